@@ -35,10 +35,20 @@
 #include "contour_generator.h"
 #include "segment_merger.h"
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
 #include "gdal.h"
 #include "gdal_alg.h"
+#include "gdal_thread_pool.h"
 #include "cpl_conv.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_srs_api.h"
 #include "ogr_geometry.h"
@@ -208,6 +218,298 @@ struct GDALRingAppender
     void *data_;
 };
 
+/************************************************************************/
+/*                  Multi-threaded contour generation                   */
+/*                                                                      */
+/*      In line mode, the raster can be split into bands of lines       */
+/*      whose contours are generated in parallel. Lines that do not     */
+/*      touch the seams between bands are written as soon as their      */
+/*      band, and all the previous ones, are complete. Lines ending on  */
+/*      a seam are stitched together once all bands are processed.      */
+/************************************************************************/
+
+namespace
+{
+
+// Collects the lines of a band, keeping apart the fragments that have an
+// end on one of the seams of the band.
+struct ContourBandCollector
+{
+    struct Line
+    {
+        double level;
+        marching_squares::LineString ls;
+    };
+
+    ContourBandCollector() = default;
+    CPL_DISALLOW_COPY_ASSIGN(ContourBandCollector)
+
+    void addLine(double level, marching_squares::LineString &ls,
+                 bool /*closed*/)
+    {
+        const bool isFragment = isOnSeam(ls.front()) || isOnSeam(ls.back());
+        (isFragment ? fragments : lines).push_back(Line{level, std::move(ls)});
+    }
+
+    bool isOnSeam(const marching_squares::Point &p) const
+    {
+        // NaN seams never compare equal
+        return p.y == topSeam || p.y == bottomSeam;
+    }
+
+    double topSeam = marching_squares::NaN;
+    double bottomSeam = marching_squares::NaN;
+    std::vector<Line> lines{};
+    std::vector<Line> fragments{};
+};
+
+struct ContourTiledContext
+{
+    GDALRasterBandH hBand = nullptr;
+    bool useNoData = false;
+    double noDataValue = 0;
+    std::mutex ioMutex{};  // RasterIO() and the output layer are not
+                           // thread-safe
+    std::atomic<bool> stop{false};
+};
+
+template <typename LevelGenerator> struct ContourBandJob
+{
+    ContourBandJob(ContourTiledContext *context, const LevelGenerator &levels,
+                   int startLine, int endLine)
+        : context_(context), levels_(levels), startLine_(startLine),
+          endLine_(endLine)
+    {
+    }
+    CPL_DISALLOW_COPY_ASSIGN(ContourBandJob)
+
+    ContourTiledContext *context_;
+    LevelGenerator levels_;
+    int startLine_;
+    int endLine_;
+    ContourBandCollector collector_{};
+    std::atomic<bool> done_{false};
+};
+
+/************************************************************************/
+/*                        ContourBandJobFunc()                          */
+/************************************************************************/
+
+template <typename LevelGenerator> void ContourBandJobFunc(void *pData)
+{
+    using namespace marching_squares;
+
+    auto job = static_cast<ContourBandJob<LevelGenerator> *>(pData);
+    auto context = job->context_;
+    const int width = GDALGetRasterBandXSize(context->hBand);
+    const int height = GDALGetRasterBandYSize(context->hBand);
+
+    const auto readLine = [context, width](int lineIdx, double *line)
+    {
+        std::lock_guard<std::mutex> lock(context->ioMutex);
+        if (GDALRasterIO(context->hBand, GF_Read, 0, lineIdx, width, 1, line,
+                         width, 1, GDT_Float64, 0, 0) != CE_None)
+        {
+            CPLDebug("CONTOUR", "failed fetch %d %d", lineIdx, width);
+            return false;
+        }
+        return true;
+    };
+
+    try
+    {
+        std::vector<double> line(width);
+        SegmentMerger<ContourBandCollector, LevelGenerator> merger(
+            job->collector_, job->levels_, /* polygonize */ false);
+        ContourGenerator<decltype(merger), LevelGenerator> cg(
+            width, height, context->useNoData, context->noDataValue, merger,
+            job->levels_);
+        if (job->startLine_ > 0)
+        {
+            if (!readLine(job->startLine_ - 1, line.data()))
+            {
+                context->stop = true;
+                return;
+            }
+            cg.setStartLine(job->startLine_, line.data());
+        }
+        for (int lineIdx = job->startLine_; lineIdx < job->endLine_; lineIdx++)
+        {
+            if (context->stop || !readLine(lineIdx, line.data()))
+            {
+                context->stop = true;
+                return;
+            }
+            cg.feedLine(line.data());
+        }
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "%s", e.what());
+        context->stop = true;
+        return;
+    }
+    job->done_ = true;
+}
+
+/************************************************************************/
+/*                      ContourStitchFragments()                        */
+/************************************************************************/
+
+// Join the fragments sharing an end on a seam, and write the resulting lines.
+void ContourStitchFragments(std::vector<ContourBandCollector::Line> &fragments,
+                            GDALRingAppender &appender)
+{
+    using marching_squares::LineString;
+    using marching_squares::Point;
+
+    // (level, x, y) of a fragment end -> (fragment index, is front end)
+    typedef std::tuple<double, double, double> EndKey;
+    std::multimap<EndKey, std::pair<size_t, bool>> ends;
+    for (size_t i = 0; i < fragments.size(); i++)
+    {
+        const auto &frag = fragments[i];
+        ends.emplace(EndKey(frag.level, frag.ls.front().x, frag.ls.front().y),
+                     std::make_pair(i, true));
+        ends.emplace(EndKey(frag.level, frag.ls.back().x, frag.ls.back().y),
+                     std::make_pair(i, false));
+    }
+
+    std::vector<bool> used(fragments.size());
+    for (size_t i = 0; i < fragments.size(); i++)
+    {
+        if (used[i])
+            continue;
+        used[i] = true;
+        const double level = fragments[i].level;
+        LineString ls = std::move(fragments[i].ls);
+
+        // Extend at the back, then at the front, until no fragment
+        // continues the line, or it becomes a ring.
+        for (int side = 0; side < 2 && !(ls.front() == ls.back()); side++)
+        {
+            while (true)
+            {
+                const Point &end = side == 0 ? ls.back() : ls.front();
+                auto range = ends.equal_range(EndKey(level, end.x, end.y));
+                auto it = range.first;
+                while (it != range.second && used[it->second.first])
+                    ++it;
+                if (it == range.second)
+                    break;
+
+                used[it->second.first] = true;
+                LineString &other = fragments[it->second.first].ls;
+                const bool otherFront = it->second.second;
+                // Make "other" start at the common end when appending to the
+                // back, and finish at it when prepending to the front.
+                if (otherFront != (side == 0))
+                    other.reverse();
+                if (side == 0)
+                {
+                    other.pop_front();
+                    ls.splice(ls.end(), other);
+                }
+                else
+                {
+                    other.pop_back();
+                    ls.splice(ls.begin(), other);
+                }
+                if (ls.front() == ls.back())
+                    break;
+            }
+        }
+
+        appender.addLine(level, ls, /* closed */ false);
+    }
+}
+
+/************************************************************************/
+/*                       ContourGenerateTiled()                         */
+/************************************************************************/
+
+template <typename LevelGenerator>
+bool ContourGenerateTiled(GDALRasterBandH hBand, bool useNoData,
+                          double noDataValue, const LevelGenerator &levels,
+                          GDALRingAppender &appender,
+                          CPLWorkerThreadPool *poThreadPool, int nBandCount,
+                          GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    const int height = GDALGetRasterBandYSize(hBand);
+
+    ContourTiledContext context;
+    context.hBand = hBand;
+    context.useNoData = useNoData;
+    context.noDataValue = noDataValue;
+
+    std::vector<std::unique_ptr<ContourBandJob<LevelGenerator>>> jobs;
+    for (int i = 0; i < nBandCount; i++)
+    {
+        const int startLine =
+            static_cast<int>(static_cast<GIntBig>(height) * i / nBandCount);
+        const int endLine = static_cast<int>(static_cast<GIntBig>(height) *
+                                             (i + 1) / nBandCount);
+        jobs.emplace_back(std::make_unique<ContourBandJob<LevelGenerator>>(
+            &context, levels, startLine, endLine));
+        auto &collector = jobs.back()->collector_;
+        if (i > 0)
+            collector.topSeam = startLine - 0.5;
+        if (i < nBandCount - 1)
+            collector.bottomSeam = endLine - 0.5;
+    }
+
+    auto poJobQueue = poThreadPool->CreateJobQueue();
+    for (auto &job : jobs)
+        poJobQueue->SubmitJob(ContourBandJobFunc<LevelGenerator>, job.get());
+
+    // Write the complete lines of the bands, in band order, as soon as
+    // they are available.
+    size_t nextBandToWrite = 0;
+    const auto writeCompletedBands = [&jobs, &nextBandToWrite, &context,
+                                      &appender]()
+    {
+        std::lock_guard<std::mutex> lock(context.ioMutex);
+        while (nextBandToWrite < jobs.size() && jobs[nextBandToWrite]->done_)
+        {
+            auto &lines = jobs[nextBandToWrite]->collector_.lines;
+            for (auto &line : lines)
+                appender.addLine(line.level, line.ls, /* closed */ false);
+            lines.clear();
+            lines.shrink_to_fit();
+            nextBandToWrite++;
+        }
+    };
+
+    for (size_t i = jobs.size(); i > 0; --i)
+    {
+        poJobQueue->WaitCompletion(static_cast<int>(i - 1));
+        if (!context.stop)
+        {
+            writeCompletedBands();
+            if (!pfnProgress(0.95 * (jobs.size() - i + 1) / jobs.size(),
+                             "Processing line", pProgressArg))
+                context.stop = true;
+        }
+    }
+    poJobQueue->WaitCompletion();
+    if (context.stop)
+        return false;
+
+    std::vector<ContourBandCollector::Line> fragments;
+    for (auto &job : jobs)
+    {
+        for (auto &frag : job->collector_.fragments)
+            fragments.push_back(std::move(frag));
+        job->collector_.fragments.clear();
+    }
+    ContourStitchFragments(fragments, appender);
+
+    pfnProgress(1.0, "", pProgressArg);
+    return true;
+}
+
+}  // namespace
+
 /************************************************************************/
 /* ==================================================================== */
 /*                   Additional C Callable Functions                    */
@@ -543,6 +845,15 @@ mode.
  *
  * If YES, contour polygons will be created, rather than polygon lines.
  *
+ *   NUM_THREADS=number_of_threads|ALL_CPUS
+ *
+ * (GDAL >= 3.9) Number of threads used in line mode to generate the contours
+ * of bands of lines in parallel. The lines crossing the seams between bands
+ * are stitched together at the end. The order of the output features, and
+ * the start of closed lines, may differ from the single-threaded mode.
+ * Defaults to the value of the GDAL_NUM_THREADS configuration option, or 1.
+ * Ignored in polygonal contouring mode.
+ *
  *
  * @return CE_None on success or CE_Failure if an error occurs.
  */
@@ -635,6 +946,23 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
 
     bool polygonize = CPLFetchBool(options, "POLYGONIZE", false);
 
+    // Bands of at least 256 lines, a few per thread to balance the load
+    CPLWorkerThreadPool *poThreadPool = nullptr;
+    int nBandCount = 1;
+    const char *pszNumThreads =
+        CSLFetchNameValueDef(options, "NUM_THREADS",
+                             CPLGetConfigOption("GDAL_NUM_THREADS", nullptr));
+    if (pszNumThreads && !polygonize)
+    {
+        int nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                        : atoi(pszNumThreads);
+        nThreads = std::max(1, std::min(nThreads, 128));
+        nBandCount =
+            std::min(nThreads * 4, GDALGetRasterBandYSize(hBand) / 256);
+        if (nThreads > 1 && nBandCount > 1)
+            poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    }
+
     using namespace marching_squares;
 
     OGRContourWriterInfo oCWI;
@@ -700,7 +1028,15 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
         else
         {
             GDALRingAppender appender(OGRContourWriter, &oCWI);
-            if (!fixedLevels.empty())
+            if (!fixedLevels.empty() && poThreadPool)
+            {
+                FixedLevelRangeIterator levels(&fixedLevels[0],
+                                               fixedLevels.size());
+                ok = ContourGenerateTiled(hBand, useNoData, noDataValue, levels,
+                                          appender, poThreadPool, nBandCount,
+                                          pfnProgress, pProgressArg);
+            }
+            else if (!fixedLevels.empty())
             {
                 FixedLevelRangeIterator levels(&fixedLevels[0],
                                                fixedLevels.size());
@@ -711,6 +1047,13 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
                     cg(hBand, useNoData, noDataValue, writer, levels);
                 ok = cg.process(pfnProgress, pProgressArg);
             }
+            else if (expBase > 0.0 && poThreadPool)
+            {
+                ExponentialLevelRangeIterator levels(expBase);
+                ok = ContourGenerateTiled(hBand, useNoData, noDataValue, levels,
+                                          appender, poThreadPool, nBandCount,
+                                          pfnProgress, pProgressArg);
+            }
             else if (expBase > 0.0)
             {
                 ExponentialLevelRangeIterator levels(expBase);
@@ -721,6 +1064,13 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
                     cg(hBand, useNoData, noDataValue, writer, levels);
                 ok = cg.process(pfnProgress, pProgressArg);
             }
+            else if (poThreadPool)
+            {
+                IntervalLevelRangeIterator levels(contourBase, contourInterval);
+                ok = ContourGenerateTiled(hBand, useNoData, noDataValue, levels,
+                                          appender, poThreadPool, nBandCount,
+                                          pfnProgress, pProgressArg);
+            }
             else
             {
                 IntervalLevelRangeIterator levels(contourBase, contourInterval);
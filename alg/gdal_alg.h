@@ -60,6 +60,34 @@ int CPL_DLL CPL_STDCALL GDALDitherRGB2PCT(
 int CPL_DLL CPL_STDCALL GDALChecksumImage(GDALRasterBandH hBand, int nXOff,
                                           int nYOff, int nXSize, int nYSize);
 
+/** Difference statistics computed by GDALCompareRasterBands().
+ * @since GDAL 3.9
+ */
+typedef struct
+{
+    /** Number of compared pixels */
+    GUIntBig nPixelCount;
+    /** Number of pixels whose values differ */
+    GUIntBig nDiffCount;
+    /** Maximum absolute difference (NaN differences excluded) */
+    double dfMaxAbsDiff;
+    /** Column of a pixel with the maximum difference, or -1 */
+    int nMaxAbsDiffX;
+    /** Line of a pixel with the maximum difference, or -1 */
+    int nMaxAbsDiffY;
+    /** Mean absolute difference (NaN differences excluded) */
+    double dfMeanAbsDiff;
+    /** Root mean square difference (NaN differences excluded) */
+    double dfRMSDiff;
+} GDALRasterBandDiffStats;
+
+CPLErr CPL_DLL GDALCompareRasterBands(GDALRasterBandH hBand1,
+                                      GDALRasterBandH hBand2,
+                                      CSLConstList papszOptions,
+                                      GDALRasterBandDiffStats *psStats,
+                                      GDALProgressFunc pfnProgress,
+                                      void *pProgressArg);
+
 CPLErr CPL_DLL CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
                                                 GDALRasterBandH hProximityBand,
                                                 char **papszOptions,
@@ -245,6 +273,17 @@ int CPL_DLL GDALApproxTransform(void *pTransformArg, int bDstToSrc,
                                 int nPointCount, double *x, double *y,
                                 double *z, int *panSuccess);
 
+/* Transform grid transformer */
+void CPL_DLL *GDALCreateTransformGridTransformer(
+    GDALTransformerFunc pfnBaseTransformer, void *pBaseTransformArg,
+    int nDstXSize, int nDstYSize, int nStep, double dfMaxError);
+void CPL_DLL GDALTransformGridTransformerOwnsSubtransformer(void *pCBData,
+                                                            int bOwnFlag);
+void CPL_DLL GDALDestroyTransformGridTransformer(void *pTransformArg);
+int CPL_DLL GDALTransformGridTransform(void *pTransformArg, int bDstToSrc,
+                                       int nPointCount, double *x, double *y,
+                                       double *z, int *panSuccess);
+
 int CPL_DLL CPL_STDCALL GDALSimpleImageWarp(
     GDALDatasetH hSrcDS, GDALDatasetH hDstDS, int nBandCount, int *panBandList,
     GDALTransformerFunc pfnTransform, void *pTransformArg,
@@ -354,6 +393,15 @@ GDALDatasetH CPL_DLL GDALViewshedGenerate(
     void *pProgressArg, GDALViewshedOutputType heightMode,
     CSLConstList papszExtraOptions);
 
+GDALDatasetH CPL_DLL GDALViewshedGenerateCumulative(
+    GDALRasterBandH hBand, const char *pszDriverName,
+    const char *pszTargetRasterName, CSLConstList papszCreationOptions,
+    int nObserverCount, const double *padfObserverX,
+    const double *padfObserverY, double dfObserverHeight,
+    double dfTargetHeight, double dfCurvCoeff, GDALViewshedMode eMode,
+    double dfMaxDistance, GDALProgressFunc pfnProgress, void *pProgressArg,
+    CSLConstList papszExtraOptions);
+
 /************************************************************************/
 /*      Rasterizer API - geometries burned into GDAL raster.            */
 /************************************************************************/
@@ -385,6 +433,18 @@ CPLErr CPL_DLL GDALRasterizeLayersBuf(
     GDALTransformerFunc pfnTransformer, void *pTransformArg, double dfBurnValue,
     char **papszOptions, GDALProgressFunc pfnProgress, void *pProgressArg);
 
+/************************************************************************/
+/*  Zonal statistics.                                                   */
+/************************************************************************/
+
+CPLErr CPL_DLL GDALZonalStatistics(GDALDatasetH hSrcDS, int nBandCount,
+                                   const int *panBandList,
+                                   OGRLayerH hZonesLayer,
+                                   OGRLayerH hOutputLayer,
+                                   CSLConstList papszOptions,
+                                   GDALProgressFunc pfnProgress,
+                                   void *pProgressArg);
+
 /************************************************************************/
 /*  Gridding interface.                                                 */
 /************************************************************************/
@@ -36,11 +36,14 @@
 
 #include <cstdint>
 
+#include <memory>
 #include <set>
 
 #include "gdal_alg.h"
 #include "ogr_spatialref.h"
 
+class CPLWorkerThreadPool;
+
 CPL_C_START
 
 /** Source of the burn value */
@@ -116,7 +119,8 @@ void GDALdllImageFilledPolygon(int nRasterXSize, int nRasterYSize,
                                const double *padfX, const double *padfY,
                                const double *padfVariant,
                                llScanlineFunc pfnScanlineFunc, void *pCBData,
-                               bool bAvoidBurningSamePoints);
+                               bool bAvoidBurningSamePoints,
+                               CPLWorkerThreadPool *poThreadPool = nullptr);
 
 CPL_C_END
 
@@ -197,6 +201,21 @@ bool GDALTransformIsTranslationOnPixelBoundaries(
 bool GDALTransformIsAffineNoRotation(GDALTransformerFunc pfnTransformer,
                                      void *pTransformerArg);
 
+/* Transform grid transformer */
+
+struct GDALTransformGrid;
+
+std::shared_ptr<const GDALTransformGrid>
+GDALBuildTransformGrid(GDALTransformerFunc pfnBaseTransformer,
+                       void *pBaseTransformArg, int nDstXSize, int nDstYSize,
+                       int nStep, double dfMaxError);
+void *GDALCreateTransformGridTransformerFromGrid(
+    GDALTransformerFunc pfnBaseTransformer, void *pBaseTransformArg,
+    const std::shared_ptr<const GDALTransformGrid> &poGrid);
+void *GDALGetTransformGridBaseTransformer(void *pTransformArg,
+                                          GDALTransformerFunc *ppfnBase);
+void *GDALDeserializeTransformGridTransformer(CPLXMLNode *psTree);
+
 typedef struct _CPLQuadTree CPLQuadTree;
 
 typedef struct
@@ -215,6 +234,9 @@ typedef struct
     bool bUseArray;
     void *pAccessors;
 
+    // Number of threads used to build the backmap.
+    int nNumThreads;
+
     // Geolocation bands.
     GDALDatasetH hDS_X;
     GDALRasterBandH hBand_X;
@@ -314,6 +336,18 @@ bool GDALComputeAreaOfInterest(OGRSpatialReference *poSRS, double dfX1,
                                double &dfEastLongitudeDeg,
                                double &dfNorthLatitudeDeg);
 
+class OGRGeometry;
+struct GDALWarpCutlineIndex;
+
+std::shared_ptr<GDALWarpCutlineIndex>
+GDALWarpCreateCutlineIndex(const OGRGeometry *poCutline);
+
+CPLErr GDALWarpCutlineMaskerWithIndex(void *pMaskFuncArg,
+                                      GDALWarpCutlineIndex *poIndex,
+                                      int nXOff, int nYOff, int nXSize,
+                                      int nYSize, float *pafMask,
+                                      int *pnValidityFlag);
+
 CPLStringList GDALCreateGeolocationMetadata(GDALDatasetH hBaseDS,
                                             const char *pszGeolocationDataset,
                                             bool bIsSource);
@@ -30,45 +30,482 @@
 #include "cpl_port.h"
 #include "gdal_alg.h"
 
+#include <atomic>
+#include <climits>
 #include <cmath>
 #include <cstddef>
 #include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
+#include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
+
+static const int anPrimes[11] = {7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43};
 
 /************************************************************************/
-/*                         GDALChecksumImage()                          */
+/*                       GDALChecksumFloatToInt()                       */
 /************************************************************************/
 
-/**
- * Compute checksum for image region.
- *
- * Computes a 16bit (0-65535) checksum from a region of raster data on a GDAL
- * supported band.   Floating point data is converted to 32bit integer
- * so decimal portions of such raster data will not affect the checksum.
- * Real and Imaginary components of complex bands influence the result.
- *
- * @param hBand the raster band to read from.
- * @param nXOff pixel offset of window to read.
- * @param nYOff line offset of window to read.
- * @param nXSize pixel size of window to read.
- * @param nYSize line size of window to read.
- *
- * @return Checksum value, or -1 in case of error (starting with GDAL 3.6)
- */
+static inline int GDALChecksumFloatToInt(double dfVal)
+{
+    if (CPLIsNan(dfVal) || CPLIsInf(dfVal))
+    {
+        // Most compilers seem to cast NaN or Inf to 0x80000000.
+        // but VC7 is an exception. So we force the result
+        // of such a cast.
+        return static_cast<int>(0x80000000);
+    }
 
-int CPL_STDCALL GDALChecksumImage(GDALRasterBandH hBand, int nXOff, int nYOff,
-                                  int nXSize, int nYSize)
+    // Standard behavior of GDALCopyWords when converting
+    // from floating point to Int32.
+    dfVal += 0.5;
+
+    if (dfVal < -2147483647.0)
+        return -2147483647;
+    else if (dfVal > 2147483647)
+        return 2147483647;
+    return static_cast<GInt32>(floor(dfVal));
+}
+
+/************************************************************************/
+/*                         GDALChecksumChunk                            */
+/************************************************************************/
 
+namespace
 {
-    VALIDATE_POINTER1(hBand, "GDALChecksumImage", 0);
+// Window of a band processed as a whole by GDALChecksumRunChunks().
+struct GDALChecksumChunk
+{
+    int nXOff = 0;
+    int nYOff = 0;
+    int nXSize = 0;
+    int nYSize = 0;
+};
+}  // namespace
+
+/************************************************************************/
+/*                        GDALChecksumGetChunks()                       */
+/************************************************************************/
+
+// Split a window of a band into chunks aligned on its blocks (in absolute
+// coordinates), of about 8 MB when read with nBytesPerPixel bytes per pixel.
+// The split only depends on the band and the window, not on the number of
+// threads, so that results combined in chunk order are reproducible.
+static std::vector<GDALChecksumChunk>
+GDALChecksumGetChunks(GDALRasterBand *poBand, int nXOff, int nYOff,
+                      int nXSize, int nYSize, int nBytesPerPixel)
+{
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    nBlockXSize = std::max(1, nBlockXSize);
+    nBlockYSize = std::max(1, nBlockYSize);
+
+    // Blocks larger than the default chunk size are read as a whole, unless
+    // they are really huge (single strip files), in which case chunks of
+    // full lines are used.
+    const GIntBig nBlockBytes = static_cast<GIntBig>(std::min(
+                                    nBlockXSize, nXSize)) *
+                                std::min(nBlockYSize, nYSize) * nBytesPerPixel;
+    const GIntBig nMaxChunkBytes = std::max(
+        static_cast<GIntBig>(8 * 1024 * 1024),
+        nBlockBytes <= 256 * 1024 * 1024 ? nBlockBytes : 0);
+    const GIntBig nBlockRowBytes =
+        static_cast<GIntBig>(nXSize) * nBlockYSize * nBytesPerPixel;
+
+    int nChunkXSize = nXSize;
+    int nChunkYSize = 1;
+    bool bFullWidth = true;
+    if (nBlockRowBytes <= nMaxChunkBytes)
+    {
+        nChunkYSize = static_cast<int>(std::min(
+            static_cast<GIntBig>(INT_MAX / 2),
+            nBlockYSize * std::max(static_cast<GIntBig>(1),
+                                   nMaxChunkBytes / nBlockRowBytes)));
+    }
+    else if (nBlockBytes <= nMaxChunkBytes)
+    {
+        bFullWidth = false;
+        nChunkYSize = nBlockYSize;
+        nChunkXSize = static_cast<int>(std::min(
+            static_cast<GIntBig>(INT_MAX / 2),
+            nBlockXSize *
+                std::max(static_cast<GIntBig>(1),
+                         nMaxChunkBytes / (static_cast<GIntBig>(nBlockXSize) *
+                                           nBlockYSize * nBytesPerPixel))));
+    }
+    else
+    {
+        nChunkYSize = static_cast<int>(std::max(
+            static_cast<GIntBig>(1),
+            nMaxChunkBytes / (static_cast<GIntBig>(nXSize) * nBytesPerPixel)));
+    }
+
+    std::vector<GDALChecksumChunk> aoChunks;
+    const int nYEnd = nYOff + nYSize;
+    const int nXEnd = nXOff + nXSize;
+    for (int nY = nYOff; nY < nYEnd;)
+    {
+        const int nChunkYEnd = static_cast<int>(
+            std::min(static_cast<GIntBig>(nYEnd),
+                     (static_cast<GIntBig>(nY) / nChunkYSize + 1) *
+                         nChunkYSize));
+        for (int nX = nXOff; nX < nXEnd;)
+        {
+            const int nChunkXEnd =
+                bFullWidth
+                    ? nXEnd
+                    : static_cast<int>(std::min(
+                          static_cast<GIntBig>(nXEnd),
+                          (static_cast<GIntBig>(nX) / nChunkXSize + 1) *
+                              nChunkXSize));
+            GDALChecksumChunk sChunk;
+            sChunk.nXOff = nX;
+            sChunk.nYOff = nY;
+            sChunk.nXSize = nChunkXEnd - nX;
+            sChunk.nYSize = nChunkYEnd - nY;
+            aoChunks.push_back(sChunk);
+            nX = nChunkXEnd;
+        }
+        nY = nChunkYEnd;
+    }
+    return aoChunks;
+}
+
+/************************************************************************/
+/*                      GDALChecksumGetThreadSafeBand()                 */
+/************************************************************************/
+
+// Return a band with the same content as poBand that may be read
+// concurrently from several threads: poBand itself if its dataset is thread
+// safe, or the band of a thread safe reopening of its dataset (stored in
+// poThreadSafeDS). Return nullptr if that is not possible.
+static GDALRasterBand *
+GDALChecksumGetThreadSafeBand(GDALRasterBand *poBand,
+                              std::unique_ptr<GDALDataset> &poThreadSafeDS)
+{
+    GDALDataset *poDS = poBand->GetDataset();
+    const int nBand = poBand->GetBand();
+    if (poDS == nullptr || nBand < 1 || nBand > poDS->GetRasterCount() ||
+        poDS->GetRasterBand(nBand) != poBand)
+    {
+        // Mask or overview band
+        return nullptr;
+    }
+    if (poDS->IsThreadSafe(GDAL_OF_RASTER))
+        return poBand;
+
+    // Reopening is only safe if the file has no pending modifications.
+    GDALDriver *poDriver = poDS->GetDriver();
+    if (poDS->GetAccess() != GA_ReadOnly || poDriver == nullptr ||
+        poDS->GetDescription()[0] == '\0')
+    {
+        return nullptr;
+    }
+
+    const char *const apszAllowedDrivers[] = {poDriver->GetDescription(),
+                                              nullptr};
+    {
+        CPLErrorStateBackuper oErrorStateBackuper;
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        poThreadSafeDS.reset(GDALDataset::Open(
+            poDS->GetDescription(),
+            GDAL_OF_RASTER | GDAL_OF_THREAD_SAFE | GDAL_OF_INTERNAL,
+            apszAllowedDrivers, poDS->GetOpenOptions()));
+    }
+    if (poThreadSafeDS == nullptr ||
+        poThreadSafeDS->GetRasterXSize() != poDS->GetRasterXSize() ||
+        poThreadSafeDS->GetRasterYSize() != poDS->GetRasterYSize() ||
+        poThreadSafeDS->GetRasterCount() != poDS->GetRasterCount() ||
+        poThreadSafeDS->GetRasterBand(nBand)->GetRasterDataType() !=
+            poBand->GetRasterDataType())
+    {
+        CPLDebug("GDAL", "Cannot reopen %s in thread-safe mode",
+                 poDS->GetDescription());
+        poThreadSafeDS.reset();
+        return nullptr;
+    }
+    return poThreadSafeDS->GetRasterBand(nBand);
+}
+
+/************************************************************************/
+/*                        GDALChecksumRunChunks()                       */
+/************************************************************************/
+
+namespace
+{
+struct GDALChecksumJob
+{
+    const std::function<bool(size_t)> *pfnFunc = nullptr;
+    size_t iChunk = 0;
+    bool bOK = true;
+    std::atomic<bool> *pbStop = nullptr;
+    std::atomic<size_t> *pnDone = nullptr;
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+};
+}  // namespace
+
+static void GDALChecksumJobFunc(void *pData)
+{
+    auto psJob = static_cast<GDALChecksumJob *>(pData);
+    if (!*(psJob->pbStop))
+    {
+        CPLInstallErrorHandlerAccumulator(psJob->aoErrors);
+        psJob->bOK = (*psJob->pfnFunc)(psJob->iChunk);
+        CPLUninstallErrorHandlerAccumulator();
+        if (!psJob->bOK)
+            *(psJob->pbStop) = true;
+    }
+    ++(*psJob->pnDone);
+}
+
+// Call pfnFunc(iChunk) for each chunk index in [0, nChunks[, from worker
+// threads if nThreads > 1. Errors of worker threads are re-emitted in chunk
+// order. Return false if a call failed or the user interrupted processing.
+static bool GDALChecksumRunChunks(int nThreads, size_t nChunks,
+                                  const std::function<bool(size_t)> &pfnFunc,
+                                  GDALProgressFunc pfnProgress,
+                                  void *pProgressArg)
+{
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if (nThreads > 1 && nChunks > 1)
+    {
+        CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+        if (poThreadPool)
+            poJobQueue = poThreadPool->CreateJobQueue();
+    }
+
+    if (poJobQueue == nullptr)
+    {
+        for (size_t i = 0; i < nChunks; ++i)
+        {
+            if (!pfnFunc(i))
+                return false;
+            if (!pfnProgress(static_cast<double>(i + 1) / nChunks, "",
+                             pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::atomic<bool> bStop{false};
+    std::atomic<size_t> nDone{0};
+    std::vector<GDALChecksumJob> asJobs(nChunks);
+    bool bInterrupted = false;
+    for (size_t i = 0; i < nChunks && !bStop; ++i)
+    {
+        asJobs[i].pfnFunc = &pfnFunc;
+        asJobs[i].iChunk = i;
+        asJobs[i].pbStop = &bStop;
+        asJobs[i].pnDone = &nDone;
+        poJobQueue->SubmitJob(GDALChecksumJobFunc, &asJobs[i]);
+
+        // Bound the number of chunks in flight, and thus memory use.
+        poJobQueue->WaitCompletion(2 * nThreads);
+        if (!pfnProgress(static_cast<double>(nDone) / nChunks, "",
+                         pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            bInterrupted = true;
+            bStop = true;
+        }
+    }
+    poJobQueue->WaitCompletion();
+
+    bool bOK = !bInterrupted;
+    for (const auto &sJob : asJobs)
+    {
+        for (const auto &oError : sJob.aoErrors)
+            CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+        bOK = bOK && sJob.bOK;
+    }
+    if (bOK)
+        pfnProgress(1.0, "", pProgressArg);
+    return bOK;
+}
+
+/************************************************************************/
+/*                     GDALChecksumComputeChunk()                       */
+/************************************************************************/
+
+// Compute the (unmasked) sum of the checksum terms of the pixels of a chunk
+// of the window whose checksum is computed.
+static bool GDALChecksumComputeChunk(GDALRasterBand *poBand,
+                                     const GDALChecksumChunk &sChunk,
+                                     int nWinXOff, int nWinYOff, int nWinXSize,
+                                     int64_t &nSum)
+{
+    const GDALDataType eDataType = poBand->GetRasterDataType();
+    const bool bComplex = CPL_TO_BOOL(GDALDataTypeIsComplex(eDataType));
+    const bool bFloat = eDataType == GDT_Float32 ||
+                        eDataType == GDT_Float64 ||
+                        eDataType == GDT_CFloat32 || eDataType == GDT_CFloat64;
+    const GDALDataType eDstDataType =
+        bFloat ? (bComplex ? GDT_CFloat64 : GDT_Float64)
+               : (bComplex ? GDT_CInt32 : GDT_Int32);
+    const int nValsPerIter = bComplex ? 2 : 1;
+
+    void *pData = VSI_MALLOC3_VERBOSE(sChunk.nXSize, sChunk.nYSize,
+                                      GDALGetDataTypeSizeBytes(eDstDataType));
+    if (pData == nullptr)
+        return false;
+    if (poBand->RasterIO(GF_Read, sChunk.nXOff, sChunk.nYOff, sChunk.nXSize,
+                         sChunk.nYSize, pData, sChunk.nXSize, sChunk.nYSize,
+                         eDstDataType, 0, 0, nullptr) != CE_None)
+    {
+        CPLFree(pData);
+        return false;
+    }
+
+    const double *padfData = static_cast<const double *>(pData);
+    const int *panData = static_cast<const int *>(pData);
+    const size_t xIters = static_cast<size_t>(nValsPerIter) * sChunk.nXSize;
+    nSum = 0;
+    for (int iY = 0; iY < sChunk.nYSize; ++iY)
+    {
+        // Initialize iPrime so that it is consistent with a per full line
+        // iteration strategy
+        int iPrime = static_cast<int>(
+            (nValsPerIter *
+             (static_cast<int64_t>(sChunk.nYOff + iY - nWinYOff) * nWinXSize +
+              (sChunk.nXOff - nWinXOff))) %
+            11);
+        const size_t nOffset = xIters * iY;
+        for (size_t i = 0; i < xIters; ++i)
+        {
+            const int nVal = bFloat
+                                 ? GDALChecksumFloatToInt(padfData[nOffset + i])
+                                 : panData[nOffset + i];
+            nSum += nVal % anPrimes[iPrime++];
+            if (iPrime > 10)
+                iPrime = 0;
+        }
+    }
+    CPLFree(pData);
+    return true;
+}
+
+/************************************************************************/
+/*                      GDALChecksumImageParallel()                     */
+/************************************************************************/
+
+// Compute the checksum from worker threads, each processing a chunk of the
+// window. As the checksum is a sum modulo 65536 of terms that only depend on
+// the position of the pixels in the window, the sums of the chunks combine
+// exactly and the result is the same as the one of the sequential
+// computation, whatever the number of threads.
+// Return -2 if the band cannot be read from several threads.
+static int GDALChecksumImageParallel(GDALRasterBand *poBand, int nXOff,
+                                     int nYOff, int nXSize, int nYSize,
+                                     int nThreads)
+{
+    std::unique_ptr<GDALDataset> poThreadSafeDS;
+    GDALRasterBand *poThreadSafeBand =
+        GDALChecksumGetThreadSafeBand(poBand, poThreadSafeDS);
+    if (poThreadSafeBand == nullptr)
+        return -2;
+
+    const GDALDataType eDataType = poBand->GetRasterDataType();
+    const int nBytesPerPixel = GDALDataTypeIsComplex(eDataType) ? 16 : 8;
+    const auto aoChunks = GDALChecksumGetChunks(
+        poThreadSafeBand, nXOff, nYOff, nXSize, nYSize, nBytesPerPixel);
+    if (aoChunks.size() < 2)
+        return -2;
+
+    std::vector<int64_t> anSums(aoChunks.size());
+    const std::function<bool(size_t)> oFunc =
+        [poThreadSafeBand, &aoChunks, &anSums, nXOff, nYOff,
+         nXSize](size_t iChunk)
+    {
+        return GDALChecksumComputeChunk(poThreadSafeBand, aoChunks[iChunk],
+                                        nXOff, nYOff, nXSize, anSums[iChunk]);
+    };
+    if (!GDALChecksumRunChunks(nThreads, aoChunks.size(), oFunc, nullptr,
+                               nullptr))
+    {
+        CPLError(CE_Failure, CPLE_FileIO,
+                 "Checksum value could not be computed due to I/O "
+                 "read error.");
+        return -1;
+    }
+
+    int64_t nSum = 0;
+    for (const int64_t nChunkSum : anSums)
+        nSum += nChunkSum;
+    return static_cast<int>(nSum & 0xffff);
+}
 
-    const static int anPrimes[11] = {7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43};
+/************************************************************************/
+/*                    GDALChecksumGetCacheSignature()                   */
+/************************************************************************/
+
+// Return in osSignature a string identifying the state of the files of the
+// dataset of poBand (number of files, total size and latest modification
+// time), if checksums of the band may be cached in its PAM metadata.
+static bool GDALChecksumGetCacheSignature(GDALRasterBand *poBand,
+                                          std::string &osSignature)
+{
+    if (!CPLTestBool(CPLGetConfigOption("GDAL_CACHE_CHECKSUM", "NO")))
+        return false;
+
+    GDALDataset *poDS = poBand->GetDataset();
+    const int nBand = poBand->GetBand();
+    if (poDS == nullptr || nBand < 1 || nBand > poDS->GetRasterCount() ||
+        poDS->GetRasterBand(nBand) != poBand ||
+        poDS->GetAccess() != GA_ReadOnly)
+    {
+        return false;
+    }
+
+    const CPLStringList aosFiles(poDS->GetFileList());
+    if (aosFiles.empty())
+        return false;
+    int nFiles = 0;
+    GIntBig nTotalSize = 0;
+    GIntBig nMaxMTime = 0;
+    for (const char *pszFile : aosFiles)
+    {
+        // The PAM file is where the cached value is stored.
+        if (CPLString(pszFile).endsWith(".aux.xml"))
+            continue;
+        VSIStatBufL sStat;
+        if (VSIStatL(pszFile, &sStat) != 0)
+            return false;
+        ++nFiles;
+        nTotalSize += static_cast<GIntBig>(sStat.st_size);
+        nMaxMTime = std::max(nMaxMTime, static_cast<GIntBig>(sStat.st_mtime));
+    }
+    if (nFiles == 0)
+        return false;
+    osSignature = CPLSPrintf("%d," CPL_FRMT_GIB "," CPL_FRMT_GIB, nFiles,
+                             nTotalSize, nMaxMTime);
+    return true;
+}
+
+/************************************************************************/
+/*                     GDALChecksumImageSequential()                    */
+/************************************************************************/
 
+static int GDALChecksumImageSequential(GDALRasterBandH hBand, int nXOff,
+                                       int nYOff, int nXSize, int nYSize)
+
+{
     int nChecksum = 0;
     int iPrime = 0;
     const GDALDataType eDataType = GDALGetRasterDataType(hBand);
@@ -103,29 +540,7 @@ int CPL_STDCALL GDALChecksumImage(GDALRasterBandH hBand, int nXOff, int nYOff,
 
             for (size_t i = 0; i < nCount; i++)
             {
-                double dfVal = padfLineData[i];
-                int nVal;
-                if (CPLIsNan(dfVal) || CPLIsInf(dfVal))
-                {
-                    // Most compilers seem to cast NaN or Inf to 0x80000000.
-                    // but VC7 is an exception. So we force the result
-                    // of such a cast.
-                    nVal = 0x80000000;
-                }
-                else
-                {
-                    // Standard behavior of GDALCopyWords when converting
-                    // from floating point to Int32.
-                    dfVal += 0.5;
-
-                    if (dfVal < -2147483647.0)
-                        nVal = -2147483647;
-                    else if (dfVal > 2147483647)
-                        nVal = 2147483647;
-                    else
-                        nVal = static_cast<GInt32>(floor(dfVal));
-                }
-
+                const int nVal = GDALChecksumFloatToInt(padfLineData[i]);
                 nChecksum += nVal % anPrimes[iPrime++];
                 if (iPrime > 10)
                     iPrime = 0;
@@ -272,3 +687,304 @@ int CPL_STDCALL GDALChecksumImage(GDALRasterBandH hBand, int nXOff, int nYOff,
 
     return nChecksum;
 }
+
+/************************************************************************/
+/*                         GDALChecksumImage()                          */
+/************************************************************************/
+
+/**
+ * Compute checksum for image region.
+ *
+ * Computes a 16bit (0-65535) checksum from a region of raster data on a GDAL
+ * supported band.   Floating point data is converted to 32bit integer
+ * so decimal portions of such raster data will not affect the checksum.
+ * Real and Imaginary components of complex bands influence the result.
+ *
+ * Starting with GDAL 3.9, the checksum is computed by several threads when
+ * the GDAL_NUM_THREADS configuration option is set to a value greater than 1
+ * (or ALL_CPUS), and the dataset of the band is thread-safe or can be
+ * reopened in read-only mode with GDAL_OF_THREAD_SAFE. The result does not
+ * depend on the number of threads.
+ *
+ * Starting with GDAL 3.9, when the GDAL_CACHE_CHECKSUM configuration option
+ * is set to YES, the checksum of a whole band of a dataset opened in
+ * read-only mode is stored in the VALUE item of the CHECKSUM metadata domain
+ * of the band (usually persisted in its .aux.xml file), along with the size
+ * and modification time of the files of the dataset, and reused as long as
+ * they are unchanged.
+ *
+ * @param hBand the raster band to read from.
+ * @param nXOff pixel offset of window to read.
+ * @param nYOff line offset of window to read.
+ * @param nXSize pixel size of window to read.
+ * @param nYSize line size of window to read.
+ *
+ * @return Checksum value, or -1 in case of error (starting with GDAL 3.6)
+ */
+
+int CPL_STDCALL GDALChecksumImage(GDALRasterBandH hBand, int nXOff, int nYOff,
+                                  int nXSize, int nYSize)
+
+{
+    VALIDATE_POINTER1(hBand, "GDALChecksumImage", 0);
+
+    GDALRasterBand *poBand = GDALRasterBand::FromHandle(hBand);
+
+    std::string osSignature;
+    const bool bFullBand = nXOff == 0 && nYOff == 0 &&
+                           nXSize == poBand->GetXSize() &&
+                           nYSize == poBand->GetYSize();
+    if (bFullBand && GDALChecksumGetCacheSignature(poBand, osSignature))
+    {
+        const char *pszSignature =
+            poBand->GetMetadataItem("SIGNATURE", "CHECKSUM");
+        const char *pszValue = poBand->GetMetadataItem("VALUE", "CHECKSUM");
+        if (pszSignature && pszValue && osSignature == pszSignature)
+            return atoi(pszValue);
+    }
+
+    int nChecksum = -2;
+    const int nThreads = GDALGetNumThreads(nullptr);
+    if (nThreads > 1)
+    {
+        nChecksum = GDALChecksumImageParallel(poBand, nXOff, nYOff, nXSize,
+                                              nYSize, nThreads);
+    }
+    if (nChecksum == -2)
+    {
+        nChecksum =
+            GDALChecksumImageSequential(hBand, nXOff, nYOff, nXSize, nYSize);
+    }
+
+    if (nChecksum >= 0 && !osSignature.empty())
+    {
+        poBand->SetMetadataItem("VALUE", CPLSPrintf("%d", nChecksum),
+                                "CHECKSUM");
+        poBand->SetMetadataItem("SIGNATURE", osSignature.c_str(), "CHECKSUM");
+    }
+
+    return nChecksum;
+}
+
+/************************************************************************/
+/*                       GDALCompareChunkStats                          */
+/************************************************************************/
+
+namespace
+{
+// Difference statistics of a chunk, combined by GDALCompareRasterBands().
+struct GDALCompareChunkStats
+{
+    GUIntBig nDiffCount = 0;
+    GUIntBig nValidCount = 0;
+    double dfSumAbsDiff = 0;
+    double dfSumSqDiff = 0;
+    double dfMaxAbsDiff = 0;
+    int nMaxAbsDiffX = -1;
+    int nMaxAbsDiffY = -1;
+};
+}  // namespace
+
+/************************************************************************/
+/*                       GDALCompareComputeChunk()                      */
+/************************************************************************/
+
+static bool GDALCompareComputeChunk(GDALRasterBand *poBand1,
+                                    GDALRasterBand *poBand2, bool bComplex,
+                                    const GDALChecksumChunk &sChunk,
+                                    GDALCompareChunkStats &sStats)
+{
+    const GDALDataType eBufType = bComplex ? GDT_CFloat64 : GDT_Float64;
+    const size_t nVals = static_cast<size_t>(sChunk.nXSize) * sChunk.nYSize *
+                         (bComplex ? 2 : 1);
+    double *padfData1 =
+        static_cast<double *>(VSI_MALLOC2_VERBOSE(nVals, 2 * sizeof(double)));
+    if (padfData1 == nullptr)
+        return false;
+    double *padfData2 = padfData1 + nVals;
+    if (poBand1->RasterIO(GF_Read, sChunk.nXOff, sChunk.nYOff, sChunk.nXSize,
+                          sChunk.nYSize, padfData1, sChunk.nXSize,
+                          sChunk.nYSize, eBufType, 0, 0,
+                          nullptr) != CE_None ||
+        poBand2->RasterIO(GF_Read, sChunk.nXOff, sChunk.nYOff, sChunk.nXSize,
+                          sChunk.nYSize, padfData2, sChunk.nXSize,
+                          sChunk.nYSize, eBufType, 0, 0, nullptr) != CE_None)
+    {
+        CPLFree(padfData1);
+        return false;
+    }
+
+    size_t i = 0;
+    for (int iY = 0; iY < sChunk.nYSize; ++iY)
+    {
+        for (int iX = 0; iX < sChunk.nXSize; ++iX)
+        {
+            const double dfRe1 = padfData1[i];
+            const double dfRe2 = padfData2[i];
+            const double dfIm1 = bComplex ? padfData1[i + 1] : 0.0;
+            const double dfIm2 = bComplex ? padfData2[i + 1] : 0.0;
+            i += bComplex ? 2 : 1;
+
+            if (dfRe1 == dfRe2 && dfIm1 == dfIm2)
+            {
+                ++sStats.nValidCount;
+                continue;
+            }
+            const bool bNaN1 = std::isnan(dfRe1) || std::isnan(dfIm1);
+            const bool bNaN2 = std::isnan(dfRe2) || std::isnan(dfIm2);
+            if (bNaN1 && bNaN2)
+                continue;
+            ++sStats.nDiffCount;
+            if (bNaN1 || bNaN2)
+                continue;
+
+            ++sStats.nValidCount;
+            const double dfAbsDiff =
+                bComplex ? std::hypot(dfRe1 - dfRe2, dfIm1 - dfIm2)
+                         : std::fabs(dfRe1 - dfRe2);
+            sStats.dfSumAbsDiff += dfAbsDiff;
+            sStats.dfSumSqDiff += dfAbsDiff * dfAbsDiff;
+            if (dfAbsDiff > sStats.dfMaxAbsDiff)
+            {
+                sStats.dfMaxAbsDiff = dfAbsDiff;
+                sStats.nMaxAbsDiffX = sChunk.nXOff + iX;
+                sStats.nMaxAbsDiffY = sChunk.nYOff + iY;
+            }
+        }
+    }
+    CPLFree(padfData1);
+    return true;
+}
+
+/************************************************************************/
+/*                       GDALCompareRasterBands()                       */
+/************************************************************************/
+
+/**
+ * Compute difference statistics between the pixel values of two bands.
+ *
+ * Both bands must have the same dimensions. Values are compared as 64 bit
+ * floating point numbers (or complex numbers, in which case the modulus of
+ * the difference is used). Two NaN values are considered equal. A NaN value
+ * compared to a non-NaN one is counted as a difference, but is not taken into
+ * account in the maximum, mean and root mean square of the differences.
+ *
+ * The bands are processed by chunks aligned on the blocks of the first band,
+ * from several threads when they are thread-safe or can be reopened in
+ * read-only mode with GDAL_OF_THREAD_SAFE. The statistics of the chunks are
+ * combined in a fixed order, so that results do not depend on the number of
+ * threads.
+ *
+ * Supported options:
+ * <ul>
+ * <li>NUM_THREADS=number_of_threads|ALL_CPUS: number of threads used to read
+ * and compare the bands. Defaults to the value of the GDAL_NUM_THREADS
+ * configuration option, or 1.</li>
+ * </ul>
+ *
+ * @param hBand1 the first band.
+ * @param hBand2 the second band.
+ * @param papszOptions NULL terminated list of options, or NULL.
+ * @param psStats pointer to the structure receiving the statistics.
+ * @param pfnProgress progress function, or NULL.
+ * @param pProgressArg argument of the progress function.
+ *
+ * @return CE_None on success, CE_Failure otherwise.
+ *
+ * @since GDAL 3.9
+ */
+
+CPLErr GDALCompareRasterBands(GDALRasterBandH hBand1, GDALRasterBandH hBand2,
+                              CSLConstList papszOptions,
+                              GDALRasterBandDiffStats *psStats,
+                              GDALProgressFunc pfnProgress,
+                              void *pProgressArg)
+{
+    VALIDATE_POINTER1(hBand1, "GDALCompareRasterBands", CE_Failure);
+    VALIDATE_POINTER1(hBand2, "GDALCompareRasterBands", CE_Failure);
+    VALIDATE_POINTER1(psStats, "GDALCompareRasterBands", CE_Failure);
+
+    GDALRasterBand *poBand1 = GDALRasterBand::FromHandle(hBand1);
+    GDALRasterBand *poBand2 = GDALRasterBand::FromHandle(hBand2);
+    const int nXSize = poBand1->GetXSize();
+    const int nYSize = poBand1->GetYSize();
+    if (poBand2->GetXSize() != nXSize || poBand2->GetYSize() != nYSize)
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "GDALCompareRasterBands(): bands have different dimensions");
+        return CE_Failure;
+    }
+
+    const bool bComplex =
+        CPL_TO_BOOL(GDALDataTypeIsComplex(poBand1->GetRasterDataType())) ||
+        CPL_TO_BOOL(GDALDataTypeIsComplex(poBand2->GetRasterDataType()));
+
+    int nThreads =
+        GDALGetNumThreads(CSLFetchNameValue(papszOptions, "NUM_THREADS"));
+    std::unique_ptr<GDALDataset> poThreadSafeDS1;
+    std::unique_ptr<GDALDataset> poThreadSafeDS2;
+    if (nThreads > 1)
+    {
+        GDALRasterBand *poThreadSafeBand1 =
+            GDALChecksumGetThreadSafeBand(poBand1, poThreadSafeDS1);
+        GDALRasterBand *poThreadSafeBand2 =
+            GDALChecksumGetThreadSafeBand(poBand2, poThreadSafeDS2);
+        if (poThreadSafeBand1 && poThreadSafeBand2)
+        {
+            poBand1 = poThreadSafeBand1;
+            poBand2 = poThreadSafeBand2;
+        }
+        else
+        {
+            CPLDebug("GDAL", "GDALCompareRasterBands(): bands cannot be read "
+                             "from several threads");
+            nThreads = 1;
+        }
+    }
+
+    const auto aoChunks = GDALChecksumGetChunks(poBand1, 0, 0, nXSize, nYSize,
+                                                bComplex ? 32 : 16);
+    std::vector<GDALCompareChunkStats> asChunkStats(aoChunks.size());
+    const std::function<bool(size_t)> oFunc =
+        [poBand1, poBand2, bComplex, &aoChunks, &asChunkStats](size_t iChunk)
+    {
+        return GDALCompareComputeChunk(poBand1, poBand2, bComplex,
+                                       aoChunks[iChunk], asChunkStats[iChunk]);
+    };
+    if (!GDALChecksumRunChunks(nThreads, aoChunks.size(), oFunc, pfnProgress,
+                               pProgressArg))
+    {
+        return CE_Failure;
+    }
+
+    GDALCompareChunkStats sTotal;
+    for (const auto &sChunkStats : asChunkStats)
+    {
+        sTotal.nDiffCount += sChunkStats.nDiffCount;
+        sTotal.nValidCount += sChunkStats.nValidCount;
+        sTotal.dfSumAbsDiff += sChunkStats.dfSumAbsDiff;
+        sTotal.dfSumSqDiff += sChunkStats.dfSumSqDiff;
+        if (sChunkStats.dfMaxAbsDiff > sTotal.dfMaxAbsDiff)
+        {
+            sTotal.dfMaxAbsDiff = sChunkStats.dfMaxAbsDiff;
+            sTotal.nMaxAbsDiffX = sChunkStats.nMaxAbsDiffX;
+            sTotal.nMaxAbsDiffY = sChunkStats.nMaxAbsDiffY;
+        }
+    }
+
+    psStats->nPixelCount = static_cast<GUIntBig>(nXSize) * nYSize;
+    psStats->nDiffCount = sTotal.nDiffCount;
+    psStats->dfMaxAbsDiff = sTotal.dfMaxAbsDiff;
+    psStats->nMaxAbsDiffX = sTotal.nMaxAbsDiffX;
+    psStats->nMaxAbsDiffY = sTotal.nMaxAbsDiffY;
+    psStats->dfMeanAbsDiff =
+        sTotal.nValidCount
+            ? sTotal.dfSumAbsDiff / static_cast<double>(sTotal.nValidCount)
+            : 0.0;
+    psStats->dfRMSDiff =
+        sTotal.nValidCount
+            ? std::sqrt(sTotal.dfSumSqDiff /
+                        static_cast<double>(sTotal.nValidCount))
+            : 0.0;
+    return CE_None;
+}
@@ -34,12 +34,16 @@
 #include <cstdio>
 #include <cstring>
 #include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_string.h"
 #include "gdal.h"
 #include "gdal_alg.h"
+#include "gdal_alg_priv.h"
 #include "gdal_priv.h"
 #include "memdataset.h"
 #include "ogr_api.h"
@@ -230,6 +234,251 @@ static int CutlineTransformer(void *pTransformArg, int bDstToSrc,
     return TRUE;
 }
 
+/************************************************************************/
+/*                        GDALWarpCutlineIndex                          */
+/*                                                                      */
+/*      Spatial index of a cutline, built once per warp operation.     */
+/*      It holds a prepared geometry to classify chunks as fully        */
+/*      inside or outside of the cutline, and a quadtree of the         */
+/*      cutline clipped to tiles, so that a chunk crossing the          */
+/*      cutline boundary only rasterizes the parts of the cutline       */
+/*      around it. Tiles are built lazily, each from its parent, and    */
+/*      their bounds are on integer pixel coordinates, so that no       */
+/*      pixel center lies on the edges they add.                        */
+/************************************************************************/
+
+namespace
+{
+constexpr double CUTLINE_INDEX_MIN_TILE_SIZE = 256;
+constexpr int CUTLINE_INDEX_MAX_TILE_POINTS = 1024;
+
+struct GDALWarpCutlineIndexNode
+{
+    double dfMinX = 0;
+    double dfMinY = 0;
+    double dfMaxX = 0;
+    double dfMaxY = 0;
+    // Polygonal part of the cutline within the node, or null if empty.
+    std::unique_ptr<OGRGeometry> poGeom{};
+    bool bLeaf = false;
+    bool bChildrenBuilt = false;
+    std::vector<std::unique_ptr<GDALWarpCutlineIndexNode>> apoChildren{};
+};
+}  // namespace
+
+struct GDALWarpCutlineIndex
+{
+    std::unique_ptr<OGRGeometry> poCutline{};
+    OGRPreparedGeometryUniquePtr poPreparedCutline{};
+    std::mutex oMutex{};
+    GDALWarpCutlineIndexNode oRoot{};
+
+    void CollectPieces(GDALWarpCutlineIndexNode *psNode, double dfMinX,
+                       double dfMinY, double dfMaxX, double dfMaxY,
+                       std::vector<OGRGeometryH> &ahPieces);
+};
+
+/************************************************************************/
+/*                       CutlineIndexPointCount()                       */
+/************************************************************************/
+
+static int CutlineIndexPointCount(const OGRGeometry *poGeom)
+{
+    const auto eType = wkbFlatten(poGeom->getGeometryType());
+    if (eType == wkbPolygon)
+    {
+        int nCount = 0;
+        for (const auto *poRing : *(poGeom->toPolygon()))
+            nCount += poRing->getNumPoints();
+        return nCount;
+    }
+    if (OGR_GT_IsSubClassOf(eType, wkbGeometryCollection))
+    {
+        int nCount = 0;
+        for (const auto *poSubGeom : *(poGeom->toGeometryCollection()))
+            nCount += CutlineIndexPointCount(poSubGeom);
+        return nCount;
+    }
+    return 0;
+}
+
+/************************************************************************/
+/*                      CutlineIndexPolygonalPart()                     */
+/************************************************************************/
+
+// Returns the polygonal part of the result of an intersection, or null if
+// it is empty. Lines and points, where the cutline only touches the tile,
+// must not be burnt.
+static std::unique_ptr<OGRGeometry>
+CutlineIndexPolygonalPart(std::unique_ptr<OGRGeometry> poGeom)
+{
+    if (poGeom == nullptr || poGeom->IsEmpty())
+        return nullptr;
+    const auto eType = wkbFlatten(poGeom->getGeometryType());
+    if (eType == wkbPolygon || eType == wkbMultiPolygon)
+        return poGeom;
+    if (eType != wkbGeometryCollection)
+        return nullptr;
+    auto poMP = std::make_unique<OGRMultiPolygon>();
+    for (const auto *poSubGeom : *(poGeom->toGeometryCollection()))
+    {
+        const auto eSubType = wkbFlatten(poSubGeom->getGeometryType());
+        if (eSubType == wkbPolygon)
+        {
+            poMP->addGeometry(poSubGeom);
+        }
+        else if (eSubType == wkbMultiPolygon)
+        {
+            for (const auto *poPoly : *(poSubGeom->toMultiPolygon()))
+                poMP->addGeometry(poPoly);
+        }
+    }
+    if (poMP->IsEmpty())
+        return nullptr;
+    return poMP;
+}
+
+/************************************************************************/
+/*                    GDALWarpCutlineIndex::CollectPieces()             */
+/************************************************************************/
+
+// Appends to ahPieces the cutline parts whose union, restricted to the
+// [dfMinX,dfMaxX]x[dfMinY,dfMaxY] window, is the cutline on that window.
+// Must be called with oMutex held. The returned geometries are owned by
+// the nodes, which are never modified once built.
+
+void GDALWarpCutlineIndex::CollectPieces(GDALWarpCutlineIndexNode *psNode,
+                                         double dfMinX, double dfMinY,
+                                         double dfMaxX, double dfMaxY,
+                                         std::vector<OGRGeometryH> &ahPieces)
+{
+    if (psNode->poGeom == nullptr || psNode->dfMaxX <= dfMinX ||
+        psNode->dfMinX >= dfMaxX || psNode->dfMaxY <= dfMinY ||
+        psNode->dfMinY >= dfMaxY)
+    {
+        return;
+    }
+
+    const bool bWithinWindow =
+        psNode->dfMinX >= dfMinX && psNode->dfMaxX <= dfMaxX &&
+        psNode->dfMinY >= dfMinY && psNode->dfMaxY <= dfMaxY;
+    if (bWithinWindow || psNode->bLeaf)
+    {
+        ahPieces.push_back(OGRGeometry::ToHandle(psNode->poGeom.get()));
+        return;
+    }
+
+    if (!psNode->bChildrenBuilt)
+    {
+        psNode->bChildrenBuilt = true;
+        const double dfWidth = psNode->dfMaxX - psNode->dfMinX;
+        const double dfHeight = psNode->dfMaxY - psNode->dfMinY;
+        std::vector<double> adfX{psNode->dfMinX};
+        if (dfWidth > CUTLINE_INDEX_MIN_TILE_SIZE)
+            adfX.push_back(std::floor(psNode->dfMinX + dfWidth / 2));
+        adfX.push_back(psNode->dfMaxX);
+        std::vector<double> adfY{psNode->dfMinY};
+        if (dfHeight > CUTLINE_INDEX_MIN_TILE_SIZE)
+            adfY.push_back(std::floor(psNode->dfMinY + dfHeight / 2));
+        adfY.push_back(psNode->dfMaxY);
+
+        for (size_t iY = 0; iY + 1 < adfY.size(); ++iY)
+        {
+            for (size_t iX = 0; iX + 1 < adfX.size(); ++iX)
+            {
+                auto psChild = std::make_unique<GDALWarpCutlineIndexNode>();
+                psChild->dfMinX = adfX[iX];
+                psChild->dfMinY = adfY[iY];
+                psChild->dfMaxX = adfX[iX + 1];
+                psChild->dfMaxY = adfY[iY + 1];
+
+                auto poRing = std::make_unique<OGRLinearRing>();
+                poRing->addPoint(psChild->dfMinX, psChild->dfMinY);
+                poRing->addPoint(psChild->dfMinX, psChild->dfMaxY);
+                poRing->addPoint(psChild->dfMaxX, psChild->dfMaxY);
+                poRing->addPoint(psChild->dfMaxX, psChild->dfMinY);
+                poRing->addPoint(psChild->dfMinX, psChild->dfMinY);
+                OGRPolygon oTile;
+                oTile.addRingDirectly(poRing.release());
+
+                CPLErrorStateBackuper oErrorStateBackuper;
+                CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+                CPLErrorReset();
+                psChild->poGeom =
+                    CutlineIndexPolygonalPart(std::unique_ptr<OGRGeometry>(
+                        psNode->poGeom->Intersection(&oTile)));
+                if (CPLGetLastErrorType() == CE_Failure)
+                {
+                    // The intersection failed (typically on an invalid
+                    // cutline). Keep burning the parent geometry.
+                    psNode->bLeaf = true;
+                    psNode->apoChildren.clear();
+                    ahPieces.push_back(
+                        OGRGeometry::ToHandle(psNode->poGeom.get()));
+                    return;
+                }
+                psChild->bLeaf =
+                    psChild->poGeom == nullptr ||
+                    (psChild->dfMaxX - psChild->dfMinX <=
+                         CUTLINE_INDEX_MIN_TILE_SIZE &&
+                     psChild->dfMaxY - psChild->dfMinY <=
+                         CUTLINE_INDEX_MIN_TILE_SIZE) ||
+                    CutlineIndexPointCount(psChild->poGeom.get()) <=
+                        CUTLINE_INDEX_MAX_TILE_POINTS;
+                psNode->apoChildren.push_back(std::move(psChild));
+            }
+        }
+    }
+
+    for (auto &psChild : psNode->apoChildren)
+        CollectPieces(psChild.get(), dfMinX, dfMinY, dfMaxX, dfMaxY, ahPieces);
+}
+
+/************************************************************************/
+/*                     GDALWarpCreateCutlineIndex()                     */
+/************************************************************************/
+
+/** Creates a spatial index of a cutline, in source pixel coordinates.
+ *
+ * Returns null if GEOS is not available or the cutline is not polygonal.
+ * The index may be shared by several threads.
+ */
+std::shared_ptr<GDALWarpCutlineIndex>
+GDALWarpCreateCutlineIndex(const OGRGeometry *poCutline)
+{
+    if (poCutline == nullptr || !OGRGeometryFactory::haveGEOS() ||
+        !OGRHasPreparedGeometrySupport())
+        return nullptr;
+    const auto eType = wkbFlatten(poCutline->getGeometryType());
+    if (eType != wkbPolygon && eType != wkbMultiPolygon)
+        return nullptr;
+
+    auto poIndex = std::make_shared<GDALWarpCutlineIndex>();
+    poIndex->poCutline.reset(poCutline->clone());
+    poIndex->poPreparedCutline.reset(OGRCreatePreparedGeometry(
+        OGRGeometry::ToHandle(poIndex->poCutline.get())));
+    if (poIndex->poPreparedCutline == nullptr)
+        return nullptr;
+
+    OGREnvelope sEnvelope;
+    poCutline->getEnvelope(&sEnvelope);
+    auto &oRoot = poIndex->oRoot;
+    oRoot.dfMinX = std::floor(sEnvelope.MinX);
+    oRoot.dfMinY = std::floor(sEnvelope.MinY);
+    oRoot.dfMaxX = std::ceil(sEnvelope.MaxX);
+    oRoot.dfMaxY = std::ceil(sEnvelope.MaxY);
+    // Avoid splitting further than the precision of coordinates allows.
+    constexpr double MAX_SPLIT_COORD = 1e15;
+    oRoot.bLeaf =
+        CutlineIndexPointCount(poCutline) <= CUTLINE_INDEX_MAX_TILE_POINTS ||
+        !(std::fabs(oRoot.dfMinX) < MAX_SPLIT_COORD &&
+          std::fabs(oRoot.dfMinY) < MAX_SPLIT_COORD &&
+          std::fabs(oRoot.dfMaxX) < MAX_SPLIT_COORD &&
+          std::fabs(oRoot.dfMaxY) < MAX_SPLIT_COORD);
+    oRoot.poGeom.reset(poCutline->clone());
+    return poIndex;
+}
+
 /************************************************************************/
 /*                       GDALWarpCutlineMasker()                        */
 /*                                                                      */
@@ -254,6 +503,33 @@ CPLErr GDALWarpCutlineMaskerEx(void *pMaskFuncArg, int /* nBandCount */,
                                GByte ** /*ppImageData */, int bMaskIsFloat,
                                void *pValidityMask, int *pnValidityFlag)
 
+{
+    if (!bMaskIsFloat)
+    {
+        CPLAssert(false);
+        return CE_Failure;
+    }
+
+    return GDALWarpCutlineMaskerWithIndex(pMaskFuncArg, nullptr, nXOff, nYOff,
+                                          nXSize, nYSize,
+                                          static_cast<float *>(pValidityMask),
+                                          pnValidityFlag);
+}
+
+/************************************************************************/
+/*                  GDALWarpCutlineMaskerWithIndex()                    */
+/************************************************************************/
+
+/** Same as GDALWarpCutlineMaskerEx() with a float mask, using an optional
+ * index created by GDALWarpCreateCutlineIndex() from the cutline of the
+ * GDALWarpOptions* pMaskFuncArg.
+ */
+CPLErr GDALWarpCutlineMaskerWithIndex(void *pMaskFuncArg,
+                                      GDALWarpCutlineIndex *poIndex,
+                                      int nXOff, int nYOff, int nXSize,
+                                      int nYSize, float *pafMask,
+                                      int *pnValidityFlag)
+
 {
     if (pnValidityFlag)
         *pnValidityFlag = GCMVF_PARTIAL_INTERSECTION;
@@ -264,12 +540,6 @@ CPLErr GDALWarpCutlineMaskerEx(void *pMaskFuncArg, int /* nBandCount */,
     /* -------------------------------------------------------------------- */
     /*      Do some minimal checking.                                       */
     /* -------------------------------------------------------------------- */
-    if (!bMaskIsFloat)
-    {
-        CPLAssert(false);
-        return CE_Failure;
-    }
-
     GDALWarpOptions *psWO = static_cast<GDALWarpOptions *>(pMaskFuncArg);
 
     if (psWO == nullptr || psWO->hCutline == nullptr)
@@ -302,8 +572,6 @@ CPLErr GDALWarpCutlineMaskerEx(void *pMaskFuncArg, int /* nBandCount */,
     OGREnvelope sEnvelope;
     OGR_G_GetEnvelope(hPolygon, &sEnvelope);
 
-    float *pafMask = static_cast<float *>(pValidityMask);
-
     if (sEnvelope.MaxX + psWO->dfCutlineBlendDist < nXOff ||
         sEnvelope.MinX - psWO->dfCutlineBlendDist > nXOff + nXSize ||
         sEnvelope.MaxY + psWO->dfCutlineBlendDist < nYOff ||
@@ -344,8 +612,13 @@ CPLErr GDALWarpCutlineMaskerEx(void *pMaskFuncArg, int /* nBandCount */,
         oChunkFootprint.addRingDirectly(poRing);
         OGREnvelope sChunkEnvelope;
         oChunkFootprint.getEnvelope(&sChunkEnvelope);
+        const OGRGeometryH hChunkFootprint =
+            OGRGeometry::ToHandle(&oChunkFootprint);
         if (sEnvelope.Contains(sChunkEnvelope) &&
-            OGRGeometry::FromHandle(hPolygon)->Contains(&oChunkFootprint))
+            (poIndex ? OGRPreparedGeometryContains(
+                           poIndex->poPreparedCutline.get(), hChunkFootprint)
+                     : OGRGeometry::FromHandle(hPolygon)->Contains(
+                           &oChunkFootprint)))
         {
             if (pnValidityFlag)
                 *pnValidityFlag = GCMVF_CHUNK_FULLY_WITHIN_CUTLINE;
@@ -353,6 +626,19 @@ CPLErr GDALWarpCutlineMaskerEx(void *pMaskFuncArg, int /* nBandCount */,
             CPLDebug("WARP", "Source chunk fully contained within cutline.");
             return CE_None;
         }
+
+        // With an index, also detect chunks that are within the envelope of
+        // the cutline but do not intersect it.
+        if (poIndex && !OGRPreparedGeometryIntersects(
+                           poIndex->poPreparedCutline.get(), hChunkFootprint))
+        {
+            if (pnValidityFlag)
+                *pnValidityFlag = GCMVF_NO_INTERSECTION;
+
+            CPLDebug("WARP", "Source chunk fully outside of cutline.");
+            memset(pafMask, 0, sizeof(float) * nXSize * nYSize);
+            return CE_None;
+        }
     }
 
     /* -------------------------------------------------------------------- */
@@ -384,9 +670,29 @@ CPLErr GDALWarpCutlineMaskerEx(void *pMaskFuncArg, int /* nBandCount */,
 
     int anXYOff[2] = {nXOff, nYOff};
 
-    CPLErr eErr = GDALRasterizeGeometries(
-        hMemDS, 1, &nTargetBand, 1, &hPolygon, CutlineTransformer, anXYOff,
-        &dfBurnValue, papszRasterizeOptions, nullptr, nullptr);
+    // With an index, only burn the parts of the cutline around the chunk.
+    std::vector<OGRGeometryH> ahPieces;
+    if (poIndex)
+    {
+        std::lock_guard<std::mutex> oLock(poIndex->oMutex);
+        poIndex->CollectPieces(&poIndex->oRoot, nXOff - 1, nYOff - 1,
+                               nXOff + nXSize + 1, nYOff + nYSize + 1,
+                               ahPieces);
+    }
+    else
+    {
+        ahPieces.push_back(hPolygon);
+    }
+
+    std::vector<double> adfBurnValues(ahPieces.size(), dfBurnValue);
+    CPLErr eErr = CE_None;
+    if (!ahPieces.empty())
+    {
+        eErr = GDALRasterizeGeometries(
+            hMemDS, 1, &nTargetBand, static_cast<int>(ahPieces.size()),
+            ahPieces.data(), CutlineTransformer, anXYOff,
+            adfBurnValues.data(), papszRasterizeOptions, nullptr, nullptr);
+    }
 
     CSLDestroy(papszRasterizeOptions);
 
@@ -402,14 +708,13 @@ CPLErr GDALWarpCutlineMaskerEx(void *pMaskFuncArg, int /* nBandCount */,
         for (int i = nXSize * nYSize - 1; i >= 0; i--)
         {
             if (pabyPolyMask[i] == 0)
-                static_cast<float *>(pValidityMask)[i] = 0.0;
+                pafMask[i] = 0.0;
         }
     }
     else
     {
         eErr = BlendMaskGenerator(nXOff, nYOff, nXSize, nYSize, pabyPolyMask,
-                                  static_cast<float *>(pValidityMask), hPolygon,
-                                  psWO->dfCutlineBlendDist);
+                                  pafMask, hPolygon, psWO->dfCutlineBlendDist);
     }
 
     /* -------------------------------------------------------------------- */
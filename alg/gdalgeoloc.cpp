@@ -42,16 +42,22 @@
 #include <cstring>
 
 #include <algorithm>
+#include <functional>
 #include <limits>
+#include <memory>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_minixml.h"
 #include "cpl_quad_tree.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include "memdataset.h"
 
 constexpr float INVALID_BMXY = -10.0f;
@@ -619,22 +625,33 @@ int GDALGeoLoc<Accessors>::Transform(void *pTransformArg, int bDstToSrc,
     /* -------------------------------------------------------------------- */
     if (!bDstToSrc)
     {
+        // First convert all points to the pixel/line space of the
+        // geolocation array, in a branch-free loop that compilers can
+        // vectorize, and then interpolate the geolocation array.
+        const double dfPixelOffset = psTransform->dfPIXEL_OFFSET;
+        const double dfPixelStep = psTransform->dfPIXEL_STEP;
+        const double dfLineOffset = psTransform->dfLINE_OFFSET;
+        const double dfLineStep = psTransform->dfLINE_STEP;
         for (int i = 0; i < nPointCount; i++)
         {
-            if (padfX[i] == HUGE_VAL || padfY[i] == HUGE_VAL)
+            panSuccess[i] = padfX[i] != HUGE_VAL && padfY[i] != HUGE_VAL;
+            padfX[i] = (padfX[i] - dfPixelOffset) / dfPixelStep -
+                       dfGeorefConventionOffset;
+            padfY[i] = (padfY[i] - dfLineOffset) / dfLineStep -
+                       dfGeorefConventionOffset;
+        }
+
+        for (int i = 0; i < nPointCount; i++)
+        {
+            if (!panSuccess[i])
             {
-                panSuccess[i] = FALSE;
+                padfX[i] = HUGE_VAL;
+                padfY[i] = HUGE_VAL;
                 continue;
             }
 
-            const double dfGeoLocPixel =
-                (padfX[i] - psTransform->dfPIXEL_OFFSET) /
-                    psTransform->dfPIXEL_STEP -
-                dfGeorefConventionOffset;
-            const double dfGeoLocLine =
-                (padfY[i] - psTransform->dfLINE_OFFSET) /
-                    psTransform->dfLINE_STEP -
-                dfGeorefConventionOffset;
+            const double dfGeoLocPixel = padfX[i];
+            const double dfGeoLocLine = padfY[i];
 
             if (!PixelLineToXY(psTransform, dfGeoLocPixel, dfGeoLocLine,
                                padfX[i], padfY[i]))
@@ -1005,6 +1022,270 @@ void GDALInverseBilinearInterpolation(const double x, const double y,
     j += s;
 }
 
+/************************************************************************/
+/*                       GDALGeoLocParallelFor()                        */
+/************************************************************************/
+
+namespace
+{
+struct GDALGeoLocParallelForJob
+{
+    const std::function<void(int, int)> *pfnFunc = nullptr;
+    int iStart = 0;
+    int iEnd = 0;
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+};
+}  // namespace
+
+static void GDALGeoLocParallelForJobFunc(void *pData)
+{
+    auto psJob = static_cast<GDALGeoLocParallelForJob *>(pData);
+    CPLInstallErrorHandlerAccumulator(psJob->aoErrors);
+    (*psJob->pfnFunc)(psJob->iStart, psJob->iEnd);
+    CPLUninstallErrorHandlerAccumulator();
+}
+
+// Calls pfnFunc(iStart, iEnd) on consecutive sub-ranges of [0, nCount[ of
+// at most nChunkSize elements, from worker threads if poJobQueue is not null.
+static void GDALGeoLocParallelFor(CPLJobQueue *poJobQueue, int nCount,
+                                  int nChunkSize,
+                                  const std::function<void(int, int)> &pfnFunc)
+{
+    if (poJobQueue == nullptr)
+    {
+        for (int iStart = 0; iStart < nCount; iStart += nChunkSize)
+            pfnFunc(iStart, std::min(nCount, iStart + nChunkSize));
+        return;
+    }
+
+    std::vector<GDALGeoLocParallelForJob> asJobs(
+        DIV_ROUND_UP(nCount, nChunkSize));
+    for (size_t i = 0; i < asJobs.size(); ++i)
+    {
+        asJobs[i].pfnFunc = &pfnFunc;
+        asJobs[i].iStart = static_cast<int>(i) * nChunkSize;
+        asJobs[i].iEnd = std::min(nCount, asJobs[i].iStart + nChunkSize);
+        poJobQueue->SubmitJob(GDALGeoLocParallelForJobFunc, &asJobs[i]);
+    }
+    poJobQueue->WaitCompletion();
+
+    for (const auto &sJob : asJobs)
+    {
+        for (const auto &oError : sJob.aoErrors)
+            CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+    }
+}
+
+/************************************************************************/
+/*                   GDALGeoLocComputeBackMapSamples()                  */
+/************************************************************************/
+
+// Parameters of the backmap being generated.
+struct GDALGeoLocBackMapContext
+{
+    const GDALGeoLocTransformInfo *psTransform = nullptr;
+    double dfMinX = 0;
+    double dfMaxY = 0;
+    double dfPixelXSize = 0;
+    double dfPixelYSize = 0;
+    double dfStep = 0;
+    double dfGeorefConventionOffset = 0;
+    int nBMXSize = 0;
+    int nBMYSize = 0;
+};
+
+// Horizontal run of samples of the (i,j) pixel space of the geolocation array.
+struct GDALGeoLocBackMapRow
+{
+    double dfY = 0;
+    double dfXStart = 0;
+    double dfXEnd = 0;
+};
+
+// Forward projection of a sample of the geolocation array into the backmap.
+// It only depends on the geolocation array, and not on the content of the
+// backmap, so it can be computed in any order.
+struct GDALGeoLocBackMapSample
+{
+    double dfX = 0;   // pixel in the geolocation array
+    double dfY = 0;   // line in the geolocation array
+    double dBMX = 0;  // pixel in the backmap
+    double dBMY = 0;  // line in the backmap
+    // Value of the backmap node at the top-left of (dBMX, dBMY), if it
+    // falls into a cell of the geolocation array.
+    bool bMatchingGeoLocCellFound = false;
+    float fBMXValue = 0;
+    float fBMYValue = 0;
+};
+
+template <class Accessors>
+static void
+GDALGeoLocComputeBackMapSamples(const GDALGeoLocBackMapContext &sCtxt,
+                                const GDALGeoLocBackMapRow *pasRows,
+                                int nRows,
+                                std::vector<GDALGeoLocBackMapSample> &aoSamples)
+{
+    const GDALGeoLocTransformInfo *psTransform = sCtxt.psTransform;
+    const double dfMinX = sCtxt.dfMinX;
+    const double dfMaxY = sCtxt.dfMaxY;
+    const double dfPixelXSize = sCtxt.dfPixelXSize;
+    const double dfPixelYSize = sCtxt.dfPixelYSize;
+    const double dfGeorefConventionOffset = sCtxt.dfGeorefConventionOffset;
+
+    // Keep those objects in this outer scope, so they are re-used, to
+    // save memory allocations.
+    OGRPoint oPoint;
+    OGRLinearRing oRing;
+    oRing.setNumPoints(5);
+
+    for (int iRow = 0; iRow < nRows; ++iRow)
+    {
+        const double dfY = pasRows[iRow].dfY;
+        for (double dfX = pasRows[iRow].dfXStart; dfX < pasRows[iRow].dfXEnd;
+             dfX += sCtxt.dfStep)
+        {
+            // Use forward geolocation array interpolation to compute
+            // the georeferenced position corresponding to (dfX, dfY)
+            double dfGeoLocX;
+            double dfGeoLocY;
+            if (!GDALGeoLoc<Accessors>::PixelLineToXY(psTransform, dfX, dfY,
+                                                      dfGeoLocX, dfGeoLocY))
+                continue;
+
+            GDALGeoLocBackMapSample sSample;
+            sSample.dfX = dfX;
+            sSample.dfY = dfY;
+
+            // Compute the floating point coordinates in the pixel space
+            // of the backmap
+            sSample.dBMX = (dfGeoLocX - dfMinX) / dfPixelXSize;
+            sSample.dBMY = (dfMaxY - dfGeoLocY) / dfPixelYSize;
+
+            // Get top left index by truncation
+            const int iBMX = static_cast<int>(std::floor(sSample.dBMX));
+            const int iBMY = static_cast<int>(std::floor(sSample.dBMY));
+
+            if (iBMX >= 0 && iBMX < sCtxt.nBMXSize && iBMY >= 0 &&
+                iBMY < sCtxt.nBMYSize)
+            {
+                // Compute the georeferenced position of the top-left
+                // index of the backmap
+                double dfGeoX = dfMinX + iBMX * dfPixelXSize;
+                const double dfGeoY = dfMaxY - iBMY * dfPixelYSize;
+
+                bool bMatchingGeoLocCellFound = false;
+
+                const int nOuterIters =
+                    psTransform->bGeographicSRSWithMinus180Plus180LongRange &&
+                            fabs(dfGeoX) >= 180
+                        ? 2
+                        : 1;
+
+                for (int iOuterIter = 0; iOuterIter < nOuterIters; ++iOuterIter)
+                {
+                    if (iOuterIter == 1 && dfGeoX >= 180)
+                        dfGeoX -= 360;
+                    else if (iOuterIter == 1 && dfGeoX <= -180)
+                        dfGeoX += 360;
+
+                    // Identify a cell (quadrilateral in georeferenced
+                    // space) in the geolocation array in which dfGeoX,
+                    // dfGeoY falls into.
+                    oPoint.setX(dfGeoX);
+                    oPoint.setY(dfGeoY);
+                    const int nX = static_cast<int>(std::floor(dfX));
+                    const int nY = static_cast<int>(std::floor(dfY));
+                    for (int sx = -1; !bMatchingGeoLocCellFound && sx <= 0;
+                         sx++)
+                    {
+                        for (int sy = -1; !bMatchingGeoLocCellFound && sy <= 0;
+                             sy++)
+                        {
+                            const int pixel = nX + sx;
+                            const int line = nY + sy;
+                            double x0, y0, x1, y1, x2, y2, x3, y3;
+                            if (!GDALGeoLoc<Accessors>::PixelLineToXY(
+                                    psTransform, pixel, line, x0, y0) ||
+                                !GDALGeoLoc<Accessors>::PixelLineToXY(
+                                    psTransform, pixel + 1, line, x2, y2) ||
+                                !GDALGeoLoc<Accessors>::PixelLineToXY(
+                                    psTransform, pixel, line + 1, x1, y1) ||
+                                !GDALGeoLoc<Accessors>::PixelLineToXY(
+                                    psTransform, pixel + 1, line + 1, x3, y3))
+                            {
+                                break;
+                            }
+
+                            int nIters = 1;
+                            if (psTransform
+                                    ->bGeographicSRSWithMinus180Plus180LongRange &&
+                                std::fabs(x0) > 170 && std::fabs(x1) > 170 &&
+                                std::fabs(x2) > 170 && std::fabs(x3) > 170 &&
+                                (std::fabs(x1 - x0) > 180 ||
+                                 std::fabs(x2 - x0) > 180 ||
+                                 std::fabs(x3 - x0) > 180))
+                            {
+                                nIters = 2;
+                                if (x0 > 0)
+                                    x0 -= 360;
+                                if (x1 > 0)
+                                    x1 -= 360;
+                                if (x2 > 0)
+                                    x2 -= 360;
+                                if (x3 > 0)
+                                    x3 -= 360;
+                            }
+                            for (int iIter = 0; iIter < nIters; ++iIter)
+                            {
+                                if (iIter == 1)
+                                {
+                                    x0 += 360;
+                                    x1 += 360;
+                                    x2 += 360;
+                                    x3 += 360;
+                                }
+
+                                oRing.setPoint(0, x0, y0);
+                                oRing.setPoint(1, x2, y2);
+                                oRing.setPoint(2, x3, y3);
+                                oRing.setPoint(3, x1, y1);
+                                oRing.setPoint(4, x0, y0);
+                                if (oRing.isPointInRing(&oPoint) ||
+                                    oRing.isPointOnRingBoundary(&oPoint))
+                                {
+                                    bMatchingGeoLocCellFound = true;
+                                    double dfBMXValue = pixel;
+                                    double dfBMYValue = line;
+                                    GDALInverseBilinearInterpolation(
+                                        dfGeoX, dfGeoY, x0, y0, x1, y1, x2, y2,
+                                        x3, y3, dfBMXValue, dfBMYValue);
+
+                                    dfBMXValue = (dfBMXValue +
+                                                  dfGeorefConventionOffset) *
+                                                     psTransform->dfPIXEL_STEP +
+                                                 psTransform->dfPIXEL_OFFSET;
+                                    dfBMYValue = (dfBMYValue +
+                                                  dfGeorefConventionOffset) *
+                                                     psTransform->dfLINE_STEP +
+                                                 psTransform->dfLINE_OFFSET;
+
+                                    sSample.bMatchingGeoLocCellFound = true;
+                                    sSample.fBMXValue =
+                                        static_cast<float>(dfBMXValue);
+                                    sSample.fBMYValue =
+                                        static_cast<float>(dfBMYValue);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            aoSamples.push_back(sSample);
+        }
+    }
+}
+
 /************************************************************************/
 /*                       GeoLocGenerateBackMap()                        */
 /************************************************************************/
@@ -1150,12 +1431,6 @@ bool GDALGeoLoc<Accessors>::GenerateBackMap(
         }
     };
 
-    // Keep those objects in this outer scope, so they are re-used, to
-    // save memory allocations.
-    OGRPoint oPoint;
-    OGRLinearRing oRing;
-    oRing.setNumPoints(5);
-
     /* -------------------------------------------------------------------- */
     /*      Run through the whole geoloc array forward projecting and       */
     /*      pushing into the backmap.                                       */
@@ -1213,256 +1488,232 @@ bool GDALGeoLoc<Accessors>::GenerateBackMap(
         xStartEnd[iXBlock].second = dfX + dfStep / 10;
     }
 
-    for (int iYBlock = 0; iYBlock < nYBlocks; ++iYBlock)
+    // Rows of samples, in the order in which they must be applied to the
+    // backmap: by geolocation block, and then by line within each block.
+    std::vector<GDALGeoLocBackMapRow> asRows;
     {
-        for (int iXBlock = 0; iXBlock < nXBlocks; ++iXBlock)
+        std::vector<double> adfY;
+        for (int iYBlock = 0; iYBlock < nYBlocks; ++iYBlock)
         {
-#if 0
-        CPLDebug("Process geoloc block (y=%d,x=%d) for y in [%f, %f] and x in [%f, %f]",
-                 iYBlock, iXBlock,
-                 yStartEnd[iYBlock].first, yStartEnd[iYBlock].second,
-                 xStartEnd[iXBlock].first, xStartEnd[iXBlock].second);
-#endif
+            adfY.clear();
             for (double dfY = yStartEnd[iYBlock].first;
                  dfY < yStartEnd[iYBlock].second; dfY += dfStep)
             {
-                for (double dfX = xStartEnd[iXBlock].first;
-                     dfX < xStartEnd[iXBlock].second; dfX += dfStep)
+                adfY.push_back(dfY);
+            }
+            for (int iXBlock = 0; iXBlock < nXBlocks; ++iXBlock)
+            {
+                for (const double dfY : adfY)
                 {
-                    // Use forward geolocation array interpolation to compute
-                    // the georeferenced position corresponding to (dfX, dfY)
-                    double dfGeoLocX;
-                    double dfGeoLocY;
-                    if (!PixelLineToXY(psTransform, dfX, dfY, dfGeoLocX,
-                                       dfGeoLocY))
-                        continue;
-
-                    // Compute the floating point coordinates in the pixel space
-                    // of the backmap
-                    const double dBMX = static_cast<double>(
-                        (dfGeoLocX - dfMinX) / dfPixelXSize);
+                    GDALGeoLocBackMapRow sRow;
+                    sRow.dfY = dfY;
+                    sRow.dfXStart = xStartEnd[iXBlock].first;
+                    sRow.dfXEnd = xStartEnd[iXBlock].second;
+                    asRows.push_back(sRow);
+                }
+            }
+        }
+    }
+    const int nRows = static_cast<int>(asRows.size());
 
-                    const double dBMY = static_cast<double>(
-                        (dfMaxY - dfGeoLocY) / dfPixelYSize);
+    int nThreads = 1;
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if (Accessors::SUPPORTS_MULTI_THREADING && psTransform->nNumThreads > 1)
+    {
+        auto poThreadPool = GDALGetGlobalThreadPool(psTransform->nNumThreads);
+        if (poThreadPool)
+        {
+            nThreads = psTransform->nNumThreads;
+            poJobQueue = poThreadPool->CreateJobQueue();
+        }
+    }
 
-                    // Get top left index by truncation
-                    const int iBMX = static_cast<int>(std::floor(dBMX));
-                    const int iBMY = static_cast<int>(std::floor(dBMY));
+    GDALGeoLocBackMapContext sCtxt;
+    sCtxt.psTransform = psTransform;
+    sCtxt.dfMinX = dfMinX;
+    sCtxt.dfMaxY = dfMaxY;
+    sCtxt.dfPixelXSize = dfPixelXSize;
+    sCtxt.dfPixelYSize = dfPixelYSize;
+    sCtxt.dfStep = dfStep;
+    sCtxt.dfGeorefConventionOffset = dfGeorefConventionOffset;
+    sCtxt.nBMXSize = nBMXSize;
+    sCtxt.nBMYSize = nBMYSize;
+
+    struct ComputeSamplesJob
+    {
+        const GDALGeoLocBackMapContext *psCtxt = nullptr;
+        const GDALGeoLocBackMapRow *pasRows = nullptr;
+        int nRows = 0;
+        std::vector<GDALGeoLocBackMapSample> aoSamples{};
 
-                    if (iBMX >= 0 && iBMX < nBMXSize && iBMY >= 0 &&
-                        iBMY < nBMYSize)
-                    {
-                        // Compute the georeferenced position of the top-left
-                        // index of the backmap
-                        double dfGeoX = dfMinX + iBMX * dfPixelXSize;
-                        const double dfGeoY = dfMaxY - iBMY * dfPixelYSize;
+        static void Run(void *pData)
+        {
+            auto psJob = static_cast<ComputeSamplesJob *>(pData);
+            psJob->aoSamples.clear();
+            GDALGeoLocComputeBackMapSamples<Accessors>(
+                *(psJob->psCtxt), psJob->pasRows, psJob->nRows,
+                psJob->aoSamples);
+        }
+    };
 
-                        bool bMatchingGeoLocCellFound = false;
+    // The forward projection of the samples, and the search of the
+    // geolocation cell they fall into, which dominate the cost of the
+    // backmap generation, do not depend on the backmap content. They are
+    // computed by batches of rows split among worker threads, while the
+    // previous batch is applied to the backmap, in the same order as a
+    // single-threaded processing, so that the result does not depend on the
+    // number of threads.
+    constexpr int ROWS_PER_JOB = 32;
+    const int nRowsPerBatch = ROWS_PER_JOB * nThreads;
+    std::vector<ComputeSamplesJob> aasJobs[2] = {
+        std::vector<ComputeSamplesJob>(nThreads),
+        std::vector<ComputeSamplesJob>(nThreads)};
+
+    const auto SubmitBatch =
+        [&sCtxt, &asRows, &poJobQueue, nRows](
+            int iBatchStart, std::vector<ComputeSamplesJob> &asJobs)
+    {
+        for (size_t i = 0; i < asJobs.size(); ++i)
+        {
+            const int iStart = std::min(
+                nRows, iBatchStart + static_cast<int>(i) * ROWS_PER_JOB);
+            asJobs[i].psCtxt = &sCtxt;
+            asJobs[i].pasRows = asRows.data() + iStart;
+            asJobs[i].nRows = std::min(nRows, iStart + ROWS_PER_JOB) - iStart;
+            if (poJobQueue)
+                poJobQueue->SubmitJob(ComputeSamplesJob::Run, &asJobs[i]);
+            else
+                ComputeSamplesJob::Run(&asJobs[i]);
+        }
+    };
 
-                        const int nOuterIters =
-                            psTransform->bGeographicSRSWithMinus180Plus180LongRange &&
-                                    fabs(dfGeoX) >= 180
-                                ? 2
-                                : 1;
+    const auto ApplySample = [&](const GDALGeoLocBackMapSample &sSample)
+    {
+        const double dfX = sSample.dfX;
+        const double dfY = sSample.dfY;
+        const double dBMX = sSample.dBMX;
+        const double dBMY = sSample.dBMY;
+        const int iBMX = static_cast<int>(std::floor(dBMX));
+        const int iBMY = static_cast<int>(std::floor(dBMY));
+
+        if (sSample.bMatchingGeoLocCellFound)
+        {
+            pAccessors->backMapXAccessor.Set(iBMX, iBMY, sSample.fBMXValue);
+            pAccessors->backMapYAccessor.Set(iBMX, iBMY, sSample.fBMYValue);
+            pAccessors->backMapWeightAccessor.Set(iBMX, iBMY, 1.0f);
+            return;
+        }
 
-                        for (int iOuterIter = 0; iOuterIter < nOuterIters;
-                             ++iOuterIter)
-                        {
-                            if (iOuterIter == 1 && dfGeoX >= 180)
-                                dfGeoX -= 360;
-                            else if (iOuterIter == 1 && dfGeoX <= -180)
-                                dfGeoX += 360;
-
-                            // Identify a cell (quadrilateral in georeferenced
-                            // space) in the geolocation array in which dfGeoX,
-                            // dfGeoY falls into.
-                            oPoint.setX(dfGeoX);
-                            oPoint.setY(dfGeoY);
-                            const int nX = static_cast<int>(std::floor(dfX));
-                            const int nY = static_cast<int>(std::floor(dfY));
-                            for (int sx = -1;
-                                 !bMatchingGeoLocCellFound && sx <= 0; sx++)
-                            {
-                                for (int sy = -1;
-                                     !bMatchingGeoLocCellFound && sy <= 0; sy++)
-                                {
-                                    const int pixel = nX + sx;
-                                    const int line = nY + sy;
-                                    double x0, y0, x1, y1, x2, y2, x3, y3;
-                                    if (!PixelLineToXY(psTransform, pixel, line,
-                                                       x0, y0) ||
-                                        !PixelLineToXY(psTransform, pixel + 1,
-                                                       line, x2, y2) ||
-                                        !PixelLineToXY(psTransform, pixel,
-                                                       line + 1, x1, y1) ||
-                                        !PixelLineToXY(psTransform, pixel + 1,
-                                                       line + 1, x3, y3))
-                                    {
-                                        break;
-                                    }
-
-                                    int nIters = 1;
-                                    if (psTransform
-                                            ->bGeographicSRSWithMinus180Plus180LongRange &&
-                                        std::fabs(x0) > 170 &&
-                                        std::fabs(x1) > 170 &&
-                                        std::fabs(x2) > 170 &&
-                                        std::fabs(x3) > 170 &&
-                                        (std::fabs(x1 - x0) > 180 ||
-                                         std::fabs(x2 - x0) > 180 ||
-                                         std::fabs(x3 - x0) > 180))
-                                    {
-                                        nIters = 2;
-                                        if (x0 > 0)
-                                            x0 -= 360;
-                                        if (x1 > 0)
-                                            x1 -= 360;
-                                        if (x2 > 0)
-                                            x2 -= 360;
-                                        if (x3 > 0)
-                                            x3 -= 360;
-                                    }
-                                    for (int iIter = 0; iIter < nIters; ++iIter)
-                                    {
-                                        if (iIter == 1)
-                                        {
-                                            x0 += 360;
-                                            x1 += 360;
-                                            x2 += 360;
-                                            x3 += 360;
-                                        }
-
-                                        oRing.setPoint(0, x0, y0);
-                                        oRing.setPoint(1, x2, y2);
-                                        oRing.setPoint(2, x3, y3);
-                                        oRing.setPoint(3, x1, y1);
-                                        oRing.setPoint(4, x0, y0);
-                                        if (oRing.isPointInRing(&oPoint) ||
-                                            oRing.isPointOnRingBoundary(
-                                                &oPoint))
-                                        {
-                                            bMatchingGeoLocCellFound = true;
-                                            double dfBMXValue = pixel;
-                                            double dfBMYValue = line;
-                                            GDALInverseBilinearInterpolation(
-                                                dfGeoX, dfGeoY, x0, y0, x1, y1,
-                                                x2, y2, x3, y3, dfBMXValue,
-                                                dfBMYValue);
-
-                                            dfBMXValue =
-                                                (dfBMXValue +
-                                                 dfGeorefConventionOffset) *
-                                                    psTransform->dfPIXEL_STEP +
-                                                psTransform->dfPIXEL_OFFSET;
-                                            dfBMYValue =
-                                                (dfBMYValue +
-                                                 dfGeorefConventionOffset) *
-                                                    psTransform->dfLINE_STEP +
-                                                psTransform->dfLINE_OFFSET;
-
-                                            pAccessors->backMapXAccessor.Set(
-                                                iBMX, iBMY,
-                                                static_cast<float>(dfBMXValue));
-                                            pAccessors->backMapYAccessor.Set(
-                                                iBMX, iBMY,
-                                                static_cast<float>(dfBMYValue));
-                                            pAccessors->backMapWeightAccessor
-                                                .Set(iBMX, iBMY, 1.0f);
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                        if (bMatchingGeoLocCellFound)
-                            continue;
-                    }
+        // We will end up here in non-nominal cases, with nodata,
+        // holes, etc.
 
-                    // We will end up here in non-nominal cases, with nodata,
-                    // holes, etc.
+        // Check if the center is in range
+        if (iBMX < -1 || iBMY < -1 || iBMX > nBMXSize || iBMY > nBMYSize)
+            return;
 
-                    // Check if the center is in range
-                    if (iBMX < -1 || iBMY < -1 || iBMX > nBMXSize ||
-                        iBMY > nBMYSize)
-                        continue;
+        const double fracBMX = dBMX - iBMX;
+        const double fracBMY = dBMY - iBMY;
 
-                    const double fracBMX = dBMX - iBMX;
-                    const double fracBMY = dBMY - iBMY;
+        // Check logic for top left pixel
+        if ((iBMX >= 0) && (iBMY >= 0) && (iBMX < nBMXSize) &&
+            (iBMY < nBMYSize) &&
+            pAccessors->backMapWeightAccessor.Get(iBMX, iBMY) != 1.0f)
+        {
+            const double tempwt = (1.0 - fracBMX) * (1.0 - fracBMY);
+            UpdateBackmap(iBMX, iBMY, dfX, dfY, tempwt);
+        }
 
-                    // Check logic for top left pixel
-                    if ((iBMX >= 0) && (iBMY >= 0) && (iBMX < nBMXSize) &&
-                        (iBMY < nBMYSize) &&
-                        pAccessors->backMapWeightAccessor.Get(iBMX, iBMY) !=
-                            1.0f)
-                    {
-                        const double tempwt = (1.0 - fracBMX) * (1.0 - fracBMY);
-                        UpdateBackmap(iBMX, iBMY, dfX, dfY, tempwt);
-                    }
+        // Check logic for top right pixel
+        if ((iBMY >= 0) && (iBMX + 1 < nBMXSize) && (iBMY < nBMYSize) &&
+            pAccessors->backMapWeightAccessor.Get(iBMX + 1, iBMY) != 1.0f)
+        {
+            const double tempwt = fracBMX * (1.0 - fracBMY);
+            UpdateBackmap(iBMX + 1, iBMY, dfX, dfY, tempwt);
+        }
 
-                    // Check logic for top right pixel
-                    if ((iBMY >= 0) && (iBMX + 1 < nBMXSize) &&
-                        (iBMY < nBMYSize) &&
-                        pAccessors->backMapWeightAccessor.Get(iBMX + 1, iBMY) !=
-                            1.0f)
-                    {
-                        const double tempwt = fracBMX * (1.0 - fracBMY);
-                        UpdateBackmap(iBMX + 1, iBMY, dfX, dfY, tempwt);
-                    }
+        // Check logic for bottom right pixel
+        if ((iBMX + 1 < nBMXSize) && (iBMY + 1 < nBMYSize) &&
+            pAccessors->backMapWeightAccessor.Get(iBMX + 1, iBMY + 1) != 1.0f)
+        {
+            const double tempwt = fracBMX * fracBMY;
+            UpdateBackmap(iBMX + 1, iBMY + 1, dfX, dfY, tempwt);
+        }
 
-                    // Check logic for bottom right pixel
-                    if ((iBMX + 1 < nBMXSize) && (iBMY + 1 < nBMYSize) &&
-                        pAccessors->backMapWeightAccessor.Get(iBMX + 1,
-                                                              iBMY + 1) != 1.0f)
-                    {
-                        const double tempwt = fracBMX * fracBMY;
-                        UpdateBackmap(iBMX + 1, iBMY + 1, dfX, dfY, tempwt);
-                    }
+        // Check logic for bottom left pixel
+        if ((iBMX >= 0) && (iBMX < nBMXSize) && (iBMY + 1 < nBMYSize) &&
+            pAccessors->backMapWeightAccessor.Get(iBMX, iBMY + 1) != 1.0f)
+        {
+            const double tempwt = (1.0 - fracBMX) * fracBMY;
+            UpdateBackmap(iBMX, iBMY + 1, dfX, dfY, tempwt);
+        }
+    };
 
-                    // Check logic for bottom left pixel
-                    if ((iBMX >= 0) && (iBMX < nBMXSize) &&
-                        (iBMY + 1 < nBMYSize) &&
-                        pAccessors->backMapWeightAccessor.Get(iBMX, iBMY + 1) !=
-                            1.0f)
-                    {
-                        const double tempwt = (1.0 - fracBMX) * fracBMY;
-                        UpdateBackmap(iBMX, iBMY + 1, dfX, dfY, tempwt);
-                    }
-                }
-            }
+    int iCurBatch = 0;
+    if (nRows > 0)
+        SubmitBatch(0, aasJobs[iCurBatch]);
+    for (int iBatchStart = 0; iBatchStart < nRows; iBatchStart += nRowsPerBatch)
+    {
+        if (poJobQueue)
+            poJobQueue->WaitCompletion();
+        if (iBatchStart + nRowsPerBatch < nRows)
+            SubmitBatch(iBatchStart + nRowsPerBatch, aasJobs[1 - iCurBatch]);
+        for (const auto &sJob : aasJobs[iCurBatch])
+        {
+            for (const auto &sSample : sJob.aoSamples)
+                ApplySample(sSample);
         }
+        iCurBatch = 1 - iCurBatch;
     }
+    if (poJobQueue)
+        poJobQueue->WaitCompletion();
+    aasJobs[0].clear();
+    aasJobs[1].clear();
+
+    // Rows of the backmap processed by a job of the following passes, which
+    // work on each backmap line independently.
+    const int nBMRowsPerJob =
+        poJobQueue ? DIV_ROUND_UP(nBMYSize, 4 * nThreads) : TILE_SIZE;
 
     // Each pixel in the backmap may have multiple entries.
     // We now go in average it out using the weights
-    START_ITER_PER_BLOCK(nBMXSize, TILE_SIZE, nBMYSize, TILE_SIZE, (void)0,
-                         iXStart, iXEnd, iYStart, iYEnd)
-    {
-        for (int iY = iYStart; iY < iYEnd; ++iY)
+    GDALGeoLocParallelFor(
+        poJobQueue.get(), nBMYSize, nBMRowsPerJob,
+        [pAccessors, nBMXSize](int iYStart, int iYEnd)
         {
-            for (int iX = iXStart; iX < iXEnd; ++iX)
+            for (int iXStart = 0; iXStart < nBMXSize; iXStart += TILE_SIZE)
             {
-                // Check if pixel was only touch during neighbor scan
-                // But no real weight was added as source point matched
-                // backmap grid node
-                const auto weight =
-                    pAccessors->backMapWeightAccessor.Get(iX, iY);
-                if (weight > 0)
+                const int iXEnd = std::min(nBMXSize, iXStart + TILE_SIZE);
+                for (int iY = iYStart; iY < iYEnd; ++iY)
                 {
-                    pAccessors->backMapXAccessor.Set(
-                        iX, iY,
-                        pAccessors->backMapXAccessor.Get(iX, iY) / weight);
-                    pAccessors->backMapYAccessor.Set(
-                        iX, iY,
-                        pAccessors->backMapYAccessor.Get(iX, iY) / weight);
-                }
-                else
-                {
-                    pAccessors->backMapXAccessor.Set(iX, iY, INVALID_BMXY);
-                    pAccessors->backMapYAccessor.Set(iX, iY, INVALID_BMXY);
+                    for (int iX = iXStart; iX < iXEnd; ++iX)
+                    {
+                        // Check if pixel was only touch during neighbor scan
+                        // But no real weight was added as source point matched
+                        // backmap grid node
+                        const auto weight =
+                            pAccessors->backMapWeightAccessor.Get(iX, iY);
+                        if (weight > 0)
+                        {
+                            pAccessors->backMapXAccessor.Set(
+                                iX, iY,
+                                pAccessors->backMapXAccessor.Get(iX, iY) /
+                                    weight);
+                            pAccessors->backMapYAccessor.Set(
+                                iX, iY,
+                                pAccessors->backMapYAccessor.Get(iX, iY) /
+                                    weight);
+                        }
+                        else
+                        {
+                            pAccessors->backMapXAccessor.Set(iX, iY,
+                                                             INVALID_BMXY);
+                            pAccessors->backMapYAccessor.Set(iX, iY,
+                                                             INVALID_BMXY);
+                        }
+                    }
                 }
             }
-        }
-    }
-    END_ITER_PER_BLOCK
+        });
 
     pAccessors->FreeWghtsBackMap();
 
@@ -1481,15 +1732,19 @@ bool GDALGeoLoc<Accessors>::GenerateBackMap(
     }
 #endif
 
-    constexpr double dfMaxSearchDist = 3.0;
-    constexpr int nSmoothingIterations = 1;
-    for (int i = 1; i <= 2; i++)
-    {
-        GDALFillNodata(GDALRasterBand::ToHandle(poBackmapDS->GetRasterBand(i)),
-                       nullptr, dfMaxSearchDist,
-                       0,  // unused parameter
-                       nSmoothingIterations, nullptr, nullptr, nullptr);
-    }
+    // The X and Y bands are filled independently.
+    GDALGeoLocParallelFor(
+        poJobQueue.get(), 2, 1,
+        [poBackmapDS](int iStart, int /* iEnd */)
+        {
+            constexpr double dfMaxSearchDist = 3.0;
+            constexpr int nSmoothingIterations = 1;
+            auto poBand = poBackmapDS->GetRasterBand(iStart + 1);
+            GDALFillNodata(GDALRasterBand::ToHandle(poBand), nullptr,
+                           dfMaxSearchDist,
+                           0,  // unused parameter
+                           nSmoothingIterations, nullptr, nullptr, nullptr);
+        });
 
 #ifdef DEBUG_GEOLOC
     if (CPLTestBool(CPLGetConfigOption("GEOLOC_DUMP", "NO")))
@@ -1502,64 +1757,65 @@ bool GDALGeoLoc<Accessors>::GenerateBackMap(
 
     // A final hole filling logic, proceeding line by line, and filling
     // holes when the backmap values surrounding the hole are close enough.
-    struct LastValidStruct
-    {
-        int iX = -1;
-        float bmX = 0;
-    };
-    std::vector<LastValidStruct> lastValid(TILE_SIZE);
-    const auto reinitLine = [&lastValid]()
-    {
-        const size_t nSize = lastValid.size();
-        lastValid.clear();
-        lastValid.resize(nSize);
-    };
-    START_ITER_PER_BLOCK(nBMXSize, TILE_SIZE, nBMYSize, TILE_SIZE, reinitLine(),
-                         iXStart, iXEnd, iYStart, iYEnd)
-    {
-        const int iYCount = iYEnd - iYStart;
-        for (int iYIter = 0; iYIter < iYCount; ++iYIter)
+    GDALGeoLocParallelFor(
+        poJobQueue.get(), nBMYSize, nBMRowsPerJob,
+        [pAccessors, nBMXSize](int iYStart, int iYEnd)
         {
-            int iLastValidIX = lastValid[iYIter].iX;
-            float bmXLastValid = lastValid[iYIter].bmX;
-            const int iBMY = iYStart + iYIter;
-            for (int iBMX = iXStart; iBMX < iXEnd; ++iBMX)
+            struct LastValidStruct
             {
-                const float bmX = pAccessors->backMapXAccessor.Get(iBMX, iBMY);
-                if (bmX == INVALID_BMXY)
-                    continue;
-                if (iLastValidIX != -1 && iBMX > iLastValidIX + 1 &&
-                    fabs(bmX - bmXLastValid) <= 2)
+                int iX = -1;
+                float bmX = 0;
+            };
+            std::vector<LastValidStruct> lastValid(iYEnd - iYStart);
+            for (int iXStart = 0; iXStart < nBMXSize; iXStart += TILE_SIZE)
+            {
+                const int iXEnd = std::min(nBMXSize, iXStart + TILE_SIZE);
+                for (int iBMY = iYStart; iBMY < iYEnd; ++iBMY)
                 {
-                    const float bmY =
-                        pAccessors->backMapYAccessor.Get(iBMX, iBMY);
-                    const float bmYLastValid =
-                        pAccessors->backMapYAccessor.Get(iLastValidIX, iBMY);
-                    if (fabs(bmY - bmYLastValid) <= 2)
+                    int iLastValidIX = lastValid[iBMY - iYStart].iX;
+                    float bmXLastValid = lastValid[iBMY - iYStart].bmX;
+                    for (int iBMX = iXStart; iBMX < iXEnd; ++iBMX)
                     {
-                        for (int iBMXInner = iLastValidIX + 1; iBMXInner < iBMX;
-                             ++iBMXInner)
+                        const float bmX =
+                            pAccessors->backMapXAccessor.Get(iBMX, iBMY);
+                        if (bmX == INVALID_BMXY)
+                            continue;
+                        if (iLastValidIX != -1 && iBMX > iLastValidIX + 1 &&
+                            fabs(bmX - bmXLastValid) <= 2)
                         {
-                            const float alpha =
-                                static_cast<float>(iBMXInner - iLastValidIX) /
-                                (iBMX - iLastValidIX);
-                            pAccessors->backMapXAccessor.Set(
-                                iBMXInner, iBMY,
-                                (1.0f - alpha) * bmXLastValid + alpha * bmX);
-                            pAccessors->backMapYAccessor.Set(
-                                iBMXInner, iBMY,
-                                (1.0f - alpha) * bmYLastValid + alpha * bmY);
+                            const float bmY =
+                                pAccessors->backMapYAccessor.Get(iBMX, iBMY);
+                            const float bmYLastValid =
+                                pAccessors->backMapYAccessor.Get(iLastValidIX,
+                                                                 iBMY);
+                            if (fabs(bmY - bmYLastValid) <= 2)
+                            {
+                                for (int iBMXInner = iLastValidIX + 1;
+                                     iBMXInner < iBMX; ++iBMXInner)
+                                {
+                                    const float alpha =
+                                        static_cast<float>(iBMXInner -
+                                                           iLastValidIX) /
+                                        (iBMX - iLastValidIX);
+                                    pAccessors->backMapXAccessor.Set(
+                                        iBMXInner, iBMY,
+                                        (1.0f - alpha) * bmXLastValid +
+                                            alpha * bmX);
+                                    pAccessors->backMapYAccessor.Set(
+                                        iBMXInner, iBMY,
+                                        (1.0f - alpha) * bmYLastValid +
+                                            alpha * bmY);
+                                }
+                            }
                         }
+                        iLastValidIX = iBMX;
+                        bmXLastValid = bmX;
                     }
+                    lastValid[iBMY - iYStart].iX = iLastValidIX;
+                    lastValid[iBMY - iYStart].bmX = bmXLastValid;
                 }
-                iLastValidIX = iBMX;
-                bmXLastValid = bmX;
             }
-            lastValid[iYIter].iX = iLastValidIX;
-            lastValid[iYIter].bmX = bmXLastValid;
-        }
-    }
-    END_ITER_PER_BLOCK
+        });
 
 #ifdef DEBUG_GEOLOC
     if (CPLTestBool(CPLGetConfigOption("GEOLOC_DUMP", "NO")))
@@ -1792,6 +2048,18 @@ void *GDALCreateGeoLocTransformerEx(GDALDatasetH hBaseDS,
                      CPLGetConfigOption("GDAL_GEOLOC_BACKMAP_OVERSAMPLE_FACTOR",
                                         "1.3")))));
 
+    const char *pszNumThreads = CSLFetchNameValueDef(
+        papszTransformOptions, "NUM_THREADS",
+        CPLGetConfigOption("GDAL_NUM_THREADS", nullptr));
+    psTransform->nNumThreads = 1;
+    if (pszNumThreads)
+    {
+        const int nThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                                 ? CPLGetNumCPUs()
+                                 : atoi(pszNumThreads);
+        psTransform->nNumThreads = std::max(1, std::min(nThreads, 128));
+    }
+
     memcpy(psTransform->sTI.abySignature, GDAL_GTI2_SIGNATURE,
            strlen(GDAL_GTI2_SIGNATURE));
     psTransform->sTI.pszClassName = "GDALGeoLocTransformer";
@@ -39,14 +39,19 @@ class GDALGeoLocCArrayAccessors
     GDALGeoLocTransformInfo *m_psTransform;
     double *m_padfGeoLocX = nullptr;
     double *m_padfGeoLocY = nullptr;
-    float *m_pafBackMapX = nullptr;
-    float *m_pafBackMapY = nullptr;
+    // Backmap X and Y values, interleaved, so that both values of a node
+    // are in the same cache line.
+    float *m_pafBackMapXY = nullptr;
     float *m_wgtsBackMap = nullptr;
 
     bool LoadGeoloc(bool bIsRegularGrid);
 
   public:
-    template <class Type> struct CArrayAccessor
+    // Accessors may be used concurrently by several threads, as long as
+    // they do not write the same pixels.
+    static constexpr bool SUPPORTS_MULTI_THREADING = true;
+
+    template <class Type, int PIXEL_STRIDE = 1> struct CArrayAccessor
     {
         Type *m_array;
         size_t m_nXSize;
@@ -60,20 +65,20 @@ class GDALGeoLocCArrayAccessors
         {
             if (pbSuccess)
                 *pbSuccess = true;
-            return m_array[nY * m_nXSize + nX];
+            return m_array[(nY * m_nXSize + nX) * PIXEL_STRIDE];
         }
 
         inline bool Set(int nX, int nY, Type val)
         {
-            m_array[nY * m_nXSize + nX] = val;
+            m_array[(nY * m_nXSize + nX) * PIXEL_STRIDE] = val;
             return true;
         }
     };
 
     CArrayAccessor<double> geolocXAccessor;
     CArrayAccessor<double> geolocYAccessor;
-    CArrayAccessor<float> backMapXAccessor;
-    CArrayAccessor<float> backMapYAccessor;
+    CArrayAccessor<float, 2> backMapXAccessor;
+    CArrayAccessor<float, 2> backMapYAccessor;
     CArrayAccessor<float> backMapWeightAccessor;
 
     explicit GDALGeoLocCArrayAccessors(GDALGeoLocTransformInfo *psTransform)
@@ -85,8 +90,7 @@ class GDALGeoLocCArrayAccessors
 
     ~GDALGeoLocCArrayAccessors()
     {
-        VSIFree(m_pafBackMapX);
-        VSIFree(m_pafBackMapY);
+        VSIFree(m_pafBackMapXY);
         VSIFree(m_padfGeoLocX);
         VSIFree(m_padfGeoLocY);
         VSIFree(m_wgtsBackMap);
@@ -118,37 +122,28 @@ class GDALGeoLocCArrayAccessors
 
 bool GDALGeoLocCArrayAccessors::AllocateBackMap()
 {
-    m_pafBackMapX = static_cast<float *>(
-        VSI_MALLOC3_VERBOSE(m_psTransform->nBackMapWidth,
-                            m_psTransform->nBackMapHeight, sizeof(float)));
-    m_pafBackMapY = static_cast<float *>(
-        VSI_MALLOC3_VERBOSE(m_psTransform->nBackMapWidth,
-                            m_psTransform->nBackMapHeight, sizeof(float)));
-
-    m_wgtsBackMap = static_cast<float *>(
-        VSI_MALLOC3_VERBOSE(m_psTransform->nBackMapWidth,
-                            m_psTransform->nBackMapHeight, sizeof(float)));
-
-    if (m_pafBackMapX == nullptr || m_pafBackMapY == nullptr ||
-        m_wgtsBackMap == nullptr)
+    const size_t nBMXYCount =
+        static_cast<size_t>(m_psTransform->nBackMapWidth) *
+        m_psTransform->nBackMapHeight;
+    if (nBMXYCount > std::numeric_limits<size_t>::max() / 2)
     {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "Too large backmap");
         return false;
     }
+    m_pafBackMapXY = static_cast<float *>(
+        VSI_CALLOC_VERBOSE(2 * nBMXYCount, sizeof(float)));
+    m_wgtsBackMap =
+        static_cast<float *>(VSI_CALLOC_VERBOSE(nBMXYCount, sizeof(float)));
 
-    const size_t nBMXYCount =
-        static_cast<size_t>(m_psTransform->nBackMapWidth) *
-        m_psTransform->nBackMapHeight;
-    for (size_t i = 0; i < nBMXYCount; i++)
+    if (m_pafBackMapXY == nullptr || m_wgtsBackMap == nullptr)
     {
-        m_pafBackMapX[i] = 0;
-        m_pafBackMapY[i] = 0;
-        m_wgtsBackMap[i] = 0.0;
+        return false;
     }
 
-    backMapXAccessor.m_array = m_pafBackMapX;
+    backMapXAccessor.m_array = m_pafBackMapXY;
     backMapXAccessor.m_nXSize = m_psTransform->nBackMapWidth;
 
-    backMapYAccessor.m_array = m_pafBackMapY;
+    backMapYAccessor.m_array = m_pafBackMapXY + 1;
     backMapYAccessor.m_nXSize = m_psTransform->nBackMapWidth;
 
     backMapWeightAccessor.m_array = m_wgtsBackMap;
@@ -181,9 +176,10 @@ GDALDataset *GDALGeoLocCArrayAccessors::GetBackmapDataset()
 
     for (int i = 1; i <= 2; i++)
     {
-        void *ptr = (i == 1) ? m_pafBackMapX : m_pafBackMapY;
+        float *ptr = m_pafBackMapXY + (i - 1);
         GDALRasterBandH hMEMBand = MEMCreateRasterBandEx(
-            poMEMDS, i, static_cast<GByte *>(ptr), GDT_Float32, 0, 0, false);
+            poMEMDS, i, reinterpret_cast<GByte *>(ptr), GDT_Float32,
+            2 * sizeof(float), 0, false);
         poMEMDS->AddMEMBand(hMEMBand);
         poMEMDS->GetRasterBand(i)->SetNoDataValue(INVALID_BMXY);
     }
@@ -55,6 +55,9 @@ class GDALGeoLocDatasetAccessors
   public:
     static constexpr int TILE_SIZE = 1024;
 
+    // The pixel accessors use a non thread-safe cache of tiles.
+    static constexpr bool SUPPORTS_MULTI_THREADING = false;
+
     GDALCachedPixelAccessor<double, TILE_SIZE> geolocXAccessor;
     GDALCachedPixelAccessor<double, TILE_SIZE> geolocYAccessor;
     GDALCachedPixelAccessor<float, TILE_SIZE> backMapXAccessor;
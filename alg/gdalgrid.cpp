@@ -39,8 +39,10 @@
 
 #include <limits>
 #include <map>
+#include <memory>
 #include <utility>
 #include <algorithm>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_cpu_features.h"
@@ -52,24 +54,78 @@
 #include "cpl_vsi.h"
 #include "cpl_worker_thread_pool.h"
 #include "gdal.h"
+#include "gdal_thread_pool.h"
 
 constexpr double TO_RADIANS = M_PI / 180.0;
 
 /************************************************************************/
-/*                        GDALGridGetPointBounds()                      */
+/*                        GDALGridGetCellRange()                        */
 /************************************************************************/
 
-static void GDALGridGetPointBounds(const void *hFeature, CPLRectObj *pBounds)
+static void GDALGridGetCellRange(double dfMin, double dfMax, double dfOrigin,
+                                 double dfInvCellSize, int nCells,
+                                 int &nCellMin, int &nCellMax)
 {
-    const GDALGridPoint *psPoint = static_cast<const GDALGridPoint *>(hFeature);
-    GDALGridXYArrays *psXYArrays = psPoint->psXYArrays;
-    const int i = psPoint->i;
-    const double dfX = psXYArrays->padfX[i];
-    const double dfY = psXYArrays->padfY[i];
-    pBounds->minx = dfX;
-    pBounds->miny = dfY;
-    pBounds->maxx = dfX;
-    pBounds->maxy = dfY;
+    // Computed in double and clamped before casting, so that search
+    // windows far outside of the point extent are safe.
+    const double dfCellMin = std::floor((dfMin - dfOrigin) * dfInvCellSize);
+    const double dfCellMax = std::floor((dfMax - dfOrigin) * dfInvCellSize);
+    nCellMin = dfCellMin <= 0 ? 0
+               : dfCellMin >= nCells - 1
+                   ? nCells - 1
+                   : static_cast<int>(dfCellMin);
+    nCellMax = dfCellMax <= 0 ? 0
+               : dfCellMax >= nCells - 1
+                   ? nCells - 1
+                   : static_cast<int>(dfCellMax);
+}
+
+/************************************************************************/
+/*                        GDALGridSearchPoints()                        */
+/************************************************************************/
+
+/** Returns the indices of the points located in the (inclusive) search
+ * rectangle. The returned vector is owned by the per-job search buffers and
+ * is overwritten by the next call. */
+static std::vector<int> &
+GDALGridSearchPoints(const GDALGridExtraParameters *psExtraParams,
+                     const CPLRectObj &sAoi)
+{
+    const GDALGridPointIndex *psPointIndex = psExtraParams->psPointIndex;
+    std::vector<int> &anPointIdx = psExtraParams->psSearchBuffers->anPointIdx;
+    anPointIdx.clear();
+
+    int nCellXMin = 0;
+    int nCellXMax = 0;
+    int nCellYMin = 0;
+    int nCellYMax = 0;
+    GDALGridGetCellRange(sAoi.minx, sAoi.maxx, psPointIndex->dfMinX,
+                         psPointIndex->dfInvCellSize, psPointIndex->nCellsX,
+                         nCellXMin, nCellXMax);
+    GDALGridGetCellRange(sAoi.miny, sAoi.maxy, psPointIndex->dfMinY,
+                         psPointIndex->dfInvCellSize, psPointIndex->nCellsY,
+                         nCellYMin, nCellYMax);
+
+    const int *panCellStart = psPointIndex->anCellStart.data();
+    const int *panPointIdx = psPointIndex->anPointIdx.data();
+    const double *padfX = psPointIndex->adfX.data();
+    const double *padfY = psPointIndex->adfY.data();
+    for (int iY = nCellYMin; iY <= nCellYMax; ++iY)
+    {
+        // Cells of a row of the grid are contiguous in the arrays.
+        const int nStart = panCellStart[iY * psPointIndex->nCellsX + nCellXMin];
+        const int nEnd =
+            panCellStart[iY * psPointIndex->nCellsX + nCellXMax + 1];
+        for (int j = nStart; j < nEnd; ++j)
+        {
+            if (padfX[j] >= sAoi.minx && padfX[j] <= sAoi.maxx &&
+                padfY[j] >= sAoi.miny && padfY[j] <= sAoi.maxy)
+            {
+                anPointIdx.push_back(panPointIdx[j]);
+            }
+        }
+    }
+    return anPointIdx;
 }
 
 /************************************************************************/
@@ -117,7 +173,7 @@ static void GDALGridGetPointBounds(const void *hFeature, CPLRectObj *pBounds)
  * @param dfYPoint Y coordinate of the point to compute.
  * @param pdfValue Pointer to variable where the computed grid node value
  * will be returned.
- * @param hExtraParamsIn extra parameters (unused)
+ * @param hExtraParamsIn extra parameters (may be NULL)
  *
  * @return CE_None on success or CE_Failure if something goes wrong.
  */
@@ -126,7 +182,7 @@ CPLErr GDALGridInverseDistanceToAPower(const void *poOptionsIn, GUInt32 nPoints,
                                        const double *padfX, const double *padfY,
                                        const double *padfZ, double dfXPoint,
                                        double dfYPoint, double *pdfValue,
-                                       CPL_UNUSED void *hExtraParamsIn)
+                                       void *hExtraParamsIn)
 {
     // TODO: For optimization purposes pre-computed parameters should be moved
     // out of this routine to the calling function.
@@ -153,8 +209,35 @@ CPLErr GDALGridInverseDistanceToAPower(const void *poOptionsIn, GUInt32 nPoints,
     double dfDenominator = 0.0;
     GUInt32 n = 0;
 
-    for (GUInt32 i = 0; i < nPoints; i++)
+    // When a point index is available, only visit the points of the bounding
+    // square of the search ellipse (whatever its rotation, it is contained in
+    // the square of half-side the largest radius). Candidates are sorted so
+    // that they are visited in the same order as in the exhaustive scan, and
+    // nMaxPoints thus selects the same points.
+    const GDALGridExtraParameters *psExtraParams =
+        static_cast<const GDALGridExtraParameters *>(hExtraParamsIn);
+    const std::vector<int> *panCandidates = nullptr;
+    if (psExtraParams != nullptr && psExtraParams->psPointIndex != nullptr &&
+        poOptions->dfRadius1 > 0 && poOptions->dfRadius2 > 0)
     {
+        const double dfSearchRadius =
+            std::max(poOptions->dfRadius1, poOptions->dfRadius2);
+        CPLRectObj sAoi;
+        sAoi.minx = dfXPoint - dfSearchRadius;
+        sAoi.miny = dfYPoint - dfSearchRadius;
+        sAoi.maxx = dfXPoint + dfSearchRadius;
+        sAoi.maxy = dfYPoint + dfSearchRadius;
+        auto &anPointIdx = GDALGridSearchPoints(psExtraParams, sAoi);
+        std::sort(anPointIdx.begin(), anPointIdx.end());
+        panCandidates = &anPointIdx;
+    }
+    const GUInt32 nCandidates =
+        panCandidates ? static_cast<GUInt32>(panCandidates->size()) : nPoints;
+
+    for (GUInt32 iCandidate = 0; iCandidate < nCandidates; iCandidate++)
+    {
+        const GUInt32 i =
+            panCandidates ? (*panCandidates)[iCandidate] : iCandidate;
         double dfRX = padfX[i] - dfXPoint;
         double dfRY = padfY[i] - dfYPoint;
         const double dfR2 =
@@ -273,13 +356,14 @@ CPLErr GDALGridInverseDistanceToAPowerNearestNeighbor(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->psPointIndex);
 
     const double dfRPower2 = psExtraParams->dfRadiusPower2PreComp;
     const double dfPowerDiv2 = psExtraParams->dfPowerDiv2PreComp;
 
-    std::multimap<double, double> oMapDistanceToZValues;
+    std::vector<GDALGridNeighbor> &asNeighbors =
+        psExtraParams->psSearchBuffers->asNeighbors;
+    asNeighbors.clear();
 
     const double dfSearchRadius = dfRadius;
     CPLRectObj sAoi;
@@ -287,14 +371,13 @@ CPLErr GDALGridInverseDistanceToAPowerNearestNeighbor(
     sAoi.miny = dfYPoint - dfSearchRadius;
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
-    int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+    const auto &anPointIdx = GDALGridSearchPoints(psExtraParams, sAoi);
+    const int nFeatureCount = static_cast<int>(anPointIdx.size());
     if (nFeatureCount != 0)
     {
         for (int k = 0; k < nFeatureCount; k++)
         {
-            const int i = papsPoints[k]->i;
+            const int i = anPointIdx[k];
             const double dfRX = padfX[i] - dfXPoint;
             const double dfRY = padfY[i] - dfYPoint;
 
@@ -304,33 +387,46 @@ CPLErr GDALGridInverseDistanceToAPowerNearestNeighbor(
             if (dfRsmoothed2 < 0.0000000000001)
             {
                 *pdfValue = padfZ[i];
-                CPLFree(papsPoints);
                 return CE_None;
             }
             // is point within real distance?
             if (dfR2 <= dfRPower2)
             {
-                oMapDistanceToZValues.insert(
-                    std::make_pair(dfRsmoothed2, padfZ[i]));
+                asNeighbors.push_back({dfRsmoothed2, padfZ[i], i});
             }
         }
     }
-    CPLFree(papsPoints);
+
+    // Order the "neighbors" within the radius by increasing distance (ties
+    // broken by point index, so that the result does not depend on the
+    // order in which the search returns them). Only the nMaxPoints closest
+    // ones are needed.
+    const auto CompareNeighbors =
+        [](const GDALGridNeighbor &a, const GDALGridNeighbor &b)
+    {
+        return a.dfR2 < b.dfR2 || (a.dfR2 == b.dfR2 && a.nIdx < b.nIdx);
+    };
+    if (nMaxPoints > 0 && nMaxPoints < asNeighbors.size())
+    {
+        std::partial_sort(asNeighbors.begin(),
+                          asNeighbors.begin() + nMaxPoints, asNeighbors.end(),
+                          CompareNeighbors);
+        asNeighbors.resize(nMaxPoints);
+    }
+    else
+    {
+        std::sort(asNeighbors.begin(), asNeighbors.end(), CompareNeighbors);
+    }
 
     double dfNominator = 0.0;
     double dfDenominator = 0.0;
     GUInt32 n = 0;
 
-    // Examine all "neighbors" within the radius (sorted by distance via the
-    // multimap), and use the closest n points based on distance until the max
-    // is reached.
-    for (std::multimap<double, double>::iterator oMapDistanceToZValuesIter =
-             oMapDistanceToZValues.begin();
-         oMapDistanceToZValuesIter != oMapDistanceToZValues.end();
-         ++oMapDistanceToZValuesIter)
+    // Use the closest n points based on distance until the max is reached.
+    for (const auto &sNeighbor : asNeighbors)
     {
-        const double dfR2 = oMapDistanceToZValuesIter->first;
-        const double dfZ = oMapDistanceToZValuesIter->second;
+        const double dfR2 = sNeighbor.dfR2;
+        const double dfZ = sNeighbor.dfZ;
 
         const double dfW = pow(dfR2, dfPowerDiv2);
         const double dfInvW = 1.0 / dfW;
@@ -382,8 +478,7 @@ static CPLErr GDALGridInverseDistanceToAPowerNearestNeighborPerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->psPointIndex);
 
     const double dfRPower2 = psExtraParams->dfRadiusPower2PreComp;
     const double dfPowerDiv2 = psExtraParams->dfPowerDiv2PreComp;
@@ -395,14 +490,13 @@ static CPLErr GDALGridInverseDistanceToAPowerNearestNeighborPerQuadrant(
     sAoi.miny = dfYPoint - dfSearchRadius;
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
-    int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+    const auto &anPointIdx = GDALGridSearchPoints(psExtraParams, sAoi);
+    const int nFeatureCount = static_cast<int>(anPointIdx.size());
     if (nFeatureCount != 0)
     {
         for (int k = 0; k < nFeatureCount; k++)
         {
-            const int i = papsPoints[k]->i;
+            const int i = anPointIdx[k];
             const double dfRX = padfX[i] - dfXPoint;
             const double dfRY = padfY[i] - dfYPoint;
 
@@ -412,7 +506,6 @@ static CPLErr GDALGridInverseDistanceToAPowerNearestNeighborPerQuadrant(
             if (dfRsmoothed2 < 0.0000000000001)
             {
                 *pdfValue = padfZ[i];
-                CPLFree(papsPoints);
                 return CE_None;
             }
             // is point within real distance?
@@ -425,7 +518,6 @@ static CPLErr GDALGridInverseDistanceToAPowerNearestNeighborPerQuadrant(
             }
         }
     }
-    CPLFree(papsPoints);
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -662,7 +754,7 @@ CPLErr GDALGridMovingAverage(const void *poOptionsIn, GUInt32 nPoints,
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
+    const GDALGridPointIndex *psPointIndex = psExtraParams->psPointIndex;
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -674,21 +766,20 @@ CPLErr GDALGridMovingAverage(const void *poOptionsIn, GUInt32 nPoints,
     double dfAccumulator = 0.0;
 
     GUInt32 n = 0;  // Used after for.
-    if (phQuadTree != nullptr)
+    if (psPointIndex != nullptr)
     {
         CPLRectObj sAoi;
         sAoi.minx = dfXPoint - dfSearchRadius;
         sAoi.miny = dfYPoint - dfSearchRadius;
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
-        int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        const auto &anPointIdx = GDALGridSearchPoints(psExtraParams, sAoi);
+        const int nFeatureCount = static_cast<int>(anPointIdx.size());
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
             {
-                const int i = papsPoints[k]->i;
+                const int i = anPointIdx[k];
                 const double dfRX = padfX[i] - dfXPoint;
                 const double dfRY = padfY[i] - dfYPoint;
 
@@ -701,7 +792,6 @@ CPLErr GDALGridMovingAverage(const void *poOptionsIn, GUInt32 nPoints,
                 }
             }
         }
-        CPLFree(papsPoints);
     }
     else
     {
@@ -765,8 +855,7 @@ static CPLErr GDALGridMovingAveragePerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->psPointIndex);
 
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
@@ -777,14 +866,13 @@ static CPLErr GDALGridMovingAveragePerQuadrant(
     sAoi.miny = dfYPoint - dfSearchRadius;
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
-    int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+    const auto &anPointIdx = GDALGridSearchPoints(psExtraParams, sAoi);
+    const int nFeatureCount = static_cast<int>(anPointIdx.size());
     if (nFeatureCount != 0)
     {
         for (int k = 0; k < nFeatureCount; k++)
         {
-            const int i = papsPoints[k]->i;
+            const int i = anPointIdx[k];
             const double dfRX = padfX[i] - dfXPoint;
             const double dfRY = padfY[i] - dfYPoint;
             const double dfRXSquare = dfRX * dfRX;
@@ -800,7 +888,6 @@ static CPLErr GDALGridMovingAveragePerQuadrant(
             }
         }
     }
-    CPLFree(papsPoints);
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -909,7 +996,7 @@ CPLErr GDALGridNearestNeighbor(const void *poOptionsIn, GUInt32 nPoints,
     const double dfR12Square = dfRadius1Square * dfRadius2Square;
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    CPLQuadTree *hQuadTree = psExtraParams->hQuadTree;
+    const GDALGridPointIndex *psPointIndex = psExtraParams->psPointIndex;
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -922,7 +1009,7 @@ CPLErr GDALGridNearestNeighbor(const void *poOptionsIn, GUInt32 nPoints,
     GUInt32 i = 0;
 
     double dfSearchRadius = psExtraParams->dfInitialSearchRadius;
-    if (hQuadTree != nullptr)
+    if (psPointIndex != nullptr)
     {
         if (poOptions->dfRadius1 > 0 || poOptions->dfRadius2 > 0)
             dfSearchRadius =
@@ -934,33 +1021,35 @@ CPLErr GDALGridNearestNeighbor(const void *poOptionsIn, GUInt32 nPoints,
             sAoi.miny = dfYPoint - dfSearchRadius;
             sAoi.maxx = dfXPoint + dfSearchRadius;
             sAoi.maxy = dfYPoint + dfSearchRadius;
-            int nFeatureCount = 0;
-            GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-                CPLQuadTreeSearch(hQuadTree, &sAoi, &nFeatureCount));
+            const auto &anPointIdx = GDALGridSearchPoints(psExtraParams, sAoi);
+            const int nFeatureCount = static_cast<int>(anPointIdx.size());
             if (nFeatureCount != 0)
             {
                 // Nearest distance will be initialized with the distance to the
                 // first point in array.
                 double dfNearestRSquare = std::numeric_limits<double>::max();
+                int nNearestIdx = -1;
                 for (int k = 0; k < nFeatureCount; k++)
                 {
-                    const int idx = papsPoints[k]->i;
+                    const int idx = anPointIdx[k];
                     const double dfRX = padfX[idx] - dfXPoint;
                     const double dfRY = padfY[idx] - dfYPoint;
 
                     const double dfR2 = dfRX * dfRX + dfRY * dfRY;
-                    if (dfR2 <= dfNearestRSquare)
+                    // On ties, retain the point of largest index, as the
+                    // exhaustive scan does.
+                    if (dfR2 < dfNearestRSquare ||
+                        (dfR2 == dfNearestRSquare && idx > nNearestIdx))
                     {
                         dfNearestRSquare = dfR2;
+                        nNearestIdx = idx;
                         dfNearestValue = padfZ[idx];
                     }
                 }
 
-                CPLFree(papsPoints);
                 break;
             }
 
-            CPLFree(papsPoints);
             if (poOptions->dfRadius1 > 0 || poOptions->dfRadius2 > 0)
                 break;
             dfSearchRadius *= 2;
@@ -1067,7 +1156,7 @@ CPLErr GDALGridDataMetricMinimum(const void *poOptionsIn, GUInt32 nPoints,
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
+    const GDALGridPointIndex *psPointIndex = psExtraParams->psPointIndex;
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -1077,21 +1166,20 @@ CPLErr GDALGridDataMetricMinimum(const void *poOptionsIn, GUInt32 nPoints,
 
     double dfMinimumValue = std::numeric_limits<double>::max();
     GUInt32 n = 0;
-    if (phQuadTree != nullptr)
+    if (psPointIndex != nullptr)
     {
         CPLRectObj sAoi;
         sAoi.minx = dfXPoint - dfSearchRadius;
         sAoi.miny = dfYPoint - dfSearchRadius;
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
-        int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        const auto &anPointIdx = GDALGridSearchPoints(psExtraParams, sAoi);
+        const int nFeatureCount = static_cast<int>(anPointIdx.size());
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
             {
-                const int i = papsPoints[k]->i;
+                const int i = anPointIdx[k];
                 const double dfRX = padfX[i] - dfXPoint;
                 const double dfRY = padfY[i] - dfYPoint;
 
@@ -1105,7 +1193,6 @@ CPLErr GDALGridDataMetricMinimum(const void *poOptionsIn, GUInt32 nPoints,
                 }
             }
         }
-        CPLFree(papsPoints);
     }
     else
     {
@@ -1179,24 +1266,22 @@ static CPLErr GDALGridDataMetricMinimumOrMaximumPerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->psPointIndex);
 
     CPLRectObj sAoi;
     sAoi.minx = dfXPoint - dfSearchRadius;
     sAoi.miny = dfYPoint - dfSearchRadius;
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
-    int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+    const auto &anPointIdx = GDALGridSearchPoints(psExtraParams, sAoi);
+    const int nFeatureCount = static_cast<int>(anPointIdx.size());
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
     if (nFeatureCount != 0)
     {
         for (int k = 0; k < nFeatureCount; k++)
         {
-            const int i = papsPoints[k]->i;
+            const int i = anPointIdx[k];
             const double dfRX = padfX[i] - dfXPoint;
             const double dfRY = padfY[i] - dfYPoint;
             const double dfRXSquare = dfRX * dfRX;
@@ -1212,7 +1297,6 @@ static CPLErr GDALGridDataMetricMinimumOrMaximumPerQuadrant(
             }
         }
     }
-    CPLFree(papsPoints);
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -1361,7 +1445,7 @@ CPLErr GDALGridDataMetricMaximum(const void *poOptionsIn, GUInt32 nPoints,
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
+    const GDALGridPointIndex *psPointIndex = psExtraParams->psPointIndex;
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -1371,21 +1455,20 @@ CPLErr GDALGridDataMetricMaximum(const void *poOptionsIn, GUInt32 nPoints,
 
     double dfMaximumValue = -std::numeric_limits<double>::max();
     GUInt32 n = 0;
-    if (phQuadTree != nullptr)
+    if (psPointIndex != nullptr)
     {
         CPLRectObj sAoi;
         sAoi.minx = dfXPoint - dfSearchRadius;
         sAoi.miny = dfYPoint - dfSearchRadius;
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
-        int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        const auto &anPointIdx = GDALGridSearchPoints(psExtraParams, sAoi);
+        const int nFeatureCount = static_cast<int>(anPointIdx.size());
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
             {
-                const int i = papsPoints[k]->i;
+                const int i = anPointIdx[k];
                 const double dfRX = padfX[i] - dfXPoint;
                 const double dfRY = padfY[i] - dfYPoint;
 
@@ -1399,7 +1482,6 @@ CPLErr GDALGridDataMetricMaximum(const void *poOptionsIn, GUInt32 nPoints,
                 }
             }
         }
-        CPLFree(papsPoints);
     }
     else
     {
@@ -1517,7 +1599,7 @@ CPLErr GDALGridDataMetricRange(const void *poOptionsIn, GUInt32 nPoints,
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
+    const GDALGridPointIndex *psPointIndex = psExtraParams->psPointIndex;
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -1528,21 +1610,20 @@ CPLErr GDALGridDataMetricRange(const void *poOptionsIn, GUInt32 nPoints,
     double dfMaximumValue = -std::numeric_limits<double>::max();
     double dfMinimumValue = std::numeric_limits<double>::max();
     GUInt32 n = 0;
-    if (phQuadTree != nullptr)
+    if (psPointIndex != nullptr)
     {
         CPLRectObj sAoi;
         sAoi.minx = dfXPoint - dfSearchRadius;
         sAoi.miny = dfYPoint - dfSearchRadius;
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
-        int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        const auto &anPointIdx = GDALGridSearchPoints(psExtraParams, sAoi);
+        const int nFeatureCount = static_cast<int>(anPointIdx.size());
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
             {
-                const int i = papsPoints[k]->i;
+                const int i = anPointIdx[k];
                 const double dfRX = padfX[i] - dfXPoint;
                 const double dfRY = padfY[i] - dfYPoint;
 
@@ -1558,7 +1639,6 @@ CPLErr GDALGridDataMetricRange(const void *poOptionsIn, GUInt32 nPoints,
                 }
             }
         }
-        CPLFree(papsPoints);
     }
     else
     {
@@ -1632,24 +1712,22 @@ static CPLErr GDALGridDataMetricRangePerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->psPointIndex);
 
     CPLRectObj sAoi;
     sAoi.minx = dfXPoint - dfSearchRadius;
     sAoi.miny = dfYPoint - dfSearchRadius;
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
-    int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+    const auto &anPointIdx = GDALGridSearchPoints(psExtraParams, sAoi);
+    const int nFeatureCount = static_cast<int>(anPointIdx.size());
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
     if (nFeatureCount != 0)
     {
         for (int k = 0; k < nFeatureCount; k++)
         {
-            const int i = papsPoints[k]->i;
+            const int i = anPointIdx[k];
             const double dfRX = padfX[i] - dfXPoint;
             const double dfRY = padfY[i] - dfYPoint;
             const double dfRXSquare = dfRX * dfRX;
@@ -1665,7 +1743,6 @@ static CPLErr GDALGridDataMetricRangePerQuadrant(
             }
         }
     }
-    CPLFree(papsPoints);
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -1789,7 +1866,7 @@ CPLErr GDALGridDataMetricCount(const void *poOptionsIn, GUInt32 nPoints,
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
+    const GDALGridPointIndex *psPointIndex = psExtraParams->psPointIndex;
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -1798,21 +1875,20 @@ CPLErr GDALGridDataMetricCount(const void *poOptionsIn, GUInt32 nPoints,
     const double dfCoeff2 = bRotated ? sin(dfAngle) : 0.0;
 
     GUInt32 n = 0;
-    if (phQuadTree != nullptr)
+    if (psPointIndex != nullptr)
     {
         CPLRectObj sAoi;
         sAoi.minx = dfXPoint - dfSearchRadius;
         sAoi.miny = dfYPoint - dfSearchRadius;
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
-        int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        const auto &anPointIdx = GDALGridSearchPoints(psExtraParams, sAoi);
+        const int nFeatureCount = static_cast<int>(anPointIdx.size());
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
             {
-                const int i = papsPoints[k]->i;
+                const int i = anPointIdx[k];
                 const double dfRX = padfX[i] - dfXPoint;
                 const double dfRY = padfY[i] - dfYPoint;
 
@@ -1824,7 +1900,6 @@ CPLErr GDALGridDataMetricCount(const void *poOptionsIn, GUInt32 nPoints,
                 }
             }
         }
-        CPLFree(papsPoints);
     }
     else
     {
@@ -1894,24 +1969,22 @@ static CPLErr GDALGridDataMetricCountPerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->psPointIndex);
 
     CPLRectObj sAoi;
     sAoi.minx = dfXPoint - dfSearchRadius;
     sAoi.miny = dfYPoint - dfSearchRadius;
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
-    int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+    const auto &anPointIdx = GDALGridSearchPoints(psExtraParams, sAoi);
+    const int nFeatureCount = static_cast<int>(anPointIdx.size());
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
     if (nFeatureCount != 0)
     {
         for (int k = 0; k < nFeatureCount; k++)
         {
-            const int i = papsPoints[k]->i;
+            const int i = anPointIdx[k];
             const double dfRX = padfX[i] - dfXPoint;
             const double dfRY = padfY[i] - dfYPoint;
             const double dfRXSquare = dfRX * dfRX;
@@ -1927,7 +2000,6 @@ static CPLErr GDALGridDataMetricCountPerQuadrant(
             }
         }
     }
-    CPLFree(papsPoints);
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -2049,7 +2121,7 @@ CPLErr GDALGridDataMetricAverageDistance(const void *poOptionsIn,
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
+    const GDALGridPointIndex *psPointIndex = psExtraParams->psPointIndex;
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -2059,21 +2131,20 @@ CPLErr GDALGridDataMetricAverageDistance(const void *poOptionsIn,
 
     double dfAccumulator = 0.0;
     GUInt32 n = 0;
-    if (phQuadTree != nullptr)
+    if (psPointIndex != nullptr)
     {
         CPLRectObj sAoi;
         sAoi.minx = dfXPoint - dfSearchRadius;
         sAoi.miny = dfYPoint - dfSearchRadius;
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
-        int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        const auto &anPointIdx = GDALGridSearchPoints(psExtraParams, sAoi);
+        const int nFeatureCount = static_cast<int>(anPointIdx.size());
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
             {
-                const int i = papsPoints[k]->i;
+                const int i = anPointIdx[k];
                 const double dfRX = padfX[i] - dfXPoint;
                 const double dfRY = padfY[i] - dfYPoint;
 
@@ -2086,7 +2157,6 @@ CPLErr GDALGridDataMetricAverageDistance(const void *poOptionsIn,
                 }
             }
         }
-        CPLFree(papsPoints);
     }
     else
     {
@@ -2158,24 +2228,22 @@ static CPLErr GDALGridDataMetricAverageDistancePerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->psPointIndex);
 
     CPLRectObj sAoi;
     sAoi.minx = dfXPoint - dfSearchRadius;
     sAoi.miny = dfYPoint - dfSearchRadius;
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
-    int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+    const auto &anPointIdx = GDALGridSearchPoints(psExtraParams, sAoi);
+    const int nFeatureCount = static_cast<int>(anPointIdx.size());
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
     if (nFeatureCount != 0)
     {
         for (int k = 0; k < nFeatureCount; k++)
         {
-            const int i = papsPoints[k]->i;
+            const int i = anPointIdx[k];
             const double dfRX = padfX[i] - dfXPoint;
             const double dfRY = padfY[i] - dfYPoint;
             const double dfRXSquare = dfRX * dfRX;
@@ -2191,7 +2259,6 @@ static CPLErr GDALGridDataMetricAverageDistancePerQuadrant(
             }
         }
     }
-    CPLFree(papsPoints);
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -2315,7 +2382,7 @@ CPLErr GDALGridDataMetricAverageDistancePts(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
+    const GDALGridPointIndex *psPointIndex = psExtraParams->psPointIndex;
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -2325,21 +2392,20 @@ CPLErr GDALGridDataMetricAverageDistancePts(
 
     double dfAccumulator = 0.0;
     GUInt32 n = 0;
-    if (phQuadTree != nullptr)
+    if (psPointIndex != nullptr)
     {
         CPLRectObj sAoi;
         sAoi.minx = dfXPoint - dfSearchRadius;
         sAoi.miny = dfYPoint - dfSearchRadius;
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
-        int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        const auto &anPointIdx = GDALGridSearchPoints(psExtraParams, sAoi);
+        const int nFeatureCount = static_cast<int>(anPointIdx.size());
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount - 1; k++)
             {
-                const int i = papsPoints[k]->i;
+                const int i = anPointIdx[k];
                 const double dfRX1 = padfX[i] - dfXPoint;
                 const double dfRY1 = padfY[i] - dfYPoint;
 
@@ -2351,7 +2417,7 @@ CPLErr GDALGridDataMetricAverageDistancePts(
                     // Search all the remaining points within the ellipse and
                     // compute distances between them and the first point.
                     {
-                        const int ji = papsPoints[j]->i;
+                        const int ji = anPointIdx[j];
                         double dfRX2 = padfX[ji] - dfXPoint;
                         double dfRY2 = padfY[ji] - dfYPoint;
 
@@ -2369,7 +2435,6 @@ CPLErr GDALGridDataMetricAverageDistancePts(
                 }
             }
         }
-        CPLFree(papsPoints);
     }
     else
     {
@@ -2653,8 +2718,10 @@ static void GDALGridJobProcess(void *user_data)
     const void *poOptions = psJob->poOptions;
     GDALGridFunction pfnGDALGridMethod = psJob->pfnGDALGridMethod;
     // Have a local copy of sExtraParameters since we want to modify
-    // nInitialFacetIdx.
+    // nInitialFacetIdx, and attach search buffers private to this job.
     GDALGridExtraParameters sExtraParameters = *psJob->psExtraParameters;
+    GDALGridSearchBuffers sSearchBuffers;
+    sExtraParameters.psSearchBuffers = &sSearchBuffers;
     const GDALDataType eType = psJob->eType;
 
     const int nDataTypeSize = GDALGetDataTypeSizeBytes(eType);
@@ -2705,8 +2772,6 @@ struct GDALGridContext
     GDALGridFunction pfnGDALGridMethod;
 
     GUInt32 nPoints;
-    GDALGridPoint *pasGridPoints;
-    GDALGridXYArrays sXYArrays;
 
     GDALGridExtraParameters sExtraParameters;
     double *padfX;
@@ -2714,10 +2779,12 @@ struct GDALGridContext
     double *padfZ;
     bool bFreePadfXYZArrays;
 
-    CPLWorkerThreadPool *poWorkerThreadPool;
+    // Job queue on the global thread pool, and number of jobs to use
+    CPLJobQueue *poJobQueue;
+    int nThreads;
 };
 
-static void GDALGridContextCreateQuadTree(GDALGridContext *psContext);
+static void GDALGridContextCreatePointIndex(GDALGridContext *psContext);
 
 /**
  * Creates a context to do regular gridding from the scattered data.
@@ -2770,7 +2837,7 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
     CPLAssert(padfX);
     CPLAssert(padfY);
     CPLAssert(padfZ);
-    bool bCreateQuadTree = false;
+    bool bCreatePointIndex = false;
 
     const unsigned int nPointCountThreshold =
         atoi(CPLGetConfigOption("GDAL_GRID_POINT_COUNT_THRESHOLD", "100"));
@@ -2900,6 +2967,9 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
             else
             {
                 pfnGDALGridMethod = GDALGridInverseDistanceToAPower;
+                bCreatePointIndex = (nPoints > nPointCountThreshold &&
+                                     poPower->dfRadius1 > 0 &&
+                                     poPower->dfRadius2 > 0);
             }
             break;
         }
@@ -2931,7 +3001,7 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
                 pfnGDALGridMethod =
                     GDALGridInverseDistanceToAPowerNearestNeighbor;
             }
-            bCreateQuadTree = true;
+            bCreatePointIndex = true;
             break;
         }
         case GGA_MovingAverage:
@@ -2952,12 +3022,12 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
                 poOptionsOld->nMaxPointsPerQuadrant != 0)
             {
                 pfnGDALGridMethod = GDALGridMovingAveragePerQuadrant;
-                bCreateQuadTree = true;
+                bCreatePointIndex = true;
             }
             else
             {
                 pfnGDALGridMethod = GDALGridMovingAverage;
-                bCreateQuadTree = (nPoints > nPointCountThreshold &&
+                bCreatePointIndex = (nPoints > nPointCountThreshold &&
                                    poOptionsOld->dfAngle == 0.0 &&
                                    (poOptionsOld->dfRadius1 > 0.0 ||
                                     poOptionsOld->dfRadius2 > 0.0));
@@ -2979,7 +3049,7 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
                    sizeof(GDALGridNearestNeighborOptions));
 
             pfnGDALGridMethod = GDALGridNearestNeighbor;
-            bCreateQuadTree = (nPoints > nPointCountThreshold &&
+            bCreatePointIndex = (nPoints > nPointCountThreshold &&
                                poOptionsOld->dfAngle == 0.0 &&
                                (poOptionsOld->dfRadius1 > 0.0 ||
                                 poOptionsOld->dfRadius2 > 0.0));
@@ -3002,12 +3072,12 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
                 poOptionsOld->nMaxPointsPerQuadrant != 0)
             {
                 pfnGDALGridMethod = GDALGridDataMetricMinimumPerQuadrant;
-                bCreateQuadTree = true;
+                bCreatePointIndex = true;
             }
             else
             {
                 pfnGDALGridMethod = GDALGridDataMetricMinimum;
-                bCreateQuadTree = (nPoints > nPointCountThreshold &&
+                bCreatePointIndex = (nPoints > nPointCountThreshold &&
                                    poOptionsOld->dfAngle == 0.0 &&
                                    (poOptionsOld->dfRadius1 > 0.0 ||
                                     poOptionsOld->dfRadius2 > 0.0));
@@ -3031,12 +3101,12 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
                 poOptionsOld->nMaxPointsPerQuadrant != 0)
             {
                 pfnGDALGridMethod = GDALGridDataMetricMaximumPerQuadrant;
-                bCreateQuadTree = true;
+                bCreatePointIndex = true;
             }
             else
             {
                 pfnGDALGridMethod = GDALGridDataMetricMaximum;
-                bCreateQuadTree = (nPoints > nPointCountThreshold &&
+                bCreatePointIndex = (nPoints > nPointCountThreshold &&
                                    poOptionsOld->dfAngle == 0.0 &&
                                    (poOptionsOld->dfRadius1 > 0.0 ||
                                     poOptionsOld->dfRadius2 > 0.0));
@@ -3061,12 +3131,12 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
                 poOptionsOld->nMaxPointsPerQuadrant != 0)
             {
                 pfnGDALGridMethod = GDALGridDataMetricRangePerQuadrant;
-                bCreateQuadTree = true;
+                bCreatePointIndex = true;
             }
             else
             {
                 pfnGDALGridMethod = GDALGridDataMetricRange;
-                bCreateQuadTree = (nPoints > nPointCountThreshold &&
+                bCreatePointIndex = (nPoints > nPointCountThreshold &&
                                    poOptionsOld->dfAngle == 0.0 &&
                                    (poOptionsOld->dfRadius1 > 0.0 ||
                                     poOptionsOld->dfRadius2 > 0.0));
@@ -3091,12 +3161,12 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
                 poOptionsOld->nMaxPointsPerQuadrant != 0)
             {
                 pfnGDALGridMethod = GDALGridDataMetricCountPerQuadrant;
-                bCreateQuadTree = true;
+                bCreatePointIndex = true;
             }
             else
             {
                 pfnGDALGridMethod = GDALGridDataMetricCount;
-                bCreateQuadTree = (nPoints > nPointCountThreshold &&
+                bCreatePointIndex = (nPoints > nPointCountThreshold &&
                                    poOptionsOld->dfAngle == 0.0 &&
                                    (poOptionsOld->dfRadius1 > 0.0 ||
                                     poOptionsOld->dfRadius2 > 0.0));
@@ -3122,12 +3192,12 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
             {
                 pfnGDALGridMethod =
                     GDALGridDataMetricAverageDistancePerQuadrant;
-                bCreateQuadTree = true;
+                bCreatePointIndex = true;
             }
             else
             {
                 pfnGDALGridMethod = GDALGridDataMetricAverageDistance;
-                bCreateQuadTree = (nPoints > nPointCountThreshold &&
+                bCreatePointIndex = (nPoints > nPointCountThreshold &&
                                    poOptionsOld->dfAngle == 0.0 &&
                                    (poOptionsOld->dfRadius1 > 0.0 ||
                                     poOptionsOld->dfRadius2 > 0.0));
@@ -3149,7 +3219,7 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
             memcpy(poOptionsNew, poOptions, sizeof(GDALGridDataMetricsOptions));
 
             pfnGDALGridMethod = GDALGridDataMetricAverageDistancePts;
-            bCreateQuadTree = (nPoints > nPointCountThreshold &&
+            bCreatePointIndex = (nPoints > nPointCountThreshold &&
                                poOptionsOld->dfAngle == 0.0 &&
                                (poOptionsOld->dfRadius1 > 0.0 ||
                                 poOptionsOld->dfRadius2 > 0.0));
@@ -3207,10 +3277,8 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
     psContext->poOptions = poOptionsNew;
     psContext->pfnGDALGridMethod = pfnGDALGridMethod;
     psContext->nPoints = nPoints;
-    psContext->pasGridPoints = nullptr;
-    psContext->sXYArrays.padfX = padfX;
-    psContext->sXYArrays.padfY = padfY;
-    psContext->sExtraParameters.hQuadTree = nullptr;
+    psContext->sExtraParameters.psPointIndex = nullptr;
+    psContext->sExtraParameters.psSearchBuffers = nullptr;
     psContext->sExtraParameters.dfInitialSearchRadius = 0.0;
     psContext->sExtraParameters.pafX = pafXAligned;
     psContext->sExtraParameters.pafY = pafYAligned;
@@ -3224,12 +3292,12 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
         pafXAligned ? false : !bCallerWillKeepPointArraysAlive;
 
     /* -------------------------------------------------------------------- */
-    /*  Create quadtree if requested and possible.                          */
+    /*  Create point index if requested and possible.                       */
     /* -------------------------------------------------------------------- */
-    if (bCreateQuadTree)
+    if (bCreatePointIndex)
     {
-        GDALGridContextCreateQuadTree(psContext);
-        if (psContext->sExtraParameters.hQuadTree == nullptr &&
+        GDALGridContextCreatePointIndex(psContext);
+        if (psContext->sExtraParameters.psPointIndex == nullptr &&
             (eAlgorithm == GGA_InverseDistanceToAPowerNearestNeighbor ||
              pfnGDALGridMethod == GDALGridMovingAveragePerQuadrant))
         {
@@ -3283,72 +3351,134 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
         nThreads = atoi(pszThreads);
     if (nThreads > 128)
         nThreads = 128;
+    psContext->poJobQueue = nullptr;
+    psContext->nThreads = 1;
     if (nThreads > 1)
     {
-        psContext->poWorkerThreadPool = new CPLWorkerThreadPool();
-        if (!psContext->poWorkerThreadPool->Setup(nThreads, nullptr, nullptr))
-        {
-            delete psContext->poWorkerThreadPool;
-            psContext->poWorkerThreadPool = nullptr;
-        }
-        else
+        // Use the global thread pool, so that the threads are shared with
+        // other multi-threaded operations of the process.
+        CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+        if (poThreadPool)
         {
+            psContext->poJobQueue = poThreadPool->CreateJobQueue().release();
+            psContext->nThreads = nThreads;
             CPLDebug("GDAL_GRID", "Using %d threads", nThreads);
         }
     }
-    else
-        psContext->poWorkerThreadPool = nullptr;
 
     return psContext;
 }
 
 /************************************************************************/
-/*                      GDALGridContextCreateQuadTree()                 */
+/*                      GDALGridContextCreatePointIndex()                 */
 /************************************************************************/
 
-void GDALGridContextCreateQuadTree(GDALGridContext *psContext)
+void GDALGridContextCreatePointIndex(GDALGridContext *psContext)
 {
     const GUInt32 nPoints = psContext->nPoints;
-    psContext->pasGridPoints = static_cast<GDALGridPoint *>(
-        VSI_MALLOC2_VERBOSE(nPoints, sizeof(GDALGridPoint)));
-    if (psContext->pasGridPoints != nullptr)
+    const double *const padfX = psContext->padfX;
+    const double *const padfY = psContext->padfY;
+
+    // Determine point extents.
+    double dfMinX = padfX[0];
+    double dfMinY = padfY[0];
+    double dfMaxX = padfX[0];
+    double dfMaxY = padfY[0];
+    for (GUInt32 i = 1; i < nPoints; i++)
     {
-        const double *const padfX = psContext->padfX;
-        const double *const padfY = psContext->padfY;
-
-        // Determine point extents.
-        CPLRectObj sRect;
-        sRect.minx = padfX[0];
-        sRect.miny = padfY[0];
-        sRect.maxx = padfX[0];
-        sRect.maxy = padfY[0];
-        for (GUInt32 i = 1; i < nPoints; i++)
-        {
-            if (padfX[i] < sRect.minx)
-                sRect.minx = padfX[i];
-            if (padfY[i] < sRect.miny)
-                sRect.miny = padfY[i];
-            if (padfX[i] > sRect.maxx)
-                sRect.maxx = padfX[i];
-            if (padfY[i] > sRect.maxy)
-                sRect.maxy = padfY[i];
-        }
-
-        // Initial value for search radius is the typical dimension of a
-        // "pixel" of the point array (assuming rather uniform distribution).
-        psContext->sExtraParameters.dfInitialSearchRadius = sqrt(
-            (sRect.maxx - sRect.minx) * (sRect.maxy - sRect.miny) / nPoints);
+        if (padfX[i] < dfMinX)
+            dfMinX = padfX[i];
+        if (padfY[i] < dfMinY)
+            dfMinY = padfY[i];
+        if (padfX[i] > dfMaxX)
+            dfMaxX = padfX[i];
+        if (padfY[i] > dfMaxY)
+            dfMaxY = padfY[i];
+    }
 
-        psContext->sExtraParameters.hQuadTree =
-            CPLQuadTreeCreate(&sRect, GDALGridGetPointBounds);
+    // Initial value for search radius is the typical dimension of a
+    // "pixel" of the point array (assuming rather uniform distribution).
+    psContext->sExtraParameters.dfInitialSearchRadius =
+        sqrt((dfMaxX - dfMinX) * (dfMaxY - dfMinY) / nPoints);
+
+    // Size cells so that they hold a couple of points on average, which
+    // keeps the number of visited cells and of rejected points balanced.
+    // Degenerate extents (points aligned along an axis) fall back to a
+    // cell size derived from the largest dimension.
+    const double dfWidth = dfMaxX - dfMinX;
+    const double dfHeight = dfMaxY - dfMinY;
+    double dfCellSize = sqrt(dfWidth * dfHeight / (nPoints / 2.0 + 1));
+    if (!(dfCellSize > 0))
+        dfCellSize = std::max(dfWidth, dfHeight) / (nPoints / 2.0 + 1);
+    if (!(dfCellSize > 0) || !std::isfinite(dfCellSize))
+        dfCellSize = 1.0;
+    // Cap the number of cells to a small multiple of the number of points.
+    constexpr double MAX_CELLS_PER_DIM = 1 << 15;
+    const double dfMaxCells = std::max(4.0 * nPoints, 1.0);
+    while (std::floor(dfWidth / dfCellSize) + 1 > MAX_CELLS_PER_DIM ||
+           std::floor(dfHeight / dfCellSize) + 1 > MAX_CELLS_PER_DIM ||
+           (std::floor(dfWidth / dfCellSize) + 1) *
+                   (std::floor(dfHeight / dfCellSize) + 1) >
+               dfMaxCells)
+    {
+        dfCellSize *= 2;
+    }
 
+    try
+    {
+        auto poPointIndex = std::make_unique<GDALGridPointIndex>();
+        poPointIndex->dfMinX = dfMinX;
+        poPointIndex->dfMinY = dfMinY;
+        poPointIndex->dfInvCellSize = 1.0 / dfCellSize;
+        poPointIndex->nCellsX =
+            static_cast<int>(std::floor(dfWidth / dfCellSize)) + 1;
+        poPointIndex->nCellsY =
+            static_cast<int>(std::floor(dfHeight / dfCellSize)) + 1;
+        const int nCellsX = poPointIndex->nCellsX;
+        const int nCellsY = poPointIndex->nCellsY;
+
+        const auto GetCell = [&poPointIndex, nCellsX, nCellsY](double dfX,
+                                                               double dfY)
+        {
+            const int iX = std::min(
+                nCellsX - 1,
+                static_cast<int>((dfX - poPointIndex->dfMinX) *
+                                 poPointIndex->dfInvCellSize));
+            const int iY = std::min(
+                nCellsY - 1,
+                static_cast<int>((dfY - poPointIndex->dfMinY) *
+                                 poPointIndex->dfInvCellSize));
+            return iY * nCellsX + iX;
+        };
+
+        // Counting sort of the points by cell. Iterating in increasing point
+        // index keeps points of a given cell ordered by index.
+        auto &anCellStart = poPointIndex->anCellStart;
+        anCellStart.resize(static_cast<size_t>(nCellsX) * nCellsY + 1);
+        for (GUInt32 i = 0; i < nPoints; i++)
+            anCellStart[GetCell(padfX[i], padfY[i]) + 1]++;
+        for (size_t i = 1; i < anCellStart.size(); i++)
+            anCellStart[i] += anCellStart[i - 1];
+
+        poPointIndex->anPointIdx.resize(nPoints);
+        poPointIndex->adfX.resize(nPoints);
+        poPointIndex->adfY.resize(nPoints);
+        std::vector<int> anCellFill(anCellStart.begin(),
+                                    anCellStart.end() - 1);
         for (GUInt32 i = 0; i < nPoints; i++)
         {
-            psContext->pasGridPoints[i].psXYArrays = &(psContext->sXYArrays);
-            psContext->pasGridPoints[i].i = i;
-            CPLQuadTreeInsert(psContext->sExtraParameters.hQuadTree,
-                              psContext->pasGridPoints + i);
+            const int nPos = anCellFill[GetCell(padfX[i], padfY[i])]++;
+            poPointIndex->anPointIdx[nPos] = static_cast<int>(i);
+            poPointIndex->adfX[nPos] = padfX[i];
+            poPointIndex->adfY[nPos] = padfY[i];
         }
+
+        psContext->sExtraParameters.psPointIndex = poPointIndex.release();
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate point index: %s", e.what());
     }
 }
 
@@ -3368,9 +3498,7 @@ void GDALGridContextFree(GDALGridContext *psContext)
     if (psContext)
     {
         CPLFree(psContext->poOptions);
-        CPLFree(psContext->pasGridPoints);
-        if (psContext->sExtraParameters.hQuadTree != nullptr)
-            CPLQuadTreeDestroy(psContext->sExtraParameters.hQuadTree);
+        delete psContext->sExtraParameters.psPointIndex;
         if (psContext->bFreePadfXYZArrays)
         {
             CPLFree(psContext->padfX);
@@ -3382,7 +3510,7 @@ void GDALGridContextFree(GDALGridContext *psContext)
         VSIFreeAligned(psContext->sExtraParameters.pafZ);
         if (psContext->sExtraParameters.psTriangulation)
             GDALTriangulationFree(psContext->sExtraParameters.psTriangulation);
-        delete psContext->poWorkerThreadPool;
+        delete psContext->poJobQueue;
         CPLFree(psContext);
     }
 }
@@ -3440,7 +3568,7 @@ CPLErr GDALGridContextProcess(GDALGridContext *psContext, double dfXMin,
     // by sampling along the edges.  If all points on edges are within
     // triangles, then interior points will also be.
     if (psContext->eAlgorithm == GGA_Linear &&
-        psContext->sExtraParameters.hQuadTree == nullptr)
+        psContext->sExtraParameters.psPointIndex == nullptr)
     {
         bool bNeedNearest = false;
         int nStartLeft = 0;
@@ -3489,7 +3617,7 @@ CPLErr GDALGridContextProcess(GDALGridContext *psContext, double dfXMin,
         if (bNeedNearest)
         {
             CPLDebug("GDAL_GRID", "Will need nearest neighbour");
-            GDALGridContextCreateQuadTree(psContext);
+            GDALGridContextCreatePointIndex(psContext);
         }
     }
 
@@ -3521,7 +3649,7 @@ CPLErr GDALGridContextProcess(GDALGridContext *psContext, double dfXMin,
     sJob.hCond = nullptr;
     sJob.hCondMutex = nullptr;
 
-    if (psContext->poWorkerThreadPool == nullptr)
+    if (psContext->poJobQueue == nullptr)
     {
         if (sJob.pfnRealProgress != nullptr &&
             sJob.pfnRealProgress != GDALDummyProgress)
@@ -3533,7 +3661,7 @@ CPLErr GDALGridContextProcess(GDALGridContext *psContext, double dfXMin,
     }
     else
     {
-        int nThreads = psContext->poWorkerThreadPool->GetThreadCount();
+        const int nThreads = psContext->nThreads;
         GDALGridJob *pasJobs = static_cast<GDALGridJob *>(
             CPLMalloc(sizeof(GDALGridJob) * nThreads));
 
@@ -3551,8 +3679,7 @@ CPLErr GDALGridContextProcess(GDALGridContext *psContext, double dfXMin,
         {
             memcpy(&pasJobs[i], &sJob, sizeof(GDALGridJob));
             pasJobs[i].nYStart = i;
-            psContext->poWorkerThreadPool->SubmitJob(GDALGridJobProcess,
-                                                     &pasJobs[i]);
+            psContext->poJobQueue->SubmitJob(GDALGridJobProcess, &pasJobs[i]);
         }
 
         /* --------------------------------------------------------------------
@@ -3587,7 +3714,7 @@ CPLErr GDALGridContextProcess(GDALGridContext *psContext, double dfXMin,
         /*      Wait for all threads to complete and finish. */
         /* --------------------------------------------------------------------
          */
-        psContext->poWorkerThreadPool->WaitCompletion();
+        psContext->poJobQueue->WaitCompletion();
 
         CPLFree(pasJobs);
         CPLDestroyCond(sJob.hCond);
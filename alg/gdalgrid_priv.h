@@ -35,23 +35,46 @@
 
 #include "gdal_alg.h"
 
+#include <vector>
+
 //! @cond Doxygen_Suppress
 
-typedef struct
+/** Uniform grid of buckets over the input points, stored in compressed
+ * row form: the points of cell c are at positions
+ * [anCellStart[c], anCellStart[c+1]) of anPointIdx, adfX and adfY.
+ * Within a cell, points are kept in increasing index order. */
+struct GDALGridPointIndex
 {
-    const double *padfX;
-    const double *padfY;
-} GDALGridXYArrays;
+    double dfMinX = 0;
+    double dfMinY = 0;
+    double dfInvCellSize = 0;
+    int nCellsX = 0;
+    int nCellsY = 0;
+    std::vector<int> anCellStart{};
+    std::vector<int> anPointIdx{};
+    std::vector<double> adfX{};
+    std::vector<double> adfY{};
+};
 
-typedef struct
+/** Neighbour candidate, as collected by the nearest neighbour methods. */
+struct GDALGridNeighbor
+{
+    double dfR2;
+    double dfZ;
+    int nIdx;
+};
+
+/** Per-job scratch buffers reused from one grid node to the next. */
+struct GDALGridSearchBuffers
 {
-    GDALGridXYArrays *psXYArrays;
-    int i;
-} GDALGridPoint;
+    std::vector<int> anPointIdx{};
+    std::vector<GDALGridNeighbor> asNeighbors{};
+};
 
 typedef struct
 {
-    CPLQuadTree *hQuadTree;
+    GDALGridPointIndex *psPointIndex;
+    GDALGridSearchBuffers *psSearchBuffers;
     double dfInitialSearchRadius;
     float *pafX;  // Aligned to be usable with AVX
     float *pafY;
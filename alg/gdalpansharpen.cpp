@@ -38,7 +38,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <limits>
+#include <map>
 #include <new>
+#include <string>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -670,6 +672,11 @@ void GDALPansharpenOperation::WeightedBrovey3(
 
 #include "gdalsse_priv.h"
 
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+#include "cpl_cpu_features.h"
+#include "gdalpansharpen_avx2.h"
+#endif
+
 template <class T, int NINPUT, int NOUTPUT>
 size_t GDALPansharpenOperation::WeightedBroveyPositiveWeightsInternal(
     const T *pPanBuffer, const T *pUpsampledSpectralBuffer, T *pDataBuf,
@@ -694,6 +701,14 @@ size_t GDALPansharpenOperation::WeightedBroveyPositiveWeightsInternal(
         XMMReg4Double::Load1ValHighAndLow(&dfMaxValue);
 
     size_t j = 0;  // Used after for.
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+    if (CPLHaveRuntimeAVX2())
+    {
+        j = GDALPansharpenWeightedBroveyPositiveWeights_AVX2(
+            pPanBuffer, pUpsampledSpectralBuffer, pDataBuf, nValues,
+            nBandValues, nMaxValue, psOptions->padfWeights, NINPUT, NOUTPUT);
+    }
+#endif
     for (; j + 3 < nValues; j += 4)
     {
         XMMReg4Double pseudoPanchro = zero;
@@ -1198,16 +1213,6 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
         return CE_Failure;
     }
 
-    CPLErr eErr = poPanchroBand->RasterIO(GF_Read, nXOff, nYOff, nXSize, nYSize,
-                                          pPanBuffer, nXSize, nYSize,
-                                          eWorkDataType, 0, 0, nullptr);
-    if (eErr != CE_None)
-    {
-        VSIFree(pUpsampledSpectralBuffer);
-        VSIFree(pPanBuffer);
-        return CE_Failure;
-    }
-
     int nTasks = 0;
     if (poThreadPool)
     {
@@ -1241,15 +1246,44 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
 
     // When upsampling, extract the multispectral data at
     // full resolution in a temp buffer, and then do the upsampling.
-    if (nSpectralXSize < nXSize && nSpectralYSize < nYSize &&
-        eResampleAlg != GRIORA_NearestNeighbour && nYSize > 1)
+    const bool bUpsampleFromTempBuffer =
+        nSpectralXSize < nXSize && nSpectralYSize < nYSize &&
+        eResampleAlg != GRIORA_NearestNeighbour && nYSize > 1;
+
+    /* -------------------------------------------------------------------- */
+    /*      Collect the reads of the panchromatic and multispectral         */
+    /*      sources, so that the ones from different datasets can be        */
+    /*      done in parallel.                                               */
+    /* -------------------------------------------------------------------- */
+    std::vector<GDALPansharpenReadRequest> aoReadRequests;
+    {
+        GDALPansharpenReadRequest oReq;
+        oReq.osSourceKey = GetSourceKey(psOptions->hPanchroBand);
+        oReq.poBand = poPanchroBand;
+        oReq.nXOff = nXOff;
+        oReq.nYOff = nYOff;
+        oReq.nXSize = nXSize;
+        oReq.nYSize = nYSize;
+        oReq.pBuffer = pPanBuffer;
+        oReq.nBufXSize = nXSize;
+        oReq.nBufYSize = nYSize;
+        oReq.eDT = eWorkDataType;
+        aoReadRequests.push_back(std::move(oReq));
+    }
+
+    int nXOffExtract = 0;
+    int nYOffExtract = 0;
+    int nXSizeExtract = 0;
+    int nYSizeExtract = 0;
+    GByte *pSpectralBuffer = nullptr;
+    if (bUpsampleFromTempBuffer)
     {
         // Take some margin to take into account the radius of the
         // resampling kernel.
-        int nXOffExtract = nSpectralXOff - nKernelRadius;
-        int nYOffExtract = nSpectralYOff - nKernelRadius;
-        int nXSizeExtract = nSpectralXSize + 1 + 2 * nKernelRadius;
-        int nYSizeExtract = nSpectralYSize + 1 + 2 * nKernelRadius;
+        nXOffExtract = nSpectralXOff - nKernelRadius;
+        nYOffExtract = nSpectralYOff - nKernelRadius;
+        nXSizeExtract = nSpectralXSize + 1 + 2 * nKernelRadius;
+        nYSizeExtract = nSpectralYSize + 1 + 2 * nKernelRadius;
         if (nXOffExtract < 0)
         {
             nXSizeExtract += nXOffExtract;
@@ -1265,7 +1299,7 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
         if (nYOffExtract + nYSizeExtract > aMSBands[0]->GetYSize())
             nYSizeExtract = aMSBands[0]->GetYSize() - nYOffExtract;
 
-        GByte *pSpectralBuffer = static_cast<GByte *>(VSI_MALLOC3_VERBOSE(
+        pSpectralBuffer = static_cast<GByte *>(VSI_MALLOC3_VERBOSE(
             nXSizeExtract, nYSizeExtract,
             cpl::fits_on<int>(psOptions->nInputSpectralBands * nDataTypeSize)));
         if (pSpectralBuffer == nullptr)
@@ -1274,40 +1308,70 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
             VSIFree(pPanBuffer);
             return CE_Failure;
         }
+    }
 
+    for (int i = 0; i < psOptions->nInputSpectralBands; i++)
+    {
+        GDALPansharpenReadRequest oReq;
+        oReq.osSourceKey = GetSourceKey(psOptions->pahInputSpectralBands[i]);
         if (!anInputBands.empty())
         {
             // Use dataset RasterIO when possible.
-            eErr = aMSBands[0]->GetDataset()->RasterIO(
-                GF_Read, nXOffExtract, nYOffExtract, nXSizeExtract,
-                nYSizeExtract, pSpectralBuffer, nXSizeExtract, nYSizeExtract,
-                eWorkDataType, static_cast<int>(anInputBands.size()),
-                &anInputBands[0], 0, 0, 0, nullptr);
+            oReq.poDS = aMSBands[0]->GetDataset();
+            oReq.anBands = anInputBands;
         }
         else
         {
-            for (int i = 0;
-                 eErr == CE_None && i < psOptions->nInputSpectralBands; i++)
-            {
-                eErr = aMSBands[i]->RasterIO(
-                    GF_Read, nXOffExtract, nYOffExtract, nXSizeExtract,
-                    nYSizeExtract,
-                    pSpectralBuffer + static_cast<size_t>(i) * nXSizeExtract *
-                                          nYSizeExtract * nDataTypeSize,
-                    nXSizeExtract, nYSizeExtract, eWorkDataType, 0, 0, nullptr);
-            }
+            oReq.poBand = aMSBands[i];
         }
-        if (eErr != CE_None)
+        oReq.eDT = eWorkDataType;
+        if (bUpsampleFromTempBuffer)
         {
-            VSIFree(pSpectralBuffer);
-            VSIFree(pUpsampledSpectralBuffer);
-            VSIFree(pPanBuffer);
-            return CE_Failure;
+            oReq.nXOff = nXOffExtract;
+            oReq.nYOff = nYOffExtract;
+            oReq.nXSize = nXSizeExtract;
+            oReq.nYSize = nYSizeExtract;
+            oReq.pBuffer = pSpectralBuffer + static_cast<size_t>(i) *
+                                                 nXSizeExtract *
+                                                 nYSizeExtract * nDataTypeSize;
+            oReq.nBufXSize = nXSizeExtract;
+            oReq.nBufYSize = nYSizeExtract;
         }
+        else
+        {
+            oReq.nXOff = nSpectralXOff;
+            oReq.nYOff = nSpectralYOff;
+            oReq.nXSize = nSpectralXSize;
+            oReq.nYSize = nSpectralYSize;
+            oReq.pBuffer = pUpsampledSpectralBuffer +
+                           static_cast<size_t>(i) * nXSize * nYSize *
+                               nDataTypeSize;
+            oReq.nBufXSize = nXSize;
+            oReq.nBufYSize = nYSize;
+            oReq.bUseExtraArg = true;
+            oReq.sExtraArg = sExtraArg;
+        }
+        aoReadRequests.push_back(std::move(oReq));
+        if (!anInputBands.empty())
+            break;
+    }
+
+    CPLErr eErr = ReadSources(aoReadRequests);
+    if (eErr != CE_None)
+    {
+        VSIFree(pSpectralBuffer);
+        VSIFree(pUpsampledSpectralBuffer);
+        VSIFree(pPanBuffer);
+        return CE_Failure;
+    }
 
+    MEMDataset *poMEMDS = nullptr;
+    std::vector<GDALPansharpenResampleJob> asResampleJobs;
+    if (bUpsampleFromTempBuffer)
+    {
         // Create a MEM dataset that wraps the input buffer.
-        auto poMEMDS = MEMDataset::Create("", nXSizeExtract, nYSizeExtract, 0,
-                                          eWorkDataType, nullptr);
+        poMEMDS = MEMDataset::Create("", nXSizeExtract, nYSizeExtract, 0,
+                                     eWorkDataType, nullptr);
 
         for (int i = 0; i < psOptions->nInputSpectralBands; i++)
         {
@@ -1343,6 +1407,9 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
         }
         else
         {
+            // The resampling of each strip of lines is done by the job
+            // that pansharpens it afterwards (see PansharpenJobThreadFunc()).
+
             // We are abusing the contract of the GDAL API by using the
             // MEMDataset from several threads. In this case, this is safe. In
             // case, that would no longer be the case we could create as many
@@ -1355,116 +1422,59 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
                 poMEMDS->GetRasterBand(i + 1)->GetMaskFlags();
             }
 
-            std::vector<GDALPansharpenResampleJob> asJobs;
-            asJobs.resize(nTasks);
-            GDALPansharpenResampleJob *pasJobs = &(asJobs[0]);
+            asResampleJobs.resize(nTasks);
+            for (int i = 0; i < nTasks; i++)
             {
-                std::vector<void *> ahJobData;
-                ahJobData.resize(nTasks);
-
-#ifdef DEBUG_TIMING
-                struct timeval tv;
-#endif
-                for (int i = 0; i < nTasks; i++)
+                const size_t iStartLine =
+                    (static_cast<size_t>(i) * nYSize) / nTasks;
+                const size_t iNextStartLine =
+                    (static_cast<size_t>(i + 1) * nYSize) / nTasks;
+                GDALPansharpenResampleJob &sJob = asResampleJobs[i];
+                sJob.poMEMDS = poMEMDS;
+                sJob.eResampleAlg = eResampleAlg;
+                sJob.dfXOff = sExtraArg.dfXOff - nXOffExtract;
+                sJob.dfYOff = m_adfPanToMSGT[3] +
+                              (nYOff + iStartLine) * m_adfPanToMSGT[5] -
+                              nYOffExtract;
+                sJob.dfXSize = sExtraArg.dfXSize;
+                sJob.dfYSize =
+                    (iNextStartLine - iStartLine) * m_adfPanToMSGT[5];
+                if (sJob.dfXOff + sJob.dfXSize > aMSBands[0]->GetXSize())
                 {
-                    const size_t iStartLine =
-                        (static_cast<size_t>(i) * nYSize) / nTasks;
-                    const size_t iNextStartLine =
-                        (static_cast<size_t>(i + 1) * nYSize) / nTasks;
-                    pasJobs[i].poMEMDS = poMEMDS;
-                    pasJobs[i].eResampleAlg = eResampleAlg;
-                    pasJobs[i].dfXOff = sExtraArg.dfXOff - nXOffExtract;
-                    pasJobs[i].dfYOff =
-                        m_adfPanToMSGT[3] +
-                        (nYOff + iStartLine) * m_adfPanToMSGT[5] - nYOffExtract;
-                    pasJobs[i].dfXSize = sExtraArg.dfXSize;
-                    pasJobs[i].dfYSize =
-                        (iNextStartLine - iStartLine) * m_adfPanToMSGT[5];
-                    if (pasJobs[i].dfXOff + pasJobs[i].dfXSize >
-                        aMSBands[0]->GetXSize())
-                    {
-                        pasJobs[i].dfXOff =
-                            aMSBands[0]->GetXSize() - pasJobs[i].dfXSize;
-                    }
-                    if (pasJobs[i].dfYOff + pasJobs[i].dfYSize >
-                        aMSBands[0]->GetYSize())
-                    {
-                        pasJobs[i].dfYOff =
-                            aMSBands[0]->GetYSize() - pasJobs[i].dfYSize;
-                    }
-                    pasJobs[i].nXOff = static_cast<int>(pasJobs[i].dfXOff);
-                    pasJobs[i].nYOff = static_cast<int>(pasJobs[i].dfYOff);
-                    pasJobs[i].nXSize =
-                        static_cast<int>(0.4999 + pasJobs[i].dfXSize);
-                    pasJobs[i].nYSize =
-                        static_cast<int>(0.4999 + pasJobs[i].dfYSize);
-                    if (pasJobs[i].nXSize == 0)
-                        pasJobs[i].nXSize = 1;
-                    if (pasJobs[i].nYSize == 0)
-                        pasJobs[i].nYSize = 1;
-                    pasJobs[i].pBuffer = pUpsampledSpectralBuffer +
-                                         static_cast<size_t>(iStartLine) *
-                                             nXSize * nDataTypeSize;
-                    pasJobs[i].eDT = eWorkDataType;
-                    pasJobs[i].nBufXSize = nXSize;
-                    pasJobs[i].nBufYSize =
-                        static_cast<int>(iNextStartLine - iStartLine);
-                    pasJobs[i].nBandCount = psOptions->nInputSpectralBands;
-                    pasJobs[i].nBandSpace =
-                        static_cast<GSpacing>(nXSize) * nYSize * nDataTypeSize;
-#ifdef DEBUG_TIMING
-                    pasJobs[i].ptv = &tv;
-#endif
-                    ahJobData[i] = &(pasJobs[i]);
+                    sJob.dfXOff = aMSBands[0]->GetXSize() - sJob.dfXSize;
                 }
+                if (sJob.dfYOff + sJob.dfYSize > aMSBands[0]->GetYSize())
+                {
+                    sJob.dfYOff = aMSBands[0]->GetYSize() - sJob.dfYSize;
+                }
+                sJob.nXOff = static_cast<int>(sJob.dfXOff);
+                sJob.nYOff = static_cast<int>(sJob.dfYOff);
+                sJob.nXSize = static_cast<int>(0.4999 + sJob.dfXSize);
+                sJob.nYSize = static_cast<int>(0.4999 + sJob.dfYSize);
+                if (sJob.nXSize == 0)
+                    sJob.nXSize = 1;
+                if (sJob.nYSize == 0)
+                    sJob.nYSize = 1;
+                sJob.pBuffer = pUpsampledSpectralBuffer +
+                               static_cast<size_t>(iStartLine) * nXSize *
+                                   nDataTypeSize;
+                sJob.eDT = eWorkDataType;
+                sJob.nBufXSize = nXSize;
+                sJob.nBufYSize = static_cast<int>(iNextStartLine - iStartLine);
+                sJob.nBandCount = psOptions->nInputSpectralBands;
+                sJob.nBandSpace =
+                    static_cast<GSpacing>(nXSize) * nYSize * nDataTypeSize;
 #ifdef DEBUG_TIMING
-                gettimeofday(&tv, nullptr);
+                sJob.ptv = nullptr;
 #endif
-                poThreadPool->SubmitJobs(PansharpenResampleJobThreadFunc,
-                                         ahJobData);
-                poThreadPool->WaitCompletion();
-            }
-        }
-
-        GDALClose(poMEMDS);
-
-        VSIFree(pSpectralBuffer);
-    }
-    else
-    {
-        if (!anInputBands.empty())
-        {
-            // Use dataset RasterIO when possible.
-            eErr = aMSBands[0]->GetDataset()->RasterIO(
-                GF_Read, nSpectralXOff, nSpectralYOff, nSpectralXSize,
-                nSpectralYSize, pUpsampledSpectralBuffer, nXSize, nYSize,
-                eWorkDataType, static_cast<int>(anInputBands.size()),
-                &anInputBands[0], 0, 0, 0, &sExtraArg);
-        }
-        else
-        {
-            for (int i = 0;
-                 eErr == CE_None && i < psOptions->nInputSpectralBands; i++)
-            {
-                eErr = aMSBands[i]->RasterIO(
-                    GF_Read, nSpectralXOff, nSpectralYOff, nSpectralXSize,
-                    nSpectralYSize,
-                    pUpsampledSpectralBuffer + static_cast<size_t>(i) * nXSize *
-                                                   nYSize * nDataTypeSize,
-                    nXSize, nYSize, eWorkDataType, 0, 0, &sExtraArg);
             }
         }
-        if (eErr != CE_None)
-        {
-            VSIFree(pUpsampledSpectralBuffer);
-            VSIFree(pPanBuffer);
-            return CE_Failure;
-        }
     }
 
     // In case NBITS was not set on the spectral bands, clamp the values
     // if overshoot might have occurred.
-    int nBitDepth = psOptions->nBitDepth;
+    const int nBitDepth = psOptions->nBitDepth;
+    std::vector<int> anBandsToClamp;
     if (nBitDepth &&
         (eResampleAlg == GRIORA_Cubic || eResampleAlg == GRIORA_CubicSpline ||
          eResampleAlg == GRIORA_Lanczos))
@@ -1478,35 +1488,18 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
             if (pszNBITS)
                 nBandBitDepth = atoi(pszNBITS);
             if (nBandBitDepth < nBitDepth)
-            {
-                if (eWorkDataType == GDT_Byte)
-                {
-                    ClampValues(
-                        reinterpret_cast<GByte *>(pUpsampledSpectralBuffer) +
-                            static_cast<size_t>(i) * nXSize * nYSize,
-                        static_cast<size_t>(nXSize) * nYSize,
-                        static_cast<GByte>((1 << nBitDepth) - 1));
-                }
-                else if (eWorkDataType == GDT_UInt16)
-                {
-                    ClampValues(
-                        reinterpret_cast<GUInt16 *>(pUpsampledSpectralBuffer) +
-                            static_cast<size_t>(i) * nXSize * nYSize,
-                        static_cast<size_t>(nXSize) * nYSize,
-                        static_cast<GUInt16>((1 << nBitDepth) - 1));
-                }
-#ifndef LIMIT_TYPES
-                else if (eWorkDataType == GDT_UInt32)
-                {
-                    ClampValues(reinterpret_cast<GUInt32*>(pUpsampledSpectralBuffer) +
-                                static_cast<size_t>(i) * nXSize * nYSize,
-                                static_cast<size_t>(nXSize)*nYSize,
-                                (static_cast<GUInt32>((1 << nBitDepth)-1));
-                }
-#endif
-            }
+                anBandsToClamp.push_back(i);
         }
     }
+    // When multi-threaded, the clamping is done by the pansharpening jobs.
+    if (nTasks <= 1)
+    {
+        ClampUpsampledSpectralValues(
+            eWorkDataType, pUpsampledSpectralBuffer,
+            static_cast<size_t>(nXSize) * nYSize,
+            static_cast<size_t>(nXSize) * nYSize, anBandsToClamp.data(),
+            static_cast<int>(anBandsToClamp.size()), nBitDepth);
+    }
 
     GUInt32 nMaxValue = (1 << nBitDepth) - 1;
 
@@ -1524,6 +1517,9 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
             nXSize, nYSize, psOptions->nOutPansharpenedBands * sizeof(double)));
         if (padfTempBuffer == nullptr)
         {
+            if (poMEMDS)
+                GDALClose(poMEMDS);
+            VSIFree(pSpectralBuffer);
             VSIFree(pUpsampledSpectralBuffer);
             VSIFree(pPanBuffer);
             return CE_Failure;
@@ -1564,8 +1560,16 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
                 pasJobs[i].nValues = (iNextStartLine - iStartLine) * nXSize;
                 pasJobs[i].nBandValues = static_cast<size_t>(nXSize) * nYSize;
                 pasJobs[i].nMaxValue = nMaxValue;
+                pasJobs[i].psResampleJob =
+                    asResampleJobs.empty() ? nullptr : &asResampleJobs[i];
+                pasJobs[i].panBandsToClamp = anBandsToClamp.data();
+                pasJobs[i].nBandsToClamp =
+                    static_cast<int>(anBandsToClamp.size());
+                pasJobs[i].nBitDepth = nBitDepth;
 #ifdef DEBUG_TIMING
                 pasJobs[i].ptv = &tv;
+                if (pasJobs[i].psResampleJob)
+                    pasJobs[i].psResampleJob->ptv = &tv;
 #endif
                 ahJobData[i] = &(pasJobs[i]);
             }
@@ -1601,12 +1605,164 @@ CPLErr GDALPansharpenOperation::ProcessRegion(int nXOff, int nYOff, int nXSize,
         VSIFree(padfTempBuffer);
     }
 
+    if (poMEMDS)
+        GDALClose(poMEMDS);
+    VSIFree(pSpectralBuffer);
     VSIFree(pUpsampledSpectralBuffer);
     VSIFree(pPanBuffer);
 
     return eErr;
 }
 
+/************************************************************************/
+/*                    ClampUpsampledSpectralValues()                    */
+/************************************************************************/
+
+void GDALPansharpenOperation::ClampUpsampledSpectralValues(
+    GDALDataType eWorkDataType, void *pUpsampledSpectralBuffer,
+    size_t nValues, size_t nBandValues, const int *panBands, int nBands,
+    int nBitDepth)
+{
+    for (int iBand = 0; iBand < nBands; iBand++)
+    {
+        const size_t nOffset = static_cast<size_t>(panBands[iBand]) *
+                               nBandValues;
+        if (eWorkDataType == GDT_Byte)
+        {
+            ClampValues(static_cast<GByte *>(pUpsampledSpectralBuffer) +
+                            nOffset,
+                        nValues, static_cast<GByte>((1 << nBitDepth) - 1));
+        }
+        else if (eWorkDataType == GDT_UInt16)
+        {
+            ClampValues(static_cast<GUInt16 *>(pUpsampledSpectralBuffer) +
+                            nOffset,
+                        nValues, static_cast<GUInt16>((1 << nBitDepth) - 1));
+        }
+#ifndef LIMIT_TYPES
+        else if (eWorkDataType == GDT_UInt32)
+        {
+            ClampValues(static_cast<GUInt32 *>(pUpsampledSpectralBuffer) +
+                            nOffset,
+                        nValues, static_cast<GUInt32>((1 << nBitDepth) - 1));
+        }
+#endif
+    }
+}
+
+/************************************************************************/
+/*                            GetSourceKey()                            */
+/************************************************************************/
+
+// Return a key identifying the dataset from which a band is read. Reads
+// of bands with different keys can be done in parallel.
+std::string GDALPansharpenOperation::GetSourceKey(GDALRasterBandH hBand)
+{
+    GDALRasterBand *poBand = GDALRasterBand::FromHandle(hBand);
+    GDALDataset *poDS = poBand->GetDataset();
+    if (poDS == nullptr)
+        return CPLSPrintf("%p", poBand);
+    // Datasets opened on the same file may share underlying handles
+    // (e.g. through the proxy pool), so identify them by their name,
+    // except for unnamed or in-memory ones.
+    const char *pszDesc = poDS->GetDescription();
+    GDALDriver *poDriver = poDS->GetDriver();
+    if (pszDesc[0] == '\0' ||
+        (poDriver && EQUAL(poDriver->GetDescription(), "MEM")))
+        return CPLSPrintf("%p", poDS);
+    return pszDesc;
+}
+
+/************************************************************************/
+/*                     GDALPansharpenReadRequest::Run()                 */
+/************************************************************************/
+
+CPLErr GDALPansharpenReadRequest::Run()
+{
+    GDALRasterIOExtraArg *psExtraArg = bUseExtraArg ? &sExtraArg : nullptr;
+    if (poDS)
+    {
+        return poDS->RasterIO(GF_Read, nXOff, nYOff, nXSize, nYSize, pBuffer,
+                              nBufXSize, nBufYSize, eDT,
+                              static_cast<int>(anBands.size()),
+                              anBands.data(), 0, 0, 0, psExtraArg);
+    }
+    return poBand->RasterIO(GF_Read, nXOff, nYOff, nXSize, nYSize, pBuffer,
+                            nBufXSize, nBufYSize, eDT, 0, 0, psExtraArg);
+}
+
+/************************************************************************/
+/*                             ReadSources()                            */
+/************************************************************************/
+
+namespace
+{
+struct GDALPansharpenReadJob
+{
+    std::vector<GDALPansharpenReadRequest *> apoRequests{};
+    CPLErr eErr = CE_None;
+
+    static void Run(void *pData)
+    {
+        GDALPansharpenReadJob *psJob =
+            static_cast<GDALPansharpenReadJob *>(pData);
+        for (auto *poRequest : psJob->apoRequests)
+        {
+            psJob->eErr = poRequest->Run();
+            if (psJob->eErr != CE_None)
+                break;
+        }
+    }
+};
+}  // namespace
+
+// Read the panchromatic and multispectral sources. When a thread pool is
+// available, reads from different datasets are done in parallel, the ones
+// from the same dataset being done sequentially by the same job.
+CPLErr GDALPansharpenOperation::ReadSources(
+    std::vector<GDALPansharpenReadRequest> &aoRequests) const
+{
+    std::vector<GDALPansharpenReadJob> asJobs;
+    std::map<std::string, size_t> oMapKeyToJob;
+    for (auto &oRequest : aoRequests)
+    {
+        const auto oIter = oMapKeyToJob.find(oRequest.osSourceKey);
+        if (oIter == oMapKeyToJob.end())
+        {
+            oMapKeyToJob[oRequest.osSourceKey] = asJobs.size();
+            asJobs.emplace_back();
+            asJobs.back().apoRequests.push_back(&oRequest);
+        }
+        else
+        {
+            asJobs[oIter->second].apoRequests.push_back(&oRequest);
+        }
+    }
+
+    if (poThreadPool == nullptr || asJobs.size() <= 1)
+    {
+        for (auto &oRequest : aoRequests)
+        {
+            if (oRequest.Run() != CE_None)
+                return CE_Failure;
+        }
+        return CE_None;
+    }
+
+    std::vector<void *> ahJobData;
+    for (auto &sJob : asJobs)
+        ahJobData.push_back(&sJob);
+    poThreadPool->SubmitJobs(GDALPansharpenReadJob::Run, ahJobData);
+    poThreadPool->WaitCompletion();
+
+    for (const auto &sJob : asJobs)
+    {
+        if (sJob.eErr != CE_None)
+            return CE_Failure;
+    }
+    return CE_None;
+}
+
 /************************************************************************/
 /*                   PansharpenResampleJobThreadFunc()                  */
 /************************************************************************/
@@ -1683,6 +1839,17 @@ void GDALPansharpenOperation::PansharpenJobThreadFunc(void *pUserData)
         acc += i * i;
     psJob->eErr = CE_None;
 #else
+    // Upsample the multispectral bands for the lines of this job, and clamp
+    // them, before pansharpening them, so that those steps do not need
+    // separate passes on the calling thread.
+    if (psJob->psResampleJob)
+        PansharpenResampleJobThreadFunc(psJob->psResampleJob);
+    ClampUpsampledSpectralValues(psJob->eWorkDataType,
+                                 psJob->pUpsampledSpectralBuffer,
+                                 psJob->nValues, psJob->nBandValues,
+                                 psJob->panBandsToClamp, psJob->nBandsToClamp,
+                                 psJob->nBitDepth);
+
     psJob->eErr = psJob->poPansharpenOperation->PansharpenChunk(
         psJob->eWorkDataType, psJob->eBufDataType, psJob->pPanBuffer,
         psJob->pUpsampledSpectralBuffer, psJob->pDataBuf, psJob->nValues,
@@ -127,6 +127,7 @@ CPL_C_END
 #ifdef __cplusplus
 
 #include <array>
+#include <string>
 #include <vector>
 #include "gdal_priv.h"
 
@@ -137,25 +138,6 @@ CPL_C_END
 class GDALPansharpenOperation;
 
 //! @cond Doxygen_Suppress
-typedef struct
-{
-    GDALPansharpenOperation *poPansharpenOperation;
-    GDALDataType eWorkDataType;
-    GDALDataType eBufDataType;
-    const void *pPanBuffer;
-    const void *pUpsampledSpectralBuffer;
-    void *pDataBuf;
-    size_t nValues;
-    size_t nBandValues;
-    GUInt32 nMaxValue;
-
-#ifdef DEBUG_TIMING
-    struct timeval *ptv;
-#endif
-
-    CPLErr eErr;
-} GDALPansharpenJob;
-
 typedef struct
 {
     GDALDataset *poMEMDS;
@@ -180,6 +162,56 @@ typedef struct
 #endif
 } GDALPansharpenResampleJob;
 
+typedef struct
+{
+    GDALPansharpenOperation *poPansharpenOperation;
+    GDALDataType eWorkDataType;
+    GDALDataType eBufDataType;
+    const void *pPanBuffer;
+    void *pUpsampledSpectralBuffer;
+    void *pDataBuf;
+    size_t nValues;
+    size_t nBandValues;
+    GUInt32 nMaxValue;
+
+    // Upsampling of the multispectral bands to run before pansharpening,
+    // or nullptr.
+    GDALPansharpenResampleJob *psResampleJob;
+    // Indices of the upsampled bands to clamp to nBitDepth.
+    const int *panBandsToClamp;
+    int nBandsToClamp;
+    int nBitDepth;
+
+#ifdef DEBUG_TIMING
+    struct timeval *ptv;
+#endif
+
+    CPLErr eErr;
+} GDALPansharpenJob;
+
+/** Read of a window of the panchromatic or multispectral sources. */
+struct GDALPansharpenReadRequest
+{
+    // Key identifying the source dataset.
+    std::string osSourceKey{};
+    // Either a dataset read of anBands, or a read of poBand.
+    GDALDataset *poDS = nullptr;
+    std::vector<int> anBands{};
+    GDALRasterBand *poBand = nullptr;
+    int nXOff = 0;
+    int nYOff = 0;
+    int nXSize = 0;
+    int nYSize = 0;
+    void *pBuffer = nullptr;
+    int nBufXSize = 0;
+    int nBufYSize = 0;
+    GDALDataType eDT = GDT_Unknown;
+    bool bUseExtraArg = false;
+    GDALRasterIOExtraArg sExtraArg{};
+
+    CPLErr Run();
+};
+
 class CPLWorkerThreadPool;
 //! @endcond
 
@@ -202,6 +234,17 @@ class GDALPansharpenOperation
     static void PansharpenJobThreadFunc(void *pUserData);
     static void PansharpenResampleJobThreadFunc(void *pUserData);
 
+    static std::string GetSourceKey(GDALRasterBandH hBand);
+    CPLErr
+    ReadSources(std::vector<GDALPansharpenReadRequest> &aoRequests) const;
+
+    static void ClampUpsampledSpectralValues(GDALDataType eWorkDataType,
+                                             void *pUpsampledSpectralBuffer,
+                                             size_t nValues,
+                                             size_t nBandValues,
+                                             const int *panBands, int nBands,
+                                             int nBitDepth);
+
     template <class WorkDataType, class OutDataType>
     void WeightedBroveyWithNoData(const WorkDataType *pPanBuffer,
                                   const WorkDataType *pUpsampledSpectralBuffer,
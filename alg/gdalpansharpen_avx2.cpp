@@ -0,0 +1,201 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Pansharpening module
+ * Purpose:  AVX2 specializations
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) &&                                      \
+    (defined(__x86_64) || defined(_M_X64))
+
+#include "gdalpansharpen_avx2.h"
+
+#include <immintrin.h>
+
+// Note: like in gcore/rasterio_avx2.cpp, we deliberately do not include
+// gdalsse_priv.h or gdal_priv_templates.hpp here, so that no inline function
+// shared with other translation units gets instantiated with AVX2 code
+// generation enabled.
+
+// The computations are done on doubles, with the same sequence of operations
+// as the SSE2 code path of gdalpansharpen.cpp, so that results are identical.
+
+/************************************************************************/
+/*                        Load8() / Store8()                            */
+/************************************************************************/
+
+static inline void Load8(const GByte *pabySrc, __m256d &lo, __m256d &hi)
+{
+    const __m256i ymm = _mm256_cvtepu8_epi32(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(pabySrc)));
+    lo = _mm256_cvtepi32_pd(_mm256_castsi256_si128(ymm));
+    hi = _mm256_cvtepi32_pd(_mm256_extracti128_si256(ymm, 1));
+}
+
+static inline void Load8(const GUInt16 *panSrc, __m256d &lo, __m256d &hi)
+{
+    const __m256i ymm = _mm256_cvtepu16_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(panSrc)));
+    lo = _mm256_cvtepi32_pd(_mm256_castsi256_si128(ymm));
+    hi = _mm256_cvtepi32_pd(_mm256_extracti128_si256(ymm, 1));
+}
+
+// Round to nearest (values are known to be in [0, nMaxValue]) and pack.
+static inline __m128i RoundAndPackToUInt16(__m256d lo, __m256d hi)
+{
+    const __m256d ymm_p0d5 = _mm256_set1_pd(0.5);
+    const __m128i xmm_lo = _mm256_cvttpd_epi32(_mm256_add_pd(lo, ymm_p0d5));
+    const __m128i xmm_hi = _mm256_cvttpd_epi32(_mm256_add_pd(hi, ymm_p0d5));
+    return _mm_packus_epi32(xmm_lo, xmm_hi);
+}
+
+static inline void Store8(GByte *pabyDst, __m256d lo, __m256d hi)
+{
+    const __m128i xmm = RoundAndPackToUInt16(lo, hi);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(pabyDst),
+                     _mm_packus_epi16(xmm, xmm));
+}
+
+static inline void Store8(GUInt16 *panDst, __m256d lo, __m256d hi)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(panDst),
+                     RoundAndPackToUInt16(lo, hi));
+}
+
+/************************************************************************/
+/*                WeightedBroveyPositiveWeightsAVX2()                   */
+/************************************************************************/
+
+template <class T, int NINPUT, int NOUTPUT>
+static size_t WeightedBroveyPositiveWeightsAVX2(
+    const T *pPanBuffer, const T *pUpsampledSpectralBuffer, T *pDataBuf,
+    size_t nValues, size_t nBandValues, T nMaxValue,
+    const double *padfWeights)
+{
+    static_assert(NINPUT == 3 || NINPUT == 4);
+    static_assert(NOUTPUT == 3 || NOUTPUT == 4);
+    constexpr int NBANDS = NINPUT > NOUTPUT ? NINPUT : NOUTPUT;
+
+    __m256d w[NINPUT];
+    for (int i = 0; i < NINPUT; ++i)
+        w[i] = _mm256_set1_pd(padfWeights[i]);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d maxValue = _mm256_set1_pd(static_cast<double>(nMaxValue));
+
+    size_t j = 0;  // Used after for.
+    for (; j + 7 < nValues; j += 8)
+    {
+        __m256d valLo[NBANDS];
+        __m256d valHi[NBANDS];
+        for (int i = 0; i < NBANDS; ++i)
+        {
+            Load8(pUpsampledSpectralBuffer + i * nBandValues + j, valLo[i],
+                  valHi[i]);
+        }
+
+        __m256d pseudoPanchroLo = zero;
+        __m256d pseudoPanchroHi = zero;
+        for (int i = 0; i < NINPUT; ++i)
+        {
+            pseudoPanchroLo =
+                _mm256_add_pd(pseudoPanchroLo, _mm256_mul_pd(w[i], valLo[i]));
+            pseudoPanchroHi =
+                _mm256_add_pd(pseudoPanchroHi, _mm256_mul_pd(w[i], valHi[i]));
+        }
+
+        __m256d panLo;
+        __m256d panHi;
+        Load8(pPanBuffer + j, panLo, panHi);
+
+        // factor = (pseudoPanchro != 0) ? pan / pseudoPanchro : 0
+        const __m256d factorLo = _mm256_and_pd(
+            _mm256_cmp_pd(pseudoPanchroLo, zero, _CMP_NEQ_UQ),
+            _mm256_div_pd(panLo, pseudoPanchroLo));
+        const __m256d factorHi = _mm256_and_pd(
+            _mm256_cmp_pd(pseudoPanchroHi, zero, _CMP_NEQ_UQ),
+            _mm256_div_pd(panHi, pseudoPanchroHi));
+
+        for (int i = 0; i < NOUTPUT; ++i)
+        {
+            Store8(pDataBuf + i * nBandValues + j,
+                   _mm256_min_pd(_mm256_mul_pd(valLo[i], factorLo), maxValue),
+                   _mm256_min_pd(_mm256_mul_pd(valHi[i], factorHi), maxValue));
+        }
+    }
+    return j;
+}
+
+/************************************************************************/
+/*             GDALPansharpenWeightedBroveyPositiveWeights_AVX2()       */
+/************************************************************************/
+
+template <class T>
+static size_t WeightedBroveyPositiveWeightsAVX2Dispatch(
+    const T *pPanBuffer, const T *pUpsampledSpectralBuffer, T *pDataBuf,
+    size_t nValues, size_t nBandValues, T nMaxValue,
+    const double *padfWeights, int nInputBands, int nOutputBands)
+{
+    if (nInputBands == 3 && nOutputBands == 3)
+    {
+        return WeightedBroveyPositiveWeightsAVX2<T, 3, 3>(
+            pPanBuffer, pUpsampledSpectralBuffer, pDataBuf, nValues,
+            nBandValues, nMaxValue, padfWeights);
+    }
+    else if (nInputBands == 4 && nOutputBands == 4)
+    {
+        return WeightedBroveyPositiveWeightsAVX2<T, 4, 4>(
+            pPanBuffer, pUpsampledSpectralBuffer, pDataBuf, nValues,
+            nBandValues, nMaxValue, padfWeights);
+    }
+    else if (nInputBands == 4 && nOutputBands == 3)
+    {
+        return WeightedBroveyPositiveWeightsAVX2<T, 4, 3>(
+            pPanBuffer, pUpsampledSpectralBuffer, pDataBuf, nValues,
+            nBandValues, nMaxValue, padfWeights);
+    }
+    return 0;
+}
+
+size_t GDALPansharpenWeightedBroveyPositiveWeights_AVX2(
+    const GByte *pPanBuffer, const GByte *pUpsampledSpectralBuffer,
+    GByte *pDataBuf, size_t nValues, size_t nBandValues, GByte nMaxValue,
+    const double *padfWeights, int nInputBands, int nOutputBands)
+{
+    return WeightedBroveyPositiveWeightsAVX2Dispatch(
+        pPanBuffer, pUpsampledSpectralBuffer, pDataBuf, nValues, nBandValues,
+        nMaxValue, padfWeights, nInputBands, nOutputBands);
+}
+
+size_t GDALPansharpenWeightedBroveyPositiveWeights_AVX2(
+    const GUInt16 *pPanBuffer, const GUInt16 *pUpsampledSpectralBuffer,
+    GUInt16 *pDataBuf, size_t nValues, size_t nBandValues, GUInt16 nMaxValue,
+    const double *padfWeights, int nInputBands, int nOutputBands)
+{
+    return WeightedBroveyPositiveWeightsAVX2Dispatch(
+        pPanBuffer, pUpsampledSpectralBuffer, pDataBuf, nValues, nBandValues,
+        nMaxValue, padfWeights, nInputBands, nOutputBands);
+}
+
+#endif  // HAVE_AVX2_AT_COMPILE_TIME
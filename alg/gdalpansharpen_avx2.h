@@ -0,0 +1,52 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Pansharpening module
+ * Purpose:  AVX2 specializations
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef GDALPANSHARPEN_AVX2_H_INCLUDED
+#define GDALPANSHARPEN_AVX2_H_INCLUDED
+
+#include "cpl_port.h"
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) &&                                      \
+    (defined(__x86_64) || defined(_M_X64))
+
+// Weighted Brovey with positive weights and no nodata, for 3 or 4 input
+// spectral bands and 3 or 4 output bands (the first NOUTPUT input bands).
+// Return the number of values processed, which is a multiple of 8.
+
+size_t GDALPansharpenWeightedBroveyPositiveWeights_AVX2(
+    const GByte *pPanBuffer, const GByte *pUpsampledSpectralBuffer,
+    GByte *pDataBuf, size_t nValues, size_t nBandValues, GByte nMaxValue,
+    const double *padfWeights, int nInputBands, int nOutputBands);
+
+size_t GDALPansharpenWeightedBroveyPositiveWeights_AVX2(
+    const GUInt16 *pPanBuffer, const GUInt16 *pUpsampledSpectralBuffer,
+    GUInt16 *pDataBuf, size_t nValues, size_t nBandValues, GUInt16 nMaxValue,
+    const double *padfWeights, int nInputBands, int nOutputBands);
+
+#endif
+
+#endif /* GDALPANSHARPEN_AVX2_H_INCLUDED */
@@ -34,13 +34,16 @@
 #include <cstdlib>
 
 #include <algorithm>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
+#include "gdal_thread_pool.h"
 
 static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
                                    int *panNearY, int bForward, int iLine,
@@ -49,6 +52,355 @@ static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
                                    double *pdfSrcNoDataValue, int nTargetValues,
                                    int *panTargetValues);
 
+/************************************************************************/
+/*                    Exact Euclidean distance transform                */
+/*                                                                      */
+/*      Implementation of ALGORITHM=EXACT, following A. Meijster,       */
+/*      J.B.T.M. Roerdink and W.H. Hesselink, "A general algorithm for  */
+/*      computing distance transforms in linear time", 2000.  The       */
+/*      vertical distance to the nearest target in each column is       */
+/*      computed first, and then the exact distance along each line,    */
+/*      as the lower envelope of the parabolas rooted at each column.   */
+/*      Both phases are run in parallel on ranges of columns or lines.  */
+/************************************************************************/
+
+namespace
+{
+struct GDALProximityExactJob
+{
+    // Whole raster: source values as read, then vertical distances.
+    // Non-target source nodata pixels are flagged by storing -(dist + 1).
+    GInt32 *panDist = nullptr;
+    int nXSize = 0;
+    int nYSize = 0;
+    int iStart = 0;  // columns in the first phase, lines in the second one
+    int iEnd = 0;
+
+    // First phase
+    const double *pdfSrcNoDataValue = nullptr;
+    int nTargetValues = 0;
+    const int *panTargetValues = nullptr;
+
+    // Second phase
+    double dfMaxDist = 0;
+    float fNoDataValue = 0;
+    bool bFixedBufVal = false;
+    double dfFixedBufVal = 0;
+    double dfDistMult = 1;
+    float *pafOutChunk = nullptr;
+    int nChunkYOff = 0;
+};
+}  // namespace
+
+/************************************************************************/
+/*                  GDALProximityExactColumnsFunc()                     */
+/************************************************************************/
+
+static void GDALProximityExactColumnsFunc(void *pData)
+{
+    const auto psJob = static_cast<const GDALProximityExactJob *>(pData);
+    const int nXSize = psJob->nXSize;
+    const int nYSize = psJob->nYSize;
+    // Larger than any vertical distance.
+    const GInt32 nInf = nYSize;
+
+    const auto Decode = [](GInt32 nVal)
+    { return nVal < 0 ? -nVal - 1 : nVal; };
+    const auto Encode = [](GInt32 nDist, bool bNoData)
+    { return bNoData ? -nDist - 1 : nDist; };
+
+    // Classify pixels, and compute the distance to the nearest target
+    // above.
+    for (int iLine = 0; iLine < nYSize; iLine++)
+    {
+        GInt32 *panLine = psJob->panDist + static_cast<size_t>(iLine) * nXSize;
+        const GInt32 *panPrevLine = iLine > 0 ? panLine - nXSize : nullptr;
+        for (int iPixel = psJob->iStart; iPixel < psJob->iEnd; iPixel++)
+        {
+            const GInt32 nVal = panLine[iPixel];
+            bool bIsTarget = false;
+            if (psJob->nTargetValues == 0)
+            {
+                bIsTarget = nVal != 0;
+            }
+            else
+            {
+                for (int i = 0; i < psJob->nTargetValues; i++)
+                {
+                    if (nVal == psJob->panTargetValues[i])
+                        bIsTarget = true;
+                }
+            }
+
+            if (bIsTarget)
+            {
+                panLine[iPixel] = 0;
+            }
+            else
+            {
+                const GInt32 nDist =
+                    panPrevLine
+                        ? std::min(Decode(panPrevLine[iPixel]) + 1, nInf)
+                        : nInf;
+                panLine[iPixel] =
+                    Encode(nDist, psJob->pdfSrcNoDataValue != nullptr &&
+                                      nVal == *(psJob->pdfSrcNoDataValue));
+            }
+        }
+    }
+
+    // Take into account the nearest target below.
+    for (int iLine = nYSize - 2; iLine >= 0; iLine--)
+    {
+        GInt32 *panLine = psJob->panDist + static_cast<size_t>(iLine) * nXSize;
+        const GInt32 *panNextLine = panLine + nXSize;
+        for (int iPixel = psJob->iStart; iPixel < psJob->iEnd; iPixel++)
+        {
+            const GInt32 nVal = panLine[iPixel];
+            const GInt32 nDistBelow = Decode(panNextLine[iPixel]) + 1;
+            if (nDistBelow < Decode(nVal))
+                panLine[iPixel] = Encode(nDistBelow, nVal < 0);
+        }
+    }
+}
+
+/************************************************************************/
+/*                    GDALProximityExactLinesFunc()                     */
+/************************************************************************/
+
+static void GDALProximityExactLinesFunc(void *pData)
+{
+    const auto psJob = static_cast<const GDALProximityExactJob *>(pData);
+    const int nXSize = psJob->nXSize;
+    const GInt32 nInf = psJob->nYSize;
+    const double dfMaxDistSq = psJob->dfMaxDist * psJob->dfMaxDist;
+
+    // Columns of the parabolas of the lower envelope, and abscissa from
+    // which each one is the lowest.
+    std::vector<int> anEnvCol(nXSize);
+    std::vector<int> anEnvStart(nXSize);
+    std::vector<GIntBig> anDistSq(nXSize);
+
+    for (int iLine = psJob->iStart; iLine < psJob->iEnd; iLine++)
+    {
+        const GInt32 *panLine =
+            psJob->panDist + static_cast<size_t>(iLine) * nXSize;
+        for (int iPixel = 0; iPixel < nXSize; iPixel++)
+        {
+            const GIntBig nDist =
+                panLine[iPixel] < 0 ? -panLine[iPixel] - 1 : panLine[iPixel];
+            anDistSq[iPixel] = nDist * nDist;
+        }
+
+        // Squared distance from pixel iX to the target nearest to column iCol
+        const auto F = [&anDistSq](GIntBig iX, GIntBig iCol)
+        { return (iX - iCol) * (iX - iCol) + anDistSq[iCol]; };
+        // First abscissa from which column iCol2 is nearer than column iCol1
+        const auto Sep = [&anDistSq](GIntBig iCol1, GIntBig iCol2)
+        {
+            const GIntBig nNum = iCol2 * iCol2 - iCol1 * iCol1 +
+                                 anDistSq[iCol2] - anDistSq[iCol1];
+            const GIntBig nDen = 2 * (iCol2 - iCol1);
+            // Rounding towards negative infinity
+            return nNum >= 0 ? nNum / nDen : -((-nNum + nDen - 1) / nDen);
+        };
+
+        // Build the lower envelope, skipping columns without any target,
+        // or whose nearest target is beyond the maximum distance.
+        int q = -1;
+        for (int iCol = 0; iCol < nXSize; iCol++)
+        {
+            if (anDistSq[iCol] >= static_cast<GIntBig>(nInf) * nInf ||
+                static_cast<double>(anDistSq[iCol]) > dfMaxDistSq)
+                continue;
+            while (q >= 0 && F(anEnvStart[q], anEnvCol[q]) >
+                                 F(anEnvStart[q], iCol))
+                q--;
+            if (q < 0)
+            {
+                q = 0;
+                anEnvCol[0] = iCol;
+                anEnvStart[0] = 0;
+            }
+            else
+            {
+                const GIntBig w = 1 + Sep(anEnvCol[q], iCol);
+                if (w < nXSize)
+                {
+                    q++;
+                    anEnvCol[q] = iCol;
+                    anEnvStart[q] = static_cast<int>(w);
+                }
+            }
+        }
+
+        float *pafOut = psJob->pafOutChunk +
+                        static_cast<size_t>(iLine - psJob->nChunkYOff) * nXSize;
+        for (int iPixel = nXSize - 1; iPixel >= 0; iPixel--)
+        {
+            double dfDistSq = -1;
+            if (q >= 0)
+            {
+                dfDistSq = static_cast<double>(F(iPixel, anEnvCol[q]));
+                if (iPixel == anEnvStart[q])
+                    q--;
+            }
+
+            if (dfDistSq == 0)
+                pafOut[iPixel] = 0.0f;
+            else if (dfDistSq < 0 || dfDistSq > dfMaxDistSq ||
+                     panLine[iPixel] < 0)
+                pafOut[iPixel] = psJob->fNoDataValue;
+            else if (psJob->bFixedBufVal)
+                pafOut[iPixel] = static_cast<float>(psJob->dfFixedBufVal);
+            else
+                pafOut[iPixel] =
+                    static_cast<float>(sqrt(dfDistSq) * psJob->dfDistMult);
+        }
+    }
+}
+
+/************************************************************************/
+/*                      GDALProximityRunJobs()                          */
+/************************************************************************/
+
+static void GDALProximityRunJobs(CPLWorkerThreadPool *poThreadPool,
+                                 CPLThreadFunc pfnFunc,
+                                 std::vector<GDALProximityExactJob> &asJobs)
+{
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    if (poJobQueue == nullptr)
+    {
+        for (auto &sJob : asJobs)
+            pfnFunc(&sJob);
+        return;
+    }
+    for (auto &sJob : asJobs)
+        poJobQueue->SubmitJob(pfnFunc, &sJob);
+    poJobQueue->WaitCompletion();
+}
+
+/************************************************************************/
+/*                    GDALComputeProximityExact()                       */
+/************************************************************************/
+
+static CPLErr GDALComputeProximityExact(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hProximityBand,
+    const GDALProximityExactJob &sTemplateJob, int nThreads,
+    GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    const int nXSize = sTemplateJob.nXSize;
+    const int nYSize = sTemplateJob.nYSize;
+
+    GInt32 *panDist = static_cast<GInt32 *>(
+        VSI_MALLOC3_VERBOSE(sizeof(GInt32), nXSize, nYSize));
+    if (panDist == nullptr)
+        return CE_Failure;
+
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    if (poThreadPool == nullptr)
+        nThreads = 1;
+
+    // Process and write lines by chunks of whole blocks, of about 16 MB.
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    GDALGetBlockSize(hProximityBand, &nBlockXSize, &nBlockYSize);
+    nBlockYSize = std::max(1, nBlockYSize);
+    int nChunkYSize = std::max(
+        1, static_cast<int>(16 * 1024 * 1024 / (sizeof(float) * nXSize)));
+    nChunkYSize = std::min(
+        nYSize, std::max(nBlockYSize, nChunkYSize / nBlockYSize * nBlockYSize));
+
+    /* -------------------------------------------------------------------- */
+    /*      Read the source raster.                                         */
+    /* -------------------------------------------------------------------- */
+    CPLErr eErr = CE_None;
+    for (int iLine = 0; eErr == CE_None && iLine < nYSize;
+         iLine += nChunkYSize)
+    {
+        const int nLines = std::min(nChunkYSize, nYSize - iLine);
+        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iLine, nXSize, nLines,
+                            panDist + static_cast<size_t>(iLine) * nXSize,
+                            nXSize, nLines, GDT_Int32, 0, 0);
+        if (eErr == CE_None &&
+            !pfnProgress(0.3 * (iLine + nLines) / nYSize, "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Vertical distances, by ranges of columns.                       */
+    /* -------------------------------------------------------------------- */
+    if (eErr == CE_None)
+    {
+        std::vector<GDALProximityExactJob> asJobs;
+        const int nJobs = std::min(nXSize, nThreads * 4);
+        for (int i = 0; i < nJobs; i++)
+        {
+            asJobs.push_back(sTemplateJob);
+            asJobs.back().panDist = panDist;
+            asJobs.back().iStart =
+                static_cast<int>(static_cast<GIntBig>(nXSize) * i / nJobs);
+            asJobs.back().iEnd = static_cast<int>(
+                static_cast<GIntBig>(nXSize) * (i + 1) / nJobs);
+        }
+        GDALProximityRunJobs(poThreadPool, GDALProximityExactColumnsFunc,
+                             asJobs);
+        if (!pfnProgress(0.4, "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Distances along lines, by chunks of lines.                      */
+    /* -------------------------------------------------------------------- */
+    float *pafOutChunk = nullptr;
+    if (eErr == CE_None)
+    {
+        pafOutChunk = static_cast<float *>(
+            VSI_MALLOC3_VERBOSE(sizeof(float), nXSize, nChunkYSize));
+        if (pafOutChunk == nullptr)
+            eErr = CE_Failure;
+    }
+    for (int iLine = 0; eErr == CE_None && iLine < nYSize;
+         iLine += nChunkYSize)
+    {
+        const int nLines = std::min(nChunkYSize, nYSize - iLine);
+        std::vector<GDALProximityExactJob> asJobs;
+        const int nJobs = std::min(nLines, nThreads);
+        for (int i = 0; i < nJobs; i++)
+        {
+            asJobs.push_back(sTemplateJob);
+            asJobs.back().panDist = panDist;
+            asJobs.back().pafOutChunk = pafOutChunk;
+            asJobs.back().nChunkYOff = iLine;
+            asJobs.back().iStart = iLine + nLines * i / nJobs;
+            asJobs.back().iEnd = iLine + nLines * (i + 1) / nJobs;
+        }
+        GDALProximityRunJobs(poThreadPool, GDALProximityExactLinesFunc,
+                             asJobs);
+
+        eErr = GDALRasterIO(hProximityBand, GF_Write, 0, iLine, nXSize, nLines,
+                            pafOutChunk, nXSize, nLines, GDT_Float32, 0, 0);
+        if (eErr == CE_None &&
+            !pfnProgress(0.4 + 0.6 * (iLine + nLines) / nYSize, "",
+                         pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    CPLFree(pafOutChunk);
+    CPLFree(panDist);
+    return eErr;
+}
+
 /************************************************************************/
 /*                        GDALComputeProximity()                        */
 /************************************************************************/
@@ -105,6 +457,21 @@ the proximity output.
 
 If this option is set, all pixels within the MAXDIST threadhold are
 set to this fixed value instead of to a proximity distance.
+
+  ALGORITHM=[PROPAGATION]/EXACT
+
+(GDAL >= 3.9) The default PROPAGATION algorithm propagates the nearest
+target of each pixel in two passes over the raster, top-down and bottom-up,
+which may slightly overestimate some distances. EXACT computes an exact
+Euclidean distance transform, in two separable phases (columns, then lines)
+that are run in parallel. It requires holding one 32-bit integer per pixel
+of the raster in memory, but reads the source band and writes the proximity
+band only once.
+
+  NUM_THREADS=n/ALL_CPUS
+
+(GDAL >= 3.9) Number of threads used by ALGORITHM=EXACT. Defaults to the
+value of the GDAL_NUM_THREADS configuration option, or 1.
 */
 
 CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
@@ -241,6 +608,21 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
         CSLDestroy(papszValuesTokens);
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Which algorithm?                                                */
+    /* -------------------------------------------------------------------- */
+    const char *pszAlgorithm =
+        CSLFetchNameValueDef(papszOptions, "ALGORITHM", "PROPAGATION");
+    if (!EQUAL(pszAlgorithm, "PROPAGATION") && !EQUAL(pszAlgorithm, "EXACT"))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Unrecognized ALGORITHM value '%s', should be PROPAGATION or "
+                 "EXACT.",
+                 pszAlgorithm);
+        CPLFree(panTargetValues);
+        return CE_Failure;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Initialize progress counter.                                    */
     /* -------------------------------------------------------------------- */
@@ -251,6 +633,38 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
+    if (EQUAL(pszAlgorithm, "EXACT"))
+    {
+        const char *pszNumThreads = CSLFetchNameValueDef(
+            papszOptions, "NUM_THREADS",
+            CPLGetConfigOption("GDAL_NUM_THREADS", nullptr));
+        int nThreads = 1;
+        if (pszNumThreads)
+        {
+            nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                        : atoi(pszNumThreads);
+            nThreads = std::max(1, std::min(nThreads, 128));
+        }
+
+        GDALProximityExactJob sTemplateJob;
+        sTemplateJob.nXSize = nXSize;
+        sTemplateJob.nYSize = nYSize;
+        sTemplateJob.pdfSrcNoDataValue = pdfSrcNoData;
+        sTemplateJob.nTargetValues = nTargetValues;
+        sTemplateJob.panTargetValues = panTargetValues;
+        sTemplateJob.dfMaxDist = dfMaxDist;
+        sTemplateJob.fNoDataValue = fNoDataValue;
+        sTemplateJob.bFixedBufVal = bFixedBufVal;
+        sTemplateJob.dfFixedBufVal = dfFixedBufVal;
+        sTemplateJob.dfDistMult = dfDistMult;
+
+        const CPLErr eErr =
+            GDALComputeProximityExact(hSrcBand, hProximityBand, sTemplateJob,
+                                      nThreads, pfnProgress, pProgressArg);
+        CPLFree(panTargetValues);
+        return eErr;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      We need a signed type for the working proximity values kept     */
     /*      on disk.  If our proximity band is not signed, then create a    */
@@ -36,7 +36,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <cfloat>
+#include <atomic>
 #include <limits>
+#include <mutex>
 #include <vector>
 #include <algorithm>
 
@@ -45,14 +47,18 @@
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
 #include "ogr_geometry.h"
+#include "ogr_recordbatch.h"
 #include "ogr_spatialref.h"
+#include "ogr_wkb.h"
 #include "ogrsf_frmts.h"
 
 template <typename T> static inline T SaturatedAddSigned(T a, T b)
@@ -133,10 +139,20 @@ static inline void gvBurnScanlineBasic(GDALRasterizeInfo *psInfo, int nY,
         {
             T nVal;
             GDALCopyWord(burnValue, nVal);
-            for (int nX = nXStart; nX <= nXEnd; ++nX)
+            if (psInfo->nPixelSpace == static_cast<int>(sizeof(T)))
             {
-                *reinterpret_cast<T *>(pabyInsert) = nVal;
-                pabyInsert += psInfo->nPixelSpace;
+                // Contiguous span: let the compiler use memset() or vector
+                // stores.
+                std::fill_n(reinterpret_cast<T *>(pabyInsert),
+                            nXEnd - nXStart + 1, nVal);
+            }
+            else
+            {
+                for (int nX = nXStart; nX <= nXEnd; ++nX)
+                {
+                    *reinterpret_cast<T *>(pabyInsert) = nVal;
+                    pabyInsert += psInfo->nPixelSpace;
+                }
             }
         }
     }
@@ -186,6 +202,11 @@ static inline void gvBurnScanlineInt64UserBurnValue(GDALRasterizeInfo *psInfo,
                 }
             }
         }
+        else if (psInfo->nPixelSpace == static_cast<int>(sizeof(burnValue)))
+        {
+            std::fill_n(reinterpret_cast<std::int64_t *>(pabyInsert),
+                        nXEnd - nXStart + 1, burnValue);
+        }
         else
         {
             for (int nX = nXStart; nX <= nXEnd; ++nX)
@@ -547,39 +568,24 @@ static void GDALCollectRingsFromGeometry(const OGRGeometry *poShape,
 }
 
 /************************************************************************/
-/*                       gv_rasterize_one_shape()                       */
+/*                      gv_rasterize_flat_shape()                       */
 /************************************************************************/
-static void gv_rasterize_one_shape(
+
+// Rasterize the parts collected by GDALCollectRingsFromGeometry() or
+// GDALCollectRingsFromFlatGeometry(). The point arrays are modified.
+static void gv_rasterize_flat_shape(
     unsigned char *pabyChunkBuf, int nXOff, int nYOff, int nXSize, int nYSize,
     int nBands, GDALDataType eType, int nPixelSpace, GSpacing nLineSpace,
-    GSpacing nBandSpace, int bAllTouched, const OGRGeometry *poShape,
+    GSpacing nBandSpace, int bAllTouched, OGRwkbGeometryType eGeomType,
+    std::vector<double> &aPointX, std::vector<double> &aPointY,
+    std::vector<double> &aPointVariant, std::vector<int> &aPartSize,
     GDALDataType eBurnValueType, const double *padfBurnValues,
     const int64_t *panBurnValues, GDALBurnValueSrc eBurnValueSrc,
     GDALRasterMergeAlg eMergeAlg, GDALTransformerFunc pfnTransformer,
-    void *pTransformArg)
-
+    void *pTransformArg, CPLWorkerThreadPool *poThreadPool = nullptr)
 {
-    if (poShape == nullptr || poShape->IsEmpty())
+    if (aPartSize.empty())
         return;
-    const auto eGeomType = wkbFlatten(poShape->getGeometryType());
-
-    if ((eGeomType == wkbMultiLineString || eGeomType == wkbMultiPolygon ||
-         eGeomType == wkbGeometryCollection) &&
-        eMergeAlg == GRMA_Replace)
-    {
-        // Speed optimization: in replace mode, we can rasterize each part of
-        // a geometry collection separately.
-        const auto poGC = poShape->toGeometryCollection();
-        for (const auto poPart : *poGC)
-        {
-            gv_rasterize_one_shape(
-                pabyChunkBuf, nXOff, nYOff, nXSize, nYSize, nBands, eType,
-                nPixelSpace, nLineSpace, nBandSpace, bAllTouched, poPart,
-                eBurnValueType, padfBurnValues, panBurnValues, eBurnValueSrc,
-                eMergeAlg, pfnTransformer, pTransformArg);
-        }
-        return;
-    }
 
     if (nPixelSpace == 0)
     {
@@ -617,18 +623,6 @@ static void gv_rasterize_one_shape(
     sInfo.bFillSetVisitedPoints = false;
     sInfo.poSetVisitedPoints = nullptr;
 
-    /* -------------------------------------------------------------------- */
-    /*      Transform polygon geometries into a set of rings and a part     */
-    /*      size list.                                                      */
-    /* -------------------------------------------------------------------- */
-    std::vector<double> aPointX;
-    std::vector<double> aPointY;
-    std::vector<double> aPointVariant;
-    std::vector<int> aPartSize;
-
-    GDALCollectRingsFromGeometry(poShape, aPointX, aPointY, aPointVariant,
-                                 aPartSize, eBurnValueSrc);
-
     /* -------------------------------------------------------------------- */
     /*      Transform points if needed.                                     */
     /* -------------------------------------------------------------------- */
@@ -736,7 +730,7 @@ static void gv_rasterize_one_shape(
                 aPartSize.data(), aPointX.data(), aPointY.data(),
                 (eBurnValueSrc == GBV_UserBurnValue) ? nullptr
                                                      : aPointVariant.data(),
-                gvBurnScanline, &sInfo, eMergeAlg == GRMA_Add);
+                gvBurnScanline, &sInfo, eMergeAlg == GRMA_Add, poThreadPool);
         }
         break;
     }
@@ -744,6 +738,355 @@ static void gv_rasterize_one_shape(
     delete sInfo.poSetVisitedPoints;
 }
 
+/************************************************************************/
+/*                       gv_rasterize_one_shape()                       */
+/************************************************************************/
+static void gv_rasterize_one_shape(
+    unsigned char *pabyChunkBuf, int nXOff, int nYOff, int nXSize, int nYSize,
+    int nBands, GDALDataType eType, int nPixelSpace, GSpacing nLineSpace,
+    GSpacing nBandSpace, int bAllTouched, const OGRGeometry *poShape,
+    GDALDataType eBurnValueType, const double *padfBurnValues,
+    const int64_t *panBurnValues, GDALBurnValueSrc eBurnValueSrc,
+    GDALRasterMergeAlg eMergeAlg, GDALTransformerFunc pfnTransformer,
+    void *pTransformArg, CPLWorkerThreadPool *poThreadPool = nullptr)
+
+{
+    if (poShape == nullptr || poShape->IsEmpty())
+        return;
+    const auto eGeomType = wkbFlatten(poShape->getGeometryType());
+
+    if ((eGeomType == wkbMultiLineString || eGeomType == wkbMultiPolygon ||
+         eGeomType == wkbGeometryCollection) &&
+        eMergeAlg == GRMA_Replace)
+    {
+        // Speed optimization: in replace mode, we can rasterize each part of
+        // a geometry collection separately.
+        const auto poGC = poShape->toGeometryCollection();
+        for (const auto poPart : *poGC)
+        {
+            gv_rasterize_one_shape(
+                pabyChunkBuf, nXOff, nYOff, nXSize, nYSize, nBands, eType,
+                nPixelSpace, nLineSpace, nBandSpace, bAllTouched, poPart,
+                eBurnValueType, padfBurnValues, panBurnValues, eBurnValueSrc,
+                eMergeAlg, pfnTransformer, pTransformArg, poThreadPool);
+        }
+        return;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Transform polygon geometries into a set of rings and a part     */
+    /*      size list.                                                      */
+    /* -------------------------------------------------------------------- */
+    std::vector<double> aPointX;
+    std::vector<double> aPointY;
+    std::vector<double> aPointVariant;
+    std::vector<int> aPartSize;
+
+    GDALCollectRingsFromGeometry(poShape, aPointX, aPointY, aPointVariant,
+                                 aPartSize, eBurnValueSrc);
+
+    gv_rasterize_flat_shape(pabyChunkBuf, nXOff, nYOff, nXSize, nYSize, nBands,
+                            eType, nPixelSpace, nLineSpace, nBandSpace,
+                            bAllTouched, eGeomType, aPointX, aPointY,
+                            aPointVariant, aPartSize, eBurnValueType,
+                            padfBurnValues, panBurnValues, eBurnValueSrc,
+                            eMergeAlg, pfnTransformer, pTransformArg,
+                            poThreadPool);
+}
+
+/************************************************************************/
+/*                  GDALCollectRingsFromFlatGeometry()                  */
+/************************************************************************/
+
+// Equivalent of GDALCollectRingsFromGeometry() for the members
+// [iFirstMember, iFirstMember + nMembers) of a flat geometry, whose first
+// part and first point are iPart and iPoint.
+static void GDALCollectRingsFromFlatGeometry(
+    const OGRWKBFlatGeometry &oGeom, size_t iFirstMember, size_t nMembers,
+    size_t iPart, size_t iPoint, std::vector<double> &aPointX,
+    std::vector<double> &aPointY, std::vector<double> &aPointVariant,
+    std::vector<int> &aPartSize, GDALBurnValueSrc eBurnValueSrc)
+{
+    aPointX.clear();
+    aPointY.clear();
+    aPointVariant.clear();
+    aPartSize.clear();
+    for (size_t iMember = iFirstMember; iMember < iFirstMember + nMembers;
+         ++iMember)
+    {
+        const auto &sMember = oGeom.asMembers[iMember];
+        for (int j = 0; j < sMember.nPartCount; ++j, ++iPart)
+        {
+            const int nCount = oGeom.anPartSize[iPart];
+            // Linestrings are reversed, and rings are made clockwise.
+            const bool bReverse =
+                sMember.eFlatType == wkbLineString ||
+                (sMember.eFlatType == wkbPolygon && !oGeom.abClockwise[iPart]);
+            for (int i = 0; i < nCount; ++i)
+            {
+                const size_t k =
+                    bReverse ? iPoint + nCount - 1 - i : iPoint + i;
+                aPointX.push_back(oGeom.adfX[k]);
+                aPointY.push_back(oGeom.adfY[k]);
+                if (eBurnValueSrc != GBV_UserBurnValue)
+                    aPointVariant.push_back(oGeom.adfZ[k]);
+            }
+            aPartSize.push_back(nCount);
+            iPoint += nCount;
+        }
+    }
+}
+
+/************************************************************************/
+/*                       gv_rasterize_flat_geometry()                   */
+/************************************************************************/
+
+// Equivalent of gv_rasterize_one_shape() for a geometry decoded from WKB
+// by OGRWKBFlatGeometry, which avoids building an OGRGeometry.
+static void gv_rasterize_flat_geometry(
+    unsigned char *pabyChunkBuf, int nXOff, int nYOff, int nXSize, int nYSize,
+    int nBands, GDALDataType eType, int bAllTouched,
+    const OGRWKBFlatGeometry &oGeom, std::vector<double> &aPointX,
+    std::vector<double> &aPointY, std::vector<double> &aPointVariant,
+    std::vector<int> &aPartSize, const double *padfBurnValues,
+    GDALBurnValueSrc eBurnValueSrc, GDALRasterMergeAlg eMergeAlg,
+    GDALTransformerFunc pfnTransformer, void *pTransformArg)
+{
+    const auto eGeomType = oGeom.eFlatType;
+    if ((eGeomType == wkbMultiLineString || eGeomType == wkbMultiPolygon ||
+         eGeomType == wkbGeometryCollection) &&
+        eMergeAlg == GRMA_Replace)
+    {
+        // Speed optimization: in replace mode, we can rasterize each part of
+        // a geometry collection separately.
+        size_t iPart = 0;
+        size_t iPoint = 0;
+        for (size_t iMember = 0; iMember < oGeom.asMembers.size(); ++iMember)
+        {
+            GDALCollectRingsFromFlatGeometry(
+                oGeom, iMember, 1, iPart, iPoint, aPointX, aPointY,
+                aPointVariant, aPartSize, eBurnValueSrc);
+            iPart += aPartSize.size();
+            iPoint += aPointX.size();
+            gv_rasterize_flat_shape(
+                pabyChunkBuf, nXOff, nYOff, nXSize, nYSize, nBands, eType, 0,
+                0, 0, bAllTouched, oGeom.asMembers[iMember].eFlatType, aPointX,
+                aPointY, aPointVariant, aPartSize, GDT_Float64, padfBurnValues,
+                nullptr, eBurnValueSrc, eMergeAlg, pfnTransformer,
+                pTransformArg);
+        }
+        return;
+    }
+
+    GDALCollectRingsFromFlatGeometry(oGeom, 0, oGeom.asMembers.size(), 0, 0,
+                                     aPointX, aPointY, aPointVariant,
+                                     aPartSize, eBurnValueSrc);
+    gv_rasterize_flat_shape(pabyChunkBuf, nXOff, nYOff, nXSize, nYSize, nBands,
+                            eType, 0, 0, 0, bAllTouched, eGeomType, aPointX,
+                            aPointY, aPointVariant, aPartSize, GDT_Float64,
+                            padfBurnValues, nullptr, eBurnValueSrc, eMergeAlg,
+                            pfnTransformer, pTransformArg);
+}
+
+/************************************************************************/
+/*                   gv_rasterize_layer_arrow_stream()                  */
+/************************************************************************/
+
+// Rasterize the features of a layer, from the WKB geometries and burn
+// attribute values of its Arrow stream, into a chunk buffer.
+// Returns false if the Arrow stream cannot be used (nothing has been
+// consumed in that case), or if an error occurred, in which case bError
+// is set.
+static bool gv_rasterize_layer_arrow_stream(
+    OGRLayer *poLayer, unsigned char *pabyChunkBuf, int nYOff, int nXSize,
+    int nYSize, int nBands, GDALDataType eType, int bAllTouched,
+    const char *pszBurnAttribute, const double *padfLayerBurnValues,
+    GDALBurnValueSrc eBurnValueSrc, GDALRasterMergeAlg eMergeAlg,
+    GDALTransformerFunc pfnTransformer, void *pTransformArg, bool &bError)
+{
+    bError = false;
+
+    OGRFeatureDefn *poDefn = poLayer->GetLayerDefn();
+    if (poDefn->GetGeomFieldCount() == 0 ||
+        !poLayer->TestCapability(OLCFastGetArrowStream) ||
+        !CPLTestBool(
+            CPLGetConfigOption("GDAL_RASTERIZE_USE_ARROW_STREAM", "YES")))
+    {
+        return false;
+    }
+
+    struct ArrowArrayStream stream;
+    const char *const apszOptions[] = {"INCLUDE_FID=NO",
+                                       "GEOMETRY_ENCODING=WKB", nullptr};
+    if (!poLayer->GetArrowStream(&stream, apszOptions))
+        return false;
+
+    struct ArrowSchema schema;
+    if (stream.get_schema(&stream, &schema) != 0)
+    {
+        stream.release(&stream);
+        return false;
+    }
+
+    // Locate the children of the record batches with the geometry and
+    // the burn attribute.
+    const char *pszGeomFieldName = poDefn->GetGeomFieldDefn(0)->GetNameRef();
+    if (pszGeomFieldName[0] == '\0')
+        pszGeomFieldName = OGRLayer::DEFAULT_ARROW_GEOMETRY_NAME;
+    int iGeomChild = -1;
+    int iBurnChild = -1;
+    char chGeomFormat = 0;
+    char chBurnFormat = 0;
+    for (int64_t i = 0; i < schema.n_children; ++i)
+    {
+        const struct ArrowSchema *psChild = schema.children[i];
+        if (psChild->format[1] != '\0' || psChild->dictionary != nullptr)
+            continue;
+        if (iGeomChild < 0 && strcmp(psChild->name, pszGeomFieldName) == 0)
+        {
+            iGeomChild = static_cast<int>(i);
+            chGeomFormat = psChild->format[0];
+        }
+        else if (iBurnChild < 0 && pszBurnAttribute &&
+                 strcmp(psChild->name, pszBurnAttribute) == 0)
+        {
+            iBurnChild = static_cast<int>(i);
+            chBurnFormat = psChild->format[0];
+        }
+    }
+    schema.release(&schema);
+    if (iGeomChild < 0 || (chGeomFormat != 'z' && chGeomFormat != 'Z') ||
+        (pszBurnAttribute &&
+         (iBurnChild < 0 ||
+          (chBurnFormat != 's' && chBurnFormat != 'i' && chBurnFormat != 'l' &&
+           chBurnFormat != 'f' && chBurnFormat != 'g'))))
+    {
+        stream.release(&stream);
+        return false;
+    }
+
+    const auto IsValid = [](const struct ArrowArray *psArray, int64_t iRow)
+    {
+        const auto pabyValidity =
+            static_cast<const GByte *>(psArray->buffers[0]);
+        const int64_t i = psArray->offset + iRow;
+        return psArray->null_count == 0 || pabyValidity == nullptr ||
+               (pabyValidity[i / 8] & (1 << (i % 8))) != 0;
+    };
+
+    const auto GetBurnValue = [chBurnFormat,
+                               &IsValid](const struct ArrowArray *psArray,
+                                         int64_t iRow)
+    {
+        if (!IsValid(psArray, iRow))
+            return 0.0;
+        const int64_t i = psArray->offset + iRow;
+        switch (chBurnFormat)
+        {
+            case 's':
+                return static_cast<double>(
+                    static_cast<const int16_t *>(psArray->buffers[1])[i]);
+            case 'i':
+                return static_cast<double>(
+                    static_cast<const int32_t *>(psArray->buffers[1])[i]);
+            case 'l':
+                return static_cast<double>(
+                    static_cast<const int64_t *>(psArray->buffers[1])[i]);
+            case 'f':
+                return static_cast<double>(
+                    static_cast<const float *>(psArray->buffers[1])[i]);
+            default:
+                break;
+        }
+        return static_cast<const double *>(psArray->buffers[1])[i];
+    };
+
+    const bool bWithZ = eBurnValueSrc != GBV_UserBurnValue;
+    OGRWKBFlatGeometry oGeom;
+    std::vector<double> aPointX;
+    std::vector<double> aPointY;
+    std::vector<double> aPointVariant;
+    std::vector<int> aPartSize;
+    std::vector<double> adfAttrValues(nBands);
+
+    while (true)
+    {
+        struct ArrowArray array;
+        if (stream.get_next(&stream, &array) != 0)
+        {
+            const char *pszError = stream.get_last_error(&stream);
+            CPLError(CE_Failure, CPLE_AppDefined, "%s",
+                     pszError ? pszError : "Error while reading Arrow stream");
+            bError = true;
+            break;
+        }
+        if (array.release == nullptr)
+            break;
+
+        const struct ArrowArray *psGeomArray = array.children[iGeomChild];
+        const GByte *pabyData =
+            static_cast<const GByte *>(psGeomArray->buffers[2]);
+        for (int64_t iRow = 0; iRow < array.length; ++iRow)
+        {
+            if (!IsValid(psGeomArray, iRow))
+                continue;
+            const int64_t i = psGeomArray->offset + iRow;
+            size_t nStart;
+            size_t nEnd;
+            if (chGeomFormat == 'z')
+            {
+                const auto panOffsets =
+                    static_cast<const int32_t *>(psGeomArray->buffers[1]);
+                nStart = static_cast<size_t>(panOffsets[i]);
+                nEnd = static_cast<size_t>(panOffsets[i + 1]);
+            }
+            else
+            {
+                const auto panOffsets =
+                    static_cast<const int64_t *>(psGeomArray->buffers[1]);
+                nStart = static_cast<size_t>(panOffsets[i]);
+                nEnd = static_cast<size_t>(panOffsets[i + 1]);
+            }
+
+            const double *padfBurnValues = padfLayerBurnValues;
+            if (pszBurnAttribute)
+            {
+                const double dfAttrValue =
+                    GetBurnValue(array.children[iBurnChild], iRow);
+                for (int iBand = 0; iBand < nBands; iBand++)
+                    adfAttrValues[iBand] = dfAttrValue;
+                padfBurnValues = adfAttrValues.data();
+            }
+
+            if (oGeom.ImportFromWkb(pabyData + nStart, nEnd - nStart, bWithZ))
+            {
+                gv_rasterize_flat_geometry(
+                    pabyChunkBuf, 0, nYOff, nXSize, nYSize, nBands, eType,
+                    bAllTouched, oGeom, aPointX, aPointY, aPointVariant,
+                    aPartSize, padfBurnValues, eBurnValueSrc, eMergeAlg,
+                    pfnTransformer, pTransformArg);
+            }
+            else
+            {
+                // Curve geometries for example.
+                OGRGeometry *poGeom = nullptr;
+                OGRGeometryFactory::createFromWkb(pabyData + nStart, nullptr,
+                                                  &poGeom, nEnd - nStart);
+                gv_rasterize_one_shape(
+                    pabyChunkBuf, 0, nYOff, nXSize, nYSize, nBands, eType, 0,
+                    0, 0, bAllTouched, poGeom, GDT_Float64, padfBurnValues,
+                    nullptr, eBurnValueSrc, eMergeAlg, pfnTransformer,
+                    pTransformArg);
+                delete poGeom;
+            }
+        }
+        array.release(&array);
+    }
+
+    stream.release(&stream);
+    return true;
+}
+
 /************************************************************************/
 /*                        GDALRasterizeOptions()                        */
 /*                                                                      */
@@ -833,6 +1176,24 @@ static CPLErr GDALRasterizeOptions(CSLConstList papszOptions, int *pbAllTouched,
 /*                      GDALRasterizeGeometries()                       */
 /************************************************************************/
 
+/************************************************************************/
+/*                     GDALRasterizeGetNumThreads()                     */
+/************************************************************************/
+
+// Value of the NUM_THREADS option, defaulting to GDAL_NUM_THREADS.
+static int GDALRasterizeGetNumThreads(CSLConstList papszOptions)
+{
+    const char *pszNumThreads = CSLFetchNameValueDef(
+        papszOptions, "NUM_THREADS",
+        CPLGetConfigOption("GDAL_NUM_THREADS", nullptr));
+    if (pszNumThreads == nullptr)
+        return 1;
+    const int nThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : atoi(pszNumThreads);
+    return std::max(1, std::min(nThreads, 128));
+}
+
 static CPLErr GDALRasterizeGeometriesInternal(
     GDALDatasetH hDS, int nBandCount, const int *panBandList, int nGeomCount,
     const OGRGeometryH *pahGeometries, GDALTransformerFunc pfnTransformer,
@@ -889,6 +1250,9 @@ static CPLErr GDALRasterizeGeometriesInternal(
  * used. Default size will be estimated based on the GDAL cache buffer size
  * using formula: cache_size_bytes/scanline_size_bytes, so the chunk will
  * not exceed the cache. Not used in OPTIM=RASTER mode.</li>
+ * <li>"NUM_THREADS": (GDAL >= 3.9) Number of threads, or ALL_CPUS, used to
+ * split the rows of polygons with many vertices. Defaults to the value of the
+ * GDAL_NUM_THREADS configuration option.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -1035,6 +1399,11 @@ static CPLErr GDALRasterizeGeometriesInternal(
         return CE_Failure;
     }
 
+    // Used to split the rows of large polygons among threads
+    const int nThreads = GDALRasterizeGetNumThreads(papszOptions);
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+
     /* -------------------------------------------------------------------- */
     /*      If we have no transformer, assume the geometries are in file    */
     /*      georeferenced coordinates, and create a transformer to          */
@@ -1179,7 +1548,8 @@ static CPLErr GDALRasterizeGeometriesInternal(
                         : nullptr,
                     panGeomBurnValues ? panGeomBurnValues + iShape * nBandCount
                                       : nullptr,
-                    eBurnValueSource, eMergeAlg, pfnTransformer, pTransformArg);
+                    eBurnValueSource, eMergeAlg, pfnTransformer, pTransformArg,
+                    poThreadPool);
             }
 
             eErr = poDS->RasterIO(
@@ -1348,7 +1718,7 @@ static CPLErr GDALRasterizeGeometriesInternal(
                             ? panGeomBurnValues + iShape * nBandCount
                             : nullptr,
                         eBurnValueSource, eMergeAlg, pfnTransformer,
-                        pTransformArg);
+                        pTransformArg, poThreadPool);
 
                     eErr = poDS->RasterIO(
                         GF_Write, xB * nXBlockSize, yB * nYBlockSize,
@@ -1388,6 +1758,464 @@ static CPLErr GDALRasterizeGeometriesInternal(
     return eErr;
 }
 
+/************************************************************************/
+/*                 GDALCreateRasterizeLayerTransformer()                */
+/************************************************************************/
+
+// Create a transformer from the coordinate system of the layer to the
+// pixel/line coordinates of the dataset.
+static void *GDALCreateRasterizeLayerTransformer(GDALDataset *poDS,
+                                                 OGRLayer *poLayer)
+{
+    char *pszProjection = nullptr;
+
+    OGRSpatialReference *poSRS = poLayer->GetSpatialRef();
+    if (!poSRS)
+    {
+        CPLError(CE_Warning, CPLE_AppDefined,
+                 "Failed to fetch spatial reference on layer %s "
+                 "to build transformer, assuming matching coordinate "
+                 "systems.",
+                 poLayer->GetLayerDefn()->GetName());
+    }
+    else
+    {
+        poSRS->exportToWkt(&pszProjection);
+    }
+
+    char **papszTransformerOptions = nullptr;
+    if (pszProjection != nullptr)
+        papszTransformerOptions =
+            CSLSetNameValue(papszTransformerOptions, "SRC_SRS", pszProjection);
+    double adfGeoTransform[6] = {};
+    if (poDS->GetGeoTransform(adfGeoTransform) != CE_None &&
+        poDS->GetGCPCount() == 0 && poDS->GetMetadata("RPC") == nullptr)
+    {
+        papszTransformerOptions = CSLSetNameValue(
+            papszTransformerOptions, "DST_METHOD", "NO_GEOTRANSFORM");
+    }
+
+    void *pTransformArg = GDALCreateGenImgProjTransformer2(
+        nullptr, GDALDataset::ToHandle(poDS), papszTransformerOptions);
+
+    CPLFree(pszProjection);
+    CSLDestroy(papszTransformerOptions);
+    return pTransformArg;
+}
+
+/************************************************************************/
+/*                      Tiled multi-threaded mode                       */
+/************************************************************************/
+
+namespace
+{
+// Geometry, or part of geometry, in pixel/line coordinates, ready to be
+// burnt with gv_rasterize_flat_shape()
+struct GDALRasterizeShape
+{
+    OGRwkbGeometryType eGeomType = wkbUnknown;
+    std::vector<double> aPointX{};
+    std::vector<double> aPointY{};
+    std::vector<double> aPointVariant{};
+    std::vector<int> aPartSize{};
+    std::vector<double> adfBurnValues{};
+};
+
+struct GDALRasterizeTiledContext
+{
+    GDALDataset *poDS = nullptr;
+    int nBandCount = 0;
+    int *panBandList = nullptr;
+    GDALDataType eType = GDT_Unknown;
+    int bAllTouched = FALSE;
+    GDALBurnValueSrc eBurnValueSource = GBV_UserBurnValue;
+    GDALRasterMergeAlg eMergeAlg = GRMA_Replace;
+
+    int nTileXSize = 0;
+    int nTileYSize = 0;
+    int nTilesPerRow = 0;
+    int nTilesPerColumn = 0;
+
+    std::vector<GDALRasterizeShape> aoShapes{};
+    // Indices in aoShapes of the shapes intersecting each tile, in reading
+    // order, so that the last feature wins in GRMA_Replace mode.
+    std::vector<std::vector<size_t>> aanTileShapes{};
+
+    std::mutex oIOMutex{};  // RasterIO() is not thread-safe
+    std::atomic<bool> bStop{false};
+    std::atomic<bool> bError{false};
+};
+
+struct GDALRasterizeTileJob
+{
+    GDALRasterizeTiledContext *psContext = nullptr;
+    size_t nTile = 0;
+};
+}  // namespace
+
+/************************************************************************/
+/*                     GDALRasterizeCollectShape()                      */
+/************************************************************************/
+
+// Transform a geometry to pixel/line coordinates, and assign it to the tiles
+// it intersects.
+static void GDALRasterizeCollectShape(GDALRasterizeTiledContext &sContext,
+                                      const OGRGeometry *poShape,
+                                      const double *padfBurnValues,
+                                      GDALTransformerFunc pfnTransformer,
+                                      void *pTransformArg)
+{
+    if (poShape == nullptr || poShape->IsEmpty())
+        return;
+    const auto eGeomType = wkbFlatten(poShape->getGeometryType());
+
+    if ((eGeomType == wkbMultiLineString || eGeomType == wkbMultiPolygon ||
+         eGeomType == wkbGeometryCollection) &&
+        sContext.eMergeAlg == GRMA_Replace)
+    {
+        // Same as in gv_rasterize_one_shape(): parts are rasterized
+        // separately, which also makes the binning into tiles finer.
+        for (const auto poPart : *(poShape->toGeometryCollection()))
+        {
+            GDALRasterizeCollectShape(sContext, poPart, padfBurnValues,
+                                      pfnTransformer, pTransformArg);
+        }
+        return;
+    }
+
+    GDALRasterizeShape oShape;
+    oShape.eGeomType = eGeomType;
+    GDALCollectRingsFromGeometry(poShape, oShape.aPointX, oShape.aPointY,
+                                 oShape.aPointVariant, oShape.aPartSize,
+                                 sContext.eBurnValueSource);
+    if (oShape.aPartSize.empty())
+        return;
+
+    if (pfnTransformer != nullptr)
+    {
+        std::vector<int> anSuccess(oShape.aPointX.size());
+        pfnTransformer(pTransformArg, FALSE,
+                       static_cast<int>(oShape.aPointX.size()),
+                       oShape.aPointX.data(), oShape.aPointY.data(), nullptr,
+                       anSuccess.data());
+    }
+
+    const auto oMinMaxX =
+        std::minmax_element(oShape.aPointX.begin(), oShape.aPointX.end());
+    const auto oMinMaxY =
+        std::minmax_element(oShape.aPointY.begin(), oShape.aPointY.end());
+    // Margin of one pixel to be robust to the pixel selection rules of
+    // the various burning methods.
+    const double dfMinX = std::max(0.0, std::floor(*oMinMaxX.first) - 1);
+    const double dfMinY = std::max(0.0, std::floor(*oMinMaxY.first) - 1);
+    const double dfMaxX =
+        std::min(static_cast<double>(sContext.poDS->GetRasterXSize() - 1),
+                 std::floor(*oMinMaxX.second) + 1);
+    const double dfMaxY =
+        std::min(static_cast<double>(sContext.poDS->GetRasterYSize() - 1),
+                 std::floor(*oMinMaxY.second) + 1);
+    // Also rejects NaN
+    if (!(dfMinX <= dfMaxX && dfMinY <= dfMaxY))
+        return;
+
+    oShape.adfBurnValues.assign(padfBurnValues,
+                                padfBurnValues + sContext.nBandCount);
+    const size_t iShape = sContext.aoShapes.size();
+    sContext.aoShapes.push_back(std::move(oShape));
+
+    const int nMinTileX = static_cast<int>(dfMinX) / sContext.nTileXSize;
+    const int nMinTileY = static_cast<int>(dfMinY) / sContext.nTileYSize;
+    const int nMaxTileX = static_cast<int>(dfMaxX) / sContext.nTileXSize;
+    const int nMaxTileY = static_cast<int>(dfMaxY) / sContext.nTileYSize;
+    for (int nTileY = nMinTileY; nTileY <= nMaxTileY; ++nTileY)
+    {
+        for (int nTileX = nMinTileX; nTileX <= nMaxTileX; ++nTileX)
+        {
+            sContext
+                .aanTileShapes[static_cast<size_t>(nTileY) *
+                                   sContext.nTilesPerRow +
+                               nTileX]
+                .push_back(iShape);
+        }
+    }
+}
+
+/************************************************************************/
+/*                       GDALRasterizeTileJobFunc()                     */
+/************************************************************************/
+
+static void GDALRasterizeTileJobFunc(void *pData)
+{
+    const auto psJob = static_cast<const GDALRasterizeTileJob *>(pData);
+    auto &sContext = *(psJob->psContext);
+    if (sContext.bStop)
+        return;
+
+    const int nTileX = static_cast<int>(psJob->nTile % sContext.nTilesPerRow);
+    const int nTileY = static_cast<int>(psJob->nTile / sContext.nTilesPerRow);
+    const int nXOff = nTileX * sContext.nTileXSize;
+    const int nYOff = nTileY * sContext.nTileYSize;
+    const int nXSize = std::min(sContext.nTileXSize,
+                                sContext.poDS->GetRasterXSize() - nXOff);
+    const int nYSize = std::min(sContext.nTileYSize,
+                                sContext.poDS->GetRasterYSize() - nYOff);
+
+    std::vector<GByte> abyBuffer;
+    try
+    {
+        abyBuffer.resize(static_cast<size_t>(nXSize) * nYSize *
+                         sContext.nBandCount *
+                         GDALGetDataTypeSizeBytes(sContext.eType));
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory allocating rasterization buffer");
+        sContext.bError = true;
+        sContext.bStop = true;
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(sContext.oIOMutex);
+        if (sContext.poDS->RasterIO(
+                GF_Read, nXOff, nYOff, nXSize, nYSize, abyBuffer.data(), nXSize,
+                nYSize, sContext.eType, sContext.nBandCount,
+                sContext.panBandList, 0, 0, 0, nullptr) != CE_None)
+        {
+            sContext.bError = true;
+            sContext.bStop = true;
+            return;
+        }
+    }
+
+    // gv_rasterize_flat_shape() modifies the point arrays, hence work on
+    // copies.
+    std::vector<double> aPointX;
+    std::vector<double> aPointY;
+    std::vector<double> aPointVariant;
+    std::vector<int> aPartSize;
+    for (const size_t iShape : sContext.aanTileShapes[psJob->nTile])
+    {
+        const auto &oShape = sContext.aoShapes[iShape];
+        aPointX = oShape.aPointX;
+        aPointY = oShape.aPointY;
+        aPointVariant = oShape.aPointVariant;
+        aPartSize = oShape.aPartSize;
+        gv_rasterize_flat_shape(
+            abyBuffer.data(), nXOff, nYOff, nXSize, nYSize,
+            sContext.nBandCount, sContext.eType, 0, 0, 0, sContext.bAllTouched,
+            oShape.eGeomType, aPointX, aPointY, aPointVariant, aPartSize,
+            GDT_Float64, oShape.adfBurnValues.data(), nullptr,
+            sContext.eBurnValueSource, sContext.eMergeAlg, nullptr, nullptr);
+    }
+
+    std::lock_guard<std::mutex> oLock(sContext.oIOMutex);
+    if (sContext.poDS->RasterIO(GF_Write, nXOff, nYOff, nXSize, nYSize,
+                                abyBuffer.data(), nXSize, nYSize,
+                                sContext.eType, sContext.nBandCount,
+                                sContext.panBandList, 0, 0, 0,
+                                nullptr) != CE_None)
+    {
+        sContext.bError = true;
+        sContext.bStop = true;
+    }
+}
+
+/************************************************************************/
+/*                      GDALRasterizeLayersTiled()                      */
+/************************************************************************/
+
+// Variant of GDALRasterizeLayers() that reads the layers only once, assigns
+// the geometries to the tiles of the output raster they intersect, and burns
+// tiles in parallel. This trades memory (all the transformed geometries are
+// kept) for speed.
+static CPLErr GDALRasterizeLayersTiled(
+    GDALDataset *poDS, int nBandCount, int *panBandList, int nLayerCount,
+    OGRLayerH *pahLayers, GDALTransformerFunc pfnTransformer,
+    void *pTransformArg, double *padfLayerBurnValues,
+    const char *pszBurnAttribute, int bAllTouched,
+    GDALBurnValueSrc eBurnValueSource, GDALRasterMergeAlg eMergeAlg,
+    int nThreads, GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    GDALRasterizeTiledContext sContext;
+    sContext.poDS = poDS;
+    sContext.nBandCount = nBandCount;
+    sContext.panBandList = panBandList;
+    sContext.eType = poDS->GetRasterBand(panBandList[0])->GetRasterDataType();
+    sContext.bAllTouched = bAllTouched;
+    sContext.eBurnValueSource = eBurnValueSource;
+    sContext.eMergeAlg = eMergeAlg;
+
+    // Tiles of about 1024x1024 pixels, aligned on blocks when possible
+    constexpr int TILE_SIZE = 1024;
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poDS->GetRasterBand(panBandList[0])
+        ->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    sContext.nTileXSize = nBlockXSize <= TILE_SIZE
+                              ? DIV_ROUND_UP(TILE_SIZE, nBlockXSize) *
+                                    nBlockXSize
+                              : TILE_SIZE;
+    sContext.nTileYSize = nBlockYSize <= TILE_SIZE
+                              ? DIV_ROUND_UP(TILE_SIZE, nBlockYSize) *
+                                    nBlockYSize
+                              : TILE_SIZE;
+    sContext.nTileXSize =
+        std::min(sContext.nTileXSize, poDS->GetRasterXSize());
+    sContext.nTileYSize =
+        std::min(sContext.nTileYSize, poDS->GetRasterYSize());
+    sContext.nTilesPerRow =
+        DIV_ROUND_UP(poDS->GetRasterXSize(), sContext.nTileXSize);
+    sContext.nTilesPerColumn =
+        DIV_ROUND_UP(poDS->GetRasterYSize(), sContext.nTileYSize);
+    const size_t nTiles = static_cast<size_t>(sContext.nTilesPerRow) *
+                          sContext.nTilesPerColumn;
+    try
+    {
+        sContext.aanTileShapes.resize(nTiles);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "Too many tiles");
+        return CE_Failure;
+    }
+    CPLDebug("GDAL", "Rasterizer operating on %d x %d tiles of %d x %d pixels",
+             sContext.nTilesPerRow, sContext.nTilesPerColumn,
+             sContext.nTileXSize, sContext.nTileYSize);
+
+    /* -------------------------------------------------------------------- */
+    /*      Read the layers once, and bin their geometries into tiles.      */
+    /* -------------------------------------------------------------------- */
+    pfnProgress(0.0, nullptr, pProgressArg);
+    std::vector<double> adfAttrValues(nBandCount);
+    try
+    {
+        for (int iLayer = 0; iLayer < nLayerCount; iLayer++)
+        {
+            OGRLayer *poLayer = OGRLayer::FromHandle(pahLayers[iLayer]);
+
+            if (!poLayer)
+            {
+                CPLError(CE_Warning, CPLE_AppDefined,
+                         "Layer element number %d is NULL, skipping.", iLayer);
+                continue;
+            }
+
+            if (poLayer->GetFeatureCount(FALSE) == 0)
+                continue;
+
+            int iBurnField = -1;
+            const double *padfBurnValues = nullptr;
+            if (pszBurnAttribute)
+            {
+                iBurnField =
+                    poLayer->GetLayerDefn()->GetFieldIndex(pszBurnAttribute);
+                if (iBurnField == -1)
+                {
+                    CPLError(CE_Warning, CPLE_AppDefined,
+                             "Failed to find field %s on layer %s, skipping.",
+                             pszBurnAttribute,
+                             poLayer->GetLayerDefn()->GetName());
+                    continue;
+                }
+                padfBurnValues = adfAttrValues.data();
+            }
+            else
+            {
+                padfBurnValues = padfLayerBurnValues + iLayer * nBandCount;
+            }
+
+            GDALTransformerFunc pfnLayerTransformer = pfnTransformer;
+            void *pLayerTransformArg = pTransformArg;
+            if (pfnLayerTransformer == nullptr)
+            {
+                pLayerTransformArg =
+                    GDALCreateRasterizeLayerTransformer(poDS, poLayer);
+                if (pLayerTransformArg == nullptr)
+                    return CE_Failure;
+                pfnLayerTransformer = GDALGenImgProjTransform;
+            }
+
+            for (auto &poFeat : poLayer)
+            {
+                if (pszBurnAttribute)
+                {
+                    std::fill(adfAttrValues.begin(), adfAttrValues.end(),
+                              poFeat->GetFieldAsDouble(iBurnField));
+                }
+                GDALRasterizeCollectShape(sContext, poFeat->GetGeometryRef(),
+                                          padfBurnValues, pfnLayerTransformer,
+                                          pLayerTransformArg);
+            }
+
+            if (pfnTransformer == nullptr)
+                GDALDestroyTransformer(pLayerTransformArg);
+
+            if (!pfnProgress(0.5 * (iLayer + 1) / nLayerCount, "",
+                             pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                return CE_Failure;
+            }
+        }
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory while collecting geometries to rasterize");
+        return CE_Failure;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Burn the non-empty tiles in parallel.                           */
+    /* -------------------------------------------------------------------- */
+    std::vector<GDALRasterizeTileJob> asJobs;
+    for (size_t iTile = 0; iTile < nTiles; ++iTile)
+    {
+        if (!sContext.aanTileShapes[iTile].empty())
+        {
+            GDALRasterizeTileJob sJob;
+            sJob.psContext = &sContext;
+            sJob.nTile = iTile;
+            asJobs.push_back(sJob);
+        }
+    }
+
+    CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    if (poJobQueue == nullptr)
+    {
+        for (auto &sJob : asJobs)
+            GDALRasterizeTileJobFunc(&sJob);
+    }
+    else
+    {
+        for (auto &sJob : asJobs)
+            poJobQueue->SubmitJob(GDALRasterizeTileJobFunc, &sJob);
+        for (size_t i = asJobs.size(); i > 0; --i)
+        {
+            poJobQueue->WaitCompletion(static_cast<int>(
+                std::min<size_t>(i - 1, std::numeric_limits<int>::max())));
+            if (!sContext.bStop &&
+                !pfnProgress(0.5 + 0.5 * (asJobs.size() - i + 1) /
+                                       asJobs.size(),
+                             "", pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                sContext.bError = true;
+                sContext.bStop = true;
+            }
+        }
+        poJobQueue->WaitCompletion();
+    }
+
+    if (sContext.bError)
+        return CE_Failure;
+    pfnProgress(1.0, "", pProgressArg);
+    return CE_None;
+}
+
 /************************************************************************/
 /*                        GDALRasterizeLayers()                         */
 /************************************************************************/
@@ -1442,6 +2270,11 @@ static CPLErr GDALRasterizeGeometriesInternal(
  * <li>"MERGE_ALG": May be REPLACE (the default) or ADD.  REPLACE results in
  * overwriting of value, while ADD adds the new value to the existing raster,
  * suitable for heatmaps for instance.</li>
+ * <li>"NUM_THREADS": (GDAL >= 3.9) Number of threads, or ALL_CPUS. Defaults to
+ * the value of the GDAL_NUM_THREADS configuration option. When greater than
+ * one, the layers are read only once, their geometries are assigned to the
+ * tiles of the output raster they intersect, and tiles are burnt in parallel.
+ * All the geometries are then kept in memory, and CHUNKYSIZE is ignored.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -1488,6 +2321,16 @@ CPLErr GDALRasterizeLayers(GDALDatasetH hDS, int nBandCount, int *panBandList,
         return CE_Failure;
     }
 
+    const int nThreads = GDALRasterizeGetNumThreads(papszOptions);
+    if (nThreads > 1)
+    {
+        return GDALRasterizeLayersTiled(
+            poDS, nBandCount, panBandList, nLayerCount, pahLayers,
+            pfnTransformer, pTransformArg, padfLayerBurnValues,
+            CSLFetchNameValue(papszOptions, "ATTRIBUTE"), bAllTouched,
+            eBurnValueSource, eMergeAlg, nThreads, pfnProgress, pProgressArg);
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Establish a chunksize to operate on.  The larger the chunk      */
     /*      size the less times we need to make a pass through all the      */
@@ -1603,41 +2446,9 @@ CPLErr GDALRasterizeLayers(GDALDatasetH hDS, int nBandCount, int *panBandList,
 
         if (pfnTransformer == nullptr)
         {
-            char *pszProjection = nullptr;
             bNeedToFreeTransformer = true;
-
-            OGRSpatialReference *poSRS = poLayer->GetSpatialRef();
-            if (!poSRS)
-            {
-                CPLError(CE_Warning, CPLE_AppDefined,
-                         "Failed to fetch spatial reference on layer %s "
-                         "to build transformer, assuming matching coordinate "
-                         "systems.",
-                         poLayer->GetLayerDefn()->GetName());
-            }
-            else
-            {
-                poSRS->exportToWkt(&pszProjection);
-            }
-
-            char **papszTransformerOptions = nullptr;
-            if (pszProjection != nullptr)
-                papszTransformerOptions = CSLSetNameValue(
-                    papszTransformerOptions, "SRC_SRS", pszProjection);
-            double adfGeoTransform[6] = {};
-            if (poDS->GetGeoTransform(adfGeoTransform) != CE_None &&
-                poDS->GetGCPCount() == 0 && poDS->GetMetadata("RPC") == nullptr)
-            {
-                papszTransformerOptions = CSLSetNameValue(
-                    papszTransformerOptions, "DST_METHOD", "NO_GEOTRANSFORM");
-            }
-
-            pTransformArg = GDALCreateGenImgProjTransformer2(
-                nullptr, hDS, papszTransformerOptions);
+            pTransformArg = GDALCreateRasterizeLayerTransformer(poDS, poLayer);
             pfnTransformer = GDALGenImgProjTransform;
-
-            CPLFree(pszProjection);
-            CSLDestroy(papszTransformerOptions);
             if (pTransformArg == nullptr)
             {
                 CPLFree(pabyChunkBuf);
@@ -1676,25 +2487,42 @@ CPLErr GDALRasterizeLayers(GDALDatasetH hDS, int nBandCount, int *panBandList,
                     break;
             }
 
-            for (auto &poFeat : poLayer)
+            bool bArrowError = false;
+            if (gv_rasterize_layer_arrow_stream(
+                    poLayer, pabyChunkBuf, iY, poDS->GetRasterXSize(),
+                    nThisYChunkSize, nBandCount, eType, bAllTouched,
+                    pszBurnAttribute, padfBurnValues, eBurnValueSource,
+                    eMergeAlg, pfnTransformer, pTransformArg, bArrowError))
             {
-                OGRGeometry *poGeom = poFeat->GetGeometryRef();
-
-                if (pszBurnAttribute)
+                if (bArrowError)
                 {
-                    const double dfAttrValue =
-                        poFeat->GetFieldAsDouble(iBurnField);
-                    for (int iBand = 0; iBand < nBandCount; iBand++)
-                        padfAttrValues[iBand] = dfAttrValue;
-
-                    padfBurnValues = padfAttrValues;
+                    eErr = CE_Failure;
+                    break;
                 }
+            }
+            else
+            {
+                for (auto &poFeat : poLayer)
+                {
+                    OGRGeometry *poGeom = poFeat->GetGeometryRef();
 
-                gv_rasterize_one_shape(
-                    pabyChunkBuf, 0, iY, poDS->GetRasterXSize(),
-                    nThisYChunkSize, nBandCount, eType, 0, 0, 0, bAllTouched,
-                    poGeom, GDT_Float64, padfBurnValues, nullptr,
-                    eBurnValueSource, eMergeAlg, pfnTransformer, pTransformArg);
+                    if (pszBurnAttribute)
+                    {
+                        const double dfAttrValue =
+                            poFeat->GetFieldAsDouble(iBurnField);
+                        for (int iBand = 0; iBand < nBandCount; iBand++)
+                            padfAttrValues[iBand] = dfAttrValue;
+
+                        padfBurnValues = padfAttrValues;
+                    }
+
+                    gv_rasterize_one_shape(
+                        pabyChunkBuf, 0, iY, poDS->GetRasterXSize(),
+                        nThisYChunkSize, nBandCount, eType, 0, 0, 0,
+                        bAllTouched, poGeom, GDT_Float64, padfBurnValues,
+                        nullptr, eBurnValueSource, eMergeAlg, pfnTransformer,
+                        pTransformArg);
+                }
             }
 
             // Only write image if not a single chunk is being rendered.
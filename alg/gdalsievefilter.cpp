@@ -33,17 +33,24 @@
 #include <cstring>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <limits>
+#include <mutex>
 #include <set>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
+#include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_alg_priv.h"
+#include "gdal_thread_pool.h"
 
 #define MY_MAX_INT 2147483647
 
@@ -142,6 +149,686 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
         anBigNeighbour[nPolyId2] = nPolyId1;
 }
 
+/************************************************************************/
+/*                      Multi-threaded processing                       */
+/*                                                                      */
+/*      The raster is split into bands of rows, each processed by a     */
+/*      worker thread with its own polygon enumerator:                  */
+/*                                                                      */
+/*      1) Polygons are enumerated and sized per band.  Polygons        */
+/*         crossing the seams between bands are then merged with a      */
+/*         union-find, which gives global polygon ids.                  */
+/*                                                                      */
+/*      2) Each band finds, for each polygon it sees, the largest       */
+/*         neighbour it encounters first.  As a neighbour only          */
+/*         replaces the current one if it is strictly larger, folding   */
+/*         the per-band results in band order gives the exact same      */
+/*         biggest neighbours as the sequential scan.                   */
+/*                                                                      */
+/*      3) After the (sequential, and cheap) resolution of the merge    */
+/*         targets, bands are rewritten in parallel.                    */
+/*                                                                      */
+/*      The result is thus identical to the single-threaded mode.       */
+/************************************************************************/
+
+namespace
+{
+struct GSieveContext
+{
+    GDALRasterBandH hSrcBand = nullptr;
+    GDALRasterBandH hMaskBand = nullptr;
+    GDALRasterBandH hDstBand = nullptr;
+    int nXSize = 0;
+    int nConnectedness = 4;
+    std::mutex oIOMutex{};  // RasterIO() is not thread-safe
+    std::atomic<bool> bStop{false};
+
+    // Indexed by global polygon id.
+    std::vector<GInt32> anParent{};
+    std::vector<int> anPolySizes{};
+    std::vector<std::int64_t> anPolyValue{};
+    std::vector<int> anBigNeighbour{};
+};
+
+struct GSieveBand
+{
+    GSieveContext *psContext = nullptr;
+    int nYStart = 0;
+    int nYEnd = 0;
+
+    // Local polygon id to local final id after the first pass, then to
+    // global final id.
+    std::vector<GInt32> anIdMap{};
+    std::vector<int> anPolySizes{};
+    std::vector<std::int64_t> anPolyValue{};
+
+    // Pixel values and local polygon ids of the first and last lines.
+    std::vector<std::int64_t> anFirstLineVal{};
+    std::vector<GInt32> anFirstLineId{};
+    std::vector<std::int64_t> anLastLineVal{};
+    std::vector<GInt32> anLastLineId{};
+
+    // Global polygon ids of the line above the band.
+    std::vector<GInt32> anPrevLineId{};
+
+    // Result of the second pass: for each polygon seen by the band (a
+    // "slot"), its global id and the global id of its biggest neighbour.
+    std::vector<GInt32> anSlotId{};
+    std::vector<GInt32> anSlotBigNeighbour{};
+};
+}  // namespace
+
+/************************************************************************/
+/*                         GSieveReadLine()                             */
+/************************************************************************/
+
+// Reads a line of the source band, and of the mask band if any, under the
+// I/O mutex. If panUnmaskedVal is not null, it receives the pixel values
+// before masking.
+static bool GSieveReadLine(GSieveContext *psContext, int iY,
+                           std::int64_t *panVal, GByte *pabyMaskLine,
+                           std::int64_t *panUnmaskedVal)
+{
+    const int nXSize = psContext->nXSize;
+    std::lock_guard<std::mutex> oLock(psContext->oIOMutex);
+    CPLErr eErr = GDALRasterIO(psContext->hSrcBand, GF_Read, 0, iY, nXSize, 1,
+                               panVal, nXSize, 1, GDT_Int64, 0, 0);
+    if (eErr == CE_None && panUnmaskedVal)
+        memcpy(panUnmaskedVal, panVal, sizeof(panVal[0]) * nXSize);
+    if (eErr == CE_None && psContext->hMaskBand != nullptr)
+        eErr = GPMaskImageData(psContext->hMaskBand, pabyMaskLine, iY, nXSize,
+                               panVal);
+    return eErr == CE_None;
+}
+
+/************************************************************************/
+/*                        GSieveLabelBandFunc()                         */
+/************************************************************************/
+
+static void GSieveLabelBandFunc(void *pData)
+{
+    GSieveBand *psBand = static_cast<GSieveBand *>(pData);
+    GSieveContext *psContext = psBand->psContext;
+    const int nXSize = psContext->nXSize;
+    if (psContext->bStop)
+        return;
+
+    GDALRasterPolygonEnumerator oEnum(psContext->nConnectedness);
+    try
+    {
+        std::vector<std::int64_t> anLastLineVal(nXSize), anThisLineVal(nXSize);
+        std::vector<GInt32> anLastLineId(nXSize), anThisLineId(nXSize);
+        std::vector<GByte> abyMaskLine(psContext->hMaskBand ? nXSize : 0);
+        auto &anPolySizes = psBand->anPolySizes;
+
+        for (int iY = psBand->nYStart; iY < psBand->nYEnd; ++iY)
+        {
+            if (psContext->bStop ||
+                !GSieveReadLine(psContext, iY, anThisLineVal.data(),
+                                abyMaskLine.data(), nullptr))
+            {
+                psContext->bStop = true;
+                return;
+            }
+
+            const bool bFirstLine = iY == psBand->nYStart;
+            if (!oEnum.ProcessLine(bFirstLine ? nullptr : anLastLineVal.data(),
+                                   anThisLineVal.data(),
+                                   bFirstLine ? nullptr : anLastLineId.data(),
+                                   anThisLineId.data(), nXSize))
+            {
+                psContext->bStop = true;
+                return;
+            }
+
+            if (oEnum.nNextPolygonId > static_cast<int>(anPolySizes.size()))
+                anPolySizes.resize(oEnum.nNextPolygonId);
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                const int iPoly = anThisLineId[iX];
+                if (iPoly >= 0 && anPolySizes[iPoly] < MY_MAX_INT)
+                    anPolySizes[iPoly] += 1;
+            }
+
+            if (bFirstLine)
+            {
+                psBand->anFirstLineVal = anThisLineVal;
+                psBand->anFirstLineId = anThisLineId;
+            }
+
+            std::swap(anLastLineVal, anThisLineVal);
+            std::swap(anLastLineId, anThisLineId);
+        }
+
+        oEnum.CompleteMerges();
+
+        anPolySizes.resize(oEnum.nNextPolygonId);
+        psBand->anLastLineVal = std::move(anLastLineVal);
+        psBand->anLastLineId = std::move(anLastLineId);
+        psBand->anIdMap.assign(oEnum.panPolyIdMap,
+                               oEnum.panPolyIdMap + oEnum.nNextPolygonId);
+        psBand->anPolyValue.assign(oEnum.panPolyValue,
+                                   oEnum.panPolyValue + oEnum.nNextPolygonId);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALSieveFilter()");
+        psContext->bStop = true;
+    }
+}
+
+/************************************************************************/
+/*                      GSieveNeighbourBandFunc()                       */
+/************************************************************************/
+
+static void GSieveNeighbourBandFunc(void *pData)
+{
+    GSieveBand *psBand = static_cast<GSieveBand *>(pData);
+    GSieveContext *psContext = psBand->psContext;
+    const int nXSize = psContext->nXSize;
+    const int nConnectedness = psContext->nConnectedness;
+    if (psContext->bStop)
+        return;
+
+    GDALRasterPolygonEnumerator oEnum(nConnectedness);
+    try
+    {
+        // Assign a slot to each distinct global polygon seen by the band,
+        // including the ones of the line above it.
+        std::unordered_map<GInt32, GInt32> oMapGlobalIdToSlot;
+        auto &anSlotId = psBand->anSlotId;
+        const auto GetSlot = [&oMapGlobalIdToSlot, &anSlotId](GInt32 nId)
+        {
+            const auto oIter = oMapGlobalIdToSlot.find(nId);
+            if (oIter != oMapGlobalIdToSlot.end())
+                return oIter->second;
+            const GInt32 nSlot = static_cast<GInt32>(anSlotId.size());
+            oMapGlobalIdToSlot[nId] = nSlot;
+            anSlotId.push_back(nId);
+            return nSlot;
+        };
+        std::vector<GInt32> anLocalIdToSlot(psBand->anIdMap.size());
+        for (size_t i = 0; i < psBand->anIdMap.size(); ++i)
+            anLocalIdToSlot[i] = GetSlot(psBand->anIdMap[i]);
+
+        std::vector<std::int64_t> anLastLineVal(nXSize), anThisLineVal(nXSize);
+        std::vector<GInt32> anLastLineId(nXSize), anThisLineId(nXSize);
+        std::vector<GInt32> anLastLineSlot(nXSize), anThisLineSlot(nXSize);
+        std::vector<GByte> abyMaskLine(psContext->hMaskBand ? nXSize : 0);
+        const bool bHasPrevLine = !psBand->anPrevLineId.empty();
+        if (bHasPrevLine)
+        {
+            for (int iX = 0; iX < nXSize; ++iX)
+            {
+                const GInt32 nId = psBand->anPrevLineId[iX];
+                anLastLineSlot[iX] = nId < 0 ? -1 : GetSlot(nId);
+            }
+        }
+
+        auto &anBigNeighbour = psBand->anSlotBigNeighbour;
+        anBigNeighbour.resize(anSlotId.size(), -1);
+        const auto &anPolySizes = psContext->anPolySizes;
+        // Same as CompareNeighbour(), on slots.
+        const auto Compare = [&anBigNeighbour, &anPolySizes,
+                              &anSlotId](GInt32 nSlot1, GInt32 nSlot2)
+        {
+            if (nSlot1 < 0 || nSlot2 < 0 || nSlot1 == nSlot2)
+                return;
+            const int nSize1 = anPolySizes[anSlotId[nSlot1]];
+            const int nSize2 = anPolySizes[anSlotId[nSlot2]];
+            if (anBigNeighbour[nSlot1] == -1 ||
+                anPolySizes[anSlotId[anBigNeighbour[nSlot1]]] < nSize2)
+                anBigNeighbour[nSlot1] = nSlot2;
+            if (anBigNeighbour[nSlot2] == -1 ||
+                anPolySizes[anSlotId[anBigNeighbour[nSlot2]]] < nSize1)
+                anBigNeighbour[nSlot2] = nSlot1;
+        };
+
+        for (int iY = psBand->nYStart; iY < psBand->nYEnd; ++iY)
+        {
+            if (psContext->bStop ||
+                !GSieveReadLine(psContext, iY, anThisLineVal.data(),
+                                abyMaskLine.data(), nullptr))
+            {
+                psContext->bStop = true;
+                return;
+            }
+
+            const bool bFirstLine = iY == psBand->nYStart;
+            if (!oEnum.ProcessLine(bFirstLine ? nullptr : anLastLineVal.data(),
+                                   anThisLineVal.data(),
+                                   bFirstLine ? nullptr : anLastLineId.data(),
+                                   anThisLineId.data(), nXSize))
+            {
+                psContext->bStop = true;
+                return;
+            }
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                const GInt32 nId = anThisLineId[iX];
+                anThisLineSlot[iX] = nId < 0 ? -1 : anLocalIdToSlot[nId];
+            }
+
+            const bool bCompareLastLine = !bFirstLine || bHasPrevLine;
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                if (bCompareLastLine)
+                {
+                    Compare(anThisLineSlot[iX], anLastLineSlot[iX]);
+                    if (iX > 0 && nConnectedness == 8)
+                        Compare(anThisLineSlot[iX], anLastLineSlot[iX - 1]);
+                    if (iX < nXSize - 1 && nConnectedness == 8)
+                        Compare(anThisLineSlot[iX], anLastLineSlot[iX + 1]);
+                }
+                if (iX > 0)
+                    Compare(anThisLineSlot[iX], anThisLineSlot[iX - 1]);
+            }
+
+            std::swap(anLastLineVal, anThisLineVal);
+            std::swap(anLastLineId, anThisLineId);
+            std::swap(anLastLineSlot, anThisLineSlot);
+        }
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALSieveFilter()");
+        psContext->bStop = true;
+    }
+}
+
+/************************************************************************/
+/*                        GSieveApplyBandFunc()                         */
+/************************************************************************/
+
+static void GSieveApplyBandFunc(void *pData)
+{
+    GSieveBand *psBand = static_cast<GSieveBand *>(pData);
+    GSieveContext *psContext = psBand->psContext;
+    const int nXSize = psContext->nXSize;
+    if (psContext->bStop)
+        return;
+
+    GDALRasterPolygonEnumerator oEnum(psContext->nConnectedness);
+    try
+    {
+        std::vector<std::int64_t> anLastLineVal(nXSize), anThisLineVal(nXSize);
+        std::vector<std::int64_t> anWriteVal(nXSize);
+        std::vector<GInt32> anLastLineId(nXSize), anThisLineId(nXSize);
+        std::vector<GByte> abyMaskLine(psContext->hMaskBand ? nXSize : 0);
+        const auto &anBigNeighbour = psContext->anBigNeighbour;
+        const auto &anPolyValue = psContext->anPolyValue;
+
+        for (int iY = psBand->nYStart; iY < psBand->nYEnd; ++iY)
+        {
+            if (psContext->bStop ||
+                !GSieveReadLine(psContext, iY, anThisLineVal.data(),
+                                abyMaskLine.data(), anWriteVal.data()))
+            {
+                psContext->bStop = true;
+                return;
+            }
+
+            const bool bFirstLine = iY == psBand->nYStart;
+            oEnum.ProcessLine(bFirstLine ? nullptr : anLastLineVal.data(),
+                              anThisLineVal.data(),
+                              bFirstLine ? nullptr : anLastLineId.data(),
+                              anThisLineId.data(), nXSize);
+
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                const GInt32 nId = anThisLineId[iX];
+                if (nId >= 0)
+                {
+                    const GInt32 nGlobalId = psBand->anIdMap[nId];
+                    if (anBigNeighbour[nGlobalId] != -1)
+                        anWriteVal[iX] =
+                            anPolyValue[anBigNeighbour[nGlobalId]];
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> oLock(psContext->oIOMutex);
+                if (GDALRasterIO(psContext->hDstBand, GF_Write, 0, iY, nXSize,
+                                 1, anWriteVal.data(), nXSize, 1, GDT_Int64, 0,
+                                 0) != CE_None)
+                {
+                    psContext->bStop = true;
+                    return;
+                }
+            }
+
+            std::swap(anLastLineVal, anThisLineVal);
+            std::swap(anLastLineId, anThisLineId);
+        }
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALSieveFilter()");
+        psContext->bStop = true;
+    }
+}
+
+/************************************************************************/
+/*                          GSieveRunBands()                            */
+/************************************************************************/
+
+static bool GSieveRunBands(CPLWorkerThreadPool *poThreadPool,
+                           std::vector<GSieveBand> &asBands,
+                           CPLThreadFunc pfnFunc, double dfProgressStart,
+                           double dfProgressEnd, GDALProgressFunc pfnProgress,
+                           void *pProgressArg)
+{
+    GSieveContext *psContext = asBands[0].psContext;
+    auto poJobQueue = poThreadPool->CreateJobQueue();
+    for (auto &sBand : asBands)
+        poJobQueue->SubmitJob(pfnFunc, &sBand);
+    const size_t nBands = asBands.size();
+    for (size_t i = nBands; i > 0; --i)
+    {
+        poJobQueue->WaitCompletion(static_cast<int>(i - 1));
+        if (!psContext->bStop &&
+            !pfnProgress(dfProgressStart + (dfProgressEnd - dfProgressStart) *
+                                               (nBands - i + 1) / nBands,
+                         "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            psContext->bStop = true;
+        }
+    }
+    poJobQueue->WaitCompletion();
+    return !psContext->bStop;
+}
+
+/************************************************************************/
+/*                          GSieveFindRootId()                          */
+/************************************************************************/
+
+static GInt32 GSieveFindRootId(std::vector<GInt32> &anParent, GInt32 nId)
+{
+    while (anParent[nId] != nId)
+    {
+        anParent[nId] = anParent[anParent[nId]];
+        nId = anParent[nId];
+    }
+    return nId;
+}
+
+/************************************************************************/
+/*                   GDALSieveFilterMultiThreaded()                     */
+/************************************************************************/
+
+static CPLErr GDALSieveFilterMultiThreaded(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand,
+    GDALRasterBandH hDstBand, int nSizeThreshold, int nConnectedness,
+    CPLWorkerThreadPool *poThreadPool, int nBandCount,
+    GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+
+    GSieveContext sContext;
+    sContext.hSrcBand = hSrcBand;
+    sContext.hMaskBand = hMaskBand;
+    sContext.hDstBand = hDstBand;
+    sContext.nXSize = nXSize;
+    sContext.nConnectedness = nConnectedness;
+
+    std::vector<GSieveBand> asBands(nBandCount);
+    for (int i = 0; i < nBandCount; ++i)
+    {
+        asBands[i].psContext = &sContext;
+        asBands[i].nYStart =
+            static_cast<int>(static_cast<GIntBig>(nYSize) * i / nBandCount);
+        asBands[i].nYEnd = static_cast<int>(static_cast<GIntBig>(nYSize) *
+                                            (i + 1) / nBandCount);
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      First pass: enumerate and size the polygons of each band.       */
+    /* -------------------------------------------------------------------- */
+    if (!GSieveRunBands(poThreadPool, asBands, GSieveLabelBandFunc, 0.0, 0.25,
+                        pfnProgress, pProgressArg))
+        return CE_Failure;
+
+    try
+    {
+        /* ---------------------------------------------------------------- */
+        /*      Make the polygon ids of each band global.                   */
+        /* ---------------------------------------------------------------- */
+        GIntBig nTotalIds = 0;
+        for (auto &sBand : asBands)
+        {
+            if (nTotalIds + static_cast<GIntBig>(sBand.anIdMap.size()) >
+                std::numeric_limits<GInt32>::max())
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "GDALSieveFilter(): maximum number of polygons "
+                         "reached");
+                return CE_Failure;
+            }
+            const GInt32 nOffset = static_cast<GInt32>(nTotalIds);
+            for (auto &nId : sBand.anIdMap)
+                nId += nOffset;
+            nTotalIds += static_cast<GIntBig>(sBand.anIdMap.size());
+        }
+
+        auto &anParent = sContext.anParent;
+        anParent.resize(static_cast<size_t>(nTotalIds));
+        for (GInt32 i = 0; i < static_cast<GInt32>(nTotalIds); ++i)
+            anParent[i] = i;
+
+        /* ---------------------------------------------------------------- */
+        /*      Merge the polygons crossing seams, applying the same        */
+        /*      connectivity rules as GDALRasterPolygonEnumerator.          */
+        /* ---------------------------------------------------------------- */
+        for (int iBand = 1; iBand < nBandCount; ++iBand)
+        {
+            const auto &sAbove = asBands[iBand - 1];
+            const auto &sBelow = asBands[iBand];
+            const auto Merge = [&](int iXAbove, int iXBelow)
+            {
+                const GInt32 nIdAbove = sAbove.anLastLineId[iXAbove];
+                const GInt32 nIdBelow = sBelow.anFirstLineId[iXBelow];
+                if (nIdAbove < 0 || nIdBelow < 0 ||
+                    sAbove.anLastLineVal[iXAbove] !=
+                        sBelow.anFirstLineVal[iXBelow])
+                    return;
+                const GInt32 nRootAbove =
+                    GSieveFindRootId(anParent, sAbove.anIdMap[nIdAbove]);
+                const GInt32 nRootBelow =
+                    GSieveFindRootId(anParent, sBelow.anIdMap[nIdBelow]);
+                if (nRootAbove != nRootBelow)
+                    anParent[std::max(nRootAbove, nRootBelow)] =
+                        std::min(nRootAbove, nRootBelow);
+            };
+            for (int iX = 0; iX < nXSize; ++iX)
+            {
+                Merge(iX, iX);
+                if (nConnectedness == 8)
+                {
+                    if (iX > 0)
+                        Merge(iX - 1, iX);
+                    if (iX < nXSize - 1)
+                        Merge(iX + 1, iX);
+                }
+            }
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Accumulate sizes and values per global polygon.             */
+        /*      Non-final ids are also attached to their final id, so      */
+        /*      that final ids are exactly the roots of anParent.           */
+        /* ---------------------------------------------------------------- */
+        sContext.anPolySizes.resize(static_cast<size_t>(nTotalIds));
+        sContext.anPolyValue.resize(static_cast<size_t>(nTotalIds));
+        GInt32 nOffset = 0;
+        for (auto &sBand : asBands)
+        {
+            for (size_t i = 0; i < sBand.anIdMap.size(); ++i)
+            {
+                const GInt32 nId = GSieveFindRootId(anParent, sBand.anIdMap[i]);
+                sBand.anIdMap[i] = nId;
+                anParent[nOffset + i] = nId;
+                const GIntBig nSize =
+                    static_cast<GIntBig>(sContext.anPolySizes[nId]) +
+                    sBand.anPolySizes[i];
+                sContext.anPolySizes[nId] =
+                    static_cast<int>(std::min<GIntBig>(nSize, MY_MAX_INT));
+                sContext.anPolyValue[nId] = sBand.anPolyValue[i];
+            }
+            nOffset += static_cast<GInt32>(sBand.anIdMap.size());
+            sBand.anPolySizes.clear();
+            sBand.anPolySizes.shrink_to_fit();
+            sBand.anPolyValue.clear();
+            sBand.anPolyValue.shrink_to_fit();
+        }
+        for (int iBand = 1; iBand < nBandCount; ++iBand)
+        {
+            const auto &sAbove = asBands[iBand - 1];
+            auto &anPrevLineId = asBands[iBand].anPrevLineId;
+            anPrevLineId.resize(nXSize);
+            for (int iX = 0; iX < nXSize; ++iX)
+            {
+                const GInt32 nId = sAbove.anLastLineId[iX];
+                anPrevLineId[iX] = nId < 0 ? -1 : sAbove.anIdMap[nId];
+            }
+        }
+        for (auto &sBand : asBands)
+        {
+            sBand.anFirstLineVal.clear();
+            sBand.anFirstLineId.clear();
+            sBand.anLastLineVal.clear();
+            sBand.anLastLineId.clear();
+        }
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALSieveFilter()");
+        return CE_Failure;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Second pass: identify the largest neighbour of each polygon.    */
+    /* -------------------------------------------------------------------- */
+    if (!GSieveRunBands(poThreadPool, asBands, GSieveNeighbourBandFunc, 0.25,
+                        0.5, pfnProgress, pProgressArg))
+        return CE_Failure;
+
+    const auto &anParent = sContext.anParent;
+    const auto &anPolySizes = sContext.anPolySizes;
+    auto &anBigNeighbour = sContext.anBigNeighbour;
+    try
+    {
+        anBigNeighbour.resize(anPolySizes.size(), -1);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALSieveFilter()");
+        return CE_Failure;
+    }
+    for (auto &sBand : asBands)
+    {
+        for (size_t i = 0; i < sBand.anSlotId.size(); ++i)
+        {
+            if (sBand.anSlotBigNeighbour[i] < 0)
+                continue;
+            const GInt32 nId = sBand.anSlotId[i];
+            const GInt32 nNeighbour =
+                sBand.anSlotId[sBand.anSlotBigNeighbour[i]];
+            if (anBigNeighbour[nId] == -1 ||
+                anPolySizes[anBigNeighbour[nId]] < anPolySizes[nNeighbour])
+                anBigNeighbour[nId] = nNeighbour;
+        }
+        sBand.anSlotId.clear();
+        sBand.anSlotId.shrink_to_fit();
+        sBand.anSlotBigNeighbour.clear();
+        sBand.anSlotBigNeighbour.shrink_to_fit();
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Resolve the merge targets, as in the single-threaded mode.      */
+    /* -------------------------------------------------------------------- */
+    int nFailedMerges = 0;
+    int nIsolatedSmall = 0;
+    int nSieveTargets = 0;
+
+    for (int iPoly = 0; iPoly < static_cast<int>(anPolySizes.size()); iPoly++)
+    {
+        if (anParent[iPoly] != iPoly)
+            continue;
+
+        if (sContext.anPolyValue[iPoly] == GP_NODATA_MARKER)
+            continue;
+
+        if (anPolySizes[iPoly] >= nSizeThreshold)
+        {
+            anBigNeighbour[iPoly] = -1;
+            continue;
+        }
+
+        nSieveTargets++;
+
+        if (anBigNeighbour[iPoly] == -1)
+        {
+            nIsolatedSmall++;
+            continue;
+        }
+
+        std::set<int> oSetVisitedPoly;
+        oSetVisitedPoly.insert(iPoly);
+
+        int iFinalId = iPoly;
+        bool bFoundBigEnoughPoly = false;
+        while (true)
+        {
+            iFinalId = anBigNeighbour[iFinalId];
+            if (iFinalId < 0)
+                break;
+            if (anPolySizes[iFinalId] >= nSizeThreshold)
+            {
+                bFoundBigEnoughPoly = true;
+                break;
+            }
+            if (oSetVisitedPoly.find(iFinalId) != oSetVisitedPoly.end())
+                break;
+            oSetVisitedPoly.insert(iFinalId);
+        }
+
+        if (!bFoundBigEnoughPoly)
+        {
+            nFailedMerges++;
+            anBigNeighbour[iPoly] = -1;
+            continue;
+        }
+
+        int iPolyCur = iPoly;
+        while (anBigNeighbour[iPolyCur] != iFinalId)
+        {
+            int iNextPoly = anBigNeighbour[iPolyCur];
+            anBigNeighbour[iPolyCur] = iFinalId;
+            iPolyCur = iNextPoly;
+        }
+    }
+
+    CPLDebug("GDALSieveFilter",
+             "Small Polygons: %d, Isolated: %d, Unmergable: %d (%d bands)",
+             nSieveTargets, nIsolatedSmall, nFailedMerges, nBandCount);
+
+    /* -------------------------------------------------------------------- */
+    /*      Third pass: apply the merges.                                   */
+    /* -------------------------------------------------------------------- */
+    if (!GSieveRunBands(poThreadPool, asBands, GSieveApplyBandFunc, 0.5, 1.0,
+                        pfnProgress, pProgressArg))
+        return CE_Failure;
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                          GDALSieveFilter()                           */
 /************************************************************************/
@@ -183,8 +870,14 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
  * @param nConnectedness either 4 indicating that diagonal pixels are not
  * considered directly adjacent for polygon membership purposes or 8
  * indicating they are.
- * @param papszOptions algorithm options in name=value list form.  None
- * currently supported.
+ * @param papszOptions algorithm options in name=value list form.
+ * <ul>
+ * <li>NUM_THREADS=number_of_threads or ALL_CPUS: (GDAL >= 3.9) Number of
+ * worker threads used to process bands of rows in parallel. Polygons
+ * crossing the seams between bands are merged, so the result is identical
+ * to the single-threaded mode. Defaults to the value of the
+ * GDAL_NUM_THREADS configuration option, or 1.</li>
+ * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
  * @param pProgressArg callback argument passed to pfnProgress.
@@ -195,8 +888,7 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
 CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
                                    GDALRasterBandH hMaskBand,
                                    GDALRasterBandH hDstBand, int nSizeThreshold,
-                                   int nConnectedness,
-                                   CPL_UNUSED char **papszOptions,
+                                   int nConnectedness, char **papszOptions,
                                    GDALProgressFunc pfnProgress,
                                    void *pProgressArg)
 {
@@ -206,11 +898,39 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
     if (pfnProgress == nullptr)
         pfnProgress = GDALDummyProgress;
 
+    int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    int nYSize = GDALGetRasterBandYSize(hSrcBand);
+
+    /* -------------------------------------------------------------------- */
+    /*      Process bands of rows in parallel if several threads are        */
+    /*      requested.                                                      */
+    /* -------------------------------------------------------------------- */
+    const char *pszNumThreads =
+        CSLFetchNameValueDef(papszOptions, "NUM_THREADS",
+                             CPLGetConfigOption("GDAL_NUM_THREADS", nullptr));
+    int nThreads = 1;
+    if (pszNumThreads)
+    {
+        nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+        nThreads = std::max(1, std::min(nThreads, 128));
+    }
+    constexpr int MIN_ROWS_PER_BAND = 256;
+    const int nBandCount = std::min(nThreads * 4, nYSize / MIN_ROWS_PER_BAND);
+    if (nThreads > 1 && nBandCount > 1)
+    {
+        CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+        if (poThreadPool)
+        {
+            return GDALSieveFilterMultiThreaded(
+                hSrcBand, hMaskBand, hDstBand, nSizeThreshold, nConnectedness,
+                poThreadPool, nBandCount, pfnProgress, pProgressArg);
+        }
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Allocate working buffers.                                       */
     /* -------------------------------------------------------------------- */
-    int nXSize = GDALGetRasterBandXSize(hSrcBand);
-    int nYSize = GDALGetRasterBandYSize(hSrcBand);
     auto *panLastLineVal = static_cast<std::int64_t *>(
         VSI_MALLOC2_VERBOSE(sizeof(std::int64_t), nXSize));
     auto *panThisLineVal = static_cast<std::int64_t *>(
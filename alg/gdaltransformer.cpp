@@ -57,6 +57,11 @@
 #include "ogr_spatialref.h"
 #include "ogr_srs_api.h"
 
+#if defined(__x86_64) || defined(_M_X64)
+#define USE_SSE2_OPTIM
+#include "gdalsse_priv.h"
+#endif
+
 CPL_C_START
 void *GDALDeserializeGCPTransformer(CPLXMLNode *psTree);
 void *GDALDeserializeTPSTransformer(CPLXMLNode *psTree);
@@ -1824,6 +1829,12 @@ static void GDALGCPAntimeridianUnwrap(int nGCPCount, GDAL_GCP *pasGCPList,
  * the backmap. The default is NO, that is to use in-memory arrays, unless the
  * number of pixels of the geolocation array is greater than 16 megapixels.
  * </li>
+ * <li> NUM_THREADS=number_of_threads|ALL_CPUS. (GDAL &gt;= 3.9) Number of
+ * threads used to build the backmap of geolocation array transformers, when
+ * it is stored in memory. Defaults to the value of the GDAL_NUM_THREADS
+ * configuration option, or 1. The result does not depend on the number of
+ * threads.
+ * </li>
  * <li>
  * GEOLOC_ARRAY/SRC_GEOLOC_ARRAY=filename. (GDAL &gt;= 3.5.2) Name of a GDAL
  * dataset containing a geolocation array and associated metadata. This is an
@@ -2780,6 +2791,71 @@ void GDALDestroyGenImgProjTransformer(void *hTransformArg)
     CPLFree(psInfo);
 }
 
+/************************************************************************/
+/*                    GDALApplyGeoTransformBatch()                      */
+/************************************************************************/
+
+/* Apply padfGeoTransform to the points for which panSuccess is set. */
+/* The SSE2 path processes two points at once and evaluates the terms */
+/* in the same order as the scalar path, so results are identical. */
+
+static void GDALApplyGeoTransformBatch(const double *padfGeoTransform,
+                                       int nPointCount, double *padfX,
+                                       double *padfY, const int *panSuccess)
+{
+    int i = 0;
+#ifdef USE_SSE2_OPTIM
+    const auto gt0 = XMMReg2Double::Load1ValHighAndLow(padfGeoTransform + 0);
+    const auto gt1 = XMMReg2Double::Load1ValHighAndLow(padfGeoTransform + 1);
+    const auto gt2 = XMMReg2Double::Load1ValHighAndLow(padfGeoTransform + 2);
+    const auto gt3 = XMMReg2Double::Load1ValHighAndLow(padfGeoTransform + 3);
+    const auto gt4 = XMMReg2Double::Load1ValHighAndLow(padfGeoTransform + 4);
+    const auto gt5 = XMMReg2Double::Load1ValHighAndLow(padfGeoTransform + 5);
+    for (; i + 1 < nPointCount; i += 2)
+    {
+        if (!panSuccess[i] || !panSuccess[i + 1])
+        {
+            // Leave failed points untouched, as the scalar path does.
+            for (int j = i; j < i + 2; ++j)
+            {
+                if (!panSuccess[j])
+                    continue;
+                const double dfNewX = padfGeoTransform[0] +
+                                      padfX[j] * padfGeoTransform[1] +
+                                      padfY[j] * padfGeoTransform[2];
+                const double dfNewY = padfGeoTransform[3] +
+                                      padfX[j] * padfGeoTransform[4] +
+                                      padfY[j] * padfGeoTransform[5];
+                padfX[j] = dfNewX;
+                padfY[j] = dfNewY;
+            }
+            continue;
+        }
+        const auto x = XMMReg2Double::Load2Val(padfX + i);
+        const auto y = XMMReg2Double::Load2Val(padfY + i);
+        const auto newX = gt0 + x * gt1 + y * gt2;
+        const auto newY = gt3 + x * gt4 + y * gt5;
+        newX.Store2Val(padfX + i);
+        newY.Store2Val(padfY + i);
+    }
+#endif
+    for (; i < nPointCount; i++)
+    {
+        if (!panSuccess[i])
+            continue;
+
+        const double dfNewX = padfGeoTransform[0] +
+                              padfX[i] * padfGeoTransform[1] +
+                              padfY[i] * padfGeoTransform[2];
+        const double dfNewY = padfGeoTransform[3] +
+                              padfX[i] * padfGeoTransform[4] +
+                              padfY[i] * padfGeoTransform[5];
+
+        padfX[i] = dfNewX;
+        padfY[i] = dfNewY;
+    }
+}
+
 /************************************************************************/
 /*                      GDALGenImgProjTransform()                       */
 /************************************************************************/
@@ -2842,21 +2918,8 @@ int GDALGenImgProjTransform(void *pTransformArgIn, int bDstToSrc,
     }
     else
     {
-        for (int i = 0; i < nPointCount; i++)
-        {
-            if (!panSuccess[i])
-                continue;
-
-            const double dfNewX = padfGeoTransform[0] +
-                                  padfX[i] * padfGeoTransform[1] +
-                                  padfY[i] * padfGeoTransform[2];
-            const double dfNewY = padfGeoTransform[3] +
-                                  padfX[i] * padfGeoTransform[4] +
-                                  padfY[i] * padfGeoTransform[5];
-
-            padfX[i] = dfNewX;
-            padfY[i] = dfNewY;
-        }
+        GDALApplyGeoTransformBatch(padfGeoTransform, nPointCount, padfX, padfY,
+                                   panSuccess);
     }
 
     /* -------------------------------------------------------------------- */
@@ -2893,21 +2956,8 @@ int GDALGenImgProjTransform(void *pTransformArgIn, int bDstToSrc,
     }
     else
     {
-        for (int i = 0; i < nPointCount; i++)
-        {
-            if (!panSuccess[i])
-                continue;
-
-            const double dfNewX = padfGeoTransform[0] +
-                                  padfX[i] * padfGeoTransform[1] +
-                                  padfY[i] * padfGeoTransform[2];
-            const double dfNewY = padfGeoTransform[3] +
-                                  padfX[i] * padfGeoTransform[4] +
-                                  padfY[i] * padfGeoTransform[5];
-
-            padfX[i] = dfNewX;
-            padfY[i] = dfNewY;
-        }
+        GDALApplyGeoTransformBatch(padfGeoTransform, nPointCount, padfX, padfY,
+                                   panSuccess);
     }
 
     return TRUE;
@@ -4097,7 +4147,31 @@ static int GDALApproxTransformInternal(void *pCBData, int bDstToSrc,
     /*      NOTE: the above comment is not true: gdalwarp uses approximator */
     /*      also to compute the source pixel of each target pixel.          */
     /* -------------------------------------------------------------------- */
-    for (int i = nPoints - 1; i >= 0; i--)
+    const double dfX0 = x[0];
+    int i = 0;
+#ifndef check_error
+#ifdef USE_SSE2_OPTIM
+    {
+        const auto x0 = XMMReg2Double::Load1ValHighAndLow(&dfX0);
+        const auto xS = XMMReg2Double::Load1ValHighAndLow(&xSMETransformed[0]);
+        const auto yS = XMMReg2Double::Load1ValHighAndLow(&ySMETransformed[0]);
+        const auto zS = XMMReg2Double::Load1ValHighAndLow(&zSMETransformed[0]);
+        const auto dX = XMMReg2Double::Load1ValHighAndLow(&dfDeltaX);
+        const auto dY = XMMReg2Double::Load1ValHighAndLow(&dfDeltaY);
+        const auto dZ = XMMReg2Double::Load1ValHighAndLow(&dfDeltaZ);
+        for (; i + 1 < nPoints; i += 2)
+        {
+            const auto dist = XMMReg2Double::Load2Val(x + i) - x0;
+            (xS + dX * dist).Store2Val(x + i);
+            (yS + dY * dist).Store2Val(y + i);
+            (zS + dZ * dist).Store2Val(z + i);
+            panSuccess[i] = TRUE;
+            panSuccess[i + 1] = TRUE;
+        }
+    }
+#endif
+#endif
+    for (; i < nPoints; i++)
     {
 #ifdef check_error
         double xtemp = x[i];
@@ -4109,7 +4183,7 @@ static int GDALApproxTransformInternal(void *pCBData, int bDstToSrc,
         psATInfo->pfnBaseTransformer(psATInfo->pBaseCBData, bDstToSrc, 1,
                                      &xtemp, &ytemp, &ztemp, &btemp);
 #endif
-        const double dfDist = (x[i] - x[0]);
+        const double dfDist = (x[i] - dfX0);
         x[i] = xSMETransformed[0] + dfDeltaX * dfDist;
         y[i] = ySMETransformed[0] + dfDeltaY * dfDist;
         z[i] = zSMETransformed[0] + dfDeltaZ * dfDist;
@@ -4529,6 +4603,11 @@ CPLErr GDALDeserializeTransformer(CPLXMLNode *psTree,
         *ppfnFunc = GDALApproxTransform;
         *ppTransformArg = GDALDeserializeApproxTransformer(psTree);
     }
+    else if (EQUAL(psTree->pszValue, "TransformGridTransformer"))
+    {
+        *ppfnFunc = GDALTransformGridTransform;
+        *ppTransformArg = GDALDeserializeTransformGridTransformer(psTree);
+    }
     else
     {
         GDALTransformDeserializeFunc pfnDeserializeFunc = nullptr;
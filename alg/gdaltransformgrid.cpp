@@ -0,0 +1,715 @@
+/******************************************************************************
+ *
+ * Project:  High Performance Image Reprojector
+ * Purpose:  Transformer interpolating in a precomputed grid of source
+ *           coordinates over the destination raster.
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "gdal_alg.h"
+#include "gdal_alg_priv.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "cpl_conv.h"
+#include "cpl_error.h"
+#include "cpl_minixml.h"
+#include "cpl_string.h"
+
+/************************************************************************/
+/*                          GDALTransformGrid                           */
+/************************************************************************/
+
+// Source coordinates of the nodes of a regular grid over the destination
+// raster, with nodes every nStep pixels (and on the right and bottom edges).
+// Cells whose center cannot be interpolated within dfMaxError, or that have
+// a node that failed to transform, are flagged to use the base transformer.
+
+struct GDALTransformGrid
+{
+    int nDstXSize = 0;
+    int nDstYSize = 0;
+    int nStep = 0;
+    int nNodesX = 0;
+    int nNodesY = 0;
+    double dfMaxError = 0;
+    std::vector<double> adfSrcX{};
+    std::vector<double> adfSrcY{};
+    std::vector<double> adfSrcZ{};
+    std::vector<GByte> abyCellExact{};
+
+    size_t NodeCount() const
+    {
+        return static_cast<size_t>(nNodesX) * nNodesY;
+    }
+
+    size_t CellCount() const
+    {
+        return static_cast<size_t>(nNodesX - 1) * (nNodesY - 1);
+    }
+
+    double NodeX(int i) const
+    {
+        return std::min(static_cast<double>(i) * nStep,
+                        static_cast<double>(nDstXSize));
+    }
+
+    double NodeY(int j) const
+    {
+        return std::min(static_cast<double>(j) * nStep,
+                        static_cast<double>(nDstYSize));
+    }
+};
+
+// Maximum number of nodes of a grid. The step is increased beyond that.
+constexpr size_t MAX_GRID_NODES = 1024 * 1024;
+
+/************************************************************************/
+/*                       GDALBuildTransformGrid()                       */
+/************************************************************************/
+
+/**
+ * Build the transform grid of a transformer over a destination raster.
+ *
+ * pfnBaseTransformer is evaluated (destination to source) at the nodes of a
+ * grid with a spacing of nStep destination pixels, and at the center of each
+ * cell to check that bilinear interpolation is within dfMaxError source
+ * pixels.
+ *
+ * @return the grid, or nullptr in case of error.
+ */
+
+std::shared_ptr<const GDALTransformGrid>
+GDALBuildTransformGrid(GDALTransformerFunc pfnBaseTransformer,
+                       void *pBaseTransformArg, int nDstXSize, int nDstYSize,
+                       int nStep, double dfMaxError)
+{
+    if (nDstXSize <= 0 || nDstYSize <= 0 || nStep <= 0)
+        return nullptr;
+
+    auto poGrid = std::make_shared<GDALTransformGrid>();
+    poGrid->nDstXSize = nDstXSize;
+    poGrid->nDstYSize = nDstYSize;
+    poGrid->dfMaxError = dfMaxError;
+
+    // Increase the step if the grid would be too large.
+    const double dfMinStep =
+        std::sqrt(static_cast<double>(nDstXSize) * nDstYSize / MAX_GRID_NODES);
+    poGrid->nStep = std::max(nStep, static_cast<int>(std::ceil(dfMinStep)));
+    poGrid->nNodesX = (nDstXSize + poGrid->nStep - 1) / poGrid->nStep + 1;
+    poGrid->nNodesY = (nDstYSize + poGrid->nStep - 1) / poGrid->nStep + 1;
+
+    const int nNodesX = poGrid->nNodesX;
+    const int nNodesY = poGrid->nNodesY;
+    try
+    {
+        poGrid->adfSrcX.resize(poGrid->NodeCount());
+        poGrid->adfSrcY.resize(poGrid->NodeCount());
+        poGrid->adfSrcZ.resize(poGrid->NodeCount());
+        poGrid->abyCellExact.resize(poGrid->CellCount());
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate transform grid");
+        return nullptr;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Transform the nodes, one row at a time.                         */
+    /* -------------------------------------------------------------------- */
+    std::vector<int> abNodeSuccess(poGrid->NodeCount());
+    for (int j = 0; j < nNodesY; ++j)
+    {
+        const size_t nOffset = static_cast<size_t>(j) * nNodesX;
+        double *padfX = poGrid->adfSrcX.data() + nOffset;
+        double *padfY = poGrid->adfSrcY.data() + nOffset;
+        double *padfZ = poGrid->adfSrcZ.data() + nOffset;
+        for (int i = 0; i < nNodesX; ++i)
+        {
+            padfX[i] = poGrid->NodeX(i);
+            padfY[i] = poGrid->NodeY(j);
+            padfZ[i] = 0;
+        }
+        if (!pfnBaseTransformer(pBaseTransformArg, TRUE, nNodesX, padfX,
+                                padfY, padfZ, abNodeSuccess.data() + nOffset))
+        {
+            std::fill_n(abNodeSuccess.data() + nOffset, nNodesX, FALSE);
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Check the interpolation error at the center of the cells.       */
+    /* -------------------------------------------------------------------- */
+    const int nCellsX = nNodesX - 1;
+    std::vector<double> adfX(nCellsX);
+    std::vector<double> adfY(nCellsX);
+    std::vector<double> adfZ(nCellsX);
+    std::vector<int> abSuccess(nCellsX);
+    size_t nExactCells = 0;
+    for (int j = 0; j < nNodesY - 1; ++j)
+    {
+        const double dfCenterY = (poGrid->NodeY(j) + poGrid->NodeY(j + 1)) / 2;
+        for (int i = 0; i < nCellsX; ++i)
+        {
+            adfX[i] = (poGrid->NodeX(i) + poGrid->NodeX(i + 1)) / 2;
+            adfY[i] = dfCenterY;
+            adfZ[i] = 0;
+        }
+        if (!pfnBaseTransformer(pBaseTransformArg, TRUE, nCellsX, adfX.data(),
+                                adfY.data(), adfZ.data(), abSuccess.data()))
+        {
+            std::fill(abSuccess.begin(), abSuccess.end(), FALSE);
+        }
+
+        for (int i = 0; i < nCellsX; ++i)
+        {
+            const size_t i00 = static_cast<size_t>(j) * nNodesX + i;
+            const size_t i10 = i00 + 1;
+            const size_t i01 = i00 + nNodesX;
+            const size_t i11 = i01 + 1;
+            bool bExact = !abSuccess[i] || !abNodeSuccess[i00] ||
+                          !abNodeSuccess[i10] || !abNodeSuccess[i01] ||
+                          !abNodeSuccess[i11];
+            if (!bExact)
+            {
+                const auto Center = [](const std::vector<double> &adf,
+                                       size_t a, size_t b, size_t c, size_t d)
+                { return (adf[a] + adf[b] + adf[c] + adf[d]) / 4; };
+                const double dfErr = std::max(
+                    {std::fabs(Center(poGrid->adfSrcX, i00, i10, i01, i11) -
+                               adfX[i]),
+                     std::fabs(Center(poGrid->adfSrcY, i00, i10, i01, i11) -
+                               adfY[i]),
+                     std::fabs(Center(poGrid->adfSrcZ, i00, i10, i01, i11) -
+                               adfZ[i])});
+                // Also catches NaN
+                bExact = !(dfErr <= dfMaxError);
+            }
+            if (bExact)
+            {
+                poGrid->abyCellExact[static_cast<size_t>(j) * nCellsX + i] = 1;
+                ++nExactCells;
+            }
+        }
+    }
+
+    CPLDebug("WARP",
+             "Transform grid of %dx%d nodes (step %d) built for a %dx%d "
+             "raster: %d%% of cells use the exact transformer",
+             nNodesX, nNodesY, poGrid->nStep, nDstXSize, nDstYSize,
+             static_cast<int>(100.0 * nExactCells / poGrid->CellCount()));
+
+    return poGrid;
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*      Transform grid transformer.                                     */
+/* ==================================================================== */
+/************************************************************************/
+
+struct TransformGridInfo
+{
+    GDALTransformerInfo sTI{};
+
+    GDALTransformerFunc pfnBaseTransformer = nullptr;
+    void *pBaseCBData = nullptr;
+    bool bOwnSubtransformer = false;
+
+    std::shared_ptr<const GDALTransformGrid> poGrid{};
+
+    // Set by GDALCreateSimilarTransformer(): source pixel coordinates of the
+    // grid must be divided by those ratios.
+    double dfSrcRatioX = 1.0;
+    double dfSrcRatioY = 1.0;
+};
+
+static CPLXMLNode *GDALSerializeTransformGridTransformer(void *pTransformArg);
+static void *GDALCreateSimilarTransformGridTransformer(void *hTransformArg,
+                                                       double dfSrcRatioX,
+                                                       double dfSrcRatioY);
+
+/************************************************************************/
+/*                GDALCreateTransformGridTransformerFromGrid()          */
+/************************************************************************/
+
+void *GDALCreateTransformGridTransformerFromGrid(
+    GDALTransformerFunc pfnBaseTransformer, void *pBaseTransformArg,
+    const std::shared_ptr<const GDALTransformGrid> &poGrid)
+{
+    TransformGridInfo *psInfo = new TransformGridInfo();
+    psInfo->pfnBaseTransformer = pfnBaseTransformer;
+    psInfo->pBaseCBData = pBaseTransformArg;
+    psInfo->bOwnSubtransformer = false;
+    psInfo->poGrid = poGrid;
+    psInfo->dfSrcRatioX = 1.0;
+    psInfo->dfSrcRatioY = 1.0;
+
+    memcpy(psInfo->sTI.abySignature, GDAL_GTI2_SIGNATURE,
+           strlen(GDAL_GTI2_SIGNATURE));
+    psInfo->sTI.pszClassName = "GDALTransformGridTransformer";
+    psInfo->sTI.pfnTransform = GDALTransformGridTransform;
+    psInfo->sTI.pfnCleanup = GDALDestroyTransformGridTransformer;
+    psInfo->sTI.pfnSerialize = GDALSerializeTransformGridTransformer;
+    psInfo->sTI.pfnCreateSimilar = GDALCreateSimilarTransformGridTransformer;
+
+    return psInfo;
+}
+
+/************************************************************************/
+/*                 GDALCreateTransformGridTransformer()                 */
+/************************************************************************/
+
+/**
+ * Create a transformer interpolating in a grid of precomputed coordinates.
+ *
+ * The destination to source transformation of pfnBaseTransformer is
+ * evaluated once at the nodes of a grid spanning the nDstXSize x nDstYSize
+ * destination raster, with a node every nStep pixels. Subsequent destination
+ * to source transformations of points within the raster are bilinearly
+ * interpolated in that grid, except in cells where the interpolation error
+ * measured at the cell center exceeds dfMaxError source pixels, where
+ * pfnBaseTransformer is used. Source to destination transformations are
+ * always done by pfnBaseTransformer.
+ *
+ * This is suitable for warping repeatedly to the same destination grid, as
+ * the cost of evaluating the base transformer is paid once.
+ *
+ * @param pfnBaseTransformer the transformer to approximate.
+ * @param pBaseTransformArg the callback argument for the base transformer.
+ * @param nDstXSize width of the destination raster.
+ * @param nDstYSize height of the destination raster.
+ * @param nStep spacing, in destination pixels, of the grid nodes.
+ * @param dfMaxError maximum interpolation error, in source pixels.
+ *
+ * @return callback pointer suitable for use with GDALTransformGridTransform(),
+ * or NULL in case of error. It should be deallocated with
+ * GDALDestroyTransformGridTransformer().
+ *
+ * @since GDAL 3.9
+ */
+
+void *GDALCreateTransformGridTransformer(GDALTransformerFunc pfnBaseTransformer,
+                                         void *pBaseTransformArg,
+                                         int nDstXSize, int nDstYSize,
+                                         int nStep, double dfMaxError)
+{
+    VALIDATE_POINTER1(pfnBaseTransformer, "GDALCreateTransformGridTransformer",
+                      nullptr);
+
+    auto poGrid =
+        GDALBuildTransformGrid(pfnBaseTransformer, pBaseTransformArg,
+                               nDstXSize, nDstYSize, nStep, dfMaxError);
+    if (poGrid == nullptr)
+        return nullptr;
+    return GDALCreateTransformGridTransformerFromGrid(
+        pfnBaseTransformer, pBaseTransformArg, poGrid);
+}
+
+/************************************************************************/
+/*            GDALTransformGridTransformerOwnsSubtransformer()          */
+/************************************************************************/
+
+/** Set whether the base transformer is destroyed with the transform grid
+ * transformer.
+ *
+ * @since GDAL 3.9
+ */
+void GDALTransformGridTransformerOwnsSubtransformer(void *pCBData,
+                                                    int bOwnFlag)
+{
+    static_cast<TransformGridInfo *>(pCBData)->bOwnSubtransformer =
+        CPL_TO_BOOL(bOwnFlag);
+}
+
+/************************************************************************/
+/*                 GDALDestroyTransformGridTransformer()                */
+/************************************************************************/
+
+/**
+ * Cleanup transform grid transformer.
+ *
+ * @since GDAL 3.9
+ */
+
+void GDALDestroyTransformGridTransformer(void *pCBData)
+{
+    if (pCBData == nullptr)
+        return;
+
+    TransformGridInfo *psInfo = static_cast<TransformGridInfo *>(pCBData);
+    if (psInfo->bOwnSubtransformer)
+        GDALDestroyTransformer(psInfo->pBaseCBData);
+
+    delete psInfo;
+}
+
+/************************************************************************/
+/*                 GDALGetTransformGridBaseTransformer()                */
+/************************************************************************/
+
+void *GDALGetTransformGridBaseTransformer(void *pTransformArg,
+                                          GDALTransformerFunc *ppfnBase)
+{
+    TransformGridInfo *psInfo = static_cast<TransformGridInfo *>(pTransformArg);
+    *ppfnBase = psInfo->pfnBaseTransformer;
+    return psInfo->pBaseCBData;
+}
+
+/************************************************************************/
+/*              GDALCreateSimilarTransformGridTransformer()             */
+/************************************************************************/
+
+static void *GDALCreateSimilarTransformGridTransformer(void *hTransformArg,
+                                                       double dfSrcRatioX,
+                                                       double dfSrcRatioY)
+{
+    VALIDATE_POINTER1(hTransformArg,
+                      "GDALCreateSimilarTransformGridTransformer", nullptr);
+
+    TransformGridInfo *psInfo = static_cast<TransformGridInfo *>(hTransformArg);
+
+    void *pBaseCBData = GDALCreateSimilarTransformer(
+        psInfo->pBaseCBData, dfSrcRatioX, dfSrcRatioY);
+    if (pBaseCBData == nullptr)
+        return nullptr;
+
+    // The grid itself is shared.
+    TransformGridInfo *psClonedInfo = static_cast<TransformGridInfo *>(
+        GDALCreateTransformGridTransformerFromGrid(
+            psInfo->pfnBaseTransformer, pBaseCBData, psInfo->poGrid));
+    psClonedInfo->bOwnSubtransformer = true;
+    psClonedInfo->dfSrcRatioX = psInfo->dfSrcRatioX * dfSrcRatioX;
+    psClonedInfo->dfSrcRatioY = psInfo->dfSrcRatioY * dfSrcRatioY;
+
+    return psClonedInfo;
+}
+
+/************************************************************************/
+/*                     GDALTransformGridTransform()                     */
+/************************************************************************/
+
+/**
+ * Perform transform grid transformation.
+ *
+ * @see GDALCreateTransformGridTransformer()
+ *
+ * @since GDAL 3.9
+ */
+
+int GDALTransformGridTransform(void *pCBData, int bDstToSrc, int nPoints,
+                               double *x, double *y, double *z,
+                               int *panSuccess)
+{
+    TransformGridInfo *psInfo = static_cast<TransformGridInfo *>(pCBData);
+
+    if (!bDstToSrc)
+        return psInfo->pfnBaseTransformer(psInfo->pBaseCBData, bDstToSrc,
+                                          nPoints, x, y, z, panSuccess);
+
+    const GDALTransformGrid &oGrid = *(psInfo->poGrid);
+    const int nNodesX = oGrid.nNodesX;
+    const int nCellsX = nNodesX - 1;
+    const double dfInvStep = 1.0 / oGrid.nStep;
+    const double dfDstXSize = oGrid.nDstXSize;
+    const double dfDstYSize = oGrid.nDstYSize;
+
+    // Indices of the points that must go through the base transformer.
+    std::vector<int> anExact;
+
+    for (int i = 0; i < nPoints; ++i)
+    {
+        const double dfX = x[i];
+        const double dfY = y[i];
+        if (!(dfX >= 0 && dfX <= dfDstXSize && dfY >= 0 &&
+              dfY <= dfDstYSize) ||
+            (z && z[i] != 0))
+        {
+            anExact.push_back(i);
+            continue;
+        }
+
+        const int iX = std::min(static_cast<int>(dfX * dfInvStep), nCellsX - 1);
+        const int iY =
+            std::min(static_cast<int>(dfY * dfInvStep), oGrid.nNodesY - 2);
+        if (oGrid.abyCellExact[static_cast<size_t>(iY) * nCellsX + iX])
+        {
+            anExact.push_back(i);
+            continue;
+        }
+
+        const double dfX0 = oGrid.NodeX(iX);
+        const double dfY0 = oGrid.NodeY(iY);
+        const double dfTX = (dfX - dfX0) / (oGrid.NodeX(iX + 1) - dfX0);
+        const double dfTY = (dfY - dfY0) / (oGrid.NodeY(iY + 1) - dfY0);
+        const double dfW00 = (1 - dfTX) * (1 - dfTY);
+        const double dfW10 = dfTX * (1 - dfTY);
+        const double dfW01 = (1 - dfTX) * dfTY;
+        const double dfW11 = dfTX * dfTY;
+
+        const size_t i00 = static_cast<size_t>(iY) * nNodesX + iX;
+        const size_t i10 = i00 + 1;
+        const size_t i01 = i00 + nNodesX;
+        const size_t i11 = i01 + 1;
+        const auto Interpolate = [=](const std::vector<double> &adf)
+        {
+            return dfW00 * adf[i00] + dfW10 * adf[i10] + dfW01 * adf[i01] +
+                   dfW11 * adf[i11];
+        };
+
+        x[i] = Interpolate(oGrid.adfSrcX) / psInfo->dfSrcRatioX;
+        y[i] = Interpolate(oGrid.adfSrcY) / psInfo->dfSrcRatioY;
+        if (z)
+            z[i] = Interpolate(oGrid.adfSrcZ);
+        panSuccess[i] = TRUE;
+    }
+
+    if (anExact.empty())
+        return TRUE;
+
+    /* -------------------------------------------------------------------- */
+    /*      Transform the remaining points with the base transformer.       */
+    /* -------------------------------------------------------------------- */
+    const int nExact = static_cast<int>(anExact.size());
+    std::vector<double> adfX(nExact);
+    std::vector<double> adfY(nExact);
+    std::vector<double> adfZ(nExact);
+    std::vector<int> abSuccess(nExact);
+    for (int k = 0; k < nExact; ++k)
+    {
+        adfX[k] = x[anExact[k]];
+        adfY[k] = y[anExact[k]];
+        adfZ[k] = z ? z[anExact[k]] : 0;
+    }
+
+    const int bRet = psInfo->pfnBaseTransformer(
+        psInfo->pBaseCBData, TRUE, nExact, adfX.data(), adfY.data(),
+        adfZ.data(), abSuccess.data());
+
+    for (int k = 0; k < nExact; ++k)
+    {
+        x[anExact[k]] = adfX[k];
+        y[anExact[k]] = adfY[k];
+        if (z)
+            z[anExact[k]] = adfZ[k];
+        panSuccess[anExact[k]] = bRet ? abSuccess[k] : FALSE;
+    }
+
+    return bRet || nExact < nPoints;
+}
+
+/************************************************************************/
+/*               GDALSerializeTransformGridTransformer()                */
+/************************************************************************/
+
+static CPLXMLNode *GDALSerializeTransformGridTransformer(void *pTransformArg)
+{
+    TransformGridInfo *psInfo = static_cast<TransformGridInfo *>(pTransformArg);
+    const GDALTransformGrid &oGrid = *(psInfo->poGrid);
+
+    CPLXMLNode *psTree =
+        CPLCreateXMLNode(nullptr, CXT_Element, "TransformGridTransformer");
+
+    CPLCreateXMLElementAndValue(psTree, "DstXSize",
+                                CPLSPrintf("%d", oGrid.nDstXSize));
+    CPLCreateXMLElementAndValue(psTree, "DstYSize",
+                                CPLSPrintf("%d", oGrid.nDstYSize));
+    CPLCreateXMLElementAndValue(psTree, "Step", CPLSPrintf("%d", oGrid.nStep));
+    CPLCreateXMLElementAndValue(psTree, "MaxError",
+                                CPLSPrintf("%.18g", oGrid.dfMaxError));
+    if (psInfo->dfSrcRatioX != 1.0 || psInfo->dfSrcRatioY != 1.0)
+    {
+        CPLCreateXMLElementAndValue(
+            psTree, "SrcRatioX", CPLSPrintf("%.18g", psInfo->dfSrcRatioX));
+        CPLCreateXMLElementAndValue(
+            psTree, "SrcRatioY", CPLSPrintf("%.18g", psInfo->dfSrcRatioY));
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Grid content: X, Y and Z of the nodes as little-endian          */
+    /*      doubles, followed by one byte per cell, base64 encoded.         */
+    /* -------------------------------------------------------------------- */
+    const size_t nNodes = oGrid.NodeCount();
+    std::vector<GByte> abyData(3 * nNodes * sizeof(double) +
+                               oGrid.CellCount());
+    GByte *pabyOut = abyData.data();
+    for (const auto *padf :
+         {&oGrid.adfSrcX, &oGrid.adfSrcY, &oGrid.adfSrcZ})
+    {
+        for (double dfVal : *padf)
+        {
+            CPL_LSBPTR64(&dfVal);
+            memcpy(pabyOut, &dfVal, sizeof(double));
+            pabyOut += sizeof(double);
+        }
+    }
+    if (!oGrid.abyCellExact.empty())
+        memcpy(pabyOut, oGrid.abyCellExact.data(), oGrid.CellCount());
+
+    char *pszBase64 =
+        CPLBase64Encode(static_cast<int>(abyData.size()), abyData.data());
+    CPLXMLNode *psGrid = CPLCreateXMLElementAndValue(psTree, "Grid", pszBase64);
+    CPLFree(pszBase64);
+    CPLAddXMLAttributeAndValue(psGrid, "nodesX",
+                               CPLSPrintf("%d", oGrid.nNodesX));
+    CPLAddXMLAttributeAndValue(psGrid, "nodesY",
+                               CPLSPrintf("%d", oGrid.nNodesY));
+
+    /* -------------------------------------------------------------------- */
+    /*      Capture underlying transformer.                                 */
+    /* -------------------------------------------------------------------- */
+    CPLXMLNode *psTransformerContainer =
+        CPLCreateXMLNode(psTree, CXT_Element, "BaseTransformer");
+
+    CPLXMLNode *psTransformer = GDALSerializeTransformer(
+        psInfo->pfnBaseTransformer, psInfo->pBaseCBData);
+    if (psTransformer != nullptr)
+        CPLAddXMLChild(psTransformerContainer, psTransformer);
+
+    return psTree;
+}
+
+/************************************************************************/
+/*              GDALDeserializeTransformGridTransformer()               */
+/************************************************************************/
+
+void *GDALDeserializeTransformGridTransformer(CPLXMLNode *psTree)
+{
+    GDALTransformerFunc pfnBaseTransform = nullptr;
+    void *pBaseCBData = nullptr;
+
+    CPLXMLNode *psContainer = CPLGetXMLNode(psTree, "BaseTransformer");
+
+    if (psContainer != nullptr && psContainer->psChild != nullptr)
+    {
+        GDALDeserializeTransformer(psContainer->psChild, &pfnBaseTransform,
+                                   &pBaseCBData);
+    }
+
+    if (pfnBaseTransform == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot get base transform for transform grid transformer.");
+        return nullptr;
+    }
+
+    const int nDstXSize = atoi(CPLGetXMLValue(psTree, "DstXSize", "0"));
+    const int nDstYSize = atoi(CPLGetXMLValue(psTree, "DstYSize", "0"));
+    const int nStep = atoi(CPLGetXMLValue(psTree, "Step", "0"));
+    const double dfMaxError = CPLAtof(CPLGetXMLValue(psTree, "MaxError", "0"));
+    const double dfSrcRatioX =
+        CPLAtof(CPLGetXMLValue(psTree, "SrcRatioX", "1"));
+    const double dfSrcRatioY =
+        CPLAtof(CPLGetXMLValue(psTree, "SrcRatioY", "1"));
+    if (nDstXSize <= 0 || nDstYSize <= 0 || nStep <= 0 || dfSrcRatioX <= 0 ||
+        dfSrcRatioY <= 0)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Invalid transform grid transformer definition.");
+        GDALDestroyTransformer(pBaseCBData);
+        return nullptr;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Load the serialized grid if it is consistent.                   */
+    /* -------------------------------------------------------------------- */
+    std::shared_ptr<GDALTransformGrid> poGrid;
+    const char *pszGrid = CPLGetXMLValue(psTree, "Grid", nullptr);
+    if (pszGrid != nullptr)
+    {
+        auto poLoadedGrid = std::make_shared<GDALTransformGrid>();
+        poLoadedGrid->nDstXSize = nDstXSize;
+        poLoadedGrid->nDstYSize = nDstYSize;
+        poLoadedGrid->nStep = nStep;
+        poLoadedGrid->dfMaxError = dfMaxError;
+        poLoadedGrid->nNodesX = (nDstXSize + nStep - 1) / nStep + 1;
+        poLoadedGrid->nNodesY = (nDstYSize + nStep - 1) / nStep + 1;
+        const size_t nNodes = poLoadedGrid->NodeCount();
+        const size_t nExpectedSize =
+            3 * nNodes * sizeof(double) + poLoadedGrid->CellCount();
+
+        std::string osData(pszGrid);
+        const int nSize = CPLBase64DecodeInPlace(
+            reinterpret_cast<GByte *>(&osData[0]));
+        if (atoi(CPLGetXMLValue(psTree, "Grid.nodesX", "0")) ==
+                poLoadedGrid->nNodesX &&
+            atoi(CPLGetXMLValue(psTree, "Grid.nodesY", "0")) ==
+                poLoadedGrid->nNodesY &&
+            static_cast<size_t>(nSize) == nExpectedSize)
+        {
+            const GByte *pabyIn =
+                reinterpret_cast<const GByte *>(osData.data());
+            for (auto *padf : {&poLoadedGrid->adfSrcX, &poLoadedGrid->adfSrcY,
+                               &poLoadedGrid->adfSrcZ})
+            {
+                padf->resize(nNodes);
+                for (double &dfVal : *padf)
+                {
+                    memcpy(&dfVal, pabyIn, sizeof(double));
+                    CPL_LSBPTR64(&dfVal);
+                    pabyIn += sizeof(double);
+                }
+            }
+            poLoadedGrid->abyCellExact.assign(
+                pabyIn, pabyIn + poLoadedGrid->CellCount());
+            poGrid = std::move(poLoadedGrid);
+        }
+        else
+        {
+            CPLDebug("WARP", "Inconsistent serialized transform grid. "
+                             "Computing it again");
+        }
+    }
+
+    void *pCBData = nullptr;
+    if (poGrid)
+    {
+        pCBData = GDALCreateTransformGridTransformerFromGrid(
+            pfnBaseTransform, pBaseCBData, poGrid);
+        TransformGridInfo *psInfo = static_cast<TransformGridInfo *>(pCBData);
+        psInfo->dfSrcRatioX = dfSrcRatioX;
+        psInfo->dfSrcRatioY = dfSrcRatioY;
+    }
+    else
+    {
+        // The base transformer already includes the source ratios, so a
+        // grid computed from it does not need them.
+        pCBData = GDALCreateTransformGridTransformer(
+            pfnBaseTransform, pBaseCBData, nDstXSize, nDstYSize, nStep,
+            dfMaxError);
+        if (pCBData == nullptr)
+        {
+            GDALDestroyTransformer(pBaseCBData);
+            return nullptr;
+        }
+    }
+
+    GDALTransformGridTransformerOwnsSubtransformer(pCBData, TRUE);
+    return pCBData;
+}
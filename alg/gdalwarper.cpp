@@ -1100,7 +1100,12 @@ CPLErr GDALWarpDstAlphaMasker(void *pMaskFuncArg, int nBandCount,
  * destination (INIT_DEST) and all other processing, and so should be used
  * carefully.  Mostly useful to short circuit a lot of extra work in mosaicing
  * situations. Starting with GDAL 2.4, gdalwarp will automatically enable this
- * option when it is assumed to be safe to do so.</li>
+ * option when it is assumed to be safe to do so. Starting with GDAL 3.9, this
+ * also applies to chunks whose source window has no data, like the missing
+ * tiles of a sparse GeoTIFF file or the areas of a VRT not covered by any
+ * source, when the source nodata value is the value of such areas or when the
+ * source alpha band is empty there. Independently of this option, such source
+ * windows are never read.</li>
  *
  * <li>UNIFIED_SRC_NODATA=YES/NO/PARTIAL: This setting determines
  * how to take into account nodata values when there are several input bands.
@@ -1177,6 +1182,43 @@ CPLErr GDALWarpDstAlphaMasker(void *pMaskFuncArg, int nBandCount,
  * set the number of threads to use to parallelize the computation part of the
  * warping. If not set, computation will be done in a single thread.</li>
  *
+ * <li>NUM_CHUNK_THREADS: (GDAL >= 3.9) Can be set to a numeric value or
+ * ALL_CPUS to set the number of threads used by
+ * GDALWarpOperation::ChunkAndWarpMulti() to process whole chunks
+ * concurrently. Reading and writing of chunks remain serialized, but several
+ * chunks can be warped while another one is being read or written. The
+ * memory limit is shared by all the chunks being processed. Chunks are
+ * written in order when the output is streamable, compressed, or created by a
+ * driver without Create() support. If not set, one thread does the
+ * input/output while another one does the warping.</li>
+ *
+ * <li>TRANSFORM_GRID: (GDAL >= 3.9) Defaults to FALSE. If set to TRUE, the
+ * transformer is evaluated once at the nodes of a regular grid over the
+ * destination raster, and the warp kernel bilinearly interpolates source
+ * coordinates from that grid. Cells where interpolation deviates from the
+ * transformer by more than TRANSFORM_GRID_MAX_ERROR pixels, or where the
+ * transformation fails, fall back to the exact transformer. Grids are cached
+ * by serialized transformer and destination size, so that repeated warps with
+ * the same geometry (e.g. tiles of a VRT) reuse them. The number of cached
+ * grids is controlled by the GDAL_WARP_TRANSFORM_GRID_CACHE_SIZE configuration
+ * option (default 64).</li>
+ *
+ * <li>TRANSFORM_GRID_STEP: (GDAL >= 3.9) Spacing in destination pixels
+ * between grid nodes when TRANSFORM_GRID is set. Defaults to 16.</li>
+ *
+ * <li>TRANSFORM_GRID_MAX_ERROR: (GDAL >= 3.9) Maximum error, in source
+ * pixels, tolerated at cell centers when TRANSFORM_GRID is set. Defaults to
+ * 0.125.</li>
+ *
+ * <li>USE_OPENCL: Defaults to the value of the GDAL_USE_OPENCL configuration
+ * option, itself defaulting to FALSE. If set to TRUE and GDAL has been built
+ * with OpenCL support, the nearest, bilinear, cubic, cubicspline and lanczos
+ * resampling methods on Byte, Int16, UInt16 and Float32 (and their complex
+ * variants) data are run on an OpenCL device, typically a GPU, taking into
+ * account source nodata and destination density. Starting with GDAL 3.9,
+ * the OpenCL context and the compiled kernels are shared by all the chunks
+ * and warp operations of the process.</li>
+ *
  * <li>STREAMABLE_OUTPUT: (GDAL >= 2.0) This defaults to FALSE, but may
  * be set to TRUE typically when writing to a streamed file. The
  * gdalwarp utility automatically sets this option when writing to
@@ -1249,6 +1291,42 @@ CPLErr GDALWarpDstAlphaMasker(void *pMaskFuncArg, int nBandCount,
  * an explicit source and target SRS.</li>
  * <li>MULT_FACTOR_VERTICAL_SHIFT: Multiplication factor for the vertical
  * shift. Default 1.0</li>
+ *
+ * <li>SCALE=src_min,src_max,dst_min,dst_max: (GDAL >= 3.9) Linearly rescale
+ * the source values of all bands from the [src_min,src_max] range to the
+ * [dst_min,dst_max] range, clamping the result to the latter, like
+ * gdal_translate -scale. SCALE_&lt;n&gt; sets it for the n-th (1-based) warped
+ * band only. This allows warping and converting to a narrower output data type
+ * in a single pass, without an intermediate dataset.</li>
+ *
+ * <li>LUT=src1:dst1,src2:dst2,...: (GDAL >= 3.9) Piecewise linear lookup
+ * table applied to the source values of all bands, after SCALE, with the same
+ * semantics as the LUT of VRT sources. LUT_&lt;n&gt; sets it for the n-th
+ * (1-based) warped band only.
+ * SCALE and LUT are applied to the source values once they have been checked
+ * against the source nodata value, before resampling. This is equivalent to
+ * applying them to the warped values for nearest neighbour, and for linear or
+ * order-based resampling methods (up to values of cubic or lanczos kernels
+ * overshooting the output range), but LUT with other methods than nearest
+ * neighbour interpolates the looked-up values.
+ * When set with an integer working data type and a resampling method other
+ * than nearest neighbour, the working data type is promoted to Float32. The
+ * conversion to the output data type is done when writing the destination,
+ * with rounding and clamping.</li>
+ *
+ * <li>PROFILING_REPORT=filename: (GDAL >= 3.9) Write a JSON profiling report
+ * of the warp operation to that file when the operation is destroyed. For
+ * each chunk, it gives the destination and source windows, and the time spent
+ * computing the source window (mostly transforming sample points), reading
+ * the destination and source buffers, building the validity and density
+ * masks, running the kernel and writing the destination buffer. The name of
+ * the kernel function, the number of threads it used and their utilization
+ * are also reported, as well as totals per kernel, the time spent building the
+ * chunk list, whether a transform grid was computed or taken from the cache,
+ * and the block cache hits and misses during the operation. The time of
+ * coordinate transformations done by the kernel itself is part of the kernel
+ * time. The first report written by a process to a file replaces it, and the
+ * following ones are appended to its "operations" array.</li>
  * </ul>
  */
 
@@ -1576,6 +1654,32 @@ void CPL_STDCALL GDALWarpResolveWorkingDataType(GDALWarpOptions *psOptions)
                 GDALDataTypeUnion(psOptions->eWorkingDataType, GDT_Float32);
         }
     }
+
+    // Values transformed by the SCALE and LUT warping options are generally
+    // not integers, and must not be rounded before being resampled.
+    if (GDALDataTypeIsInteger(psOptions->eWorkingDataType) &&
+        psOptions->eResampleAlg != GRA_NearestNeighbour)
+    {
+        bool bHasValueTransform =
+            CSLFetchNameValue(psOptions->papszWarpOptions, "SCALE") !=
+                nullptr ||
+            CSLFetchNameValue(psOptions->papszWarpOptions, "LUT") != nullptr;
+        for (int iBand = 0;
+             iBand < psOptions->nBandCount && !bHasValueTransform; iBand++)
+        {
+            bHasValueTransform =
+                CSLFetchNameValue(psOptions->papszWarpOptions,
+                                  CPLSPrintf("SCALE_%d", iBand + 1)) !=
+                    nullptr ||
+                CSLFetchNameValue(psOptions->papszWarpOptions,
+                                  CPLSPrintf("LUT_%d", iBand + 1)) != nullptr;
+        }
+        if (bHasValueTransform)
+        {
+            psOptions->eWorkingDataType =
+                GDALDataTypeUnion(psOptions->eWorkingDataType, GDT_Float32);
+        }
+    }
 }
 
 /************************************************************************/
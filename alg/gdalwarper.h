@@ -474,6 +474,9 @@ void *GWKThreadsCreate(char **papszWarpOptions,
                        GDALTransformerFunc pfnTransformer,
                        void *pTransformerArg);
 void GWKThreadsEnd(void *psThreadDataIn);
+bool GWKThreadsFetchLastRunInfo(void *psThreadDataIn,
+                                const char **ppszFuncName, int *pnThreads,
+                                double *pdfBusyTime);
 /*! @endcond */
 
 /************************************************************************/
@@ -488,6 +491,7 @@ void GWKThreadsEnd(void *psThreadDataIn);
 
 /*! @cond Doxygen_Suppress */
 typedef struct _GDALWarpChunk GDALWarpChunk;
+struct GDALWarpChunkWorker;
 /*! @endcond */
 
 class CPL_DLL GDALWarpOperation
@@ -500,6 +504,7 @@ class CPL_DLL GDALWarpOperation
 
     void WipeOptions();
     int ValidateOptions();
+    void SetupTransformGrid();
 
     bool ComputeSourceWindowTransformPoints(
         int nDstXOff, int nDstYOff, int nDstXSize, int nDstYSize, bool bUseGrid,
@@ -542,11 +547,22 @@ class CPL_DLL GDALWarpOperation
 
     bool m_bIsTranslationOnPixelBoundaries = false;
 
+    // Per-chunk memory limit used by CollectChunkListInternal(), when
+    // different from psOptions->dfWarpMemoryLimit.
+    double m_dfChunkMemoryLimit = 0;
+
+    // Set on the per-thread operations created by ChunkAndWarpMulti() when
+    // several chunks are processed concurrently.
+    GDALWarpChunkWorker *m_psChunkWorker = nullptr;
+
     void WipeChunkList();
     CPLErr CollectChunkListInternal(int nDstXOff, int nDstYOff, int nDstXSize,
                                     int nDstYSize);
     void CollectChunkList(int nDstXOff, int nDstYOff, int nDstXSize,
                           int nDstYSize);
+    bool ChunkAndWarpMultiParallel(int nDstXOff, int nDstYOff, int nDstXSize,
+                                   int nDstYSize, int nChunkThreads,
+                                   CPLErr &eErr);
     void ReportTiming(const char *);
 
   public:
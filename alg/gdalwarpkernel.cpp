@@ -39,6 +39,7 @@
 #include <cstring>
 
 #include <algorithm>
+#include <chrono>
 #include <limits>
 #include <mutex>
 #include <new>
@@ -247,6 +248,11 @@ struct GWKThreadData
     std::map<GIntBig, void *> mapThreadToTransformerArg{};
     int nTotalThreadCountForThisRun = 0;
     int nCurThreadCountForThisRun = 0;
+
+    // Information on the last GWKRun(), for GWKThreadsFetchLastRunInfo().
+    const char *pszLastRunFuncName = nullptr;
+    int nLastRunThreadCount = 0;
+    double dfLastRunBusyTime = 0;  // Sum of the durations of the jobs
 };
 
 /************************************************************************/
@@ -373,6 +379,35 @@ void GWKThreadsEnd(void *psThreadDataIn)
     delete psThreadData;
 }
 
+/************************************************************************/
+/*                      GWKThreadsFetchLastRunInfo()                    */
+/************************************************************************/
+
+// Return the name of the kernel function of the last warp done with this
+// thread data, the number of threads used, and the sum of the time spent by
+// each thread in the kernel, and reset them. Returns false if no kernel has
+// run since the previous call.
+
+bool GWKThreadsFetchLastRunInfo(void *psThreadDataIn,
+                                const char **ppszFuncName, int *pnThreads,
+                                double *pdfBusyTime)
+{
+    GWKThreadData *psThreadData = static_cast<GWKThreadData *>(psThreadDataIn);
+    if (psThreadData == nullptr)
+        return false;
+
+    std::lock_guard<std::mutex> lock(psThreadData->mutex);
+    if (psThreadData->pszLastRunFuncName == nullptr)
+        return false;
+    *ppszFuncName = psThreadData->pszLastRunFuncName;
+    *pnThreads = psThreadData->nLastRunThreadCount;
+    *pdfBusyTime = psThreadData->dfLastRunBusyTime;
+    psThreadData->pszLastRunFuncName = nullptr;
+    psThreadData->nLastRunThreadCount = 0;
+    psThreadData->dfLastRunBusyTime = 0;
+    return true;
+}
+
 /************************************************************************/
 /*                         ThreadFuncAdapter()                          */
 /************************************************************************/
@@ -434,11 +469,15 @@ static void ThreadFuncAdapter(void *pData)
     }
 
     psJob->pTransformerArg = pTransformerArg;
+    const auto oStart = std::chrono::steady_clock::now();
     psJob->pfnFunc(pData);
+    const std::chrono::duration<double> oDuration =
+        std::chrono::steady_clock::now() - oStart;
 
     // Give back original transformer, if borrowed.
     {
         std::lock_guard<std::mutex> lock(psThreadData->mutex);
+        psThreadData->dfLastRunBusyTime += oDuration.count();
         if (psThreadData->bTransformerArgInputAssignedToThread &&
             pTransformerArg == psThreadData->pTransformerArgInput)
         {
@@ -476,7 +515,16 @@ static CPLErr GWKRun(GDALWarpKernel *poWK, const char *pszFuncName,
         static_cast<GWKThreadData *>(poWK->psThreadData);
     if (psThreadData == nullptr || psThreadData->poJobQueue == nullptr)
     {
-        return GWKGenericMonoThread(poWK, pfnFunc);
+        if (psThreadData == nullptr)
+            return GWKGenericMonoThread(poWK, pfnFunc);
+        const auto oStart = std::chrono::steady_clock::now();
+        const CPLErr eErr = GWKGenericMonoThread(poWK, pfnFunc);
+        const std::chrono::duration<double> oDuration =
+            std::chrono::steady_clock::now() - oStart;
+        psThreadData->pszLastRunFuncName = pszFuncName;
+        psThreadData->nLastRunThreadCount = 1;
+        psThreadData->dfLastRunBusyTime = oDuration.count();
+        return eErr;
     }
 
     int nThreads = std::min(psThreadData->nMaxThreads, nDstYSize / 2);
@@ -519,6 +567,10 @@ static CPLErr GWKRun(GDALWarpKernel *poWK, const char *pszFuncName,
         // coverity[missing_lock]
         psThreadData->nCurThreadCountForThisRun = 0;
 
+        psThreadData->pszLastRunFuncName = pszFuncName;
+        psThreadData->nLastRunThreadCount = nThreads;
+        psThreadData->dfLastRunBusyTime = 0;
+
         // Start jobs.
         for (int i = 0; i < nThreads; ++i)
         {
@@ -1210,8 +1262,9 @@ CPLErr GDALWarpKernel::PerformWarp()
     if ((eWorkingDataType == GDT_Byte || eWorkingDataType == GDT_CInt16 ||
          eWorkingDataType == GDT_UInt16 || eWorkingDataType == GDT_Int16 ||
          eWorkingDataType == GDT_CFloat32 || eWorkingDataType == GDT_Float32) &&
-        (eResample == GRA_Bilinear || eResample == GRA_Cubic ||
-         eResample == GRA_CubicSpline || eResample == GRA_Lanczos) &&
+        (eResample == GRA_NearestNeighbour || eResample == GRA_Bilinear ||
+         eResample == GRA_Cubic || eResample == GRA_CubicSpline ||
+         eResample == GRA_Lanczos) &&
         !bApplyVerticalShift &&
         // OpenCL warping gives different results than the ones expected by autotest,
         // so disable it by default even if found.
@@ -3266,6 +3319,158 @@ static bool GWKCubicResampleNoMasks4SampleT(const GDALWarpKernel *poWK,
     return true;
 }
 
+/************************************************************************/
+/*              GWKBilinearResampleNoMasks4SampleMultiBandT()           */
+/************************************************************************/
+
+// Same as GWKBilinearResampleNoMasks4SampleT(), but for all bands at once,
+// so that the source offset and weights are computed once per pixel.
+// Returns the same values as the per-band function.
+
+template <class T>
+static void GWKBilinearResampleNoMasks4SampleMultiBandT(
+    const GDALWarpKernel *poWK, double dfSrcX, double dfSrcY, T *pValues)
+
+{
+    const int nSrcXSize = poWK->nSrcXSize;
+    const int iSrcX = static_cast<int>(floor(dfSrcX - 0.5));
+    const int iSrcY = static_cast<int>(floor(dfSrcY - 0.5));
+
+    if (!(iSrcX >= 0 && iSrcX + 1 < nSrcXSize && iSrcY >= 0 &&
+          iSrcY + 1 < poWK->nSrcYSize))
+    {
+        for (int iBand = 0; iBand < poWK->nBands; iBand++)
+            GWKBilinearResampleNoMasks4SampleT(poWK, iBand, dfSrcX, dfSrcY,
+                                               pValues + iBand);
+        return;
+    }
+
+    const GPtrDiff_t iSrcOffset =
+        iSrcX + static_cast<GPtrDiff_t>(iSrcY) * nSrcXSize;
+    const double dfRatioX = 1.5 - (dfSrcX - iSrcX);
+    const double dfRatioY = 1.5 - (dfSrcY - iSrcY);
+    const double dfOneMinusRatioX = 1.0 - dfRatioX;
+    const double dfOneMinusRatioY = 1.0 - dfRatioY;
+
+    for (int iBand = 0; iBand < poWK->nBands; iBand++)
+    {
+        const T *const pSrc =
+            reinterpret_cast<const T *>(poWK->papabySrcImage[iBand]) +
+            iSrcOffset;
+        const double dfAccumulator =
+            (pSrc[0] * dfRatioX + pSrc[1] * dfOneMinusRatioX) * dfRatioY +
+            (pSrc[nSrcXSize] * dfRatioX +
+             pSrc[1 + nSrcXSize] * dfOneMinusRatioX) *
+                dfOneMinusRatioY;
+        pValues[iBand] = GWKRoundValueT<T>(dfAccumulator);
+    }
+}
+
+/************************************************************************/
+/*               GWKCubicResampleNoMasks4SampleMultiBandT()             */
+/************************************************************************/
+
+#if defined(__x86_64) || defined(_M_X64)
+
+// Horizontal convolution of 4 consecutive rows of 4 pixels. Rows are
+// transposed so that each SSE2 lane accumulates one row in the same order
+// as CONVOL4(), which gives the same result as the scalar code.
+template <class T>
+static CPL_INLINE void GWKCubicConvolve4Rows_SSE2(const T *pSrc,
+                                                  GPtrDiff_t nStride,
+                                                  const __m128d *pxmmCoeffs,
+                                                  double adfValue[4])
+{
+    for (int iPair = 0; iPair < 2; iPair++)
+    {
+        XMMReg2Double oRow0Low, oRow0High, oRow1Low, oRow1High;
+        XMMReg2Double::Load4Val(pSrc + 2 * iPair * nStride, oRow0Low,
+                                oRow0High);
+        XMMReg2Double::Load4Val(pSrc + (2 * iPair + 1) * nStride, oRow1Low,
+                                oRow1High);
+        __m128d xmmAcc = _mm_mul_pd(_mm_unpacklo_pd(oRow0Low.xmm, oRow1Low.xmm),
+                                    pxmmCoeffs[0]);
+        xmmAcc = _mm_add_pd(
+            xmmAcc, _mm_mul_pd(_mm_unpackhi_pd(oRow0Low.xmm, oRow1Low.xmm),
+                               pxmmCoeffs[1]));
+        xmmAcc = _mm_add_pd(
+            xmmAcc, _mm_mul_pd(_mm_unpacklo_pd(oRow0High.xmm, oRow1High.xmm),
+                               pxmmCoeffs[2]));
+        xmmAcc = _mm_add_pd(
+            xmmAcc, _mm_mul_pd(_mm_unpackhi_pd(oRow0High.xmm, oRow1High.xmm),
+                               pxmmCoeffs[3]));
+        _mm_storeu_pd(adfValue + 2 * iPair, xmmAcc);
+    }
+}
+
+#endif
+
+// Same as GWKCubicResampleNoMasks4SampleT(), but for all bands at once, so
+// that the source offset and weights are computed once per pixel.
+// Returns the same values as the per-band function.
+
+template <class T>
+static void GWKCubicResampleNoMasks4SampleMultiBandT(const GDALWarpKernel *poWK,
+                                                     double dfSrcX,
+                                                     double dfSrcY, T *pValues)
+
+{
+    const int nSrcXSize = poWK->nSrcXSize;
+    const int iSrcX = static_cast<int>(dfSrcX - 0.5);
+    const int iSrcY = static_cast<int>(dfSrcY - 0.5);
+
+    // Get the bilinear interpolation at the image borders.
+    if (iSrcX - 1 < 0 || iSrcX + 2 >= nSrcXSize || iSrcY - 1 < 0 ||
+        iSrcY + 2 >= poWK->nSrcYSize)
+    {
+        GWKBilinearResampleNoMasks4SampleMultiBandT(poWK, dfSrcX, dfSrcY,
+                                                    pValues);
+        return;
+    }
+
+    const GPtrDiff_t iSrcOffset =
+        iSrcX + static_cast<GPtrDiff_t>(iSrcY) * nSrcXSize;
+    const double dfDeltaX = dfSrcX - 0.5 - iSrcX;
+    const double dfDeltaY = dfSrcY - 0.5 - iSrcY;
+    const double dfDeltaY2 = dfDeltaY * dfDeltaY;
+    const double dfDeltaY3 = dfDeltaY2 * dfDeltaY;
+
+    double adfCoeffs[4] = {};
+    GWKCubicComputeWeights(dfDeltaX, adfCoeffs);
+#if defined(__x86_64) || defined(_M_X64)
+    const __m128d axmmCoeffs[4] = {
+        _mm_set1_pd(adfCoeffs[0]), _mm_set1_pd(adfCoeffs[1]),
+        _mm_set1_pd(adfCoeffs[2]), _mm_set1_pd(adfCoeffs[3])};
+#endif
+
+    // Top-left pixel of the 4x4 neighbourhood.
+    const GPtrDiff_t iTopLeftOffset = iSrcOffset - nSrcXSize - 1;
+
+    for (int iBand = 0; iBand < poWK->nBands; iBand++)
+    {
+        const T *const pSrc =
+            reinterpret_cast<const T *>(poWK->papabySrcImage[iBand]) +
+            iTopLeftOffset;
+
+        double adfValue[4];
+#if defined(__x86_64) || defined(_M_X64)
+        GWKCubicConvolve4Rows_SSE2(pSrc, nSrcXSize, axmmCoeffs, adfValue);
+#else
+        for (int i = 0; i < 4; i++)
+        {
+            adfValue[i] = CONVOL4(
+                adfCoeffs, pSrc + static_cast<GPtrDiff_t>(i) * nSrcXSize);
+        }
+#endif
+
+        const double dfValue =
+            CubicConvolution(dfDeltaY, dfDeltaY2, dfDeltaY3, adfValue[0],
+                             adfValue[1], adfValue[2], adfValue[3]);
+
+        pValues[iBand] = GWKClampValueT<T>(dfValue);
+    }
+}
+
 /************************************************************************/
 /*                          GWKLanczosSinc()                            */
 /************************************************************************/
@@ -4612,6 +4817,9 @@ static CPLErr GWKOpenCLCase(GDALWarpKernel *poWK)
     OCLResampAlg resampAlg;
     switch (poWK->eResample)
     {
+        case GRA_NearestNeighbour:
+            resampAlg = OCL_NearestNeighbour;
+            break;
         case GRA_Bilinear:
             resampAlg = OCL_Bilinear;
             break;
@@ -5873,6 +6081,13 @@ static void GWKResampleNoMasksOrDstDensityOnlyThreadInternal(void *pData)
     for (int iDstX = 0; iDstX < nDstXSize; iDstX++)
         padfX[nDstXSize + iDstX] = iDstX + 0.5 + poWK->nDstXOff;
 
+    // With the 4 samples formulas, resample all bands of a pixel at once.
+    const bool bMultiBand =
+        bUse4SamplesFormula && poWK->nBands > 1 &&
+        !poWK->bApplyVerticalShift &&
+        CPLTestBool(CPLGetConfigOption("GDAL_WARP_MULTI_BAND_KERNEL", "YES"));
+    std::vector<T> aValues(bMultiBand ? poWK->nBands : 0);
+
     /* ==================================================================== */
     /*      Loop over output lines.                                         */
     /* ==================================================================== */
@@ -5926,6 +6141,29 @@ static void GWKResampleNoMasksOrDstDensityOnlyThreadInternal(void *pData)
             const GPtrDiff_t iDstOffset =
                 iDstX + static_cast<GPtrDiff_t>(iDstY) * nDstXSize;
 
+            if (bMultiBand)
+            {
+                if constexpr (eResample == GRA_Bilinear)
+                    GWKBilinearResampleNoMasks4SampleMultiBandT(
+                        poWK, padfX[iDstX] - poWK->nSrcXOff,
+                        padfY[iDstX] - poWK->nSrcYOff, aValues.data());
+                else if constexpr (eResample == GRA_Cubic)
+                    GWKCubicResampleNoMasks4SampleMultiBandT(
+                        poWK, padfX[iDstX] - poWK->nSrcXOff,
+                        padfY[iDstX] - poWK->nSrcYOff, aValues.data());
+
+                if (poWK->pafDstDensity)
+                    poWK->pafDstDensity[iDstOffset] = 1.0f;
+
+                for (int iBand = 0; iBand < poWK->nBands; iBand++)
+                {
+                    reinterpret_cast<T *>(
+                        poWK->papabyDstImage[iBand])[iDstOffset] =
+                        aValues[iBand];
+                }
+                continue;
+            }
+
             for (int iBand = 0; iBand < poWK->nBands; iBand++)
             {
                 T value = 0;
@@ -6374,9 +6612,34 @@ static CPLErr GWKNearestFloat(GDALWarpKernel *poWK)
 /************************************************************************/
 
 static void GWKAverageOrModeThread(void *pData);
+static bool GWKAverageSeparableIsPossible(const GDALWarpKernel *poWK);
+template <class T> static void GWKAverageSeparableThread(void *pData);
 
 static CPLErr GWKAverageOrMode(GDALWarpKernel *poWK)
 {
+    if (GWKAverageSeparableIsPossible(poWK))
+    {
+        switch (poWK->eWorkingDataType)
+        {
+            case GDT_Byte:
+                return GWKRun(poWK, "GWKAverageSeparable",
+                              GWKAverageSeparableThread<GByte>);
+            case GDT_Int16:
+                return GWKRun(poWK, "GWKAverageSeparable",
+                              GWKAverageSeparableThread<GInt16>);
+            case GDT_UInt16:
+                return GWKRun(poWK, "GWKAverageSeparable",
+                              GWKAverageSeparableThread<GUInt16>);
+            case GDT_Float32:
+                return GWKRun(poWK, "GWKAverageSeparable",
+                              GWKAverageSeparableThread<float>);
+            case GDT_Float64:
+                return GWKRun(poWK, "GWKAverageSeparable",
+                              GWKAverageSeparableThread<double>);
+            default:
+                break;
+        }
+    }
     return GWKRun(poWK, "GWKAverageOrMode", GWKAverageOrModeThread);
 }
 
@@ -7338,6 +7601,234 @@ static void GWKAverageOrModeThread(void *pData)
     }
 }
 
+/************************************************************************/
+/*                    GWKAverageSeparableIsPossible()                   */
+/************************************************************************/
+
+// GRA_Average can use GWKAverageSeparableThread() when the transformer is
+// affine without rotation and no source mask is involved.
+static bool GWKAverageSeparableIsPossible(const GDALWarpKernel *poWK)
+{
+    return poWK->eResample == GRA_Average && !poWK->bApplyVerticalShift &&
+           poWK->papanBandSrcValid == nullptr &&
+           poWK->panUnifiedSrcValid == nullptr &&
+           poWK->pafUnifiedSrcDensity == nullptr &&
+           CPLAtof(CSLFetchNameValueDef(poWK->papszWarpOptions,
+                                        "SRC_COORD_PRECISION", "0")) <= 0 &&
+           GDALTransformIsAffineNoRotation(poWK->pfnTransformer,
+                                           poWK->pTransformerArg) &&
+           // for debug/testing purposes
+           CPLTestBool(
+               CPLGetConfigOption("GDAL_WARP_USE_AFFINE_OPTIMIZATION", "YES"));
+}
+
+/************************************************************************/
+/*                      GWKAverageSeparableThread()                     */
+/************************************************************************/
+
+namespace
+{
+// Extent in source pixels of a destination column or line.
+struct GWKAverageExtent
+{
+    bool bValid = false;
+    int iSrcMin = 0;
+    int iSrcMax = 0;
+    // Weights of the first and last source pixels
+    double dfWeightFirst = 1.0;
+    double dfWeightLast = 1.0;
+};
+}  // namespace
+
+// Computes the extent of [dfMin, dfMax] the same way as
+// GWKAverageOrModeThread(), so that the results are identical.
+static GWKAverageExtent GWKAverageComputeExtent(double dfMin, double dfMax,
+                                                int nSrcSize, int nMargin)
+{
+    GWKAverageExtent sExtent;
+    if (!(dfMin >= -nMargin && dfMax >= -nMargin &&
+          dfMin - nSrcSize <= nMargin && dfMax - nSrcSize <= nMargin))
+        return sExtent;
+
+    if (dfMin > dfMax)
+        std::swap(dfMin, dfMax);
+    constexpr double EPS = 1e-10;
+    if (!(dfMax > -EPS && dfMin < nSrcSize + EPS))
+        return sExtent;
+    sExtent.iSrcMin = static_cast<int>(std::max(floor(dfMin + EPS), 0.0));
+    sExtent.iSrcMax = static_cast<int>(
+        std::min(ceil(dfMax - EPS), static_cast<double>(INT_MAX)));
+    sExtent.iSrcMax = std::min(sExtent.iSrcMax, nSrcSize);
+    if (sExtent.iSrcMin == sExtent.iSrcMax && sExtent.iSrcMax < nSrcSize)
+        sExtent.iSrcMax++;
+    if (sExtent.iSrcMin + 1 != sExtent.iSrcMax)
+    {
+        sExtent.dfWeightFirst = 1 - (dfMin - sExtent.iSrcMin);
+        sExtent.dfWeightLast = 1 - (sExtent.iSrcMax - dfMax);
+    }
+    sExtent.bValid = true;
+    return sExtent;
+}
+
+// Same as GWKAverageOrModeThread() for GRA_Average, when the transformer is
+// affine without rotation and there is no source mask. The footprint of a
+// destination pixel is then the product of the extents of its column and of
+// its line, which are computed once, and source pixels are read directly.
+template <class T> static void GWKAverageSeparableThread(void *pData)
+{
+    GWKJobStruct *psJob = static_cast<GWKJobStruct *>(pData);
+    GDALWarpKernel *poWK = psJob->poWK;
+    const int iYMin = psJob->iYMin;
+    const int iYMax = psJob->iYMax;
+    const int nDstXSize = poWK->nDstXSize;
+    const int nSrcXSize = poWK->nSrcXSize;
+    const int nSrcYSize = poWK->nSrcYSize;
+
+    const int nXMargin =
+        2 * std::max(1, static_cast<int>(std::ceil(1. / poWK->dfXScale)));
+    const int nYMargin =
+        2 * std::max(1, static_cast<int>(std::ceil(1. / poWK->dfYScale)));
+
+    /* -------------------------------------------------------------------- */
+    /*      Transform the edges of the destination columns and lines.       */
+    /* -------------------------------------------------------------------- */
+    const int nPoints = std::max(nDstXSize, iYMax - iYMin) + 1;
+    std::vector<double> adfX(nPoints);
+    std::vector<double> adfY(nPoints);
+    std::vector<double> adfZ(nPoints);
+    std::vector<int> abSuccess(nPoints);
+
+    std::vector<GWKAverageExtent> asColumns(nDstXSize);
+    for (int i = 0; i <= nDstXSize; i++)
+    {
+        adfX[i] = i + poWK->nDstXOff;
+        adfY[i] = iYMin + poWK->nDstYOff;
+        adfZ[i] = 0.0;
+    }
+    poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstXSize + 1,
+                         adfX.data(), adfY.data(), adfZ.data(),
+                         abSuccess.data());
+    const int nThresholdWrapOverX = std::min(2, nSrcXSize / 10);
+    for (int iDstX = 0; iDstX < nDstXSize; iDstX++)
+    {
+        if (!abSuccess[iDstX] || !abSuccess[iDstX + 1])
+            continue;
+        const double dfX1 = std::min(adfX[iDstX], adfX[iDstX + 1]);
+        const double dfX2 = std::max(adfX[iDstX], adfX[iDstX + 1]);
+        // Leave the antimeridian wrapping logic to the general case.
+        if (poWK->nSrcXOff == 0 &&
+            dfX1 * poWK->dfXScale < nThresholdWrapOverX &&
+            (nSrcXSize - dfX2) * poWK->dfXScale < nThresholdWrapOverX)
+        {
+            GWKAverageOrModeThread(pData);
+            return;
+        }
+        asColumns[iDstX] =
+            GWKAverageComputeExtent(adfX[iDstX] - poWK->nSrcXOff,
+                                    adfX[iDstX + 1] - poWK->nSrcXOff,
+                                    nSrcXSize, nXMargin);
+    }
+
+    std::vector<GWKAverageExtent> asLines(iYMax - iYMin);
+    for (int i = 0; i <= iYMax - iYMin; i++)
+    {
+        adfX[i] = poWK->nDstXOff;
+        adfY[i] = iYMin + i + poWK->nDstYOff;
+        adfZ[i] = 0.0;
+    }
+    poWK->pfnTransformer(psJob->pTransformerArg, TRUE, iYMax - iYMin + 1,
+                         adfX.data(), adfY.data(), adfZ.data(),
+                         abSuccess.data());
+    for (int i = 0; i < iYMax - iYMin; i++)
+    {
+        if (abSuccess[i] && abSuccess[i + 1])
+        {
+            asLines[i] = GWKAverageComputeExtent(
+                adfY[i] - poWK->nSrcYOff, adfY[i + 1] - poWK->nSrcYOff,
+                nSrcYSize, nYMargin);
+        }
+    }
+
+    /* ==================================================================== */
+    /*      Loop over output lines.                                         */
+    /* ==================================================================== */
+    for (int iDstY = iYMin; iDstY < iYMax; iDstY++)
+    {
+        const GWKAverageExtent &sLine = asLines[iDstY - iYMin];
+        for (int iDstX = 0; sLine.bValid && iDstX < nDstXSize; iDstX++)
+        {
+            const GWKAverageExtent &sCol = asColumns[iDstX];
+            if (!sCol.bValid)
+                continue;
+
+            const GPtrDiff_t iDstOffset =
+                iDstX + static_cast<GPtrDiff_t>(iDstY) * nDstXSize;
+            bool bHasFoundDensity = false;
+
+            for (int iBand = 0; iBand < poWK->nBands; iBand++)
+            {
+                const T *pSrc =
+                    reinterpret_cast<const T *>(poWK->papabySrcImage[iBand]);
+                double dfTotalWeight = 0.0;
+                double dfValue = 0.0;
+
+                for (int iSrcY = sLine.iSrcMin; iSrcY < sLine.iSrcMax; iSrcY++)
+                {
+                    const double dfWeightY =
+                        iSrcY == sLine.iSrcMin       ? sLine.dfWeightFirst
+                        : iSrcY + 1 == sLine.iSrcMax ? sLine.dfWeightLast
+                                                     : 1.0;
+                    const T *pSrcLine =
+                        pSrc + static_cast<GPtrDiff_t>(iSrcY) * nSrcXSize;
+                    for (int iSrcX = sCol.iSrcMin; iSrcX < sCol.iSrcMax;
+                         iSrcX++)
+                    {
+                        const double dfWeight =
+                            iSrcX == sCol.iSrcMin
+                                ? dfWeightY * sCol.dfWeightFirst
+                            : iSrcX + 1 == sCol.iSrcMax
+                                ? dfWeightY * sCol.dfWeightLast
+                                : dfWeightY;
+                        if (dfWeight > 0)
+                        {
+                            // Weighted incremental mean, as in
+                            // GWKAverageOrModeThread().
+                            dfTotalWeight += dfWeight;
+                            dfValue += (dfWeight / dfTotalWeight) *
+                                       (pSrcLine[iSrcX] - dfValue);
+                        }
+                    }
+                }
+
+                if (dfTotalWeight > 0)
+                {
+                    GWKSetPixelValue(poWK, iBand, iDstOffset, 1.0, dfValue,
+                                     0.0);
+                    bHasFoundDensity = true;
+                }
+            }
+
+            if (!bHasFoundDensity)
+                continue;
+
+            GWKOverlayDensity(poWK, iDstOffset, 1.0);
+
+            if (poWK->panDstValid != nullptr)
+            {
+                CPLMaskSet(poWK->panDstValid, iDstOffset);
+            }
+        }
+
+        /* --------------------------------------------------------------------
+         */
+        /*      Report progress to the user, and optionally cancel out. */
+        /* --------------------------------------------------------------------
+         */
+        if (psJob->pfnProgress && psJob->pfnProgress(psJob))
+            break;
+    }
+}
+
 /************************************************************************/
 /*                         getOrientation()                             */
 /************************************************************************/
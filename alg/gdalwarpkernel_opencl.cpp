@@ -41,6 +41,9 @@
 #include <limits.h>
 #include <float.h>
 #include <limits>
+#include <map>
+#include <mutex>
+#include <string>
 #include <vector>
 #include "cpl_string.h"
 #include "gdalwarpkernel_opencl.h"
@@ -677,6 +680,84 @@ static cl_int alloc_working_arr(struct oclWarper *warper, size_t ptrSz,
     return CL_SUCCESS;
 }
 
+/*
+ The OpenCL context is shared by all the warpers of the process, so that the
+ programs built for a chunk can be reused by the next chunks instead of being
+ compiled again. They are kept until the device changes or too many of them
+ have accumulated. The references held by this cache are never released
+ before the process ends.
+ */
+static std::mutex goOCLCacheMutex;
+static cl_context ghSharedContext = nullptr;
+static cl_device_id ghSharedContextDevice = nullptr;
+static std::map<std::string, cl_program> goMapCachedPrograms;
+constexpr size_t MAX_CACHED_PROGRAMS = 32;
+
+static void release_cached_programs()
+{
+    for (auto &oIter : goMapCachedPrograms)
+        clReleaseProgram(oIter.second);
+    goMapCachedPrograms.clear();
+}
+
+/*
+ Returns a new reference to the shared context for the device, creating it
+ if needed.
+ */
+static cl_context get_shared_context(cl_device_id device, cl_int *clErr)
+{
+    std::lock_guard<std::mutex> oLock(goOCLCacheMutex);
+    if (ghSharedContext == nullptr || ghSharedContextDevice != device)
+    {
+        if (ghSharedContext != nullptr)
+        {
+            release_cached_programs();
+            clReleaseContext(ghSharedContext);
+            ghSharedContext = nullptr;
+        }
+        ghSharedContext =
+            clCreateContext(nullptr, 1, &device, nullptr, nullptr, clErr);
+        if (*clErr != CL_SUCCESS)
+        {
+            ghSharedContext = nullptr;
+            return nullptr;
+        }
+        ghSharedContextDevice = device;
+    }
+    clRetainContext(ghSharedContext);
+    *clErr = CL_SUCCESS;
+    return ghSharedContext;
+}
+
+/*
+ Returns a new reference to the program built with the given key, or NULL.
+ */
+static cl_program get_cached_program(cl_context context,
+                                     const std::string &osKey)
+{
+    std::lock_guard<std::mutex> oLock(goOCLCacheMutex);
+    if (context != ghSharedContext)
+        return nullptr;
+    auto oIter = goMapCachedPrograms.find(osKey);
+    if (oIter == goMapCachedPrograms.end())
+        return nullptr;
+    clRetainProgram(oIter->second);
+    return oIter->second;
+}
+
+static void cache_program(cl_context context, const std::string &osKey,
+                          cl_program program)
+{
+    std::lock_guard<std::mutex> oLock(goOCLCacheMutex);
+    if (context != ghSharedContext ||
+        goMapCachedPrograms.find(osKey) != goMapCachedPrograms.end())
+        return;
+    if (goMapCachedPrograms.size() >= MAX_CACHED_PROGRAMS)
+        release_cached_programs();
+    clRetainProgram(program);
+    goMapCachedPrograms[osKey] = program;
+}
+
 /*
  Assemble and create the kernel. For optimization, portability, and
  implementation limitation reasons, the program is actually assembled from
@@ -695,6 +776,8 @@ static cl_kernel get_kernel(struct oclWarper *warper, char useVec,
     cl_program program;
     cl_kernel kernel;
     cl_int err = CL_SUCCESS;
+    const char *pszProgBuf = nullptr;
+    std::string osProgramKey;
     constexpr int PROGBUF_SIZE = 128000;
     std::string buffer;
     buffer.resize(PROGBUF_SIZE);
@@ -1097,6 +1180,44 @@ __kernel void resamp(__read_only image2d_t srcCoords,
                 fAccumulatorDensity, fAccumulatorReal, fAccumulatorImag );
     }
 }
+)"""";
+
+    const char *kernNearest = R""""(
+// ************************ Nearest ************************
+__kernel void resamp(__read_only image2d_t srcCoords,
+                     __read_only image2d_t srcReal,
+                     __read_only image2d_t srcImag,
+                     __global float *fUnifiedSrcDensity,
+                     __global int *nUnifiedSrcValid,
+                     __constant char *useBandSrcValid,
+                     __global int *nBandSrcValid,
+                     __global outType *dstReal,
+                     __global outType *dstImag,
+                     __constant float *fDstNoDataReal,
+                     __global float *dstDensity,
+                     __global int *nDstValid,
+                     const int bandNum)
+{
+    float2  fSrc = getSrcCoords(srcCoords);
+    if (!isValid(fUnifiedSrcDensity, nUnifiedSrcValid, fSrc))
+        return;
+
+    int     iSrcX = (int) floor(fSrc.x);
+    int     iSrcY = (int) floor(fSrc.y);
+    vecf    fReal, fImag = 0.0f, fDens;
+
+    if (iSrcX >= iSrcWidth || iSrcY >= iSrcHeight)
+        return;
+
+    // Leave the destination pixel untouched if the source one is invalid
+    if (getPixel(srcReal, srcImag, fUnifiedSrcDensity, nUnifiedSrcValid,
+                 useBandSrcValid, nBandSrcValid, (int2)(iSrcX, iSrcY),
+                 bandNum, &fDens, &fReal, &fImag))
+    {
+        setPixel(dstReal, dstImag, dstDensity, nDstValid, fDstNoDataReal,
+                 bandNum, fDens, fReal, fImag);
+    }
+}
 )"""";
 
     const char *kernCubic = R""""(
@@ -1406,7 +1527,10 @@ __kernel void resamp(__read_only image2d_t srcCoords,
 
     // Assemble the kernel from parts. The compiler is unable to handle multiple
     // kernels in one string with more than a few __constant modifiers each.
-    if (warper->resampAlg == OCL_Bilinear)
+    if (warper->resampAlg == OCL_NearestNeighbour)
+        snprintf(&progBuf[0], PROGBUF_SIZE, "%s\n%s", kernGenFuncs,
+                 kernNearest);
+    else if (warper->resampAlg == OCL_Bilinear)
         snprintf(&progBuf[0], PROGBUF_SIZE, "%s\n%s", kernGenFuncs,
                  kernBilinear);
     else if (warper->resampAlg == OCL_Cubic)
@@ -1415,12 +1539,6 @@ __kernel void resamp(__read_only image2d_t srcCoords,
         snprintf(&progBuf[0], PROGBUF_SIZE, "%s\n%s", kernGenFuncs,
                  kernResampler);
 
-    // Actually make the program from assembled source
-    const char *pszProgBuf = progBuf.c_str();
-    program = clCreateProgramWithSource(warper->context, 1, &pszProgBuf,
-                                        nullptr, &err);
-    handleErrGoto(err, error_final);
-
     // Assemble the compiler arg string for speed. All invariants should be
     // defined here.
     snprintf(
@@ -1447,38 +1565,60 @@ __kernel void resamp(__read_only image2d_t srcCoords,
         warper->resampAlg == OCL_CubicSpline,
         warper->nBandSrcValidCL != nullptr, warper->coordMult);
 
-    (*clErr) = err = clBuildProgram(program, 1, &(warper->dev), buffer.data(),
-                                    nullptr, nullptr);
-
-    // Detailed debugging info
-    if (err != CL_SUCCESS)
+    // The program only depends on the resampling algorithm and on the
+    // invariants, so chunks of the same size reuse an earlier build.
+    osProgramKey = CPLSPrintf("%d ", static_cast<int>(warper->resampAlg));
+    osProgramKey += buffer.c_str();
+    program = get_cached_program(warper->context, osProgramKey);
+    if (program != nullptr)
     {
-        const char *pszStatus = "unknown_status";
-        err = clGetProgramBuildInfo(program, warper->dev, CL_PROGRAM_BUILD_LOG,
-                                    PROGBUF_SIZE, &buffer[0], nullptr);
-        handleErrGoto(err, error_free_program);
-
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "Error: Failed to build program executable!\nBuild Log:\n%s",
-                 buffer.c_str());
+        (*clErr) = CL_SUCCESS;
+    }
+    else
+    {
+        // Actually make the program from assembled source
+        pszProgBuf = progBuf.c_str();
+        program = clCreateProgramWithSource(warper->context, 1, &pszProgBuf,
+                                            nullptr, &err);
+        handleErrGoto(err, error_final);
 
-        err =
-            clGetProgramBuildInfo(program, warper->dev, CL_PROGRAM_BUILD_STATUS,
-                                  PROGBUF_SIZE, &buffer[0], nullptr);
-        handleErrGoto(err, error_free_program);
+        (*clErr) = err = clBuildProgram(program, 1, &(warper->dev),
+                                        buffer.data(), nullptr, nullptr);
 
-        if (buffer[0] == CL_BUILD_NONE)
-            pszStatus = "CL_BUILD_NONE";
-        else if (buffer[0] == CL_BUILD_ERROR)
-            pszStatus = "CL_BUILD_ERROR";
-        else if (buffer[0] == CL_BUILD_SUCCESS)
-            pszStatus = "CL_BUILD_SUCCESS";
-        else if (buffer[0] == CL_BUILD_IN_PROGRESS)
-            pszStatus = "CL_BUILD_IN_PROGRESS";
+        // Detailed debugging info
+        if (err != CL_SUCCESS)
+        {
+            const char *pszStatus = "unknown_status";
+            err = clGetProgramBuildInfo(program, warper->dev,
+                                        CL_PROGRAM_BUILD_LOG, PROGBUF_SIZE,
+                                        &buffer[0], nullptr);
+            handleErrGoto(err, error_free_program);
+
+            CPLError(
+                CE_Failure, CPLE_AppDefined,
+                "Error: Failed to build program executable!\nBuild Log:\n%s",
+                buffer.c_str());
+
+            err = clGetProgramBuildInfo(program, warper->dev,
+                                        CL_PROGRAM_BUILD_STATUS, PROGBUF_SIZE,
+                                        &buffer[0], nullptr);
+            handleErrGoto(err, error_free_program);
+
+            if (buffer[0] == CL_BUILD_NONE)
+                pszStatus = "CL_BUILD_NONE";
+            else if (buffer[0] == CL_BUILD_ERROR)
+                pszStatus = "CL_BUILD_ERROR";
+            else if (buffer[0] == CL_BUILD_SUCCESS)
+                pszStatus = "CL_BUILD_SUCCESS";
+            else if (buffer[0] == CL_BUILD_IN_PROGRESS)
+                pszStatus = "CL_BUILD_IN_PROGRESS";
+
+            CPLDebug("OpenCL", "Build Status: %s\nProgram Source:\n%s",
+                     pszStatus, progBuf.c_str());
+            goto error_free_program;
+        }
 
-        CPLDebug("OpenCL", "Build Status: %s\nProgram Source:\n%s", pszStatus,
-                 progBuf.c_str());
-        goto error_free_program;
+        cache_program(warper->context, osProgramKey, program);
     }
 
     kernel = clCreateKernel(program, "resamp", &err);
@@ -2318,8 +2458,7 @@ struct oclWarper *GDALWarpKernelOpenCL_createEnv(
 
     warper->dev = device;
 
-    warper->context =
-        clCreateContext(nullptr, 1, &(warper->dev), nullptr, nullptr, &err);
+    warper->context = get_shared_context(warper->dev, &err);
     handleErrGoto(err, error_label);
 #if __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6) || defined(__clang__)
 #pragma GCC diagnostic push
@@ -55,7 +55,8 @@ extern "C"
         OCL_Bilinear = 10,
         OCL_Cubic = 11,
         OCL_CubicSpline = 12,
-        OCL_Lanczos = 13
+        OCL_Lanczos = 13,
+        OCL_NearestNeighbour = 14
     } OCLResampAlg;
 
     typedef enum
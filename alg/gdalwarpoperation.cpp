@@ -37,17 +37,25 @@
 #include <cstring>
 
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
+#include <string>
+#include <vector>
 
 #include "cpl_config.h"
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_json.h"
 #include "cpl_mask.h"
+#include "cpl_mem_cache.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
+#include "cpl_trace.h"
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_priv.h"
@@ -60,16 +68,292 @@ struct _GDALWarpChunk
     int dx, dy, dsx, dsy;
     int sx, sy, ssx, ssy;
     double sExtraSx, sExtraSy;
+    double dfMemoryUse;
 };
 
+/************************************************************************/
+/*                           GDALWarpProfiler                           */
+/************************************************************************/
+
+namespace
+{
+
+// Timings of one chunk, for the PROFILING_REPORT warping option.
+struct GDALWarpChunkProfile
+{
+    int anDstWindow[4] = {0, 0, 0, 0};
+    int anSrcWindow[4] = {0, 0, 0, 0};
+    double dfSourceWindowTime = 0;
+    double dfDstReadTime = 0;
+    double dfSrcReadTime = 0;
+    double dfMaskTime = 0;
+    double dfKernelTime = 0;
+    double dfDstWriteTime = 0;
+    std::string osKernel{};
+    int nKernelThreads = 0;
+    double dfKernelBusyTime = 0;
+};
+
+// Collects the timings of the chunks of a warp operation, and of the worker
+// operations of NUM_CHUNK_THREADS, and writes them as a JSON report when
+// destroyed.
+class GDALWarpProfiler
+{
+    std::string m_osFilename;
+    std::string m_osSource{};
+    std::string m_osDestination{};
+    std::mutex m_oMutex{};
+    const std::chrono::steady_clock::time_point m_oStart =
+        std::chrono::steady_clock::now();
+    GDALCacheStatistics m_sCacheStatsAtStart{};
+    const char *m_pszTransformGrid = "none";
+    double m_dfChunkListTime = 0;
+    std::vector<GDALWarpChunkProfile> m_asChunks{};
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALWarpProfiler)
+
+    void WriteReport();
+
+  public:
+    GDALWarpProfiler(const std::string &osFilename,
+                     const GDALWarpOptions *psOptions);
+    ~GDALWarpProfiler();
+
+    void SetTransformGrid(const char *pszStatus)
+    {
+        m_pszTransformGrid = pszStatus;
+    }
+
+    void AddChunkListTime(double dfTime)
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_dfChunkListTime += dfTime;
+    }
+
+    void AddChunk(const GDALWarpChunkProfile &sChunk)
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_asChunks.push_back(sChunk);
+    }
+};
+
+// Profile of the chunk being warped by WarpRegion() in the current thread,
+// completed by WarpRegionToBuffer().
+thread_local GDALWarpChunkProfile *tlpsCurrentChunkProfile = nullptr;
+
+double GetElapsedSince(const std::chrono::steady_clock::time_point &oStart)
+{
+    const std::chrono::duration<double> oDuration =
+        std::chrono::steady_clock::now() - oStart;
+    return oDuration.count();
+}
+
+GDALWarpProfiler::GDALWarpProfiler(const std::string &osFilename,
+                                   const GDALWarpOptions *psOptions)
+    : m_osFilename(osFilename)
+{
+    if (psOptions->hSrcDS)
+        m_osSource = GDALGetDescription(psOptions->hSrcDS);
+    if (psOptions->hDstDS)
+        m_osDestination = GDALGetDescription(psOptions->hDstDS);
+    GDALGetCacheStatistics(&m_sCacheStatsAtStart);
+}
+
+GDALWarpProfiler::~GDALWarpProfiler()
+{
+    // Worker operations of NUM_CHUNK_THREADS create their own profiler
+    // before sharing the one of their parent: do not report them.
+    if (!m_asChunks.empty())
+        WriteReport();
+}
+
+void GDALWarpProfiler::WriteReport()
+{
+    double dfSourceWindowTime = 0;
+    double dfDstReadTime = 0;
+    double dfSrcReadTime = 0;
+    double dfMaskTime = 0;
+    double dfKernelTime = 0;
+    double dfDstWriteTime = 0;
+
+    struct KernelStats
+    {
+        int nChunks = 0;
+        double dfTime = 0;
+        double dfAvailableTime = 0;
+        double dfBusyTime = 0;
+    };
+
+    std::map<std::string, KernelStats> oMapKernelStats;
+
+    CPLJSONArray oChunks;
+    for (const auto &sChunk : m_asChunks)
+    {
+        dfSourceWindowTime += sChunk.dfSourceWindowTime;
+        dfDstReadTime += sChunk.dfDstReadTime;
+        dfSrcReadTime += sChunk.dfSrcReadTime;
+        dfMaskTime += sChunk.dfMaskTime;
+        dfKernelTime += sChunk.dfKernelTime;
+        dfDstWriteTime += sChunk.dfDstWriteTime;
+
+        CPLJSONObject oChunk;
+        CPLJSONArray oDstWindow;
+        CPLJSONArray oSrcWindow;
+        for (int i = 0; i < 4; ++i)
+        {
+            oDstWindow.Add(sChunk.anDstWindow[i]);
+            oSrcWindow.Add(sChunk.anSrcWindow[i]);
+        }
+        oChunk.Add("destination_window", oDstWindow);
+        oChunk.Add("source_window", oSrcWindow);
+        oChunk.Add("source_window_time", sChunk.dfSourceWindowTime);
+        oChunk.Add("destination_read_time", sChunk.dfDstReadTime);
+        oChunk.Add("source_read_time", sChunk.dfSrcReadTime);
+        oChunk.Add("mask_time", sChunk.dfMaskTime);
+        oChunk.Add("kernel_time", sChunk.dfKernelTime);
+        oChunk.Add("destination_write_time", sChunk.dfDstWriteTime);
+        if (!sChunk.osKernel.empty())
+        {
+            oChunk.Add("kernel", sChunk.osKernel);
+            oChunk.Add("kernel_threads", sChunk.nKernelThreads);
+
+            auto &sStats = oMapKernelStats[sChunk.osKernel];
+            ++sStats.nChunks;
+            sStats.dfTime += sChunk.dfKernelTime;
+            sStats.dfAvailableTime +=
+                sChunk.dfKernelTime * sChunk.nKernelThreads;
+            sStats.dfBusyTime += sChunk.dfKernelBusyTime;
+        }
+        oChunks.Add(oChunk);
+    }
+
+    CPLJSONObject oTotals;
+    oTotals.Add("source_window_time", dfSourceWindowTime);
+    oTotals.Add("destination_read_time", dfDstReadTime);
+    oTotals.Add("source_read_time", dfSrcReadTime);
+    oTotals.Add("mask_time", dfMaskTime);
+    oTotals.Add("kernel_time", dfKernelTime);
+    oTotals.Add("destination_write_time", dfDstWriteTime);
+
+    CPLJSONObject oKernels;
+    for (const auto &oIter : oMapKernelStats)
+    {
+        CPLJSONObject oKernel;
+        oKernel.Add("chunk_count", oIter.second.nChunks);
+        oKernel.Add("time", oIter.second.dfTime);
+        oKernel.Add("thread_utilization",
+                    oIter.second.dfAvailableTime > 0
+                        ? std::min(1.0, oIter.second.dfBusyTime /
+                                            oIter.second.dfAvailableTime)
+                        : 1.0);
+        oKernels.AddNoSplitName(oIter.first, oKernel);
+    }
+
+    GDALCacheStatistics sCacheStats;
+    GDALGetCacheStatistics(&sCacheStats);
+    const GIntBig nHits = sCacheStats.nHits - m_sCacheStatsAtStart.nHits;
+    const GIntBig nMisses = sCacheStats.nMisses - m_sCacheStatsAtStart.nMisses;
+    CPLJSONObject oBlockCache;
+    oBlockCache.Add("hits", static_cast<GInt64>(nHits));
+    oBlockCache.Add("misses", static_cast<GInt64>(nMisses));
+    oBlockCache.Add("hit_rate", nHits + nMisses > 0
+                                    ? static_cast<double>(nHits) /
+                                          static_cast<double>(nHits + nMisses)
+                                    : 0.0);
+    oBlockCache.Add("evictions",
+                    static_cast<GInt64>(sCacheStats.nEvictions -
+                                        m_sCacheStatsAtStart.nEvictions));
+    oBlockCache.Add("used", static_cast<GInt64>(GDALGetCacheUsed64()));
+    oBlockCache.Add("max", static_cast<GInt64>(GDALGetCacheMax64()));
+
+    CPLJSONObject oOperation;
+    oOperation.Add("source", m_osSource);
+    oOperation.Add("destination", m_osDestination);
+    oOperation.Add("total_time", GetElapsedSince(m_oStart));
+    oOperation.Add("chunk_list_time", m_dfChunkListTime);
+    oOperation.Add("chunk_count", static_cast<int>(m_asChunks.size()));
+    oOperation.Add("transform_grid", m_pszTransformGrid);
+    oOperation.Add("totals", oTotals);
+    oOperation.Add("kernels", oKernels);
+    oOperation.Add("block_cache", oBlockCache);
+    oOperation.Add("chunks", oChunks);
+
+    // The first report written by the process to a file replaces it, and
+    // the next ones are appended to it.
+    static std::mutex goMutex;
+    static std::set<std::string> goSetWrittenFiles;
+    std::lock_guard<std::mutex> oLock(goMutex);
+
+    CPLJSONDocument oDoc;
+    if (goSetWrittenFiles.find(m_osFilename) == goSetWrittenFiles.end() ||
+        !oDoc.Load(m_osFilename))
+    {
+        CPLJSONObject oRoot;
+        oRoot.Add("operations", CPLJSONArray());
+        oDoc.SetRoot(oRoot);
+    }
+    CPLJSONArray oOperations = oDoc.GetRoot().GetArray("operations");
+    oOperations.Add(oOperation);
+    if (oDoc.Save(m_osFilename))
+        goSetWrittenFiles.insert(m_osFilename);
+    else
+        CPLError(CE_Warning, CPLE_FileIO,
+                 "Cannot write warp profiling report to %s",
+                 m_osFilename.c_str());
+}
+
+}  // namespace
+
 struct GDALWarpPrivateData
 {
     int nStepCount = 0;
     std::vector<int> abSuccess{};
     std::vector<double> adfDstX{};
     std::vector<double> adfDstY{};
+
+    // Transform grid transformer installed in the options of the operation
+    // by TRANSFORM_GRID=YES.
+    void *pTransformGridArg = nullptr;
+
+    // Set when the PROFILING_REPORT warping option is set. Shared with the
+    // worker operations of NUM_CHUNK_THREADS.
+    std::shared_ptr<GDALWarpProfiler> poProfiler{};
+
+    // Index of the cutline, created on first use. Shared with the worker
+    // operations of NUM_CHUNK_THREADS.
+    std::shared_ptr<GDALWarpCutlineIndex> poCutlineIndex{};
+    bool bCutlineIndexCreated = false;
+
+    GDALWarpPrivateData() = default;
+    GDALWarpPrivateData(const GDALWarpPrivateData &) = delete;
+    GDALWarpPrivateData &operator=(const GDALWarpPrivateData &) = delete;
+
+    ~GDALWarpPrivateData()
+    {
+        if (pTransformGridArg)
+            GDALDestroyTransformGridTransformer(pTransformGridArg);
+    }
 };
 
+/************************************************************************/
+/*                       Transform grid cache                           */
+/************************************************************************/
+
+// Transform grids built for TRANSFORM_GRID=YES, shared by all warp operations
+// with the same transformer and destination raster size. The key is the
+// serialized transformer followed by the grid parameters.
+static std::mutex gTransformGridCacheMutex{};
+
+static lru11::Cache<std::string, std::shared_ptr<const GDALTransformGrid>> &
+GetTransformGridCache()
+{
+    static lru11::Cache<std::string, std::shared_ptr<const GDALTransformGrid>>
+        oCache(std::max(
+            1, atoi(CPLGetConfigOption("GDAL_WARP_TRANSFORM_GRID_CACHE_SIZE",
+                                       "64"))));
+    return oCache;
+}
+
 static std::mutex gMutex{};
 static std::map<GDALWarpOperation *, std::unique_ptr<GDALWarpPrivateData>>
     gMapPrivate{};
@@ -91,6 +375,33 @@ GetWarpPrivateData(GDALWarpOperation *poWarpOperation)
     }
 }
 
+/************************************************************************/
+/*                          GetCutlineIndex()                           */
+/************************************************************************/
+
+// Returns the index of the cutline of the operation, creating it on first
+// call. May be null, when there is no cutline or GEOS is not available.
+
+static const std::shared_ptr<GDALWarpCutlineIndex> &
+GetCutlineIndex(GDALWarpOperation *poWarpOperation)
+{
+    auto psPrivateData = GetWarpPrivateData(poWarpOperation);
+    if (!psPrivateData->bCutlineIndexCreated)
+    {
+        psPrivateData->bCutlineIndexCreated = true;
+        const auto psOptions = poWarpOperation->GetOptions();
+        // GDALWARP_CUTLINE_INDEX=NO is mostly for testing purposes.
+        if (psOptions && psOptions->hCutline &&
+            CPLTestBool(CPLGetConfigOption("GDALWARP_CUTLINE_INDEX", "YES")))
+        {
+            psPrivateData->poCutlineIndex = GDALWarpCreateCutlineIndex(
+                OGRGeometry::FromHandle(
+                    static_cast<OGRGeometryH>(psOptions->hCutline)));
+        }
+    }
+    return psPrivateData->poCutlineIndex;
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                          GDALWarpOperation                           */
@@ -229,6 +540,168 @@ void GDALWarpOperation::WipeOptions()
     }
 }
 
+/************************************************************************/
+/*                      GDALWarpValueTransform                          */
+/************************************************************************/
+
+namespace
+{
+// Transformation of the source values of a band requested with the SCALE
+// and LUT warp options: linear scaling, clamped to the output range, followed
+// by a piecewise linear lookup table.
+struct GDALWarpValueTransform
+{
+    bool bScale = false;
+    double dfScale = 1.0;
+    double dfOffset = 0.0;
+    double dfMin = 0.0;
+    double dfMax = 0.0;
+    std::vector<double> adfLUTInputs{};
+    std::vector<double> adfLUTOutputs{};
+
+    bool IsIdentity() const
+    {
+        return !bScale && adfLUTInputs.empty();
+    }
+
+    double Apply(double dfVal) const
+    {
+        if (bScale)
+        {
+            dfVal = dfVal * dfScale + dfOffset;
+            dfVal = std::max(dfMin, std::min(dfMax, dfVal));
+        }
+        if (!adfLUTInputs.empty() && !CPLIsNan(dfVal))
+        {
+            // Same semantics as the LUT of VRT complex sources.
+            const auto oIter = std::lower_bound(adfLUTInputs.begin(),
+                                                adfLUTInputs.end(), dfVal);
+            if (oIter == adfLUTInputs.begin())
+                return adfLUTOutputs.front();
+            if (oIter == adfLUTInputs.end())
+                return adfLUTOutputs.back();
+            const size_t i = oIter - adfLUTInputs.begin();
+            if (adfLUTInputs[i] == dfVal)
+                return adfLUTOutputs[i];
+            return adfLUTOutputs[i - 1] +
+                   (dfVal - adfLUTInputs[i - 1]) *
+                       (adfLUTOutputs[i] - adfLUTOutputs[i - 1]) /
+                       (adfLUTInputs[i] - adfLUTInputs[i - 1]);
+        }
+        return dfVal;
+    }
+};
+}  // namespace
+
+/************************************************************************/
+/*                    GDALWarpGetValueTransform()                       */
+/************************************************************************/
+
+// Parse the SCALE[_<n>] and LUT[_<n>] warp options for the band of index
+// iBand (0-based) of the warped band list.
+
+static bool GDALWarpGetValueTransform(CSLConstList papszWarpOptions, int iBand,
+                                      GDALWarpValueTransform &oTransform)
+{
+    const char *pszScale =
+        CSLFetchNameValue(papszWarpOptions, CPLSPrintf("SCALE_%d", iBand + 1));
+    if (pszScale == nullptr)
+        pszScale = CSLFetchNameValue(papszWarpOptions, "SCALE");
+    if (pszScale != nullptr)
+    {
+        const CPLStringList aosTokens(CSLTokenizeString2(pszScale, ",", 0));
+        if (aosTokens.size() != 4)
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg,
+                     "Invalid value for SCALE warping option: %s. Expected "
+                     "src_min,src_max,dst_min,dst_max",
+                     pszScale);
+            return false;
+        }
+        const double dfSrcMin = CPLAtof(aosTokens[0]);
+        const double dfSrcMax = CPLAtof(aosTokens[1]);
+        const double dfDstMin = CPLAtof(aosTokens[2]);
+        const double dfDstMax = CPLAtof(aosTokens[3]);
+        oTransform.bScale = true;
+        oTransform.dfScale = dfSrcMax == dfSrcMin ? 0.0
+                                                  : (dfDstMax - dfDstMin) /
+                                                        (dfSrcMax - dfSrcMin);
+        oTransform.dfOffset = dfDstMin - dfSrcMin * oTransform.dfScale;
+        oTransform.dfMin = std::min(dfDstMin, dfDstMax);
+        oTransform.dfMax = std::max(dfDstMin, dfDstMax);
+    }
+
+    const char *pszLUT =
+        CSLFetchNameValue(papszWarpOptions, CPLSPrintf("LUT_%d", iBand + 1));
+    if (pszLUT == nullptr)
+        pszLUT = CSLFetchNameValue(papszWarpOptions, "LUT");
+    if (pszLUT != nullptr)
+    {
+        const CPLStringList aosEntries(CSLTokenizeString2(pszLUT, ",", 0));
+        for (int i = 0; i < aosEntries.size(); ++i)
+        {
+            const CPLStringList aosPair(
+                CSLTokenizeString2(aosEntries[i], ":", 0));
+            if (aosPair.size() != 2 ||
+                (!oTransform.adfLUTInputs.empty() &&
+                 !(CPLAtof(aosPair[0]) > oTransform.adfLUTInputs.back())))
+            {
+                CPLError(CE_Failure, CPLE_IllegalArg,
+                         "Invalid value for LUT warping option: %s. Expected "
+                         "src1:dst1,src2:dst2,... with increasing srcN",
+                         pszLUT);
+                return false;
+            }
+            oTransform.adfLUTInputs.push_back(CPLAtof(aosPair[0]));
+            oTransform.adfLUTOutputs.push_back(CPLAtof(aosPair[1]));
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                   GDALWarpApplyValueTransforms()                     */
+/************************************************************************/
+
+// Apply the SCALE and LUT warp options to the source buffers of the kernel.
+// This is done once the validity masks have been computed from the original
+// values, so that the kernel resamples the transformed values and the
+// destination receives them directly, in its own value range.
+
+static CPLErr GDALWarpApplyValueTransforms(const GDALWarpOptions *psOptions,
+                                           GDALWarpKernel *poWK)
+{
+    const GDALDataType eDT = psOptions->eWorkingDataType;
+    const int nWordSize = GDALGetDataTypeSizeBytes(eDT);
+    const GPtrDiff_t nPixels =
+        static_cast<GPtrDiff_t>(poWK->nSrcXSize) * poWK->nSrcYSize;
+    for (int iBand = 0; iBand < psOptions->nBandCount; ++iBand)
+    {
+        GDALWarpValueTransform oTransform;
+        if (!GDALWarpGetValueTransform(psOptions->papszWarpOptions, iBand,
+                                       oTransform))
+            return CE_Failure;
+        if (oTransform.IsIdentity())
+            continue;
+
+        GByte *pabyBand = poWK->papabySrcImage[iBand];
+        constexpr int CHUNK_SIZE = 1024;
+        double adfValues[CHUNK_SIZE];
+        for (GPtrDiff_t i = 0; i < nPixels; i += CHUNK_SIZE)
+        {
+            const int nCount =
+                static_cast<int>(std::min<GPtrDiff_t>(CHUNK_SIZE, nPixels - i));
+            GDALCopyWords(pabyBand + i * nWordSize, eDT, nWordSize, adfValues,
+                          GDT_Float64, sizeof(double), nCount);
+            for (int j = 0; j < nCount; ++j)
+                adfValues[j] = oTransform.Apply(adfValues[j]);
+            GDALCopyWords(adfValues, GDT_Float64, sizeof(double),
+                          pabyBand + i * nWordSize, eDT, nWordSize, nCount);
+        }
+    }
+    return CE_None;
+}
+
 /************************************************************************/
 /*                          ValidateOptions()                           */
 /************************************************************************/
@@ -456,6 +929,23 @@ int GDALWarpOperation::ValidateOptions()
         return FALSE;
     }
 
+    for (int iBand = 0; iBand < psOptions->nBandCount; iBand++)
+    {
+        GDALWarpValueTransform oTransform;
+        if (!GDALWarpGetValueTransform(psOptions->papszWarpOptions, iBand,
+                                       oTransform))
+            return FALSE;
+        if (!oTransform.IsIdentity() &&
+            GDALDataTypeIsComplex(psOptions->eWorkingDataType))
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "GDALWarpOptions.Validate(): "
+                     "SCALE and LUT are not supported with a complex "
+                     "working data type");
+            return FALSE;
+        }
+    }
+
     return TRUE;
 }
 
@@ -558,6 +1048,14 @@ CPLErr GDALWarpOperation::Initialize(const GDALWarpOptions *psNewOptions)
     bReportTimings =
         CPLFetchBool(psOptions->papszWarpOptions, "REPORT_TIMINGS", false);
 
+    const char *pszProfilingReport =
+        CSLFetchNameValue(psOptions->papszWarpOptions, "PROFILING_REPORT");
+    if (pszProfilingReport != nullptr && pszProfilingReport[0] != '\0')
+    {
+        GetWarpPrivateData(this)->poProfiler =
+            std::make_shared<GDALWarpProfiler>(pszProfilingReport, psOptions);
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Support creating cutline from text warpoption.                  */
     /* -------------------------------------------------------------------- */
@@ -620,12 +1118,6 @@ CPLErr GDALWarpOperation::Initialize(const GDALWarpOptions *psNewOptions)
     }
     else
     {
-        psThreadData = GWKThreadsCreate(psOptions->papszWarpOptions,
-                                        psOptions->pfnTransformer,
-                                        psOptions->pTransformerArg);
-        if (psThreadData == nullptr)
-            eErr = CE_Failure;
-
         /* --------------------------------------------------------------------
          */
         /*      Compute dstcoordinates of a few special points. */
@@ -659,11 +1151,96 @@ CPLErr GDALWarpOperation::Initialize(const GDALWarpOptions *psNewOptions)
             CPLDebug("WARP",
                      "Using translation-on-pixel-boundaries optimization");
         }
+        else if (CPLFetchBool(psOptions->papszWarpOptions, "TRANSFORM_GRID",
+                              false))
+        {
+            SetupTransformGrid();
+        }
+
+        psThreadData = GWKThreadsCreate(psOptions->papszWarpOptions,
+                                        psOptions->pfnTransformer,
+                                        psOptions->pTransformerArg);
+        if (psThreadData == nullptr)
+            eErr = CE_Failure;
     }
 
     return eErr;
 }
 
+/************************************************************************/
+/*                        SetupTransformGrid()                          */
+/************************************************************************/
+
+// Replace the transformer of the options by a transform grid transformer
+// over the destination raster, taking the grid from the cache when the same
+// transformer has already been used.
+
+void GDALWarpOperation::SetupTransformGrid()
+{
+    if (psOptions->hDstDS == nullptr || psOptions->pTransformerArg == nullptr ||
+        psOptions->pfnTransformer == GDALTransformGridTransform)
+        return;
+
+    const int nDstXSize = GDALGetRasterXSize(psOptions->hDstDS);
+    const int nDstYSize = GDALGetRasterYSize(psOptions->hDstDS);
+    const int nStep = atoi(CSLFetchNameValueDef(psOptions->papszWarpOptions,
+                                                "TRANSFORM_GRID_STEP", "16"));
+    const double dfMaxError = CPLAtof(CSLFetchNameValueDef(
+        psOptions->papszWarpOptions, "TRANSFORM_GRID_MAX_ERROR", "0.125"));
+
+    std::string osKey;
+    {
+        CPLErrorStateBackuper oErrorStateBackuper;
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        CPLXMLNode *psTree = GDALSerializeTransformer(
+            psOptions->pfnTransformer, psOptions->pTransformerArg);
+        if (psTree)
+        {
+            char *pszXML = CPLSerializeXMLTree(psTree);
+            osKey = pszXML;
+            CPLFree(pszXML);
+            CPLDestroyXMLNode(psTree);
+            osKey += CPLSPrintf("|%d|%d|%d|%.18g", nDstXSize, nDstYSize, nStep,
+                                dfMaxError);
+        }
+    }
+
+    std::shared_ptr<const GDALTransformGrid> poGrid;
+    if (!osKey.empty())
+    {
+        std::lock_guard<std::mutex> oLock(gTransformGridCacheMutex);
+        GetTransformGridCache().tryGet(osKey, poGrid);
+    }
+    const auto &poProfiler = GetWarpPrivateData(this)->poProfiler;
+    if (poGrid)
+    {
+        CPLDebug("WARP", "Reusing cached transform grid");
+        if (poProfiler)
+            poProfiler->SetTransformGrid("cached");
+    }
+    else
+    {
+        poGrid = GDALBuildTransformGrid(psOptions->pfnTransformer,
+                                        psOptions->pTransformerArg, nDstXSize,
+                                        nDstYSize, nStep, dfMaxError);
+        if (poGrid == nullptr)
+            return;
+        if (poProfiler)
+            poProfiler->SetTransformGrid("computed");
+        if (!osKey.empty())
+        {
+            std::lock_guard<std::mutex> oLock(gTransformGridCacheMutex);
+            GetTransformGridCache().insert(osKey, poGrid);
+        }
+    }
+
+    void *pTransformGridArg = GDALCreateTransformGridTransformerFromGrid(
+        psOptions->pfnTransformer, psOptions->pTransformerArg, poGrid);
+    GetWarpPrivateData(this)->pTransformGridArg = pTransformGridArg;
+    psOptions->pfnTransformer = GDALTransformGridTransform;
+    psOptions->pTransformerArg = pTransformGridArg;
+}
+
 /**
  * \fn void* GDALWarpOperation::CreateDestinationBuffer(
             int nDstXSize, int nDstYSize, int *pbInitialized);
@@ -854,7 +1431,11 @@ void GDALWarpOperation::CollectChunkList(int nDstXOff, int nDstYOff,
     /*      Collect the list of chunks to operate on.                       */
     /* -------------------------------------------------------------------- */
     WipeChunkList();
+    const auto oStart = std::chrono::steady_clock::now();
     CollectChunkListInternal(nDstXOff, nDstYOff, nDstXSize, nDstYSize);
+    const auto &poProfiler = GetWarpPrivateData(this)->poProfiler;
+    if (poProfiler)
+        poProfiler->AddChunkListTime(GetElapsedSince(oStart));
 
     // Sort chunks from top to bottom, and for equal y, from left to right.
     // TODO(schwehr): Use std::sort.
@@ -863,41 +1444,27 @@ void GDALWarpOperation::CollectChunkList(int nDstXOff, int nDstYOff,
               OrderWarpChunk);
 
     /* -------------------------------------------------------------------- */
-    /*      Find the global source window.                                  */
+    /*      Advise the source dataset of the windows that will be read,    */
+    /*      in the order of the chunks.                                     */
     /* -------------------------------------------------------------------- */
-
-    const int knIntMax = std::numeric_limits<int>::max();
-    const int knIntMin = std::numeric_limits<int>::min();
-    int nSrcXOff = knIntMax;
-    int nSrcYOff = knIntMax;
-    int nSrcX2Off = knIntMin;
-    int nSrcY2Off = knIntMin;
-    double dfApproxAccArea = 0;
+    std::vector<GDALRasterWindow> asWindows;
     for (int iChunk = 0; pasChunkList != nullptr && iChunk < nChunkListCount;
          iChunk++)
     {
-        GDALWarpChunk *pasThisChunk = pasChunkList + iChunk;
-        nSrcXOff = std::min(nSrcXOff, pasThisChunk->sx);
-        nSrcYOff = std::min(nSrcYOff, pasThisChunk->sy);
-        nSrcX2Off = std::max(nSrcX2Off, pasThisChunk->sx + pasThisChunk->ssx);
-        nSrcY2Off = std::max(nSrcY2Off, pasThisChunk->sy + pasThisChunk->ssy);
-        dfApproxAccArea +=
-            static_cast<double>(pasThisChunk->ssx) * pasThisChunk->ssy;
-    }
-    if (nSrcXOff < nSrcX2Off)
-    {
-        const double dfTotalArea =
-            static_cast<double>(nSrcX2Off - nSrcXOff) * (nSrcY2Off - nSrcYOff);
-        // This is really a gross heuristics, but should work in most cases
-        if (dfApproxAccArea >= dfTotalArea * 0.80)
-        {
-            GDALDataset::FromHandle(psOptions->hSrcDS)
-                ->AdviseRead(nSrcXOff, nSrcYOff, nSrcX2Off - nSrcXOff,
-                             nSrcY2Off - nSrcYOff, nDstXSize, nDstYSize,
-                             psOptions->eWorkingDataType, psOptions->nBandCount,
-                             psOptions->panSrcBands, nullptr);
+        const GDALWarpChunk *pasThisChunk = pasChunkList + iChunk;
+        if (pasThisChunk->ssx > 0 && pasThisChunk->ssy > 0)
+        {
+            asWindows.push_back({pasThisChunk->sx, pasThisChunk->sy,
+                                 pasThisChunk->ssx, pasThisChunk->ssy});
         }
     }
+    if (!asWindows.empty())
+    {
+        GDALDataset::FromHandle(psOptions->hSrcDS)
+            ->AdviseReadPlan(static_cast<int>(asWindows.size()),
+                             asWindows.data(), psOptions->nBandCount,
+                             psOptions->panSrcBands, nullptr);
+    }
 }
 
 /************************************************************************/
@@ -1065,6 +1632,409 @@ static void ChunkThreadMain(void *pThreadData)
     }
 }
 
+/************************************************************************/
+/*                        GDALWarpChunkScheduler                        */
+/************************************************************************/
+
+// Shared state of the worker threads of ChunkAndWarpMulti() when several
+// chunks are read, warped and written concurrently (NUM_CHUNK_THREADS).
+// Access to the source and destination datasets remains serialized by the
+// IO mutex, but any number of chunks may be in their warping stage at the
+// same time, as long as their total memory use fits in the budget.
+
+struct GDALWarpChunkScheduler
+{
+    std::mutex oMutex{};
+    std::condition_variable oCV{};
+
+    CPLMutex *hIOMutex = nullptr;
+    const GDALWarpChunk *pasChunkList = nullptr;
+    int nChunkCount = 0;
+
+    // Chunks are started in order, as long as the memory of the chunks
+    // being processed fits in dfMemoryBudget.
+    int iNextChunk = 0;
+    int nChunksInFlight = 0;
+    double dfMemoryBudget = 0;
+    double dfMemoryInFlight = 0;
+
+    // When bOrderedWrites is set, a chunk is only written once all the
+    // chunks before it are done.
+    bool bOrderedWrites = false;
+    std::vector<bool> abChunkDone{};
+    int iFirstChunkNotDone = 0;
+
+    bool bStop = false;
+    CPLErr eErr = CE_None;
+
+    std::mutex oProgressMutex{};
+    GDALProgressFunc pfnProgress = nullptr;
+    void *pProgressArg = nullptr;
+    double dfTotalPixels = 0;
+    double dfProgressDone = 0;
+    double dfProgressRunning = 0;
+    double dfLastProgress = 0;
+
+    int AcquireChunk();
+    void ReleaseChunk(GDALWarpChunkWorker *psWorker, CPLErr eChunkErr);
+};
+
+struct GDALWarpChunkWorker
+{
+    GDALWarpChunkScheduler *psScheduler = nullptr;
+    GDALWarpOperation *poOperation = nullptr;
+    void *pTransformerArg = nullptr;
+    CPLJoinableThread *hThreadHandle = nullptr;
+
+    int iChunk = -1;
+    double dfChunkProgress = 0;
+};
+
+/************************************************************************/
+/*                 GDALWarpChunkScheduler::AcquireChunk()               */
+/************************************************************************/
+
+// Returns the index of the next chunk to process, or -1 when there are no
+// more chunks or processing must stop.
+
+int GDALWarpChunkScheduler::AcquireChunk()
+{
+    std::unique_lock<std::mutex> oLock(oMutex);
+    while (true)
+    {
+        if (bStop || iNextChunk >= nChunkCount)
+            return -1;
+        const double dfMemoryUse = pasChunkList[iNextChunk].dfMemoryUse;
+        if (nChunksInFlight == 0 ||
+            dfMemoryInFlight + dfMemoryUse <= dfMemoryBudget)
+        {
+            ++nChunksInFlight;
+            dfMemoryInFlight += dfMemoryUse;
+            return iNextChunk++;
+        }
+        oCV.wait(oLock);
+    }
+}
+
+/************************************************************************/
+/*                 GDALWarpChunkScheduler::ReleaseChunk()               */
+/************************************************************************/
+
+void GDALWarpChunkScheduler::ReleaseChunk(GDALWarpChunkWorker *psWorker,
+                                          CPLErr eChunkErr)
+{
+    const GDALWarpChunk *psChunk = pasChunkList + psWorker->iChunk;
+    {
+        std::lock_guard<std::mutex> oLock(oProgressMutex);
+        dfProgressRunning -= psWorker->dfChunkProgress;
+        dfProgressDone += psChunk->dsx * static_cast<double>(psChunk->dsy) /
+                          dfTotalPixels;
+        psWorker->dfChunkProgress = 0;
+    }
+
+    std::lock_guard<std::mutex> oLock(oMutex);
+    --nChunksInFlight;
+    dfMemoryInFlight -= psChunk->dfMemoryUse;
+    abChunkDone[psWorker->iChunk] = true;
+    while (iFirstChunkNotDone < nChunkCount &&
+           abChunkDone[iFirstChunkNotDone])
+        ++iFirstChunkNotDone;
+    if (eChunkErr != CE_None && eErr == CE_None)
+    {
+        eErr = eChunkErr;
+        bStop = true;
+    }
+    psWorker->iChunk = -1;
+    oCV.notify_all();
+}
+
+/************************************************************************/
+/*                       WaitForChunkWriteTurn()                        */
+/************************************************************************/
+
+// Called with the IO mutex held before writing a chunk. With ordered writes,
+// releases the IO mutex until all the previous chunks have been written.
+// Returns false if processing has been stopped in the meantime.
+
+static bool WaitForChunkWriteTurn(GDALWarpChunkWorker *psWorker)
+{
+    GDALWarpChunkScheduler *psScheduler = psWorker->psScheduler;
+    if (!psScheduler->bOrderedWrites)
+        return true;
+
+    {
+        std::lock_guard<std::mutex> oLock(psScheduler->oMutex);
+        if (psScheduler->iFirstChunkNotDone == psWorker->iChunk)
+            return true;
+    }
+
+    CPLReleaseMutex(psScheduler->hIOMutex);
+    bool bRet;
+    {
+        std::unique_lock<std::mutex> oLock(psScheduler->oMutex);
+        psScheduler->oCV.wait(
+            oLock,
+            [psScheduler, psWorker]
+            {
+                return psScheduler->bStop ||
+                       psScheduler->iFirstChunkNotDone == psWorker->iChunk;
+            });
+        bRet = !psScheduler->bStop;
+    }
+    if (!CPLAcquireMutex(psScheduler->hIOMutex, 600.0))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Failed to acquire IOMutex in WarpRegion().");
+        return false;
+    }
+    return bRet;
+}
+
+/************************************************************************/
+/*                      GDALWarpChunkWorkerProgress()                   */
+/************************************************************************/
+
+// Progress callback of the per-thread warp operations. Each chunk is warped
+// with a progress range of [0, chunk pixels / total pixels], and the sum of
+// the progress of all chunks is forwarded to the user callback.
+
+static int CPL_STDCALL GDALWarpChunkWorkerProgress(double dfComplete,
+                                                   const char *pszMessage,
+                                                   void *pProgressArg)
+{
+    GDALWarpChunkWorker *psWorker =
+        static_cast<GDALWarpChunkWorker *>(pProgressArg);
+    GDALWarpChunkScheduler *psScheduler = psWorker->psScheduler;
+
+    std::lock_guard<std::mutex> oLock(psScheduler->oProgressMutex);
+    psScheduler->dfProgressRunning += dfComplete - psWorker->dfChunkProgress;
+    psWorker->dfChunkProgress = dfComplete;
+    const double dfProgress =
+        std::min(1.0, psScheduler->dfProgressDone +
+                          psScheduler->dfProgressRunning);
+    psScheduler->dfLastProgress =
+        std::max(psScheduler->dfLastProgress, dfProgress);
+    return psScheduler->pfnProgress(psScheduler->dfLastProgress, pszMessage,
+                                    psScheduler->pProgressArg);
+}
+
+/************************************************************************/
+/*                        ChunkWorkerThreadMain()                       */
+/************************************************************************/
+
+static void ChunkWorkerThreadMain(void *pThreadData)
+
+{
+    GDALWarpChunkWorker *psWorker =
+        static_cast<GDALWarpChunkWorker *>(pThreadData);
+    GDALWarpChunkScheduler *psScheduler = psWorker->psScheduler;
+
+    while (true)
+    {
+        const int iChunk = psScheduler->AcquireChunk();
+        if (iChunk < 0)
+            break;
+
+        const GDALWarpChunk *psChunk = psScheduler->pasChunkList + iChunk;
+        psWorker->iChunk = iChunk;
+
+        CPLErr eErr = CE_None;
+        if (!CPLAcquireMutex(psScheduler->hIOMutex, 600.0))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Failed to acquire IOMutex in WarpRegion().");
+            eErr = CE_Failure;
+        }
+        else
+        {
+            eErr = psWorker->poOperation->WarpRegion(
+                psChunk->dx, psChunk->dy, psChunk->dsx, psChunk->dsy,
+                psChunk->sx, psChunk->sy, psChunk->ssx, psChunk->ssy,
+                psChunk->sExtraSx, psChunk->sExtraSy, 0.0,
+                psChunk->dsx * static_cast<double>(psChunk->dsy) /
+                    psScheduler->dfTotalPixels);
+            CPLReleaseMutex(psScheduler->hIOMutex);
+        }
+
+        CPLDebug("WARP", "Finished chunk %d / %d.", iChunk,
+                 psScheduler->nChunkCount);
+        psScheduler->ReleaseChunk(psWorker, eErr);
+    }
+}
+
+/************************************************************************/
+/*                   MultiChunkNeedsOrderedWrites()                     */
+/************************************************************************/
+
+// Whether chunks must be written to the destination dataset in the order of
+// the chunk list (top to bottom, then left to right).
+
+static bool MultiChunkNeedsOrderedWrites(const GDALWarpOptions *psOptions)
+{
+    if (CPLFetchBool(psOptions->papszWarpOptions, "STREAMABLE_OUTPUT", false))
+        return true;
+
+    GDALDataset *poDstDS = GDALDataset::FromHandle(psOptions->hDstDS);
+    if (poDstDS == nullptr)
+        return false;
+
+    // Drivers without Create() support only write sequentially.
+    GDALDriver *poDriver = poDstDS->GetDriver();
+    if (poDriver == nullptr ||
+        poDriver->GetMetadataItem(GDAL_DCAP_CREATE) == nullptr)
+        return true;
+
+    // For compressed outputs, the order in which blocks are written
+    // determines their order in the file.
+    return poDstDS->GetMetadataItem("COMPRESSION", "IMAGE_STRUCTURE") !=
+           nullptr;
+}
+
+/************************************************************************/
+/*                     ChunkAndWarpMultiParallel()                      */
+/************************************************************************/
+
+// Implementation of ChunkAndWarpMulti() when NUM_CHUNK_THREADS > 1. Returns
+// false, without doing anything, if it cannot be used, in which case eErr
+// is not set.
+
+bool GDALWarpOperation::ChunkAndWarpMultiParallel(int nDstXOff, int nDstYOff,
+                                                  int nDstXSize, int nDstYSize,
+                                                  int nChunkThreads,
+                                                  CPLErr &eErr)
+{
+    /* -------------------------------------------------------------------- */
+    /*      Create one warp operation per thread, each with its own         */
+    /*      transformer, so that chunks can be warped concurrently.         */
+    /* -------------------------------------------------------------------- */
+    GDALWarpChunkScheduler sScheduler;
+    std::vector<GDALWarpChunkWorker> asWorkers(nChunkThreads);
+
+    const auto DestroyWorkers = [&asWorkers]()
+    {
+        for (auto &sWorker : asWorkers)
+        {
+            if (sWorker.poOperation)
+            {
+                // The IO mutex belongs to this operation.
+                sWorker.poOperation->hIOMutex = nullptr;
+                delete sWorker.poOperation;
+            }
+            if (sWorker.pTransformerArg)
+                GDALDestroyTransformer(sWorker.pTransformerArg);
+        }
+    };
+
+    for (auto &sWorker : asWorkers)
+    {
+        sWorker.psScheduler = &sScheduler;
+        sWorker.pTransformerArg =
+            GDALCloneTransformer(psOptions->pTransformerArg);
+        if (sWorker.pTransformerArg == nullptr)
+        {
+            CPLDebug("WARP", "Transformer cannot be cloned. "
+                             "Ignoring NUM_CHUNK_THREADS");
+            DestroyWorkers();
+            return false;
+        }
+
+        GDALWarpOptions *psWorkerOptions = GDALCloneWarpOptions(psOptions);
+        psWorkerOptions->pTransformerArg = sWorker.pTransformerArg;
+        if (psOptions->pfnProgress != GDALDummyProgress)
+        {
+            psWorkerOptions->pfnProgress = GDALWarpChunkWorkerProgress;
+            psWorkerOptions->pProgressArg = &sWorker;
+        }
+        sWorker.poOperation = new GDALWarpOperation();
+        const CPLErr eInitErr =
+            sWorker.poOperation->Initialize(psWorkerOptions);
+        GDALDestroyWarpOptions(psWorkerOptions);
+        if (eInitErr != CE_None)
+        {
+            DestroyWorkers();
+            return false;
+        }
+    }
+
+    if (hIOMutex == nullptr)
+    {
+        hIOMutex = CPLCreateMutex();
+        hWarpMutex = CPLCreateMutex();
+
+        CPLReleaseMutex(hIOMutex);
+        CPLReleaseMutex(hWarpMutex);
+    }
+
+    const auto &poProfiler = GetWarpPrivateData(this)->poProfiler;
+    const auto &poCutlineIndex = GetCutlineIndex(this);
+    for (auto &sWorker : asWorkers)
+    {
+        sWorker.poOperation->hIOMutex = hIOMutex;
+        sWorker.poOperation->m_psChunkWorker = &sWorker;
+        auto psWorkerPrivateData = GetWarpPrivateData(sWorker.poOperation);
+        if (poProfiler)
+            psWorkerPrivateData->poProfiler = poProfiler;
+        psWorkerPrivateData->poCutlineIndex = poCutlineIndex;
+        psWorkerPrivateData->bCutlineIndexCreated = true;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Collect the list of chunks to operate on. The memory limit      */
+    /*      is shared by all the chunks being processed at the same time.   */
+    /* -------------------------------------------------------------------- */
+    m_dfChunkMemoryLimit = psOptions->dfWarpMemoryLimit / nChunkThreads;
+    CollectChunkList(nDstXOff, nDstYOff, nDstXSize, nDstYSize);
+    m_dfChunkMemoryLimit = 0;
+
+    sScheduler.hIOMutex = hIOMutex;
+    sScheduler.pasChunkList = pasChunkList;
+    sScheduler.nChunkCount = nChunkListCount;
+    sScheduler.dfMemoryBudget = psOptions->dfWarpMemoryLimit;
+    sScheduler.bOrderedWrites = MultiChunkNeedsOrderedWrites(psOptions);
+    sScheduler.abChunkDone.resize(nChunkListCount);
+    sScheduler.pfnProgress = psOptions->pfnProgress;
+    sScheduler.pProgressArg = psOptions->pProgressArg;
+    sScheduler.dfTotalPixels = static_cast<double>(nDstXSize) * nDstYSize;
+
+    CPLDebug("WARP", "Processing %d chunks with %d threads, %s writes",
+             nChunkListCount, nChunkThreads,
+             sScheduler.bOrderedWrites ? "ordered" : "unordered");
+
+    /* -------------------------------------------------------------------- */
+    /*      Launch the worker threads and wait for them to complete.        */
+    /* -------------------------------------------------------------------- */
+    for (auto &sWorker : asWorkers)
+    {
+        sWorker.hThreadHandle =
+            CPLCreateJoinableThread(ChunkWorkerThreadMain, &sWorker);
+        if (sWorker.hThreadHandle == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "CPLCreateJoinableThread() failed in ChunkAndWarpMulti()");
+            std::lock_guard<std::mutex> oLock(sScheduler.oMutex);
+            sScheduler.eErr = CE_Failure;
+            sScheduler.bStop = true;
+            sScheduler.oCV.notify_all();
+            break;
+        }
+    }
+
+    for (auto &sWorker : asWorkers)
+    {
+        if (sWorker.hThreadHandle)
+            CPLJoinThread(sWorker.hThreadHandle);
+    }
+
+    DestroyWorkers();
+    WipeChunkList();
+
+    psOptions->pfnProgress(1.0, "", psOptions->pProgressArg);
+
+    eErr = sScheduler.eErr;
+
+    return true;
+}
+
 /************************************************************************/
 /*                         ChunkAndWarpMulti()                          */
 /************************************************************************/
@@ -1081,6 +2051,12 @@ static void ChunkThreadMain(void *pThreadData)
  * internally this method uses multiple threads to interleave input/output
  * for one region while the processing is being done for another.
  *
+ * If the NUM_CHUNK_THREADS warp option is set to a value greater than 1 (or
+ * ALL_CPUS), that many threads each process whole chunks, so that several
+ * chunks can be warped at the same time while another one is being read or
+ * written. The memory limit is then shared by all the chunks being
+ * processed. This requires a transformer that can be cloned.
+ *
  * @param nDstXOff X offset to window of destination data to be produced.
  * @param nDstYOff Y offset to window of destination data to be produced.
  * @param nDstXSize Width of output window on destination file to be produced.
@@ -1093,6 +2069,26 @@ CPLErr GDALWarpOperation::ChunkAndWarpMulti(int nDstXOff, int nDstYOff,
                                             int nDstXSize, int nDstYSize)
 
 {
+    const char *pszChunkThreads =
+        CSLFetchNameValue(psOptions->papszWarpOptions, "NUM_CHUNK_THREADS");
+    if (pszChunkThreads != nullptr &&
+        psOptions->pfnPreWarpChunkProcessor == nullptr &&
+        psOptions->pfnPostWarpChunkProcessor == nullptr &&
+        psOptions->pTransformerArg != nullptr)
+    {
+        int nChunkThreads = EQUAL(pszChunkThreads, "ALL_CPUS")
+                                ? CPLGetNumCPUs()
+                                : atoi(pszChunkThreads);
+        nChunkThreads = std::min(nChunkThreads, 128);
+        CPLErr eErr = CE_None;
+        if (nChunkThreads > 1 &&
+            ChunkAndWarpMultiParallel(nDstXOff, nDstYOff, nDstXSize,
+                                      nDstYSize, nChunkThreads, eErr))
+        {
+            return eErr;
+        }
+    }
+
     hIOMutex = CPLCreateMutex();
     hWarpMutex = CPLCreateMutex();
 
@@ -1258,6 +2254,69 @@ void GDALWarpOperation::WipeChunkList()
     nChunkListMax = 0;
 }
 
+/************************************************************************/
+/*                        IsSourceWindowEmpty()                         */
+/************************************************************************/
+
+// Returns whether the source window of poBand is reported as empty by
+// GetDataCoverageStatus(), like the missing tiles of a sparse GeoTIFF file
+// or the areas of a VRT not covered by any source, and that the value of the
+// pixels of such areas is dfExpectedValue.
+
+static bool IsBandWindowEmpty(GDALRasterBand *poBand, double dfExpectedValue,
+                              int nSrcXOff, int nSrcYOff, int nSrcXSize,
+                              int nSrcYSize)
+{
+    double dfEmptyBlockValue = 0;
+    if (poBand == nullptr ||
+        !GDALGetEmptyBlockValue(poBand, &dfEmptyBlockValue))
+        return false;
+    if (!(dfEmptyBlockValue == dfExpectedValue ||
+          (CPLIsNan(dfEmptyBlockValue) && CPLIsNan(dfExpectedValue))))
+        return false;
+    return poBand->GetDataCoverageStatus(
+               nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize,
+               GDAL_DATA_COVERAGE_STATUS_DATA,
+               nullptr) == GDAL_DATA_COVERAGE_STATUS_EMPTY;
+}
+
+/************************************************************************/
+/*                        IsSourceWindowEmpty()                         */
+/************************************************************************/
+
+// Returns whether all the pixels of the source window are invalid, either
+// because the source alpha band is empty (fully transparent) there, or
+// because all the source bands are empty and the value of their empty areas
+// is the source nodata value.
+
+static bool IsSourceWindowEmpty(const GDALWarpOptions *psOptions,
+                                int nSrcXOff, int nSrcYOff, int nSrcXSize,
+                                int nSrcYSize)
+{
+    if (psOptions->hSrcDS == nullptr || psOptions->nBandCount == 0)
+        return false;
+
+    if (psOptions->nSrcAlphaBand > 0 &&
+        IsBandWindowEmpty(GDALRasterBand::FromHandle(GDALGetRasterBand(
+                              psOptions->hSrcDS, psOptions->nSrcAlphaBand)),
+                          0.0, nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize))
+        return true;
+
+    if (psOptions->padfSrcNoDataReal == nullptr)
+        return false;
+
+    for (int i = 0; i < psOptions->nBandCount; ++i)
+    {
+        if (!IsBandWindowEmpty(
+                GDALRasterBand::FromHandle(GDALGetRasterBand(
+                    psOptions->hSrcDS, psOptions->panSrcBands[i])),
+                psOptions->padfSrcNoDataReal[i], nSrcXOff, nSrcYOff,
+                nSrcXSize, nSrcYSize))
+            return false;
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                       CollectChunkListInternal()                     */
 /************************************************************************/
@@ -1293,10 +2352,12 @@ CPLErr GDALWarpOperation::CollectChunkListInternal(int nDstXOff, int nDstYOff,
 
     /* -------------------------------------------------------------------- */
     /*      If we are allowed to drop no-source regions, do so now if       */
-    /*      appropriate.                                                    */
+    /*      appropriate, including regions whose source has no data.        */
     /* -------------------------------------------------------------------- */
-    if ((nSrcXSize == 0 || nSrcYSize == 0) &&
-        CPLFetchBool(psOptions->papszWarpOptions, "SKIP_NOSOURCE", false))
+    if (CPLFetchBool(psOptions->papszWarpOptions, "SKIP_NOSOURCE", false) &&
+        (nSrcXSize == 0 || nSrcYSize == 0 ||
+         IsSourceWindowEmpty(psOptions, nSrcXOff, nSrcYOff, nSrcXSize,
+                             nSrcYSize)))
         return CE_None;
 
     /* -------------------------------------------------------------------- */
@@ -1375,7 +2436,10 @@ CPLErr GDALWarpOperation::CollectChunkListInternal(int nDstXOff, int nDstYOff,
              nSrcXSize, nSrcYSize, dfSrcFillRatio,
              dfTotalMemoryUse / (1024 * 1024));
 #endif
-    if ((dfTotalMemoryUse > psOptions->dfWarpMemoryLimit &&
+    const double dfMemoryLimit = m_dfChunkMemoryLimit > 0
+                                     ? m_dfChunkMemoryLimit
+                                     : psOptions->dfWarpMemoryLimit;
+    if ((dfTotalMemoryUse > dfMemoryLimit &&
          (nDstXSize > 2 || nDstYSize > 2)) ||
         (dfSrcFillRatio > 0 && dfSrcFillRatio < 0.5 &&
          (nDstXSize > 100 || nDstYSize > 100) &&
@@ -1482,6 +2546,7 @@ CPLErr GDALWarpOperation::CollectChunkListInternal(int nDstXOff, int nDstYOff,
     pasChunkList[nChunkListCount].ssy = nSrcYSize;
     pasChunkList[nChunkListCount].sExtraSx = dfSrcXExtraSize;
     pasChunkList[nChunkListCount].sExtraSy = dfSrcYExtraSize;
+    pasChunkList[nChunkListCount].dfMemoryUse = dfTotalMemoryUse;
 
     nChunkListCount++;
 
@@ -1573,6 +2638,27 @@ CPLErr GDALWarpOperation::WarpRegion(
 {
     ReportTiming(nullptr);
 
+    CPLTraceSpan oTraceSpan("warp", "WarpRegion");
+    if (oTraceSpan.IsActive())
+    {
+        oTraceSpan.AddAttribute("dst_xoff", nDstXOff);
+        oTraceSpan.AddAttribute("dst_yoff", nDstYOff);
+        oTraceSpan.AddAttribute("dst_xsize", nDstXSize);
+        oTraceSpan.AddAttribute("dst_ysize", nDstYSize);
+        oTraceSpan.AddAttribute("src_xsize", nSrcXSize);
+        oTraceSpan.AddAttribute("src_ysize", nSrcYSize);
+        oTraceSpan.AddAttribute("resampling",
+                                static_cast<int>(psOptions->eResampleAlg));
+    }
+
+    const auto poProfiler = GetWarpPrivateData(this)->poProfiler;
+    GDALWarpChunkProfile sProfile;
+    sProfile.anDstWindow[0] = nDstXOff;
+    sProfile.anDstWindow[1] = nDstYOff;
+    sProfile.anDstWindow[2] = nDstXSize;
+    sProfile.anDstWindow[3] = nDstYSize;
+    auto oStart = std::chrono::steady_clock::now();
+
     /* -------------------------------------------------------------------- */
     /*      Allocate the output buffer.                                     */
     /* -------------------------------------------------------------------- */
@@ -1618,18 +2704,27 @@ CPLErr GDALWarpOperation::WarpRegion(
 
         ReportTiming("Output buffer read");
     }
+    sProfile.dfDstReadTime = GetElapsedSince(oStart);
 
     /* -------------------------------------------------------------------- */
     /*      Perform the warp.                                               */
     /* -------------------------------------------------------------------- */
+    if (poProfiler)
+        tlpsCurrentChunkProfile = &sProfile;
     CPLErr eErr = WarpRegionToBuffer(
         nDstXOff, nDstYOff, nDstXSize, nDstYSize, pDstBuffer,
         psOptions->eWorkingDataType, nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize,
         dfSrcXExtraSize, dfSrcYExtraSize, dfProgressBase, dfProgressScale);
+    tlpsCurrentChunkProfile = nullptr;
 
     /* -------------------------------------------------------------------- */
     /*      Write the output data back to disk if all went well.            */
     /* -------------------------------------------------------------------- */
+    if (eErr == CE_None && m_psChunkWorker != nullptr &&
+        !WaitForChunkWriteTurn(m_psChunkWorker))
+        eErr = CE_Failure;
+
+    oStart = std::chrono::steady_clock::now();
     if (eErr == CE_None)
     {
         if (psOptions->nBandCount == 1)
@@ -1663,6 +2758,12 @@ CPLErr GDALWarpOperation::WarpRegion(
         ReportTiming("Output buffer write");
     }
 
+    if (poProfiler)
+    {
+        sProfile.dfDstWriteTime = GetElapsedSince(oStart);
+        poProfiler->AddChunk(sProfile);
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Cleanup and return.                                             */
     /* -------------------------------------------------------------------- */
@@ -1778,6 +2879,27 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
 
     CPLAssert(eBufDataType == psOptions->eWorkingDataType);
 
+    // When called outside of WarpRegion(), the chunk is reported on its own.
+    const auto poProfiler = GetWarpPrivateData(this)->poProfiler;
+    GDALWarpChunkProfile sOwnProfile;
+    GDALWarpChunkProfile *psProfile = nullptr;
+    if (poProfiler)
+    {
+        // Reset so that a nested warp, for example of a warped VRT source,
+        // does not record into the profile of this chunk.
+        psProfile = tlpsCurrentChunkProfile;
+        tlpsCurrentChunkProfile = nullptr;
+        if (psProfile == nullptr)
+        {
+            psProfile = &sOwnProfile;
+            psProfile->anDstWindow[0] = nDstXOff;
+            psProfile->anDstWindow[1] = nDstYOff;
+            psProfile->anDstWindow[2] = nDstXSize;
+            psProfile->anDstWindow[3] = nDstYSize;
+        }
+    }
+    auto oStart = std::chrono::steady_clock::now();
+
     /* -------------------------------------------------------------------- */
     /*      If not given a corresponding source window compute one now.     */
     /* -------------------------------------------------------------------- */
@@ -1807,6 +2929,29 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
                 return CE_None;
             return eErr;
         }
+        if (psProfile)
+            psProfile->dfSourceWindowTime = GetElapsedSince(oStart);
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      If the source window has no valid pixel, as reported by the     */
+    /*      data coverage status of the source bands, there is no need to   */
+    /*      read it: warp from an empty source window, which leaves the     */
+    /*      already initialized destination buffer untouched.               */
+    /* -------------------------------------------------------------------- */
+    if (nSrcXSize > 0 && nSrcYSize > 0 &&
+        IsSourceWindowEmpty(psOptions, nSrcXOff, nSrcYOff, nSrcXSize,
+                            nSrcYSize))
+    {
+        CPLDebug("WARP",
+                 "Source window %d,%d,%d,%d is empty. Skipping its reading",
+                 nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize);
+        nSrcXOff = 0;
+        nSrcYOff = 0;
+        nSrcXSize = 0;
+        nSrcYSize = 0;
+        dfSrcXExtraSize = 0;
+        dfSrcYExtraSize = 0;
     }
 
     /* -------------------------------------------------------------------- */
@@ -1861,8 +3006,8 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
 
     oWK.papabySrcImage = static_cast<GByte **>(
         CPLCalloc(sizeof(GByte *), psOptions->nBandCount));
-    oWK.papabySrcImage[0] =
-        static_cast<GByte *>(VSI_MALLOC_VERBOSE(static_cast<size_t>(nAlloc64)));
+    oWK.papabySrcImage[0] = static_cast<GByte *>(
+        VSI_MALLOC_LARGE_VERBOSE(static_cast<size_t>(nAlloc64)));
 
     CPLErr eErr =
         nSrcXSize != 0 && nSrcYSize != 0 && oWK.papabySrcImage[0] == nullptr
@@ -1877,6 +3022,14 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
                  WARP_EXTRA_ELTS) *
                 i;
 
+    if (psProfile)
+    {
+        psProfile->anSrcWindow[0] = nSrcXOff;
+        psProfile->anSrcWindow[1] = nSrcYOff;
+        psProfile->anSrcWindow[2] = nSrcXSize;
+        psProfile->anSrcWindow[3] = nSrcYSize;
+    }
+    oStart = std::chrono::steady_clock::now();
     if (eErr == CE_None && nSrcXSize > 0 && nSrcYSize > 0)
     {
         GDALDataset *poSrcDS = GDALDataset::FromHandle(psOptions->hSrcDS);
@@ -1903,6 +3056,9 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     }
 
     ReportTiming("Input buffer read");
+    if (psProfile)
+        psProfile->dfSrcReadTime = GetElapsedSince(oStart);
+    oStart = std::chrono::steady_clock::now();
 
     /* -------------------------------------------------------------------- */
     /*      Initialize destination buffer.                                  */
@@ -1984,11 +3140,10 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
 
         int nValidityFlag = 0;
         if (eErr == CE_None)
-            eErr = GDALWarpCutlineMaskerEx(
-                psOptions, psOptions->nBandCount, psOptions->eWorkingDataType,
-                oWK.nSrcXOff, oWK.nSrcYOff, oWK.nSrcXSize, oWK.nSrcYSize,
-                oWK.papabySrcImage, TRUE, oWK.pafUnifiedSrcDensity,
-                &nValidityFlag);
+            eErr = GDALWarpCutlineMaskerWithIndex(
+                psOptions, GetCutlineIndex(this).get(), oWK.nSrcXOff,
+                oWK.nSrcYOff, oWK.nSrcXSize, oWK.nSrcYSize,
+                oWK.pafUnifiedSrcDensity, &nValidityFlag);
         if (nValidityFlag == GCMVF_CHUNK_FULLY_WITHIN_CUTLINE &&
             bUnifiedSrcDensityJustCreated)
         {
@@ -2217,13 +3372,16 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
         }
     }
 
+    if (psProfile)
+        psProfile->dfMaskTime = GetElapsedSince(oStart);
+
     /* -------------------------------------------------------------------- */
     /*      Release IO Mutex, and acquire warper mutex.                     */
     /* -------------------------------------------------------------------- */
     if (hIOMutex != nullptr)
     {
         CPLReleaseMutex(hIOMutex);
-        if (!CPLAcquireMutex(hWarpMutex, 600.0))
+        if (hWarpMutex != nullptr && !CPLAcquireMutex(hWarpMutex, 600.0))
         {
             CPLError(CE_Failure, CPLE_AppDefined,
                      "Failed to acquire WarpMutex in WarpRegion().");
@@ -2231,6 +3389,13 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
         }
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Apply the scaling and lookup tables of the SCALE and LUT        */
+    /*      warping options to the source values.                           */
+    /* -------------------------------------------------------------------- */
+    if (eErr == CE_None && nSrcXSize > 0 && nSrcYSize > 0)
+        eErr = GDALWarpApplyValueTransforms(psOptions, &oWK);
+
     /* -------------------------------------------------------------------- */
     /*      Optional application provided prewarp chunk processor.          */
     /* -------------------------------------------------------------------- */
@@ -2243,8 +3408,20 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     /* -------------------------------------------------------------------- */
     if (eErr == CE_None)
     {
+        oStart = std::chrono::steady_clock::now();
         eErr = oWK.PerformWarp();
         ReportTiming("In memory warp operation");
+        if (psProfile)
+        {
+            psProfile->dfKernelTime = GetElapsedSince(oStart);
+            const char *pszKernel = nullptr;
+            if (GWKThreadsFetchLastRunInfo(psThreadData, &pszKernel,
+                                           &psProfile->nKernelThreads,
+                                           &psProfile->dfKernelBusyTime))
+            {
+                psProfile->osKernel = pszKernel;
+            }
+        }
     }
 
     /* -------------------------------------------------------------------- */
@@ -2259,7 +3436,8 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     /* -------------------------------------------------------------------- */
     if (hIOMutex != nullptr)
     {
-        CPLReleaseMutex(hWarpMutex);
+        if (hWarpMutex != nullptr)
+            CPLReleaseMutex(hWarpMutex);
         if (!CPLAcquireMutex(hIOMutex, 600.0))
         {
             CPLError(CE_Failure, CPLE_AppDefined,
@@ -2268,6 +3446,12 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
         }
     }
 
+    // With ordered multi-chunk writes, wait for the previous chunks to be
+    // written before writing the destination alpha band.
+    if (eErr == CE_None && m_psChunkWorker != nullptr &&
+        !WaitForChunkWriteTurn(m_psChunkWorker))
+        eErr = CE_Failure;
+
     /* -------------------------------------------------------------------- */
     /*      Write destination alpha if available.                           */
     /* -------------------------------------------------------------------- */
@@ -2282,7 +3466,7 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     /* -------------------------------------------------------------------- */
     /*      Cleanup.                                                        */
     /* -------------------------------------------------------------------- */
-    CPLFree(oWK.papabySrcImage[0]);
+    VSIFreeLarge(oWK.papabySrcImage[0]);
     CPLFree(oWK.papabySrcImage);
     CPLFree(oWK.papabyDstImage);
 
@@ -2297,6 +3481,9 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     CPLFree(oWK.panDstValid);
     CPLFree(oWK.pafDstDensity);
 
+    if (psProfile == &sOwnProfile)
+        poProfiler->AddChunk(sOwnProfile);
+
     return eErr;
 }
 
@@ -2757,31 +3944,39 @@ bool GDALWarpOperation::ComputeSourceWindowTransformPoints(
     /* -------------------------------------------------------------------- */
     /*      Transform them to the input pixel coordinate space              */
     /* -------------------------------------------------------------------- */
+    GDALTransformerFunc pfnTransformer = psOptions->pfnTransformer;
+    void *pTransformerArg = psOptions->pTransformerArg;
+    // The transform grid only serves the warp kernel: it cannot honour
+    // CHECK_WITH_INVERT_PROJ.
+    if (pfnTransformer == GDALTransformGridTransform)
+    {
+        pTransformerArg = GDALGetTransformGridBaseTransformer(
+            pTransformerArg, &pfnTransformer);
+    }
     if (bTryWithCheckWithInvertProj)
     {
         CPLSetThreadLocalConfigOption("CHECK_WITH_INVERT_PROJ", "YES");
-        if (psOptions->pfnTransformer == GDALGenImgProjTransform)
+        if (pfnTransformer == GDALGenImgProjTransform)
         {
-            GDALRefreshGenImgProjTransformer(psOptions->pTransformerArg);
+            GDALRefreshGenImgProjTransformer(pTransformerArg);
         }
-        else if (psOptions->pfnTransformer == GDALApproxTransform)
+        else if (pfnTransformer == GDALApproxTransform)
         {
-            GDALRefreshApproxTransformer(psOptions->pTransformerArg);
+            GDALRefreshApproxTransformer(pTransformerArg);
         }
     }
-    int ret = psOptions->pfnTransformer(psOptions->pTransformerArg, TRUE,
-                                        nSamplePoints, padfX, padfY, padfZ,
-                                        pabSuccess);
+    int ret = pfnTransformer(pTransformerArg, TRUE, nSamplePoints, padfX,
+                             padfY, padfZ, pabSuccess);
     if (bTryWithCheckWithInvertProj)
     {
         CPLSetThreadLocalConfigOption("CHECK_WITH_INVERT_PROJ", nullptr);
-        if (psOptions->pfnTransformer == GDALGenImgProjTransform)
+        if (pfnTransformer == GDALGenImgProjTransform)
         {
-            GDALRefreshGenImgProjTransformer(psOptions->pTransformerArg);
+            GDALRefreshGenImgProjTransformer(pTransformerArg);
         }
-        else if (psOptions->pfnTransformer == GDALApproxTransform)
+        else if (pfnTransformer == GDALApproxTransform)
         {
-            GDALRefreshApproxTransformer(psOptions->pTransformerArg);
+            GDALRefreshApproxTransformer(pTransformerArg);
         }
     }
 
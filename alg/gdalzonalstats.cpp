@@ -0,0 +1,1049 @@
+/******************************************************************************
+ *
+ * Project:  GDAL
+ * Purpose:  Statistics of raster values within polygon zones.
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "gdal_alg.h"
+#include "gdal_alg_priv.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "cpl_conv.h"
+#include "cpl_error.h"
+#include "cpl_progress.h"
+#include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_priv.h"
+#include "gdal_thread_pool.h"
+#include "ogr_api.h"
+#include "ogr_geometry.h"
+#include "ogr_spatialref.h"
+#include "ogrsf_frmts.h"
+
+namespace
+{
+
+/************************************************************************/
+/*                              ZoneStats                               */
+/************************************************************************/
+
+// Accumulated statistics of one band within one zone. With fractional
+// coverage, each pixel is weighted by the fraction of it that is covered.
+struct ZoneStats
+{
+    double dfCount = 0;
+    double dfSum = 0;
+    double dfMin = std::numeric_limits<double>::infinity();
+    double dfMax = -std::numeric_limits<double>::infinity();
+    std::vector<double> adfHistogram{};
+
+    void Merge(const ZoneStats &oOther)
+    {
+        dfCount += oOther.dfCount;
+        dfSum += oOther.dfSum;
+        dfMin = std::min(dfMin, oOther.dfMin);
+        dfMax = std::max(dfMax, oOther.dfMax);
+        if (!oOther.adfHistogram.empty())
+        {
+            if (adfHistogram.empty())
+                adfHistogram = oOther.adfHistogram;
+            else
+            {
+                for (size_t i = 0; i < adfHistogram.size(); ++i)
+                    adfHistogram[i] += oOther.adfHistogram[i];
+            }
+        }
+    }
+};
+
+/************************************************************************/
+/*                                Zone                                  */
+/************************************************************************/
+
+// Rings of a zone, in pixel/line coordinates of the raster, and its
+// bounding box clipped to the raster, as half-open pixel ranges.
+struct Zone
+{
+    std::vector<int> anPartSize{};
+    std::vector<double> adfX{};
+    std::vector<double> adfY{};
+    int nXOff = 0;
+    int nYOff = 0;
+    int nXEnd = 0;
+    int nYEnd = 0;
+
+    bool IsEmpty() const
+    {
+        return nXOff >= nXEnd || nYOff >= nYEnd;
+    }
+};
+
+/************************************************************************/
+/*                           ZonalContext                               */
+/************************************************************************/
+
+struct ZonalContext
+{
+    int nBands = 0;
+    bool bAllTouched = false;
+    // 1 for pixel center coverage, otherwise the number of sub-pixels per
+    // pixel side used to estimate the covered fraction of pixels.
+    int nSuperSampling = 1;
+    int nHistogramBins = 0;
+    std::vector<double> adfHistogramMin{};
+    std::vector<double> adfHistogramMax{};
+
+    std::vector<Zone> aoZones{};
+
+    // nZones * nBands statistics, merged from the window jobs.
+    std::mutex oMutex{};
+    std::vector<ZoneStats> aoStats{};
+};
+
+/************************************************************************/
+/*                             WindowJob                                */
+/************************************************************************/
+
+// A raster window that has been read, and the zones intersecting it.
+struct WindowJob
+{
+    ZonalContext *psContext = nullptr;
+    int nXOff = 0;
+    int nYOff = 0;
+    int nXSize = 0;
+    int nYSize = 0;
+    std::vector<int> anZones{};
+    // Band sequential values of the window.
+    std::vector<double> adfValues{};
+    // Per band validity mask of the window, or empty when all valid.
+    std::vector<std::vector<GByte>> aabyMasks{};
+};
+
+/************************************************************************/
+/*                             CoverageMask                             */
+/************************************************************************/
+
+struct CoverageMask
+{
+    GByte *pabyMask = nullptr;
+    int nXSize = 0;
+    int nYSize = 0;
+};
+
+static void CoverageScanline(void *pCBData, int nY, int nXStart, int nXEnd,
+                             double /* dfVariant */)
+{
+    CoverageMask *psMask = static_cast<CoverageMask *>(pCBData);
+    if (nY < 0 || nY >= psMask->nYSize)
+        return;
+    nXStart = std::max(nXStart, 0);
+    nXEnd = std::min(nXEnd, psMask->nXSize - 1);
+    if (nXStart > nXEnd)
+        return;
+    memset(psMask->pabyMask + static_cast<size_t>(nY) * psMask->nXSize +
+               nXStart,
+           1, static_cast<size_t>(nXEnd - nXStart + 1));
+}
+
+static void CoveragePoint(void *pCBData, int nY, int nX,
+                          double /* dfVariant */)
+{
+    CoverageMask *psMask = static_cast<CoverageMask *>(pCBData);
+    if (nY < 0 || nY >= psMask->nYSize || nX < 0 || nX >= psMask->nXSize)
+        return;
+    psMask->pabyMask[static_cast<size_t>(nY) * psMask->nXSize + nX] = 1;
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                       GDALZonalStatsWindowJob()                      */
+/************************************************************************/
+
+// Rasterize the coverage of each zone within the window, accumulate the
+// statistics of the covered pixels locally, and merge them into the
+// context. Runs in a worker thread, and takes ownership of the job.
+static void GDALZonalStatsWindowJob(void *pData)
+{
+    std::unique_ptr<WindowJob> poJob(static_cast<WindowJob *>(pData));
+    ZonalContext *psContext = poJob->psContext;
+    const int nBands = psContext->nBands;
+    const int nSS = psContext->nSuperSampling;
+    const size_t nWindowPixels =
+        static_cast<size_t>(poJob->nXSize) * poJob->nYSize;
+
+    std::vector<ZoneStats> aoLocalStats(poJob->anZones.size() * nBands);
+    std::vector<GByte> abyCoverage;
+    std::vector<double> adfX;
+    std::vector<double> adfY;
+
+    for (size_t iZone = 0; iZone < poJob->anZones.size(); ++iZone)
+    {
+        const Zone &oZone = psContext->aoZones[poJob->anZones[iZone]];
+        const int nSubXOff = std::max(oZone.nXOff, poJob->nXOff);
+        const int nSubYOff = std::max(oZone.nYOff, poJob->nYOff);
+        const int nSubXEnd =
+            std::min(oZone.nXEnd, poJob->nXOff + poJob->nXSize);
+        const int nSubYEnd =
+            std::min(oZone.nYEnd, poJob->nYOff + poJob->nYSize);
+        if (nSubXOff >= nSubXEnd || nSubYOff >= nSubYEnd)
+            continue;
+
+        // Rasterize the zone into a mask covering its intersection with
+        // the window, possibly supersampled.
+        CoverageMask sMask;
+        sMask.nXSize = (nSubXEnd - nSubXOff) * nSS;
+        sMask.nYSize = (nSubYEnd - nSubYOff) * nSS;
+        abyCoverage.assign(static_cast<size_t>(sMask.nXSize) * sMask.nYSize,
+                           0);
+        sMask.pabyMask = abyCoverage.data();
+
+        adfX.resize(oZone.adfX.size());
+        adfY.resize(oZone.adfY.size());
+        for (size_t i = 0; i < adfX.size(); ++i)
+        {
+            adfX[i] = (oZone.adfX[i] - nSubXOff) * nSS;
+            adfY[i] = (oZone.adfY[i] - nSubYOff) * nSS;
+        }
+
+        const int nPartCount = static_cast<int>(oZone.anPartSize.size());
+        GDALdllImageFilledPolygon(sMask.nXSize, sMask.nYSize, nPartCount,
+                                  oZone.anPartSize.data(), adfX.data(),
+                                  adfY.data(), nullptr, CoverageScanline,
+                                  &sMask, false);
+        if (psContext->bAllTouched)
+        {
+            GDALdllImageLineAllTouched(sMask.nXSize, sMask.nYSize, nPartCount,
+                                       oZone.anPartSize.data(), adfX.data(),
+                                       adfY.data(), nullptr, CoveragePoint,
+                                       &sMask, false, false);
+        }
+
+        // Accumulate the covered pixels.
+        ZoneStats *pasStats = &aoLocalStats[iZone * nBands];
+        const double dfSubPixelWeight = 1.0 / (nSS * nSS);
+        for (int iY = nSubYOff; iY < nSubYEnd; ++iY)
+        {
+            const GByte *pabyCoverageLine =
+                sMask.pabyMask +
+                static_cast<size_t>(iY - nSubYOff) * nSS * sMask.nXSize;
+            for (int iX = nSubXOff; iX < nSubXEnd; ++iX)
+            {
+                double dfWeight;
+                if (nSS == 1)
+                {
+                    if (!pabyCoverageLine[iX - nSubXOff])
+                        continue;
+                    dfWeight = 1.0;
+                }
+                else
+                {
+                    int nCovered = 0;
+                    for (int iSubY = 0; iSubY < nSS; ++iSubY)
+                    {
+                        const GByte *pabySub =
+                            pabyCoverageLine +
+                            static_cast<size_t>(iSubY) * sMask.nXSize +
+                            static_cast<size_t>(iX - nSubXOff) * nSS;
+                        for (int iSubX = 0; iSubX < nSS; ++iSubX)
+                            nCovered += pabySub[iSubX];
+                    }
+                    if (nCovered == 0)
+                        continue;
+                    dfWeight = nCovered * dfSubPixelWeight;
+                }
+
+                const size_t nIdx =
+                    static_cast<size_t>(iY - poJob->nYOff) * poJob->nXSize +
+                    (iX - poJob->nXOff);
+                for (int iBand = 0; iBand < nBands; ++iBand)
+                {
+                    const auto &abyValidity = poJob->aabyMasks[iBand];
+                    if (!abyValidity.empty() && abyValidity[nIdx] == 0)
+                        continue;
+                    const double dfVal =
+                        poJob->adfValues[iBand * nWindowPixels + nIdx];
+                    if (std::isnan(dfVal))
+                        continue;
+
+                    ZoneStats &sStats = pasStats[iBand];
+                    sStats.dfCount += dfWeight;
+                    sStats.dfSum += dfWeight * dfVal;
+                    sStats.dfMin = std::min(sStats.dfMin, dfVal);
+                    sStats.dfMax = std::max(sStats.dfMax, dfVal);
+
+                    const int nBins = psContext->nHistogramBins;
+                    if (nBins > 0)
+                    {
+                        const double dfHistMin =
+                            psContext->adfHistogramMin[iBand];
+                        const double dfHistMax =
+                            psContext->adfHistogramMax[iBand];
+                        if (!(dfVal >= dfHistMin && dfVal <= dfHistMax))
+                            continue;
+                        int iBin = static_cast<int>((dfVal - dfHistMin) /
+                                                    (dfHistMax - dfHistMin) *
+                                                    nBins);
+                        iBin = std::min(iBin, nBins - 1);
+                        if (sStats.adfHistogram.empty())
+                            sStats.adfHistogram.resize(nBins);
+                        sStats.adfHistogram[iBin] += dfWeight;
+                    }
+                }
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> oLock(psContext->oMutex);
+    for (size_t iZone = 0; iZone < poJob->anZones.size(); ++iZone)
+    {
+        const size_t nGlobalIdx =
+            static_cast<size_t>(poJob->anZones[iZone]) * nBands;
+        for (int iBand = 0; iBand < nBands; ++iBand)
+        {
+            psContext->aoStats[nGlobalIdx + iBand].Merge(
+                aoLocalStats[iZone * nBands + iBand]);
+        }
+    }
+}
+
+/************************************************************************/
+/*                       GDALZonalStatsAddRings()                       */
+/************************************************************************/
+
+// Append the rings of the polygons of poGeom, converted to pixel/line
+// coordinates, to the zone, and grow its bounding box.
+static void GDALZonalStatsAddRings(const OGRGeometry *poGeom,
+                                   const double *padfInvGT, Zone &oZone,
+                                   double &dfMinX, double &dfMinY,
+                                   double &dfMaxX, double &dfMaxY)
+{
+    const auto eType = wkbFlatten(poGeom->getGeometryType());
+    if (eType == wkbPolygon)
+    {
+        for (const auto *poRing : *(poGeom->toPolygon()))
+        {
+            const int nPoints = poRing->getNumPoints();
+            if (nPoints == 0)
+                continue;
+            oZone.anPartSize.push_back(nPoints);
+            for (int i = 0; i < nPoints; ++i)
+            {
+                const double dfX = poRing->getX(i);
+                const double dfY = poRing->getY(i);
+                const double dfPixel =
+                    padfInvGT[0] + dfX * padfInvGT[1] + dfY * padfInvGT[2];
+                const double dfLine =
+                    padfInvGT[3] + dfX * padfInvGT[4] + dfY * padfInvGT[5];
+                oZone.adfX.push_back(dfPixel);
+                oZone.adfY.push_back(dfLine);
+                dfMinX = std::min(dfMinX, dfPixel);
+                dfMinY = std::min(dfMinY, dfLine);
+                dfMaxX = std::max(dfMaxX, dfPixel);
+                dfMaxY = std::max(dfMaxY, dfLine);
+            }
+        }
+    }
+    else if (OGR_GT_IsSubClassOf(eType, wkbGeometryCollection))
+    {
+        for (const auto *poSubGeom : *(poGeom->toGeometryCollection()))
+        {
+            GDALZonalStatsAddRings(poSubGeom, padfInvGT, oZone, dfMinX,
+                                   dfMinY, dfMaxX, dfMaxY);
+        }
+    }
+    else
+    {
+        CPLDebug("GDAL", "GDALZonalStatistics(): ignoring %s geometry",
+                 OGRGeometryTypeToName(eType));
+    }
+}
+
+/************************************************************************/
+/*                        GDALZonalStatistics()                         */
+/************************************************************************/
+
+/**
+ * Compute statistics of raster values within polygon zones.
+ *
+ * For each feature of the zones layer, statistics of the values of the
+ * selected raster bands within the polygon(s) of its geometry are computed
+ * and written as a new feature of the output layer. Output features are
+ * written in the order of the zone features.
+ *
+ * The raster is processed by windows aligned on its blocks, each read only
+ * once, in which the zones intersecting the window are rasterized. Zones
+ * must be polygons or multipolygons (curve geometries are linearized,
+ * other geometry types cover no pixel). They are reprojected to the
+ * spatial reference system of the raster when both are known and differ.
+ *
+ * Pixels that are nodata or masked, according to the mask band of each
+ * band, as well as NaN values, are ignored.
+ *
+ * Fields, named after the statistic (e.g. "mean") when a single band is
+ * selected, or "b{band_number}_{statistic}" otherwise, are created in the
+ * output layer when they do not exist.
+ *
+ * Supported options:
+ * <ul>
+ * <li>STATS=list: comma separated list of statistics among count, sum,
+ * mean, min, max and histogram. Defaults to count,sum,mean,min,max.
+ * The histogram is written as a string of comma separated bucket counts.</li>
+ * <li>ALL_TOUCHED=YES/NO: whether all pixels touched by the polygons are
+ * included, rather than only those whose center is within them.
+ * Defaults to NO.</li>
+ * <li>COVERAGE=CENTER/FRACTIONAL: with FRACTIONAL, each pixel is weighted
+ * by the fraction of its area covered by the zone, estimated by
+ * supersampling. Counts are then real numbers. Defaults to CENTER.
+ * Incompatible with ALL_TOUCHED=YES.</li>
+ * <li>COVERAGE_SUPERSAMPLING=n: number of sub-pixels per pixel side used
+ * with COVERAGE=FRACTIONAL. Defaults to 8.</li>
+ * <li>HISTOGRAM_BINS=n: number of histogram buckets. Defaults to 256.</li>
+ * <li>HISTOGRAM_MIN=val and HISTOGRAM_MAX=val: range of the histogram.
+ * Defaults to -0.5 and 255.5 for Byte bands, and to the approximate
+ * minimum and maximum of the band otherwise.</li>
+ * <li>NUM_THREADS=number_of_threads or ALL_CPUS: number of threads that
+ * rasterize zones and accumulate statistics while the main thread reads
+ * the raster. Defaults to the value of the GDAL_NUM_THREADS configuration
+ * option.</li>
+ * <li>INCLUDE_FIELDS=YES/NO: whether the fields of the zone features are
+ * copied to the output features (provided the output layer has fields of
+ * the same names). Defaults to YES.</li>
+ * <li>INCLUDE_GEOMETRY=YES/NO: whether the geometries of the zone
+ * features are copied to the output features. Defaults to NO.</li>
+ * </ul>
+ *
+ * @param hSrcDS the raster dataset, which must have a geotransform.
+ * @param nBandCount number of bands in panBandList, or 0 for all bands.
+ * @param panBandList 1-based band numbers, or NULL for all bands.
+ * @param hZonesLayer layer of polygon zones.
+ * @param hOutputLayer layer to which results are written.
+ * @param papszOptions NULL terminated list of options, or NULL.
+ * @param pfnProgress progress function, or NULL.
+ * @param pProgressArg argument of the progress function.
+ *
+ * @return CE_None on success, CE_Failure otherwise.
+ *
+ * @since GDAL 3.9
+ */
+
+CPLErr GDALZonalStatistics(GDALDatasetH hSrcDS, int nBandCount,
+                           const int *panBandList, OGRLayerH hZonesLayer,
+                           OGRLayerH hOutputLayer, CSLConstList papszOptions,
+                           GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    VALIDATE_POINTER1(hSrcDS, "GDALZonalStatistics", CE_Failure);
+    VALIDATE_POINTER1(hZonesLayer, "GDALZonalStatistics", CE_Failure);
+    VALIDATE_POINTER1(hOutputLayer, "GDALZonalStatistics", CE_Failure);
+
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+
+    GDALDataset *poSrcDS = GDALDataset::FromHandle(hSrcDS);
+    OGRLayer *poZonesLayer = OGRLayer::FromHandle(hZonesLayer);
+    OGRLayer *poOutLayer = OGRLayer::FromHandle(hOutputLayer);
+
+    /* -------------------------------------------------------------------- */
+    /*      Check bands and options.                                        */
+    /* -------------------------------------------------------------------- */
+    std::vector<int> anBandList;
+    if (nBandCount == 0 || panBandList == nullptr)
+    {
+        for (int i = 1; i <= poSrcDS->GetRasterCount(); ++i)
+            anBandList.push_back(i);
+    }
+    else
+    {
+        for (int i = 0; i < nBandCount; ++i)
+        {
+            if (panBandList[i] < 1 ||
+                panBandList[i] > poSrcDS->GetRasterCount())
+            {
+                CPLError(CE_Failure, CPLE_IllegalArg, "Invalid band number: %d",
+                         panBandList[i]);
+                return CE_Failure;
+            }
+            anBandList.push_back(panBandList[i]);
+        }
+    }
+    if (anBandList.empty())
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "No raster band to process");
+        return CE_Failure;
+    }
+    const int nBands = static_cast<int>(anBandList.size());
+
+    double adfGT[6];
+    double adfInvGT[6];
+    if (poSrcDS->GetGeoTransform(adfGT) != CE_None ||
+        !GDALInvGeoTransform(adfGT, adfInvGT))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Raster has no (invertible) geotransform");
+        return CE_Failure;
+    }
+
+    bool bStatCount = false;
+    bool bStatSum = false;
+    bool bStatMean = false;
+    bool bStatMin = false;
+    bool bStatMax = false;
+    bool bStatHistogram = false;
+    const CPLStringList aosStats(CSLTokenizeString2(
+        CSLFetchNameValueDef(papszOptions, "STATS", "count,sum,mean,min,max"),
+        ", ", 0));
+    for (const char *pszStat : aosStats)
+    {
+        if (EQUAL(pszStat, "count"))
+            bStatCount = true;
+        else if (EQUAL(pszStat, "sum"))
+            bStatSum = true;
+        else if (EQUAL(pszStat, "mean"))
+            bStatMean = true;
+        else if (EQUAL(pszStat, "min"))
+            bStatMin = true;
+        else if (EQUAL(pszStat, "max"))
+            bStatMax = true;
+        else if (EQUAL(pszStat, "histogram"))
+            bStatHistogram = true;
+        else
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg, "Unknown statistic: %s",
+                     pszStat);
+            return CE_Failure;
+        }
+    }
+
+    ZonalContext sContext;
+    sContext.nBands = nBands;
+    sContext.bAllTouched =
+        CPLFetchBool(papszOptions, "ALL_TOUCHED", false);
+    const char *pszCoverage =
+        CSLFetchNameValueDef(papszOptions, "COVERAGE", "CENTER");
+    if (EQUAL(pszCoverage, "FRACTIONAL"))
+    {
+        if (sContext.bAllTouched)
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg,
+                     "ALL_TOUCHED=YES and COVERAGE=FRACTIONAL are mutually "
+                     "exclusive");
+            return CE_Failure;
+        }
+        sContext.nSuperSampling = atoi(CSLFetchNameValueDef(
+            papszOptions, "COVERAGE_SUPERSAMPLING", "8"));
+        if (sContext.nSuperSampling < 1 || sContext.nSuperSampling > 64)
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg,
+                     "COVERAGE_SUPERSAMPLING must be in [1,64] range");
+            return CE_Failure;
+        }
+    }
+    else if (!EQUAL(pszCoverage, "CENTER"))
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "Invalid value for COVERAGE: %s", pszCoverage);
+        return CE_Failure;
+    }
+    const bool bFractional = EQUAL(pszCoverage, "FRACTIONAL");
+
+    if (bStatHistogram)
+    {
+        sContext.nHistogramBins =
+            atoi(CSLFetchNameValueDef(papszOptions, "HISTOGRAM_BINS", "256"));
+        if (sContext.nHistogramBins < 1 || sContext.nHistogramBins > 65536)
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg,
+                     "HISTOGRAM_BINS must be in [1,65536] range");
+            return CE_Failure;
+        }
+        const char *pszHistMin =
+            CSLFetchNameValue(papszOptions, "HISTOGRAM_MIN");
+        const char *pszHistMax =
+            CSLFetchNameValue(papszOptions, "HISTOGRAM_MAX");
+        for (int nBand : anBandList)
+        {
+            GDALRasterBand *poBand = poSrcDS->GetRasterBand(nBand);
+            double dfHistMin = -0.5;
+            double dfHistMax = 255.5;
+            if ((pszHistMin == nullptr || pszHistMax == nullptr) &&
+                poBand->GetRasterDataType() != GDT_Byte)
+            {
+                if (poBand->GetStatistics(TRUE, TRUE, &dfHistMin, &dfHistMax,
+                                          nullptr, nullptr) != CE_None)
+                {
+                    return CE_Failure;
+                }
+            }
+            if (pszHistMin)
+                dfHistMin = CPLAtof(pszHistMin);
+            if (pszHistMax)
+                dfHistMax = CPLAtof(pszHistMax);
+            if (!(dfHistMax > dfHistMin))
+            {
+                if (pszHistMin && pszHistMax)
+                {
+                    CPLError(CE_Failure, CPLE_IllegalArg,
+                             "HISTOGRAM_MAX must be greater than "
+                             "HISTOGRAM_MIN");
+                    return CE_Failure;
+                }
+                // Constant band.
+                dfHistMin -= 0.5;
+                dfHistMax = dfHistMin + 1;
+            }
+            sContext.adfHistogramMin.push_back(dfHistMin);
+            sContext.adfHistogramMax.push_back(dfHistMax);
+        }
+    }
+
+    const bool bIncludeFields =
+        CPLFetchBool(papszOptions, "INCLUDE_FIELDS", true);
+    const bool bIncludeGeometry =
+        CPLFetchBool(papszOptions, "INCLUDE_GEOMETRY", false);
+
+    /* -------------------------------------------------------------------- */
+    /*      Create output fields.                                           */
+    /* -------------------------------------------------------------------- */
+    struct OutputField
+    {
+        int iBand = 0;
+        enum class Stat
+        {
+            COUNT,
+            SUM,
+            MEAN,
+            MIN,
+            MAX,
+            HISTOGRAM,
+        } eStat = Stat::COUNT;
+        int iField = -1;
+    };
+
+    std::vector<OutputField> aoOutputFields;
+    {
+        const struct
+        {
+            bool bSelected;
+            OutputField::Stat eStat;
+            const char *pszName;
+            OGRFieldType eType;
+        } asStats[] = {
+            {bStatCount, OutputField::Stat::COUNT, "count",
+             bFractional ? OFTReal : OFTInteger64},
+            {bStatSum, OutputField::Stat::SUM, "sum", OFTReal},
+            {bStatMean, OutputField::Stat::MEAN, "mean", OFTReal},
+            {bStatMin, OutputField::Stat::MIN, "min", OFTReal},
+            {bStatMax, OutputField::Stat::MAX, "max", OFTReal},
+            {bStatHistogram, OutputField::Stat::HISTOGRAM, "histogram",
+             OFTString},
+        };
+
+        if (bIncludeFields)
+        {
+            const OGRFeatureDefn *poZonesDefn = poZonesLayer->GetLayerDefn();
+            for (int i = 0; i < poZonesDefn->GetFieldCount(); ++i)
+            {
+                const OGRFieldDefn *poFieldDefn = poZonesDefn->GetFieldDefn(i);
+                if (poOutLayer->GetLayerDefn()->GetFieldIndex(
+                        poFieldDefn->GetNameRef()) < 0 &&
+                    poOutLayer->CreateField(poFieldDefn) != OGRERR_NONE)
+                {
+                    return CE_Failure;
+                }
+            }
+        }
+
+        for (int iBand = 0; iBand < nBands; ++iBand)
+        {
+            for (const auto &sStat : asStats)
+            {
+                if (!sStat.bSelected)
+                    continue;
+                const std::string osName =
+                    nBands == 1 ? std::string(sStat.pszName)
+                                : CPLSPrintf("b%d_%s", anBandList[iBand],
+                                             sStat.pszName);
+                OGRFeatureDefn *poOutDefn = poOutLayer->GetLayerDefn();
+                if (poOutDefn->GetFieldIndex(osName.c_str()) < 0)
+                {
+                    OGRFieldDefn oFieldDefn(osName.c_str(), sStat.eType);
+                    if (poOutLayer->CreateField(&oFieldDefn) != OGRERR_NONE)
+                        return CE_Failure;
+                }
+                OutputField sField;
+                sField.iBand = iBand;
+                sField.eStat = sStat.eStat;
+                sField.iField = poOutLayer->GetLayerDefn()->GetFieldIndex(
+                    osName.c_str());
+                aoOutputFields.push_back(sField);
+            }
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Collect zones, in pixel coordinates.                            */
+    /* -------------------------------------------------------------------- */
+    const OGRSpatialReference *poRasterSRS = poSrcDS->GetSpatialRef();
+    const OGRSpatialReference *poZonesSRS = poZonesLayer->GetSpatialRef();
+    std::unique_ptr<OGRCoordinateTransformation> poCT;
+    if (poRasterSRS && poZonesSRS && !poRasterSRS->IsSame(poZonesSRS))
+    {
+        poCT.reset(OGRCreateCoordinateTransformation(poZonesSRS, poRasterSRS));
+        if (poCT == nullptr)
+            return CE_Failure;
+    }
+
+    const int nRasterXSize = poSrcDS->GetRasterXSize();
+    const int nRasterYSize = poSrcDS->GetRasterYSize();
+
+    poZonesLayer->ResetReading();
+    for (auto &&poFeature : *poZonesLayer)
+    {
+        sContext.aoZones.emplace_back();
+        Zone &oZone = sContext.aoZones.back();
+
+        const OGRGeometry *poGeom = poFeature->GetGeometryRef();
+        if (poGeom == nullptr || poGeom->IsEmpty())
+            continue;
+
+        std::unique_ptr<OGRGeometry> poTmpGeom;
+        if (poGeom->hasCurveGeometry())
+        {
+            poTmpGeom.reset(poGeom->getLinearGeometry());
+            poGeom = poTmpGeom.get();
+        }
+        if (poCT)
+        {
+            if (!poTmpGeom)
+            {
+                poTmpGeom.reset(poGeom->clone());
+                poGeom = poTmpGeom.get();
+            }
+            if (poTmpGeom->transform(poCT.get()) != OGRERR_NONE)
+            {
+                CPLError(CE_Warning, CPLE_AppDefined,
+                         "Cannot reproject geometry of feature " CPL_FRMT_GIB
+                         ". It will be considered as empty",
+                         static_cast<GIntBig>(poFeature->GetFID()));
+                continue;
+            }
+        }
+
+        double dfMinX = std::numeric_limits<double>::infinity();
+        double dfMinY = std::numeric_limits<double>::infinity();
+        double dfMaxX = -std::numeric_limits<double>::infinity();
+        double dfMaxY = -std::numeric_limits<double>::infinity();
+        GDALZonalStatsAddRings(poGeom, adfInvGT, oZone, dfMinX, dfMinY,
+                               dfMaxX, dfMaxY);
+        if (oZone.anPartSize.empty())
+            continue;
+
+        oZone.nXOff = static_cast<int>(
+            std::max(0.0, std::floor(std::max(dfMinX, -1.0))));
+        oZone.nYOff = static_cast<int>(
+            std::max(0.0, std::floor(std::max(dfMinY, -1.0))));
+        oZone.nXEnd = static_cast<int>(std::min<double>(
+            nRasterXSize, std::ceil(std::min<double>(dfMaxX, INT_MAX))));
+        oZone.nYEnd = static_cast<int>(std::min<double>(
+            nRasterYSize, std::ceil(std::min<double>(dfMaxY, INT_MAX))));
+        if (oZone.IsEmpty())
+        {
+            oZone.anPartSize.clear();
+            oZone.adfX.clear();
+            oZone.adfY.clear();
+        }
+    }
+    const size_t nZones = sContext.aoZones.size();
+    sContext.aoStats.resize(nZones * nBands);
+
+    /* -------------------------------------------------------------------- */
+    /*      Split the raster in block aligned windows, and sort zones in    */
+    /*      the windows they intersect.                                     */
+    /* -------------------------------------------------------------------- */
+    GDALRasterBand *poFirstBand = poSrcDS->GetRasterBand(anBandList[0]);
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poFirstBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    nBlockXSize = std::max(1, std::min(nBlockXSize, nRasterXSize));
+    nBlockYSize = std::max(1, std::min(nBlockYSize, nRasterYSize));
+
+    constexpr int TARGET_WINDOW_WIDTH = 512;
+    constexpr int TARGET_WINDOW_PIXELS = 1024 * 1024;
+    int nWindowXSize = std::min(
+        nRasterXSize, std::max(1, TARGET_WINDOW_WIDTH / nBlockXSize) *
+                          nBlockXSize);
+    // Windows are made of whole blocks vertically, unless blocks are taller
+    // than the target window size (single strip files for example).
+    const int nMaxWindowYSize =
+        std::max(1, TARGET_WINDOW_PIXELS / nWindowXSize);
+    int nWindowYSize = nBlockYSize <= nMaxWindowYSize
+                           ? nMaxWindowYSize / nBlockYSize * nBlockYSize
+                           : nMaxWindowYSize;
+    nWindowYSize = std::min(nRasterYSize, nWindowYSize);
+    const int nWindowsPerRow = DIV_ROUND_UP(nRasterXSize, nWindowXSize);
+    const int nWindowsPerCol = DIV_ROUND_UP(nRasterYSize, nWindowYSize);
+
+    std::vector<std::vector<int>> aanWindowZones;
+    try
+    {
+        aanWindowZones.resize(static_cast<size_t>(nWindowsPerRow) *
+                              nWindowsPerCol);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "Out of memory");
+        return CE_Failure;
+    }
+    for (size_t iZone = 0; iZone < nZones; ++iZone)
+    {
+        const Zone &oZone = sContext.aoZones[iZone];
+        if (oZone.IsEmpty())
+            continue;
+        for (int iWinY = oZone.nYOff / nWindowYSize;
+             iWinY <= (oZone.nYEnd - 1) / nWindowYSize; ++iWinY)
+        {
+            for (int iWinX = oZone.nXOff / nWindowXSize;
+                 iWinX <= (oZone.nXEnd - 1) / nWindowXSize; ++iWinX)
+            {
+                aanWindowZones[static_cast<size_t>(iWinY) * nWindowsPerRow +
+                               iWinX]
+                    .push_back(static_cast<int>(iZone));
+            }
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Read windows, and dispatch them to worker threads.              */
+    /* -------------------------------------------------------------------- */
+    const int nThreads =
+        GDALGetNumThreads(CSLFetchNameValue(papszOptions, "NUM_THREADS"));
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if (poThreadPool)
+        poJobQueue = poThreadPool->CreateJobQueue();
+
+    CPLErr eErr = CE_None;
+    const size_t nWindows = aanWindowZones.size();
+    for (size_t iWindow = 0; iWindow < nWindows && eErr == CE_None; ++iWindow)
+    {
+        if (aanWindowZones[iWindow].empty())
+            continue;
+
+        auto poJob = std::make_unique<WindowJob>();
+        poJob->psContext = &sContext;
+        poJob->nXOff = static_cast<int>(iWindow % nWindowsPerRow) *
+                       nWindowXSize;
+        poJob->nYOff = static_cast<int>(iWindow / nWindowsPerRow) *
+                       nWindowYSize;
+        poJob->nXSize = std::min(nWindowXSize, nRasterXSize - poJob->nXOff);
+        poJob->nYSize = std::min(nWindowYSize, nRasterYSize - poJob->nYOff);
+        poJob->anZones = std::move(aanWindowZones[iWindow]);
+
+        const size_t nWindowPixels =
+            static_cast<size_t>(poJob->nXSize) * poJob->nYSize;
+        try
+        {
+            poJob->adfValues.resize(nWindowPixels * nBands);
+            poJob->aabyMasks.resize(nBands);
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory, "Out of memory");
+            eErr = CE_Failure;
+            break;
+        }
+
+        eErr = poSrcDS->RasterIO(
+            GF_Read, poJob->nXOff, poJob->nYOff, poJob->nXSize, poJob->nYSize,
+            poJob->adfValues.data(), poJob->nXSize, poJob->nYSize,
+            GDT_Float64, nBands, anBandList.data(), sizeof(double),
+            sizeof(double) * poJob->nXSize, sizeof(double) * nWindowPixels,
+            nullptr);
+        for (int iBand = 0; iBand < nBands && eErr == CE_None; ++iBand)
+        {
+            GDALRasterBand *poBand = poSrcDS->GetRasterBand(anBandList[iBand]);
+            if (poBand->GetMaskFlags() == GMF_ALL_VALID)
+                continue;
+            auto &abyMask = poJob->aabyMasks[iBand];
+            abyMask.resize(nWindowPixels);
+            eErr = poBand->GetMaskBand()->RasterIO(
+                GF_Read, poJob->nXOff, poJob->nYOff, poJob->nXSize,
+                poJob->nYSize, abyMask.data(), poJob->nXSize, poJob->nYSize,
+                GDT_Byte, 0, 0, nullptr);
+        }
+        if (eErr != CE_None)
+            break;
+
+        if (poJobQueue)
+        {
+            // Bound the number of windows held in memory.
+            poJobQueue->WaitCompletion(nThreads * 2);
+            poJobQueue->SubmitJob(GDALZonalStatsWindowJob, poJob.release());
+        }
+        else
+        {
+            GDALZonalStatsWindowJob(poJob.release());
+        }
+
+        if (!pfnProgress(0.9 * static_cast<double>(iWindow + 1) / nWindows,
+                         "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+    if (poJobQueue)
+        poJobQueue->WaitCompletion();
+    if (eErr != CE_None)
+        return eErr;
+
+    /* -------------------------------------------------------------------- */
+    /*      Write output features, in the order of the zones.               */
+    /* -------------------------------------------------------------------- */
+    const bool bUseTransactions =
+        poOutLayer->TestCapability(OLCTransactions) != FALSE;
+    constexpr size_t TRANSACTION_SIZE = 100 * 1000;
+    if (bUseTransactions && poOutLayer->StartTransaction() != OGRERR_NONE)
+        return CE_Failure;
+
+    size_t iZone = 0;
+    poZonesLayer->ResetReading();
+    for (auto &&poZoneFeature : *poZonesLayer)
+    {
+        if (iZone == nZones)
+            break;
+
+        OGRFeature oOutFeature(poOutLayer->GetLayerDefn());
+        if (bIncludeFields)
+            oOutFeature.SetFrom(poZoneFeature.get(), TRUE);
+        if (bIncludeGeometry)
+        {
+            if (!bIncludeFields)
+                oOutFeature.SetGeometry(poZoneFeature->GetGeometryRef());
+        }
+        else
+        {
+            oOutFeature.SetGeometryDirectly(nullptr);
+        }
+
+        const ZoneStats *pasStats = &sContext.aoStats[iZone * nBands];
+        for (const auto &sField : aoOutputFields)
+        {
+            const ZoneStats &sStats = pasStats[sField.iBand];
+            const bool bHasValues = sStats.dfCount > 0;
+            switch (sField.eStat)
+            {
+                case OutputField::Stat::COUNT:
+                    oOutFeature.SetField(sField.iField, sStats.dfCount);
+                    break;
+                case OutputField::Stat::SUM:
+                    oOutFeature.SetField(sField.iField, sStats.dfSum);
+                    break;
+                case OutputField::Stat::MEAN:
+                    if (bHasValues)
+                        oOutFeature.SetField(sField.iField,
+                                             sStats.dfSum / sStats.dfCount);
+                    break;
+                case OutputField::Stat::MIN:
+                    if (bHasValues)
+                        oOutFeature.SetField(sField.iField, sStats.dfMin);
+                    break;
+                case OutputField::Stat::MAX:
+                    if (bHasValues)
+                        oOutFeature.SetField(sField.iField, sStats.dfMax);
+                    break;
+                case OutputField::Stat::HISTOGRAM:
+                {
+                    std::string osHistogram;
+                    for (int i = 0; i < sContext.nHistogramBins; ++i)
+                    {
+                        if (i > 0)
+                            osHistogram += ',';
+                        const double dfVal = sStats.adfHistogram.empty()
+                                                 ? 0
+                                                 : sStats.adfHistogram[i];
+                        osHistogram += bFractional ? CPLSPrintf("%.6g", dfVal)
+                                                   : CPLSPrintf("%.0f", dfVal);
+                    }
+                    oOutFeature.SetField(sField.iField, osHistogram.c_str());
+                    break;
+                }
+            }
+        }
+
+        if (poOutLayer->CreateFeature(&oOutFeature) != OGRERR_NONE)
+        {
+            eErr = CE_Failure;
+            break;
+        }
+        ++iZone;
+
+        if (bUseTransactions && (iZone % TRANSACTION_SIZE) == 0)
+        {
+            if (poOutLayer->CommitTransaction() != OGRERR_NONE ||
+                poOutLayer->StartTransaction() != OGRERR_NONE)
+            {
+                eErr = CE_Failure;
+                break;
+            }
+        }
+
+        if (!pfnProgress(0.9 + 0.1 * static_cast<double>(iZone) / nZones, "",
+                         pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+            break;
+        }
+    }
+
+    if (bUseTransactions)
+    {
+        if (eErr == CE_None)
+        {
+            if (poOutLayer->CommitTransaction() != OGRERR_NONE)
+                eErr = CE_Failure;
+        }
+        else
+        {
+            poOutLayer->RollbackTransaction();
+        }
+    }
+
+    if (eErr == CE_None)
+        pfnProgress(1.0, "", pProgressArg);
+
+    return eErr;
+}
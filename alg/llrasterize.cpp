@@ -39,6 +39,7 @@
 #include <utility>
 #include <vector>
 
+#include "cpl_worker_thread_pool.h"
 #include "gdal_alg.h"
 
 /************************************************************************/
@@ -71,153 +72,216 @@
  * the GDAL MIT license (pulled from the OpenEV distribution).
  */
 
-void GDALdllImageFilledPolygon(int nRasterXSize, int nRasterYSize,
-                               int nPartCount, const int *panPartSize,
-                               const double *padfX, const double *padfY,
-                               const double *dfVariant,
-                               llScanlineFunc pfnScanlineFunc, void *pCBData,
-                               bool bAvoidBurningSamePoints)
+namespace
 {
-    if (!nPartCount)
-    {
-        return;
-    }
+// Non-horizontal polygon edge, with dy1 < dy2
+struct LLEdge
+{
+    double dx1;
+    double dy1;
+    double dx2;
+    double dy2;
+    int nFirstRow;  // first row whose center might be crossed by the edge
+};
+
+// "Bottom" horizontal edge, filled separately, on the row whose center
+// it lies on.
+struct LLHorizontalEdge
+{
+    int nRow;
+    int nX1;
+    int nX2;
+};
+}  // namespace
+
+/************************************************************************/
+/*                   GDALdllImageFilledPolygonRows()                    */
+/************************************************************************/
 
+// Scan conversion of rows [nYStart, nYEnd] with an active edge table: edges
+// are sorted by the first row they may cross, and only the edges crossing
+// the current row are considered, instead of all edges of the polygon.
+// The intersection of an edge with a row center is computed with the same
+// expression as in the historical implementation, to get the exact same
+// pixels.
+static void GDALdllImageFilledPolygonRows(
+    int nYStart, int nYEnd, int nRasterXSize, int nPartCount,
+    const int *panPartSize, const double *padfX, const double *padfY,
+    const double *dfVariant, llScanlineFunc pfnScanlineFunc, void *pCBData,
+    bool bAvoidBurningSamePoints)
+{
+    const int minx = 0;
+    const int maxx = nRasterXSize - 1;
+    const double dfVariant0 = dfVariant == nullptr ? 0 : dfVariant[0];
+    const double dfYStart = nYStart + 0.5;
+    const double dfYEnd = nYEnd + 0.5;
+
+    /* -------------------------------------------------------------------- */
+    /*      Build the edge tables.                                          */
+    /* -------------------------------------------------------------------- */
+    std::vector<LLEdge> asEdges;
+    std::vector<LLHorizontalEdge> asHorizontalEdges;
     int n = 0;
     for (int part = 0; part < nPartCount; part++)
         n += panPartSize[part];
 
-    std::vector<int> polyInts(n);
-    std::vector<int> polyInts2;
-    if (bAvoidBurningSamePoints)
-        polyInts2.resize(n);
-
-    double dminy = padfY[0];
-    double dmaxy = padfY[0];
-    for (int i = 1; i < n; i++)
+    int partoffset = 0;
+    int part = 0;
+    for (int i = 0; i < n; i++)
     {
-        if (padfY[i] < dminy)
+        if (i == partoffset + panPartSize[part])
         {
-            dminy = padfY[i];
+            partoffset += panPartSize[part];
+            part++;
         }
-        if (padfY[i] > dmaxy)
+
+        int ind1 = 0;
+        int ind2 = 0;
+        if (i == partoffset)
         {
-            dmaxy = padfY[i];
+            ind1 = partoffset + panPartSize[part] - 1;
+            ind2 = partoffset;
+        }
+        else
+        {
+            ind1 = i - 1;
+            ind2 = i;
         }
-    }
-    int miny = static_cast<int>(dminy);
-    int maxy = static_cast<int>(dmaxy);
 
-    if (miny < 0)
-        miny = 0;
-    if (maxy >= nRasterYSize)
-        maxy = nRasterYSize - 1;
+        const double dy1 = padfY[ind1];
+        const double dy2 = padfY[ind2];
+        if (dy1 == dy2)
+        {
+            // AE: DO NOT skip bottom horizontal segments
+            // -Fill them separately-
+            // Skip top horizontal segments.
+            // They are already filled in the regular loop.
+            if (!(padfX[ind1] > padfX[ind2]) || !(dy1 >= dfYStart) ||
+                !(dy1 <= dfYEnd))
+                continue;
+            const double dfRow = std::floor(dy1 - 0.5);
+            if (dfRow + 0.5 != dy1)
+                continue;  // not on a row center
+            const int horizontal_x1 =
+                static_cast<int>(floor(padfX[ind2] + 0.5));
+            const int horizontal_x2 =
+                static_cast<int>(floor(padfX[ind1] + 0.5));
+            if ((horizontal_x1 > maxx) || (horizontal_x2 <= minx))
+                continue;
+            asHorizontalEdges.push_back(
+                {static_cast<int>(dfRow), horizontal_x1, horizontal_x2});
+            continue;
+        }
 
-    int minx = 0;
-    const int maxx = nRasterXSize - 1;
+        LLEdge sEdge;
+        if (dy1 < dy2)
+        {
+            sEdge.dx1 = padfX[ind1];
+            sEdge.dy1 = dy1;
+            sEdge.dx2 = padfX[ind2];
+            sEdge.dy2 = dy2;
+        }
+        else if (dy1 > dy2)
+        {
+            sEdge.dx1 = padfX[ind2];
+            sEdge.dy1 = dy2;
+            sEdge.dx2 = padfX[ind1];
+            sEdge.dy2 = dy1;
+        }
+        else
+        {
+            continue;  // NaN
+        }
+        // The edge crosses the center dy of a row if dy1 <= dy < dy2
+        if (sEdge.dy2 <= dfYStart || sEdge.dy1 > dfYEnd)
+            continue;
+        // Possibly one row before the first one actually crossed, which
+        // is harmless, as the exact test is done in the scan loop.
+        sEdge.nFirstRow = static_cast<int>(std::max(
+            static_cast<double>(nYStart), std::floor(sEdge.dy1 - 0.5)));
+        asEdges.push_back(sEdge);
+    }
 
-    // Fix in 1.3: count a vertex only once.
-    for (int y = miny; y <= maxy; y++)
+    std::sort(asEdges.begin(), asEdges.end(),
+              [](const LLEdge &a, const LLEdge &b)
+              { return a.nFirstRow < b.nFirstRow; });
+    std::sort(asHorizontalEdges.begin(), asHorizontalEdges.end(),
+              [](const LLHorizontalEdge &a, const LLHorizontalEdge &b)
+              { return a.nRow < b.nRow; });
+
+    /* -------------------------------------------------------------------- */
+    /*      Scan rows.                                                      */
+    /* -------------------------------------------------------------------- */
+    std::vector<const LLEdge *> apsActiveEdges;
+    std::vector<int> polyInts;
+    std::vector<int> polyInts2;
+    size_t iNextEdge = 0;
+    size_t iNextHorizontalEdge = 0;
+    for (int y = nYStart; y <= nYEnd; y++)
     {
-        int partoffset = 0;
-
         const double dy = y + 0.5;  // Center height of line.
 
-        int part = 0;
-        int ints = 0;
-        int ints2 = 0;
-
-        for (int i = 0; i < n; i++)
+        while (iNextEdge < asEdges.size() &&
+               asEdges[iNextEdge].nFirstRow <= y)
         {
-            if (i == partoffset + panPartSize[part])
-            {
-                partoffset += panPartSize[part];
-                part++;
-            }
-
-            int ind1 = 0;
-            int ind2 = 0;
-            if (i == partoffset)
-            {
-                ind1 = partoffset + panPartSize[part] - 1;
-                ind2 = partoffset;
-            }
-            else
-            {
-                ind1 = i - 1;
-                ind2 = i;
-            }
-
-            double dy1 = padfY[ind1];
-            double dy2 = padfY[ind2];
+            apsActiveEdges.push_back(&asEdges[iNextEdge]);
+            ++iNextEdge;
+        }
 
-            if ((dy1 < dy && dy2 < dy) || (dy1 > dy && dy2 > dy))
-                continue;
+        polyInts.clear();
+        polyInts2.clear();
 
-            double dx1 = 0.0;
-            double dx2 = 0.0;
-            if (dy1 < dy2)
+        for (size_t k = 0; k < apsActiveEdges.size();)
+        {
+            const LLEdge &sEdge = *apsActiveEdges[k];
+            if (dy >= sEdge.dy2)
             {
-                dx1 = padfX[ind1];
-                dx2 = padfX[ind2];
+                // Edge fully processed
+                apsActiveEdges[k] = apsActiveEdges.back();
+                apsActiveEdges.pop_back();
+                continue;
             }
-            else if (dy1 > dy2)
+            if (dy >= sEdge.dy1)
             {
-                std::swap(dy1, dy2);
-                dx2 = padfX[ind1];
-                dx1 = padfX[ind2];
+                const double intersect =
+                    (dy - sEdge.dy1) * (sEdge.dx2 - sEdge.dx1) /
+                        (sEdge.dy2 - sEdge.dy1) +
+                    sEdge.dx1;
+                polyInts.push_back(static_cast<int>(floor(intersect + 0.5)));
             }
-            else  // if( fabs(dy1-dy2) < 1.e-6 )
-            {
-
-                // AE: DO NOT skip bottom horizontal segments
-                // -Fill them separately-
-                if (padfX[ind1] > padfX[ind2])
-                {
-                    const int horizontal_x1 =
-                        static_cast<int>(floor(padfX[ind2] + 0.5));
-                    const int horizontal_x2 =
-                        static_cast<int>(floor(padfX[ind1] + 0.5));
-
-                    if ((horizontal_x1 > maxx) || (horizontal_x2 <= minx))
-                        continue;
+            ++k;
+        }
 
-                    // Fill the horizontal segment (separately from the rest).
-                    if (bAvoidBurningSamePoints)
-                    {
-                        polyInts2[ints2++] = horizontal_x1;
-                        polyInts2[ints2++] = horizontal_x2;
-                    }
-                    else
-                    {
-                        pfnScanlineFunc(
-                            pCBData, y, horizontal_x1, horizontal_x2 - 1,
-                            dfVariant == nullptr ? 0 : dfVariant[0]);
-                    }
-                }
-                // else: Skip top horizontal segments.
-                // They are already filled in the regular loop.
+        while (iNextHorizontalEdge < asHorizontalEdges.size() &&
+               asHorizontalEdges[iNextHorizontalEdge].nRow <= y)
+        {
+            const auto &sHEdge = asHorizontalEdges[iNextHorizontalEdge];
+            ++iNextHorizontalEdge;
+            if (sHEdge.nRow < y)
                 continue;
+            if (bAvoidBurningSamePoints)
+            {
+                polyInts2.push_back(sHEdge.nX1);
+                polyInts2.push_back(sHEdge.nX2);
             }
-
-            if (dy < dy2 && dy >= dy1)
+            else
             {
-                const double intersect =
-                    (dy - dy1) * (dx2 - dx1) / (dy2 - dy1) + dx1;
-
-                polyInts[ints++] = static_cast<int>(floor(intersect + 0.5));
+                pfnScanlineFunc(pCBData, y, sHEdge.nX1, sHEdge.nX2 - 1,
+                                dfVariant0);
             }
         }
 
-        std::sort(polyInts.begin(), polyInts.begin() + ints);
-        std::sort(polyInts2.begin(), polyInts2.begin() + ints2);
+        const int ints = static_cast<int>(polyInts.size());
+        const int ints2 = static_cast<int>(polyInts2.size());
+        std::sort(polyInts.begin(), polyInts.end());
+        std::sort(polyInts2.begin(), polyInts2.end());
 
         for (int i = 0; i + 1 < ints; i += 2)
         {
             if (polyInts[i] <= maxx && polyInts[i + 1] > minx)
             {
                 pfnScanlineFunc(pCBData, y, polyInts[i], polyInts[i + 1] - 1,
-                                dfVariant == nullptr ? 0 : dfVariant[0]);
+                                dfVariant0);
             }
         }
 
@@ -225,7 +289,7 @@ void GDALdllImageFilledPolygon(int nRasterXSize, int nRasterYSize,
         {
             if (polyInts2[i2] <= maxx && polyInts2[i2 + 1] > minx)
             {
-                // "synchronize" polyInts[i] with polyInts2[i2]
+                // "synchronize" polyInts[i] with polyInts2[i2]
                 while (i + 1 < ints && polyInts[i] < polyInts2[i2])
                     i += 2;
                 // Only burn if we don't have a common segment between
@@ -233,14 +297,128 @@ void GDALdllImageFilledPolygon(int nRasterXSize, int nRasterYSize,
                 if (i + 1 >= ints || polyInts[i] != polyInts2[i2])
                 {
                     pfnScanlineFunc(pCBData, y, polyInts2[i2],
-                                    polyInts2[i2 + 1] - 1,
-                                    dfVariant == nullptr ? 0 : dfVariant[0]);
+                                    polyInts2[i2 + 1] - 1, dfVariant0);
                 }
             }
         }
     }
 }
 
+namespace
+{
+struct LLFilledPolygonJob
+{
+    int nYStart;
+    int nYEnd;
+    int nRasterXSize;
+    int nPartCount;
+    const int *panPartSize;
+    const double *padfX;
+    const double *padfY;
+    const double *dfVariant;
+    llScanlineFunc pfnScanlineFunc;
+    void *pCBData;
+    bool bAvoidBurningSamePoints;
+};
+}  // namespace
+
+static void GDALdllImageFilledPolygonJob(void *pData)
+{
+    const auto psJob = static_cast<const LLFilledPolygonJob *>(pData);
+    GDALdllImageFilledPolygonRows(
+        psJob->nYStart, psJob->nYEnd, psJob->nRasterXSize, psJob->nPartCount,
+        psJob->panPartSize, psJob->padfX, psJob->padfY, psJob->dfVariant,
+        psJob->pfnScanlineFunc, psJob->pCBData,
+        psJob->bAvoidBurningSamePoints);
+}
+
+// If poThreadPool is not null, the rows of large polygons are split among
+// its threads. pfnScanlineFunc must then support being called concurrently
+// for different rows.
+void GDALdllImageFilledPolygon(int nRasterXSize, int nRasterYSize,
+                               int nPartCount, const int *panPartSize,
+                               const double *padfX, const double *padfY,
+                               const double *dfVariant,
+                               llScanlineFunc pfnScanlineFunc, void *pCBData,
+                               bool bAvoidBurningSamePoints,
+                               CPLWorkerThreadPool *poThreadPool)
+{
+    if (!nPartCount)
+    {
+        return;
+    }
+
+    int n = 0;
+    for (int part = 0; part < nPartCount; part++)
+        n += panPartSize[part];
+    if (n == 0)
+        return;
+
+    double dminy = padfY[0];
+    double dmaxy = padfY[0];
+    for (int i = 1; i < n; i++)
+    {
+        if (padfY[i] < dminy)
+        {
+            dminy = padfY[i];
+        }
+        if (padfY[i] > dmaxy)
+        {
+            dmaxy = padfY[i];
+        }
+    }
+    int miny = static_cast<int>(dminy);
+    int maxy = static_cast<int>(dmaxy);
+
+    if (miny < 0)
+        miny = 0;
+    if (maxy >= nRasterYSize)
+        maxy = nRasterYSize - 1;
+    if (miny > maxy)
+        return;
+
+    // Only worth for polygons with many vertices and rows
+    constexpr int MIN_ROWS_PER_JOB = 64;
+    constexpr int MIN_VERTICES_FOR_THREADS = 10000;
+    const int nRows = maxy - miny + 1;
+    const int nJobs =
+        poThreadPool && n >= MIN_VERTICES_FOR_THREADS
+            ? std::min(poThreadPool->GetThreadCount(), nRows / MIN_ROWS_PER_JOB)
+            : 1;
+    if (nJobs <= 1)
+    {
+        GDALdllImageFilledPolygonRows(miny, maxy, nRasterXSize, nPartCount,
+                                      panPartSize, padfX, padfY, dfVariant,
+                                      pfnScanlineFunc, pCBData,
+                                      bAvoidBurningSamePoints);
+        return;
+    }
+
+    auto poJobQueue = poThreadPool->CreateJobQueue();
+    std::vector<LLFilledPolygonJob> asJobs(nJobs);
+    for (int i = 0; i < nJobs; ++i)
+    {
+        auto &sJob = asJobs[i];
+        sJob.nYStart = miny + static_cast<int>(static_cast<int64_t>(nRows) *
+                                               i / nJobs);
+        sJob.nYEnd = miny +
+                     static_cast<int>(static_cast<int64_t>(nRows) * (i + 1) /
+                                      nJobs) -
+                     1;
+        sJob.nRasterXSize = nRasterXSize;
+        sJob.nPartCount = nPartCount;
+        sJob.panPartSize = panPartSize;
+        sJob.padfX = padfX;
+        sJob.padfY = padfY;
+        sJob.dfVariant = dfVariant;
+        sJob.pfnScanlineFunc = pfnScanlineFunc;
+        sJob.pCBData = pCBData;
+        sJob.bAvoidBurningSamePoints = bAvoidBurningSamePoints;
+        poJobQueue->SubmitJob(GDALdllImageFilledPolygonJob, &sJob);
+    }
+    poJobQueue->WaitCompletion();
+}
+
 /************************************************************************/
 /*                         GDALdllImagePoint()                          */
 /************************************************************************/
@@ -69,6 +69,15 @@ class ContourGenerator
         return CE_None;
     }
 
+    // Start processing at line startLine rather than at the first line,
+    // previousLine being the content of line startLine - 1. This allows
+    // independent bands of lines to be processed.
+    void setStartLine(size_t startLine, const double *previousLine)
+    {
+        lineIdx_ = startLine;
+        std::copy(previousLine, previousLine + width_, previousLine_.begin());
+    }
+
   private:
     size_t width_;
     size_t height_;
@@ -35,9 +35,11 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -50,6 +52,8 @@
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 
 #include "polygonize_polygonizer.h"
 
@@ -81,6 +85,288 @@ static CPLErr GPMaskImageData(GDALRasterBandH hMaskBand, GByte *pabyMaskLine,
     return CE_None;
 }
 
+/************************************************************************/
+/*                       Multi-threaded first pass                      */
+/*                                                                      */
+/*      The raster is split into bands of rows whose polygon ids are    */
+/*      enumerated independently by worker threads.  The ids of the    */
+/*      polygons crossing the seams between two bands are then merged   */
+/*      by comparing the last line of a band with the first line of     */
+/*      the next one.                                                   */
+/************************************************************************/
+
+template <class DataType, class EqualityTest> struct GPLabelBand
+{
+    int nYStart = 0;
+    int nYEnd = 0;
+    // Local polygon id to final (global) polygon id.
+    std::vector<GInt32> anIdMap{};
+    // Pixel values and local polygon ids of the first and last lines.
+    std::vector<DataType> anFirstLineVal{};
+    std::vector<GInt32> anFirstLineId{};
+    std::vector<DataType> anLastLineVal{};
+    std::vector<GInt32> anLastLineId{};
+};
+
+template <class DataType, class EqualityTest> struct GPLabelContext
+{
+    GDALRasterBandH hSrcBand = nullptr;
+    GDALRasterBandH hMaskBand = nullptr;
+    GDALDataType eDT = GDT_Unknown;
+    int nXSize = 0;
+    int nConnectedness = 4;
+    std::mutex oIOMutex{};  // RasterIO() is not thread-safe
+    std::atomic<bool> bStop{false};
+};
+
+template <class DataType, class EqualityTest> struct GPLabelJob
+{
+    GPLabelContext<DataType, EqualityTest> *psContext = nullptr;
+    GPLabelBand<DataType, EqualityTest> *psBand = nullptr;
+};
+
+/************************************************************************/
+/*                          GPLabelBandJobFunc()                        */
+/************************************************************************/
+
+template <class DataType, class EqualityTest>
+static void GPLabelBandJobFunc(void *pData)
+{
+    auto psJob = static_cast<GPLabelJob<DataType, EqualityTest> *>(pData);
+    auto psContext = psJob->psContext;
+    auto psBand = psJob->psBand;
+    const int nXSize = psContext->nXSize;
+
+    if (psContext->bStop)
+        return;
+
+    std::vector<DataType> anLastLineVal, anThisLineVal;
+    std::vector<GInt32> anLastLineId, anThisLineId;
+    std::vector<GByte> abyMaskLine;
+    try
+    {
+        anLastLineVal.resize(nXSize);
+        anThisLineVal.resize(nXSize);
+        anLastLineId.resize(nXSize);
+        anThisLineId.resize(nXSize);
+        if (psContext->hMaskBand)
+            abyMaskLine.resize(nXSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALPolygonize()");
+        psContext->bStop = true;
+        return;
+    }
+
+    GDALRasterPolygonEnumeratorT<DataType, EqualityTest> oEnum(
+        psContext->nConnectedness);
+
+    for (int iY = psBand->nYStart; iY < psBand->nYEnd; ++iY)
+    {
+        if (psContext->bStop)
+            return;
+
+        {
+            std::lock_guard<std::mutex> oLock(psContext->oIOMutex);
+            CPLErr eErr = GDALRasterIO(psContext->hSrcBand, GF_Read, 0, iY,
+                                       nXSize, 1, anThisLineVal.data(), nXSize,
+                                       1, psContext->eDT, 0, 0);
+            if (eErr == CE_None && psContext->hMaskBand != nullptr)
+                eErr = GPMaskImageData(psContext->hMaskBand,
+                                       abyMaskLine.data(), iY, nXSize,
+                                       anThisLineVal.data());
+            if (eErr != CE_None)
+            {
+                psContext->bStop = true;
+                return;
+            }
+        }
+
+        const bool bFirstLine = iY == psBand->nYStart;
+        if (!oEnum.ProcessLine(bFirstLine ? nullptr : anLastLineVal.data(),
+                               anThisLineVal.data(),
+                               bFirstLine ? nullptr : anLastLineId.data(),
+                               anThisLineId.data(), nXSize))
+        {
+            psContext->bStop = true;
+            return;
+        }
+
+        if (bFirstLine)
+        {
+            psBand->anFirstLineVal = anThisLineVal;
+            psBand->anFirstLineId = anThisLineId;
+        }
+
+        std::swap(anLastLineVal, anThisLineVal);
+        std::swap(anLastLineId, anThisLineId);
+    }
+
+    oEnum.CompleteMerges();
+
+    psBand->anLastLineVal = std::move(anLastLineVal);
+    psBand->anLastLineId = std::move(anLastLineId);
+    psBand->anIdMap.assign(oEnum.panPolyIdMap,
+                           oEnum.panPolyIdMap + oEnum.nNextPolygonId);
+}
+
+/************************************************************************/
+/*                          GPFindRootId()                              */
+/************************************************************************/
+
+static GInt32 GPFindRootId(std::vector<GInt32> &anParent, GInt32 nId)
+{
+    while (anParent[nId] != nId)
+    {
+        anParent[nId] = anParent[anParent[nId]];
+        nId = anParent[nId];
+    }
+    return nId;
+}
+
+/************************************************************************/
+/*                     GPLabelBandsMultiThreaded()                      */
+/*                                                                      */
+/*      Equivalent of the first pass of GDALPolygonizeT(), run in       */
+/*      parallel over bands of rows. On success, each band holds the    */
+/*      mapping from the ids that a GDALRasterPolygonEnumeratorT        */
+/*      restarted at its first line will assign, to final polygon ids   */
+/*      that are unique over the whole raster.                          */
+/************************************************************************/
+
+template <class DataType, class EqualityTest>
+static CPLErr GPLabelBandsMultiThreaded(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand, GDALDataType eDT,
+    int nConnectedness, CPLWorkerThreadPool *poThreadPool,
+    std::vector<GPLabelBand<DataType, EqualityTest>> &asBands,
+    GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    GPLabelContext<DataType, EqualityTest> sContext;
+    sContext.hSrcBand = hSrcBand;
+    sContext.hMaskBand = hMaskBand;
+    sContext.eDT = eDT;
+    sContext.nXSize = GDALGetRasterBandXSize(hSrcBand);
+    sContext.nConnectedness = nConnectedness;
+
+    std::vector<GPLabelJob<DataType, EqualityTest>> asJobs(asBands.size());
+    for (size_t i = 0; i < asBands.size(); ++i)
+    {
+        asJobs[i].psContext = &sContext;
+        asJobs[i].psBand = &asBands[i];
+    }
+
+    auto poJobQueue = poThreadPool->CreateJobQueue();
+    for (auto &sJob : asJobs)
+        poJobQueue->SubmitJob(GPLabelBandJobFunc<DataType, EqualityTest>,
+                              &sJob);
+    for (size_t i = asJobs.size(); i > 0; --i)
+    {
+        poJobQueue->WaitCompletion(static_cast<int>(i - 1));
+        if (!sContext.bStop &&
+            !pfnProgress(0.10 * (asJobs.size() - i + 1) / asJobs.size(), "",
+                         pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            sContext.bStop = true;
+        }
+    }
+    poJobQueue->WaitCompletion();
+
+    if (sContext.bStop)
+        return CE_Failure;
+
+    /* -------------------------------------------------------------------- */
+    /*      Make the polygon ids of each band global.                       */
+    /* -------------------------------------------------------------------- */
+    GIntBig nTotalIds = 0;
+    for (auto &sBand : asBands)
+    {
+        // The largest id is reserved by the polygonizer for the outer polygon
+        if (nTotalIds + static_cast<GIntBig>(sBand.anIdMap.size()) >=
+            std::numeric_limits<GInt32>::max())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "GDALPolygonize(): maximum number of polygons reached");
+            return CE_Failure;
+        }
+        const GInt32 nOffset = static_cast<GInt32>(nTotalIds);
+        for (auto &nId : sBand.anIdMap)
+            nId += nOffset;
+        nTotalIds += static_cast<GIntBig>(sBand.anIdMap.size());
+    }
+
+    std::vector<GInt32> anParent;
+    try
+    {
+        anParent.resize(static_cast<size_t>(nTotalIds));
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALPolygonize()");
+        return CE_Failure;
+    }
+    for (GInt32 i = 0; i < static_cast<GInt32>(nTotalIds); ++i)
+        anParent[i] = i;
+
+    /* -------------------------------------------------------------------- */
+    /*      Merge the polygons crossing seams, applying the same            */
+    /*      connectivity rules as GDALRasterPolygonEnumeratorT.             */
+    /* -------------------------------------------------------------------- */
+    const int nXSize = sContext.nXSize;
+    EqualityTest eq;
+    for (size_t iBand = 1; iBand < asBands.size(); ++iBand)
+    {
+        const auto &sAbove = asBands[iBand - 1];
+        const auto &sBelow = asBands[iBand];
+        const auto Merge = [&](int iXAbove, int iXBelow)
+        {
+            const GInt32 nIdAbove = sAbove.anLastLineId[iXAbove];
+            const GInt32 nIdBelow = sBelow.anFirstLineId[iXBelow];
+            if (nIdAbove < 0 || nIdBelow < 0 ||
+                !eq(sAbove.anLastLineVal[iXAbove],
+                    sBelow.anFirstLineVal[iXBelow]))
+                return;
+            const GInt32 nRootAbove =
+                GPFindRootId(anParent, sAbove.anIdMap[nIdAbove]);
+            const GInt32 nRootBelow =
+                GPFindRootId(anParent, sBelow.anIdMap[nIdBelow]);
+            if (nRootAbove != nRootBelow)
+                anParent[std::max(nRootAbove, nRootBelow)] =
+                    std::min(nRootAbove, nRootBelow);
+        };
+        for (int iX = 0; iX < nXSize; ++iX)
+        {
+            Merge(iX, iX);
+            if (nConnectedness == 8)
+            {
+                if (iX > 0)
+                    Merge(iX - 1, iX);
+                if (iX < nXSize - 1)
+                    Merge(iX + 1, iX);
+            }
+        }
+    }
+
+    for (auto &sBand : asBands)
+    {
+        for (auto &nId : sBand.anIdMap)
+            nId = GPFindRootId(anParent, nId);
+        sBand.anFirstLineVal.clear();
+        sBand.anFirstLineId.clear();
+        sBand.anLastLineVal.clear();
+        sBand.anLastLineId.clear();
+    }
+
+    CPLDebug("GDALPolygonize",
+             "Enumerated " CPL_FRMT_GIB " polygon fragments in %d bands.",
+             nTotalIds, static_cast<int>(asBands.size()));
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                           GDALPolygonizeT()                          */
 /************************************************************************/
@@ -182,6 +468,40 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         adfGeoTransform[5] = 1;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Split the raster into bands of rows that are enumerated in      */
+    /*      parallel if several threads are requested.                      */
+    /* -------------------------------------------------------------------- */
+    const char *pszNumThreads = CSLFetchNameValueDef(
+        papszOptions, "NUM_THREADS",
+        CPLGetConfigOption("GDAL_NUM_THREADS", nullptr));
+    int nThreads = 1;
+    if (pszNumThreads)
+    {
+        nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+        nThreads = std::max(1, std::min(nThreads, 128));
+    }
+    constexpr int MIN_ROWS_PER_BAND = 256;
+    const int nBandCount =
+        std::min(nThreads * 4, nYSize / MIN_ROWS_PER_BAND);
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 && nBandCount > 1 ? GDALGetGlobalThreadPool(nThreads)
+                                       : nullptr;
+
+    std::vector<GPLabelBand<DataType, EqualityTest>> asBands;
+    if (poThreadPool)
+    {
+        asBands.resize(nBandCount);
+        for (int i = 0; i < nBandCount; ++i)
+        {
+            asBands[i].nYStart =
+                static_cast<int>(static_cast<GIntBig>(nYSize) * i / nBandCount);
+            asBands[i].nYEnd = static_cast<int>(static_cast<GIntBig>(nYSize) *
+                                                (i + 1) / nBandCount);
+        }
+    }
+
     /* -------------------------------------------------------------------- */
     /*      The first pass over the raster is only used to build up the     */
     /*      polygon id map so we will know in advance what polygons are     */
@@ -192,7 +512,14 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
 
     CPLErr eErr = CE_None;
 
-    for (int iY = 0; eErr == CE_None && iY < nYSize; iY++)
+    if (poThreadPool)
+    {
+        eErr = GPLabelBandsMultiThreaded(hSrcBand, hMaskBand, eDT,
+                                         nConnectedness, poThreadPool, asBands,
+                                         pfnProgress, pProgressArg);
+    }
+
+    for (int iY = 0; !poThreadPool && eErr == CE_None && iY < nYSize; iY++)
     {
         eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iY, nXSize, 1, panThisLineVal,
                             nXSize, 1, eDT, 0, 0);
@@ -240,15 +567,20 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
     /*      points to the final id it should use, not an intermediate       */
     /*      value.                                                          */
     /* -------------------------------------------------------------------- */
-    if (eErr == CE_None)
+    if (eErr == CE_None && !poThreadPool)
         oFirstEnum.CompleteMerges();
 
     /* -------------------------------------------------------------------- */
     /*      We will use a new enumerator for the second pass primarily      */
-    /*      so we can preserve the first pass map.                          */
+    /*      so we can preserve the first pass map.  In multi-threaded      */
+    /*      mode, it is restarted at the first line of each band, so that   */
+    /*      it assigns the same ids as the enumerator of the band.          */
     /* -------------------------------------------------------------------- */
-    GDALRasterPolygonEnumeratorT<DataType, EqualityTest> oSecondEnum(
-        nConnectedness);
+    auto poSecondEnum =
+        std::make_unique<GDALRasterPolygonEnumeratorT<DataType, EqualityTest>>(
+            nConnectedness);
+    const GInt32 *panPolyIdMap = oFirstEnum.panPolyIdMap;
+    size_t iCurBand = 0;
 
     OGRPolygonWriter<DataType> oPolygonWriter{hOutLayer, iPixValField,
                                               adfGeoTransform};
@@ -305,17 +637,32 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
                 panThisLineId[iX] =
                     decltype(oPolygonizer)::THE_OUTER_POLYGON_ID;
         }
-        else if (iY == 0)
+        else if (iY == 0 || (poThreadPool && iCurBand < asBands.size() &&
+                             iY == asBands[iCurBand].nYStart))
         {
-            eErr = oSecondEnum.ProcessLine(nullptr, panThisLineVal, nullptr,
-                                           panThisLineId, nXSize)
+            if (poThreadPool)
+            {
+                if (iY > 0)
+                {
+                    asBands[iCurBand - 1].anIdMap.clear();
+                    asBands[iCurBand - 1].anIdMap.shrink_to_fit();
+                    poSecondEnum = std::make_unique<
+                        GDALRasterPolygonEnumeratorT<DataType, EqualityTest>>(
+                        nConnectedness);
+                }
+                panPolyIdMap = asBands[iCurBand].anIdMap.data();
+                ++iCurBand;
+            }
+            eErr = poSecondEnum->ProcessLine(nullptr, panThisLineVal, nullptr,
+                                             panThisLineId, nXSize)
                        ? CE_None
                        : CE_Failure;
         }
         else
         {
-            eErr = oSecondEnum.ProcessLine(panLastLineVal, panThisLineVal,
-                                           panLastLineId, panThisLineId, nXSize)
+            eErr = poSecondEnum->ProcessLine(panLastLineVal, panThisLineVal,
+                                             panLastLineId, panThisLineId,
+                                             nXSize)
                        ? CE_None
                        : CE_Failure;
         }
@@ -330,10 +677,9 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
                 // TODO: maybe we can reserve -1 as the lookup result for -1 polygon id in the panPolyIdMap,
                 //       so the this expression becomes: panLastLineId[iX] = *(oFirstEnum.panPolyIdMap + panThisLineId[iX]).
                 //       This would eliminate the condition checking.
-                panLastLineId[iX] =
-                    panThisLineId[iX] == -1
-                        ? -1
-                        : oFirstEnum.panPolyIdMap[panThisLineId[iX]];
+                panLastLineId[iX] = panThisLineId[iX] == -1
+                                        ? -1
+                                        : panPolyIdMap[panThisLineId[iX]];
             }
 
             oPolygonizer.processLine(panLastLineId, panLastLineVal,
@@ -491,6 +837,13 @@ GBool GDALFloatEquals(float A, float B)
  * <li>DATASET_FOR_GEOREF=dataset_name: Name of a dataset from which to read
  * the geotransform. This useful if hSrcBand has no related dataset, which is
  * typical for mask bands.</li>
+ * <li>NUM_THREADS=number_of_threads or ALL_CPUS: (GDAL >= 3.9) Number of
+ * worker threads used to enumerate the polygons of bands of rows in parallel,
+ * before merging the polygons crossing the seams between bands. The tracing
+ * and writing of polygons remains sequential, and finished polygons are still
+ * written as soon as they are complete. The order of the output features may
+ * differ from the single-threaded mode. Defaults to the value of the
+ * GDAL_NUM_THREADS configuration option, or 1.</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
@@ -565,6 +918,13 @@ CPLErr CPL_STDCALL GDALPolygonize(GDALRasterBandH hSrcBand,
  * <li>DATASET_FOR_GEOREF=dataset_name: Name of a dataset from which to read
  * the geotransform. This useful if hSrcBand has no related dataset, which is
  * typical for mask bands.</li>
+ * <li>NUM_THREADS=number_of_threads or ALL_CPUS: (GDAL >= 3.9) Number of
+ * worker threads used to enumerate the polygons of bands of rows in parallel,
+ * before merging the polygons crossing the seams between bands. The tracing
+ * and writing of polygons remains sequential, and finished polygons are still
+ * written as soon as they are complete. The order of the output features may
+ * differ from the single-threaded mode. Defaults to the value of the
+ * GDAL_NUM_THREADS configuration option, or 1.</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
@@ -37,14 +37,17 @@
 #include <algorithm>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 /************************************************************************/
 /*                           GDALFilterLine()                           */
@@ -360,6 +363,162 @@ inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
     }
 }
 
+/************************************************************************/
+/*                     GDALFillNodataInterpolateLine()                  */
+/*                                                                      */
+/*      Interpolate the nodata pixels of line iY from the closest     */
+/*      valid pixels of each quadrant, as found by the top-down pass  */
+/*      and by the bottom-up pass up to the line below (panLastY and  */
+/*      pafLastValue).  A line only depends on its inputs, so lines   */
+/*      can be interpolated in any order.                             */
+/************************************************************************/
+
+static void GDALFillNodataInterpolateLine(
+    int iY, int nXSize, double dfMaxSearchDist, int nMaxSearchDist,
+    GUInt32 nNoDataVal, bool bHasNoData, float fNoData,
+    const GUInt32 *panTopDownY, const float *pafTopDownValue,
+    const GUInt32 *panLastY, const float *pafLastValue, GByte *pabyMask,
+    float *pafScanline, GByte *pabyFiltMask)
+{
+    memset(pabyFiltMask, 0, nXSize);
+    for (int iX = 0; iX < nXSize; iX++)
+    {
+        int nThisMaxSearchDist = nMaxSearchDist;
+
+        // If this was a valid target - no change.
+        if (pabyMask[iX])
+            continue;
+
+        // Quadrants 0:topleft, 1:bottomleft, 2:topright, 3:bottomright
+        double adfQuadDist[4] = {};
+        float fQuadValue[4] = {};
+
+        for (int iQuad = 0; iQuad < 4; iQuad++)
+        {
+            adfQuadDist[iQuad] = dfMaxSearchDist + 1.0;
+            fQuadValue[iQuad] = 0.0;
+        }
+
+        // Step left and right by one pixel searching for the closest
+        // target value for each quadrant.
+        for (int iStep = 0; iStep <= nThisMaxSearchDist; iStep++)
+        {
+            const int iLeftX = std::max(0, iX - iStep);
+            const int iRightX = std::min(nXSize - 1, iX + iStep);
+
+            // Top left includes current line.
+            QUAD_CHECK(adfQuadDist[0], fQuadValue[0], iLeftX,
+                       panTopDownY[iLeftX], iX, iY, pafTopDownValue[iLeftX],
+                       nNoDataVal);
+
+            // Bottom left.
+            QUAD_CHECK(adfQuadDist[1], fQuadValue[1], iLeftX,
+                       panLastY[iLeftX], iX, iY, pafLastValue[iLeftX],
+                       nNoDataVal);
+
+            // Top right and bottom right do no include center pixel.
+            if (iStep == 0)
+                continue;
+
+            // Top right includes current line.
+            QUAD_CHECK(adfQuadDist[2], fQuadValue[2], iRightX,
+                       panTopDownY[iRightX], iX, iY,
+                       pafTopDownValue[iRightX], nNoDataVal);
+
+            // Bottom right.
+            QUAD_CHECK(adfQuadDist[3], fQuadValue[3], iRightX,
+                       panLastY[iRightX], iX, iY, pafLastValue[iRightX],
+                       nNoDataVal);
+
+            // Every four steps, recompute maximum distance.
+            if ((iStep & 0x3) == 0)
+                nThisMaxSearchDist = static_cast<int>(floor(
+                    std::max(std::max(adfQuadDist[0], adfQuadDist[1]),
+                             std::max(adfQuadDist[2], adfQuadDist[3]))));
+        }
+
+        double dfWeightSum = 0.0;
+        double dfValueSum = 0.0;
+        bool bHasSrcValues = false;
+
+        for (int iQuad = 0; iQuad < 4; iQuad++)
+        {
+            if (adfQuadDist[iQuad] <= dfMaxSearchDist)
+            {
+                bHasSrcValues = true;
+                if (!bHasNoData || fQuadValue[iQuad] != fNoData)
+                {
+                    const double dfWeight = 1.0 / adfQuadDist[iQuad];
+                    dfWeightSum += dfWeight;
+                    dfValueSum += fQuadValue[iQuad] * dfWeight;
+                }
+            }
+        }
+
+        if (bHasSrcValues)
+        {
+            pabyFiltMask[iX] = 255;
+            if (dfWeightSum > 0.0)
+            {
+                pabyMask[iX] = 255;
+                pafScanline[iX] = static_cast<float>(dfValueSum / dfWeightSum);
+            }
+            else
+                pafScanline[iX] = fNoData;
+        }
+    }
+}
+
+/************************************************************************/
+/*                     GDALFillNodataInterpolateLines()                 */
+/************************************************************************/
+
+namespace
+{
+struct GDALFillNodataBatchJob
+{
+    int iYBatchStart = 0;
+    int nLines = 0;
+    int iFirstLine = 0;  // relative to iYBatchStart
+    int nLineStep = 1;
+    int nXSize = 0;
+    double dfMaxSearchDist = 0;
+    int nMaxSearchDist = 0;
+    GUInt32 nNoDataVal = 0;
+    bool bHasNoData = false;
+    float fNoData = 0;
+    const GUInt32 *panTopDownY = nullptr;
+    const float *pafTopDownValue = nullptr;
+    const GUInt32 *panBottomUpY = nullptr;
+    const float *pafBottomUpValue = nullptr;
+    GByte *pabyMask = nullptr;
+    float *pafScanline = nullptr;
+    GByte *pabyFiltMask = nullptr;
+};
+}  // namespace
+
+// Interpolates one of every nLineStep lines of a batch, starting at
+// iFirstLine. Line k of the batch is at offset k * nXSize of the buffers,
+// and the bottom-up state of the line below it at offset (k + 1) * nXSize.
+static void GDALFillNodataInterpolateLines(void *pData)
+{
+    const auto psJob = static_cast<const GDALFillNodataBatchJob *>(pData);
+    const size_t nXSize = psJob->nXSize;
+    for (int k = psJob->iFirstLine; k < psJob->nLines; k += psJob->nLineStep)
+    {
+        const size_t nOffset = k * nXSize;
+        GDALFillNodataInterpolateLine(
+            psJob->iYBatchStart + k, psJob->nXSize, psJob->dfMaxSearchDist,
+            psJob->nMaxSearchDist, psJob->nNoDataVal, psJob->bHasNoData,
+            psJob->fNoData, psJob->panTopDownY + nOffset,
+            psJob->pafTopDownValue + nOffset,
+            psJob->panBottomUpY + nOffset + nXSize,
+            psJob->pafBottomUpValue + nOffset + nXSize,
+            psJob->pabyMask + nOffset, psJob->pafScanline + nOffset,
+            psJob->pabyFiltMask + nOffset);
+    }
+}
+
 /************************************************************************/
 /*                           GDALFillNodata()                           */
 /************************************************************************/
@@ -397,6 +556,11 @@ inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
  * <li>NODATA=value (starting with GDAL 2.4).
  * Source pixels at that value will be ignored by the interpolator. Warning:
  * currently this will not be honored by smoothing passes.</li>
+ * <li>NUM_THREADS=number_of_threads or ALL_CPUS: (GDAL >= 3.9) Number of
+ * worker threads used to interpolate batches of lines in parallel. The result
+ * is identical to the single-threaded mode. Smoothing passes remain
+ * sequential. Defaults to the value of the GDAL_NUM_THREADS configuration
+ * option, or 1.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -588,6 +752,36 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
     GDALRasterBandH hFiltMaskBand =
         GDALRasterBand::FromHandle(poFiltMaskDS->GetRasterBand(1));
 
+    /* -------------------------------------------------------------------- */
+    /*      The bottom-up pass interpolates batches of lines, in parallel   */
+    /*      if several threads are requested.  Batches are sized to keep    */
+    /*      the threads busy, with about 64 MB of buffers at most.          */
+    /* -------------------------------------------------------------------- */
+    const char *pszNumThreads =
+        CSLFetchNameValueDef(papszOptions, "NUM_THREADS",
+                             CPLGetConfigOption("GDAL_NUM_THREADS", nullptr));
+    int nThreads = 1;
+    if (pszNumThreads)
+    {
+        nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+        nThreads = std::max(1, std::min(nThreads, 128));
+    }
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 && nYSize > 1 ? GDALGetGlobalThreadPool(nThreads)
+                                   : nullptr;
+    int nBatchLines = 1;
+    if (poThreadPool)
+    {
+        // Mask, filter mask, scanline, top-down and bottom-up states.
+        constexpr int BYTES_PER_PIXEL = 2 + 5 * 4;
+        const GIntBig nMaxLines =
+            (64 * 1024 * 1024) /
+            (BYTES_PER_PIXEL * static_cast<GIntBig>(nXSize));
+        nBatchLines = static_cast<int>(std::max<GIntBig>(
+            1, std::min<GIntBig>(std::min(nThreads * 8, nYSize), nMaxLines)));
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Allocate buffers for last scanline and this scanline.           */
     /* -------------------------------------------------------------------- */
@@ -596,24 +790,31 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         static_cast<GUInt32 *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(GUInt32)));
     GUInt32 *panThisY =
         static_cast<GUInt32 *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(GUInt32)));
-    GUInt32 *panTopDownY =
-        static_cast<GUInt32 *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(GUInt32)));
+    GUInt32 *panTopDownY = static_cast<GUInt32 *>(
+        VSI_MALLOC3_VERBOSE(nXSize, nBatchLines, sizeof(GUInt32)));
+    GUInt32 *panBottomUpY = static_cast<GUInt32 *>(
+        VSI_MALLOC3_VERBOSE(nXSize, nBatchLines + 1, sizeof(GUInt32)));
     float *pafLastValue =
         static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
     float *pafThisValue =
         static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
-    float *pafTopDownValue =
-        static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
-    float *pafScanline =
-        static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
-    GByte *pabyMask = static_cast<GByte *>(VSI_CALLOC_VERBOSE(nXSize, 1));
-    GByte *pabyFiltMask = static_cast<GByte *>(VSI_CALLOC_VERBOSE(nXSize, 1));
+    float *pafTopDownValue = static_cast<float *>(
+        VSI_MALLOC3_VERBOSE(nXSize, nBatchLines, sizeof(float)));
+    float *pafBottomUpValue = static_cast<float *>(
+        VSI_MALLOC3_VERBOSE(nXSize, nBatchLines + 1, sizeof(float)));
+    float *pafScanline = static_cast<float *>(
+        VSI_MALLOC3_VERBOSE(nXSize, nBatchLines, sizeof(float)));
+    GByte *pabyMask =
+        static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nXSize, nBatchLines));
+    GByte *pabyFiltMask =
+        static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nXSize, nBatchLines));
 
     CPLErr eErr = CE_None;
 
     if (panLastY == nullptr || panThisY == nullptr || panTopDownY == nullptr ||
-        pafLastValue == nullptr || pafThisValue == nullptr ||
-        pafTopDownValue == nullptr || pafScanline == nullptr ||
+        panBottomUpY == nullptr || pafLastValue == nullptr ||
+        pafThisValue == nullptr || pafTopDownValue == nullptr ||
+        pafBottomUpValue == nullptr || pafScanline == nullptr ||
         pabyMask == nullptr || pabyFiltMask == nullptr)
     {
         eErr = CE_Failure;
@@ -720,205 +921,188 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
     /*      Now we will do collect similar this/last information from       */
     /*      bottom to top and use it in combination with the top to         */
     /*      bottom search info to interpolate.                              */
+    /*                                                                      */
+    /*      This is done by batches of lines (a single line in              */
+    /*      single-threaded mode): the bottom-up state of each line is      */
+    /*      computed sequentially, then the lines of the batch, which are   */
+    /*      independent, are interpolated, and finally written out.        */
+    /*      Line k of the batch is line iYBatchStart + k, and slot          */
+    /*      nLines of the bottom-up state is the state of the line below    */
+    /*      the batch.                                                      */
     /* ==================================================================== */
-    for (int iY = nYSize - 1; iY >= 0 && eErr == CE_None; iY--)
+    for (int iYBatchEnd = nYSize; iYBatchEnd > 0 && eErr == CE_None;
+         iYBatchEnd -= nBatchLines)
     {
-        eErr = GDALRasterIO(hMaskBand, GF_Read, 0, iY, nXSize, 1, pabyMask,
-                            nXSize, 1, GDT_Byte, 0, 0);
+        const int iYBatchStart = std::max(0, iYBatchEnd - nBatchLines);
+        const int nLines = iYBatchEnd - iYBatchStart;
+        memcpy(panBottomUpY + static_cast<size_t>(nLines) * nXSize, panLastY,
+               sizeof(GUInt32) * nXSize);
+        memcpy(pafBottomUpValue + static_cast<size_t>(nLines) * nXSize,
+               pafLastValue, sizeof(float) * nXSize);
+
+        for (int iY = iYBatchEnd - 1; iY >= iYBatchStart && eErr == CE_None;
+             iY--)
+        {
+            const size_t nOffset =
+                static_cast<size_t>(iY - iYBatchStart) * nXSize;
+            GByte *pabyLineMask = pabyMask + nOffset;
+            float *pafLineScanline = pafScanline + nOffset;
 
-        if (eErr != CE_None)
-            break;
+            eErr = GDALRasterIO(hMaskBand, GF_Read, 0, iY, nXSize, 1,
+                                pabyLineMask, nXSize, 1, GDT_Byte, 0, 0);
 
-        eErr = GDALRasterIO(hTargetBand, GF_Read, 0, iY, nXSize, 1, pafScanline,
-                            nXSize, 1, GDT_Float32, 0, 0);
+            if (eErr != CE_None)
+                break;
 
-        if (eErr != CE_None)
-            break;
+            eErr = GDALRasterIO(hTargetBand, GF_Read, 0, iY, nXSize, 1,
+                                pafLineScanline, nXSize, 1, GDT_Float32, 0, 0);
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Figure out the most recent pixel for each column. */
-        /* --------------------------------------------------------------------
-         */
+            if (eErr != CE_None)
+                break;
 
-        for (int iX = 0; iX < nXSize; iX++)
-        {
-            if (pabyMask[iX])
-            {
-                pafThisValue[iX] = pafScanline[iX];
-                panThisY[iX] = iY;
-            }
-            else if (panLastY[iX] - iY <= dfMaxSearchDist)
+            /* ----------------------------------------------------------------
+             */
+            /*      Figure out the most recent pixel for each column. */
+            /* ----------------------------------------------------------------
+             */
+            const GUInt32 *panBelowY = panBottomUpY + nOffset + nXSize;
+            const float *pafBelowValue = pafBottomUpValue + nOffset + nXSize;
+            GUInt32 *panLineY = panBottomUpY + nOffset;
+            float *pafLineValue = pafBottomUpValue + nOffset;
+            for (int iX = 0; iX < nXSize; iX++)
             {
-                pafThisValue[iX] = pafLastValue[iX];
-                panThisY[iX] = panLastY[iX];
-            }
-            else
-            {
-                panThisY[iX] = nNoDataVal;
+                if (pabyLineMask[iX])
+                {
+                    pafLineValue[iX] = pafLineScanline[iX];
+                    panLineY[iX] = iY;
+                }
+                else if (panBelowY[iX] - iY <= dfMaxSearchDist)
+                {
+                    pafLineValue[iX] = pafBelowValue[iX];
+                    panLineY[iX] = panBelowY[iX];
+                }
+                else
+                {
+                    // The value is ignored when the line is nodata.
+                    pafLineValue[iX] = pafBelowValue[iX];
+                    panLineY[iX] = nNoDataVal;
+                }
             }
-        }
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Load the last y and corresponding value from the top down pass.
-         */
-        /* --------------------------------------------------------------------
-         */
-        eErr = GDALRasterIO(hYBand, GF_Read, 0, iY, nXSize, 1, panTopDownY,
-                            nXSize, 1, GDT_UInt32, 0, 0);
+            /* ----------------------------------------------------------------
+             */
+            /*      Load the last y and corresponding value from the top down
+             */
+            /*      pass. */
+            /* ----------------------------------------------------------------
+             */
+            eErr = GDALRasterIO(hYBand, GF_Read, 0, iY, nXSize, 1,
+                                panTopDownY + nOffset, nXSize, 1, GDT_UInt32,
+                                0, 0);
 
-        if (eErr != CE_None)
-            break;
+            if (eErr != CE_None)
+                break;
 
-        eErr = GDALRasterIO(hValBand, GF_Read, 0, iY, nXSize, 1,
-                            pafTopDownValue, nXSize, 1, GDT_Float32, 0, 0);
+            eErr = GDALRasterIO(hValBand, GF_Read, 0, iY, nXSize, 1,
+                                pafTopDownValue + nOffset, nXSize, 1,
+                                GDT_Float32, 0, 0);
+        }
 
         if (eErr != CE_None)
             break;
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Attempt to interpolate any pixels that are nodata. */
-        /* --------------------------------------------------------------------
-         */
-        memset(pabyFiltMask, 0, nXSize);
-        for (int iX = 0; iX < nXSize; iX++)
+        // Carry the state of the first line of the batch to the next one.
+        memcpy(panLastY, panBottomUpY, sizeof(GUInt32) * nXSize);
+        memcpy(pafLastValue, pafBottomUpValue, sizeof(float) * nXSize);
+
+        /* ----------------------------------------------------------------- */
+        /*      Attempt to interpolate any pixels that are nodata.           */
+        /* ----------------------------------------------------------------- */
+        GDALFillNodataBatchJob sJob;
+        sJob.iYBatchStart = iYBatchStart;
+        sJob.nLines = nLines;
+        sJob.nXSize = nXSize;
+        sJob.dfMaxSearchDist = dfMaxSearchDist;
+        sJob.nMaxSearchDist = nMaxSearchDist;
+        sJob.nNoDataVal = nNoDataVal;
+        sJob.bHasNoData = bHasNoData;
+        sJob.fNoData = fNoData;
+        sJob.panTopDownY = panTopDownY;
+        sJob.pafTopDownValue = pafTopDownValue;
+        sJob.panBottomUpY = panBottomUpY;
+        sJob.pafBottomUpValue = pafBottomUpValue;
+        sJob.pabyMask = pabyMask;
+        sJob.pafScanline = pafScanline;
+        sJob.pabyFiltMask = pabyFiltMask;
+        if (poThreadPool && nLines > 1)
         {
-            int nThisMaxSearchDist = nMaxSearchDist;
-
-            // If this was a valid target - no change.
-            if (pabyMask[iX])
-                continue;
-
-            // Quadrants 0:topleft, 1:bottomleft, 2:topright, 3:bottomright
-            double adfQuadDist[4] = {};
-            float fQuadValue[4] = {};
-
-            for (int iQuad = 0; iQuad < 4; iQuad++)
-            {
-                adfQuadDist[iQuad] = dfMaxSearchDist + 1.0;
-                fQuadValue[iQuad] = 0.0;
-            }
-
-            // Step left and right by one pixel searching for the closest
-            // target value for each quadrant.
-            for (int iStep = 0; iStep <= nThisMaxSearchDist; iStep++)
+            const int nJobs = std::min(nThreads, nLines);
+            std::vector<GDALFillNodataBatchJob> asJobs(nJobs, sJob);
+            auto poJobQueue = poThreadPool->CreateJobQueue();
+            for (int i = 0; i < nJobs; ++i)
             {
-                const int iLeftX = std::max(0, iX - iStep);
-                const int iRightX = std::min(nXSize - 1, iX + iStep);
-
-                // Top left includes current line.
-                QUAD_CHECK(adfQuadDist[0], fQuadValue[0], iLeftX,
-                           panTopDownY[iLeftX], iX, iY, pafTopDownValue[iLeftX],
-                           nNoDataVal);
-
-                // Bottom left.
-                QUAD_CHECK(adfQuadDist[1], fQuadValue[1], iLeftX,
-                           panLastY[iLeftX], iX, iY, pafLastValue[iLeftX],
-                           nNoDataVal);
-
-                // Top right and bottom right do no include center pixel.
-                if (iStep == 0)
-                    continue;
-
-                // Top right includes current line.
-                QUAD_CHECK(adfQuadDist[2], fQuadValue[2], iRightX,
-                           panTopDownY[iRightX], iX, iY,
-                           pafTopDownValue[iRightX], nNoDataVal);
-
-                // Bottom right.
-                QUAD_CHECK(adfQuadDist[3], fQuadValue[3], iRightX,
-                           panLastY[iRightX], iX, iY, pafLastValue[iRightX],
-                           nNoDataVal);
-
-                // Every four steps, recompute maximum distance.
-                if ((iStep & 0x3) == 0)
-                    nThisMaxSearchDist = static_cast<int>(floor(
-                        std::max(std::max(adfQuadDist[0], adfQuadDist[1]),
-                                 std::max(adfQuadDist[2], adfQuadDist[3]))));
-            }
-
-            double dfWeightSum = 0.0;
-            double dfValueSum = 0.0;
-            bool bHasSrcValues = false;
-
-            for (int iQuad = 0; iQuad < 4; iQuad++)
-            {
-                if (adfQuadDist[iQuad] <= dfMaxSearchDist)
-                {
-                    bHasSrcValues = true;
-                    if (!bHasNoData || fQuadValue[iQuad] != fNoData)
-                    {
-                        const double dfWeight = 1.0 / adfQuadDist[iQuad];
-                        dfWeightSum += dfWeight;
-                        dfValueSum += fQuadValue[iQuad] * dfWeight;
-                    }
-                }
-            }
-
-            if (bHasSrcValues)
-            {
-                pabyFiltMask[iX] = 255;
-                if (dfWeightSum > 0.0)
-                {
-                    pabyMask[iX] = 255;
-                    pafScanline[iX] =
-                        static_cast<float>(dfValueSum / dfWeightSum);
-                }
-                else
-                    pafScanline[iX] = fNoData;
+                asJobs[i].iFirstLine = i;
+                asJobs[i].nLineStep = nJobs;
+                poJobQueue->SubmitJob(GDALFillNodataInterpolateLines,
+                                      &asJobs[i]);
             }
+            poJobQueue->WaitCompletion();
+        }
+        else
+        {
+            GDALFillNodataInterpolateLines(&sJob);
         }
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Write out the updated data and mask information. */
-        /* --------------------------------------------------------------------
-         */
-        eErr = GDALRasterIO(hTargetBand, GF_Write, 0, iY, nXSize, 1,
-                            pafScanline, nXSize, 1, GDT_Float32, 0, 0);
-
-        if (eErr != CE_None)
-            break;
-
-        if (poTmpMaskDS != nullptr)
+        for (int iY = iYBatchEnd - 1; iY >= iYBatchStart && eErr == CE_None;
+             iY--)
         {
-            // Update (copy of) mask band when it has been provided by the
-            // user
-            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iY, nXSize, 1, pabyMask,
-                                nXSize, 1, GDT_Byte, 0, 0);
+            const size_t nOffset =
+                static_cast<size_t>(iY - iYBatchStart) * nXSize;
+
+            /* ----------------------------------------------------------------
+             */
+            /*      Write out the updated data and mask information. */
+            /* ----------------------------------------------------------------
+             */
+            eErr = GDALRasterIO(hTargetBand, GF_Write, 0, iY, nXSize, 1,
+                                pafScanline + nOffset, nXSize, 1, GDT_Float32,
+                                0, 0);
 
             if (eErr != CE_None)
                 break;
-        }
 
-        eErr = GDALRasterIO(hFiltMaskBand, GF_Write, 0, iY, nXSize, 1,
-                            pabyFiltMask, nXSize, 1, GDT_Byte, 0, 0);
+            if (poTmpMaskDS != nullptr)
+            {
+                // Update (copy of) mask band when it has been provided by the
+                // user
+                eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iY, nXSize, 1,
+                                    pabyMask + nOffset, nXSize, 1, GDT_Byte, 0,
+                                    0);
+
+                if (eErr != CE_None)
+                    break;
+            }
 
-        if (eErr != CE_None)
-            break;
+            eErr = GDALRasterIO(hFiltMaskBand, GF_Write, 0, iY, nXSize, 1,
+                                pabyFiltMask + nOffset, nXSize, 1, GDT_Byte, 0,
+                                0);
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Flip this/last buffers. */
-        /* --------------------------------------------------------------------
-         */
-        std::swap(pafThisValue, pafLastValue);
-        std::swap(panThisY, panLastY);
+            if (eErr != CE_None)
+                break;
 
-        /* --------------------------------------------------------------------
-         */
-        /*      report progress. */
-        /* --------------------------------------------------------------------
-         */
-        if (!pfnProgress(
-                dfProgressRatio *
-                    (0.5 + 0.5 * (nYSize - iY) / static_cast<double>(nYSize)),
-                "Filling...", pProgressArg))
-        {
-            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-            eErr = CE_Failure;
+            /* ----------------------------------------------------------------
+             */
+            /*      report progress. */
+            /* ----------------------------------------------------------------
+             */
+            if (!pfnProgress(dfProgressRatio *
+                                 (0.5 + 0.5 * (nYSize - iY) /
+                                            static_cast<double>(nYSize)),
+                             "Filling...", pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                eErr = CE_Failure;
+            }
         }
     }
 
@@ -954,9 +1138,11 @@ end:
     CPLFree(panLastY);
     CPLFree(panThisY);
     CPLFree(panTopDownY);
+    CPLFree(panBottomUpY);
     CPLFree(pafLastValue);
     CPLFree(pafThisValue);
     CPLFree(pafTopDownValue);
+    CPLFree(pafBottomUpValue);
     CPLFree(pafScanline);
     CPLFree(pabyMask);
     CPLFree(pabyFiltMask);
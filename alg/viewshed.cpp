@@ -28,19 +28,25 @@
 #include "cpl_port.h"
 #include "gdal_alg.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
 #include <cstring>
-#include <array>
+#include <functional>
 #include <limits>
-#include <algorithm>
+#include <mutex>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_spatialref.h"
 #include "ogr_core.h"
@@ -117,413 +123,856 @@ inline static double CalcHeight(double dfZ, double dfZ2, GDALViewshedMode eMode)
         return dfZ;
 }
 
-/************************************************************************/
-/*                        GDALViewshedGenerate()                         */
-/************************************************************************/
+namespace
+{
 
-/**
- * Create viewshed from raster DEM.
- *
- * This algorithm will generate a viewshed raster from an input DEM raster
- * by using a modified algorithm of "Generating Viewsheds without Using
- * Sightlines" published at
- * https://www.asprs.org/wp-content/uploads/pers/2000journal/january/2000_jan_87-90.pdf
- * This appoach provides a relatively fast calculation, since the output raster
- * is generated in a single scan. The gdal/apps/gdal_viewshed.cpp mainline can
- * be used as an example of how to use this function. The output raster will be
- * of type Byte or Float64.
- *
- * \note The algorithm as implemented currently will only output meaningful
- * results if the georeferencing is in a projected coordinate reference system.
- *
- * @param hBand The band to read the DEM data from. Only the part of the raster
- * within the specified maxdistance around the observer point is processed.
- *
- * @param pszDriverName Driver name (GTiff if set to NULL)
- *
- * @param pszTargetRasterName The name of the target raster to be generated.
- * Must not be NULL
- *
- * @param papszCreationOptions creation options.
- *
- * @param dfObserverX observer X value (in SRS units)
- *
- * @param dfObserverY observer Y value (in SRS units)
- *
- * @param dfObserverHeight The height of the observer above the DEM surface.
- *
- * @param dfTargetHeight The height of the target above the DEM surface.
- * (default 0)
- *
- * @param dfVisibleVal pixel value for visibility (default 255)
- *
- * @param dfInvisibleVal pixel value for invisibility (default 0)
- *
- * @param dfOutOfRangeVal The value to be set for the cells that fall outside of
- * the range specified by dfMaxDistance.
- *
- * @param dfNoDataVal The value to be set for the cells that have no data.
- *                    If set to a negative value, nodata is not set.
- *                    Note: currently, no special processing of input cells at a
- * nodata value is done (which may result in erroneous results).
- *
- * @param dfCurvCoeff Coefficient to consider the effect of the curvature and
- * refraction. The height of the DEM is corrected according to the following
- * formula: [Height] -= dfCurvCoeff * [Target Distance]^2 / [Earth Diameter] For
- * the effect of the atmospheric refraction we can use 0.85714.
- *
- * @param eMode The mode of the viewshed calculation.
- * Possible values GVM_Diagonal = 1, GVM_Edge = 2 (default), GVM_Max = 3,
- * GVM_Min = 4.
- *
- * @param dfMaxDistance maximum distance range to compute viewshed.
- *                      It is also used to clamp the extent of the output
- * raster. If set to 0, then unlimited range is assumed, that is to say the
- *                      computation is performed on the extent of the whole
- * raster.
- *
- * @param pfnProgress A GDALProgressFunc that may be used to report progress
- * to the user, or to interrupt the algorithm.  May be NULL if not required.
- *
- * @param pProgressArg The callback data for the pfnProgress function.
- *
- * @param heightMode Type of information contained in output raster. Possible
- * values GVOT_NORMAL = 1 (default), GVOT_MIN_TARGET_HEIGHT_FROM_DEM = 2,
- *                   GVOT_MIN_TARGET_HEIGHT_FROM_GROUND = 3
- *
- *                   GVOT_NORMAL returns a raster of type Byte containing
- * visible locations.
- *
- *                   GVOT_MIN_TARGET_HEIGHT_FROM_DEM and
- * GVOT_MIN_TARGET_HEIGHT_FROM_GROUND will return a raster of type Float64
- * containing the minimum target height for target to be visible from the DEM
- * surface or ground level respectively. Parameters dfTargetHeight, dfVisibleVal
- * and dfInvisibleVal will be ignored.
- *
- *
- * @param papszExtraOptions Future extra options. Must be set to NULL currently.
- *
- * @return not NULL output dataset on success (to be closed with GDALClose()) or
- * NULL if an error occurs.
- *
- * @since GDAL 3.1
- */
+/** Parameters of the viewshed computation of an observer, relative to its
+ * area of interest. */
+struct ViewshedParams
+{
+    std::array<double, 6> adfGeoTransform{{0.0, 1.0, 0.0, 0.0, 0.0, 1.0}};
+    int nX = 0;      // Column of the observer.
+    int nXSize = 0;  // Width of the area of interest.
+    double dfZObserver = 0.0;
+    double dfTargetHeight = 0.0;
+    double dfDistance2 = 0.0;
+    double dfCurvCoeff = 0.0;
+    double dfSphereDiameter = std::numeric_limits<double>::infinity();
+    GDALViewshedMode eMode = GVM_Edge;
+    GDALViewshedOutputType heightMode = GVOT_NORMAL;
+    GByte byVisibleVal = 255;
+    GByte byInvisibleVal = 0;
+    GByte byOutOfRangeVal = 0;
+    double dfOutOfRangeVal = 0.0;
+};
+
+/** Progress of tasks that may run concurrently. */
+struct ViewshedProgress
+{
+    std::mutex oMutex{};
+    GDALProgressFunc pfnProgress = nullptr;
+    void *pProgressArg = nullptr;
+    double dfTotal = 1.0;
+    double dfDone = 0.0;
+    std::atomic<bool> bStop{false};
+
+    bool Advance(double dfAmount)
+    {
+        std::lock_guard<std::mutex> oLock(oMutex);
+        if (bStop)
+            return false;
+        dfDone += dfAmount;
+        if (!pfnProgress(std::min(1.0, dfDone / dfTotal), "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            bStop = true;
+            return false;
+        }
+        return true;
+    }
+};
+
+/** Reads the DEM values of columns [nXOff, nXOff + nXCount) of a line of the
+ * area of interest in padfLine[nXOff, nXOff + nXCount). */
+typedef std::function<bool(int iLine, int nXOff, int nXCount,
+                           double *padfLine)>
+    ViewshedReadFunc;
+
+/** Writes the results of columns [nXOff, nXOff + nXCount) of a line of the
+ * area of interest. */
+typedef std::function<bool(int iLine, int nXOff, int nXCount,
+                           GByte *pabyResult, double *padfHeightResult)>
+    ViewshedWriteFunc;
+
+/** Scan of the lines above or below the observer line, on the left and/or
+ * right of the observer column. */
+struct ViewshedHalfScan
+{
+    const ViewshedParams *psParams = nullptr;
+    int nY = 0;          // Line of the observer.
+    int nYStep = 0;      // -1 to scan upwards, 1 to scan downwards.
+    int nLineCount = 0;  // Number of lines to scan after the observer line.
+    bool bLeft = true;
+    bool bRight = true;
+    const double *padfFirstLineVal = nullptr;  // Processed observer line.
+    ViewshedReadFunc pfnRead{};
+    ViewshedWriteFunc pfnWrite{};
+    ViewshedProgress *psProgress = nullptr;
+    bool bOK = false;
+};
+
+/** Data shared by the observer tasks of a cumulative viewshed. */
+struct ViewshedCumulativeContext
+{
+    const ViewshedParams *psParams = nullptr;
+    const double *padfInvGeoTransform = nullptr;
+    const double *padfDEM = nullptr;
+    int nXSize = 0;
+    int nYSize = 0;
+    double dfObserverHeight = 0.0;
+    double dfMaxDistance = 0.0;
+    GUInt32 *panCounts = nullptr;
+    std::mutex *poCountsMutex = nullptr;
+    ViewshedProgress *psProgress = nullptr;
+};
+
+/** Task computing the viewshed of one observer of a cumulative viewshed. */
+struct ViewshedObserverTask
+{
+    const ViewshedCumulativeContext *psContext = nullptr;
+    int nX = 0;
+    int nY = 0;
+    bool bOK = false;
+};
 
-GDALDatasetH GDALViewshedGenerate(
-    GDALRasterBandH hBand, const char *pszDriverName,
-    const char *pszTargetRasterName, CSLConstList papszCreationOptions,
-    double dfObserverX, double dfObserverY, double dfObserverHeight,
-    double dfTargetHeight, double dfVisibleVal, double dfInvisibleVal,
-    double dfOutOfRangeVal, double dfNoDataVal, double dfCurvCoeff,
-    GDALViewshedMode eMode, double dfMaxDistance, GDALProgressFunc pfnProgress,
-    void *pProgressArg, GDALViewshedOutputType heightMode,
-    CSLConstList papszExtraOptions)
+}  // namespace
 
-{
-    VALIDATE_POINTER1(hBand, "GDALViewshedGenerate", nullptr);
-    VALIDATE_POINTER1(pszTargetRasterName, "GDALViewshedGenerate", nullptr);
+/************************************************************************/
+/*                     ViewshedProcessFirstLine()                       */
+/************************************************************************/
 
-    CPL_IGNORE_RET_VAL(papszExtraOptions);
+// Processes the line of the observer.
+static void ViewshedProcessFirstLine(const ViewshedParams &sParams,
+                                     double *padfFirstLineVal,
+                                     std::vector<GByte> &vResult,
+                                     double *dfHeightResult)
+{
+    const auto &adfGeoTransform = sParams.adfGeoTransform;
+    const int nX = sParams.nX;
+    const int nXSize = sParams.nXSize;
+    const double dfZObserver = sParams.dfZObserver;
+    const double dfTargetHeight = sParams.dfTargetHeight;
+    const double dfDistance2 = sParams.dfDistance2;
+    const double dfCurvCoeff = sParams.dfCurvCoeff;
+    const double dfSphereDiameter = sParams.dfSphereDiameter;
+    const GDALViewshedOutputType heightMode = sParams.heightMode;
+    const GByte byVisibleVal = sParams.byVisibleVal;
+    const GByte byInvisibleVal = sParams.byInvisibleVal;
+    const GByte byOutOfRangeVal = sParams.byOutOfRangeVal;
+    const double dfOutOfRangeVal = sParams.dfOutOfRangeVal;
+    GByte *pabyResult = vResult.data();
+    double dfZ = 0.0;
 
-    if (pfnProgress == nullptr)
-        pfnProgress = GDALDummyProgress;
+    /* mark the observer point as visible */
+    double dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
+                               ? padfFirstLineVal[nX]
+                               : 0.0;
+    pabyResult[nX] = byVisibleVal;
+    if (heightMode != GVOT_NORMAL)
+        dfHeightResult[nX] = dfGroundLevel;
 
-    if (!pfnProgress(0.0, "", pProgressArg))
+    if (nX > 0)
     {
-        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-        return nullptr;
+        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
+                            ? padfFirstLineVal[nX - 1]
+                            : 0.0;
+        CPL_IGNORE_RET_VAL(AdjustHeightInRange(
+            adfGeoTransform.data(), 1, 0, padfFirstLineVal[nX - 1], dfDistance2,
+            dfCurvCoeff, dfSphereDiameter));
+        pabyResult[nX - 1] = byVisibleVal;
+        if (heightMode != GVOT_NORMAL)
+            dfHeightResult[nX - 1] = dfGroundLevel;
+    }
+    if (nX < nXSize - 1)
+    {
+        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
+                            ? padfFirstLineVal[nX + 1]
+                            : 0.0;
+        CPL_IGNORE_RET_VAL(AdjustHeightInRange(
+            adfGeoTransform.data(), 1, 0, padfFirstLineVal[nX + 1], dfDistance2,
+            dfCurvCoeff, dfSphereDiameter));
+        pabyResult[nX + 1] = byVisibleVal;
+        if (heightMode != GVOT_NORMAL)
+            dfHeightResult[nX + 1] = dfGroundLevel;
     }
 
-    const GByte byNoDataVal = dfNoDataVal >= 0 && dfNoDataVal <= 255
-                                  ? static_cast<GByte>(dfNoDataVal)
-                                  : 0;
-    const GByte byVisibleVal = dfVisibleVal >= 0 && dfVisibleVal <= 255
-                                   ? static_cast<GByte>(dfVisibleVal)
-                                   : 255;
-    const GByte byInvisibleVal = dfInvisibleVal >= 0 && dfInvisibleVal <= 255
-                                     ? static_cast<GByte>(dfInvisibleVal)
-                                     : 0;
-    const GByte byOutOfRangeVal = dfOutOfRangeVal >= 0 && dfOutOfRangeVal <= 255
-                                      ? static_cast<GByte>(dfOutOfRangeVal)
-                                      : 0;
-
-    if (heightMode != GVOT_MIN_TARGET_HEIGHT_FROM_DEM &&
-        heightMode != GVOT_MIN_TARGET_HEIGHT_FROM_GROUND)
-        heightMode = GVOT_NORMAL;
+    /* process left direction */
+    for (int iPixel = nX - 2; iPixel >= 0; iPixel--)
+    {
+        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
+                            ? padfFirstLineVal[iPixel]
+                            : 0.0;
+        bool adjusted = AdjustHeightInRange(
+            adfGeoTransform.data(), nX - iPixel, 0, padfFirstLineVal[iPixel],
+            dfDistance2, dfCurvCoeff, dfSphereDiameter);
+        if (adjusted)
+        {
+            dfZ = CalcHeightLine(nX - iPixel, padfFirstLineVal[iPixel + 1],
+                                 dfZObserver);
 
-    /* set up geotransformation */
-    std::array<double, 6> adfGeoTransform{{0.0, 1.0, 0.0, 0.0, 0.0, 1.0}};
-    GDALDatasetH hSrcDS = GDALGetBandDataset(hBand);
-    if (hSrcDS != nullptr)
-        GDALGetGeoTransform(hSrcDS, adfGeoTransform.data());
+            if (heightMode != GVOT_NORMAL)
+                dfHeightResult[iPixel] = std::max(
+                    0.0, (dfZ - padfFirstLineVal[iPixel] + dfGroundLevel));
 
-    double adfInvGeoTransform[6];
-    if (!GDALInvGeoTransform(adfGeoTransform.data(), adfInvGeoTransform))
+            SetVisibility(iPixel, dfZ, dfTargetHeight, padfFirstLineVal,
+                          vResult, byVisibleVal, byInvisibleVal);
+        }
+        else
+        {
+            for (; iPixel >= 0; iPixel--)
+            {
+                pabyResult[iPixel] = byOutOfRangeVal;
+                if (heightMode != GVOT_NORMAL)
+                    dfHeightResult[iPixel] = dfOutOfRangeVal;
+            }
+        }
+    }
+    /* process right direction */
+    for (int iPixel = nX + 2; iPixel < nXSize; iPixel++)
     {
-        CPLError(CE_Failure, CPLE_AppDefined, "Cannot invert geotransform");
-        return nullptr;
+        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
+                            ? padfFirstLineVal[iPixel]
+                            : 0.0;
+        bool adjusted = AdjustHeightInRange(
+            adfGeoTransform.data(), iPixel - nX, 0, padfFirstLineVal[iPixel],
+            dfDistance2, dfCurvCoeff, dfSphereDiameter);
+        if (adjusted)
+        {
+            dfZ = CalcHeightLine(iPixel - nX, padfFirstLineVal[iPixel - 1],
+                                 dfZObserver);
+
+            if (heightMode != GVOT_NORMAL)
+                dfHeightResult[iPixel] = std::max(
+                    0.0, (dfZ - padfFirstLineVal[iPixel] + dfGroundLevel));
+
+            SetVisibility(iPixel, dfZ, dfTargetHeight, padfFirstLineVal,
+                          vResult, byVisibleVal, byInvisibleVal);
+        }
+        else
+        {
+            for (; iPixel < nXSize; iPixel++)
+            {
+                pabyResult[iPixel] = byOutOfRangeVal;
+                if (heightMode != GVOT_NORMAL)
+                    dfHeightResult[iPixel] = dfOutOfRangeVal;
+            }
+        }
     }
+}
 
-    /* calculate observer position */
-    double dfX, dfY;
-    GDALApplyGeoTransform(adfInvGeoTransform, dfObserverX, dfObserverY, &dfX,
-                          &dfY);
-    int nX = static_cast<int>(dfX);
-    int nY = static_cast<int>(dfY);
+/************************************************************************/
+/*                        ViewshedProcessLine()                         */
+/************************************************************************/
 
-    int nXSize = GDALGetRasterBandXSize(hBand);
-    int nYSize = GDALGetRasterBandYSize(hBand);
+// Processes the line at nDistY lines from the observer line, on the left
+// and/or right of the observer column, given the previously processed line
+// (the one closer to the observer line).
+static void ViewshedProcessLine(const ViewshedParams &sParams, int nDistY,
+                                double *padfThisLineVal,
+                                const double *padfLastLineVal,
+                                std::vector<GByte> &vResult,
+                                double *dfHeightResult, bool bLeft, bool bRight)
+{
+    const auto &adfGeoTransform = sParams.adfGeoTransform;
+    const int nX = sParams.nX;
+    const int nXSize = sParams.nXSize;
+    const double dfZObserver = sParams.dfZObserver;
+    const double dfTargetHeight = sParams.dfTargetHeight;
+    const double dfDistance2 = sParams.dfDistance2;
+    const double dfCurvCoeff = sParams.dfCurvCoeff;
+    const double dfSphereDiameter = sParams.dfSphereDiameter;
+    const GDALViewshedMode eMode = sParams.eMode;
+    const GDALViewshedOutputType heightMode = sParams.heightMode;
+    const GByte byVisibleVal = sParams.byVisibleVal;
+    const GByte byInvisibleVal = sParams.byInvisibleVal;
+    const GByte byOutOfRangeVal = sParams.byOutOfRangeVal;
+    const double dfOutOfRangeVal = sParams.dfOutOfRangeVal;
+    GByte *pabyResult = vResult.data();
+    double dfGroundLevel = 0.0;
+    double dfZ = 0.0;
 
-    if (nX < 0 || nX > nXSize || nY < 0 || nY > nYSize)
+    /* set up initial point on the scanline */
+    dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
+                        ? padfThisLineVal[nX]
+                        : 0.0;
+    bool adjusted = AdjustHeightInRange(
+        adfGeoTransform.data(), 0, nDistY, padfThisLineVal[nX],
+        dfDistance2, dfCurvCoeff, dfSphereDiameter);
+    if (adjusted)
     {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "The observer location falls outside of the DEM area");
-        return nullptr;
+        dfZ = CalcHeightLine(nDistY, padfLastLineVal[nX], dfZObserver);
+
+        if (heightMode != GVOT_NORMAL)
+            dfHeightResult[nX] =
+                std::max(0.0, (dfZ - padfThisLineVal[nX] + dfGroundLevel));
+
+        SetVisibility(nX, dfZ, dfTargetHeight, padfThisLineVal, vResult,
+                      byVisibleVal, byInvisibleVal);
+    }
+    else
+    {
+        pabyResult[nX] = byOutOfRangeVal;
+        if (heightMode != GVOT_NORMAL)
+            dfHeightResult[nX] = dfOutOfRangeVal;
     }
 
-    /* calculate the area of interest */
-    int nXStart =
-        dfMaxDistance > 0
-            ? (std::max)(0, static_cast<int>(std::floor(
-                                nX - adfInvGeoTransform[1] * dfMaxDistance)))
-            : 0;
-    int nXStop =
-        dfMaxDistance > 0
-            ? (std::min)(nXSize,
-                         static_cast<int>(std::ceil(nX + adfInvGeoTransform[1] *
-                                                             dfMaxDistance) +
-                                          1))
-            : nXSize;
-    int nYStart =
-        dfMaxDistance > 0
-            ? (std::max)(0, static_cast<int>(std::floor(
-                                nY + adfInvGeoTransform[5] * dfMaxDistance)))
-            : 0;
-    int nYStop =
-        dfMaxDistance > 0
-            ? (std::min)(nYSize,
-                         static_cast<int>(std::ceil(nY - adfInvGeoTransform[5] *
-                                                             dfMaxDistance) +
-                                          1))
-            : nYSize;
 
-    /* normalize horizontal index (0 - nXSize) */
-    nXSize = nXStop - nXStart;
-    nX -= nXStart;
+    if (bLeft)
+    {
+        /* process left direction */
+        for (int iPixel = nX - 1; iPixel >= 0; iPixel--)
+        {
+            dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
+                                ? padfThisLineVal[iPixel]
+                                : 0.0;
+            bool left_adjusted =
+                AdjustHeightInRange(adfGeoTransform.data(), nX - iPixel,
+                                    nDistY, padfThisLineVal[iPixel],
+                                    dfDistance2, dfCurvCoeff, dfSphereDiameter);
+            if (left_adjusted)
+            {
+                if (eMode != GVM_Edge)
+                    dfZ = CalcHeightDiagonal(
+                        nX - iPixel, nDistY, padfThisLineVal[iPixel + 1],
+                        padfLastLineVal[iPixel], dfZObserver);
 
-    nYSize = nYStop - nYStart;
+                if (eMode != GVM_Diagonal)
+                {
+                    double dfZ2 =
+                        nX - iPixel >= nDistY
+                            ? CalcHeightEdge(nDistY, nX - iPixel,
+                                             padfLastLineVal[iPixel + 1],
+                                             padfThisLineVal[iPixel + 1],
+                                             dfZObserver)
+                            : CalcHeightEdge(nX - iPixel, nDistY,
+                                             padfLastLineVal[iPixel + 1],
+                                             padfLastLineVal[iPixel],
+                                             dfZObserver);
+                    dfZ = CalcHeight(dfZ, dfZ2, eMode);
+                }
 
-    if (nXSize == 0 || nYSize == 0)
+                if (heightMode != GVOT_NORMAL)
+                    dfHeightResult[iPixel] = std::max(
+                        0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
+
+                SetVisibility(iPixel, dfZ, dfTargetHeight, padfThisLineVal,
+                              vResult, byVisibleVal, byInvisibleVal);
+            }
+            else
+            {
+                for (; iPixel >= 0; iPixel--)
+                {
+                    pabyResult[iPixel] = byOutOfRangeVal;
+                    if (heightMode != GVOT_NORMAL)
+                        dfHeightResult[iPixel] = dfOutOfRangeVal;
+                }
+            }
+        }
+    }
+    if (bRight)
     {
-        CPLError(CE_Failure, CPLE_AppDefined, "Invalid target raster size");
-        return nullptr;
+        /* process right direction */
+        for (int iPixel = nX + 1; iPixel < nXSize; iPixel++)
+        {
+            dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
+                                ? padfThisLineVal[iPixel]
+                                : 0.0;
+            bool right_adjusted =
+                AdjustHeightInRange(adfGeoTransform.data(), iPixel - nX,
+                                    nDistY, padfThisLineVal[iPixel],
+                                    dfDistance2, dfCurvCoeff, dfSphereDiameter);
+            if (right_adjusted)
+            {
+                if (eMode != GVM_Edge)
+                    dfZ = CalcHeightDiagonal(
+                        iPixel - nX, nDistY, padfThisLineVal[iPixel - 1],
+                        padfLastLineVal[iPixel], dfZObserver);
+
+                if (eMode != GVM_Diagonal)
+                {
+                    double dfZ2 =
+                        iPixel - nX >= nDistY
+                            ? CalcHeightEdge(nDistY, iPixel - nX,
+                                             padfLastLineVal[iPixel - 1],
+                                             padfThisLineVal[iPixel - 1],
+                                             dfZObserver)
+                            : CalcHeightEdge(iPixel - nX, nDistY,
+                                             padfLastLineVal[iPixel - 1],
+                                             padfLastLineVal[iPixel],
+                                             dfZObserver);
+                    dfZ = CalcHeight(dfZ, dfZ2, eMode);
+                }
+
+                if (heightMode != GVOT_NORMAL)
+                    dfHeightResult[iPixel] = std::max(
+                        0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
+
+                SetVisibility(iPixel, dfZ, dfTargetHeight, padfThisLineVal,
+                              vResult, byVisibleVal, byInvisibleVal);
+            }
+            else
+            {
+                for (; iPixel < nXSize; iPixel++)
+                {
+                    pabyResult[iPixel] = byOutOfRangeVal;
+                    if (heightMode != GVOT_NORMAL)
+                        dfHeightResult[iPixel] = dfOutOfRangeVal;
+                }
+            }
+        }
+
     }
+}
+
+/************************************************************************/
+/*                       ViewshedScanHalfFunc()                         */
+/************************************************************************/
+
+// Scans the lines above or below the observer line, from the closest one.
+// The columns on one side of the observer are independent of the ones on
+// the other side, so a half scan can be further split in two. In that case,
+// the observer column is computed by both scans, but only written by the
+// right one.
+static void ViewshedScanHalfFunc(void *pData)
+{
+    ViewshedHalfScan *psScan = static_cast<ViewshedHalfScan *>(pData);
+    const ViewshedParams &sParams = *(psScan->psParams);
+    const int nXSize = sParams.nXSize;
 
-    std::vector<double> vFirstLineVal;
     std::vector<double> vLastLineVal;
     std::vector<double> vThisLineVal;
     std::vector<GByte> vResult;
     std::vector<double> vHeightResult;
-
     try
     {
-        vFirstLineVal.resize(nXSize);
-        vLastLineVal.resize(nXSize);
+        vLastLineVal.assign(psScan->padfFirstLineVal,
+                            psScan->padfFirstLineVal + nXSize);
         vThisLineVal.resize(nXSize);
         vResult.resize(nXSize);
-
-        if (heightMode != GVOT_NORMAL)
+        if (sParams.heightMode != GVOT_NORMAL)
             vHeightResult.resize(nXSize);
     }
     catch (...)
     {
-        CPLError(CE_Failure, CPLE_AppDefined,
+        CPLError(CE_Failure, CPLE_OutOfMemory,
                  "Cannot allocate vectors for viewshed");
-        return nullptr;
+        if (psScan->psProgress)
+            psScan->psProgress->bStop = true;
+        return;
     }
 
-    double *padfFirstLineVal = vFirstLineVal.data();
     double *padfLastLineVal = vLastLineVal.data();
     double *padfThisLineVal = vThisLineVal.data();
-    GByte *pabyResult = vResult.data();
-    double *dfHeightResult = vHeightResult.data();
-
-    GDALDriverManager *hMgr = GetGDALDriverManager();
-    GDALDriver *hDriver =
-        hMgr->GetDriverByName(pszDriverName ? pszDriverName : "GTiff");
-    if (!hDriver)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined, "Cannot get driver");
-        return nullptr;
-    }
+    const int nXOff = psScan->bLeft ? 0 : sParams.nX;
+    const int nXReadEnd =
+        psScan->bRight ? nXSize : std::min(nXSize, sParams.nX + 1);
+    const int nXWriteEnd = psScan->bRight ? nXSize : sParams.nX;
 
-    /* create output raster */
-    auto poDstDS = std::unique_ptr<GDALDataset>(
-        hDriver->Create(pszTargetRasterName, nXSize, nYStop - nYStart, 1,
-                        heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte,
-                        const_cast<char **>(papszCreationOptions)));
-    if (!poDstDS)
+    for (int i = 1; i <= psScan->nLineCount; i++)
     {
-        CPLError(CE_Failure, CPLE_AppDefined, "Cannot create dataset for %s",
-                 pszTargetRasterName);
-        return nullptr;
-    }
-    /* copy srs */
-    if (hSrcDS)
-        poDstDS->SetSpatialRef(
-            GDALDataset::FromHandle(hSrcDS)->GetSpatialRef());
+        const int iLine = psScan->nY + i * psScan->nYStep;
+        if (!psScan->pfnRead(iLine, nXOff, nXReadEnd - nXOff,
+                             padfThisLineVal))
+        {
+            if (psScan->psProgress)
+                psScan->psProgress->bStop = true;
+            return;
+        }
 
-    std::array<double, 6> adfDstGeoTransform;
-    adfDstGeoTransform[0] = adfGeoTransform[0] + adfGeoTransform[1] * nXStart +
-                            adfGeoTransform[2] * nYStart;
-    adfDstGeoTransform[1] = adfGeoTransform[1];
-    adfDstGeoTransform[2] = adfGeoTransform[2];
-    adfDstGeoTransform[3] = adfGeoTransform[3] + adfGeoTransform[4] * nXStart +
-                            adfGeoTransform[5] * nYStart;
-    adfDstGeoTransform[4] = adfGeoTransform[4];
-    adfDstGeoTransform[5] = adfGeoTransform[5];
-    poDstDS->SetGeoTransform(adfDstGeoTransform.data());
+        ViewshedProcessLine(sParams, i, padfThisLineVal, padfLastLineVal,
+                            vResult, vHeightResult.data(), psScan->bLeft,
+                            psScan->bRight);
 
-    auto hTargetBand = poDstDS->GetRasterBand(1);
-    if (hTargetBand == nullptr)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined, "Cannot get band for %s",
-                 pszTargetRasterName);
-        return nullptr;
-    }
+        if (!psScan->pfnWrite(iLine, nXOff, nXWriteEnd - nXOff, vResult.data(),
+                              vHeightResult.data()))
+        {
+            if (psScan->psProgress)
+                psScan->psProgress->bStop = true;
+            return;
+        }
 
-    if (dfNoDataVal >= 0)
-        GDALSetRasterNoDataValue(
-            hTargetBand, heightMode != GVOT_NORMAL ? dfNoDataVal : byNoDataVal);
+        std::swap(padfLastLineVal, padfThisLineVal);
 
-    /* process first line */
-    if (GDALRasterIO(hBand, GF_Read, nXStart, nY, nXSize, 1, padfFirstLineVal,
-                     nXSize, 1, GDT_Float64, 0, 0))
-    {
-        CPLError(
-            CE_Failure, CPLE_AppDefined,
-            "RasterIO error when reading DEM at position(%d, %d), size(%d, %d)",
-            nXStart, nY, nXSize, 1);
-        return nullptr;
+        if (psScan->psProgress && !psScan->psProgress->Advance(1.0))
+            return;
     }
+    psScan->bOK = true;
+}
 
-    const double dfZObserver = dfObserverHeight + padfFirstLineVal[nX];
-    double dfZ = 0.0;
-    const double dfDistance2 = dfMaxDistance * dfMaxDistance;
+/************************************************************************/
+/*                          ViewshedRunTasks()                          */
+/************************************************************************/
 
-    /* If we can't get a SemiMajor axis from the SRS, it will be
-     * SRS_WGS84_SEMIMAJOR
-     */
-    double dfSphereDiameter(std::numeric_limits<double>::infinity());
-    const OGRSpatialReference *poDstSRS = poDstDS->GetSpatialRef();
-    if (poDstSRS)
+// Runs pfnFunc() on each element of apData, on the global thread pool if
+// nThreads > 1.
+static void ViewshedRunTasks(CPLThreadFunc pfnFunc,
+                             const std::vector<void *> &apData, int nThreads)
+{
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 && apData.size() > 1 ? GDALGetGlobalThreadPool(nThreads)
+                                          : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    for (void *pData : apData)
     {
-        OGRErr eSRSerr;
-        double dfSemiMajor = poDstSRS->GetSemiMajor(&eSRSerr);
-
-        /* If we fetched the axis from the SRS, use it */
-        if (eSRSerr != OGRERR_FAILURE)
-            dfSphereDiameter = dfSemiMajor * 2.0;
-        else
-            CPLDebug("GDALViewshedGenerate",
-                     "Unable to fetch SemiMajor axis from spatial reference");
+        if (!poJobQueue || !poJobQueue->SubmitJob(pfnFunc, pData))
+            pfnFunc(pData);
     }
+    if (poJobQueue)
+        poJobQueue->WaitCompletion();
+}
 
-    /* mark the observer point as visible */
-    double dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                               ? padfFirstLineVal[nX]
-                               : 0.0;
-    pabyResult[nX] = byVisibleVal;
-    if (heightMode != GVOT_NORMAL)
-        dfHeightResult[nX] = dfGroundLevel;
+/************************************************************************/
+/*                       ViewshedGetNumThreads()                        */
+/************************************************************************/
 
-    if (nX > 0)
-    {
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                            ? padfFirstLineVal[nX - 1]
-                            : 0.0;
-        CPL_IGNORE_RET_VAL(AdjustHeightInRange(
-            adfGeoTransform.data(), 1, 0, padfFirstLineVal[nX - 1], dfDistance2,
-            dfCurvCoeff, dfSphereDiameter));
-        pabyResult[nX - 1] = byVisibleVal;
-        if (heightMode != GVOT_NORMAL)
-            dfHeightResult[nX - 1] = dfGroundLevel;
-    }
-    if (nX < nXSize - 1)
+static int ViewshedGetNumThreads(CSLConstList papszExtraOptions)
+{
+    const char *pszNumThreads =
+        CSLFetchNameValueDef(papszExtraOptions, "NUM_THREADS",
+                             CPLGetConfigOption("GDAL_NUM_THREADS", nullptr));
+    int nThreads = 1;
+    if (pszNumThreads)
     {
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                            ? padfFirstLineVal[nX + 1]
-                            : 0.0;
-        CPL_IGNORE_RET_VAL(AdjustHeightInRange(
-            adfGeoTransform.data(), 1, 0, padfFirstLineVal[nX + 1], dfDistance2,
-            dfCurvCoeff, dfSphereDiameter));
-        pabyResult[nX + 1] = byVisibleVal;
-        if (heightMode != GVOT_NORMAL)
-            dfHeightResult[nX + 1] = dfGroundLevel;
+        nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+        nThreads = std::max(1, std::min(nThreads, 128));
     }
+    return nThreads;
+}
 
-    /* process left direction */
-    for (int iPixel = nX - 2; iPixel >= 0; iPixel--)
-    {
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                            ? padfFirstLineVal[iPixel]
-                            : 0.0;
-        bool adjusted = AdjustHeightInRange(
-            adfGeoTransform.data(), nX - iPixel, 0, padfFirstLineVal[iPixel],
-            dfDistance2, dfCurvCoeff, dfSphereDiameter);
-        if (adjusted)
-        {
-            dfZ = CalcHeightLine(nX - iPixel, padfFirstLineVal[iPixel + 1],
-                                 dfZObserver);
+/************************************************************************/
+/*                       ViewshedComputeWindow()                        */
+/************************************************************************/
 
-            if (heightMode != GVOT_NORMAL)
-                dfHeightResult[iPixel] = std::max(
-                    0.0, (dfZ - padfFirstLineVal[iPixel] + dfGroundLevel));
+// Computes the area of interest of an observer at (nX, nY), clamped to the
+// raster extent.
+static void ViewshedComputeWindow(const double *adfInvGeoTransform, int nX,
+                                  int nY, int nXSize, int nYSize,
+                                  double dfMaxDistance, int &nXStart,
+                                  int &nXStop, int &nYStart, int &nYStop)
+{
+    nXStart =
+        dfMaxDistance > 0
+            ? (std::max)(0, static_cast<int>(std::floor(
+                                nX - adfInvGeoTransform[1] * dfMaxDistance)))
+            : 0;
+    nXStop =
+        dfMaxDistance > 0
+            ? (std::min)(nXSize,
+                         static_cast<int>(std::ceil(nX + adfInvGeoTransform[1] *
+                                                             dfMaxDistance) +
+                                          1))
+            : nXSize;
+    nYStart =
+        dfMaxDistance > 0
+            ? (std::max)(0, static_cast<int>(std::floor(
+                                nY + adfInvGeoTransform[5] * dfMaxDistance)))
+            : 0;
+    nYStop =
+        dfMaxDistance > 0
+            ? (std::min)(nYSize,
+                         static_cast<int>(std::ceil(nY - adfInvGeoTransform[5] *
+                                                             dfMaxDistance) +
+                                          1))
+            : nYSize;
+}
 
-            SetVisibility(iPixel, dfZ, dfTargetHeight, padfFirstLineVal,
-                          vResult, byVisibleVal, byInvisibleVal);
-        }
-        else
-        {
-            for (; iPixel >= 0; iPixel--)
-            {
-                pabyResult[iPixel] = byOutOfRangeVal;
-                if (heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = dfOutOfRangeVal;
-            }
-        }
+/************************************************************************/
+/*                        GDALViewshedGenerate()                         */
+/************************************************************************/
+
+/**
+ * Create viewshed from raster DEM.
+ *
+ * This algorithm will generate a viewshed raster from an input DEM raster
+ * by using a modified algorithm of "Generating Viewsheds without Using
+ * Sightlines" published at
+ * https://www.asprs.org/wp-content/uploads/pers/2000journal/january/2000_jan_87-90.pdf
+ * This appoach provides a relatively fast calculation, since the output raster
+ * is generated in a single scan. The gdal/apps/gdal_viewshed.cpp mainline can
+ * be used as an example of how to use this function. The output raster will be
+ * of type Byte or Float64.
+ *
+ * \note The algorithm as implemented currently will only output meaningful
+ * results if the georeferencing is in a projected coordinate reference system.
+ *
+ * @param hBand The band to read the DEM data from. Only the part of the raster
+ * within the specified maxdistance around the observer point is processed.
+ *
+ * @param pszDriverName Driver name (GTiff if set to NULL)
+ *
+ * @param pszTargetRasterName The name of the target raster to be generated.
+ * Must not be NULL
+ *
+ * @param papszCreationOptions creation options.
+ *
+ * @param dfObserverX observer X value (in SRS units)
+ *
+ * @param dfObserverY observer Y value (in SRS units)
+ *
+ * @param dfObserverHeight The height of the observer above the DEM surface.
+ *
+ * @param dfTargetHeight The height of the target above the DEM surface.
+ * (default 0)
+ *
+ * @param dfVisibleVal pixel value for visibility (default 255)
+ *
+ * @param dfInvisibleVal pixel value for invisibility (default 0)
+ *
+ * @param dfOutOfRangeVal The value to be set for the cells that fall outside of
+ * the range specified by dfMaxDistance.
+ *
+ * @param dfNoDataVal The value to be set for the cells that have no data.
+ *                    If set to a negative value, nodata is not set.
+ *                    Note: currently, no special processing of input cells at a
+ * nodata value is done (which may result in erroneous results).
+ *
+ * @param dfCurvCoeff Coefficient to consider the effect of the curvature and
+ * refraction. The height of the DEM is corrected according to the following
+ * formula: [Height] -= dfCurvCoeff * [Target Distance]^2 / [Earth Diameter] For
+ * the effect of the atmospheric refraction we can use 0.85714.
+ *
+ * @param eMode The mode of the viewshed calculation.
+ * Possible values GVM_Diagonal = 1, GVM_Edge = 2 (default), GVM_Max = 3,
+ * GVM_Min = 4.
+ *
+ * @param dfMaxDistance maximum distance range to compute viewshed.
+ *                      It is also used to clamp the extent of the output
+ * raster. If set to 0, then unlimited range is assumed, that is to say the
+ *                      computation is performed on the extent of the whole
+ * raster.
+ *
+ * @param pfnProgress A GDALProgressFunc that may be used to report progress
+ * to the user, or to interrupt the algorithm.  May be NULL if not required.
+ *
+ * @param pProgressArg The callback data for the pfnProgress function.
+ *
+ * @param heightMode Type of information contained in output raster. Possible
+ * values GVOT_NORMAL = 1 (default), GVOT_MIN_TARGET_HEIGHT_FROM_DEM = 2,
+ *                   GVOT_MIN_TARGET_HEIGHT_FROM_GROUND = 3
+ *
+ *                   GVOT_NORMAL returns a raster of type Byte containing
+ * visible locations.
+ *
+ *                   GVOT_MIN_TARGET_HEIGHT_FROM_DEM and
+ * GVOT_MIN_TARGET_HEIGHT_FROM_GROUND will return a raster of type Float64
+ * containing the minimum target height for target to be visible from the DEM
+ * surface or ground level respectively. Parameters dfTargetHeight, dfVisibleVal
+ * and dfInvisibleVal will be ignored.
+ *
+ *
+ * @param papszExtraOptions NULL terminated list of options, or NULL.
+ * The following option is supported:
+ * <ul>
+ * <li>NUM_THREADS=number_of_threads or ALL_CPUS (GDAL >= 3.9). Number of
+ * threads used to scan the lines above and below the observer, and the
+ * columns on its left and right when at least 3 threads are used. Defaults
+ * to the value of the GDAL_NUM_THREADS configuration option, or 1.</li>
+ * </ul>
+ *
+ * @return not NULL output dataset on success (to be closed with GDALClose()) or
+ * NULL if an error occurs.
+ *
+ * @since GDAL 3.1
+ */
+
+GDALDatasetH GDALViewshedGenerate(
+    GDALRasterBandH hBand, const char *pszDriverName,
+    const char *pszTargetRasterName, CSLConstList papszCreationOptions,
+    double dfObserverX, double dfObserverY, double dfObserverHeight,
+    double dfTargetHeight, double dfVisibleVal, double dfInvisibleVal,
+    double dfOutOfRangeVal, double dfNoDataVal, double dfCurvCoeff,
+    GDALViewshedMode eMode, double dfMaxDistance, GDALProgressFunc pfnProgress,
+    void *pProgressArg, GDALViewshedOutputType heightMode,
+    CSLConstList papszExtraOptions)
+
+{
+    VALIDATE_POINTER1(hBand, "GDALViewshedGenerate", nullptr);
+    VALIDATE_POINTER1(pszTargetRasterName, "GDALViewshedGenerate", nullptr);
+
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+
+    if (!pfnProgress(0.0, "", pProgressArg))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return nullptr;
     }
-    /* process right direction */
-    for (int iPixel = nX + 2; iPixel < nXSize; iPixel++)
+
+    const GByte byNoDataVal = dfNoDataVal >= 0 && dfNoDataVal <= 255
+                                  ? static_cast<GByte>(dfNoDataVal)
+                                  : 0;
+    const GByte byVisibleVal = dfVisibleVal >= 0 && dfVisibleVal <= 255
+                                   ? static_cast<GByte>(dfVisibleVal)
+                                   : 255;
+    const GByte byInvisibleVal = dfInvisibleVal >= 0 && dfInvisibleVal <= 255
+                                     ? static_cast<GByte>(dfInvisibleVal)
+                                     : 0;
+    const GByte byOutOfRangeVal = dfOutOfRangeVal >= 0 && dfOutOfRangeVal <= 255
+                                      ? static_cast<GByte>(dfOutOfRangeVal)
+                                      : 0;
+
+    if (heightMode != GVOT_MIN_TARGET_HEIGHT_FROM_DEM &&
+        heightMode != GVOT_MIN_TARGET_HEIGHT_FROM_GROUND)
+        heightMode = GVOT_NORMAL;
+
+    /* set up geotransformation */
+    std::array<double, 6> adfGeoTransform{{0.0, 1.0, 0.0, 0.0, 0.0, 1.0}};
+    GDALDatasetH hSrcDS = GDALGetBandDataset(hBand);
+    if (hSrcDS != nullptr)
+        GDALGetGeoTransform(hSrcDS, adfGeoTransform.data());
+
+    double adfInvGeoTransform[6];
+    if (!GDALInvGeoTransform(adfGeoTransform.data(), adfInvGeoTransform))
     {
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                            ? padfFirstLineVal[iPixel]
-                            : 0.0;
-        bool adjusted = AdjustHeightInRange(
-            adfGeoTransform.data(), iPixel - nX, 0, padfFirstLineVal[iPixel],
-            dfDistance2, dfCurvCoeff, dfSphereDiameter);
-        if (adjusted)
-        {
-            dfZ = CalcHeightLine(iPixel - nX, padfFirstLineVal[iPixel - 1],
-                                 dfZObserver);
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot invert geotransform");
+        return nullptr;
+    }
 
-            if (heightMode != GVOT_NORMAL)
-                dfHeightResult[iPixel] = std::max(
-                    0.0, (dfZ - padfFirstLineVal[iPixel] + dfGroundLevel));
+    /* calculate observer position */
+    double dfX, dfY;
+    GDALApplyGeoTransform(adfInvGeoTransform, dfObserverX, dfObserverY, &dfX,
+                          &dfY);
+    int nX = static_cast<int>(dfX);
+    int nY = static_cast<int>(dfY);
 
-            SetVisibility(iPixel, dfZ, dfTargetHeight, padfFirstLineVal,
-                          vResult, byVisibleVal, byInvisibleVal);
-        }
+    int nXSize = GDALGetRasterBandXSize(hBand);
+    int nYSize = GDALGetRasterBandYSize(hBand);
+
+    if (nX < 0 || nX > nXSize || nY < 0 || nY > nYSize)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "The observer location falls outside of the DEM area");
+        return nullptr;
+    }
+
+    /* calculate the area of interest */
+    int nXStart = 0;
+    int nXStop = 0;
+    int nYStart = 0;
+    int nYStop = 0;
+    ViewshedComputeWindow(adfInvGeoTransform, nX, nY, nXSize, nYSize,
+                          dfMaxDistance, nXStart, nXStop, nYStart, nYStop);
+
+    /* normalize horizontal index (0 - nXSize) */
+    nXSize = nXStop - nXStart;
+    nX -= nXStart;
+
+    nYSize = nYStop - nYStart;
+
+    if (nXSize == 0 || nYSize == 0)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Invalid target raster size");
+        return nullptr;
+    }
+
+    std::vector<double> vFirstLineVal;
+    std::vector<GByte> vResult;
+    std::vector<double> vHeightResult;
+
+    try
+    {
+        vFirstLineVal.resize(nXSize);
+        vResult.resize(nXSize);
+
+        if (heightMode != GVOT_NORMAL)
+            vHeightResult.resize(nXSize);
+    }
+    catch (...)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot allocate vectors for viewshed");
+        return nullptr;
+    }
+
+    double *padfFirstLineVal = vFirstLineVal.data();
+    GByte *pabyResult = vResult.data();
+    double *dfHeightResult = vHeightResult.data();
+
+    GDALDriverManager *hMgr = GetGDALDriverManager();
+    GDALDriver *hDriver =
+        hMgr->GetDriverByName(pszDriverName ? pszDriverName : "GTiff");
+    if (!hDriver)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot get driver");
+        return nullptr;
+    }
+
+    /* create output raster */
+    auto poDstDS = std::unique_ptr<GDALDataset>(
+        hDriver->Create(pszTargetRasterName, nXSize, nYStop - nYStart, 1,
+                        heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte,
+                        const_cast<char **>(papszCreationOptions)));
+    if (!poDstDS)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot create dataset for %s",
+                 pszTargetRasterName);
+        return nullptr;
+    }
+    /* copy srs */
+    if (hSrcDS)
+        poDstDS->SetSpatialRef(
+            GDALDataset::FromHandle(hSrcDS)->GetSpatialRef());
+
+    std::array<double, 6> adfDstGeoTransform;
+    adfDstGeoTransform[0] = adfGeoTransform[0] + adfGeoTransform[1] * nXStart +
+                            adfGeoTransform[2] * nYStart;
+    adfDstGeoTransform[1] = adfGeoTransform[1];
+    adfDstGeoTransform[2] = adfGeoTransform[2];
+    adfDstGeoTransform[3] = adfGeoTransform[3] + adfGeoTransform[4] * nXStart +
+                            adfGeoTransform[5] * nYStart;
+    adfDstGeoTransform[4] = adfGeoTransform[4];
+    adfDstGeoTransform[5] = adfGeoTransform[5];
+    poDstDS->SetGeoTransform(adfDstGeoTransform.data());
+
+    auto hTargetBand = poDstDS->GetRasterBand(1);
+    if (hTargetBand == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot get band for %s",
+                 pszTargetRasterName);
+        return nullptr;
+    }
+
+    if (dfNoDataVal >= 0)
+        GDALSetRasterNoDataValue(
+            hTargetBand, heightMode != GVOT_NORMAL ? dfNoDataVal : byNoDataVal);
+
+    /* process first line */
+    if (GDALRasterIO(hBand, GF_Read, nXStart, nY, nXSize, 1, padfFirstLineVal,
+                     nXSize, 1, GDT_Float64, 0, 0))
+    {
+        CPLError(
+            CE_Failure, CPLE_AppDefined,
+            "RasterIO error when reading DEM at position(%d, %d), size(%d, %d)",
+            nXStart, nY, nXSize, 1);
+        return nullptr;
+    }
+
+    ViewshedParams sParams;
+    sParams.adfGeoTransform = adfGeoTransform;
+    sParams.nX = nX;
+    sParams.nXSize = nXSize;
+    sParams.dfZObserver = dfObserverHeight + padfFirstLineVal[nX];
+    sParams.dfTargetHeight = dfTargetHeight;
+    sParams.dfDistance2 = dfMaxDistance * dfMaxDistance;
+    sParams.dfCurvCoeff = dfCurvCoeff;
+    sParams.eMode = eMode;
+    sParams.heightMode = heightMode;
+    sParams.byVisibleVal = byVisibleVal;
+    sParams.byInvisibleVal = byInvisibleVal;
+    sParams.byOutOfRangeVal = byOutOfRangeVal;
+    sParams.dfOutOfRangeVal = dfOutOfRangeVal;
+
+    /* If we can't get a SemiMajor axis from the SRS, it will be
+     * SRS_WGS84_SEMIMAJOR
+     */
+    const OGRSpatialReference *poDstSRS = poDstDS->GetSpatialRef();
+    if (poDstSRS)
+    {
+        OGRErr eSRSerr;
+        double dfSemiMajor = poDstSRS->GetSemiMajor(&eSRSerr);
+
+        /* If we fetched the axis from the SRS, use it */
+        if (eSRSerr != OGRERR_FAILURE)
+            sParams.dfSphereDiameter = dfSemiMajor * 2.0;
         else
-        {
-            for (; iPixel < nXSize; iPixel++)
-            {
-                pabyResult[iPixel] = byOutOfRangeVal;
-                if (heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = dfOutOfRangeVal;
-            }
-        }
+            CPLDebug("GDALViewshedGenerate",
+                     "Unable to fetch SemiMajor axis from spatial reference");
     }
+
+    ViewshedProcessFirstLine(sParams, padfFirstLineVal, vResult,
+                             dfHeightResult);
+
     /* write result line */
 
     if (GDALRasterIO(hTargetBand, GF_Write, 0, nY - nYStart, nXSize, 1,
@@ -540,330 +989,445 @@ GDALDatasetH GDALViewshedGenerate(
         return nullptr;
     }
 
-    /* scan upwards */
-    std::copy(vFirstLineVal.begin(), vFirstLineVal.end(), vLastLineVal.begin());
-    for (int iLine = nY - 1; iLine >= nYStart; iLine--)
+    /* scan upwards and downwards */
+    const int nThreads = ViewshedGetNumThreads(papszExtraOptions);
+    std::mutex oIOMutex;
+    const auto ReadLine =
+        [&](int iLine, int nXOff, int nXCount, double *padfLine)
     {
-        if (GDALRasterIO(hBand, GF_Read, nXStart, iLine, nXSize, 1,
-                         padfThisLineVal, nXSize, 1, GDT_Float64, 0, 0))
+        std::lock_guard<std::mutex> oLock(oIOMutex);
+        if (GDALRasterIO(hBand, GF_Read, nXStart + nXOff, nYStart + iLine,
+                         nXCount, 1, padfLine + nXOff, nXCount, 1,
+                         GDT_Float64, 0, 0))
         {
             CPLError(CE_Failure, CPLE_AppDefined,
                      "RasterIO error when reading DEM at position (%d,%d), "
                      "size (%d,%d)",
-                     nXStart, iLine, nXSize, 1);
-            return nullptr;
+                     nXStart + nXOff, nYStart + iLine, nXCount, 1);
+            return false;
         }
-
-        /* set up initial point on the scanline */
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                            ? padfThisLineVal[nX]
-                            : 0.0;
-        bool adjusted = AdjustHeightInRange(
-            adfGeoTransform.data(), 0, nY - iLine, padfThisLineVal[nX],
-            dfDistance2, dfCurvCoeff, dfSphereDiameter);
-        if (adjusted)
+        return true;
+    };
+    const auto WriteLine = [&](int iLine, int nXOff, int nXCount,
+                               GByte *pabyLineResult,
+                               double *padfLineHeightResult)
+    {
+        std::lock_guard<std::mutex> oLock(oIOMutex);
+        if (GDALRasterIO(
+                hTargetBand, GF_Write, nXOff, iLine, nXCount, 1,
+                heightMode != GVOT_NORMAL
+                    ? static_cast<void *>(padfLineHeightResult + nXOff)
+                    : static_cast<void *>(pabyLineResult + nXOff),
+                nXCount, 1, heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte,
+                0, 0))
         {
-            dfZ = CalcHeightLine(nY - iLine, padfLastLineVal[nX], dfZObserver);
-
-            if (heightMode != GVOT_NORMAL)
-                dfHeightResult[nX] =
-                    std::max(0.0, (dfZ - padfThisLineVal[nX] + dfGroundLevel));
-
-            SetVisibility(nX, dfZ, dfTargetHeight, padfThisLineVal, vResult,
-                          byVisibleVal, byInvisibleVal);
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "RasterIO error when writing target raster at position "
+                     "(%d,%d), size (%d,%d)",
+                     nXOff, iLine, nXCount, 1);
+            return false;
         }
-        else
+        return true;
+    };
+
+    // With enough threads, the columns on the left and on the right of the
+    // observer are also processed separately.
+    const bool bSplitColumns = nThreads > 2 && nX > 0 && nX + 1 < nXSize;
+    ViewshedProgress sProgress;
+    sProgress.pfnProgress = pfnProgress;
+    sProgress.pProgressArg = pProgressArg;
+    sProgress.dfTotal = 0.0;
+    std::vector<ViewshedHalfScan> asScans;
+    for (const int nYStep : {-1, 1})
+    {
+        const int nLineCount = nYStep < 0 ? nY - nYStart : nYStop - 1 - nY;
+        for (int iSide = 0; nLineCount > 0 && iSide < (bSplitColumns ? 2 : 1);
+             iSide++)
         {
-            pabyResult[nX] = byOutOfRangeVal;
-            if (heightMode != GVOT_NORMAL)
-                dfHeightResult[nX] = dfOutOfRangeVal;
+            ViewshedHalfScan sScan;
+            sScan.psParams = &sParams;
+            sScan.nY = nY - nYStart;
+            sScan.nYStep = nYStep;
+            sScan.nLineCount = nLineCount;
+            sScan.bLeft = !bSplitColumns || iSide == 0;
+            sScan.bRight = !bSplitColumns || iSide == 1;
+            sScan.padfFirstLineVal = padfFirstLineVal;
+            sScan.pfnRead = ReadLine;
+            sScan.pfnWrite = WriteLine;
+            sScan.psProgress = &sProgress;
+            asScans.push_back(std::move(sScan));
+            sProgress.dfTotal += nLineCount;
         }
+    }
 
-        /* process left direction */
-        for (int iPixel = nX - 1; iPixel >= 0; iPixel--)
-        {
-            dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                                ? padfThisLineVal[iPixel]
-                                : 0.0;
-            bool left_adjusted =
-                AdjustHeightInRange(adfGeoTransform.data(), nX - iPixel,
-                                    nY - iLine, padfThisLineVal[iPixel],
-                                    dfDistance2, dfCurvCoeff, dfSphereDiameter);
-            if (left_adjusted)
-            {
-                if (eMode != GVM_Edge)
-                    dfZ = CalcHeightDiagonal(
-                        nX - iPixel, nY - iLine, padfThisLineVal[iPixel + 1],
-                        padfLastLineVal[iPixel], dfZObserver);
-
-                if (eMode != GVM_Diagonal)
-                {
-                    double dfZ2 =
-                        nX - iPixel >= nY - iLine
-                            ? CalcHeightEdge(nY - iLine, nX - iPixel,
-                                             padfLastLineVal[iPixel + 1],
-                                             padfThisLineVal[iPixel + 1],
-                                             dfZObserver)
-                            : CalcHeightEdge(nX - iPixel, nY - iLine,
-                                             padfLastLineVal[iPixel + 1],
-                                             padfLastLineVal[iPixel],
-                                             dfZObserver);
-                    dfZ = CalcHeight(dfZ, dfZ2, eMode);
-                }
-
-                if (heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = std::max(
-                        0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
-
-                SetVisibility(iPixel, dfZ, dfTargetHeight, padfThisLineVal,
-                              vResult, byVisibleVal, byInvisibleVal);
-            }
-            else
-            {
-                for (; iPixel >= 0; iPixel--)
-                {
-                    pabyResult[iPixel] = byOutOfRangeVal;
-                    if (heightMode != GVOT_NORMAL)
-                        dfHeightResult[iPixel] = dfOutOfRangeVal;
-                }
-            }
-        }
-        /* process right direction */
-        for (int iPixel = nX + 1; iPixel < nXSize; iPixel++)
-        {
-            dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                                ? padfThisLineVal[iPixel]
-                                : 0.0;
-            bool right_adjusted =
-                AdjustHeightInRange(adfGeoTransform.data(), iPixel - nX,
-                                    nY - iLine, padfThisLineVal[iPixel],
-                                    dfDistance2, dfCurvCoeff, dfSphereDiameter);
-            if (right_adjusted)
-            {
-                if (eMode != GVM_Edge)
-                    dfZ = CalcHeightDiagonal(
-                        iPixel - nX, nY - iLine, padfThisLineVal[iPixel - 1],
-                        padfLastLineVal[iPixel], dfZObserver);
+    std::vector<void *> apScans;
+    for (auto &sScan : asScans)
+        apScans.push_back(&sScan);
+    ViewshedRunTasks(ViewshedScanHalfFunc, apScans, nThreads);
+    for (const auto &sScan : asScans)
+    {
+        if (!sScan.bOK)
+            return nullptr;
+    }
 
-                if (eMode != GVM_Diagonal)
-                {
-                    double dfZ2 =
-                        iPixel - nX >= nY - iLine
-                            ? CalcHeightEdge(nY - iLine, iPixel - nX,
-                                             padfLastLineVal[iPixel - 1],
-                                             padfThisLineVal[iPixel - 1],
-                                             dfZObserver)
-                            : CalcHeightEdge(iPixel - nX, nY - iLine,
-                                             padfLastLineVal[iPixel - 1],
-                                             padfLastLineVal[iPixel],
-                                             dfZObserver);
-                    dfZ = CalcHeight(dfZ, dfZ2, eMode);
-                }
+    if (!pfnProgress(1.0, "", pProgressArg))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return nullptr;
+    }
 
-                if (heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = std::max(
-                        0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
+    return GDALDataset::FromHandle(poDstDS.release());
+}
 
-                SetVisibility(iPixel, dfZ, dfTargetHeight, padfThisLineVal,
-                              vResult, byVisibleVal, byInvisibleVal);
-            }
-            else
-            {
-                for (; iPixel < nXSize; iPixel++)
-                {
-                    pabyResult[iPixel] = byOutOfRangeVal;
-                    if (heightMode != GVOT_NORMAL)
-                        dfHeightResult[iPixel] = dfOutOfRangeVal;
-                }
-            }
-        }
+/************************************************************************/
+/*                   ViewshedCumulativeObserverFunc()                   */
+/************************************************************************/
 
-        /* write result line */
-        if (GDALRasterIO(
-                hTargetBand, GF_Write, 0, iLine - nYStart, nXSize, 1,
-                heightMode != GVOT_NORMAL ? static_cast<void *>(dfHeightResult)
-                                          : static_cast<void *>(pabyResult),
-                nXSize, 1, heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte,
-                0, 0))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "RasterIO error when writing target raster at position "
-                     "(%d,%d), size (%d,%d)",
-                     0, iLine - nYStart, nXSize, 1);
-            return nullptr;
-        }
+static void ViewshedCumulativeObserverFunc(void *pData)
+{
+    ViewshedObserverTask *psTask = static_cast<ViewshedObserverTask *>(pData);
+    const ViewshedCumulativeContext &sContext = *(psTask->psContext);
+    if (sContext.psProgress->bStop)
+        return;
+
+    int nXStart = 0;
+    int nXStop = 0;
+    int nYStart = 0;
+    int nYStop = 0;
+    ViewshedComputeWindow(sContext.padfInvGeoTransform, psTask->nX,
+                          psTask->nY, sContext.nXSize, sContext.nYSize,
+                          sContext.dfMaxDistance, nXStart, nXStop, nYStart,
+                          nYStop);
+    const int nXSize = nXStop - nXStart;
+    const int nYSize = nYStop - nYStart;
+    const int nY = psTask->nY - nYStart;
+
+    ViewshedParams sParams = *(sContext.psParams);
+    sParams.nX = psTask->nX - nXStart;
+    sParams.nXSize = nXSize;
 
-        std::swap(padfLastLineVal, padfThisLineVal);
+    std::vector<double> vFirstLineVal;
+    std::vector<GByte> vResult;
+    std::vector<GByte> vVisible;
+    try
+    {
+        vFirstLineVal.resize(nXSize);
+        vResult.resize(nXSize);
+        vVisible.resize(static_cast<size_t>(nXSize) * nYSize);
+    }
+    catch (...)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate vectors for viewshed");
+        sContext.psProgress->bStop = true;
+        return;
+    }
+
+    const auto ReadLine =
+        [&](int iLine, int nXOff, int nXCount, double *padfLine)
+    {
+        memcpy(padfLine + nXOff,
+               sContext.padfDEM +
+                   static_cast<size_t>(nYStart + iLine) * sContext.nXSize +
+                   nXStart + nXOff,
+               nXCount * sizeof(double));
+        return true;
+    };
+    const auto WriteLine =
+        [&](int iLine, int nXOff, int nXCount, GByte *pabyLineResult, double *)
+    {
+        memcpy(vVisible.data() + static_cast<size_t>(iLine) * nXSize + nXOff,
+               pabyLineResult + nXOff, nXCount);
+        return true;
+    };
 
-        if (!pfnProgress((nY - iLine) / static_cast<double>(nYSize), "",
-                         pProgressArg))
+    ReadLine(nY, 0, nXSize, vFirstLineVal.data());
+    sParams.dfZObserver = sContext.dfObserverHeight + vFirstLineVal[sParams.nX];
+    ViewshedProcessFirstLine(sParams, vFirstLineVal.data(), vResult, nullptr);
+    WriteLine(nY, 0, nXSize, vResult.data(), nullptr);
+
+    for (const int nYStep : {-1, 1})
+    {
+        ViewshedHalfScan sScan;
+        sScan.psParams = &sParams;
+        sScan.nY = nY;
+        sScan.nYStep = nYStep;
+        sScan.nLineCount = nYStep < 0 ? nY : nYSize - 1 - nY;
+        sScan.padfFirstLineVal = vFirstLineVal.data();
+        sScan.pfnRead = ReadLine;
+        sScan.pfnWrite = WriteLine;
+        ViewshedScanHalfFunc(&sScan);
+        if (!sScan.bOK)
         {
-            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-            return nullptr;
+            sContext.psProgress->bStop = true;
+            return;
         }
     }
-    /* scan downwards */
-    memcpy(padfLastLineVal, padfFirstLineVal, nXSize * sizeof(double));
-    for (int iLine = nY + 1; iLine < nYStop; iLine++)
+
     {
-        if (GDALRasterIO(hBand, GF_Read, nXStart, iLine, nXStop - nXStart, 1,
-                         padfThisLineVal, nXStop - nXStart, 1, GDT_Float64, 0,
-                         0))
+        std::lock_guard<std::mutex> oLock(*(sContext.poCountsMutex));
+        for (int iLine = 0; iLine < nYSize; iLine++)
         {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "RasterIO error when reading DEM at position (%d,%d), "
-                     "size (%d,%d)",
-                     nXStart, iLine, nXStop - nXStart, 1);
-            return nullptr;
+            GUInt32 *panCountLine =
+                sContext.panCounts +
+                static_cast<size_t>(nYStart + iLine) * sContext.nXSize +
+                nXStart;
+            const GByte *pabyVisibleLine =
+                vVisible.data() + static_cast<size_t>(iLine) * nXSize;
+            for (int iPixel = 0; iPixel < nXSize; iPixel++)
+                panCountLine[iPixel] += pabyVisibleLine[iPixel];
         }
+    }
 
-        /* set up initial point on the scanline */
-        dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                            ? padfThisLineVal[nX]
-                            : 0.0;
-        bool adjusted = AdjustHeightInRange(
-            adfGeoTransform.data(), 0, iLine - nY, padfThisLineVal[nX],
-            dfDistance2, dfCurvCoeff, dfSphereDiameter);
-        if (adjusted)
-        {
-            dfZ = CalcHeightLine(iLine - nY, padfLastLineVal[nX], dfZObserver);
+    psTask->bOK = sContext.psProgress->Advance(1.0);
+}
 
-            if (heightMode != GVOT_NORMAL)
-                dfHeightResult[nX] =
-                    std::max(0.0, (dfZ - padfThisLineVal[nX] + dfGroundLevel));
+/************************************************************************/
+/*                   GDALViewshedGenerateCumulative()                   */
+/************************************************************************/
 
-            SetVisibility(nX, dfZ, dfTargetHeight, padfThisLineVal, vResult,
-                          byVisibleVal, byInvisibleVal);
-        }
-        else
-        {
-            pabyResult[nX] = byOutOfRangeVal;
-            if (heightMode != GVOT_NORMAL)
-                dfHeightResult[nX] = dfOutOfRangeVal;
-        }
+/**
+ * Create cumulative viewshed from raster DEM.
+ *
+ * This function computes the viewsheds of several observers, in the same way
+ * as GDALViewshedGenerate() does for a single observer, and generates a
+ * raster of type UInt32, of the extent of the DEM, whose values are the
+ * number of observers from which each cell is visible.
+ *
+ * The DEM is loaded once in memory and the viewsheds of the observers are
+ * computed in parallel if requested, which is much faster than computing
+ * and summing individual viewsheds when there are many observers.
+ *
+ * @param hBand The band to read the DEM data from.
+ *
+ * @param pszDriverName Driver name (GTiff if set to NULL)
+ *
+ * @param pszTargetRasterName The name of the target raster to be generated.
+ * Must not be NULL
+ *
+ * @param papszCreationOptions creation options.
+ *
+ * @param nObserverCount Number of observers.
+ *
+ * @param padfObserverX Array of nObserverCount observer X values (in SRS
+ * units)
+ *
+ * @param padfObserverY Array of nObserverCount observer Y values (in SRS
+ * units)
+ *
+ * @param dfObserverHeight The height of the observers above the DEM surface.
+ *
+ * @param dfTargetHeight The height of the target above the DEM surface.
+ *
+ * @param dfCurvCoeff Coefficient to consider the effect of the curvature and
+ * refraction. See GDALViewshedGenerate().
+ *
+ * @param eMode The mode of the viewshed calculation. See
+ * GDALViewshedGenerate().
+ *
+ * @param dfMaxDistance maximum distance range to compute the viewshed of
+ * each observer. If set to 0, then unlimited range is assumed.
+ *
+ * @param pfnProgress A GDALProgressFunc that may be used to report progress
+ * to the user, or to interrupt the algorithm.  May be NULL if not required.
+ *
+ * @param pProgressArg The callback data for the pfnProgress function.
+ *
+ * @param papszExtraOptions NULL terminated list of options, or NULL.
+ * The following option is supported:
+ * <ul>
+ * <li>NUM_THREADS=number_of_threads or ALL_CPUS. Number of threads used to
+ * compute the viewsheds of the observers. Defaults to the value of the
+ * GDAL_NUM_THREADS configuration option, or 1.</li>
+ * </ul>
+ *
+ * @return not NULL output dataset on success (to be closed with GDALClose()) or
+ * NULL if an error occurs.
+ *
+ * @since GDAL 3.9
+ */
 
-        /* process left direction */
-        for (int iPixel = nX - 1; iPixel >= 0; iPixel--)
-        {
-            dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                                ? padfThisLineVal[iPixel]
-                                : 0.0;
-            bool left_adjusted =
-                AdjustHeightInRange(adfGeoTransform.data(), nX - iPixel,
-                                    iLine - nY, padfThisLineVal[iPixel],
-                                    dfDistance2, dfCurvCoeff, dfSphereDiameter);
-            if (left_adjusted)
-            {
-                if (eMode != GVM_Edge)
-                    dfZ = CalcHeightDiagonal(
-                        nX - iPixel, iLine - nY, padfThisLineVal[iPixel + 1],
-                        padfLastLineVal[iPixel], dfZObserver);
+GDALDatasetH GDALViewshedGenerateCumulative(
+    GDALRasterBandH hBand, const char *pszDriverName,
+    const char *pszTargetRasterName, CSLConstList papszCreationOptions,
+    int nObserverCount, const double *padfObserverX,
+    const double *padfObserverY, double dfObserverHeight,
+    double dfTargetHeight, double dfCurvCoeff, GDALViewshedMode eMode,
+    double dfMaxDistance, GDALProgressFunc pfnProgress, void *pProgressArg,
+    CSLConstList papszExtraOptions)
 
-                if (eMode != GVM_Diagonal)
-                {
-                    double dfZ2 =
-                        nX - iPixel >= iLine - nY
-                            ? CalcHeightEdge(iLine - nY, nX - iPixel,
-                                             padfLastLineVal[iPixel + 1],
-                                             padfThisLineVal[iPixel + 1],
-                                             dfZObserver)
-                            : CalcHeightEdge(nX - iPixel, iLine - nY,
-                                             padfLastLineVal[iPixel + 1],
-                                             padfLastLineVal[iPixel],
-                                             dfZObserver);
-                    dfZ = CalcHeight(dfZ, dfZ2, eMode);
-                }
+{
+    VALIDATE_POINTER1(hBand, "GDALViewshedGenerateCumulative", nullptr);
+    VALIDATE_POINTER1(pszTargetRasterName, "GDALViewshedGenerateCumulative",
+                      nullptr);
+    if (nObserverCount > 0)
+    {
+        VALIDATE_POINTER1(padfObserverX, "GDALViewshedGenerateCumulative",
+                          nullptr);
+        VALIDATE_POINTER1(padfObserverY, "GDALViewshedGenerateCumulative",
+                          nullptr);
+    }
 
-                if (heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = std::max(
-                        0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
 
-                SetVisibility(iPixel, dfZ, dfTargetHeight, padfThisLineVal,
-                              vResult, byVisibleVal, byInvisibleVal);
-            }
-            else
-            {
-                for (; iPixel >= 0; iPixel--)
-                {
-                    pabyResult[iPixel] = byOutOfRangeVal;
-                    if (heightMode != GVOT_NORMAL)
-                        dfHeightResult[iPixel] = dfOutOfRangeVal;
-                }
-            }
-        }
-        /* process right direction */
-        for (int iPixel = nX + 1; iPixel < nXSize; iPixel++)
-        {
-            dfGroundLevel = heightMode == GVOT_MIN_TARGET_HEIGHT_FROM_DEM
-                                ? padfThisLineVal[iPixel]
-                                : 0.0;
-            bool right_adjusted =
-                AdjustHeightInRange(adfGeoTransform.data(), iPixel - nX,
-                                    iLine - nY, padfThisLineVal[iPixel],
-                                    dfDistance2, dfCurvCoeff, dfSphereDiameter);
-            if (right_adjusted)
-            {
-                if (eMode != GVM_Edge)
-                    dfZ = CalcHeightDiagonal(
-                        iPixel - nX, iLine - nY, padfThisLineVal[iPixel - 1],
-                        padfLastLineVal[iPixel], dfZObserver);
+    if (!pfnProgress(0.0, "", pProgressArg))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return nullptr;
+    }
 
-                if (eMode != GVM_Diagonal)
-                {
-                    double dfZ2 =
-                        iPixel - nX >= iLine - nY
-                            ? CalcHeightEdge(iLine - nY, iPixel - nX,
-                                             padfLastLineVal[iPixel - 1],
-                                             padfThisLineVal[iPixel - 1],
-                                             dfZObserver)
-                            : CalcHeightEdge(iPixel - nX, iLine - nY,
-                                             padfLastLineVal[iPixel - 1],
-                                             padfLastLineVal[iPixel],
-                                             dfZObserver);
-                    dfZ = CalcHeight(dfZ, dfZ2, eMode);
-                }
+    /* set up geotransformation */
+    std::array<double, 6> adfGeoTransform{{0.0, 1.0, 0.0, 0.0, 0.0, 1.0}};
+    GDALDatasetH hSrcDS = GDALGetBandDataset(hBand);
+    if (hSrcDS != nullptr)
+        GDALGetGeoTransform(hSrcDS, adfGeoTransform.data());
 
-                if (heightMode != GVOT_NORMAL)
-                    dfHeightResult[iPixel] = std::max(
-                        0.0, (dfZ - padfThisLineVal[iPixel] + dfGroundLevel));
+    double adfInvGeoTransform[6];
+    if (!GDALInvGeoTransform(adfGeoTransform.data(), adfInvGeoTransform))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot invert geotransform");
+        return nullptr;
+    }
 
-                SetVisibility(iPixel, dfZ, dfTargetHeight, padfThisLineVal,
-                              vResult, byVisibleVal, byInvisibleVal);
-            }
-            else
-            {
-                for (; iPixel < nXSize; iPixel++)
-                {
-                    pabyResult[iPixel] = byOutOfRangeVal;
-                    if (heightMode != GVOT_NORMAL)
-                        dfHeightResult[iPixel] = dfOutOfRangeVal;
-                }
-            }
-        }
+    const int nXSize = GDALGetRasterBandXSize(hBand);
+    const int nYSize = GDALGetRasterBandYSize(hBand);
 
-        /* write result line */
-        if (GDALRasterIO(
-                hTargetBand, GF_Write, 0, iLine - nYStart, nXSize, 1,
-                heightMode != GVOT_NORMAL ? static_cast<void *>(dfHeightResult)
-                                          : static_cast<void *>(pabyResult),
-                nXSize, 1, heightMode != GVOT_NORMAL ? GDT_Float64 : GDT_Byte,
-                0, 0))
+    /* calculate observer positions */
+    std::vector<ViewshedObserverTask> asTasks;
+    try
+    {
+        asTasks.resize(std::max(0, nObserverCount));
+    }
+    catch (...)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate vectors for viewshed");
+        return nullptr;
+    }
+    for (int i = 0; i < nObserverCount; i++)
+    {
+        double dfX, dfY;
+        GDALApplyGeoTransform(adfInvGeoTransform, padfObserverX[i],
+                              padfObserverY[i], &dfX, &dfY);
+        if (!(dfX > -1 && dfX < nXSize && dfY > -1 && dfY < nYSize))
         {
             CPLError(CE_Failure, CPLE_AppDefined,
-                     "RasterIO error when writing target raster at position "
-                     "(%d,%d), size (%d,%d)",
-                     0, iLine - nYStart, nXSize, 1);
+                     "The location of observer %d falls outside of the DEM "
+                     "area",
+                     i);
             return nullptr;
         }
+        asTasks[i].nX = static_cast<int>(dfX);
+        asTasks[i].nY = static_cast<int>(dfY);
+    }
 
-        std::swap(padfLastLineVal, padfThisLineVal);
+    /* load the DEM */
+    std::vector<double> adfDEM;
+    std::vector<GUInt32> anCounts;
+    try
+    {
+        adfDEM.resize(static_cast<size_t>(nXSize) * nYSize);
+        anCounts.resize(static_cast<size_t>(nXSize) * nYSize);
+    }
+    catch (...)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate %d x %d DEM in memory for viewshed", nXSize,
+                 nYSize);
+        return nullptr;
+    }
+    if (GDALRasterIO(hBand, GF_Read, 0, 0, nXSize, nYSize, adfDEM.data(),
+                     nXSize, nYSize, GDT_Float64, 0, 0))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "RasterIO error when reading DEM");
+        return nullptr;
+    }
 
-        if (!pfnProgress((iLine - nYStart) / static_cast<double>(nYSize), "",
-                         pProgressArg))
-        {
-            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+    GDALDriverManager *hMgr = GetGDALDriverManager();
+    GDALDriver *hDriver =
+        hMgr->GetDriverByName(pszDriverName ? pszDriverName : "GTiff");
+    if (!hDriver)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot get driver");
+        return nullptr;
+    }
+
+    /* create output raster */
+    auto poDstDS = std::unique_ptr<GDALDataset>(hDriver->Create(
+        pszTargetRasterName, nXSize, nYSize, 1, GDT_UInt32,
+        const_cast<char **>(papszCreationOptions)));
+    if (!poDstDS)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot create dataset for %s",
+                 pszTargetRasterName);
+        return nullptr;
+    }
+    if (hSrcDS)
+        poDstDS->SetSpatialRef(
+            GDALDataset::FromHandle(hSrcDS)->GetSpatialRef());
+    poDstDS->SetGeoTransform(adfGeoTransform.data());
+
+    ViewshedParams sParams;
+    sParams.adfGeoTransform = adfGeoTransform;
+    sParams.dfTargetHeight = dfTargetHeight;
+    sParams.dfDistance2 = dfMaxDistance * dfMaxDistance;
+    sParams.dfCurvCoeff = dfCurvCoeff;
+    sParams.eMode = eMode;
+    sParams.byVisibleVal = 1;
+    sParams.byInvisibleVal = 0;
+    sParams.byOutOfRangeVal = 0;
+
+    const OGRSpatialReference *poDstSRS = poDstDS->GetSpatialRef();
+    if (poDstSRS)
+    {
+        OGRErr eSRSerr;
+        double dfSemiMajor = poDstSRS->GetSemiMajor(&eSRSerr);
+        if (eSRSerr != OGRERR_FAILURE)
+            sParams.dfSphereDiameter = dfSemiMajor * 2.0;
+    }
+
+    /* compute the viewsheds */
+    std::mutex oCountsMutex;
+    ViewshedProgress sProgress;
+    sProgress.pfnProgress = pfnProgress;
+    sProgress.pProgressArg = pProgressArg;
+    sProgress.dfTotal = std::max(1, nObserverCount);
+
+    ViewshedCumulativeContext sContext;
+    sContext.psParams = &sParams;
+    sContext.padfInvGeoTransform = adfInvGeoTransform;
+    sContext.padfDEM = adfDEM.data();
+    sContext.nXSize = nXSize;
+    sContext.nYSize = nYSize;
+    sContext.dfObserverHeight = dfObserverHeight;
+    sContext.dfMaxDistance = dfMaxDistance;
+    sContext.panCounts = anCounts.data();
+    sContext.poCountsMutex = &oCountsMutex;
+    sContext.psProgress = &sProgress;
+
+    std::vector<void *> apTasks;
+    for (auto &sTask : asTasks)
+    {
+        sTask.psContext = &sContext;
+        apTasks.push_back(&sTask);
+    }
+    ViewshedRunTasks(ViewshedCumulativeObserverFunc, apTasks,
+                     ViewshedGetNumThreads(papszExtraOptions));
+    for (const auto &sTask : asTasks)
+    {
+        if (!sTask.bOK)
             return nullptr;
-        }
+    }
+
+    if (poDstDS->GetRasterBand(1)->RasterIO(
+            GF_Write, 0, 0, nXSize, nYSize, anCounts.data(), nXSize, nYSize,
+            GDT_UInt32, 0, 0, nullptr) != CE_None)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "RasterIO error when writing target raster");
+        return nullptr;
     }
 
     if (!pfnProgress(1.0, "", pProgressArg))
@@ -28,14 +28,20 @@
 
 #include "commonutils.h"
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
-
+#include <deque>
+#include <mutex>
 #include <string>
 
 #include "cpl_conv.h"
+#include "cpl_error_internal.h"
 #include "cpl_string.h"
 #include "gdal.h"
+#include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 /* -------------------------------------------------------------------- */
 /*                         GetOutputDriversFor()                        */
@@ -171,3 +177,181 @@ int ArgIsNumeric(const char *pszArg)
 {
     return CPLGetValueType(pszArg) != CPL_VALUE_STRING;
 }
+
+/************************************************************************/
+/*                  GDALGetNumThreadsForPrefetching()                   */
+/************************************************************************/
+
+// Number of datasets opened concurrently by GDALDatasetPrefetcher: 1
+// (sequential opening) unless GDAL_NUM_THREADS is set.
+int GDALGetNumThreadsForPrefetching()
+{
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    return std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                         ? CPLGetNumCPUs()
+                                         : atoi(pszThreads)));
+}
+
+/************************************************************************/
+/*                    GDALDatasetPrefetcher::Private                    */
+/************************************************************************/
+
+struct GDALDatasetPrefetcher::Private
+{
+    struct Slot
+    {
+        Private *poPrivate = nullptr;
+        std::string osFilename{};
+        std::mutex oMutex{};
+        std::condition_variable oCV{};
+        bool bDone = false;
+        GDALDataset *poDS = nullptr;
+        std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+    };
+
+    int nMaxInFlight = 1;
+    OpenFunc pfnOpen{};
+    CPLStringList aosThreadLocalConfigOptions{};
+    std::unique_ptr<CPLJobQueue> poJobQueue{};
+    std::deque<std::unique_ptr<Slot>> apoSlots{};
+
+    void Open(Slot *poSlot);
+
+    static void OpenJob(void *pData)
+    {
+        Slot *poSlot = static_cast<Slot *>(pData);
+        poSlot->poPrivate->Open(poSlot);
+    }
+};
+
+/************************************************************************/
+/*                   GDALDatasetPrefetcher::Private::Open()             */
+/************************************************************************/
+
+// Runs in a worker thread
+void GDALDatasetPrefetcher::Private::Open(Slot *poSlot)
+{
+    char **papszOldOptions = CPLGetThreadLocalConfigOptions();
+    CPLSetThreadLocalConfigOptions(aosThreadLocalConfigOptions.List());
+
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors;
+    CPLInstallErrorHandlerAccumulator(aoErrors);
+    // Debug messages can be emitted right away
+    CPLSetCurrentErrorHandlerCatchDebug(false);
+    GDALDataset *poDS = pfnOpen(poSlot->osFilename);
+    CPLUninstallErrorHandlerAccumulator();
+
+    CPLSetThreadLocalConfigOptions(papszOldOptions);
+    CSLDestroy(papszOldOptions);
+
+    std::lock_guard<std::mutex> oLock(poSlot->oMutex);
+    poSlot->poDS = poDS;
+    poSlot->aoErrors = std::move(aoErrors);
+    poSlot->bDone = true;
+    poSlot->oCV.notify_one();
+}
+
+/************************************************************************/
+/*                        GDALDatasetPrefetcher()                       */
+/************************************************************************/
+
+GDALDatasetPrefetcher::GDALDatasetPrefetcher(int nMaxInFlight,
+                                             const OpenFunc &pfnOpen)
+    : m_poPrivate(std::make_unique<Private>())
+{
+    m_poPrivate->nMaxInFlight = std::max(1, nMaxInFlight);
+    m_poPrivate->pfnOpen = pfnOpen;
+    if (m_poPrivate->nMaxInFlight > 1)
+    {
+        auto poThreadPool = GDALGetGlobalThreadPool(nMaxInFlight);
+        if (poThreadPool)
+            m_poPrivate->poJobQueue = poThreadPool->CreateJobQueue();
+        if (m_poPrivate->poJobQueue)
+            m_poPrivate->aosThreadLocalConfigOptions.Assign(
+                CPLGetThreadLocalConfigOptions(), true);
+        else
+            m_poPrivate->nMaxInFlight = 1;
+    }
+}
+
+/************************************************************************/
+/*                       ~GDALDatasetPrefetcher()                       */
+/************************************************************************/
+
+GDALDatasetPrefetcher::~GDALDatasetPrefetcher()
+{
+    if (m_poPrivate->poJobQueue)
+        m_poPrivate->poJobQueue->WaitCompletion();
+    for (auto &poSlot : m_poPrivate->apoSlots)
+    {
+        if (poSlot->poDS)
+            GDALClose(GDALDataset::ToHandle(poSlot->poDS));
+    }
+}
+
+/************************************************************************/
+/*                               IsFull()                               */
+/************************************************************************/
+
+bool GDALDatasetPrefetcher::IsFull() const
+{
+    return static_cast<int>(m_poPrivate->apoSlots.size()) >=
+           m_poPrivate->nMaxInFlight;
+}
+
+/************************************************************************/
+/*                              IsEmpty()                               */
+/************************************************************************/
+
+bool GDALDatasetPrefetcher::IsEmpty() const
+{
+    return m_poPrivate->apoSlots.empty();
+}
+
+/************************************************************************/
+/*                               Submit()                               */
+/************************************************************************/
+
+void GDALDatasetPrefetcher::Submit(const std::string &osFilename)
+{
+    auto poSlot = std::make_unique<Private::Slot>();
+    poSlot->poPrivate = m_poPrivate.get();
+    poSlot->osFilename = osFilename;
+    // The slot is kept alive until Next() has waited for the job.
+    Private::Slot *poSlotPtr = poSlot.get();
+    m_poPrivate->apoSlots.push_back(std::move(poSlot));
+    if (m_poPrivate->poJobQueue &&
+        !m_poPrivate->poJobQueue->SubmitJob(Private::OpenJob, poSlotPtr))
+    {
+        m_poPrivate->Open(poSlotPtr);
+    }
+}
+
+/************************************************************************/
+/*                                Next()                                */
+/************************************************************************/
+
+GDALDataset *GDALDatasetPrefetcher::Next(std::string &osFilename)
+{
+    if (m_poPrivate->apoSlots.empty())
+    {
+        osFilename.clear();
+        return nullptr;
+    }
+    auto poSlot = std::move(m_poPrivate->apoSlots.front());
+    m_poPrivate->apoSlots.pop_front();
+    osFilename = poSlot->osFilename;
+
+    if (!m_poPrivate->poJobQueue)
+        return m_poPrivate->pfnOpen(osFilename);
+
+    {
+        std::unique_lock<std::mutex> oLock(poSlot->oMutex);
+        poSlot->oCV.wait(oLock, [&poSlot] { return poSlot->bDone; });
+    }
+    for (const auto &oError : poSlot->aoErrors)
+    {
+        CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+    }
+    return poSlot->poDS;
+}
@@ -91,8 +91,13 @@ CPL_C_END
 #ifdef __cplusplus
 
 #include "cpl_string.h"
+#include <functional>
+#include <memory>
+#include <string>
 #include <vector>
 
+class GDALDataset;
+
 std::vector<CPLString> CPL_DLL GetOutputDriversFor(const char *pszDestFilename,
                                                    int nFlagRasterVector);
 CPLString CPL_DLL GetOutputDriverForRaster(const char *pszDestFilename);
@@ -107,6 +112,53 @@ int ArgIsNumeric(const char *pszArg);
 constexpr int OVR_LEVEL_AUTO = -2;
 constexpr int OVR_LEVEL_NONE = -1;
 
+/************************************************************************/
+/*                        GDALDatasetPrefetcher                         */
+/************************************************************************/
+
+/** Opens datasets on worker threads ahead of their consumption, so that
+ * the latency of opening many (remote) datasets overlaps.
+ *
+ * Datasets are returned by Next() in the order of their submission, and
+ * the errors emitted while opening them are re-emitted at that time from
+ * the calling thread, so that results do not depend on the scheduling.
+ * The thread-local configuration options of the thread that created the
+ * prefetcher are applied to the opening jobs.
+ *
+ * With nMaxInFlight <= 1, datasets are opened synchronously by Next().
+ */
+class GDALDatasetPrefetcher
+{
+  public:
+    /** Opens the dataset. May also query the properties that will be used
+     * by the consumer, to fetch them in the background. */
+    typedef std::function<GDALDataset *(const std::string &osFilename)>
+        OpenFunc;
+
+    GDALDatasetPrefetcher(int nMaxInFlight, const OpenFunc &pfnOpen);
+    ~GDALDatasetPrefetcher();
+
+    /** Whether as many datasets as allowed are being opened */
+    bool IsFull() const;
+
+    /** Whether there is no pending dataset */
+    bool IsEmpty() const;
+
+    void Submit(const std::string &osFilename);
+
+    /** Returns the first pending dataset (to be closed by the caller), or
+     * nullptr if it could not be opened, and its name in osFilename. */
+    GDALDataset *Next(std::string &osFilename);
+
+  private:
+    struct Private;
+    std::unique_ptr<Private> m_poPrivate;
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALDatasetPrefetcher)
+};
+
+int GDALGetNumThreadsForPrefetching();
+
 #endif /* __cplusplus */
 
 #endif /* COMMONUTILS_H_INCLUDED */
@@ -43,7 +43,7 @@ static void Usage(bool bIsError, const char *pszErrorMsg = nullptr)
     fprintf(bIsError ? stderr : stdout,
             "Usage: gdal_footprint [--help] [--help-general]\n"
             "       [-b <band>]... [-combine_bands union|intersection]\n"
-            "       [-oo <NAME>=<VALUE>]... [-ovr <index>]\n"
+            "       [-oo <NAME>=<VALUE>]... [-ovr <index>] [-accuracy <pixels>]\n"
             "       [-srcnodata \"<value>[ <value>]...\"]\n"
             "       [-t_cs pixel|georef] [-t_srs <srs_def>] [-split_polys]\n"
             "       [-convex_hull] [-densify <value>] [-simplify <value>]\n"
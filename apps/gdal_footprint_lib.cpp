@@ -84,6 +84,10 @@ struct GDALFootprintOptions
     /*! Overview index: 0 = first overview level */
     int nOvrIndex = -1;
 
+    /*! Acceptable inaccuracy of the footprint, in full resolution pixels.
+     * Values greater than 1 allow computing it from a lower resolution. */
+    double dfAccuracy = 0;
+
     /** Whether output geometry should be in georeferenced coordinates, if
      * possible (if explicitly requested, bOutCSGeorefRequested is also set)
      * false = in pixel coordinates
@@ -380,6 +384,95 @@ class GDALFootprintCombinedMaskBand final : public GDALRasterBand
     }
 };
 
+/************************************************************************/
+/*                  GDALFootprintDownsampledMaskBand                    */
+/************************************************************************/
+
+// Exposes a mask band at a lower resolution, with nearest neighbour
+// subsampling, when no suitable overview is available.
+class GDALFootprintDownsampledMaskBand final : public GDALRasterBand
+{
+    GDALRasterBand *m_poSrcBand = nullptr;
+    double m_dfXRatio = 1;
+    double m_dfYRatio = 1;
+
+  public:
+    GDALFootprintDownsampledMaskBand(GDALRasterBand *poSrcBand,
+                                     double dfFactor)
+        : m_poSrcBand(poSrcBand)
+    {
+        nRasterXSize = std::max(
+            1, static_cast<int>(std::ceil(m_poSrcBand->GetXSize() / dfFactor)));
+        nRasterYSize = std::max(
+            1, static_cast<int>(std::ceil(m_poSrcBand->GetYSize() / dfFactor)));
+        m_dfXRatio = double(m_poSrcBand->GetXSize()) / nRasterXSize;
+        m_dfYRatio = double(m_poSrcBand->GetYSize()) / nRasterYSize;
+        eDataType = m_poSrcBand->GetRasterDataType();
+        nBlockXSize = std::min(nRasterXSize, 256);
+        nBlockYSize = std::min(nRasterYSize, 256);
+    }
+
+  protected:
+    CPLErr IReadBlock(int nBlockXOff, int nBlockYOff, void *pData) override
+    {
+        int nWindowXSize;
+        int nWindowYSize;
+        GetActualBlockSize(nBlockXOff, nBlockYOff, &nWindowXSize,
+                           &nWindowYSize);
+        GDALRasterIOExtraArg sExtraArg;
+        INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+        const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
+        return IRasterIO(GF_Read, nBlockXOff * nBlockXSize,
+                         nBlockYOff * nBlockYSize, nWindowXSize, nWindowYSize,
+                         pData, nWindowXSize, nWindowYSize, eDataType, nDTSize,
+                         static_cast<GSpacing>(nDTSize) * nBlockXSize,
+                         &sExtraArg);
+    }
+
+    CPLErr IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize,
+                     int nYSize, void *pData, int nBufXSize, int nBufYSize,
+                     GDALDataType eBufType, GSpacing nPixelSpace,
+                     GSpacing nLineSpace,
+                     GDALRasterIOExtraArg *psExtraArg) override
+    {
+        if (eRWFlag != GF_Read)
+            return CE_Failure;
+
+        // Forward the request to the source band, expressed in its own
+        // pixel coordinates
+        const double dfSrcXOff = nXOff * m_dfXRatio;
+        const double dfSrcYOff = nYOff * m_dfYRatio;
+        const double dfSrcXSize = nXSize * m_dfXRatio;
+        const double dfSrcYSize = nYSize * m_dfYRatio;
+        const int nSrcXOff = static_cast<int>(dfSrcXOff);
+        const int nSrcYOff = static_cast<int>(dfSrcYOff);
+        const int nSrcXSize = std::max(
+            1, std::min(m_poSrcBand->GetXSize() - nSrcXOff,
+                        static_cast<int>(
+                            std::ceil(dfSrcXOff + dfSrcXSize - 1e-10)) -
+                            nSrcXOff));
+        const int nSrcYSize = std::max(
+            1, std::min(m_poSrcBand->GetYSize() - nSrcYOff,
+                        static_cast<int>(
+                            std::ceil(dfSrcYOff + dfSrcYSize - 1e-10)) -
+                            nSrcYOff));
+
+        GDALRasterIOExtraArg sExtraArg;
+        INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+        sExtraArg.pfnProgress = psExtraArg->pfnProgress;
+        sExtraArg.pProgressData = psExtraArg->pProgressData;
+        sExtraArg.bFloatingPointWindowValidity = TRUE;
+        sExtraArg.dfXOff = dfSrcXOff;
+        sExtraArg.dfYOff = dfSrcYOff;
+        sExtraArg.dfXSize = dfSrcXSize;
+        sExtraArg.dfYSize = dfSrcYSize;
+        return m_poSrcBand->RasterIO(GF_Read, nSrcXOff, nSrcYOff, nSrcXSize,
+                                     nSrcYSize, pData, nBufXSize, nBufYSize,
+                                     eBufType, nPixelSpace, nLineSpace,
+                                     &sExtraArg);
+    }
+};
+
 /************************************************************************/
 /*                    GetOutputLayerAndUpdateDstDS()                    */
 /************************************************************************/
@@ -699,6 +792,75 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
             adfSrcNoData.emplace_back(CPLAtof(aosSrcNoData[i]));
         }
     }
+    /* -------------------------------------------------------------------- */
+    /*      When a footprint accuracy coarser than the pixel is acceptable, */
+    /*      select the lowest resolution overview compatible with it.       */
+    /* -------------------------------------------------------------------- */
+    int nOvrIndex = psOptions->nOvrIndex;
+    // The accuracy is not applied on top of an explicitly selected overview
+    double dfRemainingFactor = nOvrIndex < 0 ? psOptions->dfAccuracy : 1;
+    if (nOvrIndex < 0 && psOptions->dfAccuracy > 1 && adfSrcNoData.empty())
+    {
+        const auto GetOvrMaskBand = [](GDALRasterBand *poBand, int iOvr)
+        {
+            GDALRasterBand *poOvrMaskBand = nullptr;
+            if (poBand->GetColorInterpretation() == GCI_AlphaBand)
+            {
+                poOvrMaskBand = poBand->GetOverview(iOvr);
+            }
+            else if (poBand->GetMaskFlags() == GMF_NODATA)
+            {
+                auto poOvrBand = poBand->GetOverview(iOvr);
+                if (poOvrBand && poOvrBand->GetMaskFlags() == GMF_NODATA)
+                    poOvrMaskBand = poOvrBand->GetMaskBand();
+            }
+            else
+            {
+                poOvrMaskBand = poBand->GetMaskBand()->GetOverview(iOvr);
+            }
+            return poOvrMaskBand;
+        };
+
+        double dfBestFactor = 1;
+        for (int iOvr = 0; anBands[0] >= 1 && anBands[0] <= nBandCount &&
+                           iOvr < poSrcDS->GetRasterBand(anBands[0])
+                                      ->GetOverviewCount();
+             ++iOvr)
+        {
+            double dfFactor = 0;
+            for (const int nBand : anBands)
+            {
+                if (nBand <= 0 || nBand > nBandCount)
+                {
+                    dfFactor = 0;
+                    break;
+                }
+                auto poOvrMaskBand =
+                    GetOvrMaskBand(poSrcDS->GetRasterBand(nBand), iOvr);
+                if (!poOvrMaskBand)
+                {
+                    dfFactor = 0;
+                    break;
+                }
+                dfFactor = std::max(
+                    double(poSrcDS->GetRasterXSize()) /
+                        poOvrMaskBand->GetXSize(),
+                    double(poSrcDS->GetRasterYSize()) /
+                        poOvrMaskBand->GetYSize());
+            }
+            if (dfFactor > dfBestFactor && dfFactor <= psOptions->dfAccuracy)
+            {
+                dfBestFactor = dfFactor;
+                nOvrIndex = iOvr;
+            }
+        }
+        dfRemainingFactor = psOptions->dfAccuracy / dfBestFactor;
+        if (nOvrIndex >= 0)
+        {
+            CPLDebug("GDAL_FOOTPRINT", "Using overview level %d", nOvrIndex);
+        }
+    }
+
     bool bGlobalMask = true;
     std::vector<std::unique_ptr<GDALRasterBand>> apoTmpNoDataMaskBands;
     for (size_t i = 0; i < anBands.size(); ++i)
@@ -736,14 +898,14 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
                 }
                 poMaskBand = poBand->GetMaskBand();
             }
-            if (psOptions->nOvrIndex >= 0)
+            if (nOvrIndex >= 0)
             {
                 if (nMaskFlags == GMF_NODATA)
                 {
                     // If the mask band is based on nodata, we don't need
                     // to check the overviews of the mask band, but we
                     // can take the mask band of the overviews
-                    auto poOvrBand = poBand->GetOverview(psOptions->nOvrIndex);
+                    auto poOvrBand = poBand->GetOverview(nOvrIndex);
                     if (!poOvrBand)
                     {
                         if (poBand->GetOverviewCount() == 0)
@@ -753,7 +915,7 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
                                 "Overview index %d invalid for this dataset. "
                                 "Bands of this dataset have no "
                                 "precomputed overviews",
-                                psOptions->nOvrIndex);
+                                nOvrIndex);
                         }
                         else
                         {
@@ -761,7 +923,7 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
                                 CE_Failure, CPLE_AppDefined,
                                 "Overview index %d invalid for this dataset. "
                                 "Value should be in [0,%d] range",
-                                psOptions->nOvrIndex,
+                                nOvrIndex,
                                 poBand->GetOverviewCount() - 1);
                         }
                         return false;
@@ -776,7 +938,7 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
                 }
                 else
                 {
-                    poMaskBand = poMaskBand->GetOverview(psOptions->nOvrIndex);
+                    poMaskBand = poMaskBand->GetOverview(nOvrIndex);
                     if (!poMaskBand)
                     {
                         if (poBand->GetMaskBand()->GetOverviewCount() == 0)
@@ -786,7 +948,7 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
                                 "Overview index %d invalid for this dataset. "
                                 "Mask bands of this dataset have no "
                                 "precomputed overviews",
-                                psOptions->nOvrIndex);
+                                nOvrIndex);
                         }
                         else
                         {
@@ -794,7 +956,7 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
                                 CE_Failure, CPLE_AppDefined,
                                 "Overview index %d invalid for this dataset. "
                                 "Value should be in [0,%d] range",
-                                psOptions->nOvrIndex,
+                                nOvrIndex,
                                 poBand->GetMaskBand()->GetOverviewCount() - 1);
                         }
                         return false;
@@ -805,6 +967,21 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
         }
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      If the accuracy still allows it, subsample the mask bands.      */
+    /* -------------------------------------------------------------------- */
+    std::vector<std::unique_ptr<GDALRasterBand>> apoTmpDownsampledMaskBands;
+    if (dfRemainingFactor >= 2)
+    {
+        for (auto &poMaskBand : apoSrcMaskBands)
+        {
+            apoTmpDownsampledMaskBands.emplace_back(
+                std::make_unique<GDALFootprintDownsampledMaskBand>(
+                    poMaskBand, dfRemainingFactor));
+            poMaskBand = apoTmpDownsampledMaskBands.back().get();
+        }
+    }
+
     std::unique_ptr<OGRCoordinateTransformation> poCT_GT;
     std::array<double, 6> adfGeoTransform{{0.0, 1.0, 0.0, 0.0, 0.0, 1.0}};
     if (psOptions->bOutCSGeoref &&
@@ -829,10 +1006,11 @@ static bool GDALFootprintProcess(GDALDataset *poSrcDS, OGRLayer *poDstLayer,
                  "input dataset has no geotransform.");
         return false;
     }
-    else if (psOptions->nOvrIndex >= 0)
+    else if (apoSrcMaskBands[0]->GetXSize() != poSrcDS->GetRasterXSize() ||
+             apoSrcMaskBands[0]->GetYSize() != poSrcDS->GetRasterYSize())
     {
-        // Transform from overview pixel coordinates to full resolution
-        // pixel coordinates
+        // Transform from overview (or subsampled) pixel coordinates to full
+        // resolution pixel coordinates
         auto poMaskBand = apoSrcMaskBands[0];
         adfGeoTransform[1] =
             double(poSrcDS->GetRasterXSize()) / poMaskBand->GetXSize();
@@ -1401,6 +1579,12 @@ GDALFootprintOptionsNew(char **papszArgv,
             psOptions->nOvrIndex = atoi(papszArgv[i]);
         }
 
+        else if (i < argc - 1 && EQUAL(papszArgv[i], "-accuracy"))
+        {
+            i++;
+            psOptions->dfAccuracy = CPLAtof(papszArgv[i]);
+        }
+
         else if (papszArgv[i][0] == '-')
         {
             CPLError(CE_Failure, CPLE_NotSupported, "Unknown option name '%s'",
@@ -0,0 +1,1605 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Utilities
+ * Purpose:  Generate a tile pyramid, according to a tile matrix set, as a
+ *           directory of tiles, MBTiles or PMTiles.
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_conv.h"
+#include "cpl_string.h"
+#include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_version.h"
+#include "gdal.h"
+#include "gdal_alg.h"
+#include "gdal_priv.h"
+#include "gdal_thread_pool.h"
+#include "gdalwarper.h"
+#include "ogr_spatialref.h"
+#include "ogrsf_frmts.h"
+#include "tilematrixset.hpp"
+#include "commonutils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/************************************************************************/
+/*                               Usage()                                */
+/************************************************************************/
+
+static void Usage(bool bIsError, const char *pszErrorMsg = nullptr)
+
+{
+    fprintf(
+        bIsError ? stderr : stdout,
+        "Usage: gdal_tiler [--help] [--help-general]\n"
+        "                  [-tms <tile_matrix_set>] [-z <min>-<max>|<max>]\n"
+        "                  [-r <resampling>] [-tile_format PNG|JPEG|WEBP]\n"
+        "                  [-tile_co <NAME>=<VALUE>]... "
+        "[-of DIR|MBTiles|PMTiles]\n"
+        "                  [-metatile <n>] [-j <num_threads>|ALL_CPUS]\n"
+        "                  [-resume] [-q]\n"
+        "                  <src_raster> <dst>\n");
+
+    if (pszErrorMsg != nullptr)
+        fprintf(stderr, "\nFAILURE: %s\n", pszErrorMsg);
+
+    exit(bIsError ? 1 : 0);
+}
+
+/************************************************************************/
+/*                            GetResampleAlg()                          */
+/************************************************************************/
+
+static bool GetResampleAlg(const char *pszResampling,
+                           GDALResampleAlg &eResampleAlg)
+{
+    if (STARTS_WITH_CI(pszResampling, "near"))
+        eResampleAlg = GRA_NearestNeighbour;
+    else if (EQUAL(pszResampling, "bilinear"))
+        eResampleAlg = GRA_Bilinear;
+    else if (EQUAL(pszResampling, "cubic"))
+        eResampleAlg = GRA_Cubic;
+    else if (EQUAL(pszResampling, "cubicspline"))
+        eResampleAlg = GRA_CubicSpline;
+    else if (EQUAL(pszResampling, "lanczos"))
+        eResampleAlg = GRA_Lanczos;
+    else if (EQUAL(pszResampling, "average"))
+        eResampleAlg = GRA_Average;
+    else if (EQUAL(pszResampling, "mode"))
+        eResampleAlg = GRA_Mode;
+    else
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg, "Unknown resampling method: %s.",
+                 pszResampling);
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                             DownsampleBy2()                          */
+/************************************************************************/
+
+// Average 2x2 pixels of a square pixel-interleaved image, whose last
+// component is alpha, weighting colors by alpha.
+static void DownsampleBy2(const GByte *pabySrc, int nSrcSize, int nComps,
+                          GByte *pabyDst)
+{
+    const int nDstSize = nSrcSize / 2;
+    const int nAlpha = nComps - 1;
+    const size_t nSrcLineStride = static_cast<size_t>(nSrcSize) * nComps;
+    for (int iY = 0; iY < nDstSize; ++iY)
+    {
+        const GByte *pabyLine0 = pabySrc + 2 * iY * nSrcLineStride;
+        const GByte *pabyLine1 = pabyLine0 + nSrcLineStride;
+        GByte *pabyDstLine =
+            pabyDst + static_cast<size_t>(iY) * nDstSize * nComps;
+        for (int iX = 0; iX < nDstSize; ++iX)
+        {
+            const GByte *p00 = pabyLine0 + 2 * iX * nComps;
+            const GByte *p01 = p00 + nComps;
+            const GByte *p10 = pabyLine1 + 2 * iX * nComps;
+            const GByte *p11 = p10 + nComps;
+            GByte *pDst = pabyDstLine + iX * nComps;
+            const int nSumAlpha = p00[nAlpha] + p01[nAlpha] + p10[nAlpha] +
+                                  p11[nAlpha];
+            if (nSumAlpha == 0)
+            {
+                memset(pDst, 0, nComps);
+                continue;
+            }
+            for (int iComp = 0; iComp < nAlpha; ++iComp)
+            {
+                const int nWeighted =
+                    p00[iComp] * p00[nAlpha] + p01[iComp] * p01[nAlpha] +
+                    p10[iComp] * p10[nAlpha] + p11[iComp] * p11[nAlpha];
+                pDst[iComp] =
+                    static_cast<GByte>((nWeighted + nSumAlpha / 2) / nSumAlpha);
+            }
+            pDst[nAlpha] = static_cast<GByte>((nSumAlpha + 2) / 4);
+        }
+    }
+}
+
+/************************************************************************/
+/*                              GDALTiler                               */
+/************************************************************************/
+
+// Generates the tiles of a quadtree of tile matrices:
+// - the tiles of the most detailed zoom level are warped by "metatiles" of
+//   nMetaTile x nMetaTile tiles, and the lower zoom levels within a metatile
+//   are obtained by successive 2x2 averaging in memory;
+// - zoom levels below that of the metatiles are obtained by assembling the
+//   4 child tiles of each tile, which are kept in memory by the depth-first
+//   traversal;
+// - tiles are encoded and written by worker threads.
+class GDALTiler
+{
+  public:
+    enum class OutputType
+    {
+        DIRECTORY,
+        MBTILES,
+        PMTILES,
+    };
+
+    // Options.
+    std::string m_osSrcFilename{};
+    std::string m_osDstFilename{};
+    std::string m_osTMS = "GoogleMapsCompatible";
+    int m_nMinZoom = -1;
+    int m_nMaxZoom = -1;
+    GDALResampleAlg m_eResampleAlg = GRA_Average;
+    std::string m_osTileFormat = "PNG";
+    CPLStringList m_aosTileCO{};
+    OutputType m_eOutputType = OutputType::DIRECTORY;
+    int m_nMetaTile = 8;
+    int m_nThreads = 1;
+    bool m_bResume = false;
+    GDALProgressFunc m_pfnProgress = GDALDummyProgress;
+
+    GDALTiler() = default;
+    ~GDALTiler();
+
+    bool Run();
+
+  private:
+    struct TileRange
+    {
+        int nMinX = 0;
+        int nMinY = 0;
+        int nMaxX = -1;
+        int nMaxY = -1;
+
+        bool Contains(int nX, int nY) const
+        {
+            return nX >= nMinX && nX <= nMaxX && nY >= nMinY && nY <= nMaxY;
+        }
+    };
+
+    struct EncodedTile
+    {
+        int nZ = 0;
+        int nX = 0;
+        int nY = 0;
+        std::vector<GByte> abyData{};
+    };
+
+    struct EncodeJob
+    {
+        GDALTiler *poTiler = nullptr;
+        int nZ = 0;
+        int nX = 0;
+        int nY = 0;
+        std::vector<GByte> abyPixels{};
+    };
+
+    using TileKey = std::tuple<int, int, int>;
+
+    std::unique_ptr<GDALDataset> m_poSrcDS{};
+    std::unique_ptr<gdal::TileMatrixSet> m_poTMS{};
+    OGRSpatialReference m_oTMSSRS{};
+    std::string m_osTMSSRS{};
+    bool m_bInvertAxis = false;
+    int m_nTileSize = 256;
+    double m_dfOriX = 0;
+    double m_dfOriY = 0;
+    double m_adfExtent[4] = {0, 0, 0, 0};
+    std::vector<TileRange> m_asRanges{};
+    int m_nBreakZoom = 0;
+
+    // Source bands, and source alpha band (0 if none).
+    std::vector<int> m_anSrcBands{};
+    int m_nSrcAlphaBand = 0;
+    // 1 (gray) or 3 (RGB) data components, followed by alpha.
+    int m_nDataComps = 1;
+    int m_nComps = 2;
+
+    void *m_hTransformArg = nullptr;
+    GDALDriver *m_poMEMDriver = nullptr;
+    GDALDriver *m_poTileDriver = nullptr;
+    std::string m_osExtension{};
+
+    CPLWorkerThreadPool *m_poThreadPool = nullptr;
+    std::unique_ptr<CPLJobQueue> m_poJobQueue{};
+    std::atomic<bool> m_bError{false};
+    std::atomic<int> m_nJobCounter{0};
+
+    // Directory output.
+    std::mutex m_oDirMutex{};
+    std::set<std::string> m_oCreatedDirs{};
+
+    // MBTiles output (also used as intermediate for PMTiles).
+    std::string m_osMBTilesFilename{};
+    std::unique_ptr<GDALDataset> m_poMBTilesDS{};
+    OGRLayer *m_poTilesLayer = nullptr;
+    OGRLayer *m_poProgressLayer = nullptr;
+    std::mutex m_oPendingMutex{};
+    std::vector<EncodedTile> m_asPendingTiles{};
+
+    // Resume support: nodes (tiles at or below the metatile zoom level)
+    // whose whole subtree has been written.
+    std::set<TileKey> m_oDoneNodes{};
+    std::vector<TileKey> m_aoPendingMarks{};
+    int m_nMetaTilesSinceCheckpoint = 0;
+    GIntBig m_nMetaTilesDone = 0;
+    GIntBig m_nMetaTilesTotal = 0;
+
+    bool OpenSource();
+    bool SetupTileMatrixSet();
+    bool SetupZoomLevels();
+    bool OpenOutput();
+    bool Finalize();
+
+    bool ProcessNode(int nZ, int nX, int nY, std::vector<GByte> &abyTile);
+    bool ProcessMetaTile(int nX, int nY, std::vector<GByte> &abyTile);
+    bool WarpMetaTile(int nCol0, int nRow0, int nCols, int nRows,
+                      GByte *pabyDst, int nDstStride);
+    void EmitTile(int nZ, int nX, int nY, const GByte *pabySrc,
+                  size_t nSrcLineStride);
+    static void EncodeJobFunc(void *pData);
+    bool EncodeTile(const EncodeJob &sJob, std::vector<GByte> &abyData);
+    bool WriteTile(int nZ, int nX, int nY, std::vector<GByte> &&abyData);
+    bool Checkpoint();
+    bool LoadExistingTile(int nZ, int nX, int nY, std::vector<GByte> &abyTile);
+    std::string GetTileFilename(int nZ, int nX, int nY) const;
+    std::string GetJournalFilename() const;
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALTiler)
+};
+
+/************************************************************************/
+/*                             ~GDALTiler()                             */
+/************************************************************************/
+
+GDALTiler::~GDALTiler()
+{
+    if (m_poJobQueue)
+        m_poJobQueue->WaitCompletion();
+    if (m_hTransformArg)
+        GDALDestroyGenImgProjTransformer(m_hTransformArg);
+}
+
+/************************************************************************/
+/*                             OpenSource()                             */
+/************************************************************************/
+
+bool GDALTiler::OpenSource()
+{
+    m_poSrcDS.reset(GDALDataset::Open(m_osSrcFilename.c_str(),
+                                      GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR));
+    if (!m_poSrcDS)
+        return false;
+
+    const int nBands = m_poSrcDS->GetRasterCount();
+    std::vector<int> anDataBands;
+    for (int i = 1; i <= nBands; ++i)
+    {
+        GDALRasterBand *poBand = m_poSrcDS->GetRasterBand(i);
+        if (poBand->GetRasterDataType() != GDT_Byte)
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "Only Byte rasters are supported. Use gdal_translate "
+                     "-ot Byte -scale first");
+            return false;
+        }
+        if (poBand->GetColorInterpretation() == GCI_AlphaBand)
+            m_nSrcAlphaBand = i;
+        else
+            anDataBands.push_back(i);
+    }
+    if (anDataBands.empty())
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "No data band in source");
+        return false;
+    }
+    if (anDataBands.size() == 1 &&
+        m_poSrcDS->GetRasterBand(anDataBands[0])->GetColorTable())
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Paletted rasters are not supported. Use gdal_translate "
+                 "-expand rgb(a) first");
+        return false;
+    }
+    m_nDataComps = anDataBands.size() >= 3 ? 3 : 1;
+    m_nComps = m_nDataComps + 1;
+    m_anSrcBands.assign(anDataBands.begin(),
+                        anDataBands.begin() + m_nDataComps);
+
+    double adfGT[6];
+    if (m_poSrcDS->GetGeoTransform(adfGT) != CE_None &&
+        m_poSrcDS->GetGCPCount() == 0)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Source raster is not georeferenced");
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                         SetupTileMatrixSet()                         */
+/************************************************************************/
+
+bool GDALTiler::SetupTileMatrixSet()
+{
+    m_poTMS = gdal::TileMatrixSet::parse(m_osTMS.c_str());
+    if (!m_poTMS)
+        return false;
+    if (!m_poTMS->haveAllLevelsSameTopLeft() ||
+        !m_poTMS->haveAllLevelsSameTileSize() ||
+        !m_poTMS->hasOnlyPowerOfTwoVaryingScales() ||
+        m_poTMS->hasVariableMatrixWidth())
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Unsupported tile matrix set: all zoom levels must have the "
+                 "same top left corner and tile size, and a resolution twice "
+                 "smaller than the previous one");
+        return false;
+    }
+    const auto &tmList = m_poTMS->tileMatrixList();
+    if (tmList.empty() || tmList[0].mTileWidth != tmList[0].mTileHeight)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Unsupported tile matrix set: tiles must be square");
+        return false;
+    }
+    m_nTileSize = tmList[0].mTileWidth;
+
+    if (m_oTMSSRS.SetFromUserInput(
+            m_poTMS->crs().c_str(),
+            OGRSpatialReference::SET_FROM_USER_INPUT_LIMITATIONS_get()) !=
+        OGRERR_NONE)
+    {
+        return false;
+    }
+    m_bInvertAxis = m_oTMSSRS.EPSGTreatsAsLatLong() != FALSE ||
+                    m_oTMSSRS.EPSGTreatsAsNorthingEasting() != FALSE;
+    m_oTMSSRS.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+    m_dfOriX = m_bInvertAxis ? tmList[0].mTopLeftY : tmList[0].mTopLeftX;
+    m_dfOriY = m_bInvertAxis ? tmList[0].mTopLeftX : tmList[0].mTopLeftY;
+
+    // "Normalize" SRS as AUTH:CODE
+    m_osTMSSRS = m_poTMS->crs();
+    const char *pszAuthCode = m_oTMSSRS.GetAuthorityCode(nullptr);
+    const char *pszAuthName = m_oTMSSRS.GetAuthorityName(nullptr);
+    if (pszAuthName && pszAuthCode)
+    {
+        m_osTMSSRS = pszAuthName;
+        m_osTMSSRS += ':';
+        m_osTMSSRS += pszAuthCode;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                           SetupZoomLevels()                          */
+/************************************************************************/
+
+bool GDALTiler::SetupZoomLevels()
+{
+    CPLStringList aosTO;
+    aosTO.SetNameValue("DST_SRS", m_osTMSSRS.c_str());
+    m_hTransformArg = GDALCreateGenImgProjTransformer2(
+        GDALDataset::ToHandle(m_poSrcDS.get()), nullptr, aosTO.List());
+    if (!m_hTransformArg)
+        return false;
+
+    double adfGT[6];
+    int nXSize = 0;
+    int nYSize = 0;
+    if (GDALSuggestedWarpOutput2(GDALDataset::ToHandle(m_poSrcDS.get()),
+                                 GDALGenImgProjTransform, m_hTransformArg,
+                                 adfGT, &nXSize, &nYSize, m_adfExtent,
+                                 0) != CE_None)
+    {
+        return false;
+    }
+
+    const auto &bbox = m_poTMS->bbox();
+    if (bbox.mCrs == m_poTMS->crs())
+    {
+        const double dfBBoxMinX =
+            m_bInvertAxis ? bbox.mLowerCornerY : bbox.mLowerCornerX;
+        const double dfBBoxMinY =
+            m_bInvertAxis ? bbox.mLowerCornerX : bbox.mLowerCornerY;
+        const double dfBBoxMaxX =
+            m_bInvertAxis ? bbox.mUpperCornerY : bbox.mUpperCornerX;
+        const double dfBBoxMaxY =
+            m_bInvertAxis ? bbox.mUpperCornerX : bbox.mUpperCornerY;
+        m_adfExtent[0] = std::max(m_adfExtent[0], dfBBoxMinX);
+        m_adfExtent[1] = std::max(m_adfExtent[1], dfBBoxMinY);
+        m_adfExtent[2] = std::min(m_adfExtent[2], dfBBoxMaxX);
+        m_adfExtent[3] = std::min(m_adfExtent[3], dfBBoxMaxY);
+        if (m_adfExtent[0] >= m_adfExtent[2] ||
+            m_adfExtent[1] >= m_adfExtent[3])
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Raster extent completely outside of tile matrix set "
+                     "bounding box");
+            return false;
+        }
+    }
+
+    const auto &tmList = m_poTMS->tileMatrixList();
+    const int nLevels = static_cast<int>(tmList.size());
+    if (m_nMaxZoom < 0)
+    {
+        // Zoom level whose resolution is the closest to the one of the
+        // source.
+        const double dfComputedRes = adfGT[1];
+        m_nMaxZoom = 0;
+        while (m_nMaxZoom + 1 < nLevels &&
+               tmList[m_nMaxZoom].mResX > dfComputedRes * (1 + 1e-8))
+        {
+            ++m_nMaxZoom;
+        }
+        if (m_nMaxZoom > 0 && tmList[m_nMaxZoom].mResX < dfComputedRes &&
+            tmList[m_nMaxZoom - 1].mResX / dfComputedRes <
+                dfComputedRes / tmList[m_nMaxZoom].mResX)
+        {
+            --m_nMaxZoom;
+        }
+    }
+    if (m_nMaxZoom >= nLevels)
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "Invalid maximum zoom level: should be in [0,%d]",
+                 nLevels - 1);
+        return false;
+    }
+
+    constexpr double TOLERANCE_IN_PIXEL = 0.499;
+    m_asRanges.resize(m_nMaxZoom + 1);
+    for (int nZ = 0; nZ <= m_nMaxZoom; ++nZ)
+    {
+        const auto &tm = tmList[nZ];
+        const double dfTileExtentX = tm.mResX * m_nTileSize;
+        const double dfTileExtentY = tm.mResY * m_nTileSize;
+        const double dfEpsX = TOLERANCE_IN_PIXEL * tm.mResX;
+        const double dfEpsY = TOLERANCE_IN_PIXEL * tm.mResY;
+        TileRange &sRange = m_asRanges[nZ];
+        sRange.nMinX = std::max(
+            0, static_cast<int>(std::floor(
+                   (m_adfExtent[0] - m_dfOriX + dfEpsX) / dfTileExtentX)));
+        sRange.nMinY = std::max(
+            0, static_cast<int>(std::floor(
+                   (m_dfOriY - m_adfExtent[3] + dfEpsY) / dfTileExtentY)));
+        sRange.nMaxX = std::min(
+            tm.mMatrixWidth - 1,
+            static_cast<int>(std::ceil((m_adfExtent[2] - m_dfOriX - dfEpsX) /
+                                       dfTileExtentX)) -
+                1);
+        sRange.nMaxY = std::min(
+            tm.mMatrixHeight - 1,
+            static_cast<int>(std::ceil((m_dfOriY - m_adfExtent[1] - dfEpsY) /
+                                       dfTileExtentY)) -
+                1);
+    }
+
+    if (m_nMinZoom < 0)
+    {
+        // Highest zoom level where the raster fits in a single tile.
+        m_nMinZoom = m_nMaxZoom;
+        while (m_nMinZoom > 0 &&
+               (m_asRanges[m_nMinZoom].nMaxX > m_asRanges[m_nMinZoom].nMinX ||
+                m_asRanges[m_nMinZoom].nMaxY > m_asRanges[m_nMinZoom].nMinY))
+        {
+            --m_nMinZoom;
+        }
+    }
+    if (m_nMinZoom > m_nMaxZoom)
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "Minimum zoom level greater than maximum zoom level");
+        return false;
+    }
+
+    // Zoom level of the metatiles.
+    int nMetaTileLevels = 0;
+    while ((2 << nMetaTileLevels) <= m_nMetaTile &&
+           nMetaTileLevels < m_nMaxZoom - m_nMinZoom)
+    {
+        ++nMetaTileLevels;
+    }
+    m_nMetaTile = 1 << nMetaTileLevels;
+    m_nBreakZoom = m_nMaxZoom - nMetaTileLevels;
+
+    const TileRange &sBreakRange = m_asRanges[m_nBreakZoom];
+    m_nMetaTilesTotal =
+        static_cast<GIntBig>(sBreakRange.nMaxX - sBreakRange.nMinX + 1) *
+        (sBreakRange.nMaxY - sBreakRange.nMinY + 1);
+
+    CPLDebug("GDAL_TILER", "Zoom levels %d to %d, metatiles at zoom %d",
+             m_nMinZoom, m_nMaxZoom, m_nBreakZoom);
+    return true;
+}
+
+/************************************************************************/
+/*                          GetTileFilename()                           */
+/************************************************************************/
+
+std::string GDALTiler::GetTileFilename(int nZ, int nX, int nY) const
+{
+    return CPLFormFilename(
+        CPLFormFilename(
+            CPLFormFilename(m_osDstFilename.c_str(), CPLSPrintf("%d", nZ),
+                            nullptr),
+            CPLSPrintf("%d", nX), nullptr),
+        CPLSPrintf("%d", nY), m_osExtension.c_str());
+}
+
+/************************************************************************/
+/*                         GetJournalFilename()                         */
+/************************************************************************/
+
+std::string GDALTiler::GetJournalFilename() const
+{
+    return CPLFormFilename(m_osDstFilename.c_str(), ".gdal_tiler_progress",
+                           nullptr);
+}
+
+/************************************************************************/
+/*                             OpenOutput()                             */
+/************************************************************************/
+
+bool GDALTiler::OpenOutput()
+{
+    m_poMEMDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+    m_poTileDriver =
+        GetGDALDriverManager()->GetDriverByName(m_osTileFormat.c_str());
+    if (!m_poMEMDriver || !m_poTileDriver)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "%s driver not available",
+                 m_poTileDriver ? "MEM" : m_osTileFormat.c_str());
+        return false;
+    }
+    m_osExtension = EQUAL(m_osTileFormat.c_str(), "JPEG")   ? "jpg"
+                    : EQUAL(m_osTileFormat.c_str(), "WEBP") ? "webp"
+                                                            : "png";
+
+    if (m_eOutputType == OutputType::DIRECTORY)
+    {
+        VSIStatBufL sStat;
+        const bool bExists = VSIStatL(m_osDstFilename.c_str(), &sStat) == 0;
+        if (bExists && !m_bResume)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "%s already exists. Use -resume to continue a "
+                     "previous run",
+                     m_osDstFilename.c_str());
+            return false;
+        }
+        if (!bExists &&
+            VSIMkdirRecursive(m_osDstFilename.c_str(), 0755) != 0)
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s",
+                     m_osDstFilename.c_str());
+            return false;
+        }
+        if (bExists)
+        {
+            const CPLStringList aosLines(
+                CSLLoad2(GetJournalFilename().c_str(), -1, -1, nullptr));
+            for (const char *pszLine : aosLines)
+            {
+                int nZ = 0;
+                int nX = 0;
+                int nY = 0;
+                if (sscanf(pszLine, "%d %d %d", &nZ, &nX, &nY) == 3)
+                    m_oDoneNodes.insert(TileKey(nZ, nX, nY));
+            }
+        }
+        return true;
+    }
+
+    // MBTiles output, or intermediate MBTiles file for PMTiles.
+    m_osMBTilesFilename = m_eOutputType == OutputType::MBTILES
+                              ? m_osDstFilename
+                              : m_osDstFilename + ".partial.mbtiles";
+    VSIStatBufL sStat;
+    const bool bExists = VSIStatL(m_osMBTilesFilename.c_str(), &sStat) == 0;
+    if (m_eOutputType == OutputType::PMTILES &&
+        VSIStatL(m_osDstFilename.c_str(), &sStat) == 0)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "%s already exists",
+                 m_osDstFilename.c_str());
+        return false;
+    }
+    if (bExists && !m_bResume)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "%s already exists. Use -resume to continue a previous run",
+                 m_osMBTilesFilename.c_str());
+        return false;
+    }
+
+    const char *const apszAllowedDrivers[] = {"SQLite", nullptr};
+    if (!bExists)
+    {
+        GDALDriver *poSQLiteDriver =
+            GetGDALDriverManager()->GetDriverByName("SQLite");
+        if (!poSQLiteDriver)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "SQLite driver not available");
+            return false;
+        }
+        const char *const apszDSCO[] = {"METADATA=NO", nullptr};
+        std::unique_ptr<GDALDataset> poDS(poSQLiteDriver->Create(
+            m_osMBTilesFilename.c_str(), 0, 0, 0, GDT_Unknown,
+            const_cast<char **>(apszDSCO)));
+        if (!poDS)
+            return false;
+        for (const char *pszSQL :
+             {"CREATE TABLE metadata (name TEXT, value TEXT)",
+              "CREATE TABLE tiles (zoom_level INTEGER, tile_column INTEGER, "
+              "tile_row INTEGER, tile_data BLOB)",
+              "CREATE UNIQUE INDEX tile_index ON tiles "
+              "(zoom_level, tile_column, tile_row)",
+              "CREATE TABLE gdal_tiler_progress (zoom_level INTEGER, "
+              "tile_column INTEGER, tile_row INTEGER)"})
+        {
+            CPLErrorReset();
+            poDS->ExecuteSQL(pszSQL, nullptr, nullptr);
+            if (CPLGetLastErrorType() == CE_Failure)
+                return false;
+        }
+    }
+
+    // (Re)open so that the tables are seen as layers.
+    m_poMBTilesDS.reset(GDALDataset::Open(
+        m_osMBTilesFilename.c_str(),
+        GDAL_OF_VECTOR | GDAL_OF_UPDATE | GDAL_OF_VERBOSE_ERROR,
+        apszAllowedDrivers));
+    if (!m_poMBTilesDS)
+        return false;
+    m_poTilesLayer = m_poMBTilesDS->GetLayerByName("tiles");
+    m_poProgressLayer = m_poMBTilesDS->GetLayerByName("gdal_tiler_progress");
+    if (!m_poTilesLayer || !m_poProgressLayer)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "%s is not a MBTiles file created by gdal_tiler",
+                 m_osMBTilesFilename.c_str());
+        return false;
+    }
+    for (auto &&poFeature : m_poProgressLayer)
+    {
+        m_oDoneNodes.insert(TileKey(poFeature->GetFieldAsInteger(0),
+                                    poFeature->GetFieldAsInteger(1),
+                                    poFeature->GetFieldAsInteger(2)));
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                            WarpMetaTile()                            */
+/************************************************************************/
+
+// Warp nCols x nRows tiles of the maximum zoom level, starting at tile
+// (nCol0, nRow0), into pabyDst.
+bool GDALTiler::WarpMetaTile(int nCol0, int nRow0, int nCols, int nRows,
+                             GByte *pabyDst, int nDstStride)
+{
+    const auto &tm = m_poTMS->tileMatrixList()[m_nMaxZoom];
+    const int nXSize = nCols * m_nTileSize;
+    const int nYSize = nRows * m_nTileSize;
+    std::unique_ptr<GDALDataset> poMemDS(m_poMEMDriver->Create(
+        "", nXSize, nYSize, m_nComps, GDT_Byte, nullptr));
+    if (!poMemDS)
+        return false;
+    double adfDstGT[6] = {m_dfOriX + nCol0 * m_nTileSize * tm.mResX,
+                          tm.mResX,
+                          0,
+                          m_dfOriY - nRow0 * m_nTileSize * tm.mResY,
+                          0,
+                          -tm.mResY};
+    poMemDS->SetGeoTransform(adfDstGT);
+    poMemDS->SetSpatialRef(&m_oTMSSRS);
+    GDALSetGenImgProjTransformerDstGeoTransform(m_hTransformArg, adfDstGT);
+
+    GDALWarpOptions *psWO = GDALCreateWarpOptions();
+    psWO->hSrcDS = GDALDataset::ToHandle(m_poSrcDS.get());
+    psWO->hDstDS = GDALDataset::ToHandle(poMemDS.get());
+    psWO->eResampleAlg = m_eResampleAlg;
+    psWO->eWorkingDataType = GDT_Byte;
+    psWO->pfnTransformer = GDALGenImgProjTransform;
+    psWO->pTransformerArg = m_hTransformArg;
+    psWO->nBandCount = m_nDataComps;
+    psWO->panSrcBands =
+        static_cast<int *>(CPLMalloc(sizeof(int) * m_nDataComps));
+    psWO->panDstBands =
+        static_cast<int *>(CPLMalloc(sizeof(int) * m_nDataComps));
+    int bHasNoData = FALSE;
+    const double dfNoData =
+        m_poSrcDS->GetRasterBand(m_anSrcBands[0])->GetNoDataValue(&bHasNoData);
+    if (bHasNoData && m_nSrcAlphaBand == 0)
+    {
+        psWO->padfSrcNoDataReal =
+            static_cast<double *>(CPLMalloc(sizeof(double) * m_nDataComps));
+    }
+    for (int i = 0; i < m_nDataComps; ++i)
+    {
+        psWO->panSrcBands[i] = m_anSrcBands[i];
+        psWO->panDstBands[i] = i + 1;
+        if (psWO->padfSrcNoDataReal)
+            psWO->padfSrcNoDataReal[i] = dfNoData;
+    }
+    psWO->nSrcAlphaBand = m_nSrcAlphaBand;
+    psWO->nDstAlphaBand = m_nComps;
+    psWO->papszWarpOptions =
+        CSLSetNameValue(psWO->papszWarpOptions, "INIT_DEST", "0");
+    psWO->papszWarpOptions =
+        CSLSetNameValue(psWO->papszWarpOptions, "NUM_THREADS",
+                        CPLSPrintf("%d", m_nThreads));
+    if (psWO->padfSrcNoDataReal)
+    {
+        psWO->papszWarpOptions = CSLSetNameValue(
+            psWO->papszWarpOptions, "UNIFIED_SRC_NODATA", "YES");
+    }
+
+    CPLErr eErr;
+    {
+        GDALWarpOperation oWO;
+        eErr = oWO.Initialize(psWO);
+        if (eErr == CE_None)
+            eErr = oWO.ChunkAndWarpImage(0, 0, nXSize, nYSize);
+    }
+    psWO->pTransformerArg = nullptr;
+    GDALDestroyWarpOptions(psWO);
+
+    if (eErr == CE_None)
+    {
+        eErr = poMemDS->RasterIO(GF_Read, 0, 0, nXSize, nYSize, pabyDst,
+                                 nXSize, nYSize, GDT_Byte, m_nComps, nullptr,
+                                 m_nComps, static_cast<GSpacing>(nDstStride),
+                                 1, nullptr);
+    }
+    return eErr == CE_None;
+}
+
+/************************************************************************/
+/*                              EmitTile()                              */
+/************************************************************************/
+
+// Submit a tile for encoding, unless it is fully transparent.
+void GDALTiler::EmitTile(int nZ, int nX, int nY, const GByte *pabySrc,
+                         size_t nSrcLineStride)
+{
+    const size_t nTileLineSize = static_cast<size_t>(m_nTileSize) * m_nComps;
+    bool bEmpty = true;
+    for (int iY = 0; iY < m_nTileSize && bEmpty; ++iY)
+    {
+        const GByte *pabyLine = pabySrc + iY * nSrcLineStride;
+        for (size_t i = m_nComps - 1; i < nTileLineSize; i += m_nComps)
+        {
+            if (pabyLine[i])
+            {
+                bEmpty = false;
+                break;
+            }
+        }
+    }
+    if (bEmpty)
+        return;
+
+    auto psJob = new EncodeJob();
+    psJob->poTiler = this;
+    psJob->nZ = nZ;
+    psJob->nX = nX;
+    psJob->nY = nY;
+    psJob->abyPixels.resize(nTileLineSize * m_nTileSize);
+    for (int iY = 0; iY < m_nTileSize; ++iY)
+    {
+        memcpy(psJob->abyPixels.data() + iY * nTileLineSize,
+               pabySrc + iY * nSrcLineStride, nTileLineSize);
+    }
+
+    if (m_poJobQueue)
+    {
+        // Bound the number of tiles waiting for encoding.
+        m_poJobQueue->WaitCompletion(m_nThreads * 64);
+        m_poJobQueue->SubmitJob(EncodeJobFunc, psJob);
+    }
+    else
+    {
+        EncodeJobFunc(psJob);
+    }
+}
+
+/************************************************************************/
+/*                            EncodeJobFunc()                           */
+/************************************************************************/
+
+void GDALTiler::EncodeJobFunc(void *pData)
+{
+    std::unique_ptr<EncodeJob> psJob(static_cast<EncodeJob *>(pData));
+    GDALTiler *poTiler = psJob->poTiler;
+    if (poTiler->m_bError)
+        return;
+    std::vector<GByte> abyData;
+    if (!poTiler->EncodeTile(*psJob, abyData) ||
+        !poTiler->WriteTile(psJob->nZ, psJob->nX, psJob->nY,
+                            std::move(abyData)))
+    {
+        poTiler->m_bError = true;
+    }
+}
+
+/************************************************************************/
+/*                             EncodeTile()                             */
+/************************************************************************/
+
+bool GDALTiler::EncodeTile(const EncodeJob &sJob, std::vector<GByte> &abyData)
+{
+    const int nAlpha = m_nComps - 1;
+    const size_t nPixels = static_cast<size_t>(m_nTileSize) * m_nTileSize;
+    bool bOpaque = true;
+    for (size_t i = 0; i < nPixels && bOpaque; ++i)
+        bOpaque = sJob.abyPixels[i * m_nComps + nAlpha] == 255;
+
+    // Components of the pixel buffer written in each band of the tile.
+    std::vector<int> anComps;
+    const bool bWebP = EQUAL(m_osTileFormat.c_str(), "WEBP");
+    if (bWebP && m_nDataComps == 1)
+        anComps = {0, 0, 0};
+    else
+    {
+        for (int i = 0; i < m_nDataComps; ++i)
+            anComps.push_back(i);
+    }
+    if (!bOpaque && !EQUAL(m_osTileFormat.c_str(), "JPEG"))
+        anComps.push_back(nAlpha);
+
+    std::unique_ptr<GDALDataset> poMemDS(
+        m_poMEMDriver->Create("", m_nTileSize, m_nTileSize,
+                              static_cast<int>(anComps.size()), GDT_Byte,
+                              nullptr));
+    if (!poMemDS)
+        return false;
+    for (int iBand = 0; iBand < static_cast<int>(anComps.size()); ++iBand)
+    {
+        if (poMemDS->GetRasterBand(iBand + 1)->RasterIO(
+                GF_Write, 0, 0, m_nTileSize, m_nTileSize,
+                const_cast<GByte *>(sJob.abyPixels.data()) + anComps[iBand],
+                m_nTileSize, m_nTileSize, GDT_Byte, m_nComps,
+                static_cast<GSpacing>(m_nTileSize) * m_nComps,
+                nullptr) != CE_None)
+        {
+            return false;
+        }
+    }
+
+    const std::string osTmpFilename(
+        CPLSPrintf("/vsimem/gdal_tiler/%p_%d.%s", this, ++m_nJobCounter,
+                   m_osExtension.c_str()));
+    std::unique_ptr<GDALDataset> poOutDS(
+        m_poTileDriver->CreateCopy(osTmpFilename.c_str(), poMemDS.get(), FALSE,
+                                   m_aosTileCO.List(), nullptr, nullptr));
+    const bool bOK = poOutDS != nullptr;
+    poOutDS.reset();
+    if (bOK)
+    {
+        vsi_l_offset nLength = 0;
+        GByte *pabyBuffer =
+            VSIGetMemFileBuffer(osTmpFilename.c_str(), &nLength, FALSE);
+        abyData.assign(pabyBuffer, pabyBuffer + nLength);
+    }
+    VSIUnlink(osTmpFilename.c_str());
+    VSIUnlink((osTmpFilename + ".aux.xml").c_str());
+    return bOK;
+}
+
+/************************************************************************/
+/*                              WriteTile()                             */
+/************************************************************************/
+
+bool GDALTiler::WriteTile(int nZ, int nX, int nY, std::vector<GByte> &&abyData)
+{
+    if (m_eOutputType != OutputType::DIRECTORY)
+    {
+        // Written by the main thread at the next checkpoint.
+        EncodedTile sTile;
+        sTile.nZ = nZ;
+        sTile.nX = nX;
+        sTile.nY = nY;
+        sTile.abyData = std::move(abyData);
+        std::lock_guard<std::mutex> oLock(m_oPendingMutex);
+        m_asPendingTiles.push_back(std::move(sTile));
+        return true;
+    }
+
+    const std::string osFilename = GetTileFilename(nZ, nX, nY);
+    {
+        const std::string osDir = CPLGetPath(osFilename.c_str());
+        std::lock_guard<std::mutex> oLock(m_oDirMutex);
+        if (m_oCreatedDirs.find(osDir) == m_oCreatedDirs.end())
+        {
+            VSIStatBufL sStat;
+            if (VSIStatL(osDir.c_str(), &sStat) != 0 &&
+                VSIMkdirRecursive(osDir.c_str(), 0755) != 0)
+            {
+                CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s",
+                         osDir.c_str());
+                return false;
+            }
+            m_oCreatedDirs.insert(osDir);
+        }
+    }
+
+    VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "wb");
+    if (!fp)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s",
+                 osFilename.c_str());
+        return false;
+    }
+    bool bOK = VSIFWriteL(abyData.data(), 1, abyData.size(), fp) ==
+               abyData.size();
+    if (VSIFCloseL(fp) != 0)
+        bOK = false;
+    if (!bOK)
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot write %s",
+                 osFilename.c_str());
+    return bOK;
+}
+
+/************************************************************************/
+/*                             Checkpoint()                             */
+/************************************************************************/
+
+// Wait for pending tiles, write them (MBTiles), and record the nodes that
+// have been completed, so that an interrupted run can be resumed.
+bool GDALTiler::Checkpoint()
+{
+    if (m_poJobQueue)
+        m_poJobQueue->WaitCompletion();
+    m_nMetaTilesSinceCheckpoint = 0;
+    if (m_bError)
+        return false;
+
+    if (m_eOutputType == OutputType::DIRECTORY)
+    {
+        if (m_aoPendingMarks.empty())
+            return true;
+        VSILFILE *fp = VSIFOpenL(GetJournalFilename().c_str(), "ab");
+        if (!fp)
+            return false;
+        for (const auto &oKey : m_aoPendingMarks)
+        {
+            VSIFPrintfL(fp, "%d %d %d\n", std::get<0>(oKey),
+                        std::get<1>(oKey), std::get<2>(oKey));
+        }
+        m_aoPendingMarks.clear();
+        return VSIFCloseL(fp) == 0;
+    }
+
+    // Tiles and completion marks are committed in the same transaction.
+    const auto &tmList = m_poTMS->tileMatrixList();
+    if (m_poMBTilesDS->StartTransaction() != OGRERR_NONE)
+        return false;
+    bool bOK = true;
+    for (auto &sTile : m_asPendingTiles)
+    {
+        OGRFeature oFeature(m_poTilesLayer->GetLayerDefn());
+        oFeature.SetField("zoom_level", sTile.nZ);
+        oFeature.SetField("tile_column", sTile.nX);
+        // MBTiles rows are numbered from the bottom.
+        oFeature.SetField("tile_row",
+                          tmList[sTile.nZ].mMatrixHeight - 1 - sTile.nY);
+        oFeature.SetField(oFeature.GetFieldIndex("tile_data"),
+                          static_cast<int>(sTile.abyData.size()),
+                          sTile.abyData.data());
+        if (m_poTilesLayer->CreateFeature(&oFeature) != OGRERR_NONE)
+        {
+            bOK = false;
+            break;
+        }
+    }
+    for (size_t i = 0; bOK && i < m_aoPendingMarks.size(); ++i)
+    {
+        OGRFeature oFeature(m_poProgressLayer->GetLayerDefn());
+        oFeature.SetField(0, std::get<0>(m_aoPendingMarks[i]));
+        oFeature.SetField(1, std::get<1>(m_aoPendingMarks[i]));
+        oFeature.SetField(2, std::get<2>(m_aoPendingMarks[i]));
+        bOK = m_poProgressLayer->CreateFeature(&oFeature) == OGRERR_NONE;
+    }
+    m_asPendingTiles.clear();
+    m_aoPendingMarks.clear();
+    if (!bOK)
+    {
+        m_poMBTilesDS->RollbackTransaction();
+        return false;
+    }
+    return m_poMBTilesDS->CommitTransaction() == OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                          LoadExistingTile()                          */
+/************************************************************************/
+
+// Decode a tile written by a previous run, when resuming.
+bool GDALTiler::LoadExistingTile(int nZ, int nX, int nY,
+                                 std::vector<GByte> &abyTile)
+{
+    abyTile.clear();
+    std::string osFilename;
+    std::string osTmpFilename;
+    if (m_eOutputType == OutputType::DIRECTORY)
+    {
+        osFilename = GetTileFilename(nZ, nX, nY);
+        VSIStatBufL sStat;
+        if (VSIStatL(osFilename.c_str(), &sStat) != 0)
+            return true;  // empty tile
+    }
+    else
+    {
+        const auto &tm = m_poTMS->tileMatrixList()[nZ];
+        m_poTilesLayer->SetAttributeFilter(CPLSPrintf(
+            "zoom_level = %d AND tile_column = %d AND tile_row = %d", nZ, nX,
+            tm.mMatrixHeight - 1 - nY));
+        std::unique_ptr<OGRFeature> poFeature(m_poTilesLayer->GetNextFeature());
+        m_poTilesLayer->SetAttributeFilter(nullptr);
+        if (!poFeature)
+            return true;  // empty tile
+        int nBytes = 0;
+        const GByte *pabyData = poFeature->GetFieldAsBinary(
+            poFeature->GetFieldIndex("tile_data"), &nBytes);
+        osTmpFilename = CPLSPrintf("/vsimem/gdal_tiler/%p_resume.%s", this,
+                                   m_osExtension.c_str());
+        VSIFCloseL(VSIFileFromMemBuffer(osTmpFilename.c_str(),
+                                        const_cast<GByte *>(pabyData), nBytes,
+                                        FALSE));
+        osFilename = osTmpFilename;
+    }
+
+    const char *const apszAllowedDrivers[] = {m_poTileDriver->GetDescription(),
+                                              nullptr};
+    std::unique_ptr<GDALDataset> poDS(
+        GDALDataset::Open(osFilename.c_str(), GDAL_OF_RASTER,
+                          apszAllowedDrivers));
+    bool bOK = poDS && poDS->GetRasterXSize() == m_nTileSize &&
+               poDS->GetRasterYSize() == m_nTileSize;
+    if (bOK)
+    {
+        const int nBands = poDS->GetRasterCount();
+        abyTile.assign(
+            static_cast<size_t>(m_nTileSize) * m_nTileSize * m_nComps, 255);
+        // Components of the tile to read from each band.
+        std::vector<std::pair<int, int>> aoBandComps;
+        for (int i = 0; i < m_nDataComps; ++i)
+            aoBandComps.emplace_back(nBands >= 3 ? i + 1 : 1, i);
+        if (nBands == 2 || nBands == 4)
+            aoBandComps.emplace_back(nBands, m_nComps - 1);
+        for (const auto &oBandComp : aoBandComps)
+        {
+            if (bOK && poDS->GetRasterBand(oBandComp.first)
+                               ->RasterIO(GF_Read, 0, 0, m_nTileSize,
+                                          m_nTileSize,
+                                          abyTile.data() + oBandComp.second,
+                                          m_nTileSize, m_nTileSize, GDT_Byte,
+                                          m_nComps,
+                                          static_cast<GSpacing>(m_nTileSize) *
+                                              m_nComps,
+                                          nullptr) != CE_None)
+            {
+                bOK = false;
+            }
+        }
+    }
+    poDS.reset();
+    if (!osTmpFilename.empty())
+        VSIUnlink(osTmpFilename.c_str());
+    if (!bOK)
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot read existing tile %d/%d/%d", nZ, nX, nY);
+    return bOK;
+}
+
+/************************************************************************/
+/*                           ProcessMetaTile()                          */
+/************************************************************************/
+
+// Warp the tiles of the maximum zoom level that belong to tile (nX, nY) of
+// the metatile zoom level, and derive the intermediate zoom levels. Returns
+// the image of tile (nX, nY), or an empty buffer if it is fully
+// transparent.
+bool GDALTiler::ProcessMetaTile(int nX, int nY, std::vector<GByte> &abyTile)
+{
+    abyTile.clear();
+    const TileRange &sMaxRange = m_asRanges[m_nMaxZoom];
+    const int nCol0 = std::max(nX * m_nMetaTile, sMaxRange.nMinX);
+    const int nRow0 = std::max(nY * m_nMetaTile, sMaxRange.nMinY);
+    const int nCol1 = std::min((nX + 1) * m_nMetaTile - 1, sMaxRange.nMaxX);
+    const int nRow1 = std::min((nY + 1) * m_nMetaTile - 1, sMaxRange.nMaxY);
+    if (nCol0 > nCol1 || nRow0 > nRow1)
+        return true;
+
+    int nSize = m_nMetaTile * m_nTileSize;
+    std::vector<GByte> abyBuffer;
+    try
+    {
+        abyBuffer.resize(static_cast<size_t>(nSize) * nSize * m_nComps);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "Out of memory");
+        return false;
+    }
+    const size_t nOffset =
+        (static_cast<size_t>(nRow0 - nY * m_nMetaTile) * m_nTileSize * nSize +
+         static_cast<size_t>(nCol0 - nX * m_nMetaTile) * m_nTileSize) *
+        m_nComps;
+    if (!WarpMetaTile(nCol0, nRow0, nCol1 - nCol0 + 1, nRow1 - nRow0 + 1,
+                      abyBuffer.data() + nOffset, nSize * m_nComps))
+    {
+        return false;
+    }
+
+    std::vector<GByte> abyHalf;
+    for (int nZ = m_nMaxZoom;; --nZ)
+    {
+        const int nTiles = nSize / m_nTileSize;
+        const size_t nLineStride = static_cast<size_t>(nSize) * m_nComps;
+        for (int iTileY = 0; iTileY < nTiles; ++iTileY)
+        {
+            for (int iTileX = 0; iTileX < nTiles; ++iTileX)
+            {
+                const int nTileX = nX * nTiles + iTileX;
+                const int nTileY = nY * nTiles + iTileY;
+                if (!m_asRanges[nZ].Contains(nTileX, nTileY))
+                    continue;
+                EmitTile(nZ, nTileX, nTileY,
+                         abyBuffer.data() +
+                             iTileY * m_nTileSize * nLineStride +
+                             static_cast<size_t>(iTileX) * m_nTileSize *
+                                 m_nComps,
+                         nLineStride);
+            }
+        }
+        if (nZ == m_nBreakZoom)
+            break;
+        abyHalf.resize(abyBuffer.size() / 4);
+        DownsampleBy2(abyBuffer.data(), nSize, m_nComps, abyHalf.data());
+        std::swap(abyBuffer, abyHalf);
+        nSize /= 2;
+    }
+
+    for (size_t i = m_nComps - 1; i < abyBuffer.size(); i += m_nComps)
+    {
+        if (abyBuffer[i])
+        {
+            abyTile = std::move(abyBuffer);
+            break;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                             ProcessNode()                            */
+/************************************************************************/
+
+// Generate all tiles of the subtree of tile (nZ, nX, nY), with nZ at or
+// below the metatile zoom level, and return the image of that tile (empty
+// if fully transparent).
+bool GDALTiler::ProcessNode(int nZ, int nX, int nY, std::vector<GByte> &abyTile)
+{
+    abyTile.clear();
+    const TileKey oKey(nZ, nX, nY);
+    if (m_oDoneNodes.find(oKey) != m_oDoneNodes.end())
+    {
+        if (nZ == m_nBreakZoom)
+            ++m_nMetaTilesDone;
+        return LoadExistingTile(nZ, nX, nY, abyTile);
+    }
+
+    if (nZ == m_nBreakZoom)
+    {
+        if (!ProcessMetaTile(nX, nY, abyTile))
+            return false;
+        ++m_nMetaTilesDone;
+        ++m_nMetaTilesSinceCheckpoint;
+        if (!m_pfnProgress(static_cast<double>(m_nMetaTilesDone) /
+                               static_cast<double>(m_nMetaTilesTotal),
+                           "", nullptr))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return false;
+        }
+    }
+    else
+    {
+        // Assemble the 4 children, and downsample them.
+        const int nQuadSize = 2 * m_nTileSize;
+        const size_t nQuadLineStride =
+            static_cast<size_t>(nQuadSize) * m_nComps;
+        const size_t nTileLineSize =
+            static_cast<size_t>(m_nTileSize) * m_nComps;
+        std::vector<GByte> abyQuad;
+        std::vector<GByte> abyChild;
+        for (int iChildY = 0; iChildY < 2; ++iChildY)
+        {
+            for (int iChildX = 0; iChildX < 2; ++iChildX)
+            {
+                const int nChildX = 2 * nX + iChildX;
+                const int nChildY = 2 * nY + iChildY;
+                if (!m_asRanges[nZ + 1].Contains(nChildX, nChildY))
+                    continue;
+                if (!ProcessNode(nZ + 1, nChildX, nChildY, abyChild))
+                    return false;
+                if (abyChild.empty())
+                    continue;
+                if (abyQuad.empty())
+                    abyQuad.resize(nQuadLineStride * nQuadSize);
+                for (int iY = 0; iY < m_nTileSize; ++iY)
+                {
+                    memcpy(abyQuad.data() +
+                               (iChildY * m_nTileSize + iY) * nQuadLineStride +
+                               iChildX * nTileLineSize,
+                           abyChild.data() + iY * nTileLineSize,
+                           nTileLineSize);
+                }
+            }
+        }
+        if (!abyQuad.empty())
+        {
+            abyTile.resize(nTileLineSize * m_nTileSize);
+            DownsampleBy2(abyQuad.data(), nQuadSize, m_nComps, abyTile.data());
+            if (nZ >= m_nMinZoom)
+                EmitTile(nZ, nX, nY, abyTile.data(), nTileLineSize);
+        }
+    }
+
+    m_aoPendingMarks.push_back(oKey);
+    constexpr int CHECKPOINT_INTERVAL = 16;
+    if (m_nMetaTilesSinceCheckpoint >= CHECKPOINT_INTERVAL && !Checkpoint())
+        return false;
+    return !m_bError;
+}
+
+/************************************************************************/
+/*                              Finalize()                              */
+/************************************************************************/
+
+bool GDALTiler::Finalize()
+{
+    if (!Checkpoint())
+        return false;
+
+    if (m_eOutputType == OutputType::DIRECTORY)
+    {
+        VSIUnlink(GetJournalFilename().c_str());
+        return true;
+    }
+
+    // Bounds in geographic coordinates.
+    OGRSpatialReference oWGS84;
+    oWGS84.SetWellKnownGeogCS("WGS84");
+    oWGS84.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+    std::unique_ptr<OGRCoordinateTransformation> poCT(
+        OGRCreateCoordinateTransformation(&m_oTMSSRS, &oWGS84));
+    double dfMinLon = -180;
+    double dfMinLat = -85;
+    double dfMaxLon = 180;
+    double dfMaxLat = 85;
+    if (poCT)
+    {
+        poCT->TransformBounds(m_adfExtent[0], m_adfExtent[1], m_adfExtent[2],
+                              m_adfExtent[3], &dfMinLon, &dfMinLat, &dfMaxLon,
+                              &dfMaxLat, 21);
+    }
+
+    const std::string osFormat = m_osExtension;
+    const std::pair<std::string, std::string> aoMetadata[] = {
+        {"name", CPLGetBasename(m_osDstFilename.c_str())},
+        {"type", "overlay"},
+        {"version", "1.1"},
+        {"format", osFormat},
+        {"minzoom", CPLSPrintf("%d", m_nMinZoom)},
+        {"maxzoom", CPLSPrintf("%d", m_nMaxZoom)},
+        {"bounds", CPLSPrintf("%.17g,%.17g,%.17g,%.17g", dfMinLon, dfMinLat,
+                              dfMaxLon, dfMaxLat)},
+        {"center", CPLSPrintf("%.17g,%.17g,%d", (dfMinLon + dfMaxLon) / 2,
+                              (dfMinLat + dfMaxLat) / 2, m_nMinZoom)},
+    };
+    m_poMBTilesDS->ExecuteSQL("DELETE FROM metadata", nullptr, nullptr);
+    m_poMBTilesDS->ExecuteSQL("DROP TABLE gdal_tiler_progress", nullptr,
+                              nullptr);
+    m_poProgressLayer = nullptr;
+    OGRLayer *poMetadataLayer = m_poMBTilesDS->GetLayerByName("metadata");
+    if (!poMetadataLayer)
+        return false;
+    for (const auto &oItem : aoMetadata)
+    {
+        OGRFeature oFeature(poMetadataLayer->GetLayerDefn());
+        oFeature.SetField(0, oItem.first.c_str());
+        oFeature.SetField(1, oItem.second.c_str());
+        if (poMetadataLayer->CreateFeature(&oFeature) != OGRERR_NONE)
+            return false;
+    }
+    m_poTilesLayer = nullptr;
+    if (m_poMBTilesDS->Close() != CE_None)
+        return false;
+    m_poMBTilesDS.reset();
+
+    if (m_eOutputType == OutputType::MBTILES)
+        return true;
+
+    // Convert the intermediate MBTiles file to PMTiles.
+    GDALDriver *poPMTilesDriver =
+        GetGDALDriverManager()->GetDriverByName("PMTiles");
+    const char *const apszAllowedDrivers[] = {"MBTiles", nullptr};
+    std::unique_ptr<GDALDataset> poMBTilesDS(GDALDataset::Open(
+        m_osMBTilesFilename.c_str(), GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR,
+        apszAllowedDrivers));
+    if (!poPMTilesDriver || !poMBTilesDS ||
+        !poPMTilesDriver->CanVectorTranslateFrom(
+            m_osDstFilename.c_str(), poMBTilesDS.get(), nullptr, nullptr))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot convert %s to PMTiles",
+                 m_osMBTilesFilename.c_str());
+        return false;
+    }
+    std::unique_ptr<GDALDataset> poPMTilesDS(
+        poPMTilesDriver->VectorTranslateFrom(m_osDstFilename.c_str(),
+                                             poMBTilesDS.get(), nullptr,
+                                             nullptr, nullptr));
+    poMBTilesDS.reset();
+    if (!poPMTilesDS)
+        return false;
+    poPMTilesDS.reset();
+    VSIUnlink(m_osMBTilesFilename.c_str());
+    return true;
+}
+
+/************************************************************************/
+/*                                Run()                                 */
+/************************************************************************/
+
+bool GDALTiler::Run()
+{
+    if (!OpenSource() || !SetupTileMatrixSet() || !SetupZoomLevels() ||
+        !OpenOutput())
+    {
+        return false;
+    }
+
+    if (m_nThreads > 1)
+    {
+        m_poThreadPool = GDALGetGlobalThreadPool(m_nThreads);
+        if (m_poThreadPool)
+            m_poJobQueue = m_poThreadPool->CreateJobQueue();
+    }
+
+    // Tiles of the minimum zoom level are the roots of the traversal.
+    const TileRange &sRootRange = m_asRanges[m_nMinZoom];
+    std::vector<GByte> abyTile;
+    for (int nY = sRootRange.nMinY; nY <= sRootRange.nMaxY; ++nY)
+    {
+        for (int nX = sRootRange.nMinX; nX <= sRootRange.nMaxX; ++nX)
+        {
+            if (!ProcessNode(m_nMinZoom, nX, nY, abyTile))
+            {
+                // Keep what has been completed for -resume.
+                if (!m_bError)
+                    Checkpoint();
+                return false;
+            }
+        }
+    }
+
+    return Finalize();
+}
+
+/************************************************************************/
+/*                                main()                                */
+/************************************************************************/
+
+#define CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(nExtraArg)                            \
+    do                                                                         \
+    {                                                                          \
+        if (i + nExtraArg >= argc)                                             \
+            Usage(true, CPLSPrintf("%s option requires %d argument(s)",        \
+                                   argv[i], nExtraArg));                       \
+    } while (false)
+
+MAIN_START(argc, argv)
+
+{
+    GDALTiler oTiler;
+    const char *pszOutputType = nullptr;
+    const char *pszNumThreads = nullptr;
+    bool bQuiet = false;
+
+    GDALAllRegister();
+
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+
+    /* -------------------------------------------------------------------- */
+    /*      Parse arguments.                                                */
+    /* -------------------------------------------------------------------- */
+    for (int i = 1; i < argc; i++)
+    {
+        if (EQUAL(argv[i], "--utility_version"))
+        {
+            printf("%s was compiled against GDAL %s and "
+                   "is running against GDAL %s\n",
+                   argv[0], GDAL_RELEASE_NAME, GDALVersionInfo("RELEASE_NAME"));
+            CSLDestroy(argv);
+            return 0;
+        }
+        else if (EQUAL(argv[i], "--help"))
+            Usage(false);
+        else if (EQUAL(argv[i], "-tms"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            oTiler.m_osTMS = argv[++i];
+        }
+        else if (EQUAL(argv[i], "-z"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            const char *pszZoom = argv[++i];
+            const char *pszDash = strchr(pszZoom, '-');
+            if (pszDash)
+            {
+                oTiler.m_nMinZoom = atoi(pszZoom);
+                oTiler.m_nMaxZoom = atoi(pszDash + 1);
+            }
+            else
+            {
+                oTiler.m_nMaxZoom = atoi(pszZoom);
+            }
+            if (oTiler.m_nMaxZoom < 0)
+                Usage(true, "Invalid value for -z");
+        }
+        else if (EQUAL(argv[i], "-r"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            if (!GetResampleAlg(argv[++i], oTiler.m_eResampleAlg))
+                exit(1);
+        }
+        else if (EQUAL(argv[i], "-tile_format"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            oTiler.m_osTileFormat = CPLString(argv[++i]).toupper();
+            if (oTiler.m_osTileFormat == "JPG")
+                oTiler.m_osTileFormat = "JPEG";
+            if (oTiler.m_osTileFormat != "PNG" &&
+                oTiler.m_osTileFormat != "JPEG" &&
+                oTiler.m_osTileFormat != "WEBP")
+            {
+                Usage(true, "-tile_format must be PNG, JPEG or WEBP");
+            }
+        }
+        else if (EQUAL(argv[i], "-tile_co"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            oTiler.m_aosTileCO.AddString(argv[++i]);
+        }
+        else if (EQUAL(argv[i], "-of"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            pszOutputType = argv[++i];
+        }
+        else if (EQUAL(argv[i], "-metatile"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            oTiler.m_nMetaTile = atoi(argv[++i]);
+            if (oTiler.m_nMetaTile < 1 || oTiler.m_nMetaTile > 64)
+                Usage(true, "-metatile must be in [1,64] range");
+        }
+        else if (EQUAL(argv[i], "-j"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            pszNumThreads = argv[++i];
+        }
+        else if (EQUAL(argv[i], "-resume"))
+        {
+            oTiler.m_bResume = true;
+        }
+        else if (EQUAL(argv[i], "-q") || EQUAL(argv[i], "-quiet"))
+        {
+            bQuiet = true;
+        }
+        else if (argv[i][0] == '-' && argv[i][1] != '\0')
+        {
+            Usage(true, CPLSPrintf("Unknown option name '%s'", argv[i]));
+        }
+        else if (oTiler.m_osSrcFilename.empty())
+        {
+            oTiler.m_osSrcFilename = argv[i];
+        }
+        else if (oTiler.m_osDstFilename.empty())
+        {
+            oTiler.m_osDstFilename = argv[i];
+        }
+        else
+            Usage(true, "Too many command options.");
+    }
+
+    if (oTiler.m_osSrcFilename.empty())
+        Usage(true, "Missing source filename.");
+    if (oTiler.m_osDstFilename.empty())
+        Usage(true, "Missing destination.");
+
+    if (pszOutputType == nullptr)
+    {
+        const CPLString osExt(CPLGetExtension(oTiler.m_osDstFilename.c_str()));
+        if (EQUAL(osExt, "mbtiles"))
+            pszOutputType = "MBTiles";
+        else if (EQUAL(osExt, "pmtiles"))
+            pszOutputType = "PMTiles";
+        else
+            pszOutputType = "DIR";
+    }
+    if (EQUAL(pszOutputType, "MBTiles"))
+        oTiler.m_eOutputType = GDALTiler::OutputType::MBTILES;
+    else if (EQUAL(pszOutputType, "PMTiles"))
+        oTiler.m_eOutputType = GDALTiler::OutputType::PMTILES;
+    else if (!EQUAL(pszOutputType, "DIR"))
+        Usage(true, "-of must be DIR, MBTiles or PMTiles");
+
+    oTiler.m_nThreads = GDALGetNumThreads(pszNumThreads);
+    if (!bQuiet)
+        oTiler.m_pfnProgress = GDALTermProgress;
+
+    const bool bSuccess = oTiler.Run();
+
+    CSLDestroy(argv);
+    GDALDestroyDriverManager();
+    OGRCleanupAll();
+
+    return bSuccess ? 0 : 1;
+}
+MAIN_END
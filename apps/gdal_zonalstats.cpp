@@ -0,0 +1,318 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Utilities
+ * Purpose:  Compute statistics of raster values within polygon zones.
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_conv.h"
+#include "cpl_string.h"
+#include "gdal_version.h"
+#include "gdal.h"
+#include "gdal_alg.h"
+#include "gdal_priv.h"
+#include "ogr_api.h"
+#include "ogrsf_frmts.h"
+#include "commonutils.h"
+
+#include <memory>
+#include <vector>
+
+/************************************************************************/
+/*                               Usage()                                */
+/************************************************************************/
+
+static void Usage(bool bIsError, const char *pszErrorMsg = nullptr)
+
+{
+    fprintf(
+        bIsError ? stderr : stdout,
+        "Usage: gdal_zonalstats [--help] [--help-general]\n"
+        "                       [-b <band>]... [-stats <stat>[,<stat>]...]\n"
+        "                       [-all_touched] [-fractional]\n"
+        "                       [-hist_bins <n>] [-hist_min <val>] "
+        "[-hist_max <val>]\n"
+        "                       [-l <zones_layer>] [-of <format>] "
+        "[-nln <name>]\n"
+        "                       [-dsco <NAME>=<VALUE>]... "
+        "[-lco <NAME>=<VALUE>]...\n"
+        "                       [-keep_geom] [-j <num_threads>|ALL_CPUS] "
+        "[-q]\n"
+        "                       <src_raster> <zones> <dst_filename>\n"
+        "\n"
+        "where <stat> is one of count, sum, mean, min, max or histogram.\n");
+
+    if (pszErrorMsg != nullptr)
+        fprintf(stderr, "\nFAILURE: %s\n", pszErrorMsg);
+
+    exit(bIsError ? 1 : 0);
+}
+
+/************************************************************************/
+/*                                main()                                */
+/************************************************************************/
+
+#define CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(nExtraArg)                            \
+    do                                                                         \
+    {                                                                          \
+        if (i + nExtraArg >= argc)                                             \
+            Usage(true, CPLSPrintf("%s option requires %d argument(s)",        \
+                                   argv[i], nExtraArg));                       \
+    } while (false)
+
+MAIN_START(argc, argv)
+
+{
+    std::vector<int> anBands;
+    const char *pszFormat = nullptr;
+    const char *pszSrcFilename = nullptr;
+    const char *pszZonesFilename = nullptr;
+    const char *pszDstFilename = nullptr;
+    const char *pszZonesLayer = nullptr;
+    const char *pszNewLayerName = "zonalstats";
+    bool bKeepGeometry = false;
+    bool bQuiet = false;
+    CPLStringList aosOptions;
+    CPLStringList aosDSCO;
+    CPLStringList aosLCO;
+
+    GDALAllRegister();
+
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+
+    /* -------------------------------------------------------------------- */
+    /*      Parse arguments.                                                */
+    /* -------------------------------------------------------------------- */
+    for (int i = 1; i < argc; i++)
+    {
+        if (EQUAL(argv[i], "--utility_version"))
+        {
+            printf("%s was compiled against GDAL %s and "
+                   "is running against GDAL %s\n",
+                   argv[0], GDAL_RELEASE_NAME, GDALVersionInfo("RELEASE_NAME"));
+            CSLDestroy(argv);
+            return 0;
+        }
+        else if (EQUAL(argv[i], "--help"))
+            Usage(false);
+        else if (EQUAL(argv[i], "-b"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            anBands.push_back(atoi(argv[++i]));
+        }
+        else if (EQUAL(argv[i], "-stats"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            aosOptions.SetNameValue("STATS", argv[++i]);
+        }
+        else if (EQUAL(argv[i], "-all_touched"))
+        {
+            aosOptions.SetNameValue("ALL_TOUCHED", "YES");
+        }
+        else if (EQUAL(argv[i], "-fractional"))
+        {
+            aosOptions.SetNameValue("COVERAGE", "FRACTIONAL");
+        }
+        else if (EQUAL(argv[i], "-hist_bins"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            aosOptions.SetNameValue("HISTOGRAM_BINS", argv[++i]);
+        }
+        else if (EQUAL(argv[i], "-hist_min"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            aosOptions.SetNameValue("HISTOGRAM_MIN", argv[++i]);
+        }
+        else if (EQUAL(argv[i], "-hist_max"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            aosOptions.SetNameValue("HISTOGRAM_MAX", argv[++i]);
+        }
+        else if (EQUAL(argv[i], "-j"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            aosOptions.SetNameValue("NUM_THREADS", argv[++i]);
+        }
+        else if (EQUAL(argv[i], "-keep_geom"))
+        {
+            bKeepGeometry = true;
+        }
+        else if (EQUAL(argv[i], "-l"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            pszZonesLayer = argv[++i];
+        }
+        else if (EQUAL(argv[i], "-f") || EQUAL(argv[i], "-of"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            pszFormat = argv[++i];
+        }
+        else if (EQUAL(argv[i], "-nln"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            pszNewLayerName = argv[++i];
+        }
+        else if (EQUAL(argv[i], "-dsco"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            aosDSCO.AddString(argv[++i]);
+        }
+        else if (EQUAL(argv[i], "-lco"))
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            aosLCO.AddString(argv[++i]);
+        }
+        else if (EQUAL(argv[i], "-q") || EQUAL(argv[i], "-quiet"))
+        {
+            bQuiet = true;
+        }
+        else if (argv[i][0] == '-' && argv[i][1] != '\0')
+        {
+            Usage(true, CPLSPrintf("Unknown option name '%s'", argv[i]));
+        }
+        else if (pszSrcFilename == nullptr)
+        {
+            pszSrcFilename = argv[i];
+        }
+        else if (pszZonesFilename == nullptr)
+        {
+            pszZonesFilename = argv[i];
+        }
+        else if (pszDstFilename == nullptr)
+        {
+            pszDstFilename = argv[i];
+        }
+        else
+            Usage(true, "Too many command options.");
+    }
+
+    if (pszSrcFilename == nullptr)
+        Usage(true, "Missing source raster filename.");
+    if (pszZonesFilename == nullptr)
+        Usage(true, "Missing zones filename.");
+    if (pszDstFilename == nullptr)
+        Usage(true, "Missing destination filename.");
+
+    aosOptions.SetNameValue("INCLUDE_GEOMETRY", bKeepGeometry ? "YES" : "NO");
+
+    /* -------------------------------------------------------------------- */
+    /*      Open inputs.                                                    */
+    /* -------------------------------------------------------------------- */
+    auto poSrcDS = std::unique_ptr<GDALDataset>(GDALDataset::Open(
+        pszSrcFilename, GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR));
+    if (poSrcDS == nullptr)
+        exit(1);
+
+    auto poZonesDS = std::unique_ptr<GDALDataset>(GDALDataset::Open(
+        pszZonesFilename, GDAL_OF_VECTOR | GDAL_OF_VERBOSE_ERROR));
+    if (poZonesDS == nullptr)
+        exit(1);
+
+    OGRLayer *poZonesLayer = pszZonesLayer
+                                 ? poZonesDS->GetLayerByName(pszZonesLayer)
+                                 : poZonesDS->GetLayer(0);
+    if (poZonesLayer == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot find zones layer %s",
+                 pszZonesLayer ? pszZonesLayer : "");
+        exit(1);
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Create the output file.                                         */
+    /* -------------------------------------------------------------------- */
+    CPLString osFormat;
+    if (pszFormat == nullptr)
+    {
+        std::vector<CPLString> aoDrivers =
+            GetOutputDriversFor(pszDstFilename, GDAL_OF_VECTOR);
+        if (aoDrivers.empty())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "Cannot guess driver for %s",
+                     pszDstFilename);
+            exit(10);
+        }
+        if (aoDrivers.size() > 1)
+        {
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "Several drivers matching %s extension. Using %s",
+                     CPLGetExtension(pszDstFilename), aoDrivers[0].c_str());
+        }
+        osFormat = aoDrivers[0];
+    }
+    else
+    {
+        osFormat = pszFormat;
+    }
+
+    GDALDriver *poDriver =
+        GetGDALDriverManager()->GetDriverByName(osFormat.c_str());
+    if (poDriver == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Unable to find driver `%s'.",
+                 osFormat.c_str());
+        exit(10);
+    }
+
+    auto poDstDS = std::unique_ptr<GDALDataset>(poDriver->Create(
+        pszDstFilename, 0, 0, 0, GDT_Unknown, aosDSCO.List()));
+    if (poDstDS == nullptr)
+        exit(1);
+
+    const OGRGeomFieldDefn *poZonesGeomFieldDefn =
+        poZonesLayer->GetLayerDefn()->GetGeomFieldCount() > 0
+            ? poZonesLayer->GetLayerDefn()->GetGeomFieldDefn(0)
+            : nullptr;
+    const OGRwkbGeometryType eGType =
+        bKeepGeometry && poZonesGeomFieldDefn ? poZonesGeomFieldDefn->GetType()
+                                              : wkbNone;
+    OGRLayer *poDstLayer = poDstDS->CreateLayer(
+        pszNewLayerName,
+        eGType != wkbNone ? poZonesLayer->GetSpatialRef() : nullptr, eGType,
+        aosLCO.List());
+    if (poDstLayer == nullptr)
+        exit(1);
+
+    /* -------------------------------------------------------------------- */
+    /*      Invoke.                                                         */
+    /* -------------------------------------------------------------------- */
+    CPLErr eErr = GDALZonalStatistics(
+        GDALDataset::ToHandle(poSrcDS.get()), static_cast<int>(anBands.size()),
+        anBands.empty() ? nullptr : anBands.data(),
+        OGRLayer::ToHandle(poZonesLayer), OGRLayer::ToHandle(poDstLayer),
+        aosOptions.List(), bQuiet ? GDALDummyProgress : GDALTermProgress,
+        nullptr);
+
+    poSrcDS.reset();
+    poZonesDS.reset();
+    if (poDstDS->Close() != CE_None)
+        eErr = CE_Failure;
+    poDstDS.reset();
+
+    CSLDestroy(argv);
+    GDALDestroyDriverManager();
+    OGRCleanupAll();
+
+    return eErr == CE_None ? 0 : 1;
+}
+MAIN_END
@@ -61,7 +61,7 @@ static void Usage(bool bIsError, const char *pszErrorMsg)
         "{nearest|bilinear|cubic|cubicspline|lanczos|average|mode}]\n"
         "                    [-oo <NAME>=<VALUE>]...\n"
         "                    [-input_file_list <filename>] [-overwrite]\n"
-        "                    [-strict | -non_strict]\n"
+        "                    [-strict | -non_strict] [-of {VRT|GTI}]\n"
         "                    <output_filename.vrt> <input_raster> "
         "[<input_raster>]...\n"
         "\n"
@@ -197,6 +197,7 @@ MAIN_START(argc, argv)
                 GDALIdentifyDriver(psOptionsForBinary->pszDstFilename, nullptr);
             if (hDriver &&
                 !(EQUAL(GDALGetDriverShortName(hDriver), "VRT") ||
+                  EQUAL(GDALGetDriverShortName(hDriver), "GTI") ||
                   (EQUAL(GDALGetDriverShortName(hDriver), "API_PROXY") &&
                    EQUAL(CPLGetExtension(psOptionsForBinary->pszDstFilename),
                          "VRT"))))
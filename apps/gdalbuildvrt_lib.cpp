@@ -1516,6 +1516,31 @@ GDALDataset *VRTBuilder::Build(GDALProgressFunc pfnProgress,
         }
     }
 
+    // Sources are opened concurrently, but analyzed in order, so that the
+    // result does not depend on the scheduling.
+    std::unique_ptr<GDALDatasetPrefetcher> poPrefetcher;
+    if (pahSrcDS == nullptr)
+    {
+        poPrefetcher = std::make_unique<GDALDatasetPrefetcher>(
+            GDALGetNumThreadsForPrefetching(),
+            [this](const std::string &osFilename)
+            {
+                GDALDataset *poDS = GDALDataset::FromHandle(
+                    GDALOpenEx(osFilename.c_str(), GDAL_OF_RASTER, nullptr,
+                               papszOpenOptions, nullptr));
+                if (poDS && poDS->GetRasterCount() > 0)
+                {
+                    // Properties used by AnalyseRaster() that may involve
+                    // I/O, such as probing for .msk and .ovr side-car files.
+                    GDALRasterBand *poFirstBand = poDS->GetRasterBand(1);
+                    poFirstBand->GetMaskFlags();
+                    poFirstBand->GetOverviewCount();
+                }
+                return poDS;
+            });
+    }
+    int iNextToSubmit = 0;
+
     bool bFoundValid = false;
     for (int i = 0; ppszInputFilenames != nullptr && i < nInputFiles; i++)
     {
@@ -1526,10 +1551,20 @@ GDALDataset *VRTBuilder::Build(GDALProgressFunc pfnProgress,
             return nullptr;
         }
 
-        GDALDatasetH hDS = (pahSrcDS)
-                               ? pahSrcDS[i]
-                               : GDALOpenEx(dsFileName, GDAL_OF_RASTER, nullptr,
-                                            papszOpenOptions, nullptr);
+        GDALDatasetH hDS = nullptr;
+        if (pahSrcDS)
+        {
+            hDS = pahSrcDS[i];
+        }
+        else
+        {
+            // nInputFiles may grow when analyzing a dataset with subdatasets
+            while (iNextToSubmit < nInputFiles && !poPrefetcher->IsFull())
+                poPrefetcher->Submit(ppszInputFilenames[iNextToSubmit++]);
+            std::string osFilename;
+            hDS = GDALDataset::ToHandle(poPrefetcher->Next(osFilename));
+            CPLAssert(osFilename == dsFileName);
+        }
         asDatasetProperties[i].isFileOK = FALSE;
 
         if (hDS)
@@ -1748,6 +1783,9 @@ struct GDALBuildVRTOptions
     char **papszOpenOptions;
     bool bUseSrcMaskBand;
 
+    /*! output format: VRT (default) or GTI */
+    char *pszFormat;
+
     /*! allow or suppress progress monitor and other non-error output */
     int bQuiet;
 
@@ -1788,9 +1826,111 @@ GDALBuildVRTOptionsClone(const GDALBuildVRTOptions *psOptionsIn)
     if (psOptionsIn->papszOpenOptions)
         psOptions->papszOpenOptions =
             CSLDuplicate(psOptionsIn->papszOpenOptions);
+    if (psOptionsIn->pszFormat)
+        psOptions->pszFormat = CPLStrdup(psOptionsIn->pszFormat);
     return psOptions;
 }
 
+/************************************************************************/
+/*                          CreateGTIFromVRT()                          */
+/************************************************************************/
+
+/* Write a tile index for the GTI driver, with the tiles and the mosaic
+ * parameters of a VRT built by VRTBuilder. */
+static GDALDatasetH CreateGTIFromVRT(const char *pszDest, GDALDatasetH hVRTDS,
+                                     const char *pszResampling)
+{
+    GDALDataset *poVRTDS = GDALDataset::FromHandle(hVRTDS);
+    double adfGT[6];
+    if (poVRTDS->GetRasterCount() == 0 ||
+        poVRTDS->GetGeoTransform(adfGT) != CE_None || adfGT[2] != 0 ||
+        adfGT[4] != 0)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Cannot create a GTI tile index from non-georeferenced "
+                 "or rotated sources");
+        return nullptr;
+    }
+
+    CPLStringList aosTileIndexArgv;
+    aosTileIndexArgv.AddString("-overwrite");
+    aosTileIndexArgv.AddString("-tr");
+    aosTileIndexArgv.AddString(CPLSPrintf("%.17g", adfGT[1]));
+    aosTileIndexArgv.AddString(CPLSPrintf("%.17g", -adfGT[5]));
+    aosTileIndexArgv.AddString("-te");
+    aosTileIndexArgv.AddString(CPLSPrintf("%.17g", adfGT[0]));
+    aosTileIndexArgv.AddString(CPLSPrintf(
+        "%.17g", adfGT[3] + poVRTDS->GetRasterYSize() * adfGT[5]));
+    aosTileIndexArgv.AddString(CPLSPrintf(
+        "%.17g", adfGT[0] + poVRTDS->GetRasterXSize() * adfGT[1]));
+    aosTileIndexArgv.AddString(CPLSPrintf("%.17g", adfGT[3]));
+
+    GDALRasterBand *poFirstBand = poVRTDS->GetRasterBand(1);
+    aosTileIndexArgv.AddString("-ot");
+    aosTileIndexArgv.AddString(
+        GDALGetDataTypeName(poFirstBand->GetRasterDataType()));
+    aosTileIndexArgv.AddString("-bandcount");
+    aosTileIndexArgv.AddString(CPLSPrintf("%d", poVRTDS->GetRasterCount()));
+
+    std::string osNoData;
+    std::string osColorInterp;
+    bool bHasNoData = true;
+    for (int i = 1; i <= poVRTDS->GetRasterCount(); ++i)
+    {
+        GDALRasterBand *poBand = poVRTDS->GetRasterBand(i);
+        int bBandHasNoData = FALSE;
+        const double dfNoData = poBand->GetNoDataValue(&bBandHasNoData);
+        bHasNoData = bHasNoData && bBandHasNoData;
+        if (i > 1)
+        {
+            osNoData += ',';
+            osColorInterp += ',';
+        }
+        osNoData += CPLSPrintf("%.17g", dfNoData);
+        osColorInterp +=
+            GDALGetColorInterpretationName(poBand->GetColorInterpretation());
+    }
+    if (bHasNoData)
+    {
+        aosTileIndexArgv.AddString("-nodata");
+        aosTileIndexArgv.AddString(osNoData.c_str());
+    }
+    aosTileIndexArgv.AddString("-colorinterp");
+    aosTileIndexArgv.AddString(osColorInterp.c_str());
+    if (poFirstBand->GetMaskFlags() == GMF_PER_DATASET)
+        aosTileIndexArgv.AddString("-mask");
+    if (pszResampling)
+    {
+        aosTileIndexArgv.AddString("-mo");
+        aosTileIndexArgv.AddString(
+            CPLSPrintf("RESAMPLING=%s", pszResampling));
+    }
+
+    // The sources retained by VRTBuilder, in their painting order.
+    CPLStringList aosSources;
+    auto poVRTBand = static_cast<VRTSourcedRasterBand *>(poFirstBand);
+    for (int i = 0; i < poVRTBand->nSources; ++i)
+    {
+        if (poVRTBand->papoSources[i]->IsSimpleSource())
+        {
+            aosSources.AddString(
+                cpl::down_cast<VRTSimpleSource *>(poVRTBand->papoSources[i])
+                    ->GetSourceDatasetName()
+                    .c_str());
+        }
+    }
+
+    GDALTileIndexOptions *psTileIndexOptions =
+        GDALTileIndexOptionsNew(aosTileIndexArgv.List(), nullptr);
+    if (psTileIndexOptions == nullptr)
+        return nullptr;
+    GDALDatasetH hIndexDS =
+        GDALTileIndex(pszDest, aosSources.size(), aosSources.List(),
+                      psTileIndexOptions, nullptr);
+    GDALTileIndexOptionsFree(psTileIndexOptions);
+    return hIndexDS;
+}
+
 /************************************************************************/
 /*                           GDALBuildVRT()                             */
 /************************************************************************/
@@ -1886,6 +2026,55 @@ GDALDatasetH GDALBuildVRT(const char *pszDest, int nSrcCount,
         return nullptr;
     }
 
+    const bool bGTIOutput =
+        psOptions->pszFormat && EQUAL(psOptions->pszFormat, "GTI");
+    if (psOptions->pszFormat && !bGTIOutput &&
+        !EQUAL(psOptions->pszFormat, "VRT"))
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Output format %s not supported. Only VRT and GTI are",
+                 psOptions->pszFormat);
+        if (pbUsageError)
+            *pbUsageError = TRUE;
+        GDALBuildVRTOptionsFree(psOptions);
+        return nullptr;
+    }
+
+    if (bGTIOutput)
+    {
+        // Options that need per-source settings, which a GTI tile index
+        // cannot express.
+        const char *pszUnsupportedOption =
+            psOptions->bSeparate                    ? "-separate"
+            : psOptions->nBandCount != 0            ? "-b"
+            : psOptions->bAddAlpha                  ? "-addalpha"
+            : psOptions->bHideNoData                ? "-hidenodata"
+            : psOptions->pszSrcNoData != nullptr    ? "-srcnodata"
+            : psOptions->pszOutputSRS != nullptr    ? "-a_srs"
+            : psOptions->bAllowProjectionDifference ? "-allow_projection_"
+                                                      "difference"
+            : !psOptions->bUseSrcMaskBand           ? "-ignore_srcmaskband"
+            : psOptions->nSubdataset >= 0           ? "-sd"
+                                                    : nullptr;
+        const char *pszError =
+            pszUnsupportedOption
+                ? CPLSPrintf("%s option is not compatible with -of GTI.",
+                             pszUnsupportedOption)
+            : pszDest[0] == '\0' ? "An output filename must be specified "
+                                    "with -of GTI."
+            : pahSrcDS != nullptr ? "Source datasets must be specified by "
+                                    "their name with -of GTI."
+                                  : nullptr;
+        if (pszError)
+        {
+            CPLError(CE_Failure, CPLE_NotSupported, "%s", pszError);
+            if (pbUsageError)
+                *pbUsageError = TRUE;
+            GDALBuildVRTOptionsFree(psOptions);
+            return nullptr;
+        }
+    }
+
     ResolutionStrategy eStrategy = AVERAGE_RESOLUTION;
     if (psOptions->pszResolution == nullptr ||
         EQUAL(psOptions->pszResolution, "user"))
@@ -1917,8 +2106,11 @@ GDALDatasetH GDALBuildVRT(const char *pszDest, int nSrcCount,
         psOptions->pszVRTNoData == nullptr)
         psOptions->pszVRTNoData = CPLStrdup(psOptions->pszSrcNoData);
 
+    // With -of GTI, the VRT is only built in memory, to compute the mosaic
+    // parameters and select the sources.
     VRTBuilder oBuilder(
-        psOptions->bStrict, pszDest, nSrcCount, papszSrcDSNames, pahSrcDS,
+        psOptions->bStrict, bGTIOutput ? "" : pszDest, nSrcCount,
+        papszSrcDSNames, pahSrcDS,
         psOptions->panSelectedBandList, psOptions->nBandCount, eStrategy,
         psOptions->we_res, psOptions->ns_res, psOptions->bTargetAlignedPixels,
         psOptions->xmin, psOptions->ymin, psOptions->xmax, psOptions->ymax,
@@ -1931,6 +2123,13 @@ GDALDatasetH GDALBuildVRT(const char *pszDest, int nSrcCount,
     GDALDatasetH hDstDS = static_cast<GDALDatasetH>(
         oBuilder.Build(psOptions->pfnProgress, psOptions->pProgressData));
 
+    if (bGTIOutput && hDstDS)
+    {
+        GDALDatasetH hVRTDS = hDstDS;
+        hDstDS = CreateGTIFromVRT(pszDest, hVRTDS, psOptions->pszResampling);
+        GDALClose(hVRTDS);
+    }
+
     GDALBuildVRTOptionsFree(psOptions);
 
     return hDstDS;
@@ -2182,6 +2381,13 @@ GDALBuildVRTOptionsNew(char **papszArgv,
         {
             psOptions->bUseSrcMaskBand = false;
         }
+        else if ((EQUAL(papszArgv[iArg], "-of") ||
+                  EQUAL(papszArgv[iArg], "-f")) &&
+                 iArg + 1 < argc)
+        {
+            CPLFree(psOptions->pszFormat);
+            psOptions->pszFormat = CPLStrdup(papszArgv[++iArg]);
+        }
         else if (papszArgv[iArg][0] == '-')
         {
             CPLError(CE_Failure, CPLE_NotSupported, "Unknown option name '%s'",
@@ -2236,6 +2442,7 @@ void GDALBuildVRTOptionsFree(GDALBuildVRTOptions *psOptions)
         CPLFree(psOptions->panSelectedBandList);
         CPLFree(psOptions->pszResampling);
         CSLDestroy(psOptions->papszOpenOptions);
+        CPLFree(psOptions->pszFormat);
     }
 
     CPLFree(psOptions);
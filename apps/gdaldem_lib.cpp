@@ -109,14 +109,20 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <limits>
+#include <mutex>
+#include <vector>
 
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 #if defined(__SSE2__) || defined(_M_X64)
 #define HAVE_16_SSE_REG
@@ -293,17 +299,119 @@ GInt32 INTERPOL(GInt32 a, GInt32 b, int bSrcHasNoData, GInt32 fSrcNoDataValue)
 }
 
 /************************************************************************/
-/*                  GDALGeneric3x3Processing()                          */
+/*                      GDALDEMProcessLineRanges()                      */
+/************************************************************************/
+
+typedef std::function<CPLErr(int nYStart, int nYEnd, std::mutex &oIOMutex,
+                             GDALProgressFunc pfnProgress, void *pProgressData)>
+    GDALDEMLineRangeFunc;
+
+namespace
+{
+struct GDALDEMLineRangeJob
+{
+    const GDALDEMLineRangeFunc *pfnProcessLines = nullptr;
+    int nYStart = 0;
+    int nYEnd = 0;
+    std::mutex *poIOMutex = nullptr;
+    std::atomic<bool> *pbStop = nullptr;
+    CPLErr eErr = CE_Failure;
+};
+}  // namespace
+
+// Progress function of the jobs: only checks if processing must stop.
+static int GDALDEMLineRangeJobProgress(double, const char *, void *pData)
+{
+    return !*static_cast<std::atomic<bool> *>(pData);
+}
+
+static void GDALDEMLineRangeJobFunc(void *pData)
+{
+    auto psJob = static_cast<GDALDEMLineRangeJob *>(pData);
+    if (*(psJob->pbStop))
+        return;
+    psJob->eErr = (*psJob->pfnProcessLines)(
+        psJob->nYStart, psJob->nYEnd, *(psJob->poIOMutex),
+        GDALDEMLineRangeJobProgress, psJob->pbStop);
+    if (psJob->eErr != CE_None)
+        *(psJob->pbStop) = true;
+}
+
+// Calls pfnProcessLines() on ranges of lines covering the whole raster, in
+// parallel if the GDAL_NUM_THREADS configuration option is set.
+// pfnProcessLines() must perform all its I/O under the mutex it receives.
+static CPLErr
+GDALDEMProcessLineRanges(int nYSize,
+                         const GDALDEMLineRangeFunc &pfnProcessLines,
+                         GDALProgressFunc pfnProgress, void *pProgressData)
+{
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    int nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+    nThreads = std::max(1, std::min(nThreads, 128));
+    // A few ranges of at least 64 lines per thread to balance the load
+    const int nRanges = std::min(nThreads * 4, nYSize / 64);
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 && nRanges > 1 ? GDALGetGlobalThreadPool(nThreads)
+                                    : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+
+    std::mutex oIOMutex;
+    if (poJobQueue == nullptr)
+        return pfnProcessLines(0, nYSize, oIOMutex, pfnProgress, pProgressData);
+
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+
+    std::atomic<bool> bStop{false};
+    std::vector<GDALDEMLineRangeJob> asJobs(nRanges);
+    for (int i = 0; i < nRanges; i++)
+    {
+        asJobs[i].pfnProcessLines = &pfnProcessLines;
+        asJobs[i].nYStart =
+            static_cast<int>(static_cast<GIntBig>(nYSize) * i / nRanges);
+        asJobs[i].nYEnd =
+            static_cast<int>(static_cast<GIntBig>(nYSize) * (i + 1) / nRanges);
+        asJobs[i].poIOMutex = &oIOMutex;
+        asJobs[i].pbStop = &bStop;
+        poJobQueue->SubmitJob(GDALDEMLineRangeJobFunc, &asJobs[i]);
+    }
+
+    for (int i = nRanges; i > 0; --i)
+    {
+        poJobQueue->WaitCompletion(i - 1);
+        if (!bStop &&
+            !pfnProgress(1.0 * (nRanges - i + 1) / nRanges, nullptr,
+                         pProgressData))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            bStop = true;
+        }
+    }
+    poJobQueue->WaitCompletion();
+
+    for (const auto &sJob : asJobs)
+    {
+        if (sJob.eErr != CE_None)
+            return CE_Failure;
+    }
+    return CE_None;
+}
+
+/************************************************************************/
+/*                  GDALGeneric3x3ProcessLines()                        */
 /************************************************************************/
 
+// Computes the output lines in [nYStart, nYEnd), reading the source lines
+// just above and below the range as halos.
 template <class T>
-static CPLErr GDALGeneric3x3Processing(
+static CPLErr GDALGeneric3x3ProcessLines(
     GDALRasterBandH hSrcBand, GDALRasterBandH hDstBand,
     typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg,
     typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
         pfnAlg_multisample,
-    void *pData, bool bComputeAtEdges, GDALProgressFunc pfnProgress,
-    void *pProgressData)
+    void *pData, bool bComputeAtEdges, int nYStart, int nYEnd,
+    std::mutex &oIOMutex, GDALProgressFunc pfnProgress, void *pProgressData)
 {
     if (pfnProgress == nullptr)
         pfnProgress = GDALDummyProgress;
@@ -379,6 +487,19 @@ static CPLErr GDALGeneric3x3Processing(
     if (!bDstHasNoData)
         fDstNoDataValue = 0.0;
 
+    const auto ReadLine = [&](int iLine, T *pBuffer)
+    {
+        std::lock_guard<std::mutex> oLock(oIOMutex);
+        return GDALRasterIO(hSrcBand, GF_Read, 0, iLine, nXSize, 1, pBuffer,
+                            nXSize, 1, eReadDT, 0, 0);
+    };
+    const auto WriteLine = [&](int iLine)
+    {
+        std::lock_guard<std::mutex> oLock(oIOMutex);
+        return GDALRasterIO(hDstBand, GF_Write, 0, iLine, nXSize, 1,
+                            pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
+    };
+
     int nLine1Off = 0;
     int nLine2Off = nXSize;
     int nLine3Off = 2 * nXSize;
@@ -390,7 +511,8 @@ static CPLErr GDALGeneric3x3Processing(
     //      3 4 5
     //      6 7 8
 
-    /* Preload the first 2 lines */
+    /* Preload the first 2 lines, including the line above the range */
+    const int nFirstLine = std::max(0, nYStart - 1);
 
     bool abLineHasNoDataValue[3] = {CPL_TO_BOOL(bSrcHasNoData),
                                     CPL_TO_BOOL(bSrcHasNoData),
@@ -398,11 +520,10 @@ static CPLErr GDALGeneric3x3Processing(
 
     // Create an extra scope for VC12 to ignore i.
     {
-        for (int i = 0; i < 2 && i < nYSize; i++)
+        for (int i = 0; i < 2 && nFirstLine + i < nYSize; i++)
         {
-            if (GDALRasterIO(hSrcBand, GF_Read, 0, i, nXSize, 1,
-                             pafThreeLineWin + i * nXSize, nXSize, 1, eReadDT,
-                             0, 0) != CE_None)
+            if (ReadLine(nFirstLine + i, pafThreeLineWin + i * nXSize) !=
+                CE_None)
             {
                 CPLFree(pafOutputBuf);
                 CPLFree(pafThreeLineWin);
@@ -425,7 +546,11 @@ static CPLErr GDALGeneric3x3Processing(
     }  // End extra scope for VC12
 
     CPLErr eErr = CE_None;
-    if (bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
+    if (nYStart > 0)
+    {
+        // First line handled by another range
+    }
+    else if (bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
     {
         for (int j = 0; j < nXSize; j++)
         {
@@ -450,8 +575,7 @@ static CPLErr GDALGeneric3x3Processing(
                            CPL_TO_BOOL(bIsSrcNoDataNan), afWin, fDstNoDataValue,
                            pfnAlg, pData, bComputeAtEdges);
         }
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, 0, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
+        eErr = WriteLine(0);
     }
     else
     {
@@ -460,14 +584,17 @@ static CPLErr GDALGeneric3x3Processing(
         {
             pafOutputBuf[j] = fDstNoDataValue;
         }
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, 0, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
-
-        if (eErr == CE_None && nYSize > 1)
+        eErr = WriteLine(0);
+    }
+    if (eErr == CE_None && nYEnd == nYSize && nYSize > 1 &&
+        !(bComputeAtEdges && nXSize >= 2))
+    {
+        // Exclude the edges
+        for (int j = 0; j < nXSize; j++)
         {
-            eErr = GDALRasterIO(hDstBand, GF_Write, 0, nYSize - 1, nXSize, 1,
-                                pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
+            pafOutputBuf[j] = fDstNoDataValue;
         }
+        eErr = WriteLine(nYSize - 1);
     }
     if (eErr != CE_None)
     {
@@ -477,13 +604,11 @@ static CPLErr GDALGeneric3x3Processing(
         return eErr;
     }
 
-    int i = 1;  // Used after for.
-    for (; i < nYSize - 1; i++)
+    const int nLoopEnd = std::min(nYEnd, nYSize - 1);
+    for (int i = std::max(nYStart, 1); i < nLoopEnd; i++)
     {
         /* Read third line of the line buffer */
-        eErr =
-            GDALRasterIO(hSrcBand, GF_Read, 0, i + 1, nXSize, 1,
-                         pafThreeLineWin + nLine3Off, nXSize, 1, eReadDT, 0, 0);
+        eErr = ReadLine(i + 1, pafThreeLineWin + nLine3Off);
         if (eErr != CE_None)
         {
             CPLFree(pafOutputBuf);
@@ -617,8 +742,7 @@ static CPLErr GDALGeneric3x3Processing(
         /* -----------------------------------------
          * Write Line to Raster
          */
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, i, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
+        eErr = WriteLine(i);
         if (eErr != CE_None)
         {
             CPLFree(pafOutputBuf);
@@ -644,7 +768,7 @@ static CPLErr GDALGeneric3x3Processing(
         nLine3Off = nTemp;
     }
 
-    if (bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
+    if (nYEnd == nYSize && bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
     {
         for (int j = 0; j < nXSize; j++)
         {
@@ -674,8 +798,7 @@ static CPLErr GDALGeneric3x3Processing(
                            CPL_TO_BOOL(bIsSrcNoDataNan), afWin, fDstNoDataValue,
                            pfnAlg, pData, bComputeAtEdges);
         }
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, i, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
+        eErr = WriteLine(nYSize - 1);
         if (eErr != CE_None)
         {
             CPLFree(pafOutputBuf);
@@ -694,6 +817,32 @@ static CPLErr GDALGeneric3x3Processing(
     return eErr;
 }
 
+/************************************************************************/
+/*                  GDALGeneric3x3Processing()                          */
+/************************************************************************/
+
+template <class T>
+static CPLErr GDALGeneric3x3Processing(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hDstBand,
+    typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg,
+    typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
+        pfnAlg_multisample,
+    void *pData, bool bComputeAtEdges, GDALProgressFunc pfnProgress,
+    void *pProgressData)
+{
+    return GDALDEMProcessLineRanges(
+        GDALGetRasterBandYSize(hSrcBand),
+        [=](int nYStart, int nYEnd, std::mutex &oIOMutex,
+            GDALProgressFunc pfnLineProgress, void *pLineProgressData)
+        {
+            return GDALGeneric3x3ProcessLines<T>(
+                hSrcBand, hDstBand, pfnAlg, pfnAlg_multisample, pData,
+                bComputeAtEdges, nYStart, nYEnd, oIOMutex, pfnLineProgress,
+                pLineProgressData);
+        },
+        pfnProgress, pProgressData);
+}
+
 /************************************************************************/
 /*                            GradientAlg                               */
 /************************************************************************/
@@ -2243,173 +2392,125 @@ GDALColorRelief(GDALRasterBandH hSrcBand, GDALRasterBandH hDstBand1,
     const int nXSize = GDALGetRasterBandXSize(hSrcBand);
     const int nYSize = GDALGetRasterBandYSize(hSrcBand);
 
-    float *pafSourceBuf = nullptr;
-    int *panSourceBuf = nullptr;
-    if (pabyPrecomputed)
-        panSourceBuf =
-            static_cast<int *>(VSI_MALLOC2_VERBOSE(sizeof(int), nXSize));
-    else
-        pafSourceBuf =
-            static_cast<float *>(VSI_MALLOC2_VERBOSE(sizeof(float), nXSize));
-    GByte *pabyDestBuf1 = static_cast<GByte *>(VSI_MALLOC2_VERBOSE(4, nXSize));
-    GByte *pabyDestBuf2 = pabyDestBuf1 ? pabyDestBuf1 + nXSize : nullptr;
-    GByte *pabyDestBuf3 = pabyDestBuf2 ? pabyDestBuf2 + nXSize : nullptr;
-    GByte *pabyDestBuf4 = pabyDestBuf3 ? pabyDestBuf3 + nXSize : nullptr;
-
-    if ((pabyPrecomputed != nullptr && panSourceBuf == nullptr) ||
-        (pabyPrecomputed == nullptr && pafSourceBuf == nullptr) ||
-        pabyDestBuf1 == nullptr)
-    {
-        VSIFree(pabyPrecomputed);
-        CPLFree(pafSourceBuf);
-        CPLFree(panSourceBuf);
-        CPLFree(pabyDestBuf1);
-        CPLFree(pasColorAssociation);
-
-        return CE_Failure;
-    }
-
     if (!pfnProgress(0.0, nullptr, pProgressData))
     {
         CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
         VSIFree(pabyPrecomputed);
-        CPLFree(pafSourceBuf);
-        CPLFree(panSourceBuf);
-        CPLFree(pabyDestBuf1);
         CPLFree(pasColorAssociation);
 
         return CE_Failure;
     }
 
-    int nR = 0;
-    int nG = 0;
-    int nB = 0;
-    int nA = 0;
-
-    for (int i = 0; i < nYSize; i++)
+    const auto ProcessLines = [=](int nYStart, int nYEnd, std::mutex &oIOMutex,
+                                  GDALProgressFunc pfnLineProgress,
+                                  void *pLineProgressData)
     {
-        /* Read source buffer */
-        CPLErr eErr = GDALRasterIO(
-            hSrcBand, GF_Read, 0, i, nXSize, 1,
-            panSourceBuf ? static_cast<void *>(panSourceBuf)
-                         : static_cast<void *>(pafSourceBuf),
-            nXSize, 1, panSourceBuf ? GDT_Int32 : GDT_Float32, 0, 0);
-        if (eErr != CE_None)
-        {
-            VSIFree(pabyPrecomputed);
-            CPLFree(pafSourceBuf);
-            CPLFree(panSourceBuf);
-            CPLFree(pabyDestBuf1);
-            CPLFree(pasColorAssociation);
-            return eErr;
-        }
-
-        if (pabyPrecomputed)
+        std::vector<float> afSourceBuf;
+        std::vector<int> anSourceBuf;
+        std::vector<GByte> abyDestBuf;
+        try
         {
-            for (int j = 0; j < nXSize; j++)
-            {
-                int nIndex = panSourceBuf[j] + nIndexOffset;
-                pabyDestBuf1[j] = pabyPrecomputed[4 * nIndex];
-                pabyDestBuf2[j] = pabyPrecomputed[4 * nIndex + 1];
-                pabyDestBuf3[j] = pabyPrecomputed[4 * nIndex + 2];
-                pabyDestBuf4[j] = pabyPrecomputed[4 * nIndex + 3];
-            }
-        }
-        else
-        {
-            for (int j = 0; j < nXSize; j++)
-            {
-                GDALColorReliefGetRGBA(pasColorAssociation, nColorAssociation,
-                                       pafSourceBuf[j], eColorSelectionMode,
-                                       &nR, &nG, &nB, &nA);
-                pabyDestBuf1[j] = static_cast<GByte>(nR);
-                pabyDestBuf2[j] = static_cast<GByte>(nG);
-                pabyDestBuf3[j] = static_cast<GByte>(nB);
-                pabyDestBuf4[j] = static_cast<GByte>(nA);
-            }
-        }
-
-        /* -----------------------------------------
-         * Write Line to Raster
-         */
-        eErr = GDALRasterIO(hDstBand1, GF_Write, 0, i, nXSize, 1, pabyDestBuf1,
-                            nXSize, 1, GDT_Byte, 0, 0);
-        if (eErr != CE_None)
-        {
-            VSIFree(pabyPrecomputed);
-            CPLFree(pafSourceBuf);
-            CPLFree(panSourceBuf);
-            CPLFree(pabyDestBuf1);
-            CPLFree(pasColorAssociation);
-
-            return eErr;
+            if (pabyPrecomputed)
+                anSourceBuf.resize(nXSize);
+            else
+                afSourceBuf.resize(nXSize);
+            abyDestBuf.resize(4 * static_cast<size_t>(nXSize));
         }
-
-        eErr = GDALRasterIO(hDstBand2, GF_Write, 0, i, nXSize, 1, pabyDestBuf2,
-                            nXSize, 1, GDT_Byte, 0, 0);
-        if (eErr != CE_None)
+        catch (const std::exception &)
         {
-            VSIFree(pabyPrecomputed);
-            CPLFree(pafSourceBuf);
-            CPLFree(panSourceBuf);
-            CPLFree(pabyDestBuf1);
-            CPLFree(pasColorAssociation);
-
-            return eErr;
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in GDALColorRelief()");
+            return CE_Failure;
         }
+        GByte *pabyDestBuf1 = abyDestBuf.data();
+        GByte *pabyDestBuf2 = pabyDestBuf1 + nXSize;
+        GByte *pabyDestBuf3 = pabyDestBuf2 + nXSize;
+        GByte *pabyDestBuf4 = pabyDestBuf3 + nXSize;
 
-        eErr = GDALRasterIO(hDstBand3, GF_Write, 0, i, nXSize, 1, pabyDestBuf3,
-                            nXSize, 1, GDT_Byte, 0, 0);
-        if (eErr != CE_None)
-        {
-            VSIFree(pabyPrecomputed);
-            CPLFree(pafSourceBuf);
-            CPLFree(panSourceBuf);
-            CPLFree(pabyDestBuf1);
-            CPLFree(pasColorAssociation);
-
-            return eErr;
-        }
+        int nR = 0;
+        int nG = 0;
+        int nB = 0;
+        int nA = 0;
 
-        if (hDstBand4)
+        for (int i = nYStart; i < nYEnd; i++)
         {
-            eErr = GDALRasterIO(hDstBand4, GF_Write, 0, i, nXSize, 1,
-                                pabyDestBuf4, nXSize, 1, GDT_Byte, 0, 0);
-            if (eErr != CE_None)
+            /* Read source buffer */
             {
-                VSIFree(pabyPrecomputed);
-                CPLFree(pafSourceBuf);
-                CPLFree(panSourceBuf);
-                CPLFree(pabyDestBuf1);
-                CPLFree(pasColorAssociation);
-
-                return eErr;
+                std::lock_guard<std::mutex> oLock(oIOMutex);
+                const CPLErr eErr = GDALRasterIO(
+                    hSrcBand, GF_Read, 0, i, nXSize, 1,
+                    pabyPrecomputed ? static_cast<void *>(anSourceBuf.data())
+                                    : static_cast<void *>(afSourceBuf.data()),
+                    nXSize, 1, pabyPrecomputed ? GDT_Int32 : GDT_Float32, 0,
+                    0);
+                if (eErr != CE_None)
+                    return eErr;
             }
-        }
 
-        if (!pfnProgress(1.0 * (i + 1) / nYSize, nullptr, pProgressData))
-        {
-            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            if (pabyPrecomputed)
+            {
+                for (int j = 0; j < nXSize; j++)
+                {
+                    int nIndex = anSourceBuf[j] + nIndexOffset;
+                    pabyDestBuf1[j] = pabyPrecomputed[4 * nIndex];
+                    pabyDestBuf2[j] = pabyPrecomputed[4 * nIndex + 1];
+                    pabyDestBuf3[j] = pabyPrecomputed[4 * nIndex + 2];
+                    pabyDestBuf4[j] = pabyPrecomputed[4 * nIndex + 3];
+                }
+            }
+            else
+            {
+                for (int j = 0; j < nXSize; j++)
+                {
+                    GDALColorReliefGetRGBA(
+                        pasColorAssociation, nColorAssociation, afSourceBuf[j],
+                        eColorSelectionMode, &nR, &nG, &nB, &nA);
+                    pabyDestBuf1[j] = static_cast<GByte>(nR);
+                    pabyDestBuf2[j] = static_cast<GByte>(nG);
+                    pabyDestBuf3[j] = static_cast<GByte>(nB);
+                    pabyDestBuf4[j] = static_cast<GByte>(nA);
+                }
+            }
 
-            VSIFree(pabyPrecomputed);
-            CPLFree(pafSourceBuf);
-            CPLFree(panSourceBuf);
-            CPLFree(pabyDestBuf1);
-            CPLFree(pasColorAssociation);
+            /* -----------------------------------------
+             * Write Line to Raster
+             */
+            {
+                std::lock_guard<std::mutex> oLock(oIOMutex);
+                const GDALRasterBandH ahDstBands[] = {hDstBand1, hDstBand2,
+                                                      hDstBand3, hDstBand4};
+                const GByte *apabyDestBufs[] = {pabyDestBuf1, pabyDestBuf2,
+                                                pabyDestBuf3, pabyDestBuf4};
+                for (int k = 0; k < 4 && ahDstBands[k]; k++)
+                {
+                    const CPLErr eErr = GDALRasterIO(
+                        ahDstBands[k], GF_Write, 0, i, nXSize, 1,
+                        const_cast<GByte *>(apabyDestBufs[k]), nXSize, 1,
+                        GDT_Byte, 0, 0);
+                    if (eErr != CE_None)
+                        return eErr;
+                }
+            }
 
-            return CE_Failure;
+            if (!pfnLineProgress(1.0 * (i + 1) / nYSize, nullptr,
+                                 pLineProgressData))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                return CE_Failure;
+            }
         }
-    }
+        return CE_None;
+    };
 
-    pfnProgress(1.0, nullptr, pProgressData);
+    const CPLErr eErr = GDALDEMProcessLineRanges(nYSize, ProcessLines,
+                                                 pfnProgress, pProgressData);
+    if (eErr == CE_None)
+        pfnProgress(1.0, nullptr, pProgressData);
 
     VSIFree(pabyPrecomputed);
-    CPLFree(pafSourceBuf);
-    CPLFree(panSourceBuf);
-    CPLFree(pabyDestBuf1);
     CPLFree(pasColorAssociation);
 
-    return CE_None;
+    return eErr;
 }
 
 /************************************************************************/
@@ -814,6 +814,38 @@ char *GDALInfo(GDALDatasetH hDataset, const GDALInfoOptions *psOptions)
         hTransform = nullptr;
     }
 
+    /* ==================================================================== */
+    /*      Compute exact statistics of all bands that do not have them     */
+    /*      yet in a single pass over the dataset. Bands for which this     */
+    /*      fails are processed again, with error reporting, in the loop.   */
+    /* ==================================================================== */
+    if (psOptions->bStats && !psOptions->bApproxStats)
+    {
+        std::vector<int> anBandsWithoutStats;
+        for (int iBand = 0; iBand < GDALGetRasterCount(hDataset); iBand++)
+        {
+            GDALRasterBandH hBand = GDALGetRasterBand(hDataset, iBand + 1);
+            double dfMin = 0;
+            double dfMax = 0;
+            double dfMean = 0;
+            double dfStdDev = 0;
+            if (GDALGetRasterStatistics(hBand, FALSE, FALSE, &dfMin, &dfMax,
+                                        &dfMean, &dfStdDev) != CE_None)
+            {
+                anBandsWithoutStats.push_back(iBand + 1);
+            }
+        }
+        if (anBandsWithoutStats.size() > 1)
+        {
+            CPLPushErrorHandler(CPLQuietErrorHandler);
+            CPL_IGNORE_RET_VAL(GDALDatasetComputeStatistics(
+                hDataset, static_cast<int>(anBandsWithoutStats.size()),
+                anBandsWithoutStats.data(), FALSE, nullptr, nullptr));
+            CPLPopErrorHandler();
+            CPLErrorReset();
+        }
+    }
+
     /* ==================================================================== */
     /*      Loop over bands.                                                */
     /* ==================================================================== */
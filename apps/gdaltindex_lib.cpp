@@ -786,14 +786,36 @@ GDALDatasetH GDALTileIndex(const char *pszDest, int nSrcCount,
         !psOptions->osGTIFilename.empty();
 
     /* -------------------------------------------------------------------- */
-    /*      loop over GDAL files, processing.                               */
+    /*      loop over GDAL files, processing. Files are opened ahead, in    */
+    /*      parallel if GDAL_NUM_THREADS is set, but processed in order.    */
     /* -------------------------------------------------------------------- */
+    GDALDatasetPrefetcher oPrefetcher(
+        GDALGetNumThreadsForPrefetching(),
+        [](const std::string &osFilename)
+        {
+            return GDALDataset::Open(osFilename.c_str(),
+                                     GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR,
+                                     nullptr, nullptr, nullptr);
+        });
+    bool bNoMoreFiles = false;
     while (true)
     {
-        const std::string osSrcFilename = oGDALTileIndexTileIterator.next();
-        if (osSrcFilename.empty())
+        while (!bNoMoreFiles && !oPrefetcher.IsFull())
+        {
+            const std::string osNextFilename =
+                oGDALTileIndexTileIterator.next();
+            if (osNextFilename.empty())
+                bNoMoreFiles = true;
+            else
+                oPrefetcher.Submit(osNextFilename);
+        }
+        if (oPrefetcher.IsEmpty())
             break;
 
+        std::string osSrcFilename;
+        auto poSrcDS =
+            std::unique_ptr<GDALDataset>(oPrefetcher.Next(osSrcFilename));
+
         std::string osFileNameToWrite;
         VSIStatBuf sStatBuf;
 
@@ -820,9 +842,6 @@ GDALDatasetH GDALTileIndex(const char *pszDest, int nSrcCount,
             continue;
         }
 
-        auto poSrcDS = std::unique_ptr<GDALDataset>(GDALDataset::Open(
-            osSrcFilename.c_str(), GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR,
-            nullptr, nullptr, nullptr));
         if (poSrcDS == nullptr)
         {
             CPLError(CE_Warning, CPLE_AppDefined,
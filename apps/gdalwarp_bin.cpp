@@ -87,8 +87,8 @@ static void Usage(bool bIsError, const char *pszErrorMsg = nullptr)
         "[-crop_to_cutline]\n"
         "    [-if <format>]... [-of <format>] [-co <NAME>=<VALUE>]... "
         "[-overwrite]\n"
-        "    [-nomd] [-cvmd <meta_conflict_value>] [-setci] [-oo "
-        "<NAME>=<VALUE>]...\n"
+        "    [-incremental] [-nomd] [-cvmd <meta_conflict_value>] [-setci]\n"
+        "    [-oo <NAME>=<VALUE>]...\n"
         "    [-doo <NAME>=<VALUE>]...\n"
         "    <srcfile>... <dstfile>\n"
         "\n"
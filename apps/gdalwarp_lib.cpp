@@ -56,8 +56,10 @@
 #include "commonutils.h"
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_json.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
+#include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "gdal_alg_priv.h"
@@ -195,6 +197,11 @@ struct GDALWarpAppOptions
        simultaneously. */
     bool bMulti = false;
 
+    /*! only re-warp the areas of an existing destination dataset affected by
+       sources that have been added, removed or modified since the previous
+       run, as recorded in a <dstfile>.gdalwarp.json sidecar file */
+    bool bIncremental = false;
+
     /*! list of transformer options suitable to pass to
        GDALCreateGenImgProjTransformer2().
         ("NAME1=VALUE1","NAME2=VALUE2",...) */
@@ -1419,6 +1426,15 @@ GDALDatasetH GDALWarp(const char *pszDest, GDALDatasetH hDstDS, int nSrcCount,
             GDALGetMetadataItem(hDriver, GDAL_DCAP_CREATECOPY, nullptr) !=
                 nullptr)
         {
+            if (psOptions->bIncremental)
+            {
+                CPLError(CE_Failure, CPLE_NotSupported,
+                         "-incremental is not supported for output formats "
+                         "that do not support update");
+                if (pbUsageError)
+                    *pbUsageError = TRUE;
+                return nullptr;
+            }
             auto ret = GDALWarpIndirect(pszDest, hDriver, nSrcCount, pahSrcDS,
                                         psOptions, pbUsageError);
             return ret;
@@ -1499,6 +1515,15 @@ static bool CheckOptions(const char *pszDest, GDALDatasetH hDstDS,
         }
     }
 
+    if (psOptions->bIncremental && (bVRT || pszDest[0] == '\0'))
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "-incremental requires an output file that is not a VRT.");
+        if (pbUsageError)
+            *pbUsageError = TRUE;
+        return false;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Check that incompatible options are not used                    */
     /* -------------------------------------------------------------------- */
@@ -2395,6 +2420,389 @@ static bool AdjustOutputExtentForRPC(GDALDatasetH hSrcDS, GDALDatasetH hDstDS,
     return true;
 }
 
+/************************************************************************/
+/*                    Incremental warping helpers                       */
+/************************************************************************/
+
+// A window of the destination dataset: x offset, y offset, x size, y size.
+// An empty window has a null size.
+typedef std::array<int, 4> GDALWarpDstWindow;
+
+static std::string GetIncrementalStateFilename(const char *pszDest)
+{
+    return std::string(pszDest) + ".gdalwarp.json";
+}
+
+static bool IsEmptyWindow(const GDALWarpDstWindow &anWindow)
+{
+    return anWindow[2] <= 0 || anWindow[3] <= 0;
+}
+
+static GDALWarpDstWindow IntersectWindows(const GDALWarpDstWindow &anA,
+                                          const GDALWarpDstWindow &anB)
+{
+    const int nXOff = std::max(anA[0], anB[0]);
+    const int nYOff = std::max(anA[1], anB[1]);
+    const int nXEnd = std::min(anA[0] + anA[2], anB[0] + anB[2]);
+    const int nYEnd = std::min(anA[1] + anA[3], anB[1] + anB[3]);
+    if (nXEnd <= nXOff || nYEnd <= nYOff)
+        return GDALWarpDstWindow{0, 0, 0, 0};
+    return GDALWarpDstWindow{nXOff, nYOff, nXEnd - nXOff, nYEnd - nYOff};
+}
+
+/************************************************************************/
+/*                          AddDirtyWindow()                            */
+/************************************************************************/
+
+// Add a window to the list of destination windows to re-warp. Intersecting
+// windows are merged into their bounding box, so that no destination pixel
+// is warped twice from the same source, which would blend it with itself.
+
+static void AddDirtyWindow(std::vector<GDALWarpDstWindow> &aanWindows,
+                           GDALWarpDstWindow anWindow)
+{
+    if (IsEmptyWindow(anWindow))
+        return;
+
+    bool bMerged = true;
+    while (bMerged)
+    {
+        bMerged = false;
+        for (auto oIter = aanWindows.begin(); oIter != aanWindows.end();
+             ++oIter)
+        {
+            const auto &anOther = *oIter;
+            if (IsEmptyWindow(IntersectWindows(anOther, anWindow)))
+                continue;
+            const int nXOff = std::min(anOther[0], anWindow[0]);
+            const int nYOff = std::min(anOther[1], anWindow[1]);
+            const int nXEnd =
+                std::max(anOther[0] + anOther[2], anWindow[0] + anWindow[2]);
+            const int nYEnd =
+                std::max(anOther[1] + anOther[3], anWindow[1] + anWindow[3]);
+            anWindow = GDALWarpDstWindow{nXOff, nYOff, nXEnd - nXOff,
+                                         nYEnd - nYOff};
+            aanWindows.erase(oIter);
+            bMerged = true;
+            break;
+        }
+    }
+    aanWindows.push_back(anWindow);
+}
+
+/************************************************************************/
+/*                   GetIncrementalSourceWindow()                       */
+/************************************************************************/
+
+// Return the window of the destination dataset that can be affected by a
+// source dataset, padded to account for the resampling kernel radius.
+// The whole destination is returned if it cannot be computed.
+
+static GDALWarpDstWindow
+GetIncrementalSourceWindow(GDALDatasetH hSrcDS, GDALDatasetH hDstDS,
+                           GDALWarpAppOptions *psOptions)
+{
+    const int nDstXSize = GDALGetRasterXSize(hDstDS);
+    const int nDstYSize = GDALGetRasterYSize(hDstDS);
+    const GDALWarpDstWindow anFullWindow{0, 0, nDstXSize, nDstYSize};
+
+    void *hTransformArg = GDALCreateGenImgProjTransformer2(
+        hSrcDS, hDstDS, psOptions->aosTransformerOptions.List());
+    if (hTransformArg == nullptr)
+    {
+        CPLErrorReset();
+        return anFullWindow;
+    }
+
+    double adfSuggestedGeoTransform[6];
+    double adfExtent[4];
+    int nPixels = 0;
+    int nLines = 0;
+    const CPLErr eErr = GDALSuggestedWarpOutput2(
+        hSrcDS, GDALGenImgProjTransform, hTransformArg,
+        adfSuggestedGeoTransform, &nPixels, &nLines, adfExtent, 0);
+    GDALDestroyGenImgProjTransformer(hTransformArg);
+    if (eErr != CE_None)
+    {
+        CPLErrorReset();
+        return anFullWindow;
+    }
+
+    const double dfMinX = adfExtent[0];
+    const double dfMinY = adfExtent[1];
+    const double dfMaxX = adfExtent[2];
+    const double dfMaxY = adfExtent[3];
+    const double dfThreshold = static_cast<double>(INT_MAX) / 2;
+    if (!(std::fabs(dfMinX) < dfThreshold && std::fabs(dfMinY) < dfThreshold &&
+          std::fabs(dfMaxX) < dfThreshold && std::fabs(dfMaxY) < dfThreshold))
+    {
+        return anFullWindow;
+    }
+
+    // Number of destination pixels per source pixel, to pad by a few source
+    // pixels for the resampling kernels.
+    const double dfRatio =
+        std::max((dfMaxX - dfMinX) / GDALGetRasterXSize(hSrcDS),
+                 (dfMaxY - dfMinY) / GDALGetRasterYSize(hSrcDS));
+    const int nPadding =
+        5 + static_cast<int>(std::ceil(4 * std::min(dfRatio, dfThreshold)));
+    const GDALWarpDstWindow anWindow{
+        static_cast<int>(std::floor(dfMinX)) - nPadding,
+        static_cast<int>(std::floor(dfMinY)) - nPadding,
+        static_cast<int>(std::ceil(dfMaxX - std::floor(dfMinX))) +
+            2 * nPadding,
+        static_cast<int>(std::ceil(dfMaxY - std::floor(dfMinY))) +
+            2 * nPadding};
+    return IntersectWindows(anWindow, anFullWindow);
+}
+
+/************************************************************************/
+/*                     GetIncrementalSourceState()                      */
+/************************************************************************/
+
+// Return the fingerprint of a source dataset: its name, and the size,
+// modification time and, for network files, ETag of its file.
+
+static CPLJSONObject GetIncrementalSourceState(GDALDatasetH hSrcDS)
+{
+    CPLJSONObject oSource;
+    const char *pszName = GDALGetDescription(hSrcDS);
+    oSource.Add("name", pszName);
+
+    VSIStatBufL sStat;
+    if (VSIStatL(pszName, &sStat) == 0)
+    {
+        oSource.Add("size", static_cast<GInt64>(sStat.st_size));
+        oSource.Add("mtime", static_cast<GInt64>(sStat.st_mtime));
+
+        char **papszHeaders = VSIGetFileMetadata(pszName, "HEADERS", nullptr);
+        const char *pszETag = CSLFetchNameValue(papszHeaders, "ETag");
+        if (pszETag)
+            oSource.Add("etag", pszETag);
+        CSLDestroy(papszHeaders);
+    }
+    return oSource;
+}
+
+static bool IsSameSourceState(const CPLJSONObject &oA, const CPLJSONObject &oB)
+{
+    // Sources whose file cannot be stat'ed are always considered as changed.
+    if (oA.GetLong("size", -1) < 0 || oB.GetLong("size", -1) < 0)
+        return false;
+    return oA.GetString("name") == oB.GetString("name") &&
+           oA.GetLong("size") == oB.GetLong("size") &&
+           oA.GetLong("mtime") == oB.GetLong("mtime") &&
+           oA.GetString("etag") == oB.GetString("etag");
+}
+
+static GDALWarpDstWindow GetStateWindow(const CPLJSONObject &oSource)
+{
+    const auto oArray = oSource.GetArray("window");
+    if (!oArray.IsValid() || oArray.Size() != 4)
+        return GDALWarpDstWindow{0, 0, 0, 0};
+    return GDALWarpDstWindow{oArray[0].ToInteger(), oArray[1].ToInteger(),
+                             oArray[2].ToInteger(), oArray[3].ToInteger()};
+}
+
+/************************************************************************/
+/*                     GetIncrementalSignature()                        */
+/************************************************************************/
+
+// Return a string summarizing the destination grid and the main options that
+// affect the value of the warped pixels. A previous state computed with a
+// different signature cannot be used for an incremental update. Warping and
+// transformer options are not included, as gdalwarp itself adjusts them
+// depending on whether the destination dataset is created or updated.
+
+static std::string GetIncrementalSignature(GDALDatasetH hDstDS,
+                                           const GDALWarpAppOptions *psOptions)
+{
+    std::string osSignature;
+    double adfGeoTransform[6] = {0, 1, 0, 0, 0, 1};
+    GDALGetGeoTransform(hDstDS, adfGeoTransform);
+    osSignature += CPLSPrintf(
+        "size=%dx%d gt=%.17g,%.17g,%.17g,%.17g,%.17g,%.17g",
+        GDALGetRasterXSize(hDstDS), GDALGetRasterYSize(hDstDS),
+        adfGeoTransform[0], adfGeoTransform[1], adfGeoTransform[2],
+        adfGeoTransform[3], adfGeoTransform[4], adfGeoTransform[5]);
+    osSignature += CPLSPrintf(" r=%d et=%.17g", psOptions->eResampleAlg,
+                              psOptions->dfErrorThreshold);
+    osSignature += " srcnodata=" + psOptions->osSrcNodata;
+    osSignature += " dstnodata=" + psOptions->osDstNodata;
+    osSignature += " cutline=" + psOptions->osCutlineDSName;
+    for (int nBand : psOptions->anSrcBands)
+        osSignature += CPLSPrintf(" b=%d", nBand);
+    for (int nBand : psOptions->anDstBands)
+        osSignature += CPLSPrintf(" dstband=%d", nBand);
+    return osSignature;
+}
+
+/************************************************************************/
+/*                      PrepareIncrementalWarp()                        */
+/************************************************************************/
+
+// Compute the fingerprint and destination window of each source in
+// oNewState, and, when the destination dataset has been updated by a
+// previous compatible run, the windows of the destination that must be
+// re-warped because a source contributing to them has been added, removed
+// or modified.
+
+static void
+PrepareIncrementalWarp(const char *pszDest, GDALDatasetH hDstDS, int nSrcCount,
+                       GDALDatasetH *pahSrcDS, GDALWarpAppOptions *psOptions,
+                       CPLJSONObject &oNewState,
+                       std::vector<GDALWarpDstWindow> &aanSrcWindows,
+                       bool &bIncrementalUpdate,
+                       std::vector<GDALWarpDstWindow> &aanDirtyWindows)
+{
+    oNewState.Add("type", "GDALWarpIncrementalState");
+    oNewState.Add("version", 1);
+    oNewState.Add("signature", GetIncrementalSignature(hDstDS, psOptions));
+
+    CPLJSONArray oNewSources;
+    for (int iSrc = 0; iSrc < nSrcCount; ++iSrc)
+    {
+        CPLJSONObject oSource = GetIncrementalSourceState(pahSrcDS[iSrc]);
+        const auto anWindow =
+            GetIncrementalSourceWindow(pahSrcDS[iSrc], hDstDS, psOptions);
+        CPLJSONArray oWindow;
+        for (int nVal : anWindow)
+            oWindow.Add(nVal);
+        oSource.Add("window", oWindow);
+        oNewSources.Add(oSource);
+        aanSrcWindows.push_back(anWindow);
+    }
+    oNewState.Add("sources", oNewSources);
+
+    bIncrementalUpdate = false;
+    if (psOptions->bCreateOutput)
+        return;
+
+    const std::string osStateFilename = GetIncrementalStateFilename(pszDest);
+    VSIStatBufL sStat;
+    CPLJSONDocument oOldDoc;
+    if (VSIStatL(osStateFilename.c_str(), &sStat) != 0 ||
+        !oOldDoc.Load(osStateFilename))
+    {
+        CPLErrorReset();
+        CPLDebug("GDALWARP",
+                 "No previous incremental state. Processing all sources");
+        return;
+    }
+    const auto oOldState = oOldDoc.GetRoot();
+    if (oOldState.GetString("type") != "GDALWarpIncrementalState" ||
+        oOldState.GetInteger("version") != 1 ||
+        oOldState.GetString("signature") !=
+            oNewState.GetString("signature"))
+    {
+        CPLDebug("GDALWARP", "Previous incremental state is not compatible "
+                             "with current options. Processing all sources");
+        return;
+    }
+
+    const auto oOldSources = oOldState.GetArray("sources");
+    std::vector<bool> abOldSourceMatched(oOldSources.Size(), false);
+    for (int iSrc = 0; iSrc < nSrcCount; ++iSrc)
+    {
+        const auto oSource = oNewSources[iSrc];
+        bool bUnchanged = false;
+        for (int i = 0; i < oOldSources.Size(); ++i)
+        {
+            const auto oOldSource = oOldSources[i];
+            if (!abOldSourceMatched[i] &&
+                oOldSource.GetString("name") == oSource.GetString("name"))
+            {
+                abOldSourceMatched[i] = true;
+                bUnchanged = IsSameSourceState(oOldSource, oSource) &&
+                             GetStateWindow(oOldSource) == aanSrcWindows[iSrc];
+                if (!bUnchanged)
+                    AddDirtyWindow(aanDirtyWindows,
+                                   GetStateWindow(oOldSource));
+                break;
+            }
+        }
+        if (!bUnchanged)
+        {
+            CPLDebug("GDALWARP", "%s is new or has changed",
+                     oSource.GetString("name").c_str());
+            AddDirtyWindow(aanDirtyWindows, aanSrcWindows[iSrc]);
+        }
+    }
+    for (int i = 0; i < oOldSources.Size(); ++i)
+    {
+        if (!abOldSourceMatched[i])
+        {
+            CPLDebug("GDALWARP", "%s has been removed",
+                     oOldSources[i].GetString("name").c_str());
+            AddDirtyWindow(aanDirtyWindows, GetStateWindow(oOldSources[i]));
+        }
+    }
+
+    bIncrementalUpdate = true;
+}
+
+/************************************************************************/
+/*                       ClearDirtyWindows()                            */
+/************************************************************************/
+
+// Reset the destination windows to re-warp to the value a newly created
+// destination dataset is initialized with: the INIT_DEST value if it is
+// numeric, or the nodata value of the band, or 0.
+
+static CPLErr
+ClearDirtyWindows(GDALDatasetH hDstDS, const GDALWarpAppOptions *psOptions,
+                  bool bEnableDstAlpha,
+                  const std::vector<GDALWarpDstWindow> &aanWindows)
+{
+    std::vector<int> anBands(psOptions->anDstBands);
+    if (anBands.empty())
+    {
+        for (int i = 1; i <= GDALGetRasterCount(hDstDS); ++i)
+            anBands.push_back(i);
+    }
+    else if (bEnableDstAlpha)
+    {
+        anBands.push_back(static_cast<int>(psOptions->anDstBands.size()) + 1);
+    }
+
+    const char *pszInitDest =
+        psOptions->aosWarpOptions.FetchNameValue("INIT_DEST");
+    const bool bNumericInitDest =
+        pszInitDest != nullptr && !EQUAL(pszInitDest, "") &&
+        !EQUAL(pszInitDest, "NO_DATA");
+
+    for (const int nBand : anBands)
+    {
+        GDALRasterBandH hBand = GDALGetRasterBand(hDstDS, nBand);
+        if (hBand == nullptr)
+            continue;
+        double dfValue = 0;
+        if (GDALGetRasterColorInterpretation(hBand) != GCI_AlphaBand)
+        {
+            int bHasNoData = FALSE;
+            const double dfNoData =
+                GDALGetRasterNoDataValue(hBand, &bHasNoData);
+            if (bNumericInitDest)
+                dfValue = CPLAtof(pszInitDest);
+            else if (bHasNoData)
+                dfValue = dfNoData;
+        }
+        for (const auto &anWindow : aanWindows)
+        {
+            std::vector<double> adfLine(anWindow[2], dfValue);
+            for (int iY = 0; iY < anWindow[3]; ++iY)
+            {
+                if (GDALRasterIO(hBand, GF_Write, anWindow[0],
+                                 anWindow[1] + iY, anWindow[2], 1,
+                                 adfLine.data(), anWindow[2], 1, GDT_Float64,
+                                 0, 0) != CE_None)
+                    return CE_Failure;
+            }
+        }
+    }
+    return CE_None;
+}
+
 /************************************************************************/
 /*                           GDALWarpDirect()                           */
 /************************************************************************/
@@ -2570,6 +2978,37 @@ static GDALDatasetH GDALWarpDirect(const char *pszDest, GDALDatasetH hDstDS,
     oProgress.nSrcCount = nSrcCount;
     oProgress.pahSrcDS = pahSrcDS;
 
+    /* -------------------------------------------------------------------- */
+    /*      In incremental mode, find the destination windows that must     */
+    /*      be re-warped, and reset them.                                   */
+    /* -------------------------------------------------------------------- */
+    CPLJSONDocument oIncrementalState;
+    std::vector<GDALWarpDstWindow> aanSrcWindows;
+    std::vector<GDALWarpDstWindow> aanDirtyWindows;
+    bool bIncrementalUpdate = false;
+    if (psOptions->bIncremental)
+    {
+        auto oRoot = oIncrementalState.GetRoot();
+        PrepareIncrementalWarp(pszDest, hDstDS, nSrcCount, pahSrcDS, psOptions,
+                               oRoot, aanSrcWindows, bIncrementalUpdate,
+                               aanDirtyWindows);
+        if (bIncrementalUpdate)
+        {
+            for (const auto &anWindow : aanDirtyWindows)
+            {
+                CPLDebug("GDALWARP", "Re-warping window %d,%d,%dx%d",
+                         anWindow[0], anWindow[1], anWindow[2], anWindow[3]);
+            }
+            if (ClearDirtyWindows(hDstDS, psOptions, bEnableDstAlpha,
+                                  aanDirtyWindows) != CE_None)
+            {
+                OGR_G_DestroyGeometry(hCutline);
+                GDALReleaseDataset(hDstDS);
+                return nullptr;
+            }
+        }
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Loop over all source files, processing each in turn.            */
     /* -------------------------------------------------------------------- */
@@ -2603,6 +3042,31 @@ static GDALDatasetH GDALWarpDirect(const char *pszDest, GDALDatasetH hDstDS,
             return nullptr;
         }
 
+        /* --------------------------------------------------------------------
+         */
+        /*      In incremental mode, only warp the parts of the source that */
+        /*      intersect the windows to re-warp. */
+        /* --------------------------------------------------------------------
+         */
+        std::vector<GDALWarpDstWindow> aanSrcDirtyWindows;
+        if (bIncrementalUpdate)
+        {
+            for (const auto &anWindow : aanDirtyWindows)
+            {
+                const auto anIntersection =
+                    IntersectWindows(anWindow, aanSrcWindows[iSrc]);
+                if (!IsEmptyWindow(anIntersection))
+                    aanSrcDirtyWindows.push_back(anIntersection);
+            }
+            if (aanSrcDirtyWindows.empty())
+            {
+                CPLDebug("GDALWARP", "Skipping %s, which is unchanged",
+                         GDALGetDescription(hSrcDS));
+                oProgress.Do(1);
+                continue;
+            }
+        }
+
         /* --------------------------------------------------------------------
          */
         /*      Do we have a source alpha band? */
@@ -3198,15 +3662,32 @@ static GDALDatasetH GDALWarpDirect(const char *pszDest, GDALDatasetH hDstDS,
 
         if (oWO.Initialize(psWO) == CE_None)
         {
-            CPLErr eErr;
-            if (psOptions->bMulti)
-                eErr = oWO.ChunkAndWarpMulti(nWarpDstXOff, nWarpDstYOff,
-                                             nWarpDstXSize, nWarpDstYSize);
-            else
-                eErr = oWO.ChunkAndWarpImage(nWarpDstXOff, nWarpDstYOff,
-                                             nWarpDstXSize, nWarpDstYSize);
-            if (eErr != CE_None)
-                bHasGotErr = true;
+            if (!bIncrementalUpdate)
+            {
+                aanSrcDirtyWindows.push_back(GDALWarpDstWindow{
+                    nWarpDstXOff, nWarpDstYOff, nWarpDstXSize, nWarpDstYSize});
+            }
+            for (const auto &anDirtyWindow : aanSrcDirtyWindows)
+            {
+                const auto anWindow = IntersectWindows(
+                    anDirtyWindow,
+                    GDALWarpDstWindow{nWarpDstXOff, nWarpDstYOff,
+                                      nWarpDstXSize, nWarpDstYSize});
+                if (IsEmptyWindow(anWindow))
+                    continue;
+                CPLErr eErr;
+                if (psOptions->bMulti)
+                    eErr = oWO.ChunkAndWarpMulti(anWindow[0], anWindow[1],
+                                                 anWindow[2], anWindow[3]);
+                else
+                    eErr = oWO.ChunkAndWarpImage(anWindow[0], anWindow[1],
+                                                 anWindow[2], anWindow[3]);
+                if (eErr != CE_None)
+                {
+                    bHasGotErr = true;
+                    break;
+                }
+            }
         }
         else
         {
@@ -3237,6 +3718,18 @@ static GDALDatasetH GDALWarpDirect(const char *pszDest, GDALDatasetH hDstDS,
 
     OGR_G_DestroyGeometry(hCutline);
 
+    /* -------------------------------------------------------------------- */
+    /*      Record the state of the sources for the next incremental run,   */
+    /*      or remove it if the destination might be inconsistent with it.  */
+    /* -------------------------------------------------------------------- */
+    if (psOptions->bIncremental)
+    {
+        const std::string osStateFilename =
+            GetIncrementalStateFilename(pszDest);
+        if (bHasGotErr || !oIncrementalState.Save(osStateFilename))
+            VSIUnlink(osStateFilename.c_str());
+    }
+
     if (bHasGotErr || bDropDstDSRef)
         GDALReleaseDataset(hDstDS);
 
@@ -5381,6 +5874,10 @@ GDALWarpAppOptionsNew(char **papszArgv,
         {
             psOptions->bMulti = true;
         }
+        else if (EQUAL(papszArgv[i], "-incremental"))
+        {
+            psOptions->bIncremental = true;
+        }
         else if (EQUAL(papszArgv[i], "-q") || EQUAL(papszArgv[i], "-quiet"))
         {
             if (psOptionsForBinary)
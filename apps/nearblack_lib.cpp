@@ -46,6 +46,7 @@
 #include "cpl_string.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 #include "nearblack_lib.h"
 
@@ -333,6 +334,37 @@ GDALDatasetH CPL_DLL GDALNearblack(const char *pszDest, GDALDatasetH hDstDS,
     return hDstDS;
 }
 
+/************************************************************************/
+/*                        NearblackReadChunk()                          */
+/************************************************************************/
+
+namespace
+{
+// Read of a chunk of lines of the source dataset, possibly run by a worker
+// thread while the previous chunk is processed.
+struct NearblackReadJob
+{
+    GDALDatasetH hDS = nullptr;
+    int nXSize = 0;
+    int iStartLine = 0;
+    int nLines = 0;
+    int nBands = 0;
+    int nDstBands = 0;
+    GByte *pabyChunk = nullptr;
+    CPLErr eErr = CE_None;
+};
+}  // namespace
+
+static void NearblackReadChunk(void *pData)
+{
+    auto psJob = static_cast<NearblackReadJob *>(pData);
+    psJob->eErr = GDALDatasetRasterIO(
+        psJob->hDS, GF_Read, 0, psJob->iStartLine, psJob->nXSize,
+        psJob->nLines, psJob->pabyChunk, psJob->nXSize, psJob->nLines,
+        GDT_Byte, psJob->nBands, nullptr, psJob->nDstBands,
+        static_cast<GSpacing>(psJob->nXSize) * psJob->nDstBands, 1);
+}
+
 /************************************************************************/
 /*                   GDALNearblackTwoPassesAlgorithm()                  */
 /*                                                                      */
@@ -355,84 +387,161 @@ bool GDALNearblackTwoPassesAlgorithm(const GDALNearblackOptions *psOptions,
     const bool bSetAlpha = psOptions->bSetAlpha;
 
     /* -------------------------------------------------------------------- */
-    /*      Allocate a line buffer.                                         */
+    /*      Lines are read and written by chunks of at least a block        */
+    /*      height, within a memory budget.                                 */
     /* -------------------------------------------------------------------- */
+    const size_t nLineSize = static_cast<size_t>(nXSize) * nDstBands;
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    GDALGetBlockSize(GDALGetRasterBand(hSrcDataset, 1), &nBlockXSize,
+                     &nBlockYSize);
+    constexpr size_t CHUNK_MAX_SIZE = 16 * 1024 * 1024;
+    const int nChunkYSize = static_cast<int>(std::max<size_t>(
+        1, std::min<size_t>(
+               {static_cast<size_t>(nYSize),
+                static_cast<size_t>(std::max(nBlockYSize, 64)),
+                CHUNK_MAX_SIZE / std::max<size_t>(1, nLineSize)})));
 
-    std::vector<GByte> abyLine(static_cast<size_t>(nXSize) * nDstBands);
-    GByte *pabyLine = abyLine.data();
+    /* -------------------------------------------------------------------- */
+    /*      Allocate chunk buffers.                                         */
+    /* -------------------------------------------------------------------- */
+    std::vector<GByte> abyChunk(nLineSize * nChunkYSize);
 
-    std::vector<GByte> abyMask;
-    GByte *pabyMask = nullptr;
+    std::vector<GByte> abyMaskChunk;
     if (bSetMask)
-    {
-        abyMask.resize(nXSize);
-        pabyMask = abyMask.data();
-    }
+        abyMaskChunk.resize(static_cast<size_t>(nXSize) * nChunkYSize);
 
     std::vector<int> anLastLineCounts(nXSize);
     int *panLastLineCounts = anLastLineCounts.data();
 
     /* -------------------------------------------------------------------- */
-    /*      Processing data one line at a time.                             */
+    /*      When several threads are allowed, the next chunk of the source  */
+    /*      is read while the current one is processed.                     */
     /* -------------------------------------------------------------------- */
-    int iLine;
-
-    for (iLine = 0; iLine < nYSize; iLine++)
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                                       ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+    std::vector<GByte> abyNextChunk;
+    NearblackReadJob sReadJob;
+    sReadJob.hDS = hSrcDataset;
+    sReadJob.nXSize = nXSize;
+    sReadJob.nBands = nBands;
+    sReadJob.nDstBands = nDstBands;
+    // Declared after the buffers it uses, so that pending reads are waited
+    // for before they are freed.
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    // Not possible on in-place updates, as a dataset cannot be accessed
+    // concurrently from several threads.
+    if (nThreads > 1 && nYSize > nChunkYSize && hDstDS != hSrcDataset)
     {
-        CPLErr eErr = GDALDatasetRasterIO(
-            hSrcDataset, GF_Read, 0, iLine, nXSize, 1, pabyLine, nXSize, 1,
-            GDT_Byte, nBands, nullptr, nDstBands, nXSize * nDstBands, 1);
-        if (eErr != CE_None)
+        if (auto poThreadPool = GDALGetGlobalThreadPool(nThreads))
         {
-            return false;
+            poJobQueue = poThreadPool->CreateJobQueue();
+            abyNextChunk.resize(abyChunk.size());
         }
+    }
 
-        if (bSetAlpha)
+    /* -------------------------------------------------------------------- */
+    /*      Processing data one line at a time.                             */
+    /* -------------------------------------------------------------------- */
+    for (int iStartLine = 0; iStartLine < nYSize; iStartLine += nChunkYSize)
+    {
+        const int nLines = std::min(nChunkYSize, nYSize - iStartLine);
+        if (poJobQueue)
         {
-            for (int iCol = 0; iCol < nXSize; iCol++)
+            if (iStartLine == 0)
             {
-                pabyLine[iCol * nDstBands + nDstBands - 1] = 255;
+                sReadJob.iStartLine = iStartLine;
+                sReadJob.nLines = nLines;
+                sReadJob.pabyChunk = abyNextChunk.data();
+                NearblackReadChunk(&sReadJob);
             }
+            else
+            {
+                poJobQueue->WaitCompletion();
+            }
+            std::swap(abyChunk, abyNextChunk);
+            if (sReadJob.eErr != CE_None)
+                return false;
+
+            if (iStartLine + nLines < nYSize)
+            {
+                sReadJob.iStartLine = iStartLine + nLines;
+                sReadJob.nLines =
+                    std::min(nChunkYSize, nYSize - sReadJob.iStartLine);
+                sReadJob.pabyChunk = abyNextChunk.data();
+                if (!poJobQueue->SubmitJob(NearblackReadChunk, &sReadJob))
+                    NearblackReadChunk(&sReadJob);
+            }
+        }
+        else
+        {
+            sReadJob.iStartLine = iStartLine;
+            sReadJob.nLines = nLines;
+            sReadJob.pabyChunk = abyChunk.data();
+            NearblackReadChunk(&sReadJob);
+            if (sReadJob.eErr != CE_None)
+                return false;
         }
 
-        if (bSetMask)
+        for (int i = 0; i < nLines; i++)
         {
-            for (int iCol = 0; iCol < nXSize; iCol++)
+            const int iLine = iStartLine + i;
+            GByte *pabyLine = abyChunk.data() + i * nLineSize;
+            GByte *pabyMask =
+                bSetMask ? abyMaskChunk.data() + static_cast<size_t>(i) * nXSize
+                         : nullptr;
+
+            if (bSetAlpha)
+            {
+                for (int iCol = 0; iCol < nXSize; iCol++)
+                {
+                    pabyLine[iCol * nDstBands + nDstBands - 1] = 255;
+                }
+            }
+
+            if (bSetMask)
             {
-                pabyMask[iCol] = 255;
+                for (int iCol = 0; iCol < nXSize; iCol++)
+                {
+                    pabyMask[iCol] = 255;
+                }
             }
+
+            ProcessLine(pabyLine, pabyMask, 0, nXSize - 1, nBands, nDstBands,
+                        nNearDist, nMaxNonBlack, bNearWhite, oColors,
+                        panLastLineCounts,
+                        true,   // bDoHorizontalCheck
+                        true,   // bDoVerticalCheck
+                        false,  // bBottomUp
+                        iLine);
+            ProcessLine(pabyLine, pabyMask, nXSize - 1, 0, nBands, nDstBands,
+                        nNearDist, nMaxNonBlack, bNearWhite, oColors,
+                        panLastLineCounts,
+                        true,   // bDoHorizontalCheck
+                        false,  // bDoVerticalCheck
+                        false,  // bBottomUp
+                        iLine);
         }
 
-        ProcessLine(pabyLine, pabyMask, 0, nXSize - 1, nBands, nDstBands,
-                    nNearDist, nMaxNonBlack, bNearWhite, oColors,
-                    panLastLineCounts,
-                    true,   // bDoHorizontalCheck
-                    true,   // bDoVerticalCheck
-                    false,  // bBottomUp
-                    iLine);
-        ProcessLine(pabyLine, pabyMask, nXSize - 1, 0, nBands, nDstBands,
-                    nNearDist, nMaxNonBlack, bNearWhite, oColors,
-                    panLastLineCounts,
-                    true,   // bDoHorizontalCheck
-                    false,  // bDoVerticalCheck
-                    false,  // bBottomUp
-                    iLine);
-
-        eErr = GDALDatasetRasterIO(hDstDS, GF_Write, 0, iLine, nXSize, 1,
-                                   pabyLine, nXSize, 1, GDT_Byte, nDstBands,
-                                   nullptr, nDstBands, nXSize * nDstBands, 1);
+        CPLErr eErr = GDALDatasetRasterIO(
+            hDstDS, GF_Write, 0, iStartLine, nXSize, nLines, abyChunk.data(),
+            nXSize, nLines, GDT_Byte, nDstBands, nullptr, nDstBands,
+            static_cast<GSpacing>(nLineSize), 1);
 
         if (eErr != CE_None)
         {
             return false;
         }
 
-        /***** write out the mask band line *****/
+        /***** write out the mask band lines *****/
 
         if (bSetMask)
         {
-            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iLine, nXSize, 1,
-                                pabyMask, nXSize, 1, GDT_Byte, 0, 0);
+            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iStartLine, nXSize,
+                                nLines, abyMaskChunk.data(), nXSize, nLines,
+                                GDT_Byte, 0, 0);
             if (eErr != CE_None)
             {
                 CPLError(CE_Warning, CPLE_AppDefined,
@@ -442,8 +551,8 @@ bool GDALNearblackTwoPassesAlgorithm(const GDALNearblackOptions *psOptions,
         }
 
         if (!(psOptions->pfnProgress(
-                0.5 * ((iLine + 1) / static_cast<double>(nYSize)), nullptr,
-                psOptions->pProgressData)))
+                0.5 * ((iStartLine + nLines) / static_cast<double>(nYSize)),
+                nullptr, psOptions->pProgressData)))
         {
             return false;
         }
@@ -454,64 +563,81 @@ bool GDALNearblackTwoPassesAlgorithm(const GDALNearblackOptions *psOptions,
     /* -------------------------------------------------------------------- */
     memset(panLastLineCounts, 0, sizeof(int) * nXSize);
 
-    for (iLine = nYSize - 1; hDstDS != nullptr && iLine >= 0; iLine--)
+    for (int iEndLine = nYSize; hDstDS != nullptr && iEndLine > 0;
+         iEndLine -= nChunkYSize)
     {
+        const int nLines = std::min(nChunkYSize, iEndLine);
+        const int iStartLine = iEndLine - nLines;
+
         CPLErr eErr = GDALDatasetRasterIO(
-            hDstDS, GF_Read, 0, iLine, nXSize, 1, pabyLine, nXSize, 1, GDT_Byte,
-            nDstBands, nullptr, nDstBands, nXSize * nDstBands, 1);
+            hDstDS, GF_Read, 0, iStartLine, nXSize, nLines, abyChunk.data(),
+            nXSize, nLines, GDT_Byte, nDstBands, nullptr, nDstBands,
+            static_cast<GSpacing>(nLineSize), 1);
         if (eErr != CE_None)
         {
             return false;
         }
 
-        /***** read the mask band line back in *****/
+        /***** read the mask band lines back in *****/
 
         if (bSetMask)
         {
-            eErr = GDALRasterIO(hMaskBand, GF_Read, 0, iLine, nXSize, 1,
-                                pabyMask, nXSize, 1, GDT_Byte, 0, 0);
+            eErr = GDALRasterIO(hMaskBand, GF_Read, 0, iStartLine, nXSize,
+                                nLines, abyMaskChunk.data(), nXSize, nLines,
+                                GDT_Byte, 0, 0);
             if (eErr != CE_None)
             {
                 return false;
             }
         }
 
-        ProcessLine(pabyLine, pabyMask, 0, nXSize - 1, nBands, nDstBands,
-                    nNearDist, nMaxNonBlack, bNearWhite, oColors,
-                    panLastLineCounts,
-                    true,  // bDoHorizontalCheck
-                    true,  // bDoVerticalCheck
-                    true,  // bBottomUp
-                    nYSize - 1 - iLine);
-        ProcessLine(pabyLine, pabyMask, nXSize - 1, 0, nBands, nDstBands,
-                    nNearDist, nMaxNonBlack, bNearWhite, oColors,
-                    panLastLineCounts,
-                    true,   // bDoHorizontalCheck
-                    false,  // bDoVerticalCheck
-                    true,   // bBottomUp
-                    nYSize - 1 - iLine);
-
-        eErr = GDALDatasetRasterIO(hDstDS, GF_Write, 0, iLine, nXSize, 1,
-                                   pabyLine, nXSize, 1, GDT_Byte, nDstBands,
-                                   nullptr, nDstBands, nXSize * nDstBands, 1);
+        for (int i = nLines - 1; i >= 0; i--)
+        {
+            const int iLine = iStartLine + i;
+            GByte *pabyLine = abyChunk.data() + i * nLineSize;
+            GByte *pabyMask =
+                bSetMask ? abyMaskChunk.data() + static_cast<size_t>(i) * nXSize
+                         : nullptr;
+
+            ProcessLine(pabyLine, pabyMask, 0, nXSize - 1, nBands, nDstBands,
+                        nNearDist, nMaxNonBlack, bNearWhite, oColors,
+                        panLastLineCounts,
+                        true,  // bDoHorizontalCheck
+                        true,  // bDoVerticalCheck
+                        true,  // bBottomUp
+                        nYSize - 1 - iLine);
+            ProcessLine(pabyLine, pabyMask, nXSize - 1, 0, nBands, nDstBands,
+                        nNearDist, nMaxNonBlack, bNearWhite, oColors,
+                        panLastLineCounts,
+                        true,   // bDoHorizontalCheck
+                        false,  // bDoVerticalCheck
+                        true,   // bBottomUp
+                        nYSize - 1 - iLine);
+        }
+
+        eErr = GDALDatasetRasterIO(hDstDS, GF_Write, 0, iStartLine, nXSize,
+                                   nLines, abyChunk.data(), nXSize, nLines,
+                                   GDT_Byte, nDstBands, nullptr, nDstBands,
+                                   static_cast<GSpacing>(nLineSize), 1);
         if (eErr != CE_None)
         {
             return false;
         }
 
-        /***** write out the mask band line *****/
+        /***** write out the mask band lines *****/
 
         if (bSetMask)
         {
-            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iLine, nXSize, 1,
-                                pabyMask, nXSize, 1, GDT_Byte, 0, 0);
+            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iStartLine, nXSize,
+                                nLines, abyMaskChunk.data(), nXSize, nLines,
+                                GDT_Byte, 0, 0);
             if (eErr != CE_None)
             {
                 return false;
             }
         }
 
-        if (!(psOptions->pfnProgress(0.5 + 0.5 * (nYSize - iLine) /
+        if (!(psOptions->pfnProgress(0.5 + 0.5 * (nYSize - iStartLine) /
                                                static_cast<double>(nYSize),
                                      nullptr, psOptions->pProgressData)))
         {
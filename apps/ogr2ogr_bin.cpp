@@ -104,7 +104,7 @@ static void Usage(bool bIsError, const char *pszAdditionalMsg = nullptr,
         "               [-clipdstwhere <expression>]\n"
         "               [-wrapdateline][-datelineoffset <val>]\n"
         "               [[-simplify <tolerance>] | [-segmentize <max_dist>]]\n"
-        "               [-makevalid]\n"
+        "               [-makevalid] [-multithread]\n"
         "               [-addfields] [-unsetFid] [-emptyStrAsNull]\n"
         "               [-relaxedFieldNameMatch] [-forceNullable] "
         "[-unsetDefault]\n"
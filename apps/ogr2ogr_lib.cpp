@@ -39,26 +39,32 @@
 #include <cstring>
 
 #include <algorithm>
+#include <condition_variable>
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <unordered_set>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "commonutils.h"
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_time.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "gdal_alg_priv.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -67,6 +73,7 @@
 #include "ogr_p.h"
 #include "ogr_recordbatch.h"
 #include "ogr_spatialref.h"
+#include "ogrlayerarrow.h"
 #include "ogrlayerdecorator.h"
 #include "ogrsf_frmts.h"
 
@@ -272,6 +279,10 @@ struct GDALVectorTranslateOptions
     /*! Whether to run MakeValid */
     bool bMakeValid = false;
 
+    /*! Whether to read, process geometries and write features in separate
+       threads (when not using the Arrow interface) */
+    bool bMultiThread = false;
+
     /*! list of field types to convert to a field of type string in the
        destination layer. Valid types are: Integer, Integer64, Real, String,
        Date, Time, DateTime, Binary, IntegerList, Integer64List, RealList,
@@ -537,11 +548,23 @@ class SetupTargetLayer
 
 class LayerTranslator
 {
-    static bool TranslateArrow(const TargetLayerInfo *psInfo,
-                               GIntBig nCountLayerFeatures,
-                               GIntBig *pnReadFeatureCount,
-                               GDALProgressFunc pfnProgress, void *pProgressArg,
-                               const GDALVectorTranslateOptions *psOptions);
+    friend class MultiThreadedFeaturePipeline;
+
+    bool TranslateArrow(TargetLayerInfo *psInfo, GIntBig nCountLayerFeatures,
+                        GIntBig *pnReadFeatureCount,
+                        GDALProgressFunc pfnProgress, void *pProgressArg,
+                        const GDALVectorTranslateOptions *psOptions);
+
+    bool NeedsGeometryProcessing() const;
+
+    template <class OffsetType>
+    bool TransformArrowGeometryColumn(TargetLayerInfo *psInfo, int iDstGeom,
+                                      const OGRSpatialReference *poSrcSRS,
+                                      const OGRSpatialReference *poOutputSRS,
+                                      size_t nParentOffset, size_t nLength,
+                                      GIntBig nFirstRowIdx,
+                                      struct ArrowArray *psArray,
+                                      std::vector<bool> &abyRowsToKeep);
 
   public:
     GDALDataset *m_poSrcDS = nullptr;
@@ -581,6 +604,13 @@ class LayerTranslator
   private:
     const OGRGeometry *GetDstClipGeom(const OGRSpatialReference *poGeomSRS);
     const OGRGeometry *GetSrcClipGeom(const OGRSpatialReference *poGeomSRS);
+    const OGRSpatialReference *
+    GetOutputSRS(const TargetLayerInfo *psInfo) const;
+    bool TransformGeometry(TargetLayerInfo *psInfo, int iGeom,
+                           GIntBig nSrcFID,
+                           const OGRSpatialReference *poOutputSRS,
+                           OGRGeometry *&poDstGeometry,
+                           bool &bReprojectionFailed);
 };
 
 static OGRLayer *GetLayerAndOverwriteIfNecessary(GDALDataset *poDstDS,
@@ -3856,6 +3886,53 @@ bool SetupTargetLayer::CanUseWriteArrowBatch(
     // OGR2OGR_USE_ARROW_API config option is mostly for testing purposes
     // or as a safety belt if things turned bad...
     bool bUseWriteArrowBatch = false;
+
+    // Geometry operations (reprojection, clipping, -nlt, -dim, -makevalid,
+    // etc.) are applied by LayerTranslator::TranslateArrow() on the WKB
+    // column, but the source SRS must be known beforehand.
+    bool bSourceSRSKnown = true;
+    if (psOptions->bTransform && psOptions->osSourceSRSDef.empty())
+    {
+        const auto poSrcFDefn = poSrcLayer->GetLayerDefn();
+        for (int i = 0; i < poSrcFDefn->GetGeomFieldCount(); ++i)
+        {
+            if (poSrcFDefn->GetGeomFieldDefn(i)->GetSpatialRef() == nullptr)
+                bSourceSRSKnown = false;
+        }
+    }
+
+    // -select is handled by ignoring the non-selected fields of the source
+    // layer, provided that the selected fields are in their source order
+    // (as output fields are created in the order of the Arrow schema).
+    bool bSelFieldsCompatible = true;
+    CPLStringList aosIgnoredFields;
+    if (m_bSelFieldsSet)
+    {
+        bSelFieldsCompatible = !m_bAppend && !m_pszWHERE &&
+                               poSrcLayer->TestCapability(OLCIgnoreFields);
+        const auto poSrcFDefn = poSrcLayer->GetLayerDefn();
+        int iLastSrcField = -1;
+        for (int i = 0;
+             bSelFieldsCompatible && m_papszSelFields && m_papszSelFields[i];
+             ++i)
+        {
+            const int iSrcField =
+                poSrcFDefn->GetFieldIndex(m_papszSelFields[i]);
+            if (iSrcField <= iLastSrcField)
+                bSelFieldsCompatible = false;
+            iLastSrcField = iSrcField;
+        }
+        for (int iSrcField = 0;
+             bSelFieldsCompatible && iSrcField < poSrcFDefn->GetFieldCount();
+             ++iSrcField)
+        {
+            const char *pszFieldName =
+                poSrcFDefn->GetFieldDefn(iSrcField)->GetNameRef();
+            if (CSLFindString(m_papszSelFields, pszFieldName) < 0)
+                aosIgnoredFields.AddString(pszFieldName);
+        }
+    }
+
     if (((poSrcLayer->TestCapability(OLCFastGetArrowStream) &&
           // As we don't control the input array size when the input or output
           // drivers are Arrow/Parquet (as they don't use the generic
@@ -3865,18 +3942,20 @@ bool SetupTargetLayer::CanUseWriteArrowBatch(
           !psOptions->aosLCO.FetchNameValue("BATCH_SIZE") &&
           CPLTestBool(CPLGetConfigOption("OGR2OGR_USE_ARROW_API", "YES"))) ||
          CPLTestBool(CPLGetConfigOption("OGR2OGR_USE_ARROW_API", "NO"))) &&
-        !psOptions->bSkipFailures && !psOptions->bTransform &&
-        !psOptions->poClipSrc && !psOptions->poClipDst &&
+        !psOptions->bSkipFailures && bSourceSRSKnown &&
         psOptions->oGCPs.nGCPCount == 0 && !psOptions->bWrapDateline &&
-        !m_papszSelFields && !m_bAddMissingFields &&
-        m_eGType == GEOMTYPE_UNCHANGED && psOptions->eGeomOp == GEOMOP_NONE &&
-        m_eGeomTypeConversion == GTC_DEFAULT && m_nCoordDim < 0 &&
+        bSelFieldsCompatible && !m_bAddMissingFields && m_eGType != wkbNone &&
         !m_papszFieldTypesToString && !m_papszMapFieldType &&
         !m_bUnsetFieldWidth && !m_bExplodeCollections && !m_pszZField &&
         m_bExactFieldNameMatch && !m_bForceNullable && !m_bResolveDomains &&
-        !m_bUnsetDefault && psOptions->nFIDToFetch == OGRNullFID &&
-        !psOptions->bMakeValid)
+        !m_bUnsetDefault && psOptions->nFIDToFetch == OGRNullFID)
     {
+        if (m_bSelFieldsSet)
+        {
+            poSrcLayer->SetIgnoredFields(
+                const_cast<const char **>(aosIgnoredFields.List()));
+        }
+
         struct ArrowArrayStream streamSrc;
         if (poSrcLayer->GetArrowStream(&streamSrc, nullptr))
         {
@@ -4006,6 +4085,10 @@ bool SetupTargetLayer::CanUseWriteArrowBatch(
             }
             streamSrc.release(&streamSrc);
         }
+
+        // The regular code path will set the ignored fields itself
+        if (m_bSelFieldsSet && !bUseWriteArrowBatch)
+            poSrcLayer->SetIgnoredFields(nullptr);
     }
     return bUseWriteArrowBatch;
 }
@@ -5447,12 +5530,155 @@ SetupCT(TargetLayerInfo *psInfo, OGRLayer *poSrcLayer, bool bTransform,
     return true;
 }
 
+/************************************************************************/
+/*                    ArrowBinaryArrayPrivateData                       */
+/************************************************************************/
+
+namespace
+{
+template <class OffsetType> struct ArrowBinaryArrayPrivateData
+{
+    std::vector<uint8_t> abyValidity{};
+    std::vector<OffsetType> anOffsets{};
+    std::vector<GByte> abyData{};
+    const void *apBuffers[3] = {nullptr, nullptr, nullptr};
+
+    static void Release(struct ArrowArray *array)
+    {
+        delete static_cast<ArrowBinaryArrayPrivateData *>(array->private_data);
+        array->private_data = nullptr;
+        array->release = nullptr;
+    }
+};
+}  // namespace
+
+/************************************************************************/
+/*              LayerTranslator::NeedsGeometryProcessing()              */
+/************************************************************************/
+
+bool LayerTranslator::NeedsGeometryProcessing() const
+{
+    return m_bTransform || m_nCoordDim != COORD_DIM_UNCHANGED ||
+           m_eGeomOp != GEOMOP_NONE || m_poClipSrcOri != nullptr ||
+           m_poClipDstOri != nullptr || m_bMakeValid ||
+           m_eGeomTypeConversion != GTC_DEFAULT ||
+           m_eGType != GEOMTYPE_UNCHANGED;
+}
+
+/************************************************************************/
+/*           LayerTranslator::TransformArrowGeometryColumn()            */
+/************************************************************************/
+
+/* Replace psArray, a WKB binary array, by a new array whose geometries have
+ * gone through TransformGeometry(). Rows whose feature must be discarded are
+ * set to false in abyRowsToKeep.
+ */
+template <class OffsetType>
+bool LayerTranslator::TransformArrowGeometryColumn(
+    TargetLayerInfo *psInfo, int iDstGeom,
+    const OGRSpatialReference *poSrcSRS, const OGRSpatialReference *poOutputSRS,
+    size_t nParentOffset, size_t nLength, GIntBig nFirstRowIdx,
+    struct ArrowArray *psArray, std::vector<bool> &abyRowsToKeep)
+{
+    const size_t nOffset = static_cast<size_t>(psArray->offset);
+    const uint8_t *pabyValidity =
+        static_cast<const uint8_t *>(psArray->buffers[0]);
+    const OffsetType *panOffsets =
+        static_cast<const OffsetType *>(psArray->buffers[1]) + nOffset;
+    const GByte *pabyData = static_cast<const GByte *>(psArray->buffers[2]);
+
+    auto psPrivate =
+        std::make_unique<ArrowBinaryArrayPrivateData<OffsetType>>();
+    // The first nParentOffset rows are not visible from the parent array:
+    // just write them as nulls.
+    const size_t nTotalLength = nParentOffset + nLength;
+    psPrivate->abyValidity.resize((nTotalLength + 7) / 8, 0);
+    psPrivate->anOffsets.resize(nTotalLength + 1, 0);
+    auto &abyData = psPrivate->abyData;
+    abyData.reserve(1);
+    int64_t nNullCount = static_cast<int64_t>(nParentOffset);
+    for (size_t iRow = 0; iRow < nLength; ++iRow)
+    {
+        const size_t i = nParentOffset + iRow;
+        psPrivate->anOffsets[i] = static_cast<OffsetType>(abyData.size());
+        if (abyRowsToKeep[iRow] &&
+            (pabyValidity == nullptr ||
+             (pabyValidity[(nOffset + i) / 8] & (1 << ((nOffset + i) % 8))) !=
+                 0))
+        {
+            OGRGeometry *poGeom = nullptr;
+            size_t nBytesConsumed = 0;
+            OGRGeometryFactory::createFromWkb(
+                pabyData + panOffsets[i], poSrcSRS, &poGeom,
+                static_cast<size_t>(panOffsets[i + 1] - panOffsets[i]),
+                wkbVariantIso, nBytesConsumed);
+            if (poGeom)
+            {
+                bool bReprojectionFailed = false;
+                if (!TransformGeometry(psInfo, iDstGeom, nFirstRowIdx + iRow,
+                                       poOutputSRS, poGeom,
+                                       bReprojectionFailed))
+                {
+                    abyRowsToKeep[iRow] = false;
+                }
+                else if (bReprojectionFailed)
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "Failed to reproject feature " CPL_FRMT_GIB
+                             " (geometry probably out of source or "
+                             "destination SRS).",
+                             nFirstRowIdx + static_cast<GIntBig>(iRow));
+                    return false;
+                }
+                else if (poGeom)
+                {
+                    const size_t nWKBSize = poGeom->WkbSize();
+                    const size_t nOldSize = abyData.size();
+                    if (sizeof(OffsetType) == sizeof(uint32_t) &&
+                        nWKBSize > static_cast<size_t>(INT_MAX) - nOldSize)
+                    {
+                        CPLError(CE_Failure, CPLE_AppDefined,
+                                 "Too large geometry content in batch");
+                        delete poGeom;
+                        return false;
+                    }
+                    abyData.resize(nOldSize + nWKBSize);
+                    poGeom->exportToWkb(wkbNDR, abyData.data() + nOldSize,
+                                        wkbVariantIso);
+                    delete poGeom;
+                    psPrivate->abyValidity[i / 8] |=
+                        static_cast<uint8_t>(1 << (i % 8));
+                    continue;
+                }
+            }
+        }
+        ++nNullCount;
+    }
+    psPrivate->anOffsets[nTotalLength] =
+        static_cast<OffsetType>(abyData.size());
+
+    psPrivate->apBuffers[0] =
+        nNullCount ? psPrivate->abyValidity.data() : nullptr;
+    psPrivate->apBuffers[1] = psPrivate->anOffsets.data();
+    psPrivate->apBuffers[2] = abyData.data();
+
+    psArray->release(psArray);
+    memset(psArray, 0, sizeof(*psArray));
+    psArray->length = static_cast<int64_t>(nTotalLength);
+    psArray->null_count = nNullCount;
+    psArray->n_buffers = 3;
+    psArray->buffers = psPrivate->apBuffers;
+    psArray->release = ArrowBinaryArrayPrivateData<OffsetType>::Release;
+    psArray->private_data = psPrivate.release();
+    return true;
+}
+
 /************************************************************************/
 /*                 LayerTranslator::TranslateArrow()                    */
 /************************************************************************/
 
 bool LayerTranslator::TranslateArrow(
-    const TargetLayerInfo *psInfo, GIntBig nCountLayerFeatures,
+    TargetLayerInfo *psInfo, GIntBig nCountLayerFeatures,
     GIntBig *pnReadFeatureCount, GDALProgressFunc pfnProgress,
     void *pProgressArg, const GDALVectorTranslateOptions *psOptions)
 {
@@ -5486,6 +5712,18 @@ bool LayerTranslator::TranslateArrow(
             "MAX_FEATURES_IN_BATCH",
             CPLSPrintf("%d", psOptions->nGroupTransactions));
     }
+
+    // Must be done before GetArrowStream(), as it may change the active SRS
+    // of the source layer.
+    const OGRSpatialReference *poOutputSRS = GetOutputSRS(psInfo);
+    if (m_bTransform &&
+        !SetupCT(psInfo, psInfo->m_poSrcLayer, m_bTransform, m_bWrapDateline,
+                 m_osDateLineOffset, m_poUserSourceSRS, nullptr, poOutputSRS,
+                 m_poGCPCoordTrans, true))
+    {
+        return false;
+    }
+
     if (psInfo->m_poSrcLayer->GetArrowStream(&stream,
                                              aosOptionsGetArrowStream.List()))
     {
@@ -5502,6 +5740,56 @@ bool LayerTranslator::TranslateArrow(
         return false;
     }
 
+    // Collect the WKB geometry columns that must go through
+    // TransformGeometry()
+    struct GeomColumn
+    {
+        int iArrowField;
+        int iDstGeom;
+        const OGRSpatialReference *poSrcSRS;
+    };
+
+    std::vector<GeomColumn> asGeomColumns;
+    if (NeedsGeometryProcessing())
+    {
+        const auto poSrcFDefn = psInfo->m_poSrcLayer->GetLayerDefn();
+        const auto poDstFDefn = psInfo->m_poDstLayer->GetLayerDefn();
+        for (int i = 0; i < static_cast<int>(schema.n_children); ++i)
+        {
+            const char *pszName = schema.children[i]->name;
+            int iSrcGeom = poSrcFDefn->GetGeomFieldIndex(pszName);
+            if (iSrcGeom < 0 && poSrcFDefn->GetGeomFieldCount() == 1 &&
+                strcmp(pszName, OGRLayer::DEFAULT_ARROW_GEOMETRY_NAME) == 0)
+            {
+                iSrcGeom = 0;
+            }
+            if (iSrcGeom < 0)
+                continue;
+            const int iDstGeom =
+                poDstFDefn->GetGeomFieldCount() ==
+                        poSrcFDefn->GetGeomFieldCount()
+                    ? iSrcGeom
+                    : poDstFDefn->GetGeomFieldIndex(pszName);
+            if (iDstGeom < 0)
+                continue;
+            const char *pszFormat = schema.children[i]->format;
+            if (strcmp(pszFormat, "z") != 0 && strcmp(pszFormat, "Z") != 0)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Unexpected Arrow format '%s' for geometry column %s",
+                         pszFormat, pszName);
+                schema.release(&schema);
+                stream.release(&stream);
+                return false;
+            }
+            asGeomColumns.push_back(
+                {i, iDstGeom,
+                 m_poUserSourceSRS ? m_poUserSourceSRS
+                                   : poSrcFDefn->GetGeomFieldDefn(iSrcGeom)
+                                         ->GetSpatialRef()});
+        }
+    }
+
     bool bRet = true;
 
     GIntBig nCount = 0;
@@ -5523,6 +5811,8 @@ bool LayerTranslator::TranslateArrow(
             break;
         }
 
+        const GIntBig nFirstRowIdx = nCount;
+
         // Limit number of features in batch if needed
         if (psOptions->nLimit >= 0 && nCount + array.length > psOptions->nLimit)
         {
@@ -5541,8 +5831,46 @@ bool LayerTranslator::TranslateArrow(
             nCount += array.length;
         }
 
+        // Transform geometries, and remove the features that must be
+        // discarded
+        if (!asGeomColumns.empty())
+        {
+            const size_t nParentOffset = static_cast<size_t>(array.offset);
+            const size_t nLength = static_cast<size_t>(array.length);
+            std::vector<bool> abyRowsToKeep(nLength, true);
+            bool bOK = true;
+            for (const auto &sGeomColumn : asGeomColumns)
+            {
+                auto psChildArray = array.children[sGeomColumn.iArrowField];
+                if (schema.children[sGeomColumn.iArrowField]->format[0] == 'z')
+                {
+                    bOK = TransformArrowGeometryColumn<uint32_t>(
+                        psInfo, sGeomColumn.iDstGeom, sGeomColumn.poSrcSRS,
+                        poOutputSRS, nParentOffset, nLength, nFirstRowIdx,
+                        psChildArray, abyRowsToKeep);
+                }
+                else
+                {
+                    bOK = TransformArrowGeometryColumn<uint64_t>(
+                        psInfo, sGeomColumn.iDstGeom, sGeomColumn.poSrcSRS,
+                        poOutputSRS, nParentOffset, nLength, nFirstRowIdx,
+                        psChildArray, abyRowsToKeep);
+                }
+                if (!bOK)
+                    break;
+            }
+            if (!bOK || !OGRCompactArrowArray(&schema, &array, abyRowsToKeep))
+            {
+                if (array.release)
+                    array.release(&array);
+                bRet = false;
+                break;
+            }
+        }
+
         // Write batch to target layer
-        if (!psInfo->m_poDstLayer->WriteArrowBatch(
+        if (array.length > 0 &&
+            !psInfo->m_poDstLayer->WriteArrowBatch(
                 &schema, &array, aosOptionsWriteArrowBatch.List()))
         {
             CPLError(CE_Failure, CPLE_AppDefined, "WriteArrowBatch() failed");
@@ -5577,6 +5905,386 @@ bool LayerTranslator::TranslateArrow(
     return bRet;
 }
 
+/************************************************************************/
+/*                           GetNumThreads()                            */
+/************************************************************************/
+
+// Number of geometry processing threads used by -multithread: all CPUs,
+// unless GDAL_NUM_THREADS is set.
+static int GetNumThreads()
+{
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "ALL_CPUS");
+    return std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                         ? CPLGetNumCPUs()
+                                         : atoi(pszThreads)));
+}
+
+/************************************************************************/
+/*                    MultiThreadedFeaturePipeline                      */
+/************************************************************************/
+
+/* Feature pipeline used by -multithread.
+ *
+ * A dedicated thread reads the features of the source layer by batches.
+ * The geometries of each batch then go through
+ * LayerTranslator::TransformGeometry() in a job of the global thread pool,
+ * using one of nWorkers contexts, each owning its copy of the coordinate
+ * transformations and of the translator state.
+ * The calling thread gets the features back in their reading order with
+ * GetNextFeature(), and writes them.
+ * The number of batches in flight is bounded, so that a slow writer does not
+ * cause the source layer to be fully loaded in memory.
+ */
+class MultiThreadedFeaturePipeline
+{
+  public:
+    struct Feature
+    {
+        std::unique_ptr<OGRFeature> poFeature{};
+        bool bDiscard = false;
+        bool bReprojectionFailed = false;
+    };
+
+    MultiThreadedFeaturePipeline(const LayerTranslator *poTranslator,
+                                 const TargetLayerInfo *psInfo,
+                                 const OGRSpatialReference *poOutputSRS,
+                                 std::vector<int> &&anDstToSrcGeom)
+        : m_poTranslator(poTranslator), m_psInfo(psInfo),
+          m_poOutputSRS(poOutputSRS),
+          m_anDstToSrcGeom(std::move(anDstToSrcGeom))
+    {
+    }
+
+    ~MultiThreadedFeaturePipeline();
+
+    bool Start(int nWorkers, GIntBig nMaxFeatures);
+    bool GetNextFeature(Feature &sFeature);
+
+    bool ReadErrorOccurred() const
+    {
+        return m_bReadError;
+    }
+
+  private:
+    CPL_DISALLOW_COPY_ASSIGN(MultiThreadedFeaturePipeline)
+
+    static constexpr size_t BATCH_SIZE = 256;
+
+    struct Batch
+    {
+        std::vector<Feature> asFeatures{};
+        std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+    };
+
+    struct WorkerContext
+    {
+        std::unique_ptr<LayerTranslator> poTranslator{};
+        TargetLayerInfo sInfo{};
+    };
+
+    struct Job
+    {
+        MultiThreadedFeaturePipeline *poPipeline = nullptr;
+        int nSeq = 0;
+        std::unique_ptr<Batch> poBatch{};
+    };
+
+    const LayerTranslator *const m_poTranslator;
+    const TargetLayerInfo *const m_psInfo;
+    const OGRSpatialReference *const m_poOutputSRS;
+    const std::vector<int> m_anDstToSrcGeom;
+    GIntBig m_nMaxFeatures = -1;
+    size_t m_nMaxBatchesInFlight = 0;
+
+    std::vector<std::unique_ptr<WorkerContext>> m_apoContexts{};
+    std::unique_ptr<CPLJobQueue> m_poJobQueue{};
+    std::thread m_oReaderThread{};
+
+    // Members below are protected by m_oMutex
+    std::mutex m_oMutex{};
+    std::condition_variable m_oCV{};
+    std::vector<WorkerContext *> m_apoFreeContexts{};
+    std::map<int, std::unique_ptr<Batch>> m_oMapProcessedBatches{};
+    int m_nNextBatchToConsume = 0;
+    int m_nBatchCount = 0;
+    bool m_bReaderFinished = false;
+    bool m_bReadError = false;
+    bool m_bStop = false;
+
+    // Only used by the consuming thread
+    std::unique_ptr<Batch> m_poCurBatch{};
+    size_t m_iNextFeatureInCurBatch = 0;
+
+    void ReadLoop();
+    void ProcessBatch(int nSeq, std::unique_ptr<Batch> poBatch);
+    static void ProcessBatchJobFunc(void *pData);
+};
+
+/************************************************************************/
+/*                  ~MultiThreadedFeaturePipeline()                     */
+/************************************************************************/
+
+MultiThreadedFeaturePipeline::~MultiThreadedFeaturePipeline()
+{
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_bStop = true;
+    }
+    m_oCV.notify_all();
+    if (m_oReaderThread.joinable())
+        m_oReaderThread.join();
+    if (m_poJobQueue)
+        m_poJobQueue->WaitCompletion();
+}
+
+/************************************************************************/
+/*                 MultiThreadedFeaturePipeline::Start()                */
+/************************************************************************/
+
+bool MultiThreadedFeaturePipeline::Start(int nWorkers, GIntBig nMaxFeatures)
+{
+    for (int i = 0; i < nWorkers; ++i)
+    {
+        auto poCtxt = std::make_unique<WorkerContext>();
+
+        // Copy the settings used by TransformGeometry(). Clipping geometries
+        // reprojected to the geometry SRS are cached per context.
+        auto poTranslator = std::make_unique<LayerTranslator>();
+        poTranslator->m_poOutputSRS = m_poTranslator->m_poOutputSRS;
+        poTranslator->m_bNullifyOutputSRS = m_poTranslator->m_bNullifyOutputSRS;
+        poTranslator->m_eGType = m_poTranslator->m_eGType;
+        poTranslator->m_eGeomTypeConversion =
+            m_poTranslator->m_eGeomTypeConversion;
+        poTranslator->m_bMakeValid = m_poTranslator->m_bMakeValid;
+        poTranslator->m_nCoordDim = m_poTranslator->m_nCoordDim;
+        poTranslator->m_eGeomOp = m_poTranslator->m_eGeomOp;
+        poTranslator->m_dfGeomOpParam = m_poTranslator->m_dfGeomOpParam;
+        poTranslator->m_poClipSrcOri = m_poTranslator->m_poClipSrcOri;
+        poTranslator->m_bWarnedClipSrcSRS = m_poTranslator->m_bWarnedClipSrcSRS;
+        poTranslator->m_poClipDstOri = m_poTranslator->m_poClipDstOri;
+        poTranslator->m_bWarnedClipDstSRS = m_poTranslator->m_bWarnedClipDstSRS;
+        poCtxt->poTranslator = std::move(poTranslator);
+
+        // Coordinate transformations are not thread-safe
+        auto &sInfo = poCtxt->sInfo;
+        sInfo.m_poSrcLayer = m_psInfo->m_poSrcLayer;
+        sInfo.m_poDstLayer = m_psInfo->m_poDstLayer;
+        sInfo.m_bSupportCurves = m_psInfo->m_bSupportCurves;
+        for (const auto &oSrcReprojInfo : m_psInfo->m_aoReprojectionInfo)
+        {
+            TargetLayerInfo::ReprojectionInfo oReprojInfo;
+            if (oSrcReprojInfo.m_poCT)
+            {
+                oReprojInfo.m_poCT.reset(oSrcReprojInfo.m_poCT->Clone());
+                if (!oReprojInfo.m_poCT)
+                    return false;
+            }
+            oReprojInfo.m_aosTransformOptions =
+                oSrcReprojInfo.m_aosTransformOptions;
+            oReprojInfo.m_bCanInvalidateValidity =
+                oSrcReprojInfo.m_bCanInvalidateValidity;
+            sInfo.m_aoReprojectionInfo.push_back(std::move(oReprojInfo));
+        }
+
+        m_apoFreeContexts.push_back(poCtxt.get());
+        m_apoContexts.push_back(std::move(poCtxt));
+    }
+
+    auto poThreadPool = GDALGetGlobalThreadPool(nWorkers);
+    if (!poThreadPool)
+        return false;
+    m_poJobQueue = poThreadPool->CreateJobQueue();
+
+    m_nMaxFeatures = nMaxFeatures;
+    m_nMaxBatchesInFlight = 2 * static_cast<size_t>(nWorkers) + 2;
+    m_oReaderThread = std::thread([this]() { ReadLoop(); });
+    return true;
+}
+
+/************************************************************************/
+/*               MultiThreadedFeaturePipeline::ReadLoop()               */
+/************************************************************************/
+
+void MultiThreadedFeaturePipeline::ReadLoop()
+{
+    OGRLayer *poSrcLayer = m_psInfo->m_poSrcLayer;
+    GIntBig nFeaturesRead = 0;
+    int nSeq = 0;
+    bool bEOF = false;
+    bool bReadError = false;
+    while (!bEOF)
+    {
+        auto poBatch = std::make_unique<Batch>();
+        CPLInstallErrorHandlerAccumulator(poBatch->aoErrors);
+        CPLErrorReset();
+        while (poBatch->asFeatures.size() < BATCH_SIZE)
+        {
+            if (m_nMaxFeatures >= 0 && nFeaturesRead >= m_nMaxFeatures)
+            {
+                bEOF = true;
+                break;
+            }
+            std::unique_ptr<OGRFeature> poFeature(poSrcLayer->GetNextFeature());
+            if (!poFeature)
+            {
+                bEOF = true;
+                bReadError = CPLGetLastErrorType() == CE_Failure;
+                break;
+            }
+            ++nFeaturesRead;
+            poBatch->asFeatures.emplace_back();
+            poBatch->asFeatures.back().poFeature = std::move(poFeature);
+        }
+        CPLUninstallErrorHandlerAccumulator();
+
+        if (!poBatch->asFeatures.empty() || !poBatch->aoErrors.empty())
+        {
+            {
+                std::unique_lock<std::mutex> oLock(m_oMutex);
+                m_oCV.wait(oLock,
+                           [this, nSeq]
+                           {
+                               return m_bStop ||
+                                      static_cast<size_t>(
+                                          nSeq - m_nNextBatchToConsume) <
+                                          m_nMaxBatchesInFlight;
+                           });
+                if (m_bStop)
+                    return;
+            }
+
+            auto psJob = new Job();
+            psJob->poPipeline = this;
+            psJob->nSeq = nSeq;
+            psJob->poBatch = std::move(poBatch);
+            if (!m_poJobQueue->SubmitJob(ProcessBatchJobFunc, psJob))
+            {
+                // Process it in this thread then
+                ProcessBatchJobFunc(psJob);
+            }
+            ++nSeq;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_nBatchCount = nSeq;
+        m_bReadError = bReadError;
+        m_bReaderFinished = true;
+    }
+    m_oCV.notify_all();
+}
+
+/************************************************************************/
+/*         MultiThreadedFeaturePipeline::ProcessBatchJobFunc()          */
+/************************************************************************/
+
+void MultiThreadedFeaturePipeline::ProcessBatchJobFunc(void *pData)
+{
+    auto psJob = static_cast<Job *>(pData);
+    psJob->poPipeline->ProcessBatch(psJob->nSeq, std::move(psJob->poBatch));
+    delete psJob;
+}
+
+/************************************************************************/
+/*             MultiThreadedFeaturePipeline::ProcessBatch()             */
+/************************************************************************/
+
+void MultiThreadedFeaturePipeline::ProcessBatch(int nSeq,
+                                                std::unique_ptr<Batch> poBatch)
+{
+    WorkerContext *psCtxt = nullptr;
+    {
+        std::unique_lock<std::mutex> oLock(m_oMutex);
+        m_oCV.wait(oLock, [this] { return !m_apoFreeContexts.empty(); });
+        psCtxt = m_apoFreeContexts.back();
+        m_apoFreeContexts.pop_back();
+    }
+
+    // Errors are re-emitted by GetNextFeature() in the consuming thread
+    CPLInstallErrorHandlerAccumulator(poBatch->aoErrors);
+    for (auto &sFeature : poBatch->asFeatures)
+    {
+        OGRFeature *poFeature = sFeature.poFeature.get();
+        for (int iDstGeom = 0;
+             iDstGeom < static_cast<int>(m_anDstToSrcGeom.size()); ++iDstGeom)
+        {
+            const int iSrcGeom = m_anDstToSrcGeom[iDstGeom];
+            if (iSrcGeom < 0)
+                continue;
+            OGRGeometry *poGeom = poFeature->StealGeometry(iSrcGeom);
+            if (poGeom == nullptr)
+                continue;
+            bool bReprojectionFailed = false;
+            if (!psCtxt->poTranslator->TransformGeometry(
+                    &psCtxt->sInfo, iDstGeom, poFeature->GetFID(),
+                    m_poOutputSRS, poGeom, bReprojectionFailed))
+            {
+                sFeature.bDiscard = true;
+                break;
+            }
+            if (bReprojectionFailed)
+                sFeature.bReprojectionFailed = true;
+            poFeature->SetGeomFieldDirectly(iSrcGeom, poGeom);
+        }
+    }
+    CPLUninstallErrorHandlerAccumulator();
+
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_apoFreeContexts.push_back(psCtxt);
+        m_oMapProcessedBatches[nSeq] = std::move(poBatch);
+    }
+    m_oCV.notify_all();
+}
+
+/************************************************************************/
+/*            MultiThreadedFeaturePipeline::GetNextFeature()            */
+/************************************************************************/
+
+bool MultiThreadedFeaturePipeline::GetNextFeature(Feature &sFeature)
+{
+    while (true)
+    {
+        if (m_poCurBatch &&
+            m_iNextFeatureInCurBatch < m_poCurBatch->asFeatures.size())
+        {
+            sFeature =
+                std::move(m_poCurBatch->asFeatures[m_iNextFeatureInCurBatch]);
+            ++m_iNextFeatureInCurBatch;
+            return true;
+        }
+
+        m_poCurBatch.reset();
+        {
+            std::unique_lock<std::mutex> oLock(m_oMutex);
+            m_oCV.wait(oLock,
+                       [this]
+                       {
+                           return m_oMapProcessedBatches.find(
+                                      m_nNextBatchToConsume) !=
+                                      m_oMapProcessedBatches.end() ||
+                                  (m_bReaderFinished &&
+                                   m_nNextBatchToConsume == m_nBatchCount);
+                       });
+            auto oIter = m_oMapProcessedBatches.find(m_nNextBatchToConsume);
+            if (oIter == m_oMapProcessedBatches.end())
+                return false;
+            m_poCurBatch = std::move(oIter->second);
+            m_oMapProcessedBatches.erase(oIter);
+            ++m_nNextBatchToConsume;
+            m_iNextFeatureInCurBatch = 0;
+        }
+        // Wake up the reader thread
+        m_oCV.notify_all();
+
+        for (const auto &sError : m_poCurBatch->aoErrors)
+        {
+            CPLError(sError.type, sError.no, "%s", sError.msg.c_str());
+        }
+    }
+}
+
 /************************************************************************/
 /*                     LayerTranslator::Translate()                     */
 /************************************************************************/
@@ -5593,8 +6301,7 @@ bool LayerTranslator::Translate(
                               pfnProgress, pProgressArg, psOptions);
     }
 
-    const int eGType = m_eGType;
-    const OGRSpatialReference *poOutputSRS = m_poOutputSRS;
+    const OGRSpatialReference *poOutputSRS = GetOutputSRS(psInfo);
 
     OGRLayer *poSrcLayer = psInfo->m_poSrcLayer;
     OGRLayer *poDstLayer = psInfo->m_poDstLayer;
@@ -5609,20 +6316,6 @@ bool LayerTranslator::Translate(
         m_bExplodeCollections && nDstGeomFieldCount <= 1;
     const int iRequestedSrcGeomField = psInfo->m_iRequestedSrcGeomField;
 
-    if (poOutputSRS == nullptr && !m_bNullifyOutputSRS)
-    {
-        if (nSrcGeomFieldCount == 1)
-        {
-            poOutputSRS = poSrcLayer->GetSpatialRef();
-        }
-        else if (iRequestedSrcGeomField > 0)
-        {
-            poOutputSRS = poSrcLayer->GetLayerDefn()
-                              ->GetGeomFieldDefn(iRequestedSrcGeomField)
-                              ->GetSpatialRef();
-        }
-    }
-
     /* -------------------------------------------------------------------- */
     /*      Transfer features.                                              */
     /* -------------------------------------------------------------------- */
@@ -5656,23 +6349,106 @@ bool LayerTranslator::Translate(
                              poOutputSRS, m_poGCPCoordTrans, false);
     }
 
-    while (true)
+    // Returns false if the translation must be stopped
+    const auto HandleReprojectionFailure = [psOptions, poDstLayer](GIntBig nFID)
     {
-        if (m_nLimit >= 0 && psInfo->m_nFeaturesRead >= m_nLimit)
+        if (psOptions->nGroupTransactions && psOptions->nLayerTransaction &&
+            poDstLayer->CommitTransaction() != OGRERR_NONE &&
+            !psOptions->bSkipFailures)
         {
-            break;
+            return false;
         }
 
-        if (poFeatureIn != nullptr)
-            poFeature.reset(poFeatureIn);
-        else if (psOptions->nFIDToFetch != OGRNullFID)
-            poFeature.reset(poSrcLayer->GetFeature(psOptions->nFIDToFetch));
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Failed to reproject feature " CPL_FRMT_GIB
+                 " (geometry probably out of source or destination SRS).",
+                 nFID);
+        return psOptions->bSkipFailures;
+    };
+
+    // With -multithread, features are read and their geometries processed
+    // in other threads. This requires the coordinate transformations to be
+    // known before reading the first feature, and each target geometry
+    // field to be directly derived from a source geometry field.
+    std::unique_ptr<MultiThreadedFeaturePipeline> poPipeline;
+    if (psOptions->bMultiThread && poFeatureIn == nullptr &&
+        psOptions->nFIDToFetch == OGRNullFID && !bExplodeCollections &&
+        iSrcZField < 0 && nDstGeomFieldCount > 0 && m_poSrcDS != m_poODS &&
+        !psInfo->m_bPerFeatureCT &&
+        !(nDstGeomFieldCount > 1 && iRequestedSrcGeomField >= 0))
+    {
+        if (!m_bTransform && psInfo->m_nFeaturesRead == 0)
+        {
+            bSetupCTOK = SetupCT(psInfo, poSrcLayer, m_bTransform,
+                                 m_bWrapDateline, m_osDateLineOffset,
+                                 m_poUserSourceSRS, nullptr, poOutputSRS,
+                                 m_poGCPCoordTrans, false);
+        }
+        if (bSetupCTOK)
+        {
+            // Same mapping as done by OGRFeature::SetFrom() and the stealing
+            // of the source geometry below
+            std::vector<int> anDstToSrcGeom(nDstGeomFieldCount, -1);
+            for (int iGeom = 0; iGeom < nDstGeomFieldCount; ++iGeom)
+            {
+                anDstToSrcGeom[iGeom] = poSrcFDefn->GetGeomFieldIndex(
+                    poDstFDefn->GetGeomFieldDefn(iGeom)->GetNameRef());
+            }
+            if (nDstGeomFieldCount == 1)
+            {
+                if (iRequestedSrcGeomField >= 0)
+                    anDstToSrcGeom[0] = iRequestedSrcGeomField;
+                else if (anDstToSrcGeom[0] < 0 && nSrcGeomFieldCount > 0)
+                    anDstToSrcGeom[0] = 0;
+            }
+
+            const int nWorkers = GetNumThreads();
+            const GIntBig nMaxFeatures =
+                m_nLimit >= 0
+                    ? std::max<GIntBig>(0, m_nLimit - psInfo->m_nFeaturesRead)
+                    : -1;
+            poPipeline = std::make_unique<MultiThreadedFeaturePipeline>(
+                this, psInfo, poOutputSRS, std::move(anDstToSrcGeom));
+            if (poPipeline->Start(nWorkers, nMaxFeatures))
+            {
+                CPLDebug("GDALVectorTranslate",
+                         "Using multi-threaded pipeline with %d workers for "
+                         "layer %s",
+                         nWorkers, poSrcLayer->GetName());
+            }
+            else
+            {
+                poPipeline.reset();
+            }
+        }
+    }
+
+    while (true)
+    {
+        if (m_nLimit >= 0 && psInfo->m_nFeaturesRead >= m_nLimit)
+        {
+            break;
+        }
+
+        MultiThreadedFeaturePipeline::Feature sPipelineFeature;
+        if (poFeatureIn != nullptr)
+            poFeature.reset(poFeatureIn);
+        else if (psOptions->nFIDToFetch != OGRNullFID)
+            poFeature.reset(poSrcLayer->GetFeature(psOptions->nFIDToFetch));
+        else if (poPipeline)
+        {
+            if (poPipeline->GetNextFeature(sPipelineFeature))
+                poFeature = std::move(sPipelineFeature.poFeature);
+            else
+                poFeature.reset();
+        }
         else
             poFeature.reset(poSrcLayer->GetNextFeature());
 
         if (poFeature == nullptr)
         {
-            if (CPLGetLastErrorType() == CE_Failure)
+            if (poPipeline ? poPipeline->ReadErrorOccurred()
+                           : CPLGetLastErrorType() == CE_Failure)
             {
                 bRet = false;
             }
@@ -5796,9 +6572,20 @@ bool LayerTranslator::Translate(
                     }
                 }
 
+                // The destination feature is recycled from one source
+                // feature to the next. Values are moved out of the source
+                // feature when it is not used afterwards, that is when it
+                // is not exploded in several parts, and when its fields are
+                // not needed to resolve coded values or to set Z.
+                const bool bStealFromSrcFeature =
+                    nIters == 1 && psInfo->m_oMapResolved.empty() &&
+                    iSrcZField < 0;
                 poDstFeature->Reset();
-                if (poDstFeature->SetFrom(poFeature.get(), panMap, TRUE) !=
-                    OGRERR_NONE)
+                if ((bStealFromSrcFeature
+                         ? poDstFeature->SetFromStealing(poFeature.get(),
+                                                         panMap, TRUE)
+                         : poDstFeature->SetFrom(poFeature.get(), panMap,
+                                                 TRUE)) != OGRERR_NONE)
                 {
                     if (psOptions->nGroupTransactions)
                     {
@@ -5919,6 +6706,17 @@ bool LayerTranslator::Translate(
                 poDstFeature->SetNativeMediaType(nullptr);
             }
 
+            if (poPipeline)
+            {
+                if (sPipelineFeature.bDiscard)
+                    goto end_loop;
+                if (sPipelineFeature.bReprojectionFailed &&
+                    !HandleReprojectionFailure(nSrcFID))
+                {
+                    return false;
+                }
+            }
+
             for (int iGeom = 0; iGeom < nDstGeomFieldCount; iGeom++)
             {
                 OGRGeometry *poDstGeometry;
@@ -5949,322 +6747,19 @@ bool LayerTranslator::Translate(
                     poDstGeometry = poDupGeometry;
                 }
 
-                if (m_nCoordDim == 2 || m_nCoordDim == 3)
-                {
-                    poDstGeometry->setCoordinateDimension(m_nCoordDim);
-                }
-                else if (m_nCoordDim == 4)
-                {
-                    poDstGeometry->set3D(TRUE);
-                    poDstGeometry->setMeasured(TRUE);
-                }
-                else if (m_nCoordDim == COORD_DIM_XYM)
-                {
-                    poDstGeometry->set3D(FALSE);
-                    poDstGeometry->setMeasured(TRUE);
-                }
-                else if (m_nCoordDim == COORD_DIM_LAYER_DIM)
-                {
-                    const OGRwkbGeometryType eDstLayerGeomType =
-                        poDstLayer->GetLayerDefn()
-                            ->GetGeomFieldDefn(iGeom)
-                            ->GetType();
-                    poDstGeometry->set3D(wkbHasZ(eDstLayerGeomType));
-                    poDstGeometry->setMeasured(wkbHasM(eDstLayerGeomType));
-                }
-
-                if (m_eGeomOp == GEOMOP_SEGMENTIZE)
-                {
-                    if (m_dfGeomOpParam > 0)
-                        poDstGeometry->segmentize(m_dfGeomOpParam);
-                }
-                else if (m_eGeomOp == GEOMOP_SIMPLIFY_PRESERVE_TOPOLOGY)
-                {
-                    if (m_dfGeomOpParam > 0)
-                    {
-                        OGRGeometry *poNewGeom =
-                            poDstGeometry->SimplifyPreserveTopology(
-                                m_dfGeomOpParam);
-                        if (poNewGeom)
-                        {
-                            delete poDstGeometry;
-                            poDstGeometry = poNewGeom;
-                        }
-                    }
-                }
-
-                if (m_poClipSrcOri)
+                // Geometries coming from the pipeline are already processed
+                if (!poPipeline)
                 {
-
-                    const OGRGeometry *poClipGeom =
-                        GetSrcClipGeom(poDstGeometry->getSpatialReference());
-
-                    std::unique_ptr<OGRGeometry> poClipped;
-                    if (poClipGeom != nullptr)
-                    {
-                        OGREnvelope oClipEnv;
-                        OGREnvelope oDstEnv;
-
-                        poClipGeom->getEnvelope(&oClipEnv);
-                        poDstGeometry->getEnvelope(&oDstEnv);
-
-                        if (oClipEnv.Intersects(oDstEnv))
-                        {
-                            poClipped.reset(
-                                poClipGeom->Intersection(poDstGeometry));
-                        }
-                    }
-
-                    if (poClipped == nullptr || poClipped->IsEmpty())
-                    {
-                        delete poDstGeometry;
-                        goto end_loop;
-                    }
-
-                    const int nDim = poDstGeometry->getDimension();
-                    if (poClipped->getDimension() < nDim &&
-                        wkbFlatten(
-                            poDstFDefn->GetGeomFieldDefn(iGeom)->GetType()) !=
-                            wkbUnknown)
+                    bool bReprojectionFailed = false;
+                    if (!TransformGeometry(psInfo, iGeom, nSrcFID, poOutputSRS,
+                                           poDstGeometry, bReprojectionFailed))
                     {
-                        CPLDebug(
-                            "OGR2OGR",
-                            "Discarding feature " CPL_FRMT_GIB " of layer %s, "
-                            "as its intersection with -clipsrc is a %s "
-                            "whereas the input is a %s",
-                            nSrcFID, poSrcLayer->GetName(),
-                            OGRToOGCGeomType(poClipped->getGeometryType()),
-                            OGRToOGCGeomType(poDstGeometry->getGeometryType()));
-                        delete poDstGeometry;
                         goto end_loop;
                     }
-
-                    delete poDstGeometry;
-                    poDstGeometry = poClipped.release();
-                }
-
-                OGRCoordinateTransformation *const poCT =
-                    psInfo->m_aoReprojectionInfo[iGeom].m_poCT.get();
-                char **const papszTransformOptions =
-                    psInfo->m_aoReprojectionInfo[iGeom]
-                        .m_aosTransformOptions.List();
-                const bool bReprojCanInvalidateValidity =
-                    psInfo->m_aoReprojectionInfo[iGeom]
-                        .m_bCanInvalidateValidity;
-
-                if (poCT != nullptr || papszTransformOptions != nullptr)
-                {
-                    // If we need to change the geometry type to linear, and
-                    // we have a geometry with curves, then convert it to
-                    // linear first, to avoid invalidities due to the fact
-                    // that validity of arc portions isn't always kept while
-                    // reprojecting and then discretizing.
-                    if (bReprojCanInvalidateValidity &&
-                        (!psInfo->m_bSupportCurves ||
-                         m_eGeomTypeConversion == GTC_CONVERT_TO_LINEAR ||
-                         m_eGeomTypeConversion ==
-                             GTC_PROMOTE_TO_MULTI_AND_CONVERT_TO_LINEAR))
-                    {
-                        if (poDstGeometry->hasCurveGeometry(TRUE))
-                        {
-                            OGRwkbGeometryType eTargetType = OGR_GT_GetLinear(
-                                poDstGeometry->getGeometryType());
-                            poDstGeometry = OGRGeometryFactory::forceTo(
-                                poDstGeometry, eTargetType);
-                        }
-                    }
-                    else if (bReprojCanInvalidateValidity &&
-                             eGType != GEOMTYPE_UNCHANGED &&
-                             !OGR_GT_IsNonLinear(
-                                 static_cast<OGRwkbGeometryType>(eGType)) &&
-                             poDstGeometry->hasCurveGeometry(TRUE))
-                    {
-                        poDstGeometry = OGRGeometryFactory::forceTo(
-                            poDstGeometry,
-                            static_cast<OGRwkbGeometryType>(eGType));
-                    }
-
-                    for (int iIter = 0; iIter < 2; ++iIter)
-                    {
-                        auto poReprojectedGeom = std::unique_ptr<OGRGeometry>(
-                            OGRGeometryFactory::transformWithOptions(
-                                poDstGeometry, poCT, papszTransformOptions,
-                                m_transformWithOptionsCache));
-                        if (poReprojectedGeom == nullptr)
-                        {
-                            if (psOptions->nGroupTransactions)
-                            {
-                                if (psOptions->nLayerTransaction)
-                                {
-                                    if (poDstLayer->CommitTransaction() !=
-                                            OGRERR_NONE &&
-                                        !psOptions->bSkipFailures)
-                                    {
-                                        delete poDstGeometry;
-                                        return false;
-                                    }
-                                }
-                            }
-
-                            CPLError(CE_Failure, CPLE_AppDefined,
-                                     "Failed to reproject feature " CPL_FRMT_GIB
-                                     " (geometry probably out of source or "
-                                     "destination SRS).",
-                                     nSrcFID);
-                            if (!psOptions->bSkipFailures)
-                            {
-                                delete poDstGeometry;
-                                return false;
-                            }
-                        }
-
-                        // Check if a curve geometry is no longer valid after
-                        // reprojection
-                        const auto eType = poDstGeometry->getGeometryType();
-                        const auto eFlatType = wkbFlatten(eType);
-
-                        const auto IsValid = [](const OGRGeometry *poGeom)
-                        {
-                            CPLErrorHandlerPusher oErrorHandler(
-                                CPLQuietErrorHandler);
-                            return poGeom->IsValid();
-                        };
-
-                        if (iIter == 0 && bReprojCanInvalidateValidity &&
-                            OGRGeometryFactory::haveGEOS() &&
-                            (eFlatType == wkbCurvePolygon ||
-                             eFlatType == wkbCompoundCurve ||
-                             eFlatType == wkbMultiCurve ||
-                             eFlatType == wkbMultiSurface) &&
-                            poDstGeometry->hasCurveGeometry(TRUE) &&
-                            IsValid(poDstGeometry))
-                        {
-                            OGRwkbGeometryType eTargetType = OGR_GT_GetLinear(
-                                poDstGeometry->getGeometryType());
-                            auto poDstGeometryTmp =
-                                std::unique_ptr<OGRGeometry>(
-                                    OGRGeometryFactory::forceTo(
-                                        poReprojectedGeom->clone(),
-                                        eTargetType));
-                            if (!IsValid(poDstGeometryTmp.get()))
-                            {
-                                CPLDebug("OGR2OGR",
-                                         "Curve geometry no longer valid after "
-                                         "reprojection: transforming it into "
-                                         "linear one before reprojecting");
-                                poDstGeometry = OGRGeometryFactory::forceTo(
-                                    poDstGeometry, eTargetType);
-                                poDstGeometry = OGRGeometryFactory::forceTo(
-                                    poDstGeometry, eType);
-                            }
-                            else
-                            {
-                                delete poDstGeometry;
-                                poDstGeometry = poReprojectedGeom.release();
-                                break;
-                            }
-                        }
-                        else
-                        {
-                            delete poDstGeometry;
-                            poDstGeometry = poReprojectedGeom.release();
-                            break;
-                        }
-                    }
-                }
-                else if (poOutputSRS != nullptr)
-                {
-                    poDstGeometry->assignSpatialReference(poOutputSRS);
-                }
-
-                if (poDstGeometry != nullptr)
-                {
-                    if (m_poClipDstOri)
-                    {
-                        const OGRGeometry *poClipGeom = GetDstClipGeom(
-                            poDstGeometry->getSpatialReference());
-                        if (poClipGeom == nullptr)
-                        {
-                            delete poDstGeometry;
-                            goto end_loop;
-                        }
-
-                        std::unique_ptr<OGRGeometry> poClipped;
-
-                        OGREnvelope oClipEnv;
-                        OGREnvelope oDstEnv;
-
-                        poClipGeom->getEnvelope(&oClipEnv);
-                        poDstGeometry->getEnvelope(&oDstEnv);
-
-                        if (oClipEnv.Intersects(oDstEnv))
-                        {
-                            poClipped.reset(
-                                poClipGeom->Intersection(poDstGeometry));
-                        }
-
-                        if (poClipped == nullptr || poClipped->IsEmpty())
-                        {
-                            delete poDstGeometry;
-                            goto end_loop;
-                        }
-
-                        const int nDim = poDstGeometry->getDimension();
-                        if (poClipped->getDimension() < nDim &&
-                            wkbFlatten(poDstFDefn->GetGeomFieldDefn(iGeom)
-                                           ->GetType()) != wkbUnknown)
-                        {
-                            CPLDebug(
-                                "OGR2OGR",
-                                "Discarding feature " CPL_FRMT_GIB
-                                " of layer %s, "
-                                "as its intersection with -clipdst is a %s "
-                                "whereas the input is a %s",
-                                nSrcFID, poSrcLayer->GetName(),
-                                OGRToOGCGeomType(poClipped->getGeometryType()),
-                                OGRToOGCGeomType(
-                                    poDstGeometry->getGeometryType()));
-                            delete poDstGeometry;
-                            goto end_loop;
-                        }
-
-                        delete poDstGeometry;
-                        poDstGeometry = poClipped.release();
-                    }
-
-                    if (m_bMakeValid)
-                    {
-                        const bool bIsGeomCollection =
-                            wkbFlatten(poDstGeometry->getGeometryType()) ==
-                            wkbGeometryCollection;
-                        OGRGeometry *poValidGeom = poDstGeometry->MakeValid();
-                        delete poDstGeometry;
-                        poDstGeometry = poValidGeom;
-                        if (poDstGeometry == nullptr)
-                            goto end_loop;
-                        if (!bIsGeomCollection)
-                        {
-                            OGRGeometry *poCleanedGeom = OGRGeometryFactory::
-                                removeLowerDimensionSubGeoms(poDstGeometry);
-                            delete poDstGeometry;
-                            poDstGeometry = poCleanedGeom;
-                        }
-                    }
-
-                    if (m_eGeomTypeConversion != GTC_DEFAULT)
-                    {
-                        OGRwkbGeometryType eTargetType =
-                            poDstGeometry->getGeometryType();
-                        eTargetType =
-                            ConvertType(m_eGeomTypeConversion, eTargetType);
-                        poDstGeometry = OGRGeometryFactory::forceTo(
-                            poDstGeometry, eTargetType);
-                    }
-                    else if (eGType != GEOMTYPE_UNCHANGED)
+                    if (bReprojectionFailed &&
+                        !HandleReprojectionFailure(nSrcFID))
                     {
-                        poDstGeometry = OGRGeometryFactory::forceTo(
-                            poDstGeometry,
-                            static_cast<OGRwkbGeometryType>(eGType));
+                        return false;
                     }
                 }
 
@@ -6369,6 +6864,339 @@ bool LayerTranslator::Translate(
     return bRet;
 }
 
+/************************************************************************/
+/*                  LayerTranslator::GetOutputSRS()                     */
+/************************************************************************/
+
+const OGRSpatialReference *
+LayerTranslator::GetOutputSRS(const TargetLayerInfo *psInfo) const
+{
+    const OGRSpatialReference *poOutputSRS = m_poOutputSRS;
+    if (poOutputSRS == nullptr && !m_bNullifyOutputSRS)
+    {
+        OGRLayer *poSrcLayer = psInfo->m_poSrcLayer;
+        const int iRequestedSrcGeomField = psInfo->m_iRequestedSrcGeomField;
+        if (poSrcLayer->GetLayerDefn()->GetGeomFieldCount() == 1)
+        {
+            poOutputSRS = poSrcLayer->GetSpatialRef();
+        }
+        else if (iRequestedSrcGeomField > 0)
+        {
+            poOutputSRS = poSrcLayer->GetLayerDefn()
+                              ->GetGeomFieldDefn(iRequestedSrcGeomField)
+                              ->GetSpatialRef();
+        }
+    }
+    return poOutputSRS;
+}
+
+/************************************************************************/
+/*                 LayerTranslator::TransformGeometry()                 */
+/************************************************************************/
+
+/* Apply -dim, -segmentize/-simplify, -clipsrc, reprojection, -clipdst,
+ * -makevalid and geometry type conversion to poDstGeometry, which is
+ * modified in place.
+ * Returns false if the feature must be discarded (poDstGeometry is then
+ * nullptr). If reprojection fails, poDstGeometry is set to nullptr,
+ * bReprojectionFailed to true, and true is returned: it is up to the caller
+ * to decide whether this is fatal.
+ */
+bool LayerTranslator::TransformGeometry(TargetLayerInfo *psInfo, int iGeom,
+                                        GIntBig nSrcFID,
+                                        const OGRSpatialReference *poOutputSRS,
+                                        OGRGeometry *&poDstGeometry,
+                                        bool &bReprojectionFailed)
+{
+    const int eGType = m_eGType;
+    const auto poDstFDefn = psInfo->m_poDstLayer->GetLayerDefn();
+    bReprojectionFailed = false;
+
+    if (m_nCoordDim == 2 || m_nCoordDim == 3)
+    {
+        poDstGeometry->setCoordinateDimension(m_nCoordDim);
+    }
+    else if (m_nCoordDim == 4)
+    {
+        poDstGeometry->set3D(TRUE);
+        poDstGeometry->setMeasured(TRUE);
+    }
+    else if (m_nCoordDim == COORD_DIM_XYM)
+    {
+        poDstGeometry->set3D(FALSE);
+        poDstGeometry->setMeasured(TRUE);
+    }
+    else if (m_nCoordDim == COORD_DIM_LAYER_DIM)
+    {
+        const OGRwkbGeometryType eDstLayerGeomType =
+            poDstFDefn->GetGeomFieldDefn(iGeom)->GetType();
+        poDstGeometry->set3D(wkbHasZ(eDstLayerGeomType));
+        poDstGeometry->setMeasured(wkbHasM(eDstLayerGeomType));
+    }
+
+    if (m_eGeomOp == GEOMOP_SEGMENTIZE)
+    {
+        if (m_dfGeomOpParam > 0)
+            poDstGeometry->segmentize(m_dfGeomOpParam);
+    }
+    else if (m_eGeomOp == GEOMOP_SIMPLIFY_PRESERVE_TOPOLOGY)
+    {
+        if (m_dfGeomOpParam > 0)
+        {
+            OGRGeometry *poNewGeom =
+                poDstGeometry->SimplifyPreserveTopology(m_dfGeomOpParam);
+            if (poNewGeom)
+            {
+                delete poDstGeometry;
+                poDstGeometry = poNewGeom;
+            }
+        }
+    }
+
+    if (m_poClipSrcOri)
+    {
+        const OGRGeometry *poClipGeom =
+            GetSrcClipGeom(poDstGeometry->getSpatialReference());
+
+        std::unique_ptr<OGRGeometry> poClipped;
+        if (poClipGeom != nullptr)
+        {
+            OGREnvelope oClipEnv;
+            OGREnvelope oDstEnv;
+
+            poClipGeom->getEnvelope(&oClipEnv);
+            poDstGeometry->getEnvelope(&oDstEnv);
+
+            if (oClipEnv.Intersects(oDstEnv))
+            {
+                poClipped.reset(poClipGeom->Intersection(poDstGeometry));
+            }
+        }
+
+        if (poClipped == nullptr || poClipped->IsEmpty())
+        {
+            delete poDstGeometry;
+            poDstGeometry = nullptr;
+            return false;
+        }
+
+        const int nDim = poDstGeometry->getDimension();
+        if (poClipped->getDimension() < nDim &&
+            wkbFlatten(poDstFDefn->GetGeomFieldDefn(iGeom)->GetType()) !=
+                wkbUnknown)
+        {
+            CPLDebug("OGR2OGR",
+                     "Discarding feature " CPL_FRMT_GIB " of layer %s, "
+                     "as its intersection with -clipsrc is a %s "
+                     "whereas the input is a %s",
+                     nSrcFID, psInfo->m_poSrcLayer->GetName(),
+                     OGRToOGCGeomType(poClipped->getGeometryType()),
+                     OGRToOGCGeomType(poDstGeometry->getGeometryType()));
+            delete poDstGeometry;
+            poDstGeometry = nullptr;
+            return false;
+        }
+
+        delete poDstGeometry;
+        poDstGeometry = poClipped.release();
+    }
+
+    OGRCoordinateTransformation *const poCT =
+        psInfo->m_aoReprojectionInfo[iGeom].m_poCT.get();
+    char **const papszTransformOptions =
+        psInfo->m_aoReprojectionInfo[iGeom].m_aosTransformOptions.List();
+    const bool bReprojCanInvalidateValidity =
+        psInfo->m_aoReprojectionInfo[iGeom].m_bCanInvalidateValidity;
+
+    if (poCT != nullptr || papszTransformOptions != nullptr)
+    {
+        // If we need to change the geometry type to linear, and
+        // we have a geometry with curves, then convert it to
+        // linear first, to avoid invalidities due to the fact
+        // that validity of arc portions isn't always kept while
+        // reprojecting and then discretizing.
+        if (bReprojCanInvalidateValidity &&
+            (!psInfo->m_bSupportCurves ||
+             m_eGeomTypeConversion == GTC_CONVERT_TO_LINEAR ||
+             m_eGeomTypeConversion ==
+                 GTC_PROMOTE_TO_MULTI_AND_CONVERT_TO_LINEAR))
+        {
+            if (poDstGeometry->hasCurveGeometry(TRUE))
+            {
+                OGRwkbGeometryType eTargetType =
+                    OGR_GT_GetLinear(poDstGeometry->getGeometryType());
+                poDstGeometry =
+                    OGRGeometryFactory::forceTo(poDstGeometry, eTargetType);
+            }
+        }
+        else if (bReprojCanInvalidateValidity &&
+                 eGType != GEOMTYPE_UNCHANGED &&
+                 !OGR_GT_IsNonLinear(
+                     static_cast<OGRwkbGeometryType>(eGType)) &&
+                 poDstGeometry->hasCurveGeometry(TRUE))
+        {
+            poDstGeometry = OGRGeometryFactory::forceTo(
+                poDstGeometry, static_cast<OGRwkbGeometryType>(eGType));
+        }
+
+        for (int iIter = 0; iIter < 2; ++iIter)
+        {
+            auto poReprojectedGeom = std::unique_ptr<OGRGeometry>(
+                OGRGeometryFactory::transformWithOptions(
+                    poDstGeometry, poCT, papszTransformOptions,
+                    m_transformWithOptionsCache));
+            if (poReprojectedGeom == nullptr)
+            {
+                delete poDstGeometry;
+                poDstGeometry = nullptr;
+                bReprojectionFailed = true;
+                return true;
+            }
+
+            // Check if a curve geometry is no longer valid after
+            // reprojection
+            const auto eType = poDstGeometry->getGeometryType();
+            const auto eFlatType = wkbFlatten(eType);
+
+            const auto IsValid = [](const OGRGeometry *poGeom)
+            {
+                CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+                return poGeom->IsValid();
+            };
+
+            if (iIter == 0 && bReprojCanInvalidateValidity &&
+                OGRGeometryFactory::haveGEOS() &&
+                (eFlatType == wkbCurvePolygon ||
+                 eFlatType == wkbCompoundCurve ||
+                 eFlatType == wkbMultiCurve ||
+                 eFlatType == wkbMultiSurface) &&
+                poDstGeometry->hasCurveGeometry(TRUE) &&
+                IsValid(poDstGeometry))
+            {
+                OGRwkbGeometryType eTargetType =
+                    OGR_GT_GetLinear(poDstGeometry->getGeometryType());
+                auto poDstGeometryTmp = std::unique_ptr<OGRGeometry>(
+                    OGRGeometryFactory::forceTo(poReprojectedGeom->clone(),
+                                                eTargetType));
+                if (!IsValid(poDstGeometryTmp.get()))
+                {
+                    CPLDebug("OGR2OGR",
+                             "Curve geometry no longer valid after "
+                             "reprojection: transforming it into "
+                             "linear one before reprojecting");
+                    poDstGeometry =
+                        OGRGeometryFactory::forceTo(poDstGeometry, eTargetType);
+                    poDstGeometry =
+                        OGRGeometryFactory::forceTo(poDstGeometry, eType);
+                }
+                else
+                {
+                    delete poDstGeometry;
+                    poDstGeometry = poReprojectedGeom.release();
+                    break;
+                }
+            }
+            else
+            {
+                delete poDstGeometry;
+                poDstGeometry = poReprojectedGeom.release();
+                break;
+            }
+        }
+    }
+    else if (poOutputSRS != nullptr)
+    {
+        poDstGeometry->assignSpatialReference(poOutputSRS);
+    }
+
+    if (m_poClipDstOri)
+    {
+        const OGRGeometry *poClipGeom =
+            GetDstClipGeom(poDstGeometry->getSpatialReference());
+        if (poClipGeom == nullptr)
+        {
+            delete poDstGeometry;
+            poDstGeometry = nullptr;
+            return false;
+        }
+
+        std::unique_ptr<OGRGeometry> poClipped;
+
+        OGREnvelope oClipEnv;
+        OGREnvelope oDstEnv;
+
+        poClipGeom->getEnvelope(&oClipEnv);
+        poDstGeometry->getEnvelope(&oDstEnv);
+
+        if (oClipEnv.Intersects(oDstEnv))
+        {
+            poClipped.reset(poClipGeom->Intersection(poDstGeometry));
+        }
+
+        if (poClipped == nullptr || poClipped->IsEmpty())
+        {
+            delete poDstGeometry;
+            poDstGeometry = nullptr;
+            return false;
+        }
+
+        const int nDim = poDstGeometry->getDimension();
+        if (poClipped->getDimension() < nDim &&
+            wkbFlatten(poDstFDefn->GetGeomFieldDefn(iGeom)->GetType()) !=
+                wkbUnknown)
+        {
+            CPLDebug("OGR2OGR",
+                     "Discarding feature " CPL_FRMT_GIB " of layer %s, "
+                     "as its intersection with -clipdst is a %s "
+                     "whereas the input is a %s",
+                     nSrcFID, psInfo->m_poSrcLayer->GetName(),
+                     OGRToOGCGeomType(poClipped->getGeometryType()),
+                     OGRToOGCGeomType(poDstGeometry->getGeometryType()));
+            delete poDstGeometry;
+            poDstGeometry = nullptr;
+            return false;
+        }
+
+        delete poDstGeometry;
+        poDstGeometry = poClipped.release();
+    }
+
+    if (m_bMakeValid)
+    {
+        const bool bIsGeomCollection =
+            wkbFlatten(poDstGeometry->getGeometryType()) ==
+            wkbGeometryCollection;
+        OGRGeometry *poValidGeom = poDstGeometry->MakeValid();
+        delete poDstGeometry;
+        poDstGeometry = poValidGeom;
+        if (poDstGeometry == nullptr)
+            return false;
+        if (!bIsGeomCollection)
+        {
+            OGRGeometry *poCleanedGeom =
+                OGRGeometryFactory::removeLowerDimensionSubGeoms(
+                    poDstGeometry);
+            delete poDstGeometry;
+            poDstGeometry = poCleanedGeom;
+        }
+    }
+
+    if (m_eGeomTypeConversion != GTC_DEFAULT)
+    {
+        OGRwkbGeometryType eTargetType = poDstGeometry->getGeometryType();
+        eTargetType = ConvertType(m_eGeomTypeConversion, eTargetType);
+        poDstGeometry =
+            OGRGeometryFactory::forceTo(poDstGeometry, eTargetType);
+    }
+    else if (eGType != GEOMTYPE_UNCHANGED)
+    {
+        poDstGeometry = OGRGeometryFactory::forceTo(
+            poDstGeometry, static_cast<OGRwkbGeometryType>(eGType));
+    }
+
+    return true;
+}
+
 /************************************************************************/
 /*                LayerTranslator::GetDstClipGeom()                     */
 /************************************************************************/
@@ -6887,6 +7715,10 @@ GDALVectorTranslateOptions *GDALVectorTranslateOptionsNew(
             psOptions->eGeomOp = GEOMOP_SIMPLIFY_PRESERVE_TOPOLOGY;
             psOptions->dfGeomOpParam = CPLAtof(papszArgv[++i]);
         }
+        else if (EQUAL(papszArgv[i], "-multithread"))
+        {
+            psOptions->bMultiThread = true;
+        }
         else if (EQUAL(papszArgv[i], "-makevalid"))
         {
             if (!OGRGeometryFactory::haveGEOS())
@@ -28,6 +28,7 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import math
 import struct
 
 import gdaltest
@@ -400,3 +401,60 @@ def test_contour_raster_acquisition_error():
         gdal.ContourGenerateEx(
             ds.GetRasterBand(1), ogr_lyr, options=["LEVEL_INTERVAL=1", "ID_FIELD=0"]
         )
+
+
+###############################################################################
+# Test multi-threaded mode: lines crossing the seams between the bands of
+# lines processed by different threads must be stitched back together
+
+
+@pytest.mark.parametrize(
+    "level_options", [["LEVEL_INTERVAL=10"], ["FIXED_LEVELS=15,35,55,75"]]
+)
+def test_contour_num_threads(level_options):
+
+    xsize = 120
+    ysize = 1100
+    src_ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize, 1, gdal.GDT_Float32)
+    src_ds.SetGeoTransform([1000, 10, 0, 5000, 0, -10])
+    data = []
+    for y in range(ysize):
+        for x in range(xsize):
+            # Bumps crossing the seams between bands, and a nodata hole
+            if 500 <= y < 520 and 40 <= x < 50:
+                data.append(-9999)
+            else:
+                data.append(
+                    50
+                    + 40 * math.sin(x / 17.0) * math.cos(y / 23.0)
+                    + 5 * math.cos((x + y) / 7.0)
+                )
+    src_ds.GetRasterBand(1).WriteRaster(
+        0, 0, xsize, ysize, struct.pack("f" * len(data), *data)
+    )
+
+    def contour(num_threads):
+        ogr_ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+        ogr_lyr = ogr_ds.CreateLayer("contour", geom_type=ogr.wkbLineString)
+        ogr_lyr.CreateField(ogr.FieldDefn("ID", ogr.OFTInteger))
+        ogr_lyr.CreateField(ogr.FieldDefn("ELEV", ogr.OFTReal))
+        gdal.ContourGenerateEx(
+            src_ds.GetRasterBand(1),
+            ogr_lyr,
+            options=level_options
+            + ["NODATA=-9999", "ID_FIELD=0", "ELEV_FIELD=1"]
+            + ["NUM_THREADS=" + str(num_threads)],
+        )
+        stats = {}
+        for f in ogr_lyr:
+            count, length = stats.get(f["ELEV"], (0, 0))
+            stats[f["ELEV"]] = (count + 1, length + f.GetGeometryRef().Length())
+        return stats
+
+    ref = contour(1)
+    got = contour(4)
+    assert len(ref) > 1
+    assert set(got.keys()) == set(ref.keys())
+    for elev in ref:
+        assert got[elev][0] == ref[elev][0], elev
+        assert got[elev][1] == pytest.approx(ref[elev][1], rel=1e-10), elev
@@ -116,3 +116,51 @@ def test_cutline_4():
 
 
 ###############################################################################
+# Test that the cutline index, used on a complex cutline with many chunks,
+# gives the same result as rasterizing the whole cutline for each chunk
+
+
+@pytest.mark.require_geos
+@pytest.mark.parametrize("all_touched", [False, True])
+def test_cutline_index(all_touched):
+
+    import math
+
+    size = 1500
+    src_ds = gdal.GetDriverByName("MEM").Create("", size, size)
+    src_ds.GetRasterBand(1).Fill(255)
+    src_ds.SetGeoTransform([0, 1, 0, 0, 0, -1])
+
+    # Jagged "coastline" with many vertices and an island
+    n = 20000
+    points = []
+    for i in range(n):
+        angle = 2 * math.pi * i / n
+        radius = 600 + 50 * math.sin(angle * 97) + 20 * math.sin(angle * 1013)
+        points.append(
+            "%.6f %.6f"
+            % (750.3 + radius * math.cos(angle), 750.7 + radius * math.sin(angle))
+        )
+    points.append(points[0])
+    wkt = "MULTIPOLYGON(((%s)),((100 100,100 130,140 130,100 100)))" % ",".join(
+        points
+    )
+
+    warp_options = ["CUTLINE=" + wkt]
+    if all_touched:
+        warp_options.append("CUTLINE_ALL_TOUCHED=YES")
+
+    results = []
+    for use_index in ("NO", "YES"):
+        with gdal.config_option("GDALWARP_CUTLINE_INDEX", use_index):
+            out_ds = gdal.Warp(
+                "",
+                src_ds,
+                format="MEM",
+                warpMemoryLimit=200000,
+                warpOptions=warp_options,
+            )
+        results.append(out_ds.ReadRaster())
+
+    assert results[0] == results[1]
+    assert results[0] != src_ds.ReadRaster()
@@ -256,3 +256,41 @@ def test_fillnodata_user_provided_mask_with_smoothing():
     )
     got = [x for x in struct.unpack("f" * (5 * 5), targetBand.ReadRaster())]
     assert got == pytest.approx(expected, 1e-5)
+
+
+###############################################################################
+# Test that multi-threaded processing gives the same result as single-threaded
+
+
+def test_fillnodata_num_threads():
+
+    import random
+
+    rnd = random.Random(0)
+    width = 200
+    height = 300
+    data = [
+        rnd.uniform(1, 100) if rnd.random() < 0.05 else 0
+        for _ in range(width * height)
+    ]
+    ar = struct.pack("f" * (width * height), *data)
+
+    results = []
+    for num_threads in ("1", "4"):
+        ds = gdal.GetDriverByName("MEM").Create(
+            "", width, height, 1, gdal.GDT_Float32
+        )
+        targetBand = ds.GetRasterBand(1)
+        targetBand.SetNoDataValue(0)
+        targetBand.WriteRaster(0, 0, width, height, ar)
+        gdal.FillNodata(
+            targetBand=targetBand,
+            maskBand=None,
+            maxSearchDist=20,
+            smoothingIterations=0,
+            options=["NUM_THREADS=" + num_threads],
+        )
+        results.append(targetBand.ReadRaster())
+
+    assert results[0] != ar
+    assert results[0] == results[1]
@@ -448,3 +448,50 @@ def test_polygonize_8():
         wkt
         == "POLYGON ((1 4,1 3,0 3,0 1,1 1,1 0,3 0,3 1,4 1,4 3,3 3,3 4,1 4),(1 3,3 3,3 1,1 1,1 3))"
     )
+
+
+###############################################################################
+# Test multi-threaded mode: polygons crossing the seams between the bands of
+# rows processed by different threads must be merged
+
+
+@pytest.mark.parametrize("connectedness", [4, 8])
+@pytest.mark.parametrize("is_int_polygonize", [True, False])
+def test_polygonize_num_threads(connectedness, is_int_polygonize):
+
+    xsize = 100
+    ysize = 1200
+    src_ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize, 1, gdal.GDT_Byte)
+    # Diagonal stripes and a frame crossing all bands, with some nodata
+    # pixels.
+    data = bytearray(xsize * ysize)
+    for y in range(ysize):
+        for x in range(xsize):
+            if x == 0 or y == 0 or x == xsize - 1 or y == ysize - 1:
+                v = 1
+            elif (x + y) % 37 == 0:
+                v = 255
+            else:
+                v = 2 + ((x + y) // 13 + (x * y) // 4096) % 3
+            data[y * xsize + x] = v
+    src_band = src_ds.GetRasterBand(1)
+    src_band.WriteRaster(0, 0, xsize, ysize, bytes(data))
+    src_band.SetNoDataValue(255)
+
+    def polygonize(options):
+        ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+        lyr = ds.CreateLayer("poly", None, ogr.wkbPolygon)
+        lyr.CreateField(ogr.FieldDefn("DN", ogr.OFTInteger))
+        if connectedness == 8:
+            options = options + ["8CONNECTED=8"]
+        if is_int_polygonize:
+            ret = gdal.Polygonize(src_band, src_band.GetMaskBand(), lyr, 0, options)
+        else:
+            ret = gdal.FPolygonize(src_band, src_band.GetMaskBand(), lyr, 0, options)
+        assert ret == 0
+        return sorted((f.GetField("DN"), f.GetGeometryRef().ExportToWkt()) for f in lyr)
+
+    ref = polygonize(["NUM_THREADS=1"])
+    got = polygonize(["NUM_THREADS=4"])
+    assert len(got) == len(ref)
+    assert got == ref
@@ -29,6 +29,9 @@
 ###############################################################################
 
 
+import math
+import struct
+
 import pytest
 
 from osgeo import gdal
@@ -126,3 +129,61 @@ def test_proximity_3():
     if cs != cs_expected:
         print("Got: ", cs)
         pytest.fail("got wrong checksum")
+
+
+###############################################################################
+# Test ALGORITHM=EXACT against a brute force computation
+
+
+@pytest.mark.parametrize("num_threads", [1, 4])
+def test_proximity_exact(num_threads):
+
+    xsize = 47
+    ysize = 39
+    targets = [(3, 2), (40, 5), (20, 20), (21, 20), (7, 35), (46, 38)]
+    src_ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize)
+    src_band = src_ds.GetRasterBand(1)
+    for x, y in targets:
+        src_band.WriteRaster(x, y, 1, 1, b"\x07")
+    # Input nodata pixel
+    src_band.WriteRaster(30, 30, 1, 1, b"\x05")
+    src_band.SetNoDataValue(5)
+
+    dst_ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize, 1, gdal.GDT_Float32)
+    dst_band = dst_ds.GetRasterBand(1)
+
+    maxdist = 15
+    gdal.ComputeProximity(
+        src_band,
+        dst_band,
+        options=[
+            "ALGORITHM=EXACT",
+            "NUM_THREADS=%d" % num_threads,
+            "VALUES=7",
+            "MAXDIST=%d" % maxdist,
+            "NODATA=-1",
+            "USE_INPUT_NODATA=YES",
+        ],
+    )
+
+    got = struct.unpack("f" * (xsize * ysize), dst_band.ReadRaster())
+    for y in range(ysize):
+        for x in range(xsize):
+            dist = min(math.sqrt((x - tx) ** 2 + (y - ty) ** 2) for tx, ty in targets)
+            if dist > maxdist or (x, y) == (30, 30):
+                expected = -1
+            else:
+                expected = dist
+            assert got[y * xsize + x] == pytest.approx(expected, abs=1e-5), (x, y)
+
+
+def test_proximity_invalid_algorithm():
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 1, 1)
+    dst_ds = gdal.GetDriverByName("MEM").Create("", 1, 1)
+    with pytest.raises(Exception, match="Unrecognized ALGORITHM value"):
+        gdal.ComputeProximity(
+            src_ds.GetRasterBand(1),
+            dst_ds.GetRasterBand(1),
+            options=["ALGORITHM=INVALID"],
+        )
@@ -28,6 +28,7 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import math
 import struct
 
 import ogrtest
@@ -1011,3 +1012,172 @@ def test_rasterize_bugfix_gh8918(wkt):
     )
 
     assert target_ds.GetRasterBand(1).Checksum() == 36
+
+
+###############################################################################
+# Test that rasterizing from the Arrow stream of a layer gives the same
+# result as the feature based code path
+
+
+@pytest.mark.parametrize(
+    "options",
+    [[], ["ALL_TOUCHED=YES"], ["ATTRIBUTE=val"], ["BURN_VALUE_FROM=Z"]],
+)
+@pytest.mark.parametrize("merge_alg", ["REPLACE", "ADD"])
+@pytest.mark.require_driver("GPKG")
+def test_rasterize_from_arrow_stream(tmp_vsimem, options, merge_alg):
+
+    filename = str(tmp_vsimem / "test_rasterize_from_arrow_stream.gpkg")
+    ds = ogr.GetDriverByName("GPKG").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbUnknown)
+    lyr.CreateField(ogr.FieldDefn("val", ogr.OFTReal))
+    for val, wkt in [
+        # counter-clockwise exterior ring and clockwise hole
+        (1.5, "POLYGON ((1 1,9 1,9 9,1 9,1 1),(3 3,3 7,7 7,7 3,3 3))"),
+        (2, "POLYGON Z ((10 10 5,10 18 5,18 18 5,10 10 5))"),
+        (3, "LINESTRING (0 19.5,19.5 0)"),
+        (4, "POINT Z (12.5 2.5 7)"),
+        (5, "MULTIPOINT ((15.5 5.5),(16.5 6.5))"),
+        (6, "MULTILINESTRING ((2 12,8 12),(2 14,8 16))"),
+        (
+            7,
+            "MULTIPOLYGON (((11 1,14 1,14 4,11 4,11 1)),((1 15,4 15,4 18,1 15)))",
+        ),
+        (
+            None,
+            "GEOMETRYCOLLECTION (POINT (0.5 0.5),LINESTRING (18 1,18 9),"
+            "POLYGON ((12 12,12 16,16 16,12 12)))",
+        ),
+        (9, "POLYGON EMPTY"),
+        (10, None),
+        (11, "CURVEPOLYGON (CIRCULARSTRING (14 14,16 16,14 14))"),
+    ]:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if val is not None:
+            f["val"] = val
+        if wkt:
+            f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+    ds = None
+
+    def rasterize(use_arrow_stream):
+        ds = ogr.Open(filename)
+        lyr = ds.GetLayer(0)
+        assert lyr.TestCapability(ogr.OLCFastGetArrowStream)
+        target_ds = gdal.GetDriverByName("MEM").Create(
+            "", 20, 20, 1, gdal.GDT_Float32
+        )
+        target_ds.SetGeoTransform((0, 1, 0, 20, 0, -1))
+        all_options = options + ["MERGE_ALG=" + merge_alg]
+        with gdal.config_option(
+            "GDAL_RASTERIZE_USE_ARROW_STREAM", use_arrow_stream
+        ):
+            assert (
+                gdal.RasterizeLayer(
+                    target_ds,
+                    [1],
+                    lyr,
+                    burn_values=[] if "ATTRIBUTE=val" in options else [1],
+                    options=all_options,
+                )
+                == gdal.CE_None
+            )
+        return target_ds.GetRasterBand(1).ReadRaster()
+
+    ref = rasterize("NO")
+    assert struct.unpack("f" * 400, ref) != tuple([0.0] * 400)
+    assert rasterize("YES") == ref
+
+
+###############################################################################
+# Test the tiled multi-threaded mode of GDALRasterizeLayers()
+
+
+@pytest.mark.parametrize(
+    "options",
+    [
+        [],
+        ["ALL_TOUCHED=YES"],
+        ["MERGE_ALG=ADD"],
+        ["ATTRIBUTE=val"],
+        ["BURN_VALUE_FROM=Z"],
+    ],
+)
+def test_rasterize_layer_num_threads(options):
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = ds.CreateLayer("test")
+    lyr.CreateField(ogr.FieldDefn("val", ogr.OFTReal))
+    wkts = []
+    for i in range(100):
+        x = (i * 37) % 3000
+        y = (i * 53) % 2000
+        size = 5 + (i * 7) % 400
+        wkts.append(
+            f"POLYGON (({x} {y} {i},{x + size} {y} {i},{x} {y + size} {i},"
+            + f"{x} {y} {i}))"
+        )
+        wkts.append(f"LINESTRING ({x} {y} {i},{x + 2 * size} {y + size} {i})")
+        wkts.append(f"POINT ({x + 0.5} {y + 0.5} {i})")
+    wkts.append("MULTIPOLYGON (((0 0 1,3000 2000 1,0 2000 1,0 0 1)))")
+    for i, wkt in enumerate(wkts):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["val"] = i
+        f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+
+    def rasterize(num_threads):
+        target_ds = gdal.GetDriverByName("MEM").Create(
+            "", 3000, 2000, 2, gdal.GDT_Float32
+        )
+        target_ds.SetGeoTransform((0, 1, 0, 0, 0, 1))
+        assert (
+            gdal.RasterizeLayer(
+                target_ds,
+                [1, 2],
+                lyr,
+                burn_values=[] if "ATTRIBUTE=val" in options else [1, 2],
+                options=options + ["NUM_THREADS=" + num_threads],
+            )
+            == gdal.CE_None
+        )
+        return target_ds.ReadRaster()
+
+    ref = rasterize("1")
+    assert rasterize("4") == ref
+    assert rasterize("ALL_CPUS") == ref
+
+
+###############################################################################
+# Test splitting the rows of a polygon with many vertices among threads
+
+
+@pytest.mark.parametrize("options", [{}, {"add": True}, {"allTouched": True}])
+def test_rasterize_polygon_many_vertices_num_threads(options):
+
+    n = 20000
+    coords = []
+    for i in range(n):
+        radius = 400 + 50 * math.sin(i / 7.0)
+        angle = 2 * math.pi * i / n
+        x = 500 + radius * math.cos(angle)
+        y = 500 + radius * math.sin(angle)
+        coords.append(f"{x:.6f} {y:.6f}")
+    coords.append(coords[0])
+
+    vector_ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = vector_ds.CreateLayer("test")
+    f = ogr.Feature(lyr.GetLayerDefn())
+    f.SetGeometry(ogr.CreateGeometryFromWkt("POLYGON ((" + ",".join(coords) + "))"))
+    lyr.CreateFeature(f)
+
+    def rasterize(num_threads):
+        target_ds = gdal.GetDriverByName("MEM").Create("", 1000, 1000, 1)
+        target_ds.SetGeoTransform((0, 1, 0, 0, 0, 1))
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            gdal.Rasterize(target_ds, vector_ds, burnValues=[1], **options)
+        return target_ds.ReadRaster()
+
+    ref = rasterize("1")
+    assert ref != b"\0" * (1000 * 1000)
+    assert rasterize("4") == ref
@@ -328,3 +328,44 @@ cellsize     60.000000000000
     if cs != cs_expected:
         print("Got: ", cs)
         pytest.fail("got wrong checksum")
+
+
+###############################################################################
+# Test that multi-threaded processing gives the same result as single-threaded
+
+
+@pytest.mark.parametrize("connectedness", [4, 8])
+def test_sieve_num_threads(connectedness):
+
+    import random
+
+    rnd = random.Random(0)
+    width = 100
+    height = 1200
+    data = bytes(
+        [
+            rnd.choice((1, 1, 1, 2, 2, 3)) if rnd.random() < 0.97 else 0
+            for _ in range(width * height)
+        ]
+    )
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", width, height)
+    src_band = src_ds.GetRasterBand(1)
+    src_band.WriteRaster(0, 0, width, height, data)
+    src_band.SetNoDataValue(0)
+
+    results = []
+    for num_threads in ("1", "4"):
+        dst_ds = gdal.GetDriverByName("MEM").Create("", width, height)
+        gdal.SieveFilter(
+            src_band,
+            src_band.GetMaskBand(),
+            dst_ds.GetRasterBand(1),
+            10,
+            connectedness,
+            options=["NUM_THREADS=" + num_threads],
+        )
+        results.append(dst_ds.ReadRaster())
+
+    assert results[0] != data
+    assert results[0] == results[1]
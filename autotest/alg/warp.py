@@ -32,6 +32,7 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import json
 import math
 import os
 import shutil
@@ -1669,3 +1670,346 @@ def test_warp_average_oversampling():
             assert math.isnan(got_data[(y + 4) * 14 + (14 - 1 - x)])
         for x in range(6):
             assert got_data[(y + 4) * 14 + (x + 4)] == 3.0
+
+
+###############################################################################
+# Test that the separable average code path used for affine transforms
+# without rotation gives the same result as the general one
+
+
+@pytest.mark.parametrize("dt", [gdal.GDT_Byte, gdal.GDT_UInt16, gdal.GDT_Float32])
+@pytest.mark.parametrize("res", [2, 3.3, 0.7])
+def test_warp_average_affine_separable(dt, res):
+
+    src_ds = gdal.Translate("", "../gcore/data/byte.tif", format="MEM", outputType=dt)
+    gt = src_ds.GetGeoTransform()
+
+    def warp():
+        return gdal.Warp(
+            "",
+            src_ds,
+            format="MEM",
+            resampleAlg="average",
+            xRes=gt[1] * res,
+            yRes=-gt[5] * res,
+            outputBounds=[
+                gt[0] + 7,
+                gt[3] + 20 * gt[5],
+                gt[0] + 20 * gt[1],
+                gt[3] - 5,
+            ],
+        )
+
+    ds = warp()
+    with gdaltest.config_option("GDAL_WARP_USE_AFFINE_OPTIMIZATION", "NO"):
+        ref_ds = warp()
+    assert ds.ReadRaster() == ref_ds.ReadRaster()
+
+
+###############################################################################
+# Test that chunks whose source window is empty in a sparse file, because of
+# a transparent alpha band or of nodata, are warped like with a dense copy
+
+
+@pytest.mark.parametrize("with_alpha", [True, False])
+def test_warp_sparse_source_empty_chunks(tmp_vsimem, with_alpha):
+
+    filename = str(tmp_vsimem / "sparse.tif")
+    src_ds = gdal.GetDriverByName("GTiff").Create(
+        filename,
+        256,
+        256,
+        2 if with_alpha else 1,
+        options=["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16", "SPARSE_OK=YES"],
+    )
+    src_ds.SetGeoTransform([0, 1, 0, 256, 0, -1])
+    if with_alpha:
+        src_ds.GetRasterBand(2).SetColorInterpretation(gdal.GCI_AlphaBand)
+        src_ds.GetRasterBand(2).WriteRaster(200, 200, 20, 20, b"\xff" * 400)
+    else:
+        src_ds.GetRasterBand(1).SetNoDataValue(0)
+    src_ds.GetRasterBand(1).WriteRaster(
+        200, 200, 20, 20, bytes([1 + (i % 200) for i in range(400)])
+    )
+    src_ds = None
+
+    src_ds = gdal.Open(filename)
+    dense_ds = gdal.Translate("", src_ds, format="MEM")
+
+    def warp(ds):
+        return gdal.Warp(
+            "",
+            ds,
+            format="MEM",
+            xRes=0.7,
+            yRes=0.7,
+            resampleAlg="bilinear",
+            warpMemoryLimit=16 * 1024,
+            warpOptions=["INIT_DEST=0"],
+        )
+
+    ref_ds = warp(dense_ds)
+    ds = warp(src_ds)
+    for i in range(ref_ds.RasterCount):
+        assert (
+            ds.GetRasterBand(i + 1).Checksum() == ref_ds.GetRasterBand(i + 1).Checksum()
+        )
+    assert ds.GetRasterBand(1).Checksum() != 0
+
+
+###############################################################################
+# Test the SCALE and LUT warping options, and compare with a warp followed
+# by gdal_translate -scale
+
+
+@pytest.mark.parametrize("resample_alg", ["near", "bilinear", "average"])
+def test_warp_scale_and_lut(resample_alg):
+    numpy = pytest.importorskip("numpy")
+
+    src_ds = gdal.Translate(
+        "", "../gcore/data/byte.tif", format="MEM", outputType=gdal.GDT_UInt16
+    )
+    src_ds.GetRasterBand(1).WriteArray(
+        src_ds.GetRasterBand(1).ReadAsArray().astype("uint16") * 16
+    )
+    options = dict(
+        format="MEM",
+        outputType=gdal.GDT_Byte,
+        resampleAlg=resample_alg,
+        xRes=80,
+        yRes=80,
+    )
+
+    ds = gdal.Warp("", src_ds, warpOptions=["SCALE=0,4080,0,255"], **options)
+    tmp_ds = gdal.Warp(
+        "", src_ds, **dict(options, outputType=gdal.GDT_Float32)
+    )
+    ref_ds = gdal.Translate(
+        "",
+        tmp_ds,
+        format="MEM",
+        outputType=gdal.GDT_Byte,
+        scaleParams=[[0, 4080, 0, 255]],
+    )
+    assert ds.GetRasterBand(1).DataType == gdal.GDT_Byte
+    got = ds.GetRasterBand(1).ReadAsArray().astype("int32")
+    expected = ref_ds.GetRasterBand(1).ReadAsArray().astype("int32")
+    assert abs(got - expected).max() <= 1
+
+    # Values above 4080 are clamped
+    ds = gdal.Warp("", src_ds, warpOptions=["SCALE=0,1000,0,100"], **options)
+    assert ds.GetRasterBand(1).ReadAsArray().max() == 100
+
+    if resample_alg == "near":
+        ds = gdal.Warp(
+            "",
+            src_ds,
+            warpOptions=["SCALE_1=0,4080,0,255", "LUT=0:0,100:200,255:255"],
+            **options,
+        )
+        got = ds.GetRasterBand(1).ReadAsArray().astype("float64")
+        expected = ref_ds.GetRasterBand(1).ReadAsArray().astype("float64")
+        lut = numpy.interp(expected, [0, 100, 255], [0, 200, 255])
+        assert abs(got - lut).max() <= 1
+
+
+def test_warp_scale_invalid():
+
+    with pytest.raises(Exception, match="SCALE"):
+        gdal.Warp(
+            "", "../gcore/data/byte.tif", format="MEM", warpOptions=["SCALE=0,1"]
+        )
+
+
+###############################################################################
+# Test the PROFILING_REPORT warping option
+
+
+@pytest.mark.parametrize("num_chunk_threads", [None, 2])
+def test_warp_profiling_report(tmp_path, num_chunk_threads):
+
+    report_filename = str(tmp_path / "report.json")
+    warp_options = ["PROFILING_REPORT=" + report_filename]
+    if num_chunk_threads:
+        warp_options.append(f"NUM_CHUNK_THREADS={num_chunk_threads}")
+
+    for i in range(2):
+        gdal.Warp(
+            "",
+            "../gcore/data/byte.tif",
+            format="MEM",
+            outputBounds=[440720, 3750120, 441920, 3751320],
+            width=200,
+            height=200,
+            resampleAlg=gdal.GRIORA_Bilinear,
+            warpOptions=warp_options,
+            warpMemoryLimit=10000,
+            multithread=num_chunk_threads is not None,
+        )
+
+        with open(report_filename) as f:
+            report = json.load(f)
+        # Reports of subsequent operations are appended
+        assert len(report["operations"]) == i + 1
+
+    op = report["operations"][0]
+    assert op["source"] == "../gcore/data/byte.tif"
+    assert op["transform_grid"] == "none"
+    assert op["chunk_count"] > 1
+    assert len(op["chunks"]) == op["chunk_count"]
+    chunk = op["chunks"][0]
+    assert len(chunk["destination_window"]) == 4
+    assert len(chunk["source_window"]) == 4
+    assert chunk["kernel"].startswith("GWK")
+    assert chunk["kernel_threads"] >= 1
+    for key in (
+        "source_read_time",
+        "mask_time",
+        "kernel_time",
+        "destination_read_time",
+        "destination_write_time",
+    ):
+        assert chunk[key] >= 0
+        assert op["totals"][key] >= 0
+    kernel = op["kernels"][chunk["kernel"]]
+    assert kernel["chunk_count"] >= 1
+    assert 0 <= kernel["thread_utilization"] <= 1
+    assert 0 <= op["block_cache"]["hit_rate"] <= 1
+
+
+###############################################################################
+# Test nearest neighbour resampling with USE_OPENCL=TRUE against the CPU
+# kernels. When GDAL is not built with OpenCL, or when no device is available,
+# the CPU kernels are used in both cases.
+
+
+@pytest.mark.parametrize(
+    "dt", [gdal.GDT_Byte, gdal.GDT_Int16, gdal.GDT_UInt16, gdal.GDT_Float32]
+)
+@pytest.mark.parametrize("with_src_nodata", [False, True])
+def test_warp_nearest_opencl(dt, with_src_nodata):
+
+    src_nodata = None
+    if with_src_nodata:
+        # Value of the top-left pixel, which is present several times
+        src_nodata = struct.unpack(
+            "B", gdal.Open("../gcore/data/byte.tif").ReadRaster(0, 0, 1, 1)
+        )[0]
+    src_ds = gdal.Translate(
+        "", "../gcore/data/byte.tif", format="MEM", outputType=dt, noData=src_nodata
+    )
+    gt = src_ds.GetGeoTransform()
+
+    def warp(use_opencl):
+        # Destination prefilled with a value that must be kept where the
+        # source is invalid. Destination pixel centers are at a quarter of a
+        # source pixel from its edges, so that the same source pixel is
+        # picked whatever the precision of the computation.
+        dst_ds = gdal.GetDriverByName("MEM").Create("", 40, 40, 1, dt)
+        dst_ds.SetGeoTransform([gt[0], gt[1] / 2, 0, gt[3], 0, gt[5] / 2])
+        dst_ds.SetProjection(src_ds.GetProjectionRef())
+        dst_ds.GetRasterBand(1).Fill(7)
+        # Small memory limit to have several chunks of the same size, that
+        # reuse the same compiled OpenCL kernel
+        gdal.Warp(
+            dst_ds,
+            src_ds,
+            resampleAlg=gdal.GRIORA_NearestNeighbour,
+            warpMemoryLimit=1000,
+            warpOptions=["USE_OPENCL=" + use_opencl],
+        )
+        return dst_ds.GetRasterBand(1).ReadRaster()
+
+    ref = warp("FALSE")
+    assert warp("TRUE") == ref
+    # Second time, with the cached OpenCL context and kernels
+    assert warp("TRUE") == ref
+
+    ref_ds = gdal.GetDriverByName("MEM").Create("", 40, 40, 1, dt)
+    ref_ds.GetRasterBand(1).WriteRaster(0, 0, 40, 40, ref)
+    expected_ds = gdal.Translate(
+        "", src_ds, format="MEM", width=40, height=40, resampleAlg="near"
+    )
+    if src_nodata is None:
+        assert (
+            ref_ds.GetRasterBand(1).Checksum()
+            == expected_ds.GetRasterBand(1).Checksum()
+        )
+    else:
+        # Pixels at nodata in the source keep their initial value
+        src_vals = expected_ds.GetRasterBand(1).ReadRaster()
+        assert src_vals != ref
+        ref_ds.GetRasterBand(1).SetNoDataValue(7)
+        expected_ds.GetRasterBand(1).SetNoDataValue(src_nodata)
+        assert (
+            ref_ds.GetRasterBand(1).GetMaskBand().Checksum()
+            == expected_ds.GetRasterBand(1).GetMaskBand().Checksum()
+        )
+
+
+###############################################################################
+# Test that resampling all bands at once in the bilinear/cubic kernels gives
+# the same result as resampling them one by one
+
+
+@pytest.mark.parametrize("dt", [gdal.GDT_Byte, gdal.GDT_UInt16])
+@pytest.mark.parametrize("band_count", [3, 4])
+@pytest.mark.parametrize("resampling", ["bilinear", "cubic"])
+@pytest.mark.parametrize("mask", [None, "src_nodata", "dst_alpha"])
+def test_warp_multi_band_kernel(dt, band_count, resampling, mask):
+
+    byte_ds = gdal.Open("../gcore/data/byte.tif")
+    vals = byte_ds.ReadRaster()
+    src_ds = gdal.GetDriverByName("MEM").Create("", 20, 20, band_count, dt)
+    src_ds.SetGeoTransform(byte_ds.GetGeoTransform())
+    src_ds.SetProjection(byte_ds.GetProjectionRef())
+    for i in range(band_count):
+        if dt == gdal.GDT_Byte:
+            band_vals = struct.pack(
+                "B" * 400, *[(v + 37 * i) % 256 for v in bytearray(vals)]
+            )
+        else:
+            band_vals = struct.pack(
+                "H" * 400, *[v * 200 + 1000 * i for v in bytearray(vals)]
+            )
+        src_ds.GetRasterBand(i + 1).WriteRaster(0, 0, 20, 20, band_vals)
+        if mask == "src_nodata":
+            # Value of the top-left pixel, which is present several times
+            src_ds.GetRasterBand(i + 1).SetNoDataValue(
+                (107 + 37 * i) % 256 if dt == gdal.GDT_Byte else 107 * 200 + 1000 * i
+            )
+
+    # Upsampling, with destination pixel centers not aligned on source ones,
+    # and an extent larger than the source one to cover edge pixels
+    gt = src_ds.GetGeoTransform()
+    options = gdal.WarpOptions(
+        format="MEM",
+        outputBounds=[
+            gt[0] - 2 * gt[1],
+            gt[3] + 22 * gt[5],
+            gt[0] + 22 * gt[1],
+            gt[3] - 2 * gt[5],
+        ],
+        xRes=gt[1] / 2.7,
+        yRes=-gt[5] / 2.7,
+        resampleAlg=resampling,
+        dstAlpha=mask == "dst_alpha",
+    )
+
+    def warp(multi_band):
+        with gdal.config_option("GDAL_WARP_MULTI_BAND_KERNEL", multi_band):
+            out_ds = gdal.Warp("", src_ds, options=options)
+        return (
+            [
+                out_ds.GetRasterBand(i + 1).Checksum()
+                for i in range(out_ds.RasterCount)
+            ],
+            out_ds.ReadRaster(),
+        )
+
+    ref_checksums, ref_data = warp("NO")
+    assert len(ref_checksums) == band_count + (1 if mask == "dst_alpha" else 0)
+    assert len(set(ref_checksums[0:band_count])) == band_count
+    checksums, data = warp("YES")
+    assert checksums == ref_checksums
+    assert data == ref_data
@@ -29,9 +29,16 @@
 
 #include "gdal_unit_test.h"
 
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "cpl_conv.h"
 
 #include "gdal_alg.h"
+#include "ogrsf_frmts.h"
 #include "gdalwarper.h"
 #include "gdal_priv.h"
 
@@ -273,4 +280,653 @@ TEST_F(test_alg, GDALAutoCreateWarpedVRT_alpha_band)
     GDALClose(hWarpedVRT);
 }
 
+// Test GDALViewshedGenerate() with several threads and
+// GDALViewshedGenerateCumulative() against individual viewsheds
+TEST_F(test_alg, GDALViewshedGenerateCumulative)
+{
+    constexpr int nXSize = 64;
+    constexpr int nYSize = 48;
+    GDALDatasetUniquePtr poDS(
+        GDALDriver::FromHandle(GDALGetDriverByName("MEM"))
+            ->Create("", nXSize, nYSize, 1, GDT_Float32, nullptr));
+    double adfGeoTransform[6] = {1000, 10, 0, 2000, 0, -10};
+    poDS->SetGeoTransform(adfGeoTransform);
+    std::vector<float> afDEM(nXSize * nYSize);
+    for (int i = 0; i < nXSize * nYSize; i++)
+        afDEM[i] = static_cast<float>((i * 7919) % 101);
+    ASSERT_EQ(poDS->GetRasterBand(1)->RasterIO(
+                  GF_Write, 0, 0, nXSize, nYSize, afDEM.data(), nXSize, nYSize,
+                  GDT_Float32, 0, 0, nullptr),
+              CE_None);
+    GDALRasterBandH hBand = GDALRasterBand::ToHandle(poDS->GetRasterBand(1));
+
+    const double adfObserverX[] = {1005, 1325, 1633};
+    const double adfObserverY[] = {1995, 1755, 1525};
+    std::vector<GUInt32> anExpected(nXSize * nYSize);
+    for (int iObs = 0; iObs < 3; iObs++)
+    {
+        std::vector<GByte> abyRef;
+        for (const char *pszNumThreads : {"1", "4"})
+        {
+            CPLStringList aosOptions;
+            aosOptions.SetNameValue("NUM_THREADS", pszNumThreads);
+            GDALDatasetH hViewshed = GDALViewshedGenerate(
+                hBand, "MEM", "", nullptr, adfObserverX[iObs],
+                adfObserverY[iObs], 5, 0, 1, 0, 0, -1, 0, GVM_Edge, 0,
+                nullptr, nullptr, GVOT_NORMAL, aosOptions.List());
+            ASSERT_TRUE(hViewshed != nullptr);
+            std::vector<GByte> abyVisible(nXSize * nYSize);
+            EXPECT_EQ(GDALRasterIO(GDALGetRasterBand(hViewshed, 1), GF_Read, 0,
+                                   0, nXSize, nYSize, abyVisible.data(),
+                                   nXSize, nYSize, GDT_Byte, 0, 0),
+                      CE_None);
+            GDALClose(hViewshed);
+            if (abyRef.empty())
+                abyRef = abyVisible;
+            else
+                EXPECT_EQ(abyVisible, abyRef);
+        }
+        for (int i = 0; i < nXSize * nYSize; i++)
+            anExpected[i] += abyRef[i];
+    }
+
+    for (const char *pszNumThreads : {"1", "4"})
+    {
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("NUM_THREADS", pszNumThreads);
+        GDALDatasetH hCumulative = GDALViewshedGenerateCumulative(
+            hBand, "MEM", "", nullptr, 3, adfObserverX, adfObserverY, 5, 0, 0,
+            GVM_Edge, 0, nullptr, nullptr, aosOptions.List());
+        ASSERT_TRUE(hCumulative != nullptr);
+        std::vector<GUInt32> anCounts(nXSize * nYSize);
+        EXPECT_EQ(GDALRasterIO(GDALGetRasterBand(hCumulative, 1), GF_Read, 0,
+                               0, nXSize, nYSize, anCounts.data(), nXSize,
+                               nYSize, GDT_UInt32, 0, 0),
+                  CE_None);
+        GDALClose(hCumulative);
+        EXPECT_EQ(anCounts, anExpected);
+    }
+}
+
+// Test GDALCompareRasterBands()
+TEST_F(test_alg, GDALCompareRasterBands)
+{
+    GDALDriver *poDriver = GDALDriver::FromHandle(GDALGetDriverByName("GTiff"));
+    if (poDriver == nullptr)
+    {
+        GTEST_SKIP() << "GTiff driver missing";
+    }
+
+    constexpr int nXSize = 300;
+    constexpr int nYSize = 200;
+    const char *const apszOptions[] = {"TILED=YES", "BLOCKXSIZE=64",
+                                       "BLOCKYSIZE=64", nullptr};
+    std::vector<float> afValues(nXSize * nYSize);
+    for (int i = 0; i < nXSize * nYSize; i++)
+        afValues[i] = static_cast<float>((i * 7919) % 1009) / 4;
+    afValues[5 * nXSize + 5] = std::numeric_limits<float>::quiet_NaN();
+    for (const char *pszFilename :
+         {"/vsimem/test_compare_1.tif", "/vsimem/test_compare_2.tif"})
+    {
+        auto poDS = std::unique_ptr<GDALDataset>(poDriver->Create(
+            pszFilename, nXSize, nYSize, 1, GDT_Float32, apszOptions));
+        ASSERT_TRUE(poDS != nullptr);
+        ASSERT_EQ(poDS->GetRasterBand(1)->RasterIO(
+                      GF_Write, 0, 0, nXSize, nYSize, afValues.data(), nXSize,
+                      nYSize, GDT_Float32, 0, 0, nullptr),
+                  CE_None);
+        // Differences in the second file
+        afValues[20 * nXSize + 10] += 5;
+        afValues[150 * nXSize + 250] -= 2;
+        afValues[180 * nXSize + 290] += 5;
+        afValues[6 * nXSize + 6] = std::numeric_limits<float>::quiet_NaN();
+    }
+
+    auto poDS1 = std::unique_ptr<GDALDataset>(
+        GDALDataset::Open("/vsimem/test_compare_1.tif", GDAL_OF_RASTER));
+    auto poDS2 = std::unique_ptr<GDALDataset>(
+        GDALDataset::Open("/vsimem/test_compare_2.tif", GDAL_OF_RASTER));
+    ASSERT_TRUE(poDS1 != nullptr);
+    ASSERT_TRUE(poDS2 != nullptr);
+    GDALRasterBandH hBand1 = GDALRasterBand::ToHandle(poDS1->GetRasterBand(1));
+    GDALRasterBandH hBand2 = GDALRasterBand::ToHandle(poDS2->GetRasterBand(1));
+
+    for (const char *pszNumThreads : {"1", "4"})
+    {
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("NUM_THREADS", pszNumThreads);
+        GDALRasterBandDiffStats sStats;
+        ASSERT_EQ(GDALCompareRasterBands(hBand1, hBand2, aosOptions.List(),
+                                         &sStats, nullptr, nullptr),
+                  CE_None);
+        EXPECT_EQ(sStats.nPixelCount, static_cast<GUIntBig>(nXSize * nYSize));
+        // 3 value differences and 1 NaN vs non-NaN difference
+        EXPECT_EQ(sStats.nDiffCount, 4U);
+        EXPECT_EQ(sStats.dfMaxAbsDiff, 5.0);
+        // Ties are resolved with the first chunk
+        EXPECT_EQ(sStats.nMaxAbsDiffX, 10);
+        EXPECT_EQ(sStats.nMaxAbsDiffY, 20);
+        // Both-NaN and NaN vs non-NaN pixels are excluded
+        const double dfValidCount = nXSize * nYSize - 2;
+        EXPECT_NEAR(sStats.dfMeanAbsDiff, 12.0 / dfValidCount, 1e-12);
+        EXPECT_NEAR(sStats.dfRMSDiff, std::sqrt(54.0 / dfValidCount), 1e-12);
+    }
+
+    // Comparing a band with itself
+    {
+        GDALRasterBandDiffStats sStats;
+        ASSERT_EQ(GDALCompareRasterBands(hBand1, hBand1, nullptr, &sStats,
+                                         nullptr, nullptr),
+                  CE_None);
+        EXPECT_EQ(sStats.nDiffCount, 0U);
+        EXPECT_EQ(sStats.dfMaxAbsDiff, 0.0);
+        EXPECT_EQ(sStats.nMaxAbsDiffX, -1);
+        EXPECT_EQ(sStats.nMaxAbsDiffY, -1);
+        EXPECT_EQ(sStats.dfMeanAbsDiff, 0.0);
+        EXPECT_EQ(sStats.dfRMSDiff, 0.0);
+    }
+
+    poDS1.reset();
+    poDS2.reset();
+    VSIUnlink("/vsimem/test_compare_1.tif");
+    VSIUnlink("/vsimem/test_compare_2.tif");
+}
+
+// Test GDALCompareRasterBands() on complex and mismatched bands
+TEST_F(test_alg, GDALCompareRasterBands_complex_and_errors)
+{
+    auto poMEMDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (poMEMDriver == nullptr)
+    {
+        GTEST_SKIP() << "MEM driver missing";
+    }
+    auto poDS1 = std::unique_ptr<GDALDataset>(
+        poMEMDriver->Create("", 10, 10, 1, GDT_CFloat32, nullptr));
+    auto poDS2 = std::unique_ptr<GDALDataset>(
+        poMEMDriver->Create("", 10, 10, 1, GDT_Float32, nullptr));
+    auto poDS3 = std::unique_ptr<GDALDataset>(
+        poMEMDriver->Create("", 10, 11, 1, GDT_Float32, nullptr));
+    const float afValue[2] = {3, 4};
+    ASSERT_EQ(poDS1->GetRasterBand(1)->RasterIO(GF_Write, 2, 3, 1, 1,
+                                                const_cast<float *>(afValue),
+                                                1, 1, GDT_CFloat32, 0, 0,
+                                                nullptr),
+              CE_None);
+
+    GDALRasterBandDiffStats sStats;
+    // Non thread-safe bands are compared from the calling thread
+    CPLStringList aosOptions;
+    aosOptions.SetNameValue("NUM_THREADS", "4");
+    ASSERT_EQ(GDALCompareRasterBands(
+                  GDALRasterBand::ToHandle(poDS1->GetRasterBand(1)),
+                  GDALRasterBand::ToHandle(poDS2->GetRasterBand(1)),
+                  aosOptions.List(), &sStats, nullptr, nullptr),
+              CE_None);
+    EXPECT_EQ(sStats.nPixelCount, 100U);
+    EXPECT_EQ(sStats.nDiffCount, 1U);
+    EXPECT_EQ(sStats.dfMaxAbsDiff, 5.0);
+    EXPECT_EQ(sStats.nMaxAbsDiffX, 2);
+    EXPECT_EQ(sStats.nMaxAbsDiffY, 3);
+    EXPECT_NEAR(sStats.dfMeanAbsDiff, 0.05, 1e-12);
+    EXPECT_NEAR(sStats.dfRMSDiff, 0.5, 1e-12);
+
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    EXPECT_EQ(GDALCompareRasterBands(
+                  GDALRasterBand::ToHandle(poDS2->GetRasterBand(1)),
+                  GDALRasterBand::ToHandle(poDS3->GetRasterBand(1)), nullptr,
+                  &sStats, nullptr, nullptr),
+              CE_Failure);
+    CPLPopErrorHandler();
+}
+
+// Create a 10x10 raster whose pixel (x,y) has value 10 * y + x, and a
+// layer of zones with a "name" field.
+static void GDALZonalStatisticsCreateTestData(
+    std::unique_ptr<GDALDataset> &poRasterDS,
+    std::unique_ptr<GDALDataset> &poZonesDS,
+    const std::vector<std::string> &aosWKT)
+{
+    auto poMEMDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+    poRasterDS.reset(poMEMDriver->Create("", 10, 10, 1, GDT_Byte, nullptr));
+    double adfGeoTransform[6] = {0, 1, 0, 10, 0, -1};
+    poRasterDS->SetGeoTransform(adfGeoTransform);
+    std::vector<GByte> abyValues(100);
+    for (int i = 0; i < 100; i++)
+        abyValues[i] = static_cast<GByte>(i);
+    ASSERT_EQ(poRasterDS->GetRasterBand(1)->RasterIO(
+                  GF_Write, 0, 0, 10, 10, abyValues.data(), 10, 10, GDT_Byte,
+                  0, 0, nullptr),
+              CE_None);
+
+    auto poMemoryDriver =
+        GetGDALDriverManager()->GetDriverByName("Memory");
+    poZonesDS.reset(
+        poMemoryDriver->Create("", 0, 0, 0, GDT_Unknown, nullptr));
+    OGRLayer *poLayer = poZonesDS->CreateLayer("zones", nullptr, wkbPolygon);
+    OGRFieldDefn oFieldDefn("name", OFTString);
+    ASSERT_EQ(poLayer->CreateField(&oFieldDefn), OGRERR_NONE);
+    for (size_t i = 0; i < aosWKT.size(); ++i)
+    {
+        OGRFeature oFeature(poLayer->GetLayerDefn());
+        oFeature.SetField(0, CPLSPrintf("zone%d", static_cast<int>(i)));
+        OGRGeometry *poGeom = nullptr;
+        OGRGeometryFactory::createFromWkt(aosWKT[i].c_str(), nullptr, &poGeom);
+        oFeature.SetGeometryDirectly(poGeom);
+        ASSERT_EQ(poLayer->CreateFeature(&oFeature), OGRERR_NONE);
+    }
+}
+
+// Run GDALZonalStatistics() and return the output layer
+static OGRLayer *GDALZonalStatisticsRun(GDALDataset *poRasterDS,
+                                        GDALDataset *poZonesDS,
+                                        std::unique_ptr<GDALDataset> &poOutDS,
+                                        CSLConstList papszOptions,
+                                        OGRwkbGeometryType eGType = wkbNone)
+{
+    auto poMemoryDriver =
+        GetGDALDriverManager()->GetDriverByName("Memory");
+    poOutDS.reset(poMemoryDriver->Create("", 0, 0, 0, GDT_Unknown, nullptr));
+    OGRLayer *poOutLayer = poOutDS->CreateLayer("out", nullptr, eGType);
+    if (GDALZonalStatistics(GDALDataset::ToHandle(poRasterDS), 0, nullptr,
+                            OGRLayer::ToHandle(poZonesDS->GetLayer(0)),
+                            OGRLayer::ToHandle(poOutLayer), papszOptions,
+                            nullptr, nullptr) != CE_None)
+    {
+        return nullptr;
+    }
+    return poOutLayer;
+}
+
+// Test GDALZonalStatistics() with the center, all touched and fractional
+// coverage modes
+TEST_F(test_alg, GDALZonalStatistics_coverage_modes)
+{
+    if (GetGDALDriverManager()->GetDriverByName("Memory") == nullptr)
+    {
+        GTEST_SKIP() << "Memory driver missing";
+    }
+    std::unique_ptr<GDALDataset> poRasterDS;
+    std::unique_ptr<GDALDataset> poZonesDS;
+    // Pixel coordinates from 2.6 to 4.4 in both directions
+    GDALZonalStatisticsCreateTestData(
+        poRasterDS, poZonesDS,
+        {"POLYGON((2.6 7.4,4.4 7.4,4.4 5.6,2.6 5.6,2.6 7.4))"});
+
+    std::unique_ptr<GDALDataset> poOutDS;
+    {
+        OGRLayer *poOutLayer = GDALZonalStatisticsRun(
+            poRasterDS.get(), poZonesDS.get(), poOutDS, nullptr);
+        ASSERT_TRUE(poOutLayer != nullptr);
+        ASSERT_EQ(poOutLayer->GetFeatureCount(), 1);
+        auto poFeature =
+            std::unique_ptr<OGRFeature>(poOutLayer->GetNextFeature());
+        EXPECT_STREQ(poFeature->GetFieldAsString("name"), "zone0");
+        // Only the center of pixel (3,3) is in the zone
+        EXPECT_EQ(poFeature->GetFieldAsInteger64("count"), 1);
+        EXPECT_EQ(poFeature->GetFieldAsDouble("sum"), 33.0);
+        EXPECT_EQ(poFeature->GetFieldAsDouble("mean"), 33.0);
+        EXPECT_EQ(poFeature->GetFieldAsDouble("min"), 33.0);
+        EXPECT_EQ(poFeature->GetFieldAsDouble("max"), 33.0);
+    }
+
+    {
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("ALL_TOUCHED", "YES");
+        OGRLayer *poOutLayer = GDALZonalStatisticsRun(
+            poRasterDS.get(), poZonesDS.get(), poOutDS, aosOptions.List());
+        ASSERT_TRUE(poOutLayer != nullptr);
+        auto poFeature =
+            std::unique_ptr<OGRFeature>(poOutLayer->GetNextFeature());
+        // Pixels (2..4, 2..4)
+        EXPECT_EQ(poFeature->GetFieldAsInteger64("count"), 9);
+        EXPECT_EQ(poFeature->GetFieldAsDouble("sum"), 297.0);
+        EXPECT_EQ(poFeature->GetFieldAsDouble("min"), 22.0);
+        EXPECT_EQ(poFeature->GetFieldAsDouble("max"), 44.0);
+    }
+
+    {
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("COVERAGE", "FRACTIONAL");
+        OGRLayer *poOutLayer = GDALZonalStatisticsRun(
+            poRasterDS.get(), poZonesDS.get(), poOutDS, aosOptions.List());
+        ASSERT_TRUE(poOutLayer != nullptr);
+        const auto poDefn = poOutLayer->GetLayerDefn();
+        EXPECT_EQ(poDefn->GetFieldDefn(poDefn->GetFieldIndex("count"))
+                      ->GetType(),
+                  OFTReal);
+        auto poFeature =
+            std::unique_ptr<OGRFeature>(poOutLayer->GetNextFeature());
+        // 3 of 8 sub-pixels of border pixels are covered in each direction,
+        // for an exact coverage of 1.8 x 1.8 pixels.
+        EXPECT_NEAR(poFeature->GetFieldAsDouble("count"), 1.75 * 1.75, 1e-10);
+        EXPECT_NEAR(poFeature->GetFieldAsDouble("mean"), 33.0, 1e-10);
+        EXPECT_EQ(poFeature->GetFieldAsDouble("min"), 22.0);
+        EXPECT_EQ(poFeature->GetFieldAsDouble("max"), 44.0);
+    }
+
+    {
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("COVERAGE", "FRACTIONAL");
+        aosOptions.SetNameValue("ALL_TOUCHED", "YES");
+        CPLErrorStateBackuper oErrorStateBackuper;
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        EXPECT_EQ(GDALZonalStatisticsRun(poRasterDS.get(), poZonesDS.get(),
+                                         poOutDS, aosOptions.List()),
+                  nullptr);
+    }
+}
+
+// Test GDALZonalStatistics() histograms and INCLUDE_FIELDS/INCLUDE_GEOMETRY
+TEST_F(test_alg, GDALZonalStatistics_histogram_and_fields)
+{
+    if (GetGDALDriverManager()->GetDriverByName("Memory") == nullptr)
+    {
+        GTEST_SKIP() << "Memory driver missing";
+    }
+    std::unique_ptr<GDALDataset> poRasterDS;
+    std::unique_ptr<GDALDataset> poZonesDS;
+    // Pixels (2..4, 2..4), and a zone outside of the raster
+    GDALZonalStatisticsCreateTestData(
+        poRasterDS, poZonesDS,
+        {"POLYGON((2 8,5 8,5 5,2 5,2 8))",
+         "POLYGON((20 8,25 8,25 5,20 5,20 8))"});
+
+    std::unique_ptr<GDALDataset> poOutDS;
+    {
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("STATS", "count,histogram");
+        aosOptions.SetNameValue("HISTOGRAM_BINS", "4");
+        aosOptions.SetNameValue("HISTOGRAM_MIN", "0");
+        aosOptions.SetNameValue("HISTOGRAM_MAX", "100");
+        aosOptions.SetNameValue("INCLUDE_FIELDS", "NO");
+        OGRLayer *poOutLayer = GDALZonalStatisticsRun(
+            poRasterDS.get(), poZonesDS.get(), poOutDS, aosOptions.List());
+        ASSERT_TRUE(poOutLayer != nullptr);
+        const auto poDefn = poOutLayer->GetLayerDefn();
+        EXPECT_EQ(poDefn->GetFieldIndex("name"), -1);
+        EXPECT_EQ(poDefn->GetFieldIndex("mean"), -1);
+        ASSERT_EQ(poOutLayer->GetFeatureCount(), 2);
+        auto poFeature =
+            std::unique_ptr<OGRFeature>(poOutLayer->GetNextFeature());
+        EXPECT_EQ(poFeature->GetFieldAsInteger64("count"), 9);
+        // 22, 23, 24 in [0,25[, and 32..34, 42..44 in [25,50[
+        EXPECT_STREQ(poFeature->GetFieldAsString("histogram"), "3,6,0,0");
+        EXPECT_EQ(poFeature->GetGeometryRef(), nullptr);
+        poFeature.reset(poOutLayer->GetNextFeature());
+        EXPECT_EQ(poFeature->GetFieldAsInteger64("count"), 0);
+        EXPECT_STREQ(poFeature->GetFieldAsString("histogram"), "0,0,0,0");
+    }
+
+    {
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("STATS", "mean");
+        aosOptions.SetNameValue("INCLUDE_GEOMETRY", "YES");
+        OGRLayer *poOutLayer =
+            GDALZonalStatisticsRun(poRasterDS.get(), poZonesDS.get(), poOutDS,
+                                   aosOptions.List(), wkbPolygon);
+        ASSERT_TRUE(poOutLayer != nullptr);
+        auto poFeature =
+            std::unique_ptr<OGRFeature>(poOutLayer->GetNextFeature());
+        EXPECT_STREQ(poFeature->GetFieldAsString("name"), "zone0");
+        EXPECT_EQ(poFeature->GetFieldAsDouble("mean"), 33.0);
+        ASSERT_TRUE(poFeature->GetGeometryRef() != nullptr);
+        EXPECT_EQ(poFeature->GetGeometryRef()->toPolygon()->get_Area(), 9.0);
+        poFeature.reset(poOutLayer->GetNextFeature());
+        EXPECT_STREQ(poFeature->GetFieldAsString("name"), "zone1");
+        EXPECT_FALSE(poFeature->IsFieldSetAndNotNull(
+            poFeature->GetFieldIndex("mean")));
+    }
+}
+
+// Test that GDALZonalStatistics() gives the same results with several
+// threads, and on a single strip raster processed by windows of lines
+TEST_F(test_alg, GDALZonalStatistics_multithreaded)
+{
+    auto poGTiffDriver = GetGDALDriverManager()->GetDriverByName("GTiff");
+    if (poGTiffDriver == nullptr ||
+        GetGDALDriverManager()->GetDriverByName("Memory") == nullptr)
+    {
+        GTEST_SKIP() << "GTiff or Memory driver missing";
+    }
+
+    constexpr int nXSize = 1500;
+    constexpr int nYSize = 1200;
+    const char *const apszOptions[] = {"BLOCKYSIZE=1200", nullptr};
+    auto poRasterDS = std::unique_ptr<GDALDataset>(
+        poGTiffDriver->Create("/vsimem/test_zonalstats_strip.tif", nXSize,
+                              nYSize, 1, GDT_Int16, apszOptions));
+    ASSERT_TRUE(poRasterDS != nullptr);
+    double adfGeoTransform[6] = {0, 1, 0, nYSize, 0, -1};
+    poRasterDS->SetGeoTransform(adfGeoTransform);
+    std::vector<GInt16> anValues(nXSize * nYSize);
+    for (int i = 0; i < nXSize * nYSize; i++)
+        anValues[i] = static_cast<GInt16>((i * 7919) % 10007);
+    ASSERT_EQ(poRasterDS->GetRasterBand(1)->RasterIO(
+                  GF_Write, 0, 0, nXSize, nYSize, anValues.data(), nXSize,
+                  nYSize, GDT_Int16, 0, 0, nullptr),
+              CE_None);
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poRasterDS->GetRasterBand(1)->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    EXPECT_EQ(nBlockYSize, nYSize);
+
+    // Same raster in memory, with one line blocks
+    auto poMEMDS = std::unique_ptr<GDALDataset>(
+        GetGDALDriverManager()->GetDriverByName("MEM")->CreateCopy(
+            "", poRasterDS.get(), false, nullptr, nullptr, nullptr));
+    ASSERT_TRUE(poMEMDS != nullptr);
+
+    auto poMemoryDriver = GetGDALDriverManager()->GetDriverByName("Memory");
+    auto poZonesDS = std::unique_ptr<GDALDataset>(
+        poMemoryDriver->Create("", 0, 0, 0, GDT_Unknown, nullptr));
+    OGRLayer *poZonesLayer =
+        poZonesDS->CreateLayer("zones", nullptr, wkbPolygon);
+    for (int i = 0; i < 200; ++i)
+    {
+        // Triangles spread over the raster, some crossing window limits
+        const double dfX = (i * 137) % (nXSize - 100);
+        const double dfY = (i * 251) % (nYSize - 300);
+        const double dfSize = 10 + (i * 31) % 290;
+        OGRFeature oFeature(poZonesLayer->GetLayerDefn());
+        OGRGeometry *poGeom = nullptr;
+        OGRGeometryFactory::createFromWkt(
+            CPLSPrintf("POLYGON((%f %f,%f %f,%f %f,%f %f))", dfX + 0.3,
+                       dfY + 0.7, dfX + dfSize / 3, dfY + dfSize,
+                       dfX + 97.1, dfY + dfSize / 2, dfX + 0.3, dfY + 0.7),
+            nullptr, &poGeom);
+        oFeature.SetGeometryDirectly(poGeom);
+        ASSERT_EQ(poZonesLayer->CreateFeature(&oFeature), OGRERR_NONE);
+    }
+
+    const auto GetResults = [&poZonesDS](GDALDataset *poDS,
+                                         const char *pszNumThreads,
+                                         const char *pszCoverage)
+    {
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("NUM_THREADS", pszNumThreads);
+        aosOptions.SetNameValue("COVERAGE", pszCoverage);
+        aosOptions.SetNameValue("STATS", "count,sum,min,max,histogram");
+        aosOptions.SetNameValue("HISTOGRAM_BINS", "16");
+        aosOptions.SetNameValue("HISTOGRAM_MIN", "0");
+        aosOptions.SetNameValue("HISTOGRAM_MAX", "10007");
+        std::unique_ptr<GDALDataset> poOutDS;
+        OGRLayer *poOutLayer = GDALZonalStatisticsRun(
+            poDS, poZonesDS.get(), poOutDS, aosOptions.List());
+        std::vector<std::string> aosResults;
+        if (poOutLayer)
+        {
+            for (auto &&poFeature : *poOutLayer)
+            {
+                std::string osLine;
+                for (int i = 0; i < poFeature->GetFieldCount(); ++i)
+                {
+                    osLine += poFeature->GetFieldAsString(i);
+                    osLine += ';';
+                }
+                aosResults.push_back(osLine);
+            }
+        }
+        return aosResults;
+    };
+
+    for (const char *pszCoverage : {"CENTER", "FRACTIONAL"})
+    {
+        const auto aosRef = GetResults(poMEMDS.get(), "1", pszCoverage);
+        ASSERT_EQ(aosRef.size(), 200U);
+        EXPECT_EQ(GetResults(poMEMDS.get(), "4", pszCoverage), aosRef);
+        EXPECT_EQ(GetResults(poRasterDS.get(), "1", pszCoverage), aosRef);
+        EXPECT_EQ(GetResults(poRasterDS.get(), "4", pszCoverage), aosRef);
+    }
+
+    poRasterDS.reset();
+    VSIUnlink("/vsimem/test_zonalstats_strip.tif");
+}
+
+// Test that transforming points by batches gives the same results as
+// transforming them one at a time, including for failed points
+TEST_F(test_alg, GDALGenImgProjTransform_batch)
+{
+    const double adfSrcGT[6] = {2.5, 0.125, 0.01, 49.75, 0.02, -0.1};
+    const double adfDstGT[6] = {-7e6, 1e4, 0, 7e6, 0, -1e4};
+    // Orthographic projection: destination points outside of the disk of
+    // the Earth fail to transform
+    OGRSpatialReference oSrcSRS;
+    oSrcSRS.importFromEPSG(4326);
+    oSrcSRS.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+    char *pszSrcWKT = nullptr;
+    oSrcSRS.exportToWkt(&pszSrcWKT);
+    const char *pszDstWKT =
+        "PROJCS[\"Ortho\",GEOGCS[\"WGS 84\",DATUM[\"WGS_1984\","
+        "SPHEROID[\"WGS 84\",6378137,298.257223563]],PRIMEM[\"Greenwich\",0],"
+        "UNIT[\"degree\",0.0174532925199433]],"
+        "PROJECTION[\"Orthographic\"],PARAMETER[\"latitude_of_origin\",0],"
+        "PARAMETER[\"central_meridian\",0],PARAMETER[\"false_easting\",0],"
+        "PARAMETER[\"false_northing\",0],UNIT[\"metre\",1]]";
+
+    for (const bool bReproject : {false, true})
+    {
+        void *hTransformArg = GDALCreateGenImgProjTransformer3(
+            bReproject ? pszSrcWKT : nullptr, adfSrcGT,
+            bReproject ? pszDstWKT : nullptr, adfDstGT);
+        ASSERT_NE(hTransformArg, nullptr);
+
+        // Odd number of points, to also go through the scalar tail
+        constexpr int N = 1001;
+        for (const int bDstToSrc : {TRUE, FALSE})
+        {
+            std::vector<double> adfX(N), adfY(N), adfZ(N);
+            for (int i = 0; i < N; ++i)
+            {
+                if (bDstToSrc)
+                {
+                    adfX[i] = (i % 37) * 37.5 - 100.25;
+                    adfY[i] = (i / 37) * 50.75 - 100.5;
+                }
+                else
+                {
+                    adfX[i] = (i % 37) * 0.75 + 0.25;
+                    adfY[i] = (i / 37) * 0.5 + 0.125;
+                }
+            }
+            std::vector<double> adfXRef(adfX), adfYRef(adfY), adfZRef(adfZ);
+            std::vector<int> anSuccess(N), anSuccessRef(N);
+
+            CPLPushErrorHandler(CPLQuietErrorHandler);
+            GDALGenImgProjTransform(hTransformArg, bDstToSrc, N, adfX.data(),
+                                    adfY.data(), adfZ.data(),
+                                    anSuccess.data());
+            for (int i = 0; i < N; ++i)
+            {
+                GDALGenImgProjTransform(hTransformArg, bDstToSrc, 1,
+                                        &adfXRef[i], &adfYRef[i],
+                                        &adfZRef[i], &anSuccessRef[i]);
+            }
+            CPLPopErrorHandler();
+
+            int nFailed = 0;
+            for (int i = 0; i < N; ++i)
+            {
+                EXPECT_EQ(anSuccess[i], anSuccessRef[i]) << i;
+                if (!anSuccess[i])
+                {
+                    ++nFailed;
+                    continue;
+                }
+                EXPECT_EQ(adfX[i], adfXRef[i]) << i;
+                EXPECT_EQ(adfY[i], adfYRef[i]) << i;
+            }
+            if (bReproject && bDstToSrc)
+            {
+                // Mix of failed and successful points
+                EXPECT_GT(nFailed, 0);
+                EXPECT_LT(nFailed, N);
+            }
+            else if (!bReproject)
+            {
+                EXPECT_EQ(nFailed, 0);
+            }
+        }
+        GDALDestroyGenImgProjTransformer(hTransformArg);
+    }
+    CPLFree(pszSrcWKT);
+}
+
+// Test the interpolation done by the approximate transformer on an affine
+// transformation, where no subdivision is needed
+TEST_F(test_alg, GDALApproxTransform_interpolation)
+{
+    const double adfSrcGT[6] = {2.5, 0.125, 0.01, 49.75, 0.02, -0.1};
+    const double adfDstGT[6] = {1.5, 0.25, 0, 50.5, 0, -0.25};
+    void *hGenImgProjArg = GDALCreateGenImgProjTransformer3(
+        nullptr, adfSrcGT, nullptr, adfDstGT);
+    ASSERT_NE(hGenImgProjArg, nullptr);
+    void *hApproxArg = GDALCreateApproxTransformer(GDALGenImgProjTransform,
+                                                   hGenImgProjArg, 0.125);
+    ASSERT_NE(hApproxArg, nullptr);
+
+    for (const int N : {1000, 1001})
+    {
+        for (const int bDstToSrc : {TRUE, FALSE})
+        {
+            std::vector<double> adfX(N), adfY(N, 10.5), adfZ(N);
+            for (int i = 0; i < N; ++i)
+                adfX[i] = i + 0.5;
+            std::vector<int> anSuccess(N);
+            std::vector<double> adfXExact(adfX), adfYExact(adfY),
+                adfZExact(adfZ);
+            std::vector<int> anSuccessExact(N);
+
+            ASSERT_TRUE(GDALApproxTransform(hApproxArg, bDstToSrc, N,
+                                            adfX.data(), adfY.data(),
+                                            adfZ.data(), anSuccess.data()));
+            ASSERT_TRUE(GDALGenImgProjTransform(
+                hGenImgProjArg, bDstToSrc, N, adfXExact.data(),
+                adfYExact.data(), adfZExact.data(), anSuccessExact.data()));
+
+            // Linear interpolation between the transformed end points
+            const double dfX0 = adfXExact[0];
+            const double dfY0 = adfYExact[0];
+            const double dfDeltaX =
+                (adfXExact[N - 1] - dfX0) / (N - 1 + 0.5 - 0.5);
+            const double dfDeltaY =
+                (adfYExact[N - 1] - dfY0) / (N - 1 + 0.5 - 0.5);
+            for (int i = 0; i < N; ++i)
+            {
+                EXPECT_TRUE(anSuccess[i]) << i;
+                if (i > 0 && i < N - 1)
+                {
+                    const double dfDist = (i + 0.5) - 0.5;
+                    EXPECT_EQ(adfX[i], dfX0 + dfDeltaX * dfDist) << i;
+                    EXPECT_EQ(adfY[i], dfY0 + dfDeltaY * dfDist) << i;
+                }
+                EXPECT_NEAR(adfX[i], adfXExact[i], 1e-8) << i;
+                EXPECT_NEAR(adfY[i], adfYExact[i], 1e-8) << i;
+            }
+        }
+    }
+
+    GDALDestroyApproxTransformer(hApproxArg);
+    GDALDestroyGenImgProjTransformer(hGenImgProjArg);
+}
+
 }  // namespace
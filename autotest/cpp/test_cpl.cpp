@@ -55,11 +55,16 @@
 #include "cpl_worker_thread_pool.h"
 #include "cpl_vsi_virtual.h"
 #include "cpl_threadsafe_queue.hpp"
+#include "cpl_trace.h"
 
+#include <algorithm>
 #include <atomic>
+#include <cinttypes>
 #include <limits>
+#include <map>
 #include <fstream>
 #include <string>
+#include <thread>
 
 #include "gtest_include.h"
 
@@ -1118,6 +1123,42 @@ TEST_F(test_cpl, CPLString_replaceAll)
     ASSERT_EQ(osTest, "fooBarBarfoo");
 }
 
+/************************************************************************/
+/*                           VSIMallocLarge()                           */
+/************************************************************************/
+TEST_F(test_cpl, VSIMallocLarge)
+{
+    GByte *ptr = static_cast<GByte *>(VSIMallocLarge(1));
+    ASSERT_TRUE(ptr != nullptr);
+    EXPECT_EQ(reinterpret_cast<size_t>(ptr) % 64, 0U);
+    *ptr = 1;
+    VSIFreeLarge(ptr);
+
+    VSIFreeLarge(nullptr);
+
+    constexpr size_t SIZE = 3 * 1024 * 1024;
+    for (const char *pszHugePages : {"NO", "YES"})
+    {
+        CPLConfigOptionSetter oSetterHugePages("GDAL_LARGE_BUFFER_HUGE_PAGES",
+                                               pszHugePages, false);
+        CPLConfigOptionSetter oSetterPool("GDAL_LARGE_BUFFER_POOL_SIZE", "16",
+                                          false);
+        ptr = static_cast<GByte *>(VSIMallocLarge(SIZE));
+        ASSERT_TRUE(ptr != nullptr);
+        EXPECT_EQ(reinterpret_cast<size_t>(ptr) % 64, 0U);
+        memset(ptr, 1, SIZE);
+        VSIFreeLarge(ptr);
+
+        GByte *ptr2 = static_cast<GByte *>(VSIMallocLarge(SIZE));
+        ASSERT_TRUE(ptr2 != nullptr);
+#if defined(__linux__)
+        // Re-used from the pool of released buffers
+        EXPECT_EQ(ptr2, ptr);
+#endif
+        VSIFreeLarge(ptr2);
+    }
+}
+
 /************************************************************************/
 /*                        VSIMallocAligned()                            */
 /************************************************************************/
@@ -2343,6 +2384,54 @@ TEST_F(test_cpl, CPLJSonStreamingParser)
     }
 }
 
+// Test CPLJSonStreamingParser() with long strings and numbers, processed by
+// the bulk scanning code paths, and split at any position
+TEST_F(test_cpl, CPLJSonStreamingParser_long_tokens)
+{
+    std::string osLongString;
+    for (int i = 0; i < 100; ++i)
+        osLongString += static_cast<char>('a' + (i % 26));
+    const std::string osText = "{\"" + osLongString + "\": [\"" +
+                               osLongString + "\\\"" + osLongString +
+                               "\\u00e9\", 123456789.0123456789e-5, "
+                               "\"\", -1234567890123]}";
+    const std::string osExpected = "{\"" + osLongString + "\": [\"" +
+                                   osLongString + "\\\"" + osLongString +
+                                   "\xc3\xa9\", 123456789.0123456789e-5, "
+                                   "\"\", -1234567890123]}";
+    for (size_t nChunkSize : {osText.size(), static_cast<size_t>(1),
+                              static_cast<size_t>(7), static_cast<size_t>(17)})
+    {
+        CPLJSonStreamingParserDump oParser;
+        for (size_t i = 0; i < osText.size(); i += nChunkSize)
+        {
+            const size_t nSize = std::min(nChunkSize, osText.size() - i);
+            ASSERT_TRUE(oParser.Parse(osText.c_str() + i, nSize,
+                                      i + nSize == osText.size()));
+        }
+        EXPECT_STREQ(oParser.GetSerialized().c_str(), osExpected.c_str());
+    }
+
+    // Check that the position of errors is still correctly reported
+    {
+        CPLJSonStreamingParserDump oParser;
+        const std::string osInvalid =
+            "[\n\"" + osLongString + "\", \"" + osLongString + "\" x]";
+        ASSERT_TRUE(!oParser.Parse(osInvalid.c_str(), osInvalid.size(), true));
+        EXPECT_STREQ(oParser.GetException().c_str(),
+                     "At line 2, character 208: Unexpected character (x)");
+    }
+
+    // Check string size limit
+    {
+        CPLJSonStreamingParserDump oParser;
+        oParser.SetMaxStringSize(50);
+        const std::string osTooLong = "\"" + osLongString + "\"";
+        ASSERT_TRUE(!oParser.Parse(osTooLong.c_str(), osTooLong.size(), true));
+        ASSERT_TRUE(!oParser.GetException().empty());
+    }
+}
+
 // Test cpl_mem_cache
 TEST_F(test_cpl, cpl_mem_cache)
 {
@@ -3135,6 +3224,124 @@ TEST_F(test_cpl, cpl_minixml)
     CPLFree(str);
 }
 
+// Test CPLXMLArenaTree
+TEST_F(test_cpl, CPLXMLArenaTree)
+{
+    const auto Serialize = [](const CPLXMLNode *psNode)
+    {
+        char *pszStr = CPLSerializeXMLTree(psNode);
+        std::string osRet(pszStr ? pszStr : "");
+        CPLFree(pszStr);
+        return osRet;
+    };
+
+    // Compare with the regular parser on a small document
+    {
+        const char *pszXML =
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            "<!-- leading comment -->\n"
+            "<Root a=\"1\" b='&lt;two&gt;'>\n"
+            "  <!-- inner comment -->\n"
+            "  <Elt attr=\"&quot;x&amp;y&quot;\">a &amp; b &#65;&#x42;</Elt>\n"
+            "  <Empty/>\n"
+            "  <Mixed>text<Sub>sub</Sub>tail</Mixed>\n"
+            "</Root>\n";
+        CPLXMLTreeCloser oRef(CPLParseXMLString(pszXML));
+        ASSERT_TRUE(oRef.get() != nullptr);
+        CPLXMLArenaTree oTree;
+        ASSERT_TRUE(oTree.Parse(pszXML));
+        ASSERT_TRUE(oTree.get() != nullptr);
+        EXPECT_EQ(Serialize(oTree.get()), Serialize(oRef.get()));
+        EXPECT_STREQ(CPLGetXMLValue(oTree.get(), "=Root.b", ""), "<two>");
+        EXPECT_STREQ(CPLGetXMLValue(oTree.get(), "=Root.Elt.attr", ""),
+                     "\"x&y\"");
+        EXPECT_STREQ(CPLGetXMLValue(oTree.get(), "=Root.Elt", ""),
+                     "a & b AB");
+
+        const CPLXMLNode *psDocElt = oTree.getDocumentElement();
+        ASSERT_TRUE(psDocElt != nullptr);
+        EXPECT_STREQ(psDocElt->pszValue, "Root");
+        EXPECT_EQ(psDocElt, CPLGetXMLNode(oTree.get(), "=Root"));
+
+        // Cloning an arena subtree gives a regular, independent tree
+        const CPLXMLNode *psMixed = CPLGetXMLNode(psDocElt, "Mixed");
+        ASSERT_TRUE(psMixed != nullptr);
+        CPLXMLTreeCloser oClone(CPLCloneXMLTree(psMixed));
+        ASSERT_TRUE(oClone.get() != nullptr);
+        EXPECT_EQ(Serialize(oClone.get()),
+                  Serialize(CPLGetXMLNode(oRef.get(), "=Root.Mixed")));
+        CPLAddXMLAttributeAndValue(oClone.get(), "new", "attr");
+        EXPECT_STREQ(CPLGetXMLValue(oClone.get(), "new", ""), "attr");
+        EXPECT_EQ(CPLGetXMLNode(psMixed, "new"), nullptr);
+    }
+
+    // Document needing several arena blocks
+    {
+        std::string osXML("<Root>");
+        for (int i = 0; i < 10000; ++i)
+        {
+            osXML += "<E i=\"";
+            osXML += std::to_string(i);
+            osXML += "\"/>";
+        }
+        osXML += "</Root>";
+        CPLXMLTreeCloser oRef(CPLParseXMLString(osXML.c_str()));
+        ASSERT_TRUE(oRef.get() != nullptr);
+        CPLXMLArenaTree oTree;
+        ASSERT_TRUE(oTree.Parse(osXML.c_str()));
+        EXPECT_EQ(Serialize(oTree.get()), Serialize(oRef.get()));
+
+        int nCount = 0;
+        for (const CPLXMLNode *psIter = oTree.getDocumentElement()->psChild;
+             psIter; psIter = psIter->psNext)
+        {
+            ASSERT_EQ(atoi(CPLGetXMLValue(psIter, "i", "-1")), nCount);
+            ++nCount;
+        }
+        EXPECT_EQ(nCount, 10000);
+
+        // Re-parse with the same object
+        ASSERT_TRUE(oTree.Parse("<Other/>"));
+        EXPECT_STREQ(oTree.getDocumentElement()->pszValue, "Other");
+    }
+
+    // From a file
+    {
+        const char *pszFilename = "/vsimem/test_cpl_xml_arena_tree.xml";
+        const char *pszXML = "<Root><A>1</A></Root>";
+        VSILFILE *fp = VSIFOpenL(pszFilename, "wb");
+        ASSERT_TRUE(fp != nullptr);
+        VSIFWriteL(pszXML, 1, strlen(pszXML), fp);
+        VSIFCloseL(fp);
+        CPLXMLArenaTree oTree;
+        EXPECT_TRUE(oTree.ParseFile(pszFilename));
+        EXPECT_STREQ(CPLGetXMLValue(oTree.get(), "=Root.A", ""), "1");
+        VSIUnlink(pszFilename);
+
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        EXPECT_FALSE(oTree.ParseFile("/vsimem/i_do_not_exist.xml"));
+        CPLPopErrorHandler();
+        EXPECT_EQ(oTree.get(), nullptr);
+    }
+
+    // Invalid documents report the same error as CPLParseXMLString()
+    for (const char *pszXML : {"<Root><A></Root>", "<Root><A>"})
+    {
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        CPLErrorReset();
+        EXPECT_EQ(CPLParseXMLString(pszXML), nullptr) << pszXML;
+        const std::string osRefMsg = CPLGetLastErrorMsg();
+        CPLErrorReset();
+        CPLXMLArenaTree oTree;
+        EXPECT_FALSE(oTree.Parse(pszXML)) << pszXML;
+        CPLPopErrorHandler();
+        EXPECT_EQ(CPLGetLastErrorType(), CE_Failure) << pszXML;
+        EXPECT_EQ(std::string(CPLGetLastErrorMsg()), osRefMsg);
+        EXPECT_EQ(oTree.get(), nullptr);
+        EXPECT_EQ(oTree.getDocumentElement(), nullptr);
+    }
+}
+
 // Test CPLCharUniquePtr
 TEST_F(test_cpl, CPLCharUniquePtr)
 {
@@ -3403,6 +3610,96 @@ TEST_F(test_cpl, CPLWorkerThreadPool)
     }
 }
 
+// Test priorities of CPLWorkerThreadPool jobs
+TEST_F(test_cpl, CPLWorkerThreadPool_priorities)
+{
+    CPLWorkerThreadPool oPool;
+    ASSERT_TRUE(oPool.Setup(1, nullptr, nullptr, false));
+
+    struct JobData
+    {
+        std::mutex *poMutex = nullptr;
+        std::vector<int> *panOrder = nullptr;
+        int nId = 0;
+    };
+
+    std::mutex oMutex;
+    std::vector<int> anOrder;
+    const auto myJob = [](void *pData)
+    {
+        auto psData = static_cast<JobData *>(pData);
+        std::lock_guard<std::mutex> oLock(*(psData->poMutex));
+        psData->panOrder->push_back(psData->nId);
+    };
+
+    std::vector<JobData> asData(4);
+    for (int i = 0; i < 4; ++i)
+    {
+        asData[i].poMutex = &oMutex;
+        asData[i].panOrder = &anOrder;
+        asData[i].nId = i;
+    }
+
+    auto poLowQueue = oPool.CreateJobQueue(CPLJobPriority::LOW);
+    EXPECT_EQ(poLowQueue->GetPriority(), CPLJobPriority::LOW);
+    {
+        // Block the only worker thread while the other jobs are queued
+        std::lock_guard<std::mutex> oLock(oMutex);
+        oPool.SubmitJob(myJob, &asData[0]);
+        poLowQueue->SubmitJob(myJob, &asData[1]);
+        oPool.SubmitJob(myJob, &asData[2], CPLJobPriority::LOW);
+        oPool.SubmitJob(myJob, &asData[3], CPLJobPriority::HIGH);
+    }
+    poLowQueue->WaitCompletion();
+    oPool.WaitCompletion();
+
+    ASSERT_EQ(anOrder.size(), 4U);
+    const auto nPosHigh = std::find(anOrder.begin(), anOrder.end(), 3);
+    EXPECT_LT(nPosHigh, std::find(anOrder.begin(), anOrder.end(), 1));
+    EXPECT_LT(nPosHigh, std::find(anOrder.begin(), anOrder.end(), 2));
+}
+
+// Test that nested jobs are run inline when the process-wide budget of
+// concurrent jobs is exhausted
+TEST_F(test_cpl, CPLWorkerThreadPool_nested_jobs_budget)
+{
+    CPLSetConfigOption("GDAL_MAX_CONCURRENT_JOBS", "1");
+
+    CPLWorkerThreadPool oOuterPool;
+    ASSERT_TRUE(oOuterPool.Setup(1, nullptr, nullptr, false));
+    CPLWorkerThreadPool oInnerPool;
+    ASSERT_TRUE(oInnerPool.Setup(1, nullptr, nullptr, false));
+
+    struct JobData
+    {
+        CPLWorkerThreadPool *poInnerPool = nullptr;
+        std::thread::id outerThreadId{};
+        std::thread::id innerThreadId{};
+    };
+
+    JobData sData;
+    sData.poInnerPool = &oInnerPool;
+    const auto outerJob = [](void *pData)
+    {
+        const auto innerJob = [](void *pDataInner)
+        {
+            static_cast<JobData *>(pDataInner)->innerThreadId =
+                std::this_thread::get_id();
+        };
+        auto psData = static_cast<JobData *>(pData);
+        psData->outerThreadId = std::this_thread::get_id();
+        psData->poInnerPool->SubmitJob(innerJob, psData);
+        psData->poInnerPool->WaitCompletion();
+    };
+    oOuterPool.SubmitJob(outerJob, &sData);
+    oOuterPool.WaitCompletion();
+
+    CPLSetConfigOption("GDAL_MAX_CONCURRENT_JOBS", nullptr);
+
+    EXPECT_NE(sData.outerThreadId, std::this_thread::get_id());
+    EXPECT_EQ(sData.innerThreadId, sData.outerThreadId);
+}
+
 // Test CPLHTTPFetch
 TEST_F(test_cpl, CPLHTTPFetch)
 {
@@ -4572,6 +4869,82 @@ TEST_F(test_cpl, file_system_pread)
     VSIUnlink("temp_test_64.bin");
 }
 
+// Test VSIVirtualHandle::ReadMultiRangeAsync()
+TEST_F(test_cpl, ReadMultiRangeAsync)
+{
+    std::string osContent;
+    for (int i = 0; i < 100000; ++i)
+        osContent += static_cast<char>('a' + (i % 26));
+    {
+        VSILFILE *fp = VSIFOpenL("/vsimem/read_multi_range_async.bin", "wb");
+        ASSERT_NE(fp, nullptr);
+        ASSERT_EQ(VSIFWriteL(osContent.data(), osContent.size(), 1, fp), 1U);
+        VSIFCloseL(fp);
+    }
+
+    // /vsimem/ has PRead(), /vsisubfile/ does not
+    for (const char *pszFilename :
+         {"/vsimem/read_multi_range_async.bin",
+          "/vsisubfile/0_100000,/vsimem/read_multi_range_async.bin"})
+    {
+        VSILFILE *fp = VSIFOpenL(pszFilename, "rb");
+        ASSERT_NE(fp, nullptr);
+        VSIVirtualHandle *poHandle = reinterpret_cast<VSIVirtualHandle *>(fp);
+
+        constexpr int N_RANGES = 100;
+        std::vector<std::string> aosBuffers(N_RANGES);
+        std::vector<void *> apData;
+        std::vector<vsi_l_offset> anOffsets;
+        std::vector<size_t> anSizes;
+        for (int i = 0; i < N_RANGES; ++i)
+        {
+            anOffsets.push_back(static_cast<vsi_l_offset>(i) * 997);
+            anSizes.push_back(1 + (i * 37) % 500);
+            aosBuffers[i].resize(anSizes.back());
+            apData.push_back(&aosBuffers[i][0]);
+        }
+
+        std::atomic<int> nCallbackCalls{0};
+        const auto Callback = [](int nStatus, void *pUserData)
+        {
+            if (nStatus == 0)
+                ++(*static_cast<std::atomic<int> *>(pUserData));
+        };
+        auto poRequest = poHandle->ReadMultiRangeAsync(
+            N_RANGES, apData.data(), anOffsets.data(), anSizes.data(),
+            Callback, &nCallbackCalls);
+        ASSERT_NE(poRequest, nullptr);
+        // Another request on the same handle, while the first one is pending
+        char abyExtra[4] = {0};
+        void *pExtra = abyExtra;
+        const vsi_l_offset nExtraOffset = 26 * 10 + 1;
+        const size_t nExtraSize = sizeof(abyExtra);
+        auto poRequest2 = poHandle->ReadMultiRangeAsync(1, &pExtra,
+                                                        &nExtraOffset,
+                                                        &nExtraSize);
+        EXPECT_EQ(poRequest->Wait(), 0);
+        EXPECT_TRUE(poRequest->IsDone());
+        EXPECT_EQ(nCallbackCalls, 1);
+        EXPECT_EQ(poRequest2->Wait(), 0);
+        EXPECT_EQ(std::string(abyExtra, 4), "bcde");
+        for (int i = 0; i < N_RANGES; ++i)
+        {
+            EXPECT_EQ(aosBuffers[i],
+                      osContent.substr(static_cast<size_t>(anOffsets[i]),
+                                       anSizes[i]));
+        }
+
+        // Read beyond end of file
+        const vsi_l_offset nOffsetEOF = osContent.size() - 1;
+        poRequest2 = poHandle->ReadMultiRangeAsync(1, &pExtra, &nOffsetEOF,
+                                                   &nExtraSize);
+        EXPECT_EQ(poRequest2->Wait(), -1);
+
+        VSIFCloseL(fp);
+    }
+    VSIUnlink("/vsimem/read_multi_range_async.bin");
+}
+
 // Test CPLMask implementation
 TEST_F(test_cpl, CPLMask)
 {
@@ -4889,4 +5262,527 @@ TEST_F(test_cpl, VSIGetCanonicalFilename)
     VSIUnlink(osLC.c_str());
 }
 
+// In-memory file handle counting the requests it receives, to check the
+// requests issued by VSICreateCachedFile()
+struct VSICountingHandleStats
+{
+    int nReadMultiRangeCalls = 0;
+    std::vector<size_t> anReadSizes{};
+};
+
+class VSICountingHandle final : public VSIVirtualHandle
+{
+    const std::string &m_osContent;
+    VSICountingHandleStats &m_oStats;
+    vsi_l_offset m_nOffset = 0;
+    bool m_bEOF = false;
+
+  public:
+    VSICountingHandle(const std::string &osContent,
+                      VSICountingHandleStats &oStats)
+        : m_osContent(osContent), m_oStats(oStats)
+    {
+    }
+
+    int Seek(vsi_l_offset nOffset, int nWhence) override
+    {
+        m_bEOF = false;
+        if (nWhence == SEEK_END)
+            m_nOffset = m_osContent.size() + nOffset;
+        else if (nWhence == SEEK_CUR)
+            m_nOffset += nOffset;
+        else
+            m_nOffset = nOffset;
+        return 0;
+    }
+
+    vsi_l_offset Tell() override
+    {
+        return m_nOffset;
+    }
+
+    size_t Read(void *pBuffer, size_t nSize, size_t nCount) override
+    {
+        m_oStats.anReadSizes.push_back(nSize * nCount);
+        if (m_nOffset >= m_osContent.size())
+        {
+            m_bEOF = true;
+            return 0;
+        }
+        const size_t nToRead =
+            std::min(nSize * nCount,
+                     m_osContent.size() - static_cast<size_t>(m_nOffset));
+        memcpy(pBuffer, m_osContent.data() + m_nOffset, nToRead);
+        m_nOffset += nToRead;
+        if (nToRead < nSize * nCount)
+            m_bEOF = true;
+        return nToRead / nSize;
+    }
+
+    int ReadMultiRange(int nRanges, void **ppData,
+                       const vsi_l_offset *panOffsets,
+                       const size_t *panSizes) override
+    {
+        ++m_oStats.nReadMultiRangeCalls;
+        for (int i = 0; i < nRanges; ++i)
+        {
+            if (panOffsets[i] + panSizes[i] > m_osContent.size())
+                return -1;
+            memcpy(ppData[i], m_osContent.data() + panOffsets[i], panSizes[i]);
+        }
+        return 0;
+    }
+
+    size_t Write(const void *, size_t, size_t) override
+    {
+        return 0;
+    }
+
+    int Eof() override
+    {
+        return m_bEOF;
+    }
+
+    int Close() override
+    {
+        return 0;
+    }
+};
+
+static std::string GetVSICacheTestContent(size_t nSize)
+{
+    std::string osContent;
+    for (size_t i = 0; i < nSize; ++i)
+        osContent += static_cast<char>('a' + (i % 26));
+    return osContent;
+}
+
+// Test the read-ahead of VSICreateCachedFile() on sequential reads
+TEST_F(test_cpl, VSICachedFile_readahead)
+{
+    const std::string osContent = GetVSICacheTestContent(100000);
+    constexpr size_t CHUNK_SIZE = 1024;
+
+    for (const char *pszMaxReadAhead : {"4096", "0"})
+    {
+        CPLConfigOptionSetter oSetter("VSI_CACHE_MAX_READAHEAD",
+                                      pszMaxReadAhead, false);
+        VSICountingHandleStats oStats;
+        auto poHandle = std::unique_ptr<VSIVirtualHandle>(VSICreateCachedFile(
+            new VSICountingHandle(osContent, oStats), CHUNK_SIZE,
+            64 * CHUNK_SIZE));
+
+        // Sequential scan by pieces of 100 bytes
+        std::string osGot;
+        char abyBuffer[100];
+        size_t nRead;
+        while ((nRead = poHandle->Read(abyBuffer, 1, sizeof(abyBuffer))) > 0)
+            osGot.append(abyBuffer, nRead);
+        EXPECT_EQ(osGot, osContent);
+
+        const auto &anReadSizes = oStats.anReadSizes;
+        ASSERT_GE(anReadSizes.size(), 4U);
+        if (EQUAL(pszMaxReadAhead, "0"))
+        {
+            for (size_t nSize : anReadSizes)
+                EXPECT_EQ(nSize, CHUNK_SIZE);
+        }
+        else
+        {
+            // The first read is not known to be sequential. The read-ahead
+            // then doubles at each cache miss, up to 4 blocks
+            EXPECT_EQ(anReadSizes[0], CHUNK_SIZE);
+            EXPECT_EQ(anReadSizes[1], 2 * CHUNK_SIZE);
+            EXPECT_EQ(anReadSizes[2], 3 * CHUNK_SIZE);
+            EXPECT_EQ(anReadSizes[3], 5 * CHUNK_SIZE);
+            for (size_t nSize : anReadSizes)
+                EXPECT_LE(nSize, 5 * CHUNK_SIZE);
+            EXPECT_LT(anReadSizes.size(),
+                      osContent.size() / CHUNK_SIZE / 4 + 4);
+        }
+
+        // A random read only loads the block it needs. The first blocks
+        // have been evicted by the end of the scan.
+        oStats.anReadSizes.clear();
+        poHandle->Seek(1000, SEEK_SET);
+        ASSERT_EQ(poHandle->Read(abyBuffer, 1, 10), 10U);
+        EXPECT_EQ(std::string(abyBuffer, 10), osContent.substr(1000, 10));
+        ASSERT_EQ(oStats.anReadSizes.size(), 1U);
+        EXPECT_EQ(oStats.anReadSizes[0], CHUNK_SIZE);
+
+        // The last blocks are still cached
+        oStats.anReadSizes.clear();
+        poHandle->Seek(osContent.size() - 10, SEEK_SET);
+        ASSERT_EQ(poHandle->Read(abyBuffer, 1, 10), 10U);
+        EXPECT_EQ(std::string(abyBuffer, 10),
+                  osContent.substr(osContent.size() - 10));
+        EXPECT_TRUE(oStats.anReadSizes.empty());
+        poHandle->Close();
+    }
+}
+
+// Test VSI_CACHE_TOTAL_SIZE eviction across two handles
+TEST_F(test_cpl, VSICachedFile_total_size)
+{
+    const std::string osContent = GetVSICacheTestContent(100000);
+    constexpr size_t CHUNK_SIZE = 1024;
+
+    CPLConfigOptionSetter oSetterTotal("VSI_CACHE_TOTAL_SIZE",
+                                       CPLSPrintf("%d", 8 * 1024), false);
+    CPLConfigOptionSetter oSetterReadAhead("VSI_CACHE_MAX_READAHEAD", "0",
+                                           false);
+    VSICountingHandleStats oStatsA;
+    auto poHandleA = std::unique_ptr<VSIVirtualHandle>(VSICreateCachedFile(
+        new VSICountingHandle(osContent, oStatsA), CHUNK_SIZE,
+        64 * CHUNK_SIZE));
+    VSICountingHandleStats oStatsB;
+    auto poHandleB = std::unique_ptr<VSIVirtualHandle>(VSICreateCachedFile(
+        new VSICountingHandle(osContent, oStatsB), CHUNK_SIZE,
+        64 * CHUNK_SIZE));
+
+    std::vector<char> abyBuffer(8 * CHUNK_SIZE);
+    const auto ReadBlocks =
+        [&abyBuffer](VSIVirtualHandle *poHandle, int nFirstBlock, int nBlocks)
+    {
+        poHandle->Seek(static_cast<vsi_l_offset>(nFirstBlock) * CHUNK_SIZE,
+                       SEEK_SET);
+        return poHandle->Read(abyBuffer.data(), 1, nBlocks * CHUNK_SIZE) ==
+               nBlocks * CHUNK_SIZE;
+    };
+
+    // Fill the whole budget with blocks 0 to 7 of A
+    ASSERT_TRUE(ReadBlocks(poHandleA.get(), 0, 8));
+    EXPECT_EQ(oStatsA.anReadSizes.size(), 1U);
+
+    // Reading 4 blocks from B evicts the 4 least recently used blocks of A,
+    // which has the largest cache
+    ASSERT_TRUE(ReadBlocks(poHandleB.get(), 0, 4));
+    EXPECT_EQ(oStatsB.anReadSizes.size(), 1U);
+
+    oStatsA.anReadSizes.clear();
+    ASSERT_TRUE(ReadBlocks(poHandleA.get(), 4, 4));
+    EXPECT_TRUE(oStatsA.anReadSizes.empty());
+    ASSERT_TRUE(ReadBlocks(poHandleA.get(), 0, 1));
+    EXPECT_EQ(oStatsA.anReadSizes.size(), 1U);
+
+    // The blocks of B are still cached
+    oStatsB.anReadSizes.clear();
+    ASSERT_TRUE(ReadBlocks(poHandleB.get(), 0, 4));
+    EXPECT_TRUE(oStatsB.anReadSizes.empty());
+
+    poHandleA->Close();
+    poHandleB->Close();
+}
+
+// Test ReadMultiRange() through VSICreateCachedFile()
+TEST_F(test_cpl, VSICachedFile_ReadMultiRange)
+{
+    const std::string osContent = GetVSICacheTestContent(100000);
+    constexpr size_t CHUNK_SIZE = 1024;
+
+    VSICountingHandleStats oStats;
+    auto poHandle = std::unique_ptr<VSIVirtualHandle>(VSICreateCachedFile(
+        new VSICountingHandle(osContent, oStats), CHUNK_SIZE,
+        64 * CHUNK_SIZE));
+
+    // Non-contiguous ranges, two of them sharing a block
+    {
+        const vsi_l_offset anOffsets[] = {100, 5000, 5100, 20000};
+        const size_t anSizes[] = {100, 100, 100, 2000};
+        std::vector<std::string> aosBuffers(4);
+        void *apData[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            aosBuffers[i].resize(anSizes[i]);
+            apData[i] = &aosBuffers[i][0];
+        }
+        for (int iIter = 0; iIter < 2; ++iIter)
+        {
+            ASSERT_EQ(poHandle->ReadMultiRange(4, apData, anOffsets, anSizes),
+                      0);
+            for (int i = 0; i < 4; ++i)
+            {
+                EXPECT_EQ(aosBuffers[i],
+                          osContent.substr(static_cast<size_t>(anOffsets[i]),
+                                           anSizes[i]));
+            }
+            // Missing blocks are fetched with a single request the first
+            // time, and then served from the cache
+            EXPECT_EQ(oStats.nReadMultiRangeCalls, 1);
+            EXPECT_TRUE(oStats.anReadSizes.empty());
+        }
+
+        // Blocks loaded by ReadMultiRange() are available to Read()
+        char abyBuffer[10];
+        poHandle->Seek(20500, SEEK_SET);
+        ASSERT_EQ(poHandle->Read(abyBuffer, 1, 10), 10U);
+        EXPECT_EQ(std::string(abyBuffer, 10), osContent.substr(20500, 10));
+        EXPECT_TRUE(oStats.anReadSizes.empty());
+    }
+
+    // A range crossing end of file fails, but the requests to the underlying
+    // handle do not extend beyond end of file
+    {
+        const vsi_l_offset anOffsets[] = {50000, osContent.size() - 10};
+        const size_t anSizes[] = {10, 20};
+        std::string osBuffer1(anSizes[0], '\0');
+        std::string osBuffer2(anSizes[1], '\0');
+        void *apData[] = {&osBuffer1[0], &osBuffer2[0]};
+        EXPECT_NE(poHandle->ReadMultiRange(2, apData, anOffsets, anSizes), 0);
+        EXPECT_EQ(oStats.nReadMultiRangeCalls, 2);
+        EXPECT_TRUE(oStats.anReadSizes.empty());
+        EXPECT_EQ(osBuffer1, osContent.substr(50000, 10));
+        EXPECT_EQ(osBuffer2.substr(0, 10),
+                  osContent.substr(osContent.size() - 10));
+    }
+
+    poHandle->Close();
+}
+
+// Test CPLTraceSpan and the export of the recorded spans
+TEST_F(test_cpl, CPLTraceSpan)
+{
+    const auto GetChromeEvents = []()
+    {
+        char *pszJSON = CPLTraceGetAsSerializedJSON("CHROME");
+        EXPECT_NE(pszJSON, nullptr);
+        CPLJSONDocument oDoc;
+        EXPECT_TRUE(oDoc.LoadMemory(std::string(pszJSON ? pszJSON : "")));
+        CPLFree(pszJSON);
+        return oDoc.GetRoot();
+    };
+
+    // Disabled by default: nothing is recorded
+    CPLTraceReset();
+    EXPECT_FALSE(CPLTraceIsEnabled());
+    {
+        CPLTraceSpan oSpan("test", "disabled");
+        EXPECT_FALSE(oSpan.IsActive());
+        oSpan.AddAttribute("key", "value");
+    }
+    EXPECT_EQ(GetChromeEvents().GetArray("traceEvents").Size(), 0);
+
+    // Nested spans with attributes
+    {
+        CPLConfigOptionSetter oSetter("CPL_TRACE", "YES", false);
+        CPLTraceReset();
+        EXPECT_TRUE(CPLTraceIsEnabled());
+    }
+    {
+        CPLTraceSpan oOuter("test", "outer");
+        EXPECT_TRUE(oOuter.IsActive());
+        oOuter.AddAttribute("str", "value");
+        oOuter.AddAttribute("null_str", static_cast<const char *>(nullptr));
+        oOuter.AddAttribute("int", 5);
+        oOuter.AddAttribute("int64", static_cast<int64_t>(1) << 40);
+        oOuter.AddAttribute("real", 1.5);
+        {
+            CPLTraceSpan oInner("test", "inner");
+            EXPECT_TRUE(oInner.IsActive());
+        }
+        {
+            CPLTraceSpan oInner2("test", "inner2");
+        }
+    }
+    {
+        CPLTraceSpan oAfter("test", "after");
+    }
+    {
+        const auto oRoot = GetChromeEvents();
+        const auto oEvents = oRoot.GetArray("traceEvents");
+        ASSERT_EQ(oEvents.Size(), 4);
+        // Spans are recorded when they end
+        EXPECT_EQ(oEvents[0].GetString("name"), "inner");
+        EXPECT_EQ(oEvents[1].GetString("name"), "inner2");
+        EXPECT_EQ(oEvents[2].GetString("name"), "outer");
+        EXPECT_EQ(oEvents[3].GetString("name"), "after");
+        for (int i = 0; i < 4; ++i)
+        {
+            EXPECT_EQ(oEvents[i].GetString("cat"), "test");
+            EXPECT_EQ(oEvents[i].GetString("ph"), "X");
+            EXPECT_GE(oEvents[i].GetDouble("dur"), 0.0);
+            EXPECT_EQ(oEvents[i].GetLong("tid"),
+                      static_cast<GInt64>(CPLGetPID()));
+        }
+        const auto oOuterArgs = oEvents[2].GetObj("args");
+        const GInt64 nOuterId = oOuterArgs.GetLong("span_id");
+        EXPECT_NE(nOuterId, 0);
+        EXPECT_FALSE(oOuterArgs.GetObj("parent_span_id").IsValid());
+        EXPECT_EQ(oOuterArgs.GetString("str"), "value");
+        EXPECT_EQ(oOuterArgs.GetString("null_str"), "");
+        EXPECT_EQ(oOuterArgs.GetInteger("int"), 5);
+        EXPECT_EQ(oOuterArgs.GetLong("int64"), static_cast<GInt64>(1) << 40);
+        EXPECT_EQ(oOuterArgs.GetDouble("real"), 1.5);
+        EXPECT_EQ(oEvents[0].GetObj("args").GetLong("parent_span_id"),
+                  nOuterId);
+        EXPECT_EQ(oEvents[1].GetObj("args").GetLong("parent_span_id"),
+                  nOuterId);
+        EXPECT_FALSE(
+            oEvents[3].GetObj("args").GetObj("parent_span_id").IsValid());
+        // The outer span contains the inner ones
+        EXPECT_LE(oEvents[2].GetDouble("ts"), oEvents[0].GetDouble("ts"));
+        EXPECT_GE(oEvents[2].GetDouble("ts") + oEvents[2].GetDouble("dur"),
+                  oEvents[1].GetDouble("ts") + oEvents[1].GetDouble("dur"));
+        EXPECT_EQ(oRoot.GetObj("otherData").GetLong("dropped_events"), 0);
+
+        // Same spans in the OpenTelemetry encoding
+        char *pszJSON = CPLTraceGetAsSerializedJSON("OTLP");
+        ASSERT_NE(pszJSON, nullptr);
+        CPLJSONDocument oDoc;
+        EXPECT_TRUE(oDoc.LoadMemory(std::string(pszJSON)));
+        CPLFree(pszJSON);
+        const auto oSpans = oDoc.GetRoot()
+                                .GetArray("resourceSpans")[0]
+                                .GetArray("scopeSpans")[0]
+                                .GetArray("spans");
+        ASSERT_EQ(oSpans.Size(), 4);
+        const std::string osTraceId = oSpans[0].GetString("traceId");
+        EXPECT_EQ(osTraceId.size(), 32U);
+        const std::string osOuterId =
+            CPLSPrintf("%016" PRIx64, static_cast<uint64_t>(nOuterId));
+        EXPECT_EQ(oSpans[2].GetString("spanId"), osOuterId);
+        EXPECT_EQ(oSpans[0].GetString("parentSpanId"), osOuterId);
+        EXPECT_EQ(oSpans[2].GetString("parentSpanId"), "");
+        for (int i = 0; i < 4; ++i)
+        {
+            EXPECT_EQ(oSpans[i].GetString("traceId"), osTraceId);
+            EXPECT_LE(CPLAtoGIntBig(
+                          oSpans[i].GetString("startTimeUnixNano").c_str()),
+                      CPLAtoGIntBig(
+                          oSpans[i].GetString("endTimeUnixNano").c_str()));
+        }
+        std::map<std::string, CPLJSONObject> oMapAttrs;
+        for (const auto &oAttr : oSpans[2].GetArray("attributes"))
+            oMapAttrs[oAttr.GetString("key")] = oAttr.GetObj("value");
+        EXPECT_EQ(oMapAttrs["gdal.category"].GetString("stringValue"), "test");
+        EXPECT_EQ(oMapAttrs["str"].GetString("stringValue"), "value");
+        // 64-bit integers are encoded as strings
+        EXPECT_EQ(oMapAttrs["int64"].GetString("intValue"),
+                  std::to_string(static_cast<GInt64>(1) << 40));
+        EXPECT_EQ(oMapAttrs["real"].GetDouble("doubleValue"), 1.5);
+    }
+
+    // Writing to a file, and unsupported format
+    EXPECT_TRUE(CPLTraceWriteToFile("/vsimem/trace.json", nullptr));
+    {
+        CPLJSONDocument oDoc;
+        EXPECT_TRUE(oDoc.Load("/vsimem/trace.json"));
+        EXPECT_EQ(oDoc.GetRoot().GetArray("traceEvents").Size(), 4);
+    }
+    VSIUnlink("/vsimem/trace.json");
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    EXPECT_EQ(CPLTraceGetAsSerializedJSON("UNSUPPORTED"), nullptr);
+    EXPECT_FALSE(CPLTraceWriteToFile("/vsimem/trace.json", "UNSUPPORTED"));
+    EXPECT_FALSE(CPLTraceWriteToFile("/i_do/not/exist/trace.json", nullptr));
+    CPLPopErrorHandler();
+
+    // Spans of another thread are not children of the spans of this thread
+    CPLTraceReset();
+    CPLTraceSetEnabled(TRUE);
+    {
+        CPLTraceSpan oMain("test", "main");
+        std::thread oThread(
+            []()
+            {
+                CPLTraceSpan oThreadSpan("test", "thread");
+                CPLTraceSpan oThreadChild("test", "thread_child");
+            });
+        oThread.join();
+    }
+    {
+        const auto oEvents = GetChromeEvents().GetArray("traceEvents");
+        ASSERT_EQ(oEvents.Size(), 3);
+        EXPECT_EQ(oEvents[0].GetString("name"), "thread_child");
+        EXPECT_EQ(oEvents[1].GetString("name"), "thread");
+        EXPECT_EQ(oEvents[2].GetString("name"), "main");
+        EXPECT_EQ(oEvents[0].GetObj("args").GetLong("parent_span_id"),
+                  oEvents[1].GetObj("args").GetLong("span_id"));
+        EXPECT_FALSE(
+            oEvents[1].GetObj("args").GetObj("parent_span_id").IsValid());
+        EXPECT_NE(oEvents[1].GetLong("tid"), oEvents[2].GetLong("tid"));
+    }
+
+    // CPLTraceSetEnabled(FALSE) stops recording
+    CPLTraceSetEnabled(FALSE);
+    {
+        CPLTraceSpan oSpan("test", "not_recorded");
+        EXPECT_FALSE(oSpan.IsActive());
+    }
+    EXPECT_EQ(GetChromeEvents().GetArray("traceEvents").Size(), 3);
+
+    // Category filtering: a filtered out span is transparent for nesting
+    {
+        CPLConfigOptionSetter oSetter("CPL_TRACE_CATEGORIES", "test,other",
+                                      false);
+        CPLTraceReset();
+        CPLTraceSetEnabled(TRUE);
+    }
+    {
+        CPLTraceSpan oOuter("test", "outer");
+        CPLTraceSpan oFiltered("filtered", "filtered");
+        EXPECT_FALSE(oFiltered.IsActive());
+        CPLTraceSpan oInner("other", "inner");
+        EXPECT_TRUE(oInner.IsActive());
+    }
+    {
+        const auto oEvents = GetChromeEvents().GetArray("traceEvents");
+        ASSERT_EQ(oEvents.Size(), 2);
+        EXPECT_EQ(oEvents[0].GetString("name"), "inner");
+        EXPECT_EQ(oEvents[1].GetString("name"), "outer");
+        EXPECT_EQ(oEvents[0].GetObj("args").GetLong("parent_span_id"),
+                  oEvents[1].GetObj("args").GetLong("span_id"));
+    }
+
+    // Maximum number of recorded spans
+    {
+        CPLConfigOptionSetter oSetter("CPL_TRACE_MAX_EVENTS", "2", false);
+        CPLTraceReset();
+        CPLTraceSetEnabled(TRUE);
+    }
+    for (int i = 0; i < 5; ++i)
+    {
+        CPLTraceSpan oSpan("test", "span");
+    }
+    {
+        const auto oRoot = GetChromeEvents();
+        EXPECT_EQ(oRoot.GetArray("traceEvents").Size(), 2);
+        EXPECT_EQ(oRoot.GetObj("otherData").GetLong("dropped_events"), 3);
+    }
+
+    // Instrumented file reads
+    CPLTraceReset();
+    CPLTraceSetEnabled(TRUE);
+    {
+        VSILFILE *fp = VSIFileFromMemBuffer(
+            "/vsimem/trace_read.bin",
+            reinterpret_cast<GByte *>(const_cast<char *>("0123456789")), 10,
+            false);
+        ASSERT_NE(fp, nullptr);
+        char abyBuffer[4];
+        VSIFSeekL(fp, 2, SEEK_SET);
+        EXPECT_EQ(VSIFReadL(abyBuffer, 1, 4, fp), 4U);
+        VSIFCloseL(fp);
+        VSIUnlink("/vsimem/trace_read.bin");
+    }
+    {
+        const auto oEvents = GetChromeEvents().GetArray("traceEvents");
+        bool bFound = false;
+        for (const auto &oEvent : oEvents)
+        {
+            if (oEvent.GetString("cat") == "vsi" &&
+                oEvent.GetString("name") == "Read")
+            {
+                bFound = true;
+                EXPECT_EQ(oEvent.GetObj("args").GetLong("offset"), 2);
+                EXPECT_EQ(oEvent.GetObj("args").GetLong("size"), 4);
+            }
+        }
+        EXPECT_TRUE(bFound);
+    }
+
+    // Back to the default state
+    CPLTraceReset();
+    EXPECT_FALSE(CPLTraceIsEnabled());
+}
+
 }  // namespace
@@ -78,4 +78,129 @@ TEST(test_deferredplugin, test_nominal)
 #endif
 }
 
+// Test that drivers of plugins found in the metadata cache are declared
+// without loading the plugin. The plugin files are fake ones, which would
+// fail to load.
+TEST(test_deferredplugin, test_metadata_cache)
+{
+    const char *pszDir = "/vsimem/test_metadata_cache";
+    const std::string osPlugin =
+        CPLFormFilename(pszDir, "gdal_CacheTest.so", nullptr);
+    const std::string osStalePlugin =
+        CPLFormFilename(pszDir, "gdal_CacheTestStale.so", nullptr);
+    const std::string osCache =
+        CPLFormFilename(pszDir, "plugin_metadata_cache.xml", nullptr);
+    VSIMkdir(pszDir, 0755);
+    for (const std::string &osFilename : {osPlugin, osStalePlugin})
+    {
+        VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "wb");
+        ASSERT_NE(fp, nullptr);
+        VSIFWriteL("not a shared library", 1, 20, fp);
+        VSIFCloseL(fp);
+    }
+    VSIStatBufL sStat;
+    ASSERT_EQ(VSIStatL(osPlugin.c_str(), &sStat), 0);
+
+    const auto PluginEntry =
+        [](const std::string &osFilename, GIntBig nSize, GIntBig nMTime,
+           const char *pszDriverName)
+    {
+        return CPLSPrintf(
+            "<Plugin path=\"%s\" size=\"" CPL_FRMT_GIB
+            "\" mtime=\"" CPL_FRMT_GIB "\"><Driver name=\"%s\">"
+            "<MetadataItem key=\"DCAP_RASTER\">YES</MetadataItem>"
+            "<MetadataItem key=\"DCAP_OPEN\">YES</MetadataItem>"
+            "<MetadataItem key=\"DMD_LONGNAME\">Cache test</MetadataItem>"
+            "<MetadataItem key=\"DMD_CONNECTION_PREFIX\">CACHETEST:"
+            "</MetadataItem>"
+            "<MetadataItem key=\"DMD_SIGNATURES\">43545354 FFFE</MetadataItem>"
+            "<MetadataItem key=\"MY_ITEM\">my_value</MetadataItem>"
+            "</Driver></Plugin>",
+            osFilename.c_str(), nSize, nMTime, pszDriverName);
+    };
+    std::string osXML = "<PluginMetadataCache>";
+    osXML += PluginEntry(osPlugin, static_cast<GIntBig>(sStat.st_size),
+                         static_cast<GIntBig>(sStat.st_mtime), "CacheTest");
+    // Size of the plugin file does not match: entry ignored
+    osXML +=
+        PluginEntry(osStalePlugin, static_cast<GIntBig>(sStat.st_size) + 1,
+                    static_cast<GIntBig>(sStat.st_mtime), "CacheTestStale");
+    osXML += "</PluginMetadataCache>";
+    VSILFILE *fp = VSIFOpenL(osCache.c_str(), "wb");
+    ASSERT_NE(fp, nullptr);
+    VSIFWriteL(osXML.data(), 1, osXML.size(), fp);
+    VSIFCloseL(fp);
+
+    {
+        CPLConfigOptionSetter oDriverPath("GDAL_DRIVER_PATH", pszDir, false);
+        CPLConfigOptionSetter oCache("GDAL_PLUGIN_METADATA_CACHE",
+                                     osCache.c_str(), false);
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        GetGDALDriverManager()->AutoLoadDrivers();
+        CPLPopErrorHandler();
+    }
+
+    // The stale plugin had to be loaded, which failed
+    EXPECT_EQ(GDALGetDriverByName("CacheTestStale"), nullptr);
+
+    GDALDriver *poDriver =
+        GDALDriver::FromHandle(GDALGetDriverByName("CacheTest"));
+    ASSERT_NE(poDriver, nullptr);
+    EXPECT_STREQ(poDriver->GetMetadataItem("IS_NON_LOADED_PLUGIN"), "YES");
+    EXPECT_STREQ(poDriver->GetMetadataItem(GDAL_DMD_LONGNAME), "Cache test");
+    EXPECT_STREQ(poDriver->GetMetadataItem(GDAL_DCAP_RASTER), "YES");
+    EXPECT_STREQ(poDriver->GetMetadataItem("MY_ITEM"), "my_value");
+    EXPECT_STREQ(poDriver->GetMetadataItem("IS_NON_LOADED_PLUGIN"), "YES");
+
+    // Identification from the connection prefix and the signatures only
+    const char *const apszAllowedDrivers[] = {"CacheTest", nullptr};
+    EXPECT_EQ(GDALIdentifyDriverEx("CACHETEST:foo", GDAL_OF_RASTER,
+                                   apszAllowedDrivers, nullptr),
+              GDALDriver::ToHandle(poDriver));
+    const std::string osData = CPLFormFilename(pszDir, "data.bin", nullptr);
+    for (const char *pszHeader : {"CTST and some data", "\xFF\xFE data",
+                                  "CTS not matching"})
+    {
+        fp = VSIFOpenL(osData.c_str(), "wb");
+        ASSERT_NE(fp, nullptr);
+        VSIFWriteL(pszHeader, 1, strlen(pszHeader), fp);
+        VSIFCloseL(fp);
+        const bool bMatch = !STARTS_WITH(pszHeader, "CTS ");
+        GDALDriverH hDrv = GDALIdentifyDriverEx(
+            osData.c_str(), GDAL_OF_RASTER, apszAllowedDrivers, nullptr);
+        EXPECT_EQ(hDrv, bMatch ? GDALDriver::ToHandle(poDriver) : nullptr)
+            << pszHeader;
+    }
+    EXPECT_STREQ(poDriver->GetMetadataItem("IS_NON_LOADED_PLUGIN"), "YES");
+
+    // Accessing metadata that is not in the cache requires loading the
+    // plugin, which fails here
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    EXPECT_EQ(poDriver->GetMetadataItem("NOT_IN_CACHE"), nullptr);
+    CPLPopErrorHandler();
+
+    // Nothing was loaded successfully, so the cache is not rewritten
+    EXPECT_EQ(VSIStatL(osCache.c_str(), &sStat), 0);
+    EXPECT_EQ(static_cast<size_t>(sStat.st_size), osXML.size());
+
+    // A corrupted cache is ignored
+    fp = VSIFOpenL(osCache.c_str(), "wb");
+    ASSERT_NE(fp, nullptr);
+    VSIFWriteL("<corrupted", 1, 10, fp);
+    VSIFCloseL(fp);
+    {
+        CPLConfigOptionSetter oDriverPath("GDAL_DRIVER_PATH", pszDir, false);
+        CPLConfigOptionSetter oCache("GDAL_PLUGIN_METADATA_CACHE",
+                                     osCache.c_str(), false);
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        GetGDALDriverManager()->AutoLoadDrivers();
+        CPLPopErrorHandler();
+    }
+    EXPECT_EQ(GDALGetDriverByName("CacheTestStale"), nullptr);
+
+    GetGDALDriverManager()->DeregisterDriver(poDriver);
+    delete poDriver;
+    VSIRmdirRecursive(pszDir);
+}
+
 }  // namespace
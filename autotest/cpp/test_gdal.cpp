@@ -35,6 +35,7 @@
 #include "gdal.h"
 #include "tilematrixset.hpp"
 #include "gdalcachedpixelaccessor.h"
+#include "mem/memdataset.h"
 
 #include <limits>
 #include <string>
@@ -3597,4 +3598,727 @@ TEST_F(test_gdal, drop_cache)
     }
 }
 
+
+// Test GDALDataset::SetBlockCacheQuota() and SetBlockCachePriority()
+TEST_F(test_gdal, block_cache_quota_and_priority)
+{
+    auto poDrv = GDALDriver::FromHandle(GDALGetDriverByName("MEM"));
+    if (!poDrv)
+    {
+        GTEST_SKIP() << "MEM driver missing";
+    }
+    const GIntBig nOldCacheMax = GDALGetCacheMax64();
+    GDALSetCacheMax64(10 * 1000 * 1000);
+
+    const auto ReadAllBlocks = [](GDALDataset *poDS)
+    {
+        auto poBand = poDS->GetRasterBand(1);
+        for (int iY = 0; iY < poDS->GetRasterYSize(); ++iY)
+        {
+            auto poBlock = poBand->GetLockedBlockRef(0, iY);
+            ASSERT_NE(poBlock, nullptr);
+            poBlock->DropLock();
+        }
+    };
+
+    {
+        // MEM datasets have one-line blocks
+        GDALDatasetUniquePtr poBulkDS(
+            poDrv->Create("", 1000, 1000, 1, GDT_Byte, nullptr));
+        GDALDatasetUniquePtr poHotDS(
+            poDrv->Create("", 1000, 1000, 1, GDT_Byte, nullptr));
+        ASSERT_NE(poBulkDS, nullptr);
+        ASSERT_NE(poHotDS, nullptr);
+
+        EXPECT_EQ(poBulkDS->GetBlockCacheQuota(), 0);
+        EXPECT_EQ(poBulkDS->GetBlockCachePriority(), 0);
+        poBulkDS->SetBlockCacheQuota(100 * 1000);
+        EXPECT_EQ(poBulkDS->GetBlockCacheQuota(), 100 * 1000);
+
+        ReadAllBlocks(poHotDS.get());
+        const GIntBig nHotUsed = poHotDS->GetBlockCacheUsed();
+        EXPECT_GE(nHotUsed, 1000 * 1000);
+
+        ReadAllBlocks(poBulkDS.get());
+        // Quota is a soft limit, up to the size of one block
+        EXPECT_LE(poBulkDS->GetBlockCacheUsed(), 100 * 1000 + 2000);
+        EXPECT_GT(poBulkDS->GetBlockCacheUsed(), 0);
+        EXPECT_EQ(poHotDS->GetBlockCacheUsed(), nHotUsed);
+
+        // Now the global budget is exceeded: a lower priority dataset
+        // cannot evict blocks of a higher priority one, as long as it has
+        // blocks of its own to evict
+        GDALSetCacheMax64(GDALGetCacheUsed64());
+        poBulkDS->SetBlockCacheQuota(0);
+        poBulkDS->SetBlockCachePriority(-1);
+        EXPECT_EQ(poBulkDS->GetBlockCachePriority(), -1);
+        ReadAllBlocks(poBulkDS.get());
+        EXPECT_EQ(poHotDS->GetBlockCacheUsed(), nHotUsed);
+
+        poBulkDS.reset();
+        poHotDS.reset();
+    }
+
+    GDALSetCacheMax64(nOldCacheMax);
+}
+
+// Test GDALGetCacheStatistics()
+TEST_F(test_gdal, GDALGetCacheStatistics)
+{
+    auto poDrv = GDALDriver::FromHandle(GDALGetDriverByName("MEM"));
+    if (!poDrv)
+    {
+        GTEST_SKIP() << "MEM driver missing";
+    }
+    GDALDatasetUniquePtr poDS(poDrv->Create("", 10, 10, 1, GDT_Byte, nullptr));
+    ASSERT_NE(poDS, nullptr);
+    auto poBand = poDS->GetRasterBand(1);
+
+    GDALResetCacheStatistics();
+    GDALCacheStatistics sStats;
+    GDALGetCacheStatistics(&sStats);
+    EXPECT_EQ(sStats.nHits, 0);
+    EXPECT_EQ(sStats.nMisses, 0);
+    EXPECT_EQ(sStats.nEvictions, 0);
+    EXPECT_EQ(sStats.nDirtyBlockWrites, 0);
+    EXPECT_EQ(sStats.dfDirtyBlockWriteTime, 0.0);
+    EXPECT_EQ(sStats.dfLockWaitTime, 0.0);
+
+    for (int iIter = 0; iIter < 2; ++iIter)
+    {
+        for (int iY = 0; iY < 10; ++iY)
+        {
+            auto poBlock = poBand->GetLockedBlockRef(0, iY);
+            ASSERT_NE(poBlock, nullptr);
+            if (iIter == 1)
+                poBlock->MarkDirty();
+            poBlock->DropLock();
+        }
+    }
+    GDALGetCacheStatistics(&sStats);
+    EXPECT_EQ(sStats.nMisses, 10);
+    EXPECT_EQ(sStats.nHits, 10);
+
+    const GIntBig nOldCacheMax = GDALGetCacheMax64();
+    GDALSetCacheMax64(0);
+    GDALGetCacheStatistics(&sStats);
+    EXPECT_GE(sStats.nEvictions, 10);
+    EXPECT_GE(sStats.nDirtyBlockWrites, 10);
+    EXPECT_GE(sStats.dfDirtyBlockWriteTime, 0.0);
+    GDALSetCacheMax64(nOldCacheMax);
+}
+
+// Test the pipelined mode of GDALDatasetCopyWholeRaster() and
+// GDALRasterBandCopyWholeRaster()
+TEST_F(test_gdal, GDALDatasetCopyWholeRaster_multithreaded)
+{
+    auto poDrv = GDALDriver::FromHandle(GDALGetDriverByName("MEM"));
+    if (!poDrv)
+    {
+        GTEST_SKIP() << "MEM driver missing";
+    }
+    constexpr int N = 100;
+    GDALDatasetUniquePtr poSrcDS(
+        poDrv->Create("", N, N, 3, GDT_UInt16, nullptr));
+    ASSERT_NE(poSrcDS, nullptr);
+    std::vector<GUInt16> anValues(N * N * 3);
+    for (size_t i = 0; i < anValues.size(); ++i)
+        anValues[i] = static_cast<GUInt16>(i % 65521);
+    ASSERT_EQ(poSrcDS->RasterIO(GF_Write, 0, 0, N, N, anValues.data(), N, N,
+                                GDT_UInt16, 3, nullptr, 0, 0, 0, nullptr),
+              CE_None);
+
+    // Force small swaths so that the copy is done in several steps
+    CPLConfigOptionSetter oSetter("GDAL_SWATH_SIZE", "2000", false);
+
+    for (const char *pszInterleave : {"BAND", "PIXEL"})
+    {
+        GDALDatasetUniquePtr poDstDS(
+            poDrv->Create("", N, N, 3, GDT_UInt16, nullptr));
+        ASSERT_NE(poDstDS, nullptr);
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("INTERLEAVE", pszInterleave);
+        aosOptions.SetNameValue("NUM_THREADS", "2");
+        EXPECT_EQ(GDALDatasetCopyWholeRaster(
+                      GDALDataset::ToHandle(poSrcDS.get()),
+                      GDALDataset::ToHandle(poDstDS.get()), aosOptions.List(),
+                      nullptr, nullptr),
+                  CE_None);
+        std::vector<GUInt16> anOutValues(N * N * 3);
+        EXPECT_EQ(poDstDS->RasterIO(GF_Read, 0, 0, N, N, anOutValues.data(),
+                                    N, N, GDT_UInt16, 3, nullptr, 0, 0, 0,
+                                    nullptr),
+                  CE_None);
+        EXPECT_EQ(anOutValues, anValues) << pszInterleave;
+    }
+
+    {
+        GDALDatasetUniquePtr poDstDS(
+            poDrv->Create("", N, N, 1, GDT_Float32, nullptr));
+        ASSERT_NE(poDstDS, nullptr);
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("NUM_THREADS", "2");
+        EXPECT_EQ(GDALRasterBandCopyWholeRaster(
+                      GDALRasterBand::ToHandle(poSrcDS->GetRasterBand(2)),
+                      GDALRasterBand::ToHandle(poDstDS->GetRasterBand(1)),
+                      aosOptions.List(), nullptr, nullptr),
+                  CE_None);
+        EXPECT_EQ(GDALChecksumImage(poDstDS->GetRasterBand(1), 0, 0, N, N),
+                  GDALChecksumImage(poSrcDS->GetRasterBand(2), 0, 0, N, N));
+    }
+}
+
+// Test that statistics, min/max and histograms computed with several
+// threads are the same as the single-threaded ones
+TEST_F(test_gdal, ComputeStatistics_multithreaded)
+{
+    auto poDrv = GDALDriver::FromHandle(GDALGetDriverByName("MEM"));
+    if (!poDrv)
+    {
+        GTEST_SKIP() << "MEM driver missing";
+    }
+    for (GDALDataType eDT : {GDT_Byte, GDT_UInt16, GDT_Float32})
+    {
+        constexpr int N = 200;
+        GDALDatasetUniquePtr poDS(poDrv->Create("", N, N, 1, eDT, nullptr));
+        ASSERT_NE(poDS, nullptr);
+        auto poBand = poDS->GetRasterBand(1);
+        std::vector<float> afValues(N * N);
+        for (size_t i = 0; i < afValues.size(); ++i)
+            afValues[i] = static_cast<float>((i * 37) % 251);
+        ASSERT_EQ(poBand->RasterIO(GF_Write, 0, 0, N, N, afValues.data(), N,
+                                   N, GDT_Float32, 0, 0, nullptr),
+                  CE_None);
+        poBand->SetNoDataValue(3);
+
+        double adfStats[2][4] = {};
+        double adfMinMax[2][2] = {};
+        GUIntBig anHistogram[2][100] = {};
+        for (int i = 0; i < 2; ++i)
+        {
+            CPLConfigOptionSetter oSetter("GDAL_NUM_THREADS",
+                                          i == 0 ? "1" : "4", false);
+            EXPECT_EQ(poBand->ComputeStatistics(
+                          false, &adfStats[i][0], &adfStats[i][1],
+                          &adfStats[i][2], &adfStats[i][3], nullptr, nullptr),
+                      CE_None);
+            EXPECT_EQ(poBand->ComputeRasterMinMax(false, adfMinMax[i]),
+                      CE_None);
+            EXPECT_EQ(poBand->GetHistogram(-0.5, 255.5, 100, anHistogram[i],
+                                           false, false, nullptr, nullptr),
+                      CE_None);
+        }
+        EXPECT_EQ(adfStats[1][0], adfStats[0][0]);
+        EXPECT_EQ(adfStats[1][1], adfStats[0][1]);
+        EXPECT_NEAR(adfStats[1][2], adfStats[0][2], 1e-10 * adfStats[0][2]);
+        EXPECT_NEAR(adfStats[1][3], adfStats[0][3], 1e-10 * adfStats[0][3]);
+        EXPECT_EQ(adfMinMax[1][0], adfMinMax[0][0]);
+        EXPECT_EQ(adfMinMax[1][1], adfMinMax[0][1]);
+        EXPECT_EQ(adfMinMax[0][0], 0);
+        EXPECT_EQ(adfMinMax[0][1], 250);
+        for (int i = 0; i < 100; ++i)
+            EXPECT_EQ(anHistogram[1][i], anHistogram[0][i]);
+    }
+}
+
+// Test that GDALDataset::ComputeStatistics(), which processes all bands in a
+// single pass, gives the same results as GDALRasterBand::ComputeStatistics()
+TEST_F(test_gdal, GDALDataset_ComputeStatistics)
+{
+    auto poDrv = GDALDriver::FromHandle(GDALGetDriverByName("MEM"));
+    if (!poDrv)
+    {
+        GTEST_SKIP() << "MEM driver missing";
+    }
+    // Large enough for the single-pass computation to use several chunks
+    constexpr int W = 2000;
+    constexpr int H = 1500;
+    GDALDatasetUniquePtr poDS(
+        poDrv->Create("", W, H, 0, GDT_Unknown, nullptr));
+    ASSERT_NE(poDS, nullptr);
+    for (GDALDataType eDT : {GDT_Byte, GDT_UInt16, GDT_Float32})
+        ASSERT_EQ(poDS->AddBand(eDT, nullptr), CE_None);
+
+    std::vector<double> adfValues(static_cast<size_t>(W) * H);
+    for (size_t i = 0; i < adfValues.size(); ++i)
+        adfValues[i] = static_cast<double>((i * 37) % 251);
+    ASSERT_EQ(poDS->GetRasterBand(1)->RasterIO(GF_Write, 0, 0, W, H,
+                                               adfValues.data(), W, H,
+                                               GDT_Float64, 0, 0, nullptr),
+              CE_None);
+
+    for (size_t i = 0; i < adfValues.size(); ++i)
+        adfValues[i] = static_cast<double>((i * 7919) % 65521);
+    ASSERT_EQ(poDS->GetRasterBand(2)->RasterIO(GF_Write, 0, 0, W, H,
+                                               adfValues.data(), W, H,
+                                               GDT_Float64, 0, 0, nullptr),
+              CE_None);
+    poDS->GetRasterBand(2)->SetNoDataValue(7919);
+
+    std::vector<GByte> abyMask(adfValues.size());
+    for (size_t i = 0; i < adfValues.size(); ++i)
+    {
+        adfValues[i] = i % 97 == 0 ? std::numeric_limits<double>::quiet_NaN()
+                                   : static_cast<double>(i % 1000) * 0.37 - 100;
+        abyMask[i] = i % 13 == 0 ? 0 : 255;
+    }
+    auto poBand3 = poDS->GetRasterBand(3);
+    ASSERT_EQ(poBand3->RasterIO(GF_Write, 0, 0, W, H, adfValues.data(), W, H,
+                                GDT_Float64, 0, 0, nullptr),
+              CE_None);
+    ASSERT_EQ(poBand3->CreateMaskBand(0), CE_None);
+    ASSERT_EQ(poBand3->GetMaskBand()->RasterIO(GF_Write, 0, 0, W, H,
+                                               abyMask.data(), W, H, GDT_Byte,
+                                               0, 0, nullptr),
+              CE_None);
+
+    double adfExpected[3][4] = {};
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_EQ(poDS->GetRasterBand(i + 1)->ComputeStatistics(
+                      false, &adfExpected[i][0], &adfExpected[i][1],
+                      &adfExpected[i][2], &adfExpected[i][3], nullptr,
+                      nullptr),
+                  CE_None);
+    }
+
+    const int anBandList[] = {3, 1, 2};
+    for (const char *pszThreads : {"1", "4"})
+    {
+        CPLConfigOptionSetter oSetter("GDAL_NUM_THREADS", pszThreads, false);
+        poDS->ClearStatistics();
+        EXPECT_EQ(poDS->ComputeStatistics(3, anBandList, false, nullptr,
+                                          nullptr),
+                  CE_None);
+        for (int i = 0; i < 3; ++i)
+        {
+            double adfStats[4] = {};
+            EXPECT_EQ(poDS->GetRasterBand(i + 1)->GetStatistics(
+                          false, false, &adfStats[0], &adfStats[1],
+                          &adfStats[2], &adfStats[3]),
+                      CE_None)
+                << i;
+            EXPECT_EQ(adfStats[0], adfExpected[i][0]) << i;
+            EXPECT_EQ(adfStats[1], adfExpected[i][1]) << i;
+            EXPECT_NEAR(adfStats[2], adfExpected[i][2],
+                        1e-10 * std::fabs(adfExpected[i][2]))
+                << i;
+            EXPECT_NEAR(adfStats[3], adfExpected[i][3],
+                        1e-10 * adfExpected[i][3])
+                << i;
+        }
+    }
+
+    const int nInvalidBand = 4;
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    EXPECT_EQ(
+        poDS->ComputeStatistics(1, &nInvalidBand, false, nullptr, nullptr),
+        CE_Failure);
+    CPLPopErrorHandler();
+}
+
+// Test the default implementation of GDALDataset::AdviseReadPlan()
+TEST_F(test_gdal, GDALDataset_AdviseReadPlan)
+{
+    class TestRasterBand : public GDALRasterBand
+    {
+      protected:
+        CPLErr IReadBlock(int, int, void *) override
+        {
+            return CE_Failure;
+        }
+
+      public:
+        TestRasterBand()
+        {
+            nBlockXSize = 100;
+            nBlockYSize = 1;
+            eDataType = GDT_Byte;
+        }
+    };
+
+    class TestDataset : public GDALDataset
+    {
+      public:
+        std::vector<std::vector<int>> m_aanAdvisedWindows{};
+
+        TestDataset()
+        {
+            nRasterXSize = 100;
+            nRasterYSize = 100;
+            SetBand(1, new TestRasterBand());
+            SetBand(2, new TestRasterBand());
+        }
+
+        CPLErr AdviseRead(int nXOff, int nYOff, int nXSize, int nYSize,
+                          int nBufXSize, int nBufYSize, GDALDataType,
+                          int nBandCount, int *panBandList, char **) override
+        {
+            std::vector<int> anWindow{nXOff,     nYOff,     nXSize,
+                                      nYSize,    nBufXSize, nBufYSize};
+            anWindow.insert(anWindow.end(), panBandList,
+                            panBandList + nBandCount);
+            m_aanAdvisedWindows.push_back(std::move(anWindow));
+            return CE_None;
+        }
+    };
+
+    // Windows covering their bounding box: advised as a whole
+    {
+        TestDataset oDS;
+        const GDALRasterWindow asWindows[] = {
+            {0, 0, 50, 50}, {50, 0, 50, 50}, {0, 50, 50, 50}, {50, 50, 50, 40}};
+        EXPECT_EQ(oDS.AdviseReadPlan(4, asWindows, 0, nullptr, nullptr),
+                  CE_None);
+        const std::vector<std::vector<int>> aanExpected{
+            {0, 0, 100, 100, 100, 100, 1, 2}};
+        EXPECT_EQ(oDS.m_aanAdvisedWindows, aanExpected);
+    }
+
+    // Bounding box larger than the budget: adjacent windows merged, and
+    // as many of them as fit in the budget advised
+    {
+        TestDataset oDS;
+        const GDALRasterWindow asWindows[] = {
+            {0, 0, 50, 50}, {50, 0, 50, 50}, {0, 50, 50, 50}, {50, 50, 50, 50}};
+        const char *const apszOptions[] = {"MAX_BYTES=15000", nullptr};
+        EXPECT_EQ(oDS.AdviseReadPlan(4, asWindows, 0, nullptr, apszOptions),
+                  CE_None);
+        const std::vector<std::vector<int>> aanExpected{
+            {0, 0, 100, 50, 100, 50, 1, 2}};
+        EXPECT_EQ(oDS.m_aanAdvisedWindows, aanExpected);
+    }
+
+    // Sparse windows: adjacent ones merged, invalid ones skipped
+    {
+        TestDataset oDS;
+        const GDALRasterWindow asWindows[] = {
+            {0, 0, 10, 10},   {10, 0, 10, 10},  {-1, 0, 10, 10},
+            {95, 95, 10, 10}, {80, 70, 10, 10}, {80, 80, 10, 10}};
+        const int nBand = 2;
+        EXPECT_EQ(oDS.AdviseReadPlan(6, asWindows, 1, &nBand, nullptr),
+                  CE_None);
+        const std::vector<std::vector<int>> aanExpected{
+            {0, 0, 20, 10, 20, 10, 2}, {80, 70, 10, 20, 10, 20, 2}};
+        EXPECT_EQ(oDS.m_aanAdvisedWindows, aanExpected);
+    }
+
+    // The first window is always advised, even if it exceeds the budget
+    {
+        TestDataset oDS;
+        const GDALRasterWindow asWindows[] = {{0, 0, 10, 10},
+                                              {80, 80, 10, 10}};
+        CPLConfigOptionSetter oSetter("GDAL_ADVISE_READ_PLAN_MAX_BYTES", "50",
+                                      false);
+        EXPECT_EQ(oDS.AdviseReadPlan(2, asWindows, 0, nullptr, nullptr),
+                  CE_None);
+        const std::vector<std::vector<int>> aanExpected{
+            {0, 0, 10, 10, 10, 10, 1, 2}};
+        EXPECT_EQ(oDS.m_aanAdvisedWindows, aanExpected);
+    }
+
+    // Invalid band number
+    {
+        TestDataset oDS;
+        const GDALRasterWindow sWindow = {0, 0, 10, 10};
+        const int nBand = 3;
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        EXPECT_EQ(oDS.AdviseReadPlan(1, &sWindow, 1, &nBand, nullptr),
+                  CE_Failure);
+        CPLPopErrorHandler();
+        EXPECT_TRUE(oDS.m_aanAdvisedWindows.empty());
+    }
+}
+
+// Test reading whole blocks directly into the user buffer
+TEST_F(test_gdal, RasterIO_direct_block_read)
+{
+    const char *pszFilename = "/vsimem/test_direct_block_read.tif";
+    const char *const apszOptions[] = {"TILED=YES", "BLOCKXSIZE=16",
+                                       "BLOCKYSIZE=16", nullptr};
+    constexpr int SIZE = 64;
+    std::vector<GUInt16> anRef(SIZE * SIZE);
+    for (int i = 0; i < SIZE * SIZE; ++i)
+        anRef[i] = static_cast<GUInt16>(i);
+    {
+        GDALDatasetUniquePtr poDS(
+            GDALDriver::FromHandle(GDALGetDriverByName("GTiff"))
+                ->Create(pszFilename, SIZE, SIZE, 1, GDT_UInt16, apszOptions));
+        ASSERT_TRUE(poDS != nullptr);
+        ASSERT_EQ(poDS->GetRasterBand(1)->RasterIO(
+                      GF_Write, 0, 0, SIZE, SIZE, anRef.data(), SIZE, SIZE,
+                      GDT_UInt16, 0, 0, nullptr),
+                  CE_None);
+    }
+
+    GDALDatasetUniquePtr poDS(GDALDataset::Open(pszFilename, GDAL_OF_UPDATE));
+    ASSERT_TRUE(poDS != nullptr);
+    auto poBand = poDS->GetRasterBand(1);
+
+    // Read the second column of blocks
+    std::vector<GUInt16> anBuf(16 * SIZE);
+    ASSERT_EQ(poBand->RasterIO(GF_Read, 16, 0, 16, SIZE, anBuf.data(), 16,
+                               SIZE, GDT_UInt16, 0, 0, nullptr),
+              CE_None);
+    for (int iY = 0; iY < SIZE; ++iY)
+    {
+        for (int iX = 0; iX < 16; ++iX)
+        {
+            ASSERT_EQ(anBuf[iY * 16 + iX], anRef[iY * SIZE + 16 + iX]);
+        }
+    }
+    // The block cache should not have been involved
+    for (int iYBlock = 0; iYBlock < SIZE / 16; ++iYBlock)
+    {
+        EXPECT_EQ(poBand->TryGetLockedBlockRef(1, iYBlock), nullptr);
+    }
+
+    // A dirty block in the cache must take precedence over the file content
+    GDALRasterBlock *poBlock = poBand->GetLockedBlockRef(1, 2);
+    ASSERT_TRUE(poBlock != nullptr);
+    static_cast<GUInt16 *>(poBlock->GetDataRef())[0] = 65535;
+    poBlock->MarkDirty();
+    poBlock->DropLock();
+
+    ASSERT_EQ(poBand->RasterIO(GF_Read, 16, 0, 16, SIZE, anBuf.data(), 16,
+                               SIZE, GDT_UInt16, 0, 0, nullptr),
+              CE_None);
+    EXPECT_EQ(anBuf[32 * 16], 65535);
+    EXPECT_EQ(anBuf[32 * 16 + 1], anRef[32 * SIZE + 17]);
+    EXPECT_EQ(anBuf[31 * 16], anRef[31 * SIZE + 16]);
+
+    poDS.reset();
+    VSIUnlink(pszFilename);
+}
+
+
+// Test MEMDataset::CreateView()
+TEST_F(test_gdal, MEMDataset_CreateView)
+{
+    std::unique_ptr<MEMDataset> poDS(
+        MEMDataset::Create("", 4, 3, 2, GDT_Byte, nullptr));
+    ASSERT_NE(poDS, nullptr);
+    double adfGT[6] = {100, 10, 0, 200, 0, -10};
+    poDS->SetGeoTransform(adfGT);
+    std::vector<GByte> abyData(4 * 3);
+    for (int i = 0; i < 4 * 3; ++i)
+        abyData[i] = static_cast<GByte>(i);
+    ASSERT_EQ(poDS->GetRasterBand(2)->RasterIO(GF_Write, 0, 0, 4, 3,
+                                               abyData.data(), 4, 3, GDT_Byte,
+                                               0, 0, nullptr),
+              CE_None);
+
+    // Invalid windows and bands
+    CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+    EXPECT_EQ(poDS->CreateView(3, 0, 2, 1, 1, nullptr), nullptr);
+    const int nInvalidBand = 3;
+    EXPECT_EQ(poDS->CreateView(0, 0, 1, 1, 1, &nInvalidBand), nullptr);
+
+    // View of band 2 over the window (1,1,2,2)
+    const int nBand = 2;
+    std::unique_ptr<MEMDataset> poView(
+        poDS->CreateView(1, 1, 2, 2, 1, &nBand));
+    ASSERT_NE(poView, nullptr);
+    EXPECT_EQ(poView->GetRasterXSize(), 2);
+    EXPECT_EQ(poView->GetRasterYSize(), 2);
+    EXPECT_EQ(poView->GetRasterCount(), 1);
+    double adfViewGT[6] = {0, 0, 0, 0, 0, 0};
+    EXPECT_EQ(poView->GetGeoTransform(adfViewGT), CE_None);
+    EXPECT_EQ(adfViewGT[0], 110);
+    EXPECT_EQ(adfViewGT[3], 190);
+
+    // No copy has been made
+    auto poViewBand =
+        cpl::down_cast<MEMRasterBand *>(poView->GetRasterBand(1));
+    auto poSrcBand = cpl::down_cast<MEMRasterBand *>(poDS->GetRasterBand(2));
+    EXPECT_EQ(poViewBand->GetData(), poSrcBand->GetData() + 4 + 1);
+
+    GByte abyView[4] = {0};
+    ASSERT_EQ(poViewBand->RasterIO(GF_Read, 0, 0, 2, 2, abyView, 2, 2,
+                                   GDT_Byte, 0, 0, nullptr),
+              CE_None);
+    EXPECT_EQ(abyView[0], 5);
+    EXPECT_EQ(abyView[1], 6);
+    EXPECT_EQ(abyView[2], 9);
+    EXPECT_EQ(abyView[3], 10);
+
+    // Writing into the view makes it use its own buffer
+    GByte abyNew[4] = {255, 255, 255, 255};
+    ASSERT_EQ(poViewBand->RasterIO(GF_Write, 0, 0, 2, 2, abyNew, 2, 2,
+                                   GDT_Byte, 0, 0, nullptr),
+              CE_None);
+    EXPECT_NE(poViewBand->GetData(), poSrcBand->GetData() + 4 + 1);
+    std::vector<GByte> abySrc(4 * 3);
+    ASSERT_EQ(poSrcBand->RasterIO(GF_Read, 0, 0, 4, 3, abySrc.data(), 4, 3,
+                                  GDT_Byte, 0, 0, nullptr),
+              CE_None);
+    EXPECT_EQ(abySrc, abyData);
+
+    // The view outlives its source
+    std::unique_ptr<MEMDataset> poView2(
+        poDS->CreateView(0, 2, 4, 1, 1, &nBand));
+    ASSERT_NE(poView2, nullptr);
+    poDS.reset();
+    GByte abyLine[4] = {0};
+    ASSERT_EQ(poView2->GetRasterBand(1)->RasterIO(GF_Read, 0, 0, 4, 1,
+                                                  abyLine, 4, 1, GDT_Byte, 0,
+                                                  0, nullptr),
+              CE_None);
+    EXPECT_EQ(abyLine[0], 8);
+    EXPECT_EQ(abyLine[3], 11);
+}
+
+
+// Compute the nodata mask of apValues with GDALComputeNoDataMask() on
+// arrays of various lengths and alignments, and compare with the result
+// on one value at a time (scalar code path) and with the expected one.
+template <class T>
+static void TestComputeNoDataMask(GDALDataType eWrkDT, double dfNoData,
+                                  const std::vector<T> &aValues)
+{
+    const auto IsNoData = [dfNoData](T val)
+    {
+        if constexpr (std::numeric_limits<T>::is_integer)
+        {
+            return val == static_cast<T>(dfNoData);
+        }
+        else
+        {
+            if (std::isnan(dfNoData))
+                return std::isnan(val);
+            return !std::isnan(val) &&
+                   ARE_REAL_EQUAL(val, static_cast<T>(dfNoData));
+        }
+    };
+
+    // Lengths that are and are not multiple of 16, and start offsets not
+    // aligned on 16 bytes
+    for (size_t nCount :
+         {size_t(0), size_t(1), size_t(15), size_t(16), size_t(17),
+          size_t(31), size_t(32), size_t(33), size_t(47), size_t(64),
+          size_t(1000 + 7)})
+    {
+        for (size_t nStart : {size_t(0), size_t(1), size_t(3)})
+        {
+            std::vector<T> aSrc(nStart + nCount);
+            for (size_t i = 0; i < nCount; ++i)
+                aSrc[nStart + i] = aValues[(i * 7 + nCount) % aValues.size()];
+            for (const bool bCombine : {false, true})
+            {
+                std::vector<GByte> abyInit(nStart + nCount);
+                for (size_t i = 0; i < abyInit.size(); ++i)
+                    abyInit[i] = (i % 3) == 0 ? 255 : 0;
+                std::vector<GByte> abyMask(abyInit);
+                GDALComputeNoDataMask(aSrc.data() + nStart, eWrkDT, dfNoData,
+                                      abyMask.data() + nStart, nCount,
+                                      bCombine);
+                std::vector<GByte> abyMaskScalar(abyInit);
+                for (size_t i = 0; i < nCount; ++i)
+                {
+                    GDALComputeNoDataMask(aSrc.data() + nStart + i, eWrkDT,
+                                          dfNoData,
+                                          abyMaskScalar.data() + nStart + i, 1,
+                                          bCombine);
+                }
+                EXPECT_EQ(abyMask, abyMaskScalar)
+                    << GDALGetDataTypeName(eWrkDT) << " nodata=" << dfNoData
+                    << " count=" << nCount << " start=" << nStart;
+                for (size_t i = 0; i < nStart + nCount; ++i)
+                {
+                    GByte byExpected = abyInit[i];
+                    if (i >= nStart)
+                    {
+                        const GByte byVal = IsNoData(aSrc[i]) ? 0 : 255;
+                        byExpected = bCombine ? (byExpected | byVal) : byVal;
+                    }
+                    ASSERT_EQ(abyMask[i], byExpected)
+                        << GDALGetDataTypeName(eWrkDT)
+                        << " nodata=" << dfNoData << " count=" << nCount
+                        << " start=" << nStart << " i=" << i;
+                }
+            }
+        }
+    }
+}
+
+// Test GDALComputeNoDataMask()
+TEST_F(test_gdal, GDALComputeNoDataMask)
+{
+    for (double dfNoData : {0.0, 1.0, 255.0})
+    {
+        TestComputeNoDataMask<GByte>(GDT_Byte, dfNoData,
+                                     {0, 1, 2, 127, 128, 254, 255});
+    }
+    for (double dfNoData : {0.0, 65535.0, 4294967295.0, 2147483648.0})
+    {
+        TestComputeNoDataMask<GUInt32>(
+            GDT_UInt32, dfNoData,
+            {0, 1, 65535, 2147483647U, 2147483648U, 4294967294U,
+             4294967295U});
+    }
+    for (double dfNoData : {0.0, -1.0, -2147483648.0, 2147483647.0})
+    {
+        TestComputeNoDataMask<GInt32>(
+            GDT_Int32, dfNoData,
+            {0, 1, -1, std::numeric_limits<GInt32>::min(),
+             std::numeric_limits<GInt32>::max(), -32768, 65535});
+    }
+
+    const auto GetRealValues = [](auto val)
+    {
+        using T = decltype(val);
+        const T eps = std::numeric_limits<float>::epsilon();
+        std::vector<T> aValues{0,
+                               -0.0,
+                               1,
+                               -1,
+                               std::numeric_limits<T>::quiet_NaN(),
+                               std::numeric_limits<T>::infinity(),
+                               -std::numeric_limits<T>::infinity(),
+                               std::numeric_limits<T>::max(),
+                               std::numeric_limits<T>::lowest(),
+                               std::numeric_limits<T>::denorm_min(),
+                               std::numeric_limits<T>::min()};
+        // Values around the nodata values tested below: within and beyond
+        // ARE_REAL_EQUAL() tolerance
+        for (T ref : {T(1), T(-1), T(1.5), T(-3.25e10),
+                      std::numeric_limits<T>::max()})
+        {
+            for (T factor : {T(1 + eps / 2), T(1 - eps / 2), T(1 + eps),
+                             T(1 - eps), T(1 + 2 * eps), T(1 - 2 * eps),
+                             T(1 + 4 * eps), T(1 - 4 * eps)})
+            {
+                aValues.push_back(ref * factor);
+            }
+            aValues.push_back(
+                std::nextafter(ref, std::numeric_limits<T>::infinity()));
+            aValues.push_back(
+                std::nextafter(ref, -std::numeric_limits<T>::infinity()));
+        }
+        return aValues;
+    };
+    const double adfRealNoData[] = {0.0,
+                                    1.0,
+                                    -1.0,
+                                    1.5,
+                                    -3.25e10,
+                                    std::numeric_limits<double>::quiet_NaN(),
+                                    std::numeric_limits<double>::infinity(),
+                                    -std::numeric_limits<double>::infinity(),
+                                    std::numeric_limits<float>::max()};
+    for (double dfNoData : adfRealNoData)
+    {
+        TestComputeNoDataMask<float>(GDT_Float32, dfNoData,
+                                     GetRealValues(0.0f));
+    }
+    for (double dfNoData : adfRealNoData)
+    {
+        TestComputeNoDataMask<double>(GDT_Float64, dfNoData,
+                                      GetRealValues(0.0));
+    }
+    TestComputeNoDataMask<double>(GDT_Float64,
+                                  std::numeric_limits<double>::max(),
+                                  GetRealValues(0.0));
+}
+
 }  // namespace
@@ -3357,4 +3357,453 @@ TEST_F(test_ogr, OGRFeatureDefn_sealing)
     }
 }
 
+// Test OGRGeometryFactory::transformGeometries()
+TEST_F(test_ogr, transformGeometries)
+{
+    OGRSpatialReference oSrcSRS;
+    oSrcSRS.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+    oSrcSRS.importFromEPSG(4326);
+    OGRSpatialReference oDstSRS;
+    oDstSRS.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+    oDstSRS.importFromEPSG(32631);
+    auto poCT = std::unique_ptr<OGRCoordinateTransformation>(
+        OGRCreateCoordinateTransformation(&oSrcSRS, &oDstSRS));
+    ASSERT_TRUE(poCT != nullptr);
+
+    const char *const apszWKT[] = {
+        "POINT (2 49)",
+        "POINT Z (2 49 10)",
+        "LINESTRING (2 49,3 50)",
+        "POLYGON ((2 49,2 50,3 50,3 49,2 49),(2.2 49.2,2.2 49.8,2.8 49.8,2.2 "
+        "49.2))",
+        "MULTIPOLYGON (((2 49,2 50,3 50,2 49)),((4 49,4 50,5 50,4 49)))",
+        "GEOMETRYCOLLECTION (POINT (2 49),CIRCULARSTRING (2 49,2.5 49.5,3 49))",
+        "LINESTRING (2 49,3 100)",
+        "POINT EMPTY",
+    };
+    constexpr size_t N = CPL_ARRAYSIZE(apszWKT);
+    std::vector<std::unique_ptr<OGRGeometry>> apoGeoms;
+    std::vector<std::unique_ptr<OGRGeometry>> apoRefGeoms;
+    for (const char *pszWKT : apszWKT)
+    {
+        OGRGeometry *poGeom = nullptr;
+        OGRGeometryFactory::createFromWkt(pszWKT, &oSrcSRS, &poGeom);
+        ASSERT_TRUE(poGeom != nullptr) << pszWKT;
+        apoRefGeoms.emplace_back(poGeom->clone());
+        apoGeoms.emplace_back(poGeom);
+    }
+
+    std::vector<OGRGeometry *> apoGeomsPtr;
+    for (const auto &poGeom : apoGeoms)
+        apoGeomsPtr.push_back(poGeom.get());
+    OGRErr aeErrors[N];
+    OGRErr eErr;
+    {
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        eErr = OGRGeometryFactory::transformGeometries(
+            apoGeomsPtr.data(), N, poCT.get(), aeErrors);
+    }
+    EXPECT_EQ(eErr, OGRERR_FAILURE);
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        OGRErr eRefErr;
+        {
+            CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+            eRefErr = apoRefGeoms[i]->transform(poCT.get());
+        }
+        EXPECT_EQ(aeErrors[i], eRefErr) << apszWKT[i];
+        if (eRefErr == OGRERR_NONE)
+        {
+            EXPECT_EQ(apoGeoms[i]->getSpatialReference(),
+                      poCT->GetTargetCS());
+            EXPECT_TRUE(apoGeoms[i]->Equals(apoRefGeoms[i].get()))
+                << apszWKT[i];
+        }
+    }
+    EXPECT_NE(aeErrors[N - 2], OGRERR_NONE);
+}
+
+
+// Test OGRFeature::SetFromStealing()
+TEST_F(test_ogr, OGRFeature_SetFromStealing)
+{
+    const auto CreateDefn = [](const char *pszName,
+                               const std::vector<const char *> &apszGeomFields)
+    {
+        OGRFeatureDefn *poDefn = new OGRFeatureDefn(pszName);
+        poDefn->Reference();
+        poDefn->SetGeomType(wkbNone);
+        for (const char *pszGeomField : apszGeomFields)
+        {
+            OGRGeomFieldDefn oGeomFieldDefn(pszGeomField, wkbUnknown);
+            poDefn->AddGeomFieldDefn(&oGeomFieldDefn);
+        }
+        return poDefn;
+    };
+    const auto AddFields = [](OGRFeatureDefn *poDefn, OGRFieldType eIntType)
+    {
+        for (const auto &oIter :
+             std::vector<std::pair<const char *, OGRFieldType>>{
+                 {"str", OFTString},
+                 {"bin", OFTBinary},
+                 {"intlist", OFTIntegerList},
+                 {"int64list", OFTInteger64List},
+                 {"reallist", OFTRealList},
+                 {"strlist", OFTStringList},
+                 {"real", OFTReal},
+                 {"int", eIntType}})
+        {
+            OGRFieldDefn oFieldDefn(oIter.first, oIter.second);
+            poDefn->AddFieldDefn(&oFieldDefn);
+        }
+    };
+
+    // Two geometry fields in the target: geometries are mapped by name
+    OGRFeatureDefn *poSrcDefn = CreateDefn("src", {"g1", "g2"});
+    AddFields(poSrcDefn, OFTInteger);
+    OGRFeatureDefn *poDstDefn = CreateDefn("dst", {"g2", "g3"});
+    // The integer field is converted to string
+    AddFields(poDstDefn, OFTString);
+
+    {
+        OGRFeature oSrc(poSrcDefn);
+        oSrc.SetFID(1);
+        oSrc.SetGeomFieldDirectly(0, new OGRPoint(1, 2));
+        OGRGeometry *poG2 = new OGRPoint(3, 4);
+        oSrc.SetGeomFieldDirectly(1, poG2);
+        oSrc.SetField("str", "foo");
+        const GByte abyData[] = {1, 2, 3};
+        oSrc.SetField(oSrc.GetFieldIndex("bin"),
+                      static_cast<int>(sizeof(abyData)), abyData);
+        const int anVals[] = {1, 2};
+        oSrc.SetField(oSrc.GetFieldIndex("intlist"), 2, anVals);
+        const GIntBig anVals64[] = {GINTBIG_MAX, 3};
+        oSrc.SetField(oSrc.GetFieldIndex("int64list"), 2, anVals64);
+        const double adfVals[] = {1.5, 2.5};
+        oSrc.SetField(oSrc.GetFieldIndex("reallist"), 2, adfVals);
+        const char *const apszList[] = {"a", "b", nullptr};
+        oSrc.SetField(oSrc.GetFieldIndex("strlist"), apszList);
+        oSrc.SetField("real", 1.25);
+        oSrc.SetField("int", 123);
+        oSrc.SetStyleString("PEN(c:#FF0000)");
+        oSrc.SetNativeData("native");
+        oSrc.SetNativeMediaType("text/plain");
+        const char *pszStr = oSrc.GetFieldAsString("str");
+        const char *const *papszList =
+            oSrc.GetFieldAsStringList(oSrc.GetFieldIndex("strlist"));
+
+        std::unique_ptr<OGRFeature> poRef(oSrc.Clone());
+
+        OGRFeature oDst(poDstDefn);
+        const int anMap[] = {0, 1, 2, 3, 4, 5, 6, 7};
+        ASSERT_EQ(oDst.SetFromStealing(&oSrc, anMap), OGRERR_NONE);
+
+        EXPECT_EQ(oDst.GetFID(), OGRNullFID);
+        EXPECT_EQ(oDst.GetGeomFieldRef(0), poG2);
+        EXPECT_EQ(oDst.GetGeomFieldRef(1), nullptr);
+        EXPECT_NE(oSrc.GetGeomFieldRef(0), nullptr);
+        EXPECT_EQ(oSrc.GetGeomFieldRef(1), nullptr);
+
+        for (int i = 0; i < poSrcDefn->GetFieldCount(); ++i)
+        {
+            const char *pszName = poSrcDefn->GetFieldDefn(i)->GetNameRef();
+            EXPECT_STREQ(oDst.GetFieldAsString(i), poRef->GetFieldAsString(i))
+                << pszName;
+            // Real values are copied, and the integer field is converted
+            const bool bCopied =
+                EQUAL(pszName, "real") || EQUAL(pszName, "int");
+            EXPECT_EQ(oSrc.IsFieldSet(i), bCopied) << pszName;
+        }
+
+        // Values of same-typed fields are moved without copy
+        EXPECT_EQ(oDst.GetFieldAsString("str"), pszStr);
+        EXPECT_EQ(oDst.GetFieldAsStringList(oDst.GetFieldIndex("strlist")),
+                  papszList);
+        // and converted values are copied
+        EXPECT_EQ(oSrc.GetFieldAsInteger("int"), 123);
+
+        EXPECT_STREQ(oDst.GetStyleString(), "PEN(c:#FF0000)");
+        EXPECT_EQ(oSrc.GetStyleString(), nullptr);
+        EXPECT_STREQ(oDst.GetNativeData(), "native");
+        EXPECT_STREQ(oDst.GetNativeMediaType(), "text/plain");
+        EXPECT_EQ(oSrc.GetNativeData(), nullptr);
+        EXPECT_EQ(oSrc.GetNativeMediaType(), nullptr);
+
+        // Values already set in the target are replaced
+        OGRFeature oSrc2(poSrcDefn);
+        oSrc2.SetField("str", "bar");
+        ASSERT_EQ(oDst.SetFromStealing(&oSrc2, anMap), OGRERR_NONE);
+        EXPECT_STREQ(oDst.GetFieldAsString("str"), "bar");
+        EXPECT_EQ(oDst.GetGeomFieldRef(0), nullptr);
+        EXPECT_EQ(oDst.GetStyleString(), nullptr);
+        EXPECT_EQ(oDst.GetNativeData(), nullptr);
+
+        // Ignored source fields are left untouched
+        OGRFeature oSrc3(poSrcDefn);
+        oSrc3.SetField("str", "baz");
+        const int anMapIgnore[] = {-1, 1, 2, 3, 4, 5, 6, 7};
+        ASSERT_EQ(oDst.SetFromStealing(&oSrc3, anMapIgnore), OGRERR_NONE);
+        EXPECT_STREQ(oSrc3.GetFieldAsString("str"), "baz");
+
+        EXPECT_EQ(oDst.SetFromStealing(&oDst, anMap), OGRERR_FAILURE);
+    }
+
+    // Single geometry field: the geometry is moved whatever the geometry
+    // field names are
+    OGRFeatureDefn *poDstDefnSingleGeom = CreateDefn("dst", {"other"});
+    {
+        OGRFeature oSrc(poSrcDefn);
+        OGRGeometry *poG1 = new OGRPoint(1, 2);
+        oSrc.SetGeomFieldDirectly(0, poG1);
+        oSrc.SetGeomFieldDirectly(1, new OGRPoint(3, 4));
+        OGRFeature oDst(poDstDefnSingleGeom);
+        const int anMap[] = {-1, -1, -1, -1, -1, -1, -1, -1};
+        ASSERT_EQ(oDst.SetFromStealing(&oSrc, anMap), OGRERR_NONE);
+        EXPECT_EQ(oDst.GetGeometryRef(), poG1);
+        EXPECT_EQ(oSrc.GetGeomFieldRef(0), nullptr);
+        EXPECT_NE(oSrc.GetGeomFieldRef(1), nullptr);
+    }
+
+    poSrcDefn->Release();
+    poDstDefn->Release();
+    poDstDefnSingleGeom->Release();
+}
+
+
+// Test OGR_L_GetNextFeatureBatch(), with the Memory driver implementation and
+// the generic one
+TEST_F(test_ogr, OGR_L_GetNextFeatureBatch)
+{
+    auto poDS = std::unique_ptr<GDALDataset>(
+        GetGDALDriverManager()->GetDriverByName("Memory")->Create(
+            "", 0, 0, 0, GDT_Unknown, nullptr));
+    auto poLayer = poDS->CreateLayer("test", nullptr, wkbPoint);
+    ASSERT_TRUE(poLayer != nullptr);
+    {
+        OGRFieldDefn oFieldDefn("int", OFTInteger);
+        ASSERT_EQ(poLayer->CreateField(&oFieldDefn), OGRERR_NONE);
+    }
+    {
+        OGRFieldDefn oFieldDefn("int64", OFTInteger64);
+        ASSERT_EQ(poLayer->CreateField(&oFieldDefn), OGRERR_NONE);
+    }
+    {
+        OGRFieldDefn oFieldDefn("real", OFTReal);
+        ASSERT_EQ(poLayer->CreateField(&oFieldDefn), OGRERR_NONE);
+    }
+    {
+        OGRFieldDefn oFieldDefn("str", OFTString);
+        ASSERT_EQ(poLayer->CreateField(&oFieldDefn), OGRERR_NONE);
+    }
+    {
+        OGRFieldDefn oFieldDefn("bin", OFTBinary);
+        ASSERT_EQ(poLayer->CreateField(&oFieldDefn), OGRERR_NONE);
+    }
+
+    // Feature i has FID i + 1. Its attribute fields are null for i == 3 and
+    // unset for i == 5, and it has no geometry for i == 4. Strings get
+    // longer to make the data buffer grow. The first one is empty.
+    constexpr int N_FEATURES = 10;
+    const auto GetExpectedString = [](int i)
+    { return std::string(static_cast<size_t>(i) * 1000, 'a' + i); };
+    const auto IsNullField = [](int i) { return i == 3 || i == 5; };
+    for (int i = 0; i < N_FEATURES; ++i)
+    {
+        OGRFeature oFeature(poLayer->GetLayerDefn());
+        oFeature.SetFID(i + 1);
+        if (i == 3)
+        {
+            for (int iField = 0; iField < 5; ++iField)
+                oFeature.SetFieldNull(iField);
+        }
+        else if (i != 5)
+        {
+            oFeature.SetField(0, i);
+            oFeature.SetField(1, static_cast<GIntBig>(i) * 10000000000LL);
+            oFeature.SetField(2, i + 0.5);
+            oFeature.SetField(3, GetExpectedString(i).c_str());
+            const std::vector<GByte> abyBin(i + 1, static_cast<GByte>(i));
+            oFeature.SetField(4, i + 1, abyBin.data());
+        }
+        if (i != 4)
+            oFeature.SetGeometryDirectly(new OGRPoint(i, i));
+        ASSERT_EQ(poLayer->CreateFeature(&oFeature), OGRERR_NONE);
+    }
+
+    constexpr int BATCH_SIZE = 4;
+    constexpr int N_COLS = 8;
+    GIntBig anFID[BATCH_SIZE] = {};
+    int anInt[BATCH_SIZE] = {};
+    GIntBig anInt64[BATCH_SIZE] = {};
+    double adfReal[BATCH_SIZE] = {};
+    size_t anStrOffsets[BATCH_SIZE + 1] = {};
+    size_t anBinOffsets[BATCH_SIZE + 1] = {};
+    size_t anGeomOffsets[BATCH_SIZE + 1] = {};
+    GByte aabyIsNull[N_COLS][BATCH_SIZE] = {};
+
+    for (const bool bGeneric : {false, true})
+    {
+        const auto GetNextFeatureBatch =
+            [poLayer, bGeneric](int nColumns, OGRFeatureBatchColumn *pasColumns,
+                                int nMaxFeatures)
+        {
+            return bGeneric
+                       ? poLayer->OGRLayer::GetNextFeatureBatch(
+                             nColumns, pasColumns, nMaxFeatures)
+                       : OGR_L_GetNextFeatureBatch(OGRLayer::ToHandle(poLayer),
+                                                   nColumns, pasColumns,
+                                                   nMaxFeatures);
+        };
+
+        OGRFeatureBatchColumn asCols[N_COLS];
+        memset(asCols, 0, sizeof(asCols));
+        asCols[0].eType = OBC_FID;
+        asCols[0].pValues = anFID;
+        for (int iField = 0; iField < 5; ++iField)
+        {
+            asCols[1 + iField].eType = OBC_FIELD;
+            asCols[1 + iField].iField = iField;
+        }
+        asCols[1].pValues = anInt;
+        asCols[2].pValues = anInt64;
+        asCols[3].pValues = adfReal;
+        asCols[4].panOffsets = anStrOffsets;
+        // Caller-provided buffer, too small for the strings
+        asCols[4].pabyData = static_cast<GByte *>(VSIMalloc(16));
+        asCols[4].nDataCapacity = 16;
+        asCols[5].panOffsets = anBinOffsets;
+        asCols[6].eType = OBC_GEOMETRY;
+        asCols[6].iField = 0;
+        asCols[6].panOffsets = anGeomOffsets;
+        // Same FID column, without null indicator
+        asCols[7].eType = OBC_FID;
+        asCols[7].pValues = anFID;
+        for (int iCol = 0; iCol < N_COLS - 1; ++iCol)
+            asCols[iCol].pabyIsNull = aabyIsNull[iCol];
+
+        const auto CheckRow = [&](int iRow, int i)
+        {
+            EXPECT_EQ(anFID[iRow], i + 1);
+            EXPECT_EQ(aabyIsNull[0][iRow], 0);
+            const bool bNull = IsNullField(i);
+            for (int iCol = 1; iCol <= 5; ++iCol)
+                EXPECT_EQ(aabyIsNull[iCol][iRow], bNull ? 1 : 0) << i;
+            EXPECT_EQ(anInt[iRow], bNull ? 0 : i);
+            EXPECT_EQ(anInt64[iRow],
+                      bNull ? 0 : static_cast<GIntBig>(i) * 10000000000LL);
+            EXPECT_EQ(adfReal[iRow], bNull ? 0.0 : i + 0.5);
+
+            const std::string osExpectedStr =
+                bNull ? std::string() : GetExpectedString(i);
+            ASSERT_EQ(anStrOffsets[iRow + 1] - anStrOffsets[iRow],
+                      osExpectedStr.size());
+            ASSERT_LE(anStrOffsets[iRow + 1], asCols[4].nDataCapacity);
+            EXPECT_EQ(std::string(reinterpret_cast<const char *>(
+                                      asCols[4].pabyData + anStrOffsets[iRow]),
+                                  osExpectedStr.size()),
+                      osExpectedStr);
+
+            const std::vector<GByte> abyExpectedBin(bNull ? 0 : i + 1,
+                                                    static_cast<GByte>(i));
+            ASSERT_EQ(anBinOffsets[iRow + 1] - anBinOffsets[iRow],
+                      abyExpectedBin.size());
+            if (!abyExpectedBin.empty())
+            {
+                ASSERT_LE(anBinOffsets[iRow + 1], asCols[5].nDataCapacity);
+                EXPECT_EQ(memcmp(asCols[5].pabyData + anBinOffsets[iRow],
+                                 abyExpectedBin.data(), abyExpectedBin.size()),
+                          0);
+            }
+
+            EXPECT_EQ(aabyIsNull[6][iRow], i == 4 ? 1 : 0);
+            if (i == 4)
+            {
+                EXPECT_EQ(anGeomOffsets[iRow + 1], anGeomOffsets[iRow]);
+            }
+            else
+            {
+                OGRPoint oPoint(i, i);
+                std::vector<GByte> abyWKB(oPoint.WkbSize());
+                oPoint.exportToWkb(wkbNDR, abyWKB.data(), wkbVariantIso);
+                ASSERT_EQ(anGeomOffsets[iRow + 1] - anGeomOffsets[iRow],
+                          abyWKB.size());
+                ASSERT_LE(anGeomOffsets[iRow + 1], asCols[6].nDataCapacity);
+                EXPECT_EQ(memcmp(asCols[6].pabyData + anGeomOffsets[iRow],
+                                 abyWKB.data(), abyWKB.size()),
+                          0);
+            }
+        };
+
+        // Whole layer, with a partial last batch
+        poLayer->ResetReading();
+        int nRead = 0;
+        while (true)
+        {
+            const int nRows = GetNextFeatureBatch(N_COLS, asCols, BATCH_SIZE);
+            ASSERT_GE(nRows, 0);
+            if (nRows == 0)
+                break;
+            EXPECT_EQ(nRows, std::min(BATCH_SIZE, N_FEATURES - nRead));
+            EXPECT_EQ(anStrOffsets[0], 0U);
+            EXPECT_EQ(anBinOffsets[0], 0U);
+            EXPECT_EQ(anGeomOffsets[0], 0U);
+            for (int iRow = 0; iRow < nRows; ++iRow)
+                CheckRow(iRow, nRead + iRow);
+            nRead += nRows;
+        }
+        EXPECT_EQ(nRead, N_FEATURES);
+        // Still at end of layer
+        EXPECT_EQ(GetNextFeatureBatch(N_COLS, asCols, BATCH_SIZE), 0);
+        // The string buffer has been grown for the 8000 and 9000 bytes long
+        // strings of the last batch, and the others allocated
+        EXPECT_GE(asCols[4].nDataCapacity, 17000U);
+        EXPECT_NE(asCols[5].pabyData, nullptr);
+        EXPECT_NE(asCols[6].pabyData, nullptr);
+
+        // Mixed with GetNextFeature()
+        poLayer->ResetReading();
+        delete poLayer->GetNextFeature();
+        ASSERT_EQ(GetNextFeatureBatch(N_COLS, asCols, BATCH_SIZE), BATCH_SIZE);
+        CheckRow(0, 1);
+        {
+            auto poFeature =
+                std::unique_ptr<OGRFeature>(poLayer->GetNextFeature());
+            ASSERT_TRUE(poFeature != nullptr);
+            EXPECT_EQ(poFeature->GetFID(), 6);
+        }
+
+        // Attribute filter
+        ASSERT_EQ(poLayer->SetAttributeFilter("int >= 6"), OGRERR_NONE);
+        poLayer->ResetReading();
+        ASSERT_EQ(GetNextFeatureBatch(N_COLS, asCols, BATCH_SIZE), BATCH_SIZE);
+        for (int iRow = 0; iRow < BATCH_SIZE; ++iRow)
+            CheckRow(iRow, 6 + iRow);
+        EXPECT_EQ(GetNextFeatureBatch(N_COLS, asCols, BATCH_SIZE), 0);
+        ASSERT_EQ(poLayer->SetAttributeFilter(nullptr), OGRERR_NONE);
+
+        // Spatial filter: excludes 0, 1, 4 (no geometry), 8 and 9
+        poLayer->SetSpatialFilterRect(1.5, 1.5, 7.5, 7.5);
+        poLayer->ResetReading();
+        ASSERT_EQ(GetNextFeatureBatch(N_COLS, asCols, BATCH_SIZE), BATCH_SIZE);
+        CheckRow(0, 2);
+        CheckRow(1, 3);
+        CheckRow(2, 5);
+        CheckRow(3, 6);
+        ASSERT_EQ(GetNextFeatureBatch(N_COLS, asCols, BATCH_SIZE), 1);
+        CheckRow(0, 7);
+        EXPECT_EQ(GetNextFeatureBatch(N_COLS, asCols, BATCH_SIZE), 0);
+        poLayer->SetSpatialFilter(nullptr);
+
+        // Invalid column
+        asCols[1].iField = 5;
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        EXPECT_EQ(GetNextFeatureBatch(N_COLS, asCols, BATCH_SIZE), -1);
+        CPLPopErrorHandler();
+
+        for (auto &sCol : asCols)
+            VSIFree(sCol.pabyData);
+    }
+}
+
 }  // namespace
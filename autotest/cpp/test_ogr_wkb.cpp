@@ -524,4 +524,133 @@ INSTANTIATE_TEST_SUITE_P(
         OGRWKBIntersectsPessimisticFixture::ParamType> &l_info)
     { return std::get<6>(l_info.param); });
 
+class OGRWKBGetMeasureFixture
+    : public test_ogr_wkb,
+      public ::testing::WithParamInterface<
+          std::tuple<const char *, bool, bool, const char *>>
+{
+  public:
+    static std::vector<std::tuple<const char *, bool, bool, const char *>>
+    GetTupleValues()
+    {
+        return {
+            std::make_tuple("POINT(1 2)", false, false, "POINT"),
+            std::make_tuple("LINESTRING(0 0,3 4,3 5)", true, true,
+                            "LINESTRING"),
+            std::make_tuple("LINESTRING Z(0 0 1,1 0 2,1 1 3,0 0 4)", true,
+                            true, "CLOSED_LINESTRING_Z"),
+            std::make_tuple("POLYGON((0 0,0 10,10 10,10 0,0 0),"
+                            "(1 1,2 1,2 2,1 2,1 1))",
+                            true, false, "POLYGON"),
+            std::make_tuple("POLYGON ZM((0 0 1 2,0 1 1 2,1 1 1 2,0 0 1 2))",
+                            true, false, "POLYGON_ZM"),
+            std::make_tuple("TRIANGLE((0 0,0 1,1 1,0 0))", true, false,
+                            "TRIANGLE"),
+            std::make_tuple("MULTIPOINT((1 2),(3 4))", false, false,
+                            "MULTIPOINT"),
+            std::make_tuple("MULTILINESTRING((0 0,0 1),(0 0,1 0,1 1,0 0))",
+                            false, true, "MULTILINESTRING"),
+            std::make_tuple("MULTIPOLYGON(((0 0,0 1,1 1,0 0)),"
+                            "((10 10,10 12,12 12,10 10)))",
+                            true, false, "MULTIPOLYGON"),
+            std::make_tuple("GEOMETRYCOLLECTION(POINT(1 2),"
+                            "LINESTRING(0 0,0 1,1 1,0 0),"
+                            "POLYGON((0 0,0 2,2 2,0 0)),"
+                            "MULTILINESTRING((0 0,0 5)),"
+                            "MULTIPOLYGON(((0 0,0 3,3 3,0 0))),"
+                            "GEOMETRYCOLLECTION(LINESTRING(0 0,0 7)))",
+                            true, true, "GEOMETRYCOLLECTION"),
+            std::make_tuple("CIRCULARSTRING(0 0,1 1,2 0)", false, false,
+                            "CIRCULARSTRING"),
+            std::make_tuple("CURVEPOLYGON((0 0,0 1,1 1,0 0))", false, false,
+                            "CURVEPOLYGON"),
+        };
+    }
+};
+
+TEST_P(OGRWKBGetMeasureFixture, test)
+{
+    const char *pszInput = std::get<0>(GetParam());
+    const bool bAreaSupported = std::get<1>(GetParam());
+    const bool bLengthSupported = std::get<2>(GetParam());
+
+    OGRGeometry *poGeom = nullptr;
+    ASSERT_EQ(OGRGeometryFactory::createFromWkt(pszInput, nullptr, &poGeom),
+              OGRERR_NONE);
+    ASSERT_TRUE(poGeom != nullptr);
+    std::vector<GByte> abyWkb(poGeom->WkbSize());
+    poGeom->exportToWkb(wkbXDR, abyWkb.data(), wkbVariantIso);
+
+    double dfArea = -1;
+    EXPECT_EQ(OGRWKBGetArea(abyWkb.data(), abyWkb.size(), dfArea),
+              bAreaSupported);
+    if (bAreaSupported)
+    {
+        EXPECT_NEAR(dfArea, OGR_G_Area(OGRGeometry::ToHandle(poGeom)), 1e-12);
+    }
+
+    double dfLength = -1;
+    EXPECT_EQ(OGRWKBGetLength(abyWkb.data(), abyWkb.size(), dfLength),
+              bLengthSupported);
+    if (bLengthSupported)
+    {
+        EXPECT_NEAR(dfLength, OGR_G_Length(OGRGeometry::ToHandle(poGeom)),
+                    1e-12);
+    }
+    delete poGeom;
+
+    if (abyWkb.size() > 9)
+    {
+        // Truncated WKB
+        EXPECT_EQ(OGRWKBGetArea(abyWkb.data(), abyWkb.size() - 1, dfArea),
+                  false);
+        EXPECT_EQ(OGRWKBGetLength(abyWkb.data(), abyWkb.size() - 1, dfLength),
+                  false);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    test_ogr_wkb, OGRWKBGetMeasureFixture,
+    ::testing::ValuesIn(OGRWKBGetMeasureFixture::GetTupleValues()),
+    [](const ::testing::TestParamInfo<OGRWKBGetMeasureFixture::ParamType>
+           &l_info) { return std::get<3>(l_info.param); });
+
+TEST_F(test_ogr_wkb, OGRWKBPointInPolygon)
+{
+    OGRGeometry *poGeom = nullptr;
+    ASSERT_EQ(OGRGeometryFactory::createFromWkt(
+                  "MULTIPOLYGON(((0 0,0 10,10 10,10 0,0 0),"
+                  "(2 2,2 8,8 8,8 2,2 2)),((20 20,20 30,30 20,20 20)))",
+                  nullptr, &poGeom),
+              OGRERR_NONE);
+    std::vector<GByte> abyWkb(poGeom->WkbSize());
+    poGeom->exportToWkb(wkbNDR, abyWkb.data(), wkbVariantIso);
+    delete poGeom;
+
+    bool bInside = false;
+    EXPECT_TRUE(
+        OGRWKBPointInPolygon(abyWkb.data(), abyWkb.size(), 1, 1, bInside));
+    EXPECT_TRUE(bInside);
+    EXPECT_TRUE(
+        OGRWKBPointInPolygon(abyWkb.data(), abyWkb.size(), 5, 5, bInside));
+    EXPECT_FALSE(bInside);
+    EXPECT_TRUE(
+        OGRWKBPointInPolygon(abyWkb.data(), abyWkb.size(), 21, 21, bInside));
+    EXPECT_TRUE(bInside);
+    EXPECT_TRUE(
+        OGRWKBPointInPolygon(abyWkb.data(), abyWkb.size(), 29, 29, bInside));
+    EXPECT_FALSE(bInside);
+    EXPECT_TRUE(
+        OGRWKBPointInPolygon(abyWkb.data(), abyWkb.size(), -1, 5, bInside));
+    EXPECT_FALSE(bInside);
+    EXPECT_FALSE(
+        OGRWKBPointInPolygon(abyWkb.data(), abyWkb.size() - 1, 1, 1, bInside));
+
+    // Not a polygon
+    const GByte abyPoint[] = {1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    EXPECT_FALSE(
+        OGRWKBPointInPolygon(abyPoint, sizeof(abyPoint), 0, 0, bInside));
+}
+
 }  // namespace
@@ -641,4 +641,28 @@ TEST_F(test_osr, exportToPanorama)
         EXPECT_NEAR(adfParams[6], 0, EPS);           //false_northing
     }
 }
+
+// Test OSRGetFromSharedCache() and OSRInsertIntoSharedCache()
+TEST_F(test_osr, shared_cache)
+{
+    const std::string osKey("test_osr:shared_cache");
+    EXPECT_EQ(OSRGetFromSharedCache(osKey), nullptr);
+
+    OGRSpatialReference oSRS;
+    oSRS.importFromEPSG(32631);
+    oSRS.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+    OSRInsertIntoSharedCache(osKey, oSRS);
+
+    auto poSRS = OSRGetFromSharedCache(osKey);
+    ASSERT_NE(poSRS, nullptr);
+    EXPECT_NE(poSRS.get(), &oSRS);
+    EXPECT_TRUE(poSRS->IsSame(&oSRS));
+    EXPECT_EQ(poSRS->GetAxisMappingStrategy(), OAMS_TRADITIONAL_GIS_ORDER);
+
+    // Modifying the returned copy must not affect the cached object
+    poSRS->SetFromUserInput("WGS84");
+    auto poSRS2 = OSRGetFromSharedCache(osKey);
+    ASSERT_NE(poSRS2, nullptr);
+    EXPECT_TRUE(poSRS2->IsSame(&oSRS));
+}
 }  // namespace
@@ -37,6 +37,8 @@
 #include <algorithm>
 #include <cmath>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "gtest_include.h"
 
@@ -380,4 +382,57 @@ TEST_F(test_osr_ct, OGRCoordinateTransformation_C_API)
     OSRDestroySpatialReference(hSource);
     OSRDestroySpatialReference(hTarget);
 }
+
+// Test creating and destroying the same transformation from several threads,
+// which reuses the instances kept in the cache
+TEST_F(test_osr_ct, cache_multithreaded)
+{
+    OGRSpatialReference oSRSSource;
+    oSRSSource.importFromEPSG(4326);
+    oSRSSource.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+
+    OGRSpatialReference oSRSTarget;
+    oSRSTarget.importFromEPSG(32631);
+    oSRSTarget.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+
+    double dfRefX = 2;
+    double dfRefY = 49;
+    {
+        auto poCT = std::unique_ptr<OGRCoordinateTransformation>(
+            OGRCreateCoordinateTransformation(&oSRSSource, &oSRSTarget));
+        ASSERT_TRUE(poCT != nullptr);
+        ASSERT_TRUE(poCT->Transform(1, &dfRefX, &dfRefY));
+    }
+
+    constexpr int THREAD_COUNT = 8;
+    std::vector<std::thread> aoThreads;
+    std::vector<int> anErrors(THREAD_COUNT);
+    for (int i = 0; i < THREAD_COUNT; ++i)
+    {
+        aoThreads.emplace_back(
+            [&oSRSSource, &oSRSTarget, &anErrors, dfRefX, dfRefY, i]()
+            {
+                for (int iIter = 0; iIter < 20; ++iIter)
+                {
+                    auto poCT = OGRCreateCoordinateTransformation(&oSRSSource,
+                                                                  &oSRSTarget);
+                    double dfX = 2;
+                    double dfY = 49;
+                    if (!poCT || !poCT->Transform(1, &dfX, &dfY) ||
+                        std::fabs(dfX - dfRefX) > 1e-8 ||
+                        std::fabs(dfY - dfRefY) > 1e-8)
+                    {
+                        ++anErrors[i];
+                    }
+                    OGRCoordinateTransformation::DestroyCT(poCT);
+                }
+            });
+    }
+    for (auto &oThread : aoThreads)
+        oThread.join();
+    for (int i = 0; i < THREAD_COUNT; ++i)
+    {
+        EXPECT_EQ(anErrors[i], 0);
+    }
+}
 }  // namespace
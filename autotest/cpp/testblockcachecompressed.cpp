@@ -0,0 +1,104 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  GDAL Core
+ * Purpose:  Test compressed block cache (GDAL_COMPRESSED_CACHEMAX)
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_conv.h"
+#include "gdal_alg.h"
+#include "gdal_priv.h"
+#include "gdal.h"
+
+#include "gtest_include.h"
+
+namespace
+{
+
+// ---------------------------------------------------------------------------
+
+TEST(testblockcachecompressed, test)
+{
+    // Must be set before the first use of the block cache
+    CPLSetConfigOption("GDAL_CACHEMAX", "0");
+    CPLSetConfigOption("GDAL_COMPRESSED_CACHEMAX", "1");
+    GDALAllRegister();
+
+    const char *pszFilename = "/vsimem/testblockcachecompressed.tif";
+    {
+        auto poDrv = GetGDALDriverManager()->GetDriverByName("GTiff");
+        if (poDrv == nullptr)
+        {
+            GDALDestroyDriverManager();
+            GTEST_SKIP() << "GTiff driver missing";
+        }
+        const char *const apszOptions[] = {"TILED=YES", "BLOCKXSIZE=32",
+                                           "BLOCKYSIZE=32", nullptr};
+        GDALDatasetUniquePtr poDS(poDrv->Create(pszFilename, 64, 64, 1,
+                                                GDT_Byte, apszOptions));
+        ASSERT_NE(poDS, nullptr);
+        poDS->GetRasterBand(1)->Fill(127);
+    }
+
+    GDALDatasetUniquePtr poDS(GDALDataset::Open(pszFilename));
+    ASSERT_NE(poDS, nullptr);
+    auto poBand = poDS->GetRasterBand(1);
+    const int nChecksum = GDALChecksumImage(poBand, 0, 0, 64, 64);
+
+    GDALCacheStatistics sStats;
+    GDALGetCacheStatistics(&sStats);
+    if (sStats.nCompressedUsed == 0)
+    {
+        // Compressed cache not available (no compressor ?)
+        poDS.reset();
+        VSIUnlink(pszFilename);
+        GDALDestroyDriverManager();
+        GTEST_SKIP() << "Compressed block cache not enabled";
+    }
+    const GIntBig nHitsBefore = sStats.nCompressedHits;
+
+    // Evict the remaining block(s) of the main cache
+    while (GDALFlushCacheBlock())
+    {
+    }
+    EXPECT_EQ(GDALGetCacheUsed64(), 0);
+
+    // Blocks are now read from the compressed block cache
+    EXPECT_EQ(GDALChecksumImage(poBand, 0, 0, 64, 64), nChecksum);
+    GDALGetCacheStatistics(&sStats);
+    EXPECT_GE(sStats.nCompressedHits, nHitsBefore + 4);
+
+    // Closing the dataset must empty the compressed block cache
+    poDS.reset();
+    while (GDALFlushCacheBlock())
+    {
+    }
+    GDALGetCacheStatistics(&sStats);
+    EXPECT_EQ(sStats.nCompressedUsed, 0);
+
+    VSIUnlink(pszFilename);
+    GDALDestroyDriverManager();
+}
+
+}  // namespace
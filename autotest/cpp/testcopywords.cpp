@@ -30,8 +30,11 @@
 #include "cpl_conv.h"
 #include "gdal.h"
 
+#include <cmath>
 #include <cstdint>
 #include <iostream>
+#include <limits>
+#include <vector>
 
 #include "gtest_include.h"
 
@@ -1004,4 +1007,72 @@ TEST_F(TestCopyWords, Int16ToInt16)
     }
 }
 
+
+TEST_F(TestCopyWords, LargePackedConversions)
+{
+    // Use a word count that is not a multiple of the SIMD vector width, so
+    // that both the vectorized loop and the scalar tail are exercised.
+    constexpr int N = 1000 + 7;
+    for (int k = 0; k < 2; k++)
+    {
+        if (k == 1)
+            CPLSetConfigOption("GDAL_USE_AVX2", "NO");
+
+        {
+            std::vector<float> afIn(N);
+            for (int i = 0; i < N; i++)
+                afIn[i] = static_cast<float>(i) * 0.37f - 50.0f;
+            afIn[5] = std::numeric_limits<float>::quiet_NaN();
+            afIn[6] = std::numeric_limits<float>::infinity();
+            afIn[7] = -std::numeric_limits<float>::infinity();
+            afIn[8] = 1e20f;
+            afIn[N - 1] = std::numeric_limits<float>::quiet_NaN();
+            std::vector<GByte> abyOut(N);
+            GDALCopyWords(afIn.data(), GDT_Float32, sizeof(float),
+                          abyOut.data(), GDT_Byte, 1, N);
+            for (int i = 0; i < N; i++)
+            {
+                int nExpected = 0;
+                if (!std::isnan(afIn[i]))
+                {
+                    const float fVal = afIn[i] + 0.5f;
+                    nExpected = fVal >= 255.0f ? 255
+                                : fVal >= 0.0f ? static_cast<int>(fVal)
+                                               : 0;
+                }
+                ASSERT_EQ(abyOut[i], nExpected) << "i=" << i << ", k=" << k;
+            }
+        }
+
+        {
+            std::vector<GUInt16> anIn(N);
+            for (int i = 0; i < N; i++)
+                anIn[i] = static_cast<GUInt16>(i * 65);
+            std::vector<float> afOut(N);
+            GDALCopyWords(anIn.data(), GDT_UInt16, sizeof(GUInt16),
+                          afOut.data(), GDT_Float32, sizeof(float), N);
+            for (int i = 0; i < N; i++)
+            {
+                ASSERT_EQ(afOut[i], static_cast<float>(anIn[i]))
+                    << "i=" << i << ", k=" << k;
+            }
+        }
+
+        {
+            std::vector<GInt16> anIn(N);
+            for (int i = 0; i < N; i++)
+                anIn[i] = static_cast<GInt16>(i * 60 - 30000);
+            std::vector<double> adfOut(N);
+            GDALCopyWords(anIn.data(), GDT_Int16, sizeof(GInt16),
+                          adfOut.data(), GDT_Float64, sizeof(double), N);
+            for (int i = 0; i < N; i++)
+            {
+                ASSERT_EQ(adfOut[i], static_cast<double>(anIn[i]))
+                    << "i=" << i << ", k=" << k;
+            }
+        }
+    }
+    CPLSetConfigOption("GDAL_USE_AVX2", nullptr);
+}
+
 }  // namespace
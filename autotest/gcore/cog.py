@@ -410,6 +410,102 @@ def test_cog_creation_of_overviews_with_mask():
     gdal.Unlink(directory)
 
 
+###############################################################################
+# Test that multi-threaded, pipelined, overview generation gives the same
+# result as the single-threaded one, with temporary overviews kept in memory
+# or not
+
+
+@pytest.mark.parametrize("in_memory_max_size", ["0", "1000000000"])
+def test_cog_creation_of_overviews_multithreaded(tmp_vsimem, in_memory_max_size):
+
+    src_ds = gdal.Translate(
+        "", "data/byte.tif", options="-of MEM -outsize 1024 1000 -r bilinear"
+    )
+    src_ds.CreateMaskBand(gdal.GMF_PER_DATASET)
+    src_ds.GetRasterBand(1).GetMaskBand().WriteRaster(
+        0, 0, 500, 700, b"\xFF", buf_xsize=1, buf_ysize=1
+    )
+
+    def get_overview_checksums(num_threads):
+        filename = str(tmp_vsimem / ("cog_%s.tif" % num_threads))
+        with gdaltest.config_options(
+            {
+                "GDAL_OVR_CHUNK_MAX_SIZE": "1000",
+                "COG_TMP_OVERVIEW_IN_MEMORY_MAX_SIZE": in_memory_max_size,
+            }
+        ):
+            ds = gdal.GetDriverByName("COG").CreateCopy(
+                filename,
+                src_ds,
+                options=[
+                    "BLOCKSIZE=128",
+                    "OVERVIEW_COUNT=4",
+                    "NUM_THREADS=" + num_threads,
+                ],
+            )
+        assert ds
+        ds = None
+        ds = gdal.Open(filename)
+        band = ds.GetRasterBand(1)
+        assert band.GetOverviewCount() == 4
+        ret = [band.GetOverview(i).Checksum() for i in range(4)] + [
+            band.GetMaskBand().GetOverview(i).Checksum() for i in range(4)
+        ]
+        ds = None
+        _check_cog(filename)
+        return ret
+
+    assert get_overview_checksums("4") == get_overview_checksums("1")
+
+
+###############################################################################
+# Test STREAMING=YES creation option
+
+
+def test_cog_streaming(tmp_vsimem):
+
+    src_ds = gdal.Translate(
+        "", "data/byte.tif", options="-of MEM -outsize 1024 1000 -r bilinear"
+    )
+    src_ds.CreateMaskBand(gdal.GMF_PER_DATASET)
+    src_ds.GetRasterBand(1).GetMaskBand().WriteRaster(
+        0, 0, 500, 700, b"\xFF", buf_xsize=1, buf_ysize=1
+    )
+    options = ["BLOCKSIZE=128", "COMPRESS=LZW", "OVERVIEW_COUNT=3"]
+
+    ref_filename = str(tmp_vsimem / "ref.tif")
+    assert gdal.GetDriverByName("COG").CreateCopy(
+        ref_filename, src_ds, options=options
+    )
+
+    def get_content(filename):
+        f = gdal.VSIFOpenL(filename, "rb")
+        assert f
+        try:
+            return gdal.VSIFReadL(1, 100 * 1000 * 1000, f)
+        finally:
+            gdal.VSIFCloseL(f)
+
+    # /vsigzip/ only supports sequential writing
+    filename = "/vsigzip/" + str(tmp_vsimem / "out.tif.gz")
+    ds = gdal.GetDriverByName("COG").CreateCopy(
+        filename, src_ds, options=options + ["STREAMING=YES"]
+    )
+    assert ds
+    assert ds.GetRasterBand(1).GetOverviewCount() == 3
+    ds = None
+    assert get_content(filename) == get_content(ref_filename)
+
+    with gdaltest.config_option("COG_STREAMING_MAX_MEMORY", "100"):
+        with pytest.raises(Exception, match="COG_STREAMING_MAX_MEMORY"):
+            gdal.GetDriverByName("COG").CreateCopy(
+                str(tmp_vsimem / "out2.tif"),
+                src_ds,
+                options=options + ["STREAMING=YES"],
+            )
+
+
 ###############################################################################
 # Test MAX_Z_ERROR_OVERVIEW creation option
 
@@ -618,3 +618,63 @@ def test_geoloc_warnings_inconsistent_size(
         else:
             assert gdal.GetLastErrorMsg() == ""
         assert tr
+
+
+###############################################################################
+# Test that the backmap does not depend on the number of threads used to
+# build it
+
+
+def test_geoloc_backmap_multithreaded(tmp_vsimem):
+
+    r = random.Random(0)
+
+    xsize = 150
+    ysize = 120
+    geoloc_filename = str(tmp_vsimem / "lonlat.tif")
+    geoloc_ds = gdal.GetDriverByName("GTiff").Create(
+        geoloc_filename, xsize, ysize, 2, gdal.GDT_Float64
+    )
+    lon = array.array("d")
+    lat = array.array("d")
+    for y in range(ysize):
+        for x in range(xsize):
+            if 40 <= x < 45 and 50 <= y < 60:
+                lon.append(-999)
+                lat.append(-999)
+            else:
+                lon.append(-80 + 0.1 * x + 0.02 * y + r.uniform(-0.02, 0.02))
+                lat.append(50 - 0.1 * y + 0.03 * x + r.uniform(-0.02, 0.02))
+    geoloc_ds.GetRasterBand(1).WriteRaster(0, 0, xsize, ysize, lon)
+    geoloc_ds.GetRasterBand(1).SetNoDataValue(-999)
+    geoloc_ds.GetRasterBand(2).WriteRaster(0, 0, xsize, ysize, lat)
+    geoloc_ds.GetRasterBand(2).SetNoDataValue(-999)
+    geoloc_ds = None
+
+    ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize)
+    md = {
+        "LINE_OFFSET": "0",
+        "LINE_STEP": "1",
+        "PIXEL_OFFSET": "0",
+        "PIXEL_STEP": "1",
+        "X_DATASET": geoloc_filename,
+        "X_BAND": "1",
+        "Y_DATASET": geoloc_filename,
+        "Y_BAND": "2",
+        "SRS": "EPSG:4326",
+    }
+    ds.SetMetadata(md, "GEOLOCATION")
+
+    points = [
+        (-80 + 0.173 * i, 50 - 0.151 * j + 0.05 * i)
+        for i in range(100)
+        for j in range(90)
+    ]
+
+    res = []
+    for num_threads in ("1", "4"):
+        tr = gdal.Transformer(ds, None, ["NUM_THREADS=" + num_threads])
+        res.append(tr.TransformPoints(True, points))
+
+    assert res[0] == res[1]
+    assert sum(res[0][1]) > 1000
@@ -28,6 +28,7 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import pytest
 
 from osgeo import gdal
 
@@ -100,3 +101,33 @@ def test_identify_4():
             "../gdrivers/data/envi/aea.dat", sibling_files=["aea.dat", "aea.hdr"]
         )
         assert dr is not None, "Did not get a driver!"
+
+
+###############################################################################
+# Test opening of files whose first bytes match a driver GDAL_DMD_SIGNATURES
+
+
+def test_identify_driver_signatures():
+
+    drv = gdal.GetDriverByName("PNG")
+    if drv is None:
+        pytest.skip("PNG driver missing")
+    assert drv.GetMetadataItem(gdal.DMD_SIGNATURES) == "89504E470D0A1A0A"
+
+    ds = gdal.Open("../gdrivers/data/png/test.png")
+    assert ds.GetDriver().ShortName == "PNG"
+
+    ds = gdal.OpenEx("../gdrivers/data/png/test.png", gdal.OF_RASTER)
+    assert ds.GetDriver().ShortName == "PNG"
+
+    # Matching driver not allowed
+    with pytest.raises(Exception):
+        gdal.OpenEx("../gdrivers/data/png/test.png", allowed_drivers=["GTiff"])
+
+    # Matching driver not compatible of the requested mode
+    with pytest.raises(Exception):
+        gdal.OpenEx("../gdrivers/data/png/test.png", gdal.OF_VECTOR)
+
+    # Other drivers are still probed after the matching ones
+    ds = gdal.Open("data/byte.tif")
+    assert ds.GetDriver().ShortName == "GTiff"
@@ -1021,3 +1021,241 @@ def test_mask_setting_nodata(dt):
     assert ds.GetRasterBand(1).GetMaskBand().ReadRaster() == struct.pack("B", 0)
     ds.GetRasterBand(1).DeleteNoDataValue()
     assert ds.GetRasterBand(1).GetMaskBand().ReadRaster() == struct.pack("B", 255)
+
+
+###############################################################################
+# Test nodata masks against a reference computed in Python, for the working
+# types of GDALComputeNoDataMask(), on tiled rasters with partial edge blocks,
+# with and without the parent blocks being in the block cache.
+
+_mask_formats = {
+    gdal.GDT_Byte: "B",
+    gdal.GDT_UInt16: "H",
+    gdal.GDT_Int16: "h",
+    gdal.GDT_UInt32: "I",
+    gdal.GDT_Int32: "i",
+    gdal.GDT_Float32: "f",
+    gdal.GDT_Float64: "d",
+}
+
+
+def _mask_is_nodata(val, nodata):
+    if nodata != nodata:
+        return val != val
+    if val != val:
+        return False
+    if abs(nodata) == float("inf"):
+        return val == nodata
+    # Values used in the tests are either within a few ulps of the nodata
+    # value, or far away from it.
+    return val == nodata or abs(val - nodata) <= 1e-6 * abs(nodata)
+
+
+def _mask_values(dt, nodata, count):
+    if dt in (gdal.GDT_Float32, gdal.GDT_Float64):
+        candidates = [0.0, 1.0, -2.5, float("nan"), float("inf"), float("-inf")]
+        if nodata == nodata and abs(nodata) != float("inf"):
+            ulp = 2**-23 if dt == gdal.GDT_Float32 else 2**-52
+            candidates += [
+                nodata,
+                nodata * (1 + ulp),
+                nodata * (1 - ulp),
+                nodata * (1 + 1e-4),
+                nodata * (1 - 1e-4),
+            ]
+        else:
+            candidates += [nodata, nodata]
+    else:
+        candidates = [0, 1, 2, 127, 255, nodata, nodata]
+    values = [candidates[(i * 7 + i // 5) % len(candidates)] for i in range(count)]
+    # Round to the precision of the data type
+    fmt = "<%d%s" % (count, _mask_formats[dt])
+    return list(struct.unpack(fmt, struct.pack(fmt, *values)))
+
+
+@pytest.mark.parametrize(
+    "dt,nodata",
+    [
+        (gdal.GDT_Byte, 255),
+        (gdal.GDT_Byte, 0),
+        (gdal.GDT_UInt16, 255),
+        (gdal.GDT_Int16, 127),
+        (gdal.GDT_UInt32, 2),
+        (gdal.GDT_Int32, 1),
+        (gdal.GDT_Float32, 1.5),
+        (gdal.GDT_Float32, -3.25e10),
+        (gdal.GDT_Float32, float("nan")),
+        (gdal.GDT_Float32, float("inf")),
+        (gdal.GDT_Float32, float("-inf")),
+        (gdal.GDT_Float64, 1.5),
+        (gdal.GDT_Float64, float("nan")),
+        (gdal.GDT_Float64, float("inf")),
+    ],
+)
+def test_mask_nodata_partial_blocks(tmp_vsimem, dt, nodata):
+
+    filename = str(tmp_vsimem / "test.tif")
+    xsize, ysize, blocksize = 37, 21, 16
+    values = _mask_values(dt, nodata, xsize * ysize)
+    ds = gdal.GetDriverByName("GTiff").Create(
+        filename,
+        xsize,
+        ysize,
+        1,
+        dt,
+        options=["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16"],
+    )
+    ds.GetRasterBand(1).SetNoDataValue(nodata)
+    ds.GetRasterBand(1).WriteRaster(
+        0,
+        0,
+        xsize,
+        ysize,
+        struct.pack("<%d%s" % (xsize * ysize, _mask_formats[dt]), *values),
+    )
+    ds = None
+
+    expected = [0 if _mask_is_nodata(v, nodata) else 255 for v in values]
+    assert 0 in expected and 255 in expected
+
+    def expected_block(xblock, yblock):
+        ret = bytearray(blocksize * blocksize)
+        for y in range(blocksize):
+            for x in range(blocksize):
+                xx = xblock * blocksize + x
+                yy = yblock * blocksize + y
+                if xx < xsize and yy < ysize:
+                    ret[y * blocksize + x] = expected[yy * xsize + xx]
+        return bytes(ret)
+
+    nblocksx = (xsize + blocksize - 1) // blocksize
+    nblocksy = (ysize + blocksize - 1) // blocksize
+
+    # RasterIO() on the mask band
+    ds = gdal.Open(filename)
+    band = ds.GetRasterBand(1)
+    assert band.GetMaskFlags() == gdal.GMF_NODATA
+    assert band.GetMaskBand().ReadRaster() == bytes(expected)
+    assert band.GetMaskBand().ReadRaster(1, 3, 33, 17) == b"".join(
+        bytes(expected[y * xsize + 1 : y * xsize + 34]) for y in range(3, 20)
+    )
+    ds = None
+
+    # Blocks read without and with the parent block in the block cache
+    for read_parent_first in (False, True):
+        ds = gdal.Open(filename)
+        band = ds.GetRasterBand(1)
+        for yblock in range(nblocksy):
+            for xblock in range(nblocksx):
+                if read_parent_first:
+                    band.ReadBlock(xblock, yblock)
+                assert band.GetMaskBand().ReadBlock(xblock, yblock) == expected_block(
+                    xblock, yblock
+                ), (read_parent_first, xblock, yblock)
+        ds = None
+
+
+###############################################################################
+# Test NODATA_VALUES masks, where a pixel is masked only when all bands are
+# nodata, on a raster with partial edge blocks.
+
+
+@pytest.mark.parametrize(
+    "dt,nodata_values",
+    [
+        (gdal.GDT_Byte, (1, 2, 255)),
+        (gdal.GDT_UInt16, (1, 2, 255)),
+        (gdal.GDT_Int32, (-1, 2, 127)),
+        (gdal.GDT_Float32, (1.5, 2.0, -2.5)),
+        (gdal.GDT_Float64, (1.5, 2.0, -2.5)),
+    ],
+)
+def test_mask_nodata_values_partial_blocks(tmp_vsimem, dt, nodata_values):
+
+    filename = str(tmp_vsimem / "test.tif")
+    xsize, ysize = 37, 21
+    count = xsize * ysize
+    fmt = "<%d%s" % (count, _mask_formats[dt])
+    ds = gdal.GetDriverByName("GTiff").Create(
+        filename,
+        xsize,
+        ysize,
+        3,
+        dt,
+        options=["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16", "INTERLEAVE=BAND"],
+    )
+    ds.SetMetadataItem("NODATA_VALUES", " ".join(str(v) for v in nodata_values))
+    band_values = []
+    for i, nodata in enumerate(nodata_values):
+        # Each band is nodata at a different set of pixels, that overlap
+        values = [nodata if (j % (i + 2)) == 0 else 0 for j in range(count)]
+        ds.GetRasterBand(i + 1).WriteRaster(
+            0, 0, xsize, ysize, struct.pack(fmt, *values)
+        )
+        band_values.append(values)
+    ds = None
+
+    expected = bytes(
+        0 if all(band_values[i][j] == nodata_values[i] for i in range(3)) else 255
+        for j in range(count)
+    )
+    assert 0 in expected and 255 in expected
+
+    ds = gdal.Open(filename)
+    band = ds.GetRasterBand(1)
+    assert band.GetMaskFlags() == gdal.GMF_PER_DATASET + gdal.GMF_NODATA
+    assert band.GetMaskBand().ReadRaster() == expected
+    for yblock in range(2):
+        for xblock in range(3):
+            data = band.GetMaskBand().ReadBlock(xblock, yblock)
+            for y in range(min(16, ysize - yblock * 16)):
+                x0 = xblock * 16
+                x1 = min(x0 + 16, xsize)
+                yy = yblock * 16 + y
+                assert (
+                    data[y * 16 : y * 16 + x1 - x0]
+                    == expected[yy * xsize + x0 : yy * xsize + x1]
+                )
+
+
+###############################################################################
+# Test the rescaling of UInt16 alpha bands to Byte masks, on widths that are
+# and are not multiple of 16
+
+
+@pytest.mark.parametrize("xsize", [16, 37])
+def test_mask_rescaled_alpha(tmp_vsimem, xsize):
+
+    filename = str(tmp_vsimem / "test.tif")
+    ysize = 3
+    alpha_values = [0, 1, 2, 255, 256, 257, 258, 513, 32767, 32768, 65279, 65534, 65535]
+    count = xsize * ysize
+    values = [alpha_values[(i * 5) % len(alpha_values)] for i in range(count)]
+    ds = gdal.GetDriverByName("GTiff").Create(
+        filename, xsize, ysize, 2, gdal.GDT_UInt16, options=["ALPHA=YES"]
+    )
+    ds.GetRasterBand(2).WriteRaster(
+        0, 0, xsize, ysize, struct.pack("<%dH" % count, *values)
+    )
+    ds = None
+
+    expected = bytes(1 if 0 < v < 257 else (v * 255) // 65535 for v in values)
+
+    ds = gdal.Open(filename)
+    band = ds.GetRasterBand(1)
+    assert band.GetMaskFlags() == gdal.GMF_ALPHA + gdal.GMF_PER_DATASET
+    mask = band.GetMaskBand()
+    # Optimized IRasterIO() case
+    assert mask.ReadRaster() == expected
+    assert mask.ReadRaster(1, 1, xsize - 1, 2) == b"".join(
+        expected[y * xsize + 1 : (y + 1) * xsize] for y in range(1, 3)
+    )
+    # Generic case
+    assert mask.ReadRaster(buf_type=gdal.GDT_UInt16) == struct.pack(
+        "<%dH" % count, *expected
+    )
+    # IReadBlock()
+    xblocksize, yblocksize = mask.GetBlockSize()
+    assert mask.ReadBlock(0, 0)[0 : xsize * min(yblocksize, ysize)] == expected[
+        0 : xsize * min(yblocksize, ysize)
+    ]
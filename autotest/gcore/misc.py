@@ -977,6 +977,174 @@ def test_misc_get_config_options():
         gdal.SetConfigOption("B", None)
 
 
+###############################################################################
+# Test that GDALChecksumImage() gives the same result with several threads,
+# including for windows split into several chunks of lines or of blocks
+
+
+def _misc_checksum_create(filename, dt, xsize, ysize, blockxsize, blockysize):
+
+    import array
+
+    n = xsize * ysize
+    if dt in (gdal.GDT_Float32, gdal.GDT_CFloat32):
+        nvals = n * (2 if dt == gdal.GDT_CFloat32 else 1)
+        vals = array.array(
+            "f", [((i * 7919) % 10007) / 7.0 - 500 for i in range(nvals)]
+        )
+        vals[123] = float("nan")
+        vals[456] = float("inf")
+        buf_type = gdal.GDT_Float32 if dt == gdal.GDT_Float32 else dt
+    elif dt == gdal.GDT_CInt16:
+        vals = array.array("h", [(i * 7919) % 20011 - 10000 for i in range(2 * n)])
+        buf_type = gdal.GDT_CInt16
+    else:
+        vals = array.array("h", [(i * 7919) % 251 for i in range(n)])
+        buf_type = gdal.GDT_Int16
+    ds = gdal.GetDriverByName("GTiff").Create(
+        filename,
+        xsize,
+        ysize,
+        1,
+        dt,
+        options=[
+            "TILED=YES",
+            "BLOCKXSIZE=%d" % blockxsize,
+            "BLOCKYSIZE=%d" % blockysize,
+        ],
+    )
+    ds.GetRasterBand(1).WriteRaster(
+        0, 0, xsize, ysize, vals.tobytes(), buf_type=buf_type
+    )
+    ds = None
+
+
+@pytest.mark.parametrize(
+    "dt,blockxsize,blockysize",
+    [
+        (gdal.GDT_Byte, 256, 256),
+        (gdal.GDT_Int16, 256, 256),
+        (gdal.GDT_Float32, 256, 256),
+        (gdal.GDT_Float32, 256, 1024),
+        (gdal.GDT_CInt16, 256, 256),
+        (gdal.GDT_CFloat32, 256, 256),
+    ],
+)
+def test_misc_checksum_multithreaded(tmp_vsimem, dt, blockxsize, blockysize):
+
+    filename = str(tmp_vsimem / "test.tif")
+    _misc_checksum_create(filename, dt, 1100, 1000, blockxsize, blockysize)
+
+    ds = gdal.Open(filename)
+    band = ds.GetRasterBand(1)
+    windows = [
+        (0, 0, 1100, 1000),
+        (3, 5, 1001, 900),
+        (17, 0, 1083, 1000),
+        (0, 300, 1100, 700),
+        (600, 700, 1, 300),
+    ]
+    with gdal.config_option("GDAL_NUM_THREADS", "1"):
+        expected = [band.Checksum(*window) for window in windows]
+    for num_threads in ("2", "4", "ALL_CPUS"):
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            assert [band.Checksum(*window) for window in windows] == expected
+
+    # Datasets opened in update mode are not reopened and use the sequential
+    # code
+    ds = None
+    ds = gdal.Open(filename, gdal.GA_Update)
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        assert [ds.GetRasterBand(1).Checksum(*window) for window in windows] == (
+            expected
+        )
+
+
+###############################################################################
+# Test GDAL_CACHE_CHECKSUM
+
+
+def test_misc_checksum_cache(tmp_path):
+
+    filename = str(tmp_path / "test.tif")
+    aux_filename = filename + ".aux.xml"
+    gdal.Translate(filename, "data/byte.tif")
+
+    def tamper_cached_value(value):
+        with open(aux_filename, "rt") as f:
+            content = f.read()
+        assert '<MDI key="VALUE">' in content
+        import re
+
+        content = re.sub(
+            '<MDI key="VALUE">[0-9]*</MDI>',
+            '<MDI key="VALUE">%d</MDI>' % value,
+            content,
+        )
+        with open(aux_filename, "wt") as f:
+            f.write(content)
+
+    # Not cached without the configuration option
+    ds = gdal.Open(filename)
+    assert ds.GetRasterBand(1).Checksum() == 4672
+    ds = None
+    assert not os.path.exists(aux_filename)
+
+    with gdal.config_option("GDAL_CACHE_CHECKSUM", "YES"):
+        # Partial windows are not cached
+        ds = gdal.Open(filename)
+        assert ds.GetRasterBand(1).Checksum(0, 0, 10, 10) != 4672
+        ds = None
+        assert not os.path.exists(aux_filename)
+
+        ds = gdal.Open(filename)
+        assert ds.GetRasterBand(1).Checksum() == 4672
+        md = ds.GetRasterBand(1).GetMetadata("CHECKSUM")
+        assert md["VALUE"] == "4672"
+        assert "SIGNATURE" in md
+        ds = None
+    assert os.path.exists(aux_filename)
+
+    # Check that the cached value is used while the file is unchanged
+    tamper_cached_value(1234)
+    with gdal.config_option("GDAL_CACHE_CHECKSUM", "YES"):
+        ds = gdal.Open(filename)
+        assert ds.GetRasterBand(1).Checksum() == 1234
+        ds = None
+
+    # but not without the configuration option
+    ds = gdal.Open(filename)
+    assert ds.GetRasterBand(1).Checksum() == 4672
+    ds = None
+
+    # Check that a change of modification time invalidates the cache
+    st = os.stat(filename)
+    os.utime(filename, (st.st_atime, st.st_mtime + 10))
+    with gdal.config_option("GDAL_CACHE_CHECKSUM", "YES"):
+        ds = gdal.Open(filename)
+        assert ds.GetRasterBand(1).Checksum() == 4672
+        ds = None
+
+    # Check that a change of size invalidates the cache, even with the same
+    # modification time
+    tamper_cached_value(1234)
+    st = os.stat(filename)
+    with open(filename, "ab") as f:
+        f.write(b"\0" * 16)
+    os.utime(filename, (st.st_atime, st.st_mtime))
+    with gdal.config_option("GDAL_CACHE_CHECKSUM", "YES"):
+        ds = gdal.Open(filename)
+        assert ds.GetRasterBand(1).Checksum() == 4672
+        ds = None
+
+    # Datasets opened in update mode do not use the cache
+    tamper_cached_value(1234)
+    with gdal.config_option("GDAL_CACHE_CHECKSUM", "YES"):
+        ds = gdal.Open(filename, gdal.GA_Update)
+        assert ds.GetRasterBand(1).Checksum() == 4672
+        ds = None
+
+
 ###############################################################################
 
 
@@ -611,3 +611,37 @@ def test_pam_nodata_nan():
     # Check that no PAM file is generated
     assert gdal.VSIStatL(outfilename + ".aux.xml") is None
     gdal.GetDriverByName("GTiff").Delete(outfilename)
+
+
+###############################################################################
+# Check that side-car files are ignored with GDAL_OF_HEADER_ONLY
+
+
+def test_pam_open_header_only(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test_pam_open_header_only.tif")
+    ds = gdal.GetDriverByName("GTiff").Create(filename, 10, 10)
+    ds = None
+
+    ds = gdal.Open(filename)
+    ds.SetMetadataItem("FOO", "BAR")
+    ds.BuildOverviews("NEAR", [2])
+    ds = None
+    assert gdal.VSIStatL(filename + ".aux.xml") is not None
+    assert gdal.VSIStatL(filename + ".ovr") is not None
+
+    ds = gdal.OpenEx(filename, gdal.OF_RASTER | gdal.OF_HEADER_ONLY)
+    assert ds.GetMetadataItem("FOO") is None
+    assert ds.GetRasterBand(1).GetOverviewCount() == 0
+    # Must not overwrite the existing PAM file
+    ds.SetMetadataItem("BAZ", "BAW")
+    ds = None
+
+    ds = gdal.Open(filename)
+    assert ds.GetMetadataItem("FOO") == "BAR"
+    assert ds.GetMetadataItem("BAZ") is None
+    assert ds.GetRasterBand(1).GetOverviewCount() == 1
+    ds = None
+
+    with pytest.raises(Exception, match="not compatible with GDAL_OF_UPDATE"):
+        gdal.OpenEx(filename, gdal.OF_RASTER | gdal.OF_UPDATE | gdal.OF_HEADER_ONLY)
@@ -1465,3 +1465,146 @@ def test_pixfun_max_no_nodata():
 
 
 ###############################################################################
+
+
+###############################################################################
+# Test the expression pixel function
+
+
+def test_pixfun_expression(tmp_vsimem):
+
+    src_filename = str(tmp_vsimem / "src.tif")
+    src_ds = gdal.GetDriverByName("GTiff").Create(src_filename, 1500, 2, 2)
+    red = numpy.array([[i % 256 for i in range(1500)]] * 2, dtype=numpy.uint8)
+    nir = numpy.array(
+        [[(i * 7) % 256 for i in range(1500)]] * 2, dtype=numpy.uint8
+    )
+    src_ds.GetRasterBand(1).WriteArray(red)
+    src_ds.GetRasterBand(2).WriteArray(nir)
+    src_ds = None
+
+    def get_vrt(expression, data_type="Float32", extra=""):
+        expression = expression.replace("&", "&amp;").replace("<", "&lt;")
+        return f"""<VRTDataset rasterXSize="1500" rasterYSize="2">
+  <VRTRasterBand dataType="{data_type}" band="1" subClass="VRTDerivedRasterBand">
+    {extra}
+    <PixelFunctionType>expression</PixelFunctionType>
+    <PixelFunctionArguments expression="{expression}" />
+    <SimpleSource>
+      <SourceFilename>{src_filename}</SourceFilename>
+      <SourceBand>1</SourceBand>
+    </SimpleSource>
+    <SimpleSource>
+      <SourceFilename>{src_filename}</SourceFilename>
+      <SourceBand>2</SourceBand>
+    </SimpleSource>
+  </VRTRasterBand>
+</VRTDataset>"""
+
+    r = red.astype(numpy.float64)
+    n = nir.astype(numpy.float64)
+
+    ds = gdal.Open(get_vrt("(B2 + B1) == 0 ? -2 : (B2 - B1) / (B2 + B1)"))
+    with numpy.errstate(divide="ignore", invalid="ignore"):
+        expected = numpy.where(n + r == 0, -2, (n - r) / (n + r))
+    numpy.testing.assert_allclose(
+        ds.GetRasterBand(1).ReadAsArray(), expected.astype(numpy.float32)
+    )
+
+    # Output data type conversion, with clamping
+    ds = gdal.Open(get_vrt("B1 * 2 + min(B2, 10, 20) - 2^2", "Byte"))
+    expected = numpy.clip(r * 2 + numpy.minimum(n, 10) - 4, 0, 255)
+    numpy.testing.assert_equal(ds.GetRasterBand(1).ReadAsArray(), expected)
+
+    # NODATA and propagateNoData
+    ds = gdal.Open(
+        get_vrt(
+            "B1 < 10 && !(B1 < 5) ? NODATA : B1",
+            "Int16",
+            "<NoDataValue>-1</NoDataValue>",
+        )
+    )
+    expected = numpy.where((r >= 5) & (r < 10), -1, r)
+    numpy.testing.assert_equal(ds.GetRasterBand(1).ReadAsArray(), expected)
+
+    ds = gdal.Open(
+        get_vrt("B1 + 1", "Int16", "<NoDataValue>0</NoDataValue>").replace(
+            "<PixelFunctionArguments ",
+            '<PixelFunctionArguments propagateNoData="true" ',
+        )
+    )
+    expected = numpy.where((r == 0) | (n == 0), 0, r + 1)
+    numpy.testing.assert_equal(ds.GetRasterBand(1).ReadAsArray(), expected)
+
+    # Errors
+    for expression, msg in [
+        ("B1 +", "unexpected end"),
+        ("B3", "only 2 sources"),
+        ("foo(B1)", "unknown function"),
+        ("max(B1)", "wrong number of arguments"),
+        ("B1 + x", "unknown identifier"),
+        ("(B1", "')' expected"),
+    ]:
+        ds = gdal.Open(get_vrt(expression))
+        with pytest.raises(Exception, match=msg):
+            ds.GetRasterBand(1).ReadRaster()
+
+
+###############################################################################
+# Test that pixel functions supporting native source types give the same
+# results when sources are read in their own data type
+
+
+@pytest.mark.parametrize(
+    "pixfn,func",
+    [
+        ("sum", lambda a, b: a + b),
+        ("mul", lambda a, b: a * b),
+        ("min", numpy.minimum),
+        ("max", numpy.maximum),
+    ],
+)
+def test_pixfun_native_source_type(tmp_vsimem, pixfn, func):
+
+    src_filename = str(tmp_vsimem / "src.tif")
+    src_ds = gdal.GetDriverByName("GTiff").Create(
+        src_filename, 20, 3, 2, gdal.GDT_UInt16
+    )
+    a = numpy.arange(60, dtype=numpy.uint16).reshape(3, 20) * 1000
+    b = numpy.arange(60, dtype=numpy.uint16).reshape(3, 20)[::-1] + 1
+    src_ds.GetRasterBand(1).WriteArray(a)
+    src_ds.GetRasterBand(2).WriteArray(b)
+    src_ds = None
+
+    def get_vrt(nodata):
+        return f"""<VRTDataset rasterXSize="30" rasterYSize="3">
+  <VRTRasterBand dataType="Float64" band="1" subClass="VRTDerivedRasterBand">
+    <NoDataValue>{nodata}</NoDataValue>
+    <PixelFunctionType>{pixfn}</PixelFunctionType>
+    <SimpleSource>
+      <SourceFilename>{src_filename}</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <DstRect xOff="0" yOff="0" xSize="20" ySize="3" />
+    </SimpleSource>
+    <SimpleSource>
+      <SourceFilename>{src_filename}</SourceFilename>
+      <SourceBand>2</SourceBand>
+      <DstRect xOff="0" yOff="0" xSize="20" ySize="3" />
+    </SimpleSource>
+  </VRTRasterBand>
+</VRTDataset>"""
+
+    expected = func(a.astype(numpy.float64), b.astype(numpy.float64))
+
+    # Nodata representable in UInt16: sources can be read as UInt16
+    ar = gdal.Open(get_vrt(65535)).GetRasterBand(1).ReadAsArray()
+    numpy.testing.assert_equal(ar[:, 0:20], expected)
+
+    # Nodata not representable in UInt16: areas not covered by sources must
+    # be computed from the nodata value
+    ar = gdal.Open(get_vrt(-1)).GetRasterBand(1).ReadAsArray()
+    numpy.testing.assert_equal(ar[:, 0:20], expected)
+    expected_uncovered = func(numpy.float64(-1), numpy.float64(-1))
+    if pixfn in ("min", "max"):
+        expected_uncovered = -1
+    assert numpy.all(ar[:, 20:] == expected_uncovered)
@@ -3119,6 +3119,47 @@ def test_rasterio_gauss_float64():
     assert struct.unpack("d" * (2 * 2), data) == (valid, nd, nd, nd)
 
 
+###############################################################################
+# Test mode downsampling by a factor of 2 on exact boundaries, with Byte data
+# type, for all combinations of equal values in a 2x2 window
+
+
+def test_rasterio_mode_halfsize_downsampling_byte():
+
+    windows = [
+        (a, b, c, d)
+        for a in range(4)
+        for b in range(4)
+        for c in range(4)
+        for d in range(4)
+    ]
+    windows += windows[0:5]
+
+    def mode(vals):
+        counts = {}
+        max_count = 0
+        res = None
+        for v in vals:
+            counts[v] = counts.get(v, 0) + 1
+            if counts[v] > max_count:
+                max_count = counts[v]
+                res = v
+        return res
+
+    first_line = []
+    second_line = []
+    for a, b, c, d in windows:
+        first_line += [a, b]
+        second_line += [c, d]
+
+    ds = gdal.GetDriverByName("MEM").Create("", 2 * len(windows), 2)
+    ds.WriteRaster(0, 0, 2 * len(windows), 2, bytes(first_line + second_line))
+    data = ds.GetRasterBand(1).ReadRaster(
+        buf_xsize=len(windows), buf_ysize=1, resample_alg=gdal.GRIORA_Mode
+    )
+    assert list(data) == [mode(w) for w in windows]
+
+
 ###############################################################################
 # Test resampling with Float64
 
@@ -3294,3 +3335,43 @@ def test_rasterio_overview_selection():
         assert ds.GetRasterBand(1).ReadRaster(0, 0, 100, 100, 29, 29)[0] == 2
         assert ds.GetRasterBand(1).ReadRaster(0, 0, 100, 100, 25, 25)[0] == 3
         assert ds.GetRasterBand(1).ReadRaster(0, 0, 100, 100, 24, 24)[0] == 3
+
+
+###############################################################################
+# Test that resampled requests with a buffer data type different from the
+# band one go through the band data type, and give stable results when
+# repeated
+
+
+@pytest.mark.parametrize(
+    "resample_alg",
+    [gdal.GRIORA_Bilinear, gdal.GRIORA_Cubic, gdal.GRIORA_Average],
+)
+def test_rasterio_resampled_buffer_type_conversion(resample_alg):
+
+    ds = gdal.GetDriverByName("MEM").Create("", 6, 6)
+    ds.GetRasterBand(1).WriteRaster(
+        0, 0, 6, 6, bytes([(i * 37) % 256 for i in range(36)])
+    )
+
+    ref = ds.GetRasterBand(1).ReadRaster(0, 0, 6, 6, 3, 3, resample_alg=resample_alg)
+    for _ in range(2):
+        assert (
+            ds.GetRasterBand(1).ReadRaster(
+                0, 0, 6, 6, 3, 3, resample_alg=resample_alg
+            )
+            == ref
+        )
+    got = struct.unpack(
+        "f" * 9,
+        ds.GetRasterBand(1).ReadRaster(
+            0, 0, 6, 6, 3, 3, buf_type=gdal.GDT_Float32, resample_alg=resample_alg
+        ),
+    )
+    assert got == tuple(float(x) for x in ref)
+
+    # Odd pixel spacing
+    got = ds.GetRasterBand(1).ReadRaster(
+        0, 0, 6, 6, 3, 3, buf_pixel_space=2, resample_alg=resample_alg
+    )
+    assert got[::2] == ref
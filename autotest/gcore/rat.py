@@ -178,3 +178,144 @@ def test_rat_4():
 
 
 ##############################################################################
+
+
+###############################################################################
+# Check that GetRowOfValue() returns the same row as a linear scan of the
+# Min/Max ranges, whether the sorted index of ranges can be used or not
+
+
+def _rat_linear_row_of_value(ranges, value):
+    for i, (vmin, vmax) in enumerate(ranges):
+        if vmin <= value <= vmax:
+            return i
+    return -1
+
+
+@pytest.mark.parametrize(
+    "case", ["minmax_int", "min_max_real", "overlapping", "duplicates"]
+)
+def test_rat_get_row_of_value(case):
+
+    rat = gdal.RasterAttributeTable()
+    nrows = 1000
+    # Deterministic shuffling of the rows
+    perm = [(i * 379) % nrows for i in range(nrows)]
+    if case in ("minmax_int", "duplicates"):
+        rat.CreateColumn("Value", gdal.GFT_Integer, gdal.GFU_MinMax)
+        rat.SetRowCount(nrows)
+        ranges = []
+        for i in range(nrows):
+            val = 2 * perm[i]
+            if case == "duplicates":
+                val //= 10
+            rat.SetValueAsInt(i, 0, val)
+            ranges.append((val, val))
+    else:
+        rat.CreateColumn("Min", gdal.GFT_Real, gdal.GFU_Min)
+        rat.CreateColumn("Max", gdal.GFT_Real, gdal.GFU_Max)
+        rat.SetRowCount(nrows)
+        ranges = []
+        for i in range(nrows):
+            vmin = perm[i] * 1.0
+            vmax = vmin + (2.5 if case == "overlapping" else 0.5)
+            rat.SetValueAsDouble(i, 0, vmin)
+            rat.SetValueAsDouble(i, 1, vmax)
+            ranges.append((vmin, vmax))
+
+    values = [-1e10, -1, 1e10, float("inf"), -float("inf")]
+    for v in range(-2, 2 * nrows + 3):
+        values += [v, v + 0.25, v + 0.5, v + 0.75]
+    for value in values:
+        assert rat.GetRowOfValue(value) == _rat_linear_row_of_value(
+            ranges, value
+        ), value
+    assert rat.GetRowOfValue(float("nan")) == -1
+
+    # Modifying the table must invalidate the index
+    if case in ("minmax_int", "duplicates"):
+        rat.SetValueAsInt(nrows // 2, 0, -100)
+        ranges[nrows // 2] = (-100, -100)
+    else:
+        rat.SetValueAsDouble(nrows // 2, 0, -100.0)
+        ranges[nrows // 2] = (-100.0, ranges[nrows // 2][1])
+    for value in (-100, -99.5, ranges[nrows // 2][1]):
+        assert rat.GetRowOfValue(value) == _rat_linear_row_of_value(
+            ranges, value
+        ), value
+
+    rat.SetRowCount(nrows + 1)
+    ranges.append((0, 0))
+    for value in (0, 0.25, 1):
+        assert rat.GetRowOfValue(value) == _rat_linear_row_of_value(
+            ranges, value
+        ), value
+
+    # Same answers from a copy
+    rat2 = rat.Clone()
+    for value in values[::7]:
+        assert rat2.GetRowOfValue(value) == rat.GetRowOfValue(value), value
+
+
+###############################################################################
+# Check that attribute tables written with the binary encoding of columns
+# (GDAL_RAT_XML_BINARY_ENCODING) are read back identically
+
+
+@pytest.mark.parametrize(
+    "binary_encoding,nrows,expect_binary",
+    [
+        ("NO", 10, False),
+        ("YES", 10, True),
+        ("YES", 0, True),
+        ("AUTO", 10, False),
+        ("AUTO", 100000, True),
+        ("NO", 100000, False),
+    ],
+)
+def test_rat_xml_binary_encoding(tmp_path, binary_encoding, nrows, expect_binary):
+
+    rat = gdal.RasterAttributeTable()
+    rat.CreateColumn("Value", gdal.GFT_Integer, gdal.GFU_MinMax)
+    rat.CreateColumn("Area", gdal.GFT_Real, gdal.GFU_Generic)
+    rat.CreateColumn("Name", gdal.GFT_String, gdal.GFU_Name)
+    rat.SetRowCount(nrows)
+    strings = ["", "foo", "é漢字", "a,b;<c>&d"]
+    for i in range(nrows):
+        rat.SetValueAsInt(i, 0, i - 5 if i % 3 else -(2**31) + i)
+        rat.SetValueAsDouble(i, 1, i * 0.25 + (1.0 / 3 if i % 2 else 0))
+        rat.SetValueAsString(i, 2, strings[i % len(strings)])
+
+    filename = str(tmp_path / "test.tif")
+    ds = gdal.GetDriverByName("GTiff").Create(filename, 1, 1)
+    ds.GetRasterBand(1).SetDefaultRAT(rat)
+    with gdal.config_option("GDAL_RAT_XML_BINARY_ENCODING", binary_encoding):
+        ds = None
+
+    aux_xml = open(filename + ".aux.xml", "rt", encoding="UTF-8").read()
+    if expect_binary:
+        assert "<ColumnData" in aux_xml
+        assert "<Row" not in aux_xml
+    else:
+        assert "<ColumnData" not in aux_xml
+
+    ds = gdal.Open(filename)
+    rat2 = ds.GetRasterBand(1).GetDefaultRAT()
+    assert rat2.GetColumnCount() == 3
+    assert rat2.GetRowCount() == nrows
+    for i in range(3):
+        assert rat2.GetNameOfCol(i) == rat.GetNameOfCol(i)
+        assert rat2.GetTypeOfCol(i) == rat.GetTypeOfCol(i)
+        assert rat2.GetUsageOfCol(i) == rat.GetUsageOfCol(i)
+    step = max(1, nrows // 1000)
+    for i in list(range(0, nrows, step)) + list(range(max(0, nrows - 5), nrows)):
+        assert rat2.GetValueAsInt(i, 0) == rat.GetValueAsInt(i, 0), i
+        if expect_binary:
+            assert rat2.GetValueAsDouble(i, 1) == rat.GetValueAsDouble(i, 1), i
+        else:
+            assert rat2.GetValueAsDouble(i, 1) == pytest.approx(
+                rat.GetValueAsDouble(i, 1), rel=1e-15
+            ), i
+        assert rat2.GetValueAsString(i, 2) == rat.GetValueAsString(i, 2), i
+    if nrows:
+        assert rat2.GetRowOfValue(2) == 7
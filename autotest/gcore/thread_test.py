@@ -75,3 +75,46 @@ def test_thread_test_1():
             ret = False
 
     assert ret
+
+
+###############################################################################
+# Test GDAL_OF_THREAD_SAFE
+
+
+def test_thread_test_thread_safe_dataset():
+
+    with pytest.raises(Exception):
+        gdal.OpenEx("data/byte.tif", gdal.OF_THREAD_SAFE | gdal.OF_UPDATE)
+    with pytest.raises(Exception):
+        gdal.OpenEx("data/byte.tif", gdal.OF_THREAD_SAFE | gdal.OF_VECTOR)
+
+    ds = gdal.OpenEx("data/byte.tif", gdal.OF_RASTER | gdal.OF_THREAD_SAFE)
+    assert ds.IsThreadSafe(gdal.OF_RASTER)
+    assert not gdal.Open("data/byte.tif").IsThreadSafe(gdal.OF_RASTER)
+    assert ds.GetDriver().ShortName == "GTiff"
+    assert ds.GetGeoTransform() == gdal.Open("data/byte.tif").GetGeoTransform()
+    assert ds.GetSpatialRef() is not None
+
+    band = ds.GetRasterBand(1)
+    with pytest.raises(Exception):
+        band.SetNoDataValue(0)
+
+    results = []
+
+    def worker():
+        ok = True
+        for i in range(100):
+            if band.Checksum() != 4672:
+                ok = False
+            if ds.GetMetadataItem("AREA_OR_POINT") != "Area":
+                ok = False
+        results.append(ok)
+
+    threads = [threading.Thread(target=worker) for i in range(4)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+
+    assert results == [True] * 4
+    ds.Close()
@@ -2315,6 +2315,49 @@ def test_tiff_ovr_multithreading_multiband():
     gdal.Unlink("/vsimem/test.tif")
 
 
+###############################################################################
+# Test that computing overview levels from the previous level kept in memory
+# gives the same result as reading it back
+
+
+@pytest.mark.parametrize("resampling", ["AVERAGE", "GAUSS", "LANCZOS"])
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_tiff_ovr_fused_levels(tmp_vsimem, resampling, num_threads):
+
+    src_ds = gdal.Translate(
+        "",
+        "data/stefan_full_rgba.tif",
+        options="-of MEM -outsize 600 400 -b 1 -b 2 -b 3",
+    )
+
+    def get_overview_checksums(fused_levels):
+        filename = str(tmp_vsimem / ("test_%s.tif" % fused_levels))
+        ds = gdal.GetDriverByName("GTiff").CreateCopy(
+            filename,
+            src_ds,
+            options=["COMPRESS=LZW", "TILED=YES", "BLOCKXSIZE=32", "BLOCKYSIZE=32"],
+        )
+        with gdaltest.config_options(
+            {
+                "GDAL_OVR_FUSED_LEVELS": fused_levels,
+                "GDAL_NUM_THREADS": num_threads,
+                "GDAL_OVR_CHUNK_MAX_SIZE": "1000",
+            }
+        ):
+            ds.BuildOverviews(resampling, [2, 4, 8, 16])
+        ds = None
+        ds = gdal.Open(filename)
+        ret = [
+            ds.GetRasterBand(i + 1).GetOverview(j).Checksum()
+            for i in range(3)
+            for j in range(4)
+        ]
+        ds = None
+        return ret
+
+    assert get_overview_checksums("YES") == get_overview_checksums("NO")
+
+
 ###############################################################################
 
 
@@ -2887,3 +2930,54 @@ def test_tiff_ovr_JXL_ALPHA_DISTANCE_OVERVIEW(tmp_vsimem):
     assert ds.GetRasterBand(4).Checksum() != cs4
     del ds
     gdal.Unlink(tmpfilename + ".ovr")
+
+
+###############################################################################
+# Test that building external overviews of all bands in a single pass gives
+# the same result as building them band after band, including when bands have
+# different nodata values, and when refreshing existing overview levels
+
+
+@pytest.mark.parametrize("resampling", ["NEAREST", "AVERAGE", "CUBIC", "MODE", "RMS"])
+@pytest.mark.parametrize("num_threads", [1, 4])
+def test_tiff_ovr_external_multiband_same_as_band_per_band(
+    tmp_path, resampling, num_threads
+):
+
+    src_filename = str(tmp_path / "src.tif")
+    gdal.Translate(src_filename, "data/rgbsmall.tif", width=251, height=190)
+    vrt_filename = str(tmp_path / "src.vrt")
+    ds = gdal.Translate(vrt_filename, src_filename, format="VRT")
+    for i, nodata in enumerate((0, 255, 128)):
+        ds.GetRasterBand(i + 1).SetNoDataValue(nodata)
+    ds = None
+
+    single_band_filenames = []
+    for i in range(3):
+        filename = str(tmp_path / ("band%d.vrt" % (i + 1)))
+        gdal.Translate(filename, vrt_filename, format="VRT", bandList=[i + 1])
+        single_band_filenames.append(filename)
+
+    def build_overviews(filename):
+        ds = gdal.Open(filename)
+        assert ds.BuildOverviews(resampling, [2, 4, 7]) == 0
+        ds = None
+        ds = gdal.Open(filename)
+        ret = [
+            [
+                ds.GetRasterBand(i + 1).GetOverview(j).Checksum()
+                for j in range(ds.GetRasterBand(i + 1).GetOverviewCount())
+            ]
+            for i in range(ds.RasterCount)
+        ]
+        ds = None
+        return ret
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", str(num_threads)):
+        expected = [build_overviews(filename)[0] for filename in single_band_filenames]
+        got = build_overviews(vrt_filename)
+        assert got == expected
+        assert len(got[0]) == 3
+
+        # Refresh existing levels
+        assert build_overviews(vrt_filename) == expected
@@ -1151,7 +1151,8 @@ def test_tiff_read_online_1():
 
 
 @pytest.mark.require_curl()
-def test_tiff_read_vsicurl_multirange():
+@pytest.mark.parametrize("max_host_connections", [None, "1"])
+def test_tiff_read_vsicurl_multirange(max_host_connections):
 
     webserver_process = None
     webserver_port = 0
@@ -1194,14 +1195,16 @@ def test_tiff_read_vsicurl_multirange():
         for i in range(6):
             handler.add("GET", "/utm.tif", custom_method=method)
 
+        options = {
+            "GTIFF_DIRECT_IO": "YES",
+            "CPL_VSIL_CURL_ALLOWED_EXTENSIONS": ".tif",
+            "GDAL_DISABLE_READDIR_ON_OPEN": "EMPTY_DIR",
+        }
+        if max_host_connections:
+            options["GDAL_HTTP_MAX_HOST_CONNECTIONS"] = max_host_connections
+            options["GDAL_HTTP_MAX_CONCURRENT_STREAMS"] = "1"
         with webserver.install_http_handler(handler):
-            with gdaltest.config_options(
-                {
-                    "GTIFF_DIRECT_IO": "YES",
-                    "CPL_VSIL_CURL_ALLOWED_EXTENSIONS": ".tif",
-                    "GDAL_DISABLE_READDIR_ON_OPEN": "EMPTY_DIR",
-                }
-            ):
+            with gdaltest.config_options(options):
                 ds = gdal.Open("/vsicurl/http://127.0.0.1:%d/utm.tif" % webserver_port)
                 assert ds is not None, "could not open dataset"
 
@@ -2119,6 +2122,57 @@ def test_tiff_direct_and_virtual_mem_io():
             pytest.fail("missing code coverage in VirtualMemIO()")
 
 
+###############################################################################
+# Test that blocks of uncompressed files are read from the memory mapping
+# when GTIFF_VIRTUAL_MEM_IO is enabled
+
+
+@pytest.mark.parametrize(
+    "creation_options",
+    [
+        [],
+        ["INTERLEAVE=BAND"],
+        ["TILED=YES", "BLOCKXSIZE=32", "BLOCKYSIZE=16"],
+        ["TILED=YES", "BLOCKXSIZE=32", "BLOCKYSIZE=16", "INTERLEAVE=BAND"],
+        ["ENDIANNESS=INVERTED"],
+        ["SPARSE_OK=YES"],
+    ],
+)
+@pytest.mark.parametrize("use_tmp_path", [False, True])
+def test_tiff_read_virtual_mem_io_blocks(
+    tmp_path, tmp_vsimem, creation_options, use_tmp_path
+):
+
+    src_ds = gdal.Translate(
+        "", "data/stefan_full_rgba.tif", format="MEM", outputType=gdal.GDT_UInt16
+    )
+    filename = str((tmp_path if use_tmp_path else tmp_vsimem) / "test.tif")
+    if "SPARSE_OK=YES" in creation_options:
+        ds = gdal.GetDriverByName("GTiff").Create(
+            filename, 162, 150, 4, gdal.GDT_UInt16, options=creation_options
+        )
+        ds.GetRasterBand(2).WriteRaster(
+            0, 0, 162, 16, src_ds.GetRasterBand(2).ReadRaster(0, 0, 162, 16)
+        )
+        ds = None
+    else:
+        gdal.GetDriverByName("GTiff").CreateCopy(
+            filename, src_ds, options=creation_options
+        )
+
+    ref_ds = gdal.Open(filename)
+    with gdaltest.config_option("GTIFF_VIRTUAL_MEM_IO", "YES"):
+        ds = gdal.Open(filename)
+    nblockxsize, nblockysize = ds.GetRasterBand(1).GetBlockSize()
+    for i in range(ds.RasterCount):
+        band = ds.GetRasterBand(i + 1)
+        ref_band = ref_ds.GetRasterBand(i + 1)
+        for y in range((ds.RasterYSize + nblockysize - 1) // nblockysize):
+            for x in range((ds.RasterXSize + nblockxsize - 1) // nblockxsize):
+                assert band.ReadBlock(x, y) == ref_band.ReadBlock(x, y)
+        assert band.Checksum() == ref_band.Checksum()
+
+
 ###############################################################################
 # Check read Digital Globe metadata IMD & RPB format
 
@@ -4448,6 +4502,125 @@ def test_tiff_read_cog_with_mask_vsicurl():
         gdal.GetDriverByName("GTIFF").Delete(cog_filename)
 
 
+###############################################################################
+# Check that reads over /vsicurl/ following AdviseRead() or a read plan (as
+# submitted by gdalwarp) return the same data as local reads, whatever the
+# memory budget of the plan and the order of the reads
+
+
+class _TiffReadRangeHandler:
+    def __init__(self, filename):
+        with open(filename, "rb") as f:
+            self.content = f.read()
+
+    def final_check(self):
+        pass
+
+    def do_HEAD(self, request):
+        request.send_response(200)
+        request.send_header("Content-Length", len(self.content))
+        request.end_headers()
+
+    def do_GET(self, request):
+        if "Range" not in request.headers:
+            request.send_response(200)
+            request.send_header("Content-Length", len(self.content))
+            request.end_headers()
+            request.wfile.write(self.content)
+            return
+        start, end = request.headers["Range"][len("bytes=") :].split("-")
+        start = int(start)
+        end = min(int(end), len(self.content) - 1)
+        request.protocol_version = "HTTP/1.1"
+        request.send_response(206)
+        request.send_header(
+            "Content-Range", "bytes %d-%d/%d" % (start, end, len(self.content))
+        )
+        request.send_header("Content-Length", end + 1 - start)
+        request.send_header("Connection", "close")
+        request.end_headers()
+        request.wfile.write(self.content[start : end + 1])
+
+
+@pytest.mark.require_curl()
+@pytest.mark.parametrize("max_bytes", ["1", "5000", None])
+@pytest.mark.parametrize("num_threads", ["1", "2"])
+def test_tiff_read_advise_read_plan_vsicurl(tmp_path, max_bytes, num_threads):
+
+    (webserver_process, webserver_port) = webserver.launch(
+        handler=webserver.DispatcherHttpHandler
+    )
+    if webserver_port == 0:
+        pytest.skip()
+
+    filename = str(tmp_path / "test.tif")
+    src_ds = gdal.Translate(
+        "",
+        "data/rgbsmall.tif",
+        format="MEM",
+        width=256,
+        height=256,
+        resampleAlg=gdal.GRIORA_NearestNeighbour,
+    )
+    gdal.GetDriverByName("GTiff").CreateCopy(
+        filename,
+        src_ds,
+        options=["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16", "COMPRESS=DEFLATE"],
+    )
+    local_ds = gdal.Open(filename)
+
+    handler = _TiffReadRangeHandler(filename)
+    options = {
+        "GDAL_ADVISE_READ_PLAN_MAX_BYTES": max_bytes,
+        "GDAL_NUM_THREADS": num_threads,
+        "GDAL_HTTP_MULTIRANGE": "SERIAL",
+    }
+
+    gdal.VSICurlClearCache()
+    try:
+        with webserver.install_http_handler(handler), gdaltest.config_options(
+            options, thread_local=False
+        ):
+            url = "/vsicurl/http://localhost:%d/test.tif" % webserver_port
+            ds = gdal.Open(url)
+            assert ds
+
+            # Whole raster advised, read in reverse order of the windows
+            assert ds.AdviseRead(0, 0, 256, 256) == gdal.CE_None
+            for yoff in range(192, -1, -64):
+                for xoff in range(192, -1, -64):
+                    assert ds.ReadRaster(xoff, yoff, 64, 64) == local_ds.ReadRaster(
+                        xoff, yoff, 64, 64
+                    ), (xoff, yoff)
+
+            # Subwindow advised, read in unaligned strips and single bands
+            assert ds.AdviseRead(37, 21, 150, 170) == gdal.CE_None
+            for yoff in range(21, 191, 57):
+                window = (37, yoff, 150, min(57, 191 - yoff))
+                assert ds.ReadRaster(*window) == local_ds.ReadRaster(*window)
+                assert ds.GetRasterBand(2).ReadRaster(
+                    *window
+                ) == local_ds.GetRasterBand(2).ReadRaster(*window)
+
+            # gdalwarp submits the source windows of its chunks as a read plan
+            gdal.VSICurlClearCache()
+            warp_options = {
+                "format": "MEM",
+                "dstSRS": "EPSG:3857",
+                "warpMemoryLimit": 20000,
+            }
+            got_ds = gdal.Warp("", url, **warp_options)
+            expected_ds = gdal.Warp("", filename, **warp_options)
+            assert [
+                got_ds.GetRasterBand(i + 1).Checksum() for i in range(3)
+            ] == [expected_ds.GetRasterBand(i + 1).Checksum() for i in range(3)]
+            ds = None
+    finally:
+        webserver.server_stop(webserver_process, webserver_port)
+
+        gdal.VSICurlClearCache()
+
+
 ###############################################################################
 # Check that GetMetadataDomainList() works properly
 
@@ -5101,3 +5274,131 @@ def test_tiff_read_webp_lossless_rgba_alpha_fully_opaque():
         4672,
         4873,
     ]
+
+
+###############################################################################
+# Test the process-wide header cache (GTIFF_HEADER_CACHE_SIZE)
+
+
+def test_tiff_read_header_cache(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test_tiff_read_header_cache.tif")
+    gdal.GetDriverByName("COG").CreateCopy(filename, gdal.Open("data/byte.tif"))
+
+    class my_error_handler(object):
+        def __init__(self):
+            self.debug_msg_list = []
+
+        def handler(self, eErrClass, err_no, msg):
+            if eErrClass == gdal.CE_Debug:
+                self.debug_msg_list.append(msg)
+
+    def open_and_checksum():
+        handler = my_error_handler()
+        try:
+            gdal.PushErrorHandler(handler.handler)
+            gdal.SetCurrentErrorHandlerCatchDebug(True)
+            with gdaltest.config_options(
+                {"CPL_DEBUG": "GTiff", "GTIFF_HEADER_CACHE_LOCAL": "YES"}
+            ):
+                ds = gdal.Open(filename)
+                cs = ds.GetRasterBand(1).Checksum()
+                ds = None
+        finally:
+            gdal.PopErrorHandler()
+        return (
+            "GTiff: Using cached header of " + filename in handler.debug_msg_list,
+            cs,
+        )
+
+    assert open_and_checksum() == (False, 4672)
+    assert open_and_checksum() == (True, 4672)
+
+    # Rewrite the file with a different size: the cache must not be used
+    gdal.GetDriverByName("COG").CreateCopy(
+        filename, gdal.Open("data/byte.tif"), options=["COMPRESS=DEFLATE"]
+    )
+    assert open_and_checksum() == (False, 4672)
+    assert open_and_checksum() == (True, 4672)
+
+    with gdaltest.config_option("GTIFF_HEADER_CACHE_SIZE", "0"):
+        assert open_and_checksum() == (False, 4672)
+
+
+###############################################################################
+# Test prefetching of blocks when reading them in a regular order
+
+
+@pytest.mark.parametrize("scan_order", ["row_major", "column_major", "local"])
+def test_tiff_read_prefetch_blocks(tmp_vsimem, scan_order):
+
+    filename = str(tmp_vsimem / "test_tiff_read_prefetch_blocks.tif")
+    src_ds = gdal.GetDriverByName("MEM").Create("", 128, 128)
+    src_ds.WriteRaster(
+        0, 0, 128, 128, bytes([(i * 37) % 251 for i in range(128 * 128)])
+    )
+    gdal.GetDriverByName("GTiff").CreateCopy(
+        filename,
+        src_ds,
+        options=["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16", "COMPRESS=DEFLATE"],
+    )
+
+    if scan_order == "row_major":
+        blocks = [(x, y) for y in range(8) for x in range(8)]
+    elif scan_order == "column_major":
+        blocks = [(x, y) for x in range(8) for y in range(8)]
+    else:
+        blocks = [(3, 3), (4, 3), (4, 4), (3, 4), (2, 4), (2, 3), (2, 2), (3, 2)]
+
+    class my_error_handler(object):
+        def __init__(self):
+            self.debug_msg_list = []
+
+        def handler(self, eErrClass, err_no, msg):
+            if eErrClass == gdal.CE_Debug:
+                self.debug_msg_list.append(msg)
+
+    handler = my_error_handler()
+    try:
+        gdal.PushErrorHandler(handler.handler)
+        gdal.SetCurrentErrorHandlerCatchDebug(True)
+        with gdaltest.config_options(
+            {"CPL_DEBUG": "GTiff", "GTIFF_HAS_OPTIMIZED_READ_MULTI_RANGE": "YES"}
+        ):
+            ds = gdal.Open(filename)
+            band = ds.GetRasterBand(1)
+            for x, y in blocks:
+                assert band.ReadBlock(x, y) == src_ds.GetRasterBand(1).ReadRaster(
+                    x * 16, y * 16, 16, 16
+                )
+            ds = None
+    finally:
+        gdal.PopErrorHandler()
+
+    msgs = [msg for msg in handler.debug_msg_list if "prefetch request(s)" in msg]
+    assert len(msgs) == 1
+    hits = int(msgs[0].split("block(s) prefetched, ")[1].split(" hit(s)")[0])
+    assert hits > 0
+
+    # Prefetching disabled
+    handler = my_error_handler()
+    try:
+        gdal.PushErrorHandler(handler.handler)
+        gdal.SetCurrentErrorHandlerCatchDebug(True)
+        with gdaltest.config_options(
+            {
+                "CPL_DEBUG": "GTiff",
+                "GTIFF_HAS_OPTIMIZED_READ_MULTI_RANGE": "YES",
+                "GTIFF_PREFETCH_BLOCKS": "0",
+            }
+        ):
+            ds = gdal.Open(filename)
+            band = ds.GetRasterBand(1)
+            for x, y in blocks:
+                assert band.ReadBlock(x, y) == src_ds.GetRasterBand(1).ReadRaster(
+                    x * 16, y * 16, 16, 16
+                )
+            ds = None
+    finally:
+        gdal.PopErrorHandler()
+    assert not [msg for msg in handler.debug_msg_list if "prefetch request(s)" in msg]
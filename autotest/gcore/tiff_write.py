@@ -9549,6 +9549,39 @@ def test_tiff_write_jpegxl_alpha_distance_zero():
     gdal.Unlink(filename)
 
 
+###############################################################################
+# Test JXL compression with NUM_THREADS, when there are fewer blocks than
+# threads, so that libjxl uses the remaining threads to encode each block
+
+
+@pytest.mark.parametrize("blocksize", [1024, 512])
+@pytest.mark.require_creation_option("GTiff", "JXL")
+def test_tiff_write_jpegxl_num_threads_few_blocks(tmp_vsimem, blocksize):
+
+    src_ds = gdal.Translate(
+        "", "data/rgbsmall.tif", format="MEM", width=1024, height=1024
+    )
+    filename = str(tmp_vsimem / "test.tif")
+    gdaltest.tiff_drv.CreateCopy(
+        filename,
+        src_ds,
+        options=[
+            "COMPRESS=JXL",
+            "JXL_LOSSLESS=YES",
+            "TILED=YES",
+            "BLOCKXSIZE=%d" % blocksize,
+            "BLOCKYSIZE=1024",
+            "NUM_THREADS=4",
+        ],
+    )
+    ds = gdal.Open(filename)
+    assert ds.GetRasterBand(1).GetBlockSize() == [blocksize, 1024]
+    assert [ds.GetRasterBand(i + 1).Checksum() for i in range(3)] == [
+        src_ds.GetRasterBand(i + 1).Checksum() for i in range(3)
+    ]
+    assert ds.ReadRaster() == src_ds.ReadRaster()
+
+
 ###############################################################################
 # Test creating overviews with NaN nodata
 
@@ -11423,3 +11456,351 @@ def test_tiff_write_copy_mdd():
     ds = None
 
     gdal.Unlink(filename)
+
+
+###############################################################################
+# Test copying raw strips/tiles when the source and target compression
+# parameters are compatible
+
+
+@pytest.mark.parametrize(
+    "src_options,dst_options,expect_raw_copy",
+    [
+        (
+            ["TILED=YES", "BLOCKXSIZE=32", "BLOCKYSIZE=32", "COMPRESS=DEFLATE"],
+            ["TILED=YES", "BLOCKXSIZE=32", "BLOCKYSIZE=32", "COMPRESS=DEFLATE"],
+            True,
+        ),
+        (
+            ["TILED=YES", "BLOCKXSIZE=32", "BLOCKYSIZE=32", "COMPRESS=DEFLATE"],
+            [
+                "TILED=YES",
+                "BLOCKXSIZE=32",
+                "BLOCKYSIZE=32",
+                "COMPRESS=DEFLATE",
+                "ZLEVEL=1",
+            ],
+            True,
+        ),
+        (
+            ["COMPRESS=LZW", "PREDICTOR=2", "BLOCKYSIZE=10", "INTERLEAVE=BAND"],
+            ["COMPRESS=LZW", "PREDICTOR=2", "BLOCKYSIZE=10", "INTERLEAVE=BAND"],
+            True,
+        ),
+        (
+            ["COMPRESS=LZW", "PREDICTOR=2"],
+            ["COMPRESS=LZW"],
+            False,
+        ),
+        (
+            ["TILED=YES", "BLOCKXSIZE=32", "BLOCKYSIZE=32", "COMPRESS=DEFLATE"],
+            ["TILED=YES", "BLOCKXSIZE=64", "BLOCKYSIZE=64", "COMPRESS=DEFLATE"],
+            False,
+        ),
+        (
+            ["TILED=YES", "BLOCKXSIZE=32", "BLOCKYSIZE=32", "COMPRESS=DEFLATE"],
+            ["TILED=YES", "BLOCKXSIZE=32", "BLOCKYSIZE=32", "COMPRESS=PACKBITS"],
+            False,
+        ),
+    ],
+)
+def test_tiff_write_copy_raw_blocks(
+    tmp_vsimem, src_options, dst_options, expect_raw_copy
+):
+
+    src_filename = str(tmp_vsimem / "src.tif")
+    mem_ds = gdal.GetDriverByName("MEM").Create("", 100, 50, 3)
+    for i in range(3):
+        mem_ds.GetRasterBand(i + 1).WriteRaster(
+            0, 0, 100, 50, bytes([(j * (i + 3)) % 251 for j in range(100 * 50)])
+        )
+    gdal.GetDriverByName("GTiff").CreateCopy(
+        src_filename, mem_ds, options=src_options
+    )
+    src_ds = gdal.Open(src_filename)
+
+    class my_error_handler(object):
+        def __init__(self):
+            self.debug_msg_list = []
+
+        def handler(self, eErrClass, err_no, msg):
+            if eErrClass == gdal.CE_Debug:
+                self.debug_msg_list.append(msg)
+
+    dst_filename = str(tmp_vsimem / "dst.tif")
+    handler = my_error_handler()
+    try:
+        gdal.PushErrorHandler(handler.handler)
+        gdal.SetCurrentErrorHandlerCatchDebug(True)
+        with gdaltest.config_option("CPL_DEBUG", "GTiff"):
+            gdal.GetDriverByName("GTiff").CreateCopy(
+                dst_filename, src_ds, options=dst_options
+            )
+    finally:
+        gdal.PopErrorHandler()
+
+    raw_copy = any(msg.startswith("Copying raw ") for msg in handler.debug_msg_list)
+    assert raw_copy == expect_raw_copy
+
+    dst_ds = gdal.Open(dst_filename)
+    for i in range(3):
+        assert (
+            dst_ds.GetRasterBand(i + 1).Checksum()
+            == mem_ds.GetRasterBand(i + 1).Checksum()
+        )
+    if expect_raw_copy:
+        assert dst_ds.GetRasterBand(1).GetMetadataItem(
+            "BLOCK_SIZE_0_0", "TIFF"
+        ) == src_ds.GetRasterBand(1).GetMetadataItem("BLOCK_SIZE_0_0", "TIFF")
+
+    # Check that it can be disabled
+    if expect_raw_copy:
+        handler = my_error_handler()
+        try:
+            gdal.PushErrorHandler(handler.handler)
+            gdal.SetCurrentErrorHandlerCatchDebug(True)
+            with gdaltest.config_options(
+                {"CPL_DEBUG": "GTiff", "GTIFF_COPY_RAW_BLOCKS": "NO"}
+            ):
+                gdal.GetDriverByName("GTiff").CreateCopy(
+                    dst_filename, src_ds, options=dst_options
+                )
+        finally:
+            gdal.PopErrorHandler()
+        assert not any(
+            msg.startswith("Copying raw ") for msg in handler.debug_msg_list
+        )
+
+
+###############################################################################
+# Test multi-threaded compression of strips and tiles, and the related
+# debug statistics
+
+
+@pytest.mark.parametrize(
+    "options",
+    [
+        ["COMPRESS=DEFLATE", "BLOCKYSIZE=7"],
+        ["COMPRESS=DEFLATE", "TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16"],
+        ["COMPRESS=CCITTFAX4", "NBITS=1", "BLOCKYSIZE=7"],
+        [
+            "COMPRESS=CCITTFAX3",
+            "NBITS=1",
+            "TILED=YES",
+            "BLOCKXSIZE=16",
+            "BLOCKYSIZE=16",
+        ],
+    ],
+)
+def test_tiff_write_multithreaded_compression_stats(tmp_vsimem, options):
+
+    nbits1 = "NBITS=1" in options
+    src_ds = gdal.GetDriverByName("MEM").Create("", 50, 50)
+    src_ds.WriteRaster(
+        0,
+        0,
+        50,
+        50,
+        bytes([(i // 3) % 2 if nbits1 else (i * 7) % 251 for i in range(50 * 50)]),
+    )
+
+    class my_error_handler(object):
+        def __init__(self):
+            self.debug_msg_list = []
+
+        def handler(self, eErrClass, err_no, msg):
+            if eErrClass == gdal.CE_Debug:
+                self.debug_msg_list.append(msg)
+
+    filename = str(tmp_vsimem / "test.tif")
+    handler = my_error_handler()
+    try:
+        gdal.PushErrorHandler(handler.handler)
+        gdal.SetCurrentErrorHandlerCatchDebug(True)
+        with gdaltest.config_option("CPL_DEBUG", "GTiff"):
+            gdal.GetDriverByName("GTiff").CreateCopy(
+                filename, src_ds, options=options + ["NUM_THREADS=4"]
+            )
+    finally:
+        gdal.PopErrorHandler()
+
+    msgs = [msg for msg in handler.debug_msg_list if "in worker threads" in msg]
+    assert len(msgs) == 1
+    nblocks = int(msgs[0].split(" compression of ")[1].split(" ")[0])
+    nblocks_threads = int(msgs[0].split(", ")[1].split(" ")[0])
+    assert nblocks > 1
+    assert nblocks_threads == nblocks
+
+    ds = gdal.Open(filename)
+    assert ds.GetRasterBand(1).Checksum() == src_ds.GetRasterBand(1).Checksum()
+
+
+###############################################################################
+# Test that statistics, histogram, overviews and warping of a sparse file,
+# whose missing tiles are not read, match the ones of a dense copy
+
+
+@pytest.mark.parametrize(
+    "datatype,nodata",
+    [
+        (gdal.GDT_Byte, None),
+        (gdal.GDT_Byte, 255),
+        (gdal.GDT_UInt16, None),
+        (gdal.GDT_Int16, -1),
+        (gdal.GDT_Float32, None),
+        (gdal.GDT_Float32, float("nan")),
+    ],
+)
+def test_tiff_write_sparse_stats_and_overviews(tmp_vsimem, datatype, nodata):
+
+    filename = str(tmp_vsimem / "test.tif")
+    ds = gdal.GetDriverByName("GTiff").Create(
+        filename,
+        100,
+        100,
+        1,
+        datatype,
+        options=["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16", "SPARSE_OK=YES"],
+    )
+    ds.SetGeoTransform([0, 1, 0, 100, 0, -1])
+    if nodata is not None:
+        ds.GetRasterBand(1).SetNoDataValue(nodata)
+    ds.GetRasterBand(1).WriteRaster(
+        40, 40, 20, 10, bytes([1 + (i % 200) for i in range(200)])
+    )
+    ds = None
+
+    ds = gdal.Open(filename)
+    band = ds.GetRasterBand(1)
+    assert band.GetDataCoverageStatus(0, 0, 16, 16) == (
+        gdal.GDAL_DATA_COVERAGE_STATUS_EMPTY,
+        0.0,
+    )
+    ref_ds = gdal.Translate("", ds, format="MEM")
+    ref_band = ref_ds.GetRasterBand(1)
+
+    assert band.ComputeRasterMinMax(False) == ref_band.ComputeRasterMinMax(False)
+    assert band.GetHistogram(
+        -0.5, 255.5, 256, include_out_of_range=1, approx_ok=0
+    ) == ref_band.GetHistogram(-0.5, 255.5, 256, include_out_of_range=1, approx_ok=0)
+    assert band.ComputeStatistics(False) == pytest.approx(
+        ref_band.ComputeStatistics(False), rel=1e-10
+    )
+    assert band.GetMetadataItem("STATISTICS_VALID_PERCENT") == ref_band.GetMetadataItem(
+        "STATISTICS_VALID_PERCENT"
+    )
+    band = None
+    ref_band = None
+
+    ds.BuildOverviews("AVERAGE", [2, 4])
+    ref_ds.BuildOverviews("AVERAGE", [2, 4])
+    for i in range(2):
+        assert (
+            ds.GetRasterBand(1).GetOverview(i).Checksum()
+            == ref_ds.GetRasterBand(1).GetOverview(i).Checksum()
+        )
+
+    warp_options = {
+        "format": "MEM",
+        "outputBounds": [-10, -10, 110, 110],
+        "xRes": 1,
+        "yRes": 1,
+        "warpOptions": ["SKIP_NOSOURCE=YES"],
+    }
+    assert (
+        gdal.Warp("", ds, **warp_options).GetRasterBand(1).Checksum()
+        == gdal.Warp("", ref_ds, **warp_options).GetRasterBand(1).Checksum()
+    )
+
+
+###############################################################################
+# Test round-tripping of the horizontal and floating-point predictors, with
+# rows large enough to use the vectorized code paths
+
+
+@pytest.mark.parametrize(
+    "datatype,predictor",
+    [
+        (gdal.GDT_Byte, 2),
+        (gdal.GDT_UInt16, 2),
+        (gdal.GDT_UInt32, 2),
+        (gdal.GDT_UInt64, 2),
+        (gdal.GDT_Float32, 2),
+        (gdal.GDT_Float32, 3),
+        (gdal.GDT_Float64, 3),
+    ],
+)
+@pytest.mark.parametrize("nbands", [1, 2, 3, 4, 5])
+def test_tiff_write_predictor_vectorized(tmp_vsimem, datatype, predictor, nbands):
+
+    filename = str(tmp_vsimem / "test.tif")
+    width = 71
+    height = 3
+    dt_size = gdal.GetDataTypeSize(datatype) // 8
+    src_ds = gdal.GetDriverByName("MEM").Create("", width, height, nbands, datatype)
+    for i in range(nbands):
+        data = bytes(
+            [
+                (j * 37 + i * 11 + (j // 7) ** 2) % 256
+                for j in range(width * height * dt_size)
+            ]
+        )
+        src_ds.GetRasterBand(i + 1).WriteRaster(0, 0, width, height, data)
+    for endianness in ["NATIVE", "INVERTED"]:
+        if predictor == 3 and endianness == "INVERTED":
+            continue
+        gdal.GetDriverByName("GTiff").CreateCopy(
+            filename,
+            src_ds,
+            options=[
+                "COMPRESS=DEFLATE",
+                "PREDICTOR=%d" % predictor,
+                "ENDIANNESS=" + endianness,
+            ],
+        )
+        ds = gdal.Open(filename)
+        for i in range(nbands):
+            assert (
+                ds.GetRasterBand(i + 1).ReadRaster()
+                == src_ds.GetRasterBand(i + 1).ReadRaster()
+            )
+        ds = None
+
+
+###############################################################################
+# Test implicit JPEG-in-TIFF overviews of internal overview levels
+
+
+@pytest.mark.require_creation_option("GTiff", "JPEG")
+@pytest.mark.require_driver("JPEG")
+def test_tiff_write_implicit_jpeg_overviews_of_overview(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test.tif")
+    src_ds = gdal.Open("../gdrivers/data/small_world_400pct_1band.vrt")
+    ds = gdaltest.tiff_drv.CreateCopy(
+        filename, src_ds, options=["COMPRESS=JPEG", "TILED=YES"]
+    )
+    ds.BuildOverviews("NEAREST", [2])
+    ds = None
+
+    ds = gdal.Open(filename)
+    ovr_band = ds.GetRasterBand(1).GetOverview(0)
+    assert ovr_band.XSize == 800
+    # Implicit overviews are not officially advertised...
+    assert ovr_band.GetOverviewCount() == 0
+    # ... but they exist
+    assert ovr_band.GetOverview(0).XSize == 400
+    assert ovr_band.GetOverview(1).XSize == 200
+    assert ovr_band.GetOverview(3) is None
+
+    # A request at 1/8 of the full resolution is served by the 1/4 implicit
+    # JPEG overview of the 1/2 explicit overview
+    implicit_ovr_data = ovr_band.GetOverview(1).ReadRaster()
+    assert ds.ReadRaster(0, 0, 1600, 800, 200, 100) == implicit_ovr_data
+    data = ds.GetRasterBand(1).ReadRaster(0, 0, 1600, 800, 200, 100)
+    assert data == implicit_ovr_data
+
+    with gdaltest.config_option("GTIFF_IMPLICIT_JPEG_OVR", "NO"):
+        ds = gdal.Open(filename)
+        assert ds.GetRasterBand(1).GetOverview(0).GetOverview(0) is None
+    ds = None
@@ -2586,3 +2586,142 @@ def test_vrt_read_compute_statistics_approximate(tmp_vsimem):
     assert "STATISTICS_MEAN" in md
     assert "STATISTICS_STDDEV" in md
     assert md["STATISTICS_VALID_PERCENT"] == "100"
+
+
+###############################################################################
+# Test multi-threaded reading of the sources in IRasterIO()
+
+
+def test_vrt_read_multithreaded_sources(tmp_vsimem):
+
+    tile_filenames = []
+    for i, (xoff, yoff) in enumerate(
+        [(0, 0), (10, 0), (20, 0), (0, 10), (10, 10), (20, 10), (5, 5)]
+    ):
+        tile_filename = str(tmp_vsimem / f"tile{i}.tif")
+        ds = gdal.GetDriverByName("GTiff").Create(tile_filename, 10, 10)
+        ds.SetGeoTransform([xoff, 1, 0, -yoff, 0, -1])
+        ds.GetRasterBand(1).Fill(i + 1)
+        ds = None
+        tile_filenames.append(tile_filename)
+    # The same file used twice must not be read concurrently
+    tile_filenames.append(tile_filenames[2])
+
+    # srcNodata to get ComplexSource
+    vrt_ds = gdal.BuildVRT("", tile_filenames, srcNodata=255)
+    expected = vrt_ds.ReadRaster()
+    expected_subsampled = vrt_ds.ReadRaster(buf_xsize=15, buf_ysize=10)
+    # Painter's order is respected for the overlapping tiles
+    assert vrt_ds.GetRasterBand(1).ReadRaster(7, 7, 1, 1) == b"\x07"
+    vrt_ds = None
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        vrt_ds = gdal.BuildVRT("", tile_filenames, srcNodata=255)
+        assert vrt_ds.ReadRaster() == expected
+        assert vrt_ds.ReadRaster(buf_xsize=15, buf_ysize=10) == expected_subsampled
+
+
+###############################################################################
+# Test the spatial index of sources used when there are many of them
+
+
+def test_vrt_read_many_sources_index(tmp_vsimem):
+
+    tiles = []
+    for j in range(10):
+        for i in range(10):
+            tile_filename = str(tmp_vsimem / f"tile_{i}_{j}.tif")
+            ds = gdal.GetDriverByName("GTiff").Create(tile_filename, 2, 2)
+            ds.SetGeoTransform([2 * i, 1, 0, -2 * j, 0, -1])
+            ds.GetRasterBand(1).Fill(10 * j + i)
+            ds = None
+            tiles.append(tile_filename)
+    vrt_ds = gdal.BuildVRT("", tiles)
+    band = vrt_ds.GetRasterBand(1)
+    assert band.ReadRaster(0, 0, 1, 1) == b"\x00"
+    assert band.ReadRaster(19, 19, 1, 1) == bytes([99])
+    assert band.ReadRaster(5, 7, 2, 1) == bytes([32, 33])
+    assert struct.unpack("B" * 100, band.ReadRaster(0, 0, 20, 20, 10, 10)) == tuple(
+        range(100)
+    )
+
+    # Replace the source of the last tile with one of the first one: the index
+    # must be refreshed.
+    xml = band.GetMetadataItem("source_0", "vrt_sources")
+    xml = xml.replace('<DstRect xOff="0" yOff="0"', '<DstRect xOff="18" yOff="18"')
+    band.SetMetadataItem("source_99", xml, "vrt_sources")
+    assert band.ReadRaster(19, 19, 1, 1) == b"\x00"
+
+
+###############################################################################
+# Test VRT_LAZY_SOURCES=YES
+
+
+def test_vrt_read_lazy_sources(tmp_vsimem):
+
+    tiles = []
+    for j in range(10):
+        for i in range(10):
+            tile_filename = str(tmp_vsimem / f"tile_{i}_{j}.tif")
+            ds = gdal.GetDriverByName("GTiff").Create(tile_filename, 2, 2)
+            ds.SetGeoTransform([2 * i, 1, 0, -2 * j, 0, -1])
+            ds.GetRasterBand(1).Fill(10 * j + i)
+            ds = None
+            tiles.append(tile_filename)
+    vrt_filename = str(tmp_vsimem / "test.vrt")
+    gdal.BuildVRT(vrt_filename, tiles).Close()
+
+    # Make the definition of the last source invalid: this is only noticed
+    # when it is read.
+    f = gdal.VSIFOpenL(vrt_filename, "rb")
+    content = gdal.VSIFReadL(1, 1000000, f).decode("utf-8")
+    gdal.VSIFCloseL(f)
+    pos = content.rfind("<SimpleSource>")
+    content = content[:pos] + content[pos:].replace(
+        "<SourceBand>1</SourceBand>", "<SourceBand>0</SourceBand>"
+    )
+    gdal.FileFromMemBuffer(vrt_filename, content)
+
+    with gdal.quiet_errors():
+        assert gdal.Open(vrt_filename) is None
+
+    with gdal.config_option("VRT_LAZY_SOURCES", "YES"):
+        ds = gdal.Open(vrt_filename)
+    band = ds.GetRasterBand(1)
+    assert band.ReadRaster(0, 0, 1, 1) == b"\x00"
+    assert band.ReadRaster(5, 7, 2, 1) == bytes([32, 33])
+    assert struct.unpack("B" * 81, band.ReadRaster(0, 0, 18, 18, 9, 9)) == tuple(
+        10 * j + i for j in range(9) for i in range(9)
+    )
+    with pytest.raises(Exception):
+        band.ReadRaster(19, 19, 1, 1)
+
+
+###############################################################################
+# Test that repeated reads of non-shared sources through the proxy pool,
+# which re-use the pooled datasets, return consistent results
+
+
+def test_vrt_read_proxy_pool_reuse(tmp_vsimem):
+
+    tiles = []
+    for j in range(4):
+        for i in range(4):
+            tile_filename = str(tmp_vsimem / f"tile_{i}_{j}.tif")
+            ds = gdal.GetDriverByName("GTiff").Create(tile_filename, 2, 2)
+            ds.SetGeoTransform([2 * i, 1, 0, -2 * j, 0, -1])
+            ds.GetRasterBand(1).SetNoDataValue(255)
+            ds.GetRasterBand(1).Fill(10 * j + i)
+            ds = None
+            tiles.append(tile_filename)
+    vrt_filename = str(tmp_vsimem / "test.vrt")
+    gdal.BuildVRT(vrt_filename, tiles).Close()
+
+    with gdal.config_option("VRT_SHARED_SOURCE", "0"):
+        ds = gdal.Open(vrt_filename)
+        band = ds.GetRasterBand(1)
+        expected = tuple(10 * (j // 2) + (i // 2) for j in range(8) for i in range(8))
+        for _ in range(3):
+            assert struct.unpack("B" * 64, band.ReadRaster()) == expected
+            assert band.GetNoDataValue() == 255
+        ds = None
@@ -28,6 +28,7 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import json
 import sys
 import time
 
@@ -1127,3 +1128,218 @@ def test_vsicurl_404_repeated_same_resource(server):
 
     with pytest.raises(Exception, match="404"):
         gdal.Open("/vsicurl/http://localhost:%d/does/not/exist.bin" % server.port)
+
+
+###############################################################################
+# Test CPL_VSIL_CURL_DISK_CACHE_DIR
+
+
+def test_vsicurl_disk_cache(server, tmp_path):
+
+    gdal.VSICurlClearCache()
+
+    url = "/vsicurl/http://localhost:%d/test_vsicurl_disk_cache.bin" % server.port
+    cache_dir = str(tmp_path / "cache")
+
+    def read_file():
+        f = gdal.VSIFOpenL(url, "rb")
+        assert f
+        data = gdal.VSIFReadL(1, 3, f)
+        gdal.VSIFCloseL(f)
+        return data
+
+    with gdal.config_options(
+        {
+            "CPL_VSIL_CURL_DISK_CACHE_DIR": cache_dir,
+            "GDAL_DISABLE_READDIR_ON_OPEN": "EMPTY_DIR",
+        }
+    ):
+        handler = webserver.SequentialHandler()
+        handler.add(
+            "HEAD",
+            "/test_vsicurl_disk_cache.bin",
+            200,
+            {"Content-Length": "3", "ETag": '"etag1"'},
+        )
+        handler.add("GET", "/test_vsicurl_disk_cache.bin", 200, {}, "foo")
+        with webserver.install_http_handler(handler):
+            assert read_file() == b"foo"
+
+        assert len(
+            [x for x in gdal.ReadDirRecursive(cache_dir) if not x.endswith("/")]
+        ) == 1
+
+        # Simulate another process: the region is read from the disk cache
+        gdal.VSICurlClearCache()
+        handler = webserver.SequentialHandler()
+        handler.add(
+            "HEAD",
+            "/test_vsicurl_disk_cache.bin",
+            200,
+            {"Content-Length": "3", "ETag": '"etag1"'},
+        )
+        with webserver.install_http_handler(handler):
+            assert read_file() == b"foo"
+
+        # The remote file has changed: the region must be downloaded again
+        gdal.VSICurlClearCache()
+        handler = webserver.SequentialHandler()
+        handler.add(
+            "HEAD",
+            "/test_vsicurl_disk_cache.bin",
+            200,
+            {"Content-Length": "3", "ETag": '"etag2"'},
+        )
+        handler.add("GET", "/test_vsicurl_disk_cache.bin", 200, {}, "bar")
+        with webserver.install_http_handler(handler):
+            assert read_file() == b"bar"
+
+    gdal.VSICurlClearCache()
+
+    # Test eviction
+    with gdal.config_options(
+        {
+            "CPL_VSIL_CURL_DISK_CACHE_DIR": cache_dir,
+            "CPL_VSIL_CURL_DISK_CACHE_SIZE": "150",
+            "GDAL_DISABLE_READDIR_ON_OPEN": "EMPTY_DIR",
+        }
+    ):
+        for i in range(10):
+            handler = webserver.SequentialHandler()
+            handler.add(
+                "HEAD",
+                "/test_vsicurl_disk_cache.bin",
+                200,
+                {"Content-Length": "3", "ETag": '"etag_%d"' % (i + 3)},
+            )
+            handler.add("GET", "/test_vsicurl_disk_cache.bin", 200, {}, "baz")
+            with webserver.install_http_handler(handler):
+                assert read_file() == b"baz"
+            gdal.VSICurlClearCache()
+
+    total_size = 0
+    for x in gdal.ReadDirRecursive(cache_dir):
+        if not x.endswith("/"):
+            total_size += gdal.VSIStatL(cache_dir + "/" + x).size
+    assert total_size <= 150
+
+
+###############################################################################
+# Test CPL_VSIL_CURL_SEQUENTIAL_READ_PARALLEL_REQUESTS
+
+
+@pytest.mark.parametrize("parallel_requests", [None, "2"])
+def test_vsicurl_sequential_read_parallel_requests(server, parallel_requests):
+
+    gdal.VSICurlClearCache()
+
+    chunk_size = 16384
+    content = bytes([i % 251 for i in range(8 * chunk_size)])
+    ranges = []
+
+    def method(request):
+        rng = request.headers["Range"][len("bytes=") :]
+        start, end = [int(x) for x in rng.split("-")]
+        ranges.append((start, end))
+        request.protocol_version = "HTTP/1.1"
+        request.send_response(206)
+        request.send_header("Content-Length", end - start + 1)
+        request.send_header(
+            "Content-Range", "bytes %d-%d/%d" % (start, end, len(content))
+        )
+        request.end_headers()
+        request.wfile.write(content[start : end + 1])
+
+    if parallel_requests:
+        expected_ranges = [
+            (0, chunk_size - 1),
+            (chunk_size, 3 * chunk_size - 1),
+            (3 * chunk_size, 5 * chunk_size - 1),
+            (5 * chunk_size, 7 * chunk_size - 1),
+            (7 * chunk_size, 8 * chunk_size - 1),
+        ]
+    else:
+        expected_ranges = [
+            (0, chunk_size - 1),
+            (chunk_size, 3 * chunk_size - 1),
+            (3 * chunk_size, 7 * chunk_size - 1),
+            (7 * chunk_size, 8 * chunk_size - 1),
+        ]
+
+    handler = webserver.SequentialHandler()
+    handler.add(
+        "HEAD",
+        "/test_vsicurl_sequential_read_parallel_requests.bin",
+        200,
+        {"Content-Length": "%d" % len(content)},
+    )
+    for i in range(len(expected_ranges)):
+        handler.add(
+            "GET",
+            "/test_vsicurl_sequential_read_parallel_requests.bin",
+            custom_method=method,
+        )
+
+    with gdal.config_options(
+        {
+            "CPL_VSIL_CURL_SEQUENTIAL_READ_PARALLEL_REQUESTS": parallel_requests,
+            "GDAL_DISABLE_READDIR_ON_OPEN": "EMPTY_DIR",
+        }
+    ), webserver.install_http_handler(handler):
+        f = gdal.VSIFOpenL(
+            "/vsicurl/http://localhost:%d/test_vsicurl_sequential_read_parallel_requests.bin"
+            % server.port,
+            "rb",
+        )
+        assert f
+        data = b""
+        for i in range(8):
+            data += gdal.VSIFReadL(1, chunk_size, f)
+        gdal.VSIFCloseL(f)
+
+    assert data == content
+    assert sorted(ranges) == expected_ranges
+
+
+###############################################################################
+# Test CPL_VSIL_CURL_METADATA_CACHE_TTL
+
+
+def test_vsicurl_metadata_cache_ttl(server):
+
+    gdal.VSICurlClearCache()
+
+    filename = "/vsicurl/http://localhost:%d/test_vsicurl_metadata_cache_ttl.bin" % (
+        server.port
+    )
+
+    handler = webserver.SequentialHandler()
+    handler.add(
+        "HEAD", "/test_vsicurl_metadata_cache_ttl.bin", 200, {"Content-Length": "3"}
+    )
+    handler.add(
+        "HEAD", "/test_vsicurl_metadata_cache_ttl.bin", 200, {"Content-Length": "4"}
+    )
+
+    gdal.NetworkStatsReset()
+    with gdal.config_options(
+        {
+            "CPL_VSIL_CURL_METADATA_CACHE_TTL": "1",
+            "CPL_VSIL_NETWORK_STATS_ENABLED": "YES",
+            "GDAL_DISABLE_READDIR_ON_OPEN": "EMPTY_DIR",
+        },
+        thread_local=False,
+    ), webserver.install_http_handler(handler):
+        assert gdal.VSIStatL(filename).size == 3
+        # Served from the cache
+        assert gdal.VSIStatL(filename).size == 3
+
+        j = json.loads(gdal.NetworkStatsGetAsSerializedJSON())
+        assert j["metadata_cache"]["file_prop_hits"] >= 1
+
+        # The cached entry has expired
+        time.sleep(1.1)
+        assert gdal.VSIStatL(filename).size == 4
+
+    gdal.NetworkStatsReset()
+    gdal.VSICurlClearCache()
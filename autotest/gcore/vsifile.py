@@ -30,6 +30,7 @@
 ###############################################################################
 
 import os
+import shutil
 import sys
 import time
 
@@ -837,6 +838,66 @@ def test_vsigzip_multi_thread():
         pytest.fail()
 
 
+###############################################################################
+# Test random access into a .gz file, with access points shared between
+# openings and persisted in a .gz.gzidx file
+
+
+def test_vsigzip_random_access(tmp_path):
+
+    import gzip
+    import random
+
+    rng = random.Random(0)
+    data = bytes(
+        rng.randrange(256) if rng.randrange(4) == 0 else ord("a") + i % 10
+        for i in range(2 * 1024 * 1024)
+    )
+    filename = str(tmp_path / "test.gz")
+    # Concatenation of two gzip members
+    with open(filename, "wb") as f:
+        f.write(gzip.compress(data[0 : len(data) // 2]))
+        f.write(gzip.compress(data[len(data) // 2 :]))
+
+    def check(filename):
+        f = gdal.VSIFOpenL("/vsigzip/" + filename, "rb")
+        assert f
+        try:
+            for i in range(50):
+                offset = rng.randrange(len(data))
+                size = rng.randrange(100000)
+                assert gdal.VSIFSeekL(f, offset, 0) == 0
+                assert (
+                    gdal.VSIFReadL(1, size, f) == data[offset : offset + size]
+                ), offset
+        finally:
+            gdal.VSIFCloseL(f)
+
+    with gdaltest.config_options(
+        {
+            "CPL_VSIL_GZIP_INDEX_INTERVAL": "64K",
+            "CPL_VSIL_GZIP_INDEX_SIDECAR": "YES",
+            "CPL_VSIL_GZIP_WRITE_PROPERTIES": "NO",
+        }
+    ):
+        check(filename)
+        check(filename)
+        assert gdal.VSIStatL(filename + ".gzidx") is not None
+
+        # Access points loaded from the .gz.gzidx file
+        filename2 = str(tmp_path / "test2.gz")
+        shutil.copy(filename, filename2)
+        shutil.copy(filename + ".gzidx", filename2 + ".gzidx")
+        check(filename2)
+
+        # Corrupted .gz.gzidx files are ignored
+        filename3 = str(tmp_path / "test3.gz")
+        shutil.copy(filename, filename3)
+        with open(filename3 + ".gzidx", "wb") as f:
+            f.write(b"GDAL_GZIP_INDEX_V1 but corrupted")
+        check(filename3)
+
+
 ###############################################################################
 # Test vsisync()
 
@@ -1290,3 +1351,30 @@ def test_vsifile_win32_network_path():
     drive_letter = os.getcwd()[0]
     dirname = f"\\\\localhost\\{drive_letter}$"
     assert gdal.VSIStatL(dirname) is not None
+
+
+###############################################################################
+# Test reading a GeoTIFF file with CPL_VSIL_UNIX_USE_IO_URING, which makes
+# local files advertise optimized multi-range reads
+
+
+@pytest.mark.skipif(sys.platform != "linux", reason="Linux specific test")
+def test_vsifile_unix_io_uring(tmp_path):
+
+    filename = str(tmp_path / "test.tif")
+    src_ds = gdal.Translate("", "data/byte.tif", format="MEM", width=200, height=200)
+    gdal.Translate(
+        filename,
+        src_ds,
+        creationOptions=["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16"],
+    )
+    expected_data = src_ds.GetRasterBand(1).ReadRaster()
+
+    with gdal.config_option("CPL_VSIL_UNIX_USE_IO_URING", "YES"):
+        ds = gdal.Open(filename)
+        band = ds.GetRasterBand(1)
+        assert band.ReadRaster() == expected_data
+        assert band.ReadRaster(3, 5, 150, 170) == src_ds.GetRasterBand(1).ReadRaster(
+            3, 5, 150, 170
+        )
+        ds = None
@@ -2057,6 +2057,19 @@ def test_vsis3_4(aws_test_config, webserver_port):
         assert gdal.GetLastErrorMsg() == ""
 
     j = json.loads(gdal.NetworkStatsGetAsSerializedJSON())
+
+    # Whether the connection is new or reused depends on previous requests
+    def pop_connections(obj):
+        if isinstance(obj, dict):
+            connections = obj.pop("connections", None)
+            if connections is not None:
+                assert connections["new_count"] + connections["reused_count"] == 1
+            for v in obj.values():
+                pop_connections(v)
+        return obj
+
+    assert "connections" in j
+    pop_connections(j)
     assert j == {
         "methods": {"PUT": {"count": 1, "uploaded_bytes": 6}},
         "handlers": {
@@ -2983,6 +2996,97 @@ def test_vsis3_write_multipart_retry(aws_test_config, webserver_port):
                 gdal.VSIFCloseL(f)
 
 
+###############################################################################
+# Test multipart upload with parts uploaded in parallel
+
+
+def test_vsis3_write_multipart_parallel_parts(aws_test_config, webserver_port):
+
+    gdal.VSICurlClearCache()
+
+    with gdaltest.config_options(
+        {"VSIS3_CHUNK_SIZE_BYTES": "3", "CPL_VSIL_CURL_UPLOAD_PARALLEL_PARTS": "2"}
+    ):
+        f = gdal.VSIFOpenL("/vsis3/s3_fake_bucket4/parallel_parts.bin", "wb")
+    assert f
+
+    handler = webserver.SequentialHandler()
+    handler.add(
+        "POST",
+        "/s3_fake_bucket4/parallel_parts.bin?uploads",
+        200,
+        {},
+        """<?xml version="1.0" encoding="UTF-8"?>
+        <InitiateMultipartUploadResult>
+        <UploadId>my_id</UploadId>
+        </InitiateMultipartUploadResult>""",
+    )
+    for part_number, content in enumerate([b"foo", b"bar", b"baz", b"!"]):
+        handler.add_unordered(
+            "PUT",
+            "/s3_fake_bucket4/parallel_parts.bin?partNumber=%d&uploadId=my_id"
+            % (part_number + 1),
+            200,
+            {"ETag": '"etag%d"' % (part_number + 1)},
+            expected_body=content,
+        )
+    handler.add_unordered(
+        "POST",
+        "/s3_fake_bucket4/parallel_parts.bin?uploadId=my_id",
+        200,
+        expected_body=b"""<CompleteMultipartUpload>
+<Part>
+<PartNumber>1</PartNumber><ETag>"etag1"</ETag></Part>
+<Part>
+<PartNumber>2</PartNumber><ETag>"etag2"</ETag></Part>
+<Part>
+<PartNumber>3</PartNumber><ETag>"etag3"</ETag></Part>
+<Part>
+<PartNumber>4</PartNumber><ETag>"etag4"</ETag></Part>
+</CompleteMultipartUpload>
+""",
+    )
+
+    gdal.ErrorReset()
+    with webserver.install_http_handler(handler):
+        assert gdal.VSIFWriteL("foobarbaz!", 1, 10, f) == 10
+        assert gdal.VSIFCloseL(f) == 0
+    assert gdal.GetLastErrorMsg() == ""
+
+    # Failure of a part uploaded in background is reported at closing
+    with gdaltest.config_options(
+        {"VSIS3_CHUNK_SIZE_BYTES": "3", "CPL_VSIL_CURL_UPLOAD_PARALLEL_PARTS": "2"}
+    ):
+        f = gdal.VSIFOpenL("/vsis3/s3_fake_bucket4/parallel_parts.bin", "wb")
+    assert f
+
+    handler = webserver.SequentialHandler()
+    handler.add(
+        "POST",
+        "/s3_fake_bucket4/parallel_parts.bin?uploads",
+        200,
+        {},
+        """<?xml version="1.0" encoding="UTF-8"?>
+        <InitiateMultipartUploadResult>
+        <UploadId>my_id</UploadId>
+        </InitiateMultipartUploadResult>""",
+    )
+    handler.add_unordered(
+        "PUT",
+        "/s3_fake_bucket4/parallel_parts.bin?partNumber=1&uploadId=my_id",
+        403,
+    )
+    handler.add_unordered(
+        "DELETE", "/s3_fake_bucket4/parallel_parts.bin?uploadId=my_id", 204
+    )
+
+    with webserver.install_http_handler(handler):
+        assert gdal.VSIFWriteL("foo", 1, 3, f) == 3
+        with gdal.quiet_errors():
+            assert gdal.VSIFCloseL(f) != 0
+        assert "UploadPart(1)" in gdal.GetLastErrorMsg()
+
+
 ###############################################################################
 # Test abort pending multipart uploads
 
@@ -938,6 +938,47 @@ def test_vsizip_byte_sozip():
         gdal.Unlink(zipfilename)
 
 
+###############################################################################
+# Test multi-threaded decompression of a SOZip-enabled file
+
+
+def test_vsizip_sozip_multi_thread():
+
+    srcfilename = "/vsimem/test_vsizip_sozip_multi_thread.bin"
+    zipfilename = "/vsimem/test_vsizip_sozip_multi_thread.zip"
+    dstfilename = f"/vsizip/{zipfilename}/test.bin"
+    data = b"".join(b"%d " % i for i in range(200000))
+    try:
+        gdal.FileFromMemBuffer(srcfilename, data)
+        options = ["SOZIP_ENABLED=YES", "SOZIP_CHUNK_SIZE=1000"]
+        assert gdal.CopyFile(srcfilename, dstfilename, options=options) == 0
+        assert gdal.GetFileMetadata(dstfilename, "ZIP")["SOZIP_VALID"] == "YES"
+
+        with gdal.config_option("GDAL_NUM_THREADS", "4"):
+            f = gdal.VSIFOpenL(dstfilename, "rb")
+            assert f
+            try:
+                # Sequential reading
+                got = b""
+                while True:
+                    chunk = gdal.VSIFReadL(1, 777, f)
+                    if not chunk:
+                        break
+                    got += chunk
+                assert got == data
+
+                # Random access
+                for offset, size in [(123456, 5000), (17, 1), (len(data) - 10, 100)]:
+                    assert gdal.VSIFSeekL(f, offset, 0) == 0
+                    assert gdal.VSIFReadL(1, size, f) == data[offset : offset + size]
+            finally:
+                gdal.VSIFCloseL(f)
+
+    finally:
+        gdal.Unlink(srcfilename)
+        gdal.Unlink(zipfilename)
+
+
 ###############################################################################
 
 
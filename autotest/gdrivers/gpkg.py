@@ -4279,3 +4279,142 @@ def test_gpkg_gti_gpkg_ext(tmp_vsimem):
     ds = gdal.Open(filename)
     assert ds.GetDriver().ShortName == "GPKG"
     assert ds.GetRasterBand(1).Checksum() == 4672
+
+
+###############################################################################
+# Test encoding tiles in worker threads with GDAL_NUM_THREADS
+
+
+def _gpkg_write_tiles(filename, num_threads):
+
+    tile_count = 8
+    with gdaltest.config_option("GDAL_NUM_THREADS", str(num_threads)):
+        # Small block cache so that tiles get flushed, and thus submitted
+        # for encoding, while other tiles are being written
+        with gdaltest.SetCacheMax(512 * 1024):
+            ds = gdal.GetDriverByName("GPKG").Create(
+                filename,
+                256 * tile_count,
+                256,
+                4,
+                options=["TILE_FORMAT=PNG", "RASTER_TABLE=tiles"],
+            )
+            ds.SetGeoTransform([0, 1, 0, 0, 0, -1])
+            tiles = []
+            for i in range(tile_count):
+                rgb = bytes((x + 16 * i) % 256 for x in range(256)) * 256 * 3
+                tiles.append(rgb + b"\xff" * (256 * 256))
+                ds.WriteRaster(256 * i, 0, 256, 256, tiles[i])
+
+            # Blank tile 5, which is deleted from the database, possibly
+            # while its previous content is still being encoded
+            ds.WriteRaster(256 * 5, 0, 256, 256, b"\x00" * (256 * 256 * 4))
+
+            # Read back tile 0, evicted from the block cache, while other
+            # tiles may still be pending
+            assert ds.ReadRaster(0, 0, 256, 256) == tiles[0]
+            ds = None
+
+    ds = ogr.Open(filename)
+    sql_lyr = ds.ExecuteSQL(
+        "SELECT tile_column, hex(tile_data) AS data FROM tiles ORDER BY tile_column"
+    )
+    ret = [(f["tile_column"], f["data"]) for f in sql_lyr]
+    ds.ReleaseResultSet(sql_lyr)
+    ds = None
+    return ret
+
+
+@pytest.mark.require_driver("PNG")
+def test_gpkg_write_tiles_multithreaded(tmp_vsimem):
+
+    got = _gpkg_write_tiles(str(tmp_vsimem / "mt.gpkg"), 4)
+    expected = _gpkg_write_tiles(str(tmp_vsimem / "st.gpkg"), 1)
+    assert got == expected
+    assert [x[0] for x in got] == [0, 1, 2, 3, 4, 6, 7]
+
+    ds = gdal.Open(str(tmp_vsimem / "mt.gpkg"))
+    ref_ds = gdal.Open(str(tmp_vsimem / "st.gpkg"))
+    assert [ds.GetRasterBand(i + 1).Checksum() for i in range(4)] == [
+        ref_ds.GetRasterBand(i + 1).Checksum() for i in range(4)
+    ]
+
+
+###############################################################################
+# Test that reading tiles decoded in parallel gives the same result as
+# decoding them in the calling thread
+
+
+def _gpkg_read_tiles(filename, num_threads, cache_max, windows):
+
+    ret = []
+    with gdaltest.config_option("GDAL_NUM_THREADS", str(num_threads)):
+        with gdaltest.SetCacheMax(cache_max):
+            for window in windows:
+                # Re-open the dataset so that tiles are not in the block cache
+                ds = gdal.Open(filename)
+                with gdaltest.disable_exceptions(), gdal.quiet_errors():
+                    gdal.ErrorReset()
+                    data = ds.ReadRaster(*window)
+                    ret.append((data, gdal.GetLastErrorType(), gdal.GetLastErrorMsg()))
+                ds = None
+    return ret
+
+
+@pytest.mark.require_driver("PNG")
+@pytest.mark.parametrize("tiling_scheme", [None, "GoogleMapsCompatible"])
+def test_gpkg_read_tiles_multithreaded(tmp_vsimem, tiling_scheme):
+
+    xsize, ysize = 600, 400
+    src_ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize, 4)
+    for i in range(4):
+        src_ds.GetRasterBand(i + 1).WriteRaster(
+            0,
+            0,
+            xsize,
+            ysize,
+            bytes(
+                (x * (i + 1) + y * 3) % 256 if i < 3 else 255
+                for y in range(ysize)
+                for x in range(xsize)
+            ),
+        )
+    # Pixel grid of zoom level 2, not aligned on tile boundaries
+    res = 2 * 20037508.342789244 / 1024
+    src_ds.SetGeoTransform(
+        [-20037508.342789244 + 37 * res, res, 0, 20037508.342789244 - 45 * res, 0, -res]
+    )
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(3857)
+    src_ds.SetSpatialRef(srs)
+
+    filename = str(tmp_vsimem / "test.gpkg")
+    options = ["TILE_FORMAT=PNG", "RASTER_TABLE=tiles"]
+    if tiling_scheme:
+        options.append("TILING_SCHEME=" + tiling_scheme)
+    gdal.GetDriverByName("GPKG").CreateCopy(filename, src_ds, options=options)
+
+    # Corrupt one tile
+    ds = ogr.Open(filename, update=1)
+    ds.ExecuteSQL(
+        "UPDATE tiles SET tile_data = x'89504E470D0A1A0A00' "
+        "WHERE id = (SELECT MAX(id) FROM tiles)"
+    )
+    ds = None
+
+    ds = gdal.Open(filename)
+    xsize, ysize = ds.RasterXSize, ds.RasterYSize
+    ds = None
+    windows = [
+        (0, 0, xsize, ysize),
+        (100, 50, 300, 200),
+        (xsize - 300, ysize - 200, 300, 200),
+        (1, 1, 256, 256),
+    ]
+
+    expected = _gpkg_read_tiles(filename, 1, 64 * 1024 * 1024, windows)
+    assert any(data for data, _, _ in expected)
+    assert _gpkg_read_tiles(filename, 4, 64 * 1024 * 1024, windows) == expected
+    # Tiles not fitting in a quarter of the block cache are not decoded in
+    # parallel
+    assert _gpkg_read_tiles(filename, 4, 1024 * 1024, windows) == expected
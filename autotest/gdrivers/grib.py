@@ -2377,3 +2377,64 @@ def test_grib_grib2_template_5_42_CCDS_aes_decompression():
         assert ds.GetRasterBand(1).Checksum() == 41970
     else:
         assert ds.GetRasterBand(1).Checksum() == -1
+
+
+###############################################################################
+# Test decoding several bands with worker threads
+
+
+def test_grib_grib2_read_multithreaded():
+
+    filename = "data/grib/gfs.t06z.pgrb2.10p0.f010.grib2"
+    ds = gdal.OpenEx(filename, open_options=["NUM_THREADS=1"])
+    expected = ds.ReadRaster()
+    expected_desc = [
+        ds.GetRasterBand(i + 1).GetDescription() for i in range(ds.RasterCount)
+    ]
+    ds = None
+
+    ds = gdal.OpenEx(filename, open_options=["NUM_THREADS=4"])
+    assert ds.ReadRaster() == expected
+    assert [
+        ds.GetRasterBand(i + 1).GetDescription() for i in range(ds.RasterCount)
+    ] == expected_desc
+
+
+###############################################################################
+# Test persisting the message inventory in the .aux.xml file
+
+
+def test_grib_grib2_read_pam_inventory(tmp_path):
+
+    filename = str(tmp_path / "test.grib2")
+    shutil.copy("data/grib/gfs.t06z.pgrb2.10p0.f010.grib2", filename)
+
+    ds = gdal.OpenEx(filename)
+    expected_md = [
+        ds.GetRasterBand(i + 1).GetMetadata() for i in range(ds.RasterCount)
+    ]
+    expected_cs = [
+        ds.GetRasterBand(i + 1).Checksum() for i in range(ds.RasterCount)
+    ]
+    ds = None
+    assert not os.path.exists(filename + ".aux.xml")
+
+    for _ in range(2):
+        ds = gdal.OpenEx(filename, open_options=["USE_PAM_INVENTORY=YES"])
+        assert [
+            ds.GetRasterBand(i + 1).GetMetadata() for i in range(ds.RasterCount)
+        ] == expected_md
+        assert [
+            ds.GetRasterBand(i + 1).Checksum() for i in range(ds.RasterCount)
+        ] == expected_cs
+        ds = None
+
+        with open(filename + ".aux.xml") as f:
+            assert "<GRIBInventory" in f.read()
+
+    # Outdated inventory
+    with open(filename, "ab") as f:
+        f.write(b"\0")
+    with gdal.quiet_errors():
+        ds = gdal.OpenEx(filename, open_options=["USE_PAM_INVENTORY=YES"])
+    assert ds.RasterCount == len(expected_md)
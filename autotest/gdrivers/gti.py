@@ -1054,6 +1054,65 @@ def test_gti_rgb_left_right(tmp_vsimem):
     )
 
 
+@pytest.mark.parametrize(
+    "open_options,expected_index_cache_active",
+    [
+        ([], "YES"),
+        (["INDEX_CACHE_MAX_FEATURES=2"], "YES"),
+        (["INDEX_CACHE_MAX_FEATURES=1"], "NO"),
+        (["INDEX_CACHE_MAX_FEATURES=0"], "NO"),
+        (["INDEX_CACHE_REFRESH_DELAY=0.000001"], "YES"),
+        (["MAX_CACHED_SOURCES=1"], "YES"),
+    ],
+)
+def test_gti_index_cache(tmp_vsimem, open_options, expected_index_cache_active):
+
+    index_filename = str(tmp_vsimem / "index.gti.gpkg")
+
+    src_ds = gdal.Open("data/small_world.tif")
+
+    left_filename = str(tmp_vsimem / "left.tif")
+    gdal.Translate(left_filename, src_ds, srcWin=[0, 0, 200, 200])
+
+    right_filename = str(tmp_vsimem / "right.tif")
+    gdal.Translate(right_filename, src_ds, srcWin=[200, 0, 200, 200])
+
+    index_ds, _ = create_basic_tileindex(
+        index_filename, [gdal.Open(left_filename), gdal.Open(right_filename)]
+    )
+    del index_ds
+
+    vrt_ds = gdal.OpenEx(index_filename, open_options=open_options)
+    for _ in range(2):
+        assert vrt_ds.ReadRaster() == src_ds.ReadRaster()
+        assert (
+            vrt_ds.GetMetadataItem("NUMBER_OF_CONTRIBUTING_SOURCES", "__DEBUG__")
+            == "2"
+        )
+
+        assert vrt_ds.ReadRaster(0, 0, 200, 200) == src_ds.ReadRaster(0, 0, 200, 200)
+        assert (
+            vrt_ds.GetMetadataItem("NUMBER_OF_CONTRIBUTING_SOURCES", "__DEBUG__")
+            == "1"
+        )
+
+        assert vrt_ds.ReadRaster(200, 0, 200, 200) == src_ds.ReadRaster(
+            200, 0, 200, 200
+        )
+        assert (
+            vrt_ds.GetMetadataItem("NUMBER_OF_CONTRIBUTING_SOURCES", "__DEBUG__")
+            == "1"
+        )
+
+    assert (
+        vrt_ds.GetMetadataItem("INDEX_CACHE_ACTIVE", "__DEBUG__")
+        == expected_index_cache_active
+    )
+
+    vrt_ds.FlushCache()
+    assert vrt_ds.GetMetadataItem("INDEX_CACHE_ACTIVE", "__DEBUG__") == "NO"
+
+
 def test_gti_overlapping_sources(tmp_vsimem):
 
     filename1 = str(tmp_vsimem / "one.tif")
@@ -827,3 +827,61 @@ def test_hdf5_multidim_eos_swath_no_explicit_dimension_map():
         coordinates[1].GetFullName()
         == "/HDFEOS/SWATHS/MySwath/Geolocation Fields/Latitude"
     )
+
+
+###############################################################################
+# Test reading chunked and compressed arrays without going through libhdf5
+
+
+@pytest.mark.require_driver("netCDF")
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_hdf5_multidim_direct_chunk_read(tmp_path, num_threads):
+
+    filename = str(tmp_path / "test.nc")
+    ds = gdal.GetDriverByName("netCDF").CreateMultiDimensional(filename)
+    rg = ds.GetRootGroup()
+    dims = [
+        rg.CreateDimension("time", None, None, 3),
+        rg.CreateDimension("y", None, None, 50),
+        rg.CreateDimension("x", None, None, 70),
+    ]
+    ar = rg.CreateMDArray(
+        "ar",
+        dims,
+        gdal.ExtendedDataType.Create(gdal.GDT_Int16),
+        ["COMPRESS=DEFLATE", "BLOCKSIZE=1,16,20"],
+    )
+    # Only write the first 2 time steps, so that the last one is made of
+    # missing chunks
+    values = [(i * 7) % 32749 for i in range(2 * 50 * 70)]
+    assert (
+        ar.Write(
+            struct.pack("h" * len(values), *values),
+            array_start_idx=[0, 0, 0],
+            count=[2, 50, 70],
+        )
+        == gdal.CE_None
+    )
+    ds = None
+
+    def read(**kwargs):
+        ds = gdal.OpenEx("HDF5:" + filename, gdal.OF_MULTIDIM_RASTER)
+        ar = ds.GetRootGroup().OpenMDArray("ar")
+        assert ar.GetBlockSize() == [1, 16, 20]
+        return ar.Read(**kwargs)
+
+    requests = [
+        {},
+        {"array_start_idx": [1, 5, 3], "count": [2, 40, 60]},
+        {"array_start_idx": [0, 1, 2], "count": [3, 10, 20], "array_step": [1, 5, 3]},
+        {"buffer_datatype": gdal.ExtendedDataType.Create(gdal.GDT_Float64)},
+    ]
+    for kwargs in requests:
+        with gdaltest.config_option("GDAL_HDF5_DIRECT_CHUNK_READ", "NO"):
+            expected = read(**kwargs)
+        with gdaltest.config_option("GDAL_NUM_THREADS", num_threads):
+            got = read(**kwargs)
+        assert got == expected, kwargs
+
+    got = struct.unpack("h" * (3 * 50 * 70), read())
+    assert got[0 : 2 * 50 * 70] == tuple(values)
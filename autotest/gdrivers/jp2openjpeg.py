@@ -3850,3 +3850,59 @@ def test_jp2openjpeg_vrt_protocol():
         webserver.server_stop(webserver_process, webserver_port)
 
         gdal.VSICurlClearCache()
+
+
+###############################################################################
+# Test decoder reuse and region of interest decoding on a tiled image
+
+
+def test_jp2openjpeg_tiled_decoder_reuse_and_roi(tmp_vsimem):
+
+    src_ds = gdal.Translate(
+        "", "../gcore/data/byte.tif", format="MEM", width=512, height=512
+    )
+    filename = str(tmp_vsimem / "tiled.jp2")
+    gdaltest.jp2openjpeg_drv.CreateCopy(
+        filename,
+        src_ds,
+        options=[
+            "BLOCKXSIZE=128",
+            "BLOCKYSIZE=128",
+            "RESOLUTIONS=3",
+            "REVERSIBLE=YES",
+            "QUALITY=100",
+        ],
+    )
+
+    expected = src_ds.ReadRaster()
+    for reuse in ("YES", "NO"):
+        with gdaltest.config_options(
+            {"USE_OPENJPEG_DECODER_REUSE": reuse, "GDAL_NUM_THREADS": "4"}
+        ):
+            ds = gdal.Open(filename)
+            assert ds.ReadRaster() == expected
+            # Read again tiles in another order, one at a time
+            ds = gdal.Open(filename)
+            for y in range(3, -1, -1):
+                for x in range(3, -1, -1):
+                    assert ds.ReadRaster(
+                        x * 128, y * 128, 128, 128
+                    ) == src_ds.ReadRaster(x * 128, y * 128, 128, 128)
+
+    windows = [(0, 0, 10, 10), (130, 200, 50, 20), (511, 511, 1, 1)]
+    for band_getter in (
+        lambda ds: ds.GetRasterBand(1),
+        lambda ds: ds.GetRasterBand(1).GetOverview(0),
+    ):
+        res = {}
+        for roi in ("YES", "NO"):
+            with gdaltest.config_option("USE_OPENJPEG_ROI_DECODING", roi):
+                ds = gdal.Open(filename)
+                band = band_getter(ds)
+                res[roi] = [
+                    band.ReadRaster(
+                        min(x, band.XSize - w), min(y, band.YSize - h), w, h
+                    )
+                    for (x, y, w, h) in windows
+                ]
+        assert res["YES"] == res["NO"]
@@ -35,7 +35,7 @@ import gdaltest
 import pytest
 import webserver
 
-from osgeo import gdal, ogr
+from osgeo import gdal, ogr, osr
 
 pytestmark = pytest.mark.require_driver("MBTILES")
 
@@ -562,6 +562,35 @@ def test_mbtiles_11():
     assert ds.GetRasterBand(1).Checksum() == 4118, "validation failed"
 
 
+###############################################################################
+# Test that reading a whole window, whose tiles are fetched with a single
+# query, returns the same pixels as reading block by block
+
+
+@pytest.mark.require_driver("PNG")
+def test_mbtiles_read_window_prefetch():
+
+    ds = gdal.OpenEx("data/mbtiles/world_l1.mbtiles", open_options=["USE_BOUNDS=NO"])
+    data = ds.ReadRaster()
+
+    ds_blocks = gdal.OpenEx(
+        "data/mbtiles/world_l1.mbtiles", open_options=["USE_BOUNDS=NO"]
+    )
+    band = ds_blocks.GetRasterBand(1)
+    blockxsize, blockysize = band.GetBlockSize()
+    for y in range(0, ds_blocks.RasterYSize, blockysize):
+        for x in range(0, ds_blocks.RasterXSize, blockxsize):
+            for i in range(ds_blocks.RasterCount):
+                ds_blocks.GetRasterBand(i + 1).ReadBlock(
+                    x // blockxsize, y // blockysize
+                )
+    assert ds_blocks.ReadRaster() == data
+
+    # Partial window not aligned on tiles
+    ds = gdal.OpenEx("data/mbtiles/world_l1.mbtiles", open_options=["USE_BOUNDS=NO"])
+    assert ds.ReadRaster(100, 50, 300, 200) == ds_blocks.ReadRaster(100, 50, 300, 200)
+
+
 ###############################################################################
 
 
@@ -705,3 +734,66 @@ def test_mbtiles_webp_write():
     ds = None
 
     gdal.Unlink("/vsimem/mbtiles_webp_write.mbtiles")
+
+
+###############################################################################
+# Test encoding tiles in worker threads with GDAL_NUM_THREADS
+
+
+def _mbtiles_write_tiles(filename, num_threads):
+
+    # Zoom level 2: 4 tiles of 256 pixels cover the whole world width
+    tile_count = 4
+    res = 2 * 20037508.342789244 / (256 * tile_count)
+    with gdaltest.config_option("GDAL_NUM_THREADS", str(num_threads)):
+        # Small block cache so that tiles get flushed, and thus submitted
+        # for encoding, while other tiles are being written
+        with gdaltest.SetCacheMax(512 * 1024):
+            ds = gdaltest.mbtiles_drv.Create(
+                filename, 256 * tile_count, 256, 4, options=["TILE_FORMAT=PNG"]
+            )
+            ds.SetGeoTransform(
+                [-20037508.342789244, res, 0, 20037508.342789244, 0, -res]
+            )
+            srs = osr.SpatialReference()
+            srs.ImportFromEPSG(3857)
+            ds.SetSpatialRef(srs)
+            tiles = []
+            for i in range(tile_count):
+                rgb = bytes((x + 16 * i) % 256 for x in range(256)) * 256 * 3
+                tiles.append(rgb + b"\xff" * (256 * 256))
+                ds.WriteRaster(256 * i, 0, 256, 256, tiles[i])
+
+            # Blank tile 2, which is deleted from the database, possibly
+            # while its previous content is still being encoded
+            ds.WriteRaster(256 * 2, 0, 256, 256, b"\x00" * (256 * 256 * 4))
+
+            # Read back tile 0, evicted from the block cache, while other
+            # tiles may still be pending
+            assert ds.ReadRaster(0, 0, 256, 256) == tiles[0]
+            ds = None
+
+    ds = ogr.Open(filename)
+    sql_lyr = ds.ExecuteSQL(
+        "SELECT tile_column, hex(tile_data) AS data FROM tiles "
+        "WHERE zoom_level = 2 ORDER BY tile_column"
+    )
+    ret = [(f["tile_column"], f["data"]) for f in sql_lyr]
+    ds.ReleaseResultSet(sql_lyr)
+    ds = None
+    return ret
+
+
+@pytest.mark.require_driver("PNG")
+def test_mbtiles_write_tiles_multithreaded(tmp_vsimem):
+
+    got = _mbtiles_write_tiles(str(tmp_vsimem / "mt.mbtiles"), 4)
+    expected = _mbtiles_write_tiles(str(tmp_vsimem / "st.mbtiles"), 1)
+    assert got == expected
+    assert [x[0] for x in got] == [0, 1, 3]
+
+    ds = gdal.Open(str(tmp_vsimem / "mt.mbtiles"))
+    ref_ds = gdal.Open(str(tmp_vsimem / "st.mbtiles"))
+    assert [ds.GetRasterBand(i + 1).Checksum() for i in range(4)] == [
+        ref_ds.GetRasterBand(i + 1).Checksum() for i in range(4)
+    ]
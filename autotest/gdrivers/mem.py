@@ -31,6 +31,7 @@
 
 import ctypes
 import struct
+import sys
 
 import gdaltest
 import pytest
@@ -783,6 +784,76 @@ def test_mem_alpha_ismaskband():
     assert ds.GetRasterBand(2).IsMaskBand()
 
 
+###############################################################################
+# Test that CreateCopy() of a MEM dataset shares its buffers with the source
+# until either of them is modified
+
+
+@pytest.mark.parametrize("interleave", ["BAND", "PIXEL"])
+def test_mem_create_copy_copy_on_write(interleave):
+
+    drv = gdal.GetDriverByName("MEM")
+    src_ds = drv.Create("", 3, 2, 2, options=["INTERLEAVE=" + interleave])
+    src_ds.SetGeoTransform([2, 1, 0, 49, 0, -1])
+    src_ds.GetRasterBand(1).WriteRaster(0, 0, 3, 2, b"\x01\x02\x03\x04\x05\x06")
+    src_ds.GetRasterBand(1).SetNoDataValue(255)
+    src_ds.GetRasterBand(2).Fill(7)
+
+    out_ds = drv.CreateCopy("", src_ds)
+    assert out_ds.GetGeoTransform() == (2, 1, 0, 49, 0, -1)
+    assert out_ds.GetRasterBand(1).GetNoDataValue() == 255
+    assert out_ds.GetRasterBand(1).ReadRaster() == b"\x01\x02\x03\x04\x05\x06"
+    assert out_ds.GetRasterBand(2).ReadRaster() == b"\x07" * 6
+    if interleave == "PIXEL":
+        assert out_ds.GetMetadataItem("INTERLEAVE", "IMAGE_STRUCTURE") == "PIXEL"
+
+    # Modifying the copy does not affect the source
+    out_ds.GetRasterBand(1).Fill(9)
+    assert out_ds.GetRasterBand(1).ReadRaster() == b"\x09" * 6
+    assert src_ds.GetRasterBand(1).ReadRaster() == b"\x01\x02\x03\x04\x05\x06"
+
+    # and the other way round
+    out_ds2 = drv.CreateCopy("", src_ds)
+    src_ds.WriteRaster(0, 0, 3, 2, b"\x08" * 12)
+    assert src_ds.GetRasterBand(2).ReadRaster() == b"\x08" * 6
+    assert out_ds2.GetRasterBand(1).ReadRaster() == b"\x01\x02\x03\x04\x05\x06"
+    assert out_ds2.GetRasterBand(2).ReadRaster() == b"\x07" * 6
+
+    # The copy outlives its source
+    src_ds = None
+    assert out_ds2.GetRasterBand(2).ReadRaster() == b"\x07" * 6
+
+
+###############################################################################
+# Test SCRATCH_FILE=YES creation option
+
+
+@pytest.mark.skipif(sys.platform == "win32", reason="mmap() not available")
+def test_mem_scratch_file(tmp_path):
+
+    with gdaltest.config_option("CPL_TMPDIR", str(tmp_path)):
+        ds = gdal.GetDriverByName("MEM").Create(
+            "", 100, 50, 2, gdal.GDT_Int16, options=["SCRATCH_FILE=YES"]
+        )
+    assert ds
+    # The backing file is removed right away
+    assert len(gdal.ReadDir(str(tmp_path)) or []) == 0
+
+    assert ds.GetRasterBand(1).Checksum() == 0
+    ds.GetRasterBand(1).Fill(1)
+    ds.GetRasterBand(2).WriteRaster(10, 20, 2, 1, struct.pack("h" * 2, -1, 2))
+    assert ds.GetRasterBand(1).ComputeRasterMinMax() == (1, 1)
+    assert struct.unpack("h" * 2, ds.GetRasterBand(2).ReadRaster(10, 20, 2, 1)) == (
+        -1,
+        2,
+    )
+
+    out_ds = gdal.GetDriverByName("MEM").CreateCopy("", ds)
+    assert out_ds.GetRasterBand(2).Checksum() == ds.GetRasterBand(2).Checksum()
+    ds = None
+    assert out_ds.GetRasterBand(1).ComputeRasterMinMax() == (1, 1)
+
+
 ###############################################################################
 # cleanup
 
@@ -645,6 +645,67 @@ def test_mrf_setspatialref():
     gdal.GetDriverByName("MRF").Delete(filename)
 
 
+###############################################################################
+# Test that reading tiles with the index chunk cache and the read-ahead of
+# consecutive tiles gives the source data, including after a tile has been
+# rewritten out of order in the data file
+
+
+@pytest.mark.parametrize("compress", ["DEFLATE", "PNG", "NONE"])
+def test_mrf_read_consecutive_tiles(tmp_vsimem, compress):
+
+    # 64 x 40 tiles, so that the index spans more than one 32 KB chunk
+    xsize, ysize, blocksize = 1024, 640, 16
+    data = bytearray(
+        (x * 7 + y * 13 + (x * y) % 11) % 256
+        for y in range(ysize)
+        for x in range(xsize)
+    )
+    src_ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize)
+    src_ds.WriteRaster(0, 0, xsize, ysize, bytes(data))
+
+    filename = str(tmp_vsimem / "test.mrf")
+    gdal.GetDriverByName("MRF").CreateCopy(
+        filename,
+        src_ds,
+        options=["COMPRESS=" + compress, "BLOCKSIZE=%d" % blocksize],
+    )
+
+    def check(data):
+        ds = gdal.Open(filename)
+        assert ds.ReadRaster() == data
+        ds = None
+
+        # Read individual tiles in an order that mixes tiles served from the
+        # read-ahead buffer, tiles already in the block cache, and tiles
+        # requiring a new request
+        ds = gdal.Open(filename)
+        band = ds.GetRasterBand(1)
+        for yblock in (0, 39, 1, 17):
+            for xblock in list(range(5, 40)) + list(range(0, 10)) + [63, 62]:
+                got = band.ReadBlock(xblock, yblock)
+                for y in range(blocksize):
+                    offset = (yblock * blocksize + y) * xsize + xblock * blocksize
+                    assert (
+                        got[y * blocksize : (y + 1) * blocksize]
+                        == data[offset : offset + blocksize]
+                    ), (xblock, yblock)
+        ds = None
+
+    check(bytes(data))
+
+    # Rewrite a tile, which is appended to the data file, so that the tiles of
+    # its row are no longer consecutive
+    ds = gdal.Open(filename, gdal.GA_Update)
+    ds.WriteRaster(20 * blocksize, 17 * blocksize, blocksize, blocksize, b"\x01" * 256)
+    ds = None
+    for y in range(blocksize):
+        offset = (17 * blocksize + y) * xsize + 20 * blocksize
+        data[offset : offset + blocksize] = b"\x01" * blocksize
+
+    check(bytes(data))
+
+
 def test_mrf_cleanup():
 
     files = (
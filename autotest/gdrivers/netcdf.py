@@ -6483,3 +6483,36 @@ def test_gdal_subdataset_bogus(bogus):
     """Test it doesn't crash"""
 
     gdal.GetSubdatasetInfo(bogus)
+
+
+###############################################################################
+# Test the GDAL_NETCDF_OPEN_CACHE open cache
+
+
+def test_netcdf_open_cache(tmp_path):
+
+    filename = str(tmp_path / "test_netcdf_open_cache.nc")
+    shutil.copy("data/netcdf/fake_Oa01_radiance.nc", filename)
+
+    ds = gdal.Open(filename)
+    ref_md = ds.GetMetadata()
+    ref_subds = ds.GetSubDatasets()
+    assert len(ref_subds) == 2
+    ds = None
+
+    with gdaltest.config_option("GDAL_NETCDF_OPEN_CACHE", "YES"):
+        for _ in range(2):
+            ds = gdal.Open(filename)
+            assert ds.GetMetadata() == ref_md
+            assert ds.GetSubDatasets() == ref_subds
+            ds = None
+
+        # Replace the file by another one with a different size: the cached
+        # entry must not be reused
+        shutil.copy("data/netcdf/two_vars_scale_offset.nc", filename)
+        ds = gdal.Open(filename)
+        subds = ds.GetSubDatasets()
+        assert subds != ref_subds
+        assert len(subds) == 2
+        assert gdal.Open(subds[0][0]) is not None
+        ds = None
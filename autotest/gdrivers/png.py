@@ -488,3 +488,59 @@ def test_png_copy_mdd():
     ds = None
 
     gdal.Unlink(filename)
+
+
+###############################################################################
+# Test ENCODER=GDAL
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+@pytest.mark.parametrize(
+    "nbands,datatype,with_ct",
+    [
+        (1, gdal.GDT_Byte, False),
+        (1, gdal.GDT_Byte, True),
+        (2, gdal.GDT_Byte, False),
+        (3, gdal.GDT_Byte, False),
+        (4, gdal.GDT_UInt16, False),
+    ],
+)
+def test_png_encoder_gdal(tmp_vsimem, num_threads, nbands, datatype, with_ct):
+
+    xsize = 1000
+    ysize = 300
+    src_ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize, nbands, datatype)
+    for i in range(nbands):
+        src_ds.GetRasterBand(i + 1).WriteRaster(
+            0,
+            0,
+            xsize,
+            ysize,
+            array.array(
+                "B" if datatype == gdal.GDT_Byte else "H",
+                [
+                    ((x // 3) * (i + 1) + y) % 200
+                    for y in range(ysize)
+                    for x in range(xsize)
+                ],
+            ),
+        )
+    if with_ct:
+        ct = gdal.ColorTable()
+        for i in range(256):
+            ct.SetColorEntry(i, (i, 255 - i, i // 2, 255))
+        src_ds.GetRasterBand(1).SetRasterColorTable(ct)
+
+    filename = str(tmp_vsimem / "test.png")
+    out_ds = gdal.GetDriverByName("PNG").CreateCopy(
+        filename, src_ds, options=["ENCODER=GDAL", "NUM_THREADS=" + num_threads]
+    )
+    assert out_ds is not None
+    out_ds = None
+
+    ds = gdal.Open(filename)
+    assert ds.RasterCount == nbands
+    assert ds.GetRasterBand(1).DataType == datatype
+    assert ds.ReadRaster() == src_ds.ReadRaster()
+    if with_ct:
+        assert ds.GetRasterBand(1).GetRasterColorTable() is not None
@@ -1023,6 +1023,130 @@ def identity(in_ar, out_ar, xoff, yoff, xsize, ysize, raster_xsize, raster_ysize
     _validate(xml)
 
 
+###############################################################################
+# Test reading a Python derived band by batches of blocks
+# (GDAL_VRT_PYTHON_BATCH_BLOCKS), with sources read in parallel
+# (GDAL_NUM_THREADS), and with Python buffers reused from one call to another
+
+
+@pytest.mark.parametrize("batch_blocks", [None, "3", "100"])
+@pytest.mark.parametrize("num_threads", [None, "4"])
+def test_vrtderived_python_batch_blocks_and_threads(
+    tmp_path, batch_blocks, num_threads
+):
+
+    numpy = pytest.importorskip("numpy")
+
+    width = 300
+    height = 100
+    block_xsize = 64
+    block_ysize = 32
+
+    # Two bands of the same dataset, and one band of another dataset
+    src1 = numpy.arange(2 * width * height, dtype=numpy.uint32)
+    src1 = (src1 % 251).astype(numpy.uint8).reshape((2, height, width))
+    src2 = numpy.arange(width * height, dtype=numpy.uint32)
+    src2 = ((src2 * 7) % 253).astype(numpy.uint8).reshape((height, width))
+    src1_filename = str(tmp_path / "src1.tif")
+    src2_filename = str(tmp_path / "src2.tif")
+    ds = gdal.GetDriverByName("GTiff").Create(src1_filename, width, height, 2)
+    ds.WriteRaster(0, 0, width, height, src1.tobytes())
+    ds = None
+    ds = gdal.GetDriverByName("GTiff").Create(src2_filename, width, height, 1)
+    ds.WriteRaster(0, 0, width, height, src2.tobytes())
+    ds = None
+
+    # The result depends on the position of each pixel, to catch wrong
+    # offsets when several blocks are computed at once
+    rows, cols = numpy.mgrid[0:height, 0:width]
+    expected = (
+        src1[0].astype(numpy.uint32)
+        + 2 * src1[1].astype(numpy.uint32)
+        + 3 * src2.astype(numpy.uint32)
+        + (cols % 7)
+        + (rows % 5)
+    ) % 256
+    expected = expected.astype(numpy.uint8)
+
+    def source(filename, band):
+        return f"""
+    <SimpleSource>
+      <SourceFilename>{filename}</SourceFilename>
+      <SourceBand>{band}</SourceBand>
+    </SimpleSource>"""
+
+    vrt = f"""<VRTDataset rasterXSize="{width}" rasterYSize="{height}">
+  <VRTRasterBand dataType="Byte" band="1" subClass="VRTDerivedRasterBand"
+                 blockXSize="{block_xsize}" blockYSize="{block_ysize}">
+    <PixelFunctionType>combine</PixelFunctionType>
+    <PixelFunctionLanguage>Python</PixelFunctionLanguage>
+    <PixelFunctionCode><![CDATA[
+import numpy as np
+def combine(in_ar, out_ar, xoff, yoff, xsize, ysize, raster_xsize, raster_ysize, r, gt, **kwargs):
+    rows, cols = np.mgrid[yoff:yoff + ysize, xoff:xoff + xsize]
+    res = (in_ar[0].astype(np.uint32) + 2 * in_ar[1].astype(np.uint32)
+           + 3 * in_ar[2].astype(np.uint32) + (cols % 7) + (rows % 5))
+    out_ar[:] = res % 256
+]]>
+    </PixelFunctionCode>
+    {source(src1_filename, 1)}{source(src1_filename, 2)}{source(src2_filename, 1)}
+  </VRTRasterBand>
+</VRTDataset>
+"""
+
+    with gdaltest.config_options(
+        {
+            "GDAL_VRT_ENABLE_PYTHON": "YES",
+            "GDAL_VRT_PYTHON_BATCH_BLOCKS": batch_blocks,
+            "GDAL_NUM_THREADS": num_threads,
+        },
+        thread_local=False,
+    ):
+        ds = gdal.Open(vrt)
+        band = ds.GetRasterBand(1)
+        assert band.GetBlockSize() == [block_xsize, block_ysize]
+
+        # Read blocks in an order where some of the blocks that follow the
+        # requested one are already in the block cache
+        nblocks_x = (width + block_xsize - 1) // block_xsize
+        nblocks_y = (height + block_ysize - 1) // block_ysize
+        order = [(x, y) for y in range(nblocks_y) for x in range(nblocks_x)]
+        order = order[1::2] + order[0::2]
+        for x, y in order:
+            got = numpy.frombuffer(band.ReadBlock(x, y), dtype=numpy.uint8)
+            got = got.reshape((block_ysize, block_xsize))
+            x0 = x * block_xsize
+            y0 = y * block_ysize
+            w = min(block_xsize, width - x0)
+            h = min(block_ysize, height - y0)
+            assert numpy.array_equal(
+                got[0:h, 0:w], expected[y0 : y0 + h, x0 : x0 + w]
+            ), (x, y)
+
+        # Windows of different sizes, so that the reused Python buffers must
+        # be reallocated, and then reused again
+        for xoff, yoff, xsize, ysize in [
+            (0, 0, width, height),
+            (5, 3, 17, 29),
+            (5, 3, 17, 29),
+            (100, 50, 200, 50),
+            (0, 0, width, height),
+        ]:
+            got = numpy.frombuffer(
+                ds.ReadRaster(xoff, yoff, xsize, ysize), dtype=numpy.uint8
+            ).reshape((ysize, xsize))
+            assert numpy.array_equal(
+                got, expected[yoff : yoff + ysize, xoff : xoff + xsize]
+            ), (xoff, yoff, xsize, ysize)
+
+        # The histogram is computed from the block cache, filled by the
+        # batched computation of blocks
+        ds = gdal.Open(vrt)
+        band = ds.GetRasterBand(1)
+        hist = band.GetHistogram(-0.5, 255.5, 256, False, False)
+        assert hist == numpy.bincount(expected.ravel(), minlength=256).tolist()
+
+
 ###############################################################################
 # Cleanup.
 
@@ -323,6 +323,54 @@ def test_vrtovr_external_ovr_has_priority_over_implicit():
     gdal.Unlink("/vsimem/test.vrt")
 
 
+###############################################################################
+# Test that implicit virtual overviews of a mosaic directly read the matching
+# overview level of each source
+
+
+@pytest.mark.parametrize("from_datasets", [False, True])
+def test_vrtovr_virtual_mosaic(tmp_vsimem, from_datasets):
+
+    filenames = []
+    for i, (val, ovr_vals) in enumerate([(1, (10, 30)), (2, (20, 40))]):
+        filename = str(tmp_vsimem / f"tile{i}.tif")
+        ds = gdal.GetDriverByName("GTiff").Create(filename, 512, 512)
+        ds.SetGeoTransform([2 + i * 512, 1, 0, 49, 0, -1])
+        ds.BuildOverviews("NEAR", [2, 4])
+        ds.GetRasterBand(1).Fill(val)
+        ds.GetRasterBand(1).GetOverview(0).Fill(ovr_vals[0])
+        ds.GetRasterBand(1).GetOverview(1).Fill(ovr_vals[1])
+        ds = None
+        filenames.append(filename)
+
+    vrt_filename = str(tmp_vsimem / "mosaic.vrt")
+    if from_datasets:
+        src_ds = [gdal.Open(filename) for filename in filenames]
+        vrt_ds = gdal.BuildVRT("", src_ds)
+    else:
+        gdal.BuildVRT(vrt_filename, filenames)
+        vrt_ds = gdal.Open(vrt_filename)
+
+    band = vrt_ds.GetRasterBand(1)
+    assert band.GetOverviewCount() == 2
+
+    ovr_band = band.GetOverview(0)
+    assert ovr_band.XSize == 512
+    assert ovr_band.YSize == 256
+    assert struct.unpack("B" * 4, ovr_band.ReadRaster(254, 0, 4, 1)) == (10, 10, 20, 20)
+
+    ovr_band = band.GetOverview(1)
+    assert ovr_band.XSize == 256
+    assert ovr_band.YSize == 128
+    assert struct.unpack("B" * 4, ovr_band.ReadRaster(126, 0, 4, 1)) == (30, 30, 40, 40)
+
+    assert struct.unpack(
+        "B" * 4, band.ReadRaster(508, 0, 8, 2, buf_xsize=4, buf_ysize=1)
+    ) == (10, 10, 20, 20)
+
+    assert struct.unpack("B" * 2, band.ReadRaster(511, 0, 2, 1)) == (1, 2)
+
+
 ###############################################################################
 # Cleanup.
 
@@ -2304,3 +2304,116 @@ def test_vrtpansharpen_out_of_order_input_bands_and_nodata():
     cs2 = [vrt_ds.GetRasterBand(i + 1).Checksum() for i in range(vrt_ds.RasterCount)]
 
     assert cs2 == cs[::-1]
+
+
+###############################################################################
+# Check the SIMD code paths of the weighted Brovey algorithm with positive
+# weights (AVX2 kernels, and SSE2 ones when GDAL_USE_AVX2=NO on a debug build)
+# against a direct computation
+
+
+@pytest.mark.parametrize(
+    "dt,bit_depth,nb_input,nb_output",
+    [
+        (gdal.GDT_Byte, None, 3, 3),
+        (gdal.GDT_Byte, None, 4, 4),
+        (gdal.GDT_Byte, None, 4, 3),
+        (gdal.GDT_UInt16, None, 3, 3),
+        (gdal.GDT_UInt16, None, 4, 4),
+        (gdal.GDT_UInt16, 12, 4, 3),
+    ],
+)
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+@pytest.mark.parametrize("use_avx2", ["YES", "NO"])
+def test_vrtpansharpen_weighted_brovey_simd(
+    dt, bit_depth, nb_input, nb_output, num_threads, use_avx2
+):
+
+    numpy = pytest.importorskip("numpy")
+
+    # Width not a multiple of 8, to also go through the scalar tail
+    width = 202
+    height = 62
+    if dt == gdal.GDT_Byte:
+        np_dt = numpy.uint8
+        max_val = 255
+    else:
+        np_dt = numpy.uint16
+        max_val = (1 << bit_depth) - 1 if bit_depth else 65535
+    ms_max = min(max_val, 1000)
+
+    idx = numpy.arange(width * height, dtype=numpy.int64).reshape((height, width))
+    pan = ((idx * 37) % (max_val + 1)).astype(np_dt)
+    pan_ds = gdal.GetDriverByName("MEM").Create("", width, height, 1, dt)
+    pan_ds.SetGeoTransform([0, 1, 0, 0, 0, -1])
+    pan_ds.GetRasterBand(1).WriteRaster(0, 0, width, height, pan.tobytes())
+
+    ms_width = width // 2
+    ms_height = height // 2
+    ms_ds = gdal.GetDriverByName("MEM").Create(
+        "", ms_width, ms_height, nb_input, dt
+    )
+    ms_ds.SetGeoTransform([0, 2, 0, 0, 0, -2])
+    ms = []
+    ms_idx = idx[0:ms_height, 0:ms_width]
+    for i in range(nb_input):
+        band = ((ms_idx * (7 + 4 * i) + 13 * i) % (ms_max + 1)).astype(np_dt)
+        # Some pixels with a null pseudo panchromatic value
+        band[0, 0:5] = 0
+        ms_ds.GetRasterBand(i + 1).WriteRaster(
+            0, 0, ms_width, ms_height, band.tobytes()
+        )
+        ms.append(band)
+
+    weights = [0.3, 0.25, 0.2, 0.25][0:nb_input]
+    spectral_bands = "".join(
+        f'<SpectralBand dstBand="{i + 1}"/>' if i < nb_output else "<SpectralBand/>"
+        for i in range(nb_input)
+    )
+    bit_depth_xml = f"<BitDepth>{bit_depth}</BitDepth>" if bit_depth else ""
+    xml = f"""<VRTDataset subClass="VRTPansharpenedDataset">
+        <PansharpeningOptions>
+            <Algorithm>WeightedBrovey</Algorithm>
+            <AlgorithmOptions>
+                <Weights>{",".join(str(w) for w in weights)}</Weights>
+            </AlgorithmOptions>
+            <Resampling>Nearest</Resampling>
+            <NumThreads>{num_threads}</NumThreads>
+            {bit_depth_xml}
+            {spectral_bands}
+        </PansharpeningOptions>
+    </VRTDataset>"""
+
+    # Expected result, with the same sequence of double operations
+    ms_up = [numpy.repeat(numpy.repeat(b, 2, axis=0), 2, axis=1) for b in ms]
+    pseudo = numpy.zeros((height, width))
+    for w, b in zip(weights, ms_up):
+        pseudo += w * b.astype(numpy.float64)
+    with numpy.errstate(divide="ignore", invalid="ignore"):
+        factor = numpy.where(pseudo != 0, pan / pseudo, 0)
+    expected = [
+        numpy.floor(numpy.minimum(b * factor, max_val) + 0.5).astype(np_dt)
+        for b in ms_up[0:nb_output]
+    ]
+
+    with gdal.config_option("GDAL_USE_AVX2", use_avx2, thread_local=False):
+        vrt_ds = gdal.CreatePansharpenedVRT(
+            xml,
+            pan_ds.GetRasterBand(1),
+            [ms_ds.GetRasterBand(i + 1) for i in range(nb_input)],
+        )
+        assert vrt_ds.RasterCount == nb_output
+        got = numpy.frombuffer(vrt_ds.ReadRaster(), dtype=np_dt)
+        got = got.reshape((nb_output, height, width))
+        for i in range(nb_output):
+            assert numpy.array_equal(got[i], expected[i]), i
+
+        # Sub-window, starting at a multispectral pixel boundary
+        xoff, yoff, xsize, ysize = 16, 10, 101, 33
+        got = numpy.frombuffer(
+            vrt_ds.ReadRaster(xoff, yoff, xsize, ysize), dtype=np_dt
+        ).reshape((nb_output, ysize, xsize))
+        for i in range(nb_output):
+            assert numpy.array_equal(
+                got[i], expected[i][yoff : yoff + ysize, xoff : xoff + xsize]
+            ), i
@@ -1158,3 +1158,56 @@ def test_wms_cache_path():
 
     with pytest.raises(Exception):
         gdal.Open("<GDAL_WMS><Service/><Cache/></GDAL_WMS>")
+
+
+###############################################################################
+# Test the process-wide in-memory tile cache
+
+
+def test_wms_memory_cache(tmp_vsimem):
+
+    src_ds = gdal.Open("data/byte.tif")
+    gdal.GetDriverByName("PNG").CreateCopy(str(tmp_vsimem / "0/0/0.png"), src_ds)
+
+    tms = f"""<GDAL_WMS>
+    <Service name="TMS">
+        <ServerUrl>{tmp_vsimem}/${{z}}/${{x}}/${{y}}.png</ServerUrl>
+    </Service>
+    <DataWindow>
+        <UpperLeftX>0</UpperLeftX>
+        <UpperLeftY>20</UpperLeftY>
+        <LowerRightX>20</LowerRightX>
+        <LowerRightY>0</LowerRightY>
+        <TileLevel>0</TileLevel>
+        <TileCountX>1</TileCountX>
+        <TileCountY>1</TileCountY>
+        <YOrigin>top</YOrigin>
+    </DataWindow>
+    <BlockSizeX>20</BlockSizeX>
+    <BlockSizeY>20</BlockSizeY>
+    <BandsCount>1</BandsCount>
+</GDAL_WMS>"""
+
+    with gdaltest.config_options(
+        {
+            "CPL_CURL_ENABLE_VSIMEM": "YES",
+            "GDAL_WMS_MEMORY_CACHE_SIZE": "1000000",
+        }
+    ):
+        ds = gdal.Open(tms)
+        assert ds.GetRasterBand(1).Checksum() == src_ds.GetRasterBand(1).Checksum()
+        ds = None
+
+        gdal.Unlink(str(tmp_vsimem / "0/0/0.png"))
+
+        # Served from the memory cache
+        ds = gdal.Open(tms)
+        assert ds.GetRasterBand(1).Checksum() == src_ds.GetRasterBand(1).Checksum()
+        ds = None
+
+    with gdaltest.config_options(
+        {"CPL_CURL_ENABLE_VSIMEM": "YES", "GDAL_WMS_MEMORY_CACHE_SIZE": "0"}
+    ):
+        ds = gdal.Open(tms)
+        with gdal.quiet_errors():
+            assert ds.GetRasterBand(1).ReadRaster() is None
@@ -3851,6 +3851,219 @@ def test_zarr_advise_read(compression, format):
         gdal.RmdirRecursive(filename)
 
 
+###############################################################################
+# Test that reading several tiles without AdviseRead() decodes them in
+# parallel with the same result
+
+
+@pytest.mark.parametrize("format", ["ZARR_V2", "ZARR_V3"])
+def test_zarr_read_multi_tile_implicit_parallel(tmp_vsimem, format):
+
+    filename = str(tmp_vsimem / "test.zarr")
+    dim0_size = 7
+    dim1_size = 230
+    dim2_size = 170
+    data = array.array(
+        "H", [(i * 37) % 65536 for i in range(dim0_size * dim1_size * dim2_size)]
+    )
+
+    ds = gdal.GetDriverByName("ZARR").CreateMultiDimensional(
+        filename, options=["FORMAT=" + format]
+    )
+    rg = ds.GetRootGroup()
+    dim0 = rg.CreateDimension("dim0", None, None, dim0_size)
+    dim1 = rg.CreateDimension("dim1", None, None, dim1_size)
+    dim2 = rg.CreateDimension("dim2", None, None, dim2_size)
+    ar = rg.CreateMDArray(
+        "test",
+        [dim0, dim1, dim2],
+        gdal.ExtendedDataType.Create(gdal.GDT_UInt16),
+        ["COMPRESS=GZIP", "BLOCKSIZE=2,20,30"],
+    )
+    assert ar.Write(data) == gdal.CE_None
+    ds = None
+
+    def read(num_threads):
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER)
+            ar = ds.GetRootGroup().OpenMDArray("test")
+            return [
+                ar.Read(),
+                ar.Read(array_start_idx=[1, 15, 29], count=[5, 100, 61]),
+                ar.Read(
+                    array_start_idx=[6, 200, 150],
+                    count=[3, 100, 120],
+                    array_step=[-1, -1, -1],
+                ),
+                ar.Read(
+                    array_start_idx=[0, 0, 0], count=[4, 50, 40], array_step=[2, 1, 3]
+                ),
+            ]
+
+    got_single_thread = read("1")
+    assert got_single_thread[0] == data.tobytes()
+    assert read("4") == got_single_thread
+
+
+###############################################################################
+# Test that writing tiles from worker threads gives the same result as
+# writing them synchronously
+
+
+@pytest.mark.parametrize("format", ["ZARR_V2", "ZARR_V3"])
+def test_zarr_write_multi_tile_parallel(tmp_vsimem, format):
+
+    dim0_size = 5
+    dim1_size = 230
+    dim2_size = 170
+    data = array.array(
+        "H", [(i * 37) % 65536 for i in range(dim0_size * dim1_size * dim2_size)]
+    )
+
+    def write(num_threads):
+        filename = str(tmp_vsimem / f"test_{num_threads}.zarr")
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            ds = gdal.GetDriverByName("ZARR").CreateMultiDimensional(
+                filename, options=["FORMAT=" + format]
+            )
+            rg = ds.GetRootGroup()
+            dim0 = rg.CreateDimension("dim0", None, None, dim0_size)
+            dim1 = rg.CreateDimension("dim1", None, None, dim1_size)
+            dim2 = rg.CreateDimension("dim2", None, None, dim2_size)
+            ar = rg.CreateMDArray(
+                "test",
+                [dim0, dim1, dim2],
+                gdal.ExtendedDataType.Create(gdal.GDT_UInt16),
+                ["COMPRESS=GZIP", "BLOCKSIZE=2,20,30"],
+            )
+            assert ar.Write(data) == gdal.CE_None
+            # Partial rewrite of tiles that may still be being written
+            assert (
+                ar.Write(
+                    array.array("H", [1] * (3 * 50 * 60)),
+                    array_start_idx=[1, 15, 25],
+                    count=[3, 50, 60],
+                )
+                == gdal.CE_None
+            )
+            # Read back before closing
+            got_before_close = ar.Read()
+            ds = None
+
+        ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER)
+        got = ds.GetRootGroup().OpenMDArray("test").Read()
+        assert got == got_before_close
+        return got
+
+    got_single_thread = write("1")
+    assert got_single_thread != data.tobytes()
+    assert write("4") == got_single_thread
+
+
+###############################################################################
+# Test creating and reading a Zarr V3 array with the sharding_indexed codec
+
+
+@gdaltest.enable_exceptions()
+def test_zarr_create_read_sharding(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test.zarr")
+    dim0_size = 50
+    dim1_size = 70
+    data = array.array("H", [i + 1 for i in range(dim0_size * dim1_size)])
+
+    ds = gdal.GetDriverByName("ZARR").CreateMultiDimensional(
+        filename, options=["FORMAT=ZARR_V3"]
+    )
+    rg = ds.GetRootGroup()
+    dim0 = rg.CreateDimension("dim0", None, None, dim0_size)
+    dim1 = rg.CreateDimension("dim1", None, None, dim1_size)
+    ar = rg.CreateMDArray(
+        "test",
+        [dim0, dim1],
+        gdal.ExtendedDataType.Create(gdal.GDT_UInt16),
+        ["COMPRESS=GZIP", "BLOCKSIZE=10,20", "SHARD_SIZE=20,40"],
+    )
+    assert ar.Write(data) == gdal.CE_None
+    # Only the top-left chunk of the shard is written
+    ar2 = rg.CreateMDArray(
+        "test2",
+        [dim0, dim1],
+        gdal.ExtendedDataType.Create(gdal.GDT_UInt16),
+        ["BLOCKSIZE=10,20", "SHARD_SIZE=20,40"],
+    )
+    assert (
+        ar2.Write(
+            array.array("H", [1] * 200), array_start_idx=[0, 0], count=[10, 20]
+        )
+        == gdal.CE_None
+    )
+    ds = None
+
+    f = gdal.VSIFOpenL(filename + "/test/zarr.json", "rb")
+    assert f
+    data_json = gdal.VSIFReadL(1, 10000, f)
+    gdal.VSIFCloseL(f)
+    j = json.loads(data_json)
+    assert j["chunk_grid"]["configuration"]["chunk_shape"] == [20, 40]
+    assert len(j["codecs"]) == 1
+    assert j["codecs"][0]["name"] == "sharding_indexed"
+    assert j["codecs"][0]["configuration"]["chunk_shape"] == [10, 20]
+    assert j["codecs"][0]["configuration"]["index_location"] == "end"
+    assert [
+        codec["name"] for codec in j["codecs"][0]["configuration"]["index_codecs"]
+    ] == ["endian", "crc32c"]
+
+    # 3 x 2 shards, each one with 2 x 2 inner chunks
+    assert set(gdal.ReadDirRecursive(filename + "/test/c")) == set(
+        ["0/", "0/0", "0/1", "1/", "1/0", "1/1", "2/", "2/0", "2/1"]
+    )
+    assert set(gdal.ReadDirRecursive(filename + "/test2/c")) == set(["0/", "0/0"])
+    # Index of 4 inner chunks followed by its CRC32C
+    assert gdal.VSIStatL(filename + "/test2/c/0/0").size == 200 * 2 + 4 * 16 + 4
+
+    def read(num_threads):
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER)
+            ar = ds.GetRootGroup().OpenMDArray("test")
+            assert ar.GetBlockSize() == [10, 20]
+            return [
+                ar.Read(),
+                ar.Read(array_start_idx=[5, 15], count=[40, 50]),
+                ar.Read(array_start_idx=[49, 69], count=[1, 1]),
+            ]
+
+    got_single_thread = read("1")
+    assert got_single_thread[0] == data.tobytes()
+    assert got_single_thread[2] == array.array("H", [data[-1]]).tobytes()
+    assert read("4") == got_single_thread
+
+    ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER)
+    ar2 = ds.GetRootGroup().OpenMDArray("test2")
+    assert struct.unpack(
+        "H" * 4, ar2.Read(array_start_idx=[9, 19], count=[2, 2])
+    ) == (1, 0, 0, 0)
+    ds = None
+
+    # Update a single chunk of an existing shard
+    ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER | gdal.OF_UPDATE)
+    ar2 = ds.GetRootGroup().OpenMDArray("test2")
+    assert (
+        ar2.Write(
+            array.array("H", [2] * 200), array_start_idx=[10, 20], count=[10, 20]
+        )
+        == gdal.CE_None
+    )
+    ds = None
+
+    ds = gdal.OpenEx(filename, gdal.OF_MULTIDIM_RASTER)
+    ar2 = ds.GetRootGroup().OpenMDArray("test2")
+    assert struct.unpack(
+        "H" * 4, ar2.Read(array_start_idx=[9, 19], count=[2, 2])
+    ) == (1, 0, 0, 2)
+    assert gdal.VSIStatL(filename + "/test2/c/0/0").size == 400 * 2 + 4 * 16 + 4
+
+
 def test_zarr_read_invalid_nczarr_dim():
 
     try:
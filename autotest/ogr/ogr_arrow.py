@@ -33,6 +33,7 @@ import json
 import math
 
 import gdaltest
+import ogrtest
 import pytest
 
 from osgeo import gdal, ogr, osr
@@ -684,3 +685,36 @@ def test_ogr_arrow_write_arrow_fid_in_output_but_not_in_input(tmp_vsimem):
     src_lyr.ResetReading()
     for i in range(src_lyr.GetFeatureCount()):
         assert str(src_lyr.GetNextFeature()) == str(lyr.GetNextFeature())
+
+
+###############################################################################
+# Test that GetArrowStream(GEOMETRY_ENCODING=GEOARROW) defers to the generic
+# implementation and returns GeoArrow geometries, whatever the encoding of
+# the file
+
+
+@pytest.mark.parametrize("encoding", ["WKB", "WKT", "GEOARROW"])
+def test_ogr_arrow_arrow_stream_geoarrow(tmp_vsimem, encoding):
+
+    filename = str(tmp_vsimem / "test.feather")
+    ds = ogr.GetDriverByName("Arrow").CreateDataSource(filename)
+    lyr = ds.CreateLayer(
+        "test",
+        geom_type=ogr.wkbPolygon,
+        options=["GEOMETRY_ENCODING=" + encoding],
+    )
+    lyr.CreateField(ogr.FieldDefn("foo", ogr.OFTString))
+    for wkt in [
+        "POLYGON ((0 0,0 1,1 1,0 0))",
+        None,
+        "POLYGON ((0 0,0 10,10 10,10 0,0 0),(1 1,1 2,2 2,1 1))",
+    ]:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["foo"] = "bar"
+        if wkt:
+            f.SetGeometryDirectly(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+    ds = None
+
+    ds = ogr.Open(filename)
+    ogrtest.check_arrow_stream_geoarrow(ds.GetLayer(0))
@@ -1152,3 +1152,52 @@ def test_geom_use_after_transfer_to_feature(tmp_vsimem, arg_type):
 
     with pytest.raises(Exception):
         point.ExportToWkt()
+
+
+###############################################################################
+# Test spatial filtering with non-rectangular and multi-part filters, which
+# use shortcuts based on the envelope of the features
+
+
+@pytest.mark.require_geos
+@pytest.mark.parametrize(
+    "filter_wkt",
+    [
+        "POLYGON ((0 0,0 10,10 10,10 8,2 8,2 2,10 2,10 0,0 0))",
+        "MULTIPOLYGON (((0 0,0 3,3 3,3 0,0 0)),((7 7,7 10,10 10,10 7,7 7)),"
+        + "((5 0,9 4,9 0,5 0)))",
+        "GEOMETRYCOLLECTION (POINT (5 5),LINESTRING (0 10,10 0))",
+    ],
+)
+def test_ogr_basic_spatial_filter_non_rectangular(filter_wkt):
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = ds.CreateLayer("test")
+    geoms = []
+    for i in range(11):
+        for j in range(11):
+            geoms.append(f"POINT ({i} {j})")
+            geoms.append(f"LINESTRING ({i} {j},{i + 0.5} {j + 0.5})")
+            geoms.append(
+                f"POLYGON (({i} {j},{i} {j + 0.4},{i + 0.4} {j + 0.4},{i} {j}))"
+            )
+    for wkt in geoms:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+
+    filter_geom = ogr.CreateGeometryFromWkt(filter_wkt)
+    expected = [
+        i
+        for i, wkt in enumerate(geoms)
+        if ogr.CreateGeometryFromWkt(wkt).Intersects(filter_geom)
+    ]
+    assert expected
+
+    lyr.SetSpatialFilter(filter_geom)
+    assert [f.GetFID() for f in lyr] == expected
+    # Also check that a change of filter resets its acceleration structures
+    lyr.SetSpatialFilterRect(0.1, 0.1, 0.9, 0.9)
+    assert lyr.GetFeatureCount() == 2
+    lyr.SetSpatialFilter(filter_geom)
+    assert lyr.GetFeatureCount() == len(expected)
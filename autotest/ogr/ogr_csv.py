@@ -2985,6 +2985,170 @@ def test_ogr_csv_getextent3d(tmp_vsimem):
     assert ext3d == (1.0, 2.0, 1.0, 2.0, 1.0, 1.0)
 
 
+###############################################################################
+# Test OGR_FILTER_NUM_THREADS
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4", "ALL_CPUS"])
+def test_ogr_csv_parallel_filter(tmp_vsimem, num_threads):
+
+    filename = tmp_vsimem / "test.csv"
+    with gdal.VSIFile(filename, "wb") as f:
+        f.write(b"id,val,WKT\n")
+        for i in range(5000):
+            f.write(b"%d,%d,\"POINT (%d %d)\"\n" % (i, i % 17, i % 100, i // 100))
+
+    def get_ids(attr_filter, spat_filter):
+        ds = ogr.Open(filename)
+        lyr = ds.GetLayer(0)
+        lyr.SetAttributeFilter(attr_filter)
+        if spat_filter:
+            lyr.SetSpatialFilterRect(*spat_filter)
+        ret = [f["id"] for f in lyr]
+        # Check that ResetReading() restarts from the beginning
+        lyr.ResetReading()
+        assert [f["id"] for f in lyr] == ret
+        return ret
+
+    for attr_filter, spat_filter in [
+        ("val = 3", None),
+        (None, (10.5, 5.5, 20.5, 30.5)),
+        ("val < 8", (10.5, 5.5, 70.5, 30.5)),
+    ]:
+        expected = get_ids(attr_filter, spat_filter)
+        assert expected
+        with gdal.config_option("OGR_FILTER_NUM_THREADS", num_threads):
+            assert get_ids(attr_filter, spat_filter) == expected
+
+
+###############################################################################
+# Test OGR_CSV_NUM_THREADS
+
+
+@pytest.mark.parametrize("num_threads", ["4", "ALL_CPUS"])
+def test_ogr_csv_num_threads(tmp_vsimem, num_threads):
+
+    filename = tmp_vsimem / "test.csv"
+    gdal.FileFromMemBuffer(tmp_vsimem / "test.csvt", "Integer,Integer,String,WKT")
+    with gdal.VSIFile(filename, "wb") as f:
+        f.write(b"id,val,str,WKT\n")
+        for i in range(5000):
+            if i % 1000 == 10:
+                f.write(b"\n")
+            val = b"%d" % (i % 17)
+            if i == 2345:
+                val = b"invalid"
+            s = b'"multi\nline ""%d"""' % i if i % 7 == 0 else b"s%d" % i
+            f.write(
+                b'%d,%s,%s,"POINT (%d %d)"\n' % (i, val, s, i % 100, i // 100)
+            )
+
+    def to_tuple(f):
+        wkt = f.GetGeometryRef().ExportToWkt()
+        return (f.GetFID(), f["id"], f["val"], f["str"], wkt)
+
+    def get_features():
+        ret = []
+        with gdal.quiet_errors():
+            ds = ogr.Open(filename)
+            lyr = ds.GetLayer(0)
+            gdal.ErrorReset()
+            ret.append([to_tuple(f) for f in lyr])
+            ret.append(gdal.GetLastErrorMsg())
+        lyr.SetAttributeFilter("val = 3")
+        lyr.SetSpatialFilterRect(10.5, 5.5, 70.5, 30.5)
+        ret.append([f.GetFID() for f in lyr])
+        lyr.SetAttributeFilter(None)
+        lyr.SetSpatialFilter(None)
+        lyr.ResetReading()
+        for _ in range(100):
+            lyr.GetNextFeature()
+        ret.append(lyr.GetFeature(1500).GetField("id"))
+        ret.append(lyr.GetNextFeature().GetFID())
+        return ret
+
+    expected = get_features()
+    assert len(expected[0]) == 5000
+    assert expected[0][2345][2] is None
+    assert "record 2346" in expected[1]
+    assert expected[3] == 1499
+    with gdal.config_option("OGR_CSV_NUM_THREADS", num_threads):
+        assert get_features() == expected
+
+
+###############################################################################
+# Test the seek index used by GetFeature(), SetNextByIndex() and
+# GetFeatureCount(), and its sidecar file
+
+
+def test_ogr_csv_seek_index(tmp_vsimem):
+
+    filename = tmp_vsimem / "test.csv"
+    with gdal.VSIFile(filename, "wb") as f:
+        f.write(b"id,str\n")
+        for i in range(5000):
+            if i % 1500 == 0:
+                f.write(b"\n")
+            s = b'"multi\nline %d"' % i if i % 7 == 0 else b"s%d" % i
+            f.write(b"%d,%s\n" % (i, s))
+
+    def check(ds):
+        lyr = ds.GetLayer(0)
+        for fid in (4000, 1, 1025, 1024, 5000, 2049, 3):
+            f = lyr.GetFeature(fid)
+            assert f.GetFID() == fid
+            assert f["id"] == fid - 1
+        assert lyr.GetFeature(5001) is None
+        assert lyr.GetFeature(0) is None
+        assert lyr.SetNextByIndex(2996) == ogr.OGRERR_NONE
+        f = lyr.GetNextFeature()
+        assert f.GetFID() == 2997
+        assert f["str"] == "multi\nline 2996"
+        assert lyr.SetNextByIndex(5000) == ogr.OGRERR_NONE
+        assert lyr.GetNextFeature() is None
+        assert lyr.SetNextByIndex(5001) != ogr.OGRERR_NONE
+        assert lyr.TestCapability(ogr.OLCFastFeatureCount)
+        assert lyr.TestCapability(ogr.OLCFastSetNextByIndex)
+        assert lyr.GetFeatureCount() == 5000
+        lyr.SetAttributeFilter("id >= 10")
+        assert not lyr.TestCapability(ogr.OLCFastSetNextByIndex)
+        assert lyr.SetNextByIndex(5) == ogr.OGRERR_NONE
+        assert lyr.GetNextFeature()["id"] == 15
+        lyr.SetAttributeFilter(None)
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    assert not lyr.TestCapability(ogr.OLCFastFeatureCount)
+    check(ds)
+    ds = None
+    assert gdal.VSIStatL(str(filename) + ".csvidx") is None
+
+    with gdal.config_option("OGR_CSV_NUM_THREADS", "4"):
+        ds = ogr.Open(filename)
+        assert len([f for f in ds.GetLayer(0)]) == 5000
+        check(ds)
+        ds = None
+
+    ds = gdal.OpenEx(filename, open_options=["SIDECAR_SEEK_INDEX=YES"])
+    assert not ds.GetLayer(0).TestCapability(ogr.OLCFastFeatureCount)
+    assert ds.GetLayer(0).GetFeatureCount() == 5000
+    ds = None
+    assert gdal.VSIStatL(str(filename) + ".csvidx") is not None
+
+    ds = gdal.OpenEx(filename, open_options=["SIDECAR_SEEK_INDEX=YES"])
+    assert ds.GetLayer(0).TestCapability(ogr.OLCFastFeatureCount)
+    check(ds)
+    ds = None
+
+    # Modify the file: the sidecar index must be detected as outdated
+    with gdal.VSIFile(filename, "ab") as f:
+        f.write(b"5000,s5000\n")
+    ds = gdal.OpenEx(filename, open_options=["SIDECAR_SEEK_INDEX=YES"])
+    assert not ds.GetLayer(0).TestCapability(ogr.OLCFastFeatureCount)
+    assert ds.GetLayer(0).GetFeatureCount() == 5001
+    ds = None
+
+
 ###############################################################################
 
 
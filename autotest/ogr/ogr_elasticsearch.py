@@ -35,6 +35,7 @@ import time
 import gdaltest
 import ogrtest
 import pytest
+import webserver
 
 from osgeo import gdal, ogr, osr
 
@@ -3484,3 +3485,177 @@ def test_ogr_elasticsearch_upsert_feature(es_url, handle_get, handle_post):
     assert gdal.GetLastErrorMsg() == ""
 
     ds = None
+
+
+###############################################################################
+# Fake server for the tests of MAX_CONNECTIONS, which serves the documents
+# of a "test" index by scroll batches, optionally split in slices, and
+# records the documents received by _bulk requests
+
+
+class _ESMaxConnectionsHandler:
+    def __init__(self, num_docs=0, failing_bulk_val=None):
+        self.docs = [{"val": i} for i in range(num_docs)]
+        self.failing_bulk_val = failing_bulk_val
+        self.slices = set()
+        self.bulk_requests = 0
+        self.bulk_vals = []
+
+    def final_check(self):
+        pass
+
+    def _send(self, request, content, code=200):
+        data = content.encode("utf-8")
+        request.send_response(code)
+        request.send_header("Content-Type", "application/json")
+        request.send_header("Content-Length", len(data))
+        request.end_headers()
+        request.wfile.write(data)
+
+    def _send_batch(self, request, slice_id, max_slices, offset, size):
+        docs = [d for d in self.docs if d["val"] % max_slices == slice_id]
+        hits = [
+            {"_index": "test", "_id": str(d["val"]), "_source": d}
+            for d in docs[offset : offset + size]
+        ]
+        scroll_id = "%d_%d_%d_%d" % (slice_id, max_slices, offset + size, size)
+        self._send(
+            request, json.dumps({"_scroll_id": scroll_id, "hits": {"hits": hits}})
+        )
+
+    def do_HEAD(self, request):
+        self._send(request, "", 404)
+
+    def do_GET(self, request, body=None):
+        path, _, query = request.path.partition("?")
+        query = dict(x.split("=", 1) for x in query.split("&") if "=" in x)
+        if path == "/fakeelasticsearch":
+            self._send(request, '{"version":{"number":"6.8.0"}}')
+        elif path == "/fakeelasticsearch/_cat/indices":
+            self._send(request, "test\n")
+        elif path == "/fakeelasticsearch/test/_mapping":
+            self._send(
+                request,
+                json.dumps(
+                    {
+                        "test": {
+                            "mappings": {
+                                "FeatureCollection": {
+                                    "properties": {"val": {"type": "integer"}}
+                                }
+                            }
+                        }
+                    }
+                ),
+            )
+        elif path == "/fakeelasticsearch/test/FeatureCollection/_search":
+            query_slice = json.loads(body or "{}").get("slice", {"id": 0, "max": 1})
+            self.slices.add((query_slice["id"], query_slice["max"]))
+            self._send_batch(
+                request, query_slice["id"], query_slice["max"], 0, int(query["size"])
+            )
+        elif path == "/fakeelasticsearch/_search/scroll":
+            self._send_batch(request, *[int(x) for x in query["scroll_id"].split("_")])
+        elif path == "/fakeelasticsearch/test":
+            self._send(request, "{}")
+        else:
+            self._send(request, "{}", 404)
+
+    def do_POST(self, request):
+        body = request.rfile.read(int(request.headers["Content-Length"]))
+        body = body.decode("utf-8")
+        path = request.path.partition("?")[0]
+        if path == "/fakeelasticsearch/_bulk":
+            self.bulk_requests += 1
+            vals = []
+            for line in body.split("\n"):
+                if line.strip():
+                    doc = json.loads(line)
+                    if "index" not in doc:
+                        vals.append(doc.get("properties", doc)["val"])
+            self.bulk_vals += vals
+            if self.failing_bulk_val in vals:
+                self._send(request, '{"took":1,"errors":true,"items":[]}')
+            else:
+                self._send(request, '{"took":1,"errors":false,"items":[]}')
+        elif path == "/fakeelasticsearch/test/_mapping/FeatureCollection":
+            self._send(request, "{}")
+        else:
+            self.do_GET(request, body)
+
+    def do_PUT(self, request):
+        self._send(request, "{}")
+
+    def do_DELETE(self, request):
+        self._send(request, "{}")
+
+
+###############################################################################
+# Test reading with a sliced scroll
+
+
+@pytest.mark.parametrize("max_connections", ["1", "3"])
+def test_ogr_elasticsearch_sliced_scroll(server, es_url, max_connections):
+
+    handler = _ESMaxConnectionsHandler(num_docs=50)
+    with webserver.install_http_handler(handler):
+        ds = gdal.OpenEx(
+            f"ES:{es_url}/fakeelasticsearch",
+            open_options=["BATCH_SIZE=4", "MAX_CONNECTIONS=" + max_connections],
+        )
+        lyr = ds.GetLayerByName("test")
+        for _ in range(2):
+            vals = [f["val"] for f in lyr]
+            assert sorted(vals) == list(range(50))
+        ds = None
+
+    if max_connections == "1":
+        assert handler.slices == {(0, 1)}
+    else:
+        assert handler.slices == {(0, 3), (1, 3), (2, 3)}
+
+
+###############################################################################
+# Test pipelined _bulk requests
+
+
+@pytest.mark.parametrize("max_connections", ["1", "3"])
+@pytest.mark.parametrize("failing_bulk_val", [None, 25])
+def test_ogr_elasticsearch_pipelined_bulk(
+    server, es_url, max_connections, failing_bulk_val
+):
+
+    handler = _ESMaxConnectionsHandler(failing_bulk_val=failing_bulk_val)
+    with webserver.install_http_handler(handler), gdal.config_option(
+        "ES_MAX_CONNECTIONS", max_connections
+    ):
+        ds = ogrtest.elasticsearch_drv.CreateDataSource(f"{es_url}/fakeelasticsearch")
+        lyr = ds.CreateLayer(
+            "test",
+            srs=ogrtest.srs_wgs84,
+            options=[
+                'MAPPING={ "FeatureCollection": { "properties": {} }}',
+                "BULK_SIZE=200",
+            ],
+        )
+        lyr.CreateField(ogr.FieldDefn("val", ogr.OFTInteger))
+
+        gdal.ErrorReset()
+        ret = []
+        with gdal.quiet_errors():
+            for i in range(50):
+                f = ogr.Feature(lyr.GetLayerDefn())
+                f["val"] = i
+                ret.append(lyr.CreateFeature(f))
+            ret.append(lyr.SyncToDisk())
+            error_msg = gdal.GetLastErrorMsg()
+        ds = None
+
+    assert sorted(handler.bulk_vals) == list(range(50))
+    assert handler.bulk_requests > 3
+    if failing_bulk_val is None:
+        assert set(ret) == {ogr.OGRERR_NONE}
+        assert error_msg == ""
+    else:
+        assert ogr.OGRERR_FAILURE in ret
+        assert '"errors":true' in error_msg
@@ -1171,6 +1171,84 @@ def test_ogr_flatgeobuf_arrow_stream_empty_file():
     ogr.GetDriverByName("FlatGeobuf").DeleteDataSource("/vsimem/test.fgb")
 
 
+###############################################################################
+# Test that the WKB geometries returned by GetArrowStream() are the same as
+# the ones of the feature API, including the ones directly encoded from the
+# FlatGeobuf buffers.
+
+
+@pytest.mark.parametrize(
+    "geom_type,wkts",
+    [
+        (ogr.wkbPoint, ["POINT (1 2)", "POINT (3 4)"]),
+        (ogr.wkbPoint25D, ["POINT Z (1 2 3)"]),
+        (ogr.wkbPointM, ["POINT M (1 2 4)"]),
+        (ogr.wkbPointZM, ["POINT ZM (1 2 3 4)"]),
+        (ogr.wkbMultiPoint, ["MULTIPOINT ((1 2),(3 4))", "MULTIPOINT EMPTY"]),
+        (ogr.wkbLineString, ["LINESTRING (1 2,3 4)", "LINESTRING EMPTY"]),
+        (ogr.wkbLineStringZM, ["LINESTRING ZM (1 2 3 4,5 6 7 8)"]),
+        (
+            ogr.wkbMultiLineString,
+            ["MULTILINESTRING ((1 2,3 4),(5 6,7 8,9 10))"],
+        ),
+        (
+            ogr.wkbPolygon,
+            [
+                "POLYGON ((0 0,0 1,1 1,0 0))",
+                "POLYGON ((0 0,0 10,10 10,0 0),(1 1,1 2,2 2,1 1))",
+            ],
+        ),
+        (ogr.wkbPolygon25D, ["POLYGON Z ((0 0 1,0 1 2,1 1 3,0 0 1))"]),
+        (
+            ogr.wkbUnknown,
+            [
+                "POINT (1 2)",
+                "LINESTRING (1 2,3 4)",
+                "MULTIPOLYGON (((0 0,0 1,1 1,0 0)))",
+                "GEOMETRYCOLLECTION (POINT (1 2))",
+            ],
+        ),
+    ],
+)
+def test_ogr_flatgeobuf_arrow_stream_wkb(tmp_vsimem, geom_type, wkts):
+    pytest.importorskip("osgeo.gdal_array")
+    pytest.importorskip("numpy")
+
+    filename = str(tmp_vsimem / "test.fgb")
+    ds = ogr.GetDriverByName("FlatGeobuf").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", geom_type=geom_type)
+    for wkt in wkts:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+    lyr.CreateFeature(ogr.Feature(lyr.GetLayerDefn()))
+    ds = None
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+
+    def get_expected_wkbs():
+        ret = []
+        for f in lyr:
+            g = f.GetGeometryRef()
+            ret.append(g.ExportToIsoWkb() if g else None)
+        return ret
+
+    def get_wkbs():
+        stream = lyr.GetArrowStreamAsNumPy(options=["USE_MASKED_ARRAYS=NO"])
+        return [
+            None if x is None else bytes(x)
+            for batch in stream
+            for x in batch["wkb_geometry"]
+        ]
+
+    assert get_wkbs() == get_expected_wkbs()
+
+    # Spatial filter: geometries built as OGRGeometry
+    lyr.SetSpatialFilterRect(-100, -100, 100, 100)
+    assert get_wkbs() == get_expected_wkbs()
+
+
 def test_ogr_flatgeobuf_issue_7401():
     # Verify null geom handling without spatial index
     ds = ogr.GetDriverByName("FlatGeobuf").CreateDataSource("/vsimem/test.fgb")
@@ -1257,3 +1335,295 @@ def test_ogr_flatgeobuf_title_description_metadata(tmp_vsimem):
         "foo": "bar",
         "bar": "baz",
     }
+
+
+###############################################################################
+# Test writing a file with a spatial index using the external sort
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_ogr_flatgeobuf_spatial_index_external_sort(tmp_vsimem, num_threads):
+
+    nfeatures = 20000
+
+    def create(filename):
+        ds = ogr.GetDriverByName("FlatGeobuf").CreateDataSource(filename)
+        lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+        lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+        for i in range(nfeatures):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f["id"] = i
+            x = (i * 7919) % 1000
+            y = (i * 104729) % 997
+            f.SetGeometry(ogr.CreateGeometryFromWkt(f"POINT ({x} {y})"))
+            lyr.CreateFeature(f)
+        ds = None
+
+    ref_filename = str(tmp_vsimem / "ref.fgb")
+    create(ref_filename)
+
+    filename = str(tmp_vsimem / "test.fgb")
+    # Room for 10000 feature items: several chunks, split in several runs
+    # when using several threads
+    with gdaltest.config_options(
+        {
+            "OGR_FLATGEOBUF_MAX_SORT_MEMORY": str(10000 * 56),
+            "GDAL_NUM_THREADS": num_threads,
+        }
+    ):
+        create(filename)
+
+    assert gdal.VSIStatL(filename).size == gdal.VSIStatL(ref_filename).size
+
+    def read(filename, rect=None):
+        ds = ogr.Open(filename)
+        lyr = ds.GetLayer(0)
+        if rect:
+            lyr.SetSpatialFilterRect(*rect)
+        return sorted(
+            (f["id"], f.GetGeometryRef().ExportToWkt()) for f in lyr
+        ), lyr.GetExtent()
+
+    got, got_extent = read(filename)
+    assert len(got) == nfeatures
+    assert got == read(ref_filename)[0]
+    assert got_extent == (0, 999, 0, 996)
+
+    for rect in [(0, 0, 10, 10), (500, 100, 510, 900), (-10, -10, -1, -1)]:
+        got = read(filename, rect)[0]
+        assert got == read(ref_filename, rect)[0]
+        assert got == [
+            x
+            for x in read(ref_filename)[0]
+            if rect[0] <= ogr.CreateGeometryFromWkt(x[1]).GetX() <= rect[2]
+            and rect[1] <= ogr.CreateGeometryFromWkt(x[1]).GetY() <= rect[3]
+        ]
+
+
+###############################################################################
+# Test batched range reading of spatial index search results
+
+
+@pytest.mark.parametrize("max_gap", [None, "0"])
+def test_ogr_flatgeobuf_spatial_index_multirange_read(tmp_vsimem, max_gap):
+
+    filename = str(tmp_vsimem / "test.fgb")
+    ds = ogr.GetDriverByName("FlatGeobuf").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbLineString)
+    lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    for i in range(5000):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["id"] = i
+        x = (i * 7919) % 1000
+        y = (i * 104729) % 997
+        # Variable number of vertices, to get variable feature sizes
+        coords = ",".join(f"{x + j} {y}" for j in range(1 + i % 7))
+        f.SetGeometry(ogr.CreateGeometryFromWkt(f"LINESTRING ({coords},{x} {y})"))
+        lyr.CreateFeature(f)
+    ds = None
+
+    def read(rect, multirange):
+        options = {"OGR_FLATGEOBUF_MULTIRANGE_READ": multirange}
+        if max_gap:
+            options["OGR_FLATGEOBUF_MULTIRANGE_MAX_GAP"] = max_gap
+        with gdaltest.config_options(options):
+            ds = ogr.Open(filename)
+            lyr = ds.GetLayer(0)
+            lyr.SetSpatialFilterRect(*rect)
+            ret = [
+                (f.GetFID(), f["id"], f.GetGeometryRef().ExportToWkt())
+                for f in lyr
+            ]
+            # Second iteration after implicit ResetReading()
+            assert [f.GetFID() for f in lyr] == [x[0] for x in ret]
+            return ret
+
+    for rect in [
+        (0, 0, 10, 10),
+        (500, 100, 510, 900),
+        (0, 0, 600, 996),
+        (-10, -10, -1, -1),
+    ]:
+        expected = read(rect, "NO")
+        assert expected or rect[0] < 0
+        assert read(rect, "YES") == expected
+
+
+###############################################################################
+# Test that GetArrowStream(GEOMETRY_ENCODING=GEOARROW) defers to the generic
+# implementation and returns GeoArrow geometries
+
+
+def test_ogr_flatgeobuf_arrow_stream_geoarrow(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test.fgb")
+    ds = ogr.GetDriverByName("FlatGeobuf").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPolygon)
+    lyr.CreateField(ogr.FieldDefn("foo", ogr.OFTString))
+    for wkt in [
+        "POLYGON ((0 0,0 1,1 1,0 0))",
+        None,
+        "POLYGON ((0 0,0 10,10 10,10 0,0 0),(1 1,1 2,2 2,1 1))",
+    ]:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["foo"] = "bar"
+        if wkt:
+            f.SetGeometryDirectly(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+    ds = None
+
+    ds = ogr.Open(filename)
+    ogrtest.check_arrow_stream_geoarrow(ds.GetLayer(0))
+
+
+###############################################################################
+# Test the native WriteArrowBatch() implementation, by checking that it
+# creates the same file as CreateFeature()
+
+
+@pytest.mark.parametrize(
+    "spatial_index,wkts",
+    [
+        (
+            "YES",
+            [
+                "POINT (1 2)",
+                "LINESTRING (0 0,10 20)",
+                "LINESTRING (1 1,2 2,3 3)",
+                "POLYGON ((0 0,0 1,1 1,0 0))",
+                "LINESTRING (5 5,6 6)",
+            ],
+        ),
+        (
+            "NO",
+            [
+                "POINT (1 2)",
+                None,
+                "XDR:LINESTRING Z (0 0 1,10 20 3)",
+                "CIRCULARSTRING (0 0,1 1,2 0)",
+                "GEOMETRYCOLLECTION (POINT (30 40),LINESTRING (1 2,3 4))",
+            ],
+        ),
+    ],
+    ids=["linear", "null_curve_xdr"],
+)
+def test_ogr_flatgeobuf_write_arrow_native(tmp_vsimem, spatial_index, wkts):
+    pa = pytest.importorskip("pyarrow")
+
+    # "XDR:" prefixed geometries are encoded as big-endian WKB
+    def to_wkb(wkt):
+        if wkt is None:
+            return None
+        if wkt.startswith("XDR:"):
+            return ogr.CreateGeometryFromWkt(wkt[4:]).ExportToIsoWkb(ogr.wkbXDR)
+        return ogr.CreateGeometryFromWkt(wkt).ExportToIsoWkb()
+
+    wkbs = [to_wkb(wkt) for wkt in wkts]
+    fields = [
+        ("bool", ogr.OFTInteger, ogr.OFSTBoolean, pa.bool_()),
+        ("int16", ogr.OFTInteger, ogr.OFSTInt16, pa.int16()),
+        ("int32", ogr.OFTInteger, ogr.OFSTNone, pa.int32()),
+        ("int64", ogr.OFTInteger64, ogr.OFSTNone, pa.int64()),
+        ("float32", ogr.OFTReal, ogr.OFSTFloat32, pa.float32()),
+        ("float64", ogr.OFTReal, ogr.OFSTNone, pa.float64()),
+        ("str", ogr.OFTString, ogr.OFSTNone, pa.string()),
+        ("bin", ogr.OFTBinary, ogr.OFSTNone, pa.binary()),
+    ]
+    values = {
+        "bool": [True, None, False, True, False],
+        "int16": [-32768, None, 0, 1, 32767],
+        "int32": [-2147483648, None, 0, 1, 2147483647],
+        "int64": [-(1 << 63), None, 0, 1, (1 << 63) - 1],
+        "float32": [1.5, None, 0.0, -2.5, 3.25],
+        "float64": [1.25, None, 0.0, -1e300, 1e300],
+        "str": ["foo", None, "", "été", "bar"],
+        "bin": [b"\x00\x01", None, b"", b"\xff", b"x"],
+    }
+
+    def create_layer(filename):
+        ds = ogr.GetDriverByName("FlatGeobuf").CreateDataSource(filename)
+        lyr = ds.CreateLayer(
+            "test",
+            geom_type=ogr.wkbUnknown,
+            options=["SPATIAL_INDEX=" + spatial_index],
+        )
+        for name, field_type, field_subtype, _ in fields:
+            fld_defn = ogr.FieldDefn(name, field_type)
+            fld_defn.SetSubType(field_subtype)
+            lyr.CreateField(fld_defn)
+        return ds, lyr
+
+    filename = str(tmp_vsimem / "native.fgb")
+    ds, lyr = create_layer(filename)
+    assert lyr.TestCapability(ogr.OLCFastWriteArrowBatch)
+    table = pa.table(
+        [pa.array(values[name], type=pa_type) for name, _, _, pa_type in fields]
+        + [pa.array(wkbs, type=pa.binary())],
+        names=[x[0] for x in fields] + ["wkb_geometry"],
+    )
+    assert lyr.WritePyArrow(table) == ogr.OGRERR_NONE
+    ds = None
+
+    ref_filename = str(tmp_vsimem / "ref.fgb")
+    ds, lyr = create_layer(ref_filename)
+    for i, wkb in enumerate(wkbs):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        for name, field_type, _, _ in fields:
+            if values[name][i] is None:
+                continue
+            if field_type == ogr.OFTBinary:
+                f.SetFieldBinaryFromHexString(name, values[name][i].hex())
+            else:
+                f[name] = values[name][i]
+        if wkb:
+            f.SetGeometryDirectly(ogr.CreateGeometryFromWkb(wkb))
+        assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+    ds = None
+
+    def read_file(filename):
+        f = gdal.VSIFOpenL(filename, "rb")
+        assert f
+        try:
+            return gdal.VSIFReadL(1, gdal.VSIStatL(filename).size, f)
+        finally:
+            gdal.VSIFCloseL(f)
+
+    assert read_file(filename) == read_file(ref_filename)
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    assert lyr.GetFeatureCount() == 5
+    got_wkts = []
+    for f in lyr:
+        assert f["str"] == values["str"][len(got_wkts)]
+        g = f.GetGeometryRef()
+        got_wkts.append(g.ExportToIsoWkt() if g else None)
+    assert got_wkts == [
+        ogr.CreateGeometryFromWkb(wkb).ExportToIsoWkt() if wkb else None
+        for wkb in wkbs
+    ]
+
+
+###############################################################################
+# Test the native WriteArrowBatch() implementation with a geometry not
+# matching the layer geometry type
+
+
+def test_ogr_flatgeobuf_write_arrow_native_geometry_type_mismatch(tmp_vsimem):
+    pa = pytest.importorskip("pyarrow")
+
+    filename = str(tmp_vsimem / "test.fgb")
+    ds = ogr.GetDriverByName("FlatGeobuf").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+    wkts = ["POINT (1 2)", "LINESTRING (1 2,3 4)"]
+    table = pa.table(
+        [
+            pa.array(
+                [ogr.CreateGeometryFromWkt(wkt).ExportToIsoWkb() for wkt in wkts],
+                type=pa.binary(),
+            )
+        ],
+        names=["wkb_geometry"],
+    )
+    with pytest.raises(Exception, match="Mismatched geometry type"):
+        lyr.WritePyArrow(table)
@@ -5056,3 +5056,52 @@ def test_ogr_json_getextent3d(tmp_vsimem):
 
     assert lyr.GetExtent() == (3.0, 6.0, 4.0, 7.0)
     assert lyr.GetExtent3D() == (3.0, 6.0, 4.0, 7.0, 2.0, 5.0)
+
+
+###############################################################################
+# Test spatial filtering through the spatial index
+
+
+@pytest.mark.parametrize("with_id", [False, True])
+def test_ogr_geojson_spatial_index(tmp_vsimem, with_id):
+
+    filename = str(tmp_vsimem / "test_ogr_geojson_spatial_index.json")
+    features = []
+    for i in range(1000):
+        geom = '{"type":"Point","coordinates":[%d,%d]}' % (i % 100, i // 100)
+        if i == 500:
+            geom = "null"
+        id_member = ('"id":%d,' % (2000 - i)) if with_id else ""
+        features.append(
+            '{"type":"Feature",%s"properties":{"i":%d},"geometry":%s}'
+            % (id_member, i, geom)
+        )
+    gdal.FileFromMemBuffer(
+        filename,
+        '{"type":"FeatureCollection","features":[\n' + ",\n".join(features) + "]}",
+    )
+
+    def get_features(ds, minx, miny, maxx, maxy):
+        lyr = ds.GetLayer(0)
+        lyr.SetSpatialFilterRect(minx, miny, maxx, maxy)
+        ret = [(f.GetFID(), f["i"]) for f in lyr]
+        assert lyr.GetFeatureCount() == len(ret)
+        lyr.SetSpatialFilter(None)
+        return ret
+
+    with gdaltest.config_option("OGR_GEOJSON_USE_SPATIAL_INDEX", "NO"):
+        ds = ogr.Open(filename)
+        expected_small = get_features(ds, 9.5, 0.5, 12.5, 2.5)
+        expected_large = get_features(ds, -1, -1, 90, 9)
+        ds = None
+    assert len(expected_small) == 6
+    assert len(expected_large) == 909
+
+    ds = ogr.Open(filename)
+    assert get_features(ds, 9.5, 0.5, 12.5, 2.5) == expected_small
+    assert get_features(ds, -1, -1, 90, 9) == expected_large
+    assert get_features(ds, 1000, 1000, 1001, 1001) == []
+    # Sequential reading still works after having used the index
+    lyr = ds.GetLayer(0)
+    assert lyr.GetFeatureCount() == 1000
+    assert [f["i"] for f in lyr] == list(range(1000))
@@ -396,3 +396,113 @@ def test_ogr_geojsonseq_vsigzip():
     ds = None
 
     gdal.Unlink(filename)
+
+
+###############################################################################
+# Test spatial filtering through the spatial index, and its sidecar file
+
+
+def test_ogr_geojsonseq_spatial_index(tmp_path):
+
+    filename = str(tmp_path / "test_ogr_geojsonseq_spatial_index.geojsonl")
+    with open(filename, "wt") as f:
+        for i in range(1000):
+            geom = '{"type":"Point","coordinates":[%d,%d]}' % (i % 100, i // 100)
+            if i == 500:
+                geom = "null"
+            f.write(
+                '{"type":"Feature","properties":{"i":%d},"geometry":%s}\n' % (i, geom)
+            )
+
+    def get_features(ds, minx, miny, maxx, maxy):
+        lyr = ds.GetLayer(0)
+        lyr.SetSpatialFilterRect(minx, miny, maxx, maxy)
+        ret = [(f.GetFID(), f["i"]) for f in lyr]
+        assert lyr.GetFeatureCount() == len(ret)
+        lyr.SetSpatialFilter(None)
+        return ret
+
+    with gdaltest.config_option("OGR_GEOJSON_USE_SPATIAL_INDEX", "NO"):
+        ds = ogr.Open(filename)
+        expected_small = get_features(ds, 9.5, 0.5, 12.5, 2.5)
+        expected_large = get_features(ds, -1, -1, 90, 9)
+        ds = None
+    assert len(expected_small) == 6
+    assert len(expected_large) == 909
+
+    ds = ogr.Open(filename)
+    assert get_features(ds, 9.5, 0.5, 12.5, 2.5) == expected_small
+    assert get_features(ds, -1, -1, 90, 9) == expected_large
+    lyr = ds.GetLayer(0)
+    assert [f["i"] for f in lyr] == list(range(1000))
+    ds = None
+    assert gdal.VSIStatL(filename + ".gjsidx") is None
+
+    for i in range(2):
+        ds = gdal.OpenEx(filename, open_options=["SIDECAR_SPATIAL_INDEX=YES"])
+        assert get_features(ds, 9.5, 0.5, 12.5, 2.5) == expected_small
+        ds = None
+        assert gdal.VSIStatL(filename + ".gjsidx") is not None
+
+    # Modify the file: the sidecar index must be detected as outdated
+    with open(filename, "at") as f:
+        f.write(
+            '{"type":"Feature","properties":{"i":1000},'
+            '"geometry":{"type":"Point","coordinates":[10,1]}}\n'
+        )
+    ds = gdal.OpenEx(filename, open_options=["SIDECAR_SPATIAL_INDEX=YES"])
+    assert get_features(ds, 9.5, 0.5, 12.5, 2.5) == sorted(
+        expected_small + [(1000, 1000)]
+    )
+    ds = None
+
+
+###############################################################################
+# Test parsing features in worker threads
+
+
+@pytest.mark.parametrize("num_threads", ["2", "ALL_CPUS"])
+def test_ogr_geojsonseq_num_threads(tmp_path, num_threads):
+
+    filename = str(tmp_path / "test_ogr_geojsonseq_num_threads.geojsonl")
+    with open(filename, "wt") as f:
+        for i in range(2000):
+            if i == 1234:
+                f.write("invalid\n")
+            elif i == 1500:
+                f.write("\n")
+            elif i % 3 == 0:
+                f.write(
+                    '{"type":"Feature","id":%d,"properties":{"i":%d},'
+                    '"geometry":{"type":"Point","coordinates":[%d,%d]}}\n'
+                    % (10000 + i, i, i % 100, i // 100)
+                )
+            else:
+                f.write(
+                    '{"type":"Feature","properties":{"i":%d},'
+                    '"geometry":{"type":"Point","coordinates":[%d,%d]}}\n'
+                    % (i, i % 100, i // 100)
+                )
+
+    def get_features():
+        ret = []
+        with gdal.quiet_errors():
+            ds = ogr.Open(filename)
+            lyr = ds.GetLayer(0)
+            lyr.GetLayerDefn()
+            gdal.ErrorReset()
+            ret.append([(f.GetFID(), f["i"]) for f in lyr])
+            ret.append(gdal.GetLastErrorMsg())
+            lyr.SetAttributeFilter("i >= 1000")
+            ret.append([(f.GetFID(), f["i"]) for f in lyr])
+            lyr.SetAttributeFilter(None)
+            lyr.SetSpatialFilterRect(9.5, 0.5, 12.5, 15.5)
+            with gdaltest.config_option("OGR_GEOJSON_USE_SPATIAL_INDEX", "NO"):
+                ret.append([(f.GetFID(), f["i"]) for f in lyr])
+        return ret
+
+    expected = get_features()
+    assert len(expected[0]) == 1998
+    assert expected[1] != ""
+    with gdaltest.config_option("OGR_GEOJSONSEQ_NUM_THREADS", num_threads):
+        assert get_features() == expected
@@ -4242,3 +4242,221 @@ def test_ogr_gml_ignore_old_gfs(tmp_path):
         width = defn.GetFieldDefn(1).GetWidth()
 
         assert width == 10
+
+
+###############################################################################
+# Test that building geometries with several threads (GML_NUM_THREADS) gives
+# the same features, in the same order, as single-threaded reading
+
+
+def _ogr_gml_read_all_features(filename, spatial_filter=None):
+    ret = []
+    ds = ogr.Open(filename)
+    assert ds is not None
+    for lyr in ds:
+        if spatial_filter:
+            lyr.SetSpatialFilterRect(*spatial_filter)
+        # Read twice to check that ResetReading() discards pending batches
+        for _ in range(2):
+            for f in lyr:
+                g = f.GetGeometryRef()
+                ret.append(
+                    (
+                        lyr.GetName(),
+                        f.GetFID(),
+                        f.GetFieldsAsList(),
+                        g.ExportToIsoWkt() if g else None,
+                    )
+                )
+    return ret
+
+
+def _ogr_gml_write_mixed_geometries(filename, count):
+    wkts = [
+        "POINT ({x} {y})",
+        "LINESTRING ({x} {y},{x1} {y1},{x} {y1})",
+        "POLYGON (({x} {y},{x} {y1},{x1} {y1},{x1} {y},{x} {y}))",
+        "MULTIPOLYGON ((({x} {y},{x} {y1},{x1} {y1},{x} {y})),"
+        "(({x1} {y1},{x1} {y},{x} {y},{x1} {y1})))",
+        "MULTILINESTRING (({x} {y},{x1} {y1}),({x1} {y},{x} {y1}))",
+        None,
+        "GEOMETRYCOLLECTION (POINT ({x} {y}),LINESTRING ({x} {y1},{x1} {y}))",
+    ]
+    ds = ogr.GetDriverByName("GML").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbUnknown)
+    lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    for i in range(count):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["id"] = i
+        wkt = wkts[i % len(wkts)]
+        if wkt:
+            x = i % 50
+            y = i // 50
+            f.SetGeometry(
+                ogr.CreateGeometryFromWkt(
+                    wkt.format(x=x, y=y, x1=x + 0.5, y1=y + 0.5)
+                )
+            )
+        lyr.CreateFeature(f)
+    ds = None
+
+
+@pytest.mark.parametrize(
+    "src_filename",
+    [
+        None,
+        "data/gml/gnis_pop_100.gml",
+        "data/gml/arcgis-world-wfs.gml",
+        "data/gml/testfmegml.gml",
+    ],
+)
+def test_ogr_gml_read_multithreaded_geometries(tmp_path, src_filename):
+
+    if src_filename is None:
+        filename = str(tmp_path / "mixed.gml")
+        _ogr_gml_write_mixed_geometries(filename, 500)
+    else:
+        filename = str(tmp_path / os.path.basename(src_filename))
+        shutil.copy(src_filename, filename)
+        xsd_filename = src_filename[: -len(".gml")] + ".xsd"
+        if os.path.exists(xsd_filename):
+            shutil.copy(xsd_filename, tmp_path)
+
+    with gdal.config_option("GML_NUM_THREADS", "1"):
+        ref = _ogr_gml_read_all_features(filename)
+    assert ref
+
+    for num_threads in ("4", "ALL_CPUS"):
+        with gdal.config_option("GML_NUM_THREADS", num_threads):
+            got = _ogr_gml_read_all_features(filename)
+        assert got == ref, num_threads
+
+    # Compare with a spatial filter covering part of the features
+    ds = ogr.Open(filename)
+    minx, maxx, miny, maxy = ds.GetLayer(0).GetExtent()
+    ds = None
+    spatial_filter = (minx, miny, (minx + maxx) / 2, (miny + maxy) / 2)
+    with gdal.config_option("GML_NUM_THREADS", "1"):
+        ref = _ogr_gml_read_all_features(filename, spatial_filter)
+    with gdal.config_option("GML_NUM_THREADS", "4"):
+        got = _ogr_gml_read_all_features(filename, spatial_filter)
+    assert got == ref
+
+
+###############################################################################
+# Test that the analysis of .xsd schemas is cached, and invalidated when the
+# .xsd file changes
+
+
+_ogr_gml_xsd_cache_gml = """<?xml version="1.0" encoding="utf-8" ?>
+<ogr:FeatureCollection
+     xmlns:xsi="http://www.w3.org/2001/XMLSchema-instance"
+     xsi:schemaLocation="http://ogr.maptools.org/ test.xsd"
+     xmlns:ogr="http://ogr.maptools.org/"
+     xmlns:gml="http://www.opengis.net/gml">
+  <gml:featureMember>
+    <ogr:test fid="test.0">
+      <ogr:geometryProperty><gml:Point><gml:coordinates>1,2</gml:coordinates></gml:Point></ogr:geometryProperty>
+      <ogr:foo>bar</ogr:foo>
+      <ogr:baz>3</ogr:baz>
+    </ogr:test>
+  </gml:featureMember>
+</ogr:FeatureCollection>
+"""
+
+_ogr_gml_xsd_cache_xsd = """<?xml version="1.0" encoding="UTF-8"?>
+<xs:schema targetNamespace="http://ogr.maptools.org/" xmlns:ogr="http://ogr.maptools.org/" xmlns:xs="http://www.w3.org/2001/XMLSchema" xmlns:gml="http://www.opengis.net/gml" elementFormDefault="qualified" version="1.0">
+<xs:import namespace="http://www.opengis.net/gml" schemaLocation="http://schemas.opengis.net/gml/2.1.2/feature.xsd"/>
+<xs:element name="FeatureCollection" type="ogr:FeatureCollectionType" substitutionGroup="gml:_FeatureCollection"/>
+<xs:complexType name="FeatureCollectionType">
+  <xs:complexContent>
+    <xs:extension base="gml:AbstractFeatureCollectionType">
+      <xs:attribute name="lockId" type="xs:string" use="optional"/>
+      <xs:attribute name="scope" type="xs:string" use="optional"/>
+    </xs:extension>
+  </xs:complexContent>
+</xs:complexType>
+<xs:element name="test" type="ogr:test_Type" substitutionGroup="gml:_Feature"/>
+<xs:complexType name="test_Type">
+  <xs:complexContent>
+    <xs:extension base="gml:AbstractFeatureType">
+      <xs:sequence>
+        <xs:element name="geometryProperty" type="gml:PointPropertyType" nillable="true" minOccurs="0" maxOccurs="1"/>
+        <xs:element name="foo" nillable="true" minOccurs="0" maxOccurs="1">
+          <xs:simpleType>
+            <xs:restriction base="xs:string">
+            </xs:restriction>
+          </xs:simpleType>
+        </xs:element>
+%s
+      </xs:sequence>
+    </xs:extension>
+  </xs:complexContent>
+</xs:complexType>
+</xs:schema>
+"""
+
+_ogr_gml_xsd_cache_baz = """        <xs:element name="baz" nillable="true" minOccurs="0" maxOccurs="1">
+          <xs:simpleType>
+            <xs:restriction base="xs:integer">
+            </xs:restriction>
+          </xs:simpleType>
+        </xs:element>"""
+
+
+def _ogr_gml_xsd_cache_read(filename):
+    # Make sure the schema comes from the .xsd and not from a .gfs
+    gfs_filename = filename[: -len(".gml")] + ".gfs"
+    if os.path.exists(gfs_filename):
+        os.unlink(gfs_filename)
+    ds = ogr.Open(filename)
+    assert ds is not None
+    lyr = ds.GetLayer(0)
+    defn = lyr.GetLayerDefn()
+    # gml_id may or may not be exposed depending on the fid attribute
+    fields = [
+        (defn.GetFieldDefn(i).GetName(), defn.GetFieldDefn(i).GetType())
+        for i in range(defn.GetFieldCount())
+        if defn.GetFieldDefn(i).GetName() != "gml_id"
+    ]
+    f = lyr.GetNextFeature()
+    assert f is not None
+    values = [f[name] for name, _ in fields]
+    return fields, values
+
+
+@pytest.mark.parametrize("xsd_cache", ["YES", "NO"])
+def test_ogr_gml_read_xsd_cache(tmp_path, xsd_cache):
+
+    gml_filename = str(tmp_path / "test.gml")
+    xsd_filename = str(tmp_path / "test.xsd")
+    with open(gml_filename, "wt") as f:
+        f.write(_ogr_gml_xsd_cache_gml)
+    with open(xsd_filename, "wt") as f:
+        f.write(_ogr_gml_xsd_cache_xsd % "")
+
+    with gdal.config_option("GML_XSD_CACHE", xsd_cache):
+        fields, values = _ogr_gml_xsd_cache_read(gml_filename)
+        assert fields == [("foo", ogr.OFTString)]
+        assert values == ["bar"]
+
+        # Unchanged .xsd: same result, whether it comes from the cache or not
+        assert _ogr_gml_xsd_cache_read(gml_filename) == (fields, values)
+
+        # Modified .xsd (different size): the new field must be seen
+        with open(xsd_filename, "wt") as f:
+            f.write(_ogr_gml_xsd_cache_xsd % _ogr_gml_xsd_cache_baz)
+        fields, values = _ogr_gml_xsd_cache_read(gml_filename)
+        assert fields == [("foo", ogr.OFTString), ("baz", ogr.OFTInteger)]
+        assert values == ["bar", 3]
+
+        # And again from the (refreshed) cache
+        assert _ogr_gml_xsd_cache_read(gml_filename) == (fields, values)
+
+        # Going back to the initial .xsd
+        with open(xsd_filename, "wt") as f:
+            f.write(_ogr_gml_xsd_cache_xsd % "")
+        assert _ogr_gml_xsd_cache_read(gml_filename) == (
+            [("foo", ogr.OFTString)],
+            ["bar"],
+        )
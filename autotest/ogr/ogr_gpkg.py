@@ -6026,6 +6026,265 @@ def test_ogr_gpkg_deferred_spi_update(tmp_vsimem, gpkg_version):
         ds = None
 
 
+###############################################################################
+# Test dropping the spatial index when appending many features, and rebuilding
+# it in bulk afterwards
+
+
+@pytest.mark.parametrize("commit", [True, False])
+def test_ogr_gpkg_spatial_index_rebuild_on_append(tmp_vsimem, commit):
+    def rtree_count(ds):
+        sql_lyr = ds.ExecuteSQL("SELECT * FROM rtree_test_geom", dialect="DEBUG")
+        res = sql_lyr.GetFeatureCount()
+        ds.ReleaseResultSet(sql_lyr)
+        return res
+
+    def has_spatial_index(ds):
+        sql_lyr = ds.ExecuteSQL("SELECT HasSpatialIndex('test', 'geom')")
+        f = sql_lyr.GetNextFeature()
+        res = f.GetField(0)
+        ds.ReleaseResultSet(sql_lyr)
+        return res == 1
+
+    filename = tmp_vsimem / "test.gpkg"
+    ds = ogr.GetDriverByName("GPKG").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test")
+    for i in range(5):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetGeometryDirectly(ogr.CreateGeometryFromWkt(f"POINT ({i} {i})"))
+        lyr.CreateFeature(f)
+    ds = None
+
+    with gdaltest.config_option("OGR_GPKG_SPATIAL_INDEX_REBUILD_THRESHOLD", "10"):
+        ds = ogr.Open(filename, update=1)
+        lyr = ds.GetLayer(0)
+        ds.StartTransaction()
+        for i in range(5, 25):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f.SetGeometryDirectly(ogr.CreateGeometryFromWkt(f"POINT ({i} {i})"))
+            lyr.CreateFeature(f)
+            if i == 13:
+                assert has_spatial_index(ds)
+            elif i == 14:
+                assert not has_spatial_index(ds)
+        assert lyr.TestCapability(ogr.OLCFastSpatialFilter)
+        if commit:
+            ds.CommitTransaction()
+        else:
+            ds.RollbackTransaction()
+            assert has_spatial_index(ds)
+            assert rtree_count(ds) == 5
+        ds = None
+
+    ds = ogr.Open(filename)
+    assert has_spatial_index(ds)
+    assert rtree_count(ds) == (25 if commit else 5)
+    lyr = ds.GetLayer(0)
+    lyr.SetSpatialFilterRect(1.5, 1.5, 3.5, 3.5)
+    assert [f.GetFID() for f in lyr] == [3, 4]
+    ds = None
+
+
+###############################################################################
+# Test REBUILD SPATIAL INDEX ON
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_ogr_gpkg_rebuild_spatial_index(tmp_vsimem, num_threads):
+
+    filename = tmp_vsimem / "test.gpkg"
+    ds = ogr.GetDriverByName("GPKG").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", options=["SPATIAL_INDEX=NO"])
+    for i in range(1000):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if i % 100 == 0:
+            pass
+        elif i % 100 == 1:
+            f.SetGeometryDirectly(ogr.CreateGeometryFromWkt("POINT EMPTY"))
+        elif i % 2 == 0:
+            f.SetGeometryDirectly(
+                ogr.CreateGeometryFromWkt(f"POINT ({i % 37} {i // 37})")
+            )
+        else:
+            f.SetGeometryDirectly(
+                ogr.CreateGeometryFromWkt(
+                    f"LINESTRING ({i % 37} {i // 37},{i % 37 + 1} {i // 37 + 1})"
+                )
+            )
+        lyr.CreateFeature(f)
+    ds = None
+
+    ds = ogr.Open(filename, update=1)
+    with pytest.raises(Exception, match="Spatial index not existing"):
+        ds.ExecuteSQL("REBUILD SPATIAL INDEX ON test")
+    ds.ExecuteSQL("SELECT CreateSpatialIndex('test', 'geom')")
+    with gdaltest.config_option("OGR_GPKG_NUM_THREADS", num_threads):
+        ds.ExecuteSQL("REBUILD SPATIAL INDEX ON test")
+    ds = None
+
+    ds = ogr.Open(filename)
+    sql_lyr = ds.ExecuteSQL("SELECT COUNT(*) FROM rtree_test_geom")
+    assert sql_lyr.GetNextFeature().GetField(0) == 1000 - 20
+    ds.ReleaseResultSet(sql_lyr)
+
+    lyr = ds.GetLayer(0)
+    lyr.SetSpatialFilterRect(10.5, 10.5, 20.5, 20.5)
+    with_index = set(f.GetFID() for f in lyr)
+    assert with_index
+    ds = None
+
+    ds = ogr.Open(filename)
+    sql_lyr = ds.ExecuteSQL(
+        "SELECT fid FROM test WHERE ST_EnvIntersects(geom, 10.5, 10.5, 20.5, 20.5)"
+    )
+    without_index = set(f.GetField(0) for f in sql_lyr)
+    ds.ReleaseResultSet(sql_lyr)
+    assert with_index == without_index
+
+
+###############################################################################
+# Test OGR_GPKG_WRITE_NUM_THREADS
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_ogr_gpkg_write_num_threads(tmp_vsimem, num_threads):
+
+    filename = tmp_vsimem / "test.gpkg"
+    with gdaltest.config_option("OGR_GPKG_WRITE_NUM_THREADS", num_threads):
+        ds = ogr.GetDriverByName("GPKG").CreateDataSource(filename)
+        lyr = ds.CreateLayer("test")
+        lyr.CreateField(ogr.FieldDefn("val", ogr.OFTInteger))
+
+        ds.StartTransaction()
+        for i in range(2500):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f["val"] = i
+            if i == 1000:
+                f.SetFID(2000)
+            if i % 10 != 0:
+                f.SetGeometryDirectly(
+                    ogr.CreateGeometryFromWkt(f"LINESTRING ({i} 0,{i} 1)")
+                )
+            assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+            assert f.GetFID() == (i + 1 if i < 1000 else i + 1000)
+        assert lyr.GetFeatureCount() == 2500
+        assert lyr.GetFeature(2000)["val"] == 1000
+        for i in range(10):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f["val"] = -1
+            f.SetGeometryDirectly(ogr.CreateGeometryFromWkt("POINT (0 0)"))
+            lyr.CreateFeature(f)
+        ds.CommitTransaction()
+
+        # Rolled back features are not inserted
+        ds.StartTransaction()
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetGeometryDirectly(ogr.CreateGeometryFromWkt("POINT (0 0)"))
+        lyr.CreateFeature(f)
+        assert f.GetFID() == 3510
+        ds.RollbackTransaction()
+        ds = None
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    assert lyr.GetFeatureCount() == 2510
+    assert lyr.GetExtent() == (0, 2499, 0, 1)
+    f = lyr.GetFeature(3499)
+    assert f["val"] == 2499
+    assert f.GetGeometryRef().ExportToWkt() == "LINESTRING (2499 0,2499 1)"
+    assert lyr.GetFeature(1).GetGeometryRef() is None
+    assert lyr.GetFeature(3510) is None
+    lyr.SetSpatialFilterRect(100.5, -1, 101.5, 2)
+    assert [f["val"] for f in lyr] == [101]
+    ds = None
+
+
+def test_ogr_gpkg_write_num_threads_error(tmp_vsimem):
+
+    filename = tmp_vsimem / "test.gpkg"
+    ds = ogr.GetDriverByName("GPKG").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test")
+    f = ogr.Feature(lyr.GetLayerDefn())
+    f.SetGeometryDirectly(ogr.CreateGeometryFromWkt("POINT (0 0)"))
+    lyr.CreateFeature(f)
+
+    with gdaltest.config_option("OGR_GPKG_WRITE_NUM_THREADS", "4"):
+        ds.StartTransaction()
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetGeometryDirectly(ogr.CreateGeometryFromWkt("POINT (1 1)"))
+        lyr.CreateFeature(f)
+        # Duplicated FID: error is only detected when features are inserted
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetFID(1)
+        f.SetGeometryDirectly(ogr.CreateGeometryFromWkt("POINT (2 2)"))
+        lyr.CreateFeature(f)
+        with pytest.raises(Exception):
+            ds.CommitTransaction()
+
+    assert lyr.GetFeatureCount() == 1
+    ds = None
+
+
+###############################################################################
+# Test SHARED_METADATA open option
+
+
+def test_ogr_gpkg_shared_metadata(tmp_vsimem):
+
+    filename = tmp_vsimem / "test.gpkg"
+    ds = ogr.GetDriverByName("GPKG").CreateDataSource(filename)
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(32631)
+    for i in range(3):
+        lyr = ds.CreateLayer(f"test{i}", srs=srs)
+        lyr.CreateField(ogr.FieldDefn("val", ogr.OFTInteger))
+        for j in range(10):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f["val"] = j
+            f.SetGeometryDirectly(ogr.CreateGeometryFromWkt(f"POINT ({j} {i})"))
+            lyr.CreateFeature(f)
+    ds = None
+
+    def open_shared():
+        return gdal.OpenEx(
+            filename, gdal.OF_VECTOR, open_options=["SHARED_METADATA=YES"]
+        )
+
+    ref_ds = open_shared()
+    assert ref_ds.GetLayerCount() == 3
+    assert ref_ds.GetLayer(0).GetSpatialRef().GetAuthorityCode(None) == "32631"
+
+    errors = []
+
+    def worker(i):
+        try:
+            for _ in range(10):
+                ds = open_shared()
+                assert ds.GetLayerCount() == 3
+                lyr = ds.GetLayer(i)
+                assert lyr.GetSpatialRef().GetAuthorityCode(None) == "32631"
+                lyr.SetAttributeFilter("val >= 5")
+                assert [f.GetGeometryRef().GetY() for f in lyr] == [i] * 5
+        except Exception as e:
+            errors.append(e)
+
+    threads = [threading.Thread(target=worker, args=(i,)) for i in range(3)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    assert not errors
+
+    # Modifications of the file are taken into account
+    ds = ogr.Open(filename, update=1)
+    ds.CreateLayer("test3")
+    ds = None
+    ds = open_shared()
+    assert ds.GetLayerCount() == 4
+    ds = None
+    ref_ds = None
+
+
 ###############################################################################
 # Test field domains
 
@@ -8468,6 +8727,45 @@ def test_ogr_gpkg_immutable(tmp_path):
     assert gdal.GetLastErrorMsg() != ""
 
 
+###############################################################################
+# Test reading a read-only database through memory-mapped I/O
+
+
+@pytest.mark.parametrize("use_ogr_vfs", ["YES", "NO"])
+@pytest.mark.parametrize("mmap_size", [None, "0"])
+def test_ogr_gpkg_read_only_mmap(tmp_path, use_ogr_vfs, mmap_size):
+
+    filename = str(tmp_path / "test_ogr_gpkg_read_only_mmap.gpkg")
+    ds = ogr.GetDriverByName("GPKG").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    lyr.StartTransaction()
+    for i in range(1000):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["str"] = "foo%d" % i
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT(%d %d)" % (i, -i)))
+        lyr.CreateFeature(f)
+    lyr.CommitTransaction()
+    ds = None
+
+    with gdaltest.config_options(
+        {"SQLITE_USE_OGR_VFS": use_ogr_vfs, "OGR_SQLITE_MMAP_SIZE": mmap_size}
+    ):
+        ds = ogr.Open(filename)
+        with ds.ExecuteSQL("PRAGMA mmap_size") as sql_lyr:
+            f = sql_lyr.GetNextFeature()
+            if mmap_size == "0":
+                assert f is None or f.GetField(0) == 0
+        lyr = ds.GetLayer(0)
+        assert lyr.GetFeatureCount() == 1000
+        for i, f in enumerate(lyr):
+            assert f["str"] == "foo%d" % i
+            assert f.GetGeometryRef().ExportToWkt() == "POINT (%d %d)" % (i, -i)
+        f = lyr.GetFeature(500)
+        assert f["str"] == "foo499"
+        ds = None
+
+
 ###############################################################################
 
 
@@ -10057,3 +10355,403 @@ def test_ogr_gpkg_creation_with_foreign_key_constraint_enabled(tmp_vsimem):
     with gdaltest.config_option("OGR_SQLITE_PRAGMA", "FOREIGN_KEYS=1"):
         out_filename = str(tmp_vsimem / "out.gpkg")
         gdal.VectorTranslate(out_filename, "data/poly.shp")
+
+
+###############################################################################
+# Test OGR SQL aggregates computed from the Arrow stream of the source layer
+
+
+@gdaltest.enable_exceptions()
+@pytest.mark.parametrize("where", [None, "i >= 0"])
+def test_ogr_gpkg_ogr_sql_summary_arrow_stream(tmp_vsimem, where):
+
+    filename = str(tmp_vsimem / "tmp.gpkg")
+    ds = gdal.GetDriverByName("GPKG").Create(filename, 0, 0, 0, gdal.GDT_Unknown)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+    lyr.CreateField(ogr.FieldDefn("i", ogr.OFTInteger))
+    fld_defn = ogr.FieldDefn("i16", ogr.OFTInteger)
+    fld_defn.SetSubType(ogr.OFSTInt16)
+    lyr.CreateField(fld_defn)
+    lyr.CreateField(ogr.FieldDefn("i64", ogr.OFTInteger64))
+    lyr.CreateField(ogr.FieldDefn("r", ogr.OFTReal))
+    lyr.StartTransaction()
+    for i in range(1000):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["i"] = i - 10
+        if (i % 7) != 0:
+            f["i16"] = -i
+        f["i64"] = 1234567890123 * (i % 13)
+        if (i % 3) != 0:
+            f["r"] = i * 1.25
+        f.SetGeometry(ogr.CreateGeometryFromWkt(f"POINT({i} {i})"))
+        lyr.CreateFeature(f)
+    lyr.CommitTransaction()
+    ds = None
+
+    sql = (
+        "SELECT COUNT(*), COUNT(i16), MIN(i), MAX(i), SUM(i), AVG(i), "
+        "MIN(i16), MAX(i16), SUM(i16), MIN(i64), MAX(i64), SUM(i64), "
+        "COUNT(r), MIN(r), MAX(r), SUM(r), AVG(r) FROM test"
+    )
+    if where:
+        sql += " WHERE " + where
+
+    def get_summary():
+        ds = ogr.Open(filename)
+        with ds.ExecuteSQL(sql, dialect="OGRSQL") as sql_lyr:
+            f = sql_lyr.GetNextFeature()
+            return [f.GetField(i) for i in range(f.GetFieldCount())]
+
+    got = get_summary()
+    with gdaltest.config_option("OGR_SQL_USE_ARROW_STREAM", "NO"):
+        expected = get_summary()
+    assert got == pytest.approx(expected, rel=1e-14)
+    assert got[0] == (990 if where else 1000)
+
+
+###############################################################################
+# Test that deferring the parsing of geometries gives the same results
+
+
+@gdaltest.enable_exceptions()
+def test_ogr_gpkg_lazy_geometry(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "tmp.gpkg")
+    ds = gdal.GetDriverByName("GPKG").Create(filename, 0, 0, 0, gdal.GDT_Unknown)
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(4326)
+    lyr = ds.CreateLayer("test", srs=srs, geom_type=ogr.wkbUnknown)
+    for wkt in [
+        "POINT (1 2)",
+        "LINESTRING (0 0,3 4)",
+        "POLYGON ((0 0,0 10,10 10,10 0,0 0),(1 1,2 1,2 2,1 2,1 1))",
+        "MULTIPOLYGON (((20 20,20 21,21 21,20 20)),((30 30,30 32,32 32,30 30)))",
+        "GEOMETRYCOLLECTION (POINT (5 5),POLYGON ((40 40,40 41,41 41,40 40)))",
+        "CURVEPOLYGON (CIRCULARSTRING (50 50,52 52,50 50))",
+        "POLYGON EMPTY",
+        None,
+    ]:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if wkt:
+            f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+    ds = None
+
+    def get_results():
+        ret = []
+        ds = ogr.Open(filename)
+        lyr = ds.GetLayer(0)
+        for f in lyr:
+            f_clone = f.Clone()
+            g = f.GetGeometryRef()
+            ret.append(g.ExportToIsoWkt() if g else None)
+            if g:
+                assert g.GetSpatialReference().GetAuthorityCode(None) == "4326"
+            assert f_clone.Equal(f)
+        for rect in [(0.5, 0.5, 1.5, 1.5), (1.5, 1.5, 20.5, 20.5), (51, 51, 52, 52)]:
+            lyr.SetSpatialFilterRect(*rect)
+            ret.append([f.GetFID() for f in lyr])
+        lyr.SetSpatialFilter(None)
+        with ds.ExecuteSQL(
+            "SELECT OGR_GEOM_AREA FROM test", dialect="OGRSQL"
+        ) as sql_lyr:
+            ret.append([f.GetField(0) for f in sql_lyr])
+        return ret
+
+    got = get_results()
+    with gdaltest.config_option("OGR_GPKG_LAZY_GEOMETRY", "NO"):
+        expected = get_results()
+    assert got == expected
+    assert got[-1][2] == pytest.approx(99)
+
+
+###############################################################################
+# Test that GetArrowStream(GEOMETRY_ENCODING=GEOARROW) on table and SQL result
+# layers defers to the generic implementation and returns GeoArrow geometries
+
+
+def test_ogr_gpkg_arrow_stream_geoarrow(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test.gpkg")
+    ds = ogr.GetDriverByName("GPKG").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPolygon)
+    lyr.CreateField(ogr.FieldDefn("foo", ogr.OFTString))
+    for wkt in [
+        "POLYGON ((0 0,0 1,1 1,0 0))",
+        None,
+        "POLYGON ((0 0,0 10,10 10,10 0,0 0),(1 1,1 2,2 2,1 1))",
+    ]:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["foo"] = "bar"
+        if wkt:
+            f.SetGeometryDirectly(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+    ds = None
+
+    ds = ogr.Open(filename)
+    ogrtest.check_arrow_stream_geoarrow(ds.GetLayer(0))
+
+    sql_lyr = ds.ExecuteSQL("SELECT * FROM test")
+    try:
+        ogrtest.check_arrow_stream_geoarrow(sql_lyr)
+    finally:
+        ds.ReleaseResultSet(sql_lyr)
+
+
+###############################################################################
+# Test the native WriteArrowBatch() implementation, by comparing its output
+# with the one of CreateFeature()
+
+
+def _gpkg_write_arrow_fields():
+    return [
+        ("bool", ogr.OFTInteger, ogr.OFSTBoolean),
+        ("int16", ogr.OFTInteger, ogr.OFSTInt16),
+        ("int32", ogr.OFTInteger, ogr.OFSTNone),
+        ("int64", ogr.OFTInteger64, ogr.OFSTNone),
+        ("float32", ogr.OFTReal, ogr.OFSTFloat32),
+        ("float64", ogr.OFTReal, ogr.OFSTNone),
+        ("str", ogr.OFTString, ogr.OFSTNone),
+        ("bin", ogr.OFTBinary, ogr.OFSTNone),
+    ]
+
+
+def _gpkg_write_arrow_values():
+    return {
+        "bool": [True, None, False, True, False],
+        "int16": [-32768, None, 0, 1, 32767],
+        "int32": [-2147483648, None, 0, 1, 2147483647],
+        "int64": [-(1 << 63), None, 0, 1, (1 << 63) - 1],
+        "float32": [1.5, None, 0.0, -2.5, 3.25],
+        "float64": [1.25, None, 0.0, -1e300, 1e300],
+        "str": ["foo", None, "", "été", "bar"],
+        "bin": [b"\x00\x01", None, b"", b"\xff", b"x"],
+    }
+
+
+def _gpkg_write_arrow_create_layers(ds, geom_type):
+    lyrs = []
+    for name in ("native", "ref"):
+        lyr = ds.CreateLayer(name, geom_type=geom_type)
+        for field_name, field_type, field_subtype in _gpkg_write_arrow_fields():
+            fld_defn = ogr.FieldDefn(field_name, field_type)
+            fld_defn.SetSubType(field_subtype)
+            lyr.CreateField(fld_defn)
+        lyrs.append(lyr)
+    return lyrs
+
+
+def _gpkg_write_arrow_ref_features(lyr, fids, wkbs):
+    values = _gpkg_write_arrow_values()
+    for i, wkb in enumerate(wkbs):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if fids[i] is not None:
+            f.SetFID(fids[i])
+        for field_name, field_type, _ in _gpkg_write_arrow_fields():
+            val = values[field_name][i % 5]
+            if val is None:
+                continue
+            if field_type == ogr.OFTBinary:
+                f.SetFieldBinaryFromHexString(field_name, val.hex())
+            else:
+                f[field_name] = val
+        if wkb:
+            f.SetGeometryDirectly(ogr.CreateGeometryFromWkb(wkb))
+        assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+
+
+def _gpkg_write_arrow_batch(pa, fids, wkbs):
+    values = _gpkg_write_arrow_values()
+    pa_types = {
+        "bool": pa.bool_(),
+        "int16": pa.int16(),
+        "int32": pa.int32(),
+        "int64": pa.int64(),
+        "float32": pa.float32(),
+        "float64": pa.float64(),
+        "str": pa.string(),
+        "bin": pa.binary(),
+    }
+    fid = pa.array(fids, type=pa.int64())
+    arrays = [fid]
+    names = ["fid"]
+    for field_name, _, _ in _gpkg_write_arrow_fields():
+        arrays.append(
+            pa.array(
+                [values[field_name][i % 5] for i in range(len(wkbs))],
+                type=pa_types[field_name],
+            )
+        )
+        names.append(field_name)
+    arrays.append(pa.array(wkbs, type=pa.binary()))
+    names.append("geom")
+    return fid, pa.table(arrays, names=names)
+
+
+def _gpkg_dump_table(ds, table_name):
+    def sql_rows(sql):
+        sql_lyr = ds.ExecuteSQL(sql)
+        try:
+            return [
+                [f.GetField(i) for i in range(f.GetFieldCount())] for f in sql_lyr
+            ]
+        finally:
+            ds.ReleaseResultSet(sql_lyr)
+
+    columns = ", ".join('"%s"' % x[0] for x in _gpkg_write_arrow_fields())
+    return {
+        "rows": sql_rows(
+            f"SELECT fid AS the_fid, {columns}, hex(geom) AS geom_hex "
+            f'FROM "{table_name}" ORDER BY fid'
+        ),
+        "rtree": sql_rows(
+            f'SELECT id, minx, maxx, miny, maxy FROM "rtree_{table_name}_geom" '
+            "ORDER BY id"
+        ),
+        "contents": sql_rows(
+            "SELECT min_x, min_y, max_x, max_y FROM gpkg_contents "
+            f"WHERE table_name = '{table_name}'"
+        ),
+        "ogr_contents": sql_rows(
+            "SELECT feature_count FROM gpkg_ogr_contents "
+            f"WHERE table_name = '{table_name}'"
+        ),
+        "geometry_columns": sql_rows(
+            "SELECT geometry_type_name, z, m FROM gpkg_geometry_columns "
+            f"WHERE table_name = '{table_name}'"
+        ),
+    }
+
+
+def _gpkg_write_arrow_wkb(wkt):
+    # "XDR:" prefixed geometries are encoded as big-endian WKB
+    if wkt is None:
+        return None
+    if wkt.startswith("XDR:"):
+        return ogr.CreateGeometryFromWkt(wkt[4:]).ExportToIsoWkb(ogr.wkbXDR)
+    return ogr.CreateGeometryFromWkt(wkt).ExportToIsoWkb()
+
+
+@pytest.mark.parametrize(
+    "wkts",
+    [
+        # Linear little-endian geometries, whose GeoPackage blobs are built
+        # directly from the WKB
+        [
+            "POINT (1 2)",
+            None,
+            "LINESTRING Z (0 0 1,10 20 3)",
+            "POLYGON ((0 0,0 1,1 1,0 0))",
+            "MULTIPOINT EMPTY",
+        ],
+        # Geometries going through GPkgGeometryFromOGR()
+        [
+            "CIRCULARSTRING (0 0,1 1,2 0)",
+            "XDR:POINT (1 2)",
+            "XDR:POLYGON Z ((0 0 1,0 -10 2,-5 -10 3,0 0 1))",
+            "GEOMETRYCOLLECTION (POINT (30 40))",
+            "POINT EMPTY",
+        ],
+    ],
+    ids=["linear", "fallback"],
+)
+def test_ogr_gpkg_write_arrow_native(tmp_vsimem, wkts):
+    pa = pytest.importorskip("pyarrow")
+
+    wkbs = [_gpkg_write_arrow_wkb(wkt) for wkt in wkts]
+
+    filename = str(tmp_vsimem / "test.gpkg")
+    ds = ogr.GetDriverByName("GPKG").CreateDataSource(filename)
+    lyr, ref_lyr = _gpkg_write_arrow_create_layers(ds, ogr.wkbUnknown)
+    assert lyr.TestCapability(ogr.OLCFastWriteArrowBatch)
+
+    fids = [1, None, 10, None, 20]
+    fid, table = _gpkg_write_arrow_batch(pa, fids, wkbs)
+    assert lyr.WritePyArrow(table, options=["FID=fid"]) == ogr.OGRERR_NONE
+    # FIDs of features inserted without one are reported in the batch
+    assert fid.to_pylist() == [1, 2, 10, 11, 20]
+
+    _gpkg_write_arrow_ref_features(ref_lyr, fids, wkbs)
+    ds = None
+
+    ds = ogr.Open(filename)
+    got = _gpkg_dump_table(ds, "native")
+    expected = _gpkg_dump_table(ds, "ref")
+    assert got == expected
+    assert [row[0] for row in got["rows"]] == [1, 2, 10, 11, 20]
+    assert got["ogr_contents"] == [[5]]
+    assert len(got["rtree"]) == len(
+        [wkb for wkb in wkbs if wkb and not ogr.CreateGeometryFromWkb(wkb).IsEmpty()]
+    )
+
+    lyr = ds.GetLayerByName("native")
+    assert lyr.GetFeatureCount() == 5
+    assert lyr.GetExtent() == ds.GetLayerByName("ref").GetExtent()
+    f = lyr.GetFeature(1)
+    assert f["str"] == "foo"
+    assert f["int64"] == -(1 << 63)
+    assert f["bin"] == "0001"
+    assert f.GetGeometryRef().ExportToIsoWkb() == ogr.CreateGeometryFromWkb(
+        wkbs[0]
+    ).ExportToIsoWkb()
+    f = lyr.GetFeature(2)
+    for field_name, _, _ in _gpkg_write_arrow_fields():
+        assert f.IsFieldNull(field_name)
+    assert (f.GetGeometryRef() is None) == (wkts[1] is None)
+
+    # Curve geometries register the corresponding extension as
+    # CreateFeature() does
+    extensions = []
+    sql_lyr = ds.ExecuteSQL(
+        "SELECT 1 FROM sqlite_master WHERE name = 'gpkg_extensions'"
+    )
+    has_extensions = sql_lyr.GetFeatureCount() == 1
+    ds.ReleaseResultSet(sql_lyr)
+    if has_extensions:
+        sql_lyr = ds.ExecuteSQL(
+            "SELECT table_name, extension_name FROM gpkg_extensions "
+            "WHERE extension_name LIKE 'gpkg_geom_%' ORDER BY table_name"
+        )
+        extensions = [(f["table_name"], f["extension_name"]) for f in sql_lyr]
+        ds.ReleaseResultSet(sql_lyr)
+    if wkts[0].startswith("CIRCULARSTRING"):
+        assert extensions == [
+            ("native", "gpkg_geom_CIRCULARSTRING"),
+            ("ref", "gpkg_geom_CIRCULARSTRING"),
+        ]
+    else:
+        assert extensions == []
+
+
+###############################################################################
+# Test the native WriteArrowBatch() implementation with geometries not
+# matching the layer geometry type
+
+
+def test_ogr_gpkg_write_arrow_native_geometry_type_mismatch(tmp_vsimem):
+    pa = pytest.importorskip("pyarrow")
+
+    filename = str(tmp_vsimem / "test.gpkg")
+    ds = ogr.GetDriverByName("GPKG").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+    wkts = ["POINT (1 2)", "LINESTRING (1 2,3 4)", "LINESTRING (5 6,7 8)"]
+    table = pa.table(
+        [
+            pa.array(
+                [ogr.CreateGeometryFromWkt(wkt).ExportToIsoWkb() for wkt in wkts],
+                type=pa.binary(),
+            )
+        ],
+        names=["geom"],
+    )
+    gdal.ErrorReset()
+    with gdal.quiet_errors():
+        assert lyr.WritePyArrow(table) == ogr.OGRERR_NONE
+    assert "is not normally allowed" in gdal.GetLastErrorMsg()
+    ds = None
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    assert lyr.GetGeomType() == ogr.wkbPoint
+    assert [f.GetGeometryRef().ExportToWkt() for f in lyr] == wkts
+    assert lyr.GetExtent() == (1, 7, 2, 8)
@@ -28,6 +28,7 @@
 ###############################################################################
 
 
+import gdaltest
 import ogrtest
 import pytest
 
@@ -481,3 +482,49 @@ def test_ogr_join_23():
     ds.ReleaseResultSet(sql_lyr)
 
     ds = None
+
+
+###############################################################################
+# Test join on integer keys, with and without the in-memory hash table
+
+
+@pytest.mark.parametrize("max_memory", [None, "0", "0.0001"])
+def test_ogr_join_24(max_memory):
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = ds.CreateLayer("first")
+    lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    for i in range(100):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if i != 50:
+            f["id"] = i % 40
+        lyr.CreateFeature(f)
+
+    lyr = ds.CreateLayer("second")
+    lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger64))
+    lyr.CreateField(ogr.FieldDefn("val", ogr.OFTString))
+    for i in range(60):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if i != 5:
+            f["id"] = i % 30
+        f["val"] = "val%d" % i
+        lyr.CreateFeature(f)
+
+    with gdaltest.config_option("OGR_SQL_HASH_JOIN_MAX_MEMORY", max_memory):
+        with ds.ExecuteSQL(
+            "SELECT first.id, second.val FROM first "
+            "LEFT JOIN second ON first.id = second.id"
+        ) as sql_lyr:
+            got = [(f["id"], f["val"]) for f in sql_lyr]
+
+    expected = []
+    for i in range(100):
+        if i == 50:
+            expected.append((None, None))
+        elif i % 40 < 30 and i % 40 != 5:
+            expected.append((i % 40, "val%d" % (i % 40)))
+        elif i % 40 == 5:
+            expected.append((5, "val35"))
+        else:
+            expected.append((i % 40, None))
+    assert got == expected
@@ -31,6 +31,7 @@
 
 
 import json
+import re
 
 import gdaltest
 import ogrtest
@@ -1218,6 +1219,56 @@ def test_ogr_mem_arrow_stream_numpy_huge_string():
     assert [x for x in batch["str"]] == ["X", None, "Y" * (1000 * 1000)]
 
 
+###############################################################################
+# Test the background prefetching of the generic GetArrowStream() implementation
+
+
+@pytest.mark.parametrize("depth", ["0", "1", "3"])
+def test_ogr_mem_arrow_stream_numpy_prefetch(depth):
+    pytest.importorskip("osgeo.gdal_array")
+    pytest.importorskip("numpy")
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = ds.CreateLayer("foo")
+    lyr.CreateField(ogr.FieldDefn("int", ogr.OFTInteger))
+    for i in range(100):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["int"] = i
+        f.SetGeometry(ogr.CreateGeometryFromWkt(f"POINT ({i} {-i})"))
+        lyr.CreateFeature(f)
+    lyr.SetAttributeFilter("int >= 10")
+
+    def get_batches(options):
+        stream = lyr.GetArrowStreamAsNumPy(
+            options=["USE_MASKED_ARRAYS=NO", "MAX_FEATURES_IN_BATCH=7"] + options
+        )
+        return [batch for batch in stream]
+
+    batches = get_batches([f"PREFETCH_DEPTH={depth}"])
+    assert len(batches) == 13
+    assert [x for batch in batches for x in batch["int"]] == list(range(10, 100))
+    assert [
+        ogr.CreateGeometryFromWkb(x).GetX()
+        for batch in batches
+        for x in batch["wkb_geometry"]
+    ] == list(range(10, 100))
+
+    with gdal.config_option("OGR_ARROW_STREAM_PREFETCH_DEPTH", depth):
+        batches = get_batches([])
+    assert [x for batch in batches for x in batch["OGC_FID"]] == list(range(10, 100))
+
+    # Release the stream while the worker thread may still be running
+    stream = lyr.GetArrowStream([f"PREFETCH_DEPTH={depth}", "MAX_FEATURES_IN_BATCH=1"])
+    array = stream.GetNextRecordBatch()
+    assert array.GetLength() == 1
+    del array
+    del stream
+
+    # A new stream restarts from the beginning
+    batches = get_batches([f"PREFETCH_DEPTH={depth}"])
+    assert [x for batch in batches for x in batch["int"]] == list(range(10, 100))
+
+
 ###############################################################################
 
 
@@ -2751,3 +2802,320 @@ def test_ogr_mem_write_pyarrow_invalid_dict_index(dict_values):
         match="Feature 4, field dict_invalid_index: invalid dictionary index: 3",
     ):
         assert lyr.WritePyArrow(table)
+
+
+###############################################################################
+# Test that geometries of existing features are preserved when fields are
+# added, deleted or reordered
+
+
+def test_ogr_mem_alter_fields_keep_geometries():
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = ds.CreateLayer("test")
+    lyr.CreateField(ogr.FieldDefn("a", ogr.OFTString))
+    lyr.CreateField(ogr.FieldDefn("b", ogr.OFTInteger))
+    lyr.CreateGeomField(ogr.GeomFieldDefn("geom2", ogr.wkbPoint))
+    for i in range(3):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["a"] = "val%d" % i
+        f["b"] = i
+        f.SetGeometryDirectly(ogr.CreateGeometryFromWkt("POINT (%d 0)" % i))
+        f.SetGeomFieldDirectly(1, ogr.CreateGeometryFromWkt("POINT (0 %d)" % i))
+        lyr.CreateFeature(f)
+
+    lyr.CreateField(ogr.FieldDefn("c", ogr.OFTReal))
+    lyr.ReorderFields([2, 0, 1])
+    lyr.DeleteField(2)
+
+    lyr.ResetReading()
+    for i, f in enumerate(lyr):
+        assert f["a"] == "val%d" % i
+        assert f.GetGeomFieldRef(0).ExportToWkt() == "POINT (%d 0)" % i
+        assert f.GetGeomFieldRef(1).ExportToWkt() == "POINT (0 %d)" % i
+
+
+###############################################################################
+# Test GEOMETRY_ENCODING=GEOARROW/GEOARROW_INTERLEAVED in GetArrowStream()
+# and WriteArrowBatch()
+
+
+_geoarrow_wkts = {
+    ogr.wkbPoint: ["POINT (1 2)", "POINT (3 4)"],
+    ogr.wkbLineString: ["LINESTRING (1 2,3 4)", "LINESTRING (5 6,7 8,9 10)"],
+    ogr.wkbPolygon: [
+        "POLYGON ((0 0,0 1,1 1,0 0))",
+        "POLYGON ((0 0,0 10,10 10,10 0,0 0),(1 1,1 2,2 2,1 1))",
+    ],
+    ogr.wkbMultiPoint: ["MULTIPOINT ((1 2),(3 4))", "MULTIPOINT ((5 6))"],
+    ogr.wkbMultiLineString: [
+        "MULTILINESTRING ((1 2,3 4),(5 6,7 8))",
+        "MULTILINESTRING ((9 10,11 12))",
+    ],
+    ogr.wkbMultiPolygon: [
+        "MULTIPOLYGON (((0 0,0 1,1 1,0 0)),((10 10,10 11,11 11,10 10)))",
+        "MULTIPOLYGON (((0 0,0 10,10 10,10 0,0 0),(1 1,1 2,2 2,1 1)))",
+    ],
+}
+
+
+def _geoarrow_wkt(wkt, dim):
+    extra = {"XY": "", "XYZ": " 100", "XYM": " 200", "XYZM": " 100 200"}[dim]
+    tag = {"XY": "", "XYZ": " Z", "XYM": " M", "XYZM": " ZM"}[dim]
+    wkt = re.sub(r"(-?[0-9]+ -?[0-9]+)", r"\g<1>" + extra, wkt)
+    return re.sub(r"^([A-Z]+)", r"\g<1>" + tag, wkt)
+
+
+def _geoarrow_geom_type(geom_type, dim):
+    if "Z" in dim:
+        geom_type = ogr.GT_SetZ(geom_type)
+    if "M" in dim:
+        geom_type = ogr.GT_SetM(geom_type)
+    return geom_type
+
+
+def _geoarrow_create_layer(ds, name, geom_type, wkts):
+    lyr = ds.CreateLayer(name, geom_type=geom_type)
+    for wkt in wkts:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if wkt:
+            f.SetGeometryDirectly(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+    return lyr
+
+
+def _geoarrow_round_trip(src_lyr, encoding):
+    """Copy src_lyr into a new Memory layer through GetArrowStream() and
+    WriteArrowBatch(), and return the ISO WKT of the copied geometries
+    together with the length of each batch"""
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    dst_lyr = ds.CreateLayer("dst", geom_type=src_lyr.GetGeomType())
+
+    stream = src_lyr.GetArrowStream(
+        ["INCLUDE_FID=NO", "GEOMETRY_ENCODING=" + encoding]
+    )
+    schema = stream.GetSchema()
+    success, error_msg = dst_lyr.IsArrowSchemaSupported(schema)
+    assert success, error_msg
+
+    batch_lengths = []
+    while True:
+        array = stream.GetNextRecordBatch()
+        if array is None:
+            break
+        batch_lengths.append(array.GetLength())
+        assert dst_lyr.WriteArrowBatch(schema, array) == ogr.OGRERR_NONE
+
+    wkts = []
+    for f in dst_lyr:
+        g = f.GetGeometryRef()
+        wkts.append(g.ExportToIsoWkt() if g else None)
+    return wkts, batch_lengths
+
+
+@pytest.mark.parametrize("encoding", ["GEOARROW", "GEOARROW_INTERLEAVED"])
+@pytest.mark.parametrize("dim", ["XY", "XYZ", "XYM", "XYZM"])
+@pytest.mark.parametrize(
+    "geom_type",
+    list(_geoarrow_wkts.keys()),
+    ids=[ogr.GeometryTypeToName(x) for x in _geoarrow_wkts.keys()],
+)
+def test_ogr_mem_arrow_geoarrow_round_trip(geom_type, dim, encoding):
+
+    wkt1, wkt2 = [_geoarrow_wkt(wkt, dim) for wkt in _geoarrow_wkts[geom_type]]
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    src_lyr = _geoarrow_create_layer(
+        ds, "src", _geoarrow_geom_type(geom_type, dim), [wkt1, None, wkt2]
+    )
+
+    wkts, batch_lengths = _geoarrow_round_trip(src_lyr, encoding)
+    assert wkts == [wkt1, None, wkt2]
+    assert batch_lengths == [3]
+
+
+###############################################################################
+# Test the pyarrow view of a GEOMETRY_ENCODING=GEOARROW stream
+
+
+@pytest.mark.parametrize("encoding", ["GEOARROW", "GEOARROW_INTERLEAVED"])
+def test_ogr_mem_arrow_geoarrow_pyarrow_schema(encoding):
+    pa = pytest.importorskip("pyarrow")
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(32631)
+    lyr = ds.CreateLayer("foo", srs=srs, geom_type=ogr.wkbLineString25D)
+    f = ogr.Feature(lyr.GetLayerDefn())
+    f.SetGeometryDirectly(ogr.CreateGeometryFromWkt("LINESTRING Z (1 2 3,4 5 6)"))
+    lyr.CreateFeature(f)
+
+    stream = lyr.GetArrowStreamAsPyArrow(
+        ["INCLUDE_FID=NO", "GEOMETRY_ENCODING=" + encoding]
+    )
+    field = stream.schema["wkb_geometry"]
+    md = field.metadata
+    assert md[b"ARROW:extension:name"] == b"geoarrow.linestring"
+    metadata = json.loads(md[b"ARROW:extension:metadata"])
+    assert metadata["crs"]["id"] == {"authority": "EPSG", "code": 32631}
+
+    assert pa.types.is_list(field.type)
+    vertices_type = field.type.value_type
+    batches = [batch for batch in stream]
+    assert len(batches) == 1
+    values = batches[0].field("wkb_geometry").to_pylist()
+    if encoding == "GEOARROW":
+        assert pa.types.is_struct(vertices_type)
+        assert [vertices_type[i].name for i in range(3)] == ["x", "y", "z"]
+        assert values == [
+            [{"x": 1.0, "y": 2.0, "z": 3.0}, {"x": 4.0, "y": 5.0, "z": 6.0}]
+        ]
+    else:
+        assert pa.types.is_fixed_size_list(vertices_type)
+        assert vertices_type.list_size == 3
+        assert vertices_type.value_field.name == "xyz"
+        assert values == [[[1.0, 2.0, 3.0], [4.0, 5.0, 6.0]]]
+
+
+###############################################################################
+# Test null and empty geometries with GEOMETRY_ENCODING=GEOARROW
+
+
+@pytest.mark.parametrize("encoding", ["GEOARROW", "GEOARROW_INTERLEAVED"])
+@pytest.mark.parametrize(
+    "geom_type,empty_wkt",
+    [
+        (ogr.wkbPoint, "POINT EMPTY"),
+        (ogr.wkbPoint25D, "POINT Z EMPTY"),
+        (ogr.wkbLineString, "LINESTRING EMPTY"),
+        (ogr.wkbPolygon, "POLYGON EMPTY"),
+        (ogr.wkbMultiPoint, "MULTIPOINT EMPTY"),
+        (ogr.wkbMultiLineString, "MULTILINESTRING EMPTY"),
+        (ogr.wkbMultiPolygon, "MULTIPOLYGON EMPTY"),
+    ],
+)
+def test_ogr_mem_arrow_geoarrow_null_empty(geom_type, empty_wkt, encoding):
+
+    full_wkt = _geoarrow_wkt(
+        _geoarrow_wkts[ogr.GT_Flatten(geom_type)][0],
+        "XYZ" if ogr.GT_HasZ(geom_type) else "XY",
+    )
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    src_lyr = _geoarrow_create_layer(
+        ds, "src", geom_type, [None, empty_wkt, full_wkt, None]
+    )
+
+    wkts, _ = _geoarrow_round_trip(src_lyr, encoding)
+    assert wkts == [None, empty_wkt, full_wkt, None]
+
+
+###############################################################################
+# Test that single part geometries are promoted to the multi type of the
+# layer, and single part collections demoted to its single type
+
+
+@pytest.mark.parametrize(
+    "geom_type,src_wkt,expected_wkt",
+    [
+        (ogr.wkbMultiPoint, "POINT (1 2)", "MULTIPOINT ((1 2))"),
+        (
+            ogr.wkbMultiLineString,
+            "LINESTRING (1 2,3 4)",
+            "MULTILINESTRING ((1 2,3 4))",
+        ),
+        (
+            ogr.wkbMultiPolygon,
+            "POLYGON ((0 0,0 1,1 1,0 0))",
+            "MULTIPOLYGON (((0 0,0 1,1 1,0 0)))",
+        ),
+        (ogr.wkbMultiPolygon, "POLYGON EMPTY", "MULTIPOLYGON EMPTY"),
+        (ogr.wkbPoint, "MULTIPOINT ((1 2))", "POINT (1 2)"),
+        (
+            ogr.wkbPolygon,
+            "MULTIPOLYGON (((0 0,0 1,1 1,0 0)))",
+            "POLYGON ((0 0,0 1,1 1,0 0))",
+        ),
+    ],
+)
+def test_ogr_mem_arrow_geoarrow_promote_demote(geom_type, src_wkt, expected_wkt):
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    src_lyr = _geoarrow_create_layer(ds, "src", geom_type, [src_wkt])
+
+    wkts, _ = _geoarrow_round_trip(src_lyr, "GEOARROW")
+    assert wkts == [expected_wkt]
+
+
+###############################################################################
+# Test geometries that cannot be encoded as the GeoArrow type of the layer
+
+
+@pytest.mark.parametrize(
+    "geom_type,wkt",
+    [
+        (ogr.wkbPoint, "LINESTRING (1 2,3 4)"),
+        (ogr.wkbPolygon, "MULTIPOLYGON (((0 0,0 1,1 1,0 0)),((2 2,2 3,3 3,2 2)))"),
+        (ogr.wkbMultiPoint, "LINESTRING (1 2,3 4)"),
+    ],
+)
+def test_ogr_mem_arrow_geoarrow_geometry_type_mismatch(geom_type, wkt):
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = _geoarrow_create_layer(ds, "src", geom_type, ["", wkt])
+
+    stream = lyr.GetArrowStream(["GEOMETRY_ENCODING=GEOARROW"])
+    with pytest.raises(Exception, match="cannot be encoded in a GeoArrow"):
+        stream.GetNextRecordBatch()
+
+    # GEOMETRY_ENCODING=WKB still works
+    stream = lyr.GetArrowStream(["GEOMETRY_ENCODING=WKB"])
+    assert stream.GetNextRecordBatch().GetLength() == 2
+
+
+###############################################################################
+# Test that layers whose geometry type has no GeoArrow encoding fall back
+# to WKB, and that a GeoArrow column cannot be created as an attribute field
+
+
+def test_ogr_mem_arrow_geoarrow_fallback_wkb():
+    pytest.importorskip("pyarrow")
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = _geoarrow_create_layer(
+        ds, "src", ogr.wkbUnknown, ["GEOMETRYCOLLECTION (POINT (1 2))"]
+    )
+    stream = lyr.GetArrowStreamAsPyArrow(["GEOMETRY_ENCODING=GEOARROW"])
+    md = stream.schema["wkb_geometry"].metadata
+    assert md[b"ARROW:extension:name"] == b"ogc.wkb"
+
+    lyr = _geoarrow_create_layer(ds, "point", ogr.wkbPoint, ["POINT (1 2)"])
+    stream = lyr.GetArrowStream(["GEOMETRY_ENCODING=GEOARROW"])
+    schema = stream.GetSchema()
+    dst_lyr = ds.CreateLayer("dst", geom_type=ogr.wkbNone)
+    for i in range(schema.GetChildrenCount()):
+        if schema.GetChild(i).GetName() == "wkb_geometry":
+            with pytest.raises(Exception, match="is a GeoArrow geometry column"):
+                dst_lyr.CreateFieldFromArrowSchema(schema.GetChild(i))
+
+
+###############################################################################
+# Test that GeoArrow batches are truncated to honour OGR_ARROW_MEM_LIMIT
+
+
+def test_ogr_mem_arrow_geoarrow_memlimit():
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    wkt = "LINESTRING (%s)" % ",".join("%d %d" % (i, i) for i in range(10))
+    src_lyr = _geoarrow_create_layer(ds, "src", ogr.wkbLineString, [wkt] * 3)
+
+    # 2 linestrings of 10 XY points take 2 * 160 + 3 * 4 = 332 bytes, and 3
+    # of them 496 bytes
+    with gdaltest.config_option("OGR_ARROW_MEM_LIMIT", "400", thread_local=False):
+        wkts, batch_lengths = _geoarrow_round_trip(src_lyr, "GEOARROW")
+    assert wkts == [wkt] * 3
+    assert batch_lengths == [2, 1]
+
+    with gdaltest.config_option("OGR_ARROW_MEM_LIMIT", "100", thread_local=False):
+        stream = src_lyr.GetArrowStream(["GEOMETRY_ENCODING=GEOARROW"])
+        with pytest.raises(Exception, match="Too large feature"):
+            stream.GetNextRecordBatch()
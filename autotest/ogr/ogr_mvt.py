@@ -1656,40 +1656,15 @@ def test_ogr_mvt_write_errors():
     assert gdal.GetLastErrorMsg() != ""
     gdal.RmdirRecursive("tmp/tmpmvt")
 
-    # Test failure in writing in temp db (multi-threaded)
+    # Test invalid temporary file in reuse mode
     gdal.RmdirRecursive("/vsimem/foo")
-    with gdaltest.config_option("OGR_MVT_REMOVE_TEMP_FILE", "NO"):
-        ds = ogr.GetDriverByName("MVT").CreateDataSource("/vsimem/foo")
-    temp_ds = ogr.Open("/vsimem/foo.temp.db", update=1)
-    temp_ds.ExecuteSQL("DROP TABLE temp")
-    temp_ds = None
-    gdal.Unlink("/vsimem/foo.temp.db")
-    lyr = ds.CreateLayer("test")
-    f = ogr.Feature(lyr.GetLayerDefn())
-    f.SetGeometry(ogr.CreateGeometryFromWkt("GEOMETRYCOLLECTION(POINT(0 0))"))
-    with gdal.quiet_errors():
-        lyr.CreateFeature(f)
-        ds = None
-    assert gdal.GetLastErrorMsg() != ""
-    gdal.RmdirRecursive("tmp/tmpmvt")
-
-    # Test failure in writing in temp db (single-threaded)
-    gdal.RmdirRecursive("/vsimem/foo")
-    with gdaltest.config_option("OGR_MVT_REMOVE_TEMP_FILE", "NO"):
-        with gdaltest.config_option("GDAL_NUM_THREADS", "1"):
+    gdal.FileFromMemBuffer("/vsimem/foo.temp.db", "invalid")
+    with gdaltest.config_option("OGR_MVT_REUSE_TEMP_FILE", "YES"):
+        with gdal.quiet_errors():
             ds = ogr.GetDriverByName("MVT").CreateDataSource("/vsimem/foo")
-    temp_ds = ogr.Open("/vsimem/foo.temp.db", update=1)
-    temp_ds.ExecuteSQL("DROP TABLE temp")
-    temp_ds = None
+    assert ds is None
+    assert "not a valid temporary file" in gdal.GetLastErrorMsg()
     gdal.Unlink("/vsimem/foo.temp.db")
-    lyr = ds.CreateLayer("test")
-    f = ogr.Feature(lyr.GetLayerDefn())
-    f.SetGeometry(ogr.CreateGeometryFromWkt("GEOMETRYCOLLECTION(POINT(0 0))"))
-    with gdal.quiet_errors():
-        lyr.CreateFeature(f)
-        ds = None
-    assert gdal.GetLastErrorMsg() != ""
-    gdal.RmdirRecursive("tmp/tmpmvt")
 
     # Test reprojection failure
     gdal.RmdirRecursive("/vsimem/foo")
@@ -1740,5 +1715,68 @@ def test_ogr_mvt_write_reuse_temp_db():
     gdal.Unlink("/vsimem/out.temp.db")
 
 
+###############################################################################
+# Test that spilling encoded features to several sorted runs of the temporary
+# file, and encoding tiles in parallel, gives the same output as the default
+
+
+@pytest.mark.require_driver("SQLite")
+@pytest.mark.require_geos
+@pytest.mark.parametrize(
+    "spill_buffer_size,num_threads", [("0.001", "1"), ("0.001", "4"), ("256", "4")]
+)
+def test_ogr_mvt_write_spill_runs(tmp_vsimem, spill_buffer_size, num_threads):
+
+    src_ds = gdal.GetDriverByName("Memory").Create("", 0, 0, 0, gdal.GDT_Unknown)
+    for layer_name in ("layer_b", "layer_a"):
+        lyr = src_ds.CreateLayer(layer_name)
+        lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+        for i in range(200):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f["id"] = i
+            x = -15000000 + (i % 20) * 1500000
+            y = -15000000 + (i // 20) * 3000000
+            f.SetGeometry(
+                ogr.CreateGeometryFromWkt(
+                    f"LINESTRING({x} {y},{x + 1000000} {y + 1000000})"
+                )
+            )
+            lyr.CreateFeature(f)
+
+    ref_filename = str(tmp_vsimem / "ref")
+    with gdaltest.config_option("GDAL_NUM_THREADS", "1"):
+        gdal.VectorTranslate(
+            ref_filename, src_ds, format="MVT", datasetCreationOptions=["MAXZOOM=3"]
+        )
+
+    out_filename = str(tmp_vsimem / "out")
+    with gdaltest.config_options(
+        {
+            "OGR_MVT_SPILL_BUFFER_SIZE": spill_buffer_size,
+            "GDAL_NUM_THREADS": num_threads,
+        }
+    ):
+        gdal.VectorTranslate(
+            out_filename, src_ds, format="MVT", datasetCreationOptions=["MAXZOOM=3"]
+        )
+
+    ref_files = sorted(gdal.ReadDirRecursive(ref_filename))
+    assert "3/" in ref_files
+    assert sorted(gdal.ReadDirRecursive(out_filename)) == ref_files
+    for filename in ref_files:
+        if filename.endswith("/"):
+            continue
+        ref_stat = gdal.VSIStatL(ref_filename + "/" + filename)
+        out_stat = gdal.VSIStatL(out_filename + "/" + filename)
+        assert out_stat.size == ref_stat.size, filename
+        ref_f = gdal.VSIFOpenL(ref_filename + "/" + filename, "rb")
+        ref_data = gdal.VSIFReadL(1, ref_stat.size, ref_f)
+        gdal.VSIFCloseL(ref_f)
+        out_f = gdal.VSIFOpenL(out_filename + "/" + filename, "rb")
+        out_data = gdal.VSIFReadL(1, out_stat.size, out_f)
+        gdal.VSIFCloseL(out_f)
+        assert out_data == ref_data, filename
+
+
 ###############################################################################
 #
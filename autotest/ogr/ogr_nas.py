@@ -29,6 +29,7 @@
 ###############################################################################
 
 import os
+import shutil
 
 import gdaltest
 import ogrtest
@@ -283,3 +284,49 @@ def test_ogr_nas_5():
         os.remove("data/nas/replace_nas.gfs")
     except OSError:
         pass
+
+
+###############################################################################
+# Test that building geometries with several threads (NAS_NUM_THREADS) gives
+# the same features, in the same order, as single-threaded reading
+
+
+def _ogr_nas_read_all_features(filename):
+    ret = []
+    with gdal.config_option("NAS_GFS_TEMPLATE", ""):
+        ds = ogr.Open(filename)
+    assert ds is not None
+    for lyr in ds:
+        # Read twice to check that ResetReading() discards pending batches
+        for _ in range(2):
+            for f in lyr:
+                g = f.GetGeometryRef()
+                ret.append(
+                    (
+                        lyr.GetName(),
+                        f.GetFID(),
+                        f.GetFieldsAsList(),
+                        g.ExportToIsoWkt() if g else None,
+                    )
+                )
+    ds = None
+    gfs_filename = filename[: -len(".xml")] + ".gfs"
+    if os.path.exists(gfs_filename):
+        os.unlink(gfs_filename)
+    return ret
+
+
+@pytest.mark.parametrize("src_filename", ["replace_nas.xml", "delete_nas.xml"])
+def test_ogr_nas_multithreaded_geometries(tmp_path, src_filename):
+
+    filename = str(tmp_path / src_filename)
+    shutil.copy("data/nas/" + src_filename, filename)
+
+    with gdal.config_option("NAS_NUM_THREADS", "1"):
+        ref = _ogr_nas_read_all_features(filename)
+    assert ref
+
+    for num_threads in ("4", "ALL_CPUS"):
+        with gdal.config_option("NAS_NUM_THREADS", num_threads):
+            got = _ogr_nas_read_all_features(filename)
+        assert got == ref, num_threads
@@ -31,6 +31,7 @@
 
 
 import json
+import urllib.parse
 
 import gdaltest
 import pytest
@@ -2094,3 +2095,93 @@ def test_ogr_oapif_initial_request_page_size():
     )
     with webserver.install_http_handler(handler):
         assert lyr.GetLayerDefn().GetFieldCount() == 1
+
+
+###############################################################################
+# Test concurrent prefetching of pages with MAX_CONNECTIONS
+
+
+class _OAPIFPagingHandler:
+    """Serves a collection of features with offset-based next links, which
+    get an additional token parameter from offset token_from"""
+
+    def __init__(self, num_features, number_matched, token_from):
+        self.num_features = num_features
+        self.number_matched = number_matched
+        self.token_from = token_from
+        self.offsets = []
+
+    def final_check(self):
+        pass
+
+    def do_HEAD(self, request):
+        request.send_response(404)
+        request.end_headers()
+
+    def do_GET(self, request):
+        url = urllib.parse.urlparse(request.path)
+        if url.path == "/oapif/collections":
+            content = {"collections": [{"id": "foo"}]}
+        elif url.path == "/oapif/collections/foo/items":
+            query = dict(urllib.parse.parse_qsl(url.query))
+            limit = int(query["limit"])
+            offset = int(query.get("offset", "0"))
+            self.offsets.append(offset)
+            content = {
+                "type": "FeatureCollection",
+                "features": [
+                    {"type": "Feature", "id": i, "properties": {"val": i}}
+                    for i in range(offset, min(offset + limit, self.num_features))
+                ],
+            }
+            if self.number_matched:
+                content["numberMatched"] = self.num_features
+            if offset + limit < self.num_features:
+                next_query = {"limit": limit, "offset": offset + limit}
+                if self.token_from is not None and offset + limit >= self.token_from:
+                    next_query["token"] = "x"
+                content["links"] = [
+                    {
+                        "rel": "next",
+                        "type": "application/geo+json",
+                        "href": "http://localhost:%d%s?%s"
+                        % (
+                            gdaltest.webserver_port,
+                            url.path,
+                            urllib.parse.urlencode(next_query),
+                        ),
+                    }
+                ]
+        else:
+            request.send_response(404)
+            request.end_headers()
+            return
+
+        data = json.dumps(content).encode("utf-8")
+        request.send_response(200)
+        request.send_header("Content-Type", "application/geo+json")
+        request.send_header("Content-Length", len(data))
+        request.end_headers()
+        request.wfile.write(data)
+
+
+@pytest.mark.parametrize("number_matched", [False, True])
+@pytest.mark.parametrize("token_from", [None, 9])
+@pytest.mark.parametrize("max_connections", ["1", "3"])
+def test_ogr_oapif_paging_prefetch(number_matched, token_from, max_connections):
+
+    num_features = 20
+    handler = _OAPIFPagingHandler(num_features, number_matched, token_from)
+    with webserver.install_http_handler(handler):
+        ds = gdal.OpenEx(
+            "OAPIF:http://localhost:%d/oapif" % gdaltest.webserver_port,
+            open_options=["PAGE_SIZE=3", "MAX_CONNECTIONS=" + max_connections],
+        )
+        lyr = ds.GetLayer(0)
+        for _ in range(2):
+            assert [f["val"] for f in lyr] == list(range(num_features))
+            assert set(range(0, num_features, 3)).issubset(handler.offsets)
+            if number_matched:
+                assert max(handler.offsets) < num_features
+            del handler.offsets[:]
+        ds = None
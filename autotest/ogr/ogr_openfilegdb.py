@@ -2549,6 +2549,44 @@ def test_ogr_openfilegdb_read_int64():
         assert f["MAX_big"] == 9007199254740991
 
 
+###############################################################################
+# Test that decoding geometries in worker threads gives the same result as
+# a single-threaded read
+
+
+@pytest.mark.parametrize(
+    "filename", ["data/filegdb/curves.gdb", "data/filegdb/sparse.gdb.zip"]
+)
+def test_ogr_openfilegdb_read_multithreaded_geometry_decoding(filename):
+    def read_all(num_threads):
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            ds = ogr.Open(filename)
+            ret = []
+            for lyr in ds:
+                for f in lyr:
+                    g = f.GetGeometryRef()
+                    ret.append(
+                        (
+                            lyr.GetName(),
+                            f.GetFID(),
+                            [f.GetField(i) for i in range(f.GetFieldCount())],
+                            g.ExportToIsoWkt() if g else None,
+                            g.GetSpatialReference() is not None if g else None,
+                        )
+                    )
+                # Read again after a rewind in the middle of the layer
+                lyr.ResetReading()
+                lyr.GetNextFeature()
+                lyr.ResetReading()
+                f = lyr.GetNextFeature()
+                ret.append(f.GetFID() if f else None)
+            return ret
+
+    ref = read_all("1")
+    assert ref
+    assert read_all("4") == ref
+
+
 ###############################################################################
 # Test reading DateOnly, TimeOnly, TimestampOffset fields (ArcGIS Pro >= 3.2)
 
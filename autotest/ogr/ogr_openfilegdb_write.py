@@ -1804,6 +1804,107 @@ def test_ogr_openfilegdb_write_attribute_index():
         gdal.RmdirRecursive(dirname)
 
 
+###############################################################################
+# Test index creation through sorted runs, and range / IN filters evaluated
+# with indexes
+
+
+@pytest.mark.parametrize("sort_buffer_size", [None, "0.01"])
+def test_ogr_openfilegdb_write_attribute_index_external_sort_and_filters(
+    sort_buffer_size,
+):
+
+    dirname = "/vsimem/out.gdb"
+    try:
+        ds = ogr.GetDriverByName("OpenFileGDB").CreateDataSource(dirname)
+        lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+        lyr.CreateField(ogr.FieldDefn("int32", ogr.OFTInteger))
+        lyr.CreateField(ogr.FieldDefn("float64", ogr.OFTReal))
+        lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+        N = 2000
+        for i in range(N):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f["int32"] = (i * 37) % 500
+            f["float64"] = ((i * 13) % 1000) / 10.0
+            f["str"] = "val%d" % (i % 50)
+            f.SetGeometry(ogr.CreateGeometryFromWkt("POINT(%d %d)" % (i, i)))
+            assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+
+        with gdaltest.config_options(
+            {
+                "OPENFILEGDB_INDEX_SORT_BUFFER_SIZE": sort_buffer_size,
+                "OPENFILEGDB_MAX_FEATURES_PER_SPX_PAGE": "20",
+            }
+        ):
+            gdal.ErrorReset()
+            for fld_name in ("int32", "float64", "str"):
+                ds.ExecuteSQL("CREATE INDEX idx_%s ON test(%s)" % (fld_name, fld_name))
+                assert gdal.GetLastErrorMsg() == ""
+            lyr.SyncToDisk()
+            assert gdal.GetLastErrorMsg() == ""
+        ds = None
+
+        # No leftover temporary file
+        assert [x for x in gdal.ReadDir(dirname) if x.endswith(".tmp")] == []
+
+        ds = ogr.Open(dirname)
+        lyr = ds.GetLayer(0)
+
+        def get_attr_index_use():
+            sql_lyr = ds.ExecuteSQL("GetLayerAttrIndexUse " + lyr.GetName())
+            attr_index_use = int(sql_lyr.GetNextFeature().GetField(0))
+            ds.ReleaseResultSet(sql_lyr)
+            return attr_index_use
+
+        def int32(i):
+            return (i * 37) % 500
+
+        def float64(i):
+            return ((i * 13) % 1000) / 10.0
+
+        for where, expected_index_use, expected in [
+            ("int32 >= 100 AND int32 <= 110", 2, lambda i: 100 <= int32(i) <= 110),
+            ("int32 > 100 AND int32 < 110", 2, lambda i: 100 < int32(i) < 110),
+            ("int32 BETWEEN 495 AND 1000", 2, lambda i: 495 <= int32(i)),
+            ("120 > int32 AND 100 <= int32", 2, lambda i: 100 <= int32(i) < 120),
+            ("int32 >= 110 AND int32 <= 100", 2, lambda i: False),
+            ("float64 > 10.5 AND float64 <= 12", 2, lambda i: 10.5 < float64(i) <= 12),
+            (
+                "int32 IN (3, 5, 7, 9, 11, 499)",
+                2,
+                lambda i: int32(i) in (3, 5, 7, 9, 11, 499),
+            ),
+            (
+                "int32 >= 10 AND int32 <= 20 AND float64 < 50",
+                2,
+                lambda i: 10 <= int32(i) <= 20 and float64(i) < 50,
+            ),
+            (
+                "int32 = 1 OR (float64 >= 1 AND float64 < 2)",
+                2,
+                lambda i: int32(i) == 1 or 1 <= float64(i) < 2,
+            ),
+            ("str IN ('val1', 'val49')", 1, lambda i: i % 50 in (1, 49)),
+        ]:
+            lyr.SetAttributeFilter(where)
+            assert get_attr_index_use() == expected_index_use, where
+            got_fids = sorted(f.GetFID() for f in lyr)
+            expected_fids = [i + 1 for i in range(N) if expected(i)]
+            assert got_fids == expected_fids, where
+            assert lyr.GetFeatureCount() == len(expected_fids), where
+
+            # Combined with a spatial filter
+            lyr.SetSpatialFilterRect(500, 500, 1500, 1500)
+            got_fids = sorted(f.GetFID() for f in lyr)
+            assert got_fids == [x for x in expected_fids if 501 <= x <= 1501], where
+            lyr.SetSpatialFilter(None)
+
+        ds = None
+
+    finally:
+        gdal.RmdirRecursive(dirname)
+
+
 ###############################################################################
 
 
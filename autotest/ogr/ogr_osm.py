@@ -30,6 +30,7 @@
 ###############################################################################
 
 import os
+import shutil
 
 import gdaltest
 import ogrtest
@@ -324,6 +325,86 @@ def test_ogr_osm_3_custom_compress_nodes():
         test_ogr_osm_3()
 
 
+###############################################################################
+# Test ogr2ogr with --config OSM_DENSE_NODE_INDEX YES
+
+
+def test_ogr_osm_3_dense_node_index():
+    with gdal.config_option("OSM_DENSE_NODE_INDEX", "YES"):
+        test_ogr_osm_3()
+
+
+###############################################################################
+# Test NODE_CACHE_FILE open option
+
+
+def test_ogr_osm_node_cache_file(tmp_path):
+
+    src_filename = str(tmp_path / "test.pbf")
+    shutil.copy("data/osm/test.pbf", src_filename)
+    cache_filename = str(tmp_path / "test.pbf.nodes")
+
+    def read_lines():
+        ds = gdal.OpenEx(
+            src_filename, open_options=["NODE_CACHE_FILE=" + cache_filename]
+        )
+        lyr = ds.GetLayerByName("lines")
+        return [f.GetGeometryRef().ExportToWkt() for f in lyr]
+
+    ref = read_lines()
+    assert ref
+    assert os.path.exists(cache_filename)
+    cache_size = os.stat(cache_filename).st_size
+    with open(cache_filename, "rb") as f:
+        assert f.read(8) == b"OSMNODC1"
+
+    # Reuse the cache
+    assert read_lines() == ref
+    assert os.stat(cache_filename).st_size == cache_size
+
+    # A corrupted cache is detected and rebuilt
+    with open(cache_filename, "r+b") as f:
+        f.seek(8)
+        f.write(b"\x00" * 8)
+    assert read_lines() == ref
+    with open(cache_filename, "rb") as f:
+        f.seek(8)
+        assert f.read(8) != b"\x00" * 8
+
+
+###############################################################################
+# Test the dense node index with nodes not sorted by increasing id
+
+
+def test_ogr_osm_dense_node_index_unsorted_ids(tmp_vsimem):
+
+    if not ogrtest.osm_drv_parse_osm:
+        pytest.skip("Expat support missing")
+
+    filename = str(tmp_vsimem / "unsorted.osm")
+    gdal.FileFromMemBuffer(
+        filename,
+        """<osm version="0.6" generator="test">
+<node id="20000000" lat="49" lon="2"/>
+<node id="3" lat="49.5" lon="2.5"/>
+<node id="1" lat="50" lon="3"/>
+<way id="1">
+<nd ref="20000000"/>
+<nd ref="3"/>
+<nd ref="1"/>
+<nd ref="2"/>
+<tag k="highway" v="road"/>
+</way>
+</osm>""",
+    )
+
+    with gdal.config_option("OSM_DENSE_NODE_INDEX", "YES"):
+        ds = gdal.OpenEx(filename)
+        lyr = ds.GetLayerByName("lines")
+        f = lyr.GetNextFeature()
+        assert f.GetGeometryRef().ExportToWkt() == "LINESTRING (2 49,2.5 49.5,3 50)"
+
+
 ###############################################################################
 # Test ogr2ogr with all layers
 
@@ -911,3 +992,53 @@ def test_ogr_osm_tags_json():
     assert lyr_defn.GetFieldDefn(other_tags_idx).GetSubType() == ogr.OFSTJSON
     f = lyr.GetNextFeature()
     assert f["other_tags"] == '{"foo":"bar"}'
+
+
+###############################################################################
+# Test that resolving way geometries in worker threads gives the same result
+# as doing it in a single thread
+
+
+def test_ogr_osm_ways_num_threads(tmp_vsimem):
+
+    if not ogrtest.osm_drv_parse_osm:
+        pytest.skip("Expat support missing")
+
+    filename = str(tmp_vsimem / "ways.osm")
+    content = '<osm version="0.6" generator="test">\n'
+    for i in range(4000):
+        content += '<node id="%d" lat="%f" lon="%f"/>\n' % (
+            i + 1,
+            49 + (i // 100) * 0.001,
+            2 + (i % 100) * 0.001,
+        )
+    for i in range(1000):
+        # Reference a missing node from time to time
+        refs = [i * 4 + 1, i * 4 + 2, i * 4 + 3, 100000 + i if i % 7 else i * 4 + 4]
+        content += '<way id="%d">\n' % (i + 1)
+        for ref in refs:
+            content += '<nd ref="%d"/>\n' % ref
+        if i % 3 == 0:
+            content += '<nd ref="%d"/>\n' % refs[0]
+            content += '<tag k="building" v="yes"/>\n'
+        else:
+            content += '<tag k="highway" v="road_%d"/>\n' % i
+        content += "</way>\n"
+    content += "</osm>\n"
+    gdal.FileFromMemBuffer(filename, content)
+
+    def read(num_threads):
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            ds = ogr.Open(filename)
+            ret = []
+            for lyr_name in ("lines", "multipolygons"):
+                lyr = ds.GetLayerByName(lyr_name)
+                for f in lyr:
+                    ret.append(
+                        (lyr_name, f.GetFID(), f.GetGeometryRef().ExportToWkt())
+                    )
+            return ret
+
+    ref = read("1")
+    assert len(ref) == 1000
+    assert read("4") == ref
@@ -1573,6 +1573,52 @@ def test_ogr_parquet_read_partitioned_hive(use_vsi, use_metadata_file, prefix):
             lyr.ResetReading()
 
 
+###############################################################################
+# Test attribute filters pushed down to the Arrow dataset scanner
+
+
+@pytest.mark.skipif(not _has_arrow_dataset(), reason="GDAL not built with ArrowDataset")
+@pytest.mark.parametrize("optimized", ["YES", "NO"])
+@pytest.mark.parametrize(
+    "filter,expected",
+    [
+        ("one = 2", [2]),
+        ("2 = one", [2]),
+        ("one <> 2", [1, 3, 4, 5, 6]),
+        ("one < 3", [1, 2]),
+        ("one <= 3.5", [1, 2, 3]),
+        ("one > 4", [5, 6]),
+        ("4 < one", [5, 6]),
+        ("one >= 4", [4, 5, 6]),
+        ("one BETWEEN 2 AND 4", [2, 3, 4]),
+        ("one IN (1, 6, 7)", [1, 6]),
+        ("one IS NULL", []),
+        ("one IS NOT NULL", [1, 2, 3, 4, 5, 6]),
+        ("one = 1 OR two = -6", [1, 6]),
+        ("one > 1 AND two > -4", [2, 3]),
+        ("foo = 'BAR'", [1, 2, 3]),
+        ("foo = 'baz' AND one < 5", [4]),
+        ("foo LIKE 'ba%'", [1, 2, 3, 4, 5, 6]),
+        ("foo LIKE 'BA%'", []),
+        ("foo ILIKE 'BA%'", [1, 2, 3, 4, 5, 6]),
+        ("foo LIKE 'b_r'", [1, 2, 3]),
+        ("one = 1 OR foo = 'baz'", [1, 4, 5, 6]),
+        ("NOT (one = 1)", [2, 3, 4, 5, 6]),
+    ],
+)
+def test_ogr_parquet_read_partitioned_attribute_filter(optimized, filter, expected):
+
+    with gdaltest.config_option("OGR_PARQUET_OPTIMIZED_ATTRIBUTE_FILTER", optimized):
+        ds = ogr.Open("data/parquet/partitioned_hive")
+        lyr = ds.GetLayer(0)
+        lyr.SetAttributeFilter(filter)
+        assert sorted(f["one"] for f in lyr) == expected
+        assert lyr.GetFeatureCount() == len(expected)
+
+        lyr.SetAttributeFilter(None)
+        assert lyr.GetFeatureCount() == 6
+
+
 ###############################################################################
 # Test reading a partitioned dataset with geo
 
@@ -3332,3 +3378,198 @@ def test_ogr_parquet_get_extent_3d(tmp_vsimem):
         lyr = ds.GetLayer(0)
         assert lyr.TestCapability(ogr.OLCFastGetExtent3D) == 0
         assert lyr.GetExtent3D() == (1.0, 4.0, 2.0, 5.0, 3.0, 6.0)
+
+
+###############################################################################
+# Test WRITE_COVERING_BBOX=YES and use of the covering for spatial filtering
+
+
+@gdaltest.enable_exceptions()
+def test_ogr_parquet_write_covering_bbox(tmp_vsimem):
+
+    outfilename = str(tmp_vsimem / "test_ogr_parquet_write_covering_bbox.parquet")
+    ds = ogr.GetDriverByName("Parquet").CreateDataSource(outfilename)
+    lyr = ds.CreateLayer(
+        "test",
+        geom_type=ogr.wkbLineString,
+        options=["FID=fid", "ROW_GROUP_SIZE=2", "WRITE_COVERING_BBOX=YES"],
+    )
+    assert lyr.TestCapability(ogr.OLCFastWriteArrowBatch) == 0
+    for fid, wkt in enumerate(
+        ["LINESTRING(1 2,3 4)", None, "LINESTRING EMPTY", "LINESTRING(-1 0,1 10)"]
+    ):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetFID(fid)
+        if wkt:
+            f.SetGeometryDirectly(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+    ds = None
+
+    ds = ogr.Open(outfilename)
+    lyr = ds.GetLayer(0)
+    geo = lyr.GetMetadataItem("geo", "_PARQUET_METADATA_")
+    assert geo is not None
+    j = json.loads(geo)
+    assert j["version"] == "1.1.0"
+    assert j["columns"]["geometry"]["covering"] == {
+        "bbox": {
+            "xmin": ["geometry_bbox", "xmin"],
+            "ymin": ["geometry_bbox", "ymin"],
+            "xmax": ["geometry_bbox", "xmax"],
+            "ymax": ["geometry_bbox", "ymax"],
+        }
+    }
+    assert [
+        lyr.GetLayerDefn().GetFieldDefn(i).GetName()
+        for i in range(lyr.GetLayerDefn().GetFieldCount())
+    ] == [
+        "geometry_bbox.xmin",
+        "geometry_bbox.ymin",
+        "geometry_bbox.xmax",
+        "geometry_bbox.ymax",
+    ]
+    f = lyr.GetNextFeature()
+    assert f["geometry_bbox.xmin"] == 1
+    assert f["geometry_bbox.ymin"] == 2
+    assert f["geometry_bbox.xmax"] == 3
+    assert f["geometry_bbox.ymax"] == 4
+    f = lyr.GetNextFeature()
+    assert f.IsFieldNull("geometry_bbox.xmin")
+    f = lyr.GetNextFeature()
+    assert f.IsFieldNull("geometry_bbox.xmin")
+
+    assert lyr.TestCapability(ogr.OLCFastGetExtent) == 1
+    minx, maxx, miny, maxy = lyr.GetExtent()
+    assert (minx, miny, maxx, maxy) == (-1.0, 0.0, 3.0, 10.0)
+
+    for use_bbox in ("YES", "NO"):
+        with gdaltest.config_option("OGR_PARQUET_USE_BBOX", use_bbox):
+            with ogrtest.spatial_filter(lyr, 1, 2, 1, 2):
+                assert [f.GetFID() for f in lyr] == [0]
+            with ogrtest.spatial_filter(lyr, 1, 10, 1, 10):
+                assert [f.GetFID() for f in lyr] == [3]
+            with ogrtest.spatial_filter(lyr, -0.5, 0.5, 2, 9):
+                assert [f.GetFID() for f in lyr] == [0, 3]
+            with ogrtest.spatial_filter(lyr, 10, 10, 11, 11):
+                assert [f.GetFID() for f in lyr] == []
+
+
+###############################################################################
+# Test SORT_BY_BBOX=YES
+
+
+@gdaltest.enable_exceptions()
+@pytest.mark.require_driver("GPKG")
+def test_ogr_parquet_sort_by_bbox(tmp_vsimem):
+
+    outfilename = str(tmp_vsimem / "test_ogr_parquet_sort_by_bbox.parquet")
+    ds = ogr.GetDriverByName("Parquet").CreateDataSource(outfilename)
+    lyr = ds.CreateLayer(
+        "test",
+        geom_type=ogr.wkbPoint,
+        options=["FID=fid", "ROW_GROUP_SIZE=16", "SORT_BY_BBOX=YES"],
+    )
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    lyr.CreateField(ogr.FieldDefn("time", ogr.OFTTime))
+    f = ogr.Feature(lyr.GetLayerDefn())
+    f.SetFID(1000)
+    f["str"] = "no geometry"
+    lyr.CreateFeature(f)
+    # Points of a 16x16 grid in row-major order
+    for i in range(256):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetFID(i)
+        f["str"] = "%d" % i
+        f["time"] = "12:34:56"
+        f.SetGeometryDirectly(ogr.CreateGeometryFromWkt(f"POINT({i % 16} {i // 16})"))
+        lyr.CreateFeature(f)
+    ds = None
+
+    assert gdal.VSIStatL(outfilename + "_tmp_sort.gpkg") is None
+
+    ds = ogr.Open(outfilename)
+    lyr = ds.GetLayer(0)
+    geo = json.loads(lyr.GetMetadataItem("geo", "_PARQUET_METADATA_"))
+    # WRITE_COVERING_BBOX defaults to YES when sorting
+    assert "covering" in geo["columns"]["geometry"]
+    assert lyr.GetFeatureCount() == 257
+    fids = set()
+    path_length = 0
+    prev_point = None
+    for f in lyr:
+        fids.add(f.GetFID())
+        g = f.GetGeometryRef()
+        if g is None:
+            assert f.GetFID() == 1000
+            assert f["str"] == "no geometry"
+            # Features without geometry are written last
+            assert len(fids) == 257
+            continue
+        assert f["str"] == "%d" % f.GetFID()
+        assert f["time"] == "12:34:56"
+        assert (g.GetX(), g.GetY()) == (f.GetFID() % 16, f.GetFID() // 16)
+        if prev_point:
+            path_length += math.hypot(
+                g.GetX() - prev_point[0], g.GetY() - prev_point[1]
+            )
+        prev_point = (g.GetX(), g.GetY())
+    assert fids == set(range(256)).union([1000])
+    # Row-major order would give a path length of 15 * 16 + 15 * sqrt(15^2+1)
+    # ~= 465, whereas a Hilbert curve visits neighbours.
+    assert path_length < 400
+
+    with ogrtest.spatial_filter(lyr, 0, 0, 3.5, 3.5):
+        assert set(f.GetFID() for f in lyr) == set(
+            i for i in range(256) if i % 16 <= 3 and i // 16 <= 3
+        )
+
+
+###############################################################################
+# Test SORT_BY_BBOX=YES with an unsupported field type
+
+
+@gdaltest.enable_exceptions()
+@pytest.mark.require_driver("GPKG")
+def test_ogr_parquet_sort_by_bbox_unsupported_field_type(tmp_vsimem):
+
+    outfilename = str(tmp_vsimem / "test_ogr_parquet_sort_by_bbox_error.parquet")
+    ds = ogr.GetDriverByName("Parquet").CreateDataSource(outfilename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint, options=["SORT_BY_BBOX=YES"])
+    lyr.CreateField(ogr.FieldDefn("strlist", ogr.OFTStringList))
+    f = ogr.Feature(lyr.GetLayerDefn())
+    with pytest.raises(Exception, match="SORT_BY_BBOX=YES is not compatible"):
+        lyr.CreateFeature(f)
+    ds = None
+
+
+###############################################################################
+# Test writing row groups from a worker thread
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_ogr_parquet_write_row_groups_multithreaded(tmp_vsimem, num_threads):
+
+    outfilename = str(tmp_vsimem / "test_ogr_parquet_write_row_groups.parquet")
+    with gdaltest.config_option("GDAL_NUM_THREADS", num_threads):
+        ds = ogr.GetDriverByName("Parquet").CreateDataSource(outfilename)
+        lyr = ds.CreateLayer(
+            "test", geom_type=ogr.wkbPoint, options=["ROW_GROUP_SIZE=10"]
+        )
+        lyr.CreateField(ogr.FieldDefn("int", ogr.OFTInteger))
+        lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+        for i in range(105):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f["int"] = i
+            f["str"] = "value%d" % i
+            f.SetGeometry(ogr.CreateGeometryFromWkt("POINT(%d %d)" % (i, -i)))
+            lyr.CreateFeature(f)
+        ds = None
+
+    ds = ogr.Open(outfilename)
+    lyr = ds.GetLayer(0)
+    assert lyr.GetMetadataItem("NUM_ROW_GROUPS", "_PARQUET_") == "11"
+    assert lyr.GetFeatureCount() == 105
+    for i, f in enumerate(lyr):
+        assert f["int"] == i
+        assert f["str"] == "value%d" % i
+        assert f.GetGeometryRef().ExportToIsoWkt() == "POINT (%d %d)" % (i, -i)
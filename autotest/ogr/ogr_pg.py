@@ -5923,3 +5923,67 @@ def test_extent3d(pg_ds):
     assert lyr.GetFeatureCount() == 2
     extent = lyr.GetExtent3D()
     assert extent == (0.0, 2.0, 1.0, 3.0, 2.0, 4.0)
+
+
+###############################################################################
+# Test that fetching rows in binary format gives the same result as in text
+
+
+@only_with_postgis
+@pytest.mark.parametrize("geom_type", ["geometry", "geography"])
+def test_ogr_pg_binary_fetch(pg_ds, geom_type):
+
+    pg_ds.ExecuteSQL(
+        "CREATE TABLE test_binary_fetch (fid serial8 PRIMARY KEY, "
+        f"geom {geom_type}(Geometry, 4326), my_bool bool, my_int2 int2, "
+        "my_int4 int4, my_int8 int8, my_float4 float4, my_float8 float8, "
+        "my_numeric numeric, my_numeric10_3 numeric(10,3), "
+        "my_numeric20 numeric(20), my_char char(3), my_varchar varchar, "
+        "my_text text, my_json json, my_jsonb jsonb, my_uuid uuid, "
+        "my_bytea bytea, my_date date, my_time time, my_timestamp timestamp, "
+        "my_timestamptz timestamptz)"
+    )
+    pg_ds.ExecuteSQL(
+        "INSERT INTO test_binary_fetch (geom, my_bool, my_int2, my_int4, "
+        "my_int8, my_float4, my_float8, my_numeric, my_numeric10_3, "
+        "my_numeric20, my_char, my_varchar, my_text, my_json, my_jsonb, "
+        "my_uuid, my_bytea, my_date, my_time, my_timestamp, my_timestamptz) "
+        "VALUES ('SRID=4326;LINESTRING(1 2,3 4)', true, -32768, -2147483648, "
+        "-9223372036854775807, 1.5, 0.1, -1234567.000123, 0.001, "
+        "12345678901234567890, 'ab', 'varchar', 'éè', '{\"a\": 1}', "
+        "'{\"b\": [1, 2]}', 'a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11', "
+        "'\\x0001ff', '1900-02-28', '23:59:59.123', "
+        "'1969-12-31 23:59:59.5', '2023-06-15 12:34:56+02'), "
+        "(NULL, false, 32767, 2147483647, 9223372036854775807, -1.5, "
+        "-1e300, 'NaN', -0.5, 0, '', '', '', '[]', '[]', NULL, '', "
+        "'2100-12-31', '00:00:00', '2000-01-01 00:00:00', NULL), "
+        "(NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, "
+        "NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL)"
+    )
+
+    def read_features(binary_fetch):
+        with gdal.config_option("PG_USE_BINARY_FETCH", binary_fetch):
+            ds = reconnect(pg_ds, update=False)
+            ret = []
+            lyr = ds.GetLayerByName("test_binary_fetch")
+            for f in lyr:
+                ret.append(f.DumpReadableAsString())
+            with ds.ExecuteSQL(
+                "SELECT * FROM test_binary_fetch ORDER BY fid"
+            ) as sql_lyr:
+                for f in sql_lyr:
+                    ret.append(f.DumpReadableAsString())
+            # A timestamptz column makes a result set fetched in text format
+            with ds.ExecuteSQL(
+                "SELECT fid, geom, my_numeric, my_uuid, my_jsonb, my_date, "
+                "my_time, my_timestamp FROM test_binary_fetch ORDER BY fid"
+            ) as sql_lyr:
+                for f in sql_lyr:
+                    ret.append(f.DumpReadableAsString())
+            lyr.SetNextByIndex(1)
+            ret.append(lyr.GetNextFeature().DumpReadableAsString())
+            return ret
+
+    ref = read_features("NO")
+    assert len(ref) == 10
+    assert read_features("YES") == ref
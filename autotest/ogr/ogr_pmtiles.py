@@ -82,6 +82,31 @@ def test_ogr_pmtiles_read_basic():
     assert f.GetGeometryRef().GetGeometryType() == ogr.wkbMultiPolygon
 
 
+###############################################################################
+# Test that reading through the shared directory cache and the batched tile
+# reads returns the same features as a fresh read
+
+
+@pytest.mark.parametrize("cache_size", [None, "1"])
+def test_ogr_pmtiles_read_directory_cache_and_prefetch(cache_size):
+
+    def get_features():
+        ds = ogr.Open("data/pmtiles/poly.pmtiles")
+        lyr = ds.GetLayer(0)
+        return [(f["EAS_ID"], f.GetGeometryRef().ExportToWkt()) for f in lyr]
+
+    with gdal.config_option("OGR_PMTILES_DIRECTORY_CACHE_SIZE", cache_size):
+        first = get_features()
+        assert len(first) == 8
+        assert get_features() == first
+
+        ds = ogr.Open("data/pmtiles/poly.pmtiles")
+        lyr = ds.GetLayer(0)
+        assert [f["EAS_ID"] for f in lyr] == [x[0] for x in first]
+        lyr.ResetReading()
+        assert [f["EAS_ID"] for f in lyr] == [x[0] for x in first]
+
+
 ###############################################################################
 
 
@@ -480,6 +505,77 @@ def test_ogr_pmtiles_write_from_mbtiles():
             gdal.Unlink(pmtiles_filename)
 
 
+###############################################################################
+# Test converting a raster MBTiles file to PMTiles
+
+
+@pytest.mark.require_driver("MBTiles")
+@pytest.mark.require_driver("SQLite")
+@pytest.mark.parametrize(
+    "tile_format,ext,tile_type",
+    [("PNG", "png", 2), ("JPEG", "jpg", 3), ("WEBP", "webp", 4)],
+)
+def test_ogr_pmtiles_write_from_raster_mbtiles(
+    tmp_vsimem, tile_format, ext, tile_type
+):
+
+    if gdal.GetDriverByName(tile_format) is None:
+        pytest.skip(f"{tile_format} driver not available")
+
+    mbtiles_filename = str(tmp_vsimem / "test.mbtiles")
+    gdal.Translate(
+        mbtiles_filename,
+        "../gcore/data/byte.tif",
+        format="MBTiles",
+        creationOptions=["TILE_FORMAT=" + tile_format],
+    )
+
+    pmtiles_filename = str(tmp_vsimem / "test.pmtiles")
+    src_ds = gdal.Open(mbtiles_filename)
+    out_ds = gdal.VectorTranslate(pmtiles_filename, src_ds, format="PMTiles")
+    assert out_ds
+    out_ds = None
+    src_ds = None
+
+    # Raster tiles are not handled by the vector driver
+    with pytest.raises(Exception, match="not handled by the driver"):
+        gdal.OpenEx(pmtiles_filename, gdal.OF_VECTOR)
+
+    f = gdal.VSIFOpenL(f"/vsipmtiles/{pmtiles_filename}/pmtiles_header.json", "rb")
+    assert f
+    try:
+        data = gdal.VSIFReadL(1, 10000, f)
+    finally:
+        gdal.VSIFCloseL(f)
+    got = json.loads(data)
+    assert got["tile_type"] == tile_type
+    assert got["tile_type_str"] == tile_format
+    assert got["tile_compression_str"] == "none"
+
+    # Tiles are copied as they are
+    src_ds_sqlite3 = gdal.OpenEx(mbtiles_filename, allowed_drivers=["SQLite"])
+    count = 0
+    with src_ds_sqlite3.ExecuteSQL(
+        "SELECT zoom_level, tile_column, tile_row, tile_data FROM tiles"
+    ) as lyr:
+        for f in lyr:
+            z = f["zoom_level"]
+            x = f["tile_column"]
+            y = (1 << z) - 1 - f["tile_row"]
+            tile_data = f.GetFieldAsBinary("tile_data")
+            tile_filename = f"/vsipmtiles/{pmtiles_filename}/{z}/{x}/{y}.{ext}"
+            fp = gdal.VSIFOpenL(tile_filename, "rb")
+            assert fp
+            try:
+                assert gdal.VSIFReadL(1, len(tile_data) + 1, fp) == tile_data
+            finally:
+                gdal.VSIFCloseL(fp)
+            tile_ds = gdal.Open(tile_filename)
+            assert tile_ds.GetDriver().ShortName == tile_format
+            count += 1
+    assert count > 0
+
+
 ###############################################################################
 
 
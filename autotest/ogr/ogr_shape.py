@@ -5868,13 +5868,14 @@ def test_ogr_shape_arrow_stream():
 
     ds = ogr.Open("data/poly.shp")
     lyr = ds.GetLayer(0)
+    assert lyr.TestCapability(ogr.OLCFastGetArrowStream)
     stream = lyr.GetArrowStreamAsNumPy(options=["USE_MASKED_ARRAYS=NO"])
     batches = [batch for batch in stream]
     assert (
         lyr.GetMetadataItem(
             "LAST_GET_NEXT_ARROW_ARRAY_USED_OPTIMIZED_CODE_PATH", "__DEBUG__"
         )
-        == "NO"
+        == "YES"
     )
     assert len(batches) == 1
     assert len(batches[0]) == 5
@@ -5971,7 +5972,7 @@ def test_ogr_shape_arrow_stream_fid_optim(tmp_vsimem):
     )
     assert len(batches) == 0
 
-    # Regular code path
+    # Optimized code path, with a field
     lyr.SetIgnoredFields(ignored_fields[0:-1])
     stream = lyr.GetArrowStreamAsNumPy(options=["USE_MASKED_ARRAYS=NO"])
     batches = [batch for batch in stream]
@@ -5980,14 +5981,14 @@ def test_ogr_shape_arrow_stream_fid_optim(tmp_vsimem):
         lyr.GetMetadataItem(
             "LAST_GET_NEXT_ARROW_ARRAY_USED_OPTIMIZED_CODE_PATH", "__DEBUG__"
         )
-        == "NO"
+        == "YES"
     )
     assert len(batches) == 1
     assert len(batches[0]) == 2
     assert len(batches[0]["OGC_FID"]) == 10
     assert list(batches[0]["OGC_FID"]) == [0, 1, 2, 3, 4, 5, 6, 7, 8, 9]
 
-    # Regular code path
+    # Optimized code path, with the geometry
     lyr.SetIgnoredFields(ignored_fields[1:])
     stream = lyr.GetArrowStreamAsNumPy(options=["USE_MASKED_ARRAYS=NO"])
     batches = [batch for batch in stream]
@@ -5996,7 +5997,7 @@ def test_ogr_shape_arrow_stream_fid_optim(tmp_vsimem):
         lyr.GetMetadataItem(
             "LAST_GET_NEXT_ARROW_ARRAY_USED_OPTIMIZED_CODE_PATH", "__DEBUG__"
         )
-        == "NO"
+        == "YES"
     )
     assert len(batches) == 1
     assert len(batches[0]) == 2
@@ -6066,3 +6067,340 @@ def test_ogr_shape_arrow_stream_fid_optim(tmp_vsimem):
         == "YES"
     )
     assert len(batches) == 0
+
+
+###############################################################################
+# Test that the specialized GetArrowStream() implementation returns the same
+# content as the feature API
+
+
+@pytest.mark.parametrize("mem_limit", [None, "200"])
+def test_ogr_shape_arrow_stream_all_field_types(tmp_vsimem, mem_limit):
+    pa = pytest.importorskip("pyarrow")
+
+    filename = str(tmp_vsimem / "test_ogr_shape_arrow_stream_all_field_types.shp")
+    ds = gdal.GetDriverByName("ESRI Shapefile").Create(
+        filename, 0, 0, 0, gdal.GDT_Unknown
+    )
+    lyr = ds.CreateLayer(
+        "test", geom_type=ogr.wkbPoint25D, options=["ENCODING=LDID/87"]
+    )
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    lyr.CreateField(ogr.FieldDefn("int", ogr.OFTInteger))
+    fld_defn = ogr.FieldDefn("int64", ogr.OFTInteger64)
+    fld_defn.SetWidth(18)
+    lyr.CreateField(fld_defn)
+    lyr.CreateField(ogr.FieldDefn("real", ogr.OFTReal))
+    lyr.CreateField(ogr.FieldDefn("date", ogr.OFTDate))
+    for i in range(10):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if i != 3:
+            f["str"] = "été %d" % i
+            f["int"] = -i
+            f["int64"] = 1234567890123 * i
+            f["real"] = 1.5 * i
+            f["date"] = "2024/01/%02d" % (i + 1)
+        if i != 5:
+            f.SetGeometry(ogr.CreateGeometryFromWkt(f"POINT Z ({i} {-i} {2 * i})"))
+        lyr.CreateFeature(f)
+    lyr.DeleteFeature(7)
+    ds.Close()
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+
+    expected = []
+    for f in lyr:
+        geom = f.GetGeometryRef()
+        expected.append(
+            {
+                "OGC_FID": f.GetFID(),
+                "str": f["str"],
+                "int": f["int"],
+                "int64": f["int64"],
+                "real": f["real"],
+                "date": f["date"],
+                "wkb_geometry": geom.ExportToIsoWkb() if geom else None,
+            }
+        )
+    assert len(expected) == 9
+
+    with gdal.config_option("OGR_ARROW_MEM_LIMIT", mem_limit):
+        stream = lyr.GetArrowStreamAsPyArrow()
+        batches = [batch for batch in stream]
+    assert (
+        lyr.GetMetadataItem(
+            "LAST_GET_NEXT_ARROW_ARRAY_USED_OPTIMIZED_CODE_PATH", "__DEBUG__"
+        )
+        == "YES"
+    )
+    if mem_limit:
+        assert len(batches) > 1
+    got = [row for batch in batches for row in batch.to_pylist()]
+    for row in got:
+        if row["date"] is not None:
+            row["date"] = row["date"].strftime("%Y/%m/%d")
+    assert got == expected
+    assert pa.types.is_date32(stream.schema.field("date").type)
+
+
+###############################################################################
+# Test mixing sequential reads (using the read-ahead buffer) and random reads
+
+
+def test_ogr_shape_sequential_and_random_reads(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test_read_ahead.shp")
+    nfeatures = 5000
+    with ogr.GetDriverByName("ESRI Shapefile").CreateDataSource(filename) as ds:
+        lyr = ds.CreateLayer("test_read_ahead", geom_type=ogr.wkbLineString)
+        lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+        for i in range(nfeatures):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f["str"] = "value %d" % i
+            f.SetGeometry(
+                ogr.CreateGeometryFromWkt(
+                    "LINESTRING (%d 0,%d 1)" % (i, i) if i % 3 else "LINESTRING EMPTY"
+                )
+            )
+            lyr.CreateFeature(f)
+
+    def check(f, i):
+        assert f.GetFID() == i
+        assert f["str"] == "value %d" % i
+        if i % 3:
+            assert f.GetGeometryRef().GetX(0) == i
+        else:
+            assert f.GetGeometryRef() is None
+
+    with ogr.Open(filename) as ds:
+        lyr = ds.GetLayer(0)
+        for i, f in enumerate(lyr):
+            check(f, i)
+            if i % 997 == 0:
+                check(lyr.GetFeature(nfeatures - 1 - i), nfeatures - 1 - i)
+        assert i == nfeatures - 1
+
+        for i in (10, 4999, 0, 2500, 2501, 2502, 17):
+            check(lyr.GetFeature(i), i)
+
+        lyr.SetNextByIndex(4990)
+        for i in range(4990, nfeatures):
+            check(lyr.GetNextFeature(), i)
+        assert lyr.GetNextFeature() is None
+
+
+###############################################################################
+# Test packed Hilbert R-tree spatial index (.hrt)
+
+
+def test_ogr_shape_hilbert_rtree_index(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test_hrt.shp")
+    with ogr.GetDriverByName("ESRI Shapefile").CreateDataSource(filename) as ds:
+        lyr = ds.CreateLayer("test_hrt", geom_type=ogr.wkbPolygon)
+        for i in range(1000):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            if i % 100 != 7:
+                x = (i % 50) * 2 + (0 if i < 500 else 1000)
+                y = (i // 50) * 2
+                f.SetGeometry(
+                    ogr.CreateGeometryFromWkt(
+                        f"POLYGON (({x} {y},{x} {y + 1},{x + 1} {y + 1},{x} {y}))"
+                    )
+                )
+            lyr.CreateFeature(f)
+
+    def get_fids(lyr, minx, miny, maxx, maxy):
+        lyr.SetSpatialFilterRect(minx, miny, maxx, maxy)
+        ret = [f.GetFID() for f in lyr]
+        lyr.SetSpatialFilter(None)
+        return ret
+
+    rects = [
+        (0, 0, 10, 10),
+        (1005, 15, 1030, 17.5),
+        (200, 0, 300, 100),
+        (0, 5, 1100, 6),
+    ]
+    with ogr.Open(filename) as ds:
+        expected = [get_fids(ds.GetLayer(0), *rect) for rect in rects]
+    assert expected[0]
+    assert expected[1]
+    assert not expected[2]
+
+    with ogr.Open(filename, update=1) as ds:
+        with pytest.raises(Exception, match="Syntax error"):
+            ds.ExecuteSQL("CREATE SPATIAL INDEX ON test_hrt TYPE FOO")
+        assert gdal.VSIStatL(filename[0:-3] + "hrt") is None
+
+        ds.ExecuteSQL("CREATE SPATIAL INDEX ON test_hrt TYPE HRT")
+        assert gdal.VSIStatL(filename[0:-3] + "hrt") is not None
+        assert gdal.VSIStatL(filename[0:-3] + "qix") is None
+
+    with ogr.Open(filename) as ds:
+        lyr = ds.GetLayer(0)
+        assert filename[0:-3] + "hrt" in ds.GetFileList()
+        got = [get_fids(lyr, *rect) for rect in rects]
+        assert got == expected
+
+    # Creating a .qix index replaces the .hrt one
+    with ogr.Open(filename, update=1) as ds:
+        ds.ExecuteSQL("CREATE SPATIAL INDEX ON test_hrt")
+        assert gdal.VSIStatL(filename[0:-3] + "hrt") is None
+        assert gdal.VSIStatL(filename[0:-3] + "qix") is not None
+        ds.ExecuteSQL("CREATE SPATIAL INDEX ON test_hrt DEPTH 4 TYPE HRT")
+        assert gdal.VSIStatL(filename[0:-3] + "hrt") is not None
+        assert gdal.VSIStatL(filename[0:-3] + "qix") is None
+
+    # Adding a feature drops the index
+    with ogr.Open(filename, update=1) as ds:
+        lyr = ds.GetLayer(0)
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POLYGON ((5 5,5 6,6 6,5 5))"))
+        lyr.CreateFeature(f)
+    assert gdal.VSIStatL(filename[0:-3] + "hrt") is None
+
+    with ogr.Open(filename, update=1) as ds:
+        ds.ExecuteSQL("CREATE SPATIAL INDEX ON test_hrt TYPE HRT")
+        lyr = ds.GetLayer(0)
+        assert 1000 in get_fids(lyr, *rects[0])
+        ds.ExecuteSQL("DROP SPATIAL INDEX ON test_hrt")
+    assert gdal.VSIStatL(filename[0:-3] + "hrt") is None
+
+
+###############################################################################
+# Test that GetArrowStream(GEOMETRY_ENCODING=GEOARROW) defers to the generic
+# implementation and returns GeoArrow geometries
+
+
+def test_ogr_shape_arrow_stream_geoarrow(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test.shp")
+    ds = ogr.GetDriverByName("ESRI Shapefile").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPolygon)
+    lyr.CreateField(ogr.FieldDefn("foo", ogr.OFTString))
+    for wkt in [
+        "POLYGON ((0 0,0 1,1 1,0 0))",
+        None,
+        "POLYGON ((0 0,0 10,10 10,10 0,0 0),(1 1,1 2,2 2,1 1))",
+    ]:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["foo"] = "bar"
+        if wkt:
+            f.SetGeometryDirectly(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+    ds = None
+
+    ds = ogr.Open(filename)
+    ogrtest.check_arrow_stream_geoarrow(ds.GetLayer(0))
+
+
+###############################################################################
+# Test that the files written in update mode with interleaved reads and
+# writes are the same with and without the write buffer
+
+
+def _ogr_shape_update_interleaved(filename):
+
+    def set_geom(f, i, npoints):
+        f.SetGeometry(
+            ogr.CreateGeometryFromWkt(
+                "LINESTRING (%s)"
+                % ",".join("%d %d" % (i, j) for j in range(npoints))
+            )
+        )
+
+    def new_feature(lyr, i):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["str"] = "value %d" % i
+        f["int"] = i
+        set_geom(f, i, 2 + i % 5)
+        return f
+
+    with ogr.GetDriverByName("ESRI Shapefile").CreateDataSource(filename) as ds:
+        lyr = ds.CreateLayer("test", geom_type=ogr.wkbLineString)
+        fld_defn = ogr.FieldDefn("str", ogr.OFTString)
+        fld_defn.SetWidth(40)
+        lyr.CreateField(fld_defn)
+        lyr.CreateField(ogr.FieldDefn("int", ogr.OFTInteger))
+        for i in range(3000):
+            lyr.CreateFeature(new_feature(lyr, i))
+
+    with ogr.Open(filename, update=1) as ds:
+        lyr = ds.GetLayer(0)
+
+        # Rewrite features in place or, for larger geometries, at the end of
+        # the .shp, while reading others
+        for i in range(0, 3000, 7):
+            f = lyr.GetFeature(i)
+            assert f["int"] == i
+            f["str"] = "updated %d" % i
+            set_geom(f, i, 2 + i % 11)
+            assert lyr.SetFeature(f) == ogr.OGRERR_NONE
+            assert lyr.GetFeature(2999 - i)["int"] == 2999 - i
+
+        # Append features, reading back the ones just written
+        deleted = set()
+        for i in range(3000, 4000):
+            f = new_feature(lyr, i)
+            assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+            assert lyr.GetFeature(f.GetFID())["str"] == "value %d" % i
+            if i % 10 == 0:
+                assert lyr.GetFeature(i - 3000)["int"] == i - 3000
+            if i % 13 == 0:
+                assert lyr.DeleteFeature(i - 2000) == ogr.OGRERR_NONE
+                deleted.add(i - 2000)
+
+        # Widen a field and add another one, which rewrite the .dbf
+        fld_defn = ogr.FieldDefn("str", ogr.OFTString)
+        fld_defn.SetWidth(80)
+        assert (
+            lyr.AlterFieldDefn(0, fld_defn, ogr.ALTER_WIDTH_PRECISION_FLAG)
+            == ogr.OGRERR_NONE
+        )
+        lyr.CreateField(ogr.FieldDefn("other", ogr.OFTInteger))
+        for i in range(0, 4000, 101):
+            if i in deleted:
+                continue
+            f = lyr.GetFeature(i)
+            f["str"] = "x" * 80
+            f["other"] = i
+            assert lyr.SetFeature(f) == ogr.OGRERR_NONE
+
+        ds.ExecuteSQL("REPACK test")
+
+        for i in range(4000, 4500):
+            f = new_feature(lyr, i)
+            assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+            if i % 50 == 0:
+                f = lyr.GetFeature(f.GetFID() // 2)
+                set_geom(f, i, 20)
+                assert lyr.SetFeature(f) == ogr.OGRERR_NONE
+
+        # Sequential read in update mode after the writes
+        lyr.ResetReading()
+        count = sum(1 for f in lyr)
+        assert count == lyr.GetFeatureCount()
+
+    ret = {}
+    for ext in ("shp", "shx", "dbf"):
+        f = gdal.VSIFOpenL(filename[0:-3] + ext, "rb")
+        data = gdal.VSIFReadL(1, gdal.VSIStatL(filename[0:-3] + ext).size, f)
+        gdal.VSIFCloseL(f)
+        if ext == "dbf":
+            # Skip the date of last update
+            data = data[0:1] + data[4:]
+        ret[ext] = data
+    return ret
+
+
+def test_ogr_shape_update_interleaved_write_buffer(tmp_vsimem):
+
+    with gdal.config_option("OGR_SHAPE_BUFFER_WRITES", "NO"):
+        expected = _ogr_shape_update_interleaved(
+            str(tmp_vsimem / "unbuffered" / "test.shp")
+        )
+    got = _ogr_shape_update_interleaved(str(tmp_vsimem / "buffered" / "test.shp"))
+    for ext in ("shp", "shx", "dbf"):
+        assert got[ext] == expected[ext], ext
@@ -1604,6 +1604,41 @@ def test_ogr_rfc28_order_by_two_columns():
     ds.ReleaseResultSet(sql_lyr)
 
 
+###############################################################################
+# Test ORDER BY ... LIMIT ... [OFFSET ...] against a full ORDER BY
+
+
+@pytest.mark.parametrize(
+    "order_by", ["int_val", "int_val DESC", "str_val, int_val DESC", "real_val"]
+)
+@pytest.mark.parametrize("limit,offset", [(1, 0), (5, 0), (7, 3), (200, 10)])
+def test_ogr_rfc28_order_by_limit(order_by, limit, offset):
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = ds.CreateLayer("lyr")
+    lyr.CreateField(ogr.FieldDefn("int_val", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("str_val", ogr.OFTString))
+    lyr.CreateField(ogr.FieldDefn("real_val", ogr.OFTReal))
+    for i in range(101):
+        feat = ogr.Feature(lyr.GetLayerDefn())
+        feat["int_val"] = (i * 37) % 11
+        if i % 5 != 0:
+            feat["str_val"] = chr(ord("a") + (i * 7) % 13)
+        if i % 9 != 0:
+            feat["real_val"] = ((i * 13) % 17) * 0.5
+        lyr.CreateFeature(feat)
+
+    with ds.ExecuteSQL(f"SELECT * FROM lyr ORDER BY {order_by}") as sql_lyr:
+        expected = [f.GetFID() for f in sql_lyr][offset : offset + limit]
+
+    with ds.ExecuteSQL(
+        f"SELECT * FROM lyr ORDER BY {order_by} LIMIT {limit} OFFSET {offset}"
+    ) as sql_lyr:
+        assert sql_lyr.GetFeatureCount() == len(expected)
+        got = [f.GetFID() for f in sql_lyr]
+    assert got == expected
+
+
 ###############################################################################
 # Test that date fields stored as ISO-8601 can be used with IN operator
 # Test fix for https://github.com/OSGeo/gdal/issues/3977
@@ -1667,3 +1702,83 @@ def test_ogr_rfc28_in_date_filter():
 
     lyr.SetAttributeFilter("date_slash IN ('2020-12-31', '2020-12-31')")
     _ogr_in_date_filter_check([])
+
+
+###############################################################################
+# Test that attribute filters compiled at SetAttributeFilter() time give the
+# same results as the generic expression evaluator
+
+
+@pytest.mark.parametrize(
+    "where",
+    [
+        "int_field = 3",
+        "3 = int_field",
+        "int_field <> 3",
+        "NOT (int_field = 3)",
+        "int_field < 3 OR int_field > 7",
+        "2 <= int_field AND 6 > int_field",
+        "int_field = 2.5 OR int_field >= 7.0",
+        "int_field BETWEEN 2 AND 5",
+        "int_field BETWEEN 1.5 AND 5.5",
+        "int_field IN (1, 3, 8)",
+        "int_field IN (1, 3.5)",
+        "int_field IS NULL",
+        "int_field IS NOT NULL",
+        "int64_field > 1234567890123",
+        "int64_field IN (1234567890125, 1)",
+        "real_field > 0.25",
+        "real_field = 1",
+        "real_field BETWEEN 0.1 AND 0.5",
+        "real_field IN (0.5, 0.75)",
+        "real_field IN (1, 2)",
+        "str_field = 'Value_3'",
+        "'value_3' < str_field",
+        "str_field <> 'value_3'",
+        "str_field BETWEEN 'value_2' AND 'value_5'",
+        "str_field IN ('value_1', 'VALUE_4')",
+        "str_field LIKE 'value_1%'",
+        "str_field ILIKE 'VALUE_1%'",
+        "str_field LIKE 'value!_1%' ESCAPE '!'",
+        "str_field = '2020-01-01 00:00:00+00'",
+        "bool_field",
+        "NOT bool_field",
+        "FID = 4",
+        "FID IN (1, 7) OR int_field IS NULL",
+        "1 = 1",
+        "1 = 0 OR int_field = 3",
+        "int_field + 1 = 4",
+    ],
+)
+def test_ogr_rfc28_compiled_attribute_filter(where):
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = ds.CreateLayer("test")
+    lyr.CreateField(ogr.FieldDefn("int_field", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("int64_field", ogr.OFTInteger64))
+    lyr.CreateField(ogr.FieldDefn("real_field", ogr.OFTReal))
+    lyr.CreateField(ogr.FieldDefn("str_field", ogr.OFTString))
+    fld_defn = ogr.FieldDefn("bool_field", ogr.OFTInteger)
+    fld_defn.SetSubType(ogr.OFSTBoolean)
+    lyr.CreateField(fld_defn)
+    for i in range(10):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        if i != 5:
+            f["int_field"] = i
+            f["int64_field"] = 1234567890120 + i
+            f["real_field"] = i / 8.0
+            f["str_field"] = "value_%d" % i
+            f["bool_field"] = i % 2
+        else:
+            f.SetFieldNull("int_field")
+            f.SetFieldNull("str_field")
+        lyr.CreateFeature(f)
+
+    def get_fids(compile):
+        with gdal.config_option("OGR_COMPILE_ATTRIBUTE_FILTER", compile):
+            lyr.SetAttributeFilter(where)
+        ret = [f.GetFID() for f in lyr]
+        lyr.SetAttributeFilter(None)
+        return ret
+
+    assert get_fids("YES") == get_fids("NO")
@@ -2477,3 +2477,189 @@ def test_ogr_sql_sqlite_like_utf8():
         dialect="SQLite",
     ) as sql_lyr:
         assert sql_lyr.GetFeatureCount() == 0
+
+
+###############################################################################
+# Test pushing down spatial predicates to the layers
+
+
+def _ogr_sql_sqlite_create_spatial_predicate_ds(driver):
+
+    if driver == "memory":
+        ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    else:
+        ds = ogr.GetDriverByName("ESRI Shapefile").CreateDataSource(
+            "/vsimem/ogr_sql_sqlite_spatial_predicate"
+        )
+
+    lyr = ds.CreateLayer("polys", geom_type=ogr.wkbPolygon)
+    lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    for id, wkt in [
+        (1, "POLYGON((0 0,0 10,10 10,10 0,0 0))"),
+        (2, "POLYGON((20 20,20 30,30 30,30 20,20 20))"),
+        (3, None),
+    ]:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["id"] = id
+        if wkt:
+            f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+
+    lyr = ds.CreateLayer("pts", geom_type=ogr.wkbPoint)
+    lyr.CreateField(ogr.FieldDefn("name", ogr.OFTString))
+    for name, wkt in [
+        ("a", "POINT(5 5)"),
+        ("b", "POINT(25 25)"),
+        ("c", "POINT(50 50)"),
+        ("d", None),
+    ]:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["name"] = name
+        if wkt:
+            f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+
+    if driver == "shape_qix":
+        ds.ExecuteSQL("CREATE SPATIAL INDEX ON polys")
+        ds = None
+        ds = ogr.Open("/vsimem/ogr_sql_sqlite_spatial_predicate")
+
+    return ds
+
+
+@pytest.mark.parametrize("driver", ["memory", "shape_qix"])
+def test_ogr_sql_sqlite_spatial_predicate_pushdown(driver):
+
+    if not ogrtest.has_spatialite:
+        pytest.skip("Spatialite not available")
+
+    ds = _ogr_sql_sqlite_create_spatial_predicate_ds(driver)
+    try:
+        lyr = ds.GetLayerByName("polys")
+        assert lyr.TestCapability(ogr.OLCFastSpatialFilter) == (
+            driver == "shape_qix"
+        )
+
+        # Like with SpatiaLite, the predicate returns -1 for NULL
+        # geometries, so those features match any constraint.
+        with ds.ExecuteSQL(
+            "SELECT pts.name, polys.id FROM pts, polys WHERE "
+            "ST_Intersects(polys.GEOMETRY, pts.GEOMETRY)",
+            dialect="SQLite",
+        ) as sql_lyr:
+            res = sorted((f["name"], f["id"]) for f in sql_lyr)
+        assert res == [
+            ("a", 1),
+            ("a", 3),
+            ("b", 2),
+            ("b", 3),
+            ("c", 3),
+            ("d", 1),
+            ("d", 2),
+            ("d", 3),
+        ]
+
+        with ds.ExecuteSQL(
+            "SELECT pts.name, polys.id FROM pts, polys WHERE "
+            "ST_Intersects(polys.GEOMETRY, pts.GEOMETRY) = 1",
+            dialect="SQLite",
+        ) as sql_lyr:
+            res = sorted((f["name"], f["id"]) for f in sql_lyr)
+        assert res == [("a", 1), ("b", 2)]
+
+        # The spatial filter of the layer is cleared at the end of the query
+        assert lyr.GetSpatialFilter() is None
+        assert lyr.GetFeatureCount() == 3
+        with ds.ExecuteSQL("SELECT COUNT(*) FROM polys", dialect="SQLite") as sql_lyr:
+            assert sql_lyr.GetNextFeature().GetField(0) == 3
+
+        # NULL geometries
+        with ds.ExecuteSQL(
+            "SELECT id, ST_Intersects(GEOMETRY, MakePoint(5, 5)) AS res, "
+            "ST_Intersects(GEOMETRY, NULL) AS res_null FROM polys",
+            dialect="SQLite",
+        ) as sql_lyr:
+            res = sorted((f["id"], f["res"], f["res_null"]) for f in sql_lyr)
+        assert res == [(1, 1, -1), (2, 0, -1), (3, -1, -1)]
+
+        with ds.ExecuteSQL(
+            "SELECT id FROM polys WHERE ST_Intersects(GEOMETRY, NULL)",
+            dialect="SQLite",
+        ) as sql_lyr:
+            assert sorted(f["id"] for f in sql_lyr) == [1, 2, 3]
+
+        # Attribute filter and spatial filter on the same table
+        with ds.ExecuteSQL(
+            "SELECT id FROM polys WHERE id <= 2 AND "
+            "ST_Intersects(GEOMETRY, MakePoint(25, 25))",
+            dialect="SQLite",
+        ) as sql_lyr:
+            assert [f["id"] for f in sql_lyr] == [2]
+
+        with ds.ExecuteSQL(
+            "SELECT id FROM polys WHERE id >= 2 AND "
+            "ST_Intersects(GEOMETRY, MakePoint(5, 5))",
+            dialect="SQLite",
+        ) as sql_lyr:
+            assert [f["id"] for f in sql_lyr] == [3]
+
+        assert lyr.GetSpatialFilter() is None
+
+        # A spatial filter set by the user is restored
+        lyr.SetSpatialFilterRect(-1, -1, 11, 11)
+        with ds.ExecuteSQL(
+            "SELECT pts.name, polys.id FROM pts, polys WHERE "
+            "ST_Intersects(polys.GEOMETRY, pts.GEOMETRY)",
+            dialect="SQLite",
+        ) as sql_lyr:
+            pass
+        assert lyr.GetSpatialFilter() is not None
+        assert lyr.GetSpatialFilter().GetEnvelope() == (-1, 11, -1, 11)
+        assert lyr.GetFeatureCount() == 1
+        lyr.SetSpatialFilter(None)
+
+    finally:
+        ds = None
+        if driver != "memory":
+            ogr.GetDriverByName("ESRI Shapefile").DeleteDataSource(
+                "/vsimem/ogr_sql_sqlite_spatial_predicate"
+            )
+
+
+###############################################################################
+# Test that the envelope cache of a layer without fast spatial filter does
+# not alter its ignored fields
+
+
+def test_ogr_sql_sqlite_spatial_predicate_pushdown_ignored_fields():
+
+    if not ogrtest.has_spatialite:
+        pytest.skip("Spatialite not available")
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbNone)
+    lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    lyr.CreateGeomField(ogr.GeomFieldDefn("geom1", ogr.wkbPoint))
+    lyr.CreateGeomField(ogr.GeomFieldDefn("geom2", ogr.wkbPoint))
+    for i in range(3):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["id"] = i
+        f.SetGeomField(0, ogr.CreateGeometryFromWkt(f"POINT({i} {i})"))
+        f.SetGeomField(1, ogr.CreateGeometryFromWkt(f"POINT({-i} {-i})"))
+        lyr.CreateFeature(f)
+
+    lyr.SetIgnoredFields(["geom2"])
+    lyr.SetAttributeFilter("id >= 1")
+
+    with ds.ExecuteSQL(
+        "SELECT id FROM test WHERE ST_Intersects(geom1, BuildMbr(0.5, 0.5, 2.5, 2.5))",
+        dialect="SQLite",
+    ) as sql_lyr:
+        assert sorted(f["id"] for f in sql_lyr) == [1, 2]
+
+    lyr_defn = lyr.GetLayerDefn()
+    assert not lyr_defn.GetFieldDefn(0).IsIgnored()
+    assert not lyr_defn.GetGeomFieldDefn(0).IsIgnored()
+    assert lyr_defn.GetGeomFieldDefn(1).IsIgnored()
+    assert lyr.GetSpatialFilter() is None
+    assert lyr.GetFeatureCount() == 2
@@ -3973,6 +3973,97 @@ xsi:schemaLocation="http://foo /vsimem/wfs_endpoint?SERVICE=WFS&amp;VERSION=1.1.
                 pytest.fail()
 
 
+###############################################################################
+# Test concurrent prefetching of pages with MAX_CONNECTIONS
+
+
+@pytest.mark.parametrize("numberMatched", ["unknown", "10"])
+@pytest.mark.parametrize("short_page", [False, True])
+@pytest.mark.parametrize("max_connections", ["1", "3"])
+def test_ogr_wfs_vsimem_wfs200_paging_prefetch(
+    tmp_vsimem, numberMatched, short_page, max_connections
+):
+
+    endpoint = str(tmp_vsimem / "wfs200_endpoint_prefetch")
+    gdal.FileFromMemBuffer(
+        endpoint + "?SERVICE=WFS&REQUEST=GetCapabilities",
+        """<WFS_Capabilities version="2.0.0">
+    <OperationsMetadata>
+        <ows:Operation name="GetFeature">
+            <ows:Constraint name="CountDefault">
+                <ows:NoValues/>
+                <ows:DefaultValue>2</ows:DefaultValue>
+            </ows:Constraint>
+        </ows:Operation>
+        <ows:Constraint name="ImplementsResultPaging">
+            <ows:NoValues/><ows:DefaultValue>TRUE</ows:DefaultValue>
+        </ows:Constraint>
+    </OperationsMetadata>
+    <FeatureTypeList>
+        <FeatureType>
+            <Name>my_layer</Name>
+            <DefaultSRS>urn:ogc:def:crs:EPSG::4326</DefaultSRS>
+        </FeatureType>
+    </FeatureTypeList>
+</WFS_Capabilities>
+""",
+    )
+    gdal.FileFromMemBuffer(
+        endpoint
+        + "?SERVICE=WFS&VERSION=2.0.0&REQUEST=DescribeFeatureType&TYPENAME=my_layer",
+        """<xsd:schema xmlns:foo="http://foo" xmlns:gml="http://www.opengis.net/gml" xmlns:xsd="http://www.w3.org/2001/XMLSchema" elementFormDefault="qualified" targetNamespace="http://foo">
+  <xsd:import namespace="http://www.opengis.net/gml" schemaLocation="http://foo/schemas/gml/3.2.1/base/gml.xsd"/>
+  <xsd:complexType name="my_layerType">
+    <xsd:complexContent>
+      <xsd:extension base="gml:AbstractFeatureType">
+        <xsd:sequence>
+          <xsd:element maxOccurs="1" minOccurs="0" name="val" nillable="true" type="xsd:int"/>
+        </xsd:sequence>
+      </xsd:extension>
+    </xsd:complexContent>
+  </xsd:complexType>
+  <xsd:element name="my_layer" substitutionGroup="gml:_Feature" type="foo:my_layerType"/>
+</xsd:schema>
+""",
+    )
+
+    # 10 features, served by pages of 2, except for the page starting at 4
+    # that only has one feature when short_page is set
+    for start in range(11):
+        count = 1 if short_page and start == 4 else 2
+        ids = range(start, min(start + count, 10))
+        members = "".join(
+            f"""
+    <gml:featureMembers>
+        <foo:my_layer gml:id="my_layer.{i}">
+            <foo:val>{i}</foo:val>
+        </foo:my_layer>
+    </gml:featureMembers>"""
+            for i in ids
+        )
+        gdal.FileFromMemBuffer(
+            endpoint
+            + "?SERVICE=WFS&VERSION=2.0.0&REQUEST=GetFeature&TYPENAMES=my_layer"
+            + f"&STARTINDEX={start}&COUNT=2",
+            f"""<wfs:FeatureCollection xmlns:foo="http://foo"
+xmlns:wfs="http://www.opengis.net/wfs"
+xmlns:gml="http://www.opengis.net/gml"
+numberMatched="{numberMatched}" numberReturned="{len(ids)}">{members}
+</wfs:FeatureCollection>
+""",
+        )
+
+    # Worker threads need to see the option too
+    with gdal.config_option("CPL_CURL_ENABLE_VSIMEM", "YES", thread_local=False):
+        ds = gdal.OpenEx(
+            "WFS:" + endpoint, open_options=["MAX_CONNECTIONS=" + max_connections]
+        )
+        lyr = ds.GetLayer(0)
+        for _ in range(2):
+            assert [f["val"] for f in lyr] == list(range(10))
+        ds = None
+
+
 def test_ogr_wfs_vsimem_wfs200_with_no_primary_key(with_and_without_streaming):
     # This server 'supports' paging, but the datasource doesn't have a primary key,
     # so in practice doesn't actually support paging.
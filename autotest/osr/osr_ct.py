@@ -310,6 +310,40 @@ def test_osr_ct_8():
                 pytest.fail("Failed to transform from Pseudo Mercator to LL")
 
 
+###############################################################################
+# Test WGS84 -> WebMercator optimized transform
+
+
+def test_osr_ct_wgs84_to_webmercator():
+
+    src_srs = osr.SpatialReference()
+    src_srs.ImportFromEPSG(4326)
+    src_srs.SetAxisMappingStrategy(osr.OAMS_TRADITIONAL_GIS_ORDER)
+
+    dst_srs = osr.SpatialReference()
+    dst_srs.ImportFromEPSG(3857)
+
+    ct = osr.CoordinateTransformation(src_srs, dst_srs)
+
+    # Includes a longitude out of [-180,180] and a repeated latitude
+    pnts = [(2, 49), (181, 49), (-179, -85), (2, 49)]
+    result = ct.TransformPoints(pnts)
+    expected_result = [
+        (222638.98158654713, 6274861.394006577, 0.0),
+        (-19926188.85199597, 6274861.394006577, 0.0),
+        (-19926188.85199597, -19971868.88040857, 0.0),
+        (222638.98158654713, 6274861.394006577, 0.0),
+    ]
+    for i in range(len(expected_result)):
+        assert result[i] == pytest.approx(expected_result[i], abs=1e-6)
+
+    # Check consistency with the inverse optimized transform
+    ct_inv = osr.CoordinateTransformation(dst_srs, src_srs)
+    x, y, _ = ct_inv.TransformPoint(*result[0][0:2])
+    assert x == pytest.approx(2, abs=1e-12)
+    assert y == pytest.approx(49, abs=1e-12)
+
+
 ###############################################################################
 # Test coordinate transformation where only one CRS has a towgs84 clause (#1156)
 
@@ -225,6 +225,59 @@ def compare_layers(lyr, lyr_ref, excluded_fields=None):
     assert f is None, "more features than expected"
 
 
+###############################################################################
+# Check that GetArrowStream() with GEOMETRY_ENCODING=GEOARROW and
+# GEOARROW_INTERLEAVED returns GeoArrow native geometries, and that they
+# are the ones returned by GetNextFeature() once written by WriteArrowBatch()
+
+
+def check_arrow_stream_geoarrow(lyr):
+    __tracebackhide__ = True
+
+    expected_wkts = []
+    lyr.ResetReading()
+    for f in lyr:
+        g = f.GetGeometryRef()
+        expected_wkts.append(g.ExportToIsoWkt() if g else None)
+
+    geom_field_name = lyr.GetGeometryColumn() or "wkb_geometry"
+    options_list = [
+        ["INCLUDE_FID=NO", "GEOMETRY_ENCODING=GEOARROW"],
+        ["INCLUDE_FID=NO", "GEOMETRY_ENCODING=GEOARROW_INTERLEAVED"],
+    ]
+    for options in options_list:
+        try:
+            import pyarrow  # noqa: F401
+
+            stream = lyr.GetArrowStreamAsPyArrow(options)
+            md = stream.schema[geom_field_name].metadata
+            ext_name = md[b"ARROW:extension:name"].decode("utf-8")
+            assert ext_name.startswith("geoarrow."), ext_name
+            assert ext_name != "geoarrow.wkb"
+            del stream
+        except ImportError:
+            pass
+
+        ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+        dst_lyr = ds.CreateLayer("dst", geom_type=lyr.GetGeomType())
+        stream = lyr.GetArrowStream(options)
+        schema = stream.GetSchema()
+        success, error_msg = dst_lyr.IsArrowSchemaSupported(schema)
+        assert success, error_msg
+        while True:
+            array = stream.GetNextRecordBatch()
+            if array is None:
+                break
+            assert dst_lyr.WriteArrowBatch(schema, array) == ogr.OGRERR_NONE
+        del stream
+
+        got_wkts = []
+        for f in dst_lyr:
+            g = f.GetGeometryRef()
+            got_wkts.append(g.ExportToIsoWkt() if g else None)
+        assert got_wkts == expected_wkts, options
+
+
 ###############################################################################
 
 
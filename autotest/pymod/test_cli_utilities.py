@@ -282,3 +282,19 @@ def get_gdal_viewshed_path():
 
 def get_gdal_footprint_path():
     return get_cli_utility_path("gdal_footprint")
+
+
+###############################################################################
+#
+
+
+def get_gdal_zonalstats_path():
+    return get_cli_utility_path("gdal_zonalstats")
+
+
+###############################################################################
+#
+
+
+def get_gdal_tiler_path():
+    return get_cli_utility_path("gdal_tiler")
@@ -338,6 +338,69 @@ def test_gdal_footprint_lib_ovr():
     ogrtest.check_feature_geometry(f, "MULTIPOLYGON (((0 0,0 2,1.5 2.0,1.5 0.0,0 0)))")
 
 
+###############################################################################
+# Test -accuracy
+
+
+def test_gdal_footprint_lib_accuracy():
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 100, 80, 1)
+    src_ds.GetRasterBand(1).SetNoDataValue(0)
+    src_ds.GetRasterBand(1).WriteRaster(16, 16, 64, 48, b"\xFF" * (64 * 48))
+    src_ds.BuildOverviews("NONE", [2, 4])
+    ovr_band = src_ds.GetRasterBand(1).GetOverview(0)
+    ovr_band.WriteRaster(8, 8, 32, 24, b"\xFF" * (32 * 24))
+    # Make the 4x overview differ from the full resolution data, to check
+    # when it is used
+    ovr_band = src_ds.GetRasterBand(1).GetOverview(1)
+    ovr_band.WriteRaster(4, 4, 16, 12, b"\xFF" * (16 * 12))
+    ovr_band.WriteRaster(0, 0, 2, 2, b"\xFF" * 4)
+
+    def get_footprint(**kwargs):
+        out_ds = gdal.Footprint(
+            "", src_ds, format="Memory", targetCoordinateSystem="pixel", **kwargs
+        )
+        f = out_ds.GetLayer(0).GetNextFeature()
+        return f.GetGeometryRef().Clone()
+
+    # Full resolution
+    for accuracy in (None, 1):
+        g = get_footprint(accuracy=accuracy)
+        assert g.GetEnvelope() == (16, 80, 16, 64)
+        assert g.GetArea() == 64 * 48
+
+    # Overview with a downsampling factor of 2
+    g = get_footprint(accuracy=3)
+    assert g.GetEnvelope() == (16, 80, 16, 64)
+    assert g.GetArea() == 64 * 48
+
+    # Overview with a downsampling factor of 4
+    g = get_footprint(accuracy=4)
+    assert g.GetEnvelope() == (0, 80, 0, 64)
+    assert g.GetArea() == 8 * 8 + 64 * 48
+
+    # Overview with a downsampling factor of 4, further subsampled by 2
+    g = get_footprint(accuracy=8)
+    minx, maxx, miny, maxy = g.GetEnvelope()
+    assert minx == 0 and miny == 0
+    assert maxx == pytest.approx(80, abs=8)
+    assert maxy == pytest.approx(64, abs=8)
+    assert g.GetArea() == pytest.approx(8 * 8 + 64 * 48, rel=0.3)
+
+    # Explicit overview index takes precedence, and is not subsampled
+    g = get_footprint(accuracy=8, ovr=0)
+    assert g.GetEnvelope() == (16, 80, 16, 64)
+    assert g.GetArea() == 64 * 48
+
+    # Overviews are not used with -srcnodata, but the mask is subsampled
+    g = get_footprint(accuracy=4, srcNodata=0)
+    minx, maxx, miny, maxy = g.GetEnvelope()
+    assert minx == pytest.approx(16, abs=4)
+    assert maxx == pytest.approx(80, abs=4)
+    assert miny == pytest.approx(16, abs=4)
+    assert maxy == pytest.approx(64, abs=4)
+
+
 ###############################################################################
 #
 
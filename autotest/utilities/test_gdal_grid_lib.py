@@ -1034,6 +1034,40 @@ def test_gdal_grid_lib_skip_nan_zvalue():
     )
 
 
+###############################################################################
+# Test that searching points through the point index gives the same result
+# as the exhaustive scan, for an (optionally rotated) search ellipse
+
+
+@pytest.mark.parametrize(
+    "algorithm",
+    [
+        "invdist:radius1=0.05:radius2=0.03",
+        "invdist:radius1=0.05:radius2=0.03:angle=30:max_points=5",
+        "invdist:radius1=0.05:radius2=0.05:smoothing=0.01:min_points=3",
+    ],
+)
+def test_gdal_grid_lib_invdist_point_index(n43_shp, algorithm):
+    def grid():
+        ds = gdal.Grid(
+            "",
+            n43_shp.GetDescription(),
+            format="MEM",
+            outputBounds=[-80.0041667, 42.9958333, -78.9958333, 44.0041667],
+            width=100,
+            height=100,
+            outputType=gdal.GDT_Float32,
+            algorithm=algorithm,
+        )
+        return ds.GetRasterBand(1).ReadRaster()
+
+    with gdal.config_option("GDAL_GRID_POINT_COUNT_THRESHOLD", "1000000000"):
+        ref = grid()
+    with gdal.config_option("GDAL_GRID_POINT_COUNT_THRESHOLD", "0"):
+        got = grid()
+    assert got == ref
+
+
 ###############################################################################
 # Test option argument handling
 
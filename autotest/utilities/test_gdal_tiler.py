@@ -0,0 +1,332 @@
+#!/usr/bin/env pytest
+# -*- coding: utf-8 -*-
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  gdal_tiler testing
+#
+###############################################################################
+# Copyright (c) 2024, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import os
+import shutil
+
+import gdaltest
+import pytest
+import test_cli_utilities
+
+from osgeo import gdal, osr
+
+pytestmark = [
+    pytest.mark.require_driver("PNG"),
+    pytest.mark.skipif(
+        test_cli_utilities.get_gdal_tiler_path() is None,
+        reason="gdal_tiler not available",
+    ),
+]
+
+
+@pytest.fixture()
+def gdal_tiler_path():
+    return test_cli_utilities.get_gdal_tiler_path()
+
+
+###############################################################################
+# Create a RGB raster covering the whole world in EPSG:4326, that gives 1, 4
+# and 16 tiles at zoom levels 0, 1 and 2 of GoogleMapsCompatible
+
+
+@pytest.fixture(scope="module")
+def tiler_src(tmp_path_factory):
+
+    src_filename = str(tmp_path_factory.mktemp("gdal_tiler") / "src.tif")
+    ds = gdal.GetDriverByName("GTiff").Create(src_filename, 360, 170, 3)
+    ds.SetGeoTransform([-180, 1, 0, 85, 0, -1])
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(4326)
+    ds.SetSpatialRef(srs)
+    for b in range(3):
+        ds.GetRasterBand(b + 1).WriteRaster(
+            0,
+            0,
+            360,
+            170,
+            bytes((x * (b + 1) + y * 3) % 256 for y in range(170) for x in range(360)),
+        )
+    ds = None
+    return src_filename
+
+
+def _run(gdal_tiler_path, options, src_filename, dst_filename, expect_error=False):
+
+    (_, err) = gdaltest.runexternal_out_and_err(
+        f"{gdal_tiler_path} -q {options} {src_filename} {dst_filename}"
+    )
+    if expect_error:
+        assert err
+    else:
+        assert err is None or err == "", f"got error/warning {err}"
+    return err
+
+
+def _read_dir_tiles(dirname, ext="png"):
+
+    tiles = {}
+    for z in os.listdir(dirname):
+        if not z.isdigit():
+            continue
+        for x in os.listdir(os.path.join(dirname, z)):
+            for filename in os.listdir(os.path.join(dirname, z, x)):
+                assert filename.endswith("." + ext)
+                y = filename[: -len(ext) - 1]
+                with open(os.path.join(dirname, z, x, filename), "rb") as f:
+                    tiles[(int(z), int(x), int(y))] = f.read()
+    return tiles
+
+
+def _read_mbtiles_tiles(filename):
+
+    ds = gdal.OpenEx(filename, gdal.OF_VECTOR, allowed_drivers=["SQLite"])
+    tiles = {}
+    with ds.ExecuteSQL(
+        "SELECT zoom_level, tile_column, tile_row, tile_data FROM tiles"
+    ) as lyr:
+        for f in lyr:
+            z = f["zoom_level"]
+            # MBTiles rows are numbered from the bottom
+            y = (1 << z) - 1 - f["tile_row"]
+            tiles[(z, f["tile_column"], y)] = f.GetFieldAsBinary("tile_data")
+    return tiles
+
+
+def _read_pmtiles_tiles(filename, expected_keys, ext):
+
+    tiles = {}
+    for z, x, y in expected_keys:
+        tile_filename = f"/vsipmtiles/{filename}/{z}/{x}/{y}.{ext}"
+        stat = gdal.VSIStatL(tile_filename)
+        assert stat, tile_filename
+        f = gdal.VSIFOpenL(tile_filename, "rb")
+        try:
+            tiles[(z, x, y)] = gdal.VSIFReadL(1, stat.size, f)
+        finally:
+            gdal.VSIFCloseL(f)
+    return tiles
+
+
+###############################################################################
+# Test directory output
+
+
+def test_gdal_tiler_dir(gdal_tiler_path, tiler_src, tmp_path):
+
+    dst_dirname = str(tmp_path / "out")
+    _run(gdal_tiler_path, "-z 0-2", tiler_src, dst_dirname)
+
+    tiles = _read_dir_tiles(dst_dirname)
+    assert sorted(tiles.keys()) == [(0, 0, 0)] + [
+        (z, x, y) for z in (1, 2) for x in range(1 << z) for y in range(1 << z)
+    ]
+    ds = gdal.Open(os.path.join(dst_dirname, "2", "1", "1.png"))
+    assert ds.GetDriver().ShortName == "PNG"
+    assert ds.RasterXSize == 256
+    assert ds.RasterYSize == 256
+    assert ds.RasterCount == 4
+    assert ds.GetRasterBand(4).ComputeRasterMinMax() == (255, 255)
+    assert not os.path.exists(os.path.join(dst_dirname, ".gdal_tiler_progress"))
+
+    # The output cannot be overwritten without -resume
+    err = _run(gdal_tiler_path, "-z 0-2", tiler_src, dst_dirname, expect_error=True)
+    assert "already exists" in err
+
+    # Same result with several threads, and smaller metatiles
+    dst_dirname_mt = str(tmp_path / "out_mt")
+    _run(gdal_tiler_path, "-z 0-2 -j 4 -metatile 2", tiler_src, dst_dirname_mt)
+    assert _read_dir_tiles(dst_dirname_mt) == tiles
+
+
+###############################################################################
+# Test selection of the zoom levels
+
+
+@pytest.mark.parametrize(
+    "zoom,expected_zooms", [("1-2", [1, 2]), ("1", [0, 1]), ("2-2", [2])]
+)
+def test_gdal_tiler_zoom_range(
+    gdal_tiler_path, tiler_src, tmp_path, zoom, expected_zooms
+):
+
+    dst_dirname = str(tmp_path / "out")
+    _run(gdal_tiler_path, f"-z {zoom}", tiler_src, dst_dirname)
+    tiles = _read_dir_tiles(dst_dirname)
+    assert sorted(set(z for z, _, _ in tiles.keys())) == expected_zooms
+    assert len(tiles) == sum(1 << (2 * z) for z in expected_zooms)
+
+
+###############################################################################
+# Test MBTiles output
+
+
+@pytest.mark.require_driver("MBTiles")
+def test_gdal_tiler_mbtiles(gdal_tiler_path, tiler_src, tmp_path):
+
+    dst_dirname = str(tmp_path / "out")
+    _run(gdal_tiler_path, "-z 0-2", tiler_src, dst_dirname)
+
+    dst_filename = str(tmp_path / "out.mbtiles")
+    _run(gdal_tiler_path, "-z 0-2", tiler_src, dst_filename)
+
+    # Same tiles as in directory output
+    assert _read_mbtiles_tiles(dst_filename) == _read_dir_tiles(dst_dirname)
+
+    ds = gdal.OpenEx(dst_filename, gdal.OF_VECTOR, allowed_drivers=["SQLite"])
+    assert ds.GetLayerByName("gdal_tiler_progress") is None
+    with ds.ExecuteSQL("SELECT name, value FROM metadata") as lyr:
+        md = {f["name"]: f["value"] for f in lyr}
+    assert md["format"] == "png"
+    assert md["minzoom"] == "0"
+    assert md["maxzoom"] == "2"
+    ds = None
+
+    ds = gdal.Open(dst_filename)
+    assert ds.GetDriver().ShortName == "MBTiles"
+    assert ds.RasterCount == 4
+
+
+###############################################################################
+# Test PMTiles output, with raster tiles
+
+
+@pytest.mark.require_driver("MBTiles")
+@pytest.mark.require_driver("PMTiles")
+@pytest.mark.parametrize(
+    "tile_format,ext", [("PNG", "png"), ("JPEG", "jpg"), ("WEBP", "webp")]
+)
+def test_gdal_tiler_pmtiles(gdal_tiler_path, tiler_src, tmp_path, tile_format, ext):
+
+    if gdal.GetDriverByName(tile_format) is None:
+        pytest.skip(f"{tile_format} driver not available")
+
+    options = f"-z 0-2 -tile_format {tile_format}"
+    mbtiles_filename = str(tmp_path / "out.mbtiles")
+    _run(gdal_tiler_path, options, tiler_src, mbtiles_filename)
+    expected_tiles = _read_mbtiles_tiles(mbtiles_filename)
+    assert len(expected_tiles) == 21
+
+    dst_filename = str(tmp_path / "out.pmtiles")
+    _run(gdal_tiler_path, options, tiler_src, dst_filename)
+    assert not os.path.exists(dst_filename + ".partial.mbtiles")
+
+    assert (
+        _read_pmtiles_tiles(dst_filename, expected_tiles.keys(), ext) == expected_tiles
+    )
+    ds = gdal.Open(f"/vsipmtiles/{dst_filename}/2/1/1.{ext}")
+    assert ds.GetDriver().ShortName == tile_format
+    assert ds.RasterXSize == 256
+
+    # The output cannot be overwritten
+    err = _run(gdal_tiler_path, options, tiler_src, dst_filename, expect_error=True)
+    assert "already exists" in err
+
+
+###############################################################################
+# Test -resume from the .gdal_tiler_progress file of a directory output
+
+
+def test_gdal_tiler_resume_dir(gdal_tiler_path, tiler_src, tmp_path):
+
+    ref_dirname = str(tmp_path / "ref")
+    _run(gdal_tiler_path, "-z 0-2 -metatile 1", tiler_src, ref_dirname)
+    ref_tiles = _read_dir_tiles(ref_dirname)
+
+    # Simulate a run interrupted once the metatile of tile 2/1/1 was
+    # completed
+    dst_dirname = str(tmp_path / "out")
+    shutil.copytree(ref_dirname, dst_dirname)
+    done_tile = os.path.join(dst_dirname, "2", "1", "1.png")
+    for z, x, y in ref_tiles:
+        if (z, x, y) != (2, 1, 1):
+            os.unlink(os.path.join(dst_dirname, str(z), str(x), f"{y}.png"))
+    os.utime(done_tile, (1000000000, 1000000000))
+    with open(os.path.join(dst_dirname, ".gdal_tiler_progress"), "wt") as f:
+        f.write("2 1 1\n")
+
+    _run(gdal_tiler_path, "-z 0-2 -metatile 1 -resume", tiler_src, dst_dirname)
+
+    # The completed tile is not written again, but is used for the lower
+    # zoom levels
+    assert os.stat(done_tile).st_mtime == 1000000000
+    assert _read_dir_tiles(dst_dirname) == ref_tiles
+    assert not os.path.exists(os.path.join(dst_dirname, ".gdal_tiler_progress"))
+
+
+###############################################################################
+# Test -resume from the gdal_tiler_progress table of a MBTiles output
+
+
+@pytest.mark.require_driver("MBTiles")
+def test_gdal_tiler_resume_mbtiles(gdal_tiler_path, tiler_src, tmp_path):
+
+    ref_filename = str(tmp_path / "ref.mbtiles")
+    _run(gdal_tiler_path, "-z 0-2 -metatile 1", tiler_src, ref_filename)
+    ref_tiles = _read_mbtiles_tiles(ref_filename)
+
+    # Simulate a run interrupted once the metatile of tile 2/1/1 was
+    # completed
+    dst_filename = str(tmp_path / "out.mbtiles")
+    shutil.copy(ref_filename, dst_filename)
+    ds = gdal.OpenEx(
+        dst_filename, gdal.OF_VECTOR | gdal.OF_UPDATE, allowed_drivers=["SQLite"]
+    )
+    ds.ExecuteSQL(
+        "CREATE TABLE gdal_tiler_progress (zoom_level INTEGER, "
+        "tile_column INTEGER, tile_row INTEGER)"
+    )
+    ds.ExecuteSQL("INSERT INTO gdal_tiler_progress VALUES (2, 1, 1)")
+    # MBTiles row of tile 2/1/1 is 2
+    ds.ExecuteSQL(
+        "DELETE FROM tiles WHERE NOT "
+        "(zoom_level = 2 AND tile_column = 1 AND tile_row = 2)"
+    )
+    ds.ExecuteSQL("DELETE FROM metadata")
+    ds = None
+
+    # Without -resume, the existing file is an error
+    err = _run(
+        gdal_tiler_path,
+        "-z 0-2 -metatile 1",
+        tiler_src,
+        dst_filename,
+        expect_error=True,
+    )
+    assert "already exists" in err
+
+    # The completed tile is not inserted again, which would fail because of
+    # the unique index on tiles
+    _run(gdal_tiler_path, "-z 0-2 -metatile 1 -resume", tiler_src, dst_filename)
+
+    assert _read_mbtiles_tiles(dst_filename) == ref_tiles
+    ds = gdal.OpenEx(dst_filename, gdal.OF_VECTOR, allowed_drivers=["SQLite"])
+    assert ds.GetLayerByName("gdal_tiler_progress") is None
+    with ds.ExecuteSQL("SELECT COUNT(*) FROM metadata") as lyr:
+        assert lyr.GetNextFeature().GetField(0) > 0
@@ -162,7 +162,8 @@ def test_gdal_viewshed_alternative_modes(gdal_viewshed_path, tmp_path, viewshed_
 ###############################################################################
 
 
-def test_gdal_viewshed_api(viewshed_input):
+@pytest.mark.parametrize("num_threads", ["1", "2", "4"])
+def test_gdal_viewshed_api(viewshed_input, num_threads):
     src_ds = gdal.Open(viewshed_input)
     ds = gdal.ViewshedGenerate(
         src_ds.GetRasterBand(1),
@@ -181,7 +182,7 @@ def test_gdal_viewshed_api(viewshed_input):
         gdal.GVM_Edge,
         0,  # maxDistance
         heightMode=gdal.GVOT_MIN_TARGET_HEIGHT_FROM_GROUND,
-        options=["UNUSED=YES"],
+        options=["UNUSED=YES", "NUM_THREADS=" + num_threads],
     )
 
     assert ds.GetRasterBand(1).Checksum() == 8381
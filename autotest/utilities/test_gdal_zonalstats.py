@@ -0,0 +1,235 @@
+#!/usr/bin/env pytest
+# -*- coding: utf-8 -*-
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  gdal_zonalstats testing
+#
+###############################################################################
+# Copyright (c) 2024, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import gdaltest
+import pytest
+import test_cli_utilities
+
+from osgeo import gdal, ogr
+
+pytestmark = pytest.mark.skipif(
+    test_cli_utilities.get_gdal_zonalstats_path() is None,
+    reason="gdal_zonalstats not available",
+)
+
+
+@pytest.fixture()
+def gdal_zonalstats_path():
+    return test_cli_utilities.get_gdal_zonalstats_path()
+
+
+###############################################################################
+# Create a 10x10 raster whose pixel (x,y) has value 10 * y + x, and a layer
+# of zones
+
+
+@pytest.fixture()
+def zonalstats_inputs(tmp_path):
+
+    src_filename = str(tmp_path / "src.tif")
+    ds = gdal.GetDriverByName("GTiff").Create(src_filename, 10, 10)
+    ds.SetGeoTransform([0, 1, 0, 10, 0, -1])
+    ds.GetRasterBand(1).WriteRaster(0, 0, 10, 10, bytes(range(100)))
+    ds = None
+
+    zones_filename = str(tmp_path / "zones.geojson")
+    ds = ogr.GetDriverByName("GeoJSON").CreateDataSource(zones_filename)
+    lyr = ds.CreateLayer("zones", geom_type=ogr.wkbPolygon)
+    lyr.CreateField(ogr.FieldDefn("name", ogr.OFTString))
+    for name, wkt in [
+        # Pixel coordinates from 2.6 to 4.4 in both directions
+        ("small", "POLYGON((2.6 7.4,4.4 7.4,4.4 5.6,2.6 5.6,2.6 7.4))"),
+        # Pixels (2..4, 2..4)
+        ("aligned", "POLYGON((2 8,5 8,5 5,2 5,2 8))"),
+    ]:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["name"] = name
+        f.SetGeometry(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+    ds = None
+
+    return src_filename, zones_filename
+
+
+def _run(gdal_zonalstats_path, options, src_filename, zones_filename, tmp_path):
+
+    dst_filename = str(tmp_path / "out.geojson")
+    gdal.Unlink(dst_filename)
+    (_, err) = gdaltest.runexternal_out_and_err(
+        f"{gdal_zonalstats_path} -q {options} {src_filename} "
+        f"{zones_filename} {dst_filename}"
+    )
+    assert err is None or err == "", f"got error/warning {err}"
+    ds = ogr.Open(dst_filename)
+    assert ds is not None
+    lyr = ds.GetLayer(0)
+    return ds, [f for f in lyr]
+
+
+###############################################################################
+
+
+def test_gdal_zonalstats_center(gdal_zonalstats_path, zonalstats_inputs, tmp_path):
+
+    ds, features = _run(gdal_zonalstats_path, "", *zonalstats_inputs, tmp_path)
+    assert len(features) == 2
+    assert features[0]["name"] == "small"
+    assert features[0]["count"] == 1
+    assert features[0]["mean"] == 33
+    assert features[1]["name"] == "aligned"
+    assert features[1]["count"] == 9
+    assert features[1]["sum"] == 297
+    assert features[1]["mean"] == 33
+    assert features[1]["min"] == 22
+    assert features[1]["max"] == 44
+    assert features[0].GetGeometryRef() is None
+
+
+###############################################################################
+
+
+def test_gdal_zonalstats_all_touched(
+    gdal_zonalstats_path, zonalstats_inputs, tmp_path
+):
+
+    ds, features = _run(
+        gdal_zonalstats_path, "-all_touched", *zonalstats_inputs, tmp_path
+    )
+    assert features[0]["count"] == 9
+    assert features[0]["sum"] == 297
+
+
+###############################################################################
+
+
+def test_gdal_zonalstats_fractional(
+    gdal_zonalstats_path, zonalstats_inputs, tmp_path
+):
+
+    ds, features = _run(
+        gdal_zonalstats_path, "-fractional", *zonalstats_inputs, tmp_path
+    )
+    # 3 of 8 sub-pixels of the border pixels are covered in each direction
+    assert features[0]["count"] == pytest.approx(1.75 * 1.75)
+    assert features[0]["mean"] == pytest.approx(33)
+    assert features[1]["count"] == pytest.approx(9)
+
+    (_, err) = gdaltest.runexternal_out_and_err(
+        f"{gdal_zonalstats_path} -q -fractional -all_touched "
+        f"{zonalstats_inputs[0]} {zonalstats_inputs[1]} "
+        f"{tmp_path}/out2.geojson"
+    )
+    assert "mutually exclusive" in err
+
+
+###############################################################################
+
+
+def test_gdal_zonalstats_histogram(
+    gdal_zonalstats_path, zonalstats_inputs, tmp_path
+):
+
+    ds, features = _run(
+        gdal_zonalstats_path,
+        "-stats count,histogram -hist_bins 4 -hist_min 0 -hist_max 100",
+        *zonalstats_inputs,
+        tmp_path,
+    )
+    assert features[0]["histogram"] == "0,1,0,0"
+    assert features[1]["histogram"] == "3,6,0,0"
+    assert features[1].GetFieldIndex("mean") < 0
+
+
+###############################################################################
+
+
+def test_gdal_zonalstats_keep_geom(
+    gdal_zonalstats_path, zonalstats_inputs, tmp_path
+):
+
+    ds, features = _run(
+        gdal_zonalstats_path, "-stats mean -keep_geom", *zonalstats_inputs, tmp_path
+    )
+    assert features[1]["name"] == "aligned"
+    assert features[1].GetGeometryRef().GetArea() == 9
+
+
+###############################################################################
+
+
+def test_gdal_zonalstats_multithreaded(gdal_zonalstats_path, tmp_path):
+
+    src_filename = str(tmp_path / "src.tif")
+    gdal.Translate(
+        src_filename,
+        "../gcore/data/byte.tif",
+        width=1000,
+        height=1000,
+        resampleAlg=gdal.GRIORA_Bilinear,
+        creationOptions=["BLOCKYSIZE=1000"],
+    )
+
+    zones_filename = str(tmp_path / "zones.geojson")
+    src_ds = gdal.Open(src_filename)
+    gt = src_ds.GetGeoTransform()
+    srs = src_ds.GetSpatialRef()
+    src_ds = None
+    ds = ogr.GetDriverByName("GeoJSON").CreateDataSource(zones_filename)
+    lyr = ds.CreateLayer("zones", srs=srs, geom_type=ogr.wkbPolygon)
+    for i in range(100):
+        x = gt[0] + ((i * 137) % 900) * gt[1]
+        y = gt[3] + ((i * 251) % 900) * gt[5]
+        size = (10 + (i * 31) % 290) * gt[1]
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetGeometry(
+            ogr.CreateGeometryFromWkt(
+                f"POLYGON(({x} {y},{x + size / 3} {y - size},"
+                f"{x + size} {y - size / 2},{x} {y}))"
+            )
+        )
+        lyr.CreateFeature(f)
+    ds = None
+
+    def get_results(options):
+        ds, features = _run(
+            gdal_zonalstats_path,
+            options + " -stats count,sum,min,max,histogram",
+            src_filename,
+            zones_filename,
+            tmp_path,
+        )
+        return [
+            [f.GetField(i) for i in range(f.GetFieldCount())] for f in features
+        ]
+
+    for coverage in ("", "-all_touched", "-fractional"):
+        ref = get_results(coverage + " -j 1")
+        assert len(ref) == 100
+        assert get_results(coverage + " -j 4") == ref
@@ -748,3 +748,79 @@ def test_gdalbuildvrt_lib_stable_average():
     vrt_gt = vrt_ds.GetGeoTransform()
 
     assert vrt_gt == gt
+
+
+###############################################################################
+# Test -of GTI
+
+
+@pytest.mark.require_driver("GPKG")
+@pytest.mark.require_driver("GTI")
+def test_gdalbuildvrt_lib_of_gti(tmp_vsimem):
+
+    src_filenames = []
+    for i in range(3):
+        src_filename = str(tmp_vsimem / f"src{i}.tif")
+        src_ds = gdal.GetDriverByName("GTiff").Create(src_filename, 2, 2, 2)
+        src_ds.SetGeoTransform([2 * i, 1, 0, 49, 0, -1])
+        src_ds.GetRasterBand(1).SetNoDataValue(255)
+        src_ds.GetRasterBand(1).Fill(i + 1)
+        src_ds.GetRasterBand(2).SetNoDataValue(255)
+        src_ds.GetRasterBand(2).Fill(i + 10)
+        src_ds = None
+        src_filenames.append(src_filename)
+
+    out_filename = str(tmp_vsimem / "out.gti.gpkg")
+    gdal.BuildVRT(out_filename, src_filenames, format="GTI", resampleAlg="bilinear")
+
+    vrt_ds = gdal.BuildVRT("", src_filenames)
+    ds = gdal.Open(out_filename)
+    assert ds.GetDriver().ShortName == "GTI"
+    assert ds.RasterXSize == vrt_ds.RasterXSize
+    assert ds.RasterYSize == vrt_ds.RasterYSize
+    assert ds.GetGeoTransform() == pytest.approx(vrt_ds.GetGeoTransform())
+    assert ds.RasterCount == 2
+    assert ds.GetRasterBand(1).GetNoDataValue() == 255
+    assert ds.ReadRaster() == vrt_ds.ReadRaster()
+    ds = None
+
+    with gdal.OpenEx(out_filename, gdal.OF_VECTOR) as ds:
+        lyr = ds.GetLayer(0)
+        assert lyr.GetFeatureCount() == 3
+        assert lyr.GetMetadataItem("RESAMPLING") == "bilinear"
+
+    with pytest.raises(Exception, match="not compatible with -of GTI"):
+        gdal.BuildVRT(out_filename, src_filenames, format="GTI", separate=True)
+
+    with pytest.raises(Exception, match="Output format"):
+        gdal.BuildVRT(out_filename, src_filenames, format="GTiff")
+
+
+###############################################################################
+# Test opening sources concurrently
+
+
+def test_gdalbuildvrt_lib_num_threads(tmp_vsimem):
+
+    src_filenames = []
+    for i in range(20):
+        src_filename = str(tmp_vsimem / f"src{i}.tif")
+        src_ds = gdal.GetDriverByName("GTiff").Create(src_filename, 2, 2)
+        src_ds.SetGeoTransform([2 * i, 1, 0, 49, 0, -1])
+        src_ds.GetRasterBand(1).Fill(i)
+        src_ds = None
+        src_filenames.append(src_filename)
+    src_filenames.insert(5, str(tmp_vsimem / "non_existing.tif"))
+
+    with gdal.quiet_errors():
+        ref_ds = gdal.BuildVRT("", src_filenames)
+    ref_xml = ref_ds.GetMetadata("xml:VRT")[0]
+
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        with gdal.quiet_errors():
+            gdal.ErrorReset()
+            ds = gdal.BuildVRT("", src_filenames)
+            # Warnings are emitted from the calling thread
+            assert "non_existing.tif" in gdal.GetLastErrorMsg()
+    assert ds.GetMetadata("xml:VRT")[0] == ref_xml
+    assert ds.ReadRaster() == ref_ds.ReadRaster()
@@ -715,3 +715,35 @@ def test_gdaldem_lib_dict_arguments():
     ind = opt.index("-co")
 
     assert opt[ind : ind + 4] == ["-co", "COMPRESS=DEFLATE", "-co", "LEVEL=4"]
+
+
+###############################################################################
+# Test that multi-threaded processing gives the same results as single-threaded
+
+
+@pytest.mark.parametrize(
+    "processing,options",
+    [
+        ("hillshade", {"zFactor": 30}),
+        ("hillshade", {"zFactor": 30, "computeEdges": True}),
+        ("slope", {}),
+        ("aspect", {}),
+        ("TRI", {}),
+        ("roughness", {}),
+        ("color-relief", {"colorFilename": "data/color_file.txt"}),
+    ],
+)
+def test_gdaldem_lib_num_threads(processing, options):
+
+    src_ds = gdal.Translate(
+        "", "../gdrivers/data/n43.tif", format="MEM", width=500, height=1000
+    )
+
+    def checksums():
+        ds = gdal.DEMProcessing("", src_ds, processing, format="MEM", **options)
+        return [ds.GetRasterBand(i + 1).Checksum() for i in range(ds.RasterCount)]
+
+    with gdal.config_option("GDAL_NUM_THREADS", "1"):
+        expected_cs = checksums()
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        assert checksums() == expected_cs
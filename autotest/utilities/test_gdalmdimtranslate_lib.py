@@ -913,6 +913,50 @@ def test_gdalmdimtranslate_array_resample():
     assert struct.unpack("d" * 3, lon.Read()) == (1.5, 2.5, 3.5)
 
 
+###############################################################################
+# Test copying an array to an array with a different block size, with several
+# copy windows
+
+
+@pytest.mark.require_driver("ZARR")
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_gdalmdimtranslate_rechunking(tmp_vsimem, num_threads):
+
+    src_filename = str(tmp_vsimem / "src.zarr")
+    ds = gdal.GetDriverByName("Zarr").CreateMultiDimensional(src_filename)
+    rg = ds.GetRootGroup()
+    dims = [
+        rg.CreateDimension("time", None, None, 5),
+        rg.CreateDimension("y", None, None, 40),
+        rg.CreateDimension("x", None, None, 60),
+    ]
+    ar = rg.CreateMDArray(
+        "ar",
+        dims,
+        gdal.ExtendedDataType.Create(gdal.GDT_Int16),
+        ["BLOCKSIZE=1,20,30"],
+    )
+    values = [(i * 7) % 32749 for i in range(5 * 40 * 60)]
+    assert ar.Write(struct.pack("h" * len(values), *values)) == gdal.CE_None
+    ds = None
+
+    dst_filename = str(tmp_vsimem / "dst.zarr")
+    with gdaltest.config_options(
+        {"GDAL_SWATH_SIZE": "20000", "GDAL_NUM_THREADS": num_threads}
+    ):
+        assert gdal.MultiDimTranslate(
+            dst_filename,
+            src_filename,
+            format="Zarr",
+            creationOptions=["ARRAY:BLOCKSIZE=5,8,12"],
+        )
+
+    ds = gdal.OpenEx(dst_filename, gdal.OF_MULTIDIM_RASTER)
+    ar = ds.GetRootGroup().OpenMDArray("ar")
+    assert ar.GetBlockSize() == [5, 8, 12]
+    assert struct.unpack("h" * len(values), ar.Read()) == tuple(values)
+
+
 def XXXX_test_all():
     while True:
         test_gdalmdimtranslate_no_arg()
@@ -103,6 +103,22 @@ def test_gdaltindex_lib_basic(four_tile_index):
         ), "i=%d, wkt=%s" % (i, feat.GetGeometryRef().ExportToWkt())
 
 
+###############################################################################
+# Test opening rasters concurrently
+
+
+def test_gdaltindex_lib_num_threads(four_tiles, tmp_path):
+
+    index_filename = str(tmp_path / "tileindex.shp")
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        gdal.TileIndex(index_filename, four_tiles * 3)
+
+    ds = ogr.Open(index_filename)
+    lyr = ds.GetLayer(0)
+    # Records are written in the order of the input files
+    assert [f["location"] for f in lyr] == four_tiles * 3
+
+
 ###############################################################################
 # Try adding the same rasters again
 
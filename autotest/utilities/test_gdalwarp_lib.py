@@ -31,6 +31,7 @@
 ###############################################################################
 
 import collections
+import os
 import shutil
 import struct
 
@@ -3944,3 +3945,136 @@ def test_gdalwarp_lib_to_projection_without_inverse_method():
                 1218250.2778614,
             ],
         )
+
+
+###############################################################################
+# Test processing several chunks concurrently with NUM_CHUNK_THREADS
+
+
+@pytest.mark.parametrize("creation_options", [[], ["COMPRESS=LZW"]])
+def test_gdalwarp_lib_num_chunk_threads(tmp_vsimem, creation_options):
+
+    src_ds = gdal.Open("../gcore/data/byte.tif")
+    options = dict(
+        dstSRS="EPSG:4326",
+        width=1000,
+        height=1000,
+        resampleAlg="cubic",
+        warpMemoryLimit=200000,
+    )
+    ref_ds = gdal.Warp("", src_ds, format="MEM", **options)
+    ref_checksum = ref_ds.GetRasterBand(1).Checksum()
+
+    out_ds = gdal.Warp(
+        tmp_vsimem / "out.tif",
+        src_ds,
+        multithread=True,
+        warpOptions=["NUM_CHUNK_THREADS=4"],
+        creationOptions=creation_options,
+        **options,
+    )
+    assert out_ds.GetRasterBand(1).Checksum() == ref_checksum
+
+
+###############################################################################
+# Test TRANSFORM_GRID=YES warping option
+
+
+def test_gdalwarp_lib_transform_grid():
+
+    src_ds = gdal.Open("../gcore/data/byte.tif")
+    options = dict(
+        format="MEM",
+        dstSRS="EPSG:4326",
+        width=100,
+        height=100,
+        resampleAlg="bilinear",
+        errorThreshold=0,
+    )
+    ref_ds = gdal.Warp("", src_ds, **options)
+    ref_data = struct.unpack("B" * 10000, ref_ds.ReadRaster())
+
+    # Second iteration reuses the cached grid
+    for _ in range(2):
+        out_ds = gdal.Warp(
+            "",
+            src_ds,
+            warpOptions=["TRANSFORM_GRID=YES", "TRANSFORM_GRID_STEP=8"],
+            **options,
+        )
+        assert out_ds.GetGeoTransform() == ref_ds.GetGeoTransform()
+        out_data = struct.unpack("B" * 10000, out_ds.ReadRaster())
+        assert max(abs(a - b) for a, b in zip(out_data, ref_data)) <= 8
+
+
+###############################################################################
+# Test -incremental
+
+
+def test_gdalwarp_lib_incremental(tmp_path):
+
+    src_filenames = []
+    for i in range(3):
+        src_filename = str(tmp_path / f"src{i}.tif")
+        ds = gdal.GetDriverByName("GTiff").Create(src_filename, 20, 20)
+        ds.SetGeoTransform([i * 20, 1, 0, 20, 0, -1])
+        ds.GetRasterBand(1).Fill(10 * (i + 1))
+        ds = None
+        src_filenames.append(src_filename)
+
+    dst_filename = str(tmp_path / "dst.tif")
+    warp_options = "-et 0 -r bilinear"
+    creation_options = warp_options + " -tr 0.7 0.7 -te 0 0 60 20"
+
+    def update():
+        dst_ds = gdal.Open(dst_filename, gdal.GA_Update)
+        assert gdal.Warp(
+            dst_ds, src_filenames, options="-incremental " + warp_options
+        )
+        dst_ds = None
+
+    def checksum_full_warp():
+        ds = gdal.Warp("", src_filenames, format="MEM", options=creation_options)
+        return ds.GetRasterBand(1).Checksum()
+
+    assert gdal.Warp(
+        dst_filename, src_filenames, options="-incremental " + creation_options
+    )
+    assert gdal.VSIStatL(dst_filename + ".gdalwarp.json") is not None
+
+    # Modify the content of a source, without changing its size and
+    # modification time: it must not be reprocessed
+    st = os.stat(src_filenames[0])
+    ds = gdal.Open(src_filenames[0], gdal.GA_Update)
+    ds.GetRasterBand(1).Fill(200)
+    ds = None
+    os.utime(src_filenames[0], ns=(st.st_atime_ns, st.st_mtime_ns))
+    expected_cs = checksum_full_warp()
+    update()
+    assert gdal.Open(dst_filename).GetRasterBand(1).Checksum() != expected_cs
+
+    # Modify the middle source: the area it covers must be re-warped
+    ds = gdal.Open(src_filenames[1], gdal.GA_Update)
+    ds.GetRasterBand(1).Fill(100)
+    ds = None
+    os.utime(src_filenames[1], ns=(st.st_atime_ns, st.st_mtime_ns + 10**9))
+    update()
+    ds = gdal.Open(dst_filename)
+    # Left part still has the old value of the first source
+    assert ds.GetRasterBand(1).ReadRaster(0, 10, 1, 1) == b"\x0a"
+    assert ds.GetRasterBand(1).ReadRaster(42, 10, 1, 1) == b"\x64"
+    ds = None
+
+    # Remove the last source: its area must be reset
+    src_filenames = src_filenames[0:2]
+    update()
+    ds = gdal.Open(dst_filename)
+    assert ds.GetRasterBand(1).ReadRaster(80, 10, 1, 1) == b"\x00"
+    ds = None
+
+    # Full rewarp of the first source, and compare to a non-incremental run
+    os.utime(src_filenames[0], ns=(st.st_atime_ns, st.st_mtime_ns + 2 * 10**9))
+    update()
+    assert gdal.Open(dst_filename).GetRasterBand(1).Checksum() == (
+        checksum_full_warp()
+    )
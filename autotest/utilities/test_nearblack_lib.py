@@ -572,3 +572,60 @@ def test_nearblack_lib_dict_arguments():
     ind = opt.index("-co")
 
     assert opt[ind : ind + 4] == ["-co", "COMPRESS=DEFLATE", "-co", "LEVEL=4"]
+
+
+###############################################################################
+# Test that processing by chunks of lines, with or without read-ahead, gives
+# the same result as processing the whole raster at once
+
+
+def _nearblack_chunk_src(filename, blockysize):
+
+    # 300 lines, so that several chunks are needed with small blocks
+    src_ds = gdal.Translate(
+        "",
+        "../gdrivers/data/rgbsmall.tif",
+        format="MEM",
+        width=160,
+        height=300,
+        resampleAlg=gdal.GRIORA_NearestNeighbour,
+    )
+    return gdal.Translate(
+        filename, src_ds, creationOptions=["BLOCKYSIZE=%d" % blockysize]
+    )
+
+
+def _nearblack_chunk_checksums(ds):
+    cs = [ds.GetRasterBand(i + 1).Checksum() for i in range(ds.RasterCount)]
+    cs.append(ds.GetRasterBand(1).GetMaskBand().Checksum())
+    return cs
+
+
+@pytest.mark.parametrize(
+    "options",
+    [
+        {"maxNonBlack": 0, "nearDist": 15},
+        {"setAlpha": True},
+        {"setMask": True, "nearDist": 10},
+        {"white": True, "maxNonBlack": 3},
+        {"colors": [(0, 0, 0), (255, 255, 255)], "setAlpha": True},
+    ],
+)
+def test_nearblack_lib_chunks(tmp_vsimem, options):
+
+    one_chunk_ds = _nearblack_chunk_src(tmp_vsimem / "one_chunk.tif", 300)
+    several_chunks_ds = _nearblack_chunk_src(tmp_vsimem / "several_chunks.tif", 1)
+
+    ref_ds = gdal.Nearblack("", one_chunk_ds, format="MEM", **options)
+    expected = _nearblack_chunk_checksums(ref_ds)
+
+    for num_threads in ("1", "4"):
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            ds = gdal.Nearblack("", several_chunks_ds, format="MEM", **options)
+        assert _nearblack_chunk_checksums(ds) == expected, num_threads
+
+    if "setAlpha" not in options and "setMask" not in options:
+        # In-place update: no read-ahead
+        with gdal.config_option("GDAL_NUM_THREADS", "4"):
+            gdal.Nearblack(several_chunks_ds, several_chunks_ds, **options)
+        assert _nearblack_chunk_checksums(several_chunks_ds) == expected
@@ -1439,6 +1439,74 @@ def test_ogr2ogr_lib_explodecollections():
     assert dst_lyr.GetFeatureCount() == 2, "wrong feature count"
 
 
+###############################################################################
+# Test that values are still available after their transfer to the output
+# feature when the source feature is reused (-explodecollections), or read
+# again (-zfield, -resolveDomains). Otherwise values are moved out of the source
+# feature.
+
+
+@pytest.mark.parametrize(
+    "options",
+    [
+        {},
+        {"explodeCollections": True},
+        {"zField": "z"},
+        {"resolveDomains": True},
+        {"explodeCollections": True, "zField": "z", "resolveDomains": True},
+    ],
+)
+def test_ogr2ogr_lib_transfer_values(options):
+
+    src_ds = gdal.GetDriverByName("Memory").Create("", 0, 0, 0, gdal.GDT_Unknown)
+    assert src_ds.AddFieldDomain(
+        ogr.CreateCodedFieldDomain(
+            "coded_domain", "desc", ogr.OFTInteger, ogr.OFSTNone, {1: "one", 2: "two"}
+        )
+    )
+    src_lyr = src_ds.CreateLayer("layer")
+    src_lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    src_lyr.CreateField(ogr.FieldDefn("strlist", ogr.OFTStringList))
+    src_lyr.CreateField(ogr.FieldDefn("intlist", ogr.OFTIntegerList))
+    src_lyr.CreateField(ogr.FieldDefn("z", ogr.OFTReal))
+    fld_defn = ogr.FieldDefn("code", ogr.OFTInteger)
+    fld_defn.SetDomainName("coded_domain")
+    src_lyr.CreateField(fld_defn)
+    for i in range(3):
+        f = ogr.Feature(src_lyr.GetLayerDefn())
+        f["str"] = "str%d" % i
+        f["strlist"] = ["a%d" % i, "b%d" % i]
+        f["intlist"] = [i, i + 1]
+        f["z"] = 10 + i
+        f["code"] = 1 + i % 2
+        f.SetStyleString("PEN(c:#FF000%d)" % i)
+        f.SetGeometry(ogr.CreateGeometryFromWkt("MULTIPOINT ((%d 0),(%d 1))" % (i, i)))
+        src_lyr.CreateFeature(f)
+
+    ds = gdal.VectorTranslate("", src_ds, format="Memory", **options)
+    lyr = ds.GetLayer(0)
+    nparts = 2 if options.get("explodeCollections") else 1
+    assert lyr.GetFeatureCount() == 3 * nparts
+    for j, f in enumerate(lyr):
+        i = j // nparts
+        assert f["str"] == "str%d" % i
+        assert f["strlist"] == ["a%d" % i, "b%d" % i]
+        assert f["intlist"] == [i, i + 1]
+        assert f["z"] == 10 + i
+        assert f["code"] == 1 + i % 2
+        if options.get("resolveDomains"):
+            assert f["code_resolved"] == ("one" if i % 2 == 0 else "two")
+        assert f.GetStyleString() == "PEN(c:#FF000%d)" % i
+        g = f.GetGeometryRef()
+        if options.get("zField"):
+            assert g.GetZ(0) == 10 + i
+        if nparts == 2:
+            assert g.GetGeometryType() in (ogr.wkbPoint, ogr.wkbPoint25D)
+            assert g.GetY(0) == j % 2
+        else:
+            assert g.GetGeometryCount() == 2
+
+
 ###############################################################################
 # Test converting a layer with a fid string to GPKG
 
@@ -2250,6 +2318,148 @@ def test_ogr2ogr_lib_OGR2OGR_USE_ARROW_API_YES(limit):
     )
 
 
+###############################################################################
+# Test that the Arrow interface is still used with reprojection, -select,
+# -nlt and -clipsrc, and gives the same result as the feature based code path
+
+
+@pytest.mark.require_driver("GPKG")
+@pytest.mark.require_geos
+def test_ogr2ogr_lib_OGR2OGR_USE_ARROW_API_geometry_processing(tmp_vsimem):
+
+    src_filename = str(tmp_vsimem / "src.gpkg")
+    src_ds = gdal.GetDriverByName("GPKG").Create(
+        src_filename, 0, 0, 0, gdal.GDT_Unknown
+    )
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(4326)
+    src_lyr = src_ds.CreateLayer("test", srs=srs, geom_type=ogr.wkbPolygon)
+    src_lyr.CreateField(ogr.FieldDefn("a"))
+    src_lyr.CreateField(ogr.FieldDefn("b", ogr.OFTInteger))
+    src_lyr.CreateField(ogr.FieldDefn("c"))
+    for i in range(3):
+        f = ogr.Feature(src_lyr.GetLayerDefn())
+        f["a"] = "a%d" % i
+        f["b"] = i
+        f["c"] = "c%d" % i
+        f.SetGeometry(
+            ogr.CreateGeometryFromWkt(
+                "POLYGON ((%d 49,%d 50,%d 50,%d 49,%d 49))"
+                % (2 * i, 2 * i, 2 * i + 1, 2 * i + 1, 2 * i)
+            )
+        )
+        src_lyr.CreateFeature(f)
+    src_ds = None
+
+    def translate(use_arrow_api):
+        got_msg = []
+
+        def my_handler(errorClass, errno, msg):
+            got_msg.append(msg)
+            return
+
+        with gdaltest.error_handler(my_handler), gdaltest.config_options(
+            {"CPL_DEBUG": "ON", "OGR2OGR_USE_ARROW_API": use_arrow_api}
+        ):
+            out_ds = gdal.VectorTranslate(
+                "",
+                src_filename,
+                format="Memory",
+                dstSRS="EPSG:32631",
+                selectFields=["a", "c"],
+                geometryType="MULTIPOLYGON",
+                clipSrc=[-1, 48, 2.5, 51],
+            )
+        return out_ds, "OGR2OGR: Using WriteArrowBatch()" in got_msg
+
+    out_ds, used_arrow = translate("YES")
+    assert used_arrow
+    ref_ds, used_arrow = translate("NO")
+    assert not used_arrow
+
+    out_lyr = out_ds.GetLayer(0)
+    ref_lyr = ref_ds.GetLayer(0)
+    assert out_lyr.GetLayerDefn().GetFieldCount() == 2
+    assert out_lyr.GetLayerDefn().GetFieldDefn(0).GetName() == "a"
+    assert out_lyr.GetLayerDefn().GetFieldDefn(1).GetName() == "c"
+    assert out_lyr.GetSpatialRef().GetAuthorityCode(None) == "32631"
+    assert out_lyr.GetFeatureCount() == 2
+    assert ref_lyr.GetFeatureCount() == 2
+    for ref_f in ref_lyr:
+        f = out_lyr.GetNextFeature()
+        assert f["a"] == ref_f["a"]
+        assert f["c"] == ref_f["c"]
+        assert f.GetGeometryRef().GetGeometryType() == ogr.wkbMultiPolygon
+        ogrtest.check_feature_geometry(f, ref_f.GetGeometryRef())
+
+
+###############################################################################
+# Test -multithread
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_ogr2ogr_lib_multithread(num_threads):
+
+    src_ds = gdal.GetDriverByName("Memory").Create("", 0, 0, 0, gdal.GDT_Unknown)
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(4326)
+    src_lyr = src_ds.CreateLayer("test", srs=srs, geom_type=ogr.wkbPolygon)
+    src_lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    # Several batches of features, some of them being discarded by the clipping
+    for i in range(1000):
+        f = ogr.Feature(src_lyr.GetLayerDefn())
+        f["id"] = i
+        x = (i % 10) * 0.5
+        y = 40 + (i // 10) * 0.1
+        f.SetGeometry(
+            ogr.CreateGeometryFromWkt(
+                "POLYGON ((%f %f,%f %f,%f %f,%f %f,%f %f))"
+                % (x, y, x, y + 0.1, x + 0.5, y + 0.1, x + 0.5, y, x, y)
+            )
+        )
+        src_lyr.CreateFeature(f)
+
+    def translate(multithread):
+        got_msg = []
+
+        def my_handler(errorClass, errno, msg):
+            got_msg.append(msg)
+            return
+
+        with gdaltest.error_handler(my_handler), gdaltest.config_options(
+            {
+                "CPL_DEBUG": "ON",
+                "OGR2OGR_USE_ARROW_API": "NO",
+                "GDAL_NUM_THREADS": num_threads,
+            }
+        ):
+            out_ds = gdal.VectorTranslate(
+                "",
+                src_ds,
+                format="Memory",
+                dstSRS="EPSG:32631",
+                geometryType="MULTIPOLYGON",
+                clipSrc=[0.25, 30, 3.75, 60],
+                multiThread=multithread,
+            )
+        return out_ds, any("Using multi-threaded pipeline" in msg for msg in got_msg)
+
+    out_ds, used_pipeline = translate(True)
+    assert used_pipeline
+    ref_ds, used_pipeline = translate(False)
+    assert not used_pipeline
+
+    out_lyr = out_ds.GetLayer(0)
+    ref_lyr = ref_ds.GetLayer(0)
+    assert out_lyr.GetFeatureCount() == 800
+    assert ref_lyr.GetFeatureCount() == 800
+    for ref_f in ref_lyr:
+        f = out_lyr.GetNextFeature()
+        assert f["id"] == ref_f["id"]
+        assert f.GetGeometryRef().GetGeometryType() == ogr.wkbMultiPolygon
+        ogrtest.check_feature_geometry(f, ref_f.GetGeometryRef())
+
+
 ###############################################################################
 # Test JSON types roundtrip
 
@@ -144,6 +144,8 @@ else ()
   check_function_exists(statvfs64 HAVE_STATVFS64)
   check_function_exists(lstat HAVE_LSTAT)
 
+  check_include_file("linux/io_uring.h" HAVE_LINUX_IO_URING_H)
+
   check_function_exists(getrlimit HAVE_GETRLIMIT)
   check_symbol_exists(RLIMIT_AS "sys/resource.h" HAVE_RLIMIT_AS)
 
@@ -190,6 +190,20 @@ man_pages = [
         [author_tamass],
         1,
     ),
+    (
+        "programs/gdal_zonalstats",
+        "gdal_zonalstats",
+        "Computes statistics of raster values within polygon zones",
+        [author_evenr],
+        1,
+    ),
+    (
+        "programs/gdal_tiler",
+        "gdal_tiler",
+        "Generates a tile pyramid as a directory, MBTiles or PMTiles",
+        [author_evenr],
+        1,
+    ),
     (
         "programs/gdal_create",
         "gdal_create",
@@ -55,6 +55,8 @@ void BIGGIFDriverSetCommonMetadata(GDALDriver *poDriver)
                               "Graphics Interchange Format (.gif)");
     poDriver->SetMetadataItem(GDAL_DMD_HELPTOPIC, "drivers/raster/gif.html");
     poDriver->SetMetadataItem(GDAL_DMD_EXTENSION, "gif");
+    poDriver->SetMetadataItem(GDAL_DMD_SIGNATURES,
+                              "474946383761 474946383961");  // GIF87a GIF89a
     poDriver->SetMetadataItem(GDAL_DMD_MIMETYPE, "image/gif");
     poDriver->SetMetadataItem(GDAL_DCAP_VIRTUALIO, "YES");
 
@@ -74,6 +76,8 @@ void GIFDriverSetCommonMetadata(GDALDriver *poDriver)
                               "Graphics Interchange Format (.gif)");
     poDriver->SetMetadataItem(GDAL_DMD_HELPTOPIC, "drivers/raster/gif.html");
     poDriver->SetMetadataItem(GDAL_DMD_EXTENSION, "gif");
+    poDriver->SetMetadataItem(GDAL_DMD_SIGNATURES,
+                              "474946383761 474946383961");  // GIF87a GIF89a
     poDriver->SetMetadataItem(GDAL_DMD_MIMETYPE, "image/gif");
     poDriver->SetMetadataItem(GDAL_DMD_CREATIONDATATYPES, "Byte");
 
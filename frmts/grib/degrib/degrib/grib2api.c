@@ -794,6 +794,15 @@ is required for each GRIB2 message.
  * gfld->num_coord = number of values in array gfld->coord_list[].
  *****************************************************************************
  */
+/* subgNum and numfields below keep state between the successive calls made
+ * for the sub grids of a same message. They are thread-local so that
+ * different messages can be decoded concurrently by different threads. */
+#if defined(_MSC_VER)
+#define UNPK_G2NCEP_THREAD_LOCAL __declspec(thread)
+#else
+#define UNPK_G2NCEP_THREAD_LOCAL __thread
+#endif
+
 void unpk_g2ncep(CPL_UNUSED sInt4 *kfildo, float *ain, sInt4 *iain, sInt4 *nd2x3,
                  sInt4 *idat, sInt4 *nidat, float *rdat, sInt4 *nrdat,
                  sInt4 *is0, CPL_UNUSED sInt4 *ns0, sInt4 *is1, CPL_UNUSED sInt4 *ns1,
@@ -806,13 +815,13 @@ void unpk_g2ncep(CPL_UNUSED sInt4 *kfildo, float *ain, sInt4 *iain, sInt4 *nd2x3
                  sInt4 *iendpk, sInt4 *jer, sInt4 *ndjer, sInt4 *kjer)
 {
    int i;               /* A counter used for a number of purposes. */
-   static unsigned int subgNum = 0; /* The sub grid we read most recently.
+   static UNPK_G2NCEP_THREAD_LOCAL unsigned int subgNum = 0; /* The sub grid we read most recently.
                                      * This is primarily to help with the
                                      * inew option. */
    int ierr;            /* Holds the error code from a called routine. */
    sInt4 listsec0[3];
    sInt4 listsec1[13];
-   static sInt4 numfields = 1; /* Number of sub Grids in this message */
+   static UNPK_G2NCEP_THREAD_LOCAL sInt4 numfields = 1; /* Number of sub Grids in this message */
    sInt4 numlocal;      /* Number of local sections in this message. */
    int unpack;          /* Tell g2_getfld to unpack the message. */
    int expand;          /* Tell g2_getflt to attempt to expand the bitmap. */
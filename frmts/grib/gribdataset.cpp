@@ -50,10 +50,12 @@
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "cpl_time.h"
+#include "cpl_worker_thread_pool.h"
 #include "degrib/degrib/degrib2.h"
 #include "degrib/degrib/inventory.h"
 #include "degrib/degrib/meta.h"
@@ -68,6 +70,7 @@ CPL_C_END
 #include "gdal_frmts.h"
 #include "gdal_pam.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include "ogr_spatialref.h"
 #include "memdataset.h"
 
@@ -802,6 +805,62 @@ const char *GRIBRasterBand::GetDescription() const
     return longFstLevel;
 }
 
+/************************************************************************/
+/*                            AttachData()                              */
+/************************************************************************/
+
+// Takes ownership of the decoded values and metadata of this band, as
+// returned by ReadGribData(), and updates the dataset band cache accounting.
+CPLErr GRIBRasterBand::AttachData(double *padfData,
+                                  grib_MetaData *psMetaData)
+{
+    GRIBDataset *poGDS = static_cast<GRIBDataset *>(poDS);
+
+    m_Grib_Data = padfData;
+    m_Grib_MetaData = psMetaData;
+    if (!m_Grib_Data)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Out of memory.");
+        if (m_Grib_MetaData != nullptr)
+        {
+            MetaFree(m_Grib_MetaData);
+            delete m_Grib_MetaData;
+            m_Grib_MetaData = nullptr;
+        }
+        return CE_Failure;
+    }
+
+    // Check the band matches the dataset as a whole, size wise. (#3246)
+    nGribDataXSize = m_Grib_MetaData->gds.Nx;
+    nGribDataYSize = m_Grib_MetaData->gds.Ny;
+    if (nGribDataXSize <= 0 || nGribDataYSize <= 0)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Band %d of GRIB dataset is %dx%d.", nBand, nGribDataXSize,
+                 nGribDataYSize);
+        MetaFree(m_Grib_MetaData);
+        delete m_Grib_MetaData;
+        m_Grib_MetaData = nullptr;
+        return CE_Failure;
+    }
+
+    poGDS->nCachedBytes += static_cast<GIntBig>(nGribDataXSize) *
+                           nGribDataYSize * sizeof(double);
+    poGDS->poLastUsedBand = this;
+
+    if (nGribDataXSize != nRasterXSize || nGribDataYSize != nRasterYSize)
+    {
+        CPLError(CE_Warning, CPLE_AppDefined,
+                 "Band %d of GRIB dataset is %dx%d, while the first band "
+                 "and dataset is %dx%d.  Georeferencing of band %d may "
+                 "be incorrect, and data access may be incomplete.",
+                 nBand, nGribDataXSize, nGribDataYSize, nRasterXSize,
+                 nRasterYSize, nBand);
+    }
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                             LoadData()                               */
 /************************************************************************/
@@ -857,46 +916,10 @@ CPLErr GRIBRasterBand::LoadData()
             delete m_Grib_MetaData;
             m_Grib_MetaData = nullptr;
         }
-        ReadGribData(poGDS->fp, start, subgNum, &m_Grib_Data, &m_Grib_MetaData);
-        if (!m_Grib_Data)
-        {
-            CPLError(CE_Failure, CPLE_AppDefined, "Out of memory.");
-            if (m_Grib_MetaData != nullptr)
-            {
-                MetaFree(m_Grib_MetaData);
-                delete m_Grib_MetaData;
-                m_Grib_MetaData = nullptr;
-            }
-            return CE_Failure;
-        }
-
-        // Check the band matches the dataset as a whole, size wise. (#3246)
-        nGribDataXSize = m_Grib_MetaData->gds.Nx;
-        nGribDataYSize = m_Grib_MetaData->gds.Ny;
-        if (nGribDataXSize <= 0 || nGribDataYSize <= 0)
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Band %d of GRIB dataset is %dx%d.", nBand, nGribDataXSize,
-                     nGribDataYSize);
-            MetaFree(m_Grib_MetaData);
-            delete m_Grib_MetaData;
-            m_Grib_MetaData = nullptr;
-            return CE_Failure;
-        }
-
-        poGDS->nCachedBytes += static_cast<GIntBig>(nGribDataXSize) *
-                               nGribDataYSize * sizeof(double);
-        poGDS->poLastUsedBand = this;
-
-        if (nGribDataXSize != nRasterXSize || nGribDataYSize != nRasterYSize)
-        {
-            CPLError(CE_Warning, CPLE_AppDefined,
-                     "Band %d of GRIB dataset is %dx%d, while the first band "
-                     "and dataset is %dx%d.  Georeferencing of band %d may "
-                     "be incorrect, and data access may be incomplete.",
-                     nBand, nGribDataXSize, nGribDataYSize, nRasterXSize,
-                     nRasterYSize, nBand);
-        }
+        double *padfData = nullptr;
+        grib_MetaData *psMetaData = nullptr;
+        ReadGribData(poGDS->fp, start, subgNum, &padfData, &psMetaData);
+        return AttachData(padfData, psMetaData);
     }
 
     return CE_None;
@@ -1253,6 +1276,101 @@ class InventoryWrapperSidecar : public gdal::grib::InventoryWrapper
     }
 };
 
+/************************************************************************/
+/*                           InventoryWrapperPam                        */
+/************************************************************************/
+
+// Inventory restored from the <GRIBInventory> element written in the
+// .aux.xml file by GRIBDataset::BuildPamInventory().
+class InventoryWrapperPam : public gdal::grib::InventoryWrapper
+{
+  public:
+    explicit InventoryWrapperPam(const CPLXMLNode *psInventory)
+        : gdal::grib::InventoryWrapper()
+    {
+        result_ = -1;
+        for (const CPLXMLNode *psIter = psInventory->psChild; psIter;
+             psIter = psIter->psNext)
+        {
+            if (psIter->eType == CXT_Element &&
+                strcmp(psIter->pszValue, "Message") == 0)
+                inv_len_++;
+        }
+        if (inv_len_ == 0)
+            return;
+        inv_ = static_cast<inventoryType *>(
+            VSI_CALLOC_VERBOSE(inv_len_, sizeof(inventoryType)));
+        if (inv_ == nullptr)
+        {
+            inv_len_ = 0;
+            return;
+        }
+
+        uInt4 i = 0;
+        for (const CPLXMLNode *psIter = psInventory->psChild; psIter;
+             psIter = psIter->psNext)
+        {
+            if (psIter->eType != CXT_Element ||
+                strcmp(psIter->pszValue, "Message") != 0)
+                continue;
+            inventoryType *psInv = inv_ + i;
+            i++;
+            const char *pszStart = CPLGetXMLValue(psIter, "Start", nullptr);
+            const int nGribVersion =
+                atoi(CPLGetXMLValue(psIter, "GribVersion", "0"));
+            if (pszStart == nullptr ||
+                (nGribVersion != 1 && nGribVersion != 2 && nGribVersion != -1))
+            {
+                CPLDebug("GRIB", "Invalid message entry in PAM inventory");
+                return;
+            }
+            psInv->GribVersion = static_cast<sChar>(nGribVersion);
+            psInv->start = std::strtoull(pszStart, nullptr, 10);
+            psInv->msgNum = static_cast<unsigned short>(
+                atoi(CPLGetXMLValue(psIter, "MsgNum", "0")));
+            psInv->subgNum = static_cast<unsigned short>(
+                atoi(CPLGetXMLValue(psIter, "SubgNum", "0")));
+            psInv->refTime = CPLAtof(CPLGetXMLValue(psIter, "RefTime", "0"));
+            psInv->validTime =
+                CPLAtof(CPLGetXMLValue(psIter, "ValidTime", "0"));
+            psInv->foreSec = CPLAtof(CPLGetXMLValue(psIter, "ForeSec", "0"));
+            psInv->element = DupValue(psIter, "Element");
+            psInv->comment = DupValue(psIter, "Comment");
+            psInv->unitName = DupValue(psIter, "Unit");
+            psInv->shortFstLevel = DupValue(psIter, "ShortFstLevel");
+            psInv->longFstLevel = DupValue(psIter, "LongFstLevel");
+        }
+
+        num_messages_ =
+            atoi(CPLGetXMLValue(psInventory, "NumMessages", "0"));
+        result_ = static_cast<int>(inv_len_);
+    }
+
+    ~InventoryWrapperPam() override
+    {
+        if (inv_ == nullptr)
+            return;
+
+        for (unsigned i = 0; i < inv_len_; i++)
+        {
+            VSIFree(inv_[i].element);
+            VSIFree(inv_[i].comment);
+            VSIFree(inv_[i].unitName);
+            VSIFree(inv_[i].shortFstLevel);
+            VSIFree(inv_[i].longFstLevel);
+        }
+
+        VSIFree(inv_);
+    }
+
+  private:
+    static char *DupValue(const CPLXMLNode *psNode, const char *pszKey)
+    {
+        const char *pszValue = CPLGetXMLValue(psNode, pszKey, nullptr);
+        return pszValue ? VSIStrdup(pszValue) : nullptr;
+    }
+};
+
 /************************************************************************/
 /* ==================================================================== */
 /*                              GRIBDataset                             */
@@ -1299,6 +1417,265 @@ CPLErr GRIBDataset::GetGeoTransform(double *padfTransform)
     return CE_None;
 }
 
+/************************************************************************/
+/*                           GRIBDecodeJob                              */
+/************************************************************************/
+
+namespace
+{
+struct GRIBDecodeJob
+{
+    std::string osFilename{};
+    vsi_l_offset nStart = 0;
+    int nSubgNum = 0;
+    double *padfData = nullptr;
+    grib_MetaData *psMetaData = nullptr;
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+};
+}  // namespace
+
+static void GRIBDecodeJobFunc(void *pData)
+{
+    GRIBDecodeJob *psJob = static_cast<GRIBDecodeJob *>(pData);
+    CPLInstallErrorHandlerAccumulator(psJob->aoErrors);
+    // Each job uses its own file handle, so that messages are read and
+    // decoded concurrently.
+    VSILFILE *fp = VSIFOpenL(psJob->osFilename.c_str(), "rb");
+    if (fp != nullptr)
+    {
+        GRIBRasterBand::ReadGribData(fp, psJob->nStart, psJob->nSubgNum,
+                                     &psJob->padfData, &psJob->psMetaData);
+        VSIFCloseL(fp);
+    }
+    CPLUninstallErrorHandlerAccumulator();
+}
+
+/************************************************************************/
+/*                        LoadBandsInParallel()                         */
+/************************************************************************/
+
+// Decode the messages of the requested bands that are not cached yet with
+// m_nNumThreads worker threads. This is only a prefetch: bands that could
+// not be decoded here are loaded as usual by GRIBRasterBand::LoadData().
+void GRIBDataset::LoadBandsInParallel(int nBandCount, const int *panBandMap)
+{
+    if (m_nNumThreads <= 1 || bCacheOnlyOneBand)
+        return;
+
+    std::vector<GRIBRasterBand *> apoBands;
+    GIntBig nNeededBytes = 0;
+    for (int i = 0; i < nBandCount; ++i)
+    {
+        GRIBRasterBand *poBand =
+            cpl::down_cast<GRIBRasterBand *>(GetRasterBand(panBandMap[i]));
+        if (poBand->m_Grib_Data != nullptr ||
+            std::find(apoBands.begin(), apoBands.end(), poBand) !=
+                apoBands.end())
+            continue;
+        apoBands.push_back(poBand);
+        nNeededBytes +=
+            static_cast<GIntBig>(nRasterXSize) * nRasterYSize * sizeof(double);
+    }
+
+    // Decoded bands that would not fit in the band cache would be evicted
+    // before being used.
+    if (apoBands.size() < 2 ||
+        nCachedBytes + nNeededBytes > nCachedBytesThreshold)
+        return;
+
+    CPLWorkerThreadPool *poPool = GDALGetGlobalThreadPool(m_nNumThreads);
+    if (poPool == nullptr)
+        return;
+    auto poJobQueue = poPool->CreateJobQueue();
+
+    std::vector<GRIBDecodeJob> asJobs(apoBands.size());
+    for (size_t i = 0; i < apoBands.size(); ++i)
+    {
+        asJobs[i].osFilename = GetDescription();
+        asJobs[i].nStart = apoBands[i]->start;
+        asJobs[i].nSubgNum = apoBands[i]->subgNum;
+        if (!poJobQueue->SubmitJob(GRIBDecodeJobFunc, &asJobs[i]))
+        {
+            asJobs.resize(i);
+            break;
+        }
+    }
+    poJobQueue->WaitCompletion();
+
+    for (size_t i = 0; i < asJobs.size(); ++i)
+    {
+        GRIBDecodeJob &sJob = asJobs[i];
+        for (const auto &oError : sJob.aoErrors)
+            CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+        if (sJob.padfData == nullptr)
+        {
+            if (sJob.psMetaData != nullptr)
+            {
+                MetaFree(sJob.psMetaData);
+                delete sJob.psMetaData;
+            }
+            continue;
+        }
+
+        GRIBRasterBand *poBand = apoBands[i];
+        if (poBand->m_Grib_MetaData != nullptr)
+        {
+            MetaFree(poBand->m_Grib_MetaData);
+            delete poBand->m_Grib_MetaData;
+            poBand->m_Grib_MetaData = nullptr;
+        }
+        poBand->AttachData(sJob.padfData, sJob.psMetaData);
+    }
+}
+
+/************************************************************************/
+/*                             IRasterIO()                              */
+/************************************************************************/
+
+CPLErr GRIBDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
+                              int nXSize, int nYSize, void *pData,
+                              int nBufXSize, int nBufYSize,
+                              GDALDataType eBufType, int nBandCount,
+                              int *panBandMap, GSpacing nPixelSpace,
+                              GSpacing nLineSpace, GSpacing nBandSpace,
+                              GDALRasterIOExtraArg *psExtraArg)
+{
+    if (eRWFlag == GF_Read && nBandCount > 1)
+        LoadBandsInParallel(nBandCount, panBandMap);
+
+    return GDALPamDataset::IRasterIO(
+        eRWFlag, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize, nBufYSize,
+        eBufType, nBandCount, panBandMap, nPixelSpace, nLineSpace, nBandSpace,
+        psExtraArg);
+}
+
+/************************************************************************/
+/*                          LoadPamInventory()                          */
+/************************************************************************/
+
+// Return the message inventory stored in the .aux.xml file, provided that
+// it was built for the current version of the GRIB file.
+std::unique_ptr<gdal::grib::InventoryWrapper> GRIBDataset::LoadPamInventory()
+{
+    PamInitialize();
+    const char *pszPamFilename = BuildPamFilename();
+    VSIStatBufL sStatPam;
+    VSIStatBufL sStat;
+    if (pszPamFilename == nullptr ||
+        VSIStatL(pszPamFilename, &sStatPam) != 0 ||
+        VSIStatL(GetDescription(), &sStat) != 0)
+        return nullptr;
+
+    CPLXMLTreeCloser poTree(CPLParseXMLFile(pszPamFilename));
+    if (!poTree)
+        return nullptr;
+    const CPLXMLNode *psInventory =
+        CPLGetXMLNode(poTree.get(), "=PAMDataset.GRIBInventory");
+    if (psInventory == nullptr)
+        return nullptr;
+
+    if (strcmp(CPLGetXMLValue(psInventory, "FileSize", ""),
+               CPLSPrintf(CPL_FRMT_GUIB,
+                          static_cast<GUIntBig>(sStat.st_size))) != 0 ||
+        strcmp(CPLGetXMLValue(psInventory, "MTime", ""),
+               CPLSPrintf(CPL_FRMT_GIB,
+                          static_cast<GIntBig>(sStat.st_mtime))) != 0)
+    {
+        CPLDebug("GRIB", "PAM inventory of %s is outdated", GetDescription());
+        return nullptr;
+    }
+
+    auto poInventory = std::make_unique<InventoryWrapperPam>(psInventory);
+    if (poInventory->result() <= 0)
+        return nullptr;
+
+    CPLDebug("GRIB", "Reading inventories from %s", pszPamFilename);
+    // Keep it so that it is written back if the PAM file is rewritten.
+    m_poPamInventory.reset(CPLCloneXMLTree(psInventory));
+    return poInventory;
+}
+
+/************************************************************************/
+/*                         BuildPamInventory()                          */
+/************************************************************************/
+
+void GRIBDataset::BuildPamInventory(
+    const gdal::grib::InventoryWrapper *poInventory)
+{
+    VSIStatBufL sStat;
+    if (VSIStatL(GetDescription(), &sStat) != 0)
+        return;
+
+    CPLXMLNode *psRoot =
+        CPLCreateXMLNode(nullptr, CXT_Element, "GRIBInventory");
+    m_poPamInventory.reset(psRoot);
+    CPLAddXMLAttributeAndValue(
+        psRoot, "FileSize",
+        CPLSPrintf(CPL_FRMT_GUIB, static_cast<GUIntBig>(sStat.st_size)));
+    CPLAddXMLAttributeAndValue(
+        psRoot, "MTime",
+        CPLSPrintf(CPL_FRMT_GIB, static_cast<GIntBig>(sStat.st_mtime)));
+    CPLAddXMLAttributeAndValue(
+        psRoot, "NumMessages",
+        CPLSPrintf("%d", static_cast<int>(poInventory->num_messages())));
+
+    // Link siblings directly, as CPLAddXMLChild() is linear in the number
+    // of children.
+    CPLXMLNode *psLast = psRoot->psChild;
+    while (psLast->psNext)
+        psLast = psLast->psNext;
+    for (uInt4 i = 0; i < poInventory->length(); ++i)
+    {
+        const inventoryType *psInv = poInventory->get(i);
+        CPLXMLNode *psMsg = CPLCreateXMLNode(nullptr, CXT_Element, "Message");
+        psLast->psNext = psMsg;
+        psLast = psMsg;
+
+        CPLAddXMLAttributeAndValue(psMsg, "GribVersion",
+                                   CPLSPrintf("%d", psInv->GribVersion));
+        CPLAddXMLAttributeAndValue(
+            psMsg, "Start",
+            CPLSPrintf(CPL_FRMT_GUIB, static_cast<GUIntBig>(psInv->start)));
+        CPLAddXMLAttributeAndValue(psMsg, "MsgNum",
+                                   CPLSPrintf("%d", psInv->msgNum));
+        CPLAddXMLAttributeAndValue(psMsg, "SubgNum",
+                                   CPLSPrintf("%d", psInv->subgNum));
+        CPLAddXMLAttributeAndValue(psMsg, "RefTime",
+                                   CPLSPrintf("%.17g", psInv->refTime));
+        CPLAddXMLAttributeAndValue(psMsg, "ValidTime",
+                                   CPLSPrintf("%.17g", psInv->validTime));
+        CPLAddXMLAttributeAndValue(psMsg, "ForeSec",
+                                   CPLSPrintf("%.17g", psInv->foreSec));
+        const std::pair<const char *, const char *> apsStrings[] = {
+            {"Element", psInv->element},
+            {"Comment", psInv->comment},
+            {"Unit", psInv->unitName},
+            {"ShortFstLevel", psInv->shortFstLevel},
+            {"LongFstLevel", psInv->longFstLevel}};
+        for (const auto &oPair : apsStrings)
+        {
+            if (oPair.second != nullptr)
+                CPLAddXMLAttributeAndValue(psMsg, oPair.first, oPair.second);
+        }
+    }
+}
+
+/************************************************************************/
+/*                           SerializeToXML()                           */
+/************************************************************************/
+
+CPLXMLNode *GRIBDataset::SerializeToXML(const char *pszVRTPath)
+{
+    CPLXMLNode *psTree = GDALPamDataset::SerializeToXML(pszVRTPath);
+    if (m_poPamInventory)
+    {
+        if (psTree == nullptr)
+            psTree = CPLCreateXMLNode(nullptr, CXT_Element, "PAMDataset");
+        CPLAddXMLChild(psTree, CPLCloneXMLTree(m_poPamInventory.get()));
+    }
+    return psTree;
+}
+
 /************************************************************************/
 /*                                Inventory()                           */
 /************************************************************************/
@@ -1407,6 +1784,14 @@ GDALDataset *GRIBDataset::Open(GDALOpenInfo *poOpenInfo)
     poDS->fp = poOpenInfo->fpL;
     poOpenInfo->fpL = nullptr;
 
+    const char *pszNumThreads =
+        CSLFetchNameValueDef(poOpenInfo->papszOpenOptions, "NUM_THREADS",
+                             CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    poDS->m_nNumThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                              ? CPLGetNumCPUs()
+                              : atoi(pszNumThreads);
+    poDS->m_nNumThreads = std::max(1, std::min(poDS->m_nNumThreads, 128));
+
     // Make an inventory of the GRIB file.
     // The inventory does not contain all the information needed for
     // creating the RasterBands (especially the x and y size), therefore
@@ -1414,7 +1799,18 @@ GDALDataset *GRIBDataset::Open(GDALOpenInfo *poOpenInfo)
     // The band-data that is read is stored into the first RasterBand,
     // simply so that the same portion of the file is not read twice.
 
-    auto pInventories = Inventory(poDS->fp, poOpenInfo);
+    const bool bUsePamInventory = CPLTestBool(CSLFetchNameValueDef(
+        poOpenInfo->papszOpenOptions, "USE_PAM_INVENTORY",
+        CPLGetConfigOption("GRIB_USE_PAM_INVENTORY", "NO")));
+    std::unique_ptr<gdal::grib::InventoryWrapper> pInventories;
+    if (bUsePamInventory)
+    {
+        poDS->SetDescription(poOpenInfo->pszFilename);
+        pInventories = poDS->LoadPamInventory();
+    }
+    const bool bBuildPamInventory = bUsePamInventory && !pInventories;
+    if (!pInventories)
+        pInventories = Inventory(poDS->fp, poOpenInfo);
     if (pInventories->result() <= 0)
     {
         char *errMsg = errSprintf(nullptr);
@@ -1489,10 +1885,20 @@ GDALDataset *GRIBDataset::Open(GDALOpenInfo *poOpenInfo)
     // Initialize any PAM information.
     poDS->SetDescription(poOpenInfo->pszFilename);
 
+    // Only persist complete inventories, not the ones read from a .idx
+    // sidecar, which lack most of the message metadata.
+    if (bBuildPamInventory && pInventories->length() > 0 &&
+        pInventories->get(0)->element != nullptr)
+    {
+        poDS->BuildPamInventory(pInventories.get());
+    }
+
     // Release hGRIBMutex otherwise we'll deadlock with GDALDataset own
     // hGRIBMutex.
     CPLReleaseMutex(hGRIBMutex);
     poDS->TryLoadXML();
+    if (bBuildPamInventory && poDS->m_poPamInventory)
+        poDS->MarkPamDirty();
 
     // Check for external overviews.
     poDS->oOvManager.Initialize(poDS, poOpenInfo->pszFilename,
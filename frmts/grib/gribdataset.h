@@ -51,6 +51,7 @@
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_minixml.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
@@ -110,11 +111,22 @@ class GRIBDataset final : public GDALPamDataset
         return m_poRootGroup;
     }
 
+    CPLXMLNode *SerializeToXML(const char *pszVRTPath) override;
+
+  protected:
+    CPLErr IRasterIO(GDALRWFlag, int, int, int, int, void *, int, int,
+                     GDALDataType, int, int *, GSpacing nPixelSpace,
+                     GSpacing nLineSpace, GSpacing nBandSpace,
+                     GDALRasterIOExtraArg *psExtraArg) override;
+
   private:
     void SetGribMetaData(grib_MetaData *meta);
     static GDALDataset *OpenMultiDim(GDALOpenInfo *);
     static std::unique_ptr<gdal::grib::InventoryWrapper>
     Inventory(VSILFILE *, GDALOpenInfo *);
+    std::unique_ptr<gdal::grib::InventoryWrapper> LoadPamInventory();
+    void BuildPamInventory(const gdal::grib::InventoryWrapper *);
+    void LoadBandsInParallel(int nBandCount, const int *panBandMap);
 
     VSILFILE *fp;
     // Calculate and store once as GetGeoTransform may be called multiple times.
@@ -134,6 +146,11 @@ class GRIBDataset final : public GDALPamDataset
     std::shared_ptr<OGRSpatialReference> m_poSRS{};
     std::unique_ptr<OGRSpatialReference> m_poLL{};
     std::unique_ptr<OGRCoordinateTransformation> m_poCT{};
+
+    // Number of worker threads used to decode messages of several bands.
+    int m_nNumThreads = 1;
+    // Message index persisted in the .aux.xml (USE_PAM_INVENTORY=YES).
+    CPLXMLTreeCloser m_poPamInventory{nullptr};
 };
 
 /************************************************************************/
@@ -167,6 +184,7 @@ class GRIBRasterBand final : public GDALPamRasterBand
 
   private:
     CPLErr LoadData();
+    CPLErr AttachData(double *padfData, grib_MetaData *psMetaData);
     void FindNoDataGrib2(bool bSeekToStart = true);
     void FindMetaData();
     // Heuristic search for the start of the message
@@ -70,9 +70,18 @@ void GRIBDriverSetCommonMetadata(GDALDriver *poDriver)
                               "    <Option name='USE_IDX' type='boolean' "
                               "description='Load metadata from "
                               "wgrib2 index file if available' default='YES'/>"
+                              "    <Option name='USE_PAM_INVENTORY' "
+                              "type='boolean' description='Whether to store "
+                              "and reuse the message inventory in the "
+                              ".aux.xml file' default='NO'/>"
+                              "    <Option name='NUM_THREADS' type='string' "
+                              "description='Number of worker threads to "
+                              "decode messages of several bands, or ALL_CPUS' "
+                              "default='1'/>"
                               "</OpenOptionList>");
     poDriver->SetMetadataItem(GDAL_DMD_HELPTOPIC, "drivers/raster/grib.html");
     poDriver->SetMetadataItem(GDAL_DMD_EXTENSIONS, "grb grb2 grib2");
+    poDriver->SetMetadataItem(GDAL_DMD_SIGNATURES, "47524942");  // GRIB
     poDriver->SetMetadataItem(GDAL_DCAP_VIRTUALIO, "YES");
 
     poDriver->SetMetadataItem(GDAL_DMD_CREATIONDATATYPES,
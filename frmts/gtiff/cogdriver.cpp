@@ -28,6 +28,7 @@
 
 #include "cpl_port.h"
 
+#include "cpl_vsi_virtual.h"
 #include "gdal_priv.h"
 #include "gtiff.h"
 #include "gt_overview.h"
@@ -39,7 +40,11 @@
 #include "tilematrixset.hpp"
 
 #include <algorithm>
+#include <cerrno>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 static bool gbHasLZW = false;
@@ -88,6 +93,31 @@ static CPLString GetTmpFilename(const char *pszFilename, const char *pszExt)
     return osTmpFilename;
 }
 
+/************************************************************************/
+/*                       GetTmpOverviewFilename()                       */
+/************************************************************************/
+
+// Return the name of the temporary file in which overviews, whose
+// uncompressed size is dfUncompressedSize, are generated. Small enough
+// overviews are kept in memory.
+static CPLString GetTmpOverviewFilename(const char *pszFilename,
+                                        const char *pszExt,
+                                        double dfUncompressedSize)
+{
+    const double dfMaxInMemorySize = CPLAtof(CPLGetConfigOption(
+        "COG_TMP_OVERVIEW_IN_MEMORY_MAX_SIZE", "67108864"));
+    if (dfUncompressedSize > dfMaxInMemorySize)
+        return GetTmpFilename(pszFilename, pszExt);
+
+    CPLString osTmpFilename("/vsimem/");
+    osTmpFilename += CPLGetFilename(
+        CPLGenerateTempFilename(CPLGetBasename(pszFilename)));
+    osTmpFilename += '.';
+    osTmpFilename += pszExt;
+    VSIUnlink(osTmpFilename);
+    return osTmpFilename;
+}
+
 /************************************************************************/
 /*                             GetResampling()                          */
 /************************************************************************/
@@ -708,6 +738,488 @@ static std::unique_ptr<GDALDataset> CreateReprojectedDS(
     return std::unique_ptr<GDALDataset>(GDALDataset::FromHandle(hRet));
 }
 
+/************************************************************************/
+/*                          COGStreamingFile                            */
+/************************************************************************/
+
+// State shared by the handles opened on a /vsicogstreaming/ file.
+//
+// A streamed COG is produced by running the GTiff CreateCopy() twice.
+// During the first pass, the content of the file is kept in memory (up to
+// COG_STREAMING_MAX_MEMORY bytes) and the end of the region that gets
+// rewritten after having been initially written (the header: IFDs, tile
+// offset and bytecount arrays, ghost area) is determined. During the second
+// pass, which must issue exactly the same writes, the final header from
+// the first pass is emitted to the output file, and all bytes after it are
+// forwarded as they are appended, which only requires the output to support
+// sequential writing.
+class COGStreamingFile
+{
+    CPL_DISALLOW_COPY_ASSIGN(COGStreamingFile)
+
+    static constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+
+    const size_t m_nMaxKeptSize;
+    std::vector<GByte> m_abyKept{};
+    vsi_l_offset m_nFileSize = 0;
+    vsi_l_offset m_nHeaderSize = 0;
+    uint64_t m_nLayoutHash = FNV_OFFSET_BASIS;
+    bool m_bError = false;
+
+    bool m_bSecondPass = false;
+    std::vector<GByte> m_abyHeader{};
+    vsi_l_offset m_nFirstPassFileSize = 0;
+    uint64_t m_nFirstPassLayoutHash = 0;
+    VSILFILE *m_fpOut = nullptr;
+    vsi_l_offset m_nOutOffset = 0;
+    bool m_bHeaderEmitted = false;
+
+    void UpdateLayoutHash(uint64_t nVal);
+    bool EmitHeader();
+
+  public:
+    explicit COGStreamingFile(size_t nMaxKeptSize);
+    ~COGStreamingFile();
+
+    vsi_l_offset GetFileSize() const
+    {
+        return m_nFileSize;
+    }
+
+    size_t Read(vsi_l_offset nOffset, void *pBuffer, size_t nBytes);
+    size_t Write(vsi_l_offset nOffset, const void *pBuffer, size_t nBytes);
+
+    bool StartSecondPass(const char *pszFilename);
+    bool Finish();
+};
+
+/************************************************************************/
+/*                         COGStreamingFile()                           */
+/************************************************************************/
+
+COGStreamingFile::COGStreamingFile(size_t nMaxKeptSize)
+    : m_nMaxKeptSize(nMaxKeptSize)
+{
+}
+
+/************************************************************************/
+/*                        ~COGStreamingFile()                           */
+/************************************************************************/
+
+COGStreamingFile::~COGStreamingFile()
+{
+    if (m_fpOut)
+        VSIFCloseL(m_fpOut);
+}
+
+/************************************************************************/
+/*                         UpdateLayoutHash()                           */
+/************************************************************************/
+
+// FNV-1a hash of the sequence of (offset, size) of the writes, used to
+// check that both passes lay out the file identically.
+void COGStreamingFile::UpdateLayoutHash(uint64_t nVal)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        m_nLayoutHash ^= static_cast<GByte>(nVal >> (8 * i));
+        m_nLayoutHash *= 1099511628211ULL;
+    }
+}
+
+/************************************************************************/
+/*                               Read()                                 */
+/************************************************************************/
+
+size_t COGStreamingFile::Read(vsi_l_offset nOffset, void *pBuffer,
+                              size_t nBytes)
+{
+    if (nOffset >= m_nFileSize)
+        return 0;
+    if (nBytes > m_nFileSize - nOffset)
+        nBytes = static_cast<size_t>(m_nFileSize - nOffset);
+
+    size_t nFromKept = 0;
+    if (nOffset < m_abyKept.size())
+    {
+        nFromKept = std::min(nBytes, static_cast<size_t>(m_abyKept.size() -
+                                                         nOffset));
+        memcpy(pBuffer, m_abyKept.data() + static_cast<size_t>(nOffset),
+               nFromKept);
+    }
+    if (nFromKept < nBytes)
+    {
+        // Only the header region is expected to be read back by the
+        // GTiff driver.
+        CPLDebug("COG",
+                 "Reading back " CPL_FRMT_GUIB " bytes at offset " CPL_FRMT_GUIB
+                 " that are not kept in memory",
+                 static_cast<GUIntBig>(nBytes - nFromKept),
+                 static_cast<GUIntBig>(nOffset + nFromKept));
+        memset(static_cast<GByte *>(pBuffer) + nFromKept, 0,
+               nBytes - nFromKept);
+    }
+    return nBytes;
+}
+
+/************************************************************************/
+/*                               Write()                                */
+/************************************************************************/
+
+size_t COGStreamingFile::Write(vsi_l_offset nOffset, const void *pBuffer,
+                               size_t nBytes)
+{
+    if (m_bError)
+        return 0;
+
+    UpdateLayoutHash(nOffset);
+    UpdateLayoutHash(nBytes);
+
+    const vsi_l_offset nEnd = nOffset + nBytes;
+    if (!m_bSecondPass && nOffset < m_nFileSize)
+        m_nHeaderSize = std::max(m_nHeaderSize, nEnd);
+
+    if (nOffset < m_nMaxKeptSize)
+    {
+        const size_t nToKeep = static_cast<size_t>(
+            std::min<vsi_l_offset>(nEnd, m_nMaxKeptSize) - nOffset);
+        try
+        {
+            if (m_abyKept.size() < nOffset + nToKeep)
+                m_abyKept.resize(static_cast<size_t>(nOffset + nToKeep));
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate memory for COG streaming");
+            m_bError = true;
+            return 0;
+        }
+        memcpy(m_abyKept.data() + static_cast<size_t>(nOffset), pBuffer,
+               nToKeep);
+    }
+
+    if (m_bSecondPass && nEnd > m_abyHeader.size())
+    {
+        const vsi_l_offset nStart =
+            std::max<vsi_l_offset>(nOffset, m_abyHeader.size());
+        if (!m_bHeaderEmitted && !EmitHeader())
+            return 0;
+        if (nStart != m_nOutOffset)
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "COG streaming: non-sequential write at offset "
+                     CPL_FRMT_GUIB " whereas " CPL_FRMT_GUIB " was expected",
+                     static_cast<GUIntBig>(nStart),
+                     static_cast<GUIntBig>(m_nOutOffset));
+            m_bError = true;
+            return 0;
+        }
+        const size_t nToForward = static_cast<size_t>(nEnd - nStart);
+        if (VSIFWriteL(static_cast<const GByte *>(pBuffer) +
+                           static_cast<size_t>(nStart - nOffset),
+                       1, nToForward, m_fpOut) != nToForward)
+        {
+            m_bError = true;
+            return 0;
+        }
+        m_nOutOffset += nToForward;
+    }
+
+    m_nFileSize = std::max(m_nFileSize, nEnd);
+    return nBytes;
+}
+
+/************************************************************************/
+/*                             EmitHeader()                             */
+/************************************************************************/
+
+bool COGStreamingFile::EmitHeader()
+{
+    m_bHeaderEmitted = true;
+    if (VSIFWriteL(m_abyHeader.data(), 1, m_abyHeader.size(), m_fpOut) !=
+        m_abyHeader.size())
+    {
+        m_bError = true;
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                          StartSecondPass()                           */
+/************************************************************************/
+
+bool COGStreamingFile::StartSecondPass(const char *pszFilename)
+{
+    if (m_bError)
+        return false;
+    if (m_nHeaderSize > m_abyKept.size())
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "COG streaming: header size (" CPL_FRMT_GUIB
+                 " bytes) exceeds COG_STREAMING_MAX_MEMORY",
+                 static_cast<GUIntBig>(m_nHeaderSize));
+        return false;
+    }
+    CPLDebug("COG", "Streaming: header of " CPL_FRMT_GUIB " bytes, total of "
+             CPL_FRMT_GUIB " bytes",
+             static_cast<GUIntBig>(m_nHeaderSize),
+             static_cast<GUIntBig>(m_nFileSize));
+
+    m_abyKept.resize(static_cast<size_t>(m_nHeaderSize));
+    m_abyHeader = std::move(m_abyKept);
+    m_abyKept.clear();
+    m_nFirstPassFileSize = m_nFileSize;
+    m_nFirstPassLayoutHash = m_nLayoutHash;
+    m_nFileSize = 0;
+    m_nLayoutHash = FNV_OFFSET_BASIS;
+    m_bSecondPass = true;
+    m_nOutOffset = m_abyHeader.size();
+
+    m_fpOut = VSIFOpenL(pszFilename, "wb");
+    if (m_fpOut == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_OpenFailed, "Cannot create %s",
+                 pszFilename);
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                               Finish()                               */
+/************************************************************************/
+
+bool COGStreamingFile::Finish()
+{
+    if (m_fpOut == nullptr)
+        return false;
+    bool bOK = !m_bError && (m_bHeaderEmitted || EmitHeader());
+    if (bOK && (m_nFileSize != m_nFirstPassFileSize ||
+                m_nLayoutHash != m_nFirstPassLayoutHash))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "COG streaming: second pass did not lay out the file "
+                 "identically to the first one");
+        bOK = false;
+    }
+    if (VSIFCloseL(m_fpOut) != 0)
+        bOK = false;
+    m_fpOut = nullptr;
+    return bOK;
+}
+
+/************************************************************************/
+/*                         COGStreamingHandle                           */
+/************************************************************************/
+
+class COGStreamingHandle final : public VSIVirtualHandle
+{
+    std::shared_ptr<COGStreamingFile> m_poFile;
+    vsi_l_offset m_nOffset = 0;
+    bool m_bEOF = false;
+
+  public:
+    explicit COGStreamingHandle(const std::shared_ptr<COGStreamingFile> &poFile)
+        : m_poFile(poFile)
+    {
+    }
+
+    int Seek(vsi_l_offset nOffset, int nWhence) override
+    {
+        m_bEOF = false;
+        if (nWhence == SEEK_SET)
+            m_nOffset = nOffset;
+        else if (nWhence == SEEK_CUR)
+            m_nOffset += nOffset;
+        else
+            m_nOffset = m_poFile->GetFileSize() + nOffset;
+        return 0;
+    }
+
+    vsi_l_offset Tell() override
+    {
+        return m_nOffset;
+    }
+
+    size_t Read(void *pBuffer, size_t nSize, size_t nCount) override
+    {
+        if (nSize == 0 || nCount == 0)
+            return 0;
+        const size_t nBytes = nSize * nCount;
+        const size_t nRead = m_poFile->Read(m_nOffset, pBuffer, nBytes);
+        m_nOffset += nRead;
+        if (nRead < nBytes)
+            m_bEOF = true;
+        return nRead / nSize;
+    }
+
+    size_t Write(const void *pBuffer, size_t nSize, size_t nCount) override
+    {
+        if (nSize == 0 || nCount == 0)
+            return 0;
+        const size_t nWritten =
+            m_poFile->Write(m_nOffset, pBuffer, nSize * nCount);
+        m_nOffset += nWritten;
+        return nWritten / nSize;
+    }
+
+    int Eof() override
+    {
+        return m_bEOF;
+    }
+
+    int Close() override
+    {
+        return 0;
+    }
+};
+
+/************************************************************************/
+/*                   COGStreamingFilesystemHandler                      */
+/************************************************************************/
+
+// Private file system, only used during the creation of streamed COGs.
+class COGStreamingFilesystemHandler final : public VSIFilesystemHandler
+{
+    std::mutex m_oMutex{};
+    std::map<std::string, std::shared_ptr<COGStreamingFile>> m_oMapFiles{};
+
+    std::shared_ptr<COGStreamingFile> GetFile(const char *pszFilename)
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        const auto oIter = m_oMapFiles.find(pszFilename);
+        if (oIter == m_oMapFiles.end())
+            return nullptr;
+        return oIter->second;
+    }
+
+  public:
+    static constexpr const char *PREFIX = "/vsicogstreaming/";
+
+    static COGStreamingFilesystemHandler *Get();
+
+    void Register(const std::string &osFilename,
+                  const std::shared_ptr<COGStreamingFile> &poFile)
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_oMapFiles[osFilename] = poFile;
+    }
+
+    void Unregister(const std::string &osFilename)
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_oMapFiles.erase(osFilename);
+    }
+
+    VSIVirtualHandle *Open(const char *pszFilename, const char * /*pszAccess*/,
+                           bool bSetError,
+                           CSLConstList /* papszOptions */) override
+    {
+        auto poFile = GetFile(pszFilename);
+        if (!poFile)
+        {
+            if (bSetError)
+                VSIError(VSIE_FileError, "%s: No such file", pszFilename);
+            errno = ENOENT;
+            return nullptr;
+        }
+        return new COGStreamingHandle(poFile);
+    }
+
+    int Stat(const char *pszFilename, VSIStatBufL *pStatBuf,
+             int /* nFlags */) override
+    {
+        memset(pStatBuf, 0, sizeof(VSIStatBufL));
+        auto poFile = GetFile(pszFilename);
+        if (!poFile)
+        {
+            errno = ENOENT;
+            return -1;
+        }
+        pStatBuf->st_size = poFile->GetFileSize();
+        pStatBuf->st_mode = S_IFREG;
+        return 0;
+    }
+};
+
+/************************************************************************/
+/*                COGStreamingFilesystemHandler::Get()                  */
+/************************************************************************/
+
+COGStreamingFilesystemHandler *COGStreamingFilesystemHandler::Get()
+{
+    static std::mutex oMutex;
+    std::lock_guard<std::mutex> oLock(oMutex);
+    if (VSIFileManager::GetHandler(PREFIX) == VSIFileManager::GetHandler("/"))
+    {
+        VSIFileManager::InstallHandler(PREFIX,
+                                       new COGStreamingFilesystemHandler());
+    }
+    return cpl::down_cast<COGStreamingFilesystemHandler *>(
+        VSIFileManager::GetHandler(PREFIX));
+}
+
+/************************************************************************/
+/*                        COGCreateCopyStreaming()                      */
+/************************************************************************/
+
+// Runs twice the GTiff CreateCopy() over a /vsicogstreaming/ file, so that
+// the output file is written strictly sequentially.
+static GDALDataset *COGCreateCopyStreaming(GDALDriver *poGTiffDrv,
+                                           const char *pszFilename,
+                                           GDALDataset *poSrcDS,
+                                           CSLConstList papszOptions,
+                                           GDALProgressFunc pfnProgress,
+                                           void *pProgressData)
+{
+    const char *pszMaxMemory =
+        CPLGetConfigOption("COG_STREAMING_MAX_MEMORY", "134217728");
+    const GIntBig nMaxMemory = std::max<GIntBig>(
+        0, std::min<GIntBig>(CPLAtoGIntBig(pszMaxMemory),
+                             std::numeric_limits<size_t>::max() / 2));
+    auto poFile =
+        std::make_shared<COGStreamingFile>(static_cast<size_t>(nMaxMemory));
+    const std::string osTmpFilename(
+        CPLSPrintf("%s%p/%s", COGStreamingFilesystemHandler::PREFIX,
+                   poFile.get(), CPLGetFilename(pszFilename)));
+    auto poFS = COGStreamingFilesystemHandler::Get();
+    poFS->Register(osTmpFilename, poFile);
+
+    const auto RunPass = [&](double dfMin, double dfMax)
+    {
+        void *pScaledProgress = GDALCreateScaledProgress(
+            dfMin, dfMax, pfnProgress, pProgressData);
+        auto poDS = poGTiffDrv->CreateCopy(
+            osTmpFilename.c_str(), poSrcDS, false,
+            const_cast<char **>(papszOptions), GDALScaledProgress,
+            pScaledProgress);
+        GDALDestroyScaledProgress(pScaledProgress);
+        bool bRet = poDS != nullptr && poDS->Close() == CE_None;
+        delete poDS;
+        return bRet;
+    };
+
+    CPLDebug("COG", "Streaming: first pass");
+    bool bOK = RunPass(0.0, 0.5) && poFile->StartSecondPass(pszFilename);
+    if (bOK)
+    {
+        CPLDebug("COG", "Streaming: second pass");
+        bOK = RunPass(0.5, 1.0);
+        bOK = poFile->Finish() && bOK;
+    }
+    poFS->Unregister(osTmpFilename);
+    if (!bOK)
+    {
+        VSIUnlink(pszFilename);
+        return nullptr;
+    }
+
+    return GDALDataset::Open(pszFilename,
+                             GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR);
+}
+
 /************************************************************************/
 /*                            GDALCOGCreator                            */
 /************************************************************************/
@@ -1108,6 +1620,10 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
             double(nXSize) * nYSize * (nBands + (bHasMask ? 1 : 0)) * 4. / 3;
     }
 
+    double dfOverviewPixels = 0;
+    for (const auto &oDims : asOverviewDims)
+        dfOverviewPixels += double(oDims.first) * oDims.second;
+
     CPLStringList aosOverviewOptions;
     aosOverviewOptions.SetNameValue(
         "COMPRESS",
@@ -1121,7 +1637,8 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
     if (bGenerateMskOvr)
     {
         CPLDebug("COG", "Generating overviews of the mask: start");
-        m_osTmpMskOverviewFilename = GetTmpFilename(pszFilename, "msk.ovr.tmp");
+        m_osTmpMskOverviewFilename = GetTmpOverviewFilename(
+            pszFilename, "msk.ovr.tmp", dfOverviewPixels);
         GDALRasterBand *poSrcMask = poFirstBand->GetMaskBand();
         const char *pszResampling = CSLFetchNameValueDef(
             papszOptions, "OVERVIEW_RESAMPLING",
@@ -1151,7 +1668,10 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
     if (bGenerateOvr)
     {
         CPLDebug("COG", "Generating overviews of the imagery: start");
-        m_osTmpOverviewFilename = GetTmpFilename(pszFilename, "ovr.tmp");
+        m_osTmpOverviewFilename = GetTmpOverviewFilename(
+            pszFilename, "ovr.tmp",
+            dfOverviewPixels * nBands *
+                GDALGetDataTypeSizeBytes(poFirstBand->GetRasterDataType()));
         std::vector<GDALRasterBand *> apoSrcBands;
         for (int i = 0; i < nBands; i++)
             apoSrcBands.push_back(poCurDS->GetRasterBand(i + 1));
@@ -1359,8 +1879,13 @@ GDALDataset *GDALCOGCreator::Create(const char *pszFilename,
 
     CPLDebug("COG", "Generating final product: start");
     auto poRet =
-        poGTiffDrv->CreateCopy(pszFilename, poCurDS, false, aosOptions.List(),
-                               GDALScaledProgress, pScaledProgress);
+        CPLFetchBool(papszOptions, "STREAMING", false)
+            ? COGCreateCopyStreaming(poGTiffDrv, pszFilename, poCurDS,
+                                     aosOptions.List(), GDALScaledProgress,
+                                     pScaledProgress)
+            : poGTiffDrv->CreateCopy(pszFilename, poCurDS, false,
+                                     aosOptions.List(), GDALScaledProgress,
+                                     pScaledProgress);
 
     GDALDestroyScaledProgress(pScaledProgress);
 
@@ -1610,6 +2135,9 @@ void GDALCOGDriver::InitializeCreationOptionList()
 #endif
         "   <Option name='SPARSE_OK' type='boolean' description='Should empty "
         "blocks be omitted on disk?' default='FALSE'/>"
+        "   <Option name='STREAMING' type='boolean' description='Whether "
+        "the output file should be written strictly sequentially, at the "
+        "expense of generating the output twice' default='NO'/>"
         "   <Option name='STATISTICS' type='string-select' default='AUTO' "
         "description='Which to add statistics to the output file'>"
         "       <Value>AUTO</Value>"
@@ -37,6 +37,7 @@
 #include "gdal_mdreader.h"  // RPC_xxx
 #include "gtiffdataset.h"
 #include "tiffio.h"
+#include "tifvsi.h"
 #include "tif_jxl.h"
 #include "xtiffio.h"
 #include <cctype>
@@ -1029,6 +1030,7 @@ void GTiffOneTimeInit()
 static void GDALDeregister_GTiff(GDALDriver *)
 
 {
+    VSI_TIFFClearHeaderCache();
 #ifdef HAVE_JXL
     if (pJXLCodec)
         TIFFUnRegisterCODEC(pJXLCodec);
@@ -1073,21 +1073,8 @@ CPLErr GTIFFBuildOverviewsEx(const char *pszFilename, int nBands,
 
     CPLErr eErr = CE_None;
 
-    // If we have an alpha band, we want it to be generated before downsampling
-    // other bands
-    bool bHasAlphaBand = false;
-    for (int iBand = 0; iBand < nBands; iBand++)
-    {
-        if (papoBandList[iBand]->GetColorInterpretation() == GCI_AlphaBand)
-            bHasAlphaBand = true;
-    }
-
     const auto poColorTable = papoBandList[0]->GetColorTable();
-    if (((((bSourceIsPixelInterleaved && bSourceIsJPEG2000) ||
-           (nCompression != COMPRESSION_NONE)) &&
-          nPlanarConfig == PLANARCONFIG_CONTIG) ||
-         bHasAlphaBand) &&
-        !GDALDataTypeIsComplex(papoBandList[0]->GetRasterDataType()) &&
+    if (!GDALDataTypeIsComplex(papoBandList[0]->GetRasterDataType()) &&
         (poColorTable == nullptr || STARTS_WITH_CI(pszResampling, "NEAR") ||
          poColorTable->IsIdentity()) &&
         (STARTS_WITH_CI(pszResampling, "NEAR") ||
@@ -1097,10 +1084,12 @@ CPLErr GTIFFBuildOverviewsEx(const char *pszFilename, int nBands,
          EQUAL(pszResampling, "LANCZOS") || EQUAL(pszResampling, "BILINEAR") ||
          EQUAL(pszResampling, "MODE")))
     {
-        // In the case of pixel interleaved compressed overviews, we want to
-        // generate the overviews for all the bands block by block, and not
-        // band after band, in order to write the block once and not loose
-        // space in the TIFF file.
+        // Generate the overviews for all the bands block by block, and not
+        // band after band, so that each source block is read only once, the
+        // bands of a chunk are resampled in parallel when several threads
+        // are used, and, in the case of pixel interleaved compressed
+        // overviews, each block is written once without loosing space in
+        // the TIFF file.
         GDALRasterBand ***papapoOverviewBands =
             static_cast<GDALRasterBand ***>(CPLCalloc(sizeof(void *), nBands));
         for (int iBand = 0; iBand < nBands && eErr == CE_None; iBand++)
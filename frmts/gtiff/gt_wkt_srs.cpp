@@ -503,6 +503,94 @@ static char *GTIFGetEPSGOfficialName(GTIF *hGTIF, PJ_TYPE searchType,
     return pszRet;
 }
 
+/************************************************************************/
+/*                        GTIFGetSRSCacheKey()                          */
+/************************************************************************/
+
+// Returns a key suitable for OSRGetFromSharedCache(), made of the GeoKeys and
+// of the configuration options used when building the SRS with
+// GTIFGetDefn() and GTIFGetOGISDefnAsOSR(). The other GeoTIFF tags (tie
+// points, pixel scale, ...) are not part of it.
+
+std::string GTIFGetSRSCacheKey(GTIF *hGTIF)
+{
+    struct PrintContext
+    {
+        std::string osText{};
+    };
+
+    PrintContext sContext;
+    GTIFPrint(
+        hGTIF,
+        [](char *pszText, void *pData)
+        {
+            static_cast<PrintContext *>(pData)->osText += pszText;
+            return 1;
+        },
+        &sContext);
+
+    std::string osKey("GTiff:");
+    bool bInTags = false;
+    const CPLStringList aosLines(
+        CSLTokenizeString2(sContext.osText.c_str(), "\n", 0));
+    for (const char *pszLine : aosLines)
+    {
+        if (strstr(pszLine, "Tagged_Information:"))
+        {
+            bInTags = true;
+            continue;
+        }
+        if (strstr(pszLine, "End_Of_Tags."))
+        {
+            bInTags = false;
+            continue;
+        }
+        if (bInTags)
+            continue;
+
+        osKey += pszLine;
+        osKey += '\n';
+
+        // Doubles are printed with 15 significant digits only: append their
+        // exact values.
+        const char *pszDouble = strstr(pszLine, " (Double,");
+        if (pszDouble)
+        {
+            std::string osKeyName(pszLine, pszDouble - pszLine);
+            const auto nPos = osKeyName.find_last_not_of(' ');
+            osKeyName.resize(nPos == std::string::npos ? 0 : nPos + 1);
+            const auto nStart = osKeyName.find_first_not_of(' ');
+            if (nStart != std::string::npos)
+                osKeyName = osKeyName.substr(nStart);
+            const int nKeyCode = GTIFKeyCode(osKeyName.c_str());
+            const int nCount = atoi(pszDouble + strlen(" (Double,"));
+            if (nKeyCode >= 0 && nCount > 0 && nCount < 100)
+            {
+                std::vector<double> adfValues(nCount);
+                if (GDALGTIFKeyGetDOUBLE(hGTIF, static_cast<geokey_t>(nKeyCode),
+                                         adfValues.data(), 0, nCount))
+                {
+                    for (double dfVal : adfValues)
+                        osKey += CPLSPrintf("%.17g ", dfVal);
+                    osKey += '\n';
+                }
+            }
+        }
+    }
+
+    for (const char *pszOption :
+         {"GTIFF_LINEAR_UNITS", "GTIFF_SRS_SOURCE", "GTIFF_IMPORT_FROM_EPSG",
+          "OSR_STRIP_TOWGS84"})
+    {
+        osKey += pszOption;
+        osKey += '=';
+        osKey += CPLGetConfigOption(pszOption, "");
+        osKey += '\n';
+    }
+
+    return osKey;
+}
+
 /************************************************************************/
 /*                      GTIFGetOGISDefnAsOSR()                          */
 /************************************************************************/
@@ -32,6 +32,8 @@
 
 #include "geotiff.h"
 
+#include <string>
+
 #if LIBGEOTIFF_VERSION >= 1600
 
 #define GDALGTIFKeyGetASCII GTIFKeyGetASCII
@@ -51,4 +53,6 @@ int GDALGTIFKeyGetDOUBLE(GTIF *hGTIF, geokey_t key, double *pdfVal, int nIndex,
 
 #endif
 
+std::string GTIFGetSRSCacheKey(GTIF *hGTIF);
+
 #endif  // GT_WKT_SRS_PRIV_H_INCLUDED
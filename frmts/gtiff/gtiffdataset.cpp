@@ -314,8 +314,41 @@ std::tuple<CPLErr, bool> GTiffDataset::Finalize()
         delete m_poColorTable;
     m_poColorTable = nullptr;
 
+    if (m_nCompressedBlockCount > 0)
+    {
+        const char *pszCompression =
+            GTIFFGetCompressionMethodName(m_nCompression);
+        const char *pszKind = "";
+        if (m_poImageryDS)
+            pszKind = " (mask)";
+        else if (m_bIsOverview)
+            pszKind = " (overview)";
+        CPLDebug("GTiff",
+                 "%s%s: %s compression of %d strip(s)/tile(s), "
+                 "%d in worker threads, cumulated time: %.3f s",
+                 m_pszFilename ? m_pszFilename : "(null)", pszKind,
+                 pszCompression ? pszCompression : "unknown",
+                 m_nCompressedBlockCount.load(),
+                 m_nCompressedBlockCountInThreads.load(),
+                 static_cast<double>(m_nCompressionTimeUs.load()) / 1e6);
+    }
+
+    if (m_nPrefetchRequestCount > 0)
+    {
+        CPLDebug("GTiff",
+                 "%s: %d prefetch request(s), %d block(s) prefetched, "
+                 "%d hit(s) (%.1f%%)",
+                 m_pszFilename ? m_pszFilename : "(null)",
+                 m_nPrefetchRequestCount, m_nPrefetchedBlockCount,
+                 m_nPrefetchHitCount,
+                 m_nPrefetchedBlockCount
+                     ? 100.0 * m_nPrefetchHitCount / m_nPrefetchedBlockCount
+                     : 0.0);
+    }
+
     if (m_hTIFF)
     {
+        ReleasePrefetchedBlocks();
         XTIFFClose(m_hTIFF);
         m_hTIFF = nullptr;
     }
@@ -479,6 +512,9 @@ CPLErr GTiffDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
             return eErr;
     }
 
+    if (eRWFlag == GF_Read && !m_anReadPlanBlocks.empty())
+        UpdateReadPlan(nXOff, nYOff, nXSize, nYSize, nBandCount, panBandMap);
+
     if (m_eVirtualMemIOUsage != VirtualMemIOEnum::NO)
     {
         const int nErr =
@@ -983,6 +1019,8 @@ void GTiffDataset::RestoreVolatileParameters(TIFF *hTIFF)
             TIFFSetField(hTIFF, TIFFTAG_JXL_DISTANCE, m_fJXLDistance);
             TIFFSetField(hTIFF, TIFFTAG_JXL_ALPHA_DISTANCE,
                          m_fJXLAlphaDistance);
+            if (m_nJXLNumThreads > 1)
+                TIFFSetField(hTIFF, TIFFTAG_JXL_NUM_THREADS, m_nJXLNumThreads);
         }
 #endif
     }
@@ -32,6 +32,8 @@
 
 #include "gdal_pam.h"
 
+#include <atomic>
+#include <map>
 #include <queue>
 
 #include "cpl_mem_cache.h"
@@ -169,6 +171,34 @@ class GTiffDataset final : public GDALPamDataset
     lru11::Cache<int, std::pair<vsi_l_offset, vsi_l_offset>>
         m_oCacheStrileToOffsetByteCount{1024};
 
+    // Strips/tiles speculatively fetched by
+    // GTiffRasterBand::PrefetchBlocksIfNeeded(), and registered as cached
+    // ranges of m_hTIFF while m_bPrefetchedRangesActive is set.
+    std::vector<GByte> m_abyPrefetchBuffer{};
+    int m_nPrefetchRequestCount = 0;
+    int m_nPrefetchedBlockCount = 0;
+    int m_nPrefetchHitCount = 0;
+    int m_nPrefetchMaxBlocks = -1;  // -1 = not yet initialized
+
+    // Strips/tiles of the windows submitted with AdviseReadPlan(), in
+    // reading order, and their rank in it. The ranks in
+    // [m_nReadPlanBatchStart, m_nReadPlanBatchEnd[ are those whose
+    // asynchronous fetching has been requested with
+    // VSIVirtualHandle::AdviseRead().
+    std::vector<int> m_anReadPlanBlocks{};
+    std::map<int, size_t> m_oMapReadPlanBlockRank{};
+    size_t m_nReadPlanBatchStart = 0;
+    size_t m_nReadPlanBatchEnd = 0;
+    GIntBig m_nReadPlanMaxBytes = 0;
+    size_t m_nPrefetchMaxBytes = 0;
+    bool m_bPrefetchedRangesActive = false;
+
+    // Compression statistics, reported in debug mode at closing.
+    // Updated from worker threads.
+    std::atomic<int> m_nCompressedBlockCount{0};
+    std::atomic<int> m_nCompressedBlockCountInThreads{0};
+    std::atomic<int64_t> m_nCompressionTimeUs{0};
+
     MaskOffset *m_panMaskOffsetLsb = nullptr;
     char *m_pszVertUnit = nullptr;
     char *m_pszFilename = nullptr;
@@ -185,6 +215,8 @@ class GTiffDataset final : public GDALPamDataset
     float m_fJXLDistance = 1.0f;
     float m_fJXLAlphaDistance = -1.0f;  // -1 = same as non-alpha channel
     uint32_t m_nJXLEffort = 5;
+    // Threads used by libjxl to encode a single block
+    uint32_t m_nJXLNumThreads = 1;
 #endif
     double m_dfNoDataValue = DEFAULT_NODATA_VALUE;
     int64_t m_nNoDataValueInt64 = GDAL_PAM_DEFAULT_NODATA_VALUE_INT64;
@@ -380,6 +412,8 @@ class GTiffDataset final : public GDALPamDataset
                              GPtrDiff_t nCompressedBufferSize);
     bool SubmitCompressionJob(int nStripOrTile, GByte *pabyData, GPtrDiff_t cc,
                               int nHeight);
+    static bool IsThreadedCompressionSupported(int nCompression);
+    void AccountCompressionTime(int64_t nStartTimeUs);
 
     int GuessJPEGQuality(bool &bOutHasQuantizationTable,
                          bool &bOutHasHuffmanTable);
@@ -399,6 +433,7 @@ class GTiffDataset final : public GDALPamDataset
                      GDALDataType eBufType, int nBandCount, int *panBandMap,
                      GSpacing nPixelSpace, GSpacing nLineSpace,
                      GSpacing nBandSpace, GDALRasterIOExtraArg *psExtraArg);
+    const GByte *GetVirtualMemIOMapping(size_t *pnMappingSize);
 
     void SetStructuralMDFromParent(GTiffDataset *poParentDS);
 
@@ -424,11 +459,20 @@ class GTiffDataset final : public GDALPamDataset
 
     CPLErr FlushCacheInternal(bool bAtClosing, bool bFlushDirectory);
     bool HasOptimizedReadMultiRange();
+    void ReleasePrefetchedBlocks();
 
     bool AssociateExternalMask();
 
     static bool MustCreateInternalMask();
 
+    static GTiffDataset *GetSourceForRawCopy(GTiffDataset *poDstDS,
+                                             GDALDataset *poSrcDS);
+    bool CopyRawStripOrTile(GTiffDataset *poSrcDS, int nStripOrTile,
+                            std::vector<GByte> &abyBuffer);
+    CPLErr CopyRawStripsOrTiles(GTiffDataset *poSrcDS,
+                                GDALProgressFunc pfnProgress,
+                                void *pProgressData);
+
     static CPLErr CopyImageryAndMask(GTiffDataset *poDstDS,
                                      GDALDataset *poSrcDS,
                                      GDALRasterBand *poSrcMaskBand,
@@ -469,6 +513,16 @@ class GTiffDataset final : public GDALPamDataset
     CPLErr SetGCPs(int nGCPCountIn, const GDAL_GCP *pasGCPListIn,
                    const OGRSpatialReference *poSRS) override;
 
+    void IssueReadPlanBatch(size_t nStart);
+    bool GetReadPlanRanks(int nXOff, int nYOff, int nXSize, int nYSize,
+                          int nBandCount, const int *panBandMap,
+                          size_t &nMinRank, size_t &nMaxRank) const;
+    void UpdateReadPlan(int nXOff, int nYOff, int nXSize, int nYSize,
+                        int nBandCount, const int *panBandMap);
+    bool IsCoveredByReadPlanBatch(int nXOff, int nYOff, int nXSize,
+                                  int nYSize, int nBandCount,
+                                  const int *panBandMap) const;
+
     bool IsMultiThreadedReadCompatible() const;
     CPLErr MultiThreadedRead(int nXOff, int nYOff, int nXSize, int nYSize,
                              void *pData, GDALDataType eBufType, int nBandCount,
@@ -483,6 +537,15 @@ class GTiffDataset final : public GDALPamDataset
                              GSpacing nBandSpace,
                              GDALRasterIOExtraArg *psExtraArg) override;
 
+    virtual CPLErr AdviseRead(int nXOff, int nYOff, int nXSize, int nYSize,
+                              int nBufXSize, int nBufYSize, GDALDataType eDT,
+                              int nBandCount, int *panBandList,
+                              char **papszOptions) override;
+    virtual CPLErr AdviseReadPlan(int nWindowCount,
+                                  const GDALRasterWindow *pasWindows,
+                                  int nBandCount, const int *panBandList,
+                                  CSLConstList papszOptions) override;
+
     virtual CPLStringList
     GetCompressionFormats(int nXOff, int nYOff, int nXSize, int nYSize,
                           int nBandCount, const int *panBandList) override;
@@ -48,6 +48,7 @@
 
 #include "cpl_error.h"
 #include "cpl_error_internal.h"  // CPLErrorHandlerAccumulatorStruct
+#include "cpl_trace.h"
 #include "cpl_vsi.h"
 #include "cpl_vsi_virtual.h"
 #include "cpl_worker_thread_pool.h"
@@ -69,7 +70,11 @@ int GTiffDataset::GetJPEGOverviewCount()
         return m_nJPEGOverviewCount;
 
     m_nJPEGOverviewCount = 0;
-    if (m_poBaseDS || eAccess != GA_ReadOnly ||
+    // Internal overview levels are also eligible, so that requests at a
+    // resolution lower than the coarsest (or between two) explicit overview
+    // levels benefit from the reduced-resolution DCT decoding of libjpeg.
+    if (m_poImageryDS || (m_poBaseDS && !m_bIsOverview) ||
+        eAccess != GA_ReadOnly ||
         m_nCompression != COMPRESSION_JPEG ||
         (nRasterXSize < 256 && nRasterYSize < 256) ||
         !CPLTestBool(CPLGetConfigOption("GTIFF_IMPLICIT_JPEG_OVR", "YES")) ||
@@ -433,6 +438,16 @@ static void CPL_STDCALL ThreadDecompressionFuncErrorHandler(
     CPLErrorHandlerPusher oErrorHandler(ThreadDecompressionFuncErrorHandler,
                                         psContext);
 
+    CPLTraceSpan oTraceSpan("decode", "GTiffDecompressJob");
+    if (oTraceSpan.IsActive())
+    {
+        oTraceSpan.AddAttribute("dataset", poDS->GetDescription());
+        oTraceSpan.AddAttribute("x_block", psJob->nXBlock);
+        oTraceSpan.AddAttribute("y_block", psJob->nYBlock);
+        oTraceSpan.AddAttribute("compression",
+                                static_cast<int>(poDS->m_nCompression));
+    }
+
     const int nBandsPerStrile =
         poDS->m_nPlanarConfig == PLANARCONFIG_CONTIG ? poDS->nBands : 1;
     const int nBandsToWrite = poDS->m_nPlanarConfig == PLANARCONFIG_CONTIG
@@ -979,6 +994,248 @@ bool GTiffDataset::IsMultiThreadedReadCompatible() const
             m_nCompression == COMPRESSION_JPEG);
 }
 
+/************************************************************************/
+/*                           AdviseReadPlan()                           */
+/************************************************************************/
+
+// The strips/tiles intersecting the windows are collected, without
+// duplicates, in the order of the windows. Their asynchronous fetching is
+// then requested by batches, whose cumulated size is bounded by the memory
+// budget, and that are sorted by file offset so that consecutive ranges are
+// merged by the file system handler. A new batch is started when a read
+// request reaches strips/tiles beyond the current one (see UpdateReadPlan()).
+
+CPLErr GTiffDataset::AdviseReadPlan(int nWindowCount,
+                                    const GDALRasterWindow *pasWindows,
+                                    int nBandCount, const int *panBandList,
+                                    CSLConstList papszOptions)
+{
+    m_anReadPlanBlocks.clear();
+    m_oMapReadPlanBlockRank.clear();
+    m_nReadPlanBatchStart = 0;
+    m_nReadPlanBatchEnd = 0;
+
+    // Asynchronous fetching is only implemented by network file systems
+    if (eAccess != GA_ReadOnly || m_bStreamingIn || nWindowCount <= 0 ||
+        !HasOptimizedReadMultiRange())
+    {
+        return CE_None;
+    }
+
+    if (nBandCount == 0)
+    {
+        nBandCount = nBands;
+        panBandList = nullptr;
+    }
+    for (int i = 0; i < nBandCount; ++i)
+    {
+        const int nBand = panBandList ? panBandList[i] : i + 1;
+        if (nBand <= 0 || nBand > nBands)
+        {
+            ReportError(CE_Failure, CPLE_IllegalArg,
+                        "AdviseReadPlan(): Invalid band number: %d", nBand);
+            return CE_Failure;
+        }
+    }
+
+    // Bound the memory used by the plan
+    constexpr size_t MAX_READ_PLAN_BLOCKS = 1000 * 1000;
+    for (int iWindow = 0; iWindow < nWindowCount &&
+                          m_anReadPlanBlocks.size() < MAX_READ_PLAN_BLOCKS;
+         ++iWindow)
+    {
+        const GDALRasterWindow &sWindow = pasWindows[iWindow];
+        if (sWindow.nXOff < 0 || sWindow.nYOff < 0 || sWindow.nXSize <= 0 ||
+            sWindow.nYSize <= 0 ||
+            sWindow.nXSize > nRasterXSize - sWindow.nXOff ||
+            sWindow.nYSize > nRasterYSize - sWindow.nYOff)
+        {
+            continue;
+        }
+        const int nBlockX1 = sWindow.nXOff / m_nBlockXSize;
+        const int nBlockY1 = sWindow.nYOff / m_nBlockYSize;
+        const int nBlockX2 =
+            (sWindow.nXOff + sWindow.nXSize - 1) / m_nBlockXSize;
+        const int nBlockY2 =
+            (sWindow.nYOff + sWindow.nYSize - 1) / m_nBlockYSize;
+        for (int iY = nBlockY1; iY <= nBlockY2; ++iY)
+        {
+            for (int iX = nBlockX1; iX <= nBlockX2; ++iX)
+            {
+                const int nStrilePerBlock =
+                    m_nPlanarConfig == PLANARCONFIG_CONTIG ? 1 : nBandCount;
+                for (int i = 0; i < nStrilePerBlock; ++i)
+                {
+                    int nBlockId = iX + iY * m_nBlocksPerRow;
+                    if (m_nPlanarConfig == PLANARCONFIG_SEPARATE)
+                        nBlockId +=
+                            ((panBandList ? panBandList[i] : i + 1) - 1) *
+                            m_nBlocksPerBand;
+                    if (m_oMapReadPlanBlockRank
+                            .insert(std::pair<int, size_t>(
+                                nBlockId, m_anReadPlanBlocks.size()))
+                            .second)
+                    {
+                        m_anReadPlanBlocks.push_back(nBlockId);
+                    }
+                }
+            }
+        }
+    }
+
+    m_nReadPlanMaxBytes = GDALGetAdviseReadPlanMaxBytes(papszOptions);
+    IssueReadPlanBatch(0);
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                            AdviseRead()                              */
+/************************************************************************/
+
+CPLErr GTiffDataset::AdviseRead(int nXOff, int nYOff, int nXSize, int nYSize,
+                                int nBufXSize, int nBufYSize, GDALDataType eDT,
+                                int nBandCount, int *panBandList,
+                                char **papszOptions)
+{
+    // A full resolution request is a plan made of a single window.
+    if (nXSize == nBufXSize && nYSize == nBufYSize)
+    {
+        const GDALRasterWindow sWindow = {nXOff, nYOff, nXSize, nYSize};
+        return AdviseReadPlan(1, &sWindow, nBandCount, panBandList,
+                              papszOptions);
+    }
+    return GDALPamDataset::AdviseRead(nXOff, nYOff, nXSize, nYSize, nBufXSize,
+                                      nBufYSize, eDT, nBandCount, panBandList,
+                                      papszOptions);
+}
+
+/************************************************************************/
+/*                        IssueReadPlanBatch()                          */
+/************************************************************************/
+
+void GTiffDataset::IssueReadPlanBatch(size_t nStart)
+{
+    std::vector<std::pair<vsi_l_offset, size_t>> aoRanges;
+    GIntBig nBatchBytes = 0;
+    size_t nEnd = nStart;
+    for (; nEnd < m_anReadPlanBlocks.size(); ++nEnd)
+    {
+        vsi_l_offset nOffset = 0;
+        vsi_l_offset nSize = 0;
+        if (!IsBlockAvailable(m_anReadPlanBlocks[nEnd], &nOffset, &nSize) ||
+            nSize == 0)
+        {
+            continue;
+        }
+        if (nSize > static_cast<vsi_l_offset>(
+                        std::numeric_limits<GIntBig>::max() - nBatchBytes) ||
+            (!aoRanges.empty() &&
+             nBatchBytes + static_cast<GIntBig>(nSize) > m_nReadPlanMaxBytes))
+        {
+            break;
+        }
+        nBatchBytes += static_cast<GIntBig>(nSize);
+        aoRanges.emplace_back(
+            nOffset, static_cast<size_t>(std::min<vsi_l_offset>(
+                         std::numeric_limits<size_t>::max(), nSize)));
+    }
+    m_nReadPlanBatchStart = nStart;
+    m_nReadPlanBatchEnd = nEnd;
+
+    if (aoRanges.empty())
+        return;
+    std::sort(aoRanges.begin(), aoRanges.end());
+    std::vector<vsi_l_offset> anOffsets;
+    std::vector<size_t> anSizes;
+    for (const auto &oRange : aoRanges)
+    {
+        anOffsets.push_back(oRange.first);
+        anSizes.push_back(oRange.second);
+    }
+    VSI_TIFFGetVSILFile(TIFFClientdata(m_hTIFF))
+        ->AdviseRead(static_cast<int>(anOffsets.size()), anOffsets.data(),
+                     anSizes.data());
+}
+
+/************************************************************************/
+/*                          GetReadPlanRanks()                          */
+/************************************************************************/
+
+// Returns the minimum and maximum ranks, in the read plan, of the
+// strips/tiles intersecting a window, or false if none of them is part of it.
+bool GTiffDataset::GetReadPlanRanks(int nXOff, int nYOff, int nXSize,
+                                    int nYSize, int nBandCount,
+                                    const int *panBandMap, size_t &nMinRank,
+                                    size_t &nMaxRank) const
+{
+    nMinRank = std::numeric_limits<size_t>::max();
+    nMaxRank = 0;
+    bool bFound = false;
+    const int nBlockX1 = nXOff / m_nBlockXSize;
+    const int nBlockY1 = nYOff / m_nBlockYSize;
+    const int nBlockX2 = (nXOff + nXSize - 1) / m_nBlockXSize;
+    const int nBlockY2 = (nYOff + nYSize - 1) / m_nBlockYSize;
+    const int nStrilePerBlock =
+        m_nPlanarConfig == PLANARCONFIG_CONTIG ? 1 : nBandCount;
+    for (int iY = nBlockY1; iY <= nBlockY2; ++iY)
+    {
+        for (int iX = nBlockX1; iX <= nBlockX2; ++iX)
+        {
+            for (int i = 0; i < nStrilePerBlock; ++i)
+            {
+                int nBlockId = iX + iY * m_nBlocksPerRow;
+                if (m_nPlanarConfig == PLANARCONFIG_SEPARATE)
+                    nBlockId += (panBandMap[i] - 1) * m_nBlocksPerBand;
+                const auto oIter = m_oMapReadPlanBlockRank.find(nBlockId);
+                if (oIter != m_oMapReadPlanBlockRank.end())
+                {
+                    bFound = true;
+                    nMinRank = std::min(nMinRank, oIter->second);
+                    nMaxRank = std::max(nMaxRank, oIter->second);
+                }
+            }
+        }
+    }
+    return bFound;
+}
+
+/************************************************************************/
+/*                          UpdateReadPlan()                            */
+/************************************************************************/
+
+// Called before a read request is processed: if it needs strips/tiles that
+// are beyond the current batch of the read plan, start the next batch from
+// the first strip/tile of the request.
+void GTiffDataset::UpdateReadPlan(int nXOff, int nYOff, int nXSize, int nYSize,
+                                  int nBandCount, const int *panBandMap)
+{
+    size_t nMinRank = 0;
+    size_t nMaxRank = 0;
+    if (GetReadPlanRanks(nXOff, nYOff, nXSize, nYSize, nBandCount, panBandMap,
+                         nMinRank, nMaxRank) &&
+        (nMaxRank >= m_nReadPlanBatchEnd || nMinRank < m_nReadPlanBatchStart))
+    {
+        IssueReadPlanBatch(nMinRank);
+    }
+}
+
+/************************************************************************/
+/*                      IsCoveredByReadPlanBatch()                      */
+/************************************************************************/
+
+bool GTiffDataset::IsCoveredByReadPlanBatch(int nXOff, int nYOff, int nXSize,
+                                            int nYSize, int nBandCount,
+                                            const int *panBandMap) const
+{
+    size_t nMinRank = 0;
+    size_t nMaxRank = 0;
+    return !m_anReadPlanBlocks.empty() &&
+           GetReadPlanRanks(nXOff, nYOff, nXSize, nYSize, nBandCount,
+                            panBandMap, nMinRank, nMaxRank) &&
+           nMinRank >= m_nReadPlanBatchStart && nMaxRank < m_nReadPlanBatchEnd;
+}
+
 /************************************************************************/
 /*                        MultiThreadedRead()                           */
 /************************************************************************/
@@ -990,7 +1247,9 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
                                        GSpacing nPixelSpace,
                                        GSpacing nLineSpace, GSpacing nBandSpace)
 {
-    auto poQueue = m_poThreadPool->CreateJobQueue();
+    // Decompression jobs are latency sensitive, as the caller is waiting
+    // for them.
+    auto poQueue = m_poThreadPool->CreateJobQueue(CPLJobPriority::HIGH);
     if (poQueue == nullptr)
     {
         return CE_Failure;
@@ -1386,8 +1645,11 @@ CPLErr GTiffDataset::MultiThreadedRead(int nXOff, int nYOff, int nXSize,
     if (sContext.bSuccess)
     {
         // Potentially start asynchronous fetching of ranges depending on file
-        // implementation
-        if (nAdviseReadRanges > 0)
+        // implementation, unless they are part of the current batch of the
+        // read plan.
+        if (nAdviseReadRanges > 0 &&
+            !IsCoveredByReadPlanBatch(nXOff, nYOff, nXSize, nYSize, nBandCount,
+                                      panBandMap))
         {
             sContext.poHandle->AdviseRead(nAdviseReadRanges, anOffsets.data(),
                                           anSizes.data());
@@ -1483,48 +1745,23 @@ class FetchBufferVirtualMemIO final
 };
 
 /************************************************************************/
-/*                         VirtualMemIO()                               */
+/*                      GetVirtualMemIOMapping()                        */
 /************************************************************************/
 
-int GTiffDataset::VirtualMemIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
-                               int nXSize, int nYSize, void *pData,
-                               int nBufXSize, int nBufYSize,
-                               GDALDataType eBufType, int nBandCount,
-                               int *panBandMap, GSpacing nPixelSpace,
-                               GSpacing nLineSpace, GSpacing nBandSpace,
-                               GDALRasterIOExtraArg *psExtraArg)
+// Returns the address of the read-only memory mapping of the whole file
+// used by GTIFF_VIRTUAL_MEM_IO (or of the buffer of a /vsimem/ file),
+// establishing it on first use, or nullptr if it is not available.
+const GByte *GTiffDataset::GetVirtualMemIOMapping(size_t *pnMappingSize)
 {
-    if (eAccess == GA_Update || eRWFlag == GF_Write || m_bStreamingIn)
-        return -1;
-
-    // Only know how to deal with nearest neighbour in this optimized routine.
-    if ((nXSize != nBufXSize || nYSize != nBufYSize) && psExtraArg != nullptr &&
-        psExtraArg->eResampleAlg != GRIORA_NearestNeighbour)
-    {
-        return -1;
-    }
-
-    const GDALDataType eDataType = GetRasterBand(1)->GetRasterDataType();
-    const int nDTSizeBits = GDALGetDataTypeSizeBits(eDataType);
-    if (!(m_nCompression == COMPRESSION_NONE &&
-          (m_nPhotometric == PHOTOMETRIC_MINISBLACK ||
-           m_nPhotometric == PHOTOMETRIC_RGB ||
-           m_nPhotometric == PHOTOMETRIC_PALETTE) &&
-          m_nBitsPerSample == nDTSizeBits))
-    {
-        m_eVirtualMemIOUsage = VirtualMemIOEnum::NO;
-        return -1;
-    }
-
-    size_t nMappingSize = 0;
-    GByte *pabySrcData = nullptr;
+    *pnMappingSize = 0;
     if (STARTS_WITH(m_pszFilename, "/vsimem/"))
     {
         vsi_l_offset nDataLength = 0;
-        pabySrcData = VSIGetMemFileBuffer(m_pszFilename, &nDataLength, FALSE);
-        nMappingSize = static_cast<size_t>(nDataLength);
-        if (pabySrcData == nullptr)
-            return -1;
+        const GByte *pabyData =
+            VSIGetMemFileBuffer(m_pszFilename, &nDataLength, FALSE);
+        if (pabyData)
+            *pnMappingSize = static_cast<size_t>(nDataLength);
+        return pabyData;
     }
     else if (m_psVirtualMemIOMapping == nullptr)
     {
@@ -1533,18 +1770,18 @@ int GTiffDataset::VirtualMemIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
             VSIFGetNativeFileDescriptorL(fp) == nullptr)
         {
             m_eVirtualMemIOUsage = VirtualMemIOEnum::NO;
-            return -1;
+            return nullptr;
         }
         if (VSIFSeekL(fp, 0, SEEK_END) != 0)
         {
             m_eVirtualMemIOUsage = VirtualMemIOEnum::NO;
-            return -1;
+            return nullptr;
         }
         const vsi_l_offset nLength = VSIFTellL(fp);
         if (static_cast<size_t>(nLength) != nLength)
         {
             m_eVirtualMemIOUsage = VirtualMemIOEnum::NO;
-            return -1;
+            return nullptr;
         }
         if (m_eVirtualMemIOUsage == VirtualMemIOEnum::IF_ENOUGH_RAM)
         {
@@ -1554,7 +1791,7 @@ int GTiffDataset::VirtualMemIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                 CPLDebug("GTiff",
                          "Not enough RAM to map whole file into memory.");
                 m_eVirtualMemIOUsage = VirtualMemIOEnum::NO;
-                return -1;
+                return nullptr;
             }
         }
         m_psVirtualMemIOMapping = CPLVirtualMemFileMapNew(
@@ -1562,20 +1799,57 @@ int GTiffDataset::VirtualMemIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         if (m_psVirtualMemIOMapping == nullptr)
         {
             m_eVirtualMemIOUsage = VirtualMemIOEnum::NO;
-            return -1;
+            return nullptr;
         }
         m_eVirtualMemIOUsage = VirtualMemIOEnum::YES;
     }
 
-    if (m_psVirtualMemIOMapping)
+    *pnMappingSize = CPLVirtualMemGetSize(m_psVirtualMemIOMapping);
+    return static_cast<const GByte *>(
+        CPLVirtualMemGetAddr(m_psVirtualMemIOMapping));
+}
+
+/************************************************************************/
+/*                         VirtualMemIO()                               */
+/************************************************************************/
+
+int GTiffDataset::VirtualMemIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
+                               int nXSize, int nYSize, void *pData,
+                               int nBufXSize, int nBufYSize,
+                               GDALDataType eBufType, int nBandCount,
+                               int *panBandMap, GSpacing nPixelSpace,
+                               GSpacing nLineSpace, GSpacing nBandSpace,
+                               GDALRasterIOExtraArg *psExtraArg)
+{
+    if (eAccess == GA_Update || eRWFlag == GF_Write || m_bStreamingIn)
+        return -1;
+
+    // Only know how to deal with nearest neighbour in this optimized routine.
+    if ((nXSize != nBufXSize || nYSize != nBufYSize) && psExtraArg != nullptr &&
+        psExtraArg->eResampleAlg != GRIORA_NearestNeighbour)
     {
+        return -1;
+    }
+
+    const GDALDataType eDataType = GetRasterBand(1)->GetRasterDataType();
+    const int nDTSizeBits = GDALGetDataTypeSizeBits(eDataType);
+    if (!(m_nCompression == COMPRESSION_NONE &&
+          (m_nPhotometric == PHOTOMETRIC_MINISBLACK ||
+           m_nPhotometric == PHOTOMETRIC_RGB ||
+           m_nPhotometric == PHOTOMETRIC_PALETTE) &&
+          m_nBitsPerSample == nDTSizeBits))
+    {
+        m_eVirtualMemIOUsage = VirtualMemIOEnum::NO;
+        return -1;
+    }
+
+    size_t nMappingSize = 0;
+    const GByte *pabySrcData = GetVirtualMemIOMapping(&nMappingSize);
+    if (pabySrcData == nullptr)
+        return -1;
 #ifdef DEBUG
-        CPLDebug("GTiff", "Using VirtualMemIO");
+    CPLDebug("GTiff", "Using VirtualMemIO");
 #endif
-        nMappingSize = CPLVirtualMemGetSize(m_psVirtualMemIOMapping);
-        pabySrcData =
-            static_cast<GByte *>(CPLVirtualMemGetAddr(m_psVirtualMemIOMapping));
-    }
 
     if (TIFFIsByteSwapped(m_hTIFF) && m_pTempBufferForCommonDirectIO == nullptr)
     {
@@ -3139,6 +3413,51 @@ int GTiffDataset::DirectIO(GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize,
 bool GTiffDataset::ReadStrile(int nBlockId, void *pOutputBuffer,
                               GPtrDiff_t nBlockReqSize)
 {
+    CPLTraceSpan oTraceSpan("decode", "GTiffReadStrile");
+    if (oTraceSpan.IsActive())
+    {
+        oTraceSpan.AddAttribute("dataset", GetDescription());
+        oTraceSpan.AddAttribute("strile", nBlockId);
+        oTraceSpan.AddAttribute("compression",
+                                static_cast<int>(m_nCompression));
+    }
+
+    // When GTIFF_VIRTUAL_MEM_IO is enabled, uncompressed striles are
+    // directly copied from the memory mapping of the file, instead of going
+    // through the file API of libtiff.
+    if (m_eVirtualMemIOUsage != VirtualMemIOEnum::NO &&
+        m_nCompression == COMPRESSION_NONE && eAccess == GA_ReadOnly &&
+        !m_bStreamingIn)
+    {
+        // TIFFReadFromUserBuffer() reverses bits in place in its input
+        // buffer for FILLORDER=LSB2MSB, which we cannot do on a read-only
+        // mapping.
+        uint16_t nFillOrder = FILLORDER_MSB2LSB;
+        TIFFGetFieldDefaulted(m_hTIFF, TIFFTAG_FILLORDER, &nFillOrder);
+        size_t nMappingSize = 0;
+        const GByte *pabyMapping =
+            nFillOrder == FILLORDER_MSB2LSB
+                ? GetVirtualMemIOMapping(&nMappingSize)
+                : nullptr;
+        if (pabyMapping)
+        {
+            const vsi_l_offset nOffset = TIFFGetStrileOffset(m_hTIFF, nBlockId);
+            const vsi_l_offset nSize =
+                TIFFGetStrileByteCount(m_hTIFF, nBlockId);
+            // Truncated striles are left to the regular code path.
+            if (nOffset > 0 && nOffset < nMappingSize &&
+                nSize <= nMappingSize - nOffset &&
+                nSize >= static_cast<vsi_l_offset>(nBlockReqSize) &&
+                TIFFReadFromUserBuffer(
+                    m_hTIFF, nBlockId,
+                    const_cast<GByte *>(pabyMapping + nOffset),
+                    static_cast<size_t>(nSize), pOutputBuffer, nBlockReqSize))
+            {
+                return true;
+            }
+        }
+    }
+
     // Optimization by which we can save some libtiff buffer copy
     std::pair<vsi_l_offset, vsi_l_offset> oPair;
     if (
@@ -3939,6 +4258,18 @@ GDALDataset *GTiffDataset::Open(GDALOpenInfo *poOpenInfo)
         poDS->LoadGeoreferencingAndPamIfNeeded();
     }
 
+    // Populate the header cache for next openings of the file.
+    thandle_t th = TIFFClientdata(poDS->m_hTIFF);
+    if (VSI_TIFFIsRecordingHeader(th))
+    {
+        // With a COG layout, all IFDs are at the beginning of the file, so
+        // it is cheap to scan them now, and that saves later network
+        // requests when accessing overviews.
+        if (poDS->m_bLayoutIFDSBeforeData && !poDS->m_bStreamingIn)
+            poDS->ScanDirectories();
+        VSI_TIFFStoreHeaderCache(th);
+    }
+
     return poDS;
 }
 
@@ -4048,16 +4379,37 @@ void GTiffDataset::LookForProjectionFromGeoTIFF()
     {
         GTIFDefn *psGTIFDefn = GTIFAllocDefn();
 
+        // Building the SRS from the GeoKeys involves many lookups in the
+        // PROJ database, so reuse the result obtained with the same GeoKeys
+        // when opening a previous file.
+        const std::string osSRSCacheKey = GTIFGetSRSCacheKey(hGTIF);
+        auto poCachedSRS = OSRGetFromSharedCache(osSRSCacheKey);
+
         bool bHasErrorBefore = CPLGetLastErrorType() != 0;
         // Collect (PROJ) error messages and remit them later as warnings
         std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors;
-        CPLInstallErrorHandlerAccumulator(aoErrors);
-        const int ret = GTIFGetDefn(hGTIF, psGTIFDefn);
-        CPLUninstallErrorHandlerAccumulator();
+        int ret = FALSE;
+        if (poCachedSRS)
+        {
+            ret = TRUE;
+        }
+        else
+        {
+            CPLInstallErrorHandlerAccumulator(aoErrors);
+            ret = GTIFGetDefn(hGTIF, psGTIFDefn);
+            CPLUninstallErrorHandlerAccumulator();
+        }
 
         bool bWarnAboutEllipsoid = true;
 
-        if (ret)
+        if (poCachedSRS)
+        {
+            CPLFree(m_pszXMLFilename);
+            m_pszXMLFilename = nullptr;
+
+            m_oSRS = *poCachedSRS;
+        }
+        else if (ret)
         {
             CPLInstallErrorHandlerAccumulator(aoErrors);
 
@@ -4081,6 +4433,11 @@ void GTiffDataset::LookForProjectionFromGeoTIFF()
 
                 m_oSRS = *(OGRSpatialReference::FromHandle(hSRS));
                 OSRDestroySpatialReference(hSRS);
+
+                // Only cache results without warnings, which would otherwise
+                // not be emitted when reusing them
+                if (aoErrors.empty())
+                    OSRInsertIntoSharedCache(osSRSCacheKey, m_oSRS);
             }
         }
 
@@ -6598,3 +6955,20 @@ bool GTiffDataset::HasOptimizedReadMultiRange()
                "GTIFF_HAS_OPTIMIZED_READ_MULTI_RANGE", "NO")));
     return m_nHasOptimizedReadMultiRange != 0;
 }
+
+/************************************************************************/
+/*                      ReleasePrefetchedBlocks()                       */
+/************************************************************************/
+
+// Unregister and free the ranges fetched by
+// GTiffRasterBand::PrefetchBlocksIfNeeded(), if any.
+void GTiffDataset::ReleasePrefetchedBlocks()
+{
+    if (m_bPrefetchedRangesActive)
+    {
+        VSI_TIFFSetCachedRanges(TIFFClientdata(m_hTIFF), 0, nullptr, nullptr,
+                                nullptr);
+        m_bPrefetchedRangesActive = false;
+    }
+    std::vector<GByte>().swap(m_abyPrefetchBuffer);
+}
@@ -35,6 +35,7 @@
 #include <cerrno>
 
 #include <algorithm>
+#include <chrono>
 #include <limits>
 #include <memory>
 #include <mutex>
@@ -532,6 +533,30 @@ inline bool GTiffDataset::IsFirstPixelEqualToNoData(const void *pBuffer)
     return false;
 }
 
+/************************************************************************/
+/*                         GetMonotonicTimeUs()                         */
+/************************************************************************/
+
+static int64_t GetMonotonicTimeUs()
+{
+    return static_cast<int64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+/************************************************************************/
+/*                       AccountCompressionTime()                       */
+/************************************************************************/
+
+void GTiffDataset::AccountCompressionTime(int64_t nStartTimeUs)
+{
+    if (m_nCompression == COMPRESSION_NONE)
+        return;
+    ++m_nCompressedBlockCount;
+    m_nCompressionTimeUs += GetMonotonicTimeUs() - nStartTimeUs;
+}
+
 /************************************************************************/
 /*                        WriteEncodedTile()                            */
 /************************************************************************/
@@ -691,7 +716,10 @@ bool GTiffDataset::WriteEncodedTile(uint32_t tile, GByte *pabyData,
     if (SubmitCompressionJob(tile, pabyData, cc, m_nBlockYSize))
         return true;
 
-    return TIFFWriteEncodedTile(m_hTIFF, tile, pabyData, cc) == cc;
+    const int64_t nStartTimeUs = GetMonotonicTimeUs();
+    const bool bRet = TIFFWriteEncodedTile(m_hTIFF, tile, pabyData, cc) == cc;
+    AccountCompressionTime(nStartTimeUs);
+    return bRet;
 }
 
 /************************************************************************/
@@ -792,7 +820,10 @@ bool GTiffDataset::WriteEncodedStrip(uint32_t strip, GByte *pabyData,
     if (SubmitCompressionJob(strip, pabyData, cc, nStripHeight))
         return true;
 
-    return TIFFWriteEncodedStrip(m_hTIFF, strip, pabyData, cc) == cc;
+    const int64_t nStartTimeUs = GetMonotonicTimeUs();
+    const bool bRet = TIFFWriteEncodedStrip(m_hTIFF, strip, pabyData, cc) == cc;
+    AccountCompressionTime(nStartTimeUs);
+    return bRet;
 }
 
 /************************************************************************/
@@ -802,13 +833,32 @@ bool GTiffDataset::WriteEncodedStrip(uint32_t strip, GByte *pabyData,
 void GTiffDataset::InitCompressionThreads(bool bUpdateMode,
                                           CSLConstList papszOptions)
 {
+    const char *pszValue = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszValue == nullptr)
+        pszValue = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+
     // Raster == tile, then no need for threads
     if (m_nBlockXSize == nRasterXSize && m_nBlockYSize == nRasterYSize)
+    {
+#ifdef HAVE_JXL
+        // ... except for libjxl, that can split the encoding of a tile
+        if (bUpdateMode && pszValue && m_nCompression == COMPRESSION_JXL)
+        {
+            const int nThreads =
+                EQUAL(pszValue, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszValue);
+            if (nThreads > 1)
+            {
+                // 1024: to please Coverity
+                m_nJXLNumThreads =
+                    static_cast<uint32_t>(std::min(nThreads, 1024));
+                TIFFSetField(m_hTIFF, TIFFTAG_JXL_NUM_THREADS,
+                             m_nJXLNumThreads);
+            }
+        }
+#endif
         return;
+    }
 
-    const char *pszValue = CSLFetchNameValue(papszOptions, "NUM_THREADS");
-    if (pszValue == nullptr)
-        pszValue = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
     if (pszValue)
     {
         int nThreads =
@@ -826,7 +876,8 @@ void GTiffDataset::InitCompressionThreads(bool bUpdateMode,
 
                 m_poThreadPool = GDALGetGlobalThreadPool(nThreads);
                 if (bUpdateMode && m_poThreadPool)
-                    m_poCompressQueue = m_poThreadPool->CreateJobQueue();
+                    m_poCompressQueue = m_poThreadPool->CreateJobQueue(
+                        CPLJobPriority::LOW);
 
                 if (m_poCompressQueue != nullptr)
                 {
@@ -857,6 +908,24 @@ void GTiffDataset::InitCompressionThreads(bool bUpdateMode,
                     // This should likely rather fixed in libtiff itself.
                     CPL_IGNORE_RET_VAL(
                         TIFFWriteBufferSetup(m_hTIFF, nullptr, -1));
+
+#ifdef HAVE_JXL
+                    // When there are less blocks than threads, let libjxl
+                    // use the threads that would otherwise remain idle to
+                    // encode each block.
+                    const int nBlocks =
+                        m_nPlanarConfig == PLANARCONFIG_SEPARATE
+                            ? m_nBlocksPerBand * nBands
+                            : m_nBlocksPerBand;
+                    if (m_nCompression == COMPRESSION_JXL && nBlocks > 0 &&
+                        nThreads / nBlocks > 1)
+                    {
+                        m_nJXLNumThreads =
+                            static_cast<uint32_t>(nThreads / nBlocks);
+                        TIFFSetField(m_hTIFF, TIFFTAG_JXL_NUM_THREADS,
+                                     m_nJXLNumThreads);
+                    }
+#endif
                 }
             }
         }
@@ -907,8 +976,10 @@ void GTiffDataset::ThreadCompressionFunc(void *pData)
 
     poDS->RestoreVolatileParameters(hTIFFTmp);
 
+    const int64_t nStartTimeUs = GetMonotonicTimeUs();
     bool bOK = TIFFWriteEncodedStrip(hTIFFTmp, 0, psJob->pabyBuffer,
                                      psJob->nBufferSize) == psJob->nBufferSize;
+    poDS->AccountCompressionTime(nStartTimeUs);
 
     toff_t nOffset = 0;
     if (bOK)
@@ -1208,6 +1279,38 @@ void GTiffDataset::WaitCompletionForBlock(int nBlockId)
     }
 }
 
+/************************************************************************/
+/*                   IsThreadedCompressionSupported()                   */
+/************************************************************************/
+
+// Whether strips/tiles compressed with nCompression can be compressed
+// independently in a temporary TIFF file by ThreadCompressionFunc(), with
+// the result being identical to what the main TIFF handle would produce.
+bool GTiffDataset::IsThreadedCompressionSupported(int nCompression)
+{
+    switch (nCompression)
+    {
+        case COMPRESSION_ADOBE_DEFLATE:
+        case COMPRESSION_LZW:
+        case COMPRESSION_PACKBITS:
+        case COMPRESSION_LZMA:
+        case COMPRESSION_ZSTD:
+        case COMPRESSION_LERC:
+        case COMPRESSION_JXL:
+        case COMPRESSION_WEBP:
+        case COMPRESSION_JPEG:
+        // CCITT codecs encode each strip/tile independently, and GDAL
+        // uses their default options.
+        case COMPRESSION_CCITTRLE:
+        case COMPRESSION_CCITTFAX3:
+        case COMPRESSION_CCITTFAX4:
+            return true;
+        default:
+            break;
+    }
+    return false;
+}
+
 /************************************************************************/
 /*                      SubmitCompressionJob()                          */
 /************************************************************************/
@@ -1260,15 +1363,7 @@ bool GTiffDataset::SubmitCompressionJob(int nStripOrTile, GByte *pabyData,
                      &sJob.pExtraSamples);
     };
 
-    if (poQueue == nullptr || !(m_nCompression == COMPRESSION_ADOBE_DEFLATE ||
-                                m_nCompression == COMPRESSION_LZW ||
-                                m_nCompression == COMPRESSION_PACKBITS ||
-                                m_nCompression == COMPRESSION_LZMA ||
-                                m_nCompression == COMPRESSION_ZSTD ||
-                                m_nCompression == COMPRESSION_LERC ||
-                                m_nCompression == COMPRESSION_JXL ||
-                                m_nCompression == COMPRESSION_WEBP ||
-                                m_nCompression == COMPRESSION_JPEG))
+    if (poQueue == nullptr || !IsThreadedCompressionSupported(m_nCompression))
     {
         if (m_bBlockOrderRowMajor || m_bLeaderSizeAsUInt4 ||
             m_bTrailerRepeatedLast4BytesRepeated)
@@ -1325,6 +1420,7 @@ bool GTiffDataset::SubmitCompressionJob(int nStripOrTile, GByte *pabyData,
 
     GTiffCompressionJob *psJob = &asJobs[nNextCompressionJobAvail];
     SetupJob(*psJob);
+    ++m_nCompressedBlockCountInThreads;
     poQueue->SubmitJob(ThreadCompressionFunc, psJob);
     oQueue.push(nNextCompressionJobAvail);
 
@@ -6293,6 +6389,252 @@ GDALDataset *GTiffDataset::Create(const char *pszFilename, int nXSize,
     return poDS;
 }
 
+/************************************************************************/
+/*                         GetSourceForRawCopy()                        */
+/************************************************************************/
+
+// Returns poSrcDS as a GTiffDataset if its strips/tiles can be copied
+// without being decompressed and recompressed, that is if they decode to
+// exactly the same pixels that a decompression and recompression with the
+// parameters of poDstDS would give, or in the case of JPEG, if the
+// compression parameters are identical.
+GTiffDataset *GTiffDataset::GetSourceForRawCopy(GTiffDataset *poDstDS,
+                                                GDALDataset *poSrcDS)
+{
+    auto poSrcGTiffDS = dynamic_cast<GTiffDataset *>(poSrcDS);
+    if (poSrcGTiffDS == nullptr || poSrcGTiffDS->GetAccess() != GA_ReadOnly ||
+        poDstDS->m_bStreamingOut || poDstDS->m_bTreatAsSplit ||
+        poDstDS->m_bTreatAsSplitBitmap || poSrcGTiffDS->m_bTreatAsSplit ||
+        poSrcGTiffDS->m_bTreatAsSplitBitmap ||
+        poDstDS->m_panMaskOffsetLsb != nullptr ||
+        // Raw copy would not skip blocks that have only nodata values
+        (!poDstDS->m_bWriteEmptyTiles &&
+         !poDstDS->m_bFillEmptyTilesAtClosing) ||
+        !CPLTestBool(CPLGetConfigOption("GTIFF_COPY_RAW_BLOCKS", "YES")))
+    {
+        return nullptr;
+    }
+    if (poSrcGTiffDS->nRasterXSize != poDstDS->nRasterXSize ||
+        poSrcGTiffDS->nRasterYSize != poDstDS->nRasterYSize ||
+        poSrcGTiffDS->nBands != poDstDS->nBands ||
+        poSrcGTiffDS->m_nBlockXSize != poDstDS->m_nBlockXSize ||
+        poSrcGTiffDS->m_nBlockYSize != poDstDS->m_nBlockYSize ||
+        poSrcGTiffDS->m_nCompression != poDstDS->m_nCompression ||
+        poSrcGTiffDS->m_nPlanarConfig != poDstDS->m_nPlanarConfig ||
+        poSrcGTiffDS->m_nBitsPerSample != poDstDS->m_nBitsPerSample ||
+        poSrcGTiffDS->m_nSampleFormat != poDstDS->m_nSampleFormat ||
+        poSrcGTiffDS->m_nPhotometric != poDstDS->m_nPhotometric ||
+        poSrcGTiffDS->GetRasterBand(1)->GetRasterDataType() !=
+            poDstDS->GetRasterBand(1)->GetRasterDataType())
+    {
+        return nullptr;
+    }
+    if (!poSrcGTiffDS->SetDirectory())
+        return nullptr;
+    TIFF *hSrcTIFF = poSrcGTiffDS->m_hTIFF;
+    TIFF *hDstTIFF = poDstDS->m_hTIFF;
+    if (TIFFIsTiled(hSrcTIFF) != TIFFIsTiled(hDstTIFF) ||
+        (poDstDS->m_nBitsPerSample > 8 &&
+         TIFFIsByteSwapped(hSrcTIFF) != TIFFIsByteSwapped(hDstTIFF)))
+    {
+        return nullptr;
+    }
+    uint16_t nSrcFillOrder = 0;
+    uint16_t nDstFillOrder = 0;
+    TIFFGetFieldDefaulted(hSrcTIFF, TIFFTAG_FILLORDER, &nSrcFillOrder);
+    TIFFGetFieldDefaulted(hDstTIFF, TIFFTAG_FILLORDER, &nDstFillOrder);
+    if (nSrcFillOrder != nDstFillOrder)
+        return nullptr;
+
+    const auto nCompression = poDstDS->m_nCompression;
+    if (GTIFFSupportsPredictor(nCompression))
+    {
+        uint16_t nSrcPredictor = PREDICTOR_NONE;
+        uint16_t nDstPredictor = PREDICTOR_NONE;
+        TIFFGetField(hSrcTIFF, TIFFTAG_PREDICTOR, &nSrcPredictor);
+        TIFFGetField(hDstTIFF, TIFFTAG_PREDICTOR, &nDstPredictor);
+        if (nSrcPredictor != nDstPredictor)
+            return nullptr;
+    }
+
+    if (nCompression == COMPRESSION_JPEG)
+    {
+        // Lossy: only if the quantization and Huffman tables are the same.
+        uint32_t nSrcTableSize = 0;
+        const void *pSrcTable = nullptr;
+        uint32_t nDstTableSize = 0;
+        const void *pDstTable = nullptr;
+        if (!TIFFGetField(hSrcTIFF, TIFFTAG_JPEGTABLES, &nSrcTableSize,
+                          &pSrcTable))
+            nSrcTableSize = 0;
+        if (!TIFFGetField(hDstTIFF, TIFFTAG_JPEGTABLES, &nDstTableSize,
+                          &pDstTable))
+            nDstTableSize = 0;
+        if (nSrcTableSize != nDstTableSize ||
+            (nSrcTableSize > 0 &&
+             memcmp(pSrcTable, pDstTable, nSrcTableSize) != 0))
+        {
+            return nullptr;
+        }
+        if (poDstDS->m_nPhotometric == PHOTOMETRIC_YCBCR)
+        {
+            uint16_t nSrcSubSampling0 = 0;
+            uint16_t nSrcSubSampling1 = 0;
+            uint16_t nDstSubSampling0 = 0;
+            uint16_t nDstSubSampling1 = 0;
+            TIFFGetFieldDefaulted(hSrcTIFF, TIFFTAG_YCBCRSUBSAMPLING,
+                                  &nSrcSubSampling0, &nSrcSubSampling1);
+            TIFFGetFieldDefaulted(hDstTIFF, TIFFTAG_YCBCRSUBSAMPLING,
+                                  &nDstSubSampling0, &nDstSubSampling1);
+            if (nSrcSubSampling0 != nDstSubSampling0 ||
+                nSrcSubSampling1 != nDstSubSampling1)
+            {
+                return nullptr;
+            }
+        }
+    }
+    else if (nCompression == COMPRESSION_LERC)
+    {
+        if (poDstDS->m_dfMaxZError != 0)
+            return nullptr;
+        uint32_t nSrcCount = 0;
+        uint32_t *panSrcParams = nullptr;
+        uint32_t nDstCount = 0;
+        uint32_t *panDstParams = nullptr;
+        if (!TIFFGetField(hSrcTIFF, TIFFTAG_LERC_PARAMETERS, &nSrcCount,
+                          &panSrcParams) ||
+            !TIFFGetField(hDstTIFF, TIFFTAG_LERC_PARAMETERS, &nDstCount,
+                          &panDstParams) ||
+            nSrcCount != nDstCount ||
+            memcmp(panSrcParams, panDstParams,
+                   nSrcCount * sizeof(uint32_t)) != 0)
+        {
+            return nullptr;
+        }
+    }
+    else if (nCompression == COMPRESSION_WEBP)
+    {
+        if (!poDstDS->m_bWebPLossless)
+            return nullptr;
+    }
+#if HAVE_JXL
+    else if (nCompression == COMPRESSION_JXL)
+    {
+        if (!poDstDS->m_bJXLLossless)
+            return nullptr;
+    }
+#endif
+
+    CPLDebug("GTiff", "Copying raw %s from %s",
+             TIFFIsTiled(hDstTIFF) ? "tiles" : "strips",
+             poSrcGTiffDS->GetDescription());
+    return poSrcGTiffDS;
+}
+
+/************************************************************************/
+/*                        CopyRawStripOrTile()                          */
+/************************************************************************/
+
+// Copies the strip/tile nStripOrTile of poSrcDS, as returned by
+// GetSourceForRawCopy(), without decompressing it.
+// Returns false if the strip/tile is missing in the source or cannot be read,
+// in which case the caller should fallback to the regular copy method.
+bool GTiffDataset::CopyRawStripOrTile(GTiffDataset *poSrcDS, int nStripOrTile,
+                                      std::vector<GByte> &abyBuffer)
+{
+    if (!poSrcDS->SetDirectory())
+        return false;
+    vsi_l_offset nSize = 0;
+    if (!poSrcDS->IsBlockAvailable(nStripOrTile, nullptr, &nSize) ||
+        nSize == 0 ||
+        nSize > static_cast<vsi_l_offset>(std::numeric_limits<int>::max()))
+    {
+        return false;
+    }
+    try
+    {
+        abyBuffer.resize(static_cast<size_t>(nSize));
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+    const tmsize_t nRead =
+        TIFFIsTiled(poSrcDS->m_hTIFF)
+            ? TIFFReadRawTile(poSrcDS->m_hTIFF, nStripOrTile, abyBuffer.data(),
+                              static_cast<tmsize_t>(nSize))
+            : TIFFReadRawStrip(poSrcDS->m_hTIFF, nStripOrTile,
+                               abyBuffer.data(), static_cast<tmsize_t>(nSize));
+    if (nRead != static_cast<tmsize_t>(nSize))
+        return false;
+
+    // Make sure that pending compression jobs, for example of the mask, are
+    // written before, so that the order of striles is preserved.
+    auto poQueue = m_poBaseDS ? m_poBaseDS->m_poCompressQueue.get()
+                              : m_poCompressQueue.get();
+    if (poQueue)
+    {
+        poQueue->WaitCompletion();
+        // cppcheck-suppress constVariableReference
+        auto &oQueue =
+            m_poBaseDS ? m_poBaseDS->m_asQueueJobIdx : m_asQueueJobIdx;
+        while (!oQueue.empty())
+        {
+            WaitCompletionForJobIdx(oQueue.front());
+        }
+    }
+
+    WriteRawStripOrTile(nStripOrTile, abyBuffer.data(),
+                        static_cast<GPtrDiff_t>(nSize));
+    return true;
+}
+
+/************************************************************************/
+/*                        CopyRawStripsOrTiles()                        */
+/************************************************************************/
+
+CPLErr GTiffDataset::CopyRawStripsOrTiles(GTiffDataset *poSrcDS,
+                                          GDALProgressFunc pfnProgress,
+                                          void *pProgressData)
+{
+    Crystalize();
+
+    const int nStriles =
+        m_nBlocksPerBand *
+        (m_nPlanarConfig == PLANARCONFIG_SEPARATE ? nBands : 1);
+    std::vector<GByte> abyBuffer;
+    for (int i = 0; i < nStriles; ++i)
+    {
+        if (!poSrcDS->SetDirectory())
+            return CE_Failure;
+        bool bErrOccurred = false;
+        if (poSrcDS->IsBlockAvailable(i, nullptr, nullptr, &bErrOccurred))
+        {
+            if (!CopyRawStripOrTile(poSrcDS, i, abyBuffer))
+            {
+                ReportError(CE_Failure, CPLE_AppDefined,
+                            "Cannot copy strip/tile %d of %s", i,
+                            poSrcDS->GetDescription());
+                return CE_Failure;
+            }
+        }
+        else if (bErrOccurred)
+        {
+            return CE_Failure;
+        }
+        if (m_bWriteError)
+            return CE_Failure;
+        if (pfnProgress &&
+            !pfnProgress(static_cast<double>(i + 1) / nStriles, nullptr,
+                         pProgressData))
+        {
+            ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+    }
+    return CE_None;
+}
+
 /************************************************************************/
 /*                           CopyImageryAndMask()                       */
 /************************************************************************/
@@ -6330,6 +6672,9 @@ CPLErr GTiffDataset::CopyImageryAndMask(GTiffDataset *poDstDS,
         CPLAssert(poDstDS->m_poMaskDS->m_nBlockYSize == poDstDS->m_nBlockYSize);
     }
 
+    GTiffDataset *poSrcRawDS = GetSourceForRawCopy(poDstDS, poSrcDS);
+    std::vector<GByte> abyRawBuffer;
+
     int iBlock = 0;
     for (int iY = 0, nYBlock = 0; iY < nYSize && eErr == CE_None;
          iY = ((nYSize - iY < poDstDS->m_nBlockYSize)
@@ -6353,7 +6698,12 @@ CPLErr GTiffDataset::CopyImageryAndMask(GTiffDataset *poDstDS,
                            poDstDS->m_nBlockYSize * l_nBands * nDataTypeSize);
             }
 
-            if (!bIsOddBand)
+            if (poSrcRawDS &&
+                poDstDS->CopyRawStripOrTile(poSrcRawDS, iBlock, abyRawBuffer))
+            {
+                // done
+            }
+            else if (!bIsOddBand)
             {
                 eErr = poSrcDS->RasterIO(
                     GF_Read, iX, iY, nReqXSize, nReqYSize, pBlockBuffer,
@@ -8079,6 +8429,11 @@ GDALDataset *GTiffDataset::CreateCopy(const char *pszFilename,
                 bWriteMask = false;
             }
         }
+        else if (auto poSrcRawDS = GetSourceForRawCopy(poDS, poSrcDS))
+        {
+            eErr = poDS->CopyRawStripsOrTiles(poSrcRawDS, GDALScaledProgress,
+                                              pScaledData);
+        }
         else
         {
             eErr = GDALDatasetCopyWholeRaster(
@@ -280,7 +280,7 @@ CPLErr GTiffJPEGOverviewBand::IReadBlock(int nBlockXOff, int nBlockYOff,
                             "</SubfileRegion></VSISparseFile>",
                             m_poGDS->m_osTmpFilenameJPEGTable.c_str(),
                             static_cast<int>(m_poGDS->m_nJPEGTableSize),
-                            m_poGDS->m_poParentDS->GetDescription(),
+                            m_poGDS->m_poParentDS->m_pszFilename,
                             static_cast<int>(m_poGDS->m_nJPEGTableSize),
                             nOffset, nByteCount) < 0)
             {
@@ -254,6 +254,9 @@ CPLErr GTiffRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
             return eErr;
     }
 
+    if (eRWFlag == GF_Read && !m_poGDS->m_anReadPlanBlocks.empty())
+        m_poGDS->UpdateReadPlan(nXOff, nYOff, nXSize, nYSize, 1, &nBand);
+
     if (m_poGDS->m_eVirtualMemIOUsage != GTiffDataset::VirtualMemIOEnum::NO)
     {
         const int nErr = m_poGDS->VirtualMemIO(
@@ -73,6 +73,16 @@ class GTiffRasterBand CPL_NON_FINAL : public GDALPamRasterBand
                           int nBufXSize, int nBufYSize,
                           GDALRasterIOExtraArg *psExtraArg);
 
+    // State of the access pattern detector used by PrefetchBlocksIfNeeded()
+    int m_nPrefetchLastBlockX = -1;
+    int m_nPrefetchLastBlockY = -1;
+    int m_nPrefetchLastStrideX = 0;
+    int m_nPrefetchLastStrideY = 0;
+    int m_nPrefetchStrideStreak = 0;
+    int m_nPrefetchLocalStreak = 0;
+
+    void PrefetchBlocksIfNeeded(int nBlockXOff, int nBlockYOff);
+
   protected:
     GTiffDataset *m_poGDS = nullptr;
     GDALMultiDomainMetadata m_oGTiffMDMD{};
@@ -104,6 +114,7 @@ class GTiffRasterBand CPL_NON_FINAL : public GDALPamRasterBand
 
     virtual CPLErr IReadBlock(int, int, void *) override;
     virtual CPLErr IWriteBlock(int, int, void *) override;
+    virtual bool CanReadBlockIntoBuffer() const override;
 
     virtual GDALSuggestedBlockAccessPattern
     GetSuggestedBlockAccessPattern() const override
@@ -32,6 +32,7 @@
 #include "gtiffjpegoverviewds.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <limits>
 #include <map>
 #include <set>
@@ -927,6 +928,32 @@ void *GTiffRasterBand::CacheMultiRange(int nXOff, int nYOff, int nXSize,
     };
 
     thandle_t th = TIFFClientdata(m_poGDS->m_hTIFF);
+    if (m_poGDS->m_bPrefetchedRangesActive)
+    {
+        // Keep the blocks fetched by PrefetchBlocksIfNeeded() if they cover
+        // the whole request. Otherwise replace them by the request ranges.
+        bool bCovered = true;
+        for (int iY = nBlockY1; bCovered && iY <= nBlockY2; iY++)
+        {
+            for (int iX = nBlockX1; bCovered && iX <= nBlockX2; iX++)
+            {
+                vsi_l_offset nOffset = 0;
+                vsi_l_offset nSize = 0;
+                if (m_poGDS->IsBlockAvailable(ComputeBlockId(iX, iY), &nOffset,
+                                              &nSize) &&
+                    nSize > 0 &&
+                    VSI_TIFFGetCachedRange(th, nOffset,
+                                           static_cast<size_t>(nSize)) ==
+                        nullptr)
+                {
+                    bCovered = false;
+                }
+            }
+        }
+        if (bCovered)
+            return nullptr;
+        m_poGDS->ReleasePrefetchedBlocks();
+    }
     if (!VSI_TIFFHasCachedRanges(th))
     {
         std::vector<std::pair<vsi_l_offset, size_t>> aOffsetSize;
@@ -1078,6 +1105,248 @@ void *GTiffRasterBand::CacheMultiRange(int nXOff, int nYOff, int nXSize,
     return pBufferedData;
 }
 
+/************************************************************************/
+/*                       PrefetchBlocksIfNeeded()                       */
+/************************************************************************/
+
+// Called by IReadBlock() before a strip/tile is read. If the recent accesses
+// to the band follow a constant stride between adjacent blocks (typically
+// row-major or column-major scanning), or stay in the neighbourhood of each
+// other, fetch the next blocks in that direction (or the ones surrounding the
+// current block) together with the current one, with a single
+// VSIFReadMultiRangeL() call, and register them as cached ranges of the TIFF
+// handle, so that their subsequent reads by libtiff do not issue network
+// requests.
+void GTiffRasterBand::PrefetchBlocksIfNeeded(int nBlockXOff, int nBlockYOff)
+{
+    if (m_poGDS->eAccess != GA_ReadOnly || m_poGDS->m_bStreamingIn ||
+        !m_poGDS->HasOptimizedReadMultiRange())
+    {
+        return;
+    }
+
+    if (m_poGDS->m_nPrefetchMaxBlocks < 0)
+    {
+        m_poGDS->m_nPrefetchMaxBlocks = std::max(
+            0, atoi(CPLGetConfigOption("GTIFF_PREFETCH_BLOCKS", "8")));
+        m_poGDS->m_nPrefetchMaxBytes = static_cast<size_t>(std::max<GIntBig>(
+            0, CPLAtoGIntBig(
+                   CPLGetConfigOption("GTIFF_PREFETCH_MAX_BYTES", "4194304"))));
+    }
+    if (m_poGDS->m_nPrefetchMaxBlocks == 0)
+        return;
+
+    thandle_t th = TIFFClientdata(m_poGDS->m_hTIFF);
+    // Ranges set by CacheMultiRange() for the RasterIO() request being
+    // processed
+    if (VSI_TIFFHasCachedRanges(th) && !m_poGDS->m_bPrefetchedRangesActive)
+        return;
+
+    const auto GetBlockRange =
+        [this](int iX, int iY, vsi_l_offset &nOffset, vsi_l_offset &nSize)
+    {
+        nOffset = 0;
+        nSize = 0;
+        return m_poGDS->IsBlockAvailable(ComputeBlockId(iX, iY), &nOffset,
+                                         &nSize) &&
+               nSize > 0 && nSize <= std::numeric_limits<size_t>::max();
+    };
+
+    vsi_l_offset nOffset = 0;
+    vsi_l_offset nSize = 0;
+    if (!GetBlockRange(nBlockXOff, nBlockYOff, nOffset, nSize))
+        return;
+    const bool bAlreadyFetched =
+        m_poGDS->m_bPrefetchedRangesActive &&
+        VSI_TIFFGetCachedRange(th, nOffset, static_cast<size_t>(nSize)) !=
+            nullptr;
+    if (bAlreadyFetched)
+        ++m_poGDS->m_nPrefetchHitCount;
+
+    /* -------------------------------------------------------------------- */
+    /*      Update the access pattern detector.                             */
+    /* -------------------------------------------------------------------- */
+    int nStrideX = nBlockXOff - m_nPrefetchLastBlockX;
+    int nStrideY = nBlockYOff - m_nPrefetchLastBlockY;
+    // Going from the end of a row to the start of the next one is a
+    // continuation of a row-major scan.
+    const bool bRowMajorWrap = m_nPrefetchLastBlockX == nBlocksPerRow - 1 &&
+                               nBlockXOff == 0 && nStrideY == 1;
+    if (bRowMajorWrap)
+    {
+        nStrideX = 1;
+        nStrideY = 0;
+    }
+    const bool bLocal = m_nPrefetchLastBlockX >= 0 && std::abs(nStrideX) <= 1 &&
+                        std::abs(nStrideY) <= 1 &&
+                        (nStrideX != 0 || nStrideY != 0);
+    if (bLocal)
+    {
+        ++m_nPrefetchLocalStreak;
+        if (nStrideX == m_nPrefetchLastStrideX &&
+            nStrideY == m_nPrefetchLastStrideY)
+            ++m_nPrefetchStrideStreak;
+        else
+            m_nPrefetchStrideStreak = 1;
+    }
+    else if (nStrideX != 0 || nStrideY != 0)
+    {
+        m_nPrefetchLocalStreak = 0;
+        m_nPrefetchStrideStreak = 0;
+    }
+    m_nPrefetchLastBlockX = nBlockXOff;
+    m_nPrefetchLastBlockY = nBlockYOff;
+    m_nPrefetchLastStrideX = nStrideX;
+    m_nPrefetchLastStrideY = nStrideY;
+
+    constexpr int MIN_STRIDE_STREAK = 2;
+    constexpr int MIN_LOCAL_STREAK = 3;
+    if (bAlreadyFetched || (m_nPrefetchStrideStreak < MIN_STRIDE_STREAK &&
+                            m_nPrefetchLocalStreak < MIN_LOCAL_STREAK))
+    {
+        return;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Collect the blocks to fetch, starting with the current one.     */
+    /* -------------------------------------------------------------------- */
+    const int nMaxBlocks = m_poGDS->m_nPrefetchMaxBlocks;
+    std::vector<std::pair<int, int>> aoCandidates;
+    aoCandidates.emplace_back(nBlockXOff, nBlockYOff);
+    if (m_nPrefetchStrideStreak >= MIN_STRIDE_STREAK)
+    {
+        if (nStrideX == 1 && nStrideY == 0)
+        {
+            // Row-major order, continuing on next rows
+            const GIntBig nBlockCount =
+                static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
+            GIntBig nIdx =
+                nBlockXOff + static_cast<GIntBig>(nBlockYOff) * nBlocksPerRow;
+            for (int i = 0; i < nMaxBlocks && ++nIdx < nBlockCount; ++i)
+            {
+                aoCandidates.emplace_back(
+                    static_cast<int>(nIdx % nBlocksPerRow),
+                    static_cast<int>(nIdx / nBlocksPerRow));
+            }
+        }
+        else
+        {
+            int iX = nBlockXOff;
+            int iY = nBlockYOff;
+            for (int i = 0; i < nMaxBlocks; ++i)
+            {
+                iX += nStrideX;
+                iY += nStrideY;
+                if (iX < 0 || iX >= nBlocksPerRow || iY < 0 ||
+                    iY >= nBlocksPerColumn)
+                    break;
+                aoCandidates.emplace_back(iX, iY);
+            }
+        }
+    }
+    else
+    {
+        // Neighbourhood of the current block
+        for (int iY = std::max(0, nBlockYOff - 1);
+             iY <= std::min(nBlocksPerColumn - 1, nBlockYOff + 1); ++iY)
+        {
+            for (int iX = std::max(0, nBlockXOff - 1);
+                 iX <= std::min(nBlocksPerRow - 1, nBlockXOff + 1); ++iX)
+            {
+                if ((iX != nBlockXOff || iY != nBlockYOff) &&
+                    static_cast<int>(aoCandidates.size()) <= nMaxBlocks)
+                {
+                    aoCandidates.emplace_back(iX, iY);
+                }
+            }
+        }
+    }
+
+    std::vector<std::pair<vsi_l_offset, size_t>> aOffsetSize;
+    size_t nTotalSize = 0;
+    for (const auto &oCandidate : aoCandidates)
+    {
+        const int iX = oCandidate.first;
+        const int iY = oCandidate.second;
+        if (iX != nBlockXOff || iY != nBlockYOff)
+        {
+            GDALRasterBlock *poBlock = TryGetLockedBlockRef(iX, iY);
+            if (poBlock != nullptr)
+            {
+                poBlock->DropLock();
+                continue;
+            }
+            if (!GetBlockRange(iX, iY, nOffset, nSize))
+                continue;
+        }
+        if (nSize > m_poGDS->m_nPrefetchMaxBytes - nTotalSize)
+            break;
+        aOffsetSize.emplace_back(nOffset, static_cast<size_t>(nSize));
+        nTotalSize += static_cast<size_t>(nSize);
+    }
+    // Nothing to prefetch besides the current block
+    if (aOffsetSize.size() < 2)
+        return;
+    const int nPrefetchedBlocks = static_cast<int>(aOffsetSize.size()) - 1;
+
+    /* -------------------------------------------------------------------- */
+    /*      Merge contiguous or overlapping ranges and fetch them.          */
+    /* -------------------------------------------------------------------- */
+    std::sort(aOffsetSize.begin(), aOffsetSize.end());
+    std::vector<vsi_l_offset> anOffsets;
+    std::vector<size_t> anSizes;
+    for (const auto &oOffsetSize : aOffsetSize)
+    {
+        if (!anOffsets.empty() &&
+            oOffsetSize.first <= anOffsets.back() + anSizes.back())
+        {
+            const vsi_l_offset nEnd =
+                std::max(anOffsets.back() + anSizes.back(),
+                         oOffsetSize.first + oOffsetSize.second);
+            anSizes.back() = static_cast<size_t>(nEnd - anOffsets.back());
+        }
+        else
+        {
+            anOffsets.push_back(oOffsetSize.first);
+            anSizes.push_back(oOffsetSize.second);
+        }
+    }
+
+    m_poGDS->ReleasePrefetchedBlocks();
+    size_t nBufferSize = 0;
+    for (const size_t nRangeSize : anSizes)
+        nBufferSize += nRangeSize;
+    try
+    {
+        m_poGDS->m_abyPrefetchBuffer.resize(nBufferSize);
+    }
+    catch (const std::exception &)
+    {
+        return;
+    }
+    std::vector<void *> apData;
+    size_t nAccOffset = 0;
+    for (const size_t nRangeSize : anSizes)
+    {
+        apData.push_back(m_poGDS->m_abyPrefetchBuffer.data() + nAccOffset);
+        nAccOffset += nRangeSize;
+    }
+
+    if (VSIFReadMultiRangeL(static_cast<int>(anSizes.size()), apData.data(),
+                            anOffsets.data(), anSizes.data(),
+                            VSI_TIFFGetVSILFile(th)) != 0)
+    {
+        m_poGDS->ReleasePrefetchedBlocks();
+        return;
+    }
+
+    VSI_TIFFSetCachedRanges(th, static_cast<int>(anSizes.size()),
+                            apData.data(), anOffsets.data(), anSizes.data());
+    m_poGDS->m_bPrefetchedRangesActive = true;
+    ++m_poGDS->m_nPrefetchRequestCount;
+    m_poGDS->m_nPrefetchedBlockCount += nPrefetchedBlocks;
+}
+
 /************************************************************************/
 /*                       IGetDataCoverageStatus()                       */
 /************************************************************************/
@@ -1242,6 +1511,9 @@ CPLErr GTiffRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff, void *pImage)
         }
     }
 
+    if (nBlockId != m_poGDS->m_nLoadedBlock)
+        PrefetchBlocksIfNeeded(nBlockXOff, nBlockYOff);
+
     /* -------------------------------------------------------------------- */
     /*      Handle simple case (separate, onesampleperpixel)                */
     /* -------------------------------------------------------------------- */
@@ -1344,6 +1616,21 @@ CPLErr GTiffRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff, void *pImage)
     return eErr;
 }
 
+/************************************************************************/
+/*                       CanReadBlockIntoBuffer()                       */
+/************************************************************************/
+
+bool GTiffRasterBand::CanReadBlockIntoBuffer() const
+{
+    // With pixel interleaving, IReadBlock() goes through m_pabyBlockBuf and
+    // fills the block cache of the other bands, so there is not much to gain.
+    // Derived classes have their own decoding logic.
+    return IsBaseGTiffClass() &&
+           (m_poGDS->nBands == 1 ||
+            m_poGDS->m_nPlanarConfig == PLANARCONFIG_SEPARATE) &&
+           m_poGDS->m_nBitsPerSample == GDALGetDataTypeSizeBits(eDataType);
+}
+
 /************************************************************************/
 /*                           CacheMaskForBlock()                       */
 /************************************************************************/
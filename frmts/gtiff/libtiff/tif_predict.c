@@ -338,6 +338,291 @@ static int PredictorSetupEncode(TIFF *tif)
 /* - when storing into the byte stream, we explicitly mask with 0xff so */
 /*   as to make icc -check=conversions happy (not necessary by the standard) */
 
+/*
+ * SSE2 implementations of the horizontal accumulation/differencing of
+ * samples, and of the byte (de)interleaving of the floating point
+ * predictor. SSE2 is always available on x86_64, so no runtime detection
+ * is needed.
+ * Note: this is a GDAL-local addition, not (yet) present in upstream libtiff.
+ */
+#if defined(__x86_64__) || defined(_M_X64)
+#define PREDICTOR_USE_SSE2
+#include <emmintrin.h>
+
+static inline __m128i predAdd(__m128i a, __m128i b, int sampleSize)
+{
+    switch (sampleSize)
+    {
+        case 1:
+            return _mm_add_epi8(a, b);
+        case 2:
+            return _mm_add_epi16(a, b);
+        case 4:
+            return _mm_add_epi32(a, b);
+        default:
+            return _mm_add_epi64(a, b);
+    }
+}
+
+static inline __m128i predSub(__m128i a, __m128i b, int sampleSize)
+{
+    switch (sampleSize)
+    {
+        case 1:
+            return _mm_sub_epi8(a, b);
+        case 2:
+            return _mm_sub_epi16(a, b);
+        case 4:
+            return _mm_sub_epi32(a, b);
+        default:
+            return _mm_sub_epi64(a, b);
+    }
+}
+
+/* Prefix sum, within a vector, of the samples distant of strideBytes */
+static inline __m128i predPrefixSum(__m128i v, tmsize_t strideBytes,
+                                    int sampleSize)
+{
+    switch (strideBytes)
+    {
+        case 1:
+            v = predAdd(v, _mm_slli_si128(v, 1), sampleSize);
+            v = predAdd(v, _mm_slli_si128(v, 2), sampleSize);
+            v = predAdd(v, _mm_slli_si128(v, 4), sampleSize);
+            v = predAdd(v, _mm_slli_si128(v, 8), sampleSize);
+            break;
+        case 2:
+            v = predAdd(v, _mm_slli_si128(v, 2), sampleSize);
+            v = predAdd(v, _mm_slli_si128(v, 4), sampleSize);
+            v = predAdd(v, _mm_slli_si128(v, 8), sampleSize);
+            break;
+        case 4:
+            v = predAdd(v, _mm_slli_si128(v, 4), sampleSize);
+            v = predAdd(v, _mm_slli_si128(v, 8), sampleSize);
+            break;
+        default:
+            v = predAdd(v, _mm_slli_si128(v, 8), sampleSize);
+            break;
+    }
+    return v;
+}
+
+/* Broadcast the last strideBytes bytes of a vector */
+static inline __m128i predBroadcastLast(__m128i v, tmsize_t strideBytes)
+{
+    switch (strideBytes)
+    {
+        case 1:
+            v = _mm_unpackhi_epi8(v, v);
+            v = _mm_shufflehi_epi16(v, 0xFF);
+            return _mm_shuffle_epi32(v, 0xFF);
+        case 2:
+            v = _mm_shufflehi_epi16(v, 0xFF);
+            return _mm_shuffle_epi32(v, 0xFF);
+        case 4:
+            return _mm_shuffle_epi32(v, 0xFF);
+        default:
+            return _mm_shuffle_epi32(v, 0xEE);
+    }
+}
+
+/*
+ * Accumulate, with (unsigned) wrap over, each sample of cp with the one
+ * strideBytes before it, for the strides that can be processed with
+ * vectors. Returns the number of bytes processed, that is a multiple of
+ * sampleSize, the remaining ones being left to the caller.
+ */
+TIFF_NOSANITIZE_UNSIGNED_INT_OVERFLOW
+static tmsize_t horAccSSE2(uint8_t *cp, tmsize_t cc, tmsize_t strideBytes,
+                           int sampleSize)
+{
+    tmsize_t i = 0;
+    if (strideBytes >= 16)
+    {
+        /* The samples added to a vector are all before it */
+        for (i = strideBytes; i + 16 <= cc; i += 16)
+        {
+            const __m128i v = _mm_loadu_si128((const __m128i *)(cp + i));
+            const __m128i prev =
+                _mm_loadu_si128((const __m128i *)(cp + i - strideBytes));
+            _mm_storeu_si128((__m128i *)(cp + i),
+                             predAdd(v, prev, sampleSize));
+        }
+    }
+    else if (strideBytes == 1 || strideBytes == 2 || strideBytes == 4 ||
+             strideBytes == 8)
+    {
+        __m128i carry = _mm_setzero_si128();
+        for (; i + 16 <= cc; i += 16)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i *)(cp + i));
+            v = predAdd(predPrefixSum(v, strideBytes, sampleSize), carry,
+                        sampleSize);
+            _mm_storeu_si128((__m128i *)(cp + i), v);
+            carry = predBroadcastLast(v, strideBytes);
+        }
+    }
+    return i;
+}
+
+/*
+ * Difference each sample of cp, from the end, with the one strideBytes
+ * before it. Returns the offset of the first byte processed, the ones
+ * before it, starting at strideBytes, being left to the caller.
+ */
+TIFF_NOSANITIZE_UNSIGNED_INT_OVERFLOW
+static tmsize_t horDiffSSE2(uint8_t *cp, tmsize_t cc, tmsize_t strideBytes,
+                            int sampleSize)
+{
+    /* Working backwards, the samples subtracted from a vector are not */
+    /* modified yet. */
+    tmsize_t i = cc;
+    while (i - 16 >= strideBytes)
+    {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(cp + i - 16));
+        const __m128i prev =
+            _mm_loadu_si128((const __m128i *)(cp + i - 16 - strideBytes));
+        i -= 16;
+        _mm_storeu_si128((__m128i *)(cp + i), predSub(v, prev, sampleSize));
+    }
+    return i;
+}
+
+/*
+ * Interleave the bytes of 16 samples from their planes (most significant
+ * byte first) into out. Returns 0 if bps is not handled.
+ */
+static inline int fpInterleaveSSE2(uint8_t *out, const uint8_t *planes,
+                                   tmsize_t wc, uint32_t bps)
+{
+#define LOAD_PLANE(k)                                                          \
+    _mm_loadu_si128((const __m128i *)(planes + (tmsize_t)(k)*wc))
+    if (bps == 2)
+    {
+        const __m128i b0 = LOAD_PLANE(1);
+        const __m128i b1 = LOAD_PLANE(0);
+        _mm_storeu_si128((__m128i *)out, _mm_unpacklo_epi8(b0, b1));
+        _mm_storeu_si128((__m128i *)(out + 16), _mm_unpackhi_epi8(b0, b1));
+        return 1;
+    }
+    if (bps == 4)
+    {
+        const __m128i b0 = LOAD_PLANE(3);
+        const __m128i b1 = LOAD_PLANE(2);
+        const __m128i b2 = LOAD_PLANE(1);
+        const __m128i b3 = LOAD_PLANE(0);
+        const __m128i e0 = _mm_unpacklo_epi8(b0, b2);
+        const __m128i e1 = _mm_unpackhi_epi8(b0, b2);
+        const __m128i o0 = _mm_unpacklo_epi8(b1, b3);
+        const __m128i o1 = _mm_unpackhi_epi8(b1, b3);
+        _mm_storeu_si128((__m128i *)out, _mm_unpacklo_epi8(e0, o0));
+        _mm_storeu_si128((__m128i *)(out + 16), _mm_unpackhi_epi8(e0, o0));
+        _mm_storeu_si128((__m128i *)(out + 32), _mm_unpacklo_epi8(e1, o1));
+        _mm_storeu_si128((__m128i *)(out + 48), _mm_unpackhi_epi8(e1, o1));
+        return 1;
+    }
+    if (bps == 8)
+    {
+        __m128i b[8];
+        __m128i e[4], o[4];
+        __m128i ee[2], eo[2], oe[2], oo[2];
+        int k;
+        for (k = 0; k < 8; k++)
+            b[k] = LOAD_PLANE(7 - k);
+        /* Reverse of the even/odd splitting done by fpDeinterleaveSSE2() */
+        ee[0] = _mm_unpacklo_epi8(b[0], b[4]);
+        ee[1] = _mm_unpackhi_epi8(b[0], b[4]);
+        eo[0] = _mm_unpacklo_epi8(b[2], b[6]);
+        eo[1] = _mm_unpackhi_epi8(b[2], b[6]);
+        oe[0] = _mm_unpacklo_epi8(b[1], b[5]);
+        oe[1] = _mm_unpackhi_epi8(b[1], b[5]);
+        oo[0] = _mm_unpacklo_epi8(b[3], b[7]);
+        oo[1] = _mm_unpackhi_epi8(b[3], b[7]);
+        for (k = 0; k < 2; k++)
+        {
+            e[2 * k] = _mm_unpacklo_epi8(ee[k], eo[k]);
+            e[2 * k + 1] = _mm_unpackhi_epi8(ee[k], eo[k]);
+            o[2 * k] = _mm_unpacklo_epi8(oe[k], oo[k]);
+            o[2 * k + 1] = _mm_unpackhi_epi8(oe[k], oo[k]);
+        }
+        for (k = 0; k < 4; k++)
+        {
+            _mm_storeu_si128((__m128i *)(out + 32 * k),
+                             _mm_unpacklo_epi8(e[k], o[k]));
+            _mm_storeu_si128((__m128i *)(out + 32 * k + 16),
+                             _mm_unpackhi_epi8(e[k], o[k]));
+        }
+        return 1;
+    }
+#undef LOAD_PLANE
+    return 0;
+}
+
+/* Split the even and odd bytes of 2 * n vectors into n vectors each */
+static inline void fpSplitEvenOddSSE2(const __m128i *in, int n,
+                                      __m128i *even, __m128i *odd)
+{
+    const __m128i mask = _mm_set1_epi16(0xFF);
+    int k;
+    for (k = 0; k < n; k++)
+    {
+        even[k] = _mm_packus_epi16(_mm_and_si128(in[2 * k], mask),
+                                   _mm_and_si128(in[2 * k + 1], mask));
+        odd[k] = _mm_packus_epi16(_mm_srli_epi16(in[2 * k], 8),
+                                  _mm_srli_epi16(in[2 * k + 1], 8));
+    }
+}
+
+/*
+ * Deinterleave the bytes of 16 samples of in into their planes (most
+ * significant byte first). Returns 0 if bps is not handled.
+ */
+static inline int fpDeinterleaveSSE2(uint8_t *planes, const uint8_t *in,
+                                     tmsize_t wc, uint32_t bps)
+{
+#define STORE_PLANE(k, v)                                                      \
+    _mm_storeu_si128((__m128i *)(planes + (tmsize_t)(k)*wc), v)
+    __m128i v[8];
+    __m128i e[4], o[4];
+    uint32_t k;
+    if (bps != 2 && bps != 4 && bps != 8)
+        return 0;
+    for (k = 0; k < bps; k++)
+        v[k] = _mm_loadu_si128((const __m128i *)(in + 16 * k));
+    fpSplitEvenOddSSE2(v, (int)bps / 2, e, o);
+    if (bps == 2)
+    {
+        STORE_PLANE(1, e[0]);
+        STORE_PLANE(0, o[0]);
+    }
+    else if (bps == 4)
+    {
+        __m128i ee, eo, oe, oo;
+        fpSplitEvenOddSSE2(e, 1, &ee, &eo);
+        fpSplitEvenOddSSE2(o, 1, &oe, &oo);
+        STORE_PLANE(3, ee);
+        STORE_PLANE(2, oe);
+        STORE_PLANE(1, eo);
+        STORE_PLANE(0, oo);
+    }
+    else
+    {
+        __m128i ee[2], eo[2], oe[2], oo[2];
+        __m128i b[8];
+        fpSplitEvenOddSSE2(e, 2, ee, eo);
+        fpSplitEvenOddSSE2(o, 2, oe, oo);
+        fpSplitEvenOddSSE2(ee, 1, &b[0], &b[4]);
+        fpSplitEvenOddSSE2(eo, 1, &b[2], &b[6]);
+        fpSplitEvenOddSSE2(oe, 1, &b[1], &b[5]);
+        fpSplitEvenOddSSE2(oo, 1, &b[3], &b[7]);
+        for (k = 0; k < 8; k++)
+            STORE_PLANE(7 - k, b[k]);
+    }
+#undef STORE_PLANE
+    return 1;
+}
+#endif
+
 TIFF_NOSANITIZE_UNSIGNED_INT_OVERFLOW
 static int horAcc8(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 {
@@ -352,6 +637,18 @@ static int horAcc8(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 
     if (cc > stride)
     {
+#ifdef PREDICTOR_USE_SSE2
+        tmsize_t iSSE2 = horAccSSE2(cp, cc, stride, 1);
+        if (iSSE2 > 0)
+        {
+            if (iSSE2 < stride)
+                iSSE2 = stride;
+            for (; iSSE2 < cc; iSSE2++)
+                cp[iSSE2] =
+                    (unsigned char)((cp[iSSE2] + cp[iSSE2 - stride]) & 0xff);
+            return 1;
+        }
+#endif
         /*
          * Pipeline the most common cases.
          */
@@ -420,6 +717,23 @@ static int horAcc16(TIFF *tif, uint8_t *cp0, tmsize_t cc)
         return 0;
     }
 
+#ifdef PREDICTOR_USE_SSE2
+    if (wc > stride)
+    {
+        tmsize_t i = horAccSSE2(cp0, cc, 2 * stride, 2) / 2;
+        if (i > 0)
+        {
+            if (i < stride)
+                i = stride;
+            for (; i < wc; i++)
+                wp[i] = (uint16_t)(((unsigned int)wp[i] +
+                                    (unsigned int)wp[i - stride]) &
+                                   0xffff);
+            return 1;
+        }
+    }
+#endif
+
     if (wc > stride)
     {
         wc -= stride;
@@ -457,6 +771,21 @@ static int horAcc32(TIFF *tif, uint8_t *cp0, tmsize_t cc)
         return 0;
     }
 
+#ifdef PREDICTOR_USE_SSE2
+    if (wc > stride)
+    {
+        tmsize_t i = horAccSSE2(cp0, cc, 4 * stride, 4) / 4;
+        if (i > 0)
+        {
+            if (i < stride)
+                i = stride;
+            for (; i < wc; i++)
+                wp[i] += wp[i - stride];
+            return 1;
+        }
+    }
+#endif
+
     if (wc > stride)
     {
         wc -= stride;
@@ -491,6 +820,21 @@ static int horAcc64(TIFF *tif, uint8_t *cp0, tmsize_t cc)
         return 0;
     }
 
+#ifdef PREDICTOR_USE_SSE2
+    if (wc > stride)
+    {
+        tmsize_t i = horAccSSE2(cp0, cc, 8 * stride, 8) / 8;
+        if (i > 0)
+        {
+            if (i < stride)
+                i = stride;
+            for (; i < wc; i++)
+                wp[i] += wp[i - stride];
+            return 1;
+        }
+    }
+#endif
+
     if (wc > stride)
     {
         wc -= stride;
@@ -525,6 +869,21 @@ static int fpAcc(TIFF *tif, uint8_t *cp0, tmsize_t cc)
     if (!tmp)
         return 0;
 
+#ifdef PREDICTOR_USE_SSE2
+    if (count > stride)
+    {
+        tmsize_t i = horAccSSE2(cp, cc, stride, 1);
+        if (i > 0)
+        {
+            if (i < stride)
+                i = stride;
+            for (; i < cc; i++)
+                cp[i] = (unsigned char)((cp[i] + cp[i - stride]) & 0xff);
+            count = stride;
+        }
+    }
+#endif
+
     while (count > stride)
     {
         REPEAT4(stride,
@@ -535,7 +894,15 @@ static int fpAcc(TIFF *tif, uint8_t *cp0, tmsize_t cc)
 
     _TIFFmemcpy(tmp, cp0, cc);
     cp = (uint8_t *)cp0;
-    for (count = 0; count < wc; count++)
+    count = 0;
+#ifdef PREDICTOR_USE_SSE2
+    while (count + 16 <= wc &&
+           fpInterleaveSSE2(cp + bps * count, tmp + count, wc, bps))
+    {
+        count += 16;
+    }
+#endif
+    for (; count < wc; count++)
     {
         uint32_t byte;
         for (byte = 0; byte < bps; byte++)
@@ -623,6 +990,22 @@ static int horDiff8(TIFF *tif, uint8_t *cp0, tmsize_t cc)
         return 0;
     }
 
+#ifdef PREDICTOR_USE_SSE2
+    if (cc > stride)
+    {
+        tmsize_t i = horDiffSSE2(cp, cc, stride, 1);
+        if (i < cc)
+        {
+            while (i > stride)
+            {
+                i--;
+                cp[i] = (unsigned char)((cp[i] - cp[i - stride]) & 0xff);
+            }
+            return 1;
+        }
+    }
+#endif
+
     if (cc > stride)
     {
         cc -= stride;
@@ -702,6 +1085,24 @@ static int horDiff16(TIFF *tif, uint8_t *cp0, tmsize_t cc)
         return 0;
     }
 
+#ifdef PREDICTOR_USE_SSE2
+    if (wc > stride)
+    {
+        tmsize_t i = horDiffSSE2(cp0, cc, 2 * stride, 2) / 2;
+        if (i < wc)
+        {
+            while (i > stride)
+            {
+                i--;
+                wp[i] = (uint16_t)(((unsigned int)wp[i] -
+                                    (unsigned int)wp[i - stride]) &
+                                   0xffff);
+            }
+            return 1;
+        }
+    }
+#endif
+
     if (wc > stride)
     {
         wc -= stride;
@@ -744,6 +1145,22 @@ static int horDiff32(TIFF *tif, uint8_t *cp0, tmsize_t cc)
         return 0;
     }
 
+#ifdef PREDICTOR_USE_SSE2
+    if (wc > stride)
+    {
+        tmsize_t i = horDiffSSE2(cp0, cc, 4 * stride, 4) / 4;
+        if (i < wc)
+        {
+            while (i > stride)
+            {
+                i--;
+                wp[i] -= wp[i - stride];
+            }
+            return 1;
+        }
+    }
+#endif
+
     if (wc > stride)
     {
         wc -= stride;
@@ -783,6 +1200,22 @@ static int horDiff64(TIFF *tif, uint8_t *cp0, tmsize_t cc)
         return 0;
     }
 
+#ifdef PREDICTOR_USE_SSE2
+    if (wc > stride)
+    {
+        tmsize_t i = horDiffSSE2(cp0, cc, 8 * stride, 8) / 8;
+        if (i < wc)
+        {
+            while (i > stride)
+            {
+                i--;
+                wp[i] -= wp[i - stride];
+            }
+            return 1;
+        }
+    }
+#endif
+
     if (wc > stride)
     {
         wc -= stride;
@@ -832,7 +1265,15 @@ static int fpDiff(TIFF *tif, uint8_t *cp0, tmsize_t cc)
         return 0;
 
     _TIFFmemcpy(tmp, cp0, cc);
-    for (count = 0; count < wc; count++)
+    count = 0;
+#ifdef PREDICTOR_USE_SSE2
+    while (count + 16 <= wc &&
+           fpDeinterleaveSSE2(cp + count, tmp + bps * count, wc, bps))
+    {
+        count += 16;
+    }
+#endif
+    for (; count < wc; count++)
     {
         uint32_t byte;
         for (byte = 0; byte < bps; byte++)
@@ -847,6 +1288,21 @@ static int fpDiff(TIFF *tif, uint8_t *cp0, tmsize_t cc)
     _TIFFfreeExt(tif, tmp);
 
     cp = (uint8_t *)cp0;
+#ifdef PREDICTOR_USE_SSE2
+    if (cc > stride)
+    {
+        tmsize_t i = horDiffSSE2(cp, cc, stride, 1);
+        if (i < cc)
+        {
+            while (i > stride)
+            {
+                i--;
+                cp[i] = (unsigned char)((cp[i] - cp[i - stride]) & 0xff);
+            }
+            return 1;
+        }
+    }
+#endif
     cp += cc - stride - 1;
     for (count = cc; count > stride; count -= stride)
         REPEAT4(stride,
@@ -27,6 +27,13 @@
 
 #include <jxl/decode.h>
 #include <jxl/encode.h>
+#ifdef HAVE_JXL_THREADS
+#include <jxl/resizable_parallel_runner.h>
+#endif
+
+#ifdef HAVE_JxlEncoderReset
+#include "cpl_multiproc.h"
+#endif
 
 #include <stdint.h>
 
@@ -57,6 +64,12 @@ typedef struct
 
     JxlDecoder *decoder;
 
+    uint32_t num_threads; /* max threads used to encode a strip. default: 1 */
+    JxlEncoder *encoder;  /* reused from one strip to the next, or NULL */
+#ifdef HAVE_JXL_THREADS
+    void *runner; /* parallel runner attached to encoder, or NULL */
+#endif
+
     TIFFVGetMethod vgetparent; /* super-class method */
     TIFFVSetMethod vsetparent; /* super-class method */
 } JXLState;
@@ -756,6 +769,125 @@ static int JXLEncode(TIFF *tif, uint8_t *bp, tmsize_t cc, uint16_t s)
     return 1;
 }
 
+#ifdef HAVE_JxlEncoderReset
+/*
+ * Encoder without parallel runner kept by each thread once the TIFF handle
+ * that used it is closed, so that the short-lived handles that GDAL creates
+ * to compress tiles in worker threads do not each create their own encoder.
+ */
+static void JXLFreeThreadEncoder(void *pData)
+{
+    JxlEncoderDestroy((JxlEncoder *)pData);
+}
+#endif
+
+/*
+ * Return an encoder ready to encode a new strip, creating it if needed.
+ */
+static JxlEncoder *JXLAcquireEncoder(TIFF *tif, JXLState *sp)
+{
+    static const char module[] = "JXLAcquireEncoder";
+
+#ifdef HAVE_JxlEncoderReset
+    if (sp->encoder != NULL)
+    {
+        JxlEncoderReset(sp->encoder);
+        return sp->encoder;
+    }
+#ifdef HAVE_JXL_THREADS
+    if (sp->num_threads <= 1)
+#endif
+    {
+        int bMemoryErrorOccurred = FALSE;
+        sp->encoder = (JxlEncoder *)CPLGetTLSEx(CTLS_JXLENCODER,
+                                                &bMemoryErrorOccurred);
+        if (sp->encoder != NULL)
+        {
+            CPLSetTLS(CTLS_JXLENCODER, NULL, FALSE);
+            JxlEncoderReset(sp->encoder);
+            return sp->encoder;
+        }
+    }
+#endif
+
+    sp->encoder = JxlEncoderCreate(NULL);
+    if (sp->encoder == NULL)
+    {
+        TIFFErrorExtR(tif, module, "JxlEncoderCreate() failed");
+        return NULL;
+    }
+
+#ifdef HAVE_JXL_THREADS
+    if (sp->num_threads > 1)
+    {
+        if (sp->runner == NULL)
+        {
+            sp->runner = JxlResizableParallelRunnerCreate(NULL);
+            if (sp->runner == NULL)
+            {
+                TIFFErrorExtR(tif, module,
+                              "JxlResizableParallelRunnerCreate() failed");
+                JxlEncoderDestroy(sp->encoder);
+                sp->encoder = NULL;
+                return NULL;
+            }
+        }
+        if (JxlEncoderSetParallelRunner(sp->encoder,
+                                        JxlResizableParallelRunner,
+                                        sp->runner) != JXL_ENC_SUCCESS)
+        {
+            TIFFErrorExtR(tif, module, "JxlEncoderSetParallelRunner() failed");
+            JxlEncoderDestroy(sp->encoder);
+            sp->encoder = NULL;
+            return NULL;
+        }
+    }
+#endif
+
+    return sp->encoder;
+}
+
+/*
+ * Release the encoder after a strip has been encoded, or failed to be.
+ */
+static void JXLReleaseEncoder(JXLState *sp)
+{
+#ifndef HAVE_JxlEncoderReset
+    /* Without JxlEncoderReset(), an encoder can only be used once */
+    JxlEncoderDestroy(sp->encoder);
+    sp->encoder = NULL;
+#else
+    (void)sp;
+#endif
+}
+
+/*
+ * Destroy the encoder, or hand it over to the current thread.
+ */
+static void JXLDestroyEncoder(JXLState *sp)
+{
+    if (sp->encoder == NULL)
+        return;
+#ifdef HAVE_JxlEncoderReset
+#ifdef HAVE_JXL_THREADS
+    if (sp->num_threads <= 1)
+#endif
+    {
+        int bMemoryErrorOccurred = FALSE;
+        if (CPLGetTLSEx(CTLS_JXLENCODER, &bMemoryErrorOccurred) == NULL &&
+            !bMemoryErrorOccurred)
+        {
+            CPLSetTLSWithFreeFunc(CTLS_JXLENCODER, sp->encoder,
+                                  JXLFreeThreadEncoder);
+            sp->encoder = NULL;
+            return;
+        }
+    }
+#endif
+    JxlEncoderDestroy(sp->encoder);
+    sp->encoder = NULL;
+}
+
 /*
  * Finish off an encoded strip by flushing it.
  */
@@ -771,14 +903,23 @@ static int JXLPostEncode(TIFF *tif)
         return 0;
     }
 
-    JxlEncoder *enc = JxlEncoderCreate(NULL);
+    JxlEncoder *enc = JXLAcquireEncoder(tif, sp);
     if (enc == NULL)
-    {
-        TIFFErrorExtR(tif, module, "JxlEncoderCreate() failed");
         return 0;
-    }
     JxlEncoderUseContainer(enc, JXL_FALSE);
 
+#ifdef HAVE_JXL_THREADS
+    if (sp->num_threads > 1)
+    {
+        /* Only large strips are worth being split among several threads */
+        size_t nThreads = JxlResizableParallelRunnerSuggestThreads(
+            sp->segment_width, sp->segment_height);
+        if (nThreads > sp->num_threads)
+            nThreads = sp->num_threads;
+        JxlResizableParallelRunnerSetThreads(sp->runner, nThreads);
+    }
+#endif
+
 #ifdef HAVE_JxlEncoderFrameSettingsCreate
     JxlEncoderFrameSettings *opts = JxlEncoderFrameSettingsCreate(enc, NULL);
 #else
@@ -787,7 +928,7 @@ static int JXLPostEncode(TIFF *tif)
     if (opts == NULL)
     {
         TIFFErrorExtR(tif, module, "JxlEncoderFrameSettingsCreate() failed");
-        JxlEncoderDestroy(enc);
+        JXLReleaseEncoder(sp);
         return 0;
     }
 
@@ -928,7 +1069,7 @@ static int JXLPostEncode(TIFF *tif)
 #endif
         {
             TIFFErrorExtR(tif, module, "JxlEncoderSetFrameDistance() failed");
-            JxlEncoderDestroy(enc);
+            JXLReleaseEncoder(sp);
             return 0;
         }
     }
@@ -940,14 +1081,14 @@ static int JXLPostEncode(TIFF *tif)
 #endif
     {
         TIFFErrorExtR(tif, module, "JxlEncoderFrameSettingsSetOption() failed");
-        JxlEncoderDestroy(enc);
+        JXLReleaseEncoder(sp);
         return 0;
     }
 
     if (JXL_ENC_SUCCESS != JxlEncoderSetBasicInfo(enc, &basic_info))
     {
         TIFFErrorExtR(tif, module, "JxlEncoderSetBasicInfo() failed");
-        JxlEncoderDestroy(enc);
+        JXLReleaseEncoder(sp);
         return 0;
     }
 
@@ -958,7 +1099,7 @@ static int JXLPostEncode(TIFF *tif)
     if (JXL_ENC_SUCCESS != JxlEncoderSetColorEncoding(enc, &color_encoding))
     {
         TIFFErrorExtR(tif, module, "JxlEncoderSetColorEncoding() failed");
-        JxlEncoderDestroy(enc);
+        JXLReleaseEncoder(sp);
         return 0;
     }
 
@@ -1016,7 +1157,7 @@ static int JXLPostEncode(TIFF *tif)
                 TIFFErrorExtR(tif, module,
                               "JxlEncoderSetExtraChannelInfo(%d) failed",
                               iChannel);
-                JxlEncoderDestroy(enc);
+                JXLReleaseEncoder(sp);
                 _TIFFfreeExt(tif, main_buffer);
                 return 0;
             }
@@ -1031,7 +1172,7 @@ static int JXLPostEncode(TIFF *tif)
                         tif, module,
                         "JxlEncoderSetExtraChannelDistance(%d) failed",
                         iChannel);
-                    JxlEncoderDestroy(enc);
+                    JXLReleaseEncoder(sp);
                     _TIFFfreeExt(tif, main_buffer);
                     return 0;
                 }
@@ -1051,7 +1192,7 @@ static int JXLPostEncode(TIFF *tif)
     if (retCode != JXL_ENC_SUCCESS)
     {
         TIFFErrorExtR(tif, module, "JxlEncoderAddImageFrame() failed");
-        JxlEncoderDestroy(enc);
+        JXLReleaseEncoder(sp);
         return 0;
     }
 
@@ -1090,7 +1231,7 @@ static int JXLPostEncode(TIFF *tif)
                 TIFFErrorExtR(tif, module,
                               "JxlEncoderSetExtraChannelBuffer() failed");
                 _TIFFfreeExt(tif, extra_channel_buffer);
-                JxlEncoderDestroy(enc);
+                JXLReleaseEncoder(sp);
                 return 0;
             }
         }
@@ -1109,20 +1250,20 @@ static int JXLPostEncode(TIFF *tif)
         if (process_result == JXL_ENC_ERROR)
         {
             TIFFErrorExtR(tif, module, "JxlEncoderProcessOutput() failed");
-            JxlEncoderDestroy(enc);
+            JXLReleaseEncoder(sp);
             return 0;
         }
         tif->tif_rawcc = tif->tif_rawdatasize - len;
         if (!TIFFFlushData1(tif))
         {
-            JxlEncoderDestroy(enc);
+            JXLReleaseEncoder(sp);
             return 0;
         }
         if (process_result != JXL_ENC_NEED_MORE_OUTPUT)
             break;
     }
 
-    JxlEncoderDestroy(enc);
+    JXLReleaseEncoder(sp);
     return 1;
 }
 
@@ -1140,6 +1281,12 @@ static void JXLCleanup(TIFF *tif)
     if (sp->decoder)
         JxlDecoderDestroy(sp->decoder);
 
+    JXLDestroyEncoder(sp);
+#ifdef HAVE_JXL_THREADS
+    if (sp->runner)
+        JxlResizableParallelRunnerDestroy(sp->runner);
+#endif
+
     _TIFFfreeExt(tif, sp);
     tif->tif_data = NULL;
 
@@ -1155,6 +1302,8 @@ static const TIFFField JXLFields[] = {
      TIFF_SETGET_UNDEFINED, FIELD_PSEUDO, FALSE, FALSE, "Distance", NULL},
     {TIFFTAG_JXL_ALPHA_DISTANCE, 0, 0, TIFF_ANY, 0, TIFF_SETGET_FLOAT,
      TIFF_SETGET_UNDEFINED, FIELD_PSEUDO, FALSE, FALSE, "AlphaDistance", NULL},
+    {TIFFTAG_JXL_NUM_THREADS, 0, 0, TIFF_ANY, 0, TIFF_SETGET_UINT32,
+     TIFF_SETGET_UNDEFINED, FIELD_PSEUDO, FALSE, FALSE, "NumThreads", NULL},
 };
 
 static int JXLVSetField(TIFF *tif, uint32_t tag, va_list ap)
@@ -1221,6 +1370,24 @@ static int JXLVSetField(TIFF *tif, uint32_t tag, va_list ap)
             return 1;
         }
 
+        case TIFFTAG_JXL_NUM_THREADS:
+        {
+            uint32_t num_threads = va_arg(ap, uint32_t);
+            if (num_threads < 1 || num_threads > 1024)
+            {
+                TIFFErrorExtR(tif, module, "Invalid value for NumThreads: %u",
+                              num_threads);
+                return 0;
+            }
+#ifdef HAVE_JXL_THREADS
+            /* The parallel runner of an encoder cannot be changed */
+            if ((num_threads > 1) != (sp->num_threads > 1))
+                JXLDestroyEncoder(sp);
+#endif
+            sp->num_threads = num_threads;
+            return 1;
+        }
+
         default:
         {
             return (*sp->vsetparent)(tif, tag, ap);
@@ -1247,6 +1414,9 @@ static int JXLVGetField(TIFF *tif, uint32_t tag, va_list ap)
         case TIFFTAG_JXL_ALPHA_DISTANCE:
             *va_arg(ap, float *) = sp->alpha_distance;
             break;
+        case TIFFTAG_JXL_NUM_THREADS:
+            *va_arg(ap, uint32_t *) = sp->num_threads;
+            break;
         default:
             return (*sp->vgetparent)(tif, tag, ap);
     }
@@ -1311,6 +1481,8 @@ int TIFFInitJXL(TIFF *tif, int scheme)
     sp->effort = 5;
     sp->distance = 1.0;
     sp->alpha_distance = -1.0;
+    sp->num_threads = 1;
+    sp->encoder = NULL;
 
     return 1;
 bad:
@@ -49,6 +49,12 @@
              max butteraugli distance, lower = higher quality. Range: 0 .. 15.*/
 #endif
 
+#ifndef TIFFTAG_JXL_NUM_THREADS
+#define TIFFTAG_JXL_NUM_THREADS                                                \
+    65539 /* Maximum number of threads used to encode a strip or tile.        \
+             Default is 1 */
+#endif
+
 #if defined(__cplusplus)
 extern "C"
 {
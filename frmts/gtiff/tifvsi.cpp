@@ -41,6 +41,15 @@
 #include <fcntl.h>
 #endif
 
+#include <algorithm>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
 #include "cpl_conv.h"
 #include "cpl_vsi.h"
 #include "cpl_string.h"
@@ -67,18 +76,72 @@ extern int GTiffErrorHandlerExt(TIFF *tif, void *user_data, const char *module,
 
 constexpr int BUFFER_SIZE = 65536;
 
+/************************************************************************/
+/*                         Header cache                                 */
+/************************************************************************/
+
+// Process-wide cache of the bytes read by libtiff while opening files
+// (TIFF header, IFDs, out-of-line tag values), so that re-opening a remote
+// file does not need to fetch them again.
+
+// Byte ranges indexed by their start offset. Adjacent ranges are merged.
+typedef std::map<vsi_l_offset, std::string> GDALTiffHeaderRanges;
+
+namespace
+{
+struct GDALTiffHeaderCacheEntry
+{
+    vsi_l_offset nFileSize = 0;
+    GIntBig nMTime = 0;
+    std::shared_ptr<const GDALTiffHeaderRanges> poRanges{};
+    size_t nBytes = 0;
+};
+
+struct GDALTiffHeaderCache
+{
+    std::mutex oMutex{};
+    // Most recently used first
+    std::list<std::pair<std::string, GDALTiffHeaderCacheEntry>> oList{};
+    std::unordered_map<std::string, decltype(oList)::iterator> oMap{};
+    size_t nUsed = 0;
+};
+}  // namespace
+
+static GDALTiffHeaderCache &GetHeaderCache()
+{
+    static GDALTiffHeaderCache oCache;
+    return oCache;
+}
+
+static size_t GetHeaderCacheMaxSize()
+{
+    return static_cast<size_t>(std::max<GIntBig>(
+        0, CPLAtoGIntBig(CPLGetConfigOption("GTIFF_HEADER_CACHE_SIZE",
+                                            "16777216"))));
+}
+
 struct GDALTiffHandle;
 
 struct GDALTiffHandleShared
 {
-    VSILFILE *fpL;
-    bool bReadOnly;
-    bool bLazyStrileLoading;
-    char *pszName;
-    GDALTiffHandle *psActiveHandle;  // only used on the parent
-    int nUserCounter;
-    bool bAtEndOfFile;
-    vsi_l_offset nFileLength;
+    VSILFILE *fpL = nullptr;
+    bool bReadOnly = false;
+    bool bLazyStrileLoading = false;
+    char *pszName = nullptr;
+    GDALTiffHandle *psActiveHandle = nullptr;  // only used on the parent
+    int nUserCounter = 0;
+    bool bAtEndOfFile = false;
+    vsi_l_offset nFileLength = 0;
+
+    // Header cache related members
+    size_t nHeaderCacheMaxSize = 0;
+    vsi_l_offset nHeaderCacheFileSize = 0;
+    GIntBig nHeaderCacheMTime = 0;
+    // Ranges from the header cache, used to serve reads
+    std::shared_ptr<const GDALTiffHeaderRanges> poHeaderRanges{};
+    // Ranges being recorded while opening the file, if not in the cache
+    std::unique_ptr<GDALTiffHeaderRanges> poRecordedRanges{};
+    size_t nRecordedBytes = 0;
 };
 
 struct GDALTiffHandle
@@ -135,6 +198,57 @@ void *VSI_TIFFGetCachedRange(thandle_t th, vsi_l_offset nOffset, size_t nSize)
     return nullptr;
 }
 
+/************************************************************************/
+/*                        GetHeaderCachedRange()                        */
+/************************************************************************/
+
+static const char *GetHeaderCachedRange(const GDALTiffHeaderRanges &oRanges,
+                                        vsi_l_offset nOffset, size_t nSize)
+{
+    auto oIter = oRanges.upper_bound(nOffset);
+    if (oIter == oRanges.begin())
+        return nullptr;
+    --oIter;
+    if (nOffset + nSize > oIter->first + oIter->second.size())
+        return nullptr;
+    return oIter->second.data() + (nOffset - oIter->first);
+}
+
+/************************************************************************/
+/*                           RecordHeaderRange()                        */
+/************************************************************************/
+
+static void RecordHeaderRange(GDALTiffHandleShared *psShared,
+                              vsi_l_offset nOffset, const void *pData,
+                              size_t nSize)
+{
+    auto &oRanges = *(psShared->poRecordedRanges);
+    if (psShared->nRecordedBytes + nSize > psShared->nHeaderCacheMaxSize)
+    {
+        // Too big to be cached: stop recording
+        psShared->poRecordedRanges.reset();
+        return;
+    }
+    if (nSize == 0 ||
+        GetHeaderCachedRange(oRanges, nOffset, nSize) != nullptr)
+        return;
+
+    // Merge with the range ending at nOffset, if any
+    auto oIter = oRanges.upper_bound(nOffset);
+    if (oIter != oRanges.begin())
+    {
+        auto oIterPrev = std::prev(oIter);
+        if (oIterPrev->first + oIterPrev->second.size() == nOffset)
+        {
+            oIterPrev->second.append(static_cast<const char *>(pData), nSize);
+            psShared->nRecordedBytes += nSize;
+            return;
+        }
+    }
+    oRanges[nOffset].assign(static_cast<const char *>(pData), nSize);
+    psShared->nRecordedBytes += nSize;
+}
+
 static tsize_t _tiffReadProc(thandle_t th, tdata_t buf, tsize_t size)
 {
     GDALTiffHandle *psGTH = reinterpret_cast<GDALTiffHandle *>(th);
@@ -153,6 +267,30 @@ static tsize_t _tiffReadProc(thandle_t th, tdata_t buf, tsize_t size)
         }
     }
 
+    GDALTiffHandleShared *psShared = psGTH->psShared;
+    if (psShared->poHeaderRanges || psShared->poRecordedRanges)
+    {
+        const vsi_l_offset nCurOffset = VSIFTellL(psShared->fpL);
+        if (psShared->poHeaderRanges)
+        {
+            const char *pszData =
+                GetHeaderCachedRange(*(psShared->poHeaderRanges), nCurOffset,
+                                     static_cast<size_t>(size));
+            if (pszData)
+            {
+                memcpy(buf, pszData, size);
+                VSIFSeekL(psShared->fpL, nCurOffset + size, SEEK_SET);
+                return size;
+            }
+        }
+        else
+        {
+            const size_t nRead = VSIFReadL(buf, 1, size, psShared->fpL);
+            RecordHeaderRange(psShared, nCurOffset, buf, nRead);
+            return nRead;
+        }
+    }
+
 #ifdef DEBUG_VERBOSE_EXTRA
     CPLDebug("GTiff", "Reading %d bytes at offset " CPL_FRMT_GUIB,
              static_cast<int>(size), VSIFTellL(psGTH->psShared->fpL));
@@ -280,7 +418,7 @@ static void FreeGTH(GDALTiffHandle *psGTH)
     {
         assert(psGTH->psShared->nUserCounter == 0);
         CPLFree(psGTH->psShared->pszName);
-        CPLFree(psGTH->psShared);
+        delete psGTH->psShared;
     }
     else
     {
@@ -493,6 +631,132 @@ static TIFF *VSI_TIFFOpen_common(GDALTiffHandle *psGTH, const char *pszMode)
     return tif;
 }
 
+/************************************************************************/
+/*                       VSI_TIFFInitHeaderCache()                      */
+/************************************************************************/
+
+// Either attach the cached header ranges of the file to the handle, or start
+// recording them.
+static void VSI_TIFFInitHeaderCache(GDALTiffHandleShared *psShared,
+                                    const char *pszName)
+{
+    // Local files are fast enough to read
+    if (VSIIsLocal(pszName) &&
+        !CPLTestBool(CPLGetConfigOption("GTIFF_HEADER_CACHE_LOCAL", "NO")))
+        return;
+    psShared->nHeaderCacheMaxSize = GetHeaderCacheMaxSize();
+    if (psShared->nHeaderCacheMaxSize == 0)
+        return;
+
+    VSIStatBufL sStat;
+    if (VSIStatL(pszName, &sStat) != 0)
+        return;
+    psShared->nHeaderCacheFileSize = static_cast<vsi_l_offset>(sStat.st_size);
+    psShared->nHeaderCacheMTime = static_cast<GIntBig>(sStat.st_mtime);
+
+    auto &oCache = GetHeaderCache();
+    {
+        std::lock_guard<std::mutex> oLock(oCache.oMutex);
+        auto oIter = oCache.oMap.find(pszName);
+        if (oIter != oCache.oMap.end())
+        {
+            const auto &oEntry = oIter->second->second;
+            if (oEntry.nFileSize == psShared->nHeaderCacheFileSize &&
+                oEntry.nMTime == psShared->nHeaderCacheMTime)
+            {
+                CPLDebug("GTiff", "Using cached header of %s", pszName);
+                psShared->poHeaderRanges = oEntry.poRanges;
+                oCache.oList.splice(oCache.oList.begin(), oCache.oList,
+                                    oIter->second);
+                return;
+            }
+
+            // File has changed
+            oCache.nUsed -= oEntry.nBytes;
+            oCache.oList.erase(oIter->second);
+            oCache.oMap.erase(oIter);
+        }
+    }
+
+    psShared->poRecordedRanges = std::make_unique<GDALTiffHeaderRanges>();
+}
+
+/************************************************************************/
+/*                     VSI_TIFFIsRecordingHeader()                      */
+/************************************************************************/
+
+bool VSI_TIFFIsRecordingHeader(thandle_t th)
+{
+    GDALTiffHandle *psGTH = reinterpret_cast<GDALTiffHandle *>(th);
+    return psGTH->psShared->poRecordedRanges != nullptr;
+}
+
+/************************************************************************/
+/*                     VSI_TIFFStoreHeaderCache()                       */
+/************************************************************************/
+
+void VSI_TIFFStoreHeaderCache(thandle_t th)
+{
+    GDALTiffHandle *psGTH = reinterpret_cast<GDALTiffHandle *>(th);
+    GDALTiffHandleShared *psShared = psGTH->psShared;
+    if (!psShared->poRecordedRanges)
+        return;
+    std::shared_ptr<const GDALTiffHeaderRanges> poRanges(
+        std::move(psShared->poRecordedRanges));
+    if (poRanges->empty())
+        return;
+
+    const size_t nMax = psShared->nHeaderCacheMaxSize;
+    const size_t nBytes = psShared->nRecordedBytes + poRanges->size() * 64;
+    if (nBytes > nMax)
+        return;
+
+    GDALTiffHeaderCacheEntry oEntry;
+    oEntry.nFileSize = psShared->nHeaderCacheFileSize;
+    oEntry.nMTime = psShared->nHeaderCacheMTime;
+    oEntry.poRanges = poRanges;
+    oEntry.nBytes = nBytes;
+
+    auto &oCache = GetHeaderCache();
+    std::lock_guard<std::mutex> oLock(oCache.oMutex);
+    const std::string osKey(psShared->pszName);
+    auto oIter = oCache.oMap.find(osKey);
+    if (oIter != oCache.oMap.end())
+    {
+        // Another handle might have stored it in the meantime
+        oCache.nUsed -= oIter->second->second.nBytes;
+        oCache.oList.erase(oIter->second);
+        oCache.oMap.erase(oIter);
+    }
+    oCache.oList.emplace_front(osKey, std::move(oEntry));
+    oCache.oMap[osKey] = oCache.oList.begin();
+    oCache.nUsed += nBytes;
+
+    while (oCache.nUsed > nMax)
+    {
+        const auto &oOldest = oCache.oList.back();
+        oCache.nUsed -= oOldest.second.nBytes;
+        oCache.oMap.erase(oOldest.first);
+        oCache.oList.pop_back();
+    }
+
+    // Serve subsequent reads of this handle from the recorded ranges too
+    psShared->poHeaderRanges = std::move(poRanges);
+}
+
+/************************************************************************/
+/*                     VSI_TIFFClearHeaderCache()                       */
+/************************************************************************/
+
+void VSI_TIFFClearHeaderCache()
+{
+    auto &oCache = GetHeaderCache();
+    std::lock_guard<std::mutex> oLock(oCache.oMutex);
+    oCache.oList.clear();
+    oCache.oMap.clear();
+    oCache.nUsed = 0;
+}
+
 // Open a TIFF file for read/writing.
 TIFF *VSI_TIFFOpen(const char *name, const char *mode, VSILFILE *fpL)
 {
@@ -504,8 +768,7 @@ TIFF *VSI_TIFFOpen(const char *name, const char *mode, VSILFILE *fpL)
         static_cast<GDALTiffHandle *>(CPLCalloc(1, sizeof(GDALTiffHandle)));
     psGTH->bFree = true;
     psGTH->psParent = nullptr;
-    psGTH->psShared = static_cast<GDALTiffHandleShared *>(
-        CPLCalloc(1, sizeof(GDALTiffHandleShared)));
+    psGTH->psShared = new GDALTiffHandleShared();
     psGTH->psShared->bReadOnly = (strchr(mode, '+') == nullptr);
     psGTH->psShared->bLazyStrileLoading = (strchr(mode, 'D') != nullptr);
     psGTH->psShared->pszName = CPLStrdup(name);
@@ -515,6 +778,9 @@ TIFF *VSI_TIFFOpen(const char *name, const char *mode, VSILFILE *fpL)
     psGTH->psShared->bAtEndOfFile = false;
     psGTH->psShared->nUserCounter = 1;
 
+    if (psGTH->psShared->bReadOnly)
+        VSI_TIFFInitHeaderCache(psGTH->psShared, name);
+
     return VSI_TIFFOpen_common(psGTH, mode);
 }
 
@@ -53,4 +53,10 @@ void VSI_TIFFSetCachedRanges(
     const vsi_l_offset *panOffsets, const size_t *panSizes);
 void *VSI_TIFFGetCachedRange(thandle_t th, vsi_l_offset nOffset, size_t nSize);
 
+// Store the header bytes read since the opening of the file in the
+// process-wide header cache (GTIFF_HEADER_CACHE_SIZE).
+bool VSI_TIFFIsRecordingHeader(thandle_t th);
+void VSI_TIFFStoreHeaderCache(thandle_t th);
+void VSI_TIFFClearHeaderCache();
+
 #endif  // TIFVSI_H_INCLUDED
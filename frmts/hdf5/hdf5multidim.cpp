@@ -25,14 +25,26 @@
  * DEALINGS IN THE SOFTWARE.
  ****************************************************************************/
 
+#include "cpl_compressor.h"
+#include "cpl_error_internal.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "hdf5dataset.h"
 #include "hdf5eosparser.h"
 #include "s100.h"
 
 #include <algorithm>
+#include <map>
+#include <mutex>
 #include <set>
 #include <utility>
 
+#if defined(H5_VERSION_GE)
+#if H5_VERSION_GE(1, 10, 5)
+#define HAVE_H5DGET_CHUNK_INFO_BY_COORD
+#endif
+#endif
+
 namespace GDAL
 {
 
@@ -292,6 +304,50 @@ class HDF5Array final : public GDALMDArray
     mutable bool m_bHasDimensionLabels = false;
     std::shared_ptr<OGRSpatialReference> m_poSRS{};
     haddr_t m_nOffset;
+    std::vector<GUInt64> m_anBlockSize{};
+
+    // Direct reading of chunks, bypassing libhdf5 for I/O and decompression
+    struct ChunkLocation
+    {
+        haddr_t nAddr = HADDR_UNDEF;
+        hsize_t nSize = 0;
+        unsigned nFilterMask = 0;
+    };
+
+    struct ChunkReadTask
+    {
+        std::vector<GUInt64> anChunkIdx{};
+        ChunkLocation sLocation{};
+    };
+
+    struct ChunkReadRequest
+    {
+        const GUInt64 *arrayStartIdx = nullptr;
+        const size_t *count = nullptr;
+        const GInt64 *arrayStep = nullptr;
+        const GPtrDiff_t *bufferStride = nullptr;
+        const GDALExtendedDataType *pBufferDataType = nullptr;
+        void *pDstBuffer = nullptr;
+        std::vector<ChunkReadTask> asTasks{};
+    };
+
+    struct ChunkReadJob
+    {
+        const HDF5Array *poArray = nullptr;
+        const ChunkReadRequest *psRequest = nullptr;
+        size_t iBegin = 0;
+        size_t iEnd = 0;
+        bool bOK = false;
+        std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+    };
+
+    bool m_bDirectChunkReadPossible = false;
+    size_t m_nChunkBytes = 0;
+    std::vector<H5Z_filter_t> m_anFilters{};
+    std::vector<GByte> m_abyFillValue{};
+    mutable std::mutex m_oMutexChunkLocations{};
+    mutable std::map<std::vector<GUInt64>, ChunkLocation>
+        m_oMapChunkLocations{};
 
     HDF5Array(const std::string &osParentName, const std::string &osName,
               const std::shared_ptr<HDF5SharedResources> &poShared,
@@ -301,11 +357,31 @@ class HDF5Array final : public GDALMDArray
     void InstantiateDimensions(const std::string &osParentName,
                                const HDF5Group *poGroup);
 
+    void InitChunking();
+
     bool ReadSlow(const GUInt64 *arrayStartIdx, const size_t *count,
                   const GInt64 *arrayStep, const GPtrDiff_t *bufferStride,
                   const GDALExtendedDataType &bufferDataType,
                   void *pDstBuffer) const;
 
+    bool IsDirectChunkReadCandidate(const GUInt64 *arrayStartIdx,
+                                    const size_t *count,
+                                    const GInt64 *arrayStep,
+                                    const GPtrDiff_t *bufferStride,
+                                    const GDALExtendedDataType &bufferDataType)
+        const;
+
+    bool ReadChunksDirectly(const GUInt64 *arrayStartIdx, const size_t *count,
+                            const GInt64 *arrayStep,
+                            const GPtrDiff_t *bufferStride,
+                            const GDALExtendedDataType &bufferDataType,
+                            void *pDstBuffer) const;
+
+    bool ReadChunkTasks(const ChunkReadRequest &sRequest, size_t iBegin,
+                        size_t iEnd) const;
+
+    static void ReadChunkTasksJobFunc(void *pData);
+
     static herr_t GetAttributesCallback(hid_t hArray, const char *pszObjName,
                                         void *);
 
@@ -374,6 +450,13 @@ class HDF5Array final : public GDALMDArray
         return m_osUnit;
     }
 
+    std::vector<GUInt64> GetBlockSize() const override
+    {
+        if (m_anBlockSize.empty())
+            return std::vector<GUInt64>(m_dims.size());
+        return m_anBlockSize;
+    }
+
     haddr_t GetFileOffset() const
     {
         return m_nOffset;
@@ -1194,6 +1277,122 @@ HDF5Array::HDF5Array(const std::string &osParentName, const std::string &osName,
     {
         InstantiateDimensions(osParentName, poGroup);
     }
+
+    InitChunking();
+}
+
+/************************************************************************/
+/*                            InitChunking()                            */
+/************************************************************************/
+
+// Fetch the chunk size, and determine if chunks can be read and decoded
+// without libhdf5, that is if the array is made of native integer or floating
+// point values, and is only compressed with the deflate and shuffle filters.
+void HDF5Array::InitChunking()
+{
+    const size_t nDims = m_dims.size();
+    if (nDims == 0 ||
+        H5Sget_simple_extent_ndims(m_hDataSpace) != static_cast<int>(nDims))
+    {
+        return;
+    }
+    const hid_t hDCPL = H5Dget_create_plist(m_hArray);
+    if (hDCPL < 0)
+        return;
+    std::vector<hsize_t> anChunkDims(nDims);
+    if (H5Pget_layout(hDCPL) != H5D_CHUNKED ||
+        H5Pget_chunk(hDCPL, static_cast<int>(nDims), anChunkDims.data()) !=
+            static_cast<int>(nDims))
+    {
+        H5Pclose(hDCPL);
+        return;
+    }
+    m_anBlockSize.assign(anChunkDims.begin(), anChunkDims.end());
+
+#ifdef HAVE_H5DGET_CHUNK_INFO_BY_COORD
+    const H5T_class_t eClass = H5Tget_class(m_hNativeDT);
+    const hid_t hFileDT = H5Dget_type(m_hArray);
+    bool bOK = m_dt.GetClass() == GEDTC_NUMERIC && !m_bHasNonNativeDataType &&
+               (eClass == H5T_INTEGER || eClass == H5T_FLOAT) &&
+               H5Tequal(hFileDT, m_hNativeDT) > 0;
+    H5Tclose(hFileDT);
+
+    // Chunk addresses are relative to the base address of the file, and
+    // the family driver splits the file into several ones.
+    if (bOK)
+    {
+        const hid_t hFAPL = H5Fget_access_plist(m_poShared->GetHDF5());
+        bOK = hFAPL >= 0 && H5Pget_driver(hFAPL) == HDF5GetFileDriver();
+        if (hFAPL >= 0)
+            H5Pclose(hFAPL);
+        const hid_t hFCPL = H5Fget_create_plist(m_poShared->GetHDF5());
+        hsize_t nUserBlockSize = 0;
+        bOK = bOK && hFCPL >= 0 &&
+              H5Pget_userblock(hFCPL, &nUserBlockSize) >= 0 &&
+              nUserBlockSize == 0;
+        if (hFCPL >= 0)
+            H5Pclose(hFCPL);
+    }
+
+    // Partial edge chunks may be stored unfiltered
+    unsigned nChunkOpts = 0;
+    bOK = bOK && H5Pget_chunk_opts(hDCPL, &nChunkOpts) >= 0 &&
+          (nChunkOpts & H5D_CHUNK_DONT_FILTER_PARTIAL_CHUNKS) == 0;
+
+    const size_t nDTSize = m_dt.GetSize();
+    GUInt64 nChunkBytes = nDTSize;
+    for (const auto nSize : m_anBlockSize)
+    {
+        if (nSize == 0 || nChunkBytes > std::numeric_limits<int>::max() / nSize)
+        {
+            bOK = false;
+            break;
+        }
+        nChunkBytes *= nSize;
+    }
+
+    const int nFilters = bOK ? H5Pget_nfilters(hDCPL) : 0;
+    for (int i = 0; bOK && i < nFilters; ++i)
+    {
+        char szName[120] = {};
+        size_t nCDElts = 20;
+        unsigned int anCDValues[20] = {};
+        unsigned int nFlags = 0;
+        const H5Z_filter_t nFilter =
+            H5Pget_filter(hDCPL, i, &nFlags, &nCDElts, anCDValues,
+                          sizeof(szName), szName);
+        if (nFilter == H5Z_FILTER_DEFLATE || nFilter == H5Z_FILTER_SHUFFLE)
+            m_anFilters.push_back(nFilter);
+        else
+            bOK = false;
+    }
+    if (bOK &&
+        std::find(m_anFilters.begin(), m_anFilters.end(),
+                  H5Z_FILTER_DEFLATE) != m_anFilters.end() &&
+        CPLGetDecompressor("zlib") == nullptr)
+    {
+        bOK = false;
+    }
+
+    if (bOK)
+    {
+        m_abyFillValue.resize(nDTSize);
+        bOK = H5Pget_fill_value(hDCPL, m_hNativeDT, m_abyFillValue.data()) >= 0;
+    }
+
+    if (bOK)
+    {
+        m_nChunkBytes = static_cast<size_t>(nChunkBytes);
+        m_bDirectChunkReadPossible = true;
+    }
+    else
+    {
+        m_anFilters.clear();
+        m_abyFillValue.clear();
+    }
+#endif
+
+    H5Pclose(hDCPL);
 }
 
 /************************************************************************/
@@ -2331,6 +2530,13 @@ bool HDF5Array::IRead(const GUInt64 *arrayStartIdx, const size_t *count,
                       const GDALExtendedDataType &bufferDataType,
                       void *pDstBuffer) const
 {
+    if (IsDirectChunkReadCandidate(arrayStartIdx, count, arrayStep,
+                                   bufferStride, bufferDataType))
+    {
+        return ReadChunksDirectly(arrayStartIdx, count, arrayStep,
+                                  bufferStride, bufferDataType, pDstBuffer);
+    }
+
     HDF5_GLOBAL_LOCK();
 
     const size_t nDims(m_dims.size());
@@ -2513,6 +2719,441 @@ bool HDF5Array::IRead(const GUInt64 *arrayStartIdx, const size_t *count,
     return status >= 0;
 }
 
+/************************************************************************/
+/*                      IsDirectChunkReadCandidate()                    */
+/************************************************************************/
+
+// Requests intersecting a single chunk are left to libhdf5, which caches
+// decompressed chunks.
+bool HDF5Array::IsDirectChunkReadCandidate(
+    const GUInt64 *arrayStartIdx, const size_t *count, const GInt64 *arrayStep,
+    const GPtrDiff_t *bufferStride,
+    const GDALExtendedDataType &bufferDataType) const
+{
+    if (!m_bDirectChunkReadPossible ||
+        bufferDataType.GetClass() != GEDTC_NUMERIC)
+    {
+        return false;
+    }
+
+    const size_t nDims = m_dims.size();
+    bool bSeveralChunks = false;
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        if (count[i] > 1)
+        {
+            if (arrayStep[i] <= 0 || bufferStride[i] < 0)
+                return false;
+            const GUInt64 nLastIdx =
+                arrayStartIdx[i] +
+                (count[i] - 1) * static_cast<GUInt64>(arrayStep[i]);
+            if (nLastIdx / m_anBlockSize[i] !=
+                arrayStartIdx[i] / m_anBlockSize[i])
+            {
+                bSeveralChunks = true;
+            }
+        }
+    }
+
+    // Strides of the fastest varying dimension are passed as int to
+    // GDALCopyWords64()
+    if (count[nDims - 1] > 1 &&
+        (static_cast<GUInt64>(arrayStep[nDims - 1]) >
+             static_cast<GUInt64>(std::numeric_limits<int>::max()) /
+                 m_dt.GetSize() ||
+         static_cast<GUInt64>(bufferStride[nDims - 1]) >
+             static_cast<GUInt64>(std::numeric_limits<int>::max()) /
+                 bufferDataType.GetSize()))
+    {
+        return false;
+    }
+
+    return bSeveralChunks &&
+           CPLTestBool(
+               CPLGetConfigOption("GDAL_HDF5_DIRECT_CHUNK_READ", "YES"));
+}
+
+/************************************************************************/
+/*                          GetChunkIntersection()                      */
+/************************************************************************/
+
+// Compute, for each dimension, the range [anKMin[i], anKMax[i]] of the
+// indices of the request that fall into the chunk of index anChunkIdx.
+// Return false if the chunk does not contain any requested element.
+static bool GetChunkIntersection(size_t nDims, const GUInt64 *arrayStartIdx,
+                                 const size_t *count, const GInt64 *arrayStep,
+                                 const std::vector<GUInt64> &anBlockSize,
+                                 const std::vector<GUInt64> &anChunkIdx,
+                                 std::vector<GUInt64> &anKMin,
+                                 std::vector<GUInt64> &anKMax)
+{
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        const GUInt64 nStep =
+            count[i] > 1 ? static_cast<GUInt64>(arrayStep[i]) : 1;
+        const GUInt64 nChunkStart = anChunkIdx[i] * anBlockSize[i];
+        const GUInt64 nChunkLast = nChunkStart + anBlockSize[i] - 1;
+        anKMin[i] = nChunkStart <= arrayStartIdx[i]
+                        ? 0
+                        : DIV_ROUND_UP(nChunkStart - arrayStartIdx[i], nStep);
+        anKMax[i] = std::min(static_cast<GUInt64>(count[i] - 1),
+                             (nChunkLast - arrayStartIdx[i]) / nStep);
+        if (anKMin[i] > anKMax[i])
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                         ReadChunksDirectly()                         */
+/************************************************************************/
+
+// Read a request intersecting several chunks by reading and decompressing
+// chunks directly from the file, from several threads when
+// GDAL_NUM_THREADS allows it. libhdf5 is only used, under its lock, to
+// get the location of chunks, which is cached.
+bool HDF5Array::ReadChunksDirectly(const GUInt64 *arrayStartIdx,
+                                   const size_t *count,
+                                   const GInt64 *arrayStep,
+                                   const GPtrDiff_t *bufferStride,
+                                   const GDALExtendedDataType &bufferDataType,
+                                   void *pDstBuffer) const
+{
+    const size_t nDims = m_dims.size();
+    ChunkReadRequest sRequest;
+    sRequest.arrayStartIdx = arrayStartIdx;
+    sRequest.count = count;
+    sRequest.arrayStep = arrayStep;
+    sRequest.bufferStride = bufferStride;
+    sRequest.pBufferDataType = &bufferDataType;
+    sRequest.pDstBuffer = pDstBuffer;
+
+    // Collect the chunks intersecting the request
+    std::vector<GUInt64> anChunkIdxStart(nDims);
+    std::vector<GUInt64> anChunkIdxEnd(nDims);
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        const GUInt64 nStep =
+            count[i] > 1 ? static_cast<GUInt64>(arrayStep[i]) : 0;
+        anChunkIdxStart[i] = arrayStartIdx[i] / m_anBlockSize[i];
+        anChunkIdxEnd[i] =
+            (arrayStartIdx[i] + (count[i] - 1) * nStep) / m_anBlockSize[i];
+    }
+    std::vector<GUInt64> anKMin(nDims);
+    std::vector<GUInt64> anKMax(nDims);
+    std::vector<GUInt64> anChunkIdx(anChunkIdxStart);
+    while (true)
+    {
+        if (GetChunkIntersection(nDims, arrayStartIdx, count, arrayStep,
+                                 m_anBlockSize, anChunkIdx, anKMin, anKMax))
+        {
+            ChunkReadTask sTask;
+            sTask.anChunkIdx = anChunkIdx;
+            sRequest.asTasks.push_back(std::move(sTask));
+        }
+        bool bDone = true;
+        for (size_t i = nDims; i > 0;)
+        {
+            --i;
+            if (anChunkIdx[i] < anChunkIdxEnd[i])
+            {
+                ++anChunkIdx[i];
+                bDone = false;
+                break;
+            }
+            anChunkIdx[i] = anChunkIdxStart[i];
+        }
+        if (bDone)
+            break;
+    }
+
+    // Get their location in the file
+    {
+        std::lock_guard<std::mutex> oChunkLocationsLock(m_oMutexChunkLocations);
+        HDF5_GLOBAL_LOCK();
+        std::vector<hsize_t> anOffset(nDims);
+        for (auto &sTask : sRequest.asTasks)
+        {
+            auto oIter = m_oMapChunkLocations.find(sTask.anChunkIdx);
+            if (oIter != m_oMapChunkLocations.end())
+            {
+                sTask.sLocation = oIter->second;
+                continue;
+            }
+            for (size_t i = 0; i < nDims; ++i)
+                anOffset[i] = sTask.anChunkIdx[i] * m_anBlockSize[i];
+            ChunkLocation sLocation;
+            if (H5Dget_chunk_info_by_coord(
+                    m_hArray, anOffset.data(), &sLocation.nFilterMask,
+                    &sLocation.nAddr, &sLocation.nSize) < 0)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Cannot get location of chunk of array %s",
+                         GetFullName().c_str());
+                return false;
+            }
+            m_oMapChunkLocations[sTask.anChunkIdx] = sLocation;
+            sTask.sLocation = sLocation;
+        }
+    }
+
+    const char *pszNumThreads =
+        CPLGetConfigOption("GDAL_NUM_THREADS", "ALL_CPUS");
+    int nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+    nThreads = static_cast<int>(std::min<size_t>(
+        sRequest.asTasks.size(), std::max(1, std::min(nThreads, 1024))));
+    CPLWorkerThreadPool *wtp =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    if (wtp == nullptr)
+        return ReadChunkTasks(sRequest, 0, sRequest.asTasks.size());
+
+    auto poQueue = wtp->CreateJobQueue();
+    std::vector<ChunkReadJob> asJobs(nThreads);
+    const size_t nTasks = sRequest.asTasks.size();
+    for (int i = 0; i < nThreads; ++i)
+    {
+        asJobs[i].poArray = this;
+        asJobs[i].psRequest = &sRequest;
+        asJobs[i].iBegin = nTasks * i / nThreads;
+        asJobs[i].iEnd = nTasks * (i + 1) / nThreads;
+        if (!poQueue->SubmitJob(ReadChunkTasksJobFunc, &asJobs[i]))
+            ReadChunkTasksJobFunc(&asJobs[i]);
+    }
+    poQueue->WaitCompletion();
+
+    bool bRet = true;
+    for (const auto &sJob : asJobs)
+    {
+        for (const auto &oError : sJob.aoErrors)
+            CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+        bRet = bRet && sJob.bOK;
+    }
+    return bRet;
+}
+
+/************************************************************************/
+/*                        ReadChunkTasksJobFunc()                       */
+/************************************************************************/
+
+void HDF5Array::ReadChunkTasksJobFunc(void *pData)
+{
+    auto psJob = static_cast<ChunkReadJob *>(pData);
+    // Errors are re-emitted by ReadChunksDirectly() in the calling thread
+    CPLInstallErrorHandlerAccumulator(psJob->aoErrors);
+    psJob->bOK = psJob->poArray->ReadChunkTasks(*(psJob->psRequest),
+                                                psJob->iBegin, psJob->iEnd);
+    CPLUninstallErrorHandlerAccumulator();
+}
+
+/************************************************************************/
+/*                            HDF5Unshuffle()                           */
+/************************************************************************/
+
+// Reverse the HDF5 shuffle filter, that stores the first byte of all
+// elements, then the second byte of all elements, etc.
+static void HDF5Unshuffle(const GByte *pabySrc, GByte *pabyDst, size_t nBytes,
+                          size_t nEltSize)
+{
+    const size_t nElts = nBytes / nEltSize;
+    if (nEltSize == 1 || nElts <= 1)
+    {
+        memcpy(pabyDst, pabySrc, nBytes);
+        return;
+    }
+    for (size_t j = 0; j < nEltSize; ++j)
+    {
+        const GByte *pabySrcByte = pabySrc + j * nElts;
+        for (size_t i = 0; i < nElts; ++i)
+            pabyDst[i * nEltSize + j] = pabySrcByte[i];
+    }
+    // Leftover bytes are not shuffled
+    memcpy(pabyDst + nElts * nEltSize, pabySrc + nElts * nEltSize,
+           nBytes - nElts * nEltSize);
+}
+
+/************************************************************************/
+/*                           ReadChunkTasks()                           */
+/************************************************************************/
+
+// Read, decode and copy into the destination buffer the chunks of index
+// [iBegin, iEnd) of the request. This does not use libhdf5 and may be
+// called from several threads at once, each thread copying into distinct
+// parts of the destination buffer.
+bool HDF5Array::ReadChunkTasks(const ChunkReadRequest &sRequest,
+                               size_t iBegin, size_t iEnd) const
+{
+    const size_t nDims = m_dims.size();
+    const size_t nDTSize = m_dt.GetSize();
+    const GDALDataType eSrcDT = m_dt.GetNumericDataType();
+    const GDALDataType eDstDT = sRequest.pBufferDataType->GetNumericDataType();
+    const size_t nBufferDTSize = sRequest.pBufferDataType->GetSize();
+    const GUInt64 *arrayStartIdx = sRequest.arrayStartIdx;
+    const size_t *count = sRequest.count;
+    const GInt64 *arrayStep = sRequest.arrayStep;
+    const GPtrDiff_t *bufferStride = sRequest.bufferStride;
+
+    VSILFILE *fp = VSIFOpenL(m_poShared->GetFilename().c_str(), "rb");
+    if (fp == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_OpenFailed, "Cannot open %s",
+                 m_poShared->GetFilename().c_str());
+        return false;
+    }
+
+    const CPLCompressor *psDecompressor = CPLGetDecompressor("zlib");
+    std::vector<GByte> abyChunk;
+    std::vector<GByte> abyTmp;
+    std::vector<GByte> abyFillChunk;
+    std::vector<GUInt64> anChunkStride(nDims);
+    GUInt64 nStride = 1;
+    for (size_t i = nDims; i > 0;)
+    {
+        --i;
+        anChunkStride[i] = nStride;
+        nStride *= m_anBlockSize[i];
+    }
+    const GUInt64 nLastStep =
+        count[nDims - 1] > 1 ? static_cast<GUInt64>(arrayStep[nDims - 1]) : 1;
+    const int nSrcPixelStride = static_cast<int>(nLastStep * nDTSize);
+    const int nDstPixelStride =
+        static_cast<int>(bufferStride[nDims - 1] * nBufferDTSize);
+    std::vector<GUInt64> anKMin(nDims);
+    std::vector<GUInt64> anKMax(nDims);
+    std::vector<GUInt64> anK(nDims);
+
+    bool bRet = true;
+    for (size_t iTask = iBegin; bRet && iTask < iEnd; ++iTask)
+    {
+        const auto &sTask = sRequest.asTasks[iTask];
+        const auto &sLocation = sTask.sLocation;
+        const GByte *pabyChunk;
+        if (sLocation.nAddr == HADDR_UNDEF)
+        {
+            // Chunk not allocated
+            if (abyFillChunk.empty())
+            {
+                abyFillChunk.resize(m_nChunkBytes);
+                for (size_t i = 0; i < m_nChunkBytes; i += nDTSize)
+                    memcpy(&abyFillChunk[i], m_abyFillValue.data(), nDTSize);
+            }
+            pabyChunk = abyFillChunk.data();
+        }
+        else
+        {
+            if (sLocation.nSize > 100 * static_cast<GUInt64>(m_nChunkBytes) +
+                                      1024 * 1024)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Invalid size for chunk of array %s",
+                         GetFullName().c_str());
+                bRet = false;
+                break;
+            }
+            size_t nSize = static_cast<size_t>(sLocation.nSize);
+            abyChunk.resize(nSize);
+            if (VSIFSeekL(fp, static_cast<vsi_l_offset>(sLocation.nAddr),
+                          SEEK_SET) != 0 ||
+                VSIFReadL(abyChunk.data(), 1, nSize, fp) != nSize)
+            {
+                CPLError(CE_Failure, CPLE_FileIO,
+                         "Cannot read chunk of array %s",
+                         GetFullName().c_str());
+                bRet = false;
+                break;
+            }
+
+            // Undo the filters, in the reverse order of the pipeline
+            for (size_t iFilter = m_anFilters.size(); iFilter > 0;)
+            {
+                --iFilter;
+                if ((sLocation.nFilterMask >> iFilter) & 1)
+                    continue;
+                abyTmp.resize(m_nChunkBytes);
+                if (m_anFilters[iFilter] == H5Z_FILTER_DEFLATE)
+                {
+                    void *pOutData = abyTmp.data();
+                    size_t nOutSize = abyTmp.size();
+                    if (!psDecompressor->pfnFunc(
+                            abyChunk.data(), nSize, &pOutData, &nOutSize,
+                            nullptr, psDecompressor->user_data))
+                    {
+                        CPLError(CE_Failure, CPLE_AppDefined,
+                                 "Decompression of chunk of array %s failed",
+                                 GetFullName().c_str());
+                        bRet = false;
+                        break;
+                    }
+                    nSize = nOutSize;
+                }
+                else
+                {
+                    CPLAssert(m_anFilters[iFilter] == H5Z_FILTER_SHUFFLE);
+                    nSize = std::min(nSize, abyTmp.size());
+                    HDF5Unshuffle(abyChunk.data(), abyTmp.data(), nSize,
+                                  nDTSize);
+                }
+                std::swap(abyChunk, abyTmp);
+            }
+            if (!bRet)
+                break;
+            if (nSize != m_nChunkBytes)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Decoded chunk of array %s has not the expected "
+                         "size",
+                         GetFullName().c_str());
+                bRet = false;
+                break;
+            }
+            pabyChunk = abyChunk.data();
+        }
+
+        // Copy the part of the chunk intersecting the request
+        GetChunkIntersection(nDims, arrayStartIdx, count, arrayStep,
+                             m_anBlockSize, sTask.anChunkIdx, anKMin, anKMax);
+        anK = anKMin;
+        const auto nRowCount =
+            static_cast<GPtrDiff_t>(anKMax[nDims - 1] - anKMin[nDims - 1] + 1);
+        while (true)
+        {
+            GUInt64 nSrcOffset = 0;
+            GPtrDiff_t nDstOffset = 0;
+            for (size_t i = 0; i < nDims; ++i)
+            {
+                const GUInt64 nStep =
+                    count[i] > 1 ? static_cast<GUInt64>(arrayStep[i]) : 1;
+                nSrcOffset += (arrayStartIdx[i] + anK[i] * nStep -
+                               sTask.anChunkIdx[i] * m_anBlockSize[i]) *
+                              anChunkStride[i];
+                nDstOffset += static_cast<GPtrDiff_t>(anK[i]) * bufferStride[i];
+            }
+            GDALCopyWords64(pabyChunk + nSrcOffset * nDTSize, eSrcDT,
+                            nSrcPixelStride,
+                            static_cast<GByte *>(sRequest.pDstBuffer) +
+                                nDstOffset * nBufferDTSize,
+                            eDstDT, nDstPixelStride, nRowCount);
+
+            bool bDone = true;
+            for (size_t i = nDims - 1; i > 0;)
+            {
+                --i;
+                if (anK[i] < anKMax[i])
+                {
+                    ++anK[i];
+                    bDone = false;
+                    break;
+                }
+                anK[i] = anKMin[i];
+            }
+            if (bDone)
+                break;
+        }
+    }
+
+    VSIFCloseL(fp);
+    return bRet;
+}
 /************************************************************************/
 /*                           ~HDF5Attribute()                           */
 /************************************************************************/
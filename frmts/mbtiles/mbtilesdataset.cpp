@@ -200,6 +200,11 @@ class MBTilesDataset final : public GDALPamDataset,
                     bool bZoomLevelFromSpatialFilter, bool bJsonField);
 
   protected:
+    virtual CPLErr IRasterIO(GDALRWFlag, int, int, int, int, void *, int, int,
+                             GDALDataType, int, int *, GSpacing, GSpacing,
+                             GSpacing,
+                             GDALRasterIOExtraArg *psExtraArg) override;
+
     // Coming from GDALGPKGMBTilesLikePseudoDataset
 
     virtual CPLErr IFlushCacheWithErrCode(bool bAtClosing) override;
@@ -1020,6 +1025,37 @@ CPLErr MBTilesDataset::IFlushCacheWithErrCode(bool bAtClosing)
     return eErr;
 }
 
+/************************************************************************/
+/*                            IRasterIO()                               */
+/************************************************************************/
+
+CPLErr MBTilesDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
+                                 int nXSize, int nYSize, void *pData,
+                                 int nBufXSize, int nBufYSize,
+                                 GDALDataType eBufType, int nBandCount,
+                                 int *panBandMap, GSpacing nPixelSpace,
+                                 GSpacing nLineSpace, GSpacing nBandSpace,
+                                 GDALRasterIOExtraArg *psExtraArg)
+
+{
+    // When reading at full resolution a window covering several tiles that
+    // are not yet in the block cache, fetch all of them with a single SQL
+    // query rather than one query per tile.
+    const bool bPrefetched =
+        eRWFlag == GF_Read && nBufXSize == nXSize && nBufYSize == nYSize &&
+        PrefetchTilesForRasterIO(nXOff, nYOff, nXSize, nYSize);
+
+    const CPLErr eErr = GDALPamDataset::IRasterIO(
+        eRWFlag, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize, nBufYSize,
+        eBufType, nBandCount, panBandMap, nPixelSpace, nLineSpace, nBandSpace,
+        psExtraArg);
+
+    if (bPrefetched)
+        ClearPrefetchedTiles();
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                         ICanIWriteBlock()                            */
 /************************************************************************/
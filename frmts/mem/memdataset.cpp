@@ -44,13 +44,57 @@
 #include "cpl_minixml.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
+#include "cpl_virtualmem.h"
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_frmts.h"
 
+/************************************************************************/
+/*                           MEMSharedBuffers                           */
+/************************************************************************/
+
+/* Band buffers shared between a dataset and its views. They are freed when */
+/* the last dataset referencing them is destroyed or detaches from them. */
+struct MEMSharedBuffers
+{
+    std::vector<GByte *> m_apabyBuffers{};
+
+    MEMSharedBuffers() = default;
+
+    ~MEMSharedBuffers()
+    {
+        for (GByte *pabyBuffer : m_apabyBuffers)
+            VSIFree(pabyBuffer);
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(MEMSharedBuffers)
+};
+
 struct MEMDataset::Private
 {
     std::shared_ptr<GDALGroup> m_poRootGroup{};
+
+    // Mapping of the temporary file backing the band buffers, when created
+    // with SCRATCH_FILE=YES.
+    CPLVirtualMem *m_psScratchVMem = nullptr;
+
+    Private() = default;
+
+    ~Private()
+    {
+        if (m_psScratchVMem)
+            CPLVirtualMemFree(m_psScratchVMem);
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(Private)
+
+    // Whether all band buffers are allocated by the driver, which is
+    // required to be able to share them with views.
+    bool m_bCanShareData = false;
+
+    // Set when the band buffers are shared with views of this dataset, or
+    // with the dataset this dataset is a view of.
+    std::shared_ptr<MEMSharedBuffers> m_poSharedBuffers{};
 };
 
 /************************************************************************/
@@ -183,6 +227,16 @@ CPLErr MEMRasterBand::IReadBlock(CPL_UNUSED int nBlockXOff, int nBlockYOff,
     return CE_None;
 }
 
+/************************************************************************/
+/*                       CanReadBlockIntoBuffer()                       */
+/************************************************************************/
+
+bool MEMRasterBand::CanReadBlockIntoBuffer() const
+{
+    // IReadBlock() is a mere copy from pabyData
+    return true;
+}
+
 /************************************************************************/
 /*                            IWriteBlock()                             */
 /************************************************************************/
@@ -191,6 +245,10 @@ CPLErr MEMRasterBand::IWriteBlock(CPL_UNUSED int nBlockXOff, int nBlockYOff,
                                   void *pImage)
 {
     CPLAssert(nBlockXOff == 0);
+    if (m_bIsSharedData &&
+        !cpl::down_cast<MEMDataset *>(poDS)->DetachSharedData())
+        return CE_Failure;
+
     const int nWordSize = GDALGetDataTypeSize(eDataType) / 8;
 
     if (nPixelOffset == nWordSize)
@@ -236,6 +294,10 @@ CPLErr MEMRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
     // In case block based I/O has been done before.
     FlushCache(false);
 
+    if (eRWFlag == GF_Write && m_bIsSharedData &&
+        !cpl::down_cast<MEMDataset *>(poDS)->DetachSharedData())
+        return CE_Failure;
+
     if (eRWFlag == GF_Read)
     {
         for (int iLine = 0; iLine < nYSize; iLine++)
@@ -279,6 +341,9 @@ CPLErr MEMDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                              GSpacing nBandSpaceBuf,
                              GDALRasterIOExtraArg *psExtraArg)
 {
+    if (eRWFlag == GF_Write && !DetachSharedData())
+        return CE_Failure;
+
     const int eBufTypeSize = GDALGetDataTypeSize(eBufType) / 8;
 
     // Detect if we have a pixel-interleaved buffer
@@ -668,6 +733,10 @@ void *MEMDataset::GetInternalHandle(const char *pszRequest)
 
             if (RequestedRasterBand != nullptr)
             {
+                // The caller may write through the returned pointer.
+                if (!DetachSharedData())
+                    return nullptr;
+
                 // return the internal band data pointer
                 return RequestedRasterBand->GetData();
             }
@@ -791,6 +860,9 @@ CPLErr MEMDataset::AddBand(GDALDataType eType, char **papszOptions)
     SetBand(nBandId, new MEMRasterBand(this, nBandId, pData, eType,
                                        nPixelOffset, nLineOffset, FALSE));
 
+    // The new band references a buffer we do not manage.
+    m_poPrivate->m_bCanShareData = false;
+
     return CE_None;
 }
 
@@ -803,6 +875,7 @@ void MEMDataset::AddMEMBand(GDALRasterBandH hMEMBand)
     auto poBand = GDALRasterBand::FromHandle(hMEMBand);
     CPLAssert(dynamic_cast<MEMRasterBand *>(poBand) != nullptr);
     SetBand(1 + nBands, poBand);
+    m_poPrivate->m_bCanShareData = false;
 }
 
 /************************************************************************/
@@ -1234,6 +1307,39 @@ GDALDataset *MEMDataset::Open(GDALOpenInfo *poOpenInfo)
     return poDS;
 }
 
+/************************************************************************/
+/*                       MEMCreateScratchMapping()                      */
+/************************************************************************/
+
+/* Map a new temporary file of nSize bytes in memory. The file is removed */
+/* right away, its pages being kept alive by the mapping only, and written */
+/* back to disk by the operating system when it runs short of RAM. */
+static CPLVirtualMem *MEMCreateScratchMapping(size_t nSize)
+{
+    if (!CPLIsVirtualMemFileMapAvailable())
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "SCRATCH_FILE=YES is not supported on this platform");
+        return nullptr;
+    }
+
+    const std::string osFilename = CPLGenerateTempFilename("mem_scratch");
+    VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "wb+");
+    if (fp == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s",
+                 osFilename.c_str());
+        return nullptr;
+    }
+
+    // The file is grown (as a sparse file) to the mapping size.
+    CPLVirtualMem *psVMem = CPLVirtualMemFileMapNew(
+        fp, 0, nSize, VIRTUALMEM_READWRITE, nullptr, nullptr);
+    VSIFCloseL(fp);
+    VSIUnlink(osFilename.c_str());
+    return psVMem;
+}
+
 /************************************************************************/
 /*                               Create()                               */
 /************************************************************************/
@@ -1254,6 +1360,13 @@ MEMDataset *MEMDataset::Create(const char * /* pszFilename */, int nXSize,
     if (pszOption && EQUAL(pszOption, "PIXEL"))
         bPixelInterleaved = true;
 
+    /* -------------------------------------------------------------------- */
+    /*      Should the bands be backed by a memory mapped temporary file,   */
+    /*      for datasets that may not fit in RAM?                           */
+    /* -------------------------------------------------------------------- */
+    const bool bScratchFile =
+        CPLFetchBool(papszOptions, "SCRATCH_FILE", false);
+
     /* -------------------------------------------------------------------- */
     /*      First allocate band data, verifying that we can get enough      */
     /*      memory.                                                         */
@@ -1281,13 +1394,27 @@ MEMDataset *MEMDataset::Create(const char * /* pszFilename */, int nXSize,
 #endif
 
     std::vector<GByte *> apbyBandData;
+    CPLVirtualMem *psScratchVMem = nullptr;
     if (nBandsIn > 0)
     {
-        GByte *pabyData =
-            static_cast<GByte *>(VSI_CALLOC_VERBOSE(1, nGlobalSize));
-        if (!pabyData)
+        GByte *pabyData = nullptr;
+        if (bScratchFile && nGlobalSize > 0)
         {
-            return nullptr;
+            psScratchVMem = MEMCreateScratchMapping(nGlobalSize);
+            if (!psScratchVMem)
+            {
+                return nullptr;
+            }
+            pabyData =
+                static_cast<GByte *>(CPLVirtualMemGetAddr(psScratchVMem));
+        }
+        else
+        {
+            pabyData = static_cast<GByte *>(VSI_CALLOC_VERBOSE(1, nGlobalSize));
+            if (!pabyData)
+            {
+                return nullptr;
+            }
         }
 
         if (bPixelInterleaved)
@@ -1316,6 +1443,9 @@ MEMDataset *MEMDataset::Create(const char * /* pszFilename */, int nXSize,
     poDS->nRasterXSize = nXSize;
     poDS->nRasterYSize = nYSize;
     poDS->eAccess = GA_Update;
+    poDS->m_poPrivate->m_psScratchVMem = psScratchVMem;
+    // Views of mapped buffers are not supported.
+    poDS->m_poPrivate->m_bCanShareData = psScratchVMem == nullptr;
 
     const char *pszPixelType = CSLFetchNameValue(papszOptions, "PIXELTYPE");
     if (pszPixelType && EQUAL(pszPixelType, "SIGNEDBYTE"))
@@ -1330,14 +1460,16 @@ MEMDataset *MEMDataset::Create(const char * /* pszFilename */, int nXSize,
     for (int iBand = 0; iBand < nBandsIn; iBand++)
     {
         MEMRasterBand *poNewBand = nullptr;
+        // The mapping is owned by the dataset.
+        const bool bAssumeOwnership = iBand == 0 && psScratchVMem == nullptr;
 
         if (bPixelInterleaved)
             poNewBand = new MEMRasterBand(
                 poDS, iBand + 1, apbyBandData[iBand], eType,
-                cpl::fits_on<int>(nWordSize * nBandsIn), 0, iBand == 0);
+                cpl::fits_on<int>(nWordSize * nBandsIn), 0, bAssumeOwnership);
         else
             poNewBand = new MEMRasterBand(poDS, iBand + 1, apbyBandData[iBand],
-                                          eType, 0, 0, iBand == 0);
+                                          eType, 0, 0, bAssumeOwnership);
 
         poDS->SetBand(iBand + 1, poNewBand);
     }
@@ -1355,6 +1487,347 @@ GDALDataset *MEMDataset::CreateBase(const char *pszFilename, int nXSize,
     return Create(pszFilename, nXSize, nYSize, nBandsIn, eType, papszOptions);
 }
 
+/************************************************************************/
+/*                       MEMCopyBandProperties()                        */
+/************************************************************************/
+
+static void MEMCopyBandProperties(GDALRasterBand *poSrcBand,
+                                  GDALRasterBand *poDstBand)
+{
+    if (strlen(poSrcBand->GetDescription()) > 0)
+        poDstBand->SetDescription(poSrcBand->GetDescription());
+
+    if (CSLCount(poSrcBand->GetMetadata()) > 0)
+        poDstBand->SetMetadata(poSrcBand->GetMetadata());
+
+    const char *pszPixelType =
+        poSrcBand->GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
+    if (pszPixelType)
+        poDstBand->SetMetadataItem("PIXELTYPE", pszPixelType,
+                                   "IMAGE_STRUCTURE");
+
+    GDALCopyNoDataValue(poDstBand, poSrcBand);
+
+    int bSuccess = FALSE;
+    double dfValue = poSrcBand->GetOffset(&bSuccess);
+    if (bSuccess)
+        poDstBand->SetOffset(dfValue);
+
+    dfValue = poSrcBand->GetScale(&bSuccess);
+    if (bSuccess)
+        poDstBand->SetScale(dfValue);
+
+    const char *pszUnit = poSrcBand->GetUnitType();
+    if (pszUnit && pszUnit[0] != '\0')
+        poDstBand->SetUnitType(pszUnit);
+
+    if (poSrcBand->GetColorInterpretation() != GCI_Undefined)
+        poDstBand->SetColorInterpretation(poSrcBand->GetColorInterpretation());
+
+    if (const GDALColorTable *poCT = poSrcBand->GetColorTable())
+        poDstBand->SetColorTable(const_cast<GDALColorTable *>(poCT));
+
+    if (char **papszCatNames = poSrcBand->GetCategoryNames())
+        poDstBand->SetCategoryNames(papszCatNames);
+
+    if (const GDALRasterAttributeTable *poRAT = poSrcBand->GetDefaultRAT())
+        poDstBand->SetDefaultRAT(poRAT);
+}
+
+/************************************************************************/
+/*                             CreateView()                             */
+/************************************************************************/
+
+/** Create a dataset that is a view of a window and/or subset of bands of
+ * this dataset.
+ *
+ * The pixels of the view are not copied: the view references the buffers
+ * of this dataset, with the same pixel and line strides. Those buffers are
+ * shared until either dataset is modified, at which point the modified
+ * dataset gets its own private copy of the pixels (copy-on-write). The
+ * shared buffers are released when the last dataset referencing them is
+ * destroyed, so the view may outlive this dataset.
+ *
+ * Views can only be created on datasets whose buffers are allocated by
+ * the driver, that is datasets returned by Create(), or views of them.
+ * Datasets created with the DATAPOINTER option are not eligible.
+ *
+ * The geotransform, GCPs and spatial reference are adjusted to the window.
+ * Band properties (nodata, scale/offset, color table, etc.) are copied.
+ *
+ * @param nXOff X offset of the window, in pixels.
+ * @param nYOff Y offset of the window, in lines.
+ * @param nXSize Width of the window.
+ * @param nYSize Height of the window.
+ * @param nBandCount Number of bands of the view.
+ * @param panBandList Indices (1-based) of the bands of this dataset to
+ *                    expose in the view, or nullptr to use the first
+ *                    nBandCount bands.
+ * @return a new dataset, to be destroyed by the caller, or nullptr.
+ * @since GDAL 3.9
+ */
+MEMDataset *MEMDataset::CreateView(int nXOff, int nYOff, int nXSize,
+                                   int nYSize, int nBandCount,
+                                   const int *panBandList)
+{
+    if (!m_poPrivate->m_bCanShareData)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "CreateView() is only supported on datasets whose buffers "
+                 "are allocated on the heap by the MEM driver");
+        return nullptr;
+    }
+    if (nXOff < 0 || nYOff < 0 || nXSize <= 0 || nYSize <= 0 ||
+        nXSize > nRasterXSize - nXOff || nYSize > nRasterYSize - nYOff)
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "Invalid window (%d,%d,%d,%d) for a %dx%d dataset", nXOff,
+                 nYOff, nXSize, nYSize, nRasterXSize, nRasterYSize);
+        return nullptr;
+    }
+    if (nBandCount < 0 || (panBandList == nullptr && nBandCount > nBands))
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg, "Invalid band count: %d",
+                 nBandCount);
+        return nullptr;
+    }
+    for (int i = 0; panBandList && i < nBandCount; ++i)
+    {
+        if (panBandList[i] < 1 || panBandList[i] > nBands)
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg, "Invalid band number: %d",
+                     panBandList[i]);
+            return nullptr;
+        }
+    }
+
+    // Make pending block writes visible in the view. This may detach this
+    // dataset from buffers it already shares with other views.
+    if (FlushCache(false) != CE_None)
+        return nullptr;
+
+    /* -------------------------------------------------------------------- */
+    /*      Hand over the ownership of our buffers to the shared state.     */
+    /* -------------------------------------------------------------------- */
+    auto &poSharedBuffers = m_poPrivate->m_poSharedBuffers;
+    if (!poSharedBuffers)
+        poSharedBuffers = std::make_shared<MEMSharedBuffers>();
+    for (int i = 0; i < nBands; ++i)
+    {
+        MEMRasterBand *poBand = cpl::down_cast<MEMRasterBand *>(papoBands[i]);
+        if (poBand->bOwnData)
+        {
+            poSharedBuffers->m_apabyBuffers.push_back(poBand->pabyData);
+            poBand->bOwnData = false;
+        }
+        poBand->m_bIsSharedData = true;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Create the view.                                                */
+    /* -------------------------------------------------------------------- */
+    MEMDataset *poView = new MEMDataset();
+    poView->nRasterXSize = nXSize;
+    poView->nRasterYSize = nYSize;
+    poView->eAccess = GA_Update;
+    poView->m_poPrivate->m_bCanShareData = true;
+    poView->m_poPrivate->m_poSharedBuffers = poSharedBuffers;
+
+    if (bGeoTransformSet)
+    {
+        double adfViewGeoTransform[6];
+        memcpy(adfViewGeoTransform, adfGeoTransform, sizeof(double) * 6);
+        adfViewGeoTransform[0] +=
+            nXOff * adfGeoTransform[1] + nYOff * adfGeoTransform[2];
+        adfViewGeoTransform[3] +=
+            nXOff * adfGeoTransform[4] + nYOff * adfGeoTransform[5];
+        poView->SetGeoTransform(adfViewGeoTransform);
+    }
+    poView->m_oSRS = m_oSRS;
+
+    if (m_nGCPCount > 0)
+    {
+        poView->m_oGCPSRS = m_oGCPSRS;
+        poView->m_nGCPCount = m_nGCPCount;
+        poView->m_pasGCPs = GDALDuplicateGCPs(m_nGCPCount, m_pasGCPs);
+        for (int i = 0; i < m_nGCPCount; ++i)
+        {
+            poView->m_pasGCPs[i].dfGCPPixel -= nXOff;
+            poView->m_pasGCPs[i].dfGCPLine -= nYOff;
+        }
+    }
+
+    const char *pszPixelType = GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
+    if (pszPixelType)
+        poView->SetMetadataItem("PIXELTYPE", pszPixelType, "IMAGE_STRUCTURE");
+
+    bool bSameBands = nBandCount == nBands;
+    for (int i = 0; i < nBandCount; ++i)
+    {
+        const int nSrcBand = panBandList ? panBandList[i] : i + 1;
+        bSameBands = bSameBands && nSrcBand == i + 1;
+
+        MEMRasterBand *poSrcBand =
+            cpl::down_cast<MEMRasterBand *>(papoBands[nSrcBand - 1]);
+        GByte *pabyViewData = poSrcBand->pabyData +
+                              poSrcBand->nLineOffset * nYOff +
+                              poSrcBand->nPixelOffset * nXOff;
+        MEMRasterBand *poViewBand = new MEMRasterBand(
+            poView, i + 1, pabyViewData, poSrcBand->GetRasterDataType(),
+            poSrcBand->nPixelOffset, poSrcBand->nLineOffset, FALSE);
+        poViewBand->m_bIsSharedData = true;
+        MEMCopyBandProperties(poSrcBand, poViewBand);
+        poView->SetBand(i + 1, poViewBand);
+    }
+
+    // Pixel interleaving is preserved if all bands are exposed in order.
+    const char *pszInterleave =
+        GetMetadataItem("INTERLEAVE", "IMAGE_STRUCTURE");
+    if (pszInterleave && bSameBands)
+        poView->SetMetadataItem("INTERLEAVE", pszInterleave,
+                                "IMAGE_STRUCTURE");
+
+    return poView;
+}
+
+/************************************************************************/
+/*                          DetachSharedData()                          */
+/************************************************************************/
+
+/* Called before modifying pixels: if the band buffers are shared with */
+/* another dataset, copy them in private buffers. */
+bool MEMDataset::DetachSharedData()
+{
+    auto &poSharedBuffers = m_poPrivate->m_poSharedBuffers;
+    if (!poSharedBuffers || poSharedBuffers.use_count() == 1)
+        return true;
+
+    // Allocate all buffers first, so that the dataset is left unchanged if
+    // we run out of memory.
+    std::vector<GByte *> apabyNewData(nBands, nullptr);
+    for (int i = 0; i < nBands; ++i)
+    {
+        MEMRasterBand *poBand = cpl::down_cast<MEMRasterBand *>(papoBands[i]);
+        if (!poBand->m_bIsSharedData)
+            continue;
+        apabyNewData[i] = static_cast<GByte *>(VSI_MALLOC3_VERBOSE(
+            GDALGetDataTypeSizeBytes(poBand->GetRasterDataType()),
+            nRasterXSize, nRasterYSize));
+        if (apabyNewData[i] == nullptr)
+        {
+            for (GByte *pabyData : apabyNewData)
+                VSIFree(pabyData);
+            return false;
+        }
+    }
+
+    for (int i = 0; i < nBands; ++i)
+    {
+        MEMRasterBand *poBand = cpl::down_cast<MEMRasterBand *>(papoBands[i]);
+        if (!poBand->m_bIsSharedData)
+            continue;
+        const GDALDataType eDT = poBand->GetRasterDataType();
+        const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+        const size_t nNewLineOffset =
+            static_cast<size_t>(nDTSize) * nRasterXSize;
+        for (int iLine = 0; iLine < nRasterYSize; ++iLine)
+        {
+            GDALCopyWords(poBand->pabyData +
+                              poBand->nLineOffset * static_cast<size_t>(iLine),
+                          eDT, static_cast<int>(poBand->nPixelOffset),
+                          apabyNewData[i] + nNewLineOffset * iLine, eDT,
+                          nDTSize, nRasterXSize);
+        }
+        poBand->pabyData = apabyNewData[i];
+        poBand->nPixelOffset = nDTSize;
+        poBand->nLineOffset = static_cast<GSpacing>(nNewLineOffset);
+        poBand->bOwnData = true;
+        poBand->m_bIsSharedData = false;
+    }
+
+    // Only release our reference once the copy is done, so that the other
+    // datasets cannot start modifying the buffers in place in the meantime.
+    poSharedBuffers.reset();
+
+    // Bands are now stored in separate buffers.
+    if (GetMetadataItem("INTERLEAVE", "IMAGE_STRUCTURE"))
+        SetMetadataItem("INTERLEAVE", nullptr, "IMAGE_STRUCTURE");
+
+    return true;
+}
+
+/************************************************************************/
+/*                             CreateCopy()                             */
+/************************************************************************/
+
+GDALDataset *MEMDataset::CreateCopy(const char *pszFilename,
+                                    GDALDataset *poSrcDS, int bStrict,
+                                    char **papszOptions,
+                                    GDALProgressFunc pfnProgress,
+                                    void *pProgressData)
+{
+    MEMDataset *poSrcMEMDS = dynamic_cast<MEMDataset *>(poSrcDS);
+
+    // A copy of a MEM dataset, with the same layout, can be a view sharing
+    // the source buffers until either of them is modified.
+    const auto CanCopyAsView = [poSrcMEMDS, papszOptions]()
+    {
+        if (poSrcMEMDS == nullptr ||
+            !poSrcMEMDS->m_poPrivate->m_bCanShareData ||
+            poSrcMEMDS->GetRasterCount() == 0 ||
+            poSrcMEMDS->GetLayerCount() != 0)
+        {
+            return false;
+        }
+        const char *pszSrcInterleave =
+            poSrcMEMDS->GetMetadataItem("INTERLEAVE", "IMAGE_STRUCTURE");
+        for (CSLConstList papszIter = papszOptions; papszIter && *papszIter;
+             ++papszIter)
+        {
+            char *pszKey = nullptr;
+            const char *pszValue = CPLParseNameValue(*papszIter, &pszKey);
+            const bool bCompatible =
+                pszKey && pszValue &&
+                (EQUAL(pszKey, "@INTERLEAVE_ADDED_AUTOMATICALLY") ||
+                 (EQUAL(pszKey, "INTERLEAVE") &&
+                  EQUAL(pszValue,
+                        pszSrcInterleave ? pszSrcInterleave : "BAND")));
+            CPLFree(pszKey);
+            if (!bCompatible)
+                return false;
+        }
+        return true;
+    };
+
+    if (!CanCopyAsView())
+    {
+        GDALDriver *poDriver =
+            GetGDALDriverManager()->GetDriverByName("MEM");
+        return poDriver->DefaultCreateCopy(pszFilename, poSrcDS, bStrict,
+                                           papszOptions, pfnProgress,
+                                           pProgressData);
+    }
+
+    std::unique_ptr<MEMDataset> poDS(poSrcMEMDS->CreateView(
+        0, 0, poSrcMEMDS->GetRasterXSize(), poSrcMEMDS->GetRasterYSize(),
+        poSrcMEMDS->GetRasterCount(), nullptr));
+    if (!poDS)
+        return nullptr;
+
+    GDALDriver::DefaultCopyMetadata(poSrcDS, poDS.get(), papszOptions,
+                                    nullptr);
+    if (GDALDriver::DefaultCopyMasks(poSrcDS, poDS.get(), bStrict) != CE_None)
+        return nullptr;
+
+    if (pfnProgress && !pfnProgress(1.0, "", pProgressData))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return nullptr;
+    }
+
+    return poDS.release();
+}
+
 /************************************************************************/
 /*                        ~MEMAttributeHolder()                         */
 /************************************************************************/
@@ -3162,6 +3635,9 @@ void GDALRegister_MEM()
         "       <Value>BAND</Value>"
         "       <Value>PIXEL</Value>"
         "   </Option>"
+        "   <Option name='SCRATCH_FILE' type='boolean' default='NO' "
+        "description='Whether pixels should be stored in a memory mapped "
+        "temporary file, paged in and out by the operating system'/>"
         "</CreationOptionList>");
 
     // Define GDAL_NO_OPEN_FOR_MEM_DRIVER macro to undefine Open() method for
@@ -3174,6 +3650,7 @@ void GDALRegister_MEM()
     poDriver->pfnIdentify = MEMDatasetIdentify;
 #endif
     poDriver->pfnCreate = MEMDataset::CreateBase;
+    poDriver->pfnCreateCopy = MEMDataset::CreateCopy;
     poDriver->pfnCreateMultiDimensional = MEMDataset::CreateMultiDimensional;
     poDriver->pfnDelete = MEMDatasetDelete;
 
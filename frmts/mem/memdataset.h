@@ -86,6 +86,8 @@ class CPL_DLL MEMDataset CPL_NON_FINAL : public GDALDataset
                                    int nYSize, int nBands, GDALDataType eType,
                                    char **papszParamList);
 
+    bool DetachSharedData();
+
   public:
     MEMDataset();
     virtual ~MEMDataset();
@@ -125,10 +127,18 @@ class CPL_DLL MEMDataset CPL_NON_FINAL : public GDALDataset
 
     void AddMEMBand(GDALRasterBandH hMEMBand);
 
+    MEMDataset *CreateView(int nXOff, int nYOff, int nXSize, int nYSize,
+                           int nBandCount, const int *panBandList);
+
     static GDALDataset *Open(GDALOpenInfo *);
     static MEMDataset *Create(const char *pszFilename, int nXSize, int nYSize,
                               int nBands, GDALDataType eType,
                               char **papszParamList);
+    static GDALDataset *CreateCopy(const char *pszFilename,
+                                   GDALDataset *poSrcDS, int bStrict,
+                                   char **papszOptions,
+                                   GDALProgressFunc pfnProgress,
+                                   void *pProgressData);
     static GDALDataset *
     CreateMultiDimensional(const char *pszFilename,
                            CSLConstList papszRootGroupOptions,
@@ -157,6 +167,10 @@ class CPL_DLL MEMRasterBand CPL_NON_FINAL : public GDALPamRasterBand
 
     bool m_bIsMask = false;
 
+    // Whether pabyData points to a buffer shared with views, or with the
+    // dataset this band is a view of.
+    bool m_bIsSharedData = false;
+
   public:
     MEMRasterBand(GDALDataset *poDS, int nBand, GByte *pabyData,
                   GDALDataType eType, GSpacing nPixelOffset,
@@ -166,6 +180,7 @@ class CPL_DLL MEMRasterBand CPL_NON_FINAL : public GDALPamRasterBand
 
     virtual CPLErr IReadBlock(int, int, void *) override;
     virtual CPLErr IWriteBlock(int, int, void *) override;
+    virtual bool CanReadBlockIntoBuffer() const override;
     virtual CPLErr IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                              int nXSize, int nYSize, void *pData, int nBufXSize,
                              int nBufYSize, GDALDataType eBufType,
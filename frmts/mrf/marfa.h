@@ -63,6 +63,8 @@
 #include "ogr_spatialref.h"
 
 #include <limits>
+#include <map>
+#include <vector>
 // For printing values
 #include <ostream>
 #include <iostream>
@@ -510,6 +512,26 @@ class MRFDataset final : public GDALPamDataset
     CPLErr ReadTileIdx(ILIdx &tinfo, const ILSize &pos, const ILImage &img,
                        const GIntBig bias = 0);
 
+    // Index and data reads can be cached when the files can't change
+    bool CanCacheReads()
+    {
+        return eAccess == GA_ReadOnly && source.empty() && !mp_safe;
+    }
+
+    // Is the data range fully in the read-ahead buffer
+    bool InReadAhead(GIntBig offset, GIntBig size) const
+    {
+        return offset >= readAheadOffset &&
+               offset + size <= readAheadOffset +
+                                    static_cast<GIntBig>(readAhead.size());
+    }
+
+    // Read size bytes of tile data at offset, from the read-ahead buffer if
+    // possible. If readEnd is past the end of the tile, the data file is
+    // read up to readEnd and the excess is kept in the read-ahead buffer
+    bool ReadTileData(void *buff, GIntBig offset, GIntBig size,
+                      GIntBig readEnd);
+
     VSILFILE *IdxFP();
     VSILFILE *DataFP();
     GDALRWFlag IdxMode()
@@ -598,6 +620,12 @@ class MRFDataset final : public GDALPamDataset
     VF dfp;  // Data file handle
     VF ifp;  // Index file handle
 
+    // Chunks of the index file, by file offset, in read-only mode
+    std::map<GIntBig, std::vector<ILIdx>> idxCache;
+    // Consecutive tiles read from the data file in a single request
+    std::vector<char> readAhead;
+    GIntBig readAheadOffset;
+
     // statistical values
     std::vector<double> vNoData, vMin, vMax;
     // Sticky context for zstd compress and decompress
@@ -670,6 +698,9 @@ class MRFRasterBand CPL_NON_FINAL : public GDALPamRasterBand
     // de-interlace a buffer in pixel blocks
     CPLErr ReadInterleavedBlock(int xblk, int yblk, void *buffer);
 
+    // End of the data of the consecutive tiles that can be read with this one
+    GIntBig ReadAheadEnd(int xblk, int yblk, const ILIdx &tinfo);
+
     const char *GetOptionValue(const char *opt, const char *def) const;
     void SetAccess(GDALAccess eA)
     {
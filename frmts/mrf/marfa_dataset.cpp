@@ -84,7 +84,8 @@ MRFDataset::MRFDataset()
       spacing(0), no_errors(0), missing(0), poSrcDS(nullptr), level(-1),
       cds(nullptr), scale(0.0), pbuffer(nullptr), pbsize(0), tile(ILSize()),
       bdirty(0), bGeoTransformValid(TRUE), poColorTable(nullptr), Quality(0),
-      pzscctx(nullptr), pzsdctx(nullptr), read_timer(), write_timer(0)
+      readAheadOffset(0), pzscctx(nullptr), pzsdctx(nullptr), read_timer(),
+      write_timer(0)
 {
     m_oSRS.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
     //                X0   Xx   Xy  Y0    Yx   Yy
@@ -2564,6 +2565,32 @@ CPLErr MRFDataset::ReadTileIdx(ILIdx &tinfo, const ILSize &pos,
         return CE_Failure;
     }
 
+    if (0 == bias && CanCacheReads())
+    {
+        // Read the index in chunks, which is much faster on object storage
+        const GIntBig CHUNKSZ = 32768;
+        const int MAX_CHUNKS = 64;
+        const GIntBig chunkOffset = (offset / CHUNKSZ) * CHUNKSZ;
+        auto it = idxCache.find(chunkOffset);
+        if (it == idxCache.end())
+        {
+            if (idxCache.size() >= MAX_CHUNKS)
+                idxCache.clear();
+            vector<ILIdx> chunk(CHUNKSZ / sizeof(ILIdx));
+            VSIFSeekL(l_ifp, chunkOffset, SEEK_SET);
+            chunk.resize(
+                VSIFReadL(chunk.data(), sizeof(ILIdx), chunk.size(), l_ifp));
+            it = idxCache.emplace(chunkOffset, std::move(chunk)).first;
+        }
+        const size_t i = static_cast<size_t>(
+            (offset - chunkOffset) / static_cast<GIntBig>(sizeof(ILIdx)));
+        if (i >= it->second.size())
+            return CE_Failure;
+        tinfo.offset = net64(it->second[i].offset);
+        tinfo.size = net64(it->second[i].size);
+        return CE_None;
+    }
+
     VSIFSeekL(l_ifp, offset, SEEK_SET);
     if (1 != VSIFReadL(&tinfo, sizeof(ILIdx), 1, l_ifp))
         return CE_Failure;
@@ -2636,4 +2663,39 @@ CPLErr MRFDataset::ReadTileIdx(ILIdx &tinfo, const ILSize &pos,
     return ReadTileIdx(tinfo, pos, img, bias);
 }
 
+bool MRFDataset::ReadTileData(void *buff, GIntBig offset, GIntBig size,
+                              GIntBig readEnd)
+{
+    if (!InReadAhead(offset, size) && readEnd > offset + size)
+    {
+        VSILFILE *l_dfp = DataFP();
+        if (l_dfp == nullptr)
+            return false;
+        readAhead.resize(static_cast<size_t>(readEnd - offset));
+        VSIFSeekL(l_dfp, offset, SEEK_SET);
+        if (1 == VSIFReadL(readAhead.data(), readAhead.size(), 1, l_dfp))
+        {
+            readAheadOffset = offset;
+        }
+        else
+        {  // Try again, only this tile
+            readAhead.clear();
+            readAheadOffset = 0;
+        }
+    }
+
+    if (InReadAhead(offset, size))
+    {
+        memcpy(buff, readAhead.data() + (offset - readAheadOffset),
+               static_cast<size_t>(size));
+        return true;
+    }
+
+    VSILFILE *l_dfp = DataFP();
+    if (l_dfp == nullptr)
+        return false;
+    VSIFSeekL(l_dfp, offset, SEEK_SET);
+    return 1 == VSIFReadL(buff, static_cast<size_t>(size), 1, l_dfp);
+}
+
 NAMESPACE_MRF_END
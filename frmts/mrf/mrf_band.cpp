@@ -57,6 +57,7 @@
 #include "ogr_srs_api.h"
 #include "ogr_spatialref.h"
 
+#include <algorithm>
 #include <vector>
 #include <cassert>
 #include <zlib.h>
@@ -1045,6 +1046,12 @@ CPLErr MRFRasterBand::IReadBlock(int xblk, int yblk, void *buffer)
     if (dfp == nullptr)
         return CE_Failure;
 
+    // Read the following tiles too, if they are stored right after this one
+    GIntBig readEnd = tinfo.offset + tinfo.size;
+    if (poMRFDS->CanCacheReads() &&
+        !poMRFDS->InReadAhead(tinfo.offset, tinfo.size))
+        readEnd = ReadAheadEnd(xblk, yblk, tinfo);
+
     void *data = VSIMalloc(static_cast<size_t>(tinfo.size + PADDING_BYTES));
     if (data == nullptr)
     {
@@ -1055,8 +1062,7 @@ CPLErr MRFRasterBand::IReadBlock(int xblk, int yblk, void *buffer)
     }
 
     // This part is not thread safe, but it is what GDAL expects
-    VSIFSeekL(dfp, tinfo.offset, SEEK_SET);
-    if (1 != VSIFReadL(data, static_cast<size_t>(tinfo.size), 1, dfp))
+    if (!poMRFDS->ReadTileData(data, tinfo.offset, tinfo.size, readEnd))
     {
         CPLFree(data);
         if (poMRFDS->no_errors)
@@ -1209,6 +1215,41 @@ CPLErr MRFRasterBand::IReadBlock(int xblk, int yblk, void *buffer)
     return ReadInterleavedBlock(xblk, yblk, buffer);
 }
 
+/**
+ *\brief Find how far the data file can be read in a single request
+ *
+ * Consecutive tiles of the same row, not yet in the block cache, are read
+ * with the current one if their data immediately follows in the data file.
+ * This avoids one request per tile, which is slow on object storage.
+ *
+ */
+
+GIntBig MRFRasterBand::ReadAheadEnd(int xblk, int yblk, const ILIdx &tinfo)
+{
+    const int MAX_TILES = 64;
+    const GIntBig MAX_BYTES = 8 * 1024 * 1024;
+    GIntBig readEnd = tinfo.offset + tinfo.size;
+    const int xend = std::min(nBlocksPerRow, xblk + MAX_TILES);
+    for (int x = xblk + 1; x < xend; x++)
+    {
+        GDALRasterBlock *poBlock = TryGetLockedBlockRef(x, yblk);
+        if (poBlock != nullptr)
+        {
+            poBlock->DropLock();
+            break;
+        }
+        ILIdx next = {0, 0};
+        ILSize req(x, yblk, 0, (nBand - 1) / img.pagesize.c, m_l);
+        if (CE_None != poMRFDS->ReadTileIdx(next, req, img) ||
+            next.offset != readEnd || next.size <= 0 ||
+            next.size > poMRFDS->pbsize * 2 ||
+            readEnd + next.size - tinfo.offset > MAX_BYTES)
+            break;
+        readEnd += next.size;
+    }
+    return readEnd;
+}
+
 /**
  *\brief Write a block from the provided buffer
  *
@@ -146,6 +146,77 @@ static CPLErr NCDFGetCoordAndBoundVarFullNames(int nCdfId, char ***ppapszVars);
 
 CPLMutex *hNCMutex = nullptr;
 
+/************************************************************************/
+/*                          netCDFCachedOpenInfo                        */
+/************************************************************************/
+
+struct netCDFCachedOpenInfo
+{
+    vsi_l_offset nFileSize = 0;
+    GIntBig nMTime = 0;
+    std::string osOpenOptions{};
+    CPLStringList aosMetadata{};
+    bool bSubDatasetListKnown = false;
+    int nSubDatasets = 0;
+    CPLStringList aosSubDatasets{};
+};
+
+// Keyed by filename. Protected by hNCMutex.
+static lru11::Cache<std::string, std::shared_ptr<netCDFCachedOpenInfo>>
+    goCachedOpenInfo{};
+
+/************************************************************************/
+/*                       netCDFGetCachedOpenInfo()                      */
+/************************************************************************/
+
+// Return the cached result of a previous opening of osFilename, if its size,
+// modification time and the open options are unchanged. Otherwise, return
+// nullptr and set poNewInfoOut to a new entry, to be filled and inserted in
+// goCachedOpenInfo by the caller. Must be called with hNCMutex held.
+static std::shared_ptr<netCDFCachedOpenInfo>
+netCDFGetCachedOpenInfo(const std::string &osFilename,
+                        CSLConstList papszOpenOptions,
+                        std::shared_ptr<netCDFCachedOpenInfo> &poNewInfoOut)
+{
+    poNewInfoOut.reset();
+    VSIStatBufL sStat;
+    if (VSIStatL(osFilename.c_str(), &sStat) != 0)
+        return nullptr;
+
+    std::string osOpenOptions;
+    for (CSLConstList papszIter = papszOpenOptions; papszIter && *papszIter;
+         ++papszIter)
+    {
+        osOpenOptions += *papszIter;
+        osOpenOptions += '\n';
+    }
+
+    std::shared_ptr<netCDFCachedOpenInfo> poInfo;
+    if (goCachedOpenInfo.tryGet(osFilename, poInfo) &&
+        poInfo->nFileSize == static_cast<vsi_l_offset>(sStat.st_size) &&
+        poInfo->nMTime == static_cast<GIntBig>(sStat.st_mtime) &&
+        poInfo->osOpenOptions == osOpenOptions)
+    {
+        return poInfo;
+    }
+
+    poNewInfoOut = std::make_shared<netCDFCachedOpenInfo>();
+    poNewInfoOut->nFileSize = static_cast<vsi_l_offset>(sStat.st_size);
+    poNewInfoOut->nMTime = static_cast<GIntBig>(sStat.st_mtime);
+    poNewInfoOut->osOpenOptions = std::move(osOpenOptions);
+    return nullptr;
+}
+
+/************************************************************************/
+/*                     netCDFInvalidateCachedOpenInfo()                 */
+/************************************************************************/
+
+// Must be called with hNCMutex held.
+static void netCDFInvalidateCachedOpenInfo(const std::string &osFilename)
+{
+    goCachedOpenInfo.remove(osFilename);
+}
+
 // Workaround https://github.com/OSGeo/gdal/issues/6253
 // Having 2 netCDF handles on the same file doesn't work in a multi-threaded
 // way. Apparently having the same handle works better (this is OK since
@@ -2935,6 +3006,9 @@ CPLErr netCDFDataset::Close()
                 eErr = CE_Failure;
         }
 
+        if (GetAccess() == GA_Update)
+            netCDFInvalidateCachedOpenInfo(osFilename);
+
         CSLDestroy(papszMetadata);
         CSLDestroy(papszSubDatasets);
         CSLDestroy(papszCreationOptions);
@@ -3014,7 +3088,14 @@ char **netCDFDataset::GetMetadataDomainList()
 char **netCDFDataset::GetMetadata(const char *pszDomain)
 {
     if (pszDomain != nullptr && STARTS_WITH_CI(pszDomain, "SUBDATASETS"))
+    {
+        if (m_bSubDatasetListPending)
+        {
+            CPLMutexHolderD(&hNCMutex);
+            BuildPendingSubDatasetList();
+        }
         return papszSubDatasets;
+    }
 
     if (pszDomain != nullptr && STARTS_WITH(pszDomain, "json:"))
     {
@@ -7278,6 +7359,36 @@ CPLErr netCDFDataset::ReadAttributes(int cdfidIn, int var)
     return CE_None;
 }
 
+/************************************************************************/
+/*                     BuildPendingSubDatasetList()                     */
+/************************************************************************/
+
+// Build the list of subdatasets, whose creation has been deferred at opening
+// time, or fetch it from the open cache. Must be called with hNCMutex held.
+void netCDFDataset::BuildPendingSubDatasetList()
+{
+    if (!m_bSubDatasetListPending)
+        return;
+    m_bSubDatasetListPending = false;
+
+    if (m_poCachedOpenInfo && m_poCachedOpenInfo->bSubDatasetListKnown)
+    {
+        nSubDatasets = m_poCachedOpenInfo->nSubDatasets;
+        papszSubDatasets =
+            CSLDuplicate(m_poCachedOpenInfo->aosSubDatasets.List());
+        return;
+    }
+
+    CreateSubDatasetList(cdfid);
+
+    if (m_poCachedOpenInfo)
+    {
+        m_poCachedOpenInfo->nSubDatasets = nSubDatasets;
+        m_poCachedOpenInfo->aosSubDatasets = CSLDuplicate(papszSubDatasets);
+        m_poCachedOpenInfo->bSubDatasetListKnown = true;
+    }
+}
+
 /************************************************************************/
 /*                netCDFDataset::CreateSubDatasetList()                 */
 /************************************************************************/
@@ -9184,6 +9295,39 @@ GDALDataset *netCDFDataset::Open(GDALOpenInfo *poOpenInfo)
         }
     }
 
+    // Reuse the result of a previous opening of the same file, as a
+    // subdataset container, in raster mode.
+    std::shared_ptr<netCDFCachedOpenInfo> poNewCachedOpenInfo;
+    if (!bTreatAsSubdataset && poOpenInfo->eAccess == GA_ReadOnly &&
+        (poOpenInfo->nOpenFlags & GDAL_OF_VECTOR) == 0 &&
+        CPLTestBool(CPLGetConfigOption("GDAL_NETCDF_OPEN_CACHE", "NO")))
+    {
+        auto poCachedOpenInfo = netCDFGetCachedOpenInfo(
+            poDS->osFilename, poOpenInfo->papszOpenOptions,
+            poNewCachedOpenInfo);
+        if (poCachedOpenInfo)
+        {
+            CPLDebug("GDAL_netCDF", "Using cached open information for %s",
+                     poDS->osFilename.c_str());
+            poDS->cdfid = cdfid;
+#ifdef ENABLE_UFFD
+            poDS->pCtx = pCtx;
+#endif
+            poDS->eAccess = poOpenInfo->eAccess;
+            poDS->bDefineMode = false;
+            poDS->papszMetadata =
+                CSLDuplicate(poCachedOpenInfo->aosMetadata.List());
+            poDS->m_poCachedOpenInfo = std::move(poCachedOpenInfo);
+            poDS->m_bSubDatasetListPending = true;
+            poDS->GDALPamDataset::SetMetadata(poDS->papszMetadata);
+            CPLReleaseMutex(hNCMutex);  // Release mutex otherwise we'll
+                // deadlock with GDALDataset own mutex.
+            poDS->TryLoadXML();
+            CPLAcquireMutex(hNCMutex, 1000.0);
+            return poDS;
+        }
+    }
+
     // Figure out whether or not the listed dataset has support for simple
     // geometries (CF-1.8)
     poDS->nCFVersion = nccfdriver::getCFVersion(cdfid);
@@ -9314,7 +9458,15 @@ GDALDataset *netCDFDataset::Open(GDALOpenInfo *poOpenInfo)
         }
         else
         {
-            poDS->CreateSubDatasetList(cdfid);
+            // The list of subdatasets is built when first requested
+            poDS->m_bSubDatasetListPending = true;
+            if (poNewCachedOpenInfo)
+            {
+                poNewCachedOpenInfo->aosMetadata =
+                    CSLDuplicate(poDS->papszMetadata);
+                poDS->m_poCachedOpenInfo = poNewCachedOpenInfo;
+                goCachedOpenInfo.insert(poDS->osFilename, poNewCachedOpenInfo);
+            }
             poDS->GDALPamDataset::SetMetadata(poDS->papszMetadata);
             CPLReleaseMutex(hNCMutex);  // Release mutex otherwise we'll
                 // deadlock with GDALDataset own mutex.
@@ -9342,7 +9494,7 @@ GDALDataset *netCDFDataset::Open(GDALOpenInfo *poOpenInfo)
                  "As %d variables were ignored, creating subdataset list "
                  "for reference. Variable #%d [%s] is the main variable",
                  nIgnoredVars, nVarID, osSubdatasetName.c_str());
-        poDS->CreateSubDatasetList(cdfid);
+        poDS->m_bSubDatasetListPending = true;
     }
 
     // Open the NETCDF subdataset NETCDF:"filename":subdataset.
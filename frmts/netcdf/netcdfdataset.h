@@ -716,6 +716,7 @@ class netCDFWriterConfiguration
 
 class netCDFRasterBand;
 class netCDFLayer;
+struct netCDFCachedOpenInfo;
 
 class netCDFDataset final : public GDALPamDataset
 {
@@ -742,8 +743,14 @@ class netCDFDataset final : public GDALPamDataset
     VSILFILE *fpVSIMEM = nullptr;
     int nSubDatasets;
     char **papszSubDatasets;
+    // Whether papszSubDatasets must be built when first requested
+    bool m_bSubDatasetListPending = false;
     char **papszMetadata;
 
+    // Result of the opening of a subdataset container, shared between the
+    // datasets opened on the same file when GDAL_NETCDF_OPEN_CACHE=YES.
+    std::shared_ptr<netCDFCachedOpenInfo> m_poCachedOpenInfo{};
+
     // Used to report metadata found in Sentinel 5
     std::map<std::string, CPLStringList> m_oMapDomainToJSon{};
 
@@ -875,6 +882,7 @@ class netCDFDataset final : public GDALPamDataset
     CPLErr ReadAttributes(int, int);
 
     void CreateSubDatasetList(int nGroupId);
+    void BuildPendingSubDatasetList();
 
     void SetProjectionFromVar(int nGroupId, int nVarId, bool bReadSRSOnly,
                               const char *pszGivenGM, std::string *,
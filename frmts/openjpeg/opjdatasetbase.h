@@ -29,6 +29,9 @@
 
 #include <limits>
 #include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 /* This file is to be used with openjpeg 2.1 or later */
 #ifdef __clang__
@@ -202,13 +205,15 @@ struct OPJCodecWrapper
     }
     explicit OPJCodecWrapper(OPJCodecWrapper *rhs)
         : pCodec(rhs->pCodec), pStream(rhs->pStream), psImage(rhs->psImage),
-          pasBandParams(rhs->pasBandParams), psJP2File(rhs->psJP2File)
+          pasBandParams(rhs->pasBandParams), psJP2File(rhs->psJP2File),
+          bOwnsFile(rhs->bOwnsFile), nDecodeThreads(rhs->nDecodeThreads)
     {
         rhs->pCodec = nullptr;
         rhs->pStream = nullptr;
         rhs->psImage = nullptr;
         rhs->pasBandParams = nullptr;
         rhs->psJP2File = nullptr;
+        rhs->bOwnsFile = false;
     }
     ~OPJCodecWrapper(void)
     {
@@ -228,6 +233,25 @@ struct OPJCodecWrapper
         psJP2File->nBaseOffset = VSIFTellL(fp);
     }
 
+    // Take the whole decoder state of rhs, including its stream.
+    void moveFrom(OPJCodecWrapper *rhs)
+    {
+        free();
+        pCodec = rhs->pCodec;
+        rhs->pCodec = nullptr;
+        pStream = rhs->pStream;
+        rhs->pStream = nullptr;
+        psImage = rhs->psImage;
+        rhs->psImage = nullptr;
+        pasBandParams = rhs->pasBandParams;
+        rhs->pasBandParams = nullptr;
+        psJP2File = rhs->psJP2File;
+        rhs->psJP2File = nullptr;
+        bOwnsFile = rhs->bOwnsFile;
+        rhs->bOwnsFile = false;
+        nDecodeThreads = rhs->nDecodeThreads;
+    }
+
     void transfer(OPJCodecWrapper *rhs)
     {
         pCodec = rhs->pCodec;
@@ -236,6 +260,8 @@ struct OPJCodecWrapper
         rhs->psImage = nullptr;
         psJP2File = rhs->psJP2File;
         rhs->psJP2File = nullptr;
+        bOwnsFile = rhs->bOwnsFile;
+        rhs->bOwnsFile = false;
     }
 
     static int cvtenum(JP2_ENUM enumeration)
@@ -309,6 +335,9 @@ struct OPJCodecWrapper
         ::free(pasBandParams);
         pasBandParams = nullptr;
 
+        if (bOwnsFile && psJP2File)
+            VSIFCloseL(psJP2File->fp_);
+        bOwnsFile = false;
         CPLFree(psJP2File);
         psJP2File = nullptr;
     }
@@ -753,6 +782,12 @@ struct OPJCodecWrapper
     jp2_image *psImage;
     jp2_image_comp_param *pasBandParams;
     JP2File *psJP2File;
+    // Whether psJP2File->fp_ is a file handle dedicated to this decoder,
+    // which makes it reusable from any thread.
+    bool bOwnsFile = false;
+    // Value passed to opj_codec_set_threads(), which cannot be changed once
+    // the header has been read.
+    int nDecodeThreads = 0;
 };
 
 /************************************************************************/
@@ -768,6 +803,11 @@ struct JP2OPJDatasetBase : public JP2DatasetBase
     int *m_pnLastLevel = nullptr;
     bool m_bStrict = true;
 
+    // Idle decoders of a multi-tiled image, whose main header and tile-part
+    // index have already been read, reused across block reads.
+    std::mutex m_oDecoderPoolMutex{};
+    std::vector<std::unique_ptr<OPJCodecWrapper>> m_apoDecoderPool{};
+
     void init(void)
     {
         (void)this;
@@ -778,6 +818,116 @@ struct JP2OPJDatasetBase : public JP2DatasetBase
         (void)this;
     }
 
+    bool openDecoder(VSILFILE *fpIn, OPJCodecWrapper *codec,
+                     int nDecodeThreads, bool bOwnFile)
+    {
+        codec->pCodec = opj_create_decompress(
+            (OPJ_CODEC_FORMAT)OPJCodecWrapper::cvtenum(JP2_CODEC_J2K));
+        if (codec->pCodec == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "opj_create_decompress() failed");
+            return false;
+        }
+
+        opj_set_info_handler(codec->pCodec, JP2OpenJPEG_InfoCallback, nullptr);
+        opj_set_warning_handler(codec->pCodec, JP2OpenJPEG_WarningCallback,
+                                nullptr);
+        opj_set_error_handler(codec->pCodec, JP2OpenJPEG_ErrorCallback,
+                              nullptr);
+
+        opj_dparameters_t parameters;
+        opj_set_default_decoder_parameters(&parameters);
+        if (!opj_setup_decoder(codec->pCodec, &parameters))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "opj_setup_decoder() failed");
+            return false;
+        }
+#if IS_OPENJPEG_OR_LATER(2, 5, 0)
+        if (!m_bStrict)
+        {
+            opj_decoder_set_strict_mode(codec->pCodec, false);
+        }
+#endif
+        if (m_codec && m_codec->psJP2File)
+        {
+            codec->pStream = OPJCodecWrapper::CreateReadStream(
+                m_codec->psJP2File, nCodeStreamLength);
+        }
+        else
+        {
+            // A decoder that is kept for later reads, possibly from another
+            // thread, cannot use the file handle of the caller.
+            VSILFILE *fpOwned =
+                bOwnFile ? VSIFOpenL(m_osFilename.c_str(), "rb") : nullptr;
+            if (fpOwned)
+            {
+                codec->open(fpOwned, nCodeStreamStart);
+                codec->bOwnsFile = true;
+            }
+            else
+            {
+                codec->open(fpIn, nCodeStreamStart);
+            }
+            codec->pStream = OPJCodecWrapper::CreateReadStream(
+                codec->psJP2File, nCodeStreamLength);
+        }
+        if (!codec->pStream)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "OPJCodecWrapper::CreateReadStream() failed");
+            return false;
+        }
+
+        if (getenv("OPJ_NUM_THREADS") == nullptr)
+            opj_codec_set_threads(codec->pCodec, nDecodeThreads);
+        codec->nDecodeThreads = nDecodeThreads;
+
+        if (!opj_read_header(codec->pStream, codec->pCodec, &codec->psImage))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "opj_read_header() failed (psImage=%p)", codec->psImage);
+            // Hopefully the situation is better on openjpeg 2.2 regarding
+            // cleanup
+            // We may leak objects, but the cleanup of openjpeg can cause
+            // double frees sometimes...
+            return false;
+        }
+        return true;
+    }
+
+    // Take an idle decoder of the pool, preferably one set up with the
+    // requested number of threads.
+    void acquireDecoder(OPJCodecWrapper *codec, int nDecodeThreads)
+    {
+        std::lock_guard<std::mutex> oLock(m_oDecoderPoolMutex);
+        for (auto iter = m_apoDecoderPool.begin();
+             iter != m_apoDecoderPool.end(); ++iter)
+        {
+            if ((*iter)->nDecodeThreads == nDecodeThreads)
+            {
+                codec->moveFrom(iter->get());
+                m_apoDecoderPool.erase(iter);
+                return;
+            }
+        }
+    }
+
+    // Return a decoder owning its file handle to the pool, once the data of
+    // the last decoded tile has been released.
+    void releaseDecoder(OPJCodecWrapper *codec)
+    {
+        for (unsigned int i = 0; i < codec->psImage->numcomps; i++)
+        {
+            opj_image_data_free(codec->psImage->comps[i].data);
+            codec->psImage->comps[i].data = nullptr;
+        }
+        std::lock_guard<std::mutex> oLock(m_oDecoderPoolMutex);
+        if (static_cast<int>(m_apoDecoderPool.size()) >= GetNumThreads())
+            m_apoDecoderPool.erase(m_apoDecoderPool.begin());
+        m_apoDecoderPool.emplace_back(std::make_unique<OPJCodecWrapper>(codec));
+    }
+
     CPLErr readBlockInit(VSILFILE *fpIn, OPJCodecWrapper *codec, int nBlockXOff,
                          int nBlockYOff, int nRasterXSize, int nRasterYSize,
                          int nBlockXSize, int nBlockYSize, int nTileNumber)
@@ -811,77 +961,22 @@ struct JP2OPJDatasetBase : public JP2DatasetBase
         }
         *m_pnLastLevel = iLevel;
 
-        if (codec->pCodec == nullptr)
+        // Number of codeblock decoding threads of libopenjp2, so that the
+        // blocks decoded concurrently by PreloadBlocks() use at most
+        // GetNumThreads() threads altogether.
+        const int nDecodeThreads =
+            std::max(1, GetNumThreads() / std::max(1, m_nBlocksToLoad));
+        const bool bReuseDecoder =
+            m_codec == nullptr && !bUseSetDecodeArea &&
+            CPLTestBool(
+                CPLGetConfigOption("USE_OPENJPEG_DECODER_REUSE", "YES"));
+        if (codec->pCodec == nullptr && bReuseDecoder)
+            acquireDecoder(codec, nDecodeThreads);
+
+        if (codec->pCodec == nullptr &&
+            !openDecoder(fpIn, codec, nDecodeThreads, bReuseDecoder))
         {
-            codec->pCodec = opj_create_decompress(
-                (OPJ_CODEC_FORMAT)OPJCodecWrapper::cvtenum(JP2_CODEC_J2K));
-            if (codec->pCodec == nullptr)
-            {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "opj_create_decompress() failed");
-                return CE_Failure;
-            }
-
-            opj_set_info_handler(codec->pCodec, JP2OpenJPEG_InfoCallback,
-                                 nullptr);
-            opj_set_warning_handler(codec->pCodec, JP2OpenJPEG_WarningCallback,
-                                    nullptr);
-            opj_set_error_handler(codec->pCodec, JP2OpenJPEG_ErrorCallback,
-                                  nullptr);
-
-            opj_dparameters_t parameters;
-            opj_set_default_decoder_parameters(&parameters);
-            if (!opj_setup_decoder(codec->pCodec, &parameters))
-            {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "opj_setup_decoder() failed");
-                return CE_Failure;
-            }
-#if IS_OPENJPEG_OR_LATER(2, 5, 0)
-            if (!m_bStrict)
-            {
-                opj_decoder_set_strict_mode(codec->pCodec, false);
-            }
-#endif
-            if (m_codec && m_codec->psJP2File)
-            {
-                codec->pStream = OPJCodecWrapper::CreateReadStream(
-                    m_codec->psJP2File, nCodeStreamLength);
-            }
-            else
-            {
-                codec->open(fpIn, nCodeStreamStart);
-                codec->pStream = OPJCodecWrapper::CreateReadStream(
-                    codec->psJP2File, nCodeStreamLength);
-            }
-            if (!codec->pStream)
-            {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "OPJCodecWrapper::CreateReadStream() failed");
-                return CE_Failure;
-            }
-
-            if (getenv("OPJ_NUM_THREADS") == nullptr)
-            {
-                if (m_nBlocksToLoad <= 1)
-                    opj_codec_set_threads(codec->pCodec, GetNumThreads());
-                else
-                    opj_codec_set_threads(codec->pCodec,
-                                          GetNumThreads() / m_nBlocksToLoad);
-            }
-
-            if (!opj_read_header(codec->pStream, codec->pCodec,
-                                 &codec->psImage))
-            {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "opj_read_header() failed (psImage=%p)",
-                         codec->psImage);
-                // Hopefully the situation is better on openjpeg 2.2 regarding
-                // cleanup
-                // We may leak objects, but the cleanup of openjpeg can cause
-                // double frees sometimes...
-                return CE_Failure;
-            }
+            return CE_Failure;
         }
         if (!opj_set_decoded_resolution_factor(codec->pCodec, iLevel))
         {
@@ -947,6 +1042,49 @@ struct JP2OPJDatasetBase : public JP2DatasetBase
         return CE_None;
     }
 
+    // Decode only the code-blocks covering the (nXOff, nYOff, nXSize, nYSize)
+    // window, expressed in the pixel space of this resolution level.
+    CPLErr readAreaInit(VSILFILE *fpIn, OPJCodecWrapper *codec, int nXOff,
+                        int nYOff, int nXSize, int nYSize, int nRasterXSize,
+                        int nRasterYSize)
+    {
+        if (!openDecoder(fpIn, codec, GetNumThreads(), false))
+            return CE_Failure;
+        if (!opj_set_decoded_resolution_factor(codec->pCodec, iLevel))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "opj_set_decoded_resolution_factor() failed");
+            return CE_Failure;
+        }
+        for (unsigned int iBand = 0; iBand < codec->psImage->numcomps; iBand++)
+        {
+            codec->psImage->comps[iBand].factor = iLevel;
+        }
+        if (!opj_set_decode_area(
+                codec->pCodec, codec->psImage,
+                m_nX0 + static_cast<int>(static_cast<GIntBig>(nXOff) *
+                                         nParentXSize / nRasterXSize),
+                m_nY0 + static_cast<int>(static_cast<GIntBig>(nYOff) *
+                                         nParentYSize / nRasterYSize),
+                m_nX0 + static_cast<int>(
+                            static_cast<GIntBig>(nXOff + nXSize) *
+                            nParentXSize / nRasterXSize),
+                m_nY0 + static_cast<int>(
+                            static_cast<GIntBig>(nYOff + nYSize) *
+                            nParentYSize / nRasterYSize)))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "opj_set_decode_area() failed");
+            return CE_Failure;
+        }
+        if (!opj_decode(codec->pCodec, codec->pStream, codec->psImage))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "opj_decode() failed");
+            return CE_Failure;
+        }
+        return CE_None;
+    }
+
     void cache(CPL_UNUSED JP2OPJDatasetBase *rhs)
     {
         // prevent linter from treating this as potential static method
@@ -965,7 +1103,7 @@ struct JP2OPJDatasetBase : public JP2DatasetBase
             m_codec = new OPJCodecWrapper(codec);
     }
 
-    void cache(CPL_UNUSED OPJCodecWrapper *codec)
+    void cache(CPL_UNUSED OPJCodecWrapper *codec, bool bSuccess = true)
     {
         // prevent linter from treating this as potential static method
         (void)this;
@@ -977,6 +1115,11 @@ struct JP2OPJDatasetBase : public JP2DatasetBase
         {
             codec->transfer(m_codec);
         }
+        else if (bSuccess && codec->bOwnsFile && codec->pCodec &&
+                 codec->psImage)
+        {
+            releaseDecoder(codec);
+        }
         else
         {
             codec->cleanUpDecompress();
@@ -1002,6 +1145,10 @@ struct JP2OPJDatasetBase : public JP2DatasetBase
     {
         // prevent linter from treating this as potential static method
         (void)this;
+        {
+            std::lock_guard<std::mutex> oLock(m_oDecoderPoolMutex);
+            m_apoDecoderPool.clear();
+        }
         if (iLevel == 0)
         {
             if (m_codec)
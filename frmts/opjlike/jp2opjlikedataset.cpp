@@ -174,6 +174,26 @@ CPLErr JP2OPJLikeRasterBand<CODEC, BASE>::IRasterIO(
             return eErr;
     }
 
+    // A small window within a single tile that is not cached yet is decoded
+    // from the code-blocks covering it, instead of decoding and caching the
+    // whole tile.
+    if (!poGDS->bUseSetDecodeArea && !poGDS->bIs420 && nBufXSize == nXSize &&
+        nBufYSize == nYSize &&
+        nXOff / nBlockXSize == (nXOff + nXSize - 1) / nBlockXSize &&
+        nYOff / nBlockYSize == (nYOff + nYSize - 1) / nBlockYSize &&
+        static_cast<GIntBig>(nXSize) * nYSize * 4 <=
+            static_cast<GIntBig>(nBlockXSize) * nBlockYSize &&
+        CPLTestBool(CPLGetConfigOption("USE_OPENJPEG_ROI_DECODING", "YES")))
+    {
+        GDALRasterBlock *poBlock =
+            TryGetLockedBlockRef(nXOff / nBlockXSize, nYOff / nBlockYSize);
+        if (poBlock != nullptr)
+            poBlock->DropLock();
+        else
+            return poGDS->ReadArea(nBand, nXOff, nYOff, nXSize, nYSize, pData,
+                                   eBufType, nPixelSpace, nLineSpace);
+    }
+
     int nRet =
         poGDS->PreloadBlocks(this, nXOff, nYOff, nXSize, nYSize, 0, nullptr);
     if (nRet < 0)
@@ -706,7 +726,60 @@ CPLErr JP2OPJLikeDataset<CODEC, BASE>::ReadBlock(int nBand, VSILFILE *fpIn,
     }
 
 end:
-    this->cache(&localctx);
+    this->cache(&localctx, eErr == CE_None);
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                              ReadArea()                              */
+/************************************************************************/
+
+template <typename CODEC, typename BASE>
+CPLErr JP2OPJLikeDataset<CODEC, BASE>::ReadArea(int nBand, int nXOff,
+                                                int nYOff, int nXSize,
+                                                int nYSize, void *pData,
+                                                GDALDataType eBufType,
+                                                GSpacing nPixelSpace,
+                                                GSpacing nLineSpace)
+{
+    CODEC localctx;
+
+    CPLErr eErr =
+        this->readAreaInit(this->fp_, &localctx, nXOff, nYOff, nXSize, nYSize,
+                           this->nRasterXSize, this->nRasterYSize);
+    if (eErr == CE_None)
+    {
+        auto psComp = localctx.psImage->comps + nBand - 1;
+        if (psComp->data == nullptr || (int)psComp->w < nXSize ||
+            (int)psComp->h < nYSize)
+        {
+            CPLError(CE_Failure, CPLE_AssertionFailed,
+                     "Assertion at line %d of %s failed", __LINE__, __FILE__);
+            eErr = CE_Failure;
+        }
+        else
+        {
+            const int bPromoteTo8Bit =
+                ((JP2OPJLikeRasterBand<CODEC, BASE> *)GetRasterBand(nBand))
+                    ->bPromoteTo8Bit;
+            for (GPtrDiff_t j = 0; j < nYSize; j++)
+            {
+                auto pSrc = psComp->data + j * localctx.stride(psComp);
+                if (bPromoteTo8Bit)
+                {
+                    for (int i = 0; i < nXSize; i++)
+                        pSrc[i] *= 255;
+                }
+                GDALCopyWords64(pSrc, GDT_Int32, 4,
+                                static_cast<GByte *>(pData) + j * nLineSpace,
+                                eBufType, static_cast<int>(nPixelSpace),
+                                nXSize);
+            }
+        }
+    }
+
+    this->cache(&localctx, false);
 
     return eErr;
 }
@@ -187,6 +187,10 @@ class JP2OPJLikeDataset final : public GDALJP2AbstractDataset, public BASE
     CPLErr ReadBlock(int nBand, VSILFILE *fp, int nBlockXOff, int nBlockYOff,
                      void *pImage, int nBandCount, int *panBandMap);
 
+    CPLErr ReadArea(int nBand, int nXOff, int nYOff, int nXSize, int nYSize,
+                    void *pData, GDALDataType eBufType, GSpacing nPixelSpace,
+                    GSpacing nLineSpace);
+
     int PreloadBlocks(JP2OPJLikeRasterBand<CODEC, BASE> *poBand, int nXOff,
                       int nYOff, int nXSize, int nYSize, int nBandCount,
                       int *panBandMap);
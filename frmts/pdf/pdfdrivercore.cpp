@@ -119,6 +119,7 @@ void PDFDriverSetCommonMetadata(GDALDriver *poDriver)
     poDriver->SetMetadataItem(GDAL_DMD_LONGNAME, "Geospatial PDF");
     poDriver->SetMetadataItem(GDAL_DMD_HELPTOPIC, "drivers/raster/pdf.html");
     poDriver->SetMetadataItem(GDAL_DMD_EXTENSION, "pdf");
+    poDriver->SetMetadataItem(GDAL_DMD_SIGNATURES, "25504446");  // %PDF
     poDriver->SetMetadataItem(GDAL_DMD_CREATIONDATATYPES, "Byte");
     poDriver->SetMetadataItem(
         GDAL_DMD_CREATIONFIELDDATATYPES,
@@ -43,14 +43,19 @@
 #include "pngdrivercore.h"
 
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal_frmts.h"
 #include "gdal_pam.h"
+#include "gdal_thread_pool.h"
 #include "png.h"
+#include "zlib.h"
 
 #include <csetjmp>
 
 #include <algorithm>
+#include <cstdlib>
 #include <limits>
+#include <vector>
 
 // Note: Callers must provide blocks in increasing Y order.
 // Disclaimer (E. Rouault): this code is not production ready at all. A lot of
@@ -2169,6 +2174,510 @@ static bool safe_png_write_end(jmp_buf sSetJmpContext, png_structp png_ptr,
     return true;
 }
 
+/************************************************************************/
+/* ==================================================================== */
+/*            Image data encoder used with ENCODER=GDAL                 */
+/* ==================================================================== */
+/************************************************************************/
+
+// Filtered rows are deflated by chunks of that many bytes, which are
+// compressed independently from each other when using several threads.
+constexpr size_t PNG_ENCODE_CHUNK_SIZE = 256 * 1024;
+
+// Images whose filtered data is smaller than that are compressed in a
+// single call to CPLZLibDeflate(), which uses libdeflate when available.
+constexpr size_t PNG_ENCODE_ONE_SHOT_MAX_SIZE = 64 * 1024 * 1024;
+
+// Maximum size of the payload of an IDAT chunk.
+constexpr size_t PNG_IDAT_MAX_SIZE = 1024 * 1024;
+
+/************************************************************************/
+/*                          PNGFilterRow()                              */
+/************************************************************************/
+
+// Write in pabyOut the filter type byte followed by the row filtered with
+// nFilter. pabyPrev is the previous row, or nullptr for the first row.
+static void PNGFilterRow(int nFilter, const GByte *pabyRow,
+                         const GByte *pabyPrev, size_t nRowBytes, int nBPP,
+                         GByte *pabyOut)
+{
+    pabyOut[0] = static_cast<GByte>(nFilter);
+    GByte *pabyDst = pabyOut + 1;
+    const size_t nBPPSize = std::min(static_cast<size_t>(nBPP), nRowBytes);
+    switch (nFilter)
+    {
+        case PNG_FILTER_VALUE_SUB:
+            memcpy(pabyDst, pabyRow, nBPPSize);
+            for (size_t i = nBPPSize; i < nRowBytes; ++i)
+                pabyDst[i] = static_cast<GByte>(pabyRow[i] - pabyRow[i - nBPP]);
+            break;
+
+        case PNG_FILTER_VALUE_UP:
+            if (pabyPrev == nullptr)
+            {
+                memcpy(pabyDst, pabyRow, nRowBytes);
+                break;
+            }
+            for (size_t i = 0; i < nRowBytes; ++i)
+                pabyDst[i] = static_cast<GByte>(pabyRow[i] - pabyPrev[i]);
+            break;
+
+        case PNG_FILTER_VALUE_AVG:
+            for (size_t i = 0; i < nRowBytes; ++i)
+            {
+                const int a = i >= nBPPSize ? pabyRow[i - nBPP] : 0;
+                const int b = pabyPrev ? pabyPrev[i] : 0;
+                pabyDst[i] = static_cast<GByte>(pabyRow[i] - ((a + b) >> 1));
+            }
+            break;
+
+        case PNG_FILTER_VALUE_PAETH:
+            for (size_t i = 0; i < nRowBytes; ++i)
+            {
+                const int a = i >= nBPPSize ? pabyRow[i - nBPP] : 0;
+                const int b = pabyPrev ? pabyPrev[i] : 0;
+                const int c =
+                    (i >= nBPPSize && pabyPrev) ? pabyPrev[i - nBPP] : 0;
+                const int p = a + b - c;
+                const int pa = std::abs(p - a);
+                const int pb = std::abs(p - b);
+                const int pc = std::abs(p - c);
+                const int nPred = (pa <= pb && pa <= pc) ? a
+                                  : (pb <= pc)           ? b
+                                                         : c;
+                pabyDst[i] = static_cast<GByte>(pabyRow[i] - nPred);
+            }
+            break;
+
+        default:
+            memcpy(pabyDst, pabyRow, nRowBytes);
+            break;
+    }
+}
+
+/************************************************************************/
+/*                       PNGFilterRowAdaptive()                         */
+/************************************************************************/
+
+// Select the filter with the minimum sum of absolute differences, which is
+// the heuristics recommended by the PNG specification and used by libpng.
+static void PNGFilterRowAdaptive(const GByte *pabyRow, const GByte *pabyPrev,
+                                 size_t nRowBytes, int nBPP, GByte *pabyOut,
+                                 GByte *pabyScratch)
+{
+    GIntBig nBestCost = std::numeric_limits<GIntBig>::max();
+    for (int nFilter = PNG_FILTER_VALUE_NONE; nFilter <= PNG_FILTER_VALUE_PAETH;
+         ++nFilter)
+    {
+        GByte *pabyCandidate =
+            nFilter == PNG_FILTER_VALUE_NONE ? pabyOut : pabyScratch;
+        PNGFilterRow(nFilter, pabyRow, pabyPrev, nRowBytes, nBPP,
+                     pabyCandidate);
+        GIntBig nCost = 0;
+        for (size_t i = 1; i <= nRowBytes && nCost < nBestCost; ++i)
+            nCost += std::abs(static_cast<int>(
+                static_cast<signed char>(pabyCandidate[i])));
+        if (nCost < nBestCost)
+        {
+            nBestCost = nCost;
+            if (pabyCandidate != pabyOut)
+                memcpy(pabyOut, pabyCandidate, nRowBytes + 1);
+        }
+    }
+}
+
+/************************************************************************/
+/*                          PNGFilterRows()                             */
+/************************************************************************/
+
+static void PNGFilterRows(const GByte *pabyRows, const GByte *pabyPrevRow,
+                          int nRows, size_t nRowBytes, int nBPP,
+                          bool bAdaptiveFilter, GByte *pabyOut,
+                          std::vector<GByte> &abyScratch)
+{
+    if (bAdaptiveFilter)
+        abyScratch.resize(nRowBytes + 1);
+    for (int i = 0; i < nRows; ++i)
+    {
+        const GByte *pabyRow = pabyRows + i * nRowBytes;
+        const GByte *pabyPrev = i == 0 ? pabyPrevRow : pabyRow - nRowBytes;
+        GByte *pabyDst = pabyOut + i * (nRowBytes + 1);
+        if (bAdaptiveFilter)
+            PNGFilterRowAdaptive(pabyRow, pabyPrev, nRowBytes, nBPP, pabyDst,
+                                 abyScratch.data());
+        else
+            PNGFilterRow(PNG_FILTER_VALUE_NONE, pabyRow, pabyPrev, nRowBytes,
+                         nBPP, pabyDst);
+    }
+}
+
+/************************************************************************/
+/*                         PNGDeflateStream                             */
+/************************************************************************/
+
+namespace
+{
+// Raw deflate stream, reset instead of being reallocated between uses.
+struct PNGDeflateStream
+{
+    z_stream sStream{};
+    bool bInit = false;
+    int nLevel = 0;
+    int nStrategy = 0;
+
+    PNGDeflateStream() = default;
+    PNGDeflateStream(const PNGDeflateStream &) = delete;
+    PNGDeflateStream &operator=(const PNGDeflateStream &) = delete;
+
+    ~PNGDeflateStream()
+    {
+        if (bInit)
+            deflateEnd(&sStream);
+    }
+
+    z_stream *Get(int nLevelIn, int nStrategyIn)
+    {
+        if (bInit && (nLevel != nLevelIn || nStrategy != nStrategyIn))
+        {
+            deflateEnd(&sStream);
+            bInit = false;
+        }
+        if (!bInit)
+        {
+            memset(&sStream, 0, sizeof(sStream));
+            if (deflateInit2(&sStream, nLevelIn, Z_DEFLATED, -MAX_WBITS, 8,
+                             nStrategyIn) != Z_OK)
+                return nullptr;
+            bInit = true;
+            nLevel = nLevelIn;
+            nStrategy = nStrategyIn;
+        }
+        else if (deflateReset(&sStream) != Z_OK)
+        {
+            return nullptr;
+        }
+        return &sStream;
+    }
+};
+}  // namespace
+
+/************************************************************************/
+/*                           PNGEncodeJob                               */
+/************************************************************************/
+
+namespace
+{
+struct PNGEncodeJob
+{
+    const GByte *pabyRows = nullptr;
+    const GByte *pabyPrevRow = nullptr;
+    int nRows = 0;
+    size_t nRowBytes = 0;
+    int nBPP = 0;
+    bool bAdaptiveFilter = false;
+    int nLevel = 0;
+    bool bLast = false;
+
+    uLong nAdler = 0;
+    size_t nFilteredSize = 0;
+    std::vector<GByte> abyCompressed{};
+    bool bOK = false;
+};
+}  // namespace
+
+// Filter and deflate a chunk of rows as a part of a zlib stream made of
+// concatenated raw deflate streams ended by a sync flush, as done by pigz.
+static void PNGEncodeChunk(void *pData)
+{
+    PNGEncodeJob *psJob = static_cast<PNGEncodeJob *>(pData);
+#ifdef _WIN32
+    // thread_local C++ objects don't work well with DLLs on Windows
+    PNGDeflateStream oStream;
+    PNGDeflateStream &oTLSStream = oStream;
+    std::vector<GByte> abyFiltered;
+    std::vector<GByte> abyScratch;
+#else
+    static thread_local PNGDeflateStream oTLSStream;
+    static thread_local std::vector<GByte> abyFiltered;
+    static thread_local std::vector<GByte> abyScratch;
+#endif
+
+    psJob->nFilteredSize = psJob->nRows * (psJob->nRowBytes + 1);
+    try
+    {
+        abyFiltered.resize(psJob->nFilteredSize);
+    }
+    catch (const std::exception &)
+    {
+        return;
+    }
+    PNGFilterRows(psJob->pabyRows, psJob->pabyPrevRow, psJob->nRows,
+                  psJob->nRowBytes, psJob->nBPP, psJob->bAdaptiveFilter,
+                  abyFiltered.data(), abyScratch);
+    psJob->nAdler =
+        adler32(adler32(0, nullptr, 0), abyFiltered.data(),
+                static_cast<uInt>(psJob->nFilteredSize));
+
+    z_stream *psStream =
+        oTLSStream.Get(psJob->nLevel, psJob->bAdaptiveFilter
+                                          ? Z_FILTERED
+                                          : Z_DEFAULT_STRATEGY);
+    if (psStream == nullptr)
+        return;
+
+    try
+    {
+        // Room for the sync flush marker and the adler32 trailer.
+        psJob->abyCompressed.resize(
+            deflateBound(psStream, static_cast<uLong>(psJob->nFilteredSize)) +
+            16);
+    }
+    catch (const std::exception &)
+    {
+        return;
+    }
+    psStream->next_in = abyFiltered.data();
+    psStream->avail_in = static_cast<uInt>(psJob->nFilteredSize);
+    psStream->next_out = psJob->abyCompressed.data();
+    psStream->avail_out = static_cast<uInt>(psJob->abyCompressed.size());
+    const int nRet =
+        deflate(psStream, psJob->bLast ? Z_FINISH : Z_SYNC_FLUSH);
+    if (nRet != (psJob->bLast ? Z_STREAM_END : Z_OK) ||
+        psStream->avail_in != 0)
+        return;
+    psJob->abyCompressed.resize(psJob->abyCompressed.size() -
+                                psStream->avail_out);
+    psJob->bOK = true;
+}
+
+/************************************************************************/
+/*                           PNGWriteChunk()                            */
+/************************************************************************/
+
+// Write a PNG chunk whose payload is the concatenation of pabyData1 and
+// pabyData2.
+static bool PNGWriteChunk(VSILFILE *fp, const char *pszType,
+                          const GByte *pabyData1, size_t nSize1,
+                          const GByte *pabyData2 = nullptr, size_t nSize2 = 0)
+{
+    GByte abyHeader[8];
+    const GUInt32 nSize = CPL_MSBWORD32(static_cast<GUInt32>(nSize1 + nSize2));
+    memcpy(abyHeader, &nSize, 4);
+    memcpy(abyHeader + 4, pszType, 4);
+    uLong nCRC = crc32(0, abyHeader + 4, 4);
+    if (nSize1)
+        nCRC = crc32(nCRC, pabyData1, static_cast<uInt>(nSize1));
+    if (nSize2)
+        nCRC = crc32(nCRC, pabyData2, static_cast<uInt>(nSize2));
+    const GUInt32 nCRC32 = CPL_MSBWORD32(static_cast<GUInt32>(nCRC));
+    return VSIFWriteL(abyHeader, 8, 1, fp) == 1 &&
+           (nSize1 == 0 || VSIFWriteL(pabyData1, nSize1, 1, fp) == 1) &&
+           (nSize2 == 0 || VSIFWriteL(pabyData2, nSize2, 1, fp) == 1) &&
+           VSIFWriteL(&nCRC32, 4, 1, fp) == 1;
+}
+
+// Write a part of the zlib stream as one or several IDAT chunks.
+static bool PNGWriteIDAT(VSILFILE *fp, const GByte *pabyData, size_t nSize)
+{
+    for (size_t nOffset = 0; nOffset < nSize; nOffset += PNG_IDAT_MAX_SIZE)
+    {
+        if (!PNGWriteChunk(fp, "IDAT", pabyData + nOffset,
+                           std::min(PNG_IDAT_MAX_SIZE, nSize - nOffset)))
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                        PNGWriteImageData()                           */
+/************************************************************************/
+
+// Write the IDAT and IEND chunks of the image, once the header chunks have
+// been written by libpng.
+static CPLErr PNGWriteImageData(VSILFILE *fp, GDALDataset *poSrcDS,
+                                GDALDataType eType, bool bAdaptiveFilter,
+                                int nLevel, int nThreads,
+                                GDALProgressFunc pfnProgress,
+                                void *pProgressData)
+{
+    const int nXSize = poSrcDS->GetRasterXSize();
+    const int nYSize = poSrcDS->GetRasterYSize();
+    const int nBands = poSrcDS->GetRasterCount();
+    const int nWordSize = GDALGetDataTypeSizeBytes(eType);
+    const int nBPP = nBands * nWordSize;
+    const size_t nRowBytes = static_cast<size_t>(nXSize) * nBPP;
+
+    const auto ReadRows = [=](int nYOff, int nRows, GByte *pabyDst)
+    {
+        if (poSrcDS->RasterIO(GF_Read, 0, nYOff, nXSize, nRows, pabyDst,
+                              nXSize, nRows, eType, nBands, nullptr, nBPP,
+                              static_cast<GSpacing>(nRowBytes), nWordSize,
+                              nullptr) != CE_None)
+            return false;
+#ifdef CPL_LSB
+        if (nWordSize == 2)
+            GDALSwapWords(pabyDst, 2,
+                          static_cast<size_t>(nRows) * nXSize * nBands, 2);
+#endif
+        return true;
+    };
+
+    // Small images: whole image compressed at once.
+    const size_t nFilteredSize = (nRowBytes + 1) * nYSize;
+    if (nThreads <= 1 && nFilteredSize <= PNG_ENCODE_ONE_SHOT_MAX_SIZE)
+    {
+        std::vector<GByte> abyRows, abyFiltered, abyScratch;
+        try
+        {
+            abyRows.resize(nRowBytes * nYSize);
+            abyFiltered.resize(nFilteredSize);
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate image buffer");
+            return CE_Failure;
+        }
+        if (!ReadRows(0, nYSize, abyRows.data()))
+            return CE_Failure;
+        PNGFilterRows(abyRows.data(), nullptr, nYSize, nRowBytes, nBPP,
+                      bAdaptiveFilter, abyFiltered.data(), abyScratch);
+        size_t nCompressedSize = 0;
+        GByte *pabyCompressed = static_cast<GByte *>(
+            CPLZLibDeflate(abyFiltered.data(), nFilteredSize, nLevel, nullptr,
+                           0, &nCompressedSize));
+        if (pabyCompressed == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "Compression failed");
+            return CE_Failure;
+        }
+        const bool bOK = PNGWriteIDAT(fp, pabyCompressed, nCompressedSize) &&
+                         PNGWriteChunk(fp, "IEND", nullptr, 0);
+        VSIFree(pabyCompressed);
+        if (!bOK)
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Write error");
+            return CE_Failure;
+        }
+        if (!pfnProgress(1.0, nullptr, pProgressData))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt,
+                     "User terminated CreateCopy()");
+            return CE_Failure;
+        }
+        return CE_None;
+    }
+
+    // Larger images, or multi-threaded compression: the image is processed
+    // by batches of nThreads chunks of nRowsPerChunk rows.
+    const int nRowsPerChunk = static_cast<int>(std::max<size_t>(
+        1, PNG_ENCODE_CHUNK_SIZE / (nRowBytes + 1)));
+    const int nRowsPerBatch = static_cast<int>(std::min<GIntBig>(
+        nYSize, static_cast<GIntBig>(nRowsPerChunk) * nThreads));
+
+    CPLWorkerThreadPool *poPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue = poPool ? poPool->CreateJobQueue() : nullptr;
+
+    // The first row of the buffer is the last row of the previous batch.
+    std::vector<GByte> abyRows;
+    try
+    {
+        abyRows.resize((static_cast<size_t>(nRowsPerBatch) + 1) * nRowBytes);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "Cannot allocate image buffer");
+        return CE_Failure;
+    }
+
+    // zlib header, with the FLEVEL hint of the compression level.
+    const int nFLevel = nLevel <= 1 ? 0 : nLevel <= 5 ? 1 : nLevel == 6 ? 2 : 3;
+    GByte abyZLibHeader[2] = {0x78, static_cast<GByte>(nFLevel << 6)};
+    abyZLibHeader[1] = static_cast<GByte>(
+        abyZLibHeader[1] +
+        (31 - (abyZLibHeader[0] * 256 + abyZLibHeader[1]) % 31) % 31);
+    bool bHeaderWritten = false;
+    uLong nAdler = adler32(0, nullptr, 0);
+
+    for (int nYOff = 0; nYOff < nYSize; nYOff += nRowsPerBatch)
+    {
+        const int nRows = std::min(nRowsPerBatch, nYSize - nYOff);
+        if (!ReadRows(nYOff, nRows, abyRows.data() + nRowBytes))
+            return CE_Failure;
+
+        std::vector<PNGEncodeJob> asJobs;
+        for (int iRow = 0; iRow < nRows; iRow += nRowsPerChunk)
+        {
+            PNGEncodeJob sJob;
+            sJob.pabyRows = abyRows.data() + (iRow + 1) * nRowBytes;
+            sJob.pabyPrevRow =
+                (nYOff + iRow == 0) ? nullptr : sJob.pabyRows - nRowBytes;
+            sJob.nRows = std::min(nRowsPerChunk, nRows - iRow);
+            sJob.nRowBytes = nRowBytes;
+            sJob.nBPP = nBPP;
+            sJob.bAdaptiveFilter = bAdaptiveFilter;
+            sJob.nLevel = nLevel;
+            sJob.bLast = nYOff + iRow + sJob.nRows == nYSize;
+            asJobs.emplace_back(std::move(sJob));
+        }
+        for (auto &sJob : asJobs)
+        {
+            if (!poJobQueue || !poJobQueue->SubmitJob(PNGEncodeChunk, &sJob))
+                PNGEncodeChunk(&sJob);
+        }
+        if (poJobQueue)
+            poJobQueue->WaitCompletion();
+
+        for (auto &sJob : asJobs)
+        {
+            if (!sJob.bOK)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined, "Compression failed");
+                return CE_Failure;
+            }
+            nAdler = adler32_combine(nAdler, sJob.nAdler,
+                                     static_cast<z_off_t>(sJob.nFilteredSize));
+            if (sJob.bLast)
+            {
+                for (int i = 3; i >= 0; --i)
+                    sJob.abyCompressed.push_back(
+                        static_cast<GByte>((nAdler >> (8 * i)) & 0xff));
+            }
+            const bool bOK =
+                bHeaderWritten
+                    ? PNGWriteIDAT(fp, sJob.abyCompressed.data(),
+                                   sJob.abyCompressed.size())
+                    : PNGWriteChunk(fp, "IDAT", abyZLibHeader, 2,
+                                    sJob.abyCompressed.data(),
+                                    sJob.abyCompressed.size());
+            bHeaderWritten = true;
+            if (!bOK)
+            {
+                CPLError(CE_Failure, CPLE_FileIO, "Write error");
+                return CE_Failure;
+            }
+        }
+
+        memcpy(abyRows.data(), abyRows.data() + nRows * nRowBytes, nRowBytes);
+
+        if (!pfnProgress(static_cast<double>(nYOff + nRows) / nYSize, nullptr,
+                         pProgressData))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt,
+                     "User terminated CreateCopy()");
+            return CE_Failure;
+        }
+    }
+
+    if (!PNGWriteChunk(fp, "IEND", nullptr, 0))
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Write error");
+        return CE_Failure;
+    }
+    return CE_None;
+}
+
 /************************************************************************/
 /*                             CreateCopy()                             */
 /************************************************************************/
@@ -2292,10 +2801,12 @@ GDALDataset *PNGDataset::CreateCopy(const char *pszFilename,
 
     // Do we want to control the compression level?
     const char *pszLevel = CSLFetchNameValue(papszOptions, "ZLEVEL");
+    int nZLevel = 6;
 
     if (pszLevel)
     {
         const int nLevel = atoi(pszLevel);
+        nZLevel = nLevel;
         if (nLevel < 1 || nLevel > 9)
         {
             CPLError(CE_Failure, CPLE_AppDefined,
@@ -2673,57 +3184,94 @@ GDALDataset *PNGDataset::CreateCopy(const char *pszFilename,
         png_set_packing(hPNG);
     }
 
-    // Loop over the image, copying image data.
+    // Use our own filtering and compression of the image data?
+    const char *pszEncoder =
+        CSLFetchNameValueDef(papszOptions, "ENCODER", "LIBPNG");
+    bool bGDALEncoder = EQUAL(pszEncoder, "GDAL");
+    if (!bGDALEncoder && !EQUAL(pszEncoder, "LIBPNG"))
+    {
+        CPLError(CE_Warning, CPLE_NotSupported,
+                 "Unsupported value for ENCODER: %s. Using LIBPNG", pszEncoder);
+    }
+    if (bGDALEncoder && nBitDepth < 8)
+    {
+        CPLDebug("PNG", "ENCODER=GDAL not supported for NBITS=%d. "
+                        "Using libpng encoder",
+                 nBitDepth);
+        bGDALEncoder = false;
+    }
     CPLErr eErr = CE_None;
-    const int nWordSize = GDALGetDataTypeSize(eType) / 8;
+    if (bGDALEncoder)
+    {
+        const char *pszNumThreads = CSLFetchNameValueDef(
+            papszOptions, "NUM_THREADS",
+            CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+        int nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                        : atoi(pszNumThreads);
+        nThreads = std::max(1, std::min(128, nThreads));
+
+        eErr = PNGWriteImageData(fpImage, poSrcDS, eType,
+                                 nColorType != PNG_COLOR_TYPE_PALETTE, nZLevel,
+                                 nThreads, pfnProgress, pProgressData);
+        png_destroy_write_struct(&hPNG, &psPNGInfo);
+        if (VSIFCloseL(fpImage) != 0)
+            eErr = CE_Failure;
+        if (eErr != CE_None)
+            return nullptr;
+    }
+    else
+    {
+        // Loop over the image, copying image data.
+        const int nWordSize = GDALGetDataTypeSize(eType) / 8;
 
-    GByte *pabyScanline = reinterpret_cast<GByte *>(
-        CPLMalloc(cpl::fits_on<int>(nBands * nXSize * nWordSize)));
+        GByte *pabyScanline = reinterpret_cast<GByte *>(
+            CPLMalloc(cpl::fits_on<int>(nBands * nXSize * nWordSize)));
 
-    for (int iLine = 0; iLine < nYSize && eErr == CE_None; iLine++)
-    {
-        png_bytep row = pabyScanline;
+        for (int iLine = 0; iLine < nYSize && eErr == CE_None; iLine++)
+        {
+            png_bytep row = pabyScanline;
 
-        eErr = poSrcDS->RasterIO(
-            GF_Read, 0, iLine, nXSize, 1, pabyScanline, nXSize, 1, eType,
-            nBands, nullptr, static_cast<GSpacing>(nBands) * nWordSize,
-            static_cast<GSpacing>(nBands) * nXSize * nWordSize, nWordSize,
-            nullptr);
+            eErr = poSrcDS->RasterIO(
+                GF_Read, 0, iLine, nXSize, 1, pabyScanline, nXSize, 1, eType,
+                nBands, nullptr, static_cast<GSpacing>(nBands) * nWordSize,
+                static_cast<GSpacing>(nBands) * nXSize * nWordSize, nWordSize,
+                nullptr);
 
 #ifdef CPL_LSB
-        if (nBitDepth == 16)
-            GDALSwapWords(row, 2, nXSize * nBands, 2);
+            if (nBitDepth == 16)
+                GDALSwapWords(row, 2, nXSize * nBands, 2);
 #endif
-        if (eErr == CE_None)
-        {
-            if (!safe_png_write_rows(sSetJmpContext, hPNG, &row, 1))
+            if (eErr == CE_None)
+            {
+                if (!safe_png_write_rows(sSetJmpContext, hPNG, &row, 1))
+                {
+                    eErr = CE_Failure;
+                }
+            }
+
+            if (eErr == CE_None &&
+                !pfnProgress((iLine + 1) / static_cast<double>(nYSize),
+                             nullptr, pProgressData))
             {
                 eErr = CE_Failure;
+                CPLError(CE_Failure, CPLE_UserInterrupt,
+                         "User terminated CreateCopy()");
             }
         }
 
-        if (eErr == CE_None &&
-            !pfnProgress((iLine + 1) / static_cast<double>(nYSize), nullptr,
-                         pProgressData))
+        CPLFree(pabyScanline);
+
+        if (!safe_png_write_end(sSetJmpContext, hPNG, psPNGInfo))
         {
             eErr = CE_Failure;
-            CPLError(CE_Failure, CPLE_UserInterrupt,
-                     "User terminated CreateCopy()");
         }
-    }
+        png_destroy_write_struct(&hPNG, &psPNGInfo);
 
-    CPLFree(pabyScanline);
+        VSIFCloseL(fpImage);
 
-    if (!safe_png_write_end(sSetJmpContext, hPNG, psPNGInfo))
-    {
-        eErr = CE_Failure;
+        if (eErr != CE_None)
+            return nullptr;
     }
-    png_destroy_write_struct(&hPNG, &psPNGInfo);
-
-    VSIFCloseL(fpImage);
-
-    if (eErr != CE_None)
-        return nullptr;
 
     // Do we need a world file?
     if (CPLFetchBool(papszOptions, "WORLDFILE", false))
@@ -59,6 +59,7 @@ void PNGDriverSetCommonMetadata(GDALDriver *poDriver)
     poDriver->SetMetadataItem(GDAL_DMD_LONGNAME, "Portable Network Graphics");
     poDriver->SetMetadataItem(GDAL_DMD_HELPTOPIC, "drivers/raster/png.html");
     poDriver->SetMetadataItem(GDAL_DMD_EXTENSION, "png");
+    poDriver->SetMetadataItem(GDAL_DMD_SIGNATURES, "89504E470D0A1A0A");
     poDriver->SetMetadataItem(GDAL_DMD_MIMETYPE, "image/png");
 
     poDriver->SetMetadataItem(GDAL_DMD_CREATIONDATATYPES, "Byte UInt16");
@@ -92,6 +93,14 @@ void PNGDriverSetCommonMetadata(GDALDriver *poDriver)
         "default='FALSE'/>\n"
         "   <Option name='NBITS' type='int' description='Force output bit "
         "depth: 1, 2 or 4'/>\n"
+        "   <Option name='ENCODER' type='string-select' description='Encoder "
+        "of the image data' default='LIBPNG'>\n"
+        "       <Value>LIBPNG</Value>\n"
+        "       <Value>GDAL</Value>\n"
+        "   </Option>\n"
+        "   <Option name='NUM_THREADS' type='string' description='Number of "
+        "worker threads for compression with ENCODER=GDAL. Can be set to "
+        "ALL_CPUS' default='1'/>\n"
         "</CreationOptionList>\n");
 
     poDriver->SetMetadataItem(GDAL_DCAP_VIRTUALIO, "YES");
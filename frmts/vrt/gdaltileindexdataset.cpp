@@ -30,6 +30,7 @@
 
 #include <array>
 #include <algorithm>
+#include <chrono>
 #include <limits>
 #include <set>
 #include <tuple>
@@ -39,6 +40,7 @@
 #include "cpl_port.h"
 #include "cpl_mem_cache.h"
 #include "cpl_minixml.h"
+#include "cpl_quad_tree.h"
 #include "vrtdataset.h"
 #include "vrt_priv.h"
 #include "ogrsf_frmts.h"
@@ -223,9 +225,36 @@ class GDALTileIndexDataset final : public GDALPamDataset
     //! Note that the dataset objects are ultimately GDALProxyPoolDataset,
     //! and that the GDALProxyPoolDataset limits the number of simultaneously
     //! opened real datasets (controlled by GDAL_MAX_DATASET_POOL_SIZE). Hence 500 is not too big.
+    //! Its size may be changed with the MAX_CACHED_SOURCES open option.
     lru11::Cache<std::string, std::shared_ptr<GDALDataset>> m_oMapSharedSources{
         500};
 
+    //! Maximum number of features of the tile index layer that may be loaded
+    //! in the in-memory index snapshot (INDEX_CACHE_MAX_FEATURES open option).
+    //! 0 disables the snapshot.
+    GIntBig m_nIndexCacheMaxFeatures = 100 * 1000;
+
+    //! Delay in seconds after which the in-memory index snapshot is reloaded,
+    //! or 0 to never reload it (INDEX_CACHE_REFRESH_DELAY open option).
+    double m_dfIndexCacheRefreshDelay = 0;
+
+    //! Whether the in-memory index snapshot has been tentatively built.
+    bool m_bIndexCacheBuilt = false;
+
+    //! Whether the in-memory index snapshot is used. False if it has been
+    //! disabled, or if the tile index layer had too many features.
+    bool m_bIndexCacheActive = false;
+
+    //! Time at which the in-memory index snapshot has been built.
+    std::chrono::steady_clock::time_point m_oIndexCacheTime{};
+
+    //! Features of the in-memory index snapshot.
+    std::vector<std::shared_ptr<OGRFeature>> m_apoIndexCacheFeatures{};
+
+    //! Spatial index of m_apoIndexCacheFeatures[]. The values are indices
+    //! in that array.
+    CPLQuadTree *m_hIndexCacheQuadTree = nullptr;
+
     //! Mask band (e.g. for JPEG compressed + mask band)
     std::unique_ptr<GDALTileIndexBand> m_poMaskBand{};
 
@@ -288,7 +317,7 @@ class GDALTileIndexDataset final : public GDALPamDataset
         std::unique_ptr<VRTSimpleSource> poSource{};
 
         //! OGRFeature corresponding to the source in the tile index.
-        std::unique_ptr<OGRFeature> poFeature{};
+        std::shared_ptr<OGRFeature> poFeature{};
 
         //! Work buffer containing the value of the mask band for the current pixel query.
         std::vector<GByte> abyMask{};
@@ -314,6 +343,12 @@ class GDALTileIndexDataset final : public GDALPamDataset
     //! From a source dataset name, return its SourceDesc description structure.
     bool GetSourceDesc(const std::string &osTileName, SourceDesc &oSourceDesc);
 
+    //! Load the features of the tile index layer, and their extent, in memory.
+    void BuildIndexCache();
+
+    //! Discard the in-memory index snapshot.
+    void ClearIndexCache();
+
     //! Collect sources corresponding to the georeferenced window of interest,
     //! and store them in m_aoSourceDesc[].
     bool CollectSources(double dfXOff, double dfYOff, double dfXSize,
@@ -1839,6 +1874,23 @@ bool GDALTileIndexDataset::Open(GDALOpenInfo *poOpenInfo)
         GDALDataset::SetMetadataItem("INTERLEAVE", "PIXEL", "IMAGE_STRUCTURE");
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Caching of the index and of the sources.                        */
+    /* -------------------------------------------------------------------- */
+    m_nIndexCacheMaxFeatures = std::max<GIntBig>(
+        0, CPLAtoGIntBig(CSLFetchNameValueDef(
+               poOpenInfo->papszOpenOptions, "INDEX_CACHE_MAX_FEATURES",
+               CPLGetConfigOption("GTI_INDEX_CACHE_MAX_FEATURES", "100000"))));
+    m_dfIndexCacheRefreshDelay = std::max(
+        0.0, CPLAtof(CSLFetchNameValueDef(
+                 poOpenInfo->papszOpenOptions, "INDEX_CACHE_REFRESH_DELAY",
+                 CPLGetConfigOption("GTI_INDEX_CACHE_REFRESH_DELAY", "0"))));
+    const int nMaxCachedSources = atoi(CSLFetchNameValueDef(
+        poOpenInfo->papszOpenOptions, "MAX_CACHED_SOURCES",
+        CPLGetConfigOption("GTI_MAX_CACHED_SOURCES", "500")));
+    if (nMaxCachedSources > 0)
+        m_oMapSharedSources.setMaxSize(nMaxCachedSources);
+
     /* -------------------------------------------------------------------- */
     /*      Initialize any PAM information.                                 */
     /* -------------------------------------------------------------------- */
@@ -1866,6 +1918,10 @@ const char *GDALTileIndexDataset::GetMetadataItem(const char *pszName,
         {
             return m_bScannedOneFeatureAtOpening ? "YES" : "NO";
         }
+        else if (EQUAL(pszName, "INDEX_CACHE_ACTIVE"))
+        {
+            return m_bIndexCacheActive ? "YES" : "NO";
+        }
         else if (EQUAL(pszName, "NUMBER_OF_CONTRIBUTING_SOURCES"))
         {
             return CPLSPrintf("%d", static_cast<int>(m_aoSourceDesc.size()));
@@ -2014,6 +2070,7 @@ static GDALDataset *GDALTileIndexDatasetOpen(GDALOpenInfo *poOpenInfo)
 GDALTileIndexDataset::~GDALTileIndexDataset()
 {
     GDALTileIndexDataset::FlushCache(true);
+    ClearIndexCache();
 }
 
 /************************************************************************/
@@ -2147,10 +2204,12 @@ CPLErr GDALTileIndexDataset::FlushCache(bool bAtClosing)
             eErr = CE_Failure;
     }
 
-    // We also clear the cache of opened sources, in case the user would
-    // change the content of a source and would want the GTI dataset to see
-    // the refreshed content.
+    // We also clear the cache of opened sources and the in-memory index
+    // snapshot, in case the user would change the content of a source or
+    // of the index and would want the GTI dataset to see the refreshed
+    // content.
     m_oMapSharedSources.clear();
+    ClearIndexCache();
     m_dfLastMinXFilter = std::numeric_limits<double>::quiet_NaN();
     m_dfLastMinYFilter = std::numeric_limits<double>::quiet_NaN();
     m_dfLastMaxXFilter = std::numeric_limits<double>::quiet_NaN();
@@ -2910,6 +2969,91 @@ bool GDALTileIndexDataset::GetSourceDesc(const std::string &osTileName,
     return true;
 }
 
+/************************************************************************/
+/*                          ClearIndexCache()                           */
+/************************************************************************/
+
+void GDALTileIndexDataset::ClearIndexCache()
+{
+    if (m_hIndexCacheQuadTree)
+    {
+        CPLQuadTreeDestroy(m_hIndexCacheQuadTree);
+        m_hIndexCacheQuadTree = nullptr;
+    }
+    m_apoIndexCacheFeatures.clear();
+    m_bIndexCacheBuilt = false;
+    m_bIndexCacheActive = false;
+}
+
+/************************************************************************/
+/*                          BuildIndexCache()                           */
+/************************************************************************/
+
+void GDALTileIndexDataset::BuildIndexCache()
+{
+    m_bIndexCacheBuilt = true;
+    m_oIndexCacheTime = std::chrono::steady_clock::now();
+    if (m_nIndexCacheMaxFeatures == 0)
+        return;
+
+    // Do not bother reading the whole layer if we know in advance it is
+    // too large
+    if (m_poLayer->TestCapability(OLCFastFeatureCount) &&
+        m_poLayer->GetFeatureCount(/* bForce = */ false) >
+            m_nIndexCacheMaxFeatures)
+    {
+        CPLDebug("VRT", "Tile index has too many features to be cached");
+        return;
+    }
+
+    std::vector<OGREnvelope> asEnvelopes;
+    OGREnvelope sGlobalEnvelope;
+    m_poLayer->SetSpatialFilter(nullptr);
+    m_poLayer->ResetReading();
+    for (auto &&poFeature : m_poLayer)
+    {
+        if (!poFeature->IsFieldSetAndNotNull(m_nLocationFieldIndex))
+            continue;
+        const auto poGeom = poFeature->GetGeometryRef();
+        if (!poGeom || poGeom->IsEmpty())
+            continue;
+        if (static_cast<GIntBig>(m_apoIndexCacheFeatures.size()) ==
+            m_nIndexCacheMaxFeatures)
+        {
+            CPLDebug("VRT", "Tile index has too many features to be cached");
+            m_apoIndexCacheFeatures.clear();
+            return;
+        }
+        OGREnvelope sEnvelope;
+        poGeom->getEnvelope(&sEnvelope);
+        sGlobalEnvelope.Merge(sEnvelope);
+        asEnvelopes.push_back(sEnvelope);
+        m_apoIndexCacheFeatures.emplace_back(poFeature.release());
+    }
+
+    m_bIndexCacheActive = true;
+    if (asEnvelopes.empty())
+        return;
+
+    CPLRectObj sGlobalBounds;
+    sGlobalBounds.minx = sGlobalEnvelope.MinX;
+    sGlobalBounds.miny = sGlobalEnvelope.MinY;
+    sGlobalBounds.maxx = sGlobalEnvelope.MaxX;
+    sGlobalBounds.maxy = sGlobalEnvelope.MaxY;
+    m_hIndexCacheQuadTree = CPLQuadTreeCreate(&sGlobalBounds, nullptr);
+    for (size_t i = 0; i < asEnvelopes.size(); ++i)
+    {
+        CPLRectObj sBounds;
+        sBounds.minx = asEnvelopes[i].MinX;
+        sBounds.miny = asEnvelopes[i].MinY;
+        sBounds.maxx = asEnvelopes[i].MaxX;
+        sBounds.maxy = asEnvelopes[i].MaxY;
+        CPLQuadTreeInsertWithBounds(
+            m_hIndexCacheQuadTree,
+            reinterpret_cast<void *>(static_cast<uintptr_t>(i)), &sBounds);
+    }
+}
+
 /************************************************************************/
 /*                        CollectSources()                              */
 /************************************************************************/
@@ -2924,6 +3068,17 @@ bool GDALTileIndexDataset::CollectSources(double dfXOff, double dfYOff,
         m_adfGeoTransform[GT_TOPLEFT_Y] + dfYOff * m_adfGeoTransform[GT_NS_RES];
     const double dfMinY = dfMaxY + dfYSize * m_adfGeoTransform[GT_NS_RES];
 
+    if (m_bIndexCacheBuilt && m_dfIndexCacheRefreshDelay > 0 &&
+        std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                      m_oIndexCacheTime)
+                .count() >= m_dfIndexCacheRefreshDelay)
+    {
+        CPLDebug("VRT", "Refreshing in-memory snapshot of tile index");
+        ClearIndexCache();
+        m_dfLastMinXFilter = std::numeric_limits<double>::quiet_NaN();
+        m_aoSourceDesc.clear();
+    }
+
     if (dfMinX == m_dfLastMinXFilter && dfMinY == m_dfLastMinYFilter &&
         dfMaxX == m_dfLastMaxXFilter && dfMaxY == m_dfLastMaxYFilter)
     {
@@ -2935,32 +3090,62 @@ bool GDALTileIndexDataset::CollectSources(double dfXOff, double dfYOff,
     m_dfLastMaxXFilter = dfMaxX;
     m_dfLastMaxYFilter = dfMaxY;
 
-    m_poLayer->SetSpatialFilterRect(dfMinX, dfMinY, dfMaxX, dfMaxY);
-    m_poLayer->ResetReading();
+    if (!m_bIndexCacheBuilt)
+        BuildIndexCache();
 
     m_aoSourceDesc.clear();
-    while (true)
+    if (m_bIndexCacheActive)
+    {
+        CPLRectObj sAOI;
+        sAOI.minx = dfMinX;
+        sAOI.miny = dfMinY;
+        sAOI.maxx = dfMaxX;
+        sAOI.maxy = dfMaxY;
+        int nFeatureCount = 0;
+        void **pahRet =
+            m_hIndexCacheQuadTree
+                ? CPLQuadTreeSearch(m_hIndexCacheQuadTree, &sAOI,
+                                    &nFeatureCount)
+                : nullptr;
+        m_aoSourceDesc.reserve(nFeatureCount);
+        for (int i = 0; i < nFeatureCount; ++i)
+        {
+            const auto iFeature =
+                static_cast<size_t>(reinterpret_cast<uintptr_t>(pahRet[i]));
+            SourceDesc oSourceDesc;
+            oSourceDesc.poFeature = m_apoIndexCacheFeatures[iFeature];
+            m_aoSourceDesc.emplace_back(std::move(oSourceDesc));
+        }
+        CPLFree(pahRet);
+    }
+    else
     {
-        auto poFeature =
-            std::unique_ptr<OGRFeature>(m_poLayer->GetNextFeature());
-        if (!poFeature)
-            break;
-        if (!poFeature->IsFieldSetAndNotNull(m_nLocationFieldIndex))
+        m_poLayer->SetSpatialFilterRect(dfMinX, dfMinY, dfMaxX, dfMaxY);
+        m_poLayer->ResetReading();
+
+        while (true)
         {
-            continue;
-        }
+            auto poFeature =
+                std::unique_ptr<OGRFeature>(m_poLayer->GetNextFeature());
+            if (!poFeature)
+                break;
+            if (!poFeature->IsFieldSetAndNotNull(m_nLocationFieldIndex))
+            {
+                continue;
+            }
 
-        SourceDesc oSourceDesc;
-        oSourceDesc.poFeature = std::move(poFeature);
-        m_aoSourceDesc.emplace_back(std::move(oSourceDesc));
+            SourceDesc oSourceDesc;
+            oSourceDesc.poFeature = std::move(poFeature);
+            m_aoSourceDesc.emplace_back(std::move(oSourceDesc));
 
-        if (m_aoSourceDesc.size() > 10 * 1000 * 1000)
-        {
-            // Safety belt...
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "More than 10 million contributing sources to a "
-                     "single RasterIO() request is not supported");
-            return false;
+            if (m_aoSourceDesc.size() > 10 * 1000 * 1000)
+            {
+                // Safety belt...
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "More than 10 million contributing sources to a "
+                         "single RasterIO() request is not supported");
+                return false;
+            }
         }
     }
 
@@ -3769,6 +3954,12 @@ void GDALRegister_GTI()
                               "  <Option name='MINY' type='float'/>"
                               "  <Option name='MAXX' type='float'/>"
                               "  <Option name='MAXY' type='float'/>"
+                              "  <Option name='INDEX_CACHE_MAX_FEATURES' "
+                              "type='int' default='100000'/>"
+                              "  <Option name='INDEX_CACHE_REFRESH_DELAY' "
+                              "type='float' default='0'/>"
+                              "  <Option name='MAX_CACHED_SOURCES' type='int' "
+                              "default='500'/>"
                               "</OpenOptionList>");
 
     GetGDALDriverManager()->RegisterDriver(poDriver.release());
@@ -27,11 +27,20 @@
  * DEALINGS IN THE SOFTWARE.
  *****************************************************************************/
 
+#include <cctype>
 #include <cmath>
+#include <cstring>
 #include "gdal.h"
 #include "vrtdataset.h"
 
+#include <algorithm>
 #include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 template <typename T>
 inline double GetSrcVal(const void *pSource, GDALDataType eSrcType, T ii)
@@ -77,6 +86,64 @@ inline double GetSrcVal(const void *pSource, GDALDataType eSrcType, T ii)
     return 0;
 }
 
+// Call oFunc with a null pointer to the C type of a real data type, so that
+// it can be instantiated for each of them.
+template <class Func>
+static void DispatchOnRealType(GDALDataType eType, Func &&oFunc)
+{
+    switch (eType)
+    {
+        case GDT_Byte:
+            oFunc(static_cast<const GByte *>(nullptr));
+            break;
+        case GDT_Int8:
+            oFunc(static_cast<const GInt8 *>(nullptr));
+            break;
+        case GDT_UInt16:
+            oFunc(static_cast<const GUInt16 *>(nullptr));
+            break;
+        case GDT_Int16:
+            oFunc(static_cast<const GInt16 *>(nullptr));
+            break;
+        case GDT_UInt32:
+            oFunc(static_cast<const GUInt32 *>(nullptr));
+            break;
+        case GDT_Int32:
+            oFunc(static_cast<const GInt32 *>(nullptr));
+            break;
+        case GDT_UInt64:
+            oFunc(static_cast<const uint64_t *>(nullptr));
+            break;
+        case GDT_Int64:
+            oFunc(static_cast<const int64_t *>(nullptr));
+            break;
+        case GDT_Float32:
+            oFunc(static_cast<const float *>(nullptr));
+            break;
+        case GDT_Float64:
+            oFunc(static_cast<const double *>(nullptr));
+            break;
+        default:
+            CPLAssert(false);
+            break;
+    }
+}
+
+#define SRC_TYPE_OF(pTypeTag)                                                  \
+    typename std::remove_const<                                                \
+        typename std::remove_pointer<decltype(pTypeTag)>::type>::type
+
+// Convert a line of values to the output buffer
+static void WriteLine(const double *padfLine, void *pData, int iLine,
+                      int nXSize, GDALDataType eBufType, int nPixelSpace,
+                      int nLineSpace)
+{
+    GDALCopyWords(padfLine, GDT_Float64, sizeof(double),
+                  static_cast<GByte *>(pData) +
+                      static_cast<GSpacing>(nLineSpace) * iLine,
+                  eBufType, nPixelSpace, nXSize);
+}
+
 static CPLErr FetchDoubleArg(CSLConstList papszArgs, const char *pszName,
                              double *pdfX, double *pdfDefault = nullptr)
 {
@@ -489,7 +556,7 @@ static CPLErr ConjPixelFunc(void **papoSources, int nSources, void *pData,
 }  // ConjPixelFunc
 
 static const char pszSumPixelFuncMetadata[] =
-    "<PixelFunctionArgumentsList>"
+    "<PixelFunctionArgumentsList supportsNativeSourceTypes='true'>"
     "   <Argument name='k' description='Optional constant term' type='double' "
     "default='0.0' />"
     "</PixelFunctionArgumentsList>";
@@ -543,27 +610,29 @@ static CPLErr SumPixelFunc(void **papoSources, int nSources, void *pData,
     else
     {
         /* ---- Set pixels ---- */
-        size_t ii = 0;
-        for (int iLine = 0; iLine < nYSize; ++iLine)
-        {
-            for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
+        std::vector<double> adfLine(nXSize);
+        DispatchOnRealType(
+            eSrcType,
+            [&](auto pTypeTag)
             {
-                double dfSum = dfK;  // Not complex.
-
-                for (int iSrc = 0; iSrc < nSources; ++iSrc)
+                using T = SRC_TYPE_OF(pTypeTag);
+                for (int iLine = 0; iLine < nYSize; ++iLine)
                 {
-                    // Source raster pixels may be obtained with GetSrcVal
-                    // macro.
-                    dfSum += GetSrcVal(papoSources[iSrc], eSrcType, ii);
+                    const size_t nLineOffset =
+                        static_cast<size_t>(iLine) * nXSize;
+                    std::fill(adfLine.begin(), adfLine.end(), dfK);
+                    for (int iSrc = 0; iSrc < nSources; ++iSrc)
+                    {
+                        const T *pSrc =
+                            static_cast<const T *>(papoSources[iSrc]) +
+                            nLineOffset;
+                        for (int iCol = 0; iCol < nXSize; ++iCol)
+                            adfLine[iCol] += static_cast<double>(pSrc[iCol]);
+                    }
+                    WriteLine(adfLine.data(), pData, iLine, nXSize, eBufType,
+                              nPixelSpace, nLineSpace);
                 }
-
-                GDALCopyWords(&dfSum, GDT_Float64, 0,
-                              static_cast<GByte *>(pData) +
-                                  static_cast<GSpacing>(nLineSpace) * iLine +
-                                  iCol * nPixelSpace,
-                              eBufType, nPixelSpace, 1);
-            }
-        }
+            });
     }
 
     /* ---- Return success ---- */
@@ -637,7 +706,7 @@ static CPLErr DiffPixelFunc(void **papoSources, int nSources, void *pData,
 }  // DiffPixelFunc
 
 static const char pszMulPixelFuncMetadata[] =
-    "<PixelFunctionArgumentsList>"
+    "<PixelFunctionArgumentsList supportsNativeSourceTypes='true'>"
     "   <Argument name='k' description='Optional constant factor' "
     "type='double' default='1.0' />"
     "</PixelFunctionArgumentsList>";
@@ -697,27 +766,29 @@ static CPLErr MulPixelFunc(void **papoSources, int nSources, void *pData,
     else
     {
         /* ---- Set pixels ---- */
-        size_t ii = 0;
-        for (int iLine = 0; iLine < nYSize; ++iLine)
-        {
-            for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
+        std::vector<double> adfLine(nXSize);
+        DispatchOnRealType(
+            eSrcType,
+            [&](auto pTypeTag)
             {
-                double dfPixVal = dfK;  // Not complex.
-
-                for (int iSrc = 0; iSrc < nSources; ++iSrc)
+                using T = SRC_TYPE_OF(pTypeTag);
+                for (int iLine = 0; iLine < nYSize; ++iLine)
                 {
-                    // Source raster pixels may be obtained with GetSrcVal
-                    // macro.
-                    dfPixVal *= GetSrcVal(papoSources[iSrc], eSrcType, ii);
+                    const size_t nLineOffset =
+                        static_cast<size_t>(iLine) * nXSize;
+                    std::fill(adfLine.begin(), adfLine.end(), dfK);
+                    for (int iSrc = 0; iSrc < nSources; ++iSrc)
+                    {
+                        const T *pSrc =
+                            static_cast<const T *>(papoSources[iSrc]) +
+                            nLineOffset;
+                        for (int iCol = 0; iCol < nXSize; ++iCol)
+                            adfLine[iCol] *= static_cast<double>(pSrc[iCol]);
+                    }
+                    WriteLine(adfLine.data(), pData, iLine, nXSize, eBufType,
+                              nPixelSpace, nLineSpace);
                 }
-
-                GDALCopyWords(&dfPixVal, GDT_Float64, 0,
-                              static_cast<GByte *>(pData) +
-                                  static_cast<GSpacing>(nLineSpace) * iLine +
-                                  iCol * nPixelSpace,
-                              eBufType, nPixelSpace, 1);
-            }
-        }
+            });
     }
 
     /* ---- Return success ---- */
@@ -1366,7 +1437,7 @@ CPLErr InterpolatePixelFunc(void **papoSources, int nSources, void *pData,
 }
 
 static const char pszReplaceNoDataPixelFuncMetadata[] =
-    "<PixelFunctionArgumentsList>"
+    "<PixelFunctionArgumentsList supportsNativeSourceTypes='true'>"
     "   <Argument type='builtin' value='NoData' />"
     "   <Argument name='to' type='double' description='New NoData value to be "
     "replaced' default='nan' />"
@@ -1402,29 +1473,35 @@ static CPLErr ReplaceNoDataPixelFunc(void **papoSources, int nSources,
     }
 
     /* ---- Set pixels ---- */
-    size_t ii = 0;
-    for (int iLine = 0; iLine < nYSize; ++iLine)
-    {
-        for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
+    std::vector<double> adfLine(nXSize);
+    DispatchOnRealType(
+        eSrcType,
+        [&](auto pTypeTag)
         {
-            double dfPixVal = GetSrcVal(papoSources[0], eSrcType, ii);
-            if (dfPixVal == dfOldNoData || std::isnan(dfPixVal))
-                dfPixVal = dfNewNoData;
-
-            GDALCopyWords(&dfPixVal, GDT_Float64, 0,
-                          static_cast<GByte *>(pData) +
-                              static_cast<GSpacing>(nLineSpace) * iLine +
-                              iCol * nPixelSpace,
-                          eBufType, nPixelSpace, 1);
-        }
-    }
+            using T = SRC_TYPE_OF(pTypeTag);
+            for (int iLine = 0; iLine < nYSize; ++iLine)
+            {
+                const T *pSrc = static_cast<const T *>(papoSources[0]) +
+                                static_cast<size_t>(iLine) * nXSize;
+                for (int iCol = 0; iCol < nXSize; ++iCol)
+                {
+                    const double dfPixVal = static_cast<double>(pSrc[iCol]);
+                    adfLine[iCol] =
+                        dfPixVal == dfOldNoData || std::isnan(dfPixVal)
+                            ? dfNewNoData
+                            : dfPixVal;
+                }
+                WriteLine(adfLine.data(), pData, iLine, nXSize, eBufType,
+                          nPixelSpace, nLineSpace);
+            }
+        });
 
     /* ---- Return success ---- */
     return CE_None;
 }
 
 static const char pszScalePixelFuncMetadata[] =
-    "<PixelFunctionArgumentsList>"
+    "<PixelFunctionArgumentsList supportsNativeSourceTypes='true'>"
     "   <Argument type='builtin' value='offset' />"
     "   <Argument type='builtin' value='scale' />"
     "</PixelFunctionArgumentsList>";
@@ -1451,21 +1528,25 @@ static CPLErr ScalePixelFunc(void **papoSources, int nSources, void *pData,
         return CE_Failure;
 
     /* ---- Set pixels ---- */
-    size_t ii = 0;
-    for (int iLine = 0; iLine < nYSize; ++iLine)
-    {
-        for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
+    std::vector<double> adfLine(nXSize);
+    DispatchOnRealType(
+        eSrcType,
+        [&](auto pTypeTag)
         {
-            const double dfPixVal =
-                GetSrcVal(papoSources[0], eSrcType, ii) * dfScale + dfOffset;
-
-            GDALCopyWords(&dfPixVal, GDT_Float64, 0,
-                          static_cast<GByte *>(pData) +
-                              static_cast<GSpacing>(nLineSpace) * iLine +
-                              iCol * nPixelSpace,
-                          eBufType, nPixelSpace, 1);
-        }
-    }
+            using T = SRC_TYPE_OF(pTypeTag);
+            for (int iLine = 0; iLine < nYSize; ++iLine)
+            {
+                const T *pSrc = static_cast<const T *>(papoSources[0]) +
+                                static_cast<size_t>(iLine) * nXSize;
+                for (int iCol = 0; iCol < nXSize; ++iCol)
+                {
+                    adfLine[iCol] =
+                        static_cast<double>(pSrc[iCol]) * dfScale + dfOffset;
+                }
+                WriteLine(adfLine.data(), pData, iLine, nXSize, eBufType,
+                          nPixelSpace, nLineSpace);
+            }
+        });
 
     /* ---- Return success ---- */
     return CE_None;
@@ -1519,7 +1600,7 @@ static CPLErr NormDiffPixelFunc(void **papoSources, int nSources, void *pData,
 /************************************************************************/
 
 static const char pszMinMaxFuncMetadataNodata[] =
-    "<PixelFunctionArgumentsList>"
+    "<PixelFunctionArgumentsList supportsNativeSourceTypes='true'>"
     "   <Argument type='builtin' value='NoData' optional='true' />"
     "   <Argument name='propagateNoData' description='Whether the output value "
     "should be NoData as as soon as one source is NoData' type='boolean' "
@@ -1550,43 +1631,49 @@ static CPLErr MinOrMaxPixelFunc(void **papoSources, int nSources, void *pData,
         CSLFetchNameValueDef(papszArgs, "propagateNoData", "false"));
 
     /* ---- Set pixels ---- */
-    size_t ii = 0;
-    for (int iLine = 0; iLine < nYSize; ++iLine)
-    {
-        for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
+    std::vector<double> adfLine(nXSize);
+    DispatchOnRealType(
+        eSrcType,
+        [&](auto pTypeTag)
         {
-            double dfRes = std::numeric_limits<double>::quiet_NaN();
-
-            for (int iSrc = 0; iSrc < nSources; ++iSrc)
+            using T = SRC_TYPE_OF(pTypeTag);
+            size_t ii = 0;
+            for (int iLine = 0; iLine < nYSize; ++iLine)
             {
-                const double dfVal = GetSrcVal(papoSources[iSrc], eSrcType, ii);
-
-                if (std::isnan(dfVal) || dfVal == dfNoData)
+                for (int iCol = 0; iCol < nXSize; ++iCol, ++ii)
                 {
-                    if (bPropagateNoData)
+                    double dfRes = std::numeric_limits<double>::quiet_NaN();
+
+                    for (int iSrc = 0; iSrc < nSources; ++iSrc)
+                    {
+                        const double dfVal = static_cast<double>(
+                            static_cast<const T *>(papoSources[iSrc])[ii]);
+
+                        if (std::isnan(dfVal) || dfVal == dfNoData)
+                        {
+                            if (bPropagateNoData)
+                            {
+                                dfRes = dfNoData;
+                                break;
+                            }
+                        }
+                        else if (Comparator::compare(dfVal, dfRes))
+                        {
+                            dfRes = dfVal;
+                        }
+                    }
+
+                    if (!bPropagateNoData && std::isnan(dfRes))
                     {
                         dfRes = dfNoData;
-                        break;
                     }
-                }
-                else if (Comparator::compare(dfVal, dfRes))
-                {
-                    dfRes = dfVal;
-                }
-            }
 
-            if (!bPropagateNoData && std::isnan(dfRes))
-            {
-                dfRes = dfNoData;
+                    adfLine[iCol] = dfRes;
+                }
+                WriteLine(adfLine.data(), pData, iLine, nXSize, eBufType,
+                          nPixelSpace, nLineSpace);
             }
-
-            GDALCopyWords(&dfRes, GDT_Float64, 0,
-                          static_cast<GByte *>(pData) +
-                              static_cast<GSpacing>(nLineSpace) * iLine +
-                              iCol * nPixelSpace,
-                          eBufType, nPixelSpace, 1);
-        }
-    }
+        });
 
     /* ---- Return success ---- */
     return CE_None;
@@ -1628,6 +1715,783 @@ static CPLErr MaxPixelFunc(void **papoSources, int nSources, void *pData,
                                          nPixelSpace, nLineSpace, papszArgs);
 }
 
+/************************************************************************/
+/*                          PixelExpression                             */
+/************************************************************************/
+
+namespace
+{
+
+// Compiled form of the expression of the "expression" pixel function.
+// It is a program for a stack machine whose values are runs of pixels, so
+// that each instruction boils down to a simple loop over contiguous doubles,
+// that compilers can vectorize.
+class PixelExpression
+{
+  public:
+    enum class Op
+    {
+        PUSH_CONST,
+        PUSH_SOURCE,
+        NEG,
+        NOT,
+        ABS,
+        SQRT,
+        EXP,
+        LOG,
+        LOG10,
+        SIN,
+        COS,
+        TAN,
+        ASIN,
+        ACOS,
+        ATAN,
+        FLOOR,
+        CEIL,
+        ROUND,
+        ISNAN,
+        ADD,
+        SUB,
+        MUL,
+        DIV,
+        MOD,
+        POW,
+        ATAN2,
+        MIN,
+        MAX,
+        LT,
+        LE,
+        GT,
+        GE,
+        EQ,
+        NE,
+        AND,
+        OR,
+        SELECT,
+    };
+
+    // Number of pixels processed at once by Evaluate()
+    static constexpr size_t CHUNK_SIZE = 1024;
+
+    static std::unique_ptr<PixelExpression> Compile(const char *pszExpression,
+                                                    double dfNoData);
+
+    int GetMaxSourceIndex() const
+    {
+        return m_nMaxSourceIndex;
+    }
+
+    int GetMaxStackDepth() const
+    {
+        return m_nMaxStackDepth;
+    }
+
+    bool UsesSource(int iSource) const
+    {
+        return iSource < static_cast<int>(m_abUsedSources.size()) &&
+               m_abUsedSources[iSource];
+    }
+
+    const double *Evaluate(const double *const *papadfSources, size_t nCount,
+                           double *padfStack) const;
+
+  private:
+    struct Instr
+    {
+        Op eOp;
+        int nSource;
+        double dfValue;
+    };
+
+    std::vector<Instr> m_aoInstrs{};
+    std::vector<bool> m_abUsedSources{};
+    int m_nMaxSourceIndex = -1;
+    int m_nMaxStackDepth = 0;
+    int m_nStackDepth = 0;
+
+    // Parser state
+    const char *m_pszExpression = nullptr;
+    const char *m_pszCur = nullptr;
+    double m_dfNoData = 0;
+
+    void Emit(Op eOp, int nSource = 0, double dfValue = 0);
+    void SkipSpaces();
+    bool Accept(const char *pszToken);
+    bool Error(const char *pszMsg);
+    bool ParseTernary();
+    bool ParseOr();
+    bool ParseAnd();
+    bool ParseEquality();
+    bool ParseRelational();
+    bool ParseAdditive();
+    bool ParseMultiplicative();
+    bool ParseUnary();
+    bool ParsePower();
+    bool ParsePrimary();
+    bool ParseFunctionCall(const std::string &osName);
+};
+
+void PixelExpression::Emit(Op eOp, int nSource, double dfValue)
+{
+    m_aoInstrs.push_back(Instr{eOp, nSource, dfValue});
+    switch (eOp)
+    {
+        case Op::PUSH_CONST:
+        case Op::PUSH_SOURCE:
+            ++m_nStackDepth;
+            m_nMaxStackDepth = std::max(m_nMaxStackDepth, m_nStackDepth);
+            break;
+        case Op::NEG:
+        case Op::NOT:
+        case Op::ABS:
+        case Op::SQRT:
+        case Op::EXP:
+        case Op::LOG:
+        case Op::LOG10:
+        case Op::SIN:
+        case Op::COS:
+        case Op::TAN:
+        case Op::ASIN:
+        case Op::ACOS:
+        case Op::ATAN:
+        case Op::FLOOR:
+        case Op::CEIL:
+        case Op::ROUND:
+        case Op::ISNAN:
+            break;
+        case Op::SELECT:
+            m_nStackDepth -= 2;
+            break;
+        default:
+            --m_nStackDepth;
+            break;
+    }
+}
+
+void PixelExpression::SkipSpaces()
+{
+    while (isspace(static_cast<unsigned char>(*m_pszCur)))
+        ++m_pszCur;
+}
+
+bool PixelExpression::Accept(const char *pszToken)
+{
+    SkipSpaces();
+    const size_t nLen = strlen(pszToken);
+    if (strncmp(m_pszCur, pszToken, nLen) != 0)
+        return false;
+    // Do not take the '<' of '<=' for instance
+    if (nLen == 1 && strchr("<>=!&|", pszToken[0]) && m_pszCur[1] == '=')
+        return false;
+    m_pszCur += nLen;
+    return true;
+}
+
+bool PixelExpression::Error(const char *pszMsg)
+{
+    CPLError(CE_Failure, CPLE_AppDefined,
+             "expression pixel function: %s at offset %d of '%s'", pszMsg,
+             static_cast<int>(m_pszCur - m_pszExpression), m_pszExpression);
+    return false;
+}
+
+bool PixelExpression::ParseTernary()
+{
+    if (!ParseOr())
+        return false;
+    if (Accept("?"))
+    {
+        if (!ParseTernary())
+            return false;
+        if (!Accept(":"))
+            return Error("':' expected");
+        if (!ParseTernary())
+            return false;
+        Emit(Op::SELECT);
+    }
+    return true;
+}
+
+bool PixelExpression::ParseOr()
+{
+    if (!ParseAnd())
+        return false;
+    while (Accept("||"))
+    {
+        if (!ParseAnd())
+            return false;
+        Emit(Op::OR);
+    }
+    return true;
+}
+
+bool PixelExpression::ParseAnd()
+{
+    if (!ParseEquality())
+        return false;
+    while (Accept("&&"))
+    {
+        if (!ParseEquality())
+            return false;
+        Emit(Op::AND);
+    }
+    return true;
+}
+
+bool PixelExpression::ParseEquality()
+{
+    if (!ParseRelational())
+        return false;
+    while (true)
+    {
+        Op eOp;
+        if (Accept("=="))
+            eOp = Op::EQ;
+        else if (Accept("!="))
+            eOp = Op::NE;
+        else
+            return true;
+        if (!ParseRelational())
+            return false;
+        Emit(eOp);
+    }
+}
+
+bool PixelExpression::ParseRelational()
+{
+    if (!ParseAdditive())
+        return false;
+    while (true)
+    {
+        Op eOp;
+        if (Accept("<="))
+            eOp = Op::LE;
+        else if (Accept(">="))
+            eOp = Op::GE;
+        else if (Accept("<"))
+            eOp = Op::LT;
+        else if (Accept(">"))
+            eOp = Op::GT;
+        else
+            return true;
+        if (!ParseAdditive())
+            return false;
+        Emit(eOp);
+    }
+}
+
+bool PixelExpression::ParseAdditive()
+{
+    if (!ParseMultiplicative())
+        return false;
+    while (true)
+    {
+        Op eOp;
+        if (Accept("+"))
+            eOp = Op::ADD;
+        else if (Accept("-"))
+            eOp = Op::SUB;
+        else
+            return true;
+        if (!ParseMultiplicative())
+            return false;
+        Emit(eOp);
+    }
+}
+
+bool PixelExpression::ParseMultiplicative()
+{
+    if (!ParseUnary())
+        return false;
+    while (true)
+    {
+        Op eOp;
+        if (Accept("*"))
+            eOp = Op::MUL;
+        else if (Accept("/"))
+            eOp = Op::DIV;
+        else if (Accept("%"))
+            eOp = Op::MOD;
+        else
+            return true;
+        if (!ParseUnary())
+            return false;
+        Emit(eOp);
+    }
+}
+
+bool PixelExpression::ParseUnary()
+{
+    if (Accept("-"))
+    {
+        if (!ParseUnary())
+            return false;
+        Emit(Op::NEG);
+        return true;
+    }
+    if (Accept("+"))
+        return ParseUnary();
+    if (Accept("!"))
+    {
+        if (!ParseUnary())
+            return false;
+        Emit(Op::NOT);
+        return true;
+    }
+    return ParsePower();
+}
+
+bool PixelExpression::ParsePower()
+{
+    if (!ParsePrimary())
+        return false;
+    if (Accept("^"))
+    {
+        // Right associative, and binding tighter than unary minus on its
+        // left: -2^2 is -(2^2)
+        if (!ParseUnary())
+            return false;
+        Emit(Op::POW);
+    }
+    return true;
+}
+
+bool PixelExpression::ParsePrimary()
+{
+    SkipSpaces();
+    if (Accept("("))
+    {
+        if (!ParseTernary())
+            return false;
+        if (!Accept(")"))
+            return Error("')' expected");
+        return true;
+    }
+
+    if (isdigit(static_cast<unsigned char>(*m_pszCur)) || *m_pszCur == '.')
+    {
+        char *pszEnd = nullptr;
+        const double dfValue = CPLStrtod(m_pszCur, &pszEnd);
+        if (pszEnd == m_pszCur)
+            return Error("invalid number");
+        m_pszCur = pszEnd;
+        Emit(Op::PUSH_CONST, 0, dfValue);
+        return true;
+    }
+
+    if (isalpha(static_cast<unsigned char>(*m_pszCur)) || *m_pszCur == '_')
+    {
+        const char *pszStart = m_pszCur;
+        while (isalnum(static_cast<unsigned char>(*m_pszCur)) ||
+               *m_pszCur == '_')
+            ++m_pszCur;
+        const std::string osName(pszStart, m_pszCur - pszStart);
+
+        if (Accept("("))
+            return ParseFunctionCall(osName);
+
+        if (osName.size() >= 2 && osName[0] == 'B' &&
+            osName.find_first_not_of("0123456789", 1) == std::string::npos)
+        {
+            const int nBand = atoi(osName.c_str() + 1);
+            if (nBand < 1 || nBand > 65535)
+            {
+                m_pszCur = pszStart;
+                return Error("invalid source index");
+            }
+            const int iSource = nBand - 1;
+            m_nMaxSourceIndex = std::max(m_nMaxSourceIndex, iSource);
+            if (static_cast<int>(m_abUsedSources.size()) <= iSource)
+                m_abUsedSources.resize(iSource + 1);
+            m_abUsedSources[iSource] = true;
+            Emit(Op::PUSH_SOURCE, iSource);
+            return true;
+        }
+        if (osName == "NODATA")
+        {
+            Emit(Op::PUSH_CONST, 0, m_dfNoData);
+            return true;
+        }
+        if (osName == "pi")
+        {
+            Emit(Op::PUSH_CONST, 0, M_PI);
+            return true;
+        }
+        m_pszCur = pszStart;
+        return Error("unknown identifier");
+    }
+
+    return Error(*m_pszCur ? "unexpected character" : "unexpected end");
+}
+
+bool PixelExpression::ParseFunctionCall(const std::string &osName)
+{
+    static const struct
+    {
+        const char *pszName;
+        Op eOp;
+        int nArgs;  // -1 for 2 or more
+    } asFunctions[] = {
+        {"abs", Op::ABS, 1},     {"sqrt", Op::SQRT, 1},
+        {"exp", Op::EXP, 1},     {"log", Op::LOG, 1},
+        {"log10", Op::LOG10, 1}, {"sin", Op::SIN, 1},
+        {"cos", Op::COS, 1},     {"tan", Op::TAN, 1},
+        {"asin", Op::ASIN, 1},   {"acos", Op::ACOS, 1},
+        {"atan", Op::ATAN, 1},   {"floor", Op::FLOOR, 1},
+        {"ceil", Op::CEIL, 1},   {"round", Op::ROUND, 1},
+        {"isnan", Op::ISNAN, 1}, {"pow", Op::POW, 2},
+        {"atan2", Op::ATAN2, 2}, {"fmod", Op::MOD, 2},
+        {"min", Op::MIN, -1},    {"max", Op::MAX, -1},
+    };
+
+    for (const auto &sFunction : asFunctions)
+    {
+        if (osName != sFunction.pszName)
+            continue;
+
+        int nArgs = 0;
+        if (!Accept(")"))
+        {
+            do
+            {
+                if (!ParseTernary())
+                    return false;
+                ++nArgs;
+                // Variadic functions are folded as arguments come
+                if (sFunction.nArgs < 0 && nArgs >= 2)
+                    Emit(sFunction.eOp);
+            } while (Accept(","));
+            if (!Accept(")"))
+                return Error("')' expected");
+        }
+        if (sFunction.nArgs < 0 ? nArgs < 2 : nArgs != sFunction.nArgs)
+            return Error(CPLSPrintf("wrong number of arguments for %s()",
+                                    osName.c_str()));
+        if (sFunction.nArgs > 0)
+            Emit(sFunction.eOp);
+        return true;
+    }
+
+    return Error(CPLSPrintf("unknown function %s()", osName.c_str()));
+}
+
+std::unique_ptr<PixelExpression>
+PixelExpression::Compile(const char *pszExpression, double dfNoData)
+{
+    auto poExpr = std::make_unique<PixelExpression>();
+    poExpr->m_pszExpression = pszExpression;
+    poExpr->m_pszCur = pszExpression;
+    poExpr->m_dfNoData = dfNoData;
+    if (!poExpr->ParseTernary())
+        return nullptr;
+    poExpr->SkipSpaces();
+    if (*poExpr->m_pszCur != '\0')
+    {
+        poExpr->Error("unexpected character");
+        return nullptr;
+    }
+    CPLAssert(poExpr->m_nStackDepth == 1);
+    poExpr->m_pszExpression = nullptr;
+    poExpr->m_pszCur = nullptr;
+    return poExpr;
+}
+
+// Evaluate the expression on nCount <= CHUNK_SIZE pixels. papadfSources[i] is
+// the values of the i-th source, padfStack a scratch buffer of
+// GetMaxStackDepth() * CHUNK_SIZE values. Returns a pointer to the nCount
+// result values, that may point to one of the sources.
+const double *PixelExpression::Evaluate(const double *const *papadfSources,
+                                        size_t nCount, double *padfStack) const
+{
+    // Each stack level has its own output buffer, but may refer to a source
+    // instead when it has just been pushed.
+    const double *apadfLevels[64];
+    std::vector<const double *> apadfLevelsDyn;
+    const double **papadfLevels = apadfLevels;
+    if (m_nMaxStackDepth > 64)
+    {
+        apadfLevelsDyn.resize(m_nMaxStackDepth);
+        papadfLevels = apadfLevelsDyn.data();
+    }
+
+    int nDepth = 0;
+    for (const auto &sInstr : m_aoInstrs)
+    {
+        switch (sInstr.eOp)
+        {
+            case Op::PUSH_CONST:
+            {
+                double *padfOut = padfStack + nDepth * CHUNK_SIZE;
+                std::fill(padfOut, padfOut + nCount, sInstr.dfValue);
+                papadfLevels[nDepth++] = padfOut;
+                continue;
+            }
+            case Op::PUSH_SOURCE:
+                papadfLevels[nDepth++] = papadfSources[sInstr.nSource];
+                continue;
+            case Op::SELECT:
+            {
+                double *padfOut = padfStack + (nDepth - 3) * CHUNK_SIZE;
+                const double *padfCond = papadfLevels[nDepth - 3];
+                const double *padfA = papadfLevels[nDepth - 2];
+                const double *padfB = papadfLevels[nDepth - 1];
+                for (size_t i = 0; i < nCount; ++i)
+                    padfOut[i] = padfCond[i] != 0 ? padfA[i] : padfB[i];
+                nDepth -= 2;
+                papadfLevels[nDepth - 1] = padfOut;
+                continue;
+            }
+            default:
+                break;
+        }
+
+#define UNARY_OP(op, expr)                                                     \
+    case Op::op:                                                               \
+    {                                                                          \
+        double *padfOut = padfStack + (nDepth - 1) * CHUNK_SIZE;               \
+        const double *padfX = papadfLevels[nDepth - 1];                        \
+        for (size_t i = 0; i < nCount; ++i)                                    \
+        {                                                                      \
+            const double x = padfX[i];                                         \
+            padfOut[i] = (expr);                                               \
+        }                                                                      \
+        papadfLevels[nDepth - 1] = padfOut;                                    \
+        break;                                                                 \
+    }
+
+#define BINARY_OP(op, expr)                                                    \
+    case Op::op:                                                               \
+    {                                                                          \
+        double *padfOut = padfStack + (nDepth - 2) * CHUNK_SIZE;               \
+        const double *padfX = papadfLevels[nDepth - 2];                        \
+        const double *padfY = papadfLevels[nDepth - 1];                        \
+        for (size_t i = 0; i < nCount; ++i)                                    \
+        {                                                                      \
+            const double x = padfX[i];                                         \
+            const double y = padfY[i];                                         \
+            padfOut[i] = (expr);                                               \
+        }                                                                      \
+        --nDepth;                                                              \
+        papadfLevels[nDepth - 1] = padfOut;                                    \
+        break;                                                                 \
+    }
+
+        switch (sInstr.eOp)
+        {
+            UNARY_OP(NEG, -x)
+            UNARY_OP(NOT, x == 0 ? 1.0 : 0.0)
+            UNARY_OP(ABS, std::fabs(x))
+            UNARY_OP(SQRT, std::sqrt(x))
+            UNARY_OP(EXP, std::exp(x))
+            UNARY_OP(LOG, std::log(x))
+            UNARY_OP(LOG10, std::log10(x))
+            UNARY_OP(SIN, std::sin(x))
+            UNARY_OP(COS, std::cos(x))
+            UNARY_OP(TAN, std::tan(x))
+            UNARY_OP(ASIN, std::asin(x))
+            UNARY_OP(ACOS, std::acos(x))
+            UNARY_OP(ATAN, std::atan(x))
+            UNARY_OP(FLOOR, std::floor(x))
+            UNARY_OP(CEIL, std::ceil(x))
+            UNARY_OP(ROUND, std::round(x))
+            UNARY_OP(ISNAN, std::isnan(x) ? 1.0 : 0.0)
+            BINARY_OP(ADD, x + y)
+            BINARY_OP(SUB, x - y)
+            BINARY_OP(MUL, x * y)
+            BINARY_OP(DIV, x / y)
+            BINARY_OP(MOD, std::fmod(x, y))
+            BINARY_OP(POW, std::pow(x, y))
+            BINARY_OP(ATAN2, std::atan2(x, y))
+            BINARY_OP(MIN, y < x ? y : x)
+            BINARY_OP(MAX, y > x ? y : x)
+            BINARY_OP(LT, x < y ? 1.0 : 0.0)
+            BINARY_OP(LE, x <= y ? 1.0 : 0.0)
+            BINARY_OP(GT, x > y ? 1.0 : 0.0)
+            BINARY_OP(GE, x >= y ? 1.0 : 0.0)
+            BINARY_OP(EQ, x == y ? 1.0 : 0.0)
+            BINARY_OP(NE, x != y ? 1.0 : 0.0)
+            BINARY_OP(AND, (x != 0 && y != 0) ? 1.0 : 0.0)
+            BINARY_OP(OR, (x != 0 || y != 0) ? 1.0 : 0.0)
+            case Op::PUSH_CONST:
+            case Op::PUSH_SOURCE:
+            case Op::SELECT:
+                break;
+        }
+
+#undef UNARY_OP
+#undef BINARY_OP
+    }
+
+    CPLAssert(nDepth == 1);
+    return papadfLevels[0];
+}
+
+// Return the compiled form of an expression, from a cache shared by all
+// bands since the pixel function is called for every block.
+std::shared_ptr<const PixelExpression>
+GetCompiledPixelExpression(const char *pszExpression, double dfNoData)
+{
+    static std::mutex oMutex;
+    static std::map<std::pair<std::string, uint64_t>,
+                    std::shared_ptr<const PixelExpression>>
+        oCache;
+    constexpr size_t MAX_CACHE_SIZE = 128;
+
+    uint64_t nNoDataBits = 0;
+    memcpy(&nNoDataBits, &dfNoData, sizeof(dfNoData));
+    auto oKey = std::make_pair(std::string(pszExpression), nNoDataBits);
+
+    std::lock_guard<std::mutex> oLock(oMutex);
+    auto oIter = oCache.find(oKey);
+    if (oIter != oCache.end())
+        return oIter->second;
+
+    std::shared_ptr<const PixelExpression> poExpr =
+        PixelExpression::Compile(pszExpression, dfNoData);
+    if (poExpr)
+    {
+        if (oCache.size() == MAX_CACHE_SIZE)
+            oCache.clear();
+        oCache[std::move(oKey)] = poExpr;
+    }
+    return poExpr;
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                        ExpressionPixelFunc()                         */
+/************************************************************************/
+
+static const char pszExpressionPixelFuncMetadata[] =
+    "<PixelFunctionArgumentsList supportsNativeSourceTypes='true'>"
+    "   <Argument name='expression' description='Expression to evaluate' "
+    "type='string' mandatory='1' />"
+    "   <Argument type='builtin' value='NoData' optional='true' />"
+    "   <Argument name='propagateNoData' description='Whether the output value "
+    "should be NoData as soon as one source is NoData' type='boolean' "
+    "default='false' />"
+    "</PixelFunctionArgumentsList>";
+
+static CPLErr ExpressionPixelFunc(void **papoSources, int nSources,
+                                  void *pData, int nXSize, int nYSize,
+                                  GDALDataType eSrcType, GDALDataType eBufType,
+                                  int nPixelSpace, int nLineSpace,
+                                  CSLConstList papszArgs)
+{
+    /* ---- Init ---- */
+    if (GDALDataTypeIsComplex(eSrcType))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "expression cannot by applied to complex data types");
+        return CE_Failure;
+    }
+
+    const char *pszExpression = CSLFetchNameValue(papszArgs, "expression");
+    if (pszExpression == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Missing pixel function argument: expression");
+        return CE_Failure;
+    }
+
+    double dfNoData = std::numeric_limits<double>::quiet_NaN();
+    if (FetchDoubleArg(papszArgs, "NoData", &dfNoData, &dfNoData) != CE_None)
+        return CE_Failure;
+    const bool bPropagateNoData = CPLTestBool(
+        CSLFetchNameValueDef(papszArgs, "propagateNoData", "false"));
+
+    const auto poExpr = GetCompiledPixelExpression(pszExpression, dfNoData);
+    if (!poExpr)
+        return CE_Failure;
+    if (poExpr->GetMaxSourceIndex() >= nSources)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "expression references B%d, but there are only %d sources",
+                 poExpr->GetMaxSourceIndex() + 1, nSources);
+        return CE_Failure;
+    }
+
+    // Working buffers, kept from one call to another
+    constexpr size_t CHUNK_SIZE = PixelExpression::CHUNK_SIZE;
+    thread_local std::vector<double> adfBuffers;
+    const size_t nBufferCount =
+        static_cast<size_t>(nSources) + poExpr->GetMaxStackDepth();
+    if (adfBuffers.size() < nBufferCount * CHUNK_SIZE)
+        adfBuffers.resize(nBufferCount * CHUNK_SIZE);
+    double *const padfSourceBuffers = adfBuffers.data();
+    double *const padfStack = padfSourceBuffers + nSources * CHUNK_SIZE;
+    std::vector<const double *> apadfSources(nSources);
+
+    const int nSrcTypeSize = GDALGetDataTypeSizeBytes(eSrcType);
+
+    /* ---- Set pixels ---- */
+    for (int iLine = 0; iLine < nYSize; ++iLine)
+    {
+        for (int iCol = 0; iCol < nXSize; iCol += static_cast<int>(CHUNK_SIZE))
+        {
+            const int nCount =
+                std::min(static_cast<int>(CHUNK_SIZE), nXSize - iCol);
+            const size_t nSrcOffset =
+                static_cast<size_t>(iLine) * nXSize + iCol;
+
+            for (int iSrc = 0; iSrc < nSources; ++iSrc)
+            {
+                if (!poExpr->UsesSource(iSrc) && !bPropagateNoData)
+                    continue;
+                const GByte *pabySrc =
+                    static_cast<const GByte *>(papoSources[iSrc]) +
+                    nSrcOffset * nSrcTypeSize;
+                if (eSrcType == GDT_Float64)
+                {
+                    apadfSources[iSrc] =
+                        reinterpret_cast<const double *>(pabySrc);
+                }
+                else
+                {
+                    double *padfBuffer =
+                        padfSourceBuffers + iSrc * CHUNK_SIZE;
+                    GDALCopyWords(pabySrc, eSrcType, nSrcTypeSize, padfBuffer,
+                                  GDT_Float64, sizeof(double), nCount);
+                    apadfSources[iSrc] = padfBuffer;
+                }
+            }
+
+            const double *padfResult =
+                poExpr->Evaluate(apadfSources.data(), nCount, padfStack);
+
+            if (bPropagateNoData)
+            {
+                // The result may point to a source: use the first stack
+                // level, which is free at that point.
+                if (padfResult != padfStack)
+                {
+                    memcpy(padfStack, padfResult, nCount * sizeof(double));
+                    padfResult = padfStack;
+                }
+                for (int iSrc = 0; iSrc < nSources; ++iSrc)
+                {
+                    const double *padfSrc = apadfSources[iSrc];
+                    for (int i = 0; i < nCount; ++i)
+                    {
+                        if (std::isnan(padfSrc[i]) || padfSrc[i] == dfNoData)
+                            padfStack[i] = dfNoData;
+                    }
+                }
+            }
+
+            GDALCopyWords(padfResult, GDT_Float64, sizeof(double),
+                          static_cast<GByte *>(pData) +
+                              static_cast<GSpacing>(nLineSpace) * iLine +
+                              static_cast<GSpacing>(iCol) * nPixelSpace,
+                          eBufType, nPixelSpace, nCount);
+        }
+    }
+
+    /* ---- Return success ---- */
+    return CE_None;
+}  // ExpressionPixelFunc
+
 /************************************************************************/
 /*                     GDALRegisterDefaultPixelFunc()                   */
 /************************************************************************/
@@ -1696,6 +2560,8 @@ static CPLErr MaxPixelFunc(void **papoSources, int nSources, void *pData,
  *                      exponential interpolation
  * - "scale": Apply the RasterBand metadata values of "offset" and "scale"
  * - "nan": Convert incoming NoData values to IEEE 754 nan
+ * - "expression": evaluate an arithmetic expression of the sources (B1, B2,
+ *                 ...)
  *
  * @see GDALAddDerivedBandPixelFunc
  *
@@ -1749,5 +2615,7 @@ CPLErr GDALRegisterDefaultPixelFunc()
                                         pszMinMaxFuncMetadataNodata);
     GDALAddDerivedBandPixelFuncWithArgs("max", MaxPixelFunc,
                                         pszMinMaxFuncMetadataNodata);
+    GDALAddDerivedBandPixelFuncWithArgs("expression", ExpressionPixelFunc,
+                                        pszExpressionPixelFuncMetadata);
     return CE_None;
 }
@@ -36,6 +36,7 @@
 #include "gdal_utils.h"
 
 #include <algorithm>
+#include <memory>
 #include <typeinfo>
 #include "gdal_proxy.h"
 
@@ -1592,11 +1593,13 @@ GDALDataset *VRTDataset::OpenXML(const char *pszXML, const char *pszVRTPath,
     /* -------------------------------------------------------------------- */
     /*      Parse the XML.                                                  */
     /* -------------------------------------------------------------------- */
-    CPLXMLTreeCloser psTree(CPLParseXMLString(pszXML));
-    if (psTree == nullptr)
+    // The tree is only read by XMLInit(), so use the cheaper arena-backed
+    // representation.
+    CPLXMLArenaTree oTree;
+    if (!oTree.Parse(pszXML))
         return nullptr;
 
-    CPLXMLNode *psRoot = CPLGetXMLNode(psTree.get(), "=VRTDataset");
+    CPLXMLNode *psRoot = CPLGetXMLNode(oTree.get(), "=VRTDataset");
     if (psRoot == nullptr)
     {
         CPLError(CE_Failure, CPLE_AppDefined, "Missing VRTDataset element.");
@@ -2600,6 +2603,235 @@ void VRTDataset::BuildVirtualOverviews()
     }
 }
 
+/************************************************************************/
+/*                    IsMosaicForVirtualOverviews()                     */
+/************************************************************************/
+
+// Whether all bands are made only of SimpleSource or ComplexSource, in
+// which case AddMosaicVirtualOverview() can be used.
+
+bool VRTDataset::IsMosaicForVirtualOverviews()
+{
+    if (nBands == 0)
+        return false;
+    const auto IsMosaicBand = [](GDALRasterBand *poBand)
+    {
+        // Do not allow VRTDerivedRasterBand for example
+        if (typeid(*poBand) != typeid(VRTSourcedRasterBand))
+            return false;
+        auto poVRTBand = cpl::down_cast<VRTSourcedRasterBand *>(poBand);
+        for (int iSource = 0; iSource < poVRTBand->nSources; ++iSource)
+        {
+            VRTSource *poSource = poVRTBand->papoSources[iSource];
+            if (!poSource->IsSimpleSource())
+                return false;
+            auto poSimpleSource = cpl::down_cast<VRTSimpleSource *>(poSource);
+            if (!EQUAL(poSimpleSource->GetType(), "SimpleSource") &&
+                !EQUAL(poSimpleSource->GetType(), "ComplexSource"))
+                return false;
+            // Sources without DstRect cannot be scaled
+            if (!(poSimpleSource->m_dfDstXSize > 0) ||
+                !(poSimpleSource->m_dfDstYSize > 0))
+                return false;
+        }
+        return true;
+    };
+    for (int iBand = 0; iBand < nBands; ++iBand)
+    {
+        if (!IsMosaicBand(papoBands[iBand]))
+            return false;
+    }
+    return m_poMaskBand == nullptr || IsMosaicBand(m_poMaskBand);
+}
+
+/************************************************************************/
+/*                    CreateMosaicOverviewSource()                      */
+/************************************************************************/
+
+// Create the source of an implicit virtual overview of a mosaic, from the
+// source of the full resolution band. The overview of the source band whose
+// resolution matches the one of the virtual overview is selected once, here,
+// instead of at each RasterIO() request.
+
+VRTSource *VRTDataset::CreateMosaicOverviewSource(VRTSimpleSource *poSrcSource,
+                                                  double dfXRatio,
+                                                  double dfYRatio,
+                                                  const char *pszResampling)
+{
+    GDALRasterBand *poSrcBand = poSrcSource->m_bGetMaskBand
+                                    ? poSrcSource->GetMaskBandMainBand()
+                                    : poSrcSource->GetRasterBand();
+    if (poSrcBand == nullptr)
+        return nullptr;
+
+    std::unique_ptr<VRTSimpleSource> poNewSource;
+    if (EQUAL(poSrcSource->GetType(), "ComplexSource"))
+    {
+        poNewSource = std::make_unique<VRTComplexSource>(
+            cpl::down_cast<VRTComplexSource *>(poSrcSource), dfXRatio,
+            dfYRatio);
+    }
+    else
+    {
+        poNewSource =
+            std::make_unique<VRTSimpleSource>(poSrcSource, dfXRatio, dfYRatio);
+    }
+    poNewSource->SetResampling(poSrcSource->GetResampling().empty()
+                                   ? pszResampling
+                                   : poSrcSource->GetResampling().c_str());
+
+    GDALRasterBand *poOvrBand = nullptr;
+    int iOvr = -1;
+    if (!poSrcSource->m_bGetMaskBand && poNewSource->m_dfDstXSize > 0 &&
+        poNewSource->m_dfDstYSize > 0 && poSrcSource->m_dfSrcXSize > 0 &&
+        poSrcSource->m_dfSrcYSize > 0)
+    {
+        int nXOff = 0;
+        int nYOff = 0;
+        int nXSize = poSrcBand->GetXSize();
+        int nYSize = poSrcBand->GetYSize();
+        const int nBufXSize = std::max(
+            1, static_cast<int>(nXSize * poNewSource->m_dfDstXSize /
+                                    poSrcSource->m_dfSrcXSize +
+                                0.5));
+        const int nBufYSize = std::max(
+            1, static_cast<int>(nYSize * poNewSource->m_dfDstYSize /
+                                    poSrcSource->m_dfSrcYSize +
+                                0.5));
+        GDALRasterIOExtraArg sExtraArg;
+        INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+        sExtraArg.eResampleAlg =
+            GDALRasterIOGetResampleAlg(poNewSource->GetResampling());
+        iOvr = GDALBandGetBestOverviewLevel2(poSrcBand, nXOff, nYOff, nXSize,
+                                             nYSize, nBufXSize, nBufYSize,
+                                             &sExtraArg);
+        if (iOvr >= 0)
+            poOvrBand = poSrcBand->GetOverview(iOvr);
+    }
+
+    if (poOvrBand == nullptr)
+    {
+        // Read from the full resolution source band, as the source of the
+        // full resolution dataset does.
+        if (poNewSource->m_bDropRefOnSrcBand && poSrcBand->GetDataset())
+            poSrcBand->GetDataset()->Reference();
+        return poNewSource.release();
+    }
+
+    const double dfOvrXRatio =
+        static_cast<double>(poOvrBand->GetXSize()) / poSrcBand->GetXSize();
+    const double dfOvrYRatio =
+        static_cast<double>(poOvrBand->GetYSize()) / poSrcBand->GetYSize();
+    poNewSource->m_dfSrcXOff *= dfOvrXRatio;
+    poNewSource->m_dfSrcYOff *= dfOvrYRatio;
+    poNewSource->m_dfSrcXSize *= dfOvrXRatio;
+    poNewSource->m_dfSrcYSize *= dfOvrYRatio;
+
+    if (dynamic_cast<GDALProxyPoolRasterBand *>(poSrcBand) &&
+        !poSrcSource->m_osSrcDSName.empty())
+    {
+        // The overview bands of a proxy pool band belong to the full
+        // resolution proxy dataset. Open the source at the overview level
+        // instead, so that the dataset of the source band is consistent with
+        // it.
+        poNewSource->m_aosOpenOptions.SetNameValue("OVERVIEW_LEVEL",
+                                                   CPLSPrintf("%d", iOvr));
+        poNewSource->SetRasterBand(nullptr, true);
+    }
+    else
+    {
+        // The overview band is owned by the source dataset, which is kept
+        // alive by poSrcSource.
+        poNewSource->SetRasterBand(poOvrBand, false);
+    }
+    return poNewSource.release();
+}
+
+/************************************************************************/
+/*                      AddMosaicVirtualOverview()                      */
+/************************************************************************/
+
+// Add an implicit virtual overview whose bands have the same sources as the
+// full resolution bands, with scaled destination windows. Each source reads
+// directly the overview of its source band matching the overview factor.
+// Sources are only instantiated when a request intersects them.
+
+bool VRTDataset::AddMosaicVirtualOverview(int nOvFactor,
+                                          const char *pszResampling)
+{
+    const int nOvrXSize = nRasterXSize / nOvFactor;
+    const int nOvrYSize = nRasterYSize / nOvFactor;
+    const double dfXRatio = static_cast<double>(nOvrXSize) / nRasterXSize;
+    const double dfYRatio = static_cast<double>(nOvrYSize) / nRasterYSize;
+
+    auto poOvrVDS = std::make_unique<VRTDataset>(nOvrXSize, nOvrYSize);
+    if (m_bGeoTransformSet)
+    {
+        double adfOvrGT[6];
+        memcpy(adfOvrGT, m_adfGeoTransform, sizeof(adfOvrGT));
+        adfOvrGT[1] /= dfXRatio;
+        adfOvrGT[2] /= dfYRatio;
+        adfOvrGT[4] /= dfXRatio;
+        adfOvrGT[5] /= dfYRatio;
+        poOvrVDS->SetGeoTransform(adfOvrGT);
+    }
+    poOvrVDS->SetSpatialRef(GetSpatialRef());
+
+    const std::string osResampling(pszResampling);
+    const auto CreateOverviewBand =
+        [&poOvrVDS, nOvrXSize, nOvrYSize, dfXRatio, dfYRatio,
+         &osResampling](VRTSourcedRasterBand *poVRTBand)
+    {
+        VRTSourcedRasterBand *poOvrVRTBand = new VRTSourcedRasterBand(
+            poOvrVDS.get(), poVRTBand->GetBand(),
+            poVRTBand->GetRasterDataType(), nOvrXSize, nOvrYSize);
+        poOvrVRTBand->CopyCommonInfoFrom(poVRTBand);
+        poOvrVRTBand->m_bNoDataValueSet = poVRTBand->m_bNoDataValueSet;
+        poOvrVRTBand->m_dfNoDataValue = poVRTBand->m_dfNoDataValue;
+        poOvrVRTBand->m_bHideNoDataValue = poVRTBand->m_bHideNoDataValue;
+
+        for (int iSource = 0; iSource < poVRTBand->nSources; ++iSource)
+        {
+            VRTSimpleSource *poSrcSource = cpl::down_cast<VRTSimpleSource *>(
+                poVRTBand->papoSources[iSource]);
+            double dfDstXOff = 0;
+            double dfDstYOff = 0;
+            double dfDstXSize = 0;
+            double dfDstYSize = 0;
+            poSrcSource->GetDstWindow(dfDstXOff, dfDstYOff, dfDstXSize,
+                                      dfDstYSize);
+            poOvrVRTBand->AddDeferredSource(
+                dfDstXOff * dfXRatio, dfDstYOff * dfYRatio,
+                dfDstXSize * dfXRatio, dfDstYSize * dfYRatio,
+                [poSrcSource, dfXRatio, dfYRatio, osResampling]()
+                {
+                    return CreateMosaicOverviewSource(poSrcSource, dfXRatio,
+                                                      dfYRatio,
+                                                      osResampling.c_str());
+                });
+        }
+        return poOvrVRTBand;
+    };
+
+    for (int i = 0; i < nBands; i++)
+    {
+        auto poOvrVRTBand = CreateOverviewBand(
+            cpl::down_cast<VRTSourcedRasterBand *>(papoBands[i]));
+        poOvrVDS->SetBand(poOvrVDS->GetRasterCount() + 1, poOvrVRTBand);
+    }
+
+    if (m_poMaskBand)
+    {
+        auto poOvrVRTBand = CreateOverviewBand(
+            cpl::down_cast<VRTSourcedRasterBand *>(m_poMaskBand));
+        poOvrVDS->SetMaskBand(poOvrVRTBand);
+    }
+
+    m_anOverviewFactors.push_back(nOvFactor);
+    m_apoOverviews.push_back(poOvrVDS.release());
+    return true;
+}
+
 /************************************************************************/
 /*                        AddVirtualOverview()                          */
 /************************************************************************/
@@ -2611,6 +2843,9 @@ bool VRTDataset::AddVirtualOverview(int nOvFactor, const char *pszResampling)
         return false;
     }
 
+    if (IsMosaicForVirtualOverviews())
+        return AddMosaicVirtualOverview(nOvFactor, pszResampling);
+
     CPLStringList argv;
     argv.AddString("-of");
     argv.AddString("VRT");
@@ -35,6 +35,7 @@
 
 #include "cpl_hash_set.h"
 #include "cpl_minixml.h"
+#include "cpl_quad_tree.h"
 #include "gdal_pam.h"
 #include "gdal_priv.h"
 #include "gdal_rat.h"
@@ -195,6 +196,7 @@ template <class T> struct VRTFlushCacheStruct
 class VRTWarpedDataset;
 class VRTPansharpenedDataset;
 class VRTGroup;
+class VRTSimpleSource;
 
 class CPL_DLL VRTDataset CPL_NON_FINAL : public GDALDataset
 {
@@ -244,6 +246,12 @@ class CPL_DLL VRTDataset CPL_NON_FINAL : public GDALDataset
                             bool bAllowPansharpened);
     static GDALDataset *OpenVRTProtocol(const char *pszSpec);
     bool AddVirtualOverview(int nOvFactor, const char *pszResampling);
+    bool IsMosaicForVirtualOverviews();
+    bool AddMosaicVirtualOverview(int nOvFactor, const char *pszResampling);
+    static VRTSource *CreateMosaicOverviewSource(VRTSimpleSource *poSrcSource,
+                                                 double dfXRatio,
+                                                 double dfYRatio,
+                                                 const char *pszResampling);
 
     bool GetShiftedDataset(int nXOff, int nYOff, int nXSize, int nYSize,
                            GDALDataset *&poSrcDataset, int &nSrcXOff,
@@ -662,11 +670,35 @@ class CPL_DLL VRTSourcedRasterBand CPL_NON_FINAL : public VRTRasterBand
     char **m_papszSourceList = nullptr;
     int m_nSkipBufferInitialization = -1;
 
+    // Spatial index of the destination windows of the sources, built on
+    // first use when there are many sources, and rebuilt when the source
+    // list changes.
+    CPLQuadTree *m_hSourcesIndex = nullptr;
+    int m_nSourcesIndexCount = 0;
+    VRTSource **m_papoSourcesIndexed = nullptr;
+
+    // Whether some sources have been added unparsed, with VRT_LAZY_SOURCES.
+    bool m_bHasLazySources = false;
+
+    void InvalidateSourcesIndex();
+    void GetSourcesIntersectingWindow(double dfXOff, double dfYOff,
+                                      double dfXSize, double dfYSize,
+                                      std::vector<int> &anSources);
+    void MaterializeLazySources(const std::vector<int> &anSources);
+    void ApplyNBitsToSource(VRTSource *poSource);
+
     bool CanUseSourcesMinMaxImplementations();
 
     bool IsMosaicOfNonOverlappingSimpleSourcesOfFullRasterNoResAndTypeChange(
         bool bAllowMaxValAdjustment) const;
 
+    bool IRasterIOMultiThreaded(int nXOff, int nYOff, int nXSize, int nYSize,
+                                void *pData, int nBufXSize, int nBufYSize,
+                                GDALDataType eBufType, GSpacing nPixelSpace,
+                                GSpacing nLineSpace,
+                                GDALRasterIOExtraArg *psExtraArg,
+                                CPLErr &eErr);
+
     CPL_DISALLOW_COPY_ASSIGN(VRTSourcedRasterBand)
 
   protected:
@@ -722,6 +754,9 @@ class CPL_DLL VRTSourcedRasterBand CPL_NON_FINAL : public VRTRasterBand
                                 void *pProgressData) override;
 
     CPLErr AddSource(VRTSource *);
+    void AddDeferredSource(double dfDstXOff, double dfDstYOff,
+                           double dfDstXSize, double dfDstYSize,
+                           std::function<VRTSource *()> &&oFactory);
 
     CPLErr AddSimpleSource(const char *pszFilename, int nBand,
                            double dfSrcXOff = -1, double dfSrcYOff = -1,
@@ -865,7 +900,15 @@ class CPL_DLL VRTDerivedRasterBand CPL_NON_FINAL : public VRTSourcedRasterBand
     bool InitializePython();
     CPLErr
     GetPixelFunctionArguments(const CPLString &,
-                              std::vector<std::pair<CPLString, CPLString>> &);
+                              std::vector<std::pair<CPLString, CPLString>> &,
+                              bool &bSupportsNativeSourceTypes);
+    GDALDataType GetNativeSourceType();
+    bool LoadSourcesMultiThreaded(
+        int nBufferCount, const std::vector<int> &anMapBufferIdxToSourceIdx,
+        const GDALRasterIOExtraArg *psExtraArg,
+        const std::function<CPLErr(int, VRTSource::WorkingState &)>
+            &LoadSource,
+        CPLErr &eErr);
 
     CPL_DISALLOW_COPY_ASSIGN(VRTDerivedRasterBand)
 
@@ -887,6 +930,8 @@ class CPL_DLL VRTDerivedRasterBand CPL_NON_FINAL : public VRTSourcedRasterBand
                              GSpacing nLineSpace,
                              GDALRasterIOExtraArg *psExtraArg) override;
 
+    virtual CPLErr IReadBlock(int, int, void *) override;
+
     virtual int IGetDataCoverageStatus(int nXOff, int nYOff, int nXSize,
                                        int nYSize, int nMaskFlagStop,
                                        double *pdfDataPct) override;
@@ -996,6 +1041,7 @@ class VRTDriver final : public GDALDriver
     VRTSource *
     ParseSource(CPLXMLNode *psSrc, const char *pszVRTPath,
                 std::map<CPLString, GDALDataset *> &oMapSharedSources);
+    bool IsSourceElementName(const char *pszElementName) const;
     void AddSourceParser(const char *pszElementName, VRTSourceParser pfnParser);
 };
 
@@ -32,9 +32,14 @@
 #include "cpl_string.h"
 #include "vrtdataset.h"
 #include "cpl_multiproc.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "gdalpython.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
 #include <map>
 #include <vector>
 #include <utility>
@@ -160,6 +165,18 @@ class VRTDerivedRasterBandPrivateData
     bool m_bSkipNonContributingSourcesSpecified = false;
     bool m_bSkipNonContributingSources = false;
 
+    // Buffers of the sources and of the output of the Python pixel function,
+    // with the NumPy arrays wrapping them, kept from one IRasterIO() call to
+    // the next one with the same dimensions.
+    GDALDataType m_eCachedSrcType = GDT_Unknown;
+    int m_nCachedXSize = 0;
+    int m_nCachedYSize = 0;
+    std::vector<void *> m_apCachedSrcBuffers{};
+    std::vector<PyObject *> m_apoCachedSrcArrays{};
+    GByte *m_pabyCachedDstBuffer = nullptr;
+    PyObject *m_poCachedDstArray = nullptr;
+    PyObject *m_poKwargs = nullptr;
+
     VRTDerivedRasterBandPrivateData() = default;
 
     virtual ~VRTDerivedRasterBandPrivateData()
@@ -168,9 +185,55 @@ class VRTDerivedRasterBandPrivateData
             Py_DecRef(m_poGDALCreateNumpyArray);
         if (m_poUserFunction)
             Py_DecRef(m_poUserFunction);
+        if (m_poKwargs)
+            Py_DecRef(m_poKwargs);
+        ResetCachedBuffers(GDT_Unknown, 0, 0);
+    }
+
+    void ResetCachedBuffers(GDALDataType eSrcType, int nXSize, int nYSize)
+    {
+        if (m_poCachedDstArray || !m_apoCachedSrcArrays.empty())
+        {
+            GIL_Holder oHolder(false);
+            if (m_poCachedDstArray)
+                Py_DecRef(m_poCachedDstArray);
+            for (PyObject *poArray : m_apoCachedSrcArrays)
+            {
+                if (poArray)
+                    Py_DecRef(poArray);
+            }
+        }
+        m_poCachedDstArray = nullptr;
+        m_apoCachedSrcArrays.clear();
+        for (void *pBuffer : m_apCachedSrcBuffers)
+            VSIFree(pBuffer);
+        m_apCachedSrcBuffers.clear();
+        VSIFree(m_pabyCachedDstBuffer);
+        m_pabyCachedDstBuffer = nullptr;
+        m_eCachedSrcType = eSrcType;
+        m_nCachedXSize = nXSize;
+        m_nCachedYSize = nYSize;
+    }
+
+    void *GetCachedSrcBuffer(int iBuffer)
+    {
+        while (static_cast<int>(m_apCachedSrcBuffers.size()) <= iBuffer)
+        {
+            void *pBuffer = VSI_MALLOC3_VERBOSE(
+                GDALGetDataTypeSizeBytes(m_eCachedSrcType), m_nCachedXSize,
+                m_nCachedYSize);
+            if (pBuffer == nullptr)
+                return nullptr;
+            m_apCachedSrcBuffers.push_back(pBuffer);
+            m_apoCachedSrcArrays.push_back(nullptr);
+        }
+        return m_apCachedSrcBuffers[iBuffer];
     }
 };
 
+// Maximum size in bytes of a buffer kept by VRTDerivedRasterBandPrivateData
+constexpr size_t MAX_CACHED_PYTHON_BUFFER_SIZE = 16 * 1024 * 1024;
+
 /************************************************************************/
 /* ==================================================================== */
 /*                          VRTDerivedRasterBand                        */
@@ -752,13 +815,16 @@ bool VRTDerivedRasterBand::InitializePython()
 
 CPLErr VRTDerivedRasterBand::GetPixelFunctionArguments(
     const CPLString &osMetadata,
-    std::vector<std::pair<CPLString, CPLString>> &oAdditionalArgs)
+    std::vector<std::pair<CPLString, CPLString>> &oAdditionalArgs,
+    bool &bSupportsNativeSourceTypes)
 {
 
     auto poArgs = CPLXMLTreeCloser(CPLParseXMLString(osMetadata));
     if (poArgs != nullptr && poArgs->eType == CXT_Element &&
         !strcmp(poArgs->pszValue, "PixelFunctionArgumentsList"))
     {
+        bSupportsNativeSourceTypes = CPLTestBool(CPLGetXMLValue(
+            poArgs.get(), "supportsNativeSourceTypes", "false"));
         for (CPLXMLNode *psIter = poArgs->psChild; psIter != nullptr;
              psIter = psIter->psNext)
         {
@@ -819,6 +885,251 @@ CPLErr VRTDerivedRasterBand::GetPixelFunctionArguments(
     return CE_None;
 }
 
+/************************************************************************/
+/*                        GetNativeSourceType()                         */
+/************************************************************************/
+
+// Return the data type in which all sources can be read without loss, or
+// GDT_Unknown if there is none that is real and smaller than Float64, or if
+// sources alter the values they read.
+
+GDALDataType VRTDerivedRasterBand::GetNativeSourceType()
+{
+    GDALDataType eNativeType = GDT_Unknown;
+    for (int iSource = 0; iSource < nSources; iSource++)
+    {
+        if (!papoSources[iSource]->IsSimpleSource())
+            return GDT_Unknown;
+        auto poSource = static_cast<VRTSimpleSource *>(papoSources[iSource]);
+        if (strcmp(poSource->GetType(), "SimpleSource") != 0)
+            return GDT_Unknown;
+        GDALRasterBand *poBand = poSource->GetRasterBand();
+        if (poBand == nullptr)
+            return GDT_Unknown;
+        const GDALDataType eType = poBand->GetRasterDataType();
+        eNativeType = eNativeType == GDT_Unknown
+                          ? eType
+                          : GDALDataTypeUnion(eNativeType, eType);
+    }
+    if (eNativeType == GDT_Unknown || GDALDataTypeIsComplex(eNativeType) ||
+        eNativeType == GDT_Float64 || eNativeType == GDT_Int64 ||
+        eNativeType == GDT_UInt64)
+    {
+        return GDT_Unknown;
+    }
+
+    // Areas not covered by sources are initialized with the nodata value,
+    // which must be preserved.
+    if (m_bNoDataValueSet)
+    {
+        GByte abyNoData[sizeof(double)];
+        GDALCopyWords(&m_dfNoDataValue, GDT_Float64, 0, abyNoData, eNativeType,
+                      0, 1);
+        double dfNoData = 0;
+        GDALCopyWords(abyNoData, eNativeType, 0, &dfNoData, GDT_Float64, 0, 1);
+        if (!(dfNoData == m_dfNoDataValue ||
+              (std::isnan(dfNoData) && std::isnan(m_dfNoDataValue))))
+            return GDT_Unknown;
+    }
+
+    return eNativeType;
+}
+
+/************************************************************************/
+/*                      LoadSourcesMultiThreaded()                      */
+/************************************************************************/
+
+// Read the sources into their buffer with the global thread pool, when
+// GDAL_NUM_THREADS is set. Sources reading the same dataset are put in the
+// same job. Returns false, without doing anything, if it cannot be used, in
+// which case eErr is not set.
+
+bool VRTDerivedRasterBand::LoadSourcesMultiThreaded(
+    int nBufferCount, const std::vector<int> &anMapBufferIdxToSourceIdx,
+    const GDALRasterIOExtraArg *psExtraArg,
+    const std::function<CPLErr(int, VRTSource::WorkingState &)> &LoadSource,
+    CPLErr &eErr)
+{
+    // Progress callbacks are not necessarily thread-safe.
+    if (nBufferCount < 2 || (psExtraArg->pfnProgress != nullptr &&
+                             psExtraArg->pfnProgress != GDALDummyProgress))
+        return false;
+
+    const char *pszValue = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszValue == nullptr)
+        return false;
+    int nThreads =
+        EQUAL(pszValue, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszValue);
+    if (nThreads > 1024)
+        nThreads = 1024;  // to please Coverity
+    if (nThreads <= 1)
+        return false;
+
+    struct Job
+    {
+        const std::function<CPLErr(int, VRTSource::WorkingState &)>
+            *pLoadSource = nullptr;
+        std::vector<int> anBuffers{};
+        std::atomic<bool> *pbFailure = nullptr;
+
+        static void Run(void *pData)
+        {
+            Job *psJob = static_cast<Job *>(pData);
+            VRTSource::WorkingState oWorkingState;
+            for (const int iBuffer : psJob->anBuffers)
+            {
+                if (*(psJob->pbFailure))
+                    break;
+                if ((*psJob->pLoadSource)(iBuffer, oWorkingState) != CE_None)
+                    *(psJob->pbFailure) = true;
+            }
+        }
+    };
+
+    // Group the sources by dataset. Sources are opened here, as opening them
+    // from several threads is not safe. Other kinds of sources are all read
+    // by the same job.
+    std::atomic<bool> bFailure{false};
+    std::vector<std::unique_ptr<Job>> apoJobs;
+    std::map<std::string, Job *> oMapDatasetToJob;
+    for (int iBuffer = 0; iBuffer < nBufferCount; ++iBuffer)
+    {
+        std::string osKey;
+        VRTSource *poSource = papoSources[anMapBufferIdxToSourceIdx[iBuffer]];
+        if (poSource->IsSimpleSource())
+        {
+            auto poSrcBand =
+                cpl::down_cast<VRTSimpleSource *>(poSource)->GetRasterBand();
+            auto poSrcDS = poSrcBand ? poSrcBand->GetDataset() : nullptr;
+            if (poSrcDS == nullptr)
+                return false;
+            // Datasets of the MEM driver are identified by their pointer,
+            // others by their name, as distinct GDALProxyPoolDataset may
+            // share the same underlying dataset.
+            const auto poDriver = poSrcDS->GetDriver();
+            if (poDriver && EQUAL(poDriver->GetDescription(), "MEM"))
+                osKey = CPLSPrintf("%p", poSrcDS);
+            else
+                osKey = std::string("file:").append(poSrcDS->GetDescription());
+        }
+        Job *&psJob = oMapDatasetToJob[osKey];
+        if (psJob == nullptr)
+        {
+            apoJobs.push_back(std::make_unique<Job>());
+            psJob = apoJobs.back().get();
+            psJob->pLoadSource = &LoadSource;
+            psJob->pbFailure = &bFailure;
+        }
+        psJob->anBuffers.push_back(iBuffer);
+    }
+    if (apoJobs.size() < 2)
+        return false;
+
+    CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    auto poQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    if (poQueue == nullptr)
+        return false;
+
+    CPLDebugOnly("VRT", "Reading %d sources with %d jobs in parallel",
+                 nBufferCount, static_cast<int>(apoJobs.size()));
+    for (auto &poJob : apoJobs)
+    {
+        if (!poQueue->SubmitJob(Job::Run, poJob.get()))
+        {
+            bFailure = true;
+            break;
+        }
+    }
+    poQueue->WaitCompletion();
+
+    eErr = bFailure ? CE_Failure : CE_None;
+    return true;
+}
+
+/************************************************************************/
+/*                             IReadBlock()                             */
+/************************************************************************/
+
+// With a Python pixel function, and when GDAL_VRT_PYTHON_BATCH_BLOCKS is
+// set, compute the following blocks of the same row that are not in the
+// block cache yet with the same call of the function, and put them in the
+// block cache.
+
+CPLErr VRTDerivedRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff,
+                                        void *pImage)
+
+{
+    int nMaxBlocks = 1;
+    if (EQUAL(m_poPrivate->m_osLanguage, "Python"))
+    {
+        nMaxBlocks = std::min(
+            atoi(CPLGetConfigOption("GDAL_VRT_PYTHON_BATCH_BLOCKS", "1")),
+            nBlocksPerRow - nBlockXOff);
+    }
+    int nBlocks = 1;
+    while (nBlocks < nMaxBlocks)
+    {
+        GDALRasterBlock *poBlock =
+            TryGetLockedBlockRef(nBlockXOff + nBlocks, nBlockYOff);
+        if (poBlock)
+        {
+            poBlock->DropLock();
+            break;
+        }
+        ++nBlocks;
+    }
+    if (nBlocks == 1)
+        return VRTSourcedRasterBand::IReadBlock(nBlockXOff, nBlockYOff, pImage);
+
+    const int nPixelSize = GDALGetDataTypeSizeBytes(eDataType);
+    const int nXOff = nBlockXOff * nBlockXSize;
+    const int nYOff = nBlockYOff * nBlockYSize;
+    const int nReadXSize =
+        static_cast<int>(std::min(static_cast<GIntBig>(nBlocks) * nBlockXSize,
+                                  static_cast<GIntBig>(nRasterXSize - nXOff)));
+    const int nReadYSize = std::min(nBlockYSize, nRasterYSize - nYOff);
+    GByte *pabyBuffer = static_cast<GByte *>(
+        VSI_MALLOC3_VERBOSE(nPixelSize, nReadXSize, nReadYSize));
+    if (pabyBuffer == nullptr)
+        return CE_Failure;
+
+    GDALRasterIOExtraArg sExtraArg;
+    INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+    const CPLErr eErr =
+        IRasterIO(GF_Read, nXOff, nYOff, nReadXSize, nReadYSize, pabyBuffer,
+                  nReadXSize, nReadYSize, eDataType, nPixelSize,
+                  static_cast<GSpacing>(nPixelSize) * nReadXSize, &sExtraArg);
+
+    for (int i = 0; eErr == CE_None && i < nBlocks; ++i)
+    {
+        GDALRasterBlock *poBlock = nullptr;
+        GByte *pabyDst = static_cast<GByte *>(pImage);
+        if (i > 0)
+        {
+            poBlock = GetLockedBlockRef(nBlockXOff + i, nBlockYOff, TRUE);
+            if (poBlock == nullptr)
+                break;
+            pabyDst = static_cast<GByte *>(poBlock->GetDataRef());
+        }
+        const int nCopyXSize =
+            std::min(nBlockXSize, nReadXSize - i * nBlockXSize);
+        for (int iY = 0; iY < nReadYSize; ++iY)
+        {
+            memcpy(pabyDst +
+                       static_cast<size_t>(iY) * nBlockXSize * nPixelSize,
+                   pabyBuffer + (static_cast<size_t>(iY) * nReadXSize +
+                                 static_cast<size_t>(i) * nBlockXSize) *
+                                    nPixelSize,
+                   static_cast<size_t>(nCopyXSize) * nPixelSize);
+        }
+        if (poBlock)
+            poBlock->DropLock();
+    }
+
+    VSIFree(pabyBuffer);
+    return eErr;
+}
+
 /************************************************************************/
 /*                             IRasterIO()                              */
 /************************************************************************/
@@ -889,12 +1200,6 @@ CPLErr VRTDerivedRasterBand::IRasterIO(
     }
 
     const int nBufTypeSize = GDALGetDataTypeSizeBytes(eBufType);
-    GDALDataType eSrcType = eSourceTransferType;
-    if (eSrcType == GDT_Unknown || eSrcType >= GDT_TypeCount)
-    {
-        eSrcType = eBufType;
-    }
-    const int nSrcTypeSize = GDALGetDataTypeSizeBytes(eSrcType);
 
     /* -------------------------------------------------------------------- */
     /*      Initialize the buffer to some background value. Use the         */
@@ -937,6 +1242,7 @@ CPLErr VRTDerivedRasterBand::IRasterIO(
     /* ---- Get pixel function for band ---- */
     std::pair<PixelFunc, CPLString> *poPixelFunc = nullptr;
     std::vector<std::pair<CPLString, CPLString>> oAdditionalArgs;
+    bool bSupportsNativeSourceTypes = false;
 
     if (EQUAL(m_poPrivate->m_osLanguage, "C"))
     {
@@ -953,13 +1259,37 @@ CPLErr VRTDerivedRasterBand::IRasterIO(
         if (poPixelFunc->second != "")
         {
             if (GetPixelFunctionArguments(poPixelFunc->second,
-                                          oAdditionalArgs) != CE_None)
+                                          oAdditionalArgs,
+                                          bSupportsNativeSourceTypes) !=
+                CE_None)
             {
                 return CE_Failure;
             }
         }
     }
 
+    GDALDataType eSrcType = eSourceTransferType;
+    if (eSrcType == GDT_Unknown || eSrcType >= GDT_TypeCount)
+    {
+        eSrcType = eBufType;
+
+        // Read the sources in their own data type when it is smaller, and
+        // the pixel function can deal with it, to save memory bandwidth.
+        if (bSupportsNativeSourceTypes &&
+            ((nBufXSize == nXSize && nBufYSize == nYSize) ||
+             psExtraArg->eResampleAlg == GRIORA_NearestNeighbour))
+        {
+            const GDALDataType eNativeType = GetNativeSourceType();
+            if (eNativeType != GDT_Unknown &&
+                GDALGetDataTypeSizeBytes(eNativeType) <
+                    GDALGetDataTypeSizeBytes(eSrcType))
+            {
+                eSrcType = eNativeType;
+            }
+        }
+    }
+    const int nSrcTypeSize = GDALGetDataTypeSizeBytes(eSrcType);
+
     /* TODO: It would be nice to use a MallocBlock function for each
        individual buffer that would recycle blocks of memory from a
        cache by reassigning blocks that are nearly the same size.
@@ -976,9 +1306,39 @@ CPLErr VRTDerivedRasterBand::IRasterIO(
     }
     const int nExtBufXSize = nBufXSize + 2 * nBufferRadius;
     const int nExtBufYSize = nBufYSize + 2 * nBufferRadius;
+
+    // Python pixel functions reuse the buffers, and the NumPy arrays
+    // wrapping them, of the previous call when they are not too large.
+    const bool bIsPython = EQUAL(m_poPrivate->m_osLanguage, "Python");
+    const size_t nExtBufPixels =
+        static_cast<size_t>(nExtBufXSize) * nExtBufYSize;
+    const bool bUseCachedBuffers =
+        bIsPython && eSrcType != GDT_CInt16 && eSrcType != GDT_CInt32 &&
+        nExtBufPixels <= MAX_CACHED_PYTHON_BUFFER_SIZE /
+                             std::max(nSrcTypeSize,
+                                      GDALGetDataTypeSizeBytes(eDataType));
+    if (bUseCachedBuffers &&
+        (m_poPrivate->m_eCachedSrcType != eSrcType ||
+         m_poPrivate->m_nCachedXSize != nExtBufXSize ||
+         m_poPrivate->m_nCachedYSize != nExtBufYSize))
+    {
+        m_poPrivate->ResetCachedBuffers(eSrcType, nExtBufXSize, nExtBufYSize);
+    }
+
     int nBufferCount = 0;
     void **pBuffers =
         static_cast<void **>(CPLMalloc(sizeof(void *) * nSources));
+    const auto FreeBuffers = [&pBuffers, &nBufferCount, bUseCachedBuffers]()
+    {
+        if (!bUseCachedBuffers)
+        {
+            for (int i = 0; i < nBufferCount; i++)
+            {
+                VSIFree(pBuffers[i]);
+            }
+        }
+        CPLFree(pBuffers);
+    };
     std::vector<int> anMapBufferIdxToSourceIdx(nSources);
     for (int iSource = 0; iSource < nSources; iSource++)
     {
@@ -999,11 +1359,7 @@ CPLErr VRTDerivedRasterBand::IRasterIO(
             {
                 if (bError)
                 {
-                    for (int i = 0; i < nBufferCount; i++)
-                    {
-                        VSIFree(pBuffers[i]);
-                    }
-                    CPLFree(pBuffers);
+                    FreeBuffers();
                     return CE_Failure;
                 }
 
@@ -1014,14 +1370,13 @@ CPLErr VRTDerivedRasterBand::IRasterIO(
 
         anMapBufferIdxToSourceIdx[nBufferCount] = iSource;
         pBuffers[nBufferCount] =
-            VSI_MALLOC3_VERBOSE(nSrcTypeSize, nExtBufXSize, nExtBufYSize);
+            bUseCachedBuffers
+                ? m_poPrivate->GetCachedSrcBuffer(nBufferCount)
+                : VSI_MALLOC3_VERBOSE(nSrcTypeSize, nExtBufXSize,
+                                      nExtBufYSize);
         if (pBuffers[nBufferCount] == nullptr)
         {
-            for (int i = 0; i < nBufferCount; i++)
-            {
-                VSIFree(pBuffers[i]);
-            }
-            CPLFree(pBuffers);
+            FreeBuffers();
             return CE_Failure;
         }
 
@@ -1052,7 +1407,7 @@ CPLErr VRTDerivedRasterBand::IRasterIO(
     // output buffer.
     if (nBufferCount == 0 && m_poPrivate->m_bSkipNonContributingSources)
     {
-        CPLFree(pBuffers);
+        FreeBuffers();
         return CE_None;
     }
 
@@ -1124,21 +1479,21 @@ CPLErr VRTDerivedRasterBand::IRasterIO(
     }
 
     // Load values for sources into packed buffers.
-    CPLErr eErr = CE_None;
-    VRTSource::WorkingState oWorkingState;
-    for (int iBuffer = 0; iBuffer < nBufferCount && eErr == CE_None; iBuffer++)
+    const std::function<CPLErr(int, VRTSource::WorkingState &)> LoadSource =
+        [&](int iBuffer, VRTSource::WorkingState &oWorkingState)
     {
         const int iSource = anMapBufferIdxToSourceIdx[iBuffer];
         GByte *pabyBuffer = static_cast<GByte *>(pBuffers[iBuffer]);
-        eErr = static_cast<VRTSource *>(papoSources[iSource])
-                   ->RasterIO(
-                       eSrcType, nXOffExt, nYOffExt, nXSizeExt, nYSizeExt,
-                       pabyBuffer +
-                           (nYShiftInBuffer * nExtBufXSize + nXShiftInBuffer) *
-                               nSrcTypeSize,
-                       nExtBufXSizeReq, nExtBufYSizeReq, eSrcType, nSrcTypeSize,
-                       static_cast<GSpacing>(nSrcTypeSize) * nExtBufXSize,
-                       &sExtraArg, oWorkingState);
+        const CPLErr eErrSource =
+            static_cast<VRTSource *>(papoSources[iSource])
+                ->RasterIO(
+                    eSrcType, nXOffExt, nYOffExt, nXSizeExt, nYSizeExt,
+                    pabyBuffer +
+                        (nYShiftInBuffer * nExtBufXSize + nXShiftInBuffer) *
+                            nSrcTypeSize,
+                    nExtBufXSizeReq, nExtBufYSizeReq, eSrcType, nSrcTypeSize,
+                    static_cast<GSpacing>(nSrcTypeSize) * nExtBufXSize,
+                    &sExtraArg, oWorkingState);
 
         // Extend first lines
         for (int iY = 0; iY < nYShiftInBuffer; iY++)
@@ -1197,6 +1552,19 @@ CPLErr VRTDerivedRasterBand::IRasterIO(
                 }
             }
         }
+        return eErrSource;
+    };
+
+    CPLErr eErr = CE_None;
+    if (!LoadSourcesMultiThreaded(nBufferCount, anMapBufferIdxToSourceIdx,
+                                  psExtraArg, LoadSource, eErr))
+    {
+        VRTSource::WorkingState oWorkingState;
+        for (int iBuffer = 0; iBuffer < nBufferCount && eErr == CE_None;
+             iBuffer++)
+        {
+            eErr = LoadSource(iBuffer, oWorkingState);
+        }
     }
 
     // Apply pixel function.
@@ -1224,10 +1592,25 @@ CPLErr VRTDerivedRasterBand::IRasterIO(
 
         GByte *pabyTmpBuffer = nullptr;
         // Do we need a temporary buffer or can we use directly the output
-        // buffer ?
-        if (nBufferRadius != 0 || eDataType != eBufType ||
-            nPixelSpace != nBufTypeSize ||
-            nLineSpace != static_cast<GSpacing>(nBufTypeSize) * nBufXSize)
+        // buffer ? The cached output buffer is always used, so that the
+        // NumPy array wrapping it can be reused.
+        if (bUseCachedBuffers)
+        {
+            if (m_poPrivate->m_pabyCachedDstBuffer == nullptr)
+            {
+                m_poPrivate->m_pabyCachedDstBuffer =
+                    static_cast<GByte *>(VSI_MALLOC2_VERBOSE(
+                        nExtBufPixels, GDALGetDataTypeSizeBytes(eDataType)));
+                if (!m_poPrivate->m_pabyCachedDstBuffer)
+                    goto end;
+            }
+            pabyTmpBuffer = m_poPrivate->m_pabyCachedDstBuffer;
+            memset(pabyTmpBuffer, 0,
+                   nExtBufPixels * GDALGetDataTypeSizeBytes(eDataType));
+        }
+        else if (nBufferRadius != 0 || eDataType != eBufType ||
+                 nPixelSpace != nBufTypeSize ||
+                 nLineSpace != static_cast<GSpacing>(nBufTypeSize) * nBufXSize)
         {
             pabyTmpBuffer = static_cast<GByte *>(VSI_CALLOC_VERBOSE(
                 static_cast<size_t>(nExtBufXSize) * nExtBufYSize,
@@ -1245,13 +1628,28 @@ CPLErr VRTDerivedRasterBand::IRasterIO(
             GIL_Holder oHolder(bUseExclusiveLock);
 
             // Prepare target numpy array
-            PyObject *poPyDstArray =
-                GDALCreateNumpyArray(m_poPrivate->m_poGDALCreateNumpyArray,
-                                     pabyTmpBuffer ? pabyTmpBuffer : pData,
-                                     eDataType, nExtBufYSize, nExtBufXSize);
+            PyObject *poPyDstArray = nullptr;
+            if (bUseCachedBuffers && m_poPrivate->m_poCachedDstArray)
+            {
+                poPyDstArray = m_poPrivate->m_poCachedDstArray;
+                Py_IncRef(poPyDstArray);
+            }
+            else
+            {
+                poPyDstArray = GDALCreateNumpyArray(
+                    m_poPrivate->m_poGDALCreateNumpyArray,
+                    pabyTmpBuffer ? pabyTmpBuffer : pData, eDataType,
+                    nExtBufYSize, nExtBufXSize);
+                if (poPyDstArray && bUseCachedBuffers)
+                {
+                    m_poPrivate->m_poCachedDstArray = poPyDstArray;
+                    Py_IncRef(poPyDstArray);
+                }
+            }
             if (!poPyDstArray)
             {
-                VSIFree(pabyTmpBuffer);
+                if (!bUseCachedBuffers)
+                    VSIFree(pabyTmpBuffer);
                 goto end;
             }
 
@@ -1259,11 +1657,26 @@ CPLErr VRTDerivedRasterBand::IRasterIO(
             PyObject *pyArgInputArray = PyTuple_New(nBufferCount);
             for (int i = 0; i < nBufferCount; i++)
             {
-                GByte *pabyBuffer = static_cast<GByte *>(pBuffers[i]);
-                PyObject *poPySrcArray = GDALCreateNumpyArray(
-                    m_poPrivate->m_poGDALCreateNumpyArray, pabyBuffer, eSrcType,
-                    nExtBufYSize, nExtBufXSize);
-                CPLAssert(poPySrcArray);
+                PyObject *poPySrcArray =
+                    bUseCachedBuffers ? m_poPrivate->m_apoCachedSrcArrays[i]
+                                      : nullptr;
+                if (poPySrcArray)
+                {
+                    Py_IncRef(poPySrcArray);
+                }
+                else
+                {
+                    GByte *pabyBuffer = static_cast<GByte *>(pBuffers[i]);
+                    poPySrcArray = GDALCreateNumpyArray(
+                        m_poPrivate->m_poGDALCreateNumpyArray, pabyBuffer,
+                        eSrcType, nExtBufYSize, nExtBufXSize);
+                    CPLAssert(poPySrcArray);
+                    if (poPySrcArray && bUseCachedBuffers)
+                    {
+                        m_poPrivate->m_apoCachedSrcArrays[i] = poPySrcArray;
+                        Py_IncRef(poPySrcArray);
+                    }
+                }
                 PyTuple_SetItem(pyArgInputArray, i, poPySrcArray);
             }
 
@@ -1294,25 +1707,30 @@ CPLErr VRTDerivedRasterBand::IRasterIO(
                                 PyFloat_FromDouble(adfGeoTransform[i]));
             PyTuple_SetItem(pyArgs, 9, pyGT);
 
-            // Prepare kwargs
-            PyObject *pyKwargs = PyDict_New();
-            for (size_t i = 0; i < m_poPrivate->m_oFunctionArgs.size(); ++i)
+            // Prepare kwargs, which do not change from one call to another
+            if (m_poPrivate->m_poKwargs == nullptr)
             {
-                const char *pszKey =
-                    m_poPrivate->m_oFunctionArgs[i].first.c_str();
-                const char *pszValue =
-                    m_poPrivate->m_oFunctionArgs[i].second.c_str();
-                PyDict_SetItemString(
-                    pyKwargs, pszKey,
-                    PyBytes_FromStringAndSize(pszValue, strlen(pszValue)));
+                PyObject *pyKwargs = PyDict_New();
+                for (size_t i = 0; i < m_poPrivate->m_oFunctionArgs.size();
+                     ++i)
+                {
+                    const char *pszKey =
+                        m_poPrivate->m_oFunctionArgs[i].first.c_str();
+                    const char *pszValue =
+                        m_poPrivate->m_oFunctionArgs[i].second.c_str();
+                    PyDict_SetItemString(
+                        pyKwargs, pszKey,
+                        PyBytes_FromStringAndSize(pszValue, strlen(pszValue)));
+                }
+                m_poPrivate->m_poKwargs = pyKwargs;
             }
 
             // Call user function
             PyObject *pRetValue =
-                PyObject_Call(m_poPrivate->m_poUserFunction, pyArgs, pyKwargs);
+                PyObject_Call(m_poPrivate->m_poUserFunction, pyArgs,
+                              m_poPrivate->m_poKwargs);
 
             Py_DecRef(pyArgs);
-            Py_DecRef(pyKwargs);
 
             if (ErrOccurredEmitCPLError())
             {
@@ -1342,7 +1760,8 @@ CPLErr VRTDerivedRasterBand::IRasterIO(
                               nBufXSize);
             }
 
-            VSIFree(pabyTmpBuffer);
+            if (!bUseCachedBuffers)
+                VSIFree(pabyTmpBuffer);
         }
     }
     else if (eErr == CE_None && poPixelFunc != nullptr)
@@ -1368,11 +1787,7 @@ CPLErr VRTDerivedRasterBand::IRasterIO(
     }
 end:
     // Release buffers.
-    for (int iBuffer = 0; iBuffer < nBufferCount; iBuffer++)
-    {
-        VSIFree(pBuffers[iBuffer]);
-    }
-    CPLFree(pBuffers);
+    FreeBuffers();
 
     return eErr;
 }
@@ -177,6 +177,20 @@ VRTDriver::ParseSource(CPLXMLNode *psSrc, const char *pszVRTPath,
     return pfnParser(psSrc, pszVRTPath, oMapSharedSources);
 }
 
+/************************************************************************/
+/*                        IsSourceElementName()                         */
+/************************************************************************/
+
+// Whether ParseSource() has a parser for elements of that name.
+
+bool VRTDriver::IsSourceElementName(const char *pszElementName) const
+{
+    if (!m_oMapSourceParser.empty())
+        return m_oMapSourceParser.find(pszElementName) !=
+               m_oMapSourceParser.end();
+    return CSLFetchNameValue(papszSourceParsers, pszElementName) != nullptr;
+}
+
 /************************************************************************/
 /*                           VRTCreateCopy()                            */
 /************************************************************************/
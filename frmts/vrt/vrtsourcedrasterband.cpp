@@ -32,16 +32,21 @@
 #include "vrtdataset.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <functional>
 #include <limits>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -100,6 +105,187 @@ VRTSourcedRasterBand::VRTSourcedRasterBand(GDALDataset *poDSIn, int nBandIn,
 {
 }
 
+/************************************************************************/
+/*                            VRTLazySource                             */
+/************************************************************************/
+
+namespace
+{
+
+// Placeholder for a source of a VRT opened with VRT_LAZY_SOURCES=YES. It
+// keeps the XML definition of the source and its destination window, and
+// only parses it when needed. VRTSourcedRasterBand replaces it with the
+// parsed source once a request intersects it; the other users of the
+// source list go through the forwarding methods below.
+// It is also used for sources added with AddDeferredSource(), which are
+// instantiated by a factory function instead of being parsed.
+class VRTLazySource final : public VRTSource
+{
+    CPLXMLNode *m_psTree = nullptr;
+    std::function<VRTSource *()> m_oFactory{};
+    std::string m_osVRTPath{};
+    bool m_bHasVRTPath = false;
+    std::map<CPLString, GDALDataset *> *m_poMapSharedSources = nullptr;
+    std::unique_ptr<VRTSource> m_poSource{};
+    bool m_bParseFailed = false;
+
+    CPL_DISALLOW_COPY_ASSIGN(VRTLazySource)
+
+  public:
+    double m_dfDstXOff = -1;
+    double m_dfDstYOff = -1;
+    double m_dfDstXSize = -1;
+    double m_dfDstYSize = -1;
+
+    VRTLazySource(const CPLXMLNode *psTree, const char *pszVRTPath,
+                  std::map<CPLString, GDALDataset *> &oMapSharedSources)
+        : m_psTree(CPLCloneXMLTree(psTree)),
+          m_osVRTPath(pszVRTPath ? pszVRTPath : ""),
+          m_bHasVRTPath(pszVRTPath != nullptr),
+          m_poMapSharedSources(&oMapSharedSources)
+    {
+        const CPLXMLNode *psDstRect = CPLGetXMLNode(psTree, "DstRect");
+        if (psDstRect)
+        {
+            m_dfDstXOff = CPLAtof(CPLGetXMLValue(psDstRect, "xOff", "-1"));
+            m_dfDstYOff = CPLAtof(CPLGetXMLValue(psDstRect, "yOff", "-1"));
+            m_dfDstXSize = CPLAtof(CPLGetXMLValue(psDstRect, "xSize", "-1"));
+            m_dfDstYSize = CPLAtof(CPLGetXMLValue(psDstRect, "ySize", "-1"));
+        }
+    }
+
+    VRTLazySource(double dfDstXOff, double dfDstYOff, double dfDstXSize,
+                  double dfDstYSize, std::function<VRTSource *()> &&oFactory)
+        : m_oFactory(std::move(oFactory)), m_dfDstXOff(dfDstXOff),
+          m_dfDstYOff(dfDstYOff), m_dfDstXSize(dfDstXSize),
+          m_dfDstYSize(dfDstYSize)
+    {
+    }
+
+    ~VRTLazySource() override
+    {
+        CPLDestroyXMLNode(m_psTree);
+    }
+
+    // Return the parsed source, or nullptr in case of error.
+    VRTSource *GetSource()
+    {
+        if (!m_poSource && !m_bParseFailed && !m_psTree)
+        {
+            m_poSource.reset(m_oFactory());
+            m_bParseFailed = m_poSource == nullptr;
+            if (m_bParseFailed)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Cannot instantiate VRT source");
+            }
+        }
+        else if (!m_poSource && !m_bParseFailed)
+        {
+            VRTDriver *poDriver =
+                static_cast<VRTDriver *>(GDALGetDriverByName("VRT"));
+            if (poDriver)
+                m_poSource.reset(poDriver->ParseSource(
+                    m_psTree, m_bHasVRTPath ? m_osVRTPath.c_str() : nullptr,
+                    *m_poMapSharedSources));
+            m_bParseFailed = m_poSource == nullptr;
+            if (m_bParseFailed)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Cannot parse VRT source %s", m_psTree->pszValue);
+            }
+        }
+        return m_poSource.get();
+    }
+
+    // Return the parsed source, whose ownership is transferred to the
+    // caller, or nullptr in case of error.
+    VRTSource *ReleaseSource()
+    {
+        GetSource();
+        return m_poSource.release();
+    }
+
+    CPLErr RasterIO(GDALDataType eVRTBandDataType, int nXOff, int nYOff,
+                    int nXSize, int nYSize, void *pData, int nBufXSize,
+                    int nBufYSize, GDALDataType eBufType, GSpacing nPixelSpace,
+                    GSpacing nLineSpace, GDALRasterIOExtraArg *psExtraArg,
+                    WorkingState &oWorkingState) override
+    {
+        VRTSource *poSource = GetSource();
+        if (!poSource)
+            return CE_Failure;
+        return poSource->RasterIO(eVRTBandDataType, nXOff, nYOff, nXSize,
+                                  nYSize, pData, nBufXSize, nBufYSize,
+                                  eBufType, nPixelSpace, nLineSpace,
+                                  psExtraArg, oWorkingState);
+    }
+
+    double GetMinimum(int nXSize, int nYSize, int *pbSuccess) override
+    {
+        VRTSource *poSource = GetSource();
+        if (!poSource)
+        {
+            *pbSuccess = FALSE;
+            return 0;
+        }
+        return poSource->GetMinimum(nXSize, nYSize, pbSuccess);
+    }
+
+    double GetMaximum(int nXSize, int nYSize, int *pbSuccess) override
+    {
+        VRTSource *poSource = GetSource();
+        if (!poSource)
+        {
+            *pbSuccess = FALSE;
+            return 0;
+        }
+        return poSource->GetMaximum(nXSize, nYSize, pbSuccess);
+    }
+
+    CPLErr GetHistogram(int nXSize, int nYSize, double dfMin, double dfMax,
+                        int nBuckets, GUIntBig *panHistogram,
+                        int bIncludeOutOfRange, int bApproxOK,
+                        GDALProgressFunc pfnProgress,
+                        void *pProgressData) override
+    {
+        VRTSource *poSource = GetSource();
+        if (!poSource)
+            return CE_Failure;
+        return poSource->GetHistogram(nXSize, nYSize, dfMin, dfMax, nBuckets,
+                                      panHistogram, bIncludeOutOfRange,
+                                      bApproxOK, pfnProgress, pProgressData);
+    }
+
+    CPLErr XMLInit(CPLXMLNode *, const char *,
+                   std::map<CPLString, GDALDataset *> &) override
+    {
+        return CE_Failure;
+    }
+
+    CPLXMLNode *SerializeToXML(const char *pszVRTPath) override
+    {
+        VRTSource *poSource = GetSource();
+        return poSource ? poSource->SerializeToXML(pszVRTPath) : nullptr;
+    }
+
+    void GetFileList(char ***ppapszFileList, int *pnSize, int *pnMaxSize,
+                     CPLHashSet *hSetFiles) override
+    {
+        VRTSource *poSource = GetSource();
+        if (poSource)
+            poSource->GetFileList(ppapszFileList, pnSize, pnMaxSize,
+                                  hSetFiles);
+    }
+
+    CPLErr FlushCache(bool bAtClosing) override
+    {
+        return m_poSource ? m_poSource->FlushCache(bAtClosing) : CE_None;
+    }
+};
+
+}  // namespace
+
 /************************************************************************/
 /*                        VRTSourcedRasterBand()                        */
 /************************************************************************/
@@ -130,6 +316,150 @@ VRTSourcedRasterBand::~VRTSourcedRasterBand()
 {
     VRTSourcedRasterBand::CloseDependentDatasets();
     CSLDestroy(m_papszSourceList);
+    InvalidateSourcesIndex();
+}
+
+/************************************************************************/
+/*                       InvalidateSourcesIndex()                       */
+/************************************************************************/
+
+void VRTSourcedRasterBand::InvalidateSourcesIndex()
+{
+    if (m_hSourcesIndex)
+        CPLQuadTreeDestroy(m_hSourcesIndex);
+    m_hSourcesIndex = nullptr;
+    m_nSourcesIndexCount = 0;
+    m_papoSourcesIndexed = nullptr;
+}
+
+/************************************************************************/
+/*                    GetSourcesIntersectingWindow()                    */
+/************************************************************************/
+
+// Minimum number of sources from which a spatial index of their destination
+// windows is used to find the sources intersecting a request.
+constexpr int VRT_SOURCES_INDEX_MIN_COUNT = 64;
+
+// Set anSources to the indices, in increasing order, of the sources that may
+// contribute to the window (in pixel coordinates of the band). Those of them
+// that are still lazy sources are parsed.
+
+void VRTSourcedRasterBand::GetSourcesIntersectingWindow(
+    double dfXOff, double dfYOff, double dfXSize, double dfYSize,
+    std::vector<int> &anSources)
+{
+    anSources.clear();
+    if (nSources < VRT_SOURCES_INDEX_MIN_COUNT)
+    {
+        for (int i = 0; i < nSources; i++)
+            anSources.push_back(i);
+        MaterializeLazySources(anSources);
+        return;
+    }
+
+    // nSources and papoSources may be directly modified by other classes.
+    if (m_hSourcesIndex == nullptr || m_nSourcesIndexCount != nSources ||
+        m_papoSourcesIndexed != papoSources)
+    {
+        InvalidateSourcesIndex();
+
+        CPLRectObj sGlobalBounds;
+        sGlobalBounds.minx = 0;
+        sGlobalBounds.miny = 0;
+        sGlobalBounds.maxx = nRasterXSize;
+        sGlobalBounds.maxy = nRasterYSize;
+        m_hSourcesIndex = CPLQuadTreeCreate(&sGlobalBounds, nullptr);
+
+        for (int i = 0; i < nSources; i++)
+        {
+            // Sources other than simple ones, or without destination
+            // window, may contribute to the whole raster.
+            CPLRectObj sBounds = sGlobalBounds;
+            double dfDstXOff = -1;
+            double dfDstYOff = -1;
+            double dfDstXSize = -1;
+            double dfDstYSize = -1;
+            if (papoSources[i]->IsSimpleSource())
+            {
+                cpl::down_cast<VRTSimpleSource *>(papoSources[i])
+                    ->GetDstWindow(dfDstXOff, dfDstYOff, dfDstXSize,
+                                   dfDstYSize);
+            }
+            else if (m_bHasLazySources)
+            {
+                const auto poLazySource =
+                    dynamic_cast<const VRTLazySource *>(papoSources[i]);
+                if (poLazySource)
+                {
+                    dfDstXOff = poLazySource->m_dfDstXOff;
+                    dfDstYOff = poLazySource->m_dfDstYOff;
+                    dfDstXSize = poLazySource->m_dfDstXSize;
+                    dfDstYSize = poLazySource->m_dfDstYSize;
+                }
+            }
+            if (dfDstXOff != -1 && dfDstYOff != -1 && dfDstXSize != -1 &&
+                dfDstYSize != -1)
+            {
+                sBounds.minx = dfDstXOff;
+                sBounds.miny = dfDstYOff;
+                sBounds.maxx = dfDstXOff + dfDstXSize;
+                sBounds.maxy = dfDstYOff + dfDstYSize;
+            }
+            CPLQuadTreeInsertWithBounds(
+                m_hSourcesIndex,
+                reinterpret_cast<void *>(static_cast<uintptr_t>(i)), &sBounds);
+        }
+        m_nSourcesIndexCount = nSources;
+        m_papoSourcesIndexed = papoSources;
+    }
+
+    CPLRectObj sBounds;
+    sBounds.minx = dfXOff;
+    sBounds.miny = dfYOff;
+    sBounds.maxx = dfXOff + dfXSize;
+    sBounds.maxy = dfYOff + dfYSize;
+    int nFeatureCount = 0;
+    void **pahRet =
+        CPLQuadTreeSearch(m_hSourcesIndex, &sBounds, &nFeatureCount);
+    anSources.reserve(nFeatureCount);
+    for (int k = 0; k < nFeatureCount; k++)
+    {
+        anSources.push_back(
+            static_cast<int>(reinterpret_cast<uintptr_t>(pahRet[k])));
+    }
+    CPLFree(pahRet);
+
+    // Painter's order
+    std::sort(anSources.begin(), anSources.end());
+
+    MaterializeLazySources(anSources);
+}
+
+/************************************************************************/
+/*                       MaterializeLazySources()                       */
+/************************************************************************/
+
+// Replace the lazy sources among the given ones by their parsed source. The
+// ones that cannot be parsed are left as they are, and will report the error
+// when read.
+
+void VRTSourcedRasterBand::MaterializeLazySources(
+    const std::vector<int> &anSources)
+{
+    if (!m_bHasLazySources)
+        return;
+    for (const int iSource : anSources)
+    {
+        auto poLazySource = dynamic_cast<VRTLazySource *>(papoSources[iSource]);
+        if (poLazySource == nullptr)
+            continue;
+        VRTSource *poSource = poLazySource->ReleaseSource();
+        if (poSource == nullptr)
+            continue;
+        delete poLazySource;
+        papoSources[iSource] = poSource;
+        ApplyNBitsToSource(poSource);
+    }
 }
 
 /************************************************************************/
@@ -239,6 +569,246 @@ bool VRTSourcedRasterBand::CanIRasterIOBeForwardedToEachSource(
     return true;
 }
 
+/************************************************************************/
+/*                       IRasterIOMultiThreaded()                       */
+/************************************************************************/
+
+// Implementation of IRasterIO() reading the sources with the global thread
+// pool, when GDAL_NUM_THREADS is set. Sources whose output windows overlap,
+// or that read the same dataset, are put in the same job and read in their
+// order, so that the last one still wins where they overlap. The jobs then
+// write to distinct parts of the buffer and use distinct source datasets.
+// Returns false, without doing anything, if it cannot be used, in which case
+// eErr is not set.
+
+bool VRTSourcedRasterBand::IRasterIOMultiThreaded(
+    int nXOff, int nYOff, int nXSize, int nYSize, void *pData, int nBufXSize,
+    int nBufYSize, GDALDataType eBufType, GSpacing nPixelSpace,
+    GSpacing nLineSpace, GDALRasterIOExtraArg *psExtraArg, CPLErr &eErr)
+{
+    // Progress callbacks are not necessarily thread-safe.
+    if (nSources < 2 || (psExtraArg->pfnProgress != nullptr &&
+                         psExtraArg->pfnProgress != GDALDummyProgress))
+        return false;
+
+    const char *pszValue = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszValue == nullptr)
+        return false;
+    int nThreads =
+        EQUAL(pszValue, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszValue);
+    if (nThreads > 1024)
+        nThreads = 1024;  // to please Coverity
+    if (nThreads <= 1)
+        return false;
+
+    double dfXOff = nXOff;
+    double dfYOff = nYOff;
+    double dfXSize = nXSize;
+    double dfYSize = nYSize;
+    if (psExtraArg->bFloatingPointWindowValidity)
+    {
+        dfXOff = psExtraArg->dfXOff;
+        dfYOff = psExtraArg->dfYOff;
+        dfXSize = psExtraArg->dfXSize;
+        dfYSize = psExtraArg->dfYSize;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Collect the sources intersecting the request, with their        */
+    /*      window in the buffer. Sources are opened here, as opening       */
+    /*      them from several threads is not safe.                          */
+    /* -------------------------------------------------------------------- */
+    struct SourceWindow
+    {
+        int iSource = 0;
+        int nOutXOff = 0;
+        int nOutYOff = 0;
+        int nOutXSize = 0;
+        int nOutYSize = 0;
+        GDALDataset *poSrcDS = nullptr;
+    };
+
+    std::vector<int> anSources;
+    GetSourcesIntersectingWindow(dfXOff, dfYOff, dfXSize, dfYSize, anSources);
+
+    std::vector<SourceWindow> asWindows;
+    for (const int iSource : anSources)
+    {
+        if (!papoSources[iSource]->IsSimpleSource())
+            return false;
+        auto poSource = cpl::down_cast<VRTSimpleSource *>(papoSources[iSource]);
+        auto poSrcBand = poSource->GetRasterBand();
+        if (poSrcBand == nullptr || poSrcBand->GetDataset() == nullptr)
+            return false;
+
+        double dfReqXOff = 0.0;
+        double dfReqYOff = 0.0;
+        double dfReqXSize = 0.0;
+        double dfReqYSize = 0.0;
+        int nReqXOff = 0;
+        int nReqYOff = 0;
+        int nReqXSize = 0;
+        int nReqYSize = 0;
+        SourceWindow sWindow;
+        bool bError = false;
+        if (!poSource->GetSrcDstWindow(
+                dfXOff, dfYOff, dfXSize, dfYSize, nBufXSize, nBufYSize,
+                &dfReqXOff, &dfReqYOff, &dfReqXSize, &dfReqYSize, &nReqXOff,
+                &nReqYOff, &nReqXSize, &nReqYSize, &sWindow.nOutXOff,
+                &sWindow.nOutYOff, &sWindow.nOutXSize, &sWindow.nOutYSize,
+                bError))
+        {
+            if (bError)
+                return false;
+            continue;
+        }
+        sWindow.iSource = iSource;
+        sWindow.poSrcDS = poSrcBand->GetDataset();
+        asWindows.push_back(sWindow);
+    }
+    if (asWindows.size() < 2)
+        return false;
+
+    /* -------------------------------------------------------------------- */
+    /*      Group the sources that overlap or share a dataset.              */
+    /* -------------------------------------------------------------------- */
+    const int nWindows = static_cast<int>(asWindows.size());
+    std::vector<int> anParent(nWindows);
+    for (int i = 0; i < nWindows; ++i)
+        anParent[i] = i;
+    const auto FindRoot = [&anParent](int i)
+    {
+        while (anParent[i] != i)
+        {
+            anParent[i] = anParent[anParent[i]];
+            i = anParent[i];
+        }
+        return i;
+    };
+
+    for (int i = 0; i < nWindows; ++i)
+    {
+        const auto &sA = asWindows[i];
+        const auto poDriverA = sA.poSrcDS->GetDriver();
+        const bool bIsMEMA =
+            poDriverA && EQUAL(poDriverA->GetDescription(), "MEM");
+        for (int j = i + 1; j < nWindows; ++j)
+        {
+            const auto &sB = asWindows[j];
+            bool bConflict = sA.nOutXOff < sB.nOutXOff + sB.nOutXSize &&
+                             sB.nOutXOff < sA.nOutXOff + sA.nOutXSize &&
+                             sA.nOutYOff < sB.nOutYOff + sB.nOutYSize &&
+                             sB.nOutYOff < sA.nOutYOff + sA.nOutYSize;
+            // Datasets of the MEM driver are identified by their pointer,
+            // others also by their name, as distinct GDALProxyPoolDataset
+            // may share the same underlying dataset.
+            if (!bConflict)
+                bConflict = sA.poSrcDS == sB.poSrcDS ||
+                            (!bIsMEMA && strcmp(sA.poSrcDS->GetDescription(),
+                                                sB.poSrcDS->GetDescription()) ==
+                                             0);
+            if (bConflict)
+            {
+                const int iRootA = FindRoot(i);
+                const int iRootB = FindRoot(j);
+                if (iRootA != iRootB)
+                    anParent[std::max(iRootA, iRootB)] =
+                        std::min(iRootA, iRootB);
+            }
+        }
+    }
+
+    struct Job
+    {
+        VRTSourcedRasterBand *poBand = nullptr;
+        std::vector<int> anSources{};
+        int nXOff = 0;
+        int nYOff = 0;
+        int nXSize = 0;
+        int nYSize = 0;
+        void *pData = nullptr;
+        int nBufXSize = 0;
+        int nBufYSize = 0;
+        GDALDataType eBufType = GDT_Unknown;
+        GSpacing nPixelSpace = 0;
+        GSpacing nLineSpace = 0;
+        GDALRasterIOExtraArg sExtraArg{};
+        std::atomic<bool> *pbFailure = nullptr;
+
+        static void Run(void *pData)
+        {
+            Job *psJob = static_cast<Job *>(pData);
+            VRTSource::WorkingState oWorkingState;
+            for (const int iSource : psJob->anSources)
+            {
+                if (*(psJob->pbFailure))
+                    break;
+                if (psJob->poBand->papoSources[iSource]->RasterIO(
+                        psJob->poBand->eDataType, psJob->nXOff, psJob->nYOff,
+                        psJob->nXSize, psJob->nYSize, psJob->pData,
+                        psJob->nBufXSize, psJob->nBufYSize, psJob->eBufType,
+                        psJob->nPixelSpace, psJob->nLineSpace,
+                        &psJob->sExtraArg, oWorkingState) != CE_None)
+                {
+                    *(psJob->pbFailure) = true;
+                }
+            }
+        }
+    };
+
+    std::atomic<bool> bFailure{false};
+    std::vector<std::unique_ptr<Job>> apoJobs;
+    std::map<int, Job *> oMapRootToJob;
+    for (int i = 0; i < nWindows; ++i)
+    {
+        Job *&psJob = oMapRootToJob[FindRoot(i)];
+        if (psJob == nullptr)
+        {
+            apoJobs.push_back(std::make_unique<Job>());
+            psJob = apoJobs.back().get();
+            psJob->poBand = this;
+            psJob->nXOff = nXOff;
+            psJob->nYOff = nYOff;
+            psJob->nXSize = nXSize;
+            psJob->nYSize = nYSize;
+            psJob->pData = pData;
+            psJob->nBufXSize = nBufXSize;
+            psJob->nBufYSize = nBufYSize;
+            psJob->eBufType = eBufType;
+            psJob->nPixelSpace = nPixelSpace;
+            psJob->nLineSpace = nLineSpace;
+            psJob->sExtraArg = *psExtraArg;
+            psJob->sExtraArg.pfnProgress = nullptr;
+            psJob->sExtraArg.pProgressData = nullptr;
+            psJob->pbFailure = &bFailure;
+        }
+        psJob->anSources.push_back(asWindows[i].iSource);
+    }
+    if (apoJobs.size() < 2)
+        return false;
+
+    CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    auto poQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    if (poQueue == nullptr)
+        return false;
+
+    CPLDebugOnly("VRT",
+                 "IRasterIO(): reading %d sources with %d jobs in parallel",
+                 nWindows, static_cast<int>(apoJobs.size()));
+    for (auto &poJob : apoJobs)
+    {
+        if (!poQueue->SubmitJob(Job::Run, poJob.get()))
+        {
+            bFailure = true;
+            break;
+        }
+    }
+    poQueue->WaitCompletion();
+
+    eErr = bFailure ? CE_Failure : CE_None;
+    return true;
+}
+
 /************************************************************************/
 /*                             IRasterIO()                              */
 /************************************************************************/
@@ -351,19 +921,39 @@ CPLErr VRTSourcedRasterBand::IRasterIO(
         }
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Read independent sources in parallel if possible.               */
+    /* -------------------------------------------------------------------- */
+    CPLErr eErr = CE_None;
+    if (IRasterIOMultiThreaded(nXOff, nYOff, nXSize, nYSize, pData, nBufXSize,
+                               nBufYSize, eBufType, nPixelSpace, nLineSpace,
+                               psExtraArg, eErr))
+    {
+        return eErr;
+    }
+
     GDALProgressFunc const pfnProgressGlobal = psExtraArg->pfnProgress;
     void *const pProgressDataGlobal = psExtraArg->pProgressData;
 
     /* -------------------------------------------------------------------- */
     /*      Overlay each source in turn over top this.                      */
     /* -------------------------------------------------------------------- */
-    CPLErr eErr = CE_None;
+    std::vector<int> anSources;
+    if (psExtraArg->bFloatingPointWindowValidity)
+        GetSourcesIntersectingWindow(psExtraArg->dfXOff, psExtraArg->dfYOff,
+                                     psExtraArg->dfXSize, psExtraArg->dfYSize,
+                                     anSources);
+    else
+        GetSourcesIntersectingWindow(nXOff, nYOff, nXSize, nYSize, anSources);
+    const int nSourcesToRead = static_cast<int>(anSources.size());
+
     VRTSource::WorkingState oWorkingState;
-    for (int iSource = 0; eErr == CE_None && iSource < nSources; iSource++)
+    for (int i = 0; eErr == CE_None && i < nSourcesToRead; i++)
     {
+        const int iSource = anSources[i];
         psExtraArg->pfnProgress = GDALScaledProgress;
         psExtraArg->pProgressData = GDALCreateScaledProgress(
-            1.0 * iSource / nSources, 1.0 * (iSource + 1) / nSources,
+            1.0 * i / nSourcesToRead, 1.0 * (i + 1) / nSourcesToRead,
             pfnProgressGlobal, pProgressDataGlobal);
         if (psExtraArg->pProgressData == nullptr)
             psExtraArg->pfnProgress = nullptr;
@@ -1768,12 +2358,41 @@ CPLErr VRTSourcedRasterBand::AddSource(VRTSource *poNewSource)
     papoSources = static_cast<VRTSource **>(
         CPLRealloc(papoSources, sizeof(void *) * nSources));
     papoSources[nSources - 1] = poNewSource;
+    InvalidateSourcesIndex();
 
     static_cast<VRTDataset *>(poDS)->SetNeedsFlush();
 
-    if (poNewSource->IsSimpleSource())
+    ApplyNBitsToSource(poNewSource);
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                         AddDeferredSource()                          */
+/************************************************************************/
+
+// Add a source, of known destination window, that is only instantiated
+// by oFactory when a request intersects it (or when an operation needs
+// all sources).
+
+void VRTSourcedRasterBand::AddDeferredSource(
+    double dfDstXOff, double dfDstYOff, double dfDstXSize, double dfDstYSize,
+    std::function<VRTSource *()> &&oFactory)
+{
+    AddSource(new VRTLazySource(dfDstXOff, dfDstYOff, dfDstXSize, dfDstYSize,
+                                std::move(oFactory)));
+    m_bHasLazySources = true;
+}
+
+/************************************************************************/
+/*                         ApplyNBitsToSource()                         */
+/************************************************************************/
+
+void VRTSourcedRasterBand::ApplyNBitsToSource(VRTSource *poSource)
+{
+    if (poSource->IsSimpleSource())
     {
-        VRTSimpleSource *poSS = static_cast<VRTSimpleSource *>(poNewSource);
+        VRTSimpleSource *poSS = static_cast<VRTSimpleSource *>(poSource);
         if (GetMetadataItem("NBITS", "IMAGE_STRUCTURE") != nullptr)
         {
             int nBits = atoi(GetMetadataItem("NBITS", "IMAGE_STRUCTURE"));
@@ -1783,8 +2402,6 @@ CPLErr VRTSourcedRasterBand::AddSource(VRTSource *poNewSource)
             }
         }
     }
-
-    return CE_None;
 }
 
 /*! @endcond */
@@ -1829,6 +2446,14 @@ CPLErr VRTSourcedRasterBand::XMLInit(
     /* -------------------------------------------------------------------- */
     VRTDriver *const poDriver =
         static_cast<VRTDriver *>(GDALGetDriverByName("VRT"));
+    const char *pszSubclass =
+        CPLGetXMLValue(psTree, "subclass", "VRTSourcedRasterBand");
+
+    // With VRT_LAZY_SOURCES=YES, sources are only parsed when a request
+    // intersects them.
+    const bool bLazySources =
+        EQUAL(pszSubclass, "VRTSourcedRasterBand") &&
+        CPLTestBool(CPLGetConfigOption("VRT_LAZY_SOURCES", "NO"));
 
     for (CPLXMLNode *psChild = psTree->psChild;
          psChild != nullptr && poDriver != nullptr; psChild = psChild->psNext)
@@ -1836,6 +2461,14 @@ CPLErr VRTSourcedRasterBand::XMLInit(
         if (psChild->eType != CXT_Element)
             continue;
 
+        if (bLazySources && poDriver->IsSourceElementName(psChild->pszValue))
+        {
+            AddSource(
+                new VRTLazySource(psChild, pszVRTPath, oMapSharedSources));
+            m_bHasLazySources = true;
+            continue;
+        }
+
         CPLErrorReset();
         VRTSource *const poSource =
             poDriver->ParseSource(psChild, pszVRTPath, oMapSharedSources);
@@ -1848,8 +2481,6 @@ CPLErr VRTSourcedRasterBand::XMLInit(
     /* -------------------------------------------------------------------- */
     /*      Done.                                                           */
     /* -------------------------------------------------------------------- */
-    const char *pszSubclass =
-        CPLGetXMLValue(psTree, "subclass", "VRTSourcedRasterBand");
     if (nSources == 0 && !EQUAL(pszSubclass, "VRTDerivedRasterBand"))
         CPLDebug("VRT", "No valid sources found for band in VRT file %s",
                  GetDataset() ? GetDataset()->GetDescription() : "");
@@ -2553,6 +3184,7 @@ CPLErr VRTSourcedRasterBand::SetMetadataItem(const char *pszName,
         {
             delete papoSources[iSource];
             papoSources[iSource] = poSource;
+            InvalidateSourcesIndex();
             static_cast<VRTDataset *>(poDS)->SetNeedsFlush();
             return CE_None;
         }
@@ -2584,6 +3216,7 @@ CPLErr VRTSourcedRasterBand::SetMetadata(char **papszNewMD,
             CPLFree(papoSources);
             papoSources = nullptr;
             nSources = 0;
+            InvalidateSourcesIndex();
         }
 
         for (int i = 0; i < CSLCount(papszNewMD); i++)
@@ -2653,6 +3286,7 @@ int VRTSourcedRasterBand::CloseDependentDatasets()
     CPLFree(papoSources);
     papoSources = nullptr;
     nSources = 0;
+    InvalidateSourcesIndex();
 
     return TRUE;
 }
@@ -1355,14 +1355,20 @@ CPLErr VRTWarpedDataset::XMLInit(CPLXMLNode *psTree, const char *pszVRTPathIn)
     else
         pszAbsolutePath = CPLStrdup(pszRelativePath);
 
-    CPLSetXMLValue(psOptionsTree, "SourceDataset", pszAbsolutePath);
+    // Patch a copy, as the passed tree may be a read-only CPLXMLArenaTree.
+    CPLXMLNode *const psOptionsTreeNext = psOptionsTree->psNext;
+    psOptionsTree->psNext = nullptr;
+    CPLXMLTreeCloser oOptionsTree(CPLCloneXMLTree(psOptionsTree));
+    psOptionsTree->psNext = psOptionsTreeNext;
+
+    CPLSetXMLValue(oOptionsTree.get(), "SourceDataset", pszAbsolutePath);
     CPLFree(pszAbsolutePath);
 
     /* -------------------------------------------------------------------- */
     /*      And instantiate the warp options, and corresponding warp        */
     /*      operation.                                                      */
     /* -------------------------------------------------------------------- */
-    GDALWarpOptions *psWO = GDALDeserializeWarpOptions(psOptionsTree);
+    GDALWarpOptions *psWO = GDALDeserializeWarpOptions(oOptionsTree.get());
     if (psWO == nullptr)
         return CE_Failure;
 
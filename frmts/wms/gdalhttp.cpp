@@ -31,6 +31,8 @@
 
 #include "wmsdriver.h"
 #include <algorithm>
+#include <map>
+#include <mutex>
 
 static size_t WriteFunc(void *buffer, size_t count, size_t nmemb, void *req)
 {
@@ -154,9 +156,45 @@ WMSHTTPRequest::~WMSHTTPRequest()
         CPLFree(pabyData);
 }
 
+// Number of connections currently opened to each host, by all the
+// WMSHTTPFetchMulti() calls of the process
+static std::mutex goHostConnectionsMutex;
+static std::map<std::string, int> goMapHostConnections;
+
+static std::string WMSGetHostFromURL(const std::string &osURL)
+{
+    size_t nPos = osURL.find("://");
+    nPos = nPos == std::string::npos ? 0 : nPos + 3;
+    return osURL.substr(nPos, osURL.find('/', nPos) - nPos);
+}
+
+// Returns false if nMaxPerHost connections are already opened to the host of
+// the URL. A non-positive nMaxPerHost means no limit.
+static bool WMSAcquireHostConnection(const std::string &osURL, int nMaxPerHost)
+{
+    if (nMaxPerHost <= 0)
+        return true;
+    std::lock_guard<std::mutex> oLock(goHostConnectionsMutex);
+    int &nCount = goMapHostConnections[WMSGetHostFromURL(osURL)];
+    if (nCount >= nMaxPerHost)
+        return false;
+    ++nCount;
+    return true;
+}
+
+static void WMSReleaseHostConnection(const std::string &osURL)
+{
+    std::lock_guard<std::mutex> oLock(goHostConnectionsMutex);
+    auto oIter = goMapHostConnections.find(WMSGetHostFromURL(osURL));
+    if (oIter != goMapHostConnections.end() && --oIter->second <= 0)
+        goMapHostConnections.erase(oIter);
+}
+
 //
 // Like CPLHTTPFetch, but multiple requests in parallel
-// By default it uses 5 connections
+// By default it uses 5 connections. The GDAL_WMS_MAX_CONNECTIONS_PER_HOST
+// configuration option limits the number of connections opened to a same
+// host by all the concurrent calls.
 //
 CPLErr WMSHTTPFetchMulti(WMSHTTPRequest *pasRequest, int nRequestCount)
 {
@@ -212,15 +250,50 @@ CPLErr WMSHTTPFetchMulti(WMSHTTPRequest *pasRequest, int nRequestCount)
                  "CPLHTTPFetchMulti(): Unable to create CURL multi-handle.");
     }
 
-    // add at most max_conn requests
-    int torun = std::min(nRequestCount, max_conn);
-    for (conn_i = 0; conn_i < torun; ++conn_i)
+    const int nMaxConnPerHost =
+        atoi(CPLGetConfigOption("GDAL_WMS_MAX_CONNECTIONS_PER_HOST", "0"));
+    std::vector<bool> abHostConnectionAcquired(nRequestCount);
+    int nRunning = 0;
+
+    // add requests while there are less than max_conn running, and the
+    // limit of connections to the host is not reached
+    conn_i = 0;
+    const auto AddRequests = [&]()
     {
-        WMSHTTPRequest *const psRequest = &pasRequest[conn_i];
-        CPLDebug("HTTP", "Requesting [%d/%d] %s", conn_i + 1, nRequestCount,
-                 pasRequest[conn_i].URL.c_str());
-        curl_multi_add_handle(curl_multi, psRequest->m_curl_handle);
-    }
+        bool bAdded = false;
+        while (conn_i < nRequestCount && nRunning < max_conn)
+        {
+            WMSHTTPRequest *const psRequest = &pasRequest[conn_i];
+            if (!WMSAcquireHostConnection(psRequest->URL, nMaxConnPerHost))
+                break;
+            abHostConnectionAcquired[conn_i] = nMaxConnPerHost > 0;
+            CPLDebug("HTTP", "Requesting [%d/%d] %s", conn_i + 1,
+                     nRequestCount, psRequest->URL.c_str());
+            curl_multi_add_handle(curl_multi, psRequest->m_curl_handle);
+            ++conn_i;
+            ++nRunning;
+            bAdded = true;
+        }
+        return bAdded;
+    };
+
+    const auto ReleaseHostConnection = [&](CURL *easy_handle)
+    {
+        for (int j = 0; j < conn_i; ++j)
+        {
+            if (pasRequest[j].m_curl_handle == easy_handle)
+            {
+                if (abHostConnectionAcquired[j])
+                {
+                    abHostConnectionAcquired[j] = false;
+                    WMSReleaseHostConnection(pasRequest[j].URL);
+                }
+                break;
+            }
+        }
+    };
+
+    AddRequests();
 
     void *old_handler = CPLHTTPIgnoreSigPipe();
     int still_running;
@@ -242,19 +315,22 @@ CPLErr WMSHTTPFetchMulti(WMSHTTPRequest *pasRequest, int nRequestCount)
                 ProcessCurlErrors(m, pasRequest, nRequestCount);
 
                 curl_multi_remove_handle(curl_multi, m->easy_handle);
-                if (conn_i < nRequestCount)
-                {
-                    auto psRequest = &pasRequest[conn_i];
-                    CPLDebug("HTTP", "Requesting [%d/%d] %s", conn_i + 1,
-                             nRequestCount, pasRequest[conn_i].URL.c_str());
-                    curl_multi_add_handle(curl_multi, psRequest->m_curl_handle);
-                    ++conn_i;
-                    still_running = 1;  // Still have request pending
-                }
+                ReleaseHostConnection(m->easy_handle);
+                --nRunning;
             }
         } while (msgs_in_queue);
 
-        if (CURLM_OK == mc)
+        // Connections to the host may also have been released by other
+        // threads
+        if (AddRequests())
+            still_running = 1;  // Still have request pending
+
+        if (nRunning == 0 && conn_i != nRequestCount)
+        {
+            // Waiting for other threads to release connections to the host
+            CPLSleep(0.01);
+        }
+        else if (CURLM_OK == mc)
         {
             int numfds;
             curl_multi_wait(curl_multi, nullptr, 0, 100, &numfds);
@@ -278,6 +354,12 @@ CPLErr WMSHTTPFetchMulti(WMSHTTPRequest *pasRequest, int nRequestCount)
 
     CPLHTTPRestoreSigPipeHandler(old_handler);
 
+    for (int j = 0; j < conn_i; ++j)
+    {
+        if (abHostConnectionAcquired[j])
+            WMSReleaseHostConnection(pasRequest[j].URL);
+    }
+
     if (conn_i != nRequestCount)
     {  // something gone really really wrong
         // oddly built libcurl or perhaps absence of network interface
@@ -32,6 +32,8 @@
 #include "cpl_md5.h"
 #include "wmsdriver.h"
 
+#include <limits>
+
 static void CleanCacheThread(void *pData)
 {
     GDALWMSCache *pCache = static_cast<GDALWMSCache *>(pData);
@@ -379,3 +381,132 @@ void GDALWMSCache::Clean()
     m_nCleanThreadLastRunTime = time(nullptr);
     m_bIsCleanThreadRunning = false;
 }
+
+//------------------------------------------------------------------------------
+// GDALWMSMemoryCache
+//------------------------------------------------------------------------------
+
+static std::mutex goMemoryCacheMutex;
+static GDALWMSMemoryCache *gpoMemoryCache = nullptr;
+
+GDALWMSMemoryCache *GDALWMSMemoryCache::Get()
+{
+    const size_t nMaxSize = static_cast<size_t>(std::min<GUIntBig>(
+        std::numeric_limits<size_t>::max(),
+        CPLScanUIntBig(
+            CPLGetConfigOption("GDAL_WMS_MEMORY_CACHE_SIZE", "0"), 20)));
+    std::lock_guard<std::mutex> oLock(goMemoryCacheMutex);
+    if (nMaxSize == 0)
+        return nullptr;
+    if (gpoMemoryCache == nullptr)
+        gpoMemoryCache = new GDALWMSMemoryCache();
+    std::lock_guard<std::mutex> oLockCache(gpoMemoryCache->m_oMutex);
+    gpoMemoryCache->m_nMaxSize = nMaxSize;
+    return gpoMemoryCache;
+}
+
+void GDALWMSMemoryCache::Destroy()
+{
+    std::lock_guard<std::mutex> oLock(goMemoryCacheMutex);
+    delete gpoMemoryCache;
+    gpoMemoryCache = nullptr;
+}
+
+std::string GDALWMSMemoryCache::GetKey(const WMSHTTPRequest &request)
+{
+    std::string osKey(request.URL);
+    if (!request.Range.empty())
+    {
+        osKey += '|';
+        osKey += request.Range;
+    }
+    return osKey;
+}
+
+// Must be called with m_oMutex held
+bool GDALWMSMemoryCache::FillFromCache(const std::string &osKey,
+                                       WMSHTTPRequest &request)
+{
+    auto oIter = m_oMap.find(osKey);
+    if (oIter == m_oMap.end())
+        return false;
+    // Move to front of the LRU list
+    m_oLRU.splice(m_oLRU.begin(), m_oLRU, oIter->second);
+    const Entry &oEntry = oIter->second->second;
+    GByte *pabyData =
+        static_cast<GByte *>(VSI_MALLOC_VERBOSE(oEntry.abyData.size() + 1));
+    if (pabyData == nullptr)
+        return false;
+    memcpy(pabyData, oEntry.abyData.data(), oEntry.abyData.size());
+    pabyData[oEntry.abyData.size()] = 0;
+    CPLFree(request.pabyData);
+    request.pabyData = pabyData;
+    request.nDataLen = oEntry.abyData.size();
+    request.nDataAlloc = oEntry.abyData.size() + 1;
+    request.nStatus = oEntry.nStatus;
+    request.ContentType = oEntry.osContentType;
+    return true;
+}
+
+GDALWMSMemoryCache::Status
+GDALWMSMemoryCache::Claim(const std::string &osKey, WMSHTTPRequest &request)
+{
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    if (FillFromCache(osKey, request))
+        return Status::FOUND;
+    if (!m_oSetInFlight.insert(osKey).second)
+        return Status::IN_FLIGHT;
+    return Status::CLAIMED;
+}
+
+// Store the result of a claimed download if successful, and wake up the
+// callers waiting for it.
+void GDALWMSMemoryCache::Publish(const std::string &osKey,
+                                 const WMSHTTPRequest &request)
+{
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_oSetInFlight.erase(osKey);
+        const bool bSuccess =
+            (request.nStatus == 200 ||
+             (!request.Range.empty() && request.nStatus == 206)) &&
+            request.pabyData != nullptr && request.nDataLen > 0 &&
+            request.nDataLen <= m_nMaxSize &&
+            m_oMap.find(osKey) == m_oMap.end();
+        if (bSuccess)
+        {
+            try
+            {
+                Entry oEntry;
+                oEntry.abyData.assign(request.pabyData,
+                                      request.pabyData + request.nDataLen);
+                oEntry.osContentType = request.ContentType;
+                oEntry.nStatus = request.nStatus;
+                m_oLRU.emplace_front(osKey, std::move(oEntry));
+                m_oMap[osKey] = m_oLRU.begin();
+                m_nSize += request.nDataLen;
+                while (m_nSize > m_nMaxSize)
+                {
+                    const auto &oOldest = m_oLRU.back();
+                    m_nSize -= oOldest.second.abyData.size();
+                    m_oMap.erase(oOldest.first);
+                    m_oLRU.pop_back();
+                }
+            }
+            catch (const std::exception &)
+            {
+            }
+        }
+    }
+    m_oCV.notify_all();
+}
+
+// Wait for a download claimed by another caller. Returns false if it
+// failed, in which case the caller should download the tile by itself.
+bool GDALWMSMemoryCache::Wait(const std::string &osKey, WMSHTTPRequest &request)
+{
+    std::unique_lock<std::mutex> oLock(m_oMutex);
+    m_oCV.wait(oLock,
+               [this, &osKey]() { return m_oSetInFlight.count(osKey) == 0; });
+    return FillFromCache(osKey, request);
+}
@@ -92,6 +92,12 @@ CPLErr GDALWMSRasterBand::ReadBlocks(int x, int y, void *buffer, int bx0,
     GDALWMSCache *cache = m_parent_dataset->m_cache;
     int offline = m_parent_dataset->m_offline_mode;
     const char *const *options = m_parent_dataset->GetHTTPRequestOpts();
+    GDALWMSMemoryCache *poMemoryCache =
+        offline ? nullptr : GDALWMSMemoryCache::Get();
+    // Keys of the tiles that we must publish in poMemoryCache
+    std::vector<std::string> claimedKeys;
+    // Requests served by poMemoryCache (nStatus != 0), or waiting for it
+    std::vector<std::unique_ptr<WMSHTTPRequest>> apoSharedRequests;
 
     for (int iy = by0; iy <= by1; ++iy)
     {
@@ -188,6 +194,28 @@ CPLErr GDALWMSRasterBand::ReadBlocks(int x, int y, void *buffer, int bx0,
                 else
                 {
                     request.options = options;
+                    if (poMemoryCache)
+                    {
+                        // Use the tile already downloaded, or being
+                        // downloaded, by another dataset or thread
+                        auto poSharedRequest =
+                            std::make_unique<WMSHTTPRequest>();
+                        poSharedRequest->URL = request.URL;
+                        poSharedRequest->Range = request.Range;
+                        poSharedRequest->x = ix;
+                        poSharedRequest->y = iy;
+                        const std::string osKey =
+                            GDALWMSMemoryCache::GetKey(request);
+                        if (poMemoryCache->Claim(osKey, *poSharedRequest) !=
+                            GDALWMSMemoryCache::Status::CLAIMED)
+                        {
+                            apoSharedRequests.emplace_back(
+                                std::move(poSharedRequest));
+                            continue;
+                        }
+                        claimedKeys.resize(count + 1);
+                        claimedKeys[count] = osKey;
+                    }
                     WMSHTTPInitializeRequest(&request);
                     count++;
                 }
@@ -204,9 +232,15 @@ CPLErr GDALWMSRasterBand::ReadBlocks(int x, int y, void *buffer, int bx0,
         ret = CE_Failure;
     }
 
-    for (size_t i = 0; i < count; ++i)
+    // Wake up the callers waiting for the tiles that we have downloaded
+    for (size_t i = 0; i < claimedKeys.size(); ++i)
+    {
+        if (!claimedKeys[i].empty())
+            poMemoryCache->Publish(claimedKeys[i], requests[i]);
+    }
+
+    const auto ProcessRequest = [&](WMSHTTPRequest &request)
     {
-        WMSHTTPRequest &request = requests[i];
         void *p = ((request.x == x) && (request.y == y)) ? buffer : nullptr;
         if (ret == CE_None)
         {
@@ -320,6 +354,47 @@ CPLErr GDALWMSRasterBand::ReadBlocks(int x, int y, void *buffer, int bx0,
                 }
             }
         }
+    };
+
+    for (size_t i = 0; i < count; ++i)
+        ProcessRequest(requests[i]);
+
+    // Tiles downloaded by other datasets or threads
+    if (!apoSharedRequests.empty())
+    {
+        std::vector<WMSHTTPRequest> retryRequests(apoSharedRequests.size());
+        size_t retryCount = 0;
+        for (auto &poRequest : apoSharedRequests)
+        {
+            if (poRequest->nStatus == 0 &&
+                !poMemoryCache->Wait(GDALWMSMemoryCache::GetKey(*poRequest),
+                                     *poRequest))
+            {
+                // Failed download: try by ourselves
+                WMSHTTPRequest &request = retryRequests[retryCount++];
+                request.URL = poRequest->URL;
+                request.Range = poRequest->Range;
+                request.x = poRequest->x;
+                request.y = poRequest->y;
+                request.options = options;
+                WMSHTTPInitializeRequest(&request);
+                continue;
+            }
+            ProcessRequest(*poRequest);
+        }
+
+        if (retryCount > 0)
+        {
+            if (WMSHTTPFetchMulti(&retryRequests[0],
+                                  static_cast<int>(retryCount)) != CE_None)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "GDALWMS: CPLHTTPFetchMulti failed.");
+                ret = CE_Failure;
+            }
+            for (size_t i = 0; i < retryCount; ++i)
+                ProcessRequest(retryRequests[i]);
+        }
     }
 
     return ret;
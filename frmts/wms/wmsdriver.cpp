@@ -1039,6 +1039,7 @@ GDALDataset *GDALWMSDataset::CreateCopy(const char *pszFilename,
 void WMSDeregister(CPL_UNUSED GDALDriver *d)
 {
     GDALWMSDataset::DestroyCfgMutex();
+    GDALWMSMemoryCache::Destroy();
 }
 
 // Define a minidriver factory type, create one and register it
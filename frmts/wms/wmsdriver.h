@@ -36,8 +36,13 @@
 
 #include <algorithm>
 #include <cmath>
+#include <condition_variable>
+#include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
@@ -310,6 +315,55 @@ class GDALWMSCache
     CPLJoinableThread *m_hThread = nullptr;
 };
 
+/************************************************************************/
+/*                          GDALWMSMemoryCache                          */
+/************************************************************************/
+
+// Process-wide in-memory cache of the downloaded (still compressed) tiles,
+// shared by all WMS datasets. Concurrent requests of a same tile are
+// coalesced: the first one claims the download, and the other ones wait for
+// its result.
+class GDALWMSMemoryCache
+{
+  public:
+    enum class Status
+    {
+        FOUND,     // request filled from the cache
+        CLAIMED,   // caller must download the tile, then call Publish()
+        IN_FLIGHT  // being downloaded by another caller: call Wait()
+    };
+
+    // Returns nullptr if disabled (GDAL_WMS_MEMORY_CACHE_SIZE=0).
+    static GDALWMSMemoryCache *Get();
+    static void Destroy();
+
+    static std::string GetKey(const WMSHTTPRequest &request);
+
+    Status Claim(const std::string &osKey, WMSHTTPRequest &request);
+    void Publish(const std::string &osKey, const WMSHTTPRequest &request);
+    bool Wait(const std::string &osKey, WMSHTTPRequest &request);
+
+  private:
+    struct Entry
+    {
+        std::vector<GByte> abyData{};
+        CPLString osContentType{};
+        int nStatus = 0;
+    };
+
+    using EntryList = std::list<std::pair<std::string, Entry>>;
+
+    std::mutex m_oMutex{};
+    std::condition_variable m_oCV{};
+    EntryList m_oLRU{};
+    std::unordered_map<std::string, EntryList::iterator> m_oMap{};
+    std::set<std::string> m_oSetInFlight{};
+    size_t m_nSize = 0;
+    size_t m_nMaxSize = 0;
+
+    bool FillFromCache(const std::string &osKey, WMSHTTPRequest &request);
+};
+
 /************************************************************************/
 /*                            GDALWMSDataset                            */
 /************************************************************************/
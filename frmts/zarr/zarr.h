@@ -31,11 +31,14 @@
 
 #include "cpl_compressor.h"
 #include "cpl_json.h"
+#include "cpl_mem_cache.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal_priv.h"
 #include "gdal_pam.h"
 #include "memmultidim.h"
 
 #include <array>
+#include <condition_variable>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -768,6 +771,23 @@ class ZarrArray CPL_NON_FINAL : public GDALPamMDArray
     };
     mutable std::map<uint64_t, CachedTile> m_oMapTileIndexToCachedTile{};
 
+    // Asynchronous encoding and writing of dirty tiles
+    struct TileWriteJob
+    {
+        const ZarrArray *poArray = nullptr;
+        std::vector<uint64_t> anTileIndices{};
+        ZarrByteVectorQuickResize abyRawTileData{};
+        ZarrByteVectorQuickResize abyDecodedTileData{};
+    };
+    mutable int m_nTileWriteThreads = -1;
+    mutable std::unique_ptr<CPLJobQueue> m_poTileWriteJobQueue{};
+    // Below members are protected by m_oMutex
+    mutable std::vector<std::unique_ptr<TileWriteJob>> m_apoTileWriteJobs{};
+    mutable std::vector<TileWriteJob *> m_apoFreeTileWriteJobs{};
+    mutable std::set<std::vector<uint64_t>> m_oSetPendingWriteTiles{};
+    mutable bool m_bTileWriteJobError = false;
+    mutable std::string m_osTileWriteJobError{};
+
     static uint64_t
     ComputeTileCount(const std::string &osName,
                      const std::vector<std::shared_ptr<GDALDimension>> &aoDims,
@@ -799,6 +819,22 @@ class ZarrArray CPL_NON_FINAL : public GDALPamMDArray
 
     virtual bool FlushDirtyTile() const = 0;
 
+    // Encode and write the content of a tile. When bAsync is true, this
+    // method is called from a worker thread, and must not use the working
+    // buffers or codecs of the array.
+    virtual bool
+    WriteTileData(const uint64_t *tileIndices,
+                  ZarrByteVectorQuickResize &abyRawTileData,
+                  const ZarrByteVectorQuickResize &abyDecodedTileData,
+                  bool bAsync, bool &bEmptyTileOut) const = 0;
+
+    bool ScheduleDirtyTileFlush(
+        const std::vector<uint64_t> &anNextTileIndices) const;
+
+    static void TileWriteJobFunc(void *pData);
+
+    bool WaitTileWriteJobs() const;
+
     std::shared_ptr<GDALMDArray> OpenTilePresenceCache(bool bCanCreate) const;
 
     void NotifyChildrenOfRenaming() override;
@@ -831,6 +867,11 @@ class ZarrArray CPL_NON_FINAL : public GDALPamMDArray
                            std::vector<uint64_t> &anReqTilesIndices,
                            size_t &nReqTiles) const;
 
+    bool CanUseImplicitAdviseRead(const GUInt64 *arrayStartIdx,
+                                  const size_t *count,
+                                  const GInt64 *arrayStep,
+                                  std::vector<GUInt64> &anAdviseStartIdx) const;
+
     CPLJSONObject SerializeSpecialAttributes();
 
     virtual std::string
@@ -1102,6 +1143,11 @@ class ZarrV2Array final : public ZarrArray
 
     bool FlushDirtyTile() const override;
 
+    bool WriteTileData(const uint64_t *tileIndices,
+                       ZarrByteVectorQuickResize &abyRawTileData,
+                       const ZarrByteVectorQuickResize &abyDecodedTileData,
+                       bool bAsync, bool &bEmptyTileOut) const override;
+
     std::string BuildTileFilename(const uint64_t *tileIndices) const override;
 
     bool AllocateWorkingBuffers() const override;
@@ -1410,6 +1456,25 @@ class ZarrV3CodecSequence
     bool Decode(ZarrByteVectorQuickResize &abyBuffer);
 };
 
+/************************************************************************/
+/*                         ZarrV3ShardingInfo                           */
+/************************************************************************/
+
+// Implements
+// https://zarr-specs.readthedocs.io/en/latest/v3/codecs/sharding-indexed/v1.0.html
+// When an array uses the sharding_indexed codec, its block size is the
+// inner chunk shape, and each file is a shard of several inner chunks.
+struct ZarrV3ShardingInfo
+{
+    static constexpr const char *CODEC_NAME = "sharding_indexed";
+
+    // Shape of a shard, in number of elements
+    std::vector<GUInt64> anShardSize{};
+    bool bIndexAtStart = false;
+    bool bIndexCRC32C = false;
+    CPLJSONArray oIndexCodecs{};
+};
+
 /************************************************************************/
 /*                           ZarrV3Array                                */
 /************************************************************************/
@@ -1419,6 +1484,33 @@ class ZarrV3Array final : public ZarrArray
     bool m_bV2ChunkKeyEncoding = false;
     std::unique_ptr<ZarrV3CodecSequence> m_poCodecs{};
 
+    // Sharding. Empty m_sSharding.anShardSize when not sharded.
+    ZarrV3ShardingInfo m_sSharding{};
+    std::vector<uint64_t> m_anInnerChunksPerShard{};
+    size_t m_nInnerChunksPerShard = 0;
+
+    // Inner chunks written but not yet flushed to their shard. An empty
+    // chunk is a missing one.
+    struct ShardWriteBuffer
+    {
+        std::vector<std::vector<GByte>> aabyChunks{};
+        std::vector<bool> abSet{};
+        size_t nSet = 0;
+        size_t nExpected = 0;
+    };
+
+    // Protects m_oShardIndexCache, m_oMapShardWriteBuffers and
+    // m_oSetShardsBeingWritten
+    mutable std::mutex m_oShardMutex{};
+    // Shards being written by WriteShard(), possibly from a worker thread
+    mutable std::set<std::vector<uint64_t>> m_oSetShardsBeingWritten{};
+    mutable std::condition_variable m_oShardWrittenCV{};
+    // Map a shard filename to its index (pairs of offset and size)
+    mutable lru11::Cache<std::string, std::shared_ptr<std::vector<uint64_t>>>
+        m_oShardIndexCache{16};
+    mutable std::map<std::vector<uint64_t>, ShardWriteBuffer>
+        m_oMapShardWriteBuffers{};
+
     ZarrV3Array(const std::shared_ptr<ZarrSharedResource> &poSharedResource,
                 const std::string &osParentName, const std::string &osName,
                 const std::vector<std::shared_ptr<GDALDimension>> &aoDims,
@@ -1440,6 +1532,36 @@ class ZarrV3Array final : public ZarrArray
                       ZarrByteVectorQuickResize &abyDecodedTileData,
                       bool &bMissingTileOut) const;
 
+    bool DecodeTileData(const std::string &osTileName,
+                        ZarrV3CodecSequence *poCodecs,
+                        ZarrByteVectorQuickResize &abyRawTileData,
+                        ZarrByteVectorQuickResize &abyDecodedTileData) const;
+
+    VSILFILE *OpenTileFile(const std::string &osFilename) const;
+
+    bool IsSharded() const
+    {
+        return !m_sSharding.anShardSize.empty();
+    }
+
+    size_t GetShardIndices(const uint64_t *tileIndices,
+                           std::vector<uint64_t> &anShardIndices) const;
+
+    std::shared_ptr<std::vector<uint64_t>>
+    GetShardIndex(const std::string &osFilename, VSILFILE *fp) const;
+
+    bool ReadShardChunks(const uint64_t *panTileIndices, size_t nTiles,
+                         std::vector<ZarrByteVectorQuickResize> &aabyRaw,
+                         std::vector<bool> &abMissing) const;
+
+    bool SetShardChunk(const uint64_t *tileIndices, const GByte *pabyData,
+                       size_t nSize) const;
+
+    bool WriteShard(const std::vector<uint64_t> &anShardIndices,
+                    ShardWriteBuffer &sBuffer) const;
+
+    bool FlushShards() const;
+
   public:
     ~ZarrV3Array() override;
 
@@ -1461,6 +1583,8 @@ class ZarrV3Array final : public ZarrArray
         m_poCodecs = std::move(poCodecs);
     }
 
+    bool SetSharding(const ZarrV3ShardingInfo &sSharding);
+
     void Flush() override;
 
   protected:
@@ -1473,6 +1597,11 @@ class ZarrV3Array final : public ZarrArray
 
     bool FlushDirtyTile() const override;
 
+    bool WriteTileData(const uint64_t *tileIndices,
+                       ZarrByteVectorQuickResize &abyRawTileData,
+                       const ZarrByteVectorQuickResize &abyDecodedTileData,
+                       bool bAsync, bool &bEmptyTileOut) const override;
+
     std::string BuildTileFilename(const uint64_t *tileIndices) const override;
 
     bool LoadTileData(const uint64_t *tileIndices,
@@ -30,6 +30,7 @@
 #include "ucs4_utf8.hpp"
 
 #include "cpl_float.h"
+#include "gdal_thread_pool.h"
 
 #include "netcdf_cf_constants.h"  // for CF_UNITS, etc
 
@@ -891,6 +892,9 @@ bool ZarrArray::IAdviseReadCommon(const GUInt64 *arrayStartIdx,
     if (!CheckValidAndErrorOutIfNot())
         return false;
 
+    if (!WaitTileWriteJobs())
+        return false;
+
     const size_t nDims = m_aoDims.size();
     anIndicesCur.resize(nDims);
     std::vector<uint64_t> anIndicesMin(nDims);
@@ -1027,6 +1031,58 @@ lbl_next_depth:
     return true;
 }
 
+/************************************************************************/
+/*                 ZarrArray::CanUseImplicitAdviseRead()                */
+/************************************************************************/
+
+// Returns whether IRead() should decode the tiles of a request in parallel,
+// as if IAdviseRead() had been called, that is when the request spans
+// several tiles, all of them needed, several threads are allowed, and the
+// decoded tiles fit in half of the remaining block cache.
+// anAdviseStartIdx is set to the start of the request with positive steps.
+
+bool ZarrArray::CanUseImplicitAdviseRead(
+    const GUInt64 *arrayStartIdx, const size_t *count, const GInt64 *arrayStep,
+    std::vector<GUInt64> &anAdviseStartIdx) const
+{
+    if (m_bUpdatable || !m_oMapTileIndexToCachedTile.empty() ||
+        m_nTileSize == 0)
+        return false;
+
+    const size_t nDims = m_aoDims.size();
+    anAdviseStartIdx.resize(nDims);
+    uint64_t nReqTiles = 1;
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        // With larger steps, some of the tiles of the region might not be
+        // needed.
+        if (count[i] > 1 && arrayStep[i] != 1 && arrayStep[i] != -1)
+            return false;
+        anAdviseStartIdx[i] = arrayStep[i] < 0
+                                  ? arrayStartIdx[i] - (count[i] - 1)
+                                  : arrayStartIdx[i];
+        nReqTiles *= (anAdviseStartIdx[i] + count[i] - 1) / m_anBlockSize[i] -
+                     anAdviseStartIdx[i] / m_anBlockSize[i] + 1;
+        if (nReqTiles > std::numeric_limits<size_t>::max() / m_nTileSize)
+            return false;
+    }
+    if (nReqTiles <= 1)
+        return false;
+
+    const char *pszNumThreads =
+        CPLGetConfigOption("GDAL_NUM_THREADS", "ALL_CPUS");
+    const int nThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : atoi(pszNumThreads);
+    if (nThreads <= 1)
+        return false;
+
+    // Same as the implicit CACHE_SIZE of IAdviseReadCommon()
+    const uint64_t nCacheSize =
+        static_cast<uint64_t>(GDALGetCacheMax64() - GDALGetCacheUsed64()) / 2;
+    return nReqTiles * std::max(m_nTileSize, nDims) <= nCacheSize;
+}
+
 /************************************************************************/
 /*                           ZarrArray::IRead()                         */
 /************************************************************************/
@@ -1039,6 +1095,32 @@ bool ZarrArray::IRead(const GUInt64 *arrayStartIdx, const size_t *count,
     if (!CheckValidAndErrorOutIfNot())
         return false;
 
+    // Tiles being written must be fully written before being read back
+    if (!WaitTileWriteJobs())
+        return false;
+
+    // When the request spans several tiles, fetch and decode them in
+    // parallel first, as AdviseRead() does, and then read from the decoded
+    // tiles. The decoded tiles are discarded afterwards.
+    std::vector<GUInt64> anAdviseStartIdx;
+    if (CanUseImplicitAdviseRead(arrayStartIdx, count, arrayStep,
+                                 anAdviseStartIdx))
+    {
+        if (!IAdviseRead(anAdviseStartIdx.data(), count, nullptr))
+        {
+            m_oMapTileIndexToCachedTile.clear();
+            return false;
+        }
+        if (!m_oMapTileIndexToCachedTile.empty())
+        {
+            const bool bRet =
+                IRead(arrayStartIdx, count, arrayStep, bufferStride,
+                      bufferDataType, pDstBuffer);
+            m_oMapTileIndexToCachedTile.clear();
+            return bRet;
+        }
+    }
+
     if (!AllocateWorkingBuffers())
         return false;
 
@@ -1148,7 +1230,7 @@ lbl_next_depth:
             for (size_t j = 0; j < nDims; ++j)
             {
                 if (j > 0)
-                    nTileIdx *= m_aoDims[j - 1]->GetSize();
+                    nTileIdx *= m_aoDims[j]->GetSize();
                 nTileIdx += tileIndices[j];
             }
             const auto oIter = m_oMapTileIndexToCachedTile.find(nTileIdx);
@@ -1675,7 +1757,7 @@ lbl_next_depth:
         }
         else
         {
-            if (!FlushDirtyTile())
+            if (!ScheduleDirtyTileFlush(tileIndices))
                 return false;
 
             m_anCachedTiledIndices = tileIndices;
@@ -1990,6 +2072,192 @@ lbl_next_depth:
     return true;
 }
 
+/************************************************************************/
+/*                 ZarrArray::ScheduleDirtyTileFlush()                  */
+/************************************************************************/
+
+// Flush the dirty tile, by encoding and writing it from a worker thread when
+// possible, so that several tiles are compressed and uploaded concurrently.
+// Also make sure that the tile of indices anNextTileIndices, that is going to
+// be loaded, is not being written.
+bool ZarrArray::ScheduleDirtyTileFlush(
+    const std::vector<uint64_t> &anNextTileIndices) const
+{
+    if (m_nTileWriteThreads < 0)
+    {
+        m_nTileWriteThreads = 1;
+        // Strings of decoded tiles are allocated on the heap, and owned by
+        // the working buffer of the array
+        if (!m_oType.NeedsFreeDynamicMemory())
+        {
+            const char *pszNumThreads =
+                CPLGetConfigOption("GDAL_NUM_THREADS", "ALL_CPUS");
+            m_nTileWriteThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                                      ? CPLGetNumCPUs()
+                                      : atoi(pszNumThreads);
+            m_nTileWriteThreads =
+                std::max(1, std::min(m_nTileWriteThreads, 1024));
+        }
+        if (m_nTileWriteThreads > 1)
+        {
+            CPLWorkerThreadPool *wtp =
+                GDALGetGlobalThreadPool(m_nTileWriteThreads);
+            if (wtp)
+            {
+                CPLDebug(ZARR_DEBUG_KEY,
+                         "Writing tiles of %s with up to %d threads",
+                         GetFullName().c_str(), m_nTileWriteThreads);
+                m_poTileWriteJobQueue = wtp->CreateJobQueue();
+            }
+            else
+            {
+                m_nTileWriteThreads = 1;
+            }
+        }
+    }
+    if (!m_poTileWriteJobQueue)
+        return FlushDirtyTile();
+
+    if (m_bDirtyTile)
+    {
+        // Limit the number of tiles waiting to be written
+        m_poTileWriteJobQueue->WaitCompletion(2 * m_nTileWriteThreads - 1);
+
+        TileWriteJob *psJob = nullptr;
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            if (m_bTileWriteJobError)
+            {
+                // Report the error in the calling thread
+                CPLError(CE_Failure, CPLE_AppDefined, "%s",
+                         m_osTileWriteJobError.c_str());
+                m_bTileWriteJobError = false;
+                return false;
+            }
+            if (m_apoFreeTileWriteJobs.empty())
+            {
+                m_apoTileWriteJobs.emplace_back(
+                    std::make_unique<TileWriteJob>());
+                psJob = m_apoTileWriteJobs.back().get();
+            }
+            else
+            {
+                psJob = m_apoFreeTileWriteJobs.back();
+                m_apoFreeTileWriteJobs.pop_back();
+            }
+            m_oSetPendingWriteTiles.insert(m_anCachedTiledIndices);
+        }
+
+        // Copy the tile content, so that the working buffers can be reused
+        // immediately
+        psJob->poArray = this;
+        psJob->anTileIndices = m_anCachedTiledIndices;
+        try
+        {
+            psJob->abyRawTileData.resize(m_abyRawTileData.capacity());
+            psJob->abyRawTileData.resize(m_abyRawTileData.size());
+            psJob->abyDecodedTileData.resize(m_abyDecodedTileData.size());
+        }
+        catch (const std::bad_alloc &e)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            m_oSetPendingWriteTiles.erase(m_anCachedTiledIndices);
+            m_apoFreeTileWriteJobs.push_back(psJob);
+            return false;
+        }
+        if (!m_abyRawTileData.empty())
+        {
+            memcpy(psJob->abyRawTileData.data(), m_abyRawTileData.data(),
+                   m_abyRawTileData.size());
+        }
+        if (!m_abyDecodedTileData.empty())
+        {
+            memcpy(psJob->abyDecodedTileData.data(),
+                   m_abyDecodedTileData.data(), m_abyDecodedTileData.size());
+        }
+
+        m_bDirtyTile = false;
+        if (!m_poTileWriteJobQueue->SubmitJob(TileWriteJobFunc, psJob))
+        {
+            {
+                std::lock_guard<std::mutex> oLock(m_oMutex);
+                m_oSetPendingWriteTiles.erase(m_anCachedTiledIndices);
+                m_apoFreeTileWriteJobs.push_back(psJob);
+            }
+            m_bDirtyTile = true;
+            return FlushDirtyTile();
+        }
+    }
+
+    bool bNextTilePending;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        bNextTilePending = m_oSetPendingWriteTiles.find(anNextTileIndices) !=
+                           m_oSetPendingWriteTiles.end();
+    }
+    return !bNextTilePending || WaitTileWriteJobs();
+}
+
+/************************************************************************/
+/*                    ZarrArray::TileWriteJobFunc()                     */
+/************************************************************************/
+
+/* static */ void ZarrArray::TileWriteJobFunc(void *pData)
+{
+    TileWriteJob *psJob = static_cast<TileWriteJob *>(pData);
+    const ZarrArray *poArray = psJob->poArray;
+
+    bool bRet;
+    std::string osErrorMsg;
+    {
+        // Errors are reported by the thread that waits for the job
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        CPLErrorReset();
+        bool bEmptyTile = false;
+        bRet = poArray->WriteTileData(psJob->anTileIndices.data(),
+                                      psJob->abyRawTileData,
+                                      psJob->abyDecodedTileData, true,
+                                      bEmptyTile);
+        if (!bRet)
+            osErrorMsg = CPLGetLastErrorMsg();
+    }
+
+    std::lock_guard<std::mutex> oLock(poArray->m_oMutex);
+    if (!bRet && !poArray->m_bTileWriteJobError)
+    {
+        poArray->m_bTileWriteJobError = true;
+        poArray->m_osTileWriteJobError =
+            osErrorMsg.empty() ? std::string("Writing of a tile failed")
+                               : osErrorMsg;
+    }
+    poArray->m_oSetPendingWriteTiles.erase(psJob->anTileIndices);
+    poArray->m_apoFreeTileWriteJobs.push_back(psJob);
+}
+
+/************************************************************************/
+/*                    ZarrArray::WaitTileWriteJobs()                    */
+/************************************************************************/
+
+// Wait for all tiles scheduled by ScheduleDirtyTileFlush() to be written
+bool ZarrArray::WaitTileWriteJobs() const
+{
+    if (!m_poTileWriteJobQueue)
+        return true;
+
+    m_poTileWriteJobQueue->WaitCompletion();
+
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    if (m_bTileWriteJobError)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "%s",
+                 m_osTileWriteJobError.c_str());
+        m_bTileWriteJobError = false;
+        return false;
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                   ZarrArray::IsEmptyTile()                           */
 /************************************************************************/
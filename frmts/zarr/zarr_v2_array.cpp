@@ -86,6 +86,9 @@ ZarrV2Array::Create(const std::shared_ptr<ZarrSharedResource> &poSharedResource,
 ZarrV2Array::~ZarrV2Array()
 {
     ZarrV2Array::Flush();
+    // In case Flush() did nothing, tiles must not be written after the
+    // destruction of this object
+    WaitTileWriteJobs();
 }
 
 /************************************************************************/
@@ -98,6 +101,7 @@ void ZarrV2Array::Flush()
         return;
 
     ZarrV2Array::FlushDirtyTile();
+    WaitTileWriteJobs();
 
     if (m_bDefinitionModified)
     {
@@ -737,7 +741,7 @@ bool ZarrV2Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
             for (size_t j = 0; j < l_nDims; ++j)
             {
                 if (j > 0)
-                    nTileIdx *= aoDims[j - 1]->GetSize();
+                    nTileIdx *= aoDims[j]->GetSize();
                 nTileIdx += tileIndices[j];
             }
 
@@ -815,16 +819,36 @@ bool ZarrV2Array::FlushDirtyTile() const
         return true;
     m_bDirtyTile = false;
 
-    std::string osFilename = BuildTileFilename(m_anCachedTiledIndices.data());
+    bool bEmptyTile = false;
+    const bool bRet =
+        WriteTileData(m_anCachedTiledIndices.data(), m_abyRawTileData,
+                      m_abyDecodedTileData, false, bEmptyTile);
+    if (bEmptyTile)
+        m_bCachedTiledEmpty = true;
+    return bRet;
+}
+
+/************************************************************************/
+/*                     ZarrV2Array::WriteTileData()                     */
+/************************************************************************/
+
+bool ZarrV2Array::WriteTileData(
+    const uint64_t *tileIndices, ZarrByteVectorQuickResize &abyRawTileData,
+    const ZarrByteVectorQuickResize &abyDecodedTileData, bool bAsync,
+    bool &bEmptyTileOut) const
+{
+    bEmptyTileOut = false;
+
+    std::string osFilename = BuildTileFilename(tileIndices);
 
     const size_t nSourceSize =
         m_aoDtypeElts.back().nativeOffset + m_aoDtypeElts.back().nativeSize;
     const auto &abyTile =
-        m_abyDecodedTileData.empty() ? m_abyRawTileData : m_abyDecodedTileData;
+        abyDecodedTileData.empty() ? abyRawTileData : abyDecodedTileData;
 
     if (IsEmptyTile(abyTile))
     {
-        m_bCachedTiledEmpty = true;
+        bEmptyTileOut = true;
 
         VSIStatBufL sStat;
         if (VSIStatL(osFilename.c_str(), &sStat) == 0)
@@ -837,12 +861,30 @@ bool ZarrV2Array::FlushDirtyTile() const
         return true;
     }
 
-    if (!m_abyDecodedTileData.empty())
+    // Working buffer for Fortran order and filters. The one of the array
+    // cannot be used from a worker thread.
+    ZarrByteVectorQuickResize abyLocalTmpRawTileData;
+    auto &abyTmpRawTileData =
+        bAsync ? abyLocalTmpRawTileData : m_abyTmpRawTileData;
+    if (bAsync && (m_bFortranOrder || m_oFiltersArray.Size() != 0))
+    {
+        try
+        {
+            abyTmpRawTileData.resize(m_nTileSize);
+        }
+        catch (const std::bad_alloc &e)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+            return false;
+        }
+    }
+
+    if (!abyDecodedTileData.empty())
     {
         const size_t nDTSize = m_oType.GetSize();
-        const size_t nValues = m_abyDecodedTileData.size() / nDTSize;
-        GByte *pDst = &m_abyRawTileData[0];
-        const GByte *pSrc = m_abyDecodedTileData.data();
+        const size_t nValues = abyDecodedTileData.size() / nDTSize;
+        GByte *pDst = &abyRawTileData[0];
+        const GByte *pSrc = abyDecodedTileData.data();
         for (size_t i = 0; i < nValues;
              i++, pDst += nSourceSize, pSrc += nDTSize)
         {
@@ -852,11 +894,11 @@ bool ZarrV2Array::FlushDirtyTile() const
 
     if (m_bFortranOrder && !m_aoDims.empty())
     {
-        BlockTranspose(m_abyRawTileData, m_abyTmpRawTileData, false);
-        std::swap(m_abyRawTileData, m_abyTmpRawTileData);
+        BlockTranspose(abyRawTileData, abyTmpRawTileData, false);
+        std::swap(abyRawTileData, abyTmpRawTileData);
     }
 
-    size_t nRawDataSize = m_abyRawTileData.size();
+    size_t nRawDataSize = abyRawTileData.size();
     for (const auto &oFilter : m_oFiltersArray)
     {
         const auto osFilterId = oFilter["id"].ToString();
@@ -869,10 +911,10 @@ bool ZarrV2Array::FlushDirtyTile() const
             aosOptions.SetNameValue(obj.GetName().c_str(),
                                     obj.ToString().c_str());
         }
-        void *out_buffer = &m_abyTmpRawTileData[0];
-        size_t nOutSize = m_abyTmpRawTileData.size();
+        void *out_buffer = &abyTmpRawTileData[0];
+        size_t nOutSize = abyTmpRawTileData.size();
         if (!psFilterCompressor->pfnFunc(
-                m_abyRawTileData.data(), nRawDataSize, &out_buffer, &nOutSize,
+                abyRawTileData.data(), nRawDataSize, &out_buffer, &nOutSize,
                 aosOptions.List(), psFilterCompressor->user_data))
         {
             CPLError(CE_Failure, CPLE_AppDefined,
@@ -882,7 +924,7 @@ bool ZarrV2Array::FlushDirtyTile() const
         }
 
         nRawDataSize = nOutSize;
-        std::swap(m_abyRawTileData, m_abyTmpRawTileData);
+        std::swap(abyRawTileData, abyTmpRawTileData);
     }
 
     if (m_osDimSeparator == "/")
@@ -911,7 +953,7 @@ bool ZarrV2Array::FlushDirtyTile() const
     bool bRet = true;
     if (m_psCompressor == nullptr)
     {
-        if (VSIFWriteL(m_abyRawTileData.data(), 1, nRawDataSize, fp) !=
+        if (VSIFWriteL(abyRawTileData.data(), 1, nRawDataSize, fp) !=
             nRawDataSize)
         {
             CPLError(CE_Failure, CPLE_AppDefined,
@@ -957,7 +999,7 @@ bool ZarrV2Array::FlushDirtyTile() const
             }
 
             if (!m_psCompressor->pfnFunc(
-                    m_abyRawTileData.data(), nRawDataSize, &out_buffer,
+                    abyRawTileData.data(), nRawDataSize, &out_buffer,
                     &out_size, aosOptions.List(), m_psCompressor->user_data))
             {
                 CPLError(CE_Failure, CPLE_AppDefined,
@@ -31,6 +31,7 @@
 #include "zarr.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstdlib>
 #include <limits>
@@ -82,6 +83,9 @@ ZarrV3Array::Create(const std::shared_ptr<ZarrSharedResource> &poSharedResource,
 ZarrV3Array::~ZarrV3Array()
 {
     ZarrV3Array::Flush();
+    // In case Flush() did nothing, tiles must not be written after the
+    // destruction of this object
+    WaitTileWriteJobs();
 }
 
 /************************************************************************/
@@ -94,6 +98,8 @@ void ZarrV3Array::Flush()
         return;
 
     ZarrV3Array::FlushDirtyTile();
+    WaitTileWriteJobs();
+    FlushShards();
 
     if (!m_aoDims.empty())
     {
@@ -159,7 +165,9 @@ void ZarrV3Array::Serialize(const CPLJSONObject &oAttrs)
         CPLJSONObject oConfiguration;
         oChunkGrid.Add("configuration", oConfiguration);
         CPLJSONArray oChunks;
-        for (const auto nBlockSize : m_anBlockSize)
+        // With sharding, the chunks of the chunk grid are the shards
+        for (const auto nBlockSize :
+             IsSharded() ? m_sSharding.anShardSize : m_anBlockSize)
         {
             oChunks.Add(static_cast<GInt64>(nBlockSize));
         }
@@ -217,7 +225,29 @@ void ZarrV3Array::Serialize(const CPLJSONObject &oAttrs)
         }
     }
 
-    if (m_poCodecs)
+    if (IsSharded())
+    {
+        CPLJSONObject oShardingCodec;
+        oShardingCodec.Add("name", ZarrV3ShardingInfo::CODEC_NAME);
+        CPLJSONObject oConfiguration;
+        oShardingCodec.Add("configuration", oConfiguration);
+        CPLJSONArray oChunks;
+        for (const auto nBlockSize : m_anBlockSize)
+        {
+            oChunks.Add(static_cast<GInt64>(nBlockSize));
+        }
+        oConfiguration.Add("chunk_shape", oChunks);
+        oConfiguration.Add("codecs",
+                           m_poCodecs ? m_poCodecs->GetJSon() : CPLJSONArray());
+        oConfiguration.Add("index_codecs", m_sSharding.oIndexCodecs);
+        oConfiguration.Add("index_location",
+                           m_sSharding.bIndexAtStart ? "start" : "end");
+
+        CPLJSONArray oCodecs;
+        oCodecs.Add(oShardingCodec);
+        oRoot.Add("codecs", oCodecs);
+    }
+    else if (m_poCodecs)
     {
         oRoot.Add("codecs", m_poCodecs->GetJSon());
     }
@@ -394,6 +424,24 @@ bool ZarrV3Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
 
     bMissingTileOut = false;
 
+    if (IsSharded())
+    {
+        std::vector<ZarrByteVectorQuickResize> aabyChunks;
+        std::vector<bool> abMissing;
+        if (!ReadShardChunks(tileIndices, 1, aabyChunks, abMissing))
+            return false;
+        if (abMissing[0])
+        {
+            bMissingTileOut = true;
+            return true;
+        }
+        abyRawTileData.resize(aabyChunks[0].size());
+        memcpy(abyRawTileData.data(), aabyChunks[0].data(),
+               aabyChunks[0].size());
+        return DecodeTileData(BuildTileFilename(tileIndices), poCodecs,
+                              abyRawTileData, abyDecodedTileData);
+    }
+
     std::string osFilename = BuildTileFilename(tileIndices);
 
     // For network file systems, get the streaming version of the filename,
@@ -433,25 +481,7 @@ bool ZarrV3Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
     if (bUseMutex)
         m_oMutex.unlock();
 
-    VSILFILE *fp = nullptr;
-    // This is the number of files returned in a S3 directory listing operation
-    constexpr uint64_t MAX_TILES_ALLOWED_FOR_DIRECTORY_LISTING = 1000;
-    const char *const apszOpenOptions[] = {"IGNORE_FILENAME_RESTRICTIONS=YES",
-                                           nullptr};
-    if ((m_osDimSeparator == "/" && !m_anBlockSize.empty() &&
-         m_anBlockSize.back() > MAX_TILES_ALLOWED_FOR_DIRECTORY_LISTING) ||
-        (m_osDimSeparator != "/" &&
-         m_nTotalTileCount > MAX_TILES_ALLOWED_FOR_DIRECTORY_LISTING))
-    {
-        // Avoid issuing ReadDir() when a lot of files are expected
-        CPLConfigOptionSetter optionSetter("GDAL_DISABLE_READDIR_ON_OPEN",
-                                           "YES", true);
-        fp = VSIFOpenEx2L(osFilename.c_str(), "rb", 0, apszOpenOptions);
-    }
-    else
-    {
-        fp = VSIFOpenEx2L(osFilename.c_str(), "rb", 0, apszOpenOptions);
-    }
+    VSILFILE *fp = OpenTileFile(osFilename);
     if (fp == nullptr)
     {
         // Missing files are OK and indicate nodata_value
@@ -468,10 +498,10 @@ bool ZarrV3Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
     abyRawTileData.resize(m_nTileSize);
 
     bool bRet = true;
-    size_t nRawDataSize = abyRawTileData.size();
     if (poCodecs == nullptr)
     {
-        nRawDataSize = VSIFReadL(&abyRawTileData[0], 1, nRawDataSize, fp);
+        abyRawTileData.resize(
+            VSIFReadL(&abyRawTileData[0], 1, abyRawTileData.size(), fp));
     }
     else
     {
@@ -507,30 +537,77 @@ bool ZarrV3Array::LoadTileData(const uint64_t *tileIndices, bool bUseMutex,
                          osFilename.c_str());
                 bRet = false;
             }
-            else
-            {
-                if (!poCodecs->Decode(abyRawTileData))
-                {
-                    CPLError(CE_Failure, CPLE_AppDefined,
-                             "Decompression of tile %s failed",
-                             osFilename.c_str());
-                    bRet = false;
-                }
-            }
         }
     }
     VSIFCloseL(fp);
     if (!bRet)
         return false;
 
-    if (nRawDataSize != abyRawTileData.size())
+    return DecodeTileData(osFilename, poCodecs, abyRawTileData,
+                          abyDecodedTileData);
+
+#undef m_abyRawTileData
+#undef m_abyDecodedTileData
+#undef m_poCodecs
+}
+
+/************************************************************************/
+/*                      ZarrV3Array::OpenTileFile()                     */
+/************************************************************************/
+
+VSILFILE *ZarrV3Array::OpenTileFile(const std::string &osFilename) const
+{
+    // This is the number of files returned in a S3 directory listing operation
+    constexpr uint64_t MAX_TILES_ALLOWED_FOR_DIRECTORY_LISTING = 1000;
+    const char *const apszOpenOptions[] = {"IGNORE_FILENAME_RESTRICTIONS=YES",
+                                           nullptr};
+    if ((m_osDimSeparator == "/" && !m_anBlockSize.empty() &&
+         m_anBlockSize.back() > MAX_TILES_ALLOWED_FOR_DIRECTORY_LISTING) ||
+        (m_osDimSeparator != "/" &&
+         m_nTotalTileCount > MAX_TILES_ALLOWED_FOR_DIRECTORY_LISTING))
+    {
+        // Avoid issuing ReadDir() when a lot of files are expected
+        CPLConfigOptionSetter optionSetter("GDAL_DISABLE_READDIR_ON_OPEN",
+                                           "YES", true);
+        return VSIFOpenEx2L(osFilename.c_str(), "rb", 0, apszOpenOptions);
+    }
+    return VSIFOpenEx2L(osFilename.c_str(), "rb", 0, apszOpenOptions);
+}
+
+/************************************************************************/
+/*                     ZarrV3Array::DecodeTileData()                    */
+/************************************************************************/
+
+// Decode the content of a tile file (or of an inner chunk of a shard) in
+// abyRawTileData, and convert it to abyDecodedTileData if needed.
+bool ZarrV3Array::DecodeTileData(
+    const std::string &osTileName, ZarrV3CodecSequence *poCodecs,
+    ZarrByteVectorQuickResize &abyRawTileData,
+    ZarrByteVectorQuickResize &abyDecodedTileData) const
+{
+    // This method should NOT modify any ZarrArray member, as it is going to
+    // be called concurrently from several threads.
+
+    // Set those #define to avoid accidental use of some global variables
+#define m_abyRawTileData cannot_use_here
+#define m_abyDecodedTileData cannot_use_here
+#define m_poCodecs cannot_use_here
+
+    if (poCodecs && !poCodecs->Decode(abyRawTileData))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Decompression of tile %s failed",
+                 osTileName.c_str());
+        return false;
+    }
+
+    if (abyRawTileData.size() != m_nTileSize)
     {
         CPLError(CE_Failure, CPLE_AppDefined,
                  "Decompressed tile %s has not expected size. "
                  "Got %u instead of %u",
-                 osFilename.c_str(),
+                 osTileName.c_str(),
                  static_cast<unsigned>(abyRawTileData.size()),
-                 static_cast<unsigned>(nRawDataSize));
+                 static_cast<unsigned>(m_nTileSize));
         return false;
     }
 
@@ -578,6 +655,34 @@ bool ZarrV3Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
         return true;
     }
 
+    if (IsSharded())
+    {
+        // Sort the requested inner chunks by shard, so that jobs can read
+        // the chunks of a same shard at once
+        const size_t nDims = m_aoDims.size();
+        std::vector<std::pair<std::vector<uint64_t>, size_t>> aoKeys;
+        aoKeys.reserve(nReqTiles);
+        for (size_t i = 0; i < nReqTiles; ++i)
+        {
+            std::vector<uint64_t> anKey;
+            const size_t nIdxInShard =
+                GetShardIndices(anReqTilesIndices.data() + i * nDims, anKey);
+            anKey.push_back(nIdxInShard);
+            aoKeys.emplace_back(std::move(anKey), i);
+        }
+        std::sort(aoKeys.begin(), aoKeys.end());
+        std::vector<uint64_t> anSortedReqTilesIndices;
+        anSortedReqTilesIndices.reserve(anReqTilesIndices.size());
+        for (const auto &oKey : aoKeys)
+        {
+            anSortedReqTilesIndices.insert(
+                anSortedReqTilesIndices.end(),
+                anReqTilesIndices.begin() + oKey.second * nDims,
+                anReqTilesIndices.begin() + (oKey.second + 1) * nDims);
+        }
+        anReqTilesIndices = std::move(anSortedReqTilesIndices);
+    }
+
     const int nThreads =
         static_cast<int>(std::min(static_cast<size_t>(nThreadsMax), nReqTiles));
 
@@ -641,6 +746,12 @@ bool ZarrV3Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
             poCodecs = poArray->m_poCodecs->Clone();
         }
 
+        const bool bSharded = poArray->IsSharded();
+        std::vector<ZarrByteVectorQuickResize> aabyShardChunks;
+        std::vector<bool> abMissingShardChunks;
+        size_t iFirstShardChunk = 0;
+        size_t iLastShardChunkNotIncluded = 0;
+
         for (size_t iReq = jobStruct->nFirstIdx;
              iReq < jobStruct->nLastIdxNotIncluded; ++iReq)
         {
@@ -648,17 +759,51 @@ bool ZarrV3Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
             {
                 std::lock_guard<std::mutex> oLock(poArray->m_oMutex);
                 if (!(*jobStruct->pbGlobalStatus))
-                    return;
+                    break;
             }
 
             const uint64_t *tileIndices =
                 jobStruct->panReqTilesIndices->data() + iReq * l_nDims;
 
+            // Read at once the requested chunks of the shard of this tile
+            if (bSharded && iReq >= iLastShardChunkNotIncluded)
+            {
+                iFirstShardChunk = iReq;
+                iLastShardChunkNotIncluded = iReq + 1;
+                while (iLastShardChunkNotIncluded <
+                       jobStruct->nLastIdxNotIncluded)
+                {
+                    const uint64_t *otherTileIndices =
+                        jobStruct->panReqTilesIndices->data() +
+                        iLastShardChunkNotIncluded * l_nDims;
+                    bool bSameShard = true;
+                    for (size_t j = 0; bSameShard && j < l_nDims; ++j)
+                    {
+                        const auto nPerShard =
+                            poArray->m_anInnerChunksPerShard[j];
+                        bSameShard = tileIndices[j] / nPerShard ==
+                                     otherTileIndices[j] / nPerShard;
+                    }
+                    if (!bSameShard)
+                        break;
+                    ++iLastShardChunkNotIncluded;
+                }
+                if (!poArray->ReadShardChunks(
+                        tileIndices,
+                        iLastShardChunkNotIncluded - iFirstShardChunk,
+                        aabyShardChunks, abMissingShardChunks))
+                {
+                    std::lock_guard<std::mutex> oLock(poArray->m_oMutex);
+                    *jobStruct->pbGlobalStatus = false;
+                    break;
+                }
+            }
+
             uint64_t nTileIdx = 0;
             for (size_t j = 0; j < l_nDims; ++j)
             {
                 if (j > 0)
-                    nTileIdx *= aoDims[j - 1]->GetSize();
+                    nTileIdx *= aoDims[j]->GetSize();
                 nTileIdx += tileIndices[j];
             }
 
@@ -671,10 +816,30 @@ bool ZarrV3Array::IAdviseRead(const GUInt64 *arrayStartIdx, const size_t *count,
             }
 
             bool bIsEmpty = false;
-            bool success = poArray->LoadTileData(tileIndices,
-                                                 true,  // use mutex
-                                                 poCodecs.get(), abyRawTileData,
-                                                 abyDecodedTileData, bIsEmpty);
+            bool success = true;
+            if (bSharded)
+            {
+                const size_t iChunk = iReq - iFirstShardChunk;
+                bIsEmpty = abMissingShardChunks[iChunk];
+                if (!bIsEmpty)
+                {
+                    const auto &abyChunk = aabyShardChunks[iChunk];
+                    abyRawTileData.resize(abyChunk.size());
+                    memcpy(abyRawTileData.data(), abyChunk.data(),
+                           abyChunk.size());
+                    success = poArray->DecodeTileData(
+                        poArray->BuildTileFilename(tileIndices),
+                        poCodecs.get(), abyRawTileData, abyDecodedTileData);
+                }
+            }
+            else
+            {
+                success = poArray->LoadTileData(
+                    tileIndices,
+                    true,  // use mutex
+                    poCodecs.get(), abyRawTileData, abyDecodedTileData,
+                    bIsEmpty);
+            }
 
             std::lock_guard<std::mutex> oLock(poArray->m_oMutex);
             if (!success)
@@ -735,16 +900,39 @@ bool ZarrV3Array::FlushDirtyTile() const
         return true;
     m_bDirtyTile = false;
 
-    std::string osFilename = BuildTileFilename(m_anCachedTiledIndices.data());
+    bool bEmptyTile = false;
+    const bool bRet =
+        WriteTileData(m_anCachedTiledIndices.data(), m_abyRawTileData,
+                      m_abyDecodedTileData, false, bEmptyTile);
+    if (bEmptyTile)
+        m_bCachedTiledEmpty = true;
+    return bRet;
+}
+
+/************************************************************************/
+/*                     ZarrV3Array::WriteTileData()                     */
+/************************************************************************/
+
+bool ZarrV3Array::WriteTileData(
+    const uint64_t *tileIndices, ZarrByteVectorQuickResize &abyRawTileData,
+    const ZarrByteVectorQuickResize &abyDecodedTileData, bool bAsync,
+    bool &bEmptyTileOut) const
+{
+    bEmptyTileOut = false;
+
+    std::string osFilename = BuildTileFilename(tileIndices);
 
     const size_t nSourceSize =
         m_aoDtypeElts.back().nativeOffset + m_aoDtypeElts.back().nativeSize;
     const auto &abyTile =
-        m_abyDecodedTileData.empty() ? m_abyRawTileData : m_abyDecodedTileData;
+        abyDecodedTileData.empty() ? abyRawTileData : abyDecodedTileData;
 
     if (IsEmptyTile(abyTile))
     {
-        m_bCachedTiledEmpty = true;
+        bEmptyTileOut = true;
+
+        if (IsSharded())
+            return SetShardChunk(tileIndices, nullptr, 0);
 
         VSIStatBufL sStat;
         if (VSIStatL(osFilename.c_str(), &sStat) == 0)
@@ -757,12 +945,12 @@ bool ZarrV3Array::FlushDirtyTile() const
         return true;
     }
 
-    if (!m_abyDecodedTileData.empty())
+    if (!abyDecodedTileData.empty())
     {
         const size_t nDTSize = m_oType.GetSize();
-        const size_t nValues = m_abyDecodedTileData.size() / nDTSize;
-        GByte *pDst = &m_abyRawTileData[0];
-        const GByte *pSrc = m_abyDecodedTileData.data();
+        const size_t nValues = abyDecodedTileData.size() / nDTSize;
+        GByte *pDst = &abyRawTileData[0];
+        const GByte *pSrc = abyDecodedTileData.data();
         for (size_t i = 0; i < nValues;
              i++, pDst += nSourceSize, pSrc += nDTSize)
         {
@@ -770,16 +958,34 @@ bool ZarrV3Array::FlushDirtyTile() const
         }
     }
 
-    const size_t nSizeBefore = m_abyRawTileData.size();
-    if (m_poCodecs)
+    // The codecs of the array cannot be used from a worker thread
+    std::unique_ptr<ZarrV3CodecSequence> poCodecsClone;
+    ZarrV3CodecSequence *poCodecs = m_poCodecs.get();
+    if (bAsync && m_poCodecs)
     {
-        if (!m_poCodecs->Encode(m_abyRawTileData))
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        poCodecsClone = m_poCodecs->Clone();
+        poCodecs = poCodecsClone.get();
+    }
+
+    const size_t nSizeBefore = abyRawTileData.size();
+    if (poCodecs)
+    {
+        if (!poCodecs->Encode(abyRawTileData))
         {
-            m_abyRawTileData.resize(nSizeBefore);
+            abyRawTileData.resize(nSizeBefore);
             return false;
         }
     }
 
+    if (IsSharded())
+    {
+        const bool bRet = SetShardChunk(tileIndices, abyRawTileData.data(),
+                                        abyRawTileData.size());
+        abyRawTileData.resize(nSizeBefore);
+        return bRet;
+    }
+
     if (m_osDimSeparator == "/")
     {
         std::string osDir = CPLGetDirname(osFilename.c_str());
@@ -790,7 +996,7 @@ bool ZarrV3Array::FlushDirtyTile() const
             {
                 CPLError(CE_Failure, CPLE_AppDefined,
                          "Cannot create directory %s", osDir.c_str());
-                m_abyRawTileData.resize(nSizeBefore);
+                abyRawTileData.resize(nSizeBefore);
                 return false;
             }
         }
@@ -801,14 +1007,13 @@ bool ZarrV3Array::FlushDirtyTile() const
     {
         CPLError(CE_Failure, CPLE_AppDefined, "Cannot create tile %s",
                  osFilename.c_str());
-        m_abyRawTileData.resize(nSizeBefore);
+        abyRawTileData.resize(nSizeBefore);
         return false;
     }
 
     bool bRet = true;
-    const size_t nRawDataSize = m_abyRawTileData.size();
-    if (VSIFWriteL(m_abyRawTileData.data(), 1, nRawDataSize, fp) !=
-        nRawDataSize)
+    const size_t nRawDataSize = abyRawTileData.size();
+    if (VSIFWriteL(abyRawTileData.data(), 1, nRawDataSize, fp) != nRawDataSize)
     {
         CPLError(CE_Failure, CPLE_AppDefined,
                  "Could not write tile %s correctly", osFilename.c_str());
@@ -816,11 +1021,589 @@ bool ZarrV3Array::FlushDirtyTile() const
     }
     VSIFCloseL(fp);
 
-    m_abyRawTileData.resize(nSizeBefore);
+    abyRawTileData.resize(nSizeBefore);
 
     return bRet;
 }
 
+/************************************************************************/
+/*                             ZarrCRC32C()                             */
+/************************************************************************/
+
+// CRC32C (Castagnoli) checksum, as used by the crc32c codec
+static uint32_t ZarrCRC32C(const GByte *pabyData, size_t nSize)
+{
+    static const std::array<uint32_t, 256> anTable = []()
+    {
+        std::array<uint32_t, 256> anRet;
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t nVal = i;
+            for (int j = 0; j < 8; ++j)
+                nVal = (nVal >> 1) ^ ((nVal & 1) ? 0x82F63B78U : 0);
+            anRet[i] = nVal;
+        }
+        return anRet;
+    }();
+
+    uint32_t nCRC = 0xFFFFFFFFU;
+    for (size_t i = 0; i < nSize; ++i)
+        nCRC = anTable[(nCRC ^ pabyData[i]) & 0xFF] ^ (nCRC >> 8);
+    return nCRC ^ 0xFFFFFFFFU;
+}
+
+/************************************************************************/
+/*                      ZarrV3Array::SetSharding()                      */
+/************************************************************************/
+
+bool ZarrV3Array::SetSharding(const ZarrV3ShardingInfo &sSharding)
+{
+    if (sSharding.anShardSize.size() != m_aoDims.size())
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Shard shape has not the same number of dimensions as "
+                 "the array");
+        return false;
+    }
+
+    std::vector<uint64_t> anInnerChunksPerShard;
+    size_t nInnerChunksPerShard = 1;
+    for (size_t i = 0; i < m_aoDims.size(); ++i)
+    {
+        if (sSharding.anShardSize[i] == 0 ||
+            (sSharding.anShardSize[i] % m_anBlockSize[i]) != 0)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Shard shape must be a multiple of the chunk shape");
+            return false;
+        }
+        const uint64_t nChunks = sSharding.anShardSize[i] / m_anBlockSize[i];
+        // Limit the size of the shard index to 256 MB
+        constexpr size_t MAX_INNER_CHUNKS = 16 * 1024 * 1024;
+        if (nChunks > MAX_INNER_CHUNKS / nInnerChunksPerShard)
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "Too many chunks per shard");
+            return false;
+        }
+        nInnerChunksPerShard *= static_cast<size_t>(nChunks);
+        anInnerChunksPerShard.push_back(nChunks);
+    }
+
+    m_sSharding = sSharding;
+    m_anInnerChunksPerShard = std::move(anInnerChunksPerShard);
+    m_nInnerChunksPerShard = nInnerChunksPerShard;
+    return true;
+}
+
+/************************************************************************/
+/*                    ZarrV3Array::GetShardIndices()                    */
+/************************************************************************/
+
+// Compute the indices of the shard containing the inner chunk of indices
+// tileIndices, and return the position of the inner chunk in the shard.
+size_t ZarrV3Array::GetShardIndices(const uint64_t *tileIndices,
+                                    std::vector<uint64_t> &anShardIndices) const
+{
+    const size_t nDims = m_aoDims.size();
+    anShardIndices.resize(nDims);
+    size_t nIdxInShard = 0;
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        anShardIndices[i] = tileIndices[i] / m_anInnerChunksPerShard[i];
+        nIdxInShard = nIdxInShard * static_cast<size_t>(
+                                        m_anInnerChunksPerShard[i]) +
+                      static_cast<size_t>(tileIndices[i] %
+                                          m_anInnerChunksPerShard[i]);
+    }
+    return nIdxInShard;
+}
+
+/************************************************************************/
+/*                     ZarrV3Array::GetShardIndex()                     */
+/************************************************************************/
+
+// Return the index of a shard, as pairs of (offset, size) for each inner
+// chunk, from the cache or by reading it from the opened shard file.
+std::shared_ptr<std::vector<uint64_t>>
+ZarrV3Array::GetShardIndex(const std::string &osFilename, VSILFILE *fp) const
+{
+    {
+        std::lock_guard<std::mutex> oLock(m_oShardMutex);
+        std::shared_ptr<std::vector<uint64_t>> panIndex;
+        if (m_oShardIndexCache.tryGet(osFilename, panIndex))
+            return panIndex;
+    }
+
+    const size_t nIndexEntries = 2 * m_nInnerChunksPerShard;
+    const size_t nIndexSize =
+        nIndexEntries * sizeof(uint64_t) +
+        (m_sSharding.bIndexCRC32C ? sizeof(uint32_t) : 0);
+    vsi_l_offset nIndexOffset = 0;
+    if (!m_sSharding.bIndexAtStart)
+    {
+        if (VSIFSeekL(fp, 0, SEEK_END) != 0)
+            return nullptr;
+        const auto nFileSize = VSIFTellL(fp);
+        if (nFileSize < nIndexSize)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Shard %s is too small to contain its index",
+                     osFilename.c_str());
+            return nullptr;
+        }
+        nIndexOffset = nFileSize - nIndexSize;
+    }
+
+    std::vector<GByte> abyIndex;
+    std::shared_ptr<std::vector<uint64_t>> panIndex;
+    try
+    {
+        abyIndex.resize(nIndexSize);
+        panIndex = std::make_shared<std::vector<uint64_t>>(nIndexEntries);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate memory for index of shard %s",
+                 osFilename.c_str());
+        return nullptr;
+    }
+    if (VSIFSeekL(fp, nIndexOffset, SEEK_SET) != 0 ||
+        VSIFReadL(abyIndex.data(), 1, nIndexSize, fp) != nIndexSize)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot read index of shard %s",
+                 osFilename.c_str());
+        return nullptr;
+    }
+
+    if (m_sSharding.bIndexCRC32C)
+    {
+        uint32_t nExpectedCRC = 0;
+        memcpy(&nExpectedCRC,
+               abyIndex.data() + nIndexEntries * sizeof(uint64_t),
+               sizeof(nExpectedCRC));
+        CPL_LSBPTR32(&nExpectedCRC);
+        if (ZarrCRC32C(abyIndex.data(), nIndexEntries * sizeof(uint64_t)) !=
+            nExpectedCRC)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Invalid CRC32C checksum for index of shard %s",
+                     osFilename.c_str());
+            return nullptr;
+        }
+    }
+
+    memcpy(panIndex->data(), abyIndex.data(),
+           nIndexEntries * sizeof(uint64_t));
+#if !CPL_IS_LSB
+    for (auto &nVal : *panIndex)
+        CPL_SWAP64PTR(&nVal);
+#endif
+
+    std::lock_guard<std::mutex> oLock(m_oShardMutex);
+    m_oShardIndexCache.insert(osFilename, panIndex);
+    return panIndex;
+}
+
+/************************************************************************/
+/*                    ZarrV3Array::ReadShardChunks()                    */
+/************************************************************************/
+
+// Read the (still encoded) content of nTiles inner chunks, that must all
+// belong to the same shard. Only the shard index and the byte ranges of the
+// requested chunks are read.
+bool ZarrV3Array::ReadShardChunks(
+    const uint64_t *panTileIndices, size_t nTiles,
+    std::vector<ZarrByteVectorQuickResize> &aabyChunks,
+    std::vector<bool> &abMissing) const
+{
+    const size_t nDims = m_aoDims.size();
+    std::vector<uint64_t> anShardIndices;
+    std::vector<size_t> anIdxInShard(nTiles);
+    for (size_t i = 0; i < nTiles; ++i)
+    {
+        anIdxInShard[i] =
+            GetShardIndices(panTileIndices + i * nDims, anShardIndices);
+    }
+    aabyChunks.resize(nTiles);
+    abMissing.assign(nTiles, true);
+
+    // First look at chunks written, but not yet flushed to the shard
+    std::vector<size_t> anToRead;
+    {
+        std::unique_lock<std::mutex> oLock(m_oShardMutex);
+        // Wait for the shard to be fully written if it is being written
+        m_oShardWrittenCV.wait(
+            oLock, [this, &anShardIndices]()
+            { return m_oSetShardsBeingWritten.count(anShardIndices) == 0; });
+        const auto oIter = m_oMapShardWriteBuffers.find(anShardIndices);
+        for (size_t i = 0; i < nTiles; ++i)
+        {
+            if (oIter != m_oMapShardWriteBuffers.end() &&
+                oIter->second.abSet[anIdxInShard[i]])
+            {
+                const auto &abyChunk =
+                    oIter->second.aabyChunks[anIdxInShard[i]];
+                if (!abyChunk.empty())
+                {
+                    aabyChunks[i].resize(abyChunk.size());
+                    memcpy(aabyChunks[i].data(), abyChunk.data(),
+                           abyChunk.size());
+                    abMissing[i] = false;
+                }
+            }
+            else
+            {
+                anToRead.push_back(i);
+            }
+        }
+    }
+    if (anToRead.empty())
+        return true;
+
+    const std::string osFilename = BuildTileFilename(anShardIndices.data());
+    VSILFILE *fp = OpenTileFile(osFilename);
+    if (fp == nullptr)
+    {
+        // Missing shards are OK and indicate nodata_value
+        CPLDebugOnly(ZARR_DEBUG_KEY, "Shard %s missing (=nodata)",
+                     osFilename.c_str());
+        return true;
+    }
+
+    const auto panIndex = GetShardIndex(osFilename, fp);
+    if (!panIndex)
+    {
+        VSIFCloseL(fp);
+        return false;
+    }
+
+    // Collect the byte ranges to read, sorted by increasing offset
+    std::vector<std::pair<uint64_t, size_t>> anOffsetAndTile;
+    for (const size_t i : anToRead)
+    {
+        const uint64_t nOffset = (*panIndex)[2 * anIdxInShard[i]];
+        const uint64_t nSize = (*panIndex)[2 * anIdxInShard[i] + 1];
+        constexpr uint64_t MISSING = std::numeric_limits<uint64_t>::max();
+        if (nOffset == MISSING && nSize == MISSING)
+            continue;
+        if (nSize > static_cast<uint64_t>(std::numeric_limits<int>::max()) ||
+            nOffset > MISSING - nSize)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Invalid chunk size or offset in index of shard %s",
+                     osFilename.c_str());
+            VSIFCloseL(fp);
+            return false;
+        }
+        try
+        {
+            aabyChunks[i].resize(static_cast<size_t>(nSize));
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate memory for chunk of shard %s",
+                     osFilename.c_str());
+            VSIFCloseL(fp);
+            return false;
+        }
+        abMissing[i] = false;
+        if (nSize > 0)
+            anOffsetAndTile.emplace_back(nOffset, i);
+    }
+    std::sort(anOffsetAndTile.begin(), anOffsetAndTile.end());
+
+    std::vector<void *> apData;
+    std::vector<vsi_l_offset> anOffsets;
+    std::vector<size_t> anSizes;
+    bool bOverlap = false;
+    for (const auto &oPair : anOffsetAndTile)
+    {
+        const size_t i = oPair.second;
+        if (!anOffsets.empty() &&
+            anOffsets.back() + anSizes.back() > oPair.first)
+        {
+            bOverlap = true;
+        }
+        apData.push_back(aabyChunks[i].data());
+        anOffsets.push_back(static_cast<vsi_l_offset>(oPair.first));
+        anSizes.push_back(aabyChunks[i].size());
+    }
+
+    bool bRet = true;
+    if (apData.size() >= 2 && !bOverlap)
+    {
+        // Coalesced ranged reads on network file systems
+        bRet = VSIFReadMultiRangeL(static_cast<int>(apData.size()),
+                                   apData.data(), anOffsets.data(),
+                                   anSizes.data(), fp) == 0;
+    }
+    else
+    {
+        for (size_t i = 0; bRet && i < apData.size(); ++i)
+        {
+            bRet = VSIFSeekL(fp, anOffsets[i], SEEK_SET) == 0 &&
+                   VSIFReadL(apData[i], 1, anSizes[i], fp) == anSizes[i];
+        }
+    }
+    VSIFCloseL(fp);
+    if (!bRet)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Could not read chunks of shard %s correctly",
+                 osFilename.c_str());
+    }
+    return bRet;
+}
+
+/************************************************************************/
+/*                     ZarrV3Array::SetShardChunk()                     */
+/************************************************************************/
+
+// Store the encoded content of an inner chunk (nSize == 0 for an empty
+// chunk) in the write buffer of its shard, and write the shard once all its
+// chunks have been set.
+bool ZarrV3Array::SetShardChunk(const uint64_t *tileIndices,
+                                const GByte *pabyData, size_t nSize) const
+{
+    std::vector<uint64_t> anShardIndices;
+    const size_t nIdxInShard = GetShardIndices(tileIndices, anShardIndices);
+
+    ShardWriteBuffer sBufferToWrite;
+    {
+        std::lock_guard<std::mutex> oLock(m_oShardMutex);
+        auto &sBuffer = m_oMapShardWriteBuffers[anShardIndices];
+        if (sBuffer.abSet.empty())
+        {
+            sBuffer.aabyChunks.resize(m_nInnerChunksPerShard);
+            sBuffer.abSet.resize(m_nInnerChunksPerShard);
+            // Number of inner chunks of the shard within the array extent
+            sBuffer.nExpected = 1;
+            for (size_t i = 0; i < m_aoDims.size(); ++i)
+            {
+                const uint64_t nChunks =
+                    DIV_ROUND_UP(m_aoDims[i]->GetSize(), m_anBlockSize[i]);
+                const uint64_t nFirstChunk =
+                    anShardIndices[i] * m_anInnerChunksPerShard[i];
+                sBuffer.nExpected *= static_cast<size_t>(std::min(
+                    m_anInnerChunksPerShard[i], nChunks - nFirstChunk));
+            }
+        }
+        if (!sBuffer.abSet[nIdxInShard])
+        {
+            sBuffer.abSet[nIdxInShard] = true;
+            ++sBuffer.nSet;
+        }
+        sBuffer.aabyChunks[nIdxInShard].assign(pabyData, pabyData + nSize);
+        // If the shard is already being written by another thread, it will
+        // be written again by FlushShards()
+        if (sBuffer.nSet < sBuffer.nExpected ||
+            m_oSetShardsBeingWritten.count(anShardIndices) != 0)
+        {
+            return true;
+        }
+        sBufferToWrite = std::move(sBuffer);
+        m_oMapShardWriteBuffers.erase(anShardIndices);
+        m_oSetShardsBeingWritten.insert(anShardIndices);
+    }
+
+    const bool bRet = WriteShard(anShardIndices, sBufferToWrite);
+
+    {
+        std::lock_guard<std::mutex> oLock(m_oShardMutex);
+        m_oSetShardsBeingWritten.erase(anShardIndices);
+    }
+    m_oShardWrittenCV.notify_all();
+
+    return bRet;
+}
+
+/************************************************************************/
+/*                       ZarrV3Array::WriteShard()                      */
+/************************************************************************/
+
+bool ZarrV3Array::WriteShard(const std::vector<uint64_t> &anShardIndices,
+                             ShardWriteBuffer &sBuffer) const
+{
+    const std::string osFilename = BuildTileFilename(anShardIndices.data());
+    constexpr uint64_t MISSING = std::numeric_limits<uint64_t>::max();
+
+    // Retrieve chunks that have not been written from the existing shard
+    if (sBuffer.nSet < m_nInnerChunksPerShard)
+    {
+        VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "rb");
+        if (fp)
+        {
+            const auto panIndex = GetShardIndex(osFilename, fp);
+            bool bOK = panIndex != nullptr;
+            for (size_t i = 0; bOK && i < m_nInnerChunksPerShard; ++i)
+            {
+                const uint64_t nOffset = (*panIndex)[2 * i];
+                const uint64_t nSize = (*panIndex)[2 * i + 1];
+                if (sBuffer.abSet[i] ||
+                    (nOffset == MISSING && nSize == MISSING))
+                {
+                    continue;
+                }
+                if (nSize >
+                    static_cast<uint64_t>(std::numeric_limits<int>::max()))
+                {
+                    bOK = false;
+                    break;
+                }
+                auto &abyChunk = sBuffer.aabyChunks[i];
+                try
+                {
+                    abyChunk.resize(static_cast<size_t>(nSize));
+                }
+                catch (const std::exception &)
+                {
+                    bOK = false;
+                    break;
+                }
+                bOK = VSIFSeekL(fp, nOffset, SEEK_SET) == 0 &&
+                      VSIFReadL(abyChunk.data(), 1, abyChunk.size(), fp) ==
+                          abyChunk.size();
+            }
+            VSIFCloseL(fp);
+            if (!bOK)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Cannot read existing content of shard %s",
+                         osFilename.c_str());
+                return false;
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(m_oShardMutex);
+        m_oShardIndexCache.remove(osFilename);
+    }
+
+    if (std::all_of(sBuffer.aabyChunks.begin(), sBuffer.aabyChunks.end(),
+                    [](const std::vector<GByte> &abyChunk)
+                    { return abyChunk.empty(); }))
+    {
+        VSIStatBufL sStat;
+        if (VSIStatL(osFilename.c_str(), &sStat) == 0)
+        {
+            CPLDebugOnly(ZARR_DEBUG_KEY,
+                         "Deleting shard %s that has now empty content",
+                         osFilename.c_str());
+            return VSIUnlink(osFilename.c_str()) == 0;
+        }
+        return true;
+    }
+
+    // Build the shard index
+    const size_t nIndexEntries = 2 * m_nInnerChunksPerShard;
+    const size_t nIndexSize =
+        nIndexEntries * sizeof(uint64_t) +
+        (m_sSharding.bIndexCRC32C ? sizeof(uint32_t) : 0);
+    auto panIndex =
+        std::make_shared<std::vector<uint64_t>>(nIndexEntries, MISSING);
+    uint64_t nOffset = m_sSharding.bIndexAtStart ? nIndexSize : 0;
+    for (size_t i = 0; i < m_nInnerChunksPerShard; ++i)
+    {
+        const auto &abyChunk = sBuffer.aabyChunks[i];
+        if (!abyChunk.empty())
+        {
+            (*panIndex)[2 * i] = nOffset;
+            (*panIndex)[2 * i + 1] = abyChunk.size();
+            nOffset += abyChunk.size();
+        }
+    }
+    std::vector<GByte> abyIndex(nIndexSize);
+    for (size_t i = 0; i < nIndexEntries; ++i)
+    {
+        uint64_t nVal = (*panIndex)[i];
+        CPL_LSBPTR64(&nVal);
+        memcpy(abyIndex.data() + i * sizeof(uint64_t), &nVal, sizeof(nVal));
+    }
+    if (m_sSharding.bIndexCRC32C)
+    {
+        uint32_t nCRC =
+            ZarrCRC32C(abyIndex.data(), nIndexEntries * sizeof(uint64_t));
+        CPL_LSBPTR32(&nCRC);
+        memcpy(abyIndex.data() + nIndexEntries * sizeof(uint64_t), &nCRC,
+               sizeof(nCRC));
+    }
+
+    if (m_osDimSeparator == "/")
+    {
+        std::string osDir = CPLGetDirname(osFilename.c_str());
+        VSIStatBufL sStat;
+        if (VSIStatL(osDir.c_str(), &sStat) != 0)
+        {
+            if (VSIMkdirRecursive(osDir.c_str(), 0755) != 0)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Cannot create directory %s", osDir.c_str());
+                return false;
+            }
+        }
+    }
+
+    VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "wb");
+    if (fp == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot create shard %s",
+                 osFilename.c_str());
+        return false;
+    }
+
+    bool bRet = true;
+    if (m_sSharding.bIndexAtStart)
+        bRet = VSIFWriteL(abyIndex.data(), 1, nIndexSize, fp) == nIndexSize;
+    for (const auto &abyChunk : sBuffer.aabyChunks)
+    {
+        if (bRet && !abyChunk.empty())
+        {
+            bRet = VSIFWriteL(abyChunk.data(), 1, abyChunk.size(), fp) ==
+                   abyChunk.size();
+        }
+    }
+    if (bRet && !m_sSharding.bIndexAtStart)
+        bRet = VSIFWriteL(abyIndex.data(), 1, nIndexSize, fp) == nIndexSize;
+    if (VSIFCloseL(fp) != 0)
+        bRet = false;
+    if (!bRet)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Could not write shard %s correctly", osFilename.c_str());
+        return false;
+    }
+
+    std::lock_guard<std::mutex> oLock(m_oShardMutex);
+    m_oShardIndexCache.insert(osFilename, panIndex);
+    return true;
+}
+
+/************************************************************************/
+/*                      ZarrV3Array::FlushShards()                      */
+/************************************************************************/
+
+// Write the shards whose chunks have not all been written
+bool ZarrV3Array::FlushShards() const
+{
+    std::map<std::vector<uint64_t>, ShardWriteBuffer> oMapShardWriteBuffers;
+    {
+        std::lock_guard<std::mutex> oLock(m_oShardMutex);
+        std::swap(oMapShardWriteBuffers, m_oMapShardWriteBuffers);
+    }
+
+    bool bRet = true;
+    for (auto &oIter : oMapShardWriteBuffers)
+    {
+        if (!WriteShard(oIter.first, oIter.second))
+            bRet = false;
+    }
+    return bRet;
+}
+
 /************************************************************************/
 /*                          BuildTileFilename()                         */
 /************************************************************************/
@@ -1584,7 +2367,74 @@ ZarrV3Group::LoadArray(const std::string &osArrayName,
         return nullptr;
     }
 
-    const auto oCodecs = oRoot["codecs"].ToArray();
+    auto oCodecs = oRoot["codecs"].ToArray();
+    ZarrV3ShardingInfo sSharding;
+    if (oCodecs.Size() > 0 &&
+        oCodecs[0]["name"].ToString() == ZarrV3ShardingInfo::CODEC_NAME)
+    {
+        if (oCodecs.Size() != 1)
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "Codecs after %s are not supported",
+                     ZarrV3ShardingInfo::CODEC_NAME);
+            return nullptr;
+        }
+        const auto oConfiguration = oCodecs[0]["configuration"];
+
+        // The chunks of the chunk grid are the shards, and the chunks
+        // are the inner chunks of the sharding codec
+        const auto oInnerChunks = oConfiguration["chunk_shape"].ToArray();
+        if (oInnerChunks.Size() != oChunks.Size())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "%s: invalid chunk_shape", ZarrV3ShardingInfo::CODEC_NAME);
+            return nullptr;
+        }
+        std::vector<GUInt64> anInnerBlockSize;
+        if (!ZarrArray::ParseChunkSize(oInnerChunks, oType, anInnerBlockSize))
+            return nullptr;
+        sSharding.anShardSize = std::move(anBlockSize);
+        anBlockSize = std::move(anInnerBlockSize);
+
+        const auto osIndexLocation =
+            oConfiguration.GetString("index_location", "end");
+        if (osIndexLocation == "start")
+            sSharding.bIndexAtStart = true;
+        else if (osIndexLocation != "end")
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "%s: unsupported index_location = %s",
+                     ZarrV3ShardingInfo::CODEC_NAME, osIndexLocation.c_str());
+            return nullptr;
+        }
+
+        // Only a little-endian index, optionally followed by a CRC32C
+        // checksum, is supported
+        sSharding.oIndexCodecs = oConfiguration["index_codecs"].ToArray();
+        for (const auto &oIndexCodec : sSharding.oIndexCodecs)
+        {
+            const auto osName = oIndexCodec["name"].ToString();
+            if ((osName == "endian" || osName == "bytes") &&
+                !sSharding.bIndexCRC32C &&
+                oIndexCodec["configuration"].GetString("endian", "little") ==
+                    "little")
+            {
+                continue;
+            }
+            if (osName == "crc32c" && !sSharding.bIndexCRC32C)
+            {
+                sSharding.bIndexCRC32C = true;
+                continue;
+            }
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "%s: unsupported index_codecs",
+                     ZarrV3ShardingInfo::CODEC_NAME);
+            return nullptr;
+        }
+
+        oCodecs = oConfiguration["codecs"].ToArray();
+    }
+
     std::unique_ptr<ZarrV3CodecSequence> poCodecs;
     if (oCodecs.Size() > 0)
     {
@@ -1619,6 +2469,8 @@ ZarrV3Group::LoadArray(const std::string &osArrayName,
     poArray->SetDtype(oDtype);
     if (poCodecs)
         poArray->SetCodecs(std::move(poCodecs));
+    if (!sSharding.anShardSize.empty() && !poArray->SetSharding(sSharding))
+        return nullptr;
     RegisterArray(poArray);
 
     // If this is an indexing variable, attach it to the dimension.
@@ -1631,7 +2483,10 @@ ZarrV3Group::LoadArray(const std::string &osArrayName,
         }
     }
 
-    if (CPLTestBool(m_poSharedResource->GetOpenOptions().FetchNameValueDef(
+    // The tile presence cache is not relevant for sharded arrays, as files
+    // are shards and not chunks
+    if (sSharding.anShardSize.empty() &&
+        CPLTestBool(m_poSharedResource->GetOpenOptions().FetchNameValueDef(
             "CACHE_TILE_PRESENCE", "NO")))
     {
         poArray->CacheTilePresence();
@@ -980,7 +980,10 @@ bool ZarrV3CodecSequence::InitFromJson(const CPLJSONObject &oCodecs)
             poCodec = std::make_unique<ZarrV3CodecGZip>();
         else if (osName == "blosc")
             poCodec = std::make_unique<ZarrV3CodecBlosc>();
-        else if (osName == "endian")
+        else if (osName == "endian" ||
+                 // "bytes" is the name of the endian codec in the final
+                 // version of the Zarr V3 specification
+                 osName == "bytes")
             poCodec = std::make_unique<ZarrV3CodecEndian>();
         else if (osName == "transpose")
             poCodec = std::make_unique<ZarrV3CodecTranspose>();
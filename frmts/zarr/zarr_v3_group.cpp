@@ -30,6 +30,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdlib>
 #include <limits>
 #include <map>
 #include <set>
@@ -551,6 +552,42 @@ std::shared_ptr<GDALMDArray> ZarrV3Group::CreateMDArray(
                                   papszOptions))
         return nullptr;
 
+    ZarrV3ShardingInfo sSharding;
+    const char *pszShardSize = CSLFetchNameValue(papszOptions, "SHARD_SIZE");
+    if (pszShardSize)
+    {
+        const CPLStringList aosTokens(
+            CSLTokenizeString2(pszShardSize, ",", 0));
+        if (static_cast<size_t>(aosTokens.size()) != aoDimensions.size())
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Invalid number of values in SHARD_SIZE");
+            return nullptr;
+        }
+        for (int i = 0; i < aosTokens.size(); ++i)
+        {
+            const auto nShardSize = std::strtoull(aosTokens[i], nullptr, 10);
+            if (nShardSize == 0 || (nShardSize % anBlockSize[i]) != 0)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "SHARD_SIZE values must be multiple of the "
+                         "corresponding BLOCKSIZE values");
+                return nullptr;
+            }
+            sSharding.anShardSize.push_back(nShardSize);
+        }
+
+        CPLJSONObject oEndianCodec;
+        oEndianCodec.Add("name", "endian");
+        oEndianCodec.Add("configuration",
+                         ZarrV3CodecEndian::GetConfiguration(true));
+        sSharding.oIndexCodecs.Add(oEndianCodec);
+        CPLJSONObject oCRC32CCodec;
+        oCRC32CCodec.Add("name", "crc32c");
+        sSharding.oIndexCodecs.Add(oCRC32CCodec);
+        sSharding.bIndexCRC32C = true;
+    }
+
     const char *pszDimSeparator =
         CSLFetchNameValueDef(papszOptions, "DIM_SEPARATOR", "/");
 
@@ -697,6 +734,8 @@ std::shared_ptr<GDALMDArray> ZarrV3Group::CreateMDArray(
     poArray->SetDtype(dtype);
     if (poCodecs)
         poArray->SetCodecs(std::move(poCodecs));
+    if (!sSharding.anShardSize.empty() && !poArray->SetSharding(sSharding))
+        return nullptr;
     poArray->SetUpdatable(true);
     poArray->SetDefinitionModified(true);
     poArray->Flush();
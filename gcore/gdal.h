@@ -205,6 +205,22 @@ typedef struct
     double dfYSize;
 } GDALRasterIOExtraArg;
 
+/** Window of a raster, in pixel coordinates, as submitted to
+ * GDALDatasetAdviseReadPlan().
+ * @since GDAL 3.9
+ */
+typedef struct
+{
+    /*! Pixel offset of the top left corner of the window */
+    int nXOff;
+    /*! Line offset of the top left corner of the window */
+    int nYOff;
+    /*! Width of the window, in pixels */
+    int nXSize;
+    /*! Height of the window, in lines */
+    int nYSize;
+} GDALRasterWindow;
+
 #ifndef DOXYGEN_SKIP
 #define RASTERIO_EXTRA_ARG_CURRENT_VERSION 1
 #endif
@@ -378,6 +394,16 @@ typedef struct GDALDimensionHS *GDALDimensionH;
  */
 #define GDAL_DMD_EXTENSIONS "DMD_EXTENSIONS"
 
+/** List of (space separated) signatures of the files handled by the driver,
+ * each signature being the hexadecimal encoding of the first bytes (at least
+ * 2) of the file.
+ * GDALOpenEx() probes first the drivers whose signature matches the file.
+ * A driver should only declare signatures that no other driver, except
+ * other drivers declaring the same signature, can recognize.
+ * @since GDAL 3.9
+ */
+#define GDAL_DMD_SIGNATURES "DMD_SIGNATURES"
+
 /** XML snippet with creation options. */
 #define GDAL_DMD_CREATIONOPTIONLIST "DMD_CREATIONOPTIONLIST"
 
@@ -1019,6 +1045,33 @@ GDALDatasetH CPL_DLL CPL_STDCALL GDALOpenShared(const char *, GDALAccess)
 #define GDAL_OF_FROM_GDALOPEN 0x400
 #endif
 
+/** Open in read-only mode a raster dataset that can be used concurrently
+ * from several threads.
+ *
+ * Must be combined with GDAL_OF_RASTER, and is not compatible with
+ * GDAL_OF_UPDATE, GDAL_OF_VECTOR, GDAL_OF_MULTIDIM_RASTER, GDAL_OF_GNM or
+ * GDAL_OF_SHARED.
+ *
+ * Used by GDALOpenEx().
+ * @since GDAL 3.9
+ */
+#define GDAL_OF_THREAD_SAFE 0x800
+
+/** Open a dataset only to read its header, typically to scan the metadata
+ * of many files.
+ *
+ * The side-car files of the dataset (.aux.xml PAM file, external .ovr
+ * overviews, .msk masks, world files, etc.) are neither looked for nor
+ * read, and the directory of the file is not listed. Only what is stored
+ * in the file itself is reported.
+ *
+ * Not compatible with GDAL_OF_UPDATE.
+ *
+ * Used by GDALOpenEx().
+ * @since GDAL 3.9
+ */
+#define GDAL_OF_HEADER_ONLY 0x1000
+
 GDALDatasetH CPL_DLL CPL_STDCALL GDALOpenEx(
     const char *pszFilename, unsigned int nOpenFlags,
     const char *const *papszAllowedDrivers, const char *const *papszOpenOptions,
@@ -1131,6 +1184,9 @@ int CPL_DLL CPL_STDCALL GDALGetRasterYSize(GDALDatasetH);
 int CPL_DLL CPL_STDCALL GDALGetRasterCount(GDALDatasetH);
 GDALRasterBandH CPL_DLL CPL_STDCALL GDALGetRasterBand(GDALDatasetH, int);
 
+bool CPL_DLL GDALDatasetIsThreadSafe(GDALDatasetH, int nScopeFlags,
+                                     CSLConstList papszOptions);
+
 CPLErr CPL_DLL CPL_STDCALL GDALAddBand(GDALDatasetH hDS, GDALDataType eType,
                                        CSLConstList papszOptions);
 
@@ -1161,6 +1217,12 @@ CPLErr CPL_DLL CPL_STDCALL GDALDatasetAdviseRead(
     int nBXSize, int nBYSize, GDALDataType eBDataType, int nBandCount,
     int *panBandCount, CSLConstList papszOptions);
 
+CPLErr CPL_DLL GDALDatasetAdviseReadPlan(GDALDatasetH hDS, int nWindowCount,
+                                         const GDALRasterWindow *pasWindows,
+                                         int nBandCount,
+                                         const int *panBandList,
+                                         CSLConstList papszOptions);
+
 char CPL_DLL **
 GDALDatasetGetCompressionFormats(GDALDatasetH hDS, int nXOff, int nYOff,
                                  int nXSize, int nYSize, int nBandCount,
@@ -1170,6 +1232,12 @@ CPLErr CPL_DLL GDALDatasetReadCompressedData(
     int nYSize, int nBandCount, const int *panBandList, void **ppBuffer,
     size_t *pnBufferSize, char **ppszDetailedFormat);
 
+CPLErr CPL_DLL GDALDatasetComputeStatistics(GDALDatasetH hDS, int nBandCount,
+                                            const int *panBandList,
+                                            int bApproxOK,
+                                            GDALProgressFunc pfnProgress,
+                                            void *pProgressData);
+
 const char CPL_DLL *CPL_STDCALL GDALGetProjectionRef(GDALDatasetH);
 OGRSpatialReferenceH CPL_DLL GDALGetSpatialRef(GDALDatasetH);
 CPLErr CPL_DLL CPL_STDCALL GDALSetProjection(GDALDatasetH, const char *);
@@ -2054,6 +2122,40 @@ void CPL_DLL CPL_STDCALL GDALSetCacheMax64(GIntBig nBytes);
 GIntBig CPL_DLL CPL_STDCALL GDALGetCacheMax64(void);
 GIntBig CPL_DLL CPL_STDCALL GDALGetCacheUsed64(void);
 
+/** Statistics on the raster block cache. See GDALGetCacheStatistics()
+ * @since GDAL 3.9
+ */
+typedef struct
+{
+    /*! Number of blocks requests served from the cache */
+    GIntBig nHits;
+    /*! Number of blocks that had to be loaded in the cache */
+    GIntBig nMisses;
+    /*! Number of blocks evicted from the cache to recover memory */
+    GIntBig nEvictions;
+    /*! Number of blocks loaded from the compressed block cache */
+    GIntBig nCompressedHits;
+    /*! Memory used by the compressed block cache, in bytes */
+    GIntBig nCompressedUsed;
+    /*! Number of dirty blocks written to their dataset */
+    GIntBig nDirtyBlockWrites;
+    /*! Time spent writing dirty blocks, in seconds */
+    double dfDirtyBlockWriteTime;
+    /*! Time spent waiting on the block cache locks, in seconds. Only
+     * measured when GDAL_CACHE_LOCK_TIMING=YES */
+    double dfLockWaitTime;
+} GDALCacheStatistics;
+
+void CPL_DLL GDALGetCacheStatistics(GDALCacheStatistics *psStats);
+void CPL_DLL GDALResetCacheStatistics(void);
+
+GIntBig CPL_DLL GDALDatasetGetBlockCacheUsed(GDALDatasetH hDS);
+void CPL_DLL GDALDatasetSetBlockCacheQuota(GDALDatasetH hDS,
+                                           GIntBig nQuotaBytes);
+GIntBig CPL_DLL GDALDatasetGetBlockCacheQuota(GDALDatasetH hDS);
+void CPL_DLL GDALDatasetSetBlockCachePriority(GDALDatasetH hDS, int nPriority);
+int CPL_DLL GDALDatasetGetBlockCachePriority(GDALDatasetH hDS);
+
 int CPL_DLL CPL_STDCALL GDALFlushCacheBlock(void);
 
 /* ==================================================================== */
@@ -4459,6 +4459,44 @@ double GDALAdjustNoDataCloseToFloatMax(double dfVal)
     return dfVal;
 }
 
+/************************************************************************/
+/*                       GDALGetEmptyBlockValue()                       */
+/************************************************************************/
+
+// Returns whether the value of the pixels of the areas that
+// GetDataCoverageStatus() reports as empty, like the missing tiles of a
+// sparse GeoTIFF file, can be used without reading them, in which case it
+// is set in *pdfValue: the nodata value, when it can be represented exactly
+// in the data type of the band, or 0 when there is no nodata value.
+
+bool GDALGetEmptyBlockValue(GDALRasterBand *poBand, double *pdfValue)
+{
+    *pdfValue = 0;
+
+    // Avoid the flush of the block cache done by some drivers in
+    // GetDataCoverageStatus() in update mode.
+    if (poBand->GetAccess() != GA_ReadOnly)
+        return false;
+
+    const GDALDataType eDT = poBand->GetRasterDataType();
+    if (eDT == GDT_Int64 || eDT == GDT_UInt64 || GDALDataTypeIsComplex(eDT))
+        return false;
+
+    int bHasNoData = FALSE;
+    const double dfNoDataValue = poBand->GetNoDataValue(&bHasNoData);
+    if (!bHasNoData)
+        return true;
+    *pdfValue = dfNoDataValue;
+    if (CPLIsNan(dfNoDataValue))
+        return GDALDataTypeIsFloating(eDT) != FALSE;
+
+    GByte abyValue[sizeof(double)];
+    double dfRoundTripValue = 0;
+    GDALCopyWords(&dfNoDataValue, GDT_Float64, 0, abyValue, eDT, 0, 1);
+    GDALCopyWords(abyValue, eDT, 0, &dfRoundTripValue, GDT_Float64, 0, 1);
+    return dfRoundTripValue == dfNoDataValue;
+}
+
 /************************************************************************/
 /*                        GDALCopyNoDataValue()                         */
 /************************************************************************/
@@ -574,6 +574,10 @@ class CPL_DLL GDALDataset : public GDALMajorObject
                               int nBufXSize, int nBufYSize, GDALDataType eDT,
                               int nBandCount, int *panBandList,
                               char **papszOptions);
+    virtual CPLErr AdviseReadPlan(int nWindowCount,
+                                  const GDALRasterWindow *pasWindows,
+                                  int nBandCount, const int *panBandList,
+                                  CSLConstList papszOptions);
 
     virtual CPLErr CreateMaskBand(int nFlagsIn);
 
@@ -608,6 +612,8 @@ class CPL_DLL GDALDataset : public GDALMajorObject
     virtual bool GetRawBinaryLayout(RawBinaryLayout &);
     //! @endcond
 
+    virtual bool IsThreadSafe(int nScopeFlags) const;
+
     CPLErr RasterIO(GDALRWFlag, int, int, int, int, void *, int, int,
                     GDALDataType, int, int *, GSpacing, GSpacing, GSpacing,
                     GDALRasterIOExtraArg *psExtraArg
@@ -626,6 +632,10 @@ class CPL_DLL GDALDataset : public GDALMajorObject
                                       void **ppBuffer, size_t *pnBufferSize,
                                       char **ppszDetailedFormat);
 
+    CPLErr ComputeStatistics(int nBandCount, const int *panBandList,
+                             bool bApproxOK, GDALProgressFunc pfnProgress,
+                             void *pProgressData);
+
     int Reference();
     int Dereference();
     int ReleaseRef();
@@ -737,8 +747,17 @@ class CPL_DLL GDALDataset : public GDALMajorObject
 
     // Only to be used by driver's GetOverviewCount() method.
     bool AreOverviewsEnabled() const;
+
+    // Only to be used by GDALRasterBlock
+    void AddBlockCacheUsed(GIntBig nDelta);
     //! @endcond
 
+    GIntBig GetBlockCacheUsed() const;
+    void SetBlockCacheQuota(GIntBig nQuotaBytes);
+    GIntBig GetBlockCacheQuota() const;
+    void SetBlockCachePriority(int nPriority);
+    int GetBlockCachePriority() const;
+
   private:
     class Private;
     Private *m_poPrivate;
@@ -1015,8 +1034,18 @@ class CPL_DLL GDALRasterBlock
 
     bool bMustDetach;
 
+    // Index of the block cache shard this block belongs to
+    int nShard;
+
+    // Whether the block is in the protected segment of the 2Q policy
+    bool bProtected;
+
     CPL_INTERNAL void Detach_unlocked(void);
     CPL_INTERNAL void Touch_unlocked(void);
+    CPL_INTERNAL void Insert2Q_unlocked(void);
+    CPL_INTERNAL void Evict_unlocked(void);
+    CPL_INTERNAL static void ScheduleWriteBack();
+    CPL_INTERNAL static void WriteBackFunc(void *);
 
     CPL_INTERNAL void RecycleFor(int nXOffIn, int nYOffIn);
 
@@ -1104,6 +1133,12 @@ class CPL_DLL GDALRasterBlock
     int TakeLock();
     int DropLockForRemovalFromStorage();
 
+    //! @cond Doxygen_Suppress
+    CPL_INTERNAL void StoreInCompressedCache();
+    CPL_INTERNAL bool LoadFromCompressedCache();
+    CPL_INTERNAL static void PurgeCompressedCache(GDALRasterBand *poBand);
+    //! @endcond
+
     /// @brief Accessor to source GDALRasterBand object.
     /// @return source raster band of the raster block.
     GDALRasterBand *GetBand()
@@ -1353,6 +1388,7 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
   protected:
     virtual CPLErr IReadBlock(int nBlockXOff, int nBlockYOff, void *pData) = 0;
     virtual CPLErr IWriteBlock(int nBlockXOff, int nBlockYOff, void *pData);
+    virtual bool CanReadBlockIntoBuffer() const;
 
     virtual CPLErr
     IRasterIO(GDALRWFlag, int, int, int, int, void *, int, int, GDALDataType,
@@ -1633,6 +1669,10 @@ class CPL_DLL GDALNoDataMaskBand : public GDALRasterBand
     static bool IsNoDataInRange(double dfNoDataValue, GDALDataType eDataType);
 };
 
+void CPL_DLL GDALComputeNoDataMask(const void *pSrc, GDALDataType eWrkDT,
+                                   double dfNoDataValue, GByte *pabyMask,
+                                   size_t nCount, bool bCombine);
+
 /* ******************************************************************** */
 /*                  GDALNoDataValuesMaskBand                            */
 /* ******************************************************************** */
@@ -2011,6 +2051,9 @@ class GDALPluginDriverProxy : public GDALDriver
     {
         m_osPluginFullPath = osFullPath;
     }
+
+    static int IdentifyFromCachedMetadata(GDALDriver *poDriver,
+                                          GDALOpenInfo *poOpenInfo);
     //! @endcond
 
   public:
@@ -2071,6 +2114,14 @@ class CPL_DLL GDALDriverManager : public GDALMajorObject
     std::map<std::string, std::unique_ptr<GDALDriver>> m_oMapRealDrivers{};
     std::vector<std::unique_ptr<GDALDriver>> m_aoHiddenDrivers{};
 
+    // GDAL_DMD_SIGNATURES of the registered drivers, indexed by their first
+    // two bytes. Drivers are in their registration order.
+    std::map<GUInt16, std::vector<std::pair<std::string, GDALDriver *>>>
+        m_oMapSignatureToDrivers{};
+    bool m_bSignatureIndexDirty = true;
+
+    void BuildSignatureIndex_unlocked();
+
     GDALDriver *GetDriver_unlocked(int iDriver)
     {
         return (iDriver >= 0 && iDriver < nDrivers) ? papoDrivers[iDriver]
@@ -2103,6 +2154,8 @@ class CPL_DLL GDALDriverManager : public GDALMajorObject
     static char **GetSearchPaths(const char *pszGDAL_DRIVER_PATH);
     int GetDriverCount(bool bIncludeHidden) const;
     GDALDriver *GetDriver(int iDriver, bool bIncludeHidden);
+    std::vector<GDALDriver *>
+    GetDriversMatchingSignature(const GByte *pabyHeader, int nHeaderBytes);
     //! @endcond
 
   public:
@@ -3990,6 +4043,11 @@ void GDALRasterIOExtraArgSetResampleAlg(GDALRasterIOExtraArg *psExtraArg,
 GDALDataset *GDALCreateOverviewDataset(GDALDataset *poDS, int nOvrLevel,
                                        bool bThisLevelOnly);
 
+GDALDataset *GDALCreateThreadSafeDataset(GDALDatasetUniquePtr poPrototypeDS,
+                                         const char *pszFilename,
+                                         unsigned int nOpenFlags,
+                                         CSLConstList papszOpenOptions);
+
 // Should cover particular cases of #3573, #4183, #4506, #6578
 // Behavior is undefined if fVal1 or fVal2 are NaN (should be tested before
 // calling this function)
@@ -4002,6 +4060,10 @@ template <class T> inline bool ARE_REAL_EQUAL(T fVal1, T fVal2, int ulp = 2)
 
 double GDALAdjustNoDataCloseToFloatMax(double dfVal);
 
+GIntBig CPL_DLL GDALGetAdviseReadPlanMaxBytes(CSLConstList papszOptions);
+
+bool GDALGetEmptyBlockValue(GDALRasterBand *poBand, double *pdfValue);
+
 #define DIV_ROUND_UP(a, b) (((a) % (b)) == 0 ? ((a) / (b)) : (((a) / (b)) + 1))
 
 // Number of data samples that will be used to compute approximate statistics
@@ -91,6 +91,9 @@ class CPL_DLL GDALProxyDataset : public GDALDataset
                       int nBufXSize, int nBufYSize, GDALDataType eDT,
                       int nBandCount, int *panBandList,
                       char **papszOptions) override;
+    CPLErr AdviseReadPlan(int nWindowCount, const GDALRasterWindow *pasWindows,
+                          int nBandCount, const int *panBandList,
+                          CSLConstList papszOptions) override;
 
     CPLErr CreateMaskBand(int nFlags) override;
 
@@ -231,7 +234,16 @@ class CPL_DLL GDALProxyPoolDataset : public GDALProxyDataset
     CPLHashSet *metadataSet = nullptr;
     CPLHashSet *metadataItemSet = nullptr;
 
+    // In read-only mode, whether the SRS, geotransform and GCPs of the
+    // underlying dataset have already been fetched, and thus do not need to be
+    // fetched again.
+    mutable bool m_bSRSFetched = false;
+    bool m_bGeoTransformFetched = false;
+    bool m_bGCPsFetched = false;
+    mutable bool m_bGCPSRSFetched = false;
+
     mutable GDALProxyPoolCacheEntry *cacheEntry = nullptr;
+    mutable GUInt32 m_nCacheEntryGeneration = 0;
     char *m_pszOwner = nullptr;
 
     GDALDataset *RefUnderlyingDataset(bool bForceOpen) const;
@@ -291,11 +303,17 @@ class CPL_DLL GDALProxyPoolDataset : public GDALProxyDataset
     char **GetMetadata(const char *pszDomain) override;
     const char *GetMetadataItem(const char *pszName,
                                 const char *pszDomain) override;
+    CPLErr SetMetadata(char **papszMetadata, const char *pszDomain) override;
+    CPLErr SetMetadataItem(const char *pszName, const char *pszValue,
+                           const char *pszDomain) override;
 
     void *GetInternalHandle(const char *pszRequest) override;
 
+    int GetGCPCount() override;
     const OGRSpatialReference *GetGCPSpatialRef() const override;
     const GDAL_GCP *GetGCPs() override;
+    CPLErr SetGCPs(int nGCPCount, const GDAL_GCP *pasGCPList,
+                   const OGRSpatialReference *poGCP_SRS) override;
 
   private:
     CPL_DISALLOW_COPY_ASSIGN(GDALProxyPoolDataset)
@@ -321,6 +339,13 @@ class CPL_DLL GDALProxyPoolRasterBand : public GDALProxyRasterBand
     GDALProxyPoolOverviewRasterBand **papoProxyOverviewRasterBand = nullptr;
     GDALProxyPoolMaskBand *poProxyMaskBand = nullptr;
 
+    // Snapshot of the properties of the underlying band, in read-only mode
+    struct Snapshot;
+    std::unique_ptr<Snapshot> m_poSnapshot{};
+
+    Snapshot *GetSnapshot();
+    void InvalidateSnapshot();
+
   protected:
     GDALRasterBand *
     RefUnderlyingRasterBand(bool bForceOpen = true) const override;
@@ -349,9 +374,33 @@ class CPL_DLL GDALProxyPoolRasterBand : public GDALProxyRasterBand
     char **GetMetadata(const char *pszDomain) override;
     const char *GetMetadataItem(const char *pszName,
                                 const char *pszDomain) override;
+    CPLErr SetMetadata(char **papszMetadata, const char *pszDomain) override;
+    CPLErr SetMetadataItem(const char *pszName, const char *pszValue,
+                           const char *pszDomain) override;
     char **GetCategoryNames() override;
     const char *GetUnitType() override;
     GDALColorTable *GetColorTable() override;
+
+    // Those methods return a value snapshotted in read-only mode.
+    double GetNoDataValue(int *pbSuccess = nullptr) override;
+    double GetOffset(int *pbSuccess = nullptr) override;
+    double GetScale(int *pbSuccess = nullptr) override;
+    GDALColorInterp GetColorInterpretation() override;
+    int GetOverviewCount() override;
+    int GetMaskFlags() override;
+
+    CPLErr SetCategoryNames(char **) override;
+    CPLErr SetNoDataValue(double) override;
+    CPLErr DeleteNoDataValue() override;
+    CPLErr SetColorTable(GDALColorTable *) override;
+    CPLErr SetColorInterpretation(GDALColorInterp) override;
+    CPLErr SetOffset(double) override;
+    CPLErr SetScale(double) override;
+    CPLErr SetUnitType(const char *) override;
+    CPLErr BuildOverviews(const char *, int, const int *, GDALProgressFunc,
+                          void *, CSLConstList papszOptions) override;
+    CPLErr CreateMaskBand(int nFlags) override;
+
     GDALRasterBand *GetOverview(int) override;
     GDALRasterBand *
     GetRasterSampleOverview(GUIntBig nDesiredSamples) override;  // TODO
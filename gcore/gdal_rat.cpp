@@ -32,11 +32,16 @@
 #include "gdal_priv.h"
 #include "gdal_rat.h"
 
+#include <climits>
 #include <cmath>
 #include <cstddef>
 #include <cstdlib>
+#include <cstring>
 
 #include <algorithm>
+#include <limits>
+#include <new>
+#include <string>
 #include <vector>
 
 #include "cpl_conv.h"
@@ -598,6 +603,181 @@ CPLErr CPL_STDCALL GDALRATSetTableType(GDALRasterAttributeTableH hRAT,
         eInTableType);
 }
 
+/************************************************************************/
+/*                    GDALRATUseBinaryXMLEncoding()                     */
+/************************************************************************/
+
+// Number of rows from which the column values are serialized as
+// compressed binary blobs rather than as Row/F elements.
+constexpr int RAT_BINARY_XML_ENCODING_ROW_THRESHOLD = 100000;
+
+static bool GDALRATUseBinaryXMLEncoding(int nRowCount)
+{
+    const char *pszVal =
+        CPLGetConfigOption("GDAL_RAT_XML_BINARY_ENCODING", "AUTO");
+    if (EQUAL(pszVal, "AUTO"))
+        return nRowCount >= RAT_BINARY_XML_ENCODING_ROW_THRESHOLD;
+    return CPLTestBool(pszVal);
+}
+
+/************************************************************************/
+/*                       GDALRATEncodeColumnData()                      */
+/*                                                                      */
+/*      Encode the values of a column as base64 of deflate-compressed   */
+/*      little-endian Int32, Float64, or nul-terminated strings.        */
+/************************************************************************/
+
+static bool GDALRATEncodeColumnData(const GDALRasterAttributeTable *poRAT,
+                                    int iCol, int nRowCount,
+                                    std::string &osEncoded)
+{
+    std::vector<GByte> abyRaw;
+    try
+    {
+        const GDALRATFieldType eType = poRAT->GetTypeOfCol(iCol);
+        if (eType == GFT_Integer)
+        {
+            abyRaw.resize(static_cast<size_t>(nRowCount) * sizeof(GInt32));
+            for (int iRow = 0; iRow < nRowCount; iRow++)
+            {
+                GInt32 nVal = poRAT->GetValueAsInt(iRow, iCol);
+                CPL_LSBPTR32(&nVal);
+                memcpy(abyRaw.data() + iRow * sizeof(GInt32), &nVal,
+                       sizeof(nVal));
+            }
+        }
+        else if (eType == GFT_Real)
+        {
+            abyRaw.resize(static_cast<size_t>(nRowCount) * sizeof(double));
+            for (int iRow = 0; iRow < nRowCount; iRow++)
+            {
+                double dfVal = poRAT->GetValueAsDouble(iRow, iCol);
+                CPL_LSBPTR64(&dfVal);
+                memcpy(abyRaw.data() + iRow * sizeof(double), &dfVal,
+                       sizeof(dfVal));
+            }
+        }
+        else
+        {
+            for (int iRow = 0; iRow < nRowCount; iRow++)
+            {
+                const char *pszVal = poRAT->GetValueAsString(iRow, iCol);
+                abyRaw.insert(abyRaw.end(), pszVal,
+                              pszVal + strlen(pszVal) + 1);
+            }
+        }
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+
+    size_t nCompressedSize = 0;
+    void *pCompressed = CPLZLibDeflate(abyRaw.data(), abyRaw.size(), -1,
+                                       nullptr, 0, &nCompressedSize);
+    if (pCompressed == nullptr)
+        return false;
+    if (nCompressedSize > static_cast<size_t>(INT_MAX / 4 * 3))
+    {
+        VSIFree(pCompressed);
+        return false;
+    }
+
+    char *pszBase64 = CPLBase64Encode(static_cast<int>(nCompressedSize),
+                                      static_cast<GByte *>(pCompressed));
+    VSIFree(pCompressed);
+    osEncoded = pszBase64;
+    CPLFree(pszBase64);
+    return true;
+}
+
+/************************************************************************/
+/*                       GDALRATDecodeColumnData()                      */
+/************************************************************************/
+
+static CPLErr GDALRATDecodeColumnData(GDALRasterAttributeTable *poRAT,
+                                      int iCol, int nRowCount,
+                                      const char *pszEncoded)
+{
+    GByte *pabyBase64 = reinterpret_cast<GByte *>(CPLStrdup(pszEncoded));
+    const int nCompressedSize = CPLBase64DecodeInPlace(pabyBase64);
+    size_t nRawSize = 0;
+    GByte *pabyRaw = static_cast<GByte *>(
+        CPLZLibInflate(pabyBase64, nCompressedSize, nullptr, 0, &nRawSize));
+    CPLFree(pabyBase64);
+    if (pabyRaw == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot decompress RAT column data for column %d", iCol);
+        return CE_Failure;
+    }
+
+    CPLErr eErr = CE_None;
+    const GDALRATFieldType eType = poRAT->GetTypeOfCol(iCol);
+    if (eType == GFT_Integer || eType == GFT_Real)
+    {
+        const size_t nValSize =
+            eType == GFT_Integer ? sizeof(GInt32) : sizeof(double);
+        if (nRawSize != static_cast<size_t>(nRowCount) * nValSize)
+        {
+            eErr = CE_Failure;
+        }
+        else if (eType == GFT_Integer)
+        {
+            GInt32 *panValues = reinterpret_cast<GInt32 *>(pabyRaw);
+#ifdef CPL_MSB
+            GDALSwapWords(panValues, sizeof(GInt32), nRowCount,
+                          sizeof(GInt32));
+#endif
+            eErr = poRAT->ValuesIO(GF_Write, iCol, 0, nRowCount, panValues);
+        }
+        else
+        {
+            double *padfValues = reinterpret_cast<double *>(pabyRaw);
+#ifdef CPL_MSB
+            GDALSwapWords(padfValues, sizeof(double), nRowCount,
+                          sizeof(double));
+#endif
+            eErr = poRAT->ValuesIO(GF_Write, iCol, 0, nRowCount, padfValues);
+        }
+    }
+    else
+    {
+        std::vector<char *> apszValues;
+        apszValues.reserve(nRowCount);
+        char *pszIter = reinterpret_cast<char *>(pabyRaw);
+        char *const pszEnd = pszIter + nRawSize;
+        while (pszIter < pszEnd &&
+               static_cast<int>(apszValues.size()) < nRowCount)
+        {
+            char *pszNul = static_cast<char *>(
+                memchr(pszIter, 0, static_cast<size_t>(pszEnd - pszIter)));
+            if (pszNul == nullptr)
+                break;
+            apszValues.push_back(pszIter);
+            pszIter = pszNul + 1;
+        }
+        if (static_cast<int>(apszValues.size()) != nRowCount ||
+            pszIter != pszEnd)
+        {
+            eErr = CE_Failure;
+        }
+        else
+        {
+            eErr = poRAT->ValuesIO(GF_Write, iCol, 0, nRowCount,
+                                   apszValues.data());
+        }
+    }
+    VSIFree(pabyRaw);
+
+    if (eErr != CE_None)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Inconsistent RAT column data for column %d", iCol);
+    }
+    return eErr;
+}
+
 /************************************************************************/
 /*                             Serialize()                              */
 /************************************************************************/
@@ -672,9 +852,36 @@ CPLXMLNode *GDALRasterAttributeTable::Serialize() const
     }
 
     /* -------------------------------------------------------------------- */
-    /*      Write out each row.                                             */
+    /*      Large tables are written column by column as compressed         */
+    /*      binary blobs, which are much faster to write and read back      */
+    /*      than one element per value.                                     */
     /* -------------------------------------------------------------------- */
     const int iRowCount = GetRowCount();
+    if (iColCount > 0 && GDALRATUseBinaryXMLEncoding(iRowCount))
+    {
+        std::vector<std::string> aosEncoded(iColCount);
+        bool bOK = true;
+        for (int iCol = 0; bOK && iCol < iColCount; iCol++)
+            bOK = GDALRATEncodeColumnData(this, iCol, iRowCount,
+                                          aosEncoded[iCol]);
+        if (bOK)
+        {
+            snprintf(szValue, sizeof(szValue), "%d", iRowCount);
+            CPLAddXMLAttributeAndValue(psTree, "rowCount", szValue);
+            for (int iCol = 0; iCol < iColCount; iCol++)
+            {
+                CPLXMLNode *psColData = CPLCreateXMLElementAndValue(
+                    psTree, "ColumnData", aosEncoded[iCol].c_str());
+                snprintf(szValue, sizeof(szValue), "%d", iCol);
+                CPLAddXMLAttributeAndValue(psColData, "index", szValue);
+            }
+            return psTree;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Write out each row.                                             */
+    /* -------------------------------------------------------------------- */
     CPLXMLNode *psTail = nullptr;
     CPLXMLNode *psRow = nullptr;
 
@@ -881,6 +1088,43 @@ CPLErr GDALRasterAttributeTable::XMLInit(const CPLXMLNode *psTree,
         }
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Column data, for tables written with the binary encoding.       */
+    /* -------------------------------------------------------------------- */
+    const char *pszRowCount = CPLGetXMLValue(psTree, "rowCount", nullptr);
+    if (pszRowCount)
+    {
+        const int nRows = atoi(pszRowCount);
+        if (nRows < 0)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "Invalid rowCount = %s",
+                     pszRowCount);
+            return CE_Failure;
+        }
+        SetRowCount(nRows);
+
+        const int nColCount = GetColumnCount();
+        for (const CPLXMLNode *psChild = psTree->psChild; psChild != nullptr;
+             psChild = psChild->psNext)
+        {
+            if (psChild->eType != CXT_Element ||
+                !EQUAL(psChild->pszValue, "ColumnData"))
+                continue;
+
+            const int iCol = atoi(CPLGetXMLValue(psChild, "index", "-1"));
+            if (iCol < 0 || iCol >= nColCount)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Invalid ColumnData index = %d", iCol);
+                return CE_Failure;
+            }
+            if (GDALRATDecodeColumnData(this, iCol, nRows,
+                                        CPLGetXMLValue(psChild, nullptr,
+                                                       "")) != CE_None)
+                return CE_Failure;
+        }
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Row data.                                                       */
     /* -------------------------------------------------------------------- */
@@ -1230,6 +1474,107 @@ void GDALDefaultRasterAttributeTable::AnalyseColumns()
         nMaxCol = GetColOfUsage(GFU_MinMax);
 }
 
+/************************************************************************/
+/*                        BuildRowOfValueIndex()                        */
+/*                                                                      */
+/*      Build a sorted index of the Min/Max ranges of the rows, used    */
+/*      by GetRowOfValue() to avoid a linear scan of large tables.      */
+/*      The index is only usable if the ranges of distinct rows do      */
+/*      not overlap (rows with identical ranges are collapsed onto      */
+/*      the first of them), in which case a binary search returns       */
+/*      the same row as the linear scan.                                */
+/************************************************************************/
+
+void GDALDefaultRasterAttributeTable::BuildRowOfValueIndex()
+
+{
+    bRowOfValueIndexBuilt = true;
+    bRowOfValueIndexUsable = false;
+    aoRowOfValueIndex.clear();
+
+    // Not worth the effort for small tables.
+    constexpr int MIN_ROW_COUNT_FOR_INDEX = 64;
+    if (nRowCount < MIN_ROW_COUNT_FOR_INDEX)
+        return;
+
+    // Mimic the comparisons done by the linear scan: a missing, string or
+    // NaN bound never excludes a value.
+    const auto GetBound = [this](int iCol, int iRow, double dfDefault)
+    {
+        if (iCol < 0)
+            return dfDefault;
+        const auto &oField = aoFields[iCol];
+        double dfVal = dfDefault;
+        if (oField.eType == GFT_Integer)
+            dfVal = oField.anValues[iRow];
+        else if (oField.eType == GFT_Real)
+            dfVal = oField.adfValues[iRow];
+        return std::isnan(dfVal) ? dfDefault : dfVal;
+    };
+
+    constexpr double dfInf = std::numeric_limits<double>::infinity();
+    try
+    {
+        aoRowOfValueIndex.reserve(nRowCount);
+        for (int iRow = 0; iRow < nRowCount; iRow++)
+        {
+            aoRowOfValueIndex.push_back({GetBound(nMinCol, iRow, -dfInf),
+                                         GetBound(nMaxCol, iRow, dfInf),
+                                         iRow});
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        aoRowOfValueIndex.clear();
+        return;
+    }
+
+    std::sort(aoRowOfValueIndex.begin(), aoRowOfValueIndex.end(),
+              [](const RowOfValueIndexEntry &a, const RowOfValueIndexEntry &b)
+              {
+                  if (a.dfMin != b.dfMin)
+                      return a.dfMin < b.dfMin;
+                  if (a.dfMax != b.dfMax)
+                      return a.dfMax < b.dfMax;
+                  return a.iRow < b.iRow;
+              });
+
+    // Collapse identical ranges and check that the remaining ones are
+    // disjoint.
+    size_t nOut = 0;
+    for (size_t i = 0; i < aoRowOfValueIndex.size(); ++i)
+    {
+        const auto &oEntry = aoRowOfValueIndex[i];
+        if (nOut > 0)
+        {
+            const auto &oPrev = aoRowOfValueIndex[nOut - 1];
+            if (oEntry.dfMin == oPrev.dfMin && oEntry.dfMax == oPrev.dfMax)
+                continue;
+            if (!(oPrev.dfMax < oEntry.dfMin))
+            {
+                aoRowOfValueIndex.clear();
+                return;
+            }
+        }
+        aoRowOfValueIndex[nOut++] = oEntry;
+    }
+    aoRowOfValueIndex.resize(nOut);
+    aoRowOfValueIndex.shrink_to_fit();
+    bRowOfValueIndexUsable = true;
+}
+
+/************************************************************************/
+/*                      InvalidateRowOfValueIndex()                     */
+/************************************************************************/
+
+void GDALDefaultRasterAttributeTable::InvalidateRowOfValueIndex()
+
+{
+    bRowOfValueIndexBuilt = false;
+    bRowOfValueIndexUsable = false;
+    aoRowOfValueIndex.clear();
+}
+
 /************************************************************************/
 /*                           GetColumnCount()                           */
 /************************************************************************/
@@ -1642,6 +1987,8 @@ void GDALDefaultRasterAttributeTable::SetRowCount(int nNewCount)
     if (nNewCount == nRowCount)
         return;
 
+    InvalidateRowOfValueIndex();
+
     for (auto &oField : aoFields)
     {
         switch (oField.eType)
@@ -1694,6 +2041,9 @@ void GDALDefaultRasterAttributeTable::SetValue(int iRow, int iField,
         return;
     }
 
+    if (bRowOfValueIndexBuilt && (iField == nMinCol || iField == nMaxCol))
+        InvalidateRowOfValueIndex();
+
     switch (aoFields[iField].eType)
     {
         case GFT_Integer:
@@ -1760,6 +2110,9 @@ void GDALDefaultRasterAttributeTable::SetValue(int iRow, int iField, int nValue)
         return;
     }
 
+    if (bRowOfValueIndexBuilt && (iField == nMinCol || iField == nMaxCol))
+        InvalidateRowOfValueIndex();
+
     switch (aoFields[iField].eType)
     {
         case GFT_Integer:
@@ -1826,6 +2179,9 @@ void GDALDefaultRasterAttributeTable::SetValue(int iRow, int iField,
         return;
     }
 
+    if (bRowOfValueIndexBuilt && (iField == nMinCol || iField == nMaxCol))
+        InvalidateRowOfValueIndex();
+
     switch (aoFields[iField].eType)
     {
         case GFT_Integer:
@@ -1925,6 +2281,25 @@ int GDALDefaultRasterAttributeTable::GetRowOfValue(double dfValue) const
     if (nMinCol == -1 && nMaxCol == -1)
         return -1;
 
+    /* -------------------------------------------------------------------- */
+    /*      Use the sorted index when the row ranges do not overlap.        */
+    /* -------------------------------------------------------------------- */
+    if (!bRowOfValueIndexBuilt)
+        const_cast<GDALDefaultRasterAttributeTable *>(this)
+            ->BuildRowOfValueIndex();
+
+    if (bRowOfValueIndexUsable && !std::isnan(dfValue))
+    {
+        const auto oIter = std::upper_bound(
+            aoRowOfValueIndex.begin(), aoRowOfValueIndex.end(), dfValue,
+            [](double dfVal, const RowOfValueIndexEntry &oEntry)
+            { return dfVal < oEntry.dfMin; });
+        if (oIter == aoRowOfValueIndex.begin())
+            return -1;
+        const auto &oEntry = *(oIter - 1);
+        return dfValue <= oEntry.dfMax ? oEntry.iRow : -1;
+    }
+
     const GDALRasterAttributeField *poMin = nullptr;
     if (nMinCol != -1)
         poMin = &(aoFields[nMinCol]);
@@ -2078,6 +2453,9 @@ GDALDefaultRasterAttributeTable::CreateColumn(const char *pszFieldName,
 
     aoFields.resize(iNewField + 1);
 
+    bColumnsAnalysed = false;
+    InvalidateRowOfValueIndex();
+
     aoFields[iNewField].sName = pszFieldName;
 
     // color columns should be int 0..255
@@ -2148,6 +2526,9 @@ void GDALDefaultRasterAttributeTable::RemoveStatistics()
         }
     }
     aoFields = std::move(aoNewFields);
+
+    bColumnsAnalysed = false;
+    InvalidateRowOfValueIndex();
 }
 
 /************************************************************************/
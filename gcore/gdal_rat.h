@@ -361,6 +361,19 @@ class CPL_DLL GDALDefaultRasterAttributeTable : public GDALRasterAttributeTable
 
     CPLString osWorkingResult{};
 
+    struct RowOfValueIndexEntry
+    {
+        double dfMin;
+        double dfMax;
+        int iRow;
+    };
+
+    void BuildRowOfValueIndex();
+    void InvalidateRowOfValueIndex();
+    bool bRowOfValueIndexBuilt = false;
+    bool bRowOfValueIndexUsable = false;
+    std::vector<RowOfValueIndexEntry> aoRowOfValueIndex{};
+
   public:
     GDALDefaultRasterAttributeTable();
     ~GDALDefaultRasterAttributeTable() override;
@@ -28,8 +28,13 @@
 
 #include "gdal_thread_pool.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <mutex>
 
+#include "cpl_conv.h"
+#include "cpl_multiproc.h"
+
 static std::mutex gMutexThreadPool;
 static CPLWorkerThreadPool *gpoCompressThreadPool = nullptr;
 
@@ -58,3 +63,24 @@ void GDALDestroyGlobalThreadPool()
     delete gpoCompressThreadPool;
     gpoCompressThreadPool = nullptr;
 }
+
+/************************************************************************/
+/*                         GDALGetNumThreads()                          */
+/************************************************************************/
+
+/** Return the number of threads for a NUM_THREADS option value (a number
+ * or ALL_CPUS), defaulting to the GDAL_NUM_THREADS configuration option
+ * when pszNumThreads is NULL, and to 1 if neither is set. The result is
+ * clamped to [1, 128].
+ */
+int GDALGetNumThreads(const char *pszNumThreads)
+{
+    if (pszNumThreads == nullptr)
+        pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszNumThreads == nullptr)
+        return 1;
+    const int nThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : atoi(pszNumThreads);
+    return std::max(1, std::min(nThreads, 128));
+}
@@ -35,4 +35,6 @@ CPLWorkerThreadPool CPL_DLL *GDALGetGlobalThreadPool(int nThreads);
 
 void GDALDestroyGlobalThreadPool();
 
+int CPL_DLL GDALGetNumThreads(const char *pszNumThreads);
+
 #endif  // GDAL_THREAD_POOL_H
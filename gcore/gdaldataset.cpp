@@ -32,16 +32,20 @@
 #include "gdal_priv.h"
 
 #include <climits>
+#include <cmath>
 #include <cstdarg>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <atomic>
+#include <limits>
 #include <map>
 #include <new>
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -49,8 +53,12 @@
 #include "cpl_multiproc.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
+#include "cpl_trace.h"
 #include "cpl_vsi.h"
 #include "cpl_vsi_error.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_attrind.h"
 #include "ogr_core.h"
@@ -123,6 +131,11 @@ class GDALDataset::Private
 
     bool m_bOverviewsEnabled = true;
 
+    // Block cache accounting. See SetBlockCacheQuota()
+    std::atomic<GIntBig> m_nBlockCacheUsed{0};
+    GIntBig m_nBlockCacheQuota = 0;
+    int m_nBlockCachePriority = 0;
+
     Private() = default;
 };
 
@@ -1078,6 +1091,56 @@ int CPL_STDCALL GDALGetRasterCount(GDALDatasetH hDS)
     return GDALDataset::FromHandle(hDS)->GetRasterCount();
 }
 
+/************************************************************************/
+/*                            IsThreadSafe()                            */
+/************************************************************************/
+
+/**
+ * \brief Return whether this dataset, and its related objects (typically
+ * raster bands), can be called concurrently from several threads.
+ *
+ * This is the case of datasets opened with the GDAL_OF_THREAD_SAFE flag.
+ *
+ * Same as the C function GDALDatasetIsThreadSafe().
+ *
+ * @param nScopeFlags Combination of GDAL_OF_RASTER, GDAL_OF_VECTOR, etc.
+ *                    Only GDAL_OF_RASTER is currently supported.
+ * @return true if the dataset is thread-safe for the specified scope.
+ * @since GDAL 3.9
+ */
+
+bool GDALDataset::IsThreadSafe(int /* nScopeFlags */) const
+{
+    return false;
+}
+
+/************************************************************************/
+/*                       GDALDatasetIsThreadSafe()                      */
+/************************************************************************/
+
+/**
+ * \brief Return whether this dataset, and its related objects (typically
+ * raster bands), can be called concurrently from several threads.
+ *
+ * @see GDALDataset::IsThreadSafe().
+ *
+ * @param hDS Dataset handle.
+ * @param nScopeFlags Combination of GDAL_OF_RASTER, GDAL_OF_VECTOR, etc.
+ *                    Only GDAL_OF_RASTER is currently supported.
+ * @param papszOptions Unused. Should be set to NULL.
+ * @return true if the dataset is thread-safe for the specified scope.
+ * @since GDAL 3.9
+ */
+
+bool GDALDatasetIsThreadSafe(GDALDatasetH hDS, int nScopeFlags,
+                             CSLConstList papszOptions)
+{
+    VALIDATE_POINTER1(hDS, "GDALDatasetIsThreadSafe", false);
+    CPL_IGNORE_RET_VAL(papszOptions);
+
+    return GDALDataset::FromHandle(hDS)->IsThreadSafe(nScopeFlags);
+}
+
 /************************************************************************/
 /*                          GetProjectionRef()                          */
 /************************************************************************/
@@ -3061,6 +3124,213 @@ CPLErr CPL_STDCALL GDALDatasetAdviseRead(GDALDatasetH hDS, int nXOff, int nYOff,
         panBandMap, const_cast<char **>(papszOptions));
 }
 
+/************************************************************************/
+/*                   GDALGetAdviseReadPlanMaxBytes()                    */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+// Returns the maximum number of bytes that an AdviseReadPlan()
+// implementation should have pending at a given time.
+GIntBig GDALGetAdviseReadPlanMaxBytes(CSLConstList papszOptions)
+{
+    const char *pszMaxBytes = CSLFetchNameValue(papszOptions, "MAX_BYTES");
+    if (pszMaxBytes == nullptr)
+        pszMaxBytes =
+            CPLGetConfigOption("GDAL_ADVISE_READ_PLAN_MAX_BYTES", nullptr);
+    if (pszMaxBytes)
+        return std::max<GIntBig>(1, CPLAtoGIntBig(pszMaxBytes));
+    return 64 * 1024 * 1024;
+}
+
+//! @endcond
+
+/************************************************************************/
+/*                           AdviseReadPlan()                           */
+/************************************************************************/
+
+/**
+ * \brief Advise driver of the complete list of upcoming read requests.
+ *
+ * Whereas AdviseRead() notifies the driver of a single region, this method
+ * allows an application that knows in advance the sequence of windows it
+ * is going to read (for example the source windows of the chunks of a warping
+ * operation) to submit it at once. Drivers may then translate it into a
+ * schedule of coalesced prefetch operations, run in the order of the windows
+ * and limited to a memory budget, advancing as the windows are read.
+ *
+ * Windows should be submitted in the order they will be read, which is also
+ * their priority order. A new call replaces the previous plan, and a call
+ * with nWindowCount == 0 cancels it.
+ *
+ * The default implementation calls AdviseRead() on the bounding box of the
+ * windows if they cover most of it and it fits in the memory budget, and
+ * otherwise merges consecutive adjacent windows and calls AdviseRead() on as
+ * many of the first ones as fit in the memory budget.
+ *
+ * This method is the same as the C function GDALDatasetAdviseReadPlan().
+ *
+ * @param nWindowCount number of windows.
+ *
+ * @param pasWindows array of nWindowCount windows, at full resolution.
+ *
+ * @param nBandCount the number of bands that will be read, or 0 for all bands.
+ *
+ * @param panBandList the list of nBandCount band numbers. This may be nullptr
+ * to select the first nBandCount bands.
+ *
+ * @param papszOptions a list of name=value strings with special control
+ * options. The MAX_BYTES option can be set to the maximum number of bytes
+ * that may be prefetched ahead of the reads (defaults to the value of the
+ * GDAL_ADVISE_READ_PLAN_MAX_BYTES configuration option, or 64 MB).
+ *
+ * @return CE_Failure if the request is invalid and CE_None if it works or
+ * is ignored.
+ *
+ * @since GDAL 3.9
+ */
+
+CPLErr GDALDataset::AdviseReadPlan(int nWindowCount,
+                                   const GDALRasterWindow *pasWindows,
+                                   int nBandCount, const int *panBandList,
+                                   CSLConstList papszOptions)
+{
+    if (nBandCount == 0)
+    {
+        nBandCount = nBands;
+        panBandList = nullptr;
+    }
+    std::vector<int> anBandList;
+    int nPixelSize = 0;
+    for (int i = 0; i < nBandCount; ++i)
+    {
+        const int nBand = panBandList ? panBandList[i] : i + 1;
+        if (nBand <= 0 || nBand > nBands)
+        {
+            ReportError(CE_Failure, CPLE_IllegalArg,
+                        "AdviseReadPlan(): Invalid band number: %d", nBand);
+            return CE_Failure;
+        }
+        anBandList.push_back(nBand);
+        nPixelSize += GDALGetDataTypeSizeBytes(
+            GetRasterBand(nBand)->GetRasterDataType());
+    }
+    if (anBandList.empty())
+        return CE_None;
+
+    const GIntBig nMaxBytes = GDALGetAdviseReadPlanMaxBytes(papszOptions);
+    const GDALDataType eDT = GetRasterBand(anBandList[0])->GetRasterDataType();
+
+    // If the windows cover most of their bounding box, and it fits in the
+    // budget, advise it as a whole.
+    int nMinX = nRasterXSize;
+    int nMinY = nRasterYSize;
+    int nMaxX = 0;
+    int nMaxY = 0;
+    double dfWindowsArea = 0;
+    for (int i = 0; i < nWindowCount; ++i)
+    {
+        const GDALRasterWindow &sWindow = pasWindows[i];
+        if (sWindow.nXOff < 0 || sWindow.nYOff < 0 || sWindow.nXSize <= 0 ||
+            sWindow.nYSize <= 0 ||
+            sWindow.nXSize > nRasterXSize - sWindow.nXOff ||
+            sWindow.nYSize > nRasterYSize - sWindow.nYOff)
+        {
+            continue;
+        }
+        nMinX = std::min(nMinX, sWindow.nXOff);
+        nMinY = std::min(nMinY, sWindow.nYOff);
+        nMaxX = std::max(nMaxX, sWindow.nXOff + sWindow.nXSize);
+        nMaxY = std::max(nMaxY, sWindow.nYOff + sWindow.nYSize);
+        dfWindowsArea += static_cast<double>(sWindow.nXSize) * sWindow.nYSize;
+    }
+    if (nMinX >= nMaxX || nMinY >= nMaxY)
+        return CE_None;
+    const double dfBoundingBoxArea =
+        static_cast<double>(nMaxX - nMinX) * (nMaxY - nMinY);
+    if (dfWindowsArea >= dfBoundingBoxArea * 0.80 &&
+        dfBoundingBoxArea * nPixelSize <= static_cast<double>(nMaxBytes))
+    {
+        return AdviseRead(nMinX, nMinY, nMaxX - nMinX, nMaxY - nMinY,
+                          nMaxX - nMinX, nMaxY - nMinY, eDT,
+                          static_cast<int>(anBandList.size()),
+                          anBandList.data(), nullptr);
+    }
+
+    GIntBig nAdvisedBytes = 0;
+    for (int i = 0; i < nWindowCount;)
+    {
+        // Merge following windows that extend this one horizontally or
+        // vertically.
+        GDALRasterWindow sWindow = pasWindows[i];
+        int iNext = i + 1;
+        for (; iNext < nWindowCount; ++iNext)
+        {
+            const GDALRasterWindow &sNext = pasWindows[iNext];
+            if (sNext.nYOff == sWindow.nYOff &&
+                sNext.nYSize == sWindow.nYSize &&
+                sNext.nXOff == sWindow.nXOff + sWindow.nXSize)
+            {
+                sWindow.nXSize += sNext.nXSize;
+            }
+            else if (sNext.nXOff == sWindow.nXOff &&
+                     sNext.nXSize == sWindow.nXSize &&
+                     sNext.nYOff == sWindow.nYOff + sWindow.nYSize)
+            {
+                sWindow.nYSize += sNext.nYSize;
+            }
+            else
+            {
+                break;
+            }
+        }
+        i = iNext;
+
+        if (sWindow.nXOff < 0 || sWindow.nYOff < 0 || sWindow.nXSize <= 0 ||
+            sWindow.nYSize <= 0 ||
+            sWindow.nXSize > nRasterXSize - sWindow.nXOff ||
+            sWindow.nYSize > nRasterYSize - sWindow.nYOff)
+        {
+            continue;
+        }
+
+        const GIntBig nWindowBytes = static_cast<GIntBig>(sWindow.nXSize) *
+                                     sWindow.nYSize * nPixelSize;
+        if (nAdvisedBytes > 0 && nWindowBytes > nMaxBytes - nAdvisedBytes)
+            break;
+        nAdvisedBytes += nWindowBytes;
+
+        const CPLErr eErr = AdviseRead(
+            sWindow.nXOff, sWindow.nYOff, sWindow.nXSize, sWindow.nYSize,
+            sWindow.nXSize, sWindow.nYSize, eDT,
+            static_cast<int>(anBandList.size()), anBandList.data(), nullptr);
+        if (eErr != CE_None)
+            return eErr;
+    }
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                     GDALDatasetAdviseReadPlan()                      */
+/************************************************************************/
+
+/**
+ * \brief Advise driver of the complete list of upcoming read requests.
+ *
+ * @see GDALDataset::AdviseReadPlan()
+ * @since GDAL 3.9
+ */
+
+CPLErr GDALDatasetAdviseReadPlan(GDALDatasetH hDS, int nWindowCount,
+                                 const GDALRasterWindow *pasWindows,
+                                 int nBandCount, const int *panBandList,
+                                 CSLConstList papszOptions)
+{
+    VALIDATE_POINTER1(hDS, __func__, CE_Failure);
+    return GDALDataset::FromHandle(hDS)->AdviseReadPlan(
+        nWindowCount, pasWindows, nBandCount, panBandList, papszOptions);
+}
+
 /************************************************************************/
 /*                         GDALAntiRecursionStruct                      */
 /************************************************************************/
@@ -3510,7 +3780,10 @@ static GDALDataset *GetSharedDS(const char *pszFilename,
  * GDALOpenEx() it will be referenced and returned, if GDALOpenEx() is called
  * from the same thread.</li> <li>Verbose error: GDAL_OF_VERBOSE_ERROR. If set,
  * a failed attempt to open the file will lead to an error message to be
- * reported.</li>
+ * reported.</li> <li>Header only: GDAL_OF_HEADER_ONLY (since GDAL 3.9). If
+ * set, side-car files (.aux.xml, .ovr, .msk, world files, ...) are not
+ * looked for and the directory of the file is not listed. Not compatible
+ * with GDAL_OF_UPDATE.</li>
  * </ul>
  *
  * @param papszAllowedDrivers NULL to consider all candidate drivers, or a NULL
@@ -3553,6 +3826,49 @@ GDALDatasetH CPL_STDCALL GDALOpenEx(const char *pszFilename,
     if ((nOpenFlags & GDAL_OF_KIND_MASK) == 0)
         nOpenFlags |= GDAL_OF_KIND_MASK & ~GDAL_OF_MULTIDIM_RASTER;
 
+    if ((nOpenFlags & GDAL_OF_HEADER_ONLY) && (nOpenFlags & GDAL_OF_UPDATE))
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "GDAL_OF_HEADER_ONLY is not compatible with GDAL_OF_UPDATE");
+        return nullptr;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      A thread-safe dataset wraps a regular dataset, that is          */
+    /*      re-opened for each thread that uses it.                         */
+    /* -------------------------------------------------------------------- */
+    if (nOpenFlags & GDAL_OF_THREAD_SAFE)
+    {
+        if ((nOpenFlags & GDAL_OF_KIND_MASK) != GDAL_OF_RASTER)
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg,
+                     "GDAL_OF_THREAD_SAFE is only compatible with "
+                     "GDAL_OF_RASTER");
+            return nullptr;
+        }
+        if (nOpenFlags & (GDAL_OF_UPDATE | GDAL_OF_SHARED))
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg,
+                     "GDAL_OF_THREAD_SAFE is not compatible with "
+                     "GDAL_OF_UPDATE or GDAL_OF_SHARED");
+            return nullptr;
+        }
+
+        const unsigned int nPrototypeOpenFlags =
+            (nOpenFlags & ~GDAL_OF_THREAD_SAFE) | GDAL_OF_INTERNAL;
+        GDALDatasetUniquePtr poPrototypeDS(GDALDataset::FromHandle(GDALOpenEx(
+            pszFilename, nPrototypeOpenFlags, papszAllowedDrivers,
+            papszOpenOptions, papszSiblingFiles)));
+        if (!poPrototypeDS)
+            return nullptr;
+        GDALDataset *poDS = GDALCreateThreadSafeDataset(
+            std::move(poPrototypeDS), pszFilename, nOpenFlags,
+            papszOpenOptions);
+        if (poDS && !(nOpenFlags & GDAL_OF_INTERNAL))
+            poDS->AddToDatasetOpenList();
+        return poDS;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      In case of shared dataset, first scan the existing list to see  */
     /*      if it could already contain the requested dataset.              */
@@ -3582,6 +3898,9 @@ GDALDatasetH CPL_STDCALL GDALOpenEx(const char *pszFilename,
     VSIErrorReset();
     CPLAssert(nullptr != poDM);
 
+    CPLTraceSpan oTraceSpan("gdal", "Open");
+    oTraceSpan.AddAttribute("filename", pszFilename);
+
     // Build GDALOpenInfo just now to avoid useless file stat'ing if a
     // shared dataset was asked before.
     GDALOpenInfo oOpenInfo(pszFilename, nOpenFlags,
@@ -3636,6 +3955,28 @@ GDALDatasetH CPL_STDCALL GDALOpenEx(const char *pszFilename,
     GDALDriver *poMissingPluginDriver = nullptr;
     std::vector<GDALDriver *> apoSecondPassDrivers;
 
+    // Drivers whose GDAL_DMD_SIGNATURES matches the first bytes of the file
+    // are probed first, followed by the other drivers in their usual order.
+    std::vector<GDALDriver *> apoFirstPassDrivers =
+        poDM->GetDriversMatchingSignature(oOpenInfo.pabyHeader,
+                                          oOpenInfo.nHeaderBytes);
+    if (!apoFirstPassDrivers.empty())
+    {
+        const size_t nMatchingDrivers = apoFirstPassDrivers.size();
+        for (int iDriver = 0; iDriver < nDriverCount; ++iDriver)
+        {
+            GDALDriver *poDriver =
+                poDM->GetDriver(iDriver, /*bIncludeHidden=*/true);
+            if (std::find(apoFirstPassDrivers.begin(),
+                          apoFirstPassDrivers.begin() + nMatchingDrivers,
+                          poDriver) ==
+                apoFirstPassDrivers.begin() + nMatchingDrivers)
+            {
+                apoFirstPassDrivers.push_back(poDriver);
+            }
+        }
+    }
+
     // Lookup of matching driver for dataset can involve up to 2 passes:
     // - in the first pass, all drivers that are compabile of the request mode
     //   (raster/vector/etc.) are probed using their Identify() method if it
@@ -3655,13 +3996,18 @@ GDALDatasetH CPL_STDCALL GDALOpenEx(const char *pszFilename,
     int iPass = 1;
 retry:
     for (int iDriver = 0;
-         iDriver < (iPass == 1 ? nDriverCount
+         iDriver < (iPass == 1 ? (apoFirstPassDrivers.empty()
+                                      ? nDriverCount
+                                      : static_cast<int>(
+                                            apoFirstPassDrivers.size()))
                                : static_cast<int>(apoSecondPassDrivers.size()));
          ++iDriver)
     {
         GDALDriver *poDriver =
-            iPass == 1 ? poDM->GetDriver(iDriver, /*bIncludeHidden=*/true)
-                       : apoSecondPassDrivers[iDriver];
+            iPass == 2 ? apoSecondPassDrivers[iDriver]
+            : apoFirstPassDrivers.empty()
+                ? poDM->GetDriver(iDriver, /*bIncludeHidden=*/true)
+                : apoFirstPassDrivers[iDriver];
         if (papszAllowedDrivers != nullptr &&
             CSLFindString(papszAllowedDrivers,
                           GDALGetDriverShortName(poDriver)) == -1)
@@ -3875,6 +4221,8 @@ retry:
 
             CSLDestroy(papszOpenOptionsCleaned);
 
+            oTraceSpan.AddAttribute("driver", poDriver->GetDescription());
+
 #ifdef OGRAPISPY_ENABLED
             if (iSnapshot != INT_MIN)
             {
@@ -9504,6 +9852,134 @@ bool GDALDataset::AreOverviewsEnabled() const
     return m_poPrivate ? m_poPrivate->m_bOverviewsEnabled : true;
 }
 
+/************************************************************************/
+/*                         AddBlockCacheUsed()                          */
+/************************************************************************/
+
+// Only to be called by GDALRasterBlock
+void GDALDataset::AddBlockCacheUsed(GIntBig nDelta)
+{
+    if (m_poPrivate)
+        m_poPrivate->m_nBlockCacheUsed += nDelta;
+}
+
+//! @endcond
+
+/************************************************************************/
+/*                         GetBlockCacheUsed()                          */
+/************************************************************************/
+
+/**
+ * \brief Return the amount of memory used by blocks of this dataset in
+ * the global raster block cache.
+ *
+ * This method is the same as the C function GDALDatasetGetBlockCacheUsed().
+ *
+ * @return a number of bytes.
+ * @since GDAL 3.9
+ */
+
+GIntBig GDALDataset::GetBlockCacheUsed() const
+{
+    return m_poPrivate ? m_poPrivate->m_nBlockCacheUsed.load() : 0;
+}
+
+/************************************************************************/
+/*                         SetBlockCacheQuota()                         */
+/************************************************************************/
+
+/**
+ * \brief Set the maximum amount of memory that blocks of this dataset may
+ * use in the global raster block cache.
+ *
+ * When a new block of this dataset is loaded in the cache and the quota is
+ * exceeded, older blocks of this same dataset are evicted, instead of blocks
+ * of other datasets. This is useful to prevent bulk processing of a large
+ * dataset from evicting all the cached blocks of other datasets.
+ *
+ * The quota is a soft limit: blocks that are locked, or that are
+ * dirty whereas dirty block flushing is disabled, are not evicted. The quota
+ * cannot exceed the global limit set by GDALSetCacheMax64().
+ *
+ * This method is the same as the C function GDALDatasetSetBlockCacheQuota().
+ *
+ * @param nQuotaBytes maximum number of bytes, or 0 for no quota (default).
+ * @since GDAL 3.9
+ */
+
+void GDALDataset::SetBlockCacheQuota(GIntBig nQuotaBytes)
+{
+    if (m_poPrivate)
+        m_poPrivate->m_nBlockCacheQuota = std::max<GIntBig>(0, nQuotaBytes);
+}
+
+/************************************************************************/
+/*                         GetBlockCacheQuota()                         */
+/************************************************************************/
+
+/**
+ * \brief Return the quota set with SetBlockCacheQuota().
+ *
+ * This method is the same as the C function GDALDatasetGetBlockCacheQuota().
+ *
+ * @return a number of bytes, or 0 if there is no quota.
+ * @since GDAL 3.9
+ */
+
+GIntBig GDALDataset::GetBlockCacheQuota() const
+{
+    return m_poPrivate ? m_poPrivate->m_nBlockCacheQuota : 0;
+}
+
+/************************************************************************/
+/*                       SetBlockCachePriority()                        */
+/************************************************************************/
+
+/**
+ * \brief Set the eviction priority of blocks of this dataset in the global
+ * raster block cache.
+ *
+ * When the cache is full, loading a block of a dataset of priority P
+ * evicts, by order of preference, blocks of datasets whose priority is
+ * lower or equal to P. Blocks of datasets of higher priority are only
+ * evicted when no other block can be evicted. The default priority is 0.
+ * Interactive, latency-sensitive, datasets might for example be given a
+ * positive priority, and bulk processing a negative one.
+ *
+ * This method is the same as the C function
+ * GDALDatasetSetBlockCachePriority().
+ *
+ * @param nPriority priority.
+ * @since GDAL 3.9
+ */
+
+void GDALDataset::SetBlockCachePriority(int nPriority)
+{
+    if (m_poPrivate)
+        m_poPrivate->m_nBlockCachePriority = nPriority;
+}
+
+/************************************************************************/
+/*                       GetBlockCachePriority()                        */
+/************************************************************************/
+
+/**
+ * \brief Return the priority set with SetBlockCachePriority().
+ *
+ * This method is the same as the C function
+ * GDALDatasetGetBlockCachePriority().
+ *
+ * @return priority (0 by default).
+ * @since GDAL 3.9
+ */
+
+int GDALDataset::GetBlockCachePriority() const
+{
+    return m_poPrivate ? m_poPrivate->m_nBlockCachePriority : 0;
+}
+
+//! @cond Doxygen_Suppress
+
 /************************************************************************/
 /*                             IsAllBands()                             */
 /************************************************************************/
@@ -9931,3 +10407,488 @@ CPLErr GDALDatasetReadCompressedData(GDALDatasetH hDS, const char *pszFormat,
         pszFormat, nXOff, nYOff, nXSize, nYSize, nBandCount, panBandList,
         ppBuffer, pnBufferSize, ppszDetailedFormat);
 }
+
+/************************************************************************/
+/*                    GDALDatasetGetBlockCacheUsed()                    */
+/************************************************************************/
+
+/**
+ * \brief Return the amount of memory used by blocks of this dataset in
+ * the global raster block cache.
+ *
+ * This function is the same as the C++ method
+ * GDALDataset::GetBlockCacheUsed().
+ *
+ * @param hDS Dataset handle.
+ * @return a number of bytes.
+ * @since GDAL 3.9
+ */
+
+GIntBig GDALDatasetGetBlockCacheUsed(GDALDatasetH hDS)
+{
+    VALIDATE_POINTER1(hDS, __func__, 0);
+    return GDALDataset::FromHandle(hDS)->GetBlockCacheUsed();
+}
+
+/************************************************************************/
+/*                   GDALDatasetSetBlockCacheQuota()                    */
+/************************************************************************/
+
+/**
+ * \brief Set the maximum amount of memory that blocks of this dataset may
+ * use in the global raster block cache.
+ *
+ * This function is the same as the C++ method
+ * GDALDataset::SetBlockCacheQuota().
+ *
+ * @param hDS Dataset handle.
+ * @param nQuotaBytes maximum number of bytes, or 0 for no quota (default).
+ * @since GDAL 3.9
+ */
+
+void GDALDatasetSetBlockCacheQuota(GDALDatasetH hDS, GIntBig nQuotaBytes)
+{
+    VALIDATE_POINTER0(hDS, __func__);
+    GDALDataset::FromHandle(hDS)->SetBlockCacheQuota(nQuotaBytes);
+}
+
+/************************************************************************/
+/*                   GDALDatasetGetBlockCacheQuota()                    */
+/************************************************************************/
+
+/**
+ * \brief Return the quota set with GDALDatasetSetBlockCacheQuota().
+ *
+ * This function is the same as the C++ method
+ * GDALDataset::GetBlockCacheQuota().
+ *
+ * @param hDS Dataset handle.
+ * @return a number of bytes, or 0 if there is no quota.
+ * @since GDAL 3.9
+ */
+
+GIntBig GDALDatasetGetBlockCacheQuota(GDALDatasetH hDS)
+{
+    VALIDATE_POINTER1(hDS, __func__, 0);
+    return GDALDataset::FromHandle(hDS)->GetBlockCacheQuota();
+}
+
+/************************************************************************/
+/*                  GDALDatasetSetBlockCachePriority()                  */
+/************************************************************************/
+
+/**
+ * \brief Set the eviction priority of blocks of this dataset in the global
+ * raster block cache.
+ *
+ * This function is the same as the C++ method
+ * GDALDataset::SetBlockCachePriority().
+ *
+ * @param hDS Dataset handle.
+ * @param nPriority priority (0 by default).
+ * @since GDAL 3.9
+ */
+
+void GDALDatasetSetBlockCachePriority(GDALDatasetH hDS, int nPriority)
+{
+    VALIDATE_POINTER0(hDS, __func__);
+    GDALDataset::FromHandle(hDS)->SetBlockCachePriority(nPriority);
+}
+
+/************************************************************************/
+/*                  GDALDatasetGetBlockCachePriority()                  */
+/************************************************************************/
+
+/**
+ * \brief Return the priority set with GDALDatasetSetBlockCachePriority().
+ *
+ * This function is the same as the C++ method
+ * GDALDataset::GetBlockCachePriority().
+ *
+ * @param hDS Dataset handle.
+ * @return priority.
+ * @since GDAL 3.9
+ */
+
+int GDALDatasetGetBlockCachePriority(GDALDatasetH hDS)
+{
+    VALIDATE_POINTER1(hDS, __func__, 0);
+    return GDALDataset::FromHandle(hDS)->GetBlockCachePriority();
+}
+
+/************************************************************************/
+/*                         ComputeStatistics()                          */
+/************************************************************************/
+
+namespace
+{
+// Statistics being accumulated for one band by
+// GDALDataset::ComputeStatistics(), and data of the current chunk.
+struct GDALDatasetStatsBand
+{
+    GDALRasterBand *poBand = nullptr;
+    GDALRasterBand *poMaskBand = nullptr;
+    bool bGotNoDataValue = false;
+    double dfNoDataValue = 0;
+
+    double dfMin = std::numeric_limits<double>::max();
+    double dfMax = -std::numeric_limits<double>::max();
+    double dfMean = 0;
+    double dfM2 = 0;
+    GUIntBig nValidCount = 0;
+
+    const double *padfData = nullptr;
+    const GByte *pabyMask = nullptr;
+    size_t nCount = 0;
+};
+}  // namespace
+
+// Accumulates the current chunk of a band. The mean and the sum of square
+// differences to the mean of the chunk are computed in two passes, and then
+// merged with the values of the previous chunks with Chan's formula.
+static void GDALDatasetStatsAccumulate(void *pData)
+{
+    auto psBand = static_cast<GDALDatasetStatsBand *>(pData);
+    const double *padfData = psBand->padfData;
+    const GByte *pabyMask = psBand->pabyMask;
+    const bool bGotNoDataValue = psBand->bGotNoDataValue;
+    const double dfNoDataValue = psBand->dfNoDataValue;
+    const auto IsValid = [=](size_t i)
+    {
+        return (pabyMask == nullptr || pabyMask[i] != 0) &&
+               !CPLIsNan(padfData[i]) &&
+               !(bGotNoDataValue && ARE_REAL_EQUAL(padfData[i], dfNoDataValue));
+    };
+
+    double dfMin = psBand->dfMin;
+    double dfMax = psBand->dfMax;
+    double dfSum = 0;
+    GUIntBig nValidCount = 0;
+    for (size_t i = 0; i < psBand->nCount; ++i)
+    {
+        if (IsValid(i))
+        {
+            const double dfValue = padfData[i];
+            dfMin = std::min(dfMin, dfValue);
+            dfMax = std::max(dfMax, dfValue);
+            dfSum += dfValue;
+            ++nValidCount;
+        }
+    }
+    if (nValidCount == 0)
+        return;
+
+    const double dfMean = dfSum / static_cast<double>(nValidCount);
+    double dfM2 = 0;
+    for (size_t i = 0; i < psBand->nCount; ++i)
+    {
+        if (IsValid(i))
+        {
+            const double dfDelta = padfData[i] - dfMean;
+            dfM2 += dfDelta * dfDelta;
+        }
+    }
+
+    const double dfTotalCount =
+        static_cast<double>(psBand->nValidCount + nValidCount);
+    const double dfDelta = dfMean - psBand->dfMean;
+    psBand->dfMean += dfDelta * static_cast<double>(nValidCount) / dfTotalCount;
+    psBand->dfM2 += dfM2 + dfDelta * dfDelta *
+                               static_cast<double>(psBand->nValidCount) *
+                               static_cast<double>(nValidCount) / dfTotalCount;
+    psBand->nValidCount += nValidCount;
+    psBand->dfMin = dfMin;
+    psBand->dfMax = dfMax;
+}
+
+/**
+ * \brief Compute statistics of several bands in a single pass.
+ *
+ * This is equivalent to calling GDALRasterBand::ComputeStatistics() on each
+ * of the requested bands, but each region of the dataset is read only once
+ * for all bands, which avoids, for pixel-interleaved compressed datasets,
+ * decoding each block as many times as there are bands. The statistics of
+ * the different bands are accumulated in parallel when the GDAL_NUM_THREADS
+ * configuration option is set to a value greater than 1.
+ *
+ * Computed statistics are stored with GDALRasterBand::SetStatistics(), and
+ * can be retrieved with GDALRasterBand::GetStatistics().
+ *
+ * When bApproxOK is set, or for data types that cannot be losslessly
+ * converted to double (complex, 64-bit integer and signed byte types), this
+ * falls back to computing the statistics of each band separately.
+ *
+ * This method is the same as the C function GDALDatasetComputeStatistics().
+ *
+ * @param nBandCount the number of bands.
+ * @param panBandList the list of nBandCount band numbers, or nullptr to
+ * select the first nBandCount bands.
+ * @param bApproxOK whether approximate statistics are acceptable.
+ * @param pfnProgress a function to call to report progress, or nullptr.
+ * @param pProgressData application data to pass to the progress function.
+ *
+ * @return CE_None on success, CE_Failure if an error occurs or if a band has
+ * no valid pixels.
+ *
+ * @since GDAL 3.9
+ */
+
+CPLErr GDALDataset::ComputeStatistics(int nBandCount, const int *panBandList,
+                                      bool bApproxOK,
+                                      GDALProgressFunc pfnProgress,
+                                      void *pProgressData)
+{
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+
+    std::vector<int> anBandList;
+    for (int i = 0; i < nBandCount; ++i)
+    {
+        const int nBand = panBandList ? panBandList[i] : i + 1;
+        if (nBand <= 0 || nBand > GetRasterCount())
+        {
+            ReportError(CE_Failure, CPLE_IllegalArg, "Invalid band number: %d",
+                        nBand);
+            return CE_Failure;
+        }
+        anBandList.push_back(nBand);
+    }
+    if (anBandList.empty())
+        return CE_None;
+
+    bool bSinglePass = !bApproxOK && anBandList.size() > 1;
+    for (const int nBand : anBandList)
+    {
+        auto poBand = GetRasterBand(nBand);
+        const auto eDT = poBand->GetRasterDataType();
+        if (GDALDataTypeIsComplex(eDT) || eDT == GDT_Int64 ||
+            eDT == GDT_UInt64)
+        {
+            bSinglePass = false;
+        }
+        else if (eDT == GDT_Byte)
+        {
+            poBand->EnablePixelTypeSignedByteWarning(false);
+            const char *pszPixelType =
+                poBand->GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
+            poBand->EnablePixelTypeSignedByteWarning(true);
+            if (pszPixelType && EQUAL(pszPixelType, "SIGNEDBYTE"))
+                bSinglePass = false;
+        }
+    }
+
+    if (!bSinglePass)
+    {
+        for (size_t i = 0; i < anBandList.size(); ++i)
+        {
+            void *pScaledProgress = GDALCreateScaledProgress(
+                static_cast<double>(i) / anBandList.size(),
+                static_cast<double>(i + 1) / anBandList.size(), pfnProgress,
+                pProgressData);
+            const CPLErr eErr = GetRasterBand(anBandList[i])->ComputeStatistics(
+                bApproxOK, nullptr, nullptr, nullptr, nullptr,
+                pScaledProgress ? GDALScaledProgress : nullptr,
+                pScaledProgress);
+            GDALDestroyScaledProgress(pScaledProgress);
+            if (eErr != CE_None)
+                return eErr;
+        }
+        return CE_None;
+    }
+
+    if (!pfnProgress(0.0, "Compute Statistics", pProgressData))
+    {
+        ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Collect nodata and mask settings, following                     */
+    /*      GDALRasterBand::ComputeStatistics().                            */
+    /* -------------------------------------------------------------------- */
+    std::vector<GDALDatasetStatsBand> asBands(nBandCount);
+    bool bHasMask = false;
+    for (int i = 0; i < nBandCount; ++i)
+    {
+        auto &sBand = asBands[i];
+        sBand.poBand = GetRasterBand(anBandList[i]);
+        int bGotNoDataValue = FALSE;
+        double dfNoDataValue = sBand.poBand->GetNoDataValue(&bGotNoDataValue);
+        if (bGotNoDataValue && !CPLIsNan(dfNoDataValue))
+        {
+            if (sBand.poBand->GetRasterDataType() == GDT_Float32)
+            {
+                dfNoDataValue = GDALAdjustNoDataCloseToFloatMax(dfNoDataValue);
+                if (GDALIsValueInRange<float>(dfNoDataValue))
+                    dfNoDataValue = static_cast<float>(dfNoDataValue);
+            }
+            sBand.bGotNoDataValue = true;
+            sBand.dfNoDataValue = dfNoDataValue;
+        }
+        else if (!bGotNoDataValue)
+        {
+            const int nMaskFlags = sBand.poBand->GetMaskFlags();
+            if (nMaskFlags != GMF_ALL_VALID && nMaskFlags != GMF_NODATA &&
+                sBand.poBand->GetColorInterpretation() != GCI_AlphaBand)
+            {
+                sBand.poMaskBand = sBand.poBand->GetMaskBand();
+                bHasMask = true;
+            }
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Process the dataset by chunks of full lines, aligned on the     */
+    /*      blocks of the first band, within a memory budget.               */
+    /* -------------------------------------------------------------------- */
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    asBands[0].poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    nBlockYSize = std::max(1, nBlockYSize);
+    constexpr size_t CHUNK_MAX_SIZE = 64 * 1024 * 1024;
+    const size_t nLineSize =
+        static_cast<size_t>(nRasterXSize) * nBandCount * sizeof(double);
+    const int nBlocksPerChunk = static_cast<int>(std::max<size_t>(
+        1, CHUNK_MAX_SIZE / std::max<size_t>(1, nLineSize * nBlockYSize)));
+    const int nChunkYSize = static_cast<int>(std::min<GIntBig>(
+        nRasterYSize, static_cast<GIntBig>(nBlocksPerChunk) * nBlockYSize));
+    const size_t nBandSize = static_cast<size_t>(nRasterXSize) * nChunkYSize;
+
+    std::vector<double> adfData;
+    std::vector<GByte> abyMask;
+    try
+    {
+        adfData.resize(nBandSize * nBandCount);
+        if (bHasMask)
+            abyMask.resize(nBandSize * nBandCount);
+    }
+    catch (const std::exception &)
+    {
+        ReportError(CE_Failure, CPLE_OutOfMemory,
+                    "Cannot allocate buffer for statistics computation");
+        return CE_Failure;
+    }
+
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                                       ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+    auto poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(std::min(nThreads, nBandCount))
+                     : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
+
+    for (int iYOff = 0; iYOff < nRasterYSize; iYOff += nChunkYSize)
+    {
+        const int nYSize = std::min(nChunkYSize, nRasterYSize - iYOff);
+        const size_t nCount = static_cast<size_t>(nRasterXSize) * nYSize;
+
+        if (RasterIO(GF_Read, 0, iYOff, nRasterXSize, nYSize, adfData.data(),
+                     nRasterXSize, nYSize, GDT_Float64, nBandCount,
+                     anBandList.data(), 0, 0, nBandSize * sizeof(double),
+                     nullptr) != CE_None)
+        {
+            return CE_Failure;
+        }
+
+        for (int i = 0; i < nBandCount; ++i)
+        {
+            auto &sBand = asBands[i];
+            sBand.padfData = adfData.data() + i * nBandSize;
+            sBand.pabyMask = nullptr;
+            sBand.nCount = nCount;
+            if (sBand.poMaskBand)
+            {
+                GByte *pabyMask = abyMask.data() + i * nBandSize;
+                if (sBand.poMaskBand->RasterIO(
+                        GF_Read, 0, iYOff, nRasterXSize, nYSize, pabyMask,
+                        nRasterXSize, nYSize, GDT_Byte, 0, 0,
+                        nullptr) != CE_None)
+                {
+                    return CE_Failure;
+                }
+                sBand.pabyMask = pabyMask;
+            }
+
+            if (!poJobQueue ||
+                !poJobQueue->SubmitJob(GDALDatasetStatsAccumulate, &sBand))
+            {
+                GDALDatasetStatsAccumulate(&sBand);
+            }
+        }
+        if (poJobQueue)
+            poJobQueue->WaitCompletion();
+
+        if (!pfnProgress(static_cast<double>(iYOff + nYSize) / nRasterYSize,
+                         "Compute Statistics", pProgressData))
+        {
+            ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Save computed information.                                      */
+    /* -------------------------------------------------------------------- */
+    const GUIntBig nSampleCount =
+        static_cast<GUIntBig>(nRasterXSize) * nRasterYSize;
+    CPLErr eErr = CE_None;
+    for (auto &sBand : asBands)
+    {
+        if (sBand.nValidCount > 0)
+        {
+            if (sBand.poBand->GetMetadataItem("STATISTICS_APPROXIMATE"))
+                sBand.poBand->SetMetadataItem("STATISTICS_APPROXIMATE",
+                                              nullptr);
+            sBand.poBand->SetStatistics(
+                sBand.dfMin, sBand.dfMax, sBand.dfMean,
+                sqrt(sBand.dfM2 / static_cast<double>(sBand.nValidCount)));
+        }
+        else
+        {
+            ReportError(CE_Failure, CPLE_AppDefined,
+                        "Failed to compute statistics of band %d, no valid "
+                        "pixels found.",
+                        sBand.poBand->GetBand());
+            eErr = CE_Failure;
+        }
+        sBand.poBand->SetValidPercent(nSampleCount, sBand.nValidCount);
+    }
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                    GDALDatasetComputeStatistics()                    */
+/************************************************************************/
+
+/**
+ * \brief Compute statistics of several bands in a single pass.
+ *
+ * This function is the same as the C++ method
+ * GDALDataset::ComputeStatistics().
+ *
+ * @param hDS Dataset handle.
+ * @param nBandCount the number of bands.
+ * @param panBandList the list of nBandCount band numbers, or NULL to
+ * select the first nBandCount bands.
+ * @param bApproxOK whether approximate statistics are acceptable.
+ * @param pfnProgress a function to call to report progress, or NULL.
+ * @param pProgressData application data to pass to the progress function.
+ *
+ * @return CE_None on success, CE_Failure otherwise.
+ *
+ * @since GDAL 3.9
+ */
+
+CPLErr GDALDatasetComputeStatistics(GDALDatasetH hDS, int nBandCount,
+                                    const int *panBandList, int bApproxOK,
+                                    GDALProgressFunc pfnProgress,
+                                    void *pProgressData)
+{
+    VALIDATE_POINTER1(hDS, __func__, CE_Failure);
+    return GDALDataset::FromHandle(hDS)->ComputeStatistics(
+        nBandCount, panBandList, CPL_TO_BOOL(bApproxOK), pfnProgress,
+        pProgressData);
+}
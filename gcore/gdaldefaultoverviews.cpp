@@ -603,6 +603,57 @@ CPLErr GDALDefaultOverviews::BuildOverviewsSubDataset(
                           papszOptions);
 }
 
+/************************************************************************/
+/*                  CanRegenerateOverviewsMultiBand()                   */
+/************************************************************************/
+
+// Whether GDALRegenerateOverviewsMultiBand() can be used to refresh the
+// overviews of all the bands at once.
+static bool CanRegenerateOverviewsMultiBand(
+    int nBands, GDALRasterBand *const *papoSrcBands,
+    const std::vector<std::vector<GDALRasterBand *>> &aapoOverviewBands,
+    const char *pszResampling)
+{
+    if (!STARTS_WITH_CI(pszResampling, "NEAR") &&
+        !EQUAL(pszResampling, "AVERAGE") && !EQUAL(pszResampling, "RMS") &&
+        !EQUAL(pszResampling, "GAUSS") && !EQUAL(pszResampling, "CUBIC") &&
+        !EQUAL(pszResampling, "CUBICSPLINE") &&
+        !EQUAL(pszResampling, "LANCZOS") && !EQUAL(pszResampling, "BILINEAR") &&
+        !EQUAL(pszResampling, "MODE"))
+    {
+        return false;
+    }
+
+    const GDALDataType eDT = papoSrcBands[0]->GetRasterDataType();
+    if (GDALDataTypeIsComplex(eDT) || aapoOverviewBands[0].empty())
+        return false;
+
+    for (int iBand = 0; iBand < nBands; iBand++)
+    {
+        const auto poCT = papoSrcBands[iBand]->GetColorTable();
+        if (papoSrcBands[iBand]->GetRasterDataType() != eDT ||
+            (poCT != nullptr && !STARTS_WITH_CI(pszResampling, "NEAR") &&
+             !poCT->IsIdentity()) ||
+            aapoOverviewBands[iBand].size() != aapoOverviewBands[0].size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < aapoOverviewBands[0].size(); i++)
+        {
+            const auto poOvrBand = aapoOverviewBands[iBand][i];
+            const auto poRefOvrBand = aapoOverviewBands[0][i];
+            if (poOvrBand->GetXSize() != poRefOvrBand->GetXSize() ||
+                poOvrBand->GetYSize() != poRefOvrBand->GetYSize() ||
+                poOvrBand->GetRasterDataType() !=
+                    poRefOvrBand->GetRasterDataType())
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                           BuildOverviews()                           */
 /************************************************************************/
@@ -888,8 +939,7 @@ CPLErr GDALDefaultOverviews::BuildOverviews(
     /* -------------------------------------------------------------------- */
     /*      Refresh old overviews that were listed.                         */
     /* -------------------------------------------------------------------- */
-    GDALRasterBand **papoOverviewBands =
-        static_cast<GDALRasterBand **>(CPLCalloc(sizeof(void *), nOverviews));
+    std::vector<std::vector<GDALRasterBand *>> aapoOverviewBands(nBands);
 
     for (int iBand = 0; iBand < nBands && eErr == CE_None; iBand++)
     {
@@ -900,7 +950,6 @@ CPLErr GDALDefaultOverviews::BuildOverviews(
             break;
         }
 
-        nNewOverviews = 0;
         std::vector<bool> abAlreadyUsedOverviewBand(poBand->GetOverviewCount(),
                                                     false);
 
@@ -934,25 +983,52 @@ CPLErr GDALDefaultOverviews::BuildOverviews(
                                                     poBand->GetYSize()))
                 {
                     abAlreadyUsedOverviewBand[j] = true;
-                    CPLAssert(nNewOverviews < poBand->GetOverviewCount());
-                    papoOverviewBands[nNewOverviews++] = poOverview;
+                    aapoOverviewBands[iBand].push_back(poOverview);
                     break;
                 }
             }
         }
+    }
 
-        if (nNewOverviews > 0)
+    const double dfOffset = dfAreaNewOverviews / dfAreaRefreshedOverviews;
+    const double dfScale = 1.0 - dfOffset;
+
+    /* -------------------------------------------------------------------- */
+    /*      Refresh all the bands in a single pass over the source, so      */
+    /*      that each source block is read once, if possible.               */
+    /* -------------------------------------------------------------------- */
+    if (eErr == CE_None && nBands > 1 &&
+        CanRegenerateOverviewsMultiBand(nBands, pahBands, aapoOverviewBands,
+                                        pszResampling))
+    {
+        std::vector<GDALRasterBand **> apapoOverviewBands;
+        for (auto &apoOverviewBands : aapoOverviewBands)
+            apapoOverviewBands.push_back(apoOverviewBands.data());
+        pScaledProgress =
+            GDALCreateScaledProgress(dfOffset, 1.0, GDALScaledProgress,
+                                     pScaledOverviewWithoutMask);
+        eErr = GDALRegenerateOverviewsMultiBand(
+            nBands, pahBands, static_cast<int>(aapoOverviewBands[0].size()),
+            apapoOverviewBands.data(), pszResampling, GDALScaledProgress,
+            pScaledProgress, papszOptions);
+        GDALDestroyScaledProgress(pScaledProgress);
+    }
+    else
+    {
+        for (int iBand = 0; iBand < nBands && eErr == CE_None; iBand++)
         {
-            const double dfOffset =
-                dfAreaNewOverviews / dfAreaRefreshedOverviews;
-            const double dfScale = 1.0 - dfOffset;
+            auto &apoOverviewBands = aapoOverviewBands[iBand];
+            if (apoOverviewBands.empty())
+                continue;
+
             pScaledProgress = GDALCreateScaledProgress(
                 dfOffset + dfScale * iBand / nBands,
                 dfOffset + dfScale * (iBand + 1) / nBands, GDALScaledProgress,
                 pScaledOverviewWithoutMask);
             eErr = GDALRegenerateOverviewsEx(
-                GDALRasterBand::ToHandle(poBand), nNewOverviews,
-                reinterpret_cast<GDALRasterBandH *>(papoOverviewBands),
+                GDALRasterBand::ToHandle(pahBands[iBand]),
+                static_cast<int>(apoOverviewBands.size()),
+                reinterpret_cast<GDALRasterBandH *>(apoOverviewBands.data()),
                 pszResampling, GDALScaledProgress, pScaledProgress,
                 papszOptions);
             GDALDestroyScaledProgress(pScaledProgress);
@@ -962,7 +1038,6 @@ CPLErr GDALDefaultOverviews::BuildOverviews(
     /* -------------------------------------------------------------------- */
     /*      Cleanup                                                         */
     /* -------------------------------------------------------------------- */
-    CPLFree(papoOverviewBands);
     CPLFree(panNewOverviewList);
     CPLFree(pahBands);
     GDALDestroyScaledProgress(pScaledOverviewWithoutMask);
@@ -38,6 +38,7 @@
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_http.h"
+#include "cpl_minixml.h"
 #include "cpl_multiproc.h"
 #include "cpl_port.h"
 #include "cpl_string.h"
@@ -417,6 +418,85 @@ GDALDriver *GDALDriverManager::GetDriver(int iDriver, bool bIncludeHidden)
 }
 //! @endcond
 
+/************************************************************************/
+/*                    BuildSignatureIndex_unlocked()                    */
+/************************************************************************/
+
+void GDALDriverManager::BuildSignatureIndex_unlocked()
+{
+    m_oMapSignatureToDrivers.clear();
+    for (int iDriver = 0; iDriver < nDrivers; ++iDriver)
+    {
+        GDALDriver *poDriver = papoDrivers[iDriver];
+        const char *pszSignatures =
+            poDriver->GetMetadataItem(GDAL_DMD_SIGNATURES);
+        if (pszSignatures == nullptr)
+            continue;
+        const CPLStringList aosSignatures(
+            CSLTokenizeString2(pszSignatures, " ", 0));
+        for (const char *pszSignature : aosSignatures)
+        {
+            int nBytes = 0;
+            GByte *pabyBytes = CPLHexToBinary(pszSignature, &nBytes);
+            if (nBytes < 2 || strlen(pszSignature) != 2 * size_t(nBytes))
+            {
+                CPLDebug("GDAL", "Invalid signature '%s' for driver %s",
+                         pszSignature, poDriver->GetDescription());
+            }
+            else
+            {
+                const GUInt16 nKey =
+                    static_cast<GUInt16>((pabyBytes[0] << 8) | pabyBytes[1]);
+                m_oMapSignatureToDrivers[nKey].emplace_back(
+                    std::string(reinterpret_cast<const char *>(pabyBytes),
+                                nBytes),
+                    poDriver);
+            }
+            CPLFree(pabyBytes);
+        }
+    }
+    m_bSignatureIndexDirty = false;
+}
+
+/************************************************************************/
+/*                    GetDriversMatchingSignature()                     */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+/** Return the drivers, in their registration order, that declare in
+ * GDAL_DMD_SIGNATURES a signature matching the first bytes of a file.
+ */
+std::vector<GDALDriver *>
+GDALDriverManager::GetDriversMatchingSignature(const GByte *pabyHeader,
+                                               int nHeaderBytes)
+{
+    std::vector<GDALDriver *> apoDrivers;
+    if (nHeaderBytes < 2)
+        return apoDrivers;
+
+    CPLMutexHolderD(&hDMMutex);
+    if (m_bSignatureIndexDirty)
+        BuildSignatureIndex_unlocked();
+
+    const auto oIter = m_oMapSignatureToDrivers.find(
+        static_cast<GUInt16>((pabyHeader[0] << 8) | pabyHeader[1]));
+    if (oIter == m_oMapSignatureToDrivers.end())
+        return apoDrivers;
+    for (const auto &oSignatureAndDriver : oIter->second)
+    {
+        const std::string &osSignature = oSignatureAndDriver.first;
+        if (osSignature.size() <= static_cast<size_t>(nHeaderBytes) &&
+            memcmp(pabyHeader, osSignature.data(), osSignature.size()) == 0 &&
+            std::find(apoDrivers.begin(), apoDrivers.end(),
+                      oSignatureAndDriver.second) == apoDrivers.end())
+        {
+            apoDrivers.push_back(oSignatureAndDriver.second);
+        }
+    }
+    return apoDrivers;
+}
+//! @endcond
+
 /************************************************************************/
 /*                           GDALGetDriver()                            */
 /************************************************************************/
@@ -562,6 +642,7 @@ int GDALDriverManager::RegisterDriver(GDALDriver *poDriver, bool bHidden)
 
     oMapNameToDrivers[CPLString(poDriver->GetDescription()).toupper()] =
         poDriver;
+    m_bSignatureIndexDirty = true;
 
     int iResult = nDrivers - 1;
 
@@ -617,6 +698,7 @@ void GDALDriverManager::DeregisterDriver(GDALDriver *poDriver)
         return;
 
     oMapNameToDrivers.erase(CPLString(poDriver->GetDescription()).toupper());
+    m_bSignatureIndexDirty = true;
     --nDrivers;
     // Move all following drivers down by one to pack the list.
     while (i < nDrivers)
@@ -935,6 +1017,144 @@ CPLErr GDALDriverManager::LoadPlugin(const char *name)
 #endif  // GDAL_NO_AUTOLOAD
 }
 
+#ifndef GDAL_NO_AUTOLOAD
+
+/************************************************************************/
+/*                  GDALGetPluginMetadataCacheFilename()                */
+/************************************************************************/
+
+// Return the filename of the cache of the metadata of the drivers registered
+// by plugins, or an empty string if it is disabled.
+static std::string GDALGetPluginMetadataCacheFilename()
+{
+    const char *pszCache =
+        CPLGetConfigOption("GDAL_PLUGIN_METADATA_CACHE", nullptr);
+    if (pszCache != nullptr)
+    {
+        if (pszCache[0] == 0 || !CPLTestBool(pszCache))
+            return std::string();
+        if (!EQUAL(pszCache, "YES") && !EQUAL(pszCache, "ON") &&
+            !EQUAL(pszCache, "TRUE"))
+            return pszCache;
+    }
+
+    const char *pszDir = CPLGetConfigOption("XDG_CACHE_HOME", nullptr);
+    std::string osDir;
+    if (pszDir && pszDir[0])
+    {
+        osDir = pszDir;
+    }
+    else
+    {
+#ifdef _WIN32
+        const char *pszHome = CPLGetConfigOption("USERPROFILE", nullptr);
+#else
+        const char *pszHome = CPLGetConfigOption("HOME", nullptr);
+#endif
+        if (pszHome == nullptr || pszHome[0] == 0)
+            return std::string();
+        osDir = CPLFormFilename(pszHome, ".cache", nullptr);
+    }
+    osDir = CPLFormFilename(osDir.c_str(), "gdal", nullptr);
+    return CPLFormFilename(osDir.c_str(),
+                           CPLSPrintf("plugin_metadata_cache_%s.xml",
+                                      GDALVersionInfo("RELEASE_NAME")),
+                           nullptr);
+}
+
+/************************************************************************/
+/*                    GDALFindPluginInMetadataCache()                   */
+/************************************************************************/
+
+// Return the <Plugin> element of the cache matching the current state of
+// the plugin file, or nullptr.
+static CPLXMLNode *GDALFindPluginInMetadataCache(CPLXMLNode *psRoot,
+                                                 const char *pszFilename,
+                                                 const VSIStatBufL &sStat)
+{
+    for (CPLXMLNode *psIter = psRoot ? psRoot->psChild : nullptr; psIter;
+         psIter = psIter->psNext)
+    {
+        if (psIter->eType == CXT_Element &&
+            strcmp(psIter->pszValue, "Plugin") == 0 &&
+            strcmp(CPLGetXMLValue(psIter, "path", ""), pszFilename) == 0)
+        {
+            if (CPLAtoGIntBig(CPLGetXMLValue(psIter, "size", "-1")) ==
+                    static_cast<GIntBig>(sStat.st_size) &&
+                CPLAtoGIntBig(CPLGetXMLValue(psIter, "mtime", "-1")) ==
+                    static_cast<GIntBig>(sStat.st_mtime))
+            {
+                return psIter;
+            }
+            return nullptr;
+        }
+    }
+    return nullptr;
+}
+
+/************************************************************************/
+/*                     GDALAddPluginToMetadataCache()                   */
+/************************************************************************/
+
+// Record the metadata of the drivers registered by a plugin, replacing any
+// previous entry of that plugin.
+static void GDALAddPluginToMetadataCache(CPLXMLNode *psRoot,
+                                         const char *pszFilename,
+                                         const VSIStatBufL &sStat,
+                                         GDALDriver *const *papoNewDrivers,
+                                         int nNewDrivers)
+{
+    CPLXMLNode *psPrev = nullptr;
+    for (CPLXMLNode *psIter = psRoot->psChild; psIter;
+         psPrev = psIter, psIter = psIter->psNext)
+    {
+        if (psIter->eType == CXT_Element &&
+            strcmp(psIter->pszValue, "Plugin") == 0 &&
+            strcmp(CPLGetXMLValue(psIter, "path", ""), pszFilename) == 0)
+        {
+            if (psPrev)
+                psPrev->psNext = psIter->psNext;
+            else
+                psRoot->psChild = psIter->psNext;
+            psIter->psNext = nullptr;
+            CPLDestroyXMLNode(psIter);
+            break;
+        }
+    }
+
+    CPLXMLNode *psPlugin = CPLCreateXMLNode(psRoot, CXT_Element, "Plugin");
+    CPLAddXMLAttributeAndValue(psPlugin, "path", pszFilename);
+    CPLAddXMLAttributeAndValue(
+        psPlugin, "size",
+        CPLSPrintf(CPL_FRMT_GIB, static_cast<GIntBig>(sStat.st_size)));
+    CPLAddXMLAttributeAndValue(
+        psPlugin, "mtime",
+        CPLSPrintf(CPL_FRMT_GIB, static_cast<GIntBig>(sStat.st_mtime)));
+    for (int i = 0; i < nNewDrivers; ++i)
+    {
+        GDALDriver *poDriver = papoNewDrivers[i];
+        CPLXMLNode *psDriver =
+            CPLCreateXMLNode(psPlugin, CXT_Element, "Driver");
+        CPLAddXMLAttributeAndValue(psDriver, "name",
+                                   poDriver->GetDescription());
+        for (CSLConstList papszIter = poDriver->GetMetadata();
+             papszIter && *papszIter; ++papszIter)
+        {
+            char *pszKey = nullptr;
+            const char *pszValue = CPLParseNameValue(*papszIter, &pszKey);
+            if (pszKey && pszValue)
+            {
+                CPLXMLNode *psItem = CPLCreateXMLElementAndValue(
+                    psDriver, "MetadataItem", pszValue);
+                CPLAddXMLAttributeAndValue(psItem, "key", pszKey);
+            }
+            CPLFree(pszKey);
+        }
+    }
+}
+
+#endif  // GDAL_NO_AUTOLOAD
+
 /************************************************************************/
 /*                          AutoLoadDrivers()                           */
 /************************************************************************/
@@ -997,6 +1217,30 @@ void GDALDriverManager::AutoLoadDrivers()
 
     osABIVersion.Printf("%d.%d", GDAL_VERSION_MAJOR, GDAL_VERSION_MINOR);
 
+    /* -------------------------------------------------------------------- */
+    /*      Load the cache of the metadata of the plugin drivers, so that   */
+    /*      they can be declared without loading them.                      */
+    /* -------------------------------------------------------------------- */
+    const std::string osCacheFilename = GDALGetPluginMetadataCacheFilename();
+    CPLXMLTreeCloser oCache(nullptr);
+    bool bCacheDirty = false;
+    if (!osCacheFilename.empty())
+    {
+        VSIStatBufL sStat;
+        if (VSIStatL(osCacheFilename.c_str(), &sStat) == 0)
+        {
+            CPLPushErrorHandler(CPLQuietErrorHandler);
+            oCache.reset(CPLParseXMLFile(osCacheFilename.c_str()));
+            CPLPopErrorHandler();
+        }
+        if (!oCache || oCache->eType != CXT_Element ||
+            strcmp(oCache->pszValue, "PluginMetadataCache") != 0)
+        {
+            oCache.reset(
+                CPLCreateXMLNode(nullptr, CXT_Element, "PluginMetadataCache"));
+        }
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Scan each directory looking for files starting with gdal_       */
     /* -------------------------------------------------------------------- */
@@ -1051,8 +1295,58 @@ void GDALDriverManager::AutoLoadDrivers()
             else
                 continue;
 
-            const char *pszFilename =
+            const std::string osFilename =
                 CPLFormFilename(osABISpecificDir, papszFiles[iFile], nullptr);
+            const char *pszFilename = osFilename.c_str();
+
+            // If the plugin is in the metadata cache, declare its drivers
+            // as deferred plugin drivers, without loading it.
+            VSIStatBufL sPluginStat;
+            const bool bPluginStatOK =
+                oCache && VSIStatL(pszFilename, &sPluginStat) == 0;
+            const CPLXMLNode *psCachedPlugin =
+                bPluginStatOK ? GDALFindPluginInMetadataCache(
+                                    oCache.get(), pszFilename, sPluginStat)
+                              : nullptr;
+            if (psCachedPlugin)
+            {
+                bFoundOnePlugin = true;
+                m_oSetPluginFileNames.insert(papszFiles[iFile]);
+                for (const CPLXMLNode *psDriver = psCachedPlugin->psChild;
+                     psDriver; psDriver = psDriver->psNext)
+                {
+                    const char *pszDriverName =
+                        CPLGetXMLValue(psDriver, "name", nullptr);
+                    if (psDriver->eType != CXT_Element ||
+                        strcmp(psDriver->pszValue, "Driver") != 0 ||
+                        pszDriverName == nullptr ||
+                        GetDriverByName(pszDriverName) != nullptr)
+                    {
+                        continue;
+                    }
+                    auto poProxyDriver =
+                        new GDALPluginDriverProxy(papszFiles[iFile]);
+                    poProxyDriver->SetDescription(pszDriverName);
+                    for (const CPLXMLNode *psItem = psDriver->psChild; psItem;
+                         psItem = psItem->psNext)
+                    {
+                        const char *pszKey =
+                            CPLGetXMLValue(psItem, "key", nullptr);
+                        if (psItem->eType == CXT_Element &&
+                            strcmp(psItem->pszValue, "MetadataItem") == 0 &&
+                            pszKey != nullptr)
+                        {
+                            poProxyDriver->SetMetadataItem(
+                                pszKey, CPLGetXMLValue(psItem, "", ""));
+                        }
+                    }
+                    poProxyDriver->pfnIdentifyEx =
+                        GDALPluginDriverProxy::IdentifyFromCachedMetadata;
+                    poProxyDriver->SetPluginFullPath(osFilename);
+                    RegisterDriver(poProxyDriver);
+                }
+                continue;
+            }
 
             CPLErrorReset();
             CPLPushErrorHandler(CPLQuietErrorHandler);
@@ -1076,7 +1370,17 @@ void GDALDriverManager::AutoLoadDrivers()
                 CPLDebug("GDAL", "Auto register %s using %s.", pszFilename,
                          osFuncName.c_str());
 
+                const int nDriversBefore = nDrivers;
                 reinterpret_cast<void (*)()>(pRegister)();
+
+                if (bPluginStatOK)
+                {
+                    GDALAddPluginToMetadataCache(
+                        oCache.get(), pszFilename, sPluginStat,
+                        papoDrivers + nDriversBefore,
+                        std::max(0, nDrivers - nDriversBefore));
+                    bCacheDirty = true;
+                }
             }
         }
 
@@ -1085,6 +1389,24 @@ void GDALDriverManager::AutoLoadDrivers()
 
     CSLDestroy(papszSearchPaths);
 
+    if (bCacheDirty)
+    {
+        // Write to a temporary file first, as several processes may update
+        // the cache at the same time.
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        VSIMkdirRecursive(CPLGetPath(osCacheFilename.c_str()), 0755);
+        const std::string osTmpFilename =
+            osCacheFilename +
+            CPLSPrintf(".%d.tmp", static_cast<int>(CPLGetPID()));
+        if (!CPLSerializeXMLTreeToFile(oCache.get(), osTmpFilename.c_str()) ||
+            VSIRename(osTmpFilename.c_str(), osCacheFilename.c_str()) != 0)
+        {
+            CPLDebug("GDAL", "Cannot write %s", osCacheFilename.c_str());
+            VSIUnlink(osTmpFilename.c_str());
+        }
+        CPLPopErrorHandler();
+    }
+
     // No need to reorder drivers if there are no plugins
     if (!bFoundOnePlugin)
         m_osDriversIniPath.clear();
@@ -1216,6 +1538,7 @@ void GDALDriverManager::ReorderDrivers()
         CPLAssert(oIter != oMapNameToDrivers.end());
         papoDrivers[i] = oIter->second;
     }
+    m_bSignatureIndexDirty = true;
 #endif
 }
 
@@ -1261,6 +1584,58 @@ char **GDALPluginDriverProxy::GetMetadata(const char *pszDomain)
     return poRealDriver->GetMetadata(pszDomain);
 }
 
+/************************************************************************/
+/*                     IdentifyFromCachedMetadata()                     */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+/** Identify callback of the proxies created from the plugin metadata cache,
+ * for which the identification code of the driver is not available before
+ * loading it. Only GDAL_DMD_SIGNATURES and GDAL_DMD_CONNECTION_PREFIX can
+ * positively identify a dataset.
+ */
+int GDALPluginDriverProxy::IdentifyFromCachedMetadata(GDALDriver *poDriver,
+                                                      GDALOpenInfo *poOpenInfo)
+{
+    auto poProxyDriver = cpl::down_cast<GDALPluginDriverProxy *>(poDriver);
+    if (poProxyDriver->m_poRealDriver)
+    {
+        GDALDriver *poRealDriver = poProxyDriver->m_poRealDriver.get();
+        if (poRealDriver->pfnIdentifyEx)
+            return poRealDriver->pfnIdentifyEx(poRealDriver, poOpenInfo);
+        if (poRealDriver->pfnIdentify)
+            return poRealDriver->pfnIdentify(poOpenInfo);
+        return GDAL_IDENTIFY_UNKNOWN;
+    }
+
+    const char *pszPrefix =
+        poDriver->GDALDriver::GetMetadataItem(GDAL_DMD_CONNECTION_PREFIX);
+    if (pszPrefix && STARTS_WITH_CI(poOpenInfo->pszFilename, pszPrefix))
+        return TRUE;
+
+    const char *pszSignatures =
+        poDriver->GDALDriver::GetMetadataItem(GDAL_DMD_SIGNATURES);
+    if (pszSignatures && poOpenInfo->nHeaderBytes > 0)
+    {
+        const CPLStringList aosSignatures(
+            CSLTokenizeString2(pszSignatures, " ", 0));
+        for (const char *pszSignature : aosSignatures)
+        {
+            int nBytes = 0;
+            GByte *pabyBytes = CPLHexToBinary(pszSignature, &nBytes);
+            const bool bMatch =
+                nBytes > 0 && nBytes <= poOpenInfo->nHeaderBytes &&
+                memcmp(poOpenInfo->pabyHeader, pabyBytes, nBytes) == 0;
+            CPLFree(pabyBytes);
+            if (bMatch)
+                return TRUE;
+        }
+    }
+
+    return GDAL_IDENTIFY_UNKNOWN;
+}
+//! @endcond
+
 CPLErr GDALPluginDriverProxy::SetMetadataItem(const char *pszName,
                                               const char *pszValue,
                                               const char *pszDomain)
@@ -1294,6 +1669,7 @@ static const char *const apszProxyMetadataItems[] = {
     GDAL_DMD_CONNECTION_PREFIX,
     GDAL_DCAP_VECTOR_TRANSLATE_FROM,
     GDAL_DMD_PLUGIN_INSTALLATION_MESSAGE,
+    GDAL_DMD_SIGNATURES,
 };
 
 const char *GDALPluginDriverProxy::GetMetadataItem(const char *pszName,
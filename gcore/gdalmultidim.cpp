@@ -31,6 +31,7 @@
 #include <assert.h>
 #include <algorithm>
 #include <limits>
+#include <numeric>
 #include <queue>
 #include <set>
 #include <utility>
@@ -43,6 +44,8 @@
 #include "gdal_pam.h"
 #include "gdal_utils.h"
 #include "cpl_safemaths.hpp"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "memmultidim.h"
 #include "ogrsf_frmts.h"
 #include "gdalmultidim_priv.h"
@@ -3749,11 +3752,152 @@ bool GDALMDArray::CopyFromAllExceptValues(const GDALMDArray *poSrcArray,
 
 //! @endcond
 
+/************************************************************************/
+/*                          GetCopyChunkSize()                          */
+/************************************************************************/
+
+// Return the size of the window used by CopyFrom() to transfer data from
+// poSrcArray to poDstArray, or an empty vector if the source array has no
+// natural block size.
+//
+// The window is a multiple of the destination block size, so that each
+// destination block is written at once. Along a dimension, a source block of
+// size S is decoded on average 1 + (S - gcd(S, W)) / W times when iterating
+// with a window of size W. The window is grown along the dimension where this
+// factor is the largest, up to the least common multiple of the source and
+// destination block sizes, as long as it fits within nMaxChunkMemory.
+static std::vector<size_t> GetCopyChunkSize(const GDALMDArray *poSrcArray,
+                                            const GDALMDArray *poDstArray,
+                                            size_t nMaxChunkMemory)
+{
+    const auto &dims = poDstArray->GetDimensions();
+    const size_t nDims = dims.size();
+    const auto anSrcBlockSize = poSrcArray->GetBlockSize();
+    const auto anDstBlockSize = poDstArray->GetBlockSize();
+    if (anSrcBlockSize.size() != nDims || anDstBlockSize.size() != nDims ||
+        std::all_of(anSrcBlockSize.begin(), anSrcBlockSize.end(),
+                    [](GUInt64 nSize) { return nSize == 0; }))
+    {
+        return {};
+    }
+
+    std::vector<GUInt64> anDimSize(nDims);
+    std::vector<GUInt64> anSrcBlock(nDims);
+    std::vector<GUInt64> anDstBlock(nDims);
+    std::vector<GUInt64> anTarget(nDims);
+    std::vector<GUInt64> anWindow(nDims);
+    // Computed as a double to avoid caring about overflows
+    double dfWindowBytes =
+        static_cast<double>(poSrcArray->GetDataType().GetSize());
+    for (size_t i = 0; i < nDims; ++i)
+    {
+        anDimSize[i] = dims[i]->GetSize();
+        if (anDimSize[i] == 0)
+            return {};
+        anSrcBlock[i] = std::max<GUInt64>(
+            1, std::min<GUInt64>(anSrcBlockSize[i], anDimSize[i]));
+        anDstBlock[i] = std::max<GUInt64>(
+            1, std::min<GUInt64>(anDstBlockSize[i], anDimSize[i]));
+        const GUInt64 nSrcMul =
+            anSrcBlock[i] / std::gcd(anSrcBlock[i], anDstBlock[i]);
+        anTarget[i] = nSrcMul > anDimSize[i] / anDstBlock[i]
+                          ? anDimSize[i]
+                          : nSrcMul * anDstBlock[i];
+        anWindow[i] = anDstBlock[i];
+        dfWindowBytes *= static_cast<double>(anWindow[i]);
+    }
+    const double dfMaxChunkMemory = static_cast<double>(nMaxChunkMemory);
+    if (dfWindowBytes > dfMaxChunkMemory)
+        return {};
+
+    const auto GetDecodeFactor = [&anSrcBlock](size_t i, GUInt64 nWindow)
+    {
+        return 1.0 + static_cast<double>(anSrcBlock[i] -
+                                         std::gcd(anSrcBlock[i], nWindow)) /
+                         static_cast<double>(nWindow);
+    };
+
+    std::vector<bool> abCanGrow(nDims);
+    for (size_t i = 0; i < nDims; ++i)
+        abCanGrow[i] = anWindow[i] < anTarget[i];
+    while (true)
+    {
+        size_t iBest = nDims;
+        double dfBestFactor = 1.0;
+        for (size_t i = 0; i < nDims; ++i)
+        {
+            if (abCanGrow[i])
+            {
+                const double dfFactor = GetDecodeFactor(i, anWindow[i]);
+                if (dfFactor > dfBestFactor)
+                {
+                    dfBestFactor = dfFactor;
+                    iBest = i;
+                }
+            }
+        }
+        if (iBest == nDims)
+            break;
+
+        // Double the window along that dimension, or if that does not fit,
+        // take the largest multiple of the destination block size that fits.
+        const double dfOtherDimsBytes =
+            dfWindowBytes / static_cast<double>(anWindow[iBest]);
+        GUInt64 nNewWindow = std::min(anTarget[iBest], 2 * anWindow[iBest]);
+        if (dfOtherDimsBytes * static_cast<double>(nNewWindow) >
+            dfMaxChunkMemory)
+        {
+            abCanGrow[iBest] = false;
+            nNewWindow =
+                static_cast<GUInt64>(dfMaxChunkMemory / dfOtherDimsBytes) /
+                anDstBlock[iBest] * anDstBlock[iBest];
+            if (nNewWindow <= anWindow[iBest])
+                continue;
+        }
+        anWindow[iBest] = nNewWindow;
+        dfWindowBytes = dfOtherDimsBytes * static_cast<double>(nNewWindow);
+        if (nNewWindow >= anTarget[iBest])
+            abCanGrow[iBest] = false;
+    }
+
+    // Use the remaining memory budget to enlarge the window by multiples of
+    // itself, starting with the fastest varying dimension, as done by
+    // GetProcessingChunkSize().
+    for (size_t i = nDims; i > 0;)
+    {
+        --i;
+        const auto nMul =
+            static_cast<GUInt64>(dfMaxChunkMemory / dfWindowBytes);
+        if (nMul >= 2 && anWindow[i] < anDimSize[i])
+        {
+            const double dfOtherDimsBytes =
+                dfWindowBytes / static_cast<double>(anWindow[i]);
+            anWindow[i] = std::min(
+                anDimSize[i],
+                anWindow[i] *
+                    std::min(nMul, DIV_ROUND_UP(anDimSize[i], anWindow[i])));
+            dfWindowBytes = dfOtherDimsBytes * static_cast<double>(anWindow[i]);
+        }
+    }
+
+    std::vector<size_t> anChunkSize;
+    for (const auto nWindow : anWindow)
+        anChunkSize.push_back(static_cast<size_t>(nWindow));
+    return anChunkSize;
+}
+
 /************************************************************************/
 /*                               CopyFrom()                             */
 /************************************************************************/
 
 /** Copy the content of an array into a new (generally empty) array.
+ *
+ * The copy is done by windows whose size is a multiple of the block size of
+ * the destination array, and enlarged, within the memory budget set by the
+ * GDAL_SWATH_SIZE configuration option (defaults to a quarter of the block
+ * cache size), so that source blocks are decoded as few times as possible when
+ * the source and destination block sizes differ. Unless GDAL_NUM_THREADS is
+ * set to 1, a window is written in a worker thread while the next one is read.
  *
  * @param poSrcDS    Source dataset. Might be nullptr (but for correct behavior
  *                   of some output drivers this is not recommended)
@@ -3821,6 +3965,77 @@ bool GDALMDArray::CopyFrom(CPL_UNUSED GDALDataset *poSrcDS,
             GUInt64 nTotalBytesThisArray = 0;
             bool bStop = false;
 
+            // When set, the chunk previously read is written by a worker
+            // thread while the next one is read.
+            std::unique_ptr<CPLJobQueue> poJobQueue{};
+            const GDALExtendedDataType *poWriteDT = nullptr;
+            std::vector<GByte> abyWriteTmp{};
+            std::vector<GUInt64> anWriteStartIdx{};
+            std::vector<size_t> anWriteCount{};
+            bool bWriteError = false;
+            std::vector<CPLErrorHandlerAccumulatorStruct> aoWriteErrors{};
+
+            static void FreeDynamicMemory(const GDALExtendedDataType &dt,
+                                          GByte *ptr, size_t nDims,
+                                          const size_t *chunkCount)
+            {
+                if (dt.NeedsFreeDynamicMemory())
+                {
+                    const auto l_nDTSize = dt.GetSize();
+                    size_t nEltCount = 1;
+                    for (size_t i = 0; i < nDims; ++i)
+                    {
+                        nEltCount *= chunkCount[i];
+                    }
+                    for (size_t i = 0; i < nEltCount; i++)
+                    {
+                        dt.FreeDynamicMemory(ptr);
+                        ptr += l_nDTSize;
+                    }
+                }
+            }
+
+            static bool WriteChunk(GDALMDArray *l_poDstArray,
+                                   const GDALExtendedDataType &dt,
+                                   const GUInt64 *chunkArrayStartIdx,
+                                   const size_t *chunkCount, GByte *pabyData)
+            {
+                const bool bRet =
+                    l_poDstArray->Write(chunkArrayStartIdx, chunkCount,
+                                        nullptr, nullptr, dt, pabyData);
+                FreeDynamicMemory(dt, pabyData,
+                                  l_poDstArray->GetDimensionCount(),
+                                  chunkCount);
+                return bRet;
+            }
+
+            static void WriteJobFunc(void *pUserData)
+            {
+                auto data = static_cast<CopyFunc *>(pUserData);
+                // Errors are re-emitted by WaitPendingWrite()
+                CPLInstallErrorHandlerAccumulator(data->aoWriteErrors);
+                if (!WriteChunk(data->poDstArray, *(data->poWriteDT),
+                                data->anWriteStartIdx.data(),
+                                data->anWriteCount.data(),
+                                data->abyWriteTmp.data()))
+                {
+                    data->bWriteError = true;
+                }
+                CPLUninstallErrorHandlerAccumulator();
+            }
+
+            bool WaitPendingWrite()
+            {
+                poJobQueue->WaitCompletion();
+                for (const auto &oError : aoWriteErrors)
+                {
+                    CPLError(oError.type, oError.no, "%s",
+                             oError.msg.c_str());
+                }
+                aoWriteErrors.clear();
+                return !bWriteError;
+            }
+
             static bool f(GDALAbstractMDArray *l_poSrcArray,
                           const GUInt64 *chunkArrayStartIdx,
                           const size_t *chunkCount, GUInt64 iCurChunk,
@@ -3834,26 +4049,26 @@ bool GDALMDArray::CopyFrom(CPL_UNUSED GDALDataset *poSrcDS,
                 {
                     return false;
                 }
-                bool bRet =
-                    poDstArray->Write(chunkArrayStartIdx, chunkCount, nullptr,
-                                      nullptr, dt, &data->abyTmp[0]);
-                if (dt.NeedsFreeDynamicMemory())
+                if (data->poJobQueue)
                 {
-                    const auto l_nDTSize = dt.GetSize();
-                    GByte *ptr = &data->abyTmp[0];
                     const size_t l_nDims(l_poSrcArray->GetDimensionCount());
-                    size_t nEltCount = 1;
-                    for (size_t i = 0; i < l_nDims; ++i)
-                    {
-                        nEltCount *= chunkCount[i];
-                    }
-                    for (size_t i = 0; i < nEltCount; i++)
+                    if (!data->WaitPendingWrite())
                     {
-                        dt.FreeDynamicMemory(ptr);
-                        ptr += l_nDTSize;
+                        FreeDynamicMemory(dt, &data->abyTmp[0], l_nDims,
+                                          chunkCount);
+                        return false;
                     }
+                    std::swap(data->abyTmp, data->abyWriteTmp);
+                    data->poWriteDT = &dt;
+                    data->anWriteStartIdx.assign(chunkArrayStartIdx,
+                                                 chunkArrayStartIdx + l_nDims);
+                    data->anWriteCount.assign(chunkCount,
+                                              chunkCount + l_nDims);
+                    if (!data->poJobQueue->SubmitJob(WriteJobFunc, data))
+                        WriteJobFunc(data);
                 }
-                if (!bRet)
+                else if (!WriteChunk(poDstArray, dt, chunkArrayStartIdx,
+                                     chunkCount, &data->abyTmp[0]))
                 {
                     return false;
                 }
@@ -3881,7 +4096,7 @@ bool GDALMDArray::CopyFrom(CPL_UNUSED GDALDataset *poSrcDS,
         copyFunc.pProgressData = pProgressData;
         const char *pszSwathSize =
             CPLGetConfigOption("GDAL_SWATH_SIZE", nullptr);
-        const size_t nMaxChunkSize =
+        size_t nMaxChunkSize =
             pszSwathSize
                 ? static_cast<size_t>(
                       std::min(GIntBig(std::numeric_limits<size_t>::max() / 2),
@@ -3889,7 +4104,30 @@ bool GDALMDArray::CopyFrom(CPL_UNUSED GDALDataset *poSrcDS,
                 : static_cast<size_t>(
                       std::min(GIntBig(std::numeric_limits<size_t>::max() / 2),
                                GDALGetCacheMax64() / 4));
-        const auto anChunkSizes(GetProcessingChunkSize(nMaxChunkSize));
+
+        // Overlap reading of a chunk with writing of the previous one.
+        // Reading or writing a given array is not thread-safe, so there is
+        // at most one pending write.
+        const char *pszNumThreads =
+            CPLGetConfigOption("GDAL_NUM_THREADS", "ALL_CPUS");
+        const int nThreads = std::min(
+            EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                             : atoi(pszNumThreads),
+            1024);
+        if (nThreads > 1 && copyFunc.nTotalBytesThisArray > nMaxChunkSize)
+        {
+            CPLWorkerThreadPool *wtp = GDALGetGlobalThreadPool(nThreads);
+            if (wtp)
+            {
+                copyFunc.poJobQueue = wtp->CreateJobQueue();
+                // Two chunk buffers are used at the same time
+                nMaxChunkSize /= 2;
+            }
+        }
+
+        auto anChunkSizes(GetCopyChunkSize(poSrcArray, this, nMaxChunkSize));
+        if (anChunkSizes.empty())
+            anChunkSizes = GetProcessingChunkSize(nMaxChunkSize);
         size_t nRealChunkSize = nDTSize;
         for (const auto &nChunkSize : anChunkSizes)
         {
@@ -3898,6 +4136,8 @@ bool GDALMDArray::CopyFrom(CPL_UNUSED GDALDataset *poSrcDS,
         try
         {
             copyFunc.abyTmp.resize(nRealChunkSize);
+            if (copyFunc.poJobQueue)
+                copyFunc.abyWriteTmp.resize(nRealChunkSize);
         }
         catch (const std::exception &)
         {
@@ -3906,12 +4146,14 @@ bool GDALMDArray::CopyFrom(CPL_UNUSED GDALDataset *poSrcDS,
             nCurCost += copyFunc.nTotalBytesThisArray;
             return false;
         }
-        if (copyFunc.nTotalBytesThisArray != 0 &&
-            !const_cast<GDALMDArray *>(poSrcArray)
-                 ->ProcessPerChunk(arrayStartIdx.data(), count.data(),
-                                   anChunkSizes.data(), CopyFunc::f,
-                                   &copyFunc) &&
-            (bStrict || copyFunc.bStop))
+        bool bOK = copyFunc.nTotalBytesThisArray == 0 ||
+                   const_cast<GDALMDArray *>(poSrcArray)
+                       ->ProcessPerChunk(arrayStartIdx.data(), count.data(),
+                                         anChunkSizes.data(), CopyFunc::f,
+                                         &copyFunc);
+        if (copyFunc.poJobQueue && !copyFunc.WaitPendingWrite())
+            bOK = false;
+        if (!bOK && (bStrict || copyFunc.bStop))
         {
             nCurCost += copyFunc.nTotalBytesThisArray;
             return false;
@@ -33,6 +33,8 @@
 
 #include <algorithm>
 #include <cstring>
+#include <limits>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -40,6 +42,10 @@
 #include "gdal.h"
 #include "gdal_priv_templates.hpp"
 
+#if defined(__x86_64) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
 //! @cond Doxygen_Suppress
 /************************************************************************/
 /*                        GDALNoDataMaskBand()                          */
@@ -199,6 +205,277 @@ bool GDALNoDataMaskBand::IsNoDataInRange(double dfNoDataValue,
     }
 }
 
+/************************************************************************/
+/*                         GDALComputeNoDataMask()                      */
+/************************************************************************/
+
+template <class T> static inline bool IsNoData(T nVal, T nNoData, bool)
+{
+    return nVal == nNoData;
+}
+
+template <> inline bool IsNoData<float>(float fVal, float fNoData, bool bIsNan)
+{
+    return bIsNan ? CPLIsNan(fVal) != 0 : ARE_REAL_EQUAL(fVal, fNoData);
+}
+
+template <>
+inline bool IsNoData<double>(double dfVal, double dfNoData, bool bIsNan)
+{
+    return bIsNan ? CPLIsNan(dfVal) != 0 : ARE_REAL_EQUAL(dfVal, dfNoData);
+}
+
+template <class T>
+static void ComputeNoDataMaskGeneric(const T *paSrc, T tNoData,
+                                     bool bNoDataIsNan, GByte *pabyMask,
+                                     size_t i, size_t nCount, bool bCombine)
+{
+    for (; i < nCount; ++i)
+    {
+        const GByte byVal = IsNoData(paSrc[i], tNoData, bNoDataIsNan) ? 0 : 255;
+        pabyMask[i] =
+            bCombine ? static_cast<GByte>(pabyMask[i] | byVal) : byVal;
+    }
+}
+
+#if defined(__x86_64) || defined(_M_X64)
+
+// Each tester returns, for 4 consecutive values, 32-bit lanes set to all ones
+// where the value is the nodata value, with the same semantics as IsNoData().
+
+struct NoDataTesterInt32
+{
+    const __m128i xmmNoData;
+
+    explicit NoDataTesterInt32(GInt32 nNoData)
+        : xmmNoData(_mm_set1_epi32(nNoData))
+    {
+    }
+
+    inline __m128i Test4(const void *pSrc) const
+    {
+        return _mm_cmpeq_epi32(
+            _mm_loadu_si128(static_cast<const __m128i *>(pSrc)), xmmNoData);
+    }
+};
+
+struct NoDataTesterFloat
+{
+    const __m128 xmmNoData;
+    const __m128 xmmAbsMask;
+    const __m128 xmmEpsilonMul;
+    const bool bNoDataIsNan;
+
+    NoDataTesterFloat(float fNoData, bool bNoDataIsNanIn)
+        : xmmNoData(_mm_set1_ps(fNoData)),
+          xmmAbsMask(_mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF))),
+          xmmEpsilonMul(_mm_set1_ps(std::numeric_limits<float>::epsilon())),
+          bNoDataIsNan(bNoDataIsNanIn)
+    {
+    }
+
+    inline __m128i Test4(const float *pafSrc) const
+    {
+        const __m128 xmmVal = _mm_loadu_ps(pafSrc);
+        if (bNoDataIsNan)
+            return _mm_castps_si128(_mm_cmpunord_ps(xmmVal, xmmVal));
+        // Same as ARE_REAL_EQUAL()
+        const __m128 xmmAbsDiff =
+            _mm_and_ps(_mm_sub_ps(xmmVal, xmmNoData), xmmAbsMask);
+        const __m128 xmmTolerance = _mm_mul_ps(
+            xmmEpsilonMul,
+            _mm_and_ps(_mm_add_ps(xmmVal, xmmNoData), xmmAbsMask));
+        const __m128 xmmTwiceTolerance = _mm_add_ps(xmmTolerance, xmmTolerance);
+        return _mm_castps_si128(
+            _mm_or_ps(_mm_cmpeq_ps(xmmVal, xmmNoData),
+                      _mm_cmplt_ps(xmmAbsDiff, xmmTwiceTolerance)));
+    }
+};
+
+struct NoDataTesterDouble
+{
+    const __m128d xmmNoData;
+    const __m128d xmmAbsMask;
+    const __m128d xmmEpsilonMul;
+    const bool bNoDataIsNan;
+
+    NoDataTesterDouble(double dfNoData, bool bNoDataIsNanIn)
+        : xmmNoData(_mm_set1_pd(dfNoData)),
+          xmmAbsMask(_mm_castsi128_pd(
+              _mm_set1_epi64x(std::numeric_limits<int64_t>::max()))),
+          xmmEpsilonMul(_mm_set1_pd(std::numeric_limits<float>::epsilon())),
+          bNoDataIsNan(bNoDataIsNanIn)
+    {
+    }
+
+    inline __m128d Test2(const double *padfSrc) const
+    {
+        const __m128d xmmVal = _mm_loadu_pd(padfSrc);
+        if (bNoDataIsNan)
+            return _mm_cmpunord_pd(xmmVal, xmmVal);
+        // Same as ARE_REAL_EQUAL()
+        const __m128d xmmAbsDiff =
+            _mm_and_pd(_mm_sub_pd(xmmVal, xmmNoData), xmmAbsMask);
+        const __m128d xmmTolerance = _mm_mul_pd(
+            xmmEpsilonMul,
+            _mm_and_pd(_mm_add_pd(xmmVal, xmmNoData), xmmAbsMask));
+        const __m128d xmmTwiceTolerance =
+            _mm_add_pd(xmmTolerance, xmmTolerance);
+        return _mm_or_pd(_mm_cmpeq_pd(xmmVal, xmmNoData),
+                         _mm_cmplt_pd(xmmAbsDiff, xmmTwiceTolerance));
+    }
+
+    inline __m128i Test4(const double *padfSrc) const
+    {
+        // Keep the low 32 bits of each 64-bit lane
+        return _mm_castps_si128(
+            _mm_shuffle_ps(_mm_castpd_ps(Test2(padfSrc)),
+                           _mm_castpd_ps(Test2(padfSrc + 2)),
+                           _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+};
+
+static inline void StoreMask16(GByte *pabyMask, __m128i xmmIsNoData,
+                               bool bCombine)
+{
+    __m128i xmmMask = _mm_andnot_si128(xmmIsNoData, _mm_set1_epi8(-1));
+    if (bCombine)
+        xmmMask = _mm_or_si128(
+            xmmMask, _mm_loadu_si128(reinterpret_cast<__m128i *>(pabyMask)));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(pabyMask), xmmMask);
+}
+
+template <class T, class Tester>
+static size_t ComputeNoDataMaskSSE2(const Tester &oTester, const T *paSrc,
+                                    GByte *pabyMask, size_t nCount,
+                                    bool bCombine)
+{
+    size_t i = 0;
+    for (; i + 15 < nCount; i += 16)
+    {
+        const __m128i xmmIsNoData = _mm_packs_epi16(
+            _mm_packs_epi32(oTester.Test4(paSrc + i),
+                            oTester.Test4(paSrc + i + 4)),
+            _mm_packs_epi32(oTester.Test4(paSrc + i + 8),
+                            oTester.Test4(paSrc + i + 12)));
+        StoreMask16(pabyMask + i, xmmIsNoData, bCombine);
+    }
+    return i;
+}
+
+static size_t ComputeNoDataMaskByteSSE2(const GByte *pabySrc, GByte byNoData,
+                                        GByte *pabyMask, size_t nCount,
+                                        bool bCombine)
+{
+    const __m128i xmmNoData = _mm_set1_epi8(static_cast<char>(byNoData));
+    size_t i = 0;
+    for (; i + 15 < nCount; i += 16)
+    {
+        const __m128i xmmVal =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pabySrc + i));
+        StoreMask16(pabyMask + i, _mm_cmpeq_epi8(xmmVal, xmmNoData), bCombine);
+    }
+    return i;
+}
+
+#endif  // defined(__x86_64) || defined(_M_X64)
+
+/** Compute a nodata mask from an array of values.
+ *
+ * pabyMask[i] is set to 0 if pSrc[i] is the nodata value, and to 255
+ * otherwise. If bCombine is true, pabyMask[i] is or'ed with its previous
+ * value, so that a pixel is masked only if all arrays have nodata at it.
+ * pSrc and pabyMask may point to the same buffer for GDT_Byte.
+ *
+ * @param pSrc Input values, of type eWrkDT.
+ * @param eWrkDT Data type of the values, among GDT_Byte, GDT_UInt32,
+ * GDT_Int32, GDT_Float32 and GDT_Float64.
+ * @param dfNoDataValue Nodata value. For floating-point types, it can be NaN.
+ * @param pabyMask Output mask, of nCount bytes.
+ * @param nCount Number of values.
+ * @param bCombine Whether to combine with the existing content of pabyMask.
+ */
+void GDALComputeNoDataMask(const void *pSrc, GDALDataType eWrkDT,
+                           double dfNoDataValue, GByte *pabyMask, size_t nCount,
+                           bool bCombine)
+{
+    const bool bNoDataIsNan = CPLIsNan(dfNoDataValue) != 0;
+    size_t i = 0;
+    switch (eWrkDT)
+    {
+        case GDT_Byte:
+        {
+            const GByte byNoData = static_cast<GByte>(dfNoDataValue);
+            const GByte *pabySrc = static_cast<const GByte *>(pSrc);
+#if defined(__x86_64) || defined(_M_X64)
+            i = ComputeNoDataMaskByteSSE2(pabySrc, byNoData, pabyMask, nCount,
+                                          bCombine);
+#endif
+            ComputeNoDataMaskGeneric(pabySrc, byNoData, false, pabyMask, i,
+                                     nCount, bCombine);
+            break;
+        }
+
+        case GDT_UInt32:
+        {
+            const GUInt32 nNoData = static_cast<GUInt32>(dfNoDataValue);
+            const GUInt32 *panSrc = static_cast<const GUInt32 *>(pSrc);
+#if defined(__x86_64) || defined(_M_X64)
+            GInt32 nNoDataAsInt32;
+            memcpy(&nNoDataAsInt32, &nNoData, sizeof(nNoData));
+            i = ComputeNoDataMaskSSE2(NoDataTesterInt32(nNoDataAsInt32),
+                                      panSrc, pabyMask, nCount, bCombine);
+#endif
+            ComputeNoDataMaskGeneric(panSrc, nNoData, false, pabyMask, i,
+                                     nCount, bCombine);
+            break;
+        }
+
+        case GDT_Int32:
+        {
+            const GInt32 nNoData = static_cast<GInt32>(dfNoDataValue);
+            const GInt32 *panSrc = static_cast<const GInt32 *>(pSrc);
+#if defined(__x86_64) || defined(_M_X64)
+            i = ComputeNoDataMaskSSE2(NoDataTesterInt32(nNoData), panSrc,
+                                      pabyMask, nCount, bCombine);
+#endif
+            ComputeNoDataMaskGeneric(panSrc, nNoData, false, pabyMask, i,
+                                     nCount, bCombine);
+            break;
+        }
+
+        case GDT_Float32:
+        {
+            const float fNoData = static_cast<float>(dfNoDataValue);
+            const float *pafSrc = static_cast<const float *>(pSrc);
+#if defined(__x86_64) || defined(_M_X64)
+            i = ComputeNoDataMaskSSE2(NoDataTesterFloat(fNoData, bNoDataIsNan),
+                                      pafSrc, pabyMask, nCount, bCombine);
+#endif
+            ComputeNoDataMaskGeneric(pafSrc, fNoData, bNoDataIsNan, pabyMask,
+                                     i, nCount, bCombine);
+            break;
+        }
+
+        case GDT_Float64:
+        {
+            const double *padfSrc = static_cast<const double *>(pSrc);
+#if defined(__x86_64) || defined(_M_X64)
+            i = ComputeNoDataMaskSSE2(
+                NoDataTesterDouble(dfNoDataValue, bNoDataIsNan), padfSrc,
+                pabyMask, nCount, bCombine);
+#endif
+            ComputeNoDataMaskGeneric(padfSrc, dfNoDataValue, bNoDataIsNan,
+                                     pabyMask, i, nCount, bCombine);
+            break;
+        }
+
+        default:
+            CPLAssert(false);
+            break;
+    }
+}
+
 /************************************************************************/
 /*                             IReadBlock()                             */
 /************************************************************************/
@@ -217,6 +494,45 @@ CPLErr GDALNoDataMaskBand::IReadBlock(int nXBlockOff, int nYBlockOff,
         memset(pImage, 0, static_cast<GPtrDiff_t>(nBlockXSize) * nBlockYSize);
     }
 
+    // If the corresponding block of the parent is already in the block
+    // cache, typically because the data was just read, compute the mask
+    // directly from it instead of going through RasterIO() again.
+    const auto eParentDT = m_poParent->GetRasterDataType();
+    if (eParentDT == GetWorkDataType(eParentDT) && eParentDT != GDT_Int64 &&
+        eParentDT != GDT_UInt64)
+    {
+        GDALRasterBlock *poBlock =
+            m_poParent->TryGetLockedBlockRef(nXBlockOff, nYBlockOff);
+        if (poBlock != nullptr)
+        {
+            const GByte *pabySrc =
+                static_cast<const GByte *>(poBlock->GetDataRef());
+            const int nDTSize = GDALGetDataTypeSizeBytes(eParentDT);
+            if (nXSizeRequest == nBlockXSize)
+            {
+                GDALComputeNoDataMask(
+                    pabySrc, eParentDT, m_dfNoDataValue,
+                    static_cast<GByte *>(pImage),
+                    static_cast<size_t>(nBlockXSize) * nYSizeRequest, false);
+            }
+            else
+            {
+                for (int iY = 0; iY < nYSizeRequest; iY++)
+                {
+                    const size_t nOffset =
+                        static_cast<size_t>(iY) * nBlockXSize;
+                    GDALComputeNoDataMask(
+                        pabySrc + nOffset * nDTSize, eParentDT,
+                        m_dfNoDataValue,
+                        static_cast<GByte *>(pImage) + nOffset, nXSizeRequest,
+                        false);
+                }
+            }
+            poBlock->DropLock();
+            return CE_None;
+        }
+    }
+
     GDALRasterIOExtraArg sExtraArg;
     INIT_RASTERIO_EXTRA_ARG(sExtraArg);
     return IRasterIO(GF_Read, nXOff, nYOff, nXSizeRequest, nYSizeRequest,
@@ -259,9 +575,16 @@ CPLErr GDALNoDataMaskBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         if (nPixelSpace == 1 && nLineSpace == nBufXSize)
         {
             const size_t nBufSize = static_cast<size_t>(nBufXSize) * nBufYSize;
-            for (size_t i = 0; i < nBufSize; ++i)
+            GDALComputeNoDataMask(pabyData, GDT_Byte, m_dfNoDataValue,
+                                  pabyData, nBufSize, false);
+        }
+        else if (nPixelSpace == 1)
+        {
+            for (int iY = 0; iY < nBufYSize; iY++)
             {
-                pabyData[i] = pabyData[i] == byNoData ? 0 : 255;
+                GByte *pabyLine = pabyData + iY * nLineSpace;
+                GDALComputeNoDataMask(pabyLine, GDT_Byte, m_dfNoDataValue,
+                                      pabyLine, nBufXSize, false);
             }
         }
         else
@@ -286,9 +609,8 @@ CPLErr GDALNoDataMaskBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         if (pTemp == nullptr)
         {
             return GDALRasterBand::IRasterIO(
-                eRWFlag, nXOff, nYOff, nXSize, nYSize, pTemp, nBufXSize,
-                nBufYSize, eWrkDT, nWrkDTSize,
-                static_cast<GSpacing>(nBufXSize) * nWrkDTSize, psExtraArg);
+                eRWFlag, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize,
+                nBufYSize, eBufType, nPixelSpace, nLineSpace, psExtraArg);
         }
 
         const CPLErr eErr = m_poParent->RasterIO(
@@ -301,7 +623,6 @@ CPLErr GDALNoDataMaskBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
             return eErr;
         }
 
-        const bool bIsNoDataNan = CPLIsNan(m_dfNoDataValue) != 0;
         GByte *pabyDest = static_cast<GByte *>(pData);
 
         /* --------------------------------------------------------------------
@@ -312,87 +633,29 @@ CPLErr GDALNoDataMaskBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         switch (eWrkDT)
         {
             case GDT_UInt32:
-            {
-                const GUInt32 nNoData = static_cast<GUInt32>(m_dfNoDataValue);
-                const GUInt32 *panSrc = static_cast<const GUInt32 *>(pTemp);
-
-                size_t i = 0;
-                for (int iY = 0; iY < nBufYSize; iY++)
-                {
-                    GByte *pabyLineDest = pabyDest + iY * nLineSpace;
-                    for (int iX = 0; iX < nBufXSize; iX++)
-                    {
-                        *pabyLineDest = panSrc[i] == nNoData ? 0 : 255;
-                        ++i;
-                        pabyLineDest += nPixelSpace;
-                    }
-                }
-            }
-            break;
-
             case GDT_Int32:
-            {
-                const GInt32 nNoData = static_cast<GInt32>(m_dfNoDataValue);
-                const GInt32 *panSrc = static_cast<const GInt32 *>(pTemp);
-
-                size_t i = 0;
-                for (int iY = 0; iY < nBufYSize; iY++)
-                {
-                    GByte *pabyLineDest = pabyDest + iY * nLineSpace;
-                    for (int iX = 0; iX < nBufXSize; iX++)
-                    {
-                        *pabyLineDest = panSrc[i] == nNoData ? 0 : 255;
-                        ++i;
-                        pabyLineDest += nPixelSpace;
-                    }
-                }
-            }
-            break;
-
             case GDT_Float32:
-            {
-                const float fNoData = static_cast<float>(m_dfNoDataValue);
-                const float *pafSrc = static_cast<const float *>(pTemp);
-
-                size_t i = 0;
-                for (int iY = 0; iY < nBufYSize; iY++)
-                {
-                    GByte *pabyLineDest = pabyDest + iY * nLineSpace;
-                    for (int iX = 0; iX < nBufXSize; iX++)
-                    {
-                        const float fVal = pafSrc[i];
-                        if (bIsNoDataNan && CPLIsNan(fVal))
-                            *pabyLineDest = 0;
-                        else if (ARE_REAL_EQUAL(fVal, fNoData))
-                            *pabyLineDest = 0;
-                        else
-                            *pabyLineDest = 255;
-                        ++i;
-                        pabyLineDest += nPixelSpace;
-                    }
-                }
-            }
-            break;
-
             case GDT_Float64:
             {
-                const double *padfSrc = static_cast<const double *>(pTemp);
-
-                size_t i = 0;
+                std::vector<GByte> abyLine;
+                if (nPixelSpace != 1)
+                    abyLine.resize(nBufXSize);
                 for (int iY = 0; iY < nBufYSize; iY++)
                 {
                     GByte *pabyLineDest = pabyDest + iY * nLineSpace;
-                    for (int iX = 0; iX < nBufXSize; iX++)
+                    GDALComputeNoDataMask(
+                        static_cast<const GByte *>(pTemp) +
+                            static_cast<size_t>(iY) * nBufXSize * nWrkDTSize,
+                        eWrkDT, m_dfNoDataValue,
+                        nPixelSpace == 1 ? pabyLineDest : abyLine.data(),
+                        nBufXSize, false);
+                    if (nPixelSpace != 1)
                     {
-                        const double dfVal = padfSrc[i];
-                        if (bIsNoDataNan && CPLIsNan(dfVal))
-                            *pabyLineDest = 0;
-                        else if (ARE_REAL_EQUAL(dfVal, m_dfNoDataValue))
-                            *pabyLineDest = 0;
-                        else
-                            *pabyLineDest = 255;
-                        ++i;
-                        pabyLineDest += nPixelSpace;
+                        for (int iX = 0; iX < nBufXSize; iX++)
+                        {
+                            *pabyLineDest = abyLine[iX];
+                            pabyLineDest += nPixelSpace;
+                        }
                     }
                 }
             }
@@ -81,36 +81,6 @@ GDALNoDataValuesMaskBand::~GDALNoDataValuesMaskBand()
     CPLFree(padfNodataValues);
 }
 
-/************************************************************************/
-/*                            FillOutBuffer()                           */
-/************************************************************************/
-
-template <class T>
-static void FillOutBuffer(GPtrDiff_t nBlockOffsetPixels, int nBands,
-                          const void *pabySrc, const double *padfNodataValues,
-                          void *pImage)
-{
-    T *paNoData = static_cast<T *>(CPLMalloc(nBands * sizeof(T)));
-    for (int iBand = 0; iBand < nBands; ++iBand)
-    {
-        paNoData[iBand] = static_cast<T>(padfNodataValues[iBand]);
-    }
-
-    for (GPtrDiff_t i = 0; i < nBlockOffsetPixels; i++)
-    {
-        int nCountNoData = 0;
-        for (int iBand = 0; iBand < nBands; ++iBand)
-        {
-            if (static_cast<const T *>(
-                    pabySrc)[i + iBand * nBlockOffsetPixels] == paNoData[iBand])
-                ++nCountNoData;
-        }
-        static_cast<GByte *>(pImage)[i] = nCountNoData == nBands ? 0 : 255;
-    }
-
-    CPLFree(paNoData);
-}
-
 /************************************************************************/
 /*                             IReadBlock()                             */
 /************************************************************************/
@@ -202,52 +172,22 @@ CPLErr GDALNoDataValuesMaskBand::IReadBlock(int nXBlockOff, int nYBlockOff,
             nXSizeRequest, nYSizeRequest, eWrkDT, 0,
             static_cast<GSpacing>(nBlockXSize) * nWrkDTSize, nullptr);
         if (eErr != CE_None)
+        {
+            CPLFree(pabySrc);
             return eErr;
+        }
     }
 
     /* -------------------------------------------------------------------- */
-    /*      Process different cases.                                        */
+    /*      A pixel is masked if it is nodata in all bands.                 */
     /* -------------------------------------------------------------------- */
-    switch (eWrkDT)
+    for (int iBand = 0; iBand < nBands; ++iBand)
     {
-        case GDT_Byte:
-        {
-            FillOutBuffer<GByte>(nBlockOffsetPixels, nBands, pabySrc,
-                                 padfNodataValues, pImage);
-        }
-        break;
-
-        case GDT_UInt32:
-        {
-            FillOutBuffer<GUInt32>(nBlockOffsetPixels, nBands, pabySrc,
-                                   padfNodataValues, pImage);
-        }
-        break;
-
-        case GDT_Int32:
-        {
-            FillOutBuffer<GInt32>(nBlockOffsetPixels, nBands, pabySrc,
-                                  padfNodataValues, pImage);
-        }
-        break;
-
-        case GDT_Float32:
-        {
-            FillOutBuffer<float>(nBlockOffsetPixels, nBands, pabySrc,
-                                 padfNodataValues, pImage);
-        }
-        break;
-
-        case GDT_Float64:
-        {
-            FillOutBuffer<double>(nBlockOffsetPixels, nBands, pabySrc,
-                                  padfNodataValues, pImage);
-        }
-        break;
-
-        default:
-            CPLAssert(false);
-            break;
+        GDALComputeNoDataMask(pabySrc + iBand * nBandOffsetByte, eWrkDT,
+                              padfNodataValues[iBand],
+                              static_cast<GByte *>(pImage),
+                              static_cast<size_t>(nBlockOffsetPixels),
+                              iBand > 0);
     }
 
     CPLFree(pabySrc);
@@ -346,6 +346,13 @@ retry:  // TODO(schwehr): Stop using goto.
         papszSiblingFiles = CSLDuplicate(papszSiblingsIn);
         bHasGotSiblingFiles = true;
     }
+    else if ((nOpenFlags & GDAL_OF_HEADER_ONLY) && bStatOK && !bIsDirectory)
+    {
+        // Pretend that the file is alone in its directory, so that drivers
+        // do not look for side-car files.
+        papszSiblingFiles = CSLAddString(nullptr, CPLGetFilename(pszFilename));
+        bHasGotSiblingFiles = true;
+    }
     else if (bStatOK && !bIsDirectory)
     {
         papszSiblingFiles = VSISiblingFiles(pszFilename);
@@ -917,7 +917,7 @@ CPLErr GDALPamDataset::TryLoadXML(char **papszSiblingFiles)
     /*      stat'ing the filesystem.                                        */
     /* -------------------------------------------------------------------- */
     VSIStatBufL sStatBuf;
-    CPLXMLNode *psTree = nullptr;
+    CPLXMLArenaTree oTree;
 
     if (papszSiblingFiles != nullptr && IsPamFilenameAPotentialSiblingFile() &&
         GDALCanReliablyUseSiblingFileList(psPam->pszPamFilename))
@@ -928,7 +928,7 @@ CPLErr GDALPamDataset::TryLoadXML(char **papszSiblingFiles)
         {
             CPLErrorStateBackuper oErrorStateBackuper;
             CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
-            psTree = CPLParseXMLFile(psPam->pszPamFilename);
+            oTree.ParseFile(psPam->pszPamFilename);
         }
     }
     else if (VSIStatExL(psPam->pszPamFilename, &sStatBuf,
@@ -937,8 +937,9 @@ CPLErr GDALPamDataset::TryLoadXML(char **papszSiblingFiles)
     {
         CPLErrorStateBackuper oErrorStateBackuper;
         CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
-        psTree = CPLParseXMLFile(psPam->pszPamFilename);
+        oTree.ParseFile(psPam->pszPamFilename);
     }
+    CPLXMLNode *psTree = oTree.get();
 
     /* -------------------------------------------------------------------- */
     /*      If we are looking for a subdataset, search for its subtree now. */
@@ -975,10 +976,8 @@ CPLErr GDALPamDataset::TryLoadXML(char **papszSiblingFiles)
                 break;
             }
 
-            if (psSubTree != nullptr)
-                psSubTree = CPLCloneXMLTree(psSubTree);
-
-            CPLDestroyXMLNode(psTree);
+            // XMLInit() only reads the tree, so no need to clone the
+            // subtree out of the arena.
             psTree = psSubTree;
         }
     }
@@ -996,8 +995,6 @@ CPLErr GDALPamDataset::TryLoadXML(char **papszSiblingFiles)
     CPLString osVRTPath(CPLGetPath(psPam->pszPamFilename));
     const CPLErr eErr = XMLInit(psTree, osVRTPath);
 
-    CPLDestroyXMLNode(psTree);
-
     if (eErr != CE_None)
         PamClear();
 
@@ -1017,6 +1014,11 @@ CPLErr GDALPamDataset::TrySaveXML()
         (nPamFlags & GPF_DISABLED) != 0)
         return CE_None;
 
+    // The existing PAM file has not been read, so do not overwrite it.
+    if (nOpenFlags != OPEN_FLAGS_CLOSED &&
+        (nOpenFlags & GDAL_OF_HEADER_ONLY) != 0)
+        return CE_None;
+
     /* -------------------------------------------------------------------- */
     /*      Make sure we know the filename we want to store in.             */
     /* -------------------------------------------------------------------- */
@@ -214,6 +214,12 @@ D_PROXY_METHOD_WITH_RET(CPLErr, CE_Failure, AdviseRead,
                          int nBandCount, int *panBandList, char **papszOptions),
                         (nXOff, nYOff, nXSize, nYSize, nBufXSize, nBufYSize,
                          eDT, nBandCount, panBandList, papszOptions))
+D_PROXY_METHOD_WITH_RET(CPLErr, CE_Failure, AdviseReadPlan,
+                        (int nWindowCount, const GDALRasterWindow *pasWindows,
+                         int nBandCount, const int *panBandList,
+                         CSLConstList papszOptions),
+                        (nWindowCount, pasWindows, nBandCount, panBandList,
+                         papszOptions))
 D_PROXY_METHOD_WITH_RET(CPLErr, CE_Failure, CreateMaskBand, (int nFlagsIn),
                         (nFlagsIn))
 
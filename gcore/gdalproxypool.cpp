@@ -31,9 +31,12 @@
 #include "gdal_proxy.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <optional>
+#include <utility>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -55,7 +58,11 @@
 /* ******************************************************************** */
 
 /* This class is a singleton that maintains a pool of opened datasets */
-/* The cache uses a LRU strategy */
+/* The cache uses a CLOCK strategy (approximation of LRU): each use of an */
+/* entry sets its reference bit, and the eviction hand sweeps the entries, */
+/* clearing the reference bits, until it finds an unused entry whose bit is */
+/* cleared. Contrary to a strict LRU, using an entry does not require to */
+/* reorder the list. */
 
 class GDALDatasetPool;
 static GDALDatasetPool *singleton = nullptr;
@@ -67,17 +74,26 @@ void GDALNullifyProxyPoolSingleton()
 
 struct _GDALProxyPoolCacheEntry
 {
-    GIntBig responsiblePID;
-    char *pszFileNameAndOpenOptions;
-    char *pszOwner;
-    GDALDataset *poDS;
-    GIntBig nRAMUsage;
+    GIntBig responsiblePID = 0;
+    char *pszFileNameAndOpenOptions = nullptr;
+    char *pszOwner = nullptr;
+    GDALDataset *poDS = nullptr;
+    GIntBig nRAMUsage = 0;
 
-    /* Ref count of the cached dataset */
-    int refCount;
+    /* Ref count of the cached dataset. Set to -1 while the entry is being */
+    /* evicted or closed, so that GDALDatasetPool::TryRefEntry() cannot */
+    /* take a reference on it. */
+    std::atomic<int> refCount{0};
 
-    GDALProxyPoolCacheEntry *prev;
-    GDALProxyPoolCacheEntry *next;
+    /* Incremented each time the dataset of the entry is closed, so that */
+    /* proxies can check that the entry they used last is still theirs. */
+    std::atomic<GUInt32> nGeneration{0};
+
+    /* CLOCK reference bit */
+    std::atomic<bool> bReferenced{false};
+
+    GDALProxyPoolCacheEntry *prev = nullptr;
+    GDALProxyPoolCacheEntry *next = nullptr;
 };
 
 class GDALDatasetPool
@@ -99,6 +115,7 @@ class GDALDatasetPool
     int64_t nRAMUsage = 0;
     GDALProxyPoolCacheEntry *firstEntry = nullptr;
     GDALProxyPoolCacheEntry *lastEntry = nullptr;
+    GDALProxyPoolCacheEntry *clockHand = nullptr;
 
     /* This variable prevents a dataset that is going to be opened in
      * GDALDatasetPool::_RefDataset */
@@ -142,6 +159,8 @@ class GDALDatasetPool
                                                char **papszOpenOptions,
                                                int bShared, bool bForceOpen,
                                                const char *pszOwner);
+    static bool TryRefEntry(GDALProxyPoolCacheEntry *cacheEntry,
+                            GUInt32 nGeneration, bool bShared);
     static void UnrefDataset(GDALProxyPoolCacheEntry *cacheEntry);
     static void CloseDatasetIfZeroRefCount(const char *pszFileName,
                                            CSLConstList papszOpenOptions,
@@ -181,7 +200,7 @@ GDALDatasetPool::~GDALDatasetPool()
             GDALSetResponsiblePIDForCurrentThread(cur->responsiblePID);
             GDALClose(cur->poDS);
         }
-        CPLFree(cur);
+        delete cur;
         cur = next;
     }
     GDALSetResponsiblePIDForCurrentThread(responsiblePID);
@@ -203,7 +222,7 @@ void GDALDatasetPool::ShowContent()
                i,
                cur->pszFileNameAndOpenOptions ? cur->pszFileNameAndOpenOptions
                                               : "(null)",
-               cur->pszOwner ? cur->pszOwner : "(null)", cur->refCount,
+               cur->pszOwner ? cur->pszOwner : "(null)", cur->refCount.load(),
                (int)cur->responsiblePID);
         i++;
         cur = cur->next;
@@ -261,25 +280,38 @@ GDALDatasetPool::_RefDataset(const char *pszFileName, GDALAccess eAccess,
 
     const GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
 
+    // Find an entry with a zero ref count with the CLOCK algorithm, close
+    // its dataset, and return it with a ref count of -1. Return nullptr if
+    // all entries are in use.
     const auto EvictEntryWithZeroRefCount =
         [this, responsiblePID](bool evictEntryWithOpenedDataset)
     {
-        GDALProxyPoolCacheEntry *cur = firstEntry;
         GDALProxyPoolCacheEntry *candidate = nullptr;
-        while (cur)
+        // Two rounds are enough to clear all the reference bits and find
+        // a candidate, if there is one.
+        for (int i = 0; i < 2 * currentSize && candidate == nullptr; ++i)
         {
-            GDALProxyPoolCacheEntry *next = cur->next;
+            GDALProxyPoolCacheEntry *cur = clockHand ? clockHand : firstEntry;
+            clockHand = cur->next;
 
-            if (cur->refCount == 0 &&
-                (!evictEntryWithOpenedDataset || cur->nRAMUsage > 0))
+            if (!evictEntryWithOpenedDataset || cur->nRAMUsage > 0)
             {
-                candidate = cur;
+                if (cur->bReferenced)
+                {
+                    cur->bReferenced = false;
+                }
+                else
+                {
+                    int expected = 0;
+                    if (cur->refCount.compare_exchange_strong(expected, -1))
+                        candidate = cur;
+                }
             }
-
-            cur = next;
         }
         if (candidate == nullptr)
-            return false;
+            return candidate;
+
+        candidate->nGeneration++;
 
         nRAMUsage -= candidate->nRAMUsage;
         candidate->nRAMUsage = 0;
@@ -303,32 +335,7 @@ GDALDatasetPool::_RefDataset(const char *pszFileName, GDALAccess eAccess,
         CPLFree(candidate->pszOwner);
         candidate->pszOwner = nullptr;
 
-        if (!evictEntryWithOpenedDataset && candidate != firstEntry)
-        {
-            /* Recycle this entry for the to-be-opened dataset and */
-            /* moves it to the top of the list */
-            if (candidate->prev)
-                candidate->prev->next = candidate->next;
-
-            if (candidate->next)
-                candidate->next->prev = candidate->prev;
-            else
-            {
-                CPLAssert(candidate == lastEntry);
-                lastEntry->prev->next = nullptr;
-                lastEntry = lastEntry->prev;
-            }
-            candidate->prev = nullptr;
-            candidate->next = firstEntry;
-            firstEntry->prev = candidate;
-            firstEntry = candidate;
-
-#ifdef DEBUG_PROXY_POOL
-            CheckLinks();
-#endif
-        }
-
-        return true;
+        return candidate;
     };
 
     GDALProxyPoolCacheEntry *cur = firstEntry;
@@ -348,26 +355,14 @@ GDALDatasetPool::_RefDataset(const char *pszFileName, GDALAccess eAccess,
                 strcmp(cur->pszOwner, pszOwner) == 0))) ||
              (!bShared && cur->refCount == 0)))
         {
-            if (cur != firstEntry)
+            // A non-shared dataset can only be used by one proxy at a time
+            int expected = bShared ? cur->refCount.load() : 0;
+            if (expected >= 0 &&
+                cur->refCount.compare_exchange_strong(expected, expected + 1))
             {
-                /* Move to begin */
-                if (cur->next)
-                    cur->next->prev = cur->prev;
-                else
-                    lastEntry = cur->prev;
-                cur->prev->next = cur->next;
-                cur->prev = nullptr;
-                firstEntry->prev = cur;
-                cur->next = firstEntry;
-                firstEntry = cur;
-
-#ifdef DEBUG_PROXY_POOL
-                CheckLinks();
-#endif
+                cur->bReferenced = true;
+                return cur;
             }
-
-            cur->refCount++;
-            return cur;
         }
 
         cur = next;
@@ -378,7 +373,8 @@ GDALDatasetPool::_RefDataset(const char *pszFileName, GDALAccess eAccess,
 
     if (currentSize == maxSize)
     {
-        if (!EvictEntryWithZeroRefCount(false))
+        cur = EvictEntryWithZeroRefCount(false);
+        if (cur == nullptr)
         {
             CPLError(
                 CE_Failure, CPLE_AppDefined,
@@ -389,15 +385,11 @@ GDALDatasetPool::_RefDataset(const char *pszFileName, GDALAccess eAccess,
                 maxSize);
             return nullptr;
         }
-
-        CPLAssert(firstEntry);
-        cur = firstEntry;
     }
     else
     {
         /* Prepend */
-        cur = static_cast<GDALProxyPoolCacheEntry *>(
-            CPLCalloc(1, sizeof(GDALProxyPoolCacheEntry)));
+        cur = new GDALProxyPoolCacheEntry();
         if (lastEntry == nullptr)
             lastEntry = cur;
         cur->prev = nullptr;
@@ -416,6 +408,7 @@ GDALDatasetPool::_RefDataset(const char *pszFileName, GDALAccess eAccess,
     cur->responsiblePID = responsiblePID;
     cur->refCount = 1;
     cur->nRAMUsage = 0;
+    cur->bReferenced = true;
 
     refCountOfDisableRefCount++;
     int nFlag = ((eAccess == GA_Update) ? GDAL_OF_UPDATE : GDAL_OF_READONLY) |
@@ -434,10 +427,12 @@ GDALDatasetPool::_RefDataset(const char *pszFileName, GDALAccess eAccess,
 
     if (nMaxRAMUsage > 0 && cur->nRAMUsage > 0)
     {
-        while (nRAMUsage > nMaxRAMUsage && nRAMUsage != cur->nRAMUsage &&
-               EvictEntryWithZeroRefCount(true))
+        while (nRAMUsage > nMaxRAMUsage && nRAMUsage != cur->nRAMUsage)
         {
-            // ok
+            GDALProxyPoolCacheEntry *evicted = EvictEntryWithZeroRefCount(true);
+            if (evicted == nullptr)
+                break;
+            evicted->refCount = 0;
         }
     }
 
@@ -474,6 +469,12 @@ void GDALDatasetPool::_CloseDatasetIfZeroRefCount(const char *pszFileName,
               strcmp(cur->pszOwner, pszOwner) == 0)) &&
             cur->poDS != nullptr)
         {
+            // Prevent GDALDatasetPool::TryRefEntry() from using the entry
+            int expected = 0;
+            if (!cur->refCount.compare_exchange_strong(expected, -1))
+                break;
+            cur->nGeneration++;
+
             /* Close by pretending we are the thread that GDALOpen'ed this */
             /* dataset */
             GDALSetResponsiblePIDForCurrentThread(cur->responsiblePID);
@@ -493,6 +494,8 @@ void GDALDatasetPool::_CloseDatasetIfZeroRefCount(const char *pszFileName,
             GDALClose(poDS);
             refCountOfDisableRefCount--;
 
+            cur->refCount = 0;
+
             GDALSetResponsiblePIDForCurrentThread(responsiblePID);
             break;
         }
@@ -618,10 +621,40 @@ GDALDatasetPool::RefDataset(const char *pszFileName, GDALAccess eAccess,
 
 void GDALDatasetPool::UnrefDataset(GDALProxyPoolCacheEntry *cacheEntry)
 {
-    CPLMutexHolderD(GDALGetphDLMutex());
+    // No need to take the mutex, as refCount is atomic, and an entry cannot
+    // be evicted while its refCount is not zero.
     cacheEntry->refCount--;
 }
 
+/************************************************************************/
+/*                           TryRefEntry()                              */
+/************************************************************************/
+
+/* Fast path of RefDataset() that does not take the pool mutex: try to take */
+/* a reference on the entry a proxy used last, provided it has not been */
+/* evicted or closed since then (which is checked with nGeneration), and */
+/* still has an opened dataset. */
+bool GDALDatasetPool::TryRefEntry(GDALProxyPoolCacheEntry *cacheEntry,
+                                  GUInt32 nGeneration, bool bShared)
+{
+    int expected = bShared ? cacheEntry->refCount.load() : 0;
+    do
+    {
+        if (expected < 0 || (!bShared && expected != 0))
+            return false;
+    } while (
+        !cacheEntry->refCount.compare_exchange_weak(expected, expected + 1));
+
+    if (cacheEntry->nGeneration != nGeneration || cacheEntry->poDS == nullptr)
+    {
+        // The entry has been reused for another dataset in the meantime
+        cacheEntry->refCount--;
+        return false;
+    }
+    cacheEntry->bReferenced = true;
+    return true;
+}
+
 /************************************************************************/
 /*                   CloseDatasetIfZeroRefCount()                       */
 /************************************************************************/
@@ -696,6 +729,31 @@ static void free_func_get_metadata_item(void *_elt)
     CPLFree(elt);
 }
 
+/* In read-only mode, the metadata of the underlying objects is assumed not */
+/* to change, so that the proxies can serve it from their own copy without */
+/* re-opening the underlying dataset. */
+
+static GetMetadataElt *LookupMetadata(CPLHashSet *metadataSet,
+                                      const char *pszDomain)
+{
+    GetMetadataElt sElt;
+    sElt.pszDomain = const_cast<char *>(pszDomain);
+    sElt.papszMetadata = nullptr;
+    return static_cast<GetMetadataElt *>(CPLHashSetLookup(metadataSet, &sElt));
+}
+
+static GetMetadataItemElt *LookupMetadataItem(CPLHashSet *metadataItemSet,
+                                              const char *pszName,
+                                              const char *pszDomain)
+{
+    GetMetadataItemElt sElt;
+    sElt.pszName = const_cast<char *>(pszName);
+    sElt.pszDomain = const_cast<char *>(pszDomain);
+    sElt.pszMetadataItem = nullptr;
+    return static_cast<GetMetadataItemElt *>(
+        CPLHashSetLookup(metadataItemSet, &sElt));
+}
+
 /* ******************************************************************** */
 /*                     GDALProxyPoolDataset                             */
 /* ******************************************************************** */
@@ -925,6 +983,13 @@ GDALDataset *GDALProxyPoolDataset::RefUnderlyingDataset(bool bForceOpen) const
     /* To make a long story short : this is necessary when warping with
      * ChunkAndWarpMulti */
     /* a VRT of GeoTIFFs that have associated .aux files */
+    if (cacheEntry != nullptr &&
+        GDALDatasetPool::TryRefEntry(cacheEntry, m_nCacheEntryGeneration,
+                                     GetShared()))
+    {
+        return cacheEntry->poDS;
+    }
+
     GIntBig curResponsiblePID = GDALGetResponsiblePIDForCurrentThread();
     GDALSetResponsiblePIDForCurrentThread(responsiblePID);
     cacheEntry =
@@ -934,7 +999,10 @@ GDALDataset *GDALProxyPoolDataset::RefUnderlyingDataset(bool bForceOpen) const
     if (cacheEntry != nullptr)
     {
         if (cacheEntry->poDS != nullptr)
+        {
+            m_nCacheEntryGeneration = cacheEntry->nGeneration;
             return cacheEntry->poDS;
+        }
         else
             GDALDatasetPool::UnrefDataset(cacheEntry);
     }
@@ -979,6 +1047,7 @@ CPLErr GDALProxyPoolDataset::FlushCache(bool bAtClosing)
 CPLErr GDALProxyPoolDataset::SetSpatialRef(const OGRSpatialReference *poSRS)
 {
     m_bHasSrcSRS = false;
+    m_bSRSFetched = false;
     return GDALProxyDataset::SetSpatialRef(poSRS);
 }
 
@@ -988,16 +1057,22 @@ CPLErr GDALProxyPoolDataset::SetSpatialRef(const OGRSpatialReference *poSRS)
 
 const OGRSpatialReference *GDALProxyPoolDataset::GetSpatialRef() const
 {
-    if (m_bHasSrcSRS)
+    if (m_bHasSrcSRS || m_bSRSFetched)
         return m_poSRS;
     else
     {
         if (m_poSRS)
             m_poSRS->Release();
         m_poSRS = nullptr;
-        auto poSRS = GDALProxyDataset::GetSpatialRef();
+        GDALDataset *poUnderlyingDataset = RefUnderlyingDataset();
+        if (poUnderlyingDataset == nullptr)
+            return nullptr;
+        auto poSRS = poUnderlyingDataset->GetSpatialRef();
         if (poSRS)
             m_poSRS = poSRS->Clone();
+        // In read-only mode, snapshot the SRS
+        m_bSRSFetched = eAccess == GA_ReadOnly;
+        UnrefUnderlyingDataset(poUnderlyingDataset);
         return m_poSRS;
     }
 }
@@ -1009,6 +1084,7 @@ const OGRSpatialReference *GDALProxyPoolDataset::GetSpatialRef() const
 CPLErr GDALProxyPoolDataset::SetGeoTransform(double *padfGeoTransform)
 {
     bHasSrcGeoTransform = false;
+    m_bGeoTransformFetched = false;
     return GDALProxyDataset::SetGeoTransform(padfGeoTransform);
 }
 
@@ -1023,9 +1099,30 @@ CPLErr GDALProxyPoolDataset::GetGeoTransform(double *padfGeoTransform)
         memcpy(padfGeoTransform, adfGeoTransform, 6 * sizeof(double));
         return CE_None;
     }
+    else if (m_bGeoTransformFetched)
+    {
+        // The underlying dataset has no geotransform
+        return GDALDataset::GetGeoTransform(padfGeoTransform);
+    }
     else
     {
-        return GDALProxyDataset::GetGeoTransform(padfGeoTransform);
+        GDALDataset *poUnderlyingDataset = RefUnderlyingDataset();
+        if (poUnderlyingDataset == nullptr)
+            return CE_Failure;
+        const CPLErr eErr =
+            poUnderlyingDataset->GetGeoTransform(padfGeoTransform);
+        UnrefUnderlyingDataset(poUnderlyingDataset);
+        if (eAccess == GA_ReadOnly)
+        {
+            // In read-only mode, snapshot the geotransform
+            m_bGeoTransformFetched = true;
+            if (eErr == CE_None)
+            {
+                memcpy(adfGeoTransform, padfGeoTransform, 6 * sizeof(double));
+                bHasSrcGeoTransform = true;
+            }
+        }
+        return eErr;
     }
 }
 
@@ -1039,6 +1136,11 @@ char **GDALProxyPoolDataset::GetMetadata(const char *pszDomain)
         metadataSet =
             CPLHashSetNew(hash_func_get_metadata, equal_func_get_metadata,
                           free_func_get_metadata);
+    else if (eAccess == GA_ReadOnly)
+    {
+        if (const auto pElt = LookupMetadata(metadataSet, pszDomain))
+            return pElt->papszMetadata;
+    }
 
     GDALDataset *poUnderlyingDataset = RefUnderlyingDataset();
     if (poUnderlyingDataset == nullptr)
@@ -1069,6 +1171,12 @@ const char *GDALProxyPoolDataset::GetMetadataItem(const char *pszName,
         metadataItemSet = CPLHashSetNew(hash_func_get_metadata_item,
                                         equal_func_get_metadata_item,
                                         free_func_get_metadata_item);
+    else if (eAccess == GA_ReadOnly)
+    {
+        if (const auto pElt =
+                LookupMetadataItem(metadataItemSet, pszName, pszDomain))
+            return pElt->pszMetadataItem;
+    }
 
     GDALDataset *poUnderlyingDataset = RefUnderlyingDataset();
     if (poUnderlyingDataset == nullptr)
@@ -1091,6 +1199,35 @@ const char *GDALProxyPoolDataset::GetMetadataItem(const char *pszName,
     return pElt->pszMetadataItem;
 }
 
+/************************************************************************/
+/*                            SetMetadata()                             */
+/************************************************************************/
+
+CPLErr GDALProxyPoolDataset::SetMetadata(char **papszMetadata,
+                                         const char *pszDomain)
+{
+    if (metadataSet)
+        CPLHashSetClear(metadataSet);
+    if (metadataItemSet)
+        CPLHashSetClear(metadataItemSet);
+    return GDALProxyDataset::SetMetadata(papszMetadata, pszDomain);
+}
+
+/************************************************************************/
+/*                          SetMetadataItem()                           */
+/************************************************************************/
+
+CPLErr GDALProxyPoolDataset::SetMetadataItem(const char *pszName,
+                                             const char *pszValue,
+                                             const char *pszDomain)
+{
+    if (metadataSet)
+        CPLHashSetClear(metadataSet);
+    if (metadataItemSet)
+        CPLHashSetClear(metadataItemSet);
+    return GDALProxyDataset::SetMetadataItem(pszName, pszValue, pszDomain);
+}
+
 /************************************************************************/
 /*                      GetInternalHandle()                             */
 /************************************************************************/
@@ -1110,16 +1247,21 @@ void *GDALProxyPoolDataset::GetInternalHandle(const char *pszRequest)
 
 const OGRSpatialReference *GDALProxyPoolDataset::GetGCPSpatialRef() const
 {
+    if (m_bGCPSRSFetched)
+        return m_poGCPSRS;
+
     GDALDataset *poUnderlyingDataset = RefUnderlyingDataset();
     if (poUnderlyingDataset == nullptr)
         return nullptr;
 
-    m_poGCPSRS->Release();
+    if (m_poGCPSRS)
+        m_poGCPSRS->Release();
     m_poGCPSRS = nullptr;
 
     const auto poUnderlyingGCPSRS = poUnderlyingDataset->GetGCPSpatialRef();
     if (poUnderlyingGCPSRS)
         m_poGCPSRS = poUnderlyingGCPSRS->Clone();
+    m_bGCPSRSFetched = eAccess == GA_ReadOnly;
 
     UnrefUnderlyingDataset(poUnderlyingDataset);
 
@@ -1132,6 +1274,9 @@ const OGRSpatialReference *GDALProxyPoolDataset::GetGCPSpatialRef() const
 
 const GDAL_GCP *GDALProxyPoolDataset::GetGCPs()
 {
+    if (m_bGCPsFetched)
+        return pasGCPList;
+
     GDALDataset *poUnderlyingDataset = RefUnderlyingDataset();
     if (poUnderlyingDataset == nullptr)
         return nullptr;
@@ -1147,12 +1292,40 @@ const GDAL_GCP *GDALProxyPoolDataset::GetGCPs()
     nGCPCount = poUnderlyingDataset->GetGCPCount();
     if (nGCPCount)
         pasGCPList = GDALDuplicateGCPs(nGCPCount, pasUnderlyingGCPList);
+    m_bGCPsFetched = eAccess == GA_ReadOnly;
 
     UnrefUnderlyingDataset(poUnderlyingDataset);
 
     return pasGCPList;
 }
 
+/************************************************************************/
+/*                            GetGCPCount()                             */
+/************************************************************************/
+
+int GDALProxyPoolDataset::GetGCPCount()
+{
+    if (eAccess == GA_ReadOnly)
+    {
+        GetGCPs();
+        return nGCPCount;
+    }
+    return GDALProxyDataset::GetGCPCount();
+}
+
+/************************************************************************/
+/*                              SetGCPs()                               */
+/************************************************************************/
+
+CPLErr GDALProxyPoolDataset::SetGCPs(int nGCPCountIn,
+                                     const GDAL_GCP *pasGCPListIn,
+                                     const OGRSpatialReference *poGCP_SRS)
+{
+    m_bGCPsFetched = false;
+    m_bGCPSRSFetched = false;
+    return GDALProxyDataset::SetGCPs(nGCPCountIn, pasGCPListIn, poGCP_SRS);
+}
+
 /************************************************************************/
 /*                     GDALProxyPoolDatasetCreate()                     */
 /************************************************************************/
@@ -1188,6 +1361,26 @@ void GDALProxyPoolDatasetAddSrcBandDescription(
         ->AddSrcBandDescription(eDataType, nBlockXSize, nBlockYSize);
 }
 
+/* ******************************************************************** */
+/*                   GDALProxyPoolRasterBand::Snapshot                  */
+/* ******************************************************************** */
+
+struct GDALProxyPoolRasterBand::Snapshot
+{
+    bool bCategoryNamesFetched = false;
+    bool bUnitTypeFetched = false;
+    bool bColorTableFetched = false;
+
+    // Value and success flag
+    std::optional<std::pair<double, int>> noData{};
+    std::optional<std::pair<double, int>> offset{};
+    std::optional<std::pair<double, int>> scale{};
+
+    std::optional<GDALColorInterp> eColorInterp{};
+    std::optional<int> nOverviewCount{};
+    std::optional<int> nMaskFlags{};
+};
+
 /* ******************************************************************** */
 /*                    GDALProxyPoolRasterBand()                         */
 /* ******************************************************************** */
@@ -1246,6 +1439,34 @@ GDALProxyPoolRasterBand::~GDALProxyPoolRasterBand()
         delete poProxyMaskBand;
 }
 
+/************************************************************************/
+/*                            GetSnapshot()                             */
+/************************************************************************/
+
+/* Return the snapshot of the properties of the underlying band, or nullptr */
+/* in update mode, where they may change. */
+GDALProxyPoolRasterBand::Snapshot *GDALProxyPoolRasterBand::GetSnapshot()
+{
+    if (poDS->GetAccess() != GA_ReadOnly)
+        return nullptr;
+    if (!m_poSnapshot)
+        m_poSnapshot = std::make_unique<Snapshot>();
+    return m_poSnapshot.get();
+}
+
+/************************************************************************/
+/*                         InvalidateSnapshot()                         */
+/************************************************************************/
+
+void GDALProxyPoolRasterBand::InvalidateSnapshot()
+{
+    m_poSnapshot.reset();
+    if (metadataSet)
+        CPLHashSetClear(metadataSet);
+    if (metadataItemSet)
+        CPLHashSetClear(metadataItemSet);
+}
+
 /************************************************************************/
 /*                AddSrcMaskBandDescriptionFromUnderlying()             */
 /************************************************************************/
@@ -1352,6 +1573,11 @@ char **GDALProxyPoolRasterBand::GetMetadata(const char *pszDomain)
         metadataSet =
             CPLHashSetNew(hash_func_get_metadata, equal_func_get_metadata,
                           free_func_get_metadata);
+    else if (GetSnapshot())
+    {
+        if (const auto pElt = LookupMetadata(metadataSet, pszDomain))
+            return pElt->papszMetadata;
+    }
 
     GDALRasterBand *poUnderlyingRasterBand = RefUnderlyingRasterBand();
     if (poUnderlyingRasterBand == nullptr)
@@ -1382,6 +1608,12 @@ const char *GDALProxyPoolRasterBand::GetMetadataItem(const char *pszName,
         metadataItemSet = CPLHashSetNew(hash_func_get_metadata_item,
                                         equal_func_get_metadata_item,
                                         free_func_get_metadata_item);
+    else if (GetSnapshot())
+    {
+        if (const auto pElt =
+                LookupMetadataItem(metadataItemSet, pszName, pszDomain))
+            return pElt->pszMetadataItem;
+    }
 
     GDALRasterBand *poUnderlyingRasterBand = RefUnderlyingRasterBand();
     if (poUnderlyingRasterBand == nullptr)
@@ -1410,6 +1642,10 @@ const char *GDALProxyPoolRasterBand::GetMetadataItem(const char *pszName,
 
 char **GDALProxyPoolRasterBand::GetCategoryNames()
 {
+    Snapshot *psSnapshot = GetSnapshot();
+    if (psSnapshot && psSnapshot->bCategoryNamesFetched)
+        return papszCategoryNames;
+
     GDALRasterBand *poUnderlyingRasterBand = RefUnderlyingRasterBand();
     if (poUnderlyingRasterBand == nullptr)
         return nullptr;
@@ -1421,6 +1657,8 @@ char **GDALProxyPoolRasterBand::GetCategoryNames()
         poUnderlyingRasterBand->GetCategoryNames();
     if (papszUnderlyingCategoryNames)
         papszCategoryNames = CSLDuplicate(papszUnderlyingCategoryNames);
+    if (psSnapshot)
+        psSnapshot->bCategoryNamesFetched = true;
 
     UnrefUnderlyingRasterBand(poUnderlyingRasterBand);
 
@@ -1433,6 +1671,10 @@ char **GDALProxyPoolRasterBand::GetCategoryNames()
 
 const char *GDALProxyPoolRasterBand::GetUnitType()
 {
+    Snapshot *psSnapshot = GetSnapshot();
+    if (psSnapshot && psSnapshot->bUnitTypeFetched)
+        return pszUnitType;
+
     GDALRasterBand *poUnderlyingRasterBand = RefUnderlyingRasterBand();
     if (poUnderlyingRasterBand == nullptr)
         return nullptr;
@@ -1443,6 +1685,8 @@ const char *GDALProxyPoolRasterBand::GetUnitType()
     const char *pszUnderlyingUnitType = poUnderlyingRasterBand->GetUnitType();
     if (pszUnderlyingUnitType)
         pszUnitType = CPLStrdup(pszUnderlyingUnitType);
+    if (psSnapshot)
+        psSnapshot->bUnitTypeFetched = true;
 
     UnrefUnderlyingRasterBand(poUnderlyingRasterBand);
 
@@ -1455,6 +1699,10 @@ const char *GDALProxyPoolRasterBand::GetUnitType()
 
 GDALColorTable *GDALProxyPoolRasterBand::GetColorTable()
 {
+    Snapshot *psSnapshot = GetSnapshot();
+    if (psSnapshot && psSnapshot->bColorTableFetched)
+        return poColorTable;
+
     GDALRasterBand *poUnderlyingRasterBand = RefUnderlyingRasterBand();
     if (poUnderlyingRasterBand == nullptr)
         return nullptr;
@@ -1467,12 +1715,109 @@ GDALColorTable *GDALProxyPoolRasterBand::GetColorTable()
         poUnderlyingRasterBand->GetColorTable();
     if (poUnderlyingColorTable)
         poColorTable = poUnderlyingColorTable->Clone();
+    if (psSnapshot)
+        psSnapshot->bColorTableFetched = true;
 
     UnrefUnderlyingRasterBand(poUnderlyingRasterBand);
 
     return poColorTable;
 }
 
+/* ******************************************************************** */
+/*                 Getters of snapshotted band properties               */
+/* ******************************************************************** */
+
+#define PROXY_POOL_BAND_SNAPSHOT_WITH_SUCCESS(methodName, member)              \
+    double GDALProxyPoolRasterBand::methodName(int *pbSuccess)                 \
+    {                                                                          \
+        Snapshot *psSnapshot = GetSnapshot();                                  \
+        if (psSnapshot && psSnapshot->member.has_value())                      \
+        {                                                                      \
+            if (pbSuccess)                                                     \
+                *pbSuccess = psSnapshot->member->second;                       \
+            return psSnapshot->member->first;                                  \
+        }                                                                      \
+        int bSuccess = FALSE;                                                  \
+        double dfRet = 0;                                                      \
+        GDALRasterBand *poUnderlyingRasterBand = RefUnderlyingRasterBand();    \
+        if (poUnderlyingRasterBand)                                            \
+        {                                                                      \
+            dfRet = poUnderlyingRasterBand->methodName(&bSuccess);             \
+            UnrefUnderlyingRasterBand(poUnderlyingRasterBand);                 \
+            if (psSnapshot)                                                    \
+                psSnapshot->member = std::make_pair(dfRet, bSuccess);          \
+        }                                                                      \
+        if (pbSuccess)                                                         \
+            *pbSuccess = bSuccess;                                             \
+        return dfRet;                                                          \
+    }
+
+PROXY_POOL_BAND_SNAPSHOT_WITH_SUCCESS(GetNoDataValue, noData)
+PROXY_POOL_BAND_SNAPSHOT_WITH_SUCCESS(GetOffset, offset)
+PROXY_POOL_BAND_SNAPSHOT_WITH_SUCCESS(GetScale, scale)
+
+#define PROXY_POOL_BAND_SNAPSHOT(retType, retErrValue, methodName, member)     \
+    retType GDALProxyPoolRasterBand::methodName()                              \
+    {                                                                          \
+        Snapshot *psSnapshot = GetSnapshot();                                  \
+        if (psSnapshot && psSnapshot->member.has_value())                      \
+            return *(psSnapshot->member);                                      \
+        GDALRasterBand *poUnderlyingRasterBand = RefUnderlyingRasterBand();    \
+        if (poUnderlyingRasterBand == nullptr)                                 \
+            return retErrValue;                                                \
+        const retType ret = poUnderlyingRasterBand->methodName();              \
+        UnrefUnderlyingRasterBand(poUnderlyingRasterBand);                     \
+        if (psSnapshot)                                                        \
+            psSnapshot->member = ret;                                          \
+        return ret;                                                            \
+    }
+
+PROXY_POOL_BAND_SNAPSHOT(GDALColorInterp, GCI_Undefined, GetColorInterpretation,
+                         eColorInterp)
+PROXY_POOL_BAND_SNAPSHOT(int, 0, GetOverviewCount, nOverviewCount)
+PROXY_POOL_BAND_SNAPSHOT(int, 0, GetMaskFlags, nMaskFlags)
+
+/* ******************************************************************** */
+/*                Setters that invalidate the snapshot                  */
+/* ******************************************************************** */
+
+#define PROXY_POOL_BAND_INVALIDATING_SETTER(methodName, argList, argParams)    \
+    CPLErr GDALProxyPoolRasterBand::methodName argList                         \
+    {                                                                          \
+        InvalidateSnapshot();                                                  \
+        return GDALProxyRasterBand::methodName argParams;                      \
+    }
+
+PROXY_POOL_BAND_INVALIDATING_SETTER(SetMetadata,
+                                    (char **papszMetadata,
+                                     const char *pszDomain),
+                                    (papszMetadata, pszDomain))
+PROXY_POOL_BAND_INVALIDATING_SETTER(SetMetadataItem,
+                                    (const char *pszName, const char *pszValue,
+                                     const char *pszDomain),
+                                    (pszName, pszValue, pszDomain))
+PROXY_POOL_BAND_INVALIDATING_SETTER(SetCategoryNames, (char **papszNames),
+                                    (papszNames))
+PROXY_POOL_BAND_INVALIDATING_SETTER(SetNoDataValue, (double dfNoData),
+                                    (dfNoData))
+PROXY_POOL_BAND_INVALIDATING_SETTER(DeleteNoDataValue, (), ())
+PROXY_POOL_BAND_INVALIDATING_SETTER(SetColorTable, (GDALColorTable * poCT),
+                                    (poCT))
+PROXY_POOL_BAND_INVALIDATING_SETTER(SetColorInterpretation,
+                                    (GDALColorInterp eInterp), (eInterp))
+PROXY_POOL_BAND_INVALIDATING_SETTER(SetOffset, (double dfOffset), (dfOffset))
+PROXY_POOL_BAND_INVALIDATING_SETTER(SetScale, (double dfScale), (dfScale))
+PROXY_POOL_BAND_INVALIDATING_SETTER(SetUnitType, (const char *pszUnit),
+                                    (pszUnit))
+PROXY_POOL_BAND_INVALIDATING_SETTER(
+    BuildOverviews,
+    (const char *pszResampling, int nOverviews, const int *panOverviewList,
+     GDALProgressFunc pfnProgress, void *pProgressData,
+     CSLConstList papszOptions),
+    (pszResampling, nOverviews, panOverviewList, pfnProgress, pProgressData,
+     papszOptions))
+PROXY_POOL_BAND_INVALIDATING_SETTER(CreateMaskBand, (int nFlagsIn), (nFlagsIn))
+
 /* ******************************************************************** */
 /*                           GetOverview()                              */
 /* ******************************************************************** */
@@ -39,20 +39,26 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <condition_variable>
+#include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <type_traits>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
+#include "cpl_trace.h"
 #include "cpl_virtualmem.h"
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_rat.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 
 /************************************************************************/
 /*                           GDALRasterBand()                           */
@@ -93,6 +99,7 @@ GDALRasterBand::~GDALRasterBand()
     GDALRasterBand::FlushCache(true);
 
     delete poBandBlockCache;
+    GDALRasterBlock::PurgeCompressedCache(this);
 
     if (static_cast<GIntBig>(nBlockReads) >
             static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn &&
@@ -487,6 +494,24 @@ CPLErr CPL_STDCALL GDALRasterIOEx(GDALRasterBandH hBand, GDALRWFlag eRWFlag,
                              nBufXSize, nBufYSize, eBufType, nPixelSpace,
                              nLineSpace, psExtraArg));
 }
+/************************************************************************/
+/*                      AddBlockTraceAttributes()                       */
+/************************************************************************/
+
+static void AddBlockTraceAttributes(CPLTraceSpan &oTraceSpan,
+                                    GDALRasterBand *poBand, int nXBlockOff,
+                                    int nYBlockOff)
+{
+    if (!oTraceSpan.IsActive())
+        return;
+    GDALDataset *poDS = poBand->GetDataset();
+    if (poDS)
+        oTraceSpan.AddAttribute("dataset", poDS->GetDescription());
+    oTraceSpan.AddAttribute("band", poBand->GetBand());
+    oTraceSpan.AddAttribute("x_block", nXBlockOff);
+    oTraceSpan.AddAttribute("y_block", nYBlockOff);
+}
+
 /************************************************************************/
 /*                             ReadBlock()                              */
 /************************************************************************/
@@ -597,6 +622,8 @@ CPLErr GDALRasterBand::ReadBlock(int nXBlockOff, int nYBlockOff, void *pImage)
     /*      Invoke underlying implementation method.                        */
     /* -------------------------------------------------------------------- */
 
+    CPLTraceSpan oTraceSpan("raster", "IReadBlock");
+    AddBlockTraceAttributes(oTraceSpan, this, nXBlockOff, nYBlockOff);
     int bCallLeaveReadWrite = EnterReadWrite(GF_Read);
     CPLErr eErr = IReadBlock(nXBlockOff, nYBlockOff, pImage);
     if (bCallLeaveReadWrite)
@@ -669,6 +696,35 @@ CPLErr GDALRasterBand::IWriteBlock(int /*nBlockXOff*/, int /*nBlockYOff*/,
     return (CE_Failure);
 }
 
+/************************************************************************/
+/*                       CanReadBlockIntoBuffer()                       */
+/************************************************************************/
+
+/**
+ * \brief Whether IReadBlock() can decode into a buffer not owned by the block
+ * cache.
+ *
+ * When this returns true, GDALRasterBand::IRasterIO() may, for read requests
+ * made of whole blocks with the band data type and a packed layout, call
+ * IReadBlock() directly on the caller buffer instead of going through a
+ * GDALRasterBlock, thus saving a copy and not polluting the block cache.
+ *
+ * Drivers should only return true if IReadBlock() has no requirement on the
+ * buffer it is passed other than being nBlockXSize * nBlockYSize pixels large,
+ * so that it behaves the same whether it is called from GetLockedBlockRef()
+ * or not.
+ *
+ * The default implementation returns false.
+ *
+ * @return true if IReadBlock() can be called on an arbitrary buffer.
+ * @since GDAL 3.9
+ */
+
+bool GDALRasterBand::CanReadBlockIntoBuffer() const
+{
+    return false;
+}
+
 /************************************************************************/
 /*                             WriteBlock()                             */
 /************************************************************************/
@@ -1198,6 +1254,8 @@ CPLErr GDALRasterBand::DropCache()
     if (poBandBlockCache)
         poBandBlockCache->EnableDirtyBlockWriting();
 
+    GDALRasterBlock::PurgeCompressedCache(this);
+
     return result;
 }
 
@@ -1490,13 +1548,19 @@ GDALRasterBlock *GDALRasterBand::GetLockedBlockRef(int nXBlockOff,
             return nullptr;
         }
 
-        if (!bJustInitialize)
+        if (!bJustInitialize && !poBlock->LoadFromCompressedCache())
         {
             const GUInt32 nErrorCounter = CPLGetErrorCounter();
-            int bCallLeaveReadWrite = EnterReadWrite(GF_Read);
-            eErr = IReadBlock(nXBlockOff, nYBlockOff, poBlock->GetDataRef());
-            if (bCallLeaveReadWrite)
-                LeaveReadWrite();
+            {
+                CPLTraceSpan oTraceSpan("raster", "IReadBlock");
+                AddBlockTraceAttributes(oTraceSpan, this, nXBlockOff,
+                                        nYBlockOff);
+                int bCallLeaveReadWrite = EnterReadWrite(GF_Read);
+                eErr = IReadBlock(nXBlockOff, nYBlockOff,
+                                  poBlock->GetDataRef());
+                if (bCallLeaveReadWrite)
+                    LeaveReadWrite();
+            }
             if (eErr != CE_None)
             {
                 poBlock->DropLock();
@@ -3376,6 +3440,240 @@ static inline void ComputeFloatNoDataValue(GDALDataType eDataType,
     }
 }
 
+/************************************************************************/
+/*                      GDALGetStatsSlotCount()                         */
+/************************************************************************/
+
+// Returns the number of accumulators needed by callers of
+// GDALIterateSampledBlocks(): 1 when statistics are computed in the calling
+// thread only, or twice the number of threads specified by GDAL_NUM_THREADS,
+// to account for blocks being fetched while others are processed.
+
+static int GDALGetStatsSlotCount()
+{
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                                       ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+    return nThreads > 1 ? 2 * nThreads : 1;
+}
+
+/************************************************************************/
+/*                     GDALIterateSampledBlocks()                       */
+/************************************************************************/
+
+namespace
+{
+// Called for each sampled block. iSlot is the index, lower than the number
+// of slots, of the accumulator that may be updated: calls with the same
+// iSlot are never run concurrently. iBlock is the rank of the block among
+// the sampled ones. pabyMask is nullptr if there is no mask band.
+// Returns false to end the iteration early.
+using GDALSampledBlockFunc =
+    std::function<bool(int iSlot, int iBlock, const void *pData,
+                       const GByte *pabyMask, int nXCheck, int nYCheck)>;
+
+struct GDALSampledBlockSlot
+{
+    GDALRasterBlock *poBlock = nullptr;
+    GByte *pabyMask = nullptr;
+    int iBlock = 0;
+    int nXCheck = 0;
+    int nYCheck = 0;
+    bool bBusy = false;
+};
+
+struct GDALSampledBlockState
+{
+    const GDALSampledBlockFunc *pfnFunc = nullptr;
+    std::vector<GDALSampledBlockSlot> asSlots{};
+    std::mutex oMutex{};
+    std::condition_variable oCV{};
+    bool bStop = false;
+};
+
+struct GDALSampledBlockJob
+{
+    GDALSampledBlockState *psState = nullptr;
+    int iSlot = 0;
+};
+}  // namespace
+
+// Iterates over the blocks of poBand, taking one every nSampleRate blocks.
+// Blocks, and the corresponding mask data, are fetched in the calling
+// thread, since drivers cannot be assumed to be re-entrant, but when
+// nSlots > 1, pfnFunc is run by jobs of the global thread pool so that the
+// accumulation of a block overlaps with the reading of the next ones.
+// If bSkipEmptyBlocks is set, and there is no mask band, blocks that
+// GetDataCoverageStatus() reports as empty, like the missing tiles of a
+// sparse GeoTIFF file, are not read: pfnFunc is called with pData ==
+// nullptr, and must then consider that all the pixels of the block are at
+// the nodata value, or at 0 if there is no nodata value.
+
+static CPLErr GDALIterateSampledBlocks(GDALRasterBand *poBand,
+                                       GDALRasterBand *poMaskBand,
+                                       int nSampleRate, int nSlots,
+                                       bool bSkipEmptyBlocks,
+                                       const GDALSampledBlockFunc &pfnFunc,
+                                       GDALProgressFunc pfnProgress,
+                                       void *pProgressData,
+                                       const char *pszProgressMsg)
+{
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    const int nBlocksPerRow = DIV_ROUND_UP(poBand->GetXSize(), nBlockXSize);
+    const int nBlocksPerColumn = DIV_ROUND_UP(poBand->GetYSize(), nBlockYSize);
+    const int nTotalBlocks = nBlocksPerRow * nBlocksPerColumn;
+
+    double dfEmptyBlockValue = 0;
+    bSkipEmptyBlocks = bSkipEmptyBlocks && poMaskBand == nullptr &&
+                       GDALGetEmptyBlockValue(poBand, &dfEmptyBlockValue);
+
+    auto poThreadPool = nSlots > 1 ? GDALGetGlobalThreadPool(nSlots / 2)
+                                   : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
+    if (!poJobQueue)
+        nSlots = 1;
+
+    GDALSampledBlockState sState;
+    sState.pfnFunc = &pfnFunc;
+    sState.asSlots.resize(nSlots);
+    std::vector<GDALSampledBlockJob> asJobs(nSlots);
+    for (int i = 0; i < nSlots; ++i)
+    {
+        asJobs[i].psState = &sState;
+        asJobs[i].iSlot = i;
+    }
+
+    const auto FreeMasks = [&sState]()
+    {
+        for (auto &sSlot : sState.asSlots)
+            VSIFree(sSlot.pabyMask);
+    };
+
+    const auto JobFunc = [](void *pData)
+    {
+        const auto psJob = static_cast<GDALSampledBlockJob *>(pData);
+        auto psState = psJob->psState;
+        auto &sSlot = psState->asSlots[psJob->iSlot];
+        const bool bContinue =
+            (*psState->pfnFunc)(psJob->iSlot, sSlot.iBlock,
+                                sSlot.poBlock->GetDataRef(), sSlot.pabyMask,
+                                sSlot.nXCheck, sSlot.nYCheck);
+        sSlot.poBlock->DropLock();
+        sSlot.poBlock = nullptr;
+
+        std::lock_guard<std::mutex> oLock(psState->oMutex);
+        if (!bContinue)
+            psState->bStop = true;
+        sSlot.bBusy = false;
+        psState->oCV.notify_one();
+    };
+
+    CPLErr eErr = CE_None;
+    int iBlock = 0;
+    for (int iSampleBlock = 0; iSampleBlock < nTotalBlocks;
+         iSampleBlock += nSampleRate, ++iBlock)
+    {
+        // Find a free slot
+        int iSlot = 0;
+        {
+            std::unique_lock<std::mutex> oLock(sState.oMutex);
+            while (true)
+            {
+                if (sState.bStop)
+                    break;
+                for (iSlot = 0; iSlot < nSlots; ++iSlot)
+                {
+                    if (!sState.asSlots[iSlot].bBusy)
+                        break;
+                }
+                if (iSlot < nSlots)
+                    break;
+                sState.oCV.wait(oLock);
+            }
+            if (sState.bStop)
+                break;
+        }
+        auto &sSlot = sState.asSlots[iSlot];
+
+        const int iYBlock = iSampleBlock / nBlocksPerRow;
+        const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
+
+        int nXCheck = 0, nYCheck = 0;
+        poBand->GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+
+        if (bSkipEmptyBlocks &&
+            poBand->GetDataCoverageStatus(
+                iXBlock * nBlockXSize, iYBlock * nBlockYSize, nXCheck,
+                nYCheck, GDAL_DATA_COVERAGE_STATUS_DATA,
+                nullptr) == GDAL_DATA_COVERAGE_STATUS_EMPTY)
+        {
+            // The slot is free, so no job can be using it concurrently
+            if (!pfnFunc(iSlot, iBlock, nullptr, nullptr, nXCheck, nYCheck))
+                break;
+        }
+        else
+        {
+            GDALRasterBlock *const poBlock =
+                poBand->GetLockedBlockRef(iXBlock, iYBlock);
+            if (poBlock == nullptr)
+            {
+                eErr = CE_Failure;
+                break;
+            }
+
+            if (poMaskBand)
+            {
+                if (sSlot.pabyMask == nullptr)
+                {
+                    sSlot.pabyMask = static_cast<GByte *>(
+                        VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
+                }
+                if (sSlot.pabyMask == nullptr ||
+                    poMaskBand->RasterIO(
+                        GF_Read, iXBlock * nBlockXSize, iYBlock * nBlockYSize,
+                        nXCheck, nYCheck, sSlot.pabyMask, nXCheck, nYCheck,
+                        GDT_Byte, 0, nBlockXSize, nullptr) != CE_None)
+                {
+                    poBlock->DropLock();
+                    eErr = CE_Failure;
+                    break;
+                }
+            }
+
+            sSlot.poBlock = poBlock;
+            sSlot.iBlock = iBlock;
+            sSlot.nXCheck = nXCheck;
+            sSlot.nYCheck = nYCheck;
+            sSlot.bBusy = true;
+            if (nSlots == 1 ||
+                !poJobQueue->SubmitJob(JobFunc, &asJobs[iSlot]))
+            {
+                JobFunc(&asJobs[iSlot]);
+            }
+        }
+
+        if (pfnProgress &&
+            !pfnProgress(iSampleBlock / static_cast<double>(nTotalBlocks),
+                         pszProgressMsg, pProgressData))
+        {
+            poBand->ReportError(CE_Failure, CPLE_UserInterrupt,
+                                "User terminated");
+            eErr = CE_Failure;
+            break;
+        }
+    }
+
+    if (poJobQueue)
+        poJobQueue->WaitCompletion();
+    FreeMasks();
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                            GetHistogram()                            */
 /************************************************************************/
@@ -3402,6 +3700,10 @@ static inline void ComputeFloatNoDataValue(GDALDataType eDataType,
  * in generating histogram based luts for instance.  Generally bApproxOK is
  * much faster than an exactly computed histogram.
  *
+ * Starting with GDAL 3.9, the GDAL_NUM_THREADS configuration option can be set
+ * to "ALL_CPUS" or a integer value to specify the number of threads to use for
+ * histogram computation. Blocks are still read by the calling thread.
+ *
  * This method is the same as the C functions GDALGetRasterHistogram() and
  * GDALGetRasterHistogramEx().
  *
@@ -3481,6 +3783,7 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
 
     int bGotNoDataValue = FALSE;
     const double dfNoDataValue = GetNoDataValue(&bGotNoDataValue);
+    const bool bNoDataIsNaN = bGotNoDataValue && CPLIsNan(dfNoDataValue);
     bGotNoDataValue = bGotNoDataValue && !CPLIsNan(dfNoDataValue);
     bool bGotFloatNoDataValue = false;
     float fNoDataValue = 0.0f;
@@ -3732,14 +4035,21 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                 nSampleRate += 1;
         }
 
-        GByte *pabyMaskData = nullptr;
-        if (poMaskBand)
+        // Each slot accumulates in its own histogram, unless there is a
+        // single one or too many buckets.
+        int nSlots = GDALGetStatsSlotCount();
+        if (static_cast<size_t>(nBuckets) * nSlots > 16 * 1024 * 1024)
+            nSlots = 1;
+        std::vector<GUIntBig> anSlotHistograms;
+        if (nSlots > 1)
         {
-            pabyMaskData = static_cast<GByte *>(
-                VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-            if (!pabyMaskData)
+            try
             {
-                return CE_Failure;
+                anSlotHistograms.resize(static_cast<size_t>(nBuckets) * nSlots);
+            }
+            catch (const std::exception &)
+            {
+                nSlots = 1;
             }
         }
 
@@ -3748,43 +4058,43 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
         /*      Read the blocks, and add to histogram. */
         /* --------------------------------------------------------------------
          */
-        for (int iSampleBlock = 0;
-             iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
-             iSampleBlock += nSampleRate)
+        const auto AddBlockToHistogram =
+            [this, nSlots, panHistogram, &anSlotHistograms, nBuckets, dfMin,
+             dfScale, bSignedByte, bGotNoDataValue, dfNoDataValue,
+             bGotFloatNoDataValue, fNoDataValue, bNoDataIsNaN,
+             bIncludeOutOfRange](int iSlot, int /* iBlock */, const void *pData,
+                                 const GByte *pabyMask, int nXCheck,
+                                 int nYCheck)
         {
-            if (!pfnProgress(
-                    iSampleBlock /
-                        (static_cast<double>(nBlocksPerRow) * nBlocksPerColumn),
-                    "Compute Histogram", pProgressData))
+            GUIntBig *const panSlotHistogram =
+                nSlots == 1
+                    ? panHistogram
+                    : anSlotHistograms.data() +
+                          static_cast<size_t>(iSlot) * nBuckets;
+
+            // Empty block: all its pixels are at the nodata value, or 0.
+            if (pData == nullptr)
             {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
-
-            const int iYBlock = iSampleBlock / nBlocksPerRow;
-            const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
-
-            GDALRasterBlock *poBlock = GetLockedBlockRef(iXBlock, iYBlock);
-            if (poBlock == nullptr)
-            {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
-
-            void *pData = poBlock->GetDataRef();
-
-            int nXCheck = 0, nYCheck = 0;
-            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-            if (poMaskBand &&
-                poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                     iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                     pabyMaskData, nXCheck, nYCheck, GDT_Byte,
-                                     0, nBlockXSize, nullptr) != CE_None)
-            {
-                CPLFree(pabyMaskData);
-                poBlock->DropLock();
-                return CE_Failure;
+                if (bGotNoDataValue || bGotFloatNoDataValue || bNoDataIsNaN)
+                    return true;
+                const double dfIndex = floor((0.0 - dfMin) * dfScale);
+                const GUIntBig nPixels =
+                    static_cast<GUIntBig>(nXCheck) * nYCheck;
+                if (dfIndex < 0)
+                {
+                    if (bIncludeOutOfRange)
+                        panSlotHistogram[0] += nPixels;
+                }
+                else if (dfIndex >= nBuckets)
+                {
+                    if (bIncludeOutOfRange)
+                        panSlotHistogram[nBuckets - 1] += nPixels;
+                }
+                else
+                {
+                    panSlotHistogram[static_cast<int>(dfIndex)] += nPixels;
+                }
+                return true;
             }
 
             // this is a special case for a common situation.
@@ -3794,21 +4104,20 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
             {
                 const GPtrDiff_t nPixels =
                     static_cast<GPtrDiff_t>(nXCheck) * nYCheck;
-                GByte *pabyData = static_cast<GByte *>(pData);
+                const GByte *pabyData = static_cast<const GByte *>(pData);
 
                 for (GPtrDiff_t i = 0; i < nPixels; i++)
                 {
-                    if (pabyMaskData && pabyMaskData[i] == 0)
+                    if (pabyMask && pabyMask[i] == 0)
                         continue;
                     if (!(bGotNoDataValue &&
                           (pabyData[i] == static_cast<GByte>(dfNoDataValue))))
                     {
-                        panHistogram[pabyData[i]]++;
+                        panSlotHistogram[pabyData[i]]++;
                     }
                 }
 
-                poBlock->DropLock();
-                continue;  // To next sample block.
+                return true;  // To next sample block.
             }
 
             // This isn't the fastest way to do this, but is easier for now.
@@ -3819,7 +4128,7 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                     const GPtrDiff_t iOffset =
                         iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
 
-                    if (pabyMaskData && pabyMaskData[iOffset] == 0)
+                    if (pabyMask && pabyMask[iOffset] == 0)
                         continue;
 
                     double dfValue = 0.0;
@@ -3829,39 +4138,45 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                         case GDT_Byte:
                         {
                             if (bSignedByte)
-                                dfValue =
-                                    static_cast<signed char *>(pData)[iOffset];
+                                dfValue = static_cast<const signed char *>(
+                                    pData)[iOffset];
                             else
-                                dfValue = static_cast<GByte *>(pData)[iOffset];
+                                dfValue =
+                                    static_cast<const GByte *>(pData)[iOffset];
                             break;
                         }
                         case GDT_Int8:
-                            dfValue = static_cast<GInt8 *>(pData)[iOffset];
+                            dfValue =
+                                static_cast<const GInt8 *>(pData)[iOffset];
                             break;
                         case GDT_UInt16:
-                            dfValue = static_cast<GUInt16 *>(pData)[iOffset];
+                            dfValue =
+                                static_cast<const GUInt16 *>(pData)[iOffset];
                             break;
                         case GDT_Int16:
-                            dfValue = static_cast<GInt16 *>(pData)[iOffset];
+                            dfValue =
+                                static_cast<const GInt16 *>(pData)[iOffset];
                             break;
                         case GDT_UInt32:
-                            dfValue = static_cast<GUInt32 *>(pData)[iOffset];
+                            dfValue =
+                                static_cast<const GUInt32 *>(pData)[iOffset];
                             break;
                         case GDT_Int32:
-                            dfValue = static_cast<GInt32 *>(pData)[iOffset];
+                            dfValue =
+                                static_cast<const GInt32 *>(pData)[iOffset];
                             break;
                         case GDT_UInt64:
                             dfValue = static_cast<double>(
-                                static_cast<GUInt64 *>(pData)[iOffset]);
+                                static_cast<const GUInt64 *>(pData)[iOffset]);
                             break;
                         case GDT_Int64:
                             dfValue = static_cast<double>(
-                                static_cast<GInt64 *>(pData)[iOffset]);
+                                static_cast<const GInt64 *>(pData)[iOffset]);
                             break;
                         case GDT_Float32:
                         {
                             const float fValue =
-                                static_cast<float *>(pData)[iOffset];
+                                static_cast<const float *>(pData)[iOffset];
                             if (CPLIsNan(fValue) ||
                                 (bGotFloatNoDataValue &&
                                  ARE_REAL_EQUAL(fValue, fNoDataValue)))
@@ -3870,34 +4185,35 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                             break;
                         }
                         case GDT_Float64:
-                            dfValue = static_cast<double *>(pData)[iOffset];
+                            dfValue =
+                                static_cast<const double *>(pData)[iOffset];
                             if (CPLIsNan(dfValue))
                                 continue;
                             break;
                         case GDT_CInt16:
                         {
                             double dfReal =
-                                static_cast<GInt16 *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<GInt16 *>(pData)[iOffset * 2 + 1];
+                                static_cast<const GInt16 *>(pData)[iOffset * 2];
+                            double dfImag = static_cast<const GInt16 *>(
+                                pData)[iOffset * 2 + 1];
                             dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
                         }
                         break;
                         case GDT_CInt32:
                         {
                             double dfReal =
-                                static_cast<GInt32 *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<GInt32 *>(pData)[iOffset * 2 + 1];
+                                static_cast<const GInt32 *>(pData)[iOffset * 2];
+                            double dfImag = static_cast<const GInt32 *>(
+                                pData)[iOffset * 2 + 1];
                             dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
                         }
                         break;
                         case GDT_CFloat32:
                         {
                             double dfReal =
-                                static_cast<float *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<float *>(pData)[iOffset * 2 + 1];
+                                static_cast<const float *>(pData)[iOffset * 2];
+                            double dfImag = static_cast<const float *>(
+                                pData)[iOffset * 2 + 1];
                             if (CPLIsNan(dfReal) || CPLIsNan(dfImag))
                                 continue;
                             dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
@@ -3906,9 +4222,9 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                         case GDT_CFloat64:
                         {
                             double dfReal =
-                                static_cast<double *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<double *>(pData)[iOffset * 2 + 1];
+                                static_cast<const double *>(pData)[iOffset * 2];
+                            double dfImag = static_cast<const double *>(
+                                pData)[iOffset * 2 + 1];
                             if (CPLIsNan(dfReal) || CPLIsNan(dfImag))
                                 continue;
                             dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
@@ -3917,8 +4233,7 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                         case GDT_Unknown:
                         case GDT_TypeCount:
                             CPLAssert(false);
-                            CPLFree(pabyMaskData);
-                            return CE_Failure;
+                            return false;
                     }
 
                     if (eDataType != GDT_Float32 && bGotNoDataValue &&
@@ -3933,24 +4248,38 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                     if (dfIndex < 0)
                     {
                         if (bIncludeOutOfRange)
-                            panHistogram[0]++;
+                            panSlotHistogram[0]++;
                     }
                     else if (dfIndex >= nBuckets)
                     {
                         if (bIncludeOutOfRange)
-                            ++panHistogram[nBuckets - 1];
+                            ++panSlotHistogram[nBuckets - 1];
                     }
                     else
                     {
-                        ++panHistogram[static_cast<int>(dfIndex)];
+                        ++panSlotHistogram[static_cast<int>(dfIndex)];
                     }
                 }
             }
 
-            poBlock->DropLock();
+            return true;
+        };
+
+        if (GDALIterateSampledBlocks(this, poMaskBand, nSampleRate, nSlots,
+                                     !bSignedByte, AddBlockToHistogram,
+                                     pfnProgress, pProgressData,
+                                     "Compute Histogram") != CE_None)
+        {
+            return CE_Failure;
         }
 
-        CPLFree(pabyMaskData);
+        for (int iSlot = 0; nSlots > 1 && iSlot < nSlots; ++iSlot)
+        {
+            const GUIntBig *panSlotHistogram =
+                anSlotHistograms.data() + static_cast<size_t>(iSlot) * nBuckets;
+            for (int i = 0; i < nBuckets; ++i)
+                panHistogram[i] += panSlotHistogram[i];
+        }
     }
 
     pfnProgress(1.0, "Compute Histogram", pProgressData);
@@ -5672,6 +6001,10 @@ void GDALRasterBand::SetValidPercent(GUIntBig nSampleCount,
  *
  * Cached statistics can be cleared with GDALDataset::ClearStatistics().
  *
+ * Starting with GDAL 3.9, the GDAL_NUM_THREADS configuration option can be set
+ * to "ALL_CPUS" or a integer value to specify the number of threads to use for
+ * statistics computation. Blocks are still read by the calling thread.
+ *
  * This method is the same as the C function GDALComputeRasterStatistics().
  *
  * @param bApproxOK If TRUE statistics may be computed based on overviews
@@ -5764,6 +6097,7 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
 
     int bGotNoDataValue = FALSE;
     const double dfNoDataValue = GetNoDataValue(&bGotNoDataValue);
+    const bool bNoDataIsNaN = bGotNoDataValue && CPLIsNan(dfNoDataValue);
     bGotNoDataValue = bGotNoDataValue && !CPLIsNan(dfNoDataValue);
     bool bGotFloatNoDataValue = false;
     float fNoDataValue = 0.0f;
@@ -5945,31 +6279,50 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                     ? static_cast<GUInt32>(dfNoDataValue + 1e-10)
                     : nMaxValueType + 1;
 
-            for (int iSampleBlock = 0;
-                 iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
-                 iSampleBlock += nSampleRate)
+            // Partial statistics of each slot
+            struct IntStats
             {
-                const int iYBlock = iSampleBlock / nBlocksPerRow;
-                const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
-
-                GDALRasterBlock *const poBlock =
-                    GetLockedBlockRef(iXBlock, iYBlock);
-                if (poBlock == nullptr)
-                    return CE_Failure;
-
-                void *const pData = poBlock->GetDataRef();
-
-                int nXCheck = 0, nYCheck = 0;
-                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-                if (eDataType == GDT_Byte)
+                GUInt32 nMin;
+                GUInt32 nMax;
+                GUIntBig nSum;
+                GUIntBig nSumSquare;
+                GUIntBig nSampleCount;
+                GUIntBig nValidCount;
+            };
+            const int nSlots = GDALGetStatsSlotCount();
+            std::vector<IntStats> asSlotStats(
+                nSlots, IntStats{nMaxValueType, 0, 0, 0, 0, 0});
+
+            const auto AddBlockToStats =
+                [this, &asSlotStats, nNoDataValue,
+                 nMaxValueType](int iSlot, int /* iBlock */, const void *pData,
+                                const GByte * /* pabyMask */, int nXCheck,
+                                int nYCheck)
+            {
+                auto &sStats = asSlotStats[iSlot];
+                const GUIntBig nPixels =
+                    static_cast<GUIntBig>(nXCheck) * nYCheck;
+                if (pData == nullptr)
+                {
+                    // Empty block: all its pixels are at the nodata value,
+                    // or 0.
+                    sStats.nSampleCount += nPixels;
+                    if (nNoDataValue > nMaxValueType)
+                    {
+                        sStats.nMin = 0;
+                        sStats.nValidCount += nPixels;
+                    }
+                }
+                else if (eDataType == GDT_Byte)
                 {
                     ComputeStatisticsInternal<
                         GByte, /* COMPUTE_OTHER_STATS = */ true>::
                         f(nXCheck, nBlockXSize, nYCheck,
                           static_cast<const GByte *>(pData),
-                          nNoDataValue <= nMaxValueType, nNoDataValue, nMin,
-                          nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                          nNoDataValue <= nMaxValueType, nNoDataValue,
+                          sStats.nMin, sStats.nMax, sStats.nSum,
+                          sStats.nSumSquare, sStats.nSampleCount,
+                          sStats.nValidCount);
                 }
                 else
                 {
@@ -5977,21 +6330,31 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                         GUInt16, /* COMPUTE_OTHER_STATS = */ true>::
                         f(nXCheck, nBlockXSize, nYCheck,
                           static_cast<const GUInt16 *>(pData),
-                          nNoDataValue <= nMaxValueType, nNoDataValue, nMin,
-                          nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                          nNoDataValue <= nMaxValueType, nNoDataValue,
+                          sStats.nMin, sStats.nMax, sStats.nSum,
+                          sStats.nSumSquare, sStats.nSampleCount,
+                          sStats.nValidCount);
                 }
+                return true;
+            };
 
-                poBlock->DropLock();
+            if (GDALIterateSampledBlocks(this, nullptr, nSampleRate, nSlots,
+                                         true, AddBlockToStats, pfnProgress,
+                                         pProgressData,
+                                         "Compute Statistics") != CE_None)
+            {
+                return CE_Failure;
+            }
 
-                if (!pfnProgress(iSampleBlock /
-                                     static_cast<double>(nBlocksPerRow *
-                                                         nBlocksPerColumn),
-                                 "Compute Statistics", pProgressData))
-                {
-                    ReportError(CE_Failure, CPLE_UserInterrupt,
-                                "User terminated");
-                    return CE_Failure;
-                }
+            // Integer sums, so the order of the merge does not matter
+            for (const auto &sStats : asSlotStats)
+            {
+                nMin = std::min(nMin, sStats.nMin);
+                nMax = std::max(nMax, sStats.nMax);
+                nSum += sStats.nSum;
+                nSumSquare += sStats.nSumSquare;
+                nSampleCount += sStats.nSampleCount;
+                nValidCount += sStats.nValidCount;
             }
 
             if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
@@ -6060,46 +6423,54 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
         }
 #endif
 
-        GByte *pabyMaskData = nullptr;
-        if (poMaskBand)
+        // Partial statistics computed with the Welford algorithm, which are
+        // merged at the end. In the multi-threaded case, there is one per
+        // sampled block, so that the result does not depend on the order
+        // into which blocks are processed.
+        struct WelfordStats
         {
-            pabyMaskData = static_cast<GByte *>(
-                VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-            if (!pabyMaskData)
-            {
-                return CE_Failure;
-            }
-        }
-
-        for (int iSampleBlock = 0;
-             iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
-             iSampleBlock += nSampleRate)
+            double dfMin;
+            double dfMax;
+            double dfMean;
+            double dfM2;
+            GUIntBig nSampleCount;
+            GUIntBig nValidCount;
+        };
+        const int nSlots = GDALGetStatsSlotCount();
+        const int nTotalBlocks = nBlocksPerRow * nBlocksPerColumn;
+        std::vector<WelfordStats> asPartialStats(
+            nSlots > 1 ? DIV_ROUND_UP(nTotalBlocks, nSampleRate) : 1,
+            WelfordStats{std::numeric_limits<double>::max(),
+                         -std::numeric_limits<double>::max(), 0.0, 0.0, 0, 0});
+
+        const auto AddBlockToStats =
+            [this, nSlots, &asPartialStats, bSignedByte, bGotNoDataValue,
+             dfNoDataValue, bGotFloatNoDataValue, fNoDataValue,
+             bNoDataIsNaN](int /* iSlot */, int iBlock, const void *pData,
+                           const GByte *pabyMaskData, int nXCheck, int nYCheck)
         {
-            const int iYBlock = iSampleBlock / nBlocksPerRow;
-            const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
+            auto &sStats = asPartialStats[nSlots > 1 ? iBlock : 0];
 
-            GDALRasterBlock *const poBlock =
-                GetLockedBlockRef(iXBlock, iYBlock);
-            if (poBlock == nullptr)
+            if (pData == nullptr)
             {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
-
-            void *const pData = poBlock->GetDataRef();
-
-            int nXCheck = 0, nYCheck = 0;
-            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-            if (poMaskBand &&
-                poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                     iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                     pabyMaskData, nXCheck, nYCheck, GDT_Byte,
-                                     0, nBlockXSize, nullptr) != CE_None)
-            {
-                CPLFree(pabyMaskData);
-                poBlock->DropLock();
-                return CE_Failure;
+                // Empty block: all its pixels are at the nodata value, or 0.
+                const GUIntBig nPixels =
+                    static_cast<GUIntBig>(nXCheck) * nYCheck;
+                sStats.nSampleCount += nPixels;
+                if (bGotNoDataValue || bGotFloatNoDataValue || bNoDataIsNaN)
+                    return true;
+                sStats.dfMin = std::min(sStats.dfMin, 0.0);
+                sStats.dfMax = std::max(sStats.dfMax, 0.0);
+                const GUIntBig nNewValidCount = sStats.nValidCount + nPixels;
+                const double dfDelta = -sStats.dfMean;
+                sStats.dfM2 += dfDelta * dfDelta *
+                               static_cast<double>(sStats.nValidCount) *
+                               static_cast<double>(nPixels) /
+                               static_cast<double>(nNewValidCount);
+                sStats.dfMean += dfDelta * static_cast<double>(nPixels) /
+                                 static_cast<double>(nNewValidCount);
+                sStats.nValidCount = nNewValidCount;
+                return true;
             }
 
             // This isn't the fastest way to do this, but is easier for now.
@@ -6121,32 +6492,57 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                     if (!bValid)
                         continue;
 
-                    dfMin = std::min(dfMin, dfValue);
-                    dfMax = std::max(dfMax, dfValue);
+                    sStats.dfMin = std::min(sStats.dfMin, dfValue);
+                    sStats.dfMax = std::max(sStats.dfMax, dfValue);
 
-                    nValidCount++;
-                    const double dfDelta = dfValue - dfMean;
-                    dfMean += dfDelta / nValidCount;
-                    dfM2 += dfDelta * (dfValue - dfMean);
+                    sStats.nValidCount++;
+                    const double dfDelta = dfValue - sStats.dfMean;
+                    sStats.dfMean += dfDelta / sStats.nValidCount;
+                    sStats.dfM2 += dfDelta * (dfValue - sStats.dfMean);
                 }
             }
 
-            nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
+            sStats.nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
+            return true;
+        };
 
-            poBlock->DropLock();
+        if (GDALIterateSampledBlocks(this, poMaskBand, nSampleRate, nSlots,
+                                     !bSignedByte, AddBlockToStats,
+                                     pfnProgress, pProgressData,
+                                     "Compute Statistics") != CE_None)
+        {
+            return CE_Failure;
+        }
 
-            if (!pfnProgress(
-                    iSampleBlock /
-                        static_cast<double>(nBlocksPerRow * nBlocksPerColumn),
-                    "Compute Statistics", pProgressData))
+        // Merge partial statistics, using the formula of Chan et al.
+        for (const auto &sStats : asPartialStats)
+        {
+            nSampleCount += sStats.nSampleCount;
+            if (sStats.nValidCount == 0)
+                continue;
+            dfMin = std::min(dfMin, sStats.dfMin);
+            dfMax = std::max(dfMax, sStats.dfMax);
+            if (nValidCount == 0)
             {
-                ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-                CPLFree(pabyMaskData);
-                return CE_Failure;
+                dfMean = sStats.dfMean;
+                dfM2 = sStats.dfM2;
+                nValidCount = sStats.nValidCount;
+            }
+            else
+            {
+                const GUIntBig nNewValidCount =
+                    nValidCount + sStats.nValidCount;
+                const double dfDelta = sStats.dfMean - dfMean;
+                dfMean += dfDelta * static_cast<double>(sStats.nValidCount) /
+                          static_cast<double>(nNewValidCount);
+                dfM2 += sStats.dfM2 + dfDelta * dfDelta *
+                                          static_cast<double>(nValidCount) *
+                                          static_cast<double>(
+                                              sStats.nValidCount) /
+                                          static_cast<double>(nNewValidCount);
+                nValidCount = nNewValidCount;
             }
         }
-
-        CPLFree(pabyMaskData);
     }
 
     if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
@@ -6474,63 +6870,54 @@ static void ComputeMinMaxGeneric(const void *pData, GDALDataType eDataType,
 
 static bool ComputeMinMaxGenericIterBlocks(
     GDALRasterBand *poBand, GDALDataType eDataType, bool bSignedByte,
-    int nTotalBlocks, int nSampleRate, int nBlocksPerRow, bool bGotNoDataValue,
-    double dfNoDataValue, bool bGotFloatNoDataValue, float fNoDataValue,
+    int nSampleRate, int nSlots, bool bGotNoDataValue, double dfNoDataValue,
+    bool bGotFloatNoDataValue, float fNoDataValue, bool bNoDataIsNaN,
     GDALRasterBand *poMaskBand, double &dfMin, double &dfMax)
 
 {
-    GByte *pabyMaskData = nullptr;
     int nBlockXSize, nBlockYSize;
     poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
 
-    if (poMaskBand)
-    {
-        pabyMaskData =
-            static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-        if (!pabyMaskData)
-        {
-            return false;
-        }
-    }
-
-    for (int iSampleBlock = 0; iSampleBlock < nTotalBlocks;
-         iSampleBlock += nSampleRate)
+    std::vector<std::pair<double, double>> aoSlotMinMax(nSlots,
+                                                        {dfMin, dfMax});
+    const auto AddBlockToMinMax =
+        [eDataType, bSignedByte, nBlockXSize, bGotNoDataValue, dfNoDataValue,
+         bGotFloatNoDataValue, fNoDataValue, bNoDataIsNaN,
+         &aoSlotMinMax](int iSlot, int /* iBlock */, const void *pData,
+                        const GByte *pabyMaskData, int nXCheck, int nYCheck)
     {
-        const int iYBlock = iSampleBlock / nBlocksPerRow;
-        const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
-
-        GDALRasterBlock *poBlock = poBand->GetLockedBlockRef(iXBlock, iYBlock);
-        if (poBlock == nullptr)
+        if (pData == nullptr)
         {
-            CPLFree(pabyMaskData);
-            return false;
-        }
-
-        void *const pData = poBlock->GetDataRef();
-
-        int nXCheck = 0, nYCheck = 0;
-        poBand->GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-        if (poMaskBand &&
-            poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                 iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                 pabyMaskData, nXCheck, nYCheck, GDT_Byte, 0,
-                                 nBlockXSize, nullptr) != CE_None)
-        {
-            poBlock->DropLock();
-            CPLFree(pabyMaskData);
-            return false;
+            // Empty block: all its pixels are at the nodata value, or 0.
+            if (!bGotNoDataValue && !bGotFloatNoDataValue && !bNoDataIsNaN)
+            {
+                aoSlotMinMax[iSlot].first =
+                    std::min(aoSlotMinMax[iSlot].first, 0.0);
+                aoSlotMinMax[iSlot].second =
+                    std::max(aoSlotMinMax[iSlot].second, 0.0);
+            }
+            return true;
         }
-
         ComputeMinMaxGeneric(pData, eDataType, bSignedByte, nXCheck, nYCheck,
-                             nBlockXSize, CPL_TO_BOOL(bGotNoDataValue),
-                             dfNoDataValue, bGotFloatNoDataValue, fNoDataValue,
-                             pabyMaskData, dfMin, dfMax);
+                             nBlockXSize, bGotNoDataValue, dfNoDataValue,
+                             bGotFloatNoDataValue, fNoDataValue, pabyMaskData,
+                             aoSlotMinMax[iSlot].first,
+                             aoSlotMinMax[iSlot].second);
+        return true;
+    };
 
-        poBlock->DropLock();
+    if (GDALIterateSampledBlocks(poBand, poMaskBand, nSampleRate, nSlots,
+                                 !bSignedByte, AddBlockToMinMax, nullptr,
+                                 nullptr, nullptr) != CE_None)
+    {
+        return false;
     }
 
-    CPLFree(pabyMaskData);
+    for (const auto &oMinMax : aoSlotMinMax)
+    {
+        dfMin = std::min(dfMin, oMinMax.first);
+        dfMax = std::max(dfMax, oMinMax.second);
+    }
     return true;
 }
 
@@ -6545,6 +6932,10 @@ static bool ComputeMinMaxGenericIterBlocks(
  * If bApprox is FALSE, then all pixels will be read and used to compute
  * an exact range.
  *
+ * Starting with GDAL 3.9, the GDAL_NUM_THREADS configuration option can be set
+ * to "ALL_CPUS" or a integer value to specify the number of threads to use for
+ * min/max computation. Blocks are still read by the calling thread.
+ *
  * This method is the same as the C function GDALComputeRasterMinMax().
  *
  * @param bApproxOK TRUE if an approximate (faster) answer is OK, otherwise
@@ -6594,6 +6985,7 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
     /* -------------------------------------------------------------------- */
     int bGotNoDataValue = FALSE;
     const double dfNoDataValue = GetNoDataValue(&bGotNoDataValue);
+    const bool bNoDataIsNaN = bGotNoDataValue && CPLIsNan(dfNoDataValue);
     bGotNoDataValue = bGotNoDataValue && !CPLIsNan(dfNoDataValue);
     bool bGotFloatNoDataValue = false;
     float fNoDataValue = 0.0f;
@@ -6642,9 +7034,10 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                         eDataType == GDT_Int16 || eDataType == GDT_UInt16);
 
     const auto ComputeMinMaxForBlock =
-        [this, bSignedByte, bGotNoDataValue, dfNoDataValue, &nMin, &nMax,
-         &nMinInt16, &nMaxInt16](const void *pData, int nXCheck,
-                                 int nBufferWidth, int nYCheck)
+        [this, bSignedByte, bGotNoDataValue,
+         dfNoDataValue](const void *pData, int nXCheck, int nBufferWidth,
+                        int nYCheck, GUInt32 &nMinOut, GUInt32 &nMaxOut,
+                        GInt16 &nMinInt16Out, GInt16 &nMaxInt16Out)
     {
         if (eDataType == GDT_Byte && !bSignedByte)
         {
@@ -6658,7 +7051,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                                       /* COMPUTE_OTHER_STATS = */ false>::
                 f(nXCheck, nBufferWidth, nYCheck,
                   static_cast<const GByte *>(pData), bHasNoData, nNoDataValue,
-                  nMin, nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                  nMinOut, nMaxOut, nSum, nSumSquare, nSampleCount,
+                  nValidCount);
         }
         else if (eDataType == GDT_UInt16)
         {
@@ -6672,7 +7066,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                                       /* COMPUTE_OTHER_STATS = */ false>::
                 f(nXCheck, nBufferWidth, nYCheck,
                   static_cast<const GUInt16 *>(pData), bHasNoData, nNoDataValue,
-                  nMin, nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                  nMinOut, nMaxOut, nSum, nSumSquare, nSampleCount,
+                  nValidCount);
         }
         else if (eDataType == GDT_Int16)
         {
@@ -6688,7 +7083,7 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                     ComputeMinMax<int16_t, true>(
                         static_cast<const int16_t *>(pData) +
                             static_cast<size_t>(iY) * nBufferWidth,
-                        nXCheck, nNoDataValue, &nMinInt16, &nMaxInt16);
+                        nXCheck, nNoDataValue, &nMinInt16Out, &nMaxInt16Out);
                 }
             }
             else
@@ -6698,7 +7093,7 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                     ComputeMinMax<int16_t, false>(
                         static_cast<const int16_t *>(pData) +
                             static_cast<size_t>(iY) * nBufferWidth,
-                        nXCheck, 0, &nMinInt16, &nMaxInt16);
+                        nXCheck, 0, &nMinInt16Out, &nMaxInt16Out);
                 }
             }
         }
@@ -6764,7 +7159,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
 
         if (bUseOptimizedPath)
         {
-            ComputeMinMaxForBlock(pData, nXReduced, nXReduced, nYReduced);
+            ComputeMinMaxForBlock(pData, nXReduced, nXReduced, nYReduced, nMin,
+                                  nMax, nMinInt16, nMaxInt16);
         }
         else
         {
@@ -6803,41 +7199,70 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                 nSampleRate += 1;
         }
 
+        const int nSlots = GDALGetStatsSlotCount();
         if (bUseOptimizedPath)
         {
-            for (int iSampleBlock = 0;
-                 iSampleBlock < nBlocksPerRow * nBlocksPerColumn;
-                 iSampleBlock += nSampleRate)
+            struct IntMinMax
             {
-                const int iYBlock = iSampleBlock / nBlocksPerRow;
-                const int iXBlock = iSampleBlock - nBlocksPerRow * iYBlock;
-
-                GDALRasterBlock *poBlock = GetLockedBlockRef(iXBlock, iYBlock);
-                if (poBlock == nullptr)
-                    return CE_Failure;
-
-                void *const pData = poBlock->GetDataRef();
-
-                int nXCheck = 0, nYCheck = 0;
-                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-                ComputeMinMaxForBlock(pData, nXCheck, nBlockXSize, nYCheck);
-
-                poBlock->DropLock();
+                GUInt32 nMin;
+                GUInt32 nMax;
+                GInt16 nMinInt16;
+                GInt16 nMaxInt16;
+            };
+            std::vector<IntMinMax> asSlotMinMax(
+                nSlots, IntMinMax{nMin, nMax, nMinInt16, nMaxInt16});
+
+            const auto AddBlockToMinMax =
+                [this, bSignedByte, bGotNoDataValue, &asSlotMinMax,
+                 &ComputeMinMaxForBlock](int iSlot, int /* iBlock */,
+                                         const void *pData,
+                                         const GByte * /* pabyMask */,
+                                         int nXCheck, int nYCheck)
+            {
+                auto &sMinMax = asSlotMinMax[iSlot];
+                if (pData == nullptr)
+                {
+                    // Empty block: all its pixels are at the nodata value,
+                    // or 0.
+                    if (!bGotNoDataValue)
+                    {
+                        sMinMax.nMin = 0;
+                        sMinMax.nMinInt16 = std::min<GInt16>(
+                            sMinMax.nMinInt16, 0);
+                        sMinMax.nMaxInt16 = std::max<GInt16>(
+                            sMinMax.nMaxInt16, 0);
+                    }
+                    return true;
+                }
+                ComputeMinMaxForBlock(pData, nXCheck, nBlockXSize, nYCheck,
+                                      sMinMax.nMin, sMinMax.nMax,
+                                      sMinMax.nMinInt16, sMinMax.nMaxInt16);
+                return !(eDataType == GDT_Byte && !bSignedByte &&
+                         sMinMax.nMin == 0 && sMinMax.nMax == 255);
+            };
+
+            if (GDALIterateSampledBlocks(this, nullptr, nSampleRate, nSlots,
+                                         true, AddBlockToMinMax, nullptr,
+                                         nullptr, nullptr) != CE_None)
+            {
+                return CE_Failure;
+            }
 
-                if (eDataType == GDT_Byte && !bSignedByte && nMin == 0 &&
-                    nMax == 255)
-                    break;
+            for (const auto &sMinMax : asSlotMinMax)
+            {
+                nMin = std::min(nMin, sMinMax.nMin);
+                nMax = std::max(nMax, sMinMax.nMax);
+                nMinInt16 = std::min(nMinInt16, sMinMax.nMinInt16);
+                nMaxInt16 = std::max(nMaxInt16, sMinMax.nMaxInt16);
             }
         }
         else
         {
-            const int nTotalBlocks = nBlocksPerRow * nBlocksPerColumn;
             if (!ComputeMinMaxGenericIterBlocks(
-                    this, eDataType, bSignedByte, nTotalBlocks, nSampleRate,
-                    nBlocksPerRow, CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
-                    bGotFloatNoDataValue, fNoDataValue, poMaskBand, dfMin,
-                    dfMax))
+                    this, eDataType, bSignedByte, nSampleRate, nSlots,
+                    CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
+                    bGotFloatNoDataValue, fNoDataValue, bNoDataIsNaN,
+                    poMaskBand, dfMin, dfMax))
             {
                 return CE_Failure;
             }
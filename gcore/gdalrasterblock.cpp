@@ -33,34 +33,164 @@
 #include "gdal_priv.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <climits>
 #include <cstring>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "cpl_atomic_ops.h"
+#include "cpl_compressor.h"
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 
 static bool bCacheMaxInitialized = false;
 // Will later be overridden by the default 5% if GDAL_CACHEMAX not defined.
 static GIntBig nCacheMax = 40 * 1024 * 1024;
-static GIntBig nCacheUsed = 0;
-
-static GDALRasterBlock *poOldest = nullptr;  // Tail.
-static GDALRasterBlock *poNewest = nullptr;  // Head.
 
 static int nDisableDirtyBlockFlushCounter = 0;
 
-#if 0
-static CPLMutex *hRBLock = nullptr;
-#define INITIALIZE_LOCK CPLMutexHolderD(&hRBLock)
-#define TAKE_LOCK CPLMutexHolderOptionalLockD(hRBLock)
-#define DESTROY_LOCK CPLDestroyMutex(hRBLock)
-#else
+/************************************************************************/
+/*                       GDALRasterBlockCacheShard                      */
+/************************************************************************/
+
+// The global block cache is made of one or several shards (see the
+// GDAL_CACHE_SHARDS configuration option). Each shard has its own LRU list,
+// its own lock and manages a slice of GDAL_CACHEMAX. A block is assigned to
+// a shard from a hash of its band and block coordinates, so that threads
+// working on different blocks rarely compete for the same lock.
+//
+// With the default LRU policy, the list of each shard is ordered from the
+// most recently used block (head) to the least recently used one (tail).
+//
+// With the 2Q policy (GDAL_CACHE_POLICY=2Q), the list is split in two
+// segments: a "protected" segment at the head, with blocks that have been
+// requested again after having been evicted recently, ordered in LRU order,
+// and a "probation" segment at the tail, starting at poMidpoint, with blocks
+// requested only once recently, in FIFO order. Newly loaded blocks are
+// inserted at the midpoint, and eviction starts from the tail, so that a
+// sequential scan only cycles through the probation segment. The keys of
+// blocks evicted from the probation segment are remembered in a bounded
+// "ghost" FIFO, to detect blocks that are re-requested.
+
+namespace
+{
+struct GDALRasterBlockKey
+{
+    const GDALRasterBand *poBand;
+    int nXOff;
+    int nYOff;
+
+    bool operator==(const GDALRasterBlockKey &other) const
+    {
+        return poBand == other.poBand && nXOff == other.nXOff &&
+               nYOff == other.nYOff;
+    }
+};
+
+struct GDALRasterBlockKeyHasher
+{
+    size_t operator()(const GDALRasterBlockKey &key) const
+    {
+        return std::hash<const void *>()(key.poBand) ^
+               (static_cast<size_t>(key.nXOff) * 31 +
+                static_cast<size_t>(key.nYOff) * 1000003);
+    }
+};
+
+struct alignas(64) GDALRasterBlockCacheShard
+{
+    CPLLock *hLock = nullptr;
+    GDALRasterBlock *poOldest = nullptr;  // Tail.
+    GDALRasterBlock *poNewest = nullptr;  // Head.
+    GIntBig nCacheUsed = 0;
+
+    // Only used by the 2Q policy
+    GDALRasterBlock *poMidpoint = nullptr;  // Head of probation segment
+    GIntBig nProtectedUsed = 0;
+    std::unordered_set<GDALRasterBlockKey, GDALRasterBlockKeyHasher>
+        oGhostSet{};
+    std::deque<std::pair<GDALRasterBlockKey, GIntBig>> oGhostFIFO{};
+    GIntBig nGhostSize = 0;
+
+    // Statistics
+    std::atomic<GIntBig> nHits{0};
+    std::atomic<GIntBig> nMisses{0};
+    std::atomic<GIntBig> nEvictions{0};
+    // Only updated when GDAL_CACHE_LOCK_TIMING=YES
+    std::atomic<GIntBig> nLockWaitTimeNs{0};
+};
+
+/************************************************************************/
+/*                       GDALCompressedBlockCache                       */
+/************************************************************************/
+
+// Optional second tier of the block cache (see GDAL_COMPRESSED_CACHEMAX).
+// Clean blocks of read-only bands evicted from the above cache are kept
+// compressed in it, and are decompressed when they are requested again,
+// instead of being read again from the dataset. Entries are removed when
+// they are loaded back in the main cache, or when their band is destroyed.
+// Oldest entries are discarded when the budget is exceeded.
+
+struct GDALCompressedBlock
+{
+    GDALRasterBlockKey sKey{};
+    std::vector<GByte> abyData{};
+};
+
+struct GDALCompressedBlockCache
+{
+    std::mutex oMutex{};
+    GIntBig nMax = 0;
+    GIntBig nUsed = 0;
+    const CPLCompressor *psCompressor = nullptr;
+    const CPLCompressor *psDecompressor = nullptr;
+    CPLStringList aosOptions{};
+
+    // Most recently stored block at the front
+    std::list<GDALCompressedBlock> oList{};
+    // Blocks indexed by band and block offsets
+    std::unordered_map<const GDALRasterBand *,
+                       std::unordered_map<GUInt64, decltype(oList)::iterator>>
+        oMap{};
+
+    std::atomic<GIntBig> nHits{0};
+};
+}  // namespace
+
+static GDALCompressedBlockCache *poCompressedCache = nullptr;
+
+static GUInt64 GetCompressedBlockIndex(int nXOff, int nYOff)
+{
+    return (static_cast<GUInt64>(static_cast<GUInt32>(nYOff)) << 32) |
+           static_cast<GUInt32>(nXOff);
+}
+
+constexpr int MAX_CACHE_SHARDS = 64;
+static GDALRasterBlockCacheShard asShards[MAX_CACHE_SHARDS];
+static int nShardCount = 0;
+static int nFlushShardStart = 0;
+static bool b2QPolicy = false;
+static bool bLockTiming = false;
+
+// Background write-back of dirty blocks (see GDAL_CACHE_WRITEBACK)
+static CPLWorkerThreadPool *poWriteBackPool = nullptr;
+static int nWriteBackWatermark = 75;  // in percentage of nCacheMax
+static std::atomic<bool> bWriteBackScheduled{false};
+
+// Dirty blocks written by GDALRasterBlock::Write()
+static std::atomic<GIntBig> nDirtyBlockWrites{0};
+static std::atomic<GIntBig> nDirtyBlockWriteTimeNs{0};
 
-static CPLLock *hRBLock = nullptr;
 static bool bDebugContention = false;
 static bool bSleepsForBockCacheDebug = false;
 static CPLLockType GetLockType()
@@ -90,13 +220,282 @@ static CPLLockType GetLockType()
     return static_cast<CPLLockType>(nLockType);
 }
 
-#define INITIALIZE_LOCK                                                        \
-    CPLLockHolderD(&hRBLock, GetLockType());                                   \
-    CPLLockSetDebugPerf(hRBLock, bDebugContention)
-#define TAKE_LOCK CPLLockHolderOptionalLockD(hRBLock)
-#define DESTROY_LOCK CPLDestroyLock(hRBLock)
+/************************************************************************/
+/*                         GetShardCountOption()                        */
+/************************************************************************/
 
-#endif
+static int GetShardCountOption()
+{
+    const char *pszShards = CPLGetConfigOption("GDAL_CACHE_SHARDS", "1");
+    int nShards;
+    if (EQUAL(pszShards, "AUTO"))
+    {
+        // Round the number of CPUs to the next power of two
+        const int nCPUs = CPLGetNumCPUs();
+        nShards = 1;
+        while (nShards < nCPUs && nShards < MAX_CACHE_SHARDS)
+            nShards *= 2;
+    }
+    else
+    {
+        nShards = atoi(pszShards);
+        if (nShards < 1 || nShards > MAX_CACHE_SHARDS)
+        {
+            CPLError(CE_Warning, CPLE_NotSupported,
+                     "GDAL_CACHE_SHARDS=%s not supported. Must be AUTO or an "
+                     "integer between 1 and %d. Using 1",
+                     pszShards, MAX_CACHE_SHARDS);
+            nShards = 1;
+        }
+    }
+    return nShards;
+}
+
+/************************************************************************/
+/*                      InitializeCompressedCache()                     */
+/************************************************************************/
+
+static void InitializeCompressedCache()
+{
+    const char *pszMax = CPLGetConfigOption("GDAL_COMPRESSED_CACHEMAX", "0");
+    GIntBig nMax;
+    if (strchr(pszMax, '%') != nullptr)
+    {
+        const GIntBig nUsablePhysicalRAM = CPLGetUsablePhysicalRAM();
+        const double dfMax = static_cast<double>(nUsablePhysicalRAM) *
+                             CPLAtof(pszMax) / 100.0;
+        nMax = (dfMax >= 0 && dfMax < 1e15) ? static_cast<GIntBig>(dfMax) : 0;
+    }
+    else
+    {
+        nMax = CPLAtoGIntBig(pszMax);
+        if (nMax > 0 && nMax < 100000)
+            nMax *= 1024 * 1024;
+    }
+    if (nMax <= 0)
+        return;
+
+    const char *pszCodec =
+        CPLGetConfigOption("GDAL_COMPRESSED_CACHE_CODEC", nullptr);
+    const char *const apszCandidates[] = {"lz4", "zstd", "zlib"};
+    const CPLCompressor *psCompressor = nullptr;
+    const CPLCompressor *psDecompressor = nullptr;
+    if (pszCodec)
+    {
+        psCompressor = CPLGetCompressor(pszCodec);
+        psDecompressor = CPLGetDecompressor(pszCodec);
+    }
+    else
+    {
+        for (const char *pszCandidate : apszCandidates)
+        {
+            psCompressor = CPLGetCompressor(pszCandidate);
+            psDecompressor = CPLGetDecompressor(pszCandidate);
+            if (psCompressor && psDecompressor)
+                break;
+        }
+    }
+    if (!psCompressor || !psDecompressor ||
+        psCompressor->eType != CCT_COMPRESSOR)
+    {
+        CPLError(CE_Warning, CPLE_NotSupported,
+                 "Compressor %s not available. Compressed block cache "
+                 "disabled",
+                 pszCodec ? pszCodec : "lz4");
+        return;
+    }
+
+    if (poCompressedCache == nullptr)
+        poCompressedCache = new GDALCompressedBlockCache();
+    poCompressedCache->nMax = nMax;
+    poCompressedCache->psCompressor = psCompressor;
+    poCompressedCache->psDecompressor = psDecompressor;
+    poCompressedCache->aosOptions.Clear();
+    if (EQUAL(psCompressor->pszId, "lz4"))
+        poCompressedCache->aosOptions.SetNameValue("HEADER", "NO");
+    else if (EQUAL(psCompressor->pszId, "zstd") ||
+             EQUAL(psCompressor->pszId, "zlib"))
+        poCompressedCache->aosOptions.SetNameValue("LEVEL", "1");
+    CPLDebug("GDAL", "GDAL_COMPRESSED_CACHEMAX = " CPL_FRMT_GIB " MB (%s)",
+             nMax / (1024 * 1024), psCompressor->pszId);
+}
+
+/************************************************************************/
+/*                          InitializeShards()                          */
+/************************************************************************/
+
+// The lock of the first shard also serves as the lock protecting the
+// initialization of the other shards.
+static void InitializeShards()
+{
+    CPLLockHolderD(&asShards[0].hLock, GetLockType());
+    CPLLockSetDebugPerf(asShards[0].hLock, bDebugContention);
+    if (nShardCount == 0)
+    {
+        const int nShards = GetShardCountOption();
+        for (int i = 1; i < nShards; ++i)
+        {
+            if (asShards[i].hLock == nullptr)
+            {
+                asShards[i].hLock = CPLCreateLock(GetLockType());
+                CPLLockSetDebugPerf(asShards[i].hLock, bDebugContention);
+            }
+        }
+        if (nShards > 1)
+            CPLDebug("GDAL", "Block cache split into %d shards", nShards);
+
+        InitializeCompressedCache();
+
+        const char *pszPolicy = CPLGetConfigOption("GDAL_CACHE_POLICY", "LRU");
+        if (EQUAL(pszPolicy, "2Q"))
+        {
+            b2QPolicy = true;
+        }
+        else
+        {
+            if (!EQUAL(pszPolicy, "LRU"))
+            {
+                CPLError(CE_Warning, CPLE_NotSupported,
+                         "GDAL_CACHE_POLICY=%s not supported. Using LRU",
+                         pszPolicy);
+            }
+            b2QPolicy = false;
+        }
+        bLockTiming = CPLTestBool(
+            CPLGetConfigOption("GDAL_CACHE_LOCK_TIMING", "NO"));
+
+        if (poWriteBackPool == nullptr &&
+            CPLTestBool(CPLGetConfigOption("GDAL_CACHE_WRITEBACK", "NO")))
+        {
+            nWriteBackWatermark = std::max(
+                1, std::min(100, atoi(CPLGetConfigOption(
+                                     "GDAL_CACHE_WRITEBACK_WATERMARK", "75"))));
+            // A dedicated thread is used, rather than the global thread pool,
+            // since drivers may themselves submit jobs to the latter from
+            // IWriteBlock() and wait for their completion.
+            poWriteBackPool = new CPLWorkerThreadPool();
+            if (!poWriteBackPool->Setup(1, nullptr, nullptr, false))
+            {
+                delete poWriteBackPool;
+                poWriteBackPool = nullptr;
+            }
+            else
+            {
+                CPLDebug("GDAL",
+                         "Write-back of dirty blocks above %d%% of the cache",
+                         nWriteBackWatermark);
+            }
+        }
+
+        nShardCount = nShards;
+    }
+}
+
+/************************************************************************/
+/*                        GDALShardLockHolder                           */
+/************************************************************************/
+
+namespace
+{
+// Same as CPLLockHolder, except that the time spent waiting for the lock
+// is accumulated in the shard statistics when GDAL_CACHE_LOCK_TIMING=YES.
+class GDALShardLockHolder
+{
+    CPLLock *hLock = nullptr;
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALShardLockHolder)
+
+  public:
+    explicit GDALShardLockHolder(GDALRasterBlockCacheShard *psShard)
+        : hLock(psShard->hLock)
+    {
+        if (hLock == nullptr)
+            return;
+        if (bLockTiming)
+        {
+            const auto nStart = std::chrono::steady_clock::now();
+            if (!CPLAcquireLock(hLock))
+                hLock = nullptr;
+            psShard->nLockWaitTimeNs.fetch_add(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - nStart)
+                    .count(),
+                std::memory_order_relaxed);
+        }
+        else if (!CPLAcquireLock(hLock))
+        {
+            hLock = nullptr;
+        }
+        if (hLock == nullptr)
+            fprintf(stderr, "GDALShardLockHolder: Failed to acquire lock!\n");
+    }
+
+    ~GDALShardLockHolder()
+    {
+        if (hLock != nullptr)
+            CPLReleaseLock(hLock);
+    }
+};
+}  // namespace
+
+#define INITIALIZE_LOCK InitializeShards()
+#define TAKE_SHARD_LOCK(psShard) GDALShardLockHolder oHolder(psShard)
+#define TAKE_LOCK TAKE_SHARD_LOCK(&asShards[nShard])
+
+/************************************************************************/
+/*                            GetShardIndex()                           */
+/************************************************************************/
+
+static int GetShardIndex(const GDALRasterBand *poBand, int nXOff, int nYOff)
+{
+    if (nShardCount <= 1)
+        return 0;
+    // Mix the band pointer and the block coordinates (64-bit finalizer of
+    // MurmurHash3) so that consecutive blocks spread over all shards.
+    GUInt64 nHash = static_cast<GUInt64>(reinterpret_cast<GUIntptr_t>(poBand));
+    nHash ^= (static_cast<GUInt64>(static_cast<GUInt32>(nYOff)) << 32) |
+             static_cast<GUInt32>(nXOff);
+    nHash ^= nHash >> 33;
+    nHash *= 0xff51afd7ed558ccdULL;
+    nHash ^= nHash >> 33;
+    nHash *= 0xc4ceb9fe1a85ec53ULL;
+    nHash ^= nHash >> 33;
+    return static_cast<int>(nHash % static_cast<unsigned>(nShardCount));
+}
+
+/************************************************************************/
+/*                          GetShardCacheMax()                          */
+/************************************************************************/
+
+static GIntBig GetShardCacheMax(GIntBig nCurCacheMax)
+{
+    return nShardCount <= 1 ? nCurCacheMax : nCurCacheMax / nShardCount;
+}
+
+/************************************************************************/
+/*                        RememberEvictedBlock()                        */
+/************************************************************************/
+
+// 2Q policy: record the key of a block evicted from the probation segment.
+// The ghost FIFO is bounded to half of the shard budget (in terms of the
+// size of the blocks it represents).
+static void RememberEvictedBlock(GDALRasterBlockCacheShard *psShard,
+                                 const GDALRasterBlockKey &sKey,
+                                 GIntBig nBlockSize)
+{
+    if (!psShard->oGhostSet.insert(sKey).second)
+        return;
+    psShard->oGhostFIFO.emplace_back(sKey, nBlockSize);
+    psShard->nGhostSize += nBlockSize;
+    const GIntBig nGhostMax = GetShardCacheMax(nCacheMax) / 2;
+    while (psShard->nGhostSize > nGhostMax && !psShard->oGhostFIFO.empty())
+    {
+        const auto &oOldest = psShard->oGhostFIFO.front();
+        psShard->oGhostSet.erase(oOldest.first);
+        psShard->nGhostSize -= oOldest.second;
+        psShard->oGhostFIFO.pop_front();
+    }
+}
 
 // #define ENABLE_DEBUG
 
@@ -163,13 +562,13 @@ void CPL_STDCALL GDALSetCacheMax64(GIntBig nNewSizeInBytes)
     /*      Flush blocks till we are under the new limit or till we         */
     /*      can't seem to flush anymore.                                    */
     /* -------------------------------------------------------------------- */
-    while (nCacheUsed > nCacheMax)
+    while (GDALGetCacheUsed64() > nCacheMax)
     {
-        const GIntBig nOldCacheUsed = nCacheUsed;
+        const GIntBig nOldCacheUsed = GDALGetCacheUsed64();
 
         GDALFlushCacheBlock();
 
-        if (nCacheUsed == nOldCacheUsed)
+        if (GDALGetCacheUsed64() == nOldCacheUsed)
             break;
     }
 }
@@ -321,6 +720,7 @@ GIntBig CPL_STDCALL GDALGetCacheMax64()
 
 int CPL_STDCALL GDALGetCacheUsed()
 {
+    const GIntBig nCacheUsed = GDALGetCacheUsed64();
     if (nCacheUsed > INT_MAX)
     {
         static bool bHasWarned = false;
@@ -351,9 +751,79 @@ int CPL_STDCALL GDALGetCacheUsed()
 
 GIntBig CPL_STDCALL GDALGetCacheUsed64()
 {
+    GIntBig nCacheUsed = asShards[0].nCacheUsed;
+    for (int i = 1; i < nShardCount; ++i)
+        nCacheUsed += asShards[i].nCacheUsed;
     return nCacheUsed;
 }
 
+/************************************************************************/
+/*                       GDALGetCacheStatistics()                       */
+/************************************************************************/
+
+/**
+ * \brief Get statistics on the raster block cache.
+ *
+ * The counters are accumulated since the start of the process, or since the
+ * last call to GDALResetCacheStatistics(). The memory used by the blocks
+ * of a given dataset can be retrieved with GDALDatasetGetBlockCacheUsed().
+ *
+ * @param psStats Pointer to a structure to fill. Must not be NULL.
+ *
+ * @since GDAL 3.9
+ */
+
+void GDALGetCacheStatistics(GDALCacheStatistics *psStats)
+{
+    VALIDATE_POINTER0(psStats, "GDALGetCacheStatistics");
+    memset(psStats, 0, sizeof(*psStats));
+    for (const auto &sShard : asShards)
+    {
+        psStats->nHits += sShard.nHits.load(std::memory_order_relaxed);
+        psStats->nMisses += sShard.nMisses.load(std::memory_order_relaxed);
+        psStats->nEvictions +=
+            sShard.nEvictions.load(std::memory_order_relaxed);
+        psStats->dfLockWaitTime +=
+            sShard.nLockWaitTimeNs.load(std::memory_order_relaxed) * 1e-9;
+    }
+    psStats->nDirtyBlockWrites =
+        nDirtyBlockWrites.load(std::memory_order_relaxed);
+    psStats->dfDirtyBlockWriteTime =
+        nDirtyBlockWriteTimeNs.load(std::memory_order_relaxed) * 1e-9;
+    if (poCompressedCache)
+    {
+        psStats->nCompressedHits =
+            poCompressedCache->nHits.load(std::memory_order_relaxed);
+        std::lock_guard<std::mutex> oLock(poCompressedCache->oMutex);
+        psStats->nCompressedUsed = poCompressedCache->nUsed;
+    }
+}
+
+/************************************************************************/
+/*                      GDALResetCacheStatistics()                      */
+/************************************************************************/
+
+/**
+ * \brief Reset the counters returned by GDALGetCacheStatistics().
+ *
+ * @since GDAL 3.9
+ */
+
+void GDALResetCacheStatistics()
+{
+    for (auto &sShard : asShards)
+    {
+        sShard.nHits = 0;
+        sShard.nMisses = 0;
+        sShard.nEvictions = 0;
+        sShard.nLockWaitTimeNs = 0;
+    }
+    nDirtyBlockWrites = 0;
+    nDirtyBlockWriteTimeNs = 0;
+    if (poCompressedCache)
+        poCompressedCache->nHits = 0;
+}
+
 /************************************************************************/
 /*                        GDALFlushCacheBlock()                         */
 /*                                                                      */
@@ -431,11 +901,21 @@ int CPL_STDCALL GDALFlushCacheBlock()
 int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
 
 {
-    GDALRasterBlock *poTarget;
+    GDALRasterBlock *poTarget = nullptr;
 
-    {
+    if (nShardCount == 0)
         INITIALIZE_LOCK;
-        poTarget = poOldest;
+
+    // Start from a different shard at each call, so that repeated calls
+    // drain all shards evenly.
+    const int nShards = nShardCount;
+    const int iStart = CPLAtomicInc(&nFlushShardStart) & 0x7FFFFFFF;
+    for (int iIter = 0; iIter < nShards && poTarget == nullptr; ++iIter)
+    {
+        GDALRasterBlockCacheShard *psShard =
+            &asShards[(iStart + iIter) % nShards];
+        TAKE_SHARD_LOCK(psShard);
+        poTarget = psShard->poOldest;
 
         while (poTarget != nullptr)
         {
@@ -449,7 +929,7 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
         }
 
         if (poTarget == nullptr)
-            return FALSE;
+            continue;
         if (bSleepsForBockCacheDebug)
         {
             // coverity[tainted_data]
@@ -459,10 +939,12 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
                 CPLSleep(dfDelay);
         }
 
-        poTarget->Detach_unlocked();
-        poTarget->GetBand()->UnreferenceBlock(poTarget);
+        poTarget->Evict_unlocked();
     }
 
+    if (poTarget == nullptr)
+        return FALSE;
+
     if (bSleepsForBockCacheDebug)
     {
         // coverity[tainted_data]
@@ -481,14 +963,51 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
             poTarget->GetBand()->SetFlushBlockErr(eErr);
         }
     }
+    else
+    {
+        poTarget->StoreInCompressedCache();
+    }
 
-    VSIFreeAligned(poTarget->pData);
+    VSIFreeLarge(poTarget->pData);
     poTarget->pData = nullptr;
     poTarget->GetBand()->AddBlockToFreeList(poTarget);
 
     return TRUE;
 }
 
+/************************************************************************/
+/*                          ScheduleWriteBack()                         */
+/************************************************************************/
+
+// Submits a write-back job if the cache usage is above the watermark and
+// no job is already running. The job flushes the least recently used dirty
+// blocks (using the same protocol as FlushCacheBlock() so that it is safe
+// against concurrent destruction of their band), until the usage has
+// dropped 10% below the watermark, so that threads calling Internalize()
+// find clean blocks to evict instead of having to write them themselves.
+
+void GDALRasterBlock::ScheduleWriteBack()
+{
+    if (GDALGetCacheUsed64() <= nCacheMax / 100 * nWriteBackWatermark)
+        return;
+    if (bWriteBackScheduled.exchange(true))
+        return;
+    if (!poWriteBackPool->SubmitJob(WriteBackFunc, nullptr))
+        bWriteBackScheduled = false;
+}
+
+void GDALRasterBlock::WriteBackFunc(void *)
+{
+    const GIntBig nLowWatermark =
+        nCacheMax / 100 * std::max(0, nWriteBackWatermark - 10);
+    while (GDALGetCacheUsed64() > nLowWatermark)
+    {
+        if (!FlushCacheBlock(TRUE))
+            break;
+    }
+    bWriteBackScheduled = false;
+}
+
 /************************************************************************/
 /*                          FlushDirtyBlocks()                          */
 /************************************************************************/
@@ -582,7 +1101,8 @@ GDALRasterBlock::GDALRasterBlock(GDALRasterBand *poBandIn, int nXOffIn,
                                  int nYOffIn)
     : eType(poBandIn->GetRasterDataType()), bDirty(false), nLockCount(0),
       nXOff(nXOffIn), nYOff(nYOffIn), nXSize(0), nYSize(0), pData(nullptr),
-      poBand(poBandIn), poNext(nullptr), poPrevious(nullptr), bMustDetach(true)
+      poBand(poBandIn), poNext(nullptr), poPrevious(nullptr), bMustDetach(true),
+      nShard(0), bProtected(false)
 {
     CPLAssert(poBandIn != nullptr);
     poBand->GetBlockSize(&nXSize, &nYSize);
@@ -609,7 +1129,8 @@ GDALRasterBlock::GDALRasterBlock(GDALRasterBand *poBandIn, int nXOffIn,
 GDALRasterBlock::GDALRasterBlock(int nXOffIn, int nYOffIn)
     : eType(GDT_Unknown), bDirty(false), nLockCount(0), nXOff(nXOffIn),
       nYOff(nYOffIn), nXSize(0), nYSize(0), pData(nullptr), poBand(nullptr),
-      poNext(nullptr), poPrevious(nullptr), bMustDetach(false)
+      poNext(nullptr), poPrevious(nullptr), bMustDetach(false), nShard(0),
+      bProtected(false)
 {
 }
 
@@ -636,6 +1157,8 @@ void GDALRasterBlock::RecycleFor(int nXOffIn, int nYOffIn)
     nXOff = nXOffIn;
     nYOff = nYOffIn;
     bMustDetach = true;
+    nShard = 0;
+    bProtected = false;
 }
 
 /************************************************************************/
@@ -655,7 +1178,7 @@ GDALRasterBlock::~GDALRasterBlock()
 
     if (pData != nullptr)
     {
-        VSIFreeAligned(pData);
+        VSIFreeLarge(pData);
     }
 
     CPLAssert(nLockCount <= 0);
@@ -705,12 +1228,22 @@ void GDALRasterBlock::Detach()
 
 void GDALRasterBlock::Detach_unlocked()
 {
-    if (poOldest == this)
-        poOldest = poPrevious;
+    GDALRasterBlockCacheShard *psShard = &asShards[nShard];
+    if (psShard->poOldest == this)
+        psShard->poOldest = poPrevious;
 
-    if (poNewest == this)
+    if (psShard->poMidpoint == this)
+        psShard->poMidpoint = poNext;
+
+    if (bProtected)
+    {
+        psShard->nProtectedUsed -= GetEffectiveBlockSize(GetBlockSize());
+        bProtected = false;
+    }
+
+    if (psShard->poNewest == this)
     {
-        poNewest = poNext;
+        psShard->poNewest = poNext;
     }
 
     if (poPrevious != nullptr)
@@ -724,7 +1257,13 @@ void GDALRasterBlock::Detach_unlocked()
     bMustDetach = false;
 
     if (pData)
-        nCacheUsed -= GetEffectiveBlockSize(GetBlockSize());
+    {
+        const GIntBig nEffectiveSize = GetEffectiveBlockSize(GetBlockSize());
+        psShard->nCacheUsed -= nEffectiveSize;
+        GDALDataset *poDS = poBand ? poBand->GetDataset() : nullptr;
+        if (poDS)
+            poDS->AddBlockCacheUsed(-nEffectiveSize);
+    }
 
 #ifdef ENABLE_DEBUG
     Verify();
@@ -744,26 +1283,37 @@ void GDALRasterBlock::Detach_unlocked()
 void GDALRasterBlock::Verify()
 
 {
-    TAKE_LOCK;
-
-    CPLAssert((poNewest == nullptr && poOldest == nullptr) ||
-              (poNewest != nullptr && poOldest != nullptr));
-
-    if (poNewest != nullptr)
+    for (int i = 0; i < std::max(1, nShardCount); ++i)
     {
-        CPLAssert(poNewest->poPrevious == nullptr);
-        CPLAssert(poOldest->poNext == nullptr);
+        GDALRasterBlockCacheShard *psShard = &asShards[i];
+        TAKE_SHARD_LOCK(psShard);
+        GDALRasterBlock *poNewest = psShard->poNewest;
+        GDALRasterBlock *poOldest = psShard->poOldest;
+
+        CPLAssert((poNewest == nullptr && poOldest == nullptr) ||
+                  (poNewest != nullptr && poOldest != nullptr));
 
-        GDALRasterBlock *poLast = nullptr;
-        for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
-             poBlock = poBlock->poNext)
+        if (poNewest != nullptr)
         {
-            CPLAssert(poBlock->poPrevious == poLast);
+            CPLAssert(poNewest->poPrevious == nullptr);
+            CPLAssert(poOldest->poNext == nullptr);
 
-            poLast = poBlock;
-        }
+            GDALRasterBlock *poLast = nullptr;
+            bool bInProbation = false;
+            for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
+                 poBlock = poBlock->poNext)
+            {
+                CPLAssert(poBlock->poPrevious == poLast);
+                CPLAssert(poBlock->nShard == i);
+                if (poBlock == psShard->poMidpoint)
+                    bInProbation = true;
+                CPLAssert(!b2QPolicy || poBlock->bProtected == !bInProbation);
 
-        CPLAssert(poOldest == poLast);
+                poLast = poBlock;
+            }
+
+            CPLAssert(poOldest == poLast);
+        }
     }
 }
 
@@ -776,8 +1326,10 @@ void GDALRasterBlock::Verify()
 #ifdef notdef
 void GDALRasterBlock::CheckNonOrphanedBlocks(GDALRasterBand *poBand)
 {
-    TAKE_LOCK;
-    for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
+    for (int i = 0; i < std::max(1, nShardCount); ++i)
+    {
+    TAKE_SHARD_LOCK(&asShards[i]);
+    for (GDALRasterBlock *poBlock = asShards[i].poNewest; poBlock != nullptr;
          poBlock = poBlock->poNext)
     {
         if (poBlock->GetBand() == poBand)
@@ -796,6 +1348,7 @@ void GDALRasterBlock::CheckNonOrphanedBlocks(GDALRasterBand *poBand)
                        poBand->GetDataset()->GetDescription());
         }
     }
+    }
 }
 #endif
 
@@ -826,10 +1379,17 @@ CPLErr GDALRasterBlock::Write()
 
     if (poBand->eFlushBlockErr == CE_None)
     {
+        const auto nStart = std::chrono::steady_clock::now();
         int bCallLeaveReadWrite = poBand->EnterReadWrite(GF_Write);
         CPLErr eErr = poBand->IWriteBlock(nXOff, nYOff, pData);
         if (bCallLeaveReadWrite)
             poBand->LeaveReadWrite();
+        nDirtyBlockWrites.fetch_add(1, std::memory_order_relaxed);
+        nDirtyBlockWriteTimeNs.fetch_add(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - nStart)
+                .count(),
+            std::memory_order_relaxed);
         return eErr;
     }
     else
@@ -850,8 +1410,13 @@ CPLErr GDALRasterBlock::Write()
 void GDALRasterBlock::Touch()
 
 {
+    // With the 2Q policy, blocks of the probation segment are managed
+    // in FIFO order, so there is nothing to do.
+    if (b2QPolicy && !bProtected)
+        return;
+
     // Can be safely tested outside the lock
-    if (poNewest == this)
+    if (asShards[nShard].poNewest == this)
         return;
 
     TAKE_LOCK;
@@ -867,6 +1432,9 @@ void GDALRasterBlock::Touch_unlocked()
     // 1. Thread 1 calls Touch() and poNewest != this at that point
     // 2. Thread 2 detaches poNewest
     // 3. Thread 1 arrives here
+    GDALRasterBlockCacheShard *psShard = &asShards[nShard];
+    GDALRasterBlock *&poNewest = psShard->poNewest;
+    GDALRasterBlock *&poOldest = psShard->poOldest;
     if (poNewest == this)
         return;
 
@@ -877,6 +1445,9 @@ void GDALRasterBlock::Touch_unlocked()
     if (poOldest == this)
         poOldest = this->poPrevious;
 
+    if (psShard->poMidpoint == this)
+        psShard->poMidpoint = poNext;
+
     if (poPrevious != nullptr)
         poPrevious->poNext = poNext;
 
@@ -903,6 +1474,91 @@ void GDALRasterBlock::Touch_unlocked()
 #endif
 }
 
+/************************************************************************/
+/*                         Insert2Q_unlocked()                          */
+/************************************************************************/
+
+// Insert a newly loaded block in the list of its shard, with the 2Q policy.
+void GDALRasterBlock::Insert2Q_unlocked()
+{
+    GDALRasterBlockCacheShard *psShard = &asShards[nShard];
+    CPLAssert(poPrevious == nullptr && poNext == nullptr);
+
+    const GDALRasterBlockKey sKey{poBand, nXOff, nYOff};
+    if (psShard->oGhostSet.erase(sKey))
+    {
+        // The block has been recently evicted: it is part of the working
+        // set and goes to the head of the protected segment.
+        bProtected = true;
+        psShard->nProtectedUsed += GetEffectiveBlockSize(GetBlockSize());
+        Touch_unlocked();
+
+        // Demote the least recently used protected blocks to the probation
+        // segment, so that the latter one keeps at least a fourth of the
+        // budget of the shard.
+        const GIntBig nProtectedMax = GetShardCacheMax(nCacheMax) / 4 * 3;
+        while (psShard->nProtectedUsed > nProtectedMax)
+        {
+            GDALRasterBlock *poLastProtected =
+                psShard->poMidpoint ? psShard->poMidpoint->poPrevious
+                                    : psShard->poOldest;
+            if (poLastProtected == nullptr || !poLastProtected->bProtected)
+                break;
+            poLastProtected->bProtected = false;
+            psShard->nProtectedUsed -=
+                GetEffectiveBlockSize(poLastProtected->GetBlockSize());
+            psShard->poMidpoint = poLastProtected;
+        }
+        return;
+    }
+
+    // Otherwise insert it at the head of the probation segment.
+    if (psShard->poMidpoint != nullptr)
+    {
+        poPrevious = psShard->poMidpoint->poPrevious;
+        poNext = psShard->poMidpoint;
+        if (poPrevious != nullptr)
+            poPrevious->poNext = this;
+        else
+            psShard->poNewest = this;
+        psShard->poMidpoint->poPrevious = this;
+    }
+    else if (psShard->poOldest != nullptr)
+    {
+        poPrevious = psShard->poOldest;
+        psShard->poOldest->poNext = this;
+        psShard->poOldest = this;
+    }
+    else
+    {
+        psShard->poNewest = this;
+        psShard->poOldest = this;
+    }
+    psShard->poMidpoint = this;
+#ifdef ENABLE_DEBUG
+    Verify();
+#endif
+}
+
+/************************************************************************/
+/*                           Evict_unlocked()                           */
+/************************************************************************/
+
+// Remove a block, whose lock count has been set to -1, from the list of its
+// shard and from its band, in order to recover its memory.
+void GDALRasterBlock::Evict_unlocked()
+{
+    GDALRasterBlockCacheShard *psShard = &asShards[nShard];
+    psShard->nEvictions.fetch_add(1, std::memory_order_relaxed);
+    if (b2QPolicy && !bProtected)
+    {
+        RememberEvictedBlock(psShard, GDALRasterBlockKey{poBand, nXOff, nYOff},
+                             GetEffectiveBlockSize(GetBlockSize()));
+    }
+    Detach_unlocked();
+    poBand->UnreferenceBlock(this);
+}
+
 /************************************************************************/
 /*                            Internalize()                             */
 /************************************************************************/
@@ -925,9 +1581,18 @@ CPLErr GDALRasterBlock::Internalize()
 
     void *pNewData = nullptr;
 
-    // This call will initialize the hRBLock mutex. Other call places can
+    // This call will initialize the block cache locks. Other call places can
     // only be called if we have go through there.
-    const GIntBig nCurCacheMax = GDALGetCacheMax64();
+    GDALGetCacheMax64();
+    if (nShardCount == 0)
+        INITIALIZE_LOCK;
+
+    // Each shard is given its own slice of the global cache budget.
+    nShard = GetShardIndex(poBand, nXOff, nYOff);
+    GDALRasterBlockCacheShard *psShard = &asShards[nShard];
+    GIntBig &nCacheUsed = psShard->nCacheUsed;
+    const GIntBig nCurCacheMax = GetShardCacheMax(nCacheMax);
+    psShard->nMisses.fetch_add(1, std::memory_order_relaxed);
 
     // No risk of overflow as it is checked in GDALRasterBand::InitBlockInfo().
     const auto nSizeInBytes = GetBlockSize();
@@ -938,6 +1603,28 @@ CPLErr GDALRasterBlock::Internalize()
     bool bFirstIter = true;
     bool bLoopAgain = false;
     GDALDataset *poThisDS = poBand->GetDataset();
+
+    // Per-dataset quota (see GDALDataset::SetBlockCacheQuota()): when it is
+    // exceeded, only blocks of this dataset are evicted.
+    const GIntBig nDSQuota = poThisDS ? poThisDS->GetBlockCacheQuota() : 0;
+    bool bQuotaCanEvict = nDSQuota > 0;
+    const auto IsOverBudget = [&]()
+    {
+        return nCacheUsed > nCurCacheMax ||
+               (bQuotaCanEvict && poThisDS->GetBlockCacheUsed() > nDSQuota);
+    };
+
+    // Blocks of datasets with a higher priority than ours are evicted only
+    // as a last resort (see GDALDataset::SetBlockCachePriority()).
+    const int nThisPriority =
+        poThisDS ? poThisDS->GetBlockCachePriority() : 0;
+    const auto IsProtected = [nThisPriority](const GDALRasterBlock *poBlock)
+    {
+        const GDALDataset *poDS = poBlock->poBand->GetDataset();
+        return poDS && poDS->GetBlockCachePriority() > nThisPriority;
+    };
+
+    const GIntBig nEffectiveSize = GetEffectiveBlockSize(nSizeInBytes);
     do
     {
         bLoopAgain = false;
@@ -947,11 +1634,19 @@ CPLErr GDALRasterBlock::Internalize()
             TAKE_LOCK;
 
             if (bFirstIter)
-                nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
-            GDALRasterBlock *poTarget = poOldest;
-            while (nCacheUsed > nCurCacheMax)
             {
+                nCacheUsed += nEffectiveSize;
+                if (poThisDS)
+                    poThisDS->AddBlockCacheUsed(nEffectiveSize);
+            }
+            GDALRasterBlock *poTarget = psShard->poOldest;
+            while (IsOverBudget())
+            {
+                // If the global budget is respected, we are only here
+                // to honour the dataset quota.
+                const bool bOnlyThisDataset = nCacheUsed <= nCurCacheMax;
                 GDALRasterBlock *poDirtyBlockOtherDataset = nullptr;
+                GDALRasterBlock *poProtectedBlock = nullptr;
                 // In this first pass, only discard dirty blocks of this
                 // dataset. We do this to decrease significantly the likelihood
                 // of the following weakness of the block cache design:
@@ -963,7 +1658,26 @@ CPLErr GDALRasterBlock::Internalize()
                 //    so gets the old value.
                 while (poTarget != nullptr)
                 {
-                    if (!poTarget->GetDirty())
+                    if (bOnlyThisDataset)
+                    {
+                        if (poTarget->poBand->GetDataset() == poThisDS &&
+                            (!poTarget->GetDirty() ||
+                             nDisableDirtyBlockFlushCounter == 0) &&
+                            CPLAtomicCompareAndExchange(&(poTarget->nLockCount),
+                                                        0, -1))
+                            break;
+                    }
+                    else if (poTarget->poBand->GetDataset() != poThisDS &&
+                             IsProtected(poTarget))
+                    {
+                        if (poProtectedBlock == nullptr &&
+                            (!poTarget->GetDirty() ||
+                             nDisableDirtyBlockFlushCounter == 0))
+                        {
+                            poProtectedBlock = poTarget;
+                        }
+                    }
+                    else if (!poTarget->GetDirty())
                     {
                         if (CPLAtomicCompareAndExchange(&(poTarget->nLockCount),
                                                         0, -1))
@@ -984,6 +1698,13 @@ CPLErr GDALRasterBlock::Internalize()
                     }
                     poTarget = poTarget->poPrevious;
                 }
+                if (poTarget == nullptr && bOnlyThisDataset)
+                {
+                    // No more block of this dataset can be evicted from
+                    // this shard.
+                    bQuotaCanEvict = false;
+                    break;
+                }
                 if (poTarget == nullptr && poDirtyBlockOtherDataset)
                 {
                     if (CPLAtomicCompareAndExchange(
@@ -995,7 +1716,7 @@ CPLErr GDALRasterBlock::Internalize()
                     }
                     else
                     {
-                        poTarget = poOldest;
+                        poTarget = psShard->poOldest;
                         while (poTarget != nullptr)
                         {
                             if (CPLAtomicCompareAndExchange(
@@ -1010,6 +1731,14 @@ CPLErr GDALRasterBlock::Internalize()
                         }
                     }
                 }
+                if (poTarget == nullptr && poProtectedBlock &&
+                    CPLAtomicCompareAndExchange(&(poProtectedBlock->nLockCount),
+                                                0, -1))
+                {
+                    CPLDebug("GDAL",
+                             "Evicting block of a higher priority dataset");
+                    poTarget = poProtectedBlock;
+                }
 
                 if (poTarget != nullptr)
                 {
@@ -1024,8 +1753,7 @@ CPLErr GDALRasterBlock::Internalize()
 
                     GDALRasterBlock *_poPrevious = poTarget->poPrevious;
 
-                    poTarget->Detach_unlocked();
-                    poTarget->GetBand()->UnreferenceBlock(poTarget);
+                    poTarget->Evict_unlocked();
 
                     apoBlocksToFree[nBlocksToFree++] = poTarget;
                     if (poTarget->GetDirty())
@@ -1033,12 +1761,12 @@ CPLErr GDALRasterBlock::Internalize()
                         // Only free one dirty block at a time so that
                         // other dirty blocks of other bands with the same
                         // coordinates can be found with TryGetLockedBlock()
-                        bLoopAgain = nCacheUsed > nCurCacheMax;
+                        bLoopAgain = IsOverBudget();
                         break;
                     }
                     if (nBlocksToFree == 64)
                     {
-                        bLoopAgain = (nCacheUsed > nCurCacheMax);
+                        bLoopAgain = IsOverBudget();
                         break;
                     }
 
@@ -1056,7 +1784,12 @@ CPLErr GDALRasterBlock::Internalize()
             /* ------------------------------------------------------------------
              */
             if (!bLoopAgain)
-                Touch_unlocked();
+            {
+                if (b2QPolicy)
+                    Insert2Q_unlocked();
+                else
+                    Touch_unlocked();
+            }
         }
 
         bFirstIter = false;
@@ -1066,7 +1799,11 @@ CPLErr GDALRasterBlock::Internalize()
         {
             GDALRasterBlock *const poBlock = apoBlocksToFree[i];
 
-            if (poBlock->GetDirty())
+            if (!poBlock->GetDirty())
+            {
+                poBlock->StoreInCompressedCache();
+            }
+            else
             {
                 if (bSleepsForBockCacheDebug)
                 {
@@ -1095,7 +1832,7 @@ CPLErr GDALRasterBlock::Internalize()
             }
             else
             {
-                VSIFreeAligned(poBlock->pData);
+                VSIFreeLarge(poBlock->pData);
             }
             poBlock->pData = nullptr;
 
@@ -1105,18 +1842,179 @@ CPLErr GDALRasterBlock::Internalize()
 
     if (pNewData == nullptr)
     {
-        pNewData = VSI_MALLOC_ALIGNED_AUTO_VERBOSE(nSizeInBytes);
+        pNewData = VSI_MALLOC_LARGE_VERBOSE(nSizeInBytes);
         if (pNewData == nullptr)
         {
+            // The block will be detached without data, so undo the
+            // accounting we did at the beginning.
+            TAKE_LOCK;
+            nCacheUsed -= nEffectiveSize;
+            if (poThisDS)
+                poThisDS->AddBlockCacheUsed(-nEffectiveSize);
             return (CE_Failure);
         }
     }
 
     pData = pNewData;
 
+    if (poWriteBackPool)
+        ScheduleWriteBack();
+
     return CE_None;
 }
 
+/************************************************************************/
+/*                       StoreInCompressedCache()                       */
+/************************************************************************/
+
+/**
+ * Store a copy of the (clean) data of a block evicted from the cache in the
+ * compressed block cache, if it is enabled and the band is read-only.
+ */
+
+void GDALRasterBlock::StoreInCompressedCache()
+{
+    if (poCompressedCache == nullptr || pData == nullptr ||
+        poBand->GetAccess() != GA_ReadOnly)
+        return;
+
+    const size_t nSize = static_cast<size_t>(GetBlockSize());
+    std::vector<GByte> abyData;
+    try
+    {
+        abyData.resize(nSize);
+    }
+    catch (const std::exception &)
+    {
+        return;
+    }
+    void *pOutput = abyData.data();
+    size_t nOutSize = nSize;
+    // Do not keep blocks that compress poorly
+    if (!poCompressedCache->psCompressor->pfnFunc(
+            pData, nSize, &pOutput, &nOutSize,
+            poCompressedCache->aosOptions.List(),
+            poCompressedCache->psCompressor->user_data) ||
+        nOutSize > nSize / 10 * 9)
+    {
+        return;
+    }
+    abyData.resize(nOutSize);
+    abyData.shrink_to_fit();
+
+    const GDALRasterBlockKey sKey{poBand, nXOff, nYOff};
+    const GUInt64 nIndex = GetCompressedBlockIndex(nXOff, nYOff);
+    // Rough estimate of the memory used by an entry
+    const GIntBig nEntrySize =
+        static_cast<GIntBig>(nOutSize + sizeof(GDALCompressedBlock) + 64);
+
+    std::lock_guard<std::mutex> oLock(poCompressedCache->oMutex);
+    auto &oBandMap = poCompressedCache->oMap[poBand];
+    if (oBandMap.find(nIndex) != oBandMap.end())
+        return;
+    poCompressedCache->oList.push_front(
+        GDALCompressedBlock{sKey, std::move(abyData)});
+    oBandMap[nIndex] = poCompressedCache->oList.begin();
+    poCompressedCache->nUsed += nEntrySize;
+
+    while (poCompressedCache->nUsed > poCompressedCache->nMax &&
+           !poCompressedCache->oList.empty())
+    {
+        const auto &oOldest = poCompressedCache->oList.back();
+        auto oIterBand = poCompressedCache->oMap.find(oOldest.sKey.poBand);
+        CPLAssert(oIterBand != poCompressedCache->oMap.end());
+        oIterBand->second.erase(
+            GetCompressedBlockIndex(oOldest.sKey.nXOff, oOldest.sKey.nYOff));
+        if (oIterBand->second.empty())
+            poCompressedCache->oMap.erase(oIterBand);
+        poCompressedCache->nUsed -= static_cast<GIntBig>(
+            oOldest.abyData.size() + sizeof(GDALCompressedBlock) + 64);
+        poCompressedCache->oList.pop_back();
+    }
+}
+
+/************************************************************************/
+/*                       LoadFromCompressedCache()                      */
+/************************************************************************/
+
+/**
+ * Fill the data of a newly internalized block from the compressed block
+ * cache.
+ *
+ * Normally only called from GDALRasterBand::GetLockedBlockRef().
+ *
+ * @return true if the block was found in the compressed block cache (and
+ * then removed from it), false otherwise.
+ */
+
+bool GDALRasterBlock::LoadFromCompressedCache()
+{
+    if (poCompressedCache == nullptr || pData == nullptr)
+        return false;
+
+    GDALCompressedBlock oEntry;
+    {
+        std::lock_guard<std::mutex> oLock(poCompressedCache->oMutex);
+        auto oIterBand = poCompressedCache->oMap.find(poBand);
+        if (oIterBand == poCompressedCache->oMap.end())
+            return false;
+        auto oIter =
+            oIterBand->second.find(GetCompressedBlockIndex(nXOff, nYOff));
+        if (oIter == oIterBand->second.end())
+            return false;
+        oEntry = std::move(*(oIter->second));
+        poCompressedCache->oList.erase(oIter->second);
+        oIterBand->second.erase(oIter);
+        if (oIterBand->second.empty())
+            poCompressedCache->oMap.erase(oIterBand);
+        poCompressedCache->nUsed -= static_cast<GIntBig>(
+            oEntry.abyData.size() + sizeof(GDALCompressedBlock) + 64);
+    }
+
+    const size_t nSize = static_cast<size_t>(GetBlockSize());
+    void *pOutput = pData;
+    size_t nOutSize = nSize;
+    if (!poCompressedCache->psDecompressor->pfnFunc(
+            oEntry.abyData.data(), oEntry.abyData.size(), &pOutput, &nOutSize,
+            poCompressedCache->aosOptions.List(),
+            poCompressedCache->psDecompressor->user_data) ||
+        nOutSize != nSize)
+    {
+        CPLDebug("GDAL", "Decompression of cached block failed");
+        return false;
+    }
+    poCompressedCache->nHits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+/************************************************************************/
+/*                        PurgeCompressedCache()                        */
+/************************************************************************/
+
+/**
+ * Remove all blocks of a band from the compressed block cache.
+ *
+ * Normally only called when a band is destroyed or its cache dropped.
+ */
+
+void GDALRasterBlock::PurgeCompressedCache(GDALRasterBand *poBand)
+{
+    if (poCompressedCache == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> oLock(poCompressedCache->oMutex);
+    auto oIterBand = poCompressedCache->oMap.find(poBand);
+    if (oIterBand == poCompressedCache->oMap.end())
+        return;
+    for (const auto &oIter : oIterBand->second)
+    {
+        poCompressedCache->nUsed -= static_cast<GIntBig>(
+            oIter.second->abyData.size() + sizeof(GDALCompressedBlock) + 64);
+        poCompressedCache->oList.erase(oIter.second);
+    }
+    poCompressedCache->oMap.erase(oIterBand);
+}
+
 /************************************************************************/
 /*                             MarkDirty()                              */
 /************************************************************************/
@@ -1164,9 +2062,40 @@ void GDALRasterBlock::MarkClean()
 /*! @cond Doxygen_Suppress */
 void GDALRasterBlock::DestroyRBMutex()
 {
-    if (hRBLock != nullptr)
-        DESTROY_LOCK;
-    hRBLock = nullptr;
+    if (poWriteBackPool)
+    {
+        poWriteBackPool->WaitCompletion();
+        delete poWriteBackPool;
+        poWriteBackPool = nullptr;
+    }
+
+    GDALCacheStatistics sStats;
+    GDALGetCacheStatistics(&sStats);
+    if (sStats.nHits + sStats.nMisses > 0)
+    {
+        CPLDebug("GDAL",
+                 "Block cache statistics: " CPL_FRMT_GIB " hits, " CPL_FRMT_GIB
+                 " misses, " CPL_FRMT_GIB " evictions, " CPL_FRMT_GIB
+                 " compressed hits, " CPL_FRMT_GIB
+                 " dirty block writes (%.3f s), %.3f s waiting on locks",
+                 sStats.nHits, sStats.nMisses, sStats.nEvictions,
+                 sStats.nCompressedHits, sStats.nDirtyBlockWrites,
+                 sStats.dfDirtyBlockWriteTime, sStats.dfLockWaitTime);
+    }
+
+    delete poCompressedCache;
+    poCompressedCache = nullptr;
+
+    for (auto &sShard : asShards)
+    {
+        if (sShard.hLock != nullptr)
+            CPLDestroyLock(sShard.hLock);
+        sShard.hLock = nullptr;
+        sShard.oGhostSet.clear();
+        sShard.oGhostFIFO.clear();
+        sShard.nGhostSize = 0;
+    }
+    nShardCount = 0;
 }
 /*! @endcond */
 
@@ -1213,6 +2142,7 @@ int GDALRasterBlock::TakeLock()
 
         return FALSE;
     }
+    asShards[nShard].nHits.fetch_add(1, std::memory_order_relaxed);
     Touch();
     return TRUE;
 }
@@ -1253,14 +2183,17 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 void GDALRasterBlock::DumpAll()
 {
     int iBlock = 0;
-    for( GDALRasterBlock *poBlock = poNewest;
-         poBlock != nullptr;
-         poBlock = poBlock->poNext )
+    for( int i = 0; i < std::max(1, nShardCount); ++i )
     {
-        printf("Block %d\n", iBlock);/*ok*/
-        poBlock->DumpBlock();
-        printf("\n");/*ok*/
-        iBlock++;
+        for( GDALRasterBlock *poBlock = asShards[i].poNewest;
+             poBlock != nullptr;
+             poBlock = poBlock->poNext )
+        {
+            printf("Block %d\n", iBlock);/*ok*/
+            poBlock->DumpBlock();
+            printf("\n");/*ok*/
+            iBlock++;
+        }
     }
 }
 
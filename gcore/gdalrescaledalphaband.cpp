@@ -36,6 +36,10 @@
 #include "cpl_vsi.h"
 #include "gdal.h"
 
+#if defined(__x86_64) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
 //! @cond Doxygen_Suppress
 /************************************************************************/
 /*                        GDALRescaledAlphaBand()                       */
@@ -123,7 +127,33 @@ CPLErr GDALRescaledAlphaBand::IRasterIO(
             GByte *pabyImage = static_cast<GByte *>(pData) + j * nLineSpace;
             GUInt16 *pSrc = static_cast<GUInt16 *>(pTemp);
 
-            for (int i = 0; i < nBufXSize; i++)
+            int i = 0;
+#if defined(__x86_64) || defined(_M_X64)
+            // (x * 255) / 65535 == x / 257, computed as (x * 65281) >> 24
+            const __m128i xmmMul = _mm_set1_epi16(static_cast<short>(65281));
+            const __m128i xmmOne = _mm_set1_epi16(1);
+            const __m128i xmmZero = _mm_setzero_si128();
+            for (; i + 15 < nBufXSize; i += 16)
+            {
+                __m128i xmmSrc[2];
+                __m128i xmmRes[2];
+                for (int k = 0; k < 2; ++k)
+                {
+                    xmmSrc[k] = _mm_loadu_si128(
+                        reinterpret_cast<const __m128i *>(pSrc + i + 8 * k));
+                    xmmRes[k] =
+                        _mm_srli_epi16(_mm_mulhi_epu16(xmmSrc[k], xmmMul), 8);
+                    // Non-zero values must give a non-zero alpha
+                    xmmRes[k] = _mm_max_epi16(
+                        xmmRes[k],
+                        _mm_andnot_si128(_mm_cmpeq_epi16(xmmSrc[k], xmmZero),
+                                         xmmOne));
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(pabyImage + i),
+                                 _mm_packus_epi16(xmmRes[0], xmmRes[1]));
+            }
+#endif
+            for (; i < nBufXSize; i++)
             {
                 // In case the dynamics was actually 0-255 and not 0-65535 as
                 // expected, we want to make sure non-zero alpha will still
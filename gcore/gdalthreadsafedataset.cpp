@@ -0,0 +1,620 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  Dataset and raster band classes that can be used concurrently
+ *           from several threads (GDAL_OF_THREAD_SAFE)
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "gdal_priv.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cpl_error.h"
+#include "cpl_string.h"
+#include "gdal.h"
+#include "gdal_proxy.h"
+
+/** A GDALThreadSafeDataset is a read-only dataset that can be used
+    concurrently from several threads. It owns a "prototype" dataset, used to
+    serve the metadata, georeferencing, overview list, etc. under a mutex, and
+    lazily re-opens one dataset per calling thread, to which pixel
+    requests are forwarded without any locking.
+*/
+
+class GDALThreadSafeRasterBand;
+
+/* ******************************************************************** */
+/*                        GDALThreadSafeDataset                         */
+/* ******************************************************************** */
+
+class GDALThreadSafeDataset final : public GDALProxyDataset
+{
+  private:
+    friend class GDALThreadSafeRasterBand;
+
+    // Protects m_poPrototypeDS and m_oMapThreadToDataset
+    mutable std::mutex m_oMutex{};
+    GDALDatasetUniquePtr m_poPrototypeDS{};
+    const std::string m_osFilename;
+    const unsigned int m_nReopenFlags;
+    CPLStringList m_aosAllowedDrivers{};
+    const CPLStringList m_aosOpenOptions;
+    mutable std::map<std::thread::id, GDALDatasetUniquePtr>
+        m_oMapThreadToDataset{};
+
+    CPLErr ReadOnlyError(const char *pszMethod) const;
+
+  protected:
+    GDALDataset *RefUnderlyingDataset() const override;
+
+    CPLErr IBuildOverviews(const char *, int, const int *, int, const int *,
+                           GDALProgressFunc, void *,
+                           CSLConstList papszOptions) override;
+
+  public:
+    GDALThreadSafeDataset(GDALDatasetUniquePtr poPrototypeDS,
+                          const char *pszFilename, unsigned int nOpenFlagsIn,
+                          CSLConstList papszOpenOptionsIn);
+    ~GDALThreadSafeDataset() override;
+
+    bool IsThreadSafe(int nScopeFlags) const override;
+
+    bool OpenForCurrentThread() const
+    {
+        return RefUnderlyingDataset() != nullptr;
+    }
+
+    char **GetMetadataDomainList() override;
+    char **GetMetadata(const char *pszDomain) override;
+    CPLErr SetMetadata(char **papszMetadata, const char *pszDomain) override;
+    const char *GetMetadataItem(const char *pszName,
+                                const char *pszDomain) override;
+    CPLErr SetMetadataItem(const char *pszName, const char *pszValue,
+                           const char *pszDomain) override;
+
+    CPLErr FlushCache(bool bAtClosing) override;
+
+    const OGRSpatialReference *GetSpatialRef() const override;
+    CPLErr SetSpatialRef(const OGRSpatialReference *poSRS) override;
+
+    CPLErr GetGeoTransform(double *) override;
+    CPLErr SetGeoTransform(double *) override;
+
+    GDALDriver *GetDriver() override;
+    char **GetFileList() override;
+
+    int GetGCPCount() override;
+    const OGRSpatialReference *GetGCPSpatialRef() const override;
+    const GDAL_GCP *GetGCPs() override;
+    CPLErr SetGCPs(int nGCPCount, const GDAL_GCP *pasGCPList,
+                   const OGRSpatialReference *poGCP_SRS) override;
+
+    CPLErr CreateMaskBand(int nFlags) override;
+
+  private:
+    CPL_DISALLOW_COPY_ASSIGN(GDALThreadSafeDataset)
+};
+
+/* ******************************************************************** */
+/*                       GDALThreadSafeRasterBand                       */
+/* ******************************************************************** */
+
+class GDALThreadSafeRasterBand final : public GDALProxyRasterBand
+{
+  private:
+    GDALThreadSafeDataset *const m_poTSDS;
+    GDALRasterBand *const m_poPrototypeBand;
+
+    // Band number in the main dataset, followed by the path to this band:
+    // overview index, or -1 for the mask band.
+    const int m_nMainBand;
+    const std::vector<int> m_anPath;
+
+    // Overview (key >= 0) and mask (key -1) bands of this band.
+    std::map<int, std::unique_ptr<GDALThreadSafeRasterBand>> m_oMapChildren{};
+
+    GDALRasterBand *GetChild(int nKey);
+    CPLErr ReadOnlyError(const char *pszMethod);
+
+  protected:
+    GDALRasterBand *RefUnderlyingRasterBand(bool bForceOpen) const override;
+
+  public:
+    GDALThreadSafeRasterBand(GDALThreadSafeDataset *poTSDS,
+                             GDALRasterBand *poPrototypeBand, int nMainBand,
+                             const std::vector<int> &anPath);
+
+    char **GetMetadataDomainList() override;
+    char **GetMetadata(const char *pszDomain) override;
+    CPLErr SetMetadata(char **papszMetadata, const char *pszDomain) override;
+    const char *GetMetadataItem(const char *pszName,
+                                const char *pszDomain) override;
+    CPLErr SetMetadataItem(const char *pszName, const char *pszValue,
+                           const char *pszDomain) override;
+    CPLErr FlushCache(bool bAtClosing) override;
+    char **GetCategoryNames() override;
+    double GetNoDataValue(int *pbSuccess = nullptr) override;
+    int64_t GetNoDataValueAsInt64(int *pbSuccess = nullptr) override;
+    uint64_t GetNoDataValueAsUInt64(int *pbSuccess = nullptr) override;
+    double GetMinimum(int *pbSuccess = nullptr) override;
+    double GetMaximum(int *pbSuccess = nullptr) override;
+    double GetOffset(int *pbSuccess = nullptr) override;
+    double GetScale(int *pbSuccess = nullptr) override;
+    const char *GetUnitType() override;
+    GDALColorInterp GetColorInterpretation() override;
+    GDALColorTable *GetColorTable() override;
+    CPLErr Fill(double dfRealValue, double dfImaginaryValue = 0) override;
+
+    CPLErr SetCategoryNames(char **) override;
+    CPLErr SetNoDataValue(double) override;
+    CPLErr DeleteNoDataValue() override;
+    CPLErr SetColorTable(GDALColorTable *) override;
+    CPLErr SetColorInterpretation(GDALColorInterp) override;
+    CPLErr SetOffset(double) override;
+    CPLErr SetScale(double) override;
+    CPLErr SetUnitType(const char *) override;
+    CPLErr SetStatistics(double dfMin, double dfMax, double dfMean,
+                         double dfStdDev) override;
+
+    int HasArbitraryOverviews() override;
+    int GetOverviewCount() override;
+    GDALRasterBand *GetOverview(int) override;
+    GDALRasterBand *GetRasterSampleOverview(GUIntBig) override;
+    CPLErr BuildOverviews(const char *, int, const int *, GDALProgressFunc,
+                          void *, CSLConstList papszOptions) override;
+
+    CPLErr SetDefaultHistogram(double dfMin, double dfMax, int nBuckets,
+                               GUIntBig *panHistogram) override;
+
+    GDALRasterAttributeTable *GetDefaultRAT() override;
+    CPLErr SetDefaultRAT(const GDALRasterAttributeTable *) override;
+
+    GDALRasterBand *GetMaskBand() override;
+    int GetMaskFlags() override;
+    CPLErr CreateMaskBand(int nFlags) override;
+    bool IsMaskBand() const override;
+    GDALMaskValueRange GetMaskValueRange() const override;
+
+  private:
+    CPL_DISALLOW_COPY_ASSIGN(GDALThreadSafeRasterBand)
+};
+
+/************************************************************************/
+/*                       GDALThreadSafeDataset()                        */
+/************************************************************************/
+
+GDALThreadSafeDataset::GDALThreadSafeDataset(
+    GDALDatasetUniquePtr poPrototypeDS, const char *pszFilename,
+    unsigned int nOpenFlagsIn, CSLConstList papszOpenOptionsIn)
+    : m_poPrototypeDS(std::move(poPrototypeDS)), m_osFilename(pszFilename),
+      m_nReopenFlags((nOpenFlagsIn & ~(GDAL_OF_THREAD_SAFE | GDAL_OF_SHARED |
+                                       GDAL_OF_VERBOSE_ERROR)) |
+                     GDAL_OF_INTERNAL),
+      m_aosOpenOptions(CSLDuplicate(papszOpenOptionsIn))
+{
+    bForceCachedIO = false;
+    eAccess = GA_ReadOnly;
+    poDriver = m_poPrototypeDS->GetDriver();
+    m_aosAllowedDrivers.AddString(poDriver->GetDescription());
+    SetDescription(m_poPrototypeDS->GetDescription());
+    nRasterXSize = m_poPrototypeDS->GetRasterXSize();
+    nRasterYSize = m_poPrototypeDS->GetRasterYSize();
+    nOpenFlags = nOpenFlagsIn;
+
+    for (int i = 1; i <= m_poPrototypeDS->GetRasterCount(); ++i)
+    {
+        SetBand(i, new GDALThreadSafeRasterBand(
+                       this, m_poPrototypeDS->GetRasterBand(i), i, {}));
+    }
+}
+
+/************************************************************************/
+/*                       ~GDALThreadSafeDataset()                       */
+/************************************************************************/
+
+GDALThreadSafeDataset::~GDALThreadSafeDataset()
+{
+    // Destroy the bands before the datasets they refer to.
+    for (int i = 0; i < nBands; ++i)
+        delete papoBands[i];
+    CPLFree(papoBands);
+    papoBands = nullptr;
+    nBands = 0;
+
+    m_oMapThreadToDataset.clear();
+    m_poPrototypeDS.reset();
+}
+
+/************************************************************************/
+/*                         RefUnderlyingDataset()                       */
+/************************************************************************/
+
+GDALDataset *GDALThreadSafeDataset::RefUnderlyingDataset() const
+{
+    const auto nThreadId = std::this_thread::get_id();
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        const auto oIter = m_oMapThreadToDataset.find(nThreadId);
+        if (oIter != m_oMapThreadToDataset.end())
+            return oIter->second.get();
+    }
+
+    // Open the dataset of this thread without holding the lock, so that
+    // other threads are not blocked.
+    GDALDatasetUniquePtr poDS(GDALDataset::Open(
+        m_osFilename.c_str(), m_nReopenFlags, m_aosAllowedDrivers.List(),
+        m_aosOpenOptions.List()));
+    if (!poDS)
+    {
+        CPLError(CE_Failure, CPLE_OpenFailed,
+                 "Cannot re-open %s for the current thread",
+                 m_osFilename.c_str());
+        return nullptr;
+    }
+    if (poDS->GetRasterXSize() != nRasterXSize ||
+        poDS->GetRasterYSize() != nRasterYSize ||
+        poDS->GetRasterCount() != nBands)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "%s has changed since it was opened", m_osFilename.c_str());
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    auto &poThreadDS = m_oMapThreadToDataset[nThreadId];
+    poThreadDS = std::move(poDS);
+    return poThreadDS.get();
+}
+
+/************************************************************************/
+/*                            ReadOnlyError()                           */
+/************************************************************************/
+
+CPLErr GDALThreadSafeDataset::ReadOnlyError(const char *pszMethod) const
+{
+    CPLError(CE_Failure, CPLE_NotSupported,
+             "%s() is not supported on a dataset opened with "
+             "GDAL_OF_THREAD_SAFE",
+             pszMethod);
+    return CE_Failure;
+}
+
+/************************************************************************/
+/*                            IsThreadSafe()                            */
+/************************************************************************/
+
+bool GDALThreadSafeDataset::IsThreadSafe(int nScopeFlags) const
+{
+    return nScopeFlags == GDAL_OF_RASTER;
+}
+
+/************************************************************************/
+/*                   Methods served by the prototype                    */
+/************************************************************************/
+
+#define TS_DS_PROTOTYPE_METHOD(retType, methodName, argList, argParams,       \
+                               constness)                                     \
+    retType GDALThreadSafeDataset::methodName argList constness              \
+    {                                                                          \
+        std::lock_guard<std::mutex> oLock(m_oMutex);                           \
+        return m_poPrototypeDS->methodName argParams;                          \
+    }
+
+TS_DS_PROTOTYPE_METHOD(char **, GetMetadataDomainList, (), (), )
+TS_DS_PROTOTYPE_METHOD(char **, GetMetadata, (const char *pszDomain),
+                       (pszDomain), )
+TS_DS_PROTOTYPE_METHOD(const char *, GetMetadataItem,
+                       (const char *pszName, const char *pszDomain),
+                       (pszName, pszDomain), )
+TS_DS_PROTOTYPE_METHOD(const OGRSpatialReference *, GetSpatialRef, (), (),
+                       const)
+TS_DS_PROTOTYPE_METHOD(CPLErr, GetGeoTransform, (double *padfGeoTransform),
+                       (padfGeoTransform), )
+TS_DS_PROTOTYPE_METHOD(char **, GetFileList, (), (), )
+TS_DS_PROTOTYPE_METHOD(int, GetGCPCount, (), (), )
+TS_DS_PROTOTYPE_METHOD(const OGRSpatialReference *, GetGCPSpatialRef, (), (),
+                       const)
+TS_DS_PROTOTYPE_METHOD(const GDAL_GCP *, GetGCPs, (), (), )
+
+GDALDriver *GDALThreadSafeDataset::GetDriver()
+{
+    return poDriver;
+}
+
+/************************************************************************/
+/*                 Methods not allowed in read-only mode                */
+/************************************************************************/
+
+CPLErr GDALThreadSafeDataset::SetMetadata(char **, const char *)
+{
+    return ReadOnlyError("SetMetadata");
+}
+
+CPLErr GDALThreadSafeDataset::SetMetadataItem(const char *, const char *,
+                                              const char *)
+{
+    return ReadOnlyError("SetMetadataItem");
+}
+
+CPLErr GDALThreadSafeDataset::SetSpatialRef(const OGRSpatialReference *)
+{
+    return ReadOnlyError("SetSpatialRef");
+}
+
+CPLErr GDALThreadSafeDataset::SetGeoTransform(double *)
+{
+    return ReadOnlyError("SetGeoTransform");
+}
+
+CPLErr GDALThreadSafeDataset::SetGCPs(int, const GDAL_GCP *,
+                                      const OGRSpatialReference *)
+{
+    return ReadOnlyError("SetGCPs");
+}
+
+CPLErr GDALThreadSafeDataset::CreateMaskBand(int)
+{
+    return ReadOnlyError("CreateMaskBand");
+}
+
+CPLErr GDALThreadSafeDataset::IBuildOverviews(const char *, int, const int *,
+                                              int, const int *,
+                                              GDALProgressFunc, void *,
+                                              CSLConstList)
+{
+    return ReadOnlyError("BuildOverviews");
+}
+
+/************************************************************************/
+/*                             FlushCache()                             */
+/************************************************************************/
+
+CPLErr GDALThreadSafeDataset::FlushCache(bool /* bAtClosing */)
+{
+    // Nothing to write, and we do not want to open a dataset for the
+    // calling thread just to flush it.
+    return CE_None;
+}
+
+/************************************************************************/
+/*                      GDALThreadSafeRasterBand()                      */
+/************************************************************************/
+
+GDALThreadSafeRasterBand::GDALThreadSafeRasterBand(
+    GDALThreadSafeDataset *poTSDS, GDALRasterBand *poPrototypeBand,
+    int nMainBand, const std::vector<int> &anPath)
+    : m_poTSDS(poTSDS), m_poPrototypeBand(poPrototypeBand),
+      m_nMainBand(nMainBand), m_anPath(anPath)
+{
+    // Overview and mask bands are stand-alone bands, as in most drivers.
+    poDS = anPath.empty() ? poTSDS : nullptr;
+    nBand = nMainBand;
+    eAccess = GA_ReadOnly;
+    bForceCachedIO = false;
+    nRasterXSize = poPrototypeBand->GetXSize();
+    nRasterYSize = poPrototypeBand->GetYSize();
+    eDataType = poPrototypeBand->GetRasterDataType();
+    poPrototypeBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+}
+
+/************************************************************************/
+/*                       RefUnderlyingRasterBand()                      */
+/************************************************************************/
+
+GDALRasterBand *
+GDALThreadSafeRasterBand::RefUnderlyingRasterBand(bool /*bForceOpen*/) const
+{
+    GDALDataset *poThreadDS = m_poTSDS->RefUnderlyingDataset();
+    if (!poThreadDS)
+        return nullptr;
+    GDALRasterBand *poBand = poThreadDS->GetRasterBand(m_nMainBand);
+    for (const int nStep : m_anPath)
+    {
+        if (!poBand)
+            break;
+        poBand = nStep < 0 ? poBand->GetMaskBand() : poBand->GetOverview(nStep);
+    }
+    return poBand;
+}
+
+/************************************************************************/
+/*                              GetChild()                              */
+/************************************************************************/
+
+GDALRasterBand *GDALThreadSafeRasterBand::GetChild(int nKey)
+{
+    std::lock_guard<std::mutex> oLock(m_poTSDS->m_oMutex);
+    auto &poChild = m_oMapChildren[nKey];
+    if (!poChild)
+    {
+        GDALRasterBand *poPrototypeChild =
+            nKey < 0 ? m_poPrototypeBand->GetMaskBand()
+                     : m_poPrototypeBand->GetOverview(nKey);
+        if (!poPrototypeChild)
+        {
+            m_oMapChildren.erase(nKey);
+            return nullptr;
+        }
+        std::vector<int> anChildPath(m_anPath);
+        anChildPath.push_back(nKey);
+        poChild = std::make_unique<GDALThreadSafeRasterBand>(
+            m_poTSDS, poPrototypeChild, m_nMainBand, anChildPath);
+    }
+    return poChild.get();
+}
+
+/************************************************************************/
+/*                     GetOverview() / GetMaskBand()                    */
+/************************************************************************/
+
+GDALRasterBand *GDALThreadSafeRasterBand::GetOverview(int nIdx)
+{
+    if (nIdx < 0)
+        return nullptr;
+    return GetChild(nIdx);
+}
+
+GDALRasterBand *GDALThreadSafeRasterBand::GetMaskBand()
+{
+    return GetChild(-1);
+}
+
+GDALRasterBand *
+GDALThreadSafeRasterBand::GetRasterSampleOverview(GUIntBig nDesiredSamples)
+{
+    return GDALRasterBand::GetRasterSampleOverview(nDesiredSamples);
+}
+
+/************************************************************************/
+/*                   Methods served by the prototype                    */
+/************************************************************************/
+
+#define TS_BAND_PROTOTYPE_METHOD(retType, methodName, argList, argParams,     \
+                                 constness)                                   \
+    retType GDALThreadSafeRasterBand::methodName argList constness           \
+    {                                                                          \
+        std::lock_guard<std::mutex> oLock(m_poTSDS->m_oMutex);                 \
+        return m_poPrototypeBand->methodName argParams;                        \
+    }
+
+TS_BAND_PROTOTYPE_METHOD(char **, GetMetadataDomainList, (), (), )
+TS_BAND_PROTOTYPE_METHOD(char **, GetMetadata, (const char *pszDomain),
+                         (pszDomain), )
+TS_BAND_PROTOTYPE_METHOD(const char *, GetMetadataItem,
+                         (const char *pszName, const char *pszDomain),
+                         (pszName, pszDomain), )
+TS_BAND_PROTOTYPE_METHOD(char **, GetCategoryNames, (), (), )
+TS_BAND_PROTOTYPE_METHOD(double, GetNoDataValue, (int *pbSuccess),
+                         (pbSuccess), )
+TS_BAND_PROTOTYPE_METHOD(int64_t, GetNoDataValueAsInt64, (int *pbSuccess),
+                         (pbSuccess), )
+TS_BAND_PROTOTYPE_METHOD(uint64_t, GetNoDataValueAsUInt64, (int *pbSuccess),
+                         (pbSuccess), )
+TS_BAND_PROTOTYPE_METHOD(double, GetMinimum, (int *pbSuccess), (pbSuccess), )
+TS_BAND_PROTOTYPE_METHOD(double, GetMaximum, (int *pbSuccess), (pbSuccess), )
+TS_BAND_PROTOTYPE_METHOD(double, GetOffset, (int *pbSuccess), (pbSuccess), )
+TS_BAND_PROTOTYPE_METHOD(double, GetScale, (int *pbSuccess), (pbSuccess), )
+TS_BAND_PROTOTYPE_METHOD(const char *, GetUnitType, (), (), )
+TS_BAND_PROTOTYPE_METHOD(GDALColorInterp, GetColorInterpretation, (), (), )
+TS_BAND_PROTOTYPE_METHOD(GDALColorTable *, GetColorTable, (), (), )
+TS_BAND_PROTOTYPE_METHOD(int, HasArbitraryOverviews, (), (), )
+TS_BAND_PROTOTYPE_METHOD(int, GetOverviewCount, (), (), )
+TS_BAND_PROTOTYPE_METHOD(GDALRasterAttributeTable *, GetDefaultRAT, (), (), )
+TS_BAND_PROTOTYPE_METHOD(int, GetMaskFlags, (), (), )
+TS_BAND_PROTOTYPE_METHOD(bool, IsMaskBand, (), (), const)
+TS_BAND_PROTOTYPE_METHOD(GDALMaskValueRange, GetMaskValueRange, (), (), const)
+
+/************************************************************************/
+/*                 Methods not allowed in read-only mode                */
+/************************************************************************/
+
+CPLErr GDALThreadSafeRasterBand::ReadOnlyError(const char *pszMethod)
+{
+    return m_poTSDS->ReadOnlyError(pszMethod);
+}
+
+#define TS_BAND_READ_ONLY_METHOD(methodName, argList)                         \
+    CPLErr GDALThreadSafeRasterBand::methodName argList                        \
+    {                                                                          \
+        return ReadOnlyError(#methodName);                                     \
+    }
+
+TS_BAND_READ_ONLY_METHOD(SetMetadata, (char **, const char *))
+TS_BAND_READ_ONLY_METHOD(SetMetadataItem,
+                         (const char *, const char *, const char *))
+TS_BAND_READ_ONLY_METHOD(Fill, (double, double))
+TS_BAND_READ_ONLY_METHOD(SetCategoryNames, (char **))
+TS_BAND_READ_ONLY_METHOD(SetNoDataValue, (double))
+TS_BAND_READ_ONLY_METHOD(DeleteNoDataValue, ())
+TS_BAND_READ_ONLY_METHOD(SetColorTable, (GDALColorTable *))
+TS_BAND_READ_ONLY_METHOD(SetColorInterpretation, (GDALColorInterp))
+TS_BAND_READ_ONLY_METHOD(SetOffset, (double))
+TS_BAND_READ_ONLY_METHOD(SetScale, (double))
+TS_BAND_READ_ONLY_METHOD(SetUnitType, (const char *))
+TS_BAND_READ_ONLY_METHOD(SetStatistics, (double, double, double, double))
+TS_BAND_READ_ONLY_METHOD(BuildOverviews, (const char *, int, const int *,
+                                          GDALProgressFunc, void *,
+                                          CSLConstList))
+TS_BAND_READ_ONLY_METHOD(SetDefaultHistogram,
+                         (double, double, int, GUIntBig *))
+TS_BAND_READ_ONLY_METHOD(SetDefaultRAT, (const GDALRasterAttributeTable *))
+TS_BAND_READ_ONLY_METHOD(CreateMaskBand, (int))
+
+/************************************************************************/
+/*                             FlushCache()                             */
+/************************************************************************/
+
+CPLErr GDALThreadSafeRasterBand::FlushCache(bool /* bAtClosing */)
+{
+    return CE_None;
+}
+
+/************************************************************************/
+/*                     GDALCreateThreadSafeDataset()                    */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+/** Wrap a dataset opened in read-only mode into a dataset that can be used
+ * concurrently from several threads. pszFilename, nOpenFlags and
+ * papszOpenOptions must be the ones used to open poPrototypeDS, so that it
+ * can be re-opened for each thread.
+ */
+GDALDataset *GDALCreateThreadSafeDataset(GDALDatasetUniquePtr poPrototypeDS,
+                                         const char *pszFilename,
+                                         unsigned int nOpenFlags,
+                                         CSLConstList papszOpenOptions)
+{
+    if (!poPrototypeDS)
+        return nullptr;
+    if (poPrototypeDS->GetAccess() != GA_ReadOnly)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "GDAL_OF_THREAD_SAFE is only compatible with read-only "
+                 "datasets");
+        return nullptr;
+    }
+    if (poPrototypeDS->GetDriver() == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "GDAL_OF_THREAD_SAFE is not supported on %s, as it has "
+                 "no driver",
+                 pszFilename);
+        return nullptr;
+    }
+
+    auto poDS = std::make_unique<GDALThreadSafeDataset>(
+        std::move(poPrototypeDS), pszFilename, nOpenFlags, papszOpenOptions);
+
+    // Check that the dataset can be re-opened, so that errors are reported
+    // at opening time rather than during the first read.
+    if (!poDS->OpenForCurrentThread())
+        return nullptr;
+    return poDS.release();
+}
+//! @endcond
@@ -42,11 +42,13 @@
 #include <list>
 #include <memory>
 #include <mutex>
+#include <type_traits>
 #include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
+#include "cpl_trace.h"
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_thread_pool.h"
@@ -475,6 +477,16 @@ inline __m128i sse2_hadd_epi16(__m128i a, __m128i b)
 #define add_epi16 _mm256_add_epi16
 #define sub_epi16 _mm256_sub_epi16
 #define packus_epi16 _mm256_packus_epi16
+#define cmpeq_epi8 _mm256_cmpeq_epi8
+#define and_si _mm256_and_si256
+#define andnot_si _mm256_andnot_si256
+#define or_si _mm256_or_si256
+#define storeu_int(x, y)                                                       \
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(x), (y))
+/* Restore the order of the 64-bit parts after operations, like packs, */
+/* that work on each 128-bit lane separately */
+#define fixup_lanes_epi64(x)                                                   \
+    _mm256_permute4x64_epi64((x), _MM_SHUFFLE(3, 1, 2, 0))
 /* AVX2 operates on 2 separate 128-bit lanes, so we have to do shuffling */
 /* to get the lower 128-bit bits of what would be a true 256-bit vector register
  */
@@ -508,6 +520,12 @@ inline __m128i sse2_hadd_epi16(__m128i a, __m128i b)
 #define add_epi16 _mm_add_epi16
 #define sub_epi16 _mm_sub_epi16
 #define packus_epi16 _mm_packus_epi16
+#define cmpeq_epi8 _mm_cmpeq_epi8
+#define and_si _mm_and_si128
+#define andnot_si _mm_andnot_si128
+#define or_si _mm_or_si128
+#define storeu_int(x, y) _mm_storeu_si128(reinterpret_cast<__m128i *>(x), (y))
+#define fixup_lanes_epi64(x) (x)
 #define store_lo(x, y) _mm_storel_epi64(reinterpret_cast<__m128i *>(x), (y))
 #define hadd_epi16 sse2_hadd_epi16
 #define zeroupper() (void)0
@@ -667,6 +685,71 @@ AverageByteSSE2OrAVX2(int nDstXWidth, int nChunkXSize,
     return iDstPixel;
 }
 
+/************************************************************************/
+/*                       ModeByteSSE2OrAVX2()                           */
+/************************************************************************/
+
+template <class T>
+static int NOINLINE
+ModeByteSSE2OrAVX2(int nDstXWidth, int nChunkXSize,
+                   const T *&CPL_RESTRICT pSrcScanlineShiftedInOut,
+                   T *CPL_RESTRICT pDstScanline)
+{
+    // Optimized implementation for mode on Byte, without nodata, by
+    // processing by group of 2 * DEST_ELTS output pixels.
+    // For source pixels a (top left), b (top right), c (bottom left) and
+    // d (bottom right), the generic implementation selects the most frequent
+    // value, and in case of ties the first one to reach that count when
+    // iterating in a, b, c, d order. That is:
+    // - b if a is different from b and c, and b is equal to c or d
+    // - c if a, b and c are all different, and c is equal to d
+    // - a otherwise
+
+    const auto lowByteMask = set1_epi16(0xFF);
+    const T *CPL_RESTRICT pSrcScanlineShifted = pSrcScanlineShiftedInOut;
+
+    int iDstPixel = 0;
+    for (; iDstPixel < nDstXWidth - (2 * DEST_ELTS - 1);
+         iDstPixel += 2 * DEST_ELTS)
+    {
+        // Load 4 * DEST_ELTS bytes from each line
+        const auto firstLineLo = loadu_int(pSrcScanlineShifted);
+        const auto firstLineHi =
+            loadu_int(pSrcScanlineShifted + 2 * DEST_ELTS);
+        const auto secondLineLo =
+            loadu_int(pSrcScanlineShifted + nChunkXSize);
+        const auto secondLineHi =
+            loadu_int(pSrcScanlineShifted + 2 * DEST_ELTS + nChunkXSize);
+
+        // Separate the pixels of even and odd columns
+        const auto a = packus_epi16(and_si(firstLineLo, lowByteMask),
+                                    and_si(firstLineHi, lowByteMask));
+        const auto b = packus_epi16(srli_epi16(firstLineLo, 8),
+                                    srli_epi16(firstLineHi, 8));
+        const auto c = packus_epi16(and_si(secondLineLo, lowByteMask),
+                                    and_si(secondLineHi, lowByteMask));
+        const auto d = packus_epi16(srli_epi16(secondLineLo, 8),
+                                    srli_epi16(secondLineHi, 8));
+
+        const auto a_eq_b_or_c = or_si(cmpeq_epi8(a, b), cmpeq_epi8(a, c));
+        const auto b_eq_c = cmpeq_epi8(b, c);
+        const auto selectB =
+            andnot_si(a_eq_b_or_c, or_si(b_eq_c, cmpeq_epi8(b, d)));
+        const auto selectC =
+            andnot_si(or_si(a_eq_b_or_c, b_eq_c), cmpeq_epi8(c, d));
+
+        auto mode = or_si(andnot_si(selectB, a), and_si(selectB, b));
+        mode = or_si(andnot_si(selectC, mode), and_si(selectC, c));
+
+        storeu_int(&pDstScanline[iDstPixel], fixup_lanes_epi64(mode));
+        pSrcScanlineShifted += 4 * DEST_ELTS;
+    }
+    zeroupper();
+
+    pSrcScanlineShiftedInOut = pSrcScanlineShifted;
+    return iDstPixel;
+}
+
 /************************************************************************/
 /*                     QuadraticMeanUInt16SSE2()                        */
 /************************************************************************/
@@ -1155,48 +1238,50 @@ QuadraticMeanFloatSSE2(int nDstXWidth, int nChunkXSize,
 /************************************************************************/
 
 template <class T>
-static int AverageFloatSSE2(int nDstXWidth, int nChunkXSize,
-                            const T *&CPL_RESTRICT pSrcScanlineShiftedInOut,
-                            T *CPL_RESTRICT pDstScanline)
+static int NOINLINE
+AverageFloatSSE2(int nDstXWidth, int nChunkXSize,
+                 const T *&CPL_RESTRICT pSrcScanlineShiftedInOut,
+                 T *CPL_RESTRICT pDstScanline)
 {
     // Optimized implementation for average on Float32 by
-    // processing by group of 4 output pixels.
+    // processing by group of RMS_FLOAT_ELTS output pixels.
     const T *CPL_RESTRICT pSrcScanlineShifted = pSrcScanlineShiftedInOut;
 
     int iDstPixel = 0;
-    const auto zeroDot25 = _mm_set1_ps(0.25f);
+    const auto zeroDot25 = set1_ps(0.25f);
 
-    for (; iDstPixel < nDstXWidth - 3; iDstPixel += 4)
+    for (; iDstPixel < nDstXWidth - (RMS_FLOAT_ELTS - 1);
+         iDstPixel += RMS_FLOAT_ELTS)
     {
-        // Load 8 Float32 from each line
+        // Load 2*RMS_FLOAT_ELTS Float32 from each line
         const auto firstLineLo =
-            _mm_loadu_ps(reinterpret_cast<float const *>(pSrcScanlineShifted));
-        const auto firstLineHi = _mm_loadu_ps(
-            reinterpret_cast<float const *>(pSrcScanlineShifted + 4));
-        const auto secondLineLo = _mm_loadu_ps(
+            loadu_ps(reinterpret_cast<float const *>(pSrcScanlineShifted));
+        const auto firstLineHi = loadu_ps(reinterpret_cast<float const *>(
+            pSrcScanlineShifted + RMS_FLOAT_ELTS));
+        const auto secondLineLo = loadu_ps(
             reinterpret_cast<float const *>(pSrcScanlineShifted + nChunkXSize));
-        const auto secondLineHi = _mm_loadu_ps(reinterpret_cast<float const *>(
-            pSrcScanlineShifted + 4 + nChunkXSize));
+        const auto secondLineHi = loadu_ps(reinterpret_cast<float const *>(
+            pSrcScanlineShifted + RMS_FLOAT_ELTS + nChunkXSize));
 
         // Vertical addition
-        const auto sumLo = _mm_add_ps(firstLineLo, secondLineLo);
-        const auto sumHi = _mm_add_ps(firstLineHi, secondLineHi);
+        const auto sumLo = add_ps(firstLineLo, secondLineLo);
+        const auto sumHi = add_ps(firstLineHi, secondLineHi);
 
         // Horizontal addition
-        const auto A =
-            _mm_shuffle_ps(sumLo, sumHi, 0 | (2 << 2) | (0 << 4) | (2 << 6));
-        const auto B =
-            _mm_shuffle_ps(sumLo, sumHi, 1 | (3 << 2) | (1 << 4) | (3 << 6));
-        const auto sum = _mm_add_ps(A, B);
+        const auto A = shuffle_ps(sumLo, sumHi, _MM_SHUFFLE(2, 0, 2, 0));
+        const auto B = shuffle_ps(sumLo, sumHi, _MM_SHUFFLE(3, 1, 3, 1));
+        const auto sum = add_ps(A, B);
 
-        const auto average = _mm_mul_ps(sum, zeroDot25);
+        const auto average = FIXUP_LANES(mul_ps(sum, zeroDot25));
 
         // coverity[incompatible_cast]
-        _mm_storeu_ps(reinterpret_cast<float *>(&pDstScanline[iDstPixel]),
-                      average);
-        pSrcScanlineShifted += 8;
+        storeu_ps(reinterpret_cast<float *>(&pDstScanline[iDstPixel]),
+                  average);
+        pSrcScanlineShifted += RMS_FLOAT_ELTS * 2;
     }
 
+    zeroupper();
+
     pSrcScanlineShiftedInOut = pSrcScanlineShifted;
     return iDstPixel;
 }
@@ -2188,6 +2273,45 @@ static CPLErr GDALResampleChunk_Mode_T(
     const int nChunkBottomYOff = nChunkYOff + nChunkYSize;
     std::vector<int> anVals(256, 0);
 
+    const bool bByteValues =
+        eSrcDataType == GDT_Byte &&
+        (poColorTable == nullptr || poColorTable->GetColorEntryCount() <= 256);
+
+#ifdef USE_SSE2
+    // Check if the source pixels of each destination pixel are a regular
+    // pair of columns, for the optimized case of a downsampling by a factor
+    // of 2 of Byte values.
+    bool bSrcXSpacingIsTwo = false;
+    int nFirstSrcXOff = 0;
+    if constexpr (std::is_same<T, GByte>::value)
+    {
+        bSrcXSpacingIsTwo = bByteValues && !bHasNoData;
+        int nLastSrcXOff2 = -1;
+        for (int iDstPixel = nDstXOff;
+             iDstPixel < nDstXOff2 && bSrcXSpacingIsTwo; ++iDstPixel)
+        {
+            const double dfSrcXOff =
+                dfSrcXDelta + iDstPixel * dfXRatioDstToSrc;
+            int nSrcXOff = static_cast<int>(dfSrcXOff + 1e-8);
+            if (nSrcXOff < nChunkXOff)
+                nSrcXOff = nChunkXOff;
+            const double dfSrcXOff2 =
+                dfSrcXDelta + (iDstPixel + 1) * dfXRatioDstToSrc;
+            int nSrcXOff2 = static_cast<int>(ceil(dfSrcXOff2 - 1e-8));
+            if (nSrcXOff2 > nChunkRightXOff)
+                nSrcXOff2 = nChunkRightXOff;
+            if (iDstPixel == nDstXOff)
+                nFirstSrcXOff = nSrcXOff;
+            if (nSrcXOff2 - nSrcXOff != 2 ||
+                (nLastSrcXOff2 >= 0 && nLastSrcXOff2 != nSrcXOff))
+            {
+                bSrcXSpacingIsTwo = false;
+            }
+            nLastSrcXOff2 = nSrcXOff2;
+        }
+    }
+#endif
+
     /* ==================================================================== */
     /*      Loop over destination scanlines.                                */
     /* ==================================================================== */
@@ -2229,12 +2353,31 @@ static CPLErr GDALResampleChunk_Mode_T(
                 static_cast<GPtrDiff_t>(nSrcYOff - nChunkYOff) * nChunkXSize;
 
         T *const paDstScanline = pDstBuffer + (iDstLine - nDstYOff) * nDstXSize;
+
+        int iFirstDstPixel = nDstXOff;
+#ifdef USE_SSE2
+        if constexpr (std::is_same<T, GByte>::value)
+        {
+            if (bSrcXSpacingIsTwo && nSrcYOff2 == nSrcYOff + 2)
+            {
+                // Optimized case : no nodata, overview by a factor of 2 and
+                // regular x and y src spacing.
+                const T *pSrcScanlineShifted =
+                    paSrcScanline + (nFirstSrcXOff - nChunkXOff);
+                iFirstDstPixel +=
+                    ModeByteSSE2OrAVX2(nDstXSize, nChunkXSize,
+                                       pSrcScanlineShifted, paDstScanline);
+            }
+        }
+#endif
+
         /* --------------------------------------------------------------------
          */
         /*      Loop over destination pixels */
         /* --------------------------------------------------------------------
          */
-        for (int iDstPixel = nDstXOff; iDstPixel < nDstXOff2; ++iDstPixel)
+        for (int iDstPixel = iFirstDstPixel; iDstPixel < nDstXOff2;
+             ++iDstPixel)
         {
             double dfSrcXOff = dfSrcXDelta + iDstPixel * dfXRatioDstToSrc;
             // Apply some epsilon to avoid numerical precision issues
@@ -2264,8 +2407,7 @@ static CPLErr GDALResampleChunk_Mode_T(
             if (nSrcXOff2 > nChunkRightXOff)
                 nSrcXOff2 = nChunkRightXOff;
 
-            if (eSrcDataType != GDT_Byte ||
-                (poColorTable && poColorTable->GetColorEntryCount() > 256))
+            if (!bByteValues)
             {
                 // Not sure how much sense it makes to run a majority
                 // filter on floating point data, but here it is for the sake
@@ -2363,11 +2505,7 @@ static CPLErr GDALResampleChunk_Mode_T(
                 int nMaxVal = 0;
                 int iMaxInd = -1;
 
-                // The cost of this zeroing might be high. Perhaps we should
-                // just use the above generic case, and go to this one if the
-                // number of source pixels is large enough
-                std::fill(anVals.begin(), anVals.end(), 0);
-
+                // anVals[] is all zeroes at that point
                 for (int iY = nSrcYOff; iY < nSrcYOff2; ++iY)
                 {
                     const GPtrDiff_t iTotYOff =
@@ -2395,6 +2533,32 @@ static CPLErr GDALResampleChunk_Mode_T(
                 else
                     paDstScanline[iDstPixel - nDstXOff] =
                         static_cast<T>(iMaxInd);
+
+                // Reset the counts. For small windows, which have a small
+                // number of distinct values, resetting only the counts of the
+                // values that have been seen is much cheaper than resetting
+                // the whole array.
+                if (static_cast<GIntBig>(nSrcYOff2 - nSrcYOff) *
+                        (nSrcXOff2 - nSrcXOff) <
+                    static_cast<GIntBig>(anVals.size()))
+                {
+                    for (int iY = nSrcYOff; iY < nSrcYOff2; ++iY)
+                    {
+                        const GPtrDiff_t iTotYOff =
+                            static_cast<GPtrDiff_t>(iY - nSrcYOff) *
+                                nChunkXSize -
+                            nChunkXOff;
+                        for (int iX = nSrcXOff; iX < nSrcXOff2; ++iX)
+                        {
+                            anVals[static_cast<int>(
+                                paSrcScanline[iX + iTotYOff])] = 0;
+                        }
+                    }
+                }
+                else
+                {
+                    std::fill(anVals.begin(), anVals.end(), 0);
+                }
             }
         }
     }
@@ -2752,17 +2916,57 @@ GDALResampleConvolutionVertical_8cols(const T *pChunk, int nStride,
     v_acc1.Store4Val(afDest + 4);
 }
 
+#endif  // __AVX__
+
+/************************************************************************/
+/*          GDALResampleConvolutionVertical_8cols<T, double>            */
+/************************************************************************/
+
+// Same as GDALResampleConvolutionVertical_2cols() on 8 columns, with the
+// same order of additions, so that results are identical.
 template <class T>
-static inline void GDALResampleConvolutionVertical_8cols(const T *, int,
-                                                         const double *, int,
-                                                         double *)
+static inline void
+GDALResampleConvolutionVertical_8cols(const T *pChunk, int nStride,
+                                      const double *padfWeights,
+                                      int nSrcLineCount, double *adfDest)
 {
-    // Cannot be reached
-    CPLAssert(false);
+    int i = 0;
+    int j = 0;
+    XMMReg4Double v_acc0_1 = XMMReg4Double::Zero();
+    XMMReg4Double v_acc1_1 = XMMReg4Double::Zero();
+    XMMReg4Double v_acc0_2 = XMMReg4Double::Zero();
+    XMMReg4Double v_acc1_2 = XMMReg4Double::Zero();
+    for (; i + 3 < nSrcLineCount; i += 4, j += 4 * nStride)
+    {
+        XMMReg4Double w0 =
+            XMMReg4Double::Load1ValHighAndLow(padfWeights + i + 0);
+        XMMReg4Double w1 =
+            XMMReg4Double::Load1ValHighAndLow(padfWeights + i + 1);
+        XMMReg4Double w2 =
+            XMMReg4Double::Load1ValHighAndLow(padfWeights + i + 2);
+        XMMReg4Double w3 =
+            XMMReg4Double::Load1ValHighAndLow(padfWeights + i + 3);
+        v_acc0_1 += XMMReg4Double::Load4Val(pChunk + j + 0 + 0 * nStride) * w0;
+        v_acc1_1 += XMMReg4Double::Load4Val(pChunk + j + 4 + 0 * nStride) * w0;
+        v_acc0_1 += XMMReg4Double::Load4Val(pChunk + j + 0 + 1 * nStride) * w1;
+        v_acc1_1 += XMMReg4Double::Load4Val(pChunk + j + 4 + 1 * nStride) * w1;
+        v_acc0_2 += XMMReg4Double::Load4Val(pChunk + j + 0 + 2 * nStride) * w2;
+        v_acc1_2 += XMMReg4Double::Load4Val(pChunk + j + 4 + 2 * nStride) * w2;
+        v_acc0_2 += XMMReg4Double::Load4Val(pChunk + j + 0 + 3 * nStride) * w3;
+        v_acc1_2 += XMMReg4Double::Load4Val(pChunk + j + 4 + 3 * nStride) * w3;
+    }
+    for (; i < nSrcLineCount; ++i, j += nStride)
+    {
+        XMMReg4Double w = XMMReg4Double::Load1ValHighAndLow(padfWeights + i);
+        v_acc0_1 += XMMReg4Double::Load4Val(pChunk + j + 0) * w;
+        v_acc1_1 += XMMReg4Double::Load4Val(pChunk + j + 4) * w;
+    }
+    v_acc0_1 += v_acc0_2;
+    v_acc1_1 += v_acc1_2;
+    v_acc0_1.Store4Val(adfDest);
+    v_acc1_1.Store4Val(adfDest + 4);
 }
 
-#endif  // __AVX__
-
 /************************************************************************/
 /*              GDALResampleConvolutionHorizontalSSE2<T>                */
 /************************************************************************/
@@ -3549,7 +3753,25 @@ static CPLErr GDALResampleChunk_ConvolutionT(
                         replaceValIfNodata(fVal);
                 }
             }
-            else
+            else if constexpr (eWrkDataType == GDT_Float64)
+            {
+                for (; iFilteredPixelOff + 7 < nDstXSize;
+                     iFilteredPixelOff += 8, j += 8)
+                {
+                    GDALResampleConvolutionVertical_8cols(
+                        padfHorizontalFiltered + j, nDstXSize, padfWeights,
+                        nSrcLineCount, pafDstScanline + iFilteredPixelOff);
+                    if (bHasNoData)
+                    {
+                        for (int k = 0; k < 8; k++)
+                        {
+                            pafDstScanline[iFilteredPixelOff + k] =
+                                replaceValIfNodata(
+                                    pafDstScanline[iFilteredPixelOff + k]);
+                        }
+                    }
+                }
+            }
 #endif
             {
                 for (; iFilteredPixelOff + 1 < nDstXSize;
@@ -4320,6 +4542,17 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
     if (EQUAL(pszResampling, "NONE"))
         return CE_None;
 
+    CPLTraceSpan oTraceSpan("overview", "RegenerateOverviews");
+    if (oTraceSpan.IsActive())
+    {
+        GDALDataset *poSrcDS = poSrcBand->GetDataset();
+        if (poSrcDS)
+            oTraceSpan.AddAttribute("dataset", poSrcDS->GetDescription());
+        oTraceSpan.AddAttribute("band", poSrcBand->GetBand());
+        oTraceSpan.AddAttribute("resampling", pszResampling);
+        oTraceSpan.AddAttribute("overview_count", nOverviewCount);
+    }
+
     int nKernelRadius = 0;
     GDALResampleFunction pfnResampleFn =
         GDALGetResampleFunction(pszResampling, &nKernelRadius);
@@ -4572,6 +4805,19 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
     {
         OvrJob *poJob = static_cast<OvrJob *>(pData);
 
+        CPLTraceSpan oChunkSpan("overview", "ResampleChunk");
+        if (oChunkSpan.IsActive())
+        {
+            oChunkSpan.AddAttribute("resampling", poJob->pszResampling);
+            oChunkSpan.AddAttribute("overview_xsize",
+                                    poJob->poDstBand->GetXSize());
+            oChunkSpan.AddAttribute("overview_ysize",
+                                    poJob->poDstBand->GetYSize());
+            oChunkSpan.AddAttribute("dst_yoff", poJob->nDstYOff);
+            oChunkSpan.AddAttribute("dst_ysize",
+                                    poJob->nDstYOff2 - poJob->nDstYOff);
+        }
+
         if (poJob->eWrkDataType != GDT_CFloat32)
         {
             poJob->eErr = poJob->pfnResampleFn(
@@ -4981,6 +5227,30 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
     return eErr;
 }
 
+/************************************************************************/
+/*                  GDALOvrBandMayAlterWrittenValues()                  */
+/************************************************************************/
+
+// Whether reading back pixels written into an overview band may give values
+// different from the written ones, like with lossy compression methods or
+// NBITS.
+static bool GDALOvrBandMayAlterWrittenValues(GDALRasterBand *poBand)
+{
+    if (poBand->GetMetadataItem("NBITS", "IMAGE_STRUCTURE") != nullptr)
+        return true;
+    const char *pszCompression =
+        poBand->GetMetadataItem("COMPRESSION", "IMAGE_STRUCTURE");
+    if (pszCompression == nullptr && poBand->GetDataset() != nullptr)
+    {
+        pszCompression = poBand->GetDataset()->GetMetadataItem(
+            "COMPRESSION", "IMAGE_STRUCTURE");
+    }
+    return pszCompression != nullptr &&
+           (strstr(pszCompression, "JPEG") != nullptr ||
+            STARTS_WITH_CI(pszCompression, "LERC") ||
+            EQUAL(pszCompression, "WEBP") || EQUAL(pszCompression, "JXL"));
+}
+
 /************************************************************************/
 /*            GDALRegenerateOverviewsMultiBand()                        */
 /************************************************************************/
@@ -5017,7 +5287,21 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
  *
  * Starting with GDAL 3.2, the GDAL_NUM_THREADS configuration option can be set
  * to "ALL_CPUS" or a integer value to specify the number of threads to use for
- * overview computation.
+ * overview computation. Starting with GDAL 3.9, when several threads are
+ * used, the computation of an overview level computed from the previous one
+ * starts as soon as the rows it needs from that previous level are written.
+ *
+ * Starting with GDAL 3.9, overview levels computed from the previous level
+ * are, when possible, computed from the pixels of that level kept in memory
+ * instead of being read back from the overview bands: all the levels are
+ * then computed in a single pass over the source bands, only keeping in
+ * memory the rows of each level that are still needed by the next one. This
+ * is controlled with the GDAL_OVR_FUSED_LEVELS configuration option, that
+ * can be set to YES, NO or AUTO (default). In AUTO mode, this is not done
+ * when the overview bands use a lossy compression method (JPEG, WEBP, JXL,
+ * LERC) or the NBITS setting, so that the result is the same as when reading
+ * back the written pixels. This is never done when a mask or nodata value
+ * must be taken into account.
  *
  * @param nBands the number of bands, size of papoSrcBands and size of
  *               first dimension of papapoOverviewBands
@@ -5053,6 +5337,18 @@ CPLErr GDALRegenerateOverviewsMultiBand(
     if (EQUAL(pszResampling, "NONE"))
         return CE_None;
 
+    CPLTraceSpan oTraceSpan("overview", "RegenerateOverviewsMultiBand");
+    if (oTraceSpan.IsActive())
+    {
+        GDALDataset *poSrcDS =
+            nBands > 0 ? papoSrcBands[0]->GetDataset() : nullptr;
+        if (poSrcDS)
+            oTraceSpan.AddAttribute("dataset", poSrcDS->GetDescription());
+        oTraceSpan.AddAttribute("band_count", nBands);
+        oTraceSpan.AddAttribute("resampling", pszResampling);
+        oTraceSpan.AddAttribute("overview_count", nOverviews);
+    }
+
     // Sanity checks.
     if (!STARTS_WITH_CI(pszResampling, "NEAR") &&
         !EQUAL(pszResampling, "RMS") && !EQUAL(pszResampling, "AVERAGE") &&
@@ -5151,10 +5447,19 @@ CPLErr GDALRegenerateOverviewsMultiBand(
     const bool bIsMask = papoSrcBands[0]->IsMaskBand();
 
     // If we have a nodata mask and we are doing something more complicated
-    // than nearest neighbouring, we have to fetch to nodata mask.
-    const bool bUseNoDataMask =
-        !STARTS_WITH_CI(pszResampling, "NEAR") &&
-        (bIsMask || (papoSrcBands[0]->GetMaskFlags() & GMF_ALL_VALID) == 0);
+    // than nearest neighbouring, we have to fetch to nodata mask. Bands may
+    // have different masks, for example a nodata value set only on some of
+    // them.
+    bool bUseNoDataMask = false;
+    if (!STARTS_WITH_CI(pszResampling, "NEAR"))
+    {
+        bUseNoDataMask = bIsMask;
+        for (int iBand = 0; iBand < nBands && !bUseNoDataMask; ++iBand)
+        {
+            bUseNoDataMask =
+                (papoSrcBands[iBand]->GetMaskFlags() & GMF_ALL_VALID) == 0;
+        }
+    }
 
     bool *const pabHasNoData =
         static_cast<bool *>(VSI_MALLOC_VERBOSE(nBands * sizeof(bool)));
@@ -5177,6 +5482,21 @@ CPLErr GDALRegenerateOverviewsMultiBand(
     const bool bPropagateNoData =
         CPLTestBool(CPLGetConfigOption("GDAL_OVR_PROPAGATE_NODATA", "NO"));
 
+    // Source areas that GetDataCoverageStatus() reports as empty, like the
+    // missing tiles of a sparse GeoTIFF file, are neither read nor
+    // resampled when the value of their pixels is known: the resulting
+    // overview pixels are set to it.
+    std::vector<double> adfEmptyBlockValue(nBands);
+    bool bSkipEmptyChunks = !bIsMask;
+    for (int iBand = 0; iBand < nBands && bSkipEmptyChunks; ++iBand)
+    {
+        const int nMaskFlags = papoSrcBands[iBand]->GetMaskFlags();
+        bSkipEmptyChunks =
+            (nMaskFlags == GMF_ALL_VALID || nMaskFlags == GMF_NODATA) &&
+            GDALGetEmptyBlockValue(papoSrcBands[iBand],
+                                   &adfEmptyBlockValue[iBand]);
+    }
+
     const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
     const int nThreads = std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
                                                        ? CPLGetNumCPUs()
@@ -5190,147 +5510,280 @@ CPLErr GDALRegenerateOverviewsMultiBand(
     const int nChunkMaxSize =
         atoi(CPLGetConfigOption("GDAL_OVR_CHUNK_MAX_SIZE", "10485760"));
 
-    // Second pass to do the real job.
-    double dfCurPixelCount = 0;
-    CPLErr eErr = CE_None;
-    for (int iOverview = 0; iOverview < nOverviews && eErr == CE_None;
-         ++iOverview)
+    // State of the computation of one overview level
+    struct OvrLevel
     {
         int iSrcOverview = -1;  // -1 means the source bands.
-
+        int nSrcWidth = 0;
+        int nSrcHeight = 0;
+        double dfXRatioDstToSrc = 0;
+        double dfYRatioDstToSrc = 0;
+        int nOvrFactor = 1;
+        int nDstTotalWidth = 0;
+        int nDstTotalHeight = 0;
+        int nDstXOffStart = 0;
+        int nDstXOffEnd = 0;
+        int nDstYOffStart = 0;
+        int nDstYOffEnd = 0;
         int nDstChunkXSize = 0;
         int nDstChunkYSize = 0;
-        papapoOverviewBands[0][iOverview]->GetBlockSize(&nDstChunkXSize,
-                                                        &nDstChunkYSize);
+        int nFullResXChunk = 0;
+        int nFullResXChunkQueried = 0;
+        int nFullResYChunk = 0;
+        int nFullResYChunkQueried = 0;
+
+        // Next row of chunks to process
+        int nDstYOff = 0;
+        // All rows before this one have been written to the overview bands
+        int nDstYOffWritten = 0;
+        // Number of submitted jobs not yet written
+        int nPendingJobs = 0;
+        bool bFinished = false;
+
+        // Whether the written rows still needed to compute the next level
+        // are kept in memory (in the data type of the overview bands), for
+        // columns [nDstXOffStart, nDstXOffEnd) and rows
+        // [nCacheYOff, nCacheYOff2).
+        bool bKeepInMemory = false;
+        int nCacheYOff = 0;
+        int nCacheYOff2 = 0;
+        std::vector<std::vector<GByte>> aabyCache{};
+
+        std::vector<void *> apaChunk{};
+        std::vector<GByte *> apabyChunkNoDataMask{};
+    };
+
+    std::vector<OvrLevel> aoLevels(nOverviews);
+    for (int iOverview = 0; iOverview < nOverviews; ++iOverview)
+    {
+        OvrLevel &oLevel = aoLevels[iOverview];
+
+        papapoOverviewBands[0][iOverview]->GetBlockSize(&oLevel.nDstChunkXSize,
+                                                        &oLevel.nDstChunkYSize);
 
         const int nDstTotalWidth =
             papapoOverviewBands[0][iOverview]->GetXSize();
         const int nDstTotalHeight =
             papapoOverviewBands[0][iOverview]->GetYSize();
+        oLevel.nDstTotalWidth = nDstTotalWidth;
+        oLevel.nDstTotalHeight = nDstTotalHeight;
 
         // Compute the coordinates of the target region to refresh
         constexpr double EPS = 1e-8;
-        const int nDstXOffStart = static_cast<int>(
+        oLevel.nDstXOffStart = static_cast<int>(
             static_cast<double>(nSrcXOff) / nToplevelSrcWidth * nDstTotalWidth +
             EPS);
-        const int nDstXOffEnd =
+        oLevel.nDstXOffEnd =
             std::min(static_cast<int>(
                          std::ceil(static_cast<double>(nSrcXOff + nSrcXSize) /
                                        nToplevelSrcWidth * nDstTotalWidth -
                                    EPS)),
                      nDstTotalWidth);
-        const int nDstWidth = nDstXOffEnd - nDstXOffStart;
-        const int nDstYOffStart =
+        const int nDstWidth = oLevel.nDstXOffEnd - oLevel.nDstXOffStart;
+        oLevel.nDstYOffStart =
             static_cast<int>(static_cast<double>(nSrcYOff) /
                                  nToplevelSrcHeight * nDstTotalHeight +
                              EPS);
-        const int nDstYOffEnd =
+        oLevel.nDstYOffEnd =
             std::min(static_cast<int>(
                          std::ceil(static_cast<double>(nSrcYOff + nSrcYSize) /
                                        nToplevelSrcHeight * nDstTotalHeight -
                                    EPS)),
                      nDstTotalHeight);
+        oLevel.nDstYOff = oLevel.nDstYOffStart;
+        oLevel.nDstYOffWritten = oLevel.nDstYOffStart;
 
         // Try to use previous level of overview as the source to compute
         // the next level.
-        int nSrcWidth = nToplevelSrcWidth;
-        int nSrcHeight = nToplevelSrcHeight;
+        oLevel.nSrcWidth = nToplevelSrcWidth;
+        oLevel.nSrcHeight = nToplevelSrcHeight;
         if (iOverview > 0 &&
             papapoOverviewBands[0][iOverview - 1]->GetXSize() > nDstTotalWidth)
         {
-            nSrcWidth = papapoOverviewBands[0][iOverview - 1]->GetXSize();
-            nSrcHeight = papapoOverviewBands[0][iOverview - 1]->GetYSize();
-            iSrcOverview = iOverview - 1;
+            oLevel.nSrcWidth =
+                papapoOverviewBands[0][iOverview - 1]->GetXSize();
+            oLevel.nSrcHeight =
+                papapoOverviewBands[0][iOverview - 1]->GetYSize();
+            oLevel.iSrcOverview = iOverview - 1;
         }
 
-        const double dfXRatioDstToSrc =
-            static_cast<double>(nSrcWidth) / nDstTotalWidth;
-        const double dfYRatioDstToSrc =
-            static_cast<double>(nSrcHeight) / nDstTotalHeight;
+        oLevel.dfXRatioDstToSrc =
+            static_cast<double>(oLevel.nSrcWidth) / nDstTotalWidth;
+        oLevel.dfYRatioDstToSrc =
+            static_cast<double>(oLevel.nSrcHeight) / nDstTotalHeight;
 
-        int nOvrFactor = std::max(static_cast<int>(0.5 + dfXRatioDstToSrc),
-                                  static_cast<int>(0.5 + dfYRatioDstToSrc));
-        if (nOvrFactor == 0)
-            nOvrFactor = 1;
+        oLevel.nOvrFactor =
+            std::max(static_cast<int>(0.5 + oLevel.dfXRatioDstToSrc),
+                     static_cast<int>(0.5 + oLevel.dfYRatioDstToSrc));
+        if (oLevel.nOvrFactor == 0)
+            oLevel.nOvrFactor = 1;
 
         // Try to extend the chunk size so that the memory needed to acquire
         // source pixels goes up to 10 MB.
         // This can help for drivers that support multi-threaded reading
-        const int nFullResYChunk =
-            2 + static_cast<int>(nDstChunkYSize * dfYRatioDstToSrc);
-        const int nFullResYChunkQueried =
-            nFullResYChunk + 2 * nKernelRadius * nOvrFactor;
-        while (nDstChunkXSize < nDstWidth)
+        oLevel.nFullResYChunk =
+            2 + static_cast<int>(oLevel.nDstChunkYSize *
+                                 oLevel.dfYRatioDstToSrc);
+        oLevel.nFullResYChunkQueried =
+            oLevel.nFullResYChunk + 2 * nKernelRadius * oLevel.nOvrFactor;
+        while (oLevel.nDstChunkXSize < nDstWidth)
         {
             const int nFullResXChunk =
-                2 + static_cast<int>(2 * nDstChunkXSize * dfXRatioDstToSrc);
+                2 + static_cast<int>(2 * oLevel.nDstChunkXSize *
+                                     oLevel.dfXRatioDstToSrc);
 
             const int nFullResXChunkQueried =
-                nFullResXChunk + 2 * nKernelRadius * nOvrFactor;
+                nFullResXChunk + 2 * nKernelRadius * oLevel.nOvrFactor;
 
             if (static_cast<GIntBig>(nFullResXChunkQueried) *
-                    nFullResYChunkQueried * nBands *
+                    oLevel.nFullResYChunkQueried * nBands *
                     GDALGetDataTypeSizeBytes(eWrkDataType) >
                 nChunkMaxSize)
             {
                 break;
             }
 
-            nDstChunkXSize *= 2;
+            oLevel.nDstChunkXSize *= 2;
         }
-        nDstChunkXSize = std::min(nDstChunkXSize, nDstWidth);
+        oLevel.nDstChunkXSize = std::min(oLevel.nDstChunkXSize, nDstWidth);
 
-        const int nFullResXChunk =
-            2 + static_cast<int>(nDstChunkXSize * dfXRatioDstToSrc);
-        const int nFullResXChunkQueried =
-            nFullResXChunk + 2 * nKernelRadius * nOvrFactor;
+        oLevel.nFullResXChunk =
+            2 + static_cast<int>(oLevel.nDstChunkXSize *
+                                 oLevel.dfXRatioDstToSrc);
+        oLevel.nFullResXChunkQueried =
+            oLevel.nFullResXChunk + 2 * nKernelRadius * oLevel.nOvrFactor;
 
-        // Structure describing a resampling job
-        struct OvrJob
+        oLevel.apaChunk.resize(nBands);
+        oLevel.apabyChunkNoDataMask.resize(nBands);
+    }
+
+    // Determine which levels are kept in memory to compute the next one,
+    // instead of reading them back from the overview bands.
+    const char *pszFusedLevels =
+        CPLGetConfigOption("GDAL_OVR_FUSED_LEVELS", "AUTO");
+    const bool bFusedLevelsAuto = EQUAL(pszFusedLevels, "AUTO");
+    bool bFusedLevels = false;
+    if (!bUseNoDataMask && (bFusedLevelsAuto || CPLTestBool(pszFusedLevels)))
+    {
+        for (int iOverview = 0; iOverview < nOverviews; ++iOverview)
         {
-            // Buffers to free when job is finished
-            std::unique_ptr<PointerHolder> oSrcMaskBufferHolder{};
-            std::unique_ptr<PointerHolder> oSrcBufferHolder{};
-            std::unique_ptr<PointerHolder> oDstBufferHolder{};
-
-            // Input parameters of pfnResampleFn
-            GDALResampleFunction pfnResampleFn = nullptr;
-            double dfXRatioDstToSrc{};
-            double dfYRatioDstToSrc{};
-            GDALDataType eWrkDataType = GDT_Unknown;
-            const void *pChunk = nullptr;
-            const GByte *pabyChunkNodataMask = nullptr;
-            int nChunkXOff = 0;
-            int nChunkXSize = 0;
-            int nChunkYOff = 0;
-            int nChunkYSize = 0;
-            int nDstXOff = 0;
-            int nDstXOff2 = 0;
-            int nDstYOff = 0;
-            int nDstYOff2 = 0;
-            GDALRasterBand *poOverview = nullptr;
-            const char *pszResampling = nullptr;
-            bool bHasNoData = false;
-            double dfNoDataValue = 0.0;
-            GDALDataType eSrcDataType = GDT_Unknown;
-            bool bPropagateNoData = false;
-
-            // Output values of resampling function
-            CPLErr eErr = CE_Failure;
-            void *pDstBuffer = nullptr;
-            GDALDataType eDstBufferDataType = GDT_Unknown;
-
-            // Synchronization
-            bool bFinished = false;
-            std::mutex mutex{};
-            std::condition_variable cv{};
-        };
-
-        // Thread function to resample
-        const auto JobResampleFunc = [](void *pData)
+            const int iSrcOverview = aoLevels[iOverview].iSrcOverview;
+            if (iSrcOverview < 0)
+                continue;
+            OvrLevel &oSrcLevel = aoLevels[iSrcOverview];
+            oSrcLevel.bKeepInMemory = true;
+            for (int iBand = 0; iBand < nBands && bFusedLevelsAuto; ++iBand)
+            {
+                if (GDALOvrBandMayAlterWrittenValues(
+                        papapoOverviewBands[iBand][iSrcOverview]))
+                {
+                    oSrcLevel.bKeepInMemory = false;
+                    break;
+                }
+            }
+            if (oSrcLevel.bKeepInMemory)
+            {
+                bFusedLevels = true;
+                oSrcLevel.nCacheYOff = oSrcLevel.nDstYOffStart;
+                oSrcLevel.nCacheYOff2 = oSrcLevel.nDstYOffStart;
+                oSrcLevel.aabyCache.resize(nBands);
+            }
+        }
+    }
+    const int nDataTypeSize = GDALGetDataTypeSizeBytes(eDataType);
+    const int nWrkDataTypeSize = GDALGetDataTypeSizeBytes(eWrkDataType);
+
+    // Structure describing a resampling job
+    struct OvrJob
+    {
+        // Buffers to free when job is finished
+        std::unique_ptr<PointerHolder> oSrcMaskBufferHolder{};
+        std::unique_ptr<PointerHolder> oSrcBufferHolder{};
+        std::unique_ptr<PointerHolder> oDstBufferHolder{};
+
+        // Input parameters of pfnResampleFn
+        GDALResampleFunction pfnResampleFn = nullptr;
+        double dfXRatioDstToSrc{};
+        double dfYRatioDstToSrc{};
+        GDALDataType eWrkDataType = GDT_Unknown;
+        const void *pChunk = nullptr;
+        const GByte *pabyChunkNodataMask = nullptr;
+        int nChunkXOff = 0;
+        int nChunkXSize = 0;
+        int nChunkYOff = 0;
+        int nChunkYSize = 0;
+        int nDstXOff = 0;
+        int nDstXOff2 = 0;
+        int nDstYOff = 0;
+        int nDstYOff2 = 0;
+        GDALRasterBand *poOverview = nullptr;
+        const char *pszResampling = nullptr;
+        bool bHasNoData = false;
+        double dfNoDataValue = 0.0;
+        GDALDataType eSrcDataType = GDT_Unknown;
+        bool bPropagateNoData = false;
+
+        // Whether the source chunk has no data, and the value of its pixels
+        bool bEmptyChunk = false;
+        double dfEmptyChunkValue = 0.0;
+
+        // Overview level, band index, and whether this is the last job of a
+        // row of chunks
+        OvrLevel *poLevel = nullptr;
+        int iBand = 0;
+        bool bLastOfChunkRow = false;
+
+        // Output values of resampling function
+        CPLErr eErr = CE_Failure;
+        void *pDstBuffer = nullptr;
+        GDALDataType eDstBufferDataType = GDT_Unknown;
+
+        // Synchronization
+        bool bFinished = false;
+        std::mutex mutex{};
+        std::condition_variable cv{};
+    };
+
+    // Thread function to resample
+    const auto JobResampleFunc = [](void *pData)
+    {
+        OvrJob *poJob = static_cast<OvrJob *>(pData);
+
+        CPLTraceSpan oChunkSpan("overview", "ResampleChunk");
+        if (oChunkSpan.IsActive())
         {
-            OvrJob *poJob = static_cast<OvrJob *>(pData);
+            oChunkSpan.AddAttribute("resampling", poJob->pszResampling);
+            oChunkSpan.AddAttribute("overview_xsize",
+                                    poJob->poOverview->GetXSize());
+            oChunkSpan.AddAttribute("overview_ysize",
+                                    poJob->poOverview->GetYSize());
+            oChunkSpan.AddAttribute("dst_yoff", poJob->nDstYOff);
+            oChunkSpan.AddAttribute("dst_ysize",
+                                    poJob->nDstYOff2 - poJob->nDstYOff);
+            oChunkSpan.AddAttribute("empty_chunk",
+                                    static_cast<int>(poJob->bEmptyChunk));
+        }
 
+        if (poJob->bEmptyChunk)
+        {
+            poJob->eDstBufferDataType =
+                poJob->poOverview->GetRasterDataType();
+            const int nDTSize =
+                GDALGetDataTypeSizeBytes(poJob->eDstBufferDataType);
+            const size_t nPixels =
+                static_cast<size_t>(poJob->nDstXOff2 - poJob->nDstXOff) *
+                (poJob->nDstYOff2 - poJob->nDstYOff);
+            poJob->pDstBuffer = VSI_MALLOC2_VERBOSE(nPixels, nDTSize);
+            if (poJob->pDstBuffer)
+            {
+                GDALCopyWords64(&poJob->dfEmptyChunkValue, GDT_Float64, 0,
+                                poJob->pDstBuffer, poJob->eDstBufferDataType,
+                                nDTSize, nPixels);
+                poJob->eErr = CE_None;
+            }
+        }
+        else
+        {
             poJob->eErr = poJob->pfnResampleFn(
                 poJob->dfXRatioDstToSrc, poJob->dfYRatioDstToSrc, 0.0, 0.0,
                 poJob->eWrkDataType, poJob->pChunk, poJob->pabyChunkNodataMask,
@@ -5340,287 +5793,560 @@ CPLErr GDALRegenerateOverviewsMultiBand(
                 &(poJob->pDstBuffer), &(poJob->eDstBufferDataType),
                 poJob->pszResampling, poJob->bHasNoData, poJob->dfNoDataValue,
                 nullptr, poJob->eSrcDataType, poJob->bPropagateNoData);
+        }
 
-            poJob->oDstBufferHolder.reset(new PointerHolder(poJob->pDstBuffer));
-
-            {
-                std::lock_guard<std::mutex> guard(poJob->mutex);
-                poJob->bFinished = true;
-                poJob->cv.notify_one();
-            }
-        };
+        poJob->oDstBufferHolder.reset(new PointerHolder(poJob->pDstBuffer));
 
-        // Function to write resample data to target band
-        const auto WriteJobData = [](const OvrJob *poJob)
         {
-            return poJob->poOverview->RasterIO(
-                GF_Write, poJob->nDstXOff, poJob->nDstYOff,
-                poJob->nDstXOff2 - poJob->nDstXOff,
-                poJob->nDstYOff2 - poJob->nDstYOff, poJob->pDstBuffer,
-                poJob->nDstXOff2 - poJob->nDstXOff,
-                poJob->nDstYOff2 - poJob->nDstYOff, poJob->eDstBufferDataType,
-                0, 0, nullptr);
-        };
-
-        // Wait for completion of oldest job and serialize it
-        const auto WaitAndFinalizeOldestJob =
-            [WriteJobData](std::list<std::unique_ptr<OvrJob>> &jobList)
+            std::lock_guard<std::mutex> guard(poJob->mutex);
+            poJob->bFinished = true;
+            poJob->cv.notify_one();
+        }
+    };
+
+    // Function to write resample data to target band
+    const auto WriteJobData = [](const OvrJob *poJob)
+    {
+        return poJob->poOverview->RasterIO(
+            GF_Write, poJob->nDstXOff, poJob->nDstYOff,
+            poJob->nDstXOff2 - poJob->nDstXOff,
+            poJob->nDstYOff2 - poJob->nDstYOff, poJob->pDstBuffer,
+            poJob->nDstXOff2 - poJob->nDstXOff,
+            poJob->nDstYOff2 - poJob->nDstYOff, poJob->eDstBufferDataType, 0,
+            0, nullptr);
+    };
+
+    // Copy the resampled data of a job into the rows of its level kept in
+    // memory, converting it to the data type of the overview band as
+    // RasterIO() would do.
+    const auto StoreJobData = [eDataType, nDataTypeSize](const OvrJob *poJob)
+    {
+        OvrLevel &oLevel = *(poJob->poLevel);
+        const size_t nCacheLineSize =
+            static_cast<size_t>(oLevel.nDstXOffEnd - oLevel.nDstXOffStart) *
+            nDataTypeSize;
+        if (poJob->nDstYOff2 > oLevel.nCacheYOff2)
         {
-            auto poOldestJob = jobList.front().get();
+            try
             {
-                std::unique_lock<std::mutex> oGuard(poOldestJob->mutex);
-                while (!poOldestJob->bFinished)
+                for (auto &abyCache : oLevel.aabyCache)
                 {
-                    poOldestJob->cv.wait(oGuard);
+                    abyCache.resize(
+                        (poJob->nDstYOff2 - oLevel.nCacheYOff) *
+                        nCacheLineSize);
                 }
             }
-            CPLErr l_eErr = poOldestJob->eErr;
-            if (l_eErr == CE_None)
+            catch (const std::bad_alloc &)
             {
-                l_eErr = WriteJobData(poOldestJob);
+                // Fallback to reading back the overview bands
+                CPLDebug("GDAL", "Cannot keep overview level in memory");
+                oLevel.bKeepInMemory = false;
+                oLevel.aabyCache.clear();
+                return;
             }
+            oLevel.nCacheYOff2 = poJob->nDstYOff2;
+        }
 
-            jobList.pop_front();
-            return l_eErr;
-        };
-
-        // Queue of jobs
-        std::list<std::unique_ptr<OvrJob>> jobList;
+        const int nXCount = poJob->nDstXOff2 - poJob->nDstXOff;
+        const int nSrcDTSize =
+            GDALGetDataTypeSizeBytes(poJob->eDstBufferDataType);
+        GByte *pabyCache = oLevel.aabyCache[poJob->iBand].data();
+        for (int iY = poJob->nDstYOff; iY < poJob->nDstYOff2; ++iY)
+        {
+            GDALCopyWords64(
+                static_cast<const GByte *>(poJob->pDstBuffer) +
+                    static_cast<size_t>(iY - poJob->nDstYOff) * nXCount *
+                        nSrcDTSize,
+                poJob->eDstBufferDataType, nSrcDTSize,
+                pabyCache + (iY - oLevel.nCacheYOff) * nCacheLineSize +
+                    static_cast<size_t>(poJob->nDstXOff -
+                                        oLevel.nDstXOffStart) *
+                        nDataTypeSize,
+                eDataType, nDataTypeSize, nXCount);
+        }
+    };
 
-        std::vector<void *> apaChunk(nBands);
-        std::vector<GByte *> apabyChunkNoDataMask(nBands);
+    // Serialize a finished job and update the progress of its level.
+    // Jobs are finalized in the order they have been submitted, so once the
+    // last job of a row of chunks is written, the whole row is.
+    const auto FinalizeJob = [WriteJobData, StoreJobData](OvrJob *poJob)
+    {
+        CPLErr l_eErr = poJob->eErr;
+        if (l_eErr == CE_None)
+        {
+            l_eErr = WriteJobData(poJob);
+        }
+        if (l_eErr == CE_None && poJob->poLevel->bKeepInMemory)
+        {
+            StoreJobData(poJob);
+        }
+        --poJob->poLevel->nPendingJobs;
+        if (l_eErr == CE_None && poJob->bLastOfChunkRow)
+            poJob->poLevel->nDstYOffWritten = poJob->nDstYOff2;
+        return l_eErr;
+    };
 
-        // Iterate on destination overview, block by block.
-        for (int nDstYOff = nDstYOffStart;
-             nDstYOff < nDstYOffEnd && eErr == CE_None;
-             nDstYOff += nDstChunkYSize)
+    // Wait for completion of oldest job and serialize it
+    const auto WaitAndFinalizeOldestJob =
+        [FinalizeJob](std::list<std::unique_ptr<OvrJob>> &jobList)
+    {
+        auto poOldestJob = jobList.front().get();
         {
-            int nDstYCount;
-            if (nDstYOff + nDstChunkYSize <= nDstYOffEnd)
-                nDstYCount = nDstChunkYSize;
-            else
-                nDstYCount = nDstYOffEnd - nDstYOff;
-
-            int nChunkYOff = static_cast<int>(nDstYOff * dfYRatioDstToSrc);
-            int nChunkYOff2 = static_cast<int>(
-                ceil((nDstYOff + nDstYCount) * dfYRatioDstToSrc));
-            if (nChunkYOff2 > nSrcHeight ||
-                nDstYOff + nDstYCount == nDstTotalHeight)
-                nChunkYOff2 = nSrcHeight;
-            int nYCount = nChunkYOff2 - nChunkYOff;
-            CPLAssert(nYCount <= nFullResYChunk);
-
-            int nChunkYOffQueried = nChunkYOff - nKernelRadius * nOvrFactor;
-            int nChunkYSizeQueried = nYCount + 2 * nKernelRadius * nOvrFactor;
-            if (nChunkYOffQueried < 0)
+            std::unique_lock<std::mutex> oGuard(poOldestJob->mutex);
+            while (!poOldestJob->bFinished)
             {
-                nChunkYSizeQueried += nChunkYOffQueried;
-                nChunkYOffQueried = 0;
+                poOldestJob->cv.wait(oGuard);
             }
-            if (nChunkYSizeQueried + nChunkYOffQueried > nSrcHeight)
-                nChunkYSizeQueried = nSrcHeight - nChunkYOffQueried;
-            CPLAssert(nChunkYSizeQueried <= nFullResYChunkQueried);
+        }
+        const CPLErr l_eErr = FinalizeJob(poOldestJob);
+        jobList.pop_front();
+        return l_eErr;
+    };
 
-            if (!pfnProgress(dfCurPixelCount / dfTotalPixelCount, nullptr,
-                             pProgressData))
+    // Compute the source window, in the source of the overview level, needed
+    // to compute the row of chunks starting at nDstYOff.
+    const auto GetSrcChunkYRange =
+        [nKernelRadius](const OvrLevel &oLevel, int nDstYOff,
+                        int &nChunkYOffQueried, int &nChunkYSizeQueried)
+    {
+        const int nDstYCount =
+            std::min(oLevel.nDstChunkYSize, oLevel.nDstYOffEnd - nDstYOff);
+
+        const int nChunkYOff =
+            static_cast<int>(nDstYOff * oLevel.dfYRatioDstToSrc);
+        int nChunkYOff2 = static_cast<int>(
+            ceil((nDstYOff + nDstYCount) * oLevel.dfYRatioDstToSrc));
+        if (nChunkYOff2 > oLevel.nSrcHeight ||
+            nDstYOff + nDstYCount == oLevel.nDstTotalHeight)
+            nChunkYOff2 = oLevel.nSrcHeight;
+        const int nYCount = nChunkYOff2 - nChunkYOff;
+        CPLAssert(nYCount <= oLevel.nFullResYChunk);
+
+        nChunkYOffQueried = nChunkYOff - nKernelRadius * oLevel.nOvrFactor;
+        nChunkYSizeQueried = nYCount + 2 * nKernelRadius * oLevel.nOvrFactor;
+        if (nChunkYOffQueried < 0)
+        {
+            nChunkYSizeQueried += nChunkYOffQueried;
+            nChunkYOffQueried = 0;
+        }
+        if (nChunkYSizeQueried + nChunkYOffQueried > oLevel.nSrcHeight)
+            nChunkYSizeQueried = oLevel.nSrcHeight - nChunkYOffQueried;
+        CPLAssert(nChunkYSizeQueried <= oLevel.nFullResYChunkQueried);
+        return nDstYCount;
+    };
+
+    // Whether the source pixels needed by the next row of chunks of the
+    // overview level are available.
+    const auto IsLevelReady =
+        [&aoLevels, &GetSrcChunkYRange](const OvrLevel &oLevel)
+    {
+        if (oLevel.iSrcOverview < 0)
+            return true;
+        const OvrLevel &oSrcLevel = aoLevels[oLevel.iSrcOverview];
+        if (oSrcLevel.bFinished)
+            return true;
+        int nChunkYOffQueried = 0;
+        int nChunkYSizeQueried = 0;
+        GetSrcChunkYRange(oLevel, oLevel.nDstYOff, nChunkYOffQueried,
+                          nChunkYSizeQueried);
+        return nChunkYOffQueried + nChunkYSizeQueried <=
+               oSrcLevel.nDstYOffWritten;
+    };
+
+    // Queue of jobs
+    std::list<std::unique_ptr<OvrJob>> jobList;
+
+    double dfCurPixelCount = 0;
+
+    // Issue the jobs for the next row of chunks of an overview level.
+    const auto ProcessChunkRow = [&](int iOverview)
+    {
+        OvrLevel &oLevel = aoLevels[iOverview];
+        const int nDstYOff = oLevel.nDstYOff;
+        int nChunkYOffQueried = 0;
+        int nChunkYSizeQueried = 0;
+        const int nDstYCount = GetSrcChunkYRange(
+            oLevel, nDstYOff, nChunkYOffQueried, nChunkYSizeQueried);
+        oLevel.nDstYOff += nDstYCount;
+
+        // Rows of the source level before the ones needed by this row of
+        // chunks will no longer be needed.
+        OvrLevel *poSrcLevel = oLevel.iSrcOverview >= 0
+                                   ? &aoLevels[oLevel.iSrcOverview]
+                                   : nullptr;
+        if (poSrcLevel && poSrcLevel->bKeepInMemory &&
+            nChunkYOffQueried > poSrcLevel->nCacheYOff)
+        {
+            const int nDiscardedLines =
+                std::min(nChunkYOffQueried, poSrcLevel->nCacheYOff2) -
+                poSrcLevel->nCacheYOff;
+            const size_t nDiscardedSize =
+                static_cast<size_t>(nDiscardedLines) *
+                (poSrcLevel->nDstXOffEnd - poSrcLevel->nDstXOffStart) *
+                nDataTypeSize;
+            for (auto &abyCache : poSrcLevel->aabyCache)
             {
-                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-                eErr = CE_Failure;
+                abyCache.erase(abyCache.begin(),
+                               abyCache.begin() + nDiscardedSize);
             }
+            poSrcLevel->nCacheYOff += nDiscardedLines;
+        }
 
-            // Iterate on destination overview, block by block.
-            for (int nDstXOff = nDstXOffStart;
-                 nDstXOff < nDstXOffEnd && eErr == CE_None;
-                 nDstXOff += nDstChunkXSize)
+        CPLErr l_eErr = CE_None;
+        if (!pfnProgress(dfCurPixelCount / dfTotalPixelCount, nullptr,
+                         pProgressData))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            l_eErr = CE_Failure;
+        }
+
+        auto &apaChunk = oLevel.apaChunk;
+        auto &apabyChunkNoDataMask = oLevel.apabyChunkNoDataMask;
+
+        // Iterate on destination overview, block by block.
+        for (int nDstXOff = oLevel.nDstXOffStart;
+             nDstXOff < oLevel.nDstXOffEnd && l_eErr == CE_None;
+             nDstXOff += oLevel.nDstChunkXSize)
+        {
+            int nDstXCount = 0;
+            if (nDstXOff + oLevel.nDstChunkXSize <= oLevel.nDstXOffEnd)
+                nDstXCount = oLevel.nDstChunkXSize;
+            else
+                nDstXCount = oLevel.nDstXOffEnd - nDstXOff;
+
+            dfCurPixelCount += static_cast<double>(nDstXCount) * nDstYCount;
+
+            int nChunkXOff =
+                static_cast<int>(nDstXOff * oLevel.dfXRatioDstToSrc);
+            int nChunkXOff2 = static_cast<int>(
+                ceil((nDstXOff + nDstXCount) * oLevel.dfXRatioDstToSrc));
+            if (nChunkXOff2 > oLevel.nSrcWidth ||
+                nDstXOff + nDstXCount == oLevel.nDstTotalWidth)
+                nChunkXOff2 = oLevel.nSrcWidth;
+            const int nXCount = nChunkXOff2 - nChunkXOff;
+            CPLAssert(nXCount <= oLevel.nFullResXChunk);
+
+            int nChunkXOffQueried =
+                nChunkXOff - nKernelRadius * oLevel.nOvrFactor;
+            int nChunkXSizeQueried =
+                nXCount + 2 * nKernelRadius * oLevel.nOvrFactor;
+            if (nChunkXOffQueried < 0)
             {
-                int nDstXCount = 0;
-                if (nDstXOff + nDstChunkXSize <= nDstXOffEnd)
-                    nDstXCount = nDstChunkXSize;
-                else
-                    nDstXCount = nDstXOffEnd - nDstXOff;
-
-                dfCurPixelCount += static_cast<double>(nDstXCount) * nDstYCount;
-
-                int nChunkXOff = static_cast<int>(nDstXOff * dfXRatioDstToSrc);
-                int nChunkXOff2 = static_cast<int>(
-                    ceil((nDstXOff + nDstXCount) * dfXRatioDstToSrc));
-                if (nChunkXOff2 > nSrcWidth ||
-                    nDstXOff + nDstXCount == nDstTotalWidth)
-                    nChunkXOff2 = nSrcWidth;
-                const int nXCount = nChunkXOff2 - nChunkXOff;
-                CPLAssert(nXCount <= nFullResXChunk);
-
-                int nChunkXOffQueried = nChunkXOff - nKernelRadius * nOvrFactor;
-                int nChunkXSizeQueried =
-                    nXCount + 2 * nKernelRadius * nOvrFactor;
-                if (nChunkXOffQueried < 0)
-                {
-                    nChunkXSizeQueried += nChunkXOffQueried;
-                    nChunkXOffQueried = 0;
-                }
-                if (nChunkXSizeQueried + nChunkXOffQueried > nSrcWidth)
-                    nChunkXSizeQueried = nSrcWidth - nChunkXOffQueried;
-                CPLAssert(nChunkXSizeQueried <= nFullResXChunkQueried);
+                nChunkXSizeQueried += nChunkXOffQueried;
+                nChunkXOffQueried = 0;
+            }
+            if (nChunkXSizeQueried + nChunkXOffQueried > oLevel.nSrcWidth)
+                nChunkXSizeQueried = oLevel.nSrcWidth - nChunkXOffQueried;
+            CPLAssert(nChunkXSizeQueried <= oLevel.nFullResXChunkQueried);
 #if DEBUG_VERBOSE
-                CPLDebug("GDAL",
-                         "Reading (%dx%d -> %dx%d) for output (%dx%d -> %dx%d)",
-                         nChunkXOffQueried, nChunkYOffQueried,
-                         nChunkXSizeQueried, nChunkYSizeQueried, nDstXOff,
-                         nDstYOff, nDstXCount, nDstYCount);
+            CPLDebug("GDAL",
+                     "Reading (%dx%d -> %dx%d) for output (%dx%d -> %dx%d)",
+                     nChunkXOffQueried, nChunkYOffQueried, nChunkXSizeQueried,
+                     nChunkYSizeQueried, nDstXOff, nDstYOff, nDstXCount,
+                     nDstYCount);
 #endif
 
-                // Avoid accumulating too many tasks and exhaust RAM
+            // Avoid accumulating too many tasks and exhaust RAM
 
-                // Try to complete already finished jobs
-                while (eErr == CE_None && !jobList.empty())
+            // Try to complete already finished jobs
+            while (l_eErr == CE_None && !jobList.empty())
+            {
+                auto poOldestJob = jobList.front().get();
                 {
-                    auto poOldestJob = jobList.front().get();
+                    std::lock_guard<std::mutex> oGuard(poOldestJob->mutex);
+                    if (!poOldestJob->bFinished)
                     {
-                        std::lock_guard<std::mutex> oGuard(poOldestJob->mutex);
-                        if (!poOldestJob->bFinished)
-                        {
-                            break;
-                        }
+                        break;
                     }
-                    eErr = poOldestJob->eErr;
-                    if (eErr == CE_None)
-                    {
-                        eErr = WriteJobData(poOldestJob);
-                    }
-
-                    jobList.pop_front();
                 }
+                l_eErr = FinalizeJob(poOldestJob);
+                jobList.pop_front();
+            }
 
-                // And in case we have saturated the number of threads,
-                // wait for completion of tasks to go below the threshold.
-                while (eErr == CE_None &&
-                       jobList.size() >= static_cast<size_t>(nThreads))
-                {
-                    eErr = WaitAndFinalizeOldestJob(jobList);
-                }
+            // And in case we have saturated the number of threads,
+            // wait for completion of tasks to go below the threshold.
+            while (l_eErr == CE_None &&
+                   jobList.size() >= static_cast<size_t>(nThreads))
+            {
+                l_eErr = WaitAndFinalizeOldestJob(jobList);
+            }
 
-                // (Re)allocate buffers if needed
-                for (int iBand = 0; iBand < nBands; ++iBand)
+            // (Re)allocate buffers if needed
+            for (int iBand = 0; iBand < nBands; ++iBand)
+            {
+                if (apaChunk[iBand] == nullptr)
                 {
+                    apaChunk[iBand] = VSI_MALLOC3_VERBOSE(
+                        oLevel.nFullResXChunkQueried,
+                        oLevel.nFullResYChunkQueried,
+                        GDALGetDataTypeSizeBytes(eWrkDataType));
                     if (apaChunk[iBand] == nullptr)
                     {
-                        apaChunk[iBand] = VSI_MALLOC3_VERBOSE(
-                            nFullResXChunkQueried, nFullResYChunkQueried,
-                            GDALGetDataTypeSizeBytes(eWrkDataType));
-                        if (apaChunk[iBand] == nullptr)
-                        {
-                            eErr = CE_Failure;
-                        }
+                        l_eErr = CE_Failure;
                     }
-                    if (bUseNoDataMask &&
-                        apabyChunkNoDataMask[iBand] == nullptr)
+                }
+                if (bUseNoDataMask && apabyChunkNoDataMask[iBand] == nullptr)
+                {
+                    apabyChunkNoDataMask[iBand] =
+                        static_cast<GByte *>(VSI_MALLOC2_VERBOSE(
+                            oLevel.nFullResXChunkQueried,
+                            oLevel.nFullResYChunkQueried));
+                    if (apabyChunkNoDataMask[iBand] == nullptr)
                     {
-                        apabyChunkNoDataMask[iBand] =
-                            static_cast<GByte *>(VSI_MALLOC2_VERBOSE(
-                                nFullResXChunkQueried, nFullResYChunkQueried));
-                        if (apabyChunkNoDataMask[iBand] == nullptr)
-                        {
-                            eErr = CE_Failure;
-                        }
+                        l_eErr = CE_Failure;
                     }
                 }
+            }
+
+            // Only check the full resolution bands, since the overview
+            // levels used as sources are being written.
+            bool bEmptyChunk = bSkipEmptyChunks && oLevel.iSrcOverview == -1;
+            for (int iBand = 0; iBand < nBands && bEmptyChunk; ++iBand)
+            {
+                bEmptyChunk =
+                    papoSrcBands[iBand]->GetDataCoverageStatus(
+                        nChunkXOffQueried, nChunkYOffQueried,
+                        nChunkXSizeQueried, nChunkYSizeQueried,
+                        GDAL_DATA_COVERAGE_STATUS_DATA,
+                        nullptr) == GDAL_DATA_COVERAGE_STATUS_EMPTY;
+            }
 
-                // Read the source buffers for all the bands.
-                for (int iBand = 0; iBand < nBands && eErr == CE_None; ++iBand)
+            // Get the source pixels from the rows of the source level kept
+            // in memory if they are all available.
+            const bool bReadFromCache =
+                poSrcLevel && poSrcLevel->bKeepInMemory &&
+                nChunkXOffQueried >= poSrcLevel->nDstXOffStart &&
+                nChunkXOffQueried + nChunkXSizeQueried <=
+                    poSrcLevel->nDstXOffEnd &&
+                nChunkYOffQueried >= poSrcLevel->nCacheYOff &&
+                nChunkYOffQueried + nChunkYSizeQueried <=
+                    std::min(poSrcLevel->nCacheYOff2,
+                             poSrcLevel->nDstYOffWritten);
+            for (int iBand = 0;
+                 iBand < nBands && bReadFromCache && l_eErr == CE_None;
+                 ++iBand)
+            {
+                const size_t nCacheLineSize =
+                    static_cast<size_t>(poSrcLevel->nDstXOffEnd -
+                                        poSrcLevel->nDstXOffStart) *
+                    nDataTypeSize;
+                const GByte *pabyCache =
+                    poSrcLevel->aabyCache[iBand].data() +
+                    static_cast<size_t>(nChunkXOffQueried -
+                                        poSrcLevel->nDstXOffStart) *
+                        nDataTypeSize;
+                for (int iY = 0; iY < nChunkYSizeQueried; ++iY)
                 {
-                    GDALRasterBand *poSrcBand = nullptr;
-                    if (iSrcOverview == -1)
-                        poSrcBand = papoSrcBands[iBand];
-                    else
-                        poSrcBand = papapoOverviewBands[iBand][iSrcOverview];
-                    eErr = poSrcBand->RasterIO(
-                        GF_Read, nChunkXOffQueried, nChunkYOffQueried,
-                        nChunkXSizeQueried, nChunkYSizeQueried, apaChunk[iBand],
-                        nChunkXSizeQueried, nChunkYSizeQueried, eWrkDataType, 0,
-                        0, nullptr);
+                    GDALCopyWords64(
+                        pabyCache +
+                            (nChunkYOffQueried + iY - poSrcLevel->nCacheYOff) *
+                                nCacheLineSize,
+                        eDataType, nDataTypeSize,
+                        static_cast<GByte *>(apaChunk[iBand]) +
+                            static_cast<size_t>(iY) * nChunkXSizeQueried *
+                                nWrkDataTypeSize,
+                        eWrkDataType, nWrkDataTypeSize, nChunkXSizeQueried);
+                }
+            }
 
-                    if (bUseNoDataMask && eErr == CE_None)
-                    {
-                        auto poMaskBand = poSrcBand->IsMaskBand()
-                                              ? poSrcBand
-                                              : poSrcBand->GetMaskBand();
-                        eErr = poMaskBand->RasterIO(
-                            GF_Read, nChunkXOffQueried, nChunkYOffQueried,
-                            nChunkXSizeQueried, nChunkYSizeQueried,
-                            apabyChunkNoDataMask[iBand], nChunkXSizeQueried,
-                            nChunkYSizeQueried, GDT_Byte, 0, 0, nullptr);
-                    }
+            // Read the source buffers for all the bands.
+            for (int iBand = 0; iBand < nBands && !bEmptyChunk &&
+                                !bReadFromCache && l_eErr == CE_None;
+                 ++iBand)
+            {
+                GDALRasterBand *poSrcBand = nullptr;
+                if (oLevel.iSrcOverview == -1)
+                    poSrcBand = papoSrcBands[iBand];
+                else
+                    poSrcBand =
+                        papapoOverviewBands[iBand][oLevel.iSrcOverview];
+                l_eErr = poSrcBand->RasterIO(
+                    GF_Read, nChunkXOffQueried, nChunkYOffQueried,
+                    nChunkXSizeQueried, nChunkYSizeQueried, apaChunk[iBand],
+                    nChunkXSizeQueried, nChunkYSizeQueried, eWrkDataType, 0, 0,
+                    nullptr);
+
+                if (bUseNoDataMask && l_eErr == CE_None)
+                {
+                    auto poMaskBand = poSrcBand->IsMaskBand()
+                                          ? poSrcBand
+                                          : poSrcBand->GetMaskBand();
+                    l_eErr = poMaskBand->RasterIO(
+                        GF_Read, nChunkXOffQueried, nChunkYOffQueried,
+                        nChunkXSizeQueried, nChunkYSizeQueried,
+                        apabyChunkNoDataMask[iBand], nChunkXSizeQueried,
+                        nChunkYSizeQueried, GDT_Byte, 0, 0, nullptr);
                 }
+            }
 
-                // Compute the resulting overview block.
-                for (int iBand = 0; iBand < nBands && eErr == CE_None; ++iBand)
+            // Compute the resulting overview block.
+            for (int iBand = 0; iBand < nBands && l_eErr == CE_None; ++iBand)
+            {
+                auto poJob = std::unique_ptr<OvrJob>(new OvrJob());
+                poJob->pfnResampleFn = pfnResampleFn;
+                poJob->dfXRatioDstToSrc = oLevel.dfXRatioDstToSrc;
+                poJob->dfYRatioDstToSrc = oLevel.dfYRatioDstToSrc;
+                poJob->eWrkDataType = eWrkDataType;
+                poJob->pChunk = apaChunk[iBand];
+                poJob->pabyChunkNodataMask = apabyChunkNoDataMask[iBand];
+                poJob->nChunkXOff = nChunkXOffQueried;
+                poJob->nChunkXSize = nChunkXSizeQueried;
+                poJob->nChunkYOff = nChunkYOffQueried;
+                poJob->nChunkYSize = nChunkYSizeQueried;
+                poJob->nDstXOff = nDstXOff;
+                poJob->nDstXOff2 = nDstXOff + nDstXCount;
+                poJob->nDstYOff = nDstYOff;
+                poJob->nDstYOff2 = nDstYOff + nDstYCount;
+                poJob->poOverview = papapoOverviewBands[iBand][iOverview];
+                poJob->pszResampling = pszResampling;
+                poJob->bHasNoData = pabHasNoData[iBand];
+                poJob->dfNoDataValue = padfNoDataValue[iBand];
+                poJob->eSrcDataType = eDataType;
+                poJob->bPropagateNoData = bPropagateNoData;
+                poJob->bEmptyChunk = bEmptyChunk;
+                poJob->dfEmptyChunkValue = adfEmptyBlockValue[iBand];
+                poJob->poLevel = &oLevel;
+                poJob->iBand = iBand;
+                poJob->bLastOfChunkRow =
+                    iBand == nBands - 1 &&
+                    nDstXOff + nDstXCount == oLevel.nDstXOffEnd;
+                ++oLevel.nPendingJobs;
+
+                if (poJobQueue)
                 {
-                    auto poJob = std::unique_ptr<OvrJob>(new OvrJob());
-                    poJob->pfnResampleFn = pfnResampleFn;
-                    poJob->dfXRatioDstToSrc = dfXRatioDstToSrc;
-                    poJob->dfYRatioDstToSrc = dfYRatioDstToSrc;
-                    poJob->eWrkDataType = eWrkDataType;
-                    poJob->pChunk = apaChunk[iBand];
-                    poJob->pabyChunkNodataMask = apabyChunkNoDataMask[iBand];
-                    poJob->nChunkXOff = nChunkXOffQueried;
-                    poJob->nChunkXSize = nChunkXSizeQueried;
-                    poJob->nChunkYOff = nChunkYOffQueried;
-                    poJob->nChunkYSize = nChunkYSizeQueried;
-                    poJob->nDstXOff = nDstXOff;
-                    poJob->nDstXOff2 = nDstXOff + nDstXCount;
-                    poJob->nDstYOff = nDstYOff;
-                    poJob->nDstYOff2 = nDstYOff + nDstYCount;
-                    poJob->poOverview = papapoOverviewBands[iBand][iOverview];
-                    poJob->pszResampling = pszResampling;
-                    poJob->bHasNoData = pabHasNoData[iBand];
-                    poJob->dfNoDataValue = padfNoDataValue[iBand];
-                    poJob->eSrcDataType = eDataType;
-                    poJob->bPropagateNoData = bPropagateNoData;
-
-                    if (poJobQueue)
-                    {
-                        poJob->oSrcMaskBufferHolder.reset(
-                            new PointerHolder(apabyChunkNoDataMask[iBand]));
-                        apabyChunkNoDataMask[iBand] = nullptr;
+                    poJob->oSrcMaskBufferHolder.reset(
+                        new PointerHolder(apabyChunkNoDataMask[iBand]));
+                    apabyChunkNoDataMask[iBand] = nullptr;
 
-                        poJob->oSrcBufferHolder.reset(
-                            new PointerHolder(apaChunk[iBand]));
-                        apaChunk[iBand] = nullptr;
+                    poJob->oSrcBufferHolder.reset(
+                        new PointerHolder(apaChunk[iBand]));
+                    apaChunk[iBand] = nullptr;
 
-                        poJobQueue->SubmitJob(JobResampleFunc, poJob.get());
-                        jobList.emplace_back(std::move(poJob));
-                    }
-                    else
-                    {
-                        JobResampleFunc(poJob.get());
-                        eErr = poJob->eErr;
-                        if (eErr == CE_None)
-                        {
-                            eErr = WriteJobData(poJob.get());
-                        }
-                    }
+                    poJobQueue->SubmitJob(JobResampleFunc, poJob.get());
+                    jobList.emplace_back(std::move(poJob));
+                }
+                else
+                {
+                    JobResampleFunc(poJob.get());
+                    l_eErr = FinalizeJob(poJob.get());
                 }
             }
         }
+        return l_eErr;
+    };
 
-        // Wait for all pending jobs to complete
-        while (!jobList.empty())
+    // Flush the data of an overview level whose all jobs have been written.
+    const auto FinishLevel = [&](int iOverview)
+    {
+        OvrLevel &oLevel = aoLevels[iOverview];
+        for (int iBand = 0; iBand < nBands; ++iBand)
         {
-            const auto l_eErr = WaitAndFinalizeOldestJob(jobList);
-            if (l_eErr != CE_None && eErr == CE_None)
-                eErr = l_eErr;
+            CPLFree(oLevel.apaChunk[iBand]);
+            oLevel.apaChunk[iBand] = nullptr;
+            papapoOverviewBands[iBand][iOverview]->FlushCache(false);
+
+            CPLFree(oLevel.apabyChunkNoDataMask[iBand]);
+            oLevel.apabyChunkNoDataMask[iBand] = nullptr;
         }
+        oLevel.bFinished = true;
 
-        // Flush the data to overviews.
-        for (int iBand = 0; iBand < nBands; ++iBand)
+        // The rows kept in memory of the source level are no longer needed
+        if (oLevel.iSrcOverview >= 0)
         {
-            CPLFree(apaChunk[iBand]);
-            papapoOverviewBands[iBand][iOverview]->FlushCache(false);
+            OvrLevel &oSrcLevel = aoLevels[oLevel.iSrcOverview];
+            oSrcLevel.bKeepInMemory = false;
+            oSrcLevel.aabyCache.clear();
+        }
+    };
+
+    // Second pass to do the real job.
+    // In single-threaded mode, overview levels are computed one after the
+    // other. When using worker threads, or when levels are kept in memory to
+    // compute the next one, the computation of a level is pipelined with the
+    // one of the previous level it is computed from: a row of chunks of a
+    // level is processed as soon as the source rows it needs have been
+    // written, coarser levels being processed first so that they read rows
+    // still in memory or in the block cache. The full resolution level is
+    // processed when no other one can make progress.
+    CPLErr eErr = CE_None;
+    while (eErr == CE_None)
+    {
+        bool bAllFinished = true;
+        for (int iOverview = 0; iOverview < nOverviews; ++iOverview)
+        {
+            OvrLevel &oLevel = aoLevels[iOverview];
+            if (!oLevel.bFinished && oLevel.nDstYOff >= oLevel.nDstYOffEnd &&
+                oLevel.nPendingJobs == 0)
+            {
+                FinishLevel(iOverview);
+            }
+            if (!oLevel.bFinished)
+                bAllFinished = false;
+        }
+        if (bAllFinished)
+            break;
+
+        int iLevelToProcess = -1;
+        if (poJobQueue || bFusedLevels)
+        {
+            for (int iOverview = nOverviews - 1; iOverview >= 0; --iOverview)
+            {
+                const OvrLevel &oLevel = aoLevels[iOverview];
+                if (oLevel.nDstYOff < oLevel.nDstYOffEnd &&
+                    IsLevelReady(oLevel))
+                {
+                    iLevelToProcess = iOverview;
+                    break;
+                }
+            }
+        }
+        else
+        {
+            for (int iOverview = 0; iOverview < nOverviews; ++iOverview)
+            {
+                if (aoLevels[iOverview].nDstYOff <
+                    aoLevels[iOverview].nDstYOffEnd)
+                {
+                    iLevelToProcess = iOverview;
+                    break;
+                }
+            }
+        }
 
-            CPLFree(apabyChunkNoDataMask[iBand]);
+        if (iLevelToProcess >= 0)
+        {
+            eErr = ProcessChunkRow(iLevelToProcess);
+        }
+        else if (!jobList.empty())
+        {
+            // Wait for source rows to be written
+            eErr = WaitAndFinalizeOldestJob(jobList);
+        }
+        else
+        {
+            // Should not happen
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "GDALRegenerateOverviewsMultiBand(): cannot make "
+                     "progress");
+            eErr = CE_Failure;
         }
     }
 
+    // Wait for all pending jobs to complete
+    while (!jobList.empty())
+    {
+        const auto l_eErr = WaitAndFinalizeOldestJob(jobList);
+        if (l_eErr != CE_None && eErr == CE_None)
+            eErr = l_eErr;
+    }
+
+    // Flush the data to overviews.
+    for (int iOverview = 0; iOverview < nOverviews; ++iOverview)
+    {
+        if (!aoLevels[iOverview].bFinished)
+            FinishLevel(iOverview);
+    }
+
     CPLFree(pabHasNoData);
     CPLFree(padfNoDataValue);
 
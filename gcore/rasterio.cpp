@@ -41,22 +41,33 @@
 #include <cstring>
 
 #include <algorithm>
+#include <condition_variable>
+#include <functional>
 #include <limits>
+#include <mutex>
 #include <stdexcept>
 #include <type_traits>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_cpu_features.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
+#include "cpl_trace.h"
 #include "cpl_vsi.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "gdal_vrt.h"
 #include "gdalwarper.h"
 #include "memdataset.h"
 #include "vrtdataset.h"
 
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+#include "rasterio_avx2.h"
+#endif
+
 static void GDALFastCopyByte(const GByte *CPL_RESTRICT pSrcData,
                              int nSrcPixelStride, GByte *CPL_RESTRICT pDstData,
                              int nDstPixelStride, GPtrDiff_t nWordCount);
@@ -238,6 +249,84 @@ CPLErr GDALRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
          (nXOff == psExtraArg->dfXOff && nYOff == psExtraArg->dfYOff &&
           nXSize == psExtraArg->dfXSize && nYSize == psExtraArg->dfYSize));
 
+    /* ==================================================================== */
+    /*      If reading a column of whole blocks with the band data type     */
+    /*      into a packed buffer, and the driver supports it, decode        */
+    /*      blocks directly into the destination buffer, by-passing the    */
+    /*      block cache.                                                    */
+    /* ==================================================================== */
+    if (eRWFlag == GF_Read && eBufType == eDataType &&
+        nPixelSpace == nBandDataSize &&
+        nLineSpace == nPixelSpace * nBlockXSize && nXSize == nBlockXSize &&
+        nBufXSize == nXSize && nBufYSize == nYSize &&
+        (nXOff % nBlockXSize) == 0 && (nYOff % nBlockYSize) == 0 &&
+        (nYSize % nBlockYSize) == 0 && bUseIntegerRequestCoords &&
+        !bForceCachedIO && CanReadBlockIntoBuffer() && InitBlockInfo())
+    {
+        const int nXBlock = nXOff / nBlockXSize;
+        const int nYBlockStart = nYOff / nBlockYSize;
+        const int nYBlocks = nYSize / nBlockYSize;
+        const size_t nBlockBytes = static_cast<size_t>(nBandDataSize) *
+                                   nBlockXSize * nBlockYSize;
+        CPLErr eErr = CE_None;
+        for (int iYBlock = 0; iYBlock < nYBlocks; ++iYBlock)
+        {
+            const int nYBlock = nYBlockStart + iYBlock;
+            GByte *pabyDstBlock = static_cast<GByte *>(pData) +
+                                  static_cast<size_t>(iYBlock) * nBlockBytes;
+
+            // A block already in the cache may be dirty, so it takes
+            // precedence over what IReadBlock() would return.
+            poBlock = TryGetLockedBlockRef(nXBlock, nYBlock);
+            if (poBlock)
+            {
+                memcpy(pabyDstBlock, poBlock->GetDataRef(), nBlockBytes);
+                poBlock->DropLock();
+                poBlock = nullptr;
+            }
+            else
+            {
+                const GUInt32 nErrorCounter = CPLGetErrorCounter();
+                {
+                    CPLTraceSpan oTraceSpan("raster", "IReadBlock");
+                    if (oTraceSpan.IsActive())
+                    {
+                        if (poDS)
+                            oTraceSpan.AddAttribute("dataset",
+                                                    poDS->GetDescription());
+                        oTraceSpan.AddAttribute("band", nBand);
+                        oTraceSpan.AddAttribute("x_block", nXBlock);
+                        oTraceSpan.AddAttribute("y_block", nYBlock);
+                    }
+                    const int bCallLeaveReadWrite = EnterReadWrite(GF_Read);
+                    eErr = IReadBlock(nXBlock, nYBlock, pabyDstBlock);
+                    if (bCallLeaveReadWrite)
+                        LeaveReadWrite();
+                }
+                if (eErr != CE_None)
+                {
+                    ReportError(CE_Failure, CPLE_AppDefined,
+                                "IReadBlock failed at X offset %d, Y offset "
+                                "%d%s",
+                                nXBlock, nYBlock,
+                                (nErrorCounter != CPLGetErrorCounter())
+                                    ? CPLSPrintf(": %s", CPLGetLastErrorMsg())
+                                    : "");
+                    break;
+                }
+            }
+
+            if (psExtraArg->pfnProgress != nullptr &&
+                !psExtraArg->pfnProgress(1.0 * (iYBlock + 1) / nYBlocks, "",
+                                         psExtraArg->pProgressData))
+            {
+                eErr = CE_Failure;
+                break;
+            }
+        }
+        return eErr;
+    }
+
     /* ==================================================================== */
     /*      A common case is the data requested with the destination        */
     /*      is packed, and the block width is the raster width.             */
@@ -994,6 +1083,120 @@ static int GDALRasterIOTransformer(void *pTransformerArg, int bDstToSrc,
     return TRUE;
 }
 
+namespace
+{
+
+/************************************************************************/
+/*                    GDALRasterIOResampledBuffers                      */
+/************************************************************************/
+
+// Working buffers of GDALRasterBand::RasterIOResampled(), kept from one call
+// to another, so that small resampled requests do not allocate them each
+// time.
+struct GDALRasterIOResampledBuffers
+{
+    std::vector<GByte> abyChunk{};
+    std::vector<GByte> abyChunkNoDataMask{};
+    std::vector<GByte> abyLine{};
+
+    bool Reserve(size_t nChunkSize, size_t nMaskSize, size_t nLineSize)
+    {
+        try
+        {
+            if (abyChunk.size() < nChunkSize)
+                abyChunk.resize(nChunkSize);
+            if (abyChunkNoDataMask.size() < nMaskSize)
+                abyChunkNoDataMask.resize(nMaskSize);
+            if (abyLine.size() < nLineSize)
+                abyLine.resize(nLineSize);
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate resampling buffers");
+            return false;
+        }
+        return true;
+    }
+
+    size_t GetSize() const
+    {
+        return abyChunk.size() + abyChunkNoDataMask.size() + abyLine.size();
+    }
+};
+
+// Buffers bigger than that are not kept after the request.
+constexpr size_t MAX_KEPT_RESAMPLED_BUFFERS_SIZE = 16 * 1024 * 1024;
+
+#ifndef _WIN32
+// Currently thread_local and C++ objects don't work well with DLL on Windows
+thread_local GDALRasterIOResampledBuffers tlsRasterIOResampledBuffers;
+#endif
+
+// Takes the buffers of the current thread for the duration of a request.
+// A nested request (for example from a VRT source) thus gets its own ones.
+class GDALRasterIOResampledBuffersHolder
+{
+    GDALRasterIOResampledBuffers m_sBuffers{};
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALRasterIOResampledBuffersHolder)
+
+  public:
+    GDALRasterIOResampledBuffersHolder()
+    {
+#ifndef _WIN32
+        std::swap(m_sBuffers, tlsRasterIOResampledBuffers);
+#endif
+    }
+
+    ~GDALRasterIOResampledBuffersHolder()
+    {
+#ifndef _WIN32
+        if (m_sBuffers.GetSize() <= MAX_KEPT_RESAMPLED_BUFFERS_SIZE &&
+            m_sBuffers.GetSize() > tlsRasterIOResampledBuffers.GetSize())
+        {
+            std::swap(m_sBuffers, tlsRasterIOResampledBuffers);
+        }
+#endif
+    }
+
+    GDALRasterIOResampledBuffers &Get()
+    {
+        return m_sBuffers;
+    }
+};
+
+/************************************************************************/
+/*                   GDALRasterIOResampledTargetBand                    */
+/************************************************************************/
+
+// Band passed as the overview band to the resampling functions, which only
+// use it to get the dimensions, data type and NBITS of the target. This
+// avoids creating a MEM dataset wrapping the output buffer.
+class GDALRasterIOResampledTargetBand final : public GDALRasterBand
+{
+  protected:
+    CPLErr IReadBlock(int, int, void *) override
+    {
+        return CE_Failure;
+    }
+
+  public:
+    GDALRasterIOResampledTargetBand(int nXSize, int nYSize, GDALDataType eDT,
+                                    const char *pszNBITS)
+    {
+        nRasterXSize = nXSize;
+        nRasterYSize = nYSize;
+        eDataType = eDT;
+        nBlockXSize = nXSize;
+        nBlockYSize = 1;
+        if (pszNBITS)
+            SetMetadataItem("NBITS", pszNBITS, "IMAGE_STRUCTURE");
+    }
+};
+
+}  // namespace
+
 /************************************************************************/
 /*                          RasterIOResampled()                         */
 /************************************************************************/
@@ -1048,44 +1251,44 @@ CPLErr GDALRasterBand::RasterIOResampled(
         nDestYOffVirtual = static_cast<int>(dfDestYOff + 0.5);
     }
 
-    // Create a MEM dataset that wraps the output buffer.
-    GDALDataset *poMEMDS;
-    void *pTempBuffer = nullptr;
-    GSpacing nPSMem = nPixelSpace;
-    GSpacing nLSMem = nLineSpace;
-    void *pDataMem = pData;
-    GDALDataType eDTMem = eBufType;
-    if (eBufType != eDataType)
-    {
-        nPSMem = GDALGetDataTypeSizeBytes(eDataType);
-        nLSMem = nPSMem * nBufXSize;
-        pTempBuffer =
-            VSI_MALLOC2_VERBOSE(nBufYSize, static_cast<size_t>(nLSMem));
-        if (pTempBuffer == nullptr)
-            return CE_Failure;
-        pDataMem = pTempBuffer;
-        eDTMem = eDataType;
-    }
-
-    poMEMDS =
-        MEMDataset::Create("", nDestXOffVirtual + nBufXSize,
-                           nDestYOffVirtual + nBufYSize, 0, eDTMem, nullptr);
-    GByte *pabyData = static_cast<GByte *>(pDataMem) -
-                      nPSMem * nDestXOffVirtual - nLSMem * nDestYOffVirtual;
-    GDALRasterBandH hMEMBand = MEMCreateRasterBandEx(
-        poMEMDS, 1, pabyData, eDTMem, nPSMem, nLSMem, false);
-    poMEMDS->SetBand(1, GDALRasterBand::FromHandle(hMEMBand));
-
-    const char *pszNBITS = GetMetadataItem("NBITS", "IMAGE_STRUCTURE");
-    if (pszNBITS)
-        reinterpret_cast<GDALRasterBand *>(hMEMBand)->SetMetadataItem(
-            "NBITS", pszNBITS, "IMAGE_STRUCTURE");
-
     CPLErr eErr = CE_None;
 
     // Do the resampling.
     if (bUseWarp)
     {
+        // Create a MEM dataset that wraps the output buffer.
+        GDALDataset *poMEMDS;
+        void *pTempBuffer = nullptr;
+        GSpacing nPSMem = nPixelSpace;
+        GSpacing nLSMem = nLineSpace;
+        void *pDataMem = pData;
+        GDALDataType eDTMem = eBufType;
+        if (eBufType != eDataType)
+        {
+            nPSMem = GDALGetDataTypeSizeBytes(eDataType);
+            nLSMem = nPSMem * nBufXSize;
+            pTempBuffer =
+                VSI_MALLOC2_VERBOSE(nBufYSize, static_cast<size_t>(nLSMem));
+            if (pTempBuffer == nullptr)
+                return CE_Failure;
+            pDataMem = pTempBuffer;
+            eDTMem = eDataType;
+        }
+
+        poMEMDS = MEMDataset::Create("", nDestXOffVirtual + nBufXSize,
+                                     nDestYOffVirtual + nBufYSize, 0, eDTMem,
+                                     nullptr);
+        GByte *pabyData = static_cast<GByte *>(pDataMem) -
+                          nPSMem * nDestXOffVirtual - nLSMem * nDestYOffVirtual;
+        GDALRasterBandH hMEMBand = MEMCreateRasterBandEx(
+            poMEMDS, 1, pabyData, eDTMem, nPSMem, nLSMem, false);
+        poMEMDS->SetBand(1, GDALRasterBand::FromHandle(hMEMBand));
+
+        const char *pszNBITS = GetMetadataItem("NBITS", "IMAGE_STRUCTURE");
+        if (pszNBITS)
+            reinterpret_cast<GDALRasterBand *>(hMEMBand)->SetMetadataItem(
+                "NBITS", pszNBITS, "IMAGE_STRUCTURE");
+
         int bHasNoData = FALSE;
         double dfNoDataValue = GetNoDataValue(&bHasNoData);
 
@@ -1197,6 +1400,16 @@ CPLErr GDALRasterBand::RasterIOResampled(
 
         if (hVRTDS)
             GDALClose(hVRTDS);
+
+        if (eBufType != eDataType)
+        {
+            CPL_IGNORE_RET_VAL(poMEMDS->GetRasterBand(1)->RasterIO(
+                GF_Read, nDestXOffVirtual, nDestYOffVirtual, nBufXSize,
+                nBufYSize, pData, nBufXSize, nBufYSize, eBufType, nPixelSpace,
+                nLineSpace, nullptr));
+        }
+        GDALClose(poMEMDS);
+        VSIFree(pTempBuffer);
     }
     else
     {
@@ -1270,29 +1483,58 @@ CPLErr GDALRasterBand::RasterIOResampled(
         if (nFullResYSizeQueried > nRasterYSize)
             nFullResYSizeQueried = nRasterYSize;
 
-        void *pChunk =
-            VSI_MALLOC3_VERBOSE(GDALGetDataTypeSizeBytes(eWrkDataType),
-                                nFullResXSizeQueried, nFullResYSizeQueried);
-        GByte *pabyChunkNoDataMask = nullptr;
-
         GDALRasterBand *poMaskBand = GetMaskBand();
         int l_nMaskFlags = GetMaskFlags();
 
         bool bUseNoDataMask = ((l_nMaskFlags & GMF_ALL_VALID) == 0);
-        if (bUseNoDataMask)
-        {
-            pabyChunkNoDataMask = static_cast<GByte *>(VSI_MALLOC2_VERBOSE(
-                nFullResXSizeQueried, nFullResYSizeQueried));
-        }
-        if (pChunk == nullptr ||
-            (bUseNoDataMask && pabyChunkNoDataMask == nullptr))
+
+        // The working buffers are re-used from one call to another.
+        GDALRasterIOResampledBuffersHolder oBuffersHolder;
+        auto &sBuffers = oBuffersHolder.Get();
+        const size_t nChunkPixels =
+            static_cast<size_t>(nFullResXSizeQueried) * nFullResYSizeQueried;
+        const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
+        const bool bTwoStepsConversion = eBufType != eDataType;
+        if (!sBuffers.Reserve(
+                nChunkPixels * GDALGetDataTypeSizeBytes(eWrkDataType),
+                bUseNoDataMask ? nChunkPixels : 0,
+                bTwoStepsConversion ? static_cast<size_t>(nBufXSize) * nDTSize
+                                    : 0))
         {
-            GDALClose(poMEMDS);
-            CPLFree(pChunk);
-            CPLFree(pabyChunkNoDataMask);
-            VSIFree(pTempBuffer);
             return CE_Failure;
         }
+        void *pChunk = sBuffers.abyChunk.data();
+        GByte *pabyChunkNoDataMask =
+            bUseNoDataMask ? sBuffers.abyChunkNoDataMask.data() : nullptr;
+
+        // Stands for the output buffer in the calls to the resampling
+        // function, which only queries its dimensions, data type and NBITS.
+        GDALRasterIOResampledTargetBand oTargetBand(
+            nDestXOffVirtual + nBufXSize, nDestYOffVirtual + nBufYSize,
+            eDataType, GetMetadataItem("NBITS", "IMAGE_STRUCTURE"));
+
+        // Write a line of the resampled values, of type eSrcDT, into the
+        // output buffer, going through the data type of the band to get the
+        // same rounding and clamping as a non-resampled request.
+        const auto WriteLine = [&](const void *pSrc, GDALDataType eSrcDT,
+                                   int nSrcPixelStride, int nDstX, int nDstY,
+                                   int nCount)
+        {
+            GByte *pabyDst = static_cast<GByte *>(pData) +
+                             static_cast<GPtrDiff_t>(nDstY) * nLineSpace +
+                             static_cast<GPtrDiff_t>(nDstX) * nPixelSpace;
+            if (bTwoStepsConversion && eSrcDT != eDataType)
+            {
+                GByte *pabyLine = sBuffers.abyLine.data();
+                GDALCopyWords(pSrc, eSrcDT, nSrcPixelStride, pabyLine,
+                              eDataType, nDTSize, nCount);
+                pSrc = pabyLine;
+                eSrcDT = eDataType;
+                nSrcPixelStride = nDTSize;
+            }
+            GDALCopyWords(pSrc, eSrcDT, nSrcPixelStride, pabyDst, eBufType,
+                          static_cast<int>(nPixelSpace), nCount);
+        };
 
         int nTotalBlocks = ((nBufXSize + nDstBlockXSize - 1) / nDstBlockXSize) *
                            ((nBufYSize + nDstBlockYSize - 1) / nDstBlockYSize);
@@ -1394,12 +1636,8 @@ CPLErr GDALRasterBand::RasterIOResampled(
                         {
                             for (int j = 0; j < nDstYCount; j++)
                             {
-                                GDALCopyWords(&dfNoDataValue, GDT_Float64, 0,
-                                              static_cast<GByte *>(pDataMem) +
-                                                  nLSMem * (j + nDstYOff) +
-                                                  nDstXOff * nPSMem,
-                                              eDTMem, static_cast<int>(nPSMem),
-                                              nDstXCount);
+                                WriteLine(&dfNoDataValue, GDT_Float64, 0,
+                                          nDstXOff, nDstYOff + j, nDstXCount);
                             }
                             bSkipResample = true;
                         }
@@ -1415,8 +1653,6 @@ CPLErr GDALRasterBand::RasterIOResampled(
                     const bool bPropagateNoData = false;
                     void *pDstBuffer = nullptr;
                     GDALDataType eDstBufferDataType = GDT_Unknown;
-                    GDALRasterBand *poMEMBand =
-                        GDALRasterBand::FromHandle(hMEMBand);
                     eErr = pfnResampleFunc(
                         dfXRatioDstToSrc, dfYRatioDstToSrc,
                         dfXOff - nXOff, /* == 0 if bHasXOffVirtual */
@@ -1429,17 +1665,22 @@ CPLErr GDALRasterBand::RasterIOResampled(
                         nChunkYSizeQueried, nDstXOff + nDestXOffVirtual,
                         nDstXOff + nDestXOffVirtual + nDstXCount,
                         nDstYOff + nDestYOffVirtual,
-                        nDstYOff + nDestYOffVirtual + nDstYCount, poMEMBand,
+                        nDstYOff + nDestYOffVirtual + nDstYCount, &oTargetBand,
                         &pDstBuffer, &eDstBufferDataType, pszResampling,
                         bHasNoData, dfNoDataValue, GetColorTable(), eDataType,
                         bPropagateNoData);
                     if (eErr == CE_None)
                     {
-                        eErr = poMEMBand->RasterIO(
-                            GF_Write, nDstXOff + nDestXOffVirtual,
-                            nDstYOff + nDestYOffVirtual, nDstXCount, nDstYCount,
-                            pDstBuffer, nDstXCount, nDstYCount,
-                            eDstBufferDataType, 0, 0, nullptr);
+                        const int nDstBufferDTSize =
+                            GDALGetDataTypeSizeBytes(eDstBufferDataType);
+                        for (int j = 0; j < nDstYCount; j++)
+                        {
+                            WriteLine(static_cast<GByte *>(pDstBuffer) +
+                                          static_cast<size_t>(j) * nDstXCount *
+                                              nDstBufferDTSize,
+                                      eDstBufferDataType, nDstBufferDTSize,
+                                      nDstXOff, nDstYOff + j, nDstXCount);
+                        }
                     }
                     CPLFree(pDstBuffer);
                 }
@@ -1453,20 +1694,7 @@ CPLErr GDALRasterBand::RasterIOResampled(
                 }
             }
         }
-
-        CPLFree(pChunk);
-        CPLFree(pabyChunkNoDataMask);
-    }
-
-    if (eBufType != eDataType)
-    {
-        CPL_IGNORE_RET_VAL(poMEMDS->GetRasterBand(1)->RasterIO(
-            GF_Read, nDestXOffVirtual, nDestYOffVirtual, nBufXSize, nBufYSize,
-            pData, nBufXSize, nBufYSize, eBufType, nPixelSpace, nLineSpace,
-            nullptr));
     }
-    GDALClose(poMEMDS);
-    VSIFree(pTempBuffer);
 
     return eErr;
 }
@@ -2517,6 +2745,14 @@ void GDALCopyWordsT(const GUInt16 *const CPL_RESTRICT pSrcData,
     if (nSrcPixelStride == static_cast<int>(sizeof(*pSrcData)) &&
         nDstPixelStride == static_cast<int>(sizeof(*pDstData)))
     {
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+        if (nWordCount >= 16 && CPLHaveRuntimeAVX2())
+        {
+            GDALCopyUInt16ToFloat32_AVX2(pSrcData, pDstData,
+                                         static_cast<size_t>(nWordCount));
+            return;
+        }
+#endif
         decltype(nWordCount) n = 0;
         const __m128i xmm_zero = _mm_setzero_si128();
         GByte *CPL_RESTRICT pabyDstDataPtr =
@@ -2605,6 +2841,29 @@ void GDALCopyWordsT(const double *const CPL_RESTRICT pSrcData,
                             nDstPixelStride, nWordCount);
 }
 
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+
+template <>
+void GDALCopyWordsT(const GInt16 *const CPL_RESTRICT pSrcData,
+                    int nSrcPixelStride, double *const CPL_RESTRICT pDstData,
+                    int nDstPixelStride, GPtrDiff_t nWordCount)
+{
+    if (nSrcPixelStride == static_cast<int>(sizeof(*pSrcData)) &&
+        nDstPixelStride == static_cast<int>(sizeof(*pDstData)) &&
+        nWordCount >= 16 && CPLHaveRuntimeAVX2())
+    {
+        GDALCopyInt16ToFloat64_AVX2(pSrcData, pDstData,
+                                    static_cast<size_t>(nWordCount));
+    }
+    else
+    {
+        GDALCopyWordsGenericT(pSrcData, nSrcPixelStride, pDstData,
+                              nDstPixelStride, nWordCount);
+    }
+}
+
+#endif  // HAVE_AVX2_AT_COMPILE_TIME
+
 #endif  // defined(__x86_64) || defined(_M_X64)
 
 template <>
@@ -2612,6 +2871,17 @@ void GDALCopyWordsT(const float *const CPL_RESTRICT pSrcData,
                     int nSrcPixelStride, GByte *const CPL_RESTRICT pDstData,
                     int nDstPixelStride, GPtrDiff_t nWordCount)
 {
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) &&                                      \
+    (defined(__x86_64) || defined(_M_X64))
+    if (nSrcPixelStride == static_cast<int>(sizeof(*pSrcData)) &&
+        nDstPixelStride == static_cast<int>(sizeof(*pDstData)) &&
+        nWordCount >= 32 && CPLHaveRuntimeAVX2())
+    {
+        GDALCopyFloat32ToByte_AVX2(pSrcData, pDstData,
+                                   static_cast<size_t>(nWordCount));
+        return;
+    }
+#endif
     GDALCopyWordsT_8atatime(pSrcData, nSrcPixelStride, pDstData,
                             nDstPixelStride, nWordCount);
 }
@@ -4536,6 +4806,215 @@ static void GDALCopyWholeRasterGetSwathSize(GDALRasterBand *poSrcPrototypeBand,
     *pnSwathLines = nSwathLines;
 }
 
+/************************************************************************/
+/*                  GDALCopyWholeRasterGetNumThreads()                  */
+/************************************************************************/
+
+static int GDALCopyWholeRasterGetNumThreads(CSLConstList papszOptions)
+{
+    const char *pszThreads = CSLFetchNameValueDef(
+        papszOptions, "NUM_THREADS",
+        CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    return std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                         ? CPLGetNumCPUs()
+                                         : atoi(pszThreads)));
+}
+
+/************************************************************************/
+/*                    GDALCopyWholeRasterPipelined()                    */
+/************************************************************************/
+
+namespace
+{
+struct GDALCopySwath
+{
+    int nBand;  // 0 for a pixel-interleaved swath of all bands
+    int nXOff;
+    int nYOff;
+    int nXSize;
+    int nYSize;
+};
+
+struct GDALCopyPipelineState
+{
+    const std::vector<GDALCopySwath> *paoSwaths = nullptr;
+    std::vector<void *> apBuffers{};
+    std::vector<bool> abSkip{};
+    std::function<CPLErr(const GDALCopySwath &, void *, bool &)> pfnRead{};
+    CPLStringList aosThreadLocalConfigOptions{};
+
+    std::mutex oMutex{};
+    std::condition_variable oCV{};
+    size_t nRead = 0;
+    size_t nWritten = 0;
+    bool bStop = false;
+    bool bReaderDone = false;
+    CPLErr eReadErr = CE_None;
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+};
+}  // namespace
+
+// Reads the swaths in order in a worker thread while the calling thread
+// writes the previously read ones, so that read I/O (and data type
+// conversion) overlaps with the encoding done by the destination driver.
+// The number of swaths in flight is bounded by the number of buffers.
+// The source is only accessed by the worker thread, and the destination
+// and the progress callback only by the calling thread.
+// Returns false if the pipeline could not be set up, in which case nothing
+// has been done.
+
+static bool GDALCopyWholeRasterPipelined(
+    int nThreads, const std::vector<GDALCopySwath> &aoSwaths,
+    void *pFirstBuffer, size_t nBufferSize,
+    const std::function<CPLErr(const GDALCopySwath &, void *, bool &)>
+        &pfnRead,
+    const std::function<CPLErr(const GDALCopySwath &, void *)> &pfnWrite,
+    GDALProgressFunc pfnProgress, void *pProgressData, CPLErr &eErr)
+{
+    auto poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
+    if (!poJobQueue)
+        return false;
+
+    // Double buffering is enough for reads to overlap writes.
+    constexpr int N_BUFFERS = 2;
+    GDALCopyPipelineState sState;
+    sState.paoSwaths = &aoSwaths;
+    sState.apBuffers.push_back(pFirstBuffer);
+    for (int i = 1; i < N_BUFFERS; ++i)
+    {
+        void *pBuffer = VSI_MALLOC_VERBOSE(nBufferSize);
+        if (pBuffer == nullptr)
+            break;
+        sState.apBuffers.push_back(pBuffer);
+    }
+    const auto FreeExtraBuffers = [&sState]()
+    {
+        for (size_t i = 1; i < sState.apBuffers.size(); ++i)
+            VSIFree(sState.apBuffers[i]);
+    };
+    if (sState.apBuffers.size() < static_cast<size_t>(N_BUFFERS))
+    {
+        // Not enough memory: fallback to the sequential copy
+        CPLErrorReset();
+        FreeExtraBuffers();
+        return false;
+    }
+    sState.abSkip.resize(N_BUFFERS);
+    sState.pfnRead = pfnRead;
+    sState.aosThreadLocalConfigOptions.Assign(
+        CPLGetThreadLocalConfigOptions(), true);
+
+    const auto ReaderFunc = [](void *pData)
+    {
+        auto psState = static_cast<GDALCopyPipelineState *>(pData);
+        const int nBuffers = static_cast<int>(psState->apBuffers.size());
+        CPLStringList aosOldConfigOptions(
+            CPLGetThreadLocalConfigOptions(), true);
+        CPLSetThreadLocalConfigOptions(
+            psState->aosThreadLocalConfigOptions.List());
+        std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors;
+        CPLInstallErrorHandlerAccumulator(aoErrors);
+
+        const size_t nSwaths = psState->paoSwaths->size();
+        for (size_t i = 0; i < nSwaths; ++i)
+        {
+            {
+                std::unique_lock<std::mutex> oLock(psState->oMutex);
+                while (!psState->bStop &&
+                       i - psState->nWritten >= static_cast<size_t>(nBuffers))
+                {
+                    psState->oCV.wait(oLock);
+                }
+                if (psState->bStop)
+                    break;
+            }
+
+            bool bSkip = false;
+            const CPLErr eReadErr =
+                psState->pfnRead((*psState->paoSwaths)[i],
+                                 psState->apBuffers[i % nBuffers], bSkip);
+
+            std::lock_guard<std::mutex> oLock(psState->oMutex);
+            if (eReadErr != CE_None)
+            {
+                psState->eReadErr = eReadErr;
+                break;
+            }
+            psState->abSkip[i % nBuffers] = bSkip;
+            psState->nRead = i + 1;
+            psState->oCV.notify_one();
+        }
+
+        CPLUninstallErrorHandlerAccumulator();
+        CPLSetThreadLocalConfigOptions(aosOldConfigOptions.List());
+
+        std::lock_guard<std::mutex> oLock(psState->oMutex);
+        psState->aoErrors = std::move(aoErrors);
+        psState->bReaderDone = true;
+        psState->oCV.notify_one();
+    };
+
+    if (!poJobQueue->SubmitJob(ReaderFunc, &sState))
+    {
+        FreeExtraBuffers();
+        return false;
+    }
+
+    const size_t nSwaths = aoSwaths.size();
+    for (size_t i = 0; i < nSwaths && eErr == CE_None; ++i)
+    {
+        bool bSkip = false;
+        {
+            std::unique_lock<std::mutex> oLock(sState.oMutex);
+            while (sState.nRead <= i && !sState.bReaderDone)
+                sState.oCV.wait(oLock);
+            if (sState.nRead <= i)
+            {
+                eErr = sState.eReadErr != CE_None ? sState.eReadErr
+                                                  : CE_Failure;
+                break;
+            }
+            bSkip = sState.abSkip[i % N_BUFFERS];
+        }
+
+        if (!bSkip)
+            eErr = pfnWrite(aoSwaths[i], sState.apBuffers[i % N_BUFFERS]);
+
+        {
+            std::lock_guard<std::mutex> oLock(sState.oMutex);
+            sState.nWritten = i + 1;
+            sState.oCV.notify_one();
+        }
+
+        if (eErr == CE_None &&
+            !pfnProgress(static_cast<double>(i + 1) / nSwaths, nullptr,
+                         pProgressData))
+        {
+            eErr = CE_Failure;
+            CPLError(CE_Failure, CPLE_UserInterrupt,
+                     "User terminated CreateCopy()");
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(sState.oMutex);
+        sState.bStop = true;
+        sState.oCV.notify_one();
+    }
+    poJobQueue->WaitCompletion();
+
+    // Re-emit in the calling thread the errors of the reader thread
+    for (const auto &oError : sState.aoErrors)
+    {
+        CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+    }
+
+    FreeExtraBuffers();
+    return true;
+}
+
 /************************************************************************/
 /*                     GDALDatasetCopyWholeRaster()                     */
 /************************************************************************/
@@ -4561,6 +5040,11 @@ static void GDALCopyWholeRasterGetSwathSize(GDALRasterBand *poSrcPrototypeBand,
  * sizes to achieve best compression.</li> <li>"SKIP_HOLES=YES" to skip chunks
  * for which GDALGetDataCoverageStatus() returns GDAL_DATA_COVERAGE_STATUS_EMPTY
  * (GDAL &gt;= 2.2)</li>
+ * <li>"NUM_THREADS=integer|ALL_CPUS" to read swaths from the source dataset in
+ * a worker thread, while the previous swath is written to the destination
+ * dataset (GDAL &gt;= 3.9). Defaults to the value of the GDAL_NUM_THREADS
+ * configuration option. The source and destination datasets must not share
+ * any underlying object.</li>
  * </ul>
  * More options may be supported in the future.
  *
@@ -4696,14 +5180,89 @@ CPLErr CPL_STDCALL GDALDatasetCopyWholeRaster(GDALDatasetH hSrcDS,
     poSrcDS->AdviseRead(0, 0, nXSize, nYSize, nXSize, nYSize, eDT, nBandCount,
                         nullptr, nullptr);
 
-    /* ==================================================================== */
-    /*      Band oriented (uninterleaved) case.                             */
-    /* ==================================================================== */
     CPLErr eErr = CE_None;
     const bool bCheckHoles =
         CPLTestBool(CSLFetchNameValueDef(papszOptions, "SKIP_HOLES", "NO"));
 
-    if (!bInterleave)
+    /* ==================================================================== */
+    /*      Pipelined case: reads and writes run concurrently.              */
+    /* ==================================================================== */
+    bool bDone = false;
+    const int nThreads = GDALCopyWholeRasterGetNumThreads(papszOptions);
+    if (nThreads > 1)
+    {
+        std::vector<GDALCopySwath> aoSwaths;
+        for (int iBand = 0; iBand < (bInterleave ? 1 : nBandCount); iBand++)
+        {
+            for (int iY = 0; iY < nYSize; iY += nSwathLines)
+            {
+                for (int iX = 0; iX < nXSize; iX += nSwathCols)
+                {
+                    aoSwaths.push_back({bInterleave ? 0 : iBand + 1, iX, iY,
+                                        std::min(nSwathCols, nXSize - iX),
+                                        std::min(nSwathLines, nYSize - iY)});
+                }
+            }
+        }
+
+        const auto ReadSwath = [poSrcDS, nBandCount, eDT,
+                                bCheckHoles](const GDALCopySwath &sSwath,
+                                             void *pBuffer, bool &bSkip)
+        {
+            int nStatus = GDAL_DATA_COVERAGE_STATUS_DATA;
+            if (bCheckHoles)
+            {
+                nStatus = 0;
+                for (int iBand = 0; iBand < nBandCount; iBand++)
+                {
+                    if (sSwath.nBand != 0 && sSwath.nBand != iBand + 1)
+                        continue;
+                    nStatus |= poSrcDS->GetRasterBand(iBand + 1)
+                                   ->GetDataCoverageStatus(
+                                       sSwath.nXOff, sSwath.nYOff,
+                                       sSwath.nXSize, sSwath.nYSize,
+                                       GDAL_DATA_COVERAGE_STATUS_DATA);
+                    if (nStatus & GDAL_DATA_COVERAGE_STATUS_DATA)
+                        break;
+                }
+            }
+            bSkip = !(nStatus & GDAL_DATA_COVERAGE_STATUS_DATA);
+            if (bSkip)
+                return CE_None;
+            int nBand = sSwath.nBand;
+            return poSrcDS->RasterIO(
+                GF_Read, sSwath.nXOff, sSwath.nYOff, sSwath.nXSize,
+                sSwath.nYSize, pBuffer, sSwath.nXSize, sSwath.nYSize, eDT,
+                nBand == 0 ? nBandCount : 1, nBand == 0 ? nullptr : &nBand, 0,
+                0, 0, nullptr);
+        };
+
+        const auto WriteSwath =
+            [poDstDS, nBandCount, eDT](const GDALCopySwath &sSwath,
+                                       void *pBuffer)
+        {
+            int nBand = sSwath.nBand;
+            return poDstDS->RasterIO(
+                GF_Write, sSwath.nXOff, sSwath.nYOff, sSwath.nXSize,
+                sSwath.nYSize, pBuffer, sSwath.nXSize, sSwath.nYSize, eDT,
+                nBand == 0 ? nBandCount : 1, nBand == 0 ? nullptr : &nBand, 0,
+                0, 0, nullptr);
+        };
+
+        bDone = GDALCopyWholeRasterPipelined(
+            nThreads, aoSwaths, pSwathBuf,
+            static_cast<size_t>(nSwathCols) * nSwathLines * nPixelSize,
+            ReadSwath, WriteSwath, pfnProgress, pProgressData, eErr);
+    }
+
+    /* ==================================================================== */
+    /*      Band oriented (uninterleaved) case.                             */
+    /* ==================================================================== */
+    if (bDone)
+    {
+        // Already done
+    }
+    else if (!bInterleave)
     {
         GDALRasterIOExtraArg sExtraArg;
         INIT_RASTERIO_EXTRA_ARG(sExtraArg);
@@ -4889,6 +5448,10 @@ CPLErr CPL_STDCALL GDALDatasetCopyWholeRaster(GDALDatasetH hSrcDS,
  * achieve best compression.</li>
  * <li>"SKIP_HOLES=YES" to skip chunks for which GDALGetDataCoverageStatus()
  * returns GDAL_DATA_COVERAGE_STATUS_EMPTY (GDAL &gt;= 2.2)</li>
+ * <li>"NUM_THREADS=integer|ALL_CPUS" to read swaths from the source band in
+ * a worker thread, while the previous swath is written to the destination
+ * band (GDAL &gt;= 3.9). Defaults to the value of the GDAL_NUM_THREADS
+ * configuration option.</li>
  * </ul>
  *
  * @param hSrcBand the source band
@@ -4977,6 +5540,61 @@ CPLErr CPL_STDCALL GDALRasterBandCopyWholeRaster(
     // Advise the source raster that we are going to read it completely
     poSrcBand->AdviseRead(0, 0, nXSize, nYSize, nXSize, nYSize, eDT, nullptr);
 
+    /* ==================================================================== */
+    /*      Pipelined case: reads and writes run concurrently.              */
+    /* ==================================================================== */
+    const int nThreads = GDALCopyWholeRasterGetNumThreads(papszOptions);
+    if (nThreads > 1)
+    {
+        std::vector<GDALCopySwath> aoSwaths;
+        for (int iY = 0; iY < nYSize; iY += nSwathLines)
+        {
+            for (int iX = 0; iX < nXSize; iX += nSwathCols)
+            {
+                aoSwaths.push_back({1, iX, iY,
+                                    std::min(nSwathCols, nXSize - iX),
+                                    std::min(nSwathLines, nYSize - iY)});
+            }
+        }
+
+        const auto ReadSwath = [poSrcBand, eDT, bCheckHoles](
+                                   const GDALCopySwath &sSwath, void *pBuffer,
+                                   bool &bSkip)
+        {
+            if (bCheckHoles)
+            {
+                const int nStatus = poSrcBand->GetDataCoverageStatus(
+                    sSwath.nXOff, sSwath.nYOff, sSwath.nXSize, sSwath.nYSize,
+                    GDAL_DATA_COVERAGE_STATUS_DATA);
+                bSkip = !(nStatus & GDAL_DATA_COVERAGE_STATUS_DATA);
+                if (bSkip)
+                    return CE_None;
+            }
+            return poSrcBand->RasterIO(GF_Read, sSwath.nXOff, sSwath.nYOff,
+                                       sSwath.nXSize, sSwath.nYSize, pBuffer,
+                                       sSwath.nXSize, sSwath.nYSize, eDT, 0, 0,
+                                       nullptr);
+        };
+
+        const auto WriteSwath =
+            [poDstBand, eDT](const GDALCopySwath &sSwath, void *pBuffer)
+        {
+            return poDstBand->RasterIO(GF_Write, sSwath.nXOff, sSwath.nYOff,
+                                       sSwath.nXSize, sSwath.nYSize, pBuffer,
+                                       sSwath.nXSize, sSwath.nYSize, eDT, 0, 0,
+                                       nullptr);
+        };
+
+        if (GDALCopyWholeRasterPipelined(
+                nThreads, aoSwaths, pSwathBuf,
+                static_cast<size_t>(nSwathCols) * nSwathLines * nPixelSize,
+                ReadSwath, WriteSwath, pfnProgress, pProgressData, eErr))
+        {
+            CPLFree(pSwathBuf);
+            return eErr;
+        }
+    }
+
     /* ==================================================================== */
     /*      Band oriented (uninterleaved) case.                             */
     /* ==================================================================== */
@@ -0,0 +1,145 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX2 specializations
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) &&                                      \
+    (defined(__x86_64) || defined(_M_X64))
+
+#include "rasterio_avx2.h"
+
+#include <immintrin.h>
+
+// Note: we deliberately do not include gdal_priv_templates.hpp here, so that
+// no inline function shared with other translation units gets instantiated
+// with AVX2 code generation enabled.
+
+/************************************************************************/
+/*                     GDALCopyFloat32ToByte_AVX2()                     */
+/************************************************************************/
+
+// Same semantics as GDALCopyWord(float, GByte): round to nearest, clamp to
+// [0, 255], and NaN mapped to 0.
+void GDALCopyFloat32ToByte_AVX2(const float *CPL_RESTRICT pafSrc,
+                                GByte *CPL_RESTRICT pabyDest, size_t nIters)
+{
+    size_t i = 0;
+    const __m256 ymm_p0d5 = _mm256_set1_ps(0.5f);
+    const __m256 ymm_max = _mm256_set1_ps(255.0f);
+    // Undo the lane interleaving caused by the 2 pack operations
+    const __m256i ymm_permute = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    for (; i + 31 < nIters; i += 32)
+    {
+        __m256 ymm0 = _mm256_loadu_ps(pafSrc + i + 0);
+        __m256 ymm1 = _mm256_loadu_ps(pafSrc + i + 8);
+        __m256 ymm2 = _mm256_loadu_ps(pafSrc + i + 16);
+        __m256 ymm3 = _mm256_loadu_ps(pafSrc + i + 24);
+
+        // max(NaN, 0.5) returns 0.5, hence NaN is mapped to 0
+        ymm0 = _mm256_min_ps(
+            _mm256_max_ps(_mm256_add_ps(ymm0, ymm_p0d5), ymm_p0d5), ymm_max);
+        ymm1 = _mm256_min_ps(
+            _mm256_max_ps(_mm256_add_ps(ymm1, ymm_p0d5), ymm_p0d5), ymm_max);
+        ymm2 = _mm256_min_ps(
+            _mm256_max_ps(_mm256_add_ps(ymm2, ymm_p0d5), ymm_p0d5), ymm_max);
+        ymm3 = _mm256_min_ps(
+            _mm256_max_ps(_mm256_add_ps(ymm3, ymm_p0d5), ymm_p0d5), ymm_max);
+
+        const __m256i ymm01 = _mm256_packs_epi32(_mm256_cvttps_epi32(ymm0),
+                                                 _mm256_cvttps_epi32(ymm1));
+        const __m256i ymm23 = _mm256_packs_epi32(_mm256_cvttps_epi32(ymm2),
+                                                 _mm256_cvttps_epi32(ymm3));
+        const __m256i ymm_bytes = _mm256_permutevar8x32_epi32(
+            _mm256_packus_epi16(ymm01, ymm23), ymm_permute);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(pabyDest + i),
+                            ymm_bytes);
+    }
+    for (; i < nIters; ++i)
+    {
+        const float fVal = pafSrc[i] + 0.5f;
+        // NaN fails both comparisons and ends up as 0
+        pabyDest[i] = fVal >= 255.0f  ? static_cast<GByte>(255)
+                      : fVal >= 1.0f ? static_cast<GByte>(fVal)
+                                     : static_cast<GByte>(0);
+    }
+}
+
+/************************************************************************/
+/*                    GDALCopyUInt16ToFloat32_AVX2()                    */
+/************************************************************************/
+
+void GDALCopyUInt16ToFloat32_AVX2(const GUInt16 *CPL_RESTRICT panSrc,
+                                  float *CPL_RESTRICT pafDest, size_t nIters)
+{
+    size_t i = 0;
+    for (; i + 15 < nIters; i += 16)
+    {
+        const __m128i xmm0 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(panSrc + i));
+        const __m128i xmm1 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(panSrc + i + 8));
+        _mm256_storeu_ps(pafDest + i,
+                         _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(xmm0)));
+        _mm256_storeu_ps(pafDest + i + 8,
+                         _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(xmm1)));
+    }
+    for (; i < nIters; ++i)
+    {
+        pafDest[i] = panSrc[i];
+    }
+}
+
+/************************************************************************/
+/*                    GDALCopyInt16ToFloat64_AVX2()                     */
+/************************************************************************/
+
+void GDALCopyInt16ToFloat64_AVX2(const GInt16 *CPL_RESTRICT panSrc,
+                                 double *CPL_RESTRICT padfDest, size_t nIters)
+{
+    size_t i = 0;
+    for (; i + 15 < nIters; i += 16)
+    {
+        const __m256i ymm0 = _mm256_cvtepi16_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(panSrc + i)));
+        const __m256i ymm1 = _mm256_cvtepi16_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(panSrc + i + 8)));
+        _mm256_storeu_pd(padfDest + i,
+                         _mm256_cvtepi32_pd(_mm256_castsi256_si128(ymm0)));
+        _mm256_storeu_pd(padfDest + i + 4,
+                         _mm256_cvtepi32_pd(_mm256_extracti128_si256(ymm0, 1)));
+        _mm256_storeu_pd(padfDest + i + 8,
+                         _mm256_cvtepi32_pd(_mm256_castsi256_si128(ymm1)));
+        _mm256_storeu_pd(padfDest + i + 12,
+                         _mm256_cvtepi32_pd(_mm256_extracti128_si256(ymm1, 1)));
+    }
+    for (; i < nIters; ++i)
+    {
+        padfDest[i] = panSrc[i];
+    }
+}
+
+#endif  // HAVE_AVX2_AT_COMPILE_TIME
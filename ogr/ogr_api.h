@@ -741,6 +741,10 @@ bool CPL_DLL OGR_L_WriteArrowBatch(OGRLayerH hLayer,
                                    struct ArrowArray *array,
                                    char **papszOptions);
 
+int CPL_DLL OGR_L_GetNextFeatureBatch(OGRLayerH hLayer, int nColumns,
+                                      OGRFeatureBatchColumn *pasColumns,
+                                      int nMaxFeatures);
+
 OGRErr CPL_DLL OGR_L_SetNextByIndex(OGRLayerH, GIntBig);
 OGRFeatureH CPL_DLL OGR_L_GetFeature(OGRLayerH, GIntBig) CPL_WARN_UNUSED_RESULT;
 OGRErr CPL_DLL OGR_L_SetFeature(OGRLayerH, OGRFeatureH) CPL_WARN_UNUSED_RESULT;
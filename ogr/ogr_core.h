@@ -988,6 +988,55 @@ inline int OGR_GET_MS(float fSec)
 int CPL_DLL OGRParseDate(const char *pszInput, OGRField *psOutput,
                          int nOptions);
 
+/** Content of a column filled by OGR_L_GetNextFeatureBatch()
+ * @since GDAL 3.9
+ */
+typedef enum
+{
+    /** Feature identifier, as GIntBig values */
+    OBC_FID = 0,
+    /** Attribute field */
+    OBC_FIELD = 1,
+    /** Geometry field, as little-endian ISO WKB */
+    OBC_GEOMETRY = 2
+} OGRFeatureBatchColumnType;
+
+/** Caller-provided buffers of a column filled by OGR_L_GetNextFeatureBatch().
+ *
+ * Fixed-size values are written in pValues: GIntBig for OBC_FID and
+ * OFTInteger64 fields, int for OFTInteger fields and double for OFTReal
+ * fields.
+ *
+ * Other fields (OFTString, OFTBinary, date/time and list fields, the latter
+ * ones formatted as OGRFeature::GetFieldAsString() does) and geometries are
+ * variable-sized: the bytes of feature i are pabyData[panOffsets[i]] to
+ * pabyData[panOffsets[i+1]-1]. Strings are not nul-terminated.
+ *
+ * @since GDAL 3.9
+ */
+typedef struct
+{
+    /** Content of the column */
+    OGRFeatureBatchColumnType eType;
+    /** Index of the attribute or geometry field. Ignored for OBC_FID */
+    int iField;
+    /** Array of nMaxFeatures fixed-size values. Unused for variable-sized
+     * columns */
+    void *pValues;
+    /** Array of nMaxFeatures + 1 offsets in pabyData. Unused for fixed-size
+     * columns */
+    size_t *panOffsets;
+    /** Buffer for the variable-sized values. May be NULL initially. It must
+     * be allocated with VSIMalloc(), as it is grown with VSIRealloc() when
+     * needed, and freed by the caller with VSIFree() */
+    GByte *pabyData;
+    /** Allocated size of pabyData, in bytes */
+    size_t nDataCapacity;
+    /** Optional array of nMaxFeatures bytes, set to 1 for null or unset
+     * values and 0 otherwise */
+    GByte *pabyIsNull;
+} OGRFeatureBatchColumn;
+
 /* -------------------------------------------------------------------- */
 /*      Constants from ogrsf_frmts.h for capabilities.                  */
 /* -------------------------------------------------------------------- */
@@ -850,8 +850,21 @@ class CPL_DLL OGRFeature
     OGRField *pauFields;
     char *m_pszNativeData;
     char *m_pszNativeMediaType;
+    // Whether papoGeometries points inside the pauFields allocation
+    bool m_bGeometriesInFieldsBlock = false;
+    // WKB of the geometry fields set with SetGeomFieldLazyWkb() and not
+    // parsed yet (empty if none)
+    mutable std::vector<std::vector<GByte>> m_aabyLazyWkb{};
 
     bool SetFieldInternal(int i, const OGRField *puValue);
+    OGRErr SetFieldsFromInternal(const OGRFeature *poSrcFeature,
+                                 OGRFeature *poSrcFeatureToStealFrom,
+                                 const int *panMap, int bForgiving,
+                                 bool bUseISO8601ForDateTimeAsString);
+    void DetachGeometriesFromFieldsBlock();
+    OGRGeometry *InstantiateLazyGeometry(int iField) const;
+    bool GetFirstGeomFieldArea(double &dfArea) const;
+    void DiscardLazyWkb(int iField);
 
   protected:
     //! @cond Doxygen_Suppress
@@ -1160,6 +1173,9 @@ class CPL_DLL OGRFeature
     const OGRGeometry *GetGeomFieldRef(const char *pszFName) const;
     OGRErr SetGeomFieldDirectly(int iField, OGRGeometry *);
     OGRErr SetGeomField(int iField, const OGRGeometry *);
+    OGRErr SetGeomFieldLazyWkb(int iField, const GByte *pabyWkb,
+                               size_t nWkbSize);
+    const GByte *GetGeomFieldLazyWkb(int iField, size_t &nWkbSize) const;
 
     void Reset();
 
@@ -1392,6 +1408,9 @@ class CPL_DLL OGRFeature
     OGRErr SetFieldsFrom(const OGRFeature *, const int *panMap,
                          int bForgiving = TRUE,
                          bool bUseISO8601ForDateTimeAsString = false);
+    OGRErr SetFromStealing(OGRFeature *, const int *panMap,
+                           int bForgiving = TRUE,
+                           bool bUseISO8601ForDateTimeAsString = false);
 
     //! @cond Doxygen_Suppress
     OGRErr RemapFields(OGRFeatureDefn *poNewDefn, const int *panRemapSource);
@@ -1844,12 +1863,18 @@ class swq_expr_node;
 class swq_custom_func_registrar;
 struct swq_evaluation_context;
 
+struct OGRFeatureQueryCompiledNode;
+
 class CPL_DLL OGRFeatureQuery
 {
   private:
     OGRFeatureDefn *poTargetDefn;
     void *pSWQExpr;
     swq_evaluation_context *m_psContext = nullptr;
+    std::unique_ptr<OGRFeatureQueryCompiledNode> m_poCompiledExpr{};
+
+    std::unique_ptr<OGRFeatureQueryCompiledNode>
+    CompileNode(const swq_expr_node *) const;
 
     char **FieldCollector(void *, char **);
 
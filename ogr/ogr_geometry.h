@@ -4026,6 +4026,11 @@ class CPL_DLL OGRGeometryFactory
         char **papszOptions,
         const TransformWithOptionsCache &cache = TransformWithOptionsCache());
 
+    static OGRErr transformGeometries(OGRGeometry *const *papoGeoms,
+                                      size_t nGeomCount,
+                                      OGRCoordinateTransformation *poCT,
+                                      OGRErr *peErrors = nullptr);
+
     static OGRGeometry *
     approximateArcAngles(double dfX, double dfY, double dfZ,
                          double dfPrimaryRadius, double dfSecondaryAxis,
@@ -230,6 +230,17 @@ OGRErr CPL_DLL OGRReadWKBGeometryType(const unsigned char *pabyData,
 OGRErr CPL_DLL OGRReadWKTGeometryType(const char *pszWKT,
                                       OGRwkbGeometryType *peGeometryType);
 
+/************************************************************************/
+/*                        Coordinate transformation                     */
+/************************************************************************/
+
+class OGRCoordinateTransformation;
+
+void OGRTransformGeometriesPoints(OGRGeometry *const *papoGeoms,
+                                  size_t nGeomCount,
+                                  OGRCoordinateTransformation *poCT,
+                                  bool *pabTransformed);
+
 /************************************************************************/
 /*                            Other                                     */
 /************************************************************************/
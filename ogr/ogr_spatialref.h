@@ -1002,4 +1002,11 @@ OGRCoordinateTransformation CPL_DLL *OGRCreateCoordinateTransformation(
     const OGRSpatialReference *poSource, const OGRSpatialReference *poTarget,
     const OGRCoordinateTransformationOptions &options);
 
+/*! @cond Doxygen_Suppress */
+std::unique_ptr<OGRSpatialReference>
+    CPL_DLL OSRGetFromSharedCache(const std::string &osKey);
+void CPL_DLL OSRInsertIntoSharedCache(const std::string &osKey,
+                                      const OGRSpatialReference &oSRS);
+/*! @endcond */
+
 #endif /* ndef OGR_SPATIALREF_H_INCLUDED */
@@ -1072,6 +1072,603 @@ void OGRWKBFixupCounterClockWiseExternalRing(GByte *pabyWkb, size_t nWKBSize)
         pabyWkb, nWKBSize, iOffsetInOut, /* nRec = */ 0);
 }
 
+/************************************************************************/
+/*                        OGRWKBFlatReadPoints()                        */
+/************************************************************************/
+
+static bool OGRWKBFlatReadPoints(const GByte *data, size_t size,
+                                 size_t &iOffset, bool bNeedSwap, int nDim,
+                                 bool bHasZ, bool bWithZ, bool bIsRing,
+                                 OGRWKBFlatGeometry &oGeom, int &nPartCount)
+{
+    if (size - iOffset < sizeof(uint32_t))
+        return false;
+    const uint32_t nPoints = OGRWKBReadUInt32(data + iOffset, bNeedSwap);
+    iOffset += sizeof(uint32_t);
+    if (nPoints > (size - iOffset) / (nDim * sizeof(double)))
+        return false;
+    if (nPoints == 0)
+        return true;
+
+    oGeom.abClockwise.push_back(
+        bIsRing && (nPoints < 2 || OGRWKBIsClockwiseRing(data + iOffset,
+                                                         nPoints, nDim,
+                                                         bNeedSwap)));
+
+    const size_t nOldCount = oGeom.adfX.size();
+    oGeom.adfX.resize(nOldCount + nPoints);
+    oGeom.adfY.resize(nOldCount + nPoints);
+    if (bWithZ)
+        oGeom.adfZ.resize(nOldCount + nPoints);
+    for (uint32_t i = 0; i < nPoints; ++i)
+    {
+        oGeom.adfX[nOldCount + i] =
+            OGRWKBReadFloat64(data + iOffset, bNeedSwap);
+        oGeom.adfY[nOldCount + i] =
+            OGRWKBReadFloat64(data + iOffset + sizeof(double), bNeedSwap);
+        if (bWithZ)
+        {
+            oGeom.adfZ[nOldCount + i] =
+                bHasZ ? OGRWKBReadFloat64(data + iOffset + 2 * sizeof(double),
+                                          bNeedSwap)
+                      : 0.0;
+        }
+        iOffset += nDim * sizeof(double);
+    }
+    oGeom.anPartSize.push_back(static_cast<int>(nPoints));
+    ++nPartCount;
+    return true;
+}
+
+/************************************************************************/
+/*                          OGRWKBFlatImport()                          */
+/************************************************************************/
+
+// If pnParentPartCount is not null, the parts of the geometry are accounted
+// to the member of its parent (points of a multipoint).
+static bool OGRWKBFlatImport(const GByte *data, size_t size, size_t &iOffset,
+                             bool bWithZ, OGRWKBFlatGeometry &oGeom, int nRec,
+                             int *pnParentPartCount)
+{
+    if (nRec == 32 || size - iOffset < MIN_WKB_SIZE)
+        return false;
+    const int nByteOrder = DB2_V72_FIX_BYTE_ORDER(data[iOffset]);
+    if (!(nByteOrder == wkbXDR || nByteOrder == wkbNDR))
+        return false;
+    const bool bNeedSwap = OGR_SWAP(static_cast<OGRwkbByteOrder>(nByteOrder));
+
+    OGRwkbGeometryType eGeometryType = wkbUnknown;
+    if (OGRReadWKBGeometryType(data + iOffset, wkbVariantIso,
+                               &eGeometryType) != OGRERR_NONE)
+    {
+        return false;
+    }
+    iOffset += WKB_PREFIX_SIZE;
+    const auto eFlatType = wkbFlatten(eGeometryType);
+    const bool bHasZ = CPL_TO_BOOL(OGR_GT_HasZ(eGeometryType));
+    const int nDim = 2 + (bHasZ ? 1 : 0) + (OGR_GT_HasM(eGeometryType) ? 1 : 0);
+
+    int nPartCount = 0;
+    switch (eFlatType)
+    {
+        case wkbPoint:
+        {
+            if (size - iOffset < nDim * sizeof(double))
+                return false;
+            const double dfX = OGRWKBReadFloat64(data + iOffset, bNeedSwap);
+            const double dfY =
+                OGRWKBReadFloat64(data + iOffset + sizeof(double), bNeedSwap);
+            if (!(std::isnan(dfX) && std::isnan(dfY)))
+            {
+                oGeom.adfX.push_back(dfX);
+                oGeom.adfY.push_back(dfY);
+                if (bWithZ)
+                {
+                    oGeom.adfZ.push_back(
+                        bHasZ ? OGRWKBReadFloat64(
+                                    data + iOffset + 2 * sizeof(double),
+                                    bNeedSwap)
+                              : 0.0);
+                }
+                oGeom.anPartSize.push_back(1);
+                oGeom.abClockwise.push_back(false);
+                ++nPartCount;
+            }
+            iOffset += nDim * sizeof(double);
+            break;
+        }
+
+        case wkbLineString:
+            if (!OGRWKBFlatReadPoints(data, size, iOffset, bNeedSwap, nDim,
+                                      bHasZ, bWithZ, false, oGeom,
+                                      nPartCount))
+                return false;
+            break;
+
+        case wkbPolygon:
+        {
+            if (size - iOffset < sizeof(uint32_t))
+                return false;
+            const uint32_t nRings = OGRWKBReadUInt32(data + iOffset, bNeedSwap);
+            iOffset += sizeof(uint32_t);
+            if (nRings > (size - iOffset) / sizeof(uint32_t))
+                return false;
+            for (uint32_t i = 0; i < nRings; ++i)
+            {
+                if (!OGRWKBFlatReadPoints(data, size, iOffset, bNeedSwap,
+                                          nDim, bHasZ, bWithZ, true, oGeom,
+                                          nPartCount))
+                    return false;
+            }
+            break;
+        }
+
+        case wkbMultiPoint:
+        case wkbMultiLineString:
+        case wkbMultiPolygon:
+        case wkbGeometryCollection:
+        {
+            if (size - iOffset < sizeof(uint32_t))
+                return false;
+            const uint32_t nGeoms = OGRWKBReadUInt32(data + iOffset, bNeedSwap);
+            iOffset += sizeof(uint32_t);
+            if (nGeoms > (size - iOffset) / MIN_WKB_SIZE)
+                return false;
+            for (uint32_t i = 0; i < nGeoms; ++i)
+            {
+                if (eFlatType == wkbMultiPoint)
+                {
+                    OGRwkbGeometryType eSubType = wkbUnknown;
+                    if (size - iOffset < MIN_WKB_SIZE ||
+                        OGRReadWKBGeometryType(data + iOffset, wkbVariantIso,
+                                               &eSubType) != OGRERR_NONE ||
+                        wkbFlatten(eSubType) != wkbPoint)
+                    {
+                        return false;
+                    }
+                }
+                if (!OGRWKBFlatImport(
+                        data, size, iOffset, bWithZ, oGeom, nRec + 1,
+                        eFlatType == wkbMultiPoint ? &nPartCount : nullptr))
+                {
+                    return false;
+                }
+            }
+            if (eFlatType != wkbMultiPoint)
+                return true;
+            break;
+        }
+
+        default:
+            return false;
+    }
+
+    if (pnParentPartCount)
+        *pnParentPartCount += nPartCount;
+    else if (nPartCount > 0)
+        oGeom.asMembers.push_back({eFlatType, nPartCount});
+    return true;
+}
+
+/************************************************************************/
+/*                   OGRWKBFlatGeometry::ImportFromWkb()                */
+/************************************************************************/
+
+/** Fills the object from a WKB geometry.
+ *
+ * Empty parts are skipped. Only points, linestrings, polygons and their
+ * multi/collection counterparts are supported.
+ *
+ * @param pabyWkb WKB geometry.
+ * @param nWKBSize Size of pabyWkb in bytes.
+ * @param bWithZ Whether adfZ must be filled (with 0 for 2D geometries).
+ * @return true in case of success, false for unsupported or corrupted WKB.
+ * @since 3.9
+ */
+bool OGRWKBFlatGeometry::ImportFromWkb(const GByte *pabyWkb, size_t nWKBSize,
+                                       bool bWithZ)
+{
+    Clear();
+    size_t iOffset = 0;
+    if (nWKBSize < MIN_WKB_SIZE ||
+        !OGRWKBFlatImport(pabyWkb, nWKBSize, iOffset, bWithZ, *this, 0,
+                          nullptr))
+    {
+        Clear();
+        return false;
+    }
+    OGRwkbGeometryType eGeometryType = wkbUnknown;
+    OGRReadWKBGeometryType(pabyWkb, wkbVariantIso, &eGeometryType);
+    eFlatType = wkbFlatten(eGeometryType);
+    return true;
+}
+
+/************************************************************************/
+/*                      OGRWKBFlatGeometry::Clear()                     */
+/************************************************************************/
+
+/** Empties the object, while keeping the capacity of its arrays.
+ * @since 3.9
+ */
+void OGRWKBFlatGeometry::Clear()
+{
+    eFlatType = wkbUnknown;
+    adfX.clear();
+    adfY.clear();
+    adfZ.clear();
+    anPartSize.clear();
+    abClockwise.clear();
+    asMembers.clear();
+}
+
+/************************************************************************/
+/*                          OGRWKBGetMeasure()                          */
+/************************************************************************/
+
+// Accumulates in dfValue the area (bArea = true) or the length
+// (bArea = false) of a linear geometry, with the same semantics as
+// OGR_G_Area() and OGR_G_Length(), restricted to linear types. Sub-geometries
+// only contribute if bAccount is true.
+static bool OGRWKBGetMeasure(const GByte *data, size_t size, size_t &iOffset,
+                             bool bArea, bool bAccount, int nRec,
+                             double &dfValue)
+{
+    if (nRec == 32 || size - iOffset < MIN_WKB_SIZE)
+        return false;
+    const int nByteOrder = DB2_V72_FIX_BYTE_ORDER(data[iOffset]);
+    if (!(nByteOrder == wkbXDR || nByteOrder == wkbNDR))
+        return false;
+    const bool bNeedSwap = OGR_SWAP(static_cast<OGRwkbByteOrder>(nByteOrder));
+
+    OGRwkbGeometryType eGeometryType = wkbUnknown;
+    if (OGRReadWKBGeometryType(data + iOffset, wkbVariantIso,
+                               &eGeometryType) != OGRERR_NONE)
+    {
+        return false;
+    }
+    iOffset += WKB_PREFIX_SIZE;
+    const auto eFlatType = wkbFlatten(eGeometryType);
+    const int nDim = 2 + (OGR_GT_HasZ(eGeometryType) ? 1 : 0) +
+                     (OGR_GT_HasM(eGeometryType) ? 1 : 0);
+    const size_t nPointSize = nDim * sizeof(double);
+
+    // Returns the area of a ring (or closed linestring) or the length of a
+    // linestring, and advances iOffset.
+    const auto ReadPoints = [data, size, &iOffset, bNeedSwap, nPointSize](
+                                bool bRingArea, bool bCurveArea,
+                                double &dfMeasure)
+    {
+        if (size - iOffset < sizeof(uint32_t))
+            return false;
+        const uint32_t nPoints = OGRWKBReadUInt32(data + iOffset, bNeedSwap);
+        iOffset += sizeof(uint32_t);
+        if (nPoints > (size - iOffset) / nPointSize)
+            return false;
+        const GByte *pabyPoints = data + iOffset;
+        iOffset += nPoints * nPointSize;
+        dfMeasure = 0;
+        const auto X = [pabyPoints, nPointSize, bNeedSwap](uint32_t i)
+        { return OGRWKBReadFloat64(pabyPoints + i * nPointSize, bNeedSwap); };
+        const auto Y = [pabyPoints, nPointSize, bNeedSwap](uint32_t i)
+        {
+            return OGRWKBReadFloat64(pabyPoints + i * nPointSize +
+                                         sizeof(double),
+                                     bNeedSwap);
+        };
+        if (bRingArea || bCurveArea)
+        {
+            // Cf OGRSimpleCurve::get_LinearArea()
+            if (nPoints < 2 || (bCurveArea && (X(0) != X(nPoints - 1) ||
+                                               Y(0) != Y(nPoints - 1))))
+            {
+                return true;
+            }
+            double dfAreaSum = X(0) * (Y(1) - Y(nPoints - 1));
+            for (uint32_t i = 1; i < nPoints - 1; i++)
+                dfAreaSum += X(i) * (Y(i + 1) - Y(i - 1));
+            dfAreaSum += X(nPoints - 1) * (Y(0) - Y(nPoints - 2));
+            dfMeasure = 0.5 * std::fabs(dfAreaSum);
+        }
+        else
+        {
+            for (uint32_t i = 1; i < nPoints; i++)
+            {
+                const double dfDX = X(i) - X(i - 1);
+                const double dfDY = Y(i) - Y(i - 1);
+                dfMeasure += std::sqrt(dfDX * dfDX + dfDY * dfDY);
+            }
+        }
+        return true;
+    };
+
+    switch (eFlatType)
+    {
+        case wkbPoint:
+            if (size - iOffset < nPointSize)
+                return false;
+            iOffset += nPointSize;
+            return true;
+
+        case wkbLineString:
+        {
+            double dfMeasure = 0;
+            if (!ReadPoints(false, bArea, dfMeasure))
+                return false;
+            if (bAccount)
+                dfValue += dfMeasure;
+            return true;
+        }
+
+        case wkbPolygon:
+        case wkbTriangle:
+        {
+            if (size - iOffset < sizeof(uint32_t))
+                return false;
+            const uint32_t nRings = OGRWKBReadUInt32(data + iOffset, bNeedSwap);
+            iOffset += sizeof(uint32_t);
+            if (nRings > (size - iOffset) / sizeof(uint32_t))
+                return false;
+            // Cf OGRCurvePolygon::get_Area()
+            double dfArea = 0;
+            for (uint32_t i = 0; i < nRings; ++i)
+            {
+                double dfRingArea = 0;
+                if (!ReadPoints(bArea, false, dfRingArea))
+                    return false;
+                dfArea += i == 0 ? dfRingArea : -dfRingArea;
+            }
+            if (bAccount && bArea)
+                dfValue += dfArea;
+            return true;
+        }
+
+        case wkbMultiPoint:
+        case wkbMultiLineString:
+        case wkbMultiPolygon:
+        case wkbGeometryCollection:
+        {
+            if (size - iOffset < sizeof(uint32_t))
+                return false;
+            const uint32_t nGeoms = OGRWKBReadUInt32(data + iOffset, bNeedSwap);
+            iOffset += sizeof(uint32_t);
+            if (nGeoms > (size - iOffset) / MIN_WKB_SIZE)
+                return false;
+            const bool bAccountParts =
+                bAccount && (eFlatType == wkbGeometryCollection ||
+                             eFlatType == (bArea ? wkbMultiPolygon
+                                                 : wkbMultiLineString));
+            for (uint32_t i = 0; i < nGeoms; ++i)
+            {
+                if (!OGRWKBGetMeasure(data, size, iOffset, bArea,
+                                      bAccountParts, nRec + 1, dfValue))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        default:
+            break;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                           OGRWKBGetArea()                            */
+/************************************************************************/
+
+/** Computes the area of a WKB geometry, without instantiating an
+ * OGRGeometry.
+ *
+ * The result is the one of OGR_G_Area(). Only linear polygons, linestrings,
+ * multipolygons and geometry collections are supported.
+ *
+ * @param pabyWkb WKB geometry.
+ * @param nWKBSize Size of pabyWkb in bytes.
+ * @param[out] dfArea Area.
+ * @return true in case of success, false for unsupported types (for which
+ * OGR_G_Area() should be used) or corrupted WKB.
+ * @since 3.9
+ */
+bool OGRWKBGetArea(const GByte *pabyWkb, size_t nWKBSize, double &dfArea)
+{
+    dfArea = 0;
+    OGRwkbGeometryType eGeometryType = wkbUnknown;
+    if (nWKBSize < MIN_WKB_SIZE ||
+        OGRReadWKBGeometryType(pabyWkb, wkbVariantIso, &eGeometryType) !=
+            OGRERR_NONE)
+    {
+        return false;
+    }
+    const auto eFlatType = wkbFlatten(eGeometryType);
+    if (eFlatType != wkbPolygon && eFlatType != wkbTriangle &&
+        eFlatType != wkbLineString && eFlatType != wkbMultiPolygon &&
+        eFlatType != wkbGeometryCollection)
+    {
+        return false;
+    }
+    size_t iOffset = 0;
+    if (!OGRWKBGetMeasure(pabyWkb, nWKBSize, iOffset, true, true, 0, dfArea))
+    {
+        dfArea = 0;
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                          OGRWKBGetLength()                           */
+/************************************************************************/
+
+/** Computes the length of a WKB geometry, without instantiating an
+ * OGRGeometry.
+ *
+ * The result is the one of OGR_G_Length(). Only linestrings,
+ * multilinestrings and geometry collections of linear geometries are
+ * supported.
+ *
+ * @param pabyWkb WKB geometry.
+ * @param nWKBSize Size of pabyWkb in bytes.
+ * @param[out] dfLength Length.
+ * @return true in case of success, false for unsupported types (for which
+ * OGR_G_Length() should be used) or corrupted WKB.
+ * @since 3.9
+ */
+bool OGRWKBGetLength(const GByte *pabyWkb, size_t nWKBSize, double &dfLength)
+{
+    dfLength = 0;
+    OGRwkbGeometryType eGeometryType = wkbUnknown;
+    if (nWKBSize < MIN_WKB_SIZE ||
+        OGRReadWKBGeometryType(pabyWkb, wkbVariantIso, &eGeometryType) !=
+            OGRERR_NONE)
+    {
+        return false;
+    }
+    const auto eFlatType = wkbFlatten(eGeometryType);
+    if (eFlatType != wkbLineString && eFlatType != wkbMultiLineString &&
+        eFlatType != wkbGeometryCollection)
+    {
+        return false;
+    }
+    size_t iOffset = 0;
+    if (!OGRWKBGetMeasure(pabyWkb, nWKBSize, iOffset, false, true, 0,
+                          dfLength))
+    {
+        dfLength = 0;
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                       OGRWKBPointInPolygon()                         */
+/************************************************************************/
+
+// Recursive implementation of OGRWKBPointInPolygon(). bInside is toggled
+// for each ring crossed by the ray going from the point towards +X, for
+// each polygon.
+static bool OGRWKBPointInPolygon(const GByte *data, size_t size,
+                                 size_t &iOffset, double dfX, double dfY,
+                                 int nRec, bool &bInside)
+{
+    if (nRec == 32 || size - iOffset < MIN_WKB_SIZE)
+        return false;
+    const int nByteOrder = DB2_V72_FIX_BYTE_ORDER(data[iOffset]);
+    if (!(nByteOrder == wkbXDR || nByteOrder == wkbNDR))
+        return false;
+    const bool bNeedSwap = OGR_SWAP(static_cast<OGRwkbByteOrder>(nByteOrder));
+
+    OGRwkbGeometryType eGeometryType = wkbUnknown;
+    if (OGRReadWKBGeometryType(data + iOffset, wkbVariantIso,
+                               &eGeometryType) != OGRERR_NONE)
+    {
+        return false;
+    }
+    iOffset += WKB_PREFIX_SIZE;
+    const auto eFlatType = wkbFlatten(eGeometryType);
+    const int nDim = 2 + (OGR_GT_HasZ(eGeometryType) ? 1 : 0) +
+                     (OGR_GT_HasM(eGeometryType) ? 1 : 0);
+    const size_t nPointSize = nDim * sizeof(double);
+
+    if (size - iOffset < sizeof(uint32_t))
+        return false;
+    const uint32_t nParts = OGRWKBReadUInt32(data + iOffset, bNeedSwap);
+    iOffset += sizeof(uint32_t);
+
+    if (eFlatType == wkbMultiPolygon)
+    {
+        if (nParts > (size - iOffset) / MIN_WKB_SIZE)
+            return false;
+        for (uint32_t i = 0; i < nParts; ++i)
+        {
+            bool bInsidePolygon = false;
+            if (!OGRWKBPointInPolygon(data, size, iOffset, dfX, dfY, nRec + 1,
+                                      bInsidePolygon))
+            {
+                return false;
+            }
+            if (bInsidePolygon)
+            {
+                bInside = true;
+                return true;
+            }
+        }
+        return true;
+    }
+
+    if (eFlatType != wkbPolygon && eFlatType != wkbTriangle)
+        return false;
+
+    if (nParts > (size - iOffset) / sizeof(uint32_t))
+        return false;
+    for (uint32_t iRing = 0; iRing < nParts; ++iRing)
+    {
+        if (size - iOffset < sizeof(uint32_t))
+            return false;
+        const uint32_t nPoints = OGRWKBReadUInt32(data + iOffset, bNeedSwap);
+        iOffset += sizeof(uint32_t);
+        if (nPoints > (size - iOffset) / nPointSize)
+            return false;
+        if (nPoints > 0)
+        {
+            double dfPrevX = OGRWKBReadFloat64(
+                data + iOffset + (nPoints - 1) * nPointSize, bNeedSwap);
+            double dfPrevY = OGRWKBReadFloat64(
+                data + iOffset + (nPoints - 1) * nPointSize + sizeof(double),
+                bNeedSwap);
+            for (uint32_t i = 0; i < nPoints; ++i)
+            {
+                const double dfCurX =
+                    OGRWKBReadFloat64(data + iOffset, bNeedSwap);
+                const double dfCurY = OGRWKBReadFloat64(
+                    data + iOffset + sizeof(double), bNeedSwap);
+                iOffset += nPointSize;
+                if (((dfCurY > dfY) != (dfPrevY > dfY)) &&
+                    dfX < (dfPrevX - dfCurX) * (dfY - dfCurY) /
+                                  (dfPrevY - dfCurY) +
+                              dfCurX)
+                {
+                    bInside = !bInside;
+                }
+                dfPrevX = dfCurX;
+                dfPrevY = dfCurY;
+            }
+        }
+    }
+    return true;
+}
+
+/** Returns whether a point is inside a WKB polygon or multipolygon, without
+ * instantiating an OGRGeometry.
+ *
+ * The even-odd rule is used, and the result for points on the boundary is
+ * unspecified. Use OGRGeometry::Contains() or Intersects() when an exact
+ * answer is needed.
+ *
+ * @param pabyWkb WKB geometry.
+ * @param nWKBSize Size of pabyWkb in bytes.
+ * @param dfX X coordinate of the point.
+ * @param dfY Y coordinate of the point.
+ * @param[out] bInside Whether the point is inside the polygon.
+ * @return true in case of success, false if the geometry is not a (multi)
+ * polygon or is corrupted.
+ * @since 3.9
+ */
+bool OGRWKBPointInPolygon(const GByte *pabyWkb, size_t nWKBSize, double dfX,
+                          double dfY, bool &bInside)
+{
+    bInside = false;
+    size_t iOffset = 0;
+    if (!OGRWKBPointInPolygon(pabyWkb, nWKBSize, iOffset, dfX, dfY, 0,
+                              bInside))
+    {
+        bInside = false;
+        return false;
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                         OGRAppendBuffer()                            */
 /************************************************************************/
@@ -32,6 +32,8 @@
 #include "cpl_port.h"
 #include "ogr_core.h"
 
+#include <vector>
+
 bool CPL_DLL OGRWKBGetGeomType(const GByte *pabyWkb, size_t nWKBSize,
                                bool &bNeedSwap, uint32_t &nType);
 bool OGRWKBPolygonGetArea(const GByte *&pabyWkb, size_t &nWKBSize,
@@ -48,6 +50,15 @@ bool CPL_DLL OGRWKBGetBoundingBox(const GByte *pabyWkb, size_t nWKBSize,
 bool CPL_DLL OGRWKBIntersectsPessimistic(const GByte *pabyWkb, size_t nWKBSize,
                                          const OGREnvelope &sEnvelope);
 
+bool CPL_DLL OGRWKBGetArea(const GByte *pabyWkb, size_t nWKBSize,
+                           double &dfArea);
+
+bool CPL_DLL OGRWKBGetLength(const GByte *pabyWkb, size_t nWKBSize,
+                             double &dfLength);
+
+bool CPL_DLL OGRWKBPointInPolygon(const GByte *pabyWkb, size_t nWKBSize,
+                                  double dfX, double dfY, bool &bInside);
+
 void CPL_DLL OGRWKBFixupCounterClockWiseExternalRing(GByte *pabyWkb,
                                                      size_t nWKBSize);
 
@@ -62,6 +73,53 @@ void CPL_DLL OGRWKBFixupCounterClockWiseExternalRing(GByte *pabyWkb,
 const GByte CPL_DLL *WKBFromEWKB(GByte *pabyEWKB, size_t nEWKBSize,
                                  size_t &nWKBSizeOut, int *pnSRIDOut);
 
+/************************************************************************/
+/*                         OGRWKBFlatGeometry                           */
+/************************************************************************/
+
+/** Flat representation of the vertices of a WKB geometry.
+ *
+ * The coordinates of all parts (points, linestrings and polygon rings) are
+ * stored contiguously in separate X, Y and Z arrays, similarly to the
+ * "separated" GeoArrow encodings, so that consumers such as the rasterizer
+ * do not need to build an OGRGeometry object tree.
+ *
+ * @since 3.9
+ */
+struct CPL_DLL OGRWKBFlatGeometry
+{
+    /** Member of the geometry: a point, linestring, polygon or multipoint,
+     * with the number of consecutive parts of anPartSize it is made of.
+     * Members of multi geometries and collections are listed recursively.
+     */
+    struct Member
+    {
+        /** Flat type of the member */
+        OGRwkbGeometryType eFlatType;
+        /** Number of parts (rings for a polygon, points for a multipoint) */
+        int nPartCount;
+    };
+
+    /** Flat type of the geometry */
+    OGRwkbGeometryType eFlatType = wkbUnknown;
+    /** X coordinates */
+    std::vector<double> adfX{};
+    /** Y coordinates */
+    std::vector<double> adfY{};
+    /** Z coordinates, if requested */
+    std::vector<double> adfZ{};
+    /** Number of points of each part */
+    std::vector<int> anPartSize{};
+    /** For each part, whether it is a polygon ring with clockwise orientation,
+     * as determined by OGRLinearRing::isClockwise() */
+    std::vector<bool> abClockwise{};
+    /** Members */
+    std::vector<Member> asMembers{};
+
+    bool ImportFromWkb(const GByte *pabyWkb, size_t nWKBSize, bool bWithZ);
+    void Clear();
+};
+
 /************************************************************************/
 /*                       OGRAppendBuffer                                */
 /************************************************************************/
@@ -31,12 +31,15 @@
 #include "ogr_spatialref.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cmath>
 #include <cstring>
 #include <limits>
 #include <list>
 #include <mutex>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -85,12 +88,40 @@ static void CPLGettimeofday(struct CPLTimeVal *tp, void * /* timezonep*/)
 
 #endif  // DEBUG_PERF
 
-// Cache of OGRProjCT objects
-static std::mutex g_oCTCacheMutex;
+// Cache of OGRProjCT objects. For each key, it holds the idle instances
+// released by OGRCoordinateTransformation::DestroyCT(), so that threads
+// creating the same transformation concurrently can each reuse one.
+// The cache is split into shards, each one protected by its own mutex, to
+// limit contention between threads.
 class OGRProjCT;
 typedef std::string CTCacheKey;
-typedef std::unique_ptr<OGRProjCT> CTCacheValue;
-static lru11::Cache<CTCacheKey, CTCacheValue> *g_poCTCache = nullptr;
+typedef std::vector<std::unique_ptr<OGRProjCT>> CTCacheValue;
+
+namespace
+{
+struct CTCacheShard
+{
+    std::mutex oMutex{};
+    lru11::Cache<CTCacheKey, CTCacheValue> *poCache = nullptr;
+};
+}  // namespace
+
+constexpr size_t CT_CACHE_SHARD_COUNT = 16;
+// Maximum number of idle instances kept for a given key
+constexpr size_t CT_CACHE_MAX_INSTANCES_PER_KEY = 64;
+static CTCacheShard g_aoCTCacheShards[CT_CACHE_SHARD_COUNT];
+
+static CTCacheShard &GetCTCacheShard(const CTCacheKey &key)
+{
+    return g_aoCTCacheShards[std::hash<CTCacheKey>()(key) %
+                             CT_CACHE_SHARD_COUNT];
+}
+
+// Statistics reported by OGRCTDumpStatistics()
+static std::atomic<GUIntBig> g_nCTCacheHits{0};
+static std::atomic<GUIntBig> g_nCTCacheMisses{0};
+static std::atomic<GUIntBig> g_nCTCreationCount{0};
+static std::atomic<GUIntBig> g_nCTCreationTimeUS{0};
 
 /************************************************************************/
 /*             OGRCoordinateTransformationOptions::Private              */
@@ -739,6 +770,7 @@ class OGRProjCT : public OGRCoordinateTransformation
     std::string m_osTargetSRS{};  // WKT, PROJ4 or AUTH:CODE
 
     bool bWebMercatorToWGS84LongLat = false;
+    bool bWGS84LongLatToWebMercator = false;
 
     size_t nErrorCount = 0;
 
@@ -788,6 +820,7 @@ class OGRProjCT : public OGRCoordinateTransformation
 
     void ComputeThreshold();
     void DetectWebMercatorToWGS84();
+    void DetectWGS84ToWebMercator();
 
     OGRProjCT(const OGRProjCT &other);
     OGRProjCT &operator=(const OGRProjCT &) = delete;
@@ -1013,6 +1046,7 @@ OGRCoordinateTransformation *OGRCreateCoordinateTransformation(
                                                pszTargetSRS, options);
     if (poCT == nullptr)
     {
+        const auto tStart = std::chrono::steady_clock::now();
         poCT = new OGRProjCT();
         if (!poCT->Initialize(poSource, pszSrcSRS, poTarget, pszTargetSRS,
                               options))
@@ -1020,6 +1054,11 @@ OGRCoordinateTransformation *OGRCreateCoordinateTransformation(
             delete poCT;
             poCT = nullptr;
         }
+        ++g_nCTCreationCount;
+        g_nCTCreationTimeUS +=
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - tStart)
+                .count();
     }
     CPLFree(pszSrcSRS);
     CPLFree(pszTargetSRS);
@@ -1251,6 +1290,7 @@ OGRProjCT::OGRProjCT(const OGRProjCT &other)
       dfTargetCoordinateEpoch(other.dfTargetCoordinateEpoch),
       m_osTargetSRS(other.m_osTargetSRS),
       bWebMercatorToWGS84LongLat(other.bWebMercatorToWGS84LongLat),
+      bWGS84LongLatToWebMercator(other.bWGS84LongLatToWebMercator),
       nErrorCount(other.nErrorCount), dfThreshold(other.dfThreshold),
       m_pj(other.m_pj), m_bReversePj(other.m_bReversePj),
       m_bEmitErrors(other.m_bEmitErrors), bNoTransform(other.bNoTransform),
@@ -1416,6 +1456,44 @@ void OGRProjCT::DetectWebMercatorToWGS84()
     }
 }
 
+/************************************************************************/
+/*                        DetectWGS84ToWebMercator()                    */
+/************************************************************************/
+
+void OGRProjCT::DetectWGS84ToWebMercator()
+{
+    // Only detected from the EPSG codes, as the forward direction is mostly
+    // used to generate tiles from data in EPSG:4326.
+    if (m_options.d->osCoordOperation.empty() && poSRSSource && poSRSTarget &&
+        poSRSSource->IsGeographic() && poSRSTarget->IsProjected() &&
+        ((m_eSourceFirstAxisOrient == OAO_North &&
+          poSRSSource->GetDataAxisToSRSAxisMapping() ==
+              std::vector<int>{2, 1}) ||
+         (m_eSourceFirstAxisOrient == OAO_East &&
+          poSRSSource->GetDataAxisToSRSAxisMapping() ==
+              std::vector<int>{1, 2})))
+    {
+        const char *pszSourceAuth = poSRSSource->GetAuthorityName(nullptr);
+        const char *pszSourceCode = poSRSSource->GetAuthorityCode(nullptr);
+        const char *pszTargetAuth = poSRSTarget->GetAuthorityName(nullptr);
+        const char *pszTargetCode = poSRSTarget->GetAuthorityCode(nullptr);
+        if (pszSourceAuth && pszSourceCode && pszTargetAuth && pszTargetCode &&
+            EQUAL(pszSourceAuth, "EPSG") && EQUAL(pszTargetAuth, "EPSG"))
+        {
+            bWGS84LongLatToWebMercator =
+                EQUAL(pszSourceCode, "4326") &&
+                (EQUAL(pszTargetCode, "3857") ||
+                 EQUAL(pszTargetCode, "3785") ||    // deprecated
+                 EQUAL(pszTargetCode, "900913"));  // deprecated
+        }
+
+        if (bWGS84LongLatToWebMercator)
+        {
+            CPLDebug("OGRCT", "Using WGS84 to WebMercator optimization");
+        }
+    }
+}
+
 /************************************************************************/
 /*                             Initialize()                             */
 /************************************************************************/
@@ -1563,6 +1641,7 @@ int OGRProjCT::Initialize(const OGRSpatialReference *poSourceIn,
     ComputeThreshold();
 
     DetectWebMercatorToWGS84();
+    DetectWGS84ToWebMercator();
 
     const char *pszCTOpSelection =
         CPLGetConfigOption("OGR_CT_OP_SELECTION", nullptr);
@@ -1617,7 +1696,8 @@ int OGRProjCT::Initialize(const OGRSpatialReference *poSourceIn,
                  m_bReversePj ? "(reversed) " : "");
 #endif
     }
-    else if (!bWebMercatorToWGS84LongLat && poSRSSource && poSRSTarget)
+    else if (!bWebMercatorToWGS84LongLat && !bWGS84LongLatToWebMercator &&
+             poSRSSource && poSRSTarget)
     {
 #ifdef DEBUG_PERF
         struct CPLTimeVal tvStart;
@@ -2479,6 +2559,83 @@ int OGRProjCT::TransformWithErrorCodes(size_t nCount, double *x, double *y,
         bTransformDone = true;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Optimized transform from WGS84 to WebMercator                   */
+    /* -------------------------------------------------------------------- */
+    if (bWGS84LongLatToWebMercator)
+    {
+        constexpr double SPHERE_RADIUS = 6378137.0;
+        constexpr double DEG_TO_RAD = M_PI / 180.0;
+        // Same tolerance as PROJ webmerc forward method
+        constexpr double EPS10 = 1e-10;
+
+        if (m_eSourceFirstAxisOrient != OAO_East)
+        {
+            std::swap(x, y);
+        }
+
+        double y0 = HUGE_VAL;
+        double y0Out = 0;
+        for (size_t i = 0; i < nCount; i++)
+        {
+            if (x[i] == HUGE_VAL || y[i] == HUGE_VAL)
+            {
+                x[i] = HUGE_VAL;
+                y[i] = HUGE_VAL;
+                continue;
+            }
+
+            const double dfLat = y[i] * DEG_TO_RAD;
+            if (!(std::fabs(dfLat) < M_PI / 2 - EPS10))
+            {
+                x[i] = HUGE_VAL;
+                y[i] = HUGE_VAL;
+                continue;
+            }
+
+            // Longitudes are brought back into [-180,180], as done by PROJ
+            double dfLong = x[i];
+            if (dfLong > 180 || dfLong < -180)
+            {
+                dfLong = fmod(dfLong + 180, 360);
+                if (dfLong < 0)
+                    dfLong += 360;
+                dfLong -= 180;
+            }
+            x[i] = SPHERE_RADIUS * dfLong * DEG_TO_RAD;
+
+            // Optimization for the case where we are provided a whole line
+            // of same latitude.
+            if (y[i] == y0)
+                y[i] = y0Out;
+            else
+            {
+                y0 = y[i];
+                y[i] = SPHERE_RADIUS * log(tan(M_PI / 4 + dfLat / 2));
+                y0Out = y[i];
+            }
+        }
+
+        if (panErrorCodes)
+        {
+            for (size_t i = 0; i < nCount; i++)
+            {
+                if (x[i] != HUGE_VAL)
+                    panErrorCodes[i] = 0;
+                else
+                    panErrorCodes[i] =
+                        PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN;
+            }
+        }
+
+        if (m_eTargetFirstAxisOrient != OAO_East)
+        {
+            std::swap(x, y);
+        }
+
+        bTransformDone = true;
+    }
+
     // Determine the default coordinate epoch, if not provided in the point to
     // transform.
     // For time-dependent transformations, PROJ can currently only do
@@ -3526,7 +3683,8 @@ OGRCoordinateTransformation *OGRProjCT::GetInverse() const
 {
     PJ *new_pj = nullptr;
     // m_pj can be nullptr if using m_eStrategy != PROJ
-    if (m_pj && !bWebMercatorToWGS84LongLat && !bNoTransform)
+    if (m_pj && !bWebMercatorToWGS84LongLat && !bWGS84LongLatToWebMercator &&
+        !bNoTransform)
     {
         // See https://github.com/OSGeo/PROJ/pull/2582
         // This may fail before PROJ 8.0.1 if the m_pj object is a "meta"
@@ -3579,6 +3737,7 @@ OGRCoordinateTransformation *OGRProjCT::GetInverse() const
     poNewCT->m_options = newOptions;
 
     poNewCT->DetectWebMercatorToWGS84();
+    poNewCT->DetectWGS84ToWebMercator();
 
     return poNewCT;
 }
@@ -3589,9 +3748,12 @@ OGRCoordinateTransformation *OGRProjCT::GetInverse() const
 
 void OSRCTCleanCache()
 {
-    std::lock_guard<std::mutex> oGuard(g_oCTCacheMutex);
-    delete g_poCTCache;
-    g_poCTCache = nullptr;
+    for (auto &oShard : g_aoCTCacheShards)
+    {
+        std::lock_guard<std::mutex> oGuard(oShard.oMutex);
+        delete oShard.poCache;
+        oShard.poCache = nullptr;
+    }
 }
 
 /************************************************************************/
@@ -3634,24 +3796,29 @@ CTCacheKey OGRProjCT::MakeCacheKey(
 
 void OGRProjCT::InsertIntoCache(OGRProjCT *poCT)
 {
-    {
-        std::lock_guard<std::mutex> oGuard(g_oCTCacheMutex);
-        if (g_poCTCache == nullptr)
-        {
-            g_poCTCache = new lru11::Cache<CTCacheKey, CTCacheValue>();
-        }
-    }
     const auto key = MakeCacheKey(poCT->poSRSSource, poCT->m_osSrcSRS.c_str(),
                                   poCT->poSRSTarget,
                                   poCT->m_osTargetSRS.c_str(), poCT->m_options);
+    auto &oShard = GetCTCacheShard(key);
 
-    std::lock_guard<std::mutex> oGuard(g_oCTCacheMutex);
-    if (g_poCTCache->contains(key))
+    // Declared before the lock, so that deletion happens after unlocking
+    std::unique_ptr<OGRProjCT> poCTToDelete;
+    std::lock_guard<std::mutex> oGuard(oShard.oMutex);
+    if (oShard.poCache == nullptr)
     {
-        delete poCT;
+        oShard.poCache = new lru11::Cache<CTCacheKey, CTCacheValue>();
+    }
+    CTCacheValue *pValue = oShard.poCache->getPtr(key);
+    if (pValue == nullptr)
+    {
+        pValue = &(oShard.poCache->insert(key, CTCacheValue()));
+    }
+    if (pValue->size() >= CT_CACHE_MAX_INSTANCES_PER_KEY)
+    {
+        poCTToDelete.reset(poCT);
         return;
     }
-    g_poCTCache->insert(key, std::unique_ptr<OGRProjCT>(poCT));
+    pValue->emplace_back(poCT);
 }
 
 /************************************************************************/
@@ -3663,23 +3830,23 @@ OGRProjCT *OGRProjCT::FindFromCache(
     const OGRSpatialReference *poTarget, const char *pszTargetSRS,
     const OGRCoordinateTransformationOptions &options)
 {
-    {
-        std::lock_guard<std::mutex> oGuard(g_oCTCacheMutex);
-        if (g_poCTCache == nullptr || g_poCTCache->empty())
-            return nullptr;
-    }
-
     const auto key =
         MakeCacheKey(poSource, pszSrcSRS, poTarget, pszTargetSRS, options);
-    // Get value from cache and remove it
-    std::lock_guard<std::mutex> oGuard(g_oCTCacheMutex);
-    CTCacheValue *cachedValue = g_poCTCache->getPtr(key);
-    if (cachedValue)
+    auto &oShard = GetCTCacheShard(key);
     {
-        auto poCT = cachedValue->release();
-        g_poCTCache->remove(key);
-        return poCT;
+        // Get an idle instance from cache and remove it
+        std::lock_guard<std::mutex> oGuard(oShard.oMutex);
+        CTCacheValue *pValue =
+            oShard.poCache ? oShard.poCache->getPtr(key) : nullptr;
+        if (pValue && !pValue->empty())
+        {
+            OGRProjCT *poCT = pValue->back().release();
+            pValue->pop_back();
+            ++g_nCTCacheHits;
+            return poCT;
+        }
     }
+    ++g_nCTCacheMisses;
     return nullptr;
 }
 
@@ -3848,6 +4015,27 @@ int CPL_STDCALL OCTTransformBounds(OGRCoordinateTransformationH hTransform,
 
 void OGRCTDumpStatistics()
 {
+    const GUIntBig nHits = g_nCTCacheHits.load();
+    const GUIntBig nMisses = g_nCTCacheMisses.load();
+    if (nHits + nMisses > 0)
+    {
+        CPLDebug("OGR_CT",
+                 "Coordinate transformation cache: " CPL_FRMT_GUIB
+                 " hits, " CPL_FRMT_GUIB " misses",
+                 nHits, nMisses);
+        const GUIntBig nCreations = g_nCTCreationCount.load();
+        if (nCreations > 0)
+        {
+            CPLDebug("OGR_CT",
+                     "Creation of " CPL_FRMT_GUIB
+                     " coordinate transformations: %d ms in total, %.3f ms "
+                     "in average",
+                     nCreations,
+                     static_cast<int>(g_nCTCreationTimeUS.load() / 1000),
+                     static_cast<double>(g_nCTCreationTimeUS.load()) / 1000 /
+                         static_cast<double>(nCreations));
+        }
+    }
 #ifdef DEBUG_PERF
     CPLDebug("OGR_CT", "Total time in proj_create_crs_to_crs(): %d ms",
              static_cast<int>(g_dfTotalTimeCRStoCRS * 1000));
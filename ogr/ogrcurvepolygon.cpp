@@ -679,6 +679,16 @@ OGRBoolean OGRCurvePolygon::Equals(const OGRGeometry *poOther) const
 OGRErr OGRCurvePolygon::transform(OGRCoordinateTransformation *poCT)
 
 {
+    // Transform all the points of the rings in a single call when possible
+    if (oCC.getNumCurves() > 1)
+    {
+        OGRGeometry *poThis = this;
+        bool bTransformed = false;
+        OGRTransformGeometriesPoints(&poThis, 1, poCT, &bTransformed);
+        if (bTransformed)
+            return OGRERR_NONE;
+    }
+
     return oCC.transform(this, poCT);
 }
 
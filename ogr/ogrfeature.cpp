@@ -54,6 +54,7 @@
 #include "ogr_featurestyle.h"
 #include "ogr_geometry.h"
 #include "ogr_p.h"
+#include "ogr_wkb.h"
 #include "ogrgeojsonreader.h"
 
 #include "cpl_json_header.h"
@@ -84,16 +85,25 @@ OGRFeature::OGRFeature(OGRFeatureDefn *poDefnIn)
 {
     poDefnIn->Reference();
 
+    // Allocate the field and geometry arrays in a single block, to save
+    // one allocation per feature.
     const int nFieldCount = poDefn->GetFieldCount();
-    pauFields = static_cast<OGRField *>(
-        VSI_MALLOC_VERBOSE(nFieldCount * sizeof(OGRField)));
-
-    papoGeometries = static_cast<OGRGeometry **>(
-        VSI_CALLOC_VERBOSE(poDefn->GetGeomFieldCount(), sizeof(OGRGeometry *)));
+    const int nGeomFieldCount = poDefn->GetGeomFieldCount();
+    static_assert(sizeof(OGRField) % alignof(OGRGeometry *) == 0,
+                  "geometry array must be aligned");
+    GByte *pabyBlock = static_cast<GByte *>(
+        VSI_MALLOC_VERBOSE(nFieldCount * sizeof(OGRField) +
+                           nGeomFieldCount * sizeof(OGRGeometry *)));
+    if (pabyBlock != nullptr)
+    {
+        pauFields = reinterpret_cast<OGRField *>(pabyBlock);
+        papoGeometries = reinterpret_cast<OGRGeometry **>(
+            pabyBlock + nFieldCount * sizeof(OGRField));
+        m_bGeometriesInFieldsBlock = true;
+        for (int i = 0; i < nGeomFieldCount; i++)
+            papoGeometries[i] = nullptr;
 
-    // Initialize array to the unset special value.
-    if (pauFields != nullptr)
-    {
+        // Initialize array to the unset special value.
         for (int i = 0; i < nFieldCount; i++)
         {
             pauFields[i].Set.nMarker1 = OGRUnsetMarker;
@@ -191,7 +201,8 @@ OGRFeature::~OGRFeature()
         poDefn->Release();
 
     CPLFree(pauFields);
-    CPLFree(papoGeometries);
+    if (!m_bGeometriesInFieldsBlock)
+        CPLFree(papoGeometries);
     CPLFree(m_pszStyleString);
     CPLFree(m_pszTmpFieldValue);
     CPLFree(m_pszNativeData);
@@ -349,6 +360,7 @@ void OGRFeature::Reset()
             papoGeometries[i] = nullptr;
         }
     }
+    m_aabyLazyWkb.clear();
 
     if (m_pszStyleString)
     {
@@ -597,7 +609,7 @@ OGRGeometry *OGRFeature::StealGeometry()
 {
     if (GetGeomFieldCount() > 0)
     {
-        OGRGeometry *poReturn = papoGeometries[0];
+        OGRGeometry *poReturn = InstantiateLazyGeometry(0);
         papoGeometries[0] = nullptr;
         return poReturn;
     }
@@ -625,7 +637,7 @@ OGRGeometry *OGRFeature::StealGeometry(int iGeomField)
 {
     if (iGeomField >= 0 && iGeomField < GetGeomFieldCount())
     {
-        OGRGeometry *poReturn = papoGeometries[iGeomField];
+        OGRGeometry *poReturn = InstantiateLazyGeometry(iGeomField);
         papoGeometries[iGeomField] = nullptr;
         return poReturn;
     }
@@ -800,7 +812,7 @@ OGRGeometry *OGRFeature::GetGeomFieldRef(int iField)
     if (iField < 0 || iField >= GetGeomFieldCount())
         return nullptr;
     else
-        return papoGeometries[iField];
+        return InstantiateLazyGeometry(iField);
 }
 
 /**
@@ -820,7 +832,7 @@ const OGRGeometry *OGRFeature::GetGeomFieldRef(int iField) const
     if (iField < 0 || iField >= GetGeomFieldCount())
         return nullptr;
     else
-        return papoGeometries[iField];
+        return InstantiateLazyGeometry(iField);
 }
 
 /************************************************************************/
@@ -844,7 +856,7 @@ OGRGeometry *OGRFeature::GetGeomFieldRef(const char *pszFName)
     if (iField < 0)
         return nullptr;
 
-    return papoGeometries[iField];
+    return InstantiateLazyGeometry(iField);
 }
 
 /**
@@ -863,7 +875,7 @@ const OGRGeometry *OGRFeature::GetGeomFieldRef(const char *pszFName) const
     if (iField < 0)
         return nullptr;
 
-    return papoGeometries[iField];
+    return InstantiateLazyGeometry(iField);
 }
 
 /************************************************************************/
@@ -939,6 +951,7 @@ OGRErr OGRFeature::SetGeomFieldDirectly(int iField, OGRGeometry *poGeomIn)
         return OGRERR_FAILURE;
     }
 
+    DiscardLazyWkb(iField);
     if (papoGeometries[iField] != poGeomIn)
     {
         delete papoGeometries[iField];
@@ -1014,6 +1027,7 @@ OGRErr OGRFeature::SetGeomField(int iField, const OGRGeometry *poGeomIn)
     if (iField < 0 || iField >= GetGeomFieldCount())
         return OGRERR_FAILURE;
 
+    DiscardLazyWkb(iField);
     if (papoGeometries[iField] != poGeomIn)
     {
         delete papoGeometries[iField];
@@ -1060,6 +1074,148 @@ OGRErr OGR_F_SetGeomField(OGRFeatureH hFeat, int iField, OGRGeometryH hGeom)
         iField, OGRGeometry::FromHandle(hGeom));
 }
 
+/************************************************************************/
+/*                        SetGeomFieldLazyWkb()                         */
+/************************************************************************/
+
+/**
+ * \brief Set feature geometry of a specified geometry field from WKB,
+ * without parsing it.
+ *
+ * The WKB is copied into the feature, and is only parsed into an OGRGeometry
+ * (with the spatial reference of the geometry field) when the geometry is
+ * requested with GetGeomFieldRef(), GetGeometryRef() or StealGeometry().
+ * Until then, consumers that only need the WKB, or what can be computed
+ * directly from it (see ogr_wkb.h), can use GetGeomFieldLazyWkb().
+ *
+ * This is meant to be used by drivers whose storage format is WKB based.
+ * Errors in the WKB are only reported when it is parsed.
+ *
+ * @param iField geometry field to set.
+ * @param pabyWkb WKB geometry. Must not be NULL.
+ * @param nWkbSize size of pabyWkb in bytes. Must not be 0.
+ *
+ * @return OGRERR_NONE if successful, or OGRERR_FAILURE if the index is
+ * invalid.
+ *
+ * @since GDAL 3.9
+ */
+
+OGRErr OGRFeature::SetGeomFieldLazyWkb(int iField, const GByte *pabyWkb,
+                                       size_t nWkbSize)
+
+{
+    if (iField < 0 || iField >= GetGeomFieldCount() || nWkbSize == 0)
+        return OGRERR_FAILURE;
+
+    delete papoGeometries[iField];
+    papoGeometries[iField] = nullptr;
+
+    if (static_cast<int>(m_aabyLazyWkb.size()) <= iField)
+        m_aabyLazyWkb.resize(GetGeomFieldCount());
+    m_aabyLazyWkb[iField].assign(pabyWkb, pabyWkb + nWkbSize);
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                        GetGeomFieldLazyWkb()                         */
+/************************************************************************/
+
+/**
+ * \brief Return the WKB set with SetGeomFieldLazyWkb(), if the geometry
+ * has not been parsed yet.
+ *
+ * @param iField geometry field.
+ * @param[out] nWkbSize set to the size of the WKB in bytes.
+ *
+ * @return the WKB, valid until the geometry of the field is requested or
+ * modified, or NULL if there is no pending WKB for that field (the geometry
+ * must then be fetched with GetGeomFieldRef()).
+ *
+ * @since GDAL 3.9
+ */
+
+const GByte *OGRFeature::GetGeomFieldLazyWkb(int iField,
+                                            size_t &nWkbSize) const
+
+{
+    nWkbSize = 0;
+    if (iField < 0 || iField >= static_cast<int>(m_aabyLazyWkb.size()) ||
+        m_aabyLazyWkb[iField].empty())
+    {
+        return nullptr;
+    }
+    nWkbSize = m_aabyLazyWkb[iField].size();
+    return m_aabyLazyWkb[iField].data();
+}
+
+//! @cond Doxygen_Suppress
+
+/************************************************************************/
+/*                      InstantiateLazyGeometry()                       */
+/*                                                                      */
+/*      Parse the pending WKB of a geometry field, if any, and return   */
+/*      its geometry.                                                   */
+/************************************************************************/
+
+OGRGeometry *OGRFeature::InstantiateLazyGeometry(int iField) const
+{
+    if (iField < static_cast<int>(m_aabyLazyWkb.size()) &&
+        !m_aabyLazyWkb[iField].empty())
+    {
+        auto &abyWkb = m_aabyLazyWkb[iField];
+        OGRGeometry *poGeom = nullptr;
+        const OGRSpatialReference *poSRS =
+            poDefn->GetGeomFieldDefn(iField)->GetSpatialRef();
+        if (OGRGeometryFactory::createFromWkb(abyWkb.data(), poSRS, &poGeom,
+                                              abyWkb.size()) != OGRERR_NONE)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "Unable to read geometry");
+            poGeom = nullptr;
+        }
+        abyWkb.clear();
+        papoGeometries[iField] = poGeom;
+    }
+    return papoGeometries[iField];
+}
+
+/************************************************************************/
+/*                       GetFirstGeomFieldArea()                        */
+/*                                                                      */
+/*      Area of the first geometry field, for the OGR_GEOM_AREA         */
+/*      special field. Computed from the pending WKB when possible.     */
+/*      Returns false if there is no geometry.                          */
+/************************************************************************/
+
+bool OGRFeature::GetFirstGeomFieldArea(double &dfArea) const
+{
+    dfArea = 0.0;
+    if (GetGeomFieldCount() == 0)
+        return false;
+    size_t nWkbSize = 0;
+    const GByte *pabyWkb = GetGeomFieldLazyWkb(0, nWkbSize);
+    if (pabyWkb && OGRWKBGetArea(pabyWkb, nWkbSize, dfArea))
+        return true;
+    OGRGeometry *poGeom = InstantiateLazyGeometry(0);
+    if (poGeom == nullptr)
+        return false;
+    dfArea = OGR_G_Area(OGRGeometry::ToHandle(poGeom));
+    return true;
+}
+
+/************************************************************************/
+/*                          DiscardLazyWkb()                            */
+/************************************************************************/
+
+void OGRFeature::DiscardLazyWkb(int iField)
+{
+    if (iField < static_cast<int>(m_aabyLazyWkb.size()))
+        m_aabyLazyWkb[iField].clear();
+}
+
+//! @endcond
+
 /************************************************************************/
 /*                               Clone()                                */
 /************************************************************************/
@@ -1152,6 +1308,7 @@ bool OGRFeature::CopySelfTo(OGRFeature *poNew) const
                 }
             }
         }
+        poNew->m_aabyLazyWkb = m_aabyLazyWkb;
     }
 
     if (m_pszStyleString != nullptr)
@@ -1509,17 +1666,16 @@ int OGRFeature::IsFieldSet(int iField) const
 
             case SPF_OGR_GEOM_WKT:
             case SPF_OGR_GEOMETRY:
-                return GetGeomFieldCount() > 0 && papoGeometries[0] != nullptr;
+                return GetGeomFieldCount() > 0 && GetGeomFieldRef(0) != nullptr;
 
             case SPF_OGR_STYLE:
                 return GetStyleString() != nullptr;
 
             case SPF_OGR_GEOM_AREA:
-                if (GetGeomFieldCount() == 0 || papoGeometries[0] == nullptr)
-                    return FALSE;
-
-                return OGR_G_Area(OGRGeometry::ToHandle(papoGeometries[0])) !=
-                       0.0;
+            {
+                double dfArea = 0.0;
+                return GetFirstGeomFieldArea(dfArea) && dfArea != 0.0;
+            }
 
             default:
                 return FALSE;
@@ -2013,10 +2169,11 @@ int OGRFeature::GetFieldAsInteger(int iField) const
             }
 
             case SPF_OGR_GEOM_AREA:
-                if (GetGeomFieldCount() == 0 || papoGeometries[0] == nullptr)
-                    return 0;
-                return static_cast<int>(
-                    OGR_G_Area(OGRGeometry::ToHandle(papoGeometries[0])));
+            {
+                double dfArea = 0.0;
+                GetFirstGeomFieldArea(dfArea);
+                return static_cast<int>(dfArea);
+            }
 
             default:
                 return 0;
@@ -2140,10 +2297,11 @@ GIntBig OGRFeature::GetFieldAsInteger64(int iField) const
                 return nFID;
 
             case SPF_OGR_GEOM_AREA:
-                if (GetGeomFieldCount() == 0 || papoGeometries[0] == nullptr)
-                    return 0;
-                return static_cast<int>(
-                    OGR_G_Area(OGRGeometry::ToHandle(papoGeometries[0])));
+            {
+                double dfArea = 0.0;
+                GetFirstGeomFieldArea(dfArea);
+                return static_cast<int>(dfArea);
+            }
 
             default:
                 return 0;
@@ -2258,9 +2416,11 @@ double OGRFeature::GetFieldAsDouble(int iField) const
                 return static_cast<double>(GetFID());
 
             case SPF_OGR_GEOM_AREA:
-                if (GetGeomFieldCount() == 0 || papoGeometries[0] == nullptr)
-                    return 0.0;
-                return OGR_G_Area(OGRGeometry::ToHandle(papoGeometries[0]));
+            {
+                double dfArea = 0.0;
+                GetFirstGeomFieldArea(dfArea);
+                return dfArea;
+            }
 
             default:
                 return 0.0;
@@ -2451,8 +2611,8 @@ const char *OGRFeature::GetFieldAsString(int iField) const
             }
 
             case SPF_OGR_GEOMETRY:
-                if (GetGeomFieldCount() > 0 && papoGeometries[0] != nullptr)
-                    return papoGeometries[0]->getGeometryName();
+                if (GetGeomFieldCount() > 0 && GetGeomFieldRef(0) != nullptr)
+                    return GetGeomFieldRef(0)->getGeometryName();
                 else
                     return "";
 
@@ -2464,10 +2624,10 @@ const char *OGRFeature::GetFieldAsString(int iField) const
 
             case SPF_OGR_GEOM_WKT:
             {
-                if (GetGeomFieldCount() == 0 || papoGeometries[0] == nullptr)
+                if (GetGeomFieldCount() == 0 || GetGeomFieldRef(0) == nullptr)
                     return "";
 
-                if (papoGeometries[0]->exportToWkt(&m_pszTmpFieldValue) ==
+                if (GetGeomFieldRef(0)->exportToWkt(&m_pszTmpFieldValue) ==
                     OGRERR_NONE)
                     return m_pszTmpFieldValue;
                 else
@@ -2476,14 +2636,13 @@ const char *OGRFeature::GetFieldAsString(int iField) const
 
             case SPF_OGR_GEOM_AREA:
             {
-                if (GetGeomFieldCount() == 0 || papoGeometries[0] == nullptr)
+                double dfArea = 0.0;
+                if (!GetFirstGeomFieldArea(dfArea))
                     return "";
 
                 constexpr size_t MAX_SIZE = 20 + 1;
                 m_pszTmpFieldValue = static_cast<char *>(CPLMalloc(MAX_SIZE));
-                CPLsnprintf(
-                    m_pszTmpFieldValue, MAX_SIZE, "%.16g",
-                    OGR_G_Area(OGRGeometry::ToHandle(papoGeometries[0])));
+                CPLsnprintf(m_pszTmpFieldValue, MAX_SIZE, "%.16g", dfArea);
                 return m_pszTmpFieldValue;
             }
 
@@ -5644,14 +5803,14 @@ std::string OGRFeature::DumpReadableAsString(CSLConstList papszOptions) const
             {
                 OGRGeomFieldDefn *poFDefn = poDefn->GetGeomFieldDefn(iField);
 
-                if (papoGeometries[iField] != nullptr)
+                const OGRGeometry *poGeom = GetGeomFieldRef(iField);
+                if (poGeom != nullptr)
                 {
                     osRet += "  ";
                     if (strlen(poFDefn->GetNameRef()) > 0 &&
                         GetGeomFieldCount() > 1)
                         osRet += CPLOPrintf("%s = ", poFDefn->GetNameRef());
-                    osRet += papoGeometries[iField]->dumpReadable(nullptr,
-                                                                  papszOptions);
+                    osRet += poGeom->dumpReadable(nullptr, papszOptions);
                 }
             }
         }
@@ -6248,6 +6407,110 @@ OGRErr OGRFeature::SetFrom(const OGRFeature *poSrcFeature, const int *panMap,
     return OGRERR_NONE;
 }
 
+/************************************************************************/
+/*                          SetFromStealing()                           */
+/************************************************************************/
+
+/**
+ * \brief Set one feature from another, moving values out of it.
+ *
+ * This method is the same as SetFrom() with a field map, except that the
+ * geometries, the style string, the native data and the values of fields
+ * of the same type that require an allocation (strings, binary and lists)
+ * are moved from poSrcFeature instead of being copied. This avoids
+ * allocations and copies when poSrcFeature is discarded afterwards.
+ *
+ * The geometries of poSrcFeature are set to NULL, and the fields whose
+ * value has been moved are unset.
+ *
+ * @param poSrcFeature the feature from which geometry, and field values will
+ * be moved.
+ *
+ * @param panMap Array of the indices of the feature's fields
+ * stored at the corresponding index of the source feature's fields. A value of
+ * -1 should be used to ignore the source's field. The array should not be NULL
+ * and be as long as the number of fields in the source feature.
+ *
+ * @param bForgiving TRUE if the operation should continue despite lacking
+ * output fields matching some of the source fields.
+ *
+ * @param bUseISO8601ForDateTimeAsString true if datetime fields
+ * converted to string should use ISO8601 formatting rather than OGR own format.
+ *
+ * @return OGRERR_NONE if the operation succeeds, even if some values are
+ * not transferred, otherwise an error code.
+ *
+ * @since GDAL 3.9
+ */
+
+OGRErr OGRFeature::SetFromStealing(OGRFeature *poSrcFeature,
+                                   const int *panMap, int bForgiving,
+                                   bool bUseISO8601ForDateTimeAsString)
+
+{
+    if (poSrcFeature == this)
+        return OGRERR_FAILURE;
+
+    SetFID(OGRNullFID);
+
+    /* -------------------------------------------------------------------- */
+    /*      Move the geometries.                                            */
+    /* -------------------------------------------------------------------- */
+    if (GetGeomFieldCount() == 1)
+    {
+        const OGRGeomFieldDefn *poGFieldDefn = GetGeomFieldDefnRef(0);
+
+        const int iSrc =
+            poSrcFeature->GetGeomFieldIndex(poGFieldDefn->GetNameRef());
+        // Whatever the geometry field names are.  For backward
+        // compatibility.
+        SetGeomFieldDirectly(0, poSrcFeature->StealGeometry(std::max(0, iSrc)));
+    }
+    else
+    {
+        for (int i = 0; i < GetGeomFieldCount(); i++)
+        {
+            const OGRGeomFieldDefn *poGFieldDefn = GetGeomFieldDefnRef(i);
+
+            const int iSrc =
+                poSrcFeature->GetGeomFieldIndex(poGFieldDefn->GetNameRef());
+            SetGeomFieldDirectly(
+                i, iSrc >= 0 ? poSrcFeature->StealGeometry(iSrc) : nullptr);
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Move feature style string.                                      */
+    /* -------------------------------------------------------------------- */
+    // GetStyleString() is virtual and may not return m_pszStyleString
+    const char *pszStyleString = poSrcFeature->GetStyleString();
+    if (pszStyleString && pszStyleString == poSrcFeature->m_pszStyleString)
+    {
+        SetStyleStringDirectly(poSrcFeature->m_pszStyleString);
+        poSrcFeature->m_pszStyleString = nullptr;
+    }
+    else
+    {
+        SetStyleString(pszStyleString);
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Move native data.                                               */
+    /* -------------------------------------------------------------------- */
+    std::swap(m_pszNativeData, poSrcFeature->m_pszNativeData);
+    CPLFree(poSrcFeature->m_pszNativeData);
+    poSrcFeature->m_pszNativeData = nullptr;
+    std::swap(m_pszNativeMediaType, poSrcFeature->m_pszNativeMediaType);
+    CPLFree(poSrcFeature->m_pszNativeMediaType);
+    poSrcFeature->m_pszNativeMediaType = nullptr;
+
+    /* -------------------------------------------------------------------- */
+    /*      Set the fields by index.                                        */
+    /* -------------------------------------------------------------------- */
+    return SetFieldsFromInternal(poSrcFeature, poSrcFeature, panMap,
+                                 bForgiving, bUseISO8601ForDateTimeAsString);
+}
+
 /************************************************************************/
 /*                      OGR_F_SetFromWithMap()                          */
 /************************************************************************/
@@ -6331,6 +6594,24 @@ OGRErr OGRFeature::SetFieldsFrom(const OGRFeature *poSrcFeature,
                                  const int *panMap, int bForgiving,
                                  bool bUseISO8601ForDateTimeAsString)
 
+{
+    return SetFieldsFromInternal(poSrcFeature, nullptr, panMap, bForgiving,
+                                 bUseISO8601ForDateTimeAsString);
+}
+
+/************************************************************************/
+/*                       SetFieldsFromInternal()                        */
+/*                                                                      */
+/*      If poSrcFeatureToStealFrom is not null, it must be the same as  */
+/*      poSrcFeature, and values of fields of the same type that need   */
+/*      an allocation are moved from it instead of being copied.       */
+/************************************************************************/
+
+OGRErr OGRFeature::SetFieldsFromInternal(const OGRFeature *poSrcFeature,
+                                         OGRFeature *poSrcFeatureToStealFrom,
+                                         const int *panMap, int bForgiving,
+                                         bool bUseISO8601ForDateTimeAsString)
+
 {
     const int nSrcFieldCount = poSrcFeature->poDefn->GetFieldCountUnsafe();
     const int nFieldCount = poDefn->GetFieldCountUnsafe();
@@ -6361,6 +6642,18 @@ OGRErr OGRFeature::SetFieldsFrom(const OGRFeature *poSrcFeature,
         const auto eDstType = poDefn->GetFieldDefnUnsafe(iDstField)->GetType();
         if (eSrcType == eDstType)
         {
+            if (poSrcFeatureToStealFrom &&
+                (eSrcType == OFTString || eSrcType == OFTBinary ||
+                 eSrcType == OFTIntegerList || eSrcType == OFTInteger64List ||
+                 eSrcType == OFTRealList || eSrcType == OFTStringList))
+            {
+                UnsetField(iDstField);
+                pauFields[iDstField] =
+                    poSrcFeatureToStealFrom->pauFields[iField];
+                OGR_RawField_SetUnset(
+                    &poSrcFeatureToStealFrom->pauFields[iField]);
+                continue;
+            }
             if (eSrcType == OFTInteger)
             {
                 SetFieldSameTypeUnsafe(
@@ -6709,6 +7002,27 @@ void OGRFeature::SetStyleTableDirectly(OGRStyleTable *poStyleTable)
 
 //! @cond Doxygen_Suppress
 
+/************************************************************************/
+/*                  DetachGeometriesFromFieldsBlock()                   */
+/*                                                                      */
+/*      Move the geometry array to its own allocation, before the       */
+/*      field array is reallocated.                                     */
+/************************************************************************/
+
+void OGRFeature::DetachGeometriesFromFieldsBlock()
+{
+    if (!m_bGeometriesInFieldsBlock)
+        return;
+    const int nGeomFieldCount = poDefn->GetGeomFieldCount();
+    OGRGeometry **papoNewGeometries = static_cast<OGRGeometry **>(
+        CPLCalloc(nGeomFieldCount, sizeof(OGRGeometry *)));
+    if (nGeomFieldCount > 0)
+        memcpy(papoNewGeometries, papoGeometries,
+               nGeomFieldCount * sizeof(OGRGeometry *));
+    papoGeometries = papoNewGeometries;
+    m_bGeometriesInFieldsBlock = false;
+}
+
 /************************************************************************/
 /*                            RemapFields()                             */
 /*                                                                      */
@@ -6746,6 +7060,7 @@ OGRErr OGRFeature::RemapFields(OGRFeatureDefn *poNewDefn,
     /* -------------------------------------------------------------------- */
     /*      Apply new definition and fields.                                */
     /* -------------------------------------------------------------------- */
+    DetachGeometriesFromFieldsBlock();
     CPLFree(pauFields);
     pauFields = pauNewFields;
 
@@ -6763,6 +7078,7 @@ OGRErr OGRFeature::RemapFields(OGRFeatureDefn *poNewDefn,
 
 void OGRFeature::AppendField()
 {
+    DetachGeometriesFromFieldsBlock();
     int nFieldCount = poDefn->GetFieldCount();
     pauFields = static_cast<OGRField *>(
         CPLRealloc(pauFields, nFieldCount * sizeof(OGRField)));
@@ -6783,6 +7099,10 @@ OGRErr OGRFeature::RemapGeomFields(OGRFeatureDefn *poNewDefn,
     if (poNewDefn == nullptr)
         poNewDefn = poDefn;
 
+    for (int i = 0; i < static_cast<int>(m_aabyLazyWkb.size()); ++i)
+        InstantiateLazyGeometry(i);
+    m_aabyLazyWkb.clear();
+
     OGRGeometry **papoNewGeomFields = static_cast<OGRGeometry **>(
         CPLCalloc(poNewDefn->GetGeomFieldCount(), sizeof(OGRGeometry *)));
 
@@ -6807,7 +7127,10 @@ OGRErr OGRFeature::RemapGeomFields(OGRFeatureDefn *poNewDefn,
     /* -------------------------------------------------------------------- */
     /*      Apply new definition and fields.                                */
     /* -------------------------------------------------------------------- */
-    CPLFree(papoGeometries);
+    if (m_bGeometriesInFieldsBlock)
+        m_bGeometriesInFieldsBlock = false;
+    else
+        CPLFree(papoGeometries);
     papoGeometries = papoNewGeomFields;
 
     poDefn = poNewDefn;
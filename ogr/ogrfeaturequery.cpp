@@ -35,6 +35,9 @@
 #include <cstddef>
 #include <cstdlib>
 #include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -117,6 +120,7 @@ OGRFeatureQuery::Compile(OGRLayer *poLayer, OGRFeatureDefn *poDefn,
                          swq_custom_func_registrar *poCustomFuncRegistrar)
 {
     // Clear any existing expression.
+    m_poCompiledExpr.reset();
     if (pSWQExpr != nullptr)
     {
         delete static_cast<swq_expr_node *>(pSWQExpr);
@@ -243,6 +247,12 @@ OGRFeatureQuery::Compile(OGRLayer *poLayer, OGRFeatureDefn *poDefn,
         eErr = OGRERR_CORRUPT_DATA;
         pSWQExpr = nullptr;
     }
+    else if (CPLTestBool(
+                 CPLGetConfigOption("OGR_COMPILE_ATTRIBUTE_FILTER", "YES")))
+    {
+        m_poCompiledExpr =
+            CompileNode(static_cast<const swq_expr_node *>(pSWQExpr));
+    }
 
     CPLFree(papszFieldNames);
     CPLFree(paeFieldTypes);
@@ -318,6 +328,494 @@ static swq_expr_node *OGRFeatureFetcher(swq_expr_node *op, void *pFeatureIn)
     return poRetNode;
 }
 
+/************************************************************************/
+/*                     OGRFeatureQueryCompiledNode                      */
+/************************************************************************/
+
+// Resolved form of the subset of WHERE expressions commonly used as
+// attribute filters: comparisons, BETWEEN, IN, LIKE, ILIKE and IS NULL of a
+// field against constants, combined with AND, OR and NOT. Field indices,
+// field types and constants are resolved when the query is compiled, so
+// that evaluating a feature does not allocate temporary swq_expr_node
+// values. The semantics are the ones of SWQGeneralEvaluator(): in
+// particular a comparison involving a NULL value evaluates to false.
+struct OGRFeatureQueryCompiledNode
+{
+    enum class Type
+    {
+        CONSTANT,
+        AND,
+        OR,
+        NOT,
+        IS_NULL,
+        INTEGER,  // integer field compared to integer constants
+        REAL,     // integer or real field compared to real constants
+        STRING,   // string field compared to string constants
+    };
+
+    Type eType = Type::CONSTANT;
+    bool bConstantValue = false;
+
+    std::unique_ptr<OGRFeatureQueryCompiledNode> poFirst{};
+    std::unique_ptr<OGRFeatureQueryCompiledNode> poSecond{};
+
+    // Field comparisons
+    swq_op eOp = SWQ_EQ;
+    int iField = -1;
+    bool bIsFID = false;
+    OGRFieldType eFieldType = OFTString;
+    std::vector<GIntBig> anValues{};
+    std::vector<double> adfValues{};
+    std::vector<std::string> aosValues{};
+    char chEscape = '\0';
+
+    bool Evaluate(OGRFeature *poFeature, bool bUTF8Strings) const;
+
+  private:
+    bool FetchInteger(OGRFeature *poFeature, GIntBig &nVal) const;
+
+    template <class T> bool CompareNumber(T val, const std::vector<T> &) const;
+};
+
+/************************************************************************/
+/*                            FetchInteger()                            */
+/************************************************************************/
+
+inline bool
+OGRFeatureQueryCompiledNode::FetchInteger(OGRFeature *poFeature,
+                                          GIntBig &nVal) const
+{
+    if (!poFeature->IsFieldSetAndNotNull(iField))
+        return false;
+    if (bIsFID)
+    {
+        // Go through the special field accessors, as OGRFeatureFetcher().
+        nVal = eFieldType == OFTInteger64
+                   ? poFeature->GetFieldAsInteger64(iField)
+                   : poFeature->GetFieldAsInteger(iField);
+    }
+    else
+    {
+        const OGRField *psField = poFeature->GetRawFieldRef(iField);
+        nVal = eFieldType == OFTInteger64 ? psField->Integer64
+                                          : psField->Integer;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                            CompareNumber()                           */
+/************************************************************************/
+
+template <class T>
+inline bool
+OGRFeatureQueryCompiledNode::CompareNumber(T val,
+                                           const std::vector<T> &aVals) const
+{
+    switch (eOp)
+    {
+        case SWQ_EQ:
+            return val == aVals[0];
+        case SWQ_NE:
+            return val != aVals[0];
+        case SWQ_LT:
+            return val < aVals[0];
+        case SWQ_LE:
+            return val <= aVals[0];
+        case SWQ_GT:
+            return val > aVals[0];
+        case SWQ_GE:
+            return val >= aVals[0];
+        case SWQ_BETWEEN:
+            return val >= aVals[0] && val <= aVals[1];
+        case SWQ_IN:
+            for (const T &other : aVals)
+            {
+                if (val == other)
+                    return true;
+            }
+            return false;
+        default:
+            break;
+    }
+    CPLAssert(false);
+    return false;
+}
+
+/************************************************************************/
+/*                              Evaluate()                              */
+/************************************************************************/
+
+bool OGRFeatureQueryCompiledNode::Evaluate(OGRFeature *poFeature,
+                                           bool bUTF8Strings) const
+{
+    switch (eType)
+    {
+        case Type::CONSTANT:
+            return bConstantValue;
+
+        case Type::AND:
+            return poFirst->Evaluate(poFeature, bUTF8Strings) &&
+                   poSecond->Evaluate(poFeature, bUTF8Strings);
+
+        case Type::OR:
+            return poFirst->Evaluate(poFeature, bUTF8Strings) ||
+                   poSecond->Evaluate(poFeature, bUTF8Strings);
+
+        case Type::NOT:
+            return !poFirst->Evaluate(poFeature, bUTF8Strings);
+
+        case Type::IS_NULL:
+            return !poFeature->IsFieldSetAndNotNull(iField);
+
+        case Type::INTEGER:
+        {
+            GIntBig nVal = 0;
+            return FetchInteger(poFeature, nVal) &&
+                   CompareNumber(nVal, anValues);
+        }
+
+        case Type::REAL:
+        {
+            double dfVal = 0;
+            if (eFieldType == OFTReal)
+            {
+                if (!poFeature->IsFieldSetAndNotNull(iField))
+                    return false;
+                dfVal = poFeature->GetRawFieldRef(iField)->Real;
+            }
+            else
+            {
+                GIntBig nVal = 0;
+                if (!FetchInteger(poFeature, nVal))
+                    return false;
+                dfVal = static_cast<double>(nVal);
+            }
+            return CompareNumber(dfVal, adfValues);
+        }
+
+        case Type::STRING:
+        {
+            if (!poFeature->IsFieldSetAndNotNull(iField))
+                return false;
+            const char *pszVal = poFeature->GetRawFieldRef(iField)->String;
+            switch (eOp)
+            {
+                case SWQ_EQ:
+                    return strcasecmp(pszVal, aosValues[0].c_str()) == 0;
+                case SWQ_NE:
+                    return strcasecmp(pszVal, aosValues[0].c_str()) != 0;
+                case SWQ_LT:
+                    return strcasecmp(pszVal, aosValues[0].c_str()) < 0;
+                case SWQ_LE:
+                    return strcasecmp(pszVal, aosValues[0].c_str()) <= 0;
+                case SWQ_GT:
+                    return strcasecmp(pszVal, aosValues[0].c_str()) > 0;
+                case SWQ_GE:
+                    return strcasecmp(pszVal, aosValues[0].c_str()) >= 0;
+                case SWQ_BETWEEN:
+                    return strcasecmp(pszVal, aosValues[0].c_str()) >= 0 &&
+                           strcasecmp(pszVal, aosValues[1].c_str()) <= 0;
+                case SWQ_IN:
+                    for (const auto &osOther : aosValues)
+                    {
+                        if (strcasecmp(pszVal, osOther.c_str()) == 0)
+                            return true;
+                    }
+                    return false;
+                case SWQ_LIKE:
+                case SWQ_ILIKE:
+                {
+                    const bool bInsensitive =
+                        eOp == SWQ_ILIKE ||
+                        CPLTestBool(CPLGetConfigOption("OGR_SQL_LIKE_AS_ILIKE",
+                                                       "FALSE"));
+                    return swq_test_like(pszVal, aosValues[0].c_str(),
+                                         chEscape, bInsensitive, bUTF8Strings);
+                }
+                default:
+                    break;
+            }
+            break;
+        }
+    }
+    CPLAssert(false);
+    return false;
+}
+
+/************************************************************************/
+/*                        HasColumnOrCustomFunc()                       */
+/************************************************************************/
+
+static bool HasColumnOrCustomFunc(const swq_expr_node *poNode)
+{
+    if (poNode->eNodeType == SNT_COLUMN)
+        return true;
+    if (poNode->eNodeType == SNT_OPERATION)
+    {
+        if (poNode->nOperation == SWQ_CUSTOM_FUNC)
+            return true;
+        for (int i = 0; i < poNode->nSubExprCount; i++)
+        {
+            if (HasColumnOrCustomFunc(poNode->papoSubExpr[i]))
+                return true;
+        }
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                            CompileNode()                             */
+/************************************************************************/
+
+// Returns nullptr if the expression cannot be compiled, in which case the
+// generic swq_expr_node evaluator is used.
+std::unique_ptr<OGRFeatureQueryCompiledNode>
+OGRFeatureQuery::CompileNode(const swq_expr_node *poNode) const
+{
+    using Type = OGRFeatureQueryCompiledNode::Type;
+    auto poRet = std::make_unique<OGRFeatureQueryCompiledNode>();
+
+    // Fold sub-expressions that do not depend on the feature.
+    if (!HasColumnOrCustomFunc(poNode))
+    {
+        CPLErrorStateBackuper oErrorStateBackuper;
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        const auto nErrorCounter = CPLGetErrorCounter();
+        std::unique_ptr<swq_expr_node> poVal(
+            const_cast<swq_expr_node *>(poNode)->Evaluate(
+                OGRFeatureFetcher, nullptr, *m_psContext));
+        if (!poVal || poVal->is_null || CPLGetErrorCounter() != nErrorCounter ||
+            !(SWQ_IS_INTEGER(poVal->field_type) ||
+              poVal->field_type == SWQ_BOOLEAN))
+        {
+            return nullptr;
+        }
+        poRet->bConstantValue = poVal->int_value != 0;
+        return poRet;
+    }
+
+    if (poNode->eNodeType != SNT_OPERATION)
+        return nullptr;
+
+    const int nSubExprCount = poNode->nSubExprCount;
+    swq_op eOp = poNode->nOperation;
+    switch (eOp)
+    {
+        case SWQ_AND:
+        case SWQ_OR:
+            if (nSubExprCount != 2)
+                return nullptr;
+            poRet->eType = eOp == SWQ_AND ? Type::AND : Type::OR;
+            poRet->poFirst = CompileNode(poNode->papoSubExpr[0]);
+            poRet->poSecond = CompileNode(poNode->papoSubExpr[1]);
+            if (!poRet->poFirst || !poRet->poSecond)
+                return nullptr;
+            return poRet;
+
+        case SWQ_NOT:
+            if (nSubExprCount != 1)
+                return nullptr;
+            poRet->eType = Type::NOT;
+            poRet->poFirst = CompileNode(poNode->papoSubExpr[0]);
+            if (!poRet->poFirst)
+                return nullptr;
+            return poRet;
+
+        case SWQ_ISNULL:
+            if (nSubExprCount != 1)
+                return nullptr;
+            break;
+
+        case SWQ_EQ:
+        case SWQ_NE:
+        case SWQ_LT:
+        case SWQ_LE:
+        case SWQ_GT:
+        case SWQ_GE:
+            if (nSubExprCount != 2)
+                return nullptr;
+            break;
+
+        case SWQ_BETWEEN:
+            if (nSubExprCount != 3)
+                return nullptr;
+            break;
+
+        case SWQ_IN:
+            if (nSubExprCount < 2)
+                return nullptr;
+            break;
+
+        case SWQ_LIKE:
+        case SWQ_ILIKE:
+            if (nSubExprCount != 2 && nSubExprCount != 3)
+                return nullptr;
+            break;
+
+        default:
+            return nullptr;
+    }
+
+    // Only a single field operand against non-NULL constants is handled.
+    int iColumn = -1;
+    for (int i = 0; i < nSubExprCount; i++)
+    {
+        const swq_expr_node *poSubExpr = poNode->papoSubExpr[i];
+        if (poSubExpr->eNodeType == SNT_COLUMN)
+        {
+            if (iColumn >= 0)
+                return nullptr;
+            iColumn = i;
+        }
+        else if (poSubExpr->eNodeType != SNT_CONSTANT || poSubExpr->is_null)
+        {
+            return nullptr;
+        }
+    }
+    if (iColumn < 0 || (iColumn == 1 && nSubExprCount != 2) || iColumn > 1)
+        return nullptr;
+    if (iColumn == 1)
+    {
+        // "constant op field": swap the operands.
+        if (eOp == SWQ_LT)
+            eOp = SWQ_GT;
+        else if (eOp == SWQ_LE)
+            eOp = SWQ_GE;
+        else if (eOp == SWQ_GT)
+            eOp = SWQ_LT;
+        else if (eOp == SWQ_GE)
+            eOp = SWQ_LE;
+        else if (eOp != SWQ_EQ && eOp != SWQ_NE)
+            return nullptr;
+    }
+    poRet->eOp = eOp;
+
+    const swq_expr_node *poColumn = poNode->papoSubExpr[iColumn];
+    if (poColumn->table_index != 0)
+        return nullptr;
+    const int nFieldCount = poTargetDefn->GetFieldCount();
+    const int iField =
+        OGRFeatureFetcherFixFieldIndex(poTargetDefn, poColumn->field_index);
+    poRet->iField = iField;
+    if (iField >= 0 && iField < nFieldCount)
+    {
+        const OGRFieldType eFieldType =
+            poTargetDefn->GetFieldDefn(iField)->GetType();
+        if (eOp == SWQ_ISNULL)
+        {
+            poRet->eType = Type::IS_NULL;
+            return poRet;
+        }
+        if (!((eFieldType == OFTInteger &&
+               poColumn->field_type == SWQ_INTEGER) ||
+              (eFieldType == OFTInteger64 &&
+               poColumn->field_type == SWQ_INTEGER64) ||
+              (eFieldType == OFTReal && poColumn->field_type == SWQ_FLOAT) ||
+              (eFieldType == OFTString && poColumn->field_type == SWQ_STRING)))
+        {
+            return nullptr;
+        }
+        poRet->eFieldType = eFieldType;
+    }
+    else if (iField == nFieldCount + SPF_FID &&
+             SWQ_IS_INTEGER(poColumn->field_type))
+    {
+        if (eOp == SWQ_ISNULL)
+        {
+            poRet->eType = Type::IS_NULL;
+            return poRet;
+        }
+        poRet->bIsFID = true;
+        poRet->eFieldType =
+            poColumn->field_type == SWQ_INTEGER64 ? OFTInteger64 : OFTInteger;
+    }
+    else
+    {
+        return nullptr;
+    }
+
+    bool bAllInteger = true;
+    bool bAllReal = true;
+    bool bAllString = true;
+    for (int i = 0; i < nSubExprCount; i++)
+    {
+        if (i != iColumn)
+        {
+            const swq_field_type eType = poNode->papoSubExpr[i]->field_type;
+            bAllInteger &= SWQ_IS_INTEGER(eType);
+            bAllReal &= eType == SWQ_FLOAT;
+            bAllString &= eType == SWQ_STRING;
+        }
+    }
+
+    if (poRet->eFieldType == OFTString)
+    {
+        if (!bAllString)
+            return nullptr;
+        poRet->eType = Type::STRING;
+        if (eOp == SWQ_LIKE || eOp == SWQ_ILIKE)
+        {
+            poRet->aosValues.push_back(poNode->papoSubExpr[1]->string_value);
+            if (nSubExprCount == 3)
+                poRet->chEscape = poNode->papoSubExpr[2]->string_value[0];
+            return poRet;
+        }
+        for (int i = 0; i < nSubExprCount; i++)
+        {
+            if (i == iColumn)
+                continue;
+            const char *pszVal = poNode->papoSubExpr[i]->string_value;
+            // SWQ_EQ has special rules for values that look like timestamps
+            // with a time zone.
+            const size_t nLen = strlen(pszVal);
+            if (eOp == SWQ_EQ && nLen > 3 &&
+                (pszVal[nLen - 3] == ':' ||
+                 strcmp(pszVal + nLen - 3, "+00") == 0))
+            {
+                return nullptr;
+            }
+            poRet->aosValues.push_back(pszVal);
+        }
+        return poRet;
+    }
+
+    if (eOp == SWQ_LIKE || eOp == SWQ_ILIKE)
+        return nullptr;
+
+    // SWQGeneralEvaluator() only converts the first two operands to double
+    // when one of them is a real, so mixed n-ary lists are left to it.
+    if (bAllInteger && poRet->eFieldType != OFTReal)
+    {
+        poRet->eType = Type::INTEGER;
+        for (int i = 0; i < nSubExprCount; i++)
+        {
+            if (i != iColumn)
+                poRet->anValues.push_back(poNode->papoSubExpr[i]->int_value);
+        }
+    }
+    else if (bAllReal || (bAllInteger && nSubExprCount == 2))
+    {
+        poRet->eType = Type::REAL;
+        for (int i = 0; i < nSubExprCount; i++)
+        {
+            if (i != iColumn)
+            {
+                const swq_expr_node *poVal = poNode->papoSubExpr[i];
+                poRet->adfValues.push_back(
+                    poVal->field_type == SWQ_FLOAT
+                        ? poVal->float_value
+                        : static_cast<double>(poVal->int_value));
+            }
+        }
+    }
+    else
+    {
+        return nullptr;
+    }
+    return poRet;
+}
+
 /************************************************************************/
 /*                              Evaluate()                              */
 /************************************************************************/
@@ -328,6 +826,9 @@ int OGRFeatureQuery::Evaluate(OGRFeature *poFeature)
     if (pSWQExpr == nullptr)
         return FALSE;
 
+    if (m_poCompiledExpr && poFeature->GetDefnRef() == poTargetDefn)
+        return m_poCompiledExpr->Evaluate(poFeature, m_psContext->bUTF8Strings);
+
     swq_expr_node *poResult = static_cast<swq_expr_node *>(pSWQExpr)->Evaluate(
         OGRFeatureFetcher, poFeature, *m_psContext);
 
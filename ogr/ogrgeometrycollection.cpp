@@ -982,6 +982,16 @@ OGRBoolean OGRGeometryCollection::Equals(const OGRGeometry *poOther) const
 OGRErr OGRGeometryCollection::transform(OGRCoordinateTransformation *poCT)
 
 {
+    // Transform all the points of the parts in a single call when possible
+    if (nGeomCount > 1)
+    {
+        OGRGeometry *poThis = this;
+        bool bTransformed = false;
+        OGRTransformGeometriesPoints(&poThis, 1, poCT, &bTransformed);
+        if (bTransformed)
+            return OGRERR_NONE;
+    }
+
     int iGeom = 0;
     for (auto &&poSubGeom : *this)
     {
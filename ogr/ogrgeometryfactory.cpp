@@ -3803,6 +3803,265 @@ static void SnapCoordsCloseToLatLongBounds(OGRGeometry *poGeom)
 
 #endif
 
+/************************************************************************/
+/*                    OGRTransformGeometriesPoints()                    */
+/************************************************************************/
+
+namespace
+{
+// Collects the simple curves and points whose coordinates must be
+// transformed, that is what the transform() methods eventually operate on.
+class OGRTransformPartsCollector final : public OGRDefaultGeometryVisitor
+{
+  public:
+    struct Part
+    {
+        OGRSimpleCurve *poCurve = nullptr;
+        OGRPoint *poPoint = nullptr;
+        bool bClosedRing = false;
+    };
+
+    std::vector<Part> aoParts{};
+    size_t nPointCount = 0;
+    bool bUnsupported = false;
+
+    OGRTransformPartsCollector() = default;
+
+    using OGRDefaultGeometryVisitor::visit;
+
+    void visit(OGRPoint *poPoint) override
+    {
+        // OGRPoint::transform() transforms the (0,0) coordinates of an empty
+        // point, which cannot be emulated here
+        if (poPoint->IsEmpty())
+        {
+            bUnsupported = true;
+            return;
+        }
+        Part oPart;
+        oPart.poPoint = poPoint;
+        aoParts.push_back(oPart);
+        ++nPointCount;
+    }
+
+    void visit(OGRLineString *poLS) override
+    {
+        AddCurve(poLS, false);
+    }
+
+    void visit(OGRLinearRing *poLR) override
+    {
+        AddCurve(poLR,
+                 poLR->getNumPoints() > 2 && CPL_TO_BOOL(poLR->get_IsClosed()));
+    }
+
+    void visit(OGRCircularString *poCS) override
+    {
+        AddCurve(poCS, false);
+    }
+
+  private:
+    void AddCurve(OGRSimpleCurve *poCurve, bool bClosedRing)
+    {
+        Part oPart;
+        oPart.poCurve = poCurve;
+        oPart.bClosedRing = bClosedRing;
+        aoParts.push_back(oPart);
+        nPointCount += poCurve->getNumPoints();
+    }
+};
+}  // namespace
+
+/* Transforms the points of several geometries with a single call to
+ * poCT->Transform(), which avoids the per-call overhead of the coordinate
+ * transformation when there are many small parts.
+ * pabTransformed[i] is set to true if all the points of papoGeoms[i] have been
+ * successfully transformed, in which case papoGeoms[i] is updated and assigned
+ * the target SRS. Otherwise papoGeoms[i] is left unmodified, and callers
+ * should use OGRGeometry::transform() on it to get its error reporting and
+ * OGR_ENABLE_PARTIAL_REPROJECTION behavior.
+ */
+void OGRTransformGeometriesPoints(OGRGeometry *const *papoGeoms,
+                                  size_t nGeomCount,
+                                  OGRCoordinateTransformation *poCT,
+                                  bool *pabTransformed)
+{
+    OGRTransformPartsCollector oCollector;
+    std::vector<size_t> anFirstPart;
+    std::vector<size_t> anFirstPoint;
+    std::vector<bool> abUnsupported;
+    std::vector<double> adfX, adfY, adfZ;
+    std::vector<int> abSuccess;
+    try
+    {
+        anFirstPart.reserve(nGeomCount + 1);
+        anFirstPoint.reserve(nGeomCount + 1);
+        abUnsupported.resize(nGeomCount);
+        for (size_t i = 0; i < nGeomCount; ++i)
+        {
+            pabTransformed[i] = false;
+            anFirstPart.push_back(oCollector.aoParts.size());
+            anFirstPoint.push_back(oCollector.nPointCount);
+            oCollector.bUnsupported = false;
+            papoGeoms[i]->accept(&oCollector);
+            if (oCollector.bUnsupported)
+            {
+                abUnsupported[i] = true;
+                // Forget the parts of this geometry
+                oCollector.aoParts.resize(anFirstPart.back());
+                oCollector.nPointCount = anFirstPoint.back();
+            }
+        }
+        anFirstPart.push_back(oCollector.aoParts.size());
+        anFirstPoint.push_back(oCollector.nPointCount);
+
+        adfX.resize(oCollector.nPointCount);
+        adfY.resize(oCollector.nPointCount);
+        adfZ.resize(oCollector.nPointCount);
+        abSuccess.resize(oCollector.nPointCount);
+    }
+    catch (const std::bad_alloc &)
+    {
+        return;
+    }
+
+    size_t iPoint = 0;
+    for (const auto &oPart : oCollector.aoParts)
+    {
+        if (oPart.poPoint)
+        {
+            adfX[iPoint] = oPart.poPoint->getX();
+            adfY[iPoint] = oPart.poPoint->getY();
+            adfZ[iPoint] = oPart.poPoint->getZ();
+            ++iPoint;
+        }
+        else
+        {
+            const int nPoints = oPart.poCurve->getNumPoints();
+            oPart.poCurve->getPoints(adfX.data() + iPoint, sizeof(double),
+                                     adfY.data() + iPoint, sizeof(double),
+                                     adfZ.data() + iPoint, sizeof(double));
+            iPoint += nPoints;
+        }
+    }
+
+    // Errors of failed points are reported by the transform() fallback
+    const bool bEmitErrors = poCT->GetEmitErrors();
+    poCT->SetEmitErrors(false);
+    poCT->Transform(oCollector.nPointCount, adfX.data(), adfY.data(),
+                    adfZ.data(), nullptr, abSuccess.data());
+    poCT->SetEmitErrors(bEmitErrors);
+
+    const OGRSpatialReference *poTargetSRS = poCT->GetTargetCS();
+    for (size_t i = 0; i < nGeomCount; ++i)
+    {
+        if (abUnsupported[i])
+            continue;
+
+        bool bOK = true;
+        for (iPoint = anFirstPoint[i]; bOK && iPoint < anFirstPoint[i + 1];
+             ++iPoint)
+        {
+            bOK = abSuccess[iPoint] != 0;
+        }
+        if (!bOK)
+            continue;
+
+        iPoint = anFirstPoint[i];
+        for (size_t iPart = anFirstPart[i]; iPart < anFirstPart[i + 1];
+             ++iPart)
+        {
+            const auto &oPart = oCollector.aoParts[iPart];
+            if (oPart.poPoint)
+            {
+                oPart.poPoint->setX(adfX[iPoint]);
+                oPart.poPoint->setY(adfY[iPoint]);
+                if (oPart.poPoint->Is3D())
+                    oPart.poPoint->setZ(adfZ[iPoint]);
+                ++iPoint;
+            }
+            else
+            {
+                auto poCurve = oPart.poCurve;
+                const int nPoints = poCurve->getNumPoints();
+                poCurve->setPoints(nPoints, adfX.data() + iPoint,
+                                   adfY.data() + iPoint,
+                                   poCurve->Is3D() ? adfZ.data() + iPoint
+                                                   : nullptr);
+                iPoint += nPoints;
+
+                // Same as OGRLinearRing::transform()
+                if (oPart.bClosedRing && !poCurve->get_IsClosed())
+                {
+                    OGRPoint oStartPoint;
+                    poCurve->StartPoint(&oStartPoint);
+                    poCurve->setPoint(nPoints - 1, &oStartPoint);
+                }
+            }
+        }
+
+        papoGeoms[i]->assignSpatialReference(poTargetSRS);
+        pabTransformed[i] = true;
+    }
+}
+
+/************************************************************************/
+/*                        transformGeometries()                         */
+/************************************************************************/
+
+/** Transform several geometries in place.
+ *
+ * This is equivalent to calling OGRGeometry::transform() on each geometry,
+ * but the coordinates of all the geometries are transformed with a single
+ * call to OGRCoordinateTransformation::Transform(), which is significantly
+ * faster when transforming a large number of small geometries. Geometries
+ * for which some points cannot be transformed are processed with
+ * OGRGeometry::transform().
+ *
+ * Note that when the coordinate transformation dynamically selects the
+ * coordinate operation from the extent of the points (OGR_CT_OP_SELECTION
+ * set to BEST_ACCURACY or FIRST_MATCHING), it is selected from all the
+ * points of the geometries.
+ *
+ * @param papoGeoms array of nGeomCount geometries.
+ * @param nGeomCount number of geometries.
+ * @param poCT coordinate transformation object.
+ * @param peErrors array of nGeomCount values, set to the result of the
+ * transformation of each geometry, or nullptr.
+ * @return OGRERR_NONE if all geometries were successfully transformed,
+ * otherwise the error of the first geometry that could not be transformed.
+ * @since GDAL 3.9
+ */
+OGRErr OGRGeometryFactory::transformGeometries(
+    OGRGeometry *const *papoGeoms, size_t nGeomCount,
+    OGRCoordinateTransformation *poCT, OGRErr *peErrors)
+{
+    std::unique_ptr<bool[]> pabTransformed;
+    try
+    {
+        pabTransformed.reset(new bool[nGeomCount]);
+    }
+    catch (const std::bad_alloc &)
+    {
+        return OGRERR_NOT_ENOUGH_MEMORY;
+    }
+    OGRTransformGeometriesPoints(papoGeoms, nGeomCount, poCT,
+                                 pabTransformed.get());
+
+    OGRErr eRet = OGRERR_NONE;
+    for (size_t i = 0; i < nGeomCount; ++i)
+    {
+        const OGRErr eErr = pabTransformed[i]
+                                ? OGRERR_NONE
+                                : papoGeoms[i]->transform(poCT);
+        if (peErrors)
+            peErrors[i] = eErr;
+        if (eErr != OGRERR_NONE && eRet == OGRERR_NONE)
+            eRet = eErr;
+    }
+    return eRet;
+}
+
 /************************************************************************/
 /*                  TransformWithOptionsCache::Private                  */
 /************************************************************************/
@@ -335,6 +335,10 @@ class OGRArrowWriterLayer CPL_NON_FINAL : public OGRLayer
     std::vector<std::set<OGRwkbGeometryType>>
         m_oSetWrittenGeometryTypes{};  // size: GetGeomFieldCount()
 
+    // Whether to write a "{geom_name}_bbox" struct column with xmin, ymin,
+    // xmax, ymax double members after the geometry columns.
+    bool m_bWriteBBoxStruct = false;
+
     static OGRArrowGeomEncoding
     GetPreciseArrowGeomEncoding(OGRwkbGeometryType eGType);
     static const char *
@@ -357,6 +361,7 @@ class OGRArrowWriterLayer CPL_NON_FINAL : public OGRLayer
     }
 
     void CreateArrayBuilders();
+    std::string GetBBoxStructColumnName(int iGeomField) const;
     virtual bool FlushGroup() = 0;
     void FinalizeWriting();
     bool WriteArrays(std::function<bool(const std::shared_ptr<arrow::Field> &,
@@ -34,6 +34,7 @@
 #include "cpl_float.h"
 #include "cpl_json.h"
 #include "cpl_time.h"
+#include "ograrrowarrayhelper.h"
 #include "ogrlayerarrow.h"
 #include "ogr_p.h"
 #include "ogr_swq.h"
@@ -3368,8 +3369,9 @@ OGRArrowLayer::SetBatch(const std::shared_ptr<arrow::RecordBatch> &poBatch)
                     static_cast<const arrow::LargeBinaryArray *>(poArrayWKB);
             }
 
-            if (m_iBBOXMinXField >= 0 && m_iBBOXMinYField >= 0 &&
-                m_iBBOXMaxXField >= 0 && m_iBBOXMaxYField >= 0 &&
+            if (m_iGeomFieldFilter == 0 && m_iBBOXMinXField >= 0 &&
+                m_iBBOXMinYField >= 0 && m_iBBOXMaxXField >= 0 &&
+                m_iBBOXMaxYField >= 0 &&
                 CPLTestBool(CPLGetConfigOption(
                     ("OGR_" + GetDriverUCName() + "_USE_BBOX").c_str(), "YES")))
             {
@@ -4171,6 +4173,16 @@ inline bool OGRArrowLayer::UseRecordBatchBaseImplementation() const
             }
         }
     }
+    else if (OGRArrowArrayHelper::HasGeoArrowGeometryField(
+                 m_poFeatureDefn, m_aosArrowArrayStreamOptions))
+    {
+        // GEOMETRY_ENCODING=GEOARROW[_INTERLEAVED] is handled by the generic
+        // implementation, even when the native encoding is already GeoArrow,
+        // as the coordinate layout of the file might not be the requested one.
+        CPLDebug("ARROW", "Geometry encoding not compatible of fast "
+                          "Arrow implementation");
+        return true;
+    }
 
     if (m_bIgnoredFields)
     {
@@ -341,6 +341,22 @@ inline void OGRArrowWriterLayer::CreateSchemaCommon()
         fields.emplace_back(field);
     }
 
+    if (m_bWriteBBoxStruct)
+    {
+        for (int i = 0; i < m_poFeatureDefn->GetGeomFieldCount(); ++i)
+        {
+            const auto poGeomFieldDefn = m_poFeatureDefn->GetGeomFieldDefn(i);
+            auto bboxType = arrow::struct_(
+                {arrow::field("xmin", arrow::float64(), false),
+                 arrow::field("ymin", arrow::float64(), false),
+                 arrow::field("xmax", arrow::float64(), false),
+                 arrow::field("ymax", arrow::float64(), false)});
+            fields.emplace_back(arrow::field(GetBBoxStructColumnName(i),
+                                             std::move(bboxType),
+                                             poGeomFieldDefn->IsNullable()));
+        }
+    }
+
     m_aoEnvelopes.resize(m_poFeatureDefn->GetGeomFieldCount());
     m_oSetWrittenGeometryTypes.resize(m_poFeatureDefn->GetGeomFieldCount());
 
@@ -921,6 +937,33 @@ inline void OGRArrowWriterLayer::CreateArrayBuilders()
         }
         m_apoBuilders.emplace_back(builder);
     }
+
+    if (m_bWriteBBoxStruct)
+    {
+        for (int i = 0; i < m_poFeatureDefn->GetGeomFieldCount(); ++i)
+        {
+            std::vector<std::shared_ptr<arrow::ArrayBuilder>> apoChildren;
+            for (int j = 0; j < 4; ++j)
+                apoChildren.emplace_back(
+                    std::make_shared<arrow::DoubleBuilder>(m_poMemoryPool));
+            m_apoBuilders.emplace_back(std::make_shared<arrow::StructBuilder>(
+                m_poSchema->fields()[nArrowIdx]->type(), m_poMemoryPool,
+                std::move(apoChildren)));
+            ++nArrowIdx;
+        }
+    }
+}
+
+/************************************************************************/
+/*                      GetBBoxStructColumnName()                       */
+/************************************************************************/
+
+inline std::string
+OGRArrowWriterLayer::GetBBoxStructColumnName(int iGeomField) const
+{
+    return std::string(
+               m_poFeatureDefn->GetGeomFieldDefn(iGeomField)->GetNameRef()) +
+           "_bbox";
 }
 
 /************************************************************************/
@@ -1645,6 +1688,39 @@ inline OGRErr OGRArrowWriterLayer::ICreateFeature(OGRFeature *poFeature)
             return OGRERR_FAILURE;
     }
 
+    // Write bounding box of geometries
+    if (m_bWriteBBoxStruct)
+    {
+        for (int i = 0; i < nGeomFieldCount; ++i, ++nArrowIdx)
+        {
+            auto poStructBuilder = static_cast<arrow::StructBuilder *>(
+                m_apoBuilders[nArrowIdx].get());
+            const OGRGeometry *poGeom = poFeature->GetGeomFieldRef(i);
+            OGREnvelope sEnvelope;
+            const bool bValid = poGeom && !poGeom->IsEmpty();
+            if (bValid)
+                poGeom->getEnvelope(&sEnvelope);
+            else
+                sEnvelope.MinX = sEnvelope.MinY = sEnvelope.MaxX =
+                    sEnvelope.MaxY = 0;
+            // Append(false) only records a null in the validity bitmap, so
+            // we must append a (ignored) value to each child builder in all
+            // cases.
+            OGR_ARROW_RETURN_OGRERR_NOT_OK(poStructBuilder->Append(bValid));
+            for (int j = 0; j < 4; ++j)
+            {
+                const double dfVal = j == 0   ? sEnvelope.MinX
+                                     : j == 1 ? sEnvelope.MinY
+                                     : j == 2 ? sEnvelope.MaxX
+                                              : sEnvelope.MaxY;
+                OGR_ARROW_RETURN_OGRERR_NOT_OK(
+                    static_cast<arrow::DoubleBuilder *>(
+                        poStructBuilder->field_builder(j))
+                        ->Append(dfVal));
+            }
+        }
+    }
+
     m_nFeatureCount++;
 
     // Flush the current row group if reaching the limit of rows per group.
@@ -32,8 +32,14 @@
 #define OGR_CSV_H_INCLUDED
 
 #include "ogrsf_frmts.h"
+#include "ogrlayerparallelfilter.h"
 
+#include <deque>
+#include <memory>
 #include <set>
+#include <vector>
+
+class CPLJobQueue;
 
 typedef enum
 {
@@ -96,7 +102,43 @@ class OGRCSVLayer final : public IOGRCSVLayer, public OGRLayer
 
     bool bHasFieldNames;
 
+    OGRLayerParallelFilter m_oParallelFilter{this};
+
+    // Multi-threaded parsing (OGR_CSV_NUM_THREADS)
+    int m_nNumThreads = 0;
+    bool m_bAllRecordsRead = false;
+    std::vector<CPLCharUniquePtr> m_apszRecords{};
+    std::vector<int> m_anRecordFIDs{};
+    std::vector<std::unique_ptr<OGRFeature>> m_apoParsedFeatures{};
+    std::deque<std::unique_ptr<OGRFeature>> m_oParsedQueue{};
+    std::unique_ptr<CPLJobQueue> m_poJobQueue{};
+
+    struct ParseJob;
+
+    // Sparse index of the file offsets of records with FID 1, 1 + STEP,
+    // 1 + 2 * STEP, etc., built as the file is read.
+    std::vector<vsi_l_offset> m_anSeekIndexOffsets{};
+    // Whether the whole file has been read
+    bool m_bSeekIndexComplete = false;
+    GIntBig m_nSeekIndexRecordCount = 0;
+    std::string m_osSeekIndexSidecarFilename{};
+
+    void UpdateSeekIndex();
+    void SetSeekIndexComplete();
+    void InvalidateSeekIndex();
+    bool SkipToRecord(GIntBig nFID);
+    bool ReadSeekIndexSidecar();
+    void WriteSeekIndexSidecar() const;
+
     OGRFeature *GetNextUnfilteredFeature();
+    OGRFeature *ReadNextUnfilteredFeature();
+    OGRFeature *TranslateRecord(char **papszTokens, int nFID,
+                                bool &bWarningEmitted);
+
+    int GetNumThreads();
+    static void ParseJobFunc(void *pData);
+    bool ParseNextBatch();
+    void ResetParsedQueue();
 
     bool bNew;
     bool bInWriteMode;
@@ -214,9 +256,12 @@ class OGRCSVLayer final : public IOGRCSVLayer, public OGRLayer
                           const char *pszGeonamesGeomFieldPrefix = nullptr,
                           char **papszOpenOptions = nullptr);
 
+    void SetSeekIndexSidecarFilename(const std::string &osFilename);
+
     void ResetReading() override;
     OGRFeature *GetNextFeature() override;
     virtual OGRFeature *GetFeature(GIntBig nFID) override;
+    OGRErr SetNextByIndex(GIntBig nIndex) override;
 
     OGRFeatureDefn *GetLayerDefn() override
     {
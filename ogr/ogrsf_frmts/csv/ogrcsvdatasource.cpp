@@ -900,6 +900,12 @@ bool OGRCSVDataSource::OpenTable(const char *pszFilename,
     poCSVLayer->BuildFeatureDefn(pszNfdcRunwaysGeomField,
                                  pszGeonamesGeomFieldPrefix,
                                  papszOpenOptionsIn);
+    if (!bUpdate && !EQUAL(pszFilename, "/vsistdin/") &&
+        CPLFetchBool(papszOpenOptionsIn, "SIDECAR_SEEK_INDEX", false))
+    {
+        poCSVLayer->SetSeekIndexSidecarFilename(std::string(pszFilename) +
+                                                ".csvidx");
+    }
     if (bUpdate)
     {
         m_apoLayers.emplace_back(std::make_unique<OGRCSVEditableLayer>(
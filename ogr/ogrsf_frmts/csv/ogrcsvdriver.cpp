@@ -429,6 +429,9 @@ void RegisterOGRCSV()
         "  <Option name='EMPTY_STRING_AS_NULL' type='boolean' "
         "description='Whether to consider empty strings as null fields on "
         "reading' default='NO'/>"
+        "  <Option name='SIDECAR_SEEK_INDEX' type='boolean' "
+        "description='Whether the index of record offsets should be persisted "
+        "in a .csvidx sidecar file' default='NO'/>"
         "  <Option name='MAX_LINE_SIZE' type='int' description='Maximum number "
         "of bytes for a line (-1=unlimited)' default='" STRINGIFY(
             OGR_CSV_DEFAULT_MAX_LINE_SIZE) "'/>"
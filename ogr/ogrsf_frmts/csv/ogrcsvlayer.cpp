@@ -47,8 +47,11 @@
 #include "cpl_conv.h"
 #include "cpl_csv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -59,6 +62,17 @@
 
 #define DIGIT_ZERO '0'
 
+// Number of records between two entries of the seek index
+constexpr int CSV_SEEK_INDEX_STEP = 1024;
+
+constexpr char CSV_SEEK_INDEX_MAGIC[] = "CSVSKIX1";
+constexpr size_t CSV_SEEK_INDEX_MAGIC_SIZE = 8;
+// magic, file size, file modification time, flags, number of records,
+// number of offsets
+constexpr size_t CSV_SEEK_INDEX_HEADER_SIZE = CSV_SEEK_INDEX_MAGIC_SIZE + 5 * 8;
+constexpr uint64_t CSV_SEEK_INDEX_FLAG_FIELD_NAMES = 1;
+constexpr uint64_t CSV_SEEK_INDEX_FLAG_HONOUR_STRINGS = 2;
+
 /************************************************************************/
 /*                            OGRCSVLayer()                             */
 /*                                                                      */
@@ -1263,6 +1277,10 @@ OGRCSVLayer::~OGRCSVLayer()
 
     CPLFree(panGeomFieldIndex);
 
+    // Release pending features before their definition
+    m_oParallelFilter.Reset();
+    ResetParsedQueue();
+
     poFeatureDefn->Release();
     CPLFree(pszFilename);
 
@@ -1291,6 +1309,10 @@ void OGRCSVLayer::ResetReading()
     bNeedRewindBeforeRead = false;
 
     nNextFID = 1;
+
+    m_oParallelFilter.Reset();
+    ResetParsedQueue();
+    m_nNumThreads = 0;
 }
 
 /************************************************************************/
@@ -1326,17 +1348,277 @@ OGRFeature *OGRCSVLayer::GetFeature(GIntBig nFID)
 {
     if (nFID < 1 || fpCSV == nullptr)
         return nullptr;
-    if (nFID < nNextFID || bNeedRewindBeforeRead)
+    if (bNeedRewindBeforeRead)
         ResetReading();
+    if (!SkipToRecord(nFID))
+        return nullptr;
+    return ReadNextUnfilteredFeature();
+}
+
+/************************************************************************/
+/*                           SetNextByIndex()                           */
+/************************************************************************/
+
+OGRErr OGRCSVLayer::SetNextByIndex(GIntBig nIndex)
+{
+    if (m_poFilterGeom != nullptr || m_poAttrQuery != nullptr)
+        return OGRLayer::SetNextByIndex(nIndex);
+
+    if (nIndex < 0 || fpCSV == nullptr)
+        return OGRERR_FAILURE;
+    if (bNeedRewindBeforeRead)
+        ResetReading();
+    return SkipToRecord(nIndex + 1) ? OGRERR_NONE : OGRERR_FAILURE;
+}
+
+/************************************************************************/
+/*                            SkipToRecord()                            */
+/************************************************************************/
+
+// Positions the reader so that the next record read has FID nFID, using
+// the seek index when possible. Returns false if the file has less than
+// nFID - 1 records.
+bool OGRCSVLayer::SkipToRecord(GIntBig nFID)
+{
+    if ((m_bSeekIndexComplete && nFID > m_nSeekIndexRecordCount + 1) ||
+        nFID > std::numeric_limits<int>::max())
+    {
+        return false;
+    }
+
+    // Records already read in advance have a FID lower than nNextFID
+    m_oParallelFilter.Reset();
+    ResetParsedQueue();
+
+    bool bSeekDone = false;
+    if (!m_anSeekIndexOffsets.empty())
+    {
+        const size_t iEntry =
+            std::min(static_cast<size_t>((nFID - 1) / CSV_SEEK_INDEX_STEP),
+                     m_anSeekIndexOffsets.size() - 1);
+        const int nEntryFID =
+            1 + static_cast<int>(iEntry) * CSV_SEEK_INDEX_STEP;
+        if (nFID < nNextFID || nEntryFID > nNextFID)
+        {
+            if (VSIFSeekL(fpCSV, m_anSeekIndexOffsets[iEntry], SEEK_SET) != 0)
+                return false;
+            nNextFID = nEntryFID;
+            bSeekDone = true;
+        }
+    }
+    if (!bSeekDone && nFID < nNextFID)
+        ResetReading();
+
     while (nNextFID < nFID)
     {
+        UpdateSeekIndex();
         char **papszTokens = GetNextLineTokens();
         if (papszTokens == nullptr)
-            return nullptr;
+        {
+            if (VSIFEofL(fpCSV))
+                SetSeekIndexComplete();
+            return false;
+        }
         CSLDestroy(papszTokens);
         nNextFID++;
     }
-    return GetNextUnfilteredFeature();
+    return true;
+}
+
+/************************************************************************/
+/*                          UpdateSeekIndex()                           */
+/************************************************************************/
+
+// Must be called before reading the record of FID nNextFID
+void OGRCSVLayer::UpdateSeekIndex()
+{
+    if (!m_bSeekIndexComplete && ((nNextFID - 1) % CSV_SEEK_INDEX_STEP) == 0 &&
+        static_cast<size_t>((nNextFID - 1) / CSV_SEEK_INDEX_STEP) ==
+            m_anSeekIndexOffsets.size())
+    {
+        m_anSeekIndexOffsets.push_back(VSIFTellL(fpCSV));
+    }
+}
+
+/************************************************************************/
+/*                        SetSeekIndexComplete()                        */
+/************************************************************************/
+
+// Must be called when the end of file is reached
+void OGRCSVLayer::SetSeekIndexComplete()
+{
+    if (m_bSeekIndexComplete)
+        return;
+    m_bSeekIndexComplete = true;
+    m_nSeekIndexRecordCount = nNextFID - 1;
+    if (nTotalFeatures < 0)
+        nTotalFeatures = m_nSeekIndexRecordCount;
+    if (!m_osSeekIndexSidecarFilename.empty())
+        WriteSeekIndexSidecar();
+}
+
+/************************************************************************/
+/*                        InvalidateSeekIndex()                         */
+/************************************************************************/
+
+void OGRCSVLayer::InvalidateSeekIndex()
+{
+    m_anSeekIndexOffsets.clear();
+    m_bSeekIndexComplete = false;
+    m_nSeekIndexRecordCount = 0;
+}
+
+/************************************************************************/
+/*                    SetSeekIndexSidecarFilename()                     */
+/************************************************************************/
+
+// Enables the persistence of the seek index in a sidecar file, and loads
+// it if it exists and is up-to-date.
+void OGRCSVLayer::SetSeekIndexSidecarFilename(const std::string &osFilename)
+{
+    m_osSeekIndexSidecarFilename = osFilename;
+    if (!m_bSeekIndexComplete && ReadSeekIndexSidecar())
+    {
+        m_bSeekIndexComplete = true;
+        if (nTotalFeatures < 0)
+            nTotalFeatures = m_nSeekIndexRecordCount;
+    }
+}
+
+/************************************************************************/
+/*                        ReadSeekIndexSidecar()                        */
+/************************************************************************/
+
+bool OGRCSVLayer::ReadSeekIndexSidecar()
+{
+    VSIStatBufL sStat;
+    VSIStatBufL sStatIndex;
+    if (VSIStatL(pszFilename, &sStat) != 0 ||
+        VSIStatL(m_osSeekIndexSidecarFilename.c_str(), &sStatIndex) != 0)
+    {
+        return false;
+    }
+
+    VSILFILE *fp = VSIFOpenL(m_osSeekIndexSidecarFilename.c_str(), "rb");
+    if (!fp)
+        return false;
+
+    GByte abyHeader[CSV_SEEK_INDEX_HEADER_SIZE];
+    uint64_t anHeaderValues[5] = {0, 0, 0, 0, 0};
+    bool bOK = VSIFReadL(abyHeader, sizeof(abyHeader), 1, fp) == 1 &&
+               memcmp(abyHeader, CSV_SEEK_INDEX_MAGIC,
+                      CSV_SEEK_INDEX_MAGIC_SIZE) == 0;
+    if (bOK)
+    {
+        memcpy(anHeaderValues, abyHeader + CSV_SEEK_INDEX_MAGIC_SIZE,
+               sizeof(anHeaderValues));
+        for (uint64_t &nVal : anHeaderValues)
+            CPL_LSBPTR64(&nVal);
+    }
+    const uint64_t nFileSize = anHeaderValues[0];
+    const int64_t nMTime = static_cast<int64_t>(anHeaderValues[1]);
+    const uint64_t nIndexFlags = anHeaderValues[2];
+    const uint64_t nRecordCount = anHeaderValues[3];
+    const uint64_t nOffsetCount = anHeaderValues[4];
+    const uint64_t nExpectedFlags =
+        (bHasFieldNames ? CSV_SEEK_INDEX_FLAG_FIELD_NAMES : 0) |
+        (bHonourStrings ? CSV_SEEK_INDEX_FLAG_HONOUR_STRINGS : 0);
+    bOK = bOK && nFileSize == static_cast<uint64_t>(sStat.st_size) &&
+          nMTime == static_cast<int64_t>(sStat.st_mtime) &&
+          nIndexFlags == nExpectedFlags &&
+          nRecordCount <
+              static_cast<uint64_t>(std::numeric_limits<int>::max()) &&
+          nOffsetCount == nRecordCount / CSV_SEEK_INDEX_STEP + 1 &&
+          static_cast<uint64_t>(sStatIndex.st_size) ==
+              CSV_SEEK_INDEX_HEADER_SIZE + nOffsetCount * 8;
+
+    std::vector<uint64_t> anOffsets;
+    if (bOK)
+    {
+        try
+        {
+            anOffsets.resize(static_cast<size_t>(nOffsetCount));
+        }
+        catch (const std::exception &)
+        {
+            bOK = false;
+        }
+    }
+    if (bOK)
+        bOK = VSIFReadL(anOffsets.data(), anOffsets.size() * 8, 1, fp) == 1;
+    VSIFCloseL(fp);
+
+    for (size_t i = 0; bOK && i < anOffsets.size(); ++i)
+    {
+        CPL_LSBPTR64(&anOffsets[i]);
+        bOK = anOffsets[i] <= nFileSize &&
+              (i == 0 || anOffsets[i] > anOffsets[i - 1]);
+    }
+
+    if (!bOK)
+    {
+        CPLDebug("CSV", "Ignoring invalid or outdated %s",
+                 m_osSeekIndexSidecarFilename.c_str());
+        return false;
+    }
+
+    CPLDebug("CSV", "Reading seek index from %s",
+             m_osSeekIndexSidecarFilename.c_str());
+    m_anSeekIndexOffsets.assign(anOffsets.begin(), anOffsets.end());
+    m_nSeekIndexRecordCount = static_cast<GIntBig>(nRecordCount);
+    return true;
+}
+
+/************************************************************************/
+/*                       WriteSeekIndexSidecar()                        */
+/************************************************************************/
+
+void OGRCSVLayer::WriteSeekIndexSidecar() const
+{
+    VSIStatBufL sStat;
+    if (VSIStatL(pszFilename, &sStat) != 0)
+        return;
+
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    VSILFILE *fp = VSIFOpenL(m_osSeekIndexSidecarFilename.c_str(), "wb");
+    CPLPopErrorHandler();
+    if (!fp)
+    {
+        CPLDebug("CSV", "Cannot create %s",
+                 m_osSeekIndexSidecarFilename.c_str());
+        return;
+    }
+
+    GByte abyHeader[CSV_SEEK_INDEX_HEADER_SIZE];
+    memcpy(abyHeader, CSV_SEEK_INDEX_MAGIC, CSV_SEEK_INDEX_MAGIC_SIZE);
+    uint64_t anHeaderValues[5] = {
+        static_cast<uint64_t>(sStat.st_size),
+        static_cast<uint64_t>(static_cast<int64_t>(sStat.st_mtime)),
+        (bHasFieldNames ? CSV_SEEK_INDEX_FLAG_FIELD_NAMES : 0) |
+            (bHonourStrings ? CSV_SEEK_INDEX_FLAG_HONOUR_STRINGS : 0),
+        static_cast<uint64_t>(m_nSeekIndexRecordCount),
+        static_cast<uint64_t>(m_anSeekIndexOffsets.size())};
+    for (uint64_t &nVal : anHeaderValues)
+        CPL_LSBPTR64(&nVal);
+    memcpy(abyHeader + CSV_SEEK_INDEX_MAGIC_SIZE, anHeaderValues,
+           sizeof(anHeaderValues));
+    bool bOK = VSIFWriteL(abyHeader, sizeof(abyHeader), 1, fp) == 1;
+
+    for (size_t i = 0; bOK && i < m_anSeekIndexOffsets.size(); ++i)
+    {
+        uint64_t nOffset = static_cast<uint64_t>(m_anSeekIndexOffsets[i]);
+        CPL_LSBPTR64(&nOffset);
+        bOK = VSIFWriteL(&nOffset, sizeof(nOffset), 1, fp) == 1;
+    }
+
+    if (VSIFCloseL(fp) != 0)
+        bOK = false;
+    if (!bOK)
+    {
+        CPLDebug("CSV", "Cannot write %s",
+                 m_osSeekIndexSidecarFilename.c_str());
+        VSIUnlink(m_osSeekIndexSidecarFilename.c_str());
+    }
 }
 
 /************************************************************************/
@@ -1345,15 +1627,64 @@ OGRFeature *OGRCSVLayer::GetFeature(GIntBig nFID)
 
 OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
 
+{
+    if (fpCSV == nullptr)
+        return nullptr;
+
+    if (GetNumThreads() <= 1)
+        return ReadNextUnfilteredFeature();
+
+    while (m_oParsedQueue.empty())
+    {
+        if (m_bAllRecordsRead || !ParseNextBatch())
+            return nullptr;
+    }
+    OGRFeature *poFeature = m_oParsedQueue.front().release();
+    m_oParsedQueue.pop_front();
+
+    m_nFeaturesRead++;
+
+    return poFeature;
+}
+
+/************************************************************************/
+/*                     ReadNextUnfilteredFeature()                      */
+/************************************************************************/
+
+OGRFeature *OGRCSVLayer::ReadNextUnfilteredFeature()
+
 {
     if (fpCSV == nullptr)
         return nullptr;
 
     // Read the CSV record.
+    UpdateSeekIndex();
     char **papszTokens = GetNextLineTokens();
     if (papszTokens == nullptr)
+    {
+        if (VSIFEofL(fpCSV))
+            SetSeekIndexComplete();
         return nullptr;
+    }
+
+    OGRFeature *poFeature =
+        TranslateRecord(papszTokens, nNextFID, bWarningBadTypeOrWidth);
+    nNextFID++;
 
+    m_nFeaturesRead++;
+
+    return poFeature;
+}
+
+/************************************************************************/
+/*                          TranslateRecord()                           */
+/************************************************************************/
+
+// Takes ownership of papszTokens. Does not modify the state of the layer,
+// so that it can be called from worker threads.
+OGRFeature *OGRCSVLayer::TranslateRecord(char **papszTokens, int nFID,
+                                         bool &bWarningEmitted)
+{
     // Create the OGR feature.
     OGRFeature *poFeature = new OGRFeature(poFeatureDefn);
 
@@ -1436,14 +1767,14 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
                 {
                     poFeature->SetField(iOGRField, 0);
                 }
-                else if (!bWarningBadTypeOrWidth)
+                else if (!bWarningEmitted)
                 {
-                    bWarningBadTypeOrWidth = true;
+                    bWarningEmitted = true;
                     CPLError(
                         CE_Warning, CPLE_AppDefined,
                         "Invalid value type found in record %d for field %s. "
                         "This warning will no longer be emitted",
-                        nNextFID, poFieldDefn->GetNameRef());
+                        nFID, poFieldDefn->GetNameRef());
                 }
             }
         }
@@ -1462,31 +1793,31 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
                 if (eType == CPL_VALUE_INTEGER || eType == CPL_VALUE_REAL)
                 {
                     poFeature->SetField(iOGRField, papszTokens[iAttr]);
-                    if (!bWarningBadTypeOrWidth &&
+                    if (!bWarningEmitted &&
                         (eFieldType == OFTInteger ||
                          eFieldType == OFTInteger64) &&
                         eType == CPL_VALUE_REAL)
                     {
-                        bWarningBadTypeOrWidth = true;
+                        bWarningEmitted = true;
                         CPLError(CE_Warning, CPLE_AppDefined,
                                  "Invalid value type found in record %d for "
                                  "field %s. "
                                  "This warning will no longer be emitted",
-                                 nNextFID, poFieldDefn->GetNameRef());
+                                 nFID, poFieldDefn->GetNameRef());
                     }
-                    else if (!bWarningBadTypeOrWidth &&
+                    else if (!bWarningEmitted &&
                              poFieldDefn->GetWidth() > 0 &&
                              static_cast<int>(strlen(papszTokens[iAttr])) >
                                  poFieldDefn->GetWidth())
                     {
-                        bWarningBadTypeOrWidth = true;
+                        bWarningEmitted = true;
                         CPLError(CE_Warning, CPLE_AppDefined,
                                  "Value with a width greater than field width "
                                  "found in record %d for field %s. "
                                  "This warning will no longer be emitted",
-                                 nNextFID, poFieldDefn->GetNameRef());
+                                 nFID, poFieldDefn->GetNameRef());
                     }
-                    else if (!bWarningBadTypeOrWidth &&
+                    else if (!bWarningEmitted &&
                              eType == CPL_VALUE_REAL &&
                              poFieldDefn->GetWidth() > 0)
                     {
@@ -1497,26 +1828,26 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
                                 : 0;
                         if (nPrecision > poFieldDefn->GetPrecision())
                         {
-                            bWarningBadTypeOrWidth = true;
+                            bWarningEmitted = true;
                             CPLError(CE_Warning, CPLE_AppDefined,
                                      "Value with a precision greater than "
                                      "field precision found in record %d for "
                                      "field %s. "
                                      "This warning will no longer be emitted",
-                                     nNextFID, poFieldDefn->GetNameRef());
+                                     nFID, poFieldDefn->GetNameRef());
                         }
                     }
                 }
                 else
                 {
-                    if (!bWarningBadTypeOrWidth)
+                    if (!bWarningEmitted)
                     {
-                        bWarningBadTypeOrWidth = true;
+                        bWarningEmitted = true;
                         CPLError(
                             CE_Warning, CPLE_AppDefined,
                             "Invalid value type found in record %d for field "
                             "%s. This warning will no longer be emitted.",
-                            nNextFID, poFieldDefn->GetNameRef());
+                            nFID, poFieldDefn->GetNameRef());
                     }
                 }
             }
@@ -1526,15 +1857,15 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
             if (papszTokens[iAttr][0] != '\0' && !poFieldDefn->IsIgnored())
             {
                 poFeature->SetField(iOGRField, papszTokens[iAttr]);
-                if (!bWarningBadTypeOrWidth &&
+                if (!bWarningEmitted &&
                     !poFeature->IsFieldSetAndNotNull(iOGRField))
                 {
-                    bWarningBadTypeOrWidth = true;
+                    bWarningEmitted = true;
                     CPLError(
                         CE_Warning, CPLE_AppDefined,
                         "Invalid value type found in record %d for field %s. "
                         "This warning will no longer be emitted",
-                        nNextFID, poFieldDefn->GetNameRef());
+                        nFID, poFieldDefn->GetNameRef());
                 }
             }
         }
@@ -1547,16 +1878,16 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
             else
             {
                 poFeature->SetField(iOGRField, papszTokens[iAttr]);
-                if (!bWarningBadTypeOrWidth && poFieldDefn->GetWidth() > 0 &&
+                if (!bWarningEmitted && poFieldDefn->GetWidth() > 0 &&
                     static_cast<int>(strlen(papszTokens[iAttr])) >
                         poFieldDefn->GetWidth())
                 {
-                    bWarningBadTypeOrWidth = true;
+                    bWarningEmitted = true;
                     CPLError(CE_Warning, CPLE_AppDefined,
                              "Value with a width greater than field width "
                              "found in record %d for field %s. "
                              "This warning will no longer be emitted",
-                             nNextFID, poFieldDefn->GetNameRef());
+                             nFID, poFieldDefn->GetNameRef());
                 }
             }
         }
@@ -1684,13 +2015,178 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
     CSLDestroy(papszTokens);
 
     // Translate the record id.
-    poFeature->SetFID(nNextFID++);
-
-    m_nFeaturesRead++;
+    poFeature->SetFID(nFID);
 
     return poFeature;
 }
 
+/************************************************************************/
+/*                            GetNumThreads()                           */
+/************************************************************************/
+
+int OGRCSVLayer::GetNumThreads()
+{
+    if (m_nNumThreads == 0)
+    {
+        const char *pszNumThreads =
+            CPLGetConfigOption("OGR_CSV_NUM_THREADS", "1");
+        if (EQUAL(pszNumThreads, "ALL_CPUS"))
+            m_nNumThreads = CPLGetNumCPUs();
+        else
+            m_nNumThreads = atoi(pszNumThreads);
+        m_nNumThreads = std::max(1, std::min(m_nNumThreads, 128));
+    }
+    return m_nNumThreads;
+}
+
+/************************************************************************/
+/*                              ParseJob                                */
+/************************************************************************/
+
+struct OGRCSVLayer::ParseJob
+{
+    OGRCSVLayer *poThis = nullptr;
+    size_t iStart = 0;
+    size_t iEnd = 0;
+    bool bWarningEmitted = false;
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+};
+
+/************************************************************************/
+/*                            ParseJobFunc()                            */
+/************************************************************************/
+
+/* static */ void OGRCSVLayer::ParseJobFunc(void *pData)
+{
+    ParseJob *psJob = static_cast<ParseJob *>(pData);
+    OGRCSVLayer *poThis = psJob->poThis;
+
+    // Errors are emitted afterwards by the calling thread, in record order
+    CPLInstallErrorHandlerAccumulator(psJob->aoErrors);
+    for (size_t i = psJob->iStart; i < psJob->iEnd; ++i)
+    {
+        char **papszTokens = CSVSplitRecord(
+            poThis->m_apszRecords[i].get(), poThis->szDelimiter,
+            poThis->bHonourStrings,
+            false,  // bKeepLeadingAndClosingQuotes
+            poThis->bMergeDelimiter);
+        if (papszTokens == nullptr || papszTokens[0] == nullptr)
+        {
+            CSLDestroy(papszTokens);
+            continue;
+        }
+        poThis->m_apoParsedFeatures[i].reset(poThis->TranslateRecord(
+            papszTokens, poThis->m_anRecordFIDs[i], psJob->bWarningEmitted));
+    }
+    CPLUninstallErrorHandlerAccumulator();
+}
+
+/************************************************************************/
+/*                           ParseNextBatch()                           */
+/************************************************************************/
+
+// Reads a batch of records in the current thread, splits them into fields
+// and translates them into features in worker threads, and appends the
+// resulting features, in file order, to m_oParsedQueue.
+// Returns false if no record could be read.
+bool OGRCSVLayer::ParseNextBatch()
+{
+    const size_t nBatchSize = static_cast<size_t>(m_nNumThreads) * 256;
+    m_apszRecords.clear();
+    m_anRecordFIDs.clear();
+    while (m_apszRecords.size() < nBatchSize)
+    {
+        UpdateSeekIndex();
+        char *pszRecord = CSVReadRecordL(fpCSV, m_nMaxLineSize, bHonourStrings,
+                                         true  // bSkipBOM
+        );
+        if (pszRecord == nullptr)
+        {
+            if (VSIFEofL(fpCSV))
+                SetSeekIndexComplete();
+            m_bAllRecordsRead = true;
+            break;
+        }
+        // Empty records are skipped, as in GetNextLineTokens()
+        if (pszRecord[0] == '\0')
+        {
+            CPLFree(pszRecord);
+            continue;
+        }
+        m_apszRecords.emplace_back(pszRecord);
+        m_anRecordFIDs.push_back(nNextFID++);
+    }
+    if (m_apszRecords.empty())
+        return false;
+
+    const size_t nRecords = m_apszRecords.size();
+    m_apoParsedFeatures.clear();
+    m_apoParsedFeatures.resize(nRecords);
+    const size_t nJobs = std::min(static_cast<size_t>(m_nNumThreads),
+                                  (nRecords + 63) / 64);
+
+    std::vector<ParseJob> asJobs(nJobs);
+    for (size_t iJob = 0; iJob < nJobs; ++iJob)
+    {
+        asJobs[iJob].poThis = this;
+        asJobs[iJob].iStart = iJob * nRecords / nJobs;
+        asJobs[iJob].iEnd = (iJob + 1) * nRecords / nJobs;
+        asJobs[iJob].bWarningEmitted = bWarningBadTypeOrWidth;
+    }
+
+    CPLWorkerThreadPool *poPool =
+        nJobs > 1 ? GDALGetGlobalThreadPool(m_nNumThreads) : nullptr;
+    if (poPool && !m_poJobQueue)
+        m_poJobQueue = poPool->CreateJobQueue();
+    for (size_t iJob = 0; iJob < nJobs; ++iJob)
+    {
+        // The last job is run in the current thread
+        if (!m_poJobQueue || iJob + 1 == nJobs ||
+            !m_poJobQueue->SubmitJob(ParseJobFunc, &asJobs[iJob]))
+        {
+            ParseJobFunc(&asJobs[iJob]);
+        }
+    }
+    if (m_poJobQueue)
+        m_poJobQueue->WaitCompletion();
+
+    for (const auto &sJob : asJobs)
+    {
+        for (const auto &sError : sJob.aoErrors)
+        {
+            // Only the first warning about an invalid value is reported
+            if (sError.type == CE_Warning && bWarningBadTypeOrWidth)
+                continue;
+            CPLError(sError.type, sError.no, "%s", sError.msg.c_str());
+        }
+        if (sJob.bWarningEmitted)
+            bWarningBadTypeOrWidth = true;
+    }
+
+    for (auto &poFeature : m_apoParsedFeatures)
+    {
+        if (poFeature)
+            m_oParsedQueue.push_back(std::move(poFeature));
+    }
+    m_apoParsedFeatures.clear();
+    m_apszRecords.clear();
+    m_anRecordFIDs.clear();
+    return true;
+}
+
+/************************************************************************/
+/*                          ResetParsedQueue()                          */
+/************************************************************************/
+
+void OGRCSVLayer::ResetParsedQueue()
+{
+    m_bAllRecordsRead = false;
+    m_apszRecords.clear();
+    m_anRecordFIDs.clear();
+    m_apoParsedFeatures.clear();
+    m_oParsedQueue.clear();
+}
+
 /************************************************************************/
 /*                           GetNextFeature()                           */
 /************************************************************************/
@@ -1701,6 +2197,12 @@ OGRFeature *OGRCSVLayer::GetNextFeature()
     if (bNeedRewindBeforeRead)
         ResetReading();
 
+    if (m_oParallelFilter.IsActive())
+    {
+        return m_oParallelFilter.GetNextFeature(
+            [this]() { return GetNextUnfilteredFeature(); });
+    }
+
     // Read features till we find one that satisfies our current
     // spatial criteria.
     while (true)
@@ -1732,6 +2234,10 @@ int OGRCSVLayer::TestCapability(const char *pszCap)
     else if (EQUAL(pszCap, OLCCreateGeomField))
         return bNew && !bHasFieldNames &&
                eGeometryFormat == OGR_CSV_GEOM_AS_WKT;
+    else if (EQUAL(pszCap, OLCFastFeatureCount) ||
+             EQUAL(pszCap, OLCFastSetNextByIndex))
+        return m_bSeekIndexComplete && m_poFilterGeom == nullptr &&
+               m_poAttrQuery == nullptr;
     else if (EQUAL(pszCap, OLCIgnoreFields))
         return TRUE;
     else if (EQUAL(pszCap, OLCCurveGeometries))
@@ -2173,6 +2679,7 @@ OGRErr OGRCSVLayer::ICreateFeature(OGRFeature *poNewFeature)
     bool bNeedSeekEnd = !bNeedRewindBeforeRead;
 
     bNeedRewindBeforeRead = true;
+    InvalidateSeekIndex();
 
     // Write field names if we haven't written them yet.
     // Write .csvt file if needed.
@@ -2497,11 +3004,17 @@ GIntBig OGRCSVLayer::GetFeatureCount(int bForce)
         nTotalFeatures = 0;
         while (true)
         {
+            UpdateSeekIndex();
             char **papszTokens = GetNextLineTokens();
             if (papszTokens == nullptr)
+            {
+                if (VSIFEofL(fpCSV))
+                    SetSeekIndexComplete();
                 break;
+            }
 
             nTotalFeatures++;
+            nNextFID++;
 
             CSLDestroy(papszTokens);
         }
@@ -37,7 +37,10 @@
 #include "ogr_p.h"
 #include "cpl_http.h"
 #include "cpl_json.h"
+#include "cpl_worker_thread_pool.h"
 
+#include <atomic>
+#include <deque>
 #include <map>
 #include <memory>
 #include <set>
@@ -64,6 +67,43 @@ class OGRESSortDesc
     }
 };
 
+/************************************************************************/
+/*                        OGRElasticBulkRequest                         */
+/************************************************************************/
+
+// _bulk request run by a worker thread, when MAX_CONNECTIONS > 1
+struct OGRElasticBulkRequest
+{
+    OGRElasticDataSource *poDS = nullptr;
+    CPLString osContent{};
+    bool bOK = false;
+    CPLString osErrorMsg{};
+    std::atomic<bool> bDone{false};
+};
+
+/************************************************************************/
+/*                        OGRElasticScrollSlice                         */
+/************************************************************************/
+
+// State of one slice of a sliced scroll, whose next batch is fetched by a
+// worker thread while features of the other slices are read.
+struct OGRElasticScrollSlice
+{
+    OGRElasticDataSource *poDS = nullptr;
+    CPLString osRequest{};
+    CPLString osPostData{};
+    json_object *poResponse = nullptr;
+    CPLString osErrorMsg{};
+    CPLString osScrollID{};
+    bool bEOF = false;
+    std::atomic<bool> bDone{false};
+
+    OGRElasticScrollSlice() = default;
+    ~OGRElasticScrollSlice();
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRElasticScrollSlice)
+};
+
 /************************************************************************/
 /*                          OGRElasticLayer                             */
 /************************************************************************/
@@ -137,9 +177,26 @@ class OGRElasticLayer final : public OGRLayer
 
     bool m_bUseSingleQueryParams = false;
 
+    // Used when MAX_CONNECTIONS > 1
+    std::unique_ptr<CPLWorkerThreadPool> m_poThreadPool{};
+    std::deque<std::unique_ptr<OGRElasticBulkRequest>>
+        m_apoPendingBulkRequests{};
+    std::vector<std::unique_ptr<OGRElasticScrollSlice>> m_apoScrollSlices{};
+    int m_iCurScrollSlice = 0;
+
     void CopyMembersTo(OGRElasticLayer *poNew);
 
-    bool PushIndex();
+    CPLWorkerThreadPool *GetThreadPool();
+    static void BulkRequestJob(void *pData);
+    bool WaitBulkRequests(size_t nMaxRemaining);
+    bool PushIndex(bool bWaitCompletion = true);
+
+    static void ScrollSliceJob(void *pData);
+    bool StartSlicedScroll(const CPLString &osRequest,
+                           const CPLString &osPostData);
+    OGRFeature *GetNextSlicedScrollFeature();
+    void ClearScrollSlices();
+    void BuildFeaturesFromHits(json_object *poHits);
     CPLString BuildMap();
 
     OGRErr WriteMapIfNecessary();
@@ -349,6 +406,7 @@ class OGRElasticDataSource final : public GDALDataset
     char *m_pszWriteMap;
     char *m_pszMapping;
     int m_nBatchSize;
+    int m_nMaxConnections = 1;
     int m_nFeatureCountToEstablishFeatureDefn;
     bool m_bJSonField;
     bool m_bFlattenNestedAttributes;
@@ -35,6 +35,8 @@
 #include "ogrgeojsonreader.h"
 #include "ogr_swq.h"
 
+#include <algorithm>
+
 /************************************************************************/
 /*                        OGRElasticDataSource()                        */
 /************************************************************************/
@@ -840,6 +842,10 @@ bool OGRElasticDataSource::Open(GDALOpenInfo *poOpenInfo)
         CSLFetchNameValueDef(poOpenInfo->papszOpenOptions, "USERPWD", "");
     m_nBatchSize = atoi(CSLFetchNameValueDef(poOpenInfo->papszOpenOptions,
                                              "BATCH_SIZE", "100"));
+    m_nMaxConnections = std::max(
+        1, atoi(CSLFetchNameValueDef(
+               poOpenInfo->papszOpenOptions, "MAX_CONNECTIONS",
+               CPLGetConfigOption("ES_MAX_CONNECTIONS", "1"))));
     m_nFeatureCountToEstablishFeatureDefn = atoi(
         CSLFetchNameValueDef(poOpenInfo->papszOpenOptions,
                              "FEATURE_COUNT_TO_ESTABLISH_FEATURE_DEFN", "100"));
@@ -986,6 +992,8 @@ int OGRElasticDataSource::Create(const char *pszFilename,
     m_bOverwrite = CPLTestBool(CPLGetConfigOption("ES_OVERWRITE", "0"));
     // coverity[tainted_data]
     m_nBulkUpload = (int)CPLAtof(CPLGetConfigOption("ES_BULK", "0"));
+    m_nMaxConnections =
+        std::max(1, atoi(CPLGetConfigOption("ES_MAX_CONNECTIONS", "1")));
 
     // Read in the meta file from disk
     if (pszMetaFile != nullptr)
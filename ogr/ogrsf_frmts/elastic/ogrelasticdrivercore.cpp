@@ -140,6 +140,9 @@ void OGRElasticsearchDriverSetCommonMetadata(GDALDriver *poDriver)
         "serialized description of an aggregation request'/>"
         "  <Option name='BATCH_SIZE' type='integer' description='Number of "
         "features to retrieve per batch' default='100'/>"
+        "  <Option name='MAX_CONNECTIONS' type='integer' "
+        "description='Maximum number of concurrent connections, for sliced "
+        "scroll reading and bulk upload' default='1'/>"
         "  <Option name='FEATURE_COUNT_TO_ESTABLISH_FEATURE_DEFN' "
         "type='integer' description='Number of features to retrieve to "
         "establish feature definition. -1 = unlimited' default='100'/>"
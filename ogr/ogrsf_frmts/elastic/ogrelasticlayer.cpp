@@ -1075,6 +1075,7 @@ const char *OGRElasticLayer::GetFIDColumn()
 
 void OGRElasticLayer::ResetReading()
 {
+    ClearScrollSlices();
     if (!m_osScrollID.empty())
     {
         char **papszOptions =
@@ -1235,6 +1236,9 @@ OGRFeature *OGRElasticLayer::GetNextRawFeature()
     m_apoCachedFeatures.resize(0);
     m_iCurFeatureInPage = 0;
 
+    if (!m_apoScrollSlices.empty())
+        return GetNextSlicedScrollFeature();
+
     CPLString osRequest, osPostData;
     if (m_nReadFeaturesSinceResetReading == 0)
     {
@@ -1283,6 +1287,15 @@ OGRFeature *OGRElasticLayer::GetNextRawFeature()
 
     if (m_bAddPretty)
         osRequest += "&pretty";
+
+    // Sorted results cannot be fetched with a sliced scroll
+    if (m_nReadFeaturesSinceResetReading == 0 &&
+        m_poDS->m_nMaxConnections > 1 && m_poDS->m_nMajorVersion >= 5 &&
+        m_aoSortColumns.empty() && StartSlicedScroll(osRequest, osPostData))
+    {
+        return GetNextSlicedScrollFeature();
+    }
+
     poResponse = m_poDS->RunRequest(osRequest, osPostData);
     if (poResponse == nullptr)
     {
@@ -1321,6 +1334,27 @@ OGRFeature *OGRElasticLayer::GetNextRawFeature()
         json_object_put(poResponse);
         return nullptr;
     }
+    BuildFeaturesFromHits(poHits);
+
+    json_object_put(poResponse);
+    if (!m_apoCachedFeatures.empty())
+    {
+        OGRFeature *poRet = m_apoCachedFeatures[0];
+        m_apoCachedFeatures[0] = nullptr;
+        m_iCurFeatureInPage++;
+        m_nReadFeaturesSinceResetReading++;
+        return poRet;
+    }
+    return nullptr;
+}
+
+/************************************************************************/
+/*                       BuildFeaturesFromHits()                        */
+/************************************************************************/
+
+void OGRElasticLayer::BuildFeaturesFromHits(json_object *poHits)
+{
+    const auto nHits = json_object_array_length(poHits);
     for (auto i = decltype(nHits){0}; i < nHits; i++)
     {
         json_object *poHit = json_object_array_get_idx(poHits, i);
@@ -1373,17 +1407,213 @@ OGRFeature *OGRElasticLayer::GetNextRawFeature()
             poFeature->SetFID(++m_iCurID);
         m_apoCachedFeatures.push_back(poFeature);
     }
+}
 
+/************************************************************************/
+/*                      ~OGRElasticScrollSlice()                        */
+/************************************************************************/
+
+OGRElasticScrollSlice::~OGRElasticScrollSlice()
+{
     json_object_put(poResponse);
-    if (!m_apoCachedFeatures.empty())
+}
+
+/************************************************************************/
+/*                           ScrollSliceJob()                           */
+/************************************************************************/
+
+void OGRElasticLayer::ScrollSliceJob(void *pData)
+{
+    OGRElasticScrollSlice *psSlice =
+        static_cast<OGRElasticScrollSlice *>(pData);
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    CPLErrorReset();
+    psSlice->poResponse =
+        psSlice->poDS->RunRequest(psSlice->osRequest, psSlice->osPostData);
+    if (psSlice->poResponse == nullptr)
+        psSlice->osErrorMsg = CPLGetLastErrorMsg();
+    CPLPopErrorHandler();
+    psSlice->bDone = true;
+}
+
+/************************************************************************/
+/*                         StartSlicedScroll()                          */
+/************************************************************************/
+
+// Split the scroll into MAX_CONNECTIONS slices, whose batches are fetched
+// concurrently. Features are returned by visiting the slices in turn.
+bool OGRElasticLayer::StartSlicedScroll(const CPLString &osRequest,
+                                        const CPLString &osPostData)
+{
+    json_object *poQuery = nullptr;
+    if (!OGRJSonParse(osPostData.empty() ? "{}" : osPostData.c_str(),
+                      &poQuery, false) ||
+        json_object_get_type(poQuery) != json_type_object ||
+        CPL_json_object_object_get(poQuery, "sort") != nullptr ||
+        CPL_json_object_object_get(poQuery, "slice") != nullptr ||
+        GetThreadPool() == nullptr)
     {
-        OGRFeature *poRet = m_apoCachedFeatures[0];
-        m_apoCachedFeatures[0] = nullptr;
-        m_iCurFeatureInPage++;
-        m_nReadFeaturesSinceResetReading++;
-        return poRet;
+        json_object_put(poQuery);
+        return false;
     }
-    return nullptr;
+
+    const int nSlices = m_poDS->m_nMaxConnections;
+    CPLDebug("ES", "Using a sliced scroll with %d slices", nSlices);
+    for (int i = 0; i < nSlices; ++i)
+    {
+        json_object *poSlice = json_object_new_object();
+        json_object_object_add(poSlice, "id", json_object_new_int(i));
+        json_object_object_add(poSlice, "max", json_object_new_int(nSlices));
+        json_object_object_add(poQuery, "slice", poSlice);
+
+        auto poScrollSlice = std::make_unique<OGRElasticScrollSlice>();
+        poScrollSlice->poDS = m_poDS;
+        poScrollSlice->osRequest = osRequest;
+        poScrollSlice->osPostData = json_object_to_json_string(poQuery);
+        if (!m_poThreadPool->SubmitJob(ScrollSliceJob, poScrollSlice.get()))
+        {
+            json_object_put(poQuery);
+            ClearScrollSlices();
+            return false;
+        }
+        m_apoScrollSlices.push_back(std::move(poScrollSlice));
+    }
+    json_object_put(poQuery);
+    m_iCurScrollSlice = 0;
+    return true;
+}
+
+/************************************************************************/
+/*                     GetNextSlicedScrollFeature()                     */
+/************************************************************************/
+
+OGRFeature *OGRElasticLayer::GetNextSlicedScrollFeature()
+{
+    const int nSlices = static_cast<int>(m_apoScrollSlices.size());
+    while (true)
+    {
+        bool bAllEOF = true;
+        for (const auto &poSlice : m_apoScrollSlices)
+        {
+            if (!poSlice->bEOF)
+            {
+                bAllEOF = false;
+                break;
+            }
+        }
+        if (bAllEOF)
+        {
+            m_bEOF = true;
+            return nullptr;
+        }
+
+        auto &poSlice = m_apoScrollSlices[m_iCurScrollSlice];
+        m_iCurScrollSlice = (m_iCurScrollSlice + 1) % nSlices;
+        if (poSlice->bEOF)
+            continue;
+
+        while (!poSlice->bDone)
+            m_poThreadPool->WaitEvent();
+
+        json_object *poResponse = poSlice->poResponse;
+        poSlice->poResponse = nullptr;
+        if (poResponse == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "%s",
+                     poSlice->osErrorMsg.empty() ? "Scroll request failed"
+                                                 : poSlice->osErrorMsg.c_str());
+            poSlice->bEOF = true;
+            m_bEOF = true;
+            return nullptr;
+        }
+
+        poSlice->osScrollID.clear();
+        json_object *poScrollID =
+            CPL_json_object_object_get(poResponse, "_scroll_id");
+        if (poScrollID)
+        {
+            const char *pszScrollID = json_object_get_string(poScrollID);
+            if (pszScrollID)
+                poSlice->osScrollID = pszScrollID;
+        }
+
+        json_object *poHits = CPL_json_object_object_get(poResponse, "hits");
+        if (poHits && json_object_get_type(poHits) == json_type_object)
+            poHits = CPL_json_object_object_get(poHits, "hits");
+        if (poHits == nullptr ||
+            json_object_get_type(poHits) != json_type_array ||
+            json_object_array_length(poHits) == 0)
+        {
+            poSlice->osScrollID.clear();
+            poSlice->bEOF = true;
+            json_object_put(poResponse);
+            continue;
+        }
+        BuildFeaturesFromHits(poHits);
+        json_object_put(poResponse);
+
+        // Fetch the next batch of this slice while the current one is read
+        if (poSlice->osScrollID.empty())
+        {
+            poSlice->bEOF = true;
+        }
+        else
+        {
+            poSlice->osRequest =
+                CPLSPrintf("%s/_search/scroll?scroll=1m&scroll_id=%s",
+                           m_poDS->GetURL(), poSlice->osScrollID.c_str());
+            if (m_bAddPretty)
+                poSlice->osRequest += "&pretty";
+            poSlice->osPostData.clear();
+            poSlice->bDone = false;
+            if (!m_poThreadPool->SubmitJob(ScrollSliceJob, poSlice.get()))
+                poSlice->bEOF = true;
+        }
+
+        if (!m_apoCachedFeatures.empty())
+        {
+            OGRFeature *poRet = m_apoCachedFeatures[0];
+            m_apoCachedFeatures[0] = nullptr;
+            m_iCurFeatureInPage++;
+            m_nReadFeaturesSinceResetReading++;
+            return poRet;
+        }
+    }
+}
+
+/************************************************************************/
+/*                         ClearScrollSlices()                          */
+/************************************************************************/
+
+void OGRElasticLayer::ClearScrollSlices()
+{
+    if (m_apoScrollSlices.empty())
+        return;
+    m_poThreadPool->WaitCompletion();
+    for (const auto &poSlice : m_apoScrollSlices)
+    {
+        if (poSlice->poResponse)
+        {
+            json_object *poScrollID =
+                CPL_json_object_object_get(poSlice->poResponse, "_scroll_id");
+            if (poScrollID && json_object_get_string(poScrollID))
+                poSlice->osScrollID = json_object_get_string(poScrollID);
+        }
+        if (!poSlice->osScrollID.empty())
+        {
+            char **papszOptions =
+                CSLAddNameValue(nullptr, "CUSTOMREQUEST", "DELETE");
+            CPLHTTPResult *psResult = m_poDS->HTTPFetch(
+                (m_poDS->GetURL() + CPLString("/_search/scroll?scroll_id=") +
+                 poSlice->osScrollID)
+                    .c_str(),
+                papszOptions);
+            CSLDestroy(papszOptions);
+            CPLHTTPDestroyResult(psResult);
+        }
+    }
+    m_apoScrollSlices.clear();
+    m_iCurScrollSlice = 0;
 }
 
 /************************************************************************/
@@ -2706,7 +2936,7 @@ OGRErr OGRElasticLayer::ICreateFeature(OGRFeature *poFeature)
         // Only push the data if we are over our bulk upload limit
         if ((int)m_osBulkContent.length() > m_nBulkUpload)
         {
-            if (!PushIndex())
+            if (!PushIndex(/* bWaitCompletion = */ false))
             {
                 return OGRERR_FAILURE;
             }
@@ -2845,7 +3075,7 @@ OGRErr OGRElasticLayer::IUpsertFeature(OGRFeature *poFeature)
         // Only push the data if we are over our bulk upload limit
         if (m_osBulkContent.length() > static_cast<size_t>(m_nBulkUpload))
         {
-            if (!PushIndex())
+            if (!PushIndex(/* bWaitCompletion = */ false))
             {
                 return OGRERR_FAILURE;
             }
@@ -2880,11 +3110,29 @@ OGRErr OGRElasticLayer::IUpsertFeature(OGRFeature *poFeature)
 /*                             PushIndex()                              */
 /************************************************************************/
 
-bool OGRElasticLayer::PushIndex()
+// When MAX_CONNECTIONS > 1, the _bulk request is run by a worker thread,
+// and up to MAX_CONNECTIONS requests may be in flight when bWaitCompletion
+// is false.
+bool OGRElasticLayer::PushIndex(bool bWaitCompletion)
 {
     if (m_osBulkContent.empty())
     {
-        return true;
+        return WaitBulkRequests(0);
+    }
+
+    if (m_poDS->m_nMaxConnections > 1 && GetThreadPool() != nullptr)
+    {
+        auto poRequest = std::make_unique<OGRElasticBulkRequest>();
+        poRequest->poDS = m_poDS;
+        poRequest->osContent = std::move(m_osBulkContent);
+        m_osBulkContent.clear();
+        if (m_poThreadPool->SubmitJob(BulkRequestJob, poRequest.get()))
+        {
+            m_apoPendingBulkRequests.push_back(std::move(poRequest));
+            return WaitBulkRequests(
+                bWaitCompletion ? 0 : m_poDS->m_nMaxConnections - 1);
+        }
+        m_osBulkContent = std::move(poRequest->osContent);
     }
 
     const bool bRet = m_poDS->UploadFile(
@@ -2894,6 +3142,70 @@ bool OGRElasticLayer::PushIndex()
     return bRet;
 }
 
+/************************************************************************/
+/*                           GetThreadPool()                            */
+/************************************************************************/
+
+CPLWorkerThreadPool *OGRElasticLayer::GetThreadPool()
+{
+    if (!m_poThreadPool)
+    {
+        m_poThreadPool = std::make_unique<CPLWorkerThreadPool>();
+        if (!m_poThreadPool->Setup(m_poDS->m_nMaxConnections, nullptr,
+                                   nullptr))
+        {
+            m_poThreadPool.reset();
+            m_poDS->m_nMaxConnections = 1;
+        }
+    }
+    return m_poThreadPool.get();
+}
+
+/************************************************************************/
+/*                           BulkRequestJob()                           */
+/************************************************************************/
+
+void OGRElasticLayer::BulkRequestJob(void *pData)
+{
+    OGRElasticBulkRequest *psRequest =
+        static_cast<OGRElasticBulkRequest *>(pData);
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    CPLErrorReset();
+    psRequest->bOK = psRequest->poDS->UploadFile(
+        CPLSPrintf("%s/_bulk", psRequest->poDS->GetURL()),
+        psRequest->osContent);
+    if (!psRequest->bOK)
+        psRequest->osErrorMsg = CPLGetLastErrorMsg();
+    CPLPopErrorHandler();
+    psRequest->osContent.clear();
+    psRequest->bDone = true;
+}
+
+/************************************************************************/
+/*                          WaitBulkRequests()                          */
+/************************************************************************/
+
+// Wait until at most nMaxRemaining _bulk requests are in flight, and report
+// the errors of the completed ones.
+bool OGRElasticLayer::WaitBulkRequests(size_t nMaxRemaining)
+{
+    bool bRet = true;
+    while (m_apoPendingBulkRequests.size() > nMaxRemaining)
+    {
+        auto poRequest = std::move(m_apoPendingBulkRequests.front());
+        m_apoPendingBulkRequests.pop_front();
+        while (!poRequest->bDone)
+            m_poThreadPool->WaitEvent();
+        if (!poRequest->bOK)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "%s",
+                     poRequest->osErrorMsg.c_str());
+            bRet = false;
+        }
+    }
+    return bRet;
+}
+
 /************************************************************************/
 /*                            CreateField()                             */
 /************************************************************************/
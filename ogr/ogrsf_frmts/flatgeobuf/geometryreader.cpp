@@ -512,3 +512,193 @@ OGRGeometry *GeometryReader::read()
     }
     return nullptr;
 }
+
+size_t GeometryReader::getDirectWkbSize() const
+{
+    switch (m_geometryType)
+    {
+        case GeometryType::Point:
+        case GeometryType::MultiPoint:
+        case GeometryType::LineString:
+        case GeometryType::MultiLineString:
+        case GeometryType::Polygon:
+            break;
+        default:
+            return 0;
+    }
+
+    // Anything read() would reject, or where it would not build a geometry
+    // with the Z/M flags of the layer (empty collections), is left to it.
+    const auto pXy = m_geometry->xy();
+    if (pXy == nullptr || (pXy->size() % 2) != 0 ||
+        pXy->size() >= feature_max_buffer_size / sizeof(OGRRawPoint))
+        return 0;
+    const uint32_t nPoints = pXy->size() / 2;
+    if (nPoints == 0)
+        return 0;
+    if (m_hasZ &&
+        (m_geometry->z() == nullptr || m_geometry->z()->size() < nPoints))
+        return 0;
+    if (m_hasM &&
+        (m_geometry->m() == nullptr || m_geometry->m()->size() < nPoints))
+        return 0;
+
+    const size_t nPointSize =
+        sizeof(double) * (2 + (m_hasZ ? 1 : 0) + (m_hasM ? 1 : 0));
+    constexpr size_t HEADER_SIZE = 1 + sizeof(uint32_t);
+    const auto pEnds = m_geometry->ends();
+    switch (m_geometryType)
+    {
+        case GeometryType::Point:
+            return nPoints == 1 ? HEADER_SIZE + nPointSize : 0;
+
+        case GeometryType::MultiPoint:
+            return HEADER_SIZE + sizeof(uint32_t) +
+                   nPoints * (HEADER_SIZE + nPointSize);
+
+        case GeometryType::LineString:
+            return HEADER_SIZE + sizeof(uint32_t) + nPoints * nPointSize;
+
+        case GeometryType::Polygon:
+            if (pEnds == nullptr || pEnds->size() < 2)
+                return HEADER_SIZE + 2 * sizeof(uint32_t) +
+                       nPoints * nPointSize;
+            [[fallthrough]];
+
+        case GeometryType::MultiLineString:
+        {
+            if (pEnds == nullptr || pEnds->size() == 0)
+                return 0;
+            const bool bIsPolygon = m_geometryType == GeometryType::Polygon;
+            size_t nSize = HEADER_SIZE + sizeof(uint32_t);
+            uint32_t nStart = 0;
+            for (uint32_t i = 0; i < pEnds->size(); i++)
+            {
+                const uint32_t nEnd = pEnds->Get(i);
+                if (nEnd < nStart || nEnd > nPoints)
+                    return 0;
+                nSize += (bIsPolygon ? 0 : HEADER_SIZE) + sizeof(uint32_t) +
+                         (nEnd - nStart) * nPointSize;
+                nStart = nEnd;
+            }
+            // read() rejects polygons with only empty rings
+            if (bIsPolygon && nStart == 0)
+                return 0;
+            return nSize;
+        }
+
+        default:
+            break;
+    }
+    return 0;
+}
+
+void GeometryReader::writeDirectWkb(GByte *pabyWkb) const
+{
+    const uint32_t nZMOffset = (m_hasZ ? 1000 : 0) + (m_hasM ? 2000 : 0);
+    const auto pXy = m_geometry->xy();
+    const uint32_t nPoints = pXy->size() / 2;
+    const double *padfXY = pXy->data();
+    const double *padfZ = m_hasZ ? m_geometry->z()->data() : nullptr;
+    const double *padfM = m_hasM ? m_geometry->m()->data() : nullptr;
+
+    const auto writeUInt32 = [&pabyWkb](uint32_t nVal)
+    {
+        CPL_LSBPTR32(&nVal);
+        memcpy(pabyWkb, &nVal, sizeof(nVal));
+        pabyWkb += sizeof(nVal);
+    };
+    const auto writeHeader = [&pabyWkb, &writeUInt32, nZMOffset](
+                                 OGRwkbGeometryType eType)
+    {
+        *pabyWkb = wkbNDR;
+        ++pabyWkb;
+        writeUInt32(static_cast<uint32_t>(eType) + nZMOffset);
+    };
+    const auto writeDouble = [&pabyWkb](double dfVal)
+    {
+        dfVal = EndianScalar(dfVal);
+        CPL_LSBPTR64(&dfVal);
+        memcpy(pabyWkb, &dfVal, sizeof(dfVal));
+        pabyWkb += sizeof(dfVal);
+    };
+    const auto writePoints = [&](uint32_t nStart, uint32_t nEnd)
+    {
+#if CPL_IS_LSB
+        if (!m_hasZ && !m_hasM)
+        {
+            const size_t nBytes = (nEnd - nStart) * sizeof(OGRRawPoint);
+            memcpy(pabyWkb, padfXY + 2 * nStart, nBytes);
+            pabyWkb += nBytes;
+            return;
+        }
+#endif
+        for (uint32_t i = nStart; i < nEnd; i++)
+        {
+            writeDouble(padfXY[2 * i + 0]);
+            writeDouble(padfXY[2 * i + 1]);
+            if (padfZ)
+                writeDouble(padfZ[i]);
+            if (padfM)
+                writeDouble(padfM[i]);
+        }
+    };
+
+    const auto pEnds = m_geometry->ends();
+    switch (m_geometryType)
+    {
+        case GeometryType::Point:
+            writeHeader(wkbPoint);
+            writePoints(0, 1);
+            break;
+
+        case GeometryType::MultiPoint:
+            writeHeader(wkbMultiPoint);
+            writeUInt32(nPoints);
+            for (uint32_t i = 0; i < nPoints; i++)
+            {
+                writeHeader(wkbPoint);
+                writePoints(i, i + 1);
+            }
+            break;
+
+        case GeometryType::LineString:
+            writeHeader(wkbLineString);
+            writeUInt32(nPoints);
+            writePoints(0, nPoints);
+            break;
+
+        case GeometryType::Polygon:
+            writeHeader(wkbPolygon);
+            if (pEnds == nullptr || pEnds->size() < 2)
+            {
+                writeUInt32(1);
+                writeUInt32(nPoints);
+                writePoints(0, nPoints);
+                break;
+            }
+            [[fallthrough]];
+
+        case GeometryType::MultiLineString:
+        {
+            const bool bIsPolygon = m_geometryType == GeometryType::Polygon;
+            if (!bIsPolygon)
+                writeHeader(wkbMultiLineString);
+            writeUInt32(pEnds->size());
+            uint32_t nStart = 0;
+            for (uint32_t i = 0; i < pEnds->size(); i++)
+            {
+                const uint32_t nEnd = pEnds->Get(i);
+                if (!bIsPolygon)
+                    writeHeader(wkbLineString);
+                writeUInt32(nEnd - nStart);
+                writePoints(nStart, nEnd);
+                nStart = nEnd;
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
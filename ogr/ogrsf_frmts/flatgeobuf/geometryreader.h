@@ -101,6 +101,12 @@ class GeometryReader
     {
     }
     OGRGeometry *read();
+
+    // Direct ISO WKB encoding of Point, MultiPoint, LineString,
+    // MultiLineString and Polygon, without building a OGRGeometry.
+    // getDirectWkbSize() returns 0 if the geometry is not eligible.
+    size_t getDirectWkbSize() const;
+    void writeDirectWkb(GByte *pabyWkb) const;
 };
 
 }  // namespace ogr_flatgeobuf
@@ -99,6 +99,13 @@ class OGRFlatGeobufLayer final : public OGRLayer,
     std::vector<FlatGeobuf::SearchResultItem>
         m_foundItems;  // found node items in spatial index search
     bool m_queriedSpatialIndex = false;
+    // Batched range reading of spatial index search results (remote files)
+    bool m_bUseMultiRangeRead = false;
+    std::vector<uint32_t>
+        m_foundItemSizes{};  // size of found features, 0 if unknown
+    std::vector<GByte> m_abyPrefetchBuffer{};
+    std::vector<size_t> m_anPrefetchItemOffsets{};
+    size_t m_nPrefetchFirstItem = 0;
     bool m_ignoreSpatialFilter = false;
     bool m_ignoreAttributeFilter = false;
 
@@ -107,6 +114,11 @@ class OGRFlatGeobufLayer final : public OGRLayer,
     bool m_create = false;
     std::deque<FeatureItem> m_featureItems;  // feature item description used to
                                              // create spatial index
+    // When the number of features exceeds m_nMaxFeatureItemsInMemory, feature
+    // items are spilled to a temporary file, and sorted externally at close.
+    size_t m_nMaxFeatureItemsInMemory = 0;
+    VSILFILE *m_poFpItems = nullptr;
+    uint64_t m_nSpilledFeatureItems = 0;
     bool m_bCreateSpatialIndexAtClose = true;
     bool m_bVerifyBuffers = true;
     VSILFILE *m_poFpWrite = nullptr;
@@ -133,12 +145,19 @@ class OGRFlatGeobufLayer final : public OGRLayer,
     writeColumns(flatbuffers::FlatBufferBuilder &fbb);
     void readColumns();
     OGRErr readIndex();
+    std::vector<FlatGeobuf::SearchResultItem>
+    searchIndexMultiRange(uint64_t treeOffset, const FlatGeobuf::NodeItem &n);
+    bool prefetchFeatures();
+    bool readPrefetchedFeature(uint32_t &featureSize);
     OGRErr readFeatureOffset(uint64_t index, uint64_t &featureOffset);
 
     // serialize
     bool CreateFinalFile();
+    bool SpillFeatureItems();
+    bool CreateFinalFileExternalSort(uint64_t nTempFileSize);
     void writeHeader(VSILFILE *poFp, uint64_t featuresCount,
                      std::vector<double> *extentVector);
+    OGRErr writeFeature(const OGRGeometry *ogrGeometry);
 
     // construction
     OGRFlatGeobufLayer(const FlatGeobuf::Header *, GByte *headerBuf,
@@ -175,6 +194,9 @@ class OGRFlatGeobufLayer final : public OGRLayer,
     virtual OGRErr CreateField(const OGRFieldDefn *poField,
                                int bApproxOK = true) override;
     virtual OGRErr ICreateFeature(OGRFeature *poFeature) override;
+    virtual bool WriteArrowBatch(const struct ArrowSchema *schema,
+                                 struct ArrowArray *array,
+                                 CSLConstList papszOptions = nullptr) override;
     virtual int TestCapability(const char *) override;
 
     virtual void ResetReading() override;
@@ -34,6 +34,7 @@
 #include "cpl_time.h"
 #include "ogr_p.h"
 #include "ograrrowarrayhelper.h"
+#include "ogrlayerarrow.h"
 #include "ogr_recordbatch.h"
 
 #include "ogr_flatgeobuf.h"
@@ -44,7 +45,9 @@
 #include <algorithm>
 #include <limits>
 #include <new>
+#include <queue>
 #include <stdexcept>
+#include <thread>
 
 using namespace flatbuffers;
 using namespace FlatGeobuf;
@@ -215,6 +218,22 @@ OGRFlatGeobufLayer::OGRFlatGeobufLayer(
     if (poSpatialRef)
         m_poSRS = poSpatialRef->Clone();
 
+    if (m_bCreateSpatialIndexAtClose)
+    {
+        // Memory used to sort feature items by Hilbert value. Beyond it,
+        // an external sort is done.
+        const char *pszMaxSortMemory =
+            CPLGetConfigOption("OGR_FLATGEOBUF_MAX_SORT_MEMORY", nullptr);
+        GIntBig nMaxSortMemory =
+            pszMaxSortMemory ? CPLAtoGIntBig(pszMaxSortMemory)
+                             : CPLGetUsablePhysicalRAM() / 4;
+        if (nMaxSortMemory <= 0)
+            nMaxSortMemory = static_cast<GIntBig>(1024) * 1024 * 1024;
+        m_nMaxFeatureItemsInMemory = static_cast<size_t>(std::max<GIntBig>(
+            1, std::min<GIntBig>(std::numeric_limits<int32_t>::max(),
+                                 nMaxSortMemory / sizeof(FeatureItem))));
+    }
+
     CPLDebugOnly("FlatGeobuf", "geometryType: %d, hasZ: %d, hasM: %d, hasT: %d",
                  (int)m_geometryType, m_hasZ, m_hasM, m_hasT);
 
@@ -597,6 +616,9 @@ bool OGRFlatGeobufLayer::CreateFinalFile()
     m_writeOffset = 0;
     m_indexNodeSize = 16;
 
+    if (m_poFpItems)
+        return CreateFinalFileExternalSort(nTempFileSize);
+
     size_t c;
 
     if (m_featuresCount >= std::numeric_limits<size_t>::max() / 8)
@@ -786,6 +808,453 @@ bool OGRFlatGeobufLayer::CreateFinalFile()
     return true;
 }
 
+/************************************************************************/
+/*                          SpillFeatureItems()                         */
+/************************************************************************/
+
+// Appends the in-memory feature items to a temporary file, to bound the
+// memory used when writing a file with a spatial index.
+
+bool OGRFlatGeobufLayer::SpillFeatureItems()
+{
+    if (m_poFpItems == nullptr)
+    {
+        const std::string osItemsFile = m_osTempFile + ".items";
+        m_poFpItems = VSIFOpenL(osItemsFile.c_str(), "w+b");
+        if (m_poFpItems == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_OpenFailed, "Failed to create %s",
+                     osItemsFile.c_str());
+            return false;
+        }
+        VSIUnlink(osItemsFile.c_str());
+        CPLDebug("FlatGeobuf",
+                 "More than %u features: using external sort for the "
+                 "spatial index",
+                 static_cast<unsigned>(m_nMaxFeatureItemsInMemory));
+    }
+    for (const auto &item : m_featureItems)
+    {
+        if (VSIFWriteL(&item, sizeof(item), 1, m_poFpItems) != 1)
+        {
+            CPLErrorIO("writing temporary feature items");
+            return false;
+        }
+    }
+    m_nSpilledFeatureItems += m_featureItems.size();
+    m_featureItems.clear();
+    return true;
+}
+
+/************************************************************************/
+/*                     CreateFinalFileExternalSort()                    */
+/************************************************************************/
+
+namespace
+{
+struct HilbertSortItem
+{
+    uint32_t hilbertValue;
+    FeatureItem item;
+};
+
+// Feature items sorted by Hilbert value in a temporary file
+struct HilbertSortRun
+{
+    uint64_t nextIdx;
+    uint64_t endIdx;
+    std::vector<HilbertSortItem> buffer{};
+    size_t posInBuffer = 0;
+};
+}  // namespace
+
+// Same result as CreateFinalFile(), but with bounded memory usage:
+// - feature items are read from the spill file by chunks, which are sorted
+//   by Hilbert value by several threads, and written as sorted runs.
+// - runs are merged, which gives the leaf nodes of the packed R-tree and the
+//   order in which features must be written. Only the upper levels of the
+//   tree (about 1/15 of its size) are held in memory.
+
+bool OGRFlatGeobufLayer::CreateFinalFileExternalSort(uint64_t nTempFileSize)
+{
+    if (!SpillFeatureItems())
+        return false;
+
+    const uint64_t nItems = m_nSpilledFeatureItems;
+    const uint16_t nodeSize = m_indexNodeSize;
+    NodeItem extent{m_sExtent.MinX, m_sExtent.MinY, m_sExtent.MaxX,
+                    m_sExtent.MaxY, 0};
+    auto extentVector = extent.toVector();
+    writeHeader(m_poFp, m_featuresCount, &extentVector);
+
+    const auto CreateTempFile = [this](const char *pszSuffix)
+    {
+        const std::string osFilename = m_osTempFile + pszSuffix;
+        VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "w+b");
+        if (fp == nullptr)
+            CPLError(CE_Failure, CPLE_OpenFailed, "Failed to create %s",
+                     osFilename.c_str());
+        else
+            VSIUnlink(osFilename.c_str());
+        return std::unique_ptr<VSILFILE, decltype(&VSIFCloseL)>(fp,
+                                                                VSIFCloseL);
+    };
+
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    int nThreads = CPLGetNumCPUs();
+    if (pszNumThreads && !EQUAL(pszNumThreads, "ALL_CPUS"))
+        nThreads = std::max(1, std::min(atoi(pszNumThreads), nThreads));
+
+    /* -------------------------------------------------------------------- */
+    /*      Create sorted runs.                                             */
+    /* -------------------------------------------------------------------- */
+    auto fpRuns = CreateTempFile(".runs");
+    if (!fpRuns)
+        return false;
+    const double minX = extent.minX;
+    const double minY = extent.minY;
+    const double width = extent.width();
+    const double height = extent.height();
+    const auto sortFunc = [](const HilbertSortItem &a, const HilbertSortItem &b)
+    { return a.hilbertValue > b.hilbertValue; };
+    std::vector<HilbertSortRun> runs;
+    {
+        const size_t nChunkSize = std::max<size_t>(
+            1, m_nMaxFeatureItemsInMemory * sizeof(FeatureItem) /
+                   sizeof(HilbertSortItem));
+        std::vector<HilbertSortItem> chunk;
+        try
+        {
+            chunk.resize(static_cast<size_t>(
+                std::min(static_cast<uint64_t>(nChunkSize), nItems)));
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate sort buffer");
+            return false;
+        }
+        VSIFSeekL(m_poFpItems, 0, SEEK_SET);
+        for (uint64_t iStart = 0; iStart < nItems; iStart += chunk.size())
+        {
+            const size_t nCount = static_cast<size_t>(
+                std::min(static_cast<uint64_t>(chunk.size()), nItems - iStart));
+            for (size_t i = 0; i < nCount; ++i)
+            {
+                auto &sortItem = chunk[i];
+                if (VSIFReadL(&sortItem.item, sizeof(sortItem.item), 1,
+                              m_poFpItems) != 1)
+                {
+                    CPLErrorIO("reading temporary feature items");
+                    return false;
+                }
+                sortItem.hilbertValue =
+                    hilbert(sortItem.item.nodeItem, HILBERT_MAX, minX, minY,
+                            width, height);
+            }
+
+            // Sort slices of the chunk in parallel. Each slice is a run.
+            const size_t nSlices = std::max<size_t>(
+                1, std::min(static_cast<size_t>(nThreads), nCount / 4096));
+            const size_t nSliceSize = (nCount + nSlices - 1) / nSlices;
+            std::vector<std::thread> threads;
+            for (size_t iSlice = 0; iSlice < nSlices; ++iSlice)
+            {
+                const size_t nSliceStart = iSlice * nSliceSize;
+                const size_t nSliceEnd =
+                    std::min(nCount, nSliceStart + nSliceSize);
+                HilbertSortRun run;
+                run.nextIdx = iStart + nSliceStart;
+                run.endIdx = iStart + nSliceEnd;
+                runs.emplace_back(std::move(run));
+                const auto sortSlice = [&chunk, &sortFunc, nSliceStart,
+                                        nSliceEnd]()
+                {
+                    std::sort(chunk.begin() + nSliceStart,
+                              chunk.begin() + nSliceEnd, sortFunc);
+                };
+                if (iSlice + 1 == nSlices)
+                    sortSlice();
+                else
+                    threads.emplace_back(sortSlice);
+            }
+            for (auto &thread : threads)
+                thread.join();
+
+            if (VSIFWriteL(chunk.data(), sizeof(HilbertSortItem), nCount,
+                           fpRuns.get()) != nCount)
+            {
+                CPLErrorIO("writing temporary sorted runs");
+                return false;
+            }
+        }
+    }
+    VSIFCloseL(m_poFpItems);
+    m_poFpItems = nullptr;
+    CPLDebugOnly("FlatGeobuf", "%u sorted runs created",
+                 static_cast<unsigned>(runs.size()));
+
+    /* -------------------------------------------------------------------- */
+    /*      Merge runs. Write leaf nodes and the order of features to       */
+    /*      temporary files, and compute the first level of parent nodes.   */
+    /* -------------------------------------------------------------------- */
+    std::vector<std::pair<uint64_t, uint64_t>> levelBounds;
+    std::vector<NodeItem> upperNodes;
+    try
+    {
+        levelBounds = PackedRTree::generateLevelBounds(nItems, nodeSize);
+        upperNodes.resize(static_cast<size_t>(levelBounds.front().first));
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Create: %s", e.what());
+        return false;
+    }
+    auto fpLeaves = CreateTempFile(".leaves");
+    auto fpOrder = CreateTempFile(".order");
+    if (!fpLeaves || !fpOrder)
+        return false;
+    {
+        const size_t nRunBufferSize = std::max<size_t>(
+            1, std::min<size_t>(4096, m_nMaxFeatureItemsInMemory *
+                                          sizeof(FeatureItem) /
+                                          sizeof(HilbertSortItem) /
+                                          runs.size()));
+        const auto fillBuffer = [&fpRuns, nRunBufferSize](HilbertSortRun &run)
+        {
+            const size_t nCount = static_cast<size_t>(
+                std::min(static_cast<uint64_t>(nRunBufferSize),
+                         run.endIdx - run.nextIdx));
+            run.buffer.resize(nCount);
+            run.posInBuffer = 0;
+            if (VSIFSeekL(fpRuns.get(), run.nextIdx * sizeof(HilbertSortItem),
+                          SEEK_SET) != 0 ||
+                VSIFReadL(run.buffer.data(), sizeof(HilbertSortItem), nCount,
+                          fpRuns.get()) != nCount)
+            {
+                CPLErrorIO("reading temporary sorted runs");
+                return false;
+            }
+            run.nextIdx += nCount;
+            return true;
+        };
+
+        // Max-heap on Hilbert value, as hilbertSort() sorts by decreasing
+        // value.
+        std::priority_queue<std::pair<uint32_t, size_t>> queue;
+        for (size_t iRun = 0; iRun < runs.size(); ++iRun)
+        {
+            if (!fillBuffer(runs[iRun]))
+                return false;
+            queue.emplace(runs[iRun].buffer[0].hilbertValue, iRun);
+        }
+
+        std::vector<NodeItem> leavesBuffer;
+        std::vector<uint64_t> orderBuffer;
+        constexpr size_t BUFFER_SIZE = 4096;
+        const auto flushBuffers = [&]()
+        {
+#if !CPL_IS_LSB
+            for (auto &node : leavesBuffer)
+            {
+                CPL_LSBPTR64(&node.minX);
+                CPL_LSBPTR64(&node.minY);
+                CPL_LSBPTR64(&node.maxX);
+                CPL_LSBPTR64(&node.maxY);
+                CPL_LSBPTR64(&node.offset);
+            }
+#endif
+            if (VSIFWriteL(leavesBuffer.data(), sizeof(NodeItem),
+                           leavesBuffer.size(),
+                           fpLeaves.get()) != leavesBuffer.size() ||
+                VSIFWriteL(orderBuffer.data(), sizeof(uint64_t),
+                           orderBuffer.size(),
+                           fpOrder.get()) != orderBuffer.size())
+            {
+                CPLErrorIO("writing temporary index");
+                return false;
+            }
+            leavesBuffer.clear();
+            orderBuffer.clear();
+            return true;
+        };
+
+        const uint64_t leafNodesOffset = levelBounds[0].first;
+        const uint64_t parentNodesOffset = levelBounds[1].first;
+        uint64_t featureOffset = 0;
+        uint64_t iLeaf = 0;
+        while (!queue.empty())
+        {
+            const size_t iRun = queue.top().second;
+            queue.pop();
+            auto &run = runs[iRun];
+            const FeatureItem &item = run.buffer[run.posInBuffer].item;
+
+            NodeItem leaf = item.nodeItem;
+            leaf.offset = featureOffset;
+            featureOffset += item.size;
+
+            auto &parent = upperNodes[static_cast<size_t>(
+                parentNodesOffset + iLeaf / nodeSize)];
+            if ((iLeaf % nodeSize) == 0)
+                parent = NodeItem::create(leafNodesOffset + iLeaf);
+            parent.expand(leaf);
+            ++iLeaf;
+
+            leavesBuffer.push_back(leaf);
+            orderBuffer.push_back(item.offset);
+            orderBuffer.push_back(item.size);
+            if (leavesBuffer.size() == BUFFER_SIZE && !flushBuffers())
+                return false;
+
+            ++run.posInBuffer;
+            if (run.posInBuffer == run.buffer.size())
+            {
+                if (run.nextIdx == run.endIdx)
+                {
+                    run.buffer = std::vector<HilbertSortItem>();
+                    continue;
+                }
+                if (!fillBuffer(run))
+                    return false;
+            }
+            queue.emplace(run.buffer[run.posInBuffer].hilbertValue, iRun);
+        }
+        if (!flushBuffers())
+            return false;
+    }
+    runs.clear();
+    fpRuns.reset();
+
+    /* -------------------------------------------------------------------- */
+    /*      Compute the other levels of the tree, and write it.             */
+    /* -------------------------------------------------------------------- */
+    for (size_t i = 1; i + 1 < levelBounds.size(); i++)
+    {
+        auto pos = levelBounds[i].first;
+        const auto end = levelBounds[i].second;
+        auto newpos = levelBounds[i + 1].first;
+        while (pos < end)
+        {
+            NodeItem node = NodeItem::create(pos);
+            for (uint32_t j = 0; j < nodeSize && pos < end; j++)
+                node.expand(upperNodes[static_cast<size_t>(pos++)]);
+            upperNodes[static_cast<size_t>(newpos++)] = node;
+        }
+    }
+#if !CPL_IS_LSB
+    for (auto &node : upperNodes)
+    {
+        CPL_LSBPTR64(&node.minX);
+        CPL_LSBPTR64(&node.minY);
+        CPL_LSBPTR64(&node.maxX);
+        CPL_LSBPTR64(&node.maxY);
+        CPL_LSBPTR64(&node.offset);
+    }
+#endif
+    if (VSIFWriteL(upperNodes.data(), sizeof(NodeItem), upperNodes.size(),
+                   m_poFp) != upperNodes.size())
+    {
+        CPLErrorIO("writing index");
+        return false;
+    }
+    m_writeOffset += upperNodes.size() * sizeof(NodeItem);
+    upperNodes = std::vector<NodeItem>();
+
+    const uint32_t nMaxBufferSize = std::max(
+        m_maxFeatureSize,
+        static_cast<uint32_t>(std::min(
+            static_cast<uint64_t>(100 * 1024 * 1024), nTempFileSize)));
+    if (ensureFeatureBuf(nMaxBufferSize) != OGRERR_NONE)
+        return false;
+
+    VSIFSeekL(fpLeaves.get(), 0, SEEK_SET);
+    while (true)
+    {
+        const size_t nRead =
+            VSIFReadL(m_featureBuf, 1, m_featureBufSize, fpLeaves.get());
+        if (nRead == 0)
+            break;
+        if (VSIFWriteL(m_featureBuf, 1, nRead, m_poFp) != nRead)
+        {
+            CPLErrorIO("writing index");
+            return false;
+        }
+        m_writeOffset += nRead;
+    }
+    fpLeaves.reset();
+    CPLDebugOnly("FlatGeobuf", "Writing feature buffers at offset %lu",
+                 static_cast<long unsigned int>(m_writeOffset));
+
+    /* -------------------------------------------------------------------- */
+    /*      Copy features in their final order, by batches filling the      */
+    /*      feature buffer, read in increasing source offset.               */
+    /* -------------------------------------------------------------------- */
+    struct BatchItem
+    {
+        uint64_t offset;  // in the temporary file
+        uint32_t size;
+        uint32_t offsetInBuffer;
+    };
+    std::vector<BatchItem> batch;
+    uint32_t offsetInBuffer = 0;
+    const auto flushBatch = [this, &batch, &offsetInBuffer]()
+    {
+        std::sort(batch.begin(), batch.end(),
+                  [](const BatchItem &a, const BatchItem &b)
+                  { return a.offset < b.offset; });
+        for (const auto &batchItem : batch)
+        {
+            if (VSIFSeekL(m_poFpWrite, batchItem.offset, SEEK_SET) == -1)
+            {
+                CPLErrorIO("seeking to temp feature location");
+                return false;
+            }
+            if (VSIFReadL(m_featureBuf + batchItem.offsetInBuffer, 1,
+                          batchItem.size, m_poFpWrite) != batchItem.size)
+            {
+                CPLErrorIO("reading temp feature");
+                return false;
+            }
+        }
+        if (offsetInBuffer > 0 &&
+            VSIFWriteL(m_featureBuf, 1, offsetInBuffer, m_poFp) !=
+                offsetInBuffer)
+        {
+            CPLErrorIO("writing feature");
+            return false;
+        }
+        m_writeOffset += offsetInBuffer;
+        batch.clear();
+        offsetInBuffer = 0;
+        return true;
+    };
+
+    VSIFSeekL(fpOrder.get(), 0, SEEK_SET);
+    for (uint64_t i = 0; i < nItems; ++i)
+    {
+        uint64_t anOffsetSize[2];
+        if (VSIFReadL(anOffsetSize, sizeof(anOffsetSize), 1, fpOrder.get()) !=
+            1)
+        {
+            CPLErrorIO("reading temporary index");
+            return false;
+        }
+        const uint32_t featureSize = static_cast<uint32_t>(anOffsetSize[1]);
+        if (offsetInBuffer + featureSize > m_featureBufSize && !flushBatch())
+            return false;
+        batch.push_back({anOffsetSize[0], featureSize, offsetInBuffer});
+        offsetInBuffer += featureSize;
+    }
+    if (!flushBatch())
+        return false;
+
+    CPLDebugOnly("FlatGeobuf", "Now at offset %lu",
+                 static_cast<long unsigned int>(m_writeOffset));
+
+    return true;
+}
+
 OGRFlatGeobufLayer::~OGRFlatGeobufLayer()
 {
     OGRFlatGeobufLayer::Close();
@@ -828,6 +1297,12 @@ CPLErr OGRFlatGeobufLayer::Close()
         m_poFpWrite = nullptr;
     }
 
+    if (m_poFpItems)
+    {
+        VSIFCloseL(m_poFpItems);
+        m_poFpItems = nullptr;
+    }
+
     if (!m_osTempFile.empty())
     {
         VSIUnlink(m_osTempFile.c_str());
@@ -941,16 +1416,34 @@ OGRErr OGRFlatGeobufLayer::readIndex()
                          env.MinX, env.MinY, env.MaxX, env.MaxY);
             const auto treeOffset =
                 sizeof(magicbytes) + sizeof(uoffset_t) + headerSize;
-            const auto readNode =
-                [this, treeOffset](uint8_t *buf, size_t i, size_t s)
+            m_abyPrefetchBuffer.clear();
+            m_anPrefetchItemOffsets.clear();
+            m_nPrefetchFirstItem = 0;
+            m_foundItemSizes.clear();
+            // Network file systems benefit from issuing few requests for
+            // many byte ranges, instead of one request per tree node and
+            // per feature.
+            m_bUseMultiRangeRead = CPLTestBool(CPLGetConfigOption(
+                "OGR_FLATGEOBUF_MULTIRANGE_READ",
+                VSIHasOptimizedReadMultiRange(m_osFilename.c_str()) ? "YES"
+                                                                    : "NO"));
+            if (m_bUseMultiRangeRead)
             {
-                if (VSIFSeekL(m_poFp, treeOffset + i, SEEK_SET) == -1)
-                    throw std::runtime_error("I/O seek failure");
-                if (VSIFReadL(buf, 1, s, m_poFp) != s)
-                    throw std::runtime_error("I/O read file");
-            };
-            m_foundItems = PackedRTree::streamSearch(
-                featuresCount, indexNodeSize, n, readNode);
+                m_foundItems = searchIndexMultiRange(treeOffset, n);
+            }
+            else
+            {
+                const auto readNode =
+                    [this, treeOffset](uint8_t *buf, size_t i, size_t s)
+                {
+                    if (VSIFSeekL(m_poFp, treeOffset + i, SEEK_SET) == -1)
+                        throw std::runtime_error("I/O seek failure");
+                    if (VSIFReadL(buf, 1, s, m_poFp) != s)
+                        throw std::runtime_error("I/O read file");
+                };
+                m_foundItems = PackedRTree::streamSearch(
+                    featuresCount, indexNodeSize, n, readNode);
+            }
             m_featuresCount = m_foundItems.size();
             CPLDebugOnly("FlatGeobuf",
                          "%lu features found in spatial index search",
@@ -969,6 +1462,305 @@ OGRErr OGRFlatGeobufLayer::readIndex()
     return OGRERR_NONE;
 }
 
+/************************************************************************/
+/*                      GetMultiRangeMaxGap()                           */
+/************************************************************************/
+
+// Byte ranges separated by less than this amount are merged into a single
+// range, since fetching a few unneeded bytes is cheaper than an additional
+// range.
+static size_t GetMultiRangeMaxGap()
+{
+    return static_cast<size_t>(std::max(
+        0, atoi(CPLGetConfigOption("OGR_FLATGEOBUF_MULTIRANGE_MAX_GAP",
+                                   "65536"))));
+}
+
+/************************************************************************/
+/*                      searchIndexMultiRange()                         */
+/************************************************************************/
+
+// Equivalent of PackedRTree::streamSearch(), but processing the tree level
+// by level, so that all the nodes to visit in a level are fetched with a
+// single VSIFReadMultiRangeL() call, instead of one read per node.
+// This also deduces the size of the found features from the offset of the
+// next leaf, when available, so that prefetchFeatures() can fetch them.
+std::vector<SearchResultItem>
+OGRFlatGeobufLayer::searchIndexMultiRange(uint64_t treeOffset,
+                                          const NodeItem &n)
+{
+    const auto featuresCount = m_poHeader->features_count();
+    const auto indexNodeSize = m_poHeader->index_node_size();
+    const auto levelBounds =
+        PackedRTree::generateLevelBounds(featuresCount, indexNodeSize);
+    const size_t nMaxGap = GetMultiRangeMaxGap();
+
+    std::vector<SearchResultItem> results;
+    std::vector<uint64_t> anNodeIndices{0};
+    std::vector<NodeItem> nodeItems;
+    for (size_t level = levelBounds.size();
+         level > 0 && !anNodeIndices.empty();)
+    {
+        --level;
+        const uint64_t nLevelStart = levelBounds[level].first;
+        const uint64_t nLevelEnd = levelBounds[level].second;
+        const bool isLeafLevel = level == 0;
+
+        std::sort(anNodeIndices.begin(), anNodeIndices.end());
+        anNodeIndices.erase(
+            std::unique(anNodeIndices.begin(), anNodeIndices.end()),
+            anNodeIndices.end());
+
+        // Coalesce the [start, end[ node ranges to read
+        std::vector<std::pair<uint64_t, uint64_t>> aoRanges;
+        for (const uint64_t nodeIndex : anNodeIndices)
+        {
+            if (nodeIndex < nLevelStart || nodeIndex >= nLevelEnd)
+                throw std::runtime_error("Invalid node index");
+            const uint64_t end =
+                std::min<uint64_t>(nodeIndex + indexNodeSize, nLevelEnd);
+            if (!aoRanges.empty() &&
+                (nodeIndex <= aoRanges.back().second ||
+                 (nodeIndex - aoRanges.back().second) * sizeof(NodeItem) <=
+                     nMaxGap))
+            {
+                aoRanges.back().second = std::max(aoRanges.back().second, end);
+            }
+            else
+            {
+                aoRanges.emplace_back(nodeIndex, end);
+            }
+        }
+
+        std::vector<size_t> anRangeItemStart;
+        size_t nItems = 0;
+        for (const auto &oRange : aoRanges)
+        {
+            anRangeItemStart.push_back(nItems);
+            nItems += static_cast<size_t>(oRange.second - oRange.first);
+        }
+        nodeItems.resize(nItems);
+
+        std::vector<void *> apData;
+        std::vector<vsi_l_offset> anOffsets;
+        std::vector<size_t> anSizes;
+        for (size_t i = 0; i < aoRanges.size(); ++i)
+        {
+            apData.push_back(&nodeItems[anRangeItemStart[i]]);
+            anOffsets.push_back(treeOffset +
+                                aoRanges[i].first * sizeof(NodeItem));
+            anSizes.push_back(static_cast<size_t>(
+                (aoRanges[i].second - aoRanges[i].first) * sizeof(NodeItem)));
+        }
+        if (VSIFReadMultiRangeL(static_cast<int>(aoRanges.size()),
+                                apData.data(), anOffsets.data(), anSizes.data(),
+                                m_poFp) != 0)
+        {
+            throw std::runtime_error("I/O read failure");
+        }
+#if !CPL_IS_LSB
+        for (auto &nodeItem : nodeItems)
+        {
+            CPL_LSBPTR64(&nodeItem.minX);
+            CPL_LSBPTR64(&nodeItem.minY);
+            CPL_LSBPTR64(&nodeItem.maxX);
+            CPL_LSBPTR64(&nodeItem.maxY);
+            CPL_LSBPTR64(&nodeItem.offset);
+        }
+#endif
+
+        // Search through the child nodes of the visited nodes, skipping
+        // the items only read to fill gaps.
+        std::vector<uint64_t> anNextNodeIndices;
+        size_t iRange = 0;
+        uint64_t nMinPos = 0;  // to skip overlapping nodes of corrupted trees
+        for (const uint64_t nodeIndex : anNodeIndices)
+        {
+            while (nodeIndex >= aoRanges[iRange].second)
+                ++iRange;
+            const uint64_t rangeEnd = aoRanges[iRange].second;
+            const size_t iFirstItem =
+                anRangeItemStart[iRange] +
+                static_cast<size_t>(nodeIndex - aoRanges[iRange].first);
+            const uint64_t end =
+                std::min<uint64_t>(nodeIndex + indexNodeSize, nLevelEnd);
+            for (uint64_t pos = std::max(nodeIndex, nMinPos); pos < end; ++pos)
+            {
+                const size_t iItem =
+                    iFirstItem + static_cast<size_t>(pos - nodeIndex);
+                const auto &nodeItem = nodeItems[iItem];
+                if (!n.intersects(nodeItem))
+                    continue;
+                if (!isLeafLevel)
+                {
+                    anNextNodeIndices.push_back(nodeItem.offset);
+                    continue;
+                }
+                results.push_back({nodeItem.offset, pos - nLevelStart});
+
+                uint64_t nNextOffset = 0;
+                if (pos + 1 < rangeEnd)
+                {
+                    nNextOffset = nodeItems[iItem + 1].offset;
+                }
+                else if (pos + 1 == nLevelEnd)
+                {
+                    // Last feature: it extends up to the end of file
+                    if (m_nFileSize == 0)
+                    {
+                        VSIStatBufL sStatBuf;
+                        if (VSIStatL(m_osFilename.c_str(), &sStatBuf) == 0)
+                            m_nFileSize = sStatBuf.st_size;
+                    }
+                    if (m_nFileSize > m_offsetFeatures)
+                        nNextOffset = m_nFileSize - m_offsetFeatures;
+                }
+                const uint64_t nSize = nNextOffset > nodeItem.offset
+                                           ? nNextOffset - nodeItem.offset
+                                           : 0;
+                m_foundItemSizes.push_back(
+                    nSize <= feature_max_buffer_size
+                        ? static_cast<uint32_t>(nSize)
+                        : 0);
+            }
+            nMinPos = end;
+        }
+        anNodeIndices = std::move(anNextNodeIndices);
+    }
+    return results;
+}
+
+/************************************************************************/
+/*                         prefetchFeatures()                           */
+/************************************************************************/
+
+// Fetch the features found by searchIndexMultiRange(), starting at the
+// current iteration position, with a single VSIFReadMultiRangeL() call.
+bool OGRFlatGeobufLayer::prefetchFeatures()
+{
+    constexpr size_t MAX_PREFETCHED_FEATURES = 1000;
+    constexpr size_t MAX_PREFETCHED_BYTES = 16 * 1024 * 1024;
+    const size_t nMaxGap = GetMultiRangeMaxGap();
+
+    m_abyPrefetchBuffer.clear();
+    m_anPrefetchItemOffsets.clear();
+    m_nPrefetchFirstItem = m_featuresPos;
+
+    std::vector<vsi_l_offset> anOffsets;
+    std::vector<size_t> anSizes;
+    size_t nTotalSize = 0;
+    for (size_t i = m_featuresPos;
+         i < m_foundItems.size() &&
+         m_anPrefetchItemOffsets.size() < MAX_PREFETCHED_FEATURES;
+         ++i)
+    {
+        const size_t nSize = m_foundItemSizes[i];
+        if (nSize <= sizeof(uint32_t))
+        {
+            // Unknown size: will be read directly from the file
+            m_anPrefetchItemOffsets.push_back(
+                std::numeric_limits<size_t>::max());
+            continue;
+        }
+        const vsi_l_offset nOffset = m_offsetFeatures + m_foundItems[i].offset;
+        if (!anOffsets.empty())
+        {
+            const vsi_l_offset nPrevEnd = anOffsets.back() + anSizes.back();
+            if (nOffset < nPrevEnd)
+                break;
+            const size_t nGap = static_cast<size_t>(
+                std::min<vsi_l_offset>(nOffset - nPrevEnd, nMaxGap + 1));
+            if (nGap <= nMaxGap)
+            {
+                if (nTotalSize + nGap + nSize > MAX_PREFETCHED_BYTES)
+                    break;
+                anSizes.back() += nGap + nSize;
+                nTotalSize += nGap + nSize;
+                m_anPrefetchItemOffsets.push_back(nTotalSize - nSize);
+                continue;
+            }
+            if (nTotalSize + nSize > MAX_PREFETCHED_BYTES)
+                break;
+        }
+        anOffsets.push_back(nOffset);
+        anSizes.push_back(nSize);
+        nTotalSize += nSize;
+        m_anPrefetchItemOffsets.push_back(nTotalSize - nSize);
+    }
+    if (anOffsets.empty())
+        return true;
+
+    try
+    {
+        m_abyPrefetchBuffer.resize(nTotalSize);
+    }
+    catch (const std::exception &)
+    {
+        m_bUseMultiRangeRead = false;
+        m_anPrefetchItemOffsets.clear();
+        return false;
+    }
+    std::vector<void *> apData;
+    size_t nBufferOffset = 0;
+    for (const size_t nSize : anSizes)
+    {
+        apData.push_back(m_abyPrefetchBuffer.data() + nBufferOffset);
+        nBufferOffset += nSize;
+    }
+    CPLDebugOnly("FlatGeobuf",
+                 "Prefetching %u features in %u ranges (%u bytes)",
+                 static_cast<unsigned>(m_anPrefetchItemOffsets.size()),
+                 static_cast<unsigned>(anOffsets.size()),
+                 static_cast<unsigned>(nTotalSize));
+    if (VSIFReadMultiRangeL(static_cast<int>(anOffsets.size()), apData.data(),
+                            anOffsets.data(), anSizes.data(), m_poFp) != 0)
+    {
+        // Fallback to reading features one by one
+        CPLDebug("FlatGeobuf", "Multi-range read of features failed");
+        m_bUseMultiRangeRead = false;
+        m_abyPrefetchBuffer.clear();
+        m_anPrefetchItemOffsets.clear();
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                       readPrefetchedFeature()                        */
+/************************************************************************/
+
+// Fill m_featureBuf with the feature at the current iteration position of a
+// spatial index query, if it has been (or can be) prefetched.
+bool OGRFlatGeobufLayer::readPrefetchedFeature(uint32_t &featureSize)
+{
+    if (!m_bUseMultiRangeRead || !m_queriedSpatialIndex ||
+        m_ignoreSpatialFilter || m_featuresPos >= m_foundItemSizes.size())
+        return false;
+    if (m_featuresPos < m_nPrefetchFirstItem ||
+        m_featuresPos >=
+            m_nPrefetchFirstItem + m_anPrefetchItemOffsets.size())
+    {
+        if (!prefetchFeatures())
+            return false;
+    }
+    const size_t nBufferOffset =
+        m_anPrefetchItemOffsets[m_featuresPos - m_nPrefetchFirstItem];
+    if (nBufferOffset == std::numeric_limits<size_t>::max())
+        return false;
+    memcpy(&featureSize, m_abyPrefetchBuffer.data() + nBufferOffset,
+           sizeof(featureSize));
+    CPL_LSBPTR32(&featureSize);
+    // Consistency check with the size deduced from the index
+    if (featureSize > m_foundItemSizes[m_featuresPos] - sizeof(featureSize))
+        return false;
+    if (ensureFeatureBuf(featureSize) != OGRERR_NONE)
+        return false;
+    memcpy(m_featureBuf,
+           m_abyPrefetchBuffer.data() + nBufferOffset + sizeof(featureSize),
+           featureSize);
+    return true;
+}
+
 GIntBig OGRFlatGeobufLayer::GetFeatureCount(int bForce)
 {
     if (m_poFilterGeom != nullptr || m_poAttrQuery != nullptr ||
@@ -1090,47 +1882,50 @@ OGRErr OGRFlatGeobufLayer::parseFeature(OGRFeature *poFeature)
     if (m_featuresPos == 0)
         seek = true;
 
-    if (seek && VSIFSeekL(m_poFp, m_offset, SEEK_SET) == -1)
-    {
-        if (VSIFEofL(m_poFp))
-            return OGRERR_NONE;
-        return CPLErrorIO("seeking to feature location");
-    }
-    uint32_t featureSize;
-    if (VSIFReadL(&featureSize, sizeof(featureSize), 1, m_poFp) != 1)
+    uint32_t featureSize = 0;
+    if (!seek || !readPrefetchedFeature(featureSize))
     {
-        if (VSIFEofL(m_poFp))
-            return OGRERR_NONE;
-        return CPLErrorIO("reading feature size");
-    }
-    CPL_LSBPTR32(&featureSize);
-
-    // Sanity check to avoid allocated huge amount of memory on corrupted
-    // feature
-    if (featureSize > 100 * 1024 * 1024)
-    {
-        if (featureSize > feature_max_buffer_size)
-            return CPLErrorInvalidSize("feature");
-
-        if (m_nFileSize == 0)
+        if (seek && VSIFSeekL(m_poFp, m_offset, SEEK_SET) == -1)
         {
-            VSIStatBufL sStatBuf;
-            if (VSIStatL(m_osFilename.c_str(), &sStatBuf) == 0)
-            {
-                m_nFileSize = sStatBuf.st_size;
-            }
+            if (VSIFEofL(m_poFp))
+                return OGRERR_NONE;
+            return CPLErrorIO("seeking to feature location");
         }
-        if (m_offset + featureSize > m_nFileSize)
+        if (VSIFReadL(&featureSize, sizeof(featureSize), 1, m_poFp) != 1)
         {
+            if (VSIFEofL(m_poFp))
+                return OGRERR_NONE;
             return CPLErrorIO("reading feature size");
         }
-    }
+        CPL_LSBPTR32(&featureSize);
+
+        // Sanity check to avoid allocated huge amount of memory on corrupted
+        // feature
+        if (featureSize > 100 * 1024 * 1024)
+        {
+            if (featureSize > feature_max_buffer_size)
+                return CPLErrorInvalidSize("feature");
+
+            if (m_nFileSize == 0)
+            {
+                VSIStatBufL sStatBuf;
+                if (VSIStatL(m_osFilename.c_str(), &sStatBuf) == 0)
+                {
+                    m_nFileSize = sStatBuf.st_size;
+                }
+            }
+            if (m_offset + featureSize > m_nFileSize)
+            {
+                return CPLErrorIO("reading feature size");
+            }
+        }
 
-    const auto err = ensureFeatureBuf(featureSize);
-    if (err != OGRERR_NONE)
-        return err;
-    if (VSIFReadL(m_featureBuf, 1, featureSize, m_poFp) != featureSize)
-        return CPLErrorIO("reading feature");
+        const auto err = ensureFeatureBuf(featureSize);
+        if (err != OGRERR_NONE)
+            return err;
+        if (VSIFReadL(m_featureBuf, 1, featureSize, m_poFp) != featureSize)
+            return CPLErrorIO("reading feature");
+    }
     m_offset += featureSize + sizeof(featureSize);
 
     if (m_bVerifyBuffers)
@@ -1452,7 +2247,9 @@ int OGRFlatGeobufLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
 {
     if (!m_poSharedArrowArrayStreamPrivateData->m_anQueriedFIDs.empty() ||
         CPLTestBool(
-            CPLGetConfigOption("OGR_FLATGEOBUF_STREAM_BASE_IMPL", "NO")))
+            CPLGetConfigOption("OGR_FLATGEOBUF_STREAM_BASE_IMPL", "NO")) ||
+        OGRArrowArrayHelper::HasGeoArrowGeometryField(
+            m_poFeatureDefn, m_aosArrowArrayStreamOptions))
     {
         return OGRLayer::GetNextArrowArray(stream, out_array);
     }
@@ -1528,53 +2325,56 @@ begin:
         if (m_featuresPos == 0)
             seek = true;
 
-        if (seek && VSIFSeekL(m_poFp, m_offset, SEEK_SET) == -1)
-        {
-            break;
-        }
-        uint32_t featureSize;
-        if (VSIFReadL(&featureSize, sizeof(featureSize), 1, m_poFp) != 1)
+        uint32_t featureSize = 0;
+        if (!seek || !readPrefetchedFeature(featureSize))
         {
-            if (VSIFEofL(m_poFp))
+            if (seek && VSIFSeekL(m_poFp, m_offset, SEEK_SET) == -1)
+            {
                 break;
-            CPLErrorIO("reading feature size");
-            goto error;
-        }
-        CPL_LSBPTR32(&featureSize);
-
-        // Sanity check to avoid allocated huge amount of memory on corrupted
-        // feature
-        if (featureSize > 100 * 1024 * 1024)
-        {
-            if (featureSize > feature_max_buffer_size)
+            }
+            if (VSIFReadL(&featureSize, sizeof(featureSize), 1, m_poFp) != 1)
             {
-                CPLErrorInvalidSize("feature");
+                if (VSIFEofL(m_poFp))
+                    break;
+                CPLErrorIO("reading feature size");
                 goto error;
             }
+            CPL_LSBPTR32(&featureSize);
 
-            if (m_nFileSize == 0)
+            // Sanity check to avoid allocated huge amount of memory on
+            // corrupted feature
+            if (featureSize > 100 * 1024 * 1024)
             {
-                VSIStatBufL sStatBuf;
-                if (VSIStatL(m_osFilename.c_str(), &sStatBuf) == 0)
+                if (featureSize > feature_max_buffer_size)
                 {
-                    m_nFileSize = sStatBuf.st_size;
+                    CPLErrorInvalidSize("feature");
+                    goto error;
+                }
+
+                if (m_nFileSize == 0)
+                {
+                    VSIStatBufL sStatBuf;
+                    if (VSIStatL(m_osFilename.c_str(), &sStatBuf) == 0)
+                    {
+                        m_nFileSize = sStatBuf.st_size;
+                    }
+                }
+                if (m_offset + featureSize > m_nFileSize)
+                {
+                    CPLErrorIO("reading feature size");
+                    goto error;
                 }
             }
-            if (m_offset + featureSize > m_nFileSize)
+
+            const auto err = ensureFeatureBuf(featureSize);
+            if (err != OGRERR_NONE)
+                goto error;
+            if (VSIFReadL(m_featureBuf, 1, featureSize, m_poFp) != featureSize)
             {
-                CPLErrorIO("reading feature size");
+                CPLErrorIO("reading feature");
                 goto error;
             }
         }
-
-        const auto err = ensureFeatureBuf(featureSize);
-        if (err != OGRERR_NONE)
-            goto error;
-        if (VSIFReadL(m_featureBuf, 1, featureSize, m_poFp) != featureSize)
-        {
-            CPLErrorIO("reading feature");
-            goto error;
-        }
         m_offset += featureSize + sizeof(featureSize);
 
         if (m_bVerifyBuffers)
@@ -1602,20 +2402,33 @@ begin:
             auto geometryType = m_geometryType;
             if (geometryType == GeometryType::Unknown)
                 geometryType = geometry->type();
-            auto poOGRGeometry = std::unique_ptr<OGRGeometry>(
-                GeometryReader(geometry, geometryType, m_hasZ, m_hasM).read());
-            if (poOGRGeometry == nullptr)
+            const GeometryReader reader(geometry, geometryType, m_hasZ,
+                                        m_hasM);
+
+            // Without spatial filter, simple geometries are directly
+            // encoded as WKB from the feature buffer.
+            std::unique_ptr<OGRGeometry> poOGRGeometry;
+            size_t nWKBSize =
+                m_poFilterGeom == nullptr ? reader.getDirectWkbSize() : 0;
+            if (nWKBSize == 0)
             {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "Failed to read geometry");
-                goto error;
-            }
+                poOGRGeometry.reset(
+                    GeometryReader(geometry, geometryType, m_hasZ, m_hasM)
+                        .read());
+                if (poOGRGeometry == nullptr)
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "Failed to read geometry");
+                    goto error;
+                }
+
+                if (!FilterGeometry(poOGRGeometry.get()))
+                    goto end_of_loop;
 
-            if (!FilterGeometry(poOGRGeometry.get()))
-                goto end_of_loop;
+                nWKBSize = poOGRGeometry->WkbSize();
+            }
 
             const int iArrowField = sHelper.m_mapOGRGeomFieldToArrowField[0];
-            const size_t nWKBSize = poOGRGeometry->WkbSize();
 
             if (iFeat > 0)
             {
@@ -1637,7 +2450,10 @@ begin:
                 errorErrno = ENOMEM;
                 goto error;
             }
-            poOGRGeometry->exportToWkb(wkbNDR, outPtr, wkbVariantIso);
+            if (poOGRGeometry)
+                poOGRGeometry->exportToWkb(wkbNDR, outPtr, wkbVariantIso);
+            else
+                reader.writeDirectWkb(outPtr);
         }
 
         abSetFields.clear();
@@ -2068,8 +2884,6 @@ OGRErr OGRFlatGeobufLayer::ICreateFeature(OGRFeature *poNewFeature)
     std::vector<uint8_t> &properties = m_writeProperties;
     properties.clear();
     properties.reserve(1024 * 4);
-    FlatBufferBuilder fbb;
-    fbb.TrackMinAlign(8);
 
     for (int i = 0; i < fieldCount; i++)
     {
@@ -2263,6 +3077,18 @@ OGRErr OGRFlatGeobufLayer::ICreateFeature(OGRFeature *poNewFeature)
     // ogrGeometry->exportToWkt(&wkt);
     // CPLDebugOnly("FlatGeobuf", "poNewFeature as wkt: %s", wkt);
 #endif
+
+    return writeFeature(ogrGeometry);
+}
+
+// Serialize and write a feature whose properties have been encoded in
+// m_writeProperties.
+OGRErr OGRFlatGeobufLayer::writeFeature(const OGRGeometry *ogrGeometry)
+{
+    std::vector<uint8_t> &properties = m_writeProperties;
+    FlatBufferBuilder fbb;
+    fbb.TrackMinAlign(8);
+
     if (m_bCreateSpatialIndexAtClose &&
         (ogrGeometry == nullptr || ogrGeometry->IsEmpty()))
     {
@@ -2361,6 +3187,12 @@ OGRErr OGRFlatGeobufLayer::ICreateFeature(OGRFeature *poNewFeature)
             item.nodeItem = {psEnvelope.MinX, psEnvelope.MinY, psEnvelope.MaxX,
                              psEnvelope.MaxY, 0};
             m_featureItems.emplace_back(std::move(item));
+            if (m_nMaxFeatureItemsInMemory > 0 &&
+                m_featureItems.size() >= m_nMaxFeatureItemsInMemory &&
+                !SpillFeatureItems())
+            {
+                return OGRERR_FAILURE;
+            }
         }
         m_writeOffset += c;
 
@@ -2376,6 +3208,178 @@ OGRErr OGRFlatGeobufLayer::ICreateFeature(OGRFeature *poNewFeature)
     }
 }
 
+// Batches made only of columns of simple types (cf
+// OGRLayer::GetArrowBatchSimpleColumns()) have their properties encoded
+// directly from the Arrow buffers. Geometries are imported from WKB into a
+// geometry object reused from row to row whenever possible. Other batches are
+// handled by the generic implementation, which goes through OGRFeature.
+bool OGRFlatGeobufLayer::WriteArrowBatch(const struct ArrowSchema *schema,
+                                         struct ArrowArray *array,
+                                         CSLConstList papszOptions)
+{
+    std::vector<OGRArrowSimpleColumn> asColumns;
+    if (!m_create ||
+        !GetArrowBatchSimpleColumns(schema, array, papszOptions, asColumns))
+    {
+        return OGRLayer::WriteArrowBatch(schema, array, papszOptions);
+    }
+
+    const auto fieldCount = m_poFeatureDefn->GetFieldCount();
+    std::vector<const OGRArrowSimpleColumn *> apsFieldColumns(fieldCount,
+                                                              nullptr);
+    const OGRArrowSimpleColumn *psGeomColumn = nullptr;
+    for (const auto &sColumn : asColumns)
+    {
+        if (sColumn.iOGRFieldIdx >= 0)
+            apsFieldColumns[sColumn.iOGRFieldIdx] = &sColumn;
+        else if (sColumn.bIsGeometry)
+            psGeomColumn = &sColumn;
+    }
+
+    std::vector<uint8_t> &properties = m_writeProperties;
+    const auto append = [&properties](const void *pData, size_t nSize)
+    {
+        const uint8_t *pabyData = static_cast<const uint8_t *>(pData);
+        properties.insert(properties.end(), pabyData, pabyData + nSize);
+    };
+
+    std::unique_ptr<OGRGeometry> poGeom;
+    const size_t nRows = static_cast<size_t>(array->length);
+    try
+    {
+        for (size_t iRow = 0; iRow < nRows; ++iRow)
+        {
+            properties.clear();
+            for (int i = 0; i < fieldCount; i++)
+            {
+                const auto psColumn = apsFieldColumns[i];
+                if (!psColumn || psColumn->IsNull(iRow))
+                    continue;
+
+                uint16_t column_index_le = static_cast<uint16_t>(i);
+                CPL_LSBPTR16(&column_index_le);
+                append(&column_index_le, sizeof(column_index_le));
+
+                const auto fieldDef = m_poFeatureDefn->GetFieldDefn(i);
+                const auto fieldSubType = fieldDef->GetSubType();
+                switch (fieldDef->GetType())
+                {
+                    case OGRFieldType::OFTInteger:
+                    {
+                        const int nVal =
+                            static_cast<int>(psColumn->GetInt64(iRow));
+                        if (fieldSubType == OFSTBoolean)
+                        {
+                            const GByte byVal = static_cast<GByte>(nVal);
+                            append(&byVal, sizeof(byVal));
+                        }
+                        else if (fieldSubType == OFSTInt16)
+                        {
+                            short sVal = static_cast<short>(nVal);
+                            CPL_LSBPTR16(&sVal);
+                            append(&sVal, sizeof(sVal));
+                        }
+                        else
+                        {
+                            int nValLE = nVal;
+                            CPL_LSBPTR32(&nValLE);
+                            append(&nValLE, sizeof(nValLE));
+                        }
+                        break;
+                    }
+                    case OGRFieldType::OFTInteger64:
+                    {
+                        GIntBig nVal = psColumn->GetInt64(iRow);
+                        CPL_LSBPTR64(&nVal);
+                        append(&nVal, sizeof(nVal));
+                        break;
+                    }
+                    case OGRFieldType::OFTReal:
+                    {
+                        double dfVal = psColumn->GetDouble(iRow);
+                        if (fieldSubType == OFSTFloat32)
+                        {
+                            float fVal = static_cast<float>(dfVal);
+                            CPL_LSBPTR32(&fVal);
+                            append(&fVal, sizeof(fVal));
+                        }
+                        else
+                        {
+                            CPL_LSBPTR64(&dfVal);
+                            append(&dfVal, sizeof(dfVal));
+                        }
+                        break;
+                    }
+                    default:
+                    {
+                        // OFTString or OFTBinary
+                        size_t len = 0;
+                        const GByte *pabyData =
+                            psColumn->GetBinary(iRow, len);
+                        if (len >= feature_max_buffer_size ||
+                            properties.size() > feature_max_buffer_size - len)
+                        {
+                            CPLError(CE_Failure, CPLE_AppDefined,
+                                     "WriteArrowBatch: %s too long",
+                                     fieldDef->GetType() == OFTString
+                                         ? "String"
+                                         : "Binary");
+                            return false;
+                        }
+                        // Valid cast since feature_max_buffer_size is 2 GB
+                        uint32_t l_le = static_cast<uint32_t>(len);
+                        CPL_LSBPTR32(&l_le);
+                        append(&l_le, sizeof(l_le));
+                        append(pabyData, len);
+                        break;
+                    }
+                }
+            }
+
+            const OGRGeometry *ogrGeometry = nullptr;
+            if (psGeomColumn && !psGeomColumn->IsNull(iRow))
+            {
+                size_t nWKBSize = 0;
+                const GByte *pabyWKB = psGeomColumn->GetBinary(iRow, nWKBSize);
+                OGRwkbGeometryType eGeomType = wkbUnknown;
+                size_t nBytesConsumed = 0;
+                // Reuse the geometry of the previous row if it is of the
+                // same type, to save dynamic memory allocations
+                if (!(poGeom && nWKBSize >= 5 &&
+                      OGRReadWKBGeometryType(pabyWKB, wkbVariantIso,
+                                             &eGeomType) == OGRERR_NONE &&
+                      eGeomType == poGeom->getGeometryType() &&
+                      poGeom->importFromWkb(pabyWKB, nWKBSize, wkbVariantIso,
+                                            nBytesConsumed) == OGRERR_NONE))
+                {
+                    OGRGeometry *poGeomRaw = nullptr;
+                    OGRGeometryFactory::createFromWkb(
+                        pabyWKB, nullptr, &poGeomRaw, nWKBSize, wkbVariantIso);
+                    poGeom.reset(poGeomRaw);
+                    if (!poGeom)
+                    {
+                        CPLError(CE_Failure, CPLE_AppDefined,
+                                 "WriteArrowBatch: Invalid WKB geometry");
+                        return false;
+                    }
+                }
+                ogrGeometry = poGeom.get();
+            }
+
+            if (writeFeature(ogrGeometry) != OGRERR_NONE)
+                return false;
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "WriteArrowBatch: Memory allocation failure");
+        return false;
+    }
+
+    return true;
+}
+
 OGRErr OGRFlatGeobufLayer::GetExtent(OGREnvelope *psExtent, int bForce)
 {
     if (m_sExtent.IsInit())
@@ -2392,6 +3396,8 @@ int OGRFlatGeobufLayer::TestCapability(const char *pszCap)
         return m_create;
     else if (EQUAL(pszCap, OLCSequentialWrite))
         return m_create;
+    else if (EQUAL(pszCap, OLCFastWriteArrowBatch))
+        return m_create;
     else if (EQUAL(pszCap, OLCRandomRead))
         return m_poHeader != nullptr && m_poHeader->index_node_size() > 0;
     else if (EQUAL(pszCap, OLCIgnoreFields))
@@ -2424,6 +3430,10 @@ void OGRFlatGeobufLayer::ResetReading()
     m_bEOF = false;
     m_featuresPos = 0;
     m_foundItems.clear();
+    m_foundItemSizes.clear();
+    m_abyPrefetchBuffer.clear();
+    m_anPrefetchItemOffsets.clear();
+    m_nPrefetchFirstItem = 0;
     m_featuresCount = m_poHeader ? m_poHeader->features_count() : 0;
     m_queriedSpatialIndex = false;
     m_ignoreSpatialFilter = false;
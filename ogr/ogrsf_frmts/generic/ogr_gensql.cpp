@@ -32,6 +32,7 @@
 #include "ogr_gensql.h"
 #include "cpl_string.h"
 #include "ogr_api.h"
+#include "ogr_recordbatch.h"
 #include "cpl_time.h"
 #include <algorithm>
 #include <limits>
@@ -508,6 +509,9 @@ OGRGenSQLResultsLayer::~OGRGenSQLResultsLayer()
     CPLFree(panFIDIndex);
     CPLFree(panGeomFieldToSrcGeomField);
 
+    // Must be done before the joined datasources are closed
+    m_aoJoinHashTables.clear();
+
     delete poSummaryFeature;
     delete static_cast<swq_select *>(pSelectInfo);
 
@@ -826,6 +830,260 @@ int OGRGenSQLResultsLayer::ContainGeomSpecialField(swq_expr_node *expr)
     return FALSE;
 }
 
+/************************************************************************/
+/*                       SummarizeArrowColumn()                         */
+/************************************************************************/
+
+// Update oSummary with the values of a primitive Arrow array, following
+// the semantics of swq_select_summarize() for numeric fields.
+template <class T>
+static void SummarizeArrowColumn(const struct ArrowArray *psArray,
+                                 swq_col_func eFunc, swq_summary &oSummary)
+{
+    const auto pabyValidity =
+        static_cast<const uint8_t *>(psArray->buffers[0]);
+    const T *paValues =
+        static_cast<const T *>(psArray->buffers[1]) + psArray->offset;
+    const size_t nLength = static_cast<size_t>(psArray->length);
+    const bool bHasNulls = psArray->null_count != 0 && pabyValidity != nullptr;
+
+    GIntBig nCount = 0;
+    double dfMin = oSummary.min;
+    double dfMax = oSummary.max;
+    double dfSum = oSummary.sum;
+    if (!bHasNulls)
+    {
+        nCount = static_cast<GIntBig>(nLength);
+        switch (eFunc)
+        {
+            case SWQCF_MIN:
+                for (size_t i = 0; i < nLength; ++i)
+                    dfMin = std::min(dfMin, static_cast<double>(paValues[i]));
+                break;
+            case SWQCF_MAX:
+                for (size_t i = 0; i < nLength; ++i)
+                    dfMax = std::max(dfMax, static_cast<double>(paValues[i]));
+                break;
+            case SWQCF_AVG:
+            case SWQCF_SUM:
+                for (size_t i = 0; i < nLength; ++i)
+                    dfSum += static_cast<double>(paValues[i]);
+                break;
+            default:
+                break;
+        }
+    }
+    else
+    {
+        const size_t nOffset = static_cast<size_t>(psArray->offset);
+        for (size_t i = 0; i < nLength; ++i)
+        {
+            const size_t nIdx = nOffset + i;
+            if ((pabyValidity[nIdx / 8] & (1 << (nIdx % 8))) == 0)
+                continue;
+            ++nCount;
+            const double dfVal = static_cast<double>(paValues[i]);
+            if (eFunc == SWQCF_MIN)
+                dfMin = std::min(dfMin, dfVal);
+            else if (eFunc == SWQCF_MAX)
+                dfMax = std::max(dfMax, dfVal);
+            else if (eFunc == SWQCF_AVG || eFunc == SWQCF_SUM)
+                dfSum += dfVal;
+        }
+    }
+    oSummary.count += nCount;
+    oSummary.min = dfMin;
+    oSummary.max = dfMax;
+    oSummary.sum = dfSum;
+}
+
+/************************************************************************/
+/*                    CanSummarizeFromArrowStream()                     */
+/************************************************************************/
+
+// Returns whether all the summary columns are COUNT/MIN/MAX/SUM/AVG on
+// COUNT(*) or numeric attribute fields of the source layer, and that
+// the source layer can efficiently expose them as Arrow batches.
+bool OGRGenSQLResultsLayer::CanSummarizeFromArrowStream()
+{
+    swq_select *psSelectInfo = static_cast<swq_select *>(pSelectInfo);
+
+    if (psSelectInfo->query_mode != SWQM_SUMMARY_RECORD ||
+        psSelectInfo->join_count != 0 || psSelectInfo->table_count != 1 ||
+        !poSrcLayer->TestCapability(OLCFastGetArrowStream) ||
+        (!m_bForwardWhereToSourceLayer && psSelectInfo->where_expr) ||
+        MustEvaluateSpatialFilterOnGenSQL() ||
+        !CPLTestBool(CPLGetConfigOption("OGR_SQL_USE_ARROW_STREAM", "YES")))
+    {
+        return false;
+    }
+
+    OGRFeatureDefn *poSrcDefn = poSrcLayer->GetLayerDefn();
+    for (int iField = 0; iField < psSelectInfo->result_columns(); iField++)
+    {
+        const swq_col_def *psColDef = &psSelectInfo->column_defs[iField];
+        if (psColDef->distinct_flag || psColDef->table_index > 0)
+            return false;
+        if (psColDef->col_func == SWQCF_COUNT && psColDef->field_index < 0)
+            continue;
+        if ((psColDef->col_func != SWQCF_COUNT &&
+             psColDef->col_func != SWQCF_MIN &&
+             psColDef->col_func != SWQCF_MAX &&
+             psColDef->col_func != SWQCF_SUM &&
+             psColDef->col_func != SWQCF_AVG) ||
+            psColDef->field_index < 0 ||
+            psColDef->field_index >= poSrcDefn->GetFieldCount())
+        {
+            return false;
+        }
+        const OGRFieldDefn *poFieldDefn =
+            poSrcDefn->GetFieldDefn(psColDef->field_index);
+        const OGRFieldType eType = poFieldDefn->GetType();
+        const OGRFieldSubType eSubType = poFieldDefn->GetSubType();
+        // Boolean fields are bit-packed in Arrow, and Float32 or fixed
+        // width reals are formatted differently by GetFieldAsString().
+        if (!(eType == OFTInteger64 ||
+              (eType == OFTInteger && eSubType != OFSTBoolean) ||
+              (eType == OFTReal && eSubType == OFSTNone &&
+               poFieldDefn->GetWidth() == 0)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                     SummarizeFromArrowStream()                       */
+/************************************************************************/
+
+// Returns false if the Arrow stream of the source layer cannot be used
+// (nothing has been consumed in that case), or if an error occurred, in
+// which case bError is set.
+bool OGRGenSQLResultsLayer::SummarizeFromArrowStream(bool &bError)
+{
+    swq_select *psSelectInfo = static_cast<swq_select *>(pSelectInfo);
+    OGRFeatureDefn *poSrcDefn = poSrcLayer->GetLayerDefn();
+
+    bError = false;
+
+    struct ArrowArrayStream stream;
+    const char *const apszOptions[] = {"INCLUDE_FID=NO", nullptr};
+    if (!poSrcLayer->GetArrowStream(&stream, apszOptions))
+        return false;
+
+    struct ArrowSchema schema;
+    if (stream.get_schema(&stream, &schema) != 0)
+    {
+        stream.release(&stream);
+        return false;
+    }
+
+    // Map each summary column to a child of the Arrow record batches
+    const int nColumns = psSelectInfo->result_columns();
+    std::vector<int> anChildIdx(nColumns, -1);
+    std::vector<char> achFormat(nColumns, 0);
+    bool bOK = true;
+    for (int iField = 0; bOK && iField < nColumns; iField++)
+    {
+        const swq_col_def *psColDef = &psSelectInfo->column_defs[iField];
+        if (psColDef->field_index < 0)
+            continue;
+        const char *pszFieldName =
+            poSrcDefn->GetFieldDefn(psColDef->field_index)->GetNameRef();
+        for (int64_t i = 0; i < schema.n_children; ++i)
+        {
+            const struct ArrowSchema *psChild = schema.children[i];
+            if (strcmp(psChild->name, pszFieldName) == 0)
+            {
+                anChildIdx[iField] = static_cast<int>(i);
+                achFormat[iField] = psChild->format[0];
+                if (psChild->format[1] != '\0' ||
+                    psChild->dictionary != nullptr ||
+                    (achFormat[iField] != 's' && achFormat[iField] != 'i' &&
+                     achFormat[iField] != 'l' && achFormat[iField] != 'g'))
+                {
+                    bOK = false;
+                }
+                break;
+            }
+        }
+        if (anChildIdx[iField] < 0)
+            bOK = false;
+    }
+    schema.release(&schema);
+    if (!bOK)
+    {
+        stream.release(&stream);
+        return false;
+    }
+
+    // Initialize the summaries
+    for (int iField = 0; iField < nColumns; iField++)
+    {
+        const char *pszError =
+            swq_select_summarize(psSelectInfo, iField, nullptr);
+        if (pszError)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "%s", pszError);
+            stream.release(&stream);
+            bError = true;
+            return true;
+        }
+    }
+
+    while (true)
+    {
+        struct ArrowArray array;
+        if (stream.get_next(&stream, &array) != 0)
+        {
+            const char *pszError = stream.get_last_error(&stream);
+            CPLError(CE_Failure, CPLE_AppDefined, "%s",
+                     pszError ? pszError : "Error while reading Arrow stream");
+            bError = true;
+            break;
+        }
+        if (array.release == nullptr)
+            break;
+
+        for (int iField = 0; iField < nColumns; iField++)
+        {
+            const swq_col_def *psColDef = &psSelectInfo->column_defs[iField];
+            swq_summary &oSummary = psSelectInfo->column_summary[iField];
+            if (anChildIdx[iField] < 0)
+            {
+                oSummary.count += array.length;
+                continue;
+            }
+            const struct ArrowArray *psChild =
+                array.children[anChildIdx[iField]];
+            switch (achFormat[iField])
+            {
+                case 's':
+                    SummarizeArrowColumn<int16_t>(psChild, psColDef->col_func,
+                                                  oSummary);
+                    break;
+                case 'i':
+                    SummarizeArrowColumn<int32_t>(psChild, psColDef->col_func,
+                                                  oSummary);
+                    break;
+                case 'l':
+                    SummarizeArrowColumn<int64_t>(psChild, psColDef->col_func,
+                                                  oSummary);
+                    break;
+                default:
+                    SummarizeArrowColumn<double>(psChild, psColDef->col_func,
+                                                 oSummary);
+                    break;
+            }
+        }
+        array.release(&array);
+    }
+
+    stream.release(&stream);
+    return true;
+}
+
 /************************************************************************/
 /*                           PrepareSummary()                           */
 /************************************************************************/
@@ -917,6 +1175,27 @@ int OGRGenSQLResultsLayer::PrepareSummary()
         return TRUE;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      If the source layer can expose its features as Arrow batches,   */
+    /*      compute numeric aggregates on whole columns at once.            */
+    /* -------------------------------------------------------------------- */
+    bool bSummarizedFromArrow = false;
+    if (CanSummarizeFromArrowStream())
+    {
+        bool bError = false;
+        bSummarizedFromArrow = SummarizeFromArrowStream(bError);
+        if (bError)
+        {
+            delete poSummaryFeature;
+            poSummaryFeature = nullptr;
+            psSelectInfo->column_summary.clear();
+
+            poSrcLayer->GetLayerDefn()->SetGeometryIgnored(bSaveIsGeomIgnored);
+            ClearFilters();
+            return FALSE;
+        }
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Otherwise, process all source feature through the summary       */
     /*      building facilities of SWQ.                                     */
@@ -924,7 +1203,8 @@ int OGRGenSQLResultsLayer::PrepareSummary()
     const char *pszError = nullptr;
     OGRFeature *poSrcFeature = nullptr;
 
-    while ((poSrcFeature = poSrcLayer->GetNextFeature()) != nullptr)
+    while (!bSummarizedFromArrow &&
+           (poSrcFeature = poSrcLayer->GetNextFeature()) != nullptr)
     {
         for (int iField = 0; iField < psSelectInfo->result_columns(); iField++)
         {
@@ -1301,6 +1581,160 @@ static CPLString GetFilterForJoin(swq_expr_node *poExpr, OGRFeature *poSrcFeat,
     return "";
 }
 
+/************************************************************************/
+/*                        EstimateFeatureSize()                         */
+/************************************************************************/
+
+static size_t EstimateFeatureSize(const OGRFeature *poFeature)
+{
+    size_t nSize = sizeof(OGRFeature) +
+                   poFeature->GetFieldCount() * sizeof(OGRField) +
+                   poFeature->GetGeomFieldCount() * sizeof(OGRGeometry *);
+    for (int i = 0; i < poFeature->GetFieldCount(); ++i)
+    {
+        if (!poFeature->IsFieldSetAndNotNull(i))
+            continue;
+        const OGRField *psField = poFeature->GetRawFieldRef(i);
+        switch (poFeature->GetFieldDefnRef(i)->GetType())
+        {
+            case OFTString:
+                nSize += strlen(psField->String) + 1;
+                break;
+            case OFTBinary:
+                nSize += psField->Binary.nCount;
+                break;
+            case OFTIntegerList:
+                nSize += psField->IntegerList.nCount * sizeof(int);
+                break;
+            case OFTInteger64List:
+                nSize += psField->Integer64List.nCount * sizeof(GIntBig);
+                break;
+            case OFTRealList:
+                nSize += psField->RealList.nCount * sizeof(double);
+                break;
+            case OFTStringList:
+                for (int j = 0; j < psField->StringList.nCount; ++j)
+                    nSize += sizeof(char *) +
+                             strlen(psField->StringList.paList[j]) + 1;
+                break;
+            default:
+                break;
+        }
+    }
+    for (int i = 0; i < poFeature->GetGeomFieldCount(); ++i)
+    {
+        const OGRGeometry *poGeom = poFeature->GetGeomFieldRef(i);
+        if (poGeom)
+            nSize += poGeom->WkbSize();
+    }
+    return nSize;
+}
+
+/************************************************************************/
+/*                         BuildJoinHashTable()                         */
+/************************************************************************/
+
+// For a join whose condition is an equality between an integer field of
+// the primary layer and an integer field of the secondary layer, read the
+// secondary layer once and index its features by the value of their key,
+// so that each primary feature does not need a filtered scan of the
+// secondary layer. If the table would exceed OGR_SQL_HASH_JOIN_MAX_MEMORY
+// (in MB), it is discarded and the join falls back to attribute filtering.
+void OGRGenSQLResultsLayer::BuildJoinHashTable(int iJoin)
+{
+    swq_select *psSelectInfo = static_cast<swq_select *>(pSelectInfo);
+    JoinHashTable &oTable = m_aoJoinHashTables[iJoin];
+    oTable.bBuilt = true;
+
+    const swq_join_def *psJoinInfo = psSelectInfo->join_defs + iJoin;
+    const swq_expr_node *poExpr = psJoinInfo->poExpr;
+    if (poExpr->eNodeType != SNT_OPERATION || poExpr->nOperation != SWQ_EQ ||
+        poExpr->nSubExprCount != 2 ||
+        poExpr->papoSubExpr[0]->eNodeType != SNT_COLUMN ||
+        poExpr->papoSubExpr[1]->eNodeType != SNT_COLUMN)
+    {
+        return;
+    }
+
+    const swq_expr_node *poPrimary = poExpr->papoSubExpr[0];
+    const swq_expr_node *poSecondary = poExpr->papoSubExpr[1];
+    if (poPrimary->table_index != 0)
+        std::swap(poPrimary, poSecondary);
+    if (poPrimary->table_index != 0 ||
+        poSecondary->table_index != psJoinInfo->secondary_table)
+    {
+        return;
+    }
+
+    OGRLayer *poJoinLayer = papoTableLayers[psJoinInfo->secondary_table];
+    const auto IsIntegerField = [](OGRFeatureDefn *poFDefn, int iField)
+    {
+        if (iField < 0 || iField >= poFDefn->GetFieldCount())
+            return false;
+        const OGRFieldType eType = poFDefn->GetFieldDefn(iField)->GetType();
+        return eType == OFTInteger || eType == OFTInteger64;
+    };
+    if (!IsIntegerField(poSrcLayer->GetLayerDefn(), poPrimary->field_index) ||
+        !IsIntegerField(poJoinLayer->GetLayerDefn(), poSecondary->field_index))
+    {
+        return;
+    }
+
+    const double dfMaxMemory =
+        CPLAtof(CPLGetConfigOption("OGR_SQL_HASH_JOIN_MAX_MEMORY", "256"));
+    if (!(dfMaxMemory > 0))
+        return;
+    const size_t nMaxMemory = static_cast<size_t>(
+        std::min(dfMaxMemory * 1024 * 1024,
+                 static_cast<double>(std::numeric_limits<size_t>::max())));
+
+    const int iSecondaryField = poSecondary->field_index;
+    size_t nMemory = 0;
+    bool bOK = true;
+    poJoinLayer->SetAttributeFilter(nullptr);
+    poJoinLayer->ResetReading();
+    try
+    {
+        for (auto &&poFeature : *poJoinLayer)
+        {
+            if (!poFeature->IsFieldSetAndNotNull(iSecondaryField))
+                continue;
+            // Keep the first matching feature, as the filtered scan does
+            const GIntBig nKey =
+                poFeature->GetFieldAsInteger64(iSecondaryField);
+            if (oTable.oMap.find(nKey) != oTable.oMap.end())
+                continue;
+            nMemory += EstimateFeatureSize(poFeature.get()) +
+                       sizeof(GIntBig) + 4 * sizeof(void *);
+            if (nMemory > nMaxMemory)
+            {
+                CPLDebug("OGR",
+                         "Hash table for join on %s would exceed "
+                         "OGR_SQL_HASH_JOIN_MAX_MEMORY. Using attribute "
+                         "filtering instead",
+                         poJoinLayer->GetName());
+                bOK = false;
+                break;
+            }
+            oTable.oMap[nKey] = std::move(poFeature);
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        bOK = false;
+    }
+    poJoinLayer->ResetReading();
+
+    if (!bOK)
+    {
+        oTable.oMap.clear();
+        return;
+    }
+
+    oTable.iPrimaryField = poPrimary->field_index;
+    oTable.bUsable = true;
+}
+
 /************************************************************************/
 /*                          TranslateFeature()                          */
 /************************************************************************/
@@ -1334,6 +1768,25 @@ OGRFeature *OGRGenSQLResultsLayer::TranslateFeature(OGRFeature *poSrcFeat)
 
         OGRLayer *poJoinLayer = papoTableLayers[psJoinInfo->secondary_table];
 
+        if (m_aoJoinHashTables.empty())
+            m_aoJoinHashTables.resize(psSelectInfo->join_count);
+        if (!m_aoJoinHashTables[iJoin].bBuilt)
+            BuildJoinHashTable(iJoin);
+        const JoinHashTable &oTable = m_aoJoinHashTables[iJoin];
+        if (oTable.bUsable)
+        {
+            OGRFeature *poJoinFeature = nullptr;
+            if (poSrcFeat->IsFieldSetAndNotNull(oTable.iPrimaryField))
+            {
+                const auto oIter = oTable.oMap.find(
+                    poSrcFeat->GetFieldAsInteger64(oTable.iPrimaryField));
+                if (oIter != oTable.oMap.end())
+                    poJoinFeature = oIter->second->Clone();
+            }
+            apoFeatures.push_back(poJoinFeature);
+            continue;
+        }
+
         osFilter = GetFilterForJoin(psJoinInfo->poExpr, poSrcFeat, poJoinLayer,
                                     psJoinInfo->secondary_table);
         // CPLDebug("OGR", "Filter = %s\n", osFilter.c_str());
@@ -1954,7 +2407,7 @@ void OGRGenSQLResultsLayer::ReadIndexFields(OGRFeature *poSrcFeat,
 /*      required index.                                                 */
 /*                                                                      */
 /*      Keeping all the key values in memory will *not* scale up to     */
-/*      very large input datasets.                                      */
+/*      very large input datasets, unless a LIMIT is specified.         */
 /************************************************************************/
 
 void OGRGenSQLResultsLayer::CreateOrderByIndex()
@@ -1974,47 +2427,14 @@ void OGRGenSQLResultsLayer::CreateOrderByIndex()
     ResetReading();
 
     /* -------------------------------------------------------------------- */
-    /*      Optimize (memory-wise) ORDER BY ... LIMIT 1 [OFFSET 0] case.    */
+    /*      Optimize (memory-wise) ORDER BY ... LIMIT n [OFFSET m] case.    */
     /* -------------------------------------------------------------------- */
-    if (psSelectInfo->offset == 0 && psSelectInfo->limit == 1)
+    if (psSelectInfo->limit > 0 &&
+        psSelectInfo->limit <
+            std::numeric_limits<int>::max() - psSelectInfo->offset)
     {
-        OGRFeature *poSrcFeat = poSrcLayer->GetNextFeature();
-        if (poSrcFeat == nullptr)
-        {
-            panFIDIndex = nullptr;
-            nIndexSize = 0;
-            return;
-        }
-
-        OGRField *pasCurrentFields =
-            static_cast<OGRField *>(CPLCalloc(sizeof(OGRField), nOrderItems));
-        OGRField *pasBestFields =
-            static_cast<OGRField *>(CPLCalloc(sizeof(OGRField), nOrderItems));
-        GIntBig nBestFID = poSrcFeat->GetFID();
-        ReadIndexFields(poSrcFeat, nOrderItems, pasBestFields);
-        delete poSrcFeat;
-        while ((poSrcFeat = poSrcLayer->GetNextFeature()) != nullptr)
-        {
-            ReadIndexFields(poSrcFeat, nOrderItems, pasCurrentFields);
-            if (Compare(pasCurrentFields, pasBestFields) < 0)
-            {
-                nBestFID = poSrcFeat->GetFID();
-                FreeIndexFields(pasBestFields, 1, false);
-                memcpy(pasBestFields, pasCurrentFields,
-                       sizeof(OGRField) * nOrderItems);
-            }
-            else
-            {
-                FreeIndexFields(pasCurrentFields, 1, false);
-            }
-            memset(pasCurrentFields, 0, sizeof(OGRField) * nOrderItems);
-            delete poSrcFeat;
-        }
-        VSIFree(pasCurrentFields);
-        FreeIndexFields(pasBestFields, 1);
-        panFIDIndex = static_cast<GIntBig *>(CPLMalloc(sizeof(GIntBig)));
-        panFIDIndex[0] = nBestFID;
-        nIndexSize = 1;
+        CreateOrderByTopNIndex(
+            static_cast<size_t>(psSelectInfo->limit + psSelectInfo->offset));
         return;
     }
 
@@ -2169,6 +2589,112 @@ void OGRGenSQLResultsLayer::CreateOrderByIndex()
     ResetReading();
 }
 
+/************************************************************************/
+/*                       CreateOrderByTopNIndex()                       */
+/*                                                                      */
+/*      Variant of CreateOrderByIndex() when only the nMaxEntries       */
+/*      first records are needed: only those are kept in a bounded      */
+/*      max-heap while the source features are read.                    */
+/************************************************************************/
+
+void OGRGenSQLResultsLayer::CreateOrderByTopNIndex(size_t nMaxEntries)
+
+{
+    swq_select *psSelectInfo = static_cast<swq_select *>(pSelectInfo);
+    const int nOrderItems = psSelectInfo->order_specs;
+
+    // Key values of the retained records, nOrderItems fields per record
+    std::vector<OGRField> asIndexFields;
+    std::vector<GIntBig> anFIDs;
+    // Reading order of the retained records, to sort equal keys as the
+    // (stable) full sort does.
+    std::vector<GIntBig> anSeq;
+    // Max-heap of indices in anFIDs, whose top is the greatest record
+    std::vector<size_t> anHeap;
+    std::vector<OGRField> asCurrentFields(nOrderItems);
+
+    const auto IsLess = [this, &asIndexFields, &anSeq, nOrderItems](size_t i,
+                                                                   size_t j)
+    {
+        const int nCmp = Compare(&asIndexFields[i * nOrderItems],
+                                 &asIndexFields[j * nOrderItems]);
+        return nCmp < 0 || (nCmp == 0 && anSeq[i] < anSeq[j]);
+    };
+
+    GIntBig nSeq = 0;
+    try
+    {
+        OGRFeature *poSrcFeat = nullptr;
+        while ((poSrcFeat = poSrcLayer->GetNextFeature()) != nullptr)
+        {
+            if (anFIDs.size() < nMaxEntries)
+            {
+                const size_t iEntry = anFIDs.size();
+                asIndexFields.resize((iEntry + 1) * nOrderItems);
+                ReadIndexFields(poSrcFeat, nOrderItems,
+                                &asIndexFields[iEntry * nOrderItems]);
+                anFIDs.push_back(poSrcFeat->GetFID());
+                anSeq.push_back(nSeq);
+                anHeap.push_back(iEntry);
+                std::push_heap(anHeap.begin(), anHeap.end(), IsLess);
+            }
+            else
+            {
+                ReadIndexFields(poSrcFeat, nOrderItems, asCurrentFields.data());
+                const size_t iTop = anHeap.front();
+                OGRField *pasTopFields = &asIndexFields[iTop * nOrderItems];
+                // Records read later only replace greater keys
+                if (Compare(asCurrentFields.data(), pasTopFields) < 0)
+                {
+                    std::pop_heap(anHeap.begin(), anHeap.end(), IsLess);
+                    FreeIndexFields(pasTopFields, 1, false);
+                    memcpy(pasTopFields, asCurrentFields.data(),
+                           sizeof(OGRField) * nOrderItems);
+                    anFIDs[iTop] = poSrcFeat->GetFID();
+                    anSeq[iTop] = nSeq;
+                    std::push_heap(anHeap.begin(), anHeap.end(), IsLess);
+                }
+                else
+                {
+                    FreeIndexFields(asCurrentFields.data(), 1, false);
+                }
+                memset(asCurrentFields.data(), 0,
+                       sizeof(OGRField) * nOrderItems);
+            }
+            delete poSrcFeat;
+            ++nSeq;
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate memory for ORDER BY index");
+        FreeIndexFields(asIndexFields.data(), anFIDs.size(), false);
+        nIndexSize = 0;
+        return;
+    }
+
+    std::sort_heap(anHeap.begin(), anHeap.end(), IsLess);
+    FreeIndexFields(asIndexFields.data(), anFIDs.size(), false);
+
+    nIndexSize = anHeap.size();
+    panFIDIndex = nullptr;
+    if (nIndexSize > 0)
+    {
+        panFIDIndex = static_cast<GIntBig *>(
+            VSI_MALLOC_VERBOSE(sizeof(GIntBig) * nIndexSize));
+        if (panFIDIndex == nullptr)
+        {
+            nIndexSize = 0;
+            return;
+        }
+        for (size_t i = 0; i < nIndexSize; i++)
+            panFIDIndex[i] = anFIDs[anHeap[i]];
+    }
+
+    ResetReading();
+}
+
 /************************************************************************/
 /*                          SortIndexSection()                          */
 /*                                                                      */
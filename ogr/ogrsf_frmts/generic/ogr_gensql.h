@@ -36,6 +36,8 @@
 #include "cpl_hash_set.h"
 #include "cpl_string.h"
 
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 /*! @cond Doxygen_Suppress */
@@ -87,10 +89,26 @@ class OGRGenSQLResultsLayer final : public OGRLayer
     GIntBig nIteratedFeatures;
     std::vector<CPLString> m_oDistinctList;
 
+    // In-memory table of the features of a joined layer, indexed by the
+    // value of their join key, for joins on an integer equality.
+    struct JoinHashTable
+    {
+        bool bBuilt = false;
+        bool bUsable = false;
+        int iPrimaryField = -1;
+        std::unordered_map<GIntBig, OGRFeatureUniquePtr> oMap{};
+    };
+
+    std::vector<JoinHashTable> m_aoJoinHashTables{};
+
     int PrepareSummary();
+    bool CanSummarizeFromArrowStream();
+    bool SummarizeFromArrowStream(bool &bError);
 
     OGRFeature *TranslateFeature(OGRFeature *);
+    void BuildJoinHashTable(int iJoin);
     void CreateOrderByIndex();
+    void CreateOrderByTopNIndex(size_t nMaxEntries);
     void ReadIndexFields(OGRFeature *poSrcFeat, int nOrderItems,
                          OGRField *pasIndexFields);
     void SortIndexSection(const OGRField *pasIndexFields, GIntBig *panMerged,
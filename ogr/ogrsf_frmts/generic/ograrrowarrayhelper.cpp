@@ -27,8 +27,10 @@
  ****************************************************************************/
 
 #include "ograrrowarrayhelper.h"
+#include "ogrlayerarrow.h"
 #include "ogr_p.h"
 
+#include <cmath>
 #include <limits>
 
 //! @cond Doxygen_Suppress
@@ -465,4 +467,1020 @@ bool OGRArrowArrayHelper::FillDict(struct ArrowArray *psChild,
     return true;
 }
 
+/************************************************************************/
+/*                       GetGeoArrowListLevels()                        */
+/************************************************************************/
+
+// Number of nested lists above the coordinates of a GeoArrow native array
+static int GetGeoArrowListLevels(OGRwkbGeometryType eFlatType)
+{
+    switch (eFlatType)
+    {
+        case wkbLineString:
+        case wkbMultiPoint:
+            return 1;
+        case wkbPolygon:
+        case wkbMultiLineString:
+            return 2;
+        case wkbMultiPolygon:
+            return 3;
+        default:
+            break;
+    }
+    return 0;
+}
+
+/************************************************************************/
+/*                      GetGeoArrowExtensionName()                      */
+/************************************************************************/
+
+static const struct
+{
+    const char *pszExtensionName;
+    OGRwkbGeometryType eFlatType;
+} asGeoArrowTypes[] = {
+    {"geoarrow.point", wkbPoint},
+    {"geoarrow.linestring", wkbLineString},
+    {"geoarrow.polygon", wkbPolygon},
+    {"geoarrow.multipoint", wkbMultiPoint},
+    {"geoarrow.multilinestring", wkbMultiLineString},
+    {"geoarrow.multipolygon", wkbMultiPolygon},
+};
+
+static const char *GetGeoArrowExtensionName(OGRwkbGeometryType eFlatType)
+{
+    for (const auto &sType : asGeoArrowTypes)
+    {
+        if (sType.eFlatType == eFlatType)
+            return sType.pszExtensionName;
+    }
+    return nullptr;
+}
+
+/************************************************************************/
+/*                      GetGeoArrowGeometryType()                       */
+/************************************************************************/
+
+/* Return the geometry type, with its Z/M flags, with which a geometry field
+ * is exported as a GeoArrow native array when the GEOMETRY_ENCODING stream
+ * option is GEOARROW or GEOARROW_INTERLEAVED, or wkbNone if it is exported
+ * as WKB.
+ */
+
+/* static */
+OGRwkbGeometryType OGRArrowArrayHelper::GetGeoArrowGeometryType(
+    const OGRGeomFieldDefn *poFieldDefn,
+    const CPLStringList &aosArrowArrayStreamOptions)
+{
+    const char *pszEncoding =
+        aosArrowArrayStreamOptions.FetchNameValueDef("GEOMETRY_ENCODING", "");
+    if (!EQUAL(pszEncoding, "GEOARROW") &&
+        !EQUAL(pszEncoding, "GEOARROW_INTERLEAVED"))
+    {
+        return wkbNone;
+    }
+    const auto eGType = poFieldDefn->GetType();
+    const auto eFlatType = wkbFlatten(eGType);
+    if (GetGeoArrowExtensionName(eFlatType) == nullptr)
+        return wkbNone;
+    return OGR_GT_SetModifier(eFlatType, OGR_GT_HasZ(eGType),
+                              OGR_GT_HasM(eGType));
+}
+
+/************************************************************************/
+/*                       IsGeoArrowInterleaved()                        */
+/************************************************************************/
+
+/* static */
+bool OGRArrowArrayHelper::IsGeoArrowInterleaved(
+    const CPLStringList &aosArrowArrayStreamOptions)
+{
+    return EQUAL(
+        aosArrowArrayStreamOptions.FetchNameValueDef("GEOMETRY_ENCODING", ""),
+        "GEOARROW_INTERLEAVED");
+}
+
+/************************************************************************/
+/*                      HasGeoArrowGeometryField()                      */
+/************************************************************************/
+
+/* Whether at least one non-ignored geometry field is exported as a GeoArrow
+ * native array. Drivers whose GetNextArrowArray() implementation only knows
+ * how to emit WKB must then defer to OGRLayer::GetNextArrowArray().
+ */
+
+/* static */
+bool OGRArrowArrayHelper::HasGeoArrowGeometryField(
+    const OGRFeatureDefn *poFeatureDefn,
+    const CPLStringList &aosArrowArrayStreamOptions)
+{
+    const int nGeomFieldCount = poFeatureDefn->GetGeomFieldCount();
+    for (int i = 0; i < nGeomFieldCount; ++i)
+    {
+        const auto poGeomFieldDefn = poFeatureDefn->GetGeomFieldDefn(i);
+        if (!poGeomFieldDefn->IsIgnored() &&
+            GetGeoArrowGeometryType(poGeomFieldDefn,
+                                    aosArrowArrayStreamOptions) != wkbNone)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                    CreateSchemaForGeoArrowColumn()                   */
+/************************************************************************/
+
+/* Return a ArrowSchema* corresponding to the GeoArrow native encoding of a
+ * geometry column, with separated (struct) or interleaved (fixed size list)
+ * coordinates.
+ */
+
+/* static */
+struct ArrowSchema *OGRArrowArrayHelper::CreateSchemaForGeoArrowColumn(
+    const OGRGeomFieldDefn *poFieldDefn, OGRwkbGeometryType eGType,
+    bool bInterleaved)
+{
+    const auto eFlatType = wkbFlatten(eGType);
+    const char *pszExtensionName = GetGeoArrowExtensionName(eFlatType);
+    CPLAssert(pszExtensionName);
+    const bool bHasZ = CPL_TO_BOOL(OGR_GT_HasZ(eGType));
+    const bool bHasM = CPL_TO_BOOL(OGR_GT_HasM(eGType));
+    const int nDim = 2 + static_cast<int>(bHasZ) + static_cast<int>(bHasM);
+
+    const auto AllocGeoArrowSchema =
+        [](const char *pszName, const char *pszFormat, int nChildren)
+    {
+        auto psSchema = static_cast<struct ArrowSchema *>(
+            CPLCalloc(1, sizeof(struct ArrowSchema)));
+        psSchema->release = OGRLayer::ReleaseSchema;
+        psSchema->name = CPLStrdup(pszName);
+        psSchema->format = pszFormat;
+        psSchema->n_children = nChildren;
+        if (nChildren)
+        {
+            psSchema->children = static_cast<struct ArrowSchema **>(
+                CPLCalloc(nChildren, sizeof(struct ArrowSchema *)));
+        }
+        return psSchema;
+    };
+
+    const char *pszGeomFieldName = poFieldDefn->GetNameRef();
+    if (pszGeomFieldName[0] == '\0')
+        pszGeomFieldName = OGRLayer::DEFAULT_ARROW_GEOMETRY_NAME;
+
+    // Names of the children of the nested lists, from the outer one
+    const char *const *papszListChildNames = nullptr;
+    static const char *const apszLineString[] = {"vertices"};
+    static const char *const apszMultiPoint[] = {"points"};
+    static const char *const apszPolygon[] = {"rings", "vertices"};
+    static const char *const apszMultiLineString[] = {"linestrings",
+                                                      "vertices"};
+    static const char *const apszMultiPolygon[] = {"polygons", "rings",
+                                                   "vertices"};
+    switch (eFlatType)
+    {
+        case wkbLineString:
+            papszListChildNames = apszLineString;
+            break;
+        case wkbMultiPoint:
+            papszListChildNames = apszMultiPoint;
+            break;
+        case wkbPolygon:
+            papszListChildNames = apszPolygon;
+            break;
+        case wkbMultiLineString:
+            papszListChildNames = apszMultiLineString;
+            break;
+        case wkbMultiPolygon:
+            papszListChildNames = apszMultiPolygon;
+            break;
+        default:
+            break;
+    }
+    const int nLevels = GetGeoArrowListLevels(eFlatType);
+
+    // Coordinates
+    struct ArrowSchema *psSchema = nullptr;
+    const char *pszCoordName =
+        nLevels ? papszListChildNames[nLevels - 1] : pszGeomFieldName;
+    if (bInterleaved)
+    {
+        static const char *const apszFormats[] = {"+w:2", "+w:3", "+w:4"};
+        psSchema = AllocGeoArrowSchema(pszCoordName, apszFormats[nDim - 2], 1);
+        const char *pszDims = bHasZ && bHasM ? "xyzm"
+                              : bHasZ        ? "xyz"
+                              : bHasM        ? "xym"
+                                             : "xy";
+        psSchema->children[0] = AllocGeoArrowSchema(pszDims, "g", 0);
+    }
+    else
+    {
+        psSchema = AllocGeoArrowSchema(pszCoordName, "+s", nDim);
+        int iChild = 0;
+        for (const char *pszDim : {"x", "y", "z", "m"})
+        {
+            if ((pszDim[0] == 'z' && !bHasZ) || (pszDim[0] == 'm' && !bHasM))
+                continue;
+            psSchema->children[iChild] = AllocGeoArrowSchema(pszDim, "g", 0);
+            ++iChild;
+        }
+    }
+
+    // Nested lists
+    for (int iLevel = nLevels - 1; iLevel >= 0; --iLevel)
+    {
+        auto psList = AllocGeoArrowSchema(
+            iLevel ? papszListChildNames[iLevel - 1] : pszGeomFieldName, "+l",
+            1);
+        psList->children[0] = psSchema;
+        psSchema = psList;
+    }
+
+    if (poFieldDefn->IsNullable())
+        psSchema->flags = ARROW_FLAG_NULLABLE;
+
+    std::vector<std::pair<std::string, std::string>> aoMetadata;
+    aoMetadata.emplace_back(ARROW_EXTENSION_NAME_KEY, pszExtensionName);
+    const auto poSRS = poFieldDefn->GetSpatialRef();
+    if (poSRS)
+    {
+        char *pszPROJJSON = nullptr;
+        poSRS->exportToPROJJSON(&pszPROJJSON, nullptr);
+        if (pszPROJJSON)
+        {
+            aoMetadata.emplace_back(ARROW_EXTENSION_METADATA_KEY,
+                                    std::string("{\"crs\":")
+                                        .append(pszPROJJSON)
+                                        .append("}"));
+            CPLFree(pszPROJJSON);
+        }
+        else
+        {
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "Cannot export CRS of geometry field %s to PROJJSON",
+                     poFieldDefn->GetNameRef());
+        }
+    }
+
+    size_t nLen = sizeof(int32_t);
+    for (const auto &oPair : aoMetadata)
+    {
+        nLen += sizeof(int32_t) + oPair.first.size() + sizeof(int32_t) +
+                oPair.second.size();
+    }
+    char *pszMetadata = static_cast<char *>(CPLMalloc(nLen));
+    psSchema->metadata = pszMetadata;
+    size_t offsetMD = 0;
+    *reinterpret_cast<int32_t *>(pszMetadata + offsetMD) =
+        static_cast<int32_t>(aoMetadata.size());
+    offsetMD += sizeof(int32_t);
+    for (const auto &oPair : aoMetadata)
+    {
+        for (const std::string *posStr : {&oPair.first, &oPair.second})
+        {
+            *reinterpret_cast<int32_t *>(pszMetadata + offsetMD) =
+                static_cast<int32_t>(posStr->size());
+            offsetMD += sizeof(int32_t);
+            memcpy(pszMetadata + offsetMD, posStr->data(), posStr->size());
+            offsetMD += posStr->size();
+        }
+    }
+    CPLAssert(offsetMD == nLen);
+    CPL_IGNORE_RET_VAL(offsetMD);
+
+    return psSchema;
+}
+
+/************************************************************************/
+/*                          OGRGeoArrowBuilder                          */
+/************************************************************************/
+
+namespace
+{
+// Appends geometries to the buffers of a GeoArrow native array. Run a first
+// time with m_bWrite = false to count the elements of each level, and then
+// with m_bWrite = true once the buffers are allocated.
+class OGRGeoArrowBuilder
+{
+    const OGRwkbGeometryType m_eFlatType;
+    const bool m_bHasZ;
+    const bool m_bHasM;
+    const bool m_bInterleaved;
+    const int m_nDim;
+    const int m_nLevels;
+
+    void CloseLevel(int iLevel)
+    {
+        if (m_bWrite)
+        {
+            m_apanOffsets[iLevel][m_anCount[iLevel] + 1] =
+                static_cast<int32_t>(m_anCount[iLevel + 1]);
+        }
+        ++m_anCount[iLevel];
+    }
+
+    void AddPoint(const OGRPoint *poPoint)
+    {
+        if (m_bWrite)
+        {
+            const size_t iCoord = m_anCount[m_nLevels];
+            double adfCoords[4];
+            if (poPoint == nullptr || poPoint->IsEmpty())
+            {
+                std::fill(adfCoords, adfCoords + 4,
+                          std::numeric_limits<double>::quiet_NaN());
+            }
+            else
+            {
+                int iDim = 0;
+                adfCoords[iDim++] = poPoint->getX();
+                adfCoords[iDim++] = poPoint->getY();
+                if (m_bHasZ)
+                    adfCoords[iDim++] = poPoint->getZ();
+                if (m_bHasM)
+                    adfCoords[iDim++] = poPoint->getM();
+            }
+            if (m_bInterleaved)
+            {
+                memcpy(m_apadfCoords[0] + iCoord * m_nDim, adfCoords,
+                       m_nDim * sizeof(double));
+            }
+            else
+            {
+                for (int iDim = 0; iDim < m_nDim; ++iDim)
+                    m_apadfCoords[iDim][iCoord] = adfCoords[iDim];
+            }
+        }
+        ++m_anCount[m_nLevels];
+    }
+
+    void AddCurve(const OGRSimpleCurve *poCurve)
+    {
+        if (m_bWrite)
+        {
+            const size_t iCoord = m_anCount[m_nLevels];
+            if (m_bInterleaved)
+            {
+                double *padf = m_apadfCoords[0] + iCoord * m_nDim;
+                const int nStride = static_cast<int>(sizeof(double)) * m_nDim;
+                poCurve->getPoints(padf, nStride, padf + 1, nStride,
+                                   m_bHasZ ? padf + 2 : nullptr, nStride,
+                                   m_bHasM ? padf + 2 + m_bHasZ : nullptr,
+                                   nStride);
+            }
+            else
+            {
+                constexpr int nStride = static_cast<int>(sizeof(double));
+                poCurve->getPoints(
+                    m_apadfCoords[0] + iCoord, nStride,
+                    m_apadfCoords[1] + iCoord, nStride,
+                    m_bHasZ ? m_apadfCoords[2] + iCoord : nullptr, nStride,
+                    m_bHasM ? m_apadfCoords[2 + m_bHasZ] + iCoord : nullptr,
+                    nStride);
+            }
+        }
+        m_anCount[m_nLevels] += poCurve->getNumPoints();
+    }
+
+    void AddPolygon(const OGRPolygon *poPolygon, int iRingLevel)
+    {
+        for (const auto *poRing : *poPolygon)
+        {
+            AddCurve(poRing);
+            CloseLevel(iRingLevel);
+        }
+    }
+
+  public:
+    // Number of elements of each nested list level, and number of
+    // coordinates at index m_nLevels
+    size_t m_anCount[4] = {0, 0, 0, 0};
+    int32_t *m_apanOffsets[3] = {nullptr, nullptr, nullptr};
+    double *m_apadfCoords[4] = {nullptr, nullptr, nullptr, nullptr};
+    bool m_bWrite = false;
+
+    OGRGeoArrowBuilder(OGRwkbGeometryType eGType, bool bInterleaved)
+        : m_eFlatType(wkbFlatten(eGType)),
+          m_bHasZ(CPL_TO_BOOL(OGR_GT_HasZ(eGType))),
+          m_bHasM(CPL_TO_BOOL(OGR_GT_HasM(eGType))),
+          m_bInterleaved(bInterleaved),
+          m_nDim(2 + static_cast<int>(m_bHasZ) + static_cast<int>(m_bHasM)),
+          m_nLevels(GetGeoArrowListLevels(m_eFlatType))
+    {
+    }
+
+    int GetLevels() const
+    {
+        return m_nLevels;
+    }
+
+    int GetDim() const
+    {
+        return m_nDim;
+    }
+
+    size_t GetMemSize() const
+    {
+        size_t nSize = m_anCount[m_nLevels] * m_nDim * sizeof(double);
+        for (int iLevel = 0; iLevel < m_nLevels; ++iLevel)
+            nSize += (m_anCount[iLevel] + 1) * sizeof(int32_t);
+        return nSize;
+    }
+
+    // Null and empty geometries are emitted as empty lists, or as a point
+    // with NaN coordinates.
+    bool AddGeometry(const OGRGeometry *poGeom)
+    {
+        if (poGeom == nullptr)
+        {
+            if (m_nLevels == 0)
+                AddPoint(nullptr);
+            else
+                CloseLevel(0);
+            return true;
+        }
+
+        auto eGeomFlatType = wkbFlatten(poGeom->getGeometryType());
+        if (eGeomFlatType != m_eFlatType &&
+            OGR_GT_GetCollection(m_eFlatType) == eGeomFlatType &&
+            poGeom->toGeometryCollection()->getNumGeometries() == 1)
+        {
+            // Single part collection where a single geometry is expected
+            poGeom = poGeom->toGeometryCollection()->getGeometryRef(0);
+            eGeomFlatType = wkbFlatten(poGeom->getGeometryType());
+        }
+        const bool bPromoteToMulti =
+            eGeomFlatType != m_eFlatType &&
+            OGR_GT_GetCollection(eGeomFlatType) == m_eFlatType;
+        if (eGeomFlatType != m_eFlatType && !bPromoteToMulti)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Geometry of type %s cannot be encoded in a GeoArrow "
+                     "%s array. Use the GEOMETRY_ENCODING=WKB option",
+                     OGRToOGCGeomType(eGeomFlatType),
+                     GetGeoArrowExtensionName(m_eFlatType));
+            return false;
+        }
+
+        switch (m_eFlatType)
+        {
+            case wkbPoint:
+                AddPoint(poGeom->toPoint());
+                break;
+
+            case wkbLineString:
+                AddCurve(poGeom->toLineString());
+                CloseLevel(0);
+                break;
+
+            case wkbPolygon:
+                AddPolygon(poGeom->toPolygon(), 1);
+                CloseLevel(0);
+                break;
+
+            case wkbMultiPoint:
+                if (bPromoteToMulti)
+                {
+                    if (!poGeom->IsEmpty())
+                        AddPoint(poGeom->toPoint());
+                }
+                else
+                {
+                    for (const auto *poPoint : *(poGeom->toMultiPoint()))
+                        AddPoint(poPoint);
+                }
+                CloseLevel(0);
+                break;
+
+            case wkbMultiLineString:
+                if (bPromoteToMulti)
+                {
+                    if (!poGeom->IsEmpty())
+                    {
+                        AddCurve(poGeom->toLineString());
+                        CloseLevel(1);
+                    }
+                }
+                else
+                {
+                    for (const auto *poLS : *(poGeom->toMultiLineString()))
+                    {
+                        AddCurve(poLS);
+                        CloseLevel(1);
+                    }
+                }
+                CloseLevel(0);
+                break;
+
+            case wkbMultiPolygon:
+                if (bPromoteToMulti)
+                {
+                    if (!poGeom->IsEmpty())
+                    {
+                        AddPolygon(poGeom->toPolygon(), 2);
+                        CloseLevel(1);
+                    }
+                }
+                else
+                {
+                    for (const auto *poPoly : *(poGeom->toMultiPolygon()))
+                    {
+                        AddPolygon(poPoly, 2);
+                        CloseLevel(1);
+                    }
+                }
+                CloseLevel(0);
+                break;
+
+            default:
+                CPLAssert(false);
+                break;
+        }
+        return true;
+    }
+};
+}  // namespace
+
+/************************************************************************/
+/*                         FillGeoArrowArray()                          */
+/************************************************************************/
+
+/* Fill psArray, whose release callback is already set, with the GeoArrow
+ * native encoding of apoGeoms, as described by
+ * CreateSchemaForGeoArrowColumn(). Only the first geometries whose
+ * coordinates fit into nMemLimit bytes are written, and their number is
+ * returned in nFeatCountOut.
+ */
+
+/* static */
+bool OGRArrowArrayHelper::FillGeoArrowArray(
+    struct ArrowArray *psArray,
+    const std::vector<const OGRGeometry *> &apoGeoms,
+    OGRwkbGeometryType eGType, bool bInterleaved, bool bIsNullable,
+    size_t nMemLimit, size_t &nFeatCountOut)
+{
+    nFeatCountOut = 0;
+    OGRGeoArrowBuilder oBuilder(eGType, bInterleaved);
+    const int nLevels = oBuilder.GetLevels();
+    const int nDim = oBuilder.GetDim();
+
+    // First pass to count elements and check geometry types
+    size_t nFeatCount = 0;
+    for (; nFeatCount < apoGeoms.size(); ++nFeatCount)
+    {
+        size_t anCountBackup[4];
+        memcpy(anCountBackup, oBuilder.m_anCount, sizeof(anCountBackup));
+        if (!oBuilder.AddGeometry(apoGeoms[nFeatCount]))
+            return false;
+        if (oBuilder.GetMemSize() > nMemLimit)
+        {
+            if (nFeatCount == 0)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Too large feature: not even a single feature can "
+                         "be returned");
+                return false;
+            }
+            memcpy(oBuilder.m_anCount, anCountBackup, sizeof(anCountBackup));
+            break;
+        }
+    }
+
+    // Allocate the nested list arrays, and then the coordinate one
+    size_t anCount[4];
+    memcpy(anCount, oBuilder.m_anCount, sizeof(anCount));
+    struct ArrowArray *psLevel = psArray;
+    for (int iLevel = 0; iLevel < nLevels; ++iLevel)
+    {
+        psLevel->length = static_cast<int64_t>(anCount[iLevel]);
+        psLevel->n_buffers = 2;
+        psLevel->buffers =
+            static_cast<const void **>(CPLCalloc(2, sizeof(void *)));
+        auto panOffsets =
+            static_cast<int32_t *>(VSI_MALLOC_ALIGNED_AUTO_VERBOSE(
+                sizeof(int32_t) * (1 + anCount[iLevel])));
+        if (panOffsets == nullptr)
+            return false;
+        panOffsets[0] = 0;
+        psLevel->buffers[1] = panOffsets;
+        oBuilder.m_apanOffsets[iLevel] = panOffsets;
+
+        psLevel->n_children = 1;
+        psLevel->children = static_cast<struct ArrowArray **>(
+            CPLCalloc(1, sizeof(struct ArrowArray *)));
+        psLevel->children[0] = static_cast<struct ArrowArray *>(
+            CPLCalloc(1, sizeof(struct ArrowArray)));
+        psLevel = psLevel->children[0];
+        psLevel->release = OGRLayer::ReleaseArray;
+    }
+
+    const size_t nCoords = anCount[nLevels];
+    psLevel->length = static_cast<int64_t>(nCoords);
+    psLevel->n_buffers = 1;
+    psLevel->buffers = static_cast<const void **>(CPLCalloc(1, sizeof(void *)));
+    const int nCoordChildren = bInterleaved ? 1 : nDim;
+    const size_t nValuesPerChild = bInterleaved ? nCoords * nDim : nCoords;
+    psLevel->n_children = nCoordChildren;
+    psLevel->children = static_cast<struct ArrowArray **>(
+        CPLCalloc(nCoordChildren, sizeof(struct ArrowArray *)));
+    for (int iChild = 0; iChild < nCoordChildren; ++iChild)
+    {
+        psLevel->children[iChild] = static_cast<struct ArrowArray *>(
+            CPLCalloc(1, sizeof(struct ArrowArray)));
+        auto psValues = psLevel->children[iChild];
+        psValues->release = OGRLayer::ReleaseArray;
+        psValues->length = static_cast<int64_t>(nValuesPerChild);
+        psValues->n_buffers = 2;
+        psValues->buffers =
+            static_cast<const void **>(CPLCalloc(2, sizeof(void *)));
+        auto padfValues = static_cast<double *>(VSI_MALLOC_ALIGNED_AUTO_VERBOSE(
+            sizeof(double) * std::max<size_t>(1, nValuesPerChild)));
+        if (padfValues == nullptr)
+            return false;
+        psValues->buffers[1] = padfValues;
+        oBuilder.m_apadfCoords[iChild] = padfValues;
+    }
+
+    // Second pass to write values
+    oBuilder.m_bWrite = true;
+    std::fill(oBuilder.m_anCount, oBuilder.m_anCount + 4, 0);
+    uint8_t *pabyValidity = nullptr;
+    for (size_t iFeat = 0; iFeat < nFeatCount; ++iFeat)
+    {
+        CPL_IGNORE_RET_VAL(oBuilder.AddGeometry(apoGeoms[iFeat]));
+        if (apoGeoms[iFeat] == nullptr && bIsNullable)
+        {
+            if (pabyValidity == nullptr)
+            {
+                pabyValidity = static_cast<uint8_t *>(
+                    VSI_MALLOC_ALIGNED_AUTO_VERBOSE((nFeatCount + 7) / 8));
+                if (pabyValidity == nullptr)
+                    return false;
+                memset(pabyValidity, 0xFF, (nFeatCount + 7) / 8);
+                psArray->buffers[0] = pabyValidity;
+            }
+            ++psArray->null_count;
+            pabyValidity[iFeat / 8] &=
+                static_cast<uint8_t>(~(1 << (iFeat % 8)));
+        }
+    }
+    CPLAssert(memcmp(anCount, oBuilder.m_anCount, sizeof(anCount)) == 0);
+
+    nFeatCountOut = nFeatCount;
+    return true;
+}
+
+/************************************************************************/
+/*                         GetGeoArrowCoordDim()                        */
+/************************************************************************/
+
+static bool GetGeoArrowCoordDim(const struct ArrowSchema *schema,
+                                bool &bInterleaved, bool &bHasZ, bool &bHasM)
+{
+    const char *format = schema->format;
+    int nDim = 0;
+    const char *pszThirdDim = nullptr;
+    if (strcmp(format, "+s") == 0)
+    {
+        bInterleaved = false;
+        nDim = static_cast<int>(schema->n_children);
+        if (nDim < 2 || nDim > 4)
+            return false;
+        for (int i = 0; i < nDim; ++i)
+        {
+            if (strcmp(schema->children[i]->format, "g") != 0)
+                return false;
+        }
+        if (nDim == 3 && schema->children[2]->name)
+            pszThirdDim = schema->children[2]->name;
+    }
+    else if (STARTS_WITH(format, "+w:"))
+    {
+        bInterleaved = true;
+        nDim = atoi(format + strlen("+w:"));
+        if (nDim < 2 || nDim > 4 || schema->n_children != 1 ||
+            strcmp(schema->children[0]->format, "g") != 0)
+        {
+            return false;
+        }
+        if (nDim == 3 && schema->children[0]->name &&
+            strcmp(schema->children[0]->name, "xym") == 0)
+        {
+            pszThirdDim = "m";
+        }
+    }
+    else
+    {
+        return false;
+    }
+    const bool bThirdIsM = pszThirdDim && EQUAL(pszThirdDim, "m");
+    bHasZ = nDim == 4 || (nDim == 3 && !bThirdIsM);
+    bHasM = nDim == 4 || (nDim == 3 && bThirdIsM);
+    return true;
+}
+
+/************************************************************************/
+/*                  GetGeometryTypeFromGeoArrowSchema()                 */
+/************************************************************************/
+
+/* Return the geometry type, with its Z/M flags, of a column of a GeoArrow
+ * native type (identified by its ARROW:extension:name metadata item), wkbNone
+ * if the column is not of a GeoArrow native type, or wkbUnknown (with
+ * osErrorMsg set) if its layout does not match its extension name.
+ */
+
+/* static */
+OGRwkbGeometryType OGRArrowArrayHelper::GetGeometryTypeFromGeoArrowSchema(
+    const struct ArrowSchema *schema, bool &bInterleaved,
+    std::string &osErrorMsg)
+{
+    bInterleaved = false;
+    if (schema->metadata == nullptr)
+        return wkbNone;
+    const auto oMetadata = OGRParseArrowMetadata(schema->metadata);
+    const auto oIter = oMetadata.find(ARROW_EXTENSION_NAME_KEY);
+    if (oIter == oMetadata.end())
+        return wkbNone;
+    OGRwkbGeometryType eFlatType = wkbNone;
+    for (const auto &sType : asGeoArrowTypes)
+    {
+        if (oIter->second == sType.pszExtensionName)
+        {
+            eFlatType = sType.eFlatType;
+            break;
+        }
+    }
+    if (eFlatType == wkbNone)
+        return wkbNone;
+
+    const int nLevels = GetGeoArrowListLevels(eFlatType);
+    const struct ArrowSchema *psLevel = schema;
+    for (int iLevel = 0; iLevel < nLevels; ++iLevel)
+    {
+        if (strcmp(psLevel->format, "+l") != 0 || psLevel->n_children != 1)
+        {
+            osErrorMsg = std::string("Column ")
+                             .append(schema->name)
+                             .append(" of type ")
+                             .append(oIter->second)
+                             .append(" should be made of lists ('+l')");
+            return wkbUnknown;
+        }
+        psLevel = psLevel->children[0];
+    }
+    bool bHasZ = false;
+    bool bHasM = false;
+    if (!GetGeoArrowCoordDim(psLevel, bInterleaved, bHasZ, bHasM))
+    {
+        osErrorMsg = std::string("Column ")
+                         .append(schema->name)
+                         .append(" of type ")
+                         .append(oIter->second)
+                         .append(" should have coordinates of type struct "
+                                 "('+s') or fixed size list ('+w:N') of "
+                                 "float64 values");
+        return wkbUnknown;
+    }
+    return OGR_GT_SetModifier(eFlatType, bHasZ, bHasM);
+}
+
+/************************************************************************/
+/*                          OGRGeoArrowReader                           */
+/************************************************************************/
+
+namespace
+{
+// Builds the geometry of a row of a GeoArrow native array
+class OGRGeoArrowReader
+{
+    const OGRwkbGeometryType m_eFlatType;
+    const bool m_bHasZ;
+    const bool m_bHasM;
+    const bool m_bInterleaved;
+    const int m_nDim;
+    const int m_nLevels;
+    const struct ArrowArray *m_apsLevels[4] = {nullptr, nullptr, nullptr,
+                                               nullptr};
+    const double *m_apadfCoords[4] = {nullptr, nullptr, nullptr, nullptr};
+
+    void GetRange(int iLevel, size_t i, size_t &nStart, size_t &nEnd) const
+    {
+        const auto psArray = m_apsLevels[iLevel];
+        const int32_t *panOffsets =
+            static_cast<const int32_t *>(psArray->buffers[1]) +
+            static_cast<size_t>(psArray->offset);
+        nStart = static_cast<size_t>(panOffsets[i]);
+        nEnd = static_cast<size_t>(panOffsets[i + 1]);
+    }
+
+    double GetCoord(size_t iCoord, int iDim) const
+    {
+        return m_bInterleaved ? m_apadfCoords[0][iCoord * m_nDim + iDim]
+                              : m_apadfCoords[iDim][iCoord];
+    }
+
+    OGRPoint *ReadPoint(size_t iCoord) const
+    {
+        const double dfX = GetCoord(iCoord, 0);
+        const double dfY = GetCoord(iCoord, 1);
+        if (std::isnan(dfX) && std::isnan(dfY))
+        {
+            auto poPoint = new OGRPoint();
+            poPoint->set3D(m_bHasZ);
+            poPoint->setMeasured(m_bHasM);
+            return poPoint;
+        }
+        if (m_bHasZ && m_bHasM)
+            return new OGRPoint(dfX, dfY, GetCoord(iCoord, 2),
+                                GetCoord(iCoord, 3));
+        if (m_bHasZ)
+            return new OGRPoint(dfX, dfY, GetCoord(iCoord, 2));
+        if (m_bHasM)
+            return OGRPoint::createXYM(dfX, dfY, GetCoord(iCoord, 2));
+        return new OGRPoint(dfX, dfY);
+    }
+
+    void ReadCurve(OGRSimpleCurve *poCurve, size_t nStart, size_t nEnd) const
+    {
+        const int nPoints = static_cast<int>(nEnd - nStart);
+        if (!m_bInterleaved)
+        {
+            const double *padfX = m_apadfCoords[0] + nStart;
+            const double *padfY = m_apadfCoords[1] + nStart;
+            if (m_bHasZ && m_bHasM)
+                poCurve->setPoints(nPoints, padfX, padfY,
+                                   m_apadfCoords[2] + nStart,
+                                   m_apadfCoords[3] + nStart);
+            else if (m_bHasZ)
+                poCurve->setPoints(nPoints, padfX, padfY,
+                                   m_apadfCoords[2] + nStart);
+            else if (m_bHasM)
+                poCurve->setPointsM(nPoints, padfX, padfY,
+                                    m_apadfCoords[2] + nStart);
+            else
+                poCurve->setPoints(nPoints, padfX, padfY);
+        }
+        else if (m_nDim == 2)
+        {
+            poCurve->setPoints(nPoints, reinterpret_cast<const OGRRawPoint *>(
+                                            m_apadfCoords[0] + nStart * 2));
+        }
+        else
+        {
+            poCurve->setNumPoints(nPoints, FALSE);
+            const double *padf = m_apadfCoords[0] + nStart * m_nDim;
+            for (int i = 0; i < nPoints; ++i, padf += m_nDim)
+            {
+                if (m_bHasZ && m_bHasM)
+                    poCurve->setPoint(i, padf[0], padf[1], padf[2], padf[3]);
+                else if (m_bHasZ)
+                    poCurve->setPoint(i, padf[0], padf[1], padf[2]);
+                else
+                    poCurve->setPointM(i, padf[0], padf[1], padf[2]);
+            }
+        }
+    }
+
+    OGRLineString *ReadLineString(int iLevel, size_t i) const
+    {
+        size_t nStart = 0;
+        size_t nEnd = 0;
+        GetRange(iLevel, i, nStart, nEnd);
+        auto poLS = new OGRLineString();
+        ReadCurve(poLS, nStart, nEnd);
+        return poLS;
+    }
+
+    OGRPolygon *ReadPolygon(int iLevel, size_t i) const
+    {
+        size_t nStart = 0;
+        size_t nEnd = 0;
+        GetRange(iLevel, i, nStart, nEnd);
+        auto poPolygon = new OGRPolygon();
+        for (size_t iRing = nStart; iRing < nEnd; ++iRing)
+        {
+            size_t nRingStart = 0;
+            size_t nRingEnd = 0;
+            GetRange(iLevel + 1, iRing, nRingStart, nRingEnd);
+            auto poRing = new OGRLinearRing();
+            ReadCurve(poRing, nRingStart, nRingEnd);
+            poPolygon->addRingDirectly(poRing);
+        }
+        return poPolygon;
+    }
+
+  public:
+    OGRGeoArrowReader(const struct ArrowArray *array, OGRwkbGeometryType eGType,
+                      bool bInterleaved)
+        : m_eFlatType(wkbFlatten(eGType)),
+          m_bHasZ(CPL_TO_BOOL(OGR_GT_HasZ(eGType))),
+          m_bHasM(CPL_TO_BOOL(OGR_GT_HasM(eGType))),
+          m_bInterleaved(bInterleaved),
+          m_nDim(2 + static_cast<int>(m_bHasZ) + static_cast<int>(m_bHasM)),
+          m_nLevels(GetGeoArrowListLevels(m_eFlatType))
+    {
+        m_apsLevels[0] = array;
+        for (int iLevel = 0; iLevel < m_nLevels; ++iLevel)
+            m_apsLevels[iLevel + 1] = m_apsLevels[iLevel]->children[0];
+        const auto psCoords = m_apsLevels[m_nLevels];
+        const size_t nCoordOffset = static_cast<size_t>(psCoords->offset);
+        if (m_bInterleaved)
+        {
+            const auto psValues = psCoords->children[0];
+            m_apadfCoords[0] =
+                static_cast<const double *>(psValues->buffers[1]) +
+                static_cast<size_t>(psValues->offset) + nCoordOffset * m_nDim;
+        }
+        else
+        {
+            for (int iDim = 0; iDim < m_nDim; ++iDim)
+            {
+                const auto psValues = psCoords->children[iDim];
+                m_apadfCoords[iDim] =
+                    static_cast<const double *>(psValues->buffers[1]) +
+                    static_cast<size_t>(psValues->offset) + nCoordOffset;
+            }
+        }
+    }
+
+    OGRGeometry *Read(size_t iRow) const
+    {
+        OGRGeometry *poGeom = nullptr;
+        size_t nStart = 0;
+        size_t nEnd = 0;
+        switch (m_eFlatType)
+        {
+            case wkbPoint:
+                return ReadPoint(iRow);
+
+            case wkbLineString:
+                poGeom = ReadLineString(0, iRow);
+                break;
+
+            case wkbPolygon:
+                poGeom = ReadPolygon(0, iRow);
+                break;
+
+            case wkbMultiPoint:
+            {
+                GetRange(0, iRow, nStart, nEnd);
+                auto poMP = new OGRMultiPoint();
+                for (size_t i = nStart; i < nEnd; ++i)
+                    poMP->addGeometryDirectly(ReadPoint(i));
+                poGeom = poMP;
+                break;
+            }
+
+            case wkbMultiLineString:
+            {
+                GetRange(0, iRow, nStart, nEnd);
+                auto poMLS = new OGRMultiLineString();
+                for (size_t i = nStart; i < nEnd; ++i)
+                    poMLS->addGeometryDirectly(ReadLineString(1, i));
+                poGeom = poMLS;
+                break;
+            }
+
+            case wkbMultiPolygon:
+            {
+                GetRange(0, iRow, nStart, nEnd);
+                auto poMP = new OGRMultiPolygon();
+                for (size_t i = nStart; i < nEnd; ++i)
+                    poMP->addGeometryDirectly(ReadPolygon(1, i));
+                poGeom = poMP;
+                break;
+            }
+
+            default:
+                CPLAssert(false);
+                return nullptr;
+        }
+        // For empty geometries
+        poGeom->set3D(m_bHasZ);
+        poGeom->setMeasured(m_bHasM);
+        return poGeom;
+    }
+};
+}  // namespace
+
+/************************************************************************/
+/*                     CreateGeometryFromGeoArrow()                     */
+/************************************************************************/
+
+/* Return the geometry of row iRow (relative to array->offset) of a GeoArrow
+ * native array, whose type was returned by
+ * GetGeometryTypeFromGeoArrowSchema(). Validity is not checked.
+ */
+
+/* static */
+OGRGeometry *OGRArrowArrayHelper::CreateGeometryFromGeoArrow(
+    const struct ArrowArray *array, OGRwkbGeometryType eGType,
+    bool bInterleaved, size_t iRow)
+{
+    const OGRGeoArrowReader oReader(array, eGType, bInterleaved);
+    return oReader.Read(iRow);
+}
+
 //! @endcond
@@ -276,6 +276,38 @@ class CPL_DLL OGRArrowArrayHelper
 
     static bool FillDict(struct ArrowArray *psChild,
                          const OGRCodedFieldDomain *poCodedDomain);
+
+    static OGRwkbGeometryType
+    GetGeoArrowGeometryType(const OGRGeomFieldDefn *poFieldDefn,
+                            const CPLStringList &aosArrowArrayStreamOptions);
+
+    static bool
+    IsGeoArrowInterleaved(const CPLStringList &aosArrowArrayStreamOptions);
+
+    static bool
+    HasGeoArrowGeometryField(const OGRFeatureDefn *poFeatureDefn,
+                             const CPLStringList &aosArrowArrayStreamOptions);
+
+    static struct ArrowSchema *
+    CreateSchemaForGeoArrowColumn(const OGRGeomFieldDefn *poFieldDefn,
+                                  OGRwkbGeometryType eGType, bool bInterleaved);
+
+    static bool
+    FillGeoArrowArray(struct ArrowArray *psArray,
+                      const std::vector<const OGRGeometry *> &apoGeoms,
+                      OGRwkbGeometryType eGType, bool bInterleaved,
+                      bool bIsNullable, size_t nMemLimit,
+                      size_t &nFeatCountOut);
+
+    static OGRwkbGeometryType
+    GetGeometryTypeFromGeoArrowSchema(const struct ArrowSchema *schema,
+                                      bool &bInterleaved,
+                                      std::string &osErrorMsg);
+
+    static OGRGeometry *
+    CreateGeometryFromGeoArrow(const struct ArrowArray *array,
+                               OGRwkbGeometryType eGType, bool bInterleaved,
+                               size_t iRow);
 };
 
 //! @endcond
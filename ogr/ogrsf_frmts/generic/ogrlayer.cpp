@@ -37,7 +37,9 @@
 #include "ogrlayer_private.h"
 
 #include "cpl_time.h"
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <limits>
 #include <set>
 
@@ -96,6 +98,7 @@ OGRLayer::~OGRLayer()
 
     if (m_poSharedArrowArrayStreamPrivateData != nullptr)
     {
+        m_poSharedArrowArrayStreamPrivateData->StopPrefetch();
         m_poSharedArrowArrayStreamPrivateData->m_poLayer = nullptr;
     }
 }
@@ -649,6 +652,304 @@ OGRFeatureH OGR_L_GetNextFeature(OGRLayerH hLayer)
     return OGRFeature::ToHandle(OGRLayer::FromHandle(hLayer)->GetNextFeature());
 }
 
+/************************************************************************/
+/*                      InitFeatureBatchColumns()                       */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+static bool IsFeatureBatchColumnFixedSize(const OGRFeatureBatchColumn &sCol,
+                                          const OGRFeatureDefn *poDefn)
+{
+    if (sCol.eType == OBC_FID)
+        return true;
+    if (sCol.eType == OBC_GEOMETRY)
+        return false;
+    const OGRFieldType eType = poDefn->GetFieldDefn(sCol.iField)->GetType();
+    return eType == OFTInteger || eType == OFTInteger64 || eType == OFTReal;
+}
+
+// Check the column requests of a GetNextFeatureBatch() call, and initialize
+// the first offset of variable-sized columns.
+bool OGRLayer::InitFeatureBatchColumns(int nColumns,
+                                       OGRFeatureBatchColumn *pasColumns,
+                                       int nMaxFeatures)
+{
+    if (nColumns < 0 || nMaxFeatures < 0 ||
+        (nColumns > 0 && pasColumns == nullptr))
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "GetNextFeatureBatch(): invalid arguments");
+        return false;
+    }
+
+    const OGRFeatureDefn *poDefn = GetLayerDefn();
+    for (int i = 0; i < nColumns; ++i)
+    {
+        OGRFeatureBatchColumn &sCol = pasColumns[i];
+        if ((sCol.eType == OBC_FIELD &&
+             (sCol.iField < 0 || sCol.iField >= poDefn->GetFieldCount())) ||
+            (sCol.eType == OBC_GEOMETRY &&
+             (sCol.iField < 0 ||
+              sCol.iField >= poDefn->GetGeomFieldCount())) ||
+            (sCol.eType != OBC_FID && sCol.eType != OBC_FIELD &&
+             sCol.eType != OBC_GEOMETRY))
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg,
+                     "GetNextFeatureBatch(): invalid field of column %d", i);
+            return false;
+        }
+        if (IsFeatureBatchColumnFixedSize(sCol, poDefn))
+        {
+            if (sCol.pValues == nullptr && nMaxFeatures > 0)
+            {
+                CPLError(CE_Failure, CPLE_IllegalArg,
+                         "GetNextFeatureBatch(): pValues of column %d "
+                         "should be set",
+                         i);
+                return false;
+            }
+        }
+        else
+        {
+            if (sCol.panOffsets == nullptr)
+            {
+                CPLError(CE_Failure, CPLE_IllegalArg,
+                         "GetNextFeatureBatch(): panOffsets of column %d "
+                         "should be set",
+                         i);
+                return false;
+            }
+            sCol.panOffsets[0] = 0;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                     ReserveFeatureBatchData()                        */
+/************************************************************************/
+
+// Return a pointer where to write nSize bytes for row iRow of a
+// variable-sized column, growing its data buffer if needed.
+static GByte *ReserveFeatureBatchData(OGRFeatureBatchColumn &sCol, int iRow,
+                                      size_t nSize)
+{
+    const size_t nOffset = sCol.panOffsets[iRow];
+    if (nSize > std::numeric_limits<size_t>::max() - nOffset)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "GetNextFeatureBatch(): too large data");
+        return nullptr;
+    }
+    if (nOffset + nSize > sCol.nDataCapacity || sCol.pabyData == nullptr)
+    {
+        size_t nNewCapacity = std::max<size_t>(nOffset + nSize, 4096);
+        if (sCol.nDataCapacity <= std::numeric_limits<size_t>::max() / 2)
+            nNewCapacity = std::max(nNewCapacity, sCol.nDataCapacity * 2);
+        GByte *pabyNew = static_cast<GByte *>(
+            VSI_REALLOC_VERBOSE(sCol.pabyData, nNewCapacity));
+        if (pabyNew == nullptr)
+            return nullptr;
+        sCol.pabyData = pabyNew;
+        sCol.nDataCapacity = nNewCapacity;
+    }
+    sCol.panOffsets[iRow + 1] = nOffset + nSize;
+    return sCol.pabyData + nOffset;
+}
+
+/************************************************************************/
+/*                        FillFeatureBatchRow()                         */
+/************************************************************************/
+
+// Write the values of poFeature in row iRow of the columns.
+bool OGRLayer::FillFeatureBatchRow(const OGRFeature *poFeature, int nColumns,
+                                   OGRFeatureBatchColumn *pasColumns, int iRow)
+{
+    for (int i = 0; i < nColumns; ++i)
+    {
+        OGRFeatureBatchColumn &sCol = pasColumns[i];
+        bool bIsNull = false;
+        if (sCol.eType == OBC_FID)
+        {
+            static_cast<GIntBig *>(sCol.pValues)[iRow] = poFeature->GetFID();
+            bIsNull = poFeature->GetFID() == OGRNullFID;
+        }
+        else if (sCol.eType == OBC_GEOMETRY)
+        {
+            size_t nWkbSize = 0;
+            const GByte *pabyLazyWkb =
+                poFeature->GetGeomFieldLazyWkb(sCol.iField, nWkbSize);
+            uint32_t nRawType = 0;
+            if (pabyLazyWkb && nWkbSize >= 5 && pabyLazyWkb[0] == wkbNDR)
+            {
+                memcpy(&nRawType, pabyLazyWkb + 1, sizeof(nRawType));
+                CPL_LSBPTR32(&nRawType);
+            }
+            // Pending WKB of drivers storing little-endian ISO WKB can be
+            // copied as it is.
+            if (pabyLazyWkb && nRawType > 0 && nRawType < 4000)
+            {
+                GByte *pabyDst =
+                    ReserveFeatureBatchData(sCol, iRow, nWkbSize);
+                if (pabyDst == nullptr)
+                    return false;
+                memcpy(pabyDst, pabyLazyWkb, nWkbSize);
+            }
+            else
+            {
+                const OGRGeometry *poGeom =
+                    poFeature->GetGeomFieldRef(sCol.iField);
+                const size_t nSize = poGeom ? poGeom->WkbSize() : 0;
+                GByte *pabyDst = ReserveFeatureBatchData(sCol, iRow, nSize);
+                if (pabyDst == nullptr)
+                    return false;
+                if (poGeom)
+                    poGeom->exportToWkb(wkbNDR, pabyDst, wkbVariantIso);
+                else
+                    bIsNull = true;
+            }
+        }
+        else
+        {
+            const OGRFieldType eType =
+                poFeature->GetFieldDefnRef(sCol.iField)->GetType();
+            bIsNull = !poFeature->IsFieldSetAndNotNull(sCol.iField);
+            if (eType == OFTInteger)
+            {
+                static_cast<int *>(sCol.pValues)[iRow] =
+                    bIsNull ? 0 : poFeature->GetFieldAsInteger(sCol.iField);
+            }
+            else if (eType == OFTInteger64)
+            {
+                static_cast<GIntBig *>(sCol.pValues)[iRow] =
+                    bIsNull ? 0 : poFeature->GetFieldAsInteger64(sCol.iField);
+            }
+            else if (eType == OFTReal)
+            {
+                static_cast<double *>(sCol.pValues)[iRow] =
+                    bIsNull ? 0.0 : poFeature->GetFieldAsDouble(sCol.iField);
+            }
+            else
+            {
+                const void *pData = nullptr;
+                size_t nSize = 0;
+                if (bIsNull)
+                {
+                    // empty value
+                }
+                else if (eType == OFTBinary)
+                {
+                    int nBytes = 0;
+                    pData = poFeature->GetFieldAsBinary(sCol.iField, &nBytes);
+                    nSize = static_cast<size_t>(nBytes);
+                }
+                else
+                {
+                    const char *pszStr =
+                        poFeature->GetFieldAsString(sCol.iField);
+                    pData = pszStr;
+                    nSize = strlen(pszStr);
+                }
+                GByte *pabyDst = ReserveFeatureBatchData(sCol, iRow, nSize);
+                if (pabyDst == nullptr)
+                    return false;
+                if (nSize)
+                    memcpy(pabyDst, pData, nSize);
+            }
+        }
+        if (sCol.pabyIsNull)
+            sCol.pabyIsNull[iRow] = bIsNull ? 1 : 0;
+    }
+    return true;
+}
+
+//! @endcond
+
+/************************************************************************/
+/*                        GetNextFeatureBatch()                         */
+/************************************************************************/
+
+/**
+ \brief Fill caller-provided column buffers with the values of the next
+ features.
+
+ This is a lighter alternative to the Arrow C stream interface for consumers
+ that want to fetch the values of a few columns of many features, without
+ the per-feature overhead of GetNextFeature() and of the OGR_F_GetFieldXXX()
+ functions. The layout of the buffers is described in OGRFeatureBatchColumn.
+
+ Features are read the same way as with GetNextFeature(): the attribute and
+ spatial filters are honored, and both methods can be mixed. The batch is
+ stopped when nMaxFeatures features have been read or at the end of the
+ layer.
+
+ The default implementation is based on GetNextFeature(). Drivers may
+ override it to avoid building an OGRFeature for each feature.
+
+ This method is the same as the C function OGR_L_GetNextFeatureBatch().
+
+ @param nColumns number of elements of pasColumns.
+ @param pasColumns columns to fill.
+ @param nMaxFeatures maximum number of features to read, which is the
+ capacity of the pValues and pabyIsNull arrays (and that capacity minus one
+ for panOffsets).
+ @return the number of features read (0 at end of layer), or -1 in case of
+ error.
+
+ @since GDAL 3.9
+*/
+
+int OGRLayer::GetNextFeatureBatch(int nColumns,
+                                  OGRFeatureBatchColumn *pasColumns,
+                                  int nMaxFeatures)
+{
+    if (!InitFeatureBatchColumns(nColumns, pasColumns, nMaxFeatures))
+        return -1;
+
+    int nRows = 0;
+    while (nRows < nMaxFeatures)
+    {
+        auto poFeature = std::unique_ptr<OGRFeature>(GetNextFeature());
+        if (poFeature == nullptr)
+            break;
+        if (!FillFeatureBatchRow(poFeature.get(), nColumns, pasColumns, nRows))
+            return -1;
+        ++nRows;
+    }
+    return nRows;
+}
+
+/************************************************************************/
+/*                     OGR_L_GetNextFeatureBatch()                      */
+/************************************************************************/
+
+/**
+ \brief Fill caller-provided column buffers with the values of the next
+ features.
+
+ This function is the same as the C++ method OGRLayer::GetNextFeatureBatch().
+
+ @param hLayer handle to the layer.
+ @param nColumns number of elements of pasColumns.
+ @param pasColumns columns to fill.
+ @param nMaxFeatures maximum number of features to read.
+ @return the number of features read (0 at end of layer), or -1 in case of
+ error.
+
+ @since GDAL 3.9
+*/
+
+int OGR_L_GetNextFeatureBatch(OGRLayerH hLayer, int nColumns,
+                              OGRFeatureBatchColumn *pasColumns,
+                              int nMaxFeatures)
+
+{
+    VALIDATE_POINTER1(hLayer, "OGR_L_GetNextFeatureBatch", -1);
+
+    return OGRLayer::FromHandle(hLayer)->GetNextFeatureBatch(
+        nColumns, pasColumns, nMaxFeatures);
+}
+
 /************************************************************************/
 /*                       ConvertGeomsIfNecessary()                      */
 /************************************************************************/
@@ -1531,6 +1832,207 @@ void OGR_L_SetSpatialFilterRectEx(OGRLayerH hLayer, int iGeomField,
                                                        dfMinY, dfMaxX, dfMaxY);
 }
 
+/************************************************************************/
+/*                            IsRectangle()                             */
+/************************************************************************/
+
+static bool IsRectangle(const OGRGeometry *poGeom)
+{
+    if (wkbFlatten(poGeom->getGeometryType()) != wkbPolygon)
+        return false;
+
+    const OGRPolygon *poPoly = poGeom->toPolygon();
+
+    if (poPoly->getNumInteriorRings() != 0)
+        return false;
+
+    const OGRLinearRing *poRing = poPoly->getExteriorRing();
+    if (poRing == nullptr)
+        return false;
+
+    if (poRing->getNumPoints() > 5 || poRing->getNumPoints() < 4)
+        return false;
+
+    // If the ring has 5 points, the last should be the first.
+    if (poRing->getNumPoints() == 5 && (poRing->getX(0) != poRing->getX(4) ||
+                                        poRing->getY(0) != poRing->getY(4)))
+        return false;
+
+    // Polygon with first segment in "y" direction.
+    if (poRing->getX(0) == poRing->getX(1) &&
+        poRing->getY(1) == poRing->getY(2) &&
+        poRing->getX(2) == poRing->getX(3) &&
+        poRing->getY(3) == poRing->getY(0))
+        return true;
+
+    // Polygon with first segment in "x" direction.
+    if (poRing->getY(0) == poRing->getY(1) &&
+        poRing->getX(1) == poRing->getX(2) &&
+        poRing->getY(2) == poRing->getY(3) &&
+        poRing->getX(3) == poRing->getX(0))
+        return true;
+
+    return false;
+}
+
+/************************************************************************/
+/*                       OGRLayer::Private::~Private()                  */
+/************************************************************************/
+
+OGRLayer::Private::~Private()
+{
+    ResetFilterAccelerators();
+}
+
+/************************************************************************/
+/*                      ResetFilterAccelerators()                       */
+/************************************************************************/
+
+void OGRLayer::Private::ResetFilterAccelerators()
+{
+    m_bFilterHasInnerRect = false;
+    m_sFilterInnerRect = OGREnvelope();
+    if (m_hFilterPartsQuadTree)
+    {
+        CPLQuadTreeDestroy(m_hFilterPartsQuadTree);
+        m_hFilterPartsQuadTree = nullptr;
+    }
+}
+
+/************************************************************************/
+/*                     InstallFilterAccelerators()                      */
+/************************************************************************/
+
+void OGRLayer::Private::InstallFilterAccelerators(
+    OGRGeometry *poFilter, OGRPreparedGeometry *poPreparedFilter)
+{
+    ResetFilterAccelerators();
+
+    OGREnvelope sFilterEnvelope;
+    poFilter->getEnvelope(&sFilterEnvelope);
+    const auto eType = wkbFlatten(poFilter->getGeometryType());
+
+    /* -------------------------------------------------------------------- */
+    /*      Index the envelopes of the parts of multi-part filters.         */
+    /* -------------------------------------------------------------------- */
+    if (OGR_GT_IsSubClassOf(eType, wkbGeometryCollection))
+    {
+        const auto poGC = poFilter->toGeometryCollection();
+        if (poGC->getNumGeometries() >= 2)
+        {
+            CPLRectObj sGlobalBounds;
+            sGlobalBounds.minx = sFilterEnvelope.MinX;
+            sGlobalBounds.miny = sFilterEnvelope.MinY;
+            sGlobalBounds.maxx = sFilterEnvelope.MaxX;
+            sGlobalBounds.maxy = sFilterEnvelope.MaxY;
+            m_hFilterPartsQuadTree = CPLQuadTreeCreate(&sGlobalBounds, nullptr);
+            size_t iPart = 0;
+            for (const auto *poPart : *poGC)
+            {
+                ++iPart;
+                if (poPart->IsEmpty())
+                    continue;
+                OGREnvelope sPartEnvelope;
+                poPart->getEnvelope(&sPartEnvelope);
+                CPLRectObj sBounds;
+                sBounds.minx = sPartEnvelope.MinX;
+                sBounds.miny = sPartEnvelope.MinY;
+                sBounds.maxx = sPartEnvelope.MaxX;
+                sBounds.maxy = sPartEnvelope.MaxY;
+                // Only the presence of a part matters, not its identity
+                CPLQuadTreeInsertWithBounds(m_hFilterPartsQuadTree,
+                                            reinterpret_cast<void *>(iPart),
+                                            &sBounds);
+            }
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Find a rectangle inside surface filters, centered on a point    */
+    /*      on surface, and with the aspect ratio of the filter envelope,   */
+    /*      by dichotomy on its size.                                       */
+    /* -------------------------------------------------------------------- */
+    if (poPreparedFilter == nullptr ||
+        !(OGR_GT_IsSubClassOf(eType, wkbCurvePolygon) ||
+          OGR_GT_IsSubClassOf(eType, wkbMultiSurface)))
+    {
+        return;
+    }
+    const double dfWidth = sFilterEnvelope.MaxX - sFilterEnvelope.MinX;
+    const double dfHeight = sFilterEnvelope.MaxY - sFilterEnvelope.MinY;
+    if (!(dfWidth > 0 && dfHeight > 0))
+        return;
+
+    OGRGeometryH hPoint = OGR_G_PointOnSurface(OGRGeometry::ToHandle(poFilter));
+    if (hPoint == nullptr)
+        return;
+    const auto poPoint = OGRGeometry::FromHandle(hPoint)->toPoint();
+    if (poPoint->IsEmpty())
+    {
+        OGR_G_DestroyGeometry(hPoint);
+        return;
+    }
+    const double dfX = poPoint->getX();
+    const double dfY = poPoint->getY();
+    OGR_G_DestroyGeometry(hPoint);
+
+    const auto GetRectangle = [dfX, dfY, dfWidth, dfHeight](double dfScale)
+    {
+        OGREnvelope sRect;
+        sRect.MinX = dfX - dfScale * dfWidth / 2;
+        sRect.MinY = dfY - dfScale * dfHeight / 2;
+        sRect.MaxX = dfX + dfScale * dfWidth / 2;
+        sRect.MaxY = dfY + dfScale * dfHeight / 2;
+        return sRect;
+    };
+
+    double dfLow = 0;
+    double dfHigh = 1;
+    constexpr int NUM_ITERATIONS = 10;
+    for (int i = 0; i < NUM_ITERATIONS; ++i)
+    {
+        const double dfScale = (dfLow + dfHigh) / 2;
+        const OGREnvelope sRect = GetRectangle(dfScale);
+        auto poRing = new OGRLinearRing();
+        poRing->addPoint(sRect.MinX, sRect.MinY);
+        poRing->addPoint(sRect.MinX, sRect.MaxY);
+        poRing->addPoint(sRect.MaxX, sRect.MaxY);
+        poRing->addPoint(sRect.MaxX, sRect.MinY);
+        poRing->addPoint(sRect.MinX, sRect.MinY);
+        OGRPolygon oRect;
+        oRect.addRingDirectly(poRing);
+        if (OGRPreparedGeometryContains(poPreparedFilter,
+                                        OGRGeometry::ToHandle(&oRect)))
+            dfLow = dfScale;
+        else
+            dfHigh = dfScale;
+    }
+    if (dfLow > 0)
+    {
+        m_bFilterHasInnerRect = true;
+        m_sFilterInnerRect = GetRectangle(dfLow);
+    }
+}
+
+/************************************************************************/
+/*                   FilterEnvelopeIntersectsParts()                    */
+/************************************************************************/
+
+bool OGRLayer::Private::FilterEnvelopeIntersectsParts(
+    const OGREnvelope &sEnvelope) const
+{
+    if (m_hFilterPartsQuadTree == nullptr)
+        return true;
+    CPLRectObj sAoi;
+    sAoi.minx = sEnvelope.MinX;
+    sAoi.miny = sEnvelope.MinY;
+    sAoi.maxx = sEnvelope.MaxX;
+    sAoi.maxy = sEnvelope.MaxY;
+    int nCount = 0;
+    CPLFree(CPLQuadTreeSearch(m_hFilterPartsQuadTree, &sAoi, &nCount));
+    return nCount > 0;
+}
+
 /************************************************************************/
 /*                           InstallFilter()                            */
 /*                                                                      */
@@ -1567,6 +2069,8 @@ int OGRLayer::InstallFilter(OGRGeometry *poFilter)
         m_pPreparedFilterGeom = nullptr;
     }
 
+    m_poPrivate->ResetFilterAccelerators();
+
     if (poFilter != nullptr)
         m_poFilterGeom = poFilter->clone();
 
@@ -1584,39 +2088,11 @@ int OGRLayer::InstallFilter(OGRGeometry *poFilter)
     /* -------------------------------------------------------------------- */
     /*      Now try to determine if the filter is really a rectangle.       */
     /* -------------------------------------------------------------------- */
-    if (wkbFlatten(m_poFilterGeom->getGeometryType()) != wkbPolygon)
-        return TRUE;
+    m_bFilterIsEnvelope = IsRectangle(m_poFilterGeom);
 
-    OGRPolygon *poPoly = m_poFilterGeom->toPolygon();
-
-    if (poPoly->getNumInteriorRings() != 0)
-        return TRUE;
-
-    OGRLinearRing *poRing = poPoly->getExteriorRing();
-    if (poRing == nullptr)
-        return TRUE;
-
-    if (poRing->getNumPoints() > 5 || poRing->getNumPoints() < 4)
-        return TRUE;
-
-    // If the ring has 5 points, the last should be the first.
-    if (poRing->getNumPoints() == 5 && (poRing->getX(0) != poRing->getX(4) ||
-                                        poRing->getY(0) != poRing->getY(4)))
-        return TRUE;
-
-    // Polygon with first segment in "y" direction.
-    if (poRing->getX(0) == poRing->getX(1) &&
-        poRing->getY(1) == poRing->getY(2) &&
-        poRing->getX(2) == poRing->getX(3) &&
-        poRing->getY(3) == poRing->getY(0))
-        m_bFilterIsEnvelope = TRUE;
-
-    // Polygon with first segment in "x" direction.
-    if (poRing->getY(0) == poRing->getY(1) &&
-        poRing->getX(1) == poRing->getX(2) &&
-        poRing->getY(2) == poRing->getY(3) &&
-        poRing->getX(3) == poRing->getX(0))
-        m_bFilterIsEnvelope = TRUE;
+    if (!m_bFilterIsEnvelope)
+        m_poPrivate->InstallFilterAccelerators(m_poFilterGeom,
+                                               m_pPreparedFilterGeom);
 
     return TRUE;
 }
@@ -1699,6 +2175,15 @@ static bool DoesGeometryHavePointInEnvelope(const OGRGeometry *poGeometry,
 //! @cond Doxygen_Suppress
 int OGRLayer::FilterGeometry(OGRGeometry *poGeometry)
 
+{
+    return FilterGeometry(poGeometry, m_pPreparedFilterGeom);
+}
+
+// Variant using the passed prepared geometry (which may be null) instead
+// of m_pPreparedFilterGeom, for use from several threads.
+int OGRLayer::FilterGeometry(OGRGeometry *poGeometry,
+                             OGRPreparedGeometry *poPreparedFilterGeom)
+
 {
     /* -------------------------------------------------------------------- */
     /*      In trivial cases of new filter or target geometry, we accept    */
@@ -1749,6 +2234,14 @@ int OGRLayer::FilterGeometry(OGRGeometry *poGeometry)
                 return true;
         }
 
+        // Geometries inside a rectangle inside the filter intersect it, and
+        // geometries not intersecting the envelope of any filter part don't.
+        if (m_poPrivate->m_bFilterHasInnerRect &&
+            m_poPrivate->m_sFilterInnerRect.Contains(sGeomEnv))
+            return TRUE;
+        if (!m_poPrivate->FilterEnvelopeIntersectsParts(sGeomEnv))
+            return FALSE;
+
         /* --------------------------------------------------------------------
          */
         /*      Fallback to full intersect test (using GEOS) if we still */
@@ -1758,9 +2251,9 @@ int OGRLayer::FilterGeometry(OGRGeometry *poGeometry)
         if (OGRGeometryFactory::haveGEOS())
         {
             // CPLDebug("OGRLayer", "GEOS intersection");
-            if (m_pPreparedFilterGeom != nullptr)
+            if (poPreparedFilterGeom != nullptr)
                 return OGRPreparedGeometryIntersects(
-                    m_pPreparedFilterGeom, OGRGeometry::ToHandle(poGeometry));
+                    poPreparedFilterGeom, OGRGeometry::ToHandle(poGeometry));
             else
                 return m_poFilterGeom->Intersects(poGeometry);
         }
@@ -1796,6 +2289,15 @@ bool OGRLayer::FilterWKBGeometry(const GByte *pabyWKB, size_t nWKBSize,
             {
                 return true;
             }
+            else if (m_poPrivate->m_bFilterHasInnerRect &&
+                     m_poPrivate->m_sFilterInnerRect.Contains(sEnvelope))
+            {
+                return true;
+            }
+            else if (!m_poPrivate->FilterEnvelopeIntersectsParts(sEnvelope))
+            {
+                return false;
+            }
             else if (OGRGeometryFactory::haveGEOS())
             {
                 OGRGeometry *poGeom = nullptr;
@@ -30,6 +30,7 @@
 #define OGRLAYER_PRIVATE_H_INCLUDED
 
 #include "ogrsf_frmts.h"
+#include "cpl_quad_tree.h"
 
 //! @cond Doxygen_Suppress
 struct OGRLayer::Private
@@ -44,6 +45,25 @@ struct OGRLayer::Private
     // We should probably have CreateFieldFromArrowSchema() and
     // WriteArrowBatch() explicitly returning and accepting that mapping.
     std::map<std::string, std::string> m_oMapArrowFieldNameToOGRFieldName{};
+
+    // Computed by InstallFilter() to speed up FilterGeometry() with
+    // non-rectangular filters, by accepting or rejecting candidate geometries
+    // from their envelope, without converting them to GEOS:
+    // - a rectangle inside the filter geometry, when it is a surface;
+    bool m_bFilterHasInnerRect = false;
+    OGREnvelope m_sFilterInnerRect{};
+    // - a quad tree of the envelopes of the parts of multi-part filters.
+    CPLQuadTree *m_hFilterPartsQuadTree = nullptr;
+
+    Private() = default;
+    ~Private();
+
+    void InstallFilterAccelerators(OGRGeometry *poFilter,
+                                   OGRPreparedGeometry *poPreparedFilter);
+    void ResetFilterAccelerators();
+    bool FilterEnvelopeIntersectsParts(const OGREnvelope &sEnvelope) const;
+
+    CPL_DISALLOW_COPY_ASSIGN(Private)
 };
 //! @endcond
 
@@ -37,12 +37,17 @@
 #include "ogr_p.h"
 #include "ogrlayer_private.h"
 
+#include "cpl_error_internal.h"
 #include "cpl_float.h"
 #include "cpl_json.h"
 #include "cpl_time.h"
 #include <cassert>
+#include <algorithm>
 #include <cinttypes>
+#include <condition_variable>
 #include <limits>
+#include <mutex>
+#include <thread>
 #include <utility>
 #include <set>
 
@@ -597,6 +602,19 @@ int OGRLayer::GetArrowSchema(struct ArrowArrayStream *,
                      "Unsupported GEOMETRY_METADATA_ENCODING value: %s",
                      pszGeometryMetadataEncoding);
     }
+    const char *pszGeometryEncoding =
+        m_aosArrowArrayStreamOptions.FetchNameValueDef("GEOMETRY_ENCODING", "");
+    if (!EQUAL(pszGeometryEncoding, "") && !EQUAL(pszGeometryEncoding, "WKB") &&
+        !EQUAL(pszGeometryEncoding, "GEOARROW") &&
+        !EQUAL(pszGeometryEncoding, "GEOARROW_INTERLEAVED"))
+    {
+        CPLError(CE_Warning, CPLE_NotSupported,
+                 "Unsupported GEOMETRY_ENCODING value: %s",
+                 pszGeometryEncoding);
+    }
+    const bool bGeoArrowInterleaved =
+        OGRArrowArrayHelper::IsGeoArrowInterleaved(
+            m_aosArrowArrayStreamOptions);
     for (int i = 0; i < nGeomFieldCount; ++i)
     {
         const auto poFieldDefn = poLayerDefn->GetGeomFieldDefn(i);
@@ -605,8 +623,20 @@ int OGRLayer::GetArrowSchema(struct ArrowArrayStream *,
             continue;
         }
 
-        out_schema->children[iSchemaChild] = CreateSchemaForWKBGeometryColumn(
-            poFieldDefn, "z", pszExtensionName);
+        const auto eGeoArrowType = OGRArrowArrayHelper::GetGeoArrowGeometryType(
+            poFieldDefn, m_aosArrowArrayStreamOptions);
+        if (eGeoArrowType != wkbNone)
+        {
+            out_schema->children[iSchemaChild] =
+                OGRArrowArrayHelper::CreateSchemaForGeoArrowColumn(
+                    poFieldDefn, eGeoArrowType, bGeoArrowInterleaved);
+        }
+        else
+        {
+            out_schema->children[iSchemaChild] =
+                CreateSchemaForWKBGeometryColumn(poFieldDefn, "z",
+                                                 pszExtensionName);
+        }
 
         ++iSchemaChild;
     }
@@ -1466,6 +1496,28 @@ FillFixedWidthBinaryArray(struct ArrowArray *psChild,
     return true;
 }
 
+/************************************************************************/
+/*                        GetPassThroughWKB()                           */
+/************************************************************************/
+
+// Returns the not yet parsed WKB of a geometry field, if it can be copied
+// as it is, that is if it is little-endian ISO WKB, as generated by
+// exportToWkb(wkbNDR, ..., wkbVariantIso).
+static const GByte *GetPassThroughWKB(const OGRFeature *poFeature, int i,
+                                      size_t &nLen)
+{
+    const GByte *pabyWkb = poFeature->GetGeomFieldLazyWkb(i, nLen);
+    bool bNeedSwap = false;
+    uint32_t nType = 0;
+    if (pabyWkb == nullptr || pabyWkb[0] != wkbNDR ||
+        !OGRWKBGetGeomType(pabyWkb, nLen, bNeedSwap, nType) || nType >= 4000)
+    {
+        nLen = 0;
+        return nullptr;
+    }
+    return pabyWkb;
+}
+
 /************************************************************************/
 /*                      FillWKBGeometryArray()                          */
 /************************************************************************/
@@ -1499,17 +1551,22 @@ FillWKBGeometryArray(struct ArrowArray *psChild,
     for (size_t iFeat = 0; iFeat < nFeatureCountLimit; ++iFeat, ++nFeatCount)
     {
         panOffsets[iFeat] = static_cast<T>(nOffset);
-        const auto poGeom = apoFeatures[iFeat]->GetGeomFieldRef(i);
-        if (poGeom != nullptr)
+        size_t nWKBSize = 0;
+        const auto poGeom =
+            GetPassThroughWKB(apoFeatures[iFeat].get(), i, nWKBSize)
+                ? nullptr
+                : apoFeatures[iFeat]->GetGeomFieldRef(i);
+        if (nWKBSize != 0 || poGeom != nullptr)
         {
-            const size_t nLen = poGeom->WkbSize();
-            if (nLen > nMemLimit - nOffset)
+            if (poGeom)
+                nWKBSize = poGeom->WkbSize();
+            if (nWKBSize > nMemLimit - nOffset)
             {
                 if (nFeatCount == 0)
                     return 0;
                 break;
             }
-            nOffset += static_cast<T>(nLen);
+            nOffset += static_cast<T>(nWKBSize);
         }
         else if (bIsNullable)
         {
@@ -1550,8 +1607,19 @@ FillWKBGeometryArray(struct ArrowArray *psChild,
             static_cast<size_t>(panOffsets[iFeat + 1] - panOffsets[iFeat]);
         if (nLen)
         {
-            const auto poGeom = apoFeatures[iFeat]->GetGeomFieldRef(i);
-            poGeom->exportToWkb(wkbNDR, pabyValues + nOffset, wkbVariantIso);
+            size_t nWKBLen = 0;
+            const GByte *pabyWkb =
+                GetPassThroughWKB(apoFeatures[iFeat].get(), i, nWKBLen);
+            if (pabyWkb)
+            {
+                memcpy(pabyValues + nOffset, pabyWkb, nLen);
+            }
+            else
+            {
+                const auto poGeom = apoFeatures[iFeat]->GetGeomFieldRef(i);
+                poGeom->exportToWkb(wkbNDR, pabyValues + nOffset,
+                                    wkbVariantIso);
+            }
             nOffset += nLen;
         }
         else if (!bIsNullable && poEmptyGeom)
@@ -2131,6 +2199,28 @@ int OGRLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
         ++iSchemaChild;
         psChild->release = OGRLayerDefaultReleaseArray;
         psChild->length = oFeatureQueue.size();
+        const auto eGeoArrowType = OGRArrowArrayHelper::GetGeoArrowGeometryType(
+            poFieldDefn, m_aosArrowArrayStreamOptions);
+        if (eGeoArrowType != wkbNone)
+        {
+            std::vector<const OGRGeometry *> apoGeoms;
+            apoGeoms.reserve(nFeatureCount);
+            for (size_t iFeat = 0; iFeat < nFeatureCount; ++iFeat)
+                apoGeoms.push_back(oFeatureQueue[iFeat]->GetGeomFieldRef(i));
+            size_t nThisFeatureCount = 0;
+            if (!OGRArrowArrayHelper::FillGeoArrowArray(
+                    psChild, apoGeoms, eGeoArrowType,
+                    OGRArrowArrayHelper::IsGeoArrowInterleaved(
+                        m_aosArrowArrayStreamOptions),
+                    CPL_TO_BOOL(poFieldDefn->IsNullable()), nMemLimit,
+                    nThisFeatureCount))
+            {
+                goto error;
+            }
+            if (nThisFeatureCount < nFeatureCount)
+                nFeatureCount = nThisFeatureCount;
+            continue;
+        }
         const size_t nThisFeatureCount = FillWKBGeometryArray<int32_t>(
             psChild, oFeatureQueue, nFeatureCount, poFieldDefn, i, nMemLimit);
         if (nThisFeatureCount == 0)
@@ -2172,6 +2262,126 @@ error:
     return ENOMEM;
 }
 
+/************************************************************************/
+/*                            PrefetchState                             */
+/************************************************************************/
+
+// Worker thread that builds the next batches of the generic get_next()
+// implementation while the consumer processes the current one.
+// Only the worker thread accesses the layer while it is running.
+struct OGRLayer::ArrowArrayStreamPrivateData::PrefetchState
+{
+    struct Batch
+    {
+        int nRet = 0;
+        struct ArrowArray sArray
+        {
+        };
+        std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+    };
+
+    OGRLayer *m_poLayer = nullptr;
+    struct ArrowArrayStream m_sStream
+    {
+    };
+    size_t m_nDepth = 1;
+    std::thread m_oThread{};
+    std::mutex m_oMutex{};
+    std::condition_variable m_oCV{};
+    std::deque<Batch> m_aoReady{};
+    bool m_bStop = false;
+    bool m_bFinished = false;
+
+    void Run();
+    bool Get(struct ArrowArray *out_array, int &nRet);
+};
+
+/************************************************************************/
+/*                         PrefetchState::Run()                         */
+/************************************************************************/
+
+void OGRLayer::ArrowArrayStreamPrivateData::PrefetchState::Run()
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> oLock(m_oMutex);
+            m_oCV.wait(oLock, [this]
+                       { return m_bStop || m_aoReady.size() < m_nDepth; });
+            if (m_bStop)
+                break;
+        }
+
+        Batch oBatch;
+        CPLInstallErrorHandlerAccumulator(oBatch.aoErrors);
+        oBatch.nRet = m_poLayer->GetNextArrowArray(&m_sStream, &oBatch.sArray);
+        CPLUninstallErrorHandlerAccumulator();
+        const bool bLast = oBatch.nRet != 0 || oBatch.sArray.release == nullptr;
+
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            m_aoReady.push_back(std::move(oBatch));
+            if (bLast)
+                m_bFinished = true;
+        }
+        m_oCV.notify_all();
+        if (bLast)
+            break;
+    }
+}
+
+/************************************************************************/
+/*                         PrefetchState::Get()                         */
+/************************************************************************/
+
+// Returns false once the worker is finished and all its batches consumed.
+bool OGRLayer::ArrowArrayStreamPrivateData::PrefetchState::Get(
+    struct ArrowArray *out_array, int &nRet)
+{
+    Batch oBatch;
+    {
+        std::unique_lock<std::mutex> oLock(m_oMutex);
+        m_oCV.wait(oLock, [this] { return m_bFinished || !m_aoReady.empty(); });
+        if (m_aoReady.empty())
+            return false;
+        oBatch = std::move(m_aoReady.front());
+        m_aoReady.pop_front();
+    }
+    m_oCV.notify_all();
+
+    // Re-emit in the calling thread the errors the worker got
+    for (const auto &oError : oBatch.aoErrors)
+        CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+    nRet = oBatch.nRet;
+    memcpy(out_array, &oBatch.sArray, sizeof(*out_array));
+    return true;
+}
+
+/************************************************************************/
+/*                            StopPrefetch()                            */
+/************************************************************************/
+
+void OGRLayer::ArrowArrayStreamPrivateData::StopPrefetch()
+{
+    if (m_poPrefetch)
+    {
+        {
+            std::lock_guard<std::mutex> oLock(m_poPrefetch->m_oMutex);
+            m_poPrefetch->m_bStop = true;
+        }
+        m_poPrefetch->m_oCV.notify_all();
+        if (m_poPrefetch->m_oThread.joinable())
+            m_poPrefetch->m_oThread.join();
+        for (auto &oBatch : m_poPrefetch->m_aoReady)
+        {
+            if (oBatch.sArray.release)
+                oBatch.sArray.release(&oBatch.sArray);
+        }
+        m_poPrefetch.reset();
+    }
+    m_bPrefetchChecked = false;
+}
+
 /************************************************************************/
 /*                       StaticGetNextArrowArray()                      */
 /************************************************************************/
@@ -2186,15 +2396,53 @@ error:
 int OGRLayer::StaticGetNextArrowArray(struct ArrowArrayStream *stream,
                                       struct ArrowArray *out_array)
 {
-    auto poLayer = static_cast<ArrowArrayStreamPrivateDataSharedDataWrapper *>(
-                       stream->private_data)
-                       ->poShared->m_poLayer;
+    auto poWrapper =
+        static_cast<ArrowArrayStreamPrivateDataSharedDataWrapper *>(
+            stream->private_data);
+    auto &poShared = poWrapper->poShared;
+    auto poLayer = poShared->m_poLayer;
     if (poLayer == nullptr)
     {
         CPLError(CE_Failure, CPLE_NotSupported,
                  "Calling get_next() on a freed OGRLayer is not supported");
         return EINVAL;
     }
+
+    if (!poShared->m_bPrefetchChecked)
+    {
+        poShared->m_bPrefetchChecked = true;
+        const char *pszDepth =
+            poLayer->m_aosArrowArrayStreamOptions.FetchNameValue(
+                "PREFETCH_DEPTH");
+        if (pszDepth == nullptr)
+            pszDepth = CPLGetConfigOption("OGR_ARROW_STREAM_PREFETCH_DEPTH",
+                                          "0");
+        const int nDepth = std::min(atoi(pszDepth), 16);
+        // Layers with a specialized implementation have their own strategy
+        if (nDepth > 0 && !poLayer->TestCapability(OLCFastGetArrowStream))
+        {
+            CPLDebug("OGR", "Prefetching up to %d Arrow array(s)", nDepth);
+            auto poPrefetch =
+                std::make_shared<ArrowArrayStreamPrivateData::PrefetchState>();
+            poPrefetch->m_poLayer = poLayer;
+            // The worker uses its own copy, as the caller is allowed to move
+            // the stream structure.
+            memcpy(&poPrefetch->m_sStream, stream, sizeof(*stream));
+            poPrefetch->m_sStream.release = nullptr;
+            poPrefetch->m_nDepth = static_cast<size_t>(nDepth);
+            poPrefetch->m_oThread =
+                std::thread([poPrefetch]() { poPrefetch->Run(); });
+            poShared->m_poPrefetch = std::move(poPrefetch);
+        }
+    }
+
+    if (poShared->m_poPrefetch)
+    {
+        int nRet = 0;
+        if (poShared->m_poPrefetch->Get(out_array, nRet))
+            return nRet;
+    }
+
     return poLayer->GetNextArrowArray(stream, out_array);
 }
 
@@ -2235,6 +2483,7 @@ void OGRLayer::ReleaseStream(struct ArrowArrayStream *stream)
     ArrowArrayStreamPrivateDataSharedDataWrapper *poPrivate =
         static_cast<ArrowArrayStreamPrivateDataSharedDataWrapper *>(
             stream->private_data);
+    poPrivate->poShared->StopPrefetch();
     poPrivate->poShared->m_bArrowArrayStreamInProgress = false;
     poPrivate->poShared->m_bEOF = false;
     if (poPrivate->poShared->m_poLayer)
@@ -2357,6 +2606,12 @@ From OGR using the Arrow C Stream data interface</a> tutorial.
  * </li>
  * <li>MAX_FEATURES_IN_BATCH=integer. Maximum number of features to retrieve in
  *     a ArrowArray batch. Defaults to 65 536.</li>
+ * <li>PREFETCH_DEPTH=integer. (GDAL >= 3.9) Only taken into account by the
+ *     generic implementation. Number of batches that a background thread
+ *     builds ahead of the consumer. Defaults to the value of the
+ *     OGR_ARROW_STREAM_PREFETCH_DEPTH configuration option, or 0 (no
+ *     prefetching). When enabled, the layer must not be otherwise used, and
+ *     must not be destroyed, until the stream has been released.</li>
  * <li>TIMEZONE="unknown", "UTC", "(+|:)HH:MM" or any other value supported by
  *     Arrow. (GDAL >= 3.8)
  *     Override the timezone flag nominally provided by
@@ -2375,6 +2630,19 @@ From OGR using the Arrow C Stream data interface</a> tutorial.
  *     ARROW:extension:name=geoarrow.wkb and
  *     ARROW:extension:metadata={"crs": &lt;projjson CRS representation>&gt; are set.
  * </li>
+ * <li>GEOMETRY_ENCODING=WKB/GEOARROW/GEOARROW_INTERLEAVED (GDAL >= 3.9).
+ *     Defaults to WKB. When set to GEOARROW or GEOARROW_INTERLEAVED, geometry
+ *     fields whose declared type is Point, LineString, Polygon, MultiPoint,
+ *     MultiLineString or MultiPolygon (with optional Z and/or M) are returned
+ *     as GeoArrow native arrays (ARROW:extension:name=geoarrow.point, etc.),
+ *     with coordinates stored respectively in a struct of x/y[/z][/m] float64
+ *     arrays, or interleaved in a fixed size list. Other geometry fields are
+ *     still returned as WKB. Single-part geometries are promoted to a
+ *     declared multi-part type, and multi-part geometries made of a single
+ *     part are demoted to a declared single-part type. Other geometries not
+ *     matching the declared type cause an error.
+ *     ARROW:extension:metadata={"crs": &lt;projjson CRS representation>&gt; is
+ *     set when the field has a CRS.</li>
  * </ul>
  *
  * The Arrow/Parquet drivers recognize the following option:
@@ -2551,6 +2819,12 @@ From OGR using the Arrow C Stream data interface</a> tutorial.
 YES.</li>
  * <li>MAX_FEATURES_IN_BATCH=integer. Maximum number of features to retrieve in
  *     a ArrowArray batch. Defaults to 65 536.</li>
+ * <li>PREFETCH_DEPTH=integer. (GDAL >= 3.9) Only taken into account by the
+ *     generic implementation. Number of batches that a background thread
+ *     builds ahead of the consumer. Defaults to the value of the
+ *     OGR_ARROW_STREAM_PREFETCH_DEPTH configuration option, or 0 (no
+ *     prefetching). When enabled, the layer must not be otherwise used, and
+ *     must not be destroyed, until the stream has been released.</li>
  * <li>TIMEZONE="unknown", "UTC", "(+|:)HH:MM" or any other value supported by
  *     Arrow. (GDAL >= 3.8)
  *     Override the timezone flag nominally provided by
@@ -2569,6 +2843,19 @@ YES.</li>
  *     ARROW:extension:name=geoarrow.wkb and
  *     ARROW:extension:metadata={"crs": &lt;projjson CRS representation>&gt; are set.
  * </li>
+ * <li>GEOMETRY_ENCODING=WKB/GEOARROW/GEOARROW_INTERLEAVED (GDAL >= 3.9).
+ *     Defaults to WKB. When set to GEOARROW or GEOARROW_INTERLEAVED, geometry
+ *     fields whose declared type is Point, LineString, Polygon, MultiPoint,
+ *     MultiLineString or MultiPolygon (with optional Z and/or M) are returned
+ *     as GeoArrow native arrays (ARROW:extension:name=geoarrow.point, etc.),
+ *     with coordinates stored respectively in a struct of x/y[/z][/m] float64
+ *     arrays, or interleaved in a fixed size list. Other geometry fields are
+ *     still returned as WKB. Single-part geometries are promoted to a
+ *     declared multi-part type, and multi-part geometries made of a single
+ *     part are demoted to a declared single-part type. Other geometries not
+ *     matching the declared type cause an error.
+ *     ARROW:extension:metadata={"crs": &lt;projjson CRS representation>&gt; is
+ *     set when the field has a CRS.</li>
  * </ul>
  *
  * The Arrow/Parquet drivers recognize the following option:
@@ -5421,6 +5708,46 @@ bool OGRCloneArrowArray(const struct ArrowSchema *schema,
     return OGRCloneArrowArray(schema, src_array, out_array, 0);
 }
 
+/************************************************************************/
+/*                        OGRCompactArrowArray()                        */
+/************************************************************************/
+
+/** Remove in place the rows of a struct array that must not be kept.
+ *
+ * The buffers of the array (and its children) are modified in place, so
+ * this must only be used on arrays whose buffers are not shared.
+ *
+ * In case of failure, array will be let in a released state.
+ *
+ * @param schema Schema of the array. Must *NOT* be NULL.
+ * @param array Array to compact. Must *NOT* be NULL.
+ * @param abyRowsToKeep Vector of array->length elements, set to true for the
+ *                      rows to keep.
+ * @return true if success.
+ */
+bool OGRCompactArrowArray(const struct ArrowSchema *schema,
+                          struct ArrowArray *array,
+                          const std::vector<bool> &abyRowsToKeep)
+{
+    CPLAssert(abyRowsToKeep.size() == static_cast<size_t>(array->length));
+    const size_t nNewLength = static_cast<size_t>(
+        std::count(abyRowsToKeep.begin(), abyRowsToKeep.end(), true));
+    if (nNewLength == abyRowsToKeep.size())
+        return true;
+
+    if (nNewLength == 0)
+    {
+        array->length = 0;
+    }
+    else if (!CompactStructArray(schema, array, 0, abyRowsToKeep, nNewLength))
+    {
+        array->release(array);
+        memset(array, 0, sizeof(*array));
+        return false;
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                  OGRLayer::IsArrowSchemaSupported()                  */
 /************************************************************************/
@@ -5558,6 +5885,22 @@ static bool IsArrowSchemaSupportedInternal(const struct ArrowSchema *schema,
 
     const char *fieldName = schema->name;
     const char *format = schema->format;
+
+    bool bGeoArrowInterleaved = false;
+    std::string osGeoArrowErrorMsg;
+    const auto eGeoArrowType =
+        OGRArrowArrayHelper::GetGeometryTypeFromGeoArrowSchema(
+            schema, bGeoArrowInterleaved, osGeoArrowErrorMsg);
+    if (eGeoArrowType == wkbUnknown)
+    {
+        AppendError(osGeoArrowErrorMsg);
+        return false;
+    }
+    else if (eGeoArrowType != wkbNone)
+    {
+        return true;
+    }
+
     if (IsStructure(format))
     {
         bool bRet = true;
@@ -5817,6 +6160,19 @@ bool OGRLayer::CreateFieldFromArrowSchemaInternal(
 {
     const char *fieldName = schema->name;
     const char *format = schema->format;
+
+    bool bGeoArrowInterleaved = false;
+    std::string osGeoArrowErrorMsg;
+    if (OGRArrowArrayHelper::GetGeometryTypeFromGeoArrowSchema(
+            schema, bGeoArrowInterleaved, osGeoArrowErrorMsg) != wkbNone)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "%s%s is a GeoArrow geometry column. It should be created "
+                 "with CreateGeomField()",
+                 osFieldPrefix.c_str(), fieldName);
+        return false;
+    }
+
     if (IsStructure(format))
     {
         const std::string osNewPrefix(osFieldPrefix + fieldName + ".");
@@ -6169,6 +6525,10 @@ struct FieldInfo
     // OGR data type of the feature passed to FillFeature()
     OGRFieldType eSetFeatureFieldType = OFTMaxType;
     bool bIsGeomCol = false;
+    // Geometry type of a GeoArrow native geometry column, wkbNone for WKB
+    OGRwkbGeometryType eGeoArrowType = wkbNone;
+    bool bGeoArrowInterleaved = false;
+    const struct ArrowSchema *psGeoArrowSchema = nullptr;
     bool bUseDictionary = false;
     bool bUseStringOptim = false;
     int nWidthInBytes = 0;  // only used for decimal fields
@@ -6188,6 +6548,47 @@ static bool BuildOGRFieldInfo(
 {
     const char *fieldName = schema->name;
     const char *format = schema->format;
+
+    bool bGeoArrowInterleaved = false;
+    std::string osGeoArrowErrorMsg;
+    const auto eGeoArrowType =
+        OGRArrowArrayHelper::GetGeometryTypeFromGeoArrowSchema(
+            schema, bGeoArrowInterleaved, osGeoArrowErrorMsg);
+    if (eGeoArrowType == wkbUnknown)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported, "%s",
+                 osGeoArrowErrorMsg.c_str());
+        return false;
+    }
+    else if (eGeoArrowType != wkbNone)
+    {
+        FieldInfo sInfo;
+        sInfo.osName = osFieldPrefix + fieldName;
+        sInfo.format = format;
+        const auto oIter = oMapArrowFieldNameToOGRFieldName.find(sInfo.osName);
+        sInfo.iOGRFieldIdx = poFeatureDefn->GetGeomFieldIndex(
+            oIter != oMapArrowFieldNameToOGRFieldName.end()
+                ? oIter->second.c_str()
+                : sInfo.osName.c_str());
+        if (sInfo.iOGRFieldIdx < 0)
+        {
+            if (poFeatureDefn->GetGeomFieldCount() == 0)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Cannot find OGR geometry field for Arrow array %s",
+                         sInfo.osName.c_str());
+                return false;
+            }
+            sInfo.iOGRFieldIdx = 0;
+        }
+        sInfo.bIsGeomCol = true;
+        sInfo.eGeoArrowType = eGeoArrowType;
+        sInfo.bGeoArrowInterleaved = bGeoArrowInterleaved;
+        sInfo.psGeoArrowSchema = schema;
+        asFieldInfo.emplace_back(std::move(sInfo));
+        return true;
+    }
+
     if (IsStructure(format))
     {
         const std::string osNewPrefix(osFieldPrefix + fieldName + ".");
@@ -6645,6 +7046,12 @@ static size_t GetWorkingBufferSize(const struct ArrowSchema *schema,
 {
     const char *fieldName = schema->name;
     const char *format = schema->format;
+    if (static_cast<size_t>(iArrowIdxInOut) < asFieldInfo.size() &&
+        asFieldInfo[iArrowIdxInOut].psGeoArrowSchema == schema)
+    {
+        ++iArrowIdxInOut;
+        return 0;
+    }
     if (IsStructure(format))
     {
         size_t nRet = 0;
@@ -6820,6 +7227,25 @@ static bool FillFeature(OGRLayer *poLayer, const struct ArrowSchema *schema,
 {
     const char *fieldName = schema->name;
     const char *format = schema->format;
+    if (static_cast<size_t>(iArrowIdxInOut) < asFieldInfo.size() &&
+        asFieldInfo[iArrowIdxInOut].psGeoArrowSchema == schema)
+    {
+        const auto &sInfo = asFieldInfo[iArrowIdxInOut];
+        ++iArrowIdxInOut;
+        const uint8_t *pabyValidity =
+            static_cast<const uint8_t *>(array->buffers[0]);
+        OGRGeometry *poGeometry = nullptr;
+        if (array->null_count == 0 || pabyValidity == nullptr ||
+            TestBit(pabyValidity,
+                    static_cast<size_t>(iFeature + array->offset)))
+        {
+            poGeometry = OGRArrowArrayHelper::CreateGeometryFromGeoArrow(
+                array, sInfo.eGeoArrowType, sInfo.bGeoArrowInterleaved,
+                iFeature);
+        }
+        oFeature.SetGeomFieldDirectly(sInfo.iOGRFieldIdx, poGeometry);
+        return true;
+    }
     if (IsStructure(format))
     {
         const std::string osNewPrefix(osFieldPrefix + fieldName + ".");
@@ -7104,6 +7530,129 @@ static bool FillFeature(OGRLayer *poLayer, const struct ArrowSchema *schema,
     return false;
 }
 
+/************************************************************************/
+/*                OGRLayer::GetArrowBatchSimpleColumns()                */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+/** Resolve the top-level columns of a batch passed to WriteArrowBatch(), for
+ * use by native implementations that read the Arrow buffers directly.
+ *
+ * Returns false, without emitting any error, if at least one column is not
+ * a "simple" one (cf OGRArrowSimpleColumn), in which case the caller should
+ * defer to OGRLayer::WriteArrowBatch(), which handles all cases and emits
+ * the appropriate error messages.
+ */
+bool OGRLayer::GetArrowBatchSimpleColumns(
+    const struct ArrowSchema *schema, const struct ArrowArray *array,
+    CSLConstList papszOptions, std::vector<OGRArrowSimpleColumn> &asColumns)
+{
+    asColumns.clear();
+    if (!IsStructure(schema->format) ||
+        schema->n_children != array->n_children || array->offset != 0)
+    {
+        return false;
+    }
+
+    const auto poLayerDefn = GetLayerDefn();
+    const char *pszFIDName =
+        CSLFetchNameValueDef(papszOptions, "FID", GetFIDColumn());
+    if (!pszFIDName || pszFIDName[0] == 0)
+        pszFIDName = DEFAULT_ARROW_FID_NAME;
+    const char *pszGeomFieldName = CSLFetchNameValueDef(
+        papszOptions, "GEOMETRY_NAME", GetGeometryColumn());
+    if (!pszGeomFieldName || pszGeomFieldName[0] == 0)
+        pszGeomFieldName = DEFAULT_ARROW_GEOMETRY_NAME;
+    const auto &oMapArrowFieldNameToOGRFieldName =
+        m_poPrivate->m_oMapArrowFieldNameToOGRFieldName;
+
+    std::vector<bool> abFieldSeen(poLayerDefn->GetFieldCount(), false);
+    bool bFIDSeen = false;
+    bool bGeometrySeen = false;
+    for (int64_t i = 0; i < schema->n_children; ++i)
+    {
+        const struct ArrowSchema *psChildSchema = schema->children[i];
+        const char *format = psChildSchema->format;
+        if (psChildSchema->dictionary || format[0] == 0 || format[1] != 0 ||
+            strchr("bcCsSiIlfguUzZ", format[0]) == nullptr)
+        {
+            return false;
+        }
+
+        OGRArrowSimpleColumn sColumn;
+        sColumn.format = format;
+        sColumn.array = array->children[i];
+        const std::string osName(psChildSchema->name);
+        if (osName == pszFIDName)
+        {
+            if (bFIDSeen || !(IsInt32(format) || IsInt64(format)))
+                return false;
+            bFIDSeen = true;
+            sColumn.bIsFID = true;
+        }
+        else
+        {
+            const auto oIter = oMapArrowFieldNameToOGRFieldName.find(osName);
+            const std::string &osOGRFieldName =
+                oIter != oMapArrowFieldNameToOGRFieldName.end() ? oIter->second
+                                                                : osName;
+            const int iField =
+                poLayerDefn->GetFieldIndex(osOGRFieldName.c_str());
+            if (iField >= 0)
+            {
+                if (abFieldSeen[iField])
+                    return false;
+                abFieldSeen[iField] = true;
+                const auto eOGRType =
+                    poLayerDefn->GetFieldDefn(iField)->GetType();
+                bool bTypeOK = false;
+                for (const auto &sType : gasArrowTypesToOGR)
+                {
+                    if (strcmp(format, sType.arrowType) == 0)
+                    {
+                        bTypeOK = sType.eType == eOGRType;
+                        break;
+                    }
+                }
+                if (!bTypeOK)
+                    return false;
+                sColumn.iOGRFieldIdx = iField;
+            }
+            else
+            {
+                if (bGeometrySeen || poLayerDefn->GetGeomFieldCount() != 1 ||
+                    !(IsBinary(format) || IsLargeBinary(format)))
+                {
+                    return false;
+                }
+                bool bIsGeometry =
+                    poLayerDefn->GetGeomFieldIndex(osOGRFieldName.c_str()) ==
+                        0 ||
+                    osName == pszGeomFieldName;
+                if (!bIsGeometry && psChildSchema->metadata)
+                {
+                    const auto oMetadata =
+                        OGRParseArrowMetadata(psChildSchema->metadata);
+                    const auto oIterExt =
+                        oMetadata.find(ARROW_EXTENSION_NAME_KEY);
+                    bIsGeometry =
+                        oIterExt != oMetadata.end() &&
+                        (oIterExt->second == EXTENSION_NAME_OGC_WKB ||
+                         oIterExt->second == EXTENSION_NAME_GEOARROW_WKB);
+                }
+                if (!bIsGeometry)
+                    return false;
+                bGeometrySeen = true;
+                sColumn.bIsGeometry = true;
+            }
+        }
+        asColumns.push_back(sColumn);
+    }
+    return true;
+}
+
+//! @endcond
+
 /************************************************************************/
 /*                    OGRLayer::WriteArrowBatch()                       */
 /************************************************************************/
@@ -7125,7 +7674,10 @@ static bool FillFeature(OGRLayer *poLayer, const struct ArrowSchema *schema,
  * CreateFieldFromArrowSchema().
  *
  * Arrays for geometry columns should be of binary or large binary type and
- * contain WKB geometry.
+ * contain WKB geometry. Starting with GDAL 3.9, the base implementation also
+ * accepts GeoArrow native arrays (geoarrow.point, geoarrow.linestring,
+ * geoarrow.polygon, geoarrow.multipoint, geoarrow.multilinestring and
+ * geoarrow.multipolygon extensions), with separated or interleaved coordinates.
  *
  * Note that the passed array may be set to a released state
  * (array->release==NULL) after this call (not by the base implementation,
@@ -7571,7 +8123,10 @@ bool OGRLayer::WriteArrowBatch(const struct ArrowSchema *schema,
  * explicitly with CreateGeomField().
  *
  * Arrays for geometry columns should be of binary or large binary type and
- * contain WKB geometry.
+ * contain WKB geometry. Starting with GDAL 3.9, the base implementation also
+ * accepts GeoArrow native arrays (geoarrow.point, geoarrow.linestring,
+ * geoarrow.polygon, geoarrow.multipoint, geoarrow.multilinestring and
+ * geoarrow.multipolygon extensions), with separated or interleaved coordinates.
  *
  * Note that the passed array may be set to a released state
  * (array->release==NULL) after this call (not by the base implementation,
@@ -30,9 +30,12 @@
 #define OGRLAYERARROW_H_DEFINED
 
 #include "cpl_port.h"
+#include "ogr_recordbatch.h"
 
+#include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
 
 constexpr const char *ARROW_EXTENSION_NAME_KEY = "ARROW:extension:name";
 constexpr const char *ARROW_EXTENSION_METADATA_KEY = "ARROW:extension:metadata";
@@ -46,4 +49,94 @@ bool CPL_DLL OGRCloneArrowArray(const struct ArrowSchema *schema,
                                 const struct ArrowArray *array,
                                 struct ArrowArray *out_array);
 
+bool CPL_DLL OGRCompactArrowArray(const struct ArrowSchema *schema,
+                                  struct ArrowArray *array,
+                                  const std::vector<bool> &abyRowsToKeep);
+
+/** Top-level column of a batch passed to WriteArrowBatch(), whose values
+ * can be directly read by a native implementation.
+ *
+ * Such columns are of a boolean, integer (except uint64), float32, float64,
+ * string or binary type, without dictionary, and are the FID column, the
+ * (single) geometry column, or map to an attribute field of the exact OGR
+ * type implied by the Arrow type. Cf OGRLayer::GetArrowBatchSimpleColumns().
+ */
+struct OGRArrowSimpleColumn
+{
+    const char *format = nullptr;
+    const struct ArrowArray *array = nullptr;
+    int iOGRFieldIdx = -1;  // index of the OGR attribute field, or -1
+    bool bIsFID = false;
+    bool bIsGeometry = false;
+
+    inline bool IsNull(size_t iRow) const
+    {
+        if (array->null_count == 0 || array->buffers[0] == nullptr)
+            return false;
+        const size_t iIdx = iRow + static_cast<size_t>(array->offset);
+        return (static_cast<const uint8_t *>(array->buffers[0])[iIdx / 8] &
+                (1 << (iIdx % 8))) == 0;
+    }
+
+    template <class T> inline T GetValue(size_t iRow) const
+    {
+        return static_cast<const T *>(
+            array->buffers[1])[iRow + static_cast<size_t>(array->offset)];
+    }
+
+    /** Value of a boolean or integer column */
+    inline int64_t GetInt64(size_t iRow) const
+    {
+        switch (format[0])
+        {
+            case 'b':
+            {
+                const size_t iIdx = iRow + static_cast<size_t>(array->offset);
+                return (static_cast<const uint8_t *>(
+                            array->buffers[1])[iIdx / 8] &
+                        (1 << (iIdx % 8))) != 0;
+            }
+            case 'c':
+                return GetValue<int8_t>(iRow);
+            case 'C':
+                return GetValue<uint8_t>(iRow);
+            case 's':
+                return GetValue<int16_t>(iRow);
+            case 'S':
+                return GetValue<uint16_t>(iRow);
+            case 'i':
+                return GetValue<int32_t>(iRow);
+            case 'I':
+                return GetValue<uint32_t>(iRow);
+            default:
+                return GetValue<int64_t>(iRow);
+        }
+    }
+
+    /** Value of a numeric column */
+    inline double GetDouble(size_t iRow) const
+    {
+        if (format[0] == 'f')
+            return GetValue<float>(iRow);
+        if (format[0] == 'g')
+            return GetValue<double>(iRow);
+        return static_cast<double>(GetInt64(iRow));
+    }
+
+    /** Value of a string or binary column */
+    inline const GByte *GetBinary(size_t iRow, size_t &nLen) const
+    {
+        const GByte *pabyData = static_cast<const GByte *>(array->buffers[2]);
+        if (format[0] == 'U' || format[0] == 'Z')
+        {
+            const int64_t nStart = GetValue<int64_t>(iRow);
+            nLen = static_cast<size_t>(GetValue<int64_t>(iRow + 1) - nStart);
+            return pabyData + static_cast<size_t>(nStart);
+        }
+        const int32_t nStart = GetValue<int32_t>(iRow);
+        nLen = static_cast<size_t>(GetValue<int32_t>(iRow + 1) - nStart);
+        return pabyData + nStart;
+    }
+};
+
 #endif  // OGRLAYERARROW_H_DEFINED
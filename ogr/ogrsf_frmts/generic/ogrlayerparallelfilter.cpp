@@ -0,0 +1,206 @@
+/******************************************************************************
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  Parallel evaluation of layer filters
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ogrlayerparallelfilter.h"
+
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
+#include "ogr_api.h"
+
+#include <algorithm>
+
+//! @cond Doxygen_Suppress
+
+/************************************************************************/
+/*                       OGRLayerParallelFilter()                       */
+/************************************************************************/
+
+OGRLayerParallelFilter::OGRLayerParallelFilter(OGRLayer *poLayer)
+    : m_poLayer(poLayer)
+{
+}
+
+/************************************************************************/
+/*                      ~OGRLayerParallelFilter()                       */
+/************************************************************************/
+
+OGRLayerParallelFilter::~OGRLayerParallelFilter()
+{
+    if (m_poJobQueue)
+        m_poJobQueue->WaitCompletion();
+}
+
+/************************************************************************/
+/*                               Reset()                                */
+/************************************************************************/
+
+void OGRLayerParallelFilter::Reset()
+{
+    m_oQueue.clear();
+    m_apoBatch.clear();
+    m_bEOF = false;
+    // The spatial filter may have changed
+    m_apoPreparedFilterGeoms.clear();
+    m_nThreads = 0;
+}
+
+/************************************************************************/
+/*                              IsActive()                              */
+/************************************************************************/
+
+bool OGRLayerParallelFilter::IsActive()
+{
+    if (!m_oQueue.empty())
+        return true;
+    if (m_nThreads == 0)
+    {
+        const char *pszNumThreads =
+            CPLGetConfigOption("OGR_FILTER_NUM_THREADS", "1");
+        if (EQUAL(pszNumThreads, "ALL_CPUS"))
+            m_nThreads = CPLGetNumCPUs();
+        else
+            m_nThreads = atoi(pszNumThreads);
+        m_nThreads = std::max(1, std::min(m_nThreads, 128));
+    }
+    return m_nThreads > 1 && (m_poLayer->m_poFilterGeom != nullptr ||
+                              m_poLayer->m_poAttrQuery != nullptr);
+}
+
+/************************************************************************/
+/*                             FilterJob()                              */
+/************************************************************************/
+
+/* static */ void OGRLayerParallelFilter::FilterJob(void *pData)
+{
+    const JobData *psJob = static_cast<const JobData *>(pData);
+    OGRLayerParallelFilter *poThis = psJob->poThis;
+    OGRLayer *poLayer = poThis->m_poLayer;
+
+    auto &poPreparedFilterGeom = poThis->m_apoPreparedFilterGeoms[psJob->iJob];
+    if (poLayer->m_poFilterGeom && !poPreparedFilterGeom &&
+        OGRHasPreparedGeometrySupport())
+    {
+        poPreparedFilterGeom.reset(OGRCreatePreparedGeometry(
+            OGRGeometry::ToHandle(poLayer->m_poFilterGeom)));
+    }
+
+    for (size_t i = psJob->iStart; i < psJob->iEnd; ++i)
+    {
+        OGRFeature *poFeature = poThis->m_apoBatch[i].get();
+        poThis->m_abyKeep[i] =
+            (poLayer->m_poFilterGeom == nullptr ||
+             poLayer->FilterGeometry(
+                 poFeature->GetGeomFieldRef(poLayer->m_iGeomFieldFilter),
+                 poPreparedFilterGeom.get())) &&
+            (poLayer->m_poAttrQuery == nullptr ||
+             poLayer->m_poAttrQuery->Evaluate(poFeature));
+    }
+}
+
+/************************************************************************/
+/*                             FillQueue()                              */
+/************************************************************************/
+
+// Read a batch of unfiltered features, and append those that pass the
+// filters to m_oQueue. Returns false if no feature could be read.
+bool OGRLayerParallelFilter::FillQueue(
+    const std::function<OGRFeature *()> &fnGetNextUnfiltered)
+{
+    const size_t nBatchSize = static_cast<size_t>(m_nThreads) * 256;
+    m_apoBatch.clear();
+    while (m_apoBatch.size() < nBatchSize)
+    {
+        OGRFeature *poFeature = fnGetNextUnfiltered();
+        if (poFeature == nullptr)
+        {
+            m_bEOF = true;
+            break;
+        }
+        m_apoBatch.emplace_back(poFeature);
+    }
+    if (m_apoBatch.empty())
+        return false;
+
+    const size_t nFeatures = m_apoBatch.size();
+    m_abyKeep.assign(nFeatures, 0);
+    const size_t nJobs = std::min(static_cast<size_t>(m_nThreads),
+                                  (nFeatures + 63) / 64);
+    if (m_apoPreparedFilterGeoms.size() < nJobs)
+        m_apoPreparedFilterGeoms.resize(nJobs);
+
+    std::vector<JobData> asJobs(nJobs);
+    for (size_t iJob = 0; iJob < nJobs; ++iJob)
+    {
+        asJobs[iJob].poThis = this;
+        asJobs[iJob].iJob = iJob;
+        asJobs[iJob].iStart = iJob * nFeatures / nJobs;
+        asJobs[iJob].iEnd = (iJob + 1) * nFeatures / nJobs;
+    }
+
+    CPLWorkerThreadPool *poPool =
+        nJobs > 1 ? GDALGetGlobalThreadPool(m_nThreads) : nullptr;
+    if (poPool && !m_poJobQueue)
+        m_poJobQueue = poPool->CreateJobQueue();
+    for (size_t iJob = 0; iJob < nJobs; ++iJob)
+    {
+        // The last job is run in the current thread
+        if (!m_poJobQueue || iJob + 1 == nJobs ||
+            !m_poJobQueue->SubmitJob(FilterJob, &asJobs[iJob]))
+        {
+            FilterJob(&asJobs[iJob]);
+        }
+    }
+    if (m_poJobQueue)
+        m_poJobQueue->WaitCompletion();
+
+    for (size_t i = 0; i < nFeatures; ++i)
+    {
+        if (m_abyKeep[i])
+            m_oQueue.push_back(std::move(m_apoBatch[i]));
+    }
+    m_apoBatch.clear();
+    return true;
+}
+
+/************************************************************************/
+/*                           GetNextFeature()                           */
+/************************************************************************/
+
+OGRFeature *OGRLayerParallelFilter::GetNextFeature(
+    const std::function<OGRFeature *()> &fnGetNextUnfiltered)
+{
+    while (m_oQueue.empty())
+    {
+        if (m_bEOF || !FillQueue(fnGetNextUnfiltered))
+            return nullptr;
+    }
+    OGRFeature *poFeature = m_oQueue.front().release();
+    m_oQueue.pop_front();
+    return poFeature;
+}
+
+//! @endcond
@@ -0,0 +1,99 @@
+/******************************************************************************
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  Parallel evaluation of layer filters
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef OGRLAYERPARALLELFILTER_H_INCLUDED
+#define OGRLAYERPARALLELFILTER_H_INCLUDED
+
+//! @cond Doxygen_Suppress
+
+#include "ogrsf_frmts.h"
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class CPLJobQueue;
+
+/************************************************************************/
+/*                        OGRLayerParallelFilter                        */
+/************************************************************************/
+
+/** Helper for drivers without native filtering, that reads features in
+ * batches in the calling thread, and evaluates the spatial and attribute
+ * filters of the layer on them in worker threads. Features are returned
+ * in their reading order.
+ *
+ * This is enabled when the OGR_FILTER_NUM_THREADS configuration option is
+ * set to a value greater than 1 (or ALL_CPUS), and a filter is installed.
+ *
+ * The layer must call Reset() in its ResetReading() method, and whenever
+ * the reading position of the underlying reader is changed.
+ */
+class CPL_DLL OGRLayerParallelFilter
+{
+    OGRLayer *m_poLayer = nullptr;
+    int m_nThreads = 0;
+    bool m_bEOF = false;
+    std::deque<std::unique_ptr<OGRFeature>> m_oQueue{};
+    std::vector<std::unique_ptr<OGRFeature>> m_apoBatch{};
+    std::vector<GByte> m_abyKeep{};
+    // One prepared filter geometry per job, since GEOS prepared geometries
+    // cannot be safely used from several threads.
+    std::vector<OGRPreparedGeometryUniquePtr> m_apoPreparedFilterGeoms{};
+    std::unique_ptr<CPLJobQueue> m_poJobQueue{};
+
+    struct JobData
+    {
+        OGRLayerParallelFilter *poThis = nullptr;
+        size_t iJob = 0;
+        size_t iStart = 0;
+        size_t iEnd = 0;
+    };
+
+    static void FilterJob(void *pData);
+    bool FillQueue(const std::function<OGRFeature *()> &fnGetNextUnfiltered);
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRLayerParallelFilter)
+
+  public:
+    explicit OGRLayerParallelFilter(OGRLayer *poLayer);
+    ~OGRLayerParallelFilter();
+
+    /** Whether GetNextFeature() should be used instead of the sequential
+     * filtering loop of the layer. */
+    bool IsActive();
+
+    OGRFeature *
+    GetNextFeature(const std::function<OGRFeature *()> &fnGetNextUnfiltered);
+
+    void Reset();
+};
+
+//! @endcond
+
+#endif /* OGRLAYERPARALLELFILTER_H_INCLUDED */
@@ -33,6 +33,7 @@
 
 #include "cpl_port.h"
 #include "ogrsf_frmts.h"
+#include "ogrlayerparallelfilter.h"
 #include "../mem/ogr_mem.h"
 
 #include <cstdio>
@@ -79,6 +80,13 @@ class OGRGeoJSONLayer final : public OGRMemLayer
     virtual OGRFeature *GetNextFeature() override;
     virtual OGRFeature *GetFeature(GIntBig nFID) override;
     virtual GIntBig GetFeatureCount(int bForce) override;
+    int GetNextFeatureBatch(int nColumns, OGRFeatureBatchColumn *pasColumns,
+                            int nMaxFeatures) override
+    {
+        // Features are post-processed by GetNextFeature()
+        return OGRLayer::GetNextFeatureBatch(nColumns, pasColumns,
+                                             nMaxFeatures);
+    }
 
     OGRErr ISetFeature(OGRFeature *poFeature) override;
     OGRErr ICreateFeature(OGRFeature *poFeature) override;
@@ -124,6 +132,15 @@ class OGRGeoJSONLayer final : public OGRMemLayer
     bool bOriginalIdModified_;
     GIntBig nTotalFeatureCount_;
     GIntBig nFeatureReadSinceReset_ = 0;
+    OGRLayerParallelFilter oParallelFilter_{this};
+
+    // Features selected by the spatial index for the current spatial filter
+    bool bSpatialIndexQueried_ = false;
+    bool bUseSpatialIndexFIDs_ = false;
+    std::vector<GIntBig> anSpatialIndexFIDs_{};
+    size_t nSpatialIndexFIDIdx_ = 0;
+
+    OGRFeature *GetNextFeatureFromSpatialIndex();
 
     bool IngestAll();
     void TerminateAppendSession();
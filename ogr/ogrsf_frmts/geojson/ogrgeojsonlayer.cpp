@@ -130,6 +130,11 @@ void OGRGeoJSONLayer::SetFIDColumn(const char *pszFIDColumn)
 void OGRGeoJSONLayer::ResetReading()
 {
     nFeatureReadSinceReset_ = 0;
+    oParallelFilter_.Reset();
+    bSpatialIndexQueried_ = false;
+    bUseSpatialIndexFIDs_ = false;
+    anSpatialIndexFIDs_.clear();
+    nSpatialIndexFIDIdx_ = 0;
     if (poReader_)
     {
         TerminateAppendSession();
@@ -151,6 +156,33 @@ OGRFeature *OGRGeoJSONLayer::GetNextFeature()
         {
             ResetReading();
         }
+        if (m_poFilterGeom != nullptr && !IsUpdatable())
+        {
+            if (!bSpatialIndexQueried_)
+            {
+                bSpatialIndexQueried_ = true;
+                bUseSpatialIndexFIDs_ =
+                    OGRGeoJSONUseSpatialIndex() &&
+                    poReader_->GetFIDsIntersecting(this, m_sFilterEnvelope,
+                                                   anSpatialIndexFIDs_);
+                if (!bUseSpatialIndexFIDs_)
+                {
+                    // The reader position may have been changed by the
+                    // establishment of the index.
+                    poReader_->ResetReading();
+                }
+            }
+            if (bUseSpatialIndexFIDs_)
+                return GetNextFeatureFromSpatialIndex();
+        }
+        if (oParallelFilter_.IsActive())
+        {
+            OGRFeature *poFeature = oParallelFilter_.GetNextFeature(
+                [this]() { return poReader_->GetNextFeature(this); });
+            if (poFeature)
+                nFeatureReadSinceReset_++;
+            return poFeature;
+        }
         while (true)
         {
             OGRFeature *poFeature = poReader_->GetNextFeature(this);
@@ -179,6 +211,29 @@ OGRFeature *OGRGeoJSONLayer::GetNextFeature()
     }
 }
 
+/************************************************************************/
+/*                   GetNextFeatureFromSpatialIndex()                   */
+/************************************************************************/
+
+OGRFeature *OGRGeoJSONLayer::GetNextFeatureFromSpatialIndex()
+{
+    while (nSpatialIndexFIDIdx_ < anSpatialIndexFIDs_.size())
+    {
+        OGRFeature *poFeature = poReader_->GetFeature(
+            this, anSpatialIndexFIDs_[nSpatialIndexFIDIdx_++]);
+        if (poFeature == nullptr)
+            continue;
+        if (FilterGeometry(poFeature->GetGeomFieldRef(m_iGeomFieldFilter)) &&
+            (m_poAttrQuery == nullptr || m_poAttrQuery->Evaluate(poFeature)))
+        {
+            nFeatureReadSinceReset_++;
+            return poFeature;
+        }
+        delete poFeature;
+    }
+    return nullptr;
+}
+
 /************************************************************************/
 /*                          GetFeatureCount()                           */
 /************************************************************************/
@@ -210,6 +265,8 @@ OGRFeature *OGRGeoJSONLayer::GetFeature(GIntBig nFID)
     {
         if (!IsUpdatable())
         {
+            // The reader position is changed
+            oParallelFilter_.Reset();
             return poReader_->GetFeature(this, nFID);
         }
         return OGRLayer::GetFeature(nFID);
@@ -232,6 +289,7 @@ bool OGRGeoJSONLayer::IngestAll()
 
         OGRGeoJSONReader *poReader = poReader_;
         poReader_ = nullptr;
+        oParallelFilter_.Reset();
 
         nTotalFeatureCount_ = -1;
         bool bRet = poReader->IngestAll(this);
@@ -33,10 +33,124 @@
 #include "ogrjsoncollectionstreamingparser.h"
 #include "ogr_api.h"
 
+#include "packedrtree.h"
+
+#include <algorithm>
 #include <limits>
 #include <set>
 #include <functional>
 
+/************************************************************************/
+/*                        OGRGeoJSONUseSpatialIndex()                   */
+/************************************************************************/
+
+bool OGRGeoJSONUseSpatialIndex()
+{
+    return CPLTestBool(
+        CPLGetConfigOption("OGR_GEOJSON_USE_SPATIAL_INDEX", "YES"));
+}
+
+/************************************************************************/
+/*                        OGRGeoJSONSpatialIndex()                      */
+/************************************************************************/
+
+OGRGeoJSONSpatialIndex::OGRGeoJSONSpatialIndex() = default;
+
+/************************************************************************/
+/*                       ~OGRGeoJSONSpatialIndex()                      */
+/************************************************************************/
+
+OGRGeoJSONSpatialIndex::~OGRGeoJSONSpatialIndex() = default;
+
+/************************************************************************/
+/*                              AddItem()                               */
+/************************************************************************/
+
+void OGRGeoJSONSpatialIndex::AddItem(uint64_t nItem,
+                                     const OGREnvelope &sEnvelope)
+{
+    CPLAssert(!m_bFinalized);
+    m_anPendingItems.push_back(nItem);
+    m_asPendingEnvelopes.push_back(sEnvelope);
+}
+
+/************************************************************************/
+/*                              Finalize()                              */
+/************************************************************************/
+
+bool OGRGeoJSONSpatialIndex::Finalize()
+{
+    m_bFinalized = true;
+    m_nItemCount = m_anPendingItems.size();
+    if (m_nItemCount == 0)
+        return true;
+
+    bool bRet = true;
+    try
+    {
+        std::vector<FlatGeobuf::NodeItem> asNodes;
+        asNodes.reserve(m_nItemCount);
+        for (size_t i = 0; i < m_nItemCount; ++i)
+        {
+            const auto &sEnv = m_asPendingEnvelopes[i];
+            asNodes.push_back({sEnv.MinX, sEnv.MinY, sEnv.MaxX, sEnv.MaxY,
+                               m_anPendingItems[i]});
+        }
+        const auto extent = FlatGeobuf::calcExtent(asNodes);
+        FlatGeobuf::hilbertSort(asNodes);
+        m_poTree = std::make_unique<FlatGeobuf::PackedRTree>(asNodes, extent);
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot build spatial index: %s", e.what());
+        m_poTree.reset();
+        m_nItemCount = 0;
+        m_bFinalized = false;
+        bRet = false;
+    }
+
+    m_anPendingItems.clear();
+    m_anPendingItems.shrink_to_fit();
+    m_asPendingEnvelopes.clear();
+    m_asPendingEnvelopes.shrink_to_fit();
+    return bRet;
+}
+
+/************************************************************************/
+/*                               Clear()                                */
+/************************************************************************/
+
+void OGRGeoJSONSpatialIndex::Clear()
+{
+    m_anPendingItems.clear();
+    m_asPendingEnvelopes.clear();
+    m_poTree.reset();
+    m_nItemCount = 0;
+    m_bFinalized = false;
+}
+
+/************************************************************************/
+/*                               Search()                               */
+/************************************************************************/
+
+/** Return the items whose envelope intersects sEnvelope, sorted by
+ * increasing item number. */
+std::vector<uint64_t>
+OGRGeoJSONSpatialIndex::Search(const OGREnvelope &sEnvelope) const
+{
+    std::vector<uint64_t> anItems;
+    if (!m_poTree)
+        return anItems;
+    const auto asResults = m_poTree->search(sEnvelope.MinX, sEnvelope.MinY,
+                                            sEnvelope.MaxX, sEnvelope.MaxY);
+    anItems.reserve(asResults.size());
+    for (const auto &sResult : asResults)
+        anItems.push_back(sResult.offset);
+    std::sort(anItems.begin(), anItems.end());
+    return anItems;
+}
+
 /************************************************************************/
 /*                      OGRGeoJSONReaderStreamingParser                 */
 /************************************************************************/
@@ -676,84 +790,159 @@ OGRFeature *OGRGeoJSONReader::GetNextFeature(OGRGeoJSONLayer *poLayer)
 }
 
 /************************************************************************/
-/*                             GetFeature()                             */
+/*                       EstablishFeatureIndex()                        */
 /************************************************************************/
 
-OGRFeature *OGRGeoJSONReader::GetFeature(OGRGeoJSONLayer *poLayer, GIntBig nFID)
+/** Scan the whole file to establish the mapping from FID to the offset and
+ * size of each feature, as well as the spatial index of their envelopes. */
+bool OGRGeoJSONReader::EstablishFeatureIndex(OGRGeoJSONLayer *poLayer)
 {
-    CPLAssert(fp_);
-
-    if (oMapFIDToOffsetSize_.empty())
-    {
-        CPLDebug("GeoJSON",
-                 "Establishing index to features for first GetFeature() call");
+    const bool bBuildSpatialIndex = OGRGeoJSONUseSpatialIndex();
+    oMapFIDToOffsetSize_.clear();
+    anSpatialIndexFIDs_.clear();
+    oSpatialIndex_.Clear();
+    bFeatureIndexEstablished_ = false;
 
-        if (poStreamingParser_)
-            bOriginalIdModifiedEmitted_ =
-                poStreamingParser_->GetOriginalIdModifiedEmitted();
-        delete poStreamingParser_;
-        poStreamingParser_ = nullptr;
+    if (poStreamingParser_)
+        bOriginalIdModifiedEmitted_ =
+            poStreamingParser_->GetOriginalIdModifiedEmitted();
+    delete poStreamingParser_;
+    poStreamingParser_ = nullptr;
 
-        OGRGeoJSONReaderStreamingParser oParser(*this, poLayer, false,
-                                                bStoreNativeData_);
-        oParser.SetOriginalIdModifiedEmitted(bOriginalIdModifiedEmitted_);
-        VSIFSeekL(fp_, 0, SEEK_SET);
-        bFirstSeg_ = true;
-        bJSonPLikeWrapper_ = false;
-        vsi_l_offset nCurOffset = 0;
-        vsi_l_offset nFeatureOffset = 0;
-        while (true)
-        {
-            size_t nRead = VSIFReadL(pabyBuffer_, 1, nBufferSize_, fp_);
-            const bool bFinished = nRead < nBufferSize_;
-            size_t nSkip = 0;
-            if (bFirstSeg_)
-            {
-                bFirstSeg_ = false;
-                nSkip = SkipPrologEpilogAndUpdateJSonPLikeWrapper(nRead);
-            }
-            if (bFinished && bJSonPLikeWrapper_ && nRead - nSkip > 0)
-                nRead--;
-            auto pszPtr = reinterpret_cast<const char *>(pabyBuffer_ + nSkip);
-            for (size_t i = 0; i < nRead - nSkip; i++)
-            {
-                oParser.ResetFeatureDetectionState();
-                if (!oParser.Parse(pszPtr + i, 1,
-                                   bFinished && (i + 1 == nRead - nSkip)) ||
-                    oParser.ExceptionOccurred())
-                {
-                    return nullptr;
-                }
-                if (oParser.IsStartFeature())
-                {
-                    nFeatureOffset = nCurOffset + i;
-                }
-                else if (oParser.IsEndFeature())
+    OGRGeoJSONReaderStreamingParser oParser(*this, poLayer, false,
+                                            bStoreNativeData_);
+    oParser.SetOriginalIdModifiedEmitted(bOriginalIdModifiedEmitted_);
+    VSIFSeekL(fp_, 0, SEEK_SET);
+    bFirstSeg_ = true;
+    bJSonPLikeWrapper_ = false;
+    vsi_l_offset nCurOffset = 0;
+    vsi_l_offset nFeatureOffset = 0;
+    while (true)
+    {
+        size_t nRead = VSIFReadL(pabyBuffer_, 1, nBufferSize_, fp_);
+        const bool bFinished = nRead < nBufferSize_;
+        size_t nSkip = 0;
+        if (bFirstSeg_)
+        {
+            bFirstSeg_ = false;
+            nSkip = SkipPrologEpilogAndUpdateJSonPLikeWrapper(nRead);
+        }
+        if (bFinished && bJSonPLikeWrapper_ && nRead - nSkip > 0)
+            nRead--;
+        auto pszPtr = reinterpret_cast<const char *>(pabyBuffer_ + nSkip);
+        for (size_t i = 0; i < nRead - nSkip; i++)
+        {
+            oParser.ResetFeatureDetectionState();
+            if (!oParser.Parse(pszPtr + i, 1,
+                               bFinished && (i + 1 == nRead - nSkip)) ||
+                oParser.ExceptionOccurred())
+            {
+                oMapFIDToOffsetSize_.clear();
+                anSpatialIndexFIDs_.clear();
+                oSpatialIndex_.Clear();
+                return false;
+            }
+            if (oParser.IsStartFeature())
+            {
+                nFeatureOffset = nCurOffset + i;
+            }
+            else if (oParser.IsEndFeature())
+            {
+                vsi_l_offset nFeatureSize =
+                    (nCurOffset + i) - nFeatureOffset + 1;
+                auto poFeat = oParser.GetNextFeature();
+                if (poFeat)
                 {
-                    vsi_l_offset nFeatureSize =
-                        (nCurOffset + i) - nFeatureOffset + 1;
-                    auto poFeat = oParser.GetNextFeature();
-                    if (poFeat)
+                    const GIntBig nThisFID = poFeat->GetFID();
+                    if (oMapFIDToOffsetSize_.find(nThisFID) ==
+                        oMapFIDToOffsetSize_.end())
                     {
-                        const GIntBig nThisFID = poFeat->GetFID();
-                        if (oMapFIDToOffsetSize_.find(nThisFID) ==
-                            oMapFIDToOffsetSize_.end())
+                        oMapFIDToOffsetSize_[nThisFID] =
+                            std::pair<vsi_l_offset, vsi_l_offset>(
+                                nFeatureOffset, nFeatureSize);
+                        const OGRGeometry *poGeom = poFeat->GetGeometryRef();
+                        if (bBuildSpatialIndex && poGeom &&
+                            !poGeom->IsEmpty())
                         {
-                            oMapFIDToOffsetSize_[nThisFID] =
-                                std::pair<vsi_l_offset, vsi_l_offset>(
-                                    nFeatureOffset, nFeatureSize);
+                            OGREnvelope sEnvelope;
+                            poGeom->getEnvelope(&sEnvelope);
+                            oSpatialIndex_.AddItem(anSpatialIndexFIDs_.size(),
+                                                   sEnvelope);
+                            anSpatialIndexFIDs_.push_back(nThisFID);
                         }
-                        delete poFeat;
                     }
+                    delete poFeat;
                 }
             }
-
-            if (bFinished)
-                break;
-            nCurOffset += nRead;
         }
 
-        bOriginalIdModifiedEmitted_ = oParser.GetOriginalIdModifiedEmitted();
+        if (bFinished)
+            break;
+        nCurOffset += nRead;
+    }
+
+    bOriginalIdModifiedEmitted_ = oParser.GetOriginalIdModifiedEmitted();
+
+    if (bBuildSpatialIndex && !oSpatialIndex_.Finalize())
+        anSpatialIndexFIDs_.clear();
+
+    bFeatureIndexEstablished_ = true;
+    return true;
+}
+
+/************************************************************************/
+/*                        GetFIDsIntersecting()                         */
+/************************************************************************/
+
+/** Return in anFIDs the FIDs of the features whose envelope intersects
+ * sEnvelope, in file order.
+ *
+ * Returns false if the spatial index cannot be used, or would not be
+ * beneficial because most features are selected, in which case the caller
+ * should fallback to a sequential scan.
+ */
+bool OGRGeoJSONReader::GetFIDsIntersecting(OGRGeoJSONLayer *poLayer,
+                                           const OGREnvelope &sEnvelope,
+                                           std::vector<GIntBig> &anFIDs)
+{
+    CPLAssert(fp_);
+
+    anFIDs.clear();
+    if (!bFeatureIndexEstablished_)
+    {
+        CPLDebug("GeoJSON", "Building spatial index");
+        if (!EstablishFeatureIndex(poLayer))
+            return false;
+    }
+    if (!oSpatialIndex_.IsFinalized())
+        return false;
+
+    const auto anItems = oSpatialIndex_.Search(sEnvelope);
+    // Seeking to each feature is only worth it if it saves reading a
+    // significant part of the file.
+    if (anItems.size() > oMapFIDToOffsetSize_.size() / 2)
+        return false;
+
+    anFIDs.reserve(anItems.size());
+    for (const uint64_t nItem : anItems)
+        anFIDs.push_back(anSpatialIndexFIDs_[static_cast<size_t>(nItem)]);
+    return true;
+}
+
+/************************************************************************/
+/*                             GetFeature()                             */
+/************************************************************************/
+
+OGRFeature *OGRGeoJSONReader::GetFeature(OGRGeoJSONLayer *poLayer, GIntBig nFID)
+{
+    CPLAssert(fp_);
+
+    if (!bFeatureIndexEstablished_)
+    {
+        CPLDebug("GeoJSON",
+                 "Establishing index to features for first GetFeature() call");
+        if (!EstablishFeatureIndex(poLayer))
+            return nullptr;
     }
 
     auto oIter = oMapFIDToOffsetSize_.find(nFID);
@@ -38,6 +38,7 @@
 #include "ogrgeojsonutils.h"
 #include "directedacyclicgraph.hpp"
 
+#include <memory>
 #include <utility>
 #include <map>
 #include <set>
@@ -58,6 +59,11 @@ class OGRPolygon;
 class OGRMultiPolygon;
 class OGRGeometryCollection;
 class OGRFeature;
+
+namespace FlatGeobuf
+{
+class PackedRTree;
+}
 class OGRGeoJSONLayer;
 class OGRSpatialReference;
 
@@ -88,6 +94,49 @@ struct GeoJSONObject
     };
 };
 
+/************************************************************************/
+/*                        OGRGeoJSONSpatialIndex                        */
+/************************************************************************/
+
+/** Packed Hilbert R-tree over feature envelopes, used to turn spatial filter
+ * queries on file-backed layers into index lookups plus seeks.
+ * Items are identified by a caller-defined integer (typically the rank of
+ * the feature in the file).
+ */
+class OGRGeoJSONSpatialIndex
+{
+  public:
+    OGRGeoJSONSpatialIndex();
+    ~OGRGeoJSONSpatialIndex();
+
+    void AddItem(uint64_t nItem, const OGREnvelope &sEnvelope);
+    bool Finalize();
+    void Clear();
+
+    bool IsFinalized() const
+    {
+        return m_bFinalized;
+    }
+
+    size_t GetItemCount() const
+    {
+        return m_nItemCount;
+    }
+
+    std::vector<uint64_t> Search(const OGREnvelope &sEnvelope) const;
+
+  private:
+    std::vector<OGREnvelope> m_asPendingEnvelopes{};
+    std::vector<uint64_t> m_anPendingItems{};
+    std::unique_ptr<FlatGeobuf::PackedRTree> m_poTree{};
+    size_t m_nItemCount = 0;
+    bool m_bFinalized = false;
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRGeoJSONSpatialIndex)
+};
+
+bool OGRGeoJSONUseSpatialIndex();
+
 /************************************************************************/
 /*                        OGRGeoJSONBaseReader                          */
 /************************************************************************/
@@ -180,6 +229,9 @@ class OGRGeoJSONReader : public OGRGeoJSONBaseReader
     void ResetReading();
     OGRFeature *GetNextFeature(OGRGeoJSONLayer *poLayer);
     OGRFeature *GetFeature(OGRGeoJSONLayer *poLayer, GIntBig nFID);
+    bool GetFIDsIntersecting(OGRGeoJSONLayer *poLayer,
+                             const OGREnvelope &sEnvelope,
+                             std::vector<GIntBig> &anFIDs);
     bool IngestAll(OGRGeoJSONLayer *poLayer);
 
     VSILFILE *GetFP()
@@ -215,6 +267,12 @@ class OGRGeoJSONReader : public OGRGeoJSONBaseReader
 
     std::map<GIntBig, std::pair<vsi_l_offset, vsi_l_offset>>
         oMapFIDToOffsetSize_;
+    // FID of the items of oSpatialIndex_
+    std::vector<GIntBig> anSpatialIndexFIDs_{};
+    OGRGeoJSONSpatialIndex oSpatialIndex_{};
+    bool bFeatureIndexEstablished_ = false;
+
+    bool EstablishFeatureIndex(OGRGeoJSONLayer *poLayer);
     //
     // Copy operations not supported.
     //
@@ -30,16 +30,28 @@
 #include "cpl_vsi_virtual.h"
 #include "cpl_http.h"
 #include "cpl_vsi_error.h"
+#include "cpl_error_internal.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 
 #include "ogr_geojson.h"
 #include "ogrgeojsonreader.h"
 #include "ogrgeojsonwriter.h"
 
 #include <algorithm>
+#include <deque>
 #include <memory>
 
 constexpr char RS = '\x1e';
 
+constexpr char SIDECAR_INDEX_EXTENSION[] = ".gjsidx";
+constexpr char SIDECAR_INDEX_MAGIC[] = "GJSQIDX1";
+constexpr size_t SIDECAR_INDEX_MAGIC_SIZE = 8;
+// magic, file size, file modification time, number of items
+constexpr size_t SIDECAR_INDEX_HEADER_SIZE = SIDECAR_INDEX_MAGIC_SIZE + 3 * 8;
+// offset, size, FID, minx, miny, maxx, maxy
+constexpr size_t SIDECAR_INDEX_ITEM_SIZE = 7 * 8;
+
 /************************************************************************/
 /*                        OGRGeoJSONSeqDataSource                       */
 /************************************************************************/
@@ -97,14 +109,69 @@ class OGRGeoJSONSeqLayer final : public OGRLayer
     vsi_l_offset m_nFileSize = 0;
     GIntBig m_nIter = 0;
 
+    // Offset in file of m_osBuffer[0]
+    vsi_l_offset m_nBufferOffset = 0;
+    // Offset in file and size of the last object returned by GetNextObject()
+    vsi_l_offset m_nObjectOffset = 0;
+    size_t m_nObjectSize = 0;
+
     GIntBig m_nTotalFeatures = 0;
     GIntBig m_nNextFID = 0;
 
+    struct FeatureLocation
+    {
+        vsi_l_offset nOffset;
+        size_t nSize;
+        GIntBig nFID;
+    };
+
+    // Spatial index: item i of m_oSpatialIndex is m_asIndexedFeatures[i]
+    bool m_bSpatialIndexEstablished = false;
+    std::vector<FeatureLocation> m_asIndexedFeatures{};
+    OGRGeoJSONSpatialIndex m_oSpatialIndex{};
+    std::string m_osSidecarIndexFilename{};
+
+    // Items selected by the spatial index for the current spatial filter
+    bool m_bSpatialIndexQueried = false;
+    bool m_bUseSpatialIndexItems = false;
+    std::vector<uint64_t> m_anSpatialIndexItems{};
+    size_t m_nSpatialIndexItemIdx = 0;
+
+    // Multi-threaded parsing (OGR_GEOJSONSEQ_NUM_THREADS)
+    int m_nNumThreads = 0;
+    bool m_bAllRecordsRead = false;
+    std::vector<std::string> m_aosRecords{};
+    std::vector<std::unique_ptr<OGRFeature>> m_apoParsedFeatures{};
+    std::deque<std::unique_ptr<OGRFeature>> m_oParsedQueue{};
+    std::unique_ptr<CPLJobQueue> m_poJobQueue{};
+
+    struct ParseJob
+    {
+        OGRGeoJSONSeqLayer *poThis = nullptr;
+        size_t iStart = 0;
+        size_t iEnd = 0;
+        std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+    };
+
     std::unique_ptr<OGRCoordinateTransformation> m_poCT{};
     OGRGeometryFactory::TransformWithOptionsCache m_oTransformCache;
     OGRGeoJSONWriteOptions m_oWriteOptions;
 
+    bool GetNextRecord();
     json_object *GetNextObject(bool bLooseIdentification);
+    OGRFeature *FeatureFromObject(json_object *poObject);
+    OGRFeature *ReadNextFeature();
+
+    int GetNumThreads();
+    static void ParseJobFunc(void *pData);
+    bool ParseNextBatch();
+    OGRFeature *ReadNextFeatureMultiThreaded();
+
+    void InvalidateSpatialIndex();
+    bool EstablishSpatialIndex();
+    bool ReadSidecarIndex();
+    void WriteSidecarIndex(const std::vector<OGREnvelope> &asEnvelopes) const;
+    OGRFeature *GetNextFeatureFromSpatialIndex();
 
   public:
     OGRGeoJSONSeqLayer(OGRGeoJSONSeqDataSource *poDS, const char *pszName);
@@ -118,6 +185,11 @@ class OGRGeoJSONSeqLayer final : public OGRLayer
 
     bool Init(bool bLooseIdentification, bool bEstablishLayerDefn);
 
+    void SetSidecarIndexFilename(const std::string &osFilename)
+    {
+        m_osSidecarIndexFilename = osFilename;
+    }
+
     const char *GetName() override
     {
         return GetDescription();
@@ -294,6 +366,8 @@ OGRGeoJSONSeqLayer::OGRGeoJSONSeqLayer(
 
 OGRGeoJSONSeqLayer::~OGRGeoJSONSeqLayer()
 {
+    if (m_poJobQueue)
+        m_poJobQueue->WaitCompletion();
     m_poFeatureDefn->Release();
 }
 
@@ -403,14 +477,27 @@ void OGRGeoJSONSeqLayer::ResetReading()
     m_osFeatureBuffer.clear();
     m_nPosInBuffer = nBufferSizeValidated;
     m_nBufferValidSize = nBufferSizeValidated;
+    m_nBufferOffset = 0;
     m_nNextFID = 0;
+
+    m_nNumThreads = 0;
+    m_bAllRecordsRead = false;
+    m_aosRecords.clear();
+    m_apoParsedFeatures.clear();
+    m_oParsedQueue.clear();
+
+    m_bSpatialIndexQueried = false;
+    m_bUseSpatialIndexItems = false;
+    m_anSpatialIndexItems.clear();
+    m_nSpatialIndexItemIdx = 0;
 }
 
 /************************************************************************/
-/*                           GetNextObject()                            */
+/*                           GetNextRecord()                            */
 /************************************************************************/
 
-json_object *OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
+// Reads the text of the next non-empty record into m_osFeatureBuffer
+bool OGRGeoJSONSeqLayer::GetNextRecord()
 {
     m_osFeatureBuffer.clear();
     while (true)
@@ -420,8 +507,9 @@ json_object *OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
         {
             if (m_nBufferValidSize < m_osBuffer.size())
             {
-                return nullptr;
+                return false;
             }
+            m_nBufferOffset = VSIFTellL(m_poDS->m_fp);
             m_nBufferValidSize =
                 VSIFReadL(&m_osBuffer[0], 1, m_osBuffer.size(), m_poDS->m_fp);
             m_nPosInBuffer = 0;
@@ -444,13 +532,15 @@ json_object *OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
             }
             if (m_nPosInBuffer >= m_nBufferValidSize)
             {
-                return nullptr;
+                return false;
             }
         }
 
         // Find next feature separator in buffer
         const size_t nNextSepPos = m_osBuffer.find(
             m_poDS->m_bIsRSSeparated ? RS : '\n', m_nPosInBuffer);
+        if (m_osFeatureBuffer.empty())
+            m_nObjectOffset = m_nBufferOffset + m_nPosInBuffer;
         if (nNextSepPos != std::string::npos)
         {
             m_osFeatureBuffer.append(m_osBuffer.data() + m_nPosInBuffer,
@@ -472,7 +562,7 @@ json_object *OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
                          "for larger features, or 0 to remove any size limit.",
                          static_cast<unsigned>(m_osFeatureBuffer.size() / 1024 /
                                                1024));
-                return nullptr;
+                return false;
             }
             m_nPosInBuffer = m_nBufferValidSize;
             if (m_nBufferValidSize == m_osBuffer.size())
@@ -489,23 +579,36 @@ json_object *OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
         }
         if (!m_osFeatureBuffer.empty())
         {
-            json_object *poObject = nullptr;
-            CPL_IGNORE_RET_VAL(
-                OGRJSonParse(m_osFeatureBuffer.c_str(), &poObject));
-            m_osFeatureBuffer.clear();
-            if (json_object_get_type(poObject) == json_type_object)
-            {
-                return poObject;
-            }
-            json_object_put(poObject);
-            if (bLooseIdentification)
-            {
-                return nullptr;
-            }
+            m_nObjectSize = m_osFeatureBuffer.size();
+            return true;
         }
     }
 }
 
+/************************************************************************/
+/*                           GetNextObject()                            */
+/************************************************************************/
+
+json_object *OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
+{
+    while (GetNextRecord())
+    {
+        json_object *poObject = nullptr;
+        CPL_IGNORE_RET_VAL(OGRJSonParse(m_osFeatureBuffer.c_str(), &poObject));
+        m_osFeatureBuffer.clear();
+        if (json_object_get_type(poObject) == json_type_object)
+        {
+            return poObject;
+        }
+        json_object_put(poObject);
+        if (bLooseIdentification)
+        {
+            return nullptr;
+        }
+    }
+    return nullptr;
+}
+
 /************************************************************************/
 /*                           GetNextFeature()                           */
 /************************************************************************/
@@ -524,51 +627,554 @@ OGRFeature *OGRGeoJSONSeqLayer::GetNextFeature()
     }
 
     GetLayerDefn();  // force scan if not already done
+
+    if (m_poFilterGeom != nullptr && m_poDS->GetAccess() == GA_ReadOnly)
+    {
+        if (!m_bSpatialIndexQueried)
+        {
+            // Note: EstablishSpatialIndex() calls ResetReading()
+            const bool bHasSpatialIndex =
+                OGRGeoJSONUseSpatialIndex() &&
+                (m_bSpatialIndexEstablished || EstablishSpatialIndex()) &&
+                m_oSpatialIndex.IsFinalized();
+            m_bSpatialIndexQueried = true;
+            m_bUseSpatialIndexItems = false;
+            m_nSpatialIndexItemIdx = 0;
+            if (bHasSpatialIndex)
+            {
+                m_anSpatialIndexItems =
+                    m_oSpatialIndex.Search(m_sFilterEnvelope);
+                // Seeking to each feature is only worth it if it saves
+                // reading a significant part of the file.
+                m_bUseSpatialIndexItems =
+                    static_cast<GIntBig>(m_anSpatialIndexItems.size()) <=
+                    m_nTotalFeatures / 2;
+            }
+        }
+        if (m_bUseSpatialIndexItems)
+            return GetNextFeatureFromSpatialIndex();
+    }
+
+    const bool bMultiThreaded = GetNumThreads() > 1;
+    while (true)
+    {
+        OGRFeature *poFeature = bMultiThreaded
+                                    ? ReadNextFeatureMultiThreaded()
+                                    : ReadNextFeature();
+        if (!poFeature)
+            return nullptr;
+        if ((m_poFilterGeom == nullptr ||
+             FilterGeometry(poFeature->GetGeomFieldRef(m_iGeomFieldFilter))) &&
+            (m_poAttrQuery == nullptr || m_poAttrQuery->Evaluate(poFeature)))
+        {
+            return poFeature;
+        }
+        delete poFeature;
+    }
+}
+
+/************************************************************************/
+/*                          FeatureFromObject()                         */
+/************************************************************************/
+
+// Takes ownership of poObject. Returns nullptr if the object must be skipped
+OGRFeature *OGRGeoJSONSeqLayer::FeatureFromObject(json_object *poObject)
+{
+    OGRFeature *poFeature;
+    auto type = OGRGeoJSONGetType(poObject);
+    if (type == GeoJSONObject::eFeature)
+    {
+        poFeature = m_oReader.ReadFeature(this, poObject,
+                                          m_osFeatureBuffer.c_str());
+        json_object_put(poObject);
+    }
+    else if (type == GeoJSONObject::eFeatureCollection ||
+             type == GeoJSONObject::eUnknown)
+    {
+        json_object_put(poObject);
+        return nullptr;
+    }
+    else
+    {
+        OGRGeometry *poGeom = m_oReader.ReadGeometry(poObject, GetSpatialRef());
+        json_object_put(poObject);
+        if (!poGeom)
+        {
+            return nullptr;
+        }
+        poFeature = new OGRFeature(m_poFeatureDefn);
+        poFeature->SetGeometryDirectly(poGeom);
+    }
+    return poFeature;
+}
+
+/************************************************************************/
+/*                           ReadNextFeature()                          */
+/************************************************************************/
+
+// Returns the next feature, without applying filters
+OGRFeature *OGRGeoJSONSeqLayer::ReadNextFeature()
+{
     while (true)
     {
         auto poObject = GetNextObject(false);
         if (!poObject)
             return nullptr;
-        OGRFeature *poFeature;
-        auto type = OGRGeoJSONGetType(poObject);
-        if (type == GeoJSONObject::eFeature)
+        OGRFeature *poFeature = FeatureFromObject(poObject);
+        if (!poFeature)
+            continue;
+
+        if (poFeature->GetFID() == OGRNullFID)
         {
-            poFeature = m_oReader.ReadFeature(this, poObject,
-                                              m_osFeatureBuffer.c_str());
-            json_object_put(poObject);
+            poFeature->SetFID(m_nNextFID);
+            m_nNextFID++;
         }
-        else if (type == GeoJSONObject::eFeatureCollection ||
-                 type == GeoJSONObject::eUnknown)
+        return poFeature;
+    }
+}
+
+/************************************************************************/
+/*                            GetNumThreads()                           */
+/************************************************************************/
+
+int OGRGeoJSONSeqLayer::GetNumThreads()
+{
+    if (m_nNumThreads == 0)
+    {
+        const char *pszNumThreads =
+            CPLGetConfigOption("OGR_GEOJSONSEQ_NUM_THREADS", "1");
+        if (EQUAL(pszNumThreads, "ALL_CPUS"))
+            m_nNumThreads = CPLGetNumCPUs();
+        else
+            m_nNumThreads = atoi(pszNumThreads);
+        m_nNumThreads = std::max(1, std::min(m_nNumThreads, 128));
+    }
+    return m_nNumThreads;
+}
+
+/************************************************************************/
+/*                            ParseJobFunc()                            */
+/************************************************************************/
+
+/* static */ void OGRGeoJSONSeqLayer::ParseJobFunc(void *pData)
+{
+    ParseJob *psJob = static_cast<ParseJob *>(pData);
+    OGRGeoJSONSeqLayer *poThis = psJob->poThis;
+
+    // Errors are emitted afterwards by the calling thread, in record order
+    CPLInstallErrorHandlerAccumulator(psJob->aoErrors);
+    for (size_t i = psJob->iStart; i < psJob->iEnd; ++i)
+    {
+        json_object *poObject = nullptr;
+        CPL_IGNORE_RET_VAL(
+            OGRJSonParse(poThis->m_aosRecords[i].c_str(), &poObject));
+        if (json_object_get_type(poObject) != json_type_object)
         {
             json_object_put(poObject);
             continue;
         }
-        else
+        poThis->m_apoParsedFeatures[i].reset(
+            poThis->FeatureFromObject(poObject));
+    }
+    CPLUninstallErrorHandlerAccumulator();
+}
+
+/************************************************************************/
+/*                           ParseNextBatch()                           */
+/************************************************************************/
+
+// Reads a batch of records in the current thread, parses them in worker
+// threads, and appends the resulting features, in file order, to
+// m_oParsedQueue. Returns false if no record could be read.
+bool OGRGeoJSONSeqLayer::ParseNextBatch()
+{
+    const size_t nBatchSize = static_cast<size_t>(m_nNumThreads) * 256;
+    m_aosRecords.clear();
+    while (m_aosRecords.size() < nBatchSize)
+    {
+        if (!GetNextRecord())
         {
-            OGRGeometry *poGeom =
-                m_oReader.ReadGeometry(poObject, GetSpatialRef());
-            json_object_put(poObject);
-            if (!poGeom)
-            {
-                continue;
-            }
-            poFeature = new OGRFeature(m_poFeatureDefn);
-            poFeature->SetGeometryDirectly(poGeom);
+            m_bAllRecordsRead = true;
+            break;
         }
+        m_aosRecords.emplace_back(std::move(m_osFeatureBuffer));
+        m_osFeatureBuffer.clear();
+    }
+    if (m_aosRecords.empty())
+        return false;
 
-        if (poFeature->GetFID() == OGRNullFID)
+    const size_t nRecords = m_aosRecords.size();
+    m_apoParsedFeatures.clear();
+    m_apoParsedFeatures.resize(nRecords);
+    const size_t nJobs = std::min(static_cast<size_t>(m_nNumThreads),
+                                  (nRecords + 63) / 64);
+
+    std::vector<ParseJob> asJobs(nJobs);
+    for (size_t iJob = 0; iJob < nJobs; ++iJob)
+    {
+        asJobs[iJob].poThis = this;
+        asJobs[iJob].iStart = iJob * nRecords / nJobs;
+        asJobs[iJob].iEnd = (iJob + 1) * nRecords / nJobs;
+    }
+
+    CPLWorkerThreadPool *poPool =
+        nJobs > 1 ? GDALGetGlobalThreadPool(m_nNumThreads) : nullptr;
+    if (poPool && !m_poJobQueue)
+        m_poJobQueue = poPool->CreateJobQueue();
+    for (size_t iJob = 0; iJob < nJobs; ++iJob)
+    {
+        // The last job is run in the current thread
+        if (!m_poJobQueue || iJob + 1 == nJobs ||
+            !m_poJobQueue->SubmitJob(ParseJobFunc, &asJobs[iJob]))
         {
-            poFeature->SetFID(m_nNextFID);
-            m_nNextFID++;
+            ParseJobFunc(&asJobs[iJob]);
         }
-        if ((m_poFilterGeom == nullptr ||
-             FilterGeometry(poFeature->GetGeomFieldRef(m_iGeomFieldFilter))) &&
+    }
+    if (m_poJobQueue)
+        m_poJobQueue->WaitCompletion();
+
+    for (const auto &sJob : asJobs)
+    {
+        for (const auto &sError : sJob.aoErrors)
+            CPLError(sError.type, sError.no, "%s", sError.msg.c_str());
+    }
+
+    for (auto &poFeature : m_apoParsedFeatures)
+    {
+        if (poFeature)
+            m_oParsedQueue.push_back(std::move(poFeature));
+    }
+    m_apoParsedFeatures.clear();
+    m_aosRecords.clear();
+    return true;
+}
+
+/************************************************************************/
+/*                    ReadNextFeatureMultiThreaded()                    */
+/************************************************************************/
+
+// Same as ReadNextFeature(), but with records parsed in worker threads
+OGRFeature *OGRGeoJSONSeqLayer::ReadNextFeatureMultiThreaded()
+{
+    while (m_oParsedQueue.empty())
+    {
+        if (m_bAllRecordsRead || !ParseNextBatch())
+            return nullptr;
+    }
+    OGRFeature *poFeature = m_oParsedQueue.front().release();
+    m_oParsedQueue.pop_front();
+    if (poFeature->GetFID() == OGRNullFID)
+    {
+        poFeature->SetFID(m_nNextFID);
+        m_nNextFID++;
+    }
+    return poFeature;
+}
+
+/************************************************************************/
+/*                   GetNextFeatureFromSpatialIndex()                   */
+/************************************************************************/
+
+OGRFeature *OGRGeoJSONSeqLayer::GetNextFeatureFromSpatialIndex()
+{
+    std::string osBuffer;
+    while (m_nSpatialIndexItemIdx < m_anSpatialIndexItems.size())
+    {
+        const auto &sLocation = m_asIndexedFeatures[static_cast<size_t>(
+            m_anSpatialIndexItems[m_nSpatialIndexItemIdx++])];
+        if (m_nMaxObjectSize > 0 && sLocation.nSize > m_nMaxObjectSize)
+            continue;
+        try
+        {
+            osBuffer.resize(sLocation.nSize);
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate %" PRIu64 " bytes",
+                     static_cast<uint64_t>(sLocation.nSize));
+            return nullptr;
+        }
+        if (VSIFSeekL(m_poDS->m_fp, sLocation.nOffset, SEEK_SET) != 0 ||
+            VSIFReadL(&osBuffer[0], 1, osBuffer.size(), m_poDS->m_fp) !=
+                osBuffer.size())
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot read feature");
+            return nullptr;
+        }
+        json_object *poObject = nullptr;
+        if (!OGRJSonParse(osBuffer.c_str(), &poObject))
+            continue;
+        if (json_object_get_type(poObject) != json_type_object)
+        {
+            json_object_put(poObject);
+            continue;
+        }
+        OGRFeature *poFeature = FeatureFromObject(poObject);
+        if (!poFeature)
+            continue;
+        poFeature->SetFID(sLocation.nFID);
+        if (FilterGeometry(poFeature->GetGeomFieldRef(m_iGeomFieldFilter)) &&
             (m_poAttrQuery == nullptr || m_poAttrQuery->Evaluate(poFeature)))
         {
             return poFeature;
         }
         delete poFeature;
     }
+    return nullptr;
+}
+
+/************************************************************************/
+/*                       InvalidateSpatialIndex()                       */
+/************************************************************************/
+
+void OGRGeoJSONSeqLayer::InvalidateSpatialIndex()
+{
+    m_bSpatialIndexEstablished = false;
+    m_asIndexedFeatures.clear();
+    m_oSpatialIndex.Clear();
+    m_bSpatialIndexQueried = false;
+    m_bUseSpatialIndexItems = false;
+    m_anSpatialIndexItems.clear();
+}
+
+/************************************************************************/
+/*                        EstablishSpatialIndex()                       */
+/************************************************************************/
+
+bool OGRGeoJSONSeqLayer::EstablishSpatialIndex()
+{
+    InvalidateSpatialIndex();
+    m_bSpatialIndexEstablished = true;
+
+    if (!m_osSidecarIndexFilename.empty() && ReadSidecarIndex())
+        return true;
+
+    CPLDebug("GeoJSONSeq", "Building spatial index");
+    std::vector<OGREnvelope> asEnvelopes;
+    ResetReading();
+    while (true)
+    {
+        OGRFeature *poFeature = ReadNextFeature();
+        if (!poFeature)
+            break;
+        const OGRGeometry *poGeom = poFeature->GetGeometryRef();
+        if (poGeom && !poGeom->IsEmpty())
+        {
+            OGREnvelope sEnvelope;
+            poGeom->getEnvelope(&sEnvelope);
+            m_oSpatialIndex.AddItem(m_asIndexedFeatures.size(), sEnvelope);
+            m_asIndexedFeatures.push_back(
+                {m_nObjectOffset, m_nObjectSize, poFeature->GetFID()});
+            if (!m_osSidecarIndexFilename.empty())
+                asEnvelopes.push_back(sEnvelope);
+        }
+        delete poFeature;
+    }
+    ResetReading();
+
+    if (!m_oSpatialIndex.Finalize())
+    {
+        m_asIndexedFeatures.clear();
+        return false;
+    }
+
+    if (!m_osSidecarIndexFilename.empty())
+        WriteSidecarIndex(asEnvelopes);
+
+    return true;
+}
+
+/************************************************************************/
+/*                          ReadSidecarIndex()                          */
+/************************************************************************/
+
+/* The sidecar index file is made of a header with:
+ * - the "GJSQIDX1" magic
+ * - the size (uint64) and modification time (int64) of the indexed file
+ * - the number of items (uint64)
+ * followed by, for each feature with a non-empty geometry, its offset (uint64)
+ * and size (uint64) in the indexed file, its FID (int64), and its envelope as
+ * minx, miny, maxx, maxy (double). All values are little-endian.
+ */
+bool OGRGeoJSONSeqLayer::ReadSidecarIndex()
+{
+    const char *pszFilename = m_poDS->GetDescription();
+    if (STARTS_WITH_CI(pszFilename, "GeoJSONSeq:"))
+        pszFilename += strlen("GeoJSONSeq:");
+    VSIStatBufL sStat;
+    VSIStatBufL sStatIndex;
+    if (VSIStatL(pszFilename, &sStat) != 0 ||
+        VSIStatL(m_osSidecarIndexFilename.c_str(), &sStatIndex) != 0)
+    {
+        return false;
+    }
+
+    VSILFILE *fp = VSIFOpenL(m_osSidecarIndexFilename.c_str(), "rb");
+    if (!fp)
+        return false;
+
+    GByte abyHeader[SIDECAR_INDEX_HEADER_SIZE];
+    uint64_t nFileSize = 0;
+    int64_t nMTime = 0;
+    uint64_t nItemCount = 0;
+    bool bOK = VSIFReadL(abyHeader, sizeof(abyHeader), 1, fp) == 1 &&
+               memcmp(abyHeader, SIDECAR_INDEX_MAGIC,
+                      SIDECAR_INDEX_MAGIC_SIZE) == 0;
+    if (bOK)
+    {
+        memcpy(&nFileSize, abyHeader + SIDECAR_INDEX_MAGIC_SIZE, 8);
+        CPL_LSBPTR64(&nFileSize);
+        memcpy(&nMTime, abyHeader + SIDECAR_INDEX_MAGIC_SIZE + 8, 8);
+        CPL_LSBPTR64(&nMTime);
+        memcpy(&nItemCount, abyHeader + SIDECAR_INDEX_MAGIC_SIZE + 16, 8);
+        CPL_LSBPTR64(&nItemCount);
+        bOK = nFileSize == static_cast<uint64_t>(sStat.st_size) &&
+              nMTime == static_cast<int64_t>(sStat.st_mtime) &&
+              nItemCount <= static_cast<uint64_t>(m_nTotalFeatures) &&
+              static_cast<uint64_t>(sStatIndex.st_size) ==
+                  SIDECAR_INDEX_HEADER_SIZE +
+                      nItemCount * SIDECAR_INDEX_ITEM_SIZE;
+    }
+
+    std::vector<GByte> abyItems;
+    if (bOK)
+    {
+        try
+        {
+            abyItems.resize(static_cast<size_t>(nItemCount) *
+                            SIDECAR_INDEX_ITEM_SIZE);
+        }
+        catch (const std::exception &)
+        {
+            bOK = false;
+        }
+    }
+    if (bOK && !abyItems.empty())
+        bOK = VSIFReadL(abyItems.data(), abyItems.size(), 1, fp) == 1;
+    VSIFCloseL(fp);
+
+    if (!bOK)
+    {
+        CPLDebug("GeoJSONSeq", "Ignoring invalid or outdated %s",
+                 m_osSidecarIndexFilename.c_str());
+        return false;
+    }
+
+    CPLDebug("GeoJSONSeq", "Reading spatial index from %s",
+             m_osSidecarIndexFilename.c_str());
+    m_asIndexedFeatures.reserve(static_cast<size_t>(nItemCount));
+    for (size_t i = 0; i < static_cast<size_t>(nItemCount); ++i)
+    {
+        const GByte *pabyItem = abyItems.data() + i * SIDECAR_INDEX_ITEM_SIZE;
+        uint64_t nOffset;
+        uint64_t nSize;
+        int64_t nFID;
+        double adfEnv[4];
+        memcpy(&nOffset, pabyItem, 8);
+        CPL_LSBPTR64(&nOffset);
+        memcpy(&nSize, pabyItem + 8, 8);
+        CPL_LSBPTR64(&nSize);
+        memcpy(&nFID, pabyItem + 16, 8);
+        CPL_LSBPTR64(&nFID);
+        memcpy(adfEnv, pabyItem + 24, sizeof(adfEnv));
+        for (double &dfVal : adfEnv)
+            CPL_LSBPTR64(&dfVal);
+        if (nOffset > nFileSize || nSize > nFileSize - nOffset)
+        {
+            CPLDebug("GeoJSONSeq", "Invalid item in %s",
+                     m_osSidecarIndexFilename.c_str());
+            m_asIndexedFeatures.clear();
+            m_oSpatialIndex.Clear();
+            return false;
+        }
+        OGREnvelope sEnvelope;
+        sEnvelope.MinX = adfEnv[0];
+        sEnvelope.MinY = adfEnv[1];
+        sEnvelope.MaxX = adfEnv[2];
+        sEnvelope.MaxY = adfEnv[3];
+        m_oSpatialIndex.AddItem(i, sEnvelope);
+        m_asIndexedFeatures.push_back({static_cast<vsi_l_offset>(nOffset),
+                                       static_cast<size_t>(nSize),
+                                       static_cast<GIntBig>(nFID)});
+    }
+
+    if (!m_oSpatialIndex.Finalize())
+    {
+        m_asIndexedFeatures.clear();
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                          WriteSidecarIndex()                         */
+/************************************************************************/
+
+void OGRGeoJSONSeqLayer::WriteSidecarIndex(
+    const std::vector<OGREnvelope> &asEnvelopes) const
+{
+    CPLAssert(asEnvelopes.size() == m_asIndexedFeatures.size());
+
+    const char *pszFilename = m_poDS->GetDescription();
+    if (STARTS_WITH_CI(pszFilename, "GeoJSONSeq:"))
+        pszFilename += strlen("GeoJSONSeq:");
+    VSIStatBufL sStat;
+    if (VSIStatL(pszFilename, &sStat) != 0)
+        return;
+
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    VSILFILE *fp = VSIFOpenL(m_osSidecarIndexFilename.c_str(), "wb");
+    CPLPopErrorHandler();
+    if (!fp)
+    {
+        CPLDebug("GeoJSONSeq", "Cannot create %s",
+                 m_osSidecarIndexFilename.c_str());
+        return;
+    }
+
+    GByte abyHeader[SIDECAR_INDEX_HEADER_SIZE];
+    memcpy(abyHeader, SIDECAR_INDEX_MAGIC, SIDECAR_INDEX_MAGIC_SIZE);
+    uint64_t nFileSize = static_cast<uint64_t>(sStat.st_size);
+    CPL_LSBPTR64(&nFileSize);
+    memcpy(abyHeader + SIDECAR_INDEX_MAGIC_SIZE, &nFileSize, 8);
+    int64_t nMTime = static_cast<int64_t>(sStat.st_mtime);
+    CPL_LSBPTR64(&nMTime);
+    memcpy(abyHeader + SIDECAR_INDEX_MAGIC_SIZE + 8, &nMTime, 8);
+    uint64_t nItemCount = static_cast<uint64_t>(m_asIndexedFeatures.size());
+    CPL_LSBPTR64(&nItemCount);
+    memcpy(abyHeader + SIDECAR_INDEX_MAGIC_SIZE + 16, &nItemCount, 8);
+    bool bOK = VSIFWriteL(abyHeader, sizeof(abyHeader), 1, fp) == 1;
+
+    for (size_t i = 0; bOK && i < m_asIndexedFeatures.size(); ++i)
+    {
+        const auto &sLocation = m_asIndexedFeatures[i];
+        GByte abyItem[SIDECAR_INDEX_ITEM_SIZE];
+        uint64_t nOffset = static_cast<uint64_t>(sLocation.nOffset);
+        CPL_LSBPTR64(&nOffset);
+        memcpy(abyItem, &nOffset, 8);
+        uint64_t nSize = static_cast<uint64_t>(sLocation.nSize);
+        CPL_LSBPTR64(&nSize);
+        memcpy(abyItem + 8, &nSize, 8);
+        int64_t nFID = static_cast<int64_t>(sLocation.nFID);
+        CPL_LSBPTR64(&nFID);
+        memcpy(abyItem + 16, &nFID, 8);
+        double adfEnv[4] = {asEnvelopes[i].MinX, asEnvelopes[i].MinY,
+                            asEnvelopes[i].MaxX, asEnvelopes[i].MaxY};
+        for (double &dfVal : adfEnv)
+            CPL_LSBPTR64(&dfVal);
+        memcpy(abyItem + 24, adfEnv, sizeof(adfEnv));
+        bOK = VSIFWriteL(abyItem, sizeof(abyItem), 1, fp) == 1;
+    }
+
+    if (VSIFCloseL(fp) != 0)
+        bOK = false;
+    if (!bOK)
+    {
+        CPLDebug("GeoJSONSeq", "Cannot write %s",
+                 m_osSidecarIndexFilename.c_str());
+        VSIUnlink(m_osSidecarIndexFilename.c_str());
+    }
 }
 
 /************************************************************************/
@@ -655,6 +1261,7 @@ OGRErr OGRGeoJSONSeqLayer::ICreateFeature(OGRFeature *poFeature)
     }
 
     ++m_nTotalFeatures;
+    InvalidateSpatialIndex();
 
     json_object *poObj = OGRGeoJSONWriteFeature(
         poFeatureToWrite.get() ? poFeatureToWrite.get() : poFeature,
@@ -805,6 +1412,14 @@ bool OGRGeoJSONSeqDataSource::Open(GDALOpenInfo *poOpenInfo,
     }
     const bool bEstablishLayerDefn = poOpenInfo->eAccess != GA_Update;
     auto ret = poLayer->Init(bLooseIdentification, bEstablishLayerDefn);
+    if (ret && nSrcType == eGeoJSONSourceFile &&
+        poOpenInfo->eAccess == GA_ReadOnly &&
+        CPLFetchBool(poOpenInfo->papszOpenOptions, "SIDECAR_SPATIAL_INDEX",
+                     false))
+    {
+        poLayer->SetSidecarIndexFilename(std::string(pszUnprefixedFilename) +
+                                         SIDECAR_INDEX_EXTENSION);
+    }
     if (bLooseIdentification)
     {
         CPLPopErrorHandler();
@@ -966,6 +1581,14 @@ void RegisterOGRGeoJSONSeq()
         "  </Option>"
         "</LayerCreationOptionList>");
 
+    poDriver->SetMetadataItem(
+        GDAL_DMD_OPENOPTIONLIST,
+        "<OpenOptionList>"
+        "  <Option name='SIDECAR_SPATIAL_INDEX' type='boolean' "
+        "description='Whether to read the spatial index from, and save it to, "
+        "a .gjsidx sidecar file' default='NO'/>"
+        "</OpenOptionList>");
+
     poDriver->SetMetadataItem(GDAL_DCAP_VIRTUALIO, "YES");
     poDriver->SetMetadataItem(GDAL_DMD_CREATIONFIELDDATATYPES,
                               "Integer Integer64 Real String IntegerList "
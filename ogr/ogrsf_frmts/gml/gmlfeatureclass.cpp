@@ -80,6 +80,36 @@ GMLFeatureClass::~GMLFeatureClass()
     CPLFree(m_pszSRSName);
 }
 
+/************************************************************************/
+/*                               Clone()                                */
+/************************************************************************/
+
+GMLFeatureClass *GMLFeatureClass::Clone() const
+
+{
+    GMLFeatureClass *poNew = new GMLFeatureClass(m_pszName);
+    if (m_pszElementName)
+        poNew->SetElementName(m_pszElementName);
+    for (int i = 0; i < m_nPropertyCount; i++)
+        poNew->AddProperty(m_papoProperty[i]->Clone());
+    for (int i = 0; i < m_nGeometryPropertyCount; i++)
+        poNew->AddGeometryProperty(m_papoGeometryProperty[i]->Clone());
+    poNew->m_bSchemaLocked = m_bSchemaLocked;
+    poNew->m_nFeatureCount = m_nFeatureCount;
+    poNew->SetExtraInfo(m_pszExtraInfo);
+    poNew->m_bHaveExtents = m_bHaveExtents;
+    poNew->m_dfXMin = m_dfXMin;
+    poNew->m_dfXMax = m_dfXMax;
+    poNew->m_dfYMin = m_dfYMin;
+    poNew->m_dfYMax = m_dfYMax;
+    poNew->m_pszSRSName = m_pszSRSName ? CPLStrdup(m_pszSRSName) : nullptr;
+    poNew->m_bSRSNameConsistent = m_bSRSNameConsistent;
+    poNew->m_bIsConsistentSingleGeomElemPath =
+        m_bIsConsistentSingleGeomElemPath;
+    poNew->m_osSingleGeomElemPath = m_osSingleGeomElemPath;
+    return poNew;
+}
+
 /************************************************************************/
 /*                         StealProperties()                            */
 /************************************************************************/
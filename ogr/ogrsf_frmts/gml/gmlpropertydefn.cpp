@@ -60,6 +60,24 @@ GMLPropertyDefn::~GMLPropertyDefn()
     CPLFree(m_pszCondition);
 }
 
+/************************************************************************/
+/*                               Clone()                                */
+/************************************************************************/
+
+GMLPropertyDefn *GMLPropertyDefn::Clone() const
+
+{
+    GMLPropertyDefn *poNew = new GMLPropertyDefn(m_pszName, m_pszSrcElement);
+    poNew->m_eType = m_eType;
+    poNew->m_nWidth = m_nWidth;
+    poNew->m_nPrecision = m_nPrecision;
+    poNew->SetCondition(m_pszCondition);
+    poNew->m_bNullable = m_bNullable;
+    poNew->m_bUnique = m_bUnique;
+    poNew->m_osDocumentation = m_osDocumentation;
+    return poNew;
+}
+
 /************************************************************************/
 /*                           SetSrcElement()                            */
 /************************************************************************/
@@ -239,6 +257,21 @@ GMLGeometryPropertyDefn::~GMLGeometryPropertyDefn()
     CPLFree(m_pszSrcElement);
 }
 
+/************************************************************************/
+/*                               Clone()                                */
+/************************************************************************/
+
+GMLGeometryPropertyDefn *GMLGeometryPropertyDefn::Clone() const
+
+{
+    GMLGeometryPropertyDefn *poNew =
+        new GMLGeometryPropertyDefn(m_pszName, m_pszSrcElement, m_nGeometryType,
+                                    m_nAttributeIndex, m_bNullable);
+    poNew->m_bSRSNameConsistent = m_bSRSNameConsistent;
+    poNew->m_osSRSName = m_osSRSName;
+    return poNew;
+}
+
 /************************************************************************/
 /*                           MergeSRSName()                             */
 /************************************************************************/
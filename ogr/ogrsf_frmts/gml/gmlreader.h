@@ -96,6 +96,8 @@ class CPL_DLL GMLPropertyDefn
                              const char *pszSrcElement = nullptr);
     ~GMLPropertyDefn();
 
+    GMLPropertyDefn *Clone() const;
+
     const char *GetName() const
     {
         return m_pszName;
@@ -197,6 +199,8 @@ class CPL_DLL GMLGeometryPropertyDefn
                             int nType, int nAttributeIndex, bool bNullable);
     ~GMLGeometryPropertyDefn();
 
+    GMLGeometryPropertyDefn *Clone() const;
+
     const char *GetName() const
     {
         return m_pszName;
@@ -276,6 +280,8 @@ class CPL_DLL GMLFeatureClass
     explicit GMLFeatureClass(const char *pszName = "");
     ~GMLFeatureClass();
 
+    GMLFeatureClass *Clone() const;
+
     const char *GetElementName() const;
     size_t GetElementNameLen() const;
     void SetElementName(const char *pszElementName);
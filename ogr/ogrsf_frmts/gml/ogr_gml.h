@@ -36,9 +36,12 @@
 #include "gmlreader.h"
 #include "gmlutils.h"
 
+#include <deque>
 #include <memory>
+#include <string>
 #include <vector>
 
+class CPLJobQueue;
 class OGRGMLDataSource;
 
 typedef enum
@@ -48,6 +51,25 @@ typedef enum
     INTERLEAVED_LAYERS
 } ReadMode;
 
+/************************************************************************/
+/*                        OGRGMLPrefetchedFeature                       */
+/************************************************************************/
+
+// GMLFeature read ahead by OGRGMLLayer, whose geometry may already have
+// been built by a worker thread.
+struct OGRGMLPrefetchedFeature
+{
+    GMLFeature *poGMLFeature = nullptr;
+    bool bGeomBuilt = false;
+    std::unique_ptr<OGRGeometry> poGeom{};
+    std::string osErrorMsg{};
+
+    OGRGMLPrefetchedFeature() = default;
+    ~OGRGMLPrefetchedFeature();
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRGMLPrefetchedFeature)
+};
+
 /************************************************************************/
 /*                            OGRGMLLayer                               */
 /************************************************************************/
@@ -73,6 +95,18 @@ class OGRGMLLayer final : public OGRLayer
 
     bool bFaceHoleNegative;
 
+    // Multi-threaded geometry building (GML_NUM_THREADS)
+    int m_nNumThreads = 0;
+    std::deque<std::unique_ptr<OGRGMLPrefetchedFeature>> m_oPrefetchedQueue{};
+    std::vector<void *> m_ahJobCacheSRS{};
+    std::unique_ptr<CPLJobQueue> m_poJobQueue{};
+
+    struct BuildGeometryJob;
+    static void BuildGeometryJobFunc(void *pData);
+    int GetNumThreads();
+    bool CanPrefetch();
+    bool PrefetchNextBatch();
+
   public:
     OGRGMLLayer(const char *pszName, bool bWriter, OGRGMLDataSource *poDS);
 
@@ -30,6 +30,7 @@
 #include "cpl_conv.h"
 #include "cpl_multiproc.h"
 #include "gmlreaderp.h"
+#include "parsexsd.h"
 
 /************************************************************************/
 /*                         OGRGMLDriverIdentify()                       */
@@ -123,6 +124,15 @@ OGRGMLDriverCreate(const char *pszName, CPL_UNUSED int nBands,
         return poDS;
 }
 
+/************************************************************************/
+/*                         OGRGMLDriverUnload()                         */
+/************************************************************************/
+
+static void OGRGMLDriverUnload(GDALDriver * /* poDriver */)
+{
+    GMLClearXSDCache();
+}
+
 /************************************************************************/
 /*                           RegisterOGRGML()                           */
 /************************************************************************/
@@ -298,6 +308,7 @@ void RegisterOGRGML()
     poDriver->pfnOpen = OGRGMLDriverOpen;
     poDriver->pfnIdentify = OGRGMLDriverIdentify;
     poDriver->pfnCreate = OGRGMLDriverCreate;
+    poDriver->pfnUnloadDriver = OGRGMLDriverUnload;
 
     GetGDALDriverManager()->RegisterDriver(poDriver);
 }
@@ -32,9 +32,13 @@
 #include "cpl_conv.h"
 #include "cpl_port.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "ogr_p.h"
 #include "ogr_api.h"
 
+#include <algorithm>
+
 /************************************************************************/
 /*                           OGRGMLLayer()                              */
 /************************************************************************/
@@ -75,6 +79,19 @@ OGRGMLLayer::~OGRGMLLayer()
         poFeatureDefn->Release();
 
     GML_BuildOGRGeometryFromList_DestroyCache(hCacheSRS);
+
+    m_oPrefetchedQueue.clear();
+    for (void *hJobCacheSRS : m_ahJobCacheSRS)
+        GML_BuildOGRGeometryFromList_DestroyCache(hJobCacheSRS);
+}
+
+/************************************************************************/
+/*                     ~OGRGMLPrefetchedFeature()                       */
+/************************************************************************/
+
+OGRGMLPrefetchedFeature::~OGRGMLPrefetchedFeature()
+{
+    delete poGMLFeature;
 }
 
 /************************************************************************/
@@ -87,6 +104,8 @@ void OGRGMLLayer::ResetReading()
     if (bWriter)
         return;
 
+    m_oPrefetchedQueue.clear();
+
     if (poDS->GetReadMode() == INTERLEAVED_LAYERS ||
         poDS->GetReadMode() == SEQUENTIAL_LAYERS)
     {
@@ -124,6 +143,167 @@ static GIntBig Increment(GIntBig nVal)
     return nVal;
 }
 
+/************************************************************************/
+/*                            GetNumThreads()                           */
+/************************************************************************/
+
+int OGRGMLLayer::GetNumThreads()
+{
+    if (m_nNumThreads == 0)
+    {
+        const char *pszNumThreads =
+            CPLGetConfigOption("GML_NUM_THREADS", "1");
+        if (EQUAL(pszNumThreads, "ALL_CPUS"))
+            m_nNumThreads = CPLGetNumCPUs();
+        else
+            m_nNumThreads = atoi(pszNumThreads);
+        m_nNumThreads = std::max(1, std::min(m_nNumThreads, 128));
+    }
+    return m_nNumThreads;
+}
+
+/************************************************************************/
+/*                             CanPrefetch()                            */
+/************************************************************************/
+
+// Features are only read ahead in the STANDARD read mode, where features of
+// other layers are just skipped, and for layers with a single geometry
+// field.
+bool OGRGMLLayer::CanPrefetch()
+{
+    return poDS->GetReadMode() == STANDARD &&
+           poFeatureDefn->GetGeomFieldCount() <= 1 && GetNumThreads() > 1;
+}
+
+/************************************************************************/
+/*                          BuildGeometryJob                            */
+/************************************************************************/
+
+struct OGRGMLLayer::BuildGeometryJob
+{
+    OGRGMLLayer *poLayer = nullptr;
+    OGRGMLPrefetchedFeature *const *papoFeatures = nullptr;
+    size_t nFeatures = 0;
+    void *hCacheSRS = nullptr;
+    const char *pszSRSName = nullptr;
+    OGRwkbGeometryType eGeomType = wkbUnknown;
+};
+
+// Same geometry building as the single geometry field case of
+// GetNextFeature(), except that errors are stored in the prefetched feature
+// to be reported by the main thread.
+void OGRGMLLayer::BuildGeometryJobFunc(void *pData)
+{
+    const BuildGeometryJob *psJob = static_cast<BuildGeometryJob *>(pData);
+    const OGRGMLDataSource *poDS = psJob->poLayer->poDS;
+
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    for (size_t i = 0; i < psJob->nFeatures; ++i)
+    {
+        OGRGMLPrefetchedFeature *poPrefetched = psJob->papoFeatures[i];
+        const GMLFeature *poGMLFeature = poPrefetched->poGMLFeature;
+        const CPLXMLNode *const *papsGeometry =
+            poGMLFeature->GetGeometryList();
+
+        const CPLXMLNode *apsGeometries[2] = {nullptr, nullptr};
+        const CPLXMLNode *psBoundedByGeometry =
+            poGMLFeature->GetBoundedByGeometry();
+        if (psBoundedByGeometry && !(papsGeometry && papsGeometry[0]))
+        {
+            apsGeometries[0] = psBoundedByGeometry;
+            papsGeometry = apsGeometries;
+        }
+        if (papsGeometry == nullptr || papsGeometry[0] == nullptr ||
+            strcmp(papsGeometry[0]->pszValue, "null") == 0)
+        {
+            continue;
+        }
+
+        CPLErrorReset();
+        OGRGeometry *poGeom = GML_BuildOGRGeometryFromList(
+            papsGeometry, true, poDS->GetInvertAxisOrderIfLatLong(),
+            psJob->pszSRSName, poDS->GetConsiderEPSGAsURN(),
+            poDS->GetSwapCoordinates(), poDS->GetSecondaryGeometryOption(),
+            psJob->hCacheSRS, psJob->poLayer->bFaceHoleNegative);
+        if (poGeom != nullptr)
+            poGeom = OGRGeometryFactory::forceTo(poGeom, psJob->eGeomType);
+        else
+            poPrefetched->osErrorMsg = CPLGetLastErrorMsg();
+        poPrefetched->poGeom.reset(poGeom);
+        poPrefetched->bGeomBuilt = true;
+    }
+    CPLPopErrorHandler();
+}
+
+/************************************************************************/
+/*                          PrefetchNextBatch()                         */
+/************************************************************************/
+
+// Reads a batch of features in the current thread, builds the geometries
+// of the ones of this layer in worker threads, and appends them, in file
+// order, to m_oPrefetchedQueue.
+// Returns false if no feature could be read.
+bool OGRGMLLayer::PrefetchNextBatch()
+{
+    const size_t nBatchSize = static_cast<size_t>(m_nNumThreads) * 256;
+    std::vector<OGRGMLPrefetchedFeature *> apoToBuild;
+    size_t nRead = 0;
+    while (nRead < nBatchSize)
+    {
+        GMLFeature *poGMLFeature = poDS->GetReader()->NextFeature();
+        if (poGMLFeature == nullptr)
+            break;
+        auto poPrefetched = std::make_unique<OGRGMLPrefetchedFeature>();
+        poPrefetched->poGMLFeature = poGMLFeature;
+        if (poGMLFeature->GetClass() == poFClass)
+            apoToBuild.push_back(poPrefetched.get());
+        m_oPrefetchedQueue.push_back(std::move(poPrefetched));
+        ++nRead;
+    }
+    if (nRead == 0)
+        return false;
+
+    const size_t nFeatures = apoToBuild.size();
+    const size_t nJobs = std::min(static_cast<size_t>(m_nNumThreads),
+                                  (nFeatures + 63) / 64);
+    while (m_ahJobCacheSRS.size() < nJobs)
+        m_ahJobCacheSRS.push_back(GML_BuildOGRGeometryFromList_CreateCache());
+
+    const char *pszGlobalSRSName = poDS->GetGlobalSRSName();
+    const std::string osSRSName(pszGlobalSRSName ? pszGlobalSRSName : "");
+
+    std::vector<BuildGeometryJob> asJobs(nJobs);
+    for (size_t iJob = 0; iJob < nJobs; ++iJob)
+    {
+        const size_t iStart = iJob * nFeatures / nJobs;
+        asJobs[iJob].poLayer = this;
+        asJobs[iJob].papoFeatures = apoToBuild.data() + iStart;
+        asJobs[iJob].nFeatures = (iJob + 1) * nFeatures / nJobs - iStart;
+        asJobs[iJob].hCacheSRS = m_ahJobCacheSRS[iJob];
+        asJobs[iJob].pszSRSName =
+            pszGlobalSRSName ? osSRSName.c_str() : nullptr;
+        asJobs[iJob].eGeomType = GetGeomType();
+    }
+
+    CPLWorkerThreadPool *poPool =
+        nJobs > 1 ? GDALGetGlobalThreadPool(m_nNumThreads) : nullptr;
+    if (poPool && !m_poJobQueue)
+        m_poJobQueue = poPool->CreateJobQueue();
+    for (size_t iJob = 0; iJob < nJobs; ++iJob)
+    {
+        // The last job is run in the current thread
+        if (!m_poJobQueue || iJob + 1 == nJobs ||
+            !m_poJobQueue->SubmitJob(BuildGeometryJobFunc, &asJobs[iJob]))
+        {
+            BuildGeometryJobFunc(&asJobs[iJob]);
+        }
+    }
+    if (m_poJobQueue)
+        m_poJobQueue->WaitCompletion();
+
+    return true;
+}
+
 /************************************************************************/
 /*                           GetNextFeature()                           */
 /************************************************************************/
@@ -152,10 +332,22 @@ OGRFeature *OGRGMLLayer::GetNextFeature()
     while (true)
     {
         GMLFeature *poGMLFeature = poDS->PeekStoredGMLFeature();
+        std::unique_ptr<OGRGMLPrefetchedFeature> poPrefetched;
         if (poGMLFeature != nullptr)
         {
             poDS->SetStoredGMLFeature(nullptr);
         }
+        else if (CanPrefetch())
+        {
+            if (m_oPrefetchedQueue.empty() && !PrefetchNextBatch())
+                return nullptr;
+            poPrefetched = std::move(m_oPrefetchedQueue.front());
+            m_oPrefetchedQueue.pop_front();
+            poGMLFeature = poPrefetched->poGMLFeature;
+            poPrefetched->poGMLFeature = nullptr;
+
+            m_nFeaturesRead++;
+        }
         else
         {
             poGMLFeature = poDS->GetReader()->NextFeature();
@@ -355,24 +547,34 @@ OGRFeature *OGRGMLLayer::GetNextFeature()
         }
         else if (papsGeometry[0] != nullptr)
         {
-            const char *pszSRSName = poDS->GetGlobalSRSName();
-            CPLPushErrorHandler(CPLQuietErrorHandler);
-            poGeom = GML_BuildOGRGeometryFromList(
-                papsGeometry, true, poDS->GetInvertAxisOrderIfLatLong(),
-                pszSRSName, poDS->GetConsiderEPSGAsURN(),
-                poDS->GetSwapCoordinates(), poDS->GetSecondaryGeometryOption(),
-                hCacheSRS, bFaceHoleNegative);
-            CPLPopErrorHandler();
-
-            // Do geometry type changes if needed to match layer geometry type.
-            if (poGeom != nullptr)
+            CPLString osLastErrorMsg;
+            if (poPrefetched && poPrefetched->bGeomBuilt)
             {
-                poGeom = OGRGeometryFactory::forceTo(poGeom, GetGeomType());
+                poGeom = poPrefetched->poGeom.release();
+                osLastErrorMsg = poPrefetched->osErrorMsg;
             }
             else
             {
-                const CPLString osLastErrorMsg(CPLGetLastErrorMsg());
+                const char *pszSRSName = poDS->GetGlobalSRSName();
+                CPLPushErrorHandler(CPLQuietErrorHandler);
+                poGeom = GML_BuildOGRGeometryFromList(
+                    papsGeometry, true, poDS->GetInvertAxisOrderIfLatLong(),
+                    pszSRSName, poDS->GetConsiderEPSGAsURN(),
+                    poDS->GetSwapCoordinates(),
+                    poDS->GetSecondaryGeometryOption(), hCacheSRS,
+                    bFaceHoleNegative);
+                CPLPopErrorHandler();
+
+                // Do geometry type changes if needed to match layer geometry
+                // type.
+                if (poGeom != nullptr)
+                    poGeom = OGRGeometryFactory::forceTo(poGeom, GetGeomType());
+                else
+                    osLastErrorMsg = CPLGetLastErrorMsg();
+            }
 
+            if (poGeom == nullptr)
+            {
                 const bool bGoOn = CPLTestBool(
                     CPLGetConfigOption("GML_SKIP_CORRUPTED_FEATURES", "NO"));
 
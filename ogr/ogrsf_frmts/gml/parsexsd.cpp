@@ -32,6 +32,9 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <utility>
@@ -41,6 +44,7 @@
 #include "cpl_http.h"
 #include "cpl_minixml.h"
 #include "cpl_string.h"
+#include "cpl_vsi.h"
 #include "ogr_core.h"
 
 /************************************************************************/
@@ -1010,12 +1014,12 @@ GetUniqueConstraints(const CPLXMLNode *psNode)
 }
 
 /************************************************************************/
-/*                          GMLParseXSD()                               */
+/*                        GMLParseXSDInternal()                         */
 /************************************************************************/
 
-bool GMLParseXSD(const char *pszFile,
-                 std::vector<GMLFeatureClass *> &aosClasses,
-                 bool &bFullyUnderstood)
+static bool GMLParseXSDInternal(const char *pszFile,
+                                std::vector<GMLFeatureClass *> &aosClasses,
+                                bool &bFullyUnderstood)
 
 {
     bFullyUnderstood = false;
@@ -1195,3 +1199,94 @@ bool GMLParseXSD(const char *pszFile,
 
     return !aosClasses.empty();
 }
+
+/************************************************************************/
+/*                           XSD cache                                  */
+/*                                                                      */
+/*      Analysing big application schemas (with their includes) can    */
+/*      take longer than reading a small GML file, so the resulting     */
+/*      feature classes are kept per .xsd filename, and reused as long  */
+/*      as the size and modification time of the file do not change.   */
+/************************************************************************/
+
+namespace
+{
+struct GMLXSDCacheEntry
+{
+    GIntBig nMTime = 0;
+    vsi_l_offset nSize = 0;
+    bool bFullyUnderstood = false;
+    std::vector<std::unique_ptr<GMLFeatureClass>> apoClasses{};
+};
+}  // namespace
+
+constexpr size_t GML_XSD_CACHE_MAX_ENTRIES = 32;
+
+static std::mutex goMutexXSDCache;
+static std::map<std::string, GMLXSDCacheEntry> goMapXSDCache;
+
+/************************************************************************/
+/*                          GMLParseXSD()                               */
+/************************************************************************/
+
+bool GMLParseXSD(const char *pszFile,
+                 std::vector<GMLFeatureClass *> &aosClasses,
+                 bool &bFullyUnderstood)
+
+{
+    // Files in /vsimem/ are temporary downloads whose name may be reused.
+    VSIStatBufL sStat;
+    if (pszFile == nullptr || STARTS_WITH(pszFile, "/vsimem/") ||
+        !CPLTestBool(CPLGetConfigOption("GML_XSD_CACHE", "YES")) ||
+        VSIStatL(pszFile, &sStat) != 0 || !VSI_ISREG(sStat.st_mode))
+    {
+        return GMLParseXSDInternal(pszFile, aosClasses, bFullyUnderstood);
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(goMutexXSDCache);
+        const auto oIter = goMapXSDCache.find(pszFile);
+        if (oIter != goMapXSDCache.end())
+        {
+            const GMLXSDCacheEntry &oEntry = oIter->second;
+            if (oEntry.nMTime == static_cast<GIntBig>(sStat.st_mtime) &&
+                oEntry.nSize == static_cast<vsi_l_offset>(sStat.st_size))
+            {
+                CPLDebug("GML", "Reusing cached analysis of %s", pszFile);
+                for (const auto &poClass : oEntry.apoClasses)
+                    aosClasses.push_back(poClass->Clone());
+                bFullyUnderstood = oEntry.bFullyUnderstood;
+                return true;
+            }
+            goMapXSDCache.erase(oIter);
+        }
+    }
+
+    const size_t nExistingClasses = aosClasses.size();
+    if (!GMLParseXSDInternal(pszFile, aosClasses, bFullyUnderstood))
+        return false;
+
+    GMLXSDCacheEntry oEntry;
+    oEntry.nMTime = static_cast<GIntBig>(sStat.st_mtime);
+    oEntry.nSize = static_cast<vsi_l_offset>(sStat.st_size);
+    oEntry.bFullyUnderstood = bFullyUnderstood;
+    for (size_t i = nExistingClasses; i < aosClasses.size(); ++i)
+        oEntry.apoClasses.emplace_back(aosClasses[i]->Clone());
+
+    std::lock_guard<std::mutex> oLock(goMutexXSDCache);
+    if (goMapXSDCache.size() >= GML_XSD_CACHE_MAX_ENTRIES)
+        goMapXSDCache.clear();
+    goMapXSDCache[pszFile] = std::move(oEntry);
+    return true;
+}
+
+/************************************************************************/
+/*                        GMLClearXSDCache()                            */
+/************************************************************************/
+
+void GMLClearXSDCache()
+
+{
+    std::lock_guard<std::mutex> oLock(goMutexXSDCache);
+    goMapXSDCache.clear();
+}
@@ -40,4 +40,6 @@ bool CPL_DLL GMLParseXSD(const char *pszFile,
                          std::vector<GMLFeatureClass *> &aosClasses,
                          bool &bFullyUnderstood);
 
+void CPL_DLL GMLClearXSDCache();
+
 #endif  // PARSEXSD_H_INCLUDED
@@ -31,6 +31,8 @@
 #include "gdal_alg_priv.h"
 #include "ogrsqlitevfs.h"
 #include "cpl_error.h"
+#include "gdal_thread_pool.h"
+#include "cpl_error_internal.h"
 
 #include <algorithm>
 #include <limits>
@@ -65,6 +67,18 @@ GDALGPKGMBTilesLikePseudoDataset::GDALGPKGMBTilesLikePseudoDataset()
 
 GDALGPKGMBTilesLikePseudoDataset::~GDALGPKGMBTilesLikePseudoDataset()
 {
+    // Tiles should have been inserted by FlushTiles(). Otherwise, wait for
+    // the worker threads to be done with them before discarding them.
+    if (m_poEncodeTileQueue)
+        m_poEncodeTileQueue->WaitCompletion();
+    if (!m_apoEncodedTiles.empty())
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "%d encoded tile(s) have not been written",
+                 static_cast<int>(m_apoEncodedTiles.size()));
+        m_apoEncodedTiles.clear();
+    }
+
     if (m_poParentDS == nullptr && m_hTempDB != nullptr)
     {
         sqlite3_close(m_hTempDB);
@@ -168,6 +182,9 @@ CPLErr GDALGPKGMBTilesLikePseudoDataset::FlushTiles()
         }
     }
 
+    if (WaitEncodedTiles() != CE_None)
+        eErr = CE_Failure;
+
     if (poMainDS->m_nTileInsertionCount > 0)
     {
         if (poMainDS->ICommitTransaction() != OGRERR_NONE)
@@ -856,6 +873,9 @@ GByte *GDALGPKGMBTilesLikePseudoDataset::ReadTile(int nRow, int nCol,
                                                   GByte *pabyData,
                                                   bool *pbIsLossyFormat)
 {
+    // The tile might be one of those being encoded
+    WaitEncodedTiles();
+
     int nBlockXSize = 0;
     int nBlockYSize = 0;
     IGetRasterBand(1)->GetBlockSize(&nBlockXSize, &nBlockYSize);
@@ -877,6 +897,34 @@ GByte *GDALGPKGMBTilesLikePseudoDataset::ReadTile(int nRow, int nCol,
     CPLDebug("GPKG", "ReadTile(row=%d, col=%d)", nRow, nCol);
 #endif
 
+    if (nRow >= m_nPrefetchRowMin && nRow <= m_nPrefetchRowMax &&
+        nCol >= m_nPrefetchColMin && nCol <= m_nPrefetchColMax)
+    {
+        const auto oIter = m_oMapPrefetchedTiles.find(std::pair(nRow, nCol));
+        if (oIter == m_oMapPrefetchedTiles.end())
+        {
+            FillEmptyTile(pabyData);
+            return pabyData;
+        }
+        const PrefetchedTile &oTile = oIter->second;
+        if (!oTile.abyDecoded.empty())
+        {
+            memcpy(pabyData, oTile.abyDecoded.data(), oTile.abyDecoded.size());
+            if (pbIsLossyFormat)
+                *pbIsLossyFormat = oTile.bIsLossyFormat;
+            return pabyData;
+        }
+        CPLString osMemFileName;
+        osMemFileName.Printf("/vsimem/gpkg_read_tile_%p", this);
+        VSIFCloseL(VSIFileFromMemBuffer(
+            osMemFileName.c_str(),
+            reinterpret_cast<GByte *>(const_cast<char *>(oTile.osData.data())),
+            oTile.osData.size(), FALSE));
+        ReadTile(osMemFileName, pabyData, 0.0, 1.0, pbIsLossyFormat);
+        VSIUnlink(osMemFileName);
+        return pabyData;
+    }
+
     char *pszSQL = sqlite3_mprintf(
         "SELECT tile_data%s FROM \"%w\" "
         "WHERE zoom_level = %d AND tile_row = %d AND tile_column = %d%s",
@@ -994,6 +1042,259 @@ GByte *GDALGPKGMBTilesLikePseudoDataset::ReadTile(int nRow, int nCol,
     return pabyData;
 }
 
+/************************************************************************/
+/*                           PrefetchTiles()                            */
+/************************************************************************/
+
+/** Fetch in a single SQL query the tiles of the [nRowMin, nRowMax] x
+ * [nColMin, nColMax] window (in top-left origin convention), so that the
+ * following ReadTile() calls on that window do not issue one query per tile.
+ *
+ * Only used in read-only mode, and for Byte data (that is without per-tile
+ * offset and scale).
+ */
+bool GDALGPKGMBTilesLikePseudoDataset::PrefetchTiles(int nRowMin, int nColMin,
+                                                     int nRowMax, int nColMax)
+{
+    ClearPrefetchedTiles();
+
+    constexpr int MAX_PREFETCHED_TILES = 1024;
+    nRowMin = std::max(nRowMin, 0);
+    nColMin = std::max(nColMin, 0);
+    nRowMax = std::min(nRowMax, m_nTileMatrixHeight - 1);
+    nColMax = std::min(nColMax, m_nTileMatrixWidth - 1);
+    if (IGetUpdate() || m_eDT != GDT_Byte || nRowMin > nRowMax ||
+        nColMin > nColMax ||
+        (nColMax - nColMin + 1) >
+            MAX_PREFETCHED_TILES / (nRowMax - nRowMin + 1))
+    {
+        return false;
+    }
+
+    const int nDBRow1 = GetRowFromIntoTopConvention(nRowMin);
+    const int nDBRow2 = GetRowFromIntoTopConvention(nRowMax);
+    char *pszSQL = sqlite3_mprintf(
+        "SELECT tile_row, tile_column, tile_data FROM \"%w\" "
+        "WHERE zoom_level = %d AND tile_row BETWEEN %d AND %d AND "
+        "tile_column BETWEEN %d AND %d%s",
+        m_osRasterTable.c_str(), m_nZoomLevel, std::min(nDBRow1, nDBRow2),
+        std::max(nDBRow1, nDBRow2), nColMin, nColMax,
+        !m_osWHERE.empty() ? CPLSPrintf(" AND (%s)", m_osWHERE.c_str()) : "");
+    sqlite3_stmt *hStmt = nullptr;
+    const int rc = sqlite3_prepare_v2(IGetDB(), pszSQL, -1, &hStmt, nullptr);
+    sqlite3_free(pszSQL);
+    if (rc != SQLITE_OK)
+        return false;
+
+    bool bRet = true;
+    while (true)
+    {
+        const int nStepRet = sqlite3_step(hStmt);
+        if (nStepRet == SQLITE_DONE)
+            break;
+        if (nStepRet != SQLITE_ROW)
+        {
+            bRet = false;
+            break;
+        }
+        if (sqlite3_column_type(hStmt, 2) != SQLITE_BLOB)
+            continue;
+        const int nRow =
+            GetRowFromIntoTopConvention(sqlite3_column_int(hStmt, 0));
+        const int nCol = sqlite3_column_int(hStmt, 1);
+        m_oMapPrefetchedTiles[std::pair(nRow, nCol)].osData.assign(
+            static_cast<const char *>(sqlite3_column_blob(hStmt, 2)),
+            sqlite3_column_bytes(hStmt, 2));
+    }
+    sqlite3_finalize(hStmt);
+
+    if (!bRet)
+    {
+        m_oMapPrefetchedTiles.clear();
+        return false;
+    }
+    m_nPrefetchRowMin = nRowMin;
+    m_nPrefetchColMin = nColMin;
+    m_nPrefetchRowMax = nRowMax;
+    m_nPrefetchColMax = nColMax;
+
+    DecodePrefetchedTiles();
+
+    return true;
+}
+
+/************************************************************************/
+/*                         GPKGGetNumThreads()                          */
+/************************************************************************/
+
+/** Return the number of worker threads set by GDAL_NUM_THREADS */
+static int GPKGGetNumThreads()
+{
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    return std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                         ? CPLGetNumCPUs()
+                                         : atoi(pszThreads)));
+}
+
+/************************************************************************/
+/*                        DecodePrefetchedTiles()                       */
+/************************************************************************/
+
+namespace
+{
+struct GPKGDecodeTileJob
+{
+    GDALGPKGMBTilesLikePseudoDataset *poTPD = nullptr;
+    std::string *posData = nullptr;
+    std::vector<GByte> *pabyDecoded = nullptr;
+    bool *pbIsLossyFormat = nullptr;
+    size_t nTileSize = 0;
+};
+}  // namespace
+
+static void GPKGDecodeTileJobFunc(void *pData)
+{
+    auto psJob = static_cast<GPKGDecodeTileJob *>(pData);
+
+    // Errors and warnings are not reported from worker threads: the tile is
+    // then left undecoded, and decoded again by ReadTile() in the calling
+    // thread, which will emit them.
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    const auto nErrorCounter = CPLGetErrorCounter();
+
+    const std::string osMemFileName(CPLSPrintf(
+        "/vsimem/gpkg_decode_tile_%p", static_cast<void *>(psJob->posData)));
+    VSIFCloseL(VSIFileFromMemBuffer(
+        osMemFileName.c_str(),
+        reinterpret_cast<GByte *>(const_cast<char *>(psJob->posData->data())),
+        psJob->posData->size(), FALSE));
+    std::vector<GByte> abyDecoded(psJob->nTileSize);
+    if (psJob->poTPD->ReadTile(osMemFileName, abyDecoded.data(), 0.0, 1.0,
+                               psJob->pbIsLossyFormat) == CE_None &&
+        CPLGetErrorCounter() == nErrorCounter)
+    {
+        *psJob->pabyDecoded = std::move(abyDecoded);
+    }
+    VSIUnlink(osMemFileName.c_str());
+    CPLPopErrorHandler();
+}
+
+/** Decode the tiles fetched by PrefetchTiles() with the GDAL_NUM_THREADS
+ * worker threads, provided that they fit in a quarter of the block cache.
+ * Tiles not decoded there are decoded by ReadTile() when requested.
+ */
+void GDALGPKGMBTilesLikePseudoDataset::DecodePrefetchedTiles()
+{
+    if (m_oMapPrefetchedTiles.size() < 2)
+        return;
+
+    const int nThreads = GPKGGetNumThreads();
+    if (nThreads <= 1)
+        return;
+
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    IGetRasterBand(1)->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    // Same size as a tile of m_pabyCachedTiles, for Byte data
+    const size_t nTileSize = static_cast<size_t>(4) * nBlockXSize * nBlockYSize;
+    if (static_cast<GIntBig>(nTileSize * m_oMapPrefetchedTiles.size()) >
+        GDALGetCacheMax64() / 4)
+    {
+        return;
+    }
+
+    CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    if (poThreadPool == nullptr)
+        return;
+    auto poJobQueue = poThreadPool->CreateJobQueue();
+
+    // Establish the color table, that ReadTile() relies on, before decoding
+    // in the worker threads.
+    if (IGetRasterCount() == 1)
+        IGetRasterBand(1)->GetColorTable();
+
+    std::vector<GPKGDecodeTileJob> asJobs(m_oMapPrefetchedTiles.size());
+    size_t iJob = 0;
+    for (auto &oIter : m_oMapPrefetchedTiles)
+    {
+        auto &sJob = asJobs[iJob++];
+        sJob.poTPD = this;
+        sJob.posData = &oIter.second.osData;
+        sJob.pabyDecoded = &oIter.second.abyDecoded;
+        sJob.pbIsLossyFormat = &oIter.second.bIsLossyFormat;
+        sJob.nTileSize = nTileSize;
+        if (!poJobQueue->SubmitJob(GPKGDecodeTileJobFunc, &sJob))
+        {
+            GPKGDecodeTileJobFunc(&sJob);
+        }
+    }
+    poJobQueue->WaitCompletion();
+}
+
+/************************************************************************/
+/*                      PrefetchTilesForRasterIO()                      */
+/************************************************************************/
+
+/** Prefetch, with PrefetchTiles(), the tiles needed by a full resolution
+ * read of the [nXOff, nXOff + nXSize[ x [nYOff, nYOff + nYSize[ window, if
+ * at least two of its blocks are not already in the block cache.
+ *
+ * Returns true if tiles have been prefetched, in which case
+ * ClearPrefetchedTiles() must be called once the read is done.
+ */
+bool GDALGPKGMBTilesLikePseudoDataset::PrefetchTilesForRasterIO(int nXOff,
+                                                                int nYOff,
+                                                                int nXSize,
+                                                                int nYSize)
+{
+    if (IGetUpdate() || IGetRasterCount() == 0)
+        return false;
+
+    auto poBand =
+        cpl::down_cast<GDALGPKGMBTilesLikeRasterBand *>(IGetRasterBand(1));
+    int nBlockXSize, nBlockYSize;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    const int nBlockXStart = nXOff / nBlockXSize;
+    const int nBlockYStart = nYOff / nBlockYSize;
+    const int nBlockXEnd = (nXOff + nXSize - 1) / nBlockXSize;
+    const int nBlockYEnd = (nYOff + nYSize - 1) / nBlockYSize;
+    int nMissingBlocks = 0;
+    for (int nBlockY = nBlockYStart;
+         nBlockY <= nBlockYEnd && nMissingBlocks < 2; nBlockY++)
+    {
+        for (int nBlockX = nBlockXStart;
+             nBlockX <= nBlockXEnd && nMissingBlocks < 2; nBlockX++)
+        {
+            GDALRasterBlock *poBlock =
+                poBand->AccessibleTryGetLockedBlockRef(nBlockX, nBlockY);
+            if (poBlock)
+                poBlock->DropLock();
+            else
+                nMissingBlocks++;
+        }
+    }
+    if (nMissingBlocks < 2)
+        return false;
+
+    return PrefetchTiles(
+        nBlockYStart + m_nShiftYTiles, nBlockXStart + m_nShiftXTiles,
+        nBlockYEnd + m_nShiftYTiles + (m_nShiftYPixelsMod ? 1 : 0),
+        nBlockXEnd + m_nShiftXTiles + (m_nShiftXPixelsMod ? 1 : 0));
+}
+
+/************************************************************************/
+/*                        ClearPrefetchedTiles()                        */
+/************************************************************************/
+
+void GDALGPKGMBTilesLikePseudoDataset::ClearPrefetchedTiles()
+{
+    m_oMapPrefetchedTiles.clear();
+    m_nPrefetchRowMin = 0;
+    m_nPrefetchColMin = 0;
+    m_nPrefetchRowMax = -1;
+    m_nPrefetchColMax = -1;
+}
+
 /************************************************************************/
 /*                         IReadBlock()                                 */
 /************************************************************************/
@@ -1276,6 +1577,9 @@ GIntBig GDALGPKGMBTilesLikePseudoDataset::GetTileId(int nRow, int nCol)
 
 bool GDALGPKGMBTilesLikePseudoDataset::DeleteTile(int nRow, int nCol)
 {
+    // Do not let a pending insertion of the tile resurrect it
+    WaitEncodedTiles();
+
     char *pszSQL =
         sqlite3_mprintf("DELETE FROM \"%w\" "
                         "WHERE zoom_level = %d AND tile_row = %d AND "
@@ -1423,6 +1727,237 @@ static void ProcessInt16UInt16Tile(
     }
 }
 
+/************************************************************************/
+/*                            InsertTile()                              */
+/************************************************************************/
+
+/** Insert (or replace) an encoded tile into the database, within the
+ * current transaction, that is committed and restarted every 1000 tiles.
+ * pabyBlob, allocated with CPLMalloc(), is taken ownership of.
+ */
+CPLErr GDALGPKGMBTilesLikePseudoDataset::InsertTile(int nRow, int nCol,
+                                                    GByte *pabyBlob,
+                                                    vsi_l_offset nBlobSize)
+{
+    /* Create or commit and recreate transaction */
+    GDALGPKGMBTilesLikePseudoDataset *poMainDS =
+        m_poParentDS ? m_poParentDS : this;
+    if (poMainDS->m_nTileInsertionCount < 0)
+    {
+        CPLFree(pabyBlob);
+        return CE_Failure;
+    }
+    if (poMainDS->m_nTileInsertionCount == 0)
+    {
+        poMainDS->IStartTransaction();
+    }
+    else if (poMainDS->m_nTileInsertionCount == 1000)
+    {
+        if (poMainDS->ICommitTransaction() != OGRERR_NONE)
+        {
+            poMainDS->m_nTileInsertionCount = -1;
+            CPLFree(pabyBlob);
+            return CE_Failure;
+        }
+        poMainDS->IStartTransaction();
+        poMainDS->m_nTileInsertionCount = 0;
+    }
+    poMainDS->m_nTileInsertionCount++;
+
+    CPLErr eErr = CE_Failure;
+    char *pszSQL = sqlite3_mprintf("INSERT OR REPLACE INTO \"%w\" "
+                                   "(zoom_level, tile_row, tile_column, "
+                                   "tile_data) VALUES (%d, %d, %d, ?)",
+                                   m_osRasterTable.c_str(), m_nZoomLevel,
+                                   GetRowFromIntoTopConvention(nRow), nCol);
+#ifdef DEBUG_VERBOSE
+    CPLDebug("GPKG", "%s", pszSQL);
+#endif
+    sqlite3_stmt *hStmt = nullptr;
+    int rc = sqlite3_prepare_v2(IGetDB(), pszSQL, -1, &hStmt, nullptr);
+    if (rc != SQLITE_OK)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "failed to prepare SQL %s: %s",
+                 pszSQL, sqlite3_errmsg(IGetDB()));
+        CPLFree(pabyBlob);
+    }
+    else
+    {
+        sqlite3_bind_blob(hStmt, 1, pabyBlob, static_cast<int>(nBlobSize),
+                          CPLFree);
+        rc = sqlite3_step(hStmt);
+        if (rc == SQLITE_DONE)
+            eErr = CE_None;
+        else
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Failure when inserting tile (row=%d,col=%d) at "
+                     "zoom_level=%d : %s",
+                     GetRowFromIntoTopConvention(nRow), nCol, m_nZoomLevel,
+                     sqlite3_errmsg(IGetDB()));
+        }
+    }
+    sqlite3_finalize(hStmt);
+    sqlite3_free(pszSQL);
+    return eErr;
+}
+
+/************************************************************************/
+/*                            EncodedTile                               */
+/************************************************************************/
+
+struct GDALGPKGMBTilesLikePseudoDataset::EncodedTile
+{
+    GDALGPKGMBTilesLikePseudoDataset *poTPD = nullptr;
+    int nRow = 0;
+    int nCol = 0;
+    GDALDriver *poDriver = nullptr;
+    std::unique_ptr<GDALDataset> poMEMDS{};
+    CPLStringList aosDriverOptions{};
+    GByte *pabyBlob = nullptr;
+    vsi_l_offset nBlobSize = 0;
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+    bool bDone = false;  // protected by poTPD->m_oEncodedTilesMutex
+
+    EncodedTile() = default;
+    EncodedTile(const EncodedTile &) = delete;
+    EncodedTile &operator=(const EncodedTile &) = delete;
+
+    ~EncodedTile()
+    {
+        CPLFree(pabyBlob);
+    }
+};
+
+/************************************************************************/
+/*                         EncodeTileJobFunc()                          */
+/************************************************************************/
+
+void GDALGPKGMBTilesLikePseudoDataset::EncodeTileJobFunc(void *pData)
+{
+    auto psTile = static_cast<EncodedTile *>(pData);
+
+    // Errors are emitted again by WaitEncodedTiles(), in the calling thread
+    CPLInstallErrorHandlerAccumulator(psTile->aoErrors);
+
+    const std::string osMemFileName(CPLSPrintf(
+        "/vsimem/gpkg_encode_tile_%p", static_cast<void *>(psTile)));
+    GDALDataset *poOutDS = psTile->poDriver->CreateCopy(
+        osMemFileName.c_str(), psTile->poMEMDS.get(), FALSE,
+        psTile->aosDriverOptions.List(), nullptr, nullptr);
+    if (poOutDS)
+    {
+        GDALClose(poOutDS);
+        psTile->pabyBlob = VSIGetMemFileBuffer(osMemFileName.c_str(),
+                                               &psTile->nBlobSize, TRUE);
+    }
+    VSIUnlink(osMemFileName.c_str());
+    psTile->poMEMDS.reset();
+
+    CPLUninstallErrorHandlerAccumulator();
+
+    GDALGPKGMBTilesLikePseudoDataset *poTPD = psTile->poTPD;
+    std::lock_guard<std::mutex> oLock(poTPD->m_oEncodedTilesMutex);
+    psTile->bDone = true;
+    poTPD->m_oEncodedTilesCV.notify_all();
+}
+
+/************************************************************************/
+/*                         SubmitEncodeTile()                           */
+/************************************************************************/
+
+/** Submit the encoding of poMEMDS, whose bands may point to
+ * m_pabyCachedTiles, to a worker thread. At most 2 * nThreads tiles are
+ * pending: beyond, the oldest ones are waited for and inserted.
+ */
+CPLErr GDALGPKGMBTilesLikePseudoDataset::SubmitEncodeTile(
+    int nRow, int nCol, int nThreads, GDALDriver *poDriver,
+    GDALDataset *poMEMDS, CSLConstList papszDriverOptions)
+{
+    if (!m_poEncodeTileQueue)
+    {
+        CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+        if (poThreadPool == nullptr)
+            return CE_Failure;
+        m_poEncodeTileQueue = poThreadPool->CreateJobQueue(CPLJobPriority::LOW);
+    }
+
+    // m_pabyCachedTiles is reused for the next tile: work on a copy
+    const int nXSize = poMEMDS->GetRasterXSize();
+    const int nYSize = poMEMDS->GetRasterYSize();
+    const int nBands = poMEMDS->GetRasterCount();
+    std::unique_ptr<GDALDataset> poCopyDS(
+        MEMDataset::Create("", nXSize, nYSize, nBands, GDT_Byte, nullptr));
+    if (!poCopyDS ||
+        GDALDatasetCopyWholeRaster(GDALDataset::ToHandle(poMEMDS),
+                                   GDALDataset::ToHandle(poCopyDS.get()),
+                                   nullptr, nullptr, nullptr) != CE_None)
+    {
+        return CE_Failure;
+    }
+    if (const auto poCT = poMEMDS->GetRasterBand(1)->GetColorTable())
+        poCopyDS->GetRasterBand(1)->SetColorTable(poCT);
+
+    auto poTile = std::make_unique<EncodedTile>();
+    poTile->poTPD = this;
+    poTile->nRow = nRow;
+    poTile->nCol = nCol;
+    poTile->poDriver = poDriver;
+    poTile->poMEMDS = std::move(poCopyDS);
+    poTile->aosDriverOptions = CPLStringList(papszDriverOptions);
+    EncodedTile *psTile = poTile.get();
+    m_apoEncodedTiles.push_back(std::move(poTile));
+    if (!m_poEncodeTileQueue->SubmitJob(EncodeTileJobFunc, psTile))
+    {
+        EncodeTileJobFunc(psTile);
+    }
+
+    return WaitEncodedTiles(2 * static_cast<size_t>(nThreads));
+}
+
+/************************************************************************/
+/*                         WaitEncodedTiles()                           */
+/************************************************************************/
+
+/** Wait for the oldest tiles submitted by SubmitEncodeTile() to be encoded
+ * and insert them, until at most nMaxPendingTiles tiles remain pending.
+ */
+CPLErr GDALGPKGMBTilesLikePseudoDataset::WaitEncodedTiles(
+    size_t nMaxPendingTiles)
+{
+    CPLErr eErr = CE_None;
+    while (m_apoEncodedTiles.size() > nMaxPendingTiles)
+    {
+        std::unique_ptr<EncodedTile> poTile =
+            std::move(m_apoEncodedTiles.front());
+        m_apoEncodedTiles.pop_front();
+        {
+            std::unique_lock<std::mutex> oLock(m_oEncodedTilesMutex);
+            m_oEncodedTilesCV.wait(oLock,
+                                   [&poTile]() { return poTile->bDone; });
+        }
+
+        for (const auto &oError : poTile->aoErrors)
+        {
+            CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+        }
+        if (poTile->pabyBlob == nullptr)
+        {
+            eErr = CE_Failure;
+            continue;
+        }
+
+        GByte *pabyBlob = poTile->pabyBlob;
+        poTile->pabyBlob = nullptr;
+        if (InsertTile(poTile->nRow, poTile->nCol, pabyBlob,
+                       poTile->nBlobSize) != CE_None)
+        {
+            eErr = CE_Failure;
+        }
+    }
+    return eErr;
+}
+
 /************************************************************************/
 /*                         WriteTile()                                  */
 /************************************************************************/
@@ -2214,6 +2749,18 @@ CPLErr GDALGPKGMBTilesLikePseudoDataset::WriteTileInternal()
                                     CPLSPrintf("%d", nBlockYSize));
             }
         }
+        // Byte tiles, that do not need a gpkg_2d_gridded_tile_ancillary
+        // record, can be encoded by worker threads.
+        const int nThreads = m_eDT == GDT_Byte ? GPKGGetNumThreads() : 1;
+        if (nThreads > 1)
+        {
+            eErr = SubmitEncodeTile(nRow, nCol, nThreads, l_poDriver, poMEMDS,
+                                    papszDriverOptions);
+            CSLDestroy(papszDriverOptions);
+            delete poMEMDS;
+            return eErr;
+        }
+
 #ifdef DEBUG
         VSIStatBufL sStat;
         CPLAssert(VSIStatL(osMemFileName, &sStat) != 0);
@@ -2231,64 +2778,15 @@ CPLErr GDALGPKGMBTilesLikePseudoDataset::WriteTileInternal()
             GByte *pabyBlob =
                 VSIGetMemFileBuffer(osMemFileName, &nBlobSize, TRUE);
 
-            /* Create or commit and recreate transaction */
+            eErr = InsertTile(nRow, nCol, pabyBlob, nBlobSize);
             GDALGPKGMBTilesLikePseudoDataset *poMainDS =
                 m_poParentDS ? m_poParentDS : this;
-            if (poMainDS->m_nTileInsertionCount == 0)
-            {
-                poMainDS->IStartTransaction();
-            }
-            else if (poMainDS->m_nTileInsertionCount == 1000)
-            {
-                if (poMainDS->ICommitTransaction() != OGRERR_NONE)
-                {
-                    poMainDS->m_nTileInsertionCount = -1;
-                    CPLFree(pabyBlob);
-                    VSIUnlink(osMemFileName);
-                    delete poMEMDS;
-                    return CE_Failure;
-                }
-                poMainDS->IStartTransaction();
-                poMainDS->m_nTileInsertionCount = 0;
-            }
-            poMainDS->m_nTileInsertionCount++;
-
-            char *pszSQL =
-                sqlite3_mprintf("INSERT OR REPLACE INTO \"%w\" "
-                                "(zoom_level, tile_row, tile_column, "
-                                "tile_data) VALUES (%d, %d, %d, ?)",
-                                m_osRasterTable.c_str(), m_nZoomLevel,
-                                GetRowFromIntoTopConvention(nRow), nCol);
-#ifdef DEBUG_VERBOSE
-            CPLDebug("GPKG", "%s", pszSQL);
-#endif
-            sqlite3_stmt *hStmt = nullptr;
-            int rc = sqlite3_prepare_v2(IGetDB(), pszSQL, -1, &hStmt, nullptr);
-            if (rc != SQLITE_OK)
-            {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "failed to prepare SQL %s: %s", pszSQL,
-                         sqlite3_errmsg(IGetDB()));
-                CPLFree(pabyBlob);
-            }
-            else
+            if (poMainDS->m_nTileInsertionCount < 0)
             {
-                sqlite3_bind_blob(hStmt, 1, pabyBlob,
-                                  static_cast<int>(nBlobSize), CPLFree);
-                rc = sqlite3_step(hStmt);
-                if (rc == SQLITE_DONE)
-                    eErr = CE_None;
-                else
-                {
-                    CPLError(CE_Failure, CPLE_AppDefined,
-                             "Failure when inserting tile (row=%d,col=%d) at "
-                             "zoom_level=%d : %s",
-                             GetRowFromIntoTopConvention(nRow), nCol,
-                             m_nZoomLevel, sqlite3_errmsg(IGetDB()));
-                }
+                VSIUnlink(osMemFileName);
+                delete poMEMDS;
+                return CE_Failure;
             }
-            sqlite3_finalize(hStmt);
-            sqlite3_free(pszSQL);
 
             if (m_eTF == GPKG_TF_PNG_16BIT || m_eTF == GPKG_TF_TIFF_32BIT_FLOAT)
             {
@@ -2299,7 +2797,7 @@ CPLErr GDALGPKGMBTilesLikePseudoDataset::WriteTileInternal()
                 {
                     DeleteFromGriddedTileAncillary(nTileId);
 
-                    pszSQL = sqlite3_mprintf(
+                    char *pszSQL = sqlite3_mprintf(
                         "INSERT INTO gpkg_2d_gridded_tile_ancillary "
                         "(tpudt_name, tpudt_id, scale, offset, min, max, "
                         "mean, std_dev) VALUES "
@@ -2308,9 +2806,9 @@ CPLErr GDALGPKGMBTilesLikePseudoDataset::WriteTileInternal()
 #ifdef DEBUG_VERBOSE
                     CPLDebug("GPKG", "%s", pszSQL);
 #endif
-                    hStmt = nullptr;
-                    rc = sqlite3_prepare_v2(IGetDB(), pszSQL, -1, &hStmt,
-                                            nullptr);
+                    sqlite3_stmt *hStmt = nullptr;
+                    int rc = sqlite3_prepare_v2(IGetDB(), pszSQL, -1, &hStmt,
+                                                nullptr);
                     if (rc != SQLITE_OK)
                     {
                         eErr = CE_Failure;
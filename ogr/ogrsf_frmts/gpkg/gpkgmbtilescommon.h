@@ -34,6 +34,17 @@
 #include "gdal_pam.h"
 #include <sqlite3.h>
 
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+class CPLJobQueue;
+
 typedef struct
 {
     int nRow;
@@ -112,8 +123,46 @@ class GDALGPKGMBTilesLikePseudoDataset
 
     GDALGPKGMBTilesLikePseudoDataset *m_poParentDS = nullptr;
 
+    // Tile fetched by PrefetchTiles(). abyDecoded is empty if the tile has
+    // not been decoded in advance.
+    struct PrefetchedTile
+    {
+        std::string osData{};
+        std::vector<GByte> abyDecoded{};
+        bool bIsLossyFormat = false;
+    };
+
+    // Tiles fetched by PrefetchTiles(), indexed by (row, column) in
+    // top-left origin convention. Tiles of the prefetched window that are
+    // not in the map do not exist in the database.
+    std::map<std::pair<int, int>, PrefetchedTile> m_oMapPrefetchedTiles{};
+    int m_nPrefetchRowMin = 0;
+    int m_nPrefetchColMin = 0;
+    int m_nPrefetchRowMax = -1;
+    int m_nPrefetchColMax = -1;
+
   private:
     bool m_bInWriteTile = false;
+
+    // Tile encoded by a worker thread
+    struct EncodedTile;
+
+    // Tiles submitted to worker threads by WriteTileInternal(), in
+    // submission order. They are inserted into the database by
+    // WaitEncodedTiles(), in the calling thread.
+    std::unique_ptr<CPLJobQueue> m_poEncodeTileQueue{};
+    std::deque<std::unique_ptr<EncodedTile>> m_apoEncodedTiles{};
+    std::mutex m_oEncodedTilesMutex{};
+    std::condition_variable m_oEncodedTilesCV{};
+
+    static void EncodeTileJobFunc(void *pData);
+    CPLErr SubmitEncodeTile(int nRow, int nCol, int nThreads,
+                            GDALDriver *poDriver, GDALDataset *poMEMDS,
+                            CSLConstList papszDriverOptions);
+    CPLErr WaitEncodedTiles(size_t nMaxPendingTiles = 0);
+    CPLErr InsertTile(int nRow, int nCol, GByte *pabyBlob,
+                      vsi_l_offset nBlobSize);
+
     CPLErr WriteTileInternal(); /* should only be called by WriteTile() */
     GIntBig GetTileId(int nRow, int nCol);
     bool DeleteTile(int nRow, int nCol);
@@ -140,6 +189,12 @@ class GDALGPKGMBTilesLikePseudoDataset
 
     CPLErr WriteTile();
 
+    bool PrefetchTiles(int nRowMin, int nColMin, int nRowMax, int nColMax);
+    bool PrefetchTilesForRasterIO(int nXOff, int nYOff, int nXSize,
+                                  int nYSize);
+    void DecodePrefetchedTiles();
+    void ClearPrefetchedTiles();
+
     CPLErr FlushTiles();
     CPLErr FlushRemainingShiftedTiles(bool bPartialFlush);
     CPLErr WriteShiftedTile(int nRow, int nCol, int iBand, int nDstXOffset,
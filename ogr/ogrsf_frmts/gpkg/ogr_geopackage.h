@@ -94,6 +94,51 @@ struct GPKGContentsDesc
     CPLString osMaxY{};
 };
 
+// Vector layer as listed from gpkg_contents & gpkg_geometry_columns
+struct GPKGLayerDesc
+{
+    std::string osTableName{};
+    std::string osObjectType{};  // empty if the table/view does not exist
+    std::string osGeomColName{};
+    std::string osGeomType{};
+    int nZ = 0;
+    int nM = 0;
+    bool bIsSpatial = false;
+    bool bIsInGpkgContents = false;
+};
+
+// Content of the metadata tables of a GeoPackage, shared between all the
+// datasets opened in read-only mode on the same file with the
+// SHARED_METADATA=YES open option, so that opening a dataset per thread does
+// not require to read and parse it again.
+struct GPKGSharedMetadata
+{
+    std::mutex oMutex{};
+
+    // Used to detect that the file has been modified since the metadata has
+    // been read
+    GIntBig nFileSize = 0;
+    GIntBig nFileMTime = 0;
+    GIntBig nWALSize = 0;
+    GIntBig nWALMTime = 0;
+    int nSchemaVersion = 0;
+
+    // Indexed by the SQL request used to list the layers
+    std::map<std::string, std::vector<GPKGLayerDesc>> oMapLayerDescs{};
+    std::map<int, std::unique_ptr<OGRSpatialReference,
+                                  OGRSpatialReferenceReleaser>>
+        oMapSrsIdToSrs{};
+    bool bMapTableToExtensionsBuilt = false;
+    std::map<CPLString, std::vector<GPKGExtensionDesc>>
+        oMapTableToExtensions{};
+    bool bMapTableToContentsBuilt = false;
+    std::map<CPLString, GPKGContentsDesc> oMapTableToContents{};
+    bool bMapNameToTypeBuilt = false;
+    std::map<CPLString, CPLString> oMapNameToType{};
+    bool bSqliteMasterContentBuilt = false;
+    std::vector<SQLSqliteMasterContent> aoSqliteMasterContent{};
+};
+
 class OGRGeoPackageLayer;
 
 struct OGRGPKGTableLayerFillArrowArray
@@ -268,6 +313,9 @@ class GDALGeoPackageDataset final : public OGRSQLiteBaseDataSource,
 
     std::map<int, OGRSpatialReference *> m_oMapSrsIdToSrs{};
 
+    std::shared_ptr<GPKGSharedMetadata> m_poSharedMetadata{};
+    std::shared_ptr<GPKGSharedMetadata> GetSharedMetadata();
+
     OGRErr DeleteLayerCommon(const char *pszLayerName);
     OGRErr DeleteRasterLayer(const char *pszLayerName);
     bool DeleteVectorOrRasterLayer(const char *pszLayerName);
@@ -581,12 +629,16 @@ class OGRGeoPackageLayer CPL_NON_FINAL : public OGRLayer,
     int m_iGeomCol = -1;
     std::vector<int> m_anFieldOrdinals{};
 
+    // Whether TranslateFeature() defers the parsing of WKB geometries
+    bool m_bLazyGeometry = true;
+
     void ClearStatement();
     virtual OGRErr ResetStatement() = 0;
 
     void BuildFeatureDefn(const char *pszLayerName, sqlite3_stmt *hStmt);
 
     OGRFeature *TranslateFeature(sqlite3_stmt *hStmt);
+    bool FilterFeatureGeometry(OGRFeature *poFeature);
     bool ParseDateField(const char *pszTxt, OGRField *psField,
                         const OGRFieldDefn *poFieldDefn, GIntBig nFID);
     bool ParseDateField(sqlite3_stmt *hStmt, int iRawField, int nSqlite3ColType,
@@ -715,6 +767,20 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
     } GPKGRTreeEntry;
     std::vector<GPKGRTreeEntry> m_aoRTreeEntries{};
 
+    // Variables used to drop the spatial index when appending a large number
+    // of features to an existing table, and rebuild it in bulk afterwards
+    GIntBig m_nCountInsertWithSpatialIndex = 0;
+    GIntBig m_nSpatialIndexRebuildThreshold = -1;
+    bool m_bSpatialIndexDroppedInTransaction = false;
+
+    // Variables used to encode feature geometries on worker threads when
+    // inserting features in a transaction (OGR_GPKG_WRITE_NUM_THREADS)
+    int m_nWriteThreads = -1;
+    GIntBig m_nNextFIDInPipeline = -1;
+    std::vector<std::unique_ptr<OGRFeature>> m_apoPendingFeatures{};
+    GByte *m_pabyPrecomputedGeomBlob = nullptr;
+    size_t m_nPrecomputedGeomBlobSize = 0;
+
     // Variables used for background RTree building
     std::string m_osAsyncDBName{};
     std::string m_osAsyncDBAttachName{};
@@ -757,6 +823,7 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
 #endif
 
     void CheckGeometryType(const OGRFeature *poFeature);
+    void CheckGeometryType(OGRwkbGeometryType eGeomType);
 
     OGRErr ReadTableDefinition();
     void InitView();
@@ -765,6 +832,19 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
 
     bool StartDeferredSpatialIndexUpdate();
     bool FlushPendingSpatialIndexUpdate();
+    void DeferSpatialIndexRebuild();
+
+    struct GPKGEnvelopeJob;
+    static void ComputeEnvelopesJobFunc(void *pData);
+    static void SortRTreeEntriesSTR(std::vector<GPKGRTreeEntry> &asEntries,
+                                    size_t nNodeCapacity);
+    bool BulkLoadSpatialIndex(const char *pszT, const char *pszI,
+                              const char *pszC);
+
+    struct GPKGGeomBlobJob;
+    static void EncodeGeometriesJobFunc(void *pData);
+    bool CanUseWritePipeline();
+    void DiscardPendingFeatures();
     void WorkaroundUpdate1TriggerIssue();
     void RevertWorkaroundUpdate1TriggerIssue();
 
@@ -772,6 +852,9 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
                                         const char *pszNewName);
 
     OGRErr CreateOrUpsertFeature(OGRFeature *poFeature, bool bUpsert);
+    OGRErr UpdateExtentAndSpatialIndexOfInsertedFeature(GIntBig nFID,
+                                                        const OGREnvelope &oEnv,
+                                                        bool bUpsert);
 
     GIntBig GetTotalFeatureCount();
 
@@ -857,6 +940,9 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
                           const int *panUpdatedGeomFieldsIdx,
                           bool bUpdateStyleString) override;
     OGRErr DeleteFeature(GIntBig nFID) override;
+    bool WriteArrowBatch(const struct ArrowSchema *schema,
+                         struct ArrowArray *array,
+                         CSLConstList papszOptions = nullptr) override;
     virtual void SetSpatialFilter(OGRGeometry *) override;
     virtual void SetSpatialFilter(int iGeomField, OGRGeometry *poGeom) override
     {
@@ -913,6 +999,7 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
     bool FlushInMemoryRTree(sqlite3 *hRTreeDB, const char *pszRTreeName);
     bool CreateSpatialIndex(const char *pszTableName = nullptr);
     bool DropSpatialIndex(bool bCalledFromSQLFunction = false);
+    bool RebuildSpatialIndex();
     CPLString ReturnSQLCreateSpatialIndexTriggers(const char *pszTableName,
                                                   const char *pszGeomColName);
     CPLString ReturnSQLDropSpatialIndexTriggers();
@@ -946,6 +1033,7 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
     bool RunDeferredDropRTreeTableIfNecessary();
     bool DoJobAtTransactionCommit();
     bool DoJobAtTransactionRollback();
+    OGRErr FlushPendingFeatures();
     bool RunDeferredSpatialIndexUpdate();
 
 #ifdef ENABLE_GPKG_OGR_CONTENTS
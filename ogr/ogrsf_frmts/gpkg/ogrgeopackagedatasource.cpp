@@ -284,6 +284,21 @@ OGRSpatialReference *GDALGeoPackageDataset::GetSpatialRef(int iSrsId,
         return poSpatialRef;
     }
 
+    if (m_poSharedMetadata)
+    {
+        std::lock_guard<std::mutex> oLock(m_poSharedMetadata->oMutex);
+        const auto oSharedIter =
+            m_poSharedMetadata->oMapSrsIdToSrs.find(iSrsId);
+        if (oSharedIter != m_poSharedMetadata->oMapSrsIdToSrs.end())
+        {
+            // OGRSpatialReference is not thread-safe, hence the copy
+            OGRSpatialReference *poSpatialRef = oSharedIter->second->Clone();
+            m_oMapSrsIdToSrs[iSrsId] = poSpatialRef;
+            poSpatialRef->Reference();
+            return poSpatialRef;
+        }
+    }
+
     CPLString oSQL;
     oSQL.Printf("SELECT definition, organization, organization_coordsys_id%s%s "
                 "FROM gpkg_spatial_ref_sys WHERE "
@@ -332,10 +347,31 @@ OGRSpatialReference *GDALGeoPackageDataset::GetSpatialRef(int iSrsId,
     const double dfCoordinateEpoch =
         pszCoordinateEpoch ? CPLAtof(pszCoordinateEpoch) : 0.0;
 
-    OGRSpatialReference *poSpatialRef = new OGRSpatialReference();
-    poSpatialRef->SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+    // Reuse the SRS built from the same definition by another dataset (or
+    // this one with another srs_id), since importing it may be costly.
+    std::string osSRSCacheKey("GPKG:");
+    osSRSCacheKey += std::to_string(iSrsId);
+    osSRSCacheKey += '\n';
+    osSRSCacheKey += pszOrganization ? pszOrganization : "";
+    osSRSCacheKey += '\n';
+    osSRSCacheKey += pszOrganizationCoordsysID ? pszOrganizationCoordsysID : "";
+    osSRSCacheKey += '\n';
+    osSRSCacheKey += CPLSPrintf("%.17g", dfCoordinateEpoch);
+    osSRSCacheKey += '\n';
+    osSRSCacheKey += CPLGetConfigOption("OSR_STRIP_TOWGS84", "");
+    osSRSCacheKey += '\n';
+    osSRSCacheKey += pszWkt;
+
+    OGRSpatialReference *poSpatialRef =
+        OSRGetFromSharedCache(osSRSCacheKey).release();
+    const bool bFromCache = poSpatialRef != nullptr;
+    if (!bFromCache)
+    {
+        poSpatialRef = new OGRSpatialReference();
+        poSpatialRef->SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+    }
     // Try to import first from EPSG code, and then from WKT
-    if (!(pszOrganization && pszOrganizationCoordsysID &&
+    if (!bFromCache && !(pszOrganization && pszOrganizationCoordsysID &&
           EQUAL(pszOrganization, "EPSG") &&
           (atoi(pszOrganizationCoordsysID) == iSrsId ||
            (dfCoordinateEpoch > 0 && strstr(pszWkt, "DYNAMIC[") == nullptr)) &&
@@ -351,10 +387,21 @@ OGRSpatialReference *GDALGeoPackageDataset::GetSpatialRef(int iSrsId,
         return nullptr;
     }
 
-    poSpatialRef->StripTOWGS84IfKnownDatumAndAllowed();
-    poSpatialRef->SetCoordinateEpoch(dfCoordinateEpoch);
+    if (!bFromCache)
+    {
+        poSpatialRef->StripTOWGS84IfKnownDatumAndAllowed();
+        poSpatialRef->SetCoordinateEpoch(dfCoordinateEpoch);
+        OSRInsertIntoSharedCache(osSRSCacheKey, *poSpatialRef);
+    }
     m_oMapSrsIdToSrs[iSrsId] = poSpatialRef;
     poSpatialRef->Reference();
+    if (m_poSharedMetadata)
+    {
+        std::lock_guard<std::mutex> oLock(m_poSharedMetadata->oMutex);
+        auto &poSharedSRS = m_poSharedMetadata->oMapSrsIdToSrs[iSrsId];
+        if (!poSharedSRS)
+            poSharedSRS.reset(poSpatialRef->Clone());
+    }
     return poSpatialRef;
 }
 
@@ -1065,11 +1112,21 @@ CPLErr GDALGeoPackageDataset::IRasterIO(
     GSpacing nBandSpace, GDALRasterIOExtraArg *psExtraArg)
 
 {
+    // When reading at full resolution a window covering several tiles that
+    // are not yet in the block cache, fetch all of them with a single SQL
+    // query rather than one query per tile.
+    const bool bPrefetched =
+        eRWFlag == GF_Read && nBufXSize == nXSize && nBufYSize == nYSize &&
+        PrefetchTilesForRasterIO(nXOff, nYOff, nXSize, nYSize);
+
     CPLErr eErr = OGRSQLiteBaseDataSource::IRasterIO(
         eRWFlag, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize, nBufYSize,
         eBufType, nBandCount, panBandMap, nPixelSpace, nLineSpace, nBandSpace,
         psExtraArg);
 
+    if (bPrefetched)
+        ClearPrefetchedTiles();
+
     // If writing all bands, in non-shifted mode, flush all entirely written
     // tiles This can avoid "stressing" the block cache with too many dirty
     // blocks. Note: this logic would be useless with a per-dataset block cache.
@@ -1132,6 +1189,16 @@ GDALGeoPackageDataset::GetNameTypeMapFromSQliteMaster()
     if (!m_oMapNameToType.empty())
         return m_oMapNameToType;
 
+    if (m_poSharedMetadata)
+    {
+        std::lock_guard<std::mutex> oLock(m_poSharedMetadata->oMutex);
+        if (m_poSharedMetadata->bMapNameToTypeBuilt)
+        {
+            m_oMapNameToType = m_poSharedMetadata->oMapNameToType;
+            return m_oMapNameToType;
+        }
+    }
+
     CPLString osSQL(
         "SELECT name, type FROM sqlite_master WHERE "
         "type IN ('view', 'table') OR "
@@ -1154,6 +1221,13 @@ GDALGeoPackageDataset::GetNameTypeMapFromSQliteMaster()
         }
     }
 
+    if (m_poSharedMetadata)
+    {
+        std::lock_guard<std::mutex> oLock(m_poSharedMetadata->oMutex);
+        m_poSharedMetadata->bMapNameToTypeBuilt = true;
+        m_poSharedMetadata->oMapNameToType = m_oMapNameToType;
+    }
+
     return m_oMapNameToType;
 }
 
@@ -1178,6 +1252,17 @@ GDALGeoPackageDataset::GetUnknownExtensionsTableSpecific()
         return m_oMapTableToExtensions;
     m_bMapTableToExtensionsBuilt = true;
 
+    if (m_poSharedMetadata)
+    {
+        std::lock_guard<std::mutex> oLock(m_poSharedMetadata->oMutex);
+        if (m_poSharedMetadata->bMapTableToExtensionsBuilt)
+        {
+            m_oMapTableToExtensions =
+                m_poSharedMetadata->oMapTableToExtensions;
+            return m_oMapTableToExtensions;
+        }
+    }
+
     if (!HasExtensionsTable())
         return m_oMapTableToExtensions;
 
@@ -1229,6 +1314,13 @@ GDALGeoPackageDataset::GetUnknownExtensionsTableSpecific()
         }
     }
 
+    if (m_poSharedMetadata)
+    {
+        std::lock_guard<std::mutex> oLock(m_poSharedMetadata->oMutex);
+        m_poSharedMetadata->bMapTableToExtensionsBuilt = true;
+        m_poSharedMetadata->oMapTableToExtensions = m_oMapTableToExtensions;
+    }
+
     return m_oMapTableToExtensions;
 }
 
@@ -1243,6 +1335,16 @@ GDALGeoPackageDataset::GetContents()
         return m_oMapTableToContents;
     m_bMapTableToContentsBuilt = true;
 
+    if (m_poSharedMetadata)
+    {
+        std::lock_guard<std::mutex> oLock(m_poSharedMetadata->oMutex);
+        if (m_poSharedMetadata->bMapTableToContentsBuilt)
+        {
+            m_oMapTableToContents = m_poSharedMetadata->oMapTableToContents;
+            return m_oMapTableToContents;
+        }
+    }
+
     CPLString osSQL("SELECT table_name, data_type, identifier, "
                     "description, min_x, min_y, max_x, max_y "
                     "FROM gpkg_contents");
@@ -1288,9 +1390,65 @@ GDALGeoPackageDataset::GetContents()
         }
     }
 
+    if (m_poSharedMetadata)
+    {
+        std::lock_guard<std::mutex> oLock(m_poSharedMetadata->oMutex);
+        m_poSharedMetadata->bMapTableToContentsBuilt = true;
+        m_poSharedMetadata->oMapTableToContents = m_oMapTableToContents;
+    }
+
     return m_oMapTableToContents;
 }
 
+/************************************************************************/
+/*                         GetSharedMetadata()                          */
+/************************************************************************/
+
+// Return the metadata shared by the datasets opened in read-only mode on
+// the same file with SHARED_METADATA=YES, or a new empty one if the file
+// has been modified since the shared metadata was created.
+std::shared_ptr<GPKGSharedMetadata> GDALGeoPackageDataset::GetSharedMetadata()
+{
+    static std::mutex goMutex;
+    static std::map<std::string, std::weak_ptr<GPKGSharedMetadata>> goMap;
+
+    auto poNew = std::make_shared<GPKGSharedMetadata>();
+    VSIStatBufL sStat;
+    if (VSIStatL(m_pszFilename, &sStat) == 0)
+    {
+        poNew->nFileSize = static_cast<GIntBig>(sStat.st_size);
+        poNew->nFileMTime = static_cast<GIntBig>(sStat.st_mtime);
+    }
+    if (VSIStatL(CPLSPrintf("%s-wal", m_pszFilename), &sStat) == 0)
+    {
+        poNew->nWALSize = static_cast<GIntBig>(sStat.st_size);
+        poNew->nWALMTime = static_cast<GIntBig>(sStat.st_mtime);
+    }
+    poNew->nSchemaVersion =
+        SQLGetInteger(hDB, "PRAGMA schema_version", nullptr);
+
+    std::lock_guard<std::mutex> oLock(goMutex);
+    for (auto oIter = goMap.begin(); oIter != goMap.end();)
+    {
+        if (oIter->second.expired())
+            oIter = goMap.erase(oIter);
+        else
+            ++oIter;
+    }
+    auto &poWeak = goMap[m_pszFilename];
+    auto poExisting = poWeak.lock();
+    if (poExisting && poExisting->nFileSize == poNew->nFileSize &&
+        poExisting->nFileMTime == poNew->nFileMTime &&
+        poExisting->nWALSize == poNew->nWALSize &&
+        poExisting->nWALMTime == poNew->nWALMTime &&
+        poExisting->nSchemaVersion == poNew->nSchemaVersion)
+    {
+        return poExisting;
+    }
+    poWeak = poNew;
+    return poNew;
+}
+
 /************************************************************************/
 /*                                Open()                                */
 /************************************************************************/
@@ -1561,6 +1719,12 @@ int GDALGeoPackageDataset::Open(GDALOpenInfo *poOpenInfo,
     }
 #endif
 
+    if (!GetUpdate() &&
+        CPLFetchBool(poOpenInfo->papszOpenOptions, "SHARED_METADATA", false))
+    {
+        m_poSharedMetadata = GetSharedMetadata();
+    }
+
     CheckUnknownExtensions();
 
     int bRet = FALSE;
@@ -1637,35 +1801,81 @@ int GDALGeoPackageDataset::Open(GDALOpenInfo *poOpenInfo,
             osSQL += CPLSPrintf("%d", 1 + nTableLimit);
         }
 
-        auto oResult = SQLQuery(hDB, osSQL.c_str());
-        if (!oResult)
+        std::vector<GPKGLayerDesc> asLayerDescs;
+        bool bLayerDescsFromSharedMetadata = false;
+        if (m_poSharedMetadata)
         {
-            return FALSE;
+            std::lock_guard<std::mutex> oLock(m_poSharedMetadata->oMutex);
+            const auto oIter = m_poSharedMetadata->oMapLayerDescs.find(osSQL);
+            if (oIter != m_poSharedMetadata->oMapLayerDescs.end())
+            {
+                asLayerDescs = oIter->second;
+                bLayerDescsFromSharedMetadata = true;
+            }
         }
-
-        if (nTableLimit > 0 && oResult->RowCount() > nTableLimit)
+        if (!bLayerDescsFromSharedMetadata)
         {
-            CPLError(CE_Warning, CPLE_AppDefined,
-                     "File has more than %d vector tables. "
-                     "Limiting to first %d (can be overridden with "
-                     "OGR_TABLE_LIMIT config option)",
-                     nTableLimit, nTableLimit);
-            oResult->LimitRowCount(nTableLimit);
+            auto oResult = SQLQuery(hDB, osSQL.c_str());
+            if (!oResult)
+            {
+                return FALSE;
+            }
+
+            if (nTableLimit > 0 && oResult->RowCount() > nTableLimit)
+            {
+                CPLError(CE_Warning, CPLE_AppDefined,
+                         "File has more than %d vector tables. "
+                         "Limiting to first %d (can be overridden with "
+                         "OGR_TABLE_LIMIT config option)",
+                         nTableLimit, nTableLimit);
+                oResult->LimitRowCount(nTableLimit);
+            }
+
+            for (int i = 0; i < oResult->RowCount(); i++)
+            {
+                const char *pszTableName = oResult->GetValue(0, i);
+                if (pszTableName == nullptr)
+                    continue;
+                GPKGLayerDesc sDesc;
+                sDesc.osTableName = pszTableName;
+                sDesc.bIsSpatial =
+                    CPL_TO_BOOL(oResult->GetValueAsInteger(2, i));
+                const char *pszGeomColName = oResult->GetValue(3, i);
+                if (pszGeomColName)
+                    sDesc.osGeomColName = pszGeomColName;
+                const char *pszGeomType = oResult->GetValue(4, i);
+                if (pszGeomType)
+                    sDesc.osGeomType = pszGeomType;
+                const char *pszZ = oResult->GetValue(5, i);
+                sDesc.nZ = pszZ ? atoi(pszZ) : 0;
+                const char *pszM = oResult->GetValue(6, i);
+                sDesc.nM = pszM ? atoi(pszM) : 0;
+                sDesc.bIsInGpkgContents =
+                    CPL_TO_BOOL(oResult->GetValueAsInteger(11, i));
+                const char *pszObjectType = oResult->GetValue(12, i);
+                if (pszObjectType)
+                    sDesc.osObjectType = pszObjectType;
+                asLayerDescs.push_back(std::move(sDesc));
+            }
+
+            if (m_poSharedMetadata)
+            {
+                std::lock_guard<std::mutex> oLock(m_poSharedMetadata->oMutex);
+                m_poSharedMetadata->oMapLayerDescs[osSQL] = asLayerDescs;
+            }
         }
 
-        if (oResult->RowCount() > 0)
+        if (!asLayerDescs.empty())
         {
             bRet = TRUE;
 
             m_papoLayers = static_cast<OGRGeoPackageTableLayer **>(CPLMalloc(
-                sizeof(OGRGeoPackageTableLayer *) * oResult->RowCount()));
+                sizeof(OGRGeoPackageTableLayer *) * asLayerDescs.size()));
 
             std::map<std::string, int> oMapTableRefCount;
-            for (int i = 0; i < oResult->RowCount(); i++)
+            for (const auto &sDesc : asLayerDescs)
             {
-                const char *pszTableName = oResult->GetValue(0, i);
-                if (pszTableName == nullptr)
-                    continue;
+                const char *pszTableName = sDesc.osTableName.c_str();
                 if (++oMapTableRefCount[pszTableName] == 2)
                 {
                     // This should normally not happen if all constraints are
@@ -1678,25 +1888,21 @@ int GDALGeoPackageDataset::Open(GDALOpenInfo *poOpenInfo,
             }
 
             std::set<std::string> oExistingLayers;
-            for (int i = 0; i < oResult->RowCount(); i++)
+            for (const auto &sDesc : asLayerDescs)
             {
-                const char *pszTableName = oResult->GetValue(0, i);
-                if (pszTableName == nullptr)
-                    continue;
+                const char *pszTableName = sDesc.osTableName.c_str();
                 const bool bTableHasSeveralGeomColumns =
                     oMapTableRefCount[pszTableName] > 1;
-                bool bIsSpatial = CPL_TO_BOOL(oResult->GetValueAsInteger(2, i));
-                const char *pszGeomColName = oResult->GetValue(3, i);
-                const char *pszGeomType = oResult->GetValue(4, i);
-                const char *pszZ = oResult->GetValue(5, i);
-                const char *pszM = oResult->GetValue(6, i);
-                bool bIsInGpkgContents =
-                    CPL_TO_BOOL(oResult->GetValueAsInteger(11, i));
+                const bool bIsSpatial = sDesc.bIsSpatial;
+                const char *pszGeomColName =
+                    bIsSpatial ? sDesc.osGeomColName.c_str() : nullptr;
+                const char *pszGeomType =
+                    bIsSpatial ? sDesc.osGeomType.c_str() : nullptr;
+                const bool bIsInGpkgContents = sDesc.bIsInGpkgContents;
                 if (!bIsInGpkgContents)
                     m_bNonSpatialTablesNonRegisteredInGpkgContentsFound = true;
-                const char *pszObjectType = oResult->GetValue(12, i);
-                if (pszObjectType == nullptr ||
-                    !(EQUAL(pszObjectType, "table") ||
+                const char *pszObjectType = sDesc.osObjectType.c_str();
+                if (!(EQUAL(pszObjectType, "table") ||
                       EQUAL(pszObjectType, "view")))
                 {
                     CPLError(CE_Warning, CPLE_AppDefined,
@@ -1724,13 +1930,13 @@ int GDALGeoPackageDataset::Open(GDALOpenInfo *poOpenInfo,
                                                     : std::string(pszTableName);
                 OGRGeoPackageTableLayer *poLayer =
                     new OGRGeoPackageTableLayer(this, osLayerName.c_str());
-                bool bHasZ = pszZ && atoi(pszZ) > 0;
-                bool bHasM = pszM && atoi(pszM) > 0;
+                bool bHasZ = sDesc.nZ > 0;
+                bool bHasM = sDesc.nM > 0;
                 if (pszGeomType && EQUAL(pszGeomType, "GEOMETRY"))
                 {
-                    if (pszZ && atoi(pszZ) == 2)
+                    if (sDesc.nZ == 2)
                         bHasZ = false;
-                    if (pszM && atoi(pszM) == 2)
+                    if (sDesc.nM == 2)
                         bHasM = false;
                 }
                 poLayer->SetOpeningParameters(
@@ -7208,6 +7414,28 @@ OGRLayer *GDALGeoPackageDataset::ExecuteSQL(const char *pszSQLCommand,
         return nullptr;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Special case REBUILD SPATIAL INDEX ON command.                  */
+    /* -------------------------------------------------------------------- */
+    if (STARTS_WITH_CI(osSQLCommand, "REBUILD SPATIAL INDEX ON "))
+    {
+        const char *pszLayerName =
+            osSQLCommand.c_str() + strlen("REBUILD SPATIAL INDEX ON ");
+
+        while (*pszLayerName == ' ')
+            pszLayerName++;
+
+        int idx = FindLayerIndex(pszLayerName);
+        if (idx >= 0)
+        {
+            m_papoLayers[idx]->RebuildSpatialIndex();
+        }
+        else
+            CPLError(CE_Failure, CPLE_AppDefined, "Unknown layer: %s",
+                     pszLayerName);
+        return nullptr;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Intercept DROP TABLE                                            */
     /* -------------------------------------------------------------------- */
@@ -9077,6 +9305,17 @@ OGRErr GDALGeoPackageDataset::CommitTransaction()
 {
     if (nSoftTransactionLevel == 1)
     {
+        // Insert features queued by OGR_GPKG_WRITE_NUM_THREADS mode.
+        // On error, roll back so that the transaction remains all-or-nothing.
+        for (int i = 0; i < m_nLayers; i++)
+        {
+            if (m_papoLayers[i]->FlushPendingFeatures() != OGRERR_NONE)
+            {
+                RollbackTransaction();
+                return OGRERR_FAILURE;
+            }
+        }
+
         FlushMetadata();
         for (int i = 0; i < m_nLayers; i++)
         {
@@ -10156,6 +10395,12 @@ bool GDALGeoPackageDataset::UpdateRelationship(
 const std::vector<SQLSqliteMasterContent> &
 GDALGeoPackageDataset::GetSqliteMasterContent()
 {
+    if (m_aoSqliteMasterContent.empty() && m_poSharedMetadata)
+    {
+        std::lock_guard<std::mutex> oLock(m_poSharedMetadata->oMutex);
+        if (m_poSharedMetadata->bSqliteMasterContentBuilt)
+            m_aoSqliteMasterContent = m_poSharedMetadata->aoSqliteMasterContent;
+    }
     if (m_aoSqliteMasterContent.empty())
     {
         auto oResultTable =
@@ -10174,6 +10419,13 @@ GDALGeoPackageDataset::GetSqliteMasterContent()
                 m_aoSqliteMasterContent.emplace_back(std::move(row));
             }
         }
+        if (m_poSharedMetadata)
+        {
+            std::lock_guard<std::mutex> oLock(m_poSharedMetadata->oMutex);
+            m_poSharedMetadata->bSqliteMasterContentBuilt = true;
+            m_poSharedMetadata->aoSqliteMasterContent =
+                m_aoSqliteMasterContent;
+        }
     }
     return m_aoSqliteMasterContent;
 }
@@ -662,6 +662,10 @@ void RegisterOGRGeoPackage()
         "database should be opened in nolock mode'/>"
         "  <Option name='IMMUTABLE' type='boolean' description='Whether the "
         "database should be opened in immutable mode'/>"
+        "  <Option name='SHARED_METADATA' type='boolean' scope='vector' "
+        "description='Whether the content of metadata tables should be shared "
+        "with other datasets opened in read-only mode on the same file' "
+        "default='NO'/>"
         "</OpenOptionList>");
 
     poDriver->SetMetadataItem(
@@ -39,7 +39,8 @@
 /************************************************************************/
 
 OGRGeoPackageLayer::OGRGeoPackageLayer(GDALGeoPackageDataset *poDS)
-    : m_poDS(poDS)
+    : m_poDS(poDS), m_bLazyGeometry(CPLTestBool(
+                        CPLGetConfigOption("OGR_GPKG_LAZY_GEOMETRY", "YES")))
 {
 }
 
@@ -136,8 +137,7 @@ OGRFeature *OGRGeoPackageLayer::GetNextFeature()
 
         OGRFeature *poFeature = TranslateFeature(m_poQueryStatement);
 
-        if ((m_poFilterGeom == nullptr ||
-             FilterGeometry(poFeature->GetGeomFieldRef(m_iGeomFieldFilter))) &&
+        if ((m_poFilterGeom == nullptr || FilterFeatureGeometry(poFeature)) &&
             (m_poAttrQuery == nullptr || m_poAttrQuery->Evaluate(poFeature)))
             return poFeature;
 
@@ -145,6 +145,35 @@ OGRFeature *OGRGeoPackageLayer::GetNextFeature()
     }
 }
 
+/************************************************************************/
+/*                       FilterFeatureGeometry()                        */
+/************************************************************************/
+
+// Evaluate the spatial filter against the geometry of a feature returned
+// by TranslateFeature(), using its WKB when it has not been parsed yet.
+bool OGRGeoPackageLayer::FilterFeatureGeometry(OGRFeature *poFeature)
+{
+    size_t nWkbSize = 0;
+    const GByte *pabyWkb =
+        poFeature->GetGeomFieldLazyWkb(m_iGeomFieldFilter, nWkbSize);
+    OGRwkbGeometryType eType = wkbUnknown;
+    // The WKB envelope of curves is computed from their control points,
+    // and thus is not accurate enough. Geometry collections may contain
+    // curves.
+    if (pabyWkb != nullptr &&
+        OGRReadWKBGeometryType(pabyWkb, wkbVariantIso, &eType) ==
+            OGRERR_NONE &&
+        !OGR_GT_IsNonLinear(eType) &&
+        wkbFlatten(eType) != wkbGeometryCollection)
+    {
+        OGREnvelope sEnvelope;
+        return FilterWKBGeometry(pabyWkb, nWkbSize,
+                                 /* bEnvelopeAlreadySet = */ false, sEnvelope);
+    }
+    return CPL_TO_BOOL(
+        FilterGeometry(poFeature->GetGeomFieldRef(m_iGeomFieldFilter)));
+}
+
 /************************************************************************/
 /*                         ParseDateField()                             */
 /************************************************************************/
@@ -385,21 +414,36 @@ OGRFeature *OGRGeoPackageLayer::TranslateFeature(sqlite3_stmt *hStmt)
             // coverity[tainted_data_return]
             const GByte *pabyGpkg = static_cast<const GByte *>(
                 sqlite3_column_blob(hStmt, m_iGeomCol));
-            OGRGeometry *poGeom =
-                GPkgGeometryToOGR(pabyGpkg, iGpkgSize, nullptr);
-            if (poGeom == nullptr)
+            GPkgHeader oHeader;
+            if (m_bLazyGeometry && pabyGpkg != nullptr &&
+                GPkgHeaderFromWKB(pabyGpkg, iGpkgSize, &oHeader) ==
+                    OGRERR_NONE &&
+                static_cast<size_t>(iGpkgSize) > oHeader.nHeaderLen)
             {
-                // Try also spatialite geometry blobs
-                if (OGRSQLiteImportSpatiaLiteGeometry(pabyGpkg, iGpkgSize,
-                                                      &poGeom) != OGRERR_NONE)
+                // Defer the parsing of the WKB until the geometry is
+                // requested.
+                poFeature->SetGeomFieldLazyWkb(
+                    0, pabyGpkg + oHeader.nHeaderLen,
+                    iGpkgSize - oHeader.nHeaderLen);
+            }
+            else
+            {
+                OGRGeometry *poGeom =
+                    GPkgGeometryToOGR(pabyGpkg, iGpkgSize, nullptr);
+                if (poGeom == nullptr)
                 {
-                    CPLError(CE_Failure, CPLE_AppDefined,
-                             "Unable to read geometry");
+                    // Try also spatialite geometry blobs
+                    if (OGRSQLiteImportSpatiaLiteGeometry(
+                            pabyGpkg, iGpkgSize, &poGeom) != OGRERR_NONE)
+                    {
+                        CPLError(CE_Failure, CPLE_AppDefined,
+                                 "Unable to read geometry");
+                    }
                 }
+                if (poGeom != nullptr)
+                    poGeom->assignSpatialReference(poSrs);
+                poFeature->SetGeometryDirectly(poGeom);
             }
-            if (poGeom != nullptr)
-                poGeom->assignSpatialReference(poSrs);
-            poFeature->SetGeometryDirectly(poGeom);
         }
     }
 
@@ -528,7 +572,9 @@ bool OGRGeoPackageLayer::GetArrowStream(struct ArrowArrayStream *out_stream,
 int OGRGeoPackageLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
                                           struct ArrowArray *out_array)
 {
-    if (CPLTestBool(CPLGetConfigOption("OGR_GPKG_STREAM_BASE_IMPL", "NO")))
+    if (CPLTestBool(CPLGetConfigOption("OGR_GPKG_STREAM_BASE_IMPL", "NO")) ||
+        OGRArrowArrayHelper::HasGeoArrowGeometryField(
+            m_poFeatureDefn, m_aosArrowArrayStreamOptions))
     {
         return OGRLayer::GetNextArrowArray(stream, out_array);
     }
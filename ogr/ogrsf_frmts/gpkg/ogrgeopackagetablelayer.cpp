@@ -33,6 +33,9 @@
 #include "cpl_md5.h"
 #include "cpl_time.h"
 #include "ogr_p.h"
+#include "ogr_wkb.h"
+#include "ogrlayerarrow.h"
+#include "gdal_thread_pool.h"
 #include "sqlite_rtree_bulk_load/wrapper.h"
 
 #include <algorithm>
@@ -248,7 +251,18 @@ OGRErr OGRGeoPackageTableLayer::FeatureBindParameters(
         if (poGeom)
         {
             size_t szWkb = 0;
-            GByte *pabyWkb = GPkgGeometryFromOGR(poGeom, m_iSrs, &szWkb);
+            GByte *pabyWkb = nullptr;
+            if (m_pabyPrecomputedGeomBlob)
+            {
+                // Blob encoded by a worker thread in FlushPendingFeatures()
+                pabyWkb = m_pabyPrecomputedGeomBlob;
+                szWkb = m_nPrecomputedGeomBlobSize;
+                m_pabyPrecomputedGeomBlob = nullptr;
+            }
+            else
+            {
+                pabyWkb = GPkgGeometryFromOGR(poGeom, m_iSrs, &szWkb);
+            }
             if (!pabyWkb)
                 return OGRERR_FAILURE;
             int err = sqlite3_bind_blob(poStmt, nColCount++, pabyWkb,
@@ -1664,6 +1678,8 @@ OGRErr OGRGeoPackageTableLayer::CreateField(const OGRFieldDefn *poField,
         GetLayerDefn();
     if (!CheckUpdatableTable("CreateField"))
         return OGRERR_FAILURE;
+    if (FlushPendingFeatures() != OGRERR_NONE)
+        return OGRERR_FAILURE;
 
     OGRFieldDefn oFieldDefn(poField);
     int nMaxWidth = 0;
@@ -2043,34 +2059,36 @@ void OGRGeoPackageTableLayer::DisableFeatureCountTriggers(
  * reflect the dimensionality of feature geometries.
  */
 void OGRGeoPackageTableLayer::CheckGeometryType(const OGRFeature *poFeature)
+{
+    const OGRGeometry *poGeom = poFeature->GetGeometryRef();
+    if (poGeom != nullptr)
+        CheckGeometryType(poGeom->getGeometryType());
+}
+
+void OGRGeoPackageTableLayer::CheckGeometryType(OGRwkbGeometryType eGeomType)
 {
     const OGRwkbGeometryType eLayerGeomType = GetGeomType();
     const OGRwkbGeometryType eFlattenLayerGeomType = wkbFlatten(eLayerGeomType);
-    const OGRGeometry *poGeom = poFeature->GetGeometryRef();
     if (eFlattenLayerGeomType != wkbNone && eFlattenLayerGeomType != wkbUnknown)
     {
-        if (poGeom != nullptr)
+        const OGRwkbGeometryType eFlattenGeomType = wkbFlatten(eGeomType);
+        if (!OGR_GT_IsSubClassOf(eFlattenGeomType, eFlattenLayerGeomType) &&
+            m_eSetBadGeomTypeWarned.find(eFlattenGeomType) ==
+                m_eSetBadGeomTypeWarned.end())
         {
-            OGRwkbGeometryType eGeomType =
-                wkbFlatten(poGeom->getGeometryType());
-            if (!OGR_GT_IsSubClassOf(eGeomType, eFlattenLayerGeomType) &&
-                m_eSetBadGeomTypeWarned.find(eGeomType) ==
-                    m_eSetBadGeomTypeWarned.end())
-            {
-                CPLError(CE_Warning, CPLE_AppDefined,
-                         "A geometry of type %s is inserted into layer %s "
-                         "of geometry type %s, which is not normally allowed "
-                         "by the GeoPackage specification, but the driver will "
-                         "however do it. "
-                         "To create a conformant GeoPackage, if using ogr2ogr, "
-                         "the -nlt option can be used to override the layer "
-                         "geometry type. "
-                         "This warning will no longer be emitted for this "
-                         "combination of layer and feature geometry type.",
-                         OGRToOGCGeomType(eGeomType), GetName(),
-                         OGRToOGCGeomType(eFlattenLayerGeomType));
-                m_eSetBadGeomTypeWarned.insert(eGeomType);
-            }
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "A geometry of type %s is inserted into layer %s "
+                     "of geometry type %s, which is not normally allowed "
+                     "by the GeoPackage specification, but the driver will "
+                     "however do it. "
+                     "To create a conformant GeoPackage, if using ogr2ogr, "
+                     "the -nlt option can be used to override the layer "
+                     "geometry type. "
+                     "This warning will no longer be emitted for this "
+                     "combination of layer and feature geometry type.",
+                     OGRToOGCGeomType(eFlattenGeomType), GetName(),
+                     OGRToOGCGeomType(eFlattenLayerGeomType));
+            m_eSetBadGeomTypeWarned.insert(eFlattenGeomType);
         }
     }
 
@@ -2078,50 +2096,46 @@ void OGRGeoPackageTableLayer::CheckGeometryType(const OGRFeature *poFeature)
     // if we have geometries with Z and M components
     if (m_nZFlag == 0 || m_nMFlag == 0)
     {
-        if (poGeom != nullptr)
+        bool bUpdateGpkgGeometryColumnsTable = false;
+        if (m_nZFlag == 0 && wkbHasZ(eGeomType))
         {
-            bool bUpdateGpkgGeometryColumnsTable = false;
-            const OGRwkbGeometryType eGeomType = poGeom->getGeometryType();
-            if (m_nZFlag == 0 && wkbHasZ(eGeomType))
-            {
-                if (eLayerGeomType != wkbUnknown && !wkbHasZ(eLayerGeomType))
-                {
-                    CPLError(
-                        CE_Warning, CPLE_AppDefined,
-                        "Layer '%s' has been declared with non-Z geometry type "
-                        "%s, but it does contain geometries with Z. Setting "
-                        "the Z=2 hint into gpkg_geometry_columns",
-                        GetName(),
-                        OGRToOGCGeomType(eLayerGeomType, true, true, true));
-                }
-                m_nZFlag = 2;
-                bUpdateGpkgGeometryColumnsTable = true;
-            }
-            if (m_nMFlag == 0 && wkbHasM(eGeomType))
+            if (eLayerGeomType != wkbUnknown && !wkbHasZ(eLayerGeomType))
             {
-                if (eLayerGeomType != wkbUnknown && !wkbHasM(eLayerGeomType))
-                {
-                    CPLError(
-                        CE_Warning, CPLE_AppDefined,
-                        "Layer '%s' has been declared with non-M geometry type "
-                        "%s, but it does contain geometries with M. Setting "
-                        "the M=2 hint into gpkg_geometry_columns",
-                        GetName(),
-                        OGRToOGCGeomType(eLayerGeomType, true, true, true));
-                }
-                m_nMFlag = 2;
-                bUpdateGpkgGeometryColumnsTable = true;
+                CPLError(
+                    CE_Warning, CPLE_AppDefined,
+                    "Layer '%s' has been declared with non-Z geometry type "
+                    "%s, but it does contain geometries with Z. Setting "
+                    "the Z=2 hint into gpkg_geometry_columns",
+                    GetName(),
+                    OGRToOGCGeomType(eLayerGeomType, true, true, true));
             }
-            if (bUpdateGpkgGeometryColumnsTable)
+            m_nZFlag = 2;
+            bUpdateGpkgGeometryColumnsTable = true;
+        }
+        if (m_nMFlag == 0 && wkbHasM(eGeomType))
+        {
+            if (eLayerGeomType != wkbUnknown && !wkbHasM(eLayerGeomType))
             {
-                /* Update gpkg_geometry_columns */
-                char *pszSQL = sqlite3_mprintf(
-                    "UPDATE gpkg_geometry_columns SET z = %d, m = %d WHERE "
-                    "table_name = '%q' AND column_name = '%q'",
-                    m_nZFlag, m_nMFlag, GetName(), GetGeometryColumn());
-                CPL_IGNORE_RET_VAL(SQLCommand(m_poDS->GetDB(), pszSQL));
-                sqlite3_free(pszSQL);
+                CPLError(
+                    CE_Warning, CPLE_AppDefined,
+                    "Layer '%s' has been declared with non-M geometry type "
+                    "%s, but it does contain geometries with M. Setting "
+                    "the M=2 hint into gpkg_geometry_columns",
+                    GetName(),
+                    OGRToOGCGeomType(eLayerGeomType, true, true, true));
             }
+            m_nMFlag = 2;
+            bUpdateGpkgGeometryColumnsTable = true;
+        }
+        if (bUpdateGpkgGeometryColumnsTable)
+        {
+            /* Update gpkg_geometry_columns */
+            char *pszSQL = sqlite3_mprintf(
+                "UPDATE gpkg_geometry_columns SET z = %d, m = %d WHERE "
+                "table_name = '%q' AND column_name = '%q'",
+                m_nZFlag, m_nMFlag, GetName(), GetGeometryColumn());
+            CPL_IGNORE_RET_VAL(SQLCommand(m_poDS->GetDB(), pszSQL));
+            sqlite3_free(pszSQL);
         }
     }
 }
@@ -2465,98 +2479,788 @@ OGRErr OGRGeoPackageTableLayer::CreateOrUpsertFeature(OGRFeature *poFeature,
         {
             OGREnvelope oEnv;
             poGeom->getEnvelope(&oEnv);
-            UpdateExtent(&oEnv);
+            if (UpdateExtentAndSpatialIndexOfInsertedFeature(
+                    nFID, oEnv, bUpsert) != OGRERR_NONE)
+                return OGRERR_FAILURE;
+        }
+    }
 
-            if (!bUpsert && !m_bDeferredSpatialIndexCreation &&
-                HasSpatialIndex() && m_poDS->IsInTransaction())
+#ifdef ENABLE_GPKG_OGR_CONTENTS
+    if (m_nTotalFeatureCount >= 0)
+        m_nTotalFeatureCount++;
+#endif
+
+    m_bContentChanged = true;
+
+    /* All done! */
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*            UpdateExtentAndSpatialIndexOfInsertedFeature()            */
+/************************************************************************/
+
+// Update the layer extent, and the spatial index (or the structures used to
+// build it later), with the envelope of the non-empty geometry of a feature
+// that has just been inserted (or upserted).
+OGRErr OGRGeoPackageTableLayer::UpdateExtentAndSpatialIndexOfInsertedFeature(
+    GIntBig nFID, const OGREnvelope &oEnv, bool bUpsert)
+{
+    UpdateExtent(&oEnv);
+
+    if (!bUpsert && !m_bDeferredSpatialIndexCreation && HasSpatialIndex())
+    {
+        m_nCountInsertWithSpatialIndex++;
+        if (m_nSpatialIndexRebuildThreshold < 0)
+        {
+            // By default, rebuild the spatial index once as many features
+            // have been appended as there were initially, since bulk loading
+            // is much faster than incremental insertion in the RTree.
+            const char *pszThreshold = CPLGetConfigOption(
+                "OGR_GPKG_SPATIAL_INDEX_REBUILD_THRESHOLD", nullptr);
+            m_nSpatialIndexRebuildThreshold =
+                pszThreshold
+                    ? std::max<GIntBig>(0, CPLAtoGIntBig(pszThreshold))
+                    : std::max<GIntBig>(100 * 1000, GetTotalFeatureCount());
+        }
+        if (m_nSpatialIndexRebuildThreshold > 0 &&
+            m_nCountInsertWithSpatialIndex == m_nSpatialIndexRebuildThreshold)
+        {
+            DeferSpatialIndexRebuild();
+        }
+    }
+
+    if (!bUpsert && !m_bDeferredSpatialIndexCreation && HasSpatialIndex() &&
+        m_poDS->IsInTransaction())
+    {
+        m_nCountInsertInTransaction++;
+        if (m_nCountInsertInTransactionThreshold < 0)
+        {
+            m_nCountInsertInTransactionThreshold = atoi(CPLGetConfigOption(
+                "OGR_GPKG_DEFERRED_SPI_UPDATE_THRESHOLD", "100"));
+        }
+        if (m_nCountInsertInTransaction == m_nCountInsertInTransactionThreshold)
+        {
+            StartDeferredSpatialIndexUpdate();
+        }
+        else if (!m_aoRTreeTriggersSQL.empty())
+        {
+            if (m_aoRTreeEntries.size() == 1000 * 1000)
             {
-                m_nCountInsertInTransaction++;
-                if (m_nCountInsertInTransactionThreshold < 0)
-                {
-                    m_nCountInsertInTransactionThreshold =
-                        atoi(CPLGetConfigOption(
-                            "OGR_GPKG_DEFERRED_SPI_UPDATE_THRESHOLD", "100"));
-                }
-                if (m_nCountInsertInTransaction ==
-                    m_nCountInsertInTransactionThreshold)
-                {
-                    StartDeferredSpatialIndexUpdate();
-                }
-                else if (!m_aoRTreeTriggersSQL.empty())
+                if (!FlushPendingSpatialIndexUpdate())
+                    return OGRERR_FAILURE;
+            }
+            GPKGRTreeEntry sEntry;
+            sEntry.nId = nFID;
+            sEntry.fMinX = rtreeValueDown(oEnv.MinX);
+            sEntry.fMaxX = rtreeValueUp(oEnv.MaxX);
+            sEntry.fMinY = rtreeValueDown(oEnv.MinY);
+            sEntry.fMaxY = rtreeValueUp(oEnv.MaxY);
+            m_aoRTreeEntries.push_back(sEntry);
+        }
+    }
+    else if (!bUpsert && m_bAllowedRTreeThread && !m_bErrorDuringRTreeThread)
+    {
+        GPKGRTreeEntry sEntry;
+#ifdef DEBUG_VERBOSE
+        if (m_aoRTreeEntries.empty())
+            CPLDebug("GPKG",
+                     "Starting to fill m_aoRTreeEntries at "
+                     "FID " CPL_FRMT_GIB,
+                     nFID);
+#endif
+        sEntry.nId = nFID;
+        sEntry.fMinX = rtreeValueDown(oEnv.MinX);
+        sEntry.fMaxX = rtreeValueUp(oEnv.MaxX);
+        sEntry.fMinY = rtreeValueDown(oEnv.MinY);
+        sEntry.fMaxY = rtreeValueUp(oEnv.MaxY);
+        try
+        {
+            m_aoRTreeEntries.push_back(sEntry);
+            if (m_aoRTreeEntries.size() == m_nRTreeBatchSize)
+            {
+                m_oQueueRTreeEntries.push(std::move(m_aoRTreeEntries));
+                m_aoRTreeEntries = std::vector<GPKGRTreeEntry>();
+            }
+            if (!m_bThreadRTreeStarted &&
+                m_oQueueRTreeEntries.size() == m_nRTreeBatchesBeforeStart)
+            {
+                StartAsyncRTree();
+            }
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLDebug("GPKG",
+                     "Memory allocation error regarding RTree "
+                     "structures. Falling back to slower method");
+            if (m_bThreadRTreeStarted)
+                CancelAsyncRTree();
+            else
+                m_bAllowedRTreeThread = false;
+        }
+    }
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                         CanUseWritePipeline()                        */
+/************************************************************************/
+
+// Whether ICreateFeature() can queue the feature so that its geometry is
+// encoded by a worker thread (cf OGR_GPKG_WRITE_NUM_THREADS).
+// This is restricted to insertions in a transaction, so that errors, which
+// are reported when the queue is flushed, at the latest at commit time, can
+// be dealt with by rolling back.
+bool OGRGeoPackageTableLayer::CanUseWritePipeline()
+{
+    if (m_nWriteThreads < 0)
+    {
+        const char *pszNumThreads =
+            CPLGetConfigOption("OGR_GPKG_WRITE_NUM_THREADS", "1");
+        m_nWriteThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                              ? CPLGetNumCPUs()
+                              : std::max(1, atoi(pszNumThreads));
+    }
+    return m_nWriteThreads > 1 && m_poDS->GetUpdate() &&
+           m_poDS->IsInTransaction() && m_pszFidColumn != nullptr &&
+           m_iFIDAsRegularColumnIndex < 0 &&
+           m_poFeatureDefn->GetGeomFieldCount() > 0;
+}
+
+/************************************************************************/
+/*                           ICreateFeature()                           */
+/************************************************************************/
+
+OGRErr OGRGeoPackageTableLayer::ICreateFeature(OGRFeature *poFeature)
+{
+    if (!m_bFeatureDefnCompleted)
+        GetLayerDefn();
+    if (!CanUseWritePipeline())
+    {
+        if (FlushPendingFeatures() != OGRERR_NONE)
+            return OGRERR_FAILURE;
+        return CreateOrUpsertFeature(poFeature, /* bUpsert=*/false);
+    }
+
+    if (m_bDeferredCreation && RunDeferredCreationIfNecessary() != OGRERR_NONE)
+        return OGRERR_FAILURE;
+
+    // The feature is inserted later, so its FID must be predicted, in the
+    // same way as SQLite does for a AUTOINCREMENT primary key, that is
+    // max(largest value ever used, largest current value) + 1.
+    if (m_nNextFIDInPipeline < 0)
+    {
+        char *pszSQL =
+            sqlite3_mprintf("SELECT MAX(\"%w\") FROM \"%w\"",
+                            m_pszFidColumn, m_pszTableName);
+        OGRErr err = OGRERR_NONE;
+        const GIntBig nMaxFID = SQLGetInteger64(m_poDS->GetDB(), pszSQL, &err);
+        sqlite3_free(pszSQL);
+        if (err != OGRERR_NONE)
+            return OGRERR_FAILURE;
+        GIntBig nSeq = 0;
+        if (SQLGetInteger(m_poDS->GetDB(),
+                          "SELECT 1 FROM sqlite_master WHERE "
+                          "name = 'sqlite_sequence' AND type = 'table'",
+                          nullptr) == 1)
+        {
+            pszSQL = sqlite3_mprintf(
+                "SELECT seq FROM sqlite_sequence WHERE name = '%q'",
+                m_pszTableName);
+            nSeq = SQLGetInteger64(m_poDS->GetDB(), pszSQL, nullptr);
+            sqlite3_free(pszSQL);
+        }
+        m_nNextFIDInPipeline = std::max(nMaxFID, nSeq) + 1;
+    }
+
+    poFeature->FillUnsetWithDefault(FALSE, nullptr);
+    if (poFeature->GetFID() == OGRNullFID)
+        poFeature->SetFID(m_nNextFIDInPipeline++);
+    else
+        m_nNextFIDInPipeline =
+            std::max(m_nNextFIDInPipeline, poFeature->GetFID() + 1);
+
+    auto poClone = std::unique_ptr<OGRFeature>(poFeature->Clone());
+    if (!poClone)
+        return OGRERR_FAILURE;
+    m_apoPendingFeatures.push_back(std::move(poClone));
+
+    constexpr size_t PENDING_FEATURES_BATCH_SIZE = 10 * 1000;
+    if (m_apoPendingFeatures.size() == PENDING_FEATURES_BATCH_SIZE)
+        return FlushPendingFeatures();
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                           GPKGGeomBlobJob                            */
+/************************************************************************/
+
+// Range of pending features whose geometry is encoded by a worker thread
+struct OGRGeoPackageTableLayer::GPKGGeomBlobJob
+{
+    const std::vector<std::unique_ptr<OGRFeature>> *papoFeatures = nullptr;
+    size_t nStart = 0;
+    size_t nEnd = 0;
+    int iSrsId = 0;
+    std::vector<std::pair<GByte *, size_t>> aoBlobs{};
+    std::mutex *poMutex = nullptr;
+    std::condition_variable *poCV = nullptr;
+    bool bDone = false;
+};
+
+/************************************************************************/
+/*                       EncodeGeometriesJobFunc()                      */
+/************************************************************************/
+
+void OGRGeoPackageTableLayer::EncodeGeometriesJobFunc(void *pData)
+{
+    auto psJob = static_cast<GPKGGeomBlobJob *>(pData);
+    {
+        // A failed encoding leaves a null blob, and is retried, and reported,
+        // by the calling thread.
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        psJob->aoBlobs.resize(psJob->nEnd - psJob->nStart,
+                              std::pair<GByte *, size_t>(nullptr, 0));
+        for (size_t i = psJob->nStart; i < psJob->nEnd; ++i)
+        {
+            const OGRGeometry *poGeom =
+                (*psJob->papoFeatures)[i]->GetGeomFieldRef(0);
+            if (poGeom)
+            {
+                auto &oBlob = psJob->aoBlobs[i - psJob->nStart];
+                oBlob.first =
+                    GPkgGeometryFromOGR(poGeom, psJob->iSrsId, &oBlob.second);
+            }
+        }
+    }
+    std::lock_guard<std::mutex> oLock(*psJob->poMutex);
+    psJob->bDone = true;
+    psJob->poCV->notify_all();
+}
+
+/************************************************************************/
+/*                        FlushPendingFeatures()                        */
+/************************************************************************/
+
+// Insert the features queued by ICreateFeature(). Geometries are encoded by
+// worker threads, while the calling thread inserts the features whose
+// geometry is ready, in order.
+OGRErr OGRGeoPackageTableLayer::FlushPendingFeatures()
+{
+    if (m_apoPendingFeatures.empty())
+        return OGRERR_NONE;
+
+    auto apoFeatures = std::move(m_apoPendingFeatures);
+    m_apoPendingFeatures.clear();
+    // Re-evaluated from the database content at the next queued insertion
+    m_nNextFIDInPipeline = -1;
+
+    constexpr size_t FEATURES_PER_JOB = 256;
+    const size_t nFeatures = apoFeatures.size();
+    std::mutex oMutex;
+    std::condition_variable oCV;
+    std::vector<GPKGGeomBlobJob> asJobs((nFeatures + FEATURES_PER_JOB - 1) /
+                                        FEATURES_PER_JOB);
+    CPLWorkerThreadPool *poThreadPool =
+        m_nWriteThreads > 1 ? GDALGetGlobalThreadPool(m_nWriteThreads)
+                            : nullptr;
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if (poThreadPool)
+        poJobQueue = poThreadPool->CreateJobQueue();
+    for (size_t i = 0; i < asJobs.size(); ++i)
+    {
+        auto &sJob = asJobs[i];
+        sJob.papoFeatures = &apoFeatures;
+        sJob.nStart = i * FEATURES_PER_JOB;
+        sJob.nEnd = std::min(nFeatures, sJob.nStart + FEATURES_PER_JOB);
+        sJob.iSrsId = m_iSrs;
+        sJob.poMutex = &oMutex;
+        sJob.poCV = &oCV;
+        if (!poJobQueue ||
+            !poJobQueue->SubmitJob(EncodeGeometriesJobFunc, &sJob))
+        {
+            // The geometries will be encoded by FeatureBindParameters()
+            std::lock_guard<std::mutex> oLock(oMutex);
+            sJob.bDone = true;
+        }
+    }
+
+    OGRErr eErr = OGRERR_NONE;
+    for (auto &sJob : asJobs)
+    {
+        {
+            std::unique_lock<std::mutex> oLock(oMutex);
+            oCV.wait(oLock, [&sJob] { return sJob.bDone; });
+        }
+        for (size_t i = sJob.nStart; eErr == OGRERR_NONE && i < sJob.nEnd; ++i)
+        {
+            if (!sJob.aoBlobs.empty())
+            {
+                auto &oBlob = sJob.aoBlobs[i - sJob.nStart];
+                m_pabyPrecomputedGeomBlob = oBlob.first;
+                m_nPrecomputedGeomBlobSize = oBlob.second;
+                oBlob.first = nullptr;
+            }
+            eErr = CreateOrUpsertFeature(apoFeatures[i].get(),
+                                         /* bUpsert=*/false);
+            CPLFree(m_pabyPrecomputedGeomBlob);
+            m_pabyPrecomputedGeomBlob = nullptr;
+        }
+        if (eErr != OGRERR_NONE)
+            break;
+    }
+
+    if (poJobQueue)
+        poJobQueue->WaitCompletion();
+    for (auto &sJob : asJobs)
+    {
+        for (auto &oBlob : sJob.aoBlobs)
+            CPLFree(oBlob.first);
+    }
+    return eErr;
+}
+
+/************************************************************************/
+/*                       DiscardPendingFeatures()                       */
+/************************************************************************/
+
+void OGRGeoPackageTableLayer::DiscardPendingFeatures()
+{
+    m_apoPendingFeatures.clear();
+    m_nNextFIDInPipeline = -1;
+}
+
+/************************************************************************/
+/*                     AppendGeometryBlobFromWKB()                      */
+/************************************************************************/
+
+// Append to abyBlobs the GeoPackage geometry blob corresponding to a ISO WKB
+// geometry, by directly prepending the GeoPackage header to it when possible.
+// psEnvelope is set to the 2D envelope of the geometry, or left uninitialized
+// if it is empty.
+static bool AppendGeometryBlobFromWKB(const GByte *pabyWKB, size_t nWKBSize,
+                                      int iSrsId, std::vector<GByte> &abyBlobs,
+                                      OGRwkbGeometryType &eGeomType,
+                                      OGREnvelope &sEnvelope)
+{
+    // Only linear geometries, whose encoding doesn't require registering
+    // a geometry extension, are handled
+    OGREnvelope3D sEnvelope3D;
+    if (nWKBSize < 5 || pabyWKB[0] != static_cast<GByte>(wkbNDR) ||
+        OGRReadWKBGeometryType(pabyWKB, wkbVariantIso, &eGeomType) !=
+            OGRERR_NONE ||
+        wkbFlatten(eGeomType) < wkbPoint ||
+        wkbFlatten(eGeomType) > wkbMultiPolygon ||
+        !OGRWKBGetBoundingBox(pabyWKB, nWKBSize, sEnvelope3D) ||
+        std::isnan(sEnvelope3D.MinX) || std::isnan(sEnvelope3D.MinY) ||
+        std::isnan(sEnvelope3D.MaxX) || std::isnan(sEnvelope3D.MaxY))
+    {
+        return false;
+    }
+
+    const bool bEmpty = !sEnvelope3D.IsInit();
+    const bool bPoint = wkbFlatten(eGeomType) == wkbPoint;
+    const int nEnvelopeDims =
+        (bEmpty || bPoint) ? 0 : (wkbHasZ(eGeomType) ? 3 : 2);
+    const size_t nHeaderLen = 8 + 2 * sizeof(double) * nEnvelopeDims;
+    if (nWKBSize > static_cast<size_t>(std::numeric_limits<int>::max()) -
+                       nHeaderLen)
+    {
+        return false;
+    }
+
+    const size_t nOffset = abyBlobs.size();
+    abyBlobs.resize(nOffset + nHeaderLen + nWKBSize);
+    GByte *pabyBlob = abyBlobs.data() + nOffset;
+    pabyBlob[0] = 0x47;  // 'G'
+    pabyBlob[1] = 0x50;  // 'P'
+    pabyBlob[2] = 0;     // version
+    // Flags: empty geometry, envelope type, native byte order for the header
+    pabyBlob[3] = static_cast<GByte>((bEmpty ? (1 << 4) : 0) |
+                                     ((nEnvelopeDims == 3   ? 2
+                                       : nEnvelopeDims == 2 ? 1
+                                                            : 0)
+                                      << 1) |
+                                     CPL_IS_LSB);
+    memcpy(pabyBlob + 4, &iSrsId, 4);
+    if (nEnvelopeDims > 0)
+    {
+        const double adfEnvelope[] = {sEnvelope3D.MinX, sEnvelope3D.MaxX,
+                                      sEnvelope3D.MinY, sEnvelope3D.MaxY,
+                                      sEnvelope3D.MinZ, sEnvelope3D.MaxZ};
+        memcpy(pabyBlob + 8, adfEnvelope, 2 * sizeof(double) * nEnvelopeDims);
+    }
+    memcpy(pabyBlob + nHeaderLen, pabyWKB, nWKBSize);
+
+    sEnvelope = OGREnvelope();
+    if (!bEmpty)
+    {
+        sEnvelope.MinX = sEnvelope3D.MinX;
+        sEnvelope.MinY = sEnvelope3D.MinY;
+        sEnvelope.MaxX = sEnvelope3D.MaxX;
+        sEnvelope.MaxY = sEnvelope3D.MaxY;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                          WriteArrowBatch()                           */
+/************************************************************************/
+
+// Batches made only of columns of simple types (cf
+// OGRLayer::GetArrowBatchSimpleColumns()) are written by binding the Arrow
+// buffers directly to a prepared INSERT statement, after having converted
+// all their WKB geometries to GeoPackage blobs. Other batches are handled by
+// the generic implementation, which goes through OGRFeature.
+bool OGRGeoPackageTableLayer::WriteArrowBatch(const struct ArrowSchema *schema,
+                                              struct ArrowArray *array,
+                                              CSLConstList papszOptions)
+{
+    if (!m_bFeatureDefnCompleted)
+        GetLayerDefn();
+
+    std::vector<OGRArrowSimpleColumn> asColumns;
+    bool bNative =
+        m_poDS->GetUpdate() && m_pszFidColumn != nullptr &&
+        m_iFIDAsRegularColumnIndex < 0 &&
+        GetArrowBatchSimpleColumns(schema, array, papszOptions, asColumns);
+    const int nFieldCount = m_poFeatureDefn->GetFieldCount();
+    std::vector<bool> abFieldInBatch(nFieldCount, false);
+    for (const auto &sColumn : asColumns)
+    {
+        if (sColumn.iOGRFieldIdx >= 0)
+        {
+            // Generated columns can't be inserted, and string values of
+            // fields with a width may need validation or truncation
+            const auto poFieldDefn =
+                m_poFeatureDefn->GetFieldDefnUnsafe(sColumn.iOGRFieldIdx);
+            if (m_abGeneratedColumns[sColumn.iOGRFieldIdx] ||
+                (poFieldDefn->GetType() == OFTString &&
+                 poFieldDefn->GetWidth() > 0))
+            {
+                bNative = false;
+            }
+            abFieldInBatch[sColumn.iOGRFieldIdx] = true;
+        }
+    }
+    // Fields that are not in the batch must get their default value as
+    // computed by OGRFeature::FillUnsetWithDefault()
+    for (int i = 0; bNative && i < nFieldCount; ++i)
+    {
+        if (!abFieldInBatch[i] && !m_abGeneratedColumns[i] &&
+            m_poFeatureDefn->GetFieldDefnUnsafe(i)->GetDefault() != nullptr)
+        {
+            bNative = false;
+        }
+    }
+    if (!bNative)
+        return OGRLayer::WriteArrowBatch(schema, array, papszOptions);
+
+    if (FlushPendingFeatures() != OGRERR_NONE)
+        return false;
+    if (m_bDeferredCreation && RunDeferredCreationIfNecessary() != OGRERR_NONE)
+        return false;
+
+    CancelAsyncNextArrowArray();
+
+#ifdef ENABLE_GPKG_OGR_CONTENTS
+    // To maximize performance of insertion, disable feature count triggers
+    if (m_bOGRFeatureCountTriggersEnabled)
+    {
+        DisableFeatureCountTriggers();
+    }
+#endif
+
+    /* Build the INSERT statement from the columns of the batch */
+    int iFIDColumn = -1;
+    const OGRArrowSimpleColumn *psGeomColumn = nullptr;
+    std::vector<OGRFieldType> aeColumnTypes;
+    CPLString osSQL;
+    osSQL.Printf("INSERT INTO \"%s\" (", SQLEscapeName(m_pszTableName).c_str());
+    CPLString osSQLValues;
+    for (size_t i = 0; i < asColumns.size(); ++i)
+    {
+        const auto &sColumn = asColumns[i];
+        const char *pszColumnName;
+        if (sColumn.bIsFID)
+        {
+            iFIDColumn = static_cast<int>(i);
+            pszColumnName = m_pszFidColumn;
+        }
+        else if (sColumn.bIsGeometry)
+        {
+            psGeomColumn = &sColumn;
+            pszColumnName = m_poFeatureDefn->GetGeomFieldDefn(0)->GetNameRef();
+        }
+        else
+        {
+            pszColumnName = m_poFeatureDefn->GetFieldDefnUnsafe(
+                                               sColumn.iOGRFieldIdx)
+                                ->GetNameRef();
+        }
+        aeColumnTypes.push_back(
+            sColumn.iOGRFieldIdx >= 0
+                ? m_poFeatureDefn->GetFieldDefnUnsafe(sColumn.iOGRFieldIdx)
+                      ->GetType()
+                : OFTInteger64);
+        if (i > 0)
+        {
+            osSQL += ", ";
+            osSQLValues += ", ";
+        }
+        osSQL += '"';
+        osSQL += SQLEscapeName(pszColumnName);
+        osSQL += '"';
+        osSQLValues += '?';
+    }
+    if (asColumns.empty())
+    {
+        osSQL.Printf("INSERT INTO \"%s\" DEFAULT VALUES",
+                     SQLEscapeName(m_pszTableName).c_str());
+    }
+    else
+    {
+        osSQL += ") VALUES (";
+        osSQL += osSQLValues;
+        osSQL += ')';
+    }
+
+    bool bTransactionOK;
+    {
+        CPLErrorHandlerPusher oHandler(CPLQuietErrorHandler);
+        CPLErrorStateBackuper oBackuper;
+        bTransactionOK = StartTransaction() == OGRERR_NONE;
+    }
+
+    sqlite3 *hDB = m_poDS->GetDB();
+    sqlite3_stmt *hInsertStmt = nullptr;
+    const auto Fail = [this, &hInsertStmt, bTransactionOK]()
+    {
+        sqlite3_finalize(hInsertStmt);
+        if (bTransactionOK)
+            RollbackTransaction();
+        return false;
+    };
+
+    /* Convert all geometries of the batch to GeoPackage blobs */
+    const size_t nRows = static_cast<size_t>(array->length);
+    std::vector<GByte> abyBlobs;
+    std::vector<size_t> anBlobOffsets;
+    std::vector<OGREnvelope> asEnvelopes;
+    if (psGeomColumn)
+    {
+        try
+        {
+            size_t nWKBSizeTotal = 0;
+            for (size_t iRow = 0; iRow < nRows; ++iRow)
+            {
+                size_t nWKBSize = 0;
+                if (!psGeomColumn->IsNull(iRow))
+                    psGeomColumn->GetBinary(iRow, nWKBSize);
+                nWKBSizeTotal += nWKBSize;
+            }
+            abyBlobs.reserve(nWKBSizeTotal + nRows * (8 + 6 * sizeof(double)));
+            anBlobOffsets.resize(nRows + 1);
+            asEnvelopes.resize(nRows);
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "WriteArrowBatch(): out of memory");
+            return Fail();
+        }
+        for (size_t iRow = 0; iRow < nRows; ++iRow)
+        {
+            anBlobOffsets[iRow] = abyBlobs.size();
+            if (psGeomColumn->IsNull(iRow))
+                continue;
+            size_t nWKBSize = 0;
+            const GByte *pabyWKB = psGeomColumn->GetBinary(iRow, nWKBSize);
+            OGRwkbGeometryType eGeomType = wkbUnknown;
+            if (!AppendGeometryBlobFromWKB(pabyWKB, nWKBSize, m_iSrs, abyBlobs,
+                                           eGeomType, asEnvelopes[iRow]))
+            {
+                // Curve geometries, collections, big-endian WKB, etc.
+                OGRGeometry *poGeomRaw = nullptr;
+                OGRGeometryFactory::createFromWkb(
+                    pabyWKB, nullptr, &poGeomRaw, nWKBSize, wkbVariantIso);
+                std::unique_ptr<OGRGeometry> poGeom(poGeomRaw);
+                if (!poGeom)
                 {
-                    if (m_aoRTreeEntries.size() == 1000 * 1000)
-                    {
-                        if (!FlushPendingSpatialIndexUpdate())
-                            return OGRERR_FAILURE;
-                    }
-                    GPKGRTreeEntry sEntry;
-                    sEntry.nId = nFID;
-                    sEntry.fMinX = rtreeValueDown(oEnv.MinX);
-                    sEntry.fMaxX = rtreeValueUp(oEnv.MaxX);
-                    sEntry.fMinY = rtreeValueDown(oEnv.MinY);
-                    sEntry.fMaxY = rtreeValueUp(oEnv.MaxY);
-                    m_aoRTreeEntries.push_back(sEntry);
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "WriteArrowBatch(): invalid WKB geometry at row "
+                             CPL_FRMT_GUIB,
+                             static_cast<GUIntBig>(iRow));
+                    return Fail();
                 }
+                size_t nBlobSize = 0;
+                GByte *pabyBlob =
+                    GPkgGeometryFromOGR(poGeom.get(), m_iSrs, &nBlobSize);
+                if (!pabyBlob)
+                    return Fail();
+                abyBlobs.insert(abyBlobs.end(), pabyBlob,
+                                pabyBlob + nBlobSize);
+                CPLFree(pabyBlob);
+                CreateGeometryExtensionIfNecessary(poGeom.get());
+                eGeomType = poGeom->getGeometryType();
+                if (!poGeom->IsEmpty())
+                    poGeom->getEnvelope(&asEnvelopes[iRow]);
             }
-            else if (!bUpsert && m_bAllowedRTreeThread &&
-                     !m_bErrorDuringRTreeThread)
+            CheckGeometryType(eGeomType);
+        }
+        anBlobOffsets[nRows] = abyBlobs.size();
+    }
+
+    if (sqlite3_prepare_v2(hDB, osSQL.c_str(), -1, &hInsertStmt, nullptr) !=
+        SQLITE_OK)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "failed to prepare SQL: %s - %s",
+                 osSQL.c_str(), sqlite3_errmsg(hDB));
+        return Fail();
+    }
+
+    struct ArrowArray *psFIDArray =
+        iFIDColumn >= 0 ? array->children[iFIDColumn] : nullptr;
+    int64_t nFIDNullCount = psFIDArray ? psFIDArray->null_count : 0;
+    for (size_t iRow = 0; iRow < nRows; ++iRow)
+    {
+        int err = SQLITE_OK;
+        for (size_t i = 0; err == SQLITE_OK && i < asColumns.size(); ++i)
+        {
+            const auto &sColumn = asColumns[i];
+            const int iParam = static_cast<int>(i) + 1;
+            if (sColumn.bIsGeometry)
             {
-                GPKGRTreeEntry sEntry;
-#ifdef DEBUG_VERBOSE
-                if (m_aoRTreeEntries.empty())
-                    CPLDebug("GPKG",
-                             "Starting to fill m_aoRTreeEntries at "
-                             "FID " CPL_FRMT_GIB,
-                             nFID);
-#endif
-                sEntry.nId = nFID;
-                sEntry.fMinX = rtreeValueDown(oEnv.MinX);
-                sEntry.fMaxX = rtreeValueUp(oEnv.MaxX);
-                sEntry.fMinY = rtreeValueDown(oEnv.MinY);
-                sEntry.fMaxY = rtreeValueUp(oEnv.MaxY);
-                try
+                const size_t nBlobSize =
+                    anBlobOffsets[iRow + 1] - anBlobOffsets[iRow];
+                err = nBlobSize == 0
+                          ? sqlite3_bind_null(hInsertStmt, iParam)
+                          : sqlite3_bind_blob(
+                                hInsertStmt, iParam,
+                                abyBlobs.data() + anBlobOffsets[iRow],
+                                static_cast<int>(nBlobSize), SQLITE_STATIC);
+            }
+            else if (sColumn.IsNull(iRow))
+            {
+                err = sqlite3_bind_null(hInsertStmt, iParam);
+            }
+            else
+            {
+                switch (aeColumnTypes[i])
                 {
-                    m_aoRTreeEntries.push_back(sEntry);
-                    if (m_aoRTreeEntries.size() == m_nRTreeBatchSize)
-                    {
-                        m_oQueueRTreeEntries.push(std::move(m_aoRTreeEntries));
-                        m_aoRTreeEntries = std::vector<GPKGRTreeEntry>();
-                    }
-                    if (!m_bThreadRTreeStarted &&
-                        m_oQueueRTreeEntries.size() ==
-                            m_nRTreeBatchesBeforeStart)
+                    case OFTReal:
+                        err = sqlite3_bind_double(hInsertStmt, iParam,
+                                                  sColumn.GetDouble(iRow));
+                        break;
+
+                    case OFTString:
+                    case OFTBinary:
                     {
-                        StartAsyncRTree();
+                        size_t nLen = 0;
+                        const GByte *pabyData =
+                            sColumn.GetBinary(iRow, nLen);
+                        if (nLen > static_cast<size_t>(
+                                       std::numeric_limits<int>::max()))
+                        {
+                            err = SQLITE_TOOBIG;
+                        }
+                        else if (aeColumnTypes[i] == OFTString)
+                        {
+                            err = sqlite3_bind_text(
+                                hInsertStmt, iParam,
+                                reinterpret_cast<const char *>(pabyData),
+                                static_cast<int>(nLen), SQLITE_STATIC);
+                        }
+                        else
+                        {
+                            err = sqlite3_bind_blob(hInsertStmt, iParam,
+                                                    pabyData,
+                                                    static_cast<int>(nLen),
+                                                    SQLITE_STATIC);
+                        }
+                        break;
                     }
+
+                    default:
+                        err = sqlite3_bind_int64(hInsertStmt, iParam,
+                                                 sColumn.GetInt64(iRow));
+                        break;
                 }
-                catch (const std::bad_alloc &)
-                {
-                    CPLDebug("GPKG",
-                             "Memory allocation error regarding RTree "
-                             "structures. Falling back to slower method");
-                    if (m_bThreadRTreeStarted)
-                        CancelAsyncRTree();
-                    else
-                        m_bAllowedRTreeThread = false;
-                }
             }
         }
+        if (err != SQLITE_OK)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "sqlite3_bind_xxx() failed%s",
+                     err == SQLITE_TOOBIG ? ": too big" : "");
+            return Fail();
+        }
+
+        err = sqlite3_step(hInsertStmt);
+        if (err != SQLITE_DONE && err != SQLITE_OK)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "failed to execute insert : %s",
+                     sqlite3_errmsg(hDB) ? sqlite3_errmsg(hDB) : "");
+            return Fail();
+        }
+        sqlite3_reset(hInsertStmt);
+        const GIntBig nFID = sqlite3_last_insert_rowid(hDB);
+
+        if (psGeomColumn && asEnvelopes[iRow].IsInit() &&
+            UpdateExtentAndSpatialIndexOfInsertedFeature(
+                nFID, asEnvelopes[iRow], /* bUpsert = */ false) != OGRERR_NONE)
+        {
+            return Fail();
+        }
+
+#ifdef ENABLE_GPKG_OGR_CONTENTS
+        if (m_nTotalFeatureCount >= 0)
+            m_nTotalFeatureCount++;
+#endif
+
+        // Report the FID of features inserted without one, as the generic
+        // implementation does
+        if (psFIDArray && asColumns[iFIDColumn].IsNull(iRow))
+        {
+            const size_t iIdx =
+                iRow + static_cast<size_t>(psFIDArray->offset);
+            const bool bFIDIsInt32 = asColumns[iFIDColumn].format[0] == 'i';
+            if (bFIDIsInt32 && nFID > std::numeric_limits<int32_t>::max())
+            {
+                CPLError(CE_Warning, CPLE_AppDefined,
+                         "FID " CPL_FRMT_GIB
+                         " cannot be stored in FID array of type int32",
+                         nFID);
+                continue;
+            }
+            if (bFIDIsInt32)
+            {
+                static_cast<int32_t *>(
+                    const_cast<void *>(psFIDArray->buffers[1]))[iIdx] =
+                    static_cast<int32_t>(nFID);
+            }
+            else
+            {
+                static_cast<int64_t *>(
+                    const_cast<void *>(psFIDArray->buffers[1]))[iIdx] = nFID;
+            }
+            static_cast<GByte *>(const_cast<void *>(
+                psFIDArray->buffers[0]))[iIdx / 8] |=
+                static_cast<GByte>(1 << (iIdx % 8));
+            --nFIDNullCount;
+        }
     }
+    if (psFIDArray)
+        psFIDArray->null_count = nFIDNullCount;
 
-#ifdef ENABLE_GPKG_OGR_CONTENTS
-    if (m_nTotalFeatureCount >= 0)
-        m_nTotalFeatureCount++;
-#endif
-
+    sqlite3_finalize(hInsertStmt);
     m_bContentChanged = true;
 
-    /* All done! */
-    return OGRERR_NONE;
-}
-
-OGRErr OGRGeoPackageTableLayer::ICreateFeature(OGRFeature *poFeature)
-{
-    return CreateOrUpsertFeature(poFeature, /* bUpsert=*/false);
+    bool bRet = true;
+    if (bTransactionOK)
+        bRet = CommitTransaction() == OGRERR_NONE;
+    return bRet;
 }
 
 /************************************************************************/
@@ -2810,6 +3514,345 @@ static size_t GetMaxRAMUsageAllowedForRTree()
     return static_cast<size_t>(nMaxRAMUsageAllowed);
 }
 
+/************************************************************************/
+/*                         GetThreadsAvailable()                        */
+/************************************************************************/
+
+static int GetThreadsAvailable()
+{
+    const char *pszMaxThreads =
+        CPLGetConfigOption("OGR_GPKG_NUM_THREADS", nullptr);
+    if (pszMaxThreads == nullptr)
+        return std::min(4, CPLGetNumCPUs());
+    else if (EQUAL(pszMaxThreads, "ALL_CPUS"))
+        return CPLGetNumCPUs();
+    else
+        return atoi(pszMaxThreads);
+}
+
+/************************************************************************/
+/*                           GPKGEnvelopeJob                            */
+/************************************************************************/
+
+// Batch of geometry blobs whose envelope is computed by a worker thread
+struct OGRGeoPackageTableLayer::GPKGEnvelopeJob
+{
+    std::vector<GIntBig> anFIDs{};
+    std::vector<size_t> anOffsets{0};  // offsets of each blob in abyBlobs
+    std::vector<GByte> abyBlobs{};
+    std::vector<GPKGRTreeEntry> asEntries{};
+};
+
+/************************************************************************/
+/*                       ComputeEnvelopesJobFunc()                      */
+/************************************************************************/
+
+void OGRGeoPackageTableLayer::ComputeEnvelopesJobFunc(void *pData)
+{
+    auto psJob = static_cast<GPKGEnvelopeJob *>(pData);
+    psJob->asEntries.reserve(psJob->anFIDs.size());
+    for (size_t i = 0; i < psJob->anFIDs.size(); ++i)
+    {
+        const GByte *pabyBLOB = psJob->abyBlobs.data() + psJob->anOffsets[i];
+        const size_t nBLOBLen = psJob->anOffsets[i + 1] - psJob->anOffsets[i];
+
+        // Same logic as ST_MinX() & co, without the SQL function overhead.
+        OGREnvelope sEnvelope;
+        GPkgHeader sHeader;
+        if (GPkgHeaderFromWKB(pabyBLOB, nBLOBLen, &sHeader) == OGRERR_NONE)
+        {
+            if (sHeader.bEmpty)
+                continue;
+            if (sHeader.bExtentHasXY)
+            {
+                sEnvelope.MinX = sHeader.MinX;
+                sEnvelope.MinY = sHeader.MinY;
+                sEnvelope.MaxX = sHeader.MaxX;
+                sEnvelope.MaxY = sHeader.MaxY;
+            }
+            else if (!OGRWKBGetBoundingBox(pabyBLOB + sHeader.nHeaderLen,
+                                           nBLOBLen - sHeader.nHeaderLen,
+                                           sEnvelope))
+            {
+                continue;
+            }
+        }
+        else
+        {
+            bool bEmpty = false;
+            if (nBLOBLen > static_cast<size_t>(INT_MAX) ||
+                OGRSQLiteGetSpatialiteGeometryHeader(
+                    pabyBLOB, static_cast<int>(nBLOBLen), nullptr, nullptr,
+                    &bEmpty, &sEnvelope.MinX, &sEnvelope.MinY,
+                    &sEnvelope.MaxX, &sEnvelope.MaxY) != OGRERR_NONE ||
+                bEmpty)
+            {
+                continue;
+            }
+        }
+
+        GPKGRTreeEntry sEntry;
+        sEntry.nId = psJob->anFIDs[i];
+        sEntry.fMinX = rtreeValueDown(sEnvelope.MinX);
+        sEntry.fMaxX = rtreeValueUp(sEnvelope.MaxX);
+        sEntry.fMinY = rtreeValueDown(sEnvelope.MinY);
+        sEntry.fMaxY = rtreeValueUp(sEnvelope.MaxY);
+        psJob->asEntries.push_back(sEntry);
+    }
+
+    // Release the memory of the blobs as soon as possible
+    psJob->anFIDs = std::vector<GIntBig>();
+    psJob->anOffsets = std::vector<size_t>();
+    psJob->abyBlobs = std::vector<GByte>();
+}
+
+/************************************************************************/
+/*                         SortRTreeEntriesSTR()                        */
+/************************************************************************/
+
+// Sort entries in Sort-Tile-Recursive order: entries are sorted by the X of
+// their center, split into vertical slices of about sqrt(number of leaves)
+// leaves, and each slice is sorted by the Y of the center. Inserting entries
+// in that order in the bulk loader results in well packed and mostly
+// non-overlapping nodes.
+void OGRGeoPackageTableLayer::SortRTreeEntriesSTR(
+    std::vector<GPKGRTreeEntry> &asEntries, size_t nNodeCapacity)
+{
+    const auto CenterX = [](const GPKGRTreeEntry &sEntry)
+    {
+        const double dfX =
+            (static_cast<double>(sEntry.fMinX) + sEntry.fMaxX) / 2;
+        return std::isnan(dfX) ? -std::numeric_limits<double>::infinity()
+                               : dfX;
+    };
+    const auto CenterY = [](const GPKGRTreeEntry &sEntry)
+    {
+        const double dfY =
+            (static_cast<double>(sEntry.fMinY) + sEntry.fMaxY) / 2;
+        return std::isnan(dfY) ? -std::numeric_limits<double>::infinity()
+                               : dfY;
+    };
+
+    const size_t nEntries = asEntries.size();
+    if (nEntries <= nNodeCapacity)
+        return;
+    std::sort(asEntries.begin(), asEntries.end(),
+              [&CenterX](const GPKGRTreeEntry &a, const GPKGRTreeEntry &b)
+              { return CenterX(a) < CenterX(b); });
+
+    const size_t nLeaves = DIV_ROUND_UP(nEntries, nNodeCapacity);
+    const size_t nSlices =
+        static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(nLeaves))));
+    const size_t nEntriesPerSlice =
+        DIV_ROUND_UP(nLeaves, nSlices) * nNodeCapacity;
+    for (size_t i = 0; i < nEntries; i += nEntriesPerSlice)
+    {
+        std::sort(asEntries.begin() + i,
+                  asEntries.begin() + std::min(nEntries, i + nEntriesPerSlice),
+                  [&CenterY](const GPKGRTreeEntry &a, const GPKGRTreeEntry &b)
+                  { return CenterY(a) < CenterY(b); });
+    }
+}
+
+/************************************************************************/
+/*                        BulkLoadSpatialIndex()                        */
+/************************************************************************/
+
+// Create and populate the RTree of the layer from the content of the
+// feature table. Envelopes are extracted from geometry blobs by worker
+// threads, sorted in STR order, and the RTree is built in RAM and
+// serialized in one go. If the RAM budget is exceeded, we fall back to
+// gdal_sqlite_rtree_bl_from_feature_table().
+bool OGRGeoPackageTableLayer::BulkLoadSpatialIndex(const char *pszT,
+                                                   const char *pszI,
+                                                   const char *pszC)
+{
+    sqlite3 *hDB = m_poDS->GetDB();
+    const size_t nMaxRAMUsageAllowed = GetMaxRAMUsageAllowedForRTree();
+
+    // Approximate RAM usage per row: the entry itself, plus the in-memory
+    // RTree (cf sqlite_rtree_bl_ram_usage())
+    constexpr size_t RAM_USAGE_PER_ROW = sizeof(GPKGRTreeEntry) + 24 * 17 / 10;
+    constexpr size_t ROWS_PER_JOB = 100 * 1000;
+
+    const int nThreads = sqlite3_threadsafe() != 0 ? GetThreadsAvailable() : 1;
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if (poThreadPool)
+        poJobQueue = poThreadPool->CreateJobQueue();
+
+    std::vector<std::unique_ptr<GPKGEnvelopeJob>> apoJobs;
+    bool bOK = true;
+    bool bMaxMemReached = false;
+    {
+        char *pszSQL = sqlite3_mprintf(
+            "SELECT \"%w\", \"%w\" FROM \"%w\" WHERE \"%w\" IS NOT NULL",
+            pszI, pszC, pszT, pszC);
+        sqlite3_stmt *hStmt = nullptr;
+        if (sqlite3_prepare_v2(hDB, pszSQL, -1, &hStmt, nullptr) != SQLITE_OK)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "failed to prepare SQL: %s",
+                     pszSQL);
+            sqlite3_free(pszSQL);
+            return false;
+        }
+        sqlite3_free(pszSQL);
+
+        const auto SubmitJob = [&apoJobs, &poJobQueue, nThreads]()
+        {
+            void *pJob = apoJobs.back().get();
+            if (!poJobQueue ||
+                !poJobQueue->SubmitJob(ComputeEnvelopesJobFunc, pJob))
+            {
+                ComputeEnvelopesJobFunc(pJob);
+            }
+            else
+            {
+                // Limit the number of batches of blobs in RAM
+                poJobQueue->WaitCompletion(nThreads);
+            }
+        };
+
+        size_t nRows = 0;
+        int nStepRet;
+        while ((nStepRet = sqlite3_step(hStmt)) == SQLITE_ROW)
+        {
+            if (sqlite3_column_type(hStmt, 1) != SQLITE_BLOB)
+                continue;
+            if (++nRows * RAM_USAGE_PER_ROW > nMaxRAMUsageAllowed)
+            {
+                bMaxMemReached = true;
+                break;
+            }
+            if (apoJobs.empty() ||
+                apoJobs.back()->anFIDs.size() == ROWS_PER_JOB)
+            {
+                if (!apoJobs.empty())
+                    SubmitJob();
+                apoJobs.emplace_back(std::make_unique<GPKGEnvelopeJob>());
+            }
+            auto &oJob = *(apoJobs.back());
+            const GByte *pabyBLOB =
+                static_cast<const GByte *>(sqlite3_column_blob(hStmt, 1));
+            const int nBLOBLen = sqlite3_column_bytes(hStmt, 1);
+            oJob.anFIDs.push_back(sqlite3_column_int64(hStmt, 0));
+            oJob.abyBlobs.insert(oJob.abyBlobs.end(), pabyBLOB,
+                                 pabyBLOB + nBLOBLen);
+            oJob.anOffsets.push_back(oJob.abyBlobs.size());
+        }
+        if (!bMaxMemReached && nStepRet != SQLITE_DONE)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "sqlite3_step() failed: %s",
+                     sqlite3_errmsg(hDB));
+            bOK = false;
+        }
+        sqlite3_finalize(hStmt);
+
+        if (bOK && !bMaxMemReached && !apoJobs.empty())
+            SubmitJob();
+        if (poJobQueue)
+            poJobQueue->WaitCompletion();
+    }
+    if (!bOK)
+        return false;
+
+    if (bMaxMemReached)
+    {
+        CPLDebug("GPKG", "Max RAM reached. Using "
+                         "gdal_sqlite_rtree_bl_from_feature_table()");
+        apoJobs.clear();
+
+        char *pszErrMsg = nullptr;
+        struct ProgressCbk
+        {
+            static bool progressCbk(const char *pszMessage, void *)
+            {
+                CPLDebug("GPKG", "%s", pszMessage);
+                return true;
+            }
+        };
+
+        if (!gdal_sqlite_rtree_bl_from_feature_table(
+                hDB, pszT, pszI, pszC, m_osRTreeName.c_str(), "id", "minx",
+                "miny", "maxx", "maxy", nMaxRAMUsageAllowed, &pszErrMsg,
+                ProgressCbk::progressCbk, nullptr))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "gdal_sqlite_rtree_bl_from_feature_table() failed "
+                     "with %s",
+                     pszErrMsg ? pszErrMsg : "(null)");
+            sqlite3_free(pszErrMsg);
+            return false;
+        }
+        return true;
+    }
+
+    std::vector<GPKGRTreeEntry> asEntries;
+    if (apoJobs.size() == 1)
+    {
+        asEntries = std::move(apoJobs[0]->asEntries);
+    }
+    else
+    {
+        size_t nEntries = 0;
+        for (const auto &poJob : apoJobs)
+            nEntries += poJob->asEntries.size();
+        asEntries.reserve(nEntries);
+        for (auto &poJob : apoJobs)
+        {
+            asEntries.insert(asEntries.end(), poJob->asEntries.begin(),
+                             poJob->asEntries.end());
+            poJob->asEntries = std::vector<GPKGRTreeEntry>();
+        }
+    }
+    apoJobs.clear();
+
+    // SQLite RTree nodes are (page_size - 64) bytes large, with a 4-byte
+    // header, 24 bytes per 2D cell, and at most 51 cells.
+    const int nPageSize = SQLGetInteger(hDB, "PRAGMA page_size", nullptr);
+    const size_t nNodeCapacity = static_cast<size_t>(
+        std::max(2, std::min(51, (nPageSize - 64 - 4) / 24)));
+    SortRTreeEntriesSTR(asEntries, nNodeCapacity);
+
+    sqlite_rtree_bl *hRTree = gdal_sqlite_rtree_bl_new(nPageSize);
+    if (!hRTree)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "sqlite_rtree_bl_new() failed");
+        return false;
+    }
+    for (const auto &sEntry : asEntries)
+    {
+        if (!gdal_sqlite_rtree_bl_insert(hRTree, sEntry.nId, sEntry.fMinX,
+                                         sEntry.fMinY, sEntry.fMaxX,
+                                         sEntry.fMaxY))
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "sqlite_rtree_bl_insert() failed");
+            gdal_sqlite_rtree_bl_free(hRTree);
+            return false;
+        }
+    }
+    CPLDebug("GPKG", "%u rows inserted in %s (in RAM)",
+             static_cast<unsigned>(asEntries.size()), m_osRTreeName.c_str());
+    asEntries = std::vector<GPKGRTreeEntry>();
+
+    char *pszErrMsg = nullptr;
+    bOK = gdal_sqlite_rtree_bl_serialize(hRTree, hDB, m_osRTreeName.c_str(),
+                                         "id", "minx", "miny", "maxx", "maxy",
+                                         &pszErrMsg);
+    gdal_sqlite_rtree_bl_free(hRTree);
+    if (!bOK)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "sqlite_rtree_bl_serialize() failed with %s",
+                 pszErrMsg ? pszErrMsg : "(null)");
+    }
+    sqlite3_free(pszErrMsg);
+    return bOK;
+}
+
 /************************************************************************/
 /*                      AsyncRTreeThreadFunction()                      */
 /************************************************************************/
@@ -2958,6 +4001,8 @@ OGRErr OGRGeoPackageTableLayer::ISetFeature(OGRFeature *poFeature)
                  "SetFeature");
         return OGRERR_FAILURE;
     }
+    if (FlushPendingFeatures() != OGRERR_NONE)
+        return OGRERR_FAILURE;
 
     /* No FID? */
     if (poFeature->GetFID() == OGRNullFID)
@@ -3084,6 +4129,8 @@ OGRErr OGRGeoPackageTableLayer::ISetFeature(OGRFeature *poFeature)
 OGRErr OGRGeoPackageTableLayer::IUpsertFeature(OGRFeature *poFeature)
 
 {
+    if (FlushPendingFeatures() != OGRERR_NONE)
+        return OGRERR_FAILURE;
     return CreateOrUpsertFeature(poFeature, /* bUpsert = */ true);
 }
 
@@ -3168,6 +4215,8 @@ OGRErr OGRGeoPackageTableLayer::IUpdateFeature(
                  "UpdateFeature");
         return OGRERR_FAILURE;
     }
+    if (FlushPendingFeatures() != OGRERR_NONE)
+        return OGRERR_FAILURE;
 
     /* No FID? */
     if (poFeature->GetFID() == OGRNullFID)
@@ -3337,6 +4386,8 @@ void OGRGeoPackageTableLayer::ResetReading()
     if (m_bDeferredCreation && RunDeferredCreationIfNecessary() != OGRERR_NONE)
         return;
 
+    FlushPendingFeatures();
+
     OGRGeoPackageLayer::ResetReading();
 
     if (m_poInsertStatement)
@@ -3373,6 +4424,8 @@ OGRErr OGRGeoPackageTableLayer::SetNextByIndex(GIntBig nIndex)
 {
     if (nIndex < 0)
         return OGRERR_FAILURE;
+    if (FlushPendingFeatures() != OGRERR_NONE)
+        return OGRERR_FAILURE;
     if (m_soColumns.empty())
         BuildColumns();
     return ResetStatementInternal(nIndex);
@@ -3479,6 +4532,8 @@ OGRFeature *OGRGeoPackageTableLayer::GetNextFeature()
         GetLayerDefn();
     if (m_bDeferredCreation && RunDeferredCreationIfNecessary() != OGRERR_NONE)
         return nullptr;
+    if (FlushPendingFeatures() != OGRERR_NONE)
+        return nullptr;
 
     CancelAsyncNextArrowArray();
 
@@ -3508,6 +4563,8 @@ OGRFeature *OGRGeoPackageTableLayer::GetFeature(GIntBig nFID)
         GetLayerDefn();
     if (m_bDeferredCreation && RunDeferredCreationIfNecessary() != OGRERR_NONE)
         return nullptr;
+    if (FlushPendingFeatures() != OGRERR_NONE)
+        return nullptr;
     CancelAsyncNextArrowArray();
 
     if (m_pszFidColumn == nullptr)
@@ -3581,6 +4638,9 @@ OGRErr OGRGeoPackageTableLayer::DeleteFeature(GIntBig nFID)
     if (m_bDeferredCreation && RunDeferredCreationIfNecessary() != OGRERR_NONE)
         return OGRERR_FAILURE;
 
+    if (FlushPendingFeatures() != OGRERR_NONE)
+        return OGRERR_FAILURE;
+
     CancelAsyncNextArrowArray();
 
     if (m_bThreadRTreeStarted)
@@ -3645,6 +4705,9 @@ OGRErr OGRGeoPackageTableLayer::DeleteFeature(GIntBig nFID)
 
 bool OGRGeoPackageTableLayer::DoJobAtTransactionCommit()
 {
+    if (FlushPendingFeatures() != OGRERR_NONE)
+        return false;
+    m_bSpatialIndexDroppedInTransaction = false;
     if (m_bAllowedRTreeThread)
         return true;
 
@@ -3662,11 +4725,21 @@ bool OGRGeoPackageTableLayer::DoJobAtTransactionCommit()
 
 bool OGRGeoPackageTableLayer::DoJobAtTransactionRollback()
 {
+    DiscardPendingFeatures();
     if (m_bThreadRTreeStarted)
         CancelAsyncRTree();
     m_nCountInsertInTransaction = 0;
     m_aoRTreeTriggersSQL.clear();
     m_aoRTreeEntries.clear();
+    if (m_bSpatialIndexDroppedInTransaction)
+    {
+        // The rollback has restored the spatial index dropped by
+        // DeferSpatialIndexRebuild()
+        m_bSpatialIndexDroppedInTransaction = false;
+        m_bDeferredSpatialIndexCreation = false;
+        m_bHasSpatialIndex = true;
+        m_nCountInsertWithSpatialIndex = 0;
+    }
     if (m_bTableCreatedInTransaction)
     {
         SyncToDisk();
@@ -3746,6 +4819,32 @@ bool OGRGeoPackageTableLayer::StartDeferredSpatialIndexUpdate()
     return true;
 }
 
+/************************************************************************/
+/*                      DeferSpatialIndexRebuild()                      */
+/************************************************************************/
+
+// Drop the spatial index, so that it is bulk loaded by
+// CreateSpatialIndexIfNecessary() when the layer is synced or a spatial
+// filter is used, rather than updated feature by feature.
+void OGRGeoPackageTableLayer::DeferSpatialIndexRebuild()
+{
+    CPLDebug("GPKG",
+             "Dropping spatial index of %s after " CPL_FRMT_GIB
+             " insertions. It will be rebuilt later",
+             m_pszTableName, m_nCountInsertWithSpatialIndex);
+
+    // Restore the triggers that may have been temporarily dropped by
+    // StartDeferredSpatialIndexUpdate(), as DropSpatialIndex() drops them.
+    m_aoRTreeEntries.clear();
+    RunDeferredSpatialIndexUpdate();
+
+    if (DropSpatialIndex())
+    {
+        m_bDeferredSpatialIndexCreation = true;
+        m_bSpatialIndexDroppedInTransaction = m_poDS->IsInTransaction();
+    }
+}
+
 /************************************************************************/
 /*                  FlushPendingSpatialIndexUpdate()                    */
 /************************************************************************/
@@ -3837,6 +4936,9 @@ OGRErr OGRGeoPackageTableLayer::SyncToDisk()
     if (m_bDeferredCreation && RunDeferredCreationIfNecessary() != OGRERR_NONE)
         return OGRERR_FAILURE;
 
+    if (FlushPendingFeatures() != OGRERR_NONE)
+        return OGRERR_FAILURE;
+
     // Both are exclusive
     CreateSpatialIndexIfNecessary();
     if (!RunDeferredSpatialIndexUpdate())
@@ -3920,6 +5022,8 @@ GIntBig OGRGeoPackageTableLayer::GetFeatureCount(int /*bForce*/)
 {
     if (!m_bFeatureDefnCompleted)
         GetLayerDefn();
+    if (FlushPendingFeatures() != OGRERR_NONE)
+        return -1;
 #ifdef ENABLE_GPKG_OGR_CONTENTS
     if (m_poFilterGeom == nullptr && m_pszAttrQueryString == nullptr)
     {
@@ -4121,6 +5225,8 @@ OGRErr OGRGeoPackageTableLayer::GetExtent(OGREnvelope *psExtent, int bForce)
 {
     if (!m_bFeatureDefnCompleted)
         GetLayerDefn();
+    if (FlushPendingFeatures() != OGRERR_NONE)
+        return OGRERR_FAILURE;
     /* Extent already calculated! We're done. */
     if (m_poExtent != nullptr)
     {
@@ -4269,6 +5375,10 @@ int OGRGeoPackageTableLayer::TestCapability(const char *pszCap)
     {
         return HasSpatialIndex() || m_bDeferredSpatialIndexCreation;
     }
+    else if (EQUAL(pszCap, OLCFastWriteArrowBatch))
+    {
+        return m_poDS->GetUpdate();
+    }
     else if (EQUAL(pszCap, OLCFastSetNextByIndex))
     {
         // Fast may not be that true on large layers, but better than the
@@ -4437,28 +5547,9 @@ bool OGRGeoPackageTableLayer::CreateSpatialIndex(const char *pszTableName)
     else
     {
         /* Populate the RTree */
-        const size_t nMaxRAMUsageAllowed = GetMaxRAMUsageAllowedForRTree();
-        char *pszErrMsg = nullptr;
-        struct ProgressCbk
-        {
-            static bool progressCbk(const char *pszMessage, void *)
-            {
-                CPLDebug("GPKG", "%s", pszMessage);
-                return true;
-            }
-        };
-
-        if (!gdal_sqlite_rtree_bl_from_feature_table(
-                m_poDS->GetDB(), pszT, pszI, pszC, m_osRTreeName.c_str(), "id",
-                "minx", "miny", "maxx", "maxy", nMaxRAMUsageAllowed, &pszErrMsg,
-                ProgressCbk::progressCbk, nullptr))
+        if (!BulkLoadSpatialIndex(pszT, pszI, pszC))
         {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "gdal_sqlite_rtree_bl_from_feature_table() failed "
-                     "with %s",
-                     pszErrMsg ? pszErrMsg : "(null)");
             m_poDS->SoftRollbackTransaction();
-            sqlite3_free(pszErrMsg);
             return false;
         }
     }
@@ -5094,6 +6185,42 @@ bool OGRGeoPackageTableLayer::DropSpatialIndex(bool bCalledFromSQLFunction)
     return true;
 }
 
+/************************************************************************/
+/*                        RebuildSpatialIndex()                         */
+/************************************************************************/
+
+bool OGRGeoPackageTableLayer::RebuildSpatialIndex()
+{
+    if (!m_bFeatureDefnCompleted)
+        GetLayerDefn();
+    if (!CheckUpdatableTable("RebuildSpatialIndex"))
+        return false;
+
+    if (m_bDeferredSpatialIndexCreation)
+        return CreateSpatialIndex();
+
+    if (!HasSpatialIndex())
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Spatial index not existing");
+        return false;
+    }
+
+    m_aoRTreeEntries.clear();
+    if (!RunDeferredSpatialIndexUpdate())
+        return false;
+
+    OGRGeoPackageTableLayer::ResetReading();
+    if (!DropSpatialIndex())
+        return false;
+    if (!CreateSpatialIndex())
+    {
+        // Retry at the next occasion
+        m_bDeferredSpatialIndexCreation = true;
+        return false;
+    }
+    return true;
+}
+
 /************************************************************************/
 /*               RunDeferredDropRTreeTableIfNecessary()                 */
 /************************************************************************/
@@ -7424,7 +8551,8 @@ OGRGeometryTypeCounter *OGRGeoPackageTableLayer::GetGeometryTypes(
     /*      Deferred actions, reset state.                                   */
     /* -------------------------------------------------------------------- */
     RunDeferredCreationIfNecessary();
-    if (!RunDeferredSpatialIndexUpdate())
+    if (FlushPendingFeatures() != OGRERR_NONE ||
+        !RunDeferredSpatialIndexUpdate())
     {
         nEntryCountOut = 0;
         return nullptr;
@@ -8302,6 +9430,11 @@ int OGRGeoPackageTableLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
         memset(out_array, 0, sizeof(*out_array));
         return EIO;
     }
+    if (FlushPendingFeatures() != OGRERR_NONE)
+    {
+        memset(out_array, 0, sizeof(*out_array));
+        return EIO;
+    }
 
     if (m_poFilterGeom != nullptr)
     {
@@ -8314,7 +9447,9 @@ int OGRGeoPackageTableLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
         }
     }
 
-    if (CPLTestBool(CPLGetConfigOption("OGR_GPKG_STREAM_BASE_IMPL", "NO")))
+    if (CPLTestBool(CPLGetConfigOption("OGR_GPKG_STREAM_BASE_IMPL", "NO")) ||
+        OGRArrowArrayHelper::HasGeoArrowGeometryField(
+            m_poFeatureDefn, m_aosArrowArrayStreamOptions))
     {
         return OGRGeoPackageLayer::GetNextArrowArray(stream, out_array);
     }
@@ -8459,18 +9594,6 @@ int OGRGeoPackageTableLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
         stopThread();
     }
 
-    const auto GetThreadsAvailable = []()
-    {
-        const char *pszMaxThreads =
-            CPLGetConfigOption("OGR_GPKG_NUM_THREADS", nullptr);
-        if (pszMaxThreads == nullptr)
-            return std::min(4, CPLGetNumCPUs());
-        else if (EQUAL(pszMaxThreads, "ALL_CPUS"))
-            return CPLGetNumCPUs();
-        else
-            return atoi(pszMaxThreads);
-    };
-
     // Start asynchronous tasks to prefetch the next ArrowArray
     if (m_poDS->GetAccess() == GA_ReadOnly &&
         m_oQueueArrowArrayPrefetchTasks.empty() &&
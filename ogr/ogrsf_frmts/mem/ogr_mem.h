@@ -86,6 +86,8 @@ class CPL_DLL OGRMemLayer CPL_NON_FINAL : public OGRLayer
 
     void ResetReading() override;
     OGRFeature *GetNextFeature() override;
+    int GetNextFeatureBatch(int nColumns, OGRFeatureBatchColumn *pasColumns,
+                            int nMaxFeatures) override;
     virtual OGRErr SetNextByIndex(GIntBig nIndex) override;
 
     OGRFeature *GetFeature(GIntBig nFeatureId) override;
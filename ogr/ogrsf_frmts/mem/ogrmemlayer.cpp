@@ -165,6 +165,56 @@ OGRFeature *OGRMemLayer::GetNextFeature()
     return nullptr;
 }
 
+/************************************************************************/
+/*                        GetNextFeatureBatch()                         */
+/************************************************************************/
+
+int OGRMemLayer::GetNextFeatureBatch(int nColumns,
+                                     OGRFeatureBatchColumn *pasColumns,
+                                     int nMaxFeatures)
+
+{
+    if (!InitFeatureBatchColumns(nColumns, pasColumns, nMaxFeatures))
+        return -1;
+
+    // Same iteration as GetNextFeature(), but values are read from the
+    // stored features instead of clones of them.
+    int nRows = 0;
+    while (nRows < nMaxFeatures)
+    {
+        OGRFeature *poFeature = nullptr;
+        if (m_papoFeatures)
+        {
+            if (m_iNextReadFID >= m_nMaxFeatureCount)
+                break;
+            poFeature = m_papoFeatures[m_iNextReadFID++];
+            if (poFeature == nullptr)
+                continue;
+        }
+        else if (m_oMapFeaturesIter != m_oMapFeatures.end())
+        {
+            poFeature = m_oMapFeaturesIter->second.get();
+            ++m_oMapFeaturesIter;
+        }
+        else
+        {
+            break;
+        }
+
+        if ((m_poFilterGeom == nullptr ||
+             FilterGeometry(poFeature->GetGeomFieldRef(m_iGeomFieldFilter))) &&
+            (m_poAttrQuery == nullptr || m_poAttrQuery->Evaluate(poFeature)))
+        {
+            m_nFeaturesRead++;
+            if (!FillFeatureBatchRow(poFeature, nColumns, pasColumns, nRows))
+                return -1;
+            ++nRows;
+        }
+    }
+
+    return nRows;
+}
+
 /************************************************************************/
 /*                           SetNextByIndex()                           */
 /************************************************************************/
@@ -77,7 +77,10 @@ constexpr int knMAX_FILES_PER_DIR = 10000;
 
 #include "cpl_worker_thread_pool.h"
 
+#include <chrono>
 #include <mutex>
+#include <queue>
+#include <tuple>
 
 // Limitations from https://github.com/mapbox/mapbox-geostats
 constexpr size_t knMAX_COUNT_LAYERS = 1000;
@@ -3236,6 +3239,40 @@ struct OGRMVTFeatureContent
     GIntBig nFID;
 };
 
+/************************************************************************/
+/*                          OGRMVTTempFeature                           */
+/************************************************************************/
+
+// Feature pre-encoded for a given tile, as accumulated in memory and
+// spilled to sorted runs of the temporary file.
+struct OGRMVTTempFeature
+{
+    int nZ = 0;
+    int nX = 0;
+    int nY = 0;
+    std::string osLayer{};
+    GIntBig nSerial = 0;
+    double dfAreaOrLength = 0;
+    std::string osFeature{};  // deflate compressed single-feature MVT layer
+
+    bool operator<(const OGRMVTTempFeature &other) const
+    {
+        return std::tie(nZ, nX, nY, osLayer, nSerial) <
+               std::tie(other.nZ, other.nX, other.nY, other.osLayer,
+                        other.nSerial);
+    }
+
+    bool IsSameTile(const OGRMVTTempFeature &other) const
+    {
+        return nZ == other.nZ && nX == other.nX && nY == other.nY;
+    }
+
+    size_t GetMemorySize() const
+    {
+        return sizeof(*this) + osLayer.capacity() + osFeature.capacity();
+    }
+};
+
 class OGRMVTWriterDataset final : public GDALDataset
 {
     class MVTFieldProperties
@@ -3262,13 +3299,43 @@ class OGRMVTWriterDataset final : public GDALDataset
         std::set<CPLString> m_oSetFields;
     };
 
+    // Changes to the layer properties implied by the encoding of a tile.
+    // Collected by the (possibly multi-threaded) tile encoding and applied
+    // afterwards in tile order.
+    class MVTLayerPropertiesUpdate
+    {
+      public:
+        std::string m_osLayerName;
+        std::vector<MVTTileLayerFeature::GeomType> m_aeGeomTypes;
+        std::vector<std::pair<std::string, MVTTileLayerValue>> m_aoKeyValues;
+    };
+
+    class MVTTileToEncode
+    {
+      public:
+        const OGRMVTWriterDataset *m_poDS = nullptr;
+        int m_nZ = 0;
+        int m_nX = 0;
+        int m_nY = 0;
+        std::vector<OGRMVTTempFeature> m_aoFeatures;
+        std::vector<MVTLayerPropertiesUpdate> m_aoUpdates;
+        std::string m_osTileBuffer;
+    };
+
     std::vector<std::unique_ptr<OGRMVTWriterLayer>> m_apoLayers;
     CPLString m_osTempDB;
-    mutable std::mutex m_oDBMutex;
+    VSILFILE *m_fpTemp = nullptr;
+    mutable std::mutex m_oTempMutex;
     mutable bool m_bWriteFeatureError = false;
+    // Features not yet spilled to the temporary file
+    mutable std::vector<OGRMVTTempFeature> m_aoTempFeatures;
+    mutable size_t m_nTempFeaturesMemSize = 0;
+    size_t m_nMaxTempFeaturesMemSize = 0;
+    // (offset, feature count) of the sorted runs of the temporary file
+    mutable std::vector<std::pair<vsi_l_offset, GUIntBig>> m_anTempRuns;
+    mutable GUIntBig m_nTempBytesWritten = 0;
+    bool m_bRemoveTempFile = true;
     sqlite3_vfs *m_pMyVFS = nullptr;
-    sqlite3 *m_hDB = nullptr;
-    sqlite3_stmt *m_hInsertStmt = nullptr;
     int m_nMinZoom = 0;
     int m_nMaxZoom = 5;
     double m_dfSimplification = 0.0;
@@ -3334,26 +3401,35 @@ class OGRMVTWriterDataset final : public GDALDataset
                                  int &nLastY) const;
 #endif
 
+    bool FlushTempFeatures() const;
+    bool ReadTempFileRuns();
+
     static void UpdateLayerProperties(MVTLayerProperties *poLayerProperties,
                                       const std::string &osKey,
                                       const MVTTileLayerValue &oValue);
 
-    void EncodeFeature(const void *pabyBlob, int nBlobSize,
+    static void ApplyLayerPropertiesUpdates(
+        int nZ, const std::vector<MVTLayerPropertiesUpdate> &aoUpdates,
+        std::map<CPLString, MVTLayerProperties> &oMapLayerProps,
+        std::set<CPLString> &oSetLayers);
+
+    void EncodeFeature(const std::string &osBlob,
                        std::shared_ptr<MVTTileLayer> &poTargetLayer,
                        std::map<CPLString, GUInt32> &oMapKeyToIdx,
                        std::map<MVTTileLayerValue, GUInt32> &oMapValueToIdx,
-                       MVTLayerProperties *poLayerProperties, GUInt32 nExtent,
-                       unsigned &nFeaturesInTile);
+                       MVTLayerPropertiesUpdate *poUpdate, GUInt32 nExtent,
+                       unsigned &nFeaturesInTile) const;
 
     std::string
-    EncodeTile(int nZ, int nX, int nY, sqlite3_stmt *hStmtLayer,
-               sqlite3_stmt *hStmtRows,
-               std::map<CPLString, MVTLayerProperties> &oMapLayerProps,
-               std::set<CPLString> &oSetLayers, GIntBig &nTempTilesRead);
+    EncodeTile(int nZ, int nX, int nY,
+               const std::vector<OGRMVTTempFeature> &aoFeatures,
+               std::vector<MVTLayerPropertiesUpdate> &aoUpdates) const;
 
-    std::string RecodeTileLowerResolution(int nZ, int nX, int nY, int nExtent,
-                                          sqlite3_stmt *hStmtLayer,
-                                          sqlite3_stmt *hStmtRows);
+    static void EncodeTileTaskFunc(void *pParam);
+
+    std::string RecodeTileLowerResolution(
+        int nZ, int nX, int nY, int nExtent,
+        const std::vector<OGRMVTTempFeature> &aoFeatures) const;
 
     bool CreateOutput();
 
@@ -3545,20 +3621,16 @@ CPLErr OGRMVTWriterDataset::Close()
             if (!CreateOutput())
                 eErr = CE_Failure;
         }
-        if (m_hInsertStmt != nullptr)
-        {
-            sqlite3_finalize(m_hInsertStmt);
-        }
-        if (m_hDB)
+        if (m_fpTemp)
         {
-            sqlite3_close(m_hDB);
+            VSIFCloseL(m_fpTemp);
+            m_fpTemp = nullptr;
         }
         if (m_hDBMBTILES)
         {
             sqlite3_close(m_hDBMBTILES);
         }
-        if (!m_osTempDB.empty() && !m_bReuseTempFile &&
-            CPLTestBool(CPLGetConfigOption("OGR_MVT_REMOVE_TEMP_FILE", "YES")))
+        if (!m_osTempDB.empty() && !m_bReuseTempFile && m_bRemoveTempFile)
         {
             VSIUnlink(m_osTempDB);
         }
@@ -4227,31 +4299,24 @@ OGRErr OGRMVTWriterDataset::PreGenerateForTileReal(
     size_t nCompressedSize = 0;
     void *pCompressed = CPLZLibDeflate(oBuffer.data(), oBuffer.size(), -1,
                                        nullptr, 0, &nCompressedSize);
-    oBuffer.assign(static_cast<char *>(pCompressed), nCompressedSize);
+    OGRMVTTempFeature oTempFeature;
+    oTempFeature.nZ = nZ;
+    oTempFeature.nX = nTileX;
+    oTempFeature.nY = nTileY;
+    oTempFeature.osLayer = osTargetName;
+    oTempFeature.nSerial = nSerial;
+    oTempFeature.dfAreaOrLength = dfAreaOrLength;
+    oTempFeature.osFeature.assign(static_cast<char *>(pCompressed),
+                                  nCompressedSize);
     CPLFree(pCompressed);
 
-    if (m_bThreadPoolOK)
-        m_oDBMutex.lock();
+    std::lock_guard<std::mutex> oLock(m_oTempMutex);
 
     m_nTempTiles++;
-    sqlite3_bind_int(m_hInsertStmt, 1, nZ);
-    sqlite3_bind_int(m_hInsertStmt, 2, nTileX);
-    sqlite3_bind_int(m_hInsertStmt, 3, nTileY);
-    sqlite3_bind_text(m_hInsertStmt, 4, osTargetName.c_str(), -1,
-                      SQLITE_STATIC);
-    sqlite3_bind_int64(m_hInsertStmt, 5, nSerial);
-    sqlite3_bind_blob(m_hInsertStmt, 6, oBuffer.data(),
-                      static_cast<int>(oBuffer.size()), SQLITE_STATIC);
-    sqlite3_bind_int(m_hInsertStmt, 7,
-                     static_cast<int>(poGPBFeature->getType()));
-    sqlite3_bind_double(m_hInsertStmt, 8, dfAreaOrLength);
-    int rc = sqlite3_step(m_hInsertStmt);
-    sqlite3_reset(m_hInsertStmt);
-
-    if (m_bThreadPoolOK)
-        m_oDBMutex.unlock();
-
-    if (!(rc == SQLITE_OK || rc == SQLITE_DONE))
+    m_nTempFeaturesMemSize += oTempFeature.GetMemorySize();
+    m_aoTempFeatures.push_back(std::move(oTempFeature));
+    if (m_nTempFeaturesMemSize > m_nMaxTempFeaturesMemSize &&
+        !FlushTempFeatures())
     {
         return OGRERR_FAILURE;
     }
@@ -4259,6 +4324,142 @@ OGRErr OGRMVTWriterDataset::PreGenerateForTileReal(
     return OGRERR_NONE;
 }
 
+/************************************************************************/
+/*                         FlushTempFeatures()                          */
+/************************************************************************/
+
+constexpr const char *knMVT_TEMP_RUN_MAGIC = "MVTRUN01";
+constexpr size_t knMVT_TEMP_RUN_HEADER_SIZE = 8 + 2 * sizeof(GUInt64);
+
+static void MVTTempAppendUInt32(std::string &osBuffer, GUInt32 nVal)
+{
+    CPL_LSBPTR32(&nVal);
+    osBuffer.append(reinterpret_cast<const char *>(&nVal), sizeof(nVal));
+}
+
+static void MVTTempAppendUInt64(std::string &osBuffer, GUInt64 nVal)
+{
+    CPL_LSBPTR64(&nVal);
+    osBuffer.append(reinterpret_cast<const char *>(&nVal), sizeof(nVal));
+}
+
+static void MVTTempAppendDouble(std::string &osBuffer, double dfVal)
+{
+    CPL_LSBPTR64(&dfVal);
+    osBuffer.append(reinterpret_cast<const char *>(&dfVal), sizeof(dfVal));
+}
+
+// Sorts the features accumulated in memory and appends them as a new run
+// at the end of the temporary file.
+// Must be called with m_oTempMutex held (or in single-threaded context)
+bool OGRMVTWriterDataset::FlushTempFeatures() const
+{
+    if (m_aoTempFeatures.empty())
+        return true;
+
+    std::sort(m_aoTempFeatures.begin(), m_aoTempFeatures.end());
+
+    std::string osBuffer;
+    osBuffer.append(knMVT_TEMP_RUN_MAGIC, 8);
+    MVTTempAppendUInt64(osBuffer, m_aoTempFeatures.size());
+    MVTTempAppendUInt64(osBuffer, 0);  // run size, patched below
+
+    VSIFSeekL(m_fpTemp, 0, SEEK_END);
+    const vsi_l_offset nRunOffset = VSIFTellL(m_fpTemp);
+    GUInt64 nRunSize = 0;
+    bool bOK = true;
+    constexpr size_t WRITE_BUFFER_SIZE = 1024 * 1024;
+    for (size_t i = 0; bOK && i < m_aoTempFeatures.size(); ++i)
+    {
+        const auto &oFeature = m_aoTempFeatures[i];
+        MVTTempAppendUInt32(osBuffer, static_cast<GUInt32>(oFeature.nZ));
+        MVTTempAppendUInt32(osBuffer, static_cast<GUInt32>(oFeature.nX));
+        MVTTempAppendUInt32(osBuffer, static_cast<GUInt32>(oFeature.nY));
+        MVTTempAppendUInt32(osBuffer,
+                            static_cast<GUInt32>(oFeature.osLayer.size()));
+        osBuffer.append(oFeature.osLayer);
+        MVTTempAppendUInt64(osBuffer, static_cast<GUInt64>(oFeature.nSerial));
+        MVTTempAppendDouble(osBuffer, oFeature.dfAreaOrLength);
+        MVTTempAppendUInt32(osBuffer,
+                            static_cast<GUInt32>(oFeature.osFeature.size()));
+        osBuffer.append(oFeature.osFeature);
+        if (osBuffer.size() >= WRITE_BUFFER_SIZE ||
+            i + 1 == m_aoTempFeatures.size())
+        {
+            bOK = VSIFWriteL(osBuffer.data(), 1, osBuffer.size(), m_fpTemp) ==
+                  osBuffer.size();
+            nRunSize += osBuffer.size();
+            osBuffer.clear();
+        }
+    }
+
+    if (bOK)
+    {
+        // Patch the run size in the header
+        nRunSize -= knMVT_TEMP_RUN_HEADER_SIZE;
+        MVTTempAppendUInt64(osBuffer, nRunSize);
+        bOK = VSIFSeekL(m_fpTemp, nRunOffset + 8 + sizeof(GUInt64),
+                        SEEK_SET) == 0 &&
+              VSIFWriteL(osBuffer.data(), 1, osBuffer.size(), m_fpTemp) ==
+                  osBuffer.size();
+    }
+    if (!bOK)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot write into %s",
+                 m_osTempDB.c_str());
+        return false;
+    }
+
+    m_anTempRuns.emplace_back(nRunOffset, m_aoTempFeatures.size());
+    m_nTempBytesWritten += knMVT_TEMP_RUN_HEADER_SIZE + nRunSize;
+    m_aoTempFeatures.clear();
+    m_nTempFeaturesMemSize = 0;
+    return true;
+}
+
+/************************************************************************/
+/*                          ReadTempFileRuns()                          */
+/************************************************************************/
+
+// Establishes the list of runs of an existing temporary file (debug mode
+// where the temporary file of a previous run is reused)
+bool OGRMVTWriterDataset::ReadTempFileRuns()
+{
+    VSIFSeekL(m_fpTemp, 0, SEEK_END);
+    const vsi_l_offset nFileSize = VSIFTellL(m_fpTemp);
+    vsi_l_offset nOffset = 0;
+    while (nOffset < nFileSize)
+    {
+        GByte abyHeader[knMVT_TEMP_RUN_HEADER_SIZE];
+        if (nFileSize - nOffset < knMVT_TEMP_RUN_HEADER_SIZE ||
+            VSIFSeekL(m_fpTemp, nOffset, SEEK_SET) != 0 ||
+            VSIFReadL(abyHeader, 1, sizeof(abyHeader), m_fpTemp) !=
+                sizeof(abyHeader) ||
+            memcmp(abyHeader, knMVT_TEMP_RUN_MAGIC, 8) != 0)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "%s is not a valid temporary file", m_osTempDB.c_str());
+            return false;
+        }
+        GUInt64 nCount = 0;
+        GUInt64 nRunSize = 0;
+        memcpy(&nCount, abyHeader + 8, sizeof(nCount));
+        memcpy(&nRunSize, abyHeader + 8 + sizeof(nCount), sizeof(nRunSize));
+        CPL_LSBPTR64(&nCount);
+        CPL_LSBPTR64(&nRunSize);
+        if (nRunSize > nFileSize - nOffset - knMVT_TEMP_RUN_HEADER_SIZE)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "%s is not a valid temporary file", m_osTempDB.c_str());
+            return false;
+        }
+        m_anTempRuns.emplace_back(nOffset, static_cast<GUIntBig>(nCount));
+        m_nTempTiles += static_cast<GIntBig>(nCount);
+        nOffset += knMVT_TEMP_RUN_HEADER_SIZE + nRunSize;
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                           MVTWriterTask()                            */
 /************************************************************************/
@@ -4291,9 +4492,9 @@ void OGRMVTWriterDataset::WriterTaskFunc(void *pParam)
         poTask->nSerial, poTask->poGeom.get(), poTask->sEnvelope);
     if (eErr != OGRERR_NONE)
     {
-        poTask->poDS->m_oDBMutex.lock();
+        poTask->poDS->m_oTempMutex.lock();
         poTask->poDS->m_bWriteFeatureError = true;
-        poTask->poDS->m_oDBMutex.unlock();
+        poTask->poDS->m_oTempMutex.unlock();
     }
     delete poTask;
 }
@@ -4718,16 +4919,15 @@ GetReducedPrecisionGeometry(MVTTileLayerFeature::GeomType eGeomType,
 /************************************************************************/
 
 void OGRMVTWriterDataset::EncodeFeature(
-    const void *pabyBlob, int nBlobSize,
-    std::shared_ptr<MVTTileLayer> &poTargetLayer,
+    const std::string &osBlob, std::shared_ptr<MVTTileLayer> &poTargetLayer,
     std::map<CPLString, GUInt32> &oMapKeyToIdx,
     std::map<MVTTileLayerValue, GUInt32> &oMapValueToIdx,
-    MVTLayerProperties *poLayerProperties, GUInt32 nExtent,
-    unsigned &nFeaturesInTile)
+    MVTLayerPropertiesUpdate *poUpdate, GUInt32 nExtent,
+    unsigned &nFeaturesInTile) const
 {
     size_t nUncompressedSize = 0;
-    void *pCompressed =
-        CPLZLibInflate(pabyBlob, nBlobSize, nullptr, 0, &nUncompressedSize);
+    void *pCompressed = CPLZLibInflate(osBlob.data(), osBlob.size(), nullptr,
+                                       0, &nUncompressedSize);
     GByte *pabyUncompressed = static_cast<GByte *>(pCompressed);
 
     MVTTileLayer oSrcTileLayer;
@@ -4745,9 +4945,9 @@ void OGRMVTWriterDataset::EncodeFeature(
             if (poSrcFeature->hasId())
                 poFeature->setId(poSrcFeature->getId());
             poFeature->setType(poSrcFeature->getType());
-            if (poLayerProperties)
+            if (poUpdate)
             {
-                poLayerProperties->m_oCountGeomType[poSrcFeature->getType()]++;
+                poUpdate->m_aeGeomTypes.push_back(poSrcFeature->getType());
             }
             bool bOK = true;
             if (nExtent < m_nExtent)
@@ -4821,10 +5021,10 @@ void OGRMVTWriterDataset::EncodeFeature(
                         const auto &osKey = srcKeys[nSrcIdxKey];
                         const auto &oValue = srcValues[nSrcIdxValue];
 
-                        if (poLayerProperties)
+                        if (poUpdate)
                         {
-                            UpdateLayerProperties(poLayerProperties, osKey,
-                                                  oValue);
+                            poUpdate->m_aoKeyValues.emplace_back(osKey,
+                                                                 oValue);
                         }
 
                         poFeature->addTag(oMapKeyToIdx[osKey]);
@@ -4847,34 +5047,17 @@ void OGRMVTWriterDataset::EncodeFeature(
 }
 
 /************************************************************************/
-/*                            EncodeTile()                              */
+/*                     ApplyLayerPropertiesUpdates()                    */
 /************************************************************************/
 
-std::string OGRMVTWriterDataset::EncodeTile(
-    int nZ, int nX, int nY, sqlite3_stmt *hStmtLayer, sqlite3_stmt *hStmtRows,
+void OGRMVTWriterDataset::ApplyLayerPropertiesUpdates(
+    int nZ, const std::vector<MVTLayerPropertiesUpdate> &aoUpdates,
     std::map<CPLString, MVTLayerProperties> &oMapLayerProps,
-    std::set<CPLString> &oSetLayers, GIntBig &nTempTilesRead)
+    std::set<CPLString> &oSetLayers)
 {
-    MVTTile oTargetTile;
-
-    sqlite3_bind_int(hStmtLayer, 1, nZ);
-    sqlite3_bind_int(hStmtLayer, 2, nX);
-    sqlite3_bind_int(hStmtLayer, 3, nY);
-
-    unsigned nFeaturesInTile = 0;
-    const GIntBig nProgressStep =
-        std::max(static_cast<GIntBig>(1), m_nTempTiles / 10);
-
-    while (nFeaturesInTile < m_nMaxFeatures &&
-           sqlite3_step(hStmtLayer) == SQLITE_ROW)
+    for (const auto &oUpdate : aoUpdates)
     {
-        const char *pszLayerName =
-            reinterpret_cast<const char *>(sqlite3_column_text(hStmtLayer, 0));
-        sqlite3_bind_int(hStmtRows, 1, nZ);
-        sqlite3_bind_int(hStmtRows, 2, nX);
-        sqlite3_bind_int(hStmtRows, 3, nY);
-        sqlite3_bind_text(hStmtRows, 4, pszLayerName, -1, SQLITE_STATIC);
-
+        const char *pszLayerName = oUpdate.m_osLayerName.c_str();
         auto oIterMapLayerProps = oMapLayerProps.find(pszLayerName);
         MVTLayerProperties *poLayerProperties = nullptr;
         if (oIterMapLayerProps == oMapLayerProps.end())
@@ -4902,11 +5085,42 @@ std::string OGRMVTWriterDataset::EncodeTile(
                 std::min(nZ, poLayerProperties->m_nMinZoom);
             poLayerProperties->m_nMaxZoom =
                 std::max(nZ, poLayerProperties->m_nMaxZoom);
+            for (const auto eGeomType : oUpdate.m_aeGeomTypes)
+                poLayerProperties->m_oCountGeomType[eGeomType]++;
+            for (const auto &oKeyValue : oUpdate.m_aoKeyValues)
+            {
+                UpdateLayerProperties(poLayerProperties, oKeyValue.first,
+                                      oKeyValue.second);
+            }
         }
+    }
+}
+
+/************************************************************************/
+/*                            EncodeTile()                              */
+/************************************************************************/
+
+// aoFeatures must be the features of the tile, sorted by layer name and
+// serial number.
+std::string OGRMVTWriterDataset::EncodeTile(
+    int nZ, int nX, int nY, const std::vector<OGRMVTTempFeature> &aoFeatures,
+    std::vector<MVTLayerPropertiesUpdate> &aoUpdates) const
+{
+    MVTTile oTargetTile;
+
+    unsigned nFeaturesInTile = 0;
+    size_t iFeature = 0;
+    while (nFeaturesInTile < m_nMaxFeatures && iFeature < aoFeatures.size())
+    {
+        const std::string &osLayerName = aoFeatures[iFeature].osLayer;
+
+        aoUpdates.emplace_back();
+        MVTLayerPropertiesUpdate &oUpdate = aoUpdates.back();
+        oUpdate.m_osLayerName = osLayerName;
 
         std::shared_ptr<MVTTileLayer> poTargetLayer(new MVTTileLayer());
         oTargetTile.addLayer(poTargetLayer);
-        poTargetLayer->setName(pszLayerName);
+        poTargetLayer->setName(osLayerName);
         poTargetLayer->setVersion(m_nMVTVersion);
         poTargetLayer->setExtent(m_nExtent);
 
@@ -4914,29 +5128,16 @@ std::string OGRMVTWriterDataset::EncodeTile(
         std::map<MVTTileLayerValue, GUInt32> oMapValueToIdx;
 
         while (nFeaturesInTile < m_nMaxFeatures &&
-               sqlite3_step(hStmtRows) == SQLITE_ROW)
+               iFeature < aoFeatures.size() &&
+               aoFeatures[iFeature].osLayer == osLayerName)
         {
-            int nBlobSize = sqlite3_column_bytes(hStmtRows, 0);
-            const void *pabyBlob = sqlite3_column_blob(hStmtRows, 0);
-
-            EncodeFeature(pabyBlob, nBlobSize, poTargetLayer, oMapKeyToIdx,
-                          oMapValueToIdx, poLayerProperties, m_nExtent,
+            EncodeFeature(aoFeatures[iFeature].osFeature, poTargetLayer,
+                          oMapKeyToIdx, oMapValueToIdx, &oUpdate, m_nExtent,
                           nFeaturesInTile);
-
-            nTempTilesRead++;
-            if (nTempTilesRead == m_nTempTiles ||
-                (nTempTilesRead % nProgressStep) == 0)
-            {
-                const int nPct =
-                    static_cast<int>((100 * nTempTilesRead) / m_nTempTiles);
-                CPLDebug("MVT", "%d%%...", nPct);
-            }
+            ++iFeature;
         }
-        sqlite3_reset(hStmtRows);
     }
 
-    sqlite3_reset(hStmtLayer);
-
     std::string oTileBuffer(oTargetTile.write());
     size_t nSizeBefore = oTileBuffer.size();
     if (m_bGZip)
@@ -4956,8 +5157,8 @@ std::string OGRMVTWriterDataset::EncodeTile(
     {
         nExtent /= 2;
         nSizeBefore = oTileBuffer.size();
-        oTileBuffer = RecodeTileLowerResolution(nZ, nX, nY, nExtent, hStmtLayer,
-                                                hStmtRows);
+        oTileBuffer =
+            RecodeTileLowerResolution(nZ, nX, nY, nExtent, aoFeatures);
         bTooBigTile = oTileBuffer.size() > m_nMaxTileSize;
         CPLDebug("MVT",
                  "Recoding tile %d/%d/%d with extent = %u. "
@@ -4985,17 +5186,17 @@ std::string OGRMVTWriterDataset::EncodeTile(
 
         const unsigned nTotalFeaturesInTile =
             std::min(m_nMaxFeatures, nFeaturesInTile);
-        char *pszSQL =
-            sqlite3_mprintf("SELECT layer, feature FROM temp "
-                            "WHERE z = %d AND x = %d AND y = %d ORDER BY "
-                            "area_or_length DESC LIMIT %d",
-                            nZ, nX, nY, nTotalFeaturesInTile);
-        sqlite3_stmt *hTmpStmt = nullptr;
-        CPL_IGNORE_RET_VAL(
-            sqlite3_prepare_v2(m_hDB, pszSQL, -1, &hTmpStmt, nullptr));
-        sqlite3_free(pszSQL);
-        if (!hTmpStmt)
-            return std::string();
+
+        std::vector<const OGRMVTTempFeature *> apoSortedFeatures;
+        apoSortedFeatures.reserve(aoFeatures.size());
+        for (const auto &oFeature : aoFeatures)
+            apoSortedFeatures.push_back(&oFeature);
+        std::stable_sort(apoSortedFeatures.begin(), apoSortedFeatures.end(),
+                         [](const OGRMVTTempFeature *a,
+                            const OGRMVTTempFeature *b)
+                         { return a->dfAreaOrLength > b->dfAreaOrLength; });
+        if (apoSortedFeatures.size() > nTotalFeaturesInTile)
+            apoSortedFeatures.resize(nTotalFeaturesInTile);
 
         class TargetTileLayerProps
         {
@@ -5009,12 +5210,9 @@ std::string OGRMVTWriterDataset::EncodeTile(
 
         nFeaturesInTile = 0;
         const unsigned nCheckStep = std::max(1U, nTotalFeaturesInTile / 100);
-        while (sqlite3_step(hTmpStmt) == SQLITE_ROW)
+        for (const OGRMVTTempFeature *poFeature : apoSortedFeatures)
         {
-            const char *pszLayerName = reinterpret_cast<const char *>(
-                sqlite3_column_text(hTmpStmt, 0));
-            int nBlobSize = sqlite3_column_bytes(hTmpStmt, 1);
-            const void *pabyBlob = sqlite3_column_blob(hTmpStmt, 1);
+            const char *pszLayerName = poFeature->osLayer.c_str();
 
             std::shared_ptr<MVTTileLayer> poTargetLayer;
             std::map<CPLString, GUInt32> *poMapKeyToIdx;
@@ -5043,7 +5241,7 @@ std::string OGRMVTWriterDataset::EncodeTile(
                 poMapValueToIdx = &oIter->second.m_oMapValueToIdx;
             }
 
-            EncodeFeature(pabyBlob, nBlobSize, poTargetLayer, *poMapKeyToIdx,
+            EncodeFeature(poFeature->osFeature, poTargetLayer, *poMapKeyToIdx,
                           *poMapValueToIdx, nullptr, nExtent, nFeaturesInTile);
 
             if (nFeaturesInTile == nTotalFeaturesInTile ||
@@ -5065,41 +5263,42 @@ std::string OGRMVTWriterDataset::EncodeTile(
             CPLDebug("MVT", "For tile %d/%d/%d, final tile size is %u", nZ, nX,
                      nY, static_cast<unsigned>(oTileBuffer.size()));
         }
-
-        sqlite3_finalize(hTmpStmt);
     }
 
     return oTileBuffer;
 }
 
+/************************************************************************/
+/*                        EncodeTileTaskFunc()                          */
+/************************************************************************/
+
+void OGRMVTWriterDataset::EncodeTileTaskFunc(void *pParam)
+{
+    MVTTileToEncode *poTile = static_cast<MVTTileToEncode *>(pParam);
+    poTile->m_osTileBuffer = poTile->m_poDS->EncodeTile(
+        poTile->m_nZ, poTile->m_nX, poTile->m_nY, poTile->m_aoFeatures,
+        poTile->m_aoUpdates);
+}
+
 /************************************************************************/
 /*                    RecodeTileLowerResolution()                       */
 /************************************************************************/
 
 std::string OGRMVTWriterDataset::RecodeTileLowerResolution(
-    int nZ, int nX, int nY, int nExtent, sqlite3_stmt *hStmtLayer,
-    sqlite3_stmt *hStmtRows)
+    int /* nZ */, int /* nX */, int /* nY */, int nExtent,
+    const std::vector<OGRMVTTempFeature> &aoFeatures) const
 {
     MVTTile oTargetTile;
 
-    sqlite3_bind_int(hStmtLayer, 1, nZ);
-    sqlite3_bind_int(hStmtLayer, 2, nX);
-    sqlite3_bind_int(hStmtLayer, 3, nY);
-
     unsigned nFeaturesInTile = 0;
-    while (nFeaturesInTile < m_nMaxFeatures &&
-           sqlite3_step(hStmtLayer) == SQLITE_ROW)
+    size_t iFeature = 0;
+    while (nFeaturesInTile < m_nMaxFeatures && iFeature < aoFeatures.size())
     {
-        const char *pszLayerName =
-            reinterpret_cast<const char *>(sqlite3_column_text(hStmtLayer, 0));
-        sqlite3_bind_int(hStmtRows, 1, nZ);
-        sqlite3_bind_int(hStmtRows, 2, nX);
-        sqlite3_bind_int(hStmtRows, 3, nY);
-        sqlite3_bind_text(hStmtRows, 4, pszLayerName, -1, SQLITE_STATIC);
+        const std::string &osLayerName = aoFeatures[iFeature].osLayer;
 
         std::shared_ptr<MVTTileLayer> poTargetLayer(new MVTTileLayer());
         oTargetTile.addLayer(poTargetLayer);
-        poTargetLayer->setName(pszLayerName);
+        poTargetLayer->setName(osLayerName);
         poTargetLayer->setVersion(m_nMVTVersion);
         poTargetLayer->setExtent(nExtent);
 
@@ -5107,19 +5306,16 @@ std::string OGRMVTWriterDataset::RecodeTileLowerResolution(
         std::map<MVTTileLayerValue, GUInt32> oMapValueToIdx;
 
         while (nFeaturesInTile < m_nMaxFeatures &&
-               sqlite3_step(hStmtRows) == SQLITE_ROW)
+               iFeature < aoFeatures.size() &&
+               aoFeatures[iFeature].osLayer == osLayerName)
         {
-            int nBlobSize = sqlite3_column_bytes(hStmtRows, 0);
-            const void *pabyBlob = sqlite3_column_blob(hStmtRows, 0);
-
-            EncodeFeature(pabyBlob, nBlobSize, poTargetLayer, oMapKeyToIdx,
-                          oMapValueToIdx, nullptr, nExtent, nFeaturesInTile);
+            EncodeFeature(aoFeatures[iFeature].osFeature, poTargetLayer,
+                          oMapKeyToIdx, oMapValueToIdx, nullptr, nExtent,
+                          nFeaturesInTile);
+            ++iFeature;
         }
-        sqlite3_reset(hStmtRows);
     }
 
-    sqlite3_reset(hStmtLayer);
-
     std::string oTileBuffer(oTargetTile.write());
     if (m_bGZip)
         GZIPCompress(oTileBuffer);
@@ -5127,6 +5323,231 @@ std::string OGRMVTWriterDataset::RecodeTileLowerResolution(
     return oTileBuffer;
 }
 
+/************************************************************************/
+/*                        OGRMVTTempRunReader                           */
+/************************************************************************/
+
+// Sequential reader of a sorted run of the temporary file. Several readers
+// share the same file handle, hence the explicit seek before each buffer
+// refill.
+class OGRMVTTempRunReader
+{
+    VSILFILE *m_fp = nullptr;
+    vsi_l_offset m_nOffset = 0;
+    vsi_l_offset m_nEnd = 0;
+    GUIntBig m_nRemaining = 0;
+    std::vector<GByte> m_abyBuffer{};
+    size_t m_nBufferPos = 0;
+    bool m_bError = false;
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRMVTTempRunReader)
+
+    static constexpr size_t BUFFER_SIZE = 1024 * 1024;
+
+    bool Read(void *pDest, size_t nSize);
+
+    bool Read(GUInt32 &nVal)
+    {
+        if (!Read(&nVal, sizeof(nVal)))
+            return false;
+        CPL_LSBPTR32(&nVal);
+        return true;
+    }
+
+    bool Read(GUInt64 &nVal)
+    {
+        if (!Read(&nVal, sizeof(nVal)))
+            return false;
+        CPL_LSBPTR64(&nVal);
+        return true;
+    }
+
+    bool Read(double &dfVal)
+    {
+        if (!Read(&dfVal, sizeof(dfVal)))
+            return false;
+        CPL_LSBPTR64(&dfVal);
+        return true;
+    }
+
+    bool Read(std::string &osStr);
+
+  public:
+    OGRMVTTempRunReader(VSILFILE *fp, vsi_l_offset nOffset,
+                        vsi_l_offset nEnd, GUIntBig nCount)
+        : m_fp(fp), m_nOffset(nOffset), m_nEnd(nEnd), m_nRemaining(nCount)
+    {
+    }
+
+    bool Next(OGRMVTTempFeature &oFeature);
+
+    bool HasError() const
+    {
+        return m_bError;
+    }
+};
+
+bool OGRMVTTempRunReader::Read(void *pDest, size_t nSize)
+{
+    GByte *pabyDest = static_cast<GByte *>(pDest);
+    while (nSize > 0)
+    {
+        if (m_nBufferPos == m_abyBuffer.size())
+        {
+            const size_t nToRead = static_cast<size_t>(
+                std::min<vsi_l_offset>(BUFFER_SIZE, m_nEnd - m_nOffset));
+            m_abyBuffer.resize(nToRead);
+            m_nBufferPos = 0;
+            if (nToRead == 0 || VSIFSeekL(m_fp, m_nOffset, SEEK_SET) != 0 ||
+                VSIFReadL(m_abyBuffer.data(), 1, nToRead, m_fp) != nToRead)
+            {
+                m_abyBuffer.clear();
+                m_bError = true;
+                return false;
+            }
+            m_nOffset += nToRead;
+        }
+        const size_t nAvail =
+            std::min(nSize, m_abyBuffer.size() - m_nBufferPos);
+        memcpy(pabyDest, m_abyBuffer.data() + m_nBufferPos, nAvail);
+        m_nBufferPos += nAvail;
+        pabyDest += nAvail;
+        nSize -= nAvail;
+    }
+    return true;
+}
+
+bool OGRMVTTempRunReader::Read(std::string &osStr)
+{
+    GUInt32 nSize = 0;
+    if (!Read(nSize))
+        return false;
+    if (nSize > (m_nEnd - m_nOffset) + (m_abyBuffer.size() - m_nBufferPos))
+    {
+        m_bError = true;
+        return false;
+    }
+    osStr.resize(nSize);
+    return nSize == 0 || Read(&osStr[0], nSize);
+}
+
+bool OGRMVTTempRunReader::Next(OGRMVTTempFeature &oFeature)
+{
+    if (m_nRemaining == 0 || m_bError)
+        return false;
+    --m_nRemaining;
+    GUInt32 nZ = 0;
+    GUInt32 nX = 0;
+    GUInt32 nY = 0;
+    GUInt64 nSerial = 0;
+    if (!Read(nZ) || !Read(nX) || !Read(nY) || !Read(oFeature.osLayer) ||
+        !Read(nSerial) || !Read(oFeature.dfAreaOrLength) ||
+        !Read(oFeature.osFeature))
+    {
+        m_bError = true;
+        return false;
+    }
+    oFeature.nZ = static_cast<int>(nZ);
+    oFeature.nX = static_cast<int>(nX);
+    oFeature.nY = static_cast<int>(nY);
+    oFeature.nSerial = static_cast<GIntBig>(nSerial);
+    return true;
+}
+
+/************************************************************************/
+/*                       OGRMVTTempFeatureMerger                        */
+/************************************************************************/
+
+// Returns the temporary features in (z, x, y, layer, serial) order, either
+// from the features kept in memory when nothing was spilled, or by merging
+// the sorted runs of the temporary file.
+class OGRMVTTempFeatureMerger
+{
+    std::vector<OGRMVTTempFeature> *m_paoMemFeatures = nullptr;
+    size_t m_nMemIdx = 0;
+
+    std::vector<std::unique_ptr<OGRMVTTempRunReader>> m_apoReaders{};
+    std::vector<OGRMVTTempFeature> m_aoHeads{};
+
+    struct HeadGreater
+    {
+        const std::vector<OGRMVTTempFeature> *paoHeads;
+
+        bool operator()(size_t a, size_t b) const
+        {
+            const auto &oA = (*paoHeads)[a];
+            const auto &oB = (*paoHeads)[b];
+            if (oB < oA)
+                return true;
+            if (oA < oB)
+                return false;
+            return a > b;
+        }
+    };
+
+    std::priority_queue<size_t, std::vector<size_t>, HeadGreater> m_oQueue;
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRMVTTempFeatureMerger)
+
+  public:
+    explicit OGRMVTTempFeatureMerger(
+        std::vector<OGRMVTTempFeature> *paoMemFeatures)
+        : m_paoMemFeatures(paoMemFeatures), m_oQueue(HeadGreater{&m_aoHeads})
+    {
+    }
+
+    // Runs are contiguous in the file, and the last one ends at its end
+    OGRMVTTempFeatureMerger(
+        VSILFILE *fp,
+        const std::vector<std::pair<vsi_l_offset, GUIntBig>> &anRuns)
+        : m_oQueue(HeadGreater{&m_aoHeads})
+    {
+        VSIFSeekL(fp, 0, SEEK_END);
+        const vsi_l_offset nFileSize = VSIFTellL(fp);
+        m_aoHeads.resize(anRuns.size());
+        for (size_t i = 0; i < anRuns.size(); ++i)
+        {
+            const vsi_l_offset nStart =
+                anRuns[i].first + knMVT_TEMP_RUN_HEADER_SIZE;
+            const vsi_l_offset nEnd =
+                i + 1 < anRuns.size() ? anRuns[i + 1].first : nFileSize;
+            m_apoReaders.push_back(std::make_unique<OGRMVTTempRunReader>(
+                fp, nStart, nEnd, anRuns[i].second));
+            if (m_apoReaders.back()->Next(m_aoHeads[i]))
+                m_oQueue.push(i);
+        }
+    }
+
+    bool Next(OGRMVTTempFeature &oFeature)
+    {
+        if (m_paoMemFeatures)
+        {
+            if (m_nMemIdx == m_paoMemFeatures->size())
+                return false;
+            oFeature = std::move((*m_paoMemFeatures)[m_nMemIdx++]);
+            return true;
+        }
+        if (m_oQueue.empty())
+            return false;
+        const size_t i = m_oQueue.top();
+        m_oQueue.pop();
+        oFeature = std::move(m_aoHeads[i]);
+        if (m_apoReaders[i]->Next(m_aoHeads[i]))
+            m_oQueue.push(i);
+        return true;
+    }
+
+    bool HasError() const
+    {
+        for (const auto &poReader : m_apoReaders)
+        {
+            if (poReader->HasError())
+                return true;
+        }
+        return false;
+    }
+};
+
 /************************************************************************/
 /*                            CreateOutput()                            */
 /************************************************************************/
@@ -5144,42 +5565,27 @@ bool OGRMVTWriterDataset::CreateOutput()
         return GenerateMetadata(0, oMapLayerProps);
     }
 
-    CPLDebug("MVT", "Building output file from temporary database...");
+    CPLDebug("MVT", "Building output file from temporary file...");
 
-    sqlite3_stmt *hStmtZXY = nullptr;
-    CPL_IGNORE_RET_VAL(sqlite3_prepare_v2(
-        m_hDB, "SELECT DISTINCT z, x, y FROM temp ORDER BY z, x, y", -1,
-        &hStmtZXY, nullptr));
-    if (hStmtZXY == nullptr)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined, "Prepared statement failed");
+    const auto tStart = std::chrono::steady_clock::now();
+
+    // If some features were already spilled, or if the temporary file must
+    // be kept, write the remaining ones as a last run.
+    if ((!m_anTempRuns.empty() || !m_bRemoveTempFile) && !FlushTempFeatures())
         return false;
-    }
+    const GUIntBig nSpilledBytes = m_nTempBytesWritten;
+    const size_t nRuns = m_anTempRuns.size();
 
-    sqlite3_stmt *hStmtLayer = nullptr;
-    CPL_IGNORE_RET_VAL(
-        sqlite3_prepare_v2(m_hDB,
-                           "SELECT DISTINCT layer FROM temp "
-                           "WHERE z = ? AND x = ? AND y = ? ORDER BY layer",
-                           -1, &hStmtLayer, nullptr));
-    if (hStmtLayer == nullptr)
+    std::unique_ptr<OGRMVTTempFeatureMerger> poMerger;
+    if (m_anTempRuns.empty())
     {
-        CPLError(CE_Failure, CPLE_AppDefined, "Prepared statement failed");
-        sqlite3_finalize(hStmtZXY);
-        return false;
+        std::sort(m_aoTempFeatures.begin(), m_aoTempFeatures.end());
+        poMerger = std::make_unique<OGRMVTTempFeatureMerger>(&m_aoTempFeatures);
     }
-    sqlite3_stmt *hStmtRows = nullptr;
-    CPL_IGNORE_RET_VAL(sqlite3_prepare_v2(
-        m_hDB,
-        "SELECT feature FROM temp "
-        "WHERE z = ? AND x = ? AND y = ? AND layer = ? ORDER BY idx",
-        -1, &hStmtRows, nullptr));
-    if (hStmtRows == nullptr)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined, "Prepared statement failed");
-        sqlite3_finalize(hStmtZXY);
-        sqlite3_finalize(hStmtLayer);
-        return false;
+    else
+    {
+        poMerger =
+            std::make_unique<OGRMVTTempFeatureMerger>(m_fpTemp, m_anTempRuns);
     }
 
     sqlite3_stmt *hInsertStmt = nullptr;
@@ -5193,89 +5599,168 @@ bool OGRMVTWriterDataset::CreateOutput()
         if (hInsertStmt == nullptr)
         {
             CPLError(CE_Failure, CPLE_AppDefined, "Prepared statement failed");
-            sqlite3_finalize(hStmtZXY);
-            sqlite3_finalize(hStmtLayer);
-            sqlite3_finalize(hStmtRows);
             return false;
         }
     }
 
+    // Tiles are read by batches, encoded in parallel, and then written in
+    // order. The number of tiles per batch is bounded so that the worker
+    // threads are kept busy while limiting the memory used.
+    const int nThreads = m_bThreadPoolOK ? m_oThreadPool.GetThreadCount() : 1;
+    const size_t nMaxTilesPerBatch = 16 * static_cast<size_t>(nThreads);
+    constexpr size_t MAX_BATCH_MEM_SIZE = 100 * 1024 * 1024;
+
     int nLastZ = -1;
     int nLastX = -1;
     bool bRet = true;
     GIntBig nTempTilesRead = 0;
+    GIntBig nTilesWritten = 0;
+    const GIntBig nProgressStep =
+        std::max(static_cast<GIntBig>(1), m_nTempTiles / 10);
 
-    while (sqlite3_step(hStmtZXY) == SQLITE_ROW)
+    OGRMVTTempFeature oNextFeature;
+    bool bHasNextFeature = poMerger->Next(oNextFeature);
+    while (bRet && bHasNextFeature)
     {
-        int nZ = sqlite3_column_int(hStmtZXY, 0);
-        int nX = sqlite3_column_int(hStmtZXY, 1);
-        int nY = sqlite3_column_int(hStmtZXY, 2);
-
-        std::string oTileBuffer(EncodeTile(nZ, nX, nY, hStmtLayer, hStmtRows,
-                                           oMapLayerProps, oSetLayers,
-                                           nTempTilesRead));
-
-        if (oTileBuffer.empty())
+        std::vector<std::unique_ptr<MVTTileToEncode>> apoTiles;
+        size_t nBatchMemSize = 0;
+        while (bHasNextFeature && apoTiles.size() < nMaxTilesPerBatch &&
+               nBatchMemSize < MAX_BATCH_MEM_SIZE)
+        {
+            auto poTile = std::make_unique<MVTTileToEncode>();
+            poTile->m_poDS = this;
+            poTile->m_nZ = oNextFeature.nZ;
+            poTile->m_nX = oNextFeature.nX;
+            poTile->m_nY = oNextFeature.nY;
+            do
+            {
+                nBatchMemSize += oNextFeature.GetMemorySize();
+                poTile->m_aoFeatures.push_back(std::move(oNextFeature));
+                bHasNextFeature = poMerger->Next(oNextFeature);
+            } while (bHasNextFeature &&
+                     oNextFeature.IsSameTile(poTile->m_aoFeatures.front()));
+            apoTiles.push_back(std::move(poTile));
+        }
+        if (poMerger->HasError())
         {
+            CPLError(CE_Failure, CPLE_FileIO, "Error while reading %s",
+                     m_osTempDB.c_str());
             bRet = false;
+            break;
         }
-        else if (hInsertStmt)
+
+        if (m_bThreadPoolOK && apoTiles.size() > 1)
         {
-            sqlite3_bind_int(hInsertStmt, 1, nZ);
-            sqlite3_bind_int(hInsertStmt, 2, nX);
-            sqlite3_bind_int(hInsertStmt, 3, (1 << nZ) - 1 - nY);
-            sqlite3_bind_blob(hInsertStmt, 4, oTileBuffer.data(),
-                              static_cast<int>(oTileBuffer.size()),
-                              SQLITE_STATIC);
-            const int rc = sqlite3_step(hInsertStmt);
-            bRet = (rc == SQLITE_OK || rc == SQLITE_DONE);
-            sqlite3_reset(hInsertStmt);
+            std::vector<void *> apData;
+            for (auto &poTile : apoTiles)
+                apData.push_back(poTile.get());
+            m_oThreadPool.SubmitJobs(EncodeTileTaskFunc, apData);
+            m_oThreadPool.WaitCompletion();
         }
         else
         {
-            CPLString osZDirname(CPLFormFilename(
-                GetDescription(), CPLSPrintf("%d", nZ), nullptr));
-            CPLString osXDirname(
-                CPLFormFilename(osZDirname, CPLSPrintf("%d", nX), nullptr));
-            if (nZ != nLastZ)
+            for (auto &poTile : apoTiles)
+                EncodeTileTaskFunc(poTile.get());
+        }
+
+        for (auto &poTile : apoTiles)
+        {
+            const int nZ = poTile->m_nZ;
+            const int nX = poTile->m_nX;
+            const int nY = poTile->m_nY;
+
+            const GIntBig nFeatures =
+                static_cast<GIntBig>(poTile->m_aoFeatures.size());
+            if ((nTempTilesRead + nFeatures) / nProgressStep !=
+                    nTempTilesRead / nProgressStep ||
+                nTempTilesRead + nFeatures == m_nTempTiles)
             {
-                VSIMkdir(osZDirname, 0755);
-                nLastZ = nZ;
-                nLastX = -1;
+                const int nPct = static_cast<int>(
+                    (100 * (nTempTilesRead + nFeatures)) / m_nTempTiles);
+                CPLDebug("MVT", "%d%%...", nPct);
             }
-            if (nX != nLastX)
+            nTempTilesRead += nFeatures;
+
+            ApplyLayerPropertiesUpdates(nZ, poTile->m_aoUpdates,
+                                        oMapLayerProps, oSetLayers);
+
+            const std::string &oTileBuffer = poTile->m_osTileBuffer;
+            if (oTileBuffer.empty())
             {
-                VSIMkdir(osXDirname, 0755);
-                nLastX = nX;
+                bRet = false;
             }
-            CPLString osTileFilename(CPLFormFilename(
-                osXDirname, CPLSPrintf("%d", nY), m_osExtension.c_str()));
-            VSILFILE *fpOut = VSIFOpenL(osTileFilename, "wb");
-            if (fpOut)
+            else if (hInsertStmt)
             {
-                const size_t nRet = VSIFWriteL(oTileBuffer.data(), 1,
-                                               oTileBuffer.size(), fpOut);
-                bRet = (nRet == oTileBuffer.size());
-                VSIFCloseL(fpOut);
+                sqlite3_bind_int(hInsertStmt, 1, nZ);
+                sqlite3_bind_int(hInsertStmt, 2, nX);
+                sqlite3_bind_int(hInsertStmt, 3, (1 << nZ) - 1 - nY);
+                sqlite3_bind_blob(hInsertStmt, 4, oTileBuffer.data(),
+                                  static_cast<int>(oTileBuffer.size()),
+                                  SQLITE_STATIC);
+                const int rc = sqlite3_step(hInsertStmt);
+                bRet = (rc == SQLITE_OK || rc == SQLITE_DONE);
+                sqlite3_reset(hInsertStmt);
             }
             else
             {
-                bRet = false;
+                CPLString osZDirname(CPLFormFilename(
+                    GetDescription(), CPLSPrintf("%d", nZ), nullptr));
+                CPLString osXDirname(CPLFormFilename(
+                    osZDirname, CPLSPrintf("%d", nX), nullptr));
+                if (nZ != nLastZ)
+                {
+                    VSIMkdir(osZDirname, 0755);
+                    nLastZ = nZ;
+                    nLastX = -1;
+                }
+                if (nX != nLastX)
+                {
+                    VSIMkdir(osXDirname, 0755);
+                    nLastX = nX;
+                }
+                CPLString osTileFilename(CPLFormFilename(
+                    osXDirname, CPLSPrintf("%d", nY), m_osExtension.c_str()));
+                VSILFILE *fpOut = VSIFOpenL(osTileFilename, "wb");
+                if (fpOut)
+                {
+                    const size_t nRet = VSIFWriteL(oTileBuffer.data(), 1,
+                                                   oTileBuffer.size(), fpOut);
+                    bRet = (nRet == oTileBuffer.size());
+                    VSIFCloseL(fpOut);
+                }
+                else
+                {
+                    bRet = false;
+                }
             }
-        }
 
-        if (!bRet)
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Error while writing tile %d/%d/%d", nZ, nX, nY);
-            break;
+            if (!bRet)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Error while writing tile %d/%d/%d", nZ, nX, nY);
+                break;
+            }
+            ++nTilesWritten;
         }
     }
-    sqlite3_finalize(hStmtZXY);
-    sqlite3_finalize(hStmtLayer);
-    sqlite3_finalize(hStmtRows);
     if (hInsertStmt)
         sqlite3_finalize(hInsertStmt);
+    m_aoTempFeatures.clear();
+
+    const double dfElapsed =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                      tStart)
+            .count();
+    CPLDebug("MVT",
+             CPL_FRMT_GIB " temporary features, %d run(s) and " CPL_FRMT_GUIB
+             " bytes spilled to temporary file. " CPL_FRMT_GIB
+             " tiles written in %.2f s (%.1f tiles/s, %.1f features/s)",
+             m_nTempTiles, static_cast<int>(nRuns), nSpilledBytes,
+             nTilesWritten, dfElapsed,
+             dfElapsed > 0 ? static_cast<double>(nTilesWritten) / dfElapsed
+                           : 0.0,
+             dfElapsed > 0 ? static_cast<double>(nTempTilesRead) / dfElapsed
+                           : 0.0);
 
     bRet &= GenerateMetadata(oSetLayers.size(), oMapLayerProps);
 
@@ -5678,7 +6163,7 @@ OGRErr OGRMVTWriterDataset::WriteFeature(OGRMVTWriterLayer *poLayer,
 
     if (!m_oEnvelope.IsInit())
     {
-        CPLDebug("MVT", "Creating temporary database...");
+        CPLDebug("MVT", "Creating temporary file...");
     }
 
     m_oEnvelope.Merge(sExtent);
@@ -5962,61 +6447,36 @@ GDALDataset *OGRMVTWriterDataset::Create(const char *pszFilename, int nXSize,
     if (!bReuseTempFile)
         VSIUnlink(osTempDB);
 
-    sqlite3 *hDB = nullptr;
-    if (sqlite3_open_v2(osTempDB, &hDB,
-                        SQLITE_OPEN_READWRITE |
-                            (bReuseTempFile ? 0 : SQLITE_OPEN_CREATE) |
-                            SQLITE_OPEN_NOMUTEX,
-                        poDS->m_pMyVFS->zName) != SQLITE_OK ||
-        hDB == nullptr)
+    // Pre-encoded features are accumulated in memory, and spilled as sorted
+    // runs into the temporary file when exceeding that amount.
+    poDS->m_nMaxTempFeaturesMemSize = static_cast<size_t>(
+        std::max(0.0, CPLAtof(CPLGetConfigOption("OGR_MVT_SPILL_BUFFER_SIZE",
+                                                 "256"))) *
+        1024 * 1024);
+    poDS->m_bRemoveTempFile =
+        CPLTestBool(CPLGetConfigOption("OGR_MVT_REMOVE_TEMP_FILE", "YES"));
+
+    poDS->m_fpTemp = VSIFOpenL(osTempDB, bReuseTempFile ? "rb" : "wb+");
+    if (poDS->m_fpTemp == nullptr)
     {
         CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s", osTempDB.c_str());
         delete poDS;
-        sqlite3_close(hDB);
         return nullptr;
     }
     poDS->m_osTempDB = osTempDB;
-    poDS->m_hDB = hDB;
     poDS->m_bReuseTempFile = bReuseTempFile;
 
     // For Unix
-    if (!poDS->m_bReuseTempFile &&
-        CPLTestBool(CPLGetConfigOption("OGR_MVT_REMOVE_TEMP_FILE", "YES")))
+    if (!poDS->m_bReuseTempFile && poDS->m_bRemoveTempFile)
     {
         VSIUnlink(osTempDB);
     }
 
-    if (poDS->m_bReuseTempFile)
-    {
-        poDS->m_nTempTiles =
-            SQLGetInteger64(hDB, "SELECT COUNT(*) FROM temp", nullptr);
-    }
-    else
-    {
-        CPL_IGNORE_RET_VAL(SQLCommand(
-            hDB,
-            "PRAGMA page_size = 4096;"  // 4096: default since sqlite 3.12
-            "PRAGMA synchronous = OFF;"
-            "PRAGMA journal_mode = OFF;"
-            "PRAGMA temp_store = MEMORY;"
-            "CREATE TABLE temp(z INTEGER, x INTEGER, y INTEGER, layer TEXT, "
-            "idx INTEGER, feature BLOB, geomtype INTEGER, area_or_length "
-            "DOUBLE);"
-            "CREATE INDEX temp_index ON temp (z, x, y, layer, idx);"));
-    }
-
-    sqlite3_stmt *hInsertStmt = nullptr;
-    CPL_IGNORE_RET_VAL(sqlite3_prepare_v2(
-        hDB,
-        "INSERT INTO temp (z,x,y,layer,idx,feature,geomtype,area_or_length) "
-        "VALUES (?,?,?,?,?,?,?,?)",
-        -1, &hInsertStmt, nullptr));
-    if (hInsertStmt == nullptr)
+    if (poDS->m_bReuseTempFile && !poDS->ReadTempFileRuns())
     {
         delete poDS;
         return nullptr;
     }
-    poDS->m_hInsertStmt = hInsertStmt;
 
     poDS->m_nMinZoom = atoi(CSLFetchNameValueDef(
         papszOptions, "MINZOOM", CPLSPrintf("%d", poDS->m_nMinZoom)));
@@ -34,10 +34,33 @@
 #include "ogrsf_frmts.h"
 #include "nasreaderp.h"
 #include "ogr_api.h"
+
+#include <deque>
+#include <memory>
+#include <string>
 #include <vector>
 
+class CPLJobQueue;
 class OGRNASDataSource;
 
+/************************************************************************/
+/*                        OGRNASPrefetchedFeature                       */
+/************************************************************************/
+
+// NAS feature read ahead by OGRNASLayer, with its geometries built by a
+// worker thread.
+struct OGRNASPrefetchedFeature
+{
+    GMLFeature *poNASFeature = nullptr;
+    std::vector<std::unique_ptr<OGRGeometry>> apoGeoms{};
+    std::string osErrorMsg{};
+
+    OGRNASPrefetchedFeature() = default;
+    ~OGRNASPrefetchedFeature();
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRNASPrefetchedFeature)
+};
+
 /************************************************************************/
 /*                            OGRNASLayer                               */
 /************************************************************************/
@@ -52,6 +75,16 @@ class OGRNASLayer final : public OGRLayer
 
     GMLFeatureClass *poFClass;
 
+    // Multi-threaded geometry building (NAS_NUM_THREADS)
+    int m_nNumThreads = 0;
+    std::deque<std::unique_ptr<OGRNASPrefetchedFeature>> m_oPrefetchedQueue{};
+    std::unique_ptr<CPLJobQueue> m_poJobQueue{};
+
+    struct BuildGeometryJob;
+    static void BuildGeometryJobFunc(void *pData);
+    int GetNumThreads();
+    bool PrefetchNextBatch();
+
   public:
     OGRNASLayer(const char *pszName, OGRNASDataSource *poDS);
 
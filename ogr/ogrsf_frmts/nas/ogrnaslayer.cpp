@@ -30,8 +30,12 @@
 #include "cpl_conv.h"
 #include "cpl_port.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "ogr_nas.h"
 
+#include <algorithm>
+
 /************************************************************************/
 /*                           OGRNASLayer()                              */
 /************************************************************************/
@@ -59,6 +63,15 @@ OGRNASLayer::~OGRNASLayer()
         poFeatureDefn->Release();
 }
 
+/************************************************************************/
+/*                     ~OGRNASPrefetchedFeature()                       */
+/************************************************************************/
+
+OGRNASPrefetchedFeature::~OGRNASPrefetchedFeature()
+{
+    delete poNASFeature;
+}
+
 /************************************************************************/
 /*                            ResetReading()                            */
 /************************************************************************/
@@ -67,11 +80,137 @@ void OGRNASLayer::ResetReading()
 
 {
     iNextNASId = 0;
+    m_oPrefetchedQueue.clear();
     poDS->GetReader()->ResetReading();
     if (poFClass)
         poDS->GetReader()->SetFilteredClassName(poFClass->GetElementName());
 }
 
+/************************************************************************/
+/*                            GetNumThreads()                           */
+/************************************************************************/
+
+int OGRNASLayer::GetNumThreads()
+{
+    if (m_nNumThreads == 0)
+    {
+        const char *pszNumThreads =
+            CPLGetConfigOption("NAS_NUM_THREADS", "1");
+        if (EQUAL(pszNumThreads, "ALL_CPUS"))
+            m_nNumThreads = CPLGetNumCPUs();
+        else
+            m_nNumThreads = atoi(pszNumThreads);
+        m_nNumThreads = std::max(1, std::min(m_nNumThreads, 128));
+    }
+    return m_nNumThreads;
+}
+
+/************************************************************************/
+/*                          BuildGeometryJob                            */
+/************************************************************************/
+
+struct OGRNASLayer::BuildGeometryJob
+{
+    OGRNASPrefetchedFeature *const *papoFeatures = nullptr;
+    size_t nFeatures = 0;
+    OGRwkbGeometryType eGeomType = wkbUnknown;
+};
+
+// Same geometry building as GetNextFeature(), except that the error of the
+// first geometry that cannot be built is stored in the prefetched feature
+// to be reported by the main thread.
+void OGRNASLayer::BuildGeometryJobFunc(void *pData)
+{
+    const BuildGeometryJob *psJob = static_cast<BuildGeometryJob *>(pData);
+
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    for (size_t i = 0; i < psJob->nFeatures; ++i)
+    {
+        OGRNASPrefetchedFeature *poPrefetched = psJob->papoFeatures[i];
+        const GMLFeature *poNASFeature = poPrefetched->poNASFeature;
+        const CPLXMLNode *const *papsGeometry = poNASFeature->GetGeometryList();
+
+        poPrefetched->apoGeoms.resize(poNASFeature->GetGeometryCount());
+        for (int iGeom = 0; iGeom < poNASFeature->GetGeometryCount(); ++iGeom)
+        {
+            if (papsGeometry[iGeom] == nullptr)
+                continue;
+
+            CPLErrorReset();
+            OGRGeometry *poGeom = OGRGeometry::FromHandle(
+                OGR_G_CreateFromGMLTree(papsGeometry[iGeom]));
+            if (poGeom == nullptr)
+                poPrefetched->osErrorMsg = CPLGetLastErrorMsg();
+            poGeom = NASReader::ConvertGeometry(poGeom);
+            poGeom = OGRGeometryFactory::forceTo(poGeom, psJob->eGeomType);
+            if (poGeom == nullptr)
+                break;
+            poPrefetched->apoGeoms[iGeom].reset(poGeom);
+        }
+    }
+    CPLPopErrorHandler();
+}
+
+/************************************************************************/
+/*                          PrefetchNextBatch()                         */
+/************************************************************************/
+
+// Reads a batch of features in the current thread, builds the geometries
+// of the ones of this layer in worker threads, and appends them, in file
+// order, to m_oPrefetchedQueue.
+// Returns false if no feature could be read.
+bool OGRNASLayer::PrefetchNextBatch()
+{
+    const size_t nBatchSize = static_cast<size_t>(m_nNumThreads) * 256;
+    std::vector<OGRNASPrefetchedFeature *> apoToBuild;
+    size_t nRead = 0;
+    while (nRead < nBatchSize)
+    {
+        GMLFeature *poNASFeature = poDS->GetReader()->NextFeature();
+        if (poNASFeature == nullptr)
+            break;
+        auto poPrefetched = std::make_unique<OGRNASPrefetchedFeature>();
+        poPrefetched->poNASFeature = poNASFeature;
+        if (poNASFeature->GetClass() == poFClass)
+            apoToBuild.push_back(poPrefetched.get());
+        m_oPrefetchedQueue.push_back(std::move(poPrefetched));
+        ++nRead;
+    }
+    if (nRead == 0)
+        return false;
+
+    const size_t nFeatures = apoToBuild.size();
+    const size_t nJobs = std::min(static_cast<size_t>(m_nNumThreads),
+                                  (nFeatures + 63) / 64);
+
+    std::vector<BuildGeometryJob> asJobs(nJobs);
+    for (size_t iJob = 0; iJob < nJobs; ++iJob)
+    {
+        const size_t iStart = iJob * nFeatures / nJobs;
+        asJobs[iJob].papoFeatures = apoToBuild.data() + iStart;
+        asJobs[iJob].nFeatures = (iJob + 1) * nFeatures / nJobs - iStart;
+        asJobs[iJob].eGeomType = GetGeomType();
+    }
+
+    CPLWorkerThreadPool *poPool =
+        nJobs > 1 ? GDALGetGlobalThreadPool(m_nNumThreads) : nullptr;
+    if (poPool && !m_poJobQueue)
+        m_poJobQueue = poPool->CreateJobQueue();
+    for (size_t iJob = 0; iJob < nJobs; ++iJob)
+    {
+        // The last job is run in the current thread
+        if (!m_poJobQueue || iJob + 1 == nJobs ||
+            !m_poJobQueue->SubmitJob(BuildGeometryJobFunc, &asJobs[iJob]))
+        {
+            BuildGeometryJobFunc(&asJobs[iJob]);
+        }
+    }
+    if (m_poJobQueue)
+        m_poJobQueue->WaitCompletion();
+
+    return true;
+}
+
 /************************************************************************/
 /*                           GetNextFeature()                           */
 /************************************************************************/
@@ -96,9 +235,22 @@ OGRFeature *OGRNASLayer::GetNextFeature()
         /* --------------------------------------------------------------------
          */
         delete poNASFeature;
-        poNASFeature = poDS->GetReader()->NextFeature();
-        if (poNASFeature == nullptr)
-            return nullptr;
+        std::unique_ptr<OGRNASPrefetchedFeature> poPrefetched;
+        if (GetNumThreads() > 1)
+        {
+            if (m_oPrefetchedQueue.empty() && !PrefetchNextBatch())
+                return nullptr;
+            poPrefetched = std::move(m_oPrefetchedQueue.front());
+            m_oPrefetchedQueue.pop_front();
+            poNASFeature = poPrefetched->poNASFeature;
+            poPrefetched->poNASFeature = nullptr;
+        }
+        else
+        {
+            poNASFeature = poDS->GetReader()->NextFeature();
+            if (poNASFeature == nullptr)
+                return nullptr;
+        }
 
         /* --------------------------------------------------------------------
          */
@@ -133,6 +285,15 @@ OGRFeature *OGRNASLayer::GetNextFeature()
             {
                 poGeom[iGeom] = nullptr;
             }
+            else if (poPrefetched)
+            {
+                poGeom[iGeom] = poPrefetched->apoGeoms[iGeom].release();
+                if (poGeom[iGeom] == nullptr)
+                {
+                    osLastErrorMsg = poPrefetched->osErrorMsg;
+                    bErrored = true;
+                }
+            }
             else
             {
                 CPLPushErrorHandler(CPLQuietErrorHandler);
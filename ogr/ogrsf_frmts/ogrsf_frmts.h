@@ -57,6 +57,7 @@ class OGRLayerAttrIndex;
 class OGRSFDriver;
 
 struct ArrowArrayStream;
+struct OGRArrowSimpleColumn;
 
 /************************************************************************/
 /*                               OGRLayer                               */
@@ -110,11 +111,20 @@ class CPL_DLL OGRLayer : public GDALMajorObject
                              // filter is active.
 
     int FilterGeometry(OGRGeometry *);
+    int FilterGeometry(OGRGeometry *,
+                       OGRPreparedGeometry *poPreparedFilterGeom);
     // int          FilterGeometry( OGRGeometry *, OGREnvelope*
     // psGeometryEnvelope);
     int InstallFilter(OGRGeometry *);
 
     OGRErr GetExtentInternal(int iGeomField, OGREnvelope *psExtent, int bForce);
+
+    bool InitFeatureBatchColumns(int nColumns,
+                                 OGRFeatureBatchColumn *pasColumns,
+                                 int nMaxFeatures);
+    static bool FillFeatureBatchRow(const OGRFeature *poFeature, int nColumns,
+                                    OGRFeatureBatchColumn *pasColumns,
+                                    int iRow);
     //! @endcond
 
     virtual OGRErr ISetFeature(OGRFeature *poFeature) CPL_WARN_UNUSED_RESULT;
@@ -136,6 +146,13 @@ class CPL_DLL OGRLayer : public GDALMajorObject
         std::vector<GIntBig> m_anQueriedFIDs{};
         size_t m_iQueriedFIDS = 0;
         std::deque<std::unique_ptr<OGRFeature>> m_oFeatureQueue{};
+
+        // Background building of the next batches by the generic
+        // get_next() implementation. See OGR_ARROW_STREAM_PREFETCH_DEPTH.
+        struct PrefetchState;
+        std::shared_ptr<PrefetchState> m_poPrefetch{};
+        bool m_bPrefetchChecked = false;
+        void StopPrefetch();
     };
     std::shared_ptr<ArrowArrayStreamPrivateData>
         m_poSharedArrowArrayStreamPrivateData{};
@@ -146,6 +163,7 @@ class CPL_DLL OGRLayer : public GDALMajorObject
     //! @endcond
 
     friend class OGRArrowArrayHelper;
+    friend class OGRLayerParallelFilter;
     static void ReleaseArray(struct ArrowArray *array);
     static void ReleaseSchema(struct ArrowSchema *schema);
     static void ReleaseStream(struct ArrowArrayStream *stream);
@@ -174,6 +192,11 @@ class CPL_DLL OGRLayer : public GDALMajorObject
     bool CreateFieldFromArrowSchemaInternal(const struct ArrowSchema *schema,
                                             const std::string &osFieldPrefix,
                                             CSLConstList papszOptions);
+    bool
+    GetArrowBatchSimpleColumns(const struct ArrowSchema *schema,
+                               const struct ArrowArray *array,
+                               CSLConstList papszOptions,
+                               std::vector<OGRArrowSimpleColumn> &asColumns);
     //! @endcond
 
   public:
@@ -224,6 +247,9 @@ class CPL_DLL OGRLayer : public GDALMajorObject
     virtual bool WriteArrowBatch(const struct ArrowSchema *schema,
                                  struct ArrowArray *array,
                                  CSLConstList papszOptions = nullptr);
+    virtual int GetNextFeatureBatch(int nColumns,
+                                    OGRFeatureBatchColumn *pasColumns,
+                                    int nMaxFeatures);
 
     OGRErr SetFeature(OGRFeature *poFeature) CPL_WARN_UNUSED_RESULT;
     OGRErr CreateFeature(OGRFeature *poFeature) CPL_WARN_UNUSED_RESULT;
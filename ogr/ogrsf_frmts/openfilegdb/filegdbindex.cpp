@@ -294,6 +294,11 @@ class FileGDBIndexIterator final : public FileGDBIndexIteratorBase
 
     bool bEvaluateToFALSE = false;
 
+    // Optional upper bound (FGSO_LT or FGSO_LE) of a range constraint, whose
+    // lower bound is eOp / sValue. Only for numeric and date/time fields.
+    FileGDBSQLOp m_eUpperOp = FGSO_ISNOTNULL;
+    OGRField m_sUpperValue{};
+
     int iSorted = 0;
     int nSortedCount = -1;
     int *panSortedRows = nullptr;
@@ -313,9 +318,13 @@ class FileGDBIndexIterator final : public FileGDBIndexIteratorBase
     virtual bool FindPages(int iLevel, int nPage) override;
     int GetNextRow();
 
+    bool IsBeyondUpperBound(const GByte *pabyValues, int iValue) const;
+
     FileGDBIndexIterator(FileGDBTable *poParent, int bAscending);
     int SetConstraint(int nFieldIdx, FileGDBSQLOp op,
-                      OGRFieldType eOGRFieldType, const OGRField *psValue);
+                      OGRFieldType eOGRFieldType, const OGRField *psValue,
+                      FileGDBSQLOp eUpperOp = FGSO_ISNOTNULL,
+                      const OGRField *psUpperValue = nullptr);
 
     template <class Getter>
     void GetMinMaxSumCount(double &dfMin, double &dfMax, double &dfSum,
@@ -330,7 +339,9 @@ class FileGDBIndexIterator final : public FileGDBIndexIteratorBase
     static FileGDBIterator *Build(FileGDBTable *poParentIn, int nFieldIdx,
                                   int bAscendingIn, FileGDBSQLOp op,
                                   OGRFieldType eOGRFieldType,
-                                  const OGRField *psValue);
+                                  const OGRField *psValue,
+                                  FileGDBSQLOp eUpperOp = FGSO_ISNOTNULL,
+                                  const OGRField *psUpperValue = nullptr);
 
     virtual int GetNextRowSortedByFID() override;
     virtual int GetRowCount() override;
@@ -407,6 +418,25 @@ FileGDBIterator *FileGDBIterator::Build(FileGDBTable *poParent, int nFieldIdx,
                                        eOGRFieldType, psValue);
 }
 
+/************************************************************************/
+/*                             BuildRange()                             */
+/************************************************************************/
+
+FileGDBIterator *FileGDBIterator::BuildRange(
+    FileGDBTable *poParent, int nFieldIdx, int bAscending,
+    FileGDBSQLOp eLowerOp, const OGRField *psLowerValue, FileGDBSQLOp eUpperOp,
+    const OGRField *psUpperValue, OGRFieldType eOGRFieldType)
+{
+    if ((eLowerOp != FGSO_GE && eLowerOp != FGSO_GT) ||
+        (eUpperOp != FGSO_LE && eUpperOp != FGSO_LT))
+    {
+        return nullptr;
+    }
+    return FileGDBIndexIterator::Build(poParent, nFieldIdx, bAscending,
+                                       eLowerOp, eOGRFieldType, psLowerValue,
+                                       eUpperOp, psUpperValue);
+}
+
 /************************************************************************/
 /*                           BuildIsNotNull()                           */
 /************************************************************************/
@@ -460,6 +490,26 @@ FileGDBIterator *FileGDBIterator::BuildOr(FileGDBIterator *poIter1,
     return new FileGDBOrIterator(poIter1, poIter2, bIteratorAreExclusive);
 }
 
+/************************************************************************/
+/*                               BuildOr()                              */
+/************************************************************************/
+
+FileGDBIterator *
+FileGDBIterator::BuildOr(const std::vector<FileGDBIterator *> &apoIters)
+{
+    // Combine the iterators as a balanced tree, so that the cost of
+    // getting the next row grows as the logarithm of the number of
+    // iterators, instead of linearly with a chain of OR iterators.
+    if (apoIters.empty())
+        return nullptr;
+    if (apoIters.size() == 1)
+        return apoIters[0];
+    const auto iMiddle = apoIters.begin() + apoIters.size() / 2;
+    return BuildOr(
+        BuildOr(std::vector<FileGDBIterator *>(apoIters.begin(), iMiddle)),
+        BuildOr(std::vector<FileGDBIterator *>(iMiddle, apoIters.end())));
+}
+
 /************************************************************************/
 /*                           GetRowCount()                              */
 /************************************************************************/
@@ -869,15 +919,15 @@ FileGDBIndexIterator::~FileGDBIndexIterator()
 /*                             Build()                                  */
 /************************************************************************/
 
-FileGDBIterator *FileGDBIndexIterator::Build(FileGDBTable *poParentIn,
-                                             int nFieldIdx, int bAscendingIn,
-                                             FileGDBSQLOp op,
-                                             OGRFieldType eOGRFieldType,
-                                             const OGRField *psValue)
+FileGDBIterator *FileGDBIndexIterator::Build(
+    FileGDBTable *poParentIn, int nFieldIdx, int bAscendingIn, FileGDBSQLOp op,
+    OGRFieldType eOGRFieldType, const OGRField *psValue, FileGDBSQLOp eUpperOp,
+    const OGRField *psUpperValue)
 {
     FileGDBIndexIterator *poIndexIterator =
         new FileGDBIndexIterator(poParentIn, bAscendingIn);
-    if (poIndexIterator->SetConstraint(nFieldIdx, op, eOGRFieldType, psValue))
+    if (poIndexIterator->SetConstraint(nFieldIdx, op, eOGRFieldType, psValue,
+                                       eUpperOp, psUpperValue))
     {
         return poIndexIterator;
     }
@@ -984,7 +1034,9 @@ int FileGDBIndex::GetMaxWidthInBytes(const FileGDBTable *poTable) const
 
 int FileGDBIndexIterator::SetConstraint(int nFieldIdx, FileGDBSQLOp op,
                                         OGRFieldType eOGRFieldType,
-                                        const OGRField *psValue)
+                                        const OGRField *psValue,
+                                        FileGDBSQLOp eUpperOp,
+                                        const OGRField *psUpperValue)
 {
     const int errorRetValue = FALSE;
     CPLAssert(fpCurIdx == nullptr);
@@ -1145,6 +1197,52 @@ int FileGDBIndexIterator::SetConstraint(int nFieldIdx, FileGDBSQLOp op,
             break;
     }
 
+    if (psUpperValue != nullptr)
+    {
+        // The value of the upper bound is converted the same way as the
+        // lower one, which has been validated above.
+        returnErrorIf(eOp != FGSO_GE && eOp != FGSO_GT);
+        returnErrorIf(eUpperOp != FGSO_LE && eUpperOp != FGSO_LT);
+        switch (eFieldType)
+        {
+            case FGFT_INT16:
+            case FGFT_INT32:
+                m_sUpperValue.Integer = psUpperValue->Integer;
+                break;
+            case FGFT_INT64:
+                m_sUpperValue.Integer64 = psUpperValue->Integer64;
+                break;
+            case FGFT_FLOAT32:
+            case FGFT_FLOAT64:
+                m_sUpperValue.Real = psUpperValue->Real;
+                break;
+            case FGFT_DATETIME:
+            case FGFT_DATE:
+            case FGFT_DATETIME_WITH_OFFSET:
+                if (eOGRFieldType == OFTReal)
+                    m_sUpperValue.Real = psUpperValue->Real;
+                else
+                    m_sUpperValue.Real = FileGDBOGRDateToDoubleDate(
+                        psUpperValue, true,
+                        /* bHighPrecision= */ eFieldType ==
+                                FGFT_DATETIME_WITH_OFFSET ||
+                            poField->IsHighPrecision());
+                break;
+            case FGFT_TIME:
+                if (eOGRFieldType == OFTReal)
+                    m_sUpperValue.Real = psUpperValue->Real;
+                else
+                    m_sUpperValue.Real =
+                        FileGDBOGRTimeToDoubleTime(psUpperValue);
+                break;
+            default:
+                // Strings are padded with spaces in the index, and UUIDs
+                // are not ordered: no range support for them
+                return FALSE;
+        }
+        m_eUpperOp = eUpperOp;
+    }
+
     if (nValueCountInIdx > 0)
     {
         if (nIndexDepth == 1)
@@ -1160,9 +1258,20 @@ int FileGDBIndexIterator::SetConstraint(int nFieldIdx, FileGDBSQLOp op,
     // To avoid 'spamming' on huge raster files
     if (poField->GetName() != "block_key")
     {
-        CPLDebug("OpenFileGDB", "Using index on field %s (%s %s)",
-                 poField->GetName().c_str(), FileGDBSQLOpToStr(eOp),
-                 FileGDBValueToStr(eOGRFieldType, psValue));
+        if (m_eUpperOp != FGSO_ISNOTNULL)
+        {
+            CPLDebug("OpenFileGDB", "Using index on field %s (%s %s AND %s %s)",
+                     poField->GetName().c_str(), FileGDBSQLOpToStr(eOp),
+                     FileGDBValueToStr(eOGRFieldType, psValue),
+                     FileGDBSQLOpToStr(m_eUpperOp),
+                     FileGDBValueToStr(eOGRFieldType, psUpperValue));
+        }
+        else
+        {
+            CPLDebug("OpenFileGDB", "Using index on field %s (%s %s)",
+                     poField->GetName().c_str(), FileGDBSQLOpToStr(eOp),
+                     FileGDBValueToStr(eOGRFieldType, psValue));
+        }
     }
 
     Reset();
@@ -1193,6 +1302,65 @@ static int FileGDBUTF16StrCompare(const GUInt16 *pasFirst,
 
 #define COMPARE(a, b) (((a) < (b)) ? -1 : ((a) == (b)) ? 0 : 1)
 
+/************************************************************************/
+/*                         IsBeyondUpperBound()                         */
+/************************************************************************/
+
+// Returns whether the iValue-th value of the pabyValues array is greater
+// than the upper bound of a range constraint.
+bool FileGDBIndexIterator::IsBeyondUpperBound(const GByte *pabyValues,
+                                              int iValue) const
+{
+    int nComp = 0;
+    switch (eFieldType)
+    {
+        case FGFT_INT16:
+            nComp =
+                COMPARE(m_sUpperValue.Integer, GetInt16(pabyValues, iValue));
+            break;
+
+        case FGFT_INT32:
+            nComp =
+                COMPARE(m_sUpperValue.Integer, GetInt32(pabyValues, iValue));
+            break;
+
+        case FGFT_INT64:
+            nComp =
+                COMPARE(m_sUpperValue.Integer64, GetInt64(pabyValues, iValue));
+            break;
+
+        case FGFT_FLOAT32:
+            nComp =
+                COMPARE(m_sUpperValue.Real, GetFloat32(pabyValues, iValue));
+            break;
+
+        case FGFT_FLOAT64:
+            nComp =
+                COMPARE(m_sUpperValue.Real, GetFloat64(pabyValues, iValue));
+            break;
+
+        case FGFT_DATETIME:
+        case FGFT_DATE:
+        case FGFT_TIME:
+        case FGFT_DATETIME_WITH_OFFSET:
+        {
+            const double dfVal = GetFloat64(pabyValues, iValue);
+            if (m_sUpperValue.Real + 1e-10 < dfVal)
+                nComp = -1;
+            else if (m_sUpperValue.Real - 1e-10 > dfVal)
+                nComp = 1;
+            else
+                nComp = 0;
+            break;
+        }
+
+        default:
+            CPLAssert(false);
+            break;
+    }
+    return m_eUpperOp == FGSO_LT ? nComp <= 0 : nComp < 0;
+}
+
 /************************************************************************/
 /*                             FindPages()                              */
 /************************************************************************/
@@ -1403,7 +1571,7 @@ bool FileGDBIndexIterator::FindPages(int iLevel, int nPage)
                     {
                         iFirstPageIdx[iLevel] = static_cast<int>(i);
                         iLastPageIdx[iLevel] = nSubPagesCount[iLevel];
-                        bStop = TRUE;
+                        bStop = m_eUpperOp == FGSO_ISNOTNULL;
                     }
                 }
                 break;
@@ -1415,7 +1583,7 @@ bool FileGDBIndexIterator::FindPages(int iLevel, int nPage)
                     {
                         iFirstPageIdx[iLevel] = static_cast<int>(i);
                         iLastPageIdx[iLevel] = nSubPagesCount[iLevel];
-                        bStop = TRUE;
+                        bStop = m_eUpperOp == FGSO_ISNOTNULL;
                     }
                 }
                 break;
@@ -1424,6 +1592,17 @@ bool FileGDBIndexIterator::FindPages(int iLevel, int nPage)
                 CPLAssert(false);
                 break;
         }
+
+        // For a range constraint, stop at the first sub-page whose
+        // maximum value is above the upper bound
+        if (!bStop && m_eUpperOp != FGSO_ISNOTNULL &&
+            iFirstPageIdx[iLevel] >= 0 &&
+            IsBeyondUpperBound(abyPage[iLevel] + nOffsetFirstValInPage,
+                               static_cast<int>(i)))
+        {
+            iLastPageIdx[iLevel] = static_cast<int>(i);
+            bStop = TRUE;
+        }
         if (bStop)
             break;
     }
@@ -1752,6 +1931,18 @@ int FileGDBIndexIterator::GetNextRow()
                     CPLAssert(false);
                     break;
             }
+
+            if (bMatch && m_eUpperOp != FGSO_ISNOTNULL &&
+                IsBeyondUpperBound(abyPageFeature + nOffsetFirstValInPage,
+                                   iCurFeatureInPage))
+            {
+                if (bAscending)
+                {
+                    bEOF = true;
+                    return -1;
+                }
+                bMatch = false;
+            }
         }
 
         if (bMatch)
@@ -34,7 +34,13 @@
 #include <cctype>
 #include <cstdint>
 #include <algorithm>
+#include <cstring>
+#include <functional>
 #include <limits>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "cpl_string.h"
 
@@ -432,24 +438,456 @@ void FileGDBTable::ComputeOptimalSpatialIndexGridResolution()
     }
 }
 
+/************************************************************************/
+/*                          IndexValueTraits                            */
+/************************************************************************/
+
+// Fixed-size serialization of indexed values in the temporary files of
+// FileGDBIndexValueSorter. Native byte order is used, as those files are
+// read back by the process that wrote them.
+template <class T> struct IndexValueTraits
+{
+    static constexpr size_t SIZE = sizeof(T);
+
+    static size_t GetHeapSize(const T &)
+    {
+        return 0;
+    }
+
+    static void Serialize(GByte *pabyDest, const T &val)
+    {
+        memcpy(pabyDest, &val, sizeof(T));
+    }
+
+    static void Deserialize(const GByte *pabySrc, T &val)
+    {
+        memcpy(&val, pabySrc, sizeof(T));
+    }
+};
+
+template <> struct IndexValueTraits<std::vector<std::uint16_t>>
+{
+    // Number of characters, followed by the (truncated) characters
+    static constexpr size_t SIZE =
+        sizeof(uint16_t) * (1 + MAX_CAR_COUNT_INDEXED_STR);
+
+    static size_t GetHeapSize(const std::vector<std::uint16_t> &val)
+    {
+        return val.capacity() * sizeof(uint16_t);
+    }
+
+    static void Serialize(GByte *pabyDest,
+                          const std::vector<std::uint16_t> &val)
+    {
+        CPLAssert(val.size() <= static_cast<size_t>(MAX_CAR_COUNT_INDEXED_STR));
+        memset(pabyDest, 0, SIZE);
+        const uint16_t nLen = static_cast<uint16_t>(val.size());
+        memcpy(pabyDest, &nLen, sizeof(nLen));
+        if (nLen)
+            memcpy(pabyDest + sizeof(nLen), val.data(),
+                   nLen * sizeof(uint16_t));
+    }
+
+    static void Deserialize(const GByte *pabySrc,
+                            std::vector<std::uint16_t> &val)
+    {
+        uint16_t nLen = 0;
+        memcpy(&nLen, pabySrc, sizeof(nLen));
+        val.resize(std::min<size_t>(nLen, MAX_CAR_COUNT_INDEXED_STR));
+        if (!val.empty())
+            memcpy(val.data(), pabySrc + sizeof(nLen),
+                   val.size() * sizeof(uint16_t));
+    }
+};
+
+/************************************************************************/
+/*                       FileGDBIndexValueSorter                        */
+/************************************************************************/
+
+// Sorts (value, OID) pairs by ascending value, and for a same value by
+// ascending OID. Pairs are accumulated in memory, and when the memory
+// used exceeds the value of the OPENFILEGDB_INDEX_SORT_BUFFER_SIZE
+// configuration option, they are sorted and appended as a run to a
+// temporary file. Runs are finally merged into another temporary file,
+// from which values are read back when writing the index pages.
+template <class T> class FileGDBIndexValueSorter
+{
+  public:
+    typedef std::pair<T, int> value_type;
+
+  private:
+    typedef IndexValueTraits<T> Traits;
+    static constexpr size_t RECORD_SIZE = Traits::SIZE + sizeof(int);
+    static constexpr size_t IO_BUFFER_SIZE = 1024 * 1024;
+
+    const std::string m_osTmpFilenamePrefix;
+    size_t m_nMaxMemUsage = 0;
+    std::vector<value_type> m_asValues{};
+    size_t m_nMemUsage = 0;
+    size_t m_nCount = 0;
+
+    // Sorted runs: index of first record in m_fpRuns, and count
+    VSILFILE *m_fpRuns = nullptr;
+    std::vector<std::pair<size_t, size_t>> m_anRuns{};
+
+    // Result of the merge of the runs
+    VSILFILE *m_fpSorted = nullptr;
+    mutable std::vector<GByte> m_abyReadBuffer{};
+    mutable size_t m_nReadBufferFirst = 0;
+    mutable size_t m_nReadBufferCount = 0;
+    mutable value_type m_oCurValue{};
+    mutable bool m_bError = false;
+
+    CPL_DISALLOW_COPY_ASSIGN(FileGDBIndexValueSorter)
+
+    static bool Less(const value_type &a, const value_type &b)
+    {
+        return a.first < b.first || (a.first == b.first && a.second < b.second);
+    }
+
+    static void SerializeRecord(GByte *pabyDest, const value_type &oVal)
+    {
+        Traits::Serialize(pabyDest, oVal.first);
+        memcpy(pabyDest + Traits::SIZE, &oVal.second, sizeof(int));
+    }
+
+    static void DeserializeRecord(const GByte *pabySrc, value_type &oVal)
+    {
+        Traits::Deserialize(pabySrc, oVal.first);
+        memcpy(&oVal.second, pabySrc + Traits::SIZE, sizeof(int));
+    }
+
+    std::string GetRunsFilename() const
+    {
+        return m_osTmpFilenamePrefix + ".runs.tmp";
+    }
+
+    std::string GetSortedFilename() const
+    {
+        return m_osTmpFilenamePrefix + ".sorted.tmp";
+    }
+
+    bool FlushRun();
+    bool MergeRuns();
+
+  public:
+    explicit FileGDBIndexValueSorter(const std::string &osTmpFilenamePrefix)
+        : m_osTmpFilenamePrefix(osTmpFilenamePrefix)
+    {
+        const double dfMaxMemUsage =
+            std::max(0.0, CPLAtof(CPLGetConfigOption(
+                              "OPENFILEGDB_INDEX_SORT_BUFFER_SIZE", "256"))) *
+            1024 * 1024;
+        m_nMaxMemUsage = static_cast<size_t>(std::min(
+            dfMaxMemUsage,
+            static_cast<double>(std::numeric_limits<size_t>::max() / 2)));
+    }
+
+    ~FileGDBIndexValueSorter();
+
+    void Add(T value, int nOID)
+    {
+        m_nMemUsage += sizeof(value_type) + Traits::GetHeapSize(value);
+        m_asValues.emplace_back(std::move(value), nOID);
+        ++m_nCount;
+        if (m_nMemUsage > m_nMaxMemUsage && !FlushRun())
+            m_bError = true;
+    }
+
+    // Must be called once all values have been added
+    bool Sort();
+
+    size_t size() const
+    {
+        return m_nCount;
+    }
+
+    bool empty() const
+    {
+        return m_nCount == 0;
+    }
+
+    const value_type &operator[](size_t i) const;
+
+    const value_type &back() const
+    {
+        return (*this)[m_nCount - 1];
+    }
+
+    bool HasError() const
+    {
+        return m_bError;
+    }
+};
+
+/************************************************************************/
+/*                     ~FileGDBIndexValueSorter()                       */
+/************************************************************************/
+
+template <class T> FileGDBIndexValueSorter<T>::~FileGDBIndexValueSorter()
+{
+    if (m_fpRuns)
+    {
+        VSIFCloseL(m_fpRuns);
+        VSIUnlink(GetRunsFilename().c_str());
+    }
+    if (m_fpSorted)
+    {
+        VSIFCloseL(m_fpSorted);
+        VSIUnlink(GetSortedFilename().c_str());
+    }
+}
+
+/************************************************************************/
+/*                              FlushRun()                              */
+/************************************************************************/
+
+template <class T> bool FileGDBIndexValueSorter<T>::FlushRun()
+{
+    if (m_asValues.empty())
+        return true;
+    if (m_fpRuns == nullptr)
+    {
+        m_fpRuns = VSIFOpenL(GetRunsFilename().c_str(), "wb+");
+        if (m_fpRuns == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s",
+                     GetRunsFilename().c_str());
+            return false;
+        }
+    }
+
+    std::sort(m_asValues.begin(), m_asValues.end(), Less);
+
+    const size_t nFirst =
+        m_anRuns.empty() ? 0 : m_anRuns.back().first + m_anRuns.back().second;
+    m_anRuns.emplace_back(nFirst, m_asValues.size());
+
+    std::vector<GByte> abyBuffer;
+    abyBuffer.reserve(IO_BUFFER_SIZE + RECORD_SIZE);
+    bool bRet = true;
+    for (const auto &oVal : m_asValues)
+    {
+        const size_t nPos = abyBuffer.size();
+        abyBuffer.resize(nPos + RECORD_SIZE);
+        SerializeRecord(abyBuffer.data() + nPos, oVal);
+        if (abyBuffer.size() >= IO_BUFFER_SIZE)
+        {
+            bRet &= VSIFWriteL(abyBuffer.data(), abyBuffer.size(), 1,
+                               m_fpRuns) == 1;
+            abyBuffer.clear();
+        }
+    }
+    if (!abyBuffer.empty())
+        bRet &=
+            VSIFWriteL(abyBuffer.data(), abyBuffer.size(), 1, m_fpRuns) == 1;
+
+    m_asValues.clear();
+    m_nMemUsage = 0;
+    return bRet;
+}
+
+/************************************************************************/
+/*                             MergeRuns()                              */
+/************************************************************************/
+
+template <class T> bool FileGDBIndexValueSorter<T>::MergeRuns()
+{
+    m_fpSorted = VSIFOpenL(GetSortedFilename().c_str(), "wb+");
+    if (m_fpSorted == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s",
+                 GetSortedFilename().c_str());
+        return false;
+    }
+
+    // Per-run read buffers, whose total size is bounded by the memory limit
+    const size_t nRecordsPerRead = std::max<size_t>(
+        1, std::min(IO_BUFFER_SIZE, m_nMaxMemUsage / m_anRuns.size()) /
+               RECORD_SIZE);
+
+    struct RunReader
+    {
+        size_t nNext = 0;  // index in m_fpRuns of next record to read
+        size_t nRemaining = 0;
+        std::vector<GByte> abyBuffer{};
+        size_t nBufferCount = 0;
+        size_t nBufferPos = 0;
+    };
+
+    std::vector<RunReader> aoReaders(m_anRuns.size());
+    bool bRet = true;
+    const auto ReadNext = [this, nRecordsPerRead, &aoReaders,
+                           &bRet](size_t iRun, value_type &oVal)
+    {
+        auto &oReader = aoReaders[iRun];
+        if (oReader.nBufferPos == oReader.nBufferCount)
+        {
+            if (oReader.nRemaining == 0)
+                return false;
+            const size_t nToRead =
+                std::min(nRecordsPerRead, oReader.nRemaining);
+            oReader.abyBuffer.resize(nToRead * RECORD_SIZE);
+            if (VSIFSeekL(m_fpRuns,
+                          static_cast<vsi_l_offset>(oReader.nNext) *
+                              RECORD_SIZE,
+                          SEEK_SET) != 0 ||
+                VSIFReadL(oReader.abyBuffer.data(), RECORD_SIZE, nToRead,
+                          m_fpRuns) != nToRead)
+            {
+                bRet = false;
+                return false;
+            }
+            oReader.nNext += nToRead;
+            oReader.nRemaining -= nToRead;
+            oReader.nBufferCount = nToRead;
+            oReader.nBufferPos = 0;
+        }
+        DeserializeRecord(oReader.abyBuffer.data() +
+                              oReader.nBufferPos * RECORD_SIZE,
+                          oVal);
+        ++oReader.nBufferPos;
+        return true;
+    };
+
+    typedef std::pair<value_type, size_t> HeapItem;
+    const auto HeapGreater = [](const HeapItem &a, const HeapItem &b)
+    { return Less(b.first, a.first); };
+    std::priority_queue<HeapItem, std::vector<HeapItem>, decltype(HeapGreater)>
+        oHeap(HeapGreater);
+
+    for (size_t iRun = 0; iRun < m_anRuns.size(); ++iRun)
+    {
+        aoReaders[iRun].nNext = m_anRuns[iRun].first;
+        aoReaders[iRun].nRemaining = m_anRuns[iRun].second;
+        value_type oVal;
+        if (ReadNext(iRun, oVal))
+            oHeap.emplace(std::move(oVal), iRun);
+    }
+
+    std::vector<GByte> abyBuffer;
+    abyBuffer.reserve(IO_BUFFER_SIZE + RECORD_SIZE);
+    while (bRet && !oHeap.empty())
+    {
+        const size_t iRun = oHeap.top().second;
+        const size_t nPos = abyBuffer.size();
+        abyBuffer.resize(nPos + RECORD_SIZE);
+        SerializeRecord(abyBuffer.data() + nPos, oHeap.top().first);
+        oHeap.pop();
+        if (abyBuffer.size() >= IO_BUFFER_SIZE)
+        {
+            bRet &= VSIFWriteL(abyBuffer.data(), abyBuffer.size(), 1,
+                               m_fpSorted) == 1;
+            abyBuffer.clear();
+        }
+
+        value_type oVal;
+        if (ReadNext(iRun, oVal))
+            oHeap.emplace(std::move(oVal), iRun);
+    }
+    if (bRet && !abyBuffer.empty())
+        bRet &=
+            VSIFWriteL(abyBuffer.data(), abyBuffer.size(), 1, m_fpSorted) == 1;
+
+    VSIFCloseL(m_fpRuns);
+    m_fpRuns = nullptr;
+    VSIUnlink(GetRunsFilename().c_str());
+
+    return bRet;
+}
+
+/************************************************************************/
+/*                                Sort()                                */
+/************************************************************************/
+
+template <class T> bool FileGDBIndexValueSorter<T>::Sort()
+{
+    if (m_bError)
+        return false;
+    if (m_anRuns.empty())
+    {
+        std::sort(m_asValues.begin(), m_asValues.end(), Less);
+        return true;
+    }
+
+    if (!FlushRun())
+    {
+        m_bError = true;
+        return false;
+    }
+    m_asValues.clear();
+    m_asValues.shrink_to_fit();
+
+    CPLDebug("OpenFileGDB", "Merging %d sorted runs of %s",
+             static_cast<int>(m_anRuns.size()),
+             m_osTmpFilenamePrefix.c_str());
+    if (!MergeRuns())
+    {
+        CPLError(CE_Failure, CPLE_FileIO,
+                 "Error while merging sorted runs of %s",
+                 m_osTmpFilenamePrefix.c_str());
+        m_bError = true;
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                             operator[]                               */
+/************************************************************************/
+
+template <class T>
+const typename FileGDBIndexValueSorter<T>::value_type &
+FileGDBIndexValueSorter<T>::operator[](size_t i) const
+{
+    if (m_fpSorted == nullptr)
+        return m_asValues[i];
+
+    if (i < m_nReadBufferFirst || i >= m_nReadBufferFirst + m_nReadBufferCount)
+    {
+        const size_t nToRead =
+            std::min(IO_BUFFER_SIZE / RECORD_SIZE, m_nCount - i);
+        m_abyReadBuffer.resize(nToRead * RECORD_SIZE);
+        m_nReadBufferFirst = i;
+        m_nReadBufferCount = 0;
+        if (VSIFSeekL(m_fpSorted, static_cast<vsi_l_offset>(i) * RECORD_SIZE,
+                      SEEK_SET) != 0 ||
+            VSIFReadL(m_abyReadBuffer.data(), RECORD_SIZE, nToRead,
+                      m_fpSorted) != nToRead)
+        {
+            m_bError = true;
+            m_oCurValue = value_type();
+            return m_oCurValue;
+        }
+        m_nReadBufferCount = nToRead;
+    }
+    DeserializeRecord(m_abyReadBuffer.data() +
+                          (i - m_nReadBufferFirst) * RECORD_SIZE,
+                      m_oCurValue);
+    return m_oCurValue;
+}
+
 /************************************************************************/
 /*                           WriteIndex()                               */
 /************************************************************************/
 
-template <class ValueOIDPair>
-static bool WriteIndex(
-    VSILFILE *fp, std::vector<ValueOIDPair> &asValues,
-    void (*writeValueFunc)(std::vector<GByte> &abyPage,
-                           const typename ValueOIDPair::first_type &value,
-                           int maxStrSize),
-    int &nDepth, int maxStrSize = 0)
+// asValues must be sorted by ascending values, and for same value by
+// ascending OID
+template <class Container>
+static bool
+WriteIndex(VSILFILE *fp, const Container &asValues,
+           void (*writeValueFunc)(
+               std::vector<GByte> &abyPage,
+               const typename Container::value_type::first_type &value,
+               int maxStrSize),
+           int &nDepth, int maxStrSize = 0)
 {
     constexpr int IDX_PAGE_SIZE = 4096;
     constexpr int HEADER_SIZE_PAGE_REFERENCING_FEATURES = 12;  // 3 * int32
     constexpr int SIZEOF_FEATURE_ID = 4;                       // sizeof(int)
     const int SIZEOF_INDEXED_VALUE =
         maxStrSize ? sizeof(uint16_t) * maxStrSize
-                   : sizeof(typename ValueOIDPair::first_type);
+                   : sizeof(typename Container::value_type::first_type);
     const int NUM_MAX_FEATURES_PER_PAGE =
         (IDX_PAGE_SIZE - HEADER_SIZE_PAGE_REFERENCING_FEATURES) /
         (SIZEOF_FEATURE_ID + SIZEOF_INDEXED_VALUE);
@@ -472,6 +910,9 @@ static bool WriteIndex(
         return nVal;
     }();
 
+    if (asValues.HasError())
+        return false;
+
     if (asValues.size() > static_cast<size_t>(INT_MAX) ||
         // Maximum number of values for depth == 4: this evaluates to ~ 13
         // billion values (~ features)
@@ -487,13 +928,6 @@ static bool WriteIndex(
         return false;
     }
 
-    // Sort by ascending values, and for same value by ascending OID
-    std::sort(asValues.begin(), asValues.end(),
-              [](const ValueOIDPair &a, const ValueOIDPair &b) {
-                  return a.first < b.first ||
-                         (a.first == b.first && a.second < b.second);
-              });
-
     bool bRet = true;
     std::vector<GByte> abyPage;
     abyPage.reserve(IDX_PAGE_SIZE);
@@ -658,15 +1092,15 @@ static bool WriteIndex(
         WriteUInt32(abyPage, 0);  // unknown semantics
 
         // Write features' ID
-        for (const auto &pair : asValues)
-            WriteUInt32(abyPage, static_cast<uint32_t>(pair.second));
+        for (size_t i = 0; i < asValues.size(); ++i)
+            WriteUInt32(abyPage, static_cast<uint32_t>(asValues[i].second));
 
         // Add padding
         abyPage.resize(OFFSET_FIRST_VAL_IN_PAGE);
 
         // Write features' spatial index value
-        for (const auto &pair : asValues)
-            writeValueFunc(abyPage, pair.first, maxStrSize);
+        for (size_t i = 0; i < asValues.size(); ++i)
+            writeValueFunc(abyPage, asValues[i].first, maxStrSize);
 
         abyPage.resize(IDX_PAGE_SIZE);
         bRet &= VSIFWriteL(abyPage.data(), abyPage.size(), 1, fp) == 1;
@@ -802,7 +1236,7 @@ static bool WriteIndex(
     WriteUInt32(abyTrailer, 1);  // unknown semantics
     bRet &= VSIFWriteL(abyTrailer.data(), abyTrailer.size(), 1, fp) == 1;
 
-    return bRet;
+    return bRet && !asValues.HasError();
 }
 
 /************************************************************************/
@@ -847,8 +1281,10 @@ bool FileGDBTable::CreateSpatialIndex()
     }
     auto poGeomConverter = std::unique_ptr<FileGDBOGRGeometryConverter>(
         FileGDBOGRGeometryConverter::BuildConverter(poGeomField));
+    const std::string osSPXFilename(
+        CPLResetExtension(m_osFilename.c_str(), "spx"));
     typedef std::pair<int64_t, int> ValueOIDPair;
-    std::vector<ValueOIDPair> asValues;
+    FileGDBIndexValueSorter<ValueOIDPair::first_type> asValues(osSPXFilename);
 
     const double dfGridStep = m_adfSpatialIndexGridResolution.back();
     const double dfShift =
@@ -1270,8 +1706,7 @@ bool FileGDBTable::CreateSpatialIndex()
                     {
                         if (nVal != nLastVal)
                         {
-                            asValues.push_back(
-                                ValueOIDPair(nVal, iCurFeat + 1));
+                            asValues.Add(nVal, iCurFeat + 1);
                             nLastVal = nVal;
                         }
                     }
@@ -1285,8 +1720,6 @@ bool FileGDBTable::CreateSpatialIndex()
         return false;
     }
 
-    const std::string osSPXFilename(
-        CPLResetExtension(m_osFilename.c_str(), "spx"));
     VSILFILE *fp = VSIFOpenL(osSPXFilename.c_str(), "wb");
     if (fp == nullptr)
         return false;
@@ -1299,7 +1732,8 @@ bool FileGDBTable::CreateSpatialIndex()
             const typename ValueOIDPair::first_type &nval, int /* maxStrSize */)
     { WriteUInt64(abyPage, static_cast<uint64_t>(nval)); };
 
-    bool bRet = WriteIndex(fp, asValues, writeValueFunc, nDepth);
+    bool bRet =
+        asValues.Sort() && WriteIndex(fp, asValues, writeValueFunc, nDepth);
 
     CPLDebug("OpenFileGDB", "Spatial index of depth %d", nDepth);
 
@@ -1344,7 +1778,8 @@ bool FileGDBTable::CreateAttributeIndex(const FileGDBIndex *poIndex)
         if (eFieldType == FGFT_INT16)
         {
             typedef std::pair<int16_t, int> ValueOIDPair;
-            std::vector<ValueOIDPair> asValues;
+            FileGDBIndexValueSorter<ValueOIDPair::first_type> asValues(
+                osIdxFilename);
             for (int iCurFeat = 0; iCurFeat < m_nTotalRecordCount; ++iCurFeat)
             {
                 iCurFeat = GetAndSelectNextNonEmptyRow(iCurFeat);
@@ -1353,8 +1788,8 @@ bool FileGDBTable::CreateAttributeIndex(const FileGDBIndex *poIndex)
                 const OGRField *psField = GetFieldValue(iField);
                 if (psField != nullptr)
                 {
-                    asValues.push_back(ValueOIDPair(
-                        static_cast<int16_t>(psField->Integer), iCurFeat + 1));
+                    asValues.Add(static_cast<int16_t>(psField->Integer),
+                                 iCurFeat + 1);
                 }
             }
 
@@ -1364,12 +1799,14 @@ bool FileGDBTable::CreateAttributeIndex(const FileGDBIndex *poIndex)
                     int /* maxStrSize */)
             { WriteUInt16(abyPage, static_cast<uint16_t>(val)); };
 
-            bRet = WriteIndex(fp, asValues, writeValueFunc, nDepth);
+            bRet = asValues.Sort() &&
+                   WriteIndex(fp, asValues, writeValueFunc, nDepth);
         }
         else if (eFieldType == FGFT_INT32)
         {
             typedef std::pair<int32_t, int> ValueOIDPair;
-            std::vector<ValueOIDPair> asValues;
+            FileGDBIndexValueSorter<ValueOIDPair::first_type> asValues(
+                osIdxFilename);
             for (int iCurFeat = 0; iCurFeat < m_nTotalRecordCount; ++iCurFeat)
             {
                 iCurFeat = GetAndSelectNextNonEmptyRow(iCurFeat);
@@ -1378,8 +1815,7 @@ bool FileGDBTable::CreateAttributeIndex(const FileGDBIndex *poIndex)
                 const OGRField *psField = GetFieldValue(iField);
                 if (psField != nullptr)
                 {
-                    asValues.push_back(
-                        ValueOIDPair(psField->Integer, iCurFeat + 1));
+                    asValues.Add(psField->Integer, iCurFeat + 1);
                 }
             }
 
@@ -1389,12 +1825,14 @@ bool FileGDBTable::CreateAttributeIndex(const FileGDBIndex *poIndex)
                     int /* maxStrSize */)
             { WriteUInt32(abyPage, static_cast<uint32_t>(val)); };
 
-            bRet = WriteIndex(fp, asValues, writeValueFunc, nDepth);
+            bRet = asValues.Sort() &&
+                   WriteIndex(fp, asValues, writeValueFunc, nDepth);
         }
         else if (eFieldType == FGFT_INT64)
         {
             typedef std::pair<int64_t, int> ValueOIDPair;
-            std::vector<ValueOIDPair> asValues;
+            FileGDBIndexValueSorter<ValueOIDPair::first_type> asValues(
+                osIdxFilename);
             for (int iCurFeat = 0; iCurFeat < m_nTotalRecordCount; ++iCurFeat)
             {
                 iCurFeat = GetAndSelectNextNonEmptyRow(iCurFeat);
@@ -1403,8 +1841,7 @@ bool FileGDBTable::CreateAttributeIndex(const FileGDBIndex *poIndex)
                 const OGRField *psField = GetFieldValue(iField);
                 if (psField != nullptr)
                 {
-                    asValues.push_back(
-                        ValueOIDPair(psField->Integer64, iCurFeat + 1));
+                    asValues.Add(psField->Integer64, iCurFeat + 1);
                 }
             }
 
@@ -1414,12 +1851,14 @@ bool FileGDBTable::CreateAttributeIndex(const FileGDBIndex *poIndex)
                     int /* maxStrSize */)
             { WriteUInt64(abyPage, static_cast<uint64_t>(val)); };
 
-            bRet = WriteIndex(fp, asValues, writeValueFunc, nDepth);
+            bRet = asValues.Sort() &&
+                   WriteIndex(fp, asValues, writeValueFunc, nDepth);
         }
         else if (eFieldType == FGFT_FLOAT32)
         {
             typedef std::pair<float, int> ValueOIDPair;
-            std::vector<ValueOIDPair> asValues;
+            FileGDBIndexValueSorter<ValueOIDPair::first_type> asValues(
+                osIdxFilename);
             for (int iCurFeat = 0; iCurFeat < m_nTotalRecordCount; ++iCurFeat)
             {
                 iCurFeat = GetAndSelectNextNonEmptyRow(iCurFeat);
@@ -1428,8 +1867,8 @@ bool FileGDBTable::CreateAttributeIndex(const FileGDBIndex *poIndex)
                 const OGRField *psField = GetFieldValue(iField);
                 if (psField != nullptr)
                 {
-                    asValues.push_back(ValueOIDPair(
-                        static_cast<float>(psField->Real), iCurFeat + 1));
+                    asValues.Add(static_cast<float>(psField->Real),
+                                 iCurFeat + 1);
                 }
             }
 
@@ -1438,14 +1877,16 @@ bool FileGDBTable::CreateAttributeIndex(const FileGDBIndex *poIndex)
                     const typename ValueOIDPair::first_type &val,
                     int /* maxStrSize */) { WriteFloat32(abyPage, val); };
 
-            bRet = WriteIndex(fp, asValues, writeValueFunc, nDepth);
+            bRet = asValues.Sort() &&
+                   WriteIndex(fp, asValues, writeValueFunc, nDepth);
         }
         else if (eFieldType == FGFT_FLOAT64 || eFieldType == FGFT_DATETIME ||
                  eFieldType == FGFT_DATE || eFieldType == FGFT_TIME ||
                  eFieldType == FGFT_DATETIME_WITH_OFFSET)
         {
             typedef std::pair<double, int> ValueOIDPair;
-            std::vector<ValueOIDPair> asValues;
+            FileGDBIndexValueSorter<ValueOIDPair::first_type> asValues(
+                osIdxFilename);
             // Hack to force reading DateTime as double
             m_apoFields[iField]->m_bReadAsDouble = true;
             for (int iCurFeat = 0; iCurFeat < m_nTotalRecordCount; ++iCurFeat)
@@ -1456,8 +1897,7 @@ bool FileGDBTable::CreateAttributeIndex(const FileGDBIndex *poIndex)
                 const OGRField *psField = GetFieldValue(iField);
                 if (psField != nullptr)
                 {
-                    asValues.push_back(
-                        ValueOIDPair(psField->Real, iCurFeat + 1));
+                    asValues.Add(psField->Real, iCurFeat + 1);
                 }
             }
             m_apoFields[iField]->m_bReadAsDouble = false;
@@ -1467,12 +1907,14 @@ bool FileGDBTable::CreateAttributeIndex(const FileGDBIndex *poIndex)
                     const typename ValueOIDPair::first_type &val,
                     int /* maxStrSize */) { WriteFloat64(abyPage, val); };
 
-            bRet = WriteIndex(fp, asValues, writeValueFunc, nDepth);
+            bRet = asValues.Sort() &&
+                   WriteIndex(fp, asValues, writeValueFunc, nDepth);
         }
         else if (eFieldType == FGFT_STRING)
         {
             typedef std::pair<std::vector<std::uint16_t>, int> ValueOIDPair;
-            std::vector<ValueOIDPair> asValues;
+            FileGDBIndexValueSorter<ValueOIDPair::first_type> asValues(
+                osIdxFilename);
             bRet = true;
             const bool bIsLower =
                 STARTS_WITH_CI(poIndex->GetExpression().c_str(), "LOWER(");
@@ -1513,7 +1955,7 @@ bool FileGDBTable::CreateAttributeIndex(const FileGDBIndex *poIndex)
                     }
                     CPLFree(pWide);
 
-                    asValues.push_back(ValueOIDPair(asUTF16Str, iCurFeat + 1));
+                    asValues.Add(std::move(asUTF16Str), iCurFeat + 1);
                 }
             }
             if (maxStrSize < MAX_CAR_COUNT_INDEXED_STR)
@@ -1533,7 +1975,8 @@ bool FileGDBTable::CreateAttributeIndex(const FileGDBIndex *poIndex)
 
             if (bRet)
             {
-                bRet = WriteIndex(fp, asValues, writeValueFunc, nDepth,
+                bRet = asValues.Sort() &&
+                       WriteIndex(fp, asValues, writeValueFunc, nDepth,
                                   maxStrSize);
             }
         }
@@ -737,6 +737,14 @@ class FileGDBIterator
                                   int bAscending, FileGDBSQLOp op,
                                   OGRFieldType eOGRFieldType,
                                   const OGRField *psValue);
+    /* Iterator on the rows whose value is within a range. eLowerOp must be
+     * FGSO_GE or FGSO_GT, and eUpperOp FGSO_LE or FGSO_LT. Only supported
+     * on numeric and date/time fields */
+    static FileGDBIterator *
+    BuildRange(FileGDBTable *poParent, int nFieldIdx, int bAscending,
+               FileGDBSQLOp eLowerOp, const OGRField *psLowerValue,
+               FileGDBSQLOp eUpperOp, const OGRField *psUpperValue,
+               OGRFieldType eOGRFieldType);
     static FileGDBIterator *BuildIsNotNull(FileGDBTable *poParent,
                                            int nFieldIdx, int bAscending);
     static FileGDBIterator *BuildNot(FileGDBIterator *poIterBase);
@@ -746,6 +754,9 @@ class FileGDBIterator
     static FileGDBIterator *BuildOr(FileGDBIterator *poIter1,
                                     FileGDBIterator *poIter2,
                                     int bIteratorAreExclusive = FALSE);
+    /* Takes ownership of the iterators */
+    static FileGDBIterator *
+    BuildOr(const std::vector<FileGDBIterator *> &apoIters);
 };
 
 /************************************************************************/
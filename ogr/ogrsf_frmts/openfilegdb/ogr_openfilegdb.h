@@ -33,12 +33,14 @@
 #include "ogrsf_frmts.h"
 #include "filegdbtable.h"
 #include "ogr_swq.h"
+#include "cpl_error_internal.h"
 #include "cpl_mem_cache.h"
 #include "cpl_quad_tree.h"
 
 #include "gdal_rat.h"
 
 #include <array>
+#include <memory>
 #include <vector>
 #include <map>
 
@@ -149,11 +151,38 @@ class OGROpenFileGDBLayer final : public OGRLayer
 
     std::unique_ptr<FileGDBOGRGeometryConverter> m_poGeomConverter{};
 
+    static OGRGeometry *
+    ConvertGeometry(FileGDBOGRGeometryConverter *poConverter,
+                    const OGRField *psField, const OGRSpatialReference *poSRS);
+
+    // Read-ahead of the sequential scan: rows are read in the calling
+    // thread, and their geometry blobs are decoded by worker threads
+    struct PrefetchedFeature
+    {
+        std::unique_ptr<OGRFeature> poFeature{};
+        bool bHasGeomBlob = false;
+        std::vector<GByte> abyGeomBlob{};
+        std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+    };
+
+    std::vector<PrefetchedFeature> m_asPrefetchedFeatures{};
+    size_t m_iNextPrefetchedFeature = 0;
+    // Set during PrefetchFeatures() so that GetCurrentFeature() copies the
+    // geometry blob instead of decoding it
+    PrefetchedFeature *m_psDeferredGeometry = nullptr;
+    int m_nNumThreads = 0;
+
+    int GetNumThreads();
+    bool CanPrefetchFeatures();
+    void ClearPrefetchedFeatures();
+    bool PrefetchFeatures();
+
     int m_iFieldToReadAsBinary = -1;
 
     FileGDBIterator *m_poAttributeIterator = nullptr;
     int m_bIteratorSufficientToEvaluateFilter = FALSE;
     FileGDBIterator *BuildIteratorFromExprNode(swq_expr_node *poNode);
+    FileGDBIterator *BuildRangeIteratorFromExprNode(swq_expr_node *poNode);
 
     FileGDBIterator *m_poIterMinMax = nullptr;
 
@@ -37,13 +37,18 @@
 #include <cwchar>
 #include <algorithm>
 #include <limits>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_minixml.h"
 #include "cpl_quad_tree.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -110,6 +115,8 @@ OGROpenFileGDBLayer::OGROpenFileGDBLayer(OGROpenFileGDBDataSource *poDS,
 
 OGROpenFileGDBLayer::~OGROpenFileGDBLayer()
 {
+    ClearPrefetchedFeatures();
+
     OGROpenFileGDBLayer::SyncToDisk();
 
     if (m_poFeatureDefn)
@@ -135,6 +142,7 @@ OGROpenFileGDBLayer::~OGROpenFileGDBLayer()
 
 void OGROpenFileGDBLayer::Close()
 {
+    ClearPrefetchedFeatures();
     delete m_poLyrTable;
     m_poLyrTable = nullptr;
     m_bValidLayerDefn = FALSE;
@@ -904,6 +912,7 @@ void OGROpenFileGDBLayer::ResetReading()
     }
     m_bEOF = FALSE;
     m_iCurFeat = 0;
+    ClearPrefetchedFeatures();
     if (m_poAttributeIterator)
         m_poAttributeIterator->Reset();
     if (m_poSpatialIndexIterator)
@@ -1253,6 +1262,103 @@ static swq_expr_node *GetConstantSubNode(swq_expr_node *poNode)
     }
     return nullptr;
 }
+
+/***********************************************************************/
+/*                          GetRangeBoundOp()                          */
+/***********************************************************************/
+
+/* Returns the operator of a "column op constant" or "constant op column" */
+/* comparison, expressed as if the column was on the left side. */
+static bool GetRangeBoundOp(const swq_expr_node *poNode,
+                            const swq_expr_node *poColumn, FileGDBSQLOp &eOp)
+{
+    const bool bColumnFirst = poColumn == poNode->papoSubExpr[0];
+    switch (poNode->nOperation)
+    {
+        case SWQ_LT:
+            eOp = bColumnFirst ? FGSO_LT : FGSO_GT;
+            return true;
+        case SWQ_LE:
+            eOp = bColumnFirst ? FGSO_LE : FGSO_GE;
+            return true;
+        case SWQ_GT:
+            eOp = bColumnFirst ? FGSO_GT : FGSO_LT;
+            return true;
+        case SWQ_GE:
+            eOp = bColumnFirst ? FGSO_GE : FGSO_LE;
+            return true;
+        default:
+            break;
+    }
+    return false;
+}
+
+/***********************************************************************/
+/*                   BuildRangeIteratorFromExprNode()                  */
+/***********************************************************************/
+
+/* Builds a single iterator for "col >(=) val1 AND col <(=) val2", that   */
+/* browses only the part of the index between the 2 bounds, instead of    */
+/* the AND of 2 iterators each browsing one half of the index.            */
+FileGDBIterator *
+OGROpenFileGDBLayer::BuildRangeIteratorFromExprNode(swq_expr_node *poNode)
+{
+    swq_expr_node *poNode1 = poNode->papoSubExpr[0];
+    swq_expr_node *poNode2 = poNode->papoSubExpr[1];
+    if (poNode1->eNodeType != SNT_OPERATION ||
+        poNode2->eNodeType != SNT_OPERATION ||
+        poNode1->nSubExprCount != 2 || poNode2->nSubExprCount != 2)
+        return nullptr;
+
+    swq_expr_node *poColumn1 = GetColumnSubNode(poNode1);
+    swq_expr_node *poValue1 = GetConstantSubNode(poNode1);
+    swq_expr_node *poColumn2 = GetColumnSubNode(poNode2);
+    swq_expr_node *poValue2 = GetConstantSubNode(poNode2);
+    FileGDBSQLOp eOp1 = FGSO_ISNOTNULL;
+    FileGDBSQLOp eOp2 = FGSO_ISNOTNULL;
+    if (poColumn1 == nullptr || poValue1 == nullptr || poColumn2 == nullptr ||
+        poValue2 == nullptr ||
+        poColumn1->field_index != poColumn2->field_index ||
+        poColumn1->field_index >= GetLayerDefn()->GetFieldCount() ||
+        !GetRangeBoundOp(poNode1, poColumn1, eOp1) ||
+        !GetRangeBoundOp(poNode2, poColumn2, eOp2))
+        return nullptr;
+
+    if (eOp1 == FGSO_LT || eOp1 == FGSO_LE)
+    {
+        std::swap(eOp1, eOp2);
+        std::swap(poValue1, poValue2);
+    }
+    if ((eOp1 != FGSO_GE && eOp1 != FGSO_GT) ||
+        (eOp2 != FGSO_LE && eOp2 != FGSO_LT))
+        return nullptr;
+
+    OGRFieldDefn *poFieldDefn =
+        GetLayerDefn()->GetFieldDefn(poColumn1->field_index);
+    const int nTableColIdx =
+        m_poLyrTable->GetFieldIdx(poFieldDefn->GetNameRef());
+    if (nTableColIdx < 0 || !m_poLyrTable->GetField(nTableColIdx)->HasIndex())
+        return nullptr;
+    const auto eTableFieldType =
+        m_poLyrTable->GetField(nTableColIdx)->GetType();
+    if (eTableFieldType == FGFT_STRING || eTableFieldType == FGFT_GUID ||
+        eTableFieldType == FGFT_GLOBALID)
+        return nullptr;
+
+    OGRField sLowerValue;
+    OGRField sUpperValue;
+    if (!FillTargetValueFromSrcExpr(poFieldDefn, &sLowerValue, poValue1) ||
+        !FillTargetValueFromSrcExpr(poFieldDefn, &sUpperValue, poValue2))
+        return nullptr;
+
+    FileGDBIterator *poIter = FileGDBIterator::BuildRange(
+        m_poLyrTable, nTableColIdx, TRUE, eOp1, &sLowerValue, eOp2,
+        &sUpperValue, poFieldDefn->GetType());
+    if (poIter != nullptr)
+        m_bIteratorSufficientToEvaluateFilter = TRUE;
+    return poIter;
+}
+
 /***********************************************************************/
 /*                     BuildIteratorFromExprNode()                     */
 /***********************************************************************/
@@ -1266,6 +1372,10 @@ OGROpenFileGDBLayer::BuildIteratorFromExprNode(swq_expr_node *poNode)
     if (poNode->eNodeType == SNT_OPERATION && poNode->nOperation == SWQ_AND &&
         poNode->nSubExprCount == 2)
     {
+        FileGDBIterator *poRangeIter = BuildRangeIteratorFromExprNode(poNode);
+        if (poRangeIter != nullptr)
+            return poRangeIter;
+
         // Even if there is only one branch of the 2 that results to an
         // iterator, it is useful. Of course, the iterator will not be
         // sufficient to evaluatethe filter, but it will be a super-set of the
@@ -1526,7 +1636,13 @@ OGROpenFileGDBLayer::BuildIteratorFromExprNode(swq_expr_node *poNode)
             if (bAllConstants && nTableColIdx >= 0 &&
                 m_poLyrTable->GetField(nTableColIdx)->HasIndex())
             {
-                FileGDBIterator *poRet = nullptr;
+                std::vector<FileGDBIterator *> apoIters;
+                const auto DeleteIters = [&apoIters]()
+                {
+                    for (auto *poIter : apoIters)
+                        delete poIter;
+                    apoIters.clear();
+                };
 
                 bool bIteratorSufficient = true;
                 auto poField = m_poLyrTable->GetField(nTableColIdx);
@@ -1537,8 +1653,7 @@ OGROpenFileGDBLayer::BuildIteratorFromExprNode(swq_expr_node *poNode)
                     if (!FillTargetValueFromSrcExpr(poFieldDefn, &sValue,
                                                     poNode->papoSubExpr[i]))
                     {
-                        delete poRet;
-                        poRet = nullptr;
+                        DeleteIters();
                         break;
                     }
 
@@ -1584,15 +1699,12 @@ OGROpenFileGDBLayer::BuildIteratorFromExprNode(swq_expr_node *poNode)
                         poFieldDefn->GetType(), &sValue);
                     if (poIter == nullptr)
                     {
-                        delete poRet;
-                        poRet = nullptr;
+                        DeleteIters();
                         break;
                     }
-                    if (poRet == nullptr)
-                        poRet = poIter;
-                    else
-                        poRet = FileGDBIterator::BuildOr(poRet, poIter);
+                    apoIters.push_back(poIter);
                 }
+                FileGDBIterator *poRet = FileGDBIterator::BuildOr(apoIters);
                 if (poRet != nullptr)
                 {
                     m_bIteratorSufficientToEvaluateFilter = bIteratorSufficient;
@@ -1683,6 +1795,41 @@ void OGROpenFileGDBLayer::BuildCombinedIterator()
     }
 }
 
+/***********************************************************************/
+/*                          ConvertGeometry()                          */
+/***********************************************************************/
+
+OGRGeometry *
+OGROpenFileGDBLayer::ConvertGeometry(FileGDBOGRGeometryConverter *poConverter,
+                                     const OGRField *psField,
+                                     const OGRSpatialReference *poSRS)
+{
+    OGRGeometry *poGeom = poConverter->GetAsGeometry(psField);
+    if (poGeom == nullptr)
+        return nullptr;
+
+    OGRwkbGeometryType eFlattenType = wkbFlatten(poGeom->getGeometryType());
+    if (eFlattenType == wkbPolygon)
+        poGeom = OGRGeometryFactory::forceToMultiPolygon(poGeom);
+    else if (eFlattenType == wkbCurvePolygon)
+    {
+        OGRMultiSurface *poMS = new OGRMultiSurface();
+        poMS->addGeometryDirectly(poGeom);
+        poGeom = poMS;
+    }
+    else if (eFlattenType == wkbLineString)
+        poGeom = OGRGeometryFactory::forceToMultiLineString(poGeom);
+    else if (eFlattenType == wkbCompoundCurve)
+    {
+        OGRMultiCurve *poMC = new OGRMultiCurve();
+        poMC->addGeometryDirectly(poGeom);
+        poGeom = poMC;
+    }
+
+    poGeom->assignSpatialReference(poSRS);
+    return poGeom;
+}
+
 /***********************************************************************/
 /*                         GetCurrentFeature()                         */
 /***********************************************************************/
@@ -1737,33 +1884,24 @@ OGRFeature *OGROpenFileGDBLayer::GetCurrentFeature()
                     return nullptr;
                 }
 
-                OGRGeometry *poGeom = m_poGeomConverter->GetAsGeometry(psField);
-                if (poGeom != nullptr)
+                if (m_psDeferredGeometry != nullptr)
                 {
-                    OGRwkbGeometryType eFlattenType =
-                        wkbFlatten(poGeom->getGeometryType());
-                    if (eFlattenType == wkbPolygon)
-                        poGeom =
-                            OGRGeometryFactory::forceToMultiPolygon(poGeom);
-                    else if (eFlattenType == wkbCurvePolygon)
-                    {
-                        OGRMultiSurface *poMS = new OGRMultiSurface();
-                        poMS->addGeometryDirectly(poGeom);
-                        poGeom = poMS;
-                    }
-                    else if (eFlattenType == wkbLineString)
-                        poGeom =
-                            OGRGeometryFactory::forceToMultiLineString(poGeom);
-                    else if (eFlattenType == wkbCompoundCurve)
-                    {
-                        OGRMultiCurve *poMC = new OGRMultiCurve();
-                        poMC->addGeometryDirectly(poGeom);
-                        poGeom = poMC;
-                    }
-
-                    poGeom->assignSpatialReference(
-                        m_poFeatureDefn->GetGeomFieldDefn(0)->GetSpatialRef());
+                    // The blob points into the row buffer of the table,
+                    // which will be overwritten by the next row.
+                    m_psDeferredGeometry->abyGeomBlob.assign(
+                        psField->Binary.paData,
+                        psField->Binary.paData + psField->Binary.nCount);
+                    m_psDeferredGeometry->bHasGeomBlob = true;
+                    if (poFeature == nullptr)
+                        poFeature = new OGRFeature(m_poFeatureDefn);
+                    continue;
+                }
 
+                OGRGeometry *poGeom = ConvertGeometry(
+                    m_poGeomConverter.get(), psField,
+                    m_poFeatureDefn->GetGeomFieldDefn(0)->GetSpatialRef());
+                if (poGeom != nullptr)
+                {
                     if (poFeature == nullptr)
                         poFeature = new OGRFeature(m_poFeatureDefn);
                     poFeature->SetGeometryDirectly(poGeom);
@@ -1886,6 +2024,24 @@ OGRFeature *OGROpenFileGDBLayer::GetNextFeature()
                 }
             }
         }
+        else if (m_iNextPrefetchedFeature < m_asPrefetchedFeatures.size() ||
+                 CanPrefetchFeatures())
+        {
+            if (m_iNextPrefetchedFeature == m_asPrefetchedFeatures.size() &&
+                !PrefetchFeatures())
+            {
+                return nullptr;
+            }
+            auto &sPrefetched =
+                m_asPrefetchedFeatures[m_iNextPrefetchedFeature++];
+            // Re-emit in the calling thread the errors that occurred
+            // while decoding the geometry
+            for (const auto &sError : sPrefetched.aoErrors)
+            {
+                CPLError(sError.type, sError.no, "%s", sError.msg.c_str());
+            }
+            poFeature = sPrefetched.poFeature.release();
+        }
         else
         {
             while (true)
@@ -1931,6 +2087,171 @@ OGRFeature *OGROpenFileGDBLayer::GetNextFeature()
     }
 }
 
+/***********************************************************************/
+/*                           GetNumThreads()                           */
+/***********************************************************************/
+
+int OGROpenFileGDBLayer::GetNumThreads()
+{
+    if (m_nNumThreads == 0)
+    {
+        const char *pszNumThreads =
+            CPLGetConfigOption("GDAL_NUM_THREADS", "ALL_CPUS");
+        const int nCPUs = CPLGetNumCPUs();
+        m_nNumThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                            ? nCPUs
+                            : std::min(2 * nCPUs, atoi(pszNumThreads));
+        m_nNumThreads = std::max(1, std::min(m_nNumThreads, 128));
+    }
+    return m_nNumThreads;
+}
+
+/***********************************************************************/
+/*                        CanPrefetchFeatures()                        */
+/***********************************************************************/
+
+bool OGROpenFileGDBLayer::CanPrefetchFeatures()
+{
+    // Only the plain sequential scan is read ahead. In update mode, rows
+    // read in advance could be modified before being returned.
+    return !m_bEditable && m_iGeomFieldIdx >= 0 &&
+           !m_poFeatureDefn->GetGeomFieldDefn(0)->IsIgnored() &&
+           GetNumThreads() > 1;
+}
+
+/***********************************************************************/
+/*                      ClearPrefetchedFeatures()                      */
+/***********************************************************************/
+
+void OGROpenFileGDBLayer::ClearPrefetchedFeatures()
+{
+    m_asPrefetchedFeatures.clear();
+    m_iNextPrefetchedFeature = 0;
+}
+
+/***********************************************************************/
+/*                         PrefetchFeatures()                          */
+/***********************************************************************/
+
+// Reads the next batch of rows of the sequential scan. Attributes are
+// decoded in the calling thread, as FileGDBTable holds a single current
+// row, while geometry blobs are copied and then decoded by worker threads.
+bool OGROpenFileGDBLayer::PrefetchFeatures()
+{
+    ClearPrefetchedFeatures();
+
+    const int nThreads = GetNumThreads();
+    constexpr int FEATURES_PER_THREAD = 64;
+    const size_t nMaxFeatures =
+        static_cast<size_t>(nThreads) * FEATURES_PER_THREAD;
+    m_asPrefetchedFeatures.reserve(nMaxFeatures);
+
+    while (m_asPrefetchedFeatures.size() < nMaxFeatures &&
+           m_iCurFeat != m_poLyrTable->GetTotalRecordCount())
+    {
+        const int iRow = m_poLyrTable->GetAndSelectNextNonEmptyRow(m_iCurFeat);
+        if (iRow < 0)
+        {
+            // Return the features already read before reporting the end
+            // of the layer
+            m_iCurFeat = m_poLyrTable->GetTotalRecordCount();
+            if (m_asPrefetchedFeatures.empty())
+                m_bEOF = TRUE;
+            break;
+        }
+        m_iCurFeat = iRow + 1;
+
+        PrefetchedFeature sPrefetched;
+        m_psDeferredGeometry = &sPrefetched;
+        sPrefetched.poFeature.reset(GetCurrentFeature());
+        m_psDeferredGeometry = nullptr;
+        if (m_eSpatialIndexState == SPI_IN_BUILDING &&
+            m_iCurFeat == m_poLyrTable->GetTotalRecordCount())
+        {
+            CPLDebug("OpenFileGDB", "SPI_COMPLETED");
+            m_eSpatialIndexState = SPI_COMPLETED;
+        }
+        if (sPrefetched.poFeature)
+            m_asPrefetchedFeatures.push_back(std::move(sPrefetched));
+    }
+
+    const int nFeatures = static_cast<int>(m_asPrefetchedFeatures.size());
+    if (nFeatures == 0)
+        return false;
+
+    const auto poGeomField = cpl::down_cast<const FileGDBGeomField *>(
+        m_poLyrTable->GetField(m_iGeomFieldIdx));
+    const OGRSpatialReference *poSRS =
+        m_poFeatureDefn->GetGeomFieldDefn(0)->GetSpatialRef();
+    const auto DecodeGeometries =
+        [this, poGeomField, poSRS](int iStart, int iEnd)
+    {
+        // The converter has internal state, so use one per job
+        std::unique_ptr<FileGDBOGRGeometryConverter> poConverter(
+            FileGDBOGRGeometryConverter::BuildConverter(poGeomField));
+        for (int i = iStart; i < iEnd; i++)
+        {
+            auto &sPrefetched = m_asPrefetchedFeatures[i];
+            if (!sPrefetched.bHasGeomBlob)
+                continue;
+            OGRField sField;
+            sField.Binary.nCount =
+                static_cast<int>(sPrefetched.abyGeomBlob.size());
+            sField.Binary.paData = sPrefetched.abyGeomBlob.data();
+            CPLInstallErrorHandlerAccumulator(sPrefetched.aoErrors);
+            OGRGeometry *poGeom =
+                ConvertGeometry(poConverter.get(), &sField, poSRS);
+            CPLUninstallErrorHandlerAccumulator();
+            if (poGeom)
+                sPrefetched.poFeature->SetGeometryDirectly(poGeom);
+            sPrefetched.abyGeomBlob.clear();
+            sPrefetched.abyGeomBlob.shrink_to_fit();
+        }
+    };
+
+    const int nJobs = std::min(
+        nThreads, (nFeatures + FEATURES_PER_THREAD / 4 - 1) /
+                      (FEATURES_PER_THREAD / 4));
+    auto poThreadPool = nJobs > 1 ? GDALGetGlobalThreadPool(nJobs) : nullptr;
+    if (poThreadPool == nullptr)
+    {
+        DecodeGeometries(0, nFeatures);
+    }
+    else
+    {
+        struct DecodeJob
+        {
+            const decltype(DecodeGeometries) *pfnDecodeGeometries = nullptr;
+            int iStart = 0;
+            int iEnd = 0;
+        };
+
+        std::vector<DecodeJob> asJobs(nJobs);
+        auto poJobQueue = poThreadPool->CreateJobQueue();
+        for (int i = 0; i < nJobs; i++)
+        {
+            asJobs[i].pfnDecodeGeometries = &DecodeGeometries;
+            asJobs[i].iStart = nFeatures * i / nJobs;
+            asJobs[i].iEnd = nFeatures * (i + 1) / nJobs;
+        }
+        const auto JobFunc = [](void *pData)
+        {
+            const DecodeJob *psJob = static_cast<const DecodeJob *>(pData);
+            (*psJob->pfnDecodeGeometries)(psJob->iStart, psJob->iEnd);
+        };
+        // Run the last job in the current thread
+        for (int i = 0; i < nJobs - 1; i++)
+        {
+            if (!poJobQueue->SubmitJob(JobFunc, &asJobs[i]))
+                JobFunc(&asJobs[i]);
+        }
+        JobFunc(&asJobs[nJobs - 1]);
+        poJobQueue->WaitCompletion();
+    }
+
+    return true;
+}
+
 /***********************************************************************/
 /*                          GetFeature()                               */
 /***********************************************************************/
@@ -1977,6 +2298,8 @@ OGRErr OGROpenFileGDBLayer::SetNextByIndex(GIntBig nIndex)
     if (m_eSpatialIndexState == SPI_IN_BUILDING)
         m_eSpatialIndexState = SPI_INVALID;
 
+    ClearPrefetchedFeatures();
+
     if (m_nFilteredFeatureCount >= 0)
     {
         if (nIndex < 0 || nIndex >= m_nFilteredFeatureCount)
@@ -35,6 +35,7 @@
 
 #include "ogrsf_frmts.h"
 #include "cpl_string.h"
+#include "cpl_virtualmem.h"
 
 #include <array>
 #include <set>
@@ -359,6 +360,13 @@ typedef struct
     bool bAttrFilterAlreadyEvaluated : 1;
 } WayFeaturePair;
 
+/* Per-way output of ResolveWay(), computed in worker threads */
+struct ResolvedWay
+{
+    std::vector<LonLat> asLonLat{};
+    std::vector<GByte> abyCompressedWay{};
+};
+
 #ifdef ENABLE_NODE_LOOKUP_BY_HASHING
 typedef struct
 {
@@ -479,6 +487,8 @@ class OGROSMDataSource final : public OGRDataSource
     int nNonRedundantValuesLen = 0;
     WayFeaturePair *m_pasWayFeaturePairs = nullptr;
     int m_nWayFeaturePairs = 0;
+    std::vector<ResolvedWay> m_asResolvedWays{};
+    int m_nNumThreads = 0;
 
     std::vector<KeyDesc *> m_asKeys{};
     std::map<const char *, KeyDesc *, ConstCharComp>
@@ -490,6 +500,20 @@ class OGROSMDataSource final : public OGRDataSource
     GIntBig m_nNodesFileSize = 0;
     VSILFILE *m_fpNodes = nullptr;
 
+    // Dense node index: file mapping of an array of LonLat indexed by node id
+    bool m_bDenseNodeIndex = false;
+    CPLVirtualMem *m_psDenseNodesMapping = nullptr;
+    LonLat *m_pasDenseNodes = nullptr;
+    GIntBig m_nDenseNodesCapacity = 0;
+    // Set once a whole pass has indexed all nodes
+    bool m_bDenseNodeIndexComplete = false;
+    // Set when some nodes have been skipped during the current pass
+    bool m_bDenseNodeIndexPartial = false;
+    // Persistent node cache (NODE_CACHE_FILE)
+    CPLString m_osNodeCacheFilename{};
+    GIntBig m_nSourceFileSize = 0;
+    GIntBig m_nSourceFileMTime = 0;
+
     GIntBig m_nPrevNodeId = -INT_MAX;
     int m_nBucketOld = -1;
     int m_nOffInBucketReducedOld = -1;
@@ -503,9 +527,10 @@ class OGROSMDataSource final : public OGRDataSource
     static const GIntBig FILESIZE_INVALID = -1;
     GIntBig m_nFileSize = FILESIZE_NOT_INIT;
 
-    void CompressWay(bool bIsArea, unsigned int nTags, IndexedKVP *pasTags,
-                     int nPoints, LonLat *pasLonLatPairs, OSMInfo *psInfo,
-                     std::vector<GByte> &abyCompressedWay);
+    void CompressWay(bool bIsArea, unsigned int nTags,
+                     const IndexedKVP *pasTags, int nPoints,
+                     const LonLat *pasLonLatPairs, const OSMInfo *psInfo,
+                     std::vector<GByte> &abyCompressedWay) const;
     void UncompressWay(int nBytes, const GByte *pabyCompressedWay,
                        bool *pbIsArea, std::vector<LonLat> &asCoords,
                        unsigned int *pnTags, OSMTag *pasTags, OSMInfo *psInfo);
@@ -523,15 +548,22 @@ class OGROSMDataSource final : public OGRDataSource
     bool FlushCurrentSectorCompressedCase();
     bool FlushCurrentSectorNonCompressedCase();
     bool IndexPointCustom(OSMNode *psNode);
+    bool OpenDenseNodeIndex();
+    bool OpenNodeCache();
+    bool WriteNodeCacheHeader(bool bComplete);
+    void SetDenseNodeIndexComplete();
+    bool GrowDenseNodeIndex(GIntBig nID);
+    bool IndexPointDense(OSMNode *psNode);
 
-    void IndexWay(GIntBig nWayID, bool bIsArea, unsigned int nTags,
-                  IndexedKVP *pasTags, LonLat *pasLonLatPairs, int nPairs,
-                  OSMInfo *psInfo);
+    void IndexWay(GIntBig nWayID, const std::vector<GByte> &abyCompressedWay);
 
     bool StartTransactionCacheDB();
     bool CommitTransactionCacheDB();
 
-    int FindNode(GIntBig nID);
+    int FindNode(GIntBig nID) const;
+    void ResolveWay(const WayFeaturePair *psWayFeaturePairs,
+                    bool bStoreTagsInIndex, ResolvedWay &sResolved) const;
+    int GetNumThreads();
     void ProcessWaysBatch();
 
     void ProcessPolygonsStandalone();
@@ -541,6 +573,7 @@ class OGROSMDataSource final : public OGRDataSource
     void LookupNodesCustom();
     void LookupNodesCustomCompressedCase();
     void LookupNodesCustomNonCompressedCase();
+    void LookupNodesDense();
 
     unsigned int
     LookupWays(std::map<GIntBig, std::pair<int, void *>> &aoMapWays,
@@ -56,6 +56,8 @@
 #include "cpl_string.h"
 #include "cpl_time.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -97,6 +99,21 @@ static bool VALID_ID_FOR_CUSTOM_INDEXING(GIntBig _id)
     return _id >= 0 && _id / NODE_PER_BUCKET < INT_MAX;
 }
 
+// Granularity, in number of nodes, at which the file of the dense node index
+// is grown (128 MB).
+constexpr GIntBig DENSE_NODES_GROWTH = 16 * 1024 * 1024;
+
+// The file of the dense node index starts with a header page, followed by
+// the array of LonLat. The header is only filled for a persistent node cache:
+// magic, followed by uint64 LSB values: size and modification time of the
+// OSM file, number of node ids in the array and flags.
+constexpr int DENSE_NODES_HEADER_SIZE = 4096;
+constexpr const char *NODE_CACHE_MAGIC = "OSMNODC1";
+constexpr int NODE_CACHE_MAGIC_SIZE = 8;
+constexpr int NODE_CACHE_HEADER_USED_SIZE =
+    NODE_CACHE_MAGIC_SIZE + 4 * static_cast<int>(sizeof(GUInt64));
+constexpr GUInt64 NODE_CACHE_FLAG_COMPLETE = 1;
+
 // Minimum size of data written on disk, in *uncompressed* case.
 constexpr int SECTOR_SIZE = 512;
 // Which represents, 64 nodes
@@ -311,6 +328,8 @@ OGROSMDataSource::~OGROSMDataSource()
         }
     }
 
+    if (m_psDenseNodesMapping)
+        CPLVirtualMemFree(m_psDenseNodesMapping);
     if (m_fpNodes)
         VSIFCloseL(m_fpNodes);
     if (!m_osNodesFilename.empty() && m_bMustUnlinkNodesFile)
@@ -417,6 +436,9 @@ bool OGROSMDataSource::IndexPoint(OSMNode *psNode)
     if (!m_bIndexPoints)
         return true;
 
+    if (m_bDenseNodeIndex)
+        return m_bDenseNodeIndexComplete || IndexPointDense(psNode);
+
     if (m_bCustomIndexing)
         return IndexPointCustom(psNode);
 
@@ -720,6 +742,247 @@ bool OGROSMDataSource::IndexPointCustom(OSMNode *psNode)
     return true;
 }
 
+/************************************************************************/
+/*                         GrowDenseNodeIndex()                         */
+/************************************************************************/
+
+bool OGROSMDataSource::GrowDenseNodeIndex(GIntBig nID)
+{
+    // Grow geometrically, so that the number of remappings stays small
+    // even if node ids are not sorted.
+    GIntBig nNewCapacity =
+        std::max(nID + 1, m_nDenseNodesCapacity + m_nDenseNodesCapacity / 2);
+    nNewCapacity = (nNewCapacity + DENSE_NODES_GROWTH - 1) /
+                   DENSE_NODES_GROWTH * DENSE_NODES_GROWTH;
+    if (static_cast<GUIntBig>(nNewCapacity) >
+        std::numeric_limits<size_t>::max() / sizeof(LonLat))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Unsupported node id value (" CPL_FRMT_GIB
+                 ") for dense node index. Use OSM_DENSE_NODE_INDEX=NO",
+                 nID);
+        return false;
+    }
+
+    if (m_psDenseNodesMapping)
+    {
+        CPLVirtualMemFree(m_psDenseNodesMapping);
+        m_psDenseNodesMapping = nullptr;
+        m_pasDenseNodes = nullptr;
+        m_nDenseNodesCapacity = 0;
+    }
+
+    // The mapping extends the file as needed. On usual file systems, the
+    // file is sparse, so the ranges of ids without nodes take no disk space.
+    m_psDenseNodesMapping = CPLVirtualMemFileMapNew(
+        m_fpNodes, DENSE_NODES_HEADER_SIZE,
+        static_cast<vsi_l_offset>(nNewCapacity) * sizeof(LonLat),
+        VIRTUALMEM_READWRITE, nullptr, nullptr);
+    if (m_psDenseNodesMapping == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot map temporary node file %s for node id " CPL_FRMT_GIB
+                 ". Use OSM_DENSE_NODE_INDEX=NO",
+                 m_osNodesFilename.c_str(), nID);
+        return false;
+    }
+    m_pasDenseNodes =
+        static_cast<LonLat *>(CPLVirtualMemGetAddr(m_psDenseNodesMapping));
+    m_nDenseNodesCapacity = nNewCapacity;
+    return true;
+}
+
+/************************************************************************/
+/*                         OpenDenseNodeIndex()                         */
+/************************************************************************/
+
+bool OGROSMDataSource::OpenDenseNodeIndex()
+{
+    // The file must be a real file to be mapped in memory
+    m_bInMemoryNodesFile = false;
+
+    if (!m_osNodeCacheFilename.empty())
+    {
+        m_osNodesFilename = m_osNodeCacheFilename;
+        m_bMustUnlinkNodesFile = false;
+        if (OpenNodeCache())
+            return true;
+
+        m_fpNodes = VSIFOpenL(m_osNodesFilename, "wb+");
+        if (m_fpNodes == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s",
+                     m_osNodesFilename.c_str());
+            return false;
+        }
+        return WriteNodeCacheHeader(false);
+    }
+
+    m_osNodesFilename = CPLGenerateTempFilename("osm_tmp_nodes");
+    m_fpNodes = VSIFOpenL(m_osNodesFilename, "wb+");
+    if (m_fpNodes == nullptr)
+    {
+        return false;
+    }
+
+    /* On Unix filesystems, you can remove a file even if it */
+    /* opened */
+    const char *pszVal = CPLGetConfigOption("OSM_UNLINK_TMPFILE", "YES");
+    if (EQUAL(pszVal, "YES"))
+    {
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        m_bMustUnlinkNodesFile = VSIUnlink(m_osNodesFilename) != 0;
+        CPLPopErrorHandler();
+    }
+
+    return VSIFTruncateL(m_fpNodes, DENSE_NODES_HEADER_SIZE) == 0;
+}
+
+/************************************************************************/
+/*                           OpenNodeCache()                            */
+/*                                                                      */
+/*      Open an existing persistent node cache, if it is complete and   */
+/*      matches the size and modification time of the OSM file.         */
+/************************************************************************/
+
+bool OGROSMDataSource::OpenNodeCache()
+{
+    VSILFILE *fp = VSIFOpenL(m_osNodeCacheFilename, "rb");
+    if (fp == nullptr)
+        return false;
+
+    GByte abyHeader[NODE_CACHE_HEADER_USED_SIZE];
+    GUInt64 anValues[4] = {0, 0, 0, 0};
+    bool bValid = VSIFReadL(abyHeader, 1, sizeof(abyHeader), fp) ==
+                      sizeof(abyHeader) &&
+                  memcmp(abyHeader, NODE_CACHE_MAGIC, NODE_CACHE_MAGIC_SIZE) ==
+                      0;
+    if (bValid)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            memcpy(&anValues[i],
+                   abyHeader + NODE_CACHE_MAGIC_SIZE + i * sizeof(GUInt64),
+                   sizeof(GUInt64));
+            CPL_LSBPTR64(&anValues[i]);
+        }
+        const GUInt64 nCapacity = anValues[2];
+        bValid = anValues[0] == static_cast<GUInt64>(m_nSourceFileSize) &&
+                 anValues[1] == static_cast<GUInt64>(m_nSourceFileMTime) &&
+                 (anValues[3] & NODE_CACHE_FLAG_COMPLETE) != 0 &&
+                 nCapacity <= std::numeric_limits<size_t>::max() /
+                                  sizeof(LonLat) &&
+                 VSIFSeekL(fp, 0, SEEK_END) == 0 &&
+                 VSIFTellL(fp) ==
+                     DENSE_NODES_HEADER_SIZE + nCapacity * sizeof(LonLat);
+    }
+    if (bValid && anValues[2] > 0)
+    {
+        m_psDenseNodesMapping = CPLVirtualMemFileMapNew(
+            fp, DENSE_NODES_HEADER_SIZE, anValues[2] * sizeof(LonLat),
+            VIRTUALMEM_READONLY, nullptr, nullptr);
+        bValid = m_psDenseNodesMapping != nullptr;
+    }
+    if (!bValid)
+    {
+        CPLDebug("OSM", "Ignoring invalid or outdated %s",
+                 m_osNodeCacheFilename.c_str());
+        VSIFCloseL(fp);
+        return false;
+    }
+
+    CPLDebug("OSM", "Reusing node cache %s", m_osNodeCacheFilename.c_str());
+    m_fpNodes = fp;
+    if (m_psDenseNodesMapping)
+        m_pasDenseNodes =
+            static_cast<LonLat *>(CPLVirtualMemGetAddr(m_psDenseNodesMapping));
+    m_nDenseNodesCapacity = static_cast<GIntBig>(anValues[2]);
+    m_bDenseNodeIndexComplete = true;
+    return true;
+}
+
+/************************************************************************/
+/*                        WriteNodeCacheHeader()                        */
+/************************************************************************/
+
+bool OGROSMDataSource::WriteNodeCacheHeader(bool bComplete)
+{
+    GByte abyHeader[DENSE_NODES_HEADER_SIZE] = {0};
+    memcpy(abyHeader, NODE_CACHE_MAGIC, NODE_CACHE_MAGIC_SIZE);
+    const GUInt64 anValues[4] = {
+        static_cast<GUInt64>(m_nSourceFileSize),
+        static_cast<GUInt64>(m_nSourceFileMTime),
+        static_cast<GUInt64>(m_nDenseNodesCapacity),
+        bComplete ? NODE_CACHE_FLAG_COMPLETE : 0};
+    for (int i = 0; i < 4; i++)
+    {
+        GUInt64 nVal = anValues[i];
+        CPL_LSBPTR64(&nVal);
+        memcpy(abyHeader + NODE_CACHE_MAGIC_SIZE + i * sizeof(GUInt64), &nVal,
+               sizeof(GUInt64));
+    }
+    if (VSIFSeekL(m_fpNodes, 0, SEEK_SET) != 0 ||
+        VSIFWriteL(abyHeader, 1, sizeof(abyHeader), m_fpNodes) !=
+            sizeof(abyHeader) ||
+        VSIFFlushL(m_fpNodes) != 0)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot write header of %s",
+                 m_osNodesFilename.c_str());
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                     SetDenseNodeIndexComplete()                      */
+/*                                                                      */
+/*      Called at the end of a pass that has indexed all nodes. The     */
+/*      following passes, and for a persistent node cache, the later    */
+/*      openings of the same OSM file, no longer need to index them.    */
+/************************************************************************/
+
+void OGROSMDataSource::SetDenseNodeIndexComplete()
+{
+    m_bDenseNodeIndexComplete = true;
+    // The mapping has extended the file up to the end of the array
+    if (!m_osNodeCacheFilename.empty() && WriteNodeCacheHeader(true))
+    {
+        CPLDebug("OSM", "Node cache %s written", m_osNodeCacheFilename.c_str());
+    }
+}
+
+/************************************************************************/
+/*                          IndexPointDense()                           */
+/************************************************************************/
+
+bool OGROSMDataSource::IndexPointDense(OSMNode *psNode)
+{
+    if (!VALID_ID_FOR_CUSTOM_INDEXING(psNode->nID))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Unsupported node id value (" CPL_FRMT_GIB
+                 "). Use OSM_USE_CUSTOM_INDEXING=NO",
+                 psNode->nID);
+        m_bDenseNodeIndexPartial = true;
+        m_bStopParsing = true;
+        return false;
+    }
+
+    if (psNode->nID >= m_nDenseNodesCapacity &&
+        !GrowDenseNodeIndex(psNode->nID))
+    {
+        m_bDenseNodeIndexPartial = true;
+        m_bStopParsing = true;
+        return false;
+    }
+
+    LonLat *psLonLat = &m_pasDenseNodes[psNode->nID];
+    psLonLat->nLon = DBL_TO_INT(psNode->dfLon);
+    psLonLat->nLat = DBL_TO_INT(psNode->dfLat);
+
+    return true;
+}
+
 /************************************************************************/
 /*                             NotifyNodes()                            */
 /************************************************************************/
@@ -729,6 +992,16 @@ void OGROSMDataSource::NotifyNodes(unsigned int nNodes, OSMNode *pasNodes)
     const OGREnvelope *psEnvelope =
         m_papoLayers[IDX_LYR_POINTS]->GetSpatialFilterEnvelope();
 
+    if (m_bDenseNodeIndexComplete)
+    {
+        if (!m_papoLayers[IDX_LYR_POINTS]->IsUserInterested())
+            return;
+    }
+    else if (psEnvelope != nullptr || !m_bIndexPoints)
+    {
+        m_bDenseNodeIndexPartial = true;
+    }
+
     for (unsigned int i = 0; i < nNodes; i++)
     {
         /* If the point doesn't fit into the envelope of the spatial filter */
@@ -800,7 +1073,9 @@ static void OGROSMNotifyNodes(unsigned int nNodes, OSMNode *pasNodes,
 
 void OGROSMDataSource::LookupNodes()
 {
-    if (m_bCustomIndexing)
+    if (m_bDenseNodeIndex)
+        LookupNodesDense();
+    else if (m_bCustomIndexing)
         LookupNodesCustom();
     else
         LookupNodesSQLite();
@@ -1296,6 +1571,45 @@ void OGROSMDataSource::LookupNodesCustomNonCompressedCase()
     m_nReqIds = j;
 }
 
+/************************************************************************/
+/*                          LookupNodesDense()                          */
+/************************************************************************/
+
+void OGROSMDataSource::LookupNodesDense()
+{
+    CPLAssert(m_nUnsortedReqIds <=
+              static_cast<unsigned int>(MAX_ACCUMULATED_NODES));
+
+    m_nReqIds = 0;
+    for (unsigned int i = 0; i < m_nUnsortedReqIds; i++)
+    {
+        const GIntBig id = m_panUnsortedReqIds[i];
+        if (id >= 0 && id < m_nDenseNodesCapacity)
+            m_panReqIds[m_nReqIds++] = id;
+    }
+
+    // Sorting makes accesses to the mapping sequential
+    std::sort(m_panReqIds, m_panReqIds + m_nReqIds);
+
+    // Remove duplicates and nodes that were not indexed, that is to say
+    // holes of the file (whose content is zero).
+    unsigned int j = 0;  // Used after for.
+    for (unsigned int i = 0; i < m_nReqIds; i++)
+    {
+        const GIntBig id = m_panReqIds[i];
+        if (j > 0 && id == m_panReqIds[j - 1])
+            continue;
+        const LonLat &sLonLat = m_pasDenseNodes[id];
+        if (sLonLat.nLon || sLonLat.nLat)
+        {
+            m_panReqIds[j] = id;
+            m_pasLonLatArray[j] = sLonLat;
+            j++;
+        }
+    }
+    m_nReqIds = j;
+}
+
 /************************************************************************/
 /*                            WriteVarInt()                             */
 /************************************************************************/
@@ -1384,9 +1698,10 @@ static void WriteVarSInt64(GIntBig nSVal, GByte **ppabyData)
 /************************************************************************/
 
 void OGROSMDataSource::CompressWay(bool bIsArea, unsigned int nTags,
-                                   IndexedKVP *pasTags, int nPoints,
-                                   LonLat *pasLonLatPairs, OSMInfo *psInfo,
-                                   std::vector<GByte> &abyCompressedWay)
+                                   const IndexedKVP *pasTags, int nPoints,
+                                   const LonLat *pasLonLatPairs,
+                                   const OSMInfo *psInfo,
+                                   std::vector<GByte> &abyCompressedWay) const
 {
     abyCompressedWay.clear();
     abyCompressedWay.push_back((bIsArea) ? 1 : 0);
@@ -1558,28 +1873,15 @@ void OGROSMDataSource::UncompressWay(int nBytes, const GByte *pabyCompressedWay,
 /*                              IndexWay()                              */
 /************************************************************************/
 
-void OGROSMDataSource::IndexWay(GIntBig nWayID, bool bIsArea,
-                                unsigned int nTags, IndexedKVP *pasTags,
-                                LonLat *pasLonLatPairs, int nPairs,
-                                OSMInfo *psInfo)
+void OGROSMDataSource::IndexWay(GIntBig nWayID,
+                                const std::vector<GByte> &abyCompressedWay)
 {
     if (!m_bIndexWays)
         return;
 
     sqlite3_bind_int64(m_hInsertWayStmt, 1, nWayID);
-
-    const unsigned nTagsClamped = std::min(nTags, MAX_COUNT_FOR_TAGS_IN_WAY);
-    if (nTagsClamped < nTags)
-    {
-        CPLDebug("OSM",
-                 "Too many tags for way " CPL_FRMT_GIB ": %u. "
-                 "Clamping to %u",
-                 nWayID, nTags, nTagsClamped);
-    }
-    CompressWay(bIsArea, nTagsClamped, pasTags, nPairs, pasLonLatPairs, psInfo,
-                m_abyWayBuffer);
-    sqlite3_bind_blob(m_hInsertWayStmt, 2, m_abyWayBuffer.data(),
-                      static_cast<int>(m_abyWayBuffer.size()), SQLITE_STATIC);
+    sqlite3_bind_blob(m_hInsertWayStmt, 2, abyCompressedWay.data(),
+                      static_cast<int>(abyCompressedWay.size()), SQLITE_STATIC);
 
     int rc = sqlite3_step(m_hInsertWayStmt);
     sqlite3_reset(m_hInsertWayStmt);
@@ -1595,7 +1897,7 @@ void OGROSMDataSource::IndexWay(GIntBig nWayID, bool bIsArea,
 /*                              FindNode()                              */
 /************************************************************************/
 
-int OGROSMDataSource::FindNode(GIntBig nID)
+int OGROSMDataSource::FindNode(GIntBig nID) const
 {
     if (m_nReqIds == 0)
         return -1;
@@ -1615,135 +1917,248 @@ int OGROSMDataSource::FindNode(GIntBig nID)
 }
 
 /************************************************************************/
-/*                         ProcessWaysBatch()                           */
+/*                             ResolveWay()                             */
+/*                                                                      */
+/*      Fetch the coordinates of the nodes of a way, and compute its    */
+/*      compressed form for the way index and its line geometry. Only   */
+/*      reads the node lookup arrays, so it can run in worker threads.  */
 /************************************************************************/
 
-void OGROSMDataSource::ProcessWaysBatch()
+void OGROSMDataSource::ResolveWay(const WayFeaturePair *psWayFeaturePairs,
+                                  bool bStoreTagsInIndex,
+                                  ResolvedWay &sResolved) const
 {
-    if (m_nWayFeaturePairs == 0)
-        return;
-
-    // printf("nodes = %d, features = %d\n", nUnsortedReqIds, nWayFeaturePairs);
-    LookupNodes();
-
-    for (int iPair = 0; iPair < m_nWayFeaturePairs; iPair++)
-    {
-        WayFeaturePair *psWayFeaturePairs = &m_pasWayFeaturePairs[iPair];
-
-        const bool bIsArea = psWayFeaturePairs->bIsArea;
-        m_asLonLatCache.clear();
+    std::vector<LonLat> &asLonLat = sResolved.asLonLat;
+    asLonLat.clear();
+    sResolved.abyCompressedWay.clear();
 
 #ifdef ENABLE_NODE_LOOKUP_BY_HASHING
-        if (m_bHashedIndexValid)
+    if (m_bHashedIndexValid)
+    {
+        for (unsigned int i = 0; i < psWayFeaturePairs->nRefs; i++)
         {
-            for (unsigned int i = 0; i < psWayFeaturePairs->nRefs; i++)
+            int nIndInHashArray = static_cast<int>(
+                HASH_ID_FUNC(psWayFeaturePairs->panNodeRefs[i]) %
+                HASHED_INDEXES_ARRAY_SIZE);
+            int nIdx = m_panHashedIndexes[nIndInHashArray];
+            if (nIdx < -1)
             {
-                int nIndInHashArray = static_cast<int>(
-                    HASH_ID_FUNC(psWayFeaturePairs->panNodeRefs[i]) %
-                    HASHED_INDEXES_ARRAY_SIZE);
-                int nIdx = m_panHashedIndexes[nIndInHashArray];
-                if (nIdx < -1)
+                int iBucket = -nIdx - 2;
+                while (true)
                 {
-                    int iBucket = -nIdx - 2;
-                    while (true)
+                    nIdx = m_psCollisionBuckets[iBucket].nInd;
+                    if (m_panReqIds[nIdx] == psWayFeaturePairs->panNodeRefs[i])
+                        break;
+                    iBucket = m_psCollisionBuckets[iBucket].nNext;
+                    if (iBucket < 0)
                     {
-                        nIdx = m_psCollisionBuckets[iBucket].nInd;
-                        if (m_panReqIds[nIdx] ==
-                            psWayFeaturePairs->panNodeRefs[i])
-                            break;
-                        iBucket = m_psCollisionBuckets[iBucket].nNext;
-                        if (iBucket < 0)
-                        {
-                            nIdx = -1;
-                            break;
-                        }
+                        nIdx = -1;
+                        break;
                     }
                 }
-                else if (nIdx >= 0 &&
-                         m_panReqIds[nIdx] != psWayFeaturePairs->panNodeRefs[i])
-                    nIdx = -1;
+            }
+            else if (nIdx >= 0 &&
+                     m_panReqIds[nIdx] != psWayFeaturePairs->panNodeRefs[i])
+                nIdx = -1;
 
-                if (nIdx >= 0)
-                {
-                    m_asLonLatCache.push_back(m_pasLonLatArray[nIdx]);
-                }
+            if (nIdx >= 0)
+            {
+                asLonLat.push_back(m_pasLonLatArray[nIdx]);
             }
         }
-        else
+    }
+    else
 #endif  // ENABLE_NODE_LOOKUP_BY_HASHING
+    {
+        int nIdx = -1;
+        for (unsigned int i = 0; i < psWayFeaturePairs->nRefs; i++)
         {
-            int nIdx = -1;
-            for (unsigned int i = 0; i < psWayFeaturePairs->nRefs; i++)
+            if (nIdx >= 0 && psWayFeaturePairs->panNodeRefs[i] ==
+                                 psWayFeaturePairs->panNodeRefs[i - 1] + 1)
             {
-                if (nIdx >= 0 && psWayFeaturePairs->panNodeRefs[i] ==
-                                     psWayFeaturePairs->panNodeRefs[i - 1] + 1)
-                {
-                    if (nIdx + 1 < (int)m_nReqIds &&
-                        m_panReqIds[nIdx + 1] ==
-                            psWayFeaturePairs->panNodeRefs[i])
-                        nIdx++;
-                    else
-                        nIdx = -1;
-                }
+                if (nIdx + 1 < (int)m_nReqIds &&
+                    m_panReqIds[nIdx + 1] == psWayFeaturePairs->panNodeRefs[i])
+                    nIdx++;
                 else
-                    nIdx = FindNode(psWayFeaturePairs->panNodeRefs[i]);
-                if (nIdx >= 0)
-                {
-                    m_asLonLatCache.push_back(m_pasLonLatArray[nIdx]);
-                }
+                    nIdx = -1;
+            }
+            else
+                nIdx = FindNode(psWayFeaturePairs->panNodeRefs[i]);
+            if (nIdx >= 0)
+            {
+                asLonLat.push_back(m_pasLonLatArray[nIdx]);
             }
         }
+    }
+
+    if (!asLonLat.empty() && psWayFeaturePairs->bIsArea)
+    {
+        asLonLat.push_back(asLonLat[0]);
+    }
+
+    // Discarded by the caller.
+    if (asLonLat.size() < 2)
+        return;
 
-        if (!m_asLonLatCache.empty() && bIsArea)
+    const int nPoints = static_cast<int>(asLonLat.size());
+    if (m_bIndexWays)
+    {
+        if (bStoreTagsInIndex)
         {
-            m_asLonLatCache.push_back(m_asLonLatCache[0]);
+            CompressWay(/*bIsArea = */ true,
+                        std::min(psWayFeaturePairs->nTags,
+                                 MAX_COUNT_FOR_TAGS_IN_WAY),
+                        psWayFeaturePairs->pasTags, nPoints, asLonLat.data(),
+                        &psWayFeaturePairs->sInfo, sResolved.abyCompressedWay);
         }
+        else
+        {
+            CompressWay(psWayFeaturePairs->bIsArea, 0, nullptr, nPoints,
+                        asLonLat.data(), nullptr, sResolved.abyCompressedWay);
+        }
+    }
 
-        if (m_asLonLatCache.size() < 2)
+    if (psWayFeaturePairs->poFeature == nullptr)
+        return;
+
+    OGRLineString *poLS = new OGRLineString();
+    poLS->setNumPoints(nPoints);
+    for (int i = 0; i < nPoints; i++)
+    {
+        poLS->setPoint(i, INT_TO_DBL(asLonLat[i].nLon),
+                       INT_TO_DBL(asLonLat[i].nLat));
+    }
+    psWayFeaturePairs->poFeature->SetGeometryDirectly(poLS);
+}
+
+/************************************************************************/
+/*                           GetNumThreads()                            */
+/************************************************************************/
+
+int OGROSMDataSource::GetNumThreads()
+{
+    if (m_nNumThreads == 0)
+    {
+        // Same setting as the one used by the PBF parser
+        const char *pszNumThreads =
+            CPLGetConfigOption("GDAL_NUM_THREADS", "ALL_CPUS");
+        const int nCPUs = CPLGetNumCPUs();
+        m_nNumThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                            ? nCPUs
+                            : std::min(2 * nCPUs, atoi(pszNumThreads));
+        m_nNumThreads = std::max(1, std::min(m_nNumThreads, 128));
+    }
+    return m_nNumThreads;
+}
+
+/************************************************************************/
+/*                         ProcessWaysBatch()                           */
+/************************************************************************/
+
+void OGROSMDataSource::ProcessWaysBatch()
+{
+    if (m_nWayFeaturePairs == 0)
+        return;
+
+    // printf("nodes = %d, features = %d\n", nUnsortedReqIds, nWayFeaturePairs);
+    LookupNodes();
+
+    // The node lookup arrays are read-only from now on, so resolve the ways
+    // of the batch in parallel. Everything that touches SQLite or the layers
+    // is done afterwards, in the original order of the ways.
+    const bool bStoreTagsInIndex =
+        m_papoLayers[IDX_LYR_MULTIPOLYGONS]->IsUserInterested();
+    if (m_asResolvedWays.size() < static_cast<size_t>(m_nWayFeaturePairs))
+        m_asResolvedWays.resize(m_nWayFeaturePairs);
+
+    const auto ResolveWays = [this, bStoreTagsInIndex](int iStart, int iEnd)
+    {
+        for (int iPair = iStart; iPair < iEnd; iPair++)
+        {
+            const WayFeaturePair *psWayFeaturePairs =
+                &m_pasWayFeaturePairs[iPair];
+            ResolveWay(psWayFeaturePairs,
+                       bStoreTagsInIndex && psWayFeaturePairs->bIsArea,
+                       m_asResolvedWays[iPair]);
+        }
+    };
+
+    const int nJobs = std::min(GetNumThreads(), (m_nWayFeaturePairs + 63) / 64);
+    if (nJobs <= 1)
+    {
+        ResolveWays(0, m_nWayFeaturePairs);
+    }
+    else
+    {
+        struct ResolveJob
+        {
+            const decltype(ResolveWays) *pfnResolveWays = nullptr;
+            int iStart = 0;
+            int iEnd = 0;
+        };
+
+        std::vector<ResolveJob> asJobs(nJobs);
+        auto poJobQueue = GDALGetGlobalThreadPool(nJobs)->CreateJobQueue();
+        for (int i = 0; i < nJobs; i++)
+        {
+            asJobs[i].pfnResolveWays = &ResolveWays;
+            asJobs[i].iStart =
+                static_cast<int>(static_cast<GIntBig>(m_nWayFeaturePairs) * i /
+                                 nJobs);
+            asJobs[i].iEnd =
+                static_cast<int>(static_cast<GIntBig>(m_nWayFeaturePairs) *
+                                 (i + 1) / nJobs);
+        }
+        const auto JobFunc = [](void *pData)
+        {
+            const ResolveJob *psJob = static_cast<const ResolveJob *>(pData);
+            (*psJob->pfnResolveWays)(psJob->iStart, psJob->iEnd);
+        };
+        // Run the last job in the current thread
+        for (int i = 0; i < nJobs - 1; i++)
+        {
+            if (!poJobQueue->SubmitJob(JobFunc, &asJobs[i]))
+                JobFunc(&asJobs[i]);
+        }
+        JobFunc(&asJobs[nJobs - 1]);
+        poJobQueue->WaitCompletion();
+    }
+
+    for (int iPair = 0; iPair < m_nWayFeaturePairs; iPair++)
+    {
+        WayFeaturePair *psWayFeaturePairs = &m_pasWayFeaturePairs[iPair];
+        const ResolvedWay &sResolved = m_asResolvedWays[iPair];
+        const int nPoints = static_cast<int>(sResolved.asLonLat.size());
+
+        if (nPoints < 2)
         {
             CPLDebug("OSM",
                      "Way " CPL_FRMT_GIB
                      " with %d nodes that could be found. Discarding it",
-                     psWayFeaturePairs->nWayID,
-                     static_cast<int>(m_asLonLatCache.size()));
+                     psWayFeaturePairs->nWayID, nPoints);
             delete psWayFeaturePairs->poFeature;
             psWayFeaturePairs->poFeature = nullptr;
             psWayFeaturePairs->bIsArea = false;
             continue;
         }
 
-        if (bIsArea && m_papoLayers[IDX_LYR_MULTIPOLYGONS]->IsUserInterested())
+        if (bStoreTagsInIndex && psWayFeaturePairs->bIsArea &&
+            psWayFeaturePairs->nTags > MAX_COUNT_FOR_TAGS_IN_WAY)
         {
-            IndexWay(psWayFeaturePairs->nWayID, /*bIsArea = */ true,
-                     psWayFeaturePairs->nTags, psWayFeaturePairs->pasTags,
-                     m_asLonLatCache.data(),
-                     static_cast<int>(m_asLonLatCache.size()),
-                     &psWayFeaturePairs->sInfo);
+            CPLDebug("OSM",
+                     "Too many tags for way " CPL_FRMT_GIB ": %u. "
+                     "Clamping to %u",
+                     psWayFeaturePairs->nWayID, psWayFeaturePairs->nTags,
+                     MAX_COUNT_FOR_TAGS_IN_WAY);
         }
-        else
-            IndexWay(psWayFeaturePairs->nWayID, bIsArea, 0, nullptr,
-                     m_asLonLatCache.data(),
-                     static_cast<int>(m_asLonLatCache.size()), nullptr);
+        IndexWay(psWayFeaturePairs->nWayID, sResolved.abyCompressedWay);
 
         if (psWayFeaturePairs->poFeature == nullptr)
         {
             continue;
         }
 
-        OGRLineString *poLS = new OGRLineString();
-        OGRGeometry *poGeom = poLS;
-
-        const int nPoints = static_cast<int>(m_asLonLatCache.size());
-        poLS->setNumPoints(nPoints);
-        for (int i = 0; i < nPoints; i++)
-        {
-            poLS->setPoint(i, INT_TO_DBL(m_asLonLatCache[i].nLon),
-                           INT_TO_DBL(m_asLonLatCache[i].nLat));
-        }
-
-        psWayFeaturePairs->poFeature->SetGeometryDirectly(poGeom);
-
-        if (m_asLonLatCache.size() != psWayFeaturePairs->nRefs)
+        if (static_cast<unsigned>(nPoints) != psWayFeaturePairs->nRefs)
             CPLDebug(
                 "OSM",
                 "For way " CPL_FRMT_GIB ", got only %d nodes instead of %d",
@@ -2775,6 +3190,57 @@ int OGROSMDataSource::Open(const char *pszFilename, char **papszOpenOptionsIn)
                              CPLGetConfigOption("OSM_COMPRESS_NODES", "NO")));
     if (m_bCompressNodes)
         CPLDebug("OSM", "Using compression for nodes DB");
+    m_bDenseNodeIndex = CPLTestBool(
+        CSLFetchNameValueDef(papszOpenOptionsIn, "DENSE_NODE_INDEX",
+                             CPLGetConfigOption("OSM_DENSE_NODE_INDEX", "NO")));
+    m_osNodeCacheFilename =
+        CSLFetchNameValueDef(papszOpenOptionsIn, "NODE_CACHE_FILE",
+                             CPLGetConfigOption("OSM_NODE_CACHE_FILE", ""));
+    if (!m_osNodeCacheFilename.empty())
+    {
+        // The persistent node cache is a dense node index
+        m_bDenseNodeIndex = true;
+    }
+    if (m_bDenseNodeIndex)
+    {
+        if (!m_bCustomIndexing)
+        {
+            CPLDebug("OSM", "Dense node index ignored since custom indexing "
+                            "is disabled");
+            m_bDenseNodeIndex = false;
+        }
+        else if (!CPLIsVirtualMemFileMapAvailable())
+        {
+            CPLError(CE_Warning, CPLE_NotSupported,
+                     "Dense node index not supported on this platform");
+            m_bDenseNodeIndex = false;
+        }
+        else
+        {
+            CPLDebug("OSM", "Using dense memory-mapped index for nodes");
+            m_bCompressNodes = false;
+        }
+    }
+    if (!m_bDenseNodeIndex)
+    {
+        m_osNodeCacheFilename.clear();
+    }
+    else if (!m_osNodeCacheFilename.empty())
+    {
+        VSIStatBufL sStat;
+        if (VSIStatL(pszFilename, &sStat) != 0 ||
+            STARTS_WITH(pszFilename, "/vsistdin/"))
+        {
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "Node cache cannot be used when reading %s", pszFilename);
+            m_osNodeCacheFilename.clear();
+        }
+        else
+        {
+            m_nSourceFileSize = static_cast<GIntBig>(sStat.st_size);
+            m_nSourceFileMTime = static_cast<GIntBig>(sStat.st_mtime);
+        }
+    }
 
     m_nLayers = 5;
     m_papoLayers = static_cast<OGROSMLayer **>(
@@ -2889,7 +3355,12 @@ int OGROSMDataSource::Open(const char *pszFilename, char **papszOpenOptionsIn)
         nSize = static_cast<GIntBig>(m_nMaxSizeForInMemoryDBInMB) * 1024 * 1024;
     }
 
-    if (m_bCustomIndexing)
+    if (m_bDenseNodeIndex)
+    {
+        if (!OpenDenseNodeIndex())
+            return FALSE;
+    }
+    else if (m_bCustomIndexing)
     {
         m_pabySector = static_cast<GByte *>(VSI_CALLOC_VERBOSE(1, SECTOR_SIZE));
 
@@ -3845,7 +4316,23 @@ int OGROSMDataSource::MyResetReading()
         m_aoMapIndexedKeys.clear();
     }
 
-    if (m_bCustomIndexing)
+    if (m_bDenseNodeIndex)
+    {
+        // A complete index can be reused as it is
+        m_bDenseNodeIndexPartial = false;
+    }
+    if (m_bDenseNodeIndex && !m_bDenseNodeIndexComplete)
+    {
+        if (m_psDenseNodesMapping)
+        {
+            CPLVirtualMemFree(m_psDenseNodesMapping);
+            m_psDenseNodesMapping = nullptr;
+            m_pasDenseNodes = nullptr;
+            m_nDenseNodesCapacity = 0;
+        }
+        VSIFTruncateL(m_fpNodes, DENSE_NODES_HEADER_SIZE);
+    }
+    else if (m_bCustomIndexing && !m_bDenseNodeIndex)
     {
         m_nPrevNodeId = -1;
         m_nBucketOld = -1;
@@ -4009,6 +4496,12 @@ bool OGROSMDataSource::ParseNextChunk(int nIdxLayer,
         {
             if (eRet == OSM_EOF)
             {
+                if (m_bDenseNodeIndex && !m_bDenseNodeIndexComplete &&
+                    !m_bDenseNodeIndexPartial && !m_bStopParsing)
+                {
+                    SetDenseNodeIndexComplete();
+                }
+
                 if (m_nWayFeaturePairs != 0)
                     ProcessWaysBatch();
 
@@ -125,6 +125,12 @@ void RegisterOGROSM()
         "description='Whether to enable custom indexing.' default='YES'/>"
         "  <Option name='COMPRESS_NODES' type='boolean' description='Whether "
         "to compress nodes in temporary DB.' default='NO'/>"
+        "  <Option name='DENSE_NODE_INDEX' type='boolean' description='Whether "
+        "to store nodes in a memory-mapped array indexed by node id.' "
+        "default='NO'/>"
+        "  <Option name='NODE_CACHE_FILE' type='string' description='Filename "
+        "of a persistent node index, reused when opening the same file "
+        "again.'/>"
         "  <Option name='MAX_TMPFILE_SIZE' type='int' description='Maximum "
         "size in MB of in-memory temporary file. If it exceeds that value, it "
         "will go to disk' default='100'/>"
@@ -46,6 +46,7 @@
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 
 #ifdef HAVE_EXPAT
 #include "ogr_expat.h"
@@ -156,7 +157,7 @@ struct _OSMContext
 
     GByte *pabyBlobHeader;  // MAX_BLOB_HEADER_SIZE+EXTRA_BYTES large
 
-    CPLWorkerThreadPool *poWTP;
+    CPLJobQueue *poJobQueue;  // on the global thread pool
 
     GByte *pabyUncompressed;
     unsigned int nUncompressedAllocated;
@@ -1657,15 +1658,16 @@ static bool RunDecompressionJobs(OSMContext *psCtxt)
     for (int i = 0; i < psCtxt->nJobs; i++)
     {
         psCtxt->asJobs[i].pabyDstBase = pabyDstBase;
-        if (psCtxt->poWTP)
+        if (psCtxt->poJobQueue)
             ahJobs.push_back(&psCtxt->asJobs[i]);
         else
             DecompressFunction(&psCtxt->asJobs[i]);
     }
-    if (psCtxt->poWTP)
+    if (psCtxt->poJobQueue)
     {
-        psCtxt->poWTP->SubmitJobs(DecompressFunction, ahJobs);
-        psCtxt->poWTP->WaitCompletion();
+        for (void *hJob : ahJobs)
+            psCtxt->poJobQueue->SubmitJob(DecompressFunction, hJob);
+        psCtxt->poJobQueue->WaitCompletion();
     }
 
     bool bRet = true;
@@ -1849,7 +1851,8 @@ static bool ReadBlob(OSMContext *psCtxt, BlobType eType)
                         psCtxt->nTotalUncompressedSize;
                     psCtxt->asJobs[psCtxt->nJobs].nDstSize = nUncompressedSize;
                     psCtxt->nJobs++;
-                    if (psCtxt->poWTP == nullptr || eType != BLOB_OSMDATA)
+                    if (psCtxt->poJobQueue == nullptr ||
+                        eType != BLOB_OSMDATA)
                     {
                         if (!RunDecompressionJobsAndProcessAll(psCtxt, eType))
                         {
@@ -2012,7 +2015,7 @@ static OSMRetCode PBF_ProcessBlock(OSMContext *psCtxt)
 
         nBlobCount++;
 
-        if (eType == BLOB_OSMDATA && psCtxt->poWTP != nullptr)
+        if (eType == BLOB_OSMDATA && psCtxt->poJobQueue != nullptr)
         {
             // Accumulate BLOB_OSMDATA until we reach either the maximum
             // number of jobs or a threshold in bytes
@@ -2773,13 +2776,10 @@ OSMContext *OSM_Open(const char *pszFilename, NotifyNodesFunc pfnNotifyNodes,
         nNumCPUs = std::max(0, std::min(2 * nNumCPUs, atoi(pszNumThreads)));
     if (nNumCPUs > 1)
     {
-        psCtxt->poWTP = new CPLWorkerThreadPool();
         // coverity[tainted_data]
-        if (!psCtxt->poWTP->Setup(nNumCPUs, nullptr, nullptr))
-        {
-            delete psCtxt->poWTP;
-            psCtxt->poWTP = nullptr;
-        }
+        CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nNumCPUs);
+        if (poThreadPool)
+            psCtxt->poJobQueue = poThreadPool->CreateJobQueue().release();
     }
 
     return psCtxt;
@@ -2812,7 +2812,7 @@ void OSM_Close(OSMContext *psCtxt)
     VSIFree(psCtxt->pasTags);
     VSIFree(psCtxt->pasMembers);
     VSIFree(psCtxt->panNodeRefs);
-    delete psCtxt->poWTP;
+    delete psCtxt->poJobQueue;
 
     VSIFCloseL(psCtxt->fp);
     VSIFree(psCtxt);
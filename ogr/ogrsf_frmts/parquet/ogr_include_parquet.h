@@ -65,6 +65,7 @@
 #include "arrow/dataset/discovery.h"
 #include "arrow/dataset/file_parquet.h"
 #include "arrow/dataset/scanner.h"
+#include "arrow/compute/api_scalar.h"
 #endif
 
 #ifdef _MSC_VER
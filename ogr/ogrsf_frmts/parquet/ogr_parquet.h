@@ -31,6 +31,8 @@
 
 #include "ogrsf_frmts.h"
 
+#include "cpl_worker_thread_pool.h"
+
 #include <functional>
 #include <map>
 
@@ -182,6 +184,15 @@ class OGRParquetDatasetLayer final : public OGRParquetLayerBase
 
     void EstablishFeatureDefn();
 
+    std::shared_ptr<arrow::DataType>
+    GetArrowTypeOfField(const std::vector<int> &anPath) const;
+    bool BuildArrowFilter(const swq_expr_node *poNode,
+                          arrow::compute::Expression &expr) const;
+    bool
+    BuildArrowFilterColumnRef(const swq_expr_node *poColumn,
+                              arrow::compute::Expression &expr,
+                              std::shared_ptr<arrow::DataType> &type) const;
+
   protected:
     std::string GetDriverUCName() const override
     {
@@ -201,6 +212,7 @@ class OGRParquetDatasetLayer final : public OGRParquetLayerBase
         CSLConstList papszOpenOptions);
 
     void ResetReading() override;
+    OGRErr SetAttributeFilter(const char *pszFilter) override;
     GIntBig GetFeatureCount(int bForce) override;
     OGRErr GetExtent(OGREnvelope *psExtent, int bForce = TRUE) override;
     OGRErr GetExtent(int iGeomField, OGREnvelope *psExtent,
@@ -253,6 +265,42 @@ class OGRParquetWriterLayer final : public OGRArrowWriterLayer
     bool m_bEdgesSpherical = false;
     parquet::WriterProperties::Builder m_oWriterPropertiesBuilder{};
 
+    // Members used when SORT_BY_BBOX=YES: features are first written in a
+    // temporary GeoPackage, and re-read in Hilbert order at finalization.
+    bool m_bSortByBBOX = false;
+    std::string m_osTmpGPKGFilename{};
+    std::unique_ptr<GDALDataset> m_poTmpGPKG{};
+    OGRLayer *m_poTmpGPKGLayer = nullptr;
+
+    struct SortItem
+    {
+        double dfX = 0;  // center of the bounding box (NaN if no geometry)
+        double dfY = 0;
+        GIntBig nTmpFID = 0;
+    };
+
+    std::vector<SortItem> m_asSortItems{};
+    OGREnvelope m_sSortExtent{};
+
+    // Members used to encode, compress and write a completed row group in a
+    // worker thread, while the next one is being filled.
+    struct RowGroupJob
+    {
+        parquet::arrow::FileWriter *poFileWriter = nullptr;
+        int64_t nRows = 0;
+        std::vector<std::shared_ptr<arrow::Field>> apoFields{};
+        std::vector<std::shared_ptr<arrow::Array>> apoArrays{};
+        bool bSuccess = true;
+        std::string osErrorMsg{};
+    };
+
+    RowGroupJob m_sRowGroupJob{};
+    std::unique_ptr<CPLJobQueue> m_poRowGroupJobQueue{};
+
+    static void WriteRowGroup(RowGroupJob &sJob);
+    static void WriteRowGroupJobFunc(void *pData);
+    bool WaitRowGroupJob();
+
     virtual bool IsFileWriterCreated() const override
     {
         return m_poFileWriter != nullptr;
@@ -283,6 +331,9 @@ class OGRParquetWriterLayer final : public OGRArrowWriterLayer
 
     std::string GetGeoMetadata() const;
 
+    bool CreateTmpLayerForSort();
+    bool WriteSortedFeatures();
+
   public:
     OGRParquetWriterLayer(
         OGRParquetWriterDataset *poDS, arrow::MemoryPool *poMemoryPool,
@@ -301,6 +352,7 @@ class OGRParquetWriterLayer final : public OGRArrowWriterLayer
                            int bApproxOK = TRUE) override;
 
     int TestCapability(const char *pszCap) override;
+    OGRErr ICreateFeature(OGRFeature *poFeature) override;
 #if PARQUET_VERSION_MAJOR <= 10
     // Parquet <= 10 doesn't support the WriteRecordBatch() API
     bool IsArrowSchemaSupported(const struct ArrowSchema *schema,
@@ -326,6 +378,9 @@ class OGRParquetWriterLayer final : public OGRArrowWriterLayer
     bool IsArrowSchemaSupported(const struct ArrowSchema *schema,
                                 CSLConstList papszOptions,
                                 std::string &osErrorMsg) const override;
+    bool
+    CreateFieldFromArrowSchema(const struct ArrowSchema *schema,
+                               CSLConstList papszOptions = nullptr) override;
     bool WriteArrowBatch(const struct ArrowSchema *schema,
                          struct ArrowArray *array,
                          CSLConstList papszOptions = nullptr) override;
@@ -105,6 +105,402 @@ void OGRParquetDatasetLayer::ResetReading()
     OGRParquetLayerBase::ResetReading();
 }
 
+/************************************************************************/
+/*                        GetArrowTypeOfField()                         */
+/************************************************************************/
+
+std::shared_ptr<arrow::DataType> OGRParquetDatasetLayer::GetArrowTypeOfField(
+    const std::vector<int> &anPath) const
+{
+    std::shared_ptr<arrow::DataType> type;
+    for (size_t i = 0; i < anPath.size(); ++i)
+    {
+        if (i == 0)
+        {
+            type = m_poSchema->field(anPath[0])->type();
+        }
+        else if (type->id() == arrow::Type::STRUCT)
+        {
+            type = type->field(anPath[i])->type();
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
+    return type;
+}
+
+/************************************************************************/
+/*                      BuildArrowFilterColumnRef()                     */
+/************************************************************************/
+
+bool OGRParquetDatasetLayer::BuildArrowFilterColumnRef(
+    const swq_expr_node *poColumn, arrow::compute::Expression &expr,
+    std::shared_ptr<arrow::DataType> &type) const
+{
+    if (poColumn->eNodeType != SNT_COLUMN || poColumn->table_index != 0)
+        return false;
+    const int nFieldCount = m_poFeatureDefn->GetFieldCount();
+    std::vector<int> anPath;
+    if (poColumn->field_index >= 0 && poColumn->field_index < nFieldCount)
+    {
+        anPath = m_anMapFieldIndexToArrowColumn[poColumn->field_index];
+    }
+    else if (poColumn->field_index == nFieldCount + SPF_FID &&
+             m_iFIDArrowColumn >= 0)
+    {
+        anPath.push_back(m_iFIDArrowColumn);
+    }
+    else
+    {
+        return false;
+    }
+    type = GetArrowTypeOfField(anPath);
+    if (!type)
+        return false;
+    expr = arrow::compute::field_ref(arrow::FieldRef(arrow::FieldPath(anPath)));
+    return true;
+}
+
+/************************************************************************/
+/*                   IsSafeForCaseInsensitiveCompare()                  */
+/************************************************************************/
+
+// OGR SQL compares strings with strcasecmp(), whereas Arrow compares bytes.
+// Both orderings are the same when the constant does not contain any ASCII
+// letter or character between 'Z' and 'a'.
+// We also exclude ':' and '+' which trigger special timestamp handling in
+// OGR SQL equality.
+static bool IsSafeForCaseInsensitiveCompare(const char *pszStr)
+{
+    for (; *pszStr; ++pszStr)
+    {
+        const char ch = *pszStr;
+        if ((ch >= 'A' && ch <= 'z') || ch == ':' || ch == '+')
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                          BuildArrowFilter()                          */
+/************************************************************************/
+
+// Translate (a subset of) an OGR SQL expression into an Arrow compute
+// expression whose result is a superset of the features selected by the
+// OGR SQL expression, so that the OGR attribute filter can still be applied
+// afterwards. Returns false if no such expression can be built.
+bool OGRParquetDatasetLayer::BuildArrowFilter(
+    const swq_expr_node *poNode, arrow::compute::Expression &expr) const
+{
+    if (poNode->eNodeType != SNT_OPERATION)
+        return false;
+
+    const auto IsNumericType = [](arrow::Type::type eId)
+    {
+        return eId == arrow::Type::INT8 || eId == arrow::Type::UINT8 ||
+               eId == arrow::Type::INT16 || eId == arrow::Type::UINT16 ||
+               eId == arrow::Type::INT32 || eId == arrow::Type::UINT32 ||
+               eId == arrow::Type::INT64 || eId == arrow::Type::UINT64 ||
+               eId == arrow::Type::FLOAT || eId == arrow::Type::DOUBLE;
+    };
+
+    const auto IsStringType = [](arrow::Type::type eId)
+    { return eId == arrow::Type::STRING || eId == arrow::Type::LARGE_STRING; };
+
+    // Build a literal from a constant node that can be compared with a
+    // column of the specified type.
+    const auto BuildLiteral =
+        [&IsNumericType, &IsStringType](const swq_expr_node *poValue,
+                                        arrow::Type::type eId,
+                                        arrow::compute::Expression &lit)
+    {
+        if (poValue->eNodeType != SNT_CONSTANT || poValue->is_null)
+            return false;
+        if (IsNumericType(eId))
+        {
+            if (poValue->field_type == SWQ_INTEGER ||
+                poValue->field_type == SWQ_INTEGER64)
+            {
+                lit = arrow::compute::literal(
+                    std::make_shared<arrow::Int64Scalar>(poValue->int_value));
+                return true;
+            }
+            if (poValue->field_type == SWQ_FLOAT)
+            {
+                lit = arrow::compute::literal(
+                    std::make_shared<arrow::DoubleScalar>(
+                        poValue->float_value));
+                return true;
+            }
+        }
+        else if (IsStringType(eId) && poValue->field_type == SWQ_STRING &&
+                 IsSafeForCaseInsensitiveCompare(poValue->string_value))
+        {
+            lit = arrow::compute::literal(std::make_shared<arrow::StringScalar>(
+                std::string(poValue->string_value)));
+            return true;
+        }
+        return false;
+    };
+
+    switch (poNode->nOperation)
+    {
+        case SWQ_AND:
+        {
+            // Untranslatable terms of a conjunction may just be dropped
+            bool bHasExpr = false;
+            for (int i = 0; i < poNode->nSubExprCount; ++i)
+            {
+                arrow::compute::Expression subExpr;
+                if (BuildArrowFilter(poNode->papoSubExpr[i], subExpr))
+                {
+                    expr = bHasExpr ? arrow::compute::and_(expr, subExpr)
+                                    : subExpr;
+                    bHasExpr = true;
+                }
+            }
+            return bHasExpr;
+        }
+
+        case SWQ_OR:
+        {
+            for (int i = 0; i < poNode->nSubExprCount; ++i)
+            {
+                arrow::compute::Expression subExpr;
+                if (!BuildArrowFilter(poNode->papoSubExpr[i], subExpr))
+                    return false;
+                expr = i > 0 ? arrow::compute::or_(expr, subExpr) : subExpr;
+            }
+            return poNode->nSubExprCount > 0;
+        }
+
+        case SWQ_NOT:
+        {
+            // Only NOT (x IS NULL) is handled, since Arrow and OGR SQL do
+            // not deal with nulls the same way in other cases.
+            const auto poSubNode = poNode->papoSubExpr[0];
+            arrow::compute::Expression col;
+            std::shared_ptr<arrow::DataType> type;
+            if (poNode->nSubExprCount == 1 &&
+                poSubNode->eNodeType == SNT_OPERATION &&
+                poSubNode->nOperation == SWQ_ISNULL &&
+                poSubNode->nSubExprCount == 1 &&
+                BuildArrowFilterColumnRef(poSubNode->papoSubExpr[0], col, type))
+            {
+                expr = arrow::compute::call("is_valid", {col});
+                return true;
+            }
+            return false;
+        }
+
+        case SWQ_ISNULL:
+        {
+            arrow::compute::Expression col;
+            std::shared_ptr<arrow::DataType> type;
+            if (poNode->nSubExprCount == 1 &&
+                BuildArrowFilterColumnRef(poNode->papoSubExpr[0], col, type))
+            {
+                expr = arrow::compute::call("is_null", {col});
+                return true;
+            }
+            return false;
+        }
+
+        case SWQ_EQ:
+        case SWQ_NE:
+        case SWQ_LT:
+        case SWQ_LE:
+        case SWQ_GT:
+        case SWQ_GE:
+        {
+            const swq_expr_node *poColumn = GetColumnSubNode(poNode);
+            const swq_expr_node *poValue = GetConstantSubNode(poNode);
+            arrow::compute::Expression col;
+            arrow::compute::Expression lit;
+            std::shared_ptr<arrow::DataType> type;
+            if (!poColumn || !poValue ||
+                !BuildArrowFilterColumnRef(poColumn, col, type) ||
+                !BuildLiteral(poValue, type->id(), lit))
+            {
+                return false;
+            }
+            auto lhs = col;
+            auto rhs = lit;
+            if (poColumn != poNode->papoSubExpr[0])
+                std::swap(lhs, rhs);
+            switch (poNode->nOperation)
+            {
+                case SWQ_EQ:
+                    expr = arrow::compute::equal(lhs, rhs);
+                    break;
+                case SWQ_NE:
+                    expr = arrow::compute::not_equal(lhs, rhs);
+                    break;
+                case SWQ_LT:
+                    expr = arrow::compute::less(lhs, rhs);
+                    break;
+                case SWQ_LE:
+                    expr = arrow::compute::less_equal(lhs, rhs);
+                    break;
+                case SWQ_GT:
+                    expr = arrow::compute::greater(lhs, rhs);
+                    break;
+                default:
+                    expr = arrow::compute::greater_equal(lhs, rhs);
+                    break;
+            }
+            return true;
+        }
+
+        case SWQ_BETWEEN:
+        {
+            arrow::compute::Expression col;
+            arrow::compute::Expression litMin;
+            arrow::compute::Expression litMax;
+            std::shared_ptr<arrow::DataType> type;
+            if (poNode->nSubExprCount == 3 &&
+                BuildArrowFilterColumnRef(poNode->papoSubExpr[0], col, type) &&
+                BuildLiteral(poNode->papoSubExpr[1], type->id(), litMin) &&
+                BuildLiteral(poNode->papoSubExpr[2], type->id(), litMax))
+            {
+                expr = arrow::compute::and_(
+                    arrow::compute::greater_equal(col, litMin),
+                    arrow::compute::less_equal(col, litMax));
+                return true;
+            }
+            return false;
+        }
+
+        case SWQ_IN:
+        {
+            // Expressed as a disjunction of equalities, which does not
+            // require the value set to be of the exact type of the column.
+            arrow::compute::Expression col;
+            std::shared_ptr<arrow::DataType> type;
+            if (poNode->nSubExprCount < 2 ||
+                !BuildArrowFilterColumnRef(poNode->papoSubExpr[0], col, type))
+            {
+                return false;
+            }
+            for (int i = 1; i < poNode->nSubExprCount; ++i)
+            {
+                arrow::compute::Expression lit;
+                if (!BuildLiteral(poNode->papoSubExpr[i], type->id(), lit))
+                    return false;
+                auto subExpr = arrow::compute::equal(col, lit);
+                expr = i > 1 ? arrow::compute::or_(expr, subExpr) : subExpr;
+            }
+            return true;
+        }
+
+        case SWQ_LIKE:
+        case SWQ_ILIKE:
+        {
+            // Only handle 'prefix%' patterns without escape character
+            arrow::compute::Expression col;
+            std::shared_ptr<arrow::DataType> type;
+            if (poNode->nSubExprCount != 2 ||
+                !BuildArrowFilterColumnRef(poNode->papoSubExpr[0], col, type) ||
+                !IsStringType(type->id()))
+            {
+                return false;
+            }
+            const auto poValue = poNode->papoSubExpr[1];
+            if (poValue->eNodeType != SNT_CONSTANT ||
+                poValue->field_type != SWQ_STRING || poValue->is_null)
+            {
+                return false;
+            }
+            const std::string osPattern(poValue->string_value);
+            if (osPattern.size() < 2 || osPattern.back() != '%')
+                return false;
+            const std::string osPrefix(
+                osPattern.substr(0, osPattern.size() - 1));
+            if (osPrefix.find_first_of("%_") != std::string::npos)
+                return false;
+            const bool bInsensitive =
+                poNode->nOperation == SWQ_ILIKE ||
+                CPLTestBool(
+                    CPLGetConfigOption("OGR_SQL_LIKE_AS_ILIKE", "FALSE"));
+            if (bInsensitive &&
+                !IsSafeForCaseInsensitiveCompare(osPrefix.c_str()))
+            {
+                return false;
+            }
+            expr = arrow::compute::call(
+                "starts_with", {col},
+                arrow::compute::MatchSubstringOptions(osPrefix));
+            return true;
+        }
+
+        default:
+            break;
+    }
+
+    return false;
+}
+
+/************************************************************************/
+/*                        SetAttributeFilter()                          */
+/************************************************************************/
+
+OGRErr OGRParquetDatasetLayer::SetAttributeFilter(const char *pszFilter)
+{
+    OGRErr eErr = OGRParquetLayerBase::SetAttributeFilter(pszFilter);
+    if (eErr != OGRERR_NONE)
+        return eErr;
+
+    // Push down what we can of the attribute filter into the Arrow scanner,
+    // so that it can skip row groups based on their statistics, and
+    // evaluate the filter in a vectorized way. The OGR attribute filter is
+    // still evaluated on the returned rows.
+    arrow::compute::Expression expr = arrow::compute::literal(true);
+    if (m_poAttrQuery && CPLTestBool(CPLGetConfigOption(
+                             "OGR_PARQUET_OPTIMIZED_ATTRIBUTE_FILTER", "YES")))
+    {
+        arrow::compute::Expression filterExpr;
+        const swq_expr_node *poNode =
+            static_cast<swq_expr_node *>(m_poAttrQuery->GetSWQExpr());
+        if (BuildArrowFilter(poNode, filterExpr))
+        {
+            CPLDebug("PARQUET", "Arrow filter: %s",
+                     filterExpr.ToString().c_str());
+            expr = std::move(filterExpr);
+        }
+    }
+
+    auto poScanOptions =
+        std::make_shared<arrow::dataset::ScanOptions>(*m_poScanner->options());
+    auto scannerBuilder = std::make_shared<arrow::dataset::ScannerBuilder>(
+        m_poScanner->dataset(), poScanOptions);
+    auto status = scannerBuilder->Filter(expr);
+    if (!status.ok())
+    {
+        CPLDebug("PARQUET", "ScannerBuilder::Filter() failed: %s",
+                 status.message().c_str());
+        status = scannerBuilder->Filter(arrow::compute::literal(true));
+    }
+    if (status.ok())
+    {
+        auto result = scannerBuilder->Finish();
+        if (result.ok())
+        {
+            m_poScanner = *result;
+        }
+        else
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "ScannerBuilder::Finish() failed: %s",
+                     result.status().message().c_str());
+        }
+    }
+    ResetReading();
+
+    return OGRERR_NONE;
+}
+
 /************************************************************************/
 /*                           ReadNextBatch()                            */
 /************************************************************************/
@@ -738,6 +738,25 @@ void OGRParquetDriver::InitMetadata()
                                    "Name of creating application");
     }
 
+    {
+        auto psOption = CPLCreateXMLNode(oTree.get(), CXT_Element, "Option");
+        CPLAddXMLAttributeAndValue(psOption, "name", "WRITE_COVERING_BBOX");
+        CPLAddXMLAttributeAndValue(psOption, "type", "boolean");
+        CPLAddXMLAttributeAndValue(psOption, "description",
+                                   "Whether to write a bounding box column "
+                                   "for each geometry column");
+    }
+
+    {
+        auto psOption = CPLCreateXMLNode(oTree.get(), CXT_Element, "Option");
+        CPLAddXMLAttributeAndValue(psOption, "name", "SORT_BY_BBOX");
+        CPLAddXMLAttributeAndValue(psOption, "type", "boolean");
+        CPLAddXMLAttributeAndValue(psOption, "description",
+                                   "Whether to sort features in Hilbert order "
+                                   "of their bounding box");
+        CPLAddXMLAttributeAndValue(psOption, "default", "NO");
+    }
+
     char *pszXML = CPLSerializeXMLTree(oTree.get());
     GDALDriver::SetMetadataItem(GDAL_DS_LAYER_CREATIONOPTIONLIST, pszXML);
     CPLFree(pszXML);
@@ -91,7 +91,7 @@ void OGRParquetLayerBase::LoadGeoMetadata(
                 if (osVersion != "0.1.0" && osVersion != "0.2.0" &&
                     osVersion != "0.3.0" && osVersion != "0.4.0" &&
                     osVersion != "1.0.0-beta.1" && osVersion != "1.0.0-rc.1" &&
-                    osVersion != "1.0.0")
+                    osVersion != "1.0.0" && osVersion != "1.1.0")
                 {
                     CPLDebug(
                         "PARQUET",
@@ -522,6 +522,52 @@ void OGRParquetLayer::EstablishFeatureDefn()
     CPLAssert(static_cast<int>(m_anMapGeomFieldIndexToParquetColumn.size()) ==
               m_poFeatureDefn->GetGeomFieldCount());
 
+    // GeoParquet 1.1 "covering" of the bounding box of the primary geometry
+    // column. Takes precedence over the bbox.minx, etc. field name heuristics.
+    if (m_poFeatureDefn->GetGeomFieldCount() > 0)
+    {
+        const auto oIter = m_oMapGeometryColumns.find(
+            m_poFeatureDefn->GetGeomFieldDefn(0)->GetNameRef());
+        const auto oBBOX = oIter != m_oMapGeometryColumns.end()
+                               ? oIter->second.GetObj("covering/bbox")
+                               : CPLJSONObject();
+        if (oBBOX.IsValid() && oBBOX.GetType() == CPLJSONObject::Type::Object)
+        {
+            const auto GetBBOXField = [this, &oBBOX](const char *pszComponent)
+            {
+                const auto oPath = oBBOX.GetArray(pszComponent);
+                if (!oPath.IsValid() || oPath.Size() != 2)
+                    return -1;
+                // Subfields of struct columns are exposed as "parent.child"
+                const std::string osName =
+                    oPath[0].ToString() + '.' + oPath[1].ToString();
+                const int iField =
+                    m_poFeatureDefn->GetFieldIndex(osName.c_str());
+                if (iField < 0 ||
+                    m_apoArrowDataTypes[iField]->id() != arrow::Type::DOUBLE)
+                {
+                    CPLDebug("PARQUET",
+                             "Covering bbox column %s not found or not of "
+                             "type double",
+                             osName.c_str());
+                    return -1;
+                }
+                return iField;
+            };
+            const int iMinX = GetBBOXField("xmin");
+            const int iMinY = GetBBOXField("ymin");
+            const int iMaxX = GetBBOXField("xmax");
+            const int iMaxY = GetBBOXField("ymax");
+            if (iMinX >= 0 && iMinY >= 0 && iMaxX >= 0 && iMaxY >= 0)
+            {
+                m_iBBOXMinXField = iMinX;
+                m_iBBOXMinYField = iMinY;
+                m_iBBOXMaxXField = iMaxX;
+                m_iBBOXMaxYField = iMaxY;
+            }
+        }
+    }
+
     if (!fields.empty())
     {
         try
@@ -1055,7 +1101,8 @@ bool OGRParquetLayer::ReadNextBatch()
         bool bIterateEverything = false;
         std::vector<int> anSelectedGroups;
         const bool bUSEBBOXFields =
-            (m_poFilterGeom && m_iBBOXMinXField >= 0 && m_iBBOXMinYField >= 0 &&
+            (m_poFilterGeom && m_iGeomFieldFilter == 0 &&
+             m_iBBOXMinXField >= 0 && m_iBBOXMinYField >= 0 &&
              m_iBBOXMaxXField >= 0 && m_iBBOXMaxYField >= 0 &&
              CPLTestBool(CPLGetConfigOption(
                  ("OGR_" + GetDriverUCName() + "_USE_BBOX").c_str(), "YES")));
@@ -28,6 +28,7 @@
 
 #undef DO_NOT_DEFINE_GDAL_DATE_NAME
 #include "gdal_version_full/gdal_version.h"
+#include "gdal_thread_pool.h"
 
 #include "ogr_parquet.h"
 
@@ -35,6 +36,10 @@
 
 #include "ogr_wkb.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 /************************************************************************/
 /*                      OGRParquetWriterLayer()                         */
 /************************************************************************/
@@ -57,7 +62,11 @@ OGRParquetWriterLayer::OGRParquetWriterLayer(
 OGRParquetWriterLayer::~OGRParquetWriterLayer()
 {
     if (m_bInitializationOK)
+    {
+        if (m_poTmpGPKGLayer)
+            WriteSortedFeatures();
         FinalizeWriting();
+    }
 }
 
 /************************************************************************/
@@ -219,9 +228,42 @@ bool OGRParquetWriterLayer::SetOptions(CSLConstList papszOptions,
         }
     }
 
+    // Completed row groups are written by a worker thread, so that
+    // encoding and compression overlap with the filling of the next one.
+    const char *pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    int nNumThreads = 0;
+    if (pszNumThreads == nullptr)
+        nNumThreads = std::min(4, CPLGetNumCPUs());
+    else
+        nNumThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                       : atoi(pszNumThreads);
+    if (nNumThreads > 1)
+    {
+        auto poThreadPool = GDALGetGlobalThreadPool(nNumThreads);
+        if (poThreadPool)
+            m_poRowGroupJobQueue = poThreadPool->CreateJobQueue();
+    }
+
     m_bEdgesSpherical = EQUAL(
         CSLFetchNameValueDef(papszOptions, "EDGES", "PLANAR"), "SPHERICAL");
 
+    m_bSortByBBOX =
+        CPLTestBool(CSLFetchNameValueDef(papszOptions, "SORT_BY_BBOX", "NO"));
+    if (m_bSortByBBOX &&
+        GetGDALDriverManager()->GetDriverByName("GPKG") == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "SORT_BY_BBOX=YES requires the GPKG driver to be available");
+        return false;
+    }
+
+    // Default to writing the bounding box column when sorting, since
+    // otherwise readers cannot take advantage of the spatial clustering.
+    m_bWriteBBoxStruct = eGType != wkbNone &&
+                         CPLTestBool(CSLFetchNameValueDef(
+                             papszOptions, "WRITE_COVERING_BBOX",
+                             m_bSortByBBOX ? "YES" : "NO"));
+
     m_bInitializationOK = true;
     return true;
 }
@@ -232,6 +274,8 @@ bool OGRParquetWriterLayer::SetOptions(CSLConstList papszOptions,
 
 void OGRParquetWriterLayer::CloseFileWriter()
 {
+    WaitRowGroupJob();
+
     auto status = m_poFileWriter->Close();
     if (!status.ok())
     {
@@ -371,7 +415,8 @@ std::string OGRParquetWriterLayer::GetGeoMetadata() const
         CPLTestBool(CPLGetConfigOption("OGR_PARQUET_WRITE_GEO", "YES")))
     {
         CPLJSONObject oRoot;
-        oRoot.Add("version", "1.0.0");
+        // "covering" was introduced in GeoParquet 1.1.0
+        oRoot.Add("version", m_bWriteBBoxStruct ? "1.1.0" : "1.0.0");
         oRoot.Add("primary_column",
                   m_poFeatureDefn->GetGeomFieldDefn(0)->GetNameRef());
         CPLJSONObject oColumns;
@@ -477,6 +522,23 @@ std::string OGRParquetWriterLayer::GetGeoMetadata() const
                 oColumn.Add("bbox", oBBOX);
             }
 
+            if (m_bWriteBBoxStruct)
+            {
+                CPLJSONObject oCovering;
+                oColumn.Add("covering", oCovering);
+                CPLJSONObject oBBOX;
+                oCovering.Add("bbox", oBBOX);
+                const std::string osBBoxColumn = GetBBoxStructColumnName(i);
+                for (const char *pszComponent :
+                     {"xmin", "ymin", "xmax", "ymax"})
+                {
+                    CPLJSONArray oPath;
+                    oPath.Add(osBBoxColumn);
+                    oPath.Add(pszComponent);
+                    oBBOX.Add(pszComponent, oPath);
+                }
+            }
+
             const auto GetStringGeometryType = [](OGRwkbGeometryType eType)
             {
                 const auto eFlattenType = wkbFlatten(eType);
@@ -721,32 +783,99 @@ void OGRParquetWriterLayer::CreateWriter()
 
 bool OGRParquetWriterLayer::FlushGroup()
 {
-    auto status = m_poFileWriter->NewRowGroup(m_apoBuilders[0]->length());
-    if (!status.ok())
+    // Wait for the previous row group to be written, so that at most one
+    // row group is in flight besides the one being filled.
+    bool ret = WaitRowGroupJob();
+
+    m_sRowGroupJob.poFileWriter = m_poFileWriter.get();
+    m_sRowGroupJob.nRows = m_apoBuilders[0]->length();
+    ret = ret && WriteArrays(
+                     [this](const std::shared_ptr<arrow::Field> &field,
+                            const std::shared_ptr<arrow::Array> &array)
+                     {
+                         m_sRowGroupJob.apoFields.push_back(field);
+                         m_sRowGroupJob.apoArrays.push_back(array);
+                         return true;
+                     });
+
+    m_apoBuilders.clear();
+    if (!ret)
     {
-        CPLError(CE_Failure, CPLE_AppDefined, "NewRowGroup() failed with %s",
-                 status.message().c_str());
-        m_apoBuilders.clear();
+        m_sRowGroupJob.apoFields.clear();
+        m_sRowGroupJob.apoArrays.clear();
         return false;
     }
 
-    auto ret = WriteArrays(
-        [this](const std::shared_ptr<arrow::Field> &field,
-               const std::shared_ptr<arrow::Array> &array)
+    if (m_poRowGroupJobQueue &&
+        m_poRowGroupJobQueue->SubmitJob(WriteRowGroupJobFunc, &m_sRowGroupJob))
+    {
+        return true;
+    }
+
+    WriteRowGroup(m_sRowGroupJob);
+    return WaitRowGroupJob();
+}
+
+/************************************************************************/
+/*                           WriteRowGroup()                            */
+/************************************************************************/
+
+// May be called from a worker thread, hence errors are stored in the job
+// and emitted later by WaitRowGroupJob().
+/* static */ void OGRParquetWriterLayer::WriteRowGroup(RowGroupJob &sJob)
+{
+    auto status = sJob.poFileWriter->NewRowGroup(sJob.nRows);
+    if (!status.ok())
+    {
+        sJob.bSuccess = false;
+        sJob.osErrorMsg = "NewRowGroup() failed with " + status.message();
+    }
+
+    for (size_t i = 0; sJob.bSuccess && i < sJob.apoArrays.size(); ++i)
+    {
+        status = sJob.poFileWriter->WriteColumnChunk(*(sJob.apoArrays[i]));
+        if (!status.ok())
         {
-            auto l_status = m_poFileWriter->WriteColumnChunk(*array);
-            if (!l_status.ok())
-            {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "WriteColumnChunk() failed for field %s: %s",
-                         field->name().c_str(), l_status.message().c_str());
-                return false;
-            }
-            return true;
-        });
+            sJob.bSuccess = false;
+            sJob.osErrorMsg = "WriteColumnChunk() failed for field " +
+                              sJob.apoFields[i]->name() + ": " +
+                              status.message();
+        }
+    }
 
-    m_apoBuilders.clear();
-    return ret;
+    sJob.apoFields.clear();
+    sJob.apoArrays.clear();
+}
+
+/************************************************************************/
+/*                        WriteRowGroupJobFunc()                        */
+/************************************************************************/
+
+/* static */ void OGRParquetWriterLayer::WriteRowGroupJobFunc(void *pData)
+{
+    WriteRowGroup(*static_cast<RowGroupJob *>(pData));
+}
+
+/************************************************************************/
+/*                          WaitRowGroupJob()                           */
+/************************************************************************/
+
+// Wait for the pending row group (if any) to be written, and report the
+// error that may have occurred while writing it.
+bool OGRParquetWriterLayer::WaitRowGroupJob()
+{
+    if (m_poRowGroupJobQueue)
+        m_poRowGroupJobQueue->WaitCompletion();
+
+    if (!m_sRowGroupJob.bSuccess)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "%s",
+                 m_sRowGroupJob.osErrorMsg.c_str());
+        m_sRowGroupJob.bSuccess = true;
+        m_sRowGroupJob.osErrorMsg.clear();
+        return false;
+    }
+    return true;
 }
 
 /************************************************************************/
@@ -797,6 +926,307 @@ void OGRParquetWriterLayer::FixupGeometryBeforeWriting(OGRGeometry *poGeom)
     }
 }
 
+/************************************************************************/
+/*                       CreateTmpLayerForSort()                        */
+/************************************************************************/
+
+bool OGRParquetWriterLayer::CreateTmpLayerForSort()
+{
+    m_osTmpGPKGFilename = std::string(m_poDataset->GetDescription());
+    if (STARTS_WITH(m_osTmpGPKGFilename.c_str(), "/vsi") &&
+        !STARTS_WITH(m_osTmpGPKGFilename.c_str(), "/vsimem/"))
+    {
+        m_osTmpGPKGFilename = CPLGenerateTempFilename(nullptr);
+    }
+    m_osTmpGPKGFilename += "_tmp_sort.gpkg";
+
+    auto poGPKGDrv = GetGDALDriverManager()->GetDriverByName("GPKG");
+    if (!poGPKGDrv)
+        return false;
+    m_poTmpGPKG.reset(poGPKGDrv->Create(m_osTmpGPKGFilename.c_str(), 0, 0, 0,
+                                        GDT_Unknown, nullptr));
+    if (!m_poTmpGPKG)
+        return false;
+
+    const char *const apszLayerOptions[] = {"SPATIAL_INDEX=NO", nullptr};
+    m_poTmpGPKGLayer = m_poTmpGPKG->CreateLayer(
+        "tmp", nullptr, wkbNone, const_cast<char **>(apszLayerOptions));
+    if (!m_poTmpGPKGLayer)
+        return false;
+
+    // Field names of the temporary layer are generated, so as to avoid any
+    // conflict. Fields of types not natively handled by GeoPackage are
+    // stored as their string representation.
+    for (int i = 0; i < m_poFeatureDefn->GetFieldCount(); ++i)
+    {
+        const auto poSrcFieldDefn = m_poFeatureDefn->GetFieldDefn(i);
+        const auto eType = poSrcFieldDefn->GetType();
+        if (eType == OFTIntegerList || eType == OFTInteger64List ||
+            eType == OFTRealList || eType == OFTStringList)
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "SORT_BY_BBOX=YES is not compatible with field %s "
+                     "of type %s",
+                     poSrcFieldDefn->GetNameRef(),
+                     OGR_GetFieldTypeName(eType));
+            return false;
+        }
+        OGRFieldDefn oFieldDefn(CPLSPrintf("field_%d", i),
+                                eType == OFTTime ? OFTString : eType);
+        if (eType != OFTTime)
+            oFieldDefn.SetSubType(poSrcFieldDefn->GetSubType());
+        if (m_poTmpGPKGLayer->CreateField(&oFieldDefn) != OGRERR_NONE)
+            return false;
+    }
+    {
+        OGRFieldDefn oFieldDefn("original_fid", OFTInteger64);
+        if (m_poTmpGPKGLayer->CreateField(&oFieldDefn) != OGRERR_NONE)
+            return false;
+    }
+    for (int i = 0; i < m_poFeatureDefn->GetGeomFieldCount(); ++i)
+    {
+        OGRFieldDefn oFieldDefn(CPLSPrintf("geom_%d", i), OFTBinary);
+        if (m_poTmpGPKGLayer->CreateField(&oFieldDefn) != OGRERR_NONE)
+            return false;
+    }
+
+    return m_poTmpGPKG->StartTransaction() == OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                          ICreateFeature()                            */
+/************************************************************************/
+
+OGRErr OGRParquetWriterLayer::ICreateFeature(OGRFeature *poFeature)
+{
+    if (!m_bSortByBBOX)
+        return OGRArrowWriterLayer::ICreateFeature(poFeature);
+
+    if (!m_poTmpGPKGLayer && !CreateTmpLayerForSort())
+    {
+        m_poTmpGPKGLayer = nullptr;
+        if (m_poTmpGPKG)
+        {
+            m_poTmpGPKG.reset();
+            VSIUnlink(m_osTmpGPKGFilename.c_str());
+        }
+        return OGRERR_FAILURE;
+    }
+
+    const int nFieldCount = m_poFeatureDefn->GetFieldCount();
+    OGRFeature oTmpFeature(m_poTmpGPKGLayer->GetLayerDefn());
+    for (int i = 0; i < nFieldCount; ++i)
+    {
+        if (poFeature->IsFieldNull(i))
+            oTmpFeature.SetFieldNull(i);
+        else if (!poFeature->IsFieldSet(i))
+            continue;
+        else if (m_poFeatureDefn->GetFieldDefn(i)->GetType() == OFTTime)
+            oTmpFeature.SetField(i, poFeature->GetFieldAsString(i));
+        else
+            oTmpFeature.SetField(i, poFeature->GetRawFieldRef(i));
+    }
+    if (poFeature->GetFID() != OGRNullFID)
+        oTmpFeature.SetField(nFieldCount, poFeature->GetFID());
+
+    SortItem sItem;
+    sItem.dfX = std::numeric_limits<double>::quiet_NaN();
+    sItem.dfY = std::numeric_limits<double>::quiet_NaN();
+    for (int i = 0; i < m_poFeatureDefn->GetGeomFieldCount(); ++i)
+    {
+        const OGRGeometry *poGeom = poFeature->GetGeomFieldRef(i);
+        if (!poGeom)
+            continue;
+        const size_t nWKBSize = poGeom->WkbSize();
+        if (nWKBSize > static_cast<size_t>(INT_MAX))
+        {
+            CPLError(CE_Failure, CPLE_NotSupported, "Too large geometry");
+            return OGRERR_FAILURE;
+        }
+        m_abyBuffer.resize(nWKBSize);
+        poGeom->exportToWkb(wkbNDR, m_abyBuffer.data(), wkbVariantIso);
+        oTmpFeature.SetField(nFieldCount + 1 + i, static_cast<int>(nWKBSize),
+                             m_abyBuffer.data());
+
+        if (i == 0 && !poGeom->IsEmpty())
+        {
+            OGREnvelope sEnvelope;
+            poGeom->getEnvelope(&sEnvelope);
+            sItem.dfX = (sEnvelope.MinX + sEnvelope.MaxX) / 2;
+            sItem.dfY = (sEnvelope.MinY + sEnvelope.MaxY) / 2;
+            m_sSortExtent.Merge(sItem.dfX, sItem.dfY);
+        }
+    }
+
+    if (m_poTmpGPKGLayer->CreateFeature(&oTmpFeature) != OGRERR_NONE)
+        return OGRERR_FAILURE;
+    sItem.nTmpFID = oTmpFeature.GetFID();
+    m_asSortItems.push_back(sItem);
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                            Hilbert()                                 */
+/************************************************************************/
+
+// Based on public domain code at
+// https://github.com/rawrunprotected/hilbert_curves
+static uint32_t Hilbert(uint32_t x, uint32_t y)
+{
+    uint32_t a = x ^ y;
+    uint32_t b = 0xFFFF ^ a;
+    uint32_t c = 0xFFFF ^ (x | y);
+    uint32_t d = x & (y ^ 0xFFFF);
+
+    uint32_t A = a | (b >> 1);
+    uint32_t B = (a >> 1) ^ a;
+    uint32_t C = ((c >> 1) ^ (b & (d >> 1))) ^ c;
+    uint32_t D = ((a & (c >> 1)) ^ (d >> 1)) ^ d;
+
+    a = A;
+    b = B;
+    c = C;
+    d = D;
+    A = ((a & (a >> 2)) ^ (b & (b >> 2)));
+    B = ((a & (b >> 2)) ^ (b & ((a ^ b) >> 2)));
+    C ^= ((a & (c >> 2)) ^ (b & (d >> 2)));
+    D ^= ((b & (c >> 2)) ^ ((a ^ b) & (d >> 2)));
+
+    a = A;
+    b = B;
+    c = C;
+    d = D;
+    A = ((a & (a >> 4)) ^ (b & (b >> 4)));
+    B = ((a & (b >> 4)) ^ (b & ((a ^ b) >> 4)));
+    C ^= ((a & (c >> 4)) ^ (b & (d >> 4)));
+    D ^= ((b & (c >> 4)) ^ ((a ^ b) & (d >> 4)));
+
+    a = A;
+    b = B;
+    c = C;
+    d = D;
+    C ^= ((a & (c >> 8)) ^ (b & (d >> 8)));
+    D ^= ((b & (c >> 8)) ^ ((a ^ b) & (d >> 8)));
+
+    a = C ^ (C >> 1);
+    b = D ^ (D >> 1);
+
+    uint32_t i0 = x ^ y;
+    uint32_t i1 = b | (0xFFFF ^ (i0 | a));
+
+    i0 = (i0 | (i0 << 8)) & 0x00FF00FF;
+    i0 = (i0 | (i0 << 4)) & 0x0F0F0F0F;
+    i0 = (i0 | (i0 << 2)) & 0x33333333;
+    i0 = (i0 | (i0 << 1)) & 0x55555555;
+
+    i1 = (i1 | (i1 << 8)) & 0x00FF00FF;
+    i1 = (i1 | (i1 << 4)) & 0x0F0F0F0F;
+    i1 = (i1 | (i1 << 2)) & 0x33333333;
+    i1 = (i1 | (i1 << 1)) & 0x55555555;
+
+    return (i1 << 1) | i0;
+}
+
+/************************************************************************/
+/*                        WriteSortedFeatures()                         */
+/************************************************************************/
+
+bool OGRParquetWriterLayer::WriteSortedFeatures()
+{
+    bool bRet = m_poTmpGPKG->CommitTransaction() == OGRERR_NONE;
+
+    // Compute the Hilbert code of the center of the bounding box of each
+    // feature, on a 65536x65536 grid covering the extent of those centers.
+    // Features without geometry are put at the end.
+    constexpr uint32_t HILBERT_MAX = (1 << 16) - 1;
+    const double dfWidth = m_sSortExtent.MaxX - m_sSortExtent.MinX;
+    const double dfHeight = m_sSortExtent.MaxY - m_sSortExtent.MinY;
+    std::vector<std::pair<uint64_t, GIntBig>> anCodeAndFID;
+    anCodeAndFID.reserve(m_asSortItems.size());
+    for (const auto &sItem : m_asSortItems)
+    {
+        uint64_t nCode = static_cast<uint64_t>(1) << 32;
+        if (!std::isnan(sItem.dfX))
+        {
+            const uint32_t x =
+                dfWidth > 0 ? static_cast<uint32_t>(
+                                  HILBERT_MAX *
+                                  ((sItem.dfX - m_sSortExtent.MinX) / dfWidth))
+                            : 0;
+            const uint32_t y =
+                dfHeight > 0
+                    ? static_cast<uint32_t>(
+                          HILBERT_MAX *
+                          ((sItem.dfY - m_sSortExtent.MinY) / dfHeight))
+                    : 0;
+            nCode = Hilbert(x, y);
+        }
+        anCodeAndFID.emplace_back(nCode, sItem.nTmpFID);
+    }
+    m_asSortItems.clear();
+    m_asSortItems.shrink_to_fit();
+    std::sort(anCodeAndFID.begin(), anCodeAndFID.end());
+
+    const int nFieldCount = m_poFeatureDefn->GetFieldCount();
+    for (size_t iItem = 0; bRet && iItem < anCodeAndFID.size(); ++iItem)
+    {
+        std::unique_ptr<OGRFeature> poTmpFeature(
+            m_poTmpGPKGLayer->GetFeature(anCodeAndFID[iItem].second));
+        if (!poTmpFeature)
+        {
+            bRet = false;
+            break;
+        }
+
+        OGRFeature oFeature(m_poFeatureDefn);
+        for (int i = 0; i < nFieldCount; ++i)
+        {
+            if (poTmpFeature->IsFieldNull(i))
+                oFeature.SetFieldNull(i);
+            else if (!poTmpFeature->IsFieldSet(i))
+                continue;
+            else if (m_poFeatureDefn->GetFieldDefn(i)->GetType() == OFTTime)
+                oFeature.SetField(i, poTmpFeature->GetFieldAsString(i));
+            else
+                oFeature.SetField(i, poTmpFeature->GetRawFieldRef(i));
+        }
+        if (poTmpFeature->IsFieldSetAndNotNull(nFieldCount))
+            oFeature.SetFID(poTmpFeature->GetFieldAsInteger64(nFieldCount));
+        for (int i = 0; i < m_poFeatureDefn->GetGeomFieldCount(); ++i)
+        {
+            const int iTmpField = nFieldCount + 1 + i;
+            if (!poTmpFeature->IsFieldSetAndNotNull(iTmpField))
+                continue;
+            int nWKBSize = 0;
+            const GByte *pabyWKB =
+                poTmpFeature->GetFieldAsBinary(iTmpField, &nWKBSize);
+            OGRGeometry *poGeom = nullptr;
+            if (OGRGeometryFactory::createFromWkb(
+                    pabyWKB,
+                    m_poFeatureDefn->GetGeomFieldDefn(i)->GetSpatialRef(),
+                    &poGeom, nWKBSize) != OGRERR_NONE)
+            {
+                bRet = false;
+                break;
+            }
+            oFeature.SetGeomFieldDirectly(i, poGeom);
+        }
+
+        if (bRet && OGRArrowWriterLayer::ICreateFeature(&oFeature) !=
+                        OGRERR_NONE)
+        {
+            bRet = false;
+        }
+    }
+
+    m_poTmpGPKGLayer = nullptr;
+    m_poTmpGPKG.reset();
+    VSIUnlink(m_osTmpGPKGFilename.c_str());
+
+    return bRet;
+}
+
 /************************************************************************/
 /*                          WriteArrowBatch()                           */
 /************************************************************************/
@@ -807,10 +1237,18 @@ OGRParquetWriterLayer::WriteArrowBatch(const struct ArrowSchema *schema,
                                        struct ArrowArray *array,
                                        CSLConstList papszOptions)
 {
+    // The bounding box column and the sorting are not implemented in the
+    // Arrow batch code path. Go through OGRFeature.
+    if (m_bWriteBBoxStruct || m_bSortByBBOX)
+        return OGRLayer::WriteArrowBatch(schema, array, papszOptions);
+
     return WriteArrowBatchInternal(
         schema, array, papszOptions,
         [this](const std::shared_ptr<arrow::RecordBatch> &poBatch)
         {
+            if (!WaitRowGroupJob())
+                return false;
+
             auto status = m_poFileWriter->NewBufferedRowGroup();
             if (!status.ok())
             {
@@ -844,9 +1282,31 @@ inline int OGRParquetWriterLayer::TestCapability(const char *pszCap)
     if (EQUAL(pszCap, OLCFastWriteArrowBatch))
         return false;
 #endif
+    if ((m_bWriteBBoxStruct || m_bSortByBBOX) &&
+        EQUAL(pszCap, OLCFastWriteArrowBatch))
+    {
+        return false;
+    }
     return OGRArrowWriterLayer::TestCapability(pszCap);
 }
 
+/************************************************************************/
+/*                      CreateFieldFromArrowSchema()                    */
+/************************************************************************/
+
+#if PARQUET_VERSION_MAJOR > 10
+bool OGRParquetWriterLayer::CreateFieldFromArrowSchema(
+    const struct ArrowSchema *schema, CSLConstList papszOptions)
+{
+    // Cf WriteArrowBatch()
+    if (m_bWriteBBoxStruct || m_bSortByBBOX)
+        return OGRLayer::CreateFieldFromArrowSchema(schema, papszOptions);
+
+    return OGRArrowWriterLayer::CreateFieldFromArrowSchema(schema,
+                                                           papszOptions);
+}
+#endif
+
 /************************************************************************/
 /*                        IsArrowSchemaSupported()                      */
 /************************************************************************/
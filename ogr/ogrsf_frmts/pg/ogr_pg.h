@@ -213,6 +213,8 @@ class OGRPGLayer CPL_NON_FINAL : public OGRLayer
     char *pszFIDColumn = nullptr;
 
     int bCanUseBinaryCursor = true;
+    // Whether the rows of the current cursor are fetched in binary format
+    bool m_bBinaryFetch = false;
     int *m_panMapFieldNameToIndex = nullptr;
     int *m_panMapFieldNameToGeomIndex = nullptr;
 
@@ -234,6 +236,9 @@ class OGRPGLayer CPL_NON_FINAL : public OGRLayer
 
     int ReadResultDefinition(PGresult *hInitialResultIn);
 
+    bool CanUseBinaryFetch(PGresult *hDescResult);
+    PGresult *FetchFromCursor(const char *pszCommand);
+
     OGRFeature *RecordToFeature(PGresult *hResult,
                                 const int *panMapFieldNameToIndex,
                                 const int *panMapFieldNameToGeomIndex,
@@ -630,6 +635,9 @@ class OGRPGDataSource final : public OGRDataSource
 
     int bUseBinaryCursor = false;
     int bBinaryTimeFormatIsInt8 = false;
+    // Whether rows of cursors can be fetched in binary format, when all
+    // their columns have a supported type
+    bool m_bUseBinaryFetch = false;
 
     bool m_bHasGeometryColumns = false;
     bool m_bHasSpatialRefSys = false;
@@ -819,6 +819,22 @@ int OGRPGDataSource::Open(const char *pszNewName, int bUpdate, int bTestOpen,
     }
     OGRPGClearResult(hResult);
 
+    /* -------------------------------------------------------------------- */
+    /*      Check if cursor rows can be fetched in binary format. The       */
+    /*      decoding of date/time values assumes integer datetimes, which   */
+    /*      are the only ones available since PostgreSQL 10.                */
+    /* -------------------------------------------------------------------- */
+    if (!bUseBinaryCursor &&
+        CPLTestBool(CPLGetConfigOption("PG_USE_BINARY_FETCH", "YES")))
+    {
+        const char *pszIntegerDatetimes =
+            PQparameterStatus(hPGConn, "integer_datetimes");
+        m_bUseBinaryFetch =
+            pszIntegerDatetimes && EQUAL(pszIntegerDatetimes, "on");
+        if (!m_bUseBinaryFetch)
+            CPLDebug("PG", "Binary fetch disabled: no integer datetimes");
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Test if time binary format is int8 or float8                    */
 /* -------------------------------------------------------------------- */
@@ -61,8 +61,10 @@ PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include "ogr_p.h"
 #include "cpl_conv.h"
 #include "cpl_string.h"
+#include "cpl_time.h"
 
 #include <limits>
+#include <string>
 
 #define PQexec this_is_an_error
 
@@ -403,6 +405,294 @@ static int OGRPGTimeStamp2DMYHMS(GIntBig dt, int *year, int *month, int *day,
 
 #endif  // defined(BINARY_CURSOR_ENABLED)
 
+/************************************************************************/
+/*                    OGRPGIsBinaryFetchSupportedOID()                  */
+/************************************************************************/
+
+/* Types whose binary representation can be decoded by */
+/* OGRPGSetFieldFromBinary() */
+static bool OGRPGIsBinaryFetchSupportedOID(Oid nTypeOID,
+                                           OGRFieldType eOGRType)
+{
+    switch (nTypeOID)
+    {
+        case BOOLOID:
+        case INT2OID:
+        case INT4OID:
+        case INT8OID:
+        case FLOAT4OID:
+        case FLOAT8OID:
+        case NUMERICOID:
+        case TEXTOID:
+        case VARCHAROID:
+        case BPCHAROID:
+        case NAMEOID:
+        case JSONOID:
+        case JSONBOID:
+        case UUIDOID:
+        case DATEOID:
+        case TIMEOID:
+        case TIMESTAMPOID:
+            return eOGRType != OFTBinary && eOGRType != OFTIntegerList &&
+                   eOGRType != OFTInteger64List && eOGRType != OFTRealList &&
+                   eOGRType != OFTStringList;
+        case BYTEAOID:
+            return eOGRType == OFTBinary;
+        default:
+            // In particular timestamptz, whose binary representation is
+            // in UTC, whereas its text one is in the session time zone.
+            break;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                     OGRPGGetBinaryNumericAsString()                  */
+/************************************************************************/
+
+/* Format a binary numeric value the same way as numeric_out() */
+static std::string OGRPGGetBinaryNumericAsString(const GByte *pabyData,
+                                                 int nLength)
+{
+    if (nLength < 4 * 2)
+        return std::string();
+    GUInt16 anHeader[4];
+    memcpy(anHeader, pabyData, sizeof(anHeader));
+    for (auto &nVal : anHeader)
+        CPL_MSBPTR16(&nVal);
+    const int nDigits = anHeader[0];
+    const int nWeight = static_cast<GInt16>(anHeader[1]);
+    const int nSign = anHeader[2];
+    const int nDScale = anHeader[3];
+    if (nLength < (4 + nDigits) * 2)
+        return std::string();
+
+    if (nSign == 0xC000)
+        return "NaN";
+    if (nSign == 0xD000)
+        return "Infinity";
+    if (nSign == 0xF000)
+        return "-Infinity";
+
+    const auto GetDigit = [pabyData, nDigits](int i)
+    {
+        if (i < 0 || i >= nDigits)
+            return 0;
+        GUInt16 nDigit;
+        memcpy(&nDigit, pabyData + (4 + i) * 2, sizeof(nDigit));
+        CPL_MSBPTR16(&nDigit);
+        return static_cast<int>(nDigit);
+    };
+
+    std::string osRet;
+    if (nSign == 0x4000)
+        osRet += '-';
+    if (nWeight < 0)
+    {
+        osRet += '0';
+    }
+    else
+    {
+        for (int i = 0; i <= nWeight; i++)
+        {
+            osRet += CPLSPrintf(i == 0 ? "%d" : "%04d", GetDigit(i));
+        }
+    }
+    if (nDScale > 0)
+    {
+        osRet += '.';
+        const size_t nDotPos = osRet.size();
+        for (int i = nWeight + 1; osRet.size() - nDotPos < size_t(nDScale);
+             i++)
+        {
+            osRet += CPLSPrintf("%04d", GetDigit(i));
+        }
+        osRet.resize(nDotPos + nDScale);
+    }
+    return osRet;
+}
+
+/************************************************************************/
+/*                        OGRPGSetFieldFromBinary()                     */
+/************************************************************************/
+
+/* Number of seconds between 1970-01-01 and 2000-01-01, the PostgreSQL */
+/* epoch for date/time values */
+constexpr GIntBig POSTGRES_EPOCH_UNIX_SECONDS = 946684800;
+
+static void OGRPGSetFieldFromBinary(OGRFeature *poFeature, int iOGRField,
+                                    Oid nTypeOID, const char *pszData,
+                                    int nLength)
+{
+    const GByte *pabyData = reinterpret_cast<const GByte *>(pszData);
+    switch (nTypeOID)
+    {
+        case BOOLOID:
+            if (nLength == 1)
+                poFeature->SetField(iOGRField, pabyData[0] ? 1 : 0);
+            break;
+
+        case INT2OID:
+            if (nLength == 2)
+            {
+                GInt16 nVal;
+                memcpy(&nVal, pabyData, sizeof(nVal));
+                CPL_MSBPTR16(&nVal);
+                poFeature->SetField(iOGRField, static_cast<int>(nVal));
+            }
+            break;
+
+        case INT4OID:
+            if (nLength == 4)
+            {
+                GInt32 nVal;
+                memcpy(&nVal, pabyData, sizeof(nVal));
+                CPL_MSBPTR32(&nVal);
+                poFeature->SetField(iOGRField, static_cast<int>(nVal));
+            }
+            break;
+
+        case INT8OID:
+            if (nLength == 8)
+            {
+                GInt64 nVal;
+                memcpy(&nVal, pabyData, sizeof(nVal));
+                CPL_MSBPTR64(&nVal);
+                poFeature->SetField(iOGRField, static_cast<GIntBig>(nVal));
+            }
+            break;
+
+        case FLOAT4OID:
+            if (nLength == 4)
+            {
+                float fVal;
+                memcpy(&fVal, pabyData, sizeof(fVal));
+                CPL_MSBPTR32(&fVal);
+                poFeature->SetField(iOGRField, static_cast<double>(fVal));
+            }
+            break;
+
+        case FLOAT8OID:
+            if (nLength == 8)
+            {
+                double dfVal;
+                memcpy(&dfVal, pabyData, sizeof(dfVal));
+                CPL_MSBPTR64(&dfVal);
+                poFeature->SetField(iOGRField, dfVal);
+            }
+            break;
+
+        case NUMERICOID:
+        {
+            const std::string osVal =
+                OGRPGGetBinaryNumericAsString(pabyData, nLength);
+            if (!osVal.empty())
+                poFeature->SetField(iOGRField, osVal.c_str());
+            break;
+        }
+
+        case JSONBOID:
+            // Skip the version byte of the jsonb binary format
+            if (nLength >= 1 && pabyData[0] == 1)
+                poFeature->SetField(iOGRField, pszData + 1);
+            break;
+
+        case UUIDOID:
+            if (nLength == 16)
+            {
+                poFeature->SetField(
+                    iOGRField,
+                    CPLSPrintf("%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-"
+                               "%02x%02x%02x%02x%02x%02x",
+                               pabyData[0], pabyData[1], pabyData[2],
+                               pabyData[3], pabyData[4], pabyData[5],
+                               pabyData[6], pabyData[7], pabyData[8],
+                               pabyData[9], pabyData[10], pabyData[11],
+                               pabyData[12], pabyData[13], pabyData[14],
+                               pabyData[15]));
+            }
+            break;
+
+        case BYTEAOID:
+            poFeature->SetField(iOGRField, nLength, pabyData);
+            break;
+
+        case DATEOID:
+            if (nLength == 4)
+            {
+                // Days since 2000-01-01. Extreme values are +/- infinity,
+                // which the text path cannot parse either.
+                GInt32 nVal;
+                memcpy(&nVal, pabyData, sizeof(nVal));
+                CPL_MSBPTR32(&nVal);
+                if (nVal == std::numeric_limits<GInt32>::max() ||
+                    nVal == std::numeric_limits<GInt32>::min())
+                    break;
+                struct tm brokendowntime;
+                CPLUnixTimeToYMDHMS(POSTGRES_EPOCH_UNIX_SECONDS +
+                                        static_cast<GIntBig>(nVal) * 86400,
+                                    &brokendowntime);
+                poFeature->SetField(iOGRField, brokendowntime.tm_year + 1900,
+                                    brokendowntime.tm_mon + 1,
+                                    brokendowntime.tm_mday);
+            }
+            break;
+
+        case TIMEOID:
+            if (nLength == 8)
+            {
+                // Microseconds since midnight
+                GInt64 nVal;
+                memcpy(&nVal, pabyData, sizeof(nVal));
+                CPL_MSBPTR64(&nVal);
+                const int nHour = static_cast<int>(nVal / 3600000000LL);
+                const int nMinute =
+                    static_cast<int>((nVal / 60000000LL) % 60);
+                const double dfSecond =
+                    static_cast<double>(nVal % 60000000LL) / 1e6;
+                poFeature->SetField(iOGRField, 0, 0, 0, nHour, nMinute,
+                                    static_cast<float>(dfSecond), 0);
+            }
+            break;
+
+        case TIMESTAMPOID:
+            if (nLength == 8)
+            {
+                // Microseconds since 2000-01-01 00:00:00
+                GInt64 nVal;
+                memcpy(&nVal, pabyData, sizeof(nVal));
+                CPL_MSBPTR64(&nVal);
+                if (nVal == std::numeric_limits<GInt64>::max() ||
+                    nVal == std::numeric_limits<GInt64>::min())
+                    break;
+                GInt64 nSeconds = nVal / 1000000;
+                GInt64 nMicroSeconds = nVal % 1000000;
+                if (nMicroSeconds < 0)
+                {
+                    nSeconds--;
+                    nMicroSeconds += 1000000;
+                }
+                struct tm brokendowntime;
+                CPLUnixTimeToYMDHMS(POSTGRES_EPOCH_UNIX_SECONDS + nSeconds,
+                                    &brokendowntime);
+                poFeature->SetField(
+                    iOGRField, brokendowntime.tm_year + 1900,
+                    brokendowntime.tm_mon + 1, brokendowntime.tm_mday,
+                    brokendowntime.tm_hour, brokendowntime.tm_min,
+                    static_cast<float>(brokendowntime.tm_sec +
+                                       nMicroSeconds / 1e6),
+                    0);
+            }
+            break;
+
+        default:
+            // Text types: the binary representation is the text one, and
+            // libpq always appends a nul terminating byte.
+            poFeature->SetField(iOGRField, pszData);
+            break;
+    }
+}
+
 /************************************************************************/
 /*                   TokenizeStringListFromText()                       */
 /*                                                                      */
@@ -566,6 +856,10 @@ OGRFeature *OGRPGLayer::RecordToFeature(PGresult *hResult,
         int nTypeOID = PQftype(hResult, iField);
 #endif
         const char *pszFieldName = PQfname(hResult, iField);
+        // Binary results not coming from a BINARY CURSOR come from
+        // FetchFromCursor(), and have been checked by CanUseBinaryFetch()
+        const bool bBinaryFetch =
+            !poDS->bUseBinaryCursor && PQfformat(hResult, iField) == 1;
 
         /* --------------------------------------------------------------------
          */
@@ -574,6 +868,29 @@ OGRFeature *OGRPGLayer::RecordToFeature(PGresult *hResult,
          */
         if (pszFIDColumn != nullptr && EQUAL(pszFieldName, pszFIDColumn))
         {
+            if (bBinaryFetch)
+            {
+                const GByte *pabyData = reinterpret_cast<const GByte *>(
+                    PQgetvalue(hResult, iRecord, iField));
+                const int nLength = PQgetlength(hResult, iRecord, iField);
+                if (nLength == 4)
+                {
+                    GInt32 nVal;
+                    memcpy(&nVal, pabyData, sizeof(nVal));
+                    CPL_MSBPTR32(&nVal);
+                    poFeature->SetFID(nVal);
+                }
+                else if (nLength == 8)
+                {
+                    GInt64 nVal;
+                    memcpy(&nVal, pabyData, sizeof(nVal));
+                    CPL_MSBPTR64(&nVal);
+                    poFeature->SetFID(static_cast<GIntBig>(nVal));
+                }
+                else
+                    continue;
+            }
+            else
 #if defined(BINARY_CURSOR_ENABLED)
             if (PQfformat(hResult, iField) == 1)  // Binary data representation
             {
@@ -629,7 +946,27 @@ OGRFeature *OGRPGLayer::RecordToFeature(PGresult *hResult,
             (poGeomFieldDefn->ePostgisType == GEOM_TYPE_GEOMETRY ||
              poGeomFieldDefn->ePostgisType == GEOM_TYPE_GEOGRAPHY))
         {
-            if (STARTS_WITH_CI(pszFieldName, "ST_AsBinary") ||
+            if (bBinaryFetch)
+            {
+                /* The binary form of geometry and geography is EWKB */
+                if (PQgetisnull(hResult, iRecord, iField))
+                    continue;
+                GByte *pabyData = reinterpret_cast<GByte *>(
+                    PQgetvalue(hResult, iRecord, iField));
+                const int nLength = PQgetlength(hResult, iRecord, iField);
+                OGRGeometry *poGeom =
+                    OGRGeometryFromEWKB(pabyData, nLength, nullptr,
+                                        poDS->sPostGISVersion.nMajor < 2);
+                if (poGeom != nullptr)
+                {
+                    poGeom->assignSpatialReference(
+                        poGeomFieldDefn->GetSpatialRef());
+                    poFeature->SetGeomFieldDirectly(iOGRGeomField, poGeom);
+                }
+
+                continue;
+            }
+            else if (STARTS_WITH_CI(pszFieldName, "ST_AsBinary") ||
                 STARTS_WITH_CI(pszFieldName, "AsBinary"))
             {
                 const char *pszVal = PQgetvalue(hResult, iRecord, iField);
@@ -851,6 +1188,15 @@ OGRFeature *OGRPGLayer::RecordToFeature(PGresult *hResult,
             continue;
         }
 
+        if (bBinaryFetch)
+        {
+            OGRPGSetFieldFromBinary(poFeature, iOGRField,
+                                    PQftype(hResult, iField),
+                                    PQgetvalue(hResult, iRecord, iField),
+                                    PQgetlength(hResult, iRecord, iField));
+            continue;
+        }
+
         OGRFieldType eOGRType =
             poFeatureDefn->GetFieldDefn(iOGRField)->GetType();
 
@@ -1484,6 +1830,66 @@ void OGRPGLayer::CreateMapFromFieldNameToIndex(PGresult *hResult,
     }
 }
 
+/************************************************************************/
+/*                          CanUseBinaryFetch()                         */
+/************************************************************************/
+
+/* Check that all the columns described by hDescResult can be decoded */
+/* from their binary representation by RecordToFeature() */
+bool OGRPGLayer::CanUseBinaryFetch(PGresult *hDescResult)
+{
+    for (int iField = 0; iField < PQnfields(hDescResult); iField++)
+    {
+        const char *pszName = PQfname(hDescResult, iField);
+        const Oid nTypeOID = PQftype(hDescResult, iField);
+        bool bOK;
+        if (pszFIDColumn != nullptr && EQUAL(pszName, pszFIDColumn))
+        {
+            bOK = nTypeOID == INT4OID || nTypeOID == INT8OID;
+        }
+        else if (poFeatureDefn->GetFieldIndex(pszName) >= 0)
+        {
+            const int iOGRField = poFeatureDefn->GetFieldIndex(pszName);
+            bOK = OGRPGIsBinaryFetchSupportedOID(
+                nTypeOID, poFeatureDefn->GetFieldDefn(iOGRField)->GetType());
+        }
+        else if (poFeatureDefn->GetGeomFieldIndex(pszName) >= 0)
+        {
+            const auto poGeomFieldDefn = poFeatureDefn->GetGeomFieldDefn(
+                poFeatureDefn->GetGeomFieldIndex(pszName));
+            bOK = (poGeomFieldDefn->ePostgisType == GEOM_TYPE_GEOMETRY &&
+                   nTypeOID == poDS->GetGeometryOID()) ||
+                  (poGeomFieldDefn->ePostgisType == GEOM_TYPE_GEOGRAPHY &&
+                   nTypeOID == poDS->GetGeographyOID());
+        }
+        else
+        {
+            // Columns such as ST_AsText_xxx are mapped to geometry fields
+            // in text format. Other columns are ignored.
+            bOK = OGRPGIsKnownGeomFuncPrefix(pszName) < 0;
+        }
+        if (!bOK)
+        {
+            CPLDebug("PG",
+                     "Column %s of type OID %u cannot be fetched in binary "
+                     "format",
+                     pszName, static_cast<unsigned>(nTypeOID));
+            return false;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                          FetchFromCursor()                           */
+/************************************************************************/
+
+PGresult *OGRPGLayer::FetchFromCursor(const char *pszCommand)
+{
+    return OGRPG_PQexec(poDS->GetPGConn(), pszCommand, FALSE, FALSE,
+                        m_bBinaryFetch ? 1 : 0);
+}
+
 /************************************************************************/
 /*                     SetInitialQueryCursor()                          */
 /************************************************************************/
@@ -1507,15 +1913,30 @@ void OGRPGLayer::SetInitialQueryCursor()
                          pszQueryStatement);
 
     hCursorResult = OGRPG_PQexec(hPGConn, osCommand);
+    m_bBinaryFetch = false;
     if (!hCursorResult || PQresultStatus(hCursorResult) != PGRES_COMMAND_OK)
     {
         CPLError(CE_Failure, CPLE_AppDefined, "%s", PQerrorMessage(hPGConn));
         poDS->SoftRollbackTransaction();
     }
+    else if (poDS->m_bUseBinaryFetch)
+    {
+        /* Check the column types of the cursor before fetching its rows */
+        /* The unquoted cursor name has been folded to lower case */
+        PGresult *hDescResult = PQdescribePortal(
+            hPGConn, CPLString(pszCursorName).tolower().c_str());
+        if (hDescResult && PQresultStatus(hDescResult) == PGRES_COMMAND_OK)
+        {
+            m_bBinaryFetch = CanUseBinaryFetch(hDescResult);
+        }
+        OGRPGClearResult(hDescResult);
+        CPLDebug("PG", "Rows of %s fetched in %s format", GetName(),
+                 m_bBinaryFetch ? "binary" : "text");
+    }
     OGRPGClearResult(hCursorResult);
 
     osCommand.Printf("FETCH %d in %s", nCursorPage, pszCursorName);
-    hCursorResult = OGRPG_PQexec(hPGConn, osCommand);
+    hCursorResult = FetchFromCursor(osCommand);
 
     CreateMapFromFieldNameToIndex(hCursorResult, poFeatureDefn,
                                   m_panMapFieldNameToIndex,
@@ -1531,7 +1952,6 @@ void OGRPGLayer::SetInitialQueryCursor()
 OGRFeature *OGRPGLayer::GetNextRawFeature()
 
 {
-    PGconn *hPGConn = poDS->GetPGConn();
     CPLString osCommand;
 
     if (bInvalidated)
@@ -1577,7 +1997,7 @@ OGRFeature *OGRPGLayer::GetNextRawFeature()
         OGRPGClearResult(hCursorResult);
 
         osCommand.Printf("FETCH %d in %s", nCursorPage, pszCursorName);
-        hCursorResult = OGRPG_PQexec(hPGConn, osCommand);
+        hCursorResult = FetchFromCursor(osCommand);
 
         nResultOffset = 0;
     }
@@ -1637,7 +2057,6 @@ OGRErr OGRPGLayer::SetNextByIndex(GIntBig nIndex)
         return OGRERR_NONE;
     }
 
-    PGconn *hPGConn = poDS->GetPGConn();
     CPLString osCommand;
 
     if (hCursorResult == nullptr)
@@ -1649,7 +2068,7 @@ OGRErr OGRPGLayer::SetNextByIndex(GIntBig nIndex)
 
     osCommand.Printf("FETCH ABSOLUTE " CPL_FRMT_GIB " in %s", nIndex + 1,
                      pszCursorName);
-    hCursorResult = OGRPG_PQexec(hPGConn, osCommand);
+    hCursorResult = FetchFromCursor(osCommand);
 
     if (PQresultStatus(hCursorResult) != PGRES_TUPLES_OK ||
         PQntuples(hCursorResult) != 1)
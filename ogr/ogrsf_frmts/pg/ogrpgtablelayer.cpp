@@ -1349,10 +1349,10 @@ CPLString OGRPGTableLayer::BuildFields()
         if (!osFieldList.empty())
             osFieldList += ", ";
 
-#if defined(BINARY_CURSOR_ENABLED)
-        /* With a binary cursor, it is not possible to get the time zone */
-        /* of a timestamptz column. So we fallback to asking it in text mode */
-        if (poDS->bUseBinaryCursor &&
+        /* With a binary cursor or binary fetch, it is not possible to get */
+        /* the time zone of a timestamptz column. So we fallback to asking */
+        /* it in text mode */
+        if ((poDS->bUseBinaryCursor || poDS->m_bUseBinaryFetch) &&
             poFeatureDefn->GetFieldDefn(i)->GetType() == OFTDateTime)
         {
             osFieldList += "CAST (";
@@ -1360,7 +1360,6 @@ CPLString OGRPGTableLayer::BuildFields()
             osFieldList += " AS text)";
         }
         else
-#endif
         {
             osFieldList += OGRPGEscapeColumnName(pszName);
         }
@@ -34,12 +34,16 @@
 /************************************************************************/
 
 PGresult *OGRPG_PQexec(PGconn *conn, const char *query,
-                       int bMultipleCommandAllowed, int bErrorAsDebug)
+                       int bMultipleCommandAllowed, int bErrorAsDebug,
+                       int nResultFormat)
 {
+    // nResultFormat = 1 requests binary results. This is only possible
+    // through the extended query protocol, i.e. with PQexecParams()
+    CPLAssert(nResultFormat == 0 || !bMultipleCommandAllowed);
     PGresult *hResult = bMultipleCommandAllowed
                             ? PQexec(conn, query)
                             : PQexecParams(conn, query, 0, nullptr, nullptr,
-                                           nullptr, nullptr, 0);
+                                           nullptr, nullptr, nResultFormat);
 
 #ifdef DEBUG
     const char *pszRetCode = "UNKNOWN";
@@ -34,7 +34,7 @@
 
 PGresult *OGRPG_PQexec(PGconn *conn, const char *query,
                        int bMultipleCommandAllowed = FALSE,
-                       int bErrorAsDebug = FALSE);
+                       int bErrorAsDebug = FALSE, int nResultFormat = 0);
 
 /************************************************************************/
 /*                            OGRPGClearResult                          */
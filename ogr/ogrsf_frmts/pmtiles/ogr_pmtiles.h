@@ -37,6 +37,7 @@
 
 #include "include_pmtiles.h"
 
+#include <deque>
 #include <limits>
 #include <set>
 #include <stack>
@@ -110,6 +111,30 @@ class OGRPMTilesDataset final : public GDALDataset
      */
     const std::string *ReadTileData(uint64_t nOffset, uint64_t nSize);
 
+    /** Read and decompress the data of several tiles at once, using
+     * VSIVirtualHandle::ReadMultiRange(), so that network file systems
+     * can fetch them in a single round.
+     *
+     * @param anOffsets Offsets of the tiles (as returned by
+     *                  OGRPMTilesTileIterator::GetNextTile())
+     * @param anSizes   Sizes of the tiles
+     * @param aosData   Output decompressed tile data, of the same size as
+     *                  anOffsets.
+     * @return true in case of success.
+     */
+    bool ReadTileDataMulti(const std::vector<uint64_t> &anOffsets,
+                           const std::vector<uint64_t> &anSizes,
+                           std::vector<std::string> &aosData);
+
+    /** Return the deserialized entries of the directory at the specified
+     * location, or nullptr in case of error.
+     *
+     * Directories are cached in a process-wide cache, shared by all
+     * datasets opened on the same file.
+     */
+    std::shared_ptr<const std::vector<pmtiles::entryv3>>
+    ReadDirectory(uint64_t nOffset, uint64_t nSize);
+
   private:
     VSIVirtualHandleUniquePtr m_poFile{};
 
@@ -145,11 +170,17 @@ class OGRPMTilesDataset final : public GDALDataset
     //! Maximum zoom level got from header
     int m_nMaxZoomLevel = 0;
 
+    //! Prefix of the keys of the directory cache for this file
+    std::string m_osDirectoryCacheKeyPrefix{};
+
     /** Return a short-lived decompressed buffer, or nullptr in case of error
      */
     const std::string *Read(const CPLCompressor *psDecompressor,
                             uint64_t nOffset, uint64_t nSize);
 
+    bool Decompress(const CPLCompressor *psDecompressor,
+                    const std::string &osIn, std::string &osOut);
+
     CPL_DISALLOW_COPY_ASSIGN(OGRPMTilesDataset)
 };
 
@@ -215,14 +246,20 @@ class OGRPMTilesTileIterator
     {
         // Entries, either tiles (sEntry.run_length > 0) or subdiretories
         // (sEntry.run_length == 0)
-        std::vector<pmtiles::entryv3> sEntries{};
+        // Shared with the directory cache of OGRPMTilesDataset
+        std::shared_ptr<const std::vector<pmtiles::entryv3>> poEntries{};
 
-        // Next index of sEntries[] to explore
+        // Next index of Entries()[] to explore
         uint32_t nIdxInEntries = 0;
 
         // For tiles, value between 0 and
-        // sEntries[nIdxInEntries].run_length - 1
+        // Entries()[nIdxInEntries].run_length - 1
         uint32_t nIdxInRunLength = 0;
+
+        const std::vector<pmtiles::entryv3> &Entries() const
+        {
+            return *poEntries;
+        }
     };
 
     // Stack of directories: bottom is root directory, and then we
@@ -299,8 +336,13 @@ class OGRPMTilesVectorLayer final
     //! Y tile value of currently opened tile
     uint32_t m_nY = 0;
 
-    //! Offset of the currently opened tile
-    uint64_t m_nLastTileOffset = 0;
+    //! Tiles read in advance from m_poTileIterator, with their uncompressed
+    //! data
+    std::deque<std::pair<pmtiles::entry_zxy, std::string>>
+        m_aoPrefetchedTiles{};
+
+    //! Maximum number of tiles to read in advance at the next prefetch
+    size_t m_nPrefetchBatchSize = 1;
 
     //! Uncompressed MVT tile
     std::string m_osTileData{};
@@ -335,6 +377,7 @@ class OGRPMTilesVectorLayer final
     //! Whether we should expose the tile fields in a "json" field
     bool m_bJsonField = false;
 
+    bool PrefetchTiles();
     std::unique_ptr<OGRFeature> GetNextSrcFeature();
     std::unique_ptr<OGRFeature> CreateFeatureFrom(OGRFeature *poSrcFeature);
     GIntBig GetTotalFeatureCount() const;
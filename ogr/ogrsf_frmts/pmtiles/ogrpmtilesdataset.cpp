@@ -29,11 +29,16 @@
 #include "ogr_pmtiles.h"
 
 #include "cpl_json.h"
+#include "cpl_mem_cache.h"
 
 #include "mvtutils.h"
 
 #include <math.h>
 
+#include <algorithm>
+#include <functional>
+#include <mutex>
+
 /************************************************************************/
 /*                       ~OGRPMTilesDataset()                           */
 /************************************************************************/
@@ -230,6 +235,22 @@ bool OGRPMTilesDataset::Open(GDALOpenInfo *poOpenInfo)
         }
     }
 
+    // Directories are cached across dataset instances. Identify the file by
+    // its name, its header and the content of its root directory, which is
+    // just after the header and thus cheap to read, so that a file rewritten
+    // with the same name does not hit stale entries.
+    {
+        const auto *posRootDir =
+            ReadInternal(m_sHeader.root_dir_offset, m_sHeader.root_dir_bytes);
+        if (!posRootDir)
+            return false;
+        m_osDirectoryCacheKeyPrefix = poOpenInfo->pszFilename;
+        m_osDirectoryCacheKeyPrefix += '|';
+        m_osDirectoryCacheKeyPrefix += std::to_string(
+            std::hash<std::string>()(osHeader + *posRootDir));
+        m_osDirectoryCacheKeyPrefix += '|';
+    }
+
     // Read metadata
     const auto *posMetadata = ReadInternal(m_sHeader.json_metadata_offset,
                                            m_sHeader.json_metadata_bytes);
@@ -397,20 +418,8 @@ const std::string *OGRPMTilesDataset::Read(const CPLCompressor *psDecompressor,
 
     if (psDecompressor)
     {
-        m_osDecompressedBuffer.resize(32 + 16 * m_osBuffer.size());
-        void *pOutputData = &m_osDecompressedBuffer[0];
-        size_t nOutputSize = m_osDecompressedBuffer.size();
-        if (!psDecompressor->pfnFunc(m_osBuffer.data(), m_osBuffer.size(),
-                                     &pOutputData, &nOutputSize, nullptr,
-                                     psDecompressor->user_data))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Cannot decompress. Uncompressed buffer size should be at "
-                     "least %u",
-                     unsigned(nOutputSize));
+        if (!Decompress(psDecompressor, m_osBuffer, m_osDecompressedBuffer))
             return nullptr;
-        }
-        m_osDecompressedBuffer.resize(nOutputSize);
         return &m_osDecompressedBuffer;
     }
     else
@@ -419,6 +428,31 @@ const std::string *OGRPMTilesDataset::Read(const CPLCompressor *psDecompressor,
     }
 }
 
+/************************************************************************/
+/*                            Decompress()                              */
+/************************************************************************/
+
+bool OGRPMTilesDataset::Decompress(const CPLCompressor *psDecompressor,
+                                   const std::string &osIn,
+                                   std::string &osOut)
+{
+    osOut.resize(32 + 16 * osIn.size());
+    void *pOutputData = &osOut[0];
+    size_t nOutputSize = osOut.size();
+    if (!psDecompressor->pfnFunc(osIn.data(), osIn.size(), &pOutputData,
+                                 &nOutputSize, nullptr,
+                                 psDecompressor->user_data))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot decompress. Uncompressed buffer size should be at "
+                 "least %u",
+                 unsigned(nOutputSize));
+        return false;
+    }
+    osOut.resize(nOutputSize);
+    return true;
+}
+
 /************************************************************************/
 /*                              ReadInternal()                          */
 /************************************************************************/
@@ -438,3 +472,129 @@ const std::string *OGRPMTilesDataset::ReadTileData(uint64_t nOffset,
 {
     return Read(m_psTileDataDecompressor, nOffset, nSize);
 }
+
+/************************************************************************/
+/*                          ReadTileDataMulti()                         */
+/************************************************************************/
+
+bool OGRPMTilesDataset::ReadTileDataMulti(
+    const std::vector<uint64_t> &anOffsets,
+    const std::vector<uint64_t> &anSizes, std::vector<std::string> &aosData)
+{
+    CPLAssert(anOffsets.size() == anSizes.size());
+    aosData.clear();
+    aosData.resize(anOffsets.size());
+    if (anOffsets.empty())
+        return true;
+
+    // Sort the ranges by increasing offset, and read only once the tiles
+    // shared by several entries (run-length encoded or de-duplicated tiles)
+    std::vector<size_t> anOrder(anOffsets.size());
+    for (size_t i = 0; i < anOrder.size(); ++i)
+        anOrder[i] = i;
+    std::sort(anOrder.begin(), anOrder.end(), [&anOffsets](size_t a, size_t b)
+              { return anOffsets[a] < anOffsets[b]; });
+
+    std::vector<std::string> aosRaw;
+    std::vector<vsi_l_offset> anRangeOffsets;
+    std::vector<size_t> anRangeSizes;
+    // Index in aosRaw[] of each tile
+    std::vector<size_t> anRangeIdx(anOffsets.size());
+    for (const size_t i : anOrder)
+    {
+        if (!anRangeOffsets.empty() && anRangeOffsets.back() == anOffsets[i] &&
+            anRangeSizes.back() == anSizes[i])
+        {
+            anRangeIdx[i] = aosRaw.size() - 1;
+            continue;
+        }
+        if (anSizes[i] == 0 || anSizes[i] > 10 * 1024 * 1024)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Too large amount of data to read");
+            return false;
+        }
+        anRangeIdx[i] = aosRaw.size();
+        aosRaw.emplace_back(static_cast<size_t>(anSizes[i]), '\0');
+        anRangeOffsets.push_back(anOffsets[i]);
+        anRangeSizes.push_back(static_cast<size_t>(anSizes[i]));
+    }
+
+    std::vector<void *> apData;
+    for (auto &osRaw : aosRaw)
+        apData.push_back(&osRaw[0]);
+    if (m_poFile->ReadMultiRange(static_cast<int>(aosRaw.size()),
+                                 apData.data(), anRangeOffsets.data(),
+                                 anRangeSizes.data()) != 0)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot read");
+        return false;
+    }
+
+    if (m_psTileDataDecompressor)
+    {
+        std::vector<std::string> aosDecompressed(aosRaw.size());
+        for (size_t i = 0; i < aosRaw.size(); ++i)
+        {
+            if (!Decompress(m_psTileDataDecompressor, aosRaw[i],
+                            aosDecompressed[i]))
+                return false;
+        }
+        std::swap(aosRaw, aosDecompressed);
+    }
+
+    for (size_t i = 0; i < aosData.size(); ++i)
+        aosData[i] = aosRaw[anRangeIdx[i]];
+    return true;
+}
+
+/************************************************************************/
+/*                         GetDirectoryCache()                          */
+/************************************************************************/
+
+typedef lru11::Cache<std::string,
+                     std::shared_ptr<const std::vector<pmtiles::entryv3>>,
+                     std::mutex>
+    OGRPMTilesDirectoryCache;
+
+static OGRPMTilesDirectoryCache &GetDirectoryCache()
+{
+    static OGRPMTilesDirectoryCache oCache(
+        std::max(1, atoi(CPLGetConfigOption("OGR_PMTILES_DIRECTORY_CACHE_SIZE",
+                                            "128"))),
+        0);
+    return oCache;
+}
+
+/************************************************************************/
+/*                            ReadDirectory()                           */
+/************************************************************************/
+
+std::shared_ptr<const std::vector<pmtiles::entryv3>>
+OGRPMTilesDataset::ReadDirectory(uint64_t nOffset, uint64_t nSize)
+{
+    const std::string osKey =
+        m_osDirectoryCacheKeyPrefix + std::to_string(nOffset) + '_' +
+        std::to_string(nSize);
+    auto &oCache = GetDirectoryCache();
+    std::shared_ptr<const std::vector<pmtiles::entryv3>> poEntries;
+    if (oCache.tryGet(osKey, poEntries))
+        return poEntries;
+
+    const auto *posStr = ReadInternal(nOffset, nSize);
+    if (!posStr)
+        return nullptr;
+    try
+    {
+        poEntries = std::make_shared<const std::vector<pmtiles::entryv3>>(
+            pmtiles::deserialize_directory(*posStr));
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot deserialize directory: %s", e.what());
+        return nullptr;
+    }
+    oCache.insert(osKey, poEntries);
+    return poEntries;
+}
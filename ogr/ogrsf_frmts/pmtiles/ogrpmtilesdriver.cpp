@@ -125,7 +125,11 @@ static GDALDataset *OGRPMTilesDriverVectorTranslateFrom(
         return nullptr;
     }
 
+    // The source may contain raster tiles
+    CPLStringList aosOpenOptions;
+    aosOpenOptions.SetNameValue("ACCEPT_ANY_TILE_TYPE", "YES");
     GDALOpenInfo oOpenInfo(pszDestName, GA_ReadOnly);
+    oOpenInfo.papszOpenOptions = aosOpenOptions.List();
     return OGRPMTilesDriverOpen(&oOpenInfo);
 }
 
@@ -124,16 +124,14 @@ bool OGRPMTilesTileIterator::LoadRootDirectory()
     }
 
     const auto &sHeader = m_poDS->GetHeader();
-    const auto *posStr = m_poDS->ReadInternal(
+    DirectoryContext sContext;
+    sContext.poEntries = m_poDS->ReadDirectory(
         sHeader.root_dir_offset, static_cast<uint32_t>(sHeader.root_dir_bytes));
-    if (!posStr)
+    if (!sContext.poEntries)
     {
         return false;
     }
 
-    DirectoryContext sContext;
-    sContext.sEntries = pmtiles::deserialize_directory(*posStr);
-
     if (m_nZoomLevel >= 0)
     {
         if (m_nCurX >= 0)
@@ -141,7 +139,7 @@ bool OGRPMTilesTileIterator::LoadRootDirectory()
             while (true)
             {
                 const int nMinEntryIdx = find_tile_idx_lesser_or_equal(
-                    sContext.sEntries, m_nMinTileId);
+                    sContext.Entries(), m_nMinTileId);
                 if (nMinEntryIdx < 0)
                 {
                     m_nCurX++;
@@ -168,7 +166,7 @@ bool OGRPMTilesTileIterator::LoadRootDirectory()
         else
         {
             const int nMinEntryIdx =
-                find_tile_idx_lesser_or_equal(sContext.sEntries, m_nMinTileId);
+                find_tile_idx_lesser_or_equal(sContext.Entries(), m_nMinTileId);
             if (nMinEntryIdx < 0)
             {
                 return false;
@@ -190,10 +188,10 @@ void OGRPMTilesTileIterator::SkipRunLength()
     if (!m_aoStack.empty())
     {
         auto &topContext = m_aoStack.top();
-        if (topContext.nIdxInEntries < topContext.sEntries.size())
+        if (topContext.nIdxInEntries < topContext.Entries().size())
         {
             const auto &sCurrentEntry =
-                topContext.sEntries[topContext.nIdxInEntries];
+                topContext.Entries()[topContext.nIdxInEntries];
             if (sCurrentEntry.run_length > 1)
             {
                 m_nLastTileId =
@@ -254,7 +252,7 @@ pmtiles::entry_zxy OGRPMTilesTileIterator::GetNextTile(uint32_t *pnRunLength)
                         while (m_aoStack.size() > 1)
                             m_aoStack.pop();
                         const int nMinEntryIdx = find_tile_idx_lesser_or_equal(
-                            m_aoStack.top().sEntries, m_nMinTileId);
+                            m_aoStack.top().Entries(), m_nMinTileId);
                         if (nMinEntryIdx < 0)
                         {
                             continue;
@@ -272,7 +270,7 @@ pmtiles::entry_zxy OGRPMTilesTileIterator::GetNextTile(uint32_t *pnRunLength)
         while (true)
         {
             if (m_aoStack.top().nIdxInEntries ==
-                m_aoStack.top().sEntries.size())
+                m_aoStack.top().Entries().size())
             {
                 if (m_aoStack.size() == 1 && AdvanceToNextTile())
                     continue;
@@ -284,7 +282,7 @@ pmtiles::entry_zxy OGRPMTilesTileIterator::GetNextTile(uint32_t *pnRunLength)
             }
             auto &topContext = m_aoStack.top();
             const auto &sCurrentEntry =
-                topContext.sEntries[topContext.nIdxInEntries];
+                topContext.Entries()[topContext.nIdxInEntries];
             if (sCurrentEntry.run_length == 0)
             {
                 // Arbitrary limit. 5 seems to be the maximum value supported
@@ -303,17 +301,16 @@ pmtiles::entry_zxy OGRPMTilesTileIterator::GetNextTile(uint32_t *pnRunLength)
                              "Invalid directory offset");
                     break;
                 }
-                const auto *posStr = m_poDS->ReadInternal(
+                DirectoryContext sContext;
+                sContext.poEntries = m_poDS->ReadDirectory(
                     sHeader.leaf_dirs_offset + sCurrentEntry.offset,
                     sCurrentEntry.length);
-                if (!posStr)
+                if (!sContext.poEntries)
                 {
                     break;
                 }
 
-                DirectoryContext sContext;
-                sContext.sEntries = pmtiles::deserialize_directory(*posStr);
-                if (sContext.sEntries.empty())
+                if (sContext.Entries().empty())
                 {
                     // In theory empty directories could exist, but for now
                     // do not allow this to be more robust against hostile files
@@ -323,7 +320,7 @@ pmtiles::entry_zxy OGRPMTilesTileIterator::GetNextTile(uint32_t *pnRunLength)
                     break;
                 }
 
-                if (sContext.sEntries[0].tile_id <= m_nLastTileId)
+                if (sContext.Entries()[0].tile_id <= m_nLastTileId)
                 {
                     CPLError(CE_Failure, CPLE_AppDefined,
                              "Non increasing tile_id");
@@ -333,7 +330,7 @@ pmtiles::entry_zxy OGRPMTilesTileIterator::GetNextTile(uint32_t *pnRunLength)
                 if (m_nZoomLevel >= 0)
                 {
                     const int nMinEntryIdx = find_tile_idx_lesser_or_equal(
-                        sContext.sEntries, m_nMinTileId);
+                        sContext.Entries(), m_nMinTileId);
                     if (nMinEntryIdx < 0)
                     {
                         if (AdvanceToNextTile())
@@ -343,7 +340,7 @@ pmtiles::entry_zxy OGRPMTilesTileIterator::GetNextTile(uint32_t *pnRunLength)
                     sContext.nIdxInEntries = nMinEntryIdx;
                 }
                 m_nLastTileId =
-                    sContext.sEntries[sContext.nIdxInEntries].tile_id;
+                    sContext.Entries()[sContext.nIdxInEntries].tile_id;
 
                 m_aoStack.emplace(std::move(sContext));
 
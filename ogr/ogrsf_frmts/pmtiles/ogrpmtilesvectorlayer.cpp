@@ -118,6 +118,8 @@ void OGRPMTilesVectorLayer::ResetReading()
     m_poTileDS.reset();
     m_poTileLayer = nullptr;
     m_poTileIterator.reset();
+    m_aoPrefetchedTiles.clear();
+    m_nPrefetchBatchSize = 1;
 }
 
 /************************************************************************/
@@ -342,6 +344,49 @@ OGRFeature *OGRPMTilesVectorLayer::GetFeature(GIntBig nFID)
     return poFeature.release();
 }
 
+/************************************************************************/
+/*                          PrefetchTiles()                             */
+/************************************************************************/
+
+// Read the next tiles of m_poTileIterator in a single
+// OGRPMTilesDataset::ReadTileDataMulti() call. The number of tiles read at
+// once grows at each call, so that reading only the first features does not
+// cause too much I/O.
+bool OGRPMTilesVectorLayer::PrefetchTiles()
+{
+    constexpr size_t MAX_PREFETCH_BATCH_SIZE = 64;
+    constexpr uint64_t MAX_PREFETCH_BYTES = 10 * 1024 * 1024;
+
+    std::vector<pmtiles::entry_zxy> asTiles;
+    std::vector<uint64_t> anOffsets;
+    std::vector<uint64_t> anSizes;
+    uint64_t nTotalSize = 0;
+    while (asTiles.size() < m_nPrefetchBatchSize &&
+           nTotalSize < MAX_PREFETCH_BYTES)
+    {
+        const auto sTile = m_poTileIterator->GetNextTile();
+        if (sTile.offset == 0)
+            break;
+        asTiles.push_back(sTile);
+        anOffsets.push_back(sTile.offset);
+        anSizes.push_back(sTile.length);
+        nTotalSize += sTile.length;
+    }
+    if (asTiles.empty())
+        return false;
+    m_nPrefetchBatchSize =
+        std::min(MAX_PREFETCH_BATCH_SIZE, 2 * m_nPrefetchBatchSize);
+
+    std::vector<std::string> aosData;
+    if (!m_poDS->ReadTileDataMulti(anOffsets, anSizes, aosData))
+        return false;
+    for (size_t i = 0; i < asTiles.size(); ++i)
+    {
+        m_aoPrefetchedTiles.emplace_back(asTiles[i], std::move(aosData[i]));
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                        GetNextSrcFeature()                           */
 /************************************************************************/
@@ -378,34 +423,20 @@ std::unique_ptr<OGRFeature> OGRPMTilesVectorLayer::GetNextSrcFeature()
 
         while (true)
         {
-            const auto sTile = m_poTileIterator->GetNextTile();
-            if (sTile.offset == 0)
+            if (m_aoPrefetchedTiles.empty() && !PrefetchTiles())
             {
                 return nullptr;
             }
 
+            const auto sTile = m_aoPrefetchedTiles.front().first;
+            m_osTileData = std::move(m_aoPrefetchedTiles.front().second);
+            m_aoPrefetchedTiles.pop_front();
+
             m_nX = sTile.x;
             m_nY = sTile.y;
 
-            if (sTile.offset == m_nLastTileOffset)
-            {
-                // In case of run-length encoded tiles, we do not need to
-                // re-read it from disk
-            }
-            else
-            {
-                m_nLastTileOffset = sTile.offset;
-                CPLDebugOnly("PMTiles", "Opening tile X=%u, Y=%u, Z=%d",
-                             sTile.x, sTile.y, m_nZoomLevel);
-
-                const auto *posStr =
-                    m_poDS->ReadTileData(sTile.offset, sTile.length);
-                if (!posStr)
-                {
-                    return nullptr;
-                }
-                m_osTileData = *posStr;
-            }
+            CPLDebugOnly("PMTiles", "Opening tile X=%u, Y=%u, Z=%d", sTile.x,
+                         sTile.y, m_nZoomLevel);
 
             m_poTileDS.reset();
             const std::string osTmpFilename =
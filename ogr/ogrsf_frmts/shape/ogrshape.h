@@ -156,6 +156,15 @@ class OGRShapeLayer final : public OGRAbstractProxiedLayer
     SBNSearchHandle hSBN;
     bool CheckForSBN();
 
+    // Packed Hilbert R-tree index (.hrt file)
+    bool m_bCheckedForHRT = false;
+    VSILFILE *m_fpHRT = nullptr;
+    uint64_t m_nHRTItemCount = 0;
+    uint16_t m_nHRTNodeSize = 0;
+    bool CheckForHRT();
+    int *SearchHRT(const OGREnvelope &sEnvelope, int *pnCount);
+    OGRErr CreateHRTSpatialIndex();
+
     bool bSbnSbxDeleted;
 
     CPLString ConvertCodePage(const char *);
@@ -209,7 +218,7 @@ class OGRShapeLayer final : public OGRAbstractProxiedLayer
     // the layer is properly re-opened if necessary.
 
   public:
-    OGRErr CreateSpatialIndex(int nMaxDepth);
+    OGRErr CreateSpatialIndex(int nMaxDepth, bool bHilbertRTree = false);
     OGRErr DropSpatialIndex();
     OGRErr Repack();
     OGRErr RecomputeExtent();
@@ -1085,7 +1085,7 @@ OGRLayer *OGRShapeDataSource::GetLayerByName(const char *pszLayerNameIn)
 /*      We override this to provide special handling of CREATE          */
 /*      SPATIAL INDEX commands.  Support forms are:                     */
 /*                                                                      */
-/*        CREATE SPATIAL INDEX ON layer_name [DEPTH n]                  */
+/*        CREATE SPATIAL INDEX ON layer_name [DEPTH n] [TYPE QIX|HRT]   */
 /*        DROP SPATIAL INDEX ON layer_name                              */
 /*        REPACK layer_name                                             */
 /*        RECOMPUTE EXTENT ON layer_name                                */
@@ -1219,27 +1219,42 @@ OGRLayer *OGRShapeDataSource::ExecuteSQL(const char *pszStatement,
     /*      Parse into keywords.                                            */
     /* -------------------------------------------------------------------- */
     char **papszTokens = CSLTokenizeString(pszStatement);
+    const int nTokens = CSLCount(papszTokens);
 
-    if (CSLCount(papszTokens) < 5 || !EQUAL(papszTokens[0], "CREATE") ||
-        !EQUAL(papszTokens[1], "SPATIAL") || !EQUAL(papszTokens[2], "INDEX") ||
-        !EQUAL(papszTokens[3], "ON") || CSLCount(papszTokens) > 7 ||
-        (CSLCount(papszTokens) == 7 && !EQUAL(papszTokens[5], "DEPTH")))
+    /* -------------------------------------------------------------------- */
+    /*      Get depth and index type if provided.                           */
+    /* -------------------------------------------------------------------- */
+    int nDepth = 0;
+    bool bHilbertRTree = false;
+    bool bSyntaxOK = nTokens >= 5 && EQUAL(papszTokens[0], "CREATE") &&
+                     EQUAL(papszTokens[1], "SPATIAL") &&
+                     EQUAL(papszTokens[2], "INDEX") &&
+                     EQUAL(papszTokens[3], "ON") && (nTokens % 2) == 1;
+    for (int i = 5; bSyntaxOK && i + 1 < nTokens; i += 2)
+    {
+        if (EQUAL(papszTokens[i], "DEPTH"))
+            nDepth = atoi(papszTokens[i + 1]);
+        else if (EQUAL(papszTokens[i], "TYPE") &&
+                 EQUAL(papszTokens[i + 1], "QIX"))
+            bHilbertRTree = false;
+        else if (EQUAL(papszTokens[i], "TYPE") &&
+                 EQUAL(papszTokens[i + 1], "HRT"))
+            bHilbertRTree = true;
+        else
+            bSyntaxOK = false;
+    }
+    if (!bSyntaxOK)
     {
         CSLDestroy(papszTokens);
         CPLError(CE_Failure, CPLE_AppDefined,
                  "Syntax error in CREATE SPATIAL INDEX command.\n"
                  "Was '%s'\n"
                  "Should be of form 'CREATE SPATIAL INDEX ON <table> "
-                 "[DEPTH <n>]'",
+                 "[DEPTH <n>] [TYPE QIX|HRT]'",
                  pszStatement);
         return nullptr;
     }
 
-    /* -------------------------------------------------------------------- */
-    /*      Get depth if provided.                                          */
-    /* -------------------------------------------------------------------- */
-    const int nDepth = CSLCount(papszTokens) == 7 ? atoi(papszTokens[6]) : 0;
-
     /* -------------------------------------------------------------------- */
     /*      What layer are we operating on.                                 */
     /* -------------------------------------------------------------------- */
@@ -1256,7 +1271,7 @@ OGRLayer *OGRShapeDataSource::ExecuteSQL(const char *pszStatement,
 
     CSLDestroy(papszTokens);
 
-    poLayer->CreateSpatialIndex(nDepth);
+    poLayer->CreateSpatialIndex(nDepth, bHilbertRTree);
     return nullptr;
 }
 
@@ -1267,7 +1282,8 @@ OGRLayer *OGRShapeDataSource::ExecuteSQL(const char *pszStatement,
 const char *const *OGRShapeDataSource::GetExtensionsForDeletion()
 {
     static const char *const apszExtensions[] = {
-        "shp",  "shx", "dbf", "sbn", "sbx", "prj", "idm", "ind", "qix", "cpg",
+        "shp", "shx", "dbf", "sbn", "sbx", "prj", "idm", "ind", "qix", "hrt",
+        "cpg",
         "qpj",  // QGIS projection file
         nullptr};
     return apszExtensions;
@@ -55,6 +55,7 @@
 #include "ogrlayerpool.h"
 #include "ograrrowarrayhelper.h"
 #include "ogrsf_frmts.h"
+#include "packedrtree.h"
 #include "shapefil.h"
 #include "shp_vsi.h"
 
@@ -280,6 +281,9 @@ OGRShapeLayer::~OGRShapeLayer()
 
     if (hSBN != nullptr)
         SBNCloseDiskTree(hSBN);
+
+    if (m_fpHRT != nullptr)
+        VSIFCloseL(m_fpHRT);
 }
 
 /************************************************************************/
@@ -632,6 +636,154 @@ bool OGRShapeLayer::CheckForSBN()
     return hSBN != nullptr;
 }
 
+/************************************************************************/
+/*                            CheckForHRT()                             */
+/************************************************************************/
+
+// A .hrt file is a packed Hilbert R-tree, with the same node layout as the
+// spatial index of FlatGeobuf files, preceded by a 32 byte header:
+// - 8 bytes: "GDALHRT\0"
+// - uint32 LSB: version (1)
+// - uint32 LSB: number of shapes in the .shp file when the index was built
+// - uint64 LSB: number of indexed shapes (non-null ones)
+// - uint16 LSB: node size
+// - 6 bytes: reserved, set to 0
+// The offset of leaf nodes is the shape id.
+
+constexpr char HRT_MAGIC[] = "GDALHRT";
+constexpr uint32_t HRT_VERSION = 1;
+constexpr int HRT_HEADER_SIZE = 32;
+constexpr uint16_t HRT_DEFAULT_NODE_SIZE = 16;
+
+bool OGRShapeLayer::CheckForHRT()
+
+{
+    if (m_bCheckedForHRT)
+        return m_fpHRT != nullptr;
+
+    m_bCheckedForHRT = true;
+
+    const char *pszHRTFilename = CPLResetExtension(pszFullName, "hrt");
+    m_fpHRT = VSIFOpenL(pszHRTFilename, "rb");
+    if (m_fpHRT == nullptr)
+        return false;
+
+    GByte abyHeader[HRT_HEADER_SIZE];
+    uint32_t nVersion = 0;
+    uint32_t nShapeCount = 0;
+    bool bValid = VSIFReadL(abyHeader, sizeof(abyHeader), 1, m_fpHRT) == 1 &&
+                  memcmp(abyHeader, HRT_MAGIC, sizeof(HRT_MAGIC)) == 0;
+    if (bValid)
+    {
+        memcpy(&nVersion, abyHeader + 8, sizeof(nVersion));
+        CPL_LSBPTR32(&nVersion);
+        memcpy(&nShapeCount, abyHeader + 12, sizeof(nShapeCount));
+        CPL_LSBPTR32(&nShapeCount);
+        memcpy(&m_nHRTItemCount, abyHeader + 16, sizeof(m_nHRTItemCount));
+        CPL_LSBPTR64(&m_nHRTItemCount);
+        memcpy(&m_nHRTNodeSize, abyHeader + 24, sizeof(m_nHRTNodeSize));
+        CPL_LSBPTR16(&m_nHRTNodeSize);
+        bValid = nVersion == HRT_VERSION && m_nHRTNodeSize >= 2 &&
+                 m_nHRTItemCount <= nShapeCount;
+    }
+    if (bValid && m_nHRTItemCount > 0)
+    {
+        try
+        {
+            const uint64_t nTreeSize = FlatGeobuf::PackedRTree::size(
+                m_nHRTItemCount, m_nHRTNodeSize);
+            bValid = VSIFSeekL(m_fpHRT, 0, SEEK_END) == 0 &&
+                     VSIFTellL(m_fpHRT) >= HRT_HEADER_SIZE + nTreeSize;
+        }
+        catch (const std::exception &)
+        {
+            bValid = false;
+        }
+    }
+    if (!bValid)
+    {
+        CPLError(CE_Warning, CPLE_AppDefined, "%s is not a valid .hrt file",
+                 pszHRTFilename);
+    }
+    else if (hSHP != nullptr &&
+             nShapeCount != static_cast<uint32_t>(hSHP->nRecords))
+    {
+        CPLDebug("SHAPE",
+                 "%s was built for %u shapes, whereas there are %d. "
+                 "Ignoring it",
+                 pszHRTFilename, nShapeCount, hSHP->nRecords);
+        bValid = false;
+    }
+    if (!bValid)
+    {
+        VSIFCloseL(m_fpHRT);
+        m_fpHRT = nullptr;
+    }
+
+    return m_fpHRT != nullptr;
+}
+
+/************************************************************************/
+/*                             SearchHRT()                              */
+/************************************************************************/
+
+// Returns the sorted list of the ids of the shapes whose bounding box
+// intersects sEnvelope, to be freed with free(), or nullptr in case of error.
+
+int *OGRShapeLayer::SearchHRT(const OGREnvelope &sEnvelope, int *pnCount)
+
+{
+    *pnCount = 0;
+    std::vector<FlatGeobuf::SearchResultItem> aoResults;
+    if (m_nHRTItemCount > 0)
+    {
+        const FlatGeobuf::NodeItem sItem{sEnvelope.MinX, sEnvelope.MinY,
+                                         sEnvelope.MaxX, sEnvelope.MaxY, 0};
+        // Nodes are read in increasing offset order, which allows
+        // efficient read-ahead on network file systems.
+        const auto readNode = [this](uint8_t *pabyBuf, size_t nOffset,
+                                     size_t nSize)
+        {
+            if (VSIFSeekL(m_fpHRT, HRT_HEADER_SIZE + nOffset, SEEK_SET) != 0 ||
+                VSIFReadL(pabyBuf, 1, nSize, m_fpHRT) != nSize)
+            {
+                throw std::runtime_error("I/O error");
+            }
+        };
+        try
+        {
+            aoResults = FlatGeobuf::PackedRTree::streamSearch(
+                m_nHRTItemCount, m_nHRTNodeSize, sItem, readNode);
+        }
+        catch (const std::exception &e)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Error while reading .hrt file: %s", e.what());
+            return nullptr;
+        }
+    }
+
+    // Allocate at least one element, since a null pointer means no result.
+    // Use malloc() for consistency with SHPSearchDiskTreeEx().
+    int *panFIDs = static_cast<int *>(
+        malloc(std::max<size_t>(1, aoResults.size()) * sizeof(int)));
+    if (panFIDs == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate spatial index results");
+        return nullptr;
+    }
+    int nCount = 0;
+    for (const auto &oResult : aoResults)
+    {
+        if (oResult.offset < static_cast<uint64_t>(nTotalShapeCount))
+            panFIDs[nCount++] = static_cast<int>(oResult.offset);
+    }
+    std::sort(panFIDs, panFIDs + nCount);
+    *pnCount = nCount;
+    return panFIDs;
+}
+
 /************************************************************************/
 /*                            ScanIndices()                             */
 /*                                                                      */
@@ -694,16 +846,19 @@ bool OGRShapeLayer::ScanIndices()
 
     if (bTryQIXorSBN)
     {
-        if (!bCheckedForQIX)
+        if (!m_bCheckedForHRT)
+            CPL_IGNORE_RET_VAL(CheckForHRT());
+        if (m_fpHRT == nullptr && !bCheckedForQIX)
             CPL_IGNORE_RET_VAL(CheckForQIX());
-        if (hQIX == nullptr && !bCheckedForSBN)
+        if (m_fpHRT == nullptr && hQIX == nullptr && !bCheckedForSBN)
             CPL_IGNORE_RET_VAL(CheckForSBN());
     }
 
     /* -------------------------------------------------------------------- */
     /*      Compute spatial index if appropriate.                           */
     /* -------------------------------------------------------------------- */
-    if (bTryQIXorSBN && (hQIX != nullptr || hSBN != nullptr) &&
+    if (bTryQIXorSBN &&
+        (m_fpHRT != nullptr || hQIX != nullptr || hSBN != nullptr) &&
         panSpatialFIDs == nullptr)
     {
         double adfBoundsMin[4] = {oSpatialFilterEnvelope.MinX,
@@ -711,7 +866,10 @@ bool OGRShapeLayer::ScanIndices()
         double adfBoundsMax[4] = {oSpatialFilterEnvelope.MaxX,
                                   oSpatialFilterEnvelope.MaxY, 0.0, 0.0};
 
-        if (hQIX != nullptr)
+        if (m_fpHRT != nullptr)
+            panSpatialFIDs =
+                SearchHRT(oSpatialFilterEnvelope, &nSpatialFIDCount);
+        else if (hQIX != nullptr)
             panSpatialFIDs = SHPSearchDiskTreeEx(
                 hQIX, adfBoundsMin, adfBoundsMax, &nSpatialFIDCount);
         else
@@ -997,7 +1155,7 @@ OGRFeature *OGRShapeLayer::GetNextFeature()
             {
                 if (DBFIsRecordDeleted(hDBF, iNextShapeId))
                     poFeature = nullptr;
-                else if (VSIFEofL(VSI_SHP_GetVSIL(hDBF->fp)))
+                else if (VSI_SHP_Eof(hDBF->fp))
                     return nullptr;  //* I/O error.
                 else
                     poFeature = FetchShape(iNextShapeId);
@@ -1101,7 +1259,7 @@ OGRErr OGRShapeLayer::ISetFeature(OGRFeature *poFeature)
     }
 
     bHeaderDirty = true;
-    if (CheckForQIX() || CheckForSBN())
+    if (CheckForHRT() || CheckForQIX() || CheckForSBN())
         DropSpatialIndex();
 
     unsigned int nOffset = 0;
@@ -1177,7 +1335,7 @@ OGRErr OGRShapeLayer::DeleteFeature(GIntBig nFID)
         return OGRERR_FAILURE;
 
     bHeaderDirty = true;
-    if (CheckForQIX() || CheckForSBN())
+    if (CheckForHRT() || CheckForQIX() || CheckForSBN())
         DropSpatialIndex();
     m_eNeedRepack = YES;
 
@@ -1201,7 +1359,7 @@ OGRErr OGRShapeLayer::ICreateFeature(OGRFeature *poFeature)
     }
 
     bHeaderDirty = true;
-    if (CheckForQIX() || CheckForSBN())
+    if (CheckForHRT() || CheckForQIX() || CheckForSBN())
         DropSpatialIndex();
 
     poFeature->SetFID(OGRNullFID);
@@ -1426,7 +1584,7 @@ int OGRShapeLayer::GetFeatureCountWithSpatialFilterOnly()
                 if (DBFIsRecordDeleted(hDBF, iShape))
                     continue;
 
-                if (VSIFEofL(VSI_SHP_GetVSIL(hDBF->fp)))
+                if (VSI_SHP_Eof(hDBF->fp))
                     break;
             }
         }
@@ -1833,6 +1991,9 @@ int OGRShapeLayer::TestCapability(const char *pszCap)
     if (EQUAL(pszCap, OLCIgnoreFields))
         return TRUE;
 
+    if (EQUAL(pszCap, OLCFastGetArrowStream))
+        return m_poFilterGeom == nullptr && m_poAttrQuery == nullptr;
+
     if (EQUAL(pszCap, OLCStringsAsUTF8))
     {
         // No encoding defined: we don't know.
@@ -2621,7 +2782,7 @@ OGRErr OGRShapeLayer::DropSpatialIndex()
     if (!StartUpdate("DropSpatialIndex"))
         return OGRERR_FAILURE;
 
-    if (!CheckForQIX() && !CheckForSBN())
+    if (!CheckForHRT() && !CheckForQIX() && !CheckForSBN())
     {
         CPLError(CE_Warning, CPLE_AppDefined,
                  "Layer %s has no spatial index, DROP SPATIAL INDEX failed.",
@@ -2630,6 +2791,12 @@ OGRErr OGRShapeLayer::DropSpatialIndex()
     }
 
     const bool bHadQIX = hQIX != nullptr;
+    const bool bHadHRT = m_fpHRT != nullptr;
+
+    if (m_fpHRT)
+        VSIFCloseL(m_fpHRT);
+    m_fpHRT = nullptr;
+    m_bCheckedForHRT = false;
 
     SHPCloseDiskTree(hQIX);
     hQIX = nullptr;
@@ -2639,15 +2806,18 @@ OGRErr OGRShapeLayer::DropSpatialIndex()
     hSBN = nullptr;
     bCheckedForSBN = false;
 
-    if (bHadQIX)
+    for (const auto &[bHadIndex, pszExt] :
+         {std::pair(bHadQIX, "qix"), std::pair(bHadHRT, "hrt")})
     {
-        const char *pszQIXFilename = CPLResetExtension(pszFullName, "qix");
-        CPLDebug("SHAPE", "Unlinking index file %s", pszQIXFilename);
+        if (!bHadIndex)
+            continue;
+        const char *pszIndexFilename = CPLResetExtension(pszFullName, pszExt);
+        CPLDebug("SHAPE", "Unlinking index file %s", pszIndexFilename);
 
-        if (VSIUnlink(pszQIXFilename) != 0)
+        if (VSIUnlink(pszIndexFilename) != 0)
         {
             CPLError(CE_Failure, CPLE_AppDefined,
-                     "Failed to delete file %s.\n%s", pszQIXFilename,
+                     "Failed to delete file %s.\n%s", pszIndexFilename,
                      VSIStrerror(errno));
             return OGRERR_FAILURE;
         }
@@ -2681,7 +2851,11 @@ OGRErr OGRShapeLayer::DropSpatialIndex()
 /*                         CreateSpatialIndex()                         */
 /************************************************************************/
 
-OGRErr OGRShapeLayer::CreateSpatialIndex(int nMaxDepth)
+// If bHilbertRTree is true, a packed Hilbert R-tree is written in a .hrt
+// file. Otherwise a quadtree of maximum depth nMaxDepth is written in a
+// .qix file.
+
+OGRErr OGRShapeLayer::CreateSpatialIndex(int nMaxDepth, bool bHilbertRTree)
 
 {
     if (!StartUpdate("CreateSpatialIndex"))
@@ -2690,10 +2864,14 @@ OGRErr OGRShapeLayer::CreateSpatialIndex(int nMaxDepth)
     /* -------------------------------------------------------------------- */
     /*      If we have an existing spatial index, blow it away first.       */
     /* -------------------------------------------------------------------- */
-    if (CheckForQIX())
+    if (CheckForQIX() || CheckForHRT())
         DropSpatialIndex();
 
     bCheckedForQIX = false;
+    m_bCheckedForHRT = false;
+
+    if (bHilbertRTree)
+        return CreateHRTSpatialIndex();
 
     /* -------------------------------------------------------------------- */
     /*      Build a quadtree structure for this file.                       */
@@ -2735,6 +2913,89 @@ OGRErr OGRShapeLayer::CreateSpatialIndex(int nMaxDepth)
     return OGRERR_NONE;
 }
 
+/************************************************************************/
+/*                       CreateHRTSpatialIndex()                        */
+/************************************************************************/
+
+OGRErr OGRShapeLayer::CreateHRTSpatialIndex()
+
+{
+    OGRShapeLayer::SyncToDisk();
+
+    std::vector<FlatGeobuf::NodeItem> asItems;
+    for (int iShape = 0; iShape < nTotalShapeCount; iShape++)
+    {
+        SHPObject *psShape = SHPReadObject(hSHP, iShape);
+        if (psShape != nullptr && psShape->nSHPType != SHPT_NULL &&
+            psShape->nVertices > 0)
+        {
+            asItems.push_back({psShape->dfXMin, psShape->dfYMin,
+                               psShape->dfXMax, psShape->dfYMax,
+                               static_cast<uint64_t>(iShape)});
+        }
+        SHPDestroyObject(psShape);
+    }
+
+    const char *pszHRTFilename = CPLResetExtension(pszFullName, "hrt");
+    CPLDebug("SHAPE", "Creating index file %s", pszHRTFilename);
+
+    VSILFILE *fp = VSIFOpenL(pszHRTFilename, "wb");
+    if (fp == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_OpenFailed, "Cannot create %s",
+                 pszHRTFilename);
+        return OGRERR_FAILURE;
+    }
+
+    GByte abyHeader[HRT_HEADER_SIZE] = {0};
+    memcpy(abyHeader, HRT_MAGIC, sizeof(HRT_MAGIC));
+    uint32_t nVersion = HRT_VERSION;
+    CPL_LSBPTR32(&nVersion);
+    memcpy(abyHeader + 8, &nVersion, sizeof(nVersion));
+    uint32_t nShapeCount = static_cast<uint32_t>(nTotalShapeCount);
+    CPL_LSBPTR32(&nShapeCount);
+    memcpy(abyHeader + 12, &nShapeCount, sizeof(nShapeCount));
+    uint64_t nItemCount = asItems.size();
+    CPL_LSBPTR64(&nItemCount);
+    memcpy(abyHeader + 16, &nItemCount, sizeof(nItemCount));
+    uint16_t nNodeSize = HRT_DEFAULT_NODE_SIZE;
+    CPL_LSBPTR16(&nNodeSize);
+    memcpy(abyHeader + 24, &nNodeSize, sizeof(nNodeSize));
+
+    bool bOK = VSIFWriteL(abyHeader, sizeof(abyHeader), 1, fp) == 1;
+    if (bOK && !asItems.empty())
+    {
+        try
+        {
+            FlatGeobuf::hilbertSort(asItems);
+            FlatGeobuf::PackedRTree oTree(asItems,
+                                          FlatGeobuf::calcExtent(asItems),
+                                          HRT_DEFAULT_NODE_SIZE);
+            asItems.clear();
+            oTree.streamWrite(
+                [fp, &bOK](uint8_t *pabyData, size_t nSize)
+                { bOK = bOK && VSIFWriteL(pabyData, 1, nSize, fp) == nSize; });
+        }
+        catch (const std::exception &e)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Cannot create packed R-tree: %s", e.what());
+            bOK = false;
+        }
+    }
+    if (VSIFCloseL(fp) != 0)
+        bOK = false;
+    if (!bOK)
+    {
+        VSIUnlink(pszHRTFilename);
+        return OGRERR_FAILURE;
+    }
+
+    CPL_IGNORE_RET_VAL(CheckForHRT());
+
+    return OGRERR_NONE;
+}
+
 /************************************************************************/
 /*                       CheckFileDeletion()                            */
 /************************************************************************/
@@ -2835,7 +3096,7 @@ OGRErr OGRShapeLayer::Repack()
                 }
                 panRecordsToDelete[nDeleteCount++] = iShape;
             }
-            if (VSIFEofL(VSI_SHP_GetVSIL(hDBF->fp)))
+            if (VSI_SHP_Eof(hDBF->fp))
             {
                 CPLFree(panRecordsToDelete);
                 return OGRERR_FAILURE;  // I/O error.
@@ -2934,7 +3195,7 @@ OGRErr OGRShapeLayer::Repack()
     /*      Cleanup any existing spatial index.  It will become             */
     /*      meaningless when the fids change.                               */
     /* -------------------------------------------------------------------- */
-    if (CheckForQIX() || CheckForSBN())
+    if (CheckForHRT() || CheckForQIX() || CheckForSBN())
         DropSpatialIndex();
 
     /* -------------------------------------------------------------------- */
@@ -3722,6 +3983,12 @@ void OGRShapeLayer::AddToFileList(CPLStringList &oFileList)
             oFileList.AddStringDirectly(
                 VSIGetCanonicalFilename(poGeomFieldDefn->GetPrjFilename()));
         }
+        if (CheckForHRT())
+        {
+            const char *pszHRTFilename = CPLResetExtension(pszFullName, "hrt");
+            oFileList.AddStringDirectly(
+                VSIGetCanonicalFilename(pszHRTFilename));
+        }
         if (CheckForQIX())
         {
             const char *pszQIXFilename = CPLResetExtension(pszFullName, "qix");
@@ -3856,8 +4123,9 @@ GDALDataset *OGRShapeLayer::GetDataset()
 /*                        GetNextArrowArray()                           */
 /************************************************************************/
 
-// Specialized implementation restricted to situations where only retrieving
-// of FID values is asked (without filters)
+// Specialized implementation reading DBF records and shapes directly into
+// Arrow buffers, without building OGRFeature objects, restricted to
+// situations where no attribute or spatial filter is set.
 // In other cases, fall back to generic implementation.
 int OGRShapeLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
                                      struct ArrowArray *out_array)
@@ -3869,21 +4137,28 @@ int OGRShapeLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
         return EIO;
     }
 
-    if (!hDBF || m_poAttrQuery != nullptr || m_poFilterGeom != nullptr)
+    if (m_poAttrQuery != nullptr || m_poFilterGeom != nullptr ||
+        OGRArrowArrayHelper::HasGeoArrowGeometryField(
+            poFeatureDefn, m_aosArrowArrayStreamOptions))
     {
         return OGRLayer::GetNextArrowArray(stream, out_array);
     }
 
-    // If any field is not ignored, use generic implementation
+    // Only field types that SHPReadOGRFeature() can return
     const int nFieldCount = poFeatureDefn->GetFieldCount();
     for (int i = 0; i < nFieldCount; ++i)
     {
-        if (!poFeatureDefn->GetFieldDefn(i)->IsIgnored())
+        const auto poFieldDefn = poFeatureDefn->GetFieldDefn(i);
+        if (poFieldDefn->IsIgnored())
+            continue;
+        const auto eType = poFieldDefn->GetType();
+        if (hDBF == nullptr || poFieldDefn->GetSubType() != OFSTNone ||
+            (eType != OFTString && eType != OFTInteger &&
+             eType != OFTInteger64 && eType != OFTReal && eType != OFTDate))
+        {
             return OGRLayer::GetNextArrowArray(stream, out_array);
+        }
     }
-    if (GetGeomType() != wkbNone &&
-        !poFeatureDefn->GetGeomFieldDefn(0)->IsIgnored())
-        return OGRLayer::GetNextArrowArray(stream, out_array);
 
     OGRArrowArrayHelper sHelper(poDS, poFeatureDefn,
                                 m_aosArrowArrayStreamOptions, out_array);
@@ -3892,39 +4167,266 @@ int OGRShapeLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
         return ENOMEM;
     }
 
-    if (!sHelper.m_bIncludeFID)
+    if (sHelper.m_nChildren == 0)
+    {
+        sHelper.ClearArray();
         return OGRLayer::GetNextArrowArray(stream, out_array);
+    }
 
     m_bLastGetNextArrowArrayUsedOptimizedCodePath = true;
-    int nCount = 0;
-    while (iNextShapeId < nTotalShapeCount)
+
+    const int iGeomArrowField = poFeatureDefn->GetGeomFieldCount() > 0
+                                    ? sHelper.m_mapOGRGeomFieldToArrowField[0]
+                                    : -1;
+    const OGRwkbGeometryType eLayerGeomType = GetGeomType();
+    const uint32_t nMemLimit = OGRArrowArrayHelper::GetMemLimit();
+    const bool bWarn = CPLTestBool(
+        CPLGetConfigOption("OGR_SETFIELD_NUMERIC_WARNING", "YES"));
+
+    struct tm brokenDown;
+    memset(&brokenDown, 0, sizeof(brokenDown));
+
+    // Strings are fetched before anything is written for a feature, so that
+    // it can be left for the next batch if the memory limit is reached.
+    std::vector<std::string> aosStrings(nFieldCount);
+    std::vector<bool> abNullStrings(nFieldCount);
+
+    int iFeat = 0;
+    while (iFeat < sHelper.m_nMaxBatchSize && iNextShapeId < nTotalShapeCount)
     {
-        const bool bIsDeleted =
-            CPL_TO_BOOL(DBFIsRecordDeleted(hDBF, iNextShapeId));
-        if (bIsDeleted)
+        const int iShape = iNextShapeId;
+        if (hDBF)
         {
-            ++iNextShapeId;
-            continue;
+            if (DBFIsRecordDeleted(hDBF, iShape))
+            {
+                ++iNextShapeId;
+                continue;
+            }
+            if (VSI_SHP_Eof(hDBF->fp))
+            {
+                sHelper.ClearArray();
+                return EIO;
+            }
         }
-        if (VSIFEofL(VSI_SHP_GetVSIL(hDBF->fp)))
+
+        const auto WouldExceedMemLimit = [out_array, iFeat,
+                                          nMemLimit](int iArrowField,
+                                                     size_t nLen)
         {
-            out_array->release(out_array);
-            memset(out_array, 0, sizeof(*out_array));
-            return EIO;
+            if (iFeat == 0)
+                return false;
+            const auto panOffsets = static_cast<const int32_t *>(
+                out_array->children[iArrowField]->buffers[1]);
+            const uint32_t nCurLength =
+                static_cast<uint32_t>(panOffsets[iFeat]);
+            return nLen <= nMemLimit && nLen > nMemLimit - nCurLength;
+        };
+
+        std::unique_ptr<OGRGeometry> poGeom;
+        size_t nWKBSize = 0;
+        if (iGeomArrowField >= 0 && hSHP != nullptr)
+        {
+            poGeom.reset(SHPReadOGRObject(hSHP, iShape, nullptr,
+                                          m_bHasWarnedWrongWindingOrder));
+            if (poGeom && eLayerGeomType != wkbUnknown)
+            {
+                // Same adjustments as in SHPReadOGRFeature()
+                const OGRwkbGeometryType eGeomInType =
+                    poGeom->getGeometryType();
+                if (wkbHasZ(eLayerGeomType) != wkbHasZ(eGeomInType))
+                    poGeom->set3D(wkbHasZ(eLayerGeomType));
+                if (wkbHasM(eLayerGeomType) != wkbHasM(eGeomInType))
+                    poGeom->setMeasured(wkbHasM(eLayerGeomType));
+            }
+            if (poGeom)
+            {
+                nWKBSize = poGeom->WkbSize();
+                if (WouldExceedMemLimit(iGeomArrowField, nWKBSize))
+                    break;
+            }
         }
-        sHelper.m_panFIDValues[nCount] = iNextShapeId;
-        ++iNextShapeId;
-        ++nCount;
-        if (nCount == sHelper.m_nMaxBatchSize)
+
+        bool bMemLimitReached = false;
+        for (int i = 0; i < nFieldCount && !bMemLimitReached; ++i)
+        {
+            const int iArrowField = sHelper.m_mapOGRFieldToArrowField[i];
+            if (iArrowField < 0 ||
+                poFeatureDefn->GetFieldDefn(i)->GetType() != OFTString)
+                continue;
+            const char *pszFieldVal = DBFReadStringAttribute(hDBF, iShape, i);
+            abNullStrings[i] = pszFieldVal == nullptr || pszFieldVal[0] == '\0';
+            if (abNullStrings[i])
+                continue;
+            if (!osEncoding.empty())
+            {
+                char *pszUTF8Field =
+                    CPLRecode(pszFieldVal, osEncoding, CPL_ENC_UTF8);
+                aosStrings[i] = pszUTF8Field;
+                CPLFree(pszUTF8Field);
+            }
+            else
+            {
+                aosStrings[i] = pszFieldVal;
+            }
+            bMemLimitReached =
+                WouldExceedMemLimit(iArrowField, aosStrings[i].size());
+        }
+        if (bMemLimitReached)
             break;
+
+        if (sHelper.m_panFIDValues)
+            sHelper.m_panFIDValues[iFeat] = iShape;
+
+        if (iGeomArrowField >= 0)
+        {
+            if (poGeom)
+            {
+                GByte *outPtr = sHelper.GetPtrForStringOrBinary(
+                    iGeomArrowField, iFeat, nWKBSize);
+                if (outPtr == nullptr)
+                    goto error;
+                poGeom->exportToWkb(wkbNDR, outPtr, wkbVariantIso);
+            }
+            else if (!sHelper.SetNull(iGeomArrowField, iFeat))
+            {
+                goto error;
+            }
+        }
+
+        for (int i = 0; i < nFieldCount; ++i)
+        {
+            const int iArrowField = sHelper.m_mapOGRFieldToArrowField[i];
+            if (iArrowField < 0)
+                continue;
+            auto psArray = out_array->children[iArrowField];
+            const auto poFieldDefn = poFeatureDefn->GetFieldDefn(i);
+            const auto eType = poFieldDefn->GetType();
+
+            const bool bIsNull = eType == OFTString
+                                     ? static_cast<bool>(abNullStrings[i])
+                                     : DBFIsAttributeNULL(hDBF, iShape, i);
+            if (bIsNull)
+            {
+                if (sHelper.m_abNullableFields[i])
+                {
+                    if (!sHelper.SetNull(iArrowField, iFeat))
+                        goto error;
+                }
+                else if (eType == OFTString)
+                {
+                    sHelper.SetEmptyStringOrBinary(psArray, iFeat);
+                }
+                continue;
+            }
+
+            if (eType == OFTString)
+            {
+                const auto &osStr = aosStrings[i];
+                GByte *outPtr = sHelper.GetPtrForStringOrBinary(
+                    iArrowField, iFeat, osStr.size());
+                if (outPtr == nullptr)
+                    goto error;
+                memcpy(outPtr, osStr.data(), osStr.size());
+                continue;
+            }
+
+            // Same conversions as OGRFeature::SetField(int, const char*)
+            const char *pszFieldVal = DBFReadStringAttribute(hDBF, iShape, i);
+            char *pszLast = nullptr;
+            switch (eType)
+            {
+                case OFTInteger:
+                {
+                    errno = 0;
+                    const long long nVal64 =
+                        std::strtoll(pszFieldVal, &pszLast, 10);
+                    const int nVal32 =
+                        nVal64 > INT_MAX   ? INT_MAX
+                        : nVal64 < INT_MIN ? INT_MIN
+                                           : static_cast<int>(nVal64);
+                    if (bWarn && (errno == ERANGE || nVal32 != nVal64 ||
+                                  !pszLast || *pszLast))
+                    {
+                        CPLError(CE_Warning, CPLE_AppDefined,
+                                 "Value '%s' of field %s.%s parsed "
+                                 "incompletely to integer %d.",
+                                 pszFieldVal, poFeatureDefn->GetName(),
+                                 poFieldDefn->GetNameRef(), nVal32);
+                    }
+                    sHelper.SetInt32(psArray, iFeat, nVal32);
+                    break;
+                }
+
+                case OFTInteger64:
+                {
+                    sHelper.SetInt64(psArray, iFeat,
+                                     CPLAtoGIntBigEx(pszFieldVal, bWarn,
+                                                     nullptr));
+                    break;
+                }
+
+                case OFTReal:
+                {
+                    const double dfVal = CPLStrtod(pszFieldVal, &pszLast);
+                    if (bWarn && (!pszLast || *pszLast))
+                    {
+                        CPLError(CE_Warning, CPLE_AppDefined,
+                                 "Value '%s' of field %s.%s parsed "
+                                 "incompletely to real %.16g.",
+                                 pszFieldVal, poFeatureDefn->GetName(),
+                                 poFieldDefn->GetNameRef(), dfVal);
+                    }
+                    sHelper.SetDouble(psArray, iFeat, dfVal);
+                    break;
+                }
+
+                case OFTDate:
+                {
+                    // Same parsing as in SHPReadOGRFeature()
+                    OGRField sFld;
+                    memset(&sFld, 0, sizeof(sFld));
+                    if (strlen(pszFieldVal) >= 10 && pszFieldVal[2] == '/' &&
+                        pszFieldVal[5] == '/')
+                    {
+                        sFld.Date.Month =
+                            static_cast<GByte>(atoi(pszFieldVal + 0));
+                        sFld.Date.Day =
+                            static_cast<GByte>(atoi(pszFieldVal + 3));
+                        sFld.Date.Year =
+                            static_cast<GInt16>(atoi(pszFieldVal + 6));
+                    }
+                    else
+                    {
+                        const int nFullDate = atoi(pszFieldVal);
+                        sFld.Date.Year = static_cast<GInt16>(nFullDate / 10000);
+                        sFld.Date.Month =
+                            static_cast<GByte>((nFullDate / 100) % 100);
+                        sFld.Date.Day = static_cast<GByte>(nFullDate % 100);
+                    }
+                    sHelper.SetDate(psArray, iFeat, brokenDown, sFld);
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        }
+
+        ++iNextShapeId;
+        ++iFeat;
+        m_nFeaturesRead++;
     }
-    sHelper.Shrink(nCount);
-    if (nCount == 0)
+
+    sHelper.Shrink(iFeat);
+    if (iFeat == 0)
     {
-        out_array->release(out_array);
-        memset(out_array, 0, sizeof(*out_array));
+        sHelper.ClearArray();
     }
     return 0;
+
+error:
+    sHelper.ClearArray();
+    return ENOMEM;
 }
 
 /************************************************************************/
@@ -31,8 +31,23 @@
 #include "shp_vsi.h"
 #include "cpl_error.h"
 #include "cpl_conv.h"
+#include "cpl_string.h"
 #include "cpl_vsi_error.h"
 #include <limits.h>
+#include <string.h>
+
+/* Size of the read-ahead buffer used for sequential reads of files opened */
+/* in read-only mode. */
+#define SHP_READ_AHEAD_SIZE (64 * 1024)
+
+/* Number of consecutive sequential reads after which read-ahead starts. */
+#define SHP_READ_AHEAD_TRIGGER 2
+
+/* Size of the buffer accumulating writes to files opened in update mode. */
+#define SHP_WRITE_BUFFER_SIZE (256 * 1024)
+
+/* Value of nFilePos when the position of fp is not known. */
+#define SHP_UNKNOWN_FILE_POS ((SAOffset)-1)
 
 typedef struct
 {
@@ -41,18 +56,108 @@ typedef struct
     int bEnforce2GBLimit;
     int bHasWarned2GB;
     SAOffset nCurOffset;
+
+    /* nCurOffset is the logical position, and nFilePos the one of fp, */
+    /* seeks being deferred to the next operation that needs fp. */
+    SAOffset nFilePos;
+
+    /* Set by short reads and cleared by seeks, as VSIFEofL(fp) does not */
+    /* reflect deferred seeks. */
+    int bEOF;
+
+    /* Below members are only used for files opened in read-only mode. */
+    int bReadOnly;
+    SAOffset nLastReadEnd;
+    int nSequentialReads;
+    GByte *pabyBuffer;
+    SAOffset nBufferOffset;
+    size_t nBufferSize;
+
+    /* Below members are only used for files opened in update mode, */
+    /* where writes are accumulated in pabyWriteBuffer, which holds */
+    /* nWriteBufferSize bytes to write at nWriteBufferOffset. Buffering */
+    /* can be disabled with the OGR_SHAPE_BUFFER_WRITES=NO configuration */
+    /* option. */
+    int bBufferWrites;
+    GByte *pabyWriteBuffer;
+    SAOffset nWriteBufferOffset;
+    size_t nWriteBufferSize;
 } OGRSHPDBFFile;
 
+/************************************************************************/
+/*                      VSI_SHP_WriteToFile()                           */
+/************************************************************************/
+
+static size_t VSI_SHP_WriteToFile(OGRSHPDBFFile *pFile, const void *p,
+                                  SAOffset nOffset, size_t nBytes)
+{
+    size_t nWritten;
+    if (pFile->nFilePos != nOffset &&
+        VSIFSeekL(pFile->fp, (vsi_l_offset)nOffset, SEEK_SET) != 0)
+    {
+        pFile->nFilePos = SHP_UNKNOWN_FILE_POS;
+        return 0;
+    }
+    nWritten = VSIFWriteL(p, 1, nBytes, pFile->fp);
+    pFile->nFilePos = nOffset + (SAOffset)nWritten;
+    return nWritten;
+}
+
+/************************************************************************/
+/*                     VSI_SHP_FlushWriteBuffer()                       */
+/************************************************************************/
+
+static int VSI_SHP_FlushWriteBuffer(OGRSHPDBFFile *pFile)
+{
+    const size_t nToWrite = pFile->nWriteBufferSize;
+    if (nToWrite == 0)
+        return TRUE;
+    pFile->nWriteBufferSize = 0;
+    if (VSI_SHP_WriteToFile(pFile, pFile->pabyWriteBuffer,
+                            pFile->nWriteBufferOffset, nToWrite) != nToWrite)
+    {
+        CPLError(CE_Failure, CPLE_FileIO,
+                 "Failed to write " CPL_FRMT_GUIB
+                 " bytes at offset " CPL_FRMT_GUIB " of %s",
+                 (GUIntBig)nToWrite, (GUIntBig)pFile->nWriteBufferOffset,
+                 pFile->pszFilename);
+        return FALSE;
+    }
+    return TRUE;
+}
+
 /************************************************************************/
 /*                         VSI_SHP_GetVSIL()                            */
 /************************************************************************/
 
+/* Pending writes are flushed, and fp is positioned at the logical */
+/* position, so that the caller can use fp directly. */
 VSILFILE *VSI_SHP_GetVSIL(SAFile file)
 {
     OGRSHPDBFFile *pFile = (OGRSHPDBFFile *)file;
+    if (!pFile->bReadOnly)
+    {
+        VSI_SHP_FlushWriteBuffer(pFile);
+        if (pFile->nFilePos != pFile->nCurOffset)
+            VSIFSeekL(pFile->fp, (vsi_l_offset)pFile->nCurOffset, SEEK_SET);
+        /* The caller may move fp */
+        pFile->nFilePos = SHP_UNKNOWN_FILE_POS;
+    }
     return pFile->fp;
 }
 
+/************************************************************************/
+/*                            VSI_SHP_Eof()                             */
+/************************************************************************/
+
+/* To be used instead of VSIFEofL(VSI_SHP_GetVSIL(file)), since reads of */
+/* read-only files are buffered, and seeks are deferred. */
+int VSI_SHP_Eof(SAFile file)
+{
+    OGRSHPDBFFile *pFile = (OGRSHPDBFFile *)file;
+    return pFile->bEOF;
+}
+
 /************************************************************************/
 /*                        VSI_SHP_GetFilename()                         */
 /************************************************************************/
@@ -80,6 +185,10 @@ static SAFile VSI_SHP_OpenInternal(const char *pszFilename,
     pFile->pszFilename = CPLStrdup(pszFilename);
     pFile->bEnforce2GBLimit = bEnforce2GBLimit;
     pFile->nCurOffset = 0;
+    pFile->bReadOnly =
+        pszAccess[0] == 'r' && strchr(pszAccess, '+') == NULL ? TRUE : FALSE;
+    pFile->bBufferWrites =
+        CPLTestBool(CPLGetConfigOption("OGR_SHAPE_BUFFER_WRITES", "YES"));
     return (SAFile)pFile;
 }
 
@@ -107,6 +216,107 @@ static SAFile VSI_SHP_Open2GBLimit(const char *pszFilename,
     return VSI_SHP_OpenInternal(pszFilename, pszAccess, TRUE);
 }
 
+/************************************************************************/
+/*                        VSI_SHP_ReadFromFile()                        */
+/************************************************************************/
+
+static size_t VSI_SHP_ReadFromFile(OGRSHPDBFFile *pFile, void *p,
+                                   SAOffset nOffset, size_t nBytes)
+{
+    size_t nRead;
+    if (pFile->nFilePos != nOffset &&
+        VSIFSeekL(pFile->fp, (vsi_l_offset)nOffset, SEEK_SET) != 0)
+    {
+        pFile->nFilePos = (SAOffset)VSIFTellL(pFile->fp);
+        return 0;
+    }
+    nRead = VSIFReadL(p, 1, nBytes, pFile->fp);
+    pFile->nFilePos = nOffset + (SAOffset)nRead;
+    return nRead;
+}
+
+/************************************************************************/
+/*                        VSI_SHP_ReadBuffered()                        */
+/************************************************************************/
+
+/* Read implementation for read-only files. Sequential scans of .shp and */
+/* .dbf files issue one or two small reads per record: once a few */
+/* consecutive reads have been detected, data is read by large blocks. */
+/* Random reads go directly to the file. */
+
+static SAOffset VSI_SHP_ReadBuffered(void *p, SAOffset size, SAOffset nmemb,
+                                     SAFile file)
+{
+    OGRSHPDBFFile *pFile = (OGRSHPDBFFile *)file;
+    GByte *pabyDst = (GByte *)p;
+    const size_t nToRead = (size_t)(size * nmemb);
+    size_t nRemaining = nToRead;
+    SAOffset nOffset = pFile->nCurOffset;
+
+    if (size <= 0 || nmemb <= 0)
+        return 0;
+
+    if (nOffset == pFile->nLastReadEnd)
+        pFile->nSequentialReads++;
+    else
+        pFile->nSequentialReads = 0;
+
+    while (nRemaining > 0)
+    {
+        size_t nRead;
+        if (pFile->pabyBuffer != NULL && nOffset >= pFile->nBufferOffset &&
+            nOffset < pFile->nBufferOffset + (SAOffset)pFile->nBufferSize)
+        {
+            const size_t nInBuffer =
+                (size_t)(nOffset - pFile->nBufferOffset);
+            nRead = pFile->nBufferSize - nInBuffer;
+            if (nRead > nRemaining)
+                nRead = nRemaining;
+            memcpy(pabyDst, pFile->pabyBuffer + nInBuffer, nRead);
+        }
+        else if (pFile->nSequentialReads < SHP_READ_AHEAD_TRIGGER ||
+                 nRemaining >= SHP_READ_AHEAD_SIZE)
+        {
+            nRead = VSI_SHP_ReadFromFile(pFile, pabyDst, nOffset, nRemaining);
+            if (nRead < nRemaining)
+            {
+                pabyDst += nRead;
+                nOffset += (SAOffset)nRead;
+                nRemaining -= nRead;
+                break;
+            }
+        }
+        else
+        {
+            if (pFile->pabyBuffer == NULL)
+            {
+                pFile->pabyBuffer =
+                    (GByte *)VSI_MALLOC_VERBOSE(SHP_READ_AHEAD_SIZE);
+                if (pFile->pabyBuffer == NULL)
+                {
+                    pFile->nSequentialReads = 0;
+                    continue;
+                }
+            }
+            pFile->nBufferOffset = nOffset;
+            pFile->nBufferSize = VSI_SHP_ReadFromFile(
+                pFile, pFile->pabyBuffer, nOffset, SHP_READ_AHEAD_SIZE);
+            if (pFile->nBufferSize == 0)
+                break;
+            continue;
+        }
+        pabyDst += nRead;
+        nOffset += (SAOffset)nRead;
+        nRemaining -= nRead;
+    }
+
+    pFile->nCurOffset = nOffset;
+    pFile->nLastReadEnd = nOffset;
+    if (nRemaining > 0)
+        pFile->bEOF = TRUE;
+    return (SAOffset)((nToRead - nRemaining) / (size_t)size);
+}
+
 /************************************************************************/
 /*                            VSI_SHP_Read()                            */
 /************************************************************************/
@@ -116,10 +326,17 @@ static SAOffset VSI_SHP_Read(void *p, SAOffset size, SAOffset nmemb,
 
 {
     OGRSHPDBFFile *pFile = (OGRSHPDBFFile *)file;
-    SAOffset ret =
-        (SAOffset)VSIFReadL(p, (size_t)size, (size_t)nmemb, pFile->fp);
-    pFile->nCurOffset += ret * size;
-    return ret;
+    size_t nRead;
+    if (pFile->bReadOnly)
+        return VSI_SHP_ReadBuffered(p, size, nmemb, file);
+    if (size <= 0 || nmemb <= 0 || !VSI_SHP_FlushWriteBuffer(pFile))
+        return 0;
+    nRead = VSI_SHP_ReadFromFile(pFile, p, pFile->nCurOffset,
+                                 (size_t)(size * nmemb));
+    pFile->nCurOffset += (SAOffset)nRead;
+    if (nRead < (size_t)(size * nmemb))
+        pFile->bEOF = TRUE;
+    return (SAOffset)(nRead / (size_t)size);
 }
 
 /************************************************************************/
@@ -151,6 +368,53 @@ int VSI_SHP_WriteMoreDataOK(SAFile file, SAOffset nExtraBytes)
     return TRUE;
 }
 
+/************************************************************************/
+/*                       VSI_SHP_WriteBuffered()                        */
+/************************************************************************/
+
+/* Shapefile writers issue one or two small writes per record, and seek */
+/* back over the end-of-file character of the .dbf before each record. */
+/* Writes within or right after the pending data are accumulated in a */
+/* buffer written by large blocks, so that the file is written */
+/* sequentially. */
+
+static size_t VSI_SHP_WriteBuffered(OGRSHPDBFFile *pFile, const void *p,
+                                    size_t nBytes)
+{
+    const SAOffset nOffset = pFile->nCurOffset;
+    size_t nPosInBuffer;
+
+    if (pFile->nWriteBufferSize > 0 &&
+        (nOffset < pFile->nWriteBufferOffset ||
+         nOffset > pFile->nWriteBufferOffset + pFile->nWriteBufferSize ||
+         (size_t)(nOffset - pFile->nWriteBufferOffset) + nBytes >
+             SHP_WRITE_BUFFER_SIZE))
+    {
+        if (!VSI_SHP_FlushWriteBuffer(pFile))
+            return 0;
+    }
+
+    if (pFile->nWriteBufferSize == 0)
+    {
+        if (!pFile->bBufferWrites || nBytes >= SHP_WRITE_BUFFER_SIZE)
+            return VSI_SHP_WriteToFile(pFile, p, nOffset, nBytes);
+        if (pFile->pabyWriteBuffer == NULL)
+        {
+            pFile->pabyWriteBuffer =
+                (GByte *)VSI_MALLOC_VERBOSE(SHP_WRITE_BUFFER_SIZE);
+            if (pFile->pabyWriteBuffer == NULL)
+                return VSI_SHP_WriteToFile(pFile, p, nOffset, nBytes);
+        }
+        pFile->nWriteBufferOffset = nOffset;
+    }
+
+    nPosInBuffer = (size_t)(nOffset - pFile->nWriteBufferOffset);
+    memcpy(pFile->pabyWriteBuffer + nPosInBuffer, p, nBytes);
+    if (nPosInBuffer + nBytes > pFile->nWriteBufferSize)
+        pFile->nWriteBufferSize = nPosInBuffer + nBytes;
+    return nBytes;
+}
+
 /************************************************************************/
 /*                           VSI_SHP_Write()                            */
 /************************************************************************/
@@ -160,12 +424,14 @@ static SAOffset VSI_SHP_Write(const void *p, SAOffset size, SAOffset nmemb,
 
 {
     OGRSHPDBFFile *pFile = (OGRSHPDBFFile *)file;
-    SAOffset ret;
+    size_t nWritten;
     if (!VSI_SHP_WriteMoreDataOK(file, size * nmemb))
         return 0;
-    ret = (SAOffset)VSIFWriteL(p, (size_t)size, (size_t)nmemb, pFile->fp);
-    pFile->nCurOffset += ret * size;
-    return ret;
+    if (size <= 0 || nmemb <= 0)
+        return 0;
+    nWritten = VSI_SHP_WriteBuffered(pFile, p, (size_t)(size * nmemb));
+    pFile->nCurOffset += (SAOffset)nWritten;
+    return (SAOffset)(nWritten / (size_t)size);
 }
 
 /************************************************************************/
@@ -176,11 +442,45 @@ static SAOffset VSI_SHP_Seek(SAFile file, SAOffset offset, int whence)
 
 {
     OGRSHPDBFFile *pFile = (OGRSHPDBFFile *)file;
-    SAOffset ret = (SAOffset)VSIFSeekL(pFile->fp, (vsi_l_offset)offset, whence);
-    if (whence == 0 && ret == 0)
-        pFile->nCurOffset = offset;
-    else
+    SAOffset ret;
+    pFile->bEOF = FALSE;
+    if (pFile->bReadOnly)
+    {
+        /* Seeking is deferred to the next read that needs the file. */
+        if (whence == SEEK_SET)
+        {
+            pFile->nCurOffset = offset;
+            return 0;
+        }
+        if (whence == SEEK_CUR)
+        {
+            pFile->nCurOffset += offset;
+            return 0;
+        }
+        if (pFile->nFilePos != pFile->nCurOffset)
+            VSIFSeekL(pFile->fp, (vsi_l_offset)pFile->nCurOffset, SEEK_SET);
+        ret = (SAOffset)VSIFSeekL(pFile->fp, (vsi_l_offset)offset, whence);
         pFile->nCurOffset = (SAOffset)VSIFTellL(pFile->fp);
+        pFile->nFilePos = pFile->nCurOffset;
+        return ret;
+    }
+    /* Seeking is deferred to the next read or write that needs the file. */
+    if (whence == SEEK_SET)
+    {
+        pFile->nCurOffset = offset;
+        return 0;
+    }
+    if (whence == SEEK_CUR)
+    {
+        pFile->nCurOffset += offset;
+        return 0;
+    }
+    /* The file size must account for pending writes */
+    if (!VSI_SHP_FlushWriteBuffer(pFile))
+        return -1;
+    ret = (SAOffset)VSIFSeekL(pFile->fp, (vsi_l_offset)offset, whence);
+    pFile->nCurOffset = (SAOffset)VSIFTellL(pFile->fp);
+    pFile->nFilePos = pFile->nCurOffset;
     return ret;
 }
 
@@ -203,6 +503,8 @@ static int VSI_SHP_Flush(SAFile file)
 
 {
     OGRSHPDBFFile *pFile = (OGRSHPDBFFile *)file;
+    if (!VSI_SHP_FlushWriteBuffer(pFile))
+        return -1;
     return VSIFFlushL(pFile->fp);
 }
 
@@ -214,7 +516,12 @@ static int VSI_SHP_Close(SAFile file)
 
 {
     OGRSHPDBFFile *pFile = (OGRSHPDBFFile *)file;
+    const int bFlushOK = VSI_SHP_FlushWriteBuffer(pFile);
     int ret = VSIFCloseL(pFile->fp);
+    if (!bFlushOK)
+        ret = -1;
+    VSIFree(pFile->pabyBuffer);
+    VSIFree(pFile->pabyWriteBuffer);
     CPLFree(pFile->pszFilename);
     CPLFree(pFile);
     return ret;
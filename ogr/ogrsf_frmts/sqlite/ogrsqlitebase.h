@@ -145,7 +145,8 @@ class OGRSQLiteBaseDataSource CPL_NON_FINAL : public GDALPamDataset
     bool OpenOrCreateDB(int flags, bool bRegisterOGR2SQLiteExtensions,
                         bool bLoadExtensions);
     bool SetSynchronous();
-    bool SetCacheSize();
+    bool SetCacheSize(bool bReadOnly);
+    bool SetMMapSize(bool bReadOnly);
     void LoadExtensions();
 
     bool CloseDB();
@@ -40,6 +40,7 @@
 #include "ogrsqliteutility.h"
 #include "ogrsqlitevfs.h"
 
+#include <algorithm>
 #include <cctype>
 #include <cstddef>
 #include <cstdio>
@@ -1160,10 +1161,12 @@ void OGRSQLiteBaseDataSource::LoadExtensions()
 /*                              SetCacheSize()                          */
 /************************************************************************/
 
-bool OGRSQLiteBaseDataSource::SetCacheSize()
+bool OGRSQLiteBaseDataSource::SetCacheSize(bool bReadOnly)
 {
+    // Read-only connections are typically used for random access to large
+    // databases, for which the default 2 MB of SQLite is too small.
     const char *pszSqliteCacheMB =
-        CPLGetConfigOption("OGR_SQLITE_CACHE", nullptr);
+        CPLGetConfigOption("OGR_SQLITE_CACHE", bReadOnly ? "16" : nullptr);
     if (pszSqliteCacheMB != nullptr)
     {
         const GIntBig iSqliteCacheBytes =
@@ -1185,6 +1188,28 @@ bool OGRSQLiteBaseDataSource::SetCacheSize()
     return true;
 }
 
+/************************************************************************/
+/*                              SetMMapSize()                           */
+/************************************************************************/
+
+// Memory-mapped I/O avoids a system call and a copy for each page read.
+// It is only enabled by default for read-only connections, as SQLite
+// recommends, since an I/O error on a memory-mapped file, or a truncation
+// of the file by another process, results in a crash.
+bool OGRSQLiteBaseDataSource::SetMMapSize(bool bReadOnly)
+{
+    const char *pszMMapSizeMB =
+        CPLGetConfigOption("OGR_SQLITE_MMAP_SIZE", bReadOnly ? "256" : nullptr);
+    if (pszMMapSizeMB != nullptr)
+    {
+        const GIntBig nMMapSizeBytes =
+            std::max<GIntBig>(0, CPLAtoGIntBig(pszMMapSizeMB)) * 1024 * 1024;
+        return SQLCommand(hDB, CPLSPrintf("PRAGMA mmap_size = " CPL_FRMT_GIB,
+                                          nMMapSizeBytes)) == OGRERR_NONE;
+    }
+    return true;
+}
+
 /************************************************************************/
 /*               OGRSQLiteBaseDataSourceNotifyFileOpened()              */
 /************************************************************************/
@@ -1633,7 +1658,9 @@ bool OGRSQLiteBaseDataSource::OpenOrCreateDB(int flagsIn,
             sqlite3_exec(hDB, pszSQL, nullptr, nullptr, nullptr));
     }
 
-    SetCacheSize();
+    const bool bReadOnly = (flagsIn & SQLITE_OPEN_READWRITE) == 0;
+    SetCacheSize(bReadOnly);
+    SetMMapSize(bReadOnly);
     SetSynchronous();
     if (bLoadExtensions)
         LoadExtensions();
@@ -29,6 +29,7 @@
 #include "cpl_port.h"
 #include "ogr_sqlite.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -37,7 +38,9 @@
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_string.h"
+#include "cpl_virtualmem.h"
 #include "cpl_vsi.h"
+#include "cpl_vsi_virtual.h"
 #include "ogrsqlitevfs.h"
 
 #ifdef DEBUG_IO
@@ -66,6 +69,19 @@ typedef struct
     VSILFILE *fp;
     int bDeleteOnClose;
     char *pszFilename;
+
+    // Memory mapping of the main database file, when it is opened in
+    // read-only mode and is a local file. Used by xFetch()/xUnfetch()
+    int bCanMMap;
+    CPLVirtualMem *psMMap;
+    int nFetchOut;
+
+    // Read-ahead of network files opened in read-only mode
+    int bReadAhead;
+    vsi_l_offset nFileSize;
+    vsi_l_offset nLastReadEnd;
+    vsi_l_offset nReadAheadEnd;
+    int nSequentialReads;
 } OGRSQLiteFileStruct;
 
 static int OGRSQLiteIOClose(sqlite3_file *pFile)
@@ -75,6 +91,8 @@ static int OGRSQLiteIOClose(sqlite3_file *pFile)
     CPLDebug("SQLITE", "OGRSQLiteIOClose(%p (%s))", pMyFile->fp,
              pMyFile->pszFilename);
 #endif
+    if (pMyFile->psMMap)
+        CPLVirtualMemFree(pMyFile->psMMap);
     VSIFCloseL(pMyFile->fp);
     if (pMyFile->bDeleteOnClose)
         VSIUnlink(pMyFile->pszFilename);
@@ -82,10 +100,40 @@ static int OGRSQLiteIOClose(sqlite3_file *pFile)
     return SQLITE_OK;
 }
 
+// SQLite reads pages one at a time. When it reads consecutive pages of a
+// network file, as in full table scans, ask the file system to fetch the
+// next pages in one request, in the background.
+static void OGRSQLiteIOReadAhead(OGRSQLiteFileStruct *pMyFile, int iAmt,
+                                 sqlite3_int64 iOfst)
+{
+    constexpr int MIN_SEQUENTIAL_READS = 3;
+    constexpr vsi_l_offset READ_AHEAD_SIZE = 1024 * 1024;
+
+    const vsi_l_offset nOffset = static_cast<vsi_l_offset>(iOfst);
+    if (nOffset == pMyFile->nLastReadEnd)
+        pMyFile->nSequentialReads++;
+    else
+        pMyFile->nSequentialReads = 0;
+    pMyFile->nLastReadEnd = nOffset + iAmt;
+
+    if (pMyFile->nSequentialReads >= MIN_SEQUENTIAL_READS &&
+        pMyFile->nLastReadEnd > pMyFile->nReadAheadEnd &&
+        pMyFile->nLastReadEnd < pMyFile->nFileSize)
+    {
+        const vsi_l_offset nStart = pMyFile->nLastReadEnd;
+        const size_t nSize = static_cast<size_t>(
+            std::min(READ_AHEAD_SIZE, pMyFile->nFileSize - nStart));
+        pMyFile->fp->AdviseRead(1, &nStart, &nSize);
+        pMyFile->nReadAheadEnd = nStart + nSize;
+    }
+}
+
 static int OGRSQLiteIORead(sqlite3_file *pFile, void *pBuffer, int iAmt,
                            sqlite3_int64 iOfst)
 {
     OGRSQLiteFileStruct *pMyFile = (OGRSQLiteFileStruct *)pFile;
+    if (pMyFile->bReadAhead)
+        OGRSQLiteIOReadAhead(pMyFile, iAmt, iOfst);
     VSIFSeekL(pMyFile->fp, (vsi_l_offset)iOfst, SEEK_SET);
     int nRead = (int)VSIFReadL(pBuffer, 1, iAmt, pMyFile->fp);
 #ifdef DEBUG_IO
@@ -209,8 +257,70 @@ static int OGRSQLiteIODeviceCharacteristics(DEBUG_ONLY sqlite3_file *pFile)
     return 0;
 }
 
+static int OGRSQLiteIOFetch(sqlite3_file *pFile, sqlite3_int64 iOfst,
+                            int iAmt, void **pp)
+{
+    OGRSQLiteFileStruct *pMyFile = (OGRSQLiteFileStruct *)pFile;
+    *pp = nullptr;
+    if (!pMyFile->bCanMMap)
+        return SQLITE_OK;
+    if (pMyFile->psMMap == nullptr)
+    {
+        // Map the whole file at the first request. SQLite only uses the
+        // mapping up to the PRAGMA mmap_size value.
+        sqlite3_int64 nSize = 0;
+        OGRSQLiteIOFileSize(pFile, &nSize);
+        if (nSize > 0)
+        {
+            pMyFile->psMMap = CPLVirtualMemFileMapNew(
+                pMyFile->fp, 0, static_cast<vsi_l_offset>(nSize),
+                VIRTUALMEM_READONLY, nullptr, nullptr);
+        }
+        if (pMyFile->psMMap == nullptr)
+        {
+            pMyFile->bCanMMap = FALSE;
+            return SQLITE_OK;
+        }
+    }
+    if (iOfst >= 0 &&
+        static_cast<size_t>(iOfst) + iAmt <=
+            CPLVirtualMemGetSize(pMyFile->psMMap))
+    {
+        *pp = static_cast<GByte *>(CPLVirtualMemGetAddr(pMyFile->psMMap)) +
+              static_cast<size_t>(iOfst);
+        pMyFile->nFetchOut++;
+    }
+#ifdef DEBUG_IO
+    CPLDebug("SQLITE", "OGRSQLiteIOFetch(%p, %d, %d) = %p", pMyFile->fp, iAmt,
+             (int)iOfst, *pp);
+#endif
+    return SQLITE_OK;
+}
+
+static int OGRSQLiteIOUnfetch(sqlite3_file *pFile,
+                              DEBUG_ONLY sqlite3_int64 iOfst, void *p)
+{
+    OGRSQLiteFileStruct *pMyFile = (OGRSQLiteFileStruct *)pFile;
+#ifdef DEBUG_IO
+    CPLDebug("SQLITE", "OGRSQLiteIOUnfetch(%p, %d, %p)", pMyFile->fp,
+             (int)iOfst, p);
+#endif
+    if (p)
+    {
+        pMyFile->nFetchOut--;
+    }
+    else if (pMyFile->psMMap && pMyFile->nFetchOut == 0)
+    {
+        // SQLite requests the mapping to be released, typically because the
+        // file size has changed. It will be recreated at the next xFetch()
+        CPLVirtualMemFree(pMyFile->psMMap);
+        pMyFile->psMMap = nullptr;
+    }
+    return SQLITE_OK;
+}
+
 static const sqlite3_io_methods OGRSQLiteIOMethods = {
-    1,
+    3,
     OGRSQLiteIOClose,
     OGRSQLiteIORead,
     OGRSQLiteIOWrite,
@@ -227,8 +337,8 @@ static const sqlite3_io_methods OGRSQLiteIOMethods = {
     nullptr,  // xShmLock
     nullptr,  // xShmBarrier
     nullptr,  // xShmUnmap
-    nullptr,  // xFetch
-    nullptr,  // xUnfetch
+    OGRSQLiteIOFetch,
+    OGRSQLiteIOUnfetch,
 };
 
 static int OGRSQLiteVFSOpen(sqlite3_vfs *pVFS, const char *zName,
@@ -252,6 +362,14 @@ static int OGRSQLiteVFSOpen(sqlite3_vfs *pVFS, const char *zName,
     pMyFile->pMethods = nullptr;
     pMyFile->bDeleteOnClose = FALSE;
     pMyFile->pszFilename = nullptr;
+    pMyFile->bCanMMap = FALSE;
+    pMyFile->psMMap = nullptr;
+    pMyFile->nFetchOut = 0;
+    pMyFile->bReadAhead = FALSE;
+    pMyFile->nFileSize = 0;
+    pMyFile->nLastReadEnd = 0;
+    pMyFile->nReadAheadEnd = 0;
+    pMyFile->nSequentialReads = 0;
     if (flags & SQLITE_OPEN_READONLY)
         pMyFile->fp = VSIFOpenL(zName, "rb");
     else if (flags & SQLITE_OPEN_CREATE)
@@ -284,6 +402,21 @@ static int OGRSQLiteVFSOpen(sqlite3_vfs *pVFS, const char *zName,
     pMyFile->bDeleteOnClose = (flags & SQLITE_OPEN_DELETEONCLOSE);
     pMyFile->pszFilename = CPLStrdup(zName);
 
+    if ((flags & SQLITE_OPEN_READONLY) && (flags & SQLITE_OPEN_MAIN_DB))
+    {
+        if (VSIFGetNativeFileDescriptorL(pMyFile->fp) != nullptr)
+        {
+            pMyFile->bCanMMap = CPLIsVirtualMemFileMapAvailable();
+        }
+        else if (VSIHasOptimizedReadMultiRange(zName))
+        {
+            pMyFile->bReadAhead = TRUE;
+            VSIFSeekL(pMyFile->fp, 0, SEEK_END);
+            pMyFile->nFileSize = VSIFTellL(pMyFile->fp);
+            VSIFSeekL(pMyFile->fp, 0, SEEK_SET);
+        }
+    }
+
     if (pOutFlags != nullptr)
         *pOutFlags = flags;
 
@@ -31,12 +31,15 @@
 #include "cpl_port.h"
 #include "ogrsqlitevirtualogr.h"
 
+#include <algorithm>
 #include <cctype>
+#include <climits>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <limits>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <utility>
@@ -44,6 +47,7 @@
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_quad_tree.h"
 #include "cpl_string.h"
 
 /************************************************************************/
@@ -389,6 +393,48 @@ typedef struct
     bool bHasFIDColumn;
 } OGR2SQLITE_vtab;
 
+/************************************************************************/
+/*                        OGR2SQLITESpatialCache                        */
+/************************************************************************/
+
+/* In-memory index of the feature envelopes of a layer, built the first */
+/* time a spatial constraint is applied to a cursor, for layers that have */
+/* no fast spatial filter. Typically used for the inner table of a */
+/* spatial join, where the constraint changes for each row of the outer */
+/* table. For layers with a fast spatial filter, only the FIDs of the */
+/* features without geometry are collected. */
+struct OGR2SQLITESpatialCache
+{
+    struct Item
+    {
+        GIntBig nFID;
+        CPLRectObj sRect;
+    };
+
+    int iGeomField = -1;
+    std::vector<Item> asItems{};
+    CPLQuadTree *hTree = nullptr;
+
+    /* Features with a null or empty geometry, for which the predicates */
+    /* return -1, and that must thus be returned for any constraint. */
+    std::vector<GIntBig> anNullGeomFIDs{};
+
+    /* FIDs matching the current constraint, when bActive */
+    bool bActive = false;
+    std::vector<GIntBig> anCandidateFIDs{};
+    size_t iNextCandidate = 0;
+
+    OGR2SQLITESpatialCache() = default;
+
+    ~OGR2SQLITESpatialCache()
+    {
+        if (hTree)
+            CPLQuadTreeDestroy(hTree);
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(OGR2SQLITESpatialCache)
+};
+
 /************************************************************************/
 /*                          OGR2SQLITE_vtab_cursor                      */
 /************************************************************************/
@@ -413,6 +459,12 @@ typedef struct
 
     GByte *pabyGeomBLOB;
     int nGeomBLOBLen;
+
+    /* Spatial constraint pushed down by OGR2SQLITE_BestIndex() */
+    bool bHasSetSpatialFilter;
+    int iPrevGeomFieldFilter;
+    OGRGeometry *poPrevSpatialFilter;
+    OGR2SQLITESpatialCache *poSpatialCache;
 } OGR2SQLITE_vtab_cursor;
 
 #ifdef VIRTUAL_OGR_DYNAMIC_EXTENSION_ENABLED
@@ -846,6 +898,113 @@ static bool OGR2SQLITE_IsHandledOp(int op)
     return false;
 }
 
+#ifdef SQLITE_INDEX_CONSTRAINT_FUNCTION
+
+/************************************************************************/
+/*                     OGR2SQLITESpatialPredicate                       */
+/************************************************************************/
+
+/* Binary spatial predicates that can only be true if the envelopes of */
+/* their arguments intersect. */
+typedef struct
+{
+    const char *pszName;
+    /* nullptr for a comparison of envelopes only */
+    bool (*pfnEvaluate)(const OGRGeometry *, const OGRGeometry *);
+} OGR2SQLITESpatialPredicate;
+
+static const OGR2SQLITESpatialPredicate asSpatialPredicates[] = {
+    {"ST_Intersects", [](const OGRGeometry *poGeom1,
+                         const OGRGeometry *poGeom2)
+     { return CPL_TO_BOOL(poGeom1->Intersects(poGeom2)); }},
+    {"ST_Contains", [](const OGRGeometry *poGeom1, const OGRGeometry *poGeom2)
+     { return CPL_TO_BOOL(poGeom1->Contains(poGeom2)); }},
+    {"ST_Within", [](const OGRGeometry *poGeom1, const OGRGeometry *poGeom2)
+     { return CPL_TO_BOOL(poGeom1->Within(poGeom2)); }},
+    {"ST_Touches", [](const OGRGeometry *poGeom1, const OGRGeometry *poGeom2)
+     { return CPL_TO_BOOL(poGeom1->Touches(poGeom2)); }},
+    {"ST_Crosses", [](const OGRGeometry *poGeom1, const OGRGeometry *poGeom2)
+     { return CPL_TO_BOOL(poGeom1->Crosses(poGeom2)); }},
+    {"ST_Overlaps", [](const OGRGeometry *poGeom1, const OGRGeometry *poGeom2)
+     { return CPL_TO_BOOL(poGeom1->Overlaps(poGeom2)); }},
+    {"ST_Equals", [](const OGRGeometry *poGeom1, const OGRGeometry *poGeom2)
+     { return CPL_TO_BOOL(poGeom1->Equals(poGeom2)); }},
+    {"MbrIntersects", nullptr},
+    {"ST_EnvIntersects", nullptr},
+};
+
+/************************************************************************/
+/*                 OGR2SQLITE_GetSpatialiteEnvelope()                   */
+/************************************************************************/
+
+static bool OGR2SQLITE_GetSpatialiteEnvelope(sqlite3_value *pValue,
+                                             OGREnvelope &sEnvelope)
+{
+    if (sqlite3_value_type(pValue) != SQLITE_BLOB)
+        return false;
+    bool bIsEmpty = false;
+    return OGRSQLiteLayer::GetSpatialiteGeometryHeader(
+               static_cast<const GByte *>(sqlite3_value_blob(pValue)),
+               sqlite3_value_bytes(pValue), nullptr, nullptr, &bIsEmpty,
+               &sEnvelope.MinX, &sEnvelope.MinY, &sEnvelope.MaxX,
+               &sEnvelope.MaxY) == OGRERR_NONE &&
+           !bIsEmpty;
+}
+
+/************************************************************************/
+/*                   OGR2SQLITE_EvaluateSpatialPredicate()              */
+/************************************************************************/
+
+static void OGR2SQLITE_EvaluateSpatialPredicate(sqlite3_context *pContext,
+                                                int argc, sqlite3_value **argv)
+{
+    const OGR2SQLITESpatialPredicate *psPredicate =
+        static_cast<const OGR2SQLITESpatialPredicate *>(
+            sqlite3_user_data(pContext));
+
+    // Like SpatiaLite, return -1 when an argument is NULL, invalid or empty.
+    OGREnvelope sEnvelope1;
+    OGREnvelope sEnvelope2;
+    if (argc != 2 || !OGR2SQLITE_GetSpatialiteEnvelope(argv[0], sEnvelope1) ||
+        !OGR2SQLITE_GetSpatialiteEnvelope(argv[1], sEnvelope2))
+    {
+        sqlite3_result_int(pContext, -1);
+        return;
+    }
+    if (!sEnvelope1.Intersects(sEnvelope2))
+    {
+        sqlite3_result_int(pContext, 0);
+        return;
+    }
+    if (psPredicate->pfnEvaluate == nullptr)
+    {
+        sqlite3_result_int(pContext, 1);
+        return;
+    }
+
+    std::unique_ptr<OGRGeometry> apoGeoms[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        OGRGeometry *poGeom = nullptr;
+        if (OGRSQLiteLayer::ImportSpatiaLiteGeometry(
+                static_cast<const GByte *>(sqlite3_value_blob(argv[i])),
+                sqlite3_value_bytes(argv[i]), &poGeom) != OGRERR_NONE)
+        {
+            delete poGeom;
+            sqlite3_result_int(pContext, -1);
+            return;
+        }
+        apoGeoms[i].reset(poGeom);
+    }
+    sqlite3_result_int(pContext,
+                       psPredicate->pfnEvaluate(apoGeoms[0].get(),
+                                                apoGeoms[1].get())
+                           ? 1
+                           : 0);
+}
+
+#endif  // SQLITE_INDEX_CONSTRAINT_FUNCTION
+
 /************************************************************************/
 /*                        OGR2SQLITE_BestIndex()                        */
 /************************************************************************/
@@ -950,6 +1109,7 @@ static int OGR2SQLITE_BestIndex(sqlite3_vtab *pVTab, sqlite3_index_info *pIndex)
 #endif
 
     int nConstraints = 0;
+    bool bHasSpatialConstraint = false;
     for (int i = 0; i < pIndex->nConstraint; i++)
     {
         int iCol = pIndex->aConstraint[i].iColumn;
@@ -957,6 +1117,32 @@ static int OGR2SQLITE_BestIndex(sqlite3_vtab *pVTab, sqlite3_index_info *pIndex)
         if (pMyVTab->bHasFIDColumn && iCol >= 0)
             --iCol;
 
+#ifdef SQLITE_INDEX_CONSTRAINT_FUNCTION
+        if (pIndex->aConstraint[i].op >= SQLITE_INDEX_CONSTRAINT_FUNCTION)
+        {
+            // Spatial predicate overloaded by OGR2SQLITE_FindFunction():
+            // the envelope of its second argument is used as a spatial
+            // filter, but the predicate must still be evaluated by SQLite.
+            // Features without geometry match any constraint (the predicate
+            // returns -1), and are fetched by FID.
+            const int iGeomField = iCol - (poFDefn->GetFieldCount() + 1);
+            if (pIndex->aConstraint[i].usable && !bHasSpatialConstraint &&
+                iGeomField >= 0 && iGeomField < poFDefn->GetGeomFieldCount() &&
+                pMyVTab->poLayer->TestCapability(OLCRandomRead))
+            {
+                pIndex->aConstraintUsage[i].argvIndex = nConstraints + 1;
+                bHasSpatialConstraint = true;
+                nConstraints++;
+            }
+            else
+            {
+                pIndex->aConstraintUsage[i].argvIndex = 0;
+            }
+            pIndex->aConstraintUsage[i].omit = false;
+            continue;
+        }
+#endif
+
         if (pIndex->aConstraint[i].usable &&
             OGR2SQLITE_IsHandledOp(pIndex->aConstraint[i].op) &&
             iCol < poFDefn->GetFieldCount() &&
@@ -986,13 +1172,18 @@ static int OGR2SQLITE_BestIndex(sqlite3_vtab *pVTab, sqlite3_index_info *pIndex)
 
         for (int i = 0; i < pIndex->nConstraint; i++)
         {
-            if (pIndex->aConstraintUsage[i].omit)
+            if (pIndex->aConstraintUsage[i].argvIndex > 0)
             {
                 panConstraints[2 * nConstraints + 1] =
                     pIndex->aConstraint[i].iColumn;
                 panConstraints[2 * nConstraints + 2] =
                     pIndex->aConstraint[i].op;
 
+                // The attribute filter is not applied when features are
+                // fetched from the envelope cache.
+                if (bHasSpatialConstraint)
+                    pIndex->aConstraintUsage[i].omit = false;
+
                 nConstraints++;
             }
         }
@@ -1001,6 +1192,16 @@ static int OGR2SQLITE_BestIndex(sqlite3_vtab *pVTab, sqlite3_index_info *pIndex)
     pIndex->orderByConsumed = false;
     pIndex->idxNum = 0;
 
+#ifdef SQLITE_INDEX_CONSTRAINT_FUNCTION
+    if (bHasSpatialConstraint)
+    {
+        // Favor plans where the spatial constraint is used, typically with
+        // this table as the inner loop of a spatial join.
+        pIndex->estimatedCost = 100.0;
+        pIndex->estimatedRows = 10;
+    }
+#endif
+
     if (nConstraints != 0)
     {
         pIndex->idxStr = (char *)panConstraints;
@@ -1095,6 +1296,23 @@ static int OGR2SQLITE_Open(sqlite3_vtab *pVTab, sqlite3_vtab_cursor **ppCursor)
     return SQLITE_OK;
 }
 
+/************************************************************************/
+/*                   OGR2SQLITE_RestoreSpatialFilter()                  */
+/************************************************************************/
+
+/* Restore the spatial filter that the layer had before a spatial */
+/* constraint was pushed down to it. */
+static void OGR2SQLITE_RestoreSpatialFilter(OGR2SQLITE_vtab_cursor *pMyCursor)
+{
+    if (!pMyCursor->bHasSetSpatialFilter)
+        return;
+    pMyCursor->poLayer->SetSpatialFilter(pMyCursor->iPrevGeomFieldFilter,
+                                         pMyCursor->poPrevSpatialFilter);
+    delete pMyCursor->poPrevSpatialFilter;
+    pMyCursor->poPrevSpatialFilter = nullptr;
+    pMyCursor->bHasSetSpatialFilter = false;
+}
+
 /************************************************************************/
 /*                           OGR2SQLITE_Close()                         */
 /************************************************************************/
@@ -1109,7 +1327,10 @@ static int OGR2SQLITE_Close(sqlite3_vtab_cursor *pCursor)
 #endif
     pMyVTab->nMyRef--;
 
+    OGR2SQLITE_RestoreSpatialFilter(pMyCursor);
+
     delete pMyCursor->poFeature;
+    delete pMyCursor->poSpatialCache;
     delete pMyCursor->poDupDataSource;
 
     CPLFree(pMyCursor->pabyGeomBLOB);
@@ -1119,6 +1340,256 @@ static int OGR2SQLITE_Close(sqlite3_vtab_cursor *pCursor)
     return SQLITE_OK;
 }
 
+#ifdef SQLITE_INDEX_CONSTRAINT_FUNCTION
+
+/************************************************************************/
+/*                     OGR2SQLITE_BuildSpatialCache()                   */
+/************************************************************************/
+
+static void OGR2SQLITE_GetSpatialCacheItemBounds(const void *hFeature,
+                                                 CPLRectObj *pBounds)
+{
+    *pBounds =
+        static_cast<const OGR2SQLITESpatialCache::Item *>(hFeature)->sRect;
+}
+
+static void OGR2SQLITE_BuildSpatialCache(OGR2SQLITE_vtab_cursor *pMyCursor,
+                                         int iGeomField, bool bBuildIndex)
+{
+    delete pMyCursor->poSpatialCache;
+    auto poCache = new OGR2SQLITESpatialCache();
+    pMyCursor->poSpatialCache = poCache;
+    poCache->iGeomField = iGeomField;
+
+    // Only read the geometry field, without filters, and restore the
+    // ignored fields and the filters of the layer afterwards.
+    OGRLayer *poLayer = pMyCursor->poLayer;
+    OGRFeatureDefn *poFDefn = poLayer->GetLayerDefn();
+    CPLStringList aosPrevIgnoredFields;
+    CPLStringList aosIgnoredFields;
+    for (int i = 0; i < poFDefn->GetFieldCount(); i++)
+    {
+        const OGRFieldDefn *poFieldDefn = poFDefn->GetFieldDefn(i);
+        if (poFieldDefn->IsIgnored())
+            aosPrevIgnoredFields.AddString(poFieldDefn->GetNameRef());
+        aosIgnoredFields.AddString(poFieldDefn->GetNameRef());
+    }
+    for (int i = 0; i < poFDefn->GetGeomFieldCount(); i++)
+    {
+        const OGRGeomFieldDefn *poGeomFieldDefn = poFDefn->GetGeomFieldDefn(i);
+        const char *pszName = poGeomFieldDefn->GetNameRef();
+        if (i == 0 && pszName[0] == '\0')
+            pszName = "OGR_GEOMETRY";
+        if (poGeomFieldDefn->IsIgnored())
+            aosPrevIgnoredFields.AddString(pszName);
+        if (i != iGeomField)
+            aosIgnoredFields.AddString(pszName);
+    }
+    if (poFDefn->IsStyleIgnored())
+        aosPrevIgnoredFields.AddString("OGR_STYLE");
+    aosIgnoredFields.AddString("OGR_STYLE");
+    poLayer->SetIgnoredFields(
+        const_cast<const char **>(aosIgnoredFields.List()));
+
+    const char *pszPrevAttrQuery = poLayer->GetAttrQueryString();
+    const std::string osPrevAttrQuery(pszPrevAttrQuery ? pszPrevAttrQuery
+                                                       : "");
+    const int iPrevGeomFieldFilter = poLayer->GetGeomFieldFilter();
+    std::unique_ptr<OGRGeometry> poPrevSpatialFilter;
+    if (poLayer->GetSpatialFilter())
+        poPrevSpatialFilter.reset(poLayer->GetSpatialFilter()->clone());
+    poLayer->SetAttributeFilter(nullptr);
+    poLayer->SetSpatialFilter(nullptr);
+
+    CPLRectObj sGlobalBounds = {0, 0, 0, 0};
+    for (auto &&poFeature : poLayer)
+    {
+        const OGRGeometry *poGeom = poFeature->GetGeomFieldRef(iGeomField);
+        if (poGeom == nullptr || poGeom->IsEmpty())
+        {
+            poCache->anNullGeomFIDs.push_back(poFeature->GetFID());
+            continue;
+        }
+        if (!bBuildIndex)
+            continue;
+        OGREnvelope sEnvelope;
+        poGeom->getEnvelope(&sEnvelope);
+        OGR2SQLITESpatialCache::Item sItem;
+        sItem.nFID = poFeature->GetFID();
+        sItem.sRect.minx = sEnvelope.MinX;
+        sItem.sRect.miny = sEnvelope.MinY;
+        sItem.sRect.maxx = sEnvelope.MaxX;
+        sItem.sRect.maxy = sEnvelope.MaxY;
+        if (poCache->asItems.empty())
+        {
+            sGlobalBounds = sItem.sRect;
+        }
+        else
+        {
+            sGlobalBounds.minx = std::min(sGlobalBounds.minx, sItem.sRect.minx);
+            sGlobalBounds.miny = std::min(sGlobalBounds.miny, sItem.sRect.miny);
+            sGlobalBounds.maxx = std::max(sGlobalBounds.maxx, sItem.sRect.maxx);
+            sGlobalBounds.maxy = std::max(sGlobalBounds.maxy, sItem.sRect.maxy);
+        }
+        poCache->asItems.push_back(sItem);
+    }
+
+    poLayer->SetIgnoredFields(
+        const_cast<const char **>(aosPrevIgnoredFields.List()));
+    poLayer->SetAttributeFilter(
+        osPrevAttrQuery.empty() ? nullptr : osPrevAttrQuery.c_str());
+    poLayer->SetSpatialFilter(iPrevGeomFieldFilter, poPrevSpatialFilter.get());
+
+    if (!bBuildIndex)
+    {
+        CPLDebug("OGR2SQLITE", "%d features of %s have no geometry",
+                 static_cast<int>(poCache->anNullGeomFIDs.size()),
+                 poLayer->GetName());
+        return;
+    }
+
+    poCache->hTree = CPLQuadTreeCreate(&sGlobalBounds,
+                                       OGR2SQLITE_GetSpatialCacheItemBounds);
+    CPLQuadTreeSetMaxDepth(poCache->hTree,
+                           CPLQuadTreeGetAdvisedMaxDepth(
+                               static_cast<int>(std::min<size_t>(
+                                   poCache->asItems.size(), INT_MAX))));
+    for (auto &sItem : poCache->asItems)
+        CPLQuadTreeInsert(poCache->hTree, &sItem);
+
+    CPLDebug("OGR2SQLITE", "Envelope cache of %s built with %d features",
+             poLayer->GetName(), static_cast<int>(poCache->asItems.size()));
+}
+
+/************************************************************************/
+/*                    OGR2SQLITE_GetNextCandidate()                     */
+/************************************************************************/
+
+static OGRFeature *
+OGR2SQLITE_GetNextCandidate(OGR2SQLITE_vtab_cursor *pMyCursor)
+{
+    OGR2SQLITESpatialCache *poCache = pMyCursor->poSpatialCache;
+    while (poCache->iNextCandidate < poCache->anCandidateFIDs.size())
+    {
+        OGRFeature *poFeature = pMyCursor->poLayer->GetFeature(
+            poCache->anCandidateFIDs[poCache->iNextCandidate++]);
+        if (poFeature)
+            return poFeature;
+    }
+    return nullptr;
+}
+
+/************************************************************************/
+/*                  OGR2SQLITE_GetNextFilteredFeature()                 */
+/************************************************************************/
+
+/* Read the layer with the spatial filter set by */
+/* OGR2SQLITE_ApplySpatialConstraint(), then the features without */
+/* geometry. */
+static OGRFeature *
+OGR2SQLITE_GetNextFilteredFeature(OGR2SQLITE_vtab_cursor *pMyCursor)
+{
+    OGR2SQLITESpatialCache *poCache = pMyCursor->poSpatialCache;
+    if (!poCache->bActive)
+    {
+        while (OGRFeature *poFeature = pMyCursor->poLayer->GetNextFeature())
+        {
+            const OGRGeometry *poGeom =
+                poFeature->GetGeomFieldRef(poCache->iGeomField);
+            if (poGeom != nullptr && !poGeom->IsEmpty())
+                return poFeature;
+            delete poFeature;
+        }
+        poCache->anCandidateFIDs = poCache->anNullGeomFIDs;
+        poCache->iNextCandidate = 0;
+        poCache->bActive = true;
+    }
+    return OGR2SQLITE_GetNextCandidate(pMyCursor);
+}
+
+/************************************************************************/
+/*                  OGR2SQLITE_ApplySpatialConstraint()                 */
+/************************************************************************/
+
+/* Returns true if the cursor has been positioned on its first feature, */
+/* false if the layer must still be read with its spatial filter set. */
+static bool OGR2SQLITE_ApplySpatialConstraint(OGR2SQLITE_vtab_cursor *pMyCursor,
+                                              int nCol, sqlite3_value *pValue)
+{
+    if (pMyCursor->pVTab->bHasFIDColumn)
+        --nCol;
+    OGRLayer *poLayer = pMyCursor->poLayer;
+    const int iGeomField =
+        nCol - (poLayer->GetLayerDefn()->GetFieldCount() + 1);
+
+    OGREnvelope sEnvelope;
+    if (!OGR2SQLITE_GetSpatialiteEnvelope(pValue, sEnvelope))
+    {
+        // The predicate returns -1 for all features with a null or empty
+        // geometry, so the layer must be fully read.
+        OGR2SQLITE_RestoreSpatialFilter(pMyCursor);
+        return false;
+    }
+
+    // Layers with a fast spatial filter use their own index. Others are
+    // indexed in memory.
+    const bool bFastSpatialFilter =
+        CPL_TO_BOOL(poLayer->TestCapability(OLCFastSpatialFilter));
+    if (pMyCursor->poSpatialCache == nullptr ||
+        pMyCursor->poSpatialCache->iGeomField != iGeomField)
+    {
+        OGR2SQLITE_RestoreSpatialFilter(pMyCursor);
+        OGR2SQLITE_BuildSpatialCache(pMyCursor, iGeomField,
+                                     !bFastSpatialFilter);
+    }
+    OGR2SQLITESpatialCache *poCache = pMyCursor->poSpatialCache;
+
+    if (bFastSpatialFilter)
+    {
+        if (!pMyCursor->bHasSetSpatialFilter)
+        {
+            pMyCursor->iPrevGeomFieldFilter = poLayer->GetGeomFieldFilter();
+            if (poLayer->GetSpatialFilter())
+                pMyCursor->poPrevSpatialFilter =
+                    poLayer->GetSpatialFilter()->clone();
+            pMyCursor->bHasSetSpatialFilter = true;
+        }
+        poLayer->SetSpatialFilterRect(iGeomField, sEnvelope.MinX,
+                                      sEnvelope.MinY, sEnvelope.MaxX,
+                                      sEnvelope.MaxY);
+        return false;
+    }
+
+    CPLRectObj sAoI;
+    sAoI.minx = sEnvelope.MinX;
+    sAoI.miny = sEnvelope.MinY;
+    sAoI.maxx = sEnvelope.MaxX;
+    sAoI.maxy = sEnvelope.MaxY;
+    int nItems = 0;
+    void **pahItems = CPLQuadTreeSearch(poCache->hTree, &sAoI, &nItems);
+    poCache->anCandidateFIDs.clear();
+    for (int i = 0; i < nItems; i++)
+    {
+        poCache->anCandidateFIDs.push_back(
+            static_cast<const OGR2SQLITESpatialCache::Item *>(pahItems[i])
+                ->nFID);
+    }
+    CPLFree(pahItems);
+    poCache->anCandidateFIDs.insert(poCache->anCandidateFIDs.end(),
+                                    poCache->anNullGeomFIDs.begin(),
+                                    poCache->anNullGeomFIDs.end());
+    // Fetch features in file order.
+    std::sort(poCache->anCandidateFIDs.begin(),
+              poCache->anCandidateFIDs.end());
+    poCache->iNextCandidate = 0;
+    poCache->bActive = true;
+
+    pMyCursor->poFeature = OGR2SQLITE_GetNextCandidate(pMyCursor);
+    return true;
+}
+
+#endif  // SQLITE_INDEX_CONSTRAINT_FUNCTION
+
 /************************************************************************/
 /*                          OGR2SQLITE_Filter()                         */
 /************************************************************************/
@@ -1138,7 +1609,16 @@ static int OGR2SQLITE_Filter(sqlite3_vtab_cursor *pCursor,
     if (nConstraints != argc)
         return SQLITE_ERROR;
 
+    delete pMyCursor->poFeature;
+    pMyCursor->poFeature = nullptr;
+    CPLFree(pMyCursor->pabyGeomBLOB);
+    pMyCursor->pabyGeomBLOB = nullptr;
+    pMyCursor->nGeomBLOBLen = -1;
+    if (pMyCursor->poSpatialCache)
+        pMyCursor->poSpatialCache->bActive = false;
+
     CPLString osAttributeFilter;
+    int iSpatialConstraint = -1;
 
     OGRFeatureDefn *poFDefn = pMyCursor->poLayer->GetLayerDefn();
 
@@ -1147,6 +1627,14 @@ static int OGR2SQLITE_Filter(sqlite3_vtab_cursor *pCursor,
         int nCol = panConstraints[2 * i + 1];
         OGRFieldDefn *poFieldDefn = nullptr;
 
+#ifdef SQLITE_INDEX_CONSTRAINT_FUNCTION
+        if (panConstraints[2 * i + 2] >= SQLITE_INDEX_CONSTRAINT_FUNCTION)
+        {
+            iSpatialConstraint = i;
+            continue;
+        }
+#endif
+
         if (pMyCursor->pVTab->bHasFIDColumn && nCol >= 0)
         {
             --nCol;
@@ -1159,7 +1647,7 @@ static int OGR2SQLITE_Filter(sqlite3_vtab_cursor *pCursor,
                 return SQLITE_ERROR;
         }
 
-        if (i != 0)
+        if (!osAttributeFilter.empty())
             osAttributeFilter += " AND ";
 
         if (poFieldDefn != nullptr)
@@ -1290,6 +1778,24 @@ static int OGR2SQLITE_Filter(sqlite3_vtab_cursor *pCursor,
     CPLDebug("OGR2SQLITE", "Attribute filter : %s", osAttributeFilter.c_str());
 #endif
 
+    pMyCursor->nNextWishedIndex = 0;
+    pMyCursor->nCurFeatureIndex = -1;
+
+#ifdef SQLITE_INDEX_CONSTRAINT_FUNCTION
+    if (iSpatialConstraint >= 0)
+    {
+        pMyCursor->nFeatureCount = -1;
+        if (OGR2SQLITE_ApplySpatialConstraint(
+                pMyCursor, panConstraints[2 * iSpatialConstraint + 1],
+                argv[iSpatialConstraint]))
+        {
+            return SQLITE_OK;
+        }
+    }
+#endif
+    if (iSpatialConstraint < 0)
+        OGR2SQLITE_RestoreSpatialFilter(pMyCursor);
+
     if (pMyCursor->poLayer->SetAttributeFilter(!osAttributeFilter.empty()
                                                    ? osAttributeFilter.c_str()
                                                    : nullptr) != OGRERR_NONE)
@@ -1300,7 +1806,8 @@ static int OGR2SQLITE_Filter(sqlite3_vtab_cursor *pCursor,
         return SQLITE_ERROR;
     }
 
-    if (pMyCursor->poLayer->TestCapability(OLCFastFeatureCount))
+    if (!pMyCursor->bHasSetSpatialFilter &&
+        pMyCursor->poLayer->TestCapability(OLCFastFeatureCount))
         pMyCursor->nFeatureCount = pMyCursor->poLayer->GetFeatureCount();
     else
         pMyCursor->nFeatureCount = -1;
@@ -1308,16 +1815,18 @@ static int OGR2SQLITE_Filter(sqlite3_vtab_cursor *pCursor,
 
     if (pMyCursor->nFeatureCount < 0)
     {
-        pMyCursor->poFeature = pMyCursor->poLayer->GetNextFeature();
+#ifdef SQLITE_INDEX_CONSTRAINT_FUNCTION
+        if (pMyCursor->bHasSetSpatialFilter)
+            pMyCursor->poFeature = OGR2SQLITE_GetNextFilteredFeature(pMyCursor);
+        else
+#endif
+            pMyCursor->poFeature = pMyCursor->poLayer->GetNextFeature();
 #ifdef DEBUG_OGR2SQLITE
         CPLDebug("OGR2SQLITE", "GetNextFeature() --> " CPL_FRMT_GIB,
                  pMyCursor->poFeature ? pMyCursor->poFeature->GetFID() : -1);
 #endif
     }
 
-    pMyCursor->nNextWishedIndex = 0;
-    pMyCursor->nCurFeatureIndex = -1;
-
     return SQLITE_OK;
 }
 
@@ -1336,7 +1845,15 @@ static int OGR2SQLITE_Next(sqlite3_vtab_cursor *pCursor)
     if (pMyCursor->nFeatureCount < 0)
     {
         delete pMyCursor->poFeature;
-        pMyCursor->poFeature = pMyCursor->poLayer->GetNextFeature();
+#ifdef SQLITE_INDEX_CONSTRAINT_FUNCTION
+        if (pMyCursor->bHasSetSpatialFilter)
+            pMyCursor->poFeature = OGR2SQLITE_GetNextFilteredFeature(pMyCursor);
+        else if (pMyCursor->poSpatialCache &&
+                 pMyCursor->poSpatialCache->bActive)
+            pMyCursor->poFeature = OGR2SQLITE_GetNextCandidate(pMyCursor);
+        else
+#endif
+            pMyCursor->poFeature = pMyCursor->poLayer->GetNextFeature();
 
         CPLFree(pMyCursor->pabyGeomBLOB);
         pMyCursor->pabyGeomBLOB = nullptr;
@@ -1673,20 +2190,42 @@ static int OGR2SQLITE_Rename(CPL_UNUSED sqlite3_vtab *pVtab,
     return SQLITE_ERROR;
 }
 
-#if 0
+#ifdef SQLITE_INDEX_CONSTRAINT_FUNCTION
 /************************************************************************/
 /*                        OGR2SQLITE_FindFunction()                     */
 /************************************************************************/
 
-static
-int OGR2SQLITE_FindFunction(sqlite3_vtab *pVtab,
-                            int nArg,
-                            const char *zName,
-                            void (**pxFunc)(sqlite3_context*,int,sqlite3_value**),
-                            void **ppArg)
+/* Overload spatial predicates whose first argument is a geometry column */
+/* of the virtual table, so that they are passed as constraints to */
+/* OGR2SQLITE_BestIndex(). */
+static int OGR2SQLITE_FindFunction(sqlite3_vtab *pVTab, int nArg,
+                                   const char *zName,
+                                   void (**pxFunc)(sqlite3_context *, int,
+                                                   sqlite3_value **),
+                                   void **ppArg)
 {
-    CPLDebug("OGR2SQLITE", "FindFunction %s", zName);
+    OGR2SQLITE_vtab *pMyVTab = (OGR2SQLITE_vtab *)pVTab;
+    if (nArg != 2 ||
+        pMyVTab->poLayer->GetLayerDefn()->GetGeomFieldCount() == 0)
+        return 0;
 
+    const char *pszName = STARTS_WITH_CI(zName, "ST_") ? zName + 3 : zName;
+    for (size_t i = 0; i < CPL_ARRAYSIZE(asSpatialPredicates); ++i)
+    {
+        const char *pszPredicateName = asSpatialPredicates[i].pszName;
+        if (EQUAL(zName, pszPredicateName) ||
+            (STARTS_WITH_CI(pszPredicateName, "ST_") &&
+             EQUAL(pszName, pszPredicateName + 3)))
+        {
+#ifdef DEBUG_OGR2SQLITE
+            CPLDebug("OGR2SQLITE", "FindFunction %s", zName);
+#endif
+            *pxFunc = OGR2SQLITE_EvaluateSpatialPredicate;
+            *ppArg = const_cast<OGR2SQLITESpatialPredicate *>(
+                &asSpatialPredicates[i]);
+            return SQLITE_INDEX_CONSTRAINT_FUNCTION + static_cast<int>(i);
+        }
+    }
     return 0;
 }
 #endif
@@ -1911,8 +2450,11 @@ static const struct sqlite3_module sOGR2SQLITEModule = {
     nullptr, /* xSync */
     nullptr, /* xCommit */
     nullptr, /* xFindFunctionRollback */
-    nullptr,
-    /* xFindFunction */  // OGR2SQLITE_FindFunction;
+#ifdef SQLITE_INDEX_CONSTRAINT_FUNCTION
+    OGR2SQLITE_FindFunction,
+#else
+    nullptr, /* xFindFunction */
+#endif
     OGR2SQLITE_Rename,
     nullptr,  // xSavepoint
     nullptr,  // xRelease
@@ -30,6 +30,9 @@
 #ifndef OGR_WFS_H_INCLUDED
 #define OGR_WFS_H_INCLUDED
 
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <vector>
 #include <set>
 #include <map>
@@ -38,6 +41,7 @@
 #include "ogrsf_frmts.h"
 #include "gmlreader.h"
 #include "cpl_http.h"
+#include "cpl_worker_thread_pool.h"
 #include "ogr_swq.h"
 
 const CPLXMLNode *WFSFindNode(const CPLXMLNode *psXML, const char *pszRootName);
@@ -73,6 +77,25 @@ class OGRWFSSortDesc
 
 class OGRWFSDataSource;
 
+/************************************************************************/
+/*                         OGRWFSPrefetchedPage                         */
+/************************************************************************/
+
+// GetFeature response of a page, downloaded by a worker thread when
+// MAX_CONNECTIONS > 1.
+struct OGRWFSPrefetchedPage
+{
+    CPLString osURL{};
+    CPLStringList aosHTTPOptions{};
+    CPLHTTPResult *psResult = nullptr;
+    std::atomic<bool> bDone{false};
+
+    OGRWFSPrefetchedPage() = default;
+    ~OGRWFSPrefetchedPage();
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRWFSPrefetchedPage)
+};
+
 class OGRWFSLayer final : public OGRLayer
 {
     OGRWFSDataSource *poDS;
@@ -136,6 +159,14 @@ class OGRWFSLayer final : public OGRLayer
     int nPagingStartIndex;
     int nFeatureRead;
 
+    std::unique_ptr<CPLWorkerThreadPool> m_poPrefetchPool{};
+    std::deque<std::unique_ptr<OGRWFSPrefetchedPage>> m_apoPrefetchedPages{};
+    bool m_bPrefetchDisabled = false;
+    static void FetchPageJob(void *pData);
+    CPLHTTPResult *GetPrefetchedPage(const CPLString &osURL);
+    void PrefetchPages(const CPLString &osURL);
+    void CancelPrefetching();
+
     OGRFeatureDefn *BuildLayerDefnFromFeatureClass(GMLFeatureClass *poClass);
 
     char *pszRequiredOutputFormat;
@@ -356,6 +387,7 @@ class OGRWFSDataSource final : public OGRDataSource
     bool bPagingAllowed;
     int nPageSize;
     int nBaseStartIndex;
+    int nMaxConnections = 1;
     bool DetectSupportPagingWFS2(const CPLXMLNode *psGetCapabilitiesResponse,
                                  const CPLXMLNode *psConfigurationRoot);
 
@@ -477,6 +509,7 @@ class OGRWFSDataSource final : public OGRDataSource
 
     void SaveLayerSchema(const char *pszLayerName, const CPLXMLNode *psSchema);
 
+    char **GetHTTPOptions(char **papszOptions) const;
     CPLHTTPResult *HTTPFetch(const char *pszURL, char **papszOptions);
 
     bool IsPagingAllowed() const
@@ -491,6 +524,10 @@ class OGRWFSDataSource final : public OGRDataSource
     {
         return nBaseStartIndex;
     }
+    int GetMaxConnections() const
+    {
+        return nMaxConnections;
+    }
 
     void LoadMultipleLayerDefn(const char *pszLayerName, char *pszNS,
                                char *pszNSVal);
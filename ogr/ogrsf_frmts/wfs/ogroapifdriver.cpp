@@ -30,10 +30,13 @@
 #include "cpl_conv.h"
 #include "cpl_minixml.h"
 #include "cpl_http.h"
+#include "cpl_worker_thread_pool.h"
 #include "ogr_swq.h"
 #include "parsexsd.h"
 
 #include <algorithm>
+#include <atomic>
+#include <deque>
 #include <memory>
 #include <vector>
 #include <set>
@@ -86,6 +89,7 @@ class OGROAPIFDataset final : public GDALDataset
     int m_nPageSize = 1000;
     int m_nInitialRequestPageSize = 20;
     bool m_bPageSizeSetFromOpenOptions = false;
+    int m_nMaxConnections = 1;
     std::vector<std::unique_ptr<OGRLayer>> m_apoLayers;
     std::string m_osAskedCRS{};
     OGRSpatialReference m_oAskedCRS{};
@@ -102,12 +106,14 @@ class OGROAPIFDataset final : public GDALDataset
 
     bool Download(const CPLString &osURL, const char *pszAccept,
                   CPLString &osResult, CPLString &osContentType,
-                  CPLStringList *paosHeaders = nullptr);
+                  CPLStringList *paosHeaders = nullptr,
+                  bool bUsePersistentConnection = true);
 
     bool DownloadJSon(const CPLString &osURL, CPLJSONDocument &oDoc,
                       const char *pszAccept = MEDIA_TYPE_GEOJSON
                       ", " MEDIA_TYPE_JSON,
-                      CPLStringList *paosHeaders = nullptr);
+                      CPLStringList *paosHeaders = nullptr,
+                      bool bUsePersistentConnection = true);
 
     bool LoadJSONCollection(const CPLJSONObject &oCollection,
                             const CPLJSONArray &oGlobalCRSList);
@@ -136,6 +142,24 @@ class OGROAPIFDataset final : public GDALDataset
     CPLString ReinjectAuthInURL(const CPLString &osURL) const;
 };
 
+/************************************************************************/
+/*                            OGROAPIFPage                              */
+/************************************************************************/
+
+// A page of the /items response, downloaded and parsed either synchronously
+// or by a worker thread when prefetching is enabled.
+struct OGROAPIFPage
+{
+    OGROAPIFDataset *poDS = nullptr;
+    CPLString osURL{};
+    bool bAsync = false;
+    CPLJSONDocument oDoc{};
+    CPLStringList aosHeaders{};
+    std::unique_ptr<GDALDataset> poUnderlyingDS{};
+    bool bOK = false;
+    std::atomic<bool> bDone{false};
+};
+
 /************************************************************************/
 /*                            OGROAPIFLayer                              */
 /************************************************************************/
@@ -181,6 +205,21 @@ class OGROAPIFLayer final : public OGRLayer
     CPLJSONDocument m_oCurDoc{};
     int m_iFeatureInPage = 0;
 
+    // Page prefetching, when MAX_CONNECTIONS > 1 and the next links only
+    // differ by an offset
+    std::unique_ptr<CPLWorkerThreadPool> m_poPrefetchPool{};
+    std::deque<std::unique_ptr<OGROAPIFPage>> m_apoPrefetchedPages{};
+    CPLString m_osPagingKey{};
+    GIntBig m_nPagingStep = 0;
+    CPLString m_osPredictedNextURL{};
+    bool m_bPagingPredictable = false;
+
+    static void FetchPage(OGROAPIFPage *psPage);
+    static void FetchPageJob(void *pData);
+    std::unique_ptr<OGROAPIFPage> GetPage(const CPLString &osURL);
+    void PrefetchPages(const CPLString &osPageURL, GIntBig nNumberMatched);
+    void CancelPrefetching();
+
     void EstablishFeatureDefn();
     OGRFeature *GetNextRawFeature();
     CPLString AddFilters(const CPLString &osURL);
@@ -323,7 +362,8 @@ CPLString OGROAPIFDataset::ReinjectAuthInURL(const CPLString &osURL) const
 
 bool OGROAPIFDataset::Download(const CPLString &osURL, const char *pszAccept,
                                CPLString &osResult, CPLString &osContentType,
-                               CPLStringList *paosHeaders)
+                               CPLStringList *paosHeaders,
+                               bool bUsePersistentConnection)
 {
 #ifndef REMOVE_HACK
     VSIStatBufL sStatBuf;
@@ -353,9 +393,14 @@ bool OGROAPIFDataset::Download(const CPLString &osURL, const char *pszAccept,
         papszOptions =
             CSLSetNameValue(papszOptions, "USERPWD", m_osUserPwd.c_str());
     }
-    m_bMustCleanPersistent = true;
-    papszOptions =
-        CSLAddString(papszOptions, CPLSPrintf("PERSISTENT=OAPIF:%p", this));
+    // Persistent connections are bound to the calling thread, and cannot
+    // be used by page prefetching jobs.
+    if (bUsePersistentConnection)
+    {
+        m_bMustCleanPersistent = true;
+        papszOptions = CSLAddString(papszOptions,
+                                    CPLSPrintf("PERSISTENT=OAPIF:%p", this));
+    }
     CPLString osURLWithQueryParameters(osURL);
     if (!m_osUserQueryParams.empty() &&
         osURL.find('?' + m_osUserQueryParams) == std::string::npos &&
@@ -487,11 +532,13 @@ bool OGROAPIFDataset::Download(const CPLString &osURL, const char *pszAccept,
 
 bool OGROAPIFDataset::DownloadJSon(const CPLString &osURL,
                                    CPLJSONDocument &oDoc, const char *pszAccept,
-                                   CPLStringList *paosHeaders)
+                                   CPLStringList *paosHeaders,
+                                   bool bUsePersistentConnection)
 {
     CPLString osResult;
     CPLString osContentType;
-    if (!Download(osURL, pszAccept, osResult, osContentType, paosHeaders))
+    if (!Download(osURL, pszAccept, osResult, osContentType, paosHeaders,
+                  bUsePersistentConnection))
         return false;
     return oDoc.LoadMemory(osResult);
 }
@@ -1097,6 +1144,10 @@ bool OGROAPIFDataset::Open(GDALOpenInfo *poOpenInfo)
         m_nInitialRequestPageSize = initialRequestPageSize;
     }
 
+    m_nMaxConnections = std::max(
+        1, atoi(CSLFetchNameValueDef(poOpenInfo->papszOpenOptions,
+                                     "MAX_CONNECTIONS", "1")));
+
     m_osUserPwd =
         CSLFetchNameValueDef(poOpenInfo->papszOpenOptions, "USERPWD", "");
     std::string osCRS =
@@ -1366,6 +1417,7 @@ OGROAPIFLayer::OGROAPIFLayer(OGROAPIFDataset *poDS, const CPLString &osName,
 
 OGROAPIFLayer::~OGROAPIFLayer()
 {
+    CancelPrefetching();
     m_poFeatureDefn->Release();
 }
 
@@ -1915,6 +1967,11 @@ void OGROAPIFLayer::ResetReading()
     }
     m_oCurDoc = CPLJSONDocument();
     m_iFeatureInPage = 0;
+    CancelPrefetching();
+    m_osPagingKey.clear();
+    m_nPagingStep = 0;
+    m_osPredictedNextURL.clear();
+    m_bPagingPredictable = false;
 }
 
 /************************************************************************/
@@ -1972,6 +2029,192 @@ CPLString OGROAPIFLayer::AddFilters(const CPLString &osURL)
     return osURLNew;
 }
 
+/************************************************************************/
+/*                             FetchPage()                              */
+/************************************************************************/
+
+// Download a page and open it with the GeoJSON driver. May be run from a
+// worker thread.
+void OGROAPIFLayer::FetchPage(OGROAPIFPage *psPage)
+{
+    psPage->bOK = false;
+    if (!psPage->poDS->DownloadJSon(psPage->osURL, psPage->oDoc,
+                                    MEDIA_TYPE_GEOJSON ", " MEDIA_TYPE_JSON,
+                                    &psPage->aosHeaders, !psPage->bAsync))
+    {
+        return;
+    }
+
+    CPLString osTmpFilename(CPLSPrintf("/vsimem/oapif_%p.json", psPage));
+    psPage->oDoc.Save(osTmpFilename);
+    psPage->poUnderlyingDS.reset(GDALDataset::FromHandle(
+        GDALOpenEx(osTmpFilename, GDAL_OF_VECTOR | GDAL_OF_INTERNAL, nullptr,
+                   nullptr, nullptr)));
+    VSIUnlink(osTmpFilename);
+    if (!psPage->poUnderlyingDS)
+        return;
+    OGRLayer *poLayer = psPage->poUnderlyingDS->GetLayer(0);
+    if (!poLayer)
+    {
+        psPage->poUnderlyingDS.reset();
+        return;
+    }
+    // Make sure the page is fully ingested by the worker
+    poLayer->GetFeatureCount();
+    psPage->bOK = true;
+}
+
+/************************************************************************/
+/*                            FetchPageJob()                            */
+/************************************************************************/
+
+void OGROAPIFLayer::FetchPageJob(void *pData)
+{
+    OGROAPIFPage *psPage = static_cast<OGROAPIFPage *>(pData);
+    // Errors are not reported from workers: a failed page is downloaded
+    // again by the main thread, which then emits the error.
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    FetchPage(psPage);
+    CPLPopErrorHandler();
+    psPage->bDone = true;
+}
+
+/************************************************************************/
+/*                               GetPage()                              */
+/************************************************************************/
+
+std::unique_ptr<OGROAPIFPage> OGROAPIFLayer::GetPage(const CPLString &osURL)
+{
+    if (!m_apoPrefetchedPages.empty())
+    {
+        if (m_apoPrefetchedPages.front()->osURL == osURL)
+        {
+            auto poPage = std::move(m_apoPrefetchedPages.front());
+            m_apoPrefetchedPages.pop_front();
+            while (!poPage->bDone)
+                m_poPrefetchPool->WaitEvent();
+            if (poPage->bOK)
+                return poPage;
+            CPLDebug("OAPIF", "Prefetching of %s failed. Retrying",
+                     osURL.c_str());
+        }
+        else
+        {
+            // The server did not return the link we predicted
+            CancelPrefetching();
+            m_bPagingPredictable = false;
+            m_osPredictedNextURL.clear();
+        }
+    }
+
+    auto poPage = std::make_unique<OGROAPIFPage>();
+    poPage->poDS = m_poDS;
+    poPage->osURL = osURL;
+    FetchPage(poPage.get());
+    return poPage;
+}
+
+/************************************************************************/
+/*                           PrefetchPages()                            */
+/************************************************************************/
+
+// Called once the next link (m_osGetURL) of the page at osPageURL is known.
+// When the next links only differ by a constant increment of an offset
+// parameter, the following pages are downloaded and parsed by up to
+// MAX_CONNECTIONS worker threads, and delivered in order by GetPage().
+void OGROAPIFLayer::PrefetchPages(const CPLString &osPageURL,
+                                  GIntBig nNumberMatched)
+{
+    if (m_poDS->m_nMaxConnections <= 1)
+        return;
+
+    if (m_osGetURL.empty())
+    {
+        CancelPrefetching();
+        return;
+    }
+
+    if (!m_bPagingPredictable)
+    {
+        // Confirm that the next link is the one we predicted from the
+        // previous page, before issuing any speculative request.
+        m_bPagingPredictable = !m_osPredictedNextURL.empty() &&
+                               m_osGetURL == m_osPredictedNextURL;
+        if (!m_bPagingPredictable)
+        {
+            m_osPredictedNextURL.clear();
+            for (const char *pszKey : {"offset", "startIndex", "start"})
+            {
+                const CPLString osNextVal(CPLURLGetValue(m_osGetURL, pszKey));
+                if (osNextVal.empty() ||
+                    CPLGetValueType(osNextVal) != CPL_VALUE_INTEGER)
+                    continue;
+                const GIntBig nNext = CPLAtoGIntBig(osNextVal);
+                const CPLString osCurVal(CPLURLGetValue(osPageURL, pszKey));
+                const GIntBig nCur =
+                    osCurVal.empty() ? 0 : CPLAtoGIntBig(osCurVal);
+                if (nNext > nCur)
+                {
+                    m_osPagingKey = pszKey;
+                    m_nPagingStep = nNext - nCur;
+                    m_osPredictedNextURL = CPLURLAddKVP(
+                        m_osGetURL, pszKey,
+                        CPLSPrintf(CPL_FRMT_GIB, nNext + m_nPagingStep));
+                }
+                break;
+            }
+            return;
+        }
+        CPLDebug("OAPIF", "Prefetching pages with up to %d connections",
+                 m_poDS->m_nMaxConnections);
+    }
+
+    if (!m_poPrefetchPool)
+    {
+        m_poPrefetchPool = std::make_unique<CPLWorkerThreadPool>();
+        if (!m_poPrefetchPool->Setup(m_poDS->m_nMaxConnections, nullptr,
+                                     nullptr))
+        {
+            m_poPrefetchPool.reset();
+            m_poDS->m_nMaxConnections = 1;
+            return;
+        }
+    }
+
+    GIntBig nOffset = CPLAtoGIntBig(CPLURLGetValue(m_osGetURL, m_osPagingKey));
+    if (!m_apoPrefetchedPages.empty())
+    {
+        nOffset = CPLAtoGIntBig(CPLURLGetValue(
+            m_apoPrefetchedPages.back()->osURL, m_osPagingKey));
+        nOffset += m_nPagingStep;
+    }
+    while (static_cast<int>(m_apoPrefetchedPages.size()) <
+               m_poDS->m_nMaxConnections &&
+           (nNumberMatched < 0 || nOffset < nNumberMatched))
+    {
+        auto poPage = std::make_unique<OGROAPIFPage>();
+        poPage->poDS = m_poDS;
+        poPage->osURL = CPLURLAddKVP(m_osGetURL, m_osPagingKey,
+                                     CPLSPrintf(CPL_FRMT_GIB, nOffset));
+        poPage->bAsync = true;
+        if (!m_poPrefetchPool->SubmitJob(FetchPageJob, poPage.get()))
+            break;
+        m_apoPrefetchedPages.push_back(std::move(poPage));
+        nOffset += m_nPagingStep;
+    }
+}
+
+/************************************************************************/
+/*                         CancelPrefetching()                          */
+/************************************************************************/
+
+void OGROAPIFLayer::CancelPrefetching()
+{
+    if (m_poPrefetchPool)
+        m_poPrefetchPool->WaitCompletion();
+    m_apoPrefetchedPages.clear();
+}
+
 /************************************************************************/
 /*                         GetNextRawFeature()                          */
 /************************************************************************/
@@ -1993,13 +2236,14 @@ OGRFeature *OGROAPIFLayer::GetNextRawFeature()
 
             CPLString osURL(m_osGetURL);
             m_osGetURL.clear();
-            CPLStringList aosHeaders;
-            if (!m_poDS->DownloadJSon(osURL, m_oCurDoc,
-                                      MEDIA_TYPE_GEOJSON ", " MEDIA_TYPE_JSON,
-                                      &aosHeaders))
+            auto poPage = GetPage(osURL);
+            if (!poPage->bOK)
             {
+                CancelPrefetching();
                 return nullptr;
             }
+            m_oCurDoc = std::move(poPage->oDoc);
+            const CPLStringList aosHeaders(std::move(poPage->aosHeaders));
 
             const std::string osContentCRS =
                 aosHeaders.FetchNameValueDef("Content-Crs", "");
@@ -2057,23 +2301,8 @@ OGRFeature *OGROAPIFLayer::GetNextRawFeature()
                 }
             }
 
-            CPLString osTmpFilename(CPLSPrintf("/vsimem/oapif_%p.json", this));
-            m_oCurDoc.Save(osTmpFilename);
-            m_poUnderlyingDS =
-                std::unique_ptr<GDALDataset>(GDALDataset::FromHandle(
-                    GDALOpenEx(osTmpFilename, GDAL_OF_VECTOR | GDAL_OF_INTERNAL,
-                               nullptr, nullptr, nullptr)));
-            VSIUnlink(osTmpFilename);
-            if (!m_poUnderlyingDS.get())
-            {
-                return nullptr;
-            }
+            m_poUnderlyingDS = std::move(poPage->poUnderlyingDS);
             m_poUnderlyingLayer = m_poUnderlyingDS->GetLayer(0);
-            if (!m_poUnderlyingLayer)
-            {
-                m_poUnderlyingDS.reset();
-                return nullptr;
-            }
 
             // To avoid issues with implementations having a non-relevant
             // next link, make sure the current page is not empty
@@ -2149,6 +2378,20 @@ OGRFeature *OGROAPIFLayer::GetNextRawFeature()
                 {
                     m_osGetURL = m_poDS->ReinjectAuthInURL(m_osGetURL);
                 }
+
+                const auto oNumberMatched =
+                    m_oCurDoc.GetRoot().GetObj("numberMatched");
+                PrefetchPages(
+                    osURL, oNumberMatched.GetType() ==
+                                   CPLJSONObject::Type::Integer ||
+                               oNumberMatched.GetType() ==
+                                   CPLJSONObject::Type::Long
+                               ? oNumberMatched.ToLong()
+                               : -1);
+            }
+            else
+            {
+                CancelPrefetching();
             }
         }
 
@@ -3169,6 +3412,9 @@ void RegisterOGROAPIF()
         "  <Option name='INITIAL_REQUEST_PAGE_SIZE' type='int' "
         "description='Maximum number of features to retrieve in the initial "
         "request issued to determine the schema from a feature sample'/>"
+        "  <Option name='MAX_CONNECTIONS' type='int' "
+        "description='Maximum number of concurrent connections used to "
+        "prefetch pages of features' default='1'/>"
         "  <Option name='USERPWD' type='string' "
         "description='Basic authentication as username:password'/>"
         "  <Option name='IGNORE_SCHEMA' type='boolean' "
@@ -913,6 +913,10 @@ int OGRWFSDataSource::Open(const char *pszFilename, int bUpdateIn,
     const char *pszBaseURL = nullptr;
 
     bEmptyAsNull = CPLFetchBool(papszOpenOptionsIn, "EMPTY_AS_NULL", true);
+    nMaxConnections = std::max(
+        1, atoi(CSLFetchNameValueDef(
+               papszOpenOptionsIn, "MAX_CONNECTIONS",
+               CPLGetConfigOption("OGR_WFS_MAX_CONNECTIONS", "1"))));
 
     const CPLXMLNode *psConfigurationRoot = nullptr;
 
@@ -2164,11 +2168,11 @@ CPLString WFS_DecodeURL(const CPLString &osSrc)
 }
 
 /************************************************************************/
-/*                            HTTPFetch()                               */
+/*                           GetHTTPOptions()                           */
 /************************************************************************/
 
-CPLHTTPResult *OGRWFSDataSource::HTTPFetch(const char *pszURL,
-                                           char **papszOptions)
+// Return a new list with papszOptions and the options set on the data source
+char **OGRWFSDataSource::GetHTTPOptions(char **papszOptions) const
 {
     char **papszNewOptions = CSLDuplicate(papszOptions);
     if (bUseHttp10)
@@ -2176,6 +2180,17 @@ CPLHTTPResult *OGRWFSDataSource::HTTPFetch(const char *pszURL,
             CSLAddNameValue(papszNewOptions, "HTTP_VERSION", "1.0");
     if (papszHttpOptions)
         papszNewOptions = CSLMerge(papszNewOptions, papszHttpOptions);
+    return papszNewOptions;
+}
+
+/************************************************************************/
+/*                            HTTPFetch()                               */
+/************************************************************************/
+
+CPLHTTPResult *OGRWFSDataSource::HTTPFetch(const char *pszURL,
+                                           char **papszOptions)
+{
+    char **papszNewOptions = GetHTTPOptions(papszOptions);
     CPLHTTPResult *psResult = CPLHTTPFetch(pszURL, papszNewOptions);
     CSLDestroy(papszNewOptions);
 
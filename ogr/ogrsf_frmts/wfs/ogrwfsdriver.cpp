@@ -124,6 +124,9 @@ void RegisterOGRWFS()
         "  </Option>"
         "  <Option name='EXPOSE_GML_ID' type='boolean' description='Whether to "
         "make feature gml:id as a gml_id attribute.' default='YES'/>"
+        "  <Option name='MAX_CONNECTIONS' type='int' description='Maximum "
+        "number of concurrent connections used to prefetch pages when paging "
+        "is active' default='1'/>"
         "</OpenOptionList>");
 
     poDriver->SetMetadataItem(GDAL_DCAP_VIRTUALIO, "YES");
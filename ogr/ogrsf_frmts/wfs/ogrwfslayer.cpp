@@ -129,6 +129,8 @@ OGRWFSLayer *OGRWFSLayer::Clone()
 OGRWFSLayer::~OGRWFSLayer()
 
 {
+    CancelPrefetching();
+
     if (bInTransaction)
         OGRWFSLayer::CommitTransaction();
 
@@ -749,6 +751,122 @@ bool OGRWFSLayer::MustRetryIfNonCompliantServer(const char *pszServerAnswer)
     return bRetry;
 }
 
+/************************************************************************/
+/*                       ~OGRWFSPrefetchedPage()                        */
+/************************************************************************/
+
+OGRWFSPrefetchedPage::~OGRWFSPrefetchedPage()
+{
+    CPLHTTPDestroyResult(psResult);
+}
+
+/************************************************************************/
+/*                            FetchPageJob()                            */
+/************************************************************************/
+
+void OGRWFSLayer::FetchPageJob(void *pData)
+{
+    OGRWFSPrefetchedPage *psPage = static_cast<OGRWFSPrefetchedPage *>(pData);
+    // Errors are not reported from workers: a failed page is downloaded
+    // again by the main thread, which then emits the error.
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    psPage->psResult =
+        CPLHTTPFetch(psPage->osURL, psPage->aosHTTPOptions.List());
+    CPLPopErrorHandler();
+    psPage->bDone = true;
+}
+
+/************************************************************************/
+/*                         GetPrefetchedPage()                          */
+/************************************************************************/
+
+// Return the prefetched response for osURL (to be freed with
+// CPLHTTPDestroyResult()), or nullptr if it must be downloaded.
+CPLHTTPResult *OGRWFSLayer::GetPrefetchedPage(const CPLString &osURL)
+{
+    if (m_apoPrefetchedPages.empty())
+        return nullptr;
+
+    if (m_apoPrefetchedPages.front()->osURL != osURL)
+    {
+        // Pages do not have the size we expected: go on sequentially
+        CPLDebug("WFS", "Unexpected page start index. Disabling prefetching");
+        CancelPrefetching();
+        m_bPrefetchDisabled = true;
+        return nullptr;
+    }
+
+    auto poPage = std::move(m_apoPrefetchedPages.front());
+    m_apoPrefetchedPages.pop_front();
+    while (!poPage->bDone)
+        m_poPrefetchPool->WaitEvent();
+
+    CPLHTTPResult *psResult = poPage->psResult;
+    if (psResult == nullptr || psResult->nStatus != 0 ||
+        psResult->pszErrBuf != nullptr || psResult->pabyData == nullptr)
+    {
+        return nullptr;
+    }
+    poPage->psResult = nullptr;
+    return psResult;
+}
+
+/************************************************************************/
+/*                           PrefetchPages()                            */
+/************************************************************************/
+
+// Submit the download of the pages following the one of osURL, so that up
+// to MAX_CONNECTIONS requests are in flight.
+void OGRWFSLayer::PrefetchPages(const CPLString &osURL)
+{
+    if (!m_poPrefetchPool)
+    {
+        m_poPrefetchPool = std::make_unique<CPLWorkerThreadPool>();
+        if (!m_poPrefetchPool->Setup(poDS->GetMaxConnections(), nullptr,
+                                     nullptr))
+        {
+            m_poPrefetchPool.reset();
+            m_bPrefetchDisabled = true;
+            return;
+        }
+        CPLDebug("WFS", "Prefetching pages with up to %d connections",
+                 poDS->GetMaxConnections());
+    }
+
+    const int nPageSize = poDS->GetPageSize();
+    GIntBig nStartIndex =
+        (m_apoPrefetchedPages.empty()
+             ? CPLAtoGIntBig(CPLURLGetValue(osURL, "STARTINDEX"))
+             : CPLAtoGIntBig(CPLURLGetValue(m_apoPrefetchedPages.back()->osURL,
+                                            "STARTINDEX"))) +
+        nPageSize;
+    while (static_cast<int>(m_apoPrefetchedPages.size()) <
+               poDS->GetMaxConnections() &&
+           (m_nNumberMatched < 0 ||
+            nStartIndex - poDS->GetBaseStartIndex() < m_nNumberMatched))
+    {
+        auto poPage = std::make_unique<OGRWFSPrefetchedPage>();
+        poPage->osURL = CPLURLAddKVP(osURL, "STARTINDEX",
+                                     CPLSPrintf(CPL_FRMT_GIB, nStartIndex));
+        poPage->aosHTTPOptions.Assign(poDS->GetHTTPOptions(nullptr), true);
+        if (!m_poPrefetchPool->SubmitJob(FetchPageJob, poPage.get()))
+            break;
+        m_apoPrefetchedPages.push_back(std::move(poPage));
+        nStartIndex += nPageSize;
+    }
+}
+
+/************************************************************************/
+/*                         CancelPrefetching()                          */
+/************************************************************************/
+
+void OGRWFSLayer::CancelPrefetching()
+{
+    if (m_poPrefetchPool)
+        m_poPrefetchPool->WaitCompletion();
+    m_apoPrefetchedPages.clear();
+}
+
 /************************************************************************/
 /*                         FetchGetFeature()                            */
 /************************************************************************/
@@ -759,6 +877,14 @@ GDALDataset *OGRWFSLayer::FetchGetFeature(int nRequestMaxFeatures)
     CPLString osURL = MakeGetFeatureURL(nRequestMaxFeatures, FALSE);
     CPLDebug("WFS", "%s", osURL.c_str());
 
+    // When paging is active, the next pages may be downloaded concurrently
+    // by worker threads. The responses are then ingested in memory, hence
+    // streaming is not used in that mode.
+    const bool bPrefetch =
+        nRequestMaxFeatures == 0 && !m_bPrefetchDisabled &&
+        poDS->GetMaxConnections() > 1 &&
+        !CPLURLGetValue(osURL, "STARTINDEX").empty();
+
     CPLHTTPResult *psResult = nullptr;
 
     CPLString osOutputFormat = CPLURLGetValue(osURL, "OUTPUTFORMAT");
@@ -783,7 +909,8 @@ GDALDataset *OGRWFSLayer::FetchGetFeature(int nRequestMaxFeatures)
         }
     };
 
-    if (CPLTestBool(CPLGetConfigOption("OGR_WFS_USE_STREAMING", "YES")))
+    if (!bPrefetch &&
+        CPLTestBool(CPLGetConfigOption("OGR_WFS_USE_STREAMING", "YES")))
     {
         CPLString osStreamingName;
         if (STARTS_WITH(osURL, "/vsimem/") &&
@@ -909,7 +1036,10 @@ GDALDataset *OGRWFSLayer::FetchGetFeature(int nRequestMaxFeatures)
     }
 
     bStreamingDS = false;
-    psResult = poDS->HTTPFetch(osURL, nullptr);
+    if (bPrefetch)
+        psResult = GetPrefetchedPage(osURL);
+    if (psResult == nullptr)
+        psResult = poDS->HTTPFetch(osURL, nullptr);
     if (psResult == nullptr)
     {
         return nullptr;
@@ -1030,6 +1160,9 @@ GDALDataset *OGRWFSLayer::FetchGetFeature(int nRequestMaxFeatures)
     if (m_nNumberMatched < 0)
         ReadNumberMatched(pszData);
 
+    if (bPrefetch)
+        PrefetchPages(osURL);
+
     CPLString osTmpFileName;
 
     if (!bIsMultiPart)
@@ -1266,6 +1399,8 @@ void OGRWFSLayer::ResetReading()
     nPagingStartIndex = 0;
     nFeatureRead = 0;
     m_nNumberMatched = -1;
+    CancelPrefetching();
+    m_bPrefetchDisabled = false;
     m_bHasReadAtLeastOneFeatureInThisPage = false;
     if (bReloadNeeded)
     {
@@ -107,6 +107,13 @@ class OGRXLSXLayer final : public OGRMemLayer
 
     /* For external usage. Mess with FID */
     virtual OGRFeature *GetNextFeature() override;
+    int GetNextFeatureBatch(int nColumns, OGRFeatureBatchColumn *pasColumns,
+                            int nMaxFeatures) override
+    {
+        // Features are post-processed by GetNextFeature()
+        return OGRLayer::GetNextFeatureBatch(nColumns, pasColumns,
+                                             nMaxFeatures);
+    }
     virtual OGRFeature *GetFeature(GIntBig nFeatureId) override;
     virtual OGRErr ISetFeature(OGRFeature *poFeature) override;
     virtual OGRErr DeleteFeature(GIntBig nFID) override;
@@ -48,6 +48,7 @@
 #include "cpl_error_internal.h"
 #include "cpl_http.h"
 #include "cpl_json.h"
+#include "cpl_mem_cache.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
@@ -10198,6 +10199,74 @@ OGRErr OGRSpatialReference::SetExtension(const char *pszTargetKey,
     return OGRERR_NONE;
 }
 
+/************************************************************************/
+/*                        Shared cache of SRS                           */
+/************************************************************************/
+
+// Process-wide cache of fully built SRS, indexed by keys computed by drivers
+// from the content the SRS is derived from (GeoTIFF keys, WKT, etc.)
+static std::mutex g_oSharedSRSCacheMutex;
+static lru11::Cache<std::string, std::unique_ptr<OGRSpatialReference>>
+    *g_poSharedSRSCache = nullptr;
+
+/*! @cond Doxygen_Suppress */
+
+/** Return a copy of the SRS stored in the process-wide cache for osKey,
+ * or nullptr.
+ *
+ * This is meant for drivers that repeatedly build the same SRS when opening
+ * many datasets, which involves costly lookups in the PROJ database.
+ * The key must capture everything the SRS is built from, including the
+ * configuration options that affect the result.
+ */
+std::unique_ptr<OGRSpatialReference>
+OSRGetFromSharedCache(const std::string &osKey)
+{
+    std::lock_guard<std::mutex> oLock(g_oSharedSRSCacheMutex);
+    if (g_poSharedSRSCache)
+    {
+        const auto ppoSRS = g_poSharedSRSCache->getPtr(osKey);
+        if (ppoSRS)
+        {
+            // OGRSpatialReference is not thread-safe, hence the copy under
+            // the lock
+            return std::unique_ptr<OGRSpatialReference>((*ppoSRS)->Clone());
+        }
+    }
+    return nullptr;
+}
+
+/** Store a copy of oSRS in the process-wide cache, associated with osKey.
+ *
+ * @see OSRGetFromSharedCache()
+ */
+void OSRInsertIntoSharedCache(const std::string &osKey,
+                              const OGRSpatialReference &oSRS)
+{
+    auto poSRS = std::unique_ptr<OGRSpatialReference>(oSRS.Clone());
+    std::lock_guard<std::mutex> oLock(g_oSharedSRSCacheMutex);
+    if (g_poSharedSRSCache == nullptr)
+    {
+        g_poSharedSRSCache =
+            new lru11::Cache<std::string,
+                             std::unique_ptr<OGRSpatialReference>>(256);
+    }
+    g_poSharedSRSCache->insert(osKey, std::move(poSRS));
+}
+
+/*! @endcond */
+
+/************************************************************************/
+/*                        CleanupSharedSRSCache()                       */
+/************************************************************************/
+
+static void CleanupSharedSRSCache()
+{
+    std::lock_guard<std::mutex> oLock(g_oSharedSRSCacheMutex);
+    delete g_poSharedSRSCache;
+    g_poSharedSRSCache = nullptr;
+}
+
 /************************************************************************/
 /*                             OSRCleanup()                             */
 /************************************************************************/
@@ -10221,6 +10290,7 @@ void OSRCleanup(void)
     OGRCTDumpStatistics();
     CSVDeaccess(nullptr);
     CleanupSRSWGS84Mutex();
+    CleanupSharedSRSCache();
     OSRCTCleanCache();
     OSRCleanupTLSContext();
 }
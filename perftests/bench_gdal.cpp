@@ -0,0 +1,1040 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Utilities
+ * Purpose:  End-to-end raster and vector benchmark suite
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "bench_harness.h"
+
+#include "cpl_vsi.h"
+#include "gdal_alg.h"
+#include "gdalwarper.h"
+#include "ogr_api.h"
+#include "ogr_recordbatch.h"
+#include "ogrsf_frmts.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+static BenchHarness goHarness;
+
+/************************************************************************/
+/*                           ReadWholeDataset()                         */
+/************************************************************************/
+
+static bool ReadWholeDataset(GDALDataset *poDS, std::vector<GByte> &abyBuffer)
+{
+    const int nXSize = poDS->GetRasterXSize();
+    const int nYSize = poDS->GetRasterYSize();
+    const int nBands = poDS->GetRasterCount();
+    const GDALDataType eDT = poDS->GetRasterBand(1)->GetRasterDataType();
+    abyBuffer.resize(static_cast<size_t>(nXSize) * nYSize * nBands *
+                     GDALGetDataTypeSizeBytes(eDT));
+    return poDS->RasterIO(GF_Read, 0, 0, nXSize, nYSize, abyBuffer.data(),
+                          nXSize, nYSize, eDT, nBands, nullptr, 0, 0, 0,
+                          nullptr) == CE_None;
+}
+
+/************************************************************************/
+/*                          RegisterCopyWords()                         */
+/************************************************************************/
+
+static void RegisterCopyWords()
+{
+    constexpr int VALUE_COUNT = 1024 * 1024;
+    const std::pair<GDALDataType, GDALDataType> aPairs[] = {
+        {GDT_Byte, GDT_Byte},      {GDT_Byte, GDT_Float32},
+        {GDT_UInt16, GDT_Float64}, {GDT_Int16, GDT_Float32},
+        {GDT_Float32, GDT_Byte},   {GDT_Float64, GDT_Int16},
+        {GDT_Float32, GDT_UInt16},
+    };
+    for (const auto &oPair : aPairs)
+    {
+        const GDALDataType eSrcDT = oPair.first;
+        const GDALDataType eDstDT = oPair.second;
+        const int nSrcSize = GDALGetDataTypeSizeBytes(eSrcDT);
+        const int nDstSize = GDALGetDataTypeSizeBytes(eDstDT);
+        auto pSrc = std::make_shared<std::vector<GByte>>(
+            static_cast<size_t>(VALUE_COUNT) * nSrcSize);
+        auto pDst = std::make_shared<std::vector<GByte>>(
+            static_cast<size_t>(VALUE_COUNT) * nDstSize);
+        // Packed and pixel-interleaved (stride of 3 words) destinations
+        for (int nDstStride : {1, 3})
+        {
+            BenchHarness::Benchmark oBench;
+            oBench.osName = CPLSPrintf(
+                "copywords/%s_to_%s%s", GDALGetDataTypeName(eSrcDT),
+                GDALGetDataTypeName(eDstDT),
+                nDstStride == 1 ? "" : "_strided");
+            oBench.setup = [pSrc, pDst, eSrcDT, nDstStride, nDstSize]()
+            {
+                std::mt19937 oGen(42);
+                std::uniform_real_distribution<double> oDist(0, 250);
+                std::vector<double> adfVals(VALUE_COUNT);
+                for (double &dfVal : adfVals)
+                    dfVal = oDist(oGen);
+                GDALCopyWords64(adfVals.data(), GDT_Float64, sizeof(double),
+                                pSrc->data(), eSrcDT,
+                                GDALGetDataTypeSizeBytes(eSrcDT), VALUE_COUNT);
+                pDst->resize(static_cast<size_t>(VALUE_COUNT) * nDstSize *
+                             nDstStride);
+            };
+            oBench.run = [pSrc, pDst, eSrcDT, eDstDT, nSrcSize, nDstSize,
+                          nDstStride]()
+            {
+                GDALCopyWords64(pSrc->data(), eSrcDT, nSrcSize, pDst->data(),
+                                eDstDT, nDstSize * nDstStride, VALUE_COUNT);
+            };
+            oBench.dfBytesPerRun =
+                static_cast<double>(VALUE_COUNT) * (nSrcSize + nDstSize);
+            goHarness.Add(std::move(oBench));
+        }
+    }
+}
+
+/************************************************************************/
+/*                          RegisterBlockCache()                        */
+/************************************************************************/
+
+static void RegisterBlockCache()
+{
+    constexpr int SIZE = 4096;
+    constexpr int WINDOW = 256;
+    constexpr int WINDOW_COUNT = 1000;
+    const char *pszFilename = "/vsimem/bench_blockcache.tif";
+
+    struct State
+    {
+        std::unique_ptr<GDALDataset> poDS{};
+        std::vector<GByte> abyBuffer{};
+        GIntBig nOldCacheMax = 0;
+    };
+
+    auto psState = std::make_shared<State>();
+    const auto Setup = [psState, pszFilename]()
+    {
+        auto poDrv = GetGDALDriverManager()->GetDriverByName("GTiff");
+        std::unique_ptr<GDALDataset> poSrcDS(
+            BenchCreateRaster(SIZE, SIZE, 1, GDT_Byte));
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("TILED", "YES");
+        aosOptions.SetNameValue("BLOCKXSIZE", "256");
+        aosOptions.SetNameValue("BLOCKYSIZE", "256");
+        if (!poDrv || !poSrcDS)
+        {
+            goHarness.Fail("cannot create blockcache source");
+            return;
+        }
+        delete poDrv->CreateCopy(pszFilename, poSrcDS.get(), false,
+                                 aosOptions.List(), nullptr, nullptr);
+        psState->poDS.reset(GDALDataset::Open(
+            pszFilename, GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR));
+        if (!psState->poDS)
+            goHarness.Fail("cannot open blockcache dataset");
+    };
+    const auto Teardown = [psState, pszFilename]()
+    {
+        psState->poDS.reset();
+        VSIUnlink(pszFilename);
+    };
+
+    // Whole raster read, served from the block cache after warmup.
+    {
+        BenchHarness::Benchmark oBench;
+        oBench.osName = "blockcache/full_read_cached";
+        oBench.setup = Setup;
+        oBench.run = [psState]()
+        {
+            if (psState->poDS &&
+                !ReadWholeDataset(psState->poDS.get(), psState->abyBuffer))
+                goHarness.Fail("blockcache/full_read_cached");
+        };
+        oBench.teardown = Teardown;
+        oBench.dfBytesPerRun = static_cast<double>(SIZE) * SIZE;
+        goHarness.Add(std::move(oBench));
+    }
+
+    // Random windows with a cache smaller than the raster, to exercise
+    // block eviction.
+    {
+        BenchHarness::Benchmark oBench;
+        oBench.osName = "blockcache/random_windows_small_cache";
+        oBench.setup = [psState, Setup]()
+        {
+            psState->nOldCacheMax = GDALGetCacheMax64();
+            GDALSetCacheMax64(8 * 1024 * 1024);
+            Setup();
+        };
+        oBench.run = [psState]()
+        {
+            if (!psState->poDS)
+                return;
+            std::mt19937 oGen(42);
+            std::uniform_int_distribution<int> oDist(0, SIZE - WINDOW);
+            psState->abyBuffer.resize(WINDOW * WINDOW);
+            auto poBand = psState->poDS->GetRasterBand(1);
+            for (int i = 0; i < WINDOW_COUNT; ++i)
+            {
+                const int nX = oDist(oGen);
+                const int nY = oDist(oGen);
+                if (poBand->RasterIO(GF_Read, nX, nY, WINDOW, WINDOW,
+                                     psState->abyBuffer.data(), WINDOW,
+                                     WINDOW, GDT_Byte, 0, 0,
+                                     nullptr) != CE_None)
+                {
+                    goHarness.Fail("blockcache/random_windows_small_cache");
+                    return;
+                }
+            }
+        };
+        oBench.teardown = [psState, Teardown]()
+        {
+            Teardown();
+            GDALSetCacheMax64(psState->nOldCacheMax);
+        };
+        oBench.dfBytesPerRun =
+            static_cast<double>(WINDOW_COUNT) * WINDOW * WINDOW;
+        goHarness.Add(std::move(oBench));
+    }
+}
+
+/************************************************************************/
+/*                            RegisterGTiff()                           */
+/************************************************************************/
+
+static void RegisterGTiff()
+{
+    constexpr int SIZE = 2048;
+    constexpr int BANDS = 3;
+    auto poDrv = GetGDALDriverManager()->GetDriverByName("GTiff");
+    if (!poDrv)
+        return;
+    const char *pszCOList = poDrv->GetMetadataItem(GDAL_DMD_CREATIONOPTIONLIST);
+
+    auto poSrcDS = std::shared_ptr<GDALDataset>(
+        BenchCreateRaster(SIZE, SIZE, BANDS, GDT_Byte));
+    if (!poSrcDS)
+        return;
+
+    for (const char *pszCodec :
+         {"NONE", "DEFLATE", "LZW", "ZSTD", "LERC", "JPEG"})
+    {
+        if (!EQUAL(pszCodec, "NONE") &&
+            (!pszCOList ||
+             !strstr(pszCOList, CPLSPrintf("<Value>%s</Value>", pszCodec))))
+            continue;
+
+        const std::string osFilename =
+            CPLSPrintf("/vsimem/bench_gtiff_%s.tif", pszCodec);
+        const std::string osCodec(pszCodec);
+        const auto Write = [poDrv, poSrcDS, osFilename, osCodec]()
+        {
+            CPLStringList aosOptions;
+            aosOptions.SetNameValue("TILED", "YES");
+            aosOptions.SetNameValue("COMPRESS", osCodec.c_str());
+            std::unique_ptr<GDALDataset> poDS(
+                poDrv->CreateCopy(osFilename.c_str(), poSrcDS.get(), false,
+                                  aosOptions.List(), nullptr, nullptr));
+            if (!poDS)
+                goHarness.Fail(("gtiff/write_" + osCodec).c_str());
+        };
+        const double dfBytes = static_cast<double>(SIZE) * SIZE * BANDS;
+
+        {
+            BenchHarness::Benchmark oBench;
+            oBench.osName = "gtiff/write_" + osCodec;
+            oBench.run = Write;
+            oBench.teardown = [osFilename]() { VSIUnlink(osFilename.c_str()); };
+            oBench.dfBytesPerRun = dfBytes;
+            goHarness.Add(std::move(oBench));
+        }
+
+        {
+            BenchHarness::Benchmark oBench;
+            oBench.osName = "gtiff/read_" + osCodec;
+            oBench.setup = Write;
+            oBench.run = [osFilename, osCodec]()
+            {
+                // Reopen at each run so that the block cache does not
+                // short-circuit decompression.
+                std::unique_ptr<GDALDataset> poDS(GDALDataset::Open(
+                    osFilename.c_str(), GDAL_OF_RASTER));
+                std::vector<GByte> abyBuffer;
+                if (!poDS || !ReadWholeDataset(poDS.get(), abyBuffer))
+                    goHarness.Fail(("gtiff/read_" + osCodec).c_str());
+            };
+            oBench.teardown = [osFilename]() { VSIUnlink(osFilename.c_str()); };
+            oBench.dfBytesPerRun = dfBytes;
+            goHarness.Add(std::move(oBench));
+        }
+    }
+}
+
+/************************************************************************/
+/*                             RegisterWarp()                           */
+/************************************************************************/
+
+static void RegisterWarp()
+{
+    constexpr int SIZE = 2048;
+    constexpr int BANDS = 3;
+
+    struct State
+    {
+        std::unique_ptr<GDALDataset> poSrcDS{};
+        std::unique_ptr<GDALDataset> poDstDS{};
+        GDALWarpOptions *psOptions = nullptr;
+        std::unique_ptr<GDALWarpOperation> poWO{};
+    };
+
+    const std::pair<GDALResampleAlg, const char *> aAlgs[] = {
+        {GRA_NearestNeighbour, "near"},
+        {GRA_Bilinear, "bilinear"},
+        {GRA_Cubic, "cubic"},
+        {GRA_Lanczos, "lanczos"},
+    };
+    for (const auto &oAlg : aAlgs)
+    {
+        const GDALResampleAlg eAlg = oAlg.first;
+        auto psState = std::make_shared<State>();
+
+        BenchHarness::Benchmark oBench;
+        oBench.osName = std::string("warp/") + oAlg.second;
+        oBench.setup = [psState, eAlg]()
+        {
+            psState->poSrcDS.reset(
+                BenchCreateRaster(SIZE, SIZE, BANDS, GDT_Byte));
+            auto poDrv = GetGDALDriverManager()->GetDriverByName("MEM");
+            psState->poDstDS.reset(poDrv->Create("", SIZE - 2, SIZE - 2, BANDS,
+                                                 GDT_Byte, nullptr));
+            if (!psState->poSrcDS || !psState->poDstDS)
+            {
+                goHarness.Fail("cannot create warp datasets");
+                return;
+            }
+            // Slightly shifted and scaled output grid, so that the
+            // transformer is not a translation on pixel boundaries.
+            double adfDstGT[6] = {0.3, 1.0001, 0, -0.3, 0, -1.0001};
+            psState->poDstDS->SetGeoTransform(adfDstGT);
+
+            GDALWarpOptions *psOptions = GDALCreateWarpOptions();
+            psOptions->hSrcDS = GDALDataset::ToHandle(psState->poSrcDS.get());
+            psOptions->hDstDS = GDALDataset::ToHandle(psState->poDstDS.get());
+            psOptions->eResampleAlg = eAlg;
+            psOptions->nBandCount = BANDS;
+            psOptions->panSrcBands =
+                static_cast<int *>(CPLMalloc(sizeof(int) * BANDS));
+            psOptions->panDstBands =
+                static_cast<int *>(CPLMalloc(sizeof(int) * BANDS));
+            for (int i = 0; i < BANDS; i++)
+            {
+                psOptions->panSrcBands[i] = i + 1;
+                psOptions->panDstBands[i] = i + 1;
+            }
+            psOptions->dfWarpMemoryLimit = 1024.0 * 1024 * 1024;
+            psOptions->pTransformerArg = GDALCreateGenImgProjTransformer2(
+                psOptions->hSrcDS, psOptions->hDstDS, nullptr);
+            psOptions->pfnTransformer = GDALGenImgProjTransform;
+            psState->psOptions = psOptions;
+            psState->poWO = std::make_unique<GDALWarpOperation>();
+            if (psState->poWO->Initialize(psOptions) != CE_None)
+                goHarness.Fail("GDALWarpOperation::Initialize() failed");
+        };
+        oBench.run = [psState]()
+        {
+            if (psState->poWO &&
+                psState->poWO->ChunkAndWarpImage(0, 0, SIZE - 2, SIZE - 2) !=
+                    CE_None)
+                goHarness.Fail("ChunkAndWarpImage() failed");
+        };
+        oBench.teardown = [psState]()
+        {
+            psState->poWO.reset();
+            if (psState->psOptions)
+            {
+                GDALDestroyGenImgProjTransformer(
+                    psState->psOptions->pTransformerArg);
+                GDALDestroyWarpOptions(psState->psOptions);
+                psState->psOptions = nullptr;
+            }
+            psState->poDstDS.reset();
+            psState->poSrcDS.reset();
+        };
+        oBench.dfBytesPerRun =
+            static_cast<double>(SIZE - 2) * (SIZE - 2) * BANDS;
+        goHarness.Add(std::move(oBench));
+    }
+}
+
+/************************************************************************/
+/*                           RegisterOverview()                         */
+/************************************************************************/
+
+static void RegisterOverview()
+{
+    constexpr int SIZE = 4096;
+
+    struct State
+    {
+        std::unique_ptr<GDALDataset> poSrcDS{};
+        std::unique_ptr<GDALDataset> poOvr1DS{};
+        std::unique_ptr<GDALDataset> poOvr2DS{};
+    };
+
+    for (const char *pszResampling :
+         {"NEAREST", "AVERAGE", "BILINEAR", "CUBIC"})
+    {
+        auto psState = std::make_shared<State>();
+        const std::string osResampling(pszResampling);
+
+        BenchHarness::Benchmark oBench;
+        oBench.osName = "overview/" + CPLString(pszResampling).tolower();
+        oBench.setup = [psState]()
+        {
+            auto poDrv = GetGDALDriverManager()->GetDriverByName("MEM");
+            psState->poSrcDS.reset(BenchCreateRaster(SIZE, SIZE, 1, GDT_Byte));
+            psState->poOvr1DS.reset(
+                poDrv->Create("", SIZE / 2, SIZE / 2, 1, GDT_Byte, nullptr));
+            psState->poOvr2DS.reset(
+                poDrv->Create("", SIZE / 4, SIZE / 4, 1, GDT_Byte, nullptr));
+            if (!psState->poSrcDS || !psState->poOvr1DS || !psState->poOvr2DS)
+                goHarness.Fail("cannot create overview datasets");
+        };
+        oBench.run = [psState, osResampling]()
+        {
+            if (!psState->poSrcDS)
+                return;
+            GDALRasterBandH ahOvrBands[] = {
+                GDALRasterBand::ToHandle(psState->poOvr1DS->GetRasterBand(1)),
+                GDALRasterBand::ToHandle(psState->poOvr2DS->GetRasterBand(1))};
+            if (GDALRegenerateOverviews(
+                    GDALRasterBand::ToHandle(
+                        psState->poSrcDS->GetRasterBand(1)),
+                    2, ahOvrBands, osResampling.c_str(), nullptr,
+                    nullptr) != CE_None)
+                goHarness.Fail("GDALRegenerateOverviews() failed");
+        };
+        oBench.teardown = [psState]()
+        {
+            psState->poOvr2DS.reset();
+            psState->poOvr1DS.reset();
+            psState->poSrcDS.reset();
+        };
+        oBench.dfBytesPerRun = static_cast<double>(SIZE) * SIZE;
+        goHarness.Add(std::move(oBench));
+    }
+}
+
+#ifndef _WIN32
+
+/************************************************************************/
+/*                            MockHTTPServer                            */
+/*                                                                      */
+/*      Minimal HTTP/1.1 server on the loopback interface, serving      */
+/*      in-memory files with HEAD, GET and single Range requests, so    */
+/*      that /vsicurl/ can be benchmarked without network access.      */
+/************************************************************************/
+
+class MockHTTPServer
+{
+  public:
+    MockHTTPServer() = default;
+
+    ~MockHTTPServer()
+    {
+        Stop();
+    }
+
+    void AddFile(const std::string &osPath, std::string &&osContent)
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_oFiles[osPath] = std::move(osContent);
+    }
+
+    bool Start()
+    {
+        m_nListenFD = socket(AF_INET, SOCK_STREAM, 0);
+        if (m_nListenFD < 0)
+            return false;
+        const int nOne = 1;
+        setsockopt(m_nListenFD, SOL_SOCKET, SO_REUSEADDR, &nOne, sizeof(nOne));
+        struct sockaddr_in sAddr;
+        memset(&sAddr, 0, sizeof(sAddr));
+        sAddr.sin_family = AF_INET;
+        sAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        sAddr.sin_port = 0;
+        socklen_t nLen = sizeof(sAddr);
+        if (bind(m_nListenFD, reinterpret_cast<struct sockaddr *>(&sAddr),
+                 sizeof(sAddr)) != 0 ||
+            listen(m_nListenFD, 64) != 0 ||
+            getsockname(m_nListenFD,
+                        reinterpret_cast<struct sockaddr *>(&sAddr),
+                        &nLen) != 0)
+        {
+            close(m_nListenFD);
+            m_nListenFD = -1;
+            return false;
+        }
+        m_nPort = ntohs(sAddr.sin_port);
+        m_bStop = false;
+        m_oThread = std::thread([this]() { Loop(); });
+        return true;
+    }
+
+    void Stop()
+    {
+        if (m_oThread.joinable())
+        {
+            m_bStop = true;
+            m_oThread.join();
+        }
+        if (m_nListenFD >= 0)
+        {
+            close(m_nListenFD);
+            m_nListenFD = -1;
+        }
+    }
+
+    std::string GetURL(const std::string &osPath) const
+    {
+        return CPLSPrintf("http://127.0.0.1:%d%s", m_nPort, osPath.c_str());
+    }
+
+  private:
+    int m_nListenFD = -1;
+    int m_nPort = 0;
+    std::atomic<bool> m_bStop{false};
+    std::thread m_oThread{};
+    std::mutex m_oMutex{};
+    std::map<std::string, std::string> m_oFiles{};
+
+    CPL_DISALLOW_COPY_ASSIGN(MockHTTPServer)
+
+    void Loop()
+    {
+        while (!m_bStop)
+        {
+            struct pollfd sPoll;
+            sPoll.fd = m_nListenFD;
+            sPoll.events = POLLIN;
+            sPoll.revents = 0;
+            if (poll(&sPoll, 1, 100) <= 0)
+                continue;
+            const int nFD = accept(m_nListenFD, nullptr, nullptr);
+            if (nFD < 0)
+                continue;
+            HandleConnection(nFD);
+            close(nFD);
+        }
+    }
+
+    static void SendAll(int nFD, const char *pabyData, size_t nSize)
+    {
+        while (nSize > 0)
+        {
+            const auto nSent = send(nFD, pabyData, nSize, 0);
+            if (nSent <= 0)
+                return;
+            pabyData += nSent;
+            nSize -= static_cast<size_t>(nSent);
+        }
+    }
+
+    void HandleConnection(int nFD)
+    {
+        std::string osRequest;
+        char szBuffer[4096];
+        while (osRequest.find("\r\n\r\n") == std::string::npos)
+        {
+            const auto nRead = recv(nFD, szBuffer, sizeof(szBuffer), 0);
+            if (nRead <= 0)
+                return;
+            osRequest.append(szBuffer, static_cast<size_t>(nRead));
+        }
+
+        const CPLStringList aosLines(
+            CSLTokenizeString2(osRequest.c_str(), "\r\n", 0));
+        if (aosLines.size() == 0)
+            return;
+        const CPLStringList aosRequestLine(
+            CSLTokenizeString2(aosLines[0], " ", 0));
+        if (aosRequestLine.size() < 2)
+            return;
+        const bool bHead = EQUAL(aosRequestLine[0], "HEAD");
+
+        std::string osBody;
+        bool bFound = false;
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            const auto oIter = m_oFiles.find(aosRequestLine[1]);
+            if (oIter != m_oFiles.end())
+            {
+                bFound = true;
+                osBody = oIter->second;
+            }
+        }
+        if (!bFound)
+        {
+            const char szResponse[] = "HTTP/1.1 404 Not Found\r\n"
+                                      "Content-Length: 0\r\n"
+                                      "Connection: close\r\n\r\n";
+            SendAll(nFD, szResponse, strlen(szResponse));
+            return;
+        }
+
+        const size_t nFileSize = osBody.size();
+        size_t nStart = 0;
+        size_t nEnd = nFileSize ? nFileSize - 1 : 0;
+        bool bRange = false;
+        for (int i = 1; i < aosLines.size(); ++i)
+        {
+            if (STARTS_WITH_CI(aosLines[i], "Range: bytes="))
+            {
+                const char *pszRange = aosLines[i] + strlen("Range: bytes=");
+                nStart = static_cast<size_t>(
+                    std::strtoull(pszRange, nullptr, 10));
+                const char *pszDash = strchr(pszRange, '-');
+                if (pszDash && pszDash[1] != '\0')
+                    nEnd = static_cast<size_t>(
+                        std::strtoull(pszDash + 1, nullptr, 10));
+                if (nEnd >= nFileSize)
+                    nEnd = nFileSize ? nFileSize - 1 : 0;
+                bRange = nStart <= nEnd && nStart < nFileSize;
+            }
+        }
+
+        std::string osHeader;
+        size_t nContentLength = nFileSize;
+        if (bRange)
+        {
+            nContentLength = nEnd - nStart + 1;
+            osHeader = "HTTP/1.1 206 Partial Content\r\n";
+            osHeader += CPLSPrintf("Content-Range: bytes %u-%u/%u\r\n",
+                                   static_cast<unsigned>(nStart),
+                                   static_cast<unsigned>(nEnd),
+                                   static_cast<unsigned>(nFileSize));
+        }
+        else
+        {
+            nStart = 0;
+            osHeader = "HTTP/1.1 200 OK\r\n";
+        }
+        osHeader += CPLSPrintf("Content-Length: %u\r\n",
+                               static_cast<unsigned>(nContentLength));
+        osHeader += "Accept-Ranges: bytes\r\n";
+        osHeader += "Connection: close\r\n\r\n";
+        SendAll(nFD, osHeader.data(), osHeader.size());
+        if (!bHead)
+            SendAll(nFD, osBody.data() + nStart, nContentLength);
+    }
+};
+
+/************************************************************************/
+/*                           RegisterVSICurl()                          */
+/************************************************************************/
+
+static void RegisterVSICurl()
+{
+    const CPLStringList aosPrefixes(VSIGetFileSystemsPrefixes());
+    if (aosPrefixes.FindString("/vsicurl/") < 0)
+        return;
+
+    constexpr int SIZE = 2048;
+    auto poServer = std::make_shared<MockHTTPServer>();
+
+    // Serve a tiled DEFLATE GTiff.
+    const auto Setup = [poServer]()
+    {
+        const char *pszTmp = "/vsimem/bench_vsicurl.tif";
+        auto poDrv = GetGDALDriverManager()->GetDriverByName("GTiff");
+        std::unique_ptr<GDALDataset> poSrcDS(
+            BenchCreateRaster(SIZE, SIZE, 3, GDT_Byte));
+        if (!poDrv || !poSrcDS)
+        {
+            goHarness.Fail("cannot create vsicurl source");
+            return;
+        }
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("TILED", "YES");
+        aosOptions.SetNameValue("COMPRESS", "DEFLATE");
+        delete poDrv->CreateCopy(pszTmp, poSrcDS.get(), false,
+                                 aosOptions.List(), nullptr, nullptr);
+        vsi_l_offset nSize = 0;
+        GByte *pabyData = VSIGetMemFileBuffer(pszTmp, &nSize, false);
+        if (pabyData)
+            poServer->AddFile(
+                "/bench.tif",
+                std::string(reinterpret_cast<char *>(pabyData),
+                            static_cast<size_t>(nSize)));
+        VSIUnlink(pszTmp);
+        if (!pabyData || !poServer->Start())
+            goHarness.Fail("cannot start mock HTTP server");
+        CPLSetConfigOption("GDAL_DISABLE_READDIR_ON_OPEN", "EMPTY_DIR");
+    };
+    const auto Teardown = [poServer]()
+    {
+        poServer->Stop();
+        VSICurlClearCache();
+        CPLSetConfigOption("GDAL_DISABLE_READDIR_ON_OPEN", nullptr);
+    };
+
+    // Cold open and full read: every run starts with an empty
+    // /vsicurl/ cache.
+    {
+        BenchHarness::Benchmark oBench;
+        oBench.osName = "vsicurl/gtiff_full_read";
+        oBench.setup = Setup;
+        oBench.run = [poServer]()
+        {
+            VSICurlClearCache();
+            const std::string osName =
+                "/vsicurl/" + poServer->GetURL("/bench.tif");
+            std::unique_ptr<GDALDataset> poDS(
+                GDALDataset::Open(osName.c_str(), GDAL_OF_RASTER));
+            std::vector<GByte> abyBuffer;
+            if (!poDS || !ReadWholeDataset(poDS.get(), abyBuffer))
+                goHarness.Fail("vsicurl/gtiff_full_read");
+        };
+        oBench.teardown = Teardown;
+        oBench.dfBytesPerRun = static_cast<double>(SIZE) * SIZE * 3;
+        goHarness.Add(std::move(oBench));
+    }
+
+    // Cold open and a few scattered windows, which is dominated by the
+    // number and size of range requests.
+    {
+        BenchHarness::Benchmark oBench;
+        oBench.osName = "vsicurl/gtiff_random_windows";
+        oBench.setup = Setup;
+        oBench.run = [poServer]()
+        {
+            VSICurlClearCache();
+            const std::string osName =
+                "/vsicurl/" + poServer->GetURL("/bench.tif");
+            std::unique_ptr<GDALDataset> poDS(
+                GDALDataset::Open(osName.c_str(), GDAL_OF_RASTER));
+            if (!poDS)
+            {
+                goHarness.Fail("vsicurl/gtiff_random_windows");
+                return;
+            }
+            std::mt19937 oGen(42);
+            std::uniform_int_distribution<int> oDist(0, SIZE - 256);
+            std::vector<GByte> abyBuffer(256 * 256 * 3);
+            for (int i = 0; i < 16; ++i)
+            {
+                if (poDS->RasterIO(GF_Read, oDist(oGen), oDist(oGen), 256,
+                                   256, abyBuffer.data(), 256, 256, GDT_Byte,
+                                   3, nullptr, 0, 0, 0, nullptr) != CE_None)
+                {
+                    goHarness.Fail("vsicurl/gtiff_random_windows");
+                    return;
+                }
+            }
+        };
+        oBench.teardown = Teardown;
+        oBench.dfBytesPerRun = 16.0 * 256 * 256 * 3;
+        goHarness.Add(std::move(oBench));
+    }
+}
+
+#endif  // _WIN32
+
+/************************************************************************/
+/*                              FillLayer()                             */
+/*                                                                      */
+/*      Fill a layer with deterministic point features with an integer, */
+/*      a real and a string attribute.                                  */
+/************************************************************************/
+
+static bool FillLayer(OGRLayer *poLayer, int nFeatures)
+{
+    OGRFieldDefn oFieldId("id", OFTInteger);
+    OGRFieldDefn oFieldVal("val", OFTReal);
+    OGRFieldDefn oFieldCat("cat", OFTString);
+    if (poLayer->CreateField(&oFieldId) != OGRERR_NONE ||
+        poLayer->CreateField(&oFieldVal) != OGRERR_NONE ||
+        poLayer->CreateField(&oFieldCat) != OGRERR_NONE)
+        return false;
+
+    std::mt19937 oGen(42);
+    std::uniform_real_distribution<double> oDist(0, 1000);
+    std::uniform_int_distribution<int> oCat(0, 99);
+    const bool bTransaction =
+        poLayer->TestCapability(OLCTransactions) &&
+        poLayer->StartTransaction() == OGRERR_NONE;
+    for (int i = 0; i < nFeatures; ++i)
+    {
+        OGRFeature oFeature(poLayer->GetLayerDefn());
+        oFeature.SetField(0, i);
+        oFeature.SetField(1, oDist(oGen));
+        oFeature.SetField(2, CPLSPrintf("category_%02d", oCat(oGen)));
+        oFeature.SetGeometry(
+            std::make_unique<OGRPoint>(oDist(oGen), oDist(oGen)).get());
+        if (poLayer->CreateFeature(&oFeature) != OGRERR_NONE)
+            return false;
+    }
+    return !bTransaction || poLayer->CommitTransaction() == OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                        CreateVectorDataset()                         */
+/************************************************************************/
+
+static GDALDataset *CreateVectorDataset(const char *pszDriver,
+                                        const char *pszFilename,
+                                        int nFeatures)
+{
+    auto poDrv = GetGDALDriverManager()->GetDriverByName(pszDriver);
+    if (!poDrv)
+        return nullptr;
+    std::unique_ptr<GDALDataset> poDS(
+        poDrv->Create(pszFilename, 0, 0, 0, GDT_Unknown, nullptr));
+    if (!poDS)
+        return nullptr;
+    OGRSpatialReference oSRS;
+    oSRS.SetFromUserInput("WGS84");
+    oSRS.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+    OGRLayer *poLayer = poDS->CreateLayer("bench", &oSRS, wkbPoint, nullptr);
+    if (!poLayer || !FillLayer(poLayer, nFeatures))
+        return nullptr;
+    return poDS.release();
+}
+
+/************************************************************************/
+/*                           RegisterOGRSQL()                           */
+/************************************************************************/
+
+static void RegisterOGRSQL()
+{
+    constexpr int FEATURES = 200 * 1000;
+    auto poDS = std::make_shared<std::unique_ptr<GDALDataset>>();
+
+    const std::pair<const char *, const char *> aQueries[] = {
+        {"where", "SELECT * FROM bench WHERE val > 500 AND cat = "
+                  "'category_42'"},
+        {"order_by", "SELECT id, val FROM bench ORDER BY val"},
+        {"distinct", "SELECT DISTINCT cat FROM bench"},
+        {"aggregate",
+         "SELECT COUNT(*), MIN(val), MAX(val), AVG(val) FROM bench"},
+    };
+    for (const auto &oQuery : aQueries)
+    {
+        const std::string osSQL(oQuery.second);
+
+        BenchHarness::Benchmark oBench;
+        oBench.osName = std::string("ogrsql/") + oQuery.first;
+        oBench.setup = [poDS]()
+        {
+            poDS->reset(CreateVectorDataset("MEM", "", FEATURES));
+            if (!*poDS)
+                goHarness.Fail("cannot create OGR SQL dataset");
+        };
+        oBench.run = [poDS, osSQL]()
+        {
+            if (!*poDS)
+                return;
+            OGRLayer *poLayer =
+                (*poDS)->ExecuteSQL(osSQL.c_str(), nullptr, "OGRSQL");
+            if (!poLayer)
+            {
+                goHarness.Fail(osSQL.c_str());
+                return;
+            }
+            for (auto &&poFeature : *poLayer)
+                CPL_IGNORE_RET_VAL(poFeature);
+            (*poDS)->ReleaseResultSet(poLayer);
+        };
+        oBench.teardown = [poDS]() { poDS->reset(); };
+        oBench.dfItemsPerRun = FEATURES;
+        goHarness.Add(std::move(oBench));
+    }
+}
+
+/************************************************************************/
+/*                         RegisterArrowStream()                        */
+/************************************************************************/
+
+static void RegisterArrowStream()
+{
+    constexpr int FEATURES = 200 * 1000;
+
+    for (const char *pszDriver : {"MEM", "GPKG"})
+    {
+        if (!GetGDALDriverManager()->GetDriverByName(pszDriver))
+            continue;
+        const std::string osDriver(pszDriver);
+        const std::string osFilename =
+            EQUAL(pszDriver, "MEM") ? "" : "/vsimem/bench_arrow.gpkg";
+        auto poDS = std::make_shared<std::unique_ptr<GDALDataset>>();
+
+        BenchHarness::Benchmark oBench;
+        oBench.osName = "arrow/" + CPLString(pszDriver).tolower();
+        oBench.setup = [poDS, osDriver, osFilename]()
+        {
+            std::unique_ptr<GDALDataset> poTmpDS(CreateVectorDataset(
+                osDriver.c_str(), osFilename.c_str(), FEATURES));
+            if (!osFilename.empty() && poTmpDS)
+            {
+                poTmpDS.reset();
+                poTmpDS.reset(GDALDataset::Open(osFilename.c_str(),
+                                                GDAL_OF_VECTOR));
+            }
+            *poDS = std::move(poTmpDS);
+            if (!*poDS)
+                goHarness.Fail("cannot create Arrow stream dataset");
+        };
+        oBench.run = [poDS]()
+        {
+            if (!*poDS)
+                return;
+            OGRLayer *poLayer = (*poDS)->GetLayer(0);
+            struct ArrowArrayStream stream;
+            if (!poLayer->GetArrowStream(&stream, nullptr))
+            {
+                goHarness.Fail("GetArrowStream() failed");
+                return;
+            }
+            while (true)
+            {
+                struct ArrowArray array;
+                if (stream.get_next(&stream, &array) != 0 ||
+                    array.release == nullptr)
+                    break;
+                array.release(&array);
+            }
+            stream.release(&stream);
+        };
+        oBench.teardown = [poDS, osFilename]()
+        {
+            poDS->reset();
+            if (!osFilename.empty())
+                VSIUnlink(osFilename.c_str());
+        };
+        oBench.dfItemsPerRun = FEATURES;
+        goHarness.Add(std::move(oBench));
+    }
+}
+
+/************************************************************************/
+/*                        RegisterVectorDrivers()                       */
+/************************************************************************/
+
+static void RegisterVectorDrivers()
+{
+    constexpr int FEATURES = 100 * 1000;
+
+    const std::pair<const char *, const char *> aDrivers[] = {
+        {"GPKG", "gpkg"},       {"FlatGeobuf", "fgb"},
+        {"ESRI Shapefile", "shp"}, {"GeoJSON", "geojson"},
+        {"CSV", "csv"},
+    };
+    for (const auto &oDriver : aDrivers)
+    {
+        if (!GetGDALDriverManager()->GetDriverByName(oDriver.first))
+            continue;
+        const std::string osDriver(oDriver.first);
+        const std::string osExt(oDriver.second);
+        // Use a directory for drivers that create side-car files.
+        const std::string osDir = "/vsimem/bench_vector_" + osExt;
+        const std::string osFilename = osDir + "/bench." + osExt;
+        const auto Write = [osDriver, osDir, osFilename]()
+        {
+            VSIRmdirRecursive(osDir.c_str());
+            VSIMkdir(osDir.c_str(), 0755);
+            std::unique_ptr<GDALDataset> poDS(CreateVectorDataset(
+                osDriver.c_str(), osFilename.c_str(), FEATURES));
+            if (!poDS)
+                goHarness.Fail(("cannot write " + osFilename).c_str());
+        };
+        const auto Cleanup = [osDir]() { VSIRmdirRecursive(osDir.c_str()); };
+
+        {
+            BenchHarness::Benchmark oBench;
+            oBench.osName = "vector/write_" + osExt;
+            oBench.run = Write;
+            oBench.teardown = Cleanup;
+            oBench.dfItemsPerRun = FEATURES;
+            goHarness.Add(std::move(oBench));
+        }
+
+        {
+            BenchHarness::Benchmark oBench;
+            oBench.osName = "vector/read_" + osExt;
+            oBench.setup = Write;
+            oBench.run = [osFilename]()
+            {
+                std::unique_ptr<GDALDataset> poDS(GDALDataset::Open(
+                    osFilename.c_str(), GDAL_OF_VECTOR));
+                if (!poDS || poDS->GetLayerCount() == 0)
+                {
+                    goHarness.Fail(("cannot read " + osFilename).c_str());
+                    return;
+                }
+                for (auto &&poFeature : *(poDS->GetLayer(0)))
+                    CPL_IGNORE_RET_VAL(poFeature);
+            };
+            oBench.teardown = Cleanup;
+            oBench.dfItemsPerRun = FEATURES;
+            goHarness.Add(std::move(oBench));
+        }
+    }
+}
+
+/************************************************************************/
+/*                                main()                                */
+/************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    GDALAllRegister();
+
+    RegisterCopyWords();
+    RegisterBlockCache();
+    RegisterGTiff();
+    RegisterWarp();
+    RegisterOverview();
+#ifndef _WIN32
+    RegisterVSICurl();
+#endif
+    RegisterOGRSQL();
+    RegisterArrowStream();
+    RegisterVectorDrivers();
+
+    const int nRet = goHarness.Main(argc, argv);
+
+    GDALDestroyDriverManager();
+    return nRet;
+}
@@ -0,0 +1,321 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Utilities
+ * Purpose:  Common harness for the C++ benchmarks of perftests/
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef BENCH_HARNESS_H_INCLUDED
+#define BENCH_HARNESS_H_INCLUDED
+
+#include "cpl_conv.h"
+#include "cpl_json.h"
+#include "cpl_string.h"
+#include "gdal_priv.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+/************************************************************************/
+/*                            BenchHarness                              */
+/*                                                                      */
+/*      Registers named benchmarks, runs them with warmup iterations,   */
+/*      and reports min / median / 90th percentile timings, on stdout   */
+/*      and optionally as a JSON file.                                  */
+/************************************************************************/
+
+class BenchHarness
+{
+  public:
+    using Func = std::function<void()>;
+
+    struct Benchmark
+    {
+        // Name, as "group/case".
+        std::string osName{};
+        // Untimed, called once before the warmup iterations.
+        Func setup{};
+        // Timed.
+        Func run{};
+        // Untimed, called once after the timed iterations.
+        Func teardown{};
+        // Bytes and items processed by one run, for throughput reporting.
+        double dfBytesPerRun = 0;
+        double dfItemsPerRun = 0;
+    };
+
+    void Add(Benchmark &&oBench)
+    {
+        m_aoBenchmarks.push_back(std::move(oBench));
+    }
+
+    void Add(const std::string &osName, Func run, double dfBytesPerRun = 0,
+             double dfItemsPerRun = 0)
+    {
+        Benchmark oBench;
+        oBench.osName = osName;
+        oBench.run = std::move(run);
+        oBench.dfBytesPerRun = dfBytesPerRun;
+        oBench.dfItemsPerRun = dfItemsPerRun;
+        Add(std::move(oBench));
+    }
+
+    static void Usage(const char *pszProgName)
+    {
+        printf("Usage: %s [--list] [--filter <substring>]*\n", pszProgName);
+        printf("       [--warmup <n>] [--iterations <n>] [--json <file>]\n");
+        printf("\n");
+        printf("--filter: only run benchmarks whose name contains one of "
+               "the substrings.\n");
+        printf("--warmup: untimed runs of each benchmark (default 1).\n");
+        printf("--iterations: timed runs of each benchmark (default 5).\n");
+        printf("--json: write the results to this JSON file.\n");
+        exit(1);
+    }
+
+    // Parse the command line, run the selected benchmarks and report.
+    // Returns the process exit code.
+    int Main(int argc, char *argv[])
+    {
+        bool bList = false;
+        for (int iArg = 1; iArg < argc; ++iArg)
+        {
+            if (strcmp(argv[iArg], "--list") == 0)
+                bList = true;
+            else if (iArg + 1 < argc && strcmp(argv[iArg], "--filter") == 0)
+                m_aosFilters.push_back(argv[++iArg]);
+            else if (iArg + 1 < argc && strcmp(argv[iArg], "--warmup") == 0)
+                m_nWarmup = std::max(0, atoi(argv[++iArg]));
+            else if (iArg + 1 < argc &&
+                     strcmp(argv[iArg], "--iterations") == 0)
+                m_nIterations = std::max(1, atoi(argv[++iArg]));
+            else if (iArg + 1 < argc && strcmp(argv[iArg], "--json") == 0)
+                m_osJSONFilename = argv[++iArg];
+            else
+                Usage(argv[0]);
+        }
+
+        if (bList)
+        {
+            for (const auto &oBench : m_aoBenchmarks)
+                printf("%s\n", oBench.osName.c_str());
+            return 0;
+        }
+
+        CPLJSONArray oResults;
+        printf("%-40s %12s %12s %12s %14s\n", "benchmark", "median (ms)",
+               "p90 (ms)", "min (ms)", "throughput");
+        for (auto &oBench : m_aoBenchmarks)
+        {
+            if (!IsSelected(oBench.osName))
+                continue;
+            oResults.Add(RunOne(oBench));
+        }
+
+        if (!m_osJSONFilename.empty())
+        {
+            CPLJSONObject oRoot;
+            oRoot.Add("gdal_version", GDALVersionInfo("RELEASE_NAME"));
+            oRoot.Add("num_cpus", CPLGetNumCPUs());
+            oRoot.Add("warmup", m_nWarmup);
+            oRoot.Add("iterations", m_nIterations);
+            oRoot.Add("benchmarks", oResults);
+            CPLJSONDocument oDoc;
+            oDoc.SetRoot(oRoot);
+            if (!oDoc.Save(m_osJSONFilename))
+            {
+                fprintf(stderr, "Cannot write %s\n", m_osJSONFilename.c_str());
+                return 1;
+            }
+        }
+        return m_bHasFailure ? 1 : 0;
+    }
+
+    // Report a failure of the current benchmark (e.g. a failed I/O).
+    void Fail(const char *pszMsg)
+    {
+        fprintf(stderr, "FAILURE: %s\n", pszMsg);
+        m_bHasFailure = true;
+    }
+
+  private:
+    std::vector<Benchmark> m_aoBenchmarks{};
+    std::vector<std::string> m_aosFilters{};
+    int m_nWarmup = 1;
+    int m_nIterations = 5;
+    std::string m_osJSONFilename{};
+    bool m_bHasFailure = false;
+
+    bool IsSelected(const std::string &osName) const
+    {
+        if (m_aosFilters.empty())
+            return true;
+        for (const auto &osFilter : m_aosFilters)
+        {
+            if (osName.find(osFilter) != std::string::npos)
+                return true;
+        }
+        return false;
+    }
+
+    // Nearest-rank percentile of sorted values.
+    static double Percentile(const std::vector<double> &adfSorted,
+                             double dfPct)
+    {
+        const size_t nRank = static_cast<size_t>(
+            std::ceil(dfPct / 100.0 * static_cast<double>(adfSorted.size())));
+        return adfSorted[std::max<size_t>(1, nRank) - 1];
+    }
+
+    CPLJSONObject RunOne(Benchmark &oBench)
+    {
+        if (oBench.setup)
+            oBench.setup();
+        for (int i = 0; i < m_nWarmup; ++i)
+            oBench.run();
+
+        std::vector<double> adfTimesMs;
+        for (int i = 0; i < m_nIterations; ++i)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            oBench.run();
+            const auto end = std::chrono::steady_clock::now();
+            adfTimesMs.push_back(
+                std::chrono::duration<double, std::milli>(end - start)
+                    .count());
+        }
+
+        if (oBench.teardown)
+            oBench.teardown();
+
+        std::vector<double> adfSorted(adfTimesMs);
+        std::sort(adfSorted.begin(), adfSorted.end());
+        const double dfMin = adfSorted.front();
+        const double dfMedian = Percentile(adfSorted, 50);
+        const double dfP90 = Percentile(adfSorted, 90);
+        double dfMean = 0;
+        for (double dfVal : adfTimesMs)
+            dfMean += dfVal;
+        dfMean /= static_cast<double>(adfTimesMs.size());
+        double dfVariance = 0;
+        for (double dfVal : adfTimesMs)
+            dfVariance += (dfVal - dfMean) * (dfVal - dfMean);
+        dfVariance /= static_cast<double>(adfTimesMs.size());
+
+        std::string osThroughput;
+        if (dfMedian > 0 && oBench.dfBytesPerRun > 0)
+            osThroughput = CPLSPrintf(
+                "%.1f MB/s", oBench.dfBytesPerRun / 1e6 / (dfMedian / 1e3));
+        else if (dfMedian > 0 && oBench.dfItemsPerRun > 0)
+            osThroughput = CPLSPrintf(
+                "%.3g it/s", oBench.dfItemsPerRun / (dfMedian / 1e3));
+        printf("%-40s %12.3f %12.3f %12.3f %14s\n", oBench.osName.c_str(),
+               dfMedian, dfP90, dfMin, osThroughput.c_str());
+        fflush(stdout);
+
+        CPLJSONObject oResult;
+        oResult.Add("name", oBench.osName);
+        CPLJSONArray oTimes;
+        for (double dfVal : adfTimesMs)
+            oTimes.Add(dfVal);
+        oResult.Add("times_ms", oTimes);
+        oResult.Add("min_ms", dfMin);
+        oResult.Add("median_ms", dfMedian);
+        oResult.Add("p90_ms", dfP90);
+        oResult.Add("mean_ms", dfMean);
+        oResult.Add("stddev_ms", std::sqrt(dfVariance));
+        if (oBench.dfBytesPerRun > 0)
+            oResult.Add("bytes_per_run", oBench.dfBytesPerRun);
+        if (oBench.dfItemsPerRun > 0)
+            oResult.Add("items_per_run", oBench.dfItemsPerRun);
+        return oResult;
+    }
+};
+
+/************************************************************************/
+/*                          Synthetic data                              */
+/************************************************************************/
+
+// Fill a dataset with a smooth pattern plus some noise, which compresses
+// roughly like real imagery (neither constant nor pure noise). The noise
+// comes from a seeded generator, so that all runs and machines process the
+// same data.
+inline bool BenchFillRaster(GDALDataset *poDS, unsigned nSeed = 42)
+{
+    std::mt19937 oGen(nSeed);
+    std::uniform_int_distribution<int> oNoise(0, 15);
+    const int nXSize = poDS->GetRasterXSize();
+    const int nYSize = poDS->GetRasterYSize();
+    std::vector<double> adfLine(nXSize);
+    for (int iBand = 1; iBand <= poDS->GetRasterCount(); ++iBand)
+    {
+        GDALRasterBand *poBand = poDS->GetRasterBand(iBand);
+        for (int iY = 0; iY < nYSize; ++iY)
+        {
+            for (int iX = 0; iX < nXSize; ++iX)
+            {
+                adfLine[iX] =
+                    100 + 60 * std::sin((iX + 3 * iBand) / 50.0) *
+                              std::cos((iY - 5 * iBand) / 70.0) +
+                    oNoise(oGen);
+            }
+            if (poBand->RasterIO(GF_Write, 0, iY, nXSize, 1, adfLine.data(),
+                                 nXSize, 1, GDT_Float64, 0, 0,
+                                 nullptr) != CE_None)
+                return false;
+        }
+    }
+    return true;
+}
+
+// Create an in-memory raster filled with synthetic data.
+inline GDALDataset *BenchCreateRaster(int nXSize, int nYSize, int nBands,
+                                      GDALDataType eDT, unsigned nSeed = 42)
+{
+    auto poDrv = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (poDrv == nullptr)
+        return nullptr;
+    GDALDataset *poDS =
+        poDrv->Create("", nXSize, nYSize, nBands, eDT, nullptr);
+    if (poDS == nullptr)
+        return nullptr;
+    double adfGT[6] = {0, 1, 0, 0, 0, -1};
+    poDS->SetGeoTransform(adfGT);
+    if (!BenchFillRaster(poDS, nSeed))
+    {
+        delete poDS;
+        return nullptr;
+    }
+    return poDS;
+}
+
+#endif /* BENCH_HARNESS_H_INCLUDED */
@@ -0,0 +1,168 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Utilities
+ * Purpose:  Benchmark of OGRFeatureQuery::Evaluate()
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_conv.h"
+#include "ogr_feature.h"
+#include "ogrsf_frmts.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+/************************************************************************/
+/*                               Usage()                                */
+/************************************************************************/
+
+static void Usage()
+{
+    printf("Usage: bench_ogr_attribute_filter [-n feature_count] "
+           "[-where filter]*\n");
+    exit(1);
+}
+
+/************************************************************************/
+/*                              Evaluate()                              */
+/************************************************************************/
+
+// Returns the number of matching features and the elapsed time in seconds.
+static int Evaluate(OGRFeatureDefn *poDefn,
+                    const std::vector<std::unique_ptr<OGRFeature>> &apoFeatures,
+                    const char *pszWhere, bool bCompile, double &dfElapsed)
+{
+    CPLConfigOptionSetter oSetter("OGR_COMPILE_ATTRIBUTE_FILTER",
+                                  bCompile ? "YES" : "NO", false);
+    OGRFeatureQuery oQuery;
+    if (oQuery.Compile(poDefn, pszWhere) != OGRERR_NONE)
+        exit(1);
+
+    const auto start = std::chrono::steady_clock::now();
+    int nMatches = 0;
+    for (const auto &poFeature : apoFeatures)
+    {
+        if (oQuery.Evaluate(poFeature.get()))
+            ++nMatches;
+    }
+    dfElapsed = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+    return nMatches;
+}
+
+/************************************************************************/
+/*                               main()                                 */
+/************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        exit(-argc);
+
+    int nFeatures = 1000 * 1000;
+    CPLStringList aosWhere;
+    for (int iArg = 1; iArg < argc; ++iArg)
+    {
+        if (iArg + 1 < argc && strcmp(argv[iArg], "-n") == 0)
+        {
+            nFeatures = atoi(argv[iArg + 1]);
+            ++iArg;
+        }
+        else if (iArg + 1 < argc && strcmp(argv[iArg], "-where") == 0)
+        {
+            aosWhere.AddString(argv[iArg + 1]);
+            ++iArg;
+        }
+        else
+        {
+            Usage();
+        }
+    }
+    if (aosWhere.empty())
+    {
+        aosWhere.AddString("int_field = 5");
+        aosWhere.AddString("int_field >= 10 AND real_field < 0.5");
+        aosWhere.AddString("int64_field BETWEEN 100 AND 200 OR "
+                           "str_field = 'value_7'");
+        aosWhere.AddString("str_field IN ('value_1', 'value_2', 'value_3')");
+        aosWhere.AddString("NOT (str_field LIKE 'value_1%') AND "
+                           "int_field IS NOT NULL");
+    }
+
+    OGRFeatureDefn *poDefn = new OGRFeatureDefn("test");
+    poDefn->Reference();
+    {
+        OGRFieldDefn oFieldInt("int_field", OFTInteger);
+        poDefn->AddFieldDefn(&oFieldInt);
+        OGRFieldDefn oFieldInt64("int64_field", OFTInteger64);
+        poDefn->AddFieldDefn(&oFieldInt64);
+        OGRFieldDefn oFieldReal("real_field", OFTReal);
+        poDefn->AddFieldDefn(&oFieldReal);
+        OGRFieldDefn oFieldStr("str_field", OFTString);
+        poDefn->AddFieldDefn(&oFieldStr);
+    }
+
+    std::vector<std::unique_ptr<OGRFeature>> apoFeatures;
+    apoFeatures.reserve(nFeatures);
+    for (int i = 0; i < nFeatures; ++i)
+    {
+        auto poFeature = std::make_unique<OGRFeature>(poDefn);
+        poFeature->SetFID(i);
+        if ((i % 97) != 0)
+            poFeature->SetField(0, i % 20);
+        poFeature->SetField(1, static_cast<GIntBig>(i % 1000));
+        poFeature->SetField(2, (i % 1000) / 1000.0);
+        poFeature->SetField(3, CPLSPrintf("value_%d", i % 13));
+        apoFeatures.push_back(std::move(poFeature));
+    }
+
+    for (const char *pszWhere : aosWhere)
+    {
+        double dfGeneric = 0;
+        double dfCompiled = 0;
+        const int nMatchesGeneric =
+            Evaluate(poDefn, apoFeatures, pszWhere, false, dfGeneric);
+        const int nMatchesCompiled =
+            Evaluate(poDefn, apoFeatures, pszWhere, true, dfCompiled);
+        printf("%s\n", pszWhere);
+        printf("  generic:  %.3f s, %d matches\n", dfGeneric, nMatchesGeneric);
+        printf("  compiled: %.3f s, %d matches (x%.1f)\n", dfCompiled,
+               nMatchesCompiled, dfCompiled > 0 ? dfGeneric / dfCompiled : 0);
+        if (nMatchesGeneric != nMatchesCompiled)
+        {
+            fprintf(stderr, "Mismatch in number of matches!\n");
+            exit(1);
+        }
+    }
+
+    apoFeatures.clear();
+    poDefn->Release();
+
+    CSLDestroy(argv);
+
+    return 0;
+}
@@ -38,7 +38,8 @@ static void Usage()
 {
     printf(
         "Usage: bench_ogr_c_api [-where filter] [-spat xmin ymin xmax ymax]\n");
-    printf("                       [-oo NAME=VALUE]* filename [layer_name]\n");
+    printf("                       [-oo NAME=VALUE]* [-batch]\n");
+    printf("                       filename [layer_name]\n");
     exit(1);
 }
 
@@ -60,6 +61,7 @@ int main(int argc, char *argv[])
     std::unique_ptr<OGRPolygon> poSpatialFilter;
     const char *pszLayerName = nullptr;
     CPLStringList aosOpenOptions;
+    bool bBatch = false;
     for (int iArg = 1; iArg < argc; ++iArg)
     {
         if (iArg + 1 < argc && strcmp(argv[iArg], "-where") == 0)
@@ -86,6 +88,10 @@ int main(int argc, char *argv[])
             ++iArg;
             aosOpenOptions.AddString(argv[iArg]);
         }
+        else if (strcmp(argv[iArg], "-batch") == 0)
+        {
+            bBatch = true;
+        }
         else if (argv[iArg][0] == '-')
         {
             Usage();
@@ -147,7 +153,48 @@ int main(int argc, char *argv[])
         aeTypes.push_back(OGR_Fld_GetType(OGR_FD_GetFieldDefn(hFDefn, i)));
     int nYear, nMonth, nDay, nHour, nMin, nSecond, nTZ;
     std::vector<GByte> abyWKB;
-    while (true)
+    if (bBatch)
+    {
+        // Fetch the FID, the attribute fields and the first geometry field
+        // with OGR_L_GetNextFeatureBatch()
+        constexpr int BATCH_SIZE = 1024;
+        const int nGeomFields = OGR_FD_GetGeomFieldCount(hFDefn) > 0 ? 1 : 0;
+        std::vector<OGRFeatureBatchColumn> asColumns(1 + nFields +
+                                                     nGeomFields);
+        std::vector<std::vector<GIntBig>> aanValues(asColumns.size());
+        std::vector<std::vector<size_t>> aanOffsets(asColumns.size());
+        for (size_t i = 0; i < asColumns.size(); ++i)
+        {
+            auto &sCol = asColumns[i];
+            memset(&sCol, 0, sizeof(sCol));
+            if (i == 0)
+            {
+                sCol.eType = OBC_FID;
+            }
+            else if (static_cast<int>(i) <= nFields)
+            {
+                sCol.eType = OBC_FIELD;
+                sCol.iField = static_cast<int>(i) - 1;
+            }
+            else
+            {
+                sCol.eType = OBC_GEOMETRY;
+            }
+            // GIntBig is large enough for all fixed-size values
+            aanValues[i].resize(BATCH_SIZE);
+            aanOffsets[i].resize(BATCH_SIZE + 1);
+            sCol.pValues = aanValues[i].data();
+            sCol.panOffsets = aanOffsets[i].data();
+        }
+        while (OGR_L_GetNextFeatureBatch(hLayer,
+                                         static_cast<int>(asColumns.size()),
+                                         asColumns.data(), BATCH_SIZE) > 0)
+        {
+        }
+        for (auto &sCol : asColumns)
+            VSIFree(sCol.pabyData);
+    }
+    while (!bBatch)
     {
         OGRFeatureH hFeat = OGR_L_GetNextFeature(hLayer);
         if (hFeat == nullptr)
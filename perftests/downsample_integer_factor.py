@@ -27,6 +27,11 @@ ds_float32 = gdal.GetDriverByName("MEM").Create(
 )
 ds_float32.GetRasterBand(1).Fill(32767)
 
+ds_float64 = gdal.GetDriverByName("MEM").Create(
+    "", 1024 * 10, 1024 * 10, 1, gdal.GDT_Float64
+)
+ds_float64.GetRasterBand(1).Fill(32767)
+
 NITERS = 50
 
 
@@ -127,6 +132,38 @@ def testCubic(downsampling_factor):
     )
 
 
+def testCubicFloat32(downsampling_factor):
+    ds_float32.ReadRaster(
+        buf_xsize=ds_float32.RasterXSize // downsampling_factor,
+        buf_ysize=ds_float32.RasterYSize // downsampling_factor,
+        resample_alg=gdal.GRIORA_Cubic,
+    )
+
+
+def testCubicFloat64(downsampling_factor):
+    ds_float64.ReadRaster(
+        buf_xsize=ds_float64.RasterXSize // downsampling_factor,
+        buf_ysize=ds_float64.RasterYSize // downsampling_factor,
+        resample_alg=gdal.GRIORA_Cubic,
+    )
+
+
+def testMode(downsampling_factor):
+    ds.ReadRaster(
+        buf_xsize=ds.RasterXSize // downsampling_factor,
+        buf_ysize=ds.RasterYSize // downsampling_factor,
+        resample_alg=gdal.GRIORA_Mode,
+    )
+
+
+def testModeNoData(downsampling_factor):
+    ds_nodata.ReadRaster(
+        buf_xsize=ds_nodata.RasterXSize // downsampling_factor,
+        buf_ysize=ds_nodata.RasterYSize // downsampling_factor,
+        resample_alg=gdal.GRIORA_Mode,
+    )
+
+
 print(
     "testNearUInt16(2): %.3f"
     % timeit.timeit(
@@ -237,3 +274,36 @@ print(
         "testCubic(4)", setup="from __main__ import testCubic", number=NITERS
     )
 )
+print(
+    "testCubicFloat32(2): %.3f"
+    % timeit.timeit(
+        "testCubicFloat32(2)",
+        setup="from __main__ import testCubicFloat32",
+        number=NITERS,
+    )
+)
+print(
+    "testCubicFloat64(2): %.3f"
+    % timeit.timeit(
+        "testCubicFloat64(2)",
+        setup="from __main__ import testCubicFloat64",
+        number=NITERS,
+    )
+)
+
+print(
+    "testMode(2): %.3f"
+    % timeit.timeit("testMode(2)", setup="from __main__ import testMode", number=NITERS)
+)
+print(
+    "testModeNoData(2): %.3f"
+    % timeit.timeit(
+        "testModeNoData(2)",
+        setup="from __main__ import testModeNoData",
+        number=NITERS,
+    )
+)
+print(
+    "testMode(4): %.3f"
+    % timeit.timeit("testMode(4)", setup="from __main__ import testMode", number=NITERS)
+)
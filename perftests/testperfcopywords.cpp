@@ -113,5 +113,36 @@ int main(int /* argc */, char * /* argv */[])
     }
     CPLSetConfigOption("GDAL_USE_SSSE3", nullptr);
 
+    for (int k = 0; k < 2; k++)
+    {
+        if (k == 1)
+        {
+            printf("Disabling AVX2\n");
+            CPLSetConfigOption("GDAL_USE_AVX2", "NO");
+        }
+
+        start = clock();
+        for (i = 0; i < 10000; i++)
+            GDALCopyWords(in, GDT_Float32, 4, out, GDT_Byte, 1, 256 * 256);
+        end = clock();
+        printf("packed Float32 -> packed Byte : %.2f\n",
+               (end - start) * 1.0 / CLOCKS_PER_SEC);
+
+        start = clock();
+        for (i = 0; i < 10000; i++)
+            GDALCopyWords(in, GDT_UInt16, 2, out, GDT_Float32, 4, 256 * 256);
+        end = clock();
+        printf("packed UInt16 -> packed Float32 : %.2f\n",
+               (end - start) * 1.0 / CLOCKS_PER_SEC);
+
+        start = clock();
+        for (i = 0; i < 10000; i++)
+            GDALCopyWords(in, GDT_Int16, 2, out, GDT_Float64, 8, 256 * 256);
+        end = clock();
+        printf("packed Int16 -> packed Float64 : %.2f\n",
+               (end - start) * 1.0 / CLOCKS_PER_SEC);
+    }
+    CPLSetConfigOption("GDAL_USE_AVX2", nullptr);
+
     return 0;
 }
@@ -0,0 +1,99 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  CPL - Common Portability Library
+ * Purpose:  Test performance of CPLParseXMLString() vs CPLXMLArenaTree.
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_conv.h"
+#include "cpl_minixml.h"
+#include "cpl_string.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+
+// Build a PAM-like document with many metadata items and a large VRT-like
+// list of sources, which is what makes .aux.xml and .vrt parsing slow.
+static std::string BuildDocument(int nItems)
+{
+    std::string osXML("<PAMDataset>\n  <Metadata>\n");
+    for (int i = 0; i < nItems; ++i)
+    {
+        osXML += CPLSPrintf("    <MDI key=\"KEY_%d\">value &amp; %d</MDI>\n", i,
+                            i);
+    }
+    osXML += "  </Metadata>\n  <PAMRasterBand band=\"1\">\n";
+    for (int i = 0; i < nItems; ++i)
+    {
+        osXML += CPLSPrintf(
+            "    <SimpleSource>\n"
+            "      <SourceFilename relativeToVRT=\"1\">tile_%d.tif"
+            "</SourceFilename>\n"
+            "      <SourceBand>1</SourceBand>\n"
+            "      <SrcRect xOff=\"0\" yOff=\"0\" xSize=\"256\" ySize=\"256\"/>\n"
+            "      <DstRect xOff=\"%d\" yOff=\"0\" xSize=\"256\" ySize=\"256\"/>\n"
+            "    </SimpleSource>\n",
+            i, i * 256);
+    }
+    osXML += "  </PAMRasterBand>\n</PAMDataset>\n";
+    return osXML;
+}
+
+int main(int argc, char *argv[])
+{
+    const int nItems = argc >= 2 ? atoi(argv[1]) : 100000;
+    const int nIters = argc >= 3 ? atoi(argv[2]) : 10;
+    const std::string osXML = BuildDocument(nItems);
+    printf("Document size: %d bytes\n", static_cast<int>(osXML.size()));
+
+    {
+        const auto start = clock();
+        for (int i = 0; i < nIters; ++i)
+        {
+            CPLXMLNode *psTree = CPLParseXMLString(osXML.c_str());
+            CPLGetXMLValue(psTree, "=PAMDataset.Metadata.MDI", "");
+            CPLDestroyXMLNode(psTree);
+        }
+        const auto end = clock();
+        printf("CPLParseXMLString() + CPLDestroyXMLNode(): %.2f\n",
+               (end - start) * 1.0 / CLOCKS_PER_SEC);
+    }
+
+    {
+        const auto start = clock();
+        for (int i = 0; i < nIters; ++i)
+        {
+            CPLXMLArenaTree oTree;
+            oTree.Parse(osXML.c_str());
+            CPLGetXMLValue(oTree.get(), "=PAMDataset.Metadata.MDI", "");
+        }
+        const auto end = clock();
+        printf("CPLXMLArenaTree::Parse(): %.2f\n",
+               (end - start) * 1.0 / CLOCKS_PER_SEC);
+    }
+
+    return 0;
+}
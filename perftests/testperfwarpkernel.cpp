@@ -0,0 +1,135 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  GDAL Core
+ * Purpose:  Test performance of multi-band bilinear/cubic warp kernels.
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "gdal.h"
+#include "gdal_alg.h"
+#include "gdalwarper.h"
+#include "cpl_conv.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+static GDALDatasetH CreateDataset(int nSize, int nBands, GDALDataType eDT,
+                                  bool bFill)
+{
+    GDALDriverH hDrv = GDALGetDriverByName("MEM");
+    GDALDatasetH hDS =
+        GDALCreate(hDrv, "", nSize, nSize, nBands, eDT, nullptr);
+    double adfGT[6] = {0, 1, 0, 0, 0, -1};
+    GDALSetGeoTransform(hDS, adfGT);
+    if (bFill)
+    {
+        const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+        GByte *pabyLine = static_cast<GByte *>(CPLMalloc(nSize * nDTSize));
+        for (int i = 0; i < nSize * nDTSize; i++)
+            pabyLine[i] = static_cast<GByte>(rand());
+        for (int iBand = 1; iBand <= nBands; iBand++)
+        {
+            GDALRasterBandH hBand = GDALGetRasterBand(hDS, iBand);
+            for (int iY = 0; iY < nSize; iY++)
+            {
+                CPL_IGNORE_RET_VAL(GDALRasterIO(hBand, GF_Write, 0, iY, nSize,
+                                                1, pabyLine, nSize, 1, eDT, 0,
+                                                0));
+            }
+        }
+        CPLFree(pabyLine);
+    }
+    return hDS;
+}
+
+static void Bench(int nBands, GDALDataType eDT, GDALResampleAlg eResampleAlg,
+                  const char *pszResampleAlg)
+{
+    constexpr int SIZE = 2048;
+    GDALDatasetH hSrcDS = CreateDataset(SIZE, nBands, eDT, true);
+    // Slightly shifted and scaled output grid, so that the transformer is not
+    // a translation on pixel boundaries.
+    GDALDatasetH hDstDS = CreateDataset(SIZE - 2, nBands, eDT, false);
+    double adfDstGT[6] = {0.3, 1.0001, 0, -0.3, 0, -1.0001};
+    GDALSetGeoTransform(hDstDS, adfDstGT);
+
+    GDALWarpOptions *psOptions = GDALCreateWarpOptions();
+    psOptions->hSrcDS = hSrcDS;
+    psOptions->hDstDS = hDstDS;
+    psOptions->eResampleAlg = eResampleAlg;
+    psOptions->nBandCount = nBands;
+    psOptions->panSrcBands =
+        static_cast<int *>(CPLMalloc(sizeof(int) * nBands));
+    psOptions->panDstBands =
+        static_cast<int *>(CPLMalloc(sizeof(int) * nBands));
+    for (int i = 0; i < nBands; i++)
+    {
+        psOptions->panSrcBands[i] = i + 1;
+        psOptions->panDstBands[i] = i + 1;
+    }
+    psOptions->dfWarpMemoryLimit = 1024.0 * 1024 * 1024;
+    psOptions->pTransformerArg = GDALCreateGenImgProjTransformer2(
+        hSrcDS, hDstDS, nullptr);
+    psOptions->pfnTransformer = GDALGenImgProjTransform;
+
+    GDALWarpOperation oWO;
+    oWO.Initialize(psOptions);
+    const auto start = clock();
+    for (int i = 0; i < 5; ++i)
+        oWO.ChunkAndWarpImage(0, 0, SIZE - 2, SIZE - 2);
+    const auto end = clock();
+    printf("%d band(s) %s %s : %.2f\n", nBands, GDALGetDataTypeName(eDT),
+           pszResampleAlg, (end - start) * 1.0 / CLOCKS_PER_SEC);
+
+    GDALDestroyGenImgProjTransformer(psOptions->pTransformerArg);
+    GDALDestroyWarpOptions(psOptions);
+    GDALClose(hDstDS);
+    GDALClose(hSrcDS);
+}
+
+int main(int /* argc */, char * /* argv */[])
+{
+    GDALAllRegister();
+
+    for (int k = 0; k < 2; k++)
+    {
+        if (k == 1)
+        {
+            printf("Disabling multi-band kernels\n");
+            CPLSetConfigOption("GDAL_WARP_MULTI_BAND_KERNEL", "NO");
+        }
+
+        for (GDALDataType eDT : {GDT_Byte, GDT_UInt16})
+        {
+            for (int nBands : {3, 4})
+            {
+                Bench(nBands, eDT, GRA_Bilinear, "bilinear");
+                Bench(nBands, eDT, GRA_Cubic, "cubic");
+            }
+        }
+    }
+
+    return 0;
+}
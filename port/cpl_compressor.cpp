@@ -588,8 +588,11 @@ static bool CPLLZ4Compressor(const void *input_data, size_t input_size,
             return false;
         }
 
-        int32_t sizeLSB = CPL_LSBWORD32(static_cast<int>(input_size));
-        memcpy(*output_data, &sizeLSB, sizeof(sizeLSB));
+        if (bHeader)
+        {
+            int32_t sizeLSB = CPL_LSBWORD32(static_cast<int>(input_size));
+            memcpy(*output_data, &sizeLSB, sizeof(sizeLSB));
+        }
 
         *output_size = static_cast<size_t>(header_size + ret);
         return true;
@@ -816,6 +816,104 @@ char **CSVReadParseLine3L(VSILFILE *fp, size_t nMaxLineSize,
         bKeepLeadingAndClosingQuotes, bMergeDelimiter, bSkipBOM);
 }
 
+/************************************************************************/
+/*                           CSVReadRecordL()                           */
+/************************************************************************/
+
+/** Read one record, without splitting it into fields.
+ *
+ * When bHonourStrings is true, a record spans as many lines as needed to
+ * close all double quoted strings, and those lines are joined with a
+ * newline character. The result can be split into fields with
+ * CSVSplitRecord(), possibly from another thread. The combination of both
+ * functions is equivalent to CSVReadParseLine3L().
+ *
+ * @param fp File handle. Must not be NULL
+ * @param nMaxLineSize Maximum line size, or 0 for unlimited.
+ * @param bHonourStrings Should be true, unless double quotes should not be
+ *                       considered when separating records.
+ * @param bSkipBOM Whether leading UTF-8 BOM should be skipped.
+ * @return a string to free with CPLFree(), or NULL at end of file or in case
+ * of error.
+ * @since GDAL 3.9
+ */
+char *CSVReadRecordL(VSILFILE *fp, size_t nMaxLineSize, bool bHonourStrings,
+                     bool bSkipBOM)
+{
+    const char *pszLine = ReadLineLargeFile(fp, nMaxLineSize);
+    if (pszLine == nullptr)
+        return nullptr;
+
+    if (bSkipBOM)
+    {
+        // Skip BOM.
+        const GByte *pabyData = reinterpret_cast<const GByte *>(pszLine);
+        if (pabyData[0] == 0xEF && pabyData[1] == 0xBB && pabyData[2] == 0xBF)
+            pszLine += 3;
+    }
+
+    if (!bHonourStrings || strchr(pszLine, '\"') == nullptr)
+        return CPLStrdup(pszLine);
+
+    try
+    {
+        // As long as the number of quotes is odd, keep adding new lines.
+        std::string osWorkLine(pszLine);
+        size_t nCount = static_cast<size_t>(
+            std::count(osWorkLine.begin(), osWorkLine.end(), '\"'));
+        while ((nCount % 2) != 0)
+        {
+            pszLine = ReadLineLargeFile(fp, nMaxLineSize);
+            if (pszLine == nullptr)
+                break;
+
+            const size_t nOldSize = osWorkLine.size();
+            osWorkLine.append("\n");
+            osWorkLine.append(pszLine);
+            nCount += static_cast<size_t>(std::count(
+                osWorkLine.begin() + nOldSize, osWorkLine.end(), '\"'));
+        }
+        return CPLStrdup(osWorkLine.c_str());
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+        return nullptr;
+    }
+}
+
+/************************************************************************/
+/*                           CSVSplitRecord()                           */
+/************************************************************************/
+
+/** Split a record returned by CSVReadRecordL() into fields.
+ *
+ * The return result is a stringlist, in the sense of the CSL functions.
+ * This function does not use any global state, and can be called
+ * concurrently from several threads.
+ *
+ * @param pszRecord Record. Must not be NULL
+ * @param pszDelimiter Delimiter sequence for readers (can be multiple bytes)
+ * @param bHonourStrings Should be true, unless double quotes should not be
+ *                       considered when separating fields.
+ * @param bKeepLeadingAndClosingQuotes Whether the leading and closing double
+ *                                     quote characters should be kept.
+ * @param bMergeDelimiter Whether consecutive delimiters should be considered
+ *                        as a single one. Should generally be set to false.
+ * @since GDAL 3.9
+ */
+char **CSVSplitRecord(const char *pszRecord, const char *pszDelimiter,
+                      bool bHonourStrings, bool bKeepLeadingAndClosingQuotes,
+                      bool bMergeDelimiter)
+{
+    if (!bHonourStrings)
+    {
+        return CSLTokenizeStringComplex(pszRecord, pszDelimiter, FALSE, TRUE);
+    }
+    return CSVSplitLine(pszRecord, pszDelimiter, bKeepLeadingAndClosingQuotes,
+                        bMergeDelimiter);
+}
+
 /************************************************************************/
 /*                             CSVCompare()                             */
 /*                                                                      */
@@ -43,6 +43,7 @@
 #include "cpl_http.h"
 #include "cpl_error.h"
 #include "cpl_multiproc.h"
+#include "cpl_trace.h"
 
 // gcc or clang complains about C-style cast in #define like
 // CURL_ZERO_TERMINATED
@@ -1069,6 +1070,9 @@ CPLHTTPResult *CPLHTTPFetchEx(const char *pszURL, CSLConstList papszOptions,
                               CPLHTTPFetchWriteFunc pfnWrite, void *pWriteArg)
 
 {
+    CPLTraceSpan oTraceSpan("http", "CPLHTTPFetch");
+    oTraceSpan.AddAttribute("url", pszURL);
+
     if (STARTS_WITH(pszURL, "/vsimem/") &&
         // Disabled by default for potential security issues.
         CPLTestBool(CPLGetConfigOption("CPL_CURL_ENABLE_VSIMEM", "FALSE")))
@@ -1906,6 +1910,70 @@ static int CPLHTTPCurlDebugFunction(CURL *handle, curl_infotype type,
     return 0;
 }
 
+/************************************************************************/
+/*                       CPLHTTPGetShareHandle()                        */
+/************************************************************************/
+
+// Process-wide curl share handle, so that the DNS cache and the TLS session
+// cache are shared among all curl easy handles, whatever the multi handle
+// or the thread they are used in. This avoids full TLS handshakes when
+// opening many different objects of the same server.
+// Connections themselves are not shared, since libcurl does not support
+// sharing them between concurrent threads: they are kept alive by the
+// connection cache of the multi handles.
+
+static std::mutex gShareHandleMutex;
+static CURLSH *ghShareHandle = nullptr;
+static std::array<std::mutex, CURL_LOCK_DATA_LAST> gaoShareDataMutexes;
+
+static void CPLHTTPShareLock(CURL *, curl_lock_data data, curl_lock_access,
+                             void *)
+{
+    gaoShareDataMutexes[data].lock();
+}
+
+static void CPLHTTPShareUnlock(CURL *, curl_lock_data data, void *)
+{
+    gaoShareDataMutexes[data].unlock();
+}
+
+static CURLSH *CPLHTTPGetShareHandle()
+{
+    if (!CPLTestBool(CPLGetConfigOption("CPL_CURL_SHARE_CACHES", "YES")))
+        return nullptr;
+
+    std::lock_guard<std::mutex> oLock(gShareHandleMutex);
+    if (ghShareHandle == nullptr)
+    {
+        ghShareHandle = curl_share_init();
+        if (ghShareHandle)
+        {
+            curl_share_setopt(ghShareHandle, CURLSHOPT_LOCKFUNC,
+                              CPLHTTPShareLock);
+            curl_share_setopt(ghShareHandle, CURLSHOPT_UNLOCKFUNC,
+                              CPLHTTPShareUnlock);
+            curl_share_setopt(ghShareHandle, CURLSHOPT_SHARE,
+                              CURL_LOCK_DATA_DNS);
+            curl_share_setopt(ghShareHandle, CURLSHOPT_SHARE,
+                              CURL_LOCK_DATA_SSL_SESSION);
+        }
+    }
+    return ghShareHandle;
+}
+
+/************************************************************************/
+/*                     CPLHTTPCleanupShareHandle()                      */
+/************************************************************************/
+
+static void CPLHTTPCleanupShareHandle()
+{
+    std::lock_guard<std::mutex> oLock(gShareHandleMutex);
+    // Fails with CURLSHE_IN_USE if easy handles still reference it, in
+    // which case we must leave it alive.
+    if (ghShareHandle && curl_share_cleanup(ghShareHandle) == CURLSHE_OK)
+        ghShareHandle = nullptr;
+}
+
 /************************************************************************/
 /*                         CPLHTTPSetOptions()                          */
 /************************************************************************/
@@ -1926,6 +1994,10 @@ void *CPLHTTPSetOptions(void *pcurl, const char *pszURL,
 
     unchecked_curl_easy_setopt(http_handle, CURLOPT_URL, pszURL);
 
+    CURLSH *hShareHandle = CPLHTTPGetShareHandle();
+    if (hShareHandle)
+        unchecked_curl_easy_setopt(http_handle, CURLOPT_SHARE, hShareHandle);
+
     if (CPLTestBool(CPLGetConfigOption("CPL_CURL_VERBOSE", "NO")))
     {
         unchecked_curl_easy_setopt(http_handle, CURLOPT_VERBOSE, 1);
@@ -2537,7 +2609,10 @@ void CPLHTTPCleanup()
 {
 #ifdef HAVE_CURL
     if (!hSessionMapMutex)
+    {
+        CPLHTTPCleanupShareHandle();
         return;
+    }
 
     {
         CPLMutexHolder oHolder(&hSessionMapMutex);
@@ -2565,6 +2640,8 @@ void CPLHTTPCleanup()
     CPLDestroyMutex(hSessionMapMutex);
     hSessionMapMutex = nullptr;
 
+    CPLHTTPCleanupShareHandle();
+
 #if defined(_WIN32) && defined(HAVE_OPENSSL_CRYPTO)
     // This cleanup must be absolutely done before CPLOpenSSLCleanup()
     // for some unknown reason, but otherwise X509_free() in
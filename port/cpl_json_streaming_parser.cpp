@@ -32,6 +32,7 @@
 #include <ctype.h>   // isdigit...
 #include <stdio.h>   // snprintf
 #include <string.h>  // strlen
+#include <algorithm>
 #include <vector>
 #include <string>
 
@@ -39,6 +40,77 @@
 #include "cpl_string.h"
 #include "cpl_json_streaming_parser.h"
 
+#if defined(__x86_64) || defined(_M_X64) || defined(USE_SSE2)
+#define JSON_STREAMING_PARSER_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+/************************************************************************/
+/*                        CountPlainStringChars()                       */
+/************************************************************************/
+
+/** Return the number of characters at the start of pStr (limited to nLength)
+ * that can be appended as such to a string token: that is characters that
+ * are not double quote, backslash, CR or LF.
+ * CR and LF are not valid in JSON strings, but are processed by the
+ * character-per-character path to keep line counting.
+ */
+static size_t CountPlainStringChars(const char *pStr, size_t nLength)
+{
+    size_t i = 0;
+#ifdef JSON_STREAMING_PARSER_USE_SSE2
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i lf = _mm_set1_epi8('\n');
+    for (; i + 16 <= nLength; i += 16)
+    {
+        const __m128i chars =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pStr + i));
+        const __m128i special = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chars, quote),
+                         _mm_cmpeq_epi8(chars, backslash)),
+            _mm_or_si128(_mm_cmpeq_epi8(chars, cr), _mm_cmpeq_epi8(chars, lf)));
+        const int nMask = _mm_movemask_epi8(special);
+        if (nMask != 0)
+        {
+            for (int j = 0; j < 16; ++j)
+            {
+                if (nMask & (1 << j))
+                    return i + j;
+            }
+        }
+    }
+#endif
+    for (; i < nLength; ++i)
+    {
+        const char ch = pStr[i];
+        if (ch == '"' || ch == '\\' || ch == '\r' || ch == '\n')
+            break;
+    }
+    return i;
+}
+
+/************************************************************************/
+/*                           IsNumberChar()                             */
+/************************************************************************/
+
+static inline bool IsNumberChar(char ch)
+{
+    return (ch >= '0' && ch <= '9') || ch == '.' || ch == '-' || ch == '+' ||
+           ch == 'e' || ch == 'E';
+}
+
+/************************************************************************/
+/*                              IsSpace()                               */
+/************************************************************************/
+
+// Same as isspace() in the C locale, but inlined
+static inline bool IsSpace(char ch)
+{
+    return ch == ' ' || (ch >= '\t' && ch <= '\r');
+}
+
 /************************************************************************/
 /*                       CPLJSonStreamingParser()                       */
 /************************************************************************/
@@ -117,13 +189,29 @@ void CPLJSonStreamingParser::AdvanceChar(const char *&pStr, size_t &nLength)
     m_nCharCounter++;
 }
 
+/************************************************************************/
+/*                             AdvanceChars()                           */
+/************************************************************************/
+
+/** Equivalent of calling AdvanceChar() nCount times, when the nCount
+ * characters are known not to be CR or LF. */
+void CPLJSonStreamingParser::AdvanceChars(const char *&pStr, size_t &nLength,
+                                          size_t nCount)
+{
+    CPLAssert(nCount > 0 && nCount <= nLength);
+    m_nLastChar = pStr[nCount - 1];
+    pStr += nCount;
+    nLength -= nCount;
+    m_nCharCounter += static_cast<int>(nCount);
+}
+
 /************************************************************************/
 /*                               SkipSpace()                            */
 /************************************************************************/
 
 void CPLJSonStreamingParser::SkipSpace(const char *&pStr, size_t &nLength)
 {
-    while (nLength > 0 && isspace(static_cast<unsigned char>(*pStr)))
+    while (nLength > 0 && IsSpace(*pStr))
     {
         AdvanceChar(pStr, nLength);
     }
@@ -170,8 +258,8 @@ bool CPLJSonStreamingParser::EmitUnexpectedChar(char ch,
 static bool IsValidNewToken(char ch)
 {
     return ch == '[' || ch == '{' || ch == '"' || ch == '-' || ch == '.' ||
-           isdigit(static_cast<unsigned char>(ch)) || ch == 't' || ch == 'f' ||
-           ch == 'n' || ch == 'i' || ch == 'I' || ch == 'N';
+           (ch >= '0' && ch <= '9') || ch == 't' || ch == 'f' || ch == 'n' ||
+           ch == 'i' || ch == 'I' || ch == 'N';
 }
 
 /************************************************************************/
@@ -208,9 +296,8 @@ bool CPLJSonStreamingParser::StartNewToken(const char *&pStr, size_t &nLength)
         m_aState.push_back(ARRAY);
         AdvanceChar(pStr, nLength);
     }
-    else if (ch == '-' || ch == '.' ||
-             isdigit(static_cast<unsigned char>(ch)) || ch == 'i' ||
-             ch == 'I' || ch == 'N')
+    else if (ch == '-' || ch == '.' || (ch >= '0' && ch <= '9') ||
+             ch == 'i' || ch == 'I' || ch == 'N')
     {
         m_aState.push_back(NUMBER);
     }
@@ -457,9 +544,27 @@ bool CPLJSonStreamingParser::Parse(const char *pStr, size_t nLength,
         {
             while (nLength)
             {
+                // Fast path: append at once the run of characters that are
+                // valid in a number.
+                size_t nNumberChars = 0;
+                const size_t nMaxNumberChars =
+                    std::min(nLength, 1024 - m_osToken.size());
+                while (nNumberChars < nMaxNumberChars &&
+                       IsNumberChar(pStr[nNumberChars]))
+                {
+                    ++nNumberChars;
+                }
+                if (nNumberChars > 0)
+                {
+                    m_osToken.append(pStr, nNumberChars);
+                    AdvanceChars(pStr, nLength, nNumberChars);
+                    if (nLength == 0)
+                        break;
+                }
+
                 char ch = *pStr;
                 if (ch == '+' || ch == '-' ||
-                    isdigit(static_cast<unsigned char>(ch)) || ch == '.' ||
+                    (ch >= '0' && ch <= '9') || ch == '.' ||
                     ch == 'e' || ch == 'E')
                 {
                     if (m_osToken.size() == 1024)
@@ -468,7 +573,7 @@ bool CPLJSonStreamingParser::Parse(const char *pStr, size_t nLength,
                     }
                     m_osToken += ch;
                 }
-                else if (isspace(static_cast<unsigned char>(ch)) || ch == ',' ||
+                else if (IsSpace(ch) || ch == ',' ||
                          ch == '}' || ch == ']')
                 {
                     SkipSpace(pStr, nLength);
@@ -549,6 +654,21 @@ bool CPLJSonStreamingParser::Parse(const char *pStr, size_t nLength,
                     return EmitException("Too many characters in number");
                 }
 
+                // Fast path: append at once the run of characters that do
+                // not need any specific processing.
+                if (!m_bInUnicode && !m_bInStringEscape)
+                {
+                    const size_t nPlainChars = CountPlainStringChars(
+                        pStr,
+                        std::min(nLength, m_nMaxStringSize - m_osToken.size()));
+                    if (nPlainChars > 0)
+                    {
+                        m_osToken.append(pStr, nPlainChars);
+                        AdvanceChars(pStr, nLength, nPlainChars);
+                        continue;
+                    }
+                }
+
                 char ch = *pStr;
                 if (m_bInUnicode)
                 {
@@ -868,7 +988,7 @@ bool CPLJSonStreamingParser::Parse(const char *pStr, size_t nLength,
                         return EmitUnexpectedChar(*pStr);
                     }
                 }
-                else if (isspace(static_cast<unsigned char>(ch)) || ch == ',' ||
+                else if (IsSpace(ch) || ch == ',' ||
                          ch == '}' || ch == ']')
                 {
                     SkipSpace(pStr, nLength);
@@ -260,6 +260,12 @@ class Cache
     {
         return maxSize_;
     }
+    void setMaxSize(size_t maxSize)
+    {
+        Guard g(lock_);
+        maxSize_ = maxSize;
+        prune();
+    }
     size_t getElasticity() const
     {
         return elasticity_;
@@ -47,6 +47,8 @@
 #include <cstring>
 
 #include <algorithm>
+#include <limits>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -90,10 +92,70 @@ typedef struct
 
     CPLXMLNode *psFirstNode;
     CPLXMLNode *psLastNode;
+
+    // Non-NULL when nodes must be allocated from a CPLXMLArenaTree.
+    CPLXMLArena *psArena;
 } ParseContext;
 
 static CPLXMLNode *_CPLCreateXMLNode(CPLXMLNode *poParent, CPLXMLNodeType eType,
                                      const char *pszText);
+static void _CPLAttachXMLNodeToParent(CPLXMLNode *poParent,
+                                      CPLXMLNode *psNode);
+
+/************************************************************************/
+/*                             CPLXMLArena                              */
+/*                                                                      */
+/*      Bump allocator backing CPLXMLArenaTree. Nodes and strings are   */
+/*      carved out of a few large blocks, all released at once when     */
+/*      the arena is destroyed.                                         */
+/************************************************************************/
+
+struct CPLXMLArena
+{
+    std::vector<void *> apBlocks{};
+    char *pabyCur = nullptr;
+    size_t nRemaining = 0;
+    size_t nNextBlockSize = 0;
+
+    explicit CPLXMLArena(size_t nInitialBlockSize)
+        : nNextBlockSize(std::max<size_t>(nInitialBlockSize, 1024))
+    {
+    }
+
+    ~CPLXMLArena()
+    {
+        for (void *pBlock : apBlocks)
+            VSIFree(pBlock);
+    }
+
+    void *Alloc(size_t nSize, size_t nAlign);
+
+    CPL_DISALLOW_COPY_ASSIGN(CPLXMLArena)
+};
+
+void *CPLXMLArena::Alloc(size_t nSize, size_t nAlign)
+{
+    size_t nPadding =
+        (nAlign - (reinterpret_cast<uintptr_t>(pabyCur) % nAlign)) % nAlign;
+    if (pabyCur == nullptr || nPadding + nSize > nRemaining)
+    {
+        const size_t nBlockSize = std::max(nNextBlockSize, nSize + nAlign);
+        char *pabyBlock = static_cast<char *>(VSIMalloc(nBlockSize));
+        if (pabyBlock == nullptr)
+            return nullptr;
+        apBlocks.push_back(pabyBlock);
+        pabyCur = pabyBlock;
+        nRemaining = nBlockSize;
+        if (nNextBlockSize < std::numeric_limits<size_t>::max() / 2)
+            nNextBlockSize *= 2;
+        nPadding =
+            (nAlign - (reinterpret_cast<uintptr_t>(pabyCur) % nAlign)) % nAlign;
+    }
+    void *pRet = pabyCur + nPadding;
+    pabyCur += nPadding + nSize;
+    nRemaining -= nPadding + nSize;
+    return pRet;
+}
 
 /************************************************************************/
 /*                              ReadChar()                              */
@@ -581,6 +643,51 @@ static void AttachNode(ParseContext *psContext, CPLXMLNode *psNode)
     }
 }
 
+/************************************************************************/
+/*                          CreateParsedNode()                          */
+/*                                                                      */
+/*      Create a node whose value is the current token, either on the   */
+/*      heap or in the arena of the parse context.                      */
+/************************************************************************/
+
+static CPLXMLNode *CreateParsedNode(ParseContext *psContext,
+                                    CPLXMLNode *poParent, CPLXMLNodeType eType)
+
+{
+    if (psContext->psArena == nullptr)
+        return _CPLCreateXMLNode(poParent, eType, psContext->pszToken);
+
+    CPLXMLNode *psNode = static_cast<CPLXMLNode *>(
+        psContext->psArena->Alloc(sizeof(CPLXMLNode), alignof(CPLXMLNode)));
+    const size_t nLen = strlen(psContext->pszToken);
+    char *pszValue =
+        psNode ? static_cast<char *>(psContext->psArena->Alloc(nLen + 1, 1))
+               : nullptr;
+    if (pszValue == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "Cannot allocate CPLXMLNode");
+        return nullptr;
+    }
+    memcpy(pszValue, psContext->pszToken, nLen + 1);
+
+    psNode->eType = eType;
+    psNode->pszValue = pszValue;
+    psNode->psNext = nullptr;
+    psNode->psChild = nullptr;
+
+    if (poParent != nullptr)
+        _CPLAttachXMLNodeToParent(poParent, psNode);
+
+    return psNode;
+}
+
+/************************************************************************/
+/*                     CPLParseXMLStringInternal()                      */
+/************************************************************************/
+
+static CPLXMLNode *CPLParseXMLStringInternal(const char *pszString,
+                                             CPLXMLArena *psArena);
+
 /************************************************************************/
 /*                         CPLParseXMLString()                          */
 /************************************************************************/
@@ -610,6 +717,13 @@ static void AttachNode(ParseContext *psContext, CPLXMLNode *psNode)
 
 CPLXMLNode *CPLParseXMLString(const char *pszString)
 
+{
+    return CPLParseXMLStringInternal(pszString, nullptr);
+}
+
+static CPLXMLNode *CPLParseXMLStringInternal(const char *pszString,
+                                             CPLXMLArena *psArena)
+
 {
     if (pszString == nullptr)
     {
@@ -660,6 +774,7 @@ CPLXMLNode *CPLParseXMLString(const char *pszString)
     sContext.papsStack = nullptr;
     sContext.psFirstNode = nullptr;
     sContext.psLastNode = nullptr;
+    sContext.psArena = psArena;
 
 #ifdef DEBUG
     bool bRecoverableError = true;
@@ -693,7 +808,7 @@ CPLXMLNode *CPLParseXMLString(const char *pszString)
             if (sContext.pszToken[0] != '/')
             {
                 psElement =
-                    _CPLCreateXMLNode(nullptr, CXT_Element, sContext.pszToken);
+                    CreateParsedNode(&sContext, nullptr, CXT_Element);
                 if (!psElement)
                     break;
                 AttachNode(&sContext, psElement);
@@ -781,7 +896,7 @@ CPLXMLNode *CPLParseXMLString(const char *pszString)
         else if (sContext.eTokenType == TToken)
         {
             CPLXMLNode *psAttr =
-                _CPLCreateXMLNode(nullptr, CXT_Attribute, sContext.pszToken);
+                CreateParsedNode(&sContext, nullptr, CXT_Attribute);
             if (!psAttr)
                 break;
             AttachNode(&sContext, psAttr);
@@ -839,7 +954,7 @@ CPLXMLNode *CPLParseXMLString(const char *pszString)
                 break;
             }
 
-            if (!_CPLCreateXMLNode(psAttr, CXT_Text, sContext.pszToken))
+            if (!CreateParsedNode(&sContext, psAttr, CXT_Text))
                 break;
         }
 
@@ -916,7 +1031,7 @@ CPLXMLNode *CPLParseXMLString(const char *pszString)
         else if (sContext.eTokenType == TComment)
         {
             CPLXMLNode *psValue =
-                _CPLCreateXMLNode(nullptr, CXT_Comment, sContext.pszToken);
+                CreateParsedNode(&sContext, nullptr, CXT_Comment);
             if (!psValue)
                 break;
             AttachNode(&sContext, psValue);
@@ -929,7 +1044,7 @@ CPLXMLNode *CPLParseXMLString(const char *pszString)
         else if (sContext.eTokenType == TLiteral)
         {
             CPLXMLNode *psValue =
-                _CPLCreateXMLNode(nullptr, CXT_Literal, sContext.pszToken);
+                CreateParsedNode(&sContext, nullptr, CXT_Literal);
             if (!psValue)
                 break;
             AttachNode(&sContext, psValue);
@@ -942,7 +1057,7 @@ CPLXMLNode *CPLParseXMLString(const char *pszString)
         else if (sContext.eTokenType == TString && !sContext.bInElement)
         {
             CPLXMLNode *psValue =
-                _CPLCreateXMLNode(nullptr, CXT_Text, sContext.pszToken);
+                CreateParsedNode(&sContext, nullptr, CXT_Text);
             if (!psValue)
                 break;
             AttachNode(&sContext, psValue);
@@ -999,7 +1114,9 @@ CPLXMLNode *CPLParseXMLString(const char *pszString)
     // has been set we would never get failures
     if (eLastErrorType == CE_Failure)
     {
-        CPLDestroyXMLNode(sContext.psFirstNode);
+        // Arena nodes are released by the owning CPLXMLArenaTree.
+        if (psArena == nullptr)
+            CPLDestroyXMLNode(sContext.psFirstNode);
         sContext.psFirstNode = nullptr;
         sContext.psLastNode = nullptr;
     }
@@ -1357,36 +1474,7 @@ static CPLXMLNode *_CPLCreateXMLNode(CPLXMLNode *poParent, CPLXMLNodeType eType,
     /*      Attach to parent, if provided.                                  */
     /* -------------------------------------------------------------------- */
     if (poParent != nullptr)
-    {
-        if (poParent->psChild == nullptr)
-            poParent->psChild = psNode;
-        else
-        {
-            CPLXMLNode *psLink = poParent->psChild;
-            if (psLink->psNext == nullptr && eType == CXT_Attribute &&
-                psLink->eType == CXT_Text)
-            {
-                psNode->psNext = psLink;
-                poParent->psChild = psNode;
-            }
-            else
-            {
-                while (psLink->psNext != nullptr)
-                {
-                    if (eType == CXT_Attribute &&
-                        psLink->psNext->eType == CXT_Text)
-                    {
-                        psNode->psNext = psLink->psNext;
-                        break;
-                    }
-
-                    psLink = psLink->psNext;
-                }
-
-                psLink->psNext = psNode;
-            }
-        }
-    }
+        _CPLAttachXMLNodeToParent(poParent, psNode);
 #ifdef DEBUG
     else
     {
@@ -1401,6 +1489,47 @@ static CPLXMLNode *_CPLCreateXMLNode(CPLXMLNode *poParent, CPLXMLNodeType eType,
     return psNode;
 }
 
+/************************************************************************/
+/*                     _CPLAttachXMLNodeToParent()                      */
+/************************************************************************/
+
+/* Append psNode to the children of poParent, keeping attributes before */
+/* the first text child. */
+
+static void _CPLAttachXMLNodeToParent(CPLXMLNode *poParent,
+                                      CPLXMLNode *psNode)
+
+{
+    if (poParent->psChild == nullptr)
+        poParent->psChild = psNode;
+    else
+    {
+        CPLXMLNode *psLink = poParent->psChild;
+        if (psLink->psNext == nullptr && psNode->eType == CXT_Attribute &&
+            psLink->eType == CXT_Text)
+        {
+            psNode->psNext = psLink;
+            poParent->psChild = psNode;
+        }
+        else
+        {
+            while (psLink->psNext != nullptr)
+            {
+                if (psNode->eType == CXT_Attribute &&
+                    psLink->psNext->eType == CXT_Text)
+                {
+                    psNode->psNext = psLink->psNext;
+                    break;
+                }
+
+                psLink = psLink->psNext;
+            }
+
+            psLink->psNext = psNode;
+        }
+    }
+}
+
 /************************************************************************/
 /*                         CPLDestroyXMLNode()                          */
 /************************************************************************/
@@ -2266,9 +2395,8 @@ void CPLCleanXMLElementName(char *pszTarget)
 /*            CPLXMLTreeCloser::getDocumentElement()                    */
 /************************************************************************/
 
-CPLXMLNode *CPLXMLTreeCloser::getDocumentElement()
+static CPLXMLNode *GetDocumentElement(CPLXMLNode *doc)
 {
-    CPLXMLNode *doc = get();
     // skip the Declaration and assume the next is the root element
     while (doc != nullptr &&
            (doc->eType != CXT_Element || doc->pszValue[0] == '?'))
@@ -2277,3 +2405,73 @@ CPLXMLNode *CPLXMLTreeCloser::getDocumentElement()
     }
     return doc;
 }
+
+CPLXMLNode *CPLXMLTreeCloser::getDocumentElement()
+{
+    return GetDocumentElement(get());
+}
+
+/************************************************************************/
+/*                          CPLXMLArenaTree                             */
+/************************************************************************/
+
+/** Constructor. The tree is empty until Parse() or ParseFile() succeeds. */
+CPLXMLArenaTree::CPLXMLArenaTree() = default;
+
+/** Destructor. Releases all nodes of the tree at once. */
+CPLXMLArenaTree::~CPLXMLArenaTree() = default;
+
+/**
+ * \brief Parse an XML string into an arena-backed tree.
+ *
+ * This accepts the same documents and reports the same errors as
+ * CPLParseXMLString(), but all nodes and their values are allocated from a
+ * few large blocks, which is much cheaper to build and release for big
+ * documents. Any tree previously held by this object is released.
+ *
+ * @param pszString the document to parse.
+ * @return true on success.
+ * @since GDAL 3.9
+ */
+bool CPLXMLArenaTree::Parse(const char *pszString)
+{
+    m_psRoot = nullptr;
+
+    // Nodes plus their values rarely take more than 1.5x the source text.
+    const size_t nLen = pszString ? strlen(pszString) : 0;
+    m_poArena.reset(new CPLXMLArena(nLen + nLen / 2));
+    m_psRoot = CPLParseXMLStringInternal(pszString, m_poArena.get());
+    if (m_psRoot == nullptr)
+        m_poArena.reset();
+    return m_psRoot != nullptr;
+}
+
+/**
+ * \brief Parse an XML file into an arena-backed tree.
+ *
+ * Same as CPLParseXMLFile(), but builds the tree with Parse().
+ *
+ * @param pszFilename the file to open.
+ * @return true on success.
+ * @since GDAL 3.9
+ */
+bool CPLXMLArenaTree::ParseFile(const char *pszFilename)
+{
+    m_psRoot = nullptr;
+    m_poArena.reset();
+
+    GByte *pabyOut = nullptr;
+    if (!VSIIngestFile(nullptr, pszFilename, &pabyOut, nullptr, -1))
+        return false;
+
+    const bool bRet = Parse(reinterpret_cast<const char *>(pabyOut));
+    CPLFree(pabyOut);
+    return bRet;
+}
+
+/** Returns a pointer to the document (root) element
+ * @return the node pointer */
+CPLXMLNode *CPLXMLArenaTree::getDocumentElement() const
+{
+    return GetDocumentElement(m_psRoot);
+}
@@ -216,6 +216,47 @@ extern "C++"
         CPLXMLNode *getDocumentElement();
     };
 
+    /*! @cond Doxygen_Suppress */
+    struct CPLXMLArena;
+    /*! @endcond */
+
+    /** Read-only XML tree whose nodes and values are all allocated from a
+     * few large memory blocks owned by the instance.
+     *
+     * The nodes are regular CPLXMLNode, so the navigation functions
+     * (CPLGetXMLNode(), CPLGetXMLValue(), CPLCloneXMLTree(), etc.) can be
+     * used on them. They must not be passed to CPLDestroyXMLNode() or to
+     * functions that add, remove or modify nodes. All nodes are released
+     * when the instance goes out of scope.
+     *
+     * @since GDAL 3.9
+     */
+    class CPL_DLL CPLXMLArenaTree
+    {
+      public:
+        CPLXMLArenaTree();
+        ~CPLXMLArenaTree();
+
+        bool Parse(const char *pszString);
+        bool ParseFile(const char *pszFilename);
+
+        /** Returns the first top level node, or nullptr
+         * @return the node pointer */
+        CPLXMLNode *get() const
+        {
+            return m_psRoot;
+        }
+
+        CPLXMLNode *getDocumentElement() const;
+
+      private:
+        std::unique_ptr<CPLXMLArena> m_poArena{};
+        CPLXMLNode *m_psRoot = nullptr;
+
+        CPLXMLArenaTree(const CPLXMLArenaTree &) = delete;
+        CPLXMLArenaTree &operator=(const CPLXMLArenaTree &) = delete;
+    };
+
 }  // extern "C++"
 
 #endif /* __cplusplus */
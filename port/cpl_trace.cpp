@@ -0,0 +1,577 @@
+/******************************************************************************
+ *
+ * Project:  CPL - Common Portability Library
+ * Purpose:  Lightweight tracing of I/O and CPU spans
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_trace.h"
+
+#include "cpl_conv.h"
+#include "cpl_json_streaming_writer.h"
+#include "cpl_multiproc.h"
+#include "cpl_string.h"
+#include "cpl_vsi.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+/************************************************************************/
+/*                             Trace state                              */
+/************************************************************************/
+
+namespace
+{
+struct TraceEvent
+{
+    const char *pszCategory = nullptr;
+    const char *pszName = nullptr;
+    uint64_t nSpanId = 0;
+    uint64_t nParentSpanId = 0;
+    GIntBig nThreadId = 0;
+    int64_t nStartNS = 0;
+    int64_t nEndNS = 0;
+    std::vector<CPLTraceSpan::Attribute> aoAttributes{};
+};
+
+struct TraceState
+{
+    std::mutex oMutex{};
+    std::vector<TraceEvent> aoEvents{};
+    size_t nMaxEvents = 1000 * 1000;
+    uint64_t nDroppedEvents = 0;
+    // Empty means all categories.
+    CPLStringList aosCategories{};
+    // Output file and format of CPL_TRACE_FILE.
+    std::string osExitFilename{};
+    std::string osExitFormat{};
+    // Origin of the steady clock, and matching wall clock, so that
+    // OpenTelemetry exports get absolute timestamps.
+    std::chrono::steady_clock::time_point oSteadyOrigin =
+        std::chrono::steady_clock::now();
+    int64_t nWallClockOriginNS =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    std::string osTraceId{};
+};
+}  // namespace
+
+static TraceState &GetTraceState()
+{
+    static TraceState oState;
+    return oState;
+}
+
+static std::atomic<uint64_t> gnLastSpanId{0};
+static thread_local uint64_t gnCurrentSpanId = 0;
+
+static int64_t GetElapsedNS()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() -
+               GetTraceState().oSteadyOrigin)
+        .count();
+}
+
+/************************************************************************/
+/*                            NewTraceId()                              */
+/************************************************************************/
+
+static std::string NewTraceId(const TraceState &oState)
+{
+    // Not cryptographically random, but unique enough to distinguish runs.
+    const uint64_t nHi =
+        static_cast<uint64_t>(oState.nWallClockOriginNS) ^
+        (static_cast<uint64_t>(CPLGetCurrentProcessID()) << 32);
+    const uint64_t nLo = static_cast<uint64_t>(
+        std::chrono::steady_clock::now().time_since_epoch().count());
+    return CPLSPrintf("%016" PRIx64 "%016" PRIx64, nHi, nLo | 1);
+}
+
+/************************************************************************/
+/*                         WriteTraceAtExit()                           */
+/************************************************************************/
+
+static void WriteTraceAtExit()
+{
+    auto &oState = GetTraceState();
+    if (oState.osExitFilename.empty())
+        return;
+    char *pszJSON = CPLTraceGetAsSerializedJSON(oState.osExitFormat.c_str());
+    if (!pszJSON)
+        return;
+    // The virtual file system may already be cleaned up at that point.
+    FILE *f = fopen(oState.osExitFilename.c_str(), "wb");
+    if (f)
+    {
+        fwrite(pszJSON, 1, strlen(pszJSON), f);
+        fclose(f);
+    }
+    else
+    {
+        fprintf(stderr, "Cannot write trace to %s\n",
+                oState.osExitFilename.c_str());
+    }
+    CPLFree(pszJSON);
+}
+
+/************************************************************************/
+/*                             CPLTraceSpan                             */
+/************************************************************************/
+
+int CPLTraceSpan::gnEnabled = -1;  // unknown state
+
+void CPLTraceSpan::ReadEnabled()
+{
+    auto &oState = GetTraceState();
+    const char *pszFilename = CPLGetConfigOption("CPL_TRACE_FILE", nullptr);
+    {
+        std::lock_guard<std::mutex> oLock(oState.oMutex);
+        oState.nMaxEvents = static_cast<size_t>(std::max(
+            0, atoi(CPLGetConfigOption("CPL_TRACE_MAX_EVENTS", "1000000"))));
+        oState.aosCategories = CSLTokenizeString2(
+            CPLGetConfigOption("CPL_TRACE_CATEGORIES", ""), ",", 0);
+        if (oState.osTraceId.empty())
+            oState.osTraceId = NewTraceId(oState);
+        if (pszFilename && pszFilename[0])
+        {
+            static bool bRegistered = false;
+            oState.osExitFilename = pszFilename;
+            oState.osExitFormat =
+                CPLGetConfigOption("CPL_TRACE_FORMAT", "CHROME");
+            if (!bRegistered)
+            {
+                bRegistered = true;
+                atexit(WriteTraceAtExit);
+            }
+        }
+    }
+    gnEnabled = ((pszFilename && pszFilename[0]) ||
+                 CPLTestBool(CPLGetConfigOption("CPL_TRACE", "NO")))
+                    ? TRUE
+                    : FALSE;
+}
+
+void CPLTraceSpan::Begin(const char *pszCategory, const char *pszName)
+{
+    auto &oState = GetTraceState();
+    if (!oState.aosCategories.empty() &&
+        oState.aosCategories.FindString(pszCategory) < 0)
+    {
+        return;
+    }
+    m_nSpanId = ++gnLastSpanId;
+    m_nParentSpanId = gnCurrentSpanId;
+    gnCurrentSpanId = m_nSpanId;
+    m_pszCategory = pszCategory;
+    m_pszName = pszName;
+    m_nStartNS = GetElapsedNS();
+}
+
+void CPLTraceSpan::End()
+{
+    const int64_t nEndNS = GetElapsedNS();
+    gnCurrentSpanId = m_nParentSpanId;
+
+    auto &oState = GetTraceState();
+    std::lock_guard<std::mutex> oLock(oState.oMutex);
+    if (oState.aoEvents.size() >= oState.nMaxEvents)
+    {
+        ++oState.nDroppedEvents;
+        return;
+    }
+    oState.aoEvents.emplace_back();
+    TraceEvent &oEvent = oState.aoEvents.back();
+    oEvent.pszCategory = m_pszCategory;
+    oEvent.pszName = m_pszName;
+    oEvent.nSpanId = m_nSpanId;
+    oEvent.nParentSpanId = m_nParentSpanId;
+    oEvent.nThreadId = CPLGetPID();
+    oEvent.nStartNS = m_nStartNS;
+    oEvent.nEndNS = nEndNS;
+    oEvent.aoAttributes = std::move(m_aoAttributes);
+}
+
+void CPLTraceSpan::AddAttributeInternal(const char *pszKey,
+                                        const char *pszValue)
+{
+    m_aoAttributes.emplace_back();
+    auto &oAttr = m_aoAttributes.back();
+    oAttr.osKey = pszKey;
+    oAttr.eType = Attribute::Type::STRING;
+    oAttr.osValue = pszValue;
+}
+
+void CPLTraceSpan::AddAttributeInternal(const char *pszKey, int64_t nValue)
+{
+    m_aoAttributes.emplace_back();
+    auto &oAttr = m_aoAttributes.back();
+    oAttr.osKey = pszKey;
+    oAttr.eType = Attribute::Type::INTEGER;
+    oAttr.nValue = nValue;
+}
+
+void CPLTraceSpan::AddAttributeInternal(const char *pszKey, double dfValue)
+{
+    m_aoAttributes.emplace_back();
+    auto &oAttr = m_aoAttributes.back();
+    oAttr.osKey = pszKey;
+    oAttr.eType = Attribute::Type::REAL;
+    oAttr.dfValue = dfValue;
+}
+
+/************************************************************************/
+/*                        CPLTraceIsEnabled()                           */
+/************************************************************************/
+
+/**
+ * \brief Return whether tracing is enabled.
+ *
+ * @since GDAL 3.9
+ */
+
+int CPLTraceIsEnabled(void)
+{
+    return CPLTraceSpan::IsEnabled();
+}
+
+/************************************************************************/
+/*                        CPLTraceSetEnabled()                          */
+/************************************************************************/
+
+/**
+ * \brief Enable or disable tracing.
+ *
+ * This overrides the CPL_TRACE configuration option. Other configuration
+ * options (CPL_TRACE_CATEGORIES, CPL_TRACE_MAX_EVENTS, CPL_TRACE_FILE) are
+ * still taken into account.
+ *
+ * @since GDAL 3.9
+ */
+
+void CPLTraceSetEnabled(int bEnabled)
+{
+    if (CPLTraceSpan::gnEnabled < 0)
+        CPLTraceSpan::ReadEnabled();
+    CPLTraceSpan::gnEnabled = bEnabled ? TRUE : FALSE;
+}
+
+/************************************************************************/
+/*                          CPLTraceReset()                             */
+/************************************************************************/
+
+/**
+ * \brief Discard recorded spans.
+ *
+ * The effect of CPLTraceSetEnabled() and of the CPL_TRACE configuration
+ * option will also be reset. That is, that the next span will check the
+ * configuration options again.
+ *
+ * @since GDAL 3.9
+ */
+
+void CPLTraceReset(void)
+{
+    auto &oState = GetTraceState();
+    {
+        std::lock_guard<std::mutex> oLock(oState.oMutex);
+        oState.aoEvents.clear();
+        oState.nDroppedEvents = 0;
+        oState.osTraceId = NewTraceId(oState);
+    }
+    CPLTraceSpan::gnEnabled = -1;
+}
+
+/************************************************************************/
+/*                         SerializeChrome()                            */
+/************************************************************************/
+
+static void SerializeAttributeValue(CPLJSonStreamingWriter &oWriter,
+                                    const CPLTraceSpan::Attribute &oAttr)
+{
+    switch (oAttr.eType)
+    {
+        case CPLTraceSpan::Attribute::Type::STRING:
+            oWriter.Add(oAttr.osValue);
+            break;
+        case CPLTraceSpan::Attribute::Type::INTEGER:
+            oWriter.Add(static_cast<std::int64_t>(oAttr.nValue));
+            break;
+        case CPLTraceSpan::Attribute::Type::REAL:
+            oWriter.Add(oAttr.dfValue, 17);
+            break;
+    }
+}
+
+// Chrome trace event format, as understood by chrome://tracing,
+// https://ui.perfetto.dev and speedscope: "complete" events with
+// timestamps and durations in microseconds.
+static void SerializeChrome(CPLJSonStreamingWriter &oWriter,
+                            const TraceState &oState)
+{
+    const int nPID = CPLGetCurrentProcessID();
+    auto oRoot = oWriter.MakeObjectContext();
+    oWriter.AddObjKey("traceEvents");
+    {
+        auto oEvents = oWriter.MakeArrayContext();
+        for (const auto &oEvent : oState.aoEvents)
+        {
+            auto oObj = oWriter.MakeObjectContext();
+            oWriter.AddObjKey("name");
+            oWriter.Add(oEvent.pszName);
+            oWriter.AddObjKey("cat");
+            oWriter.Add(oEvent.pszCategory);
+            oWriter.AddObjKey("ph");
+            oWriter.Add("X");
+            oWriter.AddObjKey("ts");
+            oWriter.Add(static_cast<double>(oEvent.nStartNS) / 1000, 15);
+            oWriter.AddObjKey("dur");
+            oWriter.Add(
+                static_cast<double>(oEvent.nEndNS - oEvent.nStartNS) / 1000,
+                15);
+            oWriter.AddObjKey("pid");
+            oWriter.Add(nPID);
+            oWriter.AddObjKey("tid");
+            oWriter.Add(static_cast<std::int64_t>(oEvent.nThreadId));
+            oWriter.AddObjKey("args");
+            {
+                auto oArgs = oWriter.MakeObjectContext();
+                oWriter.AddObjKey("span_id");
+                oWriter.Add(static_cast<std::uint64_t>(oEvent.nSpanId));
+                if (oEvent.nParentSpanId)
+                {
+                    oWriter.AddObjKey("parent_span_id");
+                    oWriter.Add(
+                        static_cast<std::uint64_t>(oEvent.nParentSpanId));
+                }
+                for (const auto &oAttr : oEvent.aoAttributes)
+                {
+                    oWriter.AddObjKey(oAttr.osKey);
+                    SerializeAttributeValue(oWriter, oAttr);
+                }
+            }
+        }
+    }
+    oWriter.AddObjKey("displayTimeUnit");
+    oWriter.Add("ms");
+    oWriter.AddObjKey("otherData");
+    {
+        auto oObj = oWriter.MakeObjectContext();
+        oWriter.AddObjKey("dropped_events");
+        oWriter.Add(static_cast<std::uint64_t>(oState.nDroppedEvents));
+    }
+}
+
+/************************************************************************/
+/*                          SerializeOTLP()                             */
+/************************************************************************/
+
+static void SerializeOTLPAttribute(CPLJSonStreamingWriter &oWriter,
+                                   const std::string &osKey,
+                                   const CPLTraceSpan::Attribute &oAttr)
+{
+    auto oObj = oWriter.MakeObjectContext();
+    oWriter.AddObjKey("key");
+    oWriter.Add(osKey);
+    oWriter.AddObjKey("value");
+    auto oValue = oWriter.MakeObjectContext();
+    switch (oAttr.eType)
+    {
+        case CPLTraceSpan::Attribute::Type::STRING:
+            oWriter.AddObjKey("stringValue");
+            oWriter.Add(oAttr.osValue);
+            break;
+        case CPLTraceSpan::Attribute::Type::INTEGER:
+            // 64-bit integers are encoded as strings in the protobuf
+            // JSON mapping.
+            oWriter.AddObjKey("intValue");
+            oWriter.Add(CPLSPrintf(CPL_FRMT_GIB,
+                                   static_cast<GIntBig>(oAttr.nValue)));
+            break;
+        case CPLTraceSpan::Attribute::Type::REAL:
+            oWriter.AddObjKey("doubleValue");
+            oWriter.Add(oAttr.dfValue, 17);
+            break;
+    }
+}
+
+static void SerializeOTLPAttribute(CPLJSonStreamingWriter &oWriter,
+                                   const char *pszKey, const char *pszValue)
+{
+    CPLTraceSpan::Attribute oAttr;
+    oAttr.osValue = pszValue;
+    SerializeOTLPAttribute(oWriter, pszKey, oAttr);
+}
+
+static void SerializeOTLPAttribute(CPLJSonStreamingWriter &oWriter,
+                                   const char *pszKey, GIntBig nValue)
+{
+    CPLTraceSpan::Attribute oAttr;
+    oAttr.eType = CPLTraceSpan::Attribute::Type::INTEGER;
+    oAttr.nValue = nValue;
+    SerializeOTLPAttribute(oWriter, pszKey, oAttr);
+}
+
+// OpenTelemetry protocol (OTLP) JSON encoding of an ExportTraceServiceRequest,
+// suitable for POSTing to a collector /v1/traces endpoint.
+static void SerializeOTLP(CPLJSonStreamingWriter &oWriter,
+                          const TraceState &oState)
+{
+    auto oRoot = oWriter.MakeObjectContext();
+    oWriter.AddObjKey("resourceSpans");
+    auto oResourceSpans = oWriter.MakeArrayContext();
+    auto oResourceSpan = oWriter.MakeObjectContext();
+    oWriter.AddObjKey("resource");
+    {
+        auto oResource = oWriter.MakeObjectContext();
+        oWriter.AddObjKey("attributes");
+        auto oAttrs = oWriter.MakeArrayContext();
+        SerializeOTLPAttribute(oWriter, "service.name", "gdal");
+        SerializeOTLPAttribute(oWriter, "process.pid",
+                               static_cast<GIntBig>(CPLGetCurrentProcessID()));
+    }
+    oWriter.AddObjKey("scopeSpans");
+    auto oScopeSpans = oWriter.MakeArrayContext();
+    auto oScopeSpan = oWriter.MakeObjectContext();
+    oWriter.AddObjKey("scope");
+    {
+        auto oScope = oWriter.MakeObjectContext();
+        oWriter.AddObjKey("name");
+        oWriter.Add("gdal");
+    }
+    oWriter.AddObjKey("spans");
+    auto oSpans = oWriter.MakeArrayContext();
+    for (const auto &oEvent : oState.aoEvents)
+    {
+        auto oObj = oWriter.MakeObjectContext();
+        oWriter.AddObjKey("traceId");
+        oWriter.Add(oState.osTraceId);
+        oWriter.AddObjKey("spanId");
+        oWriter.Add(CPLSPrintf("%016" PRIx64, oEvent.nSpanId));
+        if (oEvent.nParentSpanId)
+        {
+            oWriter.AddObjKey("parentSpanId");
+            oWriter.Add(CPLSPrintf("%016" PRIx64, oEvent.nParentSpanId));
+        }
+        oWriter.AddObjKey("name");
+        oWriter.Add(oEvent.pszName);
+        oWriter.AddObjKey("kind");
+        oWriter.Add(1);  // SPAN_KIND_INTERNAL
+        oWriter.AddObjKey("startTimeUnixNano");
+        oWriter.Add(CPLSPrintf(
+            CPL_FRMT_GIB,
+            static_cast<GIntBig>(oState.nWallClockOriginNS + oEvent.nStartNS)));
+        oWriter.AddObjKey("endTimeUnixNano");
+        oWriter.Add(CPLSPrintf(
+            CPL_FRMT_GIB,
+            static_cast<GIntBig>(oState.nWallClockOriginNS + oEvent.nEndNS)));
+        oWriter.AddObjKey("attributes");
+        auto oAttrs = oWriter.MakeArrayContext();
+        SerializeOTLPAttribute(oWriter, "gdal.category", oEvent.pszCategory);
+        SerializeOTLPAttribute(oWriter, "thread.id", oEvent.nThreadId);
+        for (const auto &oAttr : oEvent.aoAttributes)
+            SerializeOTLPAttribute(oWriter, oAttr.osKey, oAttr);
+    }
+}
+
+/************************************************************************/
+/*                    CPLTraceGetAsSerializedJSON()                     */
+/************************************************************************/
+
+/**
+ * \brief Return the recorded spans as a JSON string.
+ *
+ * @param pszFormat "CHROME" (or NULL) for the Chrome trace event format,
+ * that can be loaded in chrome://tracing or https://ui.perfetto.dev, or
+ * "OTLP" for the OpenTelemetry protocol JSON encoding.
+ *
+ * @return a JSON string to free with VSIFree(), or NULL in case of error.
+ * @since GDAL 3.9
+ */
+
+char *CPLTraceGetAsSerializedJSON(const char *pszFormat)
+{
+    const bool bOTLP =
+        pszFormat && (EQUAL(pszFormat, "OTLP") ||
+                      EQUAL(pszFormat, "OPENTELEMETRY"));
+    if (pszFormat && !bOTLP && !EQUAL(pszFormat, "CHROME") &&
+        pszFormat[0] != '\0')
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Unsupported trace format: %s", pszFormat);
+        return nullptr;
+    }
+
+    auto &oState = GetTraceState();
+    CPLJSonStreamingWriter oWriter(nullptr, nullptr);
+    oWriter.SetPrettyFormatting(false);
+    {
+        std::lock_guard<std::mutex> oLock(oState.oMutex);
+        if (oState.osTraceId.empty())
+            oState.osTraceId = NewTraceId(oState);
+        if (bOTLP)
+            SerializeOTLP(oWriter, oState);
+        else
+            SerializeChrome(oWriter, oState);
+    }
+    return CPLStrdup(oWriter.GetString().c_str());
+}
+
+/************************************************************************/
+/*                       CPLTraceWriteToFile()                          */
+/************************************************************************/
+
+/**
+ * \brief Write the recorded spans to a file.
+ *
+ * @param pszFilename output filename (may be a virtual file).
+ * @param pszFormat see CPLTraceGetAsSerializedJSON().
+ * @return TRUE in case of success.
+ * @since GDAL 3.9
+ */
+
+int CPLTraceWriteToFile(const char *pszFilename, const char *pszFormat)
+{
+    char *pszJSON = CPLTraceGetAsSerializedJSON(pszFormat);
+    if (!pszJSON)
+        return FALSE;
+    VSILFILE *fp = VSIFOpenL(pszFilename, "wb");
+    if (!fp)
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s", pszFilename);
+        CPLFree(pszJSON);
+        return FALSE;
+    }
+    const size_t nLen = strlen(pszJSON);
+    bool bOK = VSIFWriteL(pszJSON, 1, nLen, fp) == nLen;
+    bOK &= VSIFCloseL(fp) == 0;
+    CPLFree(pszJSON);
+    return bOK;
+}
@@ -0,0 +1,183 @@
+/******************************************************************************
+ *
+ * Project:  CPL - Common Portability Library
+ * Purpose:  Lightweight tracing of I/O and CPU spans
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef CPL_TRACE_H_INCLUDED
+#define CPL_TRACE_H_INCLUDED
+
+#include "cpl_port.h"
+
+/**
+ * \file cpl_trace.h
+ *
+ * Recording of timed spans (dataset opening, block reads, file system
+ * reads, HTTP requests, decompression, warping chunks, overview levels...)
+ * that can be exported as a Chrome trace or as OpenTelemetry (OTLP) JSON.
+ *
+ * Tracing is disabled by default, in which case a span costs a single
+ * integer comparison. It is enabled with the CPL_TRACE or CPL_TRACE_FILE
+ * configuration options, or with CPLTraceSetEnabled().
+ *
+ * @since GDAL 3.9
+ */
+
+CPL_C_START
+
+int CPL_DLL CPLTraceIsEnabled(void);
+void CPL_DLL CPLTraceSetEnabled(int bEnabled);
+void CPL_DLL CPLTraceReset(void);
+char CPL_DLL *CPLTraceGetAsSerializedJSON(const char *pszFormat);
+int CPL_DLL CPLTraceWriteToFile(const char *pszFilename,
+                                const char *pszFormat);
+
+CPL_C_END
+
+#if defined(__cplusplus) && !defined(CPL_SUPRESS_CPLUSPLUS)
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/************************************************************************/
+/*                             CPLTraceSpan                             */
+/************************************************************************/
+
+/**
+ * Scoped span: the time between construction and destruction is recorded
+ * when tracing is enabled.
+ *
+ * pszCategory and pszName must be string literals (or otherwise outlive
+ * the span). Variable information, such as filenames, must be passed with
+ * AddAttribute().
+ *
+ * @since GDAL 3.9
+ */
+class CPL_DLL CPLTraceSpan
+{
+  public:
+    inline CPLTraceSpan(const char *pszCategory, const char *pszName)
+    {
+        if (IsEnabled())
+            Begin(pszCategory, pszName);
+    }
+
+    inline ~CPLTraceSpan()
+    {
+        if (m_nSpanId)
+            End();
+    }
+
+    /** Whether this span is being recorded. Can be used to avoid computing
+     * costly attributes. */
+    inline bool IsActive() const
+    {
+        return m_nSpanId != 0;
+    }
+
+    inline void AddAttribute(const char *pszKey, const char *pszValue)
+    {
+        if (m_nSpanId)
+            AddAttributeInternal(pszKey, pszValue ? pszValue : "");
+    }
+
+    inline void AddAttribute(const char *pszKey, const std::string &osValue)
+    {
+        if (m_nSpanId)
+            AddAttributeInternal(pszKey, osValue.c_str());
+    }
+
+    inline void AddAttribute(const char *pszKey, int64_t nValue)
+    {
+        if (m_nSpanId)
+            AddAttributeInternal(pszKey, nValue);
+    }
+
+    inline void AddAttribute(const char *pszKey, int nValue)
+    {
+        if (m_nSpanId)
+            AddAttributeInternal(pszKey, static_cast<int64_t>(nValue));
+    }
+
+    inline void AddAttribute(const char *pszKey, double dfValue)
+    {
+        if (m_nSpanId)
+            AddAttributeInternal(pszKey, dfValue);
+    }
+
+    /** Whether tracing is enabled. */
+    static inline bool IsEnabled()
+    {
+        if (gnEnabled < 0)
+            ReadEnabled();
+        return gnEnabled > 0;
+    }
+
+    /*! @cond Doxygen_Suppress */
+    struct Attribute
+    {
+        enum class Type
+        {
+            STRING,
+            INTEGER,
+            REAL,
+        };
+
+        std::string osKey{};
+        Type eType = Type::STRING;
+        std::string osValue{};
+        int64_t nValue = 0;
+        double dfValue = 0;
+    };
+
+    /*! @endcond */
+
+  private:
+    static int gnEnabled;
+
+    static void ReadEnabled();
+
+    void Begin(const char *pszCategory, const char *pszName);
+    void End();
+    void AddAttributeInternal(const char *pszKey, const char *pszValue);
+    void AddAttributeInternal(const char *pszKey, int64_t nValue);
+    void AddAttributeInternal(const char *pszKey, double dfValue);
+
+    uint64_t m_nSpanId = 0;
+    uint64_t m_nParentSpanId = 0;
+    const char *m_pszCategory = nullptr;
+    const char *m_pszName = nullptr;
+    int64_t m_nStartNS = 0;
+    std::vector<Attribute> m_aoAttributes{};
+
+    friend void CPLTraceSetEnabled(int);
+    friend void CPLTraceReset(void);
+
+    CPL_DISALLOW_COPY_ASSIGN(CPLTraceSpan)
+};
+
+#endif /* __cplusplus */
+
+#endif /* CPL_TRACE_H_INCLUDED */
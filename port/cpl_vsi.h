@@ -303,6 +303,15 @@ void CPL_DLL *VSIMallocAlignedAutoVerbose(size_t nSize, const char *pszFile,
 #define VSI_MALLOC_ALIGNED_AUTO_VERBOSE(size)                                  \
     VSIMallocAlignedAutoVerbose(size, __FILE__, __LINE__)
 
+void CPL_DLL *VSIMallocLarge(size_t nSize) CPL_WARN_UNUSED_RESULT;
+void CPL_DLL VSIFreeLarge(void *ptr);
+
+void CPL_DLL *VSIMallocLargeVerbose(size_t nSize, const char *pszFile,
+                                    int nLine) CPL_WARN_UNUSED_RESULT;
+/** VSIMallocLargeVerbose() with FILE and LINE reporting */
+#define VSI_MALLOC_LARGE_VERBOSE(size)                                         \
+    VSIMallocLargeVerbose(size, __FILE__, __LINE__)
+
 /**
  VSIMalloc2 allocates (nSize1 * nSize2) bytes.
  In case of overflow of the multiplication, or if memory allocation fails, a
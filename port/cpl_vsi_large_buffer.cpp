@@ -0,0 +1,270 @@
+/******************************************************************************
+ *
+ * Project:  CPL - Common Portability Library
+ * Purpose:  Allocator for large buffers (raster block cache, warp chunks)
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "cpl_vsi.h"
+
+#include <limits>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "cpl_config.h"
+#include "cpl_conv.h"
+#include "cpl_error.h"
+#include "cpl_string.h"
+#include "cpl_virtualmem.h"
+
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
+#if defined(HAVE_MMAP) && defined(MAP_ANONYMOUS)
+#define USE_MMAP_FOR_LARGE_BUFFERS
+#endif
+
+namespace
+{
+
+// The header stored before the buffer returned to the user. Its size keeps
+// the returned buffer aligned on 64 bytes.
+constexpr size_t HEADER_SIZE = 64;
+
+// Buffers smaller than this are always allocated on the heap.
+constexpr size_t MIN_MAPPED_SIZE = 2 * 1024 * 1024;
+
+constexpr GUInt32 MAGIC_HEAP = 0x4C424848;    // "LBHH"
+constexpr GUInt32 MAGIC_MAPPED = 0x4C424D4D;  // "LBMM"
+
+struct LargeBufferHeader
+{
+    size_t nMappedSize;
+    GUInt32 nMagic;
+};
+
+static_assert(sizeof(LargeBufferHeader) <= HEADER_SIZE,
+              "sizeof(LargeBufferHeader) <= HEADER_SIZE");
+
+#ifdef USE_MMAP_FOR_LARGE_BUFFERS
+
+/* Pool of mapped buffers that have been released, indexed by their size. */
+/* Re-using them avoids the page faults of a new mapping, which is the */
+/* common case as the buffers of the block cache have often the same size. */
+struct LargeBufferPool
+{
+    std::mutex oMutex{};
+    std::map<size_t, std::vector<GByte *>> oMapFreeBuffers{};
+    size_t nPooledSize = 0;
+};
+
+LargeBufferPool &GetPool()
+{
+    // Intentionally leaked, so that buffers can be released from the
+    // destructors of other static objects.
+    static LargeBufferPool *poPool = new LargeBufferPool();
+    return *poPool;
+}
+
+size_t GetMaxPoolSize()
+{
+    // In megabytes
+    const GIntBig nPoolSizeMB = CPLAtoGIntBig(
+        CPLGetConfigOption("GDAL_LARGE_BUFFER_POOL_SIZE", "0"));
+    if (nPoolSizeMB <= 0)
+        return 0;
+    if (static_cast<GUIntBig>(nPoolSizeMB) >
+        std::numeric_limits<size_t>::max() / (1024 * 1024))
+        return std::numeric_limits<size_t>::max();
+    return static_cast<size_t>(nPoolSizeMB) * 1024 * 1024;
+}
+
+GByte *TakeFromPool(size_t nMappedSize)
+{
+    auto &oPool = GetPool();
+    std::lock_guard<std::mutex> oLock(oPool.oMutex);
+    auto oIter = oPool.oMapFreeBuffers.find(nMappedSize);
+    if (oIter == oPool.oMapFreeBuffers.end())
+        return nullptr;
+    GByte *pabyBase = oIter->second.back();
+    oIter->second.pop_back();
+    if (oIter->second.empty())
+        oPool.oMapFreeBuffers.erase(oIter);
+    oPool.nPooledSize -= nMappedSize;
+    return pabyBase;
+}
+
+bool ReturnToPool(GByte *pabyBase, size_t nMappedSize)
+{
+    const size_t nMaxPoolSize = GetMaxPoolSize();
+    auto &oPool = GetPool();
+    std::lock_guard<std::mutex> oLock(oPool.oMutex);
+    if (nMappedSize > nMaxPoolSize ||
+        oPool.nPooledSize > nMaxPoolSize - nMappedSize)
+        return false;
+    oPool.oMapFreeBuffers[nMappedSize].push_back(pabyBase);
+    oPool.nPooledSize += nMappedSize;
+    return true;
+}
+
+#endif  // USE_MMAP_FOR_LARGE_BUFFERS
+
+}  // namespace
+
+/************************************************************************/
+/*                           VSIMallocLarge()                           */
+/************************************************************************/
+
+/** Allocates a potentially large buffer, such as a buffer of the raster
+ * block cache.
+ *
+ * The returned buffer is aligned like with VSIMallocAlignedAuto(), and must
+ * be freed with VSIFreeLarge().
+ *
+ * By default, this is equivalent to VSIMallocAlignedAuto(). On platforms
+ * with mmap(), buffers of at least 2 MB may instead be directly mapped
+ * from the operating system when one of the following configuration
+ * options is set:
+ * <ul>
+ * <li>GDAL_LARGE_BUFFER_HUGE_PAGES=YES: ask the kernel to back the buffers
+ * with transparent huge pages (Linux only), to reduce TLB misses with large
+ * caches.</li>
+ * <li>GDAL_LARGE_BUFFER_POOL_SIZE=size_in_MB: keep up to that amount of
+ * memory of released buffers, to be re-used by later allocations of the
+ * same size without incurring page faults.</li>
+ * </ul>
+ *
+ * @param nSize Size of the buffer to allocate.
+ * @return a buffer of size nSize, or NULL
+ * @since GDAL 3.9
+ */
+
+void *VSIMallocLarge(size_t nSize)
+{
+    if (nSize > std::numeric_limits<size_t>::max() - HEADER_SIZE)
+        return nullptr;
+    const size_t nTotalSize = nSize + HEADER_SIZE;
+
+    GByte *pabyBase = nullptr;
+    size_t nMappedSize = 0;
+#ifdef USE_MMAP_FOR_LARGE_BUFFERS
+    if (nTotalSize >= MIN_MAPPED_SIZE)
+    {
+        const bool bHugePages = CPLTestBool(
+            CPLGetConfigOption("GDAL_LARGE_BUFFER_HUGE_PAGES", "NO"));
+        if (bHugePages || GetMaxPoolSize() > 0)
+        {
+            const size_t nPageSize = CPLGetPageSize();
+            nMappedSize = nTotalSize;
+            if (nPageSize > 0 && (nMappedSize % nPageSize) != 0)
+            {
+                if (nMappedSize > std::numeric_limits<size_t>::max() -
+                                      (nPageSize - nMappedSize % nPageSize))
+                    return nullptr;
+                nMappedSize += nPageSize - nMappedSize % nPageSize;
+            }
+            pabyBase = TakeFromPool(nMappedSize);
+            if (pabyBase == nullptr)
+            {
+                void *pMapped =
+                    mmap(nullptr, nMappedSize, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (pMapped == MAP_FAILED)
+                    return nullptr;
+#ifdef MADV_HUGEPAGE
+                if (bHugePages)
+                    madvise(pMapped, nMappedSize, MADV_HUGEPAGE);
+#endif
+                pabyBase = static_cast<GByte *>(pMapped);
+            }
+        }
+    }
+#endif
+
+    if (pabyBase == nullptr)
+    {
+        nMappedSize = 0;
+        pabyBase = static_cast<GByte *>(VSIMallocAligned(64, nTotalSize));
+        if (pabyBase == nullptr)
+            return nullptr;
+    }
+
+    LargeBufferHeader *psHeader = reinterpret_cast<LargeBufferHeader *>(
+        static_cast<void *>(pabyBase));
+    psHeader->nMappedSize = nMappedSize;
+    psHeader->nMagic = nMappedSize ? MAGIC_MAPPED : MAGIC_HEAP;
+    return pabyBase + HEADER_SIZE;
+}
+
+/************************************************************************/
+/*                       VSIMallocLargeVerbose()                        */
+/************************************************************************/
+
+/** See VSIMallocLarge() */
+void *VSIMallocLargeVerbose(size_t nSize, const char *pszFile, int nLine)
+{
+    void *pRet = VSIMallocLarge(nSize);
+    if (pRet == nullptr && nSize != 0)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "%s, %d: cannot allocate " CPL_FRMT_GUIB " bytes",
+                 pszFile ? pszFile : "(unknown file)", nLine,
+                 static_cast<GUIntBig>(nSize));
+    }
+    return pRet;
+}
+
+/************************************************************************/
+/*                            VSIFreeLarge()                            */
+/************************************************************************/
+
+/** Free a buffer allocated with VSIMallocLarge().
+ *
+ * @param ptr Buffer to free.
+ * @since GDAL 3.9
+ */
+
+void VSIFreeLarge(void *ptr)
+{
+    if (ptr == nullptr)
+        return;
+    GByte *pabyBase = static_cast<GByte *>(ptr) - HEADER_SIZE;
+    const LargeBufferHeader *psHeader =
+        reinterpret_cast<const LargeBufferHeader *>(
+            static_cast<const void *>(pabyBase));
+#ifdef USE_MMAP_FOR_LARGE_BUFFERS
+    if (psHeader->nMagic == MAGIC_MAPPED)
+    {
+        const size_t nMappedSize = psHeader->nMappedSize;
+        if (!ReturnToPool(pabyBase, nMappedSize))
+            munmap(pabyBase, nMappedSize);
+        return;
+    }
+#endif
+    CPLAssert(psHeader->nMagic == MAGIC_HEAP);
+    CPL_IGNORE_RET_VAL(psHeader);
+    VSIFreeAligned(pabyBase);
+}
@@ -41,6 +41,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 
@@ -54,6 +55,43 @@
 #undef CopyFile
 #endif
 
+/************************************************************************/
+/*                         VSIAsyncReadRequest                          */
+/************************************************************************/
+
+/** Callback invoked when an asynchronous read has completed.
+ *
+ * It is called from a worker thread, with nStatus = 0 on success and -1 on
+ * failure, before the request is reported as done.
+ *
+ * @since GDAL 3.9
+ */
+typedef void (*VSIAsyncReadCallback)(int nStatus, void *pUserData);
+
+/** Pending asynchronous read, returned by
+ * VSIVirtualHandle::ReadMultiRangeAsync().
+ *
+ * Destroying the object waits for the completion of the read.
+ *
+ * @since GDAL 3.9
+ */
+class CPL_DLL VSIAsyncReadRequest
+{
+  public:
+    virtual ~VSIAsyncReadRequest();
+
+    /** Returns whether the read has completed, without blocking. */
+    virtual bool IsDone() = 0;
+
+    /** Waits for the completion of the read.
+     *
+     * Errors raised while reading are emitted in the calling thread.
+     *
+     * @return 0 on success, -1 on failure.
+     */
+    virtual int Wait() = 0;
+};
+
 /************************************************************************/
 /*                           VSIVirtualHandle                           */
 /************************************************************************/
@@ -68,6 +106,11 @@ struct CPL_DLL VSIVirtualHandle
     virtual int ReadMultiRange(int nRanges, void **ppData,
                                const vsi_l_offset *panOffsets,
                                const size_t *panSizes);
+    virtual std::unique_ptr<VSIAsyncReadRequest>
+    ReadMultiRangeAsync(int nRanges, void **ppData,
+                        const vsi_l_offset *panOffsets, const size_t *panSizes,
+                        VSIAsyncReadCallback pfnCallback = nullptr,
+                        void *pUserData = nullptr);
 
     /** This method is called when code plans to access soon one or several
      * ranges in a file. Some file systems may be able to use this hint to
@@ -119,6 +162,12 @@ struct CPL_DLL VSIVirtualHandle
     virtual ~VSIVirtualHandle()
     {
     }
+
+  protected:
+    std::unique_ptr<VSIAsyncReadRequest> SubmitReadMultiRangeAsync(
+        int nRanges, void **ppData, const vsi_l_offset *panOffsets,
+        const size_t *panSizes, VSIAsyncReadCallback pfnCallback,
+        void *pUserData, bool bUsePRead, std::mutex *poMutex);
 };
 
 /************************************************************************/
@@ -41,6 +41,7 @@
 #endif
 
 #include <algorithm>
+#include <condition_variable>
 #include <limits>
 #include <map>
 #include <memory>
@@ -52,10 +53,13 @@
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
+#include "cpl_trace.h"
 #include "cpl_vsi_virtual.h"
 #include "cpl_vsil_curl_class.h"
+#include "cpl_worker_thread_pool.h"
 
 // To avoid aliasing to GetDiskFreeSpace to GetDiskFreeSpaceA on Windows
 #ifdef GetDiskFreeSpace
@@ -2253,6 +2257,12 @@ int VSIFFlushL(VSILFILE *fp)
 size_t VSIFReadL(void *pBuffer, size_t nSize, size_t nCount, VSILFILE *fp)
 
 {
+    CPLTraceSpan oTraceSpan("vsi", "Read");
+    if (oTraceSpan.IsActive())
+    {
+        oTraceSpan.AddAttribute("offset", static_cast<int64_t>(fp->Tell()));
+        oTraceSpan.AddAttribute("size", static_cast<int64_t>(nSize * nCount));
+    }
     return fp->Read(pBuffer, nSize, nCount);
 }
 
@@ -2312,6 +2322,15 @@ int VSIFReadMultiRangeL(int nRanges, void **ppData,
                         const vsi_l_offset *panOffsets, const size_t *panSizes,
                         VSILFILE *fp)
 {
+    CPLTraceSpan oTraceSpan("vsi", "ReadMultiRange");
+    if (oTraceSpan.IsActive())
+    {
+        size_t nTotalSize = 0;
+        for (int i = 0; i < nRanges; ++i)
+            nTotalSize += panSizes[i];
+        oTraceSpan.AddAttribute("ranges", nRanges);
+        oTraceSpan.AddAttribute("size", static_cast<int64_t>(nTotalSize));
+    }
     return fp->ReadMultiRange(nRanges, ppData, panOffsets, panSizes);
 }
 
@@ -3322,6 +3341,8 @@ void VSIFileManager::RemoveHandler(const std::string &osPrefix)
         Get()->oHandlers.erase(osPrefix);
 }
 
+static void VSIDestroyAsyncReadThreadPool();
+
 /************************************************************************/
 /*                       VSICleanupFileManager()                        */
 /************************************************************************/
@@ -3329,6 +3350,9 @@ void VSIFileManager::RemoveHandler(const std::string &osPrefix)
 void VSICleanupFileManager()
 
 {
+    // Pending asynchronous reads might still use file handles
+    VSIDestroyAsyncReadThreadPool();
+
     if (poManager)
     {
         delete poManager;
@@ -3452,3 +3476,356 @@ size_t VSIVirtualHandle::PRead(CPL_UNUSED void *pBuffer,
 {
     return 0;
 }
+
+/************************************************************************/
+/*                       ~VSIAsyncReadRequest()                         */
+/************************************************************************/
+
+VSIAsyncReadRequest::~VSIAsyncReadRequest() = default;
+
+/************************************************************************/
+/*                    VSIGetAsyncReadThreadPool()                       */
+/************************************************************************/
+
+static std::mutex goAsyncReadThreadPoolMutex;
+static std::unique_ptr<CPLWorkerThreadPool> gpoAsyncReadThreadPool;
+
+static CPLWorkerThreadPool *VSIGetAsyncReadThreadPool()
+{
+    std::lock_guard<std::mutex> oLock(goAsyncReadThreadPoolMutex);
+    if (!gpoAsyncReadThreadPool)
+    {
+        const char *pszThreads =
+            CPLGetConfigOption("CPL_VSIL_ASYNC_READ_THREADS", "ALL_CPUS");
+        const int nThreads = std::max(
+            1, std::min(128, EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                           : atoi(pszThreads)));
+        auto poPool = std::make_unique<CPLWorkerThreadPool>();
+        if (poPool->Setup(nThreads, nullptr, nullptr, false))
+            gpoAsyncReadThreadPool = std::move(poPool);
+    }
+    return gpoAsyncReadThreadPool.get();
+}
+
+/************************************************************************/
+/*                   VSIDestroyAsyncReadThreadPool()                    */
+/************************************************************************/
+
+static void VSIDestroyAsyncReadThreadPool()
+{
+    std::lock_guard<std::mutex> oLock(goAsyncReadThreadPoolMutex);
+    gpoAsyncReadThreadPool.reset();
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                   VSIThreadPoolAsyncReadRequest                      */
+/* ==================================================================== */
+/************************************************************************/
+
+namespace
+{
+class VSIThreadPoolAsyncReadRequest final : public VSIAsyncReadRequest
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSIThreadPoolAsyncReadRequest)
+
+    struct Job
+    {
+        VSIThreadPoolAsyncReadRequest *poRequest = nullptr;
+        int iStart = 0;
+        int nCount = 0;
+    };
+
+    VSIVirtualHandle *const m_poHandle;
+    std::vector<void *> m_apData;
+    std::vector<vsi_l_offset> m_anOffsets;
+    std::vector<size_t> m_anSizes;
+    const bool m_bUsePRead;
+    std::mutex *const m_poHandleMutex;
+    const VSIAsyncReadCallback m_pfnCallback;
+    void *const m_pUserData;
+    CPLStringList m_aosThreadLocalConfigOptions{};
+    std::vector<Job> m_asJobs{};
+
+    std::mutex m_oMutex{};
+    std::condition_variable m_oCV{};
+    int m_nPendingJobs = 0;
+    bool m_bDone = false;
+    bool m_bError = false;
+    bool m_bErrorsEmitted = false;
+    std::vector<CPLErrorHandlerAccumulatorStruct> m_aoErrors{};
+
+    bool ReadRanges(int iStart, int nCount);
+    void DeclareJobFinished(bool bSuccess,
+                            std::vector<CPLErrorHandlerAccumulatorStruct> &&);
+    static void JobFunc(void *pData);
+
+  public:
+    VSIThreadPoolAsyncReadRequest(VSIVirtualHandle *poHandle, int nRanges,
+                                  void **ppData,
+                                  const vsi_l_offset *panOffsets,
+                                  const size_t *panSizes,
+                                  VSIAsyncReadCallback pfnCallback,
+                                  void *pUserData, bool bUsePRead,
+                                  std::mutex *poHandleMutex);
+    ~VSIThreadPoolAsyncReadRequest() override;
+
+    void Submit(CPLWorkerThreadPool *poPool);
+
+    bool IsDone() override;
+    int Wait() override;
+};
+
+/************************************************************************/
+/*                   VSIThreadPoolAsyncReadRequest()                    */
+/************************************************************************/
+
+VSIThreadPoolAsyncReadRequest::VSIThreadPoolAsyncReadRequest(
+    VSIVirtualHandle *poHandle, int nRanges, void **ppData,
+    const vsi_l_offset *panOffsets, const size_t *panSizes,
+    VSIAsyncReadCallback pfnCallback, void *pUserData, bool bUsePRead,
+    std::mutex *poHandleMutex)
+    : m_poHandle(poHandle), m_apData(ppData, ppData + nRanges),
+      m_anOffsets(panOffsets, panOffsets + nRanges),
+      m_anSizes(panSizes, panSizes + nRanges), m_bUsePRead(bUsePRead),
+      m_poHandleMutex(poHandleMutex), m_pfnCallback(pfnCallback),
+      m_pUserData(pUserData)
+{
+    m_aosThreadLocalConfigOptions.Assign(CPLGetThreadLocalConfigOptions(),
+                                         true);
+}
+
+/************************************************************************/
+/*                  ~VSIThreadPoolAsyncReadRequest()                    */
+/************************************************************************/
+
+VSIThreadPoolAsyncReadRequest::~VSIThreadPoolAsyncReadRequest()
+{
+    // Jobs reference this object, so wait for them.
+    std::unique_lock<std::mutex> oLock(m_oMutex);
+    m_oCV.wait(oLock, [this] { return m_bDone; });
+}
+
+/************************************************************************/
+/*                               Submit()                               */
+/************************************************************************/
+
+void VSIThreadPoolAsyncReadRequest::Submit(CPLWorkerThreadPool *poPool)
+{
+    const int nRanges = static_cast<int>(m_anOffsets.size());
+    // With PRead(), ranges can be read concurrently: spread them over the
+    // worker threads. Otherwise, a single job reads them all.
+    const int nJobs =
+        m_bUsePRead && poPool
+            ? std::max(1, std::min(nRanges, poPool->GetThreadCount()))
+            : 1;
+    for (int i = 0; i < nJobs; ++i)
+    {
+        Job sJob;
+        sJob.poRequest = this;
+        sJob.iStart =
+            static_cast<int>(static_cast<GIntBig>(nRanges) * i / nJobs);
+        sJob.nCount =
+            static_cast<int>(static_cast<GIntBig>(nRanges) * (i + 1) / nJobs) -
+            sJob.iStart;
+        m_asJobs.push_back(sJob);
+    }
+    m_nPendingJobs = nJobs;
+
+    for (auto &sJob : m_asJobs)
+    {
+        if (!poPool || !poPool->SubmitJob(JobFunc, &sJob))
+        {
+            // Run synchronously if the pool is not available
+            JobFunc(&sJob);
+        }
+    }
+}
+
+/************************************************************************/
+/*                            ReadRanges()                              */
+/************************************************************************/
+
+bool VSIThreadPoolAsyncReadRequest::ReadRanges(int iStart, int nCount)
+{
+    if (nCount == 0)
+        return true;
+    if (m_bUsePRead)
+    {
+        for (int i = iStart; i < iStart + nCount; ++i)
+        {
+            if (m_poHandle->PRead(m_apData[i], m_anSizes[i], m_anOffsets[i]) !=
+                m_anSizes[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::unique_lock<std::mutex> oLock;
+    if (m_poHandleMutex)
+        oLock = std::unique_lock<std::mutex>(*m_poHandleMutex);
+    return m_poHandle->ReadMultiRange(nCount, &m_apData[iStart],
+                                      &m_anOffsets[iStart],
+                                      &m_anSizes[iStart]) == 0;
+}
+
+/************************************************************************/
+/*                              JobFunc()                               */
+/************************************************************************/
+
+void VSIThreadPoolAsyncReadRequest::JobFunc(void *pData)
+{
+    const Job *psJob = static_cast<const Job *>(pData);
+    VSIThreadPoolAsyncReadRequest *poRequest = psJob->poRequest;
+
+    CPLStringList aosOldConfigOptions(CPLGetThreadLocalConfigOptions(), true);
+    CPLSetThreadLocalConfigOptions(
+        poRequest->m_aosThreadLocalConfigOptions.List());
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors;
+    CPLInstallErrorHandlerAccumulator(aoErrors);
+
+    const bool bSuccess = poRequest->ReadRanges(psJob->iStart, psJob->nCount);
+
+    CPLUninstallErrorHandlerAccumulator();
+    CPLSetThreadLocalConfigOptions(aosOldConfigOptions.List());
+
+    poRequest->DeclareJobFinished(bSuccess, std::move(aoErrors));
+}
+
+/************************************************************************/
+/*                        DeclareJobFinished()                          */
+/************************************************************************/
+
+void VSIThreadPoolAsyncReadRequest::DeclareJobFinished(
+    bool bSuccess, std::vector<CPLErrorHandlerAccumulatorStruct> &&aoErrors)
+{
+    bool bLastJob;
+    bool bError;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        if (!bSuccess)
+            m_bError = true;
+        m_aoErrors.insert(m_aoErrors.end(), aoErrors.begin(), aoErrors.end());
+        --m_nPendingJobs;
+        bLastJob = m_nPendingJobs == 0;
+        bError = m_bError;
+    }
+    if (!bLastJob)
+        return;
+
+    if (m_pfnCallback)
+        m_pfnCallback(bError ? -1 : 0, m_pUserData);
+
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    m_bDone = true;
+    m_oCV.notify_all();
+}
+
+/************************************************************************/
+/*                              IsDone()                                */
+/************************************************************************/
+
+bool VSIThreadPoolAsyncReadRequest::IsDone()
+{
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    return m_bDone;
+}
+
+/************************************************************************/
+/*                               Wait()                                 */
+/************************************************************************/
+
+int VSIThreadPoolAsyncReadRequest::Wait()
+{
+    std::unique_lock<std::mutex> oLock(m_oMutex);
+    m_oCV.wait(oLock, [this] { return m_bDone; });
+    if (!m_bErrorsEmitted)
+    {
+        m_bErrorsEmitted = true;
+        for (const auto &oError : m_aoErrors)
+        {
+            CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+        }
+    }
+    return m_bError ? -1 : 0;
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                     SubmitReadMultiRangeAsync()                      */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+
+/* Helper for the implementations of ReadMultiRangeAsync(), that runs the
+ * read in the worker threads of the pool dedicated to asynchronous reads.
+ * If bUsePRead is true, ranges are read with PRead() and spread over several
+ * threads. Otherwise they are read with a single ReadMultiRange() call,
+ * while holding poMutex if it is not null.
+ */
+std::unique_ptr<VSIAsyncReadRequest>
+VSIVirtualHandle::SubmitReadMultiRangeAsync(
+    int nRanges, void **ppData, const vsi_l_offset *panOffsets,
+    const size_t *panSizes, VSIAsyncReadCallback pfnCallback, void *pUserData,
+    bool bUsePRead, std::mutex *poMutex)
+{
+    auto poRequest = std::make_unique<VSIThreadPoolAsyncReadRequest>(
+        this, std::max(0, nRanges), ppData, panOffsets, panSizes, pfnCallback,
+        pUserData, bUsePRead, poMutex);
+    poRequest->Submit(VSIGetAsyncReadThreadPool());
+    return poRequest;
+}
+
+//! @endcond
+
+/************************************************************************/
+/*                        ReadMultiRangeAsync()                         */
+/************************************************************************/
+
+/** Start reading several ranges of the file, without waiting for the data.
+ *
+ * The read is done in the background, and the returned object can be used to
+ * poll or wait for its completion. Once it has completed successfully, the
+ * content of each range is available in the ppData buffers, which must
+ * remain valid until then. The panOffsets and panSizes arrays are copied, and
+ * can be freed once this method has returned.
+ *
+ * While the request is pending, other methods of this handle must not be
+ * called, except ReadMultiRangeAsync() itself and, if HasPRead() returns
+ * true, PRead(). The handle must not be closed before the request has
+ * completed.
+ *
+ * The default implementation runs the reads in a process-wide pool of worker
+ * threads, whose size is defined by the CPL_VSIL_ASYNC_READ_THREADS
+ * configuration option (defaults to the number of CPUs). For handles that
+ * support PRead(), the ranges of a request are spread over the worker
+ * threads. Otherwise, the request is served with a single ReadMultiRange()
+ * call, and requests are serialized. Network file systems and local files
+ * have specific implementations, so that a request with many ranges does
+ * not need as many threads.
+ *
+ * @param nRanges Number of ranges.
+ * @param ppData Array of nRanges pointers to the destination buffers.
+ * @param panOffsets Array containing the start offset of each range.
+ * @param panSizes Array containing the size (in bytes) of each range.
+ * @param pfnCallback Function called from a worker thread when the read has
+ *                    completed, or nullptr.
+ * @param pUserData User data passed to pfnCallback.
+ * @return a new request object (never null).
+ * @since GDAL 3.9
+ */
+std::unique_ptr<VSIAsyncReadRequest> VSIVirtualHandle::ReadMultiRangeAsync(
+    int nRanges, void **ppData, const vsi_l_offset *panOffsets,
+    const size_t *panSizes, VSIAsyncReadCallback pfnCallback, void *pUserData)
+{
+    if (HasPRead())
+        return SubmitReadMultiRangeAsync(nRanges, ppData, panOffsets,
+                                         panSizes, pfnCallback, pUserData,
+                                         true, nullptr);
+    static std::mutex goMutex;
+    return SubmitReadMultiRangeAsync(nRanges, ppData, panOffsets, panSizes,
+                                     pfnCallback, pUserData, false, &goMutex);
+}
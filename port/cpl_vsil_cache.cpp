@@ -37,10 +37,14 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -71,6 +75,22 @@ class VSICachedFile final : public VSIVirtualHandle
 
     bool LoadBlocks(vsi_l_offset nStartBlock, size_t nBlockCount, void *pBuffer,
                     size_t nBufferSize);
+    bool LoadBlockRuns(
+        const std::vector<std::pair<vsi_l_offset, size_t>> &aoRuns);
+    bool LoadMissingBlocks(
+        const std::vector<std::pair<vsi_l_offset, size_t>> &aoRuns,
+        void *pBuffer, size_t nBufferSize);
+    void CollectMissingBlocks(
+        vsi_l_offset nFirstBlock, vsi_l_offset nLastBlock,
+        std::vector<std::pair<vsi_l_offset, size_t>> &aoRuns);
+    bool InsertBlocks(vsi_l_offset nStartBlock, const GByte *pabyData,
+                      size_t nDataSize);
+    size_t ReadInternal(void *pBuffer, vsi_l_offset nOffset,
+                        size_t nRequestedBytes, bool bSequential);
+
+    void UpdateCachedBytes();
+    void EvictOldestBlocks(size_t nBytesToFree);
+    void EnforceTotalCacheMax();
 
     VSIVirtualHandleUniquePtr m_poBase{};
 
@@ -83,6 +103,19 @@ class VSICachedFile final : public VSIVirtualHandle
 
     bool m_bEOF = false;
 
+    // Access pattern detection: reads starting where the previous one ended
+    // are sequential, and grow the number of blocks read ahead of them.
+    vsi_l_offset m_nLastReadEnd = std::numeric_limits<vsi_l_offset>::max();
+    size_t m_nReadAheadBlocks = 0;
+    size_t m_nMaxReadAheadBlocks = 0;
+
+    // Protects m_oCache against evictions from other handles sharing the
+    // VSI_CACHE_TOTAL_SIZE budget.
+    std::mutex m_oMutex{};
+    std::atomic<size_t> m_nCachedBytes{0};
+    size_t m_nTotalCacheMax = 0;
+    bool m_bRegistered = false;
+
     int Seek(vsi_l_offset nOffset, int nWhence) override;
     vsi_l_offset Tell() override;
     size_t Read(void *pBuffer, size_t nSize, size_t nMemb) override;
@@ -90,6 +123,16 @@ class VSICachedFile final : public VSIVirtualHandle
                        const vsi_l_offset *panOffsets,
                        const size_t *panSizes) override;
 
+    std::unique_ptr<VSIAsyncReadRequest>
+    ReadMultiRangeAsync(int nRanges, void **ppData,
+                        const vsi_l_offset *panOffsets, const size_t *panSizes,
+                        VSIAsyncReadCallback pfnCallback,
+                        void *pUserData) override
+    {
+        return m_poBase->ReadMultiRangeAsync(nRanges, ppData, panOffsets,
+                                             panSizes, pfnCallback, pUserData);
+    }
+
     void AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
                     const size_t *panSizes) override
     {
@@ -131,6 +174,53 @@ static size_t GetCacheMax(size_t nCacheSize)
                                            40)));
 }
 
+/************************************************************************/
+/*                         GetTotalCacheMax()                           */
+/************************************************************************/
+
+static size_t GetTotalCacheMax()
+{
+    return static_cast<size_t>(
+        std::min(static_cast<GUIntBig>(std::numeric_limits<size_t>::max() / 2),
+                 CPLScanUIntBig(
+                     CPLGetConfigOption("VSI_CACHE_TOTAL_SIZE", "0"), 40)));
+}
+
+/************************************************************************/
+/*                        GetMaxReadAheadSize()                         */
+/************************************************************************/
+
+static size_t GetMaxReadAheadSize()
+{
+    return static_cast<size_t>(
+        std::min(static_cast<GUIntBig>(std::numeric_limits<size_t>::max() / 2),
+                 CPLScanUIntBig(
+                     CPLGetConfigOption("VSI_CACHE_MAX_READAHEAD", "1048576"),
+                     40)));
+}
+
+/************************************************************************/
+/*                       VSICachedFileRegistry                          */
+/*                                                                      */
+/*      Handles sharing the VSI_CACHE_TOTAL_SIZE budget.                */
+/************************************************************************/
+
+namespace
+{
+struct VSICachedFileRegistry
+{
+    std::mutex oMutex{};
+    std::set<VSICachedFile *> oSetHandles{};
+    std::atomic<size_t> nTotalCachedBytes{0};
+};
+}  // namespace
+
+static VSICachedFileRegistry &GetRegistry()
+{
+    static VSICachedFileRegistry oRegistry;
+    return oRegistry;
+}
+
 /************************************************************************/
 /*                           DIV_ROUND_UP()                             */
 /************************************************************************/
@@ -148,10 +238,25 @@ VSICachedFile::VSICachedFile(VSIVirtualHandle *poBaseHandle, size_t nChunkSize,
                              size_t nCacheSize)
     : m_poBase(poBaseHandle),
       m_nChunkSize(nChunkSize ? nChunkSize : VSI_CACHED_DEFAULT_CHUNK_SIZE),
-      m_oCache{DIV_ROUND_UP(GetCacheMax(nCacheSize), m_nChunkSize), 0}
+      m_oCache{DIV_ROUND_UP(GetCacheMax(nCacheSize), m_nChunkSize), 0},
+      m_nTotalCacheMax(GetTotalCacheMax())
 {
     m_poBase->Seek(0, SEEK_END);
     m_nFileSize = m_poBase->Tell();
+
+    // Do not read ahead more than a quarter of the cache, so that blocks
+    // read ahead do not evict the ones being used.
+    m_nMaxReadAheadBlocks =
+        std::min(GetMaxReadAheadSize() / m_nChunkSize,
+                 m_oCache.getMaxSize() / 4);
+
+    if (m_nTotalCacheMax > 0)
+    {
+        auto &oRegistry = GetRegistry();
+        std::lock_guard<std::mutex> oLock(oRegistry.oMutex);
+        oRegistry.oSetHandles.insert(this);
+        m_bRegistered = true;
+    }
 }
 
 /************************************************************************/
@@ -161,12 +266,117 @@ VSICachedFile::VSICachedFile(VSIVirtualHandle *poBaseHandle, size_t nChunkSize,
 int VSICachedFile::Close()
 
 {
-    m_oCache.clear();
-    m_poBase.reset();
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_oCache.clear();
+        UpdateCachedBytes();
+        m_poBase.reset();
+    }
+
+    if (m_bRegistered)
+    {
+        auto &oRegistry = GetRegistry();
+        std::lock_guard<std::mutex> oLock(oRegistry.oMutex);
+        oRegistry.oSetHandles.erase(this);
+        m_bRegistered = false;
+    }
 
     return 0;
 }
 
+/************************************************************************/
+/*                         UpdateCachedBytes()                          */
+/*                                                                      */
+/*      Must be called with m_oMutex held after the cache content       */
+/*      changed.                                                        */
+/************************************************************************/
+
+void VSICachedFile::UpdateCachedBytes()
+{
+    const size_t nNewCachedBytes = m_oCache.size() * m_nChunkSize;
+    const size_t nOldCachedBytes = m_nCachedBytes.exchange(nNewCachedBytes);
+    if (m_bRegistered)
+    {
+        auto &oRegistry = GetRegistry();
+        if (nNewCachedBytes >= nOldCachedBytes)
+            oRegistry.nTotalCachedBytes += nNewCachedBytes - nOldCachedBytes;
+        else
+            oRegistry.nTotalCachedBytes -= nOldCachedBytes - nNewCachedBytes;
+    }
+}
+
+/************************************************************************/
+/*                         EvictOldestBlocks()                          */
+/************************************************************************/
+
+void VSICachedFile::EvictOldestBlocks(size_t nBytesToFree)
+{
+    cpl::NonCopyableVector<GByte> oData;
+    size_t nFreed = 0;
+    while (nFreed < nBytesToFree && m_oCache.removeAndRecycleOldestEntry(oData))
+    {
+        nFreed += m_nChunkSize;
+    }
+    UpdateCachedBytes();
+}
+
+/************************************************************************/
+/*                        EnforceTotalCacheMax()                        */
+/*                                                                      */
+/*      Evict blocks, starting with the handles with the largest        */
+/*      cache, until the cache of all handles fits within               */
+/*      VSI_CACHE_TOTAL_SIZE. Handles in use by another thread are      */
+/*      skipped. Must be called with m_oMutex held.                     */
+/************************************************************************/
+
+void VSICachedFile::EnforceTotalCacheMax()
+{
+    if (!m_bRegistered)
+        return;
+    UpdateCachedBytes();
+
+    auto &oRegistry = GetRegistry();
+    if (oRegistry.nTotalCachedBytes <= m_nTotalCacheMax)
+        return;
+
+    std::lock_guard<std::mutex> oLock(oRegistry.oMutex);
+    std::set<VSICachedFile *> oSetSkipped;
+    while (true)
+    {
+        const size_t nTotalCachedBytes = oRegistry.nTotalCachedBytes;
+        if (nTotalCachedBytes <= m_nTotalCacheMax)
+            break;
+
+        VSICachedFile *poVictim = nullptr;
+        for (auto *poHandle : oRegistry.oSetHandles)
+        {
+            if (poHandle->m_nCachedBytes == 0 ||
+                oSetSkipped.find(poHandle) != oSetSkipped.end())
+                continue;
+            if (!poVictim ||
+                poHandle->m_nCachedBytes > poVictim->m_nCachedBytes)
+                poVictim = poHandle;
+        }
+        if (!poVictim)
+            break;
+
+        const size_t nExcess = nTotalCachedBytes - m_nTotalCacheMax;
+        if (poVictim == this)
+        {
+            EvictOldestBlocks(nExcess);
+        }
+        else if (poVictim->m_oMutex.try_lock())
+        {
+            poVictim->EvictOldestBlocks(nExcess);
+            poVictim->m_oMutex.unlock();
+        }
+        else
+        {
+            oSetSkipped.insert(poVictim);
+        }
+    }
+}
+
 /************************************************************************/
 /*                                Seek()                                */
 /************************************************************************/
@@ -303,19 +513,36 @@ bool VSICachedFile::LoadBlocks(vsi_l_offset nStartBlock, size_t nBlockCount,
         }
     }
 
-    for (size_t i = 0; i < nBlockCount; i++)
+    if (!InsertBlocks(nStartBlock, pabyWorkBuffer,
+                      std::min(nDataRead, nBlockCount * m_nChunkSize)))
+        ret = false;
+
+    if (pabyWorkBuffer != pBuffer)
+        CPLFree(pabyWorkBuffer);
+
+    return ret;
+}
+
+/************************************************************************/
+/*                            InsertBlocks()                            */
+/*                                                                      */
+/*      Split data read from the start of a block into cached blocks.   */
+/************************************************************************/
+
+bool VSICachedFile::InsertBlocks(vsi_l_offset nStartBlock,
+                                 const GByte *pabyData, size_t nDataSize)
+{
+    for (size_t i = 0; i * m_nChunkSize < nDataSize; i++)
     {
         const vsi_l_offset iBlock = nStartBlock + i;
 
-        const auto nDataFilled = (nDataRead >= (i + 1) * m_nChunkSize)
-                                     ? m_nChunkSize
-                                     : nDataRead - i * m_nChunkSize;
+        const auto nDataFilled =
+            std::min(m_nChunkSize, nDataSize - i * m_nChunkSize);
         try
         {
             cpl::NonCopyableVector<GByte> oData(nDataFilled);
 
-            memcpy(oData.data(), pabyWorkBuffer + i * m_nChunkSize,
-                   nDataFilled);
+            memcpy(oData.data(), pabyData + i * m_nChunkSize, nDataFilled);
 
             m_oCache.insert(iBlock, std::move(oData));
         }
@@ -323,15 +550,133 @@ bool VSICachedFile::LoadBlocks(vsi_l_offset nStartBlock, size_t nBlockCount,
         {
             CPLError(CE_Failure, CPLE_OutOfMemory,
                      "Out of memory situation in VSICachedFile::LoadBlocks()");
-            ret = false;
-            break;
+            return false;
         }
     }
+    return true;
+}
 
-    if (pabyWorkBuffer != pBuffer)
-        CPLFree(pabyWorkBuffer);
+/************************************************************************/
+/*                           LoadBlockRuns()                            */
+/*                                                                      */
+/*      Load several runs of consecutive blocks with a single           */
+/*      ReadMultiRange() call on the underlying handle, so that network */
+/*      file systems can fetch them in parallel.                        */
+/************************************************************************/
 
-    return ret;
+bool VSICachedFile::LoadBlockRuns(
+    const std::vector<std::pair<vsi_l_offset, size_t>> &aoRuns)
+{
+    std::vector<std::pair<vsi_l_offset, size_t>> aoRunsToRead;
+    std::vector<cpl::NonCopyableVector<GByte>> aoBuffers;
+    std::vector<void *> apData;
+    std::vector<vsi_l_offset> anOffsets;
+    std::vector<size_t> anSizes;
+    try
+    {
+        for (const auto &oRun : aoRuns)
+        {
+            const vsi_l_offset nOffset =
+                static_cast<vsi_l_offset>(oRun.first) * m_nChunkSize;
+            // ReadMultiRange() fails on ranges extending beyond end of file
+            if (nOffset >= m_nFileSize)
+                continue;
+            const size_t nSize = static_cast<size_t>(std::min(
+                static_cast<vsi_l_offset>(oRun.second * m_nChunkSize),
+                m_nFileSize - nOffset));
+            aoRunsToRead.push_back(oRun);
+            aoBuffers.emplace_back(nSize);
+            anOffsets.push_back(nOffset);
+            anSizes.push_back(nSize);
+        }
+        for (auto &oBuffer : aoBuffers)
+            apData.push_back(oBuffer.data());
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory situation in VSICachedFile::LoadBlockRuns()");
+        return false;
+    }
+    if (apData.empty())
+        return false;
+
+    if (m_poBase->ReadMultiRange(static_cast<int>(apData.size()),
+                                 apData.data(), anOffsets.data(),
+                                 anSizes.data()) != 0)
+    {
+        // Fall back to reading runs one at a time
+        bool ret = true;
+        for (const auto &oRun : aoRunsToRead)
+        {
+            if (!LoadBlocks(oRun.first, oRun.second, nullptr, 0))
+                ret = false;
+        }
+        return ret;
+    }
+
+    for (size_t i = 0; i < aoRunsToRead.size(); ++i)
+    {
+        if (!InsertBlocks(aoRunsToRead[i].first, aoBuffers[i].data(),
+                          anSizes[i]))
+            return false;
+    }
+    return aoRunsToRead.size() == aoRuns.size();
+}
+
+/************************************************************************/
+/*                         LoadMissingBlocks()                          */
+/************************************************************************/
+
+bool VSICachedFile::LoadMissingBlocks(
+    const std::vector<std::pair<vsi_l_offset, size_t>> &aoRuns,
+    void *pBuffer, size_t nBufferSize)
+{
+    if (aoRuns.empty())
+        return true;
+    // The file size is needed to issue ReadMultiRange() requests that do
+    // not extend beyond end of file.
+    if (aoRuns.size() == 1 || m_nFileSize == 0)
+    {
+        bool ret = true;
+        for (const auto &oRun : aoRuns)
+        {
+            if (!LoadBlocks(oRun.first, oRun.second, pBuffer, nBufferSize))
+            {
+                ret = false;
+                break;
+            }
+        }
+        return ret;
+    }
+    return LoadBlockRuns(aoRuns);
+}
+
+/************************************************************************/
+/*                        CollectMissingBlocks()                        */
+/*                                                                      */
+/*      Append the runs of consecutive blocks in [nFirstBlock,          */
+/*      nLastBlock] that are not cached to aoRuns.                      */
+/************************************************************************/
+
+void VSICachedFile::CollectMissingBlocks(
+    vsi_l_offset nFirstBlock, vsi_l_offset nLastBlock,
+    std::vector<std::pair<vsi_l_offset, size_t>> &aoRuns)
+{
+    for (vsi_l_offset iBlock = nFirstBlock; iBlock <= nLastBlock; iBlock++)
+    {
+        if (m_oCache.contains(iBlock))
+            continue;
+        if (!aoRuns.empty() &&
+            aoRuns.back().first + aoRuns.back().second == iBlock)
+        {
+            aoRuns.back().second++;
+        }
+        else
+        {
+            aoRuns.emplace_back(iBlock, 1);
+        }
+    }
 }
 
 /************************************************************************/
@@ -353,29 +698,65 @@ size_t VSICachedFile::Read(void *pBuffer, size_t nSize, size_t nCount)
         return 0;
     }
 
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+
+    const bool bSequential = m_nOffset == m_nLastReadEnd;
+    if (!bSequential)
+        m_nReadAheadBlocks = 0;
+
+    const size_t nAmountCopied =
+        ReadInternal(pBuffer, m_nOffset, nRequestedBytes, bSequential);
+
+    m_nOffset += nAmountCopied;
+    m_nLastReadEnd = m_nOffset;
+
+    EnforceTotalCacheMax();
+
+    const size_t nRet = nAmountCopied / nSize;
+    if (nRet != nCount)
+        m_bEOF = true;
+    return nRet;
+}
+
+/************************************************************************/
+/*                            ReadInternal()                            */
+/*                                                                      */
+/*      Read nRequestedBytes at nOffset through the cache, and return   */
+/*      the number of bytes read. Must be called with m_oMutex held.    */
+/************************************************************************/
+
+size_t VSICachedFile::ReadInternal(void *pBuffer, vsi_l_offset nOffset,
+                                   size_t nRequestedBytes, bool bSequential)
+{
     /* ==================================================================== */
     /*      Make sure the cache is loaded for the whole request region.     */
     /* ==================================================================== */
-    const vsi_l_offset nStartBlock = m_nOffset / m_nChunkSize;
+    const vsi_l_offset nStartBlock = nOffset / m_nChunkSize;
     const vsi_l_offset nEndBlock =
-        (m_nOffset + nRequestedBytes - 1) / m_nChunkSize;
+        (nOffset + nRequestedBytes - 1) / m_nChunkSize;
 
-    for (vsi_l_offset iBlock = nStartBlock; iBlock <= nEndBlock; iBlock++)
-    {
-        if (!m_oCache.contains(iBlock))
-        {
-            size_t nBlocksToLoad = 1;
-            while (iBlock + nBlocksToLoad <= nEndBlock &&
-                   !m_oCache.contains(iBlock + nBlocksToLoad))
-            {
-                nBlocksToLoad++;
-            }
+    std::vector<std::pair<vsi_l_offset, size_t>> aoRuns;
+    CollectMissingBlocks(nStartBlock, nEndBlock, aoRuns);
 
-            if (!LoadBlocks(iBlock, nBlocksToLoad, pBuffer, nRequestedBytes))
-                break;
-        }
+    /* -------------------------------------------------------------------- */
+    /*      On a cache miss during a sequential scan, read ahead of the     */
+    /*      request, doubling the read-ahead size at each miss. Random      */
+    /*      reads only load the blocks they need.                           */
+    /* -------------------------------------------------------------------- */
+    if (!aoRuns.empty() && bSequential && m_nMaxReadAheadBlocks > 0)
+    {
+        m_nReadAheadBlocks =
+            std::min(m_nMaxReadAheadBlocks,
+                     std::max<size_t>(1, 2 * m_nReadAheadBlocks));
+        vsi_l_offset nLastBlock = nEndBlock + m_nReadAheadBlocks;
+        if (m_nFileSize > 0)
+            nLastBlock = std::min(nLastBlock, (m_nFileSize - 1) / m_nChunkSize);
+        if (nLastBlock > nEndBlock)
+            CollectMissingBlocks(nEndBlock + 1, nLastBlock, aoRuns);
     }
 
+    LoadMissingBlocks(aoRuns, pBuffer, nRequestedBytes);
+
     /* ==================================================================== */
     /*      Copy data into the target buffer to the extent possible.        */
     /* ==================================================================== */
@@ -383,7 +764,7 @@ size_t VSICachedFile::Read(void *pBuffer, size_t nSize, size_t nCount)
 
     while (nAmountCopied < nRequestedBytes)
     {
-        const vsi_l_offset iBlock = (m_nOffset + nAmountCopied) / m_nChunkSize;
+        const vsi_l_offset iBlock = (nOffset + nAmountCopied) / m_nChunkSize;
         const cpl::NonCopyableVector<GByte> *poData = m_oCache.getPtr(iBlock);
         if (poData == nullptr)
         {
@@ -400,28 +781,23 @@ size_t VSICachedFile::Read(void *pBuffer, size_t nSize, size_t nCount)
 
         const vsi_l_offset nStartOffset =
             static_cast<vsi_l_offset>(iBlock) * m_nChunkSize;
-        if (nStartOffset + poData->size() < nAmountCopied + m_nOffset)
+        if (nStartOffset + poData->size() < nAmountCopied + nOffset)
             break;
         const size_t nThisCopy =
             std::min(nRequestedBytes - nAmountCopied,
                      static_cast<size_t>(((nStartOffset + poData->size()) -
-                                          nAmountCopied - m_nOffset)));
+                                          nAmountCopied - nOffset)));
         if (nThisCopy == 0)
             break;
 
         memcpy(static_cast<GByte *>(pBuffer) + nAmountCopied,
-               poData->data() + (m_nOffset + nAmountCopied) - nStartOffset,
+               poData->data() + (nOffset + nAmountCopied) - nStartOffset,
                nThisCopy);
 
         nAmountCopied += nThisCopy;
     }
 
-    m_nOffset += nAmountCopied;
-
-    const size_t nRet = nAmountCopied / nSize;
-    if (nRet != nCount)
-        m_bEOF = true;
-    return nRet;
+    return nAmountCopied;
 }
 
 /************************************************************************/
@@ -432,8 +808,66 @@ int VSICachedFile::ReadMultiRange(int const nRanges, void **const ppData,
                                   const vsi_l_offset *const panOffsets,
                                   const size_t *const panSizes)
 {
-    // If the base is /vsicurl/
-    return m_poBase->ReadMultiRange(nRanges, ppData, panOffsets, panSizes);
+    // Requests that would evict a large part of the cache are forwarded to
+    // the underlying handle (which may be /vsicurl/)
+    const size_t nMaxCachedRequest = m_oCache.getMaxSize() / 2 * m_nChunkSize;
+    size_t nTotalSize = 0;
+    for (int i = 0; i < nRanges; ++i)
+    {
+        if (panSizes[i] > nMaxCachedRequest - nTotalSize)
+            return m_poBase->ReadMultiRange(nRanges, ppData, panOffsets,
+                                            panSizes);
+        nTotalSize += panSizes[i];
+    }
+
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+
+    // Load all missing blocks at once, so that they are fetched with a
+    // single ReadMultiRange() call on the underlying handle.
+    std::set<vsi_l_offset> oSetMissingBlocks;
+    for (int i = 0; i < nRanges; ++i)
+    {
+        if (panSizes[i] == 0)
+            continue;
+        const vsi_l_offset nEndBlock =
+            (panOffsets[i] + panSizes[i] - 1) / m_nChunkSize;
+        for (vsi_l_offset iBlock = panOffsets[i] / m_nChunkSize;
+             iBlock <= nEndBlock; ++iBlock)
+        {
+            if (!m_oCache.contains(iBlock))
+                oSetMissingBlocks.insert(iBlock);
+        }
+    }
+    std::vector<std::pair<vsi_l_offset, size_t>> aoRuns;
+    for (const vsi_l_offset iBlock : oSetMissingBlocks)
+    {
+        if (!aoRuns.empty() &&
+            aoRuns.back().first + aoRuns.back().second == iBlock)
+        {
+            aoRuns.back().second++;
+        }
+        else
+        {
+            aoRuns.emplace_back(iBlock, 1);
+        }
+    }
+    LoadMissingBlocks(aoRuns, nullptr, 0);
+
+    int nRet = 0;
+    for (int i = 0; i < nRanges; ++i)
+    {
+        if (panSizes[i] > 0 &&
+            ReadInternal(ppData[i], panOffsets[i], panSizes[i],
+                         /* bSequential = */ false) != panSizes[i])
+        {
+            nRet = -1;
+            break;
+        }
+    }
+
+    EnforceTotalCacheMax();
+
+    return nRet;
 }
 
 /************************************************************************/
@@ -682,6 +1116,10 @@ char **VSICachedFilesystemHandler::ReadDirEx(const char *pszDirname,
  * read-operations on the input file handle. The cache is RAM based and
  * the content of the cache is discarded when the file handle is closed.
  * The cache is a least-recently used lists of blocks of 32KB each.
+ * Sequential reads trigger reading ahead, up to the value of the
+ * VSI_CACHE_MAX_READAHEAD configuration option, and the total size of the
+ * caches of all files is limited by the VSI_CACHE_TOTAL_SIZE configuration
+ * option (GDAL >= 3.9).
  *
  * @param poBaseHandle base handle
  * @param nChunkSize chunk size, in bytes. If 0, defaults to 32 KB
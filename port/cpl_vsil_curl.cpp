@@ -32,6 +32,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <set>
 #include <map>
 #include <memory>
@@ -41,8 +42,10 @@
 #include "cpl_json_header.h"
 #include "cpl_minixml.h"
 #include "cpl_multiproc.h"
+#include "cpl_sha256.h"
 #include "cpl_string.h"
 #include "cpl_time.h"
+#include "cpl_trace.h"
 #include "cpl_vsi.h"
 #include "cpl_vsi_virtual.h"
 #include "cpl_http.h"
@@ -466,7 +469,8 @@ VSICurlHandle::VSICurlHandle(VSICurlFilesystemHandlerBase *poFSIn,
     }
 
     m_bCached = poFSIn->AllowCachedDataFor(pszFilename);
-    poFS->GetCachedFileProp(m_pszURL, oFileProp);
+    if (poFS->GetCachedFileProp(m_pszURL, oFileProp))
+        NetworkStatisticsLogger::LogFilePropCacheHit();
 }
 
 /************************************************************************/
@@ -811,6 +815,24 @@ static GIntBig VSICurlGetExpiresFromS3LikeSignedURL(const char *pszURL)
     return CPLYMDHMSToUnixTime(&brokendowntime) + nDelay;
 }
 
+/************************************************************************/
+/*                       VSICURLLogConnection()                         */
+/************************************************************************/
+
+// Records in the network statistics whether a completed transfer had to
+// establish a new connection, or could reuse an existing one.
+void VSICURLLogConnection(CURL *hEasyHandle)
+{
+    if (!NetworkStatisticsLogger::IsEnabled())
+        return;
+    long nNumConnects = 0;
+    if (curl_easy_getinfo(hEasyHandle, CURLINFO_NUM_CONNECTS, &nNumConnects) ==
+        CURLE_OK)
+    {
+        NetworkStatisticsLogger::LogConnection(nNumConnects > 0);
+    }
+}
+
 /************************************************************************/
 /*                           MultiPerform()                             */
 /************************************************************************/
@@ -819,6 +841,8 @@ void MultiPerform(CURLM *hCurlMultiHandle, CURL *hEasyHandle)
 {
     int repeats = 0;
 
+    CPLTraceSpan oTraceSpan("http", "Request");
+
     if (hEasyHandle)
         curl_multi_add_handle(hCurlMultiHandle, hEasyHandle);
 
@@ -836,7 +860,14 @@ void MultiPerform(CURLM *hCurlMultiHandle, CURL *hEasyHandle)
             break;
         }
 
-#ifdef undef
+        CPLMultiPerformWait(hCurlMultiHandle, repeats);
+    }
+    CPLHTTPRestoreSigPipeHandler(old_handler);
+
+    if (NetworkStatisticsLogger::IsEnabled() || oTraceSpan.IsActive())
+    {
+        int nRequests = 0;
+        curl_off_t nDownloadedBytes = 0;
         CURLMsg *msg;
         do
         {
@@ -844,14 +875,36 @@ void MultiPerform(CURLM *hCurlMultiHandle, CURL *hEasyHandle)
             msg = curl_multi_info_read(hCurlMultiHandle, &msgq);
             if (msg && (msg->msg == CURLMSG_DONE))
             {
-                CURL *e = msg->easy_handle;
+                VSICURLLogConnection(msg->easy_handle);
+                if (oTraceSpan.IsActive())
+                {
+                    ++nRequests;
+                    curl_off_t nSize = 0;
+                    if (curl_easy_getinfo(msg->easy_handle,
+                                          CURLINFO_SIZE_DOWNLOAD_T,
+                                          &nSize) == CURLE_OK)
+                        nDownloadedBytes += nSize;
+                    // Only detail single requests: parallel ranges of
+                    // ReadMultiRange() are summarized by the counters.
+                    if (hEasyHandle)
+                    {
+                        char *pszURL = nullptr;
+                        long nHTTPCode = 0;
+                        curl_easy_getinfo(msg->easy_handle,
+                                          CURLINFO_EFFECTIVE_URL, &pszURL);
+                        curl_easy_getinfo(msg->easy_handle,
+                                          CURLINFO_RESPONSE_CODE, &nHTTPCode);
+                        oTraceSpan.AddAttribute("url", pszURL);
+                        oTraceSpan.AddAttribute(
+                            "http_code", static_cast<int64_t>(nHTTPCode));
+                    }
+                }
             }
         } while (msg);
-#endif
-
-        CPLMultiPerformWait(hCurlMultiHandle, repeats);
+        oTraceSpan.AddAttribute("requests", nRequests);
+        oTraceSpan.AddAttribute("downloaded_bytes",
+                                static_cast<int64_t>(nDownloadedBytes));
     }
-    CPLHTTPRestoreSigPipeHandler(old_handler);
 
     if (hEasyHandle)
         curl_multi_remove_handle(hCurlMultiHandle, hEasyHandle);
@@ -2155,6 +2208,19 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
     if (nBufferRequestSize == 0)
         return 0;
 
+    // Try to use AdviseRead ranges fetched asynchronously
+    {
+        size_t nRead = 0;
+        if (ReadFromAdviseReadRanges(pBufferIn, nBufferRequestSize, curOffset,
+                                     nRead))
+        {
+            curOffset += nRead;
+            if (nRead < nBufferRequestSize)
+                bEOF = true;
+            return nRead / nSize;
+        }
+    }
+
     void *pBuffer = pBufferIn;
 
 #if DEBUG_VERBOSE
@@ -2165,6 +2231,12 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
     vsi_l_offset iterOffset = curOffset;
     const int knMAX_REGIONS = GetMaxRegions();
     const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+    constexpr int MAX_PARALLEL_REQUESTS = 64;
+    const int nSequentialReadParallelRequests = std::max(
+        1, std::min(MAX_PARALLEL_REQUESTS,
+                    atoi(CPLGetConfigOption(
+                        "CPL_VSIL_CURL_SEQUENTIAL_READ_PARALLEL_REQUESTS",
+                        "1"))));
     while (nBufferRequestSize)
     {
         // Don't try to read after end of file.
@@ -2192,7 +2264,9 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
         }
         else
         {
-            if (nOffsetToDownload == lastDownloadedOffset)
+            const bool bSequentialRead =
+                nOffsetToDownload == lastDownloadedOffset;
+            if (bSequentialRead)
             {
                 // In case of consecutive reads (of small size), we use a
                 // heuristic that we will read the file sequentially, so
@@ -2220,17 +2294,26 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
             if (nBlocksToDownload < nMinBlocksToDownload)
                 nBlocksToDownload = nMinBlocksToDownload;
 
+            // When reading sequentially, fetch nParallelRequests times the
+            // above amount of data, with as many concurrent requests, so
+            // that the throughput is not limited by a single connection.
+            int nBlocks = nBlocksToDownload;
+            const int nParallelRequests =
+                bSequentialRead ? nSequentialReadParallelRequests : 1;
+            if (nParallelRequests > 1)
+                nBlocks *= nParallelRequests;
+
             // Avoid reading already cached data.
             // Note: this might get evicted if concurrent reads are done, but
             // this should not cause bugs. Just missed optimization.
-            for (int i = 1; i < nBlocksToDownload; i++)
+            for (int i = 1; i < nBlocks; i++)
             {
                 if (poFS->GetRegion(m_pszURL, nOffsetToDownload +
                                                   static_cast<vsi_l_offset>(i) *
                                                       knDOWNLOAD_CHUNK_SIZE) !=
                     nullptr)
                 {
-                    nBlocksToDownload = i;
+                    nBlocks = i;
                     break;
                 }
             }
@@ -2238,10 +2321,20 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
             // We can't download more than knMAX_REGIONS chunks at a time,
             // otherwise the cache will not be big enough to store them and
             // copy their content to the target buffer.
-            if (nBlocksToDownload > knMAX_REGIONS)
-                nBlocksToDownload = knMAX_REGIONS;
+            if (nBlocks > knMAX_REGIONS)
+                nBlocks = knMAX_REGIONS;
+            if (nBlocksToDownload > nBlocks)
+                nBlocksToDownload = nBlocks;
 
-            osRegion = DownloadRegion(nOffsetToDownload, nBlocksToDownload);
+            if (nParallelRequests > 1 && nBlocks > 1)
+            {
+                osRegion = DownloadRegionParallel(nOffsetToDownload, nBlocks,
+                                                  nParallelRequests);
+            }
+            else
+            {
+                osRegion = DownloadRegion(nOffsetToDownload, nBlocks);
+            }
             if (osRegion.empty())
             {
                 if (!bInterrupted)
@@ -2286,6 +2379,245 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
     return ret;
 }
 
+/************************************************************************/
+/*                       VSICURLMultiSetOptions()                       */
+/************************************************************************/
+
+static void VSICURLMultiSetOptions(CURLM *hMultiHandle)
+{
+#ifdef CURLPIPE_MULTIPLEX
+    // Enable HTTP/2 multiplexing (ignored if an older version of HTTP is
+    // used)
+    // Not that this does not enable HTTP/1.1 pipeling, which is not
+    // recommended for example by Google Cloud Storage.
+    // For HTTP/1.1, parallel connections work better since you can get
+    // results out of order.
+    if (CPLTestBool(CPLGetConfigOption("GDAL_HTTP_MULTIPLEX", "YES")))
+    {
+        curl_multi_setopt(hMultiHandle, CURLMOPT_PIPELINING,
+                          CURLPIPE_MULTIPLEX);
+    }
+#endif
+
+    // Options are set on each call, since the multi handle may be reused
+    // across requests. 0 means no limit, and 100 is the libcurl default.
+    curl_multi_setopt(hMultiHandle, CURLMOPT_MAX_HOST_CONNECTIONS,
+                      static_cast<long>(std::max(
+                          0, atoi(CPLGetConfigOption(
+                                 "GDAL_HTTP_MAX_HOST_CONNECTIONS", "0")))));
+    curl_multi_setopt(hMultiHandle, CURLMOPT_MAX_CONCURRENT_STREAMS,
+                      static_cast<long>(std::max(
+                          1, atoi(CPLGetConfigOption(
+                                 "GDAL_HTTP_MAX_CONCURRENT_STREAMS", "100")))));
+}
+
+/************************************************************************/
+/*                  VSICURLEasySetMultiplexOptions()                    */
+/************************************************************************/
+
+static void VSICURLEasySetMultiplexOptions(CURL *hCurlHandle)
+{
+#ifdef CURLPIPE_MULTIPLEX
+    // When the requests of a multi-range read are started while no
+    // connection to the server is established yet, make them wait for the
+    // first connection to know if it can be multiplexed, instead of each of
+    // them opening its own TCP/TLS connection. This has no effect if HTTP/2
+    // is not requested.
+    if (CPLTestBool(CPLGetConfigOption("GDAL_HTTP_MULTIPLEX", "YES")))
+    {
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_PIPEWAIT, 1L);
+    }
+#else
+    CPL_IGNORE_RET_VAL(hCurlHandle);
+#endif
+}
+
+/************************************************************************/
+/*                       DownloadRegionParallel()                       */
+/************************************************************************/
+
+// Download nBlocks chunks starting at startOffset, by splitting the region
+// into nParallelRequests ranges that are fetched concurrently. Falls back to
+// DownloadRegion() if the file size is unknown, or if any request fails.
+std::string
+VSICurlHandle::DownloadRegionParallel(const vsi_l_offset startOffset,
+                                      const int nBlocks,
+                                      const int nParallelRequests)
+{
+    if (bInterrupted && bStopOnInterruptUntilUninstall)
+        return std::string();
+
+    if (oFileProp.eExists == EXIST_NO)
+        return std::string();
+
+    const vsi_l_offset nChunkSize = VSICURLGetDownloadChunkSize();
+    if (!oFileProp.bHasComputedFileSize || startOffset >= oFileProp.fileSize)
+        return DownloadRegion(startOffset, nBlocks);
+
+    // Some servers don't like we try to read after end-of-file (#5786).
+    const vsi_l_offset nEndOffset =
+        std::min(startOffset + static_cast<vsi_l_offset>(nBlocks) * nChunkSize,
+                 oFileProp.fileSize);
+    const int nBlocksInFile =
+        static_cast<int>((nEndOffset - startOffset + nChunkSize - 1) /
+                         nChunkSize);
+    if (nBlocksInFile <= 1)
+        return DownloadRegion(startOffset, nBlocks);
+    const int nBlocksPerRequest =
+        (nBlocksInFile + nParallelRequests - 1) / nParallelRequests;
+
+    ManagePlanetaryComputerSigning();
+
+    bool bHasExpired = false;
+    std::string osURL(GetRedirectURLIfValid(bHasExpired));
+    if (bHasExpired)
+        return DownloadRegion(startOffset, nBlocks);
+
+    CURLM *hMultiHandle = poFS->GetCurlMultiHandleFor(osURL);
+    VSICURLMultiSetOptions(hMultiHandle);
+
+    const int nRequests =
+        (nBlocksInFile + nBlocksPerRequest - 1) / nBlocksPerRequest;
+    std::vector<CURL *> aHandles;
+    std::vector<WriteFuncStruct> asWriteFuncData(nRequests);
+    std::vector<WriteFuncStruct> asWriteFuncHeaderData(nRequests);
+    std::vector<std::string> aosHeaderRanges(nRequests);
+    std::vector<struct curl_slist *> aHeaders;
+
+    for (int iRequest = 0; iRequest < nRequests; iRequest++)
+    {
+        CURL *hCurlHandle = curl_easy_init();
+        aHandles.push_back(hCurlHandle);
+
+        VSICURLEasySetMultiplexOptions(hCurlHandle);
+
+        struct curl_slist *headers =
+            VSICurlSetOptions(hCurlHandle, osURL.c_str(), m_papszHTTPOptions);
+
+        if (!AllowAutomaticRedirection())
+            unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_FOLLOWLOCATION, 0);
+
+        VSICURLInitWriteFuncStruct(&asWriteFuncData[iRequest], this, pfnReadCbk,
+                                   pReadCbkUserData);
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_WRITEDATA,
+                                   &asWriteFuncData[iRequest]);
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_WRITEFUNCTION,
+                                   VSICurlHandleWriteFunc);
+
+        VSICURLInitWriteFuncStruct(&asWriteFuncHeaderData[iRequest], nullptr,
+                                   nullptr, nullptr);
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HEADERDATA,
+                                   &asWriteFuncHeaderData[iRequest]);
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HEADERFUNCTION,
+                                   VSICurlHandleWriteFunc);
+        asWriteFuncHeaderData[iRequest].bIsHTTP = STARTS_WITH(m_pszURL, "http");
+        asWriteFuncHeaderData[iRequest].nStartOffset =
+            startOffset +
+            static_cast<vsi_l_offset>(iRequest) * nBlocksPerRequest *
+                nChunkSize;
+        asWriteFuncHeaderData[iRequest].nEndOffset =
+            std::min(asWriteFuncHeaderData[iRequest].nStartOffset +
+                         nBlocksPerRequest * nChunkSize,
+                     nEndOffset) -
+            1;
+
+        char rangeStr[512] = {};
+        snprintf(rangeStr, sizeof(rangeStr), CPL_FRMT_GUIB "-" CPL_FRMT_GUIB,
+                 asWriteFuncHeaderData[iRequest].nStartOffset,
+                 asWriteFuncHeaderData[iRequest].nEndOffset);
+
+        if (ENABLE_DEBUG)
+            CPLDebug(poFS->GetDebugKey(), "Downloading %s (%s)...", rangeStr,
+                     osURL.c_str());
+
+        if (asWriteFuncHeaderData[iRequest].bIsHTTP)
+        {
+            // So it gets included in Azure signature
+            aosHeaderRanges[iRequest] = CPLSPrintf("Range: bytes=%s", rangeStr);
+            headers =
+                curl_slist_append(headers, aosHeaderRanges[iRequest].c_str());
+            unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_RANGE, nullptr);
+        }
+        else
+        {
+            unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_RANGE, rangeStr);
+        }
+
+        headers = VSICurlMergeHeaders(headers, GetCurlHeaders("GET", headers));
+        unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HTTPHEADER, headers);
+        aHeaders.push_back(headers);
+        curl_multi_add_handle(hMultiHandle, hCurlHandle);
+    }
+
+    MultiPerform(hMultiHandle);
+
+    bool bSuccess = true;
+    bool bRequestInterrupted = false;
+    size_t nTotalDownloaded = 0;
+    std::string osRet;
+    for (int iRequest = 0; iRequest < nRequests; iRequest++)
+    {
+        long response_code = 0;
+        curl_easy_getinfo(aHandles[iRequest], CURLINFO_HTTP_CODE,
+                          &response_code);
+
+        nTotalDownloaded += asWriteFuncData[iRequest].nSize;
+        if (asWriteFuncData[iRequest].bInterrupted)
+        {
+            bRequestInterrupted = true;
+            bSuccess = false;
+        }
+        else if ((response_code != 206 && response_code != 225) ||
+                 asWriteFuncHeaderData[iRequest].nEndOffset + 1 !=
+                     asWriteFuncHeaderData[iRequest].nStartOffset +
+                         asWriteFuncData[iRequest].nSize)
+        {
+            if (ENABLE_DEBUG)
+            {
+                CPLDebug(poFS->GetDebugKey(),
+                         "DownloadRegionParallel(%s): request " CPL_FRMT_GUIB
+                         "-" CPL_FRMT_GUIB " got response_code=%ld",
+                         osURL.c_str(),
+                         asWriteFuncHeaderData[iRequest].nStartOffset,
+                         asWriteFuncHeaderData[iRequest].nEndOffset,
+                         response_code);
+            }
+            bSuccess = false;
+        }
+        else if (bSuccess)
+        {
+            osRet.append(asWriteFuncData[iRequest].pBuffer,
+                         asWriteFuncData[iRequest].nSize);
+        }
+
+        curl_multi_remove_handle(hMultiHandle, aHandles[iRequest]);
+        VSICURLResetHeaderAndWriterFunctions(aHandles[iRequest]);
+        curl_easy_cleanup(aHandles[iRequest]);
+        CPLFree(asWriteFuncData[iRequest].pBuffer);
+        CPLFree(asWriteFuncHeaderData[iRequest].pBuffer);
+        curl_slist_free_all(aHeaders[iRequest]);
+    }
+
+    NetworkStatisticsLogger::LogGET(nTotalDownloaded);
+
+    if (bRequestInterrupted)
+    {
+        bInterrupted = true;
+        return std::string();
+    }
+
+    if (!bSuccess)
+    {
+        // Let the serial code path deal with retries, redirections and
+        // error reporting.
+        return DownloadRegion(startOffset, nBlocks);
+    }
+
+    DownloadRegionPostProcess(startOffset, nBlocks, osRet.data(),
+                              osRet.size());
+    return osRet;
+}
+
 /************************************************************************/
 /*                           ReadMultiRange()                           */
 /************************************************************************/
@@ -2301,6 +2633,40 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
     if (oFileProp.eExists == EXIST_NO)
         return -1;
 
+    // Serve the request from the AdviseRead ranges fetched asynchronously
+    // if they cover all the ranges
+    if (!m_aoAdviseReadRanges.empty())
+    {
+        const auto IsCovered = [this](vsi_l_offset nOffset, size_t nSize)
+        {
+            for (const auto &poRange : m_aoAdviseReadRanges)
+            {
+                if (nOffset >= poRange->nStartOffset &&
+                    nOffset + nSize <= poRange->nStartOffset + poRange->nSize)
+                    return true;
+            }
+            return false;
+        };
+        int i = 0;
+        for (; i < nRanges && IsCovered(panOffsets[i], panSizes[i]); ++i)
+        {
+        }
+        if (i == nRanges)
+        {
+            for (i = 0; i < nRanges; ++i)
+            {
+                size_t nRead = 0;
+                if (!ReadFromAdviseReadRanges(ppData[i], panSizes[i],
+                                              panOffsets[i], nRead) ||
+                    nRead != panSizes[i])
+                {
+                    return -1;
+                }
+            }
+            return 0;
+        }
+    }
+
     NetworkStatisticsFileSystem oContextFS(poFS->GetFSPrefix().c_str());
     NetworkStatisticsFile oContextFile(m_osFilename.c_str());
     NetworkStatisticsAction oContextAction("ReadMultiRange");
@@ -2330,19 +2696,7 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
     }
 
     CURLM *hMultiHandle = poFS->GetCurlMultiHandleFor(osURL);
-#ifdef CURLPIPE_MULTIPLEX
-    // Enable HTTP/2 multiplexing (ignored if an older version of HTTP is
-    // used)
-    // Not that this does not enable HTTP/1.1 pipeling, which is not
-    // recommended for example by Google Cloud Storage.
-    // For HTTP/1.1, parallel connections work better since you can get
-    // results out of order.
-    if (CPLTestBool(CPLGetConfigOption("GDAL_HTTP_MULTIPLEX", "YES")))
-    {
-        curl_multi_setopt(hMultiHandle, CURLMOPT_PIPELINING,
-                          CURLPIPE_MULTIPLEX);
-    }
-#endif
+    VSICURLMultiSetOptions(hMultiHandle);
 
     std::vector<CURL *> aHandles;
     std::vector<WriteFuncStruct> asWriteFuncData(nRanges);
@@ -2381,9 +2735,7 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
         CURL *hCurlHandle = curl_easy_init();
         aHandles.push_back(hCurlHandle);
 
-        // As the multi-range request is likely not the first one, we don't
-        // need to wait as we already know if pipelining is possible
-        // unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_PIPEWAIT, 1);
+        VSICURLEasySetMultiplexOptions(hCurlHandle);
 
         struct curl_slist *headers =
             VSICurlSetOptions(hCurlHandle, osURL.c_str(), m_papszHTTPOptions);
@@ -2929,44 +3281,73 @@ end:
 }
 
 /************************************************************************/
-/*                              PRead()                                 */
+/*                        ReadMultiRangeAsync()                         */
 /************************************************************************/
 
-size_t VSICurlHandle::PRead(void *pBuffer, size_t nSize,
-                            vsi_l_offset nOffset) const
+std::unique_ptr<VSIAsyncReadRequest> VSICurlHandle::ReadMultiRangeAsync(
+    int nRanges, void **ppData, const vsi_l_offset *panOffsets,
+    const size_t *panSizes, VSIAsyncReadCallback pfnCallback, void *pUserData)
 {
-    // Try to use AdviseRead ranges fetched asynchronously
-    if (!m_aoAdviseReadRanges.empty())
+    // Rather than one blocking PRead() per range, use a single job whose
+    // ReadMultiRange() issues all ranges concurrently on a curl multi handle.
+    return SubmitReadMultiRangeAsync(nRanges, ppData, panOffsets, panSizes,
+                                     pfnCallback, pUserData, false,
+                                     &m_oMutexAsyncRead);
+}
+
+/************************************************************************/
+/*                      ReadFromAdviseReadRanges()                      */
+/************************************************************************/
+
+// Serves a read from the ranges fetched asynchronously after AdviseRead(),
+// waiting for their download if needed. Returns false if [nOffset,
+// nOffset+nSize[ is not contained in one of them.
+bool VSICurlHandle::ReadFromAdviseReadRanges(void *pBuffer, size_t nSize,
+                                             vsi_l_offset nOffset,
+                                             size_t &nRead) const
+{
+    nRead = 0;
+    for (auto &poRange : m_aoAdviseReadRanges)
     {
-        for (auto &poRange : m_aoAdviseReadRanges)
+        if (nOffset >= poRange->nStartOffset &&
+            nOffset + nSize <= poRange->nStartOffset + poRange->nSize)
         {
-            if (nOffset >= poRange->nStartOffset &&
-                nOffset + nSize <= poRange->nStartOffset + poRange->nSize)
             {
+                std::unique_lock<std::mutex> oLock(poRange->oMutex);
+                while (!poRange->bDone)
                 {
-                    std::unique_lock<std::mutex> oLock(poRange->oMutex);
-                    while (!poRange->bDone)
-                    {
-                        poRange->oCV.wait(oLock);
-                    }
+                    poRange->oCV.wait(oLock);
                 }
-                if (poRange->abyData.empty())
-                    return 0;
-
-                auto nEndOffset =
-                    poRange->nStartOffset + poRange->abyData.size();
-                if (nOffset >= nEndOffset)
-                    return 0;
-                const size_t nToCopy = static_cast<size_t>(
-                    std::min<vsi_l_offset>(nSize, nEndOffset - nOffset));
-                memcpy(pBuffer,
-                       poRange->abyData.data() +
-                           static_cast<size_t>(nOffset - poRange->nStartOffset),
-                       nToCopy);
-                return nToCopy;
             }
+            if (poRange->abyData.empty())
+                return true;
+
+            auto nEndOffset = poRange->nStartOffset + poRange->abyData.size();
+            if (nOffset >= nEndOffset)
+                return true;
+            nRead = static_cast<size_t>(
+                std::min<vsi_l_offset>(nSize, nEndOffset - nOffset));
+            memcpy(pBuffer,
+                   poRange->abyData.data() +
+                       static_cast<size_t>(nOffset - poRange->nStartOffset),
+                   nRead);
+            return true;
         }
     }
+    return false;
+}
+
+/************************************************************************/
+/*                              PRead()                                 */
+/************************************************************************/
+
+size_t VSICurlHandle::PRead(void *pBuffer, size_t nSize,
+                            vsi_l_offset nOffset) const
+{
+    // Try to use AdviseRead ranges fetched asynchronously
+    size_t nRead = 0;
+    if (ReadFromAdviseReadRanges(pBuffer, nSize, nOffset, nRead))
+        return nRead;
 
     // poFS has a global mutex
     poFS->GetCachedFileProp(m_pszURL, oFileProp);
@@ -3206,19 +3587,7 @@ void VSICurlHandle::AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
         NetworkStatisticsFile oContextFile(m_osFilename.c_str());
         NetworkStatisticsAction oContextAction("AdviseRead");
 
-#ifdef CURLPIPE_MULTIPLEX
-        // Enable HTTP/2 multiplexing (ignored if an older version of HTTP is
-        // used)
-        // Not that this does not enable HTTP/1.1 pipeling, which is not
-        // recommended for example by Google Cloud Storage.
-        // For HTTP/1.1, parallel connections work better since you can get
-        // results out of order.
-        if (CPLTestBool(CPLGetConfigOption("GDAL_HTTP_MULTIPLEX", "YES")))
-        {
-            curl_multi_setopt(hMultiHandle, CURLMOPT_PIPELINING,
-                              CURLPIPE_MULTIPLEX);
-        }
-#endif
+        VSICURLMultiSetOptions(hMultiHandle);
 
         std::vector<CURL *> aHandles;
         std::vector<WriteFuncStruct> asWriteFuncData(
@@ -3241,9 +3610,7 @@ void VSICurlHandle::AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
             oMapHandleToIdx[hCurlHandle] = i;
             aHandles.push_back(hCurlHandle);
 
-            // As the multi-range request is likely not the first one, we don't
-            // need to wait as we already know if pipelining is possible
-            // unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_PIPEWAIT, 1);
+            VSICURLEasySetMultiplexOptions(hCurlHandle);
 
             struct curl_slist *headers = VSICurlSetOptions(
                 hCurlHandle, osURL.c_str(), m_papszHTTPOptions);
@@ -3317,6 +3684,8 @@ void VSICurlHandle::AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
             CPLAssert(oIter != oMapHandleToIdx.end());
             const auto iReq = oIter->second;
 
+            VSICURLLogConnection(hCurlHandle);
+
             long response_code = 0;
             curl_easy_getinfo(hCurlHandle, CURLINFO_HTTP_CODE, &response_code);
 
@@ -3458,12 +3827,39 @@ int VSICurlHandle::Close()
     return 0;
 }
 
+/************************************************************************/
+/*                   VSICURLGetMetadataCacheMaxEntries()                */
+/************************************************************************/
+
+// Maximum number of files whose properties are cached.
+static size_t VSICURLGetMetadataCacheMaxEntries()
+{
+    constexpr int DEFAULT_MAX_ENTRIES = 100 * 1024;
+    const int nMaxEntries = atoi(
+        CPLGetConfigOption("CPL_VSIL_CURL_METADATA_CACHE_MAX_ENTRIES",
+                           CPLSPrintf("%d", DEFAULT_MAX_ENTRIES)));
+    return nMaxEntries > 0 ? nMaxEntries : DEFAULT_MAX_ENTRIES;
+}
+
+/************************************************************************/
+/*                  VSICURLIsMetadataCacheEntryExpired()                */
+/************************************************************************/
+
+// Cached file properties and directory listings never expire by default.
+static bool VSICURLIsMetadataCacheEntryExpired(time_t nCacheTimestamp)
+{
+    const int nTTL =
+        atoi(CPLGetConfigOption("CPL_VSIL_CURL_METADATA_CACHE_TTL", "0"));
+    return nTTL > 0 && time(nullptr) >= nCacheTimestamp + nTTL;
+}
+
 /************************************************************************/
 /*                   VSICurlFilesystemHandlerBase()                         */
 /************************************************************************/
 
 VSICurlFilesystemHandlerBase::VSICurlFilesystemHandlerBase()
-    : oCacheFileProp{100 * 1024}, oCacheDirList{1024, 0}
+    : oCacheFileProp{VSICURLGetMetadataCacheMaxEntries()},
+      oCacheDirList{1024, 0}
 {
 }
 
@@ -3611,6 +4007,272 @@ VSICurlFilesystemHandlerBase::GetRegionCache()
     return m_poRegionCacheDoNotUseDirectly.get();
 }
 
+/************************************************************************/
+/*                       On-disk region cache                           */
+/************************************************************************/
+
+// When CPL_VSIL_CURL_DISK_CACHE_DIR is set, downloaded regions are also
+// stored in that directory, so that they can be reused by other processes,
+// or after the process has been restarted. Each region is stored in its own
+// file, whose name is the SHA256 of a key made of the URL, the ETag of the
+// remote file, the offset of the region and the chunk size. Files are
+// written under a temporary name and atomically renamed, so that concurrent
+// readers never see partial content. Their modification time is refreshed
+// when they are read, and is used to evict the least recently used regions
+// when the total size of the directory exceeds
+// CPL_VSIL_CURL_DISK_CACHE_SIZE.
+
+constexpr const char DISK_CACHE_MAGIC[] = "GDAL_VSICURL_REGION_1\n";
+
+static std::mutex gDiskCacheMutex;
+static GIntBig gnDiskCacheBytesWrittenSinceLastScan = -1;
+
+/************************************************************************/
+/*                      VSICurlDiskCacheGetDir()                        */
+/************************************************************************/
+
+static const char *VSICurlDiskCacheGetDir()
+{
+    const char *pszDir = CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_DIR", "");
+    return pszDir[0] != '\0' ? pszDir : nullptr;
+}
+
+/************************************************************************/
+/*                    VSICurlDiskCacheGetMaxSize()                      */
+/************************************************************************/
+
+static GIntBig VSICurlDiskCacheGetMaxSize()
+{
+    return std::max<GIntBig>(
+        0, CPLAtoGIntBig(CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_SIZE",
+                                            "1073741824")));
+}
+
+/************************************************************************/
+/*                      VSICurlDiskCacheGetKey()                        */
+/************************************************************************/
+
+// Returns an empty string if the region cannot be cached on disk, that is
+// when the ETag of the file is not known, since we would have no way of
+// detecting that it has been modified.
+static std::string VSICurlDiskCacheGetKey(const char *pszURL,
+                                          vsi_l_offset nFileOffsetStart)
+{
+    FileProp oFileProp;
+    if (!VSICURLGetCachedFileProp(pszURL, oFileProp) || oFileProp.ETag.empty())
+        return std::string();
+    std::string osKey(pszURL);
+    osKey += '\n';
+    osKey += oFileProp.ETag;
+    osKey += '\n';
+    // The chunk size is part of the key, since a region shorter than it is
+    // interpreted as the end of the file.
+    osKey += CPLSPrintf(CPL_FRMT_GUIB "\n%d",
+                        static_cast<GUIntBig>(nFileOffsetStart),
+                        VSICURLGetDownloadChunkSize());
+    return osKey;
+}
+
+/************************************************************************/
+/*                    VSICurlDiskCacheGetFilename()                     */
+/************************************************************************/
+
+static std::string VSICurlDiskCacheGetFilename(const char *pszDir,
+                                               const std::string &osKey)
+{
+    GByte abyHash[CPL_SHA256_HASH_SIZE];
+    CPL_SHA256(osKey.data(), osKey.size(), abyHash);
+    char *pszHex = CPLBinaryToHex(CPL_SHA256_HASH_SIZE, abyHash);
+    // Spread files over 256 sub-directories to keep directories small.
+    std::string osFilename(pszDir);
+    osFilename += '/';
+    osFilename.append(pszHex, 2);
+    osFilename += '/';
+    osFilename += pszHex;
+    CPLFree(pszHex);
+    return osFilename;
+}
+
+/************************************************************************/
+/*                       VSICurlDiskCacheRead()                         */
+/************************************************************************/
+
+static std::shared_ptr<std::string>
+VSICurlDiskCacheRead(const char *pszURL, vsi_l_offset nFileOffsetStart)
+{
+    const char *pszDir = VSICurlDiskCacheGetDir();
+    if (pszDir == nullptr)
+        return nullptr;
+    const std::string osKey = VSICurlDiskCacheGetKey(pszURL, nFileOffsetStart);
+    if (osKey.empty())
+        return nullptr;
+    const std::string osFilename = VSICurlDiskCacheGetFilename(pszDir, osKey);
+
+    VSIStatBufL sStat;
+    if (VSIStatL(osFilename.c_str(), &sStat) != 0)
+        return nullptr;
+    const std::string osHeader =
+        std::string(DISK_CACHE_MAGIC) + osKey + std::string(1, '\0');
+    const vsi_l_offset nMaxRegionSize =
+        static_cast<vsi_l_offset>(VSICURLGetDownloadChunkSize());
+    if (static_cast<vsi_l_offset>(sStat.st_size) < osHeader.size() ||
+        static_cast<vsi_l_offset>(sStat.st_size) - osHeader.size() >
+            nMaxRegionSize)
+    {
+        return nullptr;
+    }
+
+    VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "rb");
+    if (fp == nullptr)
+        return nullptr;
+    std::string osContent;
+    osContent.resize(static_cast<size_t>(sStat.st_size));
+    const bool bOK =
+        VSIFReadL(&osContent[0], 1, osContent.size(), fp) == osContent.size();
+    VSIFCloseL(fp);
+    if (!bOK || osContent.compare(0, osHeader.size(), osHeader) != 0)
+        return nullptr;
+
+    // Refresh the modification time, used as the last access time for
+    // eviction, but not too often to avoid useless writes.
+    if (time(nullptr) - sStat.st_mtime > 60)
+    {
+        fp = VSIFOpenL(osFilename.c_str(), "r+b");
+        if (fp)
+        {
+            CPL_IGNORE_RET_VAL(VSIFWriteL(DISK_CACHE_MAGIC, 1, 1, fp));
+            VSIFCloseL(fp);
+        }
+    }
+
+    return std::make_shared<std::string>(osContent.substr(osHeader.size()));
+}
+
+/************************************************************************/
+/*                      VSICurlDiskCacheEvict()                         */
+/************************************************************************/
+
+static void VSICurlDiskCacheEvict(const char *pszDir, GIntBig nMaxSize)
+{
+    struct Entry
+    {
+        std::string osFilename{};
+        time_t nMTime = 0;
+        GIntBig nSize = 0;
+    };
+
+    std::vector<Entry> aoEntries;
+    GIntBig nTotalSize = 0;
+    const time_t nNow = time(nullptr);
+    const CPLStringList aosFiles(VSIReadDirRecursive(pszDir));
+    for (const char *pszFile : aosFiles)
+    {
+        Entry oEntry;
+        oEntry.osFilename = CPLFormFilename(pszDir, pszFile, nullptr);
+        VSIStatBufL sStat;
+        if (VSIStatL(oEntry.osFilename.c_str(), &sStat) != 0 ||
+            !VSI_ISREG(sStat.st_mode))
+        {
+            continue;
+        }
+        // Temporary files of other writers: only remove stale ones.
+        if (EQUAL(CPLGetExtension(pszFile), "tmp") &&
+            nNow - sStat.st_mtime < 3600)
+        {
+            continue;
+        }
+        oEntry.nMTime = sStat.st_mtime;
+        oEntry.nSize = static_cast<GIntBig>(sStat.st_size);
+        nTotalSize += oEntry.nSize;
+        aoEntries.emplace_back(std::move(oEntry));
+    }
+    if (nTotalSize <= nMaxSize)
+        return;
+
+    CPLDebug("VSICURL",
+             "Disk cache size is " CPL_FRMT_GIB " bytes. Evicting oldest "
+             "regions",
+             nTotalSize);
+    std::sort(aoEntries.begin(), aoEntries.end(),
+              [](const Entry &a, const Entry &b)
+              { return a.nMTime < b.nMTime; });
+    // Leave some room so that eviction does not run on each new region.
+    const GIntBig nTargetSize = nMaxSize / 10 * 9;
+    for (const auto &oEntry : aoEntries)
+    {
+        if (nTotalSize <= nTargetSize)
+            break;
+        // Another process may have removed it in the meantime.
+        VSIUnlink(oEntry.osFilename.c_str());
+        nTotalSize -= oEntry.nSize;
+    }
+}
+
+/************************************************************************/
+/*                       VSICurlDiskCacheWrite()                        */
+/************************************************************************/
+
+static void VSICurlDiskCacheWrite(const char *pszURL,
+                                  vsi_l_offset nFileOffsetStart, size_t nSize,
+                                  const char *pData)
+{
+    const char *pszDir = VSICurlDiskCacheGetDir();
+    if (pszDir == nullptr)
+        return;
+    const GIntBig nMaxSize = VSICurlDiskCacheGetMaxSize();
+    if (static_cast<GIntBig>(nSize) > nMaxSize)
+        return;
+    const std::string osKey = VSICurlDiskCacheGetKey(pszURL, nFileOffsetStart);
+    if (osKey.empty())
+        return;
+    const std::string osFilename = VSICurlDiskCacheGetFilename(pszDir, osKey);
+
+    VSIStatBufL sStat;
+    if (VSIStatL(osFilename.c_str(), &sStat) == 0)
+        return;
+
+    VSIMkdirRecursive(CPLGetPath(osFilename.c_str()), 0755);
+
+    static std::atomic<unsigned> nCounter{0};
+    const std::string osTmpFilename =
+        osFilename + CPLSPrintf(".%d_" CPL_FRMT_GIB "_%u.tmp",
+                                CPLGetCurrentProcessID(), CPLGetPID(),
+                                nCounter++);
+    VSILFILE *fp = VSIFOpenL(osTmpFilename.c_str(), "wb");
+    if (fp == nullptr)
+        return;
+    const size_t nMagicSize = strlen(DISK_CACHE_MAGIC);
+    bool bOK = VSIFWriteL(DISK_CACHE_MAGIC, 1, nMagicSize, fp) == nMagicSize &&
+               VSIFWriteL(osKey.c_str(), 1, osKey.size() + 1, fp) ==
+                   osKey.size() + 1 &&
+               VSIFWriteL(pData, 1, nSize, fp) == nSize;
+    if (VSIFCloseL(fp) != 0)
+        bOK = false;
+    if (!bOK || VSIRename(osTmpFilename.c_str(), osFilename.c_str()) != 0)
+    {
+        VSIUnlink(osTmpFilename.c_str());
+        return;
+    }
+
+    // Scan the cache directory for eviction at the first write of the
+    // process, and then each time a tenth of the maximum size has been
+    // written by this process.
+    bool bEvict = false;
+    {
+        std::lock_guard<std::mutex> oLock(gDiskCacheMutex);
+        if (gnDiskCacheBytesWrittenSinceLastScan < 0 ||
+            gnDiskCacheBytesWrittenSinceLastScan >= nMaxSize / 10)
+        {
+            gnDiskCacheBytesWrittenSinceLastScan = 0;
+            bEvict = true;
+        }
+        gnDiskCacheBytesWrittenSinceLastScan +=
+            static_cast<GIntBig>(nMagicSize + osKey.size() + 1 + nSize);
+    }
+    if (bEvict)
+        VSICurlDiskCacheEvict(pszDir, nMaxSize);
+}
+
 /************************************************************************/
 /*                          GetRegion()                                 */
 /************************************************************************/
@@ -3619,20 +4281,28 @@ std::shared_ptr<std::string>
 VSICurlFilesystemHandlerBase::GetRegion(const char *pszURL,
                                         vsi_l_offset nFileOffsetStart)
 {
-    CPLMutexHolder oHolder(&hMutex);
-
     const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
     nFileOffsetStart =
         (nFileOffsetStart / knDOWNLOAD_CHUNK_SIZE) * knDOWNLOAD_CHUNK_SIZE;
 
     std::shared_ptr<std::string> out;
-    if (GetRegionCache()->tryGet(
-            FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), out))
     {
-        return out;
+        CPLMutexHolder oHolder(&hMutex);
+        if (GetRegionCache()->tryGet(
+                FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), out))
+        {
+            return out;
+        }
     }
 
-    return nullptr;
+    out = VSICurlDiskCacheRead(pszURL, nFileOffsetStart);
+    if (out)
+    {
+        CPLMutexHolder oHolder(&hMutex);
+        GetRegionCache()->insert(
+            FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), out);
+    }
+    return out;
 }
 
 /************************************************************************/
@@ -3643,12 +4313,16 @@ void VSICurlFilesystemHandlerBase::AddRegion(const char *pszURL,
                                              vsi_l_offset nFileOffsetStart,
                                              size_t nSize, const char *pData)
 {
-    CPLMutexHolder oHolder(&hMutex);
+    {
+        CPLMutexHolder oHolder(&hMutex);
 
-    std::shared_ptr<std::string> value(new std::string());
-    value->assign(pData, nSize);
-    GetRegionCache()->insert(
-        FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), value);
+        std::shared_ptr<std::string> value(new std::string());
+        value->assign(pData, nSize);
+        GetRegionCache()->insert(
+            FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), value);
+    }
+
+    VSICurlDiskCacheWrite(pszURL, nFileOffsetStart, nSize, pData);
 }
 
 /************************************************************************/
@@ -3692,10 +4366,16 @@ bool VSICurlFilesystemHandlerBase::GetCachedDirList(
 {
     CPLMutexHolder oHolder(&hMutex);
 
-    return oCacheDirList.tryGet(std::string(pszURL), oCachedDirList) &&
-           // Let a chance to use new auth parameters
-           gnGenerationAuthParameters ==
-               oCachedDirList.nGenerationAuthParameters;
+    if (oCacheDirList.tryGet(std::string(pszURL), oCachedDirList) &&
+        // Let a chance to use new auth parameters
+        gnGenerationAuthParameters ==
+            oCachedDirList.nGenerationAuthParameters &&
+        !VSICURLIsMetadataCacheEntryExpired(oCachedDirList.nCacheTimestamp))
+    {
+        NetworkStatisticsLogger::LogDirListCacheHit();
+        return true;
+    }
+    return false;
 }
 
 /************************************************************************/
@@ -3726,6 +4406,7 @@ void VSICurlFilesystemHandlerBase::SetCachedDirList(
         oCacheDirList.remove(oldestKey);
     }
     oCachedDirList.nGenerationAuthParameters = gnGenerationAuthParameters;
+    oCachedDirList.nCacheTimestamp = time(nullptr);
 
     nCachedFilesInDirList += oCachedDirList.oFileList.size();
     oCacheDirList.insert(key, oCachedDirList);
@@ -3910,6 +4591,12 @@ const char *VSICurlFilesystemHandlerBase::GetActualURL(const char *pszFilename)
     "  </Option>"                                                              \
     "  <Option name='GDAL_HTTP_MULTIPLEX' type='boolean' "                     \
     "description='Whether to enable HTTP/2 multiplexing' default='YES'/>"      \
+    "  <Option name='GDAL_HTTP_MAX_HOST_CONNECTIONS' type='int' "              \
+    "description='Maximum number of simultaneous connections to a host "       \
+    "during multi-range requests (0=unlimited)' default='0'/>"                 \
+    "  <Option name='GDAL_HTTP_MAX_CONCURRENT_STREAMS' type='int' "            \
+    "description='Maximum number of concurrent streams on a HTTP/2 "           \
+    "connection' default='100'/>"                                              \
     "  <Option name='GDAL_HTTP_MERGE_CONSECUTIVE_RANGES' type='boolean' "      \
     "description='Whether to merge consecutive ranges in multirange "          \
     "requests' default='YES'/>"                                                \
@@ -5693,6 +6380,42 @@ void NetworkStatisticsLogger::LogDELETE()
     }
 }
 
+void NetworkStatisticsLogger::LogConnection(bool bNewConnection)
+{
+    if (!IsEnabled())
+        return;
+    std::lock_guard<std::mutex> oLock(gInstance.m_mutex);
+    for (auto counters : gInstance.GetCountersForContext())
+    {
+        if (bNewConnection)
+            counters->nNewConnections++;
+        else
+            counters->nReusedConnections++;
+    }
+}
+
+void NetworkStatisticsLogger::LogFilePropCacheHit()
+{
+    if (!IsEnabled())
+        return;
+    std::lock_guard<std::mutex> oLock(gInstance.m_mutex);
+    for (auto counters : gInstance.GetCountersForContext())
+    {
+        counters->nFilePropCacheHits++;
+    }
+}
+
+void NetworkStatisticsLogger::LogDirListCacheHit()
+{
+    if (!IsEnabled())
+        return;
+    std::lock_guard<std::mutex> oLock(gInstance.m_mutex);
+    for (auto counters : gInstance.GetCountersForContext())
+    {
+        counters->nDirListCacheHits++;
+    }
+}
+
 void NetworkStatisticsLogger::Reset()
 {
     std::lock_guard<std::mutex> oLock(gInstance.m_mutex);
@@ -5722,6 +6445,20 @@ void NetworkStatisticsLogger::Stats::AsJSON(CPLJSONObject &oJSON) const
     if (counters.nDELETE)
         oMethods.Add("DELETE/count", counters.nDELETE);
     oJSON.Add("methods", oMethods);
+    if (counters.nNewConnections || counters.nReusedConnections)
+    {
+        CPLJSONObject oConnections;
+        oConnections.Add("new_count", counters.nNewConnections);
+        oConnections.Add("reused_count", counters.nReusedConnections);
+        oJSON.Add("connections", oConnections);
+    }
+    if (counters.nFilePropCacheHits || counters.nDirListCacheHits)
+    {
+        CPLJSONObject oMetadataCache;
+        oMetadataCache.Add("file_prop_hits", counters.nFilePropCacheHits);
+        oMetadataCache.Add("dir_list_hits", counters.nDirListCacheHits);
+        oJSON.Add("metadata_cache", oMetadataCache);
+    }
     CPLJSONObject oFiles;
     bool bFilesAdded = false;
     for (const auto &kv : children)
@@ -5810,7 +6547,9 @@ bool VSICURLGetCachedFileProp(const char *pszURL, FileProp &oFileProp)
            poCacheFileProp->tryGet(std::string(pszURL), oFileProp) &&
            // Let a chance to use new auth parameters
            !(oFileProp.eExists == EXIST_NO &&
-             gnGenerationAuthParameters != oFileProp.nGenerationAuthParameters);
+             gnGenerationAuthParameters !=
+                 oFileProp.nGenerationAuthParameters) &&
+           !VSICURLIsMetadataCacheEntryExpired(oFileProp.nCacheTimestamp);
 }
 
 /************************************************************************/
@@ -5821,8 +6560,10 @@ void VSICURLSetCachedFileProp(const char *pszURL, FileProp &oFileProp)
 {
     std::lock_guard<std::mutex> oLock(oCacheFilePropMutex);
     if (poCacheFileProp == nullptr)
-        poCacheFileProp = new lru11::Cache<std::string, FileProp>(100 * 1024);
+        poCacheFileProp = new lru11::Cache<std::string, FileProp>(
+            VSICURLGetMetadataCacheMaxEntries());
     oFileProp.nGenerationAuthParameters = gnGenerationAuthParameters;
+    oFileProp.nCacheTimestamp = time(nullptr);
     poCacheFileProp->insert(std::string(pszURL), oFileProp);
 }
 
@@ -6155,6 +6896,14 @@ void VSINetworkStatsReset(void)
  *       "uploaded_bytes":35472
  *     }
  *   },
+ *   "connections":{
+ *     "new_count":2,
+ *     "reused_count":5
+ *   },
+ *   "metadata_cache":{
+ *     "file_prop_hits":3,
+ *     "dir_list_hits":1
+ *   },
  *   "handlers":{
  *     "vsigs":{
  *       "methods":{
@@ -6216,6 +6965,11 @@ void VSINetworkStatsReset(void)
 
  * </pre>
  *
+ * Starting with GDAL 3.9, the "connections" object reports how many requests
+ * had to establish a new connection to the server, and how many could reuse
+ * an existing one. It is emitted at each level, but omitted from the above
+ * example after the top level for brevity.
+ *
  * @param papszOptions Unused.
  * @return a JSON serialized string to free with VSIFree(), or nullptr
  * @since GDAL 3.2.0
@@ -34,10 +34,12 @@
 #include "cpl_aws.h"
 #include "cpl_azure.h"
 #include "cpl_port.h"
+#include "cpl_error_internal.h"
 #include "cpl_json.h"
 #include "cpl_string.h"
 #include "cpl_vsil_curl_priv.h"
 #include "cpl_mem_cache.h"
+#include "cpl_worker_thread_pool.h"
 
 #include "cpl_curl_priv.h"
 
@@ -97,6 +99,7 @@ class FileProp
     int nMode = 0;  // st_mode member of struct stat
     bool bS3LikeRedirect = false;
     std::string ETag{};
+    time_t nCacheTimestamp = 0;  // time at which it was stored in the cache
 };
 
 struct CachedDirList
@@ -104,6 +107,7 @@ struct CachedDirList
     bool bGotFileList = false;
     unsigned int nGenerationAuthParameters = 0;
     CPLStringList oFileList{}; /* only file name without path */
+    time_t nCacheTimestamp = 0;  // time at which it was stored in the cache
 };
 
 struct WriteFuncStruct
@@ -402,6 +406,9 @@ class VSICurlHandle : public VSIVirtualHandle
     bool bEOF = false;
 
     virtual std::string DownloadRegion(vsi_l_offset startOffset, int nBlocks);
+    virtual std::string DownloadRegionParallel(vsi_l_offset startOffset,
+                                               int nBlocks,
+                                               int nParallelRequests);
 
     bool m_bUseHead = false;
     bool m_bUseRedirectURLIfNoQueryStringParams = false;
@@ -432,6 +439,12 @@ class VSICurlHandle : public VSIVirtualHandle
     };
     std::vector<std::unique_ptr<AdviseReadRange>> m_aoAdviseReadRanges{};
     std::thread m_oThreadAdviseRead{};
+    bool ReadFromAdviseReadRanges(void *pBuffer, size_t nSize,
+                                  vsi_l_offset nOffset,
+                                  size_t &nRead) const;
+
+    // Serializes the ReadMultiRange() calls issued by ReadMultiRangeAsync()
+    std::mutex m_oMutexAsyncRead{};
 
   protected:
     virtual struct curl_slist *
@@ -477,6 +490,11 @@ class VSICurlHandle : public VSIVirtualHandle
     int ReadMultiRange(int nRanges, void **ppData,
                        const vsi_l_offset *panOffsets,
                        const size_t *panSizes) override;
+    std::unique_ptr<VSIAsyncReadRequest>
+    ReadMultiRangeAsync(int nRanges, void **ppData,
+                        const vsi_l_offset *panOffsets, const size_t *panSizes,
+                        VSIAsyncReadCallback pfnCallback,
+                        void *pUserData) override;
     size_t Write(const void *pBuffer, size_t nSize, size_t nMemb) override;
     int Eof() override;
     int Flush() override;
@@ -637,6 +655,8 @@ class IVSIS3LikeFSHandler : public VSICurlFilesystemHandlerBaseWritable
                                 int nMaxRetry, double dfRetryDelay);
 
     bool AbortPendingUploads(const char *pszFilename) override;
+
+    friend class VSIS3WriteHandle;
 };
 
 /************************************************************************/
@@ -712,7 +732,21 @@ class VSIS3WriteHandle final : public VSIVirtualHandle
     double m_dfRetryDelay = 0.0;
     WriteFuncStruct m_sWriteFuncHeaderData{};
 
+    // Asynchronous upload of parts
+    struct PartUploadJob;
+    int m_nMaxParallelParts = 1;
+    std::unique_ptr<CPLWorkerThreadPool> m_poThreadPool{};
+    std::unique_ptr<CPLJobQueue> m_poJobQueue{};
+    // Protects the members below, and m_aosEtags, while jobs are running
+    std::mutex m_oMutex{};
+    std::vector<GByte *> m_apabyFreeBuffers{};
+    bool m_bPartUploadError = false;
+    std::vector<CPLErrorHandlerAccumulatorStruct> m_aoPartUploadErrors{};
+
     bool UploadPart();
+    bool CollectPartUploadResults();
+    bool FinishPartUploads();
+    static void UploadPartJob(void *pData);
     bool DoSinglePartPUT();
 
     static size_t ReadCallBackBufferChunked(char *buffer, size_t size,
@@ -842,6 +876,10 @@ class NetworkStatisticsLogger
         GIntBig nPUTUploadedBytes = 0;
         GIntBig nPOSTDownloadedBytes = 0;
         GIntBig nPOSTUploadedBytes = 0;
+        GIntBig nNewConnections = 0;
+        GIntBig nReusedConnections = 0;
+        GIntBig nFilePropCacheHits = 0;
+        GIntBig nDirListCacheHits = 0;
     };
 
     enum class ContextPathType
@@ -921,6 +959,12 @@ class NetworkStatisticsLogger
 
     static void LogDELETE();
 
+    static void LogConnection(bool bNewConnection);
+
+    static void LogFilePropCacheHit();
+
+    static void LogDirListCacheHit();
+
     static void Reset();
 
     static std::string GetReportAsSerializedJSON();
@@ -973,6 +1017,7 @@ void VSICURLInitWriteFuncStruct(WriteFuncStruct *psStruct, VSILFILE *fp,
 size_t VSICurlHandleWriteFunc(void *buffer, size_t count, size_t nmemb,
                               void *req);
 void MultiPerform(CURLM *hCurlMultiHandle, CURL *hEasyHandle = nullptr);
+void VSICURLLogConnection(CURL *hEasyHandle);
 void VSICURLResetHeaderAndWriterFunctions(CURL *hCurlHandle);
 
 int VSICurlParseUnixPermissions(const char *pszPermissions);
@@ -59,11 +59,15 @@
 
    It replaces classical calls operating on FILE* by calls to the VSI large file
    API. It also adds the capability to seek at the end of the file, which is not
-   implemented in original gzSeek. It also implements a concept of in-memory
-   "snapshots", that are a way of improving efficiency while seeking GZip
-   files. Snapshots are created regularly when decompressing the data a snapshot
-   of the gzip state.  Later we can seek directly in the compressed data to the
-   closest snapshot in order to reduce the amount of data to uncompress again.
+   implemented in original gzSeek. It also implements a concept of "access
+   points", that are a way of improving efficiency while seeking GZip
+   files. Access points are recorded regularly at deflate block boundaries
+   while decompressing the data, in the way of zlib's examples/zran.c, with
+   the position in the compressed data and the last 32 KB of uncompressed
+   data. Later we can seek directly in the compressed data to the closest
+   access point in order to reduce the amount of data to uncompress again.
+   Access points are shared by the handles opened on the same file, and can
+   optionally be saved in a .gz.gzidx file (CPL_VSIL_GZIP_INDEX_SIDECAR=YES).
 
    For .gz files, an effort is done to cache the size of the uncompressed data
    in a .gz.properties file, so that we don't need to seek at the end of the
@@ -98,6 +102,7 @@
 #endif
 
 #include <algorithm>
+#include <condition_variable>
 #include <iterator>
 #include <limits>
 #include <list>
@@ -109,6 +114,7 @@
 #include <vector>
 
 #include "cpl_error.h"
+#include "cpl_mem_cache.h"
 #include "cpl_minizip_ioapi.h"
 #include "cpl_minizip_unzip.h"
 #include "cpl_multiproc.h"
@@ -147,15 +153,28 @@ constexpr int gz_magic[2] = {0x1f, 0x8b};  // gzip magic header
 /* ==================================================================== */
 /************************************************************************/
 
-typedef struct
+// Position in a deflate stream, at a block boundary, from which
+// decompression can be restarted without inflating the preceding data.
+// See zran.c in the zlib "examples" directory.
+struct VSIGZipAccessPoint
 {
-    vsi_l_offset posInBaseHandle;
-    z_stream stream;
-    uLong crc;
-    int transparent;
-    vsi_l_offset in;
-    vsi_l_offset out;
-} GZipSnapshot;
+    vsi_l_offset posInBaseHandle = 0; /* offset of next input byte */
+    vsi_l_offset in = 0;
+    vsi_l_offset out = 0;
+    uLong crc = 0;
+    int nBits = 0;       /* bits of the previous input byte still to decode */
+    GByte nPrevByte = 0; /* value of the previous input byte, if nBits != 0 */
+    std::vector<GByte> abyWindow{}; /* last 32 KB of uncompressed data */
+};
+
+// Sorted list of access points. It may be shared by several handles on the
+// same stream, and is filled as decompression progresses.
+struct VSIGZipIndex
+{
+    std::mutex oMutex{};
+    std::vector<VSIGZipAccessPoint> aoPoints{};
+    bool bDirty = false; /* whether points were added since loaded */
+};
 
 class VSIGZipHandle final : public VSIVirtualHandle
 {
@@ -186,15 +205,20 @@ class VSIGZipHandle final : public VSIVirtualHandle
     vsi_l_offset out = 0; /* bytes out of deflate or inflate */
     vsi_l_offset m_nLastReadOffset = 0;
 
-    GZipSnapshot *snapshots = nullptr;
-    vsi_l_offset snapshot_byte_interval =
-        0; /* number of compressed bytes at which we create a "snapshot" */
+    std::shared_ptr<VSIGZipIndex> m_poIndex{};
+    vsi_l_offset m_nIndexInterval =
+        0; /* number of uncompressed bytes between two access points */
+    std::string m_osIndexSidecarFilename{};
 
     void check_header();
     int get_byte();
     bool gzseek(vsi_l_offset nOffset, int nWhence);
     int gzrewind();
     uLong getLong();
+    void AddAccessPointIfNeeded(const Bytef *pStart);
+    bool RestoreAccessPoint(const VSIGZipAccessPoint &oPoint);
+    bool LoadIndexSidecar();
+    void SaveIndexSidecar();
 
     CPL_DISALLOW_COPY_ASSIGN(VSIGZipHandle)
 
@@ -221,6 +245,9 @@ class VSIGZipHandle final : public VSIVirtualHandle
     VSIGZipHandle *Duplicate();
     bool CloseBaseHandle();
 
+    void UseSharedIndex(const std::string &osKey,
+                        const std::string &osSidecarFilename);
+
     vsi_l_offset GetLastReadOffset()
     {
         return m_nLastReadOffset;
@@ -410,21 +437,9 @@ VSIGZipHandle *VSIGZipHandle::Duplicate()
 
     poHandle->m_nLastReadOffset = m_nLastReadOffset;
 
-    // Most important: duplicate the snapshots!
-
-    for (unsigned int i = 0; i < m_compressed_size / snapshot_byte_interval + 1;
-         i++)
-    {
-        if (snapshots[i].posInBaseHandle == 0)
-            break;
-
-        poHandle->snapshots[i].posInBaseHandle = snapshots[i].posInBaseHandle;
-        inflateCopy(&poHandle->snapshots[i].stream, &snapshots[i].stream);
-        poHandle->snapshots[i].crc = snapshots[i].crc;
-        poHandle->snapshots[i].transparent = snapshots[i].transparent;
-        poHandle->snapshots[i].in = snapshots[i].in;
-        poHandle->snapshots[i].out = snapshots[i].out;
-    }
+    // Most important: share the access points!
+    poHandle->m_poIndex = m_poIndex;
+    poHandle->m_osIndexSidecarFilename = m_osIndexSidecarFilename;
 
     return poHandle;
 }
@@ -513,11 +528,29 @@ VSIGZipHandle::VSIGZipHandle(VSIVirtualHandle *poBaseHandle,
 
     if (transparent == 0)
     {
-        snapshot_byte_interval = std::max(static_cast<vsi_l_offset>(Z_BUFSIZE),
-                                          compressed_size / 100);
-        snapshots = static_cast<GZipSnapshot *>(CPLCalloc(
-            sizeof(GZipSnapshot),
-            static_cast<size_t>(compressed_size / snapshot_byte_interval + 1)));
+        const char *pszInterval =
+            CPLGetConfigOption("CPL_VSIL_GZIP_INDEX_INTERVAL", nullptr);
+        if (pszInterval)
+        {
+            m_nIndexInterval = CPLScanUIntBig(
+                pszInterval, static_cast<int>(strlen(pszInterval)));
+            if (strchr(pszInterval, 'K'))
+                m_nIndexInterval *= 1024;
+            else if (strchr(pszInterval, 'M'))
+                m_nIndexInterval *= 1024 * 1024;
+            m_nIndexInterval = std::max(static_cast<vsi_l_offset>(Z_BUFSIZE),
+                                        m_nIndexInterval);
+        }
+        else
+        {
+            // Aim at about 100 access points per stream, assuming a
+            // compression ratio of 4 when the uncompressed size is unknown.
+            m_nIndexInterval = std::max(
+                static_cast<vsi_l_offset>(1024 * 1024),
+                (uncompressed_size ? uncompressed_size : compressed_size * 4) /
+                    100);
+        }
+        m_poIndex = std::make_shared<VSIGZipIndex>();
     }
 }
 
@@ -558,18 +591,8 @@ VSIGZipHandle::~VSIGZipHandle()
     TRYFREE(inbuf);
     TRYFREE(outbuf);
 
-    if (snapshots != nullptr)
-    {
-        for (size_t i = 0; i < m_compressed_size / snapshot_byte_interval + 1;
-             i++)
-        {
-            if (snapshots[i].posInBaseHandle)
-            {
-                inflateEnd(&(snapshots[i].stream));
-            }
-        }
-        CPLFree(snapshots);
-    }
+    SaveIndexSidecar();
+
     CPLFree(m_pszBaseFileName);
 
     CloseBaseHandle();
@@ -728,6 +751,293 @@ int VSIGZipHandle::gzrewind()
     return m_poBaseHandle->Seek(startOff, SEEK_SET);
 }
 
+/************************************************************************/
+/*                      AddAccessPointIfNeeded()                        */
+/************************************************************************/
+
+// Must be called when inflate() has just stopped at a block boundary.
+// pStart is the start of the output not yet taken into account in crc.
+void VSIGZipHandle::AddAccessPointIfNeeded(const Bytef *pStart)
+{
+    const int nBits = stream.data_type & 7;
+    // The partially consumed byte must still be in the input buffer
+    if (nBits != 0 && stream.next_in == inbuf)
+        return;
+
+    std::lock_guard<std::mutex> oLock(m_poIndex->oMutex);
+    auto &aoPoints = m_poIndex->aoPoints;
+    auto oIter = std::lower_bound(
+        aoPoints.begin(), aoPoints.end(), out,
+        [](const VSIGZipAccessPoint &oPoint, vsi_l_offset nOffset)
+        { return oPoint.out < nOffset; });
+    if (oIter != aoPoints.end() && oIter->out - out < m_nIndexInterval)
+        return;
+    const vsi_l_offset nPrevOut =
+        oIter != aoPoints.begin() ? std::prev(oIter)->out : 0;
+    if (out - nPrevOut < m_nIndexInterval)
+        return;
+
+    VSIGZipAccessPoint oPoint;
+    oPoint.posInBaseHandle = m_poBaseHandle->Tell() - stream.avail_in;
+    oPoint.in = in;
+    oPoint.out = out;
+    oPoint.crc =
+        crc32(crc, pStart, static_cast<uInt>(stream.next_out - pStart));
+    oPoint.nBits = nBits;
+    oPoint.nPrevByte = nBits != 0 ? stream.next_in[-1] : 0;
+    uInt nWindowSize = 1U << MAX_WBITS;
+    oPoint.abyWindow.resize(nWindowSize);
+    if (inflateGetDictionary(&stream, oPoint.abyWindow.data(),
+                             &nWindowSize) != Z_OK)
+        return;
+    oPoint.abyWindow.resize(nWindowSize);
+#ifdef ENABLE_DEBUG
+    CPLDebug("GZIP",
+             "creating access point %d : posInBaseHandle=" CPL_FRMT_GUIB
+             " in=" CPL_FRMT_GUIB " out=" CPL_FRMT_GUIB " crc=%X",
+             static_cast<int>(oIter - aoPoints.begin()),
+             oPoint.posInBaseHandle, oPoint.in, oPoint.out,
+             static_cast<unsigned int>(oPoint.crc));
+#endif
+    aoPoints.insert(oIter, std::move(oPoint));
+    m_poIndex->bDirty = true;
+}
+
+/************************************************************************/
+/*                        RestoreAccessPoint()                          */
+/************************************************************************/
+
+// On failure, the decompression state is undefined and gzrewind() must be
+// called.
+bool VSIGZipHandle::RestoreAccessPoint(const VSIGZipAccessPoint &oPoint)
+{
+    if (m_poBaseHandle->Seek(oPoint.posInBaseHandle, SEEK_SET) != 0)
+        return false;
+    if (inflateReset(&stream) != Z_OK)
+        return false;
+    if (oPoint.nBits != 0 &&
+        inflatePrime(&stream, oPoint.nBits,
+                     oPoint.nPrevByte >> (8 - oPoint.nBits)) != Z_OK)
+        return false;
+    if (!oPoint.abyWindow.empty() &&
+        inflateSetDictionary(&stream, oPoint.abyWindow.data(),
+                             static_cast<uInt>(oPoint.abyWindow.size())) !=
+            Z_OK)
+        return false;
+    stream.avail_in = 0;
+    stream.next_in = inbuf;
+    z_err = Z_OK;
+    z_eof = 0;
+    crc = oPoint.crc;
+    in = oPoint.in;
+    out = oPoint.out;
+    return true;
+}
+
+/************************************************************************/
+/*                          UseSharedIndex()                            */
+/************************************************************************/
+
+// Share the access points with the other handles opened on the same stream,
+// identified by osKey, so that they are not computed again each time the
+// file is opened. If osSidecarFilename is not empty, the access points are
+// also read from this file, and saved into it when new ones are created.
+void VSIGZipHandle::UseSharedIndex(const std::string &osKey,
+                                   const std::string &osSidecarFilename)
+{
+    if (!m_poIndex)
+        return;
+
+    {
+        static std::mutex goMutex;
+        static lru11::Cache<std::string, std::shared_ptr<VSIGZipIndex>>
+            goCache(8, 0);
+        const std::string osCacheKey =
+            osKey + CPLSPrintf("|" CPL_FRMT_GUIB, m_compressed_size);
+        std::lock_guard<std::mutex> oLock(goMutex);
+        std::shared_ptr<VSIGZipIndex> poIndex;
+        if (goCache.tryGet(osCacheKey, poIndex))
+            m_poIndex = std::move(poIndex);
+        else
+            goCache.insert(osCacheKey, m_poIndex);
+    }
+
+    m_osIndexSidecarFilename = osSidecarFilename;
+    if (!m_osIndexSidecarFilename.empty())
+    {
+        bool bEmpty;
+        {
+            std::lock_guard<std::mutex> oLock(m_poIndex->oMutex);
+            bEmpty = m_poIndex->aoPoints.empty();
+        }
+        if (bEmpty)
+            LoadIndexSidecar();
+    }
+}
+
+/************************************************************************/
+/*                         LoadIndexSidecar()                           */
+/************************************************************************/
+
+// Layout of the .gzidx file (little-endian):
+// - magic: "GDAL_GZIP_INDEX_V1" (18 bytes)
+// - compressed size of the stream: uint64
+// - number of access points: uint32
+// - for each access point:
+//   * posInBaseHandle, in, out: 3 x uint64
+//   * crc: uint32
+//   * nBits, nPrevByte: 2 x uint8
+//   * window size: uint32, followed by the window bytes
+
+constexpr char GZIP_INDEX_MAGIC[] = "GDAL_GZIP_INDEX_V1";
+constexpr size_t GZIP_INDEX_MAGIC_SIZE = sizeof(GZIP_INDEX_MAGIC) - 1;
+
+bool VSIGZipHandle::LoadIndexSidecar()
+{
+    VSILFILE *fp = VSIFOpenL(m_osIndexSidecarFilename.c_str(), "rb");
+    if (fp == nullptr)
+        return false;
+
+    const auto ReadUInt64 = [fp](vsi_l_offset &nVal)
+    {
+        GUIntBig nTmp = 0;
+        if (VSIFReadL(&nTmp, sizeof(nTmp), 1, fp) != 1)
+            return false;
+        CPL_LSBPTR64(&nTmp);
+        nVal = nTmp;
+        return true;
+    };
+    const auto ReadUInt32 = [fp](GUInt32 &nVal)
+    {
+        if (VSIFReadL(&nVal, sizeof(nVal), 1, fp) != 1)
+            return false;
+        CPL_LSBPTR32(&nVal);
+        return true;
+    };
+
+    std::vector<VSIGZipAccessPoint> aoPoints;
+    bool bOK = false;
+    char szMagic[GZIP_INDEX_MAGIC_SIZE] = {};
+    vsi_l_offset nCompressedSize = 0;
+    GUInt32 nCount = 0;
+    if (VSIFReadL(szMagic, GZIP_INDEX_MAGIC_SIZE, 1, fp) == 1 &&
+        memcmp(szMagic, GZIP_INDEX_MAGIC, GZIP_INDEX_MAGIC_SIZE) == 0 &&
+        ReadUInt64(nCompressedSize) && nCompressedSize == m_compressed_size &&
+        ReadUInt32(nCount))
+    {
+        bOK = true;
+        for (GUInt32 i = 0; bOK && i < nCount; ++i)
+        {
+            VSIGZipAccessPoint oPoint;
+            GUInt32 nCRC = 0;
+            GByte abyBits[2] = {0, 0};
+            GUInt32 nWindowSize = 0;
+            bOK = ReadUInt64(oPoint.posInBaseHandle) && ReadUInt64(oPoint.in) &&
+                  ReadUInt64(oPoint.out) && ReadUInt32(nCRC) &&
+                  VSIFReadL(abyBits, 2, 1, fp) == 1 &&
+                  ReadUInt32(nWindowSize) && abyBits[0] < 8 &&
+                  nWindowSize <= (1U << MAX_WBITS) &&
+                  oPoint.posInBaseHandle >= startOff &&
+                  oPoint.posInBaseHandle <= startOff + m_compressed_size &&
+                  (aoPoints.empty() || oPoint.out > aoPoints.back().out);
+            if (bOK)
+            {
+                oPoint.crc = nCRC;
+                oPoint.nBits = abyBits[0];
+                oPoint.nPrevByte = abyBits[1];
+                oPoint.abyWindow.resize(nWindowSize);
+                bOK = nWindowSize == 0 ||
+                      VSIFReadL(oPoint.abyWindow.data(), nWindowSize, 1, fp) ==
+                          1;
+                aoPoints.push_back(std::move(oPoint));
+            }
+        }
+    }
+    VSIFCloseL(fp);
+
+    if (!bOK)
+    {
+        CPLDebug("GZIP", "Ignoring invalid index file %s",
+                 m_osIndexSidecarFilename.c_str());
+        return false;
+    }
+
+    std::lock_guard<std::mutex> oLock(m_poIndex->oMutex);
+    if (m_poIndex->aoPoints.empty())
+    {
+        m_poIndex->aoPoints = std::move(aoPoints);
+        m_poIndex->bDirty = false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                         SaveIndexSidecar()                           */
+/************************************************************************/
+
+void VSIGZipHandle::SaveIndexSidecar()
+{
+    if (m_osIndexSidecarFilename.empty() || !m_poIndex ||
+        STARTS_WITH_CI(m_osIndexSidecarFilename.c_str(), "/vsicurl/"))
+        return;
+
+    std::lock_guard<std::mutex> oLock(m_poIndex->oMutex);
+    if (!m_poIndex->bDirty)
+        return;
+    m_poIndex->bDirty = false;
+
+    VSILFILE *fp = nullptr;
+    {
+        CPLErrorStateBackuper oErrorStateBackuper;
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        fp = VSIFOpenL(m_osIndexSidecarFilename.c_str(), "wb");
+    }
+    if (fp == nullptr)
+    {
+        CPLDebug("GZIP", "Cannot create %s", m_osIndexSidecarFilename.c_str());
+        return;
+    }
+
+    const auto WriteUInt64 = [fp](vsi_l_offset nVal)
+    {
+        GUIntBig nTmp = nVal;
+        CPL_LSBPTR64(&nTmp);
+        return VSIFWriteL(&nTmp, sizeof(nTmp), 1, fp) == 1;
+    };
+    const auto WriteUInt32 = [fp](GUInt32 nVal)
+    {
+        CPL_LSBPTR32(&nVal);
+        return VSIFWriteL(&nVal, sizeof(nVal), 1, fp) == 1;
+    };
+
+    const auto &aoPoints = m_poIndex->aoPoints;
+    bool bOK =
+        VSIFWriteL(GZIP_INDEX_MAGIC, GZIP_INDEX_MAGIC_SIZE, 1, fp) == 1 &&
+        WriteUInt64(m_compressed_size) &&
+        WriteUInt32(static_cast<GUInt32>(aoPoints.size()));
+    for (size_t i = 0; bOK && i < aoPoints.size(); ++i)
+    {
+        const auto &oPoint = aoPoints[i];
+        const GByte abyBits[2] = {static_cast<GByte>(oPoint.nBits),
+                                  oPoint.nPrevByte};
+        bOK = WriteUInt64(oPoint.posInBaseHandle) && WriteUInt64(oPoint.in) &&
+              WriteUInt64(oPoint.out) &&
+              WriteUInt32(static_cast<GUInt32>(oPoint.crc)) &&
+              VSIFWriteL(abyBits, 2, 1, fp) == 1 &&
+              WriteUInt32(static_cast<GUInt32>(oPoint.abyWindow.size())) &&
+              (oPoint.abyWindow.empty() ||
+               VSIFWriteL(oPoint.abyWindow.data(), oPoint.abyWindow.size(), 1,
+                          fp) == 1);
+    }
+    if (VSIFCloseL(fp) != 0)
+        bOK = false;
+    if (!bOK)
+    {
+        CPLDebug("GZIP", "Cannot write %s", m_osIndexSidecarFilename.c_str());
+        VSIUnlink(m_osIndexSidecarFilename.c_str());
+    }
+}
+
 /************************************************************************/
 /*                              Seek()                                  */
 /************************************************************************/
@@ -856,40 +1166,41 @@ bool VSIGZipHandle::gzseek(vsi_l_offset offset, int whence)
         return false;
     }
 
-    for (unsigned int i = 0; i < m_compressed_size / snapshot_byte_interval + 1;
-         i++)
+    // Restart from the closest access point before the target offset, if
+    // it is after the current position.
+    if (m_poIndex)
     {
-        if (snapshots[i].posInBaseHandle == 0)
-            break;
-        if (snapshots[i].out <= out + offset &&
-            (i == m_compressed_size / snapshot_byte_interval ||
-             snapshots[i + 1].out == 0 || snapshots[i + 1].out > out + offset))
+        const vsi_l_offset nTarget = out + offset;
+        std::lock_guard<std::mutex> oLock(m_poIndex->oMutex);
+        const auto &aoPoints = m_poIndex->aoPoints;
+        auto oIter = std::upper_bound(
+            aoPoints.begin(), aoPoints.end(), nTarget,
+            [](vsi_l_offset nOffset, const VSIGZipAccessPoint &oPoint)
+            { return nOffset < oPoint.out; });
+        if (oIter != aoPoints.begin() && std::prev(oIter)->out > out)
         {
-            if (out >= snapshots[i].out)
-                break;
-
+            const auto &oPoint = *std::prev(oIter);
 #ifdef ENABLE_DEBUG
-            CPLDebug("SNAPSHOT",
-                     "using snapshot %d : "
-                     "posInBaseHandle(snapshot)=" CPL_FRMT_GUIB
-                     " in(snapshot)=" CPL_FRMT_GUIB
-                     " out(snapshot)=" CPL_FRMT_GUIB " out=" CPL_FRMT_GUIB
-                     " offset=" CPL_FRMT_GUIB,
-                     i, snapshots[i].posInBaseHandle, snapshots[i].in,
-                     snapshots[i].out, out, offset);
+            CPLDebug("GZIP",
+                     "using access point %d : "
+                     "posInBaseHandle=" CPL_FRMT_GUIB " in=" CPL_FRMT_GUIB
+                     " out=" CPL_FRMT_GUIB " target=" CPL_FRMT_GUIB,
+                     static_cast<int>(std::prev(oIter) - aoPoints.begin()),
+                     oPoint.posInBaseHandle, oPoint.in, oPoint.out, nTarget);
 #endif
-            offset = out + offset - snapshots[i].out;
-            if (m_poBaseHandle->Seek(snapshots[i].posInBaseHandle, SEEK_SET) !=
-                0)
-                CPLError(CE_Failure, CPLE_FileIO, "Seek() failed");
-
-            inflateEnd(&stream);
-            inflateCopy(&stream, &snapshots[i].stream);
-            crc = snapshots[i].crc;
-            m_transparent = snapshots[i].transparent;
-            in = snapshots[i].in;
-            out = snapshots[i].out;
-            break;
+            if (RestoreAccessPoint(oPoint))
+            {
+                offset = nTarget - out;
+            }
+            else if (gzrewind() < 0)
+            {
+                CPL_VSIL_GZ_RETURN(FALSE);
+                return false;
+            }
+            else
+            {
+                offset = nTarget;
+            }
         }
     }
 
@@ -1078,31 +1389,8 @@ size_t VSIGZipHandle::Read(void *const buf, size_t const nSize,
                 CPL_VSIL_GZ_RETURN(0);
                 return 0;
             }
-            GZipSnapshot *snapshot = &snapshots[(posInBaseHandle - startOff) /
-                                                snapshot_byte_interval];
-            if (snapshot->posInBaseHandle == 0)
-            {
-                snapshot->crc = crc32(
-                    crc, pStart, static_cast<uInt>(stream.next_out - pStart));
-#ifdef ENABLE_DEBUG
-                CPLDebug("SNAPSHOT",
-                         "creating snapshot %d : "
-                         "posInBaseHandle=" CPL_FRMT_GUIB " in=" CPL_FRMT_GUIB
-                         " out=" CPL_FRMT_GUIB " crc=%X",
-                         static_cast<int>((posInBaseHandle - startOff) /
-                                          snapshot_byte_interval),
-                         posInBaseHandle, in, out,
-                         static_cast<unsigned int>(snapshot->crc));
-#endif
-                snapshot->posInBaseHandle = posInBaseHandle;
-                inflateCopy(&snapshot->stream, &stream);
-                snapshot->transparent = m_transparent;
-                snapshot->in = in;
-                snapshot->out = out;
-
-                if (out > m_nLastReadOffset)
-                    m_nLastReadOffset = out;
-            }
+            if (out > m_nLastReadOffset)
+                m_nLastReadOffset = out;
 
             errno = 0;
             stream.avail_in =
@@ -1139,10 +1427,20 @@ size_t VSIGZipHandle::Read(void *const buf, size_t const nSize,
         }
         in += stream.avail_in;
         out += stream.avail_out;
-        z_err = inflate(&(stream), Z_NO_FLUSH);
+        // Stop at the end of each deflate block, where access points can be
+        // recorded. Once the input is exhausted, decode all remaining bits.
+        z_err = inflate(&(stream), z_eof ? Z_NO_FLUSH : Z_BLOCK);
         in -= stream.avail_in;
         out -= stream.avail_out;
 
+        // Bit 128 of data_type: end of block reached.
+        // Bit 64: last block of the stream.
+        if (z_err == Z_OK && (stream.data_type & 128) != 0 &&
+            (stream.data_type & 64) == 0)
+        {
+            AddAccessPointIfNeeded(pStart);
+        }
+
         if (z_err == Z_STREAM_END && m_compressed_size != 2)
         {
             // Check CRC and original size.
@@ -3077,6 +3375,18 @@ VSIGZipFilesystemHandler::OpenGZipReadOnly(const char *pszFilename,
         delete poHandle;
         return nullptr;
     }
+    // The modification time is part of the key, so that the access points
+    // of a file that has been rewritten are not reused.
+    VSIStatBufL sStat;
+    poHandle->UseSharedIndex(
+        CPLSPrintf("%s|" CPL_FRMT_GIB, pszFilename,
+                   poFSHandler->Stat(pszFilename + strlen("/vsigzip/"), &sStat,
+                                     0) == 0
+                       ? static_cast<GIntBig>(sStat.st_mtime)
+                       : 0),
+        CPLTestBool(CPLGetConfigOption("CPL_VSIL_GZIP_INDEX_SIDECAR", "NO"))
+            ? std::string(pszFilename + strlen("/vsigzip/")) + ".gzidx"
+            : std::string());
     return poHandle;
 }
 
@@ -3244,6 +3554,12 @@ const char *VSIGZipFilesystemHandler::GetOptions()
            "  <Option name='CPL_VSIL_DEFLATE_CHUNK_SIZE' type='string' "
            "description='Chunk of uncompressed data for parallelization. "
            "Use K(ilobytes) or M(egabytes) suffix' default='1M'/>"
+           "  <Option name='CPL_VSIL_GZIP_INDEX_INTERVAL' type='string' "
+           "description='Number of uncompressed bytes between two access "
+           "points used for seeking. Use K(ilobytes) or M(egabytes) suffix'/>"
+           "  <Option name='CPL_VSIL_GZIP_INDEX_SIDECAR' type='boolean' "
+           "description='Whether access points should be loaded from and "
+           "saved in a .gz.gzidx file' default='NO'/>"
            "</Options>";
 }
 
@@ -3663,6 +3979,30 @@ class VSISOZipHandle final : public VSIVirtualHandle
     z_stream sStream_{};
 #endif
 
+    // Multi-threaded decompression (GDAL_NUM_THREADS)
+    struct Chunk
+    {
+        VSISOZipHandle *poParent = nullptr;
+        std::vector<GByte> abyCompressedData{};
+        std::vector<GByte> abyData{};
+        bool bOK = false;
+        bool bDone = false; /* protected by poParent->oMutex_ */
+    };
+
+    int nThreads_ = 0;
+    std::unique_ptr<CPLWorkerThreadPool> poPool_{};
+    std::map<uint64_t, std::unique_ptr<Chunk>> oMapChunks_{};
+    std::mutex oMutex_{};
+    std::condition_variable oCV_{};
+    uint64_t nNextSequentialChunk_ = 0;
+
+    uint64_t ReadOffsetInCompressedStream(uint64_t nChunkIdx);
+    bool ReadCompressedChunk(uint64_t nChunkIdx,
+                             std::vector<GByte> &abyCompressedData);
+    size_t ReadMT(void *pBuffer, size_t nToRead);
+    void WaitChunk(Chunk &oChunk);
+    static void DecompressChunk(void *pData);
+
     VSISOZipHandle(const VSISOZipHandle &) = delete;
     VSISOZipHandle &operator=(const VSISOZipHandle &) = delete;
 
@@ -3720,6 +4060,16 @@ VSISOZipHandle::VSISOZipHandle(VSIVirtualHandle *poVirtualHandle,
     if (err != Z_OK)
         bOK_ = false;
 #endif
+
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", nullptr);
+    if (pszThreads)
+    {
+        if (EQUAL(pszThreads, "ALL_CPUS"))
+            nThreads_ = CPLGetNumCPUs();
+        else
+            nThreads_ = atoi(pszThreads);
+        nThreads_ = std::max(1, std::min(128, nThreads_));
+    }
 }
 
 /************************************************************************/
@@ -3728,6 +4078,8 @@ VSISOZipHandle::VSISOZipHandle(VSIVirtualHandle *poVirtualHandle,
 
 VSISOZipHandle::~VSISOZipHandle()
 {
+    if (poPool_)
+        poPool_->WaitCompletion();
     VSISOZipHandle::Close();
     if (bOK_)
     {
@@ -3802,89 +4154,25 @@ size_t VSISOZipHandle::Read(void *pBuffer, size_t nSize, size_t nCount)
         return 0;
     }
 
-    const auto ReadOffsetInCompressedStream =
-        [this](uint64_t nChunkIdx) -> uint64_t
+    const uint64_t nFirstChunk = nCurPos_ / nChunkSize_;
+    if (nThreads_ > 1 && nToRead > 0 &&
+        (nToRead > nChunkSize_ || nFirstChunk == nNextSequentialChunk_))
     {
-        if (nChunkIdx == 0)
-            return 0;
-        if (nChunkIdx == 1 + (uncompressed_size_ - 1) / nChunkSize_)
-            return compressed_size_;
-        constexpr size_t nOffsetSize = 8;
-        if (poBaseHandle_->Seek(indexPos_ + 32 + nToSkip_ +
-                                    (nChunkIdx - 1) * nOffsetSize,
-                                SEEK_SET) != 0)
-            return static_cast<uint64_t>(-1);
-
-        uint64_t nOffset;
-        if (poBaseHandle_->Read(&nOffset, sizeof(nOffset), 1) != 1)
-            return static_cast<uint64_t>(-1);
-        CPL_LSBPTR64(&nOffset);
-        return nOffset;
-    };
+        return ReadMT(pBuffer, nToRead);
+    }
 
     size_t nOffsetInOutputBuffer = 0;
+    std::vector<GByte> abyCompressedData;
     while (true)
     {
-        uint64_t nOffsetInCompressedStream =
-            ReadOffsetInCompressedStream(nCurPos_ / nChunkSize_);
-        if (nOffsetInCompressedStream == static_cast<uint64_t>(-1))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Cannot read nOffsetInCompressedStream");
-            return 0;
-        }
-        uint64_t nNextOffsetInCompressedStream =
-            ReadOffsetInCompressedStream(1 + nCurPos_ / nChunkSize_);
-        if (nNextOffsetInCompressedStream == static_cast<uint64_t>(-1))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Cannot read nNextOffsetInCompressedStream");
-            return 0;
-        }
-
-        if (nNextOffsetInCompressedStream <= nOffsetInCompressedStream ||
-            nNextOffsetInCompressedStream - nOffsetInCompressedStream >
-                13 + 2 * nChunkSize_ ||
-            nNextOffsetInCompressedStream > compressed_size_)
-        {
-            CPLError(
-                CE_Failure, CPLE_AppDefined,
-                "Invalid values for nOffsetInCompressedStream (" CPL_FRMT_GUIB
-                ") / "
-                "nNextOffsetInCompressedStream(" CPL_FRMT_GUIB ")",
-                static_cast<GUIntBig>(nOffsetInCompressedStream),
-                static_cast<GUIntBig>(nNextOffsetInCompressedStream));
-            return 0;
-        }
-
-        // CPLDebug("VSIZIP", "Seek to compressed data at offset "
-        // CPL_FRMT_GUIB, static_cast<GUIntBig>(nPosCompressedStream_ +
-        // nOffsetInCompressedStream));
-        if (poBaseHandle_->Seek(
-                nPosCompressedStream_ + nOffsetInCompressedStream, SEEK_SET) !=
-            0)
-            return 0;
-
-        const int nCompressedToRead = static_cast<int>(
-            nNextOffsetInCompressedStream - nOffsetInCompressedStream);
-        // CPLDebug("VSIZIP", "nCompressedToRead = %d", nCompressedToRead);
-        std::vector<GByte> abyCompressedData(nCompressedToRead);
-        if (poBaseHandle_->Read(&abyCompressedData[0], nCompressedToRead, 1) !=
-            1)
+        if (!ReadCompressedChunk(nCurPos_ / nChunkSize_, abyCompressedData))
             return 0;
+        const int nCompressedToRead =
+            static_cast<int>(abyCompressedData.size());
 
         size_t nToReadThisIter =
             std::min(nToRead, static_cast<size_t>(nChunkSize_));
 
-        if (nCompressedToRead >= 5 &&
-            abyCompressedData[nCompressedToRead - 5] == 0x00 &&
-            memcmp(&abyCompressedData[nCompressedToRead - 4],
-                   "\x00\x00\xFF\xFF", 4) == 0)
-        {
-            // Tag this flush block as the last one.
-            abyCompressedData[nCompressedToRead - 5] = 0x01;
-        }
-
 #ifdef HAVE_LIBDEFLATE
         size_t nOut = 0;
         if (libdeflate_deflate_decompress(
@@ -3946,10 +4234,247 @@ size_t VSISOZipHandle::Read(void *pBuffer, size_t nSize, size_t nCount)
         if (nToRead == 0)
             break;
     }
+    nNextSequentialChunk_ = (nCurPos_ + nChunkSize_ - 1) / nChunkSize_;
 
     return nCount;
 }
 
+/************************************************************************/
+/*                    ReadOffsetInCompressedStream()                    */
+/************************************************************************/
+
+uint64_t VSISOZipHandle::ReadOffsetInCompressedStream(uint64_t nChunkIdx)
+{
+    if (nChunkIdx == 0)
+        return 0;
+    if (nChunkIdx == 1 + (uncompressed_size_ - 1) / nChunkSize_)
+        return compressed_size_;
+    constexpr size_t nOffsetSize = 8;
+    if (poBaseHandle_->Seek(indexPos_ + 32 + nToSkip_ +
+                                (nChunkIdx - 1) * nOffsetSize,
+                            SEEK_SET) != 0)
+        return static_cast<uint64_t>(-1);
+
+    uint64_t nOffset;
+    if (poBaseHandle_->Read(&nOffset, sizeof(nOffset), 1) != 1)
+        return static_cast<uint64_t>(-1);
+    CPL_LSBPTR64(&nOffset);
+    return nOffset;
+}
+
+/************************************************************************/
+/*                        ReadCompressedChunk()                         */
+/************************************************************************/
+
+// Read the compressed data of a chunk, ready to be decompressed as a
+// complete deflate stream.
+bool VSISOZipHandle::ReadCompressedChunk(uint64_t nChunkIdx,
+                                         std::vector<GByte> &abyCompressedData)
+{
+    uint64_t nOffsetInCompressedStream =
+        ReadOffsetInCompressedStream(nChunkIdx);
+    if (nOffsetInCompressedStream == static_cast<uint64_t>(-1))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot read nOffsetInCompressedStream");
+        return false;
+    }
+    uint64_t nNextOffsetInCompressedStream =
+        ReadOffsetInCompressedStream(1 + nChunkIdx);
+    if (nNextOffsetInCompressedStream == static_cast<uint64_t>(-1))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot read nNextOffsetInCompressedStream");
+        return false;
+    }
+
+    if (nNextOffsetInCompressedStream <= nOffsetInCompressedStream ||
+        nNextOffsetInCompressedStream - nOffsetInCompressedStream >
+            13 + 2 * nChunkSize_ ||
+        nNextOffsetInCompressedStream > compressed_size_)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Invalid values for nOffsetInCompressedStream (" CPL_FRMT_GUIB
+                 ") / "
+                 "nNextOffsetInCompressedStream(" CPL_FRMT_GUIB ")",
+                 static_cast<GUIntBig>(nOffsetInCompressedStream),
+                 static_cast<GUIntBig>(nNextOffsetInCompressedStream));
+        return false;
+    }
+
+    // CPLDebug("VSIZIP", "Seek to compressed data at offset "
+    // CPL_FRMT_GUIB, static_cast<GUIntBig>(nPosCompressedStream_ +
+    // nOffsetInCompressedStream));
+    if (poBaseHandle_->Seek(nPosCompressedStream_ + nOffsetInCompressedStream,
+                            SEEK_SET) != 0)
+        return false;
+
+    const int nCompressedToRead = static_cast<int>(
+        nNextOffsetInCompressedStream - nOffsetInCompressedStream);
+    // CPLDebug("VSIZIP", "nCompressedToRead = %d", nCompressedToRead);
+    abyCompressedData.resize(nCompressedToRead);
+    if (poBaseHandle_->Read(&abyCompressedData[0], nCompressedToRead, 1) != 1)
+        return false;
+
+    if (nCompressedToRead >= 5 &&
+        abyCompressedData[nCompressedToRead - 5] == 0x00 &&
+        memcmp(&abyCompressedData[nCompressedToRead - 4], "\x00\x00\xFF\xFF",
+               4) == 0)
+    {
+        // Tag this flush block as the last one.
+        abyCompressedData[nCompressedToRead - 5] = 0x01;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                          DecompressChunk()                           */
+/************************************************************************/
+
+// Run in a worker thread.
+void VSISOZipHandle::DecompressChunk(void *pData)
+{
+    Chunk *psChunk = static_cast<Chunk *>(pData);
+    auto &abyCompressedData = psChunk->abyCompressedData;
+    auto &abyData = psChunk->abyData;
+
+#ifdef HAVE_LIBDEFLATE
+    struct libdeflate_decompressor *pDecompressor =
+        libdeflate_alloc_decompressor();
+    if (pDecompressor)
+    {
+        size_t nOut = 0;
+        psChunk->bOK = libdeflate_deflate_decompress(
+                           pDecompressor, abyCompressedData.data(),
+                           abyCompressedData.size(), abyData.data(),
+                           abyData.size(), &nOut) == LIBDEFLATE_SUCCESS &&
+                       nOut == abyData.size();
+        libdeflate_free_decompressor(pDecompressor);
+    }
+#else
+    z_stream sStream;
+    memset(&sStream, 0, sizeof(sStream));
+    if (inflateInit2(&sStream, -MAX_WBITS) == Z_OK)
+    {
+        sStream.avail_in = static_cast<uInt>(abyCompressedData.size());
+        sStream.next_in = abyCompressedData.data();
+        sStream.avail_out = static_cast<uInt>(abyData.size());
+        sStream.next_out = abyData.data();
+        const int err = inflate(&sStream, Z_FINISH);
+        psChunk->bOK =
+            (err == Z_OK || err == Z_STREAM_END) && sStream.avail_out == 0;
+        inflateEnd(&sStream);
+    }
+#endif
+    abyCompressedData = std::vector<GByte>();
+
+    VSISOZipHandle *poParent = psChunk->poParent;
+    {
+        std::lock_guard<std::mutex> oLock(poParent->oMutex_);
+        psChunk->bDone = true;
+    }
+    poParent->oCV_.notify_all();
+}
+
+/************************************************************************/
+/*                             WaitChunk()                              */
+/************************************************************************/
+
+void VSISOZipHandle::WaitChunk(Chunk &oChunk)
+{
+    std::unique_lock<std::mutex> oLock(oMutex_);
+    oCV_.wait(oLock, [&oChunk] { return oChunk.bDone; });
+}
+
+/************************************************************************/
+/*                              ReadMT()                                */
+/************************************************************************/
+
+// Decompress the chunks of the requested range in parallel. When reading
+// sequentially, also start decompressing the next nThreads_ chunks, so that
+// they are ready for the next call.
+size_t VSISOZipHandle::ReadMT(void *pBuffer, size_t nToRead)
+{
+    if (poPool_ == nullptr)
+    {
+        poPool_.reset(new CPLWorkerThreadPool());
+        if (!poPool_->Setup(nThreads_, nullptr, nullptr, false))
+        {
+            poPool_.reset();
+            nThreads_ = 1;
+            return Read(pBuffer, 1, nToRead);
+        }
+    }
+
+    const uint64_t nChunkCount = 1 + (uncompressed_size_ - 1) / nChunkSize_;
+    const uint64_t nFirstChunk = nCurPos_ / nChunkSize_;
+    const uint64_t nLastChunk = 1 + (nCurPos_ + nToRead - 1) / nChunkSize_;
+    const uint64_t nEndChunk =
+        nFirstChunk == nNextSequentialChunk_
+            ? std::min(nChunkCount, nLastChunk + nThreads_)
+            : nLastChunk;
+
+    // Discard chunks decompressed ahead that are no longer relevant.
+    for (auto oIter = oMapChunks_.begin(); oIter != oMapChunks_.end();)
+    {
+        if (oIter->first < nFirstChunk || oIter->first >= nEndChunk)
+        {
+            WaitChunk(*(oIter->second));
+            oIter = oMapChunks_.erase(oIter);
+        }
+        else
+        {
+            ++oIter;
+        }
+    }
+
+    for (uint64_t nChunkIdx = nFirstChunk; nChunkIdx < nEndChunk; ++nChunkIdx)
+    {
+        if (oMapChunks_.find(nChunkIdx) != oMapChunks_.end())
+            continue;
+        auto poChunk = std::make_unique<Chunk>();
+        poChunk->poParent = this;
+        if (!ReadCompressedChunk(nChunkIdx, poChunk->abyCompressedData))
+        {
+            if (nChunkIdx < nLastChunk)
+                return 0;
+            break;
+        }
+        poChunk->abyData.resize(static_cast<size_t>(
+            nChunkIdx + 1 == nChunkCount
+                ? uncompressed_size_ - nChunkIdx * nChunkSize_
+                : nChunkSize_));
+        poPool_->SubmitJob(DecompressChunk, poChunk.get());
+        oMapChunks_[nChunkIdx] = std::move(poChunk);
+    }
+
+    size_t nOffsetInOutputBuffer = 0;
+    for (uint64_t nChunkIdx = nFirstChunk; nChunkIdx < nLastChunk; ++nChunkIdx)
+    {
+        auto oIter = oMapChunks_.find(nChunkIdx);
+        CPLAssert(oIter != oMapChunks_.end());
+        Chunk &oChunk = *(oIter->second);
+        WaitChunk(oChunk);
+        if (!oChunk.bOK)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Decompression failed at pos " CPL_FRMT_GUIB,
+                     static_cast<GUIntBig>(nChunkIdx * nChunkSize_));
+            oMapChunks_.erase(oIter);
+            return 0;
+        }
+        memcpy(static_cast<GByte *>(pBuffer) + nOffsetInOutputBuffer,
+               oChunk.abyData.data(), oChunk.abyData.size());
+        nOffsetInOutputBuffer += oChunk.abyData.size();
+        oMapChunks_.erase(oIter);
+    }
+    CPLAssert(nOffsetInOutputBuffer == nToRead);
+
+    nCurPos_ += nToRead;
+    nNextSequentialChunk_ = nLastChunk;
+    return nToRead;
+}
+
 /************************************************************************/
 /*                          GetFileInfo()                               */
 /************************************************************************/
@@ -4271,6 +4796,11 @@ VSIVirtualHandle *VSIZipFilesystemHandler::Open(const char *pszFilename,
             delete poGZIPHandle;
             return nullptr;
         }
+        // Reuse the access points of previous opening of the same member.
+        poGZIPHandle->UseSharedIndex(
+            CPLSPrintf("%s|%u", pszFilename,
+                       static_cast<unsigned>(info.nCRC)),
+            std::string());
 
         // Wrap the VSIGZipHandle inside a buffered reader that will
         // improve dramatically performance when doing small backward
@@ -4570,11 +5100,15 @@ const char *VSIZipFilesystemHandler::GetOptions()
 {
     return "<Options>"
            "  <Option name='GDAL_NUM_THREADS' type='string' "
-           "description='Number of threads for compression. Either a integer "
+           "description='Number of threads for compression, and "
+           "decompression of SOZip-enabled files. Either a integer "
            "or ALL_CPUS'/>"
            "  <Option name='CPL_VSIL_DEFLATE_CHUNK_SIZE' type='string' "
            "description='Chunk of uncompressed data for parallelization. "
            "Use K(ilobytes) or M(egabytes) suffix' default='1M'/>"
+           "  <Option name='CPL_VSIL_GZIP_INDEX_INTERVAL' type='string' "
+           "description='Number of uncompressed bytes between two access "
+           "points used for seeking. Use K(ilobytes) or M(egabytes) suffix'/>"
            "</Options>";
 }
 
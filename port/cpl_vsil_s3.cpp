@@ -779,6 +779,19 @@ VSIS3WriteHandle::VSIS3WriteHandle(IVSIS3LikeFSHandler *poFS,
                      "Cannot allocate working buffer for %s",
                      m_poFS->GetFSPrefix().c_str());
         }
+
+        // Number of parts that can be uploaded at the same time, while the
+        // caller keeps on filling a new buffer. Each of them requires its
+        // own buffer.
+        if (poFS->SupportsParallelMultipartUpload())
+        {
+            constexpr int MAX_PARALLEL_PARTS = 64;
+            m_nMaxParallelParts = std::max(
+                1, std::min(MAX_PARALLEL_PARTS,
+                            atoi(VSIGetPathSpecificOption(
+                                pszFilename,
+                                "CPL_VSIL_CURL_UPLOAD_PARALLEL_PARTS", "1"))));
+        }
     }
 }
 
@@ -791,6 +804,10 @@ VSIS3WriteHandle::~VSIS3WriteHandle()
     VSIS3WriteHandle::Close();
     delete m_poS3HandleHelper;
     CPLFree(m_pabyBuffer);
+    m_poJobQueue.reset();
+    m_poThreadPool.reset();
+    for (GByte *pabyBuffer : m_apabyFreeBuffers)
+        CPLFree(pabyBuffer);
     if (m_hCurlMulti)
     {
         if (m_hCurl)
@@ -952,6 +969,22 @@ std::string IVSIS3LikeFSHandler::InitiateMultipartUpload(
     return osUploadID;
 }
 
+/************************************************************************/
+/*                           PartUploadJob                              */
+/************************************************************************/
+
+struct VSIS3WriteHandle::PartUploadJob
+{
+    VSIS3WriteHandle *poHandle = nullptr;
+    int nPartNumber = 0;
+    GByte *pabyBuffer = nullptr;
+    size_t nBufferSize = 0;
+    // UploadPart() modifies the query parameters of the handle helper, so
+    // each job needs its own one.
+    std::unique_ptr<IVSIS3LikeHandleHelper> poS3HandleHelper{};
+    CPLStringList aosThreadLocalConfigOptions{};
+};
+
 /************************************************************************/
 /*                           UploadPart()                               */
 /************************************************************************/
@@ -970,6 +1003,72 @@ bool VSIS3WriteHandle::UploadPart()
             knMAX_PART_NUMBER, m_osFilename.c_str());
         return false;
     }
+
+    if (m_nMaxParallelParts > 1 && !m_poJobQueue)
+    {
+        auto poThreadPool = std::make_unique<CPLWorkerThreadPool>();
+        if (poThreadPool->Setup(m_nMaxParallelParts, nullptr, nullptr))
+        {
+            m_poJobQueue = poThreadPool->CreateJobQueue();
+            m_poThreadPool = std::move(poThreadPool);
+        }
+        else
+        {
+            m_nMaxParallelParts = 1;
+        }
+    }
+
+    if (m_poJobQueue)
+    {
+        // Do not have more than m_nMaxParallelParts parts being uploaded at
+        // once, so that memory usage remains bounded if the network is
+        // slower than the writer.
+        m_poJobQueue->WaitCompletion(m_nMaxParallelParts - 1);
+        if (!CollectPartUploadResults())
+            return false;
+
+        auto psJob = std::make_unique<PartUploadJob>();
+        psJob->poS3HandleHelper.reset(m_poFS->CreateHandleHelper(
+            m_osFilename.c_str() + m_poFS->GetFSPrefix().size(), false));
+        if (!psJob->poS3HandleHelper)
+            return false;
+
+        GByte *pabyNewBuffer = nullptr;
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            m_aosEtags.resize(m_nPartNumber);
+            if (!m_apabyFreeBuffers.empty())
+            {
+                pabyNewBuffer = m_apabyFreeBuffers.back();
+                m_apabyFreeBuffers.pop_back();
+            }
+        }
+        if (pabyNewBuffer == nullptr)
+        {
+            pabyNewBuffer =
+                static_cast<GByte *>(VSI_MALLOC_VERBOSE(m_nBufferSize));
+            if (pabyNewBuffer == nullptr)
+                return false;
+        }
+
+        psJob->poHandle = this;
+        psJob->nPartNumber = m_nPartNumber;
+        psJob->pabyBuffer = m_pabyBuffer;
+        psJob->nBufferSize = m_nBufferOff;
+        psJob->aosThreadLocalConfigOptions.Assign(
+            CPLGetThreadLocalConfigOptions(), true);
+        m_pabyBuffer = pabyNewBuffer;
+        m_nBufferOff = 0;
+        if (!m_poJobQueue->SubmitJob(UploadPartJob, psJob.get()))
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            m_apabyFreeBuffers.push_back(psJob->pabyBuffer);
+            return false;
+        }
+        psJob.release();
+        return true;
+    }
+
     const std::string osEtag = m_poFS->UploadPart(
         m_osFilename, m_nPartNumber, m_osUploadID,
         static_cast<vsi_l_offset>(m_nBufferSize) * (m_nPartNumber - 1),
@@ -983,6 +1082,76 @@ bool VSIS3WriteHandle::UploadPart()
     return !osEtag.empty();
 }
 
+/************************************************************************/
+/*                           UploadPartJob()                            */
+/************************************************************************/
+
+void VSIS3WriteHandle::UploadPartJob(void *pData)
+{
+    std::unique_ptr<PartUploadJob> psJob(static_cast<PartUploadJob *>(pData));
+    VSIS3WriteHandle *poThis = psJob->poHandle;
+
+    CPLStringList aosOldConfigOptions(CPLGetThreadLocalConfigOptions(), true);
+    CPLSetThreadLocalConfigOptions(psJob->aosThreadLocalConfigOptions.List());
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors;
+    CPLInstallErrorHandlerAccumulator(aoErrors);
+
+    const std::string osEtag = poThis->m_poFS->UploadPart(
+        poThis->m_osFilename, psJob->nPartNumber, poThis->m_osUploadID,
+        static_cast<vsi_l_offset>(poThis->m_nBufferSize) *
+            (psJob->nPartNumber - 1),
+        psJob->pabyBuffer, psJob->nBufferSize, psJob->poS3HandleHelper.get(),
+        poThis->m_nMaxRetry, poThis->m_dfRetryDelay, nullptr);
+
+    CPLUninstallErrorHandlerAccumulator();
+    CPLSetThreadLocalConfigOptions(aosOldConfigOptions.List());
+
+    std::lock_guard<std::mutex> oLock(poThis->m_oMutex);
+    if (osEtag.empty())
+        poThis->m_bPartUploadError = true;
+    else
+        poThis->m_aosEtags[psJob->nPartNumber - 1] = osEtag;
+    poThis->m_apabyFreeBuffers.push_back(psJob->pabyBuffer);
+    for (auto &oError : aoErrors)
+        poThis->m_aoPartUploadErrors.emplace_back(std::move(oError));
+}
+
+/************************************************************************/
+/*                      CollectPartUploadResults()                      */
+/************************************************************************/
+
+// Re-emit in the calling thread the errors of the part uploads completed so
+// far, and return whether all of them succeeded.
+bool VSIS3WriteHandle::CollectPartUploadResults()
+{
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors;
+    bool bPartUploadError;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        std::swap(aoErrors, m_aoPartUploadErrors);
+        bPartUploadError = m_bPartUploadError;
+    }
+    for (const auto &oError : aoErrors)
+    {
+        CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+    }
+    return !bPartUploadError;
+}
+
+/************************************************************************/
+/*                         FinishPartUploads()                          */
+/************************************************************************/
+
+// Wait for the parts being uploaded asynchronously, and return whether all
+// uploads succeeded.
+bool VSIS3WriteHandle::FinishPartUploads()
+{
+    if (!m_poJobQueue)
+        return true;
+    m_poJobQueue->WaitCompletion();
+    return CollectPartUploadResults();
+}
+
 std::string IVSIS3LikeFSHandler::UploadPart(
     const std::string &osFilename, int nPartNumber,
     const std::string &osUploadID, vsi_l_offset /* nPosition */,
@@ -2013,14 +2182,18 @@ int VSIS3WriteHandle::Close()
         }
         else
         {
-            if (m_bError)
+            const bool bPartUploadsOK = FinishPartUploads();
+            if (m_bError || !bPartUploadsOK)
             {
+                if (!bPartUploadsOK)
+                    nRet = -1;
                 if (!m_poFS->AbortMultipart(m_osFilename, m_osUploadID,
                                             m_poS3HandleHelper, m_nMaxRetry,
                                             m_dfRetryDelay))
                     nRet = -1;
             }
-            else if (m_nBufferOff > 0 && !UploadPart())
+            else if (m_nBufferOff > 0 &&
+                     (!UploadPart() || !FinishPartUploads()))
                 nRet = -1;
             else if (m_poFS->CompleteMultipart(
                          m_osFilename, m_osUploadID, m_aosEtags, m_nCurOffset,
@@ -81,6 +81,11 @@
 #ifdef HAVE_PREAD_BSD
 #include <sys/uio.h>
 #endif
+#ifdef HAVE_LINUX_IO_URING_H
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
 
 #if defined(__MACH__) && defined(__APPLE__)
 #define HAS_CASE_INSENSITIVE_FILE_SYSTEM
@@ -89,8 +94,11 @@
 #include <limits.h>
 #endif
 
+#include <algorithm>
 #include <limits>
+#include <memory>
 #include <new>
+#include <vector>
 
 #include "cpl_config.h"
 #include "cpl_conv.h"
@@ -155,6 +163,299 @@ static_assert(sizeof(VSIStatBufL::st_size) == sizeof(vsi_l_offset),
               "add the -DBUILD_WITHOUT_64BIT_OFFSET define");
 #endif
 
+#if defined(HAVE_LINUX_IO_URING_H) && defined(__NR_io_uring_setup) &&      \
+    defined(__NR_io_uring_enter)
+#define HAVE_VSI_IO_URING
+
+/************************************************************************/
+/* ==================================================================== */
+/*                             VSIIOUring                               */
+/* ==================================================================== */
+/************************************************************************/
+
+// Minimal wrapper over the io_uring system calls, used to submit a batch of
+// positioned reads on a file descriptor and wait for all of them.
+// One instance is used per thread, so no locking is needed.
+
+class VSIIOUring
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSIIOUring)
+
+    int m_fd = -1;
+    unsigned m_nEntries = 0;
+
+    void *m_pSQRing = nullptr;
+    size_t m_nSQRingSize = 0;
+    void *m_pCQRing = nullptr;
+    size_t m_nCQRingSize = 0;
+    struct io_uring_sqe *m_pasSQEs = nullptr;
+    size_t m_nSQEsSize = 0;
+
+    unsigned *m_pnSQTail = nullptr;
+    unsigned m_nSQMask = 0;
+    unsigned *m_panSQArray = nullptr;
+    unsigned *m_pnCQHead = nullptr;
+    unsigned *m_pnCQTail = nullptr;
+    unsigned m_nCQMask = 0;
+    struct io_uring_cqe *m_pasCQEs = nullptr;
+
+    int Enter(unsigned nToSubmit, unsigned nMinComplete);
+    unsigned ReapCompletions(std::vector<int> &anResults);
+
+  public:
+    VSIIOUring() = default;
+    ~VSIIOUring();
+
+    bool Init(unsigned nEntries);
+
+    bool Read(int fd, int nRanges, void **ppData,
+              const vsi_l_offset *panOffsets, const size_t *panSizes,
+              std::vector<int> &anResults);
+};
+
+/************************************************************************/
+/*                            ~VSIIOUring()                             */
+/************************************************************************/
+
+VSIIOUring::~VSIIOUring()
+{
+    if (m_pasSQEs)
+        munmap(m_pasSQEs, m_nSQEsSize);
+    if (m_pCQRing && m_pCQRing != m_pSQRing)
+        munmap(m_pCQRing, m_nCQRingSize);
+    if (m_pSQRing)
+        munmap(m_pSQRing, m_nSQRingSize);
+    if (m_fd >= 0)
+        close(m_fd);
+}
+
+/************************************************************************/
+/*                               Init()                                 */
+/************************************************************************/
+
+bool VSIIOUring::Init(unsigned nEntries)
+{
+    struct io_uring_params sParams;
+    memset(&sParams, 0, sizeof(sParams));
+    m_fd = static_cast<int>(syscall(__NR_io_uring_setup, nEntries, &sParams));
+    if (m_fd < 0)
+    {
+        CPLDebug("VSI", "io_uring_setup() failed: %s", strerror(errno));
+        return false;
+    }
+
+    m_nSQRingSize =
+        sParams.sq_off.array + sParams.sq_entries * sizeof(unsigned);
+    m_nCQRingSize =
+        sParams.cq_off.cqes + sParams.cq_entries * sizeof(struct io_uring_cqe);
+#ifdef IORING_FEAT_SINGLE_MMAP
+    const bool bSingleMMap = (sParams.features & IORING_FEAT_SINGLE_MMAP) != 0;
+#else
+    const bool bSingleMMap = false;
+#endif
+    if (bSingleMMap)
+    {
+        m_nSQRingSize = std::max(m_nSQRingSize, m_nCQRingSize);
+        m_nCQRingSize = m_nSQRingSize;
+    }
+
+    void *pSQRing = mmap(nullptr, m_nSQRingSize, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+    if (pSQRing == MAP_FAILED)
+        return false;
+    m_pSQRing = pSQRing;
+
+    if (bSingleMMap)
+    {
+        m_pCQRing = m_pSQRing;
+    }
+    else
+    {
+        void *pCQRing =
+            mmap(nullptr, m_nCQRingSize, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+        if (pCQRing == MAP_FAILED)
+            return false;
+        m_pCQRing = pCQRing;
+    }
+
+    m_nSQEsSize = sParams.sq_entries * sizeof(struct io_uring_sqe);
+    void *pSQEs = mmap(nullptr, m_nSQEsSize, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES);
+    if (pSQEs == MAP_FAILED)
+        return false;
+    m_pasSQEs = static_cast<struct io_uring_sqe *>(pSQEs);
+
+    GByte *pabySQ = static_cast<GByte *>(m_pSQRing);
+    m_pnSQTail = reinterpret_cast<unsigned *>(pabySQ + sParams.sq_off.tail);
+    m_nSQMask =
+        *reinterpret_cast<unsigned *>(pabySQ + sParams.sq_off.ring_mask);
+    m_panSQArray = reinterpret_cast<unsigned *>(pabySQ + sParams.sq_off.array);
+
+    GByte *pabyCQ = static_cast<GByte *>(m_pCQRing);
+    m_pnCQHead = reinterpret_cast<unsigned *>(pabyCQ + sParams.cq_off.head);
+    m_pnCQTail = reinterpret_cast<unsigned *>(pabyCQ + sParams.cq_off.tail);
+    m_nCQMask =
+        *reinterpret_cast<unsigned *>(pabyCQ + sParams.cq_off.ring_mask);
+    m_pasCQEs =
+        reinterpret_cast<struct io_uring_cqe *>(pabyCQ + sParams.cq_off.cqes);
+
+    m_nEntries = sParams.sq_entries;
+    return true;
+}
+
+/************************************************************************/
+/*                               Enter()                                */
+/************************************************************************/
+
+int VSIIOUring::Enter(unsigned nToSubmit, unsigned nMinComplete)
+{
+    while (true)
+    {
+        const int ret = static_cast<int>(
+            syscall(__NR_io_uring_enter, m_fd, nToSubmit, nMinComplete,
+                    IORING_ENTER_GETEVENTS, nullptr, 0));
+        if (ret >= 0 || errno != EINTR)
+            return ret;
+    }
+}
+
+/************************************************************************/
+/*                          ReapCompletions()                           */
+/************************************************************************/
+
+unsigned VSIIOUring::ReapCompletions(std::vector<int> &anResults)
+{
+    unsigned nHead = *m_pnCQHead;
+    const unsigned nTail = __atomic_load_n(m_pnCQTail, __ATOMIC_ACQUIRE);
+    unsigned nReaped = 0;
+    while (nHead != nTail)
+    {
+        const struct io_uring_cqe *psCQE = &m_pasCQEs[nHead & m_nCQMask];
+        anResults[static_cast<size_t>(psCQE->user_data)] = psCQE->res;
+        ++nHead;
+        ++nReaped;
+    }
+    __atomic_store_n(m_pnCQHead, nHead, __ATOMIC_RELEASE);
+    return nReaped;
+}
+
+/************************************************************************/
+/*                                Read()                                */
+/************************************************************************/
+
+// Submits the reads in batches of at most m_nEntries requests (so that the
+// submission queue can never overflow), and waits for each batch to
+// complete before submitting the next one. anResults[i] receives the
+// number of bytes read for range i, or a negative errno value.
+// Returns false if the ring is no longer usable.
+
+bool VSIIOUring::Read(int fd, int nRanges, void **ppData,
+                      const vsi_l_offset *panOffsets, const size_t *panSizes,
+                      std::vector<int> &anResults)
+{
+    anResults.assign(nRanges, 0);
+    for (int iStart = 0; iStart < nRanges;)
+    {
+        const unsigned nBatch =
+            std::min(m_nEntries, static_cast<unsigned>(nRanges - iStart));
+        unsigned nSQTail = *m_pnSQTail;
+        for (unsigned i = 0; i < nBatch; ++i)
+        {
+            const int iRange = iStart + static_cast<int>(i);
+            const unsigned nIdx = nSQTail & m_nSQMask;
+            struct io_uring_sqe *psSQE = &m_pasSQEs[nIdx];
+            memset(psSQE, 0, sizeof(*psSQE));
+            psSQE->opcode = IORING_OP_READ;
+            psSQE->fd = fd;
+            psSQE->addr = static_cast<uint64_t>(
+                reinterpret_cast<uintptr_t>(ppData[iRange]));
+            psSQE->len = static_cast<unsigned>(panSizes[iRange]);
+            psSQE->off = static_cast<uint64_t>(panOffsets[iRange]);
+            psSQE->user_data = static_cast<uint64_t>(iRange);
+            m_panSQArray[nIdx] = nIdx;
+            ++nSQTail;
+        }
+        __atomic_store_n(m_pnSQTail, nSQTail, __ATOMIC_RELEASE);
+
+        unsigned nSubmitted = 0;
+        unsigned nCompleted = 0;
+        bool bOK = true;
+        while (nCompleted < nBatch)
+        {
+            const unsigned nToSubmit = bOK ? nBatch - nSubmitted : 0;
+            if (!bOK && nCompleted == nSubmitted)
+                break;
+            const int ret = Enter(nToSubmit, 1);
+            if (ret < 0)
+            {
+                if (!bOK)
+                    break;
+                CPLDebug("VSI", "io_uring_enter() failed: %s",
+                         strerror(errno));
+                // Wait for the requests already in flight, as they write
+                // into the caller buffers.
+                bOK = false;
+                continue;
+            }
+            nSubmitted += std::min(static_cast<unsigned>(ret), nToSubmit);
+            nCompleted += ReapCompletions(anResults);
+        }
+        if (!bOK)
+            return false;
+
+        iStart += static_cast<int>(nBatch);
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                       VSIIOUringIsEnabled()                          */
+/************************************************************************/
+
+static bool VSIIOUringIsEnabled()
+{
+    return CPLTestBool(CPLGetConfigOption("CPL_VSIL_UNIX_USE_IO_URING", "NO"));
+}
+
+/************************************************************************/
+/*                        VSIGetThreadIOUring()                         */
+/************************************************************************/
+
+static thread_local std::unique_ptr<VSIIOUring> tlpoIOUring;
+static thread_local bool tlbIOUringInitFailed = false;
+
+// Returns the ring of the current thread, creating it on first use.
+// Returns nullptr if io_uring is not available on the running kernel.
+
+static VSIIOUring *VSIGetThreadIOUring()
+{
+    constexpr unsigned QUEUE_DEPTH = 64;
+    if (!tlpoIOUring && !tlbIOUringInitFailed)
+    {
+        auto poRing = std::make_unique<VSIIOUring>();
+        if (poRing->Init(QUEUE_DEPTH))
+            tlpoIOUring = std::move(poRing);
+        else
+            tlbIOUringInitFailed = true;
+    }
+    return tlpoIOUring.get();
+}
+
+/************************************************************************/
+/*                       VSIReleaseThreadIOUring()                      */
+/************************************************************************/
+
+// Destroys the ring of the current thread after an unrecoverable error.
+// A new one will be created on next use.
+
+static void VSIReleaseThreadIOUring()
+{
+    tlpoIOUring.reset();
+}
+
+#endif  // HAVE_VSI_IO_URING
+
 /************************************************************************/
 /* ==================================================================== */
 /*                       VSIUnixStdioFilesystemHandler                  */
@@ -188,6 +489,9 @@ class VSIUnixStdioFilesystemHandler final : public VSIFilesystemHandler
     char **ReadDirEx(const char *pszDirname, int nMaxFiles) override;
     GIntBig GetDiskFreeSpace(const char *pszDirname) override;
     int SupportsSparseFiles(const char *pszPath) override;
+#ifdef HAVE_VSI_IO_URING
+    int HasOptimizedReadMultiRange(const char * /* pszPath */) override;
+#endif
 
     bool IsLocal(const char *pszPath) override;
     bool SupportsSequentialWrite(const char *pszPath,
@@ -256,6 +560,18 @@ class VSIUnixStdioHandle final : public VSIVirtualHandle
     size_t PRead(void * /*pBuffer*/, size_t /* nSize */,
                  vsi_l_offset /*nOffset*/) const override;
 #endif
+#ifdef HAVE_VSI_IO_URING
+    int ReadMultiRange(int nRanges, void **ppData,
+                       const vsi_l_offset *panOffsets,
+                       const size_t *panSizes) override;
+    std::unique_ptr<VSIAsyncReadRequest>
+    ReadMultiRangeAsync(int nRanges, void **ppData,
+                        const vsi_l_offset *panOffsets, const size_t *panSizes,
+                        VSIAsyncReadCallback pfnCallback,
+                        void *pUserData) override;
+    void AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
+                    const size_t *panSizes) override;
+#endif
 };
 
 /************************************************************************/
@@ -663,6 +979,108 @@ size_t VSIUnixStdioHandle::PRead(void *pBuffer, size_t nSize,
 }
 #endif
 
+#ifdef HAVE_VSI_IO_URING
+
+/************************************************************************/
+/*                           ReadMultiRange()                           */
+/************************************************************************/
+
+int VSIUnixStdioHandle::ReadMultiRange(int nRanges, void **ppData,
+                                       const vsi_l_offset *panOffsets,
+                                       const size_t *panSizes)
+{
+    // Pending writes might still be in the stdio buffer, so only use the
+    // ring on read-only handles.
+    if (!bReadOnly || nRanges <= 0 || !VSIIOUringIsEnabled())
+        return VSIVirtualHandle::ReadMultiRange(nRanges, ppData, panOffsets,
+                                                panSizes);
+    // Ranges are read with io_uring or pread() only, so that concurrent
+    // calls on the same handle, such as from ReadMultiRangeAsync(), are safe.
+    const int fd = fileno(fp);
+    std::vector<int> anResults(nRanges, 0);
+    bool bUseRing = true;
+    for (int i = 0; i < nRanges; ++i)
+    {
+        if (panSizes[i] >
+            static_cast<size_t>(std::numeric_limits<int>::max()))
+            bUseRing = false;
+    }
+    VSIIOUring *poRing = bUseRing ? VSIGetThreadIOUring() : nullptr;
+    if (poRing &&
+        !poRing->Read(fd, nRanges, ppData, panOffsets, panSizes, anResults))
+    {
+        VSIReleaseThreadIOUring();
+        anResults.assign(nRanges, 0);
+    }
+
+    // Complete short reads, and retry failed requests (for example on
+    // kernels that do not support IORING_OP_READ), with pread(). This is
+    // also the path taken if no ring is available.
+    for (int i = 0; i < nRanges; ++i)
+    {
+        size_t nDone = anResults[i] > 0 ? static_cast<size_t>(anResults[i]) : 0;
+        while (nDone < panSizes[i])
+        {
+            GByte *pabyDst = static_cast<GByte *>(ppData[i]) + nDone;
+#ifdef HAVE_PREAD64
+            const ssize_t nRead = pread64(fd, pabyDst, panSizes[i] - nDone,
+                                          panOffsets[i] + nDone);
+#else
+            const ssize_t nRead =
+                pread(fd, pabyDst, panSizes[i] - nDone,
+                      static_cast<off_t>(panOffsets[i] + nDone));
+#endif
+            if (nRead < 0 && errno == EINTR)
+                continue;
+            if (nRead <= 0)
+                return -1;
+            nDone += static_cast<size_t>(nRead);
+        }
+#ifdef VSI_COUNT_BYTES_READ
+        nTotalBytesRead += panSizes[i];
+#endif
+    }
+
+    return 0;
+}
+
+/************************************************************************/
+/*                        ReadMultiRangeAsync()                         */
+/************************************************************************/
+
+std::unique_ptr<VSIAsyncReadRequest> VSIUnixStdioHandle::ReadMultiRangeAsync(
+    int nRanges, void **ppData, const vsi_l_offset *panOffsets,
+    const size_t *panSizes, VSIAsyncReadCallback pfnCallback, void *pUserData)
+{
+    if (!bReadOnly || !VSIIOUringIsEnabled())
+        return VSIVirtualHandle::ReadMultiRangeAsync(
+            nRanges, ppData, panOffsets, panSizes, pfnCallback, pUserData);
+    // A single job submits all the ranges to the ring of its worker thread.
+    // No locking is needed, as ReadMultiRange() does not use the FILE*.
+    return SubmitReadMultiRangeAsync(nRanges, ppData, panOffsets, panSizes,
+                                     pfnCallback, pUserData, false, nullptr);
+}
+
+/************************************************************************/
+/*                             AdviseRead()                             */
+/************************************************************************/
+
+void VSIUnixStdioHandle::AdviseRead(int nRanges,
+                                    const vsi_l_offset *panOffsets,
+                                    const size_t *panSizes)
+{
+    if (!VSIIOUringIsEnabled())
+        return;
+    const int fd = fileno(fp);
+    for (int i = 0; i < nRanges; ++i)
+    {
+        posix_fadvise(fd, static_cast<off_t>(panOffsets[i]),
+                      static_cast<off_t>(panSizes[i]), POSIX_FADV_WILLNEED);
+    }
+}
+
+#endif  // HAVE_VSI_IO_URING
+
 /************************************************************************/
 /* ==================================================================== */
 /*                       VSIUnixStdioFilesystemHandler                  */
@@ -940,6 +1358,20 @@ int VSIUnixStdioFilesystemHandler::SupportsSparseFiles(const char *
 #endif
 }
 
+#ifdef HAVE_VSI_IO_URING
+
+/************************************************************************/
+/*                     HasOptimizedReadMultiRange()                     */
+/************************************************************************/
+
+int VSIUnixStdioFilesystemHandler::HasOptimizedReadMultiRange(
+    const char * /* pszPath */)
+{
+    return VSIIOUringIsEnabled() && VSIGetThreadIOUring() != nullptr;
+}
+
+#endif
+
 /************************************************************************/
 /*                          IsLocal()                                   */
 /************************************************************************/
@@ -135,6 +135,13 @@ class VSIWebHDFSHandle final : public VSICurlHandle
 
     std::string DownloadRegion(vsi_l_offset startOffset, int nBlocks) override;
 
+    // WebHDFS does not use HTTP ranges, so only serial download is possible
+    std::string DownloadRegionParallel(vsi_l_offset startOffset, int nBlocks,
+                                       int /* nParallelRequests */) override
+    {
+        return DownloadRegion(startOffset, nBlocks);
+    }
+
   public:
     VSIWebHDFSHandle(VSIWebHDFSFSHandler *poFS, const char *pszFilename,
                      const char *pszURL);
@@ -29,7 +29,9 @@
 #include "cpl_port.h"
 #include "cpl_worker_thread_pool.h"
 
+#include <atomic>
 #include <cstddef>
+#include <cstdlib>
 #include <memory>
 
 #include "cpl_conv.h"
@@ -44,6 +46,25 @@ struct CPLWorkerThreadJob
 
 static thread_local CPLWorkerThreadPool *threadLocalCurrentThreadPool = nullptr;
 
+// Number of jobs currently running in the worker threads of all the pools of
+// the process.
+static std::atomic<int> gnRunningJobs{0};
+
+/************************************************************************/
+/*                  IsConcurrentJobBudgetExhausted()                    */
+/************************************************************************/
+
+/* Whether the process-wide budget of concurrently running jobs, set by the */
+/* GDAL_MAX_CONCURRENT_JOBS configuration option, is exhausted. */
+static bool IsConcurrentJobBudgetExhausted()
+{
+    const char *pszMaxJobs =
+        CPLGetConfigOption("GDAL_MAX_CONCURRENT_JOBS", "ALL_CPUS");
+    const int nMaxJobs =
+        EQUAL(pszMaxJobs, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszMaxJobs);
+    return nMaxJobs > 0 && gnRunningJobs.load() >= nMaxJobs;
+}
+
 /************************************************************************/
 /*                         CPLWorkerThreadPool()                        */
 /************************************************************************/
@@ -108,7 +129,9 @@ void CPLWorkerThreadPool::WorkerThreadFunction(void *user_data)
 
         if (psJob->pfnFunc)
         {
+            gnRunningJobs++;
             psJob->pfnFunc(psJob->pData);
+            gnRunningJobs--;
         }
         CPLFree(psJob);
 #if DEBUG_VERBOSE
@@ -123,15 +146,30 @@ void CPLWorkerThreadPool::WorkerThreadFunction(void *user_data)
 /************************************************************************/
 
 /** Queue a new job.
+ *
+ * If this method is called from a worker thread of any pool, and the number
+ * of jobs running in the process has reached the value of the
+ * GDAL_MAX_CONCURRENT_JOBS configuration option (defaults to the number of
+ * CPUs), the job is run synchronously by the calling thread, to avoid
+ * oversubscription of the CPU cores with nested parallelism.
  *
  * @param pfnFunc Function to run for the job.
  * @param pData User data to pass to the job function.
+ * @param ePriority Priority of the job (since GDAL 3.9)
  * @return true in case of success.
  */
-bool CPLWorkerThreadPool::SubmitJob(CPLThreadFunc pfnFunc, void *pData)
+bool CPLWorkerThreadPool::SubmitJob(CPLThreadFunc pfnFunc, void *pData,
+                                    CPLJobPriority ePriority)
 {
     CPLAssert(m_nMaxThreads > 0);
 
+    if (threadLocalCurrentThreadPool != nullptr &&
+        IsConcurrentJobBudgetExhausted())
+    {
+        pfnFunc(pData);
+        return true;
+    }
+
     bool bMustIncrementWaitingWorkerThreadsAfterSubmission = false;
     if (threadLocalCurrentThreadPool == this)
     {
@@ -208,6 +246,7 @@ bool CPLWorkerThreadPool::SubmitJob(CPLThreadFunc pfnFunc, void *pData)
         }
     }
 
+    CPLList *&psJobQueue = apsJobQueue[static_cast<int>(ePriority)];
     psItem->psNext = psJobQueue;
     psJobQueue = psItem;
     nPendingJobs++;
@@ -249,20 +288,27 @@ bool CPLWorkerThreadPool::SubmitJob(CPLThreadFunc pfnFunc, void *pData)
 /************************************************************************/
 
 /** Queue several jobs
+ *
+ * Jobs are run synchronously in the same conditions as SubmitJob().
  *
  * @param pfnFunc Function to run for the job.
  * @param apData User data instances to pass to the job function.
+ * @param ePriority Priority of the jobs (since GDAL 3.9)
  * @return true in case of success.
  */
 bool CPLWorkerThreadPool::SubmitJobs(CPLThreadFunc pfnFunc,
-                                     const std::vector<void *> &apData)
+                                     const std::vector<void *> &apData,
+                                     CPLJobPriority ePriority)
 {
     CPLAssert(m_nMaxThreads > 0);
 
-    if (threadLocalCurrentThreadPool == this)
+    if (threadLocalCurrentThreadPool == this ||
+        (threadLocalCurrentThreadPool != nullptr &&
+         IsConcurrentJobBudgetExhausted()))
     {
         // If SubmitJob() is called from a worker thread of this queue,
         // then synchronously run the task to avoid deadlock.
+        // Likewise if the process-wide budget of running jobs is exhausted.
         for (size_t i = 0; i < apData.size(); i++)
         {
             pfnFunc(apData[i]);
@@ -272,6 +318,7 @@ bool CPLWorkerThreadPool::SubmitJobs(CPLThreadFunc pfnFunc,
 
     std::unique_lock<std::mutex> oGuard(m_mutex);
 
+    CPLList *&psJobQueue = apsJobQueue[static_cast<int>(ePriority)];
     CPLList *psJobQueueInit = psJobQueue;
     bool bRet = true;
 
@@ -332,6 +379,7 @@ bool CPLWorkerThreadPool::SubmitJobs(CPLThreadFunc pfnFunc,
             nPendingJobs--;
             psIter = psNext;
         }
+        psJobQueue = psJobQueueInit;
         return false;
     }
 
@@ -529,10 +577,19 @@ CPLWorkerThreadPool::GetNextJob(CPLWorkerThread *psWorkerThread)
         {
             return nullptr;
         }
-        CPLList *psTopJobIter = psJobQueue;
+        // Pick the first job of the highest priority non-empty queue
+        CPLList *psTopJobIter = nullptr;
+        for (CPLList *&psJobQueue : apsJobQueue)
+        {
+            psTopJobIter = psJobQueue;
+            if (psTopJobIter)
+            {
+                psJobQueue = psTopJobIter->psNext;
+                break;
+            }
+        }
         if (psTopJobIter)
         {
-            psJobQueue = psTopJobIter->psNext;
 
 #if DEBUG_VERBOSE
             CPLDebug("JOB", "%p got a job", psWorkerThread);
@@ -589,11 +646,13 @@ CPLWorkerThreadPool::GetNextJob(CPLWorkerThread *psWorkerThread)
  * The worker thread pool must remain alive while the returned object is
  * itself alive.
  *
+ * @param ePriority Priority of the jobs submitted to the queue (since GDAL 3.9)
  * @since GDAL 3.2
  */
-std::unique_ptr<CPLJobQueue> CPLWorkerThreadPool::CreateJobQueue()
+std::unique_ptr<CPLJobQueue>
+CPLWorkerThreadPool::CreateJobQueue(CPLJobPriority ePriority)
 {
-    return std::unique_ptr<CPLJobQueue>(new CPLJobQueue(this));
+    return std::unique_ptr<CPLJobQueue>(new CPLJobQueue(this, ePriority));
 }
 
 /************************************************************************/
@@ -601,7 +660,9 @@ std::unique_ptr<CPLJobQueue> CPLWorkerThreadPool::CreateJobQueue()
 /************************************************************************/
 
 //! @cond Doxygen_Suppress
-CPLJobQueue::CPLJobQueue(CPLWorkerThreadPool *poPool) : m_poPool(poPool)
+CPLJobQueue::CPLJobQueue(CPLWorkerThreadPool *poPool,
+                         CPLJobPriority ePriority)
+    : m_poPool(poPool), m_ePriority(ePriority)
 {
 }
 //! @endcond
@@ -669,7 +730,7 @@ bool CPLJobQueue::SubmitJob(CPLThreadFunc pfnFunc, void *pData)
         std::lock_guard<std::mutex> oGuard(m_mutex);
         m_nPendingJobs++;
     }
-    bool bRet = m_poPool->SubmitJob(JobQueueFunction, poJob);
+    bool bRet = m_poPool->SubmitJob(JobQueueFunction, poJob, m_ePriority);
     if (!bRet)
     {
         delete poJob;
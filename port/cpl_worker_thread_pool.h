@@ -74,6 +74,24 @@ typedef enum
 
 class CPLJobQueue;
 
+/** Priority of a job submitted to a CPLWorkerThreadPool.
+ *
+ * Pending jobs of a higher priority are always started before pending jobs
+ * of a lower priority. Jobs of a same priority are started in an unspecified
+ * order.
+ *
+ * @since GDAL 3.9
+ */
+enum class CPLJobPriority
+{
+    /** For latency sensitive jobs, e.g. decoding of data being read. */
+    HIGH = 0,
+    /** Default priority. */
+    NORMAL = 1,
+    /** For background jobs, e.g. compression of data being written. */
+    LOW = 2
+};
+
 /** Pool of worker threads */
 class CPL_DLL CPLWorkerThreadPool
 {
@@ -83,7 +101,10 @@ class CPL_DLL CPLWorkerThreadPool
     std::mutex m_mutex{};
     std::condition_variable m_cv{};
     volatile CPLWorkerThreadState eState = CPLWTS_OK;
-    CPLList *psJobQueue = nullptr;
+    static constexpr int PRIORITY_COUNT =
+        static_cast<int>(CPLJobPriority::LOW) + 1;
+    // One list of queued jobs per priority
+    CPLList *apsJobQueue[PRIORITY_COUNT] = {};
     int nPendingJobs = 0;
 
     CPLList *psWaitingWorkerThreadsList = nullptr;
@@ -104,10 +125,13 @@ class CPL_DLL CPLWorkerThreadPool
     bool Setup(int nThreads, CPLThreadFunc pfnInitFunc, void **pasInitData,
                bool bWaitallStarted);
 
-    std::unique_ptr<CPLJobQueue> CreateJobQueue();
+    std::unique_ptr<CPLJobQueue>
+    CreateJobQueue(CPLJobPriority ePriority = CPLJobPriority::NORMAL);
 
-    bool SubmitJob(CPLThreadFunc pfnFunc, void *pData);
-    bool SubmitJobs(CPLThreadFunc pfnFunc, const std::vector<void *> &apData);
+    bool SubmitJob(CPLThreadFunc pfnFunc, void *pData,
+                   CPLJobPriority ePriority = CPLJobPriority::NORMAL);
+    bool SubmitJobs(CPLThreadFunc pfnFunc, const std::vector<void *> &apData,
+                    CPLJobPriority ePriority = CPLJobPriority::NORMAL);
     void WaitCompletion(int nMaxRemainingJobs = 0);
     void WaitEvent();
 
@@ -123,6 +147,7 @@ class CPL_DLL CPLJobQueue
 {
     CPL_DISALLOW_COPY_ASSIGN(CPLJobQueue)
     CPLWorkerThreadPool *m_poPool = nullptr;
+    CPLJobPriority m_ePriority = CPLJobPriority::NORMAL;
     std::mutex m_mutex{};
     std::condition_variable m_cv{};
     int m_nPendingJobs = 0;
@@ -133,7 +158,7 @@ class CPL_DLL CPLJobQueue
     //! @cond Doxygen_Suppress
   protected:
     friend class CPLWorkerThreadPool;
-    explicit CPLJobQueue(CPLWorkerThreadPool *poPool);
+    CPLJobQueue(CPLWorkerThreadPool *poPool, CPLJobPriority ePriority);
     //! @endcond
 
   public:
@@ -145,6 +170,14 @@ class CPL_DLL CPLJobQueue
         return m_poPool;
     }
 
+    /** Return the priority of the jobs submitted to this queue.
+     * @since GDAL 3.9
+     */
+    CPLJobPriority GetPriority() const
+    {
+        return m_ePriority;
+    }
+
     bool SubmitJob(CPLThreadFunc pfnFunc, void *pData);
     void WaitCompletion(int nMaxRemainingJobs = 0);
 };
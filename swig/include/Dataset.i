@@ -300,6 +300,10 @@ public:
     return (GDALRasterBandShadow*) GDALGetRasterBand( self, nBand );
   }
 
+  bool IsThreadSafe(int nScopeFlags) {
+    return GDALDatasetIsThreadSafe(self, nScopeFlags, NULL);
+  }
+
 %newobject GetRootGroup;
   GDALGroupHS* GetRootGroup() {
     return GDALDatasetGetRootGroup(self);
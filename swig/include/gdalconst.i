@@ -172,6 +172,8 @@
 %constant OF_UPDATE = GDAL_OF_UPDATE;
 %constant OF_SHARED = GDAL_OF_SHARED;
 %constant OF_VERBOSE_ERROR = GDAL_OF_VERBOSE_ERROR;
+%constant OF_THREAD_SAFE = GDAL_OF_THREAD_SAFE;
+%constant OF_HEADER_ONLY = GDAL_OF_HEADER_ONLY;
 
 #if !defined(SWIGCSHARP) && !defined(SWIGJAVA)
 
@@ -181,6 +183,7 @@
 %constant char *DMD_EXTENSION          = GDAL_DMD_EXTENSION;
 %constant char *DMD_CONNECTION_PREFIX  = GDAL_DMD_CONNECTION_PREFIX;
 %constant char *DMD_EXTENSIONS         = GDAL_DMD_EXTENSIONS;
+%constant char *DMD_SIGNATURES         = GDAL_DMD_SIGNATURES;
 %constant char *DMD_CREATIONOPTIONLIST = GDAL_DMD_CREATIONOPTIONLIST;
 %constant char *DMD_MULTIDIM_DATASET_CREATIONOPTIONLIST         = GDAL_DMD_MULTIDIM_DATASET_CREATIONOPTIONLIST;
 %constant char *DMD_MULTIDIM_GROUP_CREATIONOPTIONLIST         = GDAL_DMD_MULTIDIM_GROUP_CREATIONOPTIONLIST;
@@ -272,6 +275,8 @@
 #define GDAL_DMD_CONNECTION_PREFIX  "DMD_CONNECTION_PREFIX"
 #define DMD_EXTENSIONS "DMD_EXTENSIONS"
 #define GDAL_DMD_EXTENSIONS "DMD_EXTENSIONS"
+#define DMD_SIGNATURES "DMD_SIGNATURES"
+#define GDAL_DMD_SIGNATURES "DMD_SIGNATURES"
 #define DMD_CREATIONOPTIONLIST "DMD_CREATIONOPTIONLIST"
 #define GDAL_DMD_CREATIONOPTIONLIST "DMD_CREATIONOPTIONLIST"
 #define DMD_MULTIDIM_DATASET_CREATIONOPTIONLIST "DMD_MULTIDIM_DATASET_CREATIONOPTIONLIST"
@@ -2140,6 +2140,7 @@ def WarpOptions(options=None, format=None,
          warpMemoryLimit=None, creationOptions=None, outputType = gdalconst.GDT_Unknown,
          workingType = gdalconst.GDT_Unknown, resampleAlg=None,
          srcNodata=None, dstNodata=None, multithread = False,
+         incremental = False,
          tps = False, rpc = False, geoloc = False, polynomialOrder=None,
          transformerOptions=None, cutlineDSName=None,
          cutlineLayer=None, cutlineWhere=None, cutlineSQL=None, cutlineBlend=None, cropToCutline = False,
@@ -2204,6 +2205,9 @@ def WarpOptions(options=None, format=None,
         output nodata value(s)
     multithread:
         whether to multithread computation and I/O operations
+    incremental:
+        whether to only re-warp the areas of an existing output dataset affected by
+        sources that changed since the previous incremental run
     tps:
         whether to use Thin Plate Spline GCP transformer
     rpc:
@@ -2332,6 +2336,8 @@ def WarpOptions(options=None, format=None,
             new_options += ['-dstnodata', str(dstNodata)]
         if multithread:
             new_options += ['-multi']
+        if incremental:
+            new_options += ['-incremental']
         if tps:
             new_options += ['-tps']
         if rpc:
@@ -2454,6 +2460,7 @@ def VectorTranslateOptions(options=None, format=None,
          simplifyTolerance=None,
          segmentizeMaxDist=None,
          makeValid=False,
+         multiThread=False,
          mapFieldType=None,
          explodeCollections=False,
          zField=None,
@@ -2550,6 +2557,8 @@ def VectorTranslateOptions(options=None, format=None,
         maximum distance between consecutive nodes of a line geometry
     makeValid:
         run MakeValid() on geometries
+    multiThread:
+        set to True to read features and process their geometries in other threads
     mapFieldType:
         converts any field of the specified type to another type. Valid types are:
         Integer, Integer64, Real, String, Date, Time, DateTime, Binary, IntegerList,
@@ -2721,6 +2730,8 @@ def VectorTranslateOptions(options=None, format=None,
             new_options += ['-segmentize', str(segmentizeMaxDist)]
         if makeValid:
             new_options += ['-makevalid']
+        if multiThread:
+            new_options += ['-multithread']
         if mapFieldType is not None:
             new_options += ['-mapFieldType']
             if isinstance(mapFieldType, str):
@@ -3425,6 +3436,7 @@ def FootprintOptions(options=None,
                      combineBands=None,
                      srcNodata=None,
                      ovr=None,
+                     accuracy=None,
                      targetCoordinateSystem=None,
                      dstSRS=None,
                      splitPolys=None,
@@ -3455,6 +3467,8 @@ def FootprintOptions(options=None,
         source nodata value(s).
     ovr:
         overview index.
+    accuracy:
+        acceptable inaccuracy of the footprint, in full resolution pixels.
     targetCoordinateSystem:
         "pixel" or "georef"
     dstSRS:
@@ -3514,6 +3528,8 @@ def FootprintOptions(options=None,
             new_options += ['-srcnodata', str(srcNodata)]
         if ovr is not None:
             new_options += ['-ovr', str(ovr)]
+        if accuracy is not None:
+            new_options += ['-accuracy', str(accuracy)]
         if splitPolys:
             new_options += ["-split_polys"]
         if convexHull:
@@ -3666,6 +3682,7 @@ def BuildVRTOptions(options=None,
                     VRTNodata=None,
                     hideNodata=None,
                     strict=False,
+                    format=None,
                     callback=None, callback_data=None):
     """Create a BuildVRTOptions() object that can be passed to gdal.BuildVRT()
 
@@ -3704,6 +3721,8 @@ def BuildVRTOptions(options=None,
         whether to make the VRT band not report the NoData value.
     strict:
         set to True if warnings should be failures
+    format:
+        output format: "VRT" (default) or "GTI" (tile index for the GTI driver)
     callback:
         callback method.
     callback_data:
@@ -3721,6 +3740,8 @@ def BuildVRTOptions(options=None,
         new_options = ParseCommandLine(options)
     else:
         new_options = options
+        if format is not None:
+            new_options += ['-of', format]
         if resolution is not None:
             new_options += ['-resolution', str(resolution)]
         if outputBounds is not None: